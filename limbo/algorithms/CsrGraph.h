@@ -0,0 +1,545 @@
+/**
+ * @file   CsrGraph.h
+ * @brief  compact undirected graph in compressed sparse row (CSR) form with weighted edges.
+ *
+ * It models the Boost.Graph concepts used by the coloring algorithms,
+ * i.e., vertex list, edge list, incidence and adjacency graph,
+ * with edge_weight and edge_index property maps,
+ * so @ref limbo::algorithms::coloring::Coloring and @ref limbo::algorithms::coloring::GraphSimplification
+ * can be instantiated with it instead of boost::adjacency_list.
+ *
+ * The free functions are declared in namespace boost,
+ * so this header must be included before the algorithms calling them,
+ * which is done by @ref GraphUtility.h.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_CSRGRAPH_H
+#define LIMBO_ALGORITHMS_CSRGRAPH_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <limbo/containers/LargeMemory.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.algorithms
+namespace algorithms
+{
+
+/// @brief index array of @ref limbo::algorithms::CsrGraph, large graphs are mapped with huge pages and spread over NUMA nodes
+typedef std::vector<boost::uint32_t, limbo::containers::LargeAllocator<boost::uint32_t> > CsrIndexArray;
+
+/// @brief edge descriptor of @ref limbo::algorithms::CsrGraph.
+/// The member names follow boost::detail::edge_desc_impl so that existing edge hashers work.
+struct CsrEdgeDescriptor
+{
+    boost::uint32_t m_source; ///< source vertex, the vertex the edge is visited from
+    boost::uint32_t m_target; ///< target vertex
+    boost::uint32_t m_id; ///< dense edge id in [0, number of edges)
+
+    /// default constructor
+    CsrEdgeDescriptor() : m_source(0), m_target(0), m_id(std::numeric_limits<boost::uint32_t>::max()) {}
+    /// constructor
+    /// @param s source vertex
+    /// @param t target vertex
+    /// @param id edge id
+    CsrEdgeDescriptor(boost::uint32_t s, boost::uint32_t t, boost::uint32_t id) : m_source(s), m_target(t), m_id(id) {}
+
+    /// @nowarn
+    bool operator==(CsrEdgeDescriptor const& rhs) const {return m_id == rhs.m_id;}
+    bool operator!=(CsrEdgeDescriptor const& rhs) const {return m_id != rhs.m_id;}
+    bool operator<(CsrEdgeDescriptor const& rhs) const {return m_id < rhs.m_id;}
+    /// @endnowarn
+};
+
+/// @return hash value of an edge, same for both directions
+/// @param e edge
+inline std::size_t hash_value(CsrEdgeDescriptor const& e) {return boost::hash_value(e.m_id);}
+
+/// @brief iterator over the incident edges of a vertex of @ref limbo::algorithms::CsrGraph
+class CsrOutEdgeIterator : public boost::iterator_facade<CsrOutEdgeIterator, CsrEdgeDescriptor, boost::random_access_traversal_tag, CsrEdgeDescriptor>
+{
+    public:
+        /// @nowarn
+        typedef CsrIndexArray::const_iterator index_iterator;
+        /// @endnowarn
+
+        /// default constructor
+        CsrOutEdgeIterator() : m_source(0) {}
+        /// constructor
+        /// @param s source vertex
+        /// @param itv position in the adjacent vertices
+        /// @param ite position in the adjacent edge ids
+        CsrOutEdgeIterator(boost::uint32_t s, index_iterator itv, index_iterator ite) : m_source(s), m_itVertex(itv), m_itEdge(ite) {}
+
+    private:
+        /// @nowarn
+        friend class boost::iterator_core_access;
+        CsrEdgeDescriptor dereference() const {return CsrEdgeDescriptor(m_source, *m_itVertex, *m_itEdge);}
+        bool equal(CsrOutEdgeIterator const& rhs) const {return m_itEdge == rhs.m_itEdge;}
+        void increment() {++m_itVertex; ++m_itEdge;}
+        void decrement() {--m_itVertex; --m_itEdge;}
+        void advance(std::ptrdiff_t n) {m_itVertex += n; m_itEdge += n;}
+        std::ptrdiff_t distance_to(CsrOutEdgeIterator const& rhs) const {return rhs.m_itEdge-m_itEdge;}
+        /// @endnowarn
+
+        boost::uint32_t m_source; ///< source vertex
+        index_iterator m_itVertex; ///< position in the adjacent vertices
+        index_iterator m_itEdge; ///< position in the adjacent edge ids
+};
+
+/// @brief iterator over all edges of @ref limbo::algorithms::CsrGraph in the order of edge ids
+class CsrEdgeIterator : public boost::iterator_facade<CsrEdgeIterator, CsrEdgeDescriptor, boost::random_access_traversal_tag, CsrEdgeDescriptor>
+{
+    public:
+        /// default constructor
+        CsrEdgeIterator() : m_vSource(NULL), m_vTarget(NULL), m_id(0) {}
+        /// constructor
+        /// @param vs sources of edges
+        /// @param vt targets of edges
+        /// @param id edge id
+        CsrEdgeIterator(CsrIndexArray const* vs, CsrIndexArray const* vt, boost::uint32_t id) : m_vSource(vs), m_vTarget(vt), m_id(id) {}
+
+    private:
+        /// @nowarn
+        friend class boost::iterator_core_access;
+        CsrEdgeDescriptor dereference() const {return CsrEdgeDescriptor((*m_vSource)[m_id], (*m_vTarget)[m_id], m_id);}
+        bool equal(CsrEdgeIterator const& rhs) const {return m_id == rhs.m_id;}
+        void increment() {++m_id;}
+        void decrement() {--m_id;}
+        void advance(std::ptrdiff_t n) {m_id += n;}
+        std::ptrdiff_t distance_to(CsrEdgeIterator const& rhs) const {return (std::ptrdiff_t)rhs.m_id-(std::ptrdiff_t)m_id;}
+        /// @endnowarn
+
+        CsrIndexArray const* m_vSource; ///< sources of edges
+        CsrIndexArray const* m_vTarget; ///< targets of edges
+        boost::uint32_t m_id; ///< edge id
+};
+
+/// @brief Undirected graph with a fixed number of vertices and weighted edges in CSR form.
+///
+/// Edges are stored as flat arrays indexed by dense edge ids,
+/// and the incident edges of all vertices are packed into one offset array
+/// and two adjacency arrays sorted by the adjacent vertex,
+/// so boost::edge(u, v, g) is a binary search instead of a linear scan,
+/// and solvers can index per-edge data by edge id instead of hashing edge descriptors.
+///
+/// The graph is either built from an edge list in the constructor,
+/// or by boost::add_edge as for boost::adjacency_list.
+/// The adjacency arrays are built on the first adjacency query after edges are added,
+/// so adding all edges before traversing costs O(V+E) once.
+/// Interleaved boost::edge and boost::add_edge, as used to build merged graphs,
+/// are served by a temporary hash map until the next adjacency query.
+/// Since queries may build the arrays, call @ref freeze before sharing a graph among threads.
+///
+/// Edge weight follows the coloring convention: non-negative for conflict edges and negative for stitch edges.
+/// @tparam WeightType type of edge weight
+template <typename WeightType = boost::int32_t>
+class CsrGraph
+{
+    public:
+        /// @nowarn
+        typedef WeightType edge_weight_type;
+        typedef boost::uint32_t vertex_descriptor;
+        typedef CsrEdgeDescriptor edge_descriptor;
+        typedef boost::counting_iterator<boost::uint32_t> vertex_iterator;
+        typedef CsrEdgeIterator edge_iterator;
+        typedef CsrOutEdgeIterator out_edge_iterator;
+        typedef CsrIndexArray::const_iterator adjacency_iterator;
+        typedef void in_edge_iterator;
+        typedef boost::undirected_tag directed_category;
+        typedef boost::allow_parallel_edge_tag edge_parallel_category;
+        struct traversal_category
+            : public boost::vertex_list_graph_tag
+            , public boost::edge_list_graph_tag
+            , public boost::incidence_graph_tag
+            , public boost::adjacency_graph_tag
+        {};
+        typedef boost::uint32_t vertices_size_type;
+        typedef boost::uint32_t edges_size_type;
+        typedef boost::uint32_t degree_size_type;
+        /// @endnowarn
+
+        /// @return invalid vertex
+        static vertex_descriptor null_vertex() {return std::numeric_limits<vertex_descriptor>::max();}
+
+        /// constructor
+        /// @param n number of vertices
+        explicit CsrGraph(vertices_size_type n = 0)
+            : m_numVertices(n)
+            , m_frozen(false)
+            , m_hashed(false)
+        {}
+        /// constructor from an edge list
+        /// @tparam EdgeIterator iterator of std::pair of vertices
+        /// @tparam WeightIterator iterator of edge weights
+        /// @param n number of vertices
+        /// @param first begin of edges
+        /// @param last end of edges
+        /// @param wfirst weights of edges
+        template <typename EdgeIterator, typename WeightIterator>
+        CsrGraph(vertices_size_type n, EdgeIterator first, EdgeIterator last, WeightIterator wfirst)
+            : m_numVertices(n)
+            , m_frozen(false)
+            , m_hashed(false)
+        {
+            for (; first != last; ++first, ++wfirst)
+            {
+                m_vSource.push_back(first->first);
+                m_vTarget.push_back(first->second);
+                m_vWeight.push_back(*wfirst);
+            }
+            freeze();
+        }
+
+        /// build the adjacency arrays if edges were added since the last build
+        void freeze() const;
+
+        /// add an edge, parallel edges and self loops are kept as in boost::adjacency_list
+        /// @param s source vertex
+        /// @param t target vertex
+        /// @return new edge
+        edge_descriptor add_edge(vertex_descriptor s, vertex_descriptor t);
+        /// find an edge
+        /// @param s source vertex
+        /// @param t target vertex
+        /// @return the edge with the smallest id between \a s and \a t, and whether it exists
+        std::pair<edge_descriptor, bool> edge(vertex_descriptor s, vertex_descriptor t) const;
+
+        /// @return number of vertices
+        vertices_size_type num_vertices() const {return m_numVertices;}
+        /// @return number of edges
+        edges_size_type num_edges() const {return m_vSource.size();}
+        /// @param v vertex
+        /// @return number of incident edges of \a v
+        degree_size_type degree(vertex_descriptor v) const {freeze(); return m_vOffset[v+1]-m_vOffset[v];}
+        /// @param v vertex
+        /// @return range of adjacent vertices in ascending order
+        std::pair<adjacency_iterator, adjacency_iterator> adjacent_vertices(vertex_descriptor v) const
+        {
+            freeze();
+            return std::make_pair(m_vAdjVertex.begin()+m_vOffset[v], m_vAdjVertex.begin()+m_vOffset[v+1]);
+        }
+        /// @param v vertex
+        /// @return range of incident edges with \a v as source
+        std::pair<out_edge_iterator, out_edge_iterator> out_edges(vertex_descriptor v) const
+        {
+            freeze();
+            return std::make_pair(
+                    out_edge_iterator(v, m_vAdjVertex.begin()+m_vOffset[v], m_vAdjEdge.begin()+m_vOffset[v]),
+                    out_edge_iterator(v, m_vAdjVertex.begin()+m_vOffset[v+1], m_vAdjEdge.begin()+m_vOffset[v+1])
+                    );
+        }
+        /// @return range of all edges in the order of edge ids
+        std::pair<edge_iterator, edge_iterator> edges() const
+        {
+            return std::make_pair(edge_iterator(&m_vSource, &m_vTarget, 0), edge_iterator(&m_vSource, &m_vTarget, num_edges()));
+        }
+
+        /// @param e edge
+        /// @return weight of \a e
+        edge_weight_type const& weight(edge_descriptor const& e) const {return m_vWeight[e.m_id];}
+        /// @param e edge
+        /// @return weight of \a e
+        edge_weight_type& weight(edge_descriptor const& e) {return m_vWeight[e.m_id];}
+        /// @return weights indexed by edge ids
+        std::vector<edge_weight_type> const& weights() const {return m_vWeight;}
+
+        /// swap with another graph
+        /// @param rhs another graph
+        void swap(CsrGraph& rhs);
+
+    protected:
+        /// @return key of vertex pair in the temporary hash map
+        static boost::uint64_t pair_key(vertex_descriptor s, vertex_descriptor t)
+        {
+            if (s > t) std::swap(s, t);
+            return ((boost::uint64_t)s << 32) | t;
+        }
+
+        vertices_size_type m_numVertices; ///< number of vertices
+        CsrIndexArray m_vSource; ///< source of each edge
+        CsrIndexArray m_vTarget; ///< target of each edge
+        std::vector<edge_weight_type> m_vWeight; ///< weight of each edge
+
+        mutable CsrIndexArray m_vOffset; ///< offset of the incident edges of each vertex, with one more entry for the end
+        mutable CsrIndexArray m_vAdjVertex; ///< adjacent vertices sorted within each vertex
+        mutable CsrIndexArray m_vAdjEdge; ///< edge ids in the same order as m_vAdjVertex
+        mutable bool m_frozen; ///< whether the adjacency arrays are up to date
+        mutable bool m_hashed; ///< whether m_hEdge is in use
+        mutable boost::unordered_map<boost::uint64_t, boost::uint32_t> m_hEdge; ///< vertex pair to edge id when edges are added after a lookup
+};
+
+/// @brief whether a graph type is @ref limbo::algorithms::CsrGraph, to dispatch utilities only available for CSR graphs
+/// @tparam GraphType graph type
+template <typename GraphType>
+struct is_csr_graph : public boost::false_type {};
+/// @brief specialization for @ref limbo::algorithms::CsrGraph
+/// @tparam WeightType edge weight type
+template <typename WeightType>
+struct is_csr_graph<CsrGraph<WeightType> > : public boost::true_type {};
+
+template <typename WeightType>
+void CsrGraph<WeightType>::freeze() const
+{
+    if (m_frozen) return;
+
+    // count incident edges, a self loop is incident once
+    CsrIndexArray vOffset (m_numVertices+1, 0);
+    for (edges_size_type i = 0, ie = num_edges(); i < ie; ++i)
+    {
+        ++vOffset[m_vSource[i]+1];
+        if (m_vSource[i] != m_vTarget[i])
+            ++vOffset[m_vTarget[i]+1];
+    }
+    for (vertices_size_type v = 0; v < m_numVertices; ++v)
+        vOffset[v+1] += vOffset[v];
+
+    // first pass scatters incident edges in the order of edge ids
+    CsrIndexArray vPos (vOffset.begin(), vOffset.end()-1);
+    CsrIndexArray vAdjVertex (vOffset.back());
+    CsrIndexArray vAdjEdge (vOffset.back());
+    for (edges_size_type i = 0, ie = num_edges(); i < ie; ++i)
+    {
+        boost::uint32_t s = m_vSource[i];
+        boost::uint32_t t = m_vTarget[i];
+        vAdjVertex[vPos[s]] = t;
+        vAdjEdge[vPos[s]++] = i;
+        if (s != t)
+        {
+            vAdjVertex[vPos[t]] = s;
+            vAdjEdge[vPos[t]++] = i;
+        }
+    }
+    // second pass visits vertices in ascending order,
+    // so appending each vertex to its neighbors sorts every adjacency list without comparisons
+    m_vAdjVertex.resize(vAdjVertex.size());
+    m_vAdjEdge.resize(vAdjEdge.size());
+    vPos.assign(vOffset.begin(), vOffset.end()-1);
+    for (vertices_size_type v = 0; v < m_numVertices; ++v)
+    {
+        for (boost::uint32_t i = vOffset[v]; i < vOffset[v+1]; ++i)
+        {
+            boost::uint32_t u = vAdjVertex[i];
+            m_vAdjVertex[vPos[u]] = v;
+            m_vAdjEdge[vPos[u]++] = vAdjEdge[i];
+        }
+    }
+    m_vOffset.swap(vOffset);
+
+    boost::unordered_map<boost::uint64_t, boost::uint32_t>().swap(m_hEdge);
+    m_hashed = false;
+    m_frozen = true;
+}
+
+template <typename WeightType>
+typename CsrGraph<WeightType>::edge_descriptor CsrGraph<WeightType>::add_edge(vertex_descriptor s, vertex_descriptor t)
+{
+    if (m_frozen) // edges are added after lookups, keep a hash map until the next adjacency query
+    {
+        m_hEdge.clear();
+        for (edges_size_type i = 0, ie = num_edges(); i < ie; ++i)
+            m_hEdge.insert(std::make_pair(pair_key(m_vSource[i], m_vTarget[i]), i));
+        m_hashed = true;
+        m_frozen = false;
+    }
+    edges_size_type id = num_edges();
+    m_vSource.push_back(s);
+    m_vTarget.push_back(t);
+    m_vWeight.push_back(edge_weight_type());
+    if (m_hashed)
+        m_hEdge.insert(std::make_pair(pair_key(s, t), id));
+    return edge_descriptor(s, t, id);
+}
+
+template <typename WeightType>
+std::pair<typename CsrGraph<WeightType>::edge_descriptor, bool> CsrGraph<WeightType>::edge(vertex_descriptor s, vertex_descriptor t) const
+{
+    if (m_hashed)
+    {
+        boost::unordered_map<boost::uint64_t, boost::uint32_t>::const_iterator found = m_hEdge.find(pair_key(s, t));
+        if (found == m_hEdge.end())
+            return std::make_pair(edge_descriptor(), false);
+        return std::make_pair(edge_descriptor(s, t, found->second), true);
+    }
+    freeze();
+    adjacency_iterator first = m_vAdjVertex.begin()+m_vOffset[s];
+    adjacency_iterator last = m_vAdjVertex.begin()+m_vOffset[s+1];
+    adjacency_iterator found = std::lower_bound(first, last, t);
+    if (found == last || *found != t)
+        return std::make_pair(edge_descriptor(), false);
+    return std::make_pair(edge_descriptor(s, t, m_vAdjEdge[found-m_vAdjVertex.begin()]), true);
+}
+
+template <typename WeightType>
+void CsrGraph<WeightType>::swap(CsrGraph<WeightType>& rhs)
+{
+    std::swap(m_numVertices, rhs.m_numVertices);
+    m_vSource.swap(rhs.m_vSource);
+    m_vTarget.swap(rhs.m_vTarget);
+    m_vWeight.swap(rhs.m_vWeight);
+    m_vOffset.swap(rhs.m_vOffset);
+    m_vAdjVertex.swap(rhs.m_vAdjVertex);
+    m_vAdjEdge.swap(rhs.m_vAdjEdge);
+    std::swap(m_frozen, rhs.m_frozen);
+    std::swap(m_hashed, rhs.m_hashed);
+    m_hEdge.swap(rhs.m_hEdge);
+}
+
+/// @brief edge weight map of @ref limbo::algorithms::CsrGraph
+/// @tparam GraphType const or non-const CsrGraph
+/// @tparam Reference reference to edge weight
+template <typename GraphType, typename Reference>
+struct CsrEdgeWeightMap : public boost::put_get_helper<Reference, CsrEdgeWeightMap<GraphType, Reference> >
+{
+    /// @nowarn
+    typedef CsrEdgeDescriptor key_type;
+    typedef typename GraphType::edge_weight_type value_type;
+    typedef Reference reference;
+    typedef boost::lvalue_property_map_tag category;
+    /// @endnowarn
+
+    GraphType* g; ///< bind graph object
+
+    /// constructor
+    /// @param _g graph
+    CsrEdgeWeightMap(GraphType& _g) : g(&_g) {}
+    /// @param e edge
+    /// @return weight of \a e
+    reference operator[](key_type const& e) const {return g->weight(e);}
+};
+
+/// @brief edge index map of @ref limbo::algorithms::CsrGraph, i.e., the dense edge ids
+struct CsrEdgeIndexMap : public boost::put_get_helper<boost::uint32_t, CsrEdgeIndexMap>
+{
+    /// @nowarn
+    typedef CsrEdgeDescriptor key_type;
+    typedef boost::uint32_t value_type;
+    typedef boost::uint32_t reference;
+    typedef boost::readable_property_map_tag category;
+    /// @endnowarn
+
+    /// @param e edge
+    /// @return id of \a e
+    reference operator[](key_type const& e) const {return e.m_id;}
+};
+
+/// @nowarn
+template <typename W>
+inline typename CsrGraph<W>::vertices_size_type num_vertices(CsrGraph<W> const& g) {return g.num_vertices();}
+template <typename W>
+inline typename CsrGraph<W>::edges_size_type num_edges(CsrGraph<W> const& g) {return g.num_edges();}
+template <typename W>
+inline std::pair<typename CsrGraph<W>::vertex_iterator, typename CsrGraph<W>::vertex_iterator> vertices(CsrGraph<W> const& g)
+{
+    return std::make_pair(typename CsrGraph<W>::vertex_iterator(0), typename CsrGraph<W>::vertex_iterator(g.num_vertices()));
+}
+template <typename W>
+inline std::pair<typename CsrGraph<W>::edge_iterator, typename CsrGraph<W>::edge_iterator> edges(CsrGraph<W> const& g) {return g.edges();}
+template <typename W>
+inline std::pair<typename CsrGraph<W>::adjacency_iterator, typename CsrGraph<W>::adjacency_iterator>
+adjacent_vertices(typename CsrGraph<W>::vertex_descriptor v, CsrGraph<W> const& g) {return g.adjacent_vertices(v);}
+template <typename W>
+inline std::pair<typename CsrGraph<W>::out_edge_iterator, typename CsrGraph<W>::out_edge_iterator>
+out_edges(typename CsrGraph<W>::vertex_descriptor v, CsrGraph<W> const& g) {return g.out_edges(v);}
+template <typename W>
+inline typename CsrGraph<W>::degree_size_type out_degree(typename CsrGraph<W>::vertex_descriptor v, CsrGraph<W> const& g) {return g.degree(v);}
+template <typename W>
+inline typename CsrGraph<W>::degree_size_type degree(typename CsrGraph<W>::vertex_descriptor v, CsrGraph<W> const& g) {return g.degree(v);}
+template <typename W>
+inline typename CsrGraph<W>::vertex_descriptor source(CsrEdgeDescriptor const& e, CsrGraph<W> const&) {return e.m_source;}
+template <typename W>
+inline typename CsrGraph<W>::vertex_descriptor target(CsrEdgeDescriptor const& e, CsrGraph<W> const&) {return e.m_target;}
+template <typename W>
+inline std::pair<CsrEdgeDescriptor, bool> edge(typename CsrGraph<W>::vertex_descriptor s, typename CsrGraph<W>::vertex_descriptor t, CsrGraph<W> const& g) {return g.edge(s, t);}
+template <typename W>
+inline std::pair<CsrEdgeDescriptor, bool> add_edge(typename CsrGraph<W>::vertex_descriptor s, typename CsrGraph<W>::vertex_descriptor t, CsrGraph<W>& g)
+{
+    return std::make_pair(g.add_edge(s, t), true);
+}
+template <typename W>
+inline CsrEdgeWeightMap<CsrGraph<W>, W&> get(boost::edge_weight_t, CsrGraph<W>& g) {return CsrEdgeWeightMap<CsrGraph<W>, W&>(g);}
+template <typename W>
+inline CsrEdgeWeightMap<CsrGraph<W> const, W const&> get(boost::edge_weight_t, CsrGraph<W> const& g) {return CsrEdgeWeightMap<CsrGraph<W> const, W const&>(g);}
+template <typename W>
+inline W get(boost::edge_weight_t, CsrGraph<W> const& g, CsrEdgeDescriptor const& e) {return g.weight(e);}
+template <typename W>
+inline void put(boost::edge_weight_t, CsrGraph<W>& g, CsrEdgeDescriptor const& e, W const& w) {g.weight(e) = w;}
+template <typename W>
+inline CsrEdgeIndexMap get(boost::edge_index_t, CsrGraph<W> const&) {return CsrEdgeIndexMap();}
+template <typename W>
+inline boost::uint32_t get(boost::edge_index_t, CsrGraph<W> const&, CsrEdgeDescriptor const& e) {return e.m_id;}
+/// @endnowarn
+
+/// @brief copy the vertices, edges and edge weights of another Boost.Graph graph, 
+/// e.g., boost::adjacency_list with vertex indices from 0 
+/// @tparam GraphType graph type with edge_weight property 
+/// @tparam W type of edge weight 
+/// @param g graph 
+/// @param cg CSR graph, old contents are removed 
+template <typename GraphType, typename W>
+void copy_csr_graph(GraphType const& g, CsrGraph<W>& cg)
+{
+    // unqualified calls, so that functions of GraphType are found by argument-dependent lookup 
+    CsrGraph<W> tg (num_vertices(g));
+    typename boost::graph_traits<GraphType>::edge_iterator ei, eie;
+    for (boost::tie(ei, eie) = edges(g); ei != eie; ++ei)
+        put(boost::edge_weight, tg, tg.add_edge(source(*ei, g), target(*ei, g)), (W)get(boost::edge_weight, g, *ei));
+    tg.freeze();
+    cg.swap(tg);
+}
+
+} // namespace algorithms
+} // namespace limbo
+
+/// @nowarn
+namespace boost
+{
+
+template <typename W>
+struct property_map<limbo::algorithms::CsrGraph<W>, edge_weight_t>
+{
+    typedef limbo::algorithms::CsrEdgeWeightMap<limbo::algorithms::CsrGraph<W>, W&> type;
+    typedef limbo::algorithms::CsrEdgeWeightMap<limbo::algorithms::CsrGraph<W> const, W const&> const_type;
+};
+
+template <typename W>
+struct property_map<limbo::algorithms::CsrGraph<W>, edge_index_t>
+{
+    typedef limbo::algorithms::CsrEdgeIndexMap type;
+    typedef limbo::algorithms::CsrEdgeIndexMap const_type;
+};
+
+// algorithms call these functions with boost:: qualification
+using limbo::algorithms::num_vertices;
+using limbo::algorithms::num_edges;
+using limbo::algorithms::vertices;
+using limbo::algorithms::edges;
+using limbo::algorithms::adjacent_vertices;
+using limbo::algorithms::out_edges;
+using limbo::algorithms::out_degree;
+using limbo::algorithms::degree;
+using limbo::algorithms::source;
+using limbo::algorithms::target;
+using limbo::algorithms::edge;
+using limbo::algorithms::add_edge;
+using limbo::algorithms::get;
+using limbo::algorithms::put;
+
+} // namespace boost
+/// @endnowarn
+
+#endif
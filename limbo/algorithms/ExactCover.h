@@ -0,0 +1,542 @@
+/**
+ * @file   ExactCover.h
+ * @brief  exact cover by dancing links with the search tree split across threads
+ *
+ * Rows are kept in an array-based linked matrix, following "Dancing Links", Donald E. Knuth, 2000,
+ * in the way of the bundled limbo/thirdparty/dlx, but with links of all nodes in flat arrays,
+ * so a thread copies the whole matrix at once.
+ * The top levels of the search tree are expanded into branches in the order of a serial search,
+ * and threads take branches with an atomic counter.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_EXACTCOVER_H
+#define LIMBO_ALGORITHMS_EXACTCOVER_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <boost/cstdint.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+
+/// @class limbo::algorithms::ExactCover
+/// @brief Select rows such that each primary column is covered exactly once and each secondary column at most once,
+/// by Algorithm X of Knuth with dancing links.
+///
+/// The column with the fewest rows is branched on first.
+/// The search tree is split into branches of partial solutions until there are enough branches for the threads,
+/// and branches are searched in parallel.
+/// Results do not depend on the number of threads:
+/// @ref solve gives the first solution of a serial search, and @ref solutions gives solutions in the order of a serial search.
+class ExactCover
+{
+	public:
+		/// rows of a solution
+		typedef std::vector<boost::uint32_t> solution_type;
+
+		/// constructor
+		/// @param numPrimary number of primary columns, indexed from 0
+		/// @param numSecondary number of secondary columns, indexed after primary ones
+		ExactCover(boost::uint32_t numPrimary, boost::uint32_t numSecondary = 0);
+
+		/// add a row
+		/// @param first first column of the row
+		/// @param last end of columns of the row
+		/// @return index of the row
+		template <typename Iterator>
+		boost::uint32_t add_row(Iterator first, Iterator last);
+		/// add a row
+		/// @param vColumn columns of the row
+		/// @return index of the row
+		boost::uint32_t add_row(std::vector<boost::uint32_t> const& vColumn) {return add_row(vColumn.begin(), vColumn.end());}
+		/// set number of threads
+		/// @param t number of threads, at most @ref limbo::containers::num_threads are used
+		void threads(boost::int32_t t) {m_threads = t;}
+
+		/// @return number of primary columns
+		boost::uint32_t num_primary() const {return m_num_primary;}
+		/// @return number of columns
+		boost::uint32_t num_columns() const {return m_num_primary+m_num_secondary;}
+		/// @return number of rows
+		boost::uint32_t num_rows() const {return m_vRowBegin.size()-1;}
+
+		/// find the first solution of a serial search
+		/// @param sol rows of the solution as output
+		/// @return true if a solution exists
+		bool solve(solution_type& sol);
+		/// @return number of solutions
+		boost::uint64_t count();
+		/// @param maxSolutions the maximum number of solutions
+		/// @return the first solutions of a serial search
+		std::vector<solution_type> solutions(boost::uint64_t maxSolutions = std::numeric_limits<boost::uint64_t>::max());
+
+	protected:
+		/// what a search collects
+		enum Mode
+		{
+			FIRST, ///< the first solution
+			COUNT, ///< number of solutions
+			COLLECT ///< solutions up to a limit
+		};
+		/// links of nodes; node 0 is the root, nodes 1 to the number of columns are column headers
+		struct Matrix
+		{
+			std::vector<boost::uint32_t> vL; ///< left node
+			std::vector<boost::uint32_t> vR; ///< right node
+			std::vector<boost::uint32_t> vU; ///< node above
+			std::vector<boost::uint32_t> vD; ///< node below
+			std::vector<boost::uint32_t> vC; ///< column header of each node
+			std::vector<boost::uint32_t> vRow; ///< row of each node
+			std::vector<boost::uint32_t> vS; ///< number of rows of each column header
+
+			/// remove a column and the rows in it
+			void cover(boost::uint32_t c);
+			/// restore a column and the rows in it, in the reverse order of @ref cover
+			void uncover(boost::uint32_t c);
+			/// @return the primary column with the fewest rows, 0 if all are covered
+			boost::uint32_t choose() const;
+		};
+		/// a subtree of the search
+		struct Branch
+		{
+			boost::uint32_t begin; ///< first row of the partial solution in the flat array of branches
+			boost::uint32_t end; ///< end of rows of the partial solution
+			boost::uint64_t count; ///< number of solutions found
+			std::vector<solution_type> vSolution; ///< solutions found
+		};
+		/// shared state of threads
+		struct Pass
+		{
+			ExactCover const* cover; ///< problem
+			Mode mode; ///< what to collect
+			boost::uint64_t max_solutions; ///< the maximum number of solutions of a branch in @ref COLLECT
+			std::vector<boost::uint32_t> vPrefix; ///< partial solutions of all branches
+			std::vector<Branch> vBranch; ///< branches in the order of a serial search
+			boost::uint32_t first; ///< the first branch with a solution in @ref FIRST
+		};
+		/// branches searched by limbo::containers::parallel_for
+		struct SearchKernel
+		{
+			Pass* pass; ///< shared state
+			/// @param b first branch
+			/// @param e end branch
+			void operator()(std::size_t b, std::size_t e) const {search_branches(*pass, b, e);}
+		};
+		/// search state of a thread
+		struct Context
+		{
+			Matrix matrix; ///< copy of the matrix
+			Pass* pass; ///< shared state
+			boost::uint32_t branch; ///< current branch
+			solution_type vStack; ///< rows selected so far
+		};
+
+		/// select a row by covering its columns
+		void select(Matrix& m, boost::uint32_t r) const;
+		/// undo @ref select
+		void unselect(Matrix& m, boost::uint32_t r) const;
+		/// split the search tree into branches
+		/// @param pass shared state with branches as output
+		/// @param target number of branches to reach
+		void split(Pass& pass, boost::uint32_t target) const;
+		/// search all branches in parallel
+		void run(Pass& pass) const;
+		/// search a range of branches on a copy of the matrix
+		/// @param pass shared state
+		/// @param first first branch
+		/// @param last end branch
+		static void search_branches(Pass& pass, boost::uint32_t first, boost::uint32_t last);
+		/// recursive search
+		/// @return true to stop the branch
+		static bool search(Context& ctx);
+		/// @return true if the branch of a context should stop
+		static bool stopped(Context const& ctx);
+
+		boost::uint32_t m_num_primary; ///< number of primary columns
+		boost::uint32_t m_num_secondary; ///< number of secondary columns
+		Matrix m_matrix; ///< full matrix
+		std::vector<boost::uint32_t> m_vRowBegin; ///< first node of each row, nodes of a row are consecutive
+		boost::int32_t m_threads; ///< number of threads
+};
+
+inline ExactCover::ExactCover(boost::uint32_t numPrimary, boost::uint32_t numSecondary)
+	: m_num_primary(numPrimary)
+	, m_num_secondary(numSecondary)
+	, m_threads(std::numeric_limits<boost::int32_t>::max())
+{
+	boost::uint32_t n = numPrimary+numSecondary+1;
+	m_matrix.vL.resize(n);
+	m_matrix.vR.resize(n);
+	m_matrix.vU.resize(n);
+	m_matrix.vD.resize(n);
+	m_matrix.vC.resize(n);
+	m_matrix.vRow.assign(n, std::numeric_limits<boost::uint32_t>::max());
+	m_matrix.vS.assign(n, 0);
+	for (boost::uint32_t i = 0; i < n; ++i)
+	{
+		m_matrix.vU[i] = m_matrix.vD[i] = m_matrix.vC[i] = i;
+		// primary columns are linked to the root, secondary ones only to themselves
+		if (i <= numPrimary)
+		{
+			m_matrix.vL[i] = (i == 0)? numPrimary : i-1;
+			m_matrix.vR[i] = (i == numPrimary)? 0 : i+1;
+		}
+		else m_matrix.vL[i] = m_matrix.vR[i] = i;
+	}
+	m_vRowBegin.assign(1, n);
+}
+
+template <typename Iterator>
+boost::uint32_t ExactCover::add_row(Iterator first, Iterator last)
+{
+	Matrix& m = m_matrix;
+	boost::uint32_t begin = m.vL.size();
+	for (; first != last; ++first)
+	{
+		boost::uint32_t c = *first+1;
+		limboAssertMsg(c <= num_columns(), "column %u out of range", (unsigned)(c-1));
+		boost::uint32_t id = m.vL.size();
+		// append to the row and to the bottom of the column
+		m.vL.push_back((id == begin)? id : id-1);
+		m.vR.push_back(begin);
+		m.vR[m.vL.back()] = id;
+		m.vL[begin] = id;
+		m.vU.push_back(m.vU[c]);
+		m.vD.push_back(c);
+		m.vD[m.vU[c]] = id;
+		m.vU[c] = id;
+		m.vC.push_back(c);
+		m.vRow.push_back(num_rows());
+		m.vS.push_back(0);
+		++m.vS[c];
+	}
+	m_vRowBegin.push_back(m.vL.size());
+	return num_rows()-1;
+}
+
+inline void ExactCover::Matrix::cover(boost::uint32_t c)
+{
+	vR[vL[c]] = vR[c];
+	vL[vR[c]] = vL[c];
+	for (boost::uint32_t i = vD[c]; i != c; i = vD[i])
+	{
+		for (boost::uint32_t j = vR[i]; j != i; j = vR[j])
+		{
+			vD[vU[j]] = vD[j];
+			vU[vD[j]] = vU[j];
+			--vS[vC[j]];
+		}
+	}
+}
+
+inline void ExactCover::Matrix::uncover(boost::uint32_t c)
+{
+	for (boost::uint32_t i = vU[c]; i != c; i = vU[i])
+	{
+		for (boost::uint32_t j = vL[i]; j != i; j = vL[j])
+		{
+			++vS[vC[j]];
+			vD[vU[j]] = j;
+			vU[vD[j]] = j;
+		}
+	}
+	vR[vL[c]] = c;
+	vL[vR[c]] = c;
+}
+
+inline boost::uint32_t ExactCover::Matrix::choose() const
+{
+	boost::uint32_t best = 0;
+	for (boost::uint32_t c = vR[0]; c != 0; c = vR[c])
+	{
+		if (best == 0 || vS[c] < vS[best])
+		{
+			best = c;
+			if (vS[c] == 0) // dead end
+				break;
+		}
+	}
+	return best;
+}
+
+inline void ExactCover::select(Matrix& m, boost::uint32_t r) const
+{
+	for (boost::uint32_t j = m_vRowBegin[r]; j != m_vRowBegin[r+1]; ++j)
+		m.cover(m.vC[j]);
+}
+
+inline void ExactCover::unselect(Matrix& m, boost::uint32_t r) const
+{
+	for (boost::uint32_t j = m_vRowBegin[r+1]; j != m_vRowBegin[r]; --j)
+		m.uncover(m.vC[j-1]);
+}
+
+inline void ExactCover::split(Pass& pass, boost::uint32_t target) const
+{
+	// a branch is a partial solution; expanding one replaces it by a branch per row of its next column,
+	// so the order of branches stays the order of a serial search
+	std::vector<boost::uint32_t> vPrefix;
+	std::vector<boost::uint32_t> vBegin (2, 0); // the root with an empty partial solution
+	std::vector<boost::uint32_t> vNextPrefix;
+	std::vector<boost::uint32_t> vNextBegin;
+	Matrix m = m_matrix;
+	while (vBegin.size()-1 < target)
+	{
+		vNextPrefix.clear();
+		vNextBegin.assign(1, 0);
+		bool expanded = false;
+		for (boost::uint32_t b = 0; b+1 < vBegin.size(); ++b)
+		{
+			for (boost::uint32_t i = vBegin[b]; i < vBegin[b+1]; ++i)
+				select(m, vPrefix[i]);
+			boost::uint32_t c = m.choose();
+			if (c == 0) // a solution, kept as a branch
+			{
+				vNextPrefix.insert(vNextPrefix.end(), vPrefix.begin()+vBegin[b], vPrefix.begin()+vBegin[b+1]);
+				vNextBegin.push_back(vNextPrefix.size());
+			}
+			else
+			{
+				// a column without rows is a dead end and gives no branch
+				for (boost::uint32_t r = m.vD[c]; r != c; r = m.vD[r])
+				{
+					vNextPrefix.insert(vNextPrefix.end(), vPrefix.begin()+vBegin[b], vPrefix.begin()+vBegin[b+1]);
+					vNextPrefix.push_back(m.vRow[r]);
+					vNextBegin.push_back(vNextPrefix.size());
+				}
+				expanded = true;
+			}
+			for (boost::uint32_t i = vBegin[b+1]; i > vBegin[b]; --i)
+				unselect(m, vPrefix[i-1]);
+		}
+		vPrefix.swap(vNextPrefix);
+		vBegin.swap(vNextBegin);
+		if (!expanded || vBegin.size() == 1)
+			break;
+	}
+
+	pass.vPrefix.swap(vPrefix);
+	pass.vBranch.resize(vBegin.size()-1);
+	for (boost::uint32_t b = 0; b < pass.vBranch.size(); ++b)
+	{
+		pass.vBranch[b].begin = vBegin[b];
+		pass.vBranch[b].end = vBegin[b+1];
+		pass.vBranch[b].count = 0;
+	}
+}
+
+inline void ExactCover::run(Pass& pass) const
+{
+	boost::int32_t numThreads = std::min((boost::int32_t)limbo::containers::num_threads(), m_threads);
+	numThreads = std::max(numThreads, 1);
+	// several branches per thread balance subtrees of different sizes
+	this->split(pass, (numThreads > 1)? 8*numThreads : 1);
+	pass.cover = this;
+	pass.first = std::numeric_limits<boost::uint32_t>::max();
+
+	numThreads = std::max(std::min(numThreads, (boost::int32_t)pass.vBranch.size()), 1);
+	SearchKernel kernel = {&pass};
+	limbo::containers::parallel_for(0, pass.vBranch.size(), 1, numThreads, kernel);
+}
+
+inline void ExactCover::search_branches(Pass& pass, boost::uint32_t first, boost::uint32_t last)
+{
+	ExactCover const& cover = *pass.cover;
+	Context ctx;
+	ctx.matrix = cover.m_matrix;
+	ctx.pass = &pass;
+	for (boost::uint32_t b = first; b < last; ++b)
+	{
+		ctx.branch = b;
+		if (stopped(ctx))
+			continue;
+		Branch const& branch = pass.vBranch[b];
+		ctx.vStack.assign(pass.vPrefix.begin()+branch.begin, pass.vPrefix.begin()+branch.end);
+		for (boost::uint32_t i = branch.begin; i < branch.end; ++i)
+			cover.select(ctx.matrix, pass.vPrefix[i]);
+		search(ctx);
+		for (boost::uint32_t i = branch.end; i > branch.begin; --i)
+			cover.unselect(ctx.matrix, pass.vPrefix[i-1]);
+	}
+}
+
+inline bool ExactCover::stopped(Context const& ctx)
+{
+	Pass const& pass = *ctx.pass;
+	switch (pass.mode)
+	{
+		case FIRST: return *(boost::uint32_t const volatile*)&pass.first <= ctx.branch;
+		case COLLECT: return pass.vBranch[ctx.branch].vSolution.size() >= pass.max_solutions;
+		default: return false;
+	}
+}
+
+inline bool ExactCover::search(Context& ctx)
+{
+	Matrix& m = ctx.matrix;
+	boost::uint32_t c = m.choose();
+	if (c == 0) // all primary columns are covered
+	{
+		Pass& pass = *ctx.pass;
+		Branch& branch = pass.vBranch[ctx.branch];
+		++branch.count;
+		if (pass.mode == FIRST)
+		{
+			branch.vSolution.assign(1, ctx.vStack);
+			// keep the first branch with a solution, later ones stop
+			boost::uint32_t first = pass.first;
+			while (ctx.branch < first)
+			{
+				boost::uint32_t prev = __sync_val_compare_and_swap(&pass.first, first, ctx.branch);
+				if (prev == first)
+					break;
+				first = prev;
+			}
+		}
+		else if (pass.mode == COLLECT)
+			branch.vSolution.push_back(ctx.vStack);
+		return stopped(ctx);
+	}
+	if (m.vS[c] == 0)
+		return false;
+
+	bool stop = false;
+	m.cover(c);
+	for (boost::uint32_t r = m.vD[c]; r != c && !stop; r = m.vD[r])
+	{
+		ctx.vStack.push_back(m.vRow[r]);
+		for (boost::uint32_t j = m.vR[r]; j != r; j = m.vR[j])
+			m.cover(m.vC[j]);
+		stop = search(ctx) || stopped(ctx);
+		for (boost::uint32_t j = m.vL[r]; j != r; j = m.vL[j])
+			m.uncover(m.vC[j]);
+		ctx.vStack.pop_back();
+	}
+	m.uncover(c);
+	return stop;
+}
+
+inline bool ExactCover::solve(solution_type& sol)
+{
+	Pass pass;
+	pass.mode = FIRST;
+	pass.max_solutions = 1;
+	this->run(pass);
+	if (pass.first >= pass.vBranch.size())
+		return false;
+	sol = pass.vBranch[pass.first].vSolution.front();
+	return true;
+}
+
+inline boost::uint64_t ExactCover::count()
+{
+	Pass pass;
+	pass.mode = COUNT;
+	pass.max_solutions = 0;
+	this->run(pass);
+	boost::uint64_t total = 0;
+	for (std::vector<Branch>::const_iterator it = pass.vBranch.begin(); it != pass.vBranch.end(); ++it)
+		total += it->count;
+	return total;
+}
+
+inline std::vector<ExactCover::solution_type> ExactCover::solutions(boost::uint64_t maxSolutions)
+{
+	std::vector<solution_type> vSolution;
+	if (maxSolutions == 0)
+		return vSolution;
+	Pass pass;
+	pass.mode = COLLECT;
+	pass.max_solutions = maxSolutions;
+	this->run(pass);
+	for (std::vector<Branch>::iterator it = pass.vBranch.begin(); it != pass.vBranch.end() && vSolution.size() < maxSolutions; ++it)
+	{
+		boost::uint64_t n = std::min((boost::uint64_t)it->vSolution.size(), maxSolutions-vSolution.size());
+		vSolution.insert(vSolution.end(), it->vSolution.begin(), it->vSolution.begin()+n);
+	}
+	return vSolution;
+}
+
+/// @class limbo::algorithms::ExactAssignment
+/// @brief Assign each item one of its choices, with no two conflicting choices together, as an exact cover.
+///
+/// Each item is a primary column, and each conflict is a secondary column shared by its two choices,
+/// so small coloring or template assignment problems with hard conflicts are solved exactly by @ref ExactCover.
+class ExactAssignment
+{
+	public:
+		/// constructor
+		/// @param numItems number of items
+		explicit ExactAssignment(boost::uint32_t numItems) : m_num_items(numItems), m_num_conflicts(0), m_threads(std::numeric_limits<boost::int32_t>::max()) {}
+
+		/// add a choice of an item
+		/// @param item item
+		/// @return index of the choice
+		boost::uint32_t add_choice(boost::uint32_t item)
+		{
+			limboAssertMsg(item < m_num_items, "item %u out of range", (unsigned)item);
+			m_vItem.push_back(item);
+			m_vConflict.push_back(std::vector<boost::uint32_t>());
+			return m_vItem.size()-1;
+		}
+		/// forbid two choices together
+		/// @param a a choice
+		/// @param b another choice
+		void add_conflict(boost::uint32_t a, boost::uint32_t b)
+		{
+			m_vConflict[a].push_back(m_num_conflicts);
+			m_vConflict[b].push_back(m_num_conflicts);
+			++m_num_conflicts;
+		}
+		/// set number of threads
+		/// @param t number of threads
+		void threads(boost::int32_t t) {m_threads = t;}
+		/// @return item of a choice
+		boost::uint32_t item(boost::uint32_t choice) const {return m_vItem[choice];}
+
+		/// find an assignment
+		/// @param vChoice choice of each item as output
+		/// @return true if an assignment exists
+		bool solve(std::vector<boost::uint32_t>& vChoice) const
+		{
+			ExactCover ec (m_num_items, m_num_conflicts);
+			ec.threads(m_threads);
+			std::vector<boost::uint32_t> vColumn;
+			for (boost::uint32_t i = 0; i < m_vItem.size(); ++i)
+			{
+				vColumn.assign(1, m_vItem[i]);
+				for (std::vector<boost::uint32_t>::const_iterator it = m_vConflict[i].begin(); it != m_vConflict[i].end(); ++it)
+					vColumn.push_back(m_num_items+*it);
+				ec.add_row(vColumn);
+			}
+			ExactCover::solution_type sol;
+			if (!ec.solve(sol))
+				return false;
+			// rows are added in the order of choices
+			vChoice.assign(m_num_items, std::numeric_limits<boost::uint32_t>::max());
+			for (ExactCover::solution_type::const_iterator it = sol.begin(); it != sol.end(); ++it)
+				vChoice[m_vItem[*it]] = *it;
+			return true;
+		}
+
+	protected:
+		boost::uint32_t m_num_items; ///< number of items
+		boost::uint32_t m_num_conflicts; ///< number of conflicts
+		std::vector<boost::uint32_t> m_vItem; ///< item of each choice
+		std::vector<std::vector<boost::uint32_t> > m_vConflict; ///< conflicts of each choice
+		boost::int32_t m_threads; ///< number of threads
+};
+
+} // namespace algorithms
+} // namespace limbo
+
+#endif
@@ -3,6 +3,8 @@
  * @brief  some graph utilities such as compute complement graph and graphviz writer. 
  *
  * These are add-ons for Boost.Graph library. 
+ * Utilities for @ref limbo::algorithms::CsrGraph run on the workers of a @ref limbo::containers::TaskPool, 
+ * including connected components, breadth-first search, degree statistics and vertex orderings for locality. 
  *
  * @author Yibo Lin
  * @date   Feb 2015
@@ -15,8 +17,13 @@
 #include <string>
 #include <algorithm>
 #include <map>
+#include <vector>
+#include <limits>
 #include <boost/graph/graph_concepts.hpp>
 #include <boost/graph/iteration_macros.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/containers/DisjointSet.h>
+#include <limbo/algorithms/CsrGraph.h>
 
 /// namespace for Limbo 
 namespace limbo 
@@ -154,6 +161,412 @@ inline void graphviz2pdf(std::string const& filename, const char* suffix = ".gv"
 	system(cmd);
 }
 
+/// @brief degree statistics of a @ref limbo::algorithms::CsrGraph, see @ref limbo::algorithms::degree_statistics
+struct CsrDegreeStatistics
+{
+    boost::uint32_t numVertices; ///< number of vertices
+    boost::uint32_t minDegree; ///< minimum degree, 0 for a graph without vertices
+    boost::uint32_t maxDegree; ///< maximum degree
+    boost::uint64_t totalDegree; ///< sum of degrees, a self loop counts once
+    boost::uint32_t numIsolated; ///< number of vertices without incident edges
+
+    /// constructor of statistics of a graph without vertices
+    CsrDegreeStatistics() : numVertices(0), minDegree(0), maxDegree(0), totalDegree(0), numIsolated(0) {}
+    /// @return average degree
+    double mean() const {return (numVertices)? (double)totalDegree/numVertices : 0.0;}
+};
+
+/// @cond
+/// @brief number of indices in a block of the parallel loops on graphs
+static const std::size_t csr_utility_grain = 4096;
+
+/// @brief union the end vertices of a block of edges
+template <typename GraphType>
+struct CsrUnionBody
+{
+    GraphType const* g; ///< graph
+    limbo::containers::ConcurrentDisjointSet<boost::uint32_t>* pSet; ///< subsets of vertices
+    /// @nowarn
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        typename GraphType::edge_iterator it = g->edges().first;
+        for (std::size_t i = first; i < last; ++i)
+        {
+            CsrEdgeDescriptor e = *(it+i);
+            pSet->union_set(e.m_source, e.m_target);
+        }
+    }
+    /// @endnowarn
+};
+
+/// @brief find the root of each vertex in a block and count the roots, which are the smallest vertices of components
+struct CsrRootBody
+{
+    limbo::containers::ConcurrentDisjointSet<boost::uint32_t>* pSet; ///< subsets of vertices after all unions
+    boost::uint32_t* vRoot; ///< root of each vertex
+    boost::uint32_t* vCount; ///< number of roots in each block
+    /// @nowarn
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        boost::uint32_t count = 0;
+        for (std::size_t v = first; v < last; ++v)
+        {
+            vRoot[v] = pSet->find_set(v);
+            count += (vRoot[v] == v);
+        }
+        vCount[first/csr_utility_grain] = count;
+    }
+    /// @endnowarn
+};
+
+/// @brief number the roots of a block from the prefix count of roots in the blocks before
+struct CsrRootLabelBody
+{
+    boost::uint32_t const* vRoot; ///< root of each vertex
+    boost::uint32_t const* vOffset; ///< number of roots before each block
+    boost::uint32_t* vComponent; ///< component of each vertex
+    /// @nowarn
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        boost::uint32_t next = vOffset[first/csr_utility_grain];
+        for (std::size_t v = first; v < last; ++v)
+            if (vRoot[v] == v)
+                vComponent[v] = next++;
+    }
+    /// @endnowarn
+};
+
+/// @brief label other vertices of a block with the components of their roots
+struct CsrLabelBody
+{
+    boost::uint32_t const* vRoot; ///< root of each vertex
+    boost::uint32_t* vComponent; ///< component of each vertex, already set for roots
+    /// @nowarn
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t v = first; v < last; ++v)
+            if (vRoot[v] != v)
+                vComponent[v] = vComponent[vRoot[v]];
+    }
+    /// @endnowarn
+};
+
+/// @brief expand a block of the frontier of breadth-first search
+template <typename GraphType>
+struct CsrFrontierBody
+{
+    GraphType const* g; ///< graph
+    boost::uint32_t const* vFrontier; ///< current frontier
+    boost::uint32_t* vDistance; ///< distance of each vertex, maximum value if not reached
+    boost::uint32_t distance; ///< distance of the next frontier
+    std::vector<std::vector<boost::uint32_t> >* mNext; ///< vertices reached by each block
+    /// @nowarn
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        std::vector<boost::uint32_t>& vNext = (*mNext)[first/csr_utility_grain];
+        boost::uint32_t const unreached = std::numeric_limits<boost::uint32_t>::max();
+        for (std::size_t i = first; i < last; ++i)
+        {
+            typename GraphType::adjacency_iterator it, ite;
+            for (boost::tie(it, ite) = g->adjacent_vertices(vFrontier[i]); it != ite; ++it)
+            {
+                // read the distance again from memory, and let one thread claim the vertex
+                if (*(volatile boost::uint32_t const*)&vDistance[*it] == unreached
+                        && __sync_bool_compare_and_swap(&vDistance[*it], unreached, distance))
+                    vNext.push_back(*it);
+            }
+        }
+    }
+    /// @endnowarn
+};
+
+/// @brief degree statistics of a block of vertices
+template <typename GraphType>
+struct CsrDegreeBody
+{
+    GraphType const* g; ///< graph
+    CsrDegreeStatistics* vPartial; ///< statistics of each block
+    /// @nowarn
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        CsrDegreeStatistics& stat = vPartial[first/csr_utility_grain];
+        stat.numVertices = last-first;
+        stat.minDegree = std::numeric_limits<boost::uint32_t>::max();
+        for (std::size_t v = first; v < last; ++v)
+        {
+            boost::uint32_t d = g->degree(v);
+            stat.minDegree = std::min(stat.minDegree, d);
+            stat.maxDegree = std::max(stat.maxDegree, d);
+            stat.totalDegree += d;
+            stat.numIsolated += (d == 0);
+        }
+    }
+    /// @endnowarn
+};
+
+/// @brief Cuthill-McKee ordering of a block of components, each written reversed into its own range
+template <typename GraphType>
+struct CsrCuthillMcKeeBody
+{
+    GraphType const* g; ///< graph
+    boost::uint32_t const* vMember; ///< vertices grouped by components, ascending within a component
+    boost::uint32_t const* vBegin; ///< begin of each component in vMember, with one more entry for the end
+    char* vVisited; ///< whether each vertex is ordered, each component touches its own vertices only
+    boost::uint32_t* vOrder; ///< ordering
+    /// @nowarn
+    bool less(boost::uint32_t u, boost::uint32_t v) const
+    {
+        boost::uint32_t du = g->degree(u), dv = g->degree(v);
+        return (du == dv)? u < v : du < dv;
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        std::vector<boost::uint32_t> vNeighbor;
+        for (std::size_t c = first; c < last; ++c)
+        {
+            // start from a vertex of minimum degree
+            boost::uint32_t start = vMember[vBegin[c]];
+            for (boost::uint32_t i = vBegin[c]+1; i < vBegin[c+1]; ++i)
+                if (less(vMember[i], start))
+                    start = vMember[i];
+            // the ordering is the queue, unvisited neighbors are appended by increasing degree
+            boost::uint32_t head = vBegin[c], tail = vBegin[c];
+            vOrder[tail++] = start;
+            vVisited[start] = 1;
+            while (head < tail)
+            {
+                vNeighbor.clear();
+                typename GraphType::adjacency_iterator it, ite;
+                for (boost::tie(it, ite) = g->adjacent_vertices(vOrder[head++]); it != ite; ++it)
+                {
+                    if (!vVisited[*it])
+                    {
+                        vVisited[*it] = 1;
+                        vNeighbor.push_back(*it);
+                    }
+                }
+                std::sort(vNeighbor.begin(), vNeighbor.end(), CsrDegreeLess(this));
+                std::copy(vNeighbor.begin(), vNeighbor.end(), vOrder+tail);
+                tail += vNeighbor.size();
+            }
+            std::reverse(vOrder+vBegin[c], vOrder+vBegin[c+1]);
+        }
+    }
+    /// @endnowarn
+    /// @brief compare vertices by degree, then by index
+    struct CsrDegreeLess
+    {
+        CsrCuthillMcKeeBody const* body; ///< body with the graph
+        /// @nowarn
+        CsrDegreeLess(CsrCuthillMcKeeBody const* b) : body(b) {}
+        bool operator()(boost::uint32_t u, boost::uint32_t v) const {return body->less(u, v);}
+        /// @endnowarn
+    };
+};
+
+/// @brief map the end vertices of a block of edges to new indices
+template <typename GraphType>
+struct CsrPermuteBody
+{
+    GraphType const* g; ///< graph
+    boost::uint32_t const* vNewIndex; ///< new index of each vertex
+    std::pair<boost::uint32_t, boost::uint32_t>* vEdge; ///< edges with new indices
+    /// @nowarn
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        typename GraphType::edge_iterator it = g->edges().first;
+        for (std::size_t i = first; i < last; ++i)
+        {
+            CsrEdgeDescriptor e = *(it+i);
+            vEdge[i] = std::make_pair(vNewIndex[e.m_source], vNewIndex[e.m_target]);
+        }
+    }
+    /// @endnowarn
+};
+/// @endcond
+
+/// @brief connected components of a CSR graph with threads.
+/// Edges are merged in a lock-free disjoint set, see @ref limbo::containers::ConcurrentDisjointSet,
+/// and components are numbered in the order of their smallest vertices,
+/// the same as a sequential search from vertices in ascending order, regardless of the number of threads.
+/// @tparam WeightType edge weight type
+/// @param g graph
+/// @param vComponent component of each vertex as output
+/// @param pool workers
+/// @return number of components
+template <typename WeightType>
+boost::uint32_t connected_components(CsrGraph<WeightType> const& g, std::vector<boost::uint32_t>& vComponent, limbo::containers::TaskPool& pool)
+{
+    typedef CsrGraph<WeightType> graph_type;
+    std::size_t n = g.num_vertices();
+    vComponent.resize(n);
+    if (n == 0)
+        return 0;
+    limbo::containers::ConcurrentDisjointSet<boost::uint32_t> ds (n);
+    CsrUnionBody<graph_type> unionBody = {&g, &ds};
+    pool.parallel_for(0, g.num_edges(), csr_utility_grain, unionBody);
+
+    std::size_t numBlocks = (n+csr_utility_grain-1)/csr_utility_grain;
+    std::vector<boost::uint32_t> vRoot (n);
+    std::vector<boost::uint32_t> vCount (numBlocks+1, 0);
+    CsrRootBody rootBody = {&ds, &vRoot[0], &vCount[0]};
+    pool.parallel_for(0, n, csr_utility_grain, rootBody);
+    // exclusive prefix sum, the last entry is the number of components
+    boost::uint32_t numComponents = 0;
+    for (std::size_t i = 0; i <= numBlocks; ++i)
+    {
+        boost::uint32_t count = vCount[i];
+        vCount[i] = numComponents;
+        numComponents += count;
+    }
+    CsrRootLabelBody rootLabelBody = {&vRoot[0], &vCount[0], &vComponent[0]};
+    pool.parallel_for(0, n, csr_utility_grain, rootLabelBody);
+    CsrLabelBody labelBody = {&vRoot[0], &vComponent[0]};
+    pool.parallel_for(0, n, csr_utility_grain, labelBody);
+    return numComponents;
+}
+
+/// @brief level-synchronous breadth-first search of a CSR graph with threads.
+/// Blocks of the frontier are expanded in parallel and a vertex is claimed by compare-and-swap of its distance,
+/// so distances do not depend on the number of threads, but the order of vertices within a level may.
+/// @tparam WeightType edge weight type
+/// @param g graph
+/// @param source source vertex
+/// @param vDistance number of edges from \a source to each vertex as output, maximum value of boost::uint32_t if not reachable
+/// @param pool workers
+/// @return number of vertices reached, including \a source
+template <typename WeightType>
+boost::uint32_t breadth_first_distances(CsrGraph<WeightType> const& g, boost::uint32_t source, std::vector<boost::uint32_t>& vDistance, limbo::containers::TaskPool& pool)
+{
+    typedef CsrGraph<WeightType> graph_type;
+    // build the adjacency arrays before sharing the graph
+    g.freeze();
+    vDistance.assign(g.num_vertices(), std::numeric_limits<boost::uint32_t>::max());
+    vDistance[source] = 0;
+    std::vector<boost::uint32_t> vFrontier (1, source);
+    std::vector<std::vector<boost::uint32_t> > mNext;
+    boost::uint32_t numReached = 1;
+    for (boost::uint32_t distance = 1; !vFrontier.empty(); ++distance)
+    {
+        std::size_t numBlocks = (vFrontier.size()+csr_utility_grain-1)/csr_utility_grain;
+        mNext.resize(std::max(mNext.size(), numBlocks));
+        for (std::size_t i = 0; i < numBlocks; ++i)
+            mNext[i].clear();
+        CsrFrontierBody<graph_type> body = {&g, &vFrontier[0], &vDistance[0], distance, &mNext};
+        pool.parallel_for(0, vFrontier.size(), csr_utility_grain, body);
+        vFrontier.clear();
+        for (std::size_t i = 0; i < numBlocks; ++i)
+            vFrontier.insert(vFrontier.end(), mNext[i].begin(), mNext[i].end());
+        numReached += vFrontier.size();
+    }
+    return numReached;
+}
+
+/// @brief degree statistics of a CSR graph with threads
+/// @tparam WeightType edge weight type
+/// @param g graph
+/// @param pool workers
+/// @return statistics
+template <typename WeightType>
+CsrDegreeStatistics degree_statistics(CsrGraph<WeightType> const& g, limbo::containers::TaskPool& pool)
+{
+    typedef CsrGraph<WeightType> graph_type;
+    g.freeze();
+    std::size_t n = g.num_vertices();
+    std::vector<CsrDegreeStatistics> vPartial ((n+csr_utility_grain-1)/csr_utility_grain);
+    CsrDegreeBody<graph_type> body = {&g, (vPartial.empty())? NULL : &vPartial[0]};
+    pool.parallel_for(0, n, csr_utility_grain, body);
+    CsrDegreeStatistics stat;
+    stat.minDegree = (n)? std::numeric_limits<boost::uint32_t>::max() : 0;
+    for (std::size_t i = 0; i < vPartial.size(); ++i)
+    {
+        stat.numVertices += vPartial[i].numVertices;
+        stat.minDegree = std::min(stat.minDegree, vPartial[i].minDegree);
+        stat.maxDegree = std::max(stat.maxDegree, vPartial[i].maxDegree);
+        stat.totalDegree += vPartial[i].totalDegree;
+        stat.numIsolated += vPartial[i].numIsolated;
+    }
+    return stat;
+}
+
+/// @brief order vertices by decreasing degree, ties broken by vertex indices, with a counting sort
+/// @tparam WeightType edge weight type
+/// @param g graph
+/// @param vOrder vertex at each position as output
+template <typename WeightType>
+void degree_order(CsrGraph<WeightType> const& g, std::vector<boost::uint32_t>& vOrder)
+{
+    boost::uint32_t n = g.num_vertices();
+    boost::uint32_t maxDegree = 0;
+    for (boost::uint32_t v = 0; v < n; ++v)
+        maxDegree = std::max(maxDegree, g.degree(v));
+    // bucket i collects vertices of degree maxDegree-i
+    std::vector<boost::uint32_t> vBegin (maxDegree+2, 0);
+    for (boost::uint32_t v = 0; v < n; ++v)
+        ++vBegin[maxDegree-g.degree(v)+1];
+    for (boost::uint32_t i = 1; i < vBegin.size(); ++i)
+        vBegin[i] += vBegin[i-1];
+    vOrder.resize(n);
+    for (boost::uint32_t v = 0; v < n; ++v)
+        vOrder[vBegin[maxDegree-g.degree(v)]++] = v;
+}
+
+/// @brief reverse Cuthill-McKee ordering of a CSR graph, which keeps adjacent vertices close to reduce the bandwidth.
+/// Components are placed in the order of their smallest vertices and ordered by the workers in parallel;
+/// each starts from a vertex of minimum degree and appends unvisited neighbors by increasing degree.
+/// The result does not depend on the number of threads.
+/// @tparam WeightType edge weight type
+/// @param g graph
+/// @param vOrder vertex at each position as output
+/// @param pool workers
+template <typename WeightType>
+void reverse_cuthill_mckee_order(CsrGraph<WeightType> const& g, std::vector<boost::uint32_t>& vOrder, limbo::containers::TaskPool& pool)
+{
+    typedef CsrGraph<WeightType> graph_type;
+    g.freeze();
+    boost::uint32_t n = g.num_vertices();
+    vOrder.resize(n);
+    if (n == 0)
+        return;
+    std::vector<boost::uint32_t> vComponent;
+    boost::uint32_t numComponents = connected_components(g, vComponent, pool);
+    // group vertices by components with a counting sort, ascending within each component
+    std::vector<boost::uint32_t> vBegin (numComponents+1, 0);
+    for (boost::uint32_t v = 0; v < n; ++v)
+        ++vBegin[vComponent[v]+1];
+    for (boost::uint32_t c = 0; c < numComponents; ++c)
+        vBegin[c+1] += vBegin[c];
+    std::vector<boost::uint32_t> vPos (vBegin.begin(), vBegin.end()-1);
+    std::vector<boost::uint32_t> vMember (n);
+    for (boost::uint32_t v = 0; v < n; ++v)
+        vMember[vPos[vComponent[v]]++] = v;
+
+    std::vector<char> vVisited (n, 0);
+    CsrCuthillMcKeeBody<graph_type> body = {&g, &vMember[0], &vBegin[0], &vVisited[0], &vOrder[0]};
+    // small components are grouped to amortize scheduling
+    pool.parallel_for(0, numComponents, 64, body);
+}
+
+/// @brief relabel the vertices of a CSR graph, e.g., with @ref reverse_cuthill_mckee_order for locality of later traversals.
+/// Edge ids and weights are kept, so arrays indexed by edge ids remain valid.
+/// @tparam WeightType edge weight type
+/// @param g graph
+/// @param vOrder vertex of \a g at each position, a permutation of all vertices
+/// @param gp graph with vertex vOrder[i] of \a g as vertex i as output, which must be another object than \a g
+/// @param pool workers
+template <typename WeightType>
+void permute_graph(CsrGraph<WeightType> const& g, std::vector<boost::uint32_t> const& vOrder, CsrGraph<WeightType>& gp, limbo::containers::TaskPool& pool)
+{
+    typedef CsrGraph<WeightType> graph_type;
+    std::vector<boost::uint32_t> vNewIndex (g.num_vertices());
+    for (boost::uint32_t i = 0; i < vOrder.size(); ++i)
+        vNewIndex[vOrder[i]] = i;
+    std::vector<std::pair<boost::uint32_t, boost::uint32_t> > vEdge (g.num_edges());
+    CsrPermuteBody<graph_type> body = {&g, (vNewIndex.empty())? NULL : &vNewIndex[0], (vEdge.empty())? NULL : &vEdge[0]};
+    pool.parallel_for(0, vEdge.size(), csr_utility_grain, body);
+    graph_type(g.num_vertices(), vEdge.begin(), vEdge.end(), g.weights().begin()).swap(gp);
+}
+
 } // namespace algorithms
 } // namespace limbo
 
@@ -1,6 +1,6 @@
 /**
  * @file   MaxClique.h
- * @brief  use boost::bron_kerbosch_all_cliques to find all cliques and the maximum ones 
+ * @brief  find all maximal cliques and the maximum ones 
  * @author Yibo Lin
  * @date   May 2015
  */
@@ -15,7 +15,11 @@ using std::endl;
 using std::vector;
 
 #include <deque>
+#include <algorithm>
+#include <pthread.h>
+#include <boost/cstdint.hpp>
 #include <boost/graph/bron_kerbosch_all_cliques.hpp>
+#include <limbo/containers/TaskPool.h>
 
 /// namespace for Limbo 
 namespace limbo 
@@ -61,7 +65,435 @@ struct max_clique_visitor_type
 	}
 };
 
-/// @brief use boost::bron_kerbosch_all_cliques to find all cliques and the maximum ones 
+/// @class limbo::algorithms::BitsetCliqueSearch
+/// @brief Bron-Kerbosch search of cliques with Tomita pivoting on bitsets, 
+/// following "Listing All Maximal Cliques in Sparse Graphs in Near-optimal Time", 
+/// David Eppstein, Maarten Loffler and Darren Strash, ISAAC 2010. 
+///
+/// Vertices are visited in a degeneracy order. 
+/// The search from a vertex only sees its neighbors, later ones as candidates and earlier ones as excluded, 
+/// so each maximal clique is found once, from its earliest vertex. 
+/// Neighborhoods are bitsets local to the search from each vertex, 
+/// whose size is bounded by the degree instead of the number of vertices. 
+/// Searches from different vertices are taken by threads. 
+/// @tparam GraphType undirected graph type with vertex_index property 
+template <typename GraphType>
+class BitsetCliqueSearch
+{
+	public:
+        /// @nowarn
+		typedef GraphType graph_type;
+		typedef typename boost::graph_traits<graph_type>::vertex_descriptor vertex_descriptor_type; 
+		typedef vector<vertex_descriptor_type> clique_type;
+        /// @endnowarn
+
+		/// constructor 
+		/// @param g graph 
+		BitsetCliqueSearch(graph_type const& g);
+
+		/// set number of threads 
+		/// @param t number of threads 
+		void threads(boost::int32_t t) {m_threads = t;}
+
+		/// report all maximal cliques with at least \a min_size vertices to a visitor; 
+		/// with multiple threads, calls to the visitor are serialized but not ordered 
+		/// @tparam VisitorType visitor with a member function clique(c, g) like @ref limbo::algorithms::max_clique_visitor_type 
+		/// @param vis visitor 
+		/// @param min_size the minimum number of vertices of cliques 
+		template <typename VisitorType>
+		void operator()(VisitorType& vis, size_t min_size);
+		/// @return a clique with the largest number of vertices 
+		clique_type maximum_clique();
+
+	protected:
+		/// search state of a thread 
+		struct Context
+		{
+			vector<boost::int32_t> vLocal; ///< local index of each vertex, -1 if not in the search 
+			vector<boost::uint32_t> vGlobal; ///< vertex of each local index 
+			boost::uint32_t words; ///< number of 64-bit words of local bitsets 
+			vector<boost::uint64_t> vAdj; ///< local neighborhoods 
+			vector<vector<boost::uint64_t> > vPool; ///< candidates and excluded vertices of each depth 
+			vector<boost::uint32_t> vClique; ///< vertices of the current clique 
+		};
+		/// policy to report maximal cliques to a visitor 
+		template <typename VisitorType>
+		struct EnumeratePolicy
+		{
+			BitsetCliqueSearch const& search; ///< search 
+			VisitorType& vis; ///< visitor 
+			size_t min_size; ///< the minimum number of vertices of cliques 
+			pthread_mutex_t lock; ///< serialize calls to the visitor 
+			/// constructor 
+			/// @param s search 
+			/// @param v visitor 
+			/// @param ms the minimum number of vertices of cliques 
+			EnumeratePolicy(BitsetCliqueSearch const& s, VisitorType& v, size_t ms) : search(s), vis(v), min_size(ms) {pthread_mutex_init(&lock, NULL);}
+			/// destructor 
+			~EnumeratePolicy() {pthread_mutex_destroy(&lock);}
+			/// @param size size of the current clique plus candidates 
+			/// @return true if larger cliques from the current one may be reported 
+			bool feasible(size_t size) const {return size >= min_size;}
+			/// @return whether a clique must be maximal to be reported 
+			bool maximal() const {return true;}
+			/// @param vClique vertices of a maximal clique 
+			void report(vector<boost::uint32_t> const& vClique)
+			{
+				clique_type c (vClique.size());
+				for (boost::uint32_t i = 0; i < vClique.size(); ++i)
+					c[i] = search.m_vVertex[vClique[i]];
+				pthread_mutex_lock(&lock);
+				vis.clique(c, search.m_graph);
+				pthread_mutex_unlock(&lock);
+			}
+		};
+		/// policy to find a maximum clique by pruning branches no larger than the best clique 
+		struct MaximumPolicy
+		{
+			volatile size_t best_size; ///< size of the best clique, read without the lock as a bound 
+			vector<boost::uint32_t> vBest; ///< vertices of the best clique 
+			pthread_mutex_t lock; ///< guard of the best clique 
+			/// constructor 
+			MaximumPolicy() : best_size(0) {pthread_mutex_init(&lock, NULL);}
+			/// destructor 
+			~MaximumPolicy() {pthread_mutex_destroy(&lock);}
+			/// @param size size of the current clique plus candidates 
+			/// @return true if a clique larger than the best one may be found 
+			bool feasible(size_t size) const {return size > best_size;}
+			/// @return whether a clique must be maximal to be reported 
+			bool maximal() const {return false;}
+			/// @param vClique vertices of a clique 
+			void report(vector<boost::uint32_t> const& vClique)
+			{
+				pthread_mutex_lock(&lock);
+				if (vClique.size() > best_size)
+				{
+					vBest = vClique;
+					best_size = vClique.size();
+				}
+				pthread_mutex_unlock(&lock);
+			}
+		};
+		/// vertices of the degeneracy order searched by limbo::containers::parallel_for 
+		template <typename PolicyType>
+		struct SearchKernel
+		{
+			BitsetCliqueSearch const* search; ///< search 
+			PolicyType* policy; ///< policy 
+			/// @param b first position in the degeneracy order 
+			/// @param e end position in the degeneracy order 
+			void operator()(std::size_t b, std::size_t e) const {search->search_range(*policy, b, e);}
+		};
+
+		/// compute a degeneracy order by repeatedly removing a vertex of the smallest degree 
+		void degeneracy_order();
+		/// run searches from all vertices with threads 
+		/// @tparam PolicyType @ref EnumeratePolicy or @ref MaximumPolicy 
+		/// @param policy policy 
+		template <typename PolicyType>
+		void run(PolicyType& policy) const;
+		/// search from a range of vertices in the degeneracy order 
+		/// @param policy policy 
+		/// @param first first position 
+		/// @param last end position 
+		template <typename PolicyType>
+		void search_range(PolicyType& policy, boost::uint32_t first, boost::uint32_t last) const;
+		/// build local neighborhoods of the search from a vertex 
+		/// @param pos position of the vertex in the degeneracy order 
+		/// @param ctx search state 
+		/// @return number of later neighbors, which take the lowest local indices 
+		boost::uint32_t build_local(boost::uint32_t pos, Context& ctx) const;
+		/// Bron-Kerbosch recursion with candidates and excluded vertices in ctx.vPool[depth] 
+		/// @param ctx search state 
+		/// @param depth depth of recursion 
+		/// @param policy policy 
+		template <typename PolicyType>
+		void expand(Context& ctx, boost::uint32_t depth, PolicyType& policy) const;
+
+		graph_type const& m_graph; ///< graph 
+		vector<vertex_descriptor_type> m_vVertex; ///< vertex of each index 
+		vector<vector<boost::uint32_t> > m_vAdj; ///< sorted neighbors of each vertex without self loops 
+		vector<boost::uint32_t> m_vOrder; ///< vertices in the degeneracy order 
+		vector<boost::uint32_t> m_vPosition; ///< position of each vertex in the degeneracy order 
+		boost::int32_t m_threads; ///< number of threads 
+};
+
+template <typename GraphType>
+BitsetCliqueSearch<GraphType>::BitsetCliqueSearch(graph_type const& g) 
+	: m_graph(g)
+	, m_vVertex(boost::num_vertices(g))
+	, m_vAdj(boost::num_vertices(g))
+	, m_threads(1)
+{
+	typename boost::graph_traits<graph_type>::vertex_iterator vi, vie;
+	for (boost::tie(vi, vie) = boost::vertices(g); vi != vie; ++vi)
+		m_vVertex[boost::get(boost::vertex_index, g, *vi)] = *vi;
+	typename boost::graph_traits<graph_type>::edge_iterator ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+	{
+		boost::uint32_t s = boost::get(boost::vertex_index, g, boost::source(*ei, g));
+		boost::uint32_t t = boost::get(boost::vertex_index, g, boost::target(*ei, g));
+		if (s == t) continue;
+		m_vAdj[s].push_back(t);
+		m_vAdj[t].push_back(s);
+	}
+	for (boost::uint32_t v = 0; v < m_vAdj.size(); ++v)
+	{
+		std::sort(m_vAdj[v].begin(), m_vAdj[v].end());
+		m_vAdj[v].erase(std::unique(m_vAdj[v].begin(), m_vAdj[v].end()), m_vAdj[v].end());
+	}
+	degeneracy_order();
+}
+
+template <typename GraphType>
+void BitsetCliqueSearch<GraphType>::degeneracy_order()
+{
+	// bucket queue of vertices by remaining degrees 
+	boost::uint32_t n = m_vAdj.size();
+	vector<boost::uint32_t> vDegree (n);
+	boost::uint32_t maxDegree = 0;
+	for (boost::uint32_t v = 0; v < n; ++v)
+	{
+		vDegree[v] = m_vAdj[v].size();
+		maxDegree = std::max(maxDegree, vDegree[v]);
+	}
+	vector<boost::uint32_t> vBin (maxDegree+2, 0);
+	for (boost::uint32_t v = 0; v < n; ++v)
+		++vBin[vDegree[v]+1];
+	for (boost::uint32_t d = 1; d < vBin.size(); ++d)
+		vBin[d] += vBin[d-1];
+	m_vOrder.resize(n);
+	m_vPosition.resize(n);
+	for (boost::uint32_t v = 0; v < n; ++v)
+	{
+		m_vPosition[v] = vBin[vDegree[v]]++;
+		m_vOrder[m_vPosition[v]] = v;
+	}
+	// vBin[d] is the end of bucket d now, shift it back to the begin 
+	for (boost::uint32_t d = vBin.size()-1; d > 0; --d)
+		vBin[d] = vBin[d-1];
+	vBin[0] = 0;
+	for (boost::uint32_t i = 0; i < n; ++i)
+	{
+		boost::uint32_t v = m_vOrder[i];
+		for (vector<boost::uint32_t>::const_iterator it = m_vAdj[v].begin(); it != m_vAdj[v].end(); ++it)
+		{
+			boost::uint32_t u = *it;
+			if (vDegree[u] > vDegree[v])
+			{
+				// move u to the begin of its bucket, then shrink the bucket 
+				boost::uint32_t du = vDegree[u];
+				boost::uint32_t pu = m_vPosition[u];
+				boost::uint32_t pw = vBin[du];
+				boost::uint32_t w = m_vOrder[pw];
+				if (u != w)
+				{
+					std::swap(m_vOrder[pu], m_vOrder[pw]);
+					m_vPosition[u] = pw;
+					m_vPosition[w] = pu;
+				}
+				++vBin[du];
+				--vDegree[u];
+			}
+		}
+	}
+}
+
+template <typename GraphType>
+template <typename VisitorType>
+void BitsetCliqueSearch<GraphType>::operator()(VisitorType& vis, size_t min_size)
+{
+	EnumeratePolicy<VisitorType> policy (*this, vis, min_size);
+	run(policy);
+}
+
+template <typename GraphType>
+typename BitsetCliqueSearch<GraphType>::clique_type BitsetCliqueSearch<GraphType>::maximum_clique()
+{
+	MaximumPolicy policy;
+	run(policy);
+	clique_type c (policy.vBest.size());
+	for (boost::uint32_t i = 0; i < policy.vBest.size(); ++i)
+		c[i] = m_vVertex[policy.vBest[i]];
+	return c;
+}
+
+template <typename GraphType>
+template <typename PolicyType>
+void BitsetCliqueSearch<GraphType>::run(PolicyType& policy) const
+{
+	SearchKernel<PolicyType> kernel = {this, &policy};
+	boost::int32_t numThreads = std::min((boost::int32_t)limbo::containers::num_threads(), m_threads);
+	numThreads = std::max(std::min(numThreads, (boost::int32_t)m_vOrder.size()), 1);
+	// a block builds its own search state of the size of the graph, so threads take a few blocks each 
+	boost::uint32_t grain = std::max((boost::uint32_t)m_vOrder.size()/(numThreads*16), (boost::uint32_t)1);
+	limbo::containers::parallel_for(0, m_vOrder.size(), grain, numThreads, kernel);
+}
+
+template <typename GraphType>
+template <typename PolicyType>
+void BitsetCliqueSearch<GraphType>::search_range(PolicyType& policy, boost::uint32_t first, boost::uint32_t last) const
+{
+	Context ctx;
+	ctx.vLocal.assign(m_vOrder.size(), -1);
+	for (boost::uint32_t pos = first; pos < last; ++pos)
+	{
+		if (!policy.feasible(m_vAdj[m_vOrder[pos]].size()+1))
+			continue;
+		boost::uint32_t numLater = this->build_local(pos, ctx);
+		if (policy.feasible(numLater+1))
+		{
+			ctx.vClique.assign(1, m_vOrder[pos]);
+			this->expand(ctx, 0, policy);
+		}
+		for (vector<boost::uint32_t>::const_iterator it = ctx.vGlobal.begin(); it != ctx.vGlobal.end(); ++it)
+			ctx.vLocal[*it] = -1;
+	}
+}
+
+template <typename GraphType>
+boost::uint32_t BitsetCliqueSearch<GraphType>::build_local(boost::uint32_t pos, Context& ctx) const
+{
+	boost::uint32_t v = m_vOrder[pos];
+	// later neighbors are candidates and take the lowest local indices, earlier ones are excluded 
+	ctx.vGlobal.clear();
+	for (vector<boost::uint32_t>::const_iterator it = m_vAdj[v].begin(); it != m_vAdj[v].end(); ++it)
+		if (m_vPosition[*it] > pos)
+			ctx.vGlobal.push_back(*it);
+	boost::uint32_t numLater = ctx.vGlobal.size();
+	for (vector<boost::uint32_t>::const_iterator it = m_vAdj[v].begin(); it != m_vAdj[v].end(); ++it)
+		if (m_vPosition[*it] < pos)
+			ctx.vGlobal.push_back(*it);
+	boost::uint32_t m = ctx.vGlobal.size();
+	for (boost::uint32_t i = 0; i < m; ++i)
+		ctx.vLocal[ctx.vGlobal[i]] = i;
+
+	ctx.words = (m+63)/64;
+	ctx.vAdj.assign((size_t)m*ctx.words, 0);
+	for (boost::uint32_t i = 0; i < m; ++i)
+	{
+		boost::uint64_t* adj = &ctx.vAdj[(size_t)i*ctx.words];
+		for (vector<boost::uint32_t>::const_iterator it = m_vAdj[ctx.vGlobal[i]].begin(); it != m_vAdj[ctx.vGlobal[i]].end(); ++it)
+		{
+			boost::int32_t j = ctx.vLocal[*it];
+			if (j >= 0)
+				adj[j>>6] |= (boost::uint64_t)1<<(j&63);
+		}
+	}
+	if (ctx.vPool.empty())
+		ctx.vPool.resize(1);
+	vector<boost::uint64_t>& vSet = ctx.vPool[0];
+	vSet.assign(2*ctx.words, 0);
+	for (boost::uint32_t i = 0; i < m; ++i)
+		vSet[(i < numLater)? (i>>6) : ctx.words+(i>>6)] |= (boost::uint64_t)1<<(i&63);
+	return numLater;
+}
+
+template <typename GraphType>
+template <typename PolicyType>
+void BitsetCliqueSearch<GraphType>::expand(Context& ctx, boost::uint32_t depth, PolicyType& policy) const
+{
+	boost::uint32_t const words = ctx.words;
+	if (ctx.vPool.size() <= depth+1)
+		ctx.vPool.resize(depth+2);
+	// P and X of this depth, note vPool may be resized by deeper calls, so index it each time 
+	boost::uint32_t numP = 0;
+	bool emptyX = true;
+	for (boost::uint32_t w = 0; w < words; ++w)
+	{
+		numP += __builtin_popcountll(ctx.vPool[depth][w]);
+		emptyX &= (ctx.vPool[depth][words+w] == 0);
+	}
+	if (numP == 0)
+	{
+		if ((emptyX || !policy.maximal()) && policy.feasible(ctx.vClique.size()))
+			policy.report(ctx.vClique);
+		return;
+	}
+	if (!policy.feasible(ctx.vClique.size()+numP))
+		return;
+
+	// pivot with the most neighbors among candidates 
+	boost::int32_t pivot = -1;
+	boost::uint32_t pivotCount = 0;
+	for (boost::uint32_t w = 0; w < words; ++w)
+	{
+		boost::uint64_t bits = ctx.vPool[depth][w]|ctx.vPool[depth][words+w];
+		while (bits)
+		{
+			boost::uint32_t u = (w<<6)+__builtin_ctzll(bits);
+			bits &= bits-1;
+			boost::uint64_t const* adj = &ctx.vAdj[(size_t)u*words];
+			boost::uint32_t count = 0;
+			for (boost::uint32_t k = 0; k < words; ++k)
+				count += __builtin_popcountll(ctx.vPool[depth][k]&adj[k]);
+			if (pivot < 0 || count > pivotCount)
+			{
+				pivot = u;
+				pivotCount = count;
+			}
+		}
+	}
+
+	// branch on candidates that are not neighbors of the pivot 
+	vector<boost::uint64_t> vBranch (words);
+	boost::uint64_t const* pivotAdj = &ctx.vAdj[(size_t)pivot*words];
+	for (boost::uint32_t w = 0; w < words; ++w)
+		vBranch[w] = ctx.vPool[depth][w]&~pivotAdj[w];
+	for (boost::uint32_t w = 0; w < words; ++w)
+	{
+		while (vBranch[w])
+		{
+			boost::uint32_t v = (w<<6)+__builtin_ctzll(vBranch[w]);
+			vBranch[w] &= vBranch[w]-1;
+			boost::uint64_t const* adj = &ctx.vAdj[(size_t)v*words];
+			vector<boost::uint64_t>& vNext = ctx.vPool[depth+1];
+			vNext.resize(2*words);
+			for (boost::uint32_t k = 0; k < words; ++k)
+			{
+				vNext[k] = ctx.vPool[depth][k]&adj[k];
+				vNext[words+k] = ctx.vPool[depth][words+k]&adj[k];
+			}
+			ctx.vClique.push_back(ctx.vGlobal[v]);
+			expand(ctx, depth+1, policy);
+			ctx.vClique.pop_back();
+			// move v from candidates to excluded vertices 
+			ctx.vPool[depth][w] &= ~((boost::uint64_t)1<<(v&63));
+			ctx.vPool[depth][words+w] |= (boost::uint64_t)1<<(v&63);
+		}
+	}
+}
+
+/// @brief find all maximal cliques with at least \a clique_num vertices by @ref limbo::algorithms::BitsetCliqueSearch 
+/// @tparam GraphType graph type 
+/// @tparam VisitorType visitor with a member function clique(c, g) like @ref limbo::algorithms::max_clique_visitor_type 
+/// @param g graph 
+/// @param vis visitor, each clique is passed to it without being kept 
+/// @param clique_num the minimum number of vertices the cliques contain 
+/// @param threads number of threads, calls to the visitor are serialized but not ordered if more than one 
+template <typename GraphType, typename VisitorType>
+inline void maximal_cliques(GraphType const& g, VisitorType vis, size_t clique_num, boost::int32_t threads = 1)
+{
+	BitsetCliqueSearch<GraphType> search (g);
+	search.threads(threads);
+	search(vis, clique_num);
+}
+
+/// @brief find a clique with the largest number of vertices by @ref limbo::algorithms::BitsetCliqueSearch 
+/// @tparam GraphType graph type 
+/// @param g graph 
+/// @param threads number of threads 
+/// @return vertices of the clique 
+template <typename GraphType>
+inline vector<typename boost::graph_traits<GraphType>::vertex_descriptor>
+maximum_clique(GraphType const& g, boost::int32_t threads = 1)
+{
+	BitsetCliqueSearch<GraphType> search (g);
+	search.threads(threads);
+	return search.maximum_clique();
+}
+
+/// @brief find all maximal cliques with at least \a clique_num vertices 
 /// @tparam GraphType graph type 
 /// @param g graph 
 /// @param clique_num the minimum number of vertices the cliques contain 
@@ -72,7 +504,7 @@ max_clique(GraphType const& g, size_t clique_num)
 {
 	vector<vector<typename boost::graph_traits<GraphType>::vertex_descriptor> > vClique;
 	// search for all cliques with at least clique_num vertices
-	boost::bron_kerbosch_all_cliques(g, max_clique_visitor_type<GraphType>(vClique), clique_num);
+	maximal_cliques(g, max_clique_visitor_type<GraphType>(vClique), clique_num);
 
 	return vClique;
 }
@@ -10,6 +10,7 @@
 
 #include <limbo/algorithms/coloring/Coloring.h>
 #include <limbo/algorithms/coloring/GreedyColoring.h>
+#include <limbo/algorithms/coloring/BipartiteColoring.h>
 
 /// namespace for Limbo 
 namespace limbo 
@@ -22,7 +23,11 @@ namespace coloring
 {
 
 /// @class limbo::algorithms::coloring::BacktrackColoring
-/// Solve graph coloring with backtracking 
+/// Solve graph coloring with backtracking. 
+/// The kernel is specialized for 2, 3 and 4 colors, 
+/// and two colors are tried by @ref limbo::algorithms::coloring::bipartite_coloring first. 
+/// The search can be bounded by @ref max_nodes and the time limit of the base class, 
+/// and then returns the best solution found so far, or a greedy one if no leaf is reached. 
 /// @tparam GraphType graph type 
 template <typename GraphType>
 class BacktrackColoring : public Coloring<GraphType>
@@ -39,15 +44,27 @@ class BacktrackColoring : public Coloring<GraphType>
 		using typename base_type::ColorNumType;
 		typedef typename boost::graph_traits<graph_type>::adjacency_iterator adjacency_iterator_type;
 		typedef typename boost::graph_traits<graph_type>::edge_descriptor edge_descriptor;
+		typedef typename boost::graph_traits<graph_type>::out_edge_iterator out_edge_iterator_type;
         /// @endnowarn
 
 		/// constructor
         /// @param g graph 
 		BacktrackColoring(graph_type const& g) 
 			: base_type(g)
+			, m_max_nodes(0)
+			, m_num_nodes(0)
+			, m_deadline(0)
+			, m_stopped(false)
 		{}
 		/// destructor
 		virtual ~BacktrackColoring() {}
+		/// set the limit of nodes of the recursion tree 
+		/// @param n number of nodes, 0 for no limit 
+		void max_nodes(boost::uint64_t n) {m_max_nodes = n;}
+		/// @return number of nodes of the recursion tree in the last run 
+		boost::uint64_t num_nodes() const {return m_num_nodes;}
+		/// @return true if the last run stopped at the limit of nodes or time, so the solution may not be optimal 
+		bool stopped() const {return m_stopped;}
 	protected:
 		/// @return objective value 
 		virtual double coloring();
@@ -64,11 +81,35 @@ class BacktrackColoring : public Coloring<GraphType>
         /// @param cost_lb cost lower bound 
         /// @param cost_ub cost upper bound 
 		void coloring_kernel(vector<int8_t>& vBestColor, vector<int8_t>& vColor, double& best_cost, double& cur_cost, graph_vertex_type v, double cost_lb, double cost_ub) const;
+		/// kernel function specialized for the number of colors, see @ref coloring_kernel 
+        /// @tparam ColorNum number of colors 
+		template <int8_t ColorNum>
+		void coloring_kernel(vector<int8_t>& vBestColor, vector<int8_t>& vColor, double& best_cost, double& cur_cost, graph_vertex_type v, double cost_lb, double cost_ub) const;
+		/// count a node of the recursion tree 
+		/// @return true if the limit of nodes or time is reached 
+		bool stop() const 
+		{
+			if (m_stopped)
+				return true;
+			++m_num_nodes;
+			if ((m_max_nodes > 0 && m_num_nodes >= m_max_nodes) 
+					|| (m_deadline > 0 && (m_num_nodes&1023) == 0 && ColoringStatistics::wall_time() > m_deadline))
+				m_stopped = true;
+			return m_stopped;
+		}
+
+		boost::uint64_t m_max_nodes; ///< limit of nodes of the recursion tree, 0 for no limit 
+		mutable boost::uint64_t m_num_nodes; ///< number of nodes of the recursion tree 
+		double m_deadline; ///< wall time to stop, 0 for no limit 
+		mutable bool m_stopped; ///< whether the limit of nodes or time is reached 
 };
 
 template <typename GraphType>
 double BacktrackColoring<GraphType>::coloring()
 {
+	// two colors without violations are found in linear time 
+	if (this->color_num() == base_type::TWO && bipartite_coloring(this->m_graph, this->stitch_weight(), this->m_vColor))
+		return 0;
 	/*
 	// init edge costs
 	// For positive edge, cost = 1; for negative edge cost = this->stitch_weight();
@@ -86,6 +127,9 @@ double BacktrackColoring<GraphType>::coloring()
 		std::cout << "weight : " << this->edge_weight(*ei) << std::endl;
 	}
 */
+	m_num_nodes = 0;
+	m_stopped = false;
+	m_deadline = (this->m_time_limit > 0)? ColoringStatistics::wall_time()+this->m_time_limit : 0;
 	vector<int8_t> vBestColor(this->m_vColor.begin(), this->m_vColor.end());
 	vector<int8_t> vColor (this->m_vColor.begin(), this->m_vColor.end());
 	//double best_cost = this->init_coloring(vBestColor);
@@ -111,7 +155,7 @@ double BacktrackColoring<GraphType>::coloring()
                 //<< " best_cost_lb = " << best_cost_lb 
                 //<< std::endl;
 			//if (best_cost == actual_cost)
-            if (best_cost <= tmp_best_cost)
+            if (best_cost <= tmp_best_cost || m_stopped)
 				break;
 			//else best_cost_lb += 1;
             // reset 
@@ -122,6 +166,10 @@ double BacktrackColoring<GraphType>::coloring()
 	else if (best_cost > 0)
         this->coloring_kernel(vBestColor, vColor, best_cost, cur_cost, 0, 0, best_cost);
 
+	// stopped before any leaf 
+	if (best_cost == std::numeric_limits<double>::max())
+		best_cost = this->greedy_coloring(vBestColor);
+
 	// apply coloring solution 
 	this->m_vColor.swap(vBestColor);
 
@@ -158,11 +206,26 @@ double BacktrackColoring<GraphType>::init_coloring(vector<int8_t>& vColor) const
 }
 
 template <typename GraphType>
+void BacktrackColoring<GraphType>::coloring_kernel(vector<int8_t>& vBestColor, vector<int8_t>& vColor, double& best_cost, double& cur_cost, 
+        BacktrackColoring<GraphType>::graph_vertex_type v, double cost_lb, double cost_ub) const 
+{
+	switch (this->color_num())
+	{
+		case base_type::TWO: this->template coloring_kernel<2>(vBestColor, vColor, best_cost, cur_cost, v, cost_lb, cost_ub); break;
+		case base_type::THREE: this->template coloring_kernel<3>(vBestColor, vColor, best_cost, cur_cost, v, cost_lb, cost_ub); break;
+		default: this->template coloring_kernel<4>(vBestColor, vColor, best_cost, cur_cost, v, cost_lb, cost_ub); break;
+	}
+}
+
+template <typename GraphType>
+template <int8_t ColorNum>
 void BacktrackColoring<GraphType>::coloring_kernel(vector<int8_t>& vBestColor, vector<int8_t>& vColor, double& best_cost, double& cur_cost, 
         BacktrackColoring<GraphType>::graph_vertex_type v, double cost_lb, double cost_ub) const 
 {
 	if (best_cost <= cost_lb) // no conflict or reach to lower bound cost  
 		return;
+	if (this->stop())
+		return;
 	if (cur_cost >= best_cost|| cur_cost > cost_ub) // branch and bound 
 		return; 
 	if (v == boost::num_vertices(this->m_graph)) // leaf node in the recursion tree 
@@ -177,8 +240,8 @@ void BacktrackColoring<GraphType>::coloring_kernel(vector<int8_t>& vBestColor, v
 	}
 
 	int8_t color_begin = 0;
-	int8_t color_end = this->m_color_num;
-	if (this->m_vColor[v] >= 0 && this->m_vColor[v] < this->m_color_num) // precolored vertex 
+	int8_t color_end = ColorNum;
+	if (this->m_vColor[v] >= 0 && this->m_vColor[v] < ColorNum) // precolored vertex 
 	{
 		color_begin = this->m_vColor[v];
 		color_end = color_begin+1;
@@ -187,15 +250,14 @@ void BacktrackColoring<GraphType>::coloring_kernel(vector<int8_t>& vBestColor, v
 	{
 		vColor[v] = c;
 		double delta_cost = 0;
-		adjacency_iterator_type vi, vie;
-		for (boost::tie(vi, vie) = boost::adjacent_vertices(v, this->m_graph); vi != vie; ++vi)
+		// out edges carry their weights, so no edge lookup is needed 
+		out_edge_iterator_type ei, eie;
+		for (boost::tie(ei, eie) = boost::out_edges(v, this->m_graph); ei != eie; ++ei)
 		{
-			graph_vertex_type u = *vi;
+			graph_vertex_type u = boost::target(*ei, this->m_graph);
 			if (u < v) // only check parent node in the recursion tree 
 			{
-				std::pair<graph_edge_type, bool> e = boost::edge(u, v, this->m_graph);
-				limboAssertMsg(e.second, "failed to find edge with " << u << "--" << v);
-				edge_weight_type w = boost::get(boost::edge_weight, this->m_graph, e.first);
+				edge_weight_type w = boost::get(boost::edge_weight, this->m_graph, *ei);
 				if (w >= 0) // conflict edge 
             		delta_cost += (vColor[u] == c)*w;
 				else // stitch edge 
@@ -203,7 +265,7 @@ void BacktrackColoring<GraphType>::coloring_kernel(vector<int8_t>& vBestColor, v
 			}
 		}
 		cur_cost += delta_cost;
-		this->coloring_kernel(vBestColor, vColor, best_cost, cur_cost, v+1, cost_lb, cost_ub); // recursion 
+		this->template coloring_kernel<ColorNum>(vBestColor, vColor, best_cost, cur_cost, v+1, cost_lb, cost_ub); // recursion 
 		cur_cost -= delta_cost;
 	}
 }
@@ -0,0 +1,284 @@
+/**
+ * @file   BipartiteColoring.h
+ * @brief  two-coloring by breadth-first search in linear time, with odd cycles as witnesses of conflicts
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_BIPARTITECOLORING
+#define LIMBO_ALGORITHMS_COLORING_BIPARTITECOLORING
+
+#include <limits>
+#include <limbo/algorithms/coloring/Coloring.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+/// @class limbo::algorithms::coloring::BipartiteColoring
+/// Solve graph coloring with two colors by breadth-first search in O(V+E).
+///
+/// A conflict edge asks its vertices to take different colors and a stitch edge asks for the same color,
+/// so each connected component either has a coloring without violations, which is unique up to swapping the colors,
+/// or contains an odd cycle, i.e., a cycle with an odd number of conflict edges.
+/// Components are searched from precolored vertices first, so a component without violations also respects precolors.
+/// For each component with an odd cycle, one is recorded as a witness.
+/// Components with odd cycles or violated precolors are improved by flipping single vertices until no flip reduces the cost.
+///
+/// The solution is optimal if the graph is bipartite under the edges, see @ref bipartite,
+/// and a heuristic otherwise, where exact solvers are needed.
+/// Exact solvers call @ref limbo::algorithms::coloring::bipartite_coloring first for two colors.
+/// @tparam GraphType graph type
+template <typename GraphType>
+class BipartiteColoring : public Coloring<GraphType>
+{
+	public:
+        /// @nowarn
+		typedef Coloring<GraphType> base_type;
+		using typename base_type::graph_type;
+		using typename base_type::graph_vertex_type;
+		using typename base_type::graph_edge_type;
+		using typename base_type::vertex_iterator_type;
+		using typename base_type::edge_iterator_type;
+        using typename base_type::edge_weight_type;
+		using typename base_type::ColorNumType;
+		typedef typename boost::graph_traits<graph_type>::out_edge_iterator out_edge_iterator_type;
+        /// @endnowarn
+
+		/// constructor, the number of colors is two
+        /// @param g graph
+		BipartiteColoring(graph_type const& g)
+			: base_type(g)
+			, m_bipartite(true)
+			, m_vOddCycleBegin(1, 0)
+		{
+			this->m_color_num = base_type::TWO;
+		}
+		/// destructor
+		virtual ~BipartiteColoring() {}
+
+		/// @return true if the last solution has no violated edges
+		bool bipartite() const {return m_bipartite;}
+		/// @return number of odd cycles found, one for each component with any
+		uint32_t num_odd_cycles() const {return m_vOddCycleBegin.size()-1;}
+		/// @param i index of odd cycle
+		/// @param vCycle vertices in the order of the cycle, where the last vertex connects back to the first one
+		void odd_cycle(uint32_t i, std::vector<graph_vertex_type>& vCycle) const
+		{
+			vCycle.assign(m_vOddCycle.begin()+m_vOddCycleBegin[i], m_vOddCycle.begin()+m_vOddCycleBegin[i+1]);
+		}
+	protected:
+		/// @return objective value
+		virtual double coloring();
+		/// @param e edge
+		/// @return 1 if the edge asks for different colors, 0 for the same color, -1 if it costs nothing either way
+		int32_t parity(graph_edge_type const& e) const
+		{
+			edge_weight_type w = this->edge_weight(e);
+			if (w > 0)
+				return 1;
+			else if (w < 0 && this->stitch_weight() > 0)
+				return 0;
+			return -1;
+		}
+		/// record the cycle closed by an edge between two vertices of the search tree
+        /// @param u, v vertices of the edge
+        /// @param vParent parent of each vertex in the search tree
+        /// @param vDepth depth of each vertex in the search tree
+		void add_odd_cycle(graph_vertex_type u, graph_vertex_type v, std::vector<graph_vertex_type> const& vParent, std::vector<uint32_t> const& vDepth);
+		/// flip single vertices in a component until no flip reduces the cost
+        /// @param vVertex vertices of the components
+        /// @param vPrecolor precolors, which are not flipped
+		void improve(std::vector<graph_vertex_type> const& vVertex, std::vector<int8_t> const& vPrecolor);
+
+		bool m_bipartite; ///< true if the last solution has no violated edges
+		std::vector<graph_vertex_type> m_vOddCycle; ///< vertices of odd cycles
+		std::vector<uint32_t> m_vOddCycleBegin; ///< offset of each odd cycle in m_vOddCycle, with an extra one at the end
+};
+
+template <typename GraphType>
+double BipartiteColoring<GraphType>::coloring()
+{
+	limboAssertMsg(this->color_num() == base_type::TWO, "BipartiteColoring only supports two colors");
+	uint32_t num_vertices = boost::num_vertices(this->m_graph);
+	graph_vertex_type invalid = std::numeric_limits<graph_vertex_type>::max();
+	std::vector<int8_t> vPrecolor (this->m_vColor.begin(), this->m_vColor.end());
+	std::vector<int8_t> vSide (num_vertices, -1);
+	std::vector<graph_vertex_type> vParent (num_vertices, invalid);
+	std::vector<uint32_t> vDepth (num_vertices, 0);
+	std::vector<graph_vertex_type> vQueue;
+	vQueue.reserve(num_vertices);
+	std::vector<graph_vertex_type> vViolated;
+
+	m_bipartite = true;
+	m_vOddCycle.clear();
+	m_vOddCycleBegin.assign(1, 0);
+
+	// precolored vertices seed their components, the others follow
+	std::vector<graph_vertex_type> vSeed;
+	vSeed.reserve(num_vertices);
+	for (uint32_t v = 0; v < num_vertices; ++v)
+		if (vPrecolor[v] == 0 || vPrecolor[v] == 1)
+			vSeed.push_back(v);
+	for (uint32_t v = 0; v < num_vertices; ++v)
+		if (vPrecolor[v] != 0 && vPrecolor[v] != 1)
+			vSeed.push_back(v);
+
+	for (typename std::vector<graph_vertex_type>::const_iterator it = vSeed.begin(); it != vSeed.end(); ++it)
+	{
+		graph_vertex_type seed = *it;
+		if (vSide[seed] >= 0)
+			continue;
+		std::size_t head = vQueue.size();
+		vSide[seed] = (vPrecolor[seed] == 1)? 1 : 0;
+		vQueue.push_back(seed);
+		bool violated = false;
+		bool cycled = false;
+		for (std::size_t i = head; i < vQueue.size(); ++i)
+		{
+			graph_vertex_type u = vQueue[i];
+			out_edge_iterator_type ei, eie;
+			for (boost::tie(ei, eie) = boost::out_edges(u, this->m_graph); ei != eie; ++ei)
+			{
+				graph_vertex_type v = boost::target(*ei, this->m_graph);
+				int32_t p = this->parity(*ei);
+				if (v == u || p < 0)
+					continue;
+				int8_t side = vSide[u]^p;
+				if (vSide[v] < 0)
+				{
+					vSide[v] = side;
+					vParent[v] = u;
+					vDepth[v] = vDepth[u]+1;
+					vQueue.push_back(v);
+					// the component takes the colors of the seed, so a different precolor is a violation
+					if ((vPrecolor[v] == 0 || vPrecolor[v] == 1) && vPrecolor[v] != side)
+						violated = true;
+				}
+				else if (vSide[v] != side)
+				{
+					violated = true;
+					if (!cycled)
+						this->add_odd_cycle(u, v, vParent, vDepth);
+					cycled = true;
+				}
+			}
+		}
+		if (violated)
+			vViolated.insert(vViolated.end(), vQueue.begin()+head, vQueue.end());
+	}
+
+	for (uint32_t v = 0; v < num_vertices; ++v)
+		this->m_vColor[v] = (vPrecolor[v] == 0 || vPrecolor[v] == 1)? vPrecolor[v] : vSide[v];
+	if (!vViolated.empty())
+	{
+		m_bipartite = false;
+		this->improve(vViolated, vPrecolor);
+	}
+	return this->calc_cost(this->m_vColor);
+}
+
+template <typename GraphType>
+void BipartiteColoring<GraphType>::add_odd_cycle(graph_vertex_type u, graph_vertex_type v,
+		std::vector<graph_vertex_type> const& vParent, std::vector<uint32_t> const& vDepth)
+{
+	// climb from both ends to the common ancestor, u to the ancestor forward and the rest of v backward
+	std::vector<graph_vertex_type> vBack;
+	while (vDepth[u] > vDepth[v])
+	{
+		m_vOddCycle.push_back(u);
+		u = vParent[u];
+	}
+	while (vDepth[v] > vDepth[u])
+	{
+		vBack.push_back(v);
+		v = vParent[v];
+	}
+	while (u != v)
+	{
+		m_vOddCycle.push_back(u);
+		vBack.push_back(v);
+		u = vParent[u];
+		v = vParent[v];
+	}
+	m_vOddCycle.push_back(u);
+	m_vOddCycle.insert(m_vOddCycle.end(), vBack.rbegin(), vBack.rend());
+	m_vOddCycleBegin.push_back(m_vOddCycle.size());
+}
+
+template <typename GraphType>
+void BipartiteColoring<GraphType>::improve(std::vector<graph_vertex_type> const& vVertex, std::vector<int8_t> const& vPrecolor)
+{
+	// a flip is kept only if it reduces the cost, so the loop terminates
+	std::vector<graph_vertex_type> vQueue (vVertex.begin(), vVertex.end());
+	std::vector<char> vQueued (boost::num_vertices(this->m_graph), false);
+	for (typename std::vector<graph_vertex_type>::const_iterator it = vVertex.begin(); it != vVertex.end(); ++it)
+		vQueued[*it] = true;
+	for (std::size_t i = 0; i < vQueue.size(); ++i)
+	{
+		graph_vertex_type u = vQueue[i];
+		vQueued[u] = false;
+		if (vPrecolor[u] == 0 || vPrecolor[u] == 1)
+			continue;
+		// gain of flipping u, cost of current color minus cost of the other one
+		double gain = 0;
+		out_edge_iterator_type ei, eie;
+		for (boost::tie(ei, eie) = boost::out_edges(u, this->m_graph); ei != eie; ++ei)
+		{
+			graph_vertex_type v = boost::target(*ei, this->m_graph);
+			if (v == u)
+				continue;
+			edge_weight_type w = this->edge_weight(*ei);
+			bool same = (this->m_vColor[u] == this->m_vColor[v]);
+			if (w >= 0)
+				gain += (same)? w : -w;
+			else
+				gain += (same)? w*this->stitch_weight() : -w*this->stitch_weight();
+		}
+		if (gain <= 0)
+			continue;
+		this->m_vColor[u] ^= 1;
+		for (boost::tie(ei, eie) = boost::out_edges(u, this->m_graph); ei != eie; ++ei)
+		{
+			graph_vertex_type v = boost::target(*ei, this->m_graph);
+			if (!vQueued[v])
+			{
+				vQueued[v] = true;
+				vQueue.push_back(v);
+			}
+		}
+	}
+}
+
+/// @brief color a graph with two colors without violated edges in linear time, if such a coloring exists
+/// @param g graph, with conflict edges of non-negative weights and stitch edges of negative weights
+/// @param stitch_weight cost of a violated stitch edge per unit of weight
+/// @param vColor colors of precolored vertices in [0, 2), others are free;
+/// replaced by the coloring if found, unchanged otherwise
+/// @return true if a coloring of cost 0 is found
+template <typename GraphType>
+bool bipartite_coloring(GraphType const& g, double stitch_weight, std::vector<int8_t>& vColor)
+{
+	BipartiteColoring<GraphType> bc (g);
+	bc.stitch_weight(stitch_weight);
+	for (uint32_t v = 0; v < vColor.size(); ++v)
+		if (vColor[v] == 0 || vColor[v] == 1)
+			bc.precolor(v, vColor[v]);
+	bc();
+	if (!bc.bipartite())
+		return false;
+	for (uint32_t v = 0; v < vColor.size(); ++v)
+		vColor[v] = bc.color(v);
+	return true;
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
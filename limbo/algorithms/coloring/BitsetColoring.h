@@ -0,0 +1,307 @@
+/**
+ * @file   BitsetColoring.h
+ * @brief  exact graph coloring of small graphs by branch and bound on adjacency bitmasks
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_BITSETCOLORING
+#define LIMBO_ALGORITHMS_COLORING_BITSETCOLORING
+
+#include <limits>
+#include <limbo/algorithms/coloring/Coloring.h>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+#include <limbo/algorithms/coloring/BipartiteColoring.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+/// @class limbo::algorithms::coloring::BitsetColoring
+/// Solve graph coloring exactly with branch and bound on 64-bit adjacency masks,
+/// which finds the same cost as @ref limbo::algorithms::coloring::BacktrackColoring.
+///
+/// Edges are grouped by weights, and the cost of a color for a vertex is counted by popcounts of
+/// its neighbors in each group against the vertices of that color.
+/// The next vertex is chosen in the way of @ref limbo::algorithms::coloring::DsatColoring,
+/// with the largest saturation degree and then the most uncolored neighbors.
+/// A branch is pruned if its cost plus the smallest cost of each uncolored vertex against colored ones
+/// is no better than the best solution, and colors are tried from the cheapest one.
+/// Without precolored vertices, colors are symmetric, so a vertex only takes used colors or the first unused one.
+///
+/// The kernel is specialized for 2, 3 and 4 colors,
+/// and two colors are tried by @ref limbo::algorithms::coloring::bipartite_coloring first.
+/// Graphs with more than 64 vertices or parallel edges are solved by @ref limbo::algorithms::coloring::BacktrackColoring.
+/// @tparam GraphType graph type
+template <typename GraphType>
+class BitsetColoring : public Coloring<GraphType>
+{
+	public:
+        /// @nowarn
+		typedef Coloring<GraphType> base_type;
+		using typename base_type::graph_type;
+		using typename base_type::graph_vertex_type;
+		using typename base_type::graph_edge_type;
+		using typename base_type::vertex_iterator_type;
+		using typename base_type::edge_iterator_type;
+        using typename base_type::edge_weight_type;
+		using typename base_type::ColorNumType;
+        /// @endnowarn
+
+		/// constructor
+        /// @param g graph
+		BitsetColoring(graph_type const& g)
+			: base_type(g)
+			, m_num_vertices(0)
+			, m_best_cost(0)
+		{}
+		/// destructor
+		virtual ~BitsetColoring() {}
+	protected:
+		/// edges with the same weight
+		struct weight_class_type
+		{
+			double cost; ///< cost of each violated edge
+			bool stitch; ///< true if violated by different colors, otherwise by the same color
+			std::vector<boost::uint64_t> vAdj; ///< neighbors of each vertex
+		};
+
+		/// @return objective value
+		virtual double coloring();
+		/// build adjacency masks
+		/// @return false if the graph is not supported
+		bool build();
+		/// @tparam ColorNum number of colors
+		/// @return objective value
+		template <uint32_t ColorNum>
+		double solve();
+		/// kernel function for branch and bound
+		/// @tparam ColorNum number of colors
+		/// @param vColorMask vertices of each color
+		/// @param assigned colored vertices
+		/// @param used number of colors in use, or ColorNum if colors are not symmetric
+		/// @param cur_cost cost among colored vertices
+		/// @param vColor current coloring solution assignment
+		template <uint32_t ColorNum>
+		void kernel(boost::uint64_t* vColorMask, boost::uint64_t assigned, uint32_t used, double cur_cost, std::vector<int8_t>& vColor);
+		/// @tparam ColorNum number of colors
+		/// @param v vertex
+		/// @param vColorMask vertices of each color
+		/// @param assigned colored vertices
+		/// @param vCost cost of each color for \a v against colored vertices
+		template <uint32_t ColorNum>
+		void color_cost(uint32_t v, boost::uint64_t const* vColorMask, boost::uint64_t assigned, double* vCost) const;
+		/// @param x bitmask
+		/// @return number of set bits
+		static uint32_t popcount(boost::uint64_t x) {return __builtin_popcountll(x);}
+
+		uint32_t m_num_vertices; ///< number of vertices
+		std::vector<weight_class_type> m_vClass; ///< edges grouped by weights
+		std::vector<boost::uint64_t> m_vAdj; ///< neighbors of each vertex through all edges
+		double m_best_cost; ///< best cost
+		std::vector<int8_t> m_vBestColor; ///< best coloring solution assignment
+};
+
+template <typename GraphType>
+double BitsetColoring<GraphType>::coloring()
+{
+	// two colors without violations are found in linear time
+	if (this->color_num() == base_type::TWO && bipartite_coloring(this->m_graph, this->stitch_weight(), this->m_vColor))
+		return 0;
+	if (this->build())
+	{
+		switch (this->color_num())
+		{
+			case 2: return this->template solve<2>();
+			case 3: return this->template solve<3>();
+			case 4: return this->template solve<4>();
+			default: break;
+		}
+	}
+
+	BacktrackColoring<graph_type> bc (this->m_graph);
+	bc.stitch_weight(this->stitch_weight());
+	bc.color_num(this->color_num());
+	for (uint32_t v = 0; v < this->m_vColor.size(); ++v)
+		if (this->m_vColor[v] >= 0 && this->m_vColor[v] < this->color_num())
+			bc.precolor(v, this->m_vColor[v]);
+	double cost = bc();
+	for (uint32_t v = 0; v < this->m_vColor.size(); ++v)
+		this->m_vColor[v] = bc.color(v);
+	return cost;
+}
+
+template <typename GraphType>
+bool BitsetColoring<GraphType>::build()
+{
+	m_num_vertices = boost::num_vertices(this->m_graph);
+	if (m_num_vertices > 64)
+		return false;
+	m_vClass.clear();
+	m_vAdj.assign(m_num_vertices, 0);
+
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
+	{
+		uint32_t s = boost::source(*ei, this->m_graph);
+		uint32_t t = boost::target(*ei, this->m_graph);
+		if (s == t || (m_vAdj[s]>>t)&1) // self loop or parallel edge
+			return false;
+		m_vAdj[s] |= boost::uint64_t(1)<<t;
+		m_vAdj[t] |= boost::uint64_t(1)<<s;
+
+		edge_weight_type w = boost::get(boost::edge_weight, this->m_graph, *ei);
+		weight_class_type wc;
+		wc.stitch = (w < 0);
+		wc.cost = (w < 0)? -w*this->stitch_weight() : w;
+		uint32_t k = 0;
+		for (; k < m_vClass.size(); ++k)
+			if (m_vClass[k].stitch == wc.stitch && m_vClass[k].cost == wc.cost)
+				break;
+		if (k == m_vClass.size())
+		{
+			wc.vAdj.assign(m_num_vertices, 0);
+			m_vClass.push_back(wc);
+		}
+		m_vClass[k].vAdj[s] |= boost::uint64_t(1)<<t;
+		m_vClass[k].vAdj[t] |= boost::uint64_t(1)<<s;
+	}
+	return true;
+}
+
+template <typename GraphType>
+template <uint32_t ColorNum>
+double BitsetColoring<GraphType>::solve()
+{
+	boost::uint64_t vColorMask[ColorNum] = {0};
+	boost::uint64_t assigned = 0;
+	double cur_cost = 0;
+	std::vector<int8_t> vColor (m_num_vertices, -1);
+
+	// precolored vertices are colored first
+	for (uint32_t v = 0; v < m_num_vertices; ++v)
+	{
+		int8_t c = this->m_vColor[v];
+		if (c >= 0 && c < (int8_t)ColorNum)
+		{
+			double vCost[ColorNum];
+			this->template color_cost<ColorNum>(v, vColorMask, assigned, vCost);
+			cur_cost += vCost[c];
+			vColor[v] = c;
+			vColorMask[c] |= boost::uint64_t(1)<<v;
+			assigned |= boost::uint64_t(1)<<v;
+		}
+	}
+
+	m_best_cost = std::numeric_limits<double>::max();
+	m_vBestColor.assign(vColor.begin(), vColor.end());
+	this->template kernel<ColorNum>(vColorMask, assigned, (assigned)? ColorNum : 0, cur_cost, vColor);
+
+	this->m_vColor.assign(m_vBestColor.begin(), m_vBestColor.end());
+	return m_best_cost;
+}
+
+template <typename GraphType>
+template <uint32_t ColorNum>
+void BitsetColoring<GraphType>::color_cost(uint32_t v, boost::uint64_t const* vColorMask, boost::uint64_t assigned, double* vCost) const
+{
+	for (uint32_t c = 0; c < ColorNum; ++c)
+		vCost[c] = 0;
+	for (typename std::vector<weight_class_type>::const_iterator it = m_vClass.begin(); it != m_vClass.end(); ++it)
+	{
+		boost::uint64_t adj = it->vAdj[v];
+		if (it->stitch) // violated by colored neighbors of other colors
+		{
+			uint32_t count = popcount(adj & assigned);
+			for (uint32_t c = 0; c < ColorNum; ++c)
+				vCost[c] += it->cost*(count-popcount(adj & vColorMask[c]));
+		}
+		else // violated by colored neighbors of the same color
+		{
+			for (uint32_t c = 0; c < ColorNum; ++c)
+				vCost[c] += it->cost*popcount(adj & vColorMask[c]);
+		}
+	}
+}
+
+template <typename GraphType>
+template <uint32_t ColorNum>
+void BitsetColoring<GraphType>::kernel(boost::uint64_t* vColorMask, boost::uint64_t assigned, uint32_t used, double cur_cost, std::vector<int8_t>& vColor)
+{
+	boost::uint64_t all = (m_num_vertices == 64)? ~boost::uint64_t(0) : (boost::uint64_t(1)<<m_num_vertices)-1;
+	if (assigned == all) // leaf node in the search tree
+	{
+		if (cur_cost < m_best_cost)
+		{
+			m_best_cost = cur_cost;
+			m_vBestColor.assign(vColor.begin(), vColor.end());
+		}
+		return;
+	}
+
+	// lower bound of uncolored vertices and the next vertex by saturation degree
+	double cost_lb = 0;
+	int32_t best_v = -1;
+	uint32_t best_sat = 0;
+	uint32_t best_degree = 0;
+	double vBestCost[ColorNum];
+	for (boost::uint64_t remain = all & ~assigned; remain; remain &= remain-1)
+	{
+		uint32_t v = __builtin_ctzll(remain);
+		double vCost[ColorNum];
+		this->template color_cost<ColorNum>(v, vColorMask, assigned, vCost);
+		double min_cost = vCost[0];
+		for (uint32_t c = 1; c < ColorNum; ++c)
+			min_cost = std::min(min_cost, vCost[c]);
+		cost_lb += min_cost;
+
+		uint32_t sat = 0;
+		for (uint32_t c = 0; c < ColorNum; ++c)
+			sat += ((m_vAdj[v] & vColorMask[c]) != 0);
+		uint32_t degree = popcount(m_vAdj[v] & ~assigned);
+		if (best_v < 0 || sat > best_sat || (sat == best_sat && degree > best_degree))
+		{
+			best_v = v;
+			best_sat = sat;
+			best_degree = degree;
+			std::copy(vCost, vCost+ColorNum, vBestCost);
+		}
+	}
+	if (cur_cost+cost_lb >= m_best_cost) // branch and bound
+		return;
+
+	// try colors from the cheapest one
+	uint32_t color_end = std::min(used+1, ColorNum);
+	uint32_t vOrder[ColorNum];
+	for (uint32_t c = 0; c < color_end; ++c)
+	{
+		uint32_t i = c;
+		for (; i > 0 && vBestCost[vOrder[i-1]] > vBestCost[c]; --i)
+			vOrder[i] = vOrder[i-1];
+		vOrder[i] = c;
+	}
+	double min_cost = vBestCost[vOrder[0]];
+	boost::uint64_t bit = boost::uint64_t(1)<<best_v;
+	for (uint32_t i = 0; i < color_end; ++i)
+	{
+		uint32_t c = vOrder[i];
+		if (cur_cost+cost_lb-min_cost+vBestCost[c] >= m_best_cost)
+			break;
+		vColor[best_v] = c;
+		vColorMask[c] |= bit;
+		this->template kernel<ColorNum>(vColorMask, assigned|bit, std::max(used, c+1), cur_cost+vBestCost[c], vColor);
+		vColorMask[c] &= ~bit;
+	}
+	vColor[best_v] = -1;
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
@@ -11,8 +11,13 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <algorithm>
+#include <pthread.h>
+#include <boost/cstdint.hpp>
 #include <boost/graph/graph_concepts.hpp>
 #include <boost/graph/subgraph.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/AssertMsg.h>
 #include <limbo/algorithms/MaxIndependentSet.h>
 
 using std::vector;
@@ -179,6 +184,237 @@ class LawlerChromaticNumber
 		}
 };
 
+/// @class limbo::algorithms::coloring::BitsetChromaticNumber
+///
+/// Compute the chromatic number of small graphs by inclusion-exclusion on vertex subsets, 
+/// as in "Set Partitioning via Inclusion-Exclusion", 
+/// Andreas Bjorklund, Thore Husfeldt and Mikko Koivisto, 
+/// SIAM J. Comput., 2009. 
+///
+/// A graph is k-colorable if and only if 
+/// \f$\sum_{S \subseteq V} (-1)^{|V \setminus S|} i(S)^k > 0\f$, 
+/// where \f$i(S)\f$ is the number of independent sets in \f$S\f$. 
+/// \f$i(S)\f$ is counted on bitmasks by \f$i(S) = i(S \setminus \{v\}) + i(S \setminus N[v])\f$. 
+/// Only the lowest table_bits vertices are counted in a table. 
+/// For larger graphs, each subset adds up the table over independent sets of the remaining vertices. 
+/// Sums are computed modulo a prime for all k below a greedy upper bound in one pass, 
+/// with ranges of subsets taken by threads. 
+/// A sum is zero by chance only if the number of colorings is a multiple of the prime. 
+///
+/// Memory is \f$4 \cdot 2^{b}\f$ bytes for b table bits, and time is \f$O(2^n)\f$ times the number of colors, 
+/// so graphs up to about 30 vertices are practical, while @ref LawlerChromaticNumber stops at about 20. 
+/// @tparam GraphType graph type with vertex_index property 
+template <typename GraphType>
+class BitsetChromaticNumber
+{
+	public:
+        /// @nowarn 
+		typedef GraphType graph_type;
+		typedef typename boost::graph_traits<graph_type>::vertex_descriptor graph_vertex_type;
+		typedef typename boost::graph_traits<graph_type>::edge_iterator edge_iterator_type;
+        /// @endnowarn
+
+		/// constructor 
+		BitsetChromaticNumber() : m_threads(1), m_table_bits(24) {}
+
+		/// set number of threads 
+		/// @param t number of threads 
+		void threads(int32_t t) {m_threads = t;}
+		/// set number of vertices counted by the table of independent sets 
+		/// @param b number of vertices 
+		void table_bits(uint32_t b) {m_table_bits = b;}
+
+		/// API for computing chromatic number 
+		/// @param g graph with at most 32 vertices 
+		/// @return chromatic number 
+		int operator()(graph_type const& g) const;
+
+	protected:
+		/// state shared by threads in a pass over all subsets 
+		struct PassType
+		{
+			uint32_t num_vertices; ///< number of vertices 
+			uint32_t table_bits; ///< number of vertices in the table 
+			uint32_t max_colors; ///< largest number of colors tested 
+			std::vector<uint32_t> vTable; ///< number of independent sets in each subset of the table vertices 
+			std::vector<uint32_t> vHighSet; ///< independent sets of the other vertices, shifted to the lowest bits 
+			std::vector<uint32_t> vHighNeighbor; ///< neighbors in the table vertices of each set in vHighSet 
+			uint64_t num_chunks; ///< number of chunks of subsets 
+			uint32_t chunk_bits; ///< log2 of number of subsets in a chunk 
+			std::vector<uint64_t> vSum; ///< sums for each number of colors modulo the prime 
+			pthread_mutex_t lock; ///< guard of vSum 
+		};
+
+		/// @return prime for modular sums 
+		static uint64_t prime() {return 4294967291ULL;}
+		/// color greedily in the order of decreasing degrees 
+		/// @param vAdj adjacency masks 
+		/// @return number of colors 
+		static uint32_t greedy_colors(std::vector<uint32_t> const& vAdj);
+		/// add up subsets in a range of chunks 
+		/// @param pass shared state 
+		/// @param first first chunk 
+		/// @param last end chunk 
+		static void count_covers(PassType& pass, uint64_t first, uint64_t last);
+		/// chunks of a pass run by limbo::containers::parallel_for 
+		struct CoverKernel
+		{
+			PassType* pass; ///< shared state 
+			/// @param b first chunk 
+			/// @param e end chunk 
+			void operator()(std::size_t b, std::size_t e) const {count_covers(*pass, b, e);}
+		};
+
+		int32_t m_threads; ///< number of threads 
+		uint32_t m_table_bits; ///< number of vertices counted by the table 
+};
+
+template <typename GraphType>
+int BitsetChromaticNumber<GraphType>::operator()(graph_type const& g) const
+{
+	uint32_t n = boost::num_vertices(g);
+	limboAssertMsg(n <= 32, "BitsetChromaticNumber supports at most 32 vertices");
+	if (n == 0)
+		return 0;
+
+	std::vector<uint32_t> vAdj (n, 0);
+	bool hasEdge = false;
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+	{
+		uint32_t s = boost::get(boost::vertex_index, g, boost::source(*ei, g));
+		uint32_t t = boost::get(boost::vertex_index, g, boost::target(*ei, g));
+		if (s == t) continue; // self loops are ignored as in LawlerChromaticNumber 
+		vAdj[s] |= (uint32_t)1<<t;
+		vAdj[t] |= (uint32_t)1<<s;
+		hasEdge = true;
+	}
+	if (!hasEdge)
+		return 1;
+	uint32_t upper = greedy_colors(vAdj);
+	if (upper <= 2)
+		return upper;
+
+	PassType pass;
+	pass.num_vertices = n;
+	pass.table_bits = std::min(n, std::max(m_table_bits, (uint32_t)1));
+	pass.max_colors = upper-1;
+	uint32_t tableMask = (pass.table_bits == 32)? ~(uint32_t)0 : ((uint32_t)1<<pass.table_bits)-1;
+
+	// independent sets of the table vertices in each subset 
+	pass.vTable.resize((uint64_t)1<<pass.table_bits);
+	pass.vTable[0] = 1;
+	for (uint64_t s = 1; s < pass.vTable.size(); ++s)
+	{
+		uint32_t v = __builtin_ctz((uint32_t)s);
+		uint32_t rest = (uint32_t)s&((uint32_t)s-1);
+		pass.vTable[s] = pass.vTable[rest]+pass.vTable[rest&~vAdj[v]];
+	}
+	// independent sets of the other vertices 
+	uint32_t highBits = n-pass.table_bits;
+	for (uint32_t t = 0; t < ((uint32_t)1<<highBits); ++t)
+	{
+		bool independent = true;
+		uint32_t neighbor = 0;
+		for (uint32_t i = 0; i < highBits && independent; ++i)
+		{
+			if (t&((uint32_t)1<<i))
+			{
+				independent = ((vAdj[pass.table_bits+i]>>pass.table_bits)&t) == 0;
+				neighbor |= vAdj[pass.table_bits+i]&tableMask;
+			}
+		}
+		if (independent)
+		{
+			pass.vHighSet.push_back(t);
+			pass.vHighNeighbor.push_back(neighbor);
+		}
+	}
+
+	pass.chunk_bits = std::min(pass.table_bits, (uint32_t)16);
+	pass.num_chunks = (uint64_t)1<<(n-pass.chunk_bits);
+	pass.vSum.assign(pass.max_colors+1, 0);
+	pthread_mutex_init(&pass.lock, NULL);
+
+	int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), m_threads);
+	numThreads = (int32_t)std::max(std::min((uint64_t)numThreads, pass.num_chunks), (uint64_t)1);
+	// a few blocks of chunks per thread balance the load, and sums are merged once per block 
+	uint64_t grain = std::max(pass.num_chunks/((uint64_t)numThreads*8), (uint64_t)1);
+	CoverKernel kernel = {&pass};
+	limbo::containers::parallel_for(0, pass.num_chunks, grain, numThreads, kernel);
+	pthread_mutex_destroy(&pass.lock);
+
+	for (uint32_t k = 1; k <= pass.max_colors; ++k)
+		if (pass.vSum[k] != 0)
+			return k;
+	return upper;
+}
+
+template <typename GraphType>
+uint32_t BitsetChromaticNumber<GraphType>::greedy_colors(std::vector<uint32_t> const& vAdj)
+{
+	std::vector<std::pair<int32_t, uint32_t> > vOrder (vAdj.size());
+	for (uint32_t v = 0; v < vAdj.size(); ++v)
+		vOrder[v] = std::make_pair(-__builtin_popcount(vAdj[v]), v);
+	std::sort(vOrder.begin(), vOrder.end());
+	std::vector<uint32_t> vColorSet; // vertices of each color 
+	for (uint32_t i = 0; i < vOrder.size(); ++i)
+	{
+		uint32_t v = vOrder[i].second;
+		uint32_t c = 0;
+		while (c < vColorSet.size() && (vColorSet[c]&vAdj[v]))
+			++c;
+		if (c == vColorSet.size())
+			vColorSet.push_back(0);
+		vColorSet[c] |= (uint32_t)1<<v;
+	}
+	return vColorSet.size();
+}
+
+template <typename GraphType>
+void BitsetChromaticNumber<GraphType>::count_covers(PassType& pass, uint64_t first, uint64_t last)
+{
+	uint64_t const p = prime();
+	uint32_t const chunkSize = (uint32_t)1<<pass.chunk_bits;
+	uint32_t const tableMask = (pass.table_bits == 32)? ~(uint32_t)0 : ((uint32_t)1<<pass.table_bits)-1;
+	std::vector<uint64_t> vSum (pass.max_colors+1, 0);
+	std::vector<uint32_t> vNeighbor; // neighbors of independent sets of the other vertices in the chunk 
+	for (uint64_t chunk = first; chunk < last; ++chunk)
+	{
+		uint64_t begin = chunk<<pass.chunk_bits;
+		// a chunk is within the subsets of one set of the other vertices 
+		uint32_t high = begin>>pass.table_bits;
+		vNeighbor.clear();
+		for (uint32_t i = 0; i < pass.vHighSet.size(); ++i)
+			if ((pass.vHighSet[i]&~high) == 0)
+				vNeighbor.push_back(pass.vHighNeighbor[i]);
+
+		for (uint64_t s = begin; s < begin+chunkSize; ++s)
+		{
+			uint32_t low = (uint32_t)s&tableMask;
+			uint64_t count = 0;
+			for (std::vector<uint32_t>::const_iterator it = vNeighbor.begin(); it != vNeighbor.end(); ++it)
+				count += pass.vTable[low&~*it];
+			count %= p;
+			bool negative = (pass.num_vertices-__builtin_popcount((uint32_t)s))&1;
+			uint64_t power = 1;
+			for (uint32_t k = 1; k <= pass.max_colors; ++k)
+			{
+				power = power*count%p;
+				vSum[k] += negative? p-power : power;
+			}
+		}
+		// at most 2^16 terms below 2^32 are added to each sum, so reduce them once per chunk 
+		for (uint32_t k = 1; k <= pass.max_colors; ++k)
+			vSum[k] %= p;
+	}
+
+	pthread_mutex_lock(&pass.lock);
+	for (uint32_t k = 1; k <= pass.max_colors; ++k)
+		pass.vSum[k] = (pass.vSum[k]+vSum[k])%p;
+	pthread_mutex_unlock(&pass.lock);
+}
+
 } // namespace coloring
 } // namespace algorithms
 } // namespace limbo
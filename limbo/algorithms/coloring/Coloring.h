@@ -10,13 +10,18 @@
 
 #include <fstream>
 #include <vector>
+#include <time.h>
 #include <boost/cstdint.hpp>
 #include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/graph/graph_concepts.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/property_map/property_map.hpp>
 #include <limbo/preprocessor/AssertMsg.h>
+#include <limbo/preprocessor/Instrument.h>
 #include <limbo/algorithms/GraphUtility.h>
+#include <limbo/containers/DisjointSet.h>
+#include <limbo/algorithms/coloring/TabuRefinement.h>
 
 /// namespace for Limbo 
 namespace limbo 
@@ -106,6 +111,51 @@ struct ColoringEdgeLabelWriter : public la::EdgeLabelWriter<GraphType>
     std::string style(edge_descriptor e) const {return (boost::get(boost::edge_weight, this->g, e) >= 0)? "solid" : "dashed";}
 };
 
+/// statistics of the last run of a coloring algorithm, 
+/// collected only if enabled by @ref limbo::algorithms::coloring::Coloring::collect_statistics. 
+/// Times are wall times in seconds. 
+struct ColoringStatistics
+{
+    double stitch_time; ///< grouping vertices connected by stitch edges in @ref limbo::algorithms::coloring::Coloring::operator()
+    double simplify_time; ///< graph simplification 
+    double solve_time; ///< solver, i.e., the coloring algorithm except simplification and recovery 
+    double recover_time; ///< recovery of colors from the simplified graph 
+    double refine_time; ///< tabu refinement after the coloring algorithm 
+    uint32_t num_stitch_edges; ///< number of stitch edges in the stitch groups 
+    uint32_t num_merged_vertices; ///< number of vertices merged by simplification 
+    uint32_t num_hidden_vertices; ///< number of vertices hidden by simplification 
+    uint32_t num_pruned_vertices; ///< number of precolored vertices pruned by simplification 
+    uint32_t num_components; ///< number of components after simplification 
+    uint32_t num_variables; ///< number of variables in ILP, LP or SDP models 
+    uint32_t num_constraints; ///< number of constraints in ILP, LP or SDP models 
+    uint32_t num_iterations; ///< iterations of the solver, e.g., LP rounds or low-rank SDP iterations 
+
+    /// constructor 
+    ColoringStatistics() {reset();}
+    /// clear all statistics 
+    void reset()
+    {
+        stitch_time = simplify_time = solve_time = recover_time = refine_time = 0;
+        num_stitch_edges = num_merged_vertices = num_hidden_vertices = num_pruned_vertices = num_components = 0;
+        num_variables = num_constraints = num_iterations = 0;
+    }
+    /// add up the model sizes and iterations of a solver, e.g., on a component; safe with multiple threads 
+    /// @param rhs statistics of the solver 
+    void add_solver(ColoringStatistics const& rhs)
+    {
+        __sync_fetch_and_add(&num_variables, rhs.num_variables);
+        __sync_fetch_and_add(&num_constraints, rhs.num_constraints);
+        __sync_fetch_and_add(&num_iterations, rhs.num_iterations);
+    }
+    /// @return wall time in seconds, as clock() adds up the time of all threads
+    static double wall_time()
+    {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec+ts.tv_nsec*1e-9;
+    }
+};
+
 /// @class limbo::algorithms::coloring::Coloring
 /// Base class for all coloring algorithms.  
 /// All coloring algorithms support 3 and 4 colors. 
@@ -187,9 +237,36 @@ class Coloring
 		virtual void stitch_weight(double w) {m_stitch_weight = w;}
 
 		/// set number of threads 
-        /// @param t number of threads 
+        /// @param t number of threads, at most @ref limbo::containers::num_threads are used 
 		virtual void threads(int32_t t) {m_threads = t;}
 
+        /// set the time limit of the coloring algorithm; algorithms that support it, e.g., ILPColoring, SatColoring, 
+        /// BacktrackColoring and ComponentColoring, stop at the limit with the best solution found so far, 
+        /// while the others ignore it 
+        /// @param t seconds, 0 for no limit 
+        void time_limit(double t) {m_time_limit = t;}
+        /// @return time limit of the coloring algorithm in seconds, 0 for no limit 
+        double time_limit() const {return m_time_limit;}
+
+        /// set the number of iterations without improvement of tabu refinement after the coloring algorithm, 
+        /// see @ref limbo::algorithms::coloring::TabuRefinement; precolored vertices are kept 
+        /// @param n number of iterations for each connected component, 0 to disable the refinement 
+        void refine_iterations(uint32_t n) {m_refine_iterations = n;}
+        /// @return number of iterations without improvement of tabu refinement, 0 if disabled 
+        uint32_t refine_iterations() const {return m_refine_iterations;}
+        /// set the time limit of tabu refinement 
+        /// @param t seconds, 0 for no limit 
+        void refine_time_limit(double t) {m_refine_time_limit = t;}
+
+        /// set whether to collect @ref limbo::algorithms::coloring::ColoringStatistics in the next runs, 
+        /// no timer is read if disabled 
+        /// @param f flag 
+        void collect_statistics(bool f) {m_collect_statistics = f;}
+        /// @return whether statistics are collected 
+        bool collect_statistics() const {return m_collect_statistics;}
+        /// @return statistics of the last run, all zero if not collected 
+        ColoringStatistics const& statistics() const {return m_statistics;}
+
         /// retrieve coloring solution 
         /// @param v vertex 
 		/// @return coloring solution 
@@ -215,14 +292,7 @@ class Coloring
         /// print edge weight 
         /// @param g graph 
         void print_edge_weight(graph_type const& g) const;
-        
-        // search vertexes in stitch relation
-        // @param v vertex
-        // @param stitch_relatiin_set recording for each vertex indicating the stitch relation
-        // @param visited is visited in DFS
-        // @param stitch_edge_num total stitch edge number in graph
-        void depth_first_search_stitch(graph_vertex_type v, std::vector<int32_t>& stitch_relation_set,
-            std::vector<bool>& visited,uint32_t& stitch_edge_num,int32_t stitch_index);
+
 		// for debug 
         /// write graph in graphviz format 
         /// @param filename output file name 
@@ -235,6 +305,31 @@ class Coloring
 	protected:
 		/// @return objective value 
 		virtual double coloring() = 0;
+        /// group vertices connected by stitch edges with union-find in one sweep over edges, 
+        /// and index the pairs of groups connected by conflict edges 
+        /// @param stitch_edge_num number of stitch edges joining different groups 
+        /// @return false if a conflict edge lies inside a group 
+        bool group_stitch_vertices(uint32_t& stitch_edge_num);
+        /// @param s, t ends of a conflict edge in different groups 
+        /// @return index of the pair of stitch groups of \a s and \a t 
+        int32_t big_edge_index(graph_vertex_type s, graph_vertex_type t) const 
+        {
+            typename boost::unordered_map<uint64_t, int32_t>::const_iterator found = m_hBigEdge.find(big_edge_key(m_stitch_relation_set[s], m_stitch_relation_set[t]));
+            limboAssert(found != m_hBigEdge.end());
+            return found->second;
+        }
+        /// @brief find a clique of conflict edges greedily from the vertex of the largest degree, up to the number of colors; 
+        /// without precolored vertices, colors are symmetric, so the i-th vertex of the clique can take a color no larger than i 
+        /// @param vClique vertices of the clique in the order of insertion 
+        void symmetry_clique(std::vector<graph_vertex_type>& vClique) const; 
+        /// @brief color vertices without valid colors greedily and refine the solution by a short tabu search, 
+        /// see @ref limbo::algorithms::coloring::TabuRefinement; for algorithms stopped at the time limit before any solution 
+        /// @param vColor coloring solution, colors in [0, color_num) are kept 
+        /// @return cost 
+        double greedy_coloring(std::vector<int8_t>& vColor) const; 
+        /// @param a, b stitch groups 
+        /// @return key of an unordered pair of groups 
+        static uint64_t big_edge_key(uint32_t a, uint32_t b) {return (a < b)? ((uint64_t)a<<32)|b : ((uint64_t)b<<32)|a;}
 
 		graph_type const& m_graph; ///< initial graph 
 		std::vector<int8_t> m_vColor; ///< coloring solutions 
@@ -243,14 +338,16 @@ class Coloring
     double m_stitch_weight; ///< stitch weight 
     int32_t m_threads; ///< control number of threads for ILP solver 
     bool m_has_precolored; ///< whether contain precolored vertices 
-
-    // node num in big graph
-    int32_t m_stitch_index;
-    // edge num in big graph
-    int32_t m_big_edge_num;
-    std::vector<int32_t> m_stitch_relation_set;
-    //a verctor of len(stitch_index*stitch_index) 
-    std::vector<int32_t> m_edge_index_vector;
+    bool m_collect_statistics; ///< whether to collect statistics 
+    double m_time_limit; ///< time limit of the coloring algorithm in seconds, 0 for no limit 
+    uint32_t m_refine_iterations; ///< iterations without improvement of tabu refinement, 0 if disabled 
+    double m_refine_time_limit; ///< time limit of tabu refinement in seconds, 0 for no limit 
+    ColoringStatistics m_statistics; ///< statistics of the last run 
+
+    int32_t m_stitch_index; ///< number of stitch groups, i.e., vertices of the graph with stitch edges contracted 
+    int32_t m_big_edge_num; ///< number of pairs of stitch groups connected by conflict edges 
+    std::vector<int32_t> m_stitch_relation_set; ///< stitch group of each vertex, numbered by the first vertex of each group 
+    boost::unordered_map<uint64_t, int32_t> m_hBigEdge; ///< index of each pair of stitch groups connected by conflict edges 
 };
 
 template <typename GraphType>
@@ -261,6 +358,10 @@ Coloring<GraphType>::Coloring(Coloring<GraphType>::graph_type const& g)
     , m_stitch_weight(0.1)
     , m_threads(std::numeric_limits<int32_t>::max())
     , m_has_precolored(false)
+    , m_collect_statistics(false)
+    , m_time_limit(0)
+    , m_refine_iterations(0)
+    , m_refine_time_limit(0)
     , m_stitch_index(0)
     , m_big_edge_num(0)
 {}
@@ -268,67 +369,46 @@ Coloring<GraphType>::Coloring(Coloring<GraphType>::graph_type const& g)
 template <typename GraphType>
 double Coloring<GraphType>::operator()()
 {
+    limboScopedTimer("Coloring");
+    limboHistogramAdd("Coloring::vertices", boost::num_vertices(m_graph));
     double cost ;
     uint32_t stitch_edge_num = 0;
-    //total wo-stitch node number
-    
-    //parent node in non-stitch graph index of each node in stitch graph
-
-
-    //Step 1. Firstly, count the number of stitch edges and store all of the stitch relations
-    vertex_iterator_type vi, vie,next;
-    boost::tie(vi, vie) = vertices(m_graph);
-    std::vector<bool> visited(boost::num_vertices(m_graph), false);
-    m_stitch_relation_set.assign(boost::num_vertices(m_graph),-1);
-    for (next = vi; vi != vie; vi = next)
+    double start = 0;
+    if (m_collect_statistics)
     {
-        ++next;
-        graph_vertex_type v = *vi;
-        if(visited[(int32_t)v]) continue;
-        else{
-            visited[(int32_t)v] = true;
-            m_stitch_relation_set[(int32_t)v] = m_stitch_index;
-            depth_first_search_stitch(v,m_stitch_relation_set,visited,stitch_edge_num,m_stitch_index);
-            m_stitch_index ++;
-        }
+        m_statistics.reset();
+        start = ColoringStatistics::wall_time();
     }
+    //Step 1. Group vertices connected by stitch edges, 
+    // and verify the feasibility of this method (no conflict should be introduced when inserting stitch)
+    bool is_legal = this->group_stitch_vertices(stitch_edge_num);
+    limboCounterAdd("Coloring::stitch edges", stitch_edge_num);
 
-
-    m_edge_index_vector.assign(m_stitch_index*m_stitch_index,-1);
-    bool is_legal = true;
-
-    //Step 2. Verify the feasibility of this method(no conflict should be introduced when inserting stitch)
-    // Also, record the edge_index_vector
-    boost::tie(vi, vie) = vertices(m_graph);
-    for (next = vi; vi != vie; vi = next)
+    if (m_collect_statistics)
     {
-        ++next;
-        graph_vertex_type v = *vi;
-        adjacency_iterator vi2, vie2,next2;
-        boost::tie(vi2, vie2) = boost::adjacent_vertices(v, m_graph);
-        for (next2 = vi2; vi2 != vie2; vi2 = next2){
-            ++next2; 
-            graph_vertex_type v2 = *vi2;
-            std::pair<graph_edge_type, bool> e12 = boost::edge(v, v2, m_graph);
-            limboAssert(e12.second);
-            if(boost::get(boost::edge_weight, m_graph, e12.first) > 0){
-                //if the big_edge is not considered, consider it and add 1
-                if(m_edge_index_vector[m_stitch_relation_set[(int32_t)v]*m_stitch_index + m_stitch_relation_set[(int32_t)v2]] == -1){
-                    m_edge_index_vector[m_stitch_relation_set[(int32_t)v]*m_stitch_index + m_stitch_relation_set[(int32_t)v2]] = m_big_edge_num;
-                    m_big_edge_num++;
-                }
-            }
-            if (boost::get(boost::edge_weight, m_graph, e12.first) > 0 && m_stitch_relation_set[(int32_t)v] == m_stitch_relation_set[(int32_t)v2])  is_legal = false;
-        }
+        double stitch_end = ColoringStatistics::wall_time();
+        m_statistics.stitch_time = stitch_end-start;
+        m_statistics.num_stitch_edges = stitch_edge_num;
+        start = stitch_end;
     }
-    //Step 3. Assign the colors 
+    // precolors are kept by the refinement, as the algorithm overwrites them 
+    std::vector<char> vFixed; 
+    if (m_refine_iterations > 0 && m_has_precolored)
+    {
+        vFixed.resize(m_vColor.size()); 
+        for (uint32_t v = 0; v < m_vColor.size(); ++v)
+            vFixed[v] = (m_vColor[v] >= 0 && m_vColor[v] < color_num()); 
+    }
+    //Step 2. Assign the colors 
     std::vector<int32_t> stitch_relation_to_color(m_stitch_index,-1);
     std::vector<bool> unused_color(color_num(),true);
 
 
-    if (boost::num_vertices(m_graph) <= color_num()+stitch_edge_num && is_legal) // if vertex number is no larger than color number, directly assign color
+    // if vertex number is no larger than color number, directly assign color; 
+    // precolored vertices may conflict with each other, so they are left to the algorithm 
+    if (boost::num_vertices(m_graph) <= color_num()+stitch_edge_num && is_legal && !m_has_precolored)
     {
-        //Step 3.1: Assign pre-defined color firstly
+        //Step 2.1: Assign pre-defined color firstly
         limboAssert(m_stitch_index <= color_num());
         for (int32_t i = 0, ie = m_vColor.size(); i != ie; ++i)
         {
@@ -339,7 +419,7 @@ double Coloring<GraphType>::operator()()
             }
         }
 
-        //Step 3.2: Assign un-pre-defined color and keep colors of stitch vertexes same.
+        //Step 2.2: Assign un-pre-defined color and keep colors of stitch vertexes same.
         for (int32_t i = 0, ie = m_vColor.size(); i != ie; ++i)
         {
             if (m_vColor[i] < 0) // if not precolored, assign to an unused color
@@ -361,37 +441,145 @@ double Coloring<GraphType>::operator()()
             }
         }
         cost = calc_cost(m_vColor);
-        std::cout<<"Heustical calcuted";
         limboAssert(cost == 0);
     }
     else // perform coloring algorithm 
+    {
+        limboScopedTimer("coloring");
         cost = this->coloring();
-        std::cout<<"selected coloring solver calcuted"<<cost;
-    // clock_t sub_comp_end = clock();
+    }
+    if (m_collect_statistics) // simplification and recovery are recorded by the algorithm if any 
+    {
+        double solve_end = ColoringStatistics::wall_time(); 
+        m_statistics.solve_time = solve_end-start-m_statistics.simplify_time-m_statistics.recover_time;
+        start = solve_end; 
+    }
+    //Step 3. Refine the solution of any algorithm 
+    if (m_refine_iterations > 0 && cost > 0)
+    {
+        limboScopedTimer("refine");
+        TabuRefinement<graph_type> tr (m_graph, color_num(), stitch_weight()); 
+        tr.max_iterations(m_refine_iterations); 
+        tr.time_limit(m_refine_time_limit); 
+        tr.threads(m_threads); 
+        tr.fixed(vFixed); 
+        cost = tr(m_vColor); 
+        if (m_collect_statistics)
+            m_statistics.refine_time = ColoringStatistics::wall_time()-start; 
+    }
     return cost;
 }
 
 template <typename GraphType>
-void Coloring<GraphType>::depth_first_search_stitch(graph_vertex_type v, std::vector<int32_t>& stitch_relation_set,\
-std::vector<bool>& visited,uint32_t& stitch_edge_num, int32_t stitch_index)
+bool Coloring<GraphType>::group_stitch_vertices(uint32_t& stitch_edge_num)
 {
-    adjacency_iterator vi2, vie2,next2;
-    boost::tie(vi2, vie2) = boost::adjacent_vertices(v, m_graph);
-    for (next2 = vi2; vi2 != vie2; vi2 = next2){
-        ++next2; 
-        graph_vertex_type v2 = *vi2;
-        if(visited[(int32_t)v2])    continue;
-        std::pair<graph_edge_type, bool> e12 = boost::edge(v, v2, m_graph);
-        limboAssert(e12.second);
-        if (boost::get(boost::edge_weight, m_graph, e12.first) < 0) {
-            visited[(int32_t)v2] = true;
-            stitch_edge_num ++;
-            stitch_relation_set[(int32_t)v2] = stitch_index;
-            depth_first_search_stitch(v2,stitch_relation_set,visited,stitch_edge_num,stitch_index);
+    typedef limbo::containers::DisjointSet::SubsetHelper<uint32_t, uint32_t> subset_helper_type;
+    uint32_t num_vertices = boost::num_vertices(m_graph);
+    std::vector<uint32_t> vParent (num_vertices);
+    std::vector<uint32_t> vRank (num_vertices);
+    subset_helper_type gp (vParent, vRank);
+
+    // union by rank keeps trees shallow, so finding a set never recurses deeply 
+    edge_iterator_type ei, eie;
+    stitch_edge_num = 0;
+    for (boost::tie(ei, eie) = boost::edges(m_graph); ei != eie; ++ei)
+    {
+        if (boost::get(boost::edge_weight, m_graph, *ei) >= 0)
+            continue;
+        uint32_t s = boost::source(*ei, m_graph);
+        uint32_t t = boost::target(*ei, m_graph);
+        if (limbo::containers::DisjointSet::find_set(gp, s) != limbo::containers::DisjointSet::find_set(gp, t))
+        {
+            limbo::containers::DisjointSet::union_set(gp, s, t);
+            ++stitch_edge_num;
         }
     }
+
+    // number groups in the order of their first vertices 
+    std::vector<int32_t> vRootIndex (num_vertices, -1);
+    m_stitch_relation_set.resize(num_vertices);
+    m_stitch_index = 0;
+    for (uint32_t v = 0; v < num_vertices; ++v)
+    {
+        uint32_t root = limbo::containers::DisjointSet::find_set(gp, v);
+        if (vRootIndex[root] < 0)
+            vRootIndex[root] = m_stitch_index++;
+        m_stitch_relation_set[v] = vRootIndex[root];
+    }
+
+    // unordered pairs of groups connected by conflict edges are indexed in the order of edges 
+    bool is_legal = true;
+    m_hBigEdge.clear();
+    m_big_edge_num = 0;
+    for (boost::tie(ei, eie) = boost::edges(m_graph); ei != eie; ++ei)
+    {
+        if (boost::get(boost::edge_weight, m_graph, *ei) <= 0)
+            continue;
+        int32_t a = m_stitch_relation_set[boost::source(*ei, m_graph)];
+        int32_t b = m_stitch_relation_set[boost::target(*ei, m_graph)];
+        if (a == b)
+            is_legal = false;
+        else if (m_hBigEdge.insert(std::make_pair(big_edge_key(a, b), m_big_edge_num)).second)
+            ++m_big_edge_num;
+    }
+    return is_legal;
 }
 
+template <typename GraphType>
+double Coloring<GraphType>::greedy_coloring(std::vector<int8_t>& vColor) const
+{
+    TabuRefinement<graph_type> tr (m_graph, color_num(), stitch_weight()); 
+    std::vector<char> vFixed (vColor.size()); 
+    for (uint32_t v = 0; v < vColor.size(); ++v)
+        vFixed[v] = (vColor[v] >= 0 && vColor[v] < color_num()); 
+    tr.initial_coloring(vColor); 
+    tr.max_iterations(1000); 
+    tr.fixed(vFixed); 
+    return tr(vColor); 
+}
+
+template <typename GraphType>
+void Coloring<GraphType>::symmetry_clique(std::vector<typename Coloring<GraphType>::graph_vertex_type>& vClique) const
+{
+    typedef typename boost::graph_traits<graph_type>::out_edge_iterator out_edge_iterator_type; 
+    uint32_t vertex_num = boost::num_vertices(this->m_graph); 
+    vClique.clear(); 
+    if (vertex_num == 0)
+        return; 
+    // degrees of conflict edges 
+    std::vector<uint32_t> vDegree (vertex_num, 0); 
+    edge_iterator_type ei, eie;
+    for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
+    {
+        if (boost::get(boost::edge_weight, this->m_graph, *ei) > 0)
+        {
+            ++vDegree[boost::source(*ei, this->m_graph)]; 
+            ++vDegree[boost::target(*ei, this->m_graph)]; 
+        }
+    }
+    vClique.push_back(std::max_element(vDegree.begin(), vDegree.end())-vDegree.begin()); 
+    // candidates are the neighbors of all vertices in the clique, counted by the number of clique vertices they are adjacent to 
+    std::vector<uint32_t> vCount (vertex_num, 0); 
+    while (vClique.size() < (uint32_t)this->m_color_num)
+    {
+        graph_vertex_type u = vClique.back(); 
+        out_edge_iterator_type oi, oie; 
+        for (boost::tie(oi, oie) = boost::out_edges(u, this->m_graph); oi != oie; ++oi)
+        {
+            graph_vertex_type v = boost::target(*oi, this->m_graph); 
+            // parallel edges count once 
+            if (v != u && boost::get(boost::edge_weight, this->m_graph, *oi) > 0 && vCount[v] == vClique.size()-1)
+                ++vCount[v]; 
+        }
+        int32_t best = -1; 
+        for (uint32_t v = 0; v < vertex_num; ++v)
+            if (vCount[v] == vClique.size() && (best < 0 || vDegree[v] > vDegree[best]))
+                best = v; 
+        if (best < 0)
+            break; 
+        vClique.push_back(best); 
+    }
+}
 
 template <typename GraphType>
 typename Coloring<GraphType>::edge_weight_type Coloring<GraphType>::calc_cost(std::vector<int8_t> const& vColor) const 
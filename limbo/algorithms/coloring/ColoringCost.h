@@ -0,0 +1,313 @@
+/**
+ * @file   ColoringCost.h
+ * @brief  cost evaluation of coloring solutions on flat edge lists, with delta cost of recoloring single vertices
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_COLORINGCOST
+#define LIMBO_ALGORITHMS_COLORING_COLORINGCOST
+
+#include <vector>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+using boost::uint32_t;
+using boost::int32_t;
+using boost::int8_t;
+
+/// @class limbo::algorithms::coloring::ColoringCost
+/// Evaluate the cost of coloring solutions in the same way as @ref limbo::algorithms::coloring::Coloring::calc_cost,
+/// for graphs whose solutions are evaluated many times.
+///
+/// Conflict edges and stitch edges are kept in separate flat arrays of ends and weights.
+/// Colors of both ends are gathered into small buffers,
+/// so the comparison and accumulation run over contiguous arrays without branches and can be vectorized by the compiler.
+/// Edges are split into fixed blocks taken by threads, and the sums of blocks are added up in order,
+/// so the result does not depend on the number of threads.
+/// The adjacency of each vertex is kept as well, so the cost change of recoloring a vertex costs its degree.
+/// @tparam GraphType graph type
+template <typename GraphType>
+class ColoringCost
+{
+	public:
+        /// @nowarn
+		typedef GraphType graph_type;
+		typedef typename boost::graph_traits<graph_type>::edge_iterator edge_iterator_type;
+		typedef typename boost::property_traits<typename boost::property_map<graph_type, boost::edge_weight_t>::const_type>::value_type edge_weight_type;
+        /// @endnowarn
+
+		/// cost of a coloring solution
+		struct result_type
+		{
+			double cost; ///< total cost
+			uint32_t conflicts; ///< number of conflict edges whose ends share the same color
+			uint32_t stitches; ///< number of stitch edges whose ends have different colors
+
+			/// constructor
+			result_type() : cost(0), conflicts(0), stitches(0) {}
+		};
+
+		/// constructor
+		/// @param g graph, non-negative weights for conflict edges and negative weights for stitch edges
+		/// @param stitch_weight weight of stitches
+		ColoringCost(graph_type const& g, double stitch_weight);
+
+		/// set number of threads
+		/// @param t number of threads
+		void threads(int32_t t) {m_threads = t;}
+		/// @return number of conflict edges, self edges excluded
+		uint32_t num_conflict_edges() const {return m_vConflictWeight.size();}
+		/// @return number of stitch edges, self edges excluded
+		uint32_t num_stitch_edges() const {return m_vStitchWeight.size();}
+		/// @return number of vertices
+		uint32_t num_vertices() const {return m_num_vertices;}
+		/// @name adjacency of vertices for local search
+		/// neighbors of vertex v are in [adjacency_begin(v), adjacency_end(v))
+		///@{
+		/// @return offset of the first neighbor of a vertex
+		uint32_t adjacency_begin(uint32_t v) const {return m_vAdjBegin[v];}
+		/// @return offset after the last neighbor of a vertex
+		uint32_t adjacency_end(uint32_t v) const {return m_vAdjBegin[v+1];}
+		/// @return neighbor at an offset
+		uint32_t neighbor(uint32_t i) const {return m_vAdj[i];}
+		/// @return cost of the conflict edge at an offset, or negative cost of the stitch edge
+		double neighbor_cost(uint32_t i) const {return m_vAdjCost[i];}
+		///@}
+
+		/// @param vColor coloring solution
+		/// @return cost of \a vColor
+		double operator()(std::vector<int8_t> const& vColor) const {return this->evaluate(vColor).cost;}
+		/// @param vColor coloring solution
+		/// @return cost and violated edges of \a vColor
+		result_type evaluate(std::vector<int8_t> const& vColor) const;
+		/// @param vColor coloring solution
+		/// @param v vertex
+		/// @param c new color of \a v
+		/// @return change of cost if \a v is recolored to \a c
+		double delta(std::vector<int8_t> const& vColor, uint32_t v, int8_t c) const;
+		/// recolor a vertex
+		/// @param vColor coloring solution
+		/// @param v vertex
+		/// @param c new color of \a v
+		/// @return change of cost
+		double recolor(std::vector<int8_t>& vColor, uint32_t v, int8_t c) const
+		{
+			double d = this->delta(vColor, v, c);
+			vColor[v] = c;
+			return d;
+		}
+
+	protected:
+		/// edges in a block of the reduction
+		static const uint32_t block_size = 1<<16;
+		/// edges whose colors are gathered at a time
+		static const uint32_t chunk_size = 256;
+
+		/// blocks of a reduction run by limbo::containers::parallel_for
+		struct reduce_task_type
+		{
+			ColoringCost const* pCost; ///< this object
+			std::vector<int8_t> const* pColor; ///< coloring solution
+			result_type* pBlock; ///< result of each block
+			/// @param b first edge of a block
+			/// @param e end edge of the block
+			void operator()(std::size_t b, std::size_t e) const {pCost->evaluate_range(*pColor, b, e, pBlock[b/block_size]);}
+		};
+
+		/// evaluate a range of edges
+		/// @param vColor coloring solution
+		/// @param first, last range of edges, conflict edges first and then stitch edges
+		/// @param result result to add up
+		void evaluate_range(std::vector<int8_t> const& vColor, uint32_t first, uint32_t last, result_type& result) const;
+
+		uint32_t m_num_vertices; ///< number of vertices
+		std::vector<uint32_t> m_vConflictSource; ///< source of each conflict edge
+		std::vector<uint32_t> m_vConflictTarget; ///< target of each conflict edge
+		std::vector<double> m_vConflictWeight; ///< weight of each conflict edge
+		std::vector<uint32_t> m_vStitchSource; ///< source of each stitch edge
+		std::vector<uint32_t> m_vStitchTarget; ///< target of each stitch edge
+		std::vector<double> m_vStitchWeight; ///< cost of each stitch edge, i.e., the absolute weight times stitch weight
+		std::vector<uint32_t> m_vAdjBegin; ///< offset of neighbors of each vertex
+		std::vector<uint32_t> m_vAdj; ///< neighbors
+		std::vector<double> m_vAdjCost; ///< cost of a conflict edge, or negative cost of a stitch edge
+		int32_t m_threads; ///< number of threads
+};
+
+template <typename GraphType>
+const uint32_t ColoringCost<GraphType>::block_size;
+template <typename GraphType>
+const uint32_t ColoringCost<GraphType>::chunk_size;
+
+template <typename GraphType>
+ColoringCost<GraphType>::ColoringCost(graph_type const& g, double stitch_weight)
+	: m_num_vertices(boost::num_vertices(g))
+	, m_threads(1)
+{
+	m_vAdjBegin.assign(m_num_vertices+1, 0);
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+	{
+		uint32_t s = boost::source(*ei, g);
+		uint32_t t = boost::target(*ei, g);
+		if (s == t) // skip self edges
+			continue;
+		edge_weight_type w = boost::get(boost::edge_weight, g, *ei);
+		if (w >= 0)
+		{
+			m_vConflictSource.push_back(s);
+			m_vConflictTarget.push_back(t);
+			m_vConflictWeight.push_back(w);
+		}
+		else
+		{
+			m_vStitchSource.push_back(s);
+			m_vStitchTarget.push_back(t);
+			m_vStitchWeight.push_back(-w*stitch_weight);
+		}
+		m_vAdjBegin[s+1] += 1;
+		m_vAdjBegin[t+1] += 1;
+	}
+	for (uint32_t v = 0; v < m_num_vertices; ++v)
+		m_vAdjBegin[v+1] += m_vAdjBegin[v];
+	m_vAdj.resize(m_vAdjBegin.back());
+	m_vAdjCost.resize(m_vAdjBegin.back());
+	std::vector<uint32_t> vPos (m_vAdjBegin.begin(), m_vAdjBegin.end()-1);
+	for (uint32_t i = 0; i < m_vConflictWeight.size(); ++i)
+	{
+		uint32_t s = m_vConflictSource[i];
+		uint32_t t = m_vConflictTarget[i];
+		m_vAdj[vPos[s]] = t;
+		m_vAdjCost[vPos[s]++] = m_vConflictWeight[i];
+		m_vAdj[vPos[t]] = s;
+		m_vAdjCost[vPos[t]++] = m_vConflictWeight[i];
+	}
+	for (uint32_t i = 0; i < m_vStitchWeight.size(); ++i)
+	{
+		uint32_t s = m_vStitchSource[i];
+		uint32_t t = m_vStitchTarget[i];
+		m_vAdj[vPos[s]] = t;
+		m_vAdjCost[vPos[s]++] = -m_vStitchWeight[i];
+		m_vAdj[vPos[t]] = s;
+		m_vAdjCost[vPos[t]++] = -m_vStitchWeight[i];
+	}
+}
+
+template <typename GraphType>
+typename ColoringCost<GraphType>::result_type ColoringCost<GraphType>::evaluate(std::vector<int8_t> const& vColor) const
+{
+	limboAssert(vColor.size() == m_num_vertices);
+	uint32_t numEdges = m_vConflictWeight.size()+m_vStitchWeight.size();
+	uint32_t numBlocks = (numEdges+block_size-1)/block_size;
+
+	std::vector<result_type> vBlock (numBlocks);
+	reduce_task_type task;
+	task.pCost = this;
+	task.pColor = &vColor;
+	task.pBlock = (numBlocks > 0)? &vBlock[0] : NULL;
+
+	int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), m_threads);
+	numThreads = std::max(std::min(numThreads, (int32_t)numBlocks), 1);
+	limbo::containers::parallel_for(0, numEdges, block_size, numThreads, task);
+
+	result_type result;
+	for (uint32_t i = 0; i < numBlocks; ++i)
+	{
+		result.cost += vBlock[i].cost;
+		result.conflicts += vBlock[i].conflicts;
+		result.stitches += vBlock[i].stitches;
+	}
+	return result;
+}
+
+template <typename GraphType>
+double ColoringCost<GraphType>::delta(std::vector<int8_t> const& vColor, uint32_t v, int8_t c) const
+{
+	int8_t cv = vColor[v];
+	if (cv == c)
+		return 0;
+	// a conflict edge counts when both ends share a color, a stitch edge counts when they differ,
+	// so with signed costs both kinds change by the same expression
+	double d = 0;
+	for (uint32_t i = m_vAdjBegin[v]; i != m_vAdjBegin[v+1]; ++i)
+	{
+		int8_t cu = vColor[m_vAdj[i]];
+		d += m_vAdjCost[i]*((cu == c)-(cu == cv));
+	}
+	return d;
+}
+
+template <typename GraphType>
+void ColoringCost<GraphType>::evaluate_range(std::vector<int8_t> const& vColor, uint32_t first, uint32_t last, result_type& result) const
+{
+	int8_t vSourceColor[chunk_size];
+	int8_t vTargetColor[chunk_size];
+	int8_t const* pColor = &vColor[0];
+	uint32_t numConflicts = m_vConflictWeight.size();
+
+	// conflict edges
+	for (uint32_t begin = first, end = std::min(last, numConflicts); begin < end; begin += chunk_size)
+	{
+		uint32_t n = std::min(chunk_size, end-begin);
+		uint32_t const* pSource = &m_vConflictSource[begin];
+		uint32_t const* pTarget = &m_vConflictTarget[begin];
+		double const* pWeight = &m_vConflictWeight[begin];
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			vSourceColor[i] = pColor[pSource[i]];
+			vTargetColor[i] = pColor[pTarget[i]];
+		}
+		double cost = 0;
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			uint32_t same = (vSourceColor[i] == vTargetColor[i]);
+			count += same;
+			cost += pWeight[i]*same;
+		}
+		result.cost += cost;
+		result.conflicts += count;
+	}
+	// stitch edges
+	for (uint32_t begin = std::max(first, numConflicts); begin < last; begin += chunk_size)
+	{
+		uint32_t n = std::min(chunk_size, last-begin);
+		uint32_t const* pSource = &m_vStitchSource[begin-numConflicts];
+		uint32_t const* pTarget = &m_vStitchTarget[begin-numConflicts];
+		double const* pWeight = &m_vStitchWeight[begin-numConflicts];
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			vSourceColor[i] = pColor[pSource[i]];
+			vTargetColor[i] = pColor[pTarget[i]];
+		}
+		double cost = 0;
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			uint32_t diff = (vSourceColor[i] != vTargetColor[i]);
+			count += diff;
+			cost += pWeight[i]*diff;
+		}
+		result.cost += cost;
+		result.stitches += count;
+	}
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
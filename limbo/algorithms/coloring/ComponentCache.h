@@ -0,0 +1,478 @@
+/**
+ * @file   ComponentCache.h
+ * @brief  cache of coloring solutions of components keyed by canonical forms
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_COMPONENTCACHE
+#define LIMBO_ALGORITHMS_COLORING_COMPONENTCACHE
+
+#include <vector>
+#include <map>
+#include <list>
+#include <algorithm>
+#include <pthread.h>
+#include <boost/cstdint.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/property_map/property_map.hpp>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+using boost::uint32_t;
+using boost::int32_t;
+using boost::int8_t;
+
+/// @class limbo::algorithms::coloring::ComponentCache
+/// Least recently used cache of coloring solutions of small graphs,
+/// so that isomorphic components with the same edge weights and precolored vertices are solved once.
+///
+/// A graph is relabeled by color refinement and individualization of vertices in the first non-singleton cell,
+/// and the smallest encoding of the graph among the leaves explored gives its canonical form.
+/// The search stops after @ref leaf_budget leaves, so highly symmetric graphs may not reach the canonical form.
+/// It only costs cache misses, because a solution is reused when the encodings are exactly the same.
+///
+/// @tparam GraphType graph type
+template <typename GraphType>
+class ComponentCache
+{
+	public:
+        /// @nowarn
+		typedef GraphType graph_type;
+		typedef typename boost::graph_traits<graph_type>::vertex_descriptor graph_vertex_type;
+		typedef typename boost::graph_traits<graph_type>::edge_iterator edge_iterator_type;
+		typedef typename boost::property_traits<typename boost::property_map<graph_type, boost::edge_weight_t>::const_type>::value_type edge_weight_type;
+        /// @endnowarn
+
+		/// canonical form of a graph
+		struct key_type
+		{
+			std::vector<int32_t> vStructure; ///< number of vertices, precolors and edges with ranks of weights under the canonical labeling
+			std::vector<edge_weight_type> vWeight; ///< distinct edge weights in ascending order
+
+			/// @param rhs another key
+			/// @return true if smaller than \a rhs
+			bool operator<(key_type const& rhs) const
+			{
+				return (vStructure == rhs.vStructure)? vWeight < rhs.vWeight : vStructure < rhs.vStructure;
+			}
+		};
+
+		/// constructor
+		/// @param cap maximum number of solutions, 0 to disable the cache
+		/// @param budget maximum number of leaves explored to find the canonical form
+		ComponentCache(uint32_t cap = 0, uint32_t budget = 32)
+			: m_capacity(cap)
+			, m_leaf_budget(std::max(budget, 1U))
+			, m_hits(0)
+			, m_misses(0)
+		{
+			pthread_mutex_init(&m_mutex, NULL);
+		}
+		/// destructor
+		~ComponentCache()
+		{
+			pthread_mutex_destroy(&m_mutex);
+		}
+
+		/// set maximum number of solutions, least recently used ones are removed
+		/// @param cap number of solutions, 0 to disable the cache
+		void capacity(uint32_t cap);
+		/// @return maximum number of solutions
+		uint32_t capacity() const {return m_capacity;}
+		/// set maximum number of leaves explored to find the canonical form
+		/// @param budget number of leaves
+		void leaf_budget(uint32_t budget) {m_leaf_budget = std::max(budget, 1U);}
+		/// @return number of solutions
+		uint32_t size() const {return m_mSolution.size();}
+		/// @return number of successful lookups
+		uint32_t hits() const {return m_hits;}
+		/// @return number of failed lookups
+		uint32_t misses() const {return m_misses;}
+		/// remove all solutions
+		void clear();
+		/// exchange solutions and settings with another cache, not thread-safe
+		/// @param rhs another cache
+		void swap(ComponentCache& rhs)
+		{
+			std::swap(m_capacity, rhs.m_capacity);
+			std::swap(m_leaf_budget, rhs.m_leaf_budget);
+			std::swap(m_hits, rhs.m_hits);
+			std::swap(m_misses, rhs.m_misses);
+			// positions in the lists and keys in the maps stay valid
+			m_mSolution.swap(rhs.m_mSolution);
+			m_lLru.swap(rhs.m_lLru);
+		}
+
+		/// compute the canonical form of a graph
+		/// @param g graph
+		/// @param vPrecolor precolors of vertices, negative if not precolored
+		/// @param key canonical form
+		/// @param vLabel canonical label of each vertex
+		void canonical_form(graph_type const& g, std::vector<int8_t> const& vPrecolor, key_type& key, std::vector<uint32_t>& vLabel) const;
+		/// compute the canonical form of a component without building its graph, 
+		/// the same as that of the graph built from the component 
+		/// @tparam ComponentViewType component view like @ref limbo::algorithms::coloring::GraphSimplification::component_view, 
+		/// with size() and for_each_edge() in the order of edges of the graph built from it 
+		/// @param view component 
+		/// @param vPrecolor precolors of vertices, negative if not precolored
+		/// @param key canonical form
+		/// @param vLabel canonical label of each vertex
+		template <typename ComponentViewType>
+		void canonical_form(ComponentViewType const& view, std::vector<int8_t> const& vPrecolor, key_type& key, std::vector<uint32_t>& vLabel) const
+		{
+			std::vector<uint32_t> vEdge;
+			std::vector<edge_weight_type> vEdgeWeight;
+			vEdge.reserve(2*view.num_edges());
+			vEdgeWeight.reserve(view.num_edges());
+			edge_collector_type collector = {vEdge, vEdgeWeight};
+			view.for_each_edge(collector);
+			this->canonical_form(view.size(), vEdge, vEdgeWeight, vPrecolor, key, vLabel);
+		}
+		/// look up a solution
+		/// @param key canonical form
+		/// @param vLabel canonical labels of vertices
+		/// @param vColor colors of vertices if found
+		/// @return true if found
+		bool find(key_type const& key, std::vector<uint32_t> const& vLabel, std::vector<int8_t>& vColor);
+		/// save a solution
+		/// @param key canonical form
+		/// @param vLabel canonical labels of vertices
+		/// @param vColor colors of vertices
+		void insert(key_type const& key, std::vector<uint32_t> const& vLabel, std::vector<int8_t> const& vColor);
+
+	protected:
+		/// graph to relabel, with weights replaced by their ranks
+		struct search_type
+		{
+			uint32_t n; ///< number of vertices
+			std::vector<int8_t> const* pPrecolor; ///< precolors of vertices
+			std::vector<uint32_t> vAdjBegin; ///< offset of neighbors of each vertex
+			std::vector<uint32_t> vAdj; ///< neighbors
+			std::vector<int32_t> vAdjWeight; ///< ranks of edge weights to neighbors
+			uint32_t leaves; ///< number of leaves explored
+			std::vector<int32_t> vBest; ///< smallest encoding found
+			std::vector<uint32_t> vBestLabel; ///< labeling of vBest
+		};
+		/// collect edges into flat arrays
+		struct edge_collector_type
+		{
+			std::vector<uint32_t>& vEdge; ///< pairs of end vertices
+			std::vector<edge_weight_type>& vEdgeWeight; ///< edge weights
+			/// add an edge
+			/// @param s, t end vertices
+			/// @param w weight
+			void operator()(uint32_t s, uint32_t t, edge_weight_type w)
+			{
+				vEdge.push_back(s);
+				vEdge.push_back(t);
+				vEdgeWeight.push_back(w);
+			}
+		};
+		/// compute the canonical form of a graph given by edges
+		/// @param n number of vertices
+		/// @param vEdge pairs of end vertices of edges
+		/// @param vEdgeWeight edge weights
+		/// @param vPrecolor precolors of vertices, negative if not precolored
+		/// @param key canonical form
+		/// @param vLabel canonical label of each vertex
+		void canonical_form(uint32_t n, std::vector<uint32_t> const& vEdge, std::vector<edge_weight_type> const& vEdgeWeight, 
+				std::vector<int8_t> const& vPrecolor, key_type& key, std::vector<uint32_t>& vLabel) const;
+		/// compare vertices by signatures
+		struct signature_less
+		{
+			std::vector<std::vector<int32_t> > const& vSignature; ///< signatures of vertices
+			/// constructor
+			/// @param v signatures of vertices
+			signature_less(std::vector<std::vector<int32_t> > const& v) : vSignature(v) {}
+			/// @return true if the signature of \a v1 is smaller than that of \a v2
+			bool operator()(uint32_t v1, uint32_t v2) const {return vSignature[v1] < vSignature[v2];}
+		};
+		/// compare triples in a flat array
+		struct triple_less
+		{
+			std::vector<int32_t> const& vTriple; ///< triples
+			/// constructor
+			/// @param v triples
+			triple_less(std::vector<int32_t> const& v) : vTriple(v) {}
+			/// @return true if triple \a i1 is smaller than triple \a i2
+			bool operator()(uint32_t i1, uint32_t i2) const 
+			{
+				return std::lexicographical_compare(vTriple.begin()+i1*3, vTriple.begin()+i1*3+3, vTriple.begin()+i2*3, vTriple.begin()+i2*3+3);
+			}
+		};
+		/// split cells of vertices by the cells of their neighbors until stable
+		/// @param search graph
+		/// @param vCell cell of each vertex, replaced by the rank of its refined cell
+		/// @return number of cells
+		uint32_t refine(search_type const& search, std::vector<int32_t>& vCell) const;
+		/// explore the search tree below a partition
+		/// @param search graph and the best leaf
+		/// @param vCell cell of each vertex
+		void search(search_type& search, std::vector<int32_t> vCell) const;
+
+		/// solution in the cache
+		struct entry_type
+		{
+			std::vector<int8_t> vColor; ///< colors in canonical order
+			typename std::list<key_type const*>::iterator lru; ///< position in m_lLru
+		};
+
+		uint32_t m_capacity; ///< maximum number of solutions
+		uint32_t m_leaf_budget; ///< maximum number of leaves explored
+		uint32_t m_hits; ///< number of successful lookups
+		uint32_t m_misses; ///< number of failed lookups
+		std::map<key_type, entry_type> m_mSolution; ///< solutions
+		std::list<key_type const*> m_lLru; ///< keys from the most recently used one
+		pthread_mutex_t m_mutex; ///< lock for lookups and updates
+
+	private:
+		/// copy is not allowed because of the lock
+		ComponentCache(ComponentCache const&);
+		/// copy is not allowed because of the lock
+		/// @return reference to this object
+		ComponentCache& operator=(ComponentCache const&);
+};
+
+template <typename GraphType>
+void ComponentCache<GraphType>::capacity(uint32_t cap)
+{
+	pthread_mutex_lock(&m_mutex);
+	m_capacity = cap;
+	while (m_mSolution.size() > m_capacity)
+	{
+		m_mSolution.erase(*m_lLru.back());
+		m_lLru.pop_back();
+	}
+	pthread_mutex_unlock(&m_mutex);
+}
+
+template <typename GraphType>
+void ComponentCache<GraphType>::clear()
+{
+	pthread_mutex_lock(&m_mutex);
+	m_mSolution.clear();
+	m_lLru.clear();
+	m_hits = m_misses = 0;
+	pthread_mutex_unlock(&m_mutex);
+}
+
+template <typename GraphType>
+void ComponentCache<GraphType>::canonical_form(graph_type const& g, std::vector<int8_t> const& vPrecolor, key_type& key, std::vector<uint32_t>& vLabel) const
+{
+	std::vector<uint32_t> vEdge;
+	std::vector<edge_weight_type> vEdgeWeight;
+	vEdge.reserve(2*boost::num_edges(g));
+	vEdgeWeight.reserve(boost::num_edges(g));
+	edge_collector_type collector = {vEdge, vEdgeWeight};
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+		collector(boost::source(*ei, g), boost::target(*ei, g), boost::get(boost::edge_weight, g, *ei));
+	this->canonical_form(boost::num_vertices(g), vEdge, vEdgeWeight, vPrecolor, key, vLabel);
+}
+
+template <typename GraphType>
+void ComponentCache<GraphType>::canonical_form(uint32_t n, std::vector<uint32_t> const& vEdge, std::vector<edge_weight_type> const& vEdgeWeight, 
+		std::vector<int8_t> const& vPrecolor, key_type& key, std::vector<uint32_t>& vLabel) const
+{
+	search_type search;
+	search.n = n;
+	search.pPrecolor = &vPrecolor;
+	search.leaves = 0;
+
+	// replace weights by their ranks, which do not depend on the labeling
+	key.vWeight.assign(vEdgeWeight.begin(), vEdgeWeight.end());
+	std::sort(key.vWeight.begin(), key.vWeight.end());
+	key.vWeight.erase(std::unique(key.vWeight.begin(), key.vWeight.end()), key.vWeight.end());
+
+	search.vAdjBegin.assign(search.n+1, 0);
+	for (uint32_t e = 0; e < vEdge.size(); ++e)
+		search.vAdjBegin[vEdge[e]+1] += 1;
+	for (uint32_t v = 0; v < search.n; ++v)
+		search.vAdjBegin[v+1] += search.vAdjBegin[v];
+	search.vAdj.resize(search.vAdjBegin.back());
+	search.vAdjWeight.resize(search.vAdjBegin.back());
+	std::vector<uint32_t> vPos (search.vAdjBegin.begin(), search.vAdjBegin.end()-1);
+	for (uint32_t e = 0; e < vEdgeWeight.size(); ++e)
+	{
+		uint32_t s = vEdge[2*e];
+		uint32_t t = vEdge[2*e+1];
+		int32_t w = std::lower_bound(key.vWeight.begin(), key.vWeight.end(), vEdgeWeight[e])-key.vWeight.begin();
+		search.vAdj[vPos[s]] = t;
+		search.vAdjWeight[vPos[s]++] = w;
+		search.vAdj[vPos[t]] = s;
+		search.vAdjWeight[vPos[t]++] = w;
+	}
+
+	// initial cells by precolors
+	std::vector<int32_t> vCell (search.n);
+	for (uint32_t v = 0; v < search.n; ++v)
+		vCell[v] = vPrecolor[v];
+	this->search(search, vCell);
+
+	key.vStructure.swap(search.vBest);
+	vLabel.swap(search.vBestLabel);
+}
+
+template <typename GraphType>
+uint32_t ComponentCache<GraphType>::refine(search_type const& search, std::vector<int32_t>& vCell) const
+{
+	std::vector<std::vector<int32_t> > vSignature (search.n);
+	std::vector<uint32_t> vOrder (search.n);
+	uint32_t num_cells = 0;
+	while (true)
+	{
+		// a signature is the cell of a vertex followed by the sorted cells and weights of its neighbors
+		for (uint32_t v = 0; v < search.n; ++v)
+		{
+			std::vector<std::pair<int32_t, int32_t> > vNeighbor;
+			for (uint32_t i = search.vAdjBegin[v]; i != search.vAdjBegin[v+1]; ++i)
+				vNeighbor.push_back(std::make_pair(vCell[search.vAdj[i]], search.vAdjWeight[i]));
+			std::sort(vNeighbor.begin(), vNeighbor.end());
+			std::vector<int32_t>& vSig = vSignature[v];
+			vSig.assign(1, vCell[v]);
+			for (uint32_t i = 0; i < vNeighbor.size(); ++i)
+			{
+				vSig.push_back(vNeighbor[i].first);
+				vSig.push_back(vNeighbor[i].second);
+			}
+		}
+		for (uint32_t v = 0; v < search.n; ++v)
+			vOrder[v] = v;
+		std::sort(vOrder.begin(), vOrder.end(), signature_less(vSignature));
+
+		// new cells are ranks of signatures, which keep the order of old cells
+		uint32_t num_new_cells = 0;
+		for (uint32_t i = 0; i < search.n; ++i)
+		{
+			if (i > 0 && vSignature[vOrder[i]] != vSignature[vOrder[i-1]])
+				num_new_cells += 1;
+			vCell[vOrder[i]] = num_new_cells;
+		}
+		num_new_cells += (search.n > 0);
+		// refinement only splits cells
+		if (num_new_cells == num_cells)
+			break;
+		num_cells = num_new_cells;
+	}
+	return num_cells;
+}
+
+template <typename GraphType>
+void ComponentCache<GraphType>::search(search_type& search, std::vector<int32_t> vCell) const
+{
+	uint32_t num_cells = this->refine(search, vCell);
+	if (num_cells == search.n) // discrete partition, cells are the labels
+	{
+		search.leaves += 1;
+		std::vector<int32_t> vEncoding (1, search.n);
+		vEncoding.resize(search.n+1);
+		for (uint32_t v = 0; v < search.n; ++v)
+			vEncoding[vCell[v]+1] = (*search.pPrecolor)[v];
+		std::vector<int32_t> vEdge;
+		for (uint32_t v = 0; v < search.n; ++v)
+		{
+			for (uint32_t i = search.vAdjBegin[v]; i != search.vAdjBegin[v+1]; ++i)
+			{
+				if (vCell[v] < vCell[search.vAdj[i]])
+				{
+					vEdge.push_back(vCell[v]);
+					vEdge.push_back(vCell[search.vAdj[i]]);
+					vEdge.push_back(search.vAdjWeight[i]);
+				}
+			}
+		}
+		// sort edges as triples
+		std::vector<uint32_t> vEdgeOrder (vEdge.size()/3);
+		for (uint32_t i = 0; i < vEdgeOrder.size(); ++i)
+			vEdgeOrder[i] = i;
+		std::sort(vEdgeOrder.begin(), vEdgeOrder.end(), triple_less(vEdge));
+		for (uint32_t i = 0; i < vEdgeOrder.size(); ++i)
+			vEncoding.insert(vEncoding.end(), vEdge.begin()+vEdgeOrder[i]*3, vEdge.begin()+vEdgeOrder[i]*3+3);
+
+		if (search.vBest.empty() || vEncoding < search.vBest)
+		{
+			search.vBest.swap(vEncoding);
+			search.vBestLabel.assign(vCell.begin(), vCell.end());
+		}
+		return;
+	}
+
+	// individualize each vertex of the first cell with more than one vertex
+	std::vector<uint32_t> vCellSize (num_cells, 0);
+	for (uint32_t v = 0; v < search.n; ++v)
+		vCellSize[vCell[v]] += 1;
+	int32_t target = 0;
+	while (vCellSize[target] == 1)
+		++target;
+	for (uint32_t v = 0; v < search.n; ++v)
+	{
+		if (vCell[v] != target)
+			continue;
+		if (search.leaves >= m_leaf_budget)
+			break;
+		std::vector<int32_t> vChildCell (search.n);
+		for (uint32_t u = 0; u < search.n; ++u)
+			vChildCell[u] = vCell[u]*2+(u != v);
+		this->search(search, vChildCell);
+	}
+}
+
+template <typename GraphType>
+bool ComponentCache<GraphType>::find(key_type const& key, std::vector<uint32_t> const& vLabel, std::vector<int8_t>& vColor)
+{
+	bool found_flag = false;
+	pthread_mutex_lock(&m_mutex);
+	typename std::map<key_type, entry_type>::iterator found = m_mSolution.find(key);
+	if (found != m_mSolution.end())
+	{
+		m_lLru.splice(m_lLru.begin(), m_lLru, found->second.lru);
+		vColor.resize(vLabel.size());
+		for (uint32_t v = 0; v < vLabel.size(); ++v)
+			vColor[v] = found->second.vColor[vLabel[v]];
+		m_hits += 1;
+		found_flag = true;
+	}
+	else
+		m_misses += 1;
+	pthread_mutex_unlock(&m_mutex);
+	return found_flag;
+}
+
+template <typename GraphType>
+void ComponentCache<GraphType>::insert(key_type const& key, std::vector<uint32_t> const& vLabel, std::vector<int8_t> const& vColor)
+{
+	pthread_mutex_lock(&m_mutex);
+	if (m_capacity > 0)
+	{
+		std::pair<typename std::map<key_type, entry_type>::iterator, bool> found = m_mSolution.insert(std::make_pair(key, entry_type()));
+		if (found.second)
+		{
+			entry_type& entry = found.first->second;
+			entry.vColor.resize(vLabel.size());
+			for (uint32_t v = 0; v < vLabel.size(); ++v)
+				entry.vColor[vLabel[v]] = vColor[v];
+			m_lLru.push_front(&found.first->first);
+			entry.lru = m_lLru.begin();
+			if (m_mSolution.size() > m_capacity)
+			{
+				m_mSolution.erase(*m_lLru.back());
+				m_lLru.pop_back();
+			}
+		}
+	}
+	pthread_mutex_unlock(&m_mutex);
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
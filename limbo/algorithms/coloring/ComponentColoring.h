@@ -0,0 +1,769 @@
+/**
+ * @file   ComponentColoring.h
+ * @brief  graph coloring by simplification and coloring components in parallel
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_COMPONENTCOLORING
+#define LIMBO_ALGORITHMS_COLORING_COMPONENTCOLORING
+
+#include <algorithm>
+#include <pthread.h>
+#include <unistd.h>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/algorithms/coloring/Coloring.h>
+#include <limbo/algorithms/coloring/GraphSimplification.h>
+#include <limbo/algorithms/coloring/BitsetColoring.h>
+#include <limbo/algorithms/coloring/ComponentCache.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+/// @class limbo::algorithms::coloring::ComponentColoring
+/// Simplify the graph with @ref limbo::algorithms::coloring::GraphSimplification,
+/// color its components with multiple threads and recover the colors of the whole graph.
+///
+/// Components are sorted by size and taken by idle threads from the largest one,
+/// so that a large component does not start last while many small ones keep the other threads busy.
+/// Components with no more than @ref max_small_vertices vertices are colored by SmallColoringType,
+/// and larger ones by LargeColoringType, e.g., ILPColoring or SDPColoringCsdp.
+/// Each solver runs with one thread when several components are colored at the same time.
+/// Solvers that are not reentrant, like the Csdp library, should be run with @ref large_serial.
+///
+/// After a small change to the graph, the previous solution can be given by @ref warm_start
+/// with the changed vertices marked by @ref dirty.
+/// Components without dirty vertices keep their previous colors and are not solved again.
+/// In the other components, articulation points that are not dirty are precolored to their previous colors,
+/// so that the new solutions agree with the components kept.
+///
+/// Precolored vertices are pruned by @ref limbo::algorithms::coloring::GraphSimplification::PRUNE_PRECOLOR,
+/// so that they do not join components, e.g., power rails and pins of fixed colors.
+/// A component next to pruned vertices is solved with one more precolored vertex for each color forbidden in it,
+/// connected by conflict edges with the total weights to the pruned vertices of that color,
+/// so every solver honors the forbidden colors at their exact costs.
+///
+/// With a positive @ref cache_size, solutions are saved by the canonical forms of components
+/// in a @ref limbo::algorithms::coloring::ComponentCache, and isomorphic components with the same
+/// edge weights and precolored vertices reuse them without calling the solvers.
+/// The cache is kept across runs, and cleared if the number of colors or the stitch weight changes.
+///
+/// With a positive @ref batch_vertices, components colored by SmallColoringType are put together into
+/// disjoint graphs of at most that many vertices, each solved by one call.
+/// It saves the setup of solvers with a high cost per call, e.g., ILP solvers.
+///
+/// With the time limit of the base class, components colored by LargeColoringType share the remaining time
+/// in proportion to their numbers of vertices and edges, computed when each one starts,
+/// so time left by components finished early goes to the later ones.
+/// Each component is first colored by @ref limbo::algorithms::coloring::TabuRefinement from a greedy solution
+/// within a tenth of its share, and LargeColoringType is called with the rest as its time limit,
+/// e.g., TimeLimit of Gurobi in ILPColoring, and its solution is taken only if it is better.
+/// Components started after the deadline keep the greedy solution, so the run ends shortly after the limit.
+///
+/// Vertices of conflict graphs come in layout order, so simplification and solvers touch memory randomly.
+/// With @ref vertex_order, a @ref limbo::algorithms::CsrGraph is relabeled before simplification,
+/// e.g., by reverse Cuthill-McKee or along a Hilbert curve from @ref limbo::algorithms::coloring::ConflictGraphBuilder::hilbert_order,
+/// colored as a permuted copy, and the colors are mapped back to the original vertices.
+/// Precolors and @ref warm_start are permuted as well; the ordering is ignored for other graph types.
+///
+/// @tparam GraphType graph type
+/// @tparam SmallColoringType solver for small components, derived from @ref limbo::algorithms::coloring::Coloring
+/// @tparam LargeColoringType solver for large components, derived from @ref limbo::algorithms::coloring::Coloring
+template <typename GraphType,
+         typename SmallColoringType = BitsetColoring<GraphType>,
+         typename LargeColoringType = SmallColoringType>
+class ComponentColoring : public Coloring<GraphType>
+{
+	public:
+        /// @nowarn
+		typedef Coloring<GraphType> base_type;
+		using typename base_type::graph_type;
+		using typename base_type::graph_vertex_type;
+		using typename base_type::graph_edge_type;
+		using typename base_type::vertex_iterator_type;
+		using typename base_type::edge_iterator_type;
+        using typename base_type::edge_weight_type;
+		using typename base_type::ColorNumType;
+		typedef GraphSimplification<graph_type> graph_simplification_type;
+		typedef typename graph_simplification_type::component_set_type component_set_type;
+		typedef typename graph_simplification_type::component_view component_view;
+        /// @endnowarn
+
+        /// @brief vertex orderings of CSR graphs before simplification
+        enum vertex_order_type
+        {
+            VERTEX_ORDER_NONE, ///< keep the vertices of the graph
+            VERTEX_ORDER_RCM, ///< reverse Cuthill-McKee ordering, see @ref limbo::algorithms::reverse_cuthill_mckee_order
+            VERTEX_ORDER_DEGREE, ///< decreasing degree, see @ref limbo::algorithms::degree_order
+            VERTEX_ORDER_CUSTOM ///< ordering given by users
+        };
+
+		/// constructor
+        /// @param g graph
+		ComponentColoring(graph_type const& g)
+			: base_type(g)
+            , m_simplify_level(graph_simplification_type::PRUNE_PRECOLOR | graph_simplification_type::HIDE_SMALL_DEGREE | graph_simplification_type::BICONNECTED_COMPONENT)
+            , m_max_small_vertices(20)
+            , m_large_serial(false)
+            , m_gs(NULL)
+            , m_num_small(0)
+            , m_num_large(0)
+            , m_num_reused(0)
+            , m_num_cached(0)
+            , m_cache_color_num(0)
+            , m_cache_stitch_weight(0)
+            , m_batch_vertices(0)
+            , m_num_batches(0)
+            , m_deadline(0)
+            , m_remaining_weight(0)
+            , m_budget_threads(1)
+            , m_num_fallback(0)
+            , m_vertex_order(VERTEX_ORDER_NONE)
+		{
+            pthread_mutex_init(&m_large_mutex, NULL);
+        }
+		/// destructor
+		virtual ~ComponentColoring()
+        {
+            pthread_mutex_destroy(&m_large_mutex);
+        }
+
+        /// set simplification level
+        /// @param level combination of @ref limbo::algorithms::coloring::GraphSimplification::strategy_type
+        void simplify_level(uint32_t level) {m_simplify_level = level;}
+        /// @return simplification level
+        uint32_t simplify_level() const {return m_simplify_level;}
+        /// set the largest component colored by SmallColoringType
+        /// @param n number of vertices
+        void max_small_vertices(uint32_t n) {m_max_small_vertices = n;}
+        /// @return the largest component colored by SmallColoringType
+        uint32_t max_small_vertices() const {return m_max_small_vertices;}
+        /// set whether components colored by LargeColoringType are colored one at a time
+        /// @param f flag
+        void large_serial(bool f) {m_large_serial = f;}
+        /// @return number of components colored by SmallColoringType in the last run
+        uint32_t num_small_components() const {return m_num_small;}
+        /// @return number of components colored by LargeColoringType in the last run
+        uint32_t num_large_components() const {return m_num_large;}
+        /// @return number of components that keep the colors of @ref warm_start in the last run
+        uint32_t num_reused_components() const {return m_num_reused;}
+        /// @return number of components colored by LargeColoringType that keep the heuristic solution under the time limit in the last run
+        uint32_t num_fallback_components() const {return m_num_fallback;}
+        /// set maximum number of solutions in the cache of components
+        /// @param n number of solutions, 0 to disable the cache
+        void cache_size(uint32_t n) {m_cache.capacity(n);}
+        /// @return cache of component solutions
+        ComponentCache<graph_type>& cache() {return m_cache;}
+        /// @return number of components colored from the cache in the last run
+        uint32_t num_cached_components() const {return m_num_cached;}
+        /// set the largest disjoint graph of components colored by one call of SmallColoringType
+        /// @param n number of vertices, 0 to color components one by one
+        void batch_vertices(uint32_t n) {m_batch_vertices = n;}
+        /// @return number of batches of components in the last run
+        uint32_t num_batches() const {return m_num_batches;}
+        /// @return wall time of simplification in the last run, in seconds, 0 if statistics are not collected
+        double simplify_time() const {return this->m_statistics.simplify_time;}
+        /// @return wall time of coloring components in the last run, in seconds, 0 if statistics are not collected
+        double solve_time() const {return this->m_statistics.solve_time;}
+        /// @return wall time of recovering colors of the whole graph in the last run, in seconds, 0 if statistics are not collected
+        double recover_time() const {return this->m_statistics.recover_time;}
+        /// set the previous solution of the graph and clear dirty vertices,
+        /// vertices added since then should have negative colors
+        /// @tparam Iterator iterator to colors
+        /// @param first, last colors of vertices
+        template <typename Iterator>
+        void warm_start(Iterator first, Iterator last)
+        {
+            m_vPrevColor.assign(first, last);
+            m_vPrevColor.resize(boost::num_vertices(this->m_graph), -1);
+            m_vDirty.assign(m_vPrevColor.size(), false);
+        }
+        /// mark a vertex whose edges are changed since @ref warm_start, 
+        /// i.e., both ends of added or removed edges, and neighbors of removed vertices 
+        /// @param v vertex
+        void dirty(graph_vertex_type v) {m_vDirty.at(v) = true;}
+        /// set the vertex ordering applied to a CSR graph before simplification
+        /// @param t ordering, @ref VERTEX_ORDER_CUSTOM keeps the ordering set last
+        void vertex_order(vertex_order_type t) {m_vertex_order = t;}
+        /// set a custom vertex ordering applied to a CSR graph before simplification
+        /// @param vOrder vertex at each position, a permutation of all vertices
+        void vertex_order(std::vector<uint32_t> const& vOrder) {m_vertex_order = VERTEX_ORDER_CUSTOM; m_vCustomOrder = vOrder;}
+        /// @return vertex ordering
+        vertex_order_type vertex_order() const {return m_vertex_order;}
+
+	protected:
+        /// component to color
+        struct pending_type
+        {
+            component_view view; ///< component in m_components
+            std::vector<int8_t> vPrecolor; ///< precolors of component vertices, negative if not precolored, followed by the colors of anchors
+            std::vector<edge_weight_type> vAnchorWeight; ///< weights to anchors, the anchors of each vertex are contiguous, empty without forbidden colors
+            typename ComponentCache<graph_type>::key_type key; ///< canonical form if the cache is enabled
+            std::vector<uint32_t> vLabel; ///< canonical labels of vertices if the cache is enabled
+        };
+        /// batches of components run by limbo::containers::parallel_for
+        struct BatchKernel
+        {
+            ComponentColoring* solver; ///< coloring object
+            /// @param b first batch
+            /// @param e end batch
+            void operator()(std::size_t b, std::size_t e) const {solver->color_batches(b, e);}
+        };
+
+		/// @return objective value
+		virtual double coloring();
+        /// simplify the graph and color its components 
+        /// @return objective value
+        double coloring_components();
+        /// color a permuted copy of a CSR graph by another object and map the colors back, 
+        /// the time of ordering is counted as simplification 
+        /// @return objective value
+        double coloring_reordered(boost::true_type);
+        /// orderings are not supported for graphs other than CsrGraph 
+        /// @return objective value
+        double coloring_reordered(boost::false_type) {return this->coloring_components();}
+        /// color a range of batches of components
+        /// @param first first batch
+        /// @param last end batch
+        void color_batches(std::size_t first, std::size_t last);
+        /// color one component
+        /// @param comp_id component id
+        /// @param numThreads number of threads for the solver
+        void color_component(uint32_t comp_id, int32_t numThreads);
+        /// color a component by LargeColoringType within its share of the remaining time, 
+        /// keeping a heuristic solution if the solver does not find a better one 
+        /// @param sg graph of the component
+        /// @param vPrecolor precolors of component vertices, negative if not precolored
+        /// @param vColor coloring solution of the component
+        /// @param numThreads number of threads for the solver
+        /// @param weight weight of the component in the time budget 
+        /// @param rest total weight of the components not started yet, including this one 
+        void solve_with_budget(graph_type const& sg, std::vector<int8_t> const& vPrecolor, std::vector<int8_t>& vColor, int32_t numThreads, 
+                boost::uint64_t weight, boost::uint64_t rest);
+        /// color components in a batch by one call of SmallColoringType
+        /// @param first, last range of positions in m_vOrder
+        /// @param numThreads number of threads for the solver
+        void color_batch(uint32_t first, uint32_t last, int32_t numThreads);
+        /// set the precolors of a component, 
+        /// and color it by @ref warm_start or the cache if possible
+        /// @param pc component with the view set
+        /// @return true if colored
+        bool prepare_component(pending_type& pc);
+        /// add an anchor vertex for each color forbidden in a component by pruned vertices 
+        /// @param pc component with the precolors set 
+        void anchor_component(pending_type& pc) const;
+        /// add the edges of a component and its anchors to a graph 
+        /// @param pc component 
+        /// @param builder graph and the index of the first vertex of the component 
+        void build_component(pending_type const& pc, ComponentGraphBuilder<graph_type>& builder) const;
+        /// save the solution of a component to the cache
+        /// @param pc component
+        void save_component(pending_type const& pc);
+        /// @param v vertex of the simplified graph
+        /// @return true if \a v and all vertices merged into it keep their colors of @ref warm_start
+        bool clean(graph_vertex_type v) const;
+        /// color a component with a solver, 
+        /// and add up its model sizes and iterations if statistics are collected
+        /// @tparam SolverType coloring algorithm
+        /// @param sg graph of the component
+        /// @param vPrecolor precolors of component vertices, negative if not precolored
+        /// @param vColor coloring solution of the component
+        /// @param numThreads number of threads for the solver
+        /// @param timeLimit time limit of the solver in seconds, 0 for no limit
+        template <typename SolverType>
+        void solve(graph_type const& sg, std::vector<int8_t> const& vPrecolor, std::vector<int8_t>& vColor, int32_t numThreads, double timeLimit = 0);
+
+        uint32_t m_simplify_level; ///< simplification level
+        uint32_t m_max_small_vertices; ///< the largest component colored by SmallColoringType
+        bool m_large_serial; ///< whether components colored by LargeColoringType are colored one at a time
+        pthread_mutex_t m_large_mutex; ///< lock for m_large_serial
+
+        graph_simplification_type* m_gs; ///< simplification in the current run
+        std::vector<uint32_t> m_vOrder; ///< components from the largest one
+        std::vector<uint32_t> m_vBatchBegin; ///< offset of each batch in m_vOrder, with one more entry for the end
+        int32_t m_solver_threads; ///< number of threads for each solver in the current run
+        component_set_type m_components; ///< components of the simplified graph, graphs are only built for components to solve
+        std::vector<int8_t> m_vSubColor; ///< coloring solutions of entries of m_components.vVertex
+        uint32_t m_num_small; ///< number of components colored by SmallColoringType
+        uint32_t m_num_large; ///< number of components colored by LargeColoringType
+        uint32_t m_num_reused; ///< number of components that keep previous colors
+        std::vector<int8_t> m_vPrevColor; ///< previous solution, empty if not warm started
+        std::vector<char> m_vDirty; ///< whether the edges of a vertex are changed since the previous solution
+        ComponentCache<graph_type> m_cache; ///< solutions of components by canonical forms
+        uint32_t m_num_cached; ///< number of components colored from the cache
+        int32_t m_cache_color_num; ///< number of colors of solutions in the cache
+        double m_cache_stitch_weight; ///< stitch weight of solutions in the cache
+        uint32_t m_batch_vertices; ///< the largest disjoint graph of components colored by one call
+        uint32_t m_num_batches; ///< number of batches with more than one component
+        double m_deadline; ///< wall time to stop in the current run, 0 for no limit
+        boost::uint64_t m_remaining_weight; ///< total weight of components colored by LargeColoringType not started yet
+        int32_t m_budget_threads; ///< number of components colored by LargeColoringType at the same time
+        uint32_t m_num_fallback; ///< number of components that keep the heuristic solution under the time limit
+        vertex_order_type m_vertex_order; ///< vertex ordering of CSR graphs
+        std::vector<uint32_t> m_vCustomOrder; ///< vertex at each position of the custom ordering
+};
+
+/// compare components by size from the largest one
+/// @tparam SimplificationType graph simplification type
+template <typename SimplificationType>
+struct ComponentSizeGreater
+{
+    SimplificationType const& gs; ///< graph simplification
+    /// constructor
+    /// @param s graph simplification
+    ComponentSizeGreater(SimplificationType const& s) : gs(s) {}
+    /// @return true if component \a c1 is larger than component \a c2
+    bool operator()(uint32_t c1, uint32_t c2) const {return gs.component_size(c1) > gs.component_size(c2);}
+};
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+double ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::coloring()
+{
+    if (m_vertex_order != VERTEX_ORDER_NONE && boost::num_vertices(this->m_graph) > 0)
+        return this->coloring_reordered(is_csr_graph<graph_type>());
+    return this->coloring_components();
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+double ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::coloring_reordered(boost::true_type)
+{
+    double start = (this->m_collect_statistics)? ColoringStatistics::wall_time() : 0;
+    uint32_t numVertices = boost::num_vertices(this->m_graph);
+    limbo::containers::TaskPool pool (std::max(std::min((int32_t)limbo::containers::num_threads(), this->m_threads), 1));
+    std::vector<uint32_t> vOrder;
+    if (m_vertex_order == VERTEX_ORDER_RCM)
+        reverse_cuthill_mckee_order(this->m_graph, vOrder, pool);
+    else if (m_vertex_order == VERTEX_ORDER_DEGREE)
+        degree_order(this->m_graph, vOrder);
+    else 
+    {
+        limboAssertMsg(m_vCustomOrder.size() == numVertices, "custom vertex ordering of %u vertices for a graph of %u vertices", (uint32_t)m_vCustomOrder.size(), numVertices);
+        vOrder = m_vCustomOrder;
+    }
+    graph_type pg;
+    permute_graph(this->m_graph, vOrder, pg, pool);
+
+    // settings and the cache are passed to the coloring of the permuted graph, and taken back afterwards 
+    ComponentColoring pc (pg);
+    pc.m_color_num = this->m_color_num;
+    pc.m_stitch_weight = this->m_stitch_weight;
+    pc.m_threads = this->m_threads;
+    pc.m_has_precolored = this->m_has_precolored;
+    pc.m_collect_statistics = this->m_collect_statistics;
+    pc.m_time_limit = this->m_time_limit;
+    pc.m_statistics = this->m_statistics;
+    pc.m_simplify_level = m_simplify_level;
+    pc.m_max_small_vertices = m_max_small_vertices;
+    pc.m_large_serial = m_large_serial;
+    pc.m_batch_vertices = m_batch_vertices;
+    pc.m_cache.swap(m_cache);
+    pc.m_cache_color_num = m_cache_color_num;
+    pc.m_cache_stitch_weight = m_cache_stitch_weight;
+    for (uint32_t i = 0; i < numVertices; ++i)
+        pc.m_vColor[i] = this->m_vColor[vOrder[i]];
+    if (!m_vPrevColor.empty())
+    {
+        pc.m_vPrevColor.resize(numVertices);
+        pc.m_vDirty.resize(numVertices);
+        for (uint32_t i = 0; i < numVertices; ++i)
+        {
+            pc.m_vPrevColor[i] = m_vPrevColor[vOrder[i]];
+            pc.m_vDirty[i] = m_vDirty[vOrder[i]];
+        }
+    }
+    double order_time = (this->m_collect_statistics)? ColoringStatistics::wall_time()-start : 0;
+
+    double cost = pc.coloring_components();
+
+    for (uint32_t i = 0; i < numVertices; ++i)
+        this->m_vColor[vOrder[i]] = pc.m_vColor[i];
+    m_cache.swap(pc.m_cache);
+    m_cache_color_num = pc.m_cache_color_num;
+    m_cache_stitch_weight = pc.m_cache_stitch_weight;
+    m_num_small = pc.m_num_small;
+    m_num_large = pc.m_num_large;
+    m_num_reused = pc.m_num_reused;
+    m_num_cached = pc.m_num_cached;
+    m_num_batches = pc.m_num_batches;
+    m_num_fallback = pc.m_num_fallback;
+    if (this->m_collect_statistics)
+    {
+        this->m_statistics = pc.m_statistics;
+        this->m_statistics.simplify_time += order_time;
+    }
+    return cost;
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+double ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::coloring_components()
+{
+    double start = (this->m_collect_statistics)? ColoringStatistics::wall_time() : 0;
+    m_deadline = (this->m_time_limit > 0)? ColoringStatistics::wall_time()+this->m_time_limit : 0;
+    graph_simplification_type gs (this->m_graph, this->color_num());
+    if (this->has_precolored())
+        gs.precolor(this->m_vColor.begin(), this->m_vColor.end());
+    gs.threads(this->m_threads);
+    gs.simplify(m_simplify_level);
+    gs.simplified_components(m_components);
+    if (this->m_collect_statistics)
+    {
+        this->m_statistics.simplify_time = ColoringStatistics::wall_time()-start;
+        this->m_statistics.num_merged_vertices = gs.num_merged();
+        this->m_statistics.num_hidden_vertices = gs.num_hidden();
+        this->m_statistics.num_pruned_vertices = gs.num_pruned();
+        this->m_statistics.num_components = gs.num_component();
+    }
+
+    uint32_t numComps = gs.num_component();
+    m_gs = &gs;
+    m_vSubColor.assign(m_components.vVertex.size(), -1);
+    m_vOrder.resize(numComps);
+    for (uint32_t i = 0; i < numComps; ++i)
+        m_vOrder[i] = i;
+    std::stable_sort(m_vOrder.begin(), m_vOrder.end(), ComponentSizeGreater<graph_simplification_type>(gs));
+    // small components are at the end, put neighboring ones together 
+    m_vBatchBegin.assign(1, 0);
+    for (uint32_t i = 0, batch_size = 0; i < numComps; ++i)
+    {
+        uint32_t comp_size = gs.component_size(m_vOrder[i]);
+        bool small_flag = (comp_size <= m_max_small_vertices);
+        if (i > 0 && (!small_flag || batch_size+comp_size > m_batch_vertices))
+        {
+            m_vBatchBegin.push_back(i);
+            batch_size = 0;
+        }
+        // a large component is alone in its batch 
+        batch_size = (small_flag)? batch_size+comp_size : m_batch_vertices+1;
+    }
+    if (numComps > 0)
+        m_vBatchBegin.push_back(numComps);
+    uint32_t numBatches = m_vBatchBegin.size()-1;
+    m_num_small = m_num_large = m_num_reused = m_num_cached = m_num_batches = m_num_fallback = 0;
+    m_remaining_weight = 0;
+    if (m_deadline > 0)
+    {
+        for (uint32_t i = 0; i < numComps; ++i)
+        {
+            component_view view (m_components, i);
+            if (view.size() > m_max_small_vertices)
+                m_remaining_weight += view.size()+view.num_edges();
+        }
+    }
+    if (m_cache_color_num != (int32_t)this->color_num() || m_cache_stitch_weight != this->stitch_weight())
+    {
+        m_cache.clear();
+        m_cache_color_num = this->color_num();
+        m_cache_stitch_weight = this->stitch_weight();
+    }
+
+    // threads in use, at most one per batch
+    int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), this->m_threads);
+    numThreads = std::max(std::min(numThreads, (int32_t)numBatches), 1);
+    m_solver_threads = (numThreads > 1)? 1 : this->m_threads;
+    m_budget_threads = (m_large_serial)? 1 : numThreads;
+
+    BatchKernel kernel = {this};
+    limbo::containers::parallel_for(0, numBatches, 1, numThreads, kernel);
+
+    double recover_start = (this->m_collect_statistics)? ColoringStatistics::wall_time() : 0;
+    std::vector<int8_t> vColor (this->m_vColor.begin(), this->m_vColor.end());
+    gs.recover(vColor, m_components, m_vSubColor);
+    if (m_simplify_level & graph_simplification_type::HIDE_SMALL_DEGREE)
+        gs.recover_hide_small_degree(vColor);
+    this->m_vColor.swap(vColor);
+    if (this->m_collect_statistics)
+        this->m_statistics.recover_time = ColoringStatistics::wall_time()-recover_start;
+
+    m_gs = NULL;
+    m_components = component_set_type();
+    std::vector<int8_t>().swap(m_vSubColor);
+    return this->calc_cost(this->m_vColor);
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+void ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::color_batches(std::size_t first, std::size_t last)
+{
+    for (std::size_t i = first; i < last; ++i)
+    {
+        if (m_vBatchBegin[i]+1 == m_vBatchBegin[i+1])
+            this->color_component(m_vOrder[m_vBatchBegin[i]], m_solver_threads);
+        else 
+            this->color_batch(m_vBatchBegin[i], m_vBatchBegin[i+1], m_solver_threads);
+    }
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+void ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::color_component(uint32_t comp_id, int32_t numThreads)
+{
+    pending_type pc;
+    pc.view = component_view(m_components, comp_id);
+    // the weight in the time budget is taken even if the component is not solved
+    boost::uint64_t weight = 0, rest = 0;
+    if (m_deadline > 0 && pc.view.size() > m_max_small_vertices)
+    {
+        weight = pc.view.size()+pc.view.num_edges();
+        rest = __sync_fetch_and_sub(&m_remaining_weight, weight);
+    }
+    if (this->prepare_component(pc))
+        return;
+
+    graph_type sg (pc.vPrecolor.size());
+    ComponentGraphBuilder<graph_type> builder = {sg, 0};
+    this->build_component(pc, builder);
+    std::vector<int8_t> vColor (pc.vPrecolor.size(), -1);
+    if (pc.view.size() <= m_max_small_vertices)
+    {
+        __sync_fetch_and_add(&m_num_small, 1);
+        this->template solve<SmallColoringType>(sg, pc.vPrecolor, vColor, numThreads);
+    }
+    else
+    {
+        __sync_fetch_and_add(&m_num_large, 1);
+        if (m_large_serial)
+            pthread_mutex_lock(&m_large_mutex);
+        if (weight > 0)
+            this->solve_with_budget(sg, pc.vPrecolor, vColor, numThreads, weight, rest);
+        else
+            this->template solve<LargeColoringType>(sg, pc.vPrecolor, vColor, numThreads);
+        if (m_large_serial)
+            pthread_mutex_unlock(&m_large_mutex);
+    }
+    std::copy(vColor.begin(), vColor.begin()+pc.view.size(), m_vSubColor.begin()+pc.view.offset());
+    this->save_component(pc);
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+void ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::solve_with_budget(graph_type const& sg, 
+        std::vector<int8_t> const& vPrecolor, std::vector<int8_t>& vColor, int32_t numThreads, boost::uint64_t weight, boost::uint64_t rest)
+{
+    // the share is computed after waiting for m_large_mutex
+    double start = ColoringStatistics::wall_time();
+    double remaining = m_deadline-start;
+    double budget = std::min(remaining, remaining*m_budget_threads*weight/std::max(rest, weight));
+
+    // heuristic solution, kept if no time is left
+    TabuRefinement<graph_type> tr (sg, this->color_num(), this->stitch_weight());
+    std::vector<char> vFixed (vPrecolor.size());
+    for (uint32_t v = 0; v < vPrecolor.size(); ++v)
+        vFixed[v] = (vPrecolor[v] >= 0);
+    vColor.assign(vPrecolor.begin(), vPrecolor.end());
+    tr.initial_coloring(vColor);
+    double cost = 0;
+    if (budget > 0)
+    {
+        tr.fixed(vFixed);
+        tr.time_limit(budget/10);
+        cost = tr(vColor);
+        budget -= ColoringStatistics::wall_time()-start;
+    }
+    if (budget <= 0)
+    {
+        __sync_fetch_and_add(&m_num_fallback, 1);
+        return;
+    }
+
+    std::vector<int8_t> vSolverColor (vColor.size(), -1);
+    this->template solve<LargeColoringType>(sg, vPrecolor, vSolverColor, numThreads, budget);
+    bool valid = true;
+    for (uint32_t v = 0; v < vSolverColor.size() && valid; ++v)
+        valid = (vSolverColor[v] >= 0 && vSolverColor[v] < this->color_num());
+    if (valid && tr.cost()(vSolverColor) <= cost)
+        vColor.swap(vSolverColor);
+    else
+        __sync_fetch_and_add(&m_num_fallback, 1);
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+void ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::color_batch(uint32_t first, uint32_t last, int32_t numThreads)
+{
+    std::vector<pending_type> vPending;
+    vPending.reserve(last-first);
+    std::vector<uint32_t> vOffset (1, 0); // first vertex of each component in the batch 
+    for (uint32_t i = first; i < last; ++i)
+    {
+        vPending.push_back(pending_type());
+        vPending.back().view = component_view(m_components, m_vOrder[i]);
+        if (this->prepare_component(vPending.back()))
+            vPending.pop_back();
+        else 
+            vOffset.push_back(vOffset.back()+vPending.back().vPrecolor.size());
+    }
+    if (vPending.empty())
+        return;
+
+    // disjoint graph of all components, built from the views directly 
+    graph_type bg (vOffset.back());
+    std::vector<int8_t> vPrecolor;
+    vPrecolor.reserve(vOffset.back());
+    for (uint32_t i = 0; i < vPending.size(); ++i)
+    {
+        ComponentGraphBuilder<graph_type> builder = {bg, vOffset[i]};
+        this->build_component(vPending[i], builder);
+        vPrecolor.insert(vPrecolor.end(), vPending[i].vPrecolor.begin(), vPending[i].vPrecolor.end());
+    }
+
+    std::vector<int8_t> vColor (vOffset.back(), -1);
+    __sync_fetch_and_add(&m_num_small, vPending.size());
+    __sync_fetch_and_add(&m_num_batches, 1);
+    this->template solve<SmallColoringType>(bg, vPrecolor, vColor, numThreads);
+
+    for (uint32_t i = 0; i < vPending.size(); ++i)
+    {
+        std::copy(vColor.begin()+vOffset[i], vColor.begin()+vOffset[i]+vPending[i].view.size(), m_vSubColor.begin()+vPending[i].view.offset());
+        this->save_component(vPending[i]);
+    }
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+bool ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::prepare_component(pending_type& pc)
+{
+    component_view const& view = pc.view;
+    std::vector<int8_t>::iterator vColor = m_vSubColor.begin()+view.offset();
+    if (view.size() == 0)
+        return true;
+
+    if (!m_vPrevColor.empty())
+    {
+        uint32_t v = 0;
+        for (; v < view.size(); ++v)
+            if (!this->clean(view.vertex(v)))
+                break;
+        if (v == view.size()) // no edge of the component is changed 
+        {
+            __sync_fetch_and_add(&m_num_reused, 1);
+            for (v = 0; v < view.size(); ++v)
+                vColor[v] = m_vPrevColor[view.vertex(v)];
+            return true;
+        }
+    }
+
+    pc.vPrecolor.assign(view.size(), -1);
+    for (uint32_t v = 0; v < view.size(); ++v)
+    {
+        graph_vertex_type orig = view.vertex(v);
+        pc.vPrecolor[v] = this->m_vColor[orig];
+        // articulation points shared with components that keep previous colors 
+        if (pc.vPrecolor[v] < 0 && !m_vPrevColor.empty() && m_gs->articulation_point(orig) && this->clean(orig))
+            pc.vPrecolor[v] = m_vPrevColor[orig];
+    }
+    if (!m_gs->forbidden_colors().empty())
+        this->anchor_component(pc);
+
+    // forbidden colors are not in the canonical forms 
+    if (m_cache.capacity() > 0 && pc.vAnchorWeight.empty())
+    {
+        // the canonical form is computed from the view, no graph is built for components found in the cache 
+        m_cache.canonical_form(view, pc.vPrecolor, pc.key, pc.vLabel);
+        std::vector<int8_t> vCachedColor (view.size(), -1);
+        if (m_cache.find(pc.key, pc.vLabel, vCachedColor))
+        {
+            __sync_fetch_and_add(&m_num_cached, 1);
+            std::copy(vCachedColor.begin(), vCachedColor.end(), vColor);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+void ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::anchor_component(pending_type& pc) const
+{
+    component_view const& view = pc.view;
+    std::vector<uint8_t> const& vForbidden = m_gs->forbidden_colors();
+    uint8_t mask = 0;
+    for (uint32_t v = 0; v < view.size(); ++v)
+        mask |= vForbidden[view.vertex(v)];
+    if (mask == 0)
+        return;
+
+    std::vector<int8_t> vAnchorColor;
+    for (int8_t c = 0; c < (int8_t)this->color_num(); ++c)
+        if (mask & (1 << c))
+            vAnchorColor.push_back(c);
+    uint32_t numAnchors = vAnchorColor.size();
+    pc.vAnchorWeight.assign(view.size()*numAnchors, 0);
+    std::vector<edge_weight_type> vWeight;
+    for (uint32_t v = 0; v < view.size(); ++v)
+    {
+        if (vForbidden[view.vertex(v)] == 0)
+            continue;
+        m_gs->pruned_weights(view.vertex(v), vWeight);
+        for (uint32_t a = 0; a < numAnchors; ++a)
+            pc.vAnchorWeight[v*numAnchors+a] = vWeight[vAnchorColor[a]];
+    }
+    pc.vPrecolor.insert(pc.vPrecolor.end(), vAnchorColor.begin(), vAnchorColor.end());
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+void ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::build_component(pending_type const& pc, ComponentGraphBuilder<graph_type>& builder) const
+{
+    component_view const& view = pc.view;
+    view.for_each_edge(builder);
+    if (pc.vAnchorWeight.empty())
+        return;
+    // anchors follow the vertices of the component, and only vertices with the forbidden colors are connected 
+    std::vector<uint8_t> const& vForbidden = m_gs->forbidden_colors();
+    uint32_t numAnchors = pc.vPrecolor.size()-view.size();
+    for (uint32_t v = 0; v < view.size(); ++v)
+        for (uint32_t a = 0; a < numAnchors; ++a)
+            if (vForbidden[view.vertex(v)] & (1 << pc.vPrecolor[view.size()+a]))
+                builder(v, view.size()+a, pc.vAnchorWeight[v*numAnchors+a]);
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+void ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::save_component(pending_type const& pc)
+{
+    if (m_cache.capacity() > 0 && pc.vAnchorWeight.empty())
+    {
+        std::vector<int8_t> vColor (m_vSubColor.begin()+pc.view.offset(), m_vSubColor.begin()+pc.view.offset()+pc.view.size());
+        m_cache.insert(pc.key, pc.vLabel, vColor);
+    }
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+bool ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::clean(graph_vertex_type v) const
+{
+    std::vector<graph_vertex_type> const& vChildren = m_gs->children().at(v);
+    for (typename std::vector<graph_vertex_type>::const_iterator it = vChildren.begin(); it != vChildren.end(); ++it)
+    {
+        if (m_vDirty[*it] || m_vPrevColor[*it] < 0 || m_vPrevColor[*it] >= (int8_t)this->color_num())
+            return false;
+        // merged vertices must share the same color 
+        if (m_vPrevColor[*it] != m_vPrevColor[v])
+            return false;
+    }
+    return true;
+}
+
+template <typename GraphType, typename SmallColoringType, typename LargeColoringType>
+template <typename SolverType>
+void ComponentColoring<GraphType, SmallColoringType, LargeColoringType>::solve(graph_type const& sg,
+        std::vector<int8_t> const& vPrecolor, std::vector<int8_t>& vColor, int32_t numThreads, double timeLimit)
+{
+    SolverType solver (sg);
+    solver.collect_statistics(this->m_collect_statistics);
+    solver.stitch_weight(this->stitch_weight());
+    solver.color_num(this->color_num());
+    solver.threads(numThreads);
+    solver.time_limit(timeLimit);
+    for (uint32_t v = 0; v < vPrecolor.size(); ++v)
+        if (vPrecolor[v] >= 0)
+            solver.precolor(v, vPrecolor[v]);
+    solver();
+    for (uint32_t v = 0; v < vColor.size(); ++v)
+        vColor[v] = solver.color(v);
+    if (this->m_collect_statistics)
+        this->m_statistics.add_solver(solver.statistics());
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
@@ -0,0 +1,381 @@
+/**
+ * @file   ConflictGraphBuilder.h
+ * @brief  build conflict graphs for coloring from layout rectangles by a tiled sweep line
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_CONFLICTGRAPHBUILDER
+#define LIMBO_ALGORITHMS_COLORING_CONFLICTGRAPHBUILDER
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/containers/LargeMemory.h>
+#include <limbo/preprocessor/AssertMsg.h>
+#include <limbo/geometry/Geometry.h>
+#include <limbo/geometry/RectangleIndex.h>
+#include <limbo/algorithms/CsrGraph.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+using boost::uint32_t;
+using boost::int32_t;
+using boost::int64_t;
+
+/// @class limbo::algorithms::coloring::ConflictGraphBuilder
+/// Build the conflict graph of layout rectangles, e.g., polygons split by @ref limbo::geometry::Polygon2Rectangle,
+/// as a @ref limbo::algorithms::CsrGraph for the coloring algorithms.
+///
+/// Each rectangle is a vertex.
+/// Rectangles of the same polygon that touch or overlap are connected by stitch candidates with weight -1,
+/// and other rectangles closer than the coloring distance are connected by conflict edges with weight 1.
+///
+/// Rectangles are bloated by half of the coloring distance and binned into square tiles,
+/// so a rectangle appears in every tile its bloated box overlaps, i.e., the tiles with halo regions.
+/// Tiles are swept along x by threads independently.
+/// A pair is reported only by the tile containing the lower left corner of the intersection of the bloated boxes,
+/// so each edge is found once, and the edges do not depend on the number of threads.
+/// Memory is linear in the rectangles with their halo copies and the edges.
+/// @tparam RectType rectangle type supported by @ref limbo::geometry::rectangle_traits
+/// @tparam WeightType edge weight type of the graph
+template <typename RectType, typename WeightType = int32_t>
+class ConflictGraphBuilder
+{
+	public:
+        /// @nowarn
+		typedef RectType rectangle_type;
+		typedef limbo::geometry::rectangle_traits<rectangle_type> rectangle_traits_type;
+		typedef typename rectangle_traits_type::coordinate_type coordinate_type;
+		typedef limbo::algorithms::CsrGraph<WeightType> graph_type;
+        /// @endnowarn
+
+		/// constructor
+		/// @param distance coloring distance, rectangles closer than it are in conflict
+		ConflictGraphBuilder(coordinate_type distance);
+
+		/// add a rectangle
+		/// @param rect rectangle
+		/// @param polygon_id polygon containing the rectangle
+		/// @return vertex of the rectangle
+		uint32_t add(rectangle_type const& rect, uint32_t polygon_id);
+		/// @return number of rectangles
+		uint32_t num_rectangles() const {return m_vPolygon.size();}
+		/// @param v vertex
+		/// @return polygon of the rectangle of \a v
+		uint32_t polygon(uint32_t v) const {return m_vPolygon[v];}
+		/// set number of threads
+		/// @param t number of threads
+		void threads(int32_t t) {m_threads = t;}
+		/// set the side of tiles
+		/// @param s side, 0 to choose it by the number and extent of rectangles
+		void tile_size(coordinate_type s) {m_tile_size = s;}
+		/// @return number of conflict edges in the last build
+		uint32_t num_conflict_edges() const {return m_num_conflict_edges;}
+		/// @return number of stitch candidates in the last build
+		uint32_t num_stitch_edges() const {return m_num_stitch_edges;}
+
+		/// build the graph
+		/// @param g conflict graph with a vertex for each rectangle in the order of @ref add
+		void operator()(graph_type& g);
+		/// order rectangles along a Hilbert curve of their centers,
+		/// so that vertices close in the layout can be close in memory, see @ref limbo::algorithms::coloring::ComponentColoring::vertex_order
+		/// @param vOrder rectangle at each position as output
+		void hilbert_order(std::vector<uint32_t>& vOrder) const;
+
+	protected:
+		/// rectangle with coordinates in the order of @ref limbo::geometry::direction_2d
+		struct box_type
+		{
+			int64_t xl; ///< left
+			int64_t yl; ///< bottom
+			int64_t xh; ///< right
+			int64_t yh; ///< top
+		};
+		/// rectangles, large layouts are mapped with huge pages and spread over NUMA nodes
+		typedef std::vector<box_type, limbo::containers::LargeAllocator<box_type> > box_array_type;
+		/// compare rectangles by the left side
+		struct BoxLeftLess
+		{
+			box_array_type const& vBox; ///< rectangles
+			/// constructor
+			/// @param vb rectangles
+			BoxLeftLess(box_array_type const& vb) : vBox(vb) {}
+			/// @return true if \a v1 is on the left of \a v2, ties broken by vertices
+			bool operator()(uint32_t v1, uint32_t v2) const {return (vBox[v1].xl == vBox[v2].xl)? v1 < v2 : vBox[v1].xl < vBox[v2].xl;}
+		};
+
+		/// bin rectangles into tiles
+		void bin();
+		/// find the edges reported by a tile
+		/// @param tile tile id
+		void sweep_tile(uint32_t tile);
+		/// @param x coordinate
+		/// @param x0 coordinate of the first tile
+		/// @return column or row of a tile
+		int64_t tile_index(int64_t x, int64_t x0) const {return (x-x0)/m_tile_side;}
+		/// tiles swept by limbo::containers::parallel_for
+		struct TileKernel
+		{
+			ConflictGraphBuilder* builder; ///< builder
+			/// @param b first tile
+			/// @param e end tile
+			void operator()(std::size_t b, std::size_t e) const {for (; b < e; ++b) builder->sweep_tile(b);}
+		};
+
+		coordinate_type m_distance; ///< coloring distance
+		int64_t m_halo; ///< bloating of rectangles, half of the coloring distance rounded up
+		box_array_type m_vBox; ///< rectangles
+		std::vector<uint32_t> m_vPolygon; ///< polygon of each rectangle
+		int32_t m_threads; ///< number of threads
+		coordinate_type m_tile_size; ///< side of tiles set by users, 0 if automatic
+
+		int64_t m_tile_side; ///< side of tiles in the current build
+		int64_t m_x0; ///< left of the first tile column
+		int64_t m_y0; ///< bottom of the first tile row
+		int64_t m_num_cols; ///< number of tile columns
+		int64_t m_num_rows; ///< number of tile rows
+		std::vector<uint32_t> m_vTileBegin; ///< offset of each tile in m_vTileEntry, with one more entry for the end
+		CsrIndexArray m_vTileEntry; ///< rectangles overlapping each tile with their bloated boxes
+		std::vector<std::vector<std::pair<uint32_t, uint32_t> > > m_mTileEdge; ///< edges reported by each tile
+		std::vector<std::vector<WeightType> > m_mTileWeight; ///< weights of edges reported by each tile
+		uint32_t m_num_conflict_edges; ///< number of conflict edges in the last build
+		uint32_t m_num_stitch_edges; ///< number of stitch candidates in the last build
+};
+
+template <typename RectType, typename WeightType>
+ConflictGraphBuilder<RectType, WeightType>::ConflictGraphBuilder(coordinate_type distance)
+	: m_distance(distance)
+	, m_halo(((int64_t)distance+1)/2)
+	, m_threads(1)
+	, m_tile_size(0)
+	, m_tile_side(1)
+	, m_x0(0)
+	, m_y0(0)
+	, m_num_cols(0)
+	, m_num_rows(0)
+	, m_num_conflict_edges(0)
+	, m_num_stitch_edges(0)
+{
+	limboAssertMsg(distance > 0, "coloring distance must be positive");
+}
+
+template <typename RectType, typename WeightType>
+uint32_t ConflictGraphBuilder<RectType, WeightType>::add(rectangle_type const& rect, uint32_t polygon_id)
+{
+	box_type box;
+	box.xl = rectangle_traits_type::get(rect, limbo::geometry::LEFT);
+	box.yl = rectangle_traits_type::get(rect, limbo::geometry::BOTTOM);
+	box.xh = rectangle_traits_type::get(rect, limbo::geometry::RIGHT);
+	box.yh = rectangle_traits_type::get(rect, limbo::geometry::TOP);
+	m_vBox.push_back(box);
+	m_vPolygon.push_back(polygon_id);
+	return m_vPolygon.size()-1;
+}
+
+template <typename RectType, typename WeightType>
+void ConflictGraphBuilder<RectType, WeightType>::operator()(graph_type& g)
+{
+	this->bin();
+	uint32_t numTiles = m_vTileBegin.size()-1;
+	m_mTileEdge.assign(numTiles, std::vector<std::pair<uint32_t, uint32_t> >());
+	m_mTileWeight.assign(numTiles, std::vector<WeightType>());
+
+	int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), m_threads);
+	numThreads = std::max(std::min(numThreads, (int32_t)numTiles), 1);
+	TileKernel kernel = {this};
+	limbo::containers::parallel_for(0, numTiles, 1, numThreads, kernel);
+	CsrIndexArray().swap(m_vTileEntry);
+
+	// edges in the order of tiles, releasing each tile once copied
+	std::vector<std::pair<uint32_t, uint32_t> > vEdge;
+	std::vector<WeightType> vWeight;
+	uint32_t numEdges = 0;
+	for (uint32_t i = 0; i < numTiles; ++i)
+		numEdges += m_mTileEdge[i].size();
+	vEdge.reserve(numEdges);
+	vWeight.reserve(numEdges);
+	m_num_conflict_edges = m_num_stitch_edges = 0;
+	for (uint32_t i = 0; i < numTiles; ++i)
+	{
+		vEdge.insert(vEdge.end(), m_mTileEdge[i].begin(), m_mTileEdge[i].end());
+		vWeight.insert(vWeight.end(), m_mTileWeight[i].begin(), m_mTileWeight[i].end());
+		std::vector<std::pair<uint32_t, uint32_t> >().swap(m_mTileEdge[i]);
+		std::vector<WeightType>().swap(m_mTileWeight[i]);
+	}
+	for (uint32_t i = 0; i < numEdges; ++i)
+	{
+		if (vWeight[i] < 0)
+			++m_num_stitch_edges;
+		else
+			++m_num_conflict_edges;
+	}
+	graph_type(m_vBox.size(), vEdge.begin(), vEdge.end(), vWeight.begin()).swap(g);
+}
+
+template <typename RectType, typename WeightType>
+void ConflictGraphBuilder<RectType, WeightType>::hilbert_order(std::vector<uint32_t>& vOrder) const
+{
+	vOrder.clear();
+	if (m_vBox.empty())
+		return;
+	// doubled centers avoid rounding
+	int64_t xl = std::numeric_limits<int64_t>::max();
+	int64_t yl = std::numeric_limits<int64_t>::max();
+	int64_t xh = std::numeric_limits<int64_t>::min();
+	int64_t yh = std::numeric_limits<int64_t>::min();
+	for (typename box_array_type::const_iterator it = m_vBox.begin(); it != m_vBox.end(); ++it)
+	{
+		xl = std::min(xl, it->xl+it->xh);
+		yl = std::min(yl, it->yl+it->yh);
+		xh = std::max(xh, it->xl+it->xh);
+		yh = std::max(yh, it->yl+it->yh);
+	}
+	// map centers to a 2^16 x 2^16 grid, ties are broken by vertices
+	double sx = 65535.0/std::max((double)(xh-xl), 1.0);
+	double sy = 65535.0/std::max((double)(yh-yl), 1.0);
+	std::vector<std::pair<unsigned int, uint32_t> > vKey (m_vBox.size());
+	for (uint32_t v = 0; v < m_vBox.size(); ++v)
+	{
+		unsigned int x = (unsigned int)((m_vBox[v].xl+m_vBox[v].xh-xl)*sx);
+		unsigned int y = (unsigned int)((m_vBox[v].yl+m_vBox[v].yh-yl)*sy);
+		vKey[v] = std::make_pair(limbo::geometry::hilbert_index(x, y), v);
+	}
+	std::sort(vKey.begin(), vKey.end());
+	vOrder.resize(vKey.size());
+	for (uint32_t i = 0; i < vKey.size(); ++i)
+		vOrder[i] = vKey[i].second;
+}
+
+template <typename RectType, typename WeightType>
+void ConflictGraphBuilder<RectType, WeightType>::bin()
+{
+	m_vTileBegin.assign(1, 0);
+	m_vTileEntry.clear();
+	if (m_vBox.empty())
+		return;
+
+	// extent of bloated rectangles
+	int64_t xl = std::numeric_limits<int64_t>::max();
+	int64_t yl = std::numeric_limits<int64_t>::max();
+	int64_t xh = std::numeric_limits<int64_t>::min();
+	int64_t yh = std::numeric_limits<int64_t>::min();
+	for (typename box_array_type::const_iterator it = m_vBox.begin(); it != m_vBox.end(); ++it)
+	{
+		xl = std::min(xl, it->xl-m_halo);
+		yl = std::min(yl, it->yl-m_halo);
+		xh = std::max(xh, it->xh+m_halo);
+		yh = std::max(yh, it->yh+m_halo);
+	}
+	m_x0 = xl;
+	m_y0 = yl;
+	if (m_tile_size > 0)
+		m_tile_side = m_tile_size;
+	else // about 1024 rectangles per tile, but no smaller than the halo on both sides
+	{
+		double area = (double)(xh-xl+1)*(yh-yl+1);
+		double numTiles = std::max(1.0, m_vBox.size()/1024.0);
+		m_tile_side = std::max((int64_t)std::ceil(std::sqrt(area/numTiles)), 4*m_halo);
+	}
+	m_tile_side = std::max(m_tile_side, (int64_t)1);
+	m_num_cols = tile_index(xh, m_x0)+1;
+	m_num_rows = tile_index(yh, m_y0)+1;
+	limboAssertMsg(m_num_cols*m_num_rows < std::numeric_limits<uint32_t>::max(), "too many tiles, increase tile size");
+
+	// count and fill the tiles overlapped by each bloated rectangle
+	uint32_t numTiles = m_num_cols*m_num_rows;
+	m_vTileBegin.assign(numTiles+1, 0);
+	for (uint32_t pass = 0; pass < 2; ++pass)
+	{
+		std::vector<uint32_t> vPos;
+		if (pass == 1)
+		{
+			for (uint32_t i = 0; i < numTiles; ++i)
+				m_vTileBegin[i+1] += m_vTileBegin[i];
+			m_vTileEntry.resize(m_vTileBegin.back());
+			vPos.assign(m_vTileBegin.begin(), m_vTileBegin.end()-1);
+		}
+		for (uint32_t v = 0; v < m_vBox.size(); ++v)
+		{
+			box_type const& box = m_vBox[v];
+			int64_t cl = tile_index(box.xl-m_halo, m_x0);
+			int64_t ch = tile_index(box.xh+m_halo, m_x0);
+			int64_t rl = tile_index(box.yl-m_halo, m_y0);
+			int64_t rh = tile_index(box.yh+m_halo, m_y0);
+			for (int64_t c = cl; c <= ch; ++c)
+				for (int64_t r = rl; r <= rh; ++r)
+				{
+					uint32_t tile = c*m_num_rows+r;
+					if (pass == 0)
+						++m_vTileBegin[tile+1];
+					else
+						m_vTileEntry[vPos[tile]++] = v;
+				}
+		}
+	}
+}
+
+template <typename RectType, typename WeightType>
+void ConflictGraphBuilder<RectType, WeightType>::sweep_tile(uint32_t tile)
+{
+	int64_t col = tile/m_num_rows;
+	int64_t row = tile%m_num_rows;
+	int64_t span = 2*m_halo; // bloated boxes intersect if gaps are no larger than it
+	double distance2 = (double)m_distance*m_distance;
+	std::vector<std::pair<uint32_t, uint32_t> >& vEdge = m_mTileEdge[tile];
+	std::vector<WeightType>& vWeight = m_mTileWeight[tile];
+
+	std::vector<uint32_t> vOrder (m_vTileEntry.begin()+m_vTileBegin[tile], m_vTileEntry.begin()+m_vTileBegin[tile+1]);
+	std::sort(vOrder.begin(), vOrder.end(), BoxLeftLess(m_vBox));
+	std::vector<uint32_t> vActive;
+	for (std::vector<uint32_t>::const_iterator it = vOrder.begin(); it != vOrder.end(); ++it)
+	{
+		uint32_t v = *it;
+		box_type const& bv = m_vBox[v];
+		// drop rectangles too far on the left, they are also too far for the following ones
+		uint32_t numActive = 0;
+		for (uint32_t i = 0; i < vActive.size(); ++i)
+		{
+			uint32_t u = vActive[i];
+			box_type const& bu = m_vBox[u];
+			if (bv.xl-bu.xh > span)
+				continue;
+			vActive[numActive++] = u;
+			int64_t gapY = std::max(bu.yl-bv.yh, bv.yl-bu.yh);
+			if (gapY > span)
+				continue;
+			// the lower left corner of the intersection of bloated boxes decides the reporting tile
+			if (tile_index(std::max(bu.xl, bv.xl)-m_halo, m_x0) != col || tile_index(std::max(bu.yl, bv.yl)-m_halo, m_y0) != row)
+				continue;
+			int64_t dx = std::max((int64_t)0, std::max(bu.xl-bv.xh, bv.xl-bu.xh));
+			int64_t dy = std::max((int64_t)0, gapY);
+			WeightType w = 0;
+			if (dx == 0 && dy == 0 && m_vPolygon[u] == m_vPolygon[v])
+				w = -1;
+			else if ((double)dx*dx+(double)dy*dy < distance2)
+				w = 1;
+			else
+				continue;
+			vEdge.push_back(std::make_pair(std::min(u, v), std::max(u, v)));
+			vWeight.push_back(w);
+		}
+		vActive.resize(numActive);
+		vActive.push_back(v);
+	}
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
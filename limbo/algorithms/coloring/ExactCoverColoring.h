@@ -0,0 +1,146 @@
+/**
+ * @file   ExactCoverColoring.h
+ * @brief  conflict-free coloring of small graphs as an exact cover solved in parallel
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_EXACTCOVERCOLORING
+#define LIMBO_ALGORITHMS_COLORING_EXACTCOVERCOLORING
+
+#include <limbo/algorithms/ExactCover.h>
+#include <limbo/algorithms/coloring/Coloring.h>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+/// @class limbo::algorithms::coloring::ExactCoverColoring
+/// Find a coloring without conflicts by @ref limbo::algorithms::ExactAssignment,
+/// an exact and parallel alternative to @ref limbo::algorithms::coloring::BacktrackColoring for small components.
+///
+/// Each vertex takes one color, and the same color of two neighbors is a conflict.
+/// Precolored vertices only have their colors.
+/// Without precolored vertices, colors are symmetric, so the vertex of the largest degree only takes the first color.
+///
+/// A coloring without conflicts has zero cost, so it is optimal.
+/// Graphs with stitch edges, or without such a coloring, are solved by @ref limbo::algorithms::coloring::BacktrackColoring.
+/// @tparam GraphType graph type
+template <typename GraphType>
+class ExactCoverColoring : public Coloring<GraphType>
+{
+	public:
+        /// @nowarn
+		typedef Coloring<GraphType> base_type;
+		using typename base_type::graph_type;
+		using typename base_type::graph_vertex_type;
+		using typename base_type::graph_edge_type;
+		using typename base_type::vertex_iterator_type;
+		using typename base_type::edge_iterator_type;
+        using typename base_type::edge_weight_type;
+		using typename base_type::ColorNumType;
+        /// @endnowarn
+
+		/// constructor
+        /// @param g graph
+		ExactCoverColoring(graph_type const& g) : base_type(g) {}
+		/// destructor
+		virtual ~ExactCoverColoring() {}
+	protected:
+		/// @return objective value
+		virtual double coloring();
+		/// find a coloring without conflicts
+		/// @return false if there are stitch edges or no such coloring
+		bool solve_exact();
+};
+
+template <typename GraphType>
+double ExactCoverColoring<GraphType>::coloring()
+{
+	if (this->solve_exact())
+		return 0;
+
+	BacktrackColoring<graph_type> bc (this->m_graph);
+	bc.stitch_weight(this->stitch_weight());
+	bc.color_num(this->color_num());
+	for (uint32_t v = 0; v < this->m_vColor.size(); ++v)
+		if (this->m_vColor[v] >= 0 && this->m_vColor[v] < this->color_num())
+			bc.precolor(v, this->m_vColor[v]);
+	double cost = bc();
+	for (uint32_t v = 0; v < this->m_vColor.size(); ++v)
+		this->m_vColor[v] = bc.color(v);
+	return cost;
+}
+
+template <typename GraphType>
+bool ExactCoverColoring<GraphType>::solve_exact()
+{
+	uint32_t numVertices = boost::num_vertices(this->m_graph);
+	uint32_t colorNum = this->color_num();
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
+		if (boost::get(boost::edge_weight, this->m_graph, *ei) < 0)
+			return false;
+
+	bool precolored = false;
+	uint32_t first = 0; // vertex of the largest degree
+	for (uint32_t v = 0; v < numVertices; ++v)
+	{
+		precolored |= (this->m_vColor[v] >= 0 && this->m_vColor[v] < (int8_t)colorNum);
+		if (boost::out_degree(v, this->m_graph) > boost::out_degree(first, this->m_graph))
+			first = v;
+	}
+
+	// choice v*colorNum+c colors vertex v with c; choices out of the domain of v stay unused
+	ExactAssignment ea (numVertices);
+	ea.threads(this->m_threads);
+	std::vector<bool> vAllowed (numVertices*colorNum, false);
+	for (uint32_t v = 0; v < numVertices; ++v)
+	{
+		int8_t pc = this->m_vColor[v];
+		for (uint32_t c = 0; c < colorNum; ++c)
+		{
+			if (pc >= 0 && pc < (int8_t)colorNum)
+				vAllowed[v*colorNum+c] = (c == (uint32_t)pc);
+			else
+				vAllowed[v*colorNum+c] = (precolored || v != first || c == 0);
+		}
+	}
+	std::vector<uint32_t> vChoice (numVertices*colorNum, std::numeric_limits<uint32_t>::max());
+	for (uint32_t i = 0; i < vAllowed.size(); ++i)
+		if (vAllowed[i])
+			vChoice[i] = ea.add_choice(i/colorNum);
+	for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
+	{
+		uint32_t s = boost::source(*ei, this->m_graph);
+		uint32_t t = boost::target(*ei, this->m_graph);
+		if (s == t) // a self loop is always a conflict
+			return false;
+		for (uint32_t c = 0; c < colorNum; ++c)
+			if (vAllowed[s*colorNum+c] && vAllowed[t*colorNum+c])
+				ea.add_conflict(vChoice[s*colorNum+c], vChoice[t*colorNum+c]);
+	}
+
+	std::vector<uint32_t> vAssigned;
+	if (!ea.solve(vAssigned))
+		return false;
+	std::vector<uint32_t> vColorOfChoice (vChoice.size());
+	for (uint32_t i = 0; i < vChoice.size(); ++i)
+		if (vAllowed[i])
+			vColorOfChoice[vChoice[i]] = i%colorNum;
+	for (uint32_t v = 0; v < numVertices; ++v)
+		this->m_vColor[v] = vColorOfChoice[vAssigned[v]];
+	return true;
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
 #include <stack>
 #include <list>
 #include <string>
@@ -26,7 +27,10 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/undirected_graph.hpp>
 #include <boost/property_map/property_map.hpp>
+#include <limbo/containers/TaskPool.h>
 #include <limbo/preprocessor/AssertMsg.h>
+#include <limbo/preprocessor/Instrument.h>
+#include <limbo/preprocessor/MemoryUsage.h>
 #include <limbo/math/Math.h>
 #include <limbo/algorithms/GraphUtility.h>
 
@@ -56,14 +60,17 @@ class GraphSimplification
 		typedef typename boost::graph_traits<graph_type>::edge_descriptor graph_edge_type;
 		typedef typename boost::graph_traits<graph_type>::vertex_iterator vertex_iterator;
 		typedef typename boost::graph_traits<graph_type>::adjacency_iterator adjacency_iterator;
+		typedef typename boost::graph_traits<graph_type>::out_edge_iterator out_edge_iterator;
 		typedef typename boost::graph_traits<graph_type>::edge_iterator edge_iterator;
+		typedef typename boost::property_traits<typename boost::property_map<graph_type, boost::edge_weight_t>::const_type>::value_type edge_weight_type;
         /// @endnowarn
 
         /// @brief status of vertex. 
 		enum vertex_status_type {
 			GOOD, ///< still in graph 
 			HIDDEN, ///< vertex is hidden by simplification  
-			MERGED ///< vertex is merged to other vertex 
+			MERGED, ///< vertex is merged to other vertex 
+			PRUNED ///< vertex is precolored and removed, its color is forbidden to its neighbors 
 		};
 		/// @brief simplification strategies available. 
 		/// These strategies are order-sensitive.  
@@ -73,7 +80,86 @@ class GraphSimplification
 			NONE = 0, ///< no simplification 
 			HIDE_SMALL_DEGREE = 1, ///< hide vertices whose degree is smaller than number of colors available 
 			MERGE_SUBK4 = 2, ///< merge 4-clique structures, no longer optimal 
-			BICONNECTED_COMPONENT = 4 ///< divide graph by biconnected components 
+			BICONNECTED_COMPONENT = 4, ///< divide graph by biconnected components 
+			PRUNE_PRECOLOR = 8 ///< remove precolored vertices and record their colors as forbidden colors of neighbors, applied first 
+		};
+		/// @brief all components of the simplified graph in CSR form, built once by @ref simplified_components. 
+		/// An entry of vVertex is a vertex of a component, and its local index is its position minus the offset of the component. 
+		struct component_set_type
+		{
+			std::vector<graph_vertex_type> vVertex; ///< original vertices grouped by components, an articulation point appears once in each of its components 
+			std::vector<uint32_t> vBegin; ///< offset of each component in vVertex, with one more entry for the end 
+			std::vector<uint32_t> vAdjBegin; ///< offset of the neighbors of each entry of vVertex in vAdj, with one more entry for the end 
+			std::vector<uint32_t> vAdj; ///< local indices of neighbors in the order of first occurrence over merged vertices and their adjacency 
+			std::vector<edge_weight_type> vWeight; ///< weights of entries of vAdj, accumulated over edges between merged vertices 
+
+			/// constructor 
+			component_set_type() : vBegin(1, 0), vAdjBegin(1, 0) {}
+			/// @return number of components 
+			uint32_t size() const {return vBegin.size()-1;}
+			/// @brief report bytes under category "GraphSimplification/component_set" 
+			/// @param usage bytes are added to it 
+			void memory_usage(limbo::MemoryUsage& usage) const 
+			{
+				usage.add("GraphSimplification/component_set", sizeof(*this) + limbo::heap_bytes(vVertex) + limbo::heap_bytes(vBegin) 
+						+ limbo::heap_bytes(vAdjBegin) + limbo::heap_bytes(vAdj) + limbo::heap_bytes(vWeight)); 
+			}
+		};
+		/// @brief a component of a @ref component_set_type, which refers to the arrays of the set without copying. 
+		/// Vertices are local indices from 0 to size()-1, the same as the graph from @ref simplified_graph_component. 
+		class component_view 
+		{
+			public:
+				/// default constructor, an empty view 
+				component_view() : m_set(NULL), m_comp_id(0), m_offset(0), m_size(0) {}
+				/// constructor 
+				/// @param cs all components 
+				/// @param comp_id component id 
+				component_view(component_set_type const& cs, uint32_t comp_id) 
+					: m_set(&cs), m_comp_id(comp_id), m_offset(cs.vBegin.at(comp_id)), m_size(cs.vBegin[comp_id+1]-cs.vBegin[comp_id]) {}
+				/// @return component id 
+				uint32_t comp_id() const {return m_comp_id;}
+				/// @return offset of the component in the arrays of the set 
+				uint32_t offset() const {return m_offset;}
+				/// @return number of vertices 
+				uint32_t size() const {return m_size;}
+				/// @return number of edges 
+				uint32_t num_edges() const {return (m_set->vAdjBegin[m_offset+m_size]-m_set->vAdjBegin[m_offset])/2;}
+				/// @param i local index 
+				/// @return vertex of the original graph 
+				graph_vertex_type vertex(uint32_t i) const {return m_set->vVertex[m_offset+i];}
+				/// @param i local index 
+				/// @return position of the first neighbor of \a i, used by @ref neighbor and @ref weight 
+				uint32_t adj_begin(uint32_t i) const {return m_set->vAdjBegin[m_offset+i];}
+				/// @param i local index 
+				/// @return position past the last neighbor of \a i 
+				uint32_t adj_end(uint32_t i) const {return m_set->vAdjBegin[m_offset+i+1];}
+				/// @param k position from @ref adj_begin 
+				/// @return local index of the neighbor 
+				uint32_t neighbor(uint32_t k) const {return m_set->vAdj[k];}
+				/// @param k position from @ref adj_begin 
+				/// @return weight of the edge 
+				edge_weight_type weight(uint32_t k) const {return m_set->vWeight[k];}
+				/// call a function on each edge once in the order of edges of the graph from @ref simplified_graph_component, 
+				/// i.e., from the end with the smaller original vertex 
+				/// @tparam EdgeFunction function object called with (local index, local index, weight) 
+				/// @param f function object 
+				template <typename EdgeFunction>
+				void for_each_edge(EdgeFunction& f) const 
+				{
+					for (uint32_t i = 0; i < m_size; ++i)
+						for (uint32_t k = this->adj_begin(i), ke = this->adj_end(i); k < ke; ++k)
+							if (this->vertex(this->neighbor(k)) > this->vertex(i))
+								f(i, this->neighbor(k), this->weight(k));
+				}
+				/// build a graph of the component, the same as @ref simplified_graph_component 
+				/// @param sg graph, vertex i is local index i 
+				void graph(graph_type& sg) const;
+			protected:
+				component_set_type const* m_set; ///< all components 
+				uint32_t m_comp_id; ///< component id 
+				uint32_t m_offset; ///< offset of the component in the set 
+				uint32_t m_size; ///< number of vertices 
 		};
 		/// constructor 
         /// @param g graph 
@@ -83,14 +169,19 @@ class GraphSimplification
 			, m_color_num (color_num)
 			, m_level (NONE)
             , m_max_merge_level(std::numeric_limits<uint32_t>::max())
+            , m_threads(1)
 			, m_vStatus(boost::num_vertices(g), GOOD)
 			, m_vParent(boost::num_vertices(g))
 			, m_vChildren(boost::num_vertices(g))
 			, m_vHiddenVertex()
-			, m_mCompVertex()
+			, m_vCompVertex()
+			, m_vCompVertexBegin(1, 0)
 //			, m_vComponent(boost::num_vertices(g), std::numeric_limits<uint32_t>::max())
 //			, m_sBridgeEdge()
-			, m_mArtiPoint()
+			, m_vArtiPointId(boost::num_vertices(g), std::numeric_limits<uint32_t>::max())
+			, m_vArtiPoint()
+			, m_vArtiPointCompBegin(1, 0)
+			, m_vArtiPointComp()
 			, m_vPrecolor(boost::num_vertices(g), -1)
 			, m_isVDDGND(boost::num_vertices(g), false) // added by Qi Sun, represent whethe this vertex is VDDGND, used in IVR
 		{
@@ -129,6 +220,35 @@ class GraphSimplification
 		std::vector<std::vector<graph_vertex_type> > const& children() const {return m_vChildren;}
         /// @return hidden vertex array of vertices 
 		std::stack<graph_vertex_type> const& hidden_vertices() const {return m_vHiddenVertex;}
+        /// @return number of vertices merged to other vertices 
+		uint32_t num_merged() const {return std::count(m_vStatus.begin(), m_vStatus.end(), MERGED);}
+        /// @return number of hidden vertices 
+		uint32_t num_hidden() const {return std::count(m_vStatus.begin(), m_vStatus.end(), HIDDEN);}
+        /// @return number of pruned vertices, including those merged into precolored vertices 
+		uint32_t num_pruned() const {return std::count(m_vStatus.begin(), m_vStatus.end(), PRUNED);}
+        /// @brief colors of pruned vertices connected to each vertex by conflict edges as bit masks, 
+        /// i.e., bit c is set if the vertex or a vertex merged into it has a conflict edge to a vertex pruned with color c. 
+        /// A solver must honor them, e.g., by the weights from @ref pruned_weights. 
+        /// @return masks of vertices, empty if no vertex is pruned 
+		std::vector<uint8_t> const& forbidden_colors() const {return m_vForbidden;}
+        /// add up the weights of conflict edges to pruned vertices by their colors, 
+        /// which are the costs of taking the forbidden colors 
+        /// @param v vertex of the simplified graph 
+        /// @param vWeight weight to the pruned vertices of each color, resized to the number of colors 
+		void pruned_weights(graph_vertex_type v, std::vector<edge_weight_type>& vWeight) const;
+        /// @brief report bytes of the state, excluding the graph, under categories "GraphSimplification/vertices" 
+        /// for status, merging and hiding of vertices and "GraphSimplification/components" for components and articulation points 
+        /// @param usage bytes are added to it 
+		void memory_usage(limbo::MemoryUsage& usage) const 
+		{
+			// the stack of hidden vertices does not expose its capacity 
+			usage.add("GraphSimplification/vertices", sizeof(*this) + limbo::heap_bytes(m_vStatus) + limbo::heap_bytes(m_vParent) 
+					+ limbo::heap_bytes(m_vChildren) + m_vHiddenVertex.size()*sizeof(graph_vertex_type) 
+					+ limbo::heap_bytes(m_vPrecolor) + limbo::heap_bytes(m_vForbidden) + limbo::heap_bytes(m_isVDDGND)); 
+			usage.add("GraphSimplification/components", limbo::heap_bytes(m_vCompVertex) + limbo::heap_bytes(m_vCompVertexBegin) 
+					+ limbo::heap_bytes(m_vArtiPointId) + limbo::heap_bytes(m_vArtiPoint) 
+					+ limbo::heap_bytes(m_vArtiPointCompBegin) + limbo::heap_bytes(m_vArtiPointComp)); 
+		}
 
 		/// @return simplified graph and a std::map from merged graph vertices to original graph vertices 
 		std::pair<graph_type, std::map<graph_vertex_type, graph_vertex_type> > simplified_graph() const; 
@@ -138,19 +258,30 @@ class GraphSimplification
         /// @param vSimpl2Orig mapping from simplified graph to original graph 
         /// @return true if succeed 
 		bool simplified_graph_component(uint32_t comp_id, graph_type& sg, std::vector<graph_vertex_type>& vSimpl2Orig) const;
+        /// extract all components of the simplified graph at once, 
+        /// which avoids building a graph per component 
+        /// @param cs all components, use @ref component_view to access one 
+		void simplified_components(component_set_type& cs) const;
 
 		/// added by Qi Sun, also get the original edge relationships
 		// bool simplified_graph_component(uint32_t comp_id, graph_type& sg, std::vector<graph_vertex_type>& vSimpl2Orig, std::map<graph_vertex_type, std::vector<graph_vertex_type> >& s_graph_edges) const;
         
 		/// @return number of components 
-		uint32_t num_component() const {return m_mCompVertex.size();}
+		uint32_t num_component() const {return m_vCompVertexBegin.size()-1;}
+        /// @param comp_id component id 
+		/// @return number of vertices in a component 
+		uint32_t component_size(uint32_t comp_id) const {return m_vCompVertexBegin.at(comp_id+1)-m_vCompVertexBegin[comp_id];}
 
-		/// added by Qi Sun, to get m_mCompVertex
+		/// added by Qi Sun, to get vertices of all components 
 		void get_CompVertex(std::vector<std::vector<graph_vertex_type> >& CompVertex);
         
 		/// set maximum merge level 
         /// @param l level 
         void max_merge_level(int32_t l) {m_max_merge_level = l;}
+        /// set number of threads for HIDE_SMALL_DEGREE, MERGE_SUBK4 and @ref simplified_components, 
+        /// connected components are processed in parallel if larger than 1 
+        /// @param t number of threads 
+        void threads(int32_t t) {m_threads = t;}
 
         /// API to run the simplification algorithm 
         /// @param level simplification level, can be combination of items in @ref limbo::algorithms::coloring::GraphSimplification::strategy_type
@@ -160,6 +291,11 @@ class GraphSimplification
         /// @param mColor coloring solutions arranged by components 
         /// @param mSimpl2Orig mapping from simplified graph components to original graph 
 		void recover(std::vector<int8_t>& vColorFlat, std::vector<std::vector<int8_t> >& mColor, std::vector<std::vector<graph_vertex_type> > const& mSimpl2Orig) const;
+        /// API to recover coloring solutions from color assignment of components from @ref simplified_components 
+        /// @param vColorFlat flatten coloring solutions for original graph 
+        /// @param cs all components 
+        /// @param vColor coloring solutions of entries of cs.vVertex, rotated by biconnected components 
+		void recover(std::vector<int8_t>& vColorFlat, component_set_type const& cs, std::vector<int8_t>& vColor) const;
 
 		/// construct m_isVDDGND
 		void set_isVDDGND(std::set<graph_vertex_type> vdd_set);
@@ -178,6 +314,12 @@ class GraphSimplification
 
 		/// hide vertices whose degree is no larger than number of colors - 1
 		void hide_small_degree();
+		/// remove precolored vertices together with the vertices merged into them, 
+		/// and record their colors as forbidden colors of their neighbors by conflict edges. 
+		/// A precolored vertex with a stitch edge to a vertex that is not precolored is kept, 
+		/// as the cost of a stitch edge cannot be given by forbidden colors. 
+		/// Components are split at the pruned vertices. 
+		void prune_precolor();
 		// find all bridge edges and divided graph into components  
 		//void remove_bridge();
 		/// find all articulation points and biconnected components 
@@ -197,11 +339,19 @@ class GraphSimplification
         /// @param mColor coloring solutions arranged by components 
         /// @param mSimpl2Orig mapping from simplified graph components to original graph 
 		void recover_biconnected_component(std::vector<std::vector<int8_t> >& mColor, std::vector<std::vector<graph_vertex_type> > const& mSimpl2Orig) const;
+		/// recover color for biconnected components given by flat arrays 
+        /// @param vVertex original vertices grouped by components 
+        /// @param vBegin offset of each component in vVertex, with one more entry for the end 
+        /// @param vColor coloring solutions of entries of vVertex 
+		void recover_biconnected_component(std::vector<graph_vertex_type> const& vVertex, std::vector<uint32_t> const& vBegin, std::vector<int8_t>& vColor) const;
         /// recover color for hidden vertices 
         /// need to be called manually, no density balance considered 
         /// this function is mutable because it pops out elements in m_vHiddenVertex 
 		/// @param vColor coloring solutions, it must be partially assigned colors except simplified vertices  
         void recover_hide_small_degree(std::vector<int8_t>& vColor);
+        /// recover color for pruned vertices and the vertices merged into them 
+		/// @param vColor coloring solutions 
+        void recover_prune_precolor(std::vector<int8_t>& vColor) const;
 
         /// write graph in graphviz format 
         /// @param filename output file name 
@@ -213,33 +363,167 @@ class GraphSimplification
 		/// @return true if the point is a articulation point 
 		bool articulation_point(graph_vertex_type v) const
 		{
-			return m_mArtiPoint.count(v);
+			return m_vArtiPointId[v] != std::numeric_limits<uint32_t>::max();
 		}
 		void get_articulations(std::vector<graph_vertex_type> &art_vec)
 		{
-			std::vector<graph_vertex_type>().swap(art_vec);
-			typename std::map<graph_vertex_type, std::set<uint32_t> >::iterator it = m_mArtiPoint.begin();
-			while (it != m_mArtiPoint.end())
-			{
-				art_vec.push_back(it->first);
-				it++;
-			}
+			art_vec.assign(m_vArtiPoint.begin(), m_vArtiPoint.end());
 		}
 		
 	protected:
-        /// recursive implementation of computing biconnected components 
-        /// @param v current vertex 
-        /// @param vVisited an array records whether a vertex has been visited 
-        /// @param vDisc discovery time of vertices 
-        /// @param vLow low values of vertices 
-        /// @param vParent parents of vertices 
-        /// @param visit_time records current visiting time 
-        /// @param vEdge a stack of edges for DFS 
-        /// @param mCompVertex vertices arranged by independent components 
-		void biconnected_component_recursion(graph_vertex_type v, std::deque<bool>& vVisited, std::vector<uint32_t>& vDisc, 
-				std::vector<uint32_t>& vLow, std::vector<graph_vertex_type>& vParent, uint32_t& visit_time, 
-				std::stack<std::pair<graph_vertex_type, graph_vertex_type> >& vEdge, 
-				std::list<std::pair<graph_vertex_type, std::set<graph_vertex_type> > >& mCompVertex) const;
+		/// frame of the iterative DFS in @ref biconnected_component 
+		struct dfs_frame_type
+		{
+			graph_vertex_type v; ///< current vertex 
+			uint32_t child; ///< next merged child of v to explore 
+			adjacency_iterator ui; ///< next neighbor of the current child 
+			adjacency_iterator uie; ///< end of neighbors of the current child 
+			bool adjacent; ///< whether ui and uie are valid 
+			bool isolate; ///< whether no neighbor is found 
+			uint32_t children; ///< count of children in DFS tree 
+		};
+		/// biconnected components collected during DFS in CSR form 
+		struct bcc_collector_type
+		{
+			std::vector<graph_vertex_type> vVertex; ///< vertices of all components, sorted within each component 
+			std::vector<uint32_t> vBegin; ///< offset of each component, with one more entry for the end 
+			std::vector<graph_vertex_type> vAp; ///< articulation point that splits each component, maximum value if none 
+			std::vector<uint32_t> vMark; ///< last component of each vertex, to skip duplicates 
+
+			/// constructor 
+			/// @param vertex_num number of vertices 
+			bcc_collector_type(uint32_t vertex_num) : vBegin(1, 0), vMark(vertex_num, std::numeric_limits<uint32_t>::max()) {}
+			/// add a vertex to the open component 
+			/// @param v vertex 
+			void add(graph_vertex_type v) 
+			{
+				if (vMark[v] != vAp.size()) 
+				{
+					vMark[v] = vAp.size();
+					vVertex.push_back(v);
+				}
+			}
+			/// close the open component 
+			/// @param vap articulation point that splits the component 
+			void close(graph_vertex_type vap)
+			{
+				std::sort(vVertex.begin()+vBegin.back(), vVertex.end());
+				vBegin.push_back(vVertex.size());
+				vAp.push_back(vap);
+			}
+		};
+		/// @param v vertex 
+		/// @return a DFS frame to explore \a v 
+		dfs_frame_type dfs_frame(graph_vertex_type v) const;
+		/// degrees of a vertex tracked by @ref hide_small_degree 
+		struct peel_degree_type
+		{
+			uint32_t conflict; ///< number of conflict edges to non-VDD vertices 
+			uint32_t vdd; ///< number of conflict edges to VDD vertices, which count as one 
+			uint32_t stitch; ///< number of stitch edges 
+		};
+		/// groups of vertices peeled by threads in @ref hide_small_degree 
+		struct peel_task_type
+		{
+			GraphSimplification* gs; ///< simplification object 
+			std::vector<graph_vertex_type> vGroupVertex; ///< vertices of all groups, ascending within each group 
+			std::vector<uint32_t> vGroupBegin; ///< offset of each group, with one more entry for the end 
+			std::vector<peel_degree_type> vDegree; ///< degrees of vertices 
+			std::vector<std::vector<graph_vertex_type> > mHidden; ///< vertices hidden in each group, in the order of hiding 
+		};
+		/// @param v vertex 
+		/// @param d degrees of \a v 
+		/// @return true if \a v can be hidden 
+		bool small_degree(graph_vertex_type v, peel_degree_type const& d) const 
+		{
+			return this->good(v) && !this->precolored(v) && d.stitch == 0 && d.conflict+(d.vdd > 0)+this->num_forbidden(v) < m_color_num;
+		}
+		/// peel vertices of small degree in a group closed under adjacency 
+		/// @param task shared data 
+		/// @param group_id group id 
+		void hide_small_degree(peel_task_type& task, uint32_t group_id);
+		/// groups of @ref hide_small_degree run by limbo::containers::parallel_for 
+		struct peel_kernel_type
+		{
+			peel_task_type* task; ///< shared data 
+			/// @param b first group 
+			/// @param e end group 
+			void operator()(std::size_t b, std::size_t e) const {for (; b < e; ++b) task->gs->hide_small_degree(*task, b);}
+		};
+		/// groups of vertices searched by threads in @ref merge_subK4 
+		struct k4_task_type
+		{
+			GraphSimplification* gs; ///< simplification object 
+			std::vector<graph_vertex_type> vGroupVertex; ///< vertices of all groups, ascending within each group 
+			std::vector<uint32_t> vGroupBegin; ///< offset of each group, with one more entry for the end 
+			std::vector<uint32_t> vPosition; ///< position of each vertex in vGroupVertex 
+			std::vector<std::vector<graph_vertex_type> > mAdj; ///< parents connected to each good vertex by conflict edges, in the order of first occurrence over children and their adjacency 
+			std::vector<uint32_t> vMark1; ///< stamps of neighbors of vertex 1 
+			std::vector<uint32_t> vMark2; ///< stamps of neighbors of vertex 2 
+		};
+		/// merge sub-K4 structures in a group closed under adjacency 
+		/// @param task shared data 
+		/// @param group_id group id 
+		void merge_subK4(k4_task_type& task, uint32_t group_id);
+		/// find the first sub-K4 structure with vertex 1 in the order of the original search 
+		/// @param task shared data 
+		/// @param v1 vertex 1 
+		/// @param stamp last stamp of marks in the group, increased 
+		/// @return vertex 4 to merge to \a v1, \a v1 if none 
+		graph_vertex_type find_subK4(k4_task_type& task, graph_vertex_type v1, uint32_t& stamp) const;
+		/// groups of @ref merge_subK4 run by limbo::containers::parallel_for 
+		struct k4_kernel_type
+		{
+			k4_task_type* task; ///< shared data 
+			/// @param b first group 
+			/// @param e end group 
+			void operator()(std::size_t b, std::size_t e) const {for (; b < e; ++b) task->gs->merge_subK4(*task, b);}
+		};
+		/// group good vertices by connected components 
+		/// @param vGroupVertex vertices of all groups, ascending within each group 
+		/// @param vGroupBegin offset of each group, with one more entry for the end 
+		void good_connected_component(std::vector<graph_vertex_type>& vGroupVertex, std::vector<uint32_t>& vGroupBegin) const;
+		/// append a component of the simplified graph to a set 
+		/// @param comp_id component id 
+		/// @param vLocal local index of each vertex of the component, maximum value for other vertices 
+		/// @param vSlot position in cs.vAdj of each local index, all entries no less than cs.vAdj.size() or less than those of the component 
+		/// @param cs component set 
+		void append_component(uint32_t comp_id, std::vector<uint32_t> const& vLocal, std::vector<uint32_t>& vSlot, component_set_type& cs) const;
+		/// a range of components extracted by one thread in @ref simplified_components 
+		struct component_task_type
+		{
+			GraphSimplification const* gs; ///< simplification object 
+			uint32_t first; ///< first component 
+			uint32_t last; ///< past the last component 
+			component_set_type cs; ///< components extracted 
+		};
+		/// extract a range of components in @ref simplified_components 
+		/// @param task range of components and the components extracted 
+		static void extract_components(component_task_type& task);
+		/// ranges of @ref simplified_components run by limbo::containers::parallel_for 
+		struct component_kernel_type
+		{
+			component_task_type* vTask; ///< ranges of components 
+			/// @param b first range 
+			/// @param e end range 
+			void operator()(std::size_t b, std::size_t e) const {for (; b < e; ++b) extract_components(vTask[b]);}
+		};
+		/// local indices of vertices of a single component found by binary search 
+		struct sorted_local_index_type
+		{
+			std::vector<std::pair<graph_vertex_type, uint32_t> > const& vLocal; ///< pairs of vertex and local index sorted by vertices 
+			/// @param v original vertex 
+			/// @return local index 
+			uint32_t operator()(graph_vertex_type v) const 
+			{
+				typename std::vector<std::pair<graph_vertex_type, uint32_t> >::const_iterator found = 
+					std::lower_bound(vLocal.begin(), vLocal.end(), std::make_pair(v, (uint32_t)0));
+				return (found != vLocal.end() && found->first == v)? found->second : std::numeric_limits<uint32_t>::max();
+			}
+		};
+		/// rebuild articulation points from pairs of articulation point and component 
+		/// @param vApComp pairs of (articulation point, component), sorted inside 
+		void set_articulation_points(std::vector<std::pair<graph_vertex_type, uint32_t> >& vApComp);
 		/// compute connected components 
 		void connected_component();
         /// @param v vertex 
@@ -336,10 +620,24 @@ class GraphSimplification
 			return (m_vStatus.at(v1) == GOOD);
 		}
         /// @param v1 vertex 
-		/// @return true if current vertex is hidden  
+		/// @return true if current vertex is hidden or pruned, i.e., out of the graph 
 		bool hidden(graph_vertex_type v1) const 
 		{
-			return (m_vStatus.at(v1) == HIDDEN);
+			return (m_vStatus.at(v1) == HIDDEN || m_vStatus[v1] == PRUNED);
+		}
+        /// @param v vertex 
+		/// @return number of colors forbidden by pruned neighbors 
+		uint32_t num_forbidden(graph_vertex_type v) const 
+		{
+			return (m_vForbidden.empty())? 0 : __builtin_popcount(m_vForbidden[v]);
+		}
+        /// @param v pruned vertex 
+		/// @return color of the precolored vertex that \a v is merged into 
+		int8_t pruned_color(graph_vertex_type v) const 
+		{
+			while (v != m_vParent[v])
+				v = m_vParent[v];
+			return m_vPrecolor[v];
 		}
         /// @param v1 vertex 
 		/// @return true if current vertex is precolored
@@ -357,6 +655,16 @@ class GraphSimplification
 			}
 			return false;
 		}
+		/// @return true if there exist precolored vertices not pruned or forbidden colors 
+		bool has_fixed_color() const 
+		{
+			for (uint32_t v = 0; v < m_vPrecolor.size(); ++v)
+			{
+				if ((m_vPrecolor[v] >= 0 && m_vStatus[v] != PRUNED) || this->num_forbidden(v) > 0) 
+					return true;
+			}
+			return false;
+		}
         /// @param l merge level 
         /// @return true if the vertex satisfies maximum merge level constraint 
         bool check_max_merge_level(uint32_t l) const 
@@ -367,6 +675,7 @@ class GraphSimplification
 		uint32_t m_color_num; ///< number of colors 
 		uint32_t m_level; ///< simplification level 
         uint32_t m_max_merge_level; ///< in MERGE_SUBK4, any merge that results in the children number of a vertex larger than m_max_merge_level is disallowed 
+        int32_t m_threads; ///< number of threads for HIDE_SMALL_DEGREE and MERGE_SUBK4 
 		std::vector<vertex_status_type> m_vStatus; ///< status of each vertex 
 
 		std::vector<graph_vertex_type> m_vParent; ///< parent vertex of current vertex 
@@ -374,13 +683,18 @@ class GraphSimplification
 
 		std::stack<graph_vertex_type> m_vHiddenVertex; ///< a std::stack that keeps a reverse order of vertices hidden, useful for color recovery 
 
-		std::vector<std::vector<graph_vertex_type> > m_mCompVertex; ///< group vertices by components 
+		std::vector<graph_vertex_type> m_vCompVertex; ///< vertices grouped by components 
+		std::vector<uint32_t> m_vCompVertexBegin; ///< offset of each component in m_vCompVertex, with one more entry for the end 
 //		std::vector<uint32_t> m_vComponent; ///< component id for each vertex 
 
 //		std::set<graph_edge_type> m_sBridgeEdge; ///< bridge edges that are removed during graph division 
-		std::map<graph_vertex_type, std::set<uint32_t> > m_mArtiPoint; ///< map of (vertex of articulation point, set of components split by the vertex)
+		std::vector<uint32_t> m_vArtiPointId; ///< index to m_vArtiPoint of each vertex, maximum value if not articulation point 
+		std::vector<graph_vertex_type> m_vArtiPoint; ///< articulation points in ascending order 
+		std::vector<uint32_t> m_vArtiPointCompBegin; ///< offset of each articulation point in m_vArtiPointComp, with one more entry for the end 
+		std::vector<uint32_t> m_vArtiPointComp; ///< components split by each articulation point, in ascending order 
 
 		std::vector<int8_t> m_vPrecolor; ///< precolor information, if uncolored, std::set to -1
+		std::vector<uint8_t> m_vForbidden; ///< colors of pruned neighbors of each vertex as bit masks, empty if no vertex is pruned 
 
 		std::vector<bool>	m_isVDDGND;	///< used in graph simplification, whether it's VDDGND, added by Qi Sun
 };
@@ -391,7 +705,7 @@ std::pair<typename GraphSimplification<GraphType>::graph_type, std::map<typename
 GraphSimplification<GraphType>::simplified_graph() const 
 {
 	size_t vertex_cnt = 0;
-	std::map<graph_vertex_type, graph_vertex_type> mG2MG;
+	std::vector<graph_vertex_type> vG2MG (boost::num_vertices(m_graph), std::numeric_limits<graph_vertex_type>::max());
 	std::map<graph_vertex_type, graph_vertex_type> mMG2G;
 	vertex_iterator vi1, vie1;
 	for (boost::tie(vi1, vie1) = boost::vertices(m_graph); vi1 != vie1; ++vi1)
@@ -399,8 +713,8 @@ GraphSimplification<GraphType>::simplified_graph() const
 		graph_vertex_type v1 = *vi1;
 		if (this->good(v1))
 		{
-			mG2MG[*vi1] = vertex_cnt;
-			mMG2G[vertex_cnt] = v1;
+			vG2MG[v1] = vertex_cnt;
+			mMG2G.insert(mMG2G.end(), std::make_pair(vertex_cnt, v1));
 			vertex_cnt += 1;
 		}
 	}
@@ -419,11 +733,11 @@ GraphSimplification<GraphType>::simplified_graph() const
 		graph_vertex_type tp = this->parent(t);
 
 #ifdef DEBUG_GRAPHSIMPLIFICATION
-		limboAssert(mG2MG.count(sp));
-		limboAssert(mG2MG.count(tp));
+		limboAssert(vG2MG[sp] != std::numeric_limits<graph_vertex_type>::max());
+		limboAssert(vG2MG[tp] != std::numeric_limits<graph_vertex_type>::max());
 #endif
-		graph_vertex_type msp = mG2MG[sp];
-		graph_vertex_type mtp = mG2MG[tp];
+		graph_vertex_type msp = vG2MG[sp];
+		graph_vertex_type mtp = vG2MG[tp];
 		std::pair<graph_edge_type, bool> emg = boost::edge(msp, mtp, mg);
 		if (!emg.second)
 		{
@@ -448,9 +762,9 @@ GraphSimplification<GraphType>::simplified_graph() const
 template <typename GraphType>
 void GraphSimplification<GraphType>::get_CompVertex(std::vector<std::vector<typename GraphSimplification<GraphType>::graph_vertex_type> >& CompVertex)
 {
-	for (typename std::vector<std::vector<graph_vertex_type> >::iterator it = m_mCompVertex.begin(); it != m_mCompVertex.end(); it++)
+	for (uint32_t comp_id = 0; comp_id != this->num_component(); ++comp_id)
 	{
-		CompVertex.push_back(*it);
+		CompVertex.push_back(std::vector<graph_vertex_type>(m_vCompVertex.begin()+m_vCompVertexBegin[comp_id], m_vCompVertex.begin()+m_vCompVertexBegin[comp_id+1]));
 	}
 }
 
@@ -464,100 +778,53 @@ template <typename GraphType>
 bool GraphSimplification<GraphType>::simplified_graph_component(uint32_t comp_id, typename GraphSimplification<GraphType>::graph_type& simplG, 
 		std::vector<typename GraphSimplification<GraphType>::graph_vertex_type>& vSimpl2Orig) const
 {
-	if (comp_id >= m_mCompVertex.size()) return false;
+	if (comp_id >= this->num_component()) return false;
 
-	std::vector<graph_vertex_type> const& vCompVertex = m_mCompVertex[comp_id];
+	// a single component looks up local indices by binary search instead of a std::map, 
+	// so that extracting components one by one does not cost the size of the whole graph each time 
+	std::vector<graph_vertex_type> const vCompVertex (m_vCompVertex.begin()+m_vCompVertexBegin[comp_id], m_vCompVertex.begin()+m_vCompVertexBegin[comp_id+1]);
+	std::vector<std::pair<graph_vertex_type, uint32_t> > vLocal (vCompVertex.size());
+	for (uint32_t i = 0; i != vCompVertex.size(); ++i)
+		vLocal[i] = std::make_pair(vCompVertex[i], i);
+	std::sort(vLocal.begin(), vLocal.end());
+	sorted_local_index_type local = {vLocal};
 
 	graph_type sg (vCompVertex.size());
-	std::map<graph_vertex_type, graph_vertex_type> mOrig2Simpl;
 	vSimpl2Orig.assign(vCompVertex.begin(), vCompVertex.end());
-	for (uint32_t i = 0; i != vCompVertex.size(); ++i)
-		mOrig2Simpl[vCompVertex[i]] = i;
 #ifdef DEBUG_GRAPHSIMPLIFICATION
 	std::cout << "Comp " << comp_id << ": ";
 	for (uint32_t i = 0; i != vCompVertex.size(); ++i)
 		std::cout << vCompVertex[i] << " ";
 	std::cout << std::endl;
 #endif
-#ifdef DEBUG_LIWEI
-	bool flag = false;
-	std::cout << "\nSimplified Comp " << comp_id << " : \n";
-	for (uint32_t i = 0; i != vCompVertex.size(); ++i)
-		std::cout << i << " : " << vCompVertex[i] << std::endl;
-	std::cout << std::endl;
-	//std::cout << "Original to Simplified : " << std::endl;
-	for (uint32_t i = 0; i != vCompVertex.size(); ++i)
+	for (uint32_t vsg = 0; vsg != vCompVertex.size(); ++vsg)
 	{
-		std::cout << vCompVertex[i] << " : " << i << std::endl;
-		mOrig2Simpl[vCompVertex[i]] = i;
-	}
-	std::cout << std::endl;
-	if (vCompVertex[0] == 1 && vCompVertex[1] == 42)
-		flag = true;
-#endif
-	for (typename std::vector<graph_vertex_type>::const_iterator vi = vCompVertex.begin(); vi != vCompVertex.end(); ++vi)
-	{
-		graph_vertex_type v = *vi;
-		
-		graph_vertex_type vsg = mOrig2Simpl[v];
+		graph_vertex_type v = vCompVertex[vsg];
 		limboAssert(this->good(v));
-		bool ap = this->articulation_point(v);
 
-#ifdef DEBUG_LIWEI
-		if (flag)
-		{
-            limboPrint(kDEBUG, "v : %u ap : %d\n", (uint32_t)v, (int)ap);
-		}
-#endif
 		std::vector<graph_vertex_type> const& vChildren = m_vChildren.at(v);
 		for (typename std::vector<graph_vertex_type>::const_iterator vic = vChildren.begin(); vic != vChildren.end(); ++vic)
 		{
-			graph_vertex_type vc = *vic;
-#ifdef DEBUG_LIWEI
-			if (flag)
+			out_edge_iterator ei, eie;
+			for (boost::tie(ei, eie) = boost::out_edges(*vic, m_graph); ei != eie; ++ei)
 			{
-				std::cout << "vc : " << vc << std::endl;
-			}
-#endif
-			typename boost::graph_traits<graph_type>::adjacency_iterator ui, uie;
-			for (boost::tie(ui, uie) = boost::adjacent_vertices(vc, m_graph); ui != uie; ++ui)
-			{
-				graph_vertex_type uc = *ui;
+				graph_vertex_type uc = boost::target(*ei, m_graph);
 				// skip hidden 
 				if (this->hidden(uc)) continue;
 				graph_vertex_type u = this->parent(uc);
-#ifdef DEBUG_LIWEI
-				if (flag)
-				{
-					std::cout << "uc : " << uc << "  parent u : " << u << std::endl;
-				}
-#endif
 				// skip non-good 
 				if (!this->good(u)) continue;
 				else if (v >= u) continue; // avoid duplicate 
-				else if (ap && !mOrig2Simpl.count(u)) continue; // skip vertex that is not in component 
-				//else if (u == v) continue;
-				limboAssertMsg(u != v, "%u == %u", u, v);
+				// skip vertex that is not in component 
+				uint32_t usg = local(u);
+				if (usg == std::numeric_limits<uint32_t>::max()) continue;
 
-				std::pair<graph_edge_type, bool> e = boost::edge(vc, uc, m_graph);
-				limboAssert(e.second);
-				// skip bridge 
-				//if (m_sBridgeEdge.count(e.first)) continue;
-				graph_vertex_type usg = mOrig2Simpl[u];
-#ifdef DEBUG_LIWEI
-				if (flag)
-				{
-					std::cout << "usg : " << usg <<  "  vsg : " << vsg << std::endl;
-				}
-#endif
-				limboAssertMsg(usg != vsg, "%u==%u: %u == %u", u, v, usg, vsg);
-				
 				std::pair<graph_edge_type, bool> esg = boost::edge(vsg, usg, sg);
 				if (!esg.second)
 				{
 					esg = boost::add_edge(vsg, usg, sg);
 					limboAssert(esg.second);
-					boost::put(boost::edge_weight, sg, esg.first, boost::get(boost::edge_weight, m_graph, e.first));
+					boost::put(boost::edge_weight, sg, esg.first, boost::get(boost::edge_weight, m_graph, *ei));
 				}
 				else 
 				{
@@ -566,22 +833,152 @@ bool GraphSimplification<GraphType>::simplified_graph_component(uint32_t comp_id
 					// no longer optimal if merge_subK4() is called 
 					boost::put(
 							boost::edge_weight, sg, esg.first, 
-							boost::get(boost::edge_weight, sg, esg.first) + boost::get(boost::edge_weight, m_graph, e.first)
+							boost::get(boost::edge_weight, sg, esg.first) + boost::get(boost::edge_weight, m_graph, *ei)
 							);
 				}
 			}
 		}
 	}
 	simplG.swap(sg);
+	return true;
+}
 
-	vertex_iterator vi1, vie1;
-	int count = 0;
-	//std::cout << "Simplified comp " << comp_id << " has " << boost::num_vertices(simplG) << " nodes : " << std::endl;
-	for (boost::tie(vi1, vie1) = boost::vertices(simplG); vi1 != vie1; ++vi1)
+template <typename GraphType>
+void GraphSimplification<GraphType>::simplified_components(typename GraphSimplification<GraphType>::component_set_type& cs) const
+{
+	// threads take contiguous ranges of components with similar numbers of vertices, 
+	// so the results are concatenated in the order of components 
+	uint32_t numComps = this->num_component();
+	int32_t numThreads = std::max(std::min(std::min((int32_t)limbo::containers::num_threads(), m_threads), (int32_t)(m_vCompVertex.size()/4096)), 1);
+	std::vector<component_task_type> vTask (numThreads);
+	for (int32_t i = 0; i < numThreads; ++i)
 	{
-		count++;
+		vTask[i].gs = this;
+		vTask[i].first = (i == 0)? 0 : vTask[i-1].last;
+		vTask[i].last = (i+1 == numThreads)? numComps : 
+			std::upper_bound(m_vCompVertexBegin.begin()+vTask[i].first, m_vCompVertexBegin.end()-1, m_vCompVertex.size()*(i+1)/numThreads)-m_vCompVertexBegin.begin();
 	}
-	return true;
+	component_kernel_type kernel = {&vTask[0]};
+	limbo::containers::parallel_for(0, numThreads, 1, numThreads, kernel);
+
+	cs.vVertex.swap(vTask[0].cs.vVertex);
+	cs.vBegin.swap(vTask[0].cs.vBegin);
+	cs.vAdjBegin.swap(vTask[0].cs.vAdjBegin);
+	cs.vAdj.swap(vTask[0].cs.vAdj);
+	cs.vWeight.swap(vTask[0].cs.vWeight);
+	for (int32_t i = 1; i < numThreads; ++i)
+	{
+		component_set_type const& part = vTask[i].cs;
+		uint32_t vertex_offset = cs.vVertex.size();
+		uint32_t adj_offset = cs.vAdj.size();
+		cs.vVertex.insert(cs.vVertex.end(), part.vVertex.begin(), part.vVertex.end());
+		for (uint32_t j = 1; j < part.vBegin.size(); ++j)
+			cs.vBegin.push_back(vertex_offset+part.vBegin[j]);
+		for (uint32_t j = 1; j < part.vAdjBegin.size(); ++j)
+			cs.vAdjBegin.push_back(adj_offset+part.vAdjBegin[j]);
+		// neighbors are local indices, which do not change 
+		cs.vAdj.insert(cs.vAdj.end(), part.vAdj.begin(), part.vAdj.end());
+		cs.vWeight.insert(cs.vWeight.end(), part.vWeight.begin(), part.vWeight.end());
+	}
+}
+
+template <typename GraphType>
+void GraphSimplification<GraphType>::extract_components(component_task_type& task)
+{
+	GraphSimplification const& gs = *task.gs;
+	std::vector<graph_vertex_type> const& vCompVertex = gs.m_vCompVertex;
+	std::vector<uint32_t> const& vCompVertexBegin = gs.m_vCompVertexBegin;
+	uint32_t max_comp_size = 0;
+	for (uint32_t comp_id = task.first; comp_id != task.last; ++comp_id)
+		max_comp_size = std::max(max_comp_size, gs.component_size(comp_id));
+	task.cs.vVertex.reserve(vCompVertexBegin[task.last]-vCompVertexBegin[task.first]);
+	task.cs.vAdjBegin.reserve(task.cs.vVertex.capacity()+1);
+	std::vector<uint32_t> vLocal (boost::num_vertices(gs.m_graph), std::numeric_limits<uint32_t>::max());
+	std::vector<uint32_t> vSlot (max_comp_size, std::numeric_limits<uint32_t>::max());
+	for (uint32_t comp_id = task.first; comp_id != task.last; ++comp_id)
+	{
+		uint32_t first = vCompVertexBegin[comp_id];
+		uint32_t last = vCompVertexBegin[comp_id+1];
+		for (uint32_t i = first; i != last; ++i)
+			vLocal[vCompVertex[i]] = i-first;
+		gs.append_component(comp_id, vLocal, vSlot, task.cs);
+		for (uint32_t i = first; i != last; ++i)
+			vLocal[vCompVertex[i]] = std::numeric_limits<uint32_t>::max();
+	}
+}
+
+template <typename GraphType>
+void GraphSimplification<GraphType>::append_component(uint32_t comp_id, std::vector<uint32_t> const& vLocal, std::vector<uint32_t>& vSlot, 
+		typename GraphSimplification<GraphType>::component_set_type& cs) const
+{
+	for (uint32_t i = m_vCompVertexBegin[comp_id]; i != m_vCompVertexBegin[comp_id+1]; ++i)
+	{
+		graph_vertex_type v = m_vCompVertex[i];
+		limboAssert(this->good(v));
+		cs.vVertex.push_back(v);
+		// neighbors of v found before are at positions no less than start 
+		uint32_t start = cs.vAdj.size();
+
+		std::vector<graph_vertex_type> const& vChildren = m_vChildren.at(v);
+		for (typename std::vector<graph_vertex_type>::const_iterator vic = vChildren.begin(); vic != vChildren.end(); ++vic)
+		{
+			out_edge_iterator ei, eie;
+			for (boost::tie(ei, eie) = boost::out_edges(*vic, m_graph); ei != eie; ++ei)
+			{
+				graph_vertex_type uc = boost::target(*ei, m_graph);
+				// skip hidden 
+				if (this->hidden(uc)) continue;
+				graph_vertex_type u = this->parent(uc);
+				// skip non-good and edges between vertices merged together 
+				if (!this->good(u) || u == v) continue;
+				// skip vertex that is not in component 
+				uint32_t usg = vLocal[u];
+				if (usg == std::numeric_limits<uint32_t>::max()) continue;
+
+				// use cumulative weight 
+				// this is to make sure we can still achieve small conflict number in the simplified graph 
+				// no longer optimal if merge_subK4() is called 
+				if (vSlot[usg] >= start && vSlot[usg] < cs.vAdj.size())
+					cs.vWeight[vSlot[usg]] += boost::get(boost::edge_weight, m_graph, *ei);
+				else 
+				{
+					vSlot[usg] = cs.vAdj.size();
+					cs.vAdj.push_back(usg);
+					cs.vWeight.push_back(boost::get(boost::edge_weight, m_graph, *ei));
+				}
+			}
+		}
+		cs.vAdjBegin.push_back(cs.vAdj.size());
+	}
+	cs.vBegin.push_back(cs.vVertex.size());
+}
+
+/// function object to add edges to a graph with an offset of vertices 
+/// @tparam GraphType graph type 
+template <typename GraphType>
+struct ComponentGraphBuilder
+{
+	GraphType& g; ///< graph 
+	uint32_t offset; ///< index of local index 0 in the graph 
+	/// add an edge 
+	/// @param i, j local indices 
+	/// @param w weight 
+	template <typename WeightType>
+	void operator()(uint32_t i, uint32_t j, WeightType w)
+	{
+		std::pair<typename boost::graph_traits<GraphType>::edge_descriptor, bool> e = boost::add_edge(offset+i, offset+j, g);
+		limboAssert(e.second);
+		boost::put(boost::edge_weight, g, e.first, w);
+	}
+};
+
+template <typename GraphType>
+void GraphSimplification<GraphType>::component_view::graph(typename GraphSimplification<GraphType>::graph_type& sg) const
+{
+	graph_type g (m_size);
+	ComponentGraphBuilder<graph_type> builder = {g, 0};
+	this->for_each_edge(builder);
+	sg.swap(g);
 }
 
 template <typename GraphType>
@@ -622,45 +1019,57 @@ void GraphSimplification<GraphType>::mergeVDD(std::set<typename GraphSimplificat
 template <typename GraphType>
 void GraphSimplification<GraphType>::simplify(uint32_t level)
 {
+    limboScopedTimer("GraphSimplification::simplify");
 	m_level = level; // record level for recover()
-	if (this->has_precolored()) // this step does not support precolored graph yet 
-		m_level = m_level & (~MERGE_SUBK4) & (~BICONNECTED_COMPONENT);
+    bool reconstruct = true; // whether needs to reconstruct m_vCompVertex
 
-    bool reconstruct = true; // whether needs to reconstruct m_mCompVertex
+	if ((m_level & PRUNE_PRECOLOR) && this->has_precolored())
+    {
+        limboScopedTimer("prune_precolor");
+		this->prune_precolor(); // connected components are computed inside 
+        reconstruct = false;
+    }
+	if (this->has_fixed_color()) // these steps do not support precolored graph yet, which rotate colors of components or merge vertices 
+		m_level = m_level & (~MERGE_SUBK4) & (~BICONNECTED_COMPONENT);
 
 	if (m_level & HIDE_SMALL_DEGREE)
     {
+        limboScopedTimer("hide_small_degree");
 		this->hide_small_degree(); // connected components are computed inside 
         reconstruct = false;
     }
 	if (m_level & MERGE_SUBK4)
     {
+        limboScopedTimer("merge_subK4");
 		this->merge_subK4();
     }
 	if (m_level & BICONNECTED_COMPONENT)
     {
+        limboScopedTimer("biconnected_component");
 		this->biconnected_component();
         reconstruct = false;
 #ifdef DEBUG_LIWEI
 		uint32_t comp_id = 0;
-		for (typename std::vector<std::vector<graph_vertex_type> >::iterator it = m_mCompVertex.begin(); it != m_mCompVertex.end(); it++, comp_id++)
+		for (; comp_id != this->num_component(); comp_id++)
 		{
-			for (typename std::vector<graph_vertex_type>::iterator its = it->begin(); its != it->end(); its++)
+			for (uint32_t i = m_vCompVertexBegin[comp_id]; i != m_vCompVertexBegin[comp_id+1]; i++)
 			{
-				if (m_isVDDGND[*its])
+				if (m_isVDDGND[m_vCompVertex[i]])
 				{
-                    limboPrint(kDEBUG, "comp %u has VDD %u\n", comp_id, (uint32_t)*its);
+                    limboPrint(kDEBUG, "comp %u has VDD %u\n", comp_id, (uint32_t)m_vCompVertex[i]);
 				}
 			}
 		}
 #endif
     }
-    if (reconstruct) // if BICONNECTED_COMPONENT or HIDE_SMALL_DEGREE is not on, we need to construct m_mCompVertex with size 1 
+    if (reconstruct) // if BICONNECTED_COMPONENT or HIDE_SMALL_DEGREE is not on, we need to construct m_vCompVertex with size 1 
     {
-        m_mCompVertex.assign(1, std::vector<graph_vertex_type>());
+        m_vCompVertex.clear();
         for (graph_vertex_type v = 0, ve = boost::num_vertices(m_graph); v != ve; ++v)
             if (this->good(v))
-                m_mCompVertex[0].push_back(v);
+                m_vCompVertex.push_back(v);
+        m_vCompVertexBegin.assign(1, 0);
+        m_vCompVertexBegin.push_back(m_vCompVertex.size());
     }
 }
 
@@ -690,6 +1099,10 @@ void GraphSimplification<GraphType>::recover(std::vector<int8_t>& vColorFlat, st
 	{
 		this->recover_merge_subK4(vColorFlat);
 	}
+	if (m_level & PRUNE_PRECOLOR)
+	{
+		this->recover_prune_precolor(vColorFlat);
+	}
 	if (m_level & HIDE_SMALL_DEGREE)
 	{
 		// TO DO: this part has custom requirement, such as density balancing 
@@ -697,6 +1110,28 @@ void GraphSimplification<GraphType>::recover(std::vector<int8_t>& vColorFlat, st
 	}
 }
 
+template <typename GraphType>
+void GraphSimplification<GraphType>::recover(std::vector<int8_t>& vColorFlat, typename GraphSimplification<GraphType>::component_set_type const& cs, std::vector<int8_t>& vColor) const
+{
+	// reverse order w.r.t simplify()
+	if (m_level & BICONNECTED_COMPONENT)
+		this->recover_biconnected_component(cs.vVertex, cs.vBegin, vColor);
+
+	for (uint32_t i = 0; i < cs.vVertex.size(); ++i)
+	{
+		graph_vertex_type v = cs.vVertex[i];
+		if (vColorFlat[v] >= 0)
+			limboAssert(vColorFlat[v] == vColor[i]);
+		else 
+			vColorFlat[v] = vColor[i];
+	}
+
+	if (m_level & MERGE_SUBK4)
+		this->recover_merge_subK4(vColorFlat);
+	if (m_level & PRUNE_PRECOLOR)
+		this->recover_prune_precolor(vColorFlat);
+}
+
 /// for a structure of K4 with one fewer edge 
 /// suppose we have 4 vertices 1, 2, 3, 4
 /// 1--2, 1--3, 2--3, 2--4, 3--4, vertex 4 is merged to 1 
@@ -709,199 +1144,417 @@ void GraphSimplification<GraphType>::merge_subK4()
 	// when applying this function, be aware that other merging strategies may have already been applied 
 	// so m_vParent is valid 
 	//
-	// merge iteratively 
-	bool merge_flag; // true if merge occurs
-	do 
+	// A merge only changes its connected component, and the merges of a component are the same 
+	// as searching the whole graph again after each merge, so components are merged in parallel. 
+	k4_task_type task; 
+	task.gs = this; 
+	this->good_connected_component(task.vGroupVertex, task.vGroupBegin);
+	uint32_t vertex_num = boost::num_vertices(m_graph);
+	task.vPosition.resize(vertex_num); 
+	task.mAdj.resize(vertex_num); 
+	task.vMark1.assign(vertex_num, 0); 
+	task.vMark2.assign(vertex_num, 0); 
+
+	uint32_t numGroups = task.vGroupBegin.size()-1;
+	int32_t numThreads = std::max(std::min(std::min((int32_t)limbo::containers::num_threads(), m_threads), (int32_t)numGroups), 1);
+	k4_kernel_type kernel = {&task};
+	limbo::containers::parallel_for(0, numGroups, 1, numThreads, kernel);
+}
+
+template <typename GraphType>
+void GraphSimplification<GraphType>::merge_subK4(k4_task_type& task, uint32_t group_id)
+{
+	uint32_t begin = task.vGroupBegin[group_id]; 
+	uint32_t end = task.vGroupBegin[group_id+1]; 
+	uint32_t stamp = 0; 
+	// adjacency of merged vertices by conflict edges, without looking up edges between pairs of children 
+	for (uint32_t i = begin; i != end; ++i)
 	{
-		merge_flag = false;
-		// traverse the neighbors of vertex 1 to find connected vertex 2 and 3 
-		vertex_iterator vi1, vie1;
-		for (boost::tie(vi1, vie1) = boost::vertices(m_graph); vi1 != vie1; ++vi1)
-		{
-			graph_vertex_type v1 = *vi1;
-			// only track good vertices 
-			if (!this->good(v1)) continue;
-			// find vertex 2 by searching the neighbors of vertex 1
-			std::vector<graph_vertex_type> const& vChildren1 = m_vChildren.at(v1);
-			for (typename std::vector<graph_vertex_type>::const_iterator vic1 = vChildren1.begin(); vic1 != vChildren1.end(); ++vic1)
+		graph_vertex_type v1 = task.vGroupVertex[i];
+		task.vPosition[v1] = i; 
+		std::vector<graph_vertex_type>& vAdj1 = task.mAdj[v1]; 
+		++stamp; 
+		std::vector<graph_vertex_type> const& vChildren1 = m_vChildren.at(v1);
+		for (typename std::vector<graph_vertex_type>::const_iterator vic1 = vChildren1.begin(); vic1 != vChildren1.end(); ++vic1)
+		{
+			out_edge_iterator ei, eie;
+			for (boost::tie(ei, eie) = boost::out_edges(*vic1, m_graph); ei != eie; ++ei)
 			{
-#ifdef DEBUG_GRAPHSIMPLIFICATION
-				limboAssert(vic1-vChildren1.begin() >= 0);
-#endif
-				graph_vertex_type vc1 = *vic1;
-				adjacency_iterator vi2, vie2;
-				for (boost::tie(vi2, vie2) = boost::adjacent_vertices(vc1, m_graph); vi2 != vie2; ++vi2)
+				graph_vertex_type v2 = boost::target(*ei, m_graph);
+				// skip hidden vertex and stitch edges 
+				if (this->hidden(v2) || boost::get(boost::edge_weight, m_graph, *ei) < 0) continue;
+				v2 = this->parent(v2); 
+				if (task.vMark1[v2] != stamp)
 				{
-					// skip hidden vertex 
-					if (this->hidden(*vi2)) continue;
-					// skip stitch edges 
-					std::pair<graph_edge_type, bool> e12 = boost::edge(vc1, *vi2, m_graph);
-					limboAssert(e12.second);
-					if (boost::get(boost::edge_weight, m_graph, e12.first) < 0) continue;
-
-					graph_vertex_type v2 = this->parent(*vi2);
-					// find vertex 3 by searching the neighbors of vertex 2 
-					std::vector<graph_vertex_type> const& vChildren2 = m_vChildren.at(v2);
-					for (typename std::vector<graph_vertex_type>::const_iterator vic2 = vChildren2.begin(); vic2 != vChildren2.end(); ++vic2)
-					{
-						graph_vertex_type vc2 = *vic2;
-						adjacency_iterator vi3, vie3;
-						for (boost::tie(vi3, vie3) = boost::adjacent_vertices(vc2, m_graph); vi3 != vie3; ++vi3)
-						{
-							// skip hidden vertex 
-							if (this->hidden(*vi3)) continue;
-							// skip stitch edges 
-							std::pair<graph_edge_type, bool> e23 = boost::edge(vc2, *vi3, m_graph);
-							limboAssert(e23.second);
-							if (boost::get(boost::edge_weight, m_graph, e23.first) < 0) continue;
-
-							graph_vertex_type v3 = this->parent(*vi3);
-							// skip v1, v1 must be a parent  
-							if (v3 == v1) continue;
-							// only connected 1 and 3 are considered 
-							if (!this->connected_conflict(v1, v3)) continue;
-
-							// find vertex 4 by searching the neighbors of vertex 3  
-							std::vector<graph_vertex_type> const& vChildren3 = m_vChildren.at(v3);
-							for (typename std::vector<graph_vertex_type>::const_iterator vic3 = vChildren3.begin(); vic3 != vChildren3.end(); ++vic3)
-							{
-								graph_vertex_type vc3 = *vic3;
-								adjacency_iterator vi4, vie4;
-								for (boost::tie(vi4, vie4) = boost::adjacent_vertices(vc3, m_graph); vi4 != vie4; ++vi4)
-								{
-									// skip hidden vertex and skip precolored vertex  
-									if (this->hidden(*vi4) || this->precolored(*vi4)) continue;
-									// skip stitch edges 
-									std::pair<graph_edge_type, bool> e34 = boost::edge(vc3, *vi4, m_graph);
-									limboAssert(e34.second);
-									if (boost::get(boost::edge_weight, m_graph, e34.first) < 0) continue;
-
-									graph_vertex_type v4 = this->parent(*vi4);
-									// skip v1 or v2, v1 and v2 must be parent, and v4 must not be precolored
-									if (v4 == v1 || v4 == v2 || this->precolored(v4)) continue;
-									// vertex 2 and vertex 4 must be connected 
-									// vertex 1 and vertex 4 must not be connected (K4)
-									if (!this->connected_conflict(v2, v4) || this->connected_conflict(v1, v4)) continue;
-                                    // check max merge level 
-                                    if (!this->check_max_merge_level(m_vChildren[v1].size()+m_vChildren[v4].size())) continue;
-									// merge vertex 4 to vertex 1 
-									m_vStatus[v4] = MERGED;
-									m_vChildren[v1].insert(m_vChildren[v1].end(), m_vChildren[v4].begin(), m_vChildren[v4].end());
-									m_vChildren[v4].resize(0); // clear and shrink to fit 
-									m_vParent[v4] = v1;
-									merge_flag = true;
+					task.vMark1[v2] = stamp; 
+					vAdj1.push_back(v2); 
+				}
+			}
+		}
+	}
+
+	// vertices before i have no sub-K4 structure as vertex 1 
+	for (uint32_t i = begin; i != end; )
+	{
+		graph_vertex_type v1 = task.vGroupVertex[i];
+		graph_vertex_type v4 = (this->good(v1))? this->find_subK4(task, v1, stamp) : v1; 
+		if (v4 == v1)
+		{
+			++i; 
+			continue; 
+		}
+		// merge vertex 4 to vertex 1 
+		m_vStatus[v4] = MERGED;
+		m_vChildren[v1].insert(m_vChildren[v1].end(), m_vChildren[v4].begin(), m_vChildren[v4].end());
+		m_vChildren[v4].resize(0); // clear and shrink to fit 
+		m_vParent[v4] = v1;
 #ifdef DEBUG_GRAPHSIMPLIFICATION
-									limboAssert(m_vStatus[v1] == GOOD);
-									//this->write_graph_dot("graph_simpl");
+		limboAssert(m_vStatus[v1] == GOOD);
 #endif
-									break;
-								}
-								if (merge_flag) break;
-							}
-							if (merge_flag) break;
-						}
-						if (merge_flag) break;
-					}
-					if (merge_flag) break;
+		// neighbors of vertex 4 refer to vertex 1 at the first occurrence of either one, 
+		// and vertex 1 gets new neighbors after its own ones, as children of vertex 4 follow its children 
+		std::vector<graph_vertex_type>& vAdj1 = task.mAdj[v1]; 
+		std::vector<graph_vertex_type>& vAdj4 = task.mAdj[v4]; 
+		++stamp; 
+		for (typename std::vector<graph_vertex_type>::const_iterator it = vAdj1.begin(); it != vAdj1.end(); ++it)
+			task.vMark1[*it] = stamp; 
+		for (typename std::vector<graph_vertex_type>::const_iterator it = vAdj4.begin(); it != vAdj4.end(); ++it)
+		{
+			graph_vertex_type u = *it; 
+			// children of vertex 4 connected to each other, e.g., merged VDD vertices 
+			if (u == v4)
+				u = v1; 
+			else 
+			{
+				std::vector<graph_vertex_type>& vAdj = task.mAdj[u]; 
+				typename std::vector<graph_vertex_type>::iterator it4 = std::find(vAdj.begin(), vAdj.end(), v4); 
+				typename std::vector<graph_vertex_type>::iterator it1 = std::find(vAdj.begin(), vAdj.end(), v1); 
+				if (it1 == vAdj.end())
+					*it4 = v1; 
+				else if (it4 < it1)
+				{
+					*it4 = v1; 
+					vAdj.erase(it1); 
 				}
-				if (merge_flag) break;
+				else 
+					vAdj.erase(it4); 
+			}
+			if (task.vMark1[u] != stamp)
+			{
+				task.vMark1[u] = stamp; 
+				vAdj1.push_back(u); 
+			}
+		}
+		std::vector<graph_vertex_type>().swap(vAdj4); 
+		// a new structure has vertex 1 within two edges from the merged vertex 
+		for (typename std::vector<graph_vertex_type>::const_iterator it = vAdj1.begin(); it != vAdj1.end(); ++it)
+		{
+			i = std::min(i, task.vPosition[*it]); 
+			std::vector<graph_vertex_type> const& vAdj = task.mAdj[*it]; 
+			for (typename std::vector<graph_vertex_type>::const_iterator itt = vAdj.begin(); itt != vAdj.end(); ++itt)
+				i = std::min(i, task.vPosition[*itt]); 
+		}
+	}
+	// release adjacency of the group 
+	for (uint32_t i = begin; i != end; ++i)
+		std::vector<graph_vertex_type>().swap(task.mAdj[task.vGroupVertex[i]]); 
+}
+
+template <typename GraphType>
+typename GraphSimplification<GraphType>::graph_vertex_type GraphSimplification<GraphType>::find_subK4(k4_task_type& task, graph_vertex_type v1, uint32_t& stamp) const
+{
+	// vertex 2 and 3 are connected neighbors of vertex 1, 
+	// and vertex 4 is a neighbor of 2 and 3 but not 1, the same order as searching children and their adjacency 
+	std::vector<graph_vertex_type> const& vAdj1 = task.mAdj[v1]; 
+	uint32_t stamp1 = ++stamp; 
+	for (typename std::vector<graph_vertex_type>::const_iterator it = vAdj1.begin(); it != vAdj1.end(); ++it)
+		task.vMark1[*it] = stamp1; 
+	for (typename std::vector<graph_vertex_type>::const_iterator vi2 = vAdj1.begin(); vi2 != vAdj1.end(); ++vi2)
+	{
+		graph_vertex_type v2 = *vi2; 
+		std::vector<graph_vertex_type> const& vAdj2 = task.mAdj[v2]; 
+		uint32_t stamp2 = ++stamp; 
+		for (typename std::vector<graph_vertex_type>::const_iterator it = vAdj2.begin(); it != vAdj2.end(); ++it)
+			task.vMark2[*it] = stamp2; 
+		for (typename std::vector<graph_vertex_type>::const_iterator vi3 = vAdj2.begin(); vi3 != vAdj2.end(); ++vi3)
+		{
+			graph_vertex_type v3 = *vi3; 
+			// only connected 1 and 3 are considered 
+			if (v3 == v1 || task.vMark1[v3] != stamp1) continue; 
+			std::vector<graph_vertex_type> const& vAdj3 = task.mAdj[v3]; 
+			for (typename std::vector<graph_vertex_type>::const_iterator vi4 = vAdj3.begin(); vi4 != vAdj3.end(); ++vi4)
+			{
+				graph_vertex_type v4 = *vi4; 
+				// skip v1 or v2, and v4 must not be precolored
+				if (v4 == v1 || v4 == v2 || this->precolored(v4)) continue;
+				// vertex 2 and vertex 4 must be connected 
+				// vertex 1 and vertex 4 must not be connected (K4)
+				if (task.vMark2[v4] != stamp2 || task.vMark1[v4] == stamp1) continue; 
+				// check max merge level 
+				if (!this->check_max_merge_level(m_vChildren[v1].size()+m_vChildren[v4].size())) continue;
+				return v4; 
 			}
-			if (merge_flag) break;
 		}
-	} while (merge_flag);
+	}
+	return v1; 
 }
 
 /// hide vertices whose degree is no larger than color_num-1
+/// Hiding a vertex decrements the degrees of its neighbors, 
+/// which are queued once their degrees become small, so each edge is visited a constant number of times. 
+/// The set of hidden vertices does not depend on the order of hiding. 
 template <typename GraphType>
 void GraphSimplification<GraphType>::hide_small_degree()
 {
 	// when applying this function, be aware that other strategies may have already been applied 
 	// make sure it is compatible 
 
-	bool hide_flag;
-	do 
+	peel_task_type task; 
+	task.gs = this;
+	task.vDegree.resize(boost::num_vertices(m_graph));
+
+	int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), m_threads);
+	if (numThreads > 1) // connected components are independent 
+		this->good_connected_component(task.vGroupVertex, task.vGroupBegin);
+	else // a single group of all good vertices 
 	{
-		hide_flag = false;
-		// traverse the neighbors of vertex 1 to find connected vertex 2 and 3 
-		vertex_iterator vi1, vie1;
-		for (boost::tie(vi1, vie1) = boost::vertices(m_graph); vi1 != vie1; ++vi1)
-		{
-			graph_vertex_type v1 = *vi1;
-			// only track good and uncolored vertices  
-			if (!this->good(v1) || this->precolored(v1)) continue;
-			size_t conflictPreVDD_degree = 0;
-			size_t stitchPreVDD_degree = 0;
-			// find vertex 2 by searching the neighbors of vertex 1
-			std::vector<graph_vertex_type> const& vChildren1 = m_vChildren.at(v1);
-			bool bFind = false;
-			for (typename std::vector<graph_vertex_type>::const_iterator vic1 = vChildren1.begin(); vic1 != vChildren1.end(); ++vic1)
+		vertex_iterator vi, vie;
+		for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
+			if (this->good(*vi))
+				task.vGroupVertex.push_back(*vi);
+		task.vGroupBegin.push_back(0);
+		task.vGroupBegin.push_back(task.vGroupVertex.size());
+	}
+	uint32_t numGroups = task.vGroupBegin.size()-1;
+	task.mHidden.resize(numGroups);
+	numThreads = std::max(std::min(numThreads, (int32_t)numGroups), 1);
+
+	peel_kernel_type kernel = {&task};
+	limbo::containers::parallel_for(0, numGroups, 1, numThreads, kernel);
+
+	for (uint32_t group_id = 0; group_id < numGroups; ++group_id)
+	{
+		std::vector<graph_vertex_type> const& vHidden = task.mHidden[group_id];
+		for (typename std::vector<graph_vertex_type>::const_iterator it = vHidden.begin(); it != vHidden.end(); ++it)
+			m_vHiddenVertex.push(*it);
+	}
+
+	this->connected_component();
+}
+
+template <typename GraphType>
+void GraphSimplification<GraphType>::hide_small_degree(peel_task_type& task, uint32_t group_id) 
+{
+	std::vector<peel_degree_type>& vDegree = task.vDegree;
+	std::vector<graph_vertex_type>& vHidden = task.mHidden[group_id];
+
+	// count degrees by searching the neighbors of all merged vertices 
+	for (uint32_t i = task.vGroupBegin[group_id]; i != task.vGroupBegin[group_id+1]; ++i)
+	{
+		graph_vertex_type v1 = task.vGroupVertex[i];
+		peel_degree_type& d = vDegree[v1];
+		d.conflict = d.vdd = d.stitch = 0;
+		std::vector<graph_vertex_type> const& vChildren1 = m_vChildren.at(v1);
+		for (typename std::vector<graph_vertex_type>::const_iterator vic1 = vChildren1.begin(); vic1 != vChildren1.end(); ++vic1)
+		{
+			out_edge_iterator ei, eie;
+			for (boost::tie(ei, eie) = boost::out_edges(*vic1, m_graph); ei != eie; ++ei)
 			{
+				graph_vertex_type v2 = boost::target(*ei, m_graph);
+				// skip hidden vertex 
+				if (this->hidden(v2)) continue;
+				if (boost::get(boost::edge_weight, m_graph, *ei) < 0) // stitch edge 
+					d.stitch += 1;
+				else if (m_isVDDGND[v2]) // VDD neighbors are counted as one 
+					d.vdd += 1;
+				else 
+					d.conflict += 1;
+			}
+		}
+	}
+	// vertices queued to hide, in ascending order first 
+	for (uint32_t i = task.vGroupBegin[group_id]; i != task.vGroupBegin[group_id+1]; ++i)
+	{
+		graph_vertex_type v1 = task.vGroupVertex[i];
+		if (this->small_degree(v1, vDegree[v1]))
+			vHidden.push_back(v1);
+	}
+	for (uint32_t i = 0; i < vHidden.size(); ++i)
+	{
+		graph_vertex_type v1 = vHidden[i];
+		// hide all the children of v1 
+		// v1 is also in its children 
+		std::vector<graph_vertex_type> const& vChildren1 = m_vChildren.at(v1);
+		for (typename std::vector<graph_vertex_type>::const_iterator vic1 = vChildren1.begin(); vic1 != vChildren1.end(); ++vic1)
+			m_vStatus[*vic1] = HIDDEN;
 #ifdef DEBUG_GRAPHSIMPLIFICATION
-				limboAssert(vic1-vChildren1.begin() >= 0);
+		std::cout << "std::stack +" << v1 << std::endl;
+		limboAssert(m_vStatus[v1] == HIDDEN);
 #endif
-				graph_vertex_type vc1 = *vic1;
-				adjacency_iterator vi2, vie2;
-				for (boost::tie(vi2, vie2) = boost::adjacent_vertices(vc1, m_graph); vi2 != vie2; ++vi2)
-				{
-					// skip hidden vertex 
-					if (this->hidden(*vi2)) continue;
-					// skip stitch edges 
-					std::pair<graph_edge_type, bool> e12 = boost::edge(vc1, *vi2, m_graph);
-					limboAssert(e12.second);
-					if (boost::get(boost::edge_weight, m_graph, e12.first) < 0) 
-					{
-                        stitchPreVDD_degree += 1;
-							continue;
-                    }
-					// not exactly the number of conflict edge
-					bool isVdd = m_isVDDGND[*vi2];
-					if (isVdd && bFind)	continue;
-					if (isVdd) bFind = true;
-
-					conflictPreVDD_degree += 1;
-				}
+		// decrement the degrees of neighbors 
+		for (typename std::vector<graph_vertex_type>::const_iterator vic1 = vChildren1.begin(); vic1 != vChildren1.end(); ++vic1)
+		{
+			graph_vertex_type vc1 = *vic1;
+			out_edge_iterator ei, eie;
+			for (boost::tie(ei, eie) = boost::out_edges(vc1, m_graph); ei != eie; ++ei)
+			{
+				graph_vertex_type v2 = boost::target(*ei, m_graph);
+				// hidden or queued vertices are not tracked any more 
+				if (this->hidden(v2)) continue;
+				graph_vertex_type vp2 = this->parent(v2);
+				peel_degree_type& d = vDegree[vp2];
+				if (this->small_degree(vp2, d)) continue;
+				if (boost::get(boost::edge_weight, m_graph, *ei) < 0) 
+					d.stitch -= 1;
+				else if (m_isVDDGND[vc1]) 
+					d.vdd -= 1;
+				else 
+					d.conflict -= 1;
+				if (this->small_degree(vp2, d))
+					vHidden.push_back(vp2);
+			}
+		}
+	}
+}
+
+template <typename GraphType>
+void GraphSimplification<GraphType>::prune_precolor()
+{
+	// a vertex is pruned with the vertices merged into it, e.g., VDD and GND vertices merged by mergeVDD() 
+	std::vector<graph_vertex_type> vPruned; 
+	vertex_iterator vi, vie;
+	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
+	{
+		graph_vertex_type v = *vi;
+		if (!this->good(v) || !this->precolored(v) || m_vPrecolor[v] >= (int8_t)m_color_num) continue;
+		bool flag = true; 
+		std::vector<graph_vertex_type> const& vChildren = m_vChildren.at(v);
+		for (typename std::vector<graph_vertex_type>::const_iterator vic = vChildren.begin(); vic != vChildren.end() && flag; ++vic)
+		{
+			out_edge_iterator ei, eie;
+			for (boost::tie(ei, eie) = boost::out_edges(*vic, m_graph); ei != eie && flag; ++ei)
+			{
+				graph_vertex_type u = boost::target(*ei, m_graph);
+				// the cost of a stitch edge between two precolored vertices is fixed 
+				if (!this->hidden(u) && boost::get(boost::edge_weight, m_graph, *ei) < 0 && !this->precolored(this->parent(u)))
+					flag = false;
 			}
-			if (conflictPreVDD_degree < m_color_num && stitchPreVDD_degree ==0) // hide v1 
+		}
+		if (flag)
+			vPruned.push_back(v);
+	}
+	if (vPruned.empty())
+	{
+		this->connected_component();
+		return;
+	}
+
+	// all pruned vertices are removed first, so edges between them are not recorded 
+	for (typename std::vector<graph_vertex_type>::const_iterator it = vPruned.begin(); it != vPruned.end(); ++it)
+	{
+		std::vector<graph_vertex_type> const& vChildren = m_vChildren.at(*it);
+		for (typename std::vector<graph_vertex_type>::const_iterator vic = vChildren.begin(); vic != vChildren.end(); ++vic)
+			m_vStatus[*vic] = PRUNED;
+	}
+	m_vForbidden.assign(boost::num_vertices(m_graph), 0);
+	for (typename std::vector<graph_vertex_type>::const_iterator it = vPruned.begin(); it != vPruned.end(); ++it)
+	{
+		uint8_t mask = (1 << m_vPrecolor[*it]);
+		std::vector<graph_vertex_type> const& vChildren = m_vChildren.at(*it);
+		for (typename std::vector<graph_vertex_type>::const_iterator vic = vChildren.begin(); vic != vChildren.end(); ++vic)
+		{
+			out_edge_iterator ei, eie;
+			for (boost::tie(ei, eie) = boost::out_edges(*vic, m_graph); ei != eie; ++ei)
 			{
-				//m_vStatus[v1] = HIDDEN;
-				m_vHiddenVertex.push(v1);
-				hide_flag = true;
-				// hide all the children of v1 
-				// but no need to push them to the std::stack m_vHiddenVertex
-				// v1 is also in its children 
-				std::vector<graph_vertex_type> const& vChildren1 = m_vChildren.at(v1);
-				for (typename std::vector<graph_vertex_type>::const_iterator vic1 = vChildren1.begin(); vic1 != vChildren1.end(); ++vic1)
-					m_vStatus[*vic1] = HIDDEN;
-#ifdef DEBUG_GRAPHSIMPLIFICATION
-				std::cout << "std::stack +" << v1 << std::endl;
-				limboAssert(m_vStatus[v1] == HIDDEN);
-#endif
-				break;
+				graph_vertex_type u = boost::target(*ei, m_graph);
+				if (!this->hidden(u) && boost::get(boost::edge_weight, m_graph, *ei) >= 0)
+					m_vForbidden[this->parent(u)] |= mask;
 			}
 		}
-	} while (hide_flag);
+	}
 
 	this->connected_component();
 }
 
-// refer to http://www.geeksforgeeks.org/articulation-points-or-cut-vertices-in-a-graph/
-// for the recursive implementation 
+template <typename GraphType>
+void GraphSimplification<GraphType>::pruned_weights(typename GraphSimplification<GraphType>::graph_vertex_type v, 
+		std::vector<typename GraphSimplification<GraphType>::edge_weight_type>& vWeight) const 
+{
+	vWeight.assign(m_color_num, 0);
+	if (this->num_forbidden(v) == 0) return;
+	std::vector<graph_vertex_type> const& vChildren = m_vChildren.at(v);
+	for (typename std::vector<graph_vertex_type>::const_iterator vic = vChildren.begin(); vic != vChildren.end(); ++vic)
+	{
+		out_edge_iterator ei, eie;
+		for (boost::tie(ei, eie) = boost::out_edges(*vic, m_graph); ei != eie; ++ei)
+		{
+			graph_vertex_type u = boost::target(*ei, m_graph);
+			edge_weight_type w = boost::get(boost::edge_weight, m_graph, *ei);
+			if (m_vStatus[u] == PRUNED && w >= 0)
+				vWeight[this->pruned_color(u)] += w;
+		}
+	}
+}
+
+template <typename GraphType>
+void GraphSimplification<GraphType>::good_connected_component(std::vector<graph_vertex_type>& vGroupVertex, std::vector<uint32_t>& vGroupBegin) const
+{
+	uint32_t vertex_num = boost::num_vertices(m_graph);
+	std::vector<char> vVisited (vertex_num, false); 
+	std::vector<graph_vertex_type> vStack; 
+
+	vGroupVertex.clear();
+	vGroupBegin.assign(1, 0);
+	vertex_iterator vi, vie;
+	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
+	{
+		graph_vertex_type source = *vi;
+		if (!this->good(source) || vVisited[source]) continue;
+		vStack.push_back(source);
+		vVisited[source] = true;
+		while (!vStack.empty())
+		{
+			graph_vertex_type v = vStack.back();
+			vStack.pop_back();
+			vGroupVertex.push_back(v);
+
+			std::vector<graph_vertex_type> const& vChildren = m_vChildren.at(v);
+			for (typename std::vector<graph_vertex_type>::const_iterator vic = vChildren.begin(); vic != vChildren.end(); ++vic)
+			{
+				adjacency_iterator ui, uie;
+				for (boost::tie(ui, uie) = boost::adjacent_vertices(*vic, m_graph); ui != uie; ++ui)
+				{
+					if (this->hidden(*ui)) continue;
+					graph_vertex_type u = this->parent(*ui);
+					if (!vVisited[u])
+					{
+						vStack.push_back(u);
+						vVisited[u] = true;
+					}
+				}
+			}
+		}
+		std::sort(vGroupVertex.begin()+vGroupBegin.back(), vGroupVertex.end());
+		vGroupBegin.push_back(vGroupVertex.size());
+	}
+}
+
+// iterative version of the recursive implementation in 
+// http://www.geeksforgeeks.org/articulation-points-or-cut-vertices-in-a-graph/
+// DFS frames are kept in an explicit stack, so long chains do not overflow the call stack 
 template <typename GraphType>
 void GraphSimplification<GraphType>::biconnected_component()
 {
 	uint32_t vertex_num = boost::num_vertices(m_graph);
-	std::stack<graph_vertex_type> vStack; // std::stack for dfs 
-	// for speed instead of memory (no bool)
-	std::deque<bool> vVisited (vertex_num, false); 
+	graph_vertex_type const invalid_vertex = std::numeric_limits<graph_vertex_type>::max();
 	std::vector<graph_vertex_type> vParent (vertex_num); 
-	std::vector<uint32_t> vChildrenCnt (vertex_num, 0);
 	// vLow[u] = min(vDisc[u], vDisc[w]), where w is an ancestor of u
 	// there is a back edge from some descendant of u to w
 	std::vector<uint32_t> vLow (vertex_num, std::numeric_limits<uint32_t>::max()); // lowest vertex reachable from subtree under v  
-	std::vector<uint32_t> vDisc(vertex_num, std::numeric_limits<uint32_t>::max()); // discovery time 
-	std::deque<bool> vArtiPoint (vertex_num, false); // true if it is articulation point 
-	std::stack<std::pair<graph_vertex_type, graph_vertex_type> > vEdge; // virtual edge, it can be connection between parents 
-	std::list<std::pair<graph_vertex_type, std::set<graph_vertex_type> > > mCompVertex; // save bi-connected components 
+	std::vector<uint32_t> vDisc(vertex_num, std::numeric_limits<uint32_t>::max()); // discovery time, maximum value if not visited 
+	std::vector<std::pair<graph_vertex_type, graph_vertex_type> > vEdge; // stack of virtual edges, it can be connection between parents 
+	std::vector<dfs_frame_type> vFrame; // stack of DFS frames 
+	bcc_collector_type bcc (vertex_num); // save bi-connected components 
 	uint32_t visit_time = 0;
 
 	// set initial parent of current vertex to itself 
@@ -912,182 +1565,218 @@ void GraphSimplification<GraphType>::biconnected_component()
 	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
 	{
 		graph_vertex_type source = *vi;
-		if (!vVisited[source])
+		if (vDisc[source] == std::numeric_limits<uint32_t>::max())
+		{
+			vDisc[source] = vLow[source] = visit_time++;
+			vFrame.push_back(this->dfs_frame(source));
+		}
+		while (!vFrame.empty())
 		{
-			biconnected_component_recursion(source, vVisited, vDisc, vLow, vParent, visit_time, vEdge, mCompVertex);
+			dfs_frame_type& f = vFrame.back();
+			graph_vertex_type v = f.v;
+			graph_vertex_type next = invalid_vertex; 
+			// go through all vertices adjacent to merged vertices of v until an unvisited one is found 
+			while (next == invalid_vertex)
+			{
+				if (!f.adjacent)
+				{
+					if (f.child == m_vChildren[v].size()) break;
+					graph_vertex_type vc = m_vChildren[v][f.child++];
+					limboAssertMsg(vc < m_vStatus.size(), "m_vStatus ERROR: %u vs %u", (uint32_t)v, (uint32_t)vc);
+					// skip hidden vertex 
+					if (this->hidden(vc)) continue;
+					boost::tie(f.ui, f.uie) = boost::adjacent_vertices(vc, m_graph);
+					f.adjacent = true;
+				}
+				if (f.ui == f.uie)
+				{
+					f.adjacent = false;
+					continue;
+				}
+				graph_vertex_type uc = *f.ui;
+				++f.ui;
+				// skip hidden vertex 
+				if (this->hidden(uc)) continue;
+
+				f.isolate = false; 
+				graph_vertex_type u = this->parent(uc);
+				limboAssert(this->good(u));
+
+				// If u is not visited yet, then make it a child of v
+				// in DFS tree and descend into it 
+				if (vDisc[u] == std::numeric_limits<uint32_t>::max())
+				{
+					++f.children;
+					vParent[u] = v;
+					vEdge.push_back(std::make_pair(std::min(v, u), std::max(v, u)));
+					next = u;
+				}
+				else if (u != vParent[v] && vDisc[u] < vLow[v])
+				{
+					vLow[v] = std::min(vLow[v], vDisc[u]);
+					vEdge.push_back(std::make_pair(std::min(v, u), std::max(v, u)));
+				}
+			}
+			if (next != invalid_vertex)
+			{
+				vDisc[next] = vLow[next] = visit_time++;
+				vFrame.push_back(this->dfs_frame(next)); // f is invalid from here 
+				continue;
+			}
+
+			// for isolated vertex, create a component 
+			if (f.isolate)
+			{
+				bcc.add(v);
+				bcc.close(invalid_vertex);
+			}
+			vFrame.pop_back();
+			if (vFrame.empty()) break;
+
+			// return to the parent in DFS tree 
+			graph_vertex_type u = v;
+			dfs_frame_type const& pf = vFrame.back();
+			v = pf.v;
+			// Check if the subtree rooted with u has a connection to
+			// one of the ancestors of v
+			vLow[v] = std::min(vLow[v], vLow[u]);
+
+			// v is an articulation point in following cases
+
+			// (1) v is root of DFS tree and has two or more chilren.
+			// (2) If v is not root and low value of one of its child is no less 
+			// than discovery value of v.
+			if ((vParent[v] == v && pf.children > 1)
+					|| (vParent[v] != v && vLow[u] >= vDisc[v]))
+			{
+				std::pair<graph_vertex_type, graph_vertex_type> e (std::min(v, u), std::max(v, u));
+				while (vEdge.back() != e)
+				{
+					bcc.add(vEdge.back().first);
+					bcc.add(vEdge.back().second);
+					vEdge.pop_back();
+				}
+				bcc.add(e.first);
+				bcc.add(e.second);
+				vEdge.pop_back();
+				bcc.close(v);
+			}
 		}
 		// if stack is not empty, pop all edges from stack
 		if (!vEdge.empty())
 		{
-			mCompVertex.push_back(std::make_pair(std::numeric_limits<graph_vertex_type>::max(), std::set<graph_vertex_type>()));
 			do
 			{
-				mCompVertex.back().second.insert(vEdge.top().first);
-				mCompVertex.back().second.insert(vEdge.top().second);
-				vEdge.pop();
+				bcc.add(vEdge.back().first);
+				bcc.add(vEdge.back().second);
+				vEdge.pop_back();
 			} while (!vEdge.empty());
+			bcc.close(invalid_vertex);
 		}
 	}
-	// collect articulation points 
-	uint32_t comp_id = 0;
 	// reset members 
-	m_mArtiPoint.clear();
-	m_mCompVertex.assign(mCompVertex.size(), std::vector<graph_vertex_type>());
-	for (typename std::list<std::pair<graph_vertex_type, std::set<graph_vertex_type> > >::const_iterator it = mCompVertex.begin(); it != mCompVertex.end(); ++it, ++comp_id)
+	m_vCompVertex.swap(bcc.vVertex);
+	m_vCompVertexBegin.swap(bcc.vBegin);
+	// collect articulation points and the components containing them 
+	std::vector<char> vArtiPoint (vertex_num, false); // true if it is articulation point 
+	for (uint32_t comp_id = 0; comp_id != bcc.vAp.size(); ++comp_id)
 	{
-		graph_vertex_type vap = it->first;
-		std::set<graph_vertex_type> const& sComp = it->second;
-		if (vap < std::numeric_limits<graph_vertex_type>::max()) // valid 
-			m_mArtiPoint.insert(std::make_pair(vap, std::set<uint32_t>()));
-		m_mCompVertex[comp_id].assign(sComp.begin(), sComp.end());
+		if (bcc.vAp[comp_id] != invalid_vertex) // valid 
+			vArtiPoint[bcc.vAp[comp_id]] = true;
 	}
-	comp_id = 0;
-	for (typename std::list<std::pair<graph_vertex_type, std::set<graph_vertex_type> > >::const_iterator it = mCompVertex.begin(); it != mCompVertex.end(); ++it, ++comp_id)
+	std::vector<std::pair<graph_vertex_type, uint32_t> > vApComp; 
+	for (uint32_t comp_id = 0; comp_id != this->num_component(); ++comp_id)
 	{
-		//graph_vertex_type vap = it->first;
-		std::set<graph_vertex_type> const& sComp = it->second;
-		for (typename std::set<graph_vertex_type>::const_iterator itc = sComp.begin(); itc != sComp.end(); ++itc)
+		for (uint32_t i = m_vCompVertexBegin[comp_id]; i != m_vCompVertexBegin[comp_id+1]; ++i)
 		{
-			graph_vertex_type v = *itc;
-			if (this->articulation_point(v))
-				m_mArtiPoint[v].insert(comp_id);
+			if (vArtiPoint[m_vCompVertex[i]])
+				vApComp.push_back(std::make_pair(m_vCompVertex[i], comp_id));
 		}
 	}
+	this->set_articulation_points(vApComp);
 
 #ifdef DEBUG_LIWEI
-	for (typename std::map<graph_vertex_type, std::set<uint32_t> >::iterator it = m_mArtiPoint.begin(); it != m_mArtiPoint.end(); it++)
+	for (uint32_t i = 0; i != m_vArtiPoint.size(); i++)
 	{
-		if (m_isVDDGND[it->first])
+		if (m_isVDDGND[m_vArtiPoint[i]])
             limboPrint(kNONE, "VDD__");
-        limboPrint(kNONE, "AP : %u\nwith comps : ", (uint32_t)it->first);
-		for (typename std::set<uint32_t>::iterator its = it->second.begin(); its != it->second.end(); its++)
-            limboPrint(kNONE, "%u, ", (uint32_t)*its);
+        limboPrint(kNONE, "AP : %u\nwith comps : ", (uint32_t)m_vArtiPoint[i]);
+		for (uint32_t j = m_vArtiPointCompBegin[i]; j != m_vArtiPointCompBegin[i+1]; j++)
+            limboPrint(kNONE, "%u, ", m_vArtiPointComp[j]);
         limboPrint(kNONE, "\n");
 	}
-	comp_id = 0;
-	for (typename std::vector<std::vector<graph_vertex_type> >::iterator it = m_mCompVertex.begin(); it != m_mCompVertex.end(); it++, comp_id++)
+	for (uint32_t comp_id = 0; comp_id != this->num_component(); comp_id++)
 	{
         limboPrint(kNONE, "comp %u\n", comp_id);
-		for (typename std::vector<graph_vertex_type>::iterator its = it->begin(); its != it->end(); its++)
+		for (uint32_t i = m_vCompVertexBegin[comp_id]; i != m_vCompVertexBegin[comp_id+1]; i++)
 		{
-			if(m_isVDDGND[*its])
+			if(m_isVDDGND[m_vCompVertex[i]])
                 limboPrint(kNONE, "vdd_");
-            limboPrint(kNONE, "%u ", (uint32_t)*its);
+            limboPrint(kNONE, "%u ", (uint32_t)m_vCompVertex[i]);
 		}
         limboPrint(kNONE, "\n\n");
 	}
 #endif
 
 #ifdef DEBUG_GRAPHSIMPLIFICATION
-	comp_id = 0;
-	for (typename std::list<std::pair<graph_vertex_type, std::set<graph_vertex_type> > >::const_iterator it = mCompVertex.begin(); it != mCompVertex.end(); ++it, ++comp_id)
+	for (uint32_t comp_id = 0; comp_id != this->num_component(); ++comp_id)
 	{
-		graph_vertex_type vap = it->first;
-		std::set<graph_vertex_type> const& sComp = it->second;
-		std::cout << "+ articulation point " << vap << " --> comp " << comp_id << ": ";
-		for (typename std::set<graph_vertex_type>::const_iterator itc = sComp.begin(); itc != sComp.end(); ++itc)
-			std::cout << *itc << " ";
+		std::cout << "+ articulation point " << bcc.vAp[comp_id] << " --> comp " << comp_id << ": ";
+		for (uint32_t i = m_vCompVertexBegin[comp_id]; i != m_vCompVertexBegin[comp_id+1]; ++i)
+			std::cout << m_vCompVertex[i] << " ";
 		std::cout << std::endl;
 	}
-	for (typename std::map<graph_vertex_type, std::set<uint32_t> >::const_iterator it = m_mArtiPoint.begin(); it != m_mArtiPoint.end(); ++it)
+	for (uint32_t i = 0; i != m_vArtiPoint.size(); ++i)
 	{
-		graph_vertex_type vap = it->first;
-		std::set<uint32_t> const& sComp = it->second;
-		std::cout << "ap " << vap << ": ";
-		for (typename std::set<uint32_t>::const_iterator itc = sComp.begin(); itc != sComp.end(); ++itc)
-			std::cout << *itc << " ";
+		std::cout << "ap " << m_vArtiPoint[i] << ": ";
+		for (uint32_t j = m_vArtiPointCompBegin[i]; j != m_vArtiPointCompBegin[i+1]; ++j)
+			std::cout << m_vArtiPointComp[j] << " ";
 		std::cout << std::endl;
 	}
 #endif
 }
 
 template <typename GraphType>
-void GraphSimplification<GraphType>::biconnected_component_recursion(graph_vertex_type v, std::deque<bool>& vVisited, std::vector<uint32_t>& vDisc, 
-		std::vector<uint32_t>& vLow, std::vector<graph_vertex_type>& vParent, uint32_t& visit_time, 
-		std::stack<std::pair<graph_vertex_type, graph_vertex_type> >& vEdge, 
-		std::list<std::pair<graph_vertex_type, std::set<graph_vertex_type> > >& mCompVertex) const
-{ 
-    // Count of children in DFS Tree
-    uint32_t children = 0;
- 
-    // Mark the current node as visited
-    vVisited[v] = true;
- 
-    // Initialize discovery time and low value
-    vDisc[v] = vLow[v] = visit_time++;
- 
-    // Go through all vertices adjacent to this
+typename GraphSimplification<GraphType>::dfs_frame_type GraphSimplification<GraphType>::dfs_frame(graph_vertex_type v) const
+{
+	dfs_frame_type f; 
+	f.v = v;
+	f.child = 0;
+	f.adjacent = false;
+	f.isolate = true;
+	f.children = 0;
 	// GOOD : if this node is still in graph
-	if (!this->good(v)) return;
-
-	bool isolate = true;
-	// find neighbors of all merged vertices
-	std::vector<graph_vertex_type> const& vChildren = m_vChildren.at(v);
-	for (typename std::vector<graph_vertex_type>::const_iterator vic = vChildren.begin(); vic != vChildren.end(); ++vic)
+	if (!this->good(v))
 	{
-		graph_vertex_type vc = *vic;
-        limboAssertMsg(vc < m_vStatus.size(), "m_vStatus ERROR: %u vs %u", (uint32_t)v, (uint32_t)vc);
-		// skip hidden vertex 
-		if (this->hidden(vc)) continue;
+		f.child = m_vChildren[v].size();
+		f.isolate = false;
+	}
+	return f;
+}
 
-		adjacency_iterator ui, uie;
-		for (boost::tie(ui, uie) = boost::adjacent_vertices(vc, m_graph); ui != uie; ++ui)
+template <typename GraphType>
+void GraphSimplification<GraphType>::set_articulation_points(std::vector<std::pair<graph_vertex_type, uint32_t> >& vApComp)
+{
+	std::sort(vApComp.begin(), vApComp.end());
+	vApComp.erase(std::unique(vApComp.begin(), vApComp.end()), vApComp.end());
+
+	m_vArtiPointId.assign(boost::num_vertices(m_graph), std::numeric_limits<uint32_t>::max());
+	m_vArtiPoint.clear();
+	m_vArtiPointCompBegin.assign(1, 0);
+	m_vArtiPointComp.clear();
+	for (typename std::vector<std::pair<graph_vertex_type, uint32_t> >::const_iterator it = vApComp.begin(); it != vApComp.end(); ++it)
+	{
+		if (m_vArtiPoint.empty() || m_vArtiPoint.back() != it->first)
 		{
-			graph_vertex_type uc = *ui;
-			// skip hidden vertex 
-			if (this->hidden(uc)) continue;
-
-			isolate = false; 
-			graph_vertex_type u = this->parent(uc);
-			limboAssert(this->good(u));
-
-			// If v is not visited yet, then make it a child of u
-			// in DFS tree and recur for it
-			if (!vVisited[u])
-			{
-				++children;
-				vParent[u] = v;
-				vEdge.push(std::make_pair(std::min(v, u), std::max(v, u)));
-				biconnected_component_recursion(u, vVisited, vDisc, vLow, vParent, visit_time, vEdge, mCompVertex);
-
-				// Check if the subtree rooted with v has a connection to
-				// one of the ancestors of u
-				vLow[v] = std::min(vLow[v], vLow[u]);
-
-				// u is an articulation point in following cases
-
-				// (1) u is root of DFS tree and has two or more chilren.
-				// (2) If u is not root and low value of one of its child is more
-				// than discovery value of u.
-				if ((vParent[v] == v && children > 1)
-						|| (vParent[v] != v && vLow[u] >= vDisc[v]))
-				{
-					mCompVertex.push_back(std::make_pair(v, std::set<graph_vertex_type>()));
-					while (vEdge.top().first != std::min(v, u) || vEdge.top().second != std::max(v, u))
-					{
-						mCompVertex.back().second.insert(vEdge.top().first);
-						mCompVertex.back().second.insert(vEdge.top().second);
-						vEdge.pop();
-					}
-					mCompVertex.back().second.insert(vEdge.top().first);
-					mCompVertex.back().second.insert(vEdge.top().second);
-					vEdge.pop();
-				}
-
-			}
-			else if (u != vParent[v] && vDisc[u] < vLow[v])
-			{
-				vLow[v] = std::min(vLow[v], vDisc[u]);
-				vEdge.push(std::make_pair(std::min(v, u), std::max(v, u)));
-			}
+			if (!m_vArtiPoint.empty())
+				m_vArtiPointCompBegin.push_back(m_vArtiPointComp.size());
+			m_vArtiPointId[it->first] = m_vArtiPoint.size();
+			m_vArtiPoint.push_back(it->first);
 		}
+		m_vArtiPointComp.push_back(it->second);
 	}
-	// for isolated vertex, create a component 
-	if (isolate)
-	{
-		mCompVertex.push_back(std::make_pair(std::numeric_limits<graph_vertex_type>::max(), std::set<graph_vertex_type>()));
-		mCompVertex.back().second.insert(v);
-	}
+	if (!m_vArtiPoint.empty())
+		m_vArtiPointCompBegin.push_back(m_vArtiPointComp.size());
 }
 
 template <typename GraphType>
@@ -1102,6 +1791,11 @@ void GraphSimplification<GraphType>::connected_component()
 	std::deque<bool> vVisited (vertex_num, false); 
 	uint32_t comp_id = 0;
 	std::vector<uint32_t> vComponent (vertex_num, std::numeric_limits<uint32_t>::max());
+	// pairs of (articulation point, component), starting from existing ones 
+	std::vector<std::pair<graph_vertex_type, uint32_t> > vApComp; 
+	for (uint32_t i = 0; i != m_vArtiPoint.size(); ++i)
+		for (uint32_t j = m_vArtiPointCompBegin[i]; j != m_vArtiPointCompBegin[i+1]; ++j)
+			vApComp.push_back(std::make_pair(m_vArtiPoint[i], m_vArtiPointComp[j]));
 
 	// std::set initial parent of current vertex to itself 
 	vertex_iterator vi, vie;
@@ -1127,7 +1821,7 @@ void GraphSimplification<GraphType>::connected_component()
 			// for a articulation point, do not explore the neighbors 
 			if (this->articulation_point(v))
 			{
-				m_mArtiPoint[v].insert(comp_id);
+				vApComp.push_back(std::make_pair(v, comp_id));
 				vVisited[v] = false;
 				continue;
 			}
@@ -1157,9 +1851,9 @@ void GraphSimplification<GraphType>::connected_component()
 #endif
 	// explore the connection between articulation points
 	// create additional components for connected articulation pairs 
-	for (typename std::map<graph_vertex_type, std::set<uint32_t> >::const_iterator vapi = m_mArtiPoint.begin(); vapi != m_mArtiPoint.end(); ++vapi)
+	for (typename std::vector<graph_vertex_type>::const_iterator vapi = m_vArtiPoint.begin(); vapi != m_vArtiPoint.end(); ++vapi)
 	{
-		graph_vertex_type v = vapi->first;
+		graph_vertex_type v = *vapi;
 		if (!vVisited[v])
 		{
 			adjacency_iterator ui, uie;
@@ -1169,8 +1863,8 @@ void GraphSimplification<GraphType>::connected_component()
 				if (this->hidden(u)) continue;
 				if (!vVisited[u] && this->articulation_point(u))
 				{
-					m_mArtiPoint[v].insert(comp_id);
-					m_mArtiPoint[u].insert(comp_id);
+					vApComp.push_back(std::make_pair(v, comp_id));
+					vApComp.push_back(std::make_pair(u, comp_id));
 
 #ifdef DEBUG_GRAPHSIMPLIFICATION
 					std::cout << "detect " << v << ", " << u << " ==> comp " << comp_id << std::endl;
@@ -1183,25 +1877,36 @@ void GraphSimplification<GraphType>::connected_component()
 		}
 	}
 
-	// std::set m_mCompVertex
-	m_mCompVertex.assign(comp_id, std::vector<graph_vertex_type>());
+	this->set_articulation_points(vApComp);
+
+	// std::set m_vCompVertex by counting vertices of each component 
+	m_vCompVertexBegin.assign(comp_id+1, 0);
 	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
 	{
 		graph_vertex_type v = *vi;
 		// consider good vertices only 
 		// skip articulation_point
 		if (this->good(v) && !this->articulation_point(v))
-			m_mCompVertex[vComponent[v]].push_back(v);
+			++m_vCompVertexBegin[vComponent[v]+1];
 	}
-	for (typename std::map<graph_vertex_type, std::set<uint32_t> >::const_iterator vapi = m_mArtiPoint.begin(); vapi != m_mArtiPoint.end(); ++vapi)
+	for (std::vector<uint32_t>::const_iterator itc = m_vArtiPointComp.begin(); itc != m_vArtiPointComp.end(); ++itc)
+		++m_vCompVertexBegin[*itc+1];
+	for (uint32_t i = 0; i != comp_id; ++i)
+		m_vCompVertexBegin[i+1] += m_vCompVertexBegin[i];
+	std::vector<uint32_t> vPos (m_vCompVertexBegin.begin(), m_vCompVertexBegin.end()-1);
+	m_vCompVertex.resize(m_vCompVertexBegin.back());
+	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
 	{
-		graph_vertex_type vap = vapi->first;
-		std::set<uint32_t> const& sComp = vapi->second;
-		for (typename std::set<uint32_t>::const_iterator itc = sComp.begin(); itc != sComp.end(); ++itc)
-			m_mCompVertex[*itc].push_back(vap);
+		graph_vertex_type v = *vi;
+		if (this->good(v) && !this->articulation_point(v))
+			m_vCompVertex[vPos[vComponent[v]]++] = v;
 	}
+	for (uint32_t i = 0; i != m_vArtiPoint.size(); ++i)
+		for (uint32_t j = m_vArtiPointCompBegin[i]; j != m_vArtiPointCompBegin[i+1]; ++j)
+			m_vCompVertex[vPos[m_vArtiPointComp[j]]++] = m_vArtiPoint[i];
 }
 
+
 /// recover merged vertices 
 /// @param vColor must be partially assigned colors except simplified vertices  
 template <typename GraphType>
@@ -1228,67 +1933,85 @@ void GraphSimplification<GraphType>::recover_merge_subK4(std::vector<int8_t>& vC
 template <typename GraphType>
 void GraphSimplification<GraphType>::recover_biconnected_component(std::vector<std::vector<int8_t> >& mColor, std::vector<std::vector<graph_vertex_type> > const& mSimpl2Orig) const
 {
-	// a single articulation point must correspond to two components 
-	// std::map<graph_vertex_type, std::pair<uint32_t, uint32_t> > m_mArtiPoint
-	// std::vector<std::vector<graph_vertex_type> > m_mCompVertex
-	
-	// only contain mapping for articulation points 
-	std::vector<std::map<graph_vertex_type, graph_vertex_type> > mApOrig2Simpl (mSimpl2Orig.size());
-	for (uint32_t i = 0; i < mSimpl2Orig.size(); ++i)
+	// flatten components to share the implementation with component sets 
+	std::vector<graph_vertex_type> vVertex; 
+	std::vector<uint32_t> vBegin (1, 0); 
+	std::vector<int8_t> vColor; 
+	for (uint32_t i = 0; i < mColor.size(); ++i)
 	{
-		std::vector<graph_vertex_type> const& vSimpl2Orig = mSimpl2Orig[i];
-		std::map<graph_vertex_type, graph_vertex_type>& vApOrig2Simpl = mApOrig2Simpl[i];
-
-		for (uint32_t j = 0; j < vSimpl2Orig.size(); ++j)
-		{
-			if (m_mArtiPoint.count(vSimpl2Orig[j]))
-				vApOrig2Simpl[vSimpl2Orig[j]] = j;
-		}
+		vVertex.insert(vVertex.end(), mSimpl2Orig[i].begin(), mSimpl2Orig[i].begin()+mColor[i].size());
+		vColor.insert(vColor.end(), mColor[i].begin(), mColor[i].end());
+		vBegin.push_back(vColor.size());
 	}
+	this->recover_biconnected_component(vVertex, vBegin, vColor);
+	for (uint32_t i = 0; i < mColor.size(); ++i)
+		std::copy(vColor.begin()+vBegin[i], vColor.begin()+vBegin[i+1], mColor[i].begin());
+}
 
-	std::vector<int32_t> vRotation (m_mCompVertex.size(), 0); // rotation amount for each component
-	std::deque<bool> vVisited (m_mCompVertex.size(), false); // visited flag 
-	std::vector<std::set<graph_vertex_type> > vCompAp (m_mCompVertex.size()); // articulation points for each component 
-
-	for (typename std::map<graph_vertex_type, std::set<uint32_t> >::const_iterator vapi = m_mArtiPoint.begin(); vapi != m_mArtiPoint.end(); ++vapi)
+template <typename GraphType>
+void GraphSimplification<GraphType>::recover_biconnected_component(std::vector<graph_vertex_type> const& vVertex, std::vector<uint32_t> const& vBegin, 
+		std::vector<int8_t>& vColor) const
+{
+	// a single articulation point must correspond to two components 
+	// m_vArtiPoint and m_vArtiPointComp: articulation points and the components split by them 
+	// m_vCompVertex: vertices grouped by components 
+	uint32_t comp_num = vBegin.size()-1; 
+
+	// position in vVertex of each entry of m_vArtiPointComp, 
+	// and positions of articulation points of each component 
+	std::vector<uint32_t> vApPos (m_vArtiPointComp.size(), std::numeric_limits<uint32_t>::max());
+	std::vector<uint32_t> vCompApBegin (1, 0); 
+	std::vector<uint32_t> vCompAp; 
+	for (uint32_t comp_id = 0; comp_id < comp_num; ++comp_id)
 	{
-		graph_vertex_type vap = vapi->first;
-		std::set<uint32_t> const& sComp = vapi->second;
-		for (typename std::set<uint32_t>::const_iterator itc = sComp.begin(); itc != sComp.end(); ++itc)
+		for (uint32_t i = vBegin[comp_id]; i != vBegin[comp_id+1]; ++i)
 		{
-			uint32_t comp = *itc;
-			vCompAp[comp].insert(vap);
-			//limboAssert(vCompAp[comp].size() < 3);
+			graph_vertex_type v = vVertex[i];
+			if (!this->articulation_point(v)) continue;
+			uint32_t ap_id = m_vArtiPointId[v];
+			std::vector<uint32_t>::const_iterator found = std::lower_bound(m_vArtiPointComp.begin()+m_vArtiPointCompBegin[ap_id], 
+					m_vArtiPointComp.begin()+m_vArtiPointCompBegin[ap_id+1], comp_id);
+			if (found != m_vArtiPointComp.begin()+m_vArtiPointCompBegin[ap_id+1] && *found == comp_id)
+			{
+				vApPos[found-m_vArtiPointComp.begin()] = i;
+				vCompAp.push_back(i);
+			}
 		}
+		vCompApBegin.push_back(vCompAp.size());
 	}
 
+	std::vector<int32_t> vRotation (comp_num, 0); // rotation amount for each component
+	std::vector<char> vVisited (comp_num, false); // visited flag 
+
 	// dfs based approach to propagate rotation 
-	for (uint32_t comp_id = 0; comp_id < vCompAp.size(); ++comp_id)
+	// the components and articulation points form a tree, so the rotations do not depend on the order of visiting 
+	std::vector<uint32_t> vStack; 
+	for (uint32_t comp_id = 0; comp_id < comp_num; ++comp_id)
 	{
 		if (!vVisited[comp_id])
 		{
-			std::stack<uint32_t> vStack;
-			vStack.push(comp_id);
+			vStack.push_back(comp_id);
 			vVisited[comp_id] = true;
 			while (!vStack.empty())
 			{
-				uint32_t c = vStack.top(); // current component 
-				vStack.pop();
+				uint32_t c = vStack.back(); // current component 
+				vStack.pop_back();
 
-				for (typename std::set<graph_vertex_type>::const_iterator vapi = vCompAp[c].begin(); vapi != vCompAp[c].end(); ++vapi)
+				for (uint32_t k = vCompApBegin[c]; k != vCompApBegin[c+1]; ++k)
 				{
-					graph_vertex_type vap = *vapi;
-					std::set<uint32_t> const& sComp = m_mArtiPoint.at(vap);
+					uint32_t pos = vCompAp[k];
+					uint32_t ap_id = m_vArtiPointId[vVertex[pos]];
 
-					for (typename std::set<uint32_t>::const_iterator itcc = sComp.begin(); itcc != sComp.end(); ++itcc)
+					for (uint32_t j = m_vArtiPointCompBegin[ap_id]; j != m_vArtiPointCompBegin[ap_id+1]; ++j)
 					{
-						uint32_t cc = *itcc; // child component
-						if (!vVisited[cc])
+						uint32_t cc = m_vArtiPointComp[j]; // child component
+						if (cc < comp_num && !vVisited[cc])
 						{
-							vStack.push(cc);
+							vStack.push_back(cc);
 							vVisited[cc] = true;
-							int8_t color_c = mColor[c][mApOrig2Simpl[c][vap]];
-							int8_t color_cc = mColor[cc][mApOrig2Simpl[cc][vap]];
+							limboAssert(vApPos[j] != std::numeric_limits<uint32_t>::max());
+							int8_t color_c = vColor[pos];
+							int8_t color_cc = vColor[vApPos[j]];
 							vRotation[cc] += vRotation[c] + color_c - color_cc;
 						}
 					}
@@ -1298,45 +2021,39 @@ void GraphSimplification<GraphType>::recover_biconnected_component(std::vector<s
 	}
 
 	// apply color rotation 
-	for (uint32_t comp_id = 0; comp_id < mColor.size(); ++comp_id)
+	for (uint32_t comp_id = 0; comp_id < comp_num; ++comp_id)
 	{
-		int32_t Non_color_count = 0;
-		std::vector<int8_t>& vColor = mColor[comp_id];
 		int32_t rotation = vRotation[comp_id];
 		if (rotation < 0) // add a large enough K*m to achieve positive value 
 			rotation += (limbo::abs(rotation)/m_color_num+1)*m_color_num;
 		limboAssert(rotation >= 0);
 		rotation %= (int32_t)m_color_num;
-		for (uint32_t v = 0; v < vColor.size(); ++v)
+		for (uint32_t i = vBegin[comp_id]; i != vBegin[comp_id+1]; ++i)
 		{	 
 		#ifdef DEBUG_LIWEI
-			if(vColor[v] >= 0)
-				vColor[v] = (vColor[v] + rotation) % (int32_t)m_color_num;
-			else
-				Non_color_count++;
+			if(vColor[i] >= 0)
+				vColor[i] = (vColor[i] + rotation) % (int32_t)m_color_num;
 		#else
-			limboAssert(vColor[v] >= 0);
-			vColor[v] = (vColor[v] + rotation) % (int32_t)m_color_num;
+			limboAssert(vColor[i] >= 0);
+			vColor[i] = (vColor[i] + rotation) % (int32_t)m_color_num;
 		#endif
-
 		}
 	}
 
 #ifdef DEBUG_GRAPHSIMPLIFICATION
-	for (typename std::map<graph_vertex_type, std::set<uint32_t> >::const_iterator vapi = m_mArtiPoint.begin(); vapi != m_mArtiPoint.end(); ++vapi)
+	for (uint32_t i = 0; i != m_vArtiPoint.size(); ++i)
 	{
-		graph_vertex_type vap = vapi->first;
-		std::set<uint32_t> const& sComp = vapi->second;
+		graph_vertex_type vap = m_vArtiPoint[i];
 
 		int8_t prev_color = -1;
-		for (typename std::set<uint32_t>::const_iterator itc = sComp.begin(); itc != sComp.end(); ++itc)
+		for (uint32_t j = m_vArtiPointCompBegin[i]; j != m_vArtiPointCompBegin[i+1]; ++j)
 		{
-			uint32_t comp = *itc;
-			int8_t color = mColor[comp][mApOrig2Simpl[comp][vap]];
-			if (itc == sComp.begin())
+			uint32_t comp = m_vArtiPointComp[j];
+			int8_t color = vColor[vApPos[j]];
+			if (j == m_vArtiPointCompBegin[i])
 				prev_color = color;
 			else limboAssertMsg(prev_color == color,
-					"%u: comp %u, c[%u] = %u; prev_color = %u", vap, comp, mApOrig2Simpl[comp][vap], color, prev_color);
+					"%u: comp %u, c[%u] = %u; prev_color = %u", vap, comp, vApPos[j], color, prev_color);
 		}
 	}
 #endif
@@ -1399,6 +2116,16 @@ void GraphSimplification<GraphType>::recover_hide_small_degree(std::vector<int8_
 	}
 }
 
+template <typename GraphType>
+void GraphSimplification<GraphType>::recover_prune_precolor(std::vector<int8_t>& vColor) const
+{
+	for (uint32_t v = 0; v < m_vStatus.size(); ++v)
+	{
+		if (m_vStatus[v] == PRUNED)
+			vColor[v] = this->pruned_color(v);
+	}
+}
+
 template <typename GraphType>
 void GraphSimplification<GraphType>::write_graph_dot(std::string const& filename) const 
 {
@@ -1474,7 +2201,7 @@ void GraphSimplification<GraphType>::write_simplified_graph_dot(std::string cons
 
 	uint32_t offset = 0;
 	// component by component 
-	for (uint32_t comp_id = 0; comp_id != m_mCompVertex.size(); ++comp_id)
+	for (uint32_t comp_id = 0; comp_id != this->num_component(); ++comp_id)
 	{
 		graph_type sg;
 		std::vector<graph_vertex_type> vSimpl2Orig;
@@ -0,0 +1,503 @@
+/**
+ * @file   GraphSnapshot.h
+ * @brief  binary snapshots of conflict graphs with precolors, loaded by memory mapping, and conversion from and to graphviz
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_GRAPHSNAPSHOT
+#define LIMBO_ALGORITHMS_COLORING_GRAPHSNAPSHOT
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <limits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <boost/cstdint.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+/// @class limbo::algorithms::coloring::GraphSnapshot
+/// Binary snapshot of a conflict graph, to replay coloring problems of production graphs
+/// without parsing graphviz text.
+///
+/// The file is a header followed by arrays in CSR form, each starting at a multiple of 8 bytes:
+/// - offsets, uint64 per vertex with one more entry for the end, of the edges grouped by their smaller ends;
+/// - the larger ends of edges, uint32 per edge;
+/// - edge weights, int32 per edge, or double if any weight is not an integer,
+///   non-negative for conflict edges and negative for stitch edges as in the coloring algorithms;
+/// - precolors, int8 per vertex and negative if not precolored, only if any vertex is precolored.
+///
+/// Numbers are in the byte order of the writer, which is checked by the reader.
+/// A snapshot is opened by mapping the file into memory, and @ref graph builds any graph type of the coloring algorithms
+/// from the mapped arrays in one pass, e.g., boost::adjacency_list or @ref limbo::algorithms::CsrGraph.
+/// Edge ids are not kept, since edges are grouped by vertices.
+///
+/// @ref read_graphviz and @ref write_graphviz convert graphs written by limbo, e.g., the benchmarks in test/algorithms,
+/// with integer vertex names, weights in the weight or label attributes and precolors in the precolor attribute;
+/// they do not read the full DOT language.
+class GraphSnapshot
+{
+	public:
+		/// flags of the header
+		enum FlagType
+		{
+			PRECOLOR = 1, ///< precolors are stored
+			DOUBLE_WEIGHT = 2 ///< weights are doubles instead of int32
+		};
+		/// header at the beginning of a file
+		struct header_type
+		{
+			char magic[8]; ///< "LIMBOCG" with a null character
+			boost::uint32_t version; ///< version of the format
+			boost::uint32_t byte_order; ///< 0x01020304 in the byte order of the writer
+			boost::uint64_t num_vertices; ///< number of vertices
+			boost::uint64_t num_edges; ///< number of edges
+			boost::uint32_t flags; ///< combination of @ref FlagType
+			boost::uint32_t reserved; ///< zero
+		};
+
+		/// constructor
+		GraphSnapshot() : m_data(NULL), m_size(0), m_header(NULL), m_vOffset(NULL), m_vTarget(NULL), m_vIntWeight(NULL), m_vDoubleWeight(NULL), m_vPrecolor(NULL) {}
+		/// destructor
+		~GraphSnapshot() {close();}
+
+		/// write a snapshot of a graph
+		/// @tparam GraphType graph type with edge weights
+		/// @param filename output file
+		/// @param g graph
+		/// @param vPrecolor precolors of vertices, negative if not precolored, or empty
+		/// @return true if succeed
+		template <typename GraphType>
+		static bool write(std::string const& filename, GraphType const& g, std::vector<int8_t> const& vPrecolor = std::vector<int8_t>());
+		/// map a snapshot into memory and check its arrays
+		/// @param filename input file
+		/// @return true if succeed
+		bool open(std::string const& filename);
+		/// release the mapping
+		void close();
+
+		/// @return number of vertices
+		boost::uint32_t num_vertices() const {return (m_header)? m_header->num_vertices : 0;}
+		/// @return number of edges
+		boost::uint32_t num_edges() const {return (m_header)? m_header->num_edges : 0;}
+		/// @return true if precolors are stored
+		bool has_precolor() const {return m_vPrecolor != NULL;}
+		/// @param v vertex
+		/// @return begin of the edges with \a v as the smaller end
+		boost::uint64_t edge_begin(boost::uint32_t v) const {return m_vOffset[v];}
+		/// @param v vertex
+		/// @return end of the edges with \a v as the smaller end
+		boost::uint64_t edge_end(boost::uint32_t v) const {return m_vOffset[v+1];}
+		/// @param i edge
+		/// @return larger end of edge \a i
+		boost::uint32_t target(boost::uint64_t i) const {return m_vTarget[i];}
+		/// @param i edge
+		/// @return weight of edge \a i
+		double weight(boost::uint64_t i) const {return (m_vDoubleWeight)? m_vDoubleWeight[i] : m_vIntWeight[i];}
+		/// @param v vertex
+		/// @return precolor of \a v, negative if not precolored
+		int8_t precolor(boost::uint32_t v) const {return (m_vPrecolor)? m_vPrecolor[v] : -1;}
+
+		/// build a graph from the snapshot
+		/// @tparam GraphType graph type constructible from the number of vertices, with edge weights
+		/// @param g graph, replaced
+		template <typename GraphType>
+		void graph(GraphType& g) const;
+		/// @param vPrecolor precolors of vertices, negative if not precolored
+		void precolors(std::vector<int8_t>& vPrecolor) const;
+
+		/// read a graph in graphviz format written by limbo
+		/// @tparam GraphType graph type constructible from the number of vertices, with edge weights
+		/// @param filename input file
+		/// @param g graph, replaced
+		/// @param vPrecolor precolors of vertices, negative if not precolored
+		/// @return true if succeed
+		template <typename GraphType>
+		static bool read_graphviz(std::string const& filename, GraphType& g, std::vector<int8_t>& vPrecolor);
+		/// write a graph in graphviz format, in the way of the benchmarks in test/algorithms
+		/// @tparam GraphType graph type with edge weights
+		/// @param filename output file
+		/// @param g graph
+		/// @param vPrecolor precolors of vertices, negative if not precolored, or empty
+		/// @return true if succeed
+		template <typename GraphType>
+		static bool write_graphviz(std::string const& filename, GraphType const& g, std::vector<int8_t> const& vPrecolor = std::vector<int8_t>());
+
+	protected:
+		/// @brief copy constructor is not allowed
+		GraphSnapshot(GraphSnapshot const&);
+		/// @brief assignment is not allowed
+		GraphSnapshot& operator=(GraphSnapshot const&);
+
+		/// @param n number of bytes
+		/// @return \a n rounded up to a multiple of 8
+		static std::size_t align(std::size_t n) {return (n+7)&~(std::size_t)7;}
+		/// write an array padded to a multiple of 8 bytes
+		/// @param fp file
+		/// @param data array
+		/// @param n number of bytes
+		/// @return true if succeed
+		static bool write_padded(FILE* fp, void const* data, std::size_t n);
+		/// parse the attributes of a graphviz statement in brackets
+		/// @param p position after '['
+		/// @param end end of the text
+		/// @param weight weight from the weight or label attribute, unchanged if none
+		/// @param precolor precolor from the precolor attribute, unchanged if none
+		/// @return position after ']'
+		static char const* parse_attributes(char const* p, char const* end, double& weight, int& precolor);
+
+		char const* m_data; ///< start of the mapped file
+		std::size_t m_size; ///< number of bytes mapped
+		header_type const* m_header; ///< header in the mapped file
+		boost::uint64_t const* m_vOffset; ///< offsets of edges of vertices
+		boost::uint32_t const* m_vTarget; ///< larger ends of edges
+		boost::int32_t const* m_vIntWeight; ///< integer weights, NULL if weights are doubles
+		double const* m_vDoubleWeight; ///< double weights, NULL if weights are integers
+		int8_t const* m_vPrecolor; ///< precolors, NULL if not stored
+};
+
+template <typename GraphType>
+bool GraphSnapshot::write(std::string const& filename, GraphType const& g, std::vector<int8_t> const& vPrecolor)
+{
+	typedef typename boost::graph_traits<GraphType>::edge_iterator edge_iterator_type;
+	boost::uint32_t n = boost::num_vertices(g);
+	limboAssert(vPrecolor.empty() || vPrecolor.size() == n);
+
+	// group edges by their smaller ends by counting
+	std::vector<boost::uint64_t> vOffset (n+1, 0);
+	bool integral = true;
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+	{
+		boost::uint32_t s = boost::source(*ei, g);
+		boost::uint32_t t = boost::target(*ei, g);
+		++vOffset[std::min(s, t)+1];
+		double w = boost::get(boost::edge_weight, g, *ei);
+		integral = integral && w == std::floor(w) && std::abs(w) <= std::numeric_limits<boost::int32_t>::max();
+	}
+	for (boost::uint32_t v = 0; v < n; ++v)
+		vOffset[v+1] += vOffset[v];
+	boost::uint64_t m = vOffset[n];
+	std::vector<boost::uint64_t> vPos (vOffset.begin(), vOffset.end()-1);
+	std::vector<boost::uint32_t> vTarget (m);
+	std::vector<boost::int32_t> vIntWeight ((integral)? m : 0);
+	std::vector<double> vDoubleWeight ((integral)? 0 : m);
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+	{
+		boost::uint32_t s = boost::source(*ei, g);
+		boost::uint32_t t = boost::target(*ei, g);
+		boost::uint64_t i = vPos[std::min(s, t)]++;
+		vTarget[i] = std::max(s, t);
+		if (integral)
+			vIntWeight[i] = boost::get(boost::edge_weight, g, *ei);
+		else
+			vDoubleWeight[i] = boost::get(boost::edge_weight, g, *ei);
+	}
+	bool precolored = false;
+	for (boost::uint32_t v = 0; v < vPrecolor.size() && !precolored; ++v)
+		precolored = (vPrecolor[v] >= 0);
+
+	header_type header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, "LIMBOCG", 8);
+	header.version = 1;
+	header.byte_order = 0x01020304;
+	header.num_vertices = n;
+	header.num_edges = m;
+	header.flags = ((precolored)? PRECOLOR : 0) | ((integral)? 0 : DOUBLE_WEIGHT);
+
+	FILE* fp = fopen(filename.c_str(), "wb");
+	if (fp == NULL)
+		return false;
+	bool ok = write_padded(fp, &header, sizeof(header))
+		&& write_padded(fp, &vOffset[0], vOffset.size()*sizeof(boost::uint64_t))
+		&& write_padded(fp, (m)? &vTarget[0] : NULL, m*sizeof(boost::uint32_t))
+		&& ((integral)? write_padded(fp, (m)? &vIntWeight[0] : NULL, m*sizeof(boost::int32_t))
+				: write_padded(fp, &vDoubleWeight[0], m*sizeof(double)))
+		&& (!precolored || write_padded(fp, &vPrecolor[0], n));
+	return (fclose(fp) == 0) && ok;
+}
+
+inline bool GraphSnapshot::write_padded(FILE* fp, void const* data, std::size_t n)
+{
+	static char const zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	if (n && fwrite(data, 1, n, fp) != n)
+		return false;
+	return fwrite(zeros, 1, align(n)-n, fp) == align(n)-n;
+}
+
+inline bool GraphSnapshot::open(std::string const& filename)
+{
+	close();
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat sb;
+	if (fstat(fd, &sb) < 0 || !S_ISREG(sb.st_mode) || (std::size_t)sb.st_size < sizeof(header_type))
+	{
+		::close(fd);
+		return false;
+	}
+	void* addr = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping holds its own reference to the file
+	::close(fd);
+	if (addr == MAP_FAILED)
+		return false;
+#ifdef MADV_SEQUENTIAL
+	// arrays are read front to back when graphs are built
+	madvise(addr, sb.st_size, MADV_SEQUENTIAL);
+#endif
+	m_data = static_cast<char const*>(addr);
+	m_size = sb.st_size;
+
+	// the size of the file must match the header exactly
+	header_type const* header = reinterpret_cast<header_type const*>(m_data);
+	if (std::memcmp(header->magic, "LIMBOCG", 8) != 0 || header->version != 1 || header->byte_order != 0x01020304
+			|| header->num_vertices >= std::numeric_limits<boost::uint32_t>::max() || header->num_edges >= std::numeric_limits<boost::uint32_t>::max())
+	{
+		close();
+		return false;
+	}
+	boost::uint64_t n = header->num_vertices;
+	boost::uint64_t m = header->num_edges;
+	std::size_t pos = align(sizeof(header_type));
+	std::size_t offset_pos = pos;
+	pos += align((n+1)*sizeof(boost::uint64_t));
+	std::size_t target_pos = pos;
+	pos += align(m*sizeof(boost::uint32_t));
+	std::size_t weight_pos = pos;
+	pos += align(m*((header->flags & DOUBLE_WEIGHT)? sizeof(double) : sizeof(boost::int32_t)));
+	std::size_t precolor_pos = pos;
+	if (header->flags & PRECOLOR)
+		pos += align(n);
+	if (pos != m_size)
+	{
+		close();
+		return false;
+	}
+	m_header = header;
+	m_vOffset = reinterpret_cast<boost::uint64_t const*>(m_data+offset_pos);
+	m_vTarget = reinterpret_cast<boost::uint32_t const*>(m_data+target_pos);
+	if (header->flags & DOUBLE_WEIGHT)
+		m_vDoubleWeight = reinterpret_cast<double const*>(m_data+weight_pos);
+	else
+		m_vIntWeight = reinterpret_cast<boost::int32_t const*>(m_data+weight_pos);
+	if (header->flags & PRECOLOR)
+		m_vPrecolor = reinterpret_cast<int8_t const*>(m_data+precolor_pos);
+
+	// offsets and ends of edges are in range, so a corrupted file cannot make graphs out of bounds
+	bool valid = (m_vOffset[0] == 0 && m_vOffset[n] == m);
+	for (boost::uint64_t v = 0; v < n && valid; ++v)
+		valid = (m_vOffset[v] <= m_vOffset[v+1]);
+	for (boost::uint64_t i = 0; i < m && valid; ++i)
+		valid = (m_vTarget[i] < n);
+	if (!valid)
+		close();
+	return valid;
+}
+
+inline void GraphSnapshot::close()
+{
+	if (m_data)
+		munmap(const_cast<char*>(m_data), m_size);
+	m_data = NULL;
+	m_size = 0;
+	m_header = NULL;
+	m_vOffset = NULL;
+	m_vTarget = NULL;
+	m_vIntWeight = NULL;
+	m_vDoubleWeight = NULL;
+	m_vPrecolor = NULL;
+}
+
+template <typename GraphType>
+void GraphSnapshot::graph(GraphType& g) const
+{
+	typedef typename boost::property_traits<typename boost::property_map<GraphType, boost::edge_weight_t>::const_type>::value_type edge_weight_type;
+	boost::uint32_t n = this->num_vertices();
+	g = GraphType(n);
+	for (boost::uint32_t v = 0; v < n; ++v)
+		for (boost::uint64_t i = m_vOffset[v], ie = m_vOffset[v+1]; i != ie; ++i)
+			boost::put(boost::edge_weight, g, boost::add_edge(v, m_vTarget[i], g).first, (edge_weight_type)this->weight(i));
+}
+
+inline void GraphSnapshot::precolors(std::vector<int8_t>& vPrecolor) const
+{
+	vPrecolor.assign(this->num_vertices(), -1);
+	if (m_vPrecolor)
+		vPrecolor.assign(m_vPrecolor, m_vPrecolor+this->num_vertices());
+}
+
+inline char const* GraphSnapshot::parse_attributes(char const* p, char const* end, double& weight, int& precolor)
+{
+	bool has_weight = false;
+	while (p < end && *p != ']')
+	{
+		// key
+		while (p < end && (*p == ' ' || *p == '\t' || *p == ',' || *p == ';' || *p == '\n' || *p == '\r'))
+			++p;
+		char const* key = p;
+		while (p < end && *p != '=' && *p != ']' && *p != ',' && *p != ' ')
+			++p;
+		std::size_t key_len = p-key;
+		while (p < end && *p == ' ')
+			++p;
+		if (p >= end || *p != '=')
+			continue;
+		++p;
+		while (p < end && *p == ' ')
+			++p;
+		// value, possibly quoted
+		char const* value = p;
+		if (p < end && *p == '"')
+		{
+			value = ++p;
+			while (p < end && *p != '"')
+				++p;
+		}
+		else
+		{
+			while (p < end && *p != ',' && *p != ']' && *p != ';' && *p != ' ')
+				++p;
+		}
+		std::string text (value, p);
+		if (p < end && *p == '"')
+			++p;
+		if (key_len == 6 && std::strncmp(key, "weight", 6) == 0)
+		{
+			weight = std::atof(text.c_str());
+			has_weight = true;
+		}
+		else if (key_len == 5 && std::strncmp(key, "label", 5) == 0 && !has_weight)
+			weight = std::atof(text.c_str());
+		else if (key_len == 8 && std::strncmp(key, "precolor", 8) == 0)
+			precolor = std::atoi(text.c_str());
+	}
+	return (p < end)? p+1 : p;
+}
+
+template <typename GraphType>
+bool GraphSnapshot::read_graphviz(std::string const& filename, GraphType& g, std::vector<int8_t>& vPrecolor)
+{
+	typedef typename boost::property_traits<typename boost::property_map<GraphType, boost::edge_weight_t>::const_type>::value_type edge_weight_type;
+	// the text is read with a terminating null character for strtoul
+	std::vector<char> vText;
+	FILE* fp = fopen(filename.c_str(), "rb");
+	if (fp == NULL)
+		return false;
+	char buf[1<<16];
+	for (std::size_t count; (count = fread(buf, 1, sizeof(buf), fp)) > 0; )
+		vText.insert(vText.end(), buf, buf+count);
+	fclose(fp);
+	vText.push_back('\0');
+	char const* p = &vText[0];
+	char const* end = p+vText.size()-1;
+
+	// statements starting with a vertex name; graph, node and edge attributes are skipped
+	std::vector<std::pair<boost::uint32_t, boost::uint32_t> > vEdge;
+	std::vector<double> vWeight;
+	vPrecolor.clear();
+	boost::uint32_t n = 0;
+	while (p < end)
+	{
+		while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' || *p == ';'))
+			++p;
+		if (p >= end)
+			break;
+		if (*p < '0' || *p > '9')
+		{
+			while (p < end && *p != '\n')
+				++p;
+			continue;
+		}
+		char* next = NULL;
+		boost::uint32_t s = std::strtoul(p, &next, 10);
+		p = next;
+		while (p < end && (*p == ' ' || *p == '\t'))
+			++p;
+		bool is_edge = (p+1 < end && p[0] == '-' && p[1] == '-');
+		boost::uint32_t t = s;
+		if (is_edge)
+		{
+			p += 2;
+			while (p < end && (*p == ' ' || *p == '\t'))
+				++p;
+			if (p >= end || *p < '0' || *p > '9')
+				return false;
+			t = std::strtoul(p, &next, 10);
+			p = next;
+			while (p < end && (*p == ' ' || *p == '\t'))
+				++p;
+		}
+		double weight = 1;
+		int precolor = -1;
+		if (p < end && *p == '[')
+			p = parse_attributes(p+1, end, weight, precolor);
+		n = std::max(n, std::max(s, t)+1);
+		if (is_edge)
+		{
+			vEdge.push_back(std::make_pair(s, t));
+			vWeight.push_back(weight);
+		}
+		else if (precolor >= 0)
+		{
+			if (vPrecolor.size() <= s)
+				vPrecolor.resize(s+1, -1);
+			vPrecolor[s] = precolor;
+		}
+	}
+	vPrecolor.resize(n, -1);
+	g = GraphType(n);
+	for (std::size_t i = 0; i < vEdge.size(); ++i)
+		boost::put(boost::edge_weight, g, boost::add_edge(vEdge[i].first, vEdge[i].second, g).first, (edge_weight_type)vWeight[i]);
+	return true;
+}
+
+template <typename GraphType>
+bool GraphSnapshot::write_graphviz(std::string const& filename, GraphType const& g, std::vector<int8_t> const& vPrecolor)
+{
+	typedef typename boost::graph_traits<GraphType>::edge_iterator edge_iterator_type;
+	FILE* fp = fopen(filename.c_str(), "w");
+	if (fp == NULL)
+		return false;
+	boost::uint32_t n = boost::num_vertices(g);
+	fprintf(fp, "graph G {\n");
+	for (boost::uint32_t v = 0; v < n; ++v)
+	{
+		if (v < vPrecolor.size() && vPrecolor[v] >= 0)
+			fprintf(fp, "%u [label=%u, node_id=%u, precolor=%d];\n", v, v, v, (int)vPrecolor[v]);
+		else
+			fprintf(fp, "%u [label=%u, node_id=%u];\n", v, v, v);
+	}
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+	{
+		double w = boost::get(boost::edge_weight, g, *ei);
+		fprintf(fp, "%u--%u  [label=%.17g, weight=%.17g];\n", (boost::uint32_t)boost::source(*ei, g), (boost::uint32_t)boost::target(*ei, g), w, w);
+	}
+	fprintf(fp, "}\n");
+	return fclose(fp) == 0;
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
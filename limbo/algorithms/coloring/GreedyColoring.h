@@ -18,7 +18,13 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <algorithm>
+#include <sched.h>
+#include <boost/cstdint.hpp>
 #include <boost/graph/graph_concepts.hpp>
+#include <boost/graph/iteration_macros.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/algorithms/CsrGraph.h>
 using std::cout;
 using std::endl;
 using std::vector;
@@ -169,6 +175,318 @@ class DsatColoring
 
 };
 
+/// @class limbo::algorithms::coloring::BucketDsatColoring
+/// Coloring a graph with saturation degree based heuristics like @ref DsatColoring, 
+/// with neighbor colors in bitmasks of vertices and uncolored vertices in buckets of saturation degrees. 
+/// Each bucket is a heap by degrees with stale entries skipped when popped, 
+/// so a vertex is pushed once and once more for each increase of its saturation degree, 
+/// which takes O((n+m) log n) time in total. 
+/// Ties of degrees are broken by smaller vertex indices. 
+/// @tparam GraphType graph type with vertex_index property 
+template <typename GraphType>
+class BucketDsatColoring
+{
+	public:
+        /// @nowarn 
+		typedef GraphType graph_type;
+		typedef typename boost::graph_traits<graph_type>::vertex_descriptor graph_vertex_type;
+        /// @endnowarn
+
+        /// constructor 
+        /// @param g graph 
+		BucketDsatColoring(graph_type const& g) : m_graph(g), m_vColor(boost::num_vertices(g), -1) {}
+
+        /// get color of vertex 
+        /// @param v vertex 
+        /// @return color 
+		int color(graph_vertex_type v) const {return m_vColor[boost::get(boost::vertex_index, m_graph, v)];}
+        /// @return colors indexed by vertex_index 
+		vector<int> const& colors() const {return m_vColor;}
+
+        /// API to run the algorithm 
+        /// @return number of colors 
+		int operator()();
+
+	protected:
+		/// an entry of a bucket, larger degrees and then smaller vertices first 
+		typedef std::pair<boost::uint32_t, boost::int64_t> entry_type;
+
+		graph_type const& m_graph; ///< graph 
+		vector<int> m_vColor; ///< color of each vertex 
+};
+
+template <typename GraphType>
+int BucketDsatColoring<GraphType>::operator()()
+{
+	boost::uint32_t n = boost::num_vertices(m_graph);
+	// flat adjacency without self loops 
+	vector<boost::uint32_t> vOffset (n+1, 0);
+	vector<boost::uint32_t> vAdj;
+	typename boost::graph_traits<graph_type>::vertex_iterator vi, vie;
+	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
+	{
+		boost::uint32_t v = boost::get(boost::vertex_index, m_graph, *vi);
+		typename boost::graph_traits<graph_type>::adjacency_iterator ai, aie;
+		for (boost::tie(ai, aie) = boost::adjacent_vertices(*vi, m_graph); ai != aie; ++ai)
+			if (*ai != *vi)
+				++vOffset[v+1];
+	}
+	for (boost::uint32_t v = 0; v < n; ++v)
+		vOffset[v+1] += vOffset[v];
+	vAdj.resize(vOffset[n]);
+	vector<boost::uint32_t> vPos (vOffset.begin(), vOffset.end()-1);
+	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
+	{
+		boost::uint32_t v = boost::get(boost::vertex_index, m_graph, *vi);
+		typename boost::graph_traits<graph_type>::adjacency_iterator ai, aie;
+		for (boost::tie(ai, aie) = boost::adjacent_vertices(*vi, m_graph); ai != aie; ++ai)
+			if (*ai != *vi)
+				vAdj[vPos[v]++] = boost::get(boost::vertex_index, m_graph, *ai);
+	}
+
+	// neighbor colors in words per vertex, widened when colors run out of them 
+	boost::uint32_t words = 1;
+	vector<boost::uint64_t> vMask (n, 0);
+	vector<boost::uint32_t> vSaturation (n, 0);
+	vector<vector<entry_type> > vBucket (1);
+	m_vColor.assign(n, -1);
+	for (boost::uint32_t v = 0; v < n; ++v)
+		vBucket[0].push_back(entry_type(vOffset[v+1]-vOffset[v], -(boost::int64_t)v));
+	std::make_heap(vBucket[0].begin(), vBucket[0].end());
+
+	int color_cnt = 0;
+	boost::uint32_t top = 0; // highest bucket that may be non-empty 
+	for (boost::uint32_t numColored = 0; numColored < n; ++numColored)
+	{
+		// pop the vertex with the largest saturation degree and then degree 
+		boost::uint32_t v = 0;
+		while (true)
+		{
+			vector<entry_type>& bucket = vBucket[top];
+			if (bucket.empty())
+			{
+				--top;
+				continue;
+			}
+			std::pop_heap(bucket.begin(), bucket.end());
+			v = -bucket.back().second;
+			bucket.pop_back();
+			if (m_vColor[v] < 0 && vSaturation[v] == top)
+				break;
+		}
+
+		// the smallest color not used by neighbors 
+		boost::uint64_t const* mask = &vMask[(size_t)v*words];
+		boost::uint32_t w = 0;
+		while (w < words && mask[w] == ~(boost::uint64_t)0)
+			++w;
+		int c = (w < words)? (w<<6)+__builtin_ctzll(~mask[w]) : (words<<6);
+		m_vColor[v] = c;
+		color_cnt = std::max(color_cnt, c+1);
+		if ((boost::uint32_t)c >= (words<<6))
+		{
+			vector<boost::uint64_t> vWider ((size_t)n*words*2, 0);
+			for (boost::uint32_t u = 0; u < n; ++u)
+				std::copy(vMask.begin()+(size_t)u*words, vMask.begin()+(size_t)(u+1)*words, vWider.begin()+(size_t)u*words*2);
+			vMask.swap(vWider);
+			words *= 2;
+		}
+
+		// neighbors seeing a new color move up a bucket 
+		for (boost::uint32_t i = vOffset[v]; i < vOffset[v+1]; ++i)
+		{
+			boost::uint32_t u = vAdj[i];
+			if (m_vColor[u] >= 0)
+				continue;
+			boost::uint64_t& word = vMask[(size_t)u*words+(c>>6)];
+			boost::uint64_t bit = (boost::uint64_t)1<<(c&63);
+			if (word&bit)
+				continue;
+			word |= bit;
+			boost::uint32_t sat = ++vSaturation[u];
+			if (sat >= vBucket.size())
+				vBucket.resize(sat+1);
+			vBucket[sat].push_back(entry_type(vOffset[u+1]-vOffset[u], -(boost::int64_t)u));
+			std::push_heap(vBucket[sat].begin(), vBucket[sat].end());
+			top = std::max(top, sat);
+		}
+	}
+	return color_cnt;
+}
+
+/// @class limbo::algorithms::coloring::ParallelGreedyColoring
+/// Greedy coloring in the way of Jones and Plassmann, 
+/// "A Parallel Graph Coloring Heuristic", 
+/// SIAM J. Sci. Comput., 1993, 
+/// with priorities of larger degrees first and hashed vertex indices for ties. 
+/// A vertex is colored once all neighbors of higher priorities are colored, 
+/// with the smallest color not used by them. 
+/// Vertices ready to be colored are taken by threads from a shared queue without rounds. 
+/// Colors are the same as greedy coloring in the order of priorities, regardless of the number of threads. 
+/// @tparam GraphType graph type with vertex_index property 
+template <typename GraphType>
+class ParallelGreedyColoring
+{
+	public:
+        /// @nowarn 
+		typedef GraphType graph_type;
+		typedef typename boost::graph_traits<graph_type>::vertex_descriptor graph_vertex_type;
+        /// @endnowarn
+
+        /// constructor 
+        /// @param g graph 
+		ParallelGreedyColoring(graph_type const& g) : m_graph(g), m_vColor(boost::num_vertices(g), -1), m_threads(1) {}
+
+		/// set number of threads 
+        /// @param t number of threads 
+		void threads(boost::int32_t t) {m_threads = t;}
+        /// get color of vertex 
+        /// @param v vertex 
+        /// @return color 
+		int color(graph_vertex_type v) const {return m_vColor[boost::get(boost::vertex_index, m_graph, v)];}
+        /// @return colors indexed by vertex_index 
+		vector<int> const& colors() const {return m_vColor;}
+
+        /// API to run the algorithm 
+        /// @return number of colors 
+		int operator()();
+
+	protected:
+		/// @param v vertex 
+		/// @return hashed vertex index for ties of degrees 
+		static boost::uint32_t hash(boost::uint32_t v) 
+		{
+			v ^= v>>16; v *= 0x7feb352d; 
+			v ^= v>>15; v *= 0x846ca68b; 
+			return v^(v>>16);
+		}
+		/// @return true if \a u is colored before \a v 
+		bool before(boost::uint32_t u, boost::uint32_t v) const
+		{
+			boost::uint32_t du = m_vOffset[u+1]-m_vOffset[u];
+			boost::uint32_t dv = m_vOffset[v+1]-m_vOffset[v];
+			if (du != dv) return du > dv;
+			boost::uint32_t hu = hash(u), hv = hash(v);
+			return (hu != hv)? hu > hv : u < v;
+		}
+		/// color the vertices in a range of slots of the queue, waiting for each slot to be written 
+		/// @param first first slot 
+		/// @param last end slot 
+		void color_ready(boost::uint32_t first, boost::uint32_t last);
+		/// slots of the queue run by limbo::containers::parallel_for 
+		struct ReadyKernel
+		{
+			ParallelGreedyColoring* solver; ///< coloring object 
+			/// @param b first slot 
+			/// @param e end slot 
+			void operator()(std::size_t b, std::size_t e) const {solver->color_ready(b, e);}
+		};
+
+		graph_type const& m_graph; ///< graph 
+		vector<int> m_vColor; ///< color of each vertex 
+		boost::int32_t m_threads; ///< number of threads 
+
+		vector<boost::uint32_t> m_vOffset; ///< offset of neighbors of each vertex 
+		vector<boost::uint32_t> m_vAdj; ///< neighbors without self loops 
+		vector<boost::uint32_t> m_vWait; ///< number of uncolored neighbors of higher priorities 
+		vector<boost::uint32_t> m_vQueue; ///< vertices ready to be colored, n for slots not written yet 
+		boost::uint32_t m_tail; ///< next slot to write in the queue 
+};
+
+template <typename GraphType>
+int ParallelGreedyColoring<GraphType>::operator()()
+{
+	boost::uint32_t n = boost::num_vertices(m_graph);
+	m_vOffset.assign(n+1, 0);
+	typename boost::graph_traits<graph_type>::vertex_iterator vi, vie;
+	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
+	{
+		boost::uint32_t v = boost::get(boost::vertex_index, m_graph, *vi);
+		typename boost::graph_traits<graph_type>::adjacency_iterator ai, aie;
+		for (boost::tie(ai, aie) = boost::adjacent_vertices(*vi, m_graph); ai != aie; ++ai)
+			if (*ai != *vi)
+				++m_vOffset[v+1];
+	}
+	for (boost::uint32_t v = 0; v < n; ++v)
+		m_vOffset[v+1] += m_vOffset[v];
+	m_vAdj.resize(m_vOffset[n]);
+	vector<boost::uint32_t> vPos (m_vOffset.begin(), m_vOffset.end()-1);
+	for (boost::tie(vi, vie) = boost::vertices(m_graph); vi != vie; ++vi)
+	{
+		boost::uint32_t v = boost::get(boost::vertex_index, m_graph, *vi);
+		typename boost::graph_traits<graph_type>::adjacency_iterator ai, aie;
+		for (boost::tie(ai, aie) = boost::adjacent_vertices(*vi, m_graph); ai != aie; ++ai)
+			if (*ai != *vi)
+				m_vAdj[vPos[v]++] = boost::get(boost::vertex_index, m_graph, *ai);
+	}
+
+	m_vColor.assign(n, -1);
+	m_vWait.assign(n, 0);
+	m_vQueue.assign(n, n);
+	m_tail = 0;
+	for (boost::uint32_t v = 0; v < n; ++v)
+	{
+		for (boost::uint32_t i = m_vOffset[v]; i < m_vOffset[v+1]; ++i)
+			m_vWait[v] += before(m_vAdj[i], v);
+		if (m_vWait[v] == 0)
+			m_vQueue[m_tail++] = v;
+	}
+
+	boost::int32_t numThreads = std::min((boost::int32_t)limbo::containers::num_threads(), m_threads);
+	numThreads = std::max(std::min(numThreads, (boost::int32_t)n), 1);
+	// slots are taken in increasing order and the lowest slot not colored is always written eventually, 
+	// so a thread waiting for a slot of its block does not block the others 
+	ReadyKernel kernel = {this};
+	limbo::containers::parallel_for(0, n, 64, numThreads, kernel);
+
+	int color_cnt = 0;
+	for (boost::uint32_t v = 0; v < n; ++v)
+		color_cnt = std::max(color_cnt, m_vColor[v]+1);
+	vector<boost::uint32_t>().swap(m_vWait);
+	vector<boost::uint32_t>().swap(m_vQueue);
+	return color_cnt;
+}
+
+template <typename GraphType>
+void ParallelGreedyColoring<GraphType>::color_ready(boost::uint32_t first, boost::uint32_t last)
+{
+	boost::uint32_t n = m_vColor.size();
+	vector<boost::uint32_t> vMark; // vMark[c] == v+1 if color c is used by a neighbor of v 
+	for (boost::uint32_t slot = first; slot < last; ++slot)
+	{
+		// wait until the slot is written, a vertex is always ready while some are uncolored 
+		boost::uint32_t v;
+		while ((v = *(volatile boost::uint32_t*)&m_vQueue[slot]) == n)
+			sched_yield();
+
+		boost::uint32_t degree = m_vOffset[v+1]-m_vOffset[v];
+		if (vMark.size() < degree+1)
+			vMark.resize(degree+1, 0);
+		for (boost::uint32_t i = m_vOffset[v]; i < m_vOffset[v+1]; ++i)
+		{
+			boost::uint32_t u = m_vAdj[i];
+			int c = *(volatile int*)&m_vColor[u];
+			if (c >= 0 && (boost::uint32_t)c <= degree && before(u, v))
+				vMark[c] = v+1;
+		}
+		int c = 0;
+		while (vMark[c] == v+1)
+			++c;
+		m_vColor[v] = c;
+		__sync_synchronize();
+
+		for (boost::uint32_t i = m_vOffset[v]; i < m_vOffset[v+1]; ++i)
+		{
+			boost::uint32_t u = m_vAdj[i];
+			if (before(v, u) && __sync_sub_and_fetch(&m_vWait[u], 1) == 0)
+			{
+				boost::uint32_t tail = __sync_fetch_and_add(&m_tail, 1);
+				*(volatile boost::uint32_t*)&m_vQueue[tail] = u;
+			}
+		}
+	}
+}
+
 } // namespace coloring
 } // namespace algorithms
 } // namespace limbo
@@ -30,7 +30,10 @@
 //#include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <limbo/string/String.h>
 #include <limbo/algorithms/coloring/Coloring.h>
+#include <limbo/algorithms/coloring/BipartiteColoring.h>
+#include <limbo/algorithms/coloring/GreedyColoring.h>
 #include <limbo/solvers/Solvers.h>
+#include <limbo/solvers/Presolve.h>
 #include <limbo/solvers/api/GurobiApi.h>
 
 /// namespace for Limbo 
@@ -49,6 +52,17 @@ namespace coloring
 /// Non-negative weight implies conflict edge, 
 /// while negative weight implies stitch edge. 
 /// 
+/// The improved formulation, see @ref improved_formulation, targets graphs whose full model is slow to solve. 
+/// - Colors are symmetric without precolored vertices, so the i-th vertex of a clique of conflict edges 
+///   takes a color no larger than i, and the first vertex is fixed, 
+///   which removes the solutions that only permute colors. 
+///   This is valid for any solution, even if the clique has conflicts. 
+/// - Constraints of conflict edges are added lazily by the callback of Gurobi at integer solutions 
+///   that color both ends of an edge the same without paying for it. 
+///   The model then refers to all variables, so it is solved without @ref limbo::solvers::Presolver. 
+/// - The solver starts from a solution of @ref limbo::algorithms::coloring::BucketDsatColoring, 
+///   with colors beyond the number of colors replaced by the cheapest ones. 
+/// 
 /// @tparam GraphType graph type 
 template <typename GraphType>
 class ILPColoring : public Coloring<GraphType>
@@ -66,16 +80,26 @@ class ILPColoring : public Coloring<GraphType>
         typedef typename base_type::EdgeHashType edge_hash_type;
         typedef limbo::solvers::LinearModel<float, int32_t> model_type; 
         typedef limbo::solvers::GurobiLinearApi<model_type::coefficient_value_type, model_type::variable_value_type> solver_type; 
+        typedef limbo::solvers::Presolver<model_type::coefficient_value_type, model_type::variable_value_type> presolver_type; 
+        typedef model_type::variable_type variable_type; 
+        typedef model_type::constraint_type constraint_type; 
         /// @endnowarn
         
 		/// constructor
         /// @param g graph 
 		ILPColoring(graph_type const& g) 
 			: base_type(g)
+			, m_improved(false)
 		{}
 		/// destructor
 		virtual ~ILPColoring() {}
 
+        /// @brief use the improved formulation with symmetry breaking, lazy conflict constraints and a warm start 
+        /// @param v true to enable, false by default 
+        void improved_formulation(bool v) {m_improved = v;}
+        /// @return true if the improved formulation is used 
+        bool improved_formulation() const {return m_improved;}
+
         /// write raw solution of ILP 
         /// @param filename output file name 
         /// @param opt_model problem model 
@@ -83,14 +107,77 @@ class ILPColoring : public Coloring<GraphType>
         void write_graph_sol(string const& filename, model_type const& opt_model, std::vector<model_type::variable_type> const& vVertexBit) const;
 
 	protected:
+        /// @brief conflict edges whose constraints are separated at integer solutions 
+        class lazy_conflict_type : public limbo::solvers::GurobiLazyConstraints<model_type::coefficient_value_type, model_type::variable_value_type>
+        {
+            public:
+                /// @brief constructor 
+                /// @param vVertexBit two bits of each vertex 
+                /// @param vEdgeBit bit of each edge 
+                lazy_conflict_type(std::vector<variable_type> const& vVertexBit, std::vector<variable_type> const& vEdgeBit) 
+                    : m_vVertexBit(vVertexBit)
+                    , m_vEdgeBit(vEdgeBit)
+                {}
+                /// @brief add a conflict edge 
+                /// @param s, t vertices 
+                /// @param edge_idx index of the edge 
+                void add(uint32_t s, uint32_t t, uint32_t edge_idx) 
+                {
+                    m_vEdge.push_back(edge_type(s, t, edge_idx)); 
+                    m_vAdded.push_back(false); 
+                }
+                /// @brief constraints of the edges whose ends take the same color without setting the edge bit 
+                /// @param vSolution value of each variable 
+                /// @param vConstraint constraints to add 
+                virtual void operator()(std::vector<double> const& vSolution, std::vector<constraint_type>& vConstraint); 
+            protected:
+                /// @brief two vertices and the index of a conflict edge 
+                struct edge_type 
+                {
+                    uint32_t s; ///< source 
+                    uint32_t t; ///< target 
+                    uint32_t edge_idx; ///< index of edge 
+                    /// @brief constructor 
+                    edge_type(uint32_t ss, uint32_t tt, uint32_t e) : s(ss), t(tt), edge_idx(e) {}
+                };
+                /// @param vSolution value of each variable 
+                /// @param v vertex 
+                /// @return color of a vertex 
+                int8_t color(std::vector<double> const& vSolution, uint32_t v) const 
+                {
+                    return ((vSolution[m_vVertexBit[v<<1].id()] > 0.5)<<1) + (vSolution[m_vVertexBit[(v<<1)+1].id()] > 0.5); 
+                }
+
+                std::vector<variable_type> const& m_vVertexBit; ///< two bits of each vertex 
+                std::vector<variable_type> const& m_vEdgeBit; ///< bit of each edge 
+                std::vector<edge_type> m_vEdge; ///< lazy edges 
+                std::vector<char> m_vAdded; ///< whether the constraints of each lazy edge have been added 
+        };
+
         /// kernel coloring algorithm 
 		/// @return objective value 
 		virtual double coloring();
+        /// @brief constraints of a conflict edge, which force the edge bit to 1 if both ends take the same color 
+        /// @param vBit1 two bits of the first vertex 
+        /// @param vBit2 two bits of the second vertex 
+        /// @param edgeBit bit of the edge 
+        /// @param vConstraint four constraints are appended 
+        static void conflict_constraints(variable_type const* vBit1, variable_type const* vBit2, variable_type const& edgeBit, std::vector<constraint_type>& vConstraint); 
+        /// @brief initial solution by saturation degrees, with colors relabeled by their first appearance on the clique 
+        /// @param vClique clique for symmetry breaking, empty if colors are not symmetric 
+        /// @param vColor initial color of each vertex 
+        void initial_coloring(std::vector<graph_vertex_type> const& vClique, std::vector<int8_t>& vColor) const; 
+
+        bool m_improved; ///< whether use the improved formulation 
 };
 
 template <typename GraphType>
 double ILPColoring<GraphType>::coloring()
 {
+	// two colors without violations are found in linear time 
+	if (this->m_color_num == base_type::TWO && bipartite_coloring(this->m_graph, this->m_stitch_weight, this->m_vColor))
+		return 0;
+
 	uint32_t vertex_num = boost::num_vertices(this->m_graph);
 	uint32_t edge_num = boost::num_edges(this->m_graph);
 	uint32_t vertex_variable_num = vertex_num<<1;
@@ -102,11 +189,23 @@ double ILPColoring<GraphType>::coloring()
 	for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei, ++cnt)
 		hEdgeIdx[*ei] = cnt;
 
+	// colors are symmetric without precolored vertices, 
+	// so the i-th vertex of a clique takes a color no larger than i 
+	std::vector<graph_vertex_type> vClique; 
+	std::vector<int8_t> vMaxColor (vertex_num, (int8_t)(this->m_color_num-1)); 
+	if (m_improved && !this->has_precolored())
+	{
+		this->symmetry_clique(vClique); 
+		for (uint32_t i = 0; i < vClique.size(); ++i)
+			vMaxColor[vClique[i]] = std::min(vMaxColor[vClique[i]], (int8_t)i); 
+	}
+
 	/// ILP model 
     model_type opt_model;
     limbo::solvers::GurobiParameters gurobiParams; 
     gurobiParams.setOutputFlag(0); 
     gurobiParams.setNumThreads(this->m_threads);
+    gurobiParams.setTimeLimit(this->m_time_limit); // the best solution so far, or the start, at the limit 
 	//set up the ILP variables
     std::vector<model_type::variable_type> vVertexBit;
     std::vector<model_type::variable_type> vEdgeBit;
@@ -131,8 +230,8 @@ double ILPColoring<GraphType>::coloring()
 			else color_bit = this->m_vColor[vertex_idx]&1;
 			vVertexBit.push_back(opt_model.addVariable(color_bit, color_bit, limbo::solvers::INTEGER, oss.str()));
 		}
-		else // uncolored 
-			vVertexBit.push_back(opt_model.addVariable(0, 1, limbo::solvers::INTEGER, oss.str()));
+		else // uncolored, the high bit is 0 for colors below 2, e.g., two colors, and the low bit for color 0 
+			vVertexBit.push_back(opt_model.addVariable(0, (vMaxColor[vertex_idx] >= (((i&1) == 0)? 2 : 1)), limbo::solvers::INTEGER, oss.str()));
 	}
 
 	// edge variables 
@@ -159,6 +258,11 @@ double ILPColoring<GraphType>::coloring()
 
 	// set up the constraints
 	uint32_t constr_num = 0;
+	std::vector<char> vInClique (vertex_num, false); 
+	for (uint32_t i = 0; i < vClique.size(); ++i)
+		vInClique[vClique[i]] = true; 
+	lazy_conflict_type lazy (vVertexBit, vEdgeBit); 
+	std::vector<constraint_type> vConstraint; 
 	for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
 	{
 		graph_vertex_type s = boost::source(*ei, this->m_graph);
@@ -174,34 +278,20 @@ double ILPColoring<GraphType>::coloring()
 		string tmpConstr_name;
 		if (w >= 0) // constraints for conflict edges 
 		{
-			sprintf(buf, "R%u", constr_num++);  
-			opt_model.addConstraint(
-					vVertexBit[vertex_idx1] + vVertexBit[vertex_idx1+1] 
-					+ vVertexBit[vertex_idx2] + vVertexBit[vertex_idx2+1] 
-					+ vEdgeBit[edge_idx] >= 1
-					, buf);
-
-			sprintf(buf, "R%u", constr_num++);  
-			opt_model.addConstraint(
-					- vVertexBit[vertex_idx1] + vVertexBit[vertex_idx1+1] 
-					- vVertexBit[vertex_idx2] + vVertexBit[vertex_idx2+1] 
-					+ vEdgeBit[edge_idx] >= -1
-					, buf);
-
-			sprintf(buf, "R%u", constr_num++);  
-			opt_model.addConstraint(
-					vVertexBit[vertex_idx1] - vVertexBit[vertex_idx1+1] 
-					+ vVertexBit[vertex_idx2] - vVertexBit[vertex_idx2+1] 
-					+ vEdgeBit[edge_idx] >= -1
-					, buf);
-
-			sprintf(buf, "R%u", constr_num++);  
-			opt_model.addConstraint(
-					- vVertexBit[vertex_idx1] - vVertexBit[vertex_idx1+1] 
-					- vVertexBit[vertex_idx2] - vVertexBit[vertex_idx2+1] 
-					+ vEdgeBit[edge_idx] >= -3
-					, buf);
-
+			// conflict edges cost nothing if their weights are 0, and others are lazy except those in the clique 
+			if (m_improved && (w == 0 || !vInClique[s] || !vInClique[t]))
+			{
+				if (w > 0)
+					lazy.add(s, t, edge_idx); 
+				continue; 
+			}
+			vConstraint.clear(); 
+			conflict_constraints(&vVertexBit[vertex_idx1], &vVertexBit[vertex_idx2], vEdgeBit[edge_idx], vConstraint); 
+			for (typename std::vector<constraint_type>::const_iterator it = vConstraint.begin(); it != vConstraint.end(); ++it)
+			{
+				sprintf(buf, "R%u", constr_num++);  
+				opt_model.addConstraint(*it, buf);
+			}
 		}
 		else // constraints for stitch edges 
 		{
@@ -227,7 +317,7 @@ double ILPColoring<GraphType>::coloring()
 		}
 	}
 
-	// additional constraints for 3-coloring 
+	// additional constraints for 3-coloring, or for vertices of the clique limited to 3 colors 
 	if (this->m_color_num == base_type::THREE)
 	{
 		char buf[100];
@@ -237,10 +327,66 @@ double ILPColoring<GraphType>::coloring()
 			opt_model.addConstraint(vVertexBit[k] + vVertexBit[k+1] <= 1, buf);
 		}
 	}
+	else if (this->m_color_num == base_type::FOUR)
+	{
+		char buf[100];
+		for (uint32_t i = 0; i < vClique.size(); ++i)
+		{
+			if (vMaxColor[vClique[i]] != 2)
+				continue; 
+			sprintf(buf, "R%u", constr_num++);  
+			opt_model.addConstraint(vVertexBit[vClique[i]<<1] + vVertexBit[(vClique[i]<<1)+1] <= 1, buf);
+		}
+	}
+
+	// start from a greedy solution 
+	if (m_improved)
+	{
+		std::vector<int8_t> vInitColor; 
+		this->initial_coloring(vClique, vInitColor); 
+		for (uint32_t v = 0; v < vertex_num; ++v)
+		{
+			opt_model.setVariableSolution(vVertexBit[v<<1], (vInitColor[v]>>1)&1); 
+			opt_model.setVariableSolution(vVertexBit[(v<<1)+1], vInitColor[v]&1); 
+		}
+		for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
+		{
+			bool same = (vInitColor[boost::source(*ei, this->m_graph)] == vInitColor[boost::target(*ei, this->m_graph)]); 
+			bool violated = (boost::get(boost::edge_weight, this->m_graph, *ei) >= 0)? same : !same; 
+			opt_model.setVariableSolution(vEdgeBit[hEdgeIdx[*ei]], violated); 
+		}
+	}
 
 	//optimize model 
-    solver_type solver (&opt_model); 
-    int32_t opt_status = solver(&gurobiParams); 
+    if (this->m_collect_statistics)
+    {
+        this->m_statistics.num_variables = opt_model.numVariables();
+        this->m_statistics.num_constraints = opt_model.constraints().size();
+    }
+    int32_t opt_status = limbo::solvers::INFEASIBLE; 
+    // lazy constraints refer to variables of the full model, which is presolved by Gurobi itself 
+    if (m_improved)
+    {
+        solver_type solver (&opt_model, limbo::solvers::GurobiThreadEnv::get()); 
+        solver.setLazyConstraints(&lazy); 
+        opt_status = solver(&gurobiParams); 
+        if (this->m_collect_statistics)
+            this->m_statistics.num_constraints += solver.numLazyConstraints(); 
+    }
+    else // precolored vertices and their edges are reduced before the solver 
+    {
+        presolver_type presolver (&opt_model); 
+        if (presolver())
+        {
+            opt_status = limbo::solvers::OPTIMAL; 
+            if (!presolver.solved())
+            {
+                solver_type solver (&presolver.reducedModel(), limbo::solvers::GurobiThreadEnv::get()); 
+                opt_status = solver(&gurobiParams); 
+            }
+            presolver.postsolve(); 
+        }
+    }
 #ifdef DEBUG_ILPCOLORING
 	opt_model.print("graph.lp");
 	opt_model.printSolution("graph.sol");
@@ -272,6 +418,86 @@ double ILPColoring<GraphType>::coloring()
 	return opt_model.evaluateObjective();
 }
 
+template <typename GraphType>
+void ILPColoring<GraphType>::conflict_constraints(typename ILPColoring<GraphType>::variable_type const* vBit1, typename ILPColoring<GraphType>::variable_type const* vBit2, 
+        typename ILPColoring<GraphType>::variable_type const& edgeBit, std::vector<typename ILPColoring<GraphType>::constraint_type>& vConstraint)
+{
+    vConstraint.push_back(vBit1[0] + vBit1[1] + vBit2[0] + vBit2[1] + edgeBit >= 1); 
+    vConstraint.push_back(- vBit1[0] + vBit1[1] - vBit2[0] + vBit2[1] + edgeBit >= -1); 
+    vConstraint.push_back(vBit1[0] - vBit1[1] + vBit2[0] - vBit2[1] + edgeBit >= -1); 
+    vConstraint.push_back(- vBit1[0] - vBit1[1] - vBit2[0] - vBit2[1] + edgeBit >= -3); 
+}
+
+template <typename GraphType>
+void ILPColoring<GraphType>::lazy_conflict_type::operator()(std::vector<double> const& vSolution, std::vector<typename ILPColoring<GraphType>::constraint_type>& vConstraint)
+{
+    for (uint32_t i = 0, ie = m_vEdge.size(); i < ie; ++i)
+    {
+        edge_type const& e = m_vEdge[i]; 
+        if (m_vAdded[i] || vSolution[m_vEdgeBit[e.edge_idx].id()] > 0.5 || color(vSolution, e.s) != color(vSolution, e.t))
+            continue; 
+        conflict_constraints(&m_vVertexBit[e.s<<1], &m_vVertexBit[e.t<<1], m_vEdgeBit[e.edge_idx], vConstraint); 
+        m_vAdded[i] = true; 
+    }
+}
+
+template <typename GraphType>
+void ILPColoring<GraphType>::initial_coloring(std::vector<typename ILPColoring<GraphType>::graph_vertex_type> const& vClique, std::vector<int8_t>& vColor) const
+{
+    typedef typename boost::graph_traits<graph_type>::out_edge_iterator out_edge_iterator_type; 
+    uint32_t vertex_num = boost::num_vertices(this->m_graph); 
+    int8_t color_num = this->m_color_num; 
+    BucketDsatColoring<graph_type> dc (this->m_graph); 
+    dc(); 
+    vColor.resize(vertex_num); 
+    for (uint32_t v = 0; v < vertex_num; ++v)
+    {
+        if (this->m_vColor[v] >= 0 && this->m_vColor[v] < color_num) // precolored 
+            vColor[v] = this->m_vColor[v]; 
+        else 
+            vColor[v] = (dc.color(v) < color_num)? dc.color(v) : -1; 
+    }
+    // vertices beyond the number of colors take the cheapest color against their colored neighbors 
+    std::vector<double> vCost (color_num); 
+    for (uint32_t v = 0; v < vertex_num; ++v)
+    {
+        if (vColor[v] >= 0)
+            continue; 
+        std::fill(vCost.begin(), vCost.end(), 0); 
+        out_edge_iterator_type oi, oie; 
+        for (boost::tie(oi, oie) = boost::out_edges(v, this->m_graph); oi != oie; ++oi)
+        {
+            int8_t c = vColor[boost::target(*oi, this->m_graph)]; 
+            if (c < 0)
+                continue; 
+            edge_weight_type w = boost::get(boost::edge_weight, this->m_graph, *oi); 
+            if (w >= 0)
+                vCost[c] += w; 
+            else // the other colors violate the stitch 
+            {
+                for (int8_t k = 0; k < color_num; ++k)
+                    if (k != c)
+                        vCost[k] -= w*this->m_stitch_weight; 
+            }
+        }
+        vColor[v] = std::min_element(vCost.begin(), vCost.end())-vCost.begin(); 
+    }
+    if (vClique.empty())
+        return; 
+    // relabel colors by their first appearance on the clique and then on all vertices, 
+    // so the i-th vertex of the clique takes a color no larger than i 
+    std::vector<int8_t> vLabel (color_num, -1); 
+    int8_t num_labels = 0; 
+    for (uint32_t i = 0; i < vClique.size(); ++i)
+        if (vLabel[vColor[vClique[i]]] < 0)
+            vLabel[vColor[vClique[i]]] = num_labels++; 
+    for (uint32_t v = 0; v < vertex_num; ++v)
+        if (vLabel[vColor[v]] < 0)
+            vLabel[vColor[v]] = num_labels++; 
+    for (uint32_t v = 0; v < vertex_num; ++v)
+        vColor[v] = vLabel[vColor[v]]; 
+}
+
 template <typename GraphType>
 void ILPColoring<GraphType>::write_graph_sol(string const& filename, typename ILPColoring<GraphType>::model_type const& opt_model, 
         std::vector<typename ILPColoring<GraphType>::model_type::variable_type> const& vVertexBit) const
@@ -34,6 +34,7 @@
 //#include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <limbo/string/String.h>
 #include <limbo/algorithms/coloring/Coloring.h>
+#include <limbo/algorithms/coloring/BipartiteColoring.h>
 #include <lemon/cbc.h>
 #include <lemon/lp.h>
 
@@ -107,6 +108,10 @@ class ILPColoringLemonCbc : public Coloring<GraphType>
 template <typename GraphType>
 double ILPColoringLemonCbc<GraphType>::coloring()
 {
+	// two colors without violations are found in linear time 
+	if (this->m_color_num == base_type::TWO && bipartite_coloring(this->m_graph, this->m_stitch_weight, this->m_vColor))
+		return 0;
+
 	uint32_t vertex_num = boost::num_vertices(this->m_graph);
 	uint32_t edge_num = boost::num_edges(this->m_graph);
 	uint32_t vertex_variable_num = vertex_num<<1;
@@ -153,11 +158,11 @@ double ILPColoringLemonCbc<GraphType>::coloring()
 			opt_model.colType(x, lemon::MipSolver::INTEGER);
 			opt_model.colName(x, oss.str());
 		}
-		else // uncolored 
+		else // uncolored, the high bit of two colors is always 0 
 		{
 			vVertexBit.push_back(opt_model.addCol());
 			Col const& x = vVertexBit.back();
-			opt_model.colBounds(x, 0, 1);
+			opt_model.colBounds(x, 0, ((i&1) == 0 && this->m_color_num == base_type::TWO)? 0 : 1);
 			opt_model.colType(x, lemon::MipSolver::INTEGER);
 			opt_model.colName(x, oss.str());
 		}
@@ -30,7 +30,9 @@
 //#include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <limbo/string/String.h>
 #include <limbo/algorithms/coloring/Coloring.h>
+#include <limbo/algorithms/coloring/BipartiteColoring.h>
 #include <limbo/solvers/Solvers.h>
+#include <limbo/solvers/Presolve.h>
 #include <limbo/solvers/api/GurobiApi.h>
 
 /// namespace for Limbo 
@@ -66,6 +68,7 @@ class ILPColoringUpdated : public Coloring<GraphType>
         typedef typename base_type::EdgeHashType edge_hash_type;
         typedef limbo::solvers::LinearModel<float, int32_t> model_type; 
         typedef limbo::solvers::GurobiLinearApi<model_type::coefficient_value_type, model_type::variable_value_type> solver_type; 
+        typedef limbo::solvers::Presolver<model_type::coefficient_value_type, model_type::variable_value_type> presolver_type; 
         /// @endnowarn
         
 		/// constructor
@@ -91,6 +94,10 @@ class ILPColoringUpdated : public Coloring<GraphType>
 template <typename GraphType>
 double ILPColoringUpdated<GraphType>::coloring()
 {
+	// two colors without violations are found in linear time 
+	if (this->m_color_num == base_type::TWO && bipartite_coloring(this->m_graph, this->m_stitch_weight, this->m_vColor))
+		return 0;
+
 	uint32_t vertex_num = boost::num_vertices(this->m_graph);
 	uint32_t edge_num = boost::num_edges(this->m_graph);
 	uint32_t vertex_variable_num = vertex_num<<1;
@@ -139,35 +146,13 @@ double ILPColoringUpdated<GraphType>::coloring()
 			else color_bit = this->m_vColor[vertex_idx]&1;
 			vVertexBit.push_back(opt_model.addVariable(color_bit, color_bit, limbo::solvers::INTEGER, oss.str()));
 		}
+		else if ((i&1) == 0 && this->m_color_num == base_type::TWO) // the high bit of two colors is always 0 and reduced by the presolver 
+			vVertexBit.push_back(opt_model.addVariable(0, 0, limbo::solvers::INTEGER, oss.str()));
 		else // uncolored 
 			vVertexBit.push_back(opt_model.addVariable(0, 1, limbo::solvers::INTEGER, oss.str()));
 	}
 
 	// edge variables 
-
-    // //New version by Wei
-    // int m_stitch_index = 0;
-    // uint32_t stitch_edge_num = 0;
-    // //parent node in non-stitch graph index of each node in stitch graph
-    // std::vector<int> stitch_relation_set;
-
-    // //Step 1. Firstly, count the number of stitch edges and store all of the stitch relations
-    // vertex_iterator_type vi, vie,next;
-    // boost::tie(vi, vie) = vertices(this->m_graph);
-    // std::vector<bool> visited(boost::num_vertices(this->m_graph), false);
-    // stitch_relation_set.assign(boost::num_vertices(this->m_graph),-1);
-    // for (next = vi; vi != vie; vi = next)
-    // {
-    //     ++next;
-    //     graph_vertex_type v = *vi;
-    //     if(visited[(int)v]) continue;
-    //     else{
-    //         visited[(int)v] = true;
-    //         stitch_relation_set[(int)v] = m_stitch_index;
-    //         Coloring<GraphType>::depth_first_search_stitch(v,stitch_relation_set,visited,stitch_edge_num,m_stitch_index);
-    //         m_stitch_index ++;
-    //     }
-    // }
 	std::vector<model_type::variable_type> vBigEdgeBit;
 	vBigEdgeBit.reserve(this->m_big_edge_num);
     model_type::expression_type obj;
@@ -215,7 +200,7 @@ double ILPColoringUpdated<GraphType>::coloring()
 		string tmpConstr_name;
 		if (w >= 0) // constraints for conflict edges 
 		{
-			int big_e_index = this->m_edge_index_vector[(uint32_t)(this->m_stitch_relation_set[(int)s]*this->m_stitch_index + this->m_stitch_relation_set[(int)t])];
+			int big_e_index = this->big_edge_index(s, t);
 			sprintf(buf, "R%u", constr_num++);  
 			opt_model.addConstraint(
 					vVertexBit[vertex_idx1] + vVertexBit[vertex_idx1+1] 
@@ -282,8 +267,24 @@ double ILPColoringUpdated<GraphType>::coloring()
 	}
 
 	//optimize model 
-    solver_type solver (&opt_model); 
-    int32_t opt_status = solver(&gurobiParams); 
+    if (this->m_collect_statistics)
+    {
+        this->m_statistics.num_variables = opt_model.numVariables();
+        this->m_statistics.num_constraints = opt_model.constraints().size();
+    }
+    // precolored vertices and their edges are reduced before the solver 
+    presolver_type presolver (&opt_model); 
+    int32_t opt_status = limbo::solvers::INFEASIBLE; 
+    if (presolver())
+    {
+        opt_status = limbo::solvers::OPTIMAL; 
+        if (!presolver.solved())
+        {
+            solver_type solver (&presolver.reducedModel(), limbo::solvers::GurobiThreadEnv::get()); 
+            opt_status = solver(&gurobiParams); 
+        }
+        presolver.postsolve(); 
+    }
 #ifdef DEBUG_ILPColoringUpdated
 	opt_model.print("graph.lp");
 	opt_model.printSolution("graph.sol");
@@ -30,7 +30,9 @@
 #include <boost/dynamic_bitset.hpp>
 #include <limbo/string/String.h>
 #include <limbo/algorithms/coloring/Coloring.h>
-#include "gurobi_c++.h"
+#include <limbo/algorithms/coloring/RandomizedRounding.h>
+#include <limbo/solvers/Solvers.h>
+#include <limbo/solvers/PrimalDualHybridGradient.h>
 
 #ifdef DEBUG_NONINTEGERS
 extern std::vector<unsigned int> vLP1NonInteger; 
@@ -62,8 +64,17 @@ using std::string;
 /// @class limbo::algorithms::coloring::LPColoring
 /// LP based graph coloring.  
 /// 
+/// The LP is built once as a @ref limbo::solvers::LinearModel and kept in a solver session,
+/// such as @ref limbo::solvers::GurobiLinearSession, @ref limbo::solvers::CplexLinearSession,
+/// @ref limbo::solvers::LPSolveLinearSession, or @ref limbo::solvers::PrimalDualHybridGradientSession by default.
+/// Each rounding iteration only changes objective coefficients, bounds and odd cycle constraints through the session,
+/// so the LP is re-solved from the previous basis by dual simplex, or from the previous primal and dual solutions.
+/// Solutions within 1e-4 of a multiple of 0.5 are snapped to it,
+/// so first-order solvers see the same integers and half-integers as simplex.
+///
 /// @tparam GraphType graph type 
-template <typename GraphType>
+/// @tparam SolverType solver session of @ref limbo::solvers::LinearModel, constructed from a pointer to the model
+template <typename GraphType, typename SolverType = limbo::solvers::PrimalDualHybridGradientSession<double, double> >
 class LPColoring : public Coloring<GraphType>
 {
 	public:
@@ -76,6 +87,12 @@ class LPColoring : public Coloring<GraphType>
 		typedef typename base_type::edge_iterator_type edge_iterator_type;
         typedef typename base_type::edge_weight_type edge_weight_type;
         typedef typename base_type::EdgeHashType edge_hash_type;
+        typedef SolverType solver_type;
+        typedef typename solver_type::model_type model_type;
+        typedef typename model_type::variable_type variable_type;
+        typedef typename model_type::constraint_type constraint_type;
+        typedef typename model_type::expression_type expression_type;
+        typedef typename model_type::term_type term_type;
         /// @endnowarn
 
         /// records the information of non-integer values 
@@ -136,47 +153,50 @@ class LPColoring : public Coloring<GraphType>
 
         /// @return number of LP iterations 
         uint32_t lp_iters() const {return m_lp_iters;}
+        /// set number of randomized rounding trials from the final LP solution, 
+        /// run in parallel with @ref limbo::algorithms::coloring::RandomizedRounding; 
+        /// the best one replaces the rounding with post refinement if it has a smaller cost 
+        /// @param t number of trials, 0 to disable 
+        void rounding_trials(uint32_t t) {m_rounding_trials = t;}
 
         // for debug 
-        /// print solution 
-        /// @param vColorBits LP solutions 
-        void print_solution(vector<GRBVar> const& vColorBits) const;
+        /// print solution of the last LP
+        void print_solution() const;
 	protected:
 		/// kernel coloring algorithm; 
         /// relaxed linear programming based coloring for the conflict graph (this->m_graph)
 		/// @return objective value 
 		double coloring(); 
 
-		/// apply coloring solution 
-        /// @param vColorBits LP solutions 
-		void apply_solution(vector<GRBVar> const& vColorBits);
+		/// apply coloring solution of the last LP
+		void apply_solution();
 
 		/// create the NoStitchGraph (this->m_graph) from the (m_conflict_graph)
 		void initialize();
         /// create basic variables, objective and constraints
         /// @param vColorBits vertex bits of LP 
         /// @param vEdgeBits edge bits of LP 
-        /// @param obj objective of LP 
         /// @param optModel LP model 
-        void set_optimize_model(vector<GRBVar>& vColorBits, vector<GRBVar>& vEdgeBits, GRBLinExpr& obj, GRBModel& optModel);
+        void set_optimize_model(vector<variable_type>& vColorBits, vector<variable_type>& vEdgeBits, model_type& optModel);
         /// set anchor vertex 
         /// @param vColorBits vertex bits of LP 
-        void set_anchor(vector<GRBVar>& vColorBits) const; 
+        /// @param optModel LP model
+        void set_anchor(vector<variable_type>& vColorBits, model_type& optModel) const;
         /// for each color bit pair of a vertex 
-        /// @param vColorBits vertex bits of LP 
-        /// @param obj objective of LP 
-        void adjust_variable_pair_in_objective(vector<GRBVar> const& vColorBits, GRBLinExpr& obj) const; 
+        /// @param vObjCoef objective coefficient of each color bit
+        void adjust_variable_pair_in_objective(vector<double>& vObjCoef) const;
         /// for each color bit pair of vertices of an edge 
-        /// @param vColorBits vertex bits of LP 
-        /// @param obj objective of LP 
-        void adjust_conflict_edge_vertices_in_objective(vector<GRBVar> const& vColorBits, GRBLinExpr& obj) const;
+        /// @param vObjCoef objective coefficient of each color bit
+        void adjust_conflict_edge_vertices_in_objective(vector<double>& vObjCoef) const;
         /// odd cycle constraints from Prof. Baldick
         /// @param vColorBits vertex bits of LP 
+        /// @param solver LP session
+        void add_odd_cycle_constraints(vector<variable_type> const& vColorBits, solver_type& solver);
+        /// solve model and keep the solution of color bits
+        /// @param vColorBits vertex bits of LP
         /// @param optModel LP model 
-        void add_odd_cycle_constraints(vector<GRBVar> const& vColorBits, GRBModel& optModel); 
-        /// solve model 
-        /// @param optModel LP model 
-        void solve_model(GRBModel& optModel);
+        /// @param solver LP session
+        void solve_model(vector<variable_type> const& vColorBits, model_type const& optModel, solver_type& solver);
 
 		/// DFS to search for the odd cycles, stored in m_odd_cycles
         /// @param v vertex 
@@ -187,9 +207,9 @@ class LPColoring : public Coloring<GraphType>
 
 		/// Optimal rounding based on binding constraints
         /// @param optModel LP model 
+        /// @param solver LP session
         /// @param vColorBits vertex bits of LP 
-        /// @param vEdgeBits edge bits of LP 
-		void rounding_with_binding_analysis(GRBModel& optModel, vector<GRBVar>& vColorBits, vector<GRBVar>& vEdgeBits);
+		void rounding_with_binding_analysis(model_type const& optModel, solver_type& solver, vector<variable_type>& vColorBits);
 
 		/// greedy final coloring refinement
 		uint32_t post_refinement();
@@ -197,46 +217,55 @@ class LPColoring : public Coloring<GraphType>
         /// @param e edge 
 		bool refine_color(graph_edge_type const& e);
 
-        /// compute number of non-integers and half-integers for both vertex variables and edge variables 
-        /// @param vColorBits vertex bits of LP 
-        /// @param vEdgeBits edge bits of LP 
+        /// compute number of non-integers and half-integers for vertex variables of the last LP
         /// @param info non-integer information 
-        void non_integer_num(vector<GRBVar> const& vColorBits, vector<GRBVar> const& vEdgeBits, NonIntegerInfo& info) const;
-        /// compute number of non-integers and half-integers with given variable array 
-        /// @param vVariables variables 
+        void non_integer_num(NonIntegerInfo& info) const;
+        /// compute number of non-integers and half-integers with given values
+        /// @param vValue values of variables
         /// @param nonIntegerNum number of non-integers 
         /// @param halfIntegerNum number of half-integers 
-        void non_integer_num(vector<GRBVar> const& vVariables, uint32_t& nonIntegerNum, uint32_t& halfIntegerNum) const;
+        void non_integer_num(vector<double> const& vValue, uint32_t& nonIntegerNum, uint32_t& halfIntegerNum) const;
 
 		/// check if a variable is integer or not 
         /// @param value target value to be checked 
         /// @return true if value is an integer 
 		bool is_integer(double value) const {return value == floor(value);}
+        /// snap a solution close to a multiple of 0.5, as first-order solvers do not end at vertices exactly
+        /// @param value solution of a variable
+        /// @return snapped value
+        static double snap_value(double value)
+        {
+            double half = floor(value*2+0.5)/2;
+            return (std::abs(value-half) < 1e-4)? half : value;
+        }
 
         /// check number of precolored vertices 
         /// @param vVertex vertices of the graph 
         /// @return number of precolored vertices 
-        uint32_t check_precolored_num(vector<LPColoring<GraphType>::graph_vertex_type> const& vVertex) const; 
+        uint32_t check_precolored_num(vector<graph_vertex_type> const& vVertex) const;
 
 		/// members
         boost::dynamic_bitset<> m_vVertexHandledByOddCycle; ///< record whether a vertex has already been handled by an odd cycle 
 		uint32_t m_constrs_num; ///< record number of constraints 
         uint32_t m_lp_iters; ///< record lp iterations 
+        uint32_t m_rounding_trials; ///< number of randomized rounding trials 
+        vector<double> m_vColorBitValue; ///< solution of each color bit of the last LP
 };
 
 /// constructor
-template <typename GraphType>
-LPColoring<GraphType>::LPColoring(graph_type const& g) 
-    : LPColoring<GraphType>::base_type(g)
+template <typename GraphType, typename SolverType>
+LPColoring<GraphType, SolverType>::LPColoring(graph_type const& g)
+    : LPColoring<GraphType, SolverType>::base_type(g)
     , m_vVertexHandledByOddCycle(boost::num_vertices(g), false)
     , m_constrs_num(0)
     , m_lp_iters(0)
+    , m_rounding_trials(0)
 {
 }
 
 //DFS to search for the odd cycles, stored in m_odd_cycles
-template <typename GraphType>
-void LPColoring<GraphType>::get_odd_cycles(graph_vertex_type const& v, vector<vector<LPColoring<GraphType>::graph_vertex_type> >& vOddCyle) 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::get_odd_cycles(graph_vertex_type const& v, vector<vector<LPColoring<GraphType, SolverType>::graph_vertex_type> >& vOddCyle) 
 {
 	//odd_cycle results
 	vOddCyle.clear();
@@ -328,8 +357,8 @@ void LPColoring<GraphType>::get_odd_cycles(graph_vertex_type const& v, vector<ve
 }
 
 // the vertex with the largest degree
-template <typename GraphType>
-typename LPColoring<GraphType>::graph_vertex_type LPColoring<GraphType>::max_degree_vertex() const
+template <typename GraphType, typename SolverType>
+typename LPColoring<GraphType, SolverType>::graph_vertex_type LPColoring<GraphType, SolverType>::max_degree_vertex() const
 {
     graph_vertex_type u = 0;
     uint32_t maxDegree = 0;
@@ -346,8 +375,8 @@ typename LPColoring<GraphType>::graph_vertex_type LPColoring<GraphType>::max_deg
     return u;
 }
 
-template <typename GraphType>
-void LPColoring<GraphType>::set_optimize_model(vector<GRBVar>& vColorBits, vector<GRBVar>& /*vEdgeBits*/, GRBLinExpr& obj, GRBModel& optModel)
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::set_optimize_model(vector<variable_type>& vColorBits, vector<variable_type>& /*vEdgeBits*/, model_type& optModel)
 {
 	uint32_t numVertices = boost::num_vertices(this->m_graph);
 	//uint32_t numEdges = boost::num_edges(this->m_graph);
@@ -355,6 +384,7 @@ void LPColoring<GraphType>::set_optimize_model(vector<GRBVar>& vColorBits, vecto
 
 	//set up the LP variables
 	vColorBits.reserve(numColorBits);
+    optModel.reserveVariables(numColorBits);
 	//vEdgeBits.reserve(numEdges);
 	// vertex and edge variables 
     char buf[64];
@@ -365,28 +395,26 @@ void LPColoring<GraphType>::set_optimize_model(vector<GRBVar>& vColorBits, vecto
         uint32_t vertexIdx = i>>1;
         int8_t color = this->m_vColor[vertexIdx];
         if (color < 0) // not precolored
-            vColorBits.push_back(optModel.addVar(0.0, 1.0, 0.0, GRB_CONTINUOUS, buf));
+            vColorBits.push_back(optModel.addVariable(0.0, 1.0, limbo::solvers::CONTINUOUS, buf));
         else // precolored
         {
             int8_t colorBit = (i&1)? (color&1) : (color>>1); 
 #ifdef DEBUG_LPCOLORING
             limboAssert(colorBit >= 0 && colorBit <= 1);
 #endif
-            vColorBits.push_back(optModel.addVar(colorBit, colorBit, colorBit, GRB_CONTINUOUS, buf));
+            vColorBits.push_back(optModel.addVariable(colorBit, colorBit, limbo::solvers::CONTINUOUS, buf));
         }
 	}
 	//for (uint32_t i = 0; i != numEdges; ++i)
 	//{
 	//	// some variables here may not be used 
     //    sprintf(buf, "e%u", i);
-	//	vEdgeBits.push_back(optModel.addVar(0.0, 1.0, 0.0, GRB_CONTINUOUS, buf));
+	//	vEdgeBits.push_back(optModel.addVariable(0.0, 1.0, limbo::solvers::CONTINUOUS, buf));
 	//}
-	//Integrate new variables
-	optModel.update();
 
     // set up objective
-    obj.clear(); // set to 0 
-    optModel.setObjective(obj, GRB_MINIMIZE);
+    optModel.setObjective(expression_type()); // set to 0
+    optModel.setOptimizeType(limbo::solvers::MIN);
 
 	//set up the LP constraints
     edge_iterator_type ei, eie; 
@@ -407,28 +435,29 @@ void LPColoring<GraphType>::set_optimize_model(vector<GRBVar>& vColorBits, vecto
         edge_weight_type w = this->edge_weight(e);
         limboAssertMsg(w > 0, "no stitch edge allowed, positive edge weight expected: %u", w);
 
+        // constants of complemented bits are moved to the right hand side
         sprintf(buf, "R%u", m_constrs_num++);  
-        optModel.addConstr(
+        optModel.addConstraint(
                 vColorBits[bitIdxS] + vColorBits[bitIdxS+1] 
                 + vColorBits[bitIdxT] + vColorBits[bitIdxT+1] >= 1
                 , buf);
 
         sprintf(buf, "R%u", m_constrs_num++);  
-        optModel.addConstr(
-                1 - vColorBits[bitIdxS] + vColorBits[bitIdxS+1] 
-                + 1 - vColorBits[bitIdxT] + vColorBits[bitIdxT+1] >= 1
+        optModel.addConstraint(
+                -vColorBits[bitIdxS] + vColorBits[bitIdxS+1]
+                - vColorBits[bitIdxT] + vColorBits[bitIdxT+1] >= -1
                 , buf);
 
         sprintf(buf, "R%u", m_constrs_num++);  
-        optModel.addConstr(
-                vColorBits[bitIdxS] + 1 - vColorBits[bitIdxS+1] 
-                + vColorBits[bitIdxT] + 1 - vColorBits[bitIdxT+1] >= 1
+        optModel.addConstraint(
+                vColorBits[bitIdxS] - vColorBits[bitIdxS+1]
+                + vColorBits[bitIdxT] - vColorBits[bitIdxT+1] >= -1
                 , buf);
 
         sprintf(buf, "R%u", m_constrs_num++);  
-        optModel.addConstr(
-                1 - vColorBits[bitIdxS] + 1 - vColorBits[bitIdxS+1] 
-                + 1 - vColorBits[bitIdxT] + 1 - vColorBits[bitIdxT+1] >= 1
+        optModel.addConstraint(
+                -vColorBits[bitIdxS] - vColorBits[bitIdxS+1]
+                - vColorBits[bitIdxT] - vColorBits[bitIdxT+1] >= -3
                 , buf);
 	}
 
@@ -437,51 +466,54 @@ void LPColoring<GraphType>::set_optimize_model(vector<GRBVar>& vColorBits, vecto
 		for(uint32_t k = 0; k < numColorBits; k += 2) 
 		{
 			sprintf(buf, "R%u", m_constrs_num++);  
-			optModel.addConstr(
+			optModel.addConstraint(
                     vColorBits[k] + vColorBits[k+1] <= 1, 
                     buf);
 		}
 	}
-
-	//Integrate new variables
-	optModel.update();
 }
 
-template <typename GraphType>
-void LPColoring<GraphType>::set_anchor(vector<GRBVar>& vColorBits) const 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::set_anchor(vector<variable_type>& vColorBits, model_type& optModel) const
 {
     if (this->has_precolored()) // no anchor if containing precolored vertices 
         return;
 	//Anchoring the coloring of the vertex with largest degree
 	graph_vertex_type anchorVertex = max_degree_vertex();
 	uint32_t bitIdxAnchor = anchorVertex<<1;
-	vColorBits[bitIdxAnchor].set(GRB_DoubleAttr_UB, 0.0);
-	vColorBits[bitIdxAnchor].set(GRB_DoubleAttr_LB, 0.0);
-	vColorBits[bitIdxAnchor+1].set(GRB_DoubleAttr_UB, 0.0);
-	vColorBits[bitIdxAnchor+1].set(GRB_DoubleAttr_LB, 0.0);
+	optModel.setVariableUpperBound(vColorBits[bitIdxAnchor], 0.0);
+	optModel.setVariableLowerBound(vColorBits[bitIdxAnchor], 0.0);
+	optModel.setVariableUpperBound(vColorBits[bitIdxAnchor+1], 0.0);
+	optModel.setVariableLowerBound(vColorBits[bitIdxAnchor+1], 0.0);
 }
 
 /// tune objective for each color bit pair of vertex  
-template <typename GraphType>
-void LPColoring<GraphType>::adjust_variable_pair_in_objective(vector<GRBVar> const& vColorBits, GRBLinExpr& obj) const 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::adjust_variable_pair_in_objective(vector<double>& vObjCoef) const
 {
-    for(uint32_t k = 0, ke = vColorBits.size(); k < ke; k += 2) 
+    for(uint32_t k = 0, ke = m_vColorBitValue.size(); k < ke; k += 2)
     {
-        double value1 = vColorBits[k].get(GRB_DoubleAttr_X);
-        double value2 = vColorBits[k+1].get(GRB_DoubleAttr_X);
+        double value1 = m_vColorBitValue[k];
+        double value2 = m_vColorBitValue[k+1];
         if (!is_integer(value1) || !is_integer(value2))
         {
             if (value1 > value2)
-                obj += vColorBits[k+1]-vColorBits[k];
+            {
+                vObjCoef[k+1] += 1;
+                vObjCoef[k] -= 1;
+            }
             else if (value1 < value2)
-                obj += vColorBits[k]-vColorBits[k+1];
+            {
+                vObjCoef[k] += 1;
+                vObjCoef[k+1] -= 1;
+            }
         }
     }//end for 
 }
 
 /// tune objective for each color bit pair along conflict edges 
-template <typename GraphType>
-void LPColoring<GraphType>::adjust_conflict_edge_vertices_in_objective(vector<GRBVar> const& vColorBits, GRBLinExpr& obj) const 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::adjust_conflict_edge_vertices_in_objective(vector<double>& vObjCoef) const
 {
     edge_iterator_type ei, eie; 
 	for(boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei) 
@@ -495,27 +527,33 @@ void LPColoring<GraphType>::adjust_conflict_edge_vertices_in_objective(vector<GR
             uint32_t bitIdxS = (s<<1)+i;
             uint32_t bitIdxT = (t<<1)+i;
 
-            double value1 = vColorBits[bitIdxS].get(GRB_DoubleAttr_X);
-            double value2 = vColorBits[bitIdxT].get(GRB_DoubleAttr_X);
+            double value1 = m_vColorBitValue[bitIdxS];
+            double value2 = m_vColorBitValue[bitIdxT];
 
-            if (value1 > value2)
-                obj += vColorBits[bitIdxT]-vColorBits[bitIdxS]; // reverse, as we minimize objective
-            else if (value1 < value2)
-                obj += vColorBits[bitIdxS]-vColorBits[bitIdxT]; // reverse, as we minimize objective
+            if (value1 > value2) // reverse, as we minimize objective
+            {
+                vObjCoef[bitIdxT] += 1;
+                vObjCoef[bitIdxS] -= 1;
+            }
+            else if (value1 < value2) // reverse, as we minimize objective
+            {
+                vObjCoef[bitIdxS] += 1;
+                vObjCoef[bitIdxT] -= 1;
+            }
         }
     }//end for 
 }
 
 /// odd cycle trick from Prof. Baldick
-template <typename GraphType>
-void LPColoring<GraphType>::add_odd_cycle_constraints(vector<GRBVar> const& vColorBits, GRBModel& optModel) 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::add_odd_cycle_constraints(vector<variable_type> const& vColorBits, solver_type& solver)
 {
     char buf[64];
     vector<vector<graph_vertex_type> > vOddCyle;
     for(uint32_t k = 0, ke = vColorBits.size(); k < ke; k += 2) 
     {
         // only add odd cycle for half integer 
-        if (vColorBits[k].get(GRB_DoubleAttr_X) != 0.5 && vColorBits[k+1].get(GRB_DoubleAttr_X) != 0.5)
+        if (m_vColorBitValue[k] != 0.5 && m_vColorBitValue[k+1] != 0.5)
             continue;
 
         graph_vertex_type v = k>>1;
@@ -525,94 +563,83 @@ void LPColoring<GraphType>::add_odd_cycle_constraints(vector<GRBVar> const& vCol
         {
             vector<graph_vertex_type> const& oddCycle = *it1;
             int32_t cycleLength = oddCycle.size(); // safer to use integer as we do minus afterward
-            GRBLinExpr constraint1 = 0;
-            GRBLinExpr constraint2 = 0;
+            expression_type constraint1;
+            expression_type constraint2;
 
             for (typename vector<graph_vertex_type>::const_iterator it2 = oddCycle.begin(), it2e = oddCycle.end(); it2 != it2e; ++it2)
             {
                 graph_vertex_type u = *it2;
-                constraint1 += vColorBits[u<<1];
-                constraint2 += vColorBits[(u<<1)+1];
+                constraint1 += term_type(vColorBits[u<<1]);
+                constraint2 += term_type(vColorBits[(u<<1)+1]);
             }
 
-            sprintf(buf, "ODD%lu_%u", v, m_constrs_num++);
-            optModel.addConstr(constraint1 >= 1, buf);
-            sprintf(buf, "ODD%lu_%u", v, m_constrs_num++);
-            optModel.addConstr(constraint1 <= cycleLength-1, buf);
-            sprintf(buf, "ODD%lu_%u", v, m_constrs_num++);
-            optModel.addConstr(constraint2 >= 1, buf);
-            sprintf(buf, "ODD%lu_%u", v, m_constrs_num++);
-            optModel.addConstr(constraint2 <= cycleLength-1, buf);
+            sprintf(buf, "ODD%lu_%u", (unsigned long)v, m_constrs_num++);
+            solver.addConstraint(constraint1 >= 1, buf);
+            sprintf(buf, "ODD%lu_%u", (unsigned long)v, m_constrs_num++);
+            solver.addConstraint(constraint1 <= cycleLength-1, buf);
+            sprintf(buf, "ODD%lu_%u", (unsigned long)v, m_constrs_num++);
+            solver.addConstraint(constraint2 >= 1, buf);
+            sprintf(buf, "ODD%lu_%u", (unsigned long)v, m_constrs_num++);
+            solver.addConstraint(constraint2 <= cycleLength-1, buf);
         }
     }//end for k
 }
 
 /// solve model 
-template <typename GraphType>
-void LPColoring<GraphType>::solve_model(GRBModel& optModel) 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::solve_model(vector<variable_type> const& vColorBits, model_type const& optModel, solver_type& solver)
 {
     char buf[64];
-    //optimize the new model
-    optModel.update();
 #ifdef DEBUG_LPCOLORING
     sprintf(buf, "%u.lp", m_lp_iters);
-    optModel.write(buf);
+    optModel.print(buf);
 #endif
-    optModel.optimize();
-    int32_t optStatus = optModel.get(GRB_IntAttr_Status);
-    if (optStatus == GRB_INFEASIBLE)
+    limbo::solvers::SolverProperty optStatus = solver();
+    if (optStatus == limbo::solvers::INFEASIBLE)
     {
         // write lp 
         sprintf(buf, "%u.lp", m_lp_iters);
-        optModel.write(buf);
-        // write iis 
-        optModel.computeIIS();
-        sprintf(buf, "%u.ilp", m_lp_iters);
-        optModel.write(buf);
+        optModel.print(buf);
     }
-    limboAssertMsg(optStatus != GRB_INFEASIBLE, "model is infeasible");
+    limboAssertMsg(optStatus != limbo::solvers::INFEASIBLE, "model is infeasible");
+    m_vColorBitValue.resize(vColorBits.size());
+    for (uint32_t i = 0, ie = vColorBits.size(); i != ie; ++i)
+        m_vColorBitValue[i] = snap_value(optModel.variableSolution(vColorBits[i]));
     ++m_lp_iters;
 }
 
 //relaxed linear programming based coloring for the conflict graph (this->m_graph)
-template <typename GraphType> 
-double LPColoring<GraphType>::coloring() 
+template <typename GraphType, typename SolverType>
+double LPColoring<GraphType, SolverType>::coloring()
 {
 #ifdef DEBUG_LPCOLORING
     this->write_graph("initial_input");
 #endif
-    vector<GRBVar> vColorBits;
-    vector<GRBVar> vEdgeBits;
-    GRBLinExpr obj;
-
-	//set up the LP environment
-	GRBEnv env;
-	//mute the log from the LP solver
-	env.set(GRB_IntParam_OutputFlag, 0);
-    // set number of threads 
-	if (this->m_threads > 0 && this->m_threads < std::numeric_limits<int32_t>::max())
-		env.set(GRB_IntParam_Threads, this->m_threads);
-    // default algorithm 
-    env.set(GRB_IntParam_Method, -1);
-    // since GRBModel does not allow default constructor, we have to setup GRBEnv before it
-	GRBModel optModel = GRBModel(env);
-
-    // initialize model and set anchor vertex 
-    set_optimize_model(vColorBits, vEdgeBits, obj, optModel);
+    vector<variable_type> vColorBits;
+    vector<variable_type> vEdgeBits;
+    vector<int8_t> vPrecolor (this->m_vColor.begin(), this->m_vColor.end()); 
+
+    // initialize model and set anchor vertex
+    model_type optModel;
+    set_optimize_model(vColorBits, vEdgeBits, optModel);
 #ifndef DEBUG_NOANCHOR
-    set_anchor(vColorBits);
+    set_anchor(vColorBits, optModel);
 #endif
+    // the session keeps the LP, and later iterations only change it
+    solver_type solver (&optModel);
+    vector<double> vObjCoef (vColorBits.size(), 0.0);
+    vector<double> vPrevObjCoef (vObjCoef);
 
-    solve_model(optModel);
+    solve_model(vColorBits, optModel, solver);
 
 #ifdef DEBUG_LPCOLORING
     printf("\nLP %u solution: ", m_lp_iters);
-    print_solution(vColorBits);
+    print_solution();
 #endif
 
     NonIntegerInfo prevInfo; // initialize to numeric max 
     NonIntegerInfo curInfo;
-    non_integer_num(vColorBits, vEdgeBits, curInfo);
+    non_integer_num(curInfo);
 #ifdef DEBUG_NONINTEGERS
     vLP1NonInteger.push_back(curInfo.vertex_non_integer_num); 
     vLP1HalfInteger.push_back(curInfo.vertex_half_integer_num); 
@@ -623,26 +650,34 @@ double LPColoring<GraphType>::coloring()
 		//set the new objective
 		//push the non-half_integer to 0/1
 		// tune objective for a pair of values 
-        adjust_variable_pair_in_objective(vColorBits, obj);
+        adjust_variable_pair_in_objective(vObjCoef);
 		// tune objective for a pair of value along conflict edges 
         // disabled because it has conflicts with odd cycle constraints 
-        //adjust_conflict_edge_vertices_in_objective(vColorBits, obj);
+        //adjust_conflict_edge_vertices_in_objective(vObjCoef);
 
-		optModel.setObjective(obj);
+        // only changed coefficients go to the solver
+        for (uint32_t k = 0, ke = vObjCoef.size(); k != ke; ++k)
+        {
+            if (vObjCoef[k] != vPrevObjCoef[k])
+            {
+                solver.setObjectiveCoefficient(vColorBits[k], vObjCoef[k]);
+                vPrevObjCoef[k] = vObjCoef[k];
+            }
+        }
 
 		//add new constraints
 		//odd cycle trick from Prof. Baldick
-        add_odd_cycle_constraints(vColorBits, optModel);
+        add_odd_cycle_constraints(vColorBits, solver);
 
-        solve_model(optModel);
+        solve_model(vColorBits, optModel, solver);
 
 #ifdef DEBUG_LPCOLORING
         printf("LP %u solution: ", m_lp_iters);
-        print_solution(vColorBits);
+        print_solution();
 #endif
 
         prevInfo = curInfo;
-        non_integer_num(vColorBits, vEdgeBits, curInfo);
+        non_integer_num(curInfo);
 #ifdef DEBUG_NONINTEGERS
         if (m_lp_iters == 2)
         {
@@ -657,29 +692,44 @@ double LPColoring<GraphType>::coloring()
     vLPEndHalfInteger.push_back(curInfo.vertex_half_integer_num);
     vLPNumIter.push_back(m_lp_iters); 
 #endif
+    if (this->m_collect_statistics)
+    {
+        this->m_statistics.num_variables = optModel.numVariables();
+        this->m_statistics.num_constraints = optModel.constraints().size();
+        this->m_statistics.num_iterations = m_lp_iters;
+    }
 
 	// binding analysis
-    //rounding_with_binding_analysis(optModel, vColorBits, vEdgeBits);
+    //rounding_with_binding_analysis(optModel, solver, vColorBits);
     // apply coloring solution 
-    apply_solution(vColorBits);
+    apply_solution();
     // post refinement 
 	post_refinement();
 
+    // randomized rounding from the same LP solution 
+    if (m_rounding_trials > 0)
+    {
+        RandomizedRounding<graph_type> rr (this->m_graph, this->color_num(), this->stitch_weight(), vPrecolor, m_vColorBitValue);
+        rr.trials(m_rounding_trials); 
+        rr.threads(this->m_threads); 
+        vector<int8_t> vColor; 
+        if (rr(vColor) < rr.cost(this->m_vColor))
+            this->m_vColor.swap(vColor);
+    }
+
 #ifdef DEBUG_LPCOLORING
     this->write_graph("final_output");
 #endif
     return this->calc_cost(this->m_vColor);
 }
 
-template <typename GraphType>
-void LPColoring<GraphType>::apply_solution(vector<GRBVar> const& vColorBits)
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::apply_solution()
 {
     for (uint32_t i = 0, ie = this->m_vColor.size(); i != ie; ++i)
     {
-        GRBVar const& var1 = vColorBits[i<<1];
-        GRBVar const& var2 = vColorBits[(i<<1)+1];
-        int8_t b1 = round(var1.get(GRB_DoubleAttr_X));
-        int8_t b2 = round(var2.get(GRB_DoubleAttr_X));
+        int8_t b1 = round(m_vColorBitValue[i<<1]);
+        int8_t b2 = round(m_vColorBitValue[(i<<1)+1]);
         // exclude (1, 1) for three coloring 
         this->m_vColor[i] = std::min((b1<<1)+b2, (int8_t)this->color_num()-1);
     }
@@ -687,29 +737,38 @@ void LPColoring<GraphType>::apply_solution(vector<GRBVar> const& vColorBits)
 
 /// optimal rounding based on the binding analysis
 /// but only a part of all vertices can be rounded 
-template <typename GraphType>
-void LPColoring<GraphType>::rounding_with_binding_analysis(GRBModel& optModel, vector<GRBVar>& vColorBits, vector<GRBVar>& vEdgeBits) 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::rounding_with_binding_analysis(model_type const& optModel, solver_type& solver, vector<variable_type>& vColorBits)
 {
     NonIntegerInfo prevInfo; // initialize to numeric max 
     NonIntegerInfo curInfo;
-    non_integer_num(vColorBits, vEdgeBits, curInfo);
+    non_integer_num(curInfo);
 	//iteratively scheme
 	while(curInfo.vertex_non_integer_num > 0 && curInfo.vertex_non_integer_num < prevInfo.vertex_non_integer_num) 
     {
+        // constraints of each variable, as columns are not stored by the model
+        vector<vector<uint32_t> > vColumn (optModel.numVariables());
+        for (uint32_t k = 0, ke = optModel.constraints().size(); k != ke; ++k)
+        {
+            vector<term_type> const& vTerm = optModel.constraints()[k].expression().terms();
+            for (typename vector<term_type>::const_iterator it = vTerm.begin(), ite = vTerm.end(); it != ite; ++it)
+                vColumn[it->variable().id()].push_back(k);
+        }
+
         bool modifyFlag = false; // whether binding analysis causes any change 
         for (uint32_t i = 0, ie = vColorBits.size(); i < ie; i += 2)
         {
-            GRBVar const& var1 = vColorBits[i];
-            GRBVar const& var2 = vColorBits[i+1];
-            double value1 = var1.get(GRB_DoubleAttr_X);
-            double value2 = var2.get(GRB_DoubleAttr_X);
+            variable_type const& var1 = vColorBits[i];
+            variable_type const& var2 = vColorBits[i+1];
+            double value1 = m_vColorBitValue[i];
+            double value2 = m_vColorBitValue[i+1];
 
             if (!(value1 == 0.5 && value2 == 0.5))
                 continue;
 
-            GRBColumn column[2] = {
-                optModel.getCol(var1),
-                optModel.getCol(var2)
+            vector<uint32_t> const* column[2] = {
+                &vColumn[var1.id()],
+                &vColumn[var2.id()]
             };
 
             ConstrVariableInfo prevConstrInfo[2];
@@ -724,15 +783,24 @@ void LPColoring<GraphType>::rounding_with_binding_analysis(GRBModel& optModel, v
             bool failFlag = false; // whether optimal rounding is impossible 
             // check all corresponding constraints 
             for (uint32_t j = 0; j != 2 && !failFlag; ++j)
-                for (uint32_t k = 0, ke = column[j].size(); k != ke; ++k)
+                for (uint32_t k = 0, ke = column[j]->size(); k != ke; ++k)
                 {
-                    GRBConstr constr = column[j].getConstr(k);
+                    constraint_type const& constr = optModel.constraints()[(*column[j])[k]];
                     // skip non-binding constraint 
-                    //if (constr.get(GRB_DoubleAttr_Slack) != 0.0) 
+                    //if (optModel.evaluateConstraint(constr) != 0.0)
                     //    continue;
-                    char sense = constr.get(GRB_CharAttr_Sense);
-                    curConstrInfo[0].set(optModel.getCoeff(constr, var1), sense);
-                    curConstrInfo[1].set(optModel.getCoeff(constr, var2), sense);
+                    char sense = constr.sense();
+                    double coeff[2] = {0.0, 0.0};
+                    vector<term_type> const& vTerm = constr.expression().terms();
+                    for (typename vector<term_type>::const_iterator it = vTerm.begin(), ite = vTerm.end(); it != ite; ++it)
+                    {
+                        if (it->variable() == var1)
+                            coeff[0] = it->coefficient();
+                        else if (it->variable() == var2)
+                            coeff[1] = it->coefficient();
+                    }
+                    curConstrInfo[0].set(coeff[0], sense);
+                    curConstrInfo[1].set(coeff[1], sense);
 
                     // conflict sensitivity detected 
                     if (!curConstrInfo[0].same_direction(prevConstrInfo[0]) || !curConstrInfo[1].same_direction(prevConstrInfo[1]))
@@ -774,10 +842,8 @@ void LPColoring<GraphType>::rounding_with_binding_analysis(GRBModel& optModel, v
                     for (int32_t b2 = 0; b2 != 2; ++b2)
                         if (mValidColorBits[b1][b2])
                         {
-                            vColorBits[i].set(GRB_DoubleAttr_UB, b1);
-                            vColorBits[i].set(GRB_DoubleAttr_LB, b1);
-                            vColorBits[i+1].set(GRB_DoubleAttr_UB, b2);
-                            vColorBits[i+1].set(GRB_DoubleAttr_LB, b2);
+                            solver.setVariableBounds(var1, b1, b1);
+                            solver.setVariableBounds(var2, b2, b2);
                             modifyFlag = true;
                         }
             }
@@ -786,16 +852,16 @@ void LPColoring<GraphType>::rounding_with_binding_analysis(GRBModel& optModel, v
         // exit if nothing changed 
         if (!modifyFlag) break;
 
-        solve_model(optModel);
+        solve_model(vColorBits, optModel, solver);
 
         prevInfo = curInfo;
-        non_integer_num(vColorBits, vEdgeBits, curInfo);
+        non_integer_num(curInfo);
     }
 }
 
 //post coloring refinement
-template <typename GraphType>
-uint32_t LPColoring<GraphType>::post_refinement() 
+template <typename GraphType, typename SolverType>
+uint32_t LPColoring<GraphType, SolverType>::post_refinement() 
 {
     uint32_t count = 0;
     if (!this->has_precolored()) // no post refinement if containing precolored vertices 
@@ -815,8 +881,8 @@ uint32_t LPColoring<GraphType>::post_refinement()
 }
 
 /// @return true if found a coloring solution to resolve conflicts 
-template <typename GraphType>
-bool LPColoring<GraphType>::refine_color(LPColoring<GraphType>::graph_edge_type const& e) 
+template <typename GraphType, typename SolverType>
+bool LPColoring<GraphType, SolverType>::refine_color(LPColoring<GraphType, SolverType>::graph_edge_type const& e) 
 { 
     graph_vertex_type v[2] = {
         boost::source(e, this->m_graph), 
@@ -877,26 +943,24 @@ bool LPColoring<GraphType>::refine_color(LPColoring<GraphType>::graph_edge_type
 // for debug use
 // it seems doxygen cannot handle template functions with the same name correctly 
 /// @cond 
-template <typename GraphType>
-void LPColoring<GraphType>::non_integer_num(vector<GRBVar> const& vColorBits, vector<GRBVar> const& /*vEdgeBits*/, LPColoring<GraphType>::NonIntegerInfo& info) const
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::non_integer_num(LPColoring<GraphType, SolverType>::NonIntegerInfo& info) const
 {
-    non_integer_num(vColorBits, info.vertex_non_integer_num, info.vertex_half_integer_num);
-    //non_integer_num(vEdgeBits, info.edge_non_integer_num, info.edge_half_integer_num);
+    non_integer_num(m_vColorBitValue, info.vertex_non_integer_num, info.vertex_half_integer_num);
 
 #ifdef DEBUG_LPCOLORING
     printf("vertex_non_integer_num = %u, vertex_half_integer_num = %u\n", info.vertex_non_integer_num, info.vertex_half_integer_num); 
-    //printf("edge_non_integer_num = %u, edge_half_integer_num = %u\n", info.edge_non_integer_num, info.edge_half_integer_num); 
 #endif
 }
 
-template <typename GraphType>
-void LPColoring<GraphType>::non_integer_num(vector<GRBVar> const& vVariables, uint32_t& nonIntegerNum, uint32_t& halfIntegerNum) const 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::non_integer_num(vector<double> const& vValue, uint32_t& nonIntegerNum, uint32_t& halfIntegerNum) const
 {
     nonIntegerNum = 0;
     halfIntegerNum = 0;
-    for (vector<GRBVar>::const_iterator it = vVariables.begin(), ite = vVariables.end(); it != ite; ++it)
+    for (vector<double>::const_iterator it = vValue.begin(), ite = vValue.end(); it != ite; ++it)
     {
-        double value = it->get(GRB_DoubleAttr_X);
+        double value = *it;
         if (value != 0.0 && value != 1.0)
         {
             ++nonIntegerNum;
@@ -907,8 +971,8 @@ void LPColoring<GraphType>::non_integer_num(vector<GRBVar> const& vVariables, ui
 }
 /// @endcond 
 
-template <typename GraphType>
-uint32_t LPColoring<GraphType>::check_precolored_num(vector<LPColoring<GraphType>::graph_vertex_type> const& vVertex) const 
+template <typename GraphType, typename SolverType>
+uint32_t LPColoring<GraphType, SolverType>::check_precolored_num(vector<LPColoring<GraphType, SolverType>::graph_vertex_type> const& vVertex) const 
 {
     uint32_t precoloredNum = 0;
     for (typename vector<graph_vertex_type>::const_iterator vi = vVertex.begin(), vie = vVertex.end(); vi != vie; ++vi)
@@ -917,13 +981,13 @@ uint32_t LPColoring<GraphType>::check_precolored_num(vector<LPColoring<GraphType
     return precoloredNum;
 }
 
-template <typename GraphType>
-void LPColoring<GraphType>::print_solution(vector<GRBVar> const& vColorBits) const 
+template <typename GraphType, typename SolverType>
+void LPColoring<GraphType, SolverType>::print_solution() const
 {
     const char* prefix = "";
-    for (uint32_t i = 0, ie = vColorBits.size(); i < ie; i += 2)
+    for (uint32_t i = 0, ie = m_vColorBitValue.size(); i < ie; i += 2)
     {
-        printf("%sv%u=(%g,%g)", prefix, i>>1, vColorBits[i].get(GRB_DoubleAttr_X), vColorBits[i+1].get(GRB_DoubleAttr_X));
+        printf("%sv%u=(%g,%g)", prefix, i>>1, m_vColorBitValue[i], m_vColorBitValue[i+1]);
         prefix = ", ";
     }
     printf("\n");
@@ -26,6 +26,7 @@
 //#include <boost/graph/kruskal_min_spanning_tree.hpp>
 //#include <boost/graph/prim_minimum_spanning_tree.hpp>
 //#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <limbo/containers/TaskPool.h>
 #include <limbo/string/String.h>
 #include <limbo/algorithms/coloring/Coloring.h>
 #if GUROBI == 1
@@ -49,6 +50,13 @@ namespace coloring
 /// Non-negative weight implies conflict edge, 
 /// while negative weight implies stitch edge. 
 /// 
+/// With heuristic(true), connected components are colored concurrently. 
+/// Each component is copied to a compact adjacency array with bitsets of remaining and selected vertices, 
+/// and every independent set is found by a greedy pass and local search with the same objective as the ILP, 
+/// i.e., the number of edges incident to the set. 
+/// With Gurobi, components leaving more than ilp_residual() vertices out of all independent sets 
+/// are solved again with the ILP, and the better solution is kept. 
+/// 
 /// @tparam GraphType graph type 
 template <typename GraphType>
 class MISColoring : public Coloring<GraphType>
@@ -74,10 +82,23 @@ class MISColoring : public Coloring<GraphType>
         /// @param g graph 
 		MISColoring(graph_type const& g) 
 			: base_type(g)
+            , m_heuristic(false)
+            , m_ilp_residual(0)
+            , m_num_ilp_components(0)
 		{}
 		/// destructor
 		virtual ~MISColoring() {}
 
+        /// use heuristic independent sets on components in parallel 
+        /// @param h true to enable 
+        void heuristic(bool h) {m_heuristic = h;}
+        /// set maximum number of vertices left out of all heuristic independent sets in a component 
+        /// before falling back to the ILP, which is only available with Gurobi 
+        /// @param n number of vertices 
+        void ilp_residual(uint32_t n) {m_ilp_residual = n;}
+        /// @return number of components solved again with the ILP in the last run 
+        uint32_t num_ilp_components() const {return m_num_ilp_components;}
+
 		/// set precolored vertex, not supported  
         /// param v vertex 
         /// param c color 
@@ -139,6 +160,9 @@ class MISColoring : public Coloring<GraphType>
 		/// @return objective value 
 		virtual double coloring()
         {
+            if (m_heuristic)
+                return coloring_heuristic();
+
             std::vector<int8_t> vVertexExcludeMark (boost::num_vertices(this->m_graph), 0); 
             std::vector<graph_vertex_type> vMISVertex; 
 
@@ -302,7 +326,7 @@ class MISColoring : public Coloring<GraphType>
             }
 
             //optimize model 
-            solver_type solver (&opt_model); 
+            solver_type solver (&opt_model, limbo::solvers::GurobiThreadEnv::get()); 
             int32_t opt_status = solver(&gurobiParams); 
 #ifdef DEBUG_MISCOLORING
             opt_model.print("graph.lp");
@@ -377,6 +401,378 @@ class MISColoring : public Coloring<GraphType>
             // return size of independent set  
             return vMISVertex.size();
         }
+
+        /// a connected component copied to compact arrays 
+        struct component_type 
+        {
+            std::vector<graph_vertex_type> vVertex; ///< vertices in the graph 
+            std::vector<uint32_t> vAdjBegin; ///< neighbors of each vertex start from here in vAdj 
+            std::vector<uint32_t> vAdj; ///< neighbors of each vertex 
+            std::vector<edge_weight_type> vAdjWeight; ///< weights of edges in vAdj 
+        };
+
+        /// color connected components concurrently with heuristic independent sets 
+		/// @return objective value 
+        double coloring_heuristic()
+        {
+            uint32_t vertex_num = boost::num_vertices(this->m_graph);
+            // connected components and the index of each vertex in its component 
+            m_mComponent.clear(); 
+            m_vLocal.assign(vertex_num, std::numeric_limits<uint32_t>::max()); 
+            std::vector<graph_vertex_type> vQueue; 
+            for (uint32_t v = 0; v < vertex_num; ++v)
+            {
+                if (m_vLocal[v] != std::numeric_limits<uint32_t>::max())
+                    continue; 
+                vQueue.assign(1, v); 
+                m_vLocal[v] = 0; 
+                for (uint32_t i = 0; i < vQueue.size(); ++i)
+                {
+                    typename boost::graph_traits<graph_type>::adjacency_iterator ui, uie;
+                    for (boost::tie(ui, uie) = boost::adjacent_vertices(vQueue[i], this->m_graph); ui != uie; ++ui)
+                    {
+                        if (m_vLocal[*ui] == std::numeric_limits<uint32_t>::max())
+                        {
+                            m_vLocal[*ui] = vQueue.size(); 
+                            vQueue.push_back(*ui); 
+                        }
+                    }
+                }
+                m_mComponent.push_back(vQueue); 
+            }
+            // large components first for load balance 
+            std::vector<uint32_t> vOrder (m_mComponent.size()); 
+            for (uint32_t i = 0; i < vOrder.size(); ++i)
+                vOrder[i] = i; 
+            std::stable_sort(vOrder.begin(), vOrder.end(), ComponentSizeGreater(m_mComponent)); 
+            m_vComponentOrder.swap(vOrder); 
+
+            m_num_ilp_components = 0; 
+            int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), this->m_threads);
+            numThreads = std::max(std::min(numThreads, (int32_t)m_mComponent.size()), 1);
+            ComponentKernel kernel = {this}; 
+            limbo::containers::parallel_for(0, m_vComponentOrder.size(), 1, numThreads, kernel); 
+
+            m_mComponent.clear(); 
+            m_vComponentOrder.clear(); 
+            m_vLocal.clear(); 
+#ifdef DEBUG_MISCOLORING
+            this->write_graph("final_output");
+#endif
+            return this->calc_cost(this->m_vColor); 
+        }
+        /// components in m_vComponentOrder colored by limbo::containers::parallel_for 
+        struct ComponentKernel
+        {
+            MISColoring* solver; ///< coloring object 
+            /// @param b first position in m_vComponentOrder 
+            /// @param e end position in m_vComponentOrder 
+            void operator()(std::size_t b, std::size_t e) const 
+            {
+                for (; b < e; ++b)
+                    solver->color_component(solver->m_mComponent[solver->m_vComponentOrder[b]]); 
+            }
+        };
+        /// color a component 
+        /// @param vVertex vertices of the component 
+        void color_component(std::vector<graph_vertex_type> const& vVertex)
+        {
+            component_type comp; 
+            comp.vVertex = vVertex; 
+            comp.vAdjBegin.assign(1, 0); 
+            for (typename std::vector<graph_vertex_type>::const_iterator vi = vVertex.begin(); vi != vVertex.end(); ++vi)
+            {
+                typename boost::graph_traits<graph_type>::out_edge_iterator ei, eie;
+                for (boost::tie(ei, eie) = boost::out_edges(*vi, this->m_graph); ei != eie; ++ei)
+                {
+                    graph_vertex_type u = boost::target(*ei, this->m_graph); 
+                    if (u == *vi) // skip self edges 
+                        continue; 
+                    comp.vAdj.push_back(m_vLocal[u]); 
+                    comp.vAdjWeight.push_back(boost::get(boost::edge_weight, this->m_graph, *ei)); 
+                }
+                comp.vAdjBegin.push_back(comp.vAdj.size()); 
+            }
+
+            uint32_t n = vVertex.size(); 
+            uint32_t num_words = (n+63)/64; 
+            std::vector<boost::uint64_t> vAlive (num_words, 0); 
+            for (uint32_t v = 0; v < n; ++v)
+                vAlive[v>>6] |= boost::uint64_t(1)<<(v&63); 
+            std::vector<int8_t> vColor (n, -1); 
+            uint32_t residual = n; 
+            for (int8_t c = 0; c < this->color_num(); ++c)
+            {
+                std::vector<boost::uint64_t> vSelected; 
+                heuristic_mis(comp, vAlive, vSelected); 
+                for (uint32_t w = 0; w < num_words; ++w)
+                {
+                    for (boost::uint64_t bits = vSelected[w]; bits; bits &= bits-1)
+                    {
+                        vColor[(w<<6)+__builtin_ctzll(bits)] = c; 
+                        --residual; 
+                    }
+                    vAlive[w] &= ~vSelected[w]; 
+                }
+            }
+            color_residual(comp, vColor); 
+
+#if GUROBI == 1
+            if (residual > m_ilp_residual)
+            {
+                // the ILP only sees this component 
+                std::vector<int8_t> vVertexExcludeMark (boost::num_vertices(this->m_graph), 1); 
+                for (uint32_t v = 0; v < n; ++v)
+                    vVertexExcludeMark[vVertex[v]] = 0; 
+                std::vector<int8_t> vILPColor (n, -1); 
+                std::vector<graph_vertex_type> vMISVertex; 
+                for (int8_t c = 0; c < this->color_num(); ++c)
+                {
+                    vMISVertex.clear(); 
+                    computeMWISILP(vVertexExcludeMark, vMISVertex); 
+                    for (typename std::vector<graph_vertex_type>::const_iterator vi = vMISVertex.begin(); vi != vMISVertex.end(); ++vi)
+                    {
+                        vILPColor[m_vLocal[*vi]] = c; 
+                        vVertexExcludeMark[*vi] = 1; 
+                    }
+                }
+                color_residual(comp, vILPColor); 
+                if (component_cost(comp, vILPColor) < component_cost(comp, vColor))
+                    vColor.swap(vILPColor); 
+                __sync_fetch_and_add(&m_num_ilp_components, 1); 
+            }
+#else 
+            (void)residual; 
+#endif
+            // components have disjoint vertices 
+            for (uint32_t v = 0; v < n; ++v)
+                this->m_vColor[vVertex[v]] = vColor[v]; 
+        }
+        /// @brief find an independent set among remaining vertices maximizing the number of incident edges, 
+        /// the same objective as @ref computeMWISILP. 
+        /// A vertex is worth its number of remaining neighbors. 
+        /// A greedy pass adds vertices from the largest worth, 
+        /// then local search replaces selected neighbors of a vertex by the vertex if it is worth more, 
+        /// or a selected vertex by two of its neighbors if they are worth more. 
+        /// @param comp component 
+        /// @param vAlive bitset of remaining vertices 
+        /// @param vSelected bitset of the independent set 
+        void heuristic_mis(component_type const& comp, std::vector<boost::uint64_t> const& vAlive, std::vector<boost::uint64_t>& vSelected) const 
+        {
+            uint32_t n = comp.vVertex.size(); 
+            vSelected.assign(vAlive.size(), 0); 
+            // worth of remaining vertices and number of selected neighbors 
+            std::vector<uint32_t> vWorth (n, 0); 
+            std::vector<uint32_t> vTight (n, 0); 
+            std::vector<uint32_t> vOrder; 
+            for (uint32_t v = 0; v < n; ++v)
+            {
+                if (!test_bit(vAlive, v))
+                    continue; 
+                for (uint32_t k = comp.vAdjBegin[v]; k < comp.vAdjBegin[v+1]; ++k)
+                    vWorth[v] += test_bit(vAlive, comp.vAdj[k]); 
+                vOrder.push_back(v); 
+            }
+            std::stable_sort(vOrder.begin(), vOrder.end(), WorthGreater(vWorth)); 
+            for (std::vector<uint32_t>::const_iterator vi = vOrder.begin(); vi != vOrder.end(); ++vi)
+                if (vTight[*vi] == 0)
+                    select_vertex(comp, *vi, vSelected, vTight); 
+
+            // distinct selected neighbors, marked by stamps 
+            std::vector<uint32_t> vStamp (n, 0); 
+            uint32_t stamp = 0; 
+            std::vector<uint32_t> vCandidate; 
+            bool improved = true; 
+            for (uint32_t pass = 0; improved && pass < max_local_search_passes; ++pass)
+            {
+                improved = false; 
+                for (std::vector<uint32_t>::const_iterator vi = vOrder.begin(); vi != vOrder.end(); ++vi)
+                {
+                    uint32_t v = *vi; 
+                    if (test_bit(vSelected, v) || vTight[v] == 0)
+                        continue; 
+                    // swap v with its selected neighbors 
+                    uint32_t worth = 0; 
+                    ++stamp; 
+                    for (uint32_t k = comp.vAdjBegin[v]; k < comp.vAdjBegin[v+1]; ++k)
+                    {
+                        uint32_t u = comp.vAdj[k]; 
+                        if (test_bit(vSelected, u) && vStamp[u] != stamp)
+                        {
+                            vStamp[u] = stamp; 
+                            worth += vWorth[u]; 
+                        }
+                    }
+                    if (vWorth[v] > worth)
+                    {
+                        vCandidate.clear(); 
+                        for (uint32_t k = comp.vAdjBegin[v]; k < comp.vAdjBegin[v+1]; ++k)
+                        {
+                            if (test_bit(vSelected, comp.vAdj[k]))
+                            {
+                                unselect_vertex(comp, comp.vAdj[k], vSelected, vTight); 
+                                vCandidate.push_back(comp.vAdj[k]); 
+                            }
+                        }
+                        select_vertex(comp, v, vSelected, vTight); 
+                        for (std::vector<uint32_t>::const_iterator ui = vCandidate.begin(); ui != vCandidate.end(); ++ui)
+                            select_free_neighbors(comp, *ui, vAlive, vSelected, vTight); 
+                        improved = true; 
+                    }
+                }
+                for (std::vector<uint32_t>::const_iterator ui = vOrder.begin(); ui != vOrder.end(); ++ui)
+                {
+                    uint32_t u = *ui; 
+                    if (!test_bit(vSelected, u))
+                        continue; 
+                    // neighbors only blocked by u 
+                    vCandidate.clear(); 
+                    for (uint32_t k = comp.vAdjBegin[u]; k < comp.vAdjBegin[u+1]; ++k)
+                    {
+                        uint32_t v = comp.vAdj[k]; 
+                        if (test_bit(vAlive, v) && vTight[v] == 1)
+                            vCandidate.push_back(v); 
+                    }
+                    // swap u with two non-adjacent candidates 
+                    for (uint32_t i = 0; i < vCandidate.size() && test_bit(vSelected, u); ++i)
+                    {
+                        uint32_t v1 = vCandidate[i]; 
+                        ++stamp; 
+                        for (uint32_t k = comp.vAdjBegin[v1]; k < comp.vAdjBegin[v1+1]; ++k)
+                            vStamp[comp.vAdj[k]] = stamp; 
+                        for (uint32_t j = i+1; j < vCandidate.size(); ++j)
+                        {
+                            uint32_t v2 = vCandidate[j]; 
+                            if (vStamp[v2] != stamp && v2 != v1 && vWorth[v1]+vWorth[v2] > vWorth[u])
+                            {
+                                unselect_vertex(comp, u, vSelected, vTight); 
+                                select_vertex(comp, v1, vSelected, vTight); 
+                                select_vertex(comp, v2, vSelected, vTight); 
+                                select_free_neighbors(comp, u, vAlive, vSelected, vTight); 
+                                improved = true; 
+                                break; 
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        /// add a vertex to the independent set 
+        /// @param comp component 
+        /// @param v vertex 
+        /// @param vSelected bitset of the independent set 
+        /// @param vTight number of selected neighbors 
+        void select_vertex(component_type const& comp, uint32_t v, std::vector<boost::uint64_t>& vSelected, std::vector<uint32_t>& vTight) const 
+        {
+            vSelected[v>>6] |= boost::uint64_t(1)<<(v&63); 
+            for (uint32_t k = comp.vAdjBegin[v]; k < comp.vAdjBegin[v+1]; ++k)
+                ++vTight[comp.vAdj[k]]; 
+        }
+        /// remove a vertex from the independent set 
+        /// @param comp component 
+        /// @param v vertex 
+        /// @param vSelected bitset of the independent set 
+        /// @param vTight number of selected neighbors 
+        void unselect_vertex(component_type const& comp, uint32_t v, std::vector<boost::uint64_t>& vSelected, std::vector<uint32_t>& vTight) const 
+        {
+            vSelected[v>>6] &= ~(boost::uint64_t(1)<<(v&63)); 
+            for (uint32_t k = comp.vAdjBegin[v]; k < comp.vAdjBegin[v+1]; ++k)
+                --vTight[comp.vAdj[k]]; 
+        }
+        /// add neighbors of a removed vertex which have no selected neighbors any more 
+        /// @param comp component 
+        /// @param v removed vertex 
+        /// @param vAlive bitset of remaining vertices 
+        /// @param vSelected bitset of the independent set 
+        /// @param vTight number of selected neighbors 
+        void select_free_neighbors(component_type const& comp, uint32_t v, std::vector<boost::uint64_t> const& vAlive, std::vector<boost::uint64_t>& vSelected, std::vector<uint32_t>& vTight) const 
+        {
+            for (uint32_t k = comp.vAdjBegin[v]; k < comp.vAdjBegin[v+1]; ++k)
+            {
+                uint32_t u = comp.vAdj[k]; 
+                if (vTight[u] == 0 && test_bit(vAlive, u) && !test_bit(vSelected, u))
+                    select_vertex(comp, u, vSelected, vTight); 
+            }
+        }
+        /// color vertices not in any independent set greedily 
+        /// @param comp component 
+        /// @param vColor colors of vertices in the component 
+        void color_residual(component_type const& comp, std::vector<int8_t>& vColor) const 
+        {
+            for (uint32_t v = 0; v < comp.vVertex.size(); ++v)
+            {
+                if (vColor[v] >= 0)
+                    continue; 
+                int8_t bestColor = 0; 
+                edge_weight_type bestCost = std::numeric_limits<edge_weight_type>::max(); 
+                for (int8_t c = 0; c < this->color_num(); ++c)
+                {
+                    edge_weight_type curCost = 0; 
+                    for (uint32_t k = comp.vAdjBegin[v]; k < comp.vAdjBegin[v+1]; ++k)
+                        if (vColor[comp.vAdj[k]] == c)
+                            curCost += std::max((edge_weight_type)1, comp.vAdjWeight[k]); 
+                    if (curCost < bestCost)
+                    {
+                        bestCost = curCost;
+                        bestColor = c;
+                    }
+                }
+                vColor[v] = bestColor; 
+            }
+        }
+        /// @param comp component 
+        /// @param vColor colors of vertices in the component 
+        /// @return cost of the component in the same way as @ref limbo::algorithms::coloring::Coloring::calc_cost 
+        double component_cost(component_type const& comp, std::vector<int8_t> const& vColor) const 
+        {
+            double cost = 0; 
+            for (uint32_t v = 0; v < comp.vVertex.size(); ++v)
+            {
+                for (uint32_t k = comp.vAdjBegin[v]; k < comp.vAdjBegin[v+1]; ++k)
+                {
+                    edge_weight_type w = comp.vAdjWeight[k]; 
+                    if (w >= 0) // conflict edge 
+                        cost += (vColor[v] == vColor[comp.vAdj[k]])*w; 
+                    else // stitch edge 
+                        cost -= (vColor[v] != vColor[comp.vAdj[k]])*w*this->stitch_weight(); 
+                }
+            }
+            return cost/2; // each edge is counted twice 
+        }
+        /// @param v bitset 
+        /// @param i index 
+        /// @return whether bit \a i is set 
+        static bool test_bit(std::vector<boost::uint64_t> const& v, uint32_t i) {return (v[i>>6]>>(i&63))&1;}
+
+        /// compare components by sizes 
+        struct ComponentSizeGreater 
+        {
+            std::vector<std::vector<graph_vertex_type> > const& mComponent; ///< components 
+            /// constructor 
+            /// @param m components 
+            ComponentSizeGreater(std::vector<std::vector<graph_vertex_type> > const& m) : mComponent(m) {}
+            /// @return true if component \a i is larger than component \a j 
+            bool operator()(uint32_t i, uint32_t j) const {return mComponent[i].size() > mComponent[j].size();}
+        };
+        /// compare vertices by worth 
+        struct WorthGreater 
+        {
+            std::vector<uint32_t> const& vWorth; ///< worth of vertices 
+            /// constructor 
+            /// @param v worth of vertices 
+            WorthGreater(std::vector<uint32_t> const& v) : vWorth(v) {}
+            /// @return true if vertex \a i is worth more than vertex \a j 
+            bool operator()(uint32_t i, uint32_t j) const {return vWorth[i] > vWorth[j];}
+        };
+
+        bool m_heuristic; ///< whether to use heuristic independent sets 
+        uint32_t m_ilp_residual; ///< maximum number of vertices out of heuristic independent sets before falling back to the ILP 
+        uint32_t m_num_ilp_components; ///< number of components solved with the ILP 
+        std::vector<std::vector<graph_vertex_type> > m_mComponent; ///< connected components 
+        std::vector<uint32_t> m_vComponentOrder; ///< components from the largest one 
+        std::vector<uint32_t> m_vLocal; ///< index of each vertex in its component 
+
+        static const uint32_t max_local_search_passes = 100; ///< maximum number of passes of local search 
 };
 
 } // namespace coloring
@@ -0,0 +1,306 @@
+/**
+ * @file   RandomizedRounding.h
+ * @brief  multi-start randomized rounding and refinement of fractional coloring solutions
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_RANDOMIZEDROUNDING
+#define LIMBO_ALGORITHMS_COLORING_RANDOMIZEDROUNDING
+
+#include <vector>
+#include <deque>
+#include <limits>
+#include <algorithm>
+#include <stdlib.h>
+#include <limbo/containers/TaskPool.h>
+#include <boost/cstdint.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/property_map/property_map.hpp>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+using boost::uint32_t;
+using boost::int32_t;
+using boost::int8_t;
+
+/// @class limbo::algorithms::coloring::RandomizedRounding
+/// Round a fractional solution of the two-bit coloring formulation many times and keep the best coloring.
+///
+/// Each trial rounds a bit to 1 with the probability of its fractional value,
+/// where bits (1, 1) of three coloring map to the last color like @ref limbo::algorithms::coloring::LPColoring.
+/// The coloring is then refined by moving single vertices to their cheapest colors.
+/// Costs of all colors for each vertex are kept and updated along the edges of a moved vertex,
+/// so a move costs the degree of the vertex.
+/// Trials are taken by threads and seeded by their ids, so the result does not depend on the number of threads.
+/// @tparam GraphType graph type
+template <typename GraphType>
+class RandomizedRounding
+{
+	public:
+        /// @nowarn
+		typedef GraphType graph_type;
+		typedef typename boost::graph_traits<graph_type>::vertex_descriptor graph_vertex_type;
+		typedef typename boost::graph_traits<graph_type>::edge_iterator edge_iterator_type;
+		typedef typename boost::property_traits<typename boost::property_map<graph_type, boost::edge_weight_t>::const_type>::value_type edge_weight_type;
+        /// @endnowarn
+
+		/// constructor
+		/// @param g graph, non-negative weights for conflict edges and negative weights for stitch edges
+		/// @param color_num number of colors
+		/// @param stitch_weight weight of stitches
+		/// @param vPrecolor precolors of vertices, negative if not precolored
+		/// @param vColorBit fractional values of two bits for each vertex
+		RandomizedRounding(graph_type const& g, int8_t color_num, double stitch_weight,
+				std::vector<int8_t> const& vPrecolor, std::vector<double> const& vColorBit);
+
+		/// set number of trials
+		/// @param t number of trials
+		void trials(uint32_t t) {m_trials = t;}
+		/// set number of threads
+		/// @param t number of threads
+		void threads(int32_t t) {m_threads = t;}
+		/// set random seed of the first trial, trial i uses seed+i
+		/// @param s seed
+		void seed(uint32_t s) {m_seed = s;}
+
+		/// run all trials
+		/// @param vColor best coloring solution
+		/// @return cost of \a vColor
+		double operator()(std::vector<int8_t>& vColor);
+		/// @param vColor coloring solution
+		/// @return cost of \a vColor
+		double cost(std::vector<int8_t> const& vColor) const;
+		/// move single vertices to their cheapest colors until no move reduces the cost
+		/// @param vColor coloring solution
+		/// @return cost of refined \a vColor
+		double refine(std::vector<int8_t>& vColor) const;
+
+	protected:
+		/// round the fractional solution randomly
+		/// @param trial trial id
+		/// @param vColor coloring solution
+		void round(uint32_t trial, std::vector<int8_t>& vColor) const;
+		/// run a range of trials
+		/// @param first first trial
+		/// @param last end trial
+		void run_trials(std::size_t first, std::size_t last);
+		/// trials run by limbo::containers::parallel_for
+		struct TrialKernel
+		{
+			RandomizedRounding* rr; ///< rounding object
+			/// @param b first trial
+			/// @param e end trial
+			void operator()(std::size_t b, std::size_t e) const {rr->run_trials(b, e);}
+		};
+
+		uint32_t m_num_vertices; ///< number of vertices
+		int8_t m_color_num; ///< number of colors
+		std::vector<int8_t> const& m_vPrecolor; ///< precolors of vertices
+		std::vector<double> const& m_vColorBit; ///< fractional values of two bits for each vertex
+		std::vector<uint32_t> m_vAdjBegin; ///< offset of neighbors of each vertex
+		std::vector<uint32_t> m_vAdj; ///< neighbors
+		std::vector<double> m_vAdjCost; ///< cost of violating the edge to each neighbor
+		std::vector<char> m_vAdjStitch; ///< true if the edge to a neighbor is a stitch edge, violated by different colors
+
+		uint32_t m_trials; ///< number of trials
+		int32_t m_threads; ///< number of threads
+		uint32_t m_seed; ///< random seed of the first trial
+		std::vector<std::vector<int8_t> > m_mTrialColor; ///< coloring solution of each trial
+		std::vector<double> m_vTrialCost; ///< cost of each trial
+};
+
+template <typename GraphType>
+RandomizedRounding<GraphType>::RandomizedRounding(graph_type const& g, int8_t color_num, double stitch_weight,
+		std::vector<int8_t> const& vPrecolor, std::vector<double> const& vColorBit)
+	: m_num_vertices(boost::num_vertices(g))
+	, m_color_num(color_num)
+	, m_vPrecolor(vPrecolor)
+	, m_vColorBit(vColorBit)
+	, m_trials(1)
+	, m_threads(1)
+	, m_seed(0)
+{
+	// adjacency in flat arrays, shared by all trials
+	m_vAdjBegin.assign(m_num_vertices+1, 0);
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+	{
+		m_vAdjBegin[boost::source(*ei, g)+1] += 1;
+		m_vAdjBegin[boost::target(*ei, g)+1] += 1;
+	}
+	for (uint32_t v = 0; v < m_num_vertices; ++v)
+		m_vAdjBegin[v+1] += m_vAdjBegin[v];
+	m_vAdj.resize(m_vAdjBegin.back());
+	m_vAdjCost.resize(m_vAdjBegin.back());
+	m_vAdjStitch.resize(m_vAdjBegin.back());
+	std::vector<uint32_t> vPos (m_vAdjBegin.begin(), m_vAdjBegin.end()-1);
+	for (boost::tie(ei, eie) = boost::edges(g); ei != eie; ++ei)
+	{
+		uint32_t s = boost::source(*ei, g);
+		uint32_t t = boost::target(*ei, g);
+		edge_weight_type w = boost::get(boost::edge_weight, g, *ei);
+		double c = (w < 0)? -w*stitch_weight : w;
+		m_vAdj[vPos[s]] = t;
+		m_vAdjCost[vPos[s]] = c;
+		m_vAdjStitch[vPos[s]++] = (w < 0);
+		m_vAdj[vPos[t]] = s;
+		m_vAdjCost[vPos[t]] = c;
+		m_vAdjStitch[vPos[t]++] = (w < 0);
+	}
+}
+
+template <typename GraphType>
+double RandomizedRounding<GraphType>::operator()(std::vector<int8_t>& vColor)
+{
+	m_mTrialColor.assign(m_trials, std::vector<int8_t>());
+	m_vTrialCost.assign(m_trials, std::numeric_limits<double>::max());
+
+	int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), m_threads);
+	numThreads = std::max(std::min(numThreads, (int32_t)m_trials), 1);
+	TrialKernel kernel = {this};
+	limbo::containers::parallel_for(0, m_trials, 1, numThreads, kernel);
+
+	if (m_trials == 0)
+	{
+		vColor.clear();
+		return std::numeric_limits<double>::max();
+	}
+	// the first trial wins ties, independent of the schedule
+	uint32_t best = 0;
+	for (uint32_t i = 1; i < m_trials; ++i)
+		if (m_vTrialCost[i] < m_vTrialCost[best])
+			best = i;
+	vColor.swap(m_mTrialColor[best]);
+	m_mTrialColor.clear();
+	return m_vTrialCost[best];
+}
+
+template <typename GraphType>
+double RandomizedRounding<GraphType>::cost(std::vector<int8_t> const& vColor) const
+{
+	double total = 0;
+	for (uint32_t v = 0; v < m_num_vertices; ++v)
+	{
+		for (uint32_t i = m_vAdjBegin[v]; i != m_vAdjBegin[v+1]; ++i)
+		{
+			uint32_t u = m_vAdj[i];
+			if (u < v && (vColor[u] == vColor[v]) != (bool)m_vAdjStitch[i])
+				total += m_vAdjCost[i];
+		}
+	}
+	return total;
+}
+
+template <typename GraphType>
+double RandomizedRounding<GraphType>::refine(std::vector<int8_t>& vColor) const
+{
+	// cost of each color for each vertex against its neighbors
+	std::vector<double> vCost (m_num_vertices*m_color_num, 0);
+	for (uint32_t v = 0; v < m_num_vertices; ++v)
+	{
+		double* pCost = &vCost[v*m_color_num];
+		for (uint32_t i = m_vAdjBegin[v]; i != m_vAdjBegin[v+1]; ++i)
+		{
+			int8_t cu = vColor[m_vAdj[i]];
+			if (m_vAdjStitch[i]) // violated by other colors
+			{
+				for (int8_t c = 0; c < m_color_num; ++c)
+					pCost[c] += m_vAdjCost[i];
+				pCost[cu] -= m_vAdjCost[i];
+			}
+			else
+				pCost[cu] += m_vAdjCost[i];
+		}
+	}
+
+	std::deque<uint32_t> vQueue;
+	std::vector<char> vQueued (m_num_vertices, false);
+	for (uint32_t v = 0; v < m_num_vertices; ++v)
+	{
+		if (m_vPrecolor[v] < 0)
+		{
+			vQueue.push_back(v);
+			vQueued[v] = true;
+		}
+	}
+	while (!vQueue.empty())
+	{
+		uint32_t v = vQueue.front();
+		vQueue.pop_front();
+		vQueued[v] = false;
+
+		double const* pCost = &vCost[v*m_color_num];
+		int8_t cv = vColor[v];
+		int8_t best = cv;
+		for (int8_t c = 0; c < m_color_num; ++c)
+			if (pCost[c] < pCost[best]-1e-9)
+				best = c;
+		if (best == cv)
+			continue;
+
+		// move v and update the costs of its neighbors
+		vColor[v] = best;
+		for (uint32_t i = m_vAdjBegin[v]; i != m_vAdjBegin[v+1]; ++i)
+		{
+			uint32_t u = m_vAdj[i];
+			double* pCostU = &vCost[u*m_color_num];
+			double w = (m_vAdjStitch[i])? -m_vAdjCost[i] : m_vAdjCost[i];
+			pCostU[cv] -= w;
+			pCostU[best] += w;
+			if (!vQueued[u] && m_vPrecolor[u] < 0)
+			{
+				vQueue.push_back(u);
+				vQueued[u] = true;
+			}
+		}
+	}
+
+	// each violated edge is counted by both ends
+	double total = 0;
+	for (uint32_t v = 0; v < m_num_vertices; ++v)
+		total += vCost[v*m_color_num+vColor[v]];
+	return total/2;
+}
+
+template <typename GraphType>
+void RandomizedRounding<GraphType>::round(uint32_t trial, std::vector<int8_t>& vColor) const
+{
+	unsigned int state = m_seed+trial;
+	vColor.resize(m_num_vertices);
+	for (uint32_t v = 0; v < m_num_vertices; ++v)
+	{
+		if (m_vPrecolor[v] >= 0)
+		{
+			vColor[v] = m_vPrecolor[v];
+			continue;
+		}
+		int8_t b[2];
+		for (uint32_t k = 0; k < 2; ++k)
+			b[k] = (rand_r(&state) < m_vColorBit[(v<<1)+k]*((double)RAND_MAX+1));
+		vColor[v] = std::min((b[0]<<1)+b[1], m_color_num-1);
+	}
+}
+
+template <typename GraphType>
+void RandomizedRounding<GraphType>::run_trials(std::size_t first, std::size_t last)
+{
+	for (std::size_t trial = first; trial < last; ++trial)
+	{
+		this->round(trial, m_mTrialColor[trial]);
+		m_vTrialCost[trial] = this->refine(m_mTrialColor[trial]);
+	}
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
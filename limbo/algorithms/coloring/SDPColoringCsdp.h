@@ -15,16 +15,20 @@
 #ifndef LIMBO_ALGORITHMS_COLORING_SDPCOLORINGCSDP
 #define LIMBO_ALGORITHMS_COLORING_SDPCOLORINGCSDP
 
+#include <cmath>
+#include <stdlib.h>
 #include <limbo/string/String.h>
 #include <limbo/algorithms/coloring/GraphSimplification.h>
 #include <limbo/algorithms/coloring/Coloring.h>
 #include <limbo/algorithms/coloring/BacktrackColoring.h>
 #include <limbo/algorithms/partition/FMMultiWay.h>
 #include <limbo/containers/DisjointSet.h>
+#include <limbo/containers/TaskPool.h>
 
 // as the original csdp easy_sdp api is not very flexible to printlevel
 // I made small modification to support that 
 #include <limbo/solvers/api/CsdpEasySdpApi.h>
+#include <limbo/solvers/LowRankSdp.h>
 
 /// namespace for Limbo 
 namespace limbo 
@@ -37,14 +41,28 @@ namespace coloring
 {
 
 /// @class limbo::algorithms::coloring::SDPColoringCsdp
-/// Thread control is not available as Csdp does not provide any API for that. \n
+/// Csdp takes the number of threads from @ref threads through @ref limbo::solvers::setCsdpNumThreads, 
+/// so many components colored concurrently should set 1 thread each. 
+/// Its working storage is kept in a @ref limbo::solvers::CsdpWorkspace, of the calling thread by default, 
+/// and reused by the SDPs of later components. \n
+/// Csdp solves the dense matrix with an interior point method in \f$O(N^3)\f$, 
+/// which limits the size of graphs to a few thousand vertices. 
+/// For larger graphs, use @ref limbo::solvers::LowRankSdp by sdp_solver(LOW_RANK), 
+/// which factorizes \f$X = V V^T\f$ with a small rank and takes gradient steps in parallel threads. 
+/// Its rows give \f$x_{ij} = v_i^T v_j\f$ for the same rounding, 
+/// while only pairs of vertices sharing an edge or a neighbor are checked for merging. \n
+/// With @ref rounding_trials, the same SDP solution is also rounded many times by random projections: 
+/// each trial colors a vertex by the closest of k Gaussian directions to its vector, 
+/// refines the coloring with @ref limbo::algorithms::partition::FMMultiWay, 
+/// and the best trial replaces the threshold rounding if it has a smaller cost. 
+/// Trials are taken by threads and seeded by their ids, so the result does not depend on the number of threads. \n
 /// 
 /// SDP formulation from Bei Yu's TCAD 2015 paper \cite TPL_TCAD2015_Yu 
 /// 
 /// f{eqnarray*}{
-/// & min. & C X, \\
-/// & s.t. & x_{ii} = 1, \forall i \in V, \\
-/// &      & x_{ij} \ge -0.5, \forall (i, j) \in E, \\
+/// & min. & C X, \\[0pt]
+/// & s.t. & x_{ii} = 1, \forall i \in V, \\[0pt]
+/// &      & x_{ij} \ge -0.5, \forall (i, j) \in E, \\[0pt]
 /// &      & X \succeq 0, \textrm{(PSD)}. 
 /// \f}
 /// Note that Csdp only solves equality problem for constraints, 
@@ -74,8 +92,18 @@ class SDPColoringCsdp : public Coloring<GraphType>
         using typename base_type::edge_weight_type;
 		using typename base_type::ColorNumType;
         typedef typename base_type::EdgeHashType edge_hash_type;
+        typedef limbo::containers::DisjointSet disjoint_set_type;
+        typedef disjoint_set_type::SubsetHelper<graph_vertex_type, uint32_t> subset_helper_type;
+        typedef limbo::solvers::LowRankSdp<double> low_rank_solver_type;
         /// @endnowarn
 
+        /// solvers for the SDP 
+        enum SdpSolverType 
+        {
+            CSDP, ///< interior point method by Csdp 
+            LOW_RANK ///< low-rank factorization by @ref limbo::solvers::LowRankSdp 
+        };
+
         /// @class limbo::algorithms::coloring::SDPColoringCsdp::FMGainCalcType
         /// compute the gain when moving a vertex from one partition to another 
         struct FMGainCalcType
@@ -118,6 +146,17 @@ class SDPColoringCsdp : public Coloring<GraphType>
                 }
                 return gain;
             }
+            /// collect vertices whose gains change when a vertex moves, 
+            /// so that @ref limbo::algorithms::partition::FMMultiWay caches gains 
+            /// @param v moved vertex 
+            /// @param vVertex neighbors of \a v are appended 
+            void affected_vertices(int32_t v, std::vector<int32_t>& vVertex) const
+            {
+                typedef typename boost::graph_traits<graph_type>::adjacency_iterator adjacency_iterator_type;
+                adjacency_iterator_type vi, vie;
+                for (boost::tie(vi, vie) = boost::adjacent_vertices(v, graph); vi != vie; ++vi)
+                    vVertex.push_back(*vi);
+            }
         };
 		/// constructor
         /// @param g graph 
@@ -125,6 +164,21 @@ class SDPColoringCsdp : public Coloring<GraphType>
 		/// destructor
 		virtual ~SDPColoringCsdp() {}
 
+        /// set solver for the SDP 
+        /// @param s solver type 
+        void sdp_solver(SdpSolverType s) {m_sdp_solver = s;}
+        /// @return solver for the SDP 
+        SdpSolverType sdp_solver() const {return m_sdp_solver;}
+        /// set working storage of Csdp 
+        /// @param w workspace, not owned, the one of the calling thread if NULL 
+        void csdp_workspace(limbo::solvers::CsdpWorkspace* w) {m_csdp_workspace = w;}
+        /// set number of randomized rounding trials from the SDP solution, run in parallel 
+        /// @param t number of trials, 0 to disable 
+        void rounding_trials(uint32_t t) {m_rounding_trials = t;}
+        /// set random seed of the first rounding trial, trial i uses seed+i 
+        /// @param s seed 
+        void rounding_seed(uint32_t s) {m_rounding_seed = s;}
+
         /// for debug 
         /// write sdp solution to file 
         /// @param filename file name 
@@ -135,9 +189,31 @@ class SDPColoringCsdp : public Coloring<GraphType>
         /// @param block compact representation of a matrix 
         void print_blockrec(const char* label, blockrec const& block) const; 
 	protected:
+        /// shared data of the randomized rounding trials 
+        struct RoundingTrials
+        {
+            SDPColoringCsdp const* coloring; ///< coloring object 
+            graph_type const* graph; ///< graph weighted by the costs of edges, refined by FM 
+            double const* pVector; ///< vectors of vertices, row by row 
+            uint32_t dim; ///< dimension of the vectors 
+            std::vector<std::vector<int8_t> > mColor; ///< coloring solution of each trial 
+            std::vector<double> vCost; ///< cost of each trial 
+        };
+        /// trials run by limbo::containers::parallel_for 
+        struct RoundingKernel
+        {
+            RoundingTrials* rt; ///< shared data of the trials 
+            /// @param b first trial 
+            /// @param e end trial 
+            void operator()(std::size_t b, std::size_t e) const {rt->coloring->run_rounding_trials(*rt, b, e);}
+        };
+
         /// kernel coloring algorithm 
 		/// @return objective value 
 		virtual double coloring();
+        /// solve the SDP by @ref limbo::solvers::LowRankSdp and round the solution 
+		/// @return objective value 
+        double coloring_low_rank();
 
         /// helper functions 
         /// construct blockrec in C for objective 
@@ -163,6 +239,34 @@ class SDPColoringCsdp : public Coloring<GraphType>
         /// Then we color the merged graph. 
         /// @param X variable matrix X 
         void round_sol(struct blockmatrix const& X);
+        /// Round low-rank sdp solution in the same way. 
+        /// Vertices sharing an edge or a neighbor are merged if their vectors are close. 
+        /// @param sdp solved low-rank sdp 
+        void round_sol(low_rank_solver_type const& sdp);
+        /// factorize block 1 of the Csdp solution, \f$X = V V^T\f$, by Cholesky decomposition skipping dependent columns 
+        /// @param X variable matrix X 
+        /// @param vVector rows of V, the vectors of vertices 
+        /// @param dim number of columns of V 
+        void sdp_vectors(struct blockmatrix const& X, std::vector<double>& vVector, uint32_t& dim) const;
+        /// run randomized rounding trials from vectors of vertices in parallel, 
+        /// and keep the best one if it is better than the current coloring 
+        /// @param pVector vectors of vertices, row by row 
+        /// @param dim dimension of the vectors 
+        void randomized_rounding(double const* pVector, uint32_t dim);
+        /// color each vertex by the closest of random Gaussian directions to its vector 
+        /// @param trial trial id, added to the seed 
+        /// @param pVector vectors of vertices, row by row 
+        /// @param dim dimension of the vectors 
+        /// @param vColor coloring solution 
+        void round_by_projection(uint32_t trial, double const* pVector, uint32_t dim, std::vector<int8_t>& vColor) const;
+        /// run a range of trials 
+        /// @param rt shared data of the trials 
+        /// @param first first trial 
+        /// @param last end trial 
+        void run_rounding_trials(RoundingTrials& rt, uint32_t first, uint32_t last) const;
+        /// construct merged graph from subsets of merged vertices and color it 
+        /// @param gp subsets of merged vertices 
+        void color_merged_vertices(subset_helper_type& gp);
         /// coloring merged graph 
         /// @param mg graph 
         /// @param vMColor coloring solutions 
@@ -182,12 +286,20 @@ class SDPColoringCsdp : public Coloring<GraphType>
 
         double m_rounding_lb; ///< if SDP solution x < m_rounding_lb, take x as -0.5
         double m_rounding_ub; ///< if SDP solution x > m_rounding_ub, take x as 1.0
+        SdpSolverType m_sdp_solver; ///< solver for the SDP 
+        limbo::solvers::CsdpWorkspace* m_csdp_workspace; ///< working storage of Csdp, the one of the calling thread if NULL 
+        uint32_t m_rounding_trials; ///< number of randomized rounding trials 
+        uint32_t m_rounding_seed; ///< random seed of the first rounding trial 
         const static uint32_t max_backtrack_num_vertices = 6; ///< maximum number of graph size that @ref limbo::algorithms::coloring::BacktrackColoring can handle
 };
 
 template <typename GraphType>
 SDPColoringCsdp<GraphType>::SDPColoringCsdp(SDPColoringCsdp<GraphType>::graph_type const& g) 
     : base_type(g)
+    , m_sdp_solver(CSDP)
+    , m_csdp_workspace(NULL)
+    , m_rounding_trials(0)
+    , m_rounding_seed(0)
 {
     m_rounding_lb = -0.4;
     m_rounding_ub = 0.93;
@@ -196,7 +308,9 @@ SDPColoringCsdp<GraphType>::SDPColoringCsdp(SDPColoringCsdp<GraphType>::graph_ty
 template <typename GraphType>
 double SDPColoringCsdp<GraphType>::coloring()
 {
-    std::cout<<"start csdp!";
+    if (m_sdp_solver == LOW_RANK)
+        return coloring_low_rank();
+    limboScopedTimer("SDPColoringCsdp::csdp");
     clock_t solve_start = clock();
     // Since Csdp is written in C, the api here is also in C 
     // Please refer to the documation of Csdp for different notations 
@@ -263,10 +377,10 @@ double SDPColoringCsdp<GraphType>::coloring()
     // block 2 for slack variables 
     // this block is all 0s, so we use diagonal format to represent  
     construct_objectve_blockrec(C, 2, num_conflict_edges, DIAG);
-//#ifdef DEBUG_SDPCOLORING
+#ifdef DEBUG_SDPCOLORING
     print_blockrec("C.blocks[1].data.mat", C.blocks[1]);
     print_blockrec("C.blocks[2].data.vec", C.blocks[2]);
-//#endif
+#endif
 
     // setup right hand side of constraints b
     // the order is first for conflict edges and then for vertices  
@@ -361,8 +475,15 @@ double SDPColoringCsdp<GraphType>::coloring()
     // solve sdp 
     // objective value is (dobj+pobj)/2
     //int ret = easy_sdp(num_variables, num_constraints, C, b, constraints, 0.0, &X, &y, &Z, &pobj, &dobj);
-    int ret = limbo::solvers::easy_sdp_ext<int>(num_variables, num_constraints, C, b, constraints, 0.0, &X, &y, &Z, &pobj, &dobj, params, printlevel);
+    limbo::solvers::setCsdpNumThreads(this->m_threads);
+    int ret = limbo::solvers::easy_sdp_ext<int>(num_variables, num_constraints, C, b, constraints, 0.0, &X, &y, &Z, &pobj, &dobj, params, printlevel, 
+            (m_csdp_workspace)? *m_csdp_workspace : limbo::solvers::CsdpWorkspace::threadLocal());
     limboAssertMsg(ret == 0, "SDP failed");
+    if (this->m_collect_statistics)
+    {
+        this->m_statistics.num_variables = num_variables;
+        this->m_statistics.num_constraints = num_constraints;
+    }
 
 // #ifdef DEBUG_LIWEI
     clock_t solve_end = clock();
@@ -370,6 +491,13 @@ double SDPColoringCsdp<GraphType>::coloring()
 //#endif
     // round result to get colors 
     round_sol(X);
+    if (m_rounding_trials > 0)
+    {
+        std::vector<double> vVector; 
+        uint32_t dim = 0; 
+        sdp_vectors(X, vVector, dim);
+        randomized_rounding((vVector.empty())? NULL : &vVector[0], dim);
+    }
 
     // Free storage allocated for the problem and return.
     free_prob(num_variables, num_constraints, C, b, constraints, X, y, Z);
@@ -386,6 +514,52 @@ double SDPColoringCsdp<GraphType>::coloring()
     return final_cost;
 }
 
+template <typename GraphType>
+double SDPColoringCsdp<GraphType>::coloring_low_rank()
+{
+    limboScopedTimer("SDPColoringCsdp::low_rank");
+    clock_t solve_start = clock();
+    limboAssertMsg(!this->has_precolored(), "SDP coloring does not support precolored layout yet");
+
+    // same formulation as Csdp, but lower bounds of conflict edges need no slack variables 
+    uint32_t num_vertices = boost::num_vertices(this->m_graph);
+    double beta = -1.0/(this->color_num()-1.0); // lower bound of xij for conflict edges 
+    low_rank_solver_type sdp (num_vertices);
+    uint32_t num_conflict_edges = 0;
+    edge_iterator_type ei, eie; 
+    for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
+    {
+        graph_vertex_type s = boost::source(*ei, this->m_graph);
+        graph_vertex_type t = boost::target(*ei, this->m_graph);
+        if (s == t) continue;
+        if (this->edge_weight(*ei) >= 0) // conflict edge 
+        {
+            sdp.add_term(s, t, 1, beta);
+            ++num_conflict_edges;
+        }
+        else // stitch edge 
+            sdp.add_term(s, t, -this->stitch_weight());
+    }
+    sdp.threads(this->m_threads);
+    sdp();
+    if (this->m_collect_statistics)
+    {
+        // entries of the factor, with unit diagonals and lower bounds of conflict edges as constraints 
+        this->m_statistics.num_variables = num_vertices*sdp.dimension();
+        this->m_statistics.num_constraints = num_vertices+num_conflict_edges;
+        this->m_statistics.num_iterations = sdp.iterations();
+    }
+
+    clock_t solve_end = clock();
+    limboPrint(kDEBUG, "low-rank SDP solver takes %g seconds with %u nodes, %u iterations\n", (double)(solve_end - solve_start)/CLOCKS_PER_SEC, num_vertices, sdp.iterations());
+    // round result to get colors 
+    round_sol(sdp);
+    if (m_rounding_trials > 0 && num_vertices > 0)
+        randomized_rounding(sdp.vector(0), sdp.dimension());
+
+    return this->calc_cost(this->m_vColor);
+}
+
 template <typename GraphType>
 void SDPColoringCsdp<GraphType>::construct_objectve_blockrec(blockmatrix& C, int32_t blocknum, int32_t blocksize, blockcat blockcategory) const 
 {
@@ -446,8 +620,7 @@ void SDPColoringCsdp<GraphType>::round_sol(struct blockmatrix const& X)
     // merge vertices with SDP solution with disjoint set 
     std::vector<graph_vertex_type> vParent (boost::num_vertices(this->m_graph));
     std::vector<uint32_t> vRank (vParent.size());
-    typedef limbo::containers::DisjointSet disjoint_set_type;
-    disjoint_set_type::SubsetHelper<graph_vertex_type, uint32_t> gp (vParent, vRank);
+    subset_helper_type gp (vParent, vRank);
     // check SDP solution in X 
     // we are only interested in block 1 
     struct blockrec const& block = X.blocks[1];
@@ -459,6 +632,172 @@ void SDPColoringCsdp<GraphType>::round_sol(struct blockmatrix const& X)
             if (ent > m_rounding_ub) // merge vertices if SDP solution rounded to 1.0
                 disjoint_set_type::union_set(gp, i-1, j-1); // Csdp array starts from 1 instead of 0
         }
+    color_merged_vertices(gp);
+}
+
+template <typename GraphType>
+void SDPColoringCsdp<GraphType>::round_sol(typename SDPColoringCsdp<GraphType>::low_rank_solver_type const& sdp)
+{
+    std::vector<graph_vertex_type> vParent (boost::num_vertices(this->m_graph));
+    std::vector<uint32_t> vRank (vParent.size());
+    subset_helper_type gp (vParent, vRank);
+    typedef typename boost::graph_traits<graph_type>::adjacency_iterator adjacency_iterator_type;
+    adjacency_iterator_type ui, uie, wi, wie; 
+    for (uint32_t i = 0, ie = vParent.size(); i != ie; ++i)
+        for (boost::tie(ui, uie) = boost::adjacent_vertices(i, this->m_graph); ui != uie; ++ui)
+        {
+            graph_vertex_type u = *ui;
+            if (u > i && sdp.inner(i, u) > m_rounding_ub) 
+                disjoint_set_type::union_set(gp, i, u);
+            // vertices sharing neighbor u 
+            for (boost::tie(wi, wie) = boost::adjacent_vertices(u, this->m_graph); wi != wie; ++wi)
+                if (*wi > i && sdp.inner(i, *wi) > m_rounding_ub)
+                    disjoint_set_type::union_set(gp, i, *wi);
+        }
+    color_merged_vertices(gp);
+}
+
+template <typename GraphType>
+void SDPColoringCsdp<GraphType>::sdp_vectors(struct blockmatrix const& X, std::vector<double>& vVector, uint32_t& dim) const
+{
+    struct blockrec const& block = X.blocks[1];
+    limboAssertMsg(block.blockcategory == MATRIX, "mismatch of block category");
+    int32_t n = block.blocksize;
+    // rows of the lower triangular factor, column j is skipped if x_jj is explained by previous columns 
+    std::vector<double> vL ((std::size_t)n*n, 0.0);
+    std::vector<int32_t> vColumn; 
+    for (int32_t j = 0; j < n; ++j)
+    {
+        double* pj = &vL[(std::size_t)j*n];
+        double d = block.data.mat[ijtok(j+1, j+1, n)];
+        for (std::vector<int32_t>::const_iterator it = vColumn.begin(); it != vColumn.end(); ++it)
+            d -= pj[*it]*pj[*it];
+        if (d <= 1e-6) 
+            continue; 
+        double ljj = std::sqrt(d);
+        pj[j] = ljj;
+        for (int32_t i = j+1; i < n; ++i)
+        {
+            double* pi = &vL[(std::size_t)i*n];
+            double x = block.data.mat[ijtok(i+1, j+1, n)];
+            for (std::vector<int32_t>::const_iterator it = vColumn.begin(); it != vColumn.end(); ++it)
+                x -= pi[*it]*pj[*it];
+            pi[j] = x/ljj;
+        }
+        vColumn.push_back(j);
+    }
+    // keep the columns of the factor only 
+    dim = vColumn.size();
+    vVector.resize((std::size_t)n*dim);
+    for (int32_t i = 0; i < n; ++i)
+        for (uint32_t k = 0; k < dim; ++k)
+            vVector[(std::size_t)i*dim+k] = vL[(std::size_t)i*n+vColumn[k]];
+}
+
+template <typename GraphType>
+void SDPColoringCsdp<GraphType>::randomized_rounding(double const* pVector, uint32_t dim)
+{
+    limboScopedTimer("SDPColoringCsdp::randomized_rounding");
+    uint32_t num_vertices = boost::num_vertices(this->m_graph);
+    if (num_vertices == 0 || dim == 0)
+        return; 
+
+    // refined on the costs of calc_cost, conflict edges by their weights and stitch edges by weights times stitch weight 
+    graph_type wg (num_vertices); 
+    edge_iterator_type ei, eie; 
+    for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
+    {
+        graph_vertex_type s = boost::source(*ei, this->m_graph);
+        graph_vertex_type t = boost::target(*ei, this->m_graph);
+        if (s == t) continue;
+        edge_weight_type w = this->edge_weight(*ei);
+        if (w < 0) 
+            w *= this->stitch_weight();
+        std::pair<graph_edge_type, bool> we = boost::edge(s, t, wg);
+        if (we.second) // already exist, update weight 
+            w += boost::get(boost::edge_weight, wg, we.first);
+        else 
+            we = boost::add_edge(s, t, wg);
+        boost::put(boost::edge_weight, wg, we.first, w);
+    }
+
+    RoundingTrials rt; 
+    rt.coloring = this; 
+    rt.graph = &wg; 
+    rt.pVector = pVector; 
+    rt.dim = dim; 
+    rt.mColor.assign(m_rounding_trials, std::vector<int8_t>());
+    rt.vCost.assign(m_rounding_trials, std::numeric_limits<double>::max());
+
+    int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), this->m_threads);
+    numThreads = std::max(std::min(numThreads, (int32_t)m_rounding_trials), 1);
+    RoundingKernel kernel = {&rt}; 
+    limbo::containers::parallel_for(0, m_rounding_trials, 1, numThreads, kernel);
+
+    // the first trial wins ties, independent of the schedule 
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < m_rounding_trials; ++i)
+        if (rt.vCost[i] < rt.vCost[best])
+            best = i;
+    double cost = this->calc_cost(this->m_vColor);
+#ifdef DEBUG_SDPCOLORING
+    limboPrint(kDEBUG, "randomized rounding: best cost %g of %u trials, threshold rounding %g\n", rt.vCost[best], m_rounding_trials, cost);
+#endif
+    if (rt.vCost[best] < cost)
+        this->m_vColor.swap(rt.mColor[best]);
+}
+
+template <typename GraphType>
+void SDPColoringCsdp<GraphType>::round_by_projection(uint32_t trial, double const* pVector, uint32_t dim, std::vector<int8_t>& vColor) const
+{
+    unsigned int state = m_rounding_seed+trial; 
+    int8_t color_num = this->color_num();
+    // standard Gaussian directions by Box-Muller transform 
+    std::vector<double> vDirection (color_num*dim);
+    for (std::vector<double>::iterator it = vDirection.begin(); it != vDirection.end(); ++it)
+    {
+        double u1 = (rand_r(&state)+1.0)/((double)RAND_MAX+2.0);
+        double u2 = rand_r(&state)/((double)RAND_MAX+1.0);
+        *it = std::sqrt(-2.0*std::log(u1))*std::cos(2.0*M_PI*u2);
+    }
+    vColor.resize(boost::num_vertices(this->m_graph));
+    for (uint32_t v = 0, ve = vColor.size(); v != ve; ++v)
+    {
+        double const* pv = pVector+(std::size_t)v*dim;
+        int8_t best = 0; 
+        double best_proj = -std::numeric_limits<double>::max();
+        for (int8_t c = 0; c < color_num; ++c)
+        {
+            double const* pc = &vDirection[c*dim];
+            double proj = 0; 
+            for (uint32_t k = 0; k < dim; ++k)
+                proj += pv[k]*pc[k];
+            if (proj > best_proj)
+            {
+                best_proj = proj; 
+                best = c; 
+            }
+        }
+        vColor[v] = best; 
+    }
+}
+
+template <typename GraphType>
+void SDPColoringCsdp<GraphType>::run_rounding_trials(typename SDPColoringCsdp<GraphType>::RoundingTrials& rt, uint32_t first, uint32_t last) const
+{
+    for (uint32_t trial = first; trial < last; ++trial)
+    {
+        std::vector<int8_t>& vColor = rt.mColor[trial];
+        round_by_projection(trial, rt.pVector, rt.dim, vColor);
+        coloring_by_FM(*rt.graph, vColor);
+        rt.vCost[trial] = this->calc_cost(vColor);
+    }
+}
+
+template <typename GraphType>
+void SDPColoringCsdp<GraphType>::color_merged_vertices(typename SDPColoringCsdp<GraphType>::subset_helper_type& gp)
+{
+    std::vector<graph_vertex_type> const& vParent = gp.vParent;
     // construct merged graph 
     // for vertices in merged graph 
     std::vector<graph_vertex_type> vG2MG (vParent.size(), std::numeric_limits<graph_vertex_type>::max()); // mapping from graph to merged graph
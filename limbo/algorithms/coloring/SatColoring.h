@@ -0,0 +1,215 @@
+/**
+ * @file   SatColoring.h
+ * @brief  exact graph coloring by a series of SAT calls with a tightening bound of the cost
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_SATCOLORING
+#define LIMBO_ALGORITHMS_COLORING_SATCOLORING
+
+#include <limbo/solvers/SatSolver.h>
+#include <limbo/algorithms/coloring/Coloring.h>
+#include <limbo/algorithms/coloring/BipartiteColoring.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+/// @class limbo::algorithms::coloring::SatColoring
+/// Solve graph coloring exactly with @ref limbo::solvers::SatSolver, for components too large for
+/// @ref limbo::algorithms::coloring::BacktrackColoring without an ILP solver.
+///
+/// Each vertex takes exactly one color by one-hot variables, and each edge with a positive cost has a variable
+/// that must be true if the edge is violated, with the cost of the edge.
+/// The solver is called with a bound of the total cost, which is set just below the cost of each solution found,
+/// until no solution exists, so the last solution is optimal.
+/// Clauses learned in previous calls stay valid under tighter bounds and are kept.
+/// Without precolored vertices, colors are symmetric, so the i-th vertex of a clique of conflict edges
+/// takes a color no larger than i.
+/// Two colors are tried by @ref limbo::algorithms::coloring::bipartite_coloring first.
+///
+/// The solver runs in one thread; components are colored in parallel by
+/// @ref limbo::algorithms::coloring::ComponentColoring with SatColoring as LargeColoringType.
+/// With @ref max_conflicts, each call after the first solution stops at a number of conflicts,
+/// and the best solution so far is kept, see @ref optimal.
+/// The time limit of the base class bounds all calls in the same way,
+/// and a greedy solution is returned if it is reached before the first solution.
+/// @tparam GraphType graph type
+template <typename GraphType>
+class SatColoring : public Coloring<GraphType>
+{
+	public:
+        /// @nowarn
+		typedef Coloring<GraphType> base_type;
+		using typename base_type::graph_type;
+		using typename base_type::graph_vertex_type;
+		using typename base_type::graph_edge_type;
+		using typename base_type::vertex_iterator_type;
+		using typename base_type::edge_iterator_type;
+        using typename base_type::edge_weight_type;
+		using typename base_type::ColorNumType;
+		typedef limbo::solvers::SatSolver solver_type;
+		typedef solver_type::literal_type literal_type;
+        /// @endnowarn
+
+		/// constructor
+        /// @param g graph
+		SatColoring(graph_type const& g)
+			: base_type(g)
+			, m_max_conflicts(0)
+			, m_optimal(false)
+		{}
+		/// destructor
+		virtual ~SatColoring() {}
+
+		/// set the limit of conflicts of each call after the first solution
+        /// @param n number of conflicts, 0 for no limit
+		void max_conflicts(boost::uint64_t n) {m_max_conflicts = n;}
+		/// @return the limit of conflicts of each call after the first solution
+		boost::uint64_t max_conflicts() const {return m_max_conflicts;}
+		/// @return true if the last solution is proved optimal
+		bool optimal() const {return m_optimal;}
+	protected:
+		/// @return objective value
+		virtual double coloring();
+		/// @param v vertex
+		/// @param c color
+		/// @param positive false for the negation
+		/// @return literal of vertex \a v taking color \a c
+		literal_type vertex_literal(graph_vertex_type v, int8_t c, bool positive = true) const
+		{
+			return solver_type::literal(v*this->color_num()+c, positive);
+		}
+
+		boost::uint64_t m_max_conflicts; ///< limit of conflicts of each call after the first solution
+		bool m_optimal; ///< whether the last solution is proved optimal
+};
+
+template <typename GraphType>
+double SatColoring<GraphType>::coloring()
+{
+	m_optimal = true;
+	// two colors without violations are found in linear time
+	if (this->color_num() == base_type::TWO && bipartite_coloring(this->m_graph, this->stitch_weight(), this->m_vColor))
+		return 0;
+
+	uint32_t num_vertices = boost::num_vertices(this->m_graph);
+	int8_t color_num = this->color_num();
+	solver_type solver;
+	uint32_t num_clauses = 0;
+
+	// one-hot colors of vertices
+	for (uint32_t i = 0, ie = num_vertices*color_num; i < ie; ++i)
+		solver.new_variable();
+	std::vector<literal_type> vClause;
+	for (uint32_t v = 0; v < num_vertices; ++v)
+	{
+		vClause.clear();
+		for (int8_t c = 0; c < color_num; ++c)
+		{
+			vClause.push_back(this->vertex_literal(v, c));
+			for (int8_t d = c+1; d < color_num; ++d, ++num_clauses)
+				solver.add_clause(this->vertex_literal(v, c, false), this->vertex_literal(v, d, false));
+		}
+		solver.add_clause(vClause);
+		++num_clauses;
+		int8_t pc = this->m_vColor[v];
+		if (pc >= 0 && pc < color_num) // precolored
+		{
+			vClause.assign(1, this->vertex_literal(v, pc));
+			solver.add_clause(vClause);
+			++num_clauses;
+		}
+	}
+	if (!this->has_precolored())
+	{
+		std::vector<graph_vertex_type> vClique;
+		this->symmetry_clique(vClique);
+		for (uint32_t i = 0; i < vClique.size(); ++i)
+			for (int8_t c = i+1; c < color_num; ++c, ++num_clauses)
+			{
+				vClause.assign(1, this->vertex_literal(vClique[i], c, false));
+				solver.add_clause(vClause);
+			}
+	}
+
+	// a violated edge sets its variable, which carries the cost of the edge
+	edge_iterator_type ei, eie;
+	for (boost::tie(ei, eie) = boost::edges(this->m_graph); ei != eie; ++ei)
+	{
+		graph_vertex_type s = boost::source(*ei, this->m_graph);
+		graph_vertex_type t = boost::target(*ei, this->m_graph);
+		edge_weight_type w = this->edge_weight(*ei);
+		double cost = (w < 0)? -w*this->stitch_weight() : w;
+		if (s == t || cost <= 0)
+			continue;
+		literal_type y = solver_type::literal(solver.new_variable());
+		solver.add_cost(y, cost);
+		for (int8_t c = 0; c < color_num; ++c, ++num_clauses)
+		{
+			if (w > 0) // conflict edge, violated by the same color
+				solver.add_clause(y, this->vertex_literal(s, c, false), this->vertex_literal(t, c, false));
+			else // stitch edge, violated if t does not take the color of s
+				solver.add_clause(y, this->vertex_literal(s, c, false), this->vertex_literal(t, c));
+		}
+	}
+
+	// tighten the bound below each solution until no solution is left
+	double best_cost = -1;
+	uint32_t num_calls = 0;
+	double deadline = (this->m_time_limit > 0)? ColoringStatistics::wall_time()+this->m_time_limit : 0;
+	for (;;)
+	{
+		if (deadline > 0)
+		{
+			double remaining = deadline-ColoringStatistics::wall_time();
+			if (remaining <= 0)
+			{
+				m_optimal = false;
+				break;
+			}
+			solver.time_limit(remaining);
+		}
+		solver.max_conflicts((best_cost < 0)? 0 : m_max_conflicts);
+		solver_type::StatusType status = solver.solve();
+		++num_calls;
+		if (status != solver_type::SATISFIABLE)
+		{
+			m_optimal = (status == solver_type::UNSATISFIABLE);
+			break;
+		}
+		best_cost = solver.model_cost();
+		for (uint32_t v = 0; v < num_vertices; ++v)
+			for (int8_t c = 0; c < color_num; ++c)
+				if (solver.value(v*color_num+c))
+					this->m_vColor[v] = c;
+		if (best_cost <= 0)
+			break;
+		solver.cost_bound(best_cost-1e-6*(1+best_cost));
+	}
+	if (best_cost < 0) // stopped before the first solution
+	{
+		limboAssertMsg(!m_optimal, "no coloring found");
+		best_cost = this->greedy_coloring(this->m_vColor);
+	}
+
+	if (this->m_collect_statistics)
+	{
+		this->m_statistics.num_variables = solver.num_variables();
+		this->m_statistics.num_constraints = num_clauses;
+		this->m_statistics.num_iterations = num_calls;
+	}
+	return best_cost;
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
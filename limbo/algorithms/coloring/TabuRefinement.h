@@ -0,0 +1,503 @@
+/**
+ * @file   TabuRefinement.h
+ * @brief  refine coloring solutions by tabu search on connected components in parallel
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_TABUREFINEMENT
+#define LIMBO_ALGORITHMS_COLORING_TABUREFINEMENT
+
+#include <time.h>
+#include <cmath>
+#include <queue>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <limbo/containers/IndexedHeap.h>
+#include <limbo/algorithms/coloring/ColoringCost.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+/// @class limbo::algorithms::coloring::TabuRefinement
+/// Refine a coloring solution by tabu search in the way of TabuCol, for solutions of any coloring algorithm.
+///
+/// A move recolors a vertex incident to a violated edge, and the best move is taken even if it increases the cost.
+/// The previous color of a moved vertex is tabu for a number of iterations growing with the number of violated vertices,
+/// unless taking it gives the best cost so far.
+/// The cost of each color for each vertex against its neighbors is kept and updated in the degree of a moved vertex,
+/// on the adjacency of @ref limbo::algorithms::coloring::ColoringCost, which also evaluates the total cost.
+///
+/// Connected components are refined independently by multiple threads, from the largest one,
+/// and each stops after a number of iterations without improvement or at a time limit,
+/// keeping its best solution, so the cost never increases.
+/// Each component draws random numbers from its own seed, so the solution does not depend on the number of threads
+/// without a time limit.
+/// @tparam GraphType graph type
+template <typename GraphType>
+class TabuRefinement
+{
+	public:
+        /// @nowarn
+		typedef GraphType graph_type;
+		typedef ColoringCost<graph_type> cost_type;
+        /// @endnowarn
+
+		/// constructor
+		/// @param g graph, non-negative weights for conflict edges and negative weights for stitch edges
+		/// @param color_num number of colors
+		/// @param stitch_weight weight of stitches
+		TabuRefinement(graph_type const& g, int8_t color_num, double stitch_weight);
+
+		/// set the number of iterations without improvement to stop a component
+		/// @param n number of iterations
+		void max_iterations(uint32_t n) {m_max_iterations = n;}
+		/// set the time limit of a run
+		/// @param t seconds, 0 for no limit
+		void time_limit(double t) {m_time_limit = t;}
+		/// set number of threads
+		/// @param t number of threads
+		void threads(int32_t t) {m_threads = t; m_cost.threads(t);}
+		/// set vertices whose colors are kept, e.g., precolored ones
+		/// @param vFixed nonzero for fixed vertices
+		void fixed(std::vector<char> const& vFixed) {m_vFixed = vFixed;}
+		/// @return number of moves in the last run
+		uint32_t num_moves() const {return m_num_moves;}
+		/// @return number of components with violated edges in the last run
+		uint32_t num_refined_components() const {return m_num_refined;}
+		/// @return cost evaluation on the graph
+		cost_type const& cost() const {return m_cost;}
+
+		/// color vertices without valid colors greedily, component by component in breadth-first order,
+		/// each with the color of the least cost against its colored neighbors, e.g., to start @ref operator() from scratch
+		/// @param vColor coloring solution, colors out of [0, color_num) are replaced
+		void initial_coloring(std::vector<int8_t>& vColor) const;
+		/// refine a coloring solution
+		/// @param vColor coloring solution with colors in [0, color_num), replaced by the refined one
+		/// @return cost of the refined solution
+		double operator()(std::vector<int8_t>& vColor);
+
+	protected:
+		/// components of a run refined by limbo::containers::parallel_for
+		struct task_type
+		{
+			TabuRefinement* pRefine; ///< this object
+			std::vector<int8_t>* pColor; ///< coloring solution
+			double deadline; ///< wall time to stop, 0 for no limit
+			/// @param b first component
+			/// @param e end component
+			void operator()(std::size_t b, std::size_t e) const {pRefine->refine(*this, b, e);}
+		};
+
+		/// refine a range of components
+		/// @param task shared state
+		/// @param first first component
+		/// @param last end component
+		void refine(task_type const& task, uint32_t first, uint32_t last);
+		/// tabu search on a component
+		/// @param vColor coloring solution
+		/// @param comp component
+		/// @param deadline wall time to stop, 0 for no limit
+		/// @return number of moves
+		uint32_t refine_component(std::vector<int8_t>& vColor, uint32_t comp, double deadline) const;
+		/// moves of the vertices of a component
+		struct move_state_type
+		{
+			std::vector<uint32_t> vTabu; ///< iteration until which a color of a vertex is tabu
+			std::vector<double> vMoveKey; ///< rounded change of cost of the best move that is not tabu
+			std::vector<double> vMoveDelta; ///< change of cost of the best move that is not tabu
+			std::vector<int8_t> vMoveColor; ///< color of the best move that is not tabu
+			std::vector<double> vAspireKey; ///< rounded change of cost of the best tabu move
+			std::vector<double> vAspireDelta; ///< change of cost of the best tabu move
+			std::vector<int8_t> vAspireColor; ///< color of the best tabu move
+			std::vector<uint32_t> vTie; ///< random number to break ties of moves
+			uint32_t seed; ///< state of random numbers
+
+			/// constructor
+			/// @param n number of vertices
+			/// @param K number of colors
+			move_state_type(uint32_t n, uint32_t K)
+				: vTabu(n*K, 0), vMoveKey(n), vMoveDelta(n), vMoveColor(n), vAspireKey(n), vAspireDelta(n), vAspireColor(n), vTie(n), seed(0)
+			{}
+		};
+		/// order of vertices by the change of cost of their best moves, and then by random numbers
+		struct move_compare_type
+		{
+			std::vector<double> const* pKey; ///< rounded change of cost of each vertex
+			std::vector<uint32_t> const* pTie; ///< random number of each vertex
+			/// constructor
+			move_compare_type(std::vector<double> const& vKey, std::vector<uint32_t> const& vTie) : pKey(&vKey), pTie(&vTie) {}
+			/// @return true if vertex \a a comes before vertex \a b
+			bool operator()(uint32_t a, uint32_t b) const
+			{
+				return (*pKey)[a] < (*pKey)[b] || ((*pKey)[a] == (*pKey)[b] && (*pTie)[a] < (*pTie)[b]);
+			}
+		};
+		/// heap of vertices by their best moves
+		typedef limbo::containers::DaryHeap<uint32_t, move_compare_type> move_heap_type;
+
+		/// find the best moves of a vertex and update the heaps
+		/// @param ms moves of the component
+		/// @param v vertex
+		/// @param violated whether \a v is incident to violated edges and can move
+		/// @param vColorCost cost of each color of each vertex
+		/// @param vColor current colors
+		/// @param iter current iteration
+		/// @param hMove heap of moves that are not tabu
+		/// @param hAspire heap of tabu moves
+		void update_move(move_state_type& ms, uint32_t v, bool violated, std::vector<double> const& vColorCost,
+				std::vector<int8_t> const& vColor, uint32_t iter, move_heap_type& hMove, move_heap_type& hAspire) const;
+		/// @return wall time in seconds
+		static double wall_time()
+		{
+			timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return ts.tv_sec+ts.tv_nsec*1e-9;
+		}
+
+		cost_type m_cost; ///< cost evaluation and adjacency
+		int8_t m_color_num; ///< number of colors
+		uint32_t m_max_iterations; ///< iterations without improvement to stop a component
+		double m_time_limit; ///< time limit in seconds, 0 for no limit
+		int32_t m_threads; ///< number of threads
+		std::vector<char> m_vFixed; ///< whether the color of each vertex is kept
+		std::vector<uint32_t> m_vCompBegin; ///< offset of each component in m_vCompVertex, with one more entry for the end
+		std::vector<uint32_t> m_vCompVertex; ///< vertices of components, from the largest component
+		std::vector<uint32_t> m_vLocal; ///< index of each vertex in its component
+		uint32_t m_num_moves; ///< number of moves in the last run
+		uint32_t m_num_refined; ///< number of components with violated edges in the last run
+};
+
+template <typename GraphType>
+TabuRefinement<GraphType>::TabuRefinement(graph_type const& g, int8_t color_num, double stitch_weight)
+	: m_cost(g, stitch_weight)
+	, m_color_num(color_num)
+	, m_max_iterations(10000)
+	, m_time_limit(0)
+	, m_threads(1)
+	, m_num_moves(0)
+	, m_num_refined(0)
+{
+	// connected components by breadth-first search on the adjacency
+	uint32_t num_vertices = m_cost.num_vertices();
+	std::vector<uint32_t> vVertex;
+	std::vector<uint32_t> vBegin (1, 0);
+	std::vector<char> vVisited (num_vertices, false);
+	vVertex.reserve(num_vertices);
+	for (uint32_t root = 0; root < num_vertices; ++root)
+	{
+		if (vVisited[root])
+			continue;
+		vVisited[root] = true;
+		vVertex.push_back(root);
+		for (uint32_t i = vBegin.back(); i < vVertex.size(); ++i)
+		{
+			uint32_t v = vVertex[i];
+			for (uint32_t k = m_cost.adjacency_begin(v), ke = m_cost.adjacency_end(v); k != ke; ++k)
+			{
+				uint32_t u = m_cost.neighbor(k);
+				if (!vVisited[u])
+				{
+					vVisited[u] = true;
+					vVertex.push_back(u);
+				}
+			}
+		}
+		vBegin.push_back(vVertex.size());
+	}
+
+	// largest components first for balance among threads
+	std::vector<std::pair<uint32_t, uint32_t> > vOrder;
+	for (uint32_t c = 0; c+1 < vBegin.size(); ++c)
+		vOrder.push_back(std::make_pair(vBegin[c]-vBegin[c+1], c));
+	std::sort(vOrder.begin(), vOrder.end());
+	m_vCompBegin.assign(1, 0);
+	m_vCompVertex.reserve(num_vertices);
+	m_vLocal.resize(num_vertices);
+	for (uint32_t i = 0; i < vOrder.size(); ++i)
+	{
+		uint32_t c = vOrder[i].second;
+		for (uint32_t k = vBegin[c]; k < vBegin[c+1]; ++k)
+		{
+			m_vLocal[vVertex[k]] = k-vBegin[c];
+			m_vCompVertex.push_back(vVertex[k]);
+		}
+		m_vCompBegin.push_back(m_vCompVertex.size());
+	}
+}
+
+template <typename GraphType>
+void TabuRefinement<GraphType>::initial_coloring(std::vector<int8_t>& vColor) const
+{
+	limboAssert(vColor.size() == m_cost.num_vertices());
+	std::vector<double> vCost (m_color_num);
+	for (uint32_t i = 0; i < m_vCompVertex.size(); ++i)
+	{
+		uint32_t v = m_vCompVertex[i];
+		if (vColor[v] >= 0 && vColor[v] < m_color_num)
+			continue;
+		// stitch edges have negative costs, which favor the colors of their neighbors
+		std::fill(vCost.begin(), vCost.end(), 0);
+		for (uint32_t k = m_cost.adjacency_begin(v), ke = m_cost.adjacency_end(v); k != ke; ++k)
+		{
+			int8_t c = vColor[m_cost.neighbor(k)];
+			if (c >= 0 && c < m_color_num)
+				vCost[c] += m_cost.neighbor_cost(k);
+		}
+		vColor[v] = std::min_element(vCost.begin(), vCost.end())-vCost.begin();
+	}
+}
+
+template <typename GraphType>
+double TabuRefinement<GraphType>::operator()(std::vector<int8_t>& vColor)
+{
+	limboAssert(vColor.size() == m_cost.num_vertices());
+	limboAssert(m_vFixed.empty() || m_vFixed.size() == vColor.size());
+	m_num_moves = 0;
+	m_num_refined = 0;
+
+	task_type task;
+	task.pRefine = this;
+	task.pColor = &vColor;
+	task.deadline = (m_time_limit > 0)? wall_time()+m_time_limit : 0;
+
+	uint32_t numComps = m_vCompBegin.size()-1;
+	int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), m_threads);
+	numThreads = std::max(std::min(numThreads, (int32_t)numComps), 1);
+	limbo::containers::parallel_for(0, numComps, 1, numThreads, task);
+
+	return m_cost(vColor);
+}
+
+template <typename GraphType>
+void TabuRefinement<GraphType>::refine(task_type const& task, uint32_t first, uint32_t last)
+{
+	for (uint32_t c = first; c < last; ++c)
+	{
+		uint32_t moves = this->refine_component(*task.pColor, c, task.deadline);
+		if (moves)
+		{
+			__sync_fetch_and_add(&m_num_moves, moves);
+			__sync_fetch_and_add(&m_num_refined, 1);
+		}
+	}
+}
+
+template <typename GraphType>
+uint32_t TabuRefinement<GraphType>::refine_component(std::vector<int8_t>& vColor, uint32_t comp, double deadline) const
+{
+	uint32_t const* pVertex = &m_vCompVertex[m_vCompBegin[comp]];
+	uint32_t n = m_vCompBegin[comp+1]-m_vCompBegin[comp];
+	uint32_t K = m_color_num;
+	if (n < 2)
+		return 0;
+
+	// cost of each color of each vertex against its neighbors, with stitch edges counted when the colors differ
+	std::vector<double> vColorCost (n*K, 0);
+	std::vector<double> vStitch (n, 0);
+	std::vector<int8_t> vLocalColor (n);
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		int8_t c = vColor[pVertex[i]];
+		vLocalColor[i] = (c >= 0 && c < (int8_t)K)? c : 0;
+	}
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		for (uint32_t k = m_cost.adjacency_begin(pVertex[i]), ke = m_cost.adjacency_end(pVertex[i]); k != ke; ++k)
+		{
+			double a = m_cost.neighbor_cost(k);
+			vColorCost[i*K+vLocalColor[m_vLocal[m_cost.neighbor(k)]]] += a;
+			if (a < 0)
+				vStitch[i] -= a;
+		}
+	}
+
+	// vertices incident to violated edges
+	double const eps = 1e-9;
+	std::vector<uint32_t> vViolated;
+	std::vector<int32_t> vViolatedPos (n, -1);
+	double cost = 0;
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		double own = vColorCost[i*K+vLocalColor[i]]+vStitch[i];
+		cost += own;
+		if (own > eps && (m_vFixed.empty() || !m_vFixed[pVertex[i]]))
+		{
+			vViolatedPos[i] = vViolated.size();
+			vViolated.push_back(i);
+		}
+	}
+	cost /= 2;
+	if (vViolated.empty())
+		return 0;
+
+	// best moves of violated vertices in heaps, one for moves that are not tabu and one for tabu moves by aspiration
+	move_state_type ms (n, K);
+	move_heap_type hMove (move_compare_type(ms.vMoveKey, ms.vTie));
+	move_heap_type hAspire (move_compare_type(ms.vAspireKey, ms.vTie));
+	hMove.reserve(vViolated.size(), n);
+	hAspire.reserve(vViolated.size(), n);
+	// tabu moves by the iteration they expire
+	std::priority_queue<std::pair<uint32_t, uint32_t>, std::vector<std::pair<uint32_t, uint32_t> >, std::greater<std::pair<uint32_t, uint32_t> > > qExpire;
+	std::vector<std::pair<uint32_t, int8_t> > vMove; // moves since the best solution, to undo at the end
+	ms.seed = pVertex[0]*2654435761U+1;
+	for (uint32_t k = 0; k < vViolated.size(); ++k)
+		this->update_move(ms, vViolated[k], vViolatedPos[vViolated[k]] >= 0, vColorCost, vLocalColor, 0, hMove, hAspire);
+
+	double best = cost;
+	uint32_t since_best = 0;
+	uint32_t moves = 0;
+	for (uint32_t iter = 1; since_best < m_max_iterations && best > eps; ++iter)
+	{
+		if (deadline > 0 && (iter&255) == 0 && wall_time() > deadline)
+			break;
+		while (!qExpire.empty() && qExpire.top().first <= iter)
+		{
+			uint32_t v = qExpire.top().second;
+			qExpire.pop();
+			this->update_move(ms, v, vViolatedPos[v] >= 0, vColorCost, vLocalColor, iter, hMove, hAspire);
+		}
+		// the best move that is not tabu, or a better tabu move reaching the best cost so far
+		int32_t best_v = -1;
+		int8_t best_c = -1;
+		double best_d = 0;
+		if (!hMove.empty())
+		{
+			best_v = hMove.top();
+			best_c = ms.vMoveColor[best_v];
+			best_d = ms.vMoveDelta[best_v];
+		}
+		if (!hAspire.empty())
+		{
+			uint32_t v = hAspire.top();
+			double d = ms.vAspireDelta[v];
+			if (cost+d < best-eps && (best_v < 0 || d < best_d))
+			{
+				best_v = v;
+				best_c = ms.vAspireColor[v];
+				best_d = d;
+			}
+		}
+		if (best_v < 0)
+			break;
+
+		// apply the move and update the costs of neighbors
+		uint32_t v = best_v;
+		int8_t old_c = vLocalColor[v];
+		vLocalColor[v] = best_c;
+		for (uint32_t k = m_cost.adjacency_begin(pVertex[v]), ke = m_cost.adjacency_end(pVertex[v]); k != ke; ++k)
+		{
+			uint32_t u = m_vLocal[m_cost.neighbor(k)];
+			double a = m_cost.neighbor_cost(k);
+			vColorCost[u*K+old_c] -= a;
+			vColorCost[u*K+best_c] += a;
+		}
+		ms.seed = ms.seed*1103515245U+12345U;
+		uint32_t expire = iter+(ms.seed>>16)%10+vViolated.size()*3/5+1;
+		ms.vTabu[v*K+old_c] = expire;
+		qExpire.push(std::make_pair(expire, v));
+		// violations and best moves of v and its neighbors may change
+		for (uint32_t k = m_cost.adjacency_begin(pVertex[v]), ke = m_cost.adjacency_end(pVertex[v]); k <= ke; ++k)
+		{
+			uint32_t u = (k == ke)? v : m_vLocal[m_cost.neighbor(k)];
+			if (!m_vFixed.empty() && m_vFixed[pVertex[u]])
+				continue;
+			bool violated = (vColorCost[u*K+vLocalColor[u]]+vStitch[u] > eps);
+			if (violated && vViolatedPos[u] < 0)
+			{
+				vViolatedPos[u] = vViolated.size();
+				vViolated.push_back(u);
+			}
+			else if (!violated && vViolatedPos[u] >= 0)
+			{
+				uint32_t last = vViolated.back();
+				vViolated[vViolatedPos[u]] = last;
+				vViolatedPos[last] = vViolatedPos[u];
+				vViolated.pop_back();
+				vViolatedPos[u] = -1;
+			}
+			this->update_move(ms, u, violated, vColorCost, vLocalColor, iter, hMove, hAspire);
+		}
+		vMove.push_back(std::make_pair(v, old_c));
+		++moves;
+
+		cost += best_d;
+		if (cost < best-eps)
+		{
+			best = cost;
+			since_best = 0;
+			vMove.clear();
+		}
+		else
+			++since_best;
+	}
+
+	// back to the best solution
+	for (uint32_t k = vMove.size(); k > 0; --k)
+		vLocalColor[vMove[k-1].first] = vMove[k-1].second;
+	for (uint32_t i = 0; i < n; ++i)
+		if (m_vFixed.empty() || !m_vFixed[pVertex[i]])
+			vColor[pVertex[i]] = vLocalColor[i];
+	return moves;
+}
+
+template <typename GraphType>
+void TabuRefinement<GraphType>::update_move(move_state_type& ms, uint32_t v, bool violated, std::vector<double> const& vColorCost,
+		std::vector<int8_t> const& vColor, uint32_t iter, move_heap_type& hMove, move_heap_type& hAspire) const
+{
+	uint32_t K = m_color_num;
+	int8_t move_c = -1;
+	int8_t aspire_c = -1;
+	if (violated)
+	{
+		double const* pCost = &vColorCost[v*K];
+		int8_t cv = vColor[v];
+		for (uint32_t c = 0; c < K; ++c)
+		{
+			if ((int8_t)c == cv)
+				continue;
+			double d = pCost[c]-pCost[cv];
+			if (ms.vTabu[v*K+c] > iter)
+			{
+				if (aspire_c < 0 || d < ms.vAspireDelta[v])
+				{
+					aspire_c = c;
+					ms.vAspireDelta[v] = d;
+				}
+			}
+			else if (move_c < 0 || d < ms.vMoveDelta[v])
+			{
+				move_c = c;
+				ms.vMoveDelta[v] = d;
+			}
+		}
+		ms.seed = ms.seed*1103515245U+12345U;
+		ms.vTie[v] = ms.seed>>8;
+	}
+	// keys are rounded so that equal costs with rounding errors are ties
+	ms.vMoveColor[v] = move_c;
+	ms.vMoveKey[v] = std::floor(ms.vMoveDelta[v]*1e6+0.5);
+	if (move_c < 0)
+		hMove.erase(v);
+	else if (!hMove.update(v))
+		hMove.insert(v);
+	ms.vAspireColor[v] = aspire_c;
+	ms.vAspireKey[v] = std::floor(ms.vAspireDelta[v]*1e6+0.5);
+	if (aspire_c < 0)
+		hAspire.erase(v);
+	else if (!hAspire.update(v))
+		hAspire.insert(v);
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
@@ -0,0 +1,483 @@
+/**
+ * @file   TiledDecomposition.h
+ * @brief  decompose large layouts tile by tile with bounded memory
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_COLORING_TILEDDECOMPOSITION
+#define LIMBO_ALGORITHMS_COLORING_TILEDDECOMPOSITION
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/AssertMsg.h>
+#include <limbo/algorithms/coloring/ConflictGraphBuilder.h>
+#include <limbo/algorithms/coloring/ComponentColoring.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Coloring
+namespace coloring
+{
+
+using boost::uint32_t;
+using boost::int32_t;
+using boost::int64_t;
+using boost::uint64_t;
+
+/// @class limbo::algorithms::coloring::TiledDecomposition
+/// Decompose a layout too large for one conflict graph by square tiles.
+///
+/// Rectangles are read from a source for the window of each tile, i.e., the tile bloated by a margin,
+/// so a tile sees the neighbors of rectangles near its sides.
+/// A rectangle belongs to the tile containing its lower left corner.
+/// The graph of each window is built by @ref limbo::algorithms::coloring::ConflictGraphBuilder
+/// and colored by ColoringType independently, with tiles in a row colored in parallel.
+///
+/// Rectangles with edges to rectangles of other tiles are boundary rectangles, the others are interior rectangles.
+/// Colors are reconciled in two steps.
+/// -# Colors of each tile are permuted to agree best with the boundary rectangles of tiles colored before.
+///    Colors of interior rectangles are final then, and sent to the sink.
+/// -# Once the next row is colored, boundary rectangles of a row are colored again by a small boundary graph,
+///    with interior neighbors and boundary rectangles of other rows fixed.
+///
+/// Only a batch of tile graphs and the boundary rectangles of two rows are kept in memory.
+/// The margin should be no smaller than the coloring distance plus the largest side of rectangles,
+/// otherwise edges across tiles may be missed.
+/// @tparam RectType rectangle type supported by @ref limbo::geometry::rectangle_traits
+/// @tparam ColoringType coloring algorithm on @ref limbo::algorithms::CsrGraph, derived from @ref limbo::algorithms::coloring::Coloring
+template <typename RectType, typename ColoringType = ComponentColoring<limbo::algorithms::CsrGraph<int32_t> > >
+class TiledDecomposition
+{
+	public:
+        /// @nowarn
+		typedef RectType rectangle_type;
+		typedef limbo::geometry::rectangle_traits<rectangle_type> rectangle_traits_type;
+		typedef typename rectangle_traits_type::coordinate_type coordinate_type;
+		typedef ColoringType coloring_type;
+		typedef typename coloring_type::graph_type graph_type;
+		typedef typename graph_type::edge_weight_type edge_weight_type;
+		typedef ConflictGraphBuilder<rectangle_type, edge_weight_type> builder_type;
+        /// @endnowarn
+
+		/// constructor
+		/// @param distance coloring distance
+		/// @param tile_size side of tiles
+		/// @param margin bloating of tiles for their windows
+		TiledDecomposition(coordinate_type distance, coordinate_type tile_size, coordinate_type margin);
+
+		/// set number of colors
+		/// @param cn number of colors
+		void color_num(int8_t cn) {m_color_num = cn;}
+		/// @return number of colors
+		int8_t color_num() const {return m_color_num;}
+		/// set weight of stitches
+		/// @param w weight
+		void stitch_weight(double w) {m_stitch_weight = w;}
+		/// set number of threads, each coloring a tile
+		/// @param t number of threads
+		void threads(int32_t t) {m_threads = t;}
+		/// set number of tile graphs kept in memory at once
+		/// @param n number of tiles, 0 for the number of threads
+		void resident_tiles(uint32_t n) {m_resident_tiles = n;}
+		/// @return number of tiles in the last run
+		uint32_t num_tiles() const {return m_num_cols*m_num_rows;}
+		/// @return number of boundary rectangles in the last run
+		uint32_t num_boundary_rectangles() const {return m_num_boundary;}
+
+		/// decompose a layout
+		/// @tparam SourceType functor with arguments (xl, yl, xh, yh, vRect, vId, vPolygon) to append
+		/// rectangles overlapping a window, their unique ids and polygons to the vectors
+		/// @tparam SinkType functor with arguments (id, color) to receive the final color of a rectangle
+		/// @param extent rectangle containing the lower left corners of all rectangles
+		/// @param source source of rectangles, called by the current thread only
+		/// @param sink sink of colors, called by the current thread only, once for each rectangle
+		/// @return cost of the coloring
+		template <typename SourceType, typename SinkType>
+		double operator()(rectangle_type const& extent, SourceType& source, SinkType& sink);
+
+	protected:
+		/// edge of a boundary rectangle
+		struct BoundaryEdge
+		{
+			uint64_t source; ///< boundary rectangle
+			uint64_t target; ///< other rectangle, unused if pinned
+			edge_weight_type weight; ///< edge weight
+			int8_t color; ///< color of an interior rectangle of the same tile, negative if target is used
+			bool foreign; ///< whether target belongs to another tile
+		};
+		/// a tile and its results
+		struct Tile
+		{
+			int64_t col; ///< column
+			int64_t row; ///< row
+			std::vector<rectangle_type> vRect; ///< rectangles in the window
+			std::vector<uint64_t> vId; ///< ids of rectangles in the window
+			std::vector<uint32_t> vPolygon; ///< polygons of rectangles in the window
+			std::vector<uint64_t> vOwnedId; ///< ids of rectangles of this tile
+			std::vector<int8_t> vOwnedColor; ///< colors of rectangles of this tile
+			std::vector<bool> vBoundary; ///< whether rectangles of this tile are boundary rectangles
+			std::vector<uint64_t> vBoundaryId; ///< ids of boundary rectangles
+			std::vector<BoundaryEdge> vEdge; ///< edges of boundary rectangles
+			double cost; ///< cost of edges between interior rectangles
+		};
+		/// color of a boundary rectangle and the row of its tile
+		typedef std::pair<int8_t, int64_t> boundary_color_type;
+
+		/// tiles of a batch colored by limbo::containers::parallel_for
+		struct TileKernel
+		{
+			TiledDecomposition const* td; ///< this object
+			std::vector<Tile>* pBatch; ///< tiles of the current row
+			/// @param b first tile
+			/// @param e end tile
+			void operator()(std::size_t b, std::size_t e) const
+			{
+				for (; b < e; ++b)
+					td->color_tile((*pBatch)[b]);
+			}
+		};
+		/// build and color the window of a tile, and keep the results
+		/// @param tile tile
+		void color_tile(Tile& tile) const;
+		/// permute colors of a tile to agree with boundary rectangles colored before
+		/// @param tile tile
+		void permute(Tile& tile) const;
+		/// color boundary rectangles of a row again
+		/// @param vRow tiles of the row
+		/// @param sink sink of colors
+		/// @return cost of edges between boundary rectangles of the row and final rectangles
+		template <typename SinkType>
+		double solve_boundary(std::vector<Tile>& vRow, SinkType& sink);
+		/// @param x coordinate
+		/// @param x0 coordinate of the first tile
+		/// @param n number of tiles
+		/// @return column or row of the tile containing \a x, clamped to tiles
+		int64_t tile_index(int64_t x, int64_t x0, int64_t n) const {return std::max((int64_t)0, std::min(n-1, (x-x0)/m_tile_size));}
+		/// @param c1, c2 colors of endpoints
+		/// @param w edge weight
+		/// @return cost of an edge
+		double edge_cost(int8_t c1, int8_t c2, edge_weight_type w) const {return (w >= 0)? (c1 == c2)*w : -(c1 != c2)*w*m_stitch_weight;}
+
+		coordinate_type m_distance; ///< coloring distance
+		int64_t m_tile_size; ///< side of tiles
+		int64_t m_margin; ///< bloating of tiles for their windows
+		int8_t m_color_num; ///< number of colors
+		double m_stitch_weight; ///< weight of stitches
+		int32_t m_threads; ///< number of threads
+		uint32_t m_resident_tiles; ///< number of tile graphs kept in memory at once
+
+		int64_t m_x0; ///< left of the first tile column
+		int64_t m_y0; ///< bottom of the first tile row
+		int64_t m_num_cols; ///< number of tile columns
+		int64_t m_num_rows; ///< number of tile rows
+		uint32_t m_num_boundary; ///< number of boundary rectangles
+		boost::unordered_map<uint64_t, boundary_color_type> m_hColor; ///< colors of boundary rectangles of the rows kept
+};
+
+template <typename RectType, typename ColoringType>
+TiledDecomposition<RectType, ColoringType>::TiledDecomposition(coordinate_type distance, coordinate_type tile_size, coordinate_type margin)
+	: m_distance(distance)
+	, m_tile_size(tile_size)
+	, m_margin(margin)
+	, m_color_num(4)
+	, m_stitch_weight(0.1)
+	, m_threads(1)
+	, m_resident_tiles(0)
+	, m_x0(0)
+	, m_y0(0)
+	, m_num_cols(0)
+	, m_num_rows(0)
+	, m_num_boundary(0)
+{
+	limboAssertMsg(tile_size > 0, "tile size must be positive");
+	limboAssertMsg(margin >= distance, "margin of tiles must be no smaller than the coloring distance");
+}
+
+template <typename RectType, typename ColoringType>
+template <typename SourceType, typename SinkType>
+double TiledDecomposition<RectType, ColoringType>::operator()(rectangle_type const& extent, SourceType& source, SinkType& sink)
+{
+	m_x0 = rectangle_traits_type::get(extent, limbo::geometry::LEFT);
+	m_y0 = rectangle_traits_type::get(extent, limbo::geometry::BOTTOM);
+	m_num_cols = ((int64_t)rectangle_traits_type::get(extent, limbo::geometry::RIGHT)-m_x0)/m_tile_size+1;
+	m_num_rows = ((int64_t)rectangle_traits_type::get(extent, limbo::geometry::TOP)-m_y0)/m_tile_size+1;
+	m_num_boundary = 0;
+	m_hColor.clear();
+
+	int32_t numThreads = std::max(std::min((int32_t)limbo::containers::num_threads(), m_threads), 1);
+	uint32_t batchSize = (m_resident_tiles > 0)? m_resident_tiles : numThreads;
+	numThreads = std::min(numThreads, (int32_t)batchSize);
+
+	double cost = 0;
+	std::vector<Tile> vPrevRow;
+	std::vector<uint64_t> vPrevBoundaryId; // boundary rectangles of the row before vPrevRow
+	for (int64_t row = 0; row < m_num_rows; ++row)
+	{
+		std::vector<Tile> vRow (m_num_cols);
+		for (uint32_t batchBegin = 0; batchBegin < vRow.size(); batchBegin += batchSize)
+		{
+			uint32_t batchEnd = std::min(batchBegin+batchSize, (uint32_t)vRow.size());
+			for (uint32_t i = batchBegin; i < batchEnd; ++i)
+			{
+				Tile& tile = vRow[i];
+				tile.col = i;
+				tile.row = row;
+				tile.cost = 0;
+				int64_t xl = m_x0+tile.col*m_tile_size;
+				int64_t yl = m_y0+tile.row*m_tile_size;
+				source((coordinate_type)(xl-m_margin), (coordinate_type)(yl-m_margin),
+						(coordinate_type)(xl+m_tile_size+m_margin), (coordinate_type)(yl+m_tile_size+m_margin),
+						tile.vRect, tile.vId, tile.vPolygon);
+			}
+
+			TileKernel kernel = {this, &vRow};
+			limbo::containers::parallel_for(batchBegin, batchEnd, 1, numThreads, kernel);
+
+			// permute in the order of tiles, so results do not depend on threads
+			for (uint32_t i = batchBegin; i < batchEnd; ++i)
+			{
+				Tile& tile = vRow[i];
+				this->permute(tile);
+				for (uint32_t j = 0; j < tile.vOwnedId.size(); ++j)
+				{
+					if (tile.vBoundary[j])
+					{
+						m_hColor[tile.vOwnedId[j]] = boundary_color_type(tile.vOwnedColor[j], row);
+						tile.vBoundaryId.push_back(tile.vOwnedId[j]);
+					}
+					else
+						sink(tile.vOwnedId[j], tile.vOwnedColor[j]);
+				}
+				cost += tile.cost;
+				m_num_boundary += tile.vBoundaryId.size();
+				std::vector<uint64_t>().swap(tile.vOwnedId);
+				std::vector<int8_t>().swap(tile.vOwnedColor);
+				std::vector<bool>().swap(tile.vBoundary);
+			}
+		}
+
+		if (row > 0)
+		{
+			cost += this->solve_boundary(vPrevRow, sink);
+			// boundary rectangles two rows above are no longer neighbors of rows not solved
+			for (std::vector<uint64_t>::const_iterator it = vPrevBoundaryId.begin(); it != vPrevBoundaryId.end(); ++it)
+				m_hColor.erase(*it);
+			vPrevBoundaryId.clear();
+			for (typename std::vector<Tile>::const_iterator it = vPrevRow.begin(); it != vPrevRow.end(); ++it)
+				vPrevBoundaryId.insert(vPrevBoundaryId.end(), it->vBoundaryId.begin(), it->vBoundaryId.end());
+		}
+		vPrevRow.swap(vRow);
+	}
+	cost += this->solve_boundary(vPrevRow, sink);
+	m_hColor.clear();
+	return cost;
+}
+
+template <typename RectType, typename ColoringType>
+void TiledDecomposition<RectType, ColoringType>::color_tile(Tile& tile) const
+{
+	builder_type builder (m_distance);
+	std::vector<bool> vOwned (tile.vRect.size());
+	for (uint32_t i = 0; i < tile.vRect.size(); ++i)
+	{
+		builder.add(tile.vRect[i], tile.vPolygon[i]);
+		vOwned[i] = (tile_index(rectangle_traits_type::get(tile.vRect[i], limbo::geometry::LEFT), m_x0, m_num_cols) == tile.col
+				&& tile_index(rectangle_traits_type::get(tile.vRect[i], limbo::geometry::BOTTOM), m_y0, m_num_rows) == tile.row);
+	}
+	std::vector<rectangle_type>().swap(tile.vRect);
+	std::vector<uint32_t>().swap(tile.vPolygon);
+	graph_type g;
+	builder(g);
+
+	coloring_type coloring (g);
+	coloring.color_num(m_color_num);
+	coloring.stitch_weight(m_stitch_weight);
+	coloring.threads(1);
+	coloring();
+
+	// rectangles of this tile with edges to other tiles are boundary rectangles
+	std::vector<bool> vBoundary (vOwned.size(), false);
+	typename graph_type::edge_iterator ei, eie;
+	for (boost::tie(ei, eie) = edges(g); ei != eie; ++ei)
+	{
+		uint32_t s = source(*ei, g);
+		uint32_t t = target(*ei, g);
+		if (vOwned[s] != vOwned[t])
+			vBoundary[vOwned[s]? s : t] = true;
+	}
+	for (boost::tie(ei, eie) = edges(g); ei != eie; ++ei)
+	{
+		uint32_t s = source(*ei, g);
+		uint32_t t = target(*ei, g);
+		edge_weight_type w = g.weight(*ei);
+		if (!vOwned[s] && !vOwned[t])
+			continue;
+		if (!vBoundary[s] && !vBoundary[t])
+		{
+			tile.cost += edge_cost(coloring.color(s), coloring.color(t), w);
+			continue;
+		}
+		if (!vBoundary[s])
+			std::swap(s, t);
+		BoundaryEdge be;
+		be.source = tile.vId[s];
+		be.target = tile.vId[t];
+		be.weight = w;
+		be.color = (vBoundary[t] || !vOwned[t])? -1 : coloring.color(t);
+		be.foreign = !vOwned[t];
+		tile.vEdge.push_back(be);
+	}
+	for (uint32_t i = 0; i < vOwned.size(); ++i)
+	{
+		if (vOwned[i])
+		{
+			tile.vOwnedId.push_back(tile.vId[i]);
+			tile.vOwnedColor.push_back(coloring.color(i));
+			tile.vBoundary.push_back(vBoundary[i]);
+		}
+	}
+	std::vector<uint64_t>().swap(tile.vId);
+}
+
+template <typename RectType, typename ColoringType>
+void TiledDecomposition<RectType, ColoringType>::permute(Tile& tile) const
+{
+	boost::unordered_map<uint64_t, int8_t> hOwnedColor;
+	for (uint32_t i = 0; i < tile.vOwnedId.size(); ++i)
+		if (tile.vBoundary[i])
+			hOwnedColor[tile.vOwnedId[i]] = tile.vOwnedColor[i];
+
+	// try all permutations of colors, at most 24
+	std::vector<int8_t> vPerm (m_color_num);
+	for (int8_t c = 0; c < m_color_num; ++c)
+		vPerm[c] = c;
+	std::vector<int8_t> vBestPerm (vPerm);
+	double bestCost = std::numeric_limits<double>::max();
+	do
+	{
+		double permCost = 0;
+		for (typename std::vector<BoundaryEdge>::const_iterator it = tile.vEdge.begin(); it != tile.vEdge.end(); ++it)
+		{
+			if (!it->foreign)
+				continue;
+			typename boost::unordered_map<uint64_t, boundary_color_type>::const_iterator found = m_hColor.find(it->target);
+			if (found != m_hColor.end())
+				permCost += edge_cost(vPerm[hOwnedColor[it->source]], found->second.first, it->weight);
+		}
+		if (permCost < bestCost)
+		{
+			bestCost = permCost;
+			vBestPerm = vPerm;
+		}
+	} while (std::next_permutation(vPerm.begin(), vPerm.end()));
+
+	for (uint32_t i = 0; i < tile.vOwnedColor.size(); ++i)
+		if (tile.vOwnedColor[i] >= 0)
+			tile.vOwnedColor[i] = vBestPerm[tile.vOwnedColor[i]];
+	for (typename std::vector<BoundaryEdge>::iterator it = tile.vEdge.begin(); it != tile.vEdge.end(); ++it)
+		if (it->color >= 0)
+			it->color = vBestPerm[it->color];
+}
+
+template <typename RectType, typename ColoringType>
+template <typename SinkType>
+double TiledDecomposition<RectType, ColoringType>::solve_boundary(std::vector<Tile>& vRow, SinkType& sink)
+{
+	// boundary rectangles of the row are free, the others are precolored
+	boost::unordered_map<uint64_t, uint32_t> hIndex;
+	std::vector<uint64_t> vFreeId;
+	std::vector<int8_t> vPrecolor;
+	std::vector<bool> vFinal; // whether colors of vertices are final after this solve
+	for (typename std::vector<Tile>::const_iterator it = vRow.begin(); it != vRow.end(); ++it)
+		for (std::vector<uint64_t>::const_iterator itId = it->vBoundaryId.begin(); itId != it->vBoundaryId.end(); ++itId)
+		{
+			hIndex[*itId] = vFreeId.size();
+			vFreeId.push_back(*itId);
+		}
+	vPrecolor.assign(vFreeId.size(), -1);
+	vFinal.assign(vFreeId.size(), true);
+	if (vFreeId.empty())
+		return 0;
+
+	std::vector<std::pair<std::pair<uint32_t, uint32_t>, edge_weight_type> > vEdge;
+	for (typename std::vector<Tile>::iterator it = vRow.begin(); it != vRow.end(); ++it)
+	{
+		for (typename std::vector<BoundaryEdge>::const_iterator itEdge = it->vEdge.begin(); itEdge != it->vEdge.end(); ++itEdge)
+		{
+			uint32_t s = hIndex[itEdge->source];
+			uint32_t t = vPrecolor.size();
+			if (itEdge->color >= 0) // interior neighbor
+			{
+				vPrecolor.push_back(itEdge->color);
+				vFinal.push_back(true);
+			}
+			else
+			{
+				typename boost::unordered_map<uint64_t, uint32_t>::const_iterator found = hIndex.find(itEdge->target);
+				if (found != hIndex.end())
+					t = found->second;
+				else
+				{
+					typename boost::unordered_map<uint64_t, boundary_color_type>::const_iterator foundColor = m_hColor.find(itEdge->target);
+					if (foundColor == m_hColor.end())
+						continue;
+					hIndex[itEdge->target] = t;
+					vPrecolor.push_back(foundColor->second.first);
+					vFinal.push_back(foundColor->second.second < it->row);
+				}
+			}
+			vEdge.push_back(std::make_pair(std::make_pair(std::min(s, t), std::max(s, t)), itEdge->weight));
+		}
+		std::vector<BoundaryEdge>().swap(it->vEdge);
+	}
+	// edges between boundary rectangles of two tiles in the row are found by both tiles
+	std::sort(vEdge.begin(), vEdge.end());
+	vEdge.erase(std::unique(vEdge.begin(), vEdge.end()), vEdge.end());
+	std::vector<std::pair<uint32_t, uint32_t> > vUniqueEdge (vEdge.size());
+	std::vector<edge_weight_type> vUniqueWeight (vEdge.size());
+	for (uint32_t i = 0; i < vEdge.size(); ++i)
+	{
+		vUniqueEdge[i] = vEdge[i].first;
+		vUniqueWeight[i] = vEdge[i].second;
+	}
+
+	graph_type g (vPrecolor.size(), vUniqueEdge.begin(), vUniqueEdge.end(), vUniqueWeight.begin());
+	coloring_type coloring (g);
+	coloring.color_num(m_color_num);
+	coloring.stitch_weight(m_stitch_weight);
+	coloring.threads(m_threads);
+	for (uint32_t v = vFreeId.size(); v < vPrecolor.size(); ++v)
+		coloring.precolor(v, vPrecolor[v]);
+	coloring();
+
+	for (uint32_t v = 0; v < vFreeId.size(); ++v)
+	{
+		int8_t c = coloring.color(v);
+		m_hColor[vFreeId[v]].first = c;
+		sink(vFreeId[v], c);
+	}
+	// edges to the next row are counted when it is solved
+	double cost = 0;
+	for (uint32_t i = 0; i < vUniqueEdge.size(); ++i)
+	{
+		uint32_t s = vUniqueEdge[i].first;
+		uint32_t t = vUniqueEdge[i].second;
+		if (vFinal[s] && vFinal[t])
+			cost += edge_cost(coloring.color(s), coloring.color(t), vUniqueWeight[i]);
+	}
+	return cost;
+}
+
+} // namespace coloring
+} // namespace algorithms
+} // namespace limbo
+
+#endif
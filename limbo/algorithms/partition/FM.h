@@ -17,8 +17,11 @@
 #include <map>
 #include <set>
 #include <limbo/math/Math.h>
+#include <limbo/algorithms/partition/FMStopRule.h>
 #include <boost/array.hpp>
 #include <boost/unordered_map.hpp>
+#include <limbo/containers/ObjectPool.h>
+#include <limbo/preprocessor/MemoryUsage.h>
 
 using std::cout;
 using std::endl;
@@ -316,17 +319,7 @@ class FM
 		};
 
         /// @brief constructor 
-		FM() {}
-        /// @brief destructor 
-		~FM()
-		{
-			for (typename unordered_map<node_type*, FM_node_type*>::const_iterator it = m_hNode.begin();
-					it != m_hNode.end(); ++it)
-				delete it->second;
-			for (typename vector<FM_net_type*>::const_iterator it = m_vNet.begin(); 
-					it != m_vNet.end(); ++it)
-				delete *it;
-		}
+		FM() : m_num_passes(0) {}
         /// @brief add node 
         /// @param pNode a node 
 		/// @param initialPartition initial partition, 0 or 1
@@ -335,11 +328,13 @@ class FM
 		{
 			assert(initialPartition == 0 || initialPartition == 1);
 
-			FM_node_type* pFMNode = new FM_node_type;
+			if (m_hNode.count(pNode)) return false;
+			FM_node_type* pFMNode = m_node_pool.construct();
 			pFMNode->pNode = pNode;
 			pFMNode->partition = initialPartition;
 			pFMNode->weight = FM_node_traits<node_type>::weight(*pNode);
-			return m_hNode.insert(make_pair(pNode, pFMNode)).second;
+			m_hNode.insert(make_pair(pNode, pFMNode));
+			return true;
 		}
         /// @brief add nets 
         /// 
@@ -353,7 +348,7 @@ class FM
 		template <typename Iterator>
 		bool add_net(net_weight_type const& weight, Iterator first, Iterator last)
 		{
-			FM_net_type* pFMNet = new FM_net_type;
+			FM_net_type* pFMNet = m_net_pool.construct();
 			pFMNet->weight = weight;
 
 			for (Iterator it = first; it != last; ++it)
@@ -362,7 +357,7 @@ class FM
 				// return false if failed
 				if (found == m_hNode.end())
 				{
-					delete pFMNet;
+					m_net_pool.pop_back();
 					return false;
 				}
 				// add FM_node_type to FM_net_type
@@ -376,6 +371,83 @@ class FM
 
 			return true;
 		}
+        /// @brief add nodes and nets of a hypergraph in CSR format 
+        /// 
+		/// Nets refer to nodes by indices, so pins are added without hash lookups. 
+		/// Node i is *(nodeFirst+i), and pins of net j are indices from *(pinFirst+*(offsetFirst+j)) to *(pinFirst+*(offsetFirst+j+1)-1). 
+        /// 
+        /// @tparam NodeIterator random access iterator of node pointers 
+        /// @tparam PartitionIterator iterator of initial partitions 
+        /// @tparam OffsetIterator random access iterator of net offsets 
+        /// @tparam PinIterator random access iterator of node indices 
+        /// @tparam WeightIterator iterator of net weights 
+		/// @param nodeFirst, nodeLast begin and end iterator of nodes 
+		/// @param partitionFirst begin iterator of initial partitions, 0 or 1 
+		/// @param offsetFirst, offsetLast begin and end iterator of net offsets, one more than the number of nets 
+		/// @param pinFirst begin iterator of pins 
+		/// @param weightFirst begin iterator of net weights 
+		/// @return false if a pin is out of range or a node is already added, in which case nothing is added 
+		template <typename NodeIterator, typename PartitionIterator, typename OffsetIterator, typename PinIterator, typename WeightIterator>
+		bool add_hypergraph(NodeIterator nodeFirst, NodeIterator nodeLast, PartitionIterator partitionFirst, 
+				OffsetIterator offsetFirst, OffsetIterator offsetLast, PinIterator pinFirst, WeightIterator weightFirst)
+		{
+			int numNodes = nodeLast-nodeFirst;
+			int numNets = (offsetFirst == offsetLast)? 0 : (offsetLast-offsetFirst)-1;
+			// count nets of each node and check pins before anything is added 
+			vector<int> vDegree (numNodes, 0);
+			for (int i = 0; i < numNets; ++i)
+			{
+				if (*(offsetFirst+i) > *(offsetFirst+i+1)) return false;
+				for (int j = *(offsetFirst+i); j < *(offsetFirst+i+1); ++j)
+				{
+					int v = *(pinFirst+j);
+					if (v < 0 || v >= numNodes) return false;
+					++vDegree[v];
+				}
+			}
+
+			vector<FM_node_type*> vFMNode (numNodes, NULL);
+			m_hNode.rehash((m_hNode.size()+numNodes)/m_hNode.max_load_factor()+1);
+			for (int i = 0; i < numNodes; ++i, ++partitionFirst)
+			{
+				assert(*partitionFirst == 0 || *partitionFirst == 1);
+				node_type* pNode = *(nodeFirst+i);
+				pair<typename unordered_map<node_type*, FM_node_type*>::iterator, bool> inserted = m_hNode.insert(make_pair(pNode, (FM_node_type*)NULL));
+				if (!inserted.second)
+				{
+					// roll back nodes added by this call, the last constructed ones in the pool 
+					for (int j = i-1; j >= 0; --j)
+					{
+						m_hNode.erase(*(nodeFirst+j));
+						m_node_pool.pop_back();
+					}
+					return false;
+				}
+				FM_node_type* pFMNode = m_node_pool.construct();
+				pFMNode->pNode = pNode;
+				pFMNode->partition = *partitionFirst;
+				pFMNode->weight = FM_node_traits<node_type>::weight(*pNode);
+				pFMNode->vNet.reserve(vDegree[i]);
+				inserted.first->second = pFMNode;
+				vFMNode[i] = pFMNode;
+			}
+
+			m_vNet.reserve(m_vNet.size()+numNets);
+			for (int i = 0; i < numNets; ++i, ++weightFirst)
+			{
+				FM_net_type* pFMNet = m_net_pool.construct();
+				pFMNet->weight = *weightFirst;
+				pFMNet->vNode.reserve(*(offsetFirst+i+1)-*(offsetFirst+i));
+				for (int j = *(offsetFirst+i); j < *(offsetFirst+i+1); ++j)
+				{
+					FM_node_type* pFMNode = vFMNode[*(pinFirst+j)];
+					pFMNet->vNode.push_back(pFMNode);
+					pFMNode->vNet.push_back(pFMNet);
+				}
+				m_vNet.push_back(pFMNet);
+			}
+			return true;
+		}
 		/// @return cut size of current partition
 		net_weight_type cutsize() const 
 		{
@@ -385,6 +457,34 @@ class FM
 				cs += (*it)->cutsize();
 			return cs;
 		}
+		/// @brief stop a pass early 
+		/// @param n number of moves without a better cut size to end a pass, 0 for no limit
+		void set_max_stall(unsigned int n) {m_stop_rule.max_stall = n;}
+		/// @param n number of passes to end a run, 0 for no limit
+		void set_max_passes(unsigned int n) {m_stop_rule.max_passes = n;}
+		/// @brief end a pass after more than \a alpha times the moves of its best prefix plus \a beta moves without a better cut size
+		/// @param alpha relative part, 0 to disable
+		/// @param beta absolute part
+		void set_adaptive_stop(double alpha, unsigned int beta) {m_stop_rule.alpha = alpha; m_stop_rule.beta = beta;}
+		/// @return number of passes in the last run 
+		unsigned int num_passes() const {return m_num_passes;}
+		/// @brief report bytes under categories "FM/nodes" and "FM/nets", 
+		/// where hash and tree nodes of the node map and gain buckets are estimated with two pointers of overhead each 
+		/// @param usage bytes are added to it 
+		void memory_usage(limbo::MemoryUsage& usage) const 
+		{
+			std::size_t nodeBytes = sizeof(*this) + m_node_pool.capacity()*sizeof(FM_node_type) + limbo::heap_bytes(m_vMove) 
+				+ m_hNode.bucket_count()*sizeof(void*) + m_hNode.size()*(sizeof(typename unordered_map<node_type*, FM_node_type*>::value_type)+2*sizeof(void*)); 
+			for (std::size_t i = 0; i < m_node_pool.size(); ++i)
+				nodeBytes += limbo::heap_bytes(m_node_pool[i].vNet); 
+			for (typename gain_bucket_type::const_iterator it = m_gain_bucket.begin(); it != m_gain_bucket.end(); ++it)
+				nodeBytes += sizeof(*it) + it->second.size()*(sizeof(FM_node_type*)+4*sizeof(void*)); 
+			std::size_t netBytes = m_net_pool.capacity()*sizeof(FM_net_type) + limbo::heap_bytes(m_vNet); 
+			for (std::size_t i = 0; i < m_net_pool.size(); ++i)
+				netBytes += limbo::heap_bytes(m_net_pool[i].vNode); 
+			usage.add("FM/nodes", nodeBytes); 
+			usage.add("FM/nets", netBytes); 
+		}
 		/// Top api for FM 
 		/// @param ratio1 minimum target ratio for partition 0 over partition 1
 		/// @param ratio2 maximum target ratio for partition 0 over partition 1
@@ -472,41 +572,29 @@ class FM
 
 				prev_cutsize = cur_cutsize;
 
-				pair<net_weight_type, int> trial_pass = this->single_pass(ratio1, ratio2, -1);
-#ifdef DEBUG_FM
-				//this->print_node();
-#endif
-				pair<net_weight_type, int> actual_pass = this->single_pass(ratio1, ratio2, trial_pass.second);
+				// moves after the best prefix are rolled back with the move log instead of replaying the pass 
+				pair<net_weight_type, int> pass = this->single_pass(ratio1, ratio2, -1);
+				this->revert_moves(pass.second);
 
 #ifdef DEBUG_FM
 				this->print_node();
-				assert(trial_pass == actual_pass && limbo::abs(actual_pass.first-this->cutsize()) < 1e-6);
+				assert(limbo::abs(pass.first-this->cutsize()) < 1e-6);
 #endif 
 
-				cur_cutsize = actual_pass.first;
-			} while (cur_cutsize < prev_cutsize);
+				cur_cutsize = pass.first;
+			} while (cur_cutsize < prev_cutsize && !m_stop_rule.stop_run(iter_cnt));
+			m_num_passes = iter_cnt;
 
 			return cur_cutsize;
 		}
         /// @brief one pass of moving nodes 
 		/// @param ratio1 minimum target ratio for partition 0 over partition 1
 		/// @param ratio2 maximum target ratio for partition 0 over partition 1
-		/// @param target_cnt generalized iteration count, if it is negative, then run in trial mode 
+		/// @param target_cnt generalized iteration count, if it is negative, then move until no node can move 
 		/// @return pair of best cut size and iteration count
 		pair<net_weight_type, int> single_pass(double ratio1, double ratio2, int target_cnt)
 		{
-			// trial mode, back up partition
-			if (target_cnt < 0) 
-			{
-				cout << "======= trial phase =======" << endl;
-				for (typename unordered_map<node_type*, FM_node_type*>::const_iterator it = m_hNode.begin();
-						it != m_hNode.end(); ++it)
-				{
-					FM_node_type* const& pFMNode = it->second;
-					pFMNode->partition_bak = pFMNode->partition;
-				}
-			}
-			else cout << "======= actual phase w. target_cnt = " << target_cnt << " =======" << endl;
+			m_vMove.clear();
 #ifdef DEBUG_FM
 			//this->print_node();
 #endif
@@ -545,7 +633,7 @@ class FM
 			int best_cnt = 0;
 			while (!gain_bucket.empty())
 			{
-				if (cur_cnt == target_cnt) break;
+				if (cur_cnt == target_cnt || m_stop_rule.stop_pass(cur_cnt, best_cnt)) break;
 #ifdef DEBUG_FM
 				//this->print_node();
 #endif
@@ -659,6 +747,7 @@ class FM
 				}
 
 				// record current cnt
+				m_vMove.push_back(pFMNodeBest);
 				++cur_cnt;
 
 #ifdef DEBUG_FM
@@ -674,23 +763,25 @@ class FM
 					best_cnt = cur_cnt;
 				}
 			}
-			// trial mode, recover partition
-			if (target_cnt < 0)
-			{
-				for (typename unordered_map<node_type*, FM_node_type*>::const_iterator it = m_hNode.begin();
-						it != m_hNode.end(); ++it)
-				{
-					FM_node_type* const& pFMNode = it->second;
-					pFMNode->partition = pFMNode->partition_bak;
-				}
-			}
-
 			return make_pair(best_cutsize, best_cnt);
 		}
+		/// @brief roll back moves of the last pass after a prefix 
+		/// @param cnt number of moves to keep 
+		void revert_moves(int cnt)
+		{
+			for (int i = (int)m_vMove.size()-1; i >= cnt; --i)
+				m_vMove[i]->partition = !m_vMove[i]->partition;
+			m_vMove.resize(cnt);
+		}
 
+		limbo::containers::ObjectPool<FM_node_type> m_node_pool; ///< storage of FM nodes, released together 
+		limbo::containers::ObjectPool<FM_net_type> m_net_pool; ///< storage of FM nets, released together 
 		unordered_map<node_type*, FM_node_type*> m_hNode; ///< FM nodes
 		vector<FM_net_type*> m_vNet; ///< FM nets 
 		gain_bucket_type m_gain_bucket; ///< gain buckets
+		vector<FM_node_type*> m_vMove; ///< nodes moved in the last pass 
+		FMStopRule m_stop_rule; ///< rules to end passes and runs early 
+		unsigned int m_num_passes; ///< number of passes in the last run 
 };
 
 } // namespace partition
@@ -0,0 +1,446 @@
+/**
+ * @file   FMBucket.h
+ * @brief  Implementation of the FM partitioning algorithm with bucket lists of integer gains
+ *
+ * Refer to Fiduccia and Mattheyses,
+ * "A Linear-time Heuristics for Improving Network Partitions", DAC 1982
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_PARTITION_FMBUCKET_H
+#define LIMBO_ALGORITHMS_PARTITION_FMBUCKET_H
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/unordered_map.hpp>
+#include <limbo/math/Math.h>
+#include <limbo/algorithms/partition/FM.h>
+#include <limbo/preprocessor/MemoryUsage.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Partition
+namespace partition
+{
+
+/// @class limbo::algorithms::partition::FMBucket
+/// @brief Implementation of FM partitioning algorithm with the bucket array of the original paper
+///
+/// It has the same interface and moves as @ref limbo::algorithms::partition::FM,
+/// but net weights must be integers, so gains index an array of doubly linked lists
+/// with a pointer to the maximum gain, and each gain update costs O(1) instead of two tree operations.
+/// Nodes and nets are stored in contiguous arrays indexed by the order of insertion,
+/// and gains are updated incrementally with the number of nodes of each net in each partition.
+///
+/// Ties of gains are broken by @ref limbo::algorithms::partition::FM_node_traits::tie_id by default,
+/// which gives the same moves as @ref limbo::algorithms::partition::FM but scans the bucket of the best gain,
+/// or by the last inserted node, which is O(1) and still deterministic.
+///
+/// Only support two partitions. Nets with one node never contribute to gains.
+/// @tparam NodeType indicates type of nodes in the graph
+/// @tparam NetWeightType type of net weight values, must be integral
+template <typename NodeType, typename NetWeightType = int>
+class FMBucket
+{
+	public:
+        /// @nowarn
+		typedef NodeType node_type;
+		typedef NetWeightType net_weight_type;
+		typedef typename FM_node_traits<node_type>::node_weight_type node_weight_type;
+		typedef typename FM_node_traits<node_type>::tie_id_type tie_id_type;
+        /// @endnowarn
+		BOOST_STATIC_ASSERT(boost::is_integral<net_weight_type>::value);
+
+		/// @brief rules to break ties of gains
+		enum TieBreakType
+		{
+			TIE_BY_ID, ///< smallest tie_id first like @ref limbo::algorithms::partition::FM
+			TIE_BY_ORDER ///< last inserted node into the bucket first, O(1)
+		};
+
+        /// @brief constructor
+		FMBucket() : m_tie_break(TIE_BY_ID), m_num_pass(0) {}
+
+        /// @brief add node
+        /// @param pNode a node
+		/// @param initialPartition initial partition, 0 or 1
+		/// @return whehter insertion is successful
+		bool add_node(node_type* pNode, int initialPartition)
+		{
+			assert(initialPartition == 0 || initialPartition == 1);
+
+			if (!m_hNode.insert(std::make_pair(pNode, (unsigned int)m_vNode.size())).second)
+				return false;
+			m_vNode.push_back(pNode);
+			m_vPartition.push_back(initialPartition);
+			m_vWeight.push_back(FM_node_traits<node_type>::weight(*pNode));
+			return true;
+		}
+        /// @brief add nets
+        ///
+		/// This function must be called after all nodes are inserted.
+		/// Duplicate nodes in a net are kept once.
+        ///
+        /// @tparam Iterator iterator of net array, dereference of which must be type of node
+        /// @param weight weight of nets
+		/// @param first, last begin and end iterator of net array
+		/// @return whehter a net is successfully added
+		template <typename Iterator>
+		bool add_net(net_weight_type const& weight, Iterator first, Iterator last)
+		{
+			if (m_vNetBegin.empty())
+				m_vNetBegin.push_back(0);
+			std::size_t begin = m_vPin.size();
+			for (Iterator it = first; it != last; ++it)
+			{
+				typename boost::unordered_map<node_type*, unsigned int>::const_iterator found = m_hNode.find(*it);
+				// return false if failed
+				if (found == m_hNode.end())
+				{
+					m_vPin.resize(begin);
+					return false;
+				}
+				m_vPin.push_back(found->second);
+			}
+			std::sort(m_vPin.begin()+begin, m_vPin.end());
+			m_vPin.erase(std::unique(m_vPin.begin()+begin, m_vPin.end()), m_vPin.end());
+			m_vNetBegin.push_back(m_vPin.size());
+			m_vNetWeight.push_back(weight);
+			return true;
+		}
+		/// @brief set the rule to break ties of gains
+		/// @param t rule
+		void set_tie_break(TieBreakType t) {m_tie_break = t;}
+		/// @brief stop a pass early, which is common in refinement of good partitions
+		/// @param n number of moves without a better cut size to end a pass, 0 for no limit
+		void set_max_stall(unsigned int n) {m_stop_rule.max_stall = n;}
+		/// @param n number of passes to end a run, 0 for no limit
+		void set_max_passes(unsigned int n) {m_stop_rule.max_passes = n;}
+		/// @brief end a pass after more than \a alpha times the moves of its best prefix plus \a beta moves without a better cut size
+		/// @param alpha relative part, 0 to disable
+		/// @param beta absolute part
+		void set_adaptive_stop(double alpha, unsigned int beta) {m_stop_rule.alpha = alpha; m_stop_rule.beta = beta;}
+		/// @param pNode a node
+		/// @return partition of the node, -1 if not found
+		int partition(node_type* pNode) const
+		{
+			typename boost::unordered_map<node_type*, unsigned int>::const_iterator found = m_hNode.find(pNode);
+			return (found == m_hNode.end())? -1 : m_vPartition[found->second];
+		}
+		/// @return number of passes in the last run
+		unsigned int num_pass() const {return m_num_pass;}
+		/// @brief report bytes under categories "FMBucket/nodes" for arrays of nodes and gain buckets and "FMBucket/nets" for arrays of nets and pins, 
+		/// where hash nodes of the node map are estimated with two pointers of overhead each 
+		/// @param usage bytes are added to it 
+		void memory_usage(limbo::MemoryUsage& usage) const 
+		{
+			usage.add("FMBucket/nodes", sizeof(*this) + limbo::heap_bytes(m_vNode) 
+					+ m_hNode.bucket_count()*sizeof(void*) + m_hNode.size()*(sizeof(typename boost::unordered_map<node_type*, unsigned int>::value_type)+2*sizeof(void*)) 
+					+ limbo::heap_bytes(m_vPartition) + limbo::heap_bytes(m_vWeight) + limbo::heap_bytes(m_vRank) 
+					+ limbo::heap_bytes(m_vBucketHead) + limbo::heap_bytes(m_vPrev) + limbo::heap_bytes(m_vNext) 
+					+ limbo::heap_bytes(m_vGain) + limbo::heap_bytes(m_vLocked) + limbo::heap_bytes(m_vMove)); 
+			usage.add("FMBucket/nets", limbo::heap_bytes(m_vNetBegin) + limbo::heap_bytes(m_vPin) + limbo::heap_bytes(m_vNetWeight) 
+					+ limbo::heap_bytes(m_vNodeNetBegin) + limbo::heap_bytes(m_vNodeNet) + limbo::heap_bytes(m_vNetCount)); 
+		}
+		/// @return cut size of current partition
+		net_weight_type cutsize() const
+		{
+			net_weight_type cs = 0;
+			for (std::size_t i = 0; i < m_vNetWeight.size(); ++i)
+				for (std::size_t j = m_vNetBegin[i]+1; j < m_vNetBegin[i+1]; ++j)
+					if (m_vPartition[m_vPin[j]] != m_vPartition[m_vPin[m_vNetBegin[i]]])
+					{
+						cs += m_vNetWeight[i];
+						break;
+					}
+			return cs;
+		}
+		/// Top api for FM
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return final cutsize after partition
+		net_weight_type operator()(double ratio1, double ratio2)
+		{
+			return this->run(ratio1, ratio2);
+		}
+		/// print function
+		void print() const
+		{
+			std::cout << "------- partitions -------" << std::endl;
+			std::cout << "{";
+			for (int p = 0; p < 2; ++p)
+			{
+				if (p) std::cout << "| ";
+				for (std::size_t i = 0; i < m_vNode.size(); ++i)
+					if (m_vPartition[i] == p)
+						std::cout << FM_node_traits<node_type>::tie_id(*m_vNode[i]) << " ";
+			}
+			std::cout << "}" << std::endl;
+		}
+	protected:
+        /// @brief kernel function to run the algorithm
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return final cut size
+		net_weight_type run(double ratio1, double ratio2)
+		{
+			this->build_incidence();
+			this->build_buckets();
+
+			net_weight_type prev_cutsize;
+			net_weight_type cur_cutsize = this->cutsize();
+			m_num_pass = 0;
+			do
+			{
+				prev_cutsize = cur_cutsize;
+				cur_cutsize = this->single_pass(ratio1, ratio2, cur_cutsize);
+				++m_num_pass;
+			} while (cur_cutsize < prev_cutsize && !m_stop_rule.stop_run(m_num_pass));
+
+			return cur_cutsize;
+		}
+		/// @brief build nets of each node and the rank of tie_id
+		void build_incidence()
+		{
+			std::size_t numNodes = m_vNode.size();
+			if (m_vNetBegin.empty())
+				m_vNetBegin.push_back(0);
+			m_vNodeNetBegin.assign(numNodes+1, 0);
+			for (std::size_t j = 0; j < m_vPin.size(); ++j)
+				++m_vNodeNetBegin[m_vPin[j]+1];
+			for (std::size_t i = 0; i < numNodes; ++i)
+				m_vNodeNetBegin[i+1] += m_vNodeNetBegin[i];
+			m_vNodeNet.resize(m_vPin.size());
+			std::vector<unsigned int> vPos (m_vNodeNetBegin.begin(), m_vNodeNetBegin.end()-1);
+			for (std::size_t i = 0; i < m_vNetWeight.size(); ++i)
+				for (std::size_t j = m_vNetBegin[i]; j < m_vNetBegin[i+1]; ++j)
+					m_vNodeNet[vPos[m_vPin[j]]++] = i;
+
+			m_vRank.resize(numNodes);
+			if (m_tie_break == TIE_BY_ID)
+			{
+				std::vector<std::pair<tie_id_type, unsigned int> > vTieId (numNodes);
+				for (std::size_t i = 0; i < numNodes; ++i)
+					vTieId[i] = std::make_pair(FM_node_traits<node_type>::tie_id(*m_vNode[i]), (unsigned int)i);
+				std::sort(vTieId.begin(), vTieId.end());
+				for (std::size_t i = 0; i < numNodes; ++i)
+					m_vRank[vTieId[i].second] = i;
+			}
+		}
+		/// @brief allocate buckets for the largest possible gain
+		void build_buckets()
+		{
+			std::size_t numNodes = m_vNode.size();
+			m_max_gain = 0;
+			for (std::size_t i = 0; i < numNodes; ++i)
+			{
+				net_weight_type g = 0;
+				for (std::size_t k = m_vNodeNetBegin[i]; k < m_vNodeNetBegin[i+1]; ++k)
+					g += limbo::abs(m_vNetWeight[m_vNodeNet[k]]);
+				m_max_gain = std::max(m_max_gain, g);
+			}
+			m_vBucketHead.assign(2*m_max_gain+1, none());
+			m_vPrev.assign(numNodes, none());
+			m_vNext.assign(numNodes, none());
+			m_vGain.assign(numNodes, 0);
+			m_vLocked.assign(numNodes, false);
+			m_vNetCount.assign(2*m_vNetWeight.size(), 0);
+			m_vMove.reserve(numNodes);
+		}
+		/// @return value of no node
+		static unsigned int none() {return std::numeric_limits<unsigned int>::max();}
+		/// @brief insert a node into the bucket of its gain
+		/// @param v node
+		void bucket_insert(unsigned int v)
+		{
+			std::size_t b = m_vGain[v]+m_max_gain;
+			m_vPrev[v] = none();
+			m_vNext[v] = m_vBucketHead[b];
+			if (m_vBucketHead[b] != none())
+				m_vPrev[m_vBucketHead[b]] = v;
+			m_vBucketHead[b] = v;
+			m_max_bucket = std::max(m_max_bucket, (long)b);
+		}
+		/// @brief erase a node from its bucket
+		/// @param v node
+		void bucket_erase(unsigned int v)
+		{
+			if (m_vPrev[v] != none())
+				m_vNext[m_vPrev[v]] = m_vNext[v];
+			else
+				m_vBucketHead[m_vGain[v]+m_max_gain] = m_vNext[v];
+			if (m_vNext[v] != none())
+				m_vPrev[m_vNext[v]] = m_vPrev[v];
+		}
+		/// @brief change gain of a free node
+		/// @param v node
+		/// @param delta change of gain
+		void update_gain(unsigned int v, net_weight_type delta)
+		{
+			if (m_vLocked[v] || delta == 0) return;
+			this->bucket_erase(v);
+			m_vGain[v] += delta;
+			this->bucket_insert(v);
+		}
+		/// @brief add \a delta to gains of free nodes of a net, or only those in partition \a p if \a p is not negative
+		/// @param net net
+		/// @param p partition
+		/// @param delta change of gain
+		void update_net(unsigned int net, int p, net_weight_type delta)
+		{
+			for (std::size_t j = m_vNetBegin[net]; j < m_vNetBegin[net+1]; ++j)
+				if (p < 0 || m_vPartition[m_vPin[j]] == p)
+					this->update_gain(m_vPin[j], delta);
+		}
+		/// @brief one pass of moving nodes, moves after the best cut size are undone
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @param cur_cutsize cut size before the pass
+		/// @return best cut size
+		net_weight_type single_pass(double ratio1, double ratio2, net_weight_type cur_cutsize)
+		{
+			std::size_t numNodes = m_vNode.size();
+			std::size_t numNets = m_vNetWeight.size();
+			// initialize counts, gains and buckets
+			node_weight_type total_weight[2] = {0, 0};
+			std::fill(m_vNetCount.begin(), m_vNetCount.end(), 0);
+			for (std::size_t i = 0; i < numNets; ++i)
+				for (std::size_t j = m_vNetBegin[i]; j < m_vNetBegin[i+1]; ++j)
+					++m_vNetCount[2*i+m_vPartition[m_vPin[j]]];
+			std::fill(m_vBucketHead.begin(), m_vBucketHead.end(), none());
+			m_max_bucket = -1;
+			for (std::size_t v = 0; v < numNodes; ++v)
+			{
+				int p = m_vPartition[v];
+				total_weight[p] += m_vWeight[v];
+				net_weight_type g = 0;
+				for (std::size_t k = m_vNodeNetBegin[v]; k < m_vNodeNetBegin[v+1]; ++k)
+				{
+					unsigned int net = m_vNodeNet[k];
+					if (m_vNetBegin[net+1]-m_vNetBegin[net] < 2) continue;
+					if (m_vNetCount[2*net+p] == 1) g += m_vNetWeight[net];
+					if (m_vNetCount[2*net+!p] == 0) g -= m_vNetWeight[net];
+				}
+				m_vGain[v] = g;
+				m_vLocked[v] = false;
+				this->bucket_insert(v);
+			}
+
+			net_weight_type best_cutsize = cur_cutsize;
+			std::size_t best_cnt = 0;
+			m_vMove.clear();
+			while (true)
+			{
+				unsigned int best = this->select(total_weight, ratio1, ratio2);
+				if (best == none()) break;
+				if (m_stop_rule.stop_pass(m_vMove.size(), best_cnt)) break;
+
+				int from = m_vPartition[best];
+				int to = !from;
+				total_weight[from] -= m_vWeight[best];
+				total_weight[to] += m_vWeight[best];
+				cur_cutsize -= m_vGain[best];
+				this->bucket_erase(best);
+				m_vLocked[best] = true;
+				m_vMove.push_back(best);
+				// critical nets before and after the move
+				for (std::size_t k = m_vNodeNetBegin[best]; k < m_vNodeNetBegin[best+1]; ++k)
+				{
+					unsigned int net = m_vNodeNet[k];
+					net_weight_type w = m_vNetWeight[net];
+					if (m_vNetBegin[net+1]-m_vNetBegin[net] < 2) continue;
+					if (m_vNetCount[2*net+to] == 0) this->update_net(net, -1, w);
+					else if (m_vNetCount[2*net+to] == 1) this->update_net(net, to, -w);
+					--m_vNetCount[2*net+from];
+					++m_vNetCount[2*net+to];
+					if (m_vNetCount[2*net+from] == 0) this->update_net(net, -1, -w);
+					else if (m_vNetCount[2*net+from] == 1) this->update_net(net, from, w);
+				}
+				m_vPartition[best] = to;
+
+				if (cur_cutsize < best_cutsize)
+				{
+					best_cutsize = cur_cutsize;
+					best_cnt = m_vMove.size();
+				}
+			}
+			// undo moves after the best cut size
+			for (std::size_t i = best_cnt; i < m_vMove.size(); ++i)
+				m_vPartition[m_vMove[i]] = !m_vPartition[m_vMove[i]];
+
+			return best_cutsize;
+		}
+		/// @brief select the node of largest gain whose move keeps the ratio in the target range or gets closer to it
+		/// @param total_weight total weights of partitions
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return node, none() if no node can move
+		unsigned int select(node_weight_type const* total_weight, double ratio1, double ratio2)
+		{
+			double cur_ratio = (double)total_weight[0]/total_weight[1];
+			double cur_dist = limbo::abs(cur_ratio-ratio1)+limbo::abs(cur_ratio-ratio2);
+			// skip empty buckets on the top
+			while (m_max_bucket >= 0 && m_vBucketHead[m_max_bucket] == none())
+				--m_max_bucket;
+			for (long b = m_max_bucket; b >= 0; --b)
+			{
+				unsigned int best = none();
+				for (unsigned int v = m_vBucketHead[b]; v != none(); v = m_vNext[v])
+				{
+					if (best != none() && m_vRank[v] > m_vRank[best]) continue;
+					node_weight_type tmp_total_weight[2] = {total_weight[0], total_weight[1]};
+					tmp_total_weight[m_vPartition[v]] -= m_vWeight[v];
+					tmp_total_weight[!m_vPartition[v]] += m_vWeight[v];
+					double tmp_ratio = (double)tmp_total_weight[0]/tmp_total_weight[1];
+					if (limbo::abs(tmp_ratio-ratio1)+limbo::abs(tmp_ratio-ratio2) <= cur_dist)
+					{
+						best = v;
+						if (m_tie_break == TIE_BY_ORDER) break;
+					}
+				}
+				if (best != none()) return best;
+			}
+			return none();
+		}
+
+		TieBreakType m_tie_break; ///< rule to break ties of gains
+		FMStopRule m_stop_rule; ///< rules to end passes and runs early
+		unsigned int m_num_pass; ///< number of passes in the last run
+
+		std::vector<node_type*> m_vNode; ///< nodes in the order of insertion
+		boost::unordered_map<node_type*, unsigned int> m_hNode; ///< map from nodes to indices, only used to add nets
+		std::vector<int> m_vPartition; ///< partition of each node
+		std::vector<node_weight_type> m_vWeight; ///< weight of each node
+		std::vector<unsigned int> m_vRank; ///< rank of tie_id of each node
+
+		std::vector<std::size_t> m_vNetBegin; ///< first node of each net in m_vPin, with one more entry for the end
+		std::vector<unsigned int> m_vPin; ///< nodes of nets
+		std::vector<net_weight_type> m_vNetWeight; ///< weight of each net
+		std::vector<std::size_t> m_vNodeNetBegin; ///< first net of each node in m_vNodeNet, with one more entry for the end
+		std::vector<unsigned int> m_vNodeNet; ///< nets of nodes
+		std::vector<unsigned int> m_vNetCount; ///< number of nodes of each net in partition 0 and 1
+
+		net_weight_type m_max_gain; ///< largest possible absolute gain, the offset of bucket indices
+		long m_max_bucket; ///< no bucket above it is occupied
+		std::vector<unsigned int> m_vBucketHead; ///< first node in each bucket
+		std::vector<unsigned int> m_vPrev; ///< previous node in the bucket
+		std::vector<unsigned int> m_vNext; ///< next node in the bucket
+		std::vector<net_weight_type> m_vGain; ///< gain of each node
+		std::vector<char> m_vLocked; ///< whether each node has moved in the pass
+		std::vector<unsigned int> m_vMove; ///< moved nodes in the pass
+};
+
+} // namespace partition
+} // namespace algorithms
+} // namespace limbo
+
+#endif
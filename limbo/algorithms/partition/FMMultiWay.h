@@ -12,6 +12,14 @@
 #ifndef LIMBO_ALGORITHMS_PARTITION_FMMULTIWAY_H
 #define LIMBO_ALGORITHMS_PARTITION_FMMULTIWAY_H
 
+#include <vector>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+#include <boost/type_traits/integral_constant.hpp>
+#include <limbo/algorithms/partition/FMStopRule.h>
+
 /// namespace for Limbo 
 namespace limbo 
 { 
@@ -22,10 +30,32 @@ namespace algorithms
 namespace partition 
 {
 
+/// @brief check whether a gain calculator provides the optional hook 
+/// void affected_vertices(int v, std::vector<int>& vVertex) const, 
+/// which appends vertices whose gains may change when \a v moves. 
+/// @tparam GainCalcType gain calculator 
+template <typename GainCalcType>
+struct FMHasAffectedVertices
+{
+    /// @nowarn 
+    typedef char yes_type;
+    typedef char (&no_type)[2];
+    template <typename U, void (U::*)(int, std::vector<int>&) const> struct check_type;
+    template <typename U> static yes_type test(check_type<U, &U::affected_vertices>*);
+    template <typename U> static no_type test(...);
+    /// @endnowarn
+    static const bool value = (sizeof(test<GainCalcType>(0)) == sizeof(yes_type)); ///< true if the hook exists 
+};
+
 /// @class limbo::algorithms::partition::FMMultiWay
 /// Assume vertices are represented by 0, 1, ... N array.  
 /// Partitions are 0, 1, ... P array. 
 /// Negative partition id denotes no partition assigned.  
+///
+/// If the gain calculator provides the hook checked by @ref limbo::algorithms::partition::FMHasAffectedVertices, 
+/// gains are cached in a priority queue and only gains of affected vertices are recomputed after each move, 
+/// so a pass costs O(N P log(N P)) for sparse graphs instead of O(N^2 P). 
+/// Both ways select the same moves, i.e., the largest gain, then the smallest vertex, then the smallest partition. 
 /// @tparam GainCalcType a function object that calculate gains, refer to @ref limbo::algorithms::coloring::SDPColoringCsdp::FMGainCalcType for example.  
 template <typename GainCalcType>
 class FMMultiWay
@@ -49,6 +79,29 @@ class FMMultiWay
             /// @param g gain value 
             VertexMove(int v, int op, gain_value_type g) : vertex(v), orig_partition(op), gain(g) {}
         };
+        /// @class limbo::algorithms::partition::FMMultiWay::Candidate
+        /// @brief a cached gain of moving a vertex to a partition 
+        struct Candidate
+        {
+            gain_value_type gain; ///< gain 
+            int vertex; ///< vertex id 
+            signed char partition; ///< target partition 
+            unsigned int version; ///< version of the vertex when the gain is computed, older ones are stale 
+            /// @brief constructor 
+            /// @param g gain value 
+            /// @param v vertex 
+            /// @param p target partition 
+            /// @param ver version of the vertex 
+            Candidate(gain_value_type g, int v, signed char p, unsigned int ver) : gain(g), vertex(v), partition(p), version(ver) {}
+            /// @param rhs another candidate 
+            /// @return true if \a rhs is preferred, for the max-heap 
+            bool operator<(Candidate const& rhs) const 
+            {
+                if (gain != rhs.gain) return gain < rhs.gain; 
+                if (vertex != rhs.vertex) return vertex > rhs.vertex; 
+                return partition > rhs.partition; 
+            }
+        };
 
         /// @brief constructor 
         /// @param gc function object of gain calculator 
@@ -60,6 +113,7 @@ class FMMultiWay
             , m_num_partitions(tp)
             , m_vPartition(tn, -1)
             , m_vFixed(tn, false)
+            , m_num_passes(0)
         {
             m_vVertexMove.reserve(tn);
         }
@@ -76,6 +130,17 @@ class FMMultiWay
         /// @param v vertex 
         /// @return partition 
         signed char partition(int v) const {return m_vPartition[v];}
+        /// @brief stop a pass early 
+        /// @param n number of moves without improvement to end a pass, 0 for no limit 
+        void set_max_stall(unsigned int n) {m_stop_rule.max_stall = n;}
+        /// @param n number of passes to end a run, 0 for no limit 
+        void set_max_passes(unsigned int n) {m_stop_rule.max_passes = n;}
+        /// @brief end a pass after more than \a alpha times the moves of its best prefix plus \a beta moves without improvement 
+        /// @param alpha relative part, 0 to disable 
+        /// @param beta absolute part 
+        void set_adaptive_stop(double alpha, unsigned int beta) {m_stop_rule.alpha = alpha; m_stop_rule.beta = beta;}
+        /// @return number of passes in the last run 
+        unsigned int num_passes() const {return m_num_passes;}
 
         /// @brief API to run the algorithm 
         void operator()() {return run();}
@@ -87,11 +152,33 @@ class FMMultiWay
         /// @param cp target partition 
         /// @param max_gain best gain of the movement 
         void find_candidate(int& cv, signed char& cp, gain_value_type& max_gain) const;
-        /// find best kth movement 
+        /// @brief initialize the gain cache, nothing to do without the hook 
+        void init_candidates(boost::false_type) {}
+        /// @brief compute gains of all vertices into the cache 
+        void init_candidates(boost::true_type);
+        /// @brief find the candidate with best gain by traversal 
+        /// @param cv find vertex to move 
+        /// @param cp target partition 
+        /// @param max_gain best gain of the movement 
+        void find_candidate(int& cv, signed char& cp, gain_value_type& max_gain, boost::false_type) {find_candidate(cv, cp, max_gain);}
+        /// @brief find the candidate with best gain from the cache 
+        /// @param cv find vertex to move 
+        /// @param cp target partition 
+        /// @param max_gain best gain of the movement 
+        void find_candidate(int& cv, signed char& cp, gain_value_type& max_gain, boost::true_type);
+        /// @brief update gains after a move, nothing to do without the hook 
+        void update_candidates(int, boost::false_type) {}
+        /// @brief recompute gains of vertices affected by a move 
+        /// @param v moved vertex 
+        void update_candidates(int v, boost::true_type);
+        /// @brief push gains of a vertex to all other partitions into the cache 
+        /// @param v vertex 
+        void push_candidates(int v);
+        /// find best kth movement in the move log 
         /// @param k index of movement 
         /// @param improve cumulative improvement at kth movement 
         void best_kth_move(int& k, gain_value_type& improve) const;
-        /// revert to kth movement 
+        /// revert to kth movement with the move log 
         /// @param k index of movement 
         void revert_to_kth_move(int k);
         /// reset movements and fixed flags 
@@ -103,6 +190,11 @@ class FMMultiWay
         std::vector<signed char> m_vPartition; ///< an array storing partition of each vertex 
         std::vector<bool> m_vFixed; ///< whehter fixed during current iteration 
         std::vector<VertexMove> m_vVertexMove; ///< record vertex movement during each iteration 
+        FMStopRule m_stop_rule; ///< rules to end passes and runs early 
+        unsigned int m_num_passes; ///< number of passes in the last run 
+        std::priority_queue<Candidate> m_candidates; ///< gain cache, only used with the hook of affected vertices 
+        std::vector<unsigned int> m_vVersion; ///< version of each vertex in the gain cache 
+        std::vector<int> m_vAffected; ///< buffer of affected vertices 
 };
 
 template <typename GainCalcType>
@@ -129,13 +221,68 @@ void FMMultiWay<GainCalcType>::find_candidate(int& cv, signed char& cp, FMMultiW
     }
 }
 
+template <typename GainCalcType>
+void FMMultiWay<GainCalcType>::push_candidates(int v)
+{
+    for (signed char p = 0; p != m_num_partitions; ++p)
+    {
+        if (p == m_vPartition[v]) continue;
+        m_candidates.push(Candidate(m_gain_calc(v, m_vPartition[v], p, m_vPartition), v, p, m_vVersion[v]));
+    }
+}
+
+template <typename GainCalcType>
+void FMMultiWay<GainCalcType>::init_candidates(boost::true_type)
+{
+    m_candidates = std::priority_queue<Candidate>();
+    m_vVersion.assign(m_num_vertice, 0);
+    for (int v = 0; v != m_num_vertice; ++v)
+        push_candidates(v);
+}
+
+template <typename GainCalcType>
+void FMMultiWay<GainCalcType>::find_candidate(int& cv, signed char& cp, FMMultiWay<GainCalcType>::gain_value_type& max_gain, boost::true_type)
+{
+    // drop stale gains of fixed or updated vertices 
+    while (!m_candidates.empty())
+    {
+        Candidate const& c = m_candidates.top();
+        if (!m_vFixed[c.vertex] && c.version == m_vVersion[c.vertex])
+        {
+            cv = c.vertex;
+            cp = c.partition;
+            max_gain = c.gain;
+            m_candidates.pop();
+            return;
+        }
+        m_candidates.pop();
+    }
+}
+
+template <typename GainCalcType>
+void FMMultiWay<GainCalcType>::update_candidates(int v, boost::true_type)
+{
+    m_vAffected.clear();
+    m_gain_calc.affected_vertices(v, m_vAffected);
+    // a vertex may be listed several times, but its gains only need one update 
+    std::sort(m_vAffected.begin(), m_vAffected.end());
+    m_vAffected.erase(std::unique(m_vAffected.begin(), m_vAffected.end()), m_vAffected.end());
+    for (std::vector<int>::const_iterator it = m_vAffected.begin(); it != m_vAffected.end(); ++it)
+    {
+        int u = *it;
+        if (m_vFixed[u]) continue;
+        ++m_vVersion[u];
+        push_candidates(u);
+    }
+}
+
 template <typename GainCalcType>
 void FMMultiWay<GainCalcType>::best_kth_move(int& k, FMMultiWay<GainCalcType>::gain_value_type& improve) const
 {
     k = -1;
     improve = 0;
     gain_value_type sum = 0;
-    for (int i = 0; i != m_num_vertice; ++i)
+    for (int i = 0, ie = m_vVertexMove.size(); i != ie; ++i)
     {
         sum += m_vVertexMove[i].gain;
         if (sum > improve)
@@ -149,7 +296,7 @@ void FMMultiWay<GainCalcType>::best_kth_move(int& k, FMMultiWay<GainCalcType>::g
 template <typename GainCalcType>
 void FMMultiWay<GainCalcType>::revert_to_kth_move(int k)
 {
-    for (int i = m_num_vertice-1; i > k; --i)
+    for (int i = (int)m_vVertexMove.size()-1; i > k; --i)
         m_vPartition[m_vVertexMove[i].vertex] = m_vVertexMove[i].orig_partition;
 }
 
@@ -163,15 +310,23 @@ void FMMultiWay<GainCalcType>::reset()
 template <typename GainCalcType>
 void FMMultiWay<GainCalcType>::run()
 {
+    typedef boost::integral_constant<bool, FMHasAffectedVertices<gain_calc_type>::value> cache_tag_type;
     gain_value_type improve = 0;
+    m_num_passes = 0;
     do 
     {
+        init_candidates(cache_tag_type());
+        gain_value_type sum = 0;
+        gain_value_type best_sum = 0;
+        int best_cnt = 0;
         for (int i = 0; i != m_num_vertice; ++i)
         {
+            if (m_stop_rule.stop_pass(i, best_cnt)) break;
+
             int v = -1;
             signed char p = -1;
             gain_value_type gain = 0; 
-            find_candidate(v, p, gain);
+            find_candidate(v, p, gain, cache_tag_type());
             assert(v >= 0);
 
             // collect move 
@@ -179,12 +334,21 @@ void FMMultiWay<GainCalcType>::run()
             // apply 
             m_vPartition[v] = p;
             m_vFixed[v] = true;
+            update_candidates(v, cache_tag_type());
+
+            sum += gain;
+            if (sum > best_sum)
+            {
+                best_sum = sum;
+                best_cnt = i+1;
+            }
         }
         int k = -1;
         best_kth_move(k, improve);
         revert_to_kth_move(k);
         reset();
-    } while (improve > 1e-3);
+        ++m_num_passes;
+    } while (improve > 1e-3 && !m_stop_rule.stop_run(m_num_passes));
 }
 
 } // namespace partition
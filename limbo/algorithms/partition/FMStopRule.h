@@ -0,0 +1,58 @@
+/**
+ * @file   FMStopRule.h
+ * @brief  Rules to end passes and runs of FM algorithms early
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_PARTITION_FMSTOPRULE_H
+#define LIMBO_ALGORITHMS_PARTITION_FMSTOPRULE_H
+
+#include <cstddef>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Partition
+namespace partition
+{
+
+/// @class limbo::algorithms::partition::FMStopRule
+/// @brief Rules to end passes and runs of @ref limbo::algorithms::partition::FM,
+/// @ref limbo::algorithms::partition::FMBucket and @ref limbo::algorithms::partition::FMMultiWay early.
+///
+/// Most improvement of a pass happens in its first moves, and moves after the best prefix are rolled back anyway.
+/// A pass ends after a fixed number of moves without improvement,
+/// or adaptively after more than alpha times the length of the best prefix plus beta such moves.
+/// A run ends after a number of passes. Zero values disable the rules, which is the default.
+struct FMStopRule
+{
+    unsigned int max_stall; ///< moves without improvement to end a pass, 0 for no limit
+    unsigned int max_passes; ///< passes to end a run, 0 for no limit
+    double alpha; ///< adaptive rule, moves without improvement relative to the best prefix, 0 to disable
+    unsigned int beta; ///< adaptive rule, moves without improvement allowed on top of the relative part
+
+    /// @brief constructor
+    FMStopRule() : max_stall(0), max_passes(0), alpha(0), beta(0) {}
+    /// @param num_moves moves in the current pass
+    /// @param best_cnt moves in the best prefix of the current pass
+    /// @return true to end the pass
+    bool stop_pass(std::size_t num_moves, std::size_t best_cnt) const
+    {
+        std::size_t stall = num_moves-best_cnt;
+        if (max_stall && stall >= max_stall) return true;
+        if (alpha > 0 && stall > alpha*best_cnt+beta) return true;
+        return false;
+    }
+    /// @param num_passes passes done
+    /// @return true to end the run
+    bool stop_run(unsigned int num_passes) const {return max_passes && num_passes >= max_passes;}
+};
+
+} // namespace partition
+} // namespace algorithms
+} // namespace limbo
+
+#endif
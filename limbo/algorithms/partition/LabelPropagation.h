@@ -0,0 +1,275 @@
+/**
+ * @file   LabelPropagation.h
+ * @brief  Parallel k-way refinement by label propagation
+ *
+ * Refer to Raghavan, Albert and Kumara,
+ * "Near linear time algorithm to detect community structures in large-scale networks", Physical Review E 2007,
+ * and Meyerhenke, Sanders and Schulz, "Parallel Graph Partitioning for Complex Networks", IPDPS 2015
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_PARTITION_LABELPROPAGATION_H
+#define LIMBO_ALGORITHMS_PARTITION_LABELPROPAGATION_H
+
+#include <vector>
+#include <algorithm>
+#include <boost/static_assert.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/algorithms/partition/FMMultiWay.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Partition
+namespace partition
+{
+
+/// @class limbo::algorithms::partition::LabelPropagation
+/// @brief K-way refinement by synchronous label propagation with threads.
+///
+/// It uses the same gain calculators as @ref limbo::algorithms::partition::FMMultiWay,
+/// and requires the hook checked by @ref limbo::algorithms::partition::FMHasAffectedVertices.
+/// Each round has three steps.
+/// 1. Threads take chunks of vertices, and each vertex proposes the partition of the largest positive gain.
+/// 2. Threads take chunks again, and a proposal is kept if it beats the proposals of all affected vertices,
+///    by larger gain and then smaller vertex, so kept moves never affect each other and their gains add up exactly.
+/// 3. Kept moves are applied in the order of vertices unless they overload the target partition.
+///
+/// Rounds stop when no vertex moves. Results do not depend on the number of threads.
+/// An optional sequential polish by @ref limbo::algorithms::partition::FMMultiWay follows,
+/// which ignores balance constraints like FMMultiWay does.
+/// @tparam GainCalcType a function object that calculate gains, refer to @ref limbo::algorithms::coloring::SDPColoringCsdp::FMGainCalcType for example.
+template <typename GainCalcType>
+class LabelPropagation
+{
+    public:
+        /// @nowarn
+        typedef GainCalcType gain_calc_type;
+        typedef typename gain_calc_type::value_type gain_value_type;
+        /// @endnowarn
+        BOOST_STATIC_ASSERT(FMHasAffectedVertices<gain_calc_type>::value);
+
+        /// @brief constructor
+        /// @param gc function object of gain calculator
+        /// @param tn number of vertices
+        /// @param tp number of partitions
+        LabelPropagation(gain_calc_type const& gc, int tn, signed char tp)
+            : m_gain_calc(gc)
+            , m_num_vertice(tn)
+            , m_num_partitions(tp)
+            , m_num_threads(1)
+            , m_max_rounds(32)
+            , m_max_imbalance(-1)
+            , m_polish(false)
+            , m_num_rounds(0)
+            , m_vPartition(tn, -1)
+            , m_vWeight(tn, 1)
+        {
+        }
+        /// @brief set vertex \a v to partition \a p
+        /// @param v vertex
+        /// @param p partition
+        void set_partition(int v, signed char p) {m_vPartition[v] = p;}
+        /// @brief set partitions
+        /// @tparam Iterator iterator to the array of partitions
+        /// @param first, last begin and end iterator to the array of partitions
+        template <typename Iterator>
+        void set_partitions(Iterator first, Iterator last) {m_vPartition.assign(first, last);}
+        /// @brief set weights of vertices for balance constraints, 1 by default
+        /// @tparam Iterator iterator to the array of weights
+        /// @param first, last begin and end iterator to the array of weights
+        template <typename Iterator>
+        void set_vertex_weights(Iterator first, Iterator last) {m_vWeight.assign(first, last);}
+        /// @brief get partition of a vertex
+        /// @param v vertex
+        /// @return partition
+        signed char partition(int v) const {return m_vPartition[v];}
+        /// @param n number of threads
+        void set_num_threads(int n) {m_num_threads = std::max(n, 1);}
+        /// @param n maximum number of rounds
+        void set_max_rounds(int n) {m_max_rounds = n;}
+        /// @brief a partition may not exceed (1+eps) times the average weight after a move, negative for no constraint
+        /// @param eps allowed imbalance
+        void set_max_imbalance(double eps) {m_max_imbalance = eps;}
+        /// @param p whether to polish by @ref limbo::algorithms::partition::FMMultiWay at last
+        void set_polish(bool p) {m_polish = p;}
+        /// @return number of rounds in the last run
+        int num_rounds() const {return m_num_rounds;}
+
+        /// @brief API to run the algorithm
+        void operator()() {return run();}
+    protected:
+        /// @brief steps of a round run by threads
+        enum StepType
+        {
+            PROPOSE, ///< compute the best move of each vertex
+            SELECT ///< keep moves beating all affected vertices
+        };
+        /// @brief chunks of a step run by limbo::containers::parallel_for
+        struct step_task_type
+        {
+            LabelPropagation* pLP; ///< this object
+            StepType step; ///< step to run
+            /// @param b first vertex of a chunk
+            /// @param e end vertex of the chunk
+            void operator()(std::size_t b, std::size_t e) const {pLP->work(step, b, e);}
+        };
+        /// vertices in a chunk of a step
+        static const int chunk_size = 4096;
+
+        /// @brief kernel function to run the algorithm
+        void run();
+        /// @brief run a step with threads
+        /// @param step step to run
+        void run_step(StepType step);
+        /// @brief run a step on a chunk of vertices
+        /// @param step step to run
+        /// @param first first vertex
+        /// @param last end vertex
+        void work(StepType step, int first, int last);
+        /// @brief propose the best move of a vertex
+        /// @param v vertex
+        void propose(int v);
+        /// @brief keep the proposal of a vertex if it beats all affected vertices
+        /// @param v vertex
+        /// @param vAffected buffer of affected vertices
+        void select(int v, std::vector<int>& vAffected);
+        /// @brief apply kept moves
+        /// @return number of moved vertices
+        int apply();
+
+        gain_calc_type const& m_gain_calc; ///< function object to calculate gains
+        int m_num_vertice; ///< total number of vertices
+        int m_num_partitions; ///< total number of partitions
+        int m_num_threads; ///< number of threads
+        int m_max_rounds; ///< maximum number of rounds
+        double m_max_imbalance; ///< allowed imbalance, negative for no constraint
+        bool m_polish; ///< whether to polish by FMMultiWay
+        int m_num_rounds; ///< number of rounds in the last run
+        std::vector<signed char> m_vPartition; ///< an array storing partition of each vertex
+        std::vector<double> m_vWeight; ///< weight of each vertex
+        std::vector<signed char> m_vTarget; ///< proposed partition of each vertex, -1 for no move
+        std::vector<gain_value_type> m_vGain; ///< gain of the proposal of each vertex
+        std::vector<char> m_vKeep; ///< whether the proposal of each vertex is kept
+};
+
+template <typename GainCalcType>
+void LabelPropagation<GainCalcType>::propose(int v)
+{
+    m_vTarget[v] = -1;
+    m_vGain[v] = 0;
+    for (signed char p = 0; p != m_num_partitions; ++p)
+    {
+        // skip its own partition
+        if (p == m_vPartition[v]) continue;
+        gain_value_type cur_gain = m_gain_calc(v, m_vPartition[v], p, m_vPartition);
+        if (cur_gain > m_vGain[v])
+        {
+            m_vTarget[v] = p;
+            m_vGain[v] = cur_gain;
+        }
+    }
+}
+
+template <typename GainCalcType>
+void LabelPropagation<GainCalcType>::select(int v, std::vector<int>& vAffected)
+{
+    m_vKeep[v] = false;
+    if (m_vTarget[v] < 0) return;
+    vAffected.clear();
+    m_gain_calc.affected_vertices(v, vAffected);
+    for (std::vector<int>::const_iterator it = vAffected.begin(); it != vAffected.end(); ++it)
+    {
+        int u = *it;
+        if (u == v || m_vTarget[u] < 0) continue;
+        if (m_vGain[u] > m_vGain[v] || (m_vGain[u] == m_vGain[v] && u < v))
+            return;
+    }
+    m_vKeep[v] = true;
+}
+
+template <typename GainCalcType>
+void LabelPropagation<GainCalcType>::work(StepType step, int first, int last)
+{
+    std::vector<int> vAffected;
+    for (int v = first; v < last; ++v)
+    {
+        if (step == PROPOSE)
+            propose(v);
+        else
+            select(v, vAffected);
+    }
+}
+
+template <typename GainCalcType>
+void LabelPropagation<GainCalcType>::run_step(StepType step)
+{
+    step_task_type task;
+    task.pLP = this;
+    task.step = step;
+
+    int numThreads = std::min((int)limbo::containers::num_threads(), m_num_threads);
+    limbo::containers::parallel_for(0, m_num_vertice, chunk_size, numThreads, task);
+}
+
+template <typename GainCalcType>
+int LabelPropagation<GainCalcType>::apply()
+{
+    std::vector<double> vPartitionWeight (m_num_partitions, 0);
+    double totalWeight = 0;
+    for (int v = 0; v != m_num_vertice; ++v)
+    {
+        if (m_vPartition[v] >= 0)
+            vPartitionWeight[m_vPartition[v]] += m_vWeight[v];
+        totalWeight += m_vWeight[v];
+    }
+    double maxWeight = (1+m_max_imbalance)*totalWeight/m_num_partitions;
+
+    int numMoves = 0;
+    for (int v = 0; v != m_num_vertice; ++v)
+    {
+        if (!m_vKeep[v]) continue;
+        signed char p = m_vTarget[v];
+        if (m_max_imbalance >= 0 && vPartitionWeight[p]+m_vWeight[v] > maxWeight) continue;
+        if (m_vPartition[v] >= 0)
+            vPartitionWeight[m_vPartition[v]] -= m_vWeight[v];
+        vPartitionWeight[p] += m_vWeight[v];
+        m_vPartition[v] = p;
+        ++numMoves;
+    }
+    return numMoves;
+}
+
+template <typename GainCalcType>
+void LabelPropagation<GainCalcType>::run()
+{
+    m_vTarget.assign(m_num_vertice, -1);
+    m_vGain.assign(m_num_vertice, 0);
+    m_vKeep.assign(m_num_vertice, false);
+    for (m_num_rounds = 0; m_num_rounds < m_max_rounds; )
+    {
+        run_step(PROPOSE);
+        run_step(SELECT);
+        ++m_num_rounds;
+        if (apply() == 0) break;
+    }
+
+    if (m_polish)
+    {
+        FMMultiWay<gain_calc_type> fmp (m_gain_calc, m_num_vertice, m_num_partitions);
+        fmp.set_partitions(m_vPartition.begin(), m_vPartition.end());
+        fmp();
+        for (int v = 0; v != m_num_vertice; ++v)
+            m_vPartition[v] = fmp.partition(v);
+    }
+}
+
+} // namespace partition
+} // namespace algorithms
+} // namespace limbo
+
+#endif
@@ -0,0 +1,223 @@
+/**
+ * @file   MultiStartFM.h
+ * @brief  FM bipartitioning from several starts in parallel, keeping the best cut
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_PARTITION_MULTISTARTFM_H
+#define LIMBO_ALGORITHMS_PARTITION_MULTISTARTFM_H
+
+#include <vector>
+#include <algorithm>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/algorithms/partition/FMBucket.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Partition
+namespace partition
+{
+
+/// @class limbo::algorithms::partition::MultiStartFM
+/// @brief Best of several runs of @ref limbo::algorithms::partition::FMBucket from different initial partitions
+///
+/// The first start uses the initial partitions given to add_node(),
+/// and the others use random balanced partitions from the seed and the index of the start.
+/// Starts run in parallel. Each thread copies the hypergraph once and keeps its own gain buckets,
+/// while the input is only read.
+/// The best start is balanced if any is, then has the smallest cut size, then the smallest index,
+/// so results only depend on the seed, not on the number of threads.
+///
+/// The interface follows @ref limbo::algorithms::partition::FMBucket, and its settings apply to every start.
+/// @tparam NodeType indicates type of nodes in the graph
+/// @tparam NetWeightType type of net weight values, must be integral
+template <typename NodeType, typename NetWeightType = int>
+class MultiStartFM : public FMBucket<NodeType, NetWeightType>
+{
+	public:
+        /// @nowarn
+		typedef FMBucket<NodeType, NetWeightType> base_type;
+		typedef typename base_type::node_type node_type;
+		typedef typename base_type::net_weight_type net_weight_type;
+		typedef typename base_type::node_weight_type node_weight_type;
+        /// @endnowarn
+
+        /// @brief constructor
+		MultiStartFM() : base_type(), m_num_starts(8), m_num_threads(1), m_seed(1), m_best_start(0) {}
+
+		/// @param n number of starts
+		void set_num_starts(unsigned int n) {m_num_starts = std::max(n, 1U);}
+		/// @param n number of threads
+		void set_num_threads(unsigned int n) {m_num_threads = std::max(n, 1U);}
+		/// @param s random seed
+		void set_seed(unsigned int s) {m_seed = s;}
+		/// @return start of the best cut in the last run, 0 for the given initial partitions
+		unsigned int best_start() const {return m_best_start;}
+		/// @return cut size of each start in the last run
+		std::vector<net_weight_type> const& start_cutsizes() const {return m_vCutsize;}
+		/// Top api for multi-start FM
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return best cut size
+		net_weight_type operator()(double ratio1, double ratio2)
+		{
+			return this->run_starts(ratio1, ratio2);
+		}
+	protected:
+		/// @brief FM of a block of starts with its own copy of the hypergraph
+		class runner_type : public base_type
+		{
+			public:
+				/// @brief constructor
+				/// @param b partitioner with the hypergraph and settings
+				runner_type(base_type const& b) : base_type(b) {}
+				/// @brief run FM from a partition
+				/// @param vPartition partition of each node, updated
+				/// @param ratio1 minimum target ratio for partition 0 over partition 1
+				/// @param ratio2 maximum target ratio for partition 0 over partition 1
+				/// @return cut size
+				net_weight_type refine(std::vector<int>& vPartition, double ratio1, double ratio2)
+				{
+					this->m_vPartition.swap(vPartition);
+					net_weight_type cs = this->run(ratio1, ratio2);
+					this->m_vPartition.swap(vPartition);
+					return cs;
+				}
+				/// @return number of passes in the last run
+				unsigned int passes() const {return this->m_num_pass;}
+		};
+		/// @brief starts shared by threads
+		struct start_task_type
+		{
+			MultiStartFM const* pFM; ///< partitioner
+			double ratio1; ///< minimum target ratio
+			double ratio2; ///< maximum target ratio
+			std::vector<std::vector<int> > vPartition; ///< partition of each start
+			std::vector<net_weight_type> vCutsize; ///< cut size of each start
+			std::vector<unsigned int> vNumPass; ///< number of passes of each start
+		};
+		/// @brief starts run by limbo::containers::parallel_for
+		struct start_kernel_type
+		{
+			start_task_type* task; ///< shared task
+			/// @param b first start
+			/// @param e end start
+			void operator()(std::size_t b, std::size_t e) const {task->pFM->work(*task, b, e);}
+		};
+
+		/// @brief a small random number generator for each start
+		/// @param state state, updated
+		/// @return random number
+		static unsigned int random(unsigned int& state)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+		/// @param vPartition partition of each node
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return true if the ratio of partitions is in the target range
+		bool balanced(std::vector<int> const& vPartition, double ratio1, double ratio2) const
+		{
+			node_weight_type total_weight[2] = {0, 0};
+			for (std::size_t i = 0; i < vPartition.size(); ++i)
+				total_weight[vPartition[i]] += this->m_vWeight[i];
+			double ratio = (double)total_weight[0]/total_weight[1];
+			return ratio >= ratio1 && ratio <= ratio2;
+		}
+		/// @brief random partition with about \a ratio times the weight of partition 1 in partition 0
+		/// @param vPartition partition of each node
+		/// @param ratio target ratio for partition 0 over partition 1
+		/// @param state random state
+		void random_partition(std::vector<int>& vPartition, double ratio, unsigned int state) const
+		{
+			std::size_t numNodes = this->m_vWeight.size();
+			std::vector<unsigned int> vOrder (numNodes);
+			for (std::size_t i = 0; i < numNodes; ++i)
+				vOrder[i] = i;
+			for (std::size_t i = numNodes; i > 1; --i)
+				std::swap(vOrder[i-1], vOrder[random(state)%i]);
+			node_weight_type total_weight = 0;
+			for (std::size_t i = 0; i < numNodes; ++i)
+				total_weight += this->m_vWeight[i];
+			double target = total_weight*ratio/(1+ratio);
+			node_weight_type weight = 0;
+			vPartition.assign(numNodes, 1);
+			for (std::size_t i = 0; i < numNodes && weight < target; ++i)
+			{
+				vPartition[vOrder[i]] = 0;
+				weight += this->m_vWeight[vOrder[i]];
+			}
+		}
+        /// @brief run all starts and keep the best one
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return best cut size
+		net_weight_type run_starts(double ratio1, double ratio2)
+		{
+			start_task_type task;
+			task.pFM = this;
+			task.ratio1 = ratio1;
+			task.ratio2 = ratio2;
+			task.vPartition.resize(m_num_starts);
+			task.vCutsize.resize(m_num_starts);
+			task.vNumPass.resize(m_num_starts);
+
+			unsigned int numThreads = std::min(limbo::containers::num_threads(), m_num_threads);
+			start_kernel_type kernel = {&task};
+			limbo::containers::parallel_for(0, m_num_starts, 1, numThreads, kernel);
+
+			// balanced partitions first, then smaller cut sizes, then earlier starts
+			unsigned int best = 0;
+			bool bestBalanced = balanced(task.vPartition[0], ratio1, ratio2);
+			for (unsigned int s = 1; s < m_num_starts; ++s)
+			{
+				bool b = balanced(task.vPartition[s], ratio1, ratio2);
+				if ((b && !bestBalanced) || (b == bestBalanced && task.vCutsize[s] < task.vCutsize[best]))
+				{
+					best = s;
+					bestBalanced = b;
+				}
+			}
+			m_best_start = best;
+			m_vCutsize.swap(task.vCutsize);
+			this->m_vPartition.swap(task.vPartition[best]);
+			this->m_num_pass = task.vNumPass[best];
+			return m_vCutsize[best];
+		}
+		/// @brief run a range of starts
+		/// @param task shared task
+		/// @param first first start
+		/// @param last end start
+		void work(start_task_type& task, unsigned int first, unsigned int last) const
+		{
+			runner_type runner (*this);
+			for (unsigned int s = first; s < last; ++s)
+			{
+				if (s == 0)
+					task.vPartition[s] = this->m_vPartition;
+				else
+					this->random_partition(task.vPartition[s], (task.ratio1+task.ratio2)/2, m_seed*2654435761U+s*7919U+1);
+				task.vCutsize[s] = runner.refine(task.vPartition[s], task.ratio1, task.ratio2);
+				task.vNumPass[s] = runner.passes();
+			}
+		}
+
+		unsigned int m_num_starts; ///< number of starts
+		unsigned int m_num_threads; ///< number of threads
+		unsigned int m_seed; ///< random seed
+		unsigned int m_best_start; ///< start of the best cut in the last run
+		std::vector<net_weight_type> m_vCutsize; ///< cut size of each start in the last run
+};
+
+} // namespace partition
+} // namespace algorithms
+} // namespace limbo
+
+#endif
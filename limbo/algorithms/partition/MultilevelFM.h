@@ -0,0 +1,522 @@
+/**
+ * @file   MultilevelFM.h
+ * @brief  Multilevel bipartitioning with FM refinement
+ *
+ * Refer to Karypis, Aggarwal, Kumar and Shekhar,
+ * "Multilevel Hypergraph Partitioning: Applications in VLSI Domain", DAC 1997
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_ALGORITHMS_PARTITION_MULTILEVELFM_H
+#define LIMBO_ALGORITHMS_PARTITION_MULTILEVELFM_H
+
+#include <vector>
+#include <deque>
+#include <limits>
+#include <algorithm>
+#include <boost/unordered_map.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/algorithms/partition/FMBucket.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Partition
+namespace partition
+{
+
+/// @class limbo::algorithms::partition::MultilevelFM
+/// @brief Multilevel bipartitioning of hypergraphs
+///
+/// The hypergraph is coarsened by matching nodes along heavy nets until it is small,
+/// partitioned from several starts of greedy growing refined by FM in parallel,
+/// and projected back level by level with FM refinement on each level.
+/// All levels are CSR hypergraphs, and refinement runs @ref limbo::algorithms::partition::FMBucket,
+/// so net weights must be integers.
+///
+/// The interface follows @ref limbo::algorithms::partition::FM, except that initial partitions are not needed.
+/// Results only depend on the seed, not on the number of threads.
+/// @tparam NodeType indicates type of nodes in the graph
+/// @tparam NetWeightType type of net weight values, must be integral
+template <typename NodeType, typename NetWeightType = int>
+class MultilevelFM
+{
+	public:
+        /// @nowarn
+		typedef NodeType node_type;
+		typedef NetWeightType net_weight_type;
+		typedef typename FM_node_traits<node_type>::node_weight_type node_weight_type;
+        /// @endnowarn
+
+		/// @brief rules to match nodes in coarsening
+		enum CoarseningType
+		{
+			HEAVY_EDGE, ///< match pairs of unmatched nodes with the heaviest connection
+			FIRST_CHOICE ///< join the node with the heaviest connection, matched or not, while clusters are light
+		};
+
+		/// @class limbo::algorithms::partition::MultilevelFM::Hypergraph
+		/// @brief a level of the hypergraph in CSR
+		struct Hypergraph
+		{
+			std::vector<std::size_t> vNetBegin; ///< first node of each net in vPin, with one more entry for the end
+			std::vector<unsigned int> vPin; ///< nodes of nets
+			std::vector<net_weight_type> vNetWeight; ///< weight of each net
+			std::vector<std::size_t> vNodeNetBegin; ///< first net of each node in vNodeNet, with one more entry for the end
+			std::vector<unsigned int> vNodeNet; ///< nets of nodes
+			std::vector<node_weight_type> vNodeWeight; ///< weight of each node
+			std::vector<unsigned int> vCoarse; ///< node of each node in the next coarser level
+
+			/// @return number of nodes
+			unsigned int num_nodes() const {return vNodeWeight.size();}
+			/// @return number of nets
+			std::size_t num_nets() const {return vNetWeight.size();}
+			/// @brief build nets of each node from nodes of each net
+			void build_incidence()
+			{
+				vNodeNetBegin.assign(num_nodes()+1, 0);
+				for (std::size_t j = 0; j < vPin.size(); ++j)
+					++vNodeNetBegin[vPin[j]+1];
+				for (unsigned int i = 0; i < num_nodes(); ++i)
+					vNodeNetBegin[i+1] += vNodeNetBegin[i];
+				vNodeNet.resize(vPin.size());
+				std::vector<std::size_t> vPos (vNodeNetBegin.begin(), vNodeNetBegin.end()-1);
+				for (std::size_t i = 0; i < num_nets(); ++i)
+					for (std::size_t j = vNetBegin[i]; j < vNetBegin[i+1]; ++j)
+						vNodeNet[vPos[vPin[j]]++] = i;
+			}
+		};
+
+        /// @brief constructor
+		MultilevelFM()
+			: m_coarsening(FIRST_CHOICE)
+			, m_coarsest_size(200)
+			, m_max_net_size(64)
+			, m_num_starts(8)
+			, m_num_threads(1)
+			, m_max_stall(256)
+			, m_seed(1)
+			, m_num_levels(0)
+		{
+			m_vLevel.resize(1);
+			m_vLevel[0].vNetBegin.push_back(0);
+		}
+        /// @brief add node
+        /// @param pNode a node
+		/// @return whehter insertion is successful
+		bool add_node(node_type* pNode)
+		{
+			if (!m_hNode.insert(std::make_pair(pNode, m_vLevel[0].num_nodes())).second)
+				return false;
+			m_vLevel[0].vNodeWeight.push_back(FM_node_traits<node_type>::weight(*pNode));
+			m_vPartition.push_back(0);
+			return true;
+		}
+        /// @brief add nets
+        ///
+		/// This function must be called after all nodes are inserted.
+		/// Duplicate nodes in a net are kept once.
+        ///
+        /// @tparam Iterator iterator of net array, dereference of which must be type of node
+        /// @param weight weight of nets
+		/// @param first, last begin and end iterator of net array
+		/// @return whehter a net is successfully added
+		template <typename Iterator>
+		bool add_net(net_weight_type const& weight, Iterator first, Iterator last)
+		{
+			Hypergraph& h = m_vLevel[0];
+			std::size_t begin = h.vPin.size();
+			for (Iterator it = first; it != last; ++it)
+			{
+				typename boost::unordered_map<node_type*, unsigned int>::const_iterator found = m_hNode.find(*it);
+				if (found == m_hNode.end())
+				{
+					h.vPin.resize(begin);
+					return false;
+				}
+				h.vPin.push_back(found->second);
+			}
+			std::sort(h.vPin.begin()+begin, h.vPin.end());
+			h.vPin.erase(std::unique(h.vPin.begin()+begin, h.vPin.end()), h.vPin.end());
+			h.vNetBegin.push_back(h.vPin.size());
+			h.vNetWeight.push_back(weight);
+			return true;
+		}
+		/// @param t rule to match nodes in coarsening
+		void set_coarsening(CoarseningType t) {m_coarsening = t;}
+		/// @param n stop coarsening at this number of nodes
+		void set_coarsest_size(unsigned int n) {m_coarsest_size = std::max(n, 2U);}
+		/// @param n nets with more nodes are ignored in matching
+		void set_max_net_size(unsigned int n) {m_max_net_size = n;}
+		/// @param n number of starts of initial partitioning
+		void set_num_starts(unsigned int n) {m_num_starts = std::max(n, 1U);}
+		/// @param n number of threads of initial partitioning
+		void set_num_threads(unsigned int n) {m_num_threads = std::max(n, 1U);}
+		/// @param n number of moves without a better cut size to end a pass of refinement, 0 for no limit
+		void set_max_stall(unsigned int n) {m_max_stall = n;}
+		/// @param s random seed
+		void set_seed(unsigned int s) {m_seed = s;}
+		/// @param pNode a node
+		/// @return partition of the node, -1 if not found
+		int partition(node_type* pNode) const
+		{
+			typename boost::unordered_map<node_type*, unsigned int>::const_iterator found = m_hNode.find(pNode);
+			return (found == m_hNode.end())? -1 : m_vPartition[found->second];
+		}
+		/// @return number of levels in the last run, including the input hypergraph
+		unsigned int num_levels() const {return m_num_levels;}
+		/// @return all levels of the last run, the first one is the input hypergraph
+		std::vector<Hypergraph> const& levels() const {return m_vLevel;}
+		/// @return cut size of current partition
+		net_weight_type cutsize() const {return cutsize(m_vLevel[0], m_vPartition);}
+		/// Top api for multilevel partitioning
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return final cutsize after partition
+		net_weight_type operator()(double ratio1, double ratio2)
+		{
+			return this->run(ratio1, ratio2);
+		}
+	protected:
+		/// @brief FM refinement on a level, nodes of which have no objects, so ties are broken by order
+		class refiner_type : public FMBucket<node_type, net_weight_type>
+		{
+			public:
+				/// @nowarn
+				typedef FMBucket<node_type, net_weight_type> base_type;
+				/// @endnowarn
+
+				/// @brief constructor
+				/// @param maxStall number of moves without a better cut size to end a pass
+				refiner_type(unsigned int maxStall)
+				{
+					this->set_tie_break(base_type::TIE_BY_ORDER);
+					this->set_max_stall(maxStall);
+				}
+				/// @brief refine a partition
+				/// @param h hypergraph
+				/// @param vPartition partition of each node, updated
+				/// @param ratio1 minimum target ratio for partition 0 over partition 1
+				/// @param ratio2 maximum target ratio for partition 0 over partition 1
+				/// @return cut size
+				net_weight_type refine(Hypergraph const& h, std::vector<int>& vPartition, double ratio1, double ratio2)
+				{
+					this->m_vNode.assign(h.num_nodes(), NULL);
+					this->m_vPartition.swap(vPartition);
+					this->m_vWeight = h.vNodeWeight;
+					this->m_vNetBegin = h.vNetBegin;
+					this->m_vPin = h.vPin;
+					this->m_vNetWeight = h.vNetWeight;
+					net_weight_type cs = this->run(ratio1, ratio2);
+					this->m_vPartition.swap(vPartition);
+					return cs;
+				}
+		};
+		/// @brief task of initial partitioning shared by threads
+		struct start_task_type
+		{
+			MultilevelFM const* pFM; ///< partitioner
+			Hypergraph const* pGraph; ///< coarsest level
+			double ratio1; ///< minimum target ratio
+			double ratio2; ///< maximum target ratio
+			std::vector<std::vector<int> > vPartition; ///< partition of each start
+			std::vector<net_weight_type> vCutsize; ///< cut size of each start
+		};
+		/// @brief starts of initial partitioning run by limbo::containers::parallel_for
+		struct start_kernel_type
+		{
+			start_task_type* task; ///< shared task
+			/// @param b first start
+			/// @param e end start
+			void operator()(std::size_t b, std::size_t e) const {task->pFM->run_starts(*task, b, e);}
+		};
+
+		/// @brief a small random number generator for each start or level
+		/// @param state state, updated
+		/// @return random number
+		static unsigned int random(unsigned int& state)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			return state;
+		}
+		/// @return value of no node
+		static unsigned int none() {return std::numeric_limits<unsigned int>::max();}
+		/// @param h hypergraph
+		/// @param vPartition partition of each node
+		/// @return cut size
+		static net_weight_type cutsize(Hypergraph const& h, std::vector<int> const& vPartition)
+		{
+			net_weight_type cs = 0;
+			for (std::size_t i = 0; i < h.num_nets(); ++i)
+				for (std::size_t j = h.vNetBegin[i]+1; j < h.vNetBegin[i+1]; ++j)
+					if (vPartition[h.vPin[j]] != vPartition[h.vPin[h.vNetBegin[i]]])
+					{
+						cs += h.vNetWeight[i];
+						break;
+					}
+			return cs;
+		}
+		/// @param h hypergraph
+		/// @param vPartition partition of each node
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return true if the ratio of partitions is in the target range
+		static bool balanced(Hypergraph const& h, std::vector<int> const& vPartition, double ratio1, double ratio2)
+		{
+			node_weight_type total_weight[2] = {0, 0};
+			for (unsigned int i = 0; i < h.num_nodes(); ++i)
+				total_weight[vPartition[i]] += h.vNodeWeight[i];
+			double ratio = (double)total_weight[0]/total_weight[1];
+			return ratio >= ratio1 && ratio <= ratio2;
+		}
+
+        /// @brief kernel function to run the algorithm
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		/// @return final cut size
+		net_weight_type run(double ratio1, double ratio2)
+		{
+			// keep the input and drop levels of the last run
+			m_vLevel.resize(1);
+			m_vLevel[0].build_incidence();
+			unsigned int state = m_seed*2654435761U+1;
+			while (m_vLevel.back().num_nodes() > m_coarsest_size)
+			{
+				m_vLevel.push_back(Hypergraph());
+				if (!this->coarsen(m_vLevel[m_vLevel.size()-2], m_vLevel.back(), state))
+				{
+					m_vLevel.pop_back();
+					break;
+				}
+			}
+			m_num_levels = m_vLevel.size();
+
+			std::vector<int> vPartition;
+			this->initial_partition(m_vLevel.back(), vPartition, ratio1, ratio2);
+			refiner_type refiner (m_max_stall);
+			for (int l = (int)m_vLevel.size()-2; l >= 0; --l)
+			{
+				Hypergraph const& h = m_vLevel[l];
+				std::vector<int> vFine (h.num_nodes());
+				for (unsigned int i = 0; i < h.num_nodes(); ++i)
+					vFine[i] = vPartition[h.vCoarse[i]];
+				vPartition.swap(vFine);
+				refiner.refine(h, vPartition, ratio1, ratio2);
+			}
+			m_vPartition.swap(vPartition);
+			return this->cutsize();
+		}
+		/// @brief match nodes and contract them into the next level
+		/// @param h hypergraph, its map to coarse nodes is set
+		/// @param coarse next coarser level
+		/// @param state random state
+		/// @return false if the number of nodes does not reduce enough
+		bool coarsen(Hypergraph& h, Hypergraph& coarse, unsigned int& state)
+		{
+			unsigned int numNodes = h.num_nodes();
+			node_weight_type totalWeight = 0;
+			for (unsigned int i = 0; i < numNodes; ++i)
+				totalWeight += h.vNodeWeight[i];
+			// clusters stay light enough to be balanced at the coarsest level
+			double maxWeight = 1.5*totalWeight/m_coarsest_size;
+
+			std::vector<unsigned int> vOrder (numNodes);
+			for (unsigned int i = 0; i < numNodes; ++i)
+				vOrder[i] = i;
+			for (unsigned int i = numNodes; i > 1; --i)
+				std::swap(vOrder[i-1], vOrder[random(state)%i]);
+
+			h.vCoarse.assign(numNodes, none());
+			coarse.vNodeWeight.clear();
+			std::vector<double> vScore (numNodes, 0);
+			std::vector<unsigned int> vTouched;
+			for (unsigned int k = 0; k < numNodes; ++k)
+			{
+				unsigned int u = vOrder[k];
+				if (h.vCoarse[u] != none()) continue;
+				vTouched.clear();
+				for (std::size_t e = h.vNodeNetBegin[u]; e < h.vNodeNetBegin[u+1]; ++e)
+				{
+					unsigned int net = h.vNodeNet[e];
+					std::size_t size = h.vNetBegin[net+1]-h.vNetBegin[net];
+					if (size < 2 || size > m_max_net_size) continue;
+					double w = (double)h.vNetWeight[net]/(size-1);
+					for (std::size_t j = h.vNetBegin[net]; j < h.vNetBegin[net+1]; ++j)
+					{
+						unsigned int v = h.vPin[j];
+						if (v == u || (m_coarsening == HEAVY_EDGE && h.vCoarse[v] != none())) continue;
+						if (vScore[v] == 0) vTouched.push_back(v);
+						vScore[v] += w;
+					}
+				}
+				unsigned int best = none();
+				for (std::vector<unsigned int>::const_iterator it = vTouched.begin(); it != vTouched.end(); ++it)
+				{
+					unsigned int v = *it;
+					node_weight_type weight = (h.vCoarse[v] == none())? h.vNodeWeight[v] : coarse.vNodeWeight[h.vCoarse[v]];
+					if (h.vNodeWeight[u]+weight <= maxWeight
+							&& (best == none() || vScore[v] > vScore[best] || (vScore[v] == vScore[best] && v < best)))
+						best = v;
+				}
+				for (std::vector<unsigned int>::const_iterator it = vTouched.begin(); it != vTouched.end(); ++it)
+					vScore[*it] = 0;
+
+				if (best != none() && h.vCoarse[best] != none())
+				{
+					h.vCoarse[u] = h.vCoarse[best];
+					coarse.vNodeWeight[h.vCoarse[u]] += h.vNodeWeight[u];
+				}
+				else
+				{
+					h.vCoarse[u] = coarse.vNodeWeight.size();
+					coarse.vNodeWeight.push_back(h.vNodeWeight[u]);
+					if (best != none())
+					{
+						h.vCoarse[best] = h.vCoarse[u];
+						coarse.vNodeWeight.back() += h.vNodeWeight[best];
+					}
+				}
+			}
+			if (coarse.num_nodes() > 0.95*numNodes)
+				return false;
+
+			// nets with one node left are dropped
+			coarse.vNetBegin.assign(1, 0);
+			coarse.vPin.clear();
+			coarse.vNetWeight.clear();
+			for (std::size_t i = 0; i < h.num_nets(); ++i)
+			{
+				std::size_t begin = coarse.vPin.size();
+				for (std::size_t j = h.vNetBegin[i]; j < h.vNetBegin[i+1]; ++j)
+					coarse.vPin.push_back(h.vCoarse[h.vPin[j]]);
+				std::sort(coarse.vPin.begin()+begin, coarse.vPin.end());
+				coarse.vPin.erase(std::unique(coarse.vPin.begin()+begin, coarse.vPin.end()), coarse.vPin.end());
+				if (coarse.vPin.size()-begin < 2)
+					coarse.vPin.resize(begin);
+				else
+				{
+					coarse.vNetBegin.push_back(coarse.vPin.size());
+					coarse.vNetWeight.push_back(h.vNetWeight[i]);
+				}
+			}
+			coarse.build_incidence();
+			return true;
+		}
+		/// @brief partition the coarsest level from several starts and keep the best one
+		/// @param h coarsest level
+		/// @param vPartition partition of each node
+		/// @param ratio1 minimum target ratio for partition 0 over partition 1
+		/// @param ratio2 maximum target ratio for partition 0 over partition 1
+		void initial_partition(Hypergraph const& h, std::vector<int>& vPartition, double ratio1, double ratio2) const
+		{
+			start_task_type task;
+			task.pFM = this;
+			task.pGraph = &h;
+			task.ratio1 = ratio1;
+			task.ratio2 = ratio2;
+			task.vPartition.resize(m_num_starts);
+			task.vCutsize.resize(m_num_starts);
+
+			unsigned int numThreads = std::min(limbo::containers::num_threads(), m_num_threads);
+			start_kernel_type kernel = {&task};
+			limbo::containers::parallel_for(0, m_num_starts, 1, numThreads, kernel);
+
+			// balanced partitions first, then smaller cut sizes, then earlier starts
+			unsigned int best = 0;
+			bool bestBalanced = balanced(h, task.vPartition[0], ratio1, ratio2);
+			for (unsigned int s = 1; s < m_num_starts; ++s)
+			{
+				bool b = balanced(h, task.vPartition[s], ratio1, ratio2);
+				if ((b && !bestBalanced) || (b == bestBalanced && task.vCutsize[s] < task.vCutsize[best]))
+				{
+					best = s;
+					bestBalanced = b;
+				}
+			}
+			vPartition.swap(task.vPartition[best]);
+		}
+		/// @brief run a range of starts
+		/// @param task shared task
+		/// @param first first start
+		/// @param last end start
+		void run_starts(start_task_type& task, unsigned int first, unsigned int last) const
+		{
+			refiner_type refiner (0);
+			for (unsigned int s = first; s < last; ++s)
+			{
+				this->grow(*task.pGraph, task.vPartition[s], (task.ratio1+task.ratio2)/2, m_seed+s*7919U+1);
+				task.vCutsize[s] = refiner.refine(*task.pGraph, task.vPartition[s], task.ratio1, task.ratio2);
+			}
+		}
+		/// @brief grow partition 0 by breadth-first search from random nodes until its share of weights is reached
+		/// @param h hypergraph
+		/// @param vPartition partition of each node
+		/// @param ratio target ratio for partition 0 over partition 1
+		/// @param state random state
+		void grow(Hypergraph const& h, std::vector<int>& vPartition, double ratio, unsigned int state) const
+		{
+			unsigned int numNodes = h.num_nodes();
+			node_weight_type totalWeight = 0;
+			for (unsigned int i = 0; i < numNodes; ++i)
+				totalWeight += h.vNodeWeight[i];
+			double target = totalWeight*ratio/(1+ratio);
+
+			vPartition.assign(numNodes, 1);
+			std::vector<char> vVisited (numNodes, false);
+			std::deque<unsigned int> queue;
+			double weight = 0;
+			unsigned int numVisited = 0;
+			while (weight < target && numVisited < numNodes)
+			{
+				if (queue.empty())
+				{
+					unsigned int v = random(state)%numNodes;
+					while (vVisited[v]) v = (v+1)%numNodes;
+					vVisited[v] = true;
+					++numVisited;
+					queue.push_back(v);
+				}
+				unsigned int u = queue.front();
+				queue.pop_front();
+				if (weight+h.vNodeWeight[u]/2.0 > target) continue;
+				vPartition[u] = 0;
+				weight += h.vNodeWeight[u];
+				for (std::size_t e = h.vNodeNetBegin[u]; e < h.vNodeNetBegin[u+1]; ++e)
+				{
+					unsigned int net = h.vNodeNet[e];
+					for (std::size_t j = h.vNetBegin[net]; j < h.vNetBegin[net+1]; ++j)
+						if (!vVisited[h.vPin[j]])
+						{
+							vVisited[h.vPin[j]] = true;
+							++numVisited;
+							queue.push_back(h.vPin[j]);
+						}
+				}
+			}
+		}
+
+		CoarseningType m_coarsening; ///< rule to match nodes in coarsening
+		unsigned int m_coarsest_size; ///< stop coarsening at this number of nodes
+		unsigned int m_max_net_size; ///< nets with more nodes are ignored in matching
+		unsigned int m_num_starts; ///< number of starts of initial partitioning
+		unsigned int m_num_threads; ///< number of threads of initial partitioning
+		unsigned int m_max_stall; ///< number of moves without a better cut size to end a pass of refinement
+		unsigned int m_seed; ///< random seed
+		unsigned int m_num_levels; ///< number of levels in the last run
+
+		boost::unordered_map<node_type*, unsigned int> m_hNode; ///< map from nodes to indices, only used to add nets
+		std::vector<Hypergraph> m_vLevel; ///< levels from the input to the coarsest one
+		std::vector<int> m_vPartition; ///< partition of each node
+};
+
+} // namespace partition
+} // namespace algorithms
+} // namespace limbo
+
+#endif
@@ -0,0 +1,465 @@
+/**
+ * @file   AbacusLegalizer.h
+ * @brief  Row-based legalization by Abacus or Tetris with the callbacks of GreedySearch.
+ *
+ * Cells are taken in the order of their desired positions and appended to segments of rows.
+ * Abacus collapses cells overlapping their left neighbors into clusters placed at the positions
+ * minimizing the squared displacement of their cells, and Tetris places each cell at the nearest free site
+ * right of the cells placed before it.
+ * The cost of trying a cell in a row is the change of the displacement cost of the clusters it merges,
+ * so a trial costs the number of merged clusters.
+ * Cells failing in all their rows are left to @ref limbo::algorithms::placement::GreedySearch.
+ *
+ * See P. Spindler, U. Schlichtmann and F. M. Johannes, "Abacus: fast legalization of standard cell circuits
+ * with minimal movement", ISPD 2008.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_ALGORITHMS_PLACEMENT_ABACUSLEGALIZER_H
+#define _LIMBO_ALGORITHMS_PLACEMENT_ABACUSLEGALIZER_H
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/algorithms/placement/GreedySearch.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Placement
+namespace placement
+{
+
+/// do not delete it
+/// it is an example of callbacks, in addition to the ones of GSCallback used here
+#if 0
+/// sample callback type
+struct AbacusCallback
+{
+	/// required types, the same as GSCallback
+	typedef Component node_type;
+	typedef Segment row_type;
+	typedef int site_coordinate_type;
+	typedef list<node_type*> node_vector_type;
+	typedef list<node_type*> node_fail_vector_type;
+	typedef vector<row_type*> row_vector_type;
+	/// optional, declare that the callbacks below can run concurrently for different rows and nodes
+	typedef boost::true_type thread_safe_type;
+
+	/// required functions of GSCallback
+	/// width of a node is site_xh(pn)-site_xl(pn)
+	site_coordinate_type site_xl(const node_type* pn) const {}
+	site_coordinate_type site_xh(const node_type* pn) const {}
+	pair<size_t, size_t> row_range(const node_type* pn) const {}
+	/// nodes already in rows are obstacles, and legalized nodes are inserted in the order of sites
+	node_vector_type& nodes_in_row(size_t row_idx) const {}
+	bool check_displace(const node_type* pn, site_coordinate_type x, site_coordinate_type y) const {}
+	row_type* row(size_t row_idx) const {}
+	site_coordinate_type site_xl(const row_type* pr) const {}
+	site_coordinate_type site_xh(const row_type* pr) const {}
+
+	/// additional functions
+	/// @return desired first site of a node, e.g., from global placement
+	double desired_x(const node_type* pn) const {}
+	/// @return cost of placing a node in a row besides the squared displacement in sites, e.g., of vertical displacement
+	double row_cost(const node_type* pn, size_t row_idx) const {}
+	/// place a node at a site of a row
+	void place(node_type* pn, size_t row_idx, site_coordinate_type site) const {}
+};
+#endif
+
+/// @brief Row-based legalizer appending cells sorted by desired positions to segments of rows.
+///
+/// Nodes already in rows, e.g., fixed macros or zero width boundaries, split rows into segments.
+/// Each node is tried in the segments of the rows in its row range and kept in the one of the smallest cost,
+/// and its final position must pass check_displace. Nodes failing everywhere are appended to the failed nodes.
+///
+/// Rows can be split into bands of a fixed number of rows, and a node is only tried in the band containing
+/// the middle of its row range. Bands are independent, so they are legalized by threads
+/// if the callback is thread-safe (see @ref limbo::algorithms::placement::gs_thread_safe).
+/// Bands do not depend on the number of threads, so neither do results.
+///
+/// Usage:
+/// ~~~~~~~~~~~~~~~~
+/// AbacusLegalizer<Callback> legalizer (cbk);
+/// legalizer.set_band_rows(16);
+/// legalizer.set_num_threads(8);
+/// legalizer(vNode.begin(), vNode.end(), vFailNode);
+/// GreedySearch<Callback> gs (cbk);
+/// gs(vFailNode, 2);
+/// ~~~~~~~~~~~~~~~~
+/// @tparam CallbackType provides all the information needed
+template <typename CallbackType>
+class AbacusLegalizer
+{
+	public:
+        /// @nowarn
+		typedef CallbackType callback_type;
+		typedef typename callback_type::node_type node_type;
+		typedef typename callback_type::row_type row_type;
+		typedef typename callback_type::site_coordinate_type site_coordinate_type;
+		typedef typename callback_type::node_vector_type node_vector_type;
+		typedef typename callback_type::node_fail_vector_type node_fail_vector_type;
+		typedef typename callback_type::row_vector_type row_vector_type;
+
+		// it can be row_type& or row_type*
+		typedef typename gs_choose_type<typename row_vector_type::value_type>::const_value_type row_const_value_type;
+		// it can be node_type& or node_type*
+		typedef typename gs_choose_type<typename node_vector_type::value_type>::value_type node_value_type;
+        /// @endnowarn
+		/// legalization modes
+		enum mode_type
+		{
+			ABACUS, ///< collapse overlapping cells into clusters at their optimal positions
+			TETRIS ///< place each cell at the nearest free site right of the cells placed before
+		};
+
+        /// constructor
+        /// @param cbk callback object
+		AbacusLegalizer(callback_type cbk = callback_type()) : m_cbk(cbk), m_mode(ABACUS), m_num_threads(1), m_band_rows(0) {}
+
+        /// @param m legalization mode
+		void set_mode(mode_type m) {m_mode = m;}
+        /// @param n number of threads, only used if the callback is thread-safe
+		void set_num_threads(int n) {m_num_threads = std::max(n, 1);}
+        /// @param n number of rows of a band, 0 for all rows in one band
+		void set_band_rows(size_t n) {m_band_rows = n;}
+
+        /// API to run the algorithm
+        /// @tparam Iterator iterator of nodes to legalize, not in rows
+        /// @param first, last range of nodes
+        /// @param vFailNode container to store failed nodes
+        /// @return number of failed nodes
+		template <typename Iterator>
+		std::size_t operator()(Iterator first, Iterator last, node_fail_vector_type& vFailNode) {return this->run(first, last, vFailNode);}
+        /// kernel function to run the algorithm
+        /// @tparam Iterator iterator of nodes to legalize, not in rows
+        /// @param first, last range of nodes
+        /// @param vFailNode container to store failed nodes
+        /// @return number of failed nodes
+		template <typename Iterator>
+		std::size_t run(Iterator first, Iterator last, node_fail_vector_type& vFailNode);
+
+	protected:
+        /// @brief cells collapsed together, covering cells [first, first of the next cluster) of a segment
+		struct cluster_type
+		{
+			std::size_t first; ///< first cell in the segment
+			double e; ///< number of cells
+			double q; ///< sum of desired positions minus offsets in the cluster
+			double r; ///< sum of squares of desired positions minus offsets
+			site_coordinate_type w; ///< total width
+			site_coordinate_type x; ///< first site
+		};
+        /// @brief free sites of a row between obstacles
+		struct segment_type
+		{
+			site_coordinate_type xl; ///< first site
+			site_coordinate_type xh; ///< last site plus one
+			site_coordinate_type used; ///< sites used by cells
+			std::vector<node_value_type> vNode; ///< cells in the order of sites
+			std::vector<site_coordinate_type> vWidth; ///< width of each cell
+			std::vector<cluster_type> vCluster; ///< clusters in the order of sites, one per cell for Tetris
+		};
+        /// @brief a band of rows legalized independently
+		struct band_type
+		{
+			size_t row_first; ///< first row
+			size_t row_last; ///< last row plus one
+			std::vector<std::pair<double, std::size_t> > vOrder; ///< desired positions and indices of nodes of the band
+			std::vector<std::vector<segment_type> > vRowSegment; ///< segments of each row
+			std::vector<std::size_t> vFail; ///< indices of failed nodes
+		};
+        /// @brief compare nodes of a row by first sites only
+		struct less_site_type
+		{
+            /// @return true if \a a starts before \b b
+			bool operator()(std::pair<site_coordinate_type, node_value_type> const& a, std::pair<site_coordinate_type, node_value_type> const& b) const {return a.first < b.first;}
+		};
+        /// @brief shared state of bands legalized by threads
+		struct band_task_type
+		{
+			AbacusLegalizer* pLegalizer; ///< this object
+			std::vector<node_value_type> const* pNode; ///< nodes to legalize
+			std::vector<band_type>* pBand; ///< bands
+            /// @brief legalize a range of bands, run by limbo::containers::parallel_for
+            /// @param b first band
+            /// @param e end band
+			void operator()(std::size_t b, std::size_t e) const {pLegalizer->work(*this, b, e);}
+		};
+
+        /// @return cost of a cluster at site x
+		static double cluster_cost(double e, double q, double r, double x) {return e*x*x-2*x*q+r;}
+        /// @return the site of a cluster of width \a w closest to q/e within a segment
+		static site_coordinate_type cluster_site(double e, double q, site_coordinate_type w, segment_type const& seg)
+		{
+			double x = floor(q/e+0.5);
+			x = std::max(x, (double)seg.xl);
+			x = std::min(x, (double)(seg.xh-w));
+			return (site_coordinate_type)x;
+		}
+        /// @brief try appending a cell to a segment
+        /// @param seg segment
+        /// @param xd desired site of the cell
+        /// @param w width of the cell
+        /// @param site site of the cell as output
+        /// @return change of the displacement cost of the segment, infinity if the cell does not fit
+		double trial(segment_type const& seg, double xd, site_coordinate_type w, site_coordinate_type& site) const;
+        /// @brief append a cell to a segment
+        /// @param seg segment
+        /// @param n cell
+        /// @param xd desired site of the cell
+        /// @param w width of the cell
+		void commit(segment_type& seg, node_value_type n, double xd, site_coordinate_type w) const;
+        /// @brief legalize nodes of a band
+        /// @param vNode nodes to legalize
+        /// @param band band
+		void legalize_band(std::vector<node_value_type> const& vNode, band_type& band);
+        /// @brief legalize bands in [first, last)
+        /// @param task shared state
+        /// @param first first band
+        /// @param last end band
+		void work(band_task_type const& task, std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+				this->legalize_band(*task.pNode, (*task.pBand)[i]);
+		}
+        /// @param n node
+        /// @return width of node
+		site_coordinate_type node_site_size_x(node_value_type n) const
+		{
+			return m_cbk.site_xh(n)-m_cbk.site_xl(n);
+		}
+
+		callback_type m_cbk; ///< a copiable callback_type is required
+		mode_type m_mode; ///< legalization mode
+		int m_num_threads; ///< number of threads
+		size_t m_band_rows; ///< number of rows of a band, 0 for one band
+};
+
+template <typename CallbackType>
+template <typename Iterator>
+std::size_t AbacusLegalizer<CallbackType>::run(Iterator first, Iterator last, node_fail_vector_type& vFailNode)
+{
+	std::vector<node_value_type> vNode (first, last);
+	size_t num_rows = 0;
+	for (std::size_t i = 0; i < vNode.size(); ++i)
+		num_rows = std::max(num_rows, m_cbk.row_range(vNode[i]).second);
+	size_t band_rows = (m_band_rows == 0)? std::max(num_rows, (size_t)1) : m_band_rows;
+	std::vector<band_type> vBand ((num_rows+band_rows-1)/band_rows);
+	for (std::size_t b = 0; b < vBand.size(); ++b)
+	{
+		vBand[b].row_first = b*band_rows;
+		vBand[b].row_last = std::min((b+1)*band_rows, num_rows);
+	}
+	// Tetris-style order by desired positions, ties by the order of input
+	for (std::size_t i = 0; i < vNode.size(); ++i)
+	{
+		pair<size_t, size_t> row_range = m_cbk.row_range(vNode[i]);
+		assert(row_range.first < row_range.second);
+		size_t b = (row_range.first+row_range.second-1)/2/band_rows;
+		vBand[b].vOrder.push_back(std::make_pair(m_cbk.desired_x(vNode[i]), i));
+	}
+
+	band_task_type task;
+	task.pLegalizer = this;
+	task.pNode = &vNode;
+	task.pBand = &vBand;
+	int numThreads = 1;
+	if (gs_thread_safe<callback_type>::value)
+		numThreads = std::min((int)limbo::containers::num_threads(), m_num_threads);
+	limbo::containers::parallel_for(0, vBand.size(), 1, numThreads, task);
+
+	std::size_t num_fails = 0;
+	for (std::size_t b = 0; b < vBand.size(); ++b)
+	{
+		for (std::size_t i = 0; i < vBand[b].vFail.size(); ++i)
+			vFailNode.push_back(vNode[vBand[b].vFail[i]]);
+		num_fails += vBand[b].vFail.size();
+	}
+	return num_fails;
+}
+
+template <typename CallbackType>
+double AbacusLegalizer<CallbackType>::trial(segment_type const& seg, double xd, site_coordinate_type w, site_coordinate_type& site) const
+{
+	if (seg.used+w > seg.xh-seg.xl)
+		return std::numeric_limits<double>::max();
+	if (m_mode == TETRIS)
+	{
+		site_coordinate_type frontier = (seg.vCluster.empty())? seg.xl : seg.vCluster.back().x+seg.vCluster.back().w;
+		site = std::max(frontier, std::min((site_coordinate_type)floor(xd+0.5), (site_coordinate_type)(seg.xh-w)));
+		if (site+w > seg.xh)
+			return std::numeric_limits<double>::max();
+		return (site-xd)*(site-xd);
+	}
+	// merge the cell with clusters it overlaps from the right end, without changing the segment
+	double e = 1;
+	double q = xd;
+	double r = xd*xd;
+	site_coordinate_type cw = w;
+	site_coordinate_type x = cluster_site(e, q, cw, seg);
+	double old_cost = 0;
+	for (std::size_t k = seg.vCluster.size(); k > 0; --k)
+	{
+		cluster_type const& c = seg.vCluster[k-1];
+		if (c.x+c.w <= x)
+			break;
+		old_cost += cluster_cost(c.e, c.q, c.r, c.x);
+		// cells of the merged cluster are shifted right by the width of c
+		r = c.r+r-2*c.w*q+e*c.w*c.w;
+		q = c.q+q-e*c.w;
+		e += c.e;
+		cw += c.w;
+		x = cluster_site(e, q, cw, seg);
+	}
+	site = x+cw-w;
+	return cluster_cost(e, q, r, x)-old_cost;
+}
+
+template <typename CallbackType>
+void AbacusLegalizer<CallbackType>::commit(segment_type& seg, node_value_type n, double xd, site_coordinate_type w) const
+{
+	cluster_type c;
+	c.first = seg.vNode.size();
+	c.e = 1;
+	c.q = xd;
+	c.r = xd*xd;
+	c.w = w;
+	seg.vNode.push_back(n);
+	seg.vWidth.push_back(w);
+	seg.used += w;
+	if (m_mode == TETRIS)
+	{
+		site_coordinate_type frontier = (seg.vCluster.empty())? seg.xl : seg.vCluster.back().x+seg.vCluster.back().w;
+		c.x = std::max(frontier, std::min((site_coordinate_type)floor(xd+0.5), (site_coordinate_type)(seg.xh-w)));
+		seg.vCluster.push_back(c);
+		return;
+	}
+	c.x = cluster_site(c.e, c.q, c.w, seg);
+	// collapse with the previous clusters as long as they overlap
+	while (!seg.vCluster.empty() && seg.vCluster.back().x+seg.vCluster.back().w > c.x)
+	{
+		cluster_type const& p = seg.vCluster.back();
+		c.r = p.r+c.r-2*p.w*c.q+c.e*p.w*p.w;
+		c.q = p.q+c.q-c.e*p.w;
+		c.e += p.e;
+		c.w += p.w;
+		c.first = p.first;
+		c.x = cluster_site(c.e, c.q, c.w, seg);
+		seg.vCluster.pop_back();
+	}
+	seg.vCluster.push_back(c);
+}
+
+template <typename CallbackType>
+void AbacusLegalizer<CallbackType>::legalize_band(std::vector<node_value_type> const& vNode, band_type& band)
+{
+	// segments between nodes already in rows
+	band.vRowSegment.resize(band.row_last-band.row_first);
+	for (size_t row_idx = band.row_first; row_idx < band.row_last; ++row_idx)
+	{
+		std::vector<segment_type>& vSegment = band.vRowSegment[row_idx-band.row_first];
+		row_const_value_type row = m_cbk.row(row_idx);
+		node_vector_type const& vRowNode = m_cbk.nodes_in_row(row_idx);
+		site_coordinate_type xl = m_cbk.site_xl(row);
+		for (typename node_vector_type::const_iterator it = vRowNode.begin(); ; ++it)
+		{
+			site_coordinate_type xh = (it == vRowNode.end())? m_cbk.site_xh(row) : std::min(m_cbk.site_xl(*it), m_cbk.site_xh(row));
+			if (xl < xh)
+			{
+				vSegment.push_back(segment_type());
+				vSegment.back().xl = xl;
+				vSegment.back().xh = xh;
+				vSegment.back().used = 0;
+			}
+			if (it == vRowNode.end())
+				break;
+			xl = std::max(xl, m_cbk.site_xh(*it));
+		}
+	}
+
+	std::stable_sort(band.vOrder.begin(), band.vOrder.end());
+	for (std::size_t i = 0; i < band.vOrder.size(); ++i)
+	{
+		node_value_type n = vNode[band.vOrder[i].second];
+		double xd = band.vOrder[i].first;
+		site_coordinate_type w = node_site_size_x(n);
+		pair<size_t, size_t> row_range = m_cbk.row_range(n);
+		double best_cost = std::numeric_limits<double>::max();
+		segment_type* best_seg = NULL;
+		for (size_t row_idx = std::max(row_range.first, band.row_first); row_idx < std::min(row_range.second, band.row_last); ++row_idx)
+		{
+			double row_cost = m_cbk.row_cost(n, row_idx);
+			if (row_cost >= best_cost)
+				continue;
+			std::vector<segment_type>& vSegment = band.vRowSegment[row_idx-band.row_first];
+			for (std::size_t s = 0; s < vSegment.size(); ++s)
+			{
+				segment_type& seg = vSegment[s];
+				// the squared distance to the segment bounds the cost from below
+				double gap = std::max(std::max((double)seg.xl-xd, xd+w-(double)seg.xh), 0.0);
+				if (row_cost+gap*gap >= best_cost)
+					continue;
+				site_coordinate_type site;
+				double cost = this->trial(seg, xd, w, site);
+				if (cost == std::numeric_limits<double>::max() || row_cost+cost >= best_cost || !m_cbk.check_displace(n, site, row_idx))
+					continue;
+				best_cost = row_cost+cost;
+				best_seg = &seg;
+			}
+		}
+		if (best_seg)
+			this->commit(*best_seg, n, xd, w);
+		else
+			band.vFail.push_back(band.vOrder[i].second);
+	}
+
+	// place cells of clusters from left to right and insert them among the nodes of rows
+	std::vector<std::pair<site_coordinate_type, node_value_type> > vRowNode;
+	for (size_t row_idx = band.row_first; row_idx < band.row_last; ++row_idx)
+	{
+		std::vector<segment_type>& vSegment = band.vRowSegment[row_idx-band.row_first];
+		node_vector_type& vNodeInRow = m_cbk.nodes_in_row(row_idx);
+		vRowNode.clear();
+		for (typename node_vector_type::iterator it = vNodeInRow.begin(); it != vNodeInRow.end(); ++it)
+			vRowNode.push_back(std::make_pair(m_cbk.site_xl(*it), *it));
+		std::size_t num_existing = vRowNode.size();
+		for (std::size_t s = 0; s < vSegment.size(); ++s)
+		{
+			segment_type const& seg = vSegment[s];
+			for (std::size_t k = 0; k < seg.vCluster.size(); ++k)
+			{
+				site_coordinate_type x = seg.vCluster[k].x;
+				std::size_t last = (k+1 < seg.vCluster.size())? seg.vCluster[k+1].first : seg.vNode.size();
+				for (std::size_t j = seg.vCluster[k].first; j < last; ++j)
+				{
+					m_cbk.place(seg.vNode[j], row_idx, x);
+					vRowNode.push_back(std::make_pair(x, seg.vNode[j]));
+					x += seg.vWidth[j];
+				}
+			}
+		}
+		if (vRowNode.size() == num_existing)
+			continue;
+		// existing nodes and cells of segments are both sorted, and a segment lies between two existing nodes
+		std::inplace_merge(vRowNode.begin(), vRowNode.begin()+num_existing, vRowNode.end(), less_site_type());
+		vNodeInRow.clear();
+		for (std::size_t j = 0; j < vRowNode.size(); ++j)
+			vNodeInRow.insert(vNodeInRow.end(), vRowNode[j].second);
+	}
+	band.vRowSegment.clear();
+}
+
+} // namespace placement
+} // namespace algorithms
+} // namespace limbo
+
+#endif
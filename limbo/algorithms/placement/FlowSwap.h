@@ -0,0 +1,418 @@
+/**
+ * @file   FlowSwap.h
+ * @brief  Detailed placement reassigning cells of the same footprint among their sites by min-cost flow in windows.
+ *
+ * A window holds cells of the same footprint close to each other without common nets,
+ * so the HPWL of moving a cell of the window to the site of another one does not depend on the other moves,
+ * and the best reassignment of the window is a transportation problem from cells to sites.
+ * Windows are solved as min-cost flows by threads and applied with @ref limbo::algorithms::placement::Wirelength.
+ *
+ * See M. Pan, N. Viswanathan and C. Chu, "An efficient and effective detailed placement algorithm", ICCAD 2005,
+ * for independent set matching.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_ALGORITHMS_PLACEMENT_FLOWSWAP_H
+#define _LIMBO_ALGORITHMS_PLACEMENT_FLOWSWAP_H
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <lemon/smart_graph.h>
+#include <lemon/cost_scaling.h>
+#include <limbo/solvers/WarmStartNetworkSimplex.h>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/algorithms/placement/Wirelength.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Placement
+namespace placement
+{
+
+/// @brief Reassign cells of the same footprint among their sites in windows to reduce HPWL.
+///
+/// Cells are sorted by footprint, tile of the region and position, and each cell joins the first window of its footprint and tile
+/// that has room and no net in common with it.
+/// Costs of a window are the HPWL changes of moving each cell to each site of the window in the placement kept by the
+/// @ref limbo::algorithms::placement::Wirelength object, scaled to integers,
+/// and the window is solved as a min-cost flow on a complete bipartite graph.
+/// Each thread keeps one graph and solver for each window size, so the network simplex restarts from the spanning tree
+/// of the previous window of the same size. Windows are taken by threads in fixed blocks and solvers restart cold at each block,
+/// so results do not depend on the number of threads.
+///
+/// Solutions are applied in the order of windows.
+/// Windows may share nets with windows applied before them, so the HPWL change of a solution is evaluated again
+/// and the solution is skipped unless it reduces HPWL.
+///
+/// Usage:
+/// ~~~~~~~~~~~~~~~~
+/// wl.init(vX, vY);
+/// FlowSwap<double> fs (wl);
+/// fs.set_region(8*row_height, 8*row_height);
+/// fs.set_num_threads(8);
+/// double delta = fs(vFootprint); // cells of negative footprints are fixed
+/// // new positions are wl.x(c), wl.y(c)
+/// ~~~~~~~~~~~~~~~~
+/// @tparam CoordinateType type of coordinates
+template <typename CoordinateType = double>
+class FlowSwap
+{
+	public:
+        /// @nowarn
+		typedef CoordinateType coordinate_type;
+		typedef Wirelength<coordinate_type> wirelength_type;
+		typedef long long cost_type;
+        /// @endnowarn
+		/// min-cost flow algorithms
+		enum solver_type
+		{
+			NETWORK_SIMPLEX, ///< @ref limbo::solvers::WarmStartNetworkSimplex, restarting from the previous window of the same size
+			COST_SCALING ///< lemon::CostScaling
+		};
+
+		/// constructor
+		/// @param wl wirelength engine with a kept placement, see @ref limbo::algorithms::placement::Wirelength::init
+		explicit FlowSwap(wirelength_type& wl)
+			: m_wl(wl)
+			, m_solver(NETWORK_SIMPLEX)
+			, m_window_size(16)
+			, m_region_w(0)
+			, m_region_h(0)
+			, m_num_threads(1)
+			, m_num_windows(0)
+			, m_num_moved(0)
+		{
+		}
+
+		/// @param s min-cost flow algorithm
+		void set_solver(solver_type s) {m_solver = s;}
+		/// @param n maximum number of cells in a window, at least 2
+		void set_window_size(uint32_t n) {m_window_size = std::max(n, (uint32_t)2);}
+		/// @brief set the size of tiles that windows are built in, 0 for no tiles
+		/// @param w, h width and height of a tile
+		void set_region(coordinate_type w, coordinate_type h)
+		{
+			m_region_w = w;
+			m_region_h = h;
+		}
+		/// @param n number of threads
+		void set_num_threads(int n) {m_num_threads = std::max(n, 1);}
+		/// @return number of windows of the last run
+		uint32_t num_windows() const {return m_num_windows;}
+		/// @return number of cells moved in the last run
+		uint32_t num_moved() const {return m_num_moved;}
+
+		/// @brief API to run one pass over all cells
+		/// @param vFootprint footprint of each cell, cells of the same footprint can exchange sites, negative for fixed cells
+		/// @return change of HPWL
+		double operator()(std::vector<int> const& vFootprint) {return this->run(vFootprint);}
+		/// @brief kernel function to run one pass over all cells
+		/// @param vFootprint footprint of each cell, cells of the same footprint can exchange sites, negative for fixed cells
+		/// @return change of HPWL
+		double run(std::vector<int> const& vFootprint);
+
+	protected:
+		/// windows solved by a thread before its solvers restart cold
+		static const uint32_t block_size = 64;
+
+		/// @nowarn
+		typedef lemon::SmartDigraph graph_type;
+		typedef limbo::solvers::WarmStartNetworkSimplex<graph_type, cost_type> network_simplex_type;
+		typedef lemon::CostScaling<graph_type, cost_type, cost_type> cost_scaling_type;
+		/// @endnowarn
+
+		/// @brief a complete bipartite graph from cells to sites with its solver, arc i*k+j from cell i to site j
+		struct problem_type
+		{
+			graph_type graph; ///< graph
+			graph_type::ArcMap<cost_type> cost; ///< cost of each arc
+			graph_type::ArcMap<cost_type> upper; ///< capacity 1 of each arc, as costs can be negative
+			graph_type::NodeMap<cost_type> supply; ///< 1 for cells and -1 for sites
+			std::vector<graph_type::Arc> vArc; ///< arcs by index
+			network_simplex_type* ns; ///< network simplex, or NULL
+			cost_scaling_type* cs; ///< cost scaling, or NULL
+
+			/// constructor
+			/// @param k number of cells
+			/// @param s min-cost flow algorithm
+			problem_type(uint32_t k, solver_type s) : cost(graph), upper(graph), supply(graph), ns(NULL), cs(NULL)
+			{
+				graph.reserveNode(2*k);
+				graph.reserveArc(k*k);
+				for (uint32_t i = 0; i < 2*k; ++i)
+					supply[graph.addNode()] = (i < k)? 1 : -1;
+				for (uint32_t i = 0; i < k; ++i)
+					for (uint32_t j = 0; j < k; ++j)
+					{
+						vArc.push_back(graph.addArc(graph.nodeFromId(i), graph.nodeFromId(k+j)));
+						upper[vArc.back()] = 1;
+					}
+				if (s == NETWORK_SIMPLEX)
+					ns = new network_simplex_type(graph);
+				else
+					cs = new cost_scaling_type(graph);
+			}
+			/// destructor
+			~problem_type()
+			{
+				delete ns;
+				delete cs;
+			}
+		};
+		/// @brief solvers of a thread by window size
+		struct worker_type
+		{
+			std::vector<problem_type*> vProblem; ///< problem of each size, or NULL
+			std::vector<double> vCost; ///< HPWL changes of a window
+
+			/// destructor
+			~worker_type()
+			{
+				for (uint32_t i = 0; i < vProblem.size(); ++i)
+					delete vProblem[i];
+			}
+		};
+		/// @brief shared state of windows solved by threads
+		struct task_type
+		{
+			FlowSwap* pSwap; ///< this object
+			std::vector<worker_type> vWorker; ///< solvers, one for each thread
+			std::vector<unsigned int> vBusy; ///< whether a worker is taken by a block, set atomically
+		};
+		/// @brief block of windows run by limbo::containers::parallel_for
+		struct block_kernel_type
+		{
+			task_type* task; ///< shared state
+			/// @param b first window
+			/// @param e end window
+			void operator()(std::size_t b, std::size_t e) const {task->pSwap->work(*task, b, e);}
+		};
+
+		/// @brief solve windows of a block with a free worker
+		/// @param task shared state
+		/// @param first first window
+		/// @param last end window
+		void work(task_type& task, uint32_t first, uint32_t last);
+		/// @brief find the best assignment of a window
+		/// @param w window
+		/// @param worker solvers of the thread
+		void solve(uint32_t w, worker_type& worker);
+		/// @brief build windows from movable cells
+		/// @param vFootprint footprint of each cell
+		void build_windows(std::vector<int> const& vFootprint);
+		/// @return true if cell \a c has no net in the sorted nets \a vNet
+		bool independent(uint32_t c, std::vector<uint32_t> const& vNet) const
+		{
+			for (uint32_t i = m_wl.cell_pin_begin(c); i < m_wl.cell_pin_end(c); ++i)
+				if (std::binary_search(vNet.begin(), vNet.end(), m_wl.pin_net(m_wl.cell_pin(i))))
+					return false;
+			return true;
+		}
+
+		wirelength_type& m_wl; ///< wirelength engine
+		solver_type m_solver; ///< min-cost flow algorithm
+		uint32_t m_window_size; ///< maximum number of cells in a window
+		coordinate_type m_region_w; ///< width of a tile, 0 for no tiles
+		coordinate_type m_region_h; ///< height of a tile, 0 for no tiles
+		int m_num_threads; ///< number of threads
+		uint32_t m_num_windows; ///< number of windows of the last run
+		uint32_t m_num_moved; ///< number of cells moved in the last run
+
+		std::vector<uint32_t> m_vWindowBegin; ///< first cell of each window in @ref m_vWindowCell, with the number of cells at the end
+		std::vector<uint32_t> m_vWindowCell; ///< cells of windows
+		std::vector<uint32_t> m_vAssign; ///< index in the window of the site assigned to each cell of windows
+};
+
+template <typename CoordinateType>
+const uint32_t FlowSwap<CoordinateType>::block_size;
+
+template <typename CoordinateType>
+double FlowSwap<CoordinateType>::run(std::vector<int> const& vFootprint)
+{
+	limboAssertMsg(vFootprint.size() == m_wl.num_cells(), "%u footprints for %u cells", (uint32_t)vFootprint.size(), m_wl.num_cells());
+	this->build_windows(vFootprint);
+	m_vAssign.resize(m_vWindowCell.size());
+
+	task_type task;
+	task.pSwap = this;
+	uint32_t num_blocks = (m_num_windows+block_size-1)/block_size;
+	int numThreads = std::min((int)limbo::containers::num_threads(), m_num_threads);
+	numThreads = std::max(std::min(numThreads, (int)num_blocks), 1);
+	task.vWorker.resize(numThreads);
+	task.vBusy.assign(numThreads, 0);
+	block_kernel_type kernel = {&task};
+	limbo::containers::parallel_for(0, m_num_windows, block_size, numThreads, kernel);
+
+	// apply solutions in order, cells of a window do not share nets so their changes add up
+	double total = 0;
+	m_num_moved = 0;
+	std::vector<std::pair<coordinate_type, coordinate_type> > vPos;
+	for (uint32_t w = 0; w < m_num_windows; ++w)
+	{
+		uint32_t first = m_vWindowBegin[w];
+		uint32_t k = m_vWindowBegin[w+1]-first;
+		double delta = 0;
+		uint32_t num_moved = 0;
+		for (uint32_t i = 0; i < k; ++i)
+		{
+			uint32_t j = m_vAssign[first+i];
+			if (j != i)
+			{
+				delta += m_wl.delta_move(m_vWindowCell[first+i], m_wl.x(m_vWindowCell[first+j]), m_wl.y(m_vWindowCell[first+j]));
+				++num_moved;
+			}
+		}
+		if (num_moved == 0 || delta >= 0)
+			continue;
+		vPos.clear();
+		for (uint32_t i = 0; i < k; ++i)
+			vPos.push_back(std::make_pair(m_wl.x(m_vWindowCell[first+i]), m_wl.y(m_vWindowCell[first+i])));
+		for (uint32_t i = 0; i < k; ++i)
+		{
+			uint32_t j = m_vAssign[first+i];
+			if (j != i)
+				total += m_wl.move(m_vWindowCell[first+i], vPos[j].first, vPos[j].second);
+		}
+		m_num_moved += num_moved;
+	}
+	return total;
+}
+
+template <typename CoordinateType>
+void FlowSwap<CoordinateType>::work(task_type& task, uint32_t first, uint32_t last)
+{
+	// no more blocks run at a time than workers, so a free worker is always found
+	uint32_t i = 0;
+	while (!__sync_bool_compare_and_swap(&task.vBusy[i], 0, 1))
+		i = (i+1)%task.vBusy.size();
+	worker_type& worker = task.vWorker[i];
+	// solvers restart cold at each block, whichever windows the worker solved before
+	for (uint32_t k = 0; k < worker.vProblem.size(); ++k)
+		if (worker.vProblem[k] && worker.vProblem[k]->ns)
+			worker.vProblem[k]->ns->reset();
+	for (uint32_t w = first; w < last; ++w)
+		this->solve(w, worker);
+	__sync_lock_release(&task.vBusy[i]);
+}
+
+template <typename CoordinateType>
+void FlowSwap<CoordinateType>::solve(uint32_t w, worker_type& worker)
+{
+	uint32_t first = m_vWindowBegin[w];
+	uint32_t k = m_vWindowBegin[w+1]-first;
+	for (uint32_t i = 0; i < k; ++i)
+		m_vAssign[first+i] = i;
+	// HPWL changes of moving each cell to each site
+	worker.vCost.resize(k*k);
+	double max_cost = 0;
+	for (uint32_t i = 0; i < k; ++i)
+		for (uint32_t j = 0; j < k; ++j)
+		{
+			double c = (i == j)? 0 : m_wl.delta_move(m_vWindowCell[first+i], m_wl.x(m_vWindowCell[first+j]), m_wl.y(m_vWindowCell[first+j]));
+			worker.vCost[i*k+j] = c;
+			max_cost = std::max(max_cost, std::abs(c));
+		}
+	if (max_cost == 0)
+		return;
+
+	if (worker.vProblem.size() <= k)
+		worker.vProblem.resize(k+1, NULL);
+	if (worker.vProblem[k] == NULL)
+		worker.vProblem[k] = new problem_type(k, m_solver);
+	problem_type& prob = *worker.vProblem[k];
+	// integer costs within 2^24, so cost scaling does not overflow
+	double scale = (1<<24)/max_cost;
+	for (uint32_t a = 0; a < k*k; ++a)
+		prob.cost[prob.vArc[a]] = (cost_type)floor(worker.vCost[a]*scale+0.5);
+	if (prob.ns)
+	{
+		if (prob.ns->upperMap(prob.upper).costMap(prob.cost).supplyMap(prob.supply).run() != network_simplex_type::OPTIMAL)
+			return;
+		for (uint32_t a = 0; a < k*k; ++a)
+			if (prob.ns->flow(prob.vArc[a]) > 0)
+				m_vAssign[first+a/k] = a%k;
+	}
+	else
+	{
+		if (prob.cs->upperMap(prob.upper).costMap(prob.cost).supplyMap(prob.supply).run() != cost_scaling_type::OPTIMAL)
+			return;
+		for (uint32_t a = 0; a < k*k; ++a)
+			if (prob.cs->flow(prob.vArc[a]) > 0)
+				m_vAssign[first+a/k] = a%k;
+	}
+}
+
+template <typename CoordinateType>
+void FlowSwap<CoordinateType>::build_windows(std::vector<int> const& vFootprint)
+{
+	// sort movable cells by footprint, tile, row and position
+	coordinate_type xl = std::numeric_limits<coordinate_type>::max();
+	coordinate_type yl = std::numeric_limits<coordinate_type>::max();
+	for (uint32_t c = 0; c < m_wl.num_cells(); ++c)
+		if (vFootprint[c] >= 0)
+		{
+			xl = std::min(xl, m_wl.x(c));
+			yl = std::min(yl, m_wl.y(c));
+		}
+	std::vector<std::pair<std::pair<int, std::pair<long, long> >, std::pair<std::pair<coordinate_type, coordinate_type>, uint32_t> > > vKey;
+	for (uint32_t c = 0; c < m_wl.num_cells(); ++c)
+		if (vFootprint[c] >= 0)
+		{
+			long tx = (m_region_w > 0)? (long)floor((m_wl.x(c)-xl)/(double)m_region_w) : 0;
+			long ty = (m_region_h > 0)? (long)floor((m_wl.y(c)-yl)/(double)m_region_h) : 0;
+			vKey.push_back(std::make_pair(std::make_pair(vFootprint[c], std::make_pair(ty, tx)),
+						std::make_pair(std::make_pair(m_wl.y(c), m_wl.x(c)), c)));
+		}
+	std::sort(vKey.begin(), vKey.end());
+
+	// first fit of cells into windows of their groups without common nets
+	std::vector<std::vector<uint32_t> > vWindow;
+	std::vector<std::vector<uint32_t> > vWindowNet;
+	m_vWindowBegin.assign(1, 0);
+	m_vWindowCell.clear();
+	for (uint32_t g = 0; g < vKey.size(); )
+	{
+		uint32_t ge = g;
+		while (ge < vKey.size() && vKey[ge].first == vKey[g].first)
+			++ge;
+		vWindow.clear();
+		vWindowNet.clear();
+		for (uint32_t i = g; i < ge; ++i)
+		{
+			uint32_t c = vKey[i].second.second;
+			uint32_t w = 0;
+			while (w < vWindow.size() && (vWindow[w].size() >= m_window_size || !independent(c, vWindowNet[w])))
+				++w;
+			if (w == vWindow.size())
+			{
+				vWindow.push_back(std::vector<uint32_t>());
+				vWindowNet.push_back(std::vector<uint32_t>());
+			}
+			vWindow[w].push_back(c);
+			for (uint32_t p = m_wl.cell_pin_begin(c); p < m_wl.cell_pin_end(c); ++p)
+				vWindowNet[w].push_back(m_wl.pin_net(m_wl.cell_pin(p)));
+			std::sort(vWindowNet[w].begin(), vWindowNet[w].end());
+		}
+		for (uint32_t w = 0; w < vWindow.size(); ++w)
+			if (vWindow[w].size() > 1)
+			{
+				m_vWindowCell.insert(m_vWindowCell.end(), vWindow[w].begin(), vWindow[w].end());
+				m_vWindowBegin.push_back(m_vWindowCell.size());
+			}
+		g = ge;
+	}
+	m_num_windows = m_vWindowBegin.size()-1;
+}
+
+} // namespace placement
+} // namespace algorithms
+} // namespace limbo
+
+#endif
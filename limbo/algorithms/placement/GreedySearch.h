@@ -9,6 +9,9 @@
  * This approach is very powerful to legalize a placement or 
  * find positions without stitch or conflict in DFM aware placement. 
  *
+ * If the callback declares itself thread-safe, candidates are evaluated by threads, 
+ * see @ref limbo::algorithms::placement::GreedySearch::set_num_threads. 
+ *
  * @author Yibo Lin
  * @date   May 2015
  */
@@ -18,6 +21,10 @@
 
 #include <iostream>
 #include <iterator>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <limbo/containers/TaskPool.h>
 
 /// namespace for Limbo 
 namespace limbo 
@@ -32,6 +39,7 @@ namespace placement
 using std::cout;
 using std::endl;
 using std::pair;
+using std::vector;
 
 /// do not delete it 
 /// it is an example of callbacks 
@@ -46,6 +54,8 @@ struct GSCallback
 	typedef list<node_type*> node_vector_type;
 	typedef list<node_type*> node_fail_vector_type;
 	typedef vector<row_type*> row_vector_type;
+	/// optional, declare that the const callbacks below except apply() can run concurrently 
+	typedef boost::true_type thread_safe_type;
 	struct cost_type
 	{
 		long cost;
@@ -133,7 +143,34 @@ struct gs_choose_type<T*>
 	typedef const T* const_value_type; ///< constant value type 
 };
 
+/// @brief thread-safety trait of callbacks 
+/// 
+/// A callback is thread-safe if it declares typedef boost::true_type thread_safe_type, 
+/// which means its const functions, except apply(), can be called concurrently 
+/// while no node is applied. 
+/// @tparam CallbackType callback type 
+template <typename CallbackType>
+struct gs_thread_safe
+{
+    /// @nowarn
+	typedef char yes_type;
+	typedef char (&no_type)[2];
+	template <typename U> static yes_type test(typename U::thread_safe_type*);
+	template <typename U> static no_type test(...);
+	template <typename U, bool Declared> struct declared_value {static const bool value = false;};
+	template <typename U> struct declared_value<U, true> {static const bool value = U::thread_safe_type::value;};
+    /// @endnowarn
+	static const bool value = declared_value<CallbackType, sizeof(test<CallbackType>(0)) == sizeof(yes_type)>::value; ///< true if thread-safe 
+};
+
 /// core class to perform greedy search functions
+/// 
+/// With more than one thread and a thread-safe callback (see @ref limbo::algorithms::placement::gs_thread_safe), 
+/// consecutive failed nodes whose row ranges are separated by a gap of rows form a batch. 
+/// Nodes of a batch are searched concurrently against the same placement and applied in the order of the list, 
+/// and a batch of a single node evaluates its candidates concurrently. 
+/// Batches do not depend on the number of threads, so neither do results. 
+/// A single node batch gives the same result as the serial search. 
 /// @tparam CallbackType provides all the information needed 
 template <typename CallbackType>
 class GreedySearch
@@ -159,7 +196,14 @@ class GreedySearch
 
         /// constructor 
         /// @param cbk callback object 
-		GreedySearch(callback_type cbk = callback_type()) : m_cbk(cbk) {}
+		GreedySearch(callback_type cbk = callback_type()) : m_cbk(cbk), m_num_threads(1), m_batch_size(64), m_batch_row_gap(1) {}
+
+        /// @param n number of threads, only used if the callback is thread-safe 
+		void set_num_threads(int n) {m_num_threads = std::max(n, 1);}
+        /// @param n maximum number of nodes in a batch, 1 to only evaluate candidates concurrently 
+		void set_batch_size(int n) {m_batch_size = std::max(n, 1);}
+        /// @param n minimum number of rows between row ranges of nodes in a batch 
+		void set_batch_row_gap(size_t n) {m_batch_row_gap = n;}
 
         /// API to run the algorithm 
         /// @param vFailNode container to store failed nodes 
@@ -170,6 +214,11 @@ class GreedySearch
         /// @param max_swap_cnt one cell can swap with how many other cells 
 		void run(node_fail_vector_type& vFailNode, int max_swap_cnt)
 		{
+			if (m_num_threads > 1 && gs_thread_safe<callback_type>::value)
+			{
+				this->run_parallel(vFailNode, max_swap_cnt);
+				return;
+			}
 			for (typename node_fail_vector_type::iterator it = vFailNode.begin();
 					it != vFailNode.end(); )
 			{
@@ -199,16 +248,108 @@ class GreedySearch
         /// @param swap_cnt number of swaps occurs 
 		bool search_swap(node_value_type n, node_fail_vector_type& vFailNode, int swap_cnt) 
 		{
-			typedef typename node_vector_type::iterator node_iterator_type;
+			// it should be initialized to invalid 
+			cost_type best_cost;
+			assert(!m_cbk.check_valid(best_cost));
+			evaluate_visitor_type vis (m_cbk, best_cost);
+			this->enumerate(n, swap_cnt, vis);
+			if (m_cbk.check_valid(best_cost))
+			{
+				// I assume apply() will remove replaced nodes and insert current node 
+				m_cbk.apply(n, best_cost, vFailNode, swap_cnt);
+				return true;
+			}
+			return false;
+		}
+	protected:
+        /// @nowarn
+		typedef typename node_vector_type::iterator node_iterator_type;
+        /// @endnowarn
+        /// @brief a candidate position, whose swap_cnt+1 iterators of nodes to swap and the position for insertion 
+		/// are stored in a flat array shared by all candidates 
+		struct candidate_type
+		{
+			size_t row_idx; ///< row 
+			site_coordinate_type site; ///< target site 
+		};
+        /// @brief keep the first candidate of the smallest cost 
+		struct evaluate_visitor_type
+		{
+			callback_type const& cbk; ///< callback 
+			cost_type& best_cost; ///< best cost 
+            /// constructor 
+            /// @param c callback 
+            /// @param b best cost 
+			evaluate_visitor_type(callback_type const& c, cost_type& b) : cbk(c), best_cost(b) {}
+            /// @brief evaluate a candidate 
+            /// @param n node 
+            /// @param row_idx row 
+            /// @param tgt_site target site 
+            /// @param vIt2 nodes to swap and the position for insertion 
+            /// @param swap_cnt number of swaps 
+			void operator()(node_const_value_type n, size_t row_idx, site_coordinate_type tgt_site, vector<node_iterator_type> const& vIt2, int swap_cnt)
+			{
+				cost_type cur_cost = cbk.calc_cost(n, row_idx, tgt_site, vIt2, swap_cnt);
+				if (!cbk.check_valid(best_cost) || cur_cost < best_cost)
+					best_cost = cur_cost;
+			}
+		};
+        /// @brief collect candidates for concurrent evaluation 
+		struct collect_visitor_type
+		{
+			vector<candidate_type>& vCandidate; ///< candidates 
+			vector<node_iterator_type>& vIt2Pool; ///< iterators of all candidates 
+            /// constructor 
+            /// @param v candidates 
+            /// @param vIt iterators of all candidates 
+			collect_visitor_type(vector<candidate_type>& v, vector<node_iterator_type>& vIt) : vCandidate(v), vIt2Pool(vIt) {}
+            /// @brief collect a candidate 
+			void operator()(node_const_value_type, size_t row_idx, site_coordinate_type tgt_site, vector<node_iterator_type> const& vIt2, int)
+			{
+				vCandidate.push_back(candidate_type());
+				vCandidate.back().row_idx = row_idx;
+				vCandidate.back().site = tgt_site;
+				vIt2Pool.insert(vIt2Pool.end(), vIt2.begin(), vIt2.end());
+			}
+		};
+        /// @brief shared state of concurrent searches 
+		struct search_task_type
+		{
+			GreedySearch* pSearch; ///< this object 
+			node_value_type* vNode; ///< nodes of a batch, or the node whose candidates are evaluated 
+			int max_swap_cnt; ///< maximum number of swaps 
+			int num_jobs; ///< number of nodes or candidate chunks 
+			vector<candidate_type> const* pCandidate; ///< candidates, NULL for a batch of nodes 
+			vector<node_iterator_type> const* pIt2Pool; ///< iterators of candidates, swap_cnt+1 for each one 
+			int swap_cnt; ///< number of swaps of the candidates 
+			vector<cost_type> vBest; ///< best cost of each job 
+			vector<int> vSwapCnt; ///< number of swaps of each node, -1 if failed 
+		};
+        /// @brief jobs of a task run by limbo::containers::parallel_for 
+		struct search_kernel_type
+		{
+			search_task_type* task; ///< shared state 
+            /// @param b first job 
+            /// @param e end job 
+			void operator()(std::size_t b, std::size_t e) const {task->pSearch->work(*task, b, e);}
+		};
+		/// candidates in a chunk of concurrent evaluation 
+		static const int chunk_size = 64;
+
+        /// enumerate legal candidate positions of a node in the order of rows, swapped nodes and sites 
+        /// @tparam VisitorType visitor called for each candidate 
+        /// @param n node 
+        /// @param swap_cnt number of swaps occurs 
+        /// @param vis visitor 
+		template <typename VisitorType>
+		void enumerate(node_value_type n, int swap_cnt, VisitorType& vis) 
+		{
 			pair<size_t, size_t> row_range = m_cbk.row_range(n);
 
 			size_t row_idx1 = row_range.first;
 			size_t row_idx2 = row_range.second;
 			assert(row_idx1 < row_idx2);
 
-			// it should be initialized to invalid 
-			cost_type best_cost;
-			assert(!m_cbk.check_valid(best_cost));
 			for (size_t row_idx = row_idx1; row_idx != row_idx2; ++row_idx)
 			{
 				node_vector_type& vNode = m_cbk.nodes_in_row(row_idx);
@@ -270,23 +411,143 @@ class GreedySearch
 					{
 						// check displacment constraint 
 						if (!m_cbk.check_displace(n, tgt_site, row_idx)) continue;
-						cost_type cur_cost = m_cbk.calc_cost(n, row_idx, tgt_site, vIt2, swap_cnt);
-						if (!m_cbk.check_valid(best_cost) || cur_cost < best_cost)
+						vis(n, row_idx, tgt_site, vIt2, swap_cnt);
+					}
+				}
+			}
+		}
+        /// @brief search nodes in batches with threads 
+        /// @param vFailNode container to store failed nodes 
+        /// @param max_swap_cnt one cell can swap with how many other cells 
+		void run_parallel(node_fail_vector_type& vFailNode, int max_swap_cnt)
+		{
+			typedef typename node_fail_vector_type::iterator fail_iterator_type;
+			vector<fail_iterator_type> vBatch;
+			vector<node_value_type> vNode;
+			vector<pair<size_t, size_t> > vRowRange;
+			search_task_type task;
+			task.pSearch = this;
+			task.max_swap_cnt = max_swap_cnt;
+			for (fail_iterator_type it = vFailNode.begin(); it != vFailNode.end(); )
+			{
+				// consecutive nodes whose row ranges are separated 
+				vBatch.clear();
+				vNode.clear();
+				vRowRange.clear();
+				for (; it != vFailNode.end() && (int)vBatch.size() < m_batch_size; ++it)
+				{
+					pair<size_t, size_t> row_range = m_cbk.row_range(*it);
+					bool overlap = false;
+					for (typename vector<pair<size_t, size_t> >::const_iterator itRange = vRowRange.begin(); itRange != vRowRange.end(); ++itRange)
+						if (row_range.first < itRange->second+m_batch_row_gap && itRange->first < row_range.second+m_batch_row_gap)
 						{
-							best_cost = cur_cost;
+							overlap = true;
+							break;
 						}
-					}
+					if (overlap) break;
+					vBatch.push_back(it);
+					vNode.push_back(*it);
+					vRowRange.push_back(row_range);
+				}
+
+				task.vNode = &vNode[0];
+				task.vSwapCnt.assign(vNode.size(), -1);
+				if (vNode.size() == 1)
+					this->search_candidates(task);
+				else 
+				{
+					task.pCandidate = NULL;
+					task.num_jobs = vNode.size();
+					task.vBest.assign(vNode.size(), cost_type());
+					this->run_threads(task);
+				}
+				// apply in the order of the list, the next batch starts after the current one 
+				for (unsigned int i = 0; i < vNode.size(); ++i)
+				{
+					if (task.vSwapCnt[i] < 0) continue;
+					m_cbk.apply(vNode[i], task.vBest[i], vFailNode, task.vSwapCnt[i]);
+					vFailNode.erase(vBatch[i]);
 				}
 			}
-			if (m_cbk.check_valid(best_cost))
+		}
+        /// @brief search a node by evaluating its candidates with threads 
+        /// @param task shared state, the node is the first one 
+		void search_candidates(search_task_type& task)
+		{
+			// buffers are reused across numbers of swaps 
+			vector<candidate_type> vCandidate;
+			vector<node_iterator_type> vIt2Pool;
+			for (int swap_cnt = 0; swap_cnt <= task.max_swap_cnt; ++swap_cnt)
 			{
-				// I assume apply() will remove replaced nodes and insert current node 
-				m_cbk.apply(n, best_cost, vFailNode, swap_cnt);
-				return true;
+				vCandidate.clear();
+				vIt2Pool.clear();
+				collect_visitor_type vis (vCandidate, vIt2Pool);
+				this->enumerate(task.vNode[0], swap_cnt, vis);
+				task.pCandidate = &vCandidate;
+				task.pIt2Pool = &vIt2Pool;
+				task.swap_cnt = swap_cnt;
+				task.num_jobs = (vCandidate.size()+chunk_size-1)/chunk_size;
+				task.vBest.assign(task.num_jobs, cost_type());
+				this->run_threads(task);
+				// the first chunk of the smallest cost, as the serial search keeps the first candidate 
+				cost_type best_cost;
+				for (int i = 0; i < task.num_jobs; ++i)
+					if (m_cbk.check_valid(task.vBest[i]) && (!m_cbk.check_valid(best_cost) || task.vBest[i] < best_cost))
+						best_cost = task.vBest[i];
+				if (m_cbk.check_valid(best_cost))
+				{
+					task.vBest.assign(1, best_cost);
+					task.vSwapCnt[0] = swap_cnt;
+					return;
+				}
+			}
+		}
+        /// @brief run jobs of a task with threads 
+        /// @param task shared state 
+		void run_threads(search_task_type& task)
+		{
+			int numThreads = std::min((int)limbo::containers::num_threads(), m_num_threads);
+			search_kernel_type kernel = {&task};
+			limbo::containers::parallel_for(0, task.num_jobs, 1, numThreads, kernel);
+		}
+        /// @brief run a range of jobs 
+        /// @param task shared state 
+        /// @param first first job 
+        /// @param last end job 
+		void work(search_task_type& task, int first, int last)
+		{
+			vector<node_iterator_type> vIt2;
+			for (int i = first; i < last; ++i)
+			{
+				if (task.pCandidate)
+				{
+					// a chunk of candidates of a node 
+					evaluate_visitor_type vis (m_cbk, task.vBest[i]);
+					int end = std::min((int)task.pCandidate->size(), (i+1)*chunk_size);
+					for (int j = i*chunk_size; j < end; ++j)
+					{
+						candidate_type const& c = (*task.pCandidate)[j];
+						typename vector<node_iterator_type>::const_iterator itFirst = task.pIt2Pool->begin()+j*(task.swap_cnt+1);
+						vIt2.assign(itFirst, itFirst+task.swap_cnt+1);
+						vis(task.vNode[0], c.row_idx, c.site, vIt2, task.swap_cnt);
+					}
+				}
+				else 
+				{
+					// a node of a batch 
+					for (int swap_cnt = 0; swap_cnt <= task.max_swap_cnt; ++swap_cnt)
+					{
+						evaluate_visitor_type vis (m_cbk, task.vBest[i]);
+						this->enumerate(task.vNode[i], swap_cnt, vis);
+						if (m_cbk.check_valid(task.vBest[i]))
+						{
+							task.vSwapCnt[i] = swap_cnt;
+							break;
+						}
+					}
+				}
 			}
-			return false;
 		}
-	protected:
         /// @param n node 
         /// @return width of node 
 		site_coordinate_type node_site_size_x(node_const_value_type n) const 
@@ -314,6 +575,9 @@ class GreedySearch
 		}
 
 		callback_type m_cbk; ///< a copiable callback_type is required
+		int m_num_threads; ///< number of threads 
+		int m_batch_size; ///< maximum number of nodes in a batch 
+		size_t m_batch_row_gap; ///< minimum number of rows between row ranges of nodes in a batch 
 };
 
 } // namespace placement
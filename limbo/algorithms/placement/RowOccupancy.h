@@ -0,0 +1,274 @@
+/**
+ * @file   RowOccupancy.h
+ * @brief  Occupancy index of sites in placement rows.
+ *
+ * Callbacks of @ref limbo::algorithms::placement::GreedySearch usually scan node lists of rows
+ * to find whitespace and cells to swap.
+ * This index keeps cells of each row sorted by sites and counts occupied sites with Fenwick trees,
+ * so free sites in a window are counted in logarithmic time,
+ * and cells or legal sites in a window are found in logarithmic time plus the number of cells in the window.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_ALGORITHMS_PLACEMENT_ROWOCCUPANCY_H
+#define _LIMBO_ALGORITHMS_PLACEMENT_ROWOCCUPANCY_H
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cassert>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Placement
+namespace placement
+{
+
+/// @brief Occupancy index of rows of sites.
+///
+/// A cell occupies sites [xl, xh) of a row. Cells in a row never overlap.
+/// @tparam NodeType type of cells, usually a pointer
+/// @tparam CoordinateType integral type of sites
+template <typename NodeType, typename CoordinateType = int>
+class RowOccupancy
+{
+	public:
+        /// @nowarn
+		typedef NodeType node_type;
+		typedef CoordinateType coordinate_type;
+        /// @endnowarn
+		BOOST_STATIC_ASSERT(boost::is_integral<coordinate_type>::value);
+        /// @brief a cell in a row
+		struct cell_type
+		{
+			coordinate_type xh; ///< last site plus one
+			node_type node; ///< cell
+		};
+		/// cells of a row by their first sites
+		typedef std::map<coordinate_type, cell_type> cell_map_type;
+
+        /// @brief add a row
+        /// @param xl first site
+        /// @param xh last site plus one
+        /// @return index of the row
+		std::size_t add_row(coordinate_type xl, coordinate_type xh)
+		{
+			assert(xl <= xh);
+			m_vRow.push_back(row_type());
+			row_type& row = m_vRow.back();
+			row.xl = xl;
+			row.xh = xh;
+			row.vTree1.assign(xh-xl+1, 0);
+			row.vTree2.assign(xh-xl+1, 0);
+			return m_vRow.size()-1;
+		}
+        /// @return number of rows
+		std::size_t num_rows() const {return m_vRow.size();}
+        /// @param r row
+        /// @return first site of row \a r
+		coordinate_type row_xl(std::size_t r) const {return m_vRow[r].xl;}
+        /// @param r row
+        /// @return last site plus one of row \a r
+		coordinate_type row_xh(std::size_t r) const {return m_vRow[r].xh;}
+        /// @param r row
+        /// @return cells of row \a r by their first sites
+		cell_map_type const& cells(std::size_t r) const {return m_vRow[r].mCell;}
+
+        /// @brief place a cell
+        /// @param r row
+        /// @param xl first site
+        /// @param xh last site plus one
+        /// @param n cell
+        /// @return false if the sites are out of the row or occupied
+		bool insert(std::size_t r, coordinate_type xl, coordinate_type xh, node_type const& n)
+		{
+			row_type& row = m_vRow[r];
+			if (xl < row.xl || xh > row.xh || xl >= xh || !is_free(r, xl, xh))
+				return false;
+			cell_type& cell = row.mCell[xl];
+			cell.xh = xh;
+			cell.node = n;
+			add(row, xl, xh, 1);
+			return true;
+		}
+        /// @brief remove a cell
+        /// @param r row
+        /// @param xl first site of the cell
+        /// @return false if no cell starts at \a xl
+		bool erase(std::size_t r, coordinate_type xl)
+		{
+			row_type& row = m_vRow[r];
+			typename cell_map_type::iterator it = row.mCell.find(xl);
+			if (it == row.mCell.end())
+				return false;
+			add(row, xl, it->second.xh, -1);
+			row.mCell.erase(it);
+			return true;
+		}
+
+        /// @param r row
+        /// @param xl first site of the window
+        /// @param xh last site plus one of the window
+        /// @return number of occupied sites in the window clipped by the row
+		coordinate_type occupied_sites(std::size_t r, coordinate_type xl, coordinate_type xh) const
+		{
+			row_type const& row = m_vRow[r];
+			xl = std::max(xl, row.xl);
+			xh = std::min(xh, row.xh);
+			if (xl >= xh) return 0;
+			return prefix(row, xh)-prefix(row, xl);
+		}
+        /// @param r row
+        /// @param xl first site of the window
+        /// @param xh last site plus one of the window
+        /// @return number of free sites in the window clipped by the row
+		coordinate_type free_sites(std::size_t r, coordinate_type xl, coordinate_type xh) const
+		{
+			row_type const& row = m_vRow[r];
+			xl = std::max(xl, row.xl);
+			xh = std::min(xh, row.xh);
+			if (xl >= xh) return 0;
+			return (xh-xl)-(prefix(row, xh)-prefix(row, xl));
+		}
+        /// @param r row
+        /// @param xl first site
+        /// @param xh last site plus one
+        /// @return true if all sites are in the row and free
+		bool is_free(std::size_t r, coordinate_type xl, coordinate_type xh) const
+		{
+			row_type const& row = m_vRow[r];
+			if (xl < row.xl || xh > row.xh) return false;
+			return occupied_sites(r, xl, xh) == 0;
+		}
+        /// @brief collect cells overlapping a window in the order of sites
+        /// @tparam OutputIterator output iterator of node_type
+        /// @param r row
+        /// @param xl first site of the window
+        /// @param xh last site plus one of the window
+        /// @param out output iterator
+		template <typename OutputIterator>
+		OutputIterator cells_in_window(std::size_t r, coordinate_type xl, coordinate_type xh, OutputIterator out) const
+		{
+			if (xl >= xh) return out;
+			cell_map_type const& mCell = m_vRow[r].mCell;
+			for (typename cell_map_type::const_iterator it = first_cell(mCell, xl); it != mCell.end() && it->first < xh; ++it)
+				if (it->second.xh > xl)
+					*out++ = it->second.node;
+			return out;
+		}
+        /// @brief find the free sites for a cell closest to a site within a window
+        /// @param r row
+        /// @param x desired first site
+        /// @param width width of the cell
+        /// @param xl first site of the window
+        /// @param xh last site plus one of the window
+        /// @param site first site found, the smaller one on ties
+        /// @return false if no free sites fit the cell in the window
+		bool nearest_free_site(std::size_t r, coordinate_type x, coordinate_type width,
+				coordinate_type xl, coordinate_type xh, coordinate_type& site) const
+		{
+			row_type const& row = m_vRow[r];
+			xl = std::max(xl, row.xl);
+			xh = std::min(xh, row.xh);
+			// rejected by counting, without walking cells
+			if (width <= 0 || xh-xl < width || free_sites(r, xl, xh) < width)
+				return false;
+			bool found = false;
+			coordinate_type best_dist = 0;
+			coordinate_type gap_xl = xl;
+			cell_map_type const& mCell = row.mCell;
+			for (typename cell_map_type::const_iterator it = first_cell(mCell, xl); ; ++it)
+			{
+				coordinate_type gap_xh = (it == mCell.end())? xh : std::min(it->first, xh);
+				if (gap_xh-gap_xl >= width)
+				{
+					coordinate_type cur = std::min(std::max(x, gap_xl), gap_xh-width);
+					coordinate_type dist = (cur < x)? x-cur : cur-x;
+					if (!found || dist < best_dist)
+					{
+						found = true;
+						best_dist = dist;
+						site = cur;
+					}
+				}
+				if (it == mCell.end() || it->first >= xh)
+					break;
+				gap_xl = std::max(gap_xl, it->second.xh);
+				// gaps further right are only farther
+				if (found && gap_xl >= x && gap_xl-x >= best_dist)
+					break;
+			}
+			return found;
+		}
+	protected:
+        /// @brief a row with Fenwick trees supporting range updates and range sums of occupied sites
+		struct row_type
+		{
+			coordinate_type xl; ///< first site
+			coordinate_type xh; ///< last site plus one
+			std::vector<coordinate_type> vTree1; ///< Fenwick tree of coefficients
+			std::vector<coordinate_type> vTree2; ///< Fenwick tree of corrections
+			cell_map_type mCell; ///< cells by first sites
+		};
+
+        /// @param mCell cells of a row
+        /// @param xl first site of a window
+        /// @return first cell that may overlap the window
+		static typename cell_map_type::const_iterator first_cell(cell_map_type const& mCell, coordinate_type xl)
+		{
+			typename cell_map_type::const_iterator it = mCell.upper_bound(xl);
+			if (it != mCell.begin())
+			{
+				typename cell_map_type::const_iterator itPrev = it;
+				--itPrev;
+				if (itPrev->second.xh > xl)
+					it = itPrev;
+			}
+			return it;
+		}
+        /// @brief add a value to a Fenwick tree from an index to the end
+		static void update(std::vector<coordinate_type>& vTree, coordinate_type i, coordinate_type v)
+		{
+			for (++i; i < (coordinate_type)vTree.size(); i += i & -i)
+				vTree[i] += v;
+		}
+        /// @return sum of a Fenwick tree up to index \a i exclusive
+		static coordinate_type query(std::vector<coordinate_type> const& vTree, coordinate_type i)
+		{
+			coordinate_type sum = 0;
+			for (; i > 0; i -= i & -i)
+				sum += vTree[i];
+			return sum;
+		}
+        /// @brief add \a v to sites [xl, xh) of a row
+		static void add(row_type& row, coordinate_type xl, coordinate_type xh, coordinate_type v)
+		{
+			coordinate_type l = xl-row.xl;
+			coordinate_type h = xh-row.xl;
+			update(row.vTree1, l, v);
+			update(row.vTree1, h, -v);
+			update(row.vTree2, l, v*l);
+			update(row.vTree2, h, -v*h);
+		}
+        /// @return number of occupied sites in [row.xl, x)
+		static coordinate_type prefix(row_type const& row, coordinate_type x)
+		{
+			coordinate_type i = x-row.xl;
+			return query(row.vTree1, i)*i-query(row.vTree2, i);
+		}
+
+		std::vector<row_type> m_vRow; ///< rows
+};
+
+} // namespace placement
+} // namespace algorithms
+} // namespace limbo
+
+#endif
@@ -0,0 +1,910 @@
+/**
+ * @file   Wirelength.h
+ * @brief  Wirelength of netlists on flat net-to-pin arrays, with incremental HPWL of moves and swaps and smoothed wirelength.
+ *
+ * Placers on top of BookshelfParser and DefParser evaluate wirelength by walking pins of nets by names.
+ * This engine converts nets once to arrays of pins with cells and offsets,
+ * so the half-perimeter wirelength (HPWL) of a placement is a pass over contiguous arrays.
+ * Bounding boxes of nets are cached with the number of pins on each side,
+ * so the HPWL change of moving or swapping cells costs the pins of their nets in most cases.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_ALGORITHMS_PLACEMENT_WIRELENGTH_H
+#define _LIMBO_ALGORITHMS_PLACEMENT_WIRELENGTH_H
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Algorithms
+namespace algorithms
+{
+/// namespace for Limbo.Algorithms.Placement
+namespace placement
+{
+
+using boost::uint32_t;
+using boost::int32_t;
+
+/// @brief Wirelength of a netlist.
+///
+/// Pins are kept in arrays of cells and offsets ordered by nets, and a pin is at the position of its cell plus its offset.
+/// Positions of cells are the ones given by users, e.g., centers of cells for Bookshelf offsets.
+///
+/// @ref hpwl evaluates a placement from scratch.
+/// Pins are split into fixed blocks of whole nets taken by threads, positions of pins are gathered into small buffers,
+/// and the sums of blocks are added up in order, so the result does not depend on the number of threads.
+///
+/// @ref init keeps a placement with the bounding box of each net and the number of pins on each side of the box.
+/// The change of HPWL by moving pins off a side only scans the net when the side loses all its pins.
+/// @ref delta_move and @ref delta_swap are const and can run concurrently,
+/// so they fit calc_cost of a thread-safe callback of @ref limbo::algorithms::placement::GreedySearch,
+/// while apply() of the callback calls @ref move or @ref swap.
+///
+/// @ref smooth_wirelength evaluates the weighted-average or log-sum-exp wirelength with gradients for analytical placement.
+///
+/// Usage:
+/// ~~~~~~~~~~~~~~~~
+/// Wirelength<double> wl (numCells);
+/// wl.add_net();
+/// wl.add_pin(cell, dx, dy); // pins are added to the last net
+/// wl.build();
+/// double total = wl.hpwl(vX, vY);
+/// wl.init(vX, vY);
+/// double d = wl.delta_move(cell, x, y);
+/// wl.move(cell, x, y);
+/// ~~~~~~~~~~~~~~~~
+/// @tparam CoordinateType type of coordinates
+template <typename CoordinateType = double>
+class Wirelength
+{
+	public:
+        /// @nowarn
+		typedef CoordinateType coordinate_type;
+        /// @endnowarn
+		/// smoothed wirelength models
+		enum smooth_model_type
+		{
+			WEIGHTED_AVERAGE, ///< weighted-average wirelength
+			LOG_SUM_EXP ///< log-sum-exp wirelength
+		};
+		/// bound of a net in one direction with the number of pins on each side
+		struct bound_type
+		{
+			coordinate_type lo; ///< lower side
+			coordinate_type hi; ///< upper side
+			uint32_t count_lo; ///< number of pins on the lower side
+			uint32_t count_hi; ///< number of pins on the upper side
+		};
+
+		/// constructor
+		/// @param num_cells number of cells
+		explicit Wirelength(uint32_t num_cells)
+			: m_num_cells(num_cells)
+			, m_threads(1)
+			, m_built(false)
+			, m_total(0)
+		{
+			m_vNetPinBegin.push_back(0);
+		}
+
+		/// set number of threads
+		/// @param t number of threads
+		void threads(int32_t t) {m_threads = t;}
+		/// @return number of cells
+		uint32_t num_cells() const {return m_num_cells;}
+		/// @return number of nets
+		uint32_t num_nets() const {return m_vNetWeight.size();}
+		/// @return number of pins
+		uint32_t num_pins() const {return m_vPinCell.size();}
+		/// @name pins of nets and cells
+		/// pins of net n are in [net_pin_begin(n), net_pin_end(n)),
+		/// and pins of cell c are cell_pin(i) for i in [cell_pin_begin(c), cell_pin_end(c)) ordered by nets
+		///@{
+		/// @return index of the first pin of a net
+		uint32_t net_pin_begin(uint32_t n) const {return m_vNetPinBegin[n];}
+		/// @return index after the last pin of a net
+		uint32_t net_pin_end(uint32_t n) const {return m_vNetPinBegin[n+1];}
+		/// @return weight of a net
+		double net_weight(uint32_t n) const {return m_vNetWeight[n];}
+		/// @return cell of a pin
+		uint32_t pin_cell(uint32_t p) const {return m_vPinCell[p];}
+		/// @return net of a pin
+		uint32_t pin_net(uint32_t p) const {return m_vPinNet[p];}
+		/// @return offset of a pin to its cell in x direction
+		coordinate_type pin_offset_x(uint32_t p) const {return m_vPinOffsetX[p];}
+		/// @return offset of a pin to its cell in y direction
+		coordinate_type pin_offset_y(uint32_t p) const {return m_vPinOffsetY[p];}
+		/// @return offset of the first pin of a cell, only after @ref build
+		uint32_t cell_pin_begin(uint32_t c) const {return m_vCellPinBegin[c];}
+		/// @return offset after the last pin of a cell, only after @ref build
+		uint32_t cell_pin_end(uint32_t c) const {return m_vCellPinBegin[c+1];}
+		/// @return pin at an offset of pins of cells, only after @ref build
+		uint32_t cell_pin(uint32_t i) const {return m_vCellPin[i];}
+		///@}
+
+		/// @brief add a net, following pins are added to it
+		/// @param weight weight of the net
+		/// @return index of the net
+		uint32_t add_net(double weight = 1)
+		{
+			m_vNetWeight.push_back(weight);
+			m_vNetPinBegin.push_back(m_vPinCell.size());
+			m_built = false;
+			return m_vNetWeight.size()-1;
+		}
+		/// @brief add a pin to the last net
+		/// @param cell cell of the pin
+		/// @param offset_x, offset_y offset of the pin to the position of its cell
+		/// @return index of the pin
+		uint32_t add_pin(uint32_t cell, coordinate_type offset_x = 0, coordinate_type offset_y = 0)
+		{
+			limboAssertMsg(!m_vNetWeight.empty(), "no net to add pins");
+			limboAssertMsg(cell < m_num_cells, "cell %u out of %u cells", cell, m_num_cells);
+			m_vPinCell.push_back(cell);
+			m_vPinNet.push_back(m_vNetWeight.size()-1);
+			m_vPinOffsetX.push_back(offset_x);
+			m_vPinOffsetY.push_back(offset_y);
+			m_vNetPinBegin.back() = m_vPinCell.size();
+			m_built = false;
+			return m_vPinCell.size()-1;
+		}
+		/// @brief add a net of BookshelfParser
+		///
+		/// Nodes of pins are given by node_id from BookshelfParser::BookshelfIndexDataBase, or by names in \a mCell.
+		/// Pins of nodes not found are skipped. Offsets of Bookshelf pins are from centers of nodes.
+		/// @tparam NetType BookshelfParser::Net
+		/// @tparam CellIndexMap map from node names to cells
+		/// @param net net
+		/// @param mCell cells of nodes
+		/// @param weight weight of the net
+		/// @return index of the net
+		template <typename NetType, typename CellIndexMap>
+		uint32_t add_bookshelf_net(NetType const& net, CellIndexMap const& mCell, double weight = 1)
+		{
+			uint32_t n = this->add_net(weight);
+			for (uint32_t i = 0; i < net.vNetPin.size(); ++i)
+			{
+				if (net.vNetPin[i].node_id >= 0)
+					this->add_pin(net.vNetPin[i].node_id, net.vNetPin[i].offset[0], net.vNetPin[i].offset[1]);
+				else
+				{
+					typename CellIndexMap::const_iterator found = mCell.find(net.vNetPin[i].node_name);
+					if (found != mCell.end())
+						this->add_pin(found->second, net.vNetPin[i].offset[0], net.vNetPin[i].offset[1]);
+				}
+			}
+			return n;
+		}
+		/// @brief add a net of DefParser with offsets of pins from macros
+		///
+		/// IO pins, whose node names are "PIN", are found in \a mCell by pin names.
+		/// Pins of nodes not found are skipped.
+		/// @tparam NetType DefParser::Net
+		/// @tparam CellIndexMap map from component and IO pin names to cells
+		/// @tparam PinOffsetType function object offset(node_name, pin_name, offset_x, offset_y) setting the offset of a pin
+		/// @param net net
+		/// @param mCell cells of components and IO pins
+		/// @param offset offsets of pins
+		/// @param weight weight of the net
+		/// @return index of the net
+		template <typename NetType, typename CellIndexMap, typename PinOffsetType>
+		uint32_t add_def_net(NetType const& net, CellIndexMap const& mCell, PinOffsetType offset, double weight = 1)
+		{
+			uint32_t n = this->add_net(weight);
+			for (uint32_t i = 0; i < net.vNetPin.size(); ++i)
+			{
+				bool io = (net.vNetPin[i].first == "PIN");
+				typename CellIndexMap::const_iterator found = mCell.find(io? net.vNetPin[i].second : net.vNetPin[i].first);
+				if (found == mCell.end())
+					continue;
+				coordinate_type offset_x = 0;
+				coordinate_type offset_y = 0;
+				if (!io)
+					offset(net.vNetPin[i].first, net.vNetPin[i].second, offset_x, offset_y);
+				this->add_pin(found->second, offset_x, offset_y);
+			}
+			return n;
+		}
+		/// @brief add a net of DefParser with pins at the positions of their cells
+		/// @tparam NetType DefParser::Net
+		/// @tparam CellIndexMap map from component and IO pin names to cells
+		/// @param net net
+		/// @param mCell cells of components and IO pins
+		/// @param weight weight of the net
+		/// @return index of the net
+		template <typename NetType, typename CellIndexMap>
+		uint32_t add_def_net(NetType const& net, CellIndexMap const& mCell, double weight = 1)
+		{
+			return this->add_def_net(net, mCell, zero_offset_type(), weight);
+		}
+		/// @brief build pins of cells and blocks of the reduction, called after all nets are added
+		void build();
+
+		/// @param vX, vY positions of cells
+		/// @return weighted HPWL of a placement
+		double hpwl(std::vector<coordinate_type> const& vX, std::vector<coordinate_type> const& vY) const;
+		/// @brief smoothed wirelength of a placement
+		/// @param vX, vY positions of cells
+		/// @param gamma smoothing parameter, a smaller one is closer to HPWL
+		/// @param model smoothed wirelength model
+		/// @param vGradX, vGradY gradients of cells as output, resized to the number of cells, or NULL
+		/// @return weighted smoothed wirelength
+		double smooth_wirelength(std::vector<coordinate_type> const& vX, std::vector<coordinate_type> const& vY, double gamma,
+				smooth_model_type model = WEIGHTED_AVERAGE, std::vector<double>* vGradX = NULL, std::vector<double>* vGradY = NULL) const;
+
+		/// @name incremental HPWL
+		///@{
+		/// @brief keep a placement and bounding boxes of nets
+		/// @param vX, vY positions of cells
+		/// @return weighted HPWL of the placement
+		double init(std::vector<coordinate_type> const& vX, std::vector<coordinate_type> const& vY);
+		/// @return weighted HPWL of the kept placement, accumulated over moves since @ref init
+		double total() const {return m_total;}
+		/// @return position of a cell in the kept placement in x direction
+		coordinate_type x(uint32_t c) const {return m_vX[c];}
+		/// @return position of a cell in the kept placement in y direction
+		coordinate_type y(uint32_t c) const {return m_vY[c];}
+		/// @return bound of a net in x direction in the kept placement
+		bound_type const& bound_x(uint32_t n) const {return m_vBoundX[n];}
+		/// @return bound of a net in y direction in the kept placement
+		bound_type const& bound_y(uint32_t n) const {return m_vBoundY[n];}
+		/// @return weighted HPWL of a net in the kept placement
+		double net_hpwl(uint32_t n) const
+		{
+			if (m_vNetPinBegin[n] == m_vNetPinBegin[n+1])
+				return 0;
+			return m_vNetWeight[n]*((m_vBoundX[n].hi-m_vBoundX[n].lo)+(m_vBoundY[n].hi-m_vBoundY[n].lo));
+		}
+		/// @param c cell
+		/// @param x, y new position of \a c
+		/// @return change of HPWL if \a c moves to (x, y)
+		double delta_move(uint32_t c, coordinate_type x, coordinate_type y) const
+		{
+			move_type m = {c, x, y};
+			return this->delta(&m, 1, NULL, NULL);
+		}
+		/// @param c1, c2 cells
+		/// @return change of HPWL if \a c1 and \a c2 exchange their positions
+		double delta_swap(uint32_t c1, uint32_t c2) const
+		{
+			move_type vMove[2] = {{c1, m_vX[c2], m_vY[c2]}, {c2, m_vX[c1], m_vY[c1]}};
+			return this->delta(vMove, (c1 == c2)? 1 : 2, NULL, NULL);
+		}
+		/// @brief move a cell and update bounding boxes of its nets
+		/// @param c cell
+		/// @param x, y new position of \a c
+		/// @return change of HPWL
+		double move(uint32_t c, coordinate_type x, coordinate_type y)
+		{
+			move_type m = {c, x, y};
+			return this->apply(&m, 1);
+		}
+		/// @brief exchange positions of two cells and update bounding boxes of their nets
+		/// @param c1, c2 cells
+		/// @return change of HPWL
+		double swap(uint32_t c1, uint32_t c2)
+		{
+			move_type vMove[2] = {{c1, m_vX[c2], m_vY[c2]}, {c2, m_vX[c1], m_vY[c1]}};
+			return this->apply(vMove, (c1 == c2)? 1 : 2);
+		}
+		///@}
+
+	protected:
+		/// pins in a block of the reduction, a larger net makes a block itself
+		static const uint32_t block_size = 1<<14;
+		/// pins whose positions are gathered at a time
+		static const uint32_t chunk_size = 256;
+
+		/// new position of a cell
+		struct move_type
+		{
+			uint32_t cell; ///< cell
+			coordinate_type x; ///< new position in x direction
+			coordinate_type y; ///< new position in y direction
+		};
+		/// pins at the positions of their cells
+		struct zero_offset_type
+		{
+			/// @brief set zero offsets
+			void operator()(std::string const&, std::string const&, coordinate_type& offset_x, coordinate_type& offset_y) const
+			{
+				offset_x = 0;
+				offset_y = 0;
+			}
+		};
+		/// kinds of tasks of blocks
+		enum task_kind_type
+		{
+			TASK_HPWL, ///< HPWL of nets
+			TASK_BOUND, ///< bounding boxes of nets
+			TASK_SMOOTH, ///< smoothed wirelength and gradients of pins
+			TASK_GATHER ///< gradients of cells from pins
+		};
+		/// shared state of a reduction over blocks
+		struct task_type
+		{
+			Wirelength const* pWL; ///< this object
+			task_kind_type kind; ///< kind of the task
+			coordinate_type const* pX; ///< positions of cells in x direction
+			coordinate_type const* pY; ///< positions of cells in y direction
+			bound_type* pBoundX; ///< bounds of nets in x direction as output of TASK_BOUND
+			bound_type* pBoundY; ///< bounds of nets in y direction as output of TASK_BOUND
+			double gamma; ///< smoothing parameter
+			smooth_model_type model; ///< smoothed wirelength model
+			double* pPinGradX; ///< gradients of pins in x direction, or NULL
+			double* pPinGradY; ///< gradients of pins in y direction, or NULL
+			double* pGradX; ///< gradients of cells in x direction as output of TASK_GATHER
+			double* pGradY; ///< gradients of cells in y direction as output of TASK_GATHER
+			uint32_t num_blocks; ///< number of blocks
+			std::vector<double> vBlock; ///< result of each block
+		};
+
+		/// run blocks of a task by threads
+		/// @param task shared state
+		void run(task_type& task) const;
+		/// run blocks in [first, last)
+		/// @param task shared state
+		/// @param first first block
+		/// @param last end block
+		void reduce(task_type& task, uint32_t first, uint32_t last) const;
+		/// range of blocks run by limbo::containers::parallel_for
+		struct reduce_kernel_type
+		{
+			task_type* task; ///< shared state
+			/// @param b first block
+			/// @param e end block
+			void operator()(std::size_t b, std::size_t e) const {task->pWL->reduce(*task, b, e);}
+		};
+		/// @return weighted HPWL of nets in [first, last)
+		double hpwl_range(coordinate_type const* pX, coordinate_type const* pY, uint32_t first, uint32_t last) const;
+		/// @brief compute bounds of nets in [first, last)
+		/// @return weighted HPWL of the nets
+		double bound_range(task_type& task, uint32_t first, uint32_t last) const;
+		/// @brief compute smoothed wirelength and gradients of pins of nets in [first, last)
+		/// @return weighted smoothed wirelength of the nets
+		double smooth_range(task_type& task, uint32_t first, uint32_t last) const;
+		/// @brief smoothed wirelength of a net in one direction
+		/// @param pPos positions of pins of the net
+		/// @param n number of pins
+		/// @param gamma smoothing parameter
+		/// @param model smoothed wirelength model
+		/// @param pGrad gradients of pins as output, or NULL
+		/// @return smoothed wirelength
+		static double smooth_net(double const* pPos, uint32_t n, double gamma, smooth_model_type model, double* pGrad);
+		/// @brief compute bound of a net in one direction
+		/// @param pPos positions of pins of the net
+		/// @param n number of pins, at least 1
+		/// @param bound bound as output
+		static void compute_bound(coordinate_type const* pPos, uint32_t n, bound_type& bound);
+		/// @brief bounds of a net after moving cells
+		/// @param net net
+		/// @param vMove moves
+		/// @param num_moves number of moves
+		/// @param bx, by bounds as output
+		void moved_bound(uint32_t net, move_type const* vMove, uint32_t num_moves, bound_type& bx, bound_type& by) const;
+		/// @brief change of HPWL of moving cells
+		/// @param vMove moves
+		/// @param num_moves number of moves, 1 or 2 with different cells
+		/// @param vBoundX, vBoundY new bounds of nets of the moved cells as output in the order of visiting, or NULL
+		/// @return change of HPWL
+		double delta(move_type const* vMove, uint32_t num_moves, std::vector<std::pair<uint32_t, bound_type> >* vBoundX,
+				std::vector<std::pair<uint32_t, bound_type> >* vBoundY) const;
+		/// @brief move cells and update bounds of their nets
+		/// @param vMove moves
+		/// @param num_moves number of moves
+		/// @return change of HPWL
+		double apply(move_type const* vMove, uint32_t num_moves);
+		/// @return true if one of the first \a num_moves cells has a pin on the net
+		bool has_net(move_type const* vMove, uint32_t num_moves, uint32_t net) const
+		{
+			for (uint32_t i = 0; i < num_moves; ++i)
+			{
+				std::vector<uint32_t>::const_iterator first = m_vCellPinNet.begin()+m_vCellPinBegin[vMove[i].cell];
+				std::vector<uint32_t>::const_iterator last = m_vCellPinNet.begin()+m_vCellPinBegin[vMove[i].cell+1];
+				if (std::binary_search(first, last, net))
+					return true;
+			}
+			return false;
+		}
+
+		uint32_t m_num_cells; ///< number of cells
+		std::vector<uint32_t> m_vNetPinBegin; ///< index of the first pin of each net, with the number of pins at the end
+		std::vector<double> m_vNetWeight; ///< weight of each net
+		std::vector<uint32_t> m_vPinCell; ///< cell of each pin
+		std::vector<uint32_t> m_vPinNet; ///< net of each pin
+		std::vector<coordinate_type> m_vPinOffsetX; ///< offset of each pin in x direction
+		std::vector<coordinate_type> m_vPinOffsetY; ///< offset of each pin in y direction
+		std::vector<uint32_t> m_vCellPinBegin; ///< offset of pins of each cell
+		std::vector<uint32_t> m_vCellPin; ///< pins of cells ordered by nets
+		std::vector<uint32_t> m_vCellPinNet; ///< net of each pin in @ref m_vCellPin, for searching nets of a cell
+		std::vector<uint32_t> m_vBlockBegin; ///< first net of each block, with the number of nets at the end
+		int32_t m_threads; ///< number of threads
+		bool m_built; ///< whether @ref build is called after the last net
+
+		std::vector<coordinate_type> m_vX; ///< kept positions of cells in x direction
+		std::vector<coordinate_type> m_vY; ///< kept positions of cells in y direction
+		std::vector<bound_type> m_vBoundX; ///< bound of each net in x direction
+		std::vector<bound_type> m_vBoundY; ///< bound of each net in y direction
+		double m_total; ///< HPWL of the kept placement
+};
+
+template <typename CoordinateType>
+const uint32_t Wirelength<CoordinateType>::block_size;
+template <typename CoordinateType>
+const uint32_t Wirelength<CoordinateType>::chunk_size;
+
+template <typename CoordinateType>
+void Wirelength<CoordinateType>::build()
+{
+	// pins of cells by counting sort, pins of each cell come in the order of nets
+	m_vCellPinBegin.assign(m_num_cells+1, 0);
+	for (uint32_t p = 0; p < m_vPinCell.size(); ++p)
+		m_vCellPinBegin[m_vPinCell[p]+1] += 1;
+	for (uint32_t c = 0; c < m_num_cells; ++c)
+		m_vCellPinBegin[c+1] += m_vCellPinBegin[c];
+	m_vCellPin.resize(m_vPinCell.size());
+	m_vCellPinNet.resize(m_vPinCell.size());
+	std::vector<uint32_t> vPos (m_vCellPinBegin.begin(), m_vCellPinBegin.end()-1);
+	for (uint32_t p = 0; p < m_vPinCell.size(); ++p)
+	{
+		uint32_t i = vPos[m_vPinCell[p]]++;
+		m_vCellPin[i] = p;
+		m_vCellPinNet[i] = m_vPinNet[p];
+	}
+	// blocks of whole nets
+	m_vBlockBegin.assign(1, 0);
+	for (uint32_t n = 0; n < num_nets(); ++n)
+	{
+		if (m_vNetPinBegin[n+1]-m_vNetPinBegin[m_vBlockBegin.back()] > block_size && n > m_vBlockBegin.back())
+			m_vBlockBegin.push_back(n);
+	}
+	m_vBlockBegin.push_back(num_nets());
+	m_built = true;
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::hpwl(std::vector<coordinate_type> const& vX, std::vector<coordinate_type> const& vY) const
+{
+	limboAssertMsg(m_built, "build() is not called after adding nets");
+	limboAssert(vX.size() == m_num_cells && vY.size() == m_num_cells);
+	task_type task;
+	task.kind = TASK_HPWL;
+	task.pX = (m_num_cells)? &vX[0] : NULL;
+	task.pY = (m_num_cells)? &vY[0] : NULL;
+	this->run(task);
+	double total = 0;
+	for (uint32_t i = 0; i < task.num_blocks; ++i)
+		total += task.vBlock[i];
+	return total;
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::smooth_wirelength(std::vector<coordinate_type> const& vX, std::vector<coordinate_type> const& vY, double gamma,
+		smooth_model_type model, std::vector<double>* vGradX, std::vector<double>* vGradY) const
+{
+	limboAssertMsg(m_built, "build() is not called after adding nets");
+	limboAssert(vX.size() == m_num_cells && vY.size() == m_num_cells);
+	limboAssertMsg(gamma > 0, "gamma %g is not positive", gamma);
+	// gradients of pins are written by nets and then added up by cells, so no two threads write the same entry
+	std::vector<double> vPinGradX ((vGradX)? num_pins() : 0);
+	std::vector<double> vPinGradY ((vGradY)? num_pins() : 0);
+	task_type task;
+	task.kind = TASK_SMOOTH;
+	task.pX = (m_num_cells)? &vX[0] : NULL;
+	task.pY = (m_num_cells)? &vY[0] : NULL;
+	task.gamma = gamma;
+	task.model = model;
+	task.pPinGradX = (vPinGradX.empty())? NULL : &vPinGradX[0];
+	task.pPinGradY = (vPinGradY.empty())? NULL : &vPinGradY[0];
+	this->run(task);
+	double total = 0;
+	for (uint32_t i = 0; i < task.num_blocks; ++i)
+		total += task.vBlock[i];
+
+	if (vGradX)
+		vGradX->assign(m_num_cells, 0);
+	if (vGradY)
+		vGradY->assign(m_num_cells, 0);
+	if ((vGradX || vGradY) && m_num_cells > 0)
+	{
+		task.kind = TASK_GATHER;
+		task.pGradX = (vGradX)? &(*vGradX)[0] : NULL;
+		task.pGradY = (vGradY)? &(*vGradY)[0] : NULL;
+		this->run(task);
+	}
+	return total;
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::init(std::vector<coordinate_type> const& vX, std::vector<coordinate_type> const& vY)
+{
+	limboAssertMsg(m_built, "build() is not called after adding nets");
+	limboAssert(vX.size() == m_num_cells && vY.size() == m_num_cells);
+	m_vX = vX;
+	m_vY = vY;
+	m_vBoundX.resize(num_nets());
+	m_vBoundY.resize(num_nets());
+	task_type task;
+	task.kind = TASK_BOUND;
+	task.pX = (m_num_cells)? &m_vX[0] : NULL;
+	task.pY = (m_num_cells)? &m_vY[0] : NULL;
+	task.pBoundX = (m_vBoundX.empty())? NULL : &m_vBoundX[0];
+	task.pBoundY = (m_vBoundY.empty())? NULL : &m_vBoundY[0];
+	this->run(task);
+	m_total = 0;
+	for (uint32_t i = 0; i < task.num_blocks; ++i)
+		m_total += task.vBlock[i];
+	return m_total;
+}
+
+template <typename CoordinateType>
+void Wirelength<CoordinateType>::run(task_type& task) const
+{
+	task.pWL = this;
+	// gradients of cells are gathered in blocks of cells, other tasks in blocks of nets
+	task.num_blocks = (task.kind == TASK_GATHER)? (m_num_cells+block_size-1)/block_size : m_vBlockBegin.size()-1;
+	task.vBlock.assign(task.num_blocks, 0);
+
+	int32_t numThreads = std::min((int32_t)limbo::containers::num_threads(), m_threads);
+	reduce_kernel_type kernel = {&task};
+	limbo::containers::parallel_for(0, task.num_blocks, 1, numThreads, kernel);
+}
+
+template <typename CoordinateType>
+void Wirelength<CoordinateType>::reduce(task_type& task, uint32_t first, uint32_t last) const
+{
+	for (uint32_t i = first; i < last; ++i)
+	{
+		switch (task.kind)
+		{
+			case TASK_HPWL:
+				task.vBlock[i] = this->hpwl_range(task.pX, task.pY, m_vBlockBegin[i], m_vBlockBegin[i+1]);
+				break;
+			case TASK_BOUND:
+				task.vBlock[i] = this->bound_range(task, m_vBlockBegin[i], m_vBlockBegin[i+1]);
+				break;
+			case TASK_SMOOTH:
+				task.vBlock[i] = this->smooth_range(task, m_vBlockBegin[i], m_vBlockBegin[i+1]);
+				break;
+			case TASK_GATHER:
+				for (uint32_t c = i*block_size, ce = std::min(m_num_cells, (i+1)*block_size); c < ce; ++c)
+				{
+					double gx = 0;
+					double gy = 0;
+					for (uint32_t k = m_vCellPinBegin[c]; k < m_vCellPinBegin[c+1]; ++k)
+					{
+						if (task.pPinGradX) gx += task.pPinGradX[m_vCellPin[k]];
+						if (task.pPinGradY) gy += task.pPinGradY[m_vCellPin[k]];
+					}
+					if (task.pGradX) task.pGradX[c] = gx;
+					if (task.pGradY) task.pGradY[c] = gy;
+				}
+				break;
+		}
+	}
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::hpwl_range(coordinate_type const* pX, coordinate_type const* pY, uint32_t first, uint32_t last) const
+{
+	coordinate_type vPinX[chunk_size];
+	coordinate_type vPinY[chunk_size];
+	double total = 0;
+	uint32_t net = first;
+	uint32_t pin_last = m_vNetPinBegin[last];
+	coordinate_type xl = std::numeric_limits<coordinate_type>::max();
+	coordinate_type xh = -std::numeric_limits<coordinate_type>::max();
+	coordinate_type yl = xl;
+	coordinate_type yh = xh;
+	// positions of a chunk of pins are gathered in one loop, and then nets are closed as their last pins pass
+	for (uint32_t begin = m_vNetPinBegin[first]; begin < pin_last; begin += chunk_size)
+	{
+		uint32_t n = std::min(chunk_size, pin_last-begin);
+		uint32_t const* pCell = &m_vPinCell[begin];
+		coordinate_type const* pOffsetX = &m_vPinOffsetX[begin];
+		coordinate_type const* pOffsetY = &m_vPinOffsetY[begin];
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			vPinX[i] = pX[pCell[i]]+pOffsetX[i];
+			vPinY[i] = pY[pCell[i]]+pOffsetY[i];
+		}
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			while (begin+i == m_vNetPinBegin[net+1])
+			{
+				if (m_vNetPinBegin[net] != m_vNetPinBegin[net+1])
+					total += m_vNetWeight[net]*((xh-xl)+(yh-yl));
+				xl = yl = std::numeric_limits<coordinate_type>::max();
+				xh = yh = -std::numeric_limits<coordinate_type>::max();
+				++net;
+			}
+			xl = std::min(xl, vPinX[i]);
+			xh = std::max(xh, vPinX[i]);
+			yl = std::min(yl, vPinY[i]);
+			yh = std::max(yh, vPinY[i]);
+		}
+	}
+	// the last net with pins, empty nets after it add nothing
+	for (; net < last; ++net)
+	{
+		if (m_vNetPinBegin[net] != m_vNetPinBegin[net+1])
+		{
+			total += m_vNetWeight[net]*((xh-xl)+(yh-yl));
+			break;
+		}
+	}
+	return total;
+}
+
+template <typename CoordinateType>
+void Wirelength<CoordinateType>::compute_bound(coordinate_type const* pPos, uint32_t n, bound_type& bound)
+{
+	bound.lo = bound.hi = pPos[0];
+	for (uint32_t i = 1; i < n; ++i)
+	{
+		bound.lo = std::min(bound.lo, pPos[i]);
+		bound.hi = std::max(bound.hi, pPos[i]);
+	}
+	bound.count_lo = bound.count_hi = 0;
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		bound.count_lo += (pPos[i] == bound.lo);
+		bound.count_hi += (pPos[i] == bound.hi);
+	}
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::bound_range(task_type& task, uint32_t first, uint32_t last) const
+{
+	std::vector<coordinate_type> vPinX;
+	std::vector<coordinate_type> vPinY;
+	double total = 0;
+	for (uint32_t net = first; net < last; ++net)
+	{
+		uint32_t begin = m_vNetPinBegin[net];
+		uint32_t n = m_vNetPinBegin[net+1]-begin;
+		if (n == 0)
+			continue;
+		vPinX.resize(n);
+		vPinY.resize(n);
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			vPinX[i] = task.pX[m_vPinCell[begin+i]]+m_vPinOffsetX[begin+i];
+			vPinY[i] = task.pY[m_vPinCell[begin+i]]+m_vPinOffsetY[begin+i];
+		}
+		compute_bound(&vPinX[0], n, task.pBoundX[net]);
+		compute_bound(&vPinY[0], n, task.pBoundY[net]);
+		total += m_vNetWeight[net]*((task.pBoundX[net].hi-task.pBoundX[net].lo)+(task.pBoundY[net].hi-task.pBoundY[net].lo));
+	}
+	return total;
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::smooth_net(double const* pPos, uint32_t n, double gamma, smooth_model_type model, double* pGrad)
+{
+	double lo = pPos[0];
+	double hi = pPos[0];
+	for (uint32_t i = 1; i < n; ++i)
+	{
+		lo = std::min(lo, pPos[i]);
+		hi = std::max(hi, pPos[i]);
+	}
+	// exponents are shifted by the extremes, so they never overflow
+	double sum_hi = 0, sum_lo = 0;
+	double moment_hi = 0, moment_lo = 0;
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		double e_hi = exp((pPos[i]-hi)/gamma);
+		double e_lo = exp((lo-pPos[i])/gamma);
+		sum_hi += e_hi;
+		sum_lo += e_lo;
+		moment_hi += pPos[i]*e_hi;
+		moment_lo += pPos[i]*e_lo;
+	}
+	double wl = 0;
+	if (model == WEIGHTED_AVERAGE)
+	{
+		double wa_hi = moment_hi/sum_hi;
+		double wa_lo = moment_lo/sum_lo;
+		wl = wa_hi-wa_lo;
+		if (pGrad)
+		{
+			for (uint32_t i = 0; i < n; ++i)
+			{
+				double e_hi = exp((pPos[i]-hi)/gamma);
+				double e_lo = exp((lo-pPos[i])/gamma);
+				pGrad[i] = e_hi/sum_hi*(1+(pPos[i]-wa_hi)/gamma)-e_lo/sum_lo*(1-(pPos[i]-wa_lo)/gamma);
+			}
+		}
+	}
+	else
+	{
+		wl = (hi+gamma*log(sum_hi))-(lo-gamma*log(sum_lo));
+		if (pGrad)
+		{
+			for (uint32_t i = 0; i < n; ++i)
+				pGrad[i] = exp((pPos[i]-hi)/gamma)/sum_hi-exp((lo-pPos[i])/gamma)/sum_lo;
+		}
+	}
+	return wl;
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::smooth_range(task_type& task, uint32_t first, uint32_t last) const
+{
+	std::vector<double> vPos;
+	double total = 0;
+	for (uint32_t net = first; net < last; ++net)
+	{
+		uint32_t begin = m_vNetPinBegin[net];
+		uint32_t n = m_vNetPinBegin[net+1]-begin;
+		if (n == 0)
+			continue;
+		double weight = m_vNetWeight[net];
+		double wl = 0;
+		vPos.resize(n);
+		for (uint32_t i = 0; i < n; ++i)
+			vPos[i] = task.pX[m_vPinCell[begin+i]]+m_vPinOffsetX[begin+i];
+		wl += smooth_net(&vPos[0], n, task.gamma, task.model, (task.pPinGradX)? task.pPinGradX+begin : NULL);
+		for (uint32_t i = 0; i < n; ++i)
+			vPos[i] = task.pY[m_vPinCell[begin+i]]+m_vPinOffsetY[begin+i];
+		wl += smooth_net(&vPos[0], n, task.gamma, task.model, (task.pPinGradY)? task.pPinGradY+begin : NULL);
+		for (uint32_t i = 0; task.pPinGradX && i < n; ++i)
+			task.pPinGradX[begin+i] *= weight;
+		for (uint32_t i = 0; task.pPinGradY && i < n; ++i)
+			task.pPinGradY[begin+i] *= weight;
+		total += weight*wl;
+	}
+	return total;
+}
+
+template <typename CoordinateType>
+void Wirelength<CoordinateType>::moved_bound(uint32_t net, move_type const* vMove, uint32_t num_moves, bound_type& bx, bound_type& by) const
+{
+	bx = m_vBoundX[net];
+	by = m_vBoundY[net];
+	// extremes of moved pins at new positions
+	uint32_t num_moved = 0;
+	bound_type mx, my;
+	for (uint32_t k = 0; k < num_moves; ++k)
+	{
+		uint32_t c = vMove[k].cell;
+		std::vector<uint32_t>::const_iterator first = m_vCellPinNet.begin()+m_vCellPinBegin[c];
+		std::vector<uint32_t>::const_iterator last = m_vCellPinNet.begin()+m_vCellPinBegin[c+1];
+		for (std::vector<uint32_t>::const_iterator it = std::lower_bound(first, last, net); it != last && *it == net; ++it)
+		{
+			uint32_t p = m_vCellPin[it-m_vCellPinNet.begin()];
+			coordinate_type ox = m_vX[c]+m_vPinOffsetX[p];
+			coordinate_type oy = m_vY[c]+m_vPinOffsetY[p];
+			coordinate_type nx = vMove[k].x+m_vPinOffsetX[p];
+			coordinate_type ny = vMove[k].y+m_vPinOffsetY[p];
+			bx.count_lo -= (ox == bx.lo);
+			bx.count_hi -= (ox == bx.hi);
+			by.count_lo -= (oy == by.lo);
+			by.count_hi -= (oy == by.hi);
+			if (num_moved++ == 0)
+			{
+				mx.lo = mx.hi = nx;
+				my.lo = my.hi = ny;
+				mx.count_lo = mx.count_hi = my.count_lo = my.count_hi = 1;
+				continue;
+			}
+			if (nx < mx.lo) {mx.lo = nx; mx.count_lo = 1;}
+			else if (nx == mx.lo) ++mx.count_lo;
+			if (nx > mx.hi) {mx.hi = nx; mx.count_hi = 1;}
+			else if (nx == mx.hi) ++mx.count_hi;
+			if (ny < my.lo) {my.lo = ny; my.count_lo = 1;}
+			else if (ny == my.lo) ++my.count_lo;
+			if (ny > my.hi) {my.hi = ny; my.count_hi = 1;}
+			else if (ny == my.hi) ++my.count_hi;
+		}
+	}
+	if (num_moved == 0)
+		return;
+	// merge moved pins into the remaining sides, a side left by all its pins without a moved pin beyond it is unknown
+	bool known = true;
+	bound_type* vBound[2] = {&bx, &by};
+	bound_type* vMoved[2] = {&mx, &my};
+	for (uint32_t d = 0; d < 2; ++d)
+	{
+		bound_type& b = *vBound[d];
+		bound_type const& m = *vMoved[d];
+		if (m.lo < b.lo || (b.count_lo == 0 && m.lo == b.lo)) {b.lo = m.lo; b.count_lo = m.count_lo;}
+		else if (m.lo == b.lo) b.count_lo += m.count_lo;
+		else if (b.count_lo == 0) known = false;
+		if (m.hi > b.hi || (b.count_hi == 0 && m.hi == b.hi)) {b.hi = m.hi; b.count_hi = m.count_hi;}
+		else if (m.hi == b.hi) b.count_hi += m.count_hi;
+		else if (b.count_hi == 0) known = false;
+	}
+	if (known)
+		return;
+	// scan the net with new positions
+	uint32_t begin = m_vNetPinBegin[net];
+	uint32_t n = m_vNetPinBegin[net+1]-begin;
+	std::vector<coordinate_type> vPinX (n);
+	std::vector<coordinate_type> vPinY (n);
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		uint32_t c = m_vPinCell[begin+i];
+		coordinate_type x = m_vX[c];
+		coordinate_type y = m_vY[c];
+		for (uint32_t k = 0; k < num_moves; ++k)
+		{
+			if (vMove[k].cell == c)
+			{
+				x = vMove[k].x;
+				y = vMove[k].y;
+			}
+		}
+		vPinX[i] = x+m_vPinOffsetX[begin+i];
+		vPinY[i] = y+m_vPinOffsetY[begin+i];
+	}
+	compute_bound(&vPinX[0], n, bx);
+	compute_bound(&vPinY[0], n, by);
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::delta(move_type const* vMove, uint32_t num_moves, std::vector<std::pair<uint32_t, bound_type> >* vBoundX,
+		std::vector<std::pair<uint32_t, bound_type> >* vBoundY) const
+{
+	limboAssertMsg(m_vX.size() == m_num_cells, "init() is not called");
+	double d = 0;
+	for (uint32_t k = 0; k < num_moves; ++k)
+	{
+		uint32_t c = vMove[k].cell;
+		for (uint32_t i = m_vCellPinBegin[c]; i < m_vCellPinBegin[c+1]; ++i)
+		{
+			uint32_t net = m_vCellPinNet[i];
+			// pins of a cell are ordered by nets, and a net shared with an earlier move is already visited
+			if ((i > m_vCellPinBegin[c] && m_vCellPinNet[i-1] == net) || this->has_net(vMove, k, net))
+				continue;
+			bound_type bx, by;
+			this->moved_bound(net, vMove, num_moves, bx, by);
+			bound_type const& ox = m_vBoundX[net];
+			bound_type const& oy = m_vBoundY[net];
+			d += m_vNetWeight[net]*(((bx.hi-bx.lo)+(by.hi-by.lo))-((ox.hi-ox.lo)+(oy.hi-oy.lo)));
+			if (vBoundX)
+				vBoundX->push_back(std::make_pair(net, bx));
+			if (vBoundY)
+				vBoundY->push_back(std::make_pair(net, by));
+		}
+	}
+	return d;
+}
+
+template <typename CoordinateType>
+double Wirelength<CoordinateType>::apply(move_type const* vMove, uint32_t num_moves)
+{
+	std::vector<std::pair<uint32_t, bound_type> > vBoundX;
+	std::vector<std::pair<uint32_t, bound_type> > vBoundY;
+	double d = this->delta(vMove, num_moves, &vBoundX, &vBoundY);
+	for (uint32_t i = 0; i < vBoundX.size(); ++i)
+	{
+		m_vBoundX[vBoundX[i].first] = vBoundX[i].second;
+		m_vBoundY[vBoundY[i].first] = vBoundY[i].second;
+	}
+	for (uint32_t k = 0; k < num_moves; ++k)
+	{
+		m_vX[vMove[k].cell] = vMove[k].x;
+		m_vY[vMove[k].cell] = vMove[k].y;
+	}
+	m_total += d;
+	return d;
+}
+
+} // namespace placement
+} // namespace algorithms
+} // namespace limbo
+
+#endif
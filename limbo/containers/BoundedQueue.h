@@ -0,0 +1,171 @@
+/**
+ * @file   BoundedQueue.h
+ * @brief  a bounded lock-free queue for multiple producers and consumers
+ *
+ * The queue is a ring of cells, each with a sequence number telling whether the cell is ready for
+ * the next push or the next pop at its position, as described by D. Vyukov.
+ * Producers and consumers claim positions with compare-and-swap on two counters,
+ * so threads of a pipeline pass elements without locks, and a full or empty queue is reported instead of blocking.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_CONTAINERS_BOUNDEDQUEUE_H
+#define LIMBO_CONTAINERS_BOUNDEDQUEUE_H
+
+#include <cstddef>
+#include <vector>
+#include <sched.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Containers
+namespace containers
+{
+
+/// @class limbo::containers::BoundedQueue
+/// @brief a bounded first-in first-out queue, safe for any number of threads pushing and popping
+///
+/// Elements must be default constructible and assignable, as cells are constructed with the queue.
+/// @tparam T type of elements
+template <typename T>
+class BoundedQueue
+{
+    public:
+        /// @nowarn
+        typedef T value_type;
+        typedef std::size_t size_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param capacity maximum number of elements, rounded up to a power of two
+        explicit BoundedQueue(size_type capacity = 1024)
+            : m_pushPos(0)
+            , m_popPos(0)
+        {
+            size_type n = 2;
+            while (n < capacity)
+                n *= 2;
+            m_mask = n-1;
+            m_vCell.resize(n);
+            for (size_type i = 0; i < n; ++i)
+                m_vCell[i].sequence = i;
+        }
+
+        /// @return maximum number of elements
+        size_type capacity() const {return m_mask+1;}
+        /// @brief push an element without blocking
+        /// @param v element
+        /// @return false if the queue is full
+        bool try_push(value_type const& v)
+        {
+            size_type pos = load(m_pushPos);
+            Cell* cell;
+            while (true)
+            {
+                cell = &m_vCell[pos&m_mask];
+                std::ptrdiff_t diff = (std::ptrdiff_t)load(cell->sequence) - (std::ptrdiff_t)pos;
+                if (diff == 0)
+                {
+                    if (__sync_bool_compare_and_swap(&m_pushPos, pos, pos+1))
+                        break;
+                    pos = load(m_pushPos);
+                }
+                else if (diff < 0) // the cell still holds an element from the previous round
+                    return false;
+                else // another producer took the position
+                    pos = load(m_pushPos);
+            }
+            cell->value = v;
+            store(cell->sequence, pos+1);
+            return true;
+        }
+        /// @brief pop an element without blocking
+        /// @param v element as output
+        /// @return false if the queue is empty
+        bool try_pop(value_type& v)
+        {
+            size_type pos = load(m_popPos);
+            Cell* cell;
+            while (true)
+            {
+                cell = &m_vCell[pos&m_mask];
+                std::ptrdiff_t diff = (std::ptrdiff_t)load(cell->sequence) - (std::ptrdiff_t)(pos+1);
+                if (diff == 0)
+                {
+                    if (__sync_bool_compare_and_swap(&m_popPos, pos, pos+1))
+                        break;
+                    pos = load(m_popPos);
+                }
+                else if (diff < 0) // no element pushed at the position yet
+                    return false;
+                else // another consumer took the position
+                    pos = load(m_popPos);
+            }
+            v = cell->value;
+            // ready for the push one round later
+            store(cell->sequence, pos+m_mask+1);
+            return true;
+        }
+        /// @brief push an element, yielding while the queue is full
+        /// @param v element
+        void push(value_type const& v)
+        {
+            while (!this->try_push(v))
+                sched_yield();
+        }
+        /// @brief pop an element, yielding while the queue is empty
+        /// @param v element as output
+        void pop(value_type& v)
+        {
+            while (!this->try_pop(v))
+                sched_yield();
+        }
+        /// @return number of elements, only a snapshot when other threads push or pop
+        size_type size_approx() const
+        {
+            size_type push = load(m_pushPos);
+            size_type pop = load(m_popPos);
+            return (push > pop)? push-pop : 0;
+        }
+    protected:
+        /// @brief a cell of the ring
+        struct Cell
+        {
+            size_type sequence; ///< pos when ready to push at pos, pos+1 when ready to pop at pos
+            value_type value; ///< element
+        };
+
+        /// @return value read after all earlier writes of other threads are visible
+        static size_type load(size_type const& v)
+        {
+            size_type r = *(size_type const volatile*)&v;
+            __sync_synchronize();
+            return r;
+        }
+        /// @brief write a value after all earlier writes of this thread
+        static void store(size_type& v, size_type r)
+        {
+            __sync_synchronize();
+            *(size_type volatile*)&v = r;
+        }
+
+        /// copy is not allowed
+        BoundedQueue(BoundedQueue const&);
+        /// assignment is not allowed
+        BoundedQueue& operator=(BoundedQueue const&);
+
+        std::vector<Cell> m_vCell; ///< ring of cells
+        size_type m_mask; ///< capacity minus 1
+        char m_pad0[64]; ///< keep the counters on separate cache lines
+        size_type m_pushPos; ///< next position to push
+        char m_pad1[64]; ///< keep the counters on separate cache lines
+        size_type m_popPos; ///< next position to pop
+        char m_pad2[64]; ///< keep the counters on separate cache lines
+};
+
+} // namespace containers
+} // namespace limbo
+
+#endif
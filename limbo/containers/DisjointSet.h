@@ -5,6 +5,7 @@
  * Please refer to [GeeksforGeeks implementation](http://www.geeksforgeeks.org/union-find-algorithm-set-2-union-by-rank/)
  * and Boost.DisjointSets for details
  * the union_set() and find_set() function can be used independently 
+ * @ref limbo::containers::ConcurrentDisjointSet supports unions from many threads without locks 
  *
  * @author Yibo Lin
  * @date   Sep 2015
@@ -15,6 +16,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <limbo/containers/TaskPool.h>
 
 /// namespace for Limbo
 namespace limbo 
@@ -28,6 +30,8 @@ namespace containers
 struct DisjointSet 
 {
     /// @brief find the subset of an element e 
+    ///
+    /// Parents are walked iteratively, so long chains do not overflow the stack. 
     /// @tparam SubsetHelperType subset helper that wraps elements and ranks 
     /// @param gp a function object to get parent of an element
     /// @param e current element 
@@ -35,21 +39,45 @@ struct DisjointSet
     template <typename SubsetHelperType>
     static typename SubsetHelperType::element_type const& find_set(SubsetHelperType const& gp, typename SubsetHelperType::element_type const& e)
     {
-        if (gp.get_parent(e) == e) // if e is its own parent, it reaches to the top set 
-            return e;
-        return find_set(gp, gp.get_parent(e));
+        typename SubsetHelperType::element_type const* pe = &e; 
+        while (gp.get_parent(*pe) != *pe) // if e is its own parent, it reaches to the top set 
+            pe = &gp.get_parent(*pe); 
+        return *pe; 
+    }
+
+    /// @brief find the subset of an element e and compress the path by halving, 
+    /// i.e., every other element on the path is linked to its grandparent 
+    /// @tparam SubsetHelperType subset helper that wraps elements and ranks 
+    /// @param gp a mutable function object to get and set parent of an element
+    /// @param e current element 
+    /// @return subset of element \a e 
+    template <typename SubsetHelperType>
+    static typename SubsetHelperType::element_type find_set_compress(SubsetHelperType& gp, typename SubsetHelperType::element_type e)
+    {
+        while (gp.get_parent(e) != e)
+        {
+            typename SubsetHelperType::element_type grandparent = gp.get_parent(gp.get_parent(e)); 
+            gp.set_parent(e, grandparent); 
+            e = grandparent; 
+        }
+        return e; 
     }
 
     /// @brief union two subsets represented by element e1 and e2 
+    ///
+    /// Paths to the roots are compressed with @ref find_set_compress. 
     /// @tparam SubsetHelperType subset helper that wraps elements and ranks 
     /// @param gp a mutable function object to get and set parent of an element 
     /// @param e1 first element 
     /// @param e2 second element, after union_set() operation, e2 will become e1's parent 
+    /// @return true if two subsets are different and merged 
     template <typename SubsetHelperType>
-    static void union_set(SubsetHelperType& gp, typename SubsetHelperType::element_type const& e1, typename SubsetHelperType::element_type const& e2)
+    static bool union_set(SubsetHelperType& gp, typename SubsetHelperType::element_type const& e1, typename SubsetHelperType::element_type const& e2)
     {
-        typename SubsetHelperType::element_type const& root1 = find_set(gp, e1);
-        typename SubsetHelperType::element_type const& root2 = find_set(gp, e2);
+        typename SubsetHelperType::element_type root1 = find_set_compress(gp, e1);
+        typename SubsetHelperType::element_type root2 = find_set_compress(gp, e2);
+        if (root1 == root2) // already in the same subset 
+            return false; 
         // set parent 
         if (gp.get_rank(root1) < gp.get_rank(root2))
             gp.set_parent(root1, root2);
@@ -60,6 +88,23 @@ struct DisjointSet
             gp.set_parent(root2, root1);
             gp.set_rank(root1, gp.get_rank(root1)+1);
         }
+        return true; 
+    }
+
+    /// @brief union subsets of both elements of each edge 
+    /// @tparam SubsetHelperType subset helper that wraps elements and ranks 
+    /// @tparam EdgeIterator iterator of edges, each edge is a pair of elements like std::pair 
+    /// @param gp a mutable function object to get and set parent of an element 
+    /// @param first begin iterator of edges 
+    /// @param last end iterator of edges 
+    /// @return number of merges, i.e., decrease of the number of subsets 
+    template <typename SubsetHelperType, typename EdgeIterator>
+    static std::size_t union_sets(SubsetHelperType& gp, EdgeIterator first, EdgeIterator last)
+    {
+        std::size_t count = 0; 
+        for (; first != last; ++first)
+            count += union_set(gp, first->first, first->second); 
+        return count; 
     }
 
     /// count the number of subsets 
@@ -123,6 +168,137 @@ struct DisjointSet
     };
 };
 
+/// @class limbo::containers::ConcurrentDisjointSet 
+/// @brief a lock-free disjoint set of integer elements 0, 1, ..., n-1 for unions from many threads 
+///
+/// Following R.J. Anderson and H. Woll, Wait-free Parallel Algorithms for the Union-Find Problem, STOC 1991, 
+/// a root is linked to another root by compare-and-swap of its parent, and finds halve paths with compare-and-swap as well. 
+/// A root is always linked to a smaller root, so there is no cycle, 
+/// and after all unions the subset of an element is the smallest element of the subset, 
+/// which does not depend on the order of unions or the number of threads. 
+/// @tparam ElementType integer type of elements 
+template <typename ElementType>
+class ConcurrentDisjointSet
+{
+    public:
+        /// @nowarn 
+        typedef ElementType element_type;
+        /// @endnowarn
+
+        /// @brief constructor 
+        /// @param n number of elements, each in its own subset 
+        explicit ConcurrentDisjointSet(std::size_t n = 0) {this->reset(n);}
+        /// @brief put each of n elements into its own subset 
+        /// @param n number of elements 
+        void reset(std::size_t n)
+        {
+            m_vParent.resize(n);
+            for (std::size_t i = 0; i < n; ++i)
+                m_vParent[i] = i;
+        }
+        /// @return number of elements 
+        std::size_t size() const {return m_vParent.size();}
+
+        /// @brief find the subset of an element, safe to call during unions of other threads 
+        /// @param e element 
+        /// @return subset of element \a e, the smallest element of the subset once unions finish 
+        element_type find_set(element_type e)
+        {
+            while (true)
+            {
+                element_type p = this->parent(e);
+                if (p == e)
+                    return e;
+                element_type grandparent = this->parent(p);
+                // path halving, it fails harmlessly if another thread has changed the parent 
+                if (p != grandparent)
+                    __sync_bool_compare_and_swap(&m_vParent[e], p, grandparent);
+                e = grandparent;
+            }
+        }
+        /// @brief union subsets of two elements, safe to call from many threads 
+        /// @param e1 first element 
+        /// @param e2 second element 
+        /// @return true if this call merged two different subsets 
+        bool union_set(element_type e1, element_type e2)
+        {
+            while (true)
+            {
+                e1 = this->find_set(e1);
+                e2 = this->find_set(e2);
+                if (e1 == e2)
+                    return false;
+                if (e1 < e2)
+                    std::swap(e1, e2);
+                // link the larger root to the smaller one, retry if e1 is no longer a root 
+                if (__sync_bool_compare_and_swap(&m_vParent[e1], e1, e2))
+                    return true;
+            }
+        }
+        /// @brief union subsets of both elements of each edge with threads 
+        /// @tparam EdgeIterator random access iterator of edges, each edge is a pair of elements like std::pair 
+        /// @param first begin iterator of edges 
+        /// @param last end iterator of edges 
+        /// @param num_threads number of threads 
+        /// @return number of merges, i.e., decrease of the number of subsets 
+        template <typename EdgeIterator>
+        std::size_t union_sets(EdgeIterator first, EdgeIterator last, unsigned int num_threads = 1)
+        {
+            task_type<EdgeIterator> task;
+            task.pSet = this;
+            task.first = first;
+            task.num_merges = 0;
+            unsigned int numThreads = std::min(limbo::containers::num_threads(), std::max(num_threads, 1U));
+            limbo::containers::parallel_for(0, last-first, 4096, numThreads, task);
+            return task.num_merges;
+        }
+        /// @brief subset of every element, i.e., the smallest element of its subset; not safe during unions 
+        /// @param vSet subset of each element as output 
+        /// @return number of subsets 
+        std::size_t get_sets(std::vector<element_type>& vSet) const
+        {
+            vSet.resize(m_vParent.size());
+            std::size_t count = 0;
+            // parents are smaller than children, so parents are resolved first 
+            for (std::size_t i = 0; i < m_vParent.size(); ++i)
+            {
+                vSet[i] = (m_vParent[i] == (element_type)i)? (element_type)i : vSet[m_vParent[i]];
+                count += (vSet[i] == (element_type)i);
+            }
+            return count;
+        }
+        /// @return number of subsets; not safe during unions 
+        std::size_t count_sets() const
+        {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < m_vParent.size(); ++i)
+                count += (m_vParent[i] == (element_type)i);
+            return count;
+        }
+    protected:
+        /// @brief edges shared by threads, united in chunks 
+        template <typename EdgeIterator>
+        struct task_type
+        {
+            ConcurrentDisjointSet* pSet; ///< disjoint set 
+            EdgeIterator first; ///< begin iterator of edges 
+            mutable std::size_t num_merges; ///< number of merges, added atomically 
+
+            /// @brief union subsets of both elements of edges [b, e) 
+            void operator()(std::size_t b, std::size_t e) const
+            {
+                std::size_t count = 0;
+                for (EdgeIterator it = first+b, ite = first+e; it != ite; ++it)
+                    count += pSet->union_set(it->first, it->second);
+                __sync_fetch_and_add(&num_merges, count);
+            }
+        };
+        /// @return parent of an element, read again from memory on every call 
+        element_type parent(element_type e) const {return *(volatile element_type const*)&m_vParent[e];}
+
+        std::vector<element_type> m_vParent; ///< parent of each element 
+};
+
 }} // namespace limbo // namespace containers
 
 #endif
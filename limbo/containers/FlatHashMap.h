@@ -0,0 +1,277 @@
+/**
+ * @file   FlatHashMap.h
+ * @brief  a hash map with open addressing in flat arrays
+ *
+ * Node-based maps such as std::map and boost::unordered_map allocate a node for every entry,
+ * so lookups chase pointers across the heap.
+ * This map keeps entries in one array probed linearly, with a control byte per slot
+ * holding 7 bits of the hash, so most probes of other keys are rejected without touching the entries.
+ * Erasure shifts following entries back instead of leaving tombstones, so probe sequences stay short.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_CONTAINERS_FLATHASHMAP_H
+#define LIMBO_CONTAINERS_FLATHASHMAP_H
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <boost/functional/hash.hpp>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Containers
+namespace containers
+{
+
+/// @class limbo::containers::FlatHashMap
+/// @brief hash map with linear probing in a power-of-two array of entries
+///
+/// Keys and values must be default constructible and assignable, as slots are constructed with the array.
+/// Iterators and references are invalidated by insertion and erasure.
+/// @tparam KeyType type of keys
+/// @tparam MappedType type of values
+/// @tparam Hash hash function object
+/// @tparam KeyEqual equality function object
+template <typename KeyType,
+         typename MappedType,
+         typename Hash = boost::hash<KeyType>,
+         typename KeyEqual = std::equal_to<KeyType> >
+class FlatHashMap
+{
+    public:
+        /// @nowarn
+        typedef KeyType key_type;
+        typedef MappedType mapped_type;
+        typedef std::pair<KeyType, MappedType> value_type;
+        typedef Hash hasher;
+        typedef KeyEqual key_equal;
+        typedef std::size_t size_type;
+        /// @endnowarn
+
+        /// @brief forward iterator over entries
+        /// @tparam MapType FlatHashMap or const FlatHashMap
+        /// @tparam ValueType value_type or const value_type
+        template <typename MapType, typename ValueType>
+        class iterator_base
+        {
+            public:
+                /// @nowarn
+                typedef std::forward_iterator_tag iterator_category;
+                typedef ValueType value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef ValueType* pointer;
+                typedef ValueType& reference;
+                /// @endnowarn
+
+                /// @brief constructor
+                iterator_base(MapType* m = NULL, size_type i = 0) : m_map(m), m_index(i) {this->skip();}
+                /// @brief conversion from a mutable iterator
+                template <typename M, typename V>
+                iterator_base(iterator_base<M, V> const& rhs) : m_map(rhs.m_map), m_index(rhs.m_index) {}
+                /// @return reference to the entry
+                reference operator*() const {return m_map->m_vSlot[m_index];}
+                /// @return pointer to the entry
+                pointer operator->() const {return &m_map->m_vSlot[m_index];}
+                /// @brief move to the next entry
+                iterator_base& operator++() {++m_index; this->skip(); return *this;}
+                /// @brief move to the next entry
+                iterator_base operator++(int) {iterator_base it (*this); ++*this; return it;}
+                /// @return true if two iterators point to the same slot
+                bool operator==(iterator_base const& rhs) const {return m_index == rhs.m_index;}
+                /// @return true if two iterators point to different slots
+                bool operator!=(iterator_base const& rhs) const {return m_index != rhs.m_index;}
+
+                MapType* m_map; ///< map
+                size_type m_index; ///< slot
+            protected:
+                /// @brief skip empty slots
+                void skip()
+                {
+                    if (m_map)
+                        while (m_index < m_map->m_vCtrl.size() && m_map->m_vCtrl[m_index] == 0)
+                            ++m_index;
+                }
+        };
+        /// @brief mutable iterator
+        typedef iterator_base<FlatHashMap, value_type> iterator;
+        /// @brief constant iterator
+        typedef iterator_base<FlatHashMap const, value_type const> const_iterator;
+
+        /// @brief constructor
+        /// @param n number of entries to reserve
+        /// @param hf hash function object
+        /// @param eq equality function object
+        explicit FlatHashMap(size_type n = 0, hasher const& hf = hasher(), key_equal const& eq = key_equal())
+            : m_hash(hf)
+            , m_equal(eq)
+            , m_size(0)
+        {
+            this->reserve(n);
+        }
+
+        /// @return number of entries
+        size_type size() const {return m_size;}
+        /// @return true if there is no entry
+        bool empty() const {return m_size == 0;}
+        /// @return number of slots
+        size_type bucket_count() const {return m_vCtrl.size();}
+        /// @brief make room for n entries without rehashing
+        /// @param n number of entries
+        void reserve(size_type n)
+        {
+            // load factor at most 3/4
+            size_type capacity = 16;
+            while (capacity*3 < n*4)
+                capacity *= 2;
+            if (capacity > m_vCtrl.size())
+                this->rehash(capacity);
+        }
+        /// @brief remove all entries, keeping memory
+        void clear()
+        {
+            std::fill(m_vCtrl.begin(), m_vCtrl.end(), 0);
+            std::fill(m_vSlot.begin(), m_vSlot.end(), value_type());
+            m_size = 0;
+        }
+
+        /// @return iterator to the first entry
+        iterator begin() {return iterator(this, 0);}
+        /// @return iterator past the last entry
+        iterator end() {return iterator(this, m_vCtrl.size());}
+        /// @return iterator to the first entry
+        const_iterator begin() const {return const_iterator(this, 0);}
+        /// @return iterator past the last entry
+        const_iterator end() const {return const_iterator(this, m_vCtrl.size());}
+
+        /// @brief find a key
+        /// @param key key
+        /// @return iterator to the entry, or end() if not found
+        iterator find(key_type const& key)
+        {
+            size_type i = this->locate(key);
+            return (i == npos())? this->end() : iterator(this, i);
+        }
+        /// @brief find a key
+        /// @param key key
+        /// @return iterator to the entry, or end() if not found
+        const_iterator find(key_type const& key) const
+        {
+            size_type i = this->locate(key);
+            return (i == npos())? this->end() : const_iterator(this, i);
+        }
+        /// @param key key
+        /// @return number of entries of the key, always 0 or 1
+        size_type count(key_type const& key) const {return this->locate(key) != npos();}
+        /// @brief insert an entry if its key is absent
+        /// @param v entry
+        /// @return iterator to the entry of the key, and true if inserted
+        std::pair<iterator, bool> insert(value_type const& v)
+        {
+            if ((m_size+1)*4 > m_vCtrl.size()*3)
+                this->rehash(std::max(m_vCtrl.size()*2, (size_type)16));
+            std::size_t h = m_hash(v.first);
+            unsigned char c = control(h);
+            size_type mask = m_vCtrl.size()-1;
+            for (size_type i = h&mask; ; i = (i+1)&mask)
+            {
+                if (m_vCtrl[i] == 0)
+                {
+                    m_vCtrl[i] = c;
+                    m_vSlot[i] = v;
+                    ++m_size;
+                    return std::make_pair(iterator(this, i), true);
+                }
+                if (m_vCtrl[i] == c && m_equal(m_vSlot[i].first, v.first))
+                    return std::make_pair(iterator(this, i), false);
+            }
+        }
+        /// @param key key
+        /// @return reference to the value of the key, inserted with a default value if absent
+        mapped_type& operator[](key_type const& key)
+        {
+            return this->insert(value_type(key, mapped_type())).first->second;
+        }
+        /// @brief erase the entry of a key
+        /// @param key key
+        /// @return number of entries erased, always 0 or 1
+        size_type erase(key_type const& key)
+        {
+            size_type i = this->locate(key);
+            if (i == npos())
+                return 0;
+            // backward shift, move each following entry into the hole unless it would move before its home slot
+            size_type mask = m_vCtrl.size()-1;
+            for (size_type j = (i+1)&mask; m_vCtrl[j] != 0; j = (j+1)&mask)
+            {
+                size_type home = m_hash(m_vSlot[j].first)&mask;
+                // the entry at j may move to i if home is not in the cyclic range (i, j]
+                if (((j-home)&mask) >= ((j-i)&mask))
+                {
+                    m_vCtrl[i] = m_vCtrl[j];
+                    m_vSlot[i] = m_vSlot[j];
+                    i = j;
+                }
+            }
+            m_vCtrl[i] = 0;
+            m_vSlot[i] = value_type();
+            --m_size;
+            return 1;
+        }
+    protected:
+        /// @return invalid slot
+        static size_type npos() {return (size_type)-1;}
+        /// @return control byte of a hash, never 0
+        static unsigned char control(std::size_t h) {return (unsigned char)(0x80 | ((h >> (sizeof(std::size_t)*8-7)) & 0x7f));}
+        /// @return slot of a key, npos() if not found
+        size_type locate(key_type const& key) const
+        {
+            if (m_size == 0)
+                return npos();
+            std::size_t h = m_hash(key);
+            unsigned char c = control(h);
+            size_type mask = m_vCtrl.size()-1;
+            for (size_type i = h&mask; m_vCtrl[i] != 0; i = (i+1)&mask)
+                if (m_vCtrl[i] == c && m_equal(m_vSlot[i].first, key))
+                    return i;
+            return npos();
+        }
+        /// @brief move entries to a new array of slots
+        /// @param capacity number of slots, a power of two
+        void rehash(size_type capacity)
+        {
+            std::vector<unsigned char> vCtrl (capacity, 0);
+            std::vector<value_type> vSlot (capacity);
+            vCtrl.swap(m_vCtrl);
+            vSlot.swap(m_vSlot);
+            m_size = 0;
+            size_type mask = capacity-1;
+            for (size_type j = 0; j < vCtrl.size(); ++j)
+            {
+                if (vCtrl[j] == 0)
+                    continue;
+                size_type i = m_hash(vSlot[j].first)&mask;
+                while (m_vCtrl[i] != 0)
+                    i = (i+1)&mask;
+                m_vCtrl[i] = vCtrl[j];
+                m_vSlot[i] = vSlot[j];
+                ++m_size;
+            }
+        }
+
+        hasher m_hash; ///< hash function object
+        key_equal m_equal; ///< equality function object
+        std::vector<unsigned char> m_vCtrl; ///< 0 for an empty slot, otherwise 0x80 and 7 high bits of the hash
+        std::vector<value_type> m_vSlot; ///< entries
+        size_type m_size; ///< number of entries
+};
+
+} // namespace containers
+} // namespace limbo
+
+#endif
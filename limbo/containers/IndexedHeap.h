@@ -0,0 +1,347 @@
+/**
+ * @file   IndexedHeap.h
+ * @brief  priority queues in contiguous storage with updates of priorities by key
+ *
+ * @ref limbo::containers::FastMultiSet keeps keys in a std::multiset and a std::map,
+ * so every update takes two tree operations with node allocations.
+ * The queues here keep keys in arrays and find the position of a key from its index,
+ * so an update is a sift in the heap, or an unlink and a link for buckets, without allocation.
+ * - @ref limbo::containers::DaryHeap is a d-ary heap for any comparison, with the subset of the FastMultiSet API
+ *   used for priority structures: insert, erase, update, count, plus top and pop for the first key.
+ * - @ref limbo::containers::BucketQueue is a bucket queue for integer priorities in a bounded range, such as gains of FM partitioning,
+ *   with O(1) insert, erase and update.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_CONTAINERS_INDEXEDHEAP_H
+#define LIMBO_CONTAINERS_INDEXEDHEAP_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <cassert>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Containers
+namespace containers
+{
+
+/// @brief index of an integer key, i.e., the key itself
+/// @tparam KeyType integer type
+template <typename KeyType>
+struct identity_index
+{
+    /// @return index of a key
+    std::size_t operator()(KeyType const& key) const {return key;}
+};
+
+/// @class limbo::containers::DaryHeap
+/// @brief a d-ary heap of keys, where the position of each key is found from its index
+///
+/// Like @ref limbo::containers::FastMultiSet, keys can be pointers and the data they point to can change,
+/// as long as @ref update is called for the changed key.
+/// Keys must have distinct indices, which are expected to be small integers such as ids of cells or nets,
+/// as positions are stored in an array indexed by them.
+/// The first key in the order of Compare is on the top, the same as the begin of @ref limbo::containers::FastMultiSet.
+/// Keys with equal priorities come out in no specific order.
+/// @tparam KeyType type of keys, also the type of values in the heap
+/// @tparam Compare compare type of keys
+/// @tparam KeyIndex function object mapping a key to its index
+/// @tparam D number of children of a node, 4 keeps a node and its children in one cache line for small keys
+template <typename KeyType,
+         typename Compare = std::less<KeyType>,
+         typename KeyIndex = identity_index<KeyType>,
+         unsigned int D = 4>
+class DaryHeap
+{
+    public:
+        /// @nowarn
+        typedef KeyType key_type;
+        typedef KeyType value_type;
+        typedef Compare key_compare;
+        typedef KeyIndex key_index;
+        typedef std::size_t size_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param comp compare function object
+        /// @param index function object mapping a key to its index
+        explicit DaryHeap(key_compare const& comp = key_compare(), key_index const& index = key_index())
+            : m_comp(comp)
+            , m_index(index)
+        {
+        }
+
+        /// @brief reserve memory
+        /// @param n number of keys
+        /// @param max_index maximum index of keys plus 1
+        void reserve(size_type n, size_type max_index)
+        {
+            m_vKey.reserve(n);
+            if (m_vPos.size() < max_index)
+                m_vPos.resize(max_index, npos());
+        }
+        /// @brief insert a key, which must not be in the heap
+        /// @param key key to insert
+        void insert(key_type const& key)
+        {
+            size_type idx = m_index(key);
+            if (idx >= m_vPos.size())
+                m_vPos.resize(idx+1, npos());
+            assert(m_vPos[idx] == npos());
+            m_vKey.push_back(key);
+            m_vPos[idx] = m_vKey.size()-1;
+            this->sift_up(m_vKey.size()-1);
+        }
+        /// @brief erase a key
+        /// @param key key to erase
+        /// @return number of keys erased, always 0 or 1
+        size_type erase(key_type const& key)
+        {
+            size_type pos = this->position(key);
+            if (pos == npos())
+                return 0;
+            this->remove(pos);
+            return 1;
+        }
+        /// @brief restore the order after the priority of a key changes, either increase or decrease
+        /// @param key updated key, it must have the same index
+        /// @return true if the key is in the heap
+        bool update(key_type const& key)
+        {
+            size_type pos = this->position(key);
+            if (pos == npos())
+                return false;
+            m_vKey[pos] = key;
+            if (!this->sift_up(pos))
+                this->sift_down(pos);
+            return true;
+        }
+        /// @param key key
+        /// @return number of keys with the same index, always 0 or 1
+        size_type count(key_type const& key) const {return this->position(key) != npos();}
+        /// @return the first key
+        key_type const& top() const {return m_vKey.front();}
+        /// @brief remove the first key
+        void pop() {this->remove(0);}
+        /// @return number of keys
+        size_type size() const {return m_vKey.size();}
+        /// @return true if there is no key
+        bool empty() const {return m_vKey.empty();}
+        /// @brief remove all keys, keeping memory
+        void clear()
+        {
+            for (typename std::vector<key_type>::const_iterator it = m_vKey.begin(); it != m_vKey.end(); ++it)
+                m_vPos[m_index(*it)] = npos();
+            m_vKey.clear();
+        }
+    protected:
+        /// @return position of no key
+        static size_type npos() {return std::numeric_limits<size_type>::max();}
+        /// @return position of a key in the heap, npos() if not found
+        size_type position(key_type const& key) const
+        {
+            size_type idx = m_index(key);
+            return (idx < m_vPos.size())? m_vPos[idx] : npos();
+        }
+        /// @brief remove the key at a position
+        /// @param pos position
+        void remove(size_type pos)
+        {
+            m_vPos[m_index(m_vKey[pos])] = npos();
+            if (pos+1 != m_vKey.size())
+            {
+                m_vKey[pos] = m_vKey.back();
+                m_vPos[m_index(m_vKey[pos])] = pos;
+                m_vKey.pop_back();
+                if (!this->sift_up(pos))
+                    this->sift_down(pos);
+            }
+            else
+                m_vKey.pop_back();
+        }
+        /// @brief move a key up until its parent is not after it
+        /// @param pos position of the key
+        /// @return true if the key moved
+        bool sift_up(size_type pos)
+        {
+            key_type key = m_vKey[pos];
+            size_type start = pos;
+            while (pos > 0)
+            {
+                size_type parent = (pos-1)/D;
+                if (!m_comp(key, m_vKey[parent]))
+                    break;
+                m_vKey[pos] = m_vKey[parent];
+                m_vPos[m_index(m_vKey[pos])] = pos;
+                pos = parent;
+            }
+            m_vKey[pos] = key;
+            m_vPos[m_index(key)] = pos;
+            return pos != start;
+        }
+        /// @brief move a key down until no child is before it
+        /// @param pos position of the key
+        void sift_down(size_type pos)
+        {
+            key_type key = m_vKey[pos];
+            size_type n = m_vKey.size();
+            while (true)
+            {
+                size_type first = pos*D+1;
+                if (first >= n)
+                    break;
+                // the first child
+                size_type best = first;
+                for (size_type c = first+1, ce = std::min(first+D, n); c < ce; ++c)
+                    if (m_comp(m_vKey[c], m_vKey[best]))
+                        best = c;
+                if (!m_comp(m_vKey[best], key))
+                    break;
+                m_vKey[pos] = m_vKey[best];
+                m_vPos[m_index(m_vKey[pos])] = pos;
+                pos = best;
+            }
+            m_vKey[pos] = key;
+            m_vPos[m_index(key)] = pos;
+        }
+
+        key_compare m_comp; ///< compare function object
+        key_index m_index; ///< index function object
+        std::vector<key_type> m_vKey; ///< keys in heap order
+        std::vector<size_type> m_vPos; ///< position of each index in the heap, npos() if absent
+};
+
+/// @class limbo::containers::BucketQueue
+/// @brief a bucket queue of elements 0, 1, ..., n-1 with integer priorities in [min_priority, max_priority]
+///
+/// Each priority has a doubly linked list of elements, stored in arrays indexed by elements,
+/// so insert, erase and update take O(1) time.
+/// The top is an element of the lowest priority, found by a cursor that only moves up between inserts,
+/// and the element inserted last comes first among equal priorities.
+/// For the highest gain of FM partitioning, insert negated gains.
+/// @tparam PriorityType integer type of priorities
+template <typename PriorityType>
+class BucketQueue
+{
+    public:
+        /// @nowarn
+        typedef PriorityType priority_type;
+        typedef std::size_t size_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param n number of elements
+        /// @param min_priority minimum priority
+        /// @param max_priority maximum priority
+        BucketQueue(size_type n = 0, priority_type min_priority = 0, priority_type max_priority = 0)
+        {
+            this->reset(n, min_priority, max_priority);
+        }
+        /// @brief remove all elements and set the range of elements and priorities, keeping memory
+        /// @param n number of elements
+        /// @param min_priority minimum priority
+        /// @param max_priority maximum priority
+        void reset(size_type n, priority_type min_priority, priority_type max_priority)
+        {
+            assert(min_priority <= max_priority);
+            m_min_priority = min_priority;
+            m_vHead.assign(max_priority-min_priority+1, npos());
+            m_vNext.assign(n, npos());
+            m_vPrev.assign(n, npos());
+            m_vPriority.assign(n, min_priority);
+            m_vIn.assign(n, false);
+            m_cursor = m_vHead.size();
+            m_size = 0;
+        }
+        /// @brief insert an element, which must not be in the queue
+        /// @param e element
+        /// @param p priority in [min_priority, max_priority]
+        void insert(size_type e, priority_type p)
+        {
+            assert(!m_vIn[e]);
+            size_type b = p-m_min_priority;
+            assert(b < m_vHead.size());
+            m_vPriority[e] = p;
+            m_vIn[e] = true;
+            m_vPrev[e] = npos();
+            m_vNext[e] = m_vHead[b];
+            if (m_vHead[b] != npos())
+                m_vPrev[m_vHead[b]] = e;
+            m_vHead[b] = e;
+            if (b < m_cursor)
+                m_cursor = b;
+            ++m_size;
+        }
+        /// @brief erase an element
+        /// @param e element
+        /// @return number of elements erased, always 0 or 1
+        size_type erase(size_type e)
+        {
+            if (!m_vIn[e])
+                return 0;
+            if (m_vPrev[e] != npos())
+                m_vNext[m_vPrev[e]] = m_vNext[e];
+            else
+                m_vHead[m_vPriority[e]-m_min_priority] = m_vNext[e];
+            if (m_vNext[e] != npos())
+                m_vPrev[m_vNext[e]] = m_vPrev[e];
+            m_vIn[e] = false;
+            --m_size;
+            return 1;
+        }
+        /// @brief change the priority of an element
+        /// @param e element
+        /// @param p new priority
+        /// @return true if the element is in the queue
+        bool update(size_type e, priority_type p)
+        {
+            if (!this->erase(e))
+                return false;
+            this->insert(e, p);
+            return true;
+        }
+        /// @param e element
+        /// @return number of the element in the queue, always 0 or 1
+        size_type count(size_type e) const {return m_vIn[e];}
+        /// @param e element in the queue
+        /// @return priority of the element
+        priority_type priority(size_type e) const {return m_vPriority[e];}
+        /// @return an element of the lowest priority, the queue must not be empty
+        size_type top()
+        {
+            assert(m_size > 0);
+            while (m_vHead[m_cursor] == npos())
+                ++m_cursor;
+            return m_vHead[m_cursor];
+        }
+        /// @return the lowest priority, the queue must not be empty
+        priority_type top_priority() {return m_vPriority[this->top()];}
+        /// @brief remove the top element
+        void pop() {this->erase(this->top());}
+        /// @return number of elements in the queue
+        size_type size() const {return m_size;}
+        /// @return true if there is no element
+        bool empty() const {return m_size == 0;}
+    protected:
+        /// @return an invalid element
+        static size_type npos() {return std::numeric_limits<size_type>::max();}
+
+        priority_type m_min_priority; ///< minimum priority
+        std::vector<size_type> m_vHead; ///< first element of each bucket
+        std::vector<size_type> m_vNext; ///< next element in the bucket
+        std::vector<size_type> m_vPrev; ///< previous element in the bucket
+        std::vector<priority_type> m_vPriority; ///< priority of each element
+        std::vector<bool> m_vIn; ///< whether each element is in the queue
+        size_type m_cursor; ///< no bucket below it is nonempty
+        size_type m_size; ///< number of elements in the queue
+};
+
+} // namespace containers
+} // namespace limbo
+
+#endif
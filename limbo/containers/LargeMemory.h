@@ -0,0 +1,329 @@
+/**
+ * @file   LargeMemory.h
+ * @brief  allocation of large arrays with huge pages, NUMA placement and SIMD alignment
+ *
+ * Engines keep their bulk data in a few large arrays, e.g., CSR matrices of the solvers,
+ * CSR conflict graphs and point buffers of layouts, which are scanned by all threads of parallel kernels.
+ * By default the kernel places a page on the NUMA node of the thread touching it first,
+ * which is usually the single thread building the array, so kernels on other sockets read remote memory.
+ *
+ * Arrays of at least @ref limbo::containers::LargeMemoryOptions::threshold bytes are mapped directly,
+ * marked for transparent huge pages to save TLB misses on long scans,
+ * and placed according to @ref limbo::containers::LargeMemoryPolicy.
+ * Smaller arrays come from the heap.
+ * All arrays are aligned to @ref limbo::containers::large_memory_alignment bytes for SIMD loads.
+ *
+ * @ref limbo::containers::LargeAllocator makes std::vector use the same memory.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_CONTAINERS_LARGEMEMORY_H
+#define LIMBO_CONTAINERS_LARGEMEMORY_H
+
+#include <new>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#include <limbo/containers/TaskPool.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Containers
+namespace containers
+{
+
+/// @brief alignment of all large memory arrays in bytes, a cache line and the width of AVX-512 registers
+static const std::size_t large_memory_alignment = 64;
+
+/// @brief placement of the pages of large arrays on NUMA nodes
+enum LargeMemoryPolicy
+{
+    LARGE_MEMORY_LOCAL, ///< pages are placed on the node of the thread touching them first, the default of the kernel
+    LARGE_MEMORY_INTERLEAVE, ///< pages are interleaved over all nodes, so kernels pulling blocks dynamically share the bandwidth of all sockets
+    LARGE_MEMORY_FIRST_TOUCH ///< pages are touched at allocation by @ref num_threads threads in contiguous chunks, one chunk per thread
+};
+
+/// @brief options of large memory arrays
+struct LargeMemoryOptions
+{
+    std::size_t threshold; ///< arrays of at least this number of bytes are mapped with the policy, smaller ones come from the heap
+    LargeMemoryPolicy policy; ///< placement of pages on NUMA nodes
+    bool hugePages; ///< whether to mark mapped arrays for transparent huge pages
+
+    /// @brief constructor with the defaults, interleaving arrays of 2 MB or more backed by huge pages
+    LargeMemoryOptions() : threshold(2UL << 20), policy(LARGE_MEMORY_INTERLEAVE), hugePages(true) {}
+};
+
+/// @return options of large memory arrays, not to be changed while engines allocate
+inline LargeMemoryOptions& large_memory_options()
+{
+    static LargeMemoryOptions options;
+    return options;
+}
+
+/// @cond
+/// @brief online NUMA nodes, read once from sysfs
+struct LargeMemoryNodes
+{
+    unsigned long vMask[16]; ///< bit mask of online nodes, up to 1024 nodes
+    unsigned int numNodes; ///< number of online nodes, at least 1
+
+    /// @return the nodes of the machine
+    static LargeMemoryNodes const& get()
+    {
+        static pthread_once_t once = PTHREAD_ONCE_INIT;
+        pthread_once(&once, LargeMemoryNodes::init);
+        return instance();
+    }
+    /// @return the only object
+    static LargeMemoryNodes& instance()
+    {
+        static LargeMemoryNodes nodes;
+        return nodes;
+    }
+    /// @brief parse a list like "0-1,4" of online nodes
+    static void init()
+    {
+        LargeMemoryNodes& nodes = instance();
+        std::memset(nodes.vMask, 0, sizeof(nodes.vMask));
+        nodes.numNodes = 0;
+        char buf[256] = {0};
+        FILE* fp = fopen("/sys/devices/system/node/online", "r");
+        if (fp)
+        {
+            if (fgets(buf, sizeof(buf), fp) == NULL)
+                buf[0] = '\0';
+            fclose(fp);
+        }
+        unsigned int const maxNodes = sizeof(nodes.vMask)*8;
+        for (char* p = buf; *p >= '0' && *p <= '9'; )
+        {
+            unsigned int first = strtoul(p, &p, 10);
+            unsigned int last = first;
+            if (*p == '-')
+                last = strtoul(p+1, &p, 10);
+            for (unsigned int n = first; n <= last && n < maxNodes; ++n)
+            {
+                nodes.vMask[n/(sizeof(unsigned long)*8)] |= 1UL << (n%(sizeof(unsigned long)*8));
+                ++nodes.numNodes;
+            }
+            if (*p == ',')
+                ++p;
+        }
+        if (nodes.numNodes == 0)
+        {
+            nodes.vMask[0] = 1;
+            nodes.numNodes = 1;
+        }
+    }
+};
+
+/// @brief header in front of each large array, padded to keep arrays aligned
+struct LargeMemoryHeader
+{
+    std::size_t bytes; ///< bytes of the whole block including the header, 0 if the block comes from the heap
+    char padding[large_memory_alignment-sizeof(std::size_t)]; ///< padding to the alignment
+};
+
+/// @brief a chunk of a mapped array touched by a thread
+struct LargeMemoryTouch
+{
+    char* begin; ///< first byte
+    char* end; ///< end byte
+};
+
+/// @brief write a byte in each page of a chunk, so the pages are placed on the node of the calling thread
+/// @param arg pointer to @ref LargeMemoryTouch
+/// @return NULL
+inline void* large_memory_touch(void* arg)
+{
+    LargeMemoryTouch const* touch = static_cast<LargeMemoryTouch const*>(arg);
+    long const pageSize = sysconf(_SC_PAGESIZE);
+    for (volatile char* p = touch->begin; p < touch->end; p += pageSize)
+        *p = 0;
+    return NULL;
+}
+/// @endcond
+
+/// @brief touch the pages of a mapped array with threads in contiguous chunks, one chunk per thread,
+/// so a kernel partitioning the array statically among as many threads finds its chunk on its own node
+/// @param p begin of the array
+/// @param bytes number of bytes
+/// @param numThreads number of threads, 0 for @ref num_threads
+inline void large_first_touch(void* p, std::size_t bytes, unsigned int numThreads = 0)
+{
+    if (numThreads == 0)
+        numThreads = num_threads();
+    std::size_t const pageSize = sysconf(_SC_PAGESIZE);
+    std::size_t numPages = (bytes+pageSize-1)/pageSize;
+    numThreads = (unsigned int)std::max(std::min((std::size_t)numThreads, numPages), (std::size_t)1);
+    char* base = static_cast<char*>(p);
+    std::vector<LargeMemoryTouch> vTouch (numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        vTouch[i].begin = base+numPages*i/numThreads*pageSize;
+        vTouch[i].end = std::min(base+numPages*(i+1)/numThreads*pageSize, base+bytes);
+    }
+    std::vector<pthread_t> vThread (numThreads-1);
+    std::vector<bool> vCreated (vThread.size(), false);
+    for (unsigned int i = 0; i < vThread.size(); ++i)
+        vCreated[i] = (pthread_create(&vThread[i], NULL, large_memory_touch, &vTouch[i+1]) == 0);
+    // the current thread takes the first chunk, and the chunks of threads failed to start
+    large_memory_touch(&vTouch[0]);
+    for (unsigned int i = 0; i < vThread.size(); ++i)
+    {
+        if (vCreated[i])
+            pthread_join(vThread[i], NULL);
+        else
+            large_memory_touch(&vTouch[i+1]);
+    }
+}
+
+/// @brief allocate a large array with @ref large_memory_options
+/// @param bytes number of bytes
+/// @return memory aligned to @ref large_memory_alignment, zero-filled if mapped
+/// @throw std::bad_alloc if out of memory
+inline void* large_allocate(std::size_t bytes)
+{
+    LargeMemoryOptions const& options = large_memory_options();
+    std::size_t total = bytes+sizeof(LargeMemoryHeader);
+    if (total < bytes)
+        throw std::bad_alloc();
+    LargeMemoryHeader* header = NULL;
+    if (total < options.threshold)
+    {
+        void* p = NULL;
+        if (posix_memalign(&p, large_memory_alignment, total) != 0)
+            throw std::bad_alloc();
+        header = static_cast<LargeMemoryHeader*>(p);
+        header->bytes = 0;
+        return header+1;
+    }
+    void* p = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    // only a hint, kernels without transparent huge pages keep small pages
+    if (options.hugePages)
+        madvise(p, total, MADV_HUGEPAGE);
+#endif
+    switch (options.policy)
+    {
+        case LARGE_MEMORY_INTERLEAVE:
+#if defined(__linux__) && defined(SYS_mbind)
+            {
+                LargeMemoryNodes const& nodes = LargeMemoryNodes::get();
+                // MPOL_INTERLEAVE of linux/mempolicy.h, called without libnuma; failures leave the local policy
+                if (nodes.numNodes > 1)
+                    syscall(SYS_mbind, p, total, 3, nodes.vMask, sizeof(nodes.vMask)*8+1, 0);
+            }
+#endif
+            break;
+        case LARGE_MEMORY_FIRST_TOUCH:
+            large_first_touch(p, total);
+            break;
+        default:
+            break;
+    }
+    header = static_cast<LargeMemoryHeader*>(p);
+    header->bytes = total;
+    return header+1;
+}
+
+/// @brief free an array from @ref large_allocate
+/// @param p array, NULL is ignored
+inline void large_deallocate(void* p)
+{
+    if (p == NULL)
+        return;
+    LargeMemoryHeader* header = static_cast<LargeMemoryHeader*>(p)-1;
+    if (header->bytes)
+        munmap(header, header->bytes);
+    else
+        free(header);
+}
+
+/// @brief allocate an array of plain data without initialization, like new T [n]
+/// @tparam T plain data type without constructors and destructors
+/// @param n number of elements
+/// @return array
+template <typename T>
+inline T* large_new_array(std::size_t n)
+{
+    if (n > std::numeric_limits<std::size_t>::max()/sizeof(T))
+        throw std::bad_alloc();
+    return static_cast<T*>(large_allocate(n*sizeof(T)));
+}
+
+/// @brief free an array from @ref large_new_array
+/// @tparam T plain data type
+/// @param p array, NULL is ignored
+template <typename T>
+inline void large_delete_array(T* p)
+{
+    large_deallocate(p);
+}
+
+/// @class limbo::containers::LargeAllocator
+/// @brief allocator of std::vector with the memory of @ref large_allocate.
+/// Growing vectors reallocate as usual, so reserve the final size first to map the memory once.
+/// @tparam T value type
+template <typename T>
+class LargeAllocator
+{
+    public:
+        /// @nowarn
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T const* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        template <typename U>
+        struct rebind
+        {
+            typedef LargeAllocator<U> other;
+        };
+        /// @endnowarn
+
+        /// @brief constructor
+        LargeAllocator() {}
+        /// @brief copy constructor from another value type
+        template <typename U>
+        LargeAllocator(LargeAllocator<U> const&) {}
+
+        /// @nowarn
+        pointer address(reference x) const {return &x;}
+        const_pointer address(const_reference x) const {return &x;}
+        pointer allocate(size_type n, void const* = 0) {return (n)? static_cast<pointer>(large_allocate(n*sizeof(T))) : NULL;}
+        void deallocate(pointer p, size_type) {large_deallocate(p);}
+        size_type max_size() const {return std::numeric_limits<size_type>::max()/sizeof(T);}
+        void construct(pointer p, const_reference v) {new (p) T(v);}
+        void destroy(pointer p) {p->~T();}
+        /// @endnowarn
+};
+
+/// @return true as all allocators share the same memory
+template <typename T, typename U>
+inline bool operator==(LargeAllocator<T> const&, LargeAllocator<U> const&) {return true;}
+/// @return false as all allocators share the same memory
+template <typename T, typename U>
+inline bool operator!=(LargeAllocator<T> const&, LargeAllocator<U> const&) {return false;}
+
+} // namespace containers
+} // namespace limbo
+
+#endif
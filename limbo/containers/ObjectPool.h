@@ -0,0 +1,116 @@
+/**
+ * @file   ObjectPool.h
+ * @brief  A monotonic pool of objects allocated in blocks
+ *
+ * Objects are constructed in place in large blocks and destroyed together,
+ * so building and tearing down many small objects costs a few allocations
+ * instead of one new and delete for each object.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_CONTAINERS_OBJECTPOOL_H
+#define LIMBO_CONTAINERS_OBJECTPOOL_H
+
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cassert>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Containers
+namespace containers
+{
+
+/// @class limbo::containers::ObjectPool
+/// @brief Monotonic pool of objects.
+///
+/// Objects never move once constructed, so pointers to them stay valid until they are destroyed.
+/// Only the last object can be destroyed alone, which is enough to roll back a failed insertion,
+/// and the others are destroyed by clear() or the destructor in the reverse order of construction.
+/// @tparam T type of objects
+template <typename T>
+class ObjectPool
+{
+	public:
+		/// @nowarn
+		typedef T value_type;
+		typedef std::size_t size_type;
+		/// @endnowarn
+
+		/// @brief constructor
+		/// @param blockSize number of objects in a block
+		explicit ObjectPool(size_type blockSize = 1024) : m_block_size(blockSize? blockSize : 1), m_size(0) {}
+		/// @brief destructor
+		~ObjectPool() {clear();}
+
+		/// @brief construct a default object
+		/// @return pointer to the object
+		T* construct()
+		{
+			T* p = new (this->allocate()) T();
+			++m_size;
+			return p;
+		}
+		/// @brief construct a copy of an object
+		/// @param v object to copy
+		/// @return pointer to the object
+		T* construct(T const& v)
+		{
+			T* p = new (this->allocate()) T(v);
+			++m_size;
+			return p;
+		}
+		/// @brief destroy the last constructed object
+		void pop_back()
+		{
+			assert(m_size > 0);
+			--m_size;
+			(*this)[m_size].~T();
+		}
+		/// @brief destroy all objects and release memory
+		void clear()
+		{
+			while (m_size)
+				pop_back();
+			for (typename std::vector<T*>::iterator it = m_vBlock.begin(); it != m_vBlock.end(); ++it)
+				::operator delete(*it);
+			m_vBlock.clear();
+		}
+		/// @return number of objects
+		size_type size() const {return m_size;}
+		/// @return true if there is no object
+		bool empty() const {return m_size == 0;}
+		/// @return number of objects the allocated blocks can hold
+		size_type capacity() const {return m_vBlock.size()*m_block_size;}
+		/// @param i index in the order of construction
+		/// @return object
+		T& operator[](size_type i) {return m_vBlock[i/m_block_size][i%m_block_size];}
+		/// @param i index in the order of construction
+		/// @return object
+		T const& operator[](size_type i) const {return m_vBlock[i/m_block_size][i%m_block_size];}
+	protected:
+		/// @return memory for the next object, a new block if the last one is full
+		void* allocate()
+		{
+			if (m_size == m_vBlock.size()*m_block_size)
+				m_vBlock.push_back(static_cast<T*>(::operator new(sizeof(T)*m_block_size)));
+			return m_vBlock[m_size/m_block_size]+m_size%m_block_size;
+		}
+
+		size_type m_block_size; ///< number of objects in a block
+		size_type m_size; ///< number of objects
+		std::vector<T*> m_vBlock; ///< blocks of raw memory
+	private:
+		/// @brief copy is not allowed, objects are referred to by pointers
+		ObjectPool(ObjectPool const&);
+		/// @brief assignment is not allowed, objects are referred to by pointers
+		ObjectPool& operator=(ObjectPool const&);
+};
+
+} // namespace containers
+} // namespace limbo
+
+#endif
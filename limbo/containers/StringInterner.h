@@ -0,0 +1,232 @@
+/**
+ * @file   StringInterner.h
+ * @brief  a thread-safe table of unique strings with dense integer ids
+ *
+ * Parsers and databases map names of cells, nets and layers to indices,
+ * usually with one std::string per name in a node-based map.
+ * The interner copies each distinct string once into large blocks that never move,
+ * keys a @ref limbo::containers::FlatHashMap with views of these copies,
+ * and numbers strings 0, 1, 2, ... in the order of first insertion.
+ * Views returned stay valid as long as the interner.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_CONTAINERS_STRINGINTERNER_H
+#define LIMBO_CONTAINERS_STRINGINTERNER_H
+
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <boost/utility/string_ref.hpp>
+#include <limbo/containers/FlatHashMap.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Containers
+namespace containers
+{
+
+/// @brief FNV-1a hash of a string view
+struct string_ref_hash
+{
+    /// @return hash value
+    std::size_t operator()(boost::string_ref const& s) const
+    {
+        std::size_t h = (sizeof(std::size_t) == 8)? (std::size_t)14695981039346656037ULL : (std::size_t)2166136261UL;
+        std::size_t prime = (sizeof(std::size_t) == 8)? (std::size_t)1099511628211ULL : (std::size_t)16777619UL;
+        for (boost::string_ref::const_iterator it = s.begin(); it != s.end(); ++it)
+        {
+            h ^= (unsigned char)*it;
+            h *= prime;
+        }
+        // mix high bits down, as @ref limbo::containers::FlatHashMap uses low bits for slots
+        return h ^ (h >> 29);
+    }
+};
+
+/// @class limbo::containers::StringInterner
+/// @brief unique strings with dense ids, stored in an arena
+///
+/// @ref find_or_insert and @ref find lock a mutex and can be called from several threads.
+/// @ref str of an id does not lock, as views are kept in chunks that never move;
+/// it can be called from any thread that has obtained the id.
+///
+/// Usage:
+/// ~~~~~~~~~~~~~~~~
+/// StringInterner interner;
+/// unsigned int id = interner.find_or_insert("VDD");
+/// boost::string_ref name = interner.str(id);
+/// ~~~~~~~~~~~~~~~~
+class StringInterner
+{
+    public:
+        /// @nowarn
+        typedef unsigned int id_type;
+        typedef boost::string_ref string_view_type;
+        typedef std::size_t size_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param block_size size of each block of characters
+        explicit StringInterner(size_type block_size = 65536)
+            : m_blockSize(block_size)
+            , m_blockUsed(block_size)
+            , m_size(0)
+        {
+            pthread_mutex_init(&m_mutex, NULL);
+            std::fill(m_vChunk, m_vChunk+NUM_CHUNKS, (string_view_type*)NULL);
+        }
+        /// @brief destructor
+        ~StringInterner()
+        {
+            this->release();
+            pthread_mutex_destroy(&m_mutex);
+        }
+
+        /// @brief find the id of a string, and insert the string if absent
+        /// @param s string
+        /// @return id of the string
+        id_type find_or_insert(string_view_type s)
+        {
+            pthread_mutex_lock(&m_mutex);
+            map_type::iterator found = m_mId.find(s);
+            id_type id;
+            if (found != m_mId.end())
+                id = found->second;
+            else
+            {
+                id = m_size;
+                string_view_type copy = this->copy(s);
+                size_type chunk, offset;
+                locate(id, chunk, offset);
+                if (m_vChunk[chunk] == NULL)
+                    m_vChunk[chunk] = new string_view_type [chunk_size(chunk)];
+                m_vChunk[chunk][offset] = copy;
+                m_mId.insert(std::make_pair(copy, id));
+                ++m_size;
+            }
+            pthread_mutex_unlock(&m_mutex);
+            return id;
+        }
+        /// @brief find the id of a string
+        /// @param s string
+        /// @param id id as output
+        /// @return true if found
+        bool find(string_view_type s, id_type& id) const
+        {
+            pthread_mutex_lock(&m_mutex);
+            map_type::const_iterator found = m_mId.find(s);
+            bool flag = (found != m_mId.end());
+            if (flag)
+                id = found->second;
+            pthread_mutex_unlock(&m_mutex);
+            return flag;
+        }
+        /// @param id id returned by @ref find_or_insert
+        /// @return view of the string, terminated by '\0'
+        string_view_type str(id_type id) const
+        {
+            size_type chunk, offset;
+            locate(id, chunk, offset);
+            return m_vChunk[chunk][offset];
+        }
+        /// @return number of strings
+        size_type size() const
+        {
+            pthread_mutex_lock(&m_mutex);
+            size_type n = m_size;
+            pthread_mutex_unlock(&m_mutex);
+            return n;
+        }
+        /// @brief remove all strings and release memory, no other thread may use the interner
+        void clear()
+        {
+            this->release();
+            m_mId = map_type();
+            m_blockUsed = m_blockSize;
+            m_size = 0;
+        }
+    protected:
+        /// @nowarn
+        typedef FlatHashMap<string_view_type, id_type, string_ref_hash> map_type;
+        /// @endnowarn
+        /// chunk k holds 2^(k+FIRST_CHUNK_BITS) ids, enough chunks for all 32-bit ids
+        enum {FIRST_CHUNK_BITS = 10, NUM_CHUNKS = 32-FIRST_CHUNK_BITS+1};
+
+        /// copy is not allowed
+        StringInterner(StringInterner const&);
+        /// assignment is not allowed
+        StringInterner& operator=(StringInterner const&);
+
+        /// @return number of ids in a chunk
+        static size_type chunk_size(size_type chunk) {return (size_type)1 << (chunk+FIRST_CHUNK_BITS);}
+        /// @brief find the chunk and offset of an id
+        static void locate(id_type id, size_type& chunk, size_type& offset)
+        {
+            size_type v = (size_type)id + ((size_type)1 << FIRST_CHUNK_BITS);
+            size_type k = 0;
+            while ((v >> (k+FIRST_CHUNK_BITS+1)) != 0)
+                ++k;
+            chunk = k;
+            offset = v - chunk_size(k);
+        }
+        /// @brief copy a string into the arena
+        /// @return view of the copy
+        string_view_type copy(string_view_type s)
+        {
+            size_type n = s.size()+1;
+            char* p;
+            if (n > m_blockSize/4)
+            {
+                // long strings get their own blocks, so the current block is not wasted
+                p = new char [n];
+                m_vLargeBlock.push_back(p);
+            }
+            else
+            {
+                if (m_blockUsed+n > m_blockSize)
+                {
+                    m_vBlock.push_back(new char [m_blockSize]);
+                    m_blockUsed = 0;
+                }
+                p = m_vBlock.back()+m_blockUsed;
+                m_blockUsed += n;
+            }
+            std::memcpy(p, s.data(), s.size());
+            p[s.size()] = '\0';
+            return string_view_type(p, s.size());
+        }
+        /// @brief release all blocks and chunks
+        void release()
+        {
+            for (std::vector<char*>::iterator it = m_vBlock.begin(); it != m_vBlock.end(); ++it)
+                delete [] *it;
+            for (std::vector<char*>::iterator it = m_vLargeBlock.begin(); it != m_vLargeBlock.end(); ++it)
+                delete [] *it;
+            m_vBlock.clear();
+            m_vLargeBlock.clear();
+            for (size_type k = 0; k < NUM_CHUNKS; ++k)
+            {
+                delete [] m_vChunk[k];
+                m_vChunk[k] = NULL;
+            }
+        }
+
+        mutable pthread_mutex_t m_mutex; ///< lock of insertion and lookup
+        map_type m_mId; ///< map from strings in the arena to ids
+        std::vector<char*> m_vBlock; ///< blocks of short strings
+        std::vector<char*> m_vLargeBlock; ///< one block for each long string
+        size_type m_blockSize; ///< size of each block of short strings
+        size_type m_blockUsed; ///< number of characters used in the last block
+        string_view_type* m_vChunk[NUM_CHUNKS]; ///< views of strings by id, in chunks of doubling sizes
+        size_type m_size; ///< number of strings
+};
+
+} // namespace containers
+} // namespace limbo
+
+#endif
@@ -0,0 +1,515 @@
+/**
+ * @file   TaskPool.h
+ * @brief  a pool of threads running tasks from work-stealing deques, and the thread budget of Limbo
+ *
+ * Each worker has a deque of tasks. A worker pushes tasks it submits to the back of its own deque and pops from the back,
+ * so nested tasks run depth first on warm caches, and takes tasks from the front of other deques when its own is empty.
+ * Threads waiting for a task, e.g., in @ref limbo::containers::TaskPool::parallel_for, run queued tasks meanwhile,
+ * so tasks can submit and wait for tasks without deadlock.
+ * The free @ref limbo::containers::parallel_for runs blocks of a range on a pool started for the call,
+ * for engines that split arrays into blocks without keeping a pool.
+ *
+ * @ref limbo::containers::num_threads is the maximum number of threads of Limbo engines,
+ * which caps the threads set with engine options such as threads() of coloring algorithms.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_CONTAINERS_TASKPOOL_H
+#define LIMBO_CONTAINERS_TASKPOOL_H
+
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
+#include <unistd.h>
+#include <boost/shared_ptr.hpp>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Containers
+namespace containers
+{
+
+/// @return number of online processors, at least 1
+inline unsigned int hardware_threads()
+{
+    long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (unsigned int)std::max(numCores, 1L);
+}
+/// @return the setting of @ref num_threads, 0 for the number of online processors
+inline unsigned int& num_threads_setting()
+{
+    static unsigned int numThreads = 0;
+    return numThreads;
+}
+/// @return maximum number of threads of Limbo engines, the number of online processors by default
+inline unsigned int num_threads()
+{
+    unsigned int numThreads = num_threads_setting();
+    return (numThreads > 0)? numThreads : hardware_threads();
+}
+/// @brief set the maximum number of threads of Limbo engines, not to be called while engines run
+/// @param numThreads number of threads, 0 to restore the number of online processors
+inline void set_num_threads(unsigned int numThreads)
+{
+    num_threads_setting() = numThreads;
+}
+
+class TaskPool;
+
+/// @brief Result of a task submitted to a @ref limbo::containers::TaskPool.
+/// Copies refer to the same task.
+class TaskFuture
+{
+    public:
+        /// @brief construct an invalid future
+        TaskFuture() : m_pool(NULL) {}
+
+        /// @return true if the future refers to a task
+        bool valid() const {return m_state.get() != NULL;}
+        /// @return true if the task has finished
+        bool ready() const
+        {
+            pthread_mutex_lock(&m_state->mutex);
+            bool done = m_state->done;
+            pthread_mutex_unlock(&m_state->mutex);
+            return done;
+        }
+        /// @brief run queued tasks of the pool until the task has finished
+        inline void wait() const;
+
+    protected:
+        friend class TaskPool;
+
+        /// @brief state shared by the pool and the copies of a future
+        struct State
+        {
+            pthread_mutex_t mutex; ///< protect @ref done
+            pthread_cond_t cond; ///< signaled when @ref done is set
+            bool done; ///< whether the task has finished
+
+            /// @brief constructor
+            State() : done(false)
+            {
+                pthread_mutex_init(&mutex, NULL);
+                pthread_cond_init(&cond, NULL);
+            }
+            /// @brief destructor
+            ~State()
+            {
+                pthread_cond_destroy(&cond);
+                pthread_mutex_destroy(&mutex);
+            }
+        };
+
+        /// @brief finish the task and wake up waiting threads
+        void set() const
+        {
+            pthread_mutex_lock(&m_state->mutex);
+            m_state->done = true;
+            pthread_cond_broadcast(&m_state->cond);
+            pthread_mutex_unlock(&m_state->mutex);
+        }
+
+        TaskPool* m_pool; ///< pool running the task
+        boost::shared_ptr<State> m_state; ///< shared state, NULL if invalid
+};
+
+/// @brief Blocks of indices covering a range, taken in increasing order with an atomic counter by any number of threads.
+///
+/// This is the loop of @ref TaskPool::parallel_for, exposed for engines running it on threads of their own,
+/// e.g., a team of threads kept across kernels.
+/// All blocks are done when a thread returns from @ref run, however many threads run it.
+/// @tparam Body function object with operator()(std::size_t, std::size_t) const for a block [i, j)
+template <typename Body>
+class ParallelBlocks
+{
+    public:
+        /// @nowarn
+        typedef std::size_t size_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param first first index
+        /// @param last end index
+        /// @param grain number of indices of a block, at least 1
+        /// @param body function object, it must be alive until all blocks are done
+        ParallelBlocks(size_type first, size_type last, size_type grain, Body const& body)
+            : m_body(&body)
+            , m_first(first)
+            , m_last(std::max(first, last))
+            , m_grain(std::max(grain, (size_type)1))
+            , m_next(0)
+        {
+            m_numBlocks = (m_last-m_first+m_grain-1)/m_grain;
+        }
+
+        /// @return number of blocks
+        size_type size() const {return m_numBlocks;}
+        /// @brief take blocks until none is left
+        void run()
+        {
+            while (true)
+            {
+                size_type b = __sync_fetch_and_add(&m_next, 1);
+                if (b >= m_numBlocks)
+                    break;
+                size_type i = m_first+b*m_grain;
+                (*m_body)(i, std::min(i+m_grain, m_last));
+            }
+        }
+        /// @brief @ref run in the form of a task of @ref TaskPool
+        /// @param arg pointer to the blocks
+        static void task(void* arg)
+        {
+            static_cast<ParallelBlocks*>(arg)->run();
+        }
+
+    protected:
+        Body const* m_body; ///< function object
+        size_type m_first; ///< first index
+        size_type m_last; ///< end index
+        size_type m_grain; ///< number of indices of a block
+        size_type m_next; ///< next block
+        size_type m_numBlocks; ///< number of blocks
+};
+
+/// @brief A pool of worker threads with work-stealing deques.
+///
+/// Tasks are functions with a pointer argument, in the same form as thread functions.
+/// Tasks submitted from outside the pool are spread over the workers in turn.
+///
+/// Usage:
+/// ~~~~~~~~~~~~~~~~
+/// TaskPool pool;
+/// TaskFuture future = pool.submit(run, &arg);
+/// pool.parallel_for(0, n, 1024, body); // body(first, last) for each block of indices
+/// future.wait();
+/// ~~~~~~~~~~~~~~~~
+class TaskPool
+{
+    public:
+        /// @nowarn
+        typedef void (*function_type)(void*);
+        typedef std::size_t size_type;
+        /// @endnowarn
+
+        /// @brief constructor, start the workers
+        /// @param numThreads number of workers, 0 for @ref num_threads
+        explicit TaskPool(unsigned int numThreads = 0)
+            : m_next(0)
+            , m_queued(0)
+            , m_unfinished(0)
+            , m_sleeping(0)
+            , m_stop(false)
+        {
+            if (numThreads == 0)
+                numThreads = num_threads();
+            pthread_mutex_init(&m_mutex, NULL);
+            pthread_cond_init(&m_condWork, NULL);
+            pthread_cond_init(&m_condIdle, NULL);
+            pthread_key_create(&m_key, NULL);
+            for (unsigned int i = 0; i < numThreads; ++i)
+            {
+                Worker* worker = new Worker;
+                worker->pool = this;
+                worker->index = i;
+                pthread_mutex_init(&worker->mutex, NULL);
+                m_vWorker.push_back(worker);
+            }
+            // start workers after all deques exist, as workers steal from each other
+            for (unsigned int i = 0; i < m_vWorker.size(); ++i)
+                m_vWorker[i]->created = (pthread_create(&m_vWorker[i]->thread, NULL, TaskPool::workerThread, m_vWorker[i]) == 0);
+        }
+        /// @brief destructor, finish the submitted tasks and stop the workers
+        ~TaskPool()
+        {
+            this->wait();
+            pthread_mutex_lock(&m_mutex);
+            m_stop = true;
+            pthread_cond_broadcast(&m_condWork);
+            pthread_mutex_unlock(&m_mutex);
+            for (unsigned int i = 0; i < m_vWorker.size(); ++i)
+            {
+                if (m_vWorker[i]->created)
+                    pthread_join(m_vWorker[i]->thread, NULL);
+                pthread_mutex_destroy(&m_vWorker[i]->mutex);
+                delete m_vWorker[i];
+            }
+            pthread_key_delete(m_key);
+            pthread_cond_destroy(&m_condIdle);
+            pthread_cond_destroy(&m_condWork);
+            pthread_mutex_destroy(&m_mutex);
+        }
+
+        /// @return number of workers
+        unsigned int size() const {return m_vWorker.size();}
+
+        /// @brief schedule a task, thread-safe
+        /// @param function function of the task
+        /// @param arg argument of the function, it must be alive until the task finishes
+        /// @return future of the task
+        TaskFuture submit(function_type function, void* arg)
+        {
+            Task task;
+            task.function = function;
+            task.arg = arg;
+            task.future.m_pool = this;
+            task.future.m_state.reset(new TaskFuture::State);
+
+            Worker* self = this->current();
+            Worker* worker = self? self : m_vWorker[__sync_fetch_and_add(&m_next, 1)%m_vWorker.size()];
+            __sync_fetch_and_add(&m_unfinished, 1);
+            // count before pushing, so a worker never sees a queued task not counted
+            __sync_fetch_and_add(&m_queued, 1);
+            pthread_mutex_lock(&worker->mutex);
+            worker->qTask.push_back(task);
+            pthread_mutex_unlock(&worker->mutex);
+            // m_queued is incremented above with a full barrier, so a worker going to sleep either sees it or is counted here
+            if (load(m_sleeping) > 0)
+            {
+                pthread_mutex_lock(&m_mutex);
+                pthread_cond_signal(&m_condWork);
+                pthread_mutex_unlock(&m_mutex);
+            }
+            return task.future;
+        }
+        /// @brief run queued tasks until all submitted tasks have finished
+        void wait()
+        {
+            while (load(m_unfinished) > 0)
+            {
+                if (this->run_one())
+                    continue;
+                // remaining tasks are running on other threads
+                pthread_mutex_lock(&m_mutex);
+                while (load(m_unfinished) > 0 && load(m_queued) == 0)
+                    pthread_cond_wait(&m_condIdle, &m_mutex);
+                pthread_mutex_unlock(&m_mutex);
+            }
+        }
+        /// @brief call body(i, j) for blocks [i, j) of at most grain indices covering [first, last), and wait for all blocks.
+        /// Blocks are taken in increasing order by the workers and the calling thread.
+        /// @tparam Body function object with operator()(size_type, size_type) const
+        /// @param first first index
+        /// @param last end index
+        /// @param grain number of indices of a block, at least 1
+        /// @param body function object
+        template <typename Body>
+        void parallel_for(size_type first, size_type last, size_type grain, Body const& body)
+        {
+            this->parallel_for(first, last, grain, m_vWorker.size(), body);
+        }
+        /// @brief @ref parallel_for on at most numThreads threads, the calling thread included,
+        /// for callers keeping a pool across calls of different limits
+        /// @tparam Body function object with operator()(size_type, size_type) const
+        /// @param first first index
+        /// @param last end index
+        /// @param grain number of indices of a block, at least 1
+        /// @param numThreads maximum number of threads
+        /// @param body function object
+        template <typename Body>
+        void parallel_for(size_type first, size_type last, size_type grain, size_type numThreads, Body const& body)
+        {
+            ParallelBlocks<Body> blocks (first, last, grain, body);
+            // the calling thread takes blocks as well
+            size_type numHelpers = std::min(std::min(numThreads, blocks.size()), (size_type)m_vWorker.size()+1);
+            numHelpers = (numHelpers > 0)? numHelpers-1 : 0;
+            std::vector<TaskFuture> vFuture (numHelpers);
+            for (size_type i = 0; i < numHelpers; ++i)
+                vFuture[i] = this->submit(ParallelBlocks<Body>::task, &blocks);
+            blocks.run();
+            for (size_type i = 0; i < numHelpers; ++i)
+                vFuture[i].wait();
+        }
+
+    protected:
+        friend class TaskFuture;
+
+        /// @brief a submitted task
+        struct Task
+        {
+            function_type function; ///< function
+            void* arg; ///< argument
+            TaskFuture future; ///< result
+        };
+        /// @brief a worker thread with its deque
+        struct Worker
+        {
+            TaskPool* pool; ///< pool
+            unsigned int index; ///< index in the pool
+            pthread_t thread; ///< thread
+            bool created; ///< whether the thread is created
+            pthread_mutex_t mutex; ///< protect the deque
+            std::deque<Task> qTask; ///< tasks, the owner takes the back and other threads take the front
+        };
+        /// @return value read after all earlier writes of other threads are visible
+        static size_type load(size_type const& v)
+        {
+            size_type r = *(size_type const volatile*)&v;
+            __sync_synchronize();
+            return r;
+        }
+        /// @return worker of the calling thread, NULL if it is not a worker of the pool
+        Worker* current() const {return static_cast<Worker*>(pthread_getspecific(m_key));}
+        /// @brief take a task, first from the back of the own deque, then from the front of other deques
+        /// @param task task as output
+        /// @return true if a task is taken
+        bool take(Task& task)
+        {
+            if (load(m_queued) == 0)
+                return false;
+            Worker* self = this->current();
+            if (self)
+            {
+                pthread_mutex_lock(&self->mutex);
+                bool found = !self->qTask.empty();
+                if (found)
+                {
+                    task = self->qTask.back();
+                    self->qTask.pop_back();
+                }
+                pthread_mutex_unlock(&self->mutex);
+                if (found)
+                {
+                    __sync_fetch_and_sub(&m_queued, 1);
+                    return true;
+                }
+            }
+            // start from the next worker, so thieves spread over the deques
+            size_type start = self? self->index+1 : __sync_fetch_and_add(&m_next, 1);
+            for (size_type i = 0; i < m_vWorker.size(); ++i)
+            {
+                Worker* victim = m_vWorker[(start+i)%m_vWorker.size()];
+                if (victim == self)
+                    continue;
+                pthread_mutex_lock(&victim->mutex);
+                bool found = !victim->qTask.empty();
+                if (found)
+                {
+                    task = victim->qTask.front();
+                    victim->qTask.pop_front();
+                }
+                pthread_mutex_unlock(&victim->mutex);
+                if (found)
+                {
+                    __sync_fetch_and_sub(&m_queued, 1);
+                    return true;
+                }
+            }
+            return false;
+        }
+        /// @brief take and run a task
+        /// @return true if a task has run
+        bool run_one()
+        {
+            Task task;
+            if (!this->take(task))
+                return false;
+            task.function(task.arg);
+            task.future.set();
+            if (__sync_sub_and_fetch(&m_unfinished, 1) == 0)
+            {
+                pthread_mutex_lock(&m_mutex);
+                pthread_cond_broadcast(&m_condIdle);
+                pthread_mutex_unlock(&m_mutex);
+            }
+            return true;
+        }
+        /// @brief worker loop, run tasks and sleep when no task is queued
+        /// @param arg pointer to the worker
+        /// @return NULL
+        static void* workerThread(void* arg)
+        {
+            Worker& worker = *static_cast<Worker*>(arg);
+            TaskPool& pool = *worker.pool;
+            pthread_setspecific(pool.m_key, &worker);
+            while (true)
+            {
+                if (pool.run_one())
+                    continue;
+                pthread_mutex_lock(&pool.m_mutex);
+                // full barrier between counting the sleeper and reading m_queued, paired with submit
+                __sync_fetch_and_add(&pool.m_sleeping, 1);
+                while (load(pool.m_queued) == 0 && !pool.m_stop)
+                    pthread_cond_wait(&pool.m_condWork, &pool.m_mutex);
+                __sync_fetch_and_sub(&pool.m_sleeping, 1);
+                bool stop = (pool.m_stop && load(pool.m_queued) == 0);
+                pthread_mutex_unlock(&pool.m_mutex);
+                if (stop)
+                    break;
+            }
+            return NULL;
+        }
+
+        /// @brief copy constructor, forbidden
+        /// @param rhs right hand side
+        TaskPool(TaskPool const& rhs);
+        /// @brief assignment, forbidden
+        /// @param rhs right hand side
+        TaskPool& operator=(TaskPool const& rhs);
+
+        std::vector<Worker*> m_vWorker; ///< workers
+        pthread_key_t m_key; ///< worker of the current thread
+        size_type m_next; ///< counter to spread tasks submitted from outside and thefts
+        size_type m_queued; ///< number of tasks in the deques
+        size_type m_unfinished; ///< number of tasks submitted and not finished
+        size_type m_sleeping; ///< number of workers waiting for tasks
+        bool m_stop; ///< whether workers exit when no task is queued
+        pthread_mutex_t m_mutex; ///< protect sleeping and waking up
+        pthread_cond_t m_condWork; ///< signaled when a task is submitted to sleeping workers or the pool stops
+        pthread_cond_t m_condIdle; ///< signaled when all submitted tasks have finished
+};
+
+inline void TaskFuture::wait() const
+{
+    while (!this->ready())
+    {
+        if (m_pool->run_one())
+            continue;
+        // no task is queued, so the task is running on another thread
+        pthread_mutex_lock(&m_state->mutex);
+        while (!m_state->done)
+            pthread_cond_wait(&m_state->cond, &m_state->mutex);
+        pthread_mutex_unlock(&m_state->mutex);
+    }
+}
+
+/// @brief call body(i, j) for blocks [i, j) of at most grain indices covering [first, last) on at most numThreads threads,
+/// the calling thread included, and wait for all blocks.
+/// Workers are started for this call only and no more than the blocks; a single thread runs all blocks on the calling thread.
+/// Blocks are all done even if no worker starts.
+/// @tparam Body function object with operator()(std::size_t, std::size_t) const
+/// @param first first index
+/// @param last end index
+/// @param grain number of indices of a block, at least 1
+/// @param numThreads maximum number of threads, 0 for @ref num_threads
+/// @param body function object
+template <typename Body>
+inline void parallel_for(std::size_t first, std::size_t last, std::size_t grain, unsigned int numThreads, Body const& body)
+{
+    ParallelBlocks<Body> blocks (first, last, grain, body);
+    if (numThreads == 0)
+        numThreads = num_threads();
+    numThreads = (unsigned int)std::min((std::size_t)numThreads, blocks.size());
+    if (numThreads <= 1)
+    {
+        blocks.run();
+        return;
+    }
+    TaskPool pool (numThreads-1);
+    std::vector<TaskFuture> vFuture (pool.size());
+    for (unsigned int i = 0; i < pool.size(); ++i)
+        vFuture[i] = pool.submit(ParallelBlocks<Body>::task, &blocks);
+    blocks.run();
+    // waiting runs the tasks of workers that failed to start
+    for (unsigned int i = 0; i < pool.size(); ++i)
+        vFuture[i].wait();
+}
+
+} // namespace containers
+} // namespace limbo
+
+#endif
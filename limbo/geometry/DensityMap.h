@@ -0,0 +1,414 @@
+/**
+ * @file   DensityMap.h
+ * @brief  rasterization of rectangles into a uniform grid of bins with exact overlap areas, and window density queries
+ *
+ * Placement accumulates cell areas per bin and layout analysis accumulates metal areas per window.
+ * Both come down to adding the overlap area of each rectangle with each bin it covers.
+ * A batch of rectangles is rasterized by threads in stripes of rows,
+ * each stripe accumulated by the single thread taking it, so no bin is written by two threads
+ * and bins receive rectangles in the input order whatever the number of threads.
+ * Summed-area tables answer the area of any window of bins in constant time.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_DENSITYMAP_H
+#define _LIMBO_GEOMETRY_DENSITYMAP_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <limbo/geometry/Geometry.h>
+#include <limbo/geometry/RectangleArray.h>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.Geometry
+namespace geometry
+{
+
+/**
+ * @class limbo::geometry::DensityMap
+ * @brief a uniform grid of bins accumulating overlap areas of rectangles
+ *
+ * Bin (c, r) covers [xl+c*bin_w, xl+(c+1)*bin_w) x [yl+r*bin_h, yl+(r+1)*bin_h), and bins are stored row by row.
+ * Parts of rectangles out of the grid are ignored.
+ * Areas are computed in area_type, so integer coordinates with an integer area type give exact areas.
+ * With floating point areas, many incremental updates may leave rounding errors in bins, cleared by rebuilding the map.
+ *
+ * Usage:
+ * ~~~~~~~~~~~~~~~~
+ * DensityMap<int, long> dmap;
+ * dmap.reset(0, 0, 100, 100, 64, 64);
+ * dmap.add_rectangles(vRect.begin(), vRect.end(), 8);
+ * dmap.move(xl, yl, xh, yh, xl+10, yl, xh+10, yh);
+ * dmap.update_prefix();
+ * long a = dmap.window(0, 0, 4, 4);
+ * ~~~~~~~~~~~~~~~~
+ *
+ * @tparam CoordinateType coordinate type
+ * @tparam AreaType type of areas, signed
+ */
+template <typename CoordinateType, typename AreaType = double>
+class DensityMap
+{
+	public:
+		/// @brief coordinate type
+		typedef CoordinateType coordinate_type;
+		/// @brief area type
+		typedef AreaType area_type;
+
+        /// @brief constructor of an empty grid
+		DensityMap() : m_xl(0), m_yl(0), m_bin_w(1), m_bin_h(1), m_num_bins_x(0), m_num_bins_y(0), m_prefix_valid(false) {}
+
+        /**
+         * @brief set the grid and clear bins
+         * @param xl, yl lower left corner of the grid
+         * @param bin_w, bin_h width and height of a bin, positive
+         * @param num_bins_x, num_bins_y number of bins in x and y
+         */
+		void reset(coordinate_type xl, coordinate_type yl, coordinate_type bin_w, coordinate_type bin_h, unsigned int num_bins_x, unsigned int num_bins_y)
+		{
+			limboAssertMsg(bin_w > 0 && bin_h > 0, "bin size is not positive");
+			m_xl = xl;
+			m_yl = yl;
+			m_bin_w = bin_w;
+			m_bin_h = bin_h;
+			m_num_bins_x = num_bins_x;
+			m_num_bins_y = num_bins_y;
+			m_vBin.assign((std::size_t)num_bins_x*num_bins_y, 0);
+			m_vPrefix.clear();
+			m_prefix_valid = false;
+		}
+        /// @brief clear bins, keeping the grid
+		void clear()
+		{
+			std::fill(m_vBin.begin(), m_vBin.end(), 0);
+			m_prefix_valid = false;
+		}
+        /// @return number of bins in x
+		unsigned int num_bins_x() const {return m_num_bins_x;}
+        /// @return number of bins in y
+		unsigned int num_bins_y() const {return m_num_bins_y;}
+        /// @return left of the grid
+		coordinate_type xl() const {return m_xl;}
+        /// @return bottom of the grid
+		coordinate_type yl() const {return m_yl;}
+        /// @return width of a bin
+		coordinate_type bin_w() const {return m_bin_w;}
+        /// @return height of a bin
+		coordinate_type bin_h() const {return m_bin_h;}
+        /// @return area of a bin
+		area_type bin_area() const {return (area_type)m_bin_w*(area_type)m_bin_h;}
+        /// @return area in bin (c, r)
+		area_type bin(unsigned int c, unsigned int r) const {return m_vBin[(std::size_t)r*m_num_bins_x+c];}
+        /// @return density of bin (c, r), i.e., area over the area of a bin
+		double density(unsigned int c, unsigned int r) const {return (double)bin(c, r)/(double)bin_area();}
+        /// @return areas of all bins row by row
+		std::vector<area_type> const& bins() const {return m_vBin;}
+
+        /// @brief add the overlap areas of a rectangle
+		void add(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh)
+		{
+			this->rasterize(xl, yl, xh, yh, 1, 0, m_num_bins_y);
+			m_prefix_valid = false;
+		}
+        /// @brief subtract the overlap areas of a rectangle added before
+		void remove(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh)
+		{
+			this->rasterize(xl, yl, xh, yh, -1, 0, m_num_bins_y);
+			m_prefix_valid = false;
+		}
+        /**
+         * @brief move a rectangle, e.g., a cell in placement
+         * @param oxl, oyl, oxh, oyh old rectangle added before
+         * @param nxl, nyl, nxh, nyh new rectangle
+         */
+		void move(coordinate_type oxl, coordinate_type oyl, coordinate_type oxh, coordinate_type oyh,
+				coordinate_type nxl, coordinate_type nyl, coordinate_type nxh, coordinate_type nyh)
+		{
+			this->remove(oxl, oyl, oxh, oyh);
+			this->add(nxl, nyl, nxh, nyh);
+		}
+        /**
+         * @brief add overlap areas of rectangles with threads
+         * @param array rectangles
+         * @param num_threads number of threads
+         */
+		void add_rectangles(RectangleArray<coordinate_type> const& array, unsigned int num_threads = 1)
+		{
+			if (array.size() == 0)
+				return;
+			this->add_rectangles(&array.coords(LEFT)[0], &array.coords(BOTTOM)[0], &array.coords(RIGHT)[0], &array.coords(TOP)[0],
+					array.size(), num_threads);
+		}
+        /**
+         * @brief add overlap areas of rectangles with threads
+         * @tparam Iterator forward iterator of rectangles with @ref limbo::geometry::rectangle_traits
+         * @param first begin iterator of rectangles
+         * @param last end iterator of rectangles
+         * @param num_threads number of threads
+         */
+		template <typename Iterator>
+		void add_rectangles(Iterator first, Iterator last, unsigned int num_threads = 1)
+		{
+			typedef rectangle_traits<typename std::iterator_traits<Iterator>::value_type> traits_type;
+			// coordinate arrays without RectangleArray, which needs coordinate_traits of the coordinate type
+			std::vector<coordinate_type> vCoord[4];
+			for (; first != last; ++first)
+				for (int d = 0; d < 4; ++d)
+					vCoord[d].push_back(traits_type::get(*first, (direction_2d)d));
+			if (vCoord[LEFT].empty())
+				return;
+			this->add_rectangles(&vCoord[LEFT][0], &vCoord[BOTTOM][0], &vCoord[RIGHT][0], &vCoord[TOP][0], vCoord[LEFT].size(), num_threads);
+		}
+        /**
+         * @brief add overlap areas of rectangles in coordinate arrays with threads
+         * @param vxl, vyl, vxh, vyh coordinate arrays of n rectangles
+         * @param n number of rectangles
+         * @param num_threads number of threads
+         */
+		void add_rectangles(coordinate_type const* vxl, coordinate_type const* vyl, coordinate_type const* vxh, coordinate_type const* vyh,
+				std::size_t n, unsigned int num_threads = 1);
+
+        /// @brief compute the summed-area table, called after updates of bins and before window queries
+		void update_prefix();
+        /**
+         * @brief total area in a window of bins, only with an up-to-date summed-area table
+         * @param c0, r0 first column and row of the window
+         * @param c1, r1 column and row after the window
+         * @return area in bins [c0, c1) x [r0, r1)
+         */
+		area_type window(unsigned int c0, unsigned int r0, unsigned int c1, unsigned int r1) const
+		{
+			limboAssertMsg(m_prefix_valid, "update_prefix() is not called after updating bins");
+			std::size_t w = m_num_bins_x+1;
+			return m_vPrefix[(std::size_t)r1*w+c1]-m_vPrefix[(std::size_t)r0*w+c1]-m_vPrefix[(std::size_t)r1*w+c0]+m_vPrefix[(std::size_t)r0*w+c0];
+		}
+        /**
+         * @brief density of all windows of a size sliding by one bin, only with an up-to-date summed-area table
+         * @param wx, wy number of bins of a window in x and y
+         * @param vDensity density of the window whose lower left bin is (c, r) at r*(num_bins_x-wx+1)+c, empty if windows are larger than the grid
+         */
+		void sliding_window(unsigned int wx, unsigned int wy, std::vector<double>& vDensity) const
+		{
+			vDensity.clear();
+			if (wx == 0 || wy == 0 || wx > m_num_bins_x || wy > m_num_bins_y)
+				return;
+			unsigned int nx = m_num_bins_x-wx+1;
+			unsigned int ny = m_num_bins_y-wy+1;
+			double window_area = (double)bin_area()*wx*wy;
+			vDensity.resize((std::size_t)nx*ny);
+			for (unsigned int r = 0; r < ny; ++r)
+				for (unsigned int c = 0; c < nx; ++c)
+					vDensity[(std::size_t)r*nx+c] = (double)window(c, r, c+wx, r+wy)/window_area;
+		}
+        /**
+         * @brief overflow of bins above a target density, e.g., of placement bins
+         * @param target target density
+         * @return sum of areas above target density times the area of a bin over all bins
+         */
+		double overflow(double target) const
+		{
+			double capacity = target*(double)bin_area();
+			double sum = 0;
+			for (std::size_t i = 0; i < m_vBin.size(); ++i)
+				sum += std::max((double)m_vBin[i]-capacity, 0.0);
+			return sum;
+		}
+
+	protected:
+		/// number of rows of a stripe, rasterized by one block
+		static const unsigned int stripe_rows = 8;
+
+		/// @brief rectangles shared by threads of @ref add_rectangles
+		struct stripe_task_type
+		{
+			DensityMap* pMap; ///< this object
+			coordinate_type const* vxl; ///< left of rectangles
+			coordinate_type const* vyl; ///< bottom of rectangles
+			coordinate_type const* vxh; ///< right of rectangles
+			coordinate_type const* vyh; ///< top of rectangles
+			std::vector<std::size_t> vStripeBegin; ///< first rectangle of each stripe in vStripeItem
+			std::vector<std::size_t> vStripeItem; ///< rectangles overlapping each stripe, in the input order
+			/// @brief rasterize a range of stripes, run by limbo::containers::parallel_for
+			/// @param b first stripe
+			/// @param e end stripe
+			void operator()(std::size_t b, std::size_t e) const {pMap->rasterize_stripes(*this, b, e);}
+		};
+
+        /// @return column of bins containing x clipped to the grid, x is not less than the left of the grid
+		unsigned int column(coordinate_type x) const {return std::min((unsigned int)((x-m_xl)/m_bin_w), m_num_bins_x-1);}
+        /// @return row of bins containing y clipped to the grid, y is not less than the bottom of the grid
+		unsigned int row(coordinate_type y) const {return std::min((unsigned int)((y-m_yl)/m_bin_h), m_num_bins_y-1);}
+        /**
+         * @brief clip a rectangle to the grid
+         * @param xl, yl, xh, yh rectangle, clipped as output
+         * @return false if nothing of positive area is left
+         */
+		bool clip(coordinate_type& xl, coordinate_type& yl, coordinate_type& xh, coordinate_type& yh) const
+		{
+			xl = std::max(xl, m_xl);
+			yl = std::max(yl, m_yl);
+			xh = std::min(xh, (coordinate_type)(m_xl+m_bin_w*(coordinate_type)m_num_bins_x));
+			yh = std::min(yh, (coordinate_type)(m_yl+m_bin_h*(coordinate_type)m_num_bins_y));
+			return xl < xh && yl < yh;
+		}
+        /**
+         * @brief add overlap areas of a rectangle with bins in a range of rows
+         * @param xl, yl, xh, yh rectangle
+         * @param sign 1 to add and -1 to subtract
+         * @param row_first, row_last range of rows
+         */
+		void rasterize(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh, int sign,
+				unsigned int row_first, unsigned int row_last);
+		/// @brief rasterize stripes in [first, last)
+		/// @param task shared state
+		/// @param first first stripe
+		/// @param last end stripe
+		void rasterize_stripes(stripe_task_type const& task, unsigned int first, unsigned int last);
+
+		coordinate_type m_xl; ///< left of the grid
+		coordinate_type m_yl; ///< bottom of the grid
+		coordinate_type m_bin_w; ///< width of a bin
+		coordinate_type m_bin_h; ///< height of a bin
+		unsigned int m_num_bins_x; ///< number of bins in x
+		unsigned int m_num_bins_y; ///< number of bins in y
+		std::vector<area_type> m_vBin; ///< area of each bin, row by row
+		std::vector<area_type> m_vPrefix; ///< summed-area table of (num_bins_y+1) rows of (num_bins_x+1) entries
+		bool m_prefix_valid; ///< whether the summed-area table agrees with bins
+};
+
+template <typename CoordinateType, typename AreaType>
+const unsigned int DensityMap<CoordinateType, AreaType>::stripe_rows;
+
+template <typename CoordinateType, typename AreaType>
+void DensityMap<CoordinateType, AreaType>::rasterize(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh, int sign,
+		unsigned int row_first, unsigned int row_last)
+{
+	if (m_num_bins_x == 0 || m_num_bins_y == 0 || !this->clip(xl, yl, xh, yh))
+		return;
+	unsigned int c0 = column(xl);
+	unsigned int c1 = column(xh);
+	unsigned int r0 = std::max(row(yl), row_first);
+	unsigned int r1 = std::min(row(yh)+1, row_last);
+	if (r0 >= r1)
+		return;
+	// widths of the rectangle in columns, shared by all rows
+	area_type vWidth[64];
+	std::vector<area_type> vWidthLarge;
+	area_type* pWidth = vWidth;
+	if (c1-c0+1 > 64)
+	{
+		vWidthLarge.resize(c1-c0+1);
+		pWidth = &vWidthLarge[0];
+	}
+	for (unsigned int c = c0; c <= c1; ++c)
+	{
+		coordinate_type bxl = m_xl+m_bin_w*(coordinate_type)c;
+		pWidth[c-c0] = (area_type)sign*(area_type)(std::min(xh, (coordinate_type)(bxl+m_bin_w))-std::max(xl, bxl));
+	}
+	for (unsigned int r = r0; r < r1; ++r)
+	{
+		coordinate_type byl = m_yl+m_bin_h*(coordinate_type)r;
+		area_type h = (area_type)(std::min(yh, (coordinate_type)(byl+m_bin_h))-std::max(yl, byl));
+		area_type* pBin = &m_vBin[(std::size_t)r*m_num_bins_x+c0];
+		for (unsigned int c = 0; c <= c1-c0; ++c)
+			pBin[c] += pWidth[c]*h;
+	}
+}
+
+template <typename CoordinateType, typename AreaType>
+void DensityMap<CoordinateType, AreaType>::add_rectangles(coordinate_type const* vxl, coordinate_type const* vyl, coordinate_type const* vxh, coordinate_type const* vyh,
+		std::size_t n, unsigned int num_threads)
+{
+	m_prefix_valid = false;
+	if (m_num_bins_x == 0 || m_num_bins_y == 0)
+		return;
+	unsigned int numStripes = (m_num_bins_y+stripe_rows-1)/stripe_rows;
+	unsigned int numThreads = std::min(limbo::containers::num_threads(), std::max(num_threads, 1U));
+	numThreads = std::min(numThreads, numStripes);
+	if (numThreads <= 1)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			this->rasterize(vxl[i], vyl[i], vxh[i], vyh[i], 1, 0, m_num_bins_y);
+		return;
+	}
+
+	// rectangles of each stripe by counting sort, in the input order
+	stripe_task_type task;
+	task.pMap = this;
+	task.vxl = vxl;
+	task.vyl = vyl;
+	task.vxh = vxh;
+	task.vyh = vyh;
+	task.vStripeBegin.assign(numStripes+1, 0);
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		std::vector<std::size_t> vPos (task.vStripeBegin.begin(), task.vStripeBegin.end()-1);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			coordinate_type xl = vxl[i], yl = vyl[i], xh = vxh[i], yh = vyh[i];
+			if (!this->clip(xl, yl, xh, yh))
+				continue;
+			for (unsigned int s = row(yl)/stripe_rows, se = row(yh)/stripe_rows; s <= se; ++s)
+			{
+				if (pass == 0)
+					task.vStripeBegin[s+1] += 1;
+				else
+					task.vStripeItem[vPos[s]++] = i;
+			}
+		}
+		if (pass == 0)
+		{
+			for (unsigned int s = 0; s < numStripes; ++s)
+				task.vStripeBegin[s+1] += task.vStripeBegin[s];
+			task.vStripeItem.resize(task.vStripeBegin.back());
+		}
+	}
+
+	limbo::containers::parallel_for(0, numStripes, 1, numThreads, task);
+}
+
+template <typename CoordinateType, typename AreaType>
+void DensityMap<CoordinateType, AreaType>::rasterize_stripes(stripe_task_type const& task, unsigned int first, unsigned int last)
+{
+	for (unsigned int s = first; s < last; ++s)
+	{
+		unsigned int row_first = s*stripe_rows;
+		unsigned int row_last = std::min(row_first+stripe_rows, m_num_bins_y);
+		for (std::size_t k = task.vStripeBegin[s]; k < task.vStripeBegin[s+1]; ++k)
+		{
+			std::size_t i = task.vStripeItem[k];
+			this->rasterize(task.vxl[i], task.vyl[i], task.vxh[i], task.vyh[i], 1, row_first, row_last);
+		}
+	}
+}
+
+template <typename CoordinateType, typename AreaType>
+void DensityMap<CoordinateType, AreaType>::update_prefix()
+{
+	std::size_t w = m_num_bins_x+1;
+	m_vPrefix.assign(w*(m_num_bins_y+1), 0);
+	for (unsigned int r = 0; r < m_num_bins_y; ++r)
+	{
+		area_type const* pBin = m_vBin.empty()? NULL : &m_vBin[(std::size_t)r*m_num_bins_x];
+		area_type const* pBelow = &m_vPrefix[(std::size_t)r*w];
+		area_type* pRow = &m_vPrefix[(std::size_t)(r+1)*w];
+		area_type sum = 0;
+		for (unsigned int c = 0; c < m_num_bins_x; ++c)
+		{
+			sum += pBin[c];
+			pRow[c+1] = pBelow[c+1]+sum;
+		}
+	}
+	m_prefix_valid = true;
+}
+
+} // namespace geometry
+} // namespace limbo
+
+#endif
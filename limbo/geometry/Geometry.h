@@ -11,6 +11,7 @@
 
 #include <vector>
 #include <list>
+#include <utility>
 #include <ostream>
 
 /// @brief namespace for Limbo
@@ -42,7 +43,9 @@ enum slicing_orientation_2d
 	VERTICAL_SLICING = 2,
 	HOR_VER_SLICING = 3, ///< horizontal/vertical slicing and choose rectangle with larger area every time 
     HOR_VER_SA_SLICING = 4, ///< horizontal/vertical slicing and choose rectangle with smaller area every time 
-    HOR_VER_AR_SLICING = 5 ///< horizontal/vertical slicing and choose rectangle with better aspect ratio every time 
+    HOR_VER_AR_SLICING = 5, ///< horizontal/vertical slicing and choose rectangle with better aspect ratio every time 
+    MIN_RECT_SLICING = 6, ///< minimum number of rectangles from maximum matching of chords between concave vertices 
+    MIN_RECT_FAST_SLICING = 7 ///< near minimum number of rectangles from greedy choice of chords between concave vertices 
 };
 
 /// @brief convert enum type of slicing orientation to string 
@@ -62,6 +65,10 @@ inline std::string to_string(slicing_orientation_2d slicing_orient)
             return "HOR_VER_SA_SLICING"; 
         case HOR_VER_AR_SLICING:
             return "HOR_VER_AR_SLICING"; 
+        case MIN_RECT_SLICING:
+            return "MIN_RECT_SLICING"; 
+        case MIN_RECT_FAST_SLICING:
+            return "MIN_RECT_FAST_SLICING"; 
         default:
             return "UNKNOWN";
     }
@@ -323,6 +330,38 @@ struct container_traits<std::list<T> >
 	{return container_type();}
 };
 
+/// @class limbo::geometry::contour_traits
+/// @brief type traits for a contour, i.e., a range of points such as a hole of a polygon 
+/// @tparam ContourType contour type, a container of points by default 
+template <typename ContourType>
+struct contour_traits
+{
+    /// @nowarn
+	typedef ContourType contour_type;
+	typedef typename contour_type::const_iterator iterator_type;
+    /// @endnowarn
+
+    /// @brief begin iterator of points 
+	static iterator_type begin(contour_type const& c) {return c.begin();}
+    /// @brief end iterator of points 
+	static iterator_type end(contour_type const& c) {return c.end();}
+};
+/// @brief partial specialization of @ref limbo::geometry::contour_traits for a pair of iterators 
+/// @tparam IteratorType iterator type of points 
+template <typename IteratorType>
+struct contour_traits<std::pair<IteratorType, IteratorType> >
+{
+    /// @nowarn
+	typedef std::pair<IteratorType, IteratorType> contour_type;
+	typedef IteratorType iterator_type;
+    /// @endnowarn
+
+    /// @brief begin iterator of points 
+	static iterator_type begin(contour_type const& c) {return c.first;}
+    /// @brief end iterator of points 
+	static iterator_type end(contour_type const& c) {return c.second;}
+};
+
 /// @brief calculate signed area of a polygon, the result is positive if its winding is CLOCKWISE
 /// @tparam PointSet point set type 
 template <typename PointSet>
@@ -0,0 +1,549 @@
+/**
+ * @file   ManhattanBoolean.h
+ * @brief  scanline boolean operations and sizing of manhattan shapes given as rectangles
+ *
+ * Shapes are unions of rectangles, which may overlap.
+ * The plane is cut into horizontal tiles, each tile is swept by a scanline in a thread,
+ * and rectangles split by tile seams are merged back afterwards.
+ * Polygons can be decomposed into rectangles by @ref limbo::geometry::polygon2rectangle first.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_MANHATTANBOOLEAN_H
+#define _LIMBO_GEOMETRY_MANHATTANBOOLEAN_H
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/geometry/Geometry.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.Geometry
+namespace geometry
+{
+
+/// @enum limbo::geometry::boolean_operation_type
+/// @brief boolean operations of two shapes A and B
+enum boolean_operation_type
+{
+	BOOLEAN_OR = 0, ///< union, A | B
+	BOOLEAN_AND = 1, ///< intersection, A & B
+	BOOLEAN_NOT = 2, ///< difference, A - B
+	BOOLEAN_XOR = 3 ///< symmetric difference, A ^ B
+};
+
+/**
+ * @class limbo::geometry::ManhattanBoolean
+ * @brief boolean operations and sizing of two manhattan shapes, each given by rectangles
+ *
+ * Results are disjoint rectangles of maximal horizontal extent, merged vertically when they have the same horizontal extent,
+ * sorted by bottom and then left. This form is unique for a shape,
+ * so results do not depend on the input decomposition, the number of tiles or the number of threads.
+ *
+ * @tparam RectangleType rectangle type of input and output
+ */
+template <typename RectangleType>
+class ManhattanBoolean
+{
+	public:
+		/// @brief rectangle type
+		typedef RectangleType rectangle_type;
+		/// @brief coordinate type
+		typedef typename rectangle_traits<rectangle_type>::coordinate_type coordinate_type;
+
+        /// @brief constructor
+		ManhattanBoolean() : m_num_threads(1), m_num_tiles(0) {}
+
+        /// @param n number of threads
+		void set_num_threads(unsigned int n) {m_num_threads = std::max(n, 1U);}
+        /// @param n number of horizontal tiles, 0 for 4 tiles per thread
+		void set_num_tiles(unsigned int n) {m_num_tiles = n;}
+        /**
+         * @brief add rectangles to a shape, rectangles with zero area are skipped
+         * @tparam Iterator iterator of rectangles
+         * @param first begin iterator
+         * @param last end iterator
+         * @param operand 0 for shape A, 1 for shape B
+         */
+		template <typename Iterator>
+		void add(Iterator first, Iterator last, unsigned int operand)
+		{
+			limboAssert(operand < 2);
+			typedef typename std::iterator_traits<Iterator>::value_type input_rectangle_type;
+			for (; first != last; ++first)
+			{
+				box_type box;
+				box.xl = rectangle_traits<input_rectangle_type>::get(*first, LEFT);
+				box.yl = rectangle_traits<input_rectangle_type>::get(*first, BOTTOM);
+				box.xh = rectangle_traits<input_rectangle_type>::get(*first, RIGHT);
+				box.yh = rectangle_traits<input_rectangle_type>::get(*first, TOP);
+				if (box.xl < box.xh && box.yl < box.yh)
+					m_vBox[operand].push_back(box);
+			}
+		}
+        /// @brief remove all rectangles of both shapes
+		void clear()
+		{
+			m_vBox[0].clear();
+			m_vBox[1].clear();
+		}
+        /**
+         * @brief boolean operation of shape A and shape B
+         * @param op operation
+         * @param vRect output rectangles
+         */
+		void run(boolean_operation_type op, std::vector<rectangle_type>& vRect) const
+		{
+			std::vector<box_type> vBox;
+			this->sweep(m_vBox[0], m_vBox[1], op, vBox);
+			this->output(vBox, vRect);
+		}
+        /**
+         * @brief size shape A, i.e., Minkowski sum with a square, or difference with a square if \a d is negative
+         * @param d distance to move each edge outward, inward if negative
+         * @param vRect output rectangles
+         */
+		void resize(coordinate_type d, std::vector<rectangle_type>& vRect) const
+		{
+			std::vector<box_type> vBox;
+			std::vector<box_type> const& vA = m_vBox[0];
+			if (d >= 0)
+			{
+				// bloating the rectangles bloats their union
+				std::vector<box_type> vBloat (vA);
+				bloat(vBloat, d);
+				this->sweep(vBloat, std::vector<box_type>(), BOOLEAN_OR, vBox);
+			}
+			else if (!vA.empty())
+			{
+				// shrinking A removes the bloated complement of A, and the complement only matters within -d of A
+				box_type bbox = vA.front();
+				for (typename std::vector<box_type>::const_iterator it = vA.begin(); it != vA.end(); ++it)
+				{
+					bbox.xl = std::min(bbox.xl, it->xl);
+					bbox.yl = std::min(bbox.yl, it->yl);
+					bbox.xh = std::max(bbox.xh, it->xh);
+					bbox.yh = std::max(bbox.yh, it->yh);
+				}
+				std::vector<box_type> vBox1 (1, bbox);
+				bloat(vBox1, -d);
+				std::vector<box_type> vComplement;
+				this->sweep(vBox1, vA, BOOLEAN_NOT, vComplement);
+				bloat(vComplement, -d);
+				this->sweep(vA, vComplement, BOOLEAN_NOT, vBox);
+			}
+			this->output(vBox, vRect);
+		}
+	protected:
+		/// @brief internal rectangle
+		struct box_type
+		{
+			coordinate_type xl; ///< left
+			coordinate_type yl; ///< bottom
+			coordinate_type xh; ///< right
+			coordinate_type yh; ///< top
+			/// @return true if \a rhs is lower, or at the same bottom but more to the left
+			bool operator<(box_type const& rhs) const {return yl < rhs.yl || (yl == rhs.yl && xl < rhs.xl);}
+		};
+		/// @brief an edge of a rectangle met by the scanline
+		struct event_type
+		{
+			coordinate_type y; ///< y of the edge
+			coordinate_type xl; ///< left
+			coordinate_type xh; ///< right
+			int operand; ///< 0 for shape A, 1 for shape B
+			int delta; ///< 1 for bottom edges, -1 for top edges
+			/// @return true if \a rhs is higher
+			bool operator<(event_type const& rhs) const {return y < rhs.y;}
+		};
+		/// @brief open rectangle of the scanline
+		struct open_type
+		{
+			coordinate_type xh; ///< right
+			coordinate_type yl; ///< bottom
+		};
+		/// @brief coverage of shape A and shape B on segments of the scanline by their left ends
+		typedef std::map<coordinate_type, std::pair<int, int> > segment_map_type;
+		/// @brief open rectangles by left
+		typedef std::map<coordinate_type, open_type> open_map_type;
+		/// @brief tiles shared by threads
+		struct task_type
+		{
+			ManhattanBoolean const* pBoolean; ///< engine
+			std::vector<box_type> const* vInput[2]; ///< shape A and shape B
+			boolean_operation_type op; ///< operation
+			std::vector<coordinate_type> vCut; ///< seams of tiles, tile i is [vCut[i], vCut[i+1])
+			std::vector<std::vector<std::size_t> > vTileBox[2]; ///< rectangles of each shape overlapping each tile
+			std::vector<std::vector<box_type> > vTileOutput; ///< result of each tile
+		};
+		/// @brief tiles run by limbo::containers::parallel_for
+		struct tile_kernel_type
+		{
+			task_type* task; ///< shared task
+			/// @param b first tile
+			/// @param e end tile
+			void operator()(std::size_t b, std::size_t e) const {task->pBoolean->work(*task, b, e);}
+		};
+
+        /**
+         * @brief move edges of rectangles outward
+         * @param vBox rectangles
+         * @param d distance
+         */
+		static void bloat(std::vector<box_type>& vBox, coordinate_type d)
+		{
+			for (typename std::vector<box_type>::iterator it = vBox.begin(); it != vBox.end(); ++it)
+			{
+				it->xl -= d;
+				it->yl -= d;
+				it->xh += d;
+				it->yh += d;
+			}
+		}
+        /**
+         * @param op operation
+         * @param a true if inside shape A
+         * @param b true if inside shape B
+         * @return true if inside the result
+         */
+		static bool inside(boolean_operation_type op, bool a, bool b)
+		{
+			switch (op)
+			{
+				case BOOLEAN_OR: return a || b;
+				case BOOLEAN_AND: return a && b;
+				case BOOLEAN_NOT: return a && !b;
+				case BOOLEAN_XOR: return a != b;
+				default: limboAssertMsg(0, "unknown boolean operation %d", op);
+			}
+			return false;
+		}
+        /**
+         * @brief convert internal rectangles to output rectangles
+         * @param vBox internal rectangles
+         * @param vRect output rectangles
+         */
+		static void output(std::vector<box_type> const& vBox, std::vector<rectangle_type>& vRect)
+		{
+			vRect.clear();
+			vRect.reserve(vBox.size());
+			for (typename std::vector<box_type>::const_iterator it = vBox.begin(); it != vBox.end(); ++it)
+				vRect.push_back(rectangle_traits<rectangle_type>::construct(it->xl, it->yl, it->xh, it->yh));
+		}
+        /**
+         * @brief boolean operation by tiles
+         * @param vA shape A
+         * @param vB shape B
+         * @param op operation
+         * @param vOutput result
+         */
+		void sweep(std::vector<box_type> const& vA, std::vector<box_type> const& vB, boolean_operation_type op, std::vector<box_type>& vOutput) const
+		{
+			vOutput.clear();
+			if (vA.empty() && vB.empty())
+				return;
+			task_type task;
+			task.pBoolean = this;
+			task.vInput[0] = &vA;
+			task.vInput[1] = &vB;
+			task.op = op;
+
+			// seams at quantiles of bottoms, so tiles have similar numbers of rectangles
+			std::vector<coordinate_type> vBottom;
+			coordinate_type yh = std::numeric_limits<coordinate_type>::min();
+			for (int s = 0; s < 2; ++s)
+				for (typename std::vector<box_type>::const_iterator it = task.vInput[s]->begin(); it != task.vInput[s]->end(); ++it)
+				{
+					vBottom.push_back(it->yl);
+					yh = std::max(yh, it->yh);
+				}
+			std::sort(vBottom.begin(), vBottom.end());
+			unsigned int numTiles = m_num_tiles? m_num_tiles : m_num_threads*4;
+			task.vCut.push_back(vBottom.front());
+			for (unsigned int i = 1; i < numTiles; ++i)
+			{
+				coordinate_type y = vBottom[vBottom.size()*i/numTiles];
+				if (y > task.vCut.back())
+					task.vCut.push_back(y);
+			}
+			task.vCut.push_back(yh);
+			numTiles = task.vCut.size()-1;
+			for (int s = 0; s < 2; ++s)
+			{
+				task.vTileBox[s].resize(numTiles);
+				for (std::size_t i = 0; i < task.vInput[s]->size(); ++i)
+				{
+					box_type const& box = (*task.vInput[s])[i];
+					std::size_t t = std::upper_bound(task.vCut.begin(), task.vCut.end(), box.yl)-task.vCut.begin()-1;
+					for (; t < numTiles && task.vCut[t] < box.yh; ++t)
+						task.vTileBox[s][t].push_back(i);
+				}
+			}
+			task.vTileOutput.resize(numTiles);
+
+			unsigned int numThreads = std::min(limbo::containers::num_threads(), m_num_threads);
+			tile_kernel_type kernel = {&task};
+			limbo::containers::parallel_for(0, numTiles, 1, numThreads, kernel);
+
+			// merge rectangles split by seams, i.e., with the same left and right, one ending and the other starting at a seam
+			typedef std::map<std::pair<coordinate_type, coordinate_type>, std::size_t> seam_map_type;
+			seam_map_type mSeam, mNextSeam;
+			for (unsigned int t = 0; t < numTiles; ++t)
+			{
+				mNextSeam.clear();
+				std::vector<box_type> const& vTileOutput = task.vTileOutput[t];
+				for (typename std::vector<box_type>::const_iterator it = vTileOutput.begin(); it != vTileOutput.end(); ++it)
+				{
+					std::pair<coordinate_type, coordinate_type> key (it->xl, it->xh);
+					typename seam_map_type::iterator itSeam = mSeam.end();
+					if (it->yl == task.vCut[t])
+						itSeam = mSeam.find(key);
+					std::size_t i = vOutput.size();
+					if (itSeam != mSeam.end())
+					{
+						i = itSeam->second;
+						vOutput[i].yh = it->yh;
+					}
+					else
+						vOutput.push_back(*it);
+					if (it->yh == task.vCut[t+1])
+						mNextSeam.insert(std::make_pair(key, i));
+				}
+				mSeam.swap(mNextSeam);
+			}
+			std::sort(vOutput.begin(), vOutput.end());
+		}
+        /**
+         * @brief sweep tiles in [first, last)
+         * @param task shared task
+         * @param first first tile
+         * @param last end tile
+         */
+		void work(task_type& task, std::size_t first, std::size_t last) const
+		{
+			std::vector<event_type> vEvent;
+			for (std::size_t t = first; t < last; ++t)
+			{
+				// rectangles clipped by the tile
+				vEvent.clear();
+				for (int s = 0; s < 2; ++s)
+				{
+					std::vector<std::size_t> const& vTileBox = task.vTileBox[s][t];
+					for (std::vector<std::size_t>::const_iterator it = vTileBox.begin(); it != vTileBox.end(); ++it)
+					{
+						box_type const& box = (*task.vInput[s])[*it];
+						event_type event;
+						event.xl = box.xl;
+						event.xh = box.xh;
+						event.operand = s;
+						event.y = std::max(box.yl, task.vCut[t]);
+						event.delta = 1;
+						vEvent.push_back(event);
+						event.y = std::min(box.yh, task.vCut[t+1]);
+						event.delta = -1;
+						vEvent.push_back(event);
+					}
+				}
+				this->sweep_tile(vEvent, task.op, task.vTileOutput[t]);
+			}
+		}
+        /**
+         * @brief sweep a tile from bottom to top
+         *
+         * Coverage of both shapes is kept in segments along the scanline.
+         * At each y, only spans touched by edges at y and the open rectangles overlapping them are updated,
+         * so an edge costs time in the number of segments under it instead of the width of the tile.
+         *
+         * @param vEvent edges of rectangles in the tile, sorted in place
+         * @param op operation
+         * @param vOutput result of the tile
+         */
+		void sweep_tile(std::vector<event_type>& vEvent, boolean_operation_type op, std::vector<box_type>& vOutput) const
+		{
+			segment_map_type mSegment; // coverage of shape A and shape B on [x, next x)
+			open_map_type mOpen; // open rectangles by left
+			std::vector<std::pair<coordinate_type, coordinate_type> > vSpan; // spans changed at y
+			std::vector<std::pair<coordinate_type, coordinate_type> > vInterval; // result in a span above y
+
+			std::sort(vEvent.begin(), vEvent.end());
+			for (std::size_t i = 0; i < vEvent.size(); )
+			{
+				coordinate_type y = vEvent[i].y;
+				vSpan.clear();
+				for (; i < vEvent.size() && vEvent[i].y == y; ++i)
+				{
+					event_type const& event = vEvent[i];
+					typename segment_map_type::iterator itl = split(mSegment, event.xl);
+					typename segment_map_type::iterator ith = split(mSegment, event.xh);
+					for (typename segment_map_type::iterator it = itl; it != ith; ++it)
+					{
+						if (event.operand == 0)
+							it->second.first += event.delta;
+						else
+							it->second.second += event.delta;
+					}
+					vSpan.push_back(std::make_pair(event.xl, event.xh));
+				}
+				std::sort(vSpan.begin(), vSpan.end());
+
+				for (std::size_t j = 0; j < vSpan.size(); )
+				{
+					// a span covering touching changes, extended to open rectangles overlapping or touching it,
+					// so that the result is outside right before and right after the span
+					coordinate_type lo = vSpan[j].first;
+					coordinate_type hi = vSpan[j].second;
+					typename open_map_type::iterator itOpen = mOpen.lower_bound(lo);
+					if (itOpen != mOpen.begin() && (--itOpen)->second.xh >= lo)
+						lo = itOpen->first;
+					for (++j; ; ++j)
+					{
+						itOpen = mOpen.upper_bound(hi);
+						if (itOpen != mOpen.begin() && (--itOpen)->second.xh > hi)
+							hi = itOpen->second.xh;
+						if (j == vSpan.size() || vSpan[j].first > hi)
+							break;
+						hi = std::max(hi, vSpan[j].second);
+					}
+
+					// maximal intervals of the result in the span, and merge segments with the same coverage
+					vInterval.clear();
+					typename segment_map_type::iterator itl = split(mSegment, lo);
+					typename segment_map_type::iterator ith = split(mSegment, hi);
+					std::pair<int, int> prev (0, 0);
+					if (itl != mSegment.begin())
+					{
+						typename segment_map_type::iterator itPrev = itl;
+						prev = (--itPrev)->second;
+					}
+					bool in = false;
+					coordinate_type xl = lo;
+					for (typename segment_map_type::iterator it = itl; ; )
+					{
+						bool nextIn = (it != ith) && inside(op, it->second.first > 0, it->second.second > 0);
+						if (!in && nextIn)
+							xl = it->first;
+						else if (in && !nextIn)
+							vInterval.push_back(std::make_pair(xl, it->first));
+						in = nextIn;
+						bool last = (it == ith);
+						typename segment_map_type::iterator itNext = it;
+						++itNext;
+						if (it->second == prev)
+							mSegment.erase(it);
+						else
+							prev = it->second;
+						if (last)
+							break;
+						it = itNext;
+					}
+
+					// close rectangles whose intervals change, and open new ones
+					std::size_t k = 0;
+					for (itOpen = mOpen.lower_bound(lo); itOpen != mOpen.end() && itOpen->first < hi; )
+					{
+						for (; k < vInterval.size() && vInterval[k].first < itOpen->first; ++k)
+							this->open(mOpen, vInterval[k], y);
+						if (k < vInterval.size() && vInterval[k].first == itOpen->first && vInterval[k].second == itOpen->second.xh)
+						{
+							++k;
+							++itOpen;
+						}
+						else
+						{
+							box_type box;
+							box.xl = itOpen->first;
+							box.yl = itOpen->second.yl;
+							box.xh = itOpen->second.xh;
+							box.yh = y;
+							vOutput.push_back(box);
+							mOpen.erase(itOpen++);
+						}
+					}
+					for (; k < vInterval.size(); ++k)
+						this->open(mOpen, vInterval[k], y);
+				}
+			}
+			limboAssert(mOpen.empty());
+		}
+        /**
+         * @brief make x a boundary of segments
+         * @param mSegment coverage of segments
+         * @param x x coordinate
+         * @return segment starting from x
+         */
+		static typename segment_map_type::iterator split(segment_map_type& mSegment, coordinate_type x)
+		{
+			typename segment_map_type::iterator it = mSegment.lower_bound(x);
+			if (it != mSegment.end() && it->first == x)
+				return it;
+			std::pair<int, int> count (0, 0);
+			if (it != mSegment.begin())
+			{
+				typename segment_map_type::iterator itPrev = it;
+				count = (--itPrev)->second;
+			}
+			return mSegment.insert(it, std::make_pair(x, count));
+		}
+        /**
+         * @brief open a rectangle
+         * @param mOpen open rectangles
+         * @param interval left and right
+         * @param y bottom
+         */
+		static void open(open_map_type& mOpen, std::pair<coordinate_type, coordinate_type> const& interval, coordinate_type y)
+		{
+			open_type& open = mOpen[interval.first];
+			open.xh = interval.second;
+			open.yl = y;
+		}
+
+		std::vector<box_type> m_vBox[2]; ///< rectangles of shape A and shape B
+		unsigned int m_num_threads; ///< number of threads
+		unsigned int m_num_tiles; ///< number of tiles, 0 for 4 tiles per thread
+};
+
+/// @brief boolean operation of two shapes given by rectangles
+/// @tparam RectangleType rectangle type
+/// @param vA rectangles of shape A
+/// @param vB rectangles of shape B
+/// @param op operation
+/// @param vRect output rectangles, see @ref limbo::geometry::ManhattanBoolean
+/// @param num_threads number of threads
+template <typename RectangleType>
+inline void manhattan_boolean(std::vector<RectangleType> const& vA, std::vector<RectangleType> const& vB, boolean_operation_type op,
+		std::vector<RectangleType>& vRect, unsigned int num_threads = 1)
+{
+	ManhattanBoolean<RectangleType> mb;
+	mb.set_num_threads(num_threads);
+	mb.add(vA.begin(), vA.end(), 0);
+	mb.add(vB.begin(), vB.end(), 1);
+	mb.run(op, vRect);
+}
+
+/// @brief size a shape given by rectangles
+/// @tparam RectangleType rectangle type
+/// @param vA rectangles of the shape
+/// @param d distance to move each edge outward, inward if negative
+/// @param vRect output rectangles, see @ref limbo::geometry::ManhattanBoolean
+/// @param num_threads number of threads
+template <typename RectangleType>
+inline void manhattan_resize(std::vector<RectangleType> const& vA, typename rectangle_traits<RectangleType>::coordinate_type d,
+		std::vector<RectangleType>& vRect, unsigned int num_threads = 1)
+{
+	ManhattanBoolean<RectangleType> mb;
+	mb.set_num_threads(num_threads);
+	mb.add(vA.begin(), vA.end(), 0);
+	mb.resize(d, vRect);
+}
+
+} // namespace geometry
+} // namespace limbo
+
+#endif
@@ -19,6 +19,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <iterator>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/classification.hpp>
@@ -679,6 +680,12 @@ class Polygon2Rectangle
 
 // a specialization for vectors 
 #include <limbo/geometry/Polygon2RectangleVec.h>
+// a sweep-line engine with the same output 
+#include <limbo/geometry/Polygon2RectangleSweep.h>
+// a converter reusing buffers across polygons 
+#include <limbo/geometry/Polygon2RectangleConverter.h>
+// partition into the minimum number of rectangles 
+#include <limbo/geometry/Polygon2RectangleMinimum.h>
 
 namespace limbo 
 { 
@@ -686,6 +693,10 @@ namespace geometry
 {
 
 /// @brief standby function for polygon-to-rectangle conversion 
+/// It gives the same rectangles as @ref limbo::geometry::Polygon2Rectangle. 
+/// Polygons with fewer than 1024 vertices run @ref limbo::geometry::Polygon2RectangleConverter, which has the least overhead, 
+/// and larger ones run @ref limbo::geometry::Polygon2RectangleSweep in O(n log n) time. 
+/// MIN_RECT_SLICING and MIN_RECT_FAST_SLICING run @ref limbo::geometry::Polygon2RectangleMinimum instead. 
 /// @tparam InputIterator represents the input iterators for points of polygon 
 /// @tparam PointSet represents the internal container for points of polygon, user needs to pass a hint for type deduction 
 /// @tparam RectSet represents the container for rectangles 
@@ -698,7 +709,56 @@ template <typename InputIterator, typename PointSet, typename RectSet>
 inline bool polygon2rectangle(InputIterator input_begin, InputIterator input_end, 
 		PointSet const&, RectSet& r, slicing_orientation_2d slicing_orient = HORIZONTAL_SLICING)
 {
-	Polygon2Rectangle<PointSet, RectSet> p2r (r, input_begin, input_end, slicing_orient);
+	if (slicing_orient == MIN_RECT_SLICING || slicing_orient == MIN_RECT_FAST_SLICING)
+	{
+		Polygon2RectangleMinimum<typename container_traits<PointSet>::value_type, typename container_traits<RectSet>::value_type> p2r (slicing_orient);
+		return p2r.convert(input_begin, input_end, std::inserter(r, r.end()));
+	}
+	if (std::distance(input_begin, input_end) < 1024)
+	{
+		Polygon2RectangleConverter<typename container_traits<PointSet>::value_type, typename container_traits<RectSet>::value_type> p2r (slicing_orient);
+		return p2r.convert(input_begin, input_end, std::inserter(r, r.end()));
+	}
+	Polygon2RectangleSweep<PointSet, RectSet> p2r (r, input_begin, input_end, slicing_orient);
+	if (!p2r()) return false;
+	return true;
+}
+
+/// @brief standby function for polygon-to-rectangle conversion of a polygon with holes 
+/// Holes are given as separate contours and handled natively by the engines, 
+/// so contours do not need to be concatenated into one point sequence with duplicate points. 
+/// Engines are chosen the same way as the function without holes. 
+/// @tparam InputIterator represents the input iterators for points of the outer contour 
+/// @tparam HoleIterator represents the input iterators for holes, each hole is a contour accessed by @ref limbo::geometry::contour_traits 
+/// @tparam PointSet represents the internal container for points of polygon, user needs to pass a hint for type deduction 
+/// @tparam RectSet represents the container for rectangles 
+/// @param input_begin begin iterator of the outer contour 
+/// @param input_end end iterator of the outer contour 
+/// @param hole_begin begin iterator of holes 
+/// @param hole_end end iterator of holes 
+/// @param r reference to container for rectangles 
+/// @param slicing_orient slicing orientations 
+/// @return true if succeed 
+template <typename InputIterator, typename HoleIterator, typename PointSet, typename RectSet>
+inline bool polygon2rectangle(InputIterator input_begin, InputIterator input_end, HoleIterator hole_begin, HoleIterator hole_end, 
+		PointSet const&, RectSet& r, slicing_orientation_2d slicing_orient = HORIZONTAL_SLICING)
+{
+	if (slicing_orient == MIN_RECT_SLICING || slicing_orient == MIN_RECT_FAST_SLICING)
+	{
+		Polygon2RectangleMinimum<typename container_traits<PointSet>::value_type, typename container_traits<RectSet>::value_type> p2r (slicing_orient);
+		return p2r.convert(input_begin, input_end, hole_begin, hole_end, std::inserter(r, r.end()));
+	}
+	typedef contour_traits<typename std::iterator_traits<HoleIterator>::value_type> hole_traits;
+	std::size_t num_points = std::distance(input_begin, input_end);
+	for (HoleIterator it = hole_begin; it != hole_end; ++it)
+		num_points += std::distance(hole_traits::begin(*it), hole_traits::end(*it));
+	if (num_points < 1024)
+	{
+		Polygon2RectangleConverter<typename container_traits<PointSet>::value_type, typename container_traits<RectSet>::value_type> p2r (slicing_orient);
+		return p2r.convert(input_begin, input_end, hole_begin, hole_end, std::inserter(r, r.end()));
+	}
+	Polygon2RectangleSweep<PointSet, RectSet> p2r (r, slicing_orient);
+	p2r.initialize(input_begin, input_end, hole_begin, hole_end);
 	if (!p2r()) return false;
 	return true;
 }
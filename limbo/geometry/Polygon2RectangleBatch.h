@@ -0,0 +1,213 @@
+/**
+ * @file   Polygon2RectangleBatch.h
+ * @brief  polygon-to-rectangle conversion of many polygons with threads
+ *
+ * Polygons are given in a CSR buffer, i.e., all vertices in one array and the offset of each polygon,
+ * such as all polygons of a layer in a GDSII database.
+ * Each thread converts polygons with its own @ref limbo::geometry::Polygon2RectangleConverter
+ * and @ref limbo::geometry::Polygon2RectangleSweep for large polygons,
+ * or @ref limbo::geometry::Polygon2RectangleMinimum for MIN_RECT_SLICING and MIN_RECT_FAST_SLICING,
+ * so memory of conversion is reused from polygon to polygon,
+ * and rectangles are collected into one array with the offset of each polygon.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_POLYGON2RECTANGLEBATCH_H
+#define _LIMBO_GEOMETRY_POLYGON2RECTANGLEBATCH_H
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/geometry/Polygon2RectangleSweep.h>
+#include <limbo/geometry/Polygon2RectangleConverter.h>
+#include <limbo/geometry/Polygon2RectangleMinimum.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.Geometry
+namespace geometry
+{
+
+/**
+ * @class limbo::geometry::Polygon2RectangleBatch
+ * @brief conversion of polygons in a CSR buffer with threads
+ *
+ * Polygon i has vertices [point_begin+offset[i], point_begin+offset[i+1]).
+ * Rectangles of polygon i are [vRectOffset[i], vRectOffset[i+1]) in the output, in the same order as @ref polygon2rectangle.
+ * The output does not depend on the number of threads.
+ *
+ * @tparam PointIterator random access iterator of vertices
+ * @tparam OffsetIterator random access iterator of offsets of polygons
+ * @tparam RectangleType rectangle type
+ */
+template <typename PointIterator, typename OffsetIterator, typename RectangleType>
+class Polygon2RectangleBatch
+{
+	public:
+		/// @brief point type
+		typedef typename std::iterator_traits<PointIterator>::value_type point_type;
+		/// @brief rectangle type
+		typedef RectangleType rectangle_type;
+		/// @brief engine of one thread for large polygons
+		typedef Polygon2RectangleSweep<std::vector<point_type>, std::vector<rectangle_type> > engine_type;
+		/// @brief converter of one thread for small polygons
+		typedef Polygon2RectangleConverter<point_type, rectangle_type> converter_type;
+		/// @brief converter of one thread for the minimum number of rectangles
+		typedef Polygon2RectangleMinimum<point_type, rectangle_type> minimum_type;
+
+        /**
+         * @brief constructor
+         * @param point_begin begin iterator of vertices
+         * @param offset_begin begin iterator of offsets
+         * @param offset_end end iterator of offsets, one more than the number of polygons
+         * @param slicing_orient slicing orientation
+         */
+		Polygon2RectangleBatch(PointIterator point_begin, OffsetIterator offset_begin, OffsetIterator offset_end, slicing_orientation_2d slicing_orient = HORIZONTAL_SLICING)
+            : m_point_begin(point_begin)
+            , m_offset_begin(offset_begin)
+            , m_num_polygons((offset_begin == offset_end)? 0 : std::distance(offset_begin, offset_end)-1)
+            , m_slicing_orient(slicing_orient)
+            , m_num_threads(1)
+            , m_chunk_size(64)
+            , m_sweep_threshold(1024)
+		{
+		}
+        /// @param n number of threads
+		void set_num_threads(unsigned int n) {m_num_threads = std::max(n, 1U);}
+        /// @param n number of polygons converted by a block at a time
+		void set_chunk_size(std::size_t n) {m_chunk_size = std::max(n, (std::size_t)1);}
+        /// @param n minimum number of vertices of a polygon to run the sweep-line engine
+		void set_sweep_threshold(std::size_t n) {m_sweep_threshold = n;}
+
+        /**
+         * @brief top api for @ref limbo::geometry::Polygon2RectangleBatch
+         * @param vRect rectangles of all polygons
+         * @param vRectOffset offsets of rectangles of each polygon, one more than the number of polygons
+         * @return number of polygons failed to convert, which have no rectangles
+         */
+		std::size_t operator()(std::vector<rectangle_type>& vRect, std::vector<std::size_t>& vRectOffset)
+		{
+			task_type task;
+			task.pBatch = this;
+			task.num_failed = 0;
+			task.vLocation.resize(m_num_polygons);
+			task.vChunkRect.resize((m_num_polygons+m_chunk_size-1)/m_chunk_size);
+
+			unsigned int numThreads = std::min(limbo::containers::num_threads(), m_num_threads);
+			chunk_kernel_type kernel = {&task};
+			limbo::containers::parallel_for(0, m_num_polygons, m_chunk_size, numThreads, kernel);
+
+			// collect rectangles in the order of polygons
+			vRectOffset.assign(m_num_polygons+1, 0);
+			for (std::size_t i = 0; i < m_num_polygons; ++i)
+				vRectOffset[i+1] = vRectOffset[i]+task.vLocation[i].count;
+			vRect.resize(vRectOffset.back());
+			for (std::size_t i = 0; i < m_num_polygons; ++i)
+			{
+				location_type const& loc = task.vLocation[i];
+				typename std::vector<rectangle_type>::const_iterator it = task.vChunkRect[i/m_chunk_size].begin()+loc.first;
+				std::copy(it, it+loc.count, vRect.begin()+vRectOffset[i]);
+			}
+			return task.num_failed;
+		}
+	protected:
+		/// @brief rectangles of a polygon in the buffer of its chunk
+		struct location_type
+		{
+			std::size_t first; ///< first rectangle in the buffer of the chunk
+			std::size_t count; ///< number of rectangles
+		};
+		/// @brief polygons shared by threads
+		struct task_type
+		{
+			Polygon2RectangleBatch const* pBatch; ///< conversion
+			std::size_t num_failed; ///< number of failed polygons
+			std::vector<location_type> vLocation; ///< rectangles of each polygon
+			std::vector<std::vector<rectangle_type> > vChunkRect; ///< rectangles converted in each chunk
+		};
+		/// @brief chunk of polygons run by limbo::containers::parallel_for
+		struct chunk_kernel_type
+		{
+			task_type* task; ///< shared task
+			/// @param b first polygon
+			/// @param e end polygon
+			void operator()(std::size_t b, std::size_t e) const {task->pBatch->work(*task, b, e);}
+		};
+
+        /**
+         * @brief convert a chunk of polygons into the buffer of the chunk
+         * @param task shared task
+         * @param first first polygon of the chunk
+         * @param last end polygon of the chunk
+         */
+		void work(task_type& task, std::size_t first, std::size_t last) const
+		{
+			std::vector<rectangle_type>& vRect = task.vChunkRect[first/m_chunk_size];
+			bool minimum = (m_slicing_orient == MIN_RECT_SLICING || m_slicing_orient == MIN_RECT_FAST_SLICING);
+			engine_type engine (vRect, minimum? HORIZONTAL_SLICING : m_slicing_orient);
+			converter_type converter (minimum? HORIZONTAL_SLICING : m_slicing_orient);
+			minimum_type minimumConverter (minimum? m_slicing_orient : MIN_RECT_SLICING);
+			for (std::size_t i = first; i < last; ++i)
+			{
+				location_type& loc = task.vLocation[i];
+				loc.first = vRect.size();
+				PointIterator input_begin = m_point_begin+m_offset_begin[i];
+				PointIterator input_end = m_point_begin+m_offset_begin[i+1];
+				bool ret = (input_end-input_begin >= 4);
+				if (ret && minimum)
+					ret = minimumConverter.convert(input_begin, input_end, std::back_inserter(vRect));
+				else if (ret && (std::size_t)(input_end-input_begin) < m_sweep_threshold)
+					ret = converter.convert(input_begin, input_end, std::back_inserter(vRect));
+				else if (ret)
+				{
+					engine.initialize(input_begin, input_end);
+					ret = engine();
+				}
+				if (!ret)
+				{
+					// drop partial rectangles of a failed polygon
+					vRect.resize(loc.first);
+					__sync_fetch_and_add(&task.num_failed, 1);
+				}
+					loc.count = vRect.size()-loc.first;
+			}
+		}
+
+		PointIterator m_point_begin; ///< begin iterator of vertices
+		OffsetIterator m_offset_begin; ///< begin iterator of offsets
+		std::size_t m_num_polygons; ///< number of polygons
+		slicing_orientation_2d m_slicing_orient; ///< slicing orient
+		unsigned int m_num_threads; ///< number of threads
+		std::size_t m_chunk_size; ///< number of polygons converted by a block at a time
+		std::size_t m_sweep_threshold; ///< minimum number of vertices of a polygon to run the sweep-line engine
+};
+
+/// @brief convert polygons in a CSR buffer to rectangles with threads
+/// @tparam PointIterator random access iterator of vertices
+/// @tparam OffsetIterator random access iterator of offsets of polygons
+/// @tparam RectangleType rectangle type
+/// @param point_begin begin iterator of vertices
+/// @param offset_begin begin iterator of offsets, polygon i has vertices [point_begin+offset[i], point_begin+offset[i+1])
+/// @param offset_end end iterator of offsets, one more than the number of polygons
+/// @param vRect rectangles of all polygons
+/// @param vRectOffset rectangles of polygon i are [vRectOffset[i], vRectOffset[i+1])
+/// @param slicing_orient slicing orientation
+/// @param num_threads number of threads
+/// @return true if all polygons are converted, failed polygons have no rectangles
+template <typename PointIterator, typename OffsetIterator, typename RectangleType>
+inline bool polygon2rectangle_batch(PointIterator point_begin, OffsetIterator offset_begin, OffsetIterator offset_end,
+		std::vector<RectangleType>& vRect, std::vector<std::size_t>& vRectOffset,
+		slicing_orientation_2d slicing_orient = HORIZONTAL_SLICING, unsigned int num_threads = 1)
+{
+	Polygon2RectangleBatch<PointIterator, OffsetIterator, RectangleType> p2r (point_begin, offset_begin, offset_end, slicing_orient);
+	p2r.set_num_threads(num_threads);
+	return p2r(vRect, vRectOffset) == 0;
+}
+
+} // namespace geometry
+} // namespace limbo
+
+#endif
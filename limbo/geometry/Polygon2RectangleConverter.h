@@ -0,0 +1,382 @@
+/**
+ * @file   Polygon2RectangleConverter.h
+ * @brief  a reusable polygon-to-rectangle converter for many small polygons
+ *
+ * @ref limbo::geometry::Polygon2Rectangle allocates its point sets for every polygon.
+ * This converter runs the same algorithm with the same output,
+ * but keeps points of each sorting orientation in flat arrays owned by the converter,
+ * so they are reused from polygon to polygon and converting a polygon usually allocates nothing.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_POLYGON2RECTANGLECONVERTER_H
+#define _LIMBO_GEOMETRY_POLYGON2RECTANGLECONVERTER_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limbo/geometry/Geometry.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.Geometry
+namespace geometry
+{
+
+/**
+ * @class limbo::geometry::Polygon2RectangleConverter
+ * @brief a converter from manhattan polygons to rectangles reusing its buffers across polygons
+ *
+ * Usage:
+ * ~~~~~~~~~~~~~~~~
+ * Polygon2RectangleConverter<Point, Rectangle> converter (HOR_VER_SLICING);
+ * for (each polygon)
+ *     converter.convert(polygon.begin(), polygon.end(), std::back_inserter(vRect));
+ * ~~~~~~~~~~~~~~~~
+ * The output is identical to @ref limbo::geometry::Polygon2Rectangle.
+ * Holes can be given as separate contours,
+ * e.g., converter.convert(polygon.begin(), polygon.end(), polygon.begin_holes(), polygon.end_holes(), out).
+ * Points are stored as (primary, secondary) coordinates of each sorting orientation,
+ * and sorting is skipped if the vertices are already in order.
+ *
+ * @tparam PointType point type of input polygons
+ * @tparam RectangleType rectangle type of output
+ */
+template <typename PointType, typename RectangleType>
+class Polygon2RectangleConverter
+{
+	public:
+		/// @brief point type
+		typedef PointType point_type;
+		/// @brief rectangle type
+		typedef RectangleType rectangle_type;
+		/// @brief coordinate type
+		typedef typename point_traits<point_type>::coordinate_type coordinate_type;
+		/// @brief coordinate distance type
+        typedef typename coordinate_traits<coordinate_type>::coordinate_distance coordinate_distance;
+
+        /**
+         * @brief constructor
+         * @param slicing_orient slicing orientation
+         */
+		explicit Polygon2RectangleConverter(slicing_orientation_2d slicing_orient = HORIZONTAL_SLICING)
+		{
+			this->reset(slicing_orient);
+		}
+        /**
+         * @brief set slicing orientation and clear points, keeping memory of buffers
+         * @param slicing_orient slicing orientation
+         */
+		void reset(slicing_orientation_2d slicing_orient)
+		{
+			m_slicing_orient = slicing_orient;
+			switch (slicing_orient)
+			{
+				case HORIZONTAL_SLICING:
+					m_num_orients = 1;
+					m_vOrient[0] = VERTICAL;
+					break;
+				case VERTICAL_SLICING:
+					m_num_orients = 1;
+					m_vOrient[0] = HORIZONTAL;
+					break;
+				case HOR_VER_SLICING:
+                case HOR_VER_SA_SLICING:
+                case HOR_VER_AR_SLICING:
+					m_num_orients = 2;
+					m_vOrient[0] = HORIZONTAL;
+					m_vOrient[1] = VERTICAL;
+					break;
+				default:
+					limboAssertMsg(0, "unknown slicing orientation %d", slicing_orient);
+			}
+			m_vTmpPoint.clear();
+			m_vPoint[0].clear();
+			m_vPoint[1].clear();
+		}
+        /// @return slicing orientation
+		slicing_orientation_2d slicing_orient() const {return m_slicing_orient;}
+
+        /**
+         * @brief convert a polygon
+         * @tparam InputIterator forward iterator of points, ordered clockwise or counterclockwise
+         * @tparam OutputIterator output iterator of rectangles
+         * @param first begin iterator of points
+         * @param last end iterator of points
+         * @param out output iterator of rectangles
+         * @return true if succeed, rectangles found before a failure are still written
+         */
+		template <typename InputIterator, typename OutputIterator>
+		bool convert(InputIterator first, InputIterator last, OutputIterator out)
+		{
+			if (first == last)
+				return false;
+			m_vTmpPoint.clear();
+			this->collect(first, last);
+			this->initialize();
+			return this->run(out);
+		}
+        /**
+         * @brief convert a polygon with holes
+         * Contours are collected one by one without copying into a single point sequence,
+         * and holes are kept as vertices of the same point set.
+         * @tparam InputIterator forward iterator of points of the outer contour
+         * @tparam HoleIterator forward iterator of holes, each hole is a contour accessed by @ref limbo::geometry::contour_traits
+         * @tparam OutputIterator output iterator of rectangles
+         * @param first begin iterator of points of the outer contour
+         * @param last end iterator of points of the outer contour
+         * @param hole_first begin iterator of holes
+         * @param hole_last end iterator of holes
+         * @param out output iterator of rectangles
+         * @return true if succeed, rectangles found before a failure are still written
+         */
+		template <typename InputIterator, typename HoleIterator, typename OutputIterator>
+		bool convert(InputIterator first, InputIterator last, HoleIterator hole_first, HoleIterator hole_last, OutputIterator out)
+		{
+			if (first == last)
+				return false;
+			m_vTmpPoint.clear();
+			this->collect(first, last);
+			for (; hole_first != hole_last; ++hole_first)
+				this->collect(contour_traits<typename std::iterator_traits<HoleIterator>::value_type>::begin(*hole_first),
+						contour_traits<typename std::iterator_traits<HoleIterator>::value_type>::end(*hole_first));
+			this->initialize();
+			return this->run(out);
+		}
+	protected:
+		/// @brief coordinates of a point, (x, y) or (primary, secondary) of a sorting orientation
+		typedef std::pair<coordinate_type, coordinate_type> xy_type;
+
+        /**
+         * @brief convert collected points
+         * @tparam OutputIterator output iterator of rectangles
+         * @param out output iterator of rectangles
+         * @return true if succeed
+         */
+		template <typename OutputIterator>
+		bool run(OutputIterator out)
+		{
+			rectangle_type vRect[2];
+			while (!m_vPoint[0].empty())
+			{
+				for (unsigned int i = 0; i < m_num_orients; ++i)
+				{
+					xy_type Pk, Pl, Pm;
+					if (!this->find_Pk_Pl_Pm(Pk, Pl, Pm, m_vPoint[i]))
+						return false;
+					// (primary, secondary) to (x, y)
+					if (m_vOrient[i] == VERTICAL)
+					{
+						std::swap(Pk.first, Pk.second);
+						std::swap(Pl.first, Pl.second);
+						std::swap(Pm.first, Pm.second);
+					}
+					vRect[i] = rectangle_traits<rectangle_type>::construct(Pk.first, Pk.second,
+							std::max(Pl.first, Pm.first), std::max(Pl.second, Pm.second));
+				}
+				// choose rectangle with the same heuristic as Polygon2Rectangle
+				rectangle_type const* pRect = &vRect[0];
+				if (m_num_orients == 2 && this->better(vRect[1], vRect[0]))
+					pRect = &vRect[1];
+				coordinate_type xl = this->get(*pRect, LEFT), yl = this->get(*pRect, BOTTOM);
+				coordinate_type xh = this->get(*pRect, RIGHT), yh = this->get(*pRect, TOP);
+				// insert or remove corners
+				for (unsigned int i = 0; i < m_num_orients; ++i)
+				{
+					this->F(xl, yl, i);
+					this->F(xl, yh, i);
+					this->F(xh, yl, i);
+					this->F(xh, yh, i);
+				}
+				*out++ = *pRect;
+			}
+
+			return true;
+		}
+        /**
+         * @brief get coordinate from point
+         * @param p point
+         * @param o orientation
+         * @return coordinate
+         */
+		template <typename P>
+		inline coordinate_type get(P const& p, orientation_2d o) const {return point_traits<P>::get(p, o);}
+        /**
+         * @brief get coordinate from rectangle
+         * @param r rectangle
+         * @param d direction
+         * @return coordinate
+         */
+		inline coordinate_type get(rectangle_type const& r, direction_2d d) const {return rectangle_traits<rectangle_type>::get(r, d);}
+
+        /**
+         * @brief collect vertices of a contour into m_vTmpPoint
+         * Vertices are cleaned up the same way as @ref limbo::geometry::Polygon2Rectangle.
+         * @tparam InputIterator forward iterator of points
+         * @param input_begin begin iterator of points
+         * @param input_end end iterator of points
+         */
+		template <typename InputIterator>
+		void collect(InputIterator input_begin, InputIterator input_end)
+		{
+			// identical vertices and extra vertices in the same line are skipped
+			if (input_begin == input_end)
+				return;
+            InputIterator input_last = input_begin;
+            std::size_t dist = std::distance(input_begin, input_end);
+            std::advance(input_last, dist-1);
+			if (this->get(*input_begin, HORIZONTAL) == this->get(*input_last, HORIZONTAL)
+					&& this->get(*input_begin, VERTICAL) == this->get(*input_last, VERTICAL)) // skip identical first and last points
+                ++input_begin;
+			for (InputIterator itPrev = input_begin; itPrev != input_end; ++itPrev)
+			{
+				InputIterator itCur = itPrev;
+				++itCur;
+				if (itCur == input_end)
+					itCur = input_begin;
+				InputIterator itNext = itCur;
+				++itNext;
+				if (itNext == input_end)
+					itNext = input_begin;
+
+				coordinate_type xp = this->get(*itPrev, HORIZONTAL), yp = this->get(*itPrev, VERTICAL);
+				coordinate_type xc = this->get(*itCur, HORIZONTAL), yc = this->get(*itCur, VERTICAL);
+				coordinate_type xn = this->get(*itNext, HORIZONTAL), yn = this->get(*itNext, VERTICAL);
+				if (xc == xn && yc == yn) // identical vertices
+					continue;
+				if ((xp == xc && xc == xn) || (yp == yc && yc == yn)) // extra vertices in the same line
+					continue;
+				if (m_vOrient[0] == HORIZONTAL)
+					m_vTmpPoint.push_back(xy_type(xc, yc));
+				else
+					m_vTmpPoint.push_back(xy_type(yc, xc));
+			}
+		}
+        /**
+         * @brief sort collected vertices into flat arrays of each sorting orientation
+         * Points appearing more than once are removed, so contours become a polygon with holes.
+         */
+		void initialize()
+		{
+			// 1. sort in the first orientation and remove points that appear more than once
+			this->sort(m_vTmpPoint);
+			std::vector<xy_type>& vPoint = m_vPoint[0];
+			vPoint.clear();
+			for (typename std::vector<xy_type>::iterator itCur = m_vTmpPoint.begin(), itCure = m_vTmpPoint.end(); itCur != itCure; ++itCur)
+			{
+				typename std::vector<xy_type>::iterator itNext = itCur;
+				++itNext;
+				if (itNext == itCure)
+					itNext = m_vTmpPoint.begin();
+				if (*itCur != *itNext)
+					vPoint.push_back(*itCur);
+				else
+				{
+					++itCur;
+					if (itCur == itCure) break;
+				}
+			}
+
+			// 2. copy to the second orientation with primary and secondary coordinates swapped
+			if (m_num_orients == 2)
+			{
+				m_vPoint[1].resize(vPoint.size());
+				for (std::size_t i = 0; i < vPoint.size(); ++i)
+					m_vPoint[1][i] = xy_type(vPoint[i].second, vPoint[i].first);
+				this->sort(m_vPoint[1]);
+			}
+		}
+        /**
+         * @brief sort points unless they are already in order
+         * @param vPoint points
+         */
+		static void sort(std::vector<xy_type>& vPoint)
+		{
+			// adjacent_find with greater finds the first descent
+			if (std::adjacent_find(vPoint.begin(), vPoint.end(), std::greater<xy_type>()) != vPoint.end())
+				std::sort(vPoint.begin(), vPoint.end());
+		}
+        /**
+         * @brief find Pk, Pl, Pm, please refer to the paper for definition
+         * @param Pk the leftmost of the lowest points
+         * @param Pl the next leftmost of the lowest points
+         * @param Pm 1) Xk <= Xm <= Xl
+         *           2) Ym is lowest but Ym > Yk
+         * @param vPoint sorted (primary, secondary) coordinates of points
+         * @return false if there are fewer than 4 points or no Pm
+         */
+		static bool find_Pk_Pl_Pm(xy_type& Pk, xy_type& Pl, xy_type& Pm, std::vector<xy_type> const& vPoint)
+		{
+			if (vPoint.size() < 4)
+				return false;
+			Pk = vPoint[0];
+			Pl = vPoint[1];
+			for (typename std::vector<xy_type>::const_iterator it = vPoint.begin()+1, ite = vPoint.end(); it != ite; ++it)
+			{
+				if (it->first != Pk.first && Pk.second <= it->second && it->second <= Pl.second)
+				{
+					Pm = *it;
+					return true;
+				}
+			}
+			return false;
+		}
+        /**
+         * @brief F function in the original paper
+         * remove point if found, otherwise insert
+         * @param x x coordinate
+         * @param y y coordinate
+         * @param i index of sorting orientation
+         */
+		void F(coordinate_type x, coordinate_type y, unsigned int i)
+		{
+			std::vector<xy_type>& vPoint = m_vPoint[i];
+			xy_type point = (m_vOrient[i] == HORIZONTAL)? xy_type(x, y) : xy_type(y, x);
+			typename std::vector<xy_type>::iterator itr = std::lower_bound(vPoint.begin(), vPoint.end(), point);
+			if (itr == vPoint.end() || *itr != point) // not found, insert point
+				vPoint.insert(itr, point);
+			else // found, remove point
+				vPoint.erase(itr);
+		}
+        /**
+         * @brief heuristic of hybrid slicing orientations
+         * @param rect rectangle from the second orientation
+         * @param ref rectangle from the first orientation
+         * @return true if \a rect is chosen over \a ref
+         */
+		bool better(rectangle_type const& rect, rectangle_type const& ref) const
+		{
+            coordinate_distance w = this->get(rect, RIGHT)-this->get(rect, LEFT);
+            coordinate_distance h = this->get(rect, TOP)-this->get(rect, BOTTOM);
+            coordinate_distance wref = this->get(ref, RIGHT)-this->get(ref, LEFT);
+            coordinate_distance href = this->get(ref, TOP)-this->get(ref, BOTTOM);
+            switch (m_slicing_orient)
+            {
+                case HOR_VER_SLICING:
+                    return w*h > wref*href; // choose large area
+                case HOR_VER_SA_SLICING:
+                    return w*h < wref*href; // choose small area
+                case HOR_VER_AR_SLICING:
+                    // avoid rectangle with bad aspect ratio, compare max/min without division
+                    return std::max(w, h)*std::min(wref, href) < std::min(w, h)*std::max(wref, href);
+                default:
+                    limboAssertMsg(0, "should not reach here %d", m_slicing_orient);
+            }
+            return false;
+		}
+
+        slicing_orientation_2d m_slicing_orient; ///< slicing orient
+        unsigned int m_num_orients; ///< number of sorting orientations, 1 or 2
+        orientation_2d m_vOrient[2]; ///< sorting orientations, HORIZONTAL sorts by x then y
+        std::vector<xy_type> m_vTmpPoint; ///< scratch of input vertices
+        std::vector<xy_type> m_vPoint[2]; ///< (primary, secondary) coordinates of points sorted in each orientation
+};
+
+} // namespace geometry
+} // namespace limbo
+
+#endif
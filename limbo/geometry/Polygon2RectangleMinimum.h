@@ -0,0 +1,706 @@
+/**
+ * @file   Polygon2RectangleMinimum.h
+ * @brief  partition of a manhattan polygon into the minimum number of rectangles
+ *
+ * A chord joins two concave vertices on the same horizontal or vertical line through the interior of the polygon.
+ * The minimum number of rectangles is N - L + 1 - H, where N is the number of concave vertices,
+ * H is the number of holes, and L is the maximum number of chords no two of which intersect
+ * (W.T. Liou, J.J.M. Tan and R.C.T. Lee, Minimum Partitioning Simple Rectilinear Polygons in O(n log log n) Time, SCG 1989).
+ * Horizontal and vertical chords form a bipartite intersection graph,
+ * so the non-intersecting chords are the maximum independent set from a maximum matching (Hopcroft-Karp) by Konig's theorem.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_POLYGON2RECTANGLEMINIMUM_H
+#define _LIMBO_GEOMETRY_POLYGON2RECTANGLEMINIMUM_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <limbo/geometry/Geometry.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.Geometry
+namespace geometry
+{
+
+/**
+ * @class limbo::geometry::Polygon2RectangleMinimum
+ * @brief a converter from manhattan polygons to the fewest rectangles, reusing its buffers across polygons
+ *
+ * Usage:
+ * ~~~~~~~~~~~~~~~~
+ * Polygon2RectangleMinimum<Point, Rectangle> converter (MIN_RECT_SLICING);
+ * for (each polygon)
+ *     converter.convert(polygon.begin(), polygon.end(), std::back_inserter(vRect));
+ * ~~~~~~~~~~~~~~~~
+ * Vertices are cleaned up the same way as @ref limbo::geometry::Polygon2Rectangle,
+ * so a contour with duplicate points forms a polygon with holes.
+ * Holes can also be given as separate contours,
+ * e.g., converter.convert(polygon.begin(), polygon.end(), polygon.begin_holes(), polygon.end_holes(), out).
+ *
+ * Steps:
+ * 1. pair vertices on each line into edges and find concave vertices and chords with sweeps;
+ * 2. choose non-intersecting chords, optimally for MIN_RECT_SLICING,
+ *    or greedily by fewest intersections for MIN_RECT_FAST_SLICING;
+ * 3. cut the polygon along chosen vertical chords, and extend the other concave vertices horizontally.
+ *    Chosen horizontal chords are exactly two such extensions meeting,
+ *    so only vertical chords are cut explicitly, and rectangles are maximal runs of identical intervals of a bottom-up sweep.
+ *
+ * Rectangles are written in the order of bottom, then left.
+ *
+ * @tparam PointType point type of input polygons
+ * @tparam RectangleType rectangle type of output
+ */
+template <typename PointType, typename RectangleType>
+class Polygon2RectangleMinimum
+{
+	public:
+		/// @brief point type
+		typedef PointType point_type;
+		/// @brief rectangle type
+		typedef RectangleType rectangle_type;
+		/// @brief coordinate type
+		typedef typename point_traits<point_type>::coordinate_type coordinate_type;
+
+        /**
+         * @brief constructor
+         * @param slicing_orient MIN_RECT_SLICING or MIN_RECT_FAST_SLICING
+         */
+		explicit Polygon2RectangleMinimum(slicing_orientation_2d slicing_orient = MIN_RECT_SLICING)
+		{
+			this->reset(slicing_orient);
+		}
+        /**
+         * @brief set slicing orientation, keeping memory of buffers
+         * @param slicing_orient MIN_RECT_SLICING or MIN_RECT_FAST_SLICING
+         */
+		void reset(slicing_orientation_2d slicing_orient)
+		{
+			limboAssertMsg(slicing_orient == MIN_RECT_SLICING || slicing_orient == MIN_RECT_FAST_SLICING,
+					"unknown slicing orientation %d", slicing_orient);
+			m_slicing_orient = slicing_orient;
+		}
+        /// @return slicing orientation
+		slicing_orientation_2d slicing_orient() const {return m_slicing_orient;}
+
+        /**
+         * @brief convert a polygon
+         * @tparam InputIterator forward iterator of points, ordered clockwise or counterclockwise
+         * @tparam OutputIterator output iterator of rectangles
+         * @param first begin iterator of points
+         * @param last end iterator of points
+         * @param out output iterator of rectangles
+         * @return true if succeed, nothing is written on failure
+         */
+		template <typename InputIterator, typename OutputIterator>
+		bool convert(InputIterator first, InputIterator last, OutputIterator out)
+		{
+			if (first == last)
+				return false;
+			m_vTmpPoint.clear();
+			this->collect(first, last);
+			return this->run(out);
+		}
+        /**
+         * @brief convert a polygon with holes
+         * Contours are collected one by one without copying into a single point sequence,
+         * and holes are kept as vertices of the same point set.
+         * @tparam InputIterator forward iterator of points of the outer contour
+         * @tparam HoleIterator forward iterator of holes, each hole is a contour accessed by @ref limbo::geometry::contour_traits
+         * @tparam OutputIterator output iterator of rectangles
+         * @param first begin iterator of points of the outer contour
+         * @param last end iterator of points of the outer contour
+         * @param hole_first begin iterator of holes
+         * @param hole_last end iterator of holes
+         * @param out output iterator of rectangles
+         * @return true if succeed, nothing is written on failure
+         */
+		template <typename InputIterator, typename HoleIterator, typename OutputIterator>
+		bool convert(InputIterator first, InputIterator last, HoleIterator hole_first, HoleIterator hole_last, OutputIterator out)
+		{
+			if (first == last)
+				return false;
+			m_vTmpPoint.clear();
+			this->collect(first, last);
+			for (; hole_first != hole_last; ++hole_first)
+				this->collect(contour_traits<typename std::iterator_traits<HoleIterator>::value_type>::begin(*hole_first),
+						contour_traits<typename std::iterator_traits<HoleIterator>::value_type>::end(*hole_first));
+			return this->run(out);
+		}
+	protected:
+		/// @brief coordinates of a point
+		typedef std::pair<coordinate_type, coordinate_type> xy_type;
+		/// @brief a chord by its vertices, in increasing coordinate along the chord
+		typedef std::pair<std::size_t, std::size_t> chord_type;
+		/// @brief a vertex of the polygon
+		struct vertex_type
+		{
+			coordinate_type c[2]; ///< x and y
+			int dir[2]; ///< direction of the horizontal edge in x and of the vertical edge in y, 1 or -1
+			bool concave; ///< true if the interior angle is 270 degrees
+		};
+		/// @brief a vertical wall, i.e., a vertical edge or a chosen vertical chord, starting or ending
+		struct event_type
+		{
+			coordinate_type y; ///< y of the event
+			int add; ///< 0 for ending, 1 for starting, so endings come first
+			coordinate_type x; ///< x of the wall
+			bool boundary; ///< true for an edge, false for a chord
+			/// @brief order by y, then endings before startings, then x
+			bool operator<(event_type const& rhs) const {return y < rhs.y || (y == rhs.y && (add < rhs.add || (add == rhs.add && x < rhs.x)));}
+		};
+		/// @brief an open or closed rectangle
+		struct box_type
+		{
+			coordinate_type xl; ///< left
+			coordinate_type yl; ///< bottom
+			coordinate_type xh; ///< right
+			coordinate_type yh; ///< top
+			/// @brief order by bottom, then left
+			bool operator<(box_type const& rhs) const {return yl < rhs.yl || (yl == rhs.yl && xl < rhs.xl);}
+		};
+		/// @brief compare vertices by coordinates of an axis, then the other axis
+		struct vertex_compare_type
+		{
+			std::vector<vertex_type> const* pVertex; ///< vertices
+			int axis; ///< first axis
+			/// @brief compare
+			bool operator()(std::size_t i, std::size_t j) const
+			{
+				vertex_type const& vi = (*pVertex)[i];
+				vertex_type const& vj = (*pVertex)[j];
+				return vi.c[axis] < vj.c[axis] || (vi.c[axis] == vj.c[axis] && vi.c[1-axis] < vj.c[1-axis]);
+			}
+		};
+
+        /**
+         * @brief partition collected points
+         * @tparam OutputIterator output iterator of rectangles
+         * @param out output iterator of rectangles
+         * @return true if succeed
+         */
+		template <typename OutputIterator>
+		bool run(OutputIterator out)
+		{
+			if (!this->initialize())
+				return false;
+			m_vChord[HORIZONTAL].clear();
+			m_vChord[VERTICAL].clear();
+			// concave vertices are known after the first sweep, so chords are filtered afterwards
+			this->sweep(HORIZONTAL);
+			this->sweep(VERTICAL);
+			for (int o = 0; o < 2; ++o)
+			{
+				std::vector<chord_type>& vChord = m_vChord[o];
+				std::size_t n = 0;
+				for (std::size_t i = 0; i < vChord.size(); ++i)
+					if (m_vVertex[vChord[i].first].concave && m_vVertex[vChord[i].second].concave)
+						vChord[n++] = vChord[i];
+				vChord.resize(n);
+			}
+			this->build_graph();
+			if (m_slicing_orient == MIN_RECT_SLICING)
+				this->choose_chords();
+			else
+				this->choose_chords_greedy();
+			if (!this->partition())
+				return false;
+			for (typename std::vector<box_type>::const_iterator it = m_vBox.begin(); it != m_vBox.end(); ++it)
+				*out++ = rectangle_traits<rectangle_type>::construct(it->xl, it->yl, it->xh, it->yh);
+			return true;
+		}
+        /**
+         * @brief collect vertices of a contour into m_vTmpPoint,
+         * identical vertices and extra vertices in the same line are skipped
+         * @tparam InputIterator forward iterator of points
+         * @param input_begin begin iterator of points
+         * @param input_end end iterator of points
+         */
+		template <typename InputIterator>
+		void collect(InputIterator input_begin, InputIterator input_end)
+		{
+			if (input_begin == input_end)
+				return;
+            InputIterator input_last = input_begin;
+            std::size_t dist = std::distance(input_begin, input_end);
+            std::advance(input_last, dist-1);
+			if (point_traits<point_type>::get(*input_begin, HORIZONTAL) == point_traits<point_type>::get(*input_last, HORIZONTAL)
+					&& point_traits<point_type>::get(*input_begin, VERTICAL) == point_traits<point_type>::get(*input_last, VERTICAL)) // skip identical first and last points
+                ++input_begin;
+			for (InputIterator itPrev = input_begin; itPrev != input_end; ++itPrev)
+			{
+				InputIterator itCur = itPrev;
+				++itCur;
+				if (itCur == input_end)
+					itCur = input_begin;
+				InputIterator itNext = itCur;
+				++itNext;
+				if (itNext == input_end)
+					itNext = input_begin;
+
+				coordinate_type xp = point_traits<point_type>::get(*itPrev, HORIZONTAL), yp = point_traits<point_type>::get(*itPrev, VERTICAL);
+				coordinate_type xc = point_traits<point_type>::get(*itCur, HORIZONTAL), yc = point_traits<point_type>::get(*itCur, VERTICAL);
+				coordinate_type xn = point_traits<point_type>::get(*itNext, HORIZONTAL), yn = point_traits<point_type>::get(*itNext, VERTICAL);
+				if (xc == xn && yc == yn) // identical vertices
+					continue;
+				if ((xp == xc && xc == xn) || (yp == yc && yc == yn)) // extra vertices in the same line
+					continue;
+				m_vTmpPoint.push_back(xy_type(xc, yc));
+			}
+		}
+        /**
+         * @brief pair collected vertices into edges
+         * Points appearing more than once are removed, so contours become a polygon with holes.
+         * @return false if vertices cannot form a manhattan polygon
+         */
+		bool initialize()
+		{
+			// 1. sort by x, then y, and remove points that appear more than once
+			std::sort(m_vTmpPoint.begin(), m_vTmpPoint.end());
+			m_vVertex.clear();
+			for (typename std::vector<xy_type>::iterator itCur = m_vTmpPoint.begin(), itCure = m_vTmpPoint.end(); itCur != itCure; ++itCur)
+			{
+				typename std::vector<xy_type>::iterator itNext = itCur;
+				++itNext;
+				if (itNext == itCure)
+					itNext = m_vTmpPoint.begin();
+				if (*itCur != *itNext)
+				{
+					vertex_type v;
+					v.c[HORIZONTAL] = itCur->first;
+					v.c[VERTICAL] = itCur->second;
+					v.dir[HORIZONTAL] = v.dir[VERTICAL] = 0;
+					v.concave = false;
+					m_vVertex.push_back(v);
+				}
+				else
+				{
+					++itCur;
+					if (itCur == itCure) break;
+				}
+			}
+			if (m_vVertex.size() < 4)
+				return false;
+
+			// 2. m_vOrder[o] sorts vertices by the other axis, then axis o, so edges of orientation o are consecutive pairs
+			for (int o = 0; o < 2; ++o)
+			{
+				std::vector<std::size_t>& vOrder = m_vOrder[o];
+				vOrder.resize(m_vVertex.size());
+				for (std::size_t i = 0; i < vOrder.size(); ++i)
+					vOrder[i] = i;
+				vertex_compare_type cmp;
+				cmp.pVertex = &m_vVertex;
+				cmp.axis = 1-o;
+				if (o == HORIZONTAL) // vertices are already sorted by x, then y
+					std::sort(vOrder.begin(), vOrder.end(), cmp);
+				for (std::size_t i = 0; i < vOrder.size(); i += 2)
+				{
+					if (i+1 == vOrder.size() || m_vVertex[vOrder[i]].c[1-o] != m_vVertex[vOrder[i+1]].c[1-o])
+						return false;
+					m_vVertex[vOrder[i]].dir[o] = 1;
+					m_vVertex[vOrder[i+1]].dir[o] = -1;
+				}
+				std::vector<coordinate_type>& vCoord = m_vCoord[o];
+				vCoord.resize(m_vVertex.size());
+				for (std::size_t i = 0; i < m_vVertex.size(); ++i)
+					vCoord[i] = m_vVertex[i].c[o];
+				std::sort(vCoord.begin(), vCoord.end());
+				vCoord.erase(std::unique(vCoord.begin(), vCoord.end()), vCoord.end());
+			}
+			return true;
+		}
+        /**
+         * @brief sweep lines of orientation o to collect chords of orientation o,
+         * and to find concave vertices for HORIZONTAL
+         *
+         * Edges of the other orientation are walls crossing the lines,
+         * counted in a Fenwick tree by their coordinates along axis o.
+         * Every vertex starts or ends exactly one wall.
+         * @param o orientation of chords
+         */
+		void sweep(int o)
+		{
+			int p = 1-o;
+			std::vector<std::size_t> const& vOrder = m_vOrder[o];
+			m_vTree.assign(m_vCoord[o].size()+1, 0);
+			for (std::size_t first = 0; first < vOrder.size(); )
+			{
+				std::size_t last = first;
+				while (last < vOrder.size() && m_vVertex[vOrder[last]].c[p] == m_vVertex[vOrder[first]].c[p])
+					++last;
+				// walls ending at the line, vertices see the side before the line
+				if (o == HORIZONTAL)
+					for (std::size_t i = first; i < last; ++i)
+						if (m_vVertex[vOrder[i]].dir[p] < 0)
+							m_vVertex[vOrder[i]].concave = this->concave(m_vVertex[vOrder[i]], o);
+				for (std::size_t i = first; i < last; ++i)
+					if (m_vVertex[vOrder[i]].dir[p] < 0)
+						this->update(this->index(m_vVertex[vOrder[i]].c[o], o), -1);
+				// only walls crossing the line are left, a chord has none between its vertices
+				for (std::size_t i = first; i+1 < last; ++i)
+				{
+					vertex_type const& u = m_vVertex[vOrder[i]];
+					vertex_type const& v = m_vVertex[vOrder[i+1]];
+					if (u.dir[o] < 0 && v.dir[o] > 0
+							&& this->prefix(this->index(v.c[o], o)-1) == this->prefix(this->index(u.c[o], o)))
+						m_vChord[o].push_back(chord_type(vOrder[i], vOrder[i+1]));
+				}
+				// walls starting at the line, vertices see the side after the line
+				for (std::size_t i = first; i < last; ++i)
+					if (m_vVertex[vOrder[i]].dir[p] > 0)
+						this->update(this->index(m_vVertex[vOrder[i]].c[o], o), 1);
+				if (o == HORIZONTAL)
+					for (std::size_t i = first; i < last; ++i)
+						if (m_vVertex[vOrder[i]].dir[p] > 0)
+							m_vVertex[vOrder[i]].concave = this->concave(m_vVertex[vOrder[i]], o);
+				first = last;
+			}
+		}
+        /**
+         * @brief the quadrant between the two edges of a concave vertex is outside,
+         * i.e., an even number of walls is before the quadrant along axis o
+         * @param v vertex
+         * @param o axis of walls in the Fenwick tree
+         * @return true if the vertex is concave
+         */
+		bool concave(vertex_type const& v, int o) const
+		{
+			std::size_t idx = this->index(v.c[o], o);
+			int count = this->prefix((v.dir[o] > 0)? idx : idx-1);
+			return (count%2) == 0;
+		}
+        /// @return 1-based index of a coordinate of an axis
+		std::size_t index(coordinate_type c, int axis) const
+		{
+			return std::lower_bound(m_vCoord[axis].begin(), m_vCoord[axis].end(), c)-m_vCoord[axis].begin()+1;
+		}
+        /// @brief add to the Fenwick tree
+		void update(std::size_t i, int delta)
+		{
+			for (; i < m_vTree.size(); i += i & (~i+1))
+				m_vTree[i] += delta;
+		}
+        /// @return sum of the Fenwick tree over [1, i]
+		int prefix(std::size_t i) const
+		{
+			int sum = 0;
+			for (; i > 0; i -= i & (~i+1))
+				sum += m_vTree[i];
+			return sum;
+		}
+        /**
+         * @brief build the intersection graph from horizontal to vertical chords, and the reverse,
+         * chords sharing a vertex intersect
+         */
+		void build_graph()
+		{
+			std::vector<chord_type> const& vHor = m_vChord[HORIZONTAL];
+			std::vector<chord_type> const& vVer = m_vChord[VERTICAL];
+			// vertical chords are collected in the order of x
+			m_vVerX.resize(vVer.size());
+			for (std::size_t i = 0; i < vVer.size(); ++i)
+				m_vVerX[i] = m_vVertex[vVer[i].first].c[HORIZONTAL];
+			m_vAdjOffset[HORIZONTAL].assign(1, 0);
+			m_vAdj[HORIZONTAL].clear();
+			m_vAdjOffset[VERTICAL].assign(vVer.size()+1, 0);
+			for (std::size_t i = 0; i < vHor.size(); ++i)
+			{
+				coordinate_type y = m_vVertex[vHor[i].first].c[VERTICAL];
+				coordinate_type xh = m_vVertex[vHor[i].second].c[HORIZONTAL];
+				for (std::size_t j = std::lower_bound(m_vVerX.begin(), m_vVerX.end(), m_vVertex[vHor[i].first].c[HORIZONTAL])-m_vVerX.begin();
+						j < vVer.size() && m_vVerX[j] <= xh; ++j)
+					if (m_vVertex[vVer[j].first].c[VERTICAL] <= y && y <= m_vVertex[vVer[j].second].c[VERTICAL])
+					{
+						m_vAdj[HORIZONTAL].push_back(j);
+						++m_vAdjOffset[VERTICAL][j+1];
+					}
+				m_vAdjOffset[HORIZONTAL].push_back(m_vAdj[HORIZONTAL].size());
+			}
+			for (std::size_t j = 0; j < vVer.size(); ++j)
+				m_vAdjOffset[VERTICAL][j+1] += m_vAdjOffset[VERTICAL][j];
+			m_vAdj[VERTICAL].resize(m_vAdj[HORIZONTAL].size());
+			m_vCursor.assign(m_vAdjOffset[VERTICAL].begin(), m_vAdjOffset[VERTICAL].end()-1);
+			for (std::size_t i = 0; i < vHor.size(); ++i)
+				for (std::size_t k = m_vAdjOffset[HORIZONTAL][i]; k < m_vAdjOffset[HORIZONTAL][i+1]; ++k)
+					m_vAdj[VERTICAL][m_vCursor[m_vAdj[HORIZONTAL][k]]++] = i;
+		}
+        /**
+         * @brief choose the maximum set of non-intersecting chords
+         * A maximum matching is found by Hopcroft-Karp. Vertices reachable from unmatched horizontal chords
+         * through alternating paths give the minimum vertex cover, whose complement is chosen.
+         */
+		void choose_chords()
+		{
+			std::size_t numHor = m_vChord[HORIZONTAL].size();
+			std::size_t numVer = m_vChord[VERTICAL].size();
+			std::size_t const none = std::numeric_limits<std::size_t>::max();
+			m_vMate[HORIZONTAL].assign(numHor, none);
+			m_vMate[VERTICAL].assign(numVer, none);
+			m_vDist.resize(numHor);
+			while (true)
+			{
+				// layers of horizontal chords from unmatched ones
+				m_vQueue.clear();
+				for (std::size_t i = 0; i < numHor; ++i)
+				{
+					if (m_vMate[HORIZONTAL][i] == none)
+					{
+						m_vDist[i] = 0;
+						m_vQueue.push_back(i);
+					}
+					else
+						m_vDist[i] = none;
+				}
+				bool found = false;
+				for (std::size_t q = 0; q < m_vQueue.size(); ++q)
+				{
+					std::size_t i = m_vQueue[q];
+					for (std::size_t k = m_vAdjOffset[HORIZONTAL][i]; k < m_vAdjOffset[HORIZONTAL][i+1]; ++k)
+					{
+						std::size_t i2 = m_vMate[VERTICAL][m_vAdj[HORIZONTAL][k]];
+						if (i2 == none)
+							found = true;
+						else if (m_vDist[i2] == none)
+						{
+							m_vDist[i2] = m_vDist[i]+1;
+							m_vQueue.push_back(i2);
+						}
+					}
+				}
+				if (!found)
+					break;
+				// shortest augmenting paths along layers
+				m_vCursor.assign(m_vAdjOffset[HORIZONTAL].begin(), m_vAdjOffset[HORIZONTAL].end()-1);
+				for (std::size_t i = 0; i < numHor; ++i)
+					if (m_vMate[HORIZONTAL][i] == none)
+						this->augment(i);
+			}
+
+			// alternating paths from unmatched horizontal chords
+			m_vChosen[HORIZONTAL].assign(numHor, false);
+			m_vChosen[VERTICAL].assign(numVer, true);
+			m_vQueue.clear();
+			for (std::size_t i = 0; i < numHor; ++i)
+				if (m_vMate[HORIZONTAL][i] == none)
+				{
+					m_vChosen[HORIZONTAL][i] = true;
+					m_vQueue.push_back(i);
+				}
+			for (std::size_t q = 0; q < m_vQueue.size(); ++q)
+			{
+				std::size_t i = m_vQueue[q];
+				for (std::size_t k = m_vAdjOffset[HORIZONTAL][i]; k < m_vAdjOffset[HORIZONTAL][i+1]; ++k)
+				{
+					std::size_t j = m_vAdj[HORIZONTAL][k];
+					if (!m_vChosen[VERTICAL][j])
+						continue;
+					m_vChosen[VERTICAL][j] = false;
+					std::size_t i2 = m_vMate[VERTICAL][j];
+					if (!m_vChosen[HORIZONTAL][i2])
+					{
+						m_vChosen[HORIZONTAL][i2] = true;
+						m_vQueue.push_back(i2);
+					}
+				}
+			}
+		}
+        /**
+         * @brief find an augmenting path from a horizontal chord along layers
+         * @param i horizontal chord
+         * @return true if the matching is augmented
+         */
+		bool augment(std::size_t i)
+		{
+			std::size_t const none = std::numeric_limits<std::size_t>::max();
+			for (std::size_t& k = m_vCursor[i]; k < m_vAdjOffset[HORIZONTAL][i+1]; ++k)
+			{
+				std::size_t j = m_vAdj[HORIZONTAL][k];
+				std::size_t i2 = m_vMate[VERTICAL][j];
+				if (i2 == none || (m_vDist[i2] == m_vDist[i]+1 && this->augment(i2)))
+				{
+					m_vMate[HORIZONTAL][i] = j;
+					m_vMate[VERTICAL][j] = i;
+					return true;
+				}
+			}
+			m_vDist[i] = none;
+			return false;
+		}
+        /// @brief choose non-intersecting chords greedily, chords intersecting fewer others first
+		void choose_chords_greedy()
+		{
+			m_vGreedy.clear();
+			for (int o = 0; o < 2; ++o)
+			{
+				m_vChosen[o].assign(m_vChord[o].size(), false);
+				for (std::size_t i = 0; i < m_vChord[o].size(); ++i)
+					m_vGreedy.push_back(std::make_pair(m_vAdjOffset[o][i+1]-m_vAdjOffset[o][i], 2*i+o));
+			}
+			std::sort(m_vGreedy.begin(), m_vGreedy.end());
+			m_vBlocked[HORIZONTAL].assign(m_vChord[HORIZONTAL].size(), false);
+			m_vBlocked[VERTICAL].assign(m_vChord[VERTICAL].size(), false);
+			for (std::size_t g = 0; g < m_vGreedy.size(); ++g)
+			{
+				int o = m_vGreedy[g].second%2;
+				std::size_t i = m_vGreedy[g].second/2;
+				if (m_vBlocked[o][i])
+					continue;
+				m_vChosen[o][i] = true;
+				for (std::size_t k = m_vAdjOffset[o][i]; k < m_vAdjOffset[o][i+1]; ++k)
+					m_vBlocked[1-o][m_vAdj[o][k]] = true;
+			}
+		}
+        /**
+         * @brief cut along vertical edges and chosen vertical chords with a bottom-up sweep,
+         * and merge identical intervals of consecutive bands into rectangles
+         * @return false if walls do not bound the interior properly
+         */
+		bool partition()
+		{
+			m_vEvent.clear();
+			std::vector<std::size_t> const& vOrder = m_vOrder[VERTICAL];
+			for (std::size_t i = 0; i < vOrder.size(); i += 2)
+				this->add_wall(m_vVertex[vOrder[i]], m_vVertex[vOrder[i+1]], true);
+			for (std::size_t j = 0; j < m_vChord[VERTICAL].size(); ++j)
+				if (m_vChosen[VERTICAL][j])
+					this->add_wall(m_vVertex[m_vChord[VERTICAL][j].first], m_vVertex[m_vChord[VERTICAL][j].second], false);
+			std::sort(m_vEvent.begin(), m_vEvent.end());
+
+			m_vActive.clear();
+			m_vOpen.clear();
+			m_vBox.clear();
+			for (std::size_t first = 0; first < m_vEvent.size(); )
+			{
+				coordinate_type y = m_vEvent[first].y;
+				// merge sorted endings and startings at y into walls, linear in the number of walls
+				std::size_t last = first;
+				m_vNextActive.clear();
+				typename std::vector<std::pair<coordinate_type, bool> >::const_iterator it = m_vActive.begin();
+				for (; last < m_vEvent.size() && m_vEvent[last].y == y && !m_vEvent[last].add; ++last)
+				{
+					for (; it != m_vActive.end() && it->first < m_vEvent[last].x; ++it)
+						m_vNextActive.push_back(*it);
+					if (it == m_vActive.end() || it->first != m_vEvent[last].x)
+						return false;
+					++it;
+				}
+				m_vNextActive.insert(m_vNextActive.end(), it, typename std::vector<std::pair<coordinate_type, bool> >::const_iterator(m_vActive.end()));
+				m_vActive.clear();
+				it = m_vNextActive.begin();
+				for (; last < m_vEvent.size() && m_vEvent[last].y == y; ++last)
+				{
+					for (; it != m_vNextActive.end() && it->first < m_vEvent[last].x; ++it)
+						m_vActive.push_back(*it);
+					m_vActive.push_back(std::make_pair(m_vEvent[last].x, m_vEvent[last].boundary));
+				}
+				m_vActive.insert(m_vActive.end(), it, typename std::vector<std::pair<coordinate_type, bool> >::const_iterator(m_vNextActive.end()));
+				first = last;
+
+				// intervals of the band above y
+				m_vInterval.clear();
+				bool inside = false;
+				coordinate_type start = 0;
+				for (typename std::vector<std::pair<coordinate_type, bool> >::const_iterator it = m_vActive.begin(); it != m_vActive.end(); ++it)
+				{
+					if (inside)
+						m_vInterval.push_back(std::make_pair(start, it->first));
+					if (it->second)
+						inside = !inside;
+					else if (!inside)
+						return false;
+					start = it->first;
+				}
+				if (inside)
+					return false;
+
+				// close open rectangles whose intervals change, open new ones
+				m_vNextOpen.clear();
+				std::size_t i = 0, j = 0;
+				while (i < m_vOpen.size() || j < m_vInterval.size())
+				{
+					if (j == m_vInterval.size() || (i < m_vOpen.size() && m_vOpen[i].xl < m_vInterval[j].first))
+						this->close(m_vOpen[i++], y);
+					else if (i == m_vOpen.size() || m_vInterval[j].first < m_vOpen[i].xl)
+						this->open(m_vInterval[j++], y);
+					else if (m_vOpen[i].xh == m_vInterval[j].second)
+					{
+						m_vNextOpen.push_back(m_vOpen[i++]);
+						++j;
+					}
+					else
+					{
+						this->close(m_vOpen[i++], y);
+						this->open(m_vInterval[j++], y);
+					}
+				}
+				m_vOpen.swap(m_vNextOpen);
+			}
+			std::sort(m_vBox.begin(), m_vBox.end());
+			return true;
+		}
+        /// @brief add events of a vertical wall between two vertices, the lower one first
+		void add_wall(vertex_type const& v1, vertex_type const& v2, bool boundary)
+		{
+			event_type e;
+			e.x = v1.c[HORIZONTAL];
+			e.boundary = boundary;
+			e.y = v1.c[VERTICAL];
+			e.add = 1;
+			m_vEvent.push_back(e);
+			e.y = v2.c[VERTICAL];
+			e.add = 0;
+			m_vEvent.push_back(e);
+		}
+        /// @brief start a rectangle on an interval
+		void open(std::pair<coordinate_type, coordinate_type> const& interval, coordinate_type y)
+		{
+			box_type box;
+			box.xl = interval.first;
+			box.xh = interval.second;
+			box.yl = box.yh = y;
+			m_vNextOpen.push_back(box);
+		}
+        /// @brief finish a rectangle
+		void close(box_type box, coordinate_type y)
+		{
+			box.yh = y;
+			m_vBox.push_back(box);
+		}
+
+        slicing_orientation_2d m_slicing_orient; ///< MIN_RECT_SLICING or MIN_RECT_FAST_SLICING
+        std::vector<xy_type> m_vTmpPoint; ///< scratch of input vertices
+        std::vector<vertex_type> m_vVertex; ///< vertices sorted by x, then y
+        std::vector<std::size_t> m_vOrder[2]; ///< vertices sorted for edges of each orientation
+        std::vector<coordinate_type> m_vCoord[2]; ///< distinct coordinates of each axis
+        std::vector<int> m_vTree; ///< Fenwick tree of walls
+        std::vector<chord_type> m_vChord[2]; ///< chords of each orientation
+        std::vector<coordinate_type> m_vVerX; ///< x of vertical chords
+        std::vector<std::size_t> m_vAdjOffset[2]; ///< offsets of intersecting chords of each chord
+        std::vector<std::size_t> m_vAdj[2]; ///< intersecting chords of the other orientation
+        std::vector<std::size_t> m_vCursor; ///< scratch cursors into adjacency
+        std::vector<std::size_t> m_vMate[2]; ///< matched chords
+        std::vector<std::size_t> m_vDist; ///< layers of horizontal chords
+        std::vector<std::size_t> m_vQueue; ///< scratch queue
+        std::vector<bool> m_vChosen[2]; ///< chosen chords
+        std::vector<bool> m_vBlocked[2]; ///< chords intersecting chosen ones in greedy choice
+        std::vector<std::pair<std::size_t, std::size_t> > m_vGreedy; ///< (number of intersections, chord) for greedy choice
+        std::vector<event_type> m_vEvent; ///< events of walls
+        std::vector<std::pair<coordinate_type, bool> > m_vActive; ///< walls crossing the current band, sorted by x
+        std::vector<std::pair<coordinate_type, bool> > m_vNextActive; ///< scratch of walls
+        std::vector<std::pair<coordinate_type, coordinate_type> > m_vInterval; ///< intervals of the current band
+        std::vector<box_type> m_vOpen; ///< open rectangles sorted by left
+        std::vector<box_type> m_vNextOpen; ///< scratch of open rectangles
+        std::vector<box_type> m_vBox; ///< rectangles
+};
+
+} // namespace geometry
+} // namespace limbo
+
+#endif
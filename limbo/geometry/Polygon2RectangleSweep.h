@@ -0,0 +1,480 @@
+/**
+ * @file   Polygon2RectangleSweep.h
+ * @brief  a sweep-line engine of polygon-to-rectangle conversion
+ *
+ * It produces the same rectangles as @ref limbo::geometry::Polygon2Rectangle in the same order.
+ * Instead of scanning sorted points for Pm and inserting into or erasing from sorted vectors,
+ * points are kept in columns of the slicing direction, and a segment tree keeps the lowest point of each column,
+ * so finding Pk, Pl, Pm and toggling a corner take logarithmic time,
+ * and a polygon of n vertices is converted in O(n log n) time instead of O(n^2).
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_POLYGON2RECTANGLESWEEP_H
+#define _LIMBO_GEOMETRY_POLYGON2RECTANGLESWEEP_H
+
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <limbo/geometry/Geometry.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.Geometry
+namespace geometry
+{
+
+/**
+ * @class limbo::geometry::Polygon2RectangleSweep
+ * @brief a sweep-line conversion from manhattan polygon to rectangles
+ *
+ * The steps are the same as @ref limbo::geometry::Polygon2Rectangle, including the choice among slicing orientations,
+ * so the output is identical for all @ref limbo::geometry::slicing_orientation_2d.
+ * For a sorting orientation, the primary coordinate of a point is along the orientation,
+ * and its column is the index of its secondary coordinate among all coordinates of the polygon.
+ * Corners of rectangles always reuse coordinates of the polygon, so columns never change.
+ *
+ * @tparam PointSet container of points, only its value type is used
+ * @tparam RectSet container of output rectangles
+ */
+template <typename PointSet,
+		 typename RectSet>
+class Polygon2RectangleSweep
+{
+	public:
+		/// @brief internal rectangle set type
+		typedef RectSet rectangle_set_type;
+		/// @brief internal point type
+		typedef typename container_traits<PointSet>::value_type point_type;
+		/// @brief coordinate type
+		typedef typename point_traits<point_type>::coordinate_type coordinate_type;
+		/// @brief internal rectangle type
+		typedef typename container_traits<rectangle_set_type>::value_type rectangle_type;
+		/// @brief coordinate distance type
+        typedef typename coordinate_traits<coordinate_type>::coordinate_distance coordinate_distance;
+
+        /**
+         * @brief constructor, points are given by @ref initialize
+         * @param vRect reference to container for rectangles
+         * @param slicing_orient slicing orientation
+         */
+		Polygon2RectangleSweep(rectangle_set_type& vRect, slicing_orientation_2d slicing_orient = HORIZONTAL_SLICING)
+            : m_vSweep()
+            , m_num_points(0)
+            , m_vRect(vRect)
+            , m_slicing_orient(slicing_orient)
+		{
+		}
+        /**
+         * @brief constructor
+         * @tparam InputIterator represents the iterator type of point set container for construction only
+         * @param vRect reference to container for rectangles
+         * @param input_begin begin iterator of points
+         * @param input_end end iterator of points
+         * @param slicing_orient slicing orientation
+         */
+		template <typename InputIterator>
+		Polygon2RectangleSweep(rectangle_set_type& vRect, InputIterator input_begin, InputIterator input_end, slicing_orientation_2d slicing_orient = HORIZONTAL_SLICING)
+            : m_vSweep()
+            , m_num_points(0)
+            , m_vRect(vRect)
+            , m_slicing_orient(slicing_orient)
+		{
+			this->initialize(input_begin, input_end);
+		}
+        /**
+         * @brief initialize polygon points and columns
+         * Vertices are cleaned up the same way as @ref limbo::geometry::Polygon2Rectangle.
+         * It can be called again for another polygon after conversion, reusing memory of the previous one.
+         * @tparam InputIterator represents the iterator type of point set container for construction only
+         * @param input_begin begin iterator of points
+         * @param input_end end iterator of points
+         */
+		template <typename InputIterator>
+		void initialize(InputIterator input_begin, InputIterator input_end)
+		{
+            limboAssert(input_begin != input_end);
+			m_vTmpPoint.clear();
+			m_vTmpPoint.reserve(std::distance(input_begin, input_end));
+			this->collect(input_begin, input_end);
+			this->initialize_points();
+		}
+        /**
+         * @brief initialize points and columns of a polygon with holes
+         * Contours are collected one by one without copying into a single point sequence,
+         * and holes are kept as vertices of the same point set.
+         * @tparam InputIterator forward iterator of points of the outer contour
+         * @tparam HoleIterator forward iterator of holes, each hole is a contour accessed by @ref limbo::geometry::contour_traits
+         * @param input_begin begin iterator of points of the outer contour
+         * @param input_end end iterator of points of the outer contour
+         * @param hole_begin begin iterator of holes
+         * @param hole_end end iterator of holes
+         */
+		template <typename InputIterator, typename HoleIterator>
+		void initialize(InputIterator input_begin, InputIterator input_end, HoleIterator hole_begin, HoleIterator hole_end)
+		{
+            limboAssert(input_begin != input_end);
+			m_vTmpPoint.clear();
+			this->collect(input_begin, input_end);
+			for (; hole_begin != hole_end; ++hole_begin)
+				this->collect(contour_traits<typename std::iterator_traits<HoleIterator>::value_type>::begin(*hole_begin),
+						contour_traits<typename std::iterator_traits<HoleIterator>::value_type>::end(*hole_begin));
+			this->initialize_points();
+		}
+        /**
+         * @brief top api for @ref limbo::geometry::Polygon2RectangleSweep
+         * @return true if succeed
+         */
+		bool operator()()
+		{
+			std::vector<rectangle_type> vRect (m_vSweep.size());
+
+			while (m_num_points > 0)
+			{
+				for (std::size_t i = 0; i < m_vSweep.size(); ++i)
+				{
+					point_type Pk, Pl, Pm;
+
+					if (!this->find_Pk_Pl_Pm(Pk, Pl, Pm, m_vSweep[i]))
+						return false;
+
+					vRect[i] = rectangle_traits<rectangle_type>::construct(
+							this->get(Pk, HORIZONTAL),
+							this->get(Pk, VERTICAL),
+							std::max(this->get(Pl, HORIZONTAL), this->get(Pm, HORIZONTAL)),
+							std::max(this->get(Pl, VERTICAL), this->get(Pm, VERTICAL)));
+				}
+				// choose rectangle with the same heuristic as Polygon2Rectangle
+				typename std::vector<rectangle_type>::iterator itRect = vRect.begin();
+				for (typename std::vector<rectangle_type>::iterator it = ++vRect.begin(); it != vRect.end(); ++it)
+				{
+                    coordinate_distance w = this->get(*it, RIGHT)-this->get(*it, LEFT);
+                    coordinate_distance h = this->get(*it, TOP)-this->get(*it, BOTTOM);
+                    coordinate_distance wref = this->get(*itRect, RIGHT)-this->get(*itRect, LEFT);
+                    coordinate_distance href = this->get(*itRect, TOP)-this->get(*itRect, BOTTOM);
+                    switch (m_slicing_orient)
+                    {
+                        case HOR_VER_SLICING:
+                            if (w*h > wref*href) // choose large area
+                                itRect = it;
+                            break;
+                        case HOR_VER_SA_SLICING:
+                            if (w*h < wref*href) // choose small area
+                                itRect = it;
+                            break;
+                        case HOR_VER_AR_SLICING:
+                        {
+                            coordinate_distance minDelta = w;
+                            coordinate_distance maxDelta = h;
+                            coordinate_distance minDeltaRef = wref;
+                            coordinate_distance maxDeltaRef = href;
+                            if (minDelta > maxDelta)
+                                std::swap(minDelta, maxDelta);
+                            if (minDeltaRef > maxDeltaRef)
+                                std::swap(minDeltaRef, maxDeltaRef);
+                            if (maxDelta*minDeltaRef < minDelta*maxDeltaRef) // avoid rectangle with bad aspect ratio
+                                itRect = it;
+                            break;
+                        }
+                        default:
+                            limboAssertMsg(0, "should not reach here %d", m_slicing_orient);
+                    }
+				}
+				// insert or remove corners, all sweeps keep the same points
+				int delta = 0;
+				for (std::size_t i = 0; i < m_vSweep.size(); ++i)
+				{
+					delta = this->F(this->get(*itRect, LEFT), this->get(*itRect, BOTTOM), m_vSweep[i]);
+					delta += this->F(this->get(*itRect, LEFT), this->get(*itRect, TOP), m_vSweep[i]);
+					delta += this->F(this->get(*itRect, RIGHT), this->get(*itRect, BOTTOM), m_vSweep[i]);
+					delta += this->F(this->get(*itRect, RIGHT), this->get(*itRect, TOP), m_vSweep[i]);
+				}
+				m_num_points += delta;
+				// collect rectangle
+				container_traits<rectangle_set_type>::insert(m_vRect, *itRect);
+			}
+
+			return true;
+		}
+        /**
+         * @brief get rectangles
+         * @return result rectangles
+         */
+		rectangle_set_type const& get_rectangles() const
+		{
+			return m_vRect;
+		}
+	protected:
+		/// @brief x and y coordinates of a point
+		typedef std::pair<coordinate_type, coordinate_type> xy_type;
+		/// @brief primary coordinate of a point and its column
+		typedef std::pair<coordinate_type, std::size_t> key_type;
+        /**
+         * @brief points sorted in one orientation
+         */
+		struct sweep_type
+		{
+			orientation_2d orient; ///< sorting orientation, for HORIZONTAL_SLICING it is VERTICAL
+			std::vector<std::set<coordinate_type> > vColumn; ///< primary coordinates of points in each column
+			std::vector<key_type> vTree; ///< segment tree of the lowest point of columns, leaves start from vColumn.size()
+		};
+
+        /**
+         * @brief get coordinate from point
+         * @param p point
+         * @param o orientation
+         * @return coordinate
+         */
+		inline coordinate_type get(point_type const& p, orientation_2d o) const {return point_traits<point_type>::get(p, o);}
+        /**
+         * @brief get coordinate from rectangle
+         * @param r rectangle
+         * @param d direction
+         * @return coordinate
+         */
+		inline coordinate_type get(rectangle_type const& r, direction_2d d) const {return rectangle_traits<rectangle_type>::get(r, d);}
+        /**
+         * @brief collect vertices of a contour into m_vTmpPoint,
+         * identical vertices and extra vertices in the same line are skipped
+         * @tparam InputIterator forward iterator of points
+         * @param input_begin begin iterator of points
+         * @param input_end end iterator of points
+         */
+		template <typename InputIterator>
+		void collect(InputIterator input_begin, InputIterator input_end)
+		{
+			if (input_begin == input_end)
+				return;
+			std::vector<xy_type>& vTmpPoint = m_vTmpPoint;
+            InputIterator input_last = input_begin;
+            std::advance(input_last, std::distance(input_begin, input_end)-1);
+			if (this->get(*input_begin, HORIZONTAL) == this->get(*input_last, HORIZONTAL)
+					&& this->get(*input_begin, VERTICAL) == this->get(*input_last, VERTICAL)) // skip identical first and last points
+                ++input_begin;
+			for (InputIterator itPrev = input_begin; itPrev != input_end; ++itPrev)
+			{
+				InputIterator itCur = itPrev;
+				++itCur;
+				if (itCur == input_end)
+					itCur = input_begin;
+				InputIterator itNext = itCur;
+				++itNext;
+				if (itNext == input_end)
+					itNext = input_begin;
+
+				coordinate_type xp = this->get(*itPrev, HORIZONTAL), yp = this->get(*itPrev, VERTICAL);
+				coordinate_type xc = this->get(*itCur, HORIZONTAL), yc = this->get(*itCur, VERTICAL);
+				coordinate_type xn = this->get(*itNext, HORIZONTAL), yn = this->get(*itNext, VERTICAL);
+				if (xc == xn && yc == yn) // identical vertices
+					continue;
+				if ((xp == xc && xc == xn) || (yp == yc && yc == yn)) // extra vertices in the same line
+					continue;
+				vTmpPoint.push_back(xy_type(xc, yc));
+			}
+		}
+        /**
+         * @brief sort collected vertices, remove duplicates, and build columns and sweeps
+         */
+		void initialize_points()
+		{
+			std::vector<xy_type>& vTmpPoint = m_vTmpPoint;
+			// 1. remove points that appear more than once
+			// in other words, contour polygon will become polygon with holes
+			std::sort(vTmpPoint.begin(), vTmpPoint.end());
+			std::vector<xy_type>& vPoint = m_vPoint;
+			vPoint.clear();
+			for (typename std::vector<xy_type>::iterator itCur = vTmpPoint.begin(), itCure = vTmpPoint.end(); itCur != itCure; ++itCur)
+			{
+				typename std::vector<xy_type>::iterator itNext = itCur;
+				++itNext;
+				if (itNext == itCure)
+					itNext = vTmpPoint.begin();
+				if (*itCur != *itNext)
+					vPoint.push_back(*itCur);
+				else
+				{
+					++itCur;
+					if (itCur == itCure) break;
+				}
+			}
+			m_num_points = vPoint.size();
+
+			// 2. columns of all coordinates
+			m_vCoord[HORIZONTAL].clear();
+			m_vCoord[VERTICAL].clear();
+			for (std::size_t i = 0; i < vPoint.size(); ++i)
+			{
+				m_vCoord[HORIZONTAL].push_back(vPoint[i].first);
+				m_vCoord[VERTICAL].push_back(vPoint[i].second);
+			}
+			for (int o = HORIZONTAL; o <= VERTICAL; ++o)
+			{
+				std::sort(m_vCoord[o].begin(), m_vCoord[o].end());
+				m_vCoord[o].erase(std::unique(m_vCoord[o].begin(), m_vCoord[o].end()), m_vCoord[o].end());
+			}
+
+			// 3. one sweep for each sorting orientation, in the same order as Polygon2Rectangle
+			switch (m_slicing_orient)
+			{
+				case HORIZONTAL_SLICING:
+					m_vSweep.resize(1);
+					m_vSweep[0].orient = VERTICAL;
+					break;
+				case VERTICAL_SLICING:
+					m_vSweep.resize(1);
+					m_vSweep[0].orient = HORIZONTAL;
+					break;
+				case HOR_VER_SLICING:
+                case HOR_VER_SA_SLICING:
+                case HOR_VER_AR_SLICING:
+					m_vSweep.resize(2);
+					m_vSweep[0].orient = HORIZONTAL;
+					m_vSweep[1].orient = VERTICAL;
+					break;
+				default:
+					limboAssertMsg(0, "unknown slicing orientation %d", m_slicing_orient);
+			}
+			for (std::size_t i = 0; i < m_vSweep.size(); ++i)
+			{
+				sweep_type& sweep = m_vSweep[i];
+				std::size_t numColumns = m_vCoord[sweep.orient.get_perpendicular().to_int()].size();
+				// sets are empty after a successful conversion
+				for (std::size_t j = 0, je = std::min(numColumns, sweep.vColumn.size()); j < je; ++j)
+					sweep.vColumn[j].clear();
+				sweep.vColumn.resize(numColumns);
+				sweep.vTree.assign(numColumns*2, empty_key());
+				for (std::size_t j = 0; j < vPoint.size(); ++j)
+					this->F(vPoint[j].first, vPoint[j].second, sweep);
+			}
+		}
+        /**
+         * @return key larger than all points
+         */
+		inline key_type empty_key() const {return key_type(std::numeric_limits<coordinate_type>::max(), std::numeric_limits<std::size_t>::max());}
+
+        /**
+         * @brief find Pk, Pl, Pm, please refer to the paper for definition
+         * @param Pk the leftmost of the lowest points
+         * @param Pl the next leftmost of the lowest points
+         * @param Pm 1) Xk <= Xm <= Xl
+         *           2) Ym is lowest but Ym > Yk
+         * @param sweep points sorted in an orientation
+         * @return false if there are fewer than 4 points or no Pm
+         */
+		bool find_Pk_Pl_Pm(point_type& Pk, point_type& Pl, point_type& Pm, sweep_type const& sweep) const
+		{
+			if (m_num_points < 4)
+				return false;
+			std::size_t numColumns = sweep.vColumn.size();
+
+			key_type k = this->query(sweep, 0, numColumns);
+			// next point in the column of Pk, or the lowest point in other columns
+			key_type l = this->next_in_column(sweep, k.second, k.first);
+			l = std::min(l, this->query(sweep, 0, k.second));
+			l = std::min(l, this->query(sweep, k.second+1, numColumns));
+			if (l.second == empty_key().second || l.second < k.second)
+				return false;
+			// Pk and Pl are the only points at the level of Pk in columns [k.second, l.second]
+			key_type m = this->next_in_column(sweep, k.second, k.first);
+			if (l.second != k.second)
+			{
+				m = std::min(m, this->query(sweep, k.second+1, l.second));
+				m = std::min(m, this->next_in_column(sweep, l.second, k.first));
+			}
+			if (m.second == empty_key().second)
+				return false;
+
+			Pk = this->point(sweep, k);
+			Pl = this->point(sweep, l);
+			Pm = this->point(sweep, m);
+			return true;
+		}
+        /**
+         * @brief F function in the original paper
+         * remove point if found, otherwise insert
+         * @param x x coordinate of the point
+         * @param y y coordinate of the point
+         * @param sweep points sorted in an orientation
+         * @return 1 if the point is inserted, -1 if removed
+         */
+		int F(coordinate_type x, coordinate_type y, sweep_type& sweep) const
+		{
+			coordinate_type primary = (sweep.orient == HORIZONTAL)? x : y;
+			coordinate_type secondary = (sweep.orient == HORIZONTAL)? y : x;
+			std::vector<coordinate_type> const& vCoord = m_vCoord[sweep.orient.get_perpendicular().to_int()];
+			std::size_t c = std::lower_bound(vCoord.begin(), vCoord.end(), secondary)-vCoord.begin();
+			limboAssert(c < vCoord.size() && vCoord[c] == secondary);
+
+			std::set<coordinate_type>& sColumn = sweep.vColumn[c];
+			int delta = 1;
+			if (!sColumn.insert(primary).second)
+			{
+				sColumn.erase(primary);
+				delta = -1;
+			}
+			// update the lowest point of the column up to the root
+			std::size_t i = c+sweep.vColumn.size();
+			sweep.vTree[i] = sColumn.empty()? empty_key() : key_type(*sColumn.begin(), c);
+			for (i >>= 1; i > 0; i >>= 1)
+				sweep.vTree[i] = std::min(sweep.vTree[i<<1], sweep.vTree[(i<<1)|1]);
+			return delta;
+		}
+        /**
+         * @param sweep points sorted in an orientation
+         * @param first first column
+         * @param last last column plus one
+         * @return the lowest point in columns [first, last)
+         */
+		key_type query(sweep_type const& sweep, std::size_t first, std::size_t last) const
+		{
+			key_type result = empty_key();
+			for (first += sweep.vColumn.size(), last += sweep.vColumn.size(); first < last; first >>= 1, last >>= 1)
+			{
+				if (first&1) result = std::min(result, sweep.vTree[first++]);
+				if (last&1) result = std::min(result, sweep.vTree[--last]);
+			}
+			return result;
+		}
+        /**
+         * @param sweep points sorted in an orientation
+         * @param c column
+         * @param primary primary coordinate
+         * @return the lowest point in column \a c above \a primary
+         */
+		key_type next_in_column(sweep_type const& sweep, std::size_t c, coordinate_type primary) const
+		{
+			typename std::set<coordinate_type>::const_iterator it = sweep.vColumn[c].upper_bound(primary);
+			return (it == sweep.vColumn[c].end())? empty_key() : key_type(*it, c);
+		}
+        /**
+         * @param sweep points sorted in an orientation
+         * @param key primary coordinate and column of a point
+         * @return the point
+         */
+		point_type point(sweep_type const& sweep, key_type const& key) const
+		{
+			coordinate_type secondary = m_vCoord[sweep.orient.get_perpendicular().to_int()][key.second];
+			if (sweep.orient == HORIZONTAL)
+				return point_traits<point_type>::construct(key.first, secondary);
+			else
+				return point_traits<point_type>::construct(secondary, key.first);
+		}
+
+        std::vector<sweep_type> m_vSweep; ///< 1~2 sweeps, sorted by left lower or by lower left
+        std::vector<coordinate_type> m_vCoord[2]; ///< sorted x and y coordinates of the polygon, columns of sweeps
+        std::vector<xy_type> m_vTmpPoint; ///< scratch of input vertices
+        std::vector<xy_type> m_vPoint; ///< scratch of cleaned vertices
+		long m_num_points; ///< number of points left
+		rectangle_set_type& m_vRect; ///< save all rectangles from conversion
+        slicing_orientation_2d m_slicing_orient; ///< slicing orient
+};
+
+} // namespace geometry
+} // namespace limbo
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @file   RectangleArray.h
+ * @brief  rectangles in structure-of-arrays form with kernels for bounding box, area, overlap and distance
+ *
+ * Coordinates of many rectangles are kept in four contiguous arrays, xl, yl, xh and yh,
+ * so kernels run one branch-free loop over plain arrays without calling @ref limbo::geometry::rectangle_traits per element.
+ * Such loops are vectorized by the compiler for the instruction set it targets,
+ * e.g., SSE2 by default on x86-64, AVX2 or AVX-512 with -march, and NEON on AArch64.
+ * Rectangles are closed, i.e., rectangles touching at a boundary overlap, the same as @ref RectangleIndex.h.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_RECTANGLEARRAY_H
+#define _LIMBO_GEOMETRY_RECTANGLEARRAY_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <limbo/geometry/Geometry.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.Geometry
+namespace geometry
+{
+
+/**
+ * @class limbo::geometry::RectangleArray
+ * @brief rectangles in structure-of-arrays form
+ *
+ * Usage:
+ * ~~~~~~~~~~~~~~~~
+ * RectangleArray<int> array;
+ * array.assign(vRect.begin(), vRect.end());
+ * long area = array.area();
+ * std::size_t n = array.overlap(xl, yl, xh, yh, vMask);
+ * ~~~~~~~~~~~~~~~~
+ *
+ * @tparam CoordinateType coordinate type with @ref limbo::geometry::coordinate_traits
+ */
+template <typename CoordinateType>
+class RectangleArray
+{
+	public:
+		/// @brief coordinate type
+		typedef CoordinateType coordinate_type;
+		/// @brief area type
+		typedef typename coordinate_traits<coordinate_type>::area_type area_type;
+		/// @brief coordinate distance type
+		typedef typename coordinate_traits<coordinate_type>::coordinate_distance coordinate_distance;
+
+        /**
+         * @brief copy coordinates of rectangles
+         * @tparam Iterator forward iterator of rectangles with @ref limbo::geometry::rectangle_traits
+         * @param first begin iterator of rectangles
+         * @param last end iterator of rectangles
+         */
+		template <typename Iterator>
+		void assign(Iterator first, Iterator last)
+		{
+			typedef rectangle_traits<typename std::iterator_traits<Iterator>::value_type> traits_type;
+			this->clear();
+			std::size_t n = std::distance(first, last);
+			for (int d = 0; d < 4; ++d)
+				m_vCoord[d].reserve(n);
+			for (; first != last; ++first)
+				this->push_back(traits_type::get(*first, LEFT), traits_type::get(*first, BOTTOM),
+						traits_type::get(*first, RIGHT), traits_type::get(*first, TOP));
+		}
+        /// @brief append a rectangle
+		void push_back(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh)
+		{
+			m_vCoord[LEFT].push_back(xl);
+			m_vCoord[BOTTOM].push_back(yl);
+			m_vCoord[RIGHT].push_back(xh);
+			m_vCoord[TOP].push_back(yh);
+		}
+        /// @brief remove all rectangles, keeping memory
+		void clear()
+		{
+			for (int d = 0; d < 4; ++d)
+				m_vCoord[d].clear();
+		}
+        /// @return number of rectangles
+		std::size_t size() const {return m_vCoord[LEFT].size();}
+        /// @return coordinates of a direction of all rectangles, LEFT for xl, BOTTOM for yl, RIGHT for xh, TOP for yh
+		std::vector<coordinate_type> const& coords(direction_2d d) const {return m_vCoord[d];}
+
+        /**
+         * @brief bounding box of all rectangles
+         * @param xl, yl, xh, yh bounding box as output
+         * @return false if there is no rectangle
+         */
+		bool bbox(coordinate_type& xl, coordinate_type& yl, coordinate_type& xh, coordinate_type& yh) const
+		{
+			return bbox(this->data(LEFT), this->data(BOTTOM), this->data(RIGHT), this->data(TOP), this->size(), xl, yl, xh, yh);
+		}
+        /// @return total area of all rectangles, overlapping area is counted more than once
+		area_type area() const
+		{
+			return area(this->data(LEFT), this->data(BOTTOM), this->data(RIGHT), this->data(TOP), this->size());
+		}
+        /**
+         * @brief find rectangles overlapping a query box
+         * @param xl, yl, xh, yh query box
+         * @param vMask 1 for each rectangle overlapping the box, 0 otherwise, resized to the number of rectangles
+         * @return number of overlapping rectangles
+         */
+		std::size_t overlap(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh, std::vector<unsigned char>& vMask) const
+		{
+			vMask.resize(this->size());
+			return overlap(this->data(LEFT), this->data(BOTTOM), this->data(RIGHT), this->data(TOP), this->size(),
+					xl, yl, xh, yh, vMask.empty()? NULL : &vMask[0]);
+		}
+        /**
+         * @brief manhattan distance from each rectangle to a query box, 0 for overlapping rectangles
+         * @param xl, yl, xh, yh query box
+         * @param vDistance distance of each rectangle, resized to the number of rectangles
+         */
+		void distance(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh, std::vector<coordinate_distance>& vDistance) const
+		{
+			vDistance.resize(this->size());
+			distance(this->data(LEFT), this->data(BOTTOM), this->data(RIGHT), this->data(TOP), this->size(),
+					xl, yl, xh, yh, vDistance.empty()? NULL : &vDistance[0]);
+		}
+
+        /**
+         * @brief bounding box kernel
+         * @param vxl, vyl, vxh, vyh coordinate arrays of n rectangles
+         * @param n number of rectangles
+         * @param xl, yl, xh, yh bounding box as output
+         * @return false if n is 0
+         */
+		static bool bbox(coordinate_type const* vxl, coordinate_type const* vyl, coordinate_type const* vxh, coordinate_type const* vyh, std::size_t n,
+				coordinate_type& xl, coordinate_type& yl, coordinate_type& xh, coordinate_type& yh)
+		{
+			if (n == 0)
+				return false;
+			// separate loops keep each reduction over one array
+			coordinate_type bxl = vxl[0], byl = vyl[0], bxh = vxh[0], byh = vyh[0];
+			for (std::size_t i = 1; i < n; ++i)
+				bxl = std::min(bxl, vxl[i]);
+			for (std::size_t i = 1; i < n; ++i)
+				byl = std::min(byl, vyl[i]);
+			for (std::size_t i = 1; i < n; ++i)
+				bxh = std::max(bxh, vxh[i]);
+			for (std::size_t i = 1; i < n; ++i)
+				byh = std::max(byh, vyh[i]);
+			xl = bxl;
+			yl = byl;
+			xh = bxh;
+			yh = byh;
+			return true;
+		}
+        /**
+         * @brief total area kernel
+         * @param vxl, vyl, vxh, vyh coordinate arrays of n rectangles
+         * @param n number of rectangles
+         * @return sum of areas
+         */
+		static area_type area(coordinate_type const* vxl, coordinate_type const* vyl, coordinate_type const* vxh, coordinate_type const* vyh, std::size_t n)
+		{
+			area_type a = 0;
+			for (std::size_t i = 0; i < n; ++i)
+				a += (area_type)(vxh[i]-vxl[i])*(area_type)(vyh[i]-vyl[i]);
+			return a;
+		}
+        /**
+         * @brief overlap kernel
+         * @param vxl, vyl, vxh, vyh coordinate arrays of n rectangles
+         * @param n number of rectangles
+         * @param xl, yl, xh, yh query box
+         * @param vMask output array of n entries, 1 for each rectangle overlapping the box, 0 otherwise
+         * @return number of overlapping rectangles
+         */
+		static std::size_t overlap(coordinate_type const* vxl, coordinate_type const* vyl, coordinate_type const* vxh, coordinate_type const* vyh, std::size_t n,
+				coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh, unsigned char* vMask)
+		{
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				// bitwise and instead of logical and, so there is no branch
+				unsigned char m = (unsigned char)((vxl[i] <= xh) & (xl <= vxh[i]) & (vyl[i] <= yh) & (yl <= vyh[i]));
+				vMask[i] = m;
+				count += m;
+			}
+			return count;
+		}
+        /**
+         * @brief manhattan distance kernel
+         * @param vxl, vyl, vxh, vyh coordinate arrays of n rectangles
+         * @param n number of rectangles
+         * @param xl, yl, xh, yh query box
+         * @param vDistance output array of n entries, gaps in x and y added, 0 for overlapping rectangles
+         */
+		static void distance(coordinate_type const* vxl, coordinate_type const* vyl, coordinate_type const* vxh, coordinate_type const* vyh, std::size_t n,
+				coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh, coordinate_distance* vDistance)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				// at most one of the two gaps of an axis is positive
+				coordinate_distance dx = std::max((coordinate_distance)0, std::max((coordinate_distance)xl-vxh[i], (coordinate_distance)vxl[i]-xh));
+				coordinate_distance dy = std::max((coordinate_distance)0, std::max((coordinate_distance)yl-vyh[i], (coordinate_distance)vyl[i]-yh));
+				vDistance[i] = dx+dy;
+			}
+		}
+	protected:
+        /// @return pointer to coordinates of a direction, NULL if empty
+		coordinate_type const* data(direction_2d d) const {return m_vCoord[d].empty()? NULL : &m_vCoord[d][0];}
+
+        std::vector<coordinate_type> m_vCoord[4]; ///< coordinates indexed by direction_2d, LEFT, BOTTOM, RIGHT and TOP
+};
+
+} // namespace geometry
+} // namespace limbo
+
+#endif
@@ -0,0 +1,572 @@
+/**
+ * @file   RectangleIndex.h
+ * @brief  static spatial indices of rectangles: a packed Hilbert R-tree and a uniform bin grid
+ *
+ * Both indices are built once from a range of rectangles read through @ref limbo::geometry::rectangle_traits,
+ * so rectangles of Boost.Polygon, bLib or user classes are indexed without converting them.
+ * Only coordinates are kept in the index, and queries report positions of rectangles in the input range.
+ * Rectangles are closed, i.e., rectangles touching at a boundary overlap.
+ * A batch of queries can be answered by threads with @ref limbo::geometry::query_batch.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_RECTANGLEINDEX_H
+#define _LIMBO_GEOMETRY_RECTANGLEINDEX_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/geometry/Geometry.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.Geometry
+namespace geometry
+{
+
+/**
+ * @param x x in [0, 2^16)
+ * @param y y in [0, 2^16)
+ * @return distance along the Hilbert curve filling the 2^16 x 2^16 grid,
+ * so points close on the curve are close in the plane, e.g., to order shapes for locality
+ */
+inline unsigned int hilbert_index(unsigned int x, unsigned int y)
+{
+	unsigned int d = 0;
+	for (unsigned int s = 1U<<15; s > 0; s >>= 1)
+	{
+		unsigned int rx = (x & s) > 0;
+		unsigned int ry = (y & s) > 0;
+		d += s*s*((3*rx)^ry);
+		// rotate the quadrant
+		if (ry == 0)
+		{
+			if (rx == 1)
+			{
+				x = 65535-x;
+				y = 65535-y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return d;
+}
+
+/**
+ * @class limbo::geometry::PackedRTree
+ * @brief a static R-tree bulk loaded in Hilbert order of rectangle centers
+ *
+ * Rectangles are sorted along a Hilbert curve and packed into full leaves,
+ * and each upper level packs consecutive nodes of the level below.
+ * Boxes of each level are stored contiguously, so children of a node are adjacent in memory
+ * and no pointer is stored.
+ *
+ * @tparam RectType rectangle type of input and queries
+ */
+template <typename RectType>
+class PackedRTree
+{
+	public:
+		/// @brief rectangle type
+		typedef RectType rectangle_type;
+		/// @brief coordinate type
+		typedef typename rectangle_traits<rectangle_type>::coordinate_type coordinate_type;
+
+        /**
+         * @brief constructor
+         * @param node_capacity maximum number of children of a node
+         */
+		explicit PackedRTree(unsigned int node_capacity = 16) : m_node_capacity(std::max(node_capacity, 2U)) {}
+
+        /**
+         * @brief bulk load rectangles, replacing the previous ones
+         * @tparam Iterator forward iterator of rectangles
+         * @param first begin iterator
+         * @param last end iterator
+         */
+		template <typename Iterator>
+		void build(Iterator first, Iterator last)
+		{
+			std::vector<box_type> vBox;
+			read_boxes(first, last, vBox);
+			m_vItemBox.clear();
+			m_vItemId.clear();
+			m_vNodeBox.clear();
+			m_vLevelOffset.assign(1, 0);
+			if (vBox.empty())
+				return;
+
+			// Hilbert order of centers on a 2^16 x 2^16 grid over the bounding box
+			box_type bbox = bounding_box(vBox.begin(), vBox.end());
+			double sx = 65535.0/std::max(2.0*((double)bbox.xh-bbox.xl), 1.0);
+			double sy = 65535.0/std::max(2.0*((double)bbox.yh-bbox.yl), 1.0);
+			std::vector<std::pair<unsigned int, std::size_t> > vOrder (vBox.size());
+			for (std::size_t i = 0; i < vBox.size(); ++i)
+			{
+				unsigned int x = (unsigned int)(((double)vBox[i].xl+vBox[i].xh-2.0*bbox.xl)*sx);
+				unsigned int y = (unsigned int)(((double)vBox[i].yl+vBox[i].yh-2.0*bbox.yl)*sy);
+				vOrder[i] = std::make_pair(hilbert_index(x, y), i);
+			}
+			std::sort(vOrder.begin(), vOrder.end());
+			m_vItemBox.resize(vBox.size());
+			m_vItemId.resize(vBox.size());
+			for (std::size_t i = 0; i < vOrder.size(); ++i)
+			{
+				m_vItemBox[i] = vBox[vOrder[i].second];
+				m_vItemId[i] = vOrder[i].second;
+			}
+
+			// pack levels from leaves up to the root
+			std::vector<box_type> const* pChild = &m_vItemBox;
+			std::size_t childBegin = 0, childEnd = m_vItemBox.size();
+			while (true)
+			{
+				std::size_t levelBegin = m_vNodeBox.size();
+				for (std::size_t i = childBegin; i < childEnd; i += m_node_capacity)
+				{
+					std::size_t ie = std::min(i+m_node_capacity, childEnd);
+					// pChild may be m_vNodeBox, so compute the box before pushing
+					box_type box = bounding_box((*pChild).begin()+i, (*pChild).begin()+ie);
+					m_vNodeBox.push_back(box);
+				}
+				m_vLevelOffset.push_back(m_vNodeBox.size());
+				if (m_vNodeBox.size()-levelBegin == 1)
+					break;
+				pChild = &m_vNodeBox;
+				childBegin = levelBegin;
+				childEnd = m_vNodeBox.size();
+			}
+		}
+        /// @return number of rectangles
+		std::size_t size() const {return m_vItemId.size();}
+
+        /**
+         * @brief call a visitor with the position of each rectangle overlapping a box
+         * @tparam Visitor callable with std::size_t
+         * @param xl, yl, xh, yh query box
+         * @param visitor visitor
+         */
+		template <typename Visitor>
+		void visit(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh, Visitor& visitor) const
+		{
+			if (m_vItemId.empty())
+				return;
+			box_type query = {xl, yl, xh, yh};
+			std::size_t numLevels = m_vLevelOffset.size()-1;
+			this->visit_node(numLevels-1, 0, query, visitor);
+		}
+        /**
+         * @brief find rectangles within a distance of a box, i.e., overlapping the box bloated by the distance
+         * @tparam OutputIterator output iterator of std::size_t
+         * @param box query box
+         * @param d distance in both directions, 0 for overlapping
+         * @param out output iterator of positions of rectangles in the input range
+         * @return output iterator after the last position
+         */
+		template <typename OutputIterator>
+		OutputIterator query(rectangle_type const& box, coordinate_type d, OutputIterator out) const
+		{
+			output_visitor_type<OutputIterator> visitor (out);
+			this->visit(rectangle_traits<rectangle_type>::get(box, LEFT)-d, rectangle_traits<rectangle_type>::get(box, BOTTOM)-d,
+					rectangle_traits<rectangle_type>::get(box, RIGHT)+d, rectangle_traits<rectangle_type>::get(box, TOP)+d, visitor);
+			return visitor.out;
+		}
+        /**
+         * @brief find rectangles overlapping a box
+         * @tparam OutputIterator output iterator of std::size_t
+         * @param box query box
+         * @param out output iterator of positions of rectangles in the input range
+         * @return output iterator after the last position
+         */
+		template <typename OutputIterator>
+		OutputIterator query(rectangle_type const& box, OutputIterator out) const
+		{
+			return this->query(box, 0, out);
+		}
+	protected:
+		/// @brief coordinates of a rectangle
+		struct box_type
+		{
+			coordinate_type xl; ///< left
+			coordinate_type yl; ///< bottom
+			coordinate_type xh; ///< right
+			coordinate_type yh; ///< top
+		};
+		/// @brief visitor writing to an output iterator
+		template <typename OutputIterator>
+		struct output_visitor_type
+		{
+			OutputIterator out; ///< output iterator
+			/// constructor
+			output_visitor_type(OutputIterator o) : out(o) {}
+			/// @brief output a position
+			void operator()(std::size_t i) {*out++ = i;}
+		};
+
+        /**
+         * @brief read coordinates of rectangles
+         * @param first begin iterator
+         * @param last end iterator
+         * @param vBox coordinates
+         */
+		template <typename Iterator>
+		static void read_boxes(Iterator first, Iterator last, std::vector<box_type>& vBox)
+		{
+			typedef typename std::iterator_traits<Iterator>::value_type input_rectangle_type;
+			vBox.clear();
+			for (; first != last; ++first)
+			{
+				box_type box = {rectangle_traits<input_rectangle_type>::get(*first, LEFT), rectangle_traits<input_rectangle_type>::get(*first, BOTTOM),
+					rectangle_traits<input_rectangle_type>::get(*first, RIGHT), rectangle_traits<input_rectangle_type>::get(*first, TOP)};
+				vBox.push_back(box);
+			}
+		}
+        /**
+         * @param first begin iterator of boxes
+         * @param last end iterator of boxes, not equal to \a first
+         * @return bounding box
+         */
+		template <typename BoxIterator>
+		static box_type bounding_box(BoxIterator first, BoxIterator last)
+		{
+			box_type bbox = *first;
+			for (++first; first != last; ++first)
+			{
+				bbox.xl = std::min(bbox.xl, first->xl);
+				bbox.yl = std::min(bbox.yl, first->yl);
+				bbox.xh = std::max(bbox.xh, first->xh);
+				bbox.yh = std::max(bbox.yh, first->yh);
+			}
+			return bbox;
+		}
+        /// @return true if two boxes overlap or touch
+		static bool overlap(box_type const& b1, box_type const& b2)
+		{
+			return b1.xl <= b2.xh && b2.xl <= b1.xh && b1.yl <= b2.yh && b2.yl <= b1.yh;
+		}
+        /**
+         * @brief visit a node and its overlapping descendants
+         * @param level level of the node, 0 for nodes of leaves
+         * @param i index of the node in its level
+         * @param query query box
+         * @param visitor visitor
+         */
+		template <typename Visitor>
+		void visit_node(std::size_t level, std::size_t i, box_type const& query, Visitor& visitor) const
+		{
+			if (!overlap(m_vNodeBox[m_vLevelOffset[level]+i], query))
+				return;
+			std::size_t first = i*m_node_capacity;
+			if (level == 0)
+			{
+				std::size_t last = std::min(first+m_node_capacity, m_vItemBox.size());
+				for (std::size_t j = first; j < last; ++j)
+					if (overlap(m_vItemBox[j], query))
+						visitor(m_vItemId[j]);
+			}
+			else
+			{
+				std::size_t last = std::min(first+m_node_capacity, m_vLevelOffset[level]-m_vLevelOffset[level-1]);
+				for (std::size_t j = first; j < last; ++j)
+					this->visit_node(level-1, j, query, visitor);
+			}
+		}
+
+		unsigned int m_node_capacity; ///< maximum number of children of a node
+		std::vector<box_type> m_vItemBox; ///< rectangles in Hilbert order
+		std::vector<std::size_t> m_vItemId; ///< positions of rectangles in the input range
+		std::vector<box_type> m_vNodeBox; ///< boxes of nodes level by level from leaves to the root
+		std::vector<std::size_t> m_vLevelOffset; ///< first node of each level, one more than the number of levels
+};
+
+/**
+ * @class limbo::geometry::BinGrid
+ * @brief a static uniform grid of bins, each listing the rectangles overlapping it
+ *
+ * It suits rectangles of similar sizes, such as pins or vias,
+ * while @ref limbo::geometry::PackedRTree handles rectangles of mixed sizes better.
+ * A rectangle overlapping several bins of a query is reported once,
+ * from the lowest leftmost bin overlapped by both.
+ *
+ * @tparam RectType rectangle type of input and queries
+ */
+template <typename RectType>
+class BinGrid
+{
+	public:
+		/// @brief rectangle type
+		typedef RectType rectangle_type;
+		/// @brief coordinate type
+		typedef typename rectangle_traits<rectangle_type>::coordinate_type coordinate_type;
+
+        /// @brief constructor
+		BinGrid() : m_num_bins_x(0), m_num_bins_y(0), m_bin_w(1), m_bin_h(1) {}
+
+        /**
+         * @brief build bins, replacing the previous ones
+         * @tparam Iterator forward iterator of rectangles
+         * @param first begin iterator
+         * @param last end iterator
+         * @param num_bins_x number of bins in x, 0 for about 2 rectangles per bin
+         * @param num_bins_y number of bins in y, 0 for about 2 rectangles per bin
+         */
+		template <typename Iterator>
+		void build(Iterator first, Iterator last, unsigned int num_bins_x = 0, unsigned int num_bins_y = 0)
+		{
+			typedef typename std::iterator_traits<Iterator>::value_type input_rectangle_type;
+			m_vBox.clear();
+			for (; first != last; ++first)
+			{
+				box_type box = {rectangle_traits<input_rectangle_type>::get(*first, LEFT), rectangle_traits<input_rectangle_type>::get(*first, BOTTOM),
+					rectangle_traits<input_rectangle_type>::get(*first, RIGHT), rectangle_traits<input_rectangle_type>::get(*first, TOP)};
+				m_vBox.push_back(box);
+			}
+			m_num_bins_x = m_num_bins_y = 0;
+			m_vBinOffset.assign(1, 0);
+			m_vBinItem.clear();
+			if (m_vBox.empty())
+				return;
+
+			m_bbox = m_vBox.front();
+			for (typename std::vector<box_type>::const_iterator it = m_vBox.begin(); it != m_vBox.end(); ++it)
+			{
+				m_bbox.xl = std::min(m_bbox.xl, it->xl);
+				m_bbox.yl = std::min(m_bbox.yl, it->yl);
+				m_bbox.xh = std::max(m_bbox.xh, it->xh);
+				m_bbox.yh = std::max(m_bbox.yh, it->yh);
+			}
+			double w = std::max((double)m_bbox.xh-m_bbox.xl, 1.0);
+			double h = std::max((double)m_bbox.yh-m_bbox.yl, 1.0);
+			if (num_bins_x == 0 || num_bins_y == 0)
+			{
+				// square bins, about 2 rectangles per bin
+				double side = std::sqrt(w*h*2/m_vBox.size());
+				num_bins_x = (unsigned int)std::min(std::max(w/side, 1.0), 4096.0);
+				num_bins_y = (unsigned int)std::min(std::max(h/side, 1.0), 4096.0);
+			}
+			m_num_bins_x = num_bins_x;
+			m_num_bins_y = num_bins_y;
+			m_bin_w = std::max((coordinate_type)std::ceil(w/m_num_bins_x), (coordinate_type)1);
+			m_bin_h = std::max((coordinate_type)std::ceil(h/m_num_bins_y), (coordinate_type)1);
+
+			// count, then fill bins in ascending positions
+			m_vBinOffset.assign(m_num_bins_x*m_num_bins_y+1, 0);
+			std::vector<std::size_t> vCursor;
+			for (int pass = 0; pass < 2; ++pass)
+			{
+				if (pass == 1)
+				{
+					for (std::size_t b = 1; b < m_vBinOffset.size(); ++b)
+						m_vBinOffset[b] += m_vBinOffset[b-1];
+					m_vBinItem.resize(m_vBinOffset.back());
+					vCursor.assign(m_vBinOffset.begin(), m_vBinOffset.end()-1);
+				}
+				for (std::size_t i = 0; i < m_vBox.size(); ++i)
+				{
+					box_type const& box = m_vBox[i];
+					unsigned int c0 = this->col(box.xl), c1 = this->col(box.xh);
+					unsigned int r0 = this->row(box.yl), r1 = this->row(box.yh);
+					for (unsigned int r = r0; r <= r1; ++r)
+						for (unsigned int c = c0; c <= c1; ++c)
+						{
+							std::size_t b = r*m_num_bins_x+c;
+							if (pass == 0)
+								++m_vBinOffset[b+1];
+							else
+								m_vBinItem[vCursor[b]++] = i;
+						}
+				}
+			}
+		}
+        /// @return number of rectangles
+		std::size_t size() const {return m_vBox.size();}
+        /// @return number of bins in x
+		unsigned int num_bins_x() const {return m_num_bins_x;}
+        /// @return number of bins in y
+		unsigned int num_bins_y() const {return m_num_bins_y;}
+
+        /**
+         * @brief call a visitor with the position of each rectangle overlapping a box
+         * @tparam Visitor callable with std::size_t
+         * @param xl, yl, xh, yh query box
+         * @param visitor visitor
+         */
+		template <typename Visitor>
+		void visit(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh, Visitor& visitor) const
+		{
+			if (m_vBox.empty() || xh < m_bbox.xl || xl > m_bbox.xh || yh < m_bbox.yl || yl > m_bbox.yh)
+				return;
+			unsigned int c0 = this->col(xl), c1 = this->col(xh);
+			unsigned int r0 = this->row(yl), r1 = this->row(yh);
+			for (unsigned int r = r0; r <= r1; ++r)
+				for (unsigned int c = c0; c <= c1; ++c)
+				{
+					std::size_t b = r*m_num_bins_x+c;
+					for (std::size_t k = m_vBinOffset[b]; k < m_vBinOffset[b+1]; ++k)
+					{
+						box_type const& box = m_vBox[m_vBinItem[k]];
+						if (box.xl <= xh && xl <= box.xh && box.yl <= yh && yl <= box.yh
+								&& c == std::max(c0, this->col(box.xl)) && r == std::max(r0, this->row(box.yl)))
+							visitor(m_vBinItem[k]);
+					}
+				}
+		}
+        /**
+         * @brief find rectangles within a distance of a box, i.e., overlapping the box bloated by the distance
+         * @tparam OutputIterator output iterator of std::size_t
+         * @param box query box
+         * @param d distance in both directions, 0 for overlapping
+         * @param out output iterator of positions of rectangles in the input range
+         * @return output iterator after the last position
+         */
+		template <typename OutputIterator>
+		OutputIterator query(rectangle_type const& box, coordinate_type d, OutputIterator out) const
+		{
+			output_visitor_type<OutputIterator> visitor (out);
+			this->visit(rectangle_traits<rectangle_type>::get(box, LEFT)-d, rectangle_traits<rectangle_type>::get(box, BOTTOM)-d,
+					rectangle_traits<rectangle_type>::get(box, RIGHT)+d, rectangle_traits<rectangle_type>::get(box, TOP)+d, visitor);
+			return visitor.out;
+		}
+        /**
+         * @brief find rectangles overlapping a box
+         * @tparam OutputIterator output iterator of std::size_t
+         * @param box query box
+         * @param out output iterator of positions of rectangles in the input range
+         * @return output iterator after the last position
+         */
+		template <typename OutputIterator>
+		OutputIterator query(rectangle_type const& box, OutputIterator out) const
+		{
+			return this->query(box, 0, out);
+		}
+	protected:
+		/// @brief coordinates of a rectangle
+		struct box_type
+		{
+			coordinate_type xl; ///< left
+			coordinate_type yl; ///< bottom
+			coordinate_type xh; ///< right
+			coordinate_type yh; ///< top
+		};
+		/// @brief visitor writing to an output iterator
+		template <typename OutputIterator>
+		struct output_visitor_type
+		{
+			OutputIterator out; ///< output iterator
+			/// constructor
+			output_visitor_type(OutputIterator o) : out(o) {}
+			/// @brief output a position
+			void operator()(std::size_t i) {*out++ = i;}
+		};
+
+        /// @return column of bins containing x, clamped to the grid
+		unsigned int col(coordinate_type x) const
+		{
+			if (x <= m_bbox.xl) return 0;
+			return std::min((unsigned int)((x-m_bbox.xl)/m_bin_w), m_num_bins_x-1);
+		}
+        /// @return row of bins containing y, clamped to the grid
+		unsigned int row(coordinate_type y) const
+		{
+			if (y <= m_bbox.yl) return 0;
+			return std::min((unsigned int)((y-m_bbox.yl)/m_bin_h), m_num_bins_y-1);
+		}
+
+		std::vector<box_type> m_vBox; ///< rectangles by positions in the input range
+		box_type m_bbox; ///< bounding box of rectangles
+		unsigned int m_num_bins_x; ///< number of bins in x
+		unsigned int m_num_bins_y; ///< number of bins in y
+		coordinate_type m_bin_w; ///< width of a bin
+		coordinate_type m_bin_h; ///< height of a bin
+		std::vector<std::size_t> m_vBinOffset; ///< first item of each bin, row by row
+		std::vector<std::size_t> m_vBinItem; ///< positions of rectangles in bins
+};
+
+/// @brief queries shared by threads of @ref limbo::geometry::query_batch
+template <typename IndexType, typename BoxIterator>
+struct query_batch_task_type
+{
+	/// @brief coordinate type
+	typedef typename IndexType::coordinate_type coordinate_type;
+
+	IndexType const* pIndex; ///< index
+	BoxIterator box_begin; ///< begin iterator of query boxes
+	std::size_t num_queries; ///< number of queries
+	coordinate_type d; ///< distance
+	std::size_t chunk_size; ///< number of queries answered by a block
+	std::vector<std::vector<std::size_t> > vChunkResult; ///< results of each chunk
+	std::vector<std::size_t> vLocation; ///< first result of each query in the buffer of its chunk
+	std::vector<std::size_t> vCount; ///< number of results of each query
+
+	/// @brief answer a chunk of queries into the buffer of the chunk
+	/// @param first first query of the chunk
+	/// @param last end query of the chunk
+	void work(std::size_t first, std::size_t last)
+	{
+		std::vector<std::size_t>& vResult = vChunkResult[first/chunk_size];
+		for (std::size_t i = first; i < last; ++i)
+		{
+			vLocation[i] = vResult.size();
+			pIndex->query(box_begin[i], d, std::back_inserter(vResult));
+			vCount[i] = vResult.size()-vLocation[i];
+		}
+	}
+	/// @brief chunk of queries run by limbo::containers::parallel_for
+	struct kernel_type
+	{
+		query_batch_task_type* task; ///< shared task
+		/// @param b first query
+		/// @param e end query
+		void operator()(std::size_t b, std::size_t e) const {task->work(b, e);}
+	};
+};
+
+/// @brief answer a batch of queries with threads
+/// @tparam IndexType @ref limbo::geometry::PackedRTree or @ref limbo::geometry::BinGrid
+/// @tparam BoxIterator random access iterator of query boxes
+/// @param index spatial index
+/// @param box_begin begin iterator of query boxes
+/// @param box_end end iterator of query boxes
+/// @param d distance in both directions, 0 for overlapping
+/// @param vOffset results of query i are [vOffset[i], vOffset[i+1]) in \a vResult
+/// @param vResult positions of rectangles in the input range of the index, in the same order as single queries
+/// @param num_threads number of threads
+template <typename IndexType, typename BoxIterator>
+void query_batch(IndexType const& index, BoxIterator box_begin, BoxIterator box_end, typename IndexType::coordinate_type d,
+		std::vector<std::size_t>& vOffset, std::vector<std::size_t>& vResult, unsigned int num_threads = 1)
+{
+	typedef query_batch_task_type<IndexType, BoxIterator> task_type;
+	task_type task;
+	task.pIndex = &index;
+	task.box_begin = box_begin;
+	task.num_queries = box_end-box_begin;
+	task.d = d;
+	task.chunk_size = 256;
+	task.vChunkResult.resize((task.num_queries+task.chunk_size-1)/task.chunk_size);
+	task.vLocation.resize(task.num_queries);
+	task.vCount.resize(task.num_queries);
+
+	unsigned int numThreads = std::min(limbo::containers::num_threads(), std::max(num_threads, 1U));
+	typename task_type::kernel_type kernel = {&task};
+	limbo::containers::parallel_for(0, task.num_queries, task.chunk_size, numThreads, kernel);
+
+	// collect results in the order of queries
+	vOffset.assign(task.num_queries+1, 0);
+	for (std::size_t i = 0; i < task.num_queries; ++i)
+		vOffset[i+1] = vOffset[i]+task.vCount[i];
+	vResult.resize(vOffset.back());
+	for (std::size_t i = 0; i < task.num_queries; ++i)
+	{
+		std::vector<std::size_t> const& vChunkResult = task.vChunkResult[i/task.chunk_size];
+		std::copy(vChunkResult.begin()+task.vLocation[i], vChunkResult.begin()+task.vLocation[i]+task.vCount[i], vResult.begin()+vOffset[i]);
+	}
+}
+
+} // namespace geometry
+} // namespace limbo
+
+#endif
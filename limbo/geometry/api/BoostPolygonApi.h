@@ -115,6 +115,36 @@ struct rectangle_traits<boost::polygon::rectangle_data<T> >
 	}
 };
 
+/// @brief specialization of @ref limbo::geometry::contour_traits for boost::polygon::polygon_90_data, e.g., holes of boost::polygon::polygon_90_with_holes_data
+template <typename T>
+struct contour_traits<boost::polygon::polygon_90_data<T> >
+{
+    /// @nowarn
+	typedef boost::polygon::polygon_90_data<T> contour_type;
+	typedef typename contour_type::iterator_type iterator_type;
+    /// @endnowarn
+
+    /// @brief begin iterator of points 
+	static iterator_type begin(contour_type const& c) {return c.begin();}
+    /// @brief end iterator of points 
+	static iterator_type end(contour_type const& c) {return c.end();}
+};
+
+/// @brief specialization of @ref limbo::geometry::contour_traits for boost::polygon::polygon_data, e.g., holes of boost::polygon::polygon_with_holes_data
+template <typename T>
+struct contour_traits<boost::polygon::polygon_data<T> >
+{
+    /// @nowarn
+	typedef boost::polygon::polygon_data<T> contour_type;
+	typedef typename contour_type::iterator_type iterator_type;
+    /// @endnowarn
+
+    /// @brief begin iterator of points 
+	static iterator_type begin(contour_type const& c) {return c.begin();}
+    /// @brief end iterator of points 
+	static iterator_type end(contour_type const& c) {return c.end();}
+};
+
 } // namespace geometry
 } // namespace limbo
 
@@ -0,0 +1,77 @@
+/**
+ * @file   GdsDBApi.h
+ * @brief  Geometry traits for GdsDB, include this file when GdsDB shapes are used 
+ *
+ * Points of GdsDB are boost::polygon::point_data, so include @ref BoostPolygonApi.h for them. 
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_GEOMETRY_API_GDSDBAPI_H
+#define _LIMBO_GEOMETRY_API_GDSDBAPI_H
+
+#include <limits>
+#include <limbo/parsers/gdsii/gdsdb/GdsObjects.h>
+#include <limbo/geometry/Geometry.h>
+
+/// @brief namespace for Limbo
+namespace limbo 
+{ 
+/// @brief namespace for Limbo.Geometry
+namespace geometry 
+{
+
+/// @brief specialization of @ref limbo::geometry::rectangle_traits for GdsParser::GdsDB::GdsRectangle 
+template <>
+struct rectangle_traits<GdsParser::GdsDB::GdsRectangle>
+{
+    /// @nowarn
+	typedef GdsParser::GdsDB::GdsRectangle rectangle_type;
+	typedef int coordinate_type;
+    /// @endnowarn
+
+    /// @brief get coordinate from rectangle 
+    /// @param rect a rectangle object 
+    /// @param dir direction 
+    /// @return coordinate 
+	static coordinate_type get(const rectangle_type& rect, direction_2d const& dir) 
+	{
+		switch (dir)
+		{
+			case LEFT: return boost::polygon::xl(static_cast<rectangle_type::base_ext_type const&>(rect));
+			case BOTTOM: return boost::polygon::yl(static_cast<rectangle_type::base_ext_type const&>(rect));
+			case RIGHT: return boost::polygon::xh(static_cast<rectangle_type::base_ext_type const&>(rect));
+			case TOP: return boost::polygon::yh(static_cast<rectangle_type::base_ext_type const&>(rect));
+            default: assert(0); return std::numeric_limits<coordinate_type>::max();
+		}
+	}
+    /// @brief set coordinate for rectangle 
+    /// @param rect a rectangle object 
+    /// @param dir direction 
+    /// @param value coordinate 
+	static void set(rectangle_type& rect, direction_2d const& dir, coordinate_type const& value) 
+	{
+		switch (dir)
+		{
+			case LEFT: boost::polygon::xl(static_cast<rectangle_type::base_ext_type&>(rect), value); break;
+			case BOTTOM: boost::polygon::yl(static_cast<rectangle_type::base_ext_type&>(rect), value); break;
+			case RIGHT: boost::polygon::xh(static_cast<rectangle_type::base_ext_type&>(rect), value); break;
+			case TOP: boost::polygon::yh(static_cast<rectangle_type::base_ext_type&>(rect), value); break;
+			default: assert(0);
+		}
+	}
+    /// @brief construct rectangle from coordinates, layer and data type are left default 
+    /// @param xl, yl, xh, yh coordinates 
+    /// @return rectangle object 
+	static rectangle_type construct(coordinate_type const& xl, coordinate_type const& yl, 
+			coordinate_type const& xh, coordinate_type const& yh) 
+	{
+		rectangle_type rect; 
+		boost::polygon::set_points(static_cast<rectangle_type::base_ext_type&>(rect), boost::polygon::point_data<coordinate_type>(xl, yl), boost::polygon::point_data<coordinate_type>(xh, yh)); 
+		return rect; 
+	}
+};
+
+}}// namespace limbo // namespace geometry
+
+#endif 
@@ -11,6 +11,8 @@
 #include "GeoBoostPolygonApi.h"
 #include <limbo/geometry/Polygon2Rectangle.h>
 #include <limbo/geometry/api/BoostPolygonApi.h>
+#include <limbo/containers/TaskPool.h>
+#include <algorithm>
 
 namespace limbo { namespace geometry {
 
@@ -44,5 +46,68 @@ bool polygon2RectangleBoost(gtl::polygon_90_data<int> const& polygon, std::vecto
                 HOR_VER_SLICING);
 }
 
+/// @brief polygons shared by threads of @ref limbo::geometry::polygon2RectangleBoostBatch
+struct BoostBatchTask
+{
+    std::vector<gtl::polygon_90_data<int> > const* pPolygon; ///< polygons
+    gtl::orientation_2d slicing_orient; ///< slicing orientation
+    std::size_t chunk_size; ///< number of polygons decomposed by a block
+    std::vector<std::size_t> vFirst; ///< first rectangle of each polygon in the buffer of its chunk
+    std::vector<std::size_t> vCount; ///< number of rectangles of each polygon
+    std::vector<std::vector<gtl::rectangle_data<int> > > vChunkRect; ///< rectangles converted in each chunk
+};
+
+/// @brief chunk of polygons run by limbo::containers::parallel_for
+struct BoostBatchKernel
+{
+    BoostBatchTask* task; ///< shared task
+    /// @brief decompose polygons in [first, last) into the buffer of their chunk
+    /// @param first first polygon
+    /// @param last end polygon
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        std::vector<gtl::polygon_90_data<int> > const& vPolygon = *task->pPolygon;
+        std::vector<gtl::rectangle_data<int> >& vRect = task->vChunkRect[first/task->chunk_size];
+        gtl::polygon_90_set_data<int> ps (task->slicing_orient);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            task->vFirst[i] = vRect.size();
+            ps.clear();
+            ps.insert(vPolygon[i]);
+            ps.get_rectangles(vRect);
+            task->vCount[i] = vRect.size()-task->vFirst[i];
+        }
+    }
+};
+
+bool polygon2RectangleBoostBatch(std::vector<gtl::polygon_90_data<int> > const& vPolygon, 
+        std::vector<gtl::rectangle_data<int> >& vRectangle, std::vector<std::size_t>& vRectOffset, 
+        gtl::orientation_2d slicing_orient, unsigned int num_threads)
+{
+    BoostBatchTask task;
+    task.pPolygon = &vPolygon;
+    task.slicing_orient = slicing_orient;
+    task.chunk_size = 64;
+    task.vFirst.resize(vPolygon.size());
+    task.vCount.resize(vPolygon.size());
+    task.vChunkRect.resize((vPolygon.size()+task.chunk_size-1)/task.chunk_size);
+
+    unsigned int numThreads = std::min(limbo::containers::num_threads(), std::max(num_threads, 1U));
+    BoostBatchKernel kernel = {&task};
+    limbo::containers::parallel_for(0, vPolygon.size(), task.chunk_size, numThreads, kernel);
+
+    // collect rectangles in the order of polygons
+    vRectOffset.assign(vPolygon.size()+1, 0);
+    for (std::size_t i = 0; i < vPolygon.size(); ++i)
+        vRectOffset[i+1] = vRectOffset[i]+task.vCount[i];
+    vRectangle.resize(vRectOffset.back());
+    for (std::size_t i = 0; i < vPolygon.size(); ++i)
+    {
+        std::vector<gtl::rectangle_data<int> >::const_iterator it = task.vChunkRect[i/task.chunk_size].begin()+task.vFirst[i];
+        std::copy(it, it+task.vCount[i], vRectangle.begin()+vRectOffset[i]);
+    }
+    return true;
+}
+
 }} // namespace limbo // namespace geometry
 
@@ -8,6 +8,7 @@
 #ifndef LIMBO_GEOMETRY_GEOBOOSTPOLYGONAPI_H
 #define LIMBO_GEOMETRY_GEOBOOSTPOLYGONAPI_H
 
+#include <vector>
 #include <boost/polygon/polygon.hpp>
 
 /// @brief namespace for Limbo
@@ -29,6 +30,21 @@ bool polygon2RectangleBoost(std::vector<gtl::point_data<int> > const& vPoint, st
 /// @param vRectangle a set of rectangles as output 
 /// @return true if succeeded 
 bool polygon2RectangleBoost(gtl::polygon_90_data<int> const& polygon, std::vector<gtl::rectangle_data<int> >& vRectangle);
+/// @brief this function decomposes many rectilinear polygons into rectangles with threads, using get_rectangles of Boost.Polygon 
+///
+/// Each thread claims chunks of consecutive polygons and decomposes them one by one in its own gtl::polygon_90_set_data, 
+/// which keeps its memory from polygon to polygon. 
+/// Polygons are not merged, so rectangles of each polygon are exactly those of gtl::polygon_90_set_data::get_rectangles on the polygon alone. 
+/// The output does not depend on the number of threads. 
+/// @param vPolygon rectilinear polygons as input 
+/// @param vRectangle rectangles of all polygons as output, rectangles of polygon i are [vRectOffset[i], vRectOffset[i+1]) 
+/// @param vRectOffset offsets of rectangles of each polygon, one more than the number of polygons 
+/// @param slicing_orient slicing orientation of get_rectangles 
+/// @param num_threads number of threads 
+/// @return true if succeeded 
+bool polygon2RectangleBoostBatch(std::vector<gtl::polygon_90_data<int> > const& vPolygon, 
+        std::vector<gtl::rectangle_data<int> >& vRectangle, std::vector<std::size_t>& vRectOffset, 
+        gtl::orientation_2d slicing_orient = gtl::HORIZONTAL, unsigned int num_threads = 1);
 
 } // namespace geometry
 } // namespace limbo
@@ -0,0 +1,180 @@
+/**
+ * @file   ParallelMath.h
+ * @brief  parallel reductions over contiguous arrays
+ *
+ * Overloads of the reductions in @ref Math.h with a number of threads.
+ * Arrays are cut into blocks of a fixed size, threads take blocks with an atomic counter,
+ * and partial results are combined in the order of blocks,
+ * so results do not depend on the number of threads.
+ * Arrays with fewer than 4 blocks per thread use fewer threads, short arrays only the calling thread.
+ *
+ * A separate header from @ref Math.h, so programs only link pthread when they use it.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_MATH_PARALLELMATH
+#define _LIMBO_MATH_PARALLELMATH
+
+#include <vector>
+#include <algorithm>
+#include <limbo/math/Math.h>
+#include <limbo/containers/TaskPool.h>
+
+/// number of elements of a block in parallel reductions
+#ifndef LIMBO_MATH_REDUCE_BLOCK
+#define LIMBO_MATH_REDUCE_BLOCK 32768
+#endif
+
+/// namespace for Limbo
+namespace limbo
+{
+
+/// @brief helpers of reductions over contiguous arrays
+namespace math_detail
+{
+
+/// @brief partial result of each block
+/// @tparam T element type
+/// @tparam R partial result type
+/// @tparam Reduce reduce(x, i, m) gives the result of elements [i, i+m)
+template <typename T, typename R, typename Reduce>
+struct ReduceKernel
+{
+	T const* x; ///< array
+	Reduce reduce; ///< reduction of a range
+	R* vPartial; ///< result of each block
+
+	/// @brief reduce the block of elements [i, j)
+	void operator()(std::size_t i, std::size_t j) const
+	{
+		vPartial[i/LIMBO_MATH_REDUCE_BLOCK] = reduce(x, i, j-i);
+	}
+};
+/// @brief reduce each block of an array, with the current thread working as well
+/// @param x array
+/// @param n number of elements
+/// @param reduce reduction of a range
+/// @param numThreads maximum number of threads, 0 for @ref limbo::containers::num_threads
+/// @param vPartial result of each block as output
+template <typename T, typename R, typename Reduce>
+inline void reduce_blocks(T const* x, std::size_t n, Reduce reduce, unsigned int numThreads, std::vector<R>& vPartial)
+{
+	typedef ReduceKernel<T, R, Reduce> kernel_type;
+	std::size_t numBlocks = (n+LIMBO_MATH_REDUCE_BLOCK-1)/LIMBO_MATH_REDUCE_BLOCK;
+	vPartial.resize(numBlocks);
+	if (numBlocks == 0)
+		return;
+	kernel_type kernel;
+	kernel.x = x;
+	kernel.reduce = reduce;
+	kernel.vPartial = &vPartial[0];
+	unsigned int budget = limbo::containers::num_threads();
+	numThreads = (numThreads == 0)? budget : std::min(numThreads, budget);
+	// a thread should get at least 4 blocks to pay for its creation
+	numThreads = (unsigned int)std::max(std::min((std::size_t)numThreads, numBlocks/4), (std::size_t)1);
+	limbo::containers::parallel_for(0, n, LIMBO_MATH_REDUCE_BLOCK, numThreads, kernel);
+}
+/// @brief pairwise sum of a range
+template <typename T>
+struct SumRange
+{
+	/// @return sum of elements [i, i+m)
+	T operator()(T const* x, std::size_t i, std::size_t m) const {return pairwise_sum(x+i, m);}
+};
+/// @brief max or min of a range
+template <typename T, typename Less>
+struct ExtremeRange
+{
+	/// @return max or min of elements [i, i+m)
+	T operator()(T const* x, std::size_t i, std::size_t m) const {return extreme(x+i, m, Less());}
+};
+/// @brief index of the first max or min of a range
+template <typename T, typename Less>
+struct ArgExtremeRange
+{
+	/// @return index of the first max or min of elements [i, i+m)
+	std::size_t operator()(T const* x, std::size_t i, std::size_t m) const {return i+arg_extreme(x+i, m, Less());}
+};
+/// @brief index of the first max or min of an array in parallel
+template <typename T, typename Less>
+inline std::size_t parallel_arg_extreme(T const* x, std::size_t n, unsigned int numThreads)
+{
+	std::vector<std::size_t> vPartial;
+	reduce_blocks(x, n, ArgExtremeRange<T, Less>(), numThreads, vPartial);
+	// blocks are in order, so a strict comparison keeps the first one on ties
+	Less less;
+	std::size_t best = vPartial[0];
+	for (std::size_t b = 1; b < vPartial.size(); ++b)
+	{
+		if (less(x[best], x[vPartial[b]]))
+			best = vPartial[b];
+	}
+	return best;
+}
+
+} // namespace math_detail
+
+/// @name parallel overloads for contiguous arrays
+/// @param first pointer to the first element
+/// @param last pointer past the last element
+/// @param numThreads maximum number of threads, 0 for @ref limbo::containers::num_threads
+///@{
+/// @brief get summation of an array pairwise in parallel
+/// @return sum value of an array
+template <typename T>
+inline typename std::iterator_traits<T*>::value_type sum(T* first, T* last, unsigned int numThreads)
+{
+	typedef typename std::iterator_traits<T*>::value_type value_type;
+	std::vector<value_type> vPartial;
+	math_detail::reduce_blocks(first, last-first, math_detail::SumRange<value_type>(), numThreads, vPartial);
+	return (vPartial.empty())? value_type(0) : math_detail::pairwise_sum(&vPartial[0], vPartial.size());
+}
+/// @brief get average of an array in parallel
+/// @return average value of an array
+template <typename T>
+inline typename std::iterator_traits<T*>::value_type average(T* first, T* last, unsigned int numThreads)
+{
+	return limbo::sum(first, last, numThreads)/(last-first);
+}
+/// @brief get max of a non-empty array in parallel
+/// @return max value of an array
+template <typename T>
+inline typename std::iterator_traits<T*>::value_type max(T* first, T* last, unsigned int numThreads)
+{
+	typedef typename std::iterator_traits<T*>::value_type value_type;
+	std::vector<value_type> vPartial;
+	math_detail::reduce_blocks(first, last-first, math_detail::ExtremeRange<value_type, math_detail::less_than>(), numThreads, vPartial);
+	return math_detail::extreme(&vPartial[0], vPartial.size(), math_detail::less_than());
+}
+/// @brief get min of a non-empty array in parallel
+/// @return min value of an array
+template <typename T>
+inline typename std::iterator_traits<T*>::value_type min(T* first, T* last, unsigned int numThreads)
+{
+	typedef typename std::iterator_traits<T*>::value_type value_type;
+	std::vector<value_type> vPartial;
+	math_detail::reduce_blocks(first, last-first, math_detail::ExtremeRange<value_type, math_detail::greater_than>(), numThreads, vPartial);
+	return math_detail::extreme(&vPartial[0], vPartial.size(), math_detail::greater_than());
+}
+/// @brief get the position of the first max of an array in parallel
+/// @return pointer to the max value, last if the array is empty
+template <typename T>
+inline T* argmax(T* first, T* last, unsigned int numThreads)
+{
+	typedef typename std::iterator_traits<T*>::value_type value_type;
+	return (first == last)? last : first+math_detail::parallel_arg_extreme<value_type, math_detail::less_than>(first, last-first, numThreads);
+}
+/// @brief get the position of the first min of an array in parallel
+/// @return pointer to the min value, last if the array is empty
+template <typename T>
+inline T* argmin(T* first, T* last, unsigned int numThreads)
+{
+	typedef typename std::iterator_traits<T*>::value_type value_type;
+	return (first == last)? last : first+math_detail::parallel_arg_extreme<value_type, math_detail::greater_than>(first, last-first, numThreads);
+}
+///@}
+
+} // namespace limbo
+
+#endif
@@ -65,6 +65,12 @@ void BookshelfDataBase::add_bookshelf_blockage_layers(string const& name, vector
     bookshelf_user_cbk_reminder(__func__); 
 }
 
+void BookshelfIndexDataBase::set_bookshelf_node_position(string const& name, double, double, string const&, string const&, bool)
+{
+    cerr << "Bookshelf node position by name: " << name << endl; 
+    bookshelf_user_cbk_reminder(__func__); 
+}
+
 void BookshelfDataBase::bookshelf_user_cbk_reminder(const char* str) const 
 {
     cerr << "A corresponding user-defined callback is necessary: " << str << endl;
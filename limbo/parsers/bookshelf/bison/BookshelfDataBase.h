@@ -149,11 +149,13 @@ struct NetPin : public Item
     char direct; ///< direction 
     double offset[2]; ///< offset (x, y) to node origin 
     double size[2]; ///< sizes (x, y) of pin 
+    int node_id; ///< index of the node in .nodes for @ref BookshelfParser::BookshelfIndexDataBase, otherwise -1 
 
     /// constructor 
     NetPin()
     {
         node_name = "";
+        node_id = -1;
         pin_name = ""; 
         direct = '\0';
         offset[0] = 0; 
@@ -170,6 +172,7 @@ struct NetPin : public Item
     NetPin(string& nn, char d, double x, double y, double w, double h, string& pn)
     {
         node_name.swap(nn);
+        node_id = -1;
         direct = d;
         offset[0] = x;
         offset[1] = y;
@@ -185,6 +188,7 @@ struct NetPin : public Item
     NetPin(string& nn, char d, double x, double y, double w, double h)
     {
         node_name.swap(nn);
+        node_id = -1;
         direct = d;
         offset[0] = x;
         offset[1] = y;
@@ -192,10 +196,27 @@ struct NetPin : public Item
         size[1] = h;
         pin_name.clear();
     }
+    /// constructor 
+    /// @param id index of the node 
+    /// @param d direction 
+    /// @param x, y offset of pin to node origin 
+    /// @param w, h size of pin 
+    /// @param pn pin name 
+    NetPin(int id, char d, double x, double y, double w, double h, string& pn)
+    {
+        node_id = id;
+        direct = d;
+        offset[0] = x;
+        offset[1] = y;
+        size[0] = w;
+        size[1] = h;
+        pin_name.swap(pn);
+    }
     /// reset all data members 
     void reset()
     {
         node_name = "";
+        node_id = -1;
         pin_name = "";
         direct = 'I';
         offset[0] = offset[1] = 0;
@@ -256,6 +277,38 @@ struct ShapeBox : public Item
     }
 };
 
+/// @brief position of a node in .pl file 
+struct PlNode : public Item
+{
+    string node_name; ///< node name 
+    double origin[2]; ///< x, y of lower left corner 
+    string orient; ///< orientation 
+    string status; ///< placement status like FIXED, empty if not given 
+    /// constructor 
+    PlNode()
+    {
+        reset();
+    }
+    /// reset all data members 
+    void reset()
+    {
+        node_name = "";
+        origin[0] = origin[1] = 0;
+        orient = "N";
+        status = "";
+    }
+    /// print data members 
+    /// @param ss output stream 
+    virtual void print(ostream& ss) const
+    {
+        ss << "//////// PlNode ////////" << endl
+            << "node_name = " << node_name << endl 
+            << "origin = " << origin[0] << " " << origin[1] << endl 
+            << "orient = " << orient << endl 
+            << "status = " << status << endl;
+    }
+};
+
 /// @brief node shape to describe the shapes of node 
 struct NodeShape : public Item 
 {
@@ -387,6 +440,8 @@ struct RouteInfo : public Item
 class BookshelfDataBase
 {
 	public:
+        /// @brief destructor, virtual for deleting derived databases through a base pointer 
+        virtual ~BookshelfDataBase() {}
         /// @brief set number of terminals 
         virtual void resize_bookshelf_node_terminals(int, int) = 0;
         /// @brief set number of nets 
@@ -427,12 +482,29 @@ class BookshelfDataBase
         virtual void set_bookshelf_design(string&) = 0;
         /// @brief a callback when a bookshelf file reaches to the end 
         virtual void bookshelf_end() = 0;
-    private:
+    protected:
         /// @brief remind users to define some optional callback functions at runtime 
         /// @param str message including the information to the callback function in the reminder 
         void bookshelf_user_cbk_reminder(const char* str) const;
 };
 
+/// @brief Base class for bookshelf database receiving node indices instead of names. 
+/// Nodes, terminals and terminal_NI's get dense indices in the order of .nodes, 
+/// i.e., the i-th call of @ref BookshelfParser::BookshelfDataBase::add_bookshelf_node, 
+/// @ref BookshelfParser::BookshelfDataBase::add_bookshelf_terminal or 
+/// @ref BookshelfParser::BookshelfDataBase::add_bookshelf_terminal_NI is node i. 
+/// Pins of nets refer to nodes by @ref BookshelfParser::NetPin::node_id with empty node names, 
+/// and .pl entries are passed by indices, so the database needs no map from names. 
+/// Names not in .nodes are still passed as strings. 
+class BookshelfIndexDataBase : public BookshelfDataBase
+{
+	public:
+        /// @brief set node position, only called by @ref BookshelfParser::readPl or for nodes not in .nodes 
+        virtual void set_bookshelf_node_position(string const&, double, double, string const&, string const&, bool);
+        /// @brief set node position by index 
+        virtual void set_bookshelf_node_position(int, double, double, string const&, string const&, bool) = 0;
+};
+
 } // namespace BookshelfParser
 
 #endif
@@ -8,18 +8,588 @@
 #include "BookshelfDriver.h"
 #include "BookshelfScanner.h"
 #include <limbo/string/String.h>
+#include <limbo/string/CharConv.h>
+#include <limbo/preprocessor/Instrument.h>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <strings.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <boost/unordered_map.hpp>
+#include <boost/cstdint.hpp>
+#include <limbo/parsers/common/PrefetchInputStream.h>
 #if ZLIB == 1 
-#include <limbo/thirdparty/gzstream/gzstream.h>
+#include <limbo/parsers/common/GzipInputStream.h>
 #endif
 
 namespace BookshelfParser {
 
+/// @brief dense indices of node names in the order of .nodes 
+class BookshelfNodeIndex
+{
+    public:
+        /// @brief constructor 
+        BookshelfNodeIndex() : m_numNodes(0) {}
+        /// @brief reserve space 
+        /// @param n number of nodes 
+        void reserve(int n) {m_mName2Index.rehash(std::max(n, 0));}
+        /// @brief add a node, a duplicated name keeps its first index 
+        /// @param name node name 
+        void insert(string const& name) {m_mName2Index.insert(std::make_pair(name, m_numNodes++));}
+        /// @param name node name 
+        /// @return index of the node, -1 if not found 
+        int find(string const& name) const 
+        {
+            boost::unordered_map<string, int>::const_iterator found = m_mName2Index.find(name); 
+            return (found == m_mName2Index.end())? -1 : found->second;
+        }
+    protected:
+        boost::unordered_map<string, int> m_mName2Index; ///< hash map from node name to index 
+        int m_numNodes; ///< number of nodes added 
+};
+
+/// @brief version of the binary cache, increased whenever the layout of recorded callbacks changes 
+#define BOOKSHELF_CACHE_VERSION 1
+
+/// @brief hash bytes 8 at a time, not cryptographic but enough to detect changed inputs 
+/// @param data first byte 
+/// @param size number of bytes, a multiple of 8 except for the last block of a stream 
+/// @param h hash of previous blocks 
+/// @return hash 
+static boost::uint64_t bookshelf_hash(const char* data, std::size_t size, boost::uint64_t h)
+{
+    const boost::uint64_t prime = 0x9E3779B97F4A7C15ULL; 
+    std::size_t i = 0; 
+    for (; i+8 <= size; i += 8)
+    {
+        boost::uint64_t w; 
+        memcpy(&w, data+i, 8); 
+        h = (h ^ w) * prime; 
+        h ^= h >> 29; 
+    }
+    for (; i < size; ++i)
+        h = (h ^ (unsigned char)data[i]) * prime; 
+    return h; 
+}
+
+/// @brief append recorded callbacks in binary, the same interface as @ref BookshelfParser::BookshelfCacheReader 
+struct BookshelfCacheWriter
+{
+    string buffer; ///< binary data 
+
+    /// @brief write plain data 
+    template <typename T>
+    void pod(T const& v) {buffer.append((const char*)&v, sizeof(T));}
+    /// @brief write a string 
+    void str(string const& s) 
+    {
+        boost::uint32_t n = s.size(); 
+        pod(n); 
+        buffer.append(s);
+    }
+    /// @brief write number of elements 
+    template <typename V>
+    void count(V const& v) 
+    {
+        boost::uint64_t n = v.size(); 
+        pod(n);
+    }
+    /// @brief write an array of plain data 
+    template <typename T>
+    void pods(vector<T> const& v) 
+    {
+        count(v); 
+        if (!v.empty())
+            buffer.append((const char*)&v[0], sizeof(T)*v.size());
+    }
+    /// @brief write boxes of a shape 
+    void boxes(vector<ShapeBox> const& v)
+    {
+        count(v); 
+        for (vector<ShapeBox>::const_iterator it = v.begin(); it != v.end(); ++it)
+        {
+            str(it->name); 
+            pod(it->origin); 
+            pod(it->size); 
+        }
+    }
+};
+
+/// @brief decode recorded callbacks from memory, e.g., a mapped cache file 
+struct BookshelfCacheReader
+{
+    const char* cur; ///< current byte 
+    const char* end; ///< end of data 
+    bool good; ///< false if data are truncated 
+
+    /// @brief constructor 
+    BookshelfCacheReader(const char* data, std::size_t size) : cur(data), end(data+size), good(true) {}
+    /// @brief read plain data 
+    template <typename T>
+    void pod(T& v) 
+    {
+        if ((std::size_t)(end-cur) < sizeof(T))
+        {
+            good = false; 
+            cur = end; 
+            return; 
+        }
+        memcpy(&v, cur, sizeof(T)); 
+        cur += sizeof(T);
+    }
+    /// @brief read a string 
+    void str(string& s) 
+    {
+        boost::uint32_t n = 0; 
+        pod(n); 
+        if ((std::size_t)(end-cur) < n)
+        {
+            good = false; 
+            n = end-cur; 
+        }
+        s.assign(cur, n); 
+        cur += n; 
+    }
+    /// @brief read number of elements and resize 
+    template <typename V>
+    void count(V& v) 
+    {
+        boost::uint64_t n = 0; 
+        pod(n); 
+        // each element takes at least one byte 
+        if (n > (boost::uint64_t)(end-cur))
+        {
+            good = false; 
+            n = 0; 
+        }
+        v.resize(n); 
+    }
+    /// @brief read an array of plain data 
+    template <typename T>
+    void pods(vector<T>& v) 
+    {
+        boost::uint64_t n = 0; 
+        pod(n); 
+        if (n > (boost::uint64_t)(end-cur)/sizeof(T))
+        {
+            good = false; 
+            n = 0; 
+        }
+        v.resize(n); 
+        if (n)
+            memcpy(&v[0], cur, sizeof(T)*n); 
+        cur += sizeof(T)*n; 
+    }
+    /// @brief read boxes of a shape 
+    void boxes(vector<ShapeBox>& v)
+    {
+        boost::uint64_t n = 0; 
+        pod(n); 
+        v.clear(); 
+        for (boost::uint64_t i = 0; i < n && good; ++i)
+        {
+            string name; 
+            double origin[2] = {0, 0}; 
+            double size[2] = {0, 0}; 
+            str(name); 
+            pod(origin); 
+            pod(size); 
+            v.push_back(ShapeBox(name, origin[0], origin[1], size[0], size[1])); 
+        }
+    }
+};
+
+/// @brief callbacks recorded by @ref BookshelfParser::BookshelfRecordDataBase 
+enum BookshelfCallbackType
+{
+    BOOKSHELF_RESIZE_NODE_TERMINALS, 
+    BOOKSHELF_RESIZE_NET, 
+    BOOKSHELF_RESIZE_PIN, 
+    BOOKSHELF_RESIZE_ROW, 
+    BOOKSHELF_RESIZE_SHAPES, 
+    BOOKSHELF_RESIZE_NITERMINAL_LAYERS, 
+    BOOKSHELF_RESIZE_BLOCKAGE_LAYERS, 
+    BOOKSHELF_ADD_TERMINAL, 
+    BOOKSHELF_ADD_TERMINAL_NI, 
+    BOOKSHELF_ADD_NODE, 
+    BOOKSHELF_ADD_NET, 
+    BOOKSHELF_ADD_ROW, 
+    BOOKSHELF_SET_NODE_POSITION, 
+    BOOKSHELF_SET_NODE_POSITION_INDEX, 
+    BOOKSHELF_SET_NET_WEIGHT, 
+    BOOKSHELF_SET_SHAPE, 
+    BOOKSHELF_SET_ROUTE_INFO, 
+    BOOKSHELF_ADD_NITERMINAL_LAYER, 
+    BOOKSHELF_ADD_BLOCKAGE_LAYERS, 
+    BOOKSHELF_SET_DESIGN
+};
+
+/// @brief a recorded callback with scalar arguments, 
+/// strings and objects are kept in pools of the database 
+struct BookshelfCallback
+{
+    BookshelfCallbackType type; ///< callback 
+    int value[2]; ///< integer arguments 
+    double coord[2]; ///< floating point arguments 
+    std::size_t index; ///< first entry in the pool of the type 
+    bool flag; ///< boolean argument 
+};
+
+/// @brief database recording callbacks of a file parsed by a thread, 
+/// which are replayed to the user database in the order of files 
+class BookshelfRecordDataBase : public BookshelfIndexDataBase
+{
+    public:
+        /// @brief constructor 
+        BookshelfRecordDataBase() {}
+
+        /// @cond
+        virtual void resize_bookshelf_node_terminals(int nn, int nt) {add(BOOKSHELF_RESIZE_NODE_TERMINALS, nn, nt);}
+        virtual void resize_bookshelf_net(int n) {add(BOOKSHELF_RESIZE_NET, n);}
+        virtual void resize_bookshelf_pin(int n) {add(BOOKSHELF_RESIZE_PIN, n);}
+        virtual void resize_bookshelf_row(int n) {add(BOOKSHELF_RESIZE_ROW, n);}
+        virtual void resize_bookshelf_shapes(int n) {add(BOOKSHELF_RESIZE_SHAPES, n);}
+        virtual void resize_bookshelf_niterminal_layers(int n) {add(BOOKSHELF_RESIZE_NITERMINAL_LAYERS, n);}
+        virtual void resize_bookshelf_blockage_layers(int n) {add(BOOKSHELF_RESIZE_BLOCKAGE_LAYERS, n);}
+        virtual void add_bookshelf_terminal(string& name, int w, int h) {add_string(name); add(BOOKSHELF_ADD_TERMINAL, w, h);}
+        virtual void add_bookshelf_terminal_NI(string& name, int w, int h) {add_string(name); add(BOOKSHELF_ADD_TERMINAL_NI, w, h);}
+        virtual void add_bookshelf_node(string& name, int w, int h, bool flag) 
+        {
+            add_string(name); 
+            add(BOOKSHELF_ADD_NODE, w, h).flag = flag;
+        }
+        virtual void add_bookshelf_net(Net const& n) 
+        {
+            add(BOOKSHELF_ADD_NET).index = m_vNet.size(); 
+            m_vNet.push_back(n);
+        }
+        virtual void add_bookshelf_row(Row const& r) 
+        {
+            add(BOOKSHELF_ADD_ROW).index = m_vRow.size(); 
+            m_vRow.push_back(r);
+        }
+        virtual void set_bookshelf_node_position(string const& name, double x, double y, string const& orient, string const& status, bool flag)
+        {
+            add_string(name); 
+            m_vString.push_back(orient); 
+            m_vString.push_back(status); 
+            BookshelfCallback& cbk = add(BOOKSHELF_SET_NODE_POSITION); 
+            cbk.index -= 2; 
+            cbk.coord[0] = x; 
+            cbk.coord[1] = y; 
+            cbk.flag = flag; 
+        }
+        virtual void set_bookshelf_node_position(int id, double x, double y, string const& orient, string const& status, bool flag)
+        {
+            add_string(orient); 
+            m_vString.push_back(status); 
+            BookshelfCallback& cbk = add(BOOKSHELF_SET_NODE_POSITION_INDEX, id); 
+            cbk.index -= 1; 
+            cbk.coord[0] = x; 
+            cbk.coord[1] = y; 
+            cbk.flag = flag; 
+        }
+        virtual void set_bookshelf_net_weight(string const& name, double w) 
+        {
+            add_string(name); 
+            add(BOOKSHELF_SET_NET_WEIGHT).coord[0] = w;
+        }
+        virtual void set_bookshelf_shape(NodeShape const& shape) 
+        {
+            add(BOOKSHELF_SET_SHAPE).index = m_vShape.size(); 
+            m_vShape.push_back(shape);
+        }
+        virtual void set_bookshelf_route_info(RouteInfo const& info) 
+        {
+            add(BOOKSHELF_SET_ROUTE_INFO).index = m_vRouteInfo.size(); 
+            m_vRouteInfo.push_back(info);
+        }
+        virtual void add_bookshelf_niterminal_layer(string const& name, string const& layer) 
+        {
+            add_string(name); 
+            m_vString.push_back(layer); 
+            add(BOOKSHELF_ADD_NITERMINAL_LAYER).index -= 1; 
+        }
+        virtual void add_bookshelf_blockage_layers(string const& name, vector<string> const& vLayer) 
+        {
+            add_string(name); 
+            add(BOOKSHELF_ADD_BLOCKAGE_LAYERS).value[0] = m_vLayers.size(); 
+            m_vLayers.push_back(vLayer);
+        }
+        virtual void set_bookshelf_design(string& name) {add_string(name); add(BOOKSHELF_SET_DESIGN);}
+        virtual void bookshelf_end() {}
+        /// @endcond
+
+        /// @brief invoke recorded callbacks of the user database in order 
+        /// @param db user database 
+        /// @param vNodeName if not NULL, node names are collected to pass node indices recorded 
+        /// for a cache to a database taking names 
+        void replay(BookshelfDataBase& db, vector<string>* vNodeName = NULL)
+        {
+            BookshelfIndexDataBase* indexDb = dynamic_cast<BookshelfIndexDataBase*>(&db);
+            for (vector<BookshelfCallback>::const_iterator it = m_vCallback.begin(); it != m_vCallback.end(); ++it)
+            {
+                BookshelfCallback const& cbk = *it;
+                switch (cbk.type)
+                {
+                    case BOOKSHELF_RESIZE_NODE_TERMINALS: db.resize_bookshelf_node_terminals(cbk.value[0], cbk.value[1]); break;
+                    case BOOKSHELF_RESIZE_NET: db.resize_bookshelf_net(cbk.value[0]); break;
+                    case BOOKSHELF_RESIZE_PIN: db.resize_bookshelf_pin(cbk.value[0]); break;
+                    case BOOKSHELF_RESIZE_ROW: db.resize_bookshelf_row(cbk.value[0]); break;
+                    case BOOKSHELF_RESIZE_SHAPES: db.resize_bookshelf_shapes(cbk.value[0]); break;
+                    case BOOKSHELF_RESIZE_NITERMINAL_LAYERS: db.resize_bookshelf_niterminal_layers(cbk.value[0]); break;
+                    case BOOKSHELF_RESIZE_BLOCKAGE_LAYERS: db.resize_bookshelf_blockage_layers(cbk.value[0]); break;
+                    case BOOKSHELF_ADD_TERMINAL: 
+                        if (vNodeName) vNodeName->push_back(m_vString[cbk.index]);
+                        db.add_bookshelf_terminal(m_vString[cbk.index], cbk.value[0], cbk.value[1]); 
+                        break;
+                    case BOOKSHELF_ADD_TERMINAL_NI: 
+                        if (vNodeName) vNodeName->push_back(m_vString[cbk.index]);
+                        db.add_bookshelf_terminal_NI(m_vString[cbk.index], cbk.value[0], cbk.value[1]); 
+                        break;
+                    case BOOKSHELF_ADD_NODE: 
+                        if (vNodeName) vNodeName->push_back(m_vString[cbk.index]);
+                        db.add_bookshelf_node(m_vString[cbk.index], cbk.value[0], cbk.value[1], cbk.flag); 
+                        break;
+                    case BOOKSHELF_ADD_NET: 
+                        if (vNodeName)
+                            to_node_names(m_vNet[cbk.index], *vNodeName); 
+                        db.add_bookshelf_net(m_vNet[cbk.index]); 
+                        // release memory early 
+                        Net().vNetPin.swap(m_vNet[cbk.index].vNetPin);
+                        break;
+                    case BOOKSHELF_ADD_ROW: db.add_bookshelf_row(m_vRow[cbk.index]); break;
+                    case BOOKSHELF_SET_NODE_POSITION: 
+                        db.set_bookshelf_node_position(m_vString[cbk.index], cbk.coord[0], cbk.coord[1], 
+                                m_vString[cbk.index+1], m_vString[cbk.index+2], cbk.flag); 
+                        break;
+                    case BOOKSHELF_SET_NODE_POSITION_INDEX: 
+                        if (indexDb)
+                            indexDb->set_bookshelf_node_position(cbk.value[0], cbk.coord[0], cbk.coord[1], 
+                                    m_vString[cbk.index], m_vString[cbk.index+1], cbk.flag); 
+                        else 
+                        {
+                            assert(vNodeName && cbk.value[0] < (int)vNodeName->size());
+                            db.set_bookshelf_node_position(vNodeName->at(cbk.value[0]), cbk.coord[0], cbk.coord[1], 
+                                    m_vString[cbk.index], m_vString[cbk.index+1], cbk.flag); 
+                        }
+                        break;
+                    case BOOKSHELF_SET_NET_WEIGHT: db.set_bookshelf_net_weight(m_vString[cbk.index], cbk.coord[0]); break;
+                    case BOOKSHELF_SET_SHAPE: db.set_bookshelf_shape(m_vShape[cbk.index]); break;
+                    case BOOKSHELF_SET_ROUTE_INFO: db.set_bookshelf_route_info(m_vRouteInfo[cbk.index]); break;
+                    case BOOKSHELF_ADD_NITERMINAL_LAYER: db.add_bookshelf_niterminal_layer(m_vString[cbk.index], m_vString[cbk.index+1]); break;
+                    case BOOKSHELF_ADD_BLOCKAGE_LAYERS: db.add_bookshelf_blockage_layers(m_vString[cbk.index], m_vLayers[cbk.value[0]]); break;
+                    case BOOKSHELF_SET_DESIGN: db.set_bookshelf_design(m_vString[cbk.index]); break;
+                    default: assert(0);
+                }
+            }
+        }
+        /// @brief write or read all records, see @ref BookshelfParser::BookshelfCacheWriter and @ref BookshelfParser::BookshelfCacheReader 
+        /// @param ar archive 
+        template <typename Archive>
+        void serialize(Archive& ar)
+        {
+            ar.pods(m_vCallback); 
+            ar.count(m_vString); 
+            for (vector<string>::iterator it = m_vString.begin(); it != m_vString.end(); ++it)
+                ar.str(*it); 
+            ar.count(m_vNet); 
+            for (vector<Net>::iterator it = m_vNet.begin(); it != m_vNet.end(); ++it)
+            {
+                ar.str(it->net_name); 
+                ar.count(it->vNetPin); 
+                for (vector<NetPin>::iterator itp = it->vNetPin.begin(); itp != it->vNetPin.end(); ++itp)
+                {
+                    ar.str(itp->node_name); 
+                    ar.str(itp->pin_name); 
+                    ar.pod(itp->direct); 
+                    ar.pod(itp->offset); 
+                    ar.pod(itp->size); 
+                    ar.pod(itp->node_id); 
+                }
+            }
+            ar.count(m_vRow); 
+            for (vector<Row>::iterator it = m_vRow.begin(); it != m_vRow.end(); ++it)
+            {
+                ar.pod(it->origin); 
+                ar.str(it->orient); 
+                ar.pod(it->height); 
+                ar.pod(it->site_num); 
+                ar.pod(it->site_width); 
+                ar.pod(it->site_spacing); 
+                ar.pod(it->site_orient); 
+                ar.str(it->site_orient_str); 
+                ar.pod(it->site_symmetry); 
+                ar.str(it->site_symmetry_str); 
+            }
+            ar.count(m_vShape); 
+            for (vector<NodeShape>::iterator it = m_vShape.begin(); it != m_vShape.end(); ++it)
+            {
+                ar.str(it->node_name); 
+                ar.boxes(it->vShapeBox); 
+            }
+            ar.count(m_vRouteInfo); 
+            for (vector<RouteInfo>::iterator it = m_vRouteInfo.begin(); it != m_vRouteInfo.end(); ++it)
+            {
+                ar.pod(it->numGrids); 
+                ar.pod(it->numLayers); 
+                ar.pods(it->vVerticalCapacity); 
+                ar.pods(it->vHorizontalCapacity); 
+                ar.pods(it->vMinWireWidth); 
+                ar.pods(it->vMinWireSpacing); 
+                ar.pods(it->vViaSpacing); 
+                ar.pod(it->gridOrigin); 
+                ar.pod(it->tileSize); 
+                ar.pod(it->blockagePorosity); 
+            }
+            ar.count(m_vLayers); 
+            for (vector<vector<string> >::iterator it = m_vLayers.begin(); it != m_vLayers.end(); ++it)
+            {
+                ar.count(*it); 
+                for (vector<string>::iterator its = it->begin(); its != it->end(); ++its)
+                    ar.str(*its); 
+            }
+        }
+        /// @return true if all callbacks refer to recorded arguments, e.g., after reading a cache 
+        bool valid() const 
+        {
+            for (vector<BookshelfCallback>::const_iterator it = m_vCallback.begin(); it != m_vCallback.end(); ++it)
+            {
+                std::size_t pool = m_vString.size(); // size of the pool referred to 
+                std::size_t n = 1; // number of entries referred to 
+                switch (it->type)
+                {
+                    case BOOKSHELF_RESIZE_NODE_TERMINALS: case BOOKSHELF_RESIZE_NET: case BOOKSHELF_RESIZE_PIN: 
+                    case BOOKSHELF_RESIZE_ROW: case BOOKSHELF_RESIZE_SHAPES: case BOOKSHELF_RESIZE_NITERMINAL_LAYERS: 
+                    case BOOKSHELF_RESIZE_BLOCKAGE_LAYERS: 
+                        continue; 
+                    case BOOKSHELF_ADD_NET: pool = m_vNet.size(); break; 
+                    case BOOKSHELF_ADD_ROW: pool = m_vRow.size(); break; 
+                    case BOOKSHELF_SET_SHAPE: pool = m_vShape.size(); break; 
+                    case BOOKSHELF_SET_ROUTE_INFO: pool = m_vRouteInfo.size(); break; 
+                    case BOOKSHELF_SET_NODE_POSITION: n = 3; break; 
+                    case BOOKSHELF_SET_NODE_POSITION_INDEX: case BOOKSHELF_ADD_NITERMINAL_LAYER: n = 2; break; 
+                    case BOOKSHELF_ADD_BLOCKAGE_LAYERS: 
+                        if (it->value[0] < 0 || (std::size_t)it->value[0] >= m_vLayers.size())
+                            return false; 
+                        break; 
+                    case BOOKSHELF_ADD_TERMINAL: case BOOKSHELF_ADD_TERMINAL_NI: case BOOKSHELF_ADD_NODE: 
+                    case BOOKSHELF_SET_NET_WEIGHT: case BOOKSHELF_SET_DESIGN: 
+                        break; 
+                    default: 
+                        return false; 
+                }
+                if (it->index >= pool || pool - it->index < n)
+                    return false; 
+            }
+            return true; 
+        }
+    protected:
+        /// @brief replace node indices of pins by names 
+        /// @param net net 
+        /// @param vNodeName names of nodes 
+        static void to_node_names(Net& net, vector<string> const& vNodeName)
+        {
+            for (vector<NetPin>::iterator it = net.vNetPin.begin(); it != net.vNetPin.end(); ++it)
+            {
+                if (it->node_id >= 0 && (std::size_t)it->node_id < vNodeName.size())
+                {
+                    it->node_name = vNodeName[it->node_id]; 
+                    it->node_id = -1; 
+                }
+            }
+        }
+        /// @brief append a callback 
+        /// @param type callback 
+        /// @param v0 first integer argument 
+        /// @param v1 second integer argument 
+        /// @return the callback, whose index refers to the last string 
+        BookshelfCallback& add(BookshelfCallbackType type, int v0 = 0, int v1 = 0)
+        {
+            m_vCallback.push_back(BookshelfCallback());
+            BookshelfCallback& cbk = m_vCallback.back();
+            cbk.type = type; 
+            cbk.value[0] = v0; 
+            cbk.value[1] = v1; 
+            cbk.coord[0] = cbk.coord[1] = 0; 
+            cbk.index = m_vString.size()-1; 
+            cbk.flag = false; 
+            return cbk; 
+        }
+        /// @brief append a string to the pool 
+        /// @param s string 
+        void add_string(string const& s) {m_vString.push_back(s);}
+
+        vector<BookshelfCallback> m_vCallback; ///< callbacks in order 
+        vector<string> m_vString; ///< string arguments 
+        vector<Net> m_vNet; ///< nets 
+        vector<Row> m_vRow; ///< rows 
+        vector<NodeShape> m_vShape; ///< node shapes 
+        vector<RouteInfo> m_vRouteInfo; ///< routing information 
+        vector<vector<string> > m_vLayers; ///< layers of blockages 
+};
+
+/// @brief files shared by threads of @ref BookshelfParser::read 
+struct BookshelfParallelData
+{
+    vector<string> const* vFilename; ///< files in the order of callbacks 
+    vector<BookshelfRecordDataBase*> vDataBase; ///< recorded callbacks of files 
+    vector<char> vResult; ///< parsing results of files 
+    vector<char> vDone; ///< whether files have been parsed 
+    std::size_t next; ///< next file to parse 
+    BookshelfNodeIndex* nodeIndex; ///< map from node names to indices, NULL if not used 
+    std::size_t nodesFile; ///< .nodes, which later files wait for if node indices are used 
+    pthread_mutex_t mutex; ///< lock of vDone 
+    pthread_cond_t cond; ///< signal when a file has been parsed 
+};
+
+/// @brief thread function to parse files in turn 
+/// @param arg pointer to @ref BookshelfParser::BookshelfParallelData 
+/// @return NULL 
+static void* bookshelf_parse_files(void* arg)
+{
+    BookshelfParallelData& data = *(BookshelfParallelData*)arg;
+    while (true)
+    {
+        std::size_t i = __sync_fetch_and_add(&data.next, (std::size_t)1);
+        if (i >= data.vFilename->size())
+            break;
+        if (data.nodeIndex && i > data.nodesFile)
+        {
+            // node indices are looked up after .nodes has been parsed 
+            pthread_mutex_lock(&data.mutex);
+            while (!data.vDone[data.nodesFile])
+                pthread_cond_wait(&data.cond, &data.mutex);
+            pthread_mutex_unlock(&data.mutex);
+        }
+        BookshelfRecordDataBase* db = new BookshelfRecordDataBase;
+        Driver driver (*db);
+        driver.setNodeIndex(data.nodeIndex);
+        bool result = driver.parse_file(data.vFilename->at(i));
+
+        pthread_mutex_lock(&data.mutex);
+        data.vDataBase[i] = db;
+        data.vResult[i] = result;
+        data.vDone[i] = true;
+        pthread_cond_broadcast(&data.cond);
+        pthread_mutex_unlock(&data.mutex);
+    }
+    return NULL;
+}
+
 Driver::Driver(BookshelfDataBase& db)
     : trace_scanning(false),
       trace_parsing(false),
+      profile("BookshelfParser"),
       m_db(db), 
-      m_plFlag(false)
+      m_plFlag(false), 
+      m_indexDb(dynamic_cast<BookshelfIndexDataBase*>(&db)), 
+      m_nodeIndex(NULL)
 {
     m_row.reset();
     m_net.reset();
@@ -29,6 +599,7 @@ Driver::Driver(BookshelfDataBase& db)
 
 bool Driver::parse_stream(std::istream& in, const std::string& sname)
 {
+    limboParserParse(profile);
     streamname = sname;
 
     Scanner scanner(&in);
@@ -43,15 +614,15 @@ bool Driver::parse_stream(std::istream& in, const std::string& sname)
 bool Driver::parse_file(const std::string &filename)
 {
 #if ZLIB == 1
-    if (limbo::get_file_suffix(filename) == "gz") // detect .gz file 
+    if (limbo::is_gzip_file(filename)) // detect .gz file, inflated by a helper thread 
     {
-        igzstream in (filename.c_str());
+        limbo::GzipInputStream in (filename);
 
         if (!in.good()) return false;
         return parse_stream(in, filename);
     }
 #endif
-    std::ifstream in(filename.c_str());
+    limbo::PrefetchInputStream in (filename); // read ahead by a helper thread 
     if (!in.good()) return false;
     return parse_stream(in, filename);
 }
@@ -73,6 +644,11 @@ void Driver::error(const std::string& m)
     std::cerr << m << std::endl;
 }
 
+void Driver::setNodeIndex(BookshelfNodeIndex* nodeIndex)
+{
+    // indices can only be passed to a database taking them 
+    m_nodeIndex = (m_indexDb)? nodeIndex : NULL;
+}
 // control m_plFlag
 void Driver::setPlFlag(bool flag) 
 {
@@ -82,42 +658,74 @@ void Driver::setPlFlag(bool flag)
 // .nodes file 
 void Driver::numNodeTerminalsCbk(int nn, int nt)
 {
+    if (m_nodeIndex)
+        m_nodeIndex->reserve(nn);
+    limboParserCallback(profile);
     m_db.resize_bookshelf_node_terminals(nn, nt);
 }
 void Driver::terminalEntryCbk(string& name, int w, int h)
 {
+    limboParserRecord(profile, "nodes");
+    if (m_nodeIndex)
+        m_nodeIndex->insert(name);
+    limboParserCallback(profile);
     m_db.add_bookshelf_terminal(name, w, h);
 }
 void Driver::terminalNIEntryCbk(string& name, int w, int h)
 {
+    limboParserRecord(profile, "nodes");
+    if (m_nodeIndex)
+        m_nodeIndex->insert(name);
+    limboParserCallback(profile);
     m_db.add_bookshelf_terminal_NI(name, w, h);
 }
 void Driver::nodeEntryCbk(string& name, int w, int h, string&)
 {
+    limboParserRecord(profile, "nodes");
+    if (m_nodeIndex)
+        m_nodeIndex->insert(name);
+    limboParserCallback(profile);
     m_db.add_bookshelf_node(name, w, h, true);
 }
 void Driver::nodeEntryCbk(string& name, int w, int h)
 {
+    limboParserRecord(profile, "nodes");
+    if (m_nodeIndex)
+        m_nodeIndex->insert(name);
+    limboParserCallback(profile);
     m_db.add_bookshelf_node(name, w, h, true);
 }
 // .nets file 
 void Driver::numNetCbk(int n)
 {
+    limboParserCallback(profile);
     m_db.resize_bookshelf_net(n);
 }
 void Driver::numPinCbk(int n)
 {
+    limboParserCallback(profile);
     m_db.resize_bookshelf_pin(n);
 }
 void Driver::netPinEntryCbk(string& node_name, char direct, double offsetX, double offsetY, double w, double h, string& pin_name)
 {
     // not sure whether w or h has the correct meaning 
-    m_net.vNetPin.push_back(NetPin(node_name, direct, offsetX, offsetY, w, h, pin_name));
+    int id = (m_nodeIndex)? m_nodeIndex->find(node_name) : -1;
+    if (id >= 0)
+        m_net.vNetPin.push_back(NetPin(id, direct, offsetX, offsetY, w, h, pin_name));
+    else 
+        m_net.vNetPin.push_back(NetPin(node_name, direct, offsetX, offsetY, w, h, pin_name));
 }
 void Driver::netPinEntryCbk(string& node_name, char direct, double offsetX, double offsetY, double w, double h)
 {
     // not sure whether w or h has the correct meaning 
-    m_net.vNetPin.push_back(NetPin(node_name, direct, offsetX, offsetY, w, h));
+    int id = (m_nodeIndex)? m_nodeIndex->find(node_name) : -1;
+    if (id >= 0)
+    {
+        string pin_name; 
+        m_net.vNetPin.push_back(NetPin(id, direct, offsetX, offsetY, w, h, pin_name));
+    }
+    else 
+        m_net.vNetPin.push_back(NetPin(node_name, direct, offsetX, offsetY, w, h));
 }
 void Driver::netNameAndDegreeCbk(string& net_name, int degree)
 {
@@ -127,21 +735,44 @@ void Driver::netNameAndDegreeCbk(string& net_name, int degree)
 }
 void Driver::netEntryCbk()
 {
-    m_db.add_bookshelf_net(m_net);
+    limboParserRecord(profile, "nets");
+    {
+        limboParserCallback(profile);
+        m_db.add_bookshelf_net(m_net);
+    }
     m_net.reset();
 }
 // .pl file 
 void Driver::plNodeEntryCbk(string& node_name, double x, double y, string& orient, string& status)
 {
+    limboParserRecord(profile, "pl");
+    int id = (m_nodeIndex)? m_nodeIndex->find(node_name) : -1;
+    if (id >= 0)
+    {
+        limboParserCallback(profile);
+        m_indexDb->set_bookshelf_node_position(id, x, y, orient, status, m_plFlag);
+        return;
+    }
+    limboParserCallback(profile);
     m_db.set_bookshelf_node_position(node_name, x, y, orient, status, m_plFlag);
 }
 void Driver::plNodeEntryCbk(string& node_name, double x, double y, string& orient)
 {
+    limboParserRecord(profile, "pl");
+    int id = (m_nodeIndex)? m_nodeIndex->find(node_name) : -1;
+    if (id >= 0)
+    {
+        limboParserCallback(profile);
+        m_indexDb->set_bookshelf_node_position(id, x, y, orient, "", m_plFlag);
+        return;
+    }
+    limboParserCallback(profile);
     m_db.set_bookshelf_node_position(node_name, x, y, orient, "", m_plFlag);
 }
 // .scl file 
 void Driver::sclNumRows(int n)
 {
+    limboParserCallback(profile);
     m_db.resize_bookshelf_row(n);
 }
 void Driver::sclCoreRowStart(string const& orient)
@@ -190,17 +821,22 @@ void Driver::sclCoreRowNumSites(int site_num)
 }
 void Driver::sclCoreRowEnd()
 {
+    limboParserRecord(profile, "scl");
+    limboParserCallback(profile);
     m_db.add_bookshelf_row(m_row);
     m_row.reset();
 }
 // .wts file 
 void Driver::wtsNetWeightEntry(string& net_name, double weight)
 {
+    limboParserRecord(profile, "wts");
+    limboParserCallback(profile);
     m_db.set_bookshelf_net_weight(net_name, weight);
 }
 // .shapes file 
 void Driver::shapesNumNonRectangularNodesCbk(int n)
 {
+    limboParserCallback(profile);
     m_db.resize_bookshelf_shapes(n);
 }
 void Driver::shapesEntryCbk(string& shape_name, double xl, double yl, double w, double h)
@@ -209,8 +845,10 @@ void Driver::shapesEntryCbk(string& shape_name, double xl, double yl, double w,
 }
 void Driver::shapesNodeNameCbk(string& node_name, int n)
 {
+    limboParserRecord(profile, "shapes");
     if (!m_shape.node_name.empty())
     {
+        limboParserCallback(profile);
         m_db.set_bookshelf_shape(m_shape); 
     }
     m_shape.reset(); 
@@ -221,6 +859,7 @@ void Driver::shapesEndCbk()
 {
     if (!m_shape.node_name.empty())
     {
+        limboParserCallback(profile);
         m_db.set_bookshelf_shape(m_shape); 
     }
 }
@@ -279,22 +918,28 @@ void Driver::routeNumNiTerminalsCbk(int n)
 {
     if (!m_routeInfo.vVerticalCapacity.empty() || !m_routeInfo.vHorizontalCapacity.empty())
     {
+        limboParserCallback(profile);
         m_db.set_bookshelf_route_info(m_routeInfo); 
         m_routeInfo.reset(); 
     }
+    limboParserCallback(profile);
     m_db.resize_bookshelf_niterminal_layers(n); 
 } 
 /// @brief from .route file, for IO pins, (node_name layer_id_for_all_node_pins) 
 void Driver::routePinLayerCbk(string& name, int layer)
 {
+    limboParserRecord(profile, "route");
     // convert to name 
     char buf[64]; 
     sprintf(buf, "%d", layer);
     string layerName (buf); 
+    limboParserCallback(profile);
     m_db.add_bookshelf_niterminal_layer(name, layerName);
 } 
 void Driver::routePinLayerCbk(string& name, string& layer)
 {
+    limboParserRecord(profile, "route");
+    limboParserCallback(profile);
     m_db.add_bookshelf_niterminal_layer(name, layer);
 } 
 /// @brief from .route file, number of blockage nodes
@@ -302,14 +947,17 @@ void Driver::routeNumBlockageNodes(int n)
 {
     if (!m_routeInfo.vVerticalCapacity.empty() || !m_routeInfo.vHorizontalCapacity.empty())
     {
+        limboParserCallback(profile);
         m_db.set_bookshelf_route_info(m_routeInfo); 
         m_routeInfo.reset(); 
     }
+    limboParserCallback(profile);
     m_db.resize_bookshelf_blockage_layers(n);
 } 
 /// @brief from .route file, for blockages, (node_name num_blocked_layers list_of_blocked_layers) 
 void Driver::routeBlockageNodeLayerCbk(string& name, int, IntegerArray& vLayer)
 {
+    limboParserRecord(profile, "route");
     // convert to name 
     std::vector<std::string> vLayerName (vLayer.size()); 
     for (unsigned int i = 0; i < vLayer.size(); ++i)
@@ -318,15 +966,19 @@ void Driver::routeBlockageNodeLayerCbk(string& name, int, IntegerArray& vLayer)
         sprintf(buf, "%d", vLayer[i]); 
         vLayerName[i] = buf; 
     }
+    limboParserCallback(profile);
     m_db.add_bookshelf_blockage_layers(name, vLayerName);
 } 
 void Driver::routeBlockageNodeLayerCbk(string& name, int, StringArray& vLayer)
 {
+    limboParserRecord(profile, "route");
+    limboParserCallback(profile);
     m_db.add_bookshelf_blockage_layers(name, vLayer);
 } 
 // .aux file 
 void Driver::auxCbk(string& design_name, vector<string>& vBookshelfFiles)
 {
+    limboParserCallback(profile);
     m_db.set_bookshelf_design(design_name);
     m_vBookshelfFiles.swap(vBookshelfFiles);
 }
@@ -340,25 +992,14 @@ struct SortByPairFirst
     }
 };
 
-bool read(BookshelfDataBase& db, const string& auxFile)
+/// @brief order files listed in .aux for parsing 
+/// @param driverAux driver having parsed .aux 
+/// @param auxFile .aux file 
+/// @param gzFlag whether .aux is compressed 
+/// @param vFilename files with paths in the order of parsing 
+/// @return position of .nodes in vFilename, or the number of files if not found 
+static std::size_t bookshelf_order_files(Driver const& driverAux, const string& auxFile, bool gzFlag, vector<string>& vFilename)
 {
-    // first read .aux 
-	Driver driverAux (db);
-	//driver.trace_scanning = true;
-	//driver.trace_parsing = true;
-
-    bool gzFlag = limbo::iequals(limbo::get_file_suffix(auxFile), "gz"); // compressed or not 
-#if ZLIB == 0
-    if (gzFlag)
-    {
-        std::cerr << "compile with ZLIB_DIR defined to read .gz files\n";
-        return false; 
-    }
-#endif
-	bool flagAux = driverAux.parse_file(auxFile);
-    if (!flagAux)
-        return false;
-
     string auxPath = limbo::get_file_path(auxFile);
 
     // (visit_order, index)
@@ -388,27 +1029,330 @@ bool read(BookshelfDataBase& db, const string& auxFile)
     // order by visit_order 
     std::sort(vOrder.begin(), vOrder.end(), SortByPairFirst());
 
-    // start parsing 
+    std::size_t nodesFile = vOrder.size(); 
+    vFilename.clear(); 
+    vFilename.reserve(vOrder.size()); 
     for (vector<std::pair<int, int> >::const_iterator it = vOrder.begin(); it != vOrder.end(); ++it)
     {
         std::pair<int, int> const& order = *it;
+        if (order.first == 1) // .nodes 
+            nodesFile = vFilename.size(); 
         string filename = driverAux.bookshelfFiles().at(order.second);
         if (gzFlag && !limbo::iequals(limbo::get_file_suffix(filename), "gz"))
         {
             filename += ".gz";
         }
+        vFilename.push_back(auxPath + "/" + filename);
+    }
+    return nodesFile; 
+}
 
-        Driver driver (db);
-        bool flag = driver.parse_file(auxPath + "/" + filename);
-        if (!flag)
-            return false;
+/// @brief parse files listed in .aux into the database 
+/// @param db user database 
+/// @param vFilename files in the order of parsing 
+/// @param nodesFile position of .nodes in vFilename 
+/// @param numThreads number of threads 
+/// @param nodeIndex map from node names to indices, NULL if not used 
+/// @param cache if not NULL, recorded callbacks of files are appended for @ref BookshelfParser::readCached 
+/// @return true if succeed 
+static bool bookshelf_parse_all(BookshelfDataBase& db, vector<string> const& vFilename, std::size_t nodesFile, 
+        int numThreads, BookshelfNodeIndex* nodeIndex, BookshelfCacheWriter* cache)
+{
+    if (!cache && (numThreads <= 1 || vFilename.size() <= 1))
+    {
+        for (vector<string>::const_iterator it = vFilename.begin(); it != vFilename.end(); ++it)
+        {
+            Driver driver (db);
+            driver.setNodeIndex(nodeIndex);
+            bool flag = driver.parse_file(*it);
+            if (!flag)
+                return false;
+        }
+        return true; 
     }
+
+    // threads parse files into their own databases, 
+    // and the current thread passes callbacks to the user database in the order of files 
+    BookshelfParallelData data; 
+    data.vFilename = &vFilename; 
+    data.vDataBase.assign(vFilename.size(), NULL); 
+    data.vResult.assign(vFilename.size(), false); 
+    data.vDone.assign(vFilename.size(), false); 
+    data.next = 0; 
+    data.nodeIndex = nodeIndex; 
+    data.nodesFile = nodesFile; 
+    pthread_mutex_init(&data.mutex, NULL);
+    pthread_cond_init(&data.cond, NULL);
+
+    std::size_t numWorkers = (numThreads <= 1)? 0 : std::min((std::size_t)numThreads, vFilename.size());
+    vector<pthread_t> vThread (numWorkers);
+    std::size_t numCreated = 0; 
+    for (std::size_t i = 0; i < numWorkers; ++i)
+    {
+        if (pthread_create(&vThread[numCreated], NULL, bookshelf_parse_files, &data) == 0)
+            ++numCreated; 
+    }
+    // parse in the current thread if no thread is available 
+    if (numCreated == 0)
+        bookshelf_parse_files(&data); 
+
+    // recorded node indices are passed as names to databases only taking names 
+    vector<string> vNodeName; 
+    vector<string>* pNodeName = (nodeIndex && !dynamic_cast<BookshelfIndexDataBase*>(&db))? &vNodeName : NULL; 
+    if (cache)
+    {
+        boost::uint64_t numFiles = vFilename.size(); 
+        cache->pod(numFiles); 
+    }
+    // replays are reported as callbacks, records are counted by the threads parsing the files 
+    limbo::ParserProfile profile ("BookshelfParser"); 
+    bool flag = true; 
+    for (std::size_t i = 0; i < vFilename.size(); ++i)
+    {
+        pthread_mutex_lock(&data.mutex);
+        while (!data.vDone[i])
+            pthread_cond_wait(&data.cond, &data.mutex);
+        pthread_mutex_unlock(&data.mutex);
+        // same callbacks as the serial mode, so stop after the first failed file 
+        if (flag)
+        {
+            flag = data.vResult[i];
+            // replay moves pins of nets, so record first 
+            if (cache && flag)
+                data.vDataBase[i]->serialize(*cache); 
+            limboParserCallback(profile);
+            data.vDataBase[i]->replay(db, pNodeName);
+        }
+        delete data.vDataBase[i];
+        data.vDataBase[i] = NULL;
+    }
+    for (std::size_t i = 0; i < numCreated; ++i)
+        pthread_join(vThread[i], NULL);
+    pthread_cond_destroy(&data.cond);
+    pthread_mutex_destroy(&data.mutex);
+    return flag; 
+}
+
+bool read(BookshelfDataBase& db, const string& auxFile, int numThreads)
+{
+    limboScopedTimer("BookshelfParser::read");
+    limboScopedAllocations("BookshelfParser::read");
+    // first read .aux 
+	Driver driverAux (db);
+	//driver.trace_scanning = true;
+	//driver.trace_parsing = true;
+
+    bool gzFlag = limbo::iequals(limbo::get_file_suffix(auxFile), "gz"); // compressed or not 
+#if ZLIB == 0
+    if (gzFlag)
+    {
+        std::cerr << "compile with ZLIB_DIR defined to read .gz files\n";
+        return false; 
+    }
+#endif
+	bool flagAux = driverAux.parse_file(auxFile);
+    if (!flagAux)
+        return false;
+
+    vector<string> vFilename; 
+    std::size_t nodesFile = bookshelf_order_files(driverAux, auxFile, gzFlag, vFilename); 
+
+    // node indices for databases taking them 
+    BookshelfNodeIndex nodeIndex; 
+    BookshelfNodeIndex* pNodeIndex = (dynamic_cast<BookshelfIndexDataBase*>(&db))? &nodeIndex : NULL; 
+
+    // start parsing 
+    if (!bookshelf_parse_all(db, vFilename, nodesFile, numThreads, pNodeIndex, NULL))
+        return false; 
     // inform database that parsing is completed 
     db.bookshelf_end(); 
 
     return true;
 }
 
+/// @brief header of cache files written by @ref BookshelfParser::readCached 
+struct BookshelfCacheHeader
+{
+    char magic[8]; ///< "LIMBOBS" 
+    boost::uint32_t version; ///< @ref BOOKSHELF_CACHE_VERSION 
+    boost::uint32_t byteOrder; ///< 0x01020304 written in native byte order 
+    boost::uint32_t callbackSize; ///< sizeof(BookshelfCallback), which differs between ABIs 
+    boost::uint32_t reserved; ///< padding 
+    boost::uint64_t inputHash; ///< hash of .aux and all listed files 
+    boost::uint64_t payloadHash; ///< hash of recorded callbacks 
+    boost::uint64_t payloadSize; ///< number of bytes of recorded callbacks 
+
+    /// @brief constructor 
+    /// @param h hash of input files 
+    BookshelfCacheHeader(boost::uint64_t h = 0)
+    {
+        memset(this, 0, sizeof(*this)); 
+        memcpy(magic, "LIMBOBS", 8); 
+        version = BOOKSHELF_CACHE_VERSION; 
+        byteOrder = 0x01020304; 
+        callbackSize = sizeof(BookshelfCallback); 
+        inputHash = h; 
+    }
+    /// @return true if written by the same version and ABI for the same input files 
+    /// @param rhs expected header 
+    bool match(BookshelfCacheHeader const& rhs) const 
+    {
+        return memcmp(magic, rhs.magic, 8) == 0 && version == rhs.version && byteOrder == rhs.byteOrder 
+            && callbackSize == rhs.callbackSize && inputHash == rhs.inputHash; 
+    }
+};
+
+/// @brief hash contents of a file 
+/// @param filename file 
+/// @param h hash of previous files 
+/// @return false if failed to read 
+static bool bookshelf_hash_file(const string& filename, boost::uint64_t& h)
+{
+    std::FILE* fp = std::fopen(filename.c_str(), "rb"); 
+    if (!fp)
+        return false; 
+    vector<char> vBuffer (1024*1024); 
+    boost::uint64_t size = 0; 
+    std::size_t n; 
+    while ((n = std::fread(&vBuffer[0], 1, vBuffer.size(), fp)) > 0)
+    {
+        h = bookshelf_hash(&vBuffer[0], n, h); 
+        size += n; 
+    }
+    bool flag = !std::ferror(fp); 
+    std::fclose(fp); 
+    // separate contents of consecutive files 
+    h = bookshelf_hash((const char*)&size, sizeof(size), h); 
+    return flag; 
+}
+
+/// @brief replay recorded callbacks from a cache file 
+/// @param db user database 
+/// @param cacheFile cache file 
+/// @param expected header computed from input files 
+/// @param numFiles number of files listed in .aux 
+/// @param indexFlag whether records refer to nodes by indices 
+/// @return false if the cache is missing or stale, in which case the database is untouched 
+static bool bookshelf_load_cache(BookshelfDataBase& db, const string& cacheFile, BookshelfCacheHeader const& expected, 
+        std::size_t numFiles, bool indexFlag)
+{
+    int fd = open(cacheFile.c_str(), O_RDONLY); 
+    if (fd < 0)
+        return false; 
+    struct stat st; 
+    if (fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(BookshelfCacheHeader))
+    {
+        close(fd); 
+        return false; 
+    }
+    std::size_t size = st.st_size; 
+    void* addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0); 
+    close(fd); 
+    if (addr == MAP_FAILED)
+        return false; 
+    const char* data = (const char*)addr; 
+
+    BookshelfCacheHeader header; 
+    memcpy(&header, data, sizeof(header)); 
+    const char* payload = data + sizeof(header); 
+    bool flag = header.match(expected) && header.payloadSize == size - sizeof(header) 
+        && header.payloadHash == bookshelf_hash(payload, header.payloadSize, 0); 
+
+    // decode all files before any callback, so a bad cache does not leave a partial database 
+    vector<BookshelfRecordDataBase*> vDataBase; 
+    if (flag)
+    {
+        BookshelfCacheReader reader (payload, header.payloadSize); 
+        boost::uint64_t n = 0; 
+        reader.pod(n); 
+        flag = (n == numFiles); 
+        for (std::size_t i = 0; flag && i < numFiles; ++i)
+        {
+            vDataBase.push_back(new BookshelfRecordDataBase); 
+            vDataBase.back()->serialize(reader); 
+            flag = reader.good && vDataBase.back()->valid(); 
+        }
+        flag = flag && reader.cur == reader.end; 
+    }
+    munmap(addr, size); 
+
+    vector<string> vNodeName; 
+    vector<string>* pNodeName = (indexFlag && !dynamic_cast<BookshelfIndexDataBase*>(&db))? &vNodeName : NULL; 
+    for (std::size_t i = 0; i < vDataBase.size(); ++i)
+    {
+        if (flag)
+            vDataBase[i]->replay(db, pNodeName); 
+        delete vDataBase[i]; 
+    }
+    return flag; 
+}
+
+bool readCached(BookshelfDataBase& db, const string& auxFile, const string& cacheFile, int numThreads)
+{
+    // .aux is small, so always parse it 
+	Driver driverAux (db);
+    bool gzFlag = limbo::iequals(limbo::get_file_suffix(auxFile), "gz"); // compressed or not 
+#if ZLIB == 0
+    if (gzFlag)
+    {
+        std::cerr << "compile with ZLIB_DIR defined to read .gz files\n";
+        return false; 
+    }
+#endif
+	bool flagAux = driverAux.parse_file(auxFile);
+    if (!flagAux)
+        return false;
+
+    vector<string> vFilename; 
+    std::size_t nodesFile = bookshelf_order_files(driverAux, auxFile, gzFlag, vFilename); 
+
+    // a stale cache is detected by contents of input files 
+    boost::uint64_t inputHash = 0; 
+    bool hashFlag = bookshelf_hash_file(auxFile, inputHash); 
+    for (vector<string>::const_iterator it = vFilename.begin(); hashFlag && it != vFilename.end(); ++it)
+        hashFlag = bookshelf_hash_file(*it, inputHash); 
+    BookshelfCacheHeader header (inputHash); 
+    // indices are cheaper to record than names if .nodes exists 
+    bool indexFlag = nodesFile < vFilename.size(); 
+
+    if (hashFlag && bookshelf_load_cache(db, cacheFile, header, vFilename.size(), indexFlag))
+    {
+        db.bookshelf_end(); 
+        return true; 
+    }
+
+    BookshelfNodeIndex nodeIndex; 
+    BookshelfCacheWriter cache; 
+    cache.buffer.append(sizeof(header), '\0'); 
+    if (!bookshelf_parse_all(db, vFilename, nodesFile, numThreads, (indexFlag)? &nodeIndex : NULL, &cache))
+        return false; 
+    db.bookshelf_end(); 
+
+    if (hashFlag)
+    {
+        header.payloadSize = cache.buffer.size() - sizeof(header); 
+        header.payloadHash = bookshelf_hash(cache.buffer.data() + sizeof(header), header.payloadSize, 0); 
+        memcpy(&cache.buffer[0], &header, sizeof(header)); 
+        // write to a temporary file first, so readers never see a partial cache 
+        string tmpFile = cacheFile + ".tmp"; 
+        std::FILE* fp = std::fopen(tmpFile.c_str(), "wb"); 
+        bool flag = (fp != NULL); 
+        if (fp)
+        {
+            flag = std::fwrite(cache.buffer.data(), 1, cache.buffer.size(), fp) == cache.buffer.size(); 
+            flag = (std::fclose(fp) == 0) && flag; 
+        }
+        if (flag)
+            flag = (std::rename(tmpFile.c_str(), cacheFile.c_str()) == 0); 
+        if (!flag)
+        {
+            std::remove(tmpFile.c_str()); 
+            cerr << "warning: failed to write Bookshelf cache " << cacheFile << endl; 
+        }
+    }
+    return true; 
+}
+
 /// read .pl file only, the callback only provide positions and orientation 
 bool readPl(BookshelfDataBase& db, const string& plFile)
 {
@@ -427,5 +1371,182 @@ bool readPl(BookshelfDataBase& db, const string& plFile)
     return true;
 }
 
+/// @brief read a whole file into memory 
+/// @param filename file, possibly gzipped 
+/// @param content content of the file 
+/// @return true if succeed 
+static bool bookshelf_read_file(const string& filename, string& content)
+{
+#if ZLIB == 1
+    if (limbo::is_gzip_file(filename))
+    {
+        limbo::GzipInputStream in (filename);
+        if (!in.good()) return false;
+        std::ostringstream oss; 
+        oss << in.rdbuf(); 
+        content = oss.str(); 
+        return true; 
+    }
+#endif
+    std::FILE* fp = std::fopen(filename.c_str(), "rb"); 
+    if (!fp) return false; 
+    struct stat st; 
+    std::size_t size = 0; 
+    if (fstat(fileno(fp), &st) == 0 && st.st_size > 0)
+    {
+        content.resize(st.st_size); 
+        size = std::fread(&content[0], 1, content.size(), fp); 
+    }
+    content.resize(size); 
+    // the size may change, e.g., for pipes 
+    char buf[65536]; 
+    while ((size = std::fread(buf, 1, sizeof(buf), fp)) > 0)
+        content.append(buf, size); 
+    bool flag = !std::ferror(fp); 
+    std::fclose(fp); 
+    return flag; 
+}
+
+/// @brief match a token with keywords ignoring cases 
+/// @param first first character of token 
+/// @param last one past the last character of token 
+/// @param vKeyword keywords in upper case, ended by NULL 
+/// @return matched keyword, NULL if not found 
+static const char* bookshelf_match_keyword(const char* first, const char* last, const char* const* vKeyword)
+{
+    for (; *vKeyword; ++vKeyword)
+    {
+        std::size_t n = std::strlen(*vKeyword); 
+        if ((std::size_t)(last-first) == n && strncasecmp(first, *vKeyword, n) == 0)
+            return *vKeyword; 
+    }
+    return NULL; 
+}
+
+bool readPlFast(BookshelfDataBase& db, const string& plFile, vector<string> const* vNodeName)
+{
+    limboScopedTimer("BookshelfParser::readPlFast");
+    limboScopedAllocations("BookshelfParser::readPlFast");
+    static const char* const vOrient[] = {"N", "S", "W", "E", "FN", "FS", "FW", "FE", NULL}; 
+    static const char* const vStatus[] = {"FIXED", "FIXED_NI", "PLACED", "UNPLACED", NULL}; 
+
+    string content; 
+    if (!bookshelf_read_file(plFile, content))
+    {
+        std::cerr << "failed to read " << plFile << std::endl; 
+        return false; 
+    }
+    BookshelfIndexDataBase* indexDb = (vNodeName)? dynamic_cast<BookshelfIndexDataBase*>(&db) : NULL; 
+    // built only if an entry is out of order 
+    BookshelfNodeIndex nodeIndex; 
+    bool nodeIndexBuilt = false; 
+
+    string name; 
+    string orient; 
+    string status; 
+    const char* vToken[8][2]; 
+    bool header = false; 
+    std::size_t numEntries = 0; 
+    std::size_t lineNo = 0; 
+    const char* p = content.data(); 
+    const char* end = p+content.size(); 
+    while (p < end)
+    {
+        ++lineNo; 
+        const char* eol = (const char*)std::memchr(p, '\n', end-p); 
+        if (!eol) eol = end; 
+        const char* comment = (const char*)std::memchr(p, '#', eol-p); 
+        const char* last = (comment)? comment : eol; 
+        // split by blanks, ':' is a token by itself 
+        std::size_t numTokens = 0; 
+        while (p < last && numTokens < 8)
+        {
+            while (p < last && std::isspace((unsigned char)*p)) ++p; 
+            if (p == last) break; 
+            vToken[numTokens][0] = p; 
+            if (*p == ':') 
+                ++p; 
+            else 
+                while (p < last && *p != ':' && !std::isspace((unsigned char)*p)) ++p; 
+            vToken[numTokens++][1] = p; 
+        }
+        p = eol+1; 
+        if (numTokens == 0)
+            continue; 
+
+        if (!header)
+        {
+            // UCLA pl 1.0 or pl 1.0 
+            std::size_t i = (numTokens == 3 && strncasecmp(vToken[0][0], "UCLA", 4) == 0 && vToken[0][1]-vToken[0][0] == 4)? 1 : 0; 
+            header = (numTokens == i+2 && vToken[i][1]-vToken[i][0] == 2 && strncasecmp(vToken[i][0], "pl", 2) == 0); 
+            if (!header)
+            {
+                std::cerr << plFile << ":" << lineNo << ": missing .pl header" << std::endl; 
+                return false; 
+            }
+            continue; 
+        }
+
+        // node x y : orient [status] 
+        double x = 0; 
+        double y = 0; 
+        const char* matchedOrient = NULL; 
+        const char* matchedStatus = NULL; 
+        bool flag = (numTokens == 5 || numTokens == 6)
+            && limbo::from_chars(vToken[1][0], vToken[1][1], x).ptr == vToken[1][1]
+            && limbo::from_chars(vToken[2][0], vToken[2][1], y).ptr == vToken[2][1]
+            && vToken[3][1]-vToken[3][0] == 1 && *vToken[3][0] == ':'
+            && (matchedOrient = bookshelf_match_keyword(vToken[4][0], vToken[4][1], vOrient)) != NULL; 
+        if (flag && numTokens == 6)
+        {
+            const char* s = vToken[5][0]; 
+            if (*s == '/') ++s; 
+            flag = (matchedStatus = bookshelf_match_keyword(s, vToken[5][1], vStatus)) != NULL; 
+        }
+        if (!flag)
+        {
+            std::cerr << plFile << ":" << lineNo << ": invalid .pl entry" << std::endl; 
+            return false; 
+        }
+        orient.assign(matchedOrient); 
+        if (matchedStatus) 
+            status.assign(matchedStatus); 
+        else 
+            status.clear(); 
+
+        const char* nameFirst = vToken[0][0]; 
+        std::size_t nameSize = vToken[0][1]-nameFirst; 
+        int id = -1; 
+        if (indexDb)
+        {
+            // entries in the order of nodes are verified by names without lookups 
+            if (numEntries < vNodeName->size() && (*vNodeName)[numEntries].size() == nameSize 
+                    && std::memcmp((*vNodeName)[numEntries].data(), nameFirst, nameSize) == 0)
+                id = numEntries; 
+            else 
+            {
+                if (!nodeIndexBuilt)
+                {
+                    nodeIndex.reserve(vNodeName->size()); 
+                    for (vector<string>::const_iterator it = vNodeName->begin(); it != vNodeName->end(); ++it)
+                        nodeIndex.insert(*it); 
+                    nodeIndexBuilt = true; 
+                }
+                name.assign(nameFirst, nameSize); 
+                id = nodeIndex.find(name); 
+            }
+        }
+        if (id >= 0)
+            indexDb->set_bookshelf_node_position(id, x, y, orient, status, true); 
+        else 
+        {
+            name.assign(nameFirst, nameSize); 
+            db.set_bookshelf_node_position(name, x, y, orient, status, true); 
+        }
+        ++numEntries; 
+    }
+    return true; 
+}
+
 
 } // namespace example
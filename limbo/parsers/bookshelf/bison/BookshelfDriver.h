@@ -9,6 +9,7 @@
 #define BOOKSHELFPARSER_DRIVER_H
 
 #include "BookshelfDataBase.h"
+#include <limbo/parsers/common/ParserProfile.h>
 
 /** The example namespace is used to encapsulate the three parser classes
  * example::Parser, example::Scanner and example::Driver */
@@ -24,6 +25,9 @@ using std::pair;
 using std::make_pair;
 using std::ostringstream;
 
+/// @brief map from node names to indices, see @ref BookshelfParser::BookshelfIndexDataBase 
+class BookshelfNodeIndex;
+
 /**
  * @class BookshelfParser::Driver
  * The Driver class brings together all components. It creates an instance of
@@ -88,10 +92,19 @@ public:
      * parser to the scanner. It is used in the yylex macro. */
     class Scanner* lexer;
 
+    /** Counters and timers of the scanner, grammar actions and database
+     * callbacks, compiled out unless LIMBO_INSTRUMENT is defined. It is used
+     * in the yylex macro. */
+    limbo::ParserProfile profile;
+
     /** Reference to the database filled during parsing of the
      * expressions. */
     BookshelfDataBase& m_db;
 
+    /// @brief share a map from node names to indices, which is filled by .nodes and looked up by .nets and .pl, 
+    /// so that callbacks of @ref BookshelfParser::BookshelfIndexDataBase receive indices 
+    /// @param nodeIndex map shared by drivers of all files, NULL to pass names 
+    void setNodeIndex(BookshelfNodeIndex* nodeIndex);
     /// @brief control m_plFlag
     /// @param flag control flag 
     void setPlFlag(bool flag);
@@ -206,17 +219,45 @@ protected:
     RouteInfo m_routeInfo; ///< temporary storage of routing information 
     vector<string> m_vBookshelfFiles; ///< store bookshelf files except .aux 
     bool m_plFlag; ///< if true, indicate that only reads .pl file, this will result in different callbacks in the database 
+    BookshelfIndexDataBase* m_indexDb; ///< database receiving node indices, NULL if the database only takes names 
+    BookshelfNodeIndex* m_nodeIndex; ///< map from node names to indices, NULL if not used 
 };
 
 /// @brief API for BookshelfParser. 
 /// Read .aux file and parse all other files. 
 /// @param db database which is derived from @ref BookshelfParser::BookshelfDataBase
 /// @param auxFile .aux file 
-bool read(BookshelfDataBase& db, const string& auxFile);
+/// @param numThreads number of threads; other files are parsed concurrently with separate drivers, 
+/// and their callbacks are recorded and then passed to the database in the same order as the serial mode. 
+/// If the database is derived from @ref BookshelfParser::BookshelfIndexDataBase, 
+/// .nets and .pl refer to nodes by indices and are parsed after .nodes. 
+bool read(BookshelfDataBase& db, const string& auxFile, int numThreads = 1);
+/// @brief API for BookshelfParser with a binary cache of parsed files. 
+/// All files listed in .aux are hashed; if the cache was written by the same version for the same contents, 
+/// recorded callbacks are loaded through memory mapping and passed to the database without parsing. 
+/// Otherwise, files are parsed as @ref BookshelfParser::read and the cache is rebuilt. 
+/// Callbacks are the same as @ref BookshelfParser::read, except that the cache is only reused on the same ABI. 
+/// @param db database which is derived from @ref BookshelfParser::BookshelfDataBase
+/// @param auxFile .aux file 
+/// @param cacheFile cache file, failing to write it only gives a warning 
+/// @param numThreads number of threads to parse files if the cache is stale 
+bool readCached(BookshelfDataBase& db, const string& auxFile, const string& cacheFile, int numThreads = 1);
 /// @brief Read .pl file only, the callback only provide positions and orientation. 
 /// @param db database which is derived from @ref BookshelfParser::BookshelfDataBase
 /// @param plFile .pl file 
 bool readPl(BookshelfDataBase& db, const string& plFile);
+/// @brief Read .pl file only with a hand-written tokenizer instead of the flex/bison stack, 
+/// e.g., to reload placements dumped by @ref BookshelfParser::writePl in iterative flows. 
+/// Callbacks are the same as @ref BookshelfParser::readPl, except for databases taking indices below. 
+/// If vNodeName is given and the database is derived from @ref BookshelfParser::BookshelfIndexDataBase, 
+/// positions are passed by indices: the i-th entry is node i if its name equals vNodeName[i], 
+/// so files in the same order as the nodes need no lookup; other entries are looked up in a map built on demand, 
+/// and names not found are passed as strings. 
+/// @param db database which is derived from @ref BookshelfParser::BookshelfDataBase
+/// @param plFile .pl file 
+/// @param vNodeName node names by indices, e.g., in the order of .nodes 
+/// @return true if the file is read without errors 
+bool readPlFast(BookshelfDataBase& db, const string& plFile, vector<string> const* vNodeName = NULL);
 
 } // namespace example
 
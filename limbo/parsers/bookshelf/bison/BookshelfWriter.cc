@@ -0,0 +1,134 @@
+/**
+ * @file   BookshelfWriter.cc
+ * @brief  Implementation of @ref BookshelfParser::BookshelfWriter
+ * @date   Oct 2026
+ */
+
+#include "BookshelfWriter.h"
+#include <cstring>
+#include <limbo/string/String.h>
+#include <limbo/string/CharConv.h>
+/// support to .pl.gz if enabled
+#if ZLIB == 1
+#include <zlib.h>
+#endif
+
+namespace BookshelfParser {
+
+BookshelfWriter::BookshelfWriter(std::size_t bufferSize)
+    : m_file(NULL)
+    , m_gzFile(NULL)
+    , m_capacity(std::max(bufferSize, (std::size_t)1024))
+    , m_good(true)
+{
+    m_buffer.reserve(m_capacity+4096);
+}
+BookshelfWriter::~BookshelfWriter()
+{
+    close();
+}
+bool BookshelfWriter::open(string const& filename)
+{
+    close();
+    m_good = true;
+#if ZLIB == 1
+    if (limbo::get_file_suffix(filename) == "gz")
+    {
+        gzFile f = gzopen(filename.c_str(), "wb");
+        if (f)
+            gzbuffer(f, m_capacity);
+        m_gzFile = f;
+    }
+    else
+#endif
+        m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file && !m_gzFile)
+    {
+        cout << "Unable to open output file " << filename << endl;
+        return false;
+    }
+    return true;
+}
+bool BookshelfWriter::close()
+{
+    if (!m_file && !m_gzFile)
+        return m_good;
+    flush();
+    if (m_file)
+    {
+        m_good = (std::fclose(m_file) == 0) && m_good;
+        m_file = NULL;
+    }
+#if ZLIB == 1
+    if (m_gzFile)
+    {
+        m_good = (gzclose((gzFile)m_gzFile) == Z_OK) && m_good;
+        m_gzFile = NULL;
+    }
+#endif
+    return m_good;
+}
+void BookshelfWriter::flush()
+{
+    if (m_buffer.empty())
+        return;
+    if (m_file)
+        m_good = (std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file) == m_buffer.size()) && m_good;
+#if ZLIB == 1
+    else if (m_gzFile)
+        m_good = (gzwrite((gzFile)m_gzFile, m_buffer.data(), m_buffer.size()) == (int)m_buffer.size()) && m_good;
+#endif
+    m_buffer.clear();
+}
+
+void BookshelfWriter::write_pl_header()
+{
+    m_buffer.append("UCLA pl 1.0\n\n");
+}
+void BookshelfWriter::write_pl_nodes(std::size_t n, BookshelfPlSource const& source)
+{
+    PlNode node;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        source.get(i, node);
+        write_pl_node(node);
+        node.reset();
+    }
+}
+
+void BookshelfWriter::format(string& buffer, double v)
+{
+    char digits[32];
+    char* end = limbo::to_chars(digits, digits+sizeof(digits), v).ptr;
+    // the scanner takes no exponents, which only appear for tiny or huge values
+    if (std::memchr(digits, 'e', end-digits))
+    {
+        char fixed[512];
+        buffer.append(fixed, limbo::to_chars(fixed, fixed+sizeof(fixed), v, 12).ptr);
+    }
+    else
+        buffer.append(digits, end);
+}
+void BookshelfWriter::format(string& buffer, PlNode const& node)
+{
+    buffer.append(node.node_name).append("\t");
+    format(buffer, node.origin[0]);
+    buffer += '\t';
+    format(buffer, node.origin[1]);
+    buffer.append("\t: ").append(node.orient);
+    if (!node.status.empty())
+        buffer.append(" /").append(node.status);
+    buffer += '\n';
+}
+
+bool writePl(string const& filename, std::size_t n, BookshelfPlSource const& source)
+{
+    BookshelfWriter writer;
+    if (!writer.open(filename))
+        return false;
+    writer.write_pl_header();
+    writer.write_pl_nodes(n, source);
+    return writer.close();
+}
+
+} // namespace BookshelfParser
@@ -0,0 +1,96 @@
+/**
+ * @file   BookshelfWriter.h
+ * @brief  Streaming writer of Bookshelf .pl files, see @ref BookshelfParser::BookshelfWriter
+ * @date   Oct 2026
+ */
+
+#ifndef BOOKSHELFPARSER_WRITER_H
+#define BOOKSHELFPARSER_WRITER_H
+
+#include <cstdio>
+#include "BookshelfDataBase.h"
+
+/// @brief namespace for BookshelfParser
+namespace BookshelfParser {
+
+/// @class BookshelfParser::BookshelfPlSource
+/// @brief callback-style iterator over node positions to write, e.g., cells of a placement database
+class BookshelfPlSource
+{
+	public:
+        /// @brief destructor
+		virtual ~BookshelfPlSource() {}
+        /// @brief fill a node position
+        /// @param i index of the node
+        /// @param node target object, which is reused, so all fields to write should be set
+		virtual void get(std::size_t i, PlNode& node) const = 0;
+};
+
+/// @class BookshelfParser::BookshelfWriter
+/// @brief write .pl files in the syntax read by @ref BookshelfParser::Driver and @ref BookshelfParser::readPlFast.
+/// Records are formatted into a large buffer without iostreams and written with fwrite,
+/// or gzwrite for .gz files if compiled with ZLIB.
+/// Integral coordinates are written as integers, others with the fewest digits that read back to the same value.
+class BookshelfWriter
+{
+	public:
+        /// @brief constructor
+        /// @param bufferSize number of bytes buffered before writing to the file
+		BookshelfWriter(std::size_t bufferSize = 1024*1024);
+        /// @brief destructor, close the file
+		~BookshelfWriter();
+
+        /// @brief open a file, compressed with gzip if the suffix is .gz
+        /// @param filename output file
+        /// @return true if succeed
+		bool open(string const& filename);
+        /// @brief flush the buffer and close the file
+        /// @return true if all bytes have been written
+		bool close();
+
+        /// @brief header of .pl file
+		void write_pl_header();
+        /// @brief write a node position
+		void write_pl_node(PlNode const& node) {format(m_buffer, node); check_flush();}
+        /// @brief write node positions
+        /// @param n number of nodes
+        /// @param source node positions
+		void write_pl_nodes(std::size_t n, BookshelfPlSource const& source);
+
+        /// @name format records
+        ///@{
+        /// @brief append a line of .pl file, "name x y : orient /status"
+		static void format(string& buffer, PlNode const& node);
+        /// @brief append a coordinate
+		static void format(string& buffer, double v);
+        ///@}
+
+	protected:
+        /// @brief disabled copy
+		BookshelfWriter(BookshelfWriter const&);
+        /// @brief disabled assignment
+		BookshelfWriter& operator=(BookshelfWriter const&);
+
+        /// @brief write the buffer to the file if full
+		void check_flush() {if (m_buffer.size() >= m_capacity) flush();}
+        /// @brief write the buffer to the file
+		void flush();
+
+		std::FILE* m_file; ///< uncompressed output
+		void* m_gzFile; ///< compressed output, gzFile
+		string m_buffer; ///< bytes to write
+		std::size_t m_capacity; ///< size of the buffer to flush
+		bool m_good; ///< false if failed to write
+};
+
+/// @brief API for BookshelfParser.
+/// Write a whole .pl file.
+/// @param filename output file, compressed with gzip if the suffix is .gz
+/// @param n number of nodes
+/// @param source node positions, usually in the order of .nodes for @ref BookshelfParser::readPlFast
+/// @return true if succeed
+bool writePl(string const& filename, std::size_t n, BookshelfPlSource const& source);
+
+} // namespace BookshelfParser
+
+#endif
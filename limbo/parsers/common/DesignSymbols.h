@@ -0,0 +1,175 @@
+/**
+ * @file   DesignSymbols.h
+ * @brief  Symbols of a design shared by the LEF, DEF and Verilog drivers.
+ *
+ * Macro, instance, net and pin names appear in several files of a design:
+ * LEF macros are placed by DEF components, and Verilog instances are DEF components.
+ * Without a shared table, each parser hands out strings and each database hashes them again to link the files.
+ *
+ * A @ref limbo::DesignSymbols is attached to the databases by
+ * @ref LefParser::LefDataBase::lef_symbols, @ref DefParser::DefRefDataBase::def_symbols
+ * and @ref VerilogParser::VerilogIdDataBase::verilog_symbols.
+ * The drivers intern each name once into the namespace of its kind and pass integer symbols to the callbacks,
+ * so a DEF component gets the symbol of its LEF macro and a Verilog instance gets the symbol of its DEF component
+ * while parsing, in whichever order the files are read.
+ *
+ * Symbols are dense per kind in the order of first appearance.
+ * The table is thread-safe, so LEF and DEF files may be read concurrently with @ref LefDefLoader::read;
+ * then the order of symbols of names appearing in both depends on timing.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_COMMON_DESIGNSYMBOLS_H
+#define LIMBO_PARSERS_COMMON_DESIGNSYMBOLS_H
+
+#include <limits>
+#include <vector>
+#include <pthread.h>
+#include <limbo/containers/StringInterner.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+
+/// @brief namespaces of names in a design
+enum DesignSymbolKind
+{
+    DESIGN_MACRO, ///< standard cell types and modules, i.e., LEF macros, DEF component macros and Verilog modules of instances
+    DESIGN_INSTANCE, ///< DEF components and Verilog instances
+    DESIGN_NET, ///< nets
+    DESIGN_PIN, ///< pins of macros and IO pins
+    DESIGN_NUM_KINDS ///< number of kinds
+};
+
+/// @class limbo::DesignSymbols
+/// @brief tables of unique macro, instance, net and pin names with dense symbols,
+/// and links between them found by the parsers
+///
+/// Usage:
+/// ~~~~~~~~~~~~~~~~
+/// limbo::DesignSymbols symbols;
+/// // return &symbols in lef_symbols, def_symbols and verilog_symbols of the databases, then read the files
+/// unsigned int macro = symbols.instance_macro(symbols.find_or_insert(limbo::DESIGN_INSTANCE, "u1"));
+/// bool known = symbols.macro_defined(macro);
+/// ~~~~~~~~~~~~~~~~
+class DesignSymbols
+{
+    public:
+        /// @nowarn
+        typedef containers::StringInterner::id_type id_type;
+        typedef containers::StringInterner::string_view_type string_view_type;
+        typedef containers::StringInterner::size_type size_type;
+        /// @endnowarn
+
+        /// @return symbol of nothing, e.g., the macro of an instance not bound yet
+        static id_type invalid_id() {return std::numeric_limits<id_type>::max();}
+
+        /// @brief constructor
+        DesignSymbols() : m_numConflicts(0)
+        {
+            pthread_mutex_init(&m_mutex, NULL);
+        }
+        /// @brief destructor
+        ~DesignSymbols()
+        {
+            pthread_mutex_destroy(&m_mutex);
+        }
+
+        /// @brief find the symbol of a name, and insert the name if absent
+        /// @param kind namespace of the name
+        /// @param name name
+        /// @return symbol of the name
+        id_type find_or_insert(DesignSymbolKind kind, string_view_type name) {return m_table[kind].find_or_insert(name);}
+        /// @brief find the symbol of a name
+        /// @param kind namespace of the name
+        /// @param name name
+        /// @param id symbol as output
+        /// @return true if found
+        bool find(DesignSymbolKind kind, string_view_type name, id_type& id) const {return m_table[kind].find(name, id);}
+        /// @param kind namespace of the symbol
+        /// @param id symbol
+        /// @return view of the name, terminated by '\0'
+        string_view_type str(DesignSymbolKind kind, id_type id) const {return m_table[kind].str(id);}
+        /// @param kind namespace
+        /// @return number of names of the kind
+        size_type size(DesignSymbolKind kind) const {return m_table[kind].size();}
+
+        /// @brief mark a macro as defined, i.e., read from LEF
+        /// @param macro symbol of the macro
+        void define_macro(id_type macro)
+        {
+            pthread_mutex_lock(&m_mutex);
+            if (macro >= m_vDefined.size())
+                m_vDefined.resize(macro+1, false);
+            m_vDefined[macro] = true;
+            pthread_mutex_unlock(&m_mutex);
+        }
+        /// @param macro symbol of the macro
+        /// @return true if the macro has been read from LEF
+        bool macro_defined(id_type macro) const
+        {
+            pthread_mutex_lock(&m_mutex);
+            bool flag = (macro < m_vDefined.size() && m_vDefined[macro]);
+            pthread_mutex_unlock(&m_mutex);
+            return flag;
+        }
+        /// @brief bind an instance to its macro, e.g., by a DEF component or a Verilog instance.
+        /// A different macro for a bound instance replaces the former one and is counted by @ref num_conflicts.
+        /// @param instance symbol of the instance
+        /// @param macro symbol of the macro
+        void bind_instance(id_type instance, id_type macro)
+        {
+            pthread_mutex_lock(&m_mutex);
+            if (instance >= m_vInstanceMacro.size())
+                m_vInstanceMacro.resize(instance+1, invalid_id());
+            id_type& bound = m_vInstanceMacro[instance];
+            if (bound != invalid_id() && bound != macro)
+                ++m_numConflicts;
+            bound = macro;
+            pthread_mutex_unlock(&m_mutex);
+        }
+        /// @param instance symbol of the instance
+        /// @return symbol of the macro of the instance, @ref invalid_id if not bound
+        id_type instance_macro(id_type instance) const
+        {
+            pthread_mutex_lock(&m_mutex);
+            id_type macro = (instance < m_vInstanceMacro.size())? m_vInstanceMacro[instance] : invalid_id();
+            pthread_mutex_unlock(&m_mutex);
+            return macro;
+        }
+        /// @return number of instances bound to different macros by different files
+        size_type num_conflicts() const
+        {
+            pthread_mutex_lock(&m_mutex);
+            size_type n = m_numConflicts;
+            pthread_mutex_unlock(&m_mutex);
+            return n;
+        }
+
+        /// @brief remove all names and links, no parser may use the table
+        void clear()
+        {
+            for (int kind = 0; kind < DESIGN_NUM_KINDS; ++kind)
+                m_table[kind].clear();
+            std::vector<bool>().swap(m_vDefined);
+            std::vector<id_type>().swap(m_vInstanceMacro);
+            m_numConflicts = 0;
+        }
+
+    protected:
+        /// copy is not allowed
+        DesignSymbols(DesignSymbols const&);
+        /// assignment is not allowed
+        DesignSymbols& operator=(DesignSymbols const&);
+
+        containers::StringInterner m_table[DESIGN_NUM_KINDS]; ///< names of each kind
+        mutable pthread_mutex_t m_mutex; ///< lock of links
+        std::vector<bool> m_vDefined; ///< whether macros are read from LEF
+        std::vector<id_type> m_vInstanceMacro; ///< macros of instances
+        size_type m_numConflicts; ///< number of instances bound to different macros
+};
+
+} // namespace limbo
+
+#endif
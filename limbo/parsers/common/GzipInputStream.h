@@ -0,0 +1,118 @@
+/**
+ * @file   GzipInputStream.h
+ * @brief  Input stream of gzip files inflated by a helper thread, shared by the flex/bison parsers.
+ *
+ * Parsers check @ref limbo::is_gzip_file in parse_file and read through @ref limbo::GzipInputStream,
+ * so compressed files are parsed directly without being decompressed to disk first.
+ * The helper thread of @ref limbo::PrefetchInputBuffer inflates blocks ahead while the scanner consumes the previous ones.
+ * Requires zlib and the thread library, so parsers only include it when compiled with ZLIB=1.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_COMMON_GZIPINPUTSTREAM_H
+#define LIMBO_PARSERS_COMMON_GZIPINPUTSTREAM_H
+
+#include <istream>
+#include <string>
+#include <zlib.h>
+#include <limbo/string/String.h>
+#include <limbo/parsers/common/PrefetchInputStream.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+
+/// @brief check whether a file is compressed by gzip, i.e., with suffix .gz
+/// @param filename file name
+/// @return true if the suffix is .gz in any case
+inline bool is_gzip_file(std::string const& filename)
+{
+    return iequals(get_file_suffix(filename), "gz");
+}
+
+/// @brief stream buffer inflating a gzip file with a helper thread,
+/// the read-ahead ring of @ref limbo::PrefetchInputBuffer filled by zlib.
+class GzipInputBuffer : public PrefetchInputBuffer
+{
+    public:
+        /// @brief constructor
+        /// @param numBlocks number of blocks inflated ahead
+        /// @param blockSize size of each block in bytes
+        GzipInputBuffer(std::size_t numBlocks = 4, std::size_t blockSize = 1024*1024)
+            : PrefetchInputBuffer(numBlocks, blockSize)
+            , m_file(NULL)
+        {
+        }
+        /// @brief destructor, stops the helper thread before zlib is closed
+        ~GzipInputBuffer()
+        {
+            close();
+        }
+
+        /// @brief open a file and start the helper thread
+        /// @param filename gzip file, plain files are passed through by zlib
+        /// @return true if succeed
+        bool open(const char* filename)
+        {
+            close();
+            m_file = gzopen(filename, "rb");
+            if (!m_file)
+                return false;
+            gzbuffer(m_file, 256*1024);
+            start(true);
+            return true;
+        }
+
+    protected:
+        /// @brief inflate the next bytes
+        /// @param data destination
+        /// @param size capacity of the destination
+        /// @return number of bytes inflated, 0 at the end and negative on errors
+        virtual long read_source(char* data, std::size_t size)
+        {
+            return gzread(m_file, data, size);
+        }
+        /// @brief close the zlib file handle
+        virtual void close_source()
+        {
+            if (m_file)
+            {
+                gzclose(m_file);
+                m_file = NULL;
+            }
+        }
+
+    private:
+        /// @nowarn
+        GzipInputBuffer(GzipInputBuffer const&);
+        GzipInputBuffer& operator=(GzipInputBuffer const&);
+        /// @endnowarn
+
+        gzFile m_file; ///< zlib file handle
+};
+
+/// @brief input stream of a gzip file inflated by a helper thread,
+/// an alternative to std::ifstream in parse_file of the parsers.
+class GzipInputStream : public std::istream
+{
+    public:
+        /// @brief constructor
+        /// @param filename gzip file
+        explicit GzipInputStream(std::string const& filename)
+            : std::istream(NULL)
+        {
+            init(&m_buffer);
+            if (!m_buffer.open(filename.c_str()))
+                setstate(std::ios::badbit);
+        }
+        /// @return whether inflating failed, e.g., the file is corrupted
+        bool error() const {return m_buffer.error();}
+
+    protected:
+        GzipInputBuffer m_buffer; ///< stream buffer
+};
+
+} // namespace limbo
+
+#endif
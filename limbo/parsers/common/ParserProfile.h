@@ -0,0 +1,276 @@
+/**
+ * @file   ParserProfile.h
+ * @brief  Counters and timers of the scanner, grammar actions and database callbacks of the flex/bison parsers,
+ *         compiled out unless LIMBO_INSTRUMENT is defined.
+ *
+ * macro: limboParserScan, limboParserBytes, limboParserParse, limboParserRecord, limboParserCallback
+ *
+ * Each Driver owns a @ref limbo::ParserProfile named after its parser, e.g., "DefParser".
+ * The grammar wraps the call of the scanner with limboParserScan, the scanner counts the bytes it reads in YY_INPUT,
+ * and the driver times the calls of its database with limboParserCallback and counts records of sections with limboParserRecord.
+ * Time of grammar actions is the time of a parse minus the time in the scanner and in callbacks.
+ *
+ * At the end of each parse, the profile is added to the report of @ref Instrument.h:
+ * timers "<parser>::scanner", "<parser>::actions" and "<parser>::callbacks" under the path of the enclosing timers,
+ * e.g., "DefParser::read/DefParser::scanner", and counters "<parser>::tokens", "<parser>::bytes",
+ * "<parser>::callbacks" and "<parser>::records/<section>".
+ * A profile is used by one thread; parsers reading with threads have a driver and a profile per thread.
+ *
+ * Timing each token reads the clock twice per token, which slows down scanning noticeably.
+ * Compare the shares of the scanner, actions and callbacks rather than the absolute times with uninstrumented builds.
+ * Without LIMBO_INSTRUMENT, the macros expand to the wrapped calls or to nothing,
+ * and @ref limbo::ParserProfile is an empty class.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_COMMON_PARSERPROFILE_H
+#define LIMBO_PARSERS_COMMON_PARSERPROFILE_H
+
+#include <limbo/preprocessor/Instrument.h>
+
+#ifdef LIMBO_INSTRUMENT
+
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <utility>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+
+/// @class limbo::ParserProfile
+/// @brief counters and timers of a parser driver, added to the report of @ref Instrument.h at the end of each parse
+class ParserProfile
+{
+    public:
+        /// @brief constructor
+        /// @param name name of the parser, the prefix of timers and counters
+        explicit ParserProfile(const char* name)
+            : m_name(name)
+            , m_numTokens(0)
+            , m_numBytes(0)
+            , m_numCallbacks(0)
+            , m_numParses(0)
+            , m_scanTime(0)
+            , m_callbackTime(0)
+            , m_actionTime(0)
+            , m_scanStart(0)
+            , m_callbackStart(0)
+            , m_callbackDepth(0)
+            , m_parseDepth(0)
+            , m_parseStart(0)
+            , m_parseScanTime(0)
+            , m_parseCallbackTime(0)
+            , m_previous(NULL)
+        {
+        }
+        /// @brief destructor, report callbacks out of any parse
+        ~ParserProfile()
+        {
+            if (m_numCallbacks || m_numParses)
+                this->flush();
+        }
+
+        /// @return profile of the parse running on the calling thread, NULL if none
+        static ParserProfile*& current()
+        {
+            static __thread ParserProfile* profile = NULL;
+            return profile;
+        }
+
+        /// @brief start timing the scanner for a token
+        void begin_scan() {m_scanStart = Instrument::wall_time();}
+        /// @brief stop timing the scanner
+        /// @param token token returned by the scanner
+        /// @return the token
+        template <typename T>
+        T end_scan(T token)
+        {
+            m_scanTime += Instrument::wall_time()-m_scanStart;
+            ++m_numTokens;
+            return token;
+        }
+        /// @brief count bytes read by the scanner
+        void add_bytes(long long n) {m_numBytes += n;}
+        /// @brief count a record of a section
+        /// @param section name of the section, a string literal
+        void add_record(const char* section)
+        {
+            // a few sections, usually found at the back
+            for (std::vector<std::pair<const char*, long long> >::reverse_iterator it = m_vRecord.rbegin(); it != m_vRecord.rend(); ++it)
+            {
+                if (it->first == section || strcmp(it->first, section) == 0)
+                {
+                    ++it->second;
+                    return;
+                }
+            }
+            m_vRecord.push_back(std::make_pair(section, 1LL));
+        }
+        /// @brief start timing a callback, nested callbacks are timed by the outermost one
+        void begin_callback()
+        {
+            if (m_callbackDepth++ == 0)
+                m_callbackStart = Instrument::wall_time();
+        }
+        /// @brief stop timing a callback
+        void end_callback()
+        {
+            if (--m_callbackDepth == 0)
+            {
+                m_callbackTime += Instrument::wall_time()-m_callbackStart;
+                ++m_numCallbacks;
+            }
+        }
+        /// @brief start a parse, nested parses belong to the outermost one
+        void begin_parse()
+        {
+            if (m_parseDepth++)
+                return;
+            m_previous = current();
+            current() = this;
+            m_parseScanTime = m_scanTime;
+            m_parseCallbackTime = m_callbackTime;
+            m_parseStart = Instrument::wall_time();
+        }
+        /// @brief finish a parse and add the profile to the report
+        void end_parse()
+        {
+            if (--m_parseDepth)
+                return;
+            double elapsed = Instrument::wall_time()-m_parseStart;
+            m_actionTime += std::max(elapsed-(m_scanTime-m_parseScanTime)-(m_callbackTime-m_parseCallbackTime), 0.0);
+            ++m_numParses;
+            current() = m_previous;
+            this->flush();
+        }
+        /// @brief add counters and timers to the report of @ref Instrument.h and reset them
+        void flush()
+        {
+            Instrument& inst = Instrument::instance();
+            if (m_numParses)
+            {
+                inst.add_time((m_name+"::scanner").c_str(), m_numTokens, m_scanTime);
+                inst.add_time((m_name+"::actions").c_str(), m_numParses, m_actionTime);
+            }
+            inst.add_time((m_name+"::callbacks").c_str(), m_numCallbacks, m_callbackTime);
+            inst.counter((m_name+"::tokens").c_str())->add(m_numTokens);
+            inst.counter((m_name+"::bytes").c_str())->add(m_numBytes);
+            inst.counter((m_name+"::callbacks").c_str())->add(m_numCallbacks);
+            for (std::vector<std::pair<const char*, long long> >::const_iterator it = m_vRecord.begin(); it != m_vRecord.end(); ++it)
+                inst.counter((m_name+"::records/"+it->first).c_str())->add(it->second);
+            m_numTokens = m_numBytes = m_numCallbacks = m_numParses = 0;
+            m_scanTime = m_callbackTime = m_actionTime = 0;
+            m_vRecord.clear();
+        }
+
+    protected:
+        /// copy is not allowed
+        ParserProfile(ParserProfile const&);
+        /// assignment is not allowed
+        ParserProfile& operator=(ParserProfile const&);
+
+        std::string m_name; ///< name of the parser
+        long long m_numTokens; ///< number of tokens scanned
+        long long m_numBytes; ///< number of bytes read by the scanner
+        long long m_numCallbacks; ///< number of outermost callbacks
+        long long m_numParses; ///< number of parses finished
+        double m_scanTime; ///< seconds in the scanner
+        double m_callbackTime; ///< seconds in callbacks
+        double m_actionTime; ///< seconds in the parser outside the scanner and callbacks
+        double m_scanStart; ///< start of the current token
+        double m_callbackStart; ///< start of the outermost running callback
+        unsigned int m_callbackDepth; ///< number of running callbacks
+        unsigned int m_parseDepth; ///< number of running parses
+        double m_parseStart; ///< start of the outermost running parse
+        double m_parseScanTime; ///< m_scanTime at the start of the parse
+        double m_parseCallbackTime; ///< m_callbackTime at the start of the parse
+        ParserProfile* m_previous; ///< profile of the thread before the parse
+        std::vector<std::pair<const char*, long long> > m_vRecord; ///< number of records by section
+};
+
+/// @brief a parse timed in the enclosing scope
+class ParserParseScope
+{
+    public:
+        /// @brief constructor, start the parse
+        explicit ParserParseScope(ParserProfile& profile) : m_profile(profile) {m_profile.begin_parse();}
+        /// @brief destructor, finish the parse
+        ~ParserParseScope() {m_profile.end_parse();}
+    protected:
+        /// copy is not allowed
+        ParserParseScope(ParserParseScope const&);
+        /// assignment is not allowed
+        ParserParseScope& operator=(ParserParseScope const&);
+
+        ParserProfile& m_profile; ///< profile of the driver
+};
+
+/// @brief a callback timed in the enclosing scope
+class ParserCallbackScope
+{
+    public:
+        /// @brief constructor, start the callback
+        explicit ParserCallbackScope(ParserProfile& profile) : m_profile(profile) {m_profile.begin_callback();}
+        /// @brief destructor, stop the callback
+        ~ParserCallbackScope() {m_profile.end_callback();}
+    protected:
+        /// copy is not allowed
+        ParserCallbackScope(ParserCallbackScope const&);
+        /// assignment is not allowed
+        ParserCallbackScope& operator=(ParserCallbackScope const&);
+
+        ParserProfile& m_profile; ///< profile of the driver
+};
+
+} // namespace limbo
+
+/// @def limboParserScan(profile, token)
+/// @brief time the call of the scanner returning a token and count the token, e.g., in the definition of yylex in the grammar
+#define limboParserScan(profile, token) ((profile).begin_scan(), (profile).end_scan(token))
+/// @def limboParserBytes(bytes)
+/// @brief count bytes read by the scanner into the profile of the parse running on the thread, e.g., in YY_INPUT
+#define limboParserBytes(bytes) do {\
+    if (::limbo::ParserProfile* limboProfile = ::limbo::ParserProfile::current()) \
+        limboProfile->add_bytes(bytes); \
+} while (false)
+/// @def limboParserParse(profile)
+/// @brief time a parse in the enclosing scope and add the profile to the report at its end
+#define limboParserParse(profile) ::limbo::ParserParseScope LIMBO_INSTRUMENT_CONCAT(limboParserParse, __LINE__) (profile)
+/// @def limboParserRecord(profile, section)
+/// @brief count a record of a section, section must be a string literal
+#define limboParserRecord(profile, section) (profile).add_record(section)
+/// @def limboParserCallback(profile)
+/// @brief time the rest of the enclosing scope as a database callback
+#define limboParserCallback(profile) ::limbo::ParserCallbackScope LIMBO_INSTRUMENT_CONCAT(limboParserCallback, __LINE__) (profile)
+
+#else
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+
+/// @cond
+class ParserProfile
+{
+    public:
+        explicit ParserProfile(const char*) {}
+};
+/// @endcond
+
+} // namespace limbo
+
+/// @cond
+#define limboParserScan(profile, token) (token)
+#define limboParserBytes(bytes) do {static_cast<void>(sizeof(bytes));} while (false)
+#define limboParserParse(profile) do {} while (false)
+#define limboParserRecord(profile, section) do {} while (false)
+#define limboParserCallback(profile) do {} while (false)
+/// @endcond
+
+#endif
+
+#endif
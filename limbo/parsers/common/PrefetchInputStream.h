@@ -0,0 +1,289 @@
+/**
+ * @file   PrefetchInputStream.h
+ * @brief  Input stream of files read ahead by a helper thread, shared by the flex/bison parsers and the GDSII reader.
+ *
+ * With a plain std::ifstream, the scanner waits for each read of the file system and the disk idles while parsing,
+ * which serializes I/O and CPU on network file systems.
+ * @ref limbo::PrefetchInputStream reads blocks of a file into a ring with a helper thread while the scanner consumes
+ * the previous ones, and hints the kernel with posix_fadvise to read the file sequentially ahead.
+ * Files not larger than one block are read by the calling thread, as no overlap is possible.
+ *
+ * @ref limbo::PrefetchInputBuffer reads a file descriptor; derived buffers override
+ * @ref limbo::PrefetchInputBuffer::read_source and @ref limbo::PrefetchInputBuffer::close_source
+ * for other sources, e.g., @ref limbo::GzipInputBuffer inflates gzip files.
+ * Requires POSIX and the thread library.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_COMMON_PREFETCHINPUTSTREAM_H
+#define LIMBO_PARSERS_COMMON_PREFETCHINPUTSTREAM_H
+
+#include <algorithm>
+#include <cerrno>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+
+/// @brief stream buffer reading a file ahead with a helper thread.
+/// The helper thread fills a ring of blocks;
+/// the reader owns one block at a time and returns it in underflow.
+class PrefetchInputBuffer : public std::streambuf
+{
+    public:
+        /// @brief constructor
+        /// @param numBlocks number of blocks read ahead
+        /// @param blockSize size of each block in bytes
+        PrefetchInputBuffer(std::size_t numBlocks = 4, std::size_t blockSize = 1024*1024)
+            : m_fd(-1)
+            , m_offset(0)
+            , m_vBlock(std::max(numBlocks, (std::size_t)2), std::vector<char>(std::max(blockSize, (std::size_t)1024)))
+            , m_vSize(m_vBlock.size(), 0)
+            , m_begin(0)
+            , m_numFilled(0)
+            , m_holding(false)
+            , m_done(false)
+            , m_error(false)
+            , m_stop(false)
+            , m_started(false)
+            , m_open(false)
+        {
+            pthread_mutex_init(&m_mutex, NULL);
+            pthread_cond_init(&m_cond, NULL);
+            setg(NULL, NULL, NULL);
+        }
+        /// @brief destructor, stops the helper thread.
+        /// Derived buffers must call @ref close in their destructors, as the helper thread calls their read_source.
+        virtual ~PrefetchInputBuffer()
+        {
+            close();
+            pthread_cond_destroy(&m_cond);
+            pthread_mutex_destroy(&m_mutex);
+        }
+
+        /// @brief open a file and start the helper thread
+        /// @param filename file name, e.g., a regular file or a pipe
+        /// @return true if succeed
+        bool open(const char* filename)
+        {
+            close();
+            m_fd = ::open(filename, O_RDONLY);
+            if (m_fd < 0)
+                return false;
+            m_offset = 0;
+            struct stat sb;
+            bool small = (fstat(m_fd, &sb) == 0 && S_ISREG(sb.st_mode) && (std::size_t)sb.st_size <= m_vBlock[0].size());
+#ifdef POSIX_FADV_SEQUENTIAL
+            // a larger read-ahead window of the kernel, ignored by pipes
+            posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+            start(!small);
+            return true;
+        }
+        /// @brief stop the helper thread and close the file
+        void close()
+        {
+            if (m_started)
+            {
+                pthread_mutex_lock(&m_mutex);
+                m_stop = true;
+                pthread_cond_broadcast(&m_cond);
+                pthread_mutex_unlock(&m_mutex);
+                pthread_join(m_thread, NULL);
+                m_started = false;
+            }
+            if (m_open)
+            {
+                close_source();
+                m_open = false;
+            }
+            setg(NULL, NULL, NULL);
+        }
+        /// @return whether a file is open
+        bool is_open() const {return m_open;}
+        /// @return whether reading failed, e.g., an I/O error or a corrupted file
+        bool error() const {return m_error;}
+
+    protected:
+        /// @brief start reading an opened source
+        /// @param threaded whether to read ahead with the helper thread
+        void start(bool threaded)
+        {
+            m_begin = 0;
+            m_numFilled = 0;
+            m_holding = false;
+            m_done = m_error = m_stop = false;
+            m_open = true;
+            setg(NULL, NULL, NULL);
+            // without the helper thread, blocks are read in underflow
+            m_started = (threaded && pthread_create(&m_thread, NULL, PrefetchInputBuffer::read_thread, this) == 0);
+        }
+        /// @brief read the next bytes of the source, called by one thread at a time
+        /// @param data destination
+        /// @param size capacity of the destination
+        /// @return number of bytes read, 0 at the end and negative on errors
+        virtual long read_source(char* data, std::size_t size)
+        {
+            ssize_t n;
+            do
+            {
+                n = ::read(m_fd, data, size);
+            } while (n < 0 && errno == EINTR);
+#ifdef POSIX_FADV_WILLNEED
+            // ask for the blocks after the ring, so the next reads find them in the page cache
+            if (n > 0)
+            {
+                m_offset += n;
+                posix_fadvise(m_fd, m_offset, m_vBlock.size()*m_vBlock[0].size(), POSIX_FADV_WILLNEED);
+            }
+#endif
+            return n;
+        }
+        /// @brief close the source, called once after the helper thread has stopped
+        virtual void close_source()
+        {
+            if (m_fd >= 0)
+            {
+                ::close(m_fd);
+                m_fd = -1;
+            }
+        }
+
+        /// @brief take the next block
+        /// @return next character or EOF
+        virtual int_type underflow()
+        {
+            if (gptr() < egptr())
+                return traits_type::to_int_type(*gptr());
+            if (!m_open)
+                return traits_type::eof();
+            if (!m_started)
+                return underflow_serial();
+
+            pthread_mutex_lock(&m_mutex);
+            if (m_holding) // give the consumed block back to the helper thread
+            {
+                m_begin = (m_begin+1)%m_vBlock.size();
+                --m_numFilled;
+                m_holding = false;
+                pthread_cond_broadcast(&m_cond);
+            }
+            while (m_numFilled == 0 && !m_done)
+                pthread_cond_wait(&m_cond, &m_mutex);
+            bool available = (m_numFilled > 0);
+            if (available)
+            {
+                m_holding = true;
+                char* data = &m_vBlock[m_begin][0];
+                setg(data, data, data+m_vSize[m_begin]);
+            }
+            pthread_mutex_unlock(&m_mutex);
+
+            return available? traits_type::to_int_type(*gptr()) : traits_type::eof();
+        }
+
+    private:
+        /// @brief read the next block in the calling thread, used for small files or when no thread can be created
+        /// @return next character or EOF
+        int_type underflow_serial()
+        {
+            long n = read_source(&m_vBlock[0][0], m_vBlock[0].size());
+            if (n <= 0)
+            {
+                m_error = (n < 0);
+                return traits_type::eof();
+            }
+            char* data = &m_vBlock[0][0];
+            setg(data, data, data+n);
+            return traits_type::to_int_type(*gptr());
+        }
+        /// @brief loop of the helper thread, read blocks until end of file or stopped
+        void read_blocks()
+        {
+            pthread_mutex_lock(&m_mutex);
+            while (true)
+            {
+                while (m_numFilled == m_vBlock.size() && !m_stop)
+                    pthread_cond_wait(&m_cond, &m_mutex);
+                if (m_stop)
+                    break;
+                std::size_t i = (m_begin+m_numFilled)%m_vBlock.size();
+                // block i is neither owned by the reader nor waiting to be read
+                pthread_mutex_unlock(&m_mutex);
+                long n = read_source(&m_vBlock[i][0], m_vBlock[i].size());
+                pthread_mutex_lock(&m_mutex);
+                if (n <= 0)
+                {
+                    m_error = (n < 0);
+                    break;
+                }
+                m_vSize[i] = n;
+                ++m_numFilled;
+                pthread_cond_broadcast(&m_cond);
+            }
+            m_done = true;
+            pthread_cond_broadcast(&m_cond);
+            pthread_mutex_unlock(&m_mutex);
+        }
+        /// @brief thread entry of @ref limbo::PrefetchInputBuffer::read_blocks
+        static void* read_thread(void* arg)
+        {
+            static_cast<PrefetchInputBuffer*>(arg)->read_blocks();
+            return NULL;
+        }
+
+        /// @nowarn
+        PrefetchInputBuffer(PrefetchInputBuffer const&);
+        PrefetchInputBuffer& operator=(PrefetchInputBuffer const&);
+        /// @endnowarn
+
+        int m_fd; ///< file descriptor, -1 for other sources
+        off_t m_offset; ///< bytes read from the file descriptor
+        std::vector<std::vector<char> > m_vBlock; ///< ring of blocks
+        std::vector<std::size_t> m_vSize; ///< number of bytes in each block
+        std::size_t m_begin; ///< first filled block, owned by the reader when m_holding is true
+        std::size_t m_numFilled; ///< number of filled blocks, including the one owned by the reader
+        bool m_holding; ///< whether the reader owns block m_begin
+        bool m_done; ///< whether the helper thread has finished
+        bool m_error; ///< whether reading failed
+        bool m_stop; ///< ask the helper thread to stop
+        bool m_started; ///< whether the helper thread is running
+        bool m_open; ///< whether a source is open
+        pthread_t m_thread; ///< helper thread
+        pthread_mutex_t m_mutex; ///< protect the ring of blocks
+        pthread_cond_t m_cond; ///< signal changes of the ring of blocks
+};
+
+/// @brief input stream of a file read ahead by a helper thread,
+/// a replacement of std::ifstream in parse_file of the parsers.
+class PrefetchInputStream : public std::istream
+{
+    public:
+        /// @brief constructor
+        /// @param filename file name
+        explicit PrefetchInputStream(std::string const& filename)
+            : std::istream(NULL)
+        {
+            init(&m_buffer);
+            if (!m_buffer.open(filename.c_str()))
+                setstate(std::ios::badbit);
+        }
+        /// @return whether reading failed, e.g., an I/O error
+        bool error() const {return m_buffer.error();}
+
+    protected:
+        PrefetchInputBuffer m_buffer; ///< stream buffer
+};
+
+} // namespace limbo
+
+#endif
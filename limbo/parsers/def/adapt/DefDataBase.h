@@ -443,6 +443,24 @@ struct SNet : public Item
         ss << endl;
     }
 };
+
+/// @brief sections of DEF whose callbacks are registered to the reader, see @ref DefParser::DefDataBase::def_callbacks. 
+/// Header statements, DIEAREA, ROWS and COMPONENTS are always registered. 
+enum DefCallbackFlag 
+{
+    DEF_CBK_PINS = 1, ///< PINS, see @ref DefParser::DefDataBase::add_def_pin
+    DEF_CBK_NETS = 2, ///< NETS, see @ref DefParser::DefDataBase::add_def_net
+    DEF_CBK_SPECIALNETS = 4, ///< SPECIALNETS, see @ref DefParser::DefDataBase::add_def_snet
+    DEF_CBK_VIAS = 8, ///< VIAS, see @ref DefParser::DefDataBase::add_def_via
+    DEF_CBK_TRACKS = 16, ///< TRACKS, see @ref DefParser::DefDataBase::add_def_track
+    DEF_CBK_GCELLGRID = 32, ///< GCELLGRID, see @ref DefParser::DefDataBase::add_def_gcellgrid
+    DEF_CBK_BLOCKAGES = 64, ///< BLOCKAGES, see @ref DefParser::DefDataBase::add_def_placement_blockage
+    DEF_CBK_REGIONS = 128, ///< REGIONS, see @ref DefParser::DefDataBase::add_def_region
+    DEF_CBK_GROUPS = 256, ///< GROUPS, see @ref DefParser::DefDataBase::add_def_group
+    DEF_CBK_MISC = 512, ///< other sections like SCANCHAINS and FILLS, which are only printed 
+    DEF_CBK_ALL = 1023 ///< all sections 
+};
+
 // forward declaration
 /// @class DefParser::DefDataBase
 /// @brief Base class for def database. 
@@ -501,6 +519,10 @@ class DefDataBase
         virtual void add_def_group(Group const&); 
         /// @brief end of design 
         virtual void end_def_design(); 
+        /// @brief sections the database implements callbacks for. 
+        /// Callbacks of other sections are not registered, so the reader skips building their objects. 
+        /// @return bitwise OR of @ref DefParser::DefCallbackFlag, all sections by default 
+        virtual unsigned def_callbacks() const {return DEF_CBK_ALL;}
 
     protected:
         /// @brief remind users to define some optional callback functions at runtime 
@@ -2521,6 +2521,10 @@ bool Driver::parse_file(const std::string &filename)
 
 
         defrSetUserData((void*)3);
+        // sections without callbacks are not built by the reader 
+        unsigned callbacks = m_db.def_callbacks(); 
+
+        // always registered, the database has no default for them 
         defrSetDesignCbk(designName);
         defrSetTechnologyCbk(technologyName);
         defrSetExtensionCbk(extension);
@@ -2528,61 +2532,12 @@ bool Driver::parse_file(const std::string &filename)
         //defrSetPropDefStartCbk(propstart);
         //defrSetPropCbk(prop);
         //defrSetPropDefEndCbk(propend);
-        /* Test for CCR 766289*/
-        if (!noNetCb)
-            defrSetNetCbk(netf);
-        defrSetNetNameCbk(netNamef);
-        defrSetNetNonDefaultRuleCbk(nondefRulef);
-        defrSetNetSubnetNameCbk(subnetNamef);
-        defrSetNetPartialPathCbk(netpath);
-        defrSetSNetCbk(snetf);
-        // defrSetSNetPartialPathCbk(snetpath);
-        // if (setSNetWireCbk)
-        //     defrSetSNetWireCbk(snetwire);
-        defrSetComponentMaskShiftLayerCbk(compMSL);
         defrSetComponentCbk(compf);
-        defrSetAddPathToNet();
-        defrSetHistoryCbk(hist);
-        defrSetConstraintCbk(constraint);
-        defrSetAssertionCbk(constraint);
-        defrSetArrayNameCbk(an);
-        defrSetFloorPlanNameCbk(fn);
         defrSetDividerCbk(dividerChar);
         defrSetBusBitCbk(busbitChars);
-        defrSetNonDefaultCbk(ndr);
-
-        defrSetAssertionsStartCbk(constraintst);
-        defrSetConstraintsStartCbk(constraintst);
         defrSetComponentStartCbk(cs);
-        defrSetPinPropStartCbk(cs);
-        defrSetNetStartCbk(cs);
-        defrSetStartPinsCbk(cs);
-        defrSetViaStartCbk(cs);
-        defrSetRegionStartCbk(cs);
-        defrSetSNetStartCbk(cs);
-        defrSetGroupsStartCbk(cs);
-        defrSetScanchainsStartCbk(cs);
-        defrSetIOTimingsStartCbk(cs);
-        defrSetFPCStartCbk(cs);
-        defrSetTimingDisablesStartCbk(cs);
-        defrSetPartitionsStartCbk(cs);
-        defrSetBlockageStartCbk(cs);
-        defrSetSlotStartCbk(cs);
-        defrSetFillStartCbk(cs);
-        defrSetNonDefaultStartCbk(cs);
-        defrSetStylesStartCbk(cs);
-
-        // All of the extensions point to the same function.
-        defrSetNetExtCbk(ext);
+        defrSetComponentEndCbk(endfunc);
         defrSetComponentExtCbk(ext);
-        defrSetPinExtCbk(ext);
-        defrSetViaExtCbk(ext);
-        defrSetNetConnectionExtCbk(ext);
-        defrSetGroupExtCbk(ext);
-        defrSetScanChainExtCbk(ext);
-        defrSetIoTimingsExtCbk(ext);
-        defrSetPartitionsExtCbk(ext);
-
         defrSetUnitsCbk(units);
         if (!retStr)
             defrSetVersionCbk(vers);
@@ -2594,54 +2549,128 @@ bool Driver::parse_file(const std::string &filename)
         // to be the callback for many DIFFERENT types of constructs.
         // We have to cast the function type to meet the requirements
         // of each different set function.
-        defrSetSiteCbk((defrSiteCbkFnType)cls);
-        defrSetCanplaceCbk((defrSiteCbkFnType)cls);
-        defrSetCannotOccupyCbk((defrSiteCbkFnType)cls);
         defrSetDieAreaCbk((defrBoxCbkFnType)cls);
-        defrSetPinCapCbk((defrPinCapCbkFnType)cls);
-        defrSetPinCbk((defrPinCbkFnType)cls);
-        defrSetPinPropCbk((defrPinPropCbkFnType)cls);
-        defrSetDefaultCapCbk((defrIntegerCbkFnType)cls);
         defrSetRowCbk((defrRowCbkFnType)cls);
-        defrSetTrackCbk((defrTrackCbkFnType)cls);
-        defrSetGcellGridCbk((defrGcellGridCbkFnType)cls);
-        defrSetViaCbk((defrViaCbkFnType)cls);
-        defrSetRegionCbk((defrRegionCbkFnType)cls);
-        defrSetGroupNameCbk((defrStringCbkFnType)cls);
-        defrSetGroupMemberCbk((defrStringCbkFnType)cls);
-        defrSetGroupCbk((defrGroupCbkFnType)cls);
-        defrSetScanchainCbk((defrScanchainCbkFnType)cls);
-        defrSetIOTimingCbk((defrIOTimingCbkFnType)cls);
-        defrSetFPCCbk((defrFPCCbkFnType)cls);
-        defrSetTimingDisableCbk((defrTimingDisableCbkFnType)cls);
-        defrSetPartitionCbk((defrPartitionCbkFnType)cls);
-        defrSetBlockageCbk((defrBlockageCbkFnType)cls);
-        defrSetSlotCbk((defrSlotCbkFnType)cls);
-        defrSetFillCbk((defrFillCbkFnType)cls);
-        defrSetStylesCbk((defrStylesCbkFnType)cls);
-
-        defrSetAssertionsEndCbk(endfunc);
-        defrSetComponentEndCbk(endfunc);
-        defrSetConstraintsEndCbk(endfunc);
-        defrSetNetEndCbk(endfunc);
-        defrSetFPCEndCbk(endfunc);
-        defrSetFPCEndCbk(endfunc);
-        defrSetGroupsEndCbk(endfunc);
-        defrSetIOTimingsEndCbk(endfunc);
-        defrSetNetEndCbk(endfunc);
-        defrSetPartitionsEndCbk(endfunc);
-        defrSetRegionEndCbk(endfunc);
-        defrSetSNetEndCbk(endfunc);
-        defrSetScanchainsEndCbk(endfunc);
-        defrSetPinEndCbk(endfunc);
-        defrSetTimingDisablesEndCbk(endfunc);
-        defrSetViaEndCbk(endfunc);
-        defrSetPinPropEndCbk(endfunc);
-        defrSetBlockageEndCbk(endfunc);
-        defrSetSlotEndCbk(endfunc);
-        defrSetFillEndCbk(endfunc);
-        defrSetNonDefaultEndCbk(endfunc);
-        defrSetStylesEndCbk(endfunc);
+
+        if (callbacks & DEF_CBK_PINS)
+        {
+            defrSetStartPinsCbk(cs);
+            defrSetPinCbk((defrPinCbkFnType)cls);
+            defrSetPinEndCbk(endfunc);
+            defrSetPinExtCbk(ext);
+        }
+        if (callbacks & DEF_CBK_NETS)
+        {
+            /* Test for CCR 766289*/
+            if (!noNetCb)
+                defrSetNetCbk(netf);
+            defrSetNetNameCbk(netNamef);
+            defrSetNetNonDefaultRuleCbk(nondefRulef);
+            defrSetNetSubnetNameCbk(subnetNamef);
+            defrSetNetPartialPathCbk(netpath);
+            defrSetAddPathToNet();
+            defrSetNetStartCbk(cs);
+            defrSetNetEndCbk(endfunc);
+            defrSetNetExtCbk(ext);
+            defrSetNetConnectionExtCbk(ext);
+        }
+        if (callbacks & DEF_CBK_SPECIALNETS)
+        {
+            defrSetSNetCbk(snetf);
+            // defrSetSNetPartialPathCbk(snetpath);
+            // if (setSNetWireCbk)
+            //     defrSetSNetWireCbk(snetwire);
+            defrSetSNetStartCbk(cs);
+            defrSetSNetEndCbk(endfunc);
+        }
+        if (callbacks & DEF_CBK_VIAS)
+        {
+            defrSetViaStartCbk(cs);
+            defrSetViaCbk((defrViaCbkFnType)cls);
+            defrSetViaEndCbk(endfunc);
+            defrSetViaExtCbk(ext);
+        }
+        if (callbacks & DEF_CBK_TRACKS)
+            defrSetTrackCbk((defrTrackCbkFnType)cls);
+        if (callbacks & DEF_CBK_GCELLGRID)
+            defrSetGcellGridCbk((defrGcellGridCbkFnType)cls);
+        if (callbacks & DEF_CBK_BLOCKAGES)
+        {
+            defrSetBlockageStartCbk(cs);
+            defrSetBlockageCbk((defrBlockageCbkFnType)cls);
+            defrSetBlockageEndCbk(endfunc);
+        }
+        if (callbacks & DEF_CBK_REGIONS)
+        {
+            defrSetRegionStartCbk(cs);
+            defrSetRegionCbk((defrRegionCbkFnType)cls);
+            defrSetRegionEndCbk(endfunc);
+        }
+        if (callbacks & DEF_CBK_GROUPS)
+        {
+            defrSetGroupsStartCbk(cs);
+            defrSetGroupNameCbk((defrStringCbkFnType)cls);
+            defrSetGroupMemberCbk((defrStringCbkFnType)cls);
+            defrSetGroupCbk((defrGroupCbkFnType)cls);
+            defrSetGroupsEndCbk(endfunc);
+            defrSetGroupExtCbk(ext);
+        }
+        // sections only printed, not passed to the database 
+        if (callbacks & DEF_CBK_MISC)
+        {
+            defrSetComponentMaskShiftLayerCbk(compMSL);
+            defrSetHistoryCbk(hist);
+            defrSetConstraintCbk(constraint);
+            defrSetAssertionCbk(constraint);
+            defrSetArrayNameCbk(an);
+            defrSetFloorPlanNameCbk(fn);
+            defrSetNonDefaultCbk(ndr);
+
+            defrSetAssertionsStartCbk(constraintst);
+            defrSetConstraintsStartCbk(constraintst);
+            defrSetPinPropStartCbk(cs);
+            defrSetScanchainsStartCbk(cs);
+            defrSetIOTimingsStartCbk(cs);
+            defrSetFPCStartCbk(cs);
+            defrSetTimingDisablesStartCbk(cs);
+            defrSetPartitionsStartCbk(cs);
+            defrSetSlotStartCbk(cs);
+            defrSetFillStartCbk(cs);
+            defrSetNonDefaultStartCbk(cs);
+            defrSetStylesStartCbk(cs);
+
+            defrSetScanChainExtCbk(ext);
+            defrSetIoTimingsExtCbk(ext);
+            defrSetPartitionsExtCbk(ext);
+
+            defrSetSiteCbk((defrSiteCbkFnType)cls);
+            defrSetCanplaceCbk((defrSiteCbkFnType)cls);
+            defrSetCannotOccupyCbk((defrSiteCbkFnType)cls);
+            defrSetPinCapCbk((defrPinCapCbkFnType)cls);
+            defrSetPinPropCbk((defrPinPropCbkFnType)cls);
+            defrSetDefaultCapCbk((defrIntegerCbkFnType)cls);
+            defrSetScanchainCbk((defrScanchainCbkFnType)cls);
+            defrSetIOTimingCbk((defrIOTimingCbkFnType)cls);
+            defrSetFPCCbk((defrFPCCbkFnType)cls);
+            defrSetTimingDisableCbk((defrTimingDisableCbkFnType)cls);
+            defrSetPartitionCbk((defrPartitionCbkFnType)cls);
+            defrSetSlotCbk((defrSlotCbkFnType)cls);
+            defrSetFillCbk((defrFillCbkFnType)cls);
+            defrSetStylesCbk((defrStylesCbkFnType)cls);
+
+            defrSetAssertionsEndCbk(endfunc);
+            defrSetConstraintsEndCbk(endfunc);
+            defrSetFPCEndCbk(endfunc);
+            defrSetIOTimingsEndCbk(endfunc);
+            defrSetPartitionsEndCbk(endfunc);
+            defrSetScanchainsEndCbk(endfunc);
+            defrSetTimingDisablesEndCbk(endfunc);
+            defrSetPinPropEndCbk(endfunc);
+            defrSetSlotEndCbk(endfunc);
+            defrSetFillEndCbk(endfunc);
+            defrSetNonDefaultEndCbk(endfunc);
+            defrSetStylesEndCbk(endfunc);
+        }
 
         defrSetMallocFunction(mallocCB);
         defrSetReallocFunction(reallocCB);
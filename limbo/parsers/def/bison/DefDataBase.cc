@@ -8,6 +8,7 @@
 #include "DefDataBase.h"
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
 
 namespace DefParser {
 
@@ -23,10 +24,79 @@ void DefDataBase::add_def_routing_blockage(int, int, int, int)
 {
 	def_user_cbk_reminder(__func__);
 }
+void DefDataBase::add_def_components(vector<Component> const& vComponent)
+{
+	for (std::size_t i = 0; i < vComponent.size(); ++i)
+		add_def_component(vComponent[i]);
+}
+void DefDataBase::add_def_nets(vector<Net> const& vNet)
+{
+	for (std::size_t i = 0; i < vNet.size(); ++i)
+		add_def_net(vNet[i]);
+}
 void DefDataBase::def_user_cbk_reminder(const char* str) const 
 {
 	cout << "A corresponding user-defined callback is necessary: " << str << endl;
 	exit(0);
 }
 
+limbo::DesignSymbols* DefRefDataBase::def_symbols()
+{
+	return NULL;
+}
+void DefRefDataBase::add_def_component(Component const&)
+{
+	def_user_cbk_reminder(__func__);
+}
+void DefRefDataBase::add_def_pin(Pin const&)
+{
+	def_user_cbk_reminder(__func__);
+}
+void DefRefDataBase::add_def_net(Net const&)
+{
+	def_user_cbk_reminder(__func__);
+}
+
+StringArena::StringArena(std::size_t chunkSize) 
+	: m_chunkSize(chunkSize)
+	, m_chunk(0)
+	, m_pos(0)
+{
+}
+StringArena::~StringArena()
+{
+	for (std::size_t i = 0; i < m_vChunk.size(); ++i)
+		delete [] m_vChunk[i].first;
+}
+StringRef StringArena::copy(const char* s, std::size_t n)
+{
+	// move to a chunk large enough, the last one is allocated if necessary 
+	while (m_chunk < m_vChunk.size() && m_pos+n+1 > m_vChunk[m_chunk].second)
+	{
+		++m_chunk;
+		m_pos = 0;
+	}
+	if (m_chunk == m_vChunk.size())
+	{
+		std::size_t size = std::max(m_chunkSize, n+1);
+		m_vChunk.push_back(make_pair(new char [size], size));
+	}
+	char* p = m_vChunk[m_chunk].first+m_pos;
+	memcpy(p, s, n);
+	p[n] = '\0';
+	m_pos += n+1;
+
+	StringRef ref;
+	ref.data = p;
+	ref.size = n;
+	return ref;
+}
+std::size_t StringArena::capacity() const 
+{
+	std::size_t size = 0;
+	for (std::size_t i = 0; i < m_vChunk.size(); ++i)
+		size += m_vChunk[i].second;
+	return size;
+}
+
 }
@@ -13,7 +13,12 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
 #include <cassert>
+#include <limits>
+
+/// @brief symbols shared by the LEF, DEF and Verilog drivers, see @ref limbo::DesignSymbols 
+namespace limbo { class DesignSymbols; }
 
 /// namespace for DefParser
 namespace DefParser {
@@ -163,6 +168,14 @@ struct Component : public Item
 			<< "orient = " << orient << endl; 
 	}
 };
+/// @brief byte range of the placement of a component in a DEF file, 
+/// i.e., "+ PLACED ( x y ) N" or "+ UNPLACED"; 
+/// for a component without placement, both ends are at its ';' 
+struct DefPlacementRange
+{
+	std::size_t begin; ///< offset of '+' 
+	std::size_t end; ///< offset after the orientation or status 
+};
 /// @brief pin of node/cell 
 struct Pin : public Item
 {
@@ -221,6 +234,202 @@ struct Net : public Item
 		ss << endl;
 	}
 };
+/// @brief characters of a token kept in the scanner without copying into std::string. 
+/// It is a plain struct so that bison can keep it in the semantic union. 
+/// The characters are null terminated and only valid until the parser moves to the next statement. 
+struct StringRef
+{
+	const char* data; ///< first character 
+	uint32_t size; ///< number of characters 
+
+    /// @brief reset to an empty string 
+	void reset() {data = ""; size = 0;}
+    /// @return true if no character 
+	bool empty() const {return size == 0;}
+    /// @return a copy as std::string 
+	string str() const {return string(data, size);}
+    /// @brief copy to a std::string, which reuses its capacity 
+    /// @param s target string 
+	void assign_to(string& s) const {s.assign(data, size);}
+    /// @param rhs null terminated string 
+    /// @return true if the characters are the same 
+	bool operator==(const char* rhs) const {return strncmp(data, rhs, size) == 0 && rhs[size] == '\0';}
+    /// @param rhs string 
+    /// @return true if the characters are the same 
+	bool operator==(string const& rhs) const {return rhs.size() == size && rhs.compare(0, size, data, size) == 0;}
+    /// @brief print characters 
+    /// @param os output stream 
+    /// @param rhs target object 
+    /// @return output stream 
+	friend std::ostream& operator<<(std::ostream& os, StringRef const& rhs)
+	{
+		os.write(rhs.data, rhs.size);
+		return os;
+	}
+};
+
+/// @class DefParser::StringArena
+/// @brief storage of token characters for @ref DefParser::StringRef. 
+/// Characters are appended to large chunks and released all together, 
+/// so the scanner does not allocate a std::string for each token. 
+/// Chunks are kept for reuse after release, so memory is bounded by the longest statement. 
+class StringArena
+{
+	public:
+        /// @brief constructor 
+        /// @param chunkSize number of bytes per chunk 
+		StringArena(std::size_t chunkSize = 64*1024);
+        /// @brief destructor 
+		~StringArena();
+        /// @brief copy characters into the arena 
+        /// @param s first character 
+        /// @param n number of characters 
+        /// @return reference to the copy, which is null terminated 
+		StringRef copy(const char* s, std::size_t n);
+        /// @brief release all copies, chunks are kept for reuse 
+		void release() {m_chunk = 0; m_pos = 0;}
+        /// @return number of bytes reserved 
+		std::size_t capacity() const;
+
+	protected:
+        /// @brief disabled copy 
+		StringArena(StringArena const&);
+        /// @brief disabled assignment 
+		StringArena& operator=(StringArena const&);
+
+		vector<pair<char*, std::size_t> > m_vChunk; ///< chunks and their sizes 
+		std::size_t m_chunkSize; ///< default size of a chunk 
+		std::size_t m_chunk; ///< current chunk 
+		std::size_t m_pos; ///< next free byte in current chunk 
+};
+
+/// @brief component with names referring to characters in the scanner, see @ref DefParser::DefRefDataBase
+struct ComponentRef : public Item
+{
+	StringRef comp_name; ///< component name 
+	StringRef macro_name; ///< macro name of component, standard cell type 
+	StringRef status; ///< placement status 
+	int32_t origin[2]; ///< x, y of origin 
+	StringRef orient; ///< orientation 
+	uint32_t comp_id; ///< symbol of the component, only set with @ref DefParser::DefRefDataBase::def_symbols 
+	uint32_t macro_id; ///< symbol of the macro, only set with @ref DefParser::DefRefDataBase::def_symbols 
+    /// @brief constructor 
+	ComponentRef() {reset();}
+    /// @brief reset all data members 
+	void reset()
+	{
+		comp_name.reset(); macro_name.reset(); status.reset(); orient.reset();
+		origin[0] = origin[1] = -1;
+		comp_id = macro_id = std::numeric_limits<uint32_t>::max();
+	}
+    /// @brief copy to a component with std::string 
+    /// @param c target component 
+	void assign_to(Component& c) const
+	{
+		comp_name.assign_to(c.comp_name);
+		macro_name.assign_to(c.macro_name);
+		status.assign_to(c.status);
+		c.origin[0] = origin[0]; c.origin[1] = origin[1];
+		orient.assign_to(c.orient);
+	}
+    /// @brief print data members 
+    /// @param ss output stream 
+	virtual void print(ostringstream& ss) const
+	{
+		Component c; 
+		assign_to(c);
+		c.print(ss);
+	}
+};
+/// @brief pin with names referring to characters in the scanner, see @ref DefParser::DefRefDataBase
+struct PinRef : public Item
+{
+	StringRef pin_name; ///< pin name 
+	StringRef net_name; ///< net name 
+	StringRef direct; ///< direction 
+	StringRef status; ///< placement status 
+	int32_t origin[2]; ///< offset to node origin 
+	StringRef orient; ///< orientation 
+	StringRef layer_name; ///< layer name 
+	int32_t bbox[4]; ///< bounding box of the pin 
+	StringRef use; ///< "use" token in DEF file 
+	uint32_t pin_id; ///< symbol of the pin, only set with @ref DefParser::DefRefDataBase::def_symbols 
+	uint32_t net_id; ///< symbol of the net, only set with @ref DefParser::DefRefDataBase::def_symbols and a net 
+    /// @brief constructor 
+	PinRef() {reset();}
+    /// @brief reset all data members 
+	void reset()
+	{
+		pin_name.reset(); net_name.reset(); direct.reset(); status.reset(); 
+		orient.reset(); layer_name.reset(); use.reset();
+		origin[0] = origin[1] = -1;
+		bbox[0] = bbox[1] = bbox[2] = bbox[3] = -1;
+		pin_id = net_id = std::numeric_limits<uint32_t>::max();
+	}
+    /// @brief copy to a pin with std::string 
+    /// @param p target pin 
+	void assign_to(Pin& p) const
+	{
+		pin_name.assign_to(p.pin_name);
+		net_name.assign_to(p.net_name);
+		direct.assign_to(p.direct);
+		status.assign_to(p.status);
+		p.origin[0] = origin[0]; p.origin[1] = origin[1];
+		orient.assign_to(p.orient);
+		layer_name.assign_to(p.layer_name);
+		for (uint32_t i = 0; i < 4; ++i)
+			p.bbox[i] = bbox[i];
+		use.assign_to(p.use);
+	}
+    /// @brief print data members 
+    /// @param ss output stream 
+	virtual void print(ostringstream& ss) const
+	{
+		Pin p; 
+		assign_to(p);
+		p.print(ss);
+	}
+};
+/// @brief net with names referring to characters in the scanner, see @ref DefParser::DefRefDataBase
+struct NetRef : public Item
+{
+	StringRef net_name; ///< net name 
+	vector< std::pair<StringRef, StringRef> > vNetPin; ///< array of (node, pin) pair 
+	uint32_t net_id; ///< symbol of the net, only set with @ref DefParser::DefRefDataBase::def_symbols 
+	/// @brief array of (component, pin) symbols in the order of vNetPin, only set with @ref DefParser::DefRefDataBase::def_symbols; 
+	/// the component is invalid for IO pins, i.e., node PIN 
+	vector< std::pair<uint32_t, uint32_t> > vNetPinId; 
+    /// @brief constructor 
+	NetRef() {reset();}
+    /// @brief reset all data members, capacity of the pin arrays is kept 
+	void reset()
+	{
+		net_name.reset();
+		vNetPin.clear();
+		net_id = std::numeric_limits<uint32_t>::max();
+		vNetPinId.clear();
+	}
+    /// @brief copy to a net with std::string 
+    /// @param n target net 
+	void assign_to(Net& n) const
+	{
+		net_name.assign_to(n.net_name);
+		n.vNetPin.resize(vNetPin.size());
+		for (uint32_t i = 0; i < vNetPin.size(); ++i)
+		{
+			vNetPin[i].first.assign_to(n.vNetPin[i].first);
+			vNetPin[i].second.assign_to(n.vNetPin[i].second);
+		}
+	}
+    /// @brief print data members 
+    /// @param ss output stream 
+	virtual void print(ostringstream& ss) const
+	{
+		Net n; 
+		assign_to(n);
+		n.print(ss);
+	}
+};
 // forward declaration
 /// @class DefParser::DefDataBase
 /// @brief Base class for def database. 
@@ -262,6 +471,14 @@ class DefDataBase
         virtual void add_def_placement_blockage(int, int, int, int);
         /// @brief add routing blockages, xl, yl, xh, yh
         virtual void add_def_routing_blockage(int, int, int, int);
+        /// @brief add a block of components in the order of the file, 
+        /// call @ref DefParser::DefDataBase::add_def_component for each one by default. 
+        /// Override it to insert components in bulk; the vector is reused by the parser after the call. 
+        virtual void add_def_components(vector<Component> const&);
+        /// @brief add a block of nets in the order of the file, 
+        /// call @ref DefParser::DefDataBase::add_def_net for each one by default. 
+        /// Override it to insert nets in bulk; the vector is reused by the parser after the call. 
+        virtual void add_def_nets(vector<Net> const&);
 
     protected:
         /// @brief remind users to define some optional callback functions at runtime 
@@ -269,6 +486,38 @@ class DefDataBase
         void def_user_cbk_reminder(const char* str) const;
 };
 
+/// @class DefParser::DefRefDataBase
+/// @brief Base class for def database receiving components, pins and nets through @ref DefParser::StringRef. 
+/// Names refer to characters kept by the scanner, so no std::string is created for them; 
+/// copy or intern the names needed, since the characters are only valid during the callback. 
+/// @ref DefParser::Driver detects this type and calls the callbacks with views instead of 
+/// @ref DefParser::DefDataBase::add_def_component, @ref DefParser::DefDataBase::add_def_pin and @ref DefParser::DefDataBase::add_def_net. 
+/// Components and nets are not passed in blocks, as the characters are released after each statement. 
+/// 
+/// If @ref DefParser::DefRefDataBase::def_symbols returns a table, names are interned by the driver 
+/// and their symbols are set in the views, e.g., @ref DefParser::ComponentRef::macro_id is the symbol of the LEF macro 
+/// in the same table, and components are bound to their macros. 
+class DefRefDataBase : public DefDataBase
+{
+	public:
+        /// @brief symbols shared with LEF and Verilog databases 
+        /// @return the table, NULL by default to pass names only 
+		virtual limbo::DesignSymbols* def_symbols();
+        /// @brief add component/cell 
+		virtual void add_def_component_ref(ComponentRef const&) = 0;
+        /// @brief add pin 
+		virtual void add_def_pin_ref(PinRef const&) = 0;
+        /// @brief add net 
+		virtual void add_def_net_ref(NetRef const&) = 0;
+
+        /// @name callbacks with std::string, never called for this type 
+        ///@{
+		virtual void add_def_component(Component const&);
+		virtual void add_def_pin(Pin const&);
+		virtual void add_def_net(Net const&);
+        ///@}
+};
+
 } // namespace DefParser
 
 #endif
@@ -7,36 +7,444 @@
 
 #include "DefDriver.h"
 #include "DefScanner.h"
+#include <cctype>
+#include <cstring>
+#include <algorithm>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <limbo/parsers/common/DesignSymbols.h>
+#include <limbo/parsers/common/PrefetchInputStream.h>
+#if ZLIB == 1
+#include <limbo/parsers/common/GzipInputStream.h>
+#endif
+#include <limbo/preprocessor/Instrument.h>
 
 namespace DefParser {
 
+/// @brief a COMPONENTS or NETS section, whose records are parsed by threads 
+struct DefSection
+{
+    bool net; ///< NETS if true, otherwise COMPONENTS 
+    std::size_t firstChunk; ///< first chunk of records 
+    std::size_t lastChunk; ///< one past the last chunk of records 
+};
+
+/// @brief records in a section parsed by a thread 
+struct DefChunk
+{
+    bool net; ///< NETS if true, otherwise COMPONENTS 
+    std::size_t begin; ///< first byte of records in the file 
+    std::size_t end; ///< one past the last byte of records 
+    int line; ///< line number of the first byte 
+    bool result; ///< true if successfully parsed 
+};
+
+/// @brief database to keep components and nets of a chunk until they are passed to the user database in order 
+class DefChunkDataBase : public DefRefDataBase
+{
+    public:
+        /// @cond
+        virtual void set_def_dividerchar(string const&) {}
+        virtual void set_def_busbitchars(string const&) {}
+        virtual void set_def_version(string const&) {}
+        virtual void set_def_design(string const&) {}
+        virtual void set_def_unit(int) {}
+        virtual void set_def_diearea(int, int, int, int) {}
+        virtual void add_def_row(Row const&) {}
+        virtual void resize_def_component(int) {}
+        virtual void resize_def_pin(int) {}
+        virtual void resize_def_net(int) {}
+        virtual void add_def_pin_ref(PinRef const&) {}
+        virtual void add_def_component_ref(ComponentRef const& c) 
+        {
+            vComponent.push_back(Component());
+            c.assign_to(vComponent.back());
+        }
+        virtual void add_def_net_ref(NetRef const& n)
+        {
+            vNet.push_back(Net());
+            n.assign_to(vNet.back());
+        }
+        /// @endcond
+
+        vector<Component> vComponent; ///< components in the order of the file 
+        vector<Net> vNet; ///< nets in the order of the file 
+};
+
+/// @brief chunks of a file shared by threads 
+class DefParallelData
+{
+    public:
+        string const* text; ///< content of the file 
+        string const* filename; ///< file name for error messages 
+        bool trace_scanning; ///< debug output of scanners 
+        bool trace_parsing; ///< debug output of parsers 
+        unsigned skip; ///< sections and records skipped by scanners 
+        vector<DefSection> vSection; ///< sections in the order of the file 
+        vector<DefChunk> vChunk; ///< chunks in the order of the file 
+        vector<DefChunkDataBase> vDataBase; ///< results of chunks 
+        std::size_t next; ///< next chunk to parse 
+        std::size_t nextSection; ///< next section to pass to the user database 
+};
+
+/// @brief compare a word to a keyword 
+/// @param p first character of the word 
+/// @param n number of characters 
+/// @param key keyword 
+/// @return true if the same 
+static bool def_match(const char* p, std::size_t n, const char* key)
+{
+    return strlen(key) == n && strncmp(p, key, n) == 0;
+}
+
+/// @brief locate records of COMPONENTS and NETS sections and split them into chunks at ';'. 
+/// Comments and quoted strings are skipped as the scanner does. 
+/// @param data collect sections and chunks 
+/// @param chunkSize minimum number of bytes in a chunk 
+/// @param mainText copy of the file, where records of the sections are overwritten by spaces with line breaks kept 
+static void def_scan_sections(DefParallelData& data, std::size_t chunkSize, string& mainText)
+{
+    enum {OUTSIDE, HEADER, BODY} state = OUTSIDE;
+    string const& text = *data.text;
+    std::size_t n = text.size();
+    const char* p = text.data();
+    bool net = false;
+    bool prevEnd = false; // previous word is END 
+    std::size_t endBegin = 0; // position of the last END 
+    std::size_t bodyBegin = 0;
+    std::size_t chunkBegin = 0;
+    int chunkLine = 1;
+    int line = 1;
+    std::size_t i = 0;
+    while (i < n)
+    {
+        char c = p[i];
+        if (c == '\n')
+        {
+            ++line;
+            ++i;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r')
+            ++i;
+        else if (c == '#') 
+        {
+            while (i < n && p[i] != '\n')
+                ++i;
+        }
+        else if (c == '"')
+        {
+            for (++i; i < n && p[i] != '"'; ++i)
+            {
+                if (p[i] == '\n')
+                    ++line;
+            }
+            ++i;
+            prevEnd = false;
+        }
+        else if (c == ';')
+        {
+            ++i;
+            if (state == HEADER)
+            {
+                state = BODY;
+                bodyBegin = chunkBegin = i;
+                chunkLine = line;
+                data.vSection.push_back(DefSection());
+                data.vSection.back().net = net;
+                data.vSection.back().firstChunk = data.vChunk.size();
+            }
+            else if (state == BODY && i-chunkBegin >= chunkSize)
+            {
+                DefChunk chunk = {net, chunkBegin, i, chunkLine, false};
+                data.vChunk.push_back(chunk);
+                chunkBegin = i;
+                chunkLine = line;
+            }
+            prevEnd = false;
+        }
+        else 
+        {
+            std::size_t first = i;
+            while (i < n && !isspace((unsigned char)p[i]) && p[i] != ';' && p[i] != '"' && p[i] != '#')
+                ++i;
+            if (state == OUTSIDE)
+            {
+                if (!prevEnd && def_match(p+first, i-first, "COMPONENTS"))
+                {
+                    state = HEADER;
+                    net = false;
+                }
+                else if (!prevEnd && def_match(p+first, i-first, "NETS"))
+                {
+                    state = HEADER;
+                    net = true;
+                }
+            }
+            else if (state == BODY && prevEnd && def_match(p+first, i-first, (net)? "NETS" : "COMPONENTS"))
+            {
+                // END of the section, records stop before END 
+                std::size_t end = endBegin;
+                if (chunkBegin < end)
+                {
+                    DefChunk chunk = {net, chunkBegin, end, chunkLine, false};
+                    data.vChunk.push_back(chunk);
+                }
+                data.vSection.back().lastChunk = data.vChunk.size();
+                for (std::size_t j = bodyBegin; j < end; ++j)
+                {
+                    if (mainText[j] != '\n')
+                        mainText[j] = ' ';
+                }
+                state = OUTSIDE;
+            }
+            prevEnd = def_match(p+first, i-first, "END");
+            if (prevEnd)
+                endBegin = first;
+        }
+    }
+    // a section without END is left to the parser to report 
+    if (state == BODY)
+        data.vSection.back().lastChunk = data.vChunk.size();
+}
+
+/// @brief thread function to parse chunks in turn 
+/// @param arg pointer to @ref DefParser::DefParallelData
+/// @return NULL 
+static void* def_parse_chunks(void* arg)
+{
+    DefParallelData& data = *(DefParallelData*)arg;
+    while (true)
+    {
+        std::size_t i = __sync_fetch_and_add(&data.next, 1);
+        if (i >= data.vChunk.size())
+            break;
+        DefChunk& chunk = data.vChunk[i];
+        const char* keyword = (chunk.net)? "NETS" : "COMPONENTS";
+        // wrap records in a design on the first line to keep line numbers 
+        string input;
+        input.reserve(chunk.end-chunk.begin+64);
+        input.append("DESIGN chunk ; ").append(keyword).append(" 0 ; ");
+        input.append(*data.text, chunk.begin, chunk.end-chunk.begin);
+        input.append("\nEND ").append(keyword).append("\nEND DESIGN\n");
+
+        Driver driver (data.vDataBase[i]);
+        driver.trace_scanning = data.trace_scanning;
+        driver.trace_parsing = data.trace_parsing;
+        driver.skip = data.skip;
+        driver.firstline = chunk.line;
+        chunk.result = driver.parse_buffer(input.data(), input.size(), *data.filename);
+    }
+    return NULL;
+}
+
+bool DefFileMapping::open(const char* filename)
+{
+    close();
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat sb;
+    if (fstat(fd, &sb) < 0 || !S_ISREG(sb.st_mode) || sb.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    void* addr = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping holds its own reference to the file 
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+#ifdef MADV_SEQUENTIAL
+    madvise(addr, sb.st_size, MADV_SEQUENTIAL);
+#endif
+    m_data = static_cast<const char*>(addr);
+    m_size = sb.st_size;
+    return true;
+}
+void DefFileMapping::close()
+{
+    if (m_data)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+        m_data = NULL;
+        m_size = 0;
+    }
+}
+
+/// @brief view of a string 
+/// @param s string 
+/// @return reference to characters of the string 
+static StringRef def_string_ref(string const& s)
+{
+    StringRef ref;
+    ref.data = s.c_str();
+    ref.size = s.size();
+    return ref;
+}
+
 Driver::Driver(DefDataBase& db)
     : trace_scanning(false),
       trace_parsing(false),
-      m_db(db)
-{
+      firstline(1),
+      batchsize(65536),
+      placements(NULL),
+      skip(DEF_SKIP_NONE),
+      profile("DefParser"),
+      m_db(db),
+      m_refDb(dynamic_cast<DefRefDataBase*>(&db)),
+      m_symbols((m_refDb)? m_refDb->def_symbols() : NULL),
+      m_parallel(NULL),
+      m_numComponents(0),
+      m_numNets(0)
+{
+    m_placement[0] = 0;
 }
 
 bool Driver::parse_stream(std::istream& in, const std::string& sname)
 {
+    Scanner scanner(&in);
+    return parse(scanner, sname);
+}
+
+bool Driver::parse_buffer(const char* data, std::size_t size, const string& sname)
+{
+    // the stream is not read 
+    std::istringstream empty;
+    Scanner scanner(&empty);
+    scanner.set_input(data, size);
+    bool result = parse(scanner, sname);
+    if (placements)
+        convert_placements(data, size);
+    return result;
+}
+
+bool Driver::parse(Scanner& scanner, const string& sname)
+{
+    limboParserParse(profile);
     streamname = sname;
 
-    Scanner scanner(&in);
     scanner.set_debug(trace_scanning);
+    scanner.set_skip(skip);
     this->lexer = &scanner;
 
     Parser parser(*this);
     parser.set_debug_level(trace_parsing);
-    return (parser.parse() == 0);
+    bool result = (parser.parse() == 0);
+    // items before a syntax error 
+    flush_components();
+    flush_nets();
+    return result;
 }
 
 bool Driver::parse_file(const std::string &filename)
 {
-    std::ifstream in(filename.c_str());
+#if ZLIB == 1
+    if (limbo::is_gzip_file(filename)) // inflated by a helper thread 
+    {
+        limbo::GzipInputStream in (filename);
+        if (!in.good()) return false;
+        if (placements) // offsets refer to the inflated text 
+        {
+            std::ostringstream oss;
+            oss << in.rdbuf();
+            string text = oss.str();
+            return parse_buffer(text.data(), text.size(), filename);
+        }
+        return parse_stream(in, filename);
+    }
+#endif
+    DefFileMapping mapping;
+    if (mapping.open(filename.c_str()))
+        return parse_buffer(mapping.data(), mapping.size(), filename);
+
+    limbo::PrefetchInputStream in (filename); // read ahead by a helper thread 
     if (!in.good()) return false;
+    if (placements)
+    {
+        // offsets are computed from characters in memory 
+        std::ostringstream oss;
+        oss << in.rdbuf();
+        string text = oss.str();
+        return parse_buffer(text.data(), text.size(), filename);
+    }
     return parse_stream(in, filename);
 }
 
+bool Driver::parse_file_parallel(const string& filename, int numThreads)
+{
+    // placements are recorded in the order of the file 
+    if (numThreads <= 1 || placements)
+        return parse_file(filename);
+
+    string text;
+    {
+        DefFileMapping mapping;
+#if ZLIB == 1
+        if (limbo::is_gzip_file(filename))
+        {
+            limbo::GzipInputStream in (filename);
+            if (!in.good()) return false;
+            std::ostringstream oss;
+            oss << in.rdbuf();
+            text = oss.str();
+        }
+        else 
+#endif
+        if (mapping.open(filename.c_str()))
+            text.assign(mapping.data(), mapping.size());
+        else // e.g., pipes 
+        {
+            std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+            if (!in.good()) return false;
+            std::ostringstream oss;
+            oss << in.rdbuf();
+            text = oss.str();
+        }
+    }
+
+    DefParallelData data;
+    data.text = &text;
+    data.filename = &filename;
+    data.trace_scanning = trace_scanning;
+    data.trace_parsing = trace_parsing;
+    data.skip = skip;
+    data.next = 0;
+    data.nextSection = 0;
+    // several chunks per thread to balance sections of different sizes 
+    std::size_t chunkSize = std::max(text.size()/(numThreads*4), (std::size_t)1024*1024);
+    string mainText (text);
+    def_scan_sections(data, chunkSize, mainText);
+    data.vDataBase.resize(data.vChunk.size());
+
+    // threads take chunks in turn, the current thread also works 
+    std::size_t numWorkers = std::min((std::size_t)numThreads, data.vChunk.size());
+    vector<pthread_t> vThread (numWorkers);
+    vector<char> vCreated (numWorkers, false);
+    for (std::size_t i = 1; i < numWorkers; ++i)
+        vCreated[i] = (pthread_create(&vThread[i], NULL, def_parse_chunks, &data) == 0);
+    // also finishes chunks left by threads failed to create 
+    def_parse_chunks(&data);
+    for (std::size_t i = 1; i < numWorkers; ++i)
+    {
+        if (vCreated[i])
+            pthread_join(vThread[i], NULL);
+    }
+    for (std::size_t i = 0; i < data.vChunk.size(); ++i)
+    {
+        if (!data.vChunk[i].result)
+            return false;
+    }
+
+    // other statements, components and nets are passed to database at the beginning of sections 
+    m_parallel = &data;
+    bool result = parse_buffer(mainText.data(), mainText.size(), filename);
+    m_parallel = NULL;
+    return result;
+}
+
 bool Driver::parse_string(const std::string &input, const std::string& sname)
 {
     std::istringstream iss(input);
@@ -54,171 +462,434 @@ void Driver::error(const std::string& m)
     std::cerr << m << std::endl;
 }
 
-void Driver::dividerchar_cbk(string const& s) 
+void Driver::dividerchar_cbk(StringRef const& s) 
 {
-	m_db.set_def_dividerchar(s);
+	limboParserCallback(profile);
+	m_db.set_def_dividerchar(s.str());
 }
-void Driver::busbitchars_cbk(string const& s)
+void Driver::busbitchars_cbk(StringRef const& s)
 {
-	m_db.set_def_busbitchars(s);
+	limboParserCallback(profile);
+	m_db.set_def_busbitchars(s.str());
 }
 void Driver::version_cbk(double v) 
 {
 	// use stringstream to convert double to string 
 	std::stringstream ss;
 	ss << v;
+	limboParserCallback(profile);
 	m_db.set_def_version(ss.str());
 }
-void Driver::design_cbk(string const& s) 
+void Driver::design_cbk(StringRef const& s) 
 {
-	m_db.set_def_design(s);
+	limboParserCallback(profile);
+	m_db.set_def_design(s.str());
 }
 void Driver::unit_cbk(int v) 
 {
+	limboParserCallback(profile);
 	m_db.set_def_unit(v);
 }
 void Driver::diearea_cbk(int xl, int yl, int xh, int yh) 
 {
+	limboParserCallback(profile);
 	m_db.set_def_diearea(xl, yl, xh, yh);
 }
 
-void Driver::row_cbk(string& row_name, string& macro_name, 
-		int originx, int originy, string& orient, 
+void Driver::row_cbk(StringRef const& row_name, StringRef const& macro_name, 
+		int originx, int originy, StringRef const& orient, 
 		int repeatx, int repeaty, int stepx, int stepy) 
 {
-	std::swap(m_row.row_name, row_name); 
-	std::swap(m_row.macro_name, macro_name);
+	row_name.assign_to(m_row.row_name); 
+	macro_name.assign_to(m_row.macro_name);
 	m_row.origin[0] = originx; 
 	m_row.origin[1] = originy; 
-	std::swap(m_row.orient, orient);
+	orient.assign_to(m_row.orient);
 	m_row.repeat[0] = repeatx; m_row.repeat[1] = repeaty;
 	m_row.step[0] = stepx; m_row.step[1] = stepy;
+	limboParserRecord(profile, "ROWS");
+	limboParserCallback(profile);
 	m_db.add_def_row(m_row);
 #ifdef DEBUG_DEFPARSER
 	std::cerr << m_row << std::endl;
 #endif 
 	m_row.reset();
 }
-void Driver::track_cbk(string const& /*orient*/, int /*origin*/, 
+void Driver::track_cbk(StringRef const& /*orient*/, int /*origin*/, 
 		int /*repeat*/, int /*step*/, vector<string> const& /*vLayerName*/) 
 {
+	limboParserRecord(profile, "TRACKS");
 	// leave it empty here
 	// add something if needed
 }
-void Driver::gcellgrid_cbk(string const& /*orient*/, int /*origin*/, 
+void Driver::gcellgrid_cbk(StringRef const& /*orient*/, int /*origin*/, 
 		int /*repeat*/, int /*step*/) 
 {
+	limboParserRecord(profile, "GCELLGRID");
 	// leave it empty here
 	// add something if needed
 }
 void Driver::component_cbk_size(int size) 
 {
-	m_db.resize_def_component(size);
-}
-void Driver::component_cbk_position(string& status, int originx, int originy, string& orient) 
-{
-	std::swap(m_comp.status, status);
-	m_comp.origin[0] = originx; m_comp.origin[1] = originy;
-	std::swap(m_comp.orient, orient);
-}
-void Driver::component_cbk_position(string& status) 
-{
-	std::swap(m_comp.status, status);
-}
-void Driver::component_cbk_source(string const&) 
+	{
+		limboParserCallback(profile);
+		m_db.resize_def_component(size);
+	}
+	// preallocate the block 
+	if (!m_refDb && !m_parallel)
+		m_vComponent.reserve(std::min((std::size_t)std::max(size, 1), batchsize));
+	if (m_parallel)
+	{
+		DefSection const& section = m_parallel->vSection.at(m_parallel->nextSection++);
+		assert(!section.net);
+		for (std::size_t i = section.firstChunk; i < section.lastChunk; ++i)
+		{
+			vector<Component>& vComponent = m_parallel->vDataBase[i].vComponent;
+			add_components(vComponent);
+			// release memory early 
+			vector<Component>().swap(vComponent);
+		}
+	}
+}
+void Driver::component_cbk_position(StringRef const& status, int originx, int originy, StringRef const& orient) 
+{
+	m_compRef.status = status;
+	m_compRef.origin[0] = originx; m_compRef.origin[1] = originy;
+	m_compRef.orient = orient;
+}
+void Driver::component_cbk_position(StringRef const& status) 
+{
+	m_compRef.status = status;
+}
+void Driver::component_cbk_source(StringRef const&) 
 {
 	// no use 
 }
-void Driver::component_cbk(string& comp_name, string& macro_name) 
-{
-	std::swap(m_comp.comp_name, comp_name);
-	std::swap(m_comp.macro_name, macro_name);
-	m_db.add_def_component(m_comp);
+void Driver::component_cbk_range(position const& begin, position const& end) 
+{
+	if (placements)
+	{
+		m_placement[0] = begin.line; m_placement[1] = begin.column;
+		m_placement[2] = end.line; m_placement[3] = end.column;
+	}
+}
+void Driver::component_cbk(StringRef const& comp_name, StringRef const& macro_name, position const& end) 
+{
+	if (placements)
+	{
+		// no placement, insert before ';' 
+		if (m_placement[0] == 0)
+		{
+			m_placement[0] = m_placement[2] = end.line;
+			m_placement[1] = m_placement[3] = end.column;
+		}
+		m_vPlacementPos.insert(m_vPlacementPos.end(), m_placement, m_placement+4);
+		m_placement[0] = 0;
+	}
+	m_compRef.comp_name = comp_name;
+	m_compRef.macro_name = macro_name;
+	limboParserRecord(profile, "COMPONENTS");
+	if (m_refDb)
+	{
+		if (m_symbols)
+			resolve(m_compRef);
+		limboParserCallback(profile);
+		m_refDb->add_def_component_ref(m_compRef);
+	}
+	else 
+	{
+		// reuse objects in the block 
+		if (m_numComponents == m_vComponent.size())
+			m_vComponent.push_back(Component());
+		m_compRef.assign_to(m_vComponent[m_numComponents++]);
+		if (m_numComponents >= batchsize)
+			flush_components();
+	}
 #ifdef DEBUG_DEFPARSER
-	std::cerr << m_comp << std::endl;
+	std::cerr << m_compRef << std::endl;
 #endif 
-	m_comp.reset();
+	m_compRef.reset();
 }
 void Driver::pin_cbk_size(int size) 
 {
+	limboParserCallback(profile);
 	m_db.resize_def_pin(size);
 }
-void Driver::pin_cbk(string& pin_name) // remember to reset in this function 
-{
-	std::swap(m_pin.pin_name, pin_name);
-	m_db.add_def_pin(m_pin);
+void Driver::pin_cbk(StringRef const& pin_name) // remember to reset in this function 
+{
+	m_pinRef.pin_name = pin_name;
+	limboParserRecord(profile, "PINS");
+	if (m_refDb)
+	{
+		if (m_symbols)
+			resolve(m_pinRef);
+		limboParserCallback(profile);
+		m_refDb->add_def_pin_ref(m_pinRef);
+	}
+	else 
+	{
+		m_pinRef.assign_to(m_pin);
+		limboParserCallback(profile);
+		m_db.add_def_pin(m_pin);
+	}
 #ifdef DEBUG_DEFPARSER
-	std::cerr << m_pin << std::endl;
+	std::cerr << m_pinRef << std::endl;
 #endif 
-	m_pin.reset();
+	m_pinRef.reset();
 }
-void Driver::pin_cbk_net(string& net_name)
+void Driver::pin_cbk_net(StringRef const& net_name)
 {
-	std::swap(m_pin.net_name, net_name);
+	m_pinRef.net_name = net_name;
 }
-void Driver::pin_cbk_direction(string& direct)
+void Driver::pin_cbk_direction(StringRef const& direct)
 {
-	std::swap(m_pin.direct, direct);
+	m_pinRef.direct = direct;
 }
-void Driver::pin_cbk_position(string& status, int originx, int originy, string& orient)
+void Driver::pin_cbk_position(StringRef const& status, int originx, int originy, StringRef const& orient)
 {
-	std::swap(m_pin.status, status);
-	m_pin.origin[0] = originx; m_pin.origin[1] = originy;
-	std::swap(m_pin.orient, orient);
+	m_pinRef.status = status;
+	m_pinRef.origin[0] = originx; m_pinRef.origin[1] = originy;
+	m_pinRef.orient = orient;
 }
-void Driver::pin_cbk_bbox(string& layer_name, int xl, int yl, int xh, int yh)
+void Driver::pin_cbk_bbox(StringRef const& layer_name, int xl, int yl, int xh, int yh)
 {
-	std::swap(m_pin.layer_name, layer_name);
-	m_pin.bbox[0] = xl; m_pin.bbox[1] = yl;
-	m_pin.bbox[2] = xh; m_pin.bbox[3] = yh;
+	m_pinRef.layer_name = layer_name;
+	m_pinRef.bbox[0] = xl; m_pinRef.bbox[1] = yl;
+	m_pinRef.bbox[2] = xh; m_pinRef.bbox[3] = yh;
 }
-void Driver::pin_cbk_use(string& use)
+void Driver::pin_cbk_use(StringRef const& use)
 {
-	std::swap(m_pin.use, use);
+	m_pinRef.use = use;
 }
-void Driver::net_cbk_name(string& net_name) 
+void Driver::net_cbk_name(StringRef const& net_name) 
 {
 	// due to the feature of LL 
 	// net_cbk_pin will be called before net_cbk_name 
-	std::swap(m_net.net_name, net_name);
-	std::swap(m_net.vNetPin, m_vNetPin);
-	m_db.add_def_net(m_net);
+	m_netRef.net_name = net_name;
+	limboParserRecord(profile, "NETS");
+	if (m_refDb)
+	{
+		if (m_symbols)
+			resolve(m_netRef);
+		limboParserCallback(profile);
+		m_refDb->add_def_net_ref(m_netRef);
+	}
+	else 
+	{
+		// reuse objects in the block 
+		if (m_numNets == m_vNet.size())
+			m_vNet.push_back(Net());
+		m_netRef.assign_to(m_vNet[m_numNets++]);
+		if (m_numNets >= batchsize)
+			flush_nets();
+	}
 #ifdef DEBUG_DEFPARSER
-	std::cerr << m_net << std::endl;
+	std::cerr << m_netRef << std::endl;
 #endif 
-	m_net.reset();
-	// remember to clear m_vNetPin
-	m_vNetPin.clear();
+	// remember to clear node and pin pairs 
+	m_netRef.reset();
 }
-void Driver::net_cbk_pin(string& node_name, string& pin_name) 
+void Driver::net_cbk_pin(StringRef const& node_name, StringRef const& pin_name) 
 {
-    m_vNetPin.push_back(pair<string, string>());
-    std::swap(m_vNetPin.back().first, node_name);
-    std::swap(m_vNetPin.back().second, pin_name);
+    m_netRef.vNetPin.push_back(make_pair(node_name, pin_name));
 }
 void Driver::net_cbk_size(int size) 
 {
-	m_db.resize_def_net(size);
+	{
+		limboParserCallback(profile);
+		m_db.resize_def_net(size);
+	}
+	// preallocate the block 
+	if (!m_refDb && !m_parallel)
+		m_vNet.reserve(std::min((std::size_t)std::max(size, 1), batchsize));
+	if (m_parallel)
+	{
+		DefSection const& section = m_parallel->vSection.at(m_parallel->nextSection++);
+		assert(section.net);
+		for (std::size_t i = section.firstChunk; i < section.lastChunk; ++i)
+		{
+			vector<Net>& vNet = m_parallel->vDataBase[i].vNet;
+			add_nets(vNet);
+			// release memory early 
+			vector<Net>().swap(vNet);
+		}
+	}
+}
+void Driver::component_cbk_end() 
+{
+	flush_components();
+}
+void Driver::net_cbk_end() 
+{
+	flush_nets();
+}
+void Driver::flush_components()
+{
+	if (m_numComponents == 0)
+		return;
+	// only the last block of a section is partial 
+	if (m_numComponents < m_vComponent.size())
+		m_vComponent.resize(m_numComponents);
+	{
+		limboParserCallback(profile);
+		m_db.add_def_components(m_vComponent);
+	}
+	m_numComponents = 0;
+}
+void Driver::flush_nets()
+{
+	if (m_numNets == 0)
+		return;
+	if (m_numNets < m_vNet.size())
+		m_vNet.resize(m_numNets);
+	{
+		limboParserCallback(profile);
+		m_db.add_def_nets(m_vNet);
+	}
+	m_numNets = 0;
+}
+void Driver::convert_placements(const char* data, std::size_t size)
+{
+	placements->resize(m_vPlacementPos.size()/4);
+	// lines are increasing, so the input is scanned once 
+	int line = firstline;
+	std::size_t lineBegin = 0;
+	for (std::size_t i = 0; i < m_vPlacementPos.size(); i += 2)
+	{
+		int targetLine = m_vPlacementPos[i];
+		while (line < targetLine && lineBegin < size)
+		{
+			const char* p = static_cast<const char*>(memchr(data+lineBegin, '\n', size-lineBegin));
+			lineBegin = (p)? p-data+1 : size;
+			++line;
+		}
+		// columns start from 1 
+		std::size_t offset = std::min(lineBegin+m_vPlacementPos[i+1]-1, size);
+		DefPlacementRange& range = (*placements)[i/4];
+		if (i % 4 == 0)
+			range.begin = offset;
+		else 
+			range.end = offset;
+	}
+	m_vPlacementPos.clear();
+}
+void Driver::add_components(vector<Component> const& vComponent)
+{
+	if (m_refDb)
+	{
+		for (std::size_t i = 0; i < vComponent.size(); ++i)
+		{
+			Component const& c = vComponent[i];
+			m_compRef.comp_name = def_string_ref(c.comp_name);
+			m_compRef.macro_name = def_string_ref(c.macro_name);
+			m_compRef.status = def_string_ref(c.status);
+			m_compRef.origin[0] = c.origin[0]; m_compRef.origin[1] = c.origin[1];
+			m_compRef.orient = def_string_ref(c.orient);
+			if (m_symbols)
+				resolve(m_compRef);
+			{
+				limboParserCallback(profile);
+				m_refDb->add_def_component_ref(m_compRef);
+			}
+			m_compRef.reset();
+		}
+	}
+	else if (!vComponent.empty())
+	{
+		limboParserCallback(profile);
+		m_db.add_def_components(vComponent);
+	}
+}
+void Driver::add_nets(vector<Net> const& vNet)
+{
+	if (m_refDb)
+	{
+		for (std::size_t i = 0; i < vNet.size(); ++i)
+		{
+			Net const& n = vNet[i];
+			m_netRef.net_name = def_string_ref(n.net_name);
+			for (std::size_t j = 0; j < n.vNetPin.size(); ++j)
+				m_netRef.vNetPin.push_back(make_pair(def_string_ref(n.vNetPin[j].first), def_string_ref(n.vNetPin[j].second)));
+			if (m_symbols)
+				resolve(m_netRef);
+			{
+				limboParserCallback(profile);
+				m_refDb->add_def_net_ref(m_netRef);
+			}
+			m_netRef.reset();
+		}
+	}
+	else if (!vNet.empty())
+	{
+		limboParserCallback(profile);
+		m_db.add_def_nets(vNet);
+	}
+}
+/// @param s view of a name 
+/// @return view for the interner 
+static limbo::DesignSymbols::string_view_type def_symbol_name(StringRef const& s)
+{
+	return limbo::DesignSymbols::string_view_type(s.data, s.size);
+}
+void Driver::resolve(ComponentRef& c)
+{
+	c.comp_id = m_symbols->find_or_insert(limbo::DESIGN_INSTANCE, def_symbol_name(c.comp_name));
+	c.macro_id = m_symbols->find_or_insert(limbo::DESIGN_MACRO, def_symbol_name(c.macro_name));
+	m_symbols->bind_instance(c.comp_id, c.macro_id);
+}
+void Driver::resolve(PinRef& p)
+{
+	p.pin_id = m_symbols->find_or_insert(limbo::DESIGN_PIN, def_symbol_name(p.pin_name));
+	if (!p.net_name.empty())
+		p.net_id = m_symbols->find_or_insert(limbo::DESIGN_NET, def_symbol_name(p.net_name));
+}
+void Driver::resolve(NetRef& n)
+{
+	n.net_id = m_symbols->find_or_insert(limbo::DESIGN_NET, def_symbol_name(n.net_name));
+	n.vNetPinId.resize(n.vNetPin.size());
+	for (std::size_t i = 0; i < n.vNetPin.size(); ++i)
+	{
+		std::pair<StringRef, StringRef> const& np = n.vNetPin[i];
+		// node PIN refers to an IO pin instead of a component 
+		n.vNetPinId[i].first = (np.first == "PIN")? limbo::DesignSymbols::invalid_id() 
+			: m_symbols->find_or_insert(limbo::DESIGN_INSTANCE, def_symbol_name(np.first));
+		n.vNetPinId[i].second = m_symbols->find_or_insert(limbo::DESIGN_PIN, def_symbol_name(np.second));
+	}
 }
 void Driver::blockage_cbk_size(int n) 
 {
+    limboParserCallback(profile);
     m_db.resize_def_blockage(n);
 }
 void Driver::blockage_cbk_placement(int xl, int yl, int xh, int yh)
 {
+    limboParserRecord(profile, "BLOCKAGES");
+    limboParserCallback(profile);
     m_db.add_def_placement_blockage(xl, yl, xh, yh);
 }
 void Driver::blockage_cbk_routing(int xl, int yl, int xh, int yh)
 {
+    limboParserRecord(profile, "BLOCKAGES");
+    limboParserCallback(profile);
     m_db.add_def_routing_blockage(xl, yl, xh, yh);
 }
 
-bool read(DefDataBase& db, const string& defFile)
+bool read(DefDataBase& db, const string& defFile, int numThreads, unsigned skip)
 {
+	limboScopedTimer("DefParser::read");
+	limboScopedAllocations("DefParser::read");
 	Driver driver (db);
+	driver.skip = skip;
 	//driver.trace_scanning = true;
 	//driver.trace_parsing = true;
 
+	return driver.parse_file_parallel(defFile, numThreads);
+}
+
+bool read(DefDataBase& db, const string& defFile, vector<DefPlacementRange>& vPlacement)
+{
+	Driver driver (db);
+	driver.placements = &vPlacement;
 	return driver.parse_file(defFile);
 }
 
@@ -9,6 +9,7 @@
 #define DEFPARSER_DRIVER_H
 
 #include "DefDataBase.h"
+#include <limbo/parsers/common/ParserProfile.h>
 
 /** The example namespace is used to encapsulate the three parser classes
  * example::Parser, example::Scanner and example::Driver */
@@ -24,6 +25,18 @@ using std::pair;
 using std::make_pair;
 using std::ostringstream;
 
+/// @brief sections and records skipped by the scanner, see @ref DefParser::Driver::skip. 
+/// Skipped text is fast-forwarded without tokens or grammar actions. 
+enum DefSkipFlag
+{
+    DEF_SKIP_NONE = 0, ///< parse everything 
+    DEF_SKIP_VIAS = 1, ///< VIAS section up to END VIAS 
+    DEF_SKIP_SPECIALNETS = 2, ///< SPECIALNETS section up to END SPECIALNETS 
+    DEF_SKIP_ROUTING = 4, ///< regular wiring of nets after + ROUTED, + FIXED, + COVER or + NOSHIELD up to the next '+' or ';' 
+    DEF_SKIP_PROPERTYDEFINITIONS = 8, ///< PROPERTYDEFINITIONS section up to END PROPERTYDEFINITIONS 
+    DEF_SKIP_PLACEMENT_ONLY = 15 ///< all of the above, which placement never uses 
+};
+
 /** 
  * @class DefParser::Driver
  * The Driver class brings together all components. It creates an instance of
@@ -48,6 +61,24 @@ public:
     /// stream name (file or input stream) used for error messages.
     string streamname;
 
+    /// line number of the first line used for error messages, 
+    /// e.g., when the stream is a part of a file. 
+    int firstline;
+
+    /// maximum number of components or nets passed in a block to 
+    /// @ref DefParser::DefDataBase::add_def_components and @ref DefParser::DefDataBase::add_def_nets 
+    std::size_t batchsize;
+
+    /// if not NULL, byte ranges of placements of components in the order of the file 
+    /// are recorded by @ref DefParser::Driver::parse_buffer and @ref DefParser::Driver::parse_file, 
+    /// which can be patched by @ref DefParser::patch_placements. 
+    /// Files are parsed serially in this mode. 
+    vector<DefPlacementRange>* placements;
+
+    /// bitwise OR of @ref DefParser::DefSkipFlag, sections and records skipped by the scanner. 
+    /// For routed designs, wiring is most of the file, so skipping it speeds up placement-only reads. 
+    unsigned skip;
+
     /** Invoke the scanner and parser for a stream.
      * @param in	input stream
      * @param sname	stream name for error messages
@@ -64,13 +95,37 @@ public:
     bool parse_string(const string& input,
 		      const string& sname = "string stream");
 
-    /** Invoke the scanner and parser on a file. Use parse_stream with a
-     * std::ifstream if detection of file reading errors is required.
+    /** Invoke the scanner and parser on characters in memory without
+     * copying them into a stream.
+     * @param data	first character
+     * @param size	number of characters
+     * @param sname	stream name for error messages
+     * @return		true if successfully parsed
+     */
+    bool parse_buffer(const char* data, std::size_t size,
+		      const string& sname = "buffer");
+
+    /** Invoke the scanner and parser on a file. Regular files are memory
+     * mapped and scanned without an input stream; others are read with
+     * std::ifstream. Use parse_stream with a std::ifstream if detection of
+     * file reading errors is required.
      * @param filename	input file name
      * @return		true if successfully parsed
      */
     bool parse_file(const string& filename);
 
+    /** Invoke the scanner and parser on a file with multiple threads. 
+     * Records of COMPONENTS and NETS sections are split into chunks at ';', 
+     * which are parsed by threads with separate scanners. 
+     * The other statements are parsed by the current thread afterwards, 
+     * and parsed components and nets are passed to the database in the order of the file 
+     * right after @ref DefParser::DefDataBase::resize_def_component and @ref DefParser::DefDataBase::resize_def_net. 
+     * @param filename	input file name
+     * @param numThreads	number of threads 
+     * @return		true if successfully parsed
+     */
+    bool parse_file_parallel(const string& filename, int numThreads);
+
     // To demonstrate pure handling of parse errors, instead of
     // simply dumping them on the standard error output, we will pass
     // them to the driver using the following two member functions.
@@ -87,42 +142,50 @@ public:
      * parser to the scanner. It is used in the yylex macro. */
     class Scanner* lexer;
 
+    /** Counters and timers of the scanner, grammar actions and database
+     * callbacks, compiled out unless LIMBO_INSTRUMENT is defined. It is used
+     * in the yylex macro. */
+    limbo::ParserProfile profile;
+
     /** Reference to the database filled during parsing of the
      * expressions. */
     DefDataBase& m_db;
 
     /// @cond
-	void dividerchar_cbk(string const&) ;
-	void busbitchars_cbk(string const&) ;
+	void dividerchar_cbk(StringRef const&) ;
+	void busbitchars_cbk(StringRef const&) ;
 	void version_cbk(double) ;
-	void design_cbk(string const&) ;
+	void design_cbk(StringRef const&) ;
 	void unit_cbk(int) ;
 	void diearea_cbk(int, int, int, int) ;
 
-	void row_cbk(string&, string&, int, int, string&, int, int, int, int) ;
-	void track_cbk(string const&, int, int, int, vector<string> const&) ;
-	void gcellgrid_cbk(string const&, int, int, int) ;
+	void row_cbk(StringRef const&, StringRef const&, int, int, StringRef const&, int, int, int, int) ;
+	void track_cbk(StringRef const&, int, int, int, vector<string> const&) ;
+	void gcellgrid_cbk(StringRef const&, int, int, int) ;
 	// component cbk
 	void component_cbk_size(int) ;
-	void component_cbk_position(string&, int, int, string&) ;
-	void component_cbk_position(string&) ;
-	void component_cbk_source(string const&) ;
-	void component_cbk(string&, string&) ;
+	void component_cbk_position(StringRef const&, int, int, StringRef const&) ;
+	void component_cbk_position(StringRef const&) ;
+	void component_cbk_source(StringRef const&) ;
+	void component_cbk_range(const class position&, const class position&) ;
+	void component_cbk(StringRef const&, StringRef const&, const class position&) ;
+	void component_cbk_end() ;
 
 	// pin cbk 
 //	void pin_cbk(string const&, string const&, string const&, string const&, 
 //			int, int, string const&, string const&, int, int, int, int) ;
 	void pin_cbk_size(int) ;
-	void pin_cbk(string&); // remember to reset in this function 
-	void pin_cbk_net(string&);
-	void pin_cbk_direction(string&);
-	void pin_cbk_position(string&, int, int, string&);
-	void pin_cbk_bbox(string&, int, int, int, int);
-	void pin_cbk_use(string&);
+	void pin_cbk(StringRef const&); // remember to reset in this function 
+	void pin_cbk_net(StringRef const&);
+	void pin_cbk_direction(StringRef const&);
+	void pin_cbk_position(StringRef const&, int, int, StringRef const&);
+	void pin_cbk_bbox(StringRef const&, int, int, int, int);
+	void pin_cbk_use(StringRef const&);
 	// net cbk 
-	void net_cbk_name(string&) ;
-	void net_cbk_pin(string&, string&) ;
+	void net_cbk_name(StringRef const&) ;
+	void net_cbk_pin(StringRef const&, StringRef const&) ;
 	void net_cbk_size(int) ;
+	void net_cbk_end() ;
     // blockage cbk 
     void blockage_cbk_size(int);
     void blockage_cbk_placement(int, int, int, int);
@@ -130,24 +193,111 @@ public:
     /// @endcond
 
 protected:
-	/// @brief Use as a stack for node and pin pairs in a net,  
-	/// because net_cbk_pin will be called before net_cbk_name
-	vector<pair<string, string> > m_vNetPin;
+    /// @brief run the parser with a scanner 
+    /// @param scanner scanner with input set 
+    /// @param sname stream name for error messages 
+    /// @return true if successfully parsed 
+    bool parse(class Scanner& scanner, const string& sname);
+    /// @brief pass components parsed by a thread to the database 
+    /// @param vComponent components 
+    void add_components(vector<Component> const& vComponent);
+    /// @brief pass nets parsed by a thread to the database 
+    /// @param vNet nets 
+    void add_nets(vector<Net> const& vNet);
+    /// @name set symbols of names in views before they are passed to m_refDb, only with m_symbols 
+    ///@{
+    /// @param c component, bound to its macro 
+    void resolve(ComponentRef& c);
+    /// @param p pin 
+    void resolve(PinRef& p);
+    /// @param n net 
+    void resolve(NetRef& n);
+    ///@}
+    /// @brief pass the block of components to the database 
+    void flush_components();
+    /// @brief pass the block of nets to the database 
+    void flush_nets();
+    /// @brief convert recorded lines and columns of placements to byte offsets 
+    /// @param data first character of the input 
+    /// @param size number of characters 
+    void convert_placements(const char* data, std::size_t size);
+
+    /// @brief database receiving views of names, NULL if the database only takes std::string 
+    DefRefDataBase* m_refDb;
+    /// @brief symbols shared with other parsers, NULL if names are not interned 
+    limbo::DesignSymbols* m_symbols;
+    /// @brief components and nets parsed by threads, NULL if not in parallel mode 
+    class DefParallelData* m_parallel;
     /// @brief temporary row 
 	Row m_row;
-    /// @brief temporary component 
-	Component m_comp;
-    /// @brief temporary pin 
+    /// @brief temporary component with names in the scanner 
+    ComponentRef m_compRef;
+    /// @brief temporary pin with names in the scanner 
+    PinRef m_pinRef;
+    /// @brief temporary net with names in the scanner, 
+    /// node and pin pairs are collected before net_cbk_name 
+    NetRef m_netRef;
+    /// @brief block of components for callbacks with std::string, 
+    /// objects are reused to keep capacity of strings 
+	vector<Component> m_vComponent;
+    /// @brief number of components in the block 
+	std::size_t m_numComponents;
+    /// @brief temporary pin for callbacks with std::string 
 	Pin m_pin;
-    /// @brief temporary net 
-	Net m_net;
+    /// @brief block of nets for callbacks with std::string 
+	vector<Net> m_vNet;
+    /// @brief number of nets in the block 
+	std::size_t m_numNets;
+    /// @brief line and column of the begin and the end of the placement of the current component, 
+    /// line is 0 if not found 
+    int m_placement[4];
+    /// @brief lines and columns of recorded placements, 4 per component 
+    vector<int> m_vPlacementPos;
 };
 
 /// @brief API for DefParser. 
 /// Read DEF file and initialize database by calling user-defined callback functions. 
 /// @param db database which is derived from @ref DefParser::DefDataBase
 /// @param defFile DEF file 
-bool read(DefDataBase& db, const string& defFile);
+/// @param numThreads number of threads, see @ref DefParser::Driver::parse_file_parallel
+/// @param skip bitwise OR of @ref DefParser::DefSkipFlag, see @ref DefParser::Driver::skip
+bool read(DefDataBase& db, const string& defFile, int numThreads = 1, unsigned skip = DEF_SKIP_NONE);
+
+/// @brief API for DefParser. 
+/// Read DEF file serially and record byte ranges of placements of components for @ref DefParser::patch_placements. 
+/// Ranges are derived from lines and columns, so quoted strings spanning lines before components are not supported. 
+/// @param db database which is derived from @ref DefParser::DefDataBase
+/// @param defFile DEF file 
+/// @param vPlacement byte ranges of placements in the order of components 
+bool read(DefDataBase& db, const string& defFile, vector<DefPlacementRange>& vPlacement);
+
+/// @brief read-only memory mapping of a regular file 
+class DefFileMapping
+{
+    public:
+        /// @brief constructor 
+        DefFileMapping() : m_data(NULL), m_size(0) {}
+        /// @brief destructor 
+        ~DefFileMapping() {close();}
+        /// @brief map a file 
+        /// @param filename file name 
+        /// @return true if succeed, false for empty or irregular files 
+        bool open(const char* filename);
+        /// @brief unmap the file 
+        void close();
+        /// @return first byte 
+        const char* data() const {return m_data;}
+        /// @return number of bytes 
+        std::size_t size() const {return m_size;}
+    protected:
+        /// @brief disabled copy 
+        DefFileMapping(DefFileMapping const&);
+        /// @brief disabled assignment 
+        DefFileMapping& operator=(DefFileMapping const&);
+
+        const char* m_data; ///< mapped bytes 
+        std::size_t m_size; ///< number of bytes 
+};
 
 } // namespace example
 
@@ -11,6 +11,11 @@
 
 %}
 
+/* types in the semantic union, also needed by the parser header */
+%code requires {
+#include "DefDataBase.h"
+}
+
 /*** yacc/bison Declarations ***/
 
 /* Require bison 2.3 or later */
@@ -41,6 +46,7 @@
 {
     // initialize the initial location object
     @$.begin.filename = @$.end.filename = &driver.streamname;
+    @$.begin.line = @$.end.line = driver.firstline;
 };
 
 /* The driver is passed by reference to the parser and to the scanner. This
@@ -56,9 +62,10 @@
 %union {
     int  			integerVal;
     double 			doubleVal;
-    std::string*		stringVal;
-	std::string*		quoteVal;
-	std::string*		binaryVal;
+    /* characters are kept by the scanner, no need to delete */
+    StringRef		stringVal;
+	StringRef		quoteVal;
+	StringRef		binaryVal;
 
 /*	class IntegerArray* integerArrayVal;*/
 	class StringArray* stringArrayVal;
@@ -129,7 +136,6 @@
 %type <integerVal>	expression 
 */
 
-%destructor { delete $$; } STRING QUOTE BINARY
 %destructor { delete $$; } /*integer_array*/ string_array 
 /*
 %destructor { delete $$; } constant variable
@@ -147,7 +153,7 @@
  * object. it defines the yylex() function call to pull the next token from the
  * current lexer object of the driver context. */
 #undef yylex
-#define yylex driver.lexer->lex
+#define yylex(yylval, yylloc) limboParserScan(driver.profile, driver.lexer->lex(yylval, yylloc))
 
 %}
 
@@ -165,12 +171,10 @@ integer_array : INTEGER {
 			  }
 */
 string_array : STRING {
-				$$ = new StringArray(1, *$1);
-                delete $1;
+				$$ = new StringArray(1, $1.str());
 			  }
 			  | string_array STRING {
-				$1->push_back(*$2);
-                delete $2;
+				$1->push_back($2.str());
 				$$ = $1;
 			  }
 
@@ -178,20 +182,15 @@ block_other : KWD_VERSION DOUBLE ';' {
 				driver.version_cbk($2);
 			}
 			| KWD_DIVIDERCHAR QUOTE ';' {
-				driver.dividerchar_cbk(*$2);
-                delete $2;
+				driver.dividerchar_cbk($2);
 			}
 			| KWD_BUSBITCHARS QUOTE ';' {
-				driver.busbitchars_cbk(*$2);
-                delete $2;
+				driver.busbitchars_cbk($2);
 			}
 			
  /*** grammar for rows ***/
 single_row : KWD_ROW STRING STRING INTEGER INTEGER STRING KWD_DO INTEGER KWD_BY INTEGER KWD_STEP INTEGER INTEGER ';' {
-				driver.row_cbk(*$2, *$3, $4, $5, *$6, $8, $10, $12, $13);
-                delete $2;
-                delete $3;
-                delete $6;
+				driver.row_cbk($2, $3, $4, $5, $6, $8, $10, $12, $13);
 			 }
 
 block_rows : single_row 
@@ -200,8 +199,7 @@ block_rows : single_row
 
  /*** grammar for tracks ***/
 single_tracks : KWD_TRACKS STRING INTEGER KWD_DO INTEGER KWD_STEP INTEGER KWD_LAYER string_array ';' {
-				driver.track_cbk(*$2, $3, $5, $7, *$9);
-                delete $2;
+				driver.track_cbk($2, $3, $5, $7, *$9);
                 delete $9;
 			 }
 
@@ -211,8 +209,7 @@ block_tracks : single_tracks
 
  /*** grammar for gcellgrid ***/
 single_gcellgrid : KWD_GCELLGRID STRING INTEGER KWD_DO INTEGER KWD_STEP INTEGER ';' {
-				driver.gcellgrid_cbk(*$2, $3, $5, $7);
-                delete $2;
+				driver.gcellgrid_cbk($2, $3, $5, $7);
 			 }
 
 block_gcellgrid : single_gcellgrid 
@@ -227,16 +224,16 @@ end_vias : KWD_END KWD_VIAS
 		 ;
 
 via_addon : /* empty */
-		  | via_addon '+' KWD_VIARULE STRING {delete $4;}
+		  | via_addon '+' KWD_VIARULE STRING
 		  | via_addon '+' KWD_CUTSIZE INTEGER INTEGER
 		  | via_addon '+' KWD_LAYERS string_array {delete $4;}
 		  | via_addon '+' KWD_CUTSPACING INTEGER INTEGER 
 		  | via_addon '+' KWD_ENCLOSURE INTEGER INTEGER INTEGER INTEGER 
-		  | via_addon '+' KWD_RECT STRING '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')' {delete $4;}
+		  | via_addon '+' KWD_RECT STRING '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')'
 		  | via_addon '+' KWD_ROWCOL INTEGER INTEGER 
 		  ;
 
-single_via : '-' STRING via_addon ';' {delete $2;}
+single_via : '-' STRING via_addon ';'
 		   ;
 
 multiple_vias : single_via 
@@ -255,11 +252,11 @@ end_nondefaultrules : KWD_END KWD_NONDEFAULTRULES
 
 nondefaultrule_addon : /* empty */
            | nondefaultrule_addon '+' KWD_HARDSPACING
-           | nondefaultrule_addon '+' KWD_LAYER STRING KWD_WIDTH INTEGER KWD_SPACING INTEGER {delete $4;}
-           | nondefaultrule_addon '+' KWD_VIA STRING {delete $4;}
+           | nondefaultrule_addon '+' KWD_LAYER STRING KWD_WIDTH INTEGER KWD_SPACING INTEGER
+           | nondefaultrule_addon '+' KWD_VIA STRING
            ;
 
-single_nondefaultrule : '-' STRING nondefaultrule_addon ';' {delete $2;}
+single_nondefaultrule : '-' STRING nondefaultrule_addon ';'
                       ;
 
 multiple_nondefaultrules : single_nondefaultrule
@@ -284,7 +281,7 @@ region_points : '(' INTEGER INTEGER ')'
               | region_points '(' INTEGER INTEGER ')'
              ;
 
-single_region : '-' STRING region_points region_addon ';' {delete $2;}
+single_region : '-' STRING region_points region_addon ';'
               ;
 
 multiple_regions : single_region
@@ -300,34 +297,30 @@ begin_components : KWD_COMPONENTS INTEGER ';' {
 					driver.component_cbk_size($2);
 				 }
 
-end_components : KWD_END KWD_COMPONENTS 
-			   ;
+end_components : KWD_END KWD_COMPONENTS {
+					driver.component_cbk_end();
+			   }
 
 component_addon : /* empty */
 				| component_addon '+' STRING '(' INTEGER INTEGER ')' STRING {
-					driver.component_cbk_position(*$3, $5, $6, *$8);
-                    delete $3;
-                    delete $8;
+					driver.component_cbk_position($3, $5, $6, $8);
+					driver.component_cbk_range(@2.begin, @8.end);
 				}
 				| component_addon '+' STRING '(' DOUBLE DOUBLE ')' STRING { /*it may be double in some benchmarks*/
-					driver.component_cbk_position(*$3, $5, $6, *$8);
-                    delete $3; 
-                    delete $8;
+					driver.component_cbk_position($3, $5, $6, $8);
+					driver.component_cbk_range(@2.begin, @8.end);
 				}
 				| component_addon '+' KWD_SOURCE STRING {
-					driver.component_cbk_source(*$4);
-                    delete $4;
+					driver.component_cbk_source($4);
 				}
 				| component_addon '+' STRING {
-					driver.component_cbk_position(*$3);
-                    delete $3;
+					driver.component_cbk_position($3);
+					driver.component_cbk_range(@2.begin, @3.end);
 				}
 				;
 
 single_component : '-' STRING STRING component_addon ';' {
-				driver.component_cbk(*$2, *$3);
-                delete $2;
-                delete $3;
+				driver.component_cbk($2, $3, @5.begin);
 			}
 
 multiple_components : single_component 
@@ -351,31 +344,24 @@ end_pins : KWD_END KWD_PINS
 
 pin_addon : /* empty */
 		  | pin_addon '+' KWD_NET STRING {
-			driver.pin_cbk_net(*$4);
-            delete $4;
+			driver.pin_cbk_net($4);
 		  }
 		  | pin_addon '+' KWD_DIRECTION STRING {
-			driver.pin_cbk_direction(*$4);
-            delete $4;
+			driver.pin_cbk_direction($4);
 		  }
 		  | pin_addon '+' STRING '(' INTEGER INTEGER ')' STRING {
-			driver.pin_cbk_position(*$3, $5, $6, *$8);
-            delete $3;
-            delete $8;
+			driver.pin_cbk_position($3, $5, $6, $8);
 		  }
 		  | pin_addon '+' KWD_LAYER STRING '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')' {
-			driver.pin_cbk_bbox(*$4, $6, $7, $10, $11);
-            delete $4;
+			driver.pin_cbk_bbox($4, $6, $7, $10, $11);
 		  }
 		  | pin_addon '+' KWD_USE STRING {
-			driver.pin_cbk_use(*$4);
-            delete $4;
+			driver.pin_cbk_use($4);
 		  }
 		  ;
 
 single_pin : '-' STRING pin_addon ';' {
-			driver.pin_cbk(*$2);
-            delete $2;
+			driver.pin_cbk($2);
 		   }
 
 multiple_pins : single_pin 
@@ -396,7 +382,7 @@ end_blockages : KWD_END KWD_BLOCKAGES
               ;
 single_blockage : '-' KWD_PLACEMENT KWD_RECT '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')' ';' {driver.blockage_cbk_placement($5, $6, $9, $10);}
                 | '-' KWD_ROUTING KWD_RECT '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')' ';' {driver.blockage_cbk_routing($5, $6, $9, $10);}
-                | '-' KWD_LAYER STRING KWD_RECT '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')' ';' {delete $3;}
+                | '-' KWD_LAYER STRING KWD_RECT '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')' ';'
                 ;
 multiple_blockages : single_blockage
                    | multiple_blockages single_blockage
@@ -411,22 +397,22 @@ begin_specialnets : KWD_SPECIALNETS INTEGER ';'
 				  ;
 end_specialnets : KWD_END KWD_SPECIALNETS
 				;
-specialnets_metal_layer : STRING STRING INTEGER {delete $1; delete $2;}
+specialnets_metal_layer : STRING STRING INTEGER
 						;
-specialnets_metal_shape : '+' KWD_SHAPE STRING '(' INTEGER INTEGER ')' '(' INTEGER '*' ')' {delete $3;}
-						| '+' KWD_SHAPE STRING '(' INTEGER INTEGER ')' '(' '*' INTEGER ')' {delete $3;}
-						| '+' KWD_SHAPE STRING '(' INTEGER INTEGER ')' STRING {delete $3; delete $8;}
+specialnets_metal_shape : '+' KWD_SHAPE STRING '(' INTEGER INTEGER ')' '(' INTEGER '*' ')'
+						| '+' KWD_SHAPE STRING '(' INTEGER INTEGER ')' '(' '*' INTEGER ')'
+						| '+' KWD_SHAPE STRING '(' INTEGER INTEGER ')' STRING
 						;
 specialnets_metal_array : specialnets_metal_layer specialnets_metal_shape 
 						| specialnets_metal_array specialnets_metal_layer specialnets_metal_shape 
 						;
 specialnets_addon : /* empty */
 				  | specialnets_addon '+' specialnets_metal_array
-				  | specialnets_addon '+' KWD_USE STRING {delete $4;}
-                  | specialnets_addon '+' KWD_RECT STRING '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')' {delete $4;}
+				  | specialnets_addon '+' KWD_USE STRING
+                  | specialnets_addon '+' KWD_RECT STRING '(' INTEGER INTEGER ')' '(' INTEGER INTEGER ')'
 				  ;
-single_specialnet : '-' BINARY specialnets_addon ';' {delete $2;}
-				  | '-' STRING specialnets_addon ';' {delete $2;}
+single_specialnet : '-' BINARY specialnets_addon ';'
+				  | '-' STRING specialnets_addon ';'
 				   ;
 multiple_specialnets : single_specialnet
 					 | multiple_specialnets single_specialnet
@@ -440,14 +426,13 @@ begin_nets : KWD_NETS INTEGER ';' {
 					driver.net_cbk_size($2);
 				}
 
-end_nets : KWD_END KWD_NETS
-		 ;
+end_nets : KWD_END KWD_NETS {
+					driver.net_cbk_end();
+		 }
 
 node_pin_pair : '(' STRING STRING ')' {
 		   /** be careful, this callback will be invoked before net_cbk_name **/
-				driver.net_cbk_pin(*$2, *$3); 
-                delete $2;
-                delete $3;
+				driver.net_cbk_pin($2, $3); 
 			  }
 
 node_pin_pairs : node_pin_pair 
@@ -455,17 +440,15 @@ node_pin_pairs : node_pin_pair
 			   ;
 
 net_addon : /* empty */
-          | net_addon '+' KWD_USE STRING {delete $4;}
-          | net_addon '+' KWD_NONDEFAULTRULE STRING {delete $4;}
+          | net_addon '+' KWD_USE STRING
+          | net_addon '+' KWD_NONDEFAULTRULE STRING
           ;
 
 single_net : '-' STRING node_pin_pairs net_addon ';' {
-				driver.net_cbk_name(*$2);
-                delete $2;
+				driver.net_cbk_name($2);
 		   } 
 		   | '-' BINARY node_pin_pairs net_addon ';' {
-				driver.net_cbk_name(*$2);
-                delete $2;
+				driver.net_cbk_name($2);
 		   } 
            ;
 
@@ -483,9 +466,9 @@ block_nets : begin_nets
  /*** grammar for property definitions ***/
  /*** additional block, usually useless for placement ***/
  /*** so no callbacks are created for it ***/
-single_propterty : KWD_COMPONENTPIN STRING STRING ';' {delete $2; delete $3;}
-				 | KWD_DESIGN STRING STRING DOUBLE ';' {delete $2; delete $3;}
-                 | KWD_NET STRING STRING ';' {delete $2; delete $3;}
+single_propterty : KWD_COMPONENTPIN STRING STRING ';'
+				 | KWD_DESIGN STRING STRING DOUBLE ';'
+                 | KWD_NET STRING STRING ';'
 				 ;
 
 multiple_property : single_propterty 
@@ -506,10 +489,10 @@ end_groups : KWD_END KWD_GROUPS
            ;
 
 group_addon : /* empty */
-            | group_addon '+' KWD_REGION STRING {delete $4;}
+            | group_addon '+' KWD_REGION STRING
             ;
 
-single_group : '-' STRING string_array group_addon ';' {delete $2; delete $3;}
+single_group : '-' STRING string_array group_addon ';' {delete $3;}
              ;
 
 multiple_groups : single_group 
@@ -523,8 +506,7 @@ block_groups : begin_groups multiple_groups end_groups
  /*** grammar for top design ***/
 
 begin_design : KWD_DESIGN STRING ';' {
-				driver.design_cbk(*$2);
-                delete $2;
+				driver.design_cbk($2);
 			 }
 
 end_design : KWD_END KWD_DESIGN
@@ -53,6 +53,39 @@ public:
 
     /** Enable debug output (via arg_yyout) if compiled into the scanner. */
     void set_debug(bool b);
+
+    /** Read characters from memory, e.g., a memory mapped file, instead of
+     * the input stream. The memory must be valid until scanning finishes. */
+    void set_input(const char* data, std::size_t size);
+
+    /** Fill the buffer of the scanner from memory if set_input has been
+     * called, otherwise from the input stream. */
+    virtual int LexerInput(char* buf, int max_size);
+
+    /** Storage of characters of STRING, QUOTE and BINARY tokens. The
+     * characters are released when the token after a ';' is requested, i.e.,
+     * after the parser has reduced the statement and called its callbacks. */
+    StringArena& arena() {return m_arena;}
+
+    /** Set sections and records to fast-forward without tokens, a bitwise
+     * OR of DefSkipFlag. */
+    void set_skip(unsigned skip) {m_skip = skip;}
+
+protected:
+    /** Count line breaks of a token spanning lines, which YY_USER_ACTION has
+     * counted as columns. */
+    void count_lines(Parser::location_type* yylloc);
+    /** @return true if the current token, END followed by a word, ends the
+     * skipped section. */
+    bool is_skip_end() const;
+
+
+    StringArena m_arena; ///< characters of tokens in the current statement
+    bool m_release; ///< release m_arena before scanning the next token
+    const char* m_input; ///< next character in memory, NULL to read the stream
+    const char* m_inputEnd; ///< end of characters in memory
+    unsigned m_skip; ///< bitwise OR of DefSkipFlag
+    const char* m_skipEnd; ///< keyword of the skipped section
 };
 
 } // namespace example
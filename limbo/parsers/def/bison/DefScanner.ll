@@ -1,11 +1,22 @@
 /* $Id: scanner.ll 44 2008-10-23 09:03:19Z tb $ -*- mode: c++ -*- */
 /** \file scanner.ll Define the example Flex lexical scanner */
 
+%top{
+/* a large window for the input, which is refilled less often */
+#define YY_BUF_SIZE (1024*1024)
+#define YY_READ_BUF_SIZE YY_BUF_SIZE
+}
+
 %{ /*** C/C++ Declarations ***/
 
 #include <string>
+#include <cstring>
+#include <algorithm>
+#include <limbo/string/CharConv.h>
+#include <limbo/parsers/common/ParserProfile.h>
 
 #include "DefScanner.h"
+#include "DefDriver.h"
 
 /* import the parser's token type into a local typedef */
 typedef DefParser::Parser::token token;
@@ -42,18 +53,39 @@ typedef DefParser::Parser::token_type token_type;
 /* enables the use of start condition stacks */
 %option stack
 
+/* a skipped section up to its END, skipped wiring of a net up to the next
+ * '+' or ';', and a NETS section whose wiring is skipped */
+%x SKIPSECTION
+%x SKIPWIRING
+%s NETSECTION
+
 /* The following paragraph suffices to track locations accurately. Each time
  * yylex is invoked, the begin position is moved onto the end position. */
 %{
 #define YY_USER_ACTION  yylloc->columns(yyleng);
 %}
 
+/* Read input as flex does by default, and count the bytes in the profile of
+ * the driver if compiled with LIMBO_INSTRUMENT. */
+%{
+#define YY_INPUT(buf, result, max_size) \
+    if ((int)(result = LexerInput((char*)buf, max_size)) < 0) \
+        YY_FATAL_ERROR("input in flex scanner failed"); \
+    limboParserBytes(result);
+%}
+
 %% /*** Regular Expressions Part ***/
 
  /* code to place at the beginning of yylex() */
 %{
     // reset location
     yylloc->step();
+    // the last statement has been reduced, so no token refers to the arena
+    if (m_release)
+    {
+        m_arena.release();
+        m_release = false;
+    }
 %}
 
  /*** BEGIN EXAMPLE - Change the example lexer rules below ***/
@@ -102,6 +134,16 @@ typedef DefParser::Parser::token_type token_type;
 }
 "NETS" {
 	return token::KWD_NETS;
+}
+ /* the NETS header is followed by the number of nets, END NETS is not */
+"NETS"/[ \t\r\n]+[0-9] {
+	if (m_skip & DEF_SKIP_ROUTING)
+		BEGIN(NETSECTION);
+	return token::KWD_NETS;
+}
+<NETSECTION>"END"/[ \t\r\n]+"NETS" {
+	BEGIN(INITIAL);
+	return token::KWD_END;
 }
 "END" {
 	return token::KWD_END;
@@ -116,7 +158,15 @@ typedef DefParser::Parser::token_type token_type;
 	return token::KWD_LAYER;
 }
 "PROPERTYDEFINITIONS" {
-	return token::KWD_PROPERTYDEFINITIONS;
+	/* END PROPERTYDEFINITIONS is consumed by SKIPSECTION in skip mode */
+	if (m_skip & DEF_SKIP_PROPERTYDEFINITIONS)
+	{
+		m_skipEnd = "PROPERTYDEFINITIONS";
+		BEGIN(SKIPSECTION);
+		yylloc->step();
+	}
+	else
+		return token::KWD_PROPERTYDEFINITIONS;
 }
 "COMPONENTPIN" {
 	return token::KWD_COMPONENTPIN;
@@ -128,7 +178,15 @@ typedef DefParser::Parser::token_type token_type;
 	return token::KWD_GCELLGRID;
 }
 "VIAS" {
-	return token::KWD_VIAS;
+	/* END VIAS is consumed by SKIPSECTION in skip mode */
+	if (m_skip & DEF_SKIP_VIAS)
+	{
+		m_skipEnd = "VIAS";
+		BEGIN(SKIPSECTION);
+		yylloc->step();
+	}
+	else
+		return token::KWD_VIAS;
 }
 "VIA" {
 	return token::KWD_VIA;
@@ -155,7 +213,15 @@ typedef DefParser::Parser::token_type token_type;
 	return token::KWD_USE;
 }
 "SPECIALNETS" {
-	return token::KWD_SPECIALNETS;
+	/* END SPECIALNETS is consumed by SKIPSECTION in skip mode */
+	if (m_skip & DEF_SKIP_SPECIALNETS)
+	{
+		m_skipEnd = "SPECIALNETS";
+		BEGIN(SKIPSECTION);
+		yylloc->step();
+	}
+	else
+		return token::KWD_SPECIALNETS;
 }
 "SHAPE" {
 	return token::KWD_SHAPE;
@@ -209,28 +275,73 @@ typedef DefParser::Parser::token_type token_type;
     return token::KWD_ROUTING;
 }
 
+ /* fast-forward skipped sections without tokens */
+<SKIPSECTION>"END"[ \t\r\n]+[A-Za-z]+ {
+    count_lines(yylloc);
+    if (is_skip_end())
+        BEGIN(INITIAL);
+    yylloc->step();
+}
+<SKIPSECTION>[^ \t\r\n#"]+ {
+    yylloc->step();
+}
+
+ /* fast-forward wiring of nets, keeping '+' of the next attribute and ';' */
+<NETSECTION,SKIPWIRING>"+"[ \t\r\n]+("ROUTED"|"FIXED"|"COVER"|"NOSHIELD")/[ \t\r\n] {
+    count_lines(yylloc);
+    BEGIN(SKIPWIRING);
+    yylloc->step();
+}
+<SKIPWIRING>"+"/[ \t\r\n] {
+    BEGIN(NETSECTION);
+    return static_cast<token_type>('+');
+}
+<SKIPWIRING>";" {
+    BEGIN(NETSECTION);
+    m_release = true;
+    return static_cast<token_type>(';');
+}
+<SKIPWIRING>[^ \t\r\n#";+]+ {
+    yylloc->step();
+}
+
+<SKIPSECTION,SKIPWIRING>[ \t\r\n]+ {
+    count_lines(yylloc);
+    yylloc->step();
+}
+<SKIPSECTION,SKIPWIRING>"#"([^\n])* {
+    yylloc->step();
+}
+<SKIPSECTION,SKIPWIRING>\"([^"])*\" {
+    count_lines(yylloc);
+    yylloc->step();
+}
+<SKIPSECTION,SKIPWIRING>. {
+    yylloc->step();
+}
+
 [\+\-]?[0-9]+ {
-    yylval->integerVal = atoi(yytext);
+    limbo::from_chars(yytext, yytext+yyleng, yylval->integerVal);
     return token::INTEGER;
 }
 
 [\+\-]?[0-9]+"."[0-9]* {
-    yylval->doubleVal = atof(yytext);
+    limbo::from_chars(yytext, yytext+yyleng, yylval->doubleVal);
     return token::DOUBLE;
 }
 
 [0-9]*\'[A-Za-z][0-9]+ {
-    yylval->stringVal = new std::string(yytext, yyleng);
+    yylval->binaryVal = m_arena.copy(yytext, yyleng);
     return token::BINARY;
 }
 
 [A-Za-z_]([A-Za-z0-9_,.\-\[\]\/\*]|([\\][\(\)]))* {
-    yylval->stringVal = new std::string(yytext, yyleng);
+    yylval->stringVal = m_arena.copy(yytext, yyleng);
     return token::STRING;
 }
 
 \"([^"])*\" {
-    yylval->quoteVal = new std::string(yytext+1, yyleng-2);
+    yylval->quoteVal = m_arena.copy(yytext+1, yyleng-2);
     return token::QUOTE;
 }
 
@@ -252,6 +363,8 @@ typedef DefParser::Parser::token_type token_type;
 
  /* pass all other characters up to bison */
 . {
+    if (*yytext == ';')
+        m_release = true;
     return static_cast<token_type>(*yytext);
 }
 
@@ -263,8 +376,50 @@ namespace DefParser {
 
 Scanner::Scanner(std::istream* in,
 		 std::ostream* out)
-    : DefParserFlexLexer(in, out)
+    : DefParserFlexLexer(in, out),
+      m_release(false),
+      m_input(NULL),
+      m_inputEnd(NULL),
+      m_skip(DEF_SKIP_NONE),
+      m_skipEnd(NULL)
+{
+}
+
+void Scanner::set_input(const char* data, std::size_t size)
+{
+    m_input = data;
+    m_inputEnd = data+size;
+}
+
+int Scanner::LexerInput(char* buf, int max_size)
+{
+    if (!m_input)
+        return DefParserFlexLexer::LexerInput(buf, max_size);
+    std::size_t n = std::min((std::size_t)max_size, (std::size_t)(m_inputEnd-m_input));
+    memcpy(buf, m_input, n);
+    m_input += n;
+    return n;
+}
+
+void Scanner::count_lines(Parser::location_type* yylloc)
+{
+    int lines = std::count(yytext, yytext+yyleng, '\n');
+    if (lines)
+    {
+        const char* last = yytext+yyleng;
+        while (last[-1] != '\n')
+            --last;
+        yylloc->lines(lines);
+        yylloc->columns(yytext+yyleng-last);
+    }
+}
+
+bool Scanner::is_skip_end() const
 {
+    std::size_t n = strlen(m_skipEnd);
+    const char* word = yytext+yyleng-n;
+    return (std::size_t)yyleng > n+3 && strncmp(word, m_skipEnd, n) == 0
+        && strchr(" \t\r\n", word[-1]);
 }
 
 Scanner::~Scanner()
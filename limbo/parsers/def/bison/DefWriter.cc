@@ -0,0 +1,426 @@
+/**
+ * @file   DefWriter.cc
+ * @brief  Implementation of @ref DefParser::DefWriter
+ * @date   Oct 2026
+ */
+
+#include "DefWriter.h"
+#include "DefDriver.h"
+#include <limbo/string/String.h>
+#include <limbo/string/CharConv.h>
+#include <pthread.h>
+/// support to .def.gz if enabled
+#if ZLIB == 1
+#include <zlib.h>
+#endif
+
+namespace DefParser {
+
+/// @brief a block of items formatted by a thread
+template <typename ItemType>
+struct DefFormatTask
+{
+    DefItemSource<ItemType> const* source; ///< items
+    std::size_t begin; ///< first item
+    std::size_t end; ///< one past the last item
+    string buffer; ///< formatted records
+};
+
+/// @brief thread function to format a block of items
+/// @param arg pointer to @ref DefParser::DefFormatTask
+/// @return NULL
+template <typename ItemType>
+static void* def_format_task(void* arg)
+{
+    DefFormatTask<ItemType>& task = *(DefFormatTask<ItemType>*)arg;
+    ItemType item;
+    task.buffer.clear();
+    for (std::size_t i = task.begin; i < task.end; ++i)
+    {
+        task.source->get(i, item);
+        DefWriter::format(task.buffer, item);
+        item.reset();
+    }
+    return NULL;
+}
+
+DefWriter::DefWriter(std::size_t bufferSize)
+    : m_file(NULL)
+    , m_gzFile(NULL)
+    , m_capacity(std::max(bufferSize, (std::size_t)1024))
+    , m_numThreads(1)
+    , m_good(true)
+{
+    m_buffer.reserve(m_capacity+4096);
+}
+DefWriter::~DefWriter()
+{
+    close();
+}
+bool DefWriter::open(string const& filename)
+{
+    close();
+    m_good = true;
+#if ZLIB == 1
+    if (limbo::get_file_suffix(filename) == "gz")
+    {
+        gzFile f = gzopen(filename.c_str(), "wb");
+        if (f)
+            gzbuffer(f, m_capacity);
+        m_gzFile = f;
+    }
+    else
+#endif
+        m_file = std::fopen(filename.c_str(), "wb");
+    if (!m_file && !m_gzFile)
+    {
+        cout << "Unable to open output file " << filename << endl;
+        return false;
+    }
+    return true;
+}
+bool DefWriter::close()
+{
+    if (!m_file && !m_gzFile)
+        return m_good;
+    flush();
+    if (m_file)
+    {
+        m_good = (std::fclose(m_file) == 0) && m_good;
+        m_file = NULL;
+    }
+#if ZLIB == 1
+    if (m_gzFile)
+    {
+        m_good = (gzclose((gzFile)m_gzFile) == Z_OK) && m_good;
+        m_gzFile = NULL;
+    }
+#endif
+    return m_good;
+}
+void DefWriter::flush()
+{
+    write_bytes(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+}
+void DefWriter::write_bytes(const char* data, std::size_t size)
+{
+    if (size == 0)
+        return;
+    if (m_file)
+        m_good = (std::fwrite(data, 1, size, m_file) == size) && m_good;
+#if ZLIB == 1
+    else if (m_gzFile)
+    {
+        // gzwrite takes unsigned lengths
+        for (std::size_t i = 0; i < size; i += (1u<<30))
+        {
+            unsigned n = std::min(size-i, (std::size_t)(1u<<30));
+            m_good = (gzwrite((gzFile)m_gzFile, data+i, n) == (int)n) && m_good;
+        }
+    }
+#endif
+}
+
+void DefWriter::write_verbatim(const char* data, std::size_t size)
+{
+    if (size >= m_capacity)
+    {
+        flush();
+        write_bytes(data, size);
+    }
+    else 
+    {
+        m_buffer.append(data, size);
+        check_flush();
+    }
+}
+bool DefWriter::write_patched(const char* data, std::size_t size, vector<DefPlacementRange> const& vPlacement, 
+        DefComponentSource const& components)
+{
+    Component c;
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < vPlacement.size(); ++i)
+    {
+        DefPlacementRange const& range = vPlacement[i];
+        if (range.begin < offset || range.end < range.begin || range.end > size)
+        {
+            cout << "Invalid placement range of component " << i << endl;
+            return false;
+        }
+        write_verbatim(data+offset, range.begin-offset);
+        components.get(i, c);
+        if (!c.status.empty())
+        {
+            format_placement(m_buffer, c);
+            // inserted before ';' 
+            if (range.begin == range.end)
+                m_buffer += ' ';
+        }
+        c.reset();
+        offset = range.end;
+    }
+    write_verbatim(data+offset, size-offset);
+    flush();
+    return true;
+}
+
+void DefWriter::format(string& buffer, int v)
+{
+    char digits[16];
+    buffer.append(digits, limbo::to_chars(digits, digits+sizeof(digits), v).ptr);
+}
+void DefWriter::format_placement(string& buffer, Component const& c)
+{
+    buffer.append("+ ").append(c.status);
+    if (!c.orient.empty())
+    {
+        buffer.append(" ( ");
+        format(buffer, c.origin[0]);
+        buffer += ' ';
+        format(buffer, c.origin[1]);
+        buffer.append(" ) ").append(c.orient);
+    }
+}
+void DefWriter::format(string& buffer, Component const& c)
+{
+    buffer.append("   - ").append(c.comp_name).append(" ").append(c.macro_name);
+    if (!c.status.empty())
+    {
+        buffer += ' ';
+        format_placement(buffer, c);
+    }
+    buffer.append(" ;\n");
+}
+void DefWriter::format(string& buffer, Pin const& p)
+{
+    buffer.append("   - ").append(p.pin_name);
+    if (!p.net_name.empty())
+        buffer.append(" + NET ").append(p.net_name);
+    if (!p.direct.empty())
+        buffer.append(" + DIRECTION ").append(p.direct);
+    if (!p.status.empty())
+    {
+        buffer.append("\n      + ").append(p.status).append(" ( ");
+        format(buffer, p.origin[0]);
+        buffer += ' ';
+        format(buffer, p.origin[1]);
+        buffer.append(" ) ").append(p.orient);
+    }
+    if (!p.layer_name.empty())
+    {
+        buffer.append("\n      + LAYER ").append(p.layer_name).append(" ( ");
+        format(buffer, p.bbox[0]);
+        buffer += ' ';
+        format(buffer, p.bbox[1]);
+        buffer.append(" ) ( ");
+        format(buffer, p.bbox[2]);
+        buffer += ' ';
+        format(buffer, p.bbox[3]);
+        buffer.append(" )");
+    }
+    if (!p.use.empty())
+        buffer.append(" + USE ").append(p.use);
+    buffer.append(" ;\n");
+}
+void DefWriter::format(string& buffer, Net const& n)
+{
+    buffer.append("   - ").append(n.net_name);
+    for (std::size_t i = 0; i < n.vNetPin.size(); ++i)
+        buffer.append(" ( ").append(n.vNetPin[i].first).append(" ").append(n.vNetPin[i].second).append(" )");
+    buffer.append(" ;\n");
+}
+
+void DefWriter::write_version(string const& version)
+{
+    m_buffer.append("VERSION ").append(version).append(" ;\n");
+}
+void DefWriter::write_dividerchar(string const& c)
+{
+    m_buffer.append("DIVIDERCHAR \"").append(c).append("\" ;\n");
+}
+void DefWriter::write_busbitchars(string const& c)
+{
+    m_buffer.append("BUSBITCHARS \"").append(c).append("\" ;\n");
+}
+void DefWriter::write_design(string const& name)
+{
+    m_buffer.append("DESIGN ").append(name).append(" ;\n");
+}
+void DefWriter::write_unit(int unit)
+{
+    m_buffer.append("UNITS DISTANCE MICRONS ");
+    format(m_buffer, unit);
+    m_buffer.append(" ;\n\n");
+}
+void DefWriter::write_diearea(int xl, int yl, int xh, int yh)
+{
+    m_buffer.append("DIEAREA ( ");
+    format(m_buffer, xl);
+    m_buffer += ' ';
+    format(m_buffer, yl);
+    m_buffer.append(" ) ( ");
+    format(m_buffer, xh);
+    m_buffer += ' ';
+    format(m_buffer, yh);
+    m_buffer.append(" ) ;\n\n");
+}
+void DefWriter::write_row(Row const& row)
+{
+    m_buffer.append("ROW ").append(row.row_name).append(" ").append(row.macro_name).append(" ");
+    format(m_buffer, row.origin[0]);
+    m_buffer += ' ';
+    format(m_buffer, row.origin[1]);
+    m_buffer.append(" ").append(row.orient).append(" DO ");
+    format(m_buffer, row.repeat[0]);
+    m_buffer.append(" BY ");
+    format(m_buffer, row.repeat[1]);
+    m_buffer.append(" STEP ");
+    format(m_buffer, row.step[0]);
+    m_buffer += ' ';
+    format(m_buffer, row.step[1]);
+    m_buffer.append(" ;\n");
+    check_flush();
+}
+void DefWriter::write_end_design()
+{
+    m_buffer.append("END DESIGN\n");
+    flush();
+}
+void DefWriter::begin_components(std::size_t n)
+{
+    m_buffer.append("\nCOMPONENTS ");
+    format(m_buffer, (int)n);
+    m_buffer.append(" ;\n");
+}
+void DefWriter::end_components()
+{
+    m_buffer.append("END COMPONENTS\n\n");
+}
+void DefWriter::begin_pins(std::size_t n)
+{
+    m_buffer.append("PINS ");
+    format(m_buffer, (int)n);
+    m_buffer.append(" ;\n");
+}
+void DefWriter::end_pins()
+{
+    m_buffer.append("END PINS\n\n");
+}
+void DefWriter::begin_nets(std::size_t n)
+{
+    m_buffer.append("NETS ");
+    format(m_buffer, (int)n);
+    m_buffer.append(" ;\n");
+}
+void DefWriter::end_nets()
+{
+    m_buffer.append("END NETS\n\n");
+}
+
+template <typename ItemType>
+void DefWriter::write_items(std::size_t n, DefItemSource<ItemType> const& source)
+{
+    // each thread formats a block per round, blocks are large enough to hide thread creation
+    std::size_t blockSize = 65536;
+    std::size_t numThreads = std::min((std::size_t)m_numThreads, (n+blockSize-1)/blockSize);
+    if (numThreads <= 1)
+    {
+        ItemType item;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            source.get(i, item);
+            format(m_buffer, item);
+            item.reset();
+            check_flush();
+        }
+        return;
+    }
+
+    vector<DefFormatTask<ItemType> > vTask (numThreads);
+    vector<pthread_t> vThread (numThreads);
+    vector<char> vCreated (numThreads, false);
+    for (std::size_t first = 0; first < n; first += blockSize*numThreads)
+    {
+        for (std::size_t i = 0; i < numThreads; ++i)
+        {
+            vTask[i].source = &source;
+            vTask[i].begin = std::min(first+blockSize*i, n);
+            vTask[i].end = std::min(first+blockSize*(i+1), n);
+        }
+        for (std::size_t i = 1; i < numThreads; ++i)
+            vCreated[i] = (pthread_create(&vThread[i], NULL, def_format_task<ItemType>, &vTask[i]) == 0);
+        def_format_task<ItemType>(&vTask[0]);
+        for (std::size_t i = 1; i < numThreads; ++i)
+        {
+            if (vCreated[i])
+                pthread_join(vThread[i], NULL);
+            else // format blocks left by threads failed to create
+                def_format_task<ItemType>(&vTask[i]);
+        }
+        // keep the order of items
+        flush();
+        for (std::size_t i = 0; i < numThreads; ++i)
+            write_bytes(vTask[i].buffer.data(), vTask[i].buffer.size());
+    }
+}
+void DefWriter::write_components(std::size_t n, DefComponentSource const& source)
+{
+    begin_components(n);
+    write_items(n, source);
+    end_components();
+}
+void DefWriter::write_pins(std::size_t n, DefPinSource const& source)
+{
+    begin_pins(n);
+    write_items(n, source);
+    end_pins();
+}
+void DefWriter::write_nets(std::size_t n, DefNetSource const& source)
+{
+    begin_nets(n);
+    write_items(n, source);
+    end_nets();
+}
+
+bool write(string const& filename, string const& design, int unit, int const* dieArea, vector<Row> const& vRow,
+		std::size_t numComponents, DefComponentSource const& components,
+		std::size_t numPins, DefPinSource const& pins,
+		std::size_t numNets, DefNetSource const& nets, int numThreads)
+{
+    DefWriter writer;
+    if (!writer.open(filename))
+        return false;
+    writer.set_num_threads(numThreads);
+    writer.write_version("5.8");
+    writer.write_dividerchar("/");
+    writer.write_busbitchars("[]");
+    writer.write_design(design);
+    writer.write_unit(unit);
+    writer.write_diearea(dieArea[0], dieArea[1], dieArea[2], dieArea[3]);
+    for (std::size_t i = 0; i < vRow.size(); ++i)
+        writer.write_row(vRow[i]);
+    writer.write_components(numComponents, components);
+    writer.write_pins(numPins, pins);
+    writer.write_nets(numNets, nets);
+    writer.write_end_design();
+    return writer.close();
+}
+
+bool patch_placements(string const& inputFile, string const& outputFile, 
+        vector<DefPlacementRange> const& vPlacement, DefComponentSource const& components)
+{
+    DefFileMapping mapping;
+    if (!mapping.open(inputFile.c_str()))
+    {
+        cout << "Unable to map input file " << inputFile << endl;
+        return false;
+    }
+    DefWriter writer;
+    if (!writer.open(outputFile))
+        return false;
+    bool result = writer.write_patched(mapping.data(), mapping.size(), vPlacement, components);
+    return writer.close() && result;
+}
+
+} // namespace DefParser
@@ -0,0 +1,212 @@
+/**
+ * @file   DefWriter.h
+ * @brief  Streaming writer of DEF files, see @ref DefParser::DefWriter
+ * @date   Oct 2026
+ */
+
+#ifndef DEFPARSER_WRITER_H
+#define DEFPARSER_WRITER_H
+
+#include <cstdio>
+#include <algorithm>
+#include "DefDataBase.h"
+
+/// @brief namespace for DefParser
+namespace DefParser {
+
+/// @class DefParser::DefItemSource
+/// @brief callback-style iterator over items to write, e.g., components of a placement database.
+/// @ref DefParser::DefItemSource::get may be called concurrently from multiple threads
+/// with different indices and different target objects.
+/// @tparam ItemType @ref DefParser::Component, @ref DefParser::Pin or @ref DefParser::Net
+template <typename ItemType>
+class DefItemSource
+{
+	public:
+        /// @brief destructor
+		virtual ~DefItemSource() {}
+        /// @brief fill an item
+        /// @param i index of the item
+        /// @param item target object, which is reused, so all fields to write should be set
+		virtual void get(std::size_t i, ItemType& item) const = 0;
+};
+
+/// @nowarn
+typedef DefItemSource<Component> DefComponentSource;
+typedef DefItemSource<Pin> DefPinSource;
+typedef DefItemSource<Net> DefNetSource;
+/// @endnowarn
+
+/// @class DefParser::DefWriter
+/// @brief write DEF files in the syntax read by @ref DefParser::Driver.
+/// Records are formatted into large buffers without iostreams and written with fwrite,
+/// or gzwrite for .gz files if compiled with ZLIB.
+/// Sections written from @ref DefParser::DefItemSource are formatted by multiple threads in blocks,
+/// which are written in the order of items.
+class DefWriter
+{
+	public:
+        /// @brief constructor
+        /// @param bufferSize number of bytes buffered before writing to the file
+		DefWriter(std::size_t bufferSize = 1024*1024);
+        /// @brief destructor, close the file
+		~DefWriter();
+
+        /// @brief open a file, compressed with gzip if the suffix is .gz
+        /// @param filename output file
+        /// @return true if succeed
+		bool open(string const& filename);
+        /// @brief flush the buffer and close the file
+        /// @return true if all bytes have been written
+		bool close();
+        /// @brief set number of threads to format sections
+        /// @param numThreads number of threads
+		void set_num_threads(int numThreads) {m_numThreads = std::max(numThreads, 1);}
+
+        /// @name header statements
+        ///@{
+        /// @brief VERSION statement
+		void write_version(string const& version);
+        /// @brief DIVIDERCHAR statement
+		void write_dividerchar(string const& c);
+        /// @brief BUSBITCHARS statement
+		void write_busbitchars(string const& c);
+        /// @brief DESIGN statement
+		void write_design(string const& name);
+        /// @brief UNITS DISTANCE MICRONS statement
+		void write_unit(int unit);
+        /// @brief DIEAREA statement
+		void write_diearea(int xl, int yl, int xh, int yh);
+        /// @brief ROW statement
+		void write_row(Row const& row);
+        /// @brief END DESIGN statement
+		void write_end_design();
+        ///@}
+
+        /// @name sections from callback-style iterators, with threads
+        ///@{
+        /// @brief COMPONENTS section
+        /// @param n number of components
+        /// @param source components
+		void write_components(std::size_t n, DefComponentSource const& source);
+        /// @brief PINS section
+        /// @param n number of pins
+        /// @param source pins
+		void write_pins(std::size_t n, DefPinSource const& source);
+        /// @brief NETS section
+        /// @param n number of nets
+        /// @param source nets
+		void write_nets(std::size_t n, DefNetSource const& source);
+        ///@}
+
+        /// @name sections record by record
+        ///@{
+        /// @brief begin COMPONENTS section
+		void begin_components(std::size_t n);
+        /// @brief write a component
+		void write_component(Component const& c) {format(m_buffer, c); check_flush();}
+        /// @brief end COMPONENTS section
+		void end_components();
+        /// @brief begin PINS section
+		void begin_pins(std::size_t n);
+        /// @brief write a pin
+		void write_pin(Pin const& p) {format(m_buffer, p); check_flush();}
+        /// @brief end PINS section
+		void end_pins();
+        /// @brief begin NETS section
+		void begin_nets(std::size_t n);
+        /// @brief write a net
+		void write_net(Net const& n) {format(m_buffer, n); check_flush();}
+        /// @brief end NETS section
+		void end_nets();
+        ///@}
+
+        /// @brief copy a DEF file with placements of components replaced, 
+        /// other characters are written verbatim 
+        /// @param data first character of the original file 
+        /// @param size number of characters 
+        /// @param vPlacement byte ranges of placements recorded by @ref DefParser::read 
+        /// @param components status, origins and orientations of components in the order of ranges, 
+        /// components with empty status lose their placements 
+        /// @return true if ranges are valid 
+		bool write_patched(const char* data, std::size_t size, vector<DefPlacementRange> const& vPlacement, 
+				DefComponentSource const& components);
+
+        /// @name format records
+        ///@{
+        /// @brief append a component record
+		static void format(string& buffer, Component const& c);
+        /// @brief append the placement of a component, "+ STATUS ( x y ) ORIENT" or "+ STATUS" without orientation
+		static void format_placement(string& buffer, Component const& c);
+        /// @brief append a pin record
+		static void format(string& buffer, Pin const& p);
+        /// @brief append a net record
+		static void format(string& buffer, Net const& n);
+        /// @brief append an integer
+		static void format(string& buffer, int v);
+        ///@}
+
+	protected:
+        /// @brief disabled copy
+		DefWriter(DefWriter const&);
+        /// @brief disabled assignment
+		DefWriter& operator=(DefWriter const&);
+
+        /// @brief format items with threads and write them in order
+        /// @param n number of items
+        /// @param source items
+		template <typename ItemType>
+		void write_items(std::size_t n, DefItemSource<ItemType> const& source);
+        /// @brief write the buffer to the file if full
+		void check_flush() {if (m_buffer.size() >= m_capacity) flush();}
+        /// @brief write the buffer to the file
+		void flush();
+        /// @brief write bytes through the buffer, large blocks are written directly 
+        /// @param data first byte
+        /// @param size number of bytes
+		void write_verbatim(const char* data, std::size_t size);
+        /// @brief write bytes to the file
+        /// @param data first byte
+        /// @param size number of bytes
+		void write_bytes(const char* data, std::size_t size);
+
+		std::FILE* m_file; ///< uncompressed output
+		void* m_gzFile; ///< compressed output, gzFile
+		string m_buffer; ///< bytes to write
+		std::size_t m_capacity; ///< size of the buffer to flush
+		int m_numThreads; ///< number of threads
+		bool m_good; ///< false if failed to write
+};
+
+/// @brief write a whole DEF file
+/// @param filename output file, compressed with gzip if the suffix is .gz
+/// @param design design name
+/// @param unit DEF unit
+/// @param dieArea xl, yl, xh, yh of die area
+/// @param vRow rows
+/// @param numComponents number of components
+/// @param components components
+/// @param numPins number of pins
+/// @param pins pins
+/// @param numNets number of nets
+/// @param nets nets
+/// @param numThreads number of threads
+/// @return true if succeed
+bool write(string const& filename, string const& design, int unit, int const* dieArea, vector<Row> const& vRow,
+		std::size_t numComponents, DefComponentSource const& components,
+		std::size_t numPins, DefPinSource const& pins,
+		std::size_t numNets, DefNetSource const& nets, int numThreads = 1);
+
+/// @brief write a DEF file with new placements of components, e.g., after legalization, 
+/// by copying everything else from the original file 
+/// @param inputFile original DEF file, which must be a regular file 
+/// @param outputFile output file, compressed with gzip if the suffix is .gz
+/// @param vPlacement byte ranges of placements recorded by @ref DefParser::read on the original file 
+/// @param components new placements in the order of components 
+/// @return true if succeed
+bool patch_placements(string const& inputFile, string const& outputFile, 
+		vector<DefPlacementRange> const& vPlacement, DefComponentSource const& components);
+
+} // namespace DefParser
+
+#endif
@@ -7,18 +7,24 @@
 
 #include "EbeamDriver.h"
 #include "EbeamScanner.h"
+#include <limbo/parsers/common/PrefetchInputStream.h>
+#if ZLIB == 1
+#include <limbo/parsers/common/GzipInputStream.h>
+#endif
 
 namespace EbeamParser {
 
 Driver::Driver(EbeamDataBase& db)
     : trace_scanning(false),
       trace_parsing(false),
+      profile("EbeamParser"),
       m_db(db)
 {
 }
 
 bool Driver::parse_stream(std::istream& in, const std::string& sname)
 {
+    limboParserParse(profile);
     streamname = sname;
 
     Scanner scanner(&in);
@@ -32,7 +38,15 @@ bool Driver::parse_stream(std::istream& in, const std::string& sname)
 
 bool Driver::parse_file(const std::string &filename)
 {
-    std::ifstream in(filename.c_str());
+#if ZLIB == 1
+    if (limbo::is_gzip_file(filename)) // inflated by a helper thread 
+    {
+        limbo::GzipInputStream in (filename);
+        if (!in.good()) return false;
+        return parse_stream(in, filename);
+    }
+#endif
+    limbo::PrefetchInputStream in (filename); // read ahead by a helper thread 
     if (!in.good()) return false;
     return parse_stream(in, filename);
 }
@@ -59,6 +73,7 @@ void Driver::units_cbk(int d1)
 {
 	//std::cerr << __func__ << std::endl;
 	// call db
+	limboParserCallback(profile);
 	m_db.set_ebeam_unit(d1);
 #ifdef DEBUG_EBEAMPARSER
 	std::cerr << "ebeam unit = " << d1 << std::endl;
@@ -68,6 +83,8 @@ void Driver::ebeam_cbk()
 {
 	//std::cerr << __func__ << std::endl;
 	// call db
+	limboParserRecord(profile, "EBEAMBOUNDARY");
+	limboParserCallback(profile);
 	m_db.set_ebeam_boundary(m_ebeam_boundary);
 #ifdef DEBUG_EBEAMPARSER
 	std::cerr << m_ebeam_boundary << std::endl;
@@ -105,6 +122,8 @@ void Driver::macro_cbk(string const& s1)
 	//std::cerr << __func__ << std::endl;
 	assert(m_macro.macro_name == s1);
 	// call db 
+	limboParserRecord(profile, "MACRO");
+	limboParserCallback(profile);
 	m_db.add_ebeam_macro(m_macro);
 #ifdef DEBUG_EBEAMPARSER
 	std::cerr << m_macro << std::endl;
@@ -9,6 +9,7 @@
 #define EBEAMPARSER_DRIVER_H
 
 #include "EbeamDataBase.h"
+#include <limbo/parsers/common/ParserProfile.h>
 
 /** The example namespace is used to encapsulate the three parser classes
  * example::Parser, example::Scanner and example::Driver */
@@ -87,6 +88,11 @@ public:
      * parser to the scanner. It is used in the yylex macro. */
     class Scanner* lexer;
 
+    /** Counters and timers of the scanner, grammar actions and database
+     * callbacks, compiled out unless LIMBO_INSTRUMENT is defined. It is used
+     * in the yylex macro. */
+    limbo::ParserProfile profile;
+
     /// @cond 
 	void units_cbk(int d1);
 	void ebeam_cbk();
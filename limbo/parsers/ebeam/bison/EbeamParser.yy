@@ -114,7 +114,7 @@
  * object. it defines the yylex() function call to pull the next token from the
  * current lexer object of the driver context. */
 #undef yylex
-#define yylex driver.lexer->lex
+#define yylex(yylval, yylloc) limboParserScan(driver.profile, driver.lexer->lex(yylval, yylloc))
 
 %}
 
@@ -4,6 +4,8 @@
 %{ /*** C/C++ Declarations ***/
 
 #include <string>
+#include <limbo/string/CharConv.h>
+#include <limbo/parsers/common/ParserProfile.h>
 
 #include "EbeamScanner.h"
 
@@ -48,6 +50,15 @@ typedef EbeamParser::Parser::token_type token_type;
 #define YY_USER_ACTION  yylloc->columns(yyleng);
 %}
 
+/* Read input as flex does by default, and count the bytes in the profile of
+ * the driver if compiled with LIMBO_INSTRUMENT. */
+%{
+#define YY_INPUT(buf, result, max_size) \
+    if ((int)(result = LexerInput((char*)buf, max_size)) < 0) \
+        YY_FATAL_ERROR("input in flex scanner failed"); \
+    limboParserBytes(result);
+%}
+
 %% /*** Regular Expressions Part ***/
 
  /* code to place at the beginning of yylex() */
@@ -105,12 +116,12 @@ typedef EbeamParser::Parser::token_type token_type;
 }
 
 [\+\-]?[0-9]+ {
-    yylval->integerVal = atoi(yytext);
+    limbo::from_chars(yytext, yytext+yyleng, yylval->integerVal);
     return token::INTEGER;
 }
 
 [\+\-]?[0-9]+"."[0-9]* {
-    yylval->doubleVal = atof(yytext);
+    limbo::from_chars(yytext, yytext+yyleng, yylval->doubleVal);
     return token::DOUBLE;
 }
 
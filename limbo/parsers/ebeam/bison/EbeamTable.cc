@@ -0,0 +1,132 @@
+/**
+ * @file   EbeamTable.cc
+ * @brief  Implementation of @ref EbeamParser::EbeamConflictTable
+ * @date   Oct 2026
+ */
+
+#include <algorithm>
+#include "EbeamTable.h"
+#include "EbeamDriver.h"
+
+namespace EbeamParser {
+
+void EbeamConflictTable::clear()
+{
+    unit = 0;
+    boundary.reset();
+    vMacroName.clear();
+    vMacroRegionBegin.assign(1, 0);
+    vLayerFileId.clear();
+    vLayerName.clear();
+    vRegionNameTable.clear();
+    vRegionMacro.clear();
+    vRegionLayer.clear();
+    vRegionName.clear();
+    vRegionRangeBegin.assign(1, 0);
+    vRange.clear();
+    m_mMacroName2Id.clear();
+    m_mLayer2Id.clear();
+    m_mRegionName2Id.clear();
+}
+
+void EbeamConflictTable::add_macro(Macro const& macro)
+{
+    uint32_t macroId = vMacroName.size();
+    vMacroName.push_back(macro.macro_name);
+    m_mMacroName2Id.insert(make_pair(macro.macro_name, (int32_t)macroId));
+
+    for (vector<ConfSite>::const_iterator it = macro.vConfSite.begin(); it != macro.vConfSite.end(); ++it)
+    {
+        vRegionMacro.push_back(macroId);
+        vRegionLayer.push_back(intern_layer(it->layer.empty()? it->layer_id : -1, it->layer));
+        vRegionName.push_back(intern_region_name(it->confsite_name));
+
+        // sort and merge sites into ranges
+        m_vSite.assign(it->vSiteCnt.begin(), it->vSiteCnt.end());
+        std::sort(m_vSite.begin(), m_vSite.end());
+        for (vector<int32_t>::const_iterator its = m_vSite.begin(); its != m_vSite.end(); ++its)
+        {
+            if (vRange.size() > vRegionRangeBegin.back() && *its <= vRange.back().hi+1)
+                vRange.back().hi = std::max(vRange.back().hi, *its);
+            else
+            {
+                EbeamSiteRange range;
+                range.lo = range.hi = *its;
+                vRange.push_back(range);
+            }
+        }
+        vRegionRangeBegin.push_back(vRange.size());
+    }
+    vMacroRegionBegin.push_back(vRegionMacro.size());
+}
+
+int32_t EbeamConflictTable::macro_id(string const& name) const
+{
+    std::map<string, int32_t>::const_iterator found = m_mMacroName2Id.find(name);
+    return (found == m_mMacroName2Id.end())? -1 : found->second;
+}
+
+int32_t EbeamConflictTable::layer_id(int32_t fileId) const
+{
+    std::map<pair<int32_t, string>, uint32_t>::const_iterator found = m_mLayer2Id.find(make_pair(fileId, string()));
+    return (found == m_mLayer2Id.end())? -1 : (int32_t)found->second;
+}
+
+int32_t EbeamConflictTable::layer_id(string const& name) const
+{
+    std::map<pair<int32_t, string>, uint32_t>::const_iterator found = m_mLayer2Id.find(make_pair(-1, name));
+    return (found == m_mLayer2Id.end())? -1 : (int32_t)found->second;
+}
+
+bool EbeamConflictTable::conflict(uint32_t macro, uint32_t layer, int32_t site) const
+{
+    for (uint32_t r = vMacroRegionBegin[macro]; r < vMacroRegionBegin[macro+1]; ++r)
+    {
+        if (vRegionLayer[r] != layer)
+            continue;
+        // first range ending at or after the site
+        vector<EbeamSiteRange>::const_iterator first = vRange.begin()+vRegionRangeBegin[r];
+        vector<EbeamSiteRange>::const_iterator last = vRange.begin()+vRegionRangeBegin[r+1];
+        while (first != last)
+        {
+            vector<EbeamSiteRange>::const_iterator mid = first+(last-first)/2;
+            if (mid->hi < site)
+                first = mid+1;
+            else
+                last = mid;
+        }
+        if (first != vRange.begin()+vRegionRangeBegin[r+1] && first->lo <= site)
+            return true;
+    }
+    return false;
+}
+
+uint32_t EbeamConflictTable::intern_layer(int32_t fileId, string const& name)
+{
+    std::pair<std::map<pair<int32_t, string>, uint32_t>::iterator, bool> found =
+        m_mLayer2Id.insert(make_pair(make_pair(fileId, name), (uint32_t)vLayerFileId.size()));
+    if (found.second)
+    {
+        vLayerFileId.push_back(fileId);
+        vLayerName.push_back(name);
+    }
+    return found.first->second;
+}
+
+uint32_t EbeamConflictTable::intern_region_name(string const& name)
+{
+    std::pair<std::map<string, uint32_t>::iterator, bool> found =
+        m_mRegionName2Id.insert(make_pair(name, (uint32_t)vRegionNameTable.size()));
+    if (found.second)
+        vRegionNameTable.push_back(name);
+    return found.first->second;
+}
+
+bool read(EbeamConflictTable& table, const string& ebeamFile)
+{
+    table.clear();
+    EbeamTableDataBase db (table);
+    return read(db, ebeamFile);
+}
+
+} // namespace EbeamParser
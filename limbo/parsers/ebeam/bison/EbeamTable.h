@@ -0,0 +1,122 @@
+/**
+ * @file   EbeamTable.h
+ * @brief  conflict sites of all ebeam macros packed into flat arrays, see @ref EbeamParser::EbeamConflictTable
+ * @date   Oct 2026
+ */
+
+#ifndef EBEAMPARSER_TABLE_H
+#define EBEAMPARSER_TABLE_H
+
+#include <map>
+#include <limbo/parsers/ebeam/bison/EbeamDataBase.h>
+
+/// namespace for EbeamParser
+namespace EbeamParser {
+
+/// @brief consecutive conflicted sites from lo to hi, both inclusive
+struct EbeamSiteRange
+{
+    int32_t lo; ///< first site
+    int32_t hi; ///< last site
+};
+
+/// @brief conflict sites of all macros in structure-of-arrays form.
+///
+/// Macros, layers and conflict site names are interned to dense ids in the order they are seen.
+/// Each CONFLICTSITE statement becomes a region:
+/// regions of macro m are vMacroRegionBegin[m] to vMacroRegionBegin[m+1]-1,
+/// and the site ranges of region r are vRange[vRegionRangeBegin[r]] to vRange[vRegionRangeBegin[r+1]-1],
+/// sorted and merged from the SITE list.
+/// A layer is identified by its LAYERID, or by its name for LAYER statements.
+class EbeamConflictTable
+{
+	public:
+        /// @brief constructor
+        EbeamConflictTable() {clear();}
+
+        int32_t unit; ///< database units per micron
+        EbeamBoundary boundary; ///< ebeam boundary
+
+        vector<string> vMacroName; ///< macro names indexed by macro ids
+        vector<uint32_t> vMacroRegionBegin; ///< offset of the regions of each macro, with one more entry for the end
+
+        vector<int32_t> vLayerFileId; ///< LAYERID of each layer, -1 if given by name
+        vector<string> vLayerName; ///< name of each layer, empty if given by LAYERID
+        vector<string> vRegionNameTable; ///< interned names of conflict sites
+
+        vector<uint32_t> vRegionMacro; ///< macro id of each region
+        vector<uint32_t> vRegionLayer; ///< layer id of each region
+        vector<uint32_t> vRegionName; ///< index to vRegionNameTable of each region
+        vector<uint32_t> vRegionRangeBegin; ///< offset of the site ranges of each region, with one more entry for the end
+        vector<EbeamSiteRange> vRange; ///< site ranges of all regions
+
+        /// @return number of macros
+        uint32_t num_macros() const {return vMacroName.size();}
+        /// @return number of layers
+        uint32_t num_layers() const {return vLayerFileId.size();}
+        /// @return number of regions
+        uint32_t num_regions() const {return vRegionMacro.size();}
+
+        /// @brief remove all data
+        void clear();
+        /// @brief append a macro and its regions
+        /// @param macro macro from the parser
+        void add_macro(Macro const& macro);
+
+        /// @param name macro name
+        /// @return macro id, or -1 if not found; the first one if the name is repeated
+        int32_t macro_id(string const& name) const;
+        /// @param fileId LAYERID in the file
+        /// @return layer id, or -1 if not found
+        int32_t layer_id(int32_t fileId) const;
+        /// @param name layer name of LAYER statements
+        /// @return layer id, or -1 if not found
+        int32_t layer_id(string const& name) const;
+
+        /// @brief check whether a site of a macro conflicts on a layer
+        /// @param macro macro id
+        /// @param layer layer id
+        /// @param site site index
+        /// @return true if some region of the macro on the layer contains the site
+        bool conflict(uint32_t macro, uint32_t layer, int32_t site) const;
+
+	protected:
+        /// @brief find or add a layer
+        uint32_t intern_layer(int32_t fileId, string const& name);
+        /// @brief find or add a conflict site name
+        uint32_t intern_region_name(string const& name);
+
+        std::map<string, int32_t> m_mMacroName2Id; ///< map from macro names to ids
+        std::map<pair<int32_t, string>, uint32_t> m_mLayer2Id; ///< map from LAYERID and name to layer ids
+        std::map<string, uint32_t> m_mRegionName2Id; ///< map from conflict site names to indices
+        vector<int32_t> m_vSite; ///< temporary storage of sorted sites
+};
+
+/// @brief database filling an @ref EbeamParser::EbeamConflictTable,
+/// used by @ref EbeamParser::read(EbeamConflictTable&, string const&)
+class EbeamTableDataBase : public EbeamDataBase
+{
+	public:
+        /// @brief constructor
+        /// @param table table to fill
+        EbeamTableDataBase(EbeamConflictTable& table) : m_table(table) {}
+        /// @nowarn
+		virtual void set_ebeam_unit(int unit) {m_table.unit = unit;}
+		virtual void set_ebeam_boundary(EbeamBoundary const& boundary) {m_table.boundary = boundary;}
+		virtual void add_ebeam_macro(Macro const& macro) {m_table.add_macro(macro);}
+        /// @endnowarn
+
+	protected:
+        EbeamConflictTable& m_table; ///< table to fill
+};
+
+/// @brief API for EbeamParser.
+/// Read Ebeam file into flat arrays without user-defined callbacks.
+/// @param table conflict sites of all macros, old contents are removed
+/// @param ebeamFile Ebeam file
+/// @return true if succeed
+bool read(EbeamConflictTable& table, const string& ebeamFile);
+
+} // namespace EbeamParser
+
+#endif
@@ -461,6 +461,39 @@ class GdfDataBase
         virtual void add_gdf_cell(Cell&) = 0;
 };
 
+/// @class GdfParser::GdfStreamDataBase
+/// @brief Base class for gdf database receiving the contents of a cell one by one. 
+/// @ref GdfParser::Driver detects this type and calls the callbacks below while parsing, 
+/// instead of collecting the whole cell for @ref GdfParser::GdfDataBase::add_gdf_cell. 
+/// Only one port, instance, text, path or net is kept by the driver at a time, 
+/// so the memory of a large cell is not held twice. 
+/// Paths and nets are passed once their last object or port is read. 
+/// It is safe to directly swap the contents of the arguments for efficiency. 
+class GdfStreamDataBase : public GdfDataBase
+{
+	public:
+        /// @brief begin a cell, called before any of its contents 
+        virtual void begin_gdf_cell(std::string const&) = 0;
+        /// @brief add cell port 
+        virtual void add_gdf_port(CellPort&) = 0;
+        /// @brief add cell instance 
+        virtual void add_gdf_instance(CellInstance&) = 0;
+        /// @brief add text 
+        virtual void add_gdf_text(Text&) = 0;
+        /// @brief add routing path with all its objects 
+        virtual void add_gdf_path(Path&) = 0;
+        /// @brief add net with all its ports 
+        virtual void add_gdf_net(Net&) = 0;
+        /// @brief end a cell, called after all of its contents 
+        virtual void end_gdf_cell(std::string const&) = 0;
+
+        /// @brief callback with the whole cell, never called for this type 
+        virtual void add_gdf_cell(Cell&)
+        {
+            cerr << "GdfStreamDataBase::" << __func__ << " should not be called" << endl;
+        }
+};
+
 } // namespace GdfParser
 
 #endif
@@ -8,18 +8,25 @@
 #include "GdfDriver.h"
 #include "GdfScanner.h"
 #include <limbo/string/String.h>
+#include <limbo/parsers/common/PrefetchInputStream.h>
+#if ZLIB == 1
+#include <limbo/parsers/common/GzipInputStream.h>
+#endif
 
 namespace GdfParser {
 
 Driver::Driver(GdfDataBase& db)
     : trace_scanning(false),
       trace_parsing(false),
-      m_db(db)
+      profile("GdfParser"),
+      m_db(db),
+      m_streamDb(dynamic_cast<GdfStreamDataBase*>(&db))
 {
 }
 
 bool Driver::parse_stream(std::istream& in, const std::string& sname)
 {
+    limboParserParse(profile);
     streamname = sname;
 
     Scanner scanner(&in);
@@ -33,7 +40,15 @@ bool Driver::parse_stream(std::istream& in, const std::string& sname)
 
 bool Driver::parse_file(const std::string &filename)
 {
-    std::ifstream in(filename.c_str());
+#if ZLIB == 1
+    if (limbo::is_gzip_file(filename)) // inflated by a helper thread 
+    {
+        limbo::GzipInputStream in (filename);
+        if (!in.good()) return false;
+        return parse_stream(in, filename);
+    }
+#endif
+    limbo::PrefetchInputStream in (filename); // read ahead by a helper thread 
     if (!in.good()) return false;
     return parse_stream(in, filename);
 }
@@ -57,38 +72,59 @@ void Driver::error(const std::string& m)
 
 void Driver::cellPortCbk(std::string& name, CellPort::PortTypeEnum type, std::string& layer, double x, double y) 
 {
-    m_cell.vCellPort.push_back(CellPort());
-    CellPort& cp = m_cell.vCellPort.back();
+    limboParserRecord(profile, "port");
+    if (!m_streamDb)
+        m_cell.vCellPort.push_back(CellPort());
+    CellPort& cp = m_streamDb? m_port : m_cell.vCellPort.back();
     cp.name.swap(name);
     cp.portType = type;
     cp.layer.swap(layer);
     cp.point.x = x;
     cp.point.y = y;
+    if (m_streamDb)
+    {
+        limboParserCallback(profile);
+        m_streamDb->add_gdf_port(cp);
+    }
 }
 
 void Driver::cellInstanceCbk(std::string& name, std::string& cellType, double x, double y, int32_t orient) 
 {
-    m_cell.vCellInstance.push_back(CellInstance());
-    CellInstance& ci = m_cell.vCellInstance.back();
+    limboParserRecord(profile, "instance");
+    if (!m_streamDb)
+        m_cell.vCellInstance.push_back(CellInstance());
+    CellInstance& ci = m_streamDb? m_instance : m_cell.vCellInstance.back();
     ci.name.swap(name);
     ci.cellType.swap(cellType);
     ci.position.x = x;
     ci.position.y = y;
     ci.orient = orient; 
+    if (m_streamDb)
+    {
+        limboParserCallback(profile);
+        m_streamDb->add_gdf_instance(ci);
+    }
 }
 
 void Driver::textCbk(Text::TextTypeEnum textType, std::string const& name, std::string& content) 
 {
-    m_cell.vText.push_back(Text());
-    Text& t = m_cell.vText.back();
+    limboParserRecord(profile, "text");
+    if (!m_streamDb)
+        m_cell.vText.push_back(Text());
+    Text& t = m_streamDb? m_text : m_cell.vText.back();
     t.textType = textType;
     t.name = name;
     t.content.swap(content);
+    if (m_streamDb)
+    {
+        limboParserCallback(profile);
+        m_streamDb->add_gdf_text(t);
+    }
 }
 
 void Driver::pathObjCbk(PathObj::PathObjTypeEnum pathObjType, std::string const& name, std::string& layer, double width, double xl, double yl, double xh, double yh)
 {
-    Path& p = m_cell.vPath.back();
+    Path& p = m_streamDb? m_path : m_cell.vPath.back();
     p.vPathObj.push_back(PathObj());
     PathObj& po = p.vPathObj.back();
     po.pathObjType = pathObjType;
@@ -103,14 +139,27 @@ void Driver::pathObjCbk(PathObj::PathObjTypeEnum pathObjType, std::string const&
 
 void Driver::pathCbk(std::string& name) 
 {
-    m_cell.vPath.push_back(Path());
-    Path& p = m_cell.vPath.back();
+    limboParserRecord(profile, "path");
+    if (m_streamDb)
+        m_path.reset();
+    else 
+        m_cell.vPath.push_back(Path());
+    Path& p = m_streamDb? m_path : m_cell.vPath.back();
     p.name.swap(name);
 }
 
+void Driver::pathEndCbk()
+{
+    if (m_streamDb)
+    {
+        limboParserCallback(profile);
+        m_streamDb->add_gdf_path(m_path);
+    }
+}
+
 void Driver::netPortCbk(std::string& name, std::string& instName)
 {
-    Net& net = m_cell.vNet.back();
+    Net& net = m_streamDb? m_net : m_cell.vNet.back();
     net.vNetPort.push_back(NetPort());
     NetPort& np = net.vNetPort.back();
     np.name.swap(name);
@@ -119,7 +168,7 @@ void Driver::netPortCbk(std::string& name, std::string& instName)
 
 void Driver::netPortCbk(std::string& name)
 {
-    Net& net = m_cell.vNet.back();
+    Net& net = m_streamDb? m_net : m_cell.vNet.back();
     net.vNetPort.push_back(NetPort());
     NetPort& np = net.vNetPort.back();
     np.name.swap(name);
@@ -128,15 +177,47 @@ void Driver::netPortCbk(std::string& name)
 
 void Driver::netCbk(std::string& name) 
 {
-    m_cell.vNet.push_back(Net());
-    Net& net = m_cell.vNet.back();
+    limboParserRecord(profile, "net");
+    if (m_streamDb)
+        m_net.reset();
+    else 
+        m_cell.vNet.push_back(Net());
+    Net& net = m_streamDb? m_net : m_cell.vNet.back();
     net.name.swap(name);
 }
 
+void Driver::netEndCbk()
+{
+    if (m_streamDb)
+    {
+        limboParserCallback(profile);
+        m_streamDb->add_gdf_net(m_net);
+    }
+}
+
+void Driver::cellBeginCbk(std::string const& name)
+{
+    if (m_streamDb)
+    {
+        limboParserCallback(profile);
+        m_streamDb->begin_gdf_cell(name);
+    }
+}
+
 void Driver::cellCbk(std::string& name) 
 {
+    limboParserRecord(profile, "cell");
+    if (m_streamDb)
+    {
+        limboParserCallback(profile);
+        m_streamDb->end_gdf_cell(name);
+        return;
+    }
     m_cell.name.swap(name);
-    m_db.add_gdf_cell(m_cell);
+    {
+        limboParserCallback(profile);
+        m_db.add_gdf_cell(m_cell);
+    }
     m_cell.reset();
 }
 
@@ -9,6 +9,7 @@
 #define GDFPARSER_DRIVER_H
 
 #include "GdfDataBase.h"
+#include <limbo/parsers/common/ParserProfile.h>
 
 /** The example namespace is used to encapsulate the three parser classes
  * example::Parser, example::Scanner and example::Driver */
@@ -87,6 +88,11 @@ public:
      * parser to the scanner. It is used in the yylex macro. */
     class Scanner* lexer;
 
+    /** Counters and timers of the scanner, grammar actions and database
+     * callbacks, compiled out unless LIMBO_INSTRUMENT is defined. It is used
+     * in the yylex macro. */
+    limbo::ParserProfile profile;
+
     /** Reference to the database filled during parsing of the
      * expressions. */
     GdfDataBase& m_db;
@@ -102,6 +108,13 @@ public:
     void netCbk(std::string& name);
     /// @endcond 
 
+    /// cellBeginCbk is called before the contents of the cell, 
+    /// only forwarded to @ref GdfParser::GdfStreamDataBase 
+    void cellBeginCbk(std::string const& name);
+    /// pathEndCbk is called after all the objects of the path 
+    void pathEndCbk();
+    /// netEndCbk is called after all the ports of the net 
+    void netEndCbk();
     /// cellCbk is called after all the contents in the cell is initialized 
     /// this is different from some other callbacks 
     void cellCbk(std::string& name);
@@ -109,6 +122,16 @@ public:
 protected:
     /// @brief temporary storage of cell  
     Cell m_cell;
+    /// @brief streaming database, NULL if the database collects whole cells 
+    GdfStreamDataBase* m_streamDb;
+    /// @name temporary storage of the current item for @ref GdfParser::GdfStreamDataBase 
+    ///@{
+    CellPort m_port;
+    CellInstance m_instance;
+    Text m_text;
+    Path m_path;
+    Net m_net;
+    ///@}
 };
 
 /// @brief API for GdfParser. 
@@ -131,7 +131,7 @@
  * object. it defines the yylex() function call to pull the next token from the
  * current lexer object of the driver context. */
 #undef yylex
-#define yylex driver.lexer->lex
+#define yylex(yylval, yylloc) limboParserScan(driver.profile, driver.lexer->lex(yylval, yylloc))
 
 %}
 
@@ -255,7 +255,9 @@ path_entry : '(' KWD_PATH ':' STRING {
            driver.pathCbk(*$4);
            delete $4;
            } 
-           pathobj_entres ')' 
+           pathobj_entres ')' {
+           driver.pathEndCbk();
+           }
            ;
 
 net_port_entry : '(' KWD_PORTREF STRING '(' KWD_INSTREF STRING ')'  ')'/* connect to instance  */ {
@@ -275,7 +277,9 @@ net_port_entries : net_port_entry
 net_entry : '(' KWD_NET ':' STRING {
           driver.netCbk(*$4);
           delete $4;
-          } net_port_entries  ')'
+          } net_port_entries  ')' {
+          driver.netEndCbk();
+          }
           ; 
 
 gdif_version_entry  : '(' KWD_GDIFVERSION INTEGER INTEGER INTEGER ')'
@@ -292,7 +296,9 @@ cell_addons : cell_addon
             | cell_addons cell_addon 
             ;
 
-cell_entry : '(' KWD_CELL ':' STRING cell_addons ')' {
+cell_entry : '(' KWD_CELL ':' STRING {
+           driver.cellBeginCbk(*$4);
+           } cell_addons ')' {
            driver.cellCbk(*$4);
            delete $4;
            }
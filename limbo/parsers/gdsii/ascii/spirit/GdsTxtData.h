@@ -0,0 +1,103 @@
+/**
+ * @file   GdsTxtData.h
+ * @brief  data of ASCII GDSII files shared by @ref GdsTxtParser and @ref GdsTxtReader
+ * @date   Oct 2026
+ */
+
+#ifndef _GDSTXTDATA_H
+#define _GDSTXTDATA_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+
+using std::vector;
+using std::string;
+using std::ostringstream;
+using boost::int32_t;
+using boost::array;
+
+// user can pass an object which contains the following member functions as callbacks 
+// add_gds_lib(GdsTxtData::GdsLib const&)
+struct GdsTxtData
+{
+	struct GdsItem 
+	{
+		virtual void print(ostringstream& ss) const {};
+		friend std::ostream& operator<<(std::ostream& os, GdsItem const& rhs)
+		{
+			std::ostringstream ss;
+			rhs.print(ss);
+			os << ss.str();
+			return os;
+		}
+		friend ostringstream& operator<<(ostringstream& ss, GdsItem const& rhs)
+		{
+			rhs.print(ss);
+			return ss;
+		}
+	};
+	struct GdsBoundary 
+	{
+		int32_t layer;
+		int32_t datatype;
+		vector<array<int32_t, 2> > vPoint;
+		void reset()
+		{
+			layer = -1;
+			datatype = -1;
+			vPoint.clear();
+		}
+	};
+	struct GdsText 
+	{
+		int32_t layer;
+		int32_t texttype;
+		int32_t presentation;
+		int32_t strans;
+		double mag;
+		array<int32_t, 2> position;
+		string content;
+		void reset()
+		{
+			layer = texttype = presentation = strans = 0;
+			mag = 0;
+			position.fill(0);
+			content = "";
+		}
+	};
+	struct GdsCell 
+	{
+		string cell_name;
+		vector<GdsBoundary> vBoundary;
+		vector<GdsText> vText;
+		void reset()
+		{
+			cell_name = "";
+			vBoundary.clear();
+			vText.clear();
+		}
+	};
+	struct GdsLib 
+	{
+		string lib_name;
+		array<double, 2> unit;
+		vector<GdsCell> vCell;
+		void reset()
+		{
+			lib_name = "";
+			unit.fill(0);
+			vCell.clear();
+		}
+	};
+	/// dummy class to keep the same api with gds stream parser 
+	struct GdsDataBase
+	{
+		virtual void add_gds_lib(GdsLib const&) = 0;
+	};
+};
+
+#endif 
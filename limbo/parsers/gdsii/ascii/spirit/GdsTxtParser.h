@@ -20,6 +20,7 @@
 #include <boost/spirit/include/qi_no_case.hpp>
 #include <boost/spirit/include/phoenix.hpp>
 #include <boost/spirit/include/phoenix_bind.hpp>
+#include <limbo/parsers/gdsii/ascii/spirit/GdsTxtData.h>
 #include <limbo/parsers/gdsii/ascii/spirit/ErrorHandler.h>
 //#include "Gadget.h"
 using std::cout;
@@ -47,82 +48,8 @@ namespace phoenix =  boost::phoenix;
 // read ascii gds file 
 // user can pass an object which contains the following member functions as callbacks 
 // add_gds_lib(GdsTxtParser::GdsLib const&)
-struct GdsTxtParser
+struct GdsTxtParser : GdsTxtData
 {
-	struct GdsItem 
-	{
-		virtual void print(ostringstream& ss) const {};
-		friend std::ostream& operator<<(std::ostream& os, GdsItem const& rhs)
-		{
-			std::ostringstream ss;
-			rhs.print(ss);
-			os << ss.str();
-			return os;
-		}
-		friend ostringstream& operator<<(ostringstream& ss, GdsItem const& rhs)
-		{
-			rhs.print(ss);
-			return ss;
-		}
-	};
-	struct GdsBoundary 
-	{
-		int32_t layer;
-		int32_t datatype;
-		vector<array<int32_t, 2> > vPoint;
-		void reset()
-		{
-			layer = -1;
-			datatype = -1;
-			vPoint.clear();
-		}
-	};
-	struct GdsText 
-	{
-		int32_t layer;
-		int32_t texttype;
-		int32_t presentation;
-		int32_t strans;
-		double mag;
-		array<int32_t, 2> position;
-		string content;
-		void reset()
-		{
-			layer = texttype = presentation = strans = 0;
-			mag = 0;
-			position.fill(0);
-			content = "";
-		}
-	};
-	struct GdsCell 
-	{
-		string cell_name;
-		vector<GdsBoundary> vBoundary;
-		vector<GdsText> vText;
-		void reset()
-		{
-			cell_name = "";
-			vBoundary.clear();
-			vText.clear();
-		}
-	};
-	struct GdsLib 
-	{
-		string lib_name;
-		array<double, 2> unit;
-		vector<GdsCell> vCell;
-		void reset()
-		{
-			lib_name = "";
-			unit.fill(0);
-			vCell.clear();
-		}
-	};
-	/// dummy class to keep the same api with gds stream parser 
-	struct GdsDataBase
-	{
-		virtual void add_gds_lib(GdsLib const&) = 0;
-	};
 	// grammar 
 	template <typename Iterator, typename Skipper, typename DataBaseType>
 	struct GdsTxtGrammar : qi::grammar<Iterator, Skipper>
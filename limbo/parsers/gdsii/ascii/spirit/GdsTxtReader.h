@@ -0,0 +1,404 @@
+/**
+ * @file   GdsTxtReader.h
+ * @brief  streaming reader of ASCII GDSII files without Boost.Spirit, same input format and callbacks as @ref GdsTxtParser
+ * @date   Oct 2026
+ */
+
+#ifndef _GDSTXTREADER_H
+#define _GDSTXTREADER_H
+
+#include <cstdlib>
+#include <cctype>
+#include <cassert>
+#include <fstream>
+#include <algorithm>
+#include <limbo/string/CharConv.h>
+#include <limbo/parsers/gdsii/ascii/spirit/GdsTxtData.h>
+
+// read ascii gds file with a hand-written tokenizer
+// the file is read in chunks, so it does not need to fit in memory
+// user can pass an object which contains the following member functions as callbacks
+// add_gds_lib(GdsTxtReader::GdsLib const&)
+struct GdsTxtReader : GdsTxtData
+{
+	// tokenizer over a stream, separators are white spaces, ':', ',' and comments from '#' to the end of line
+	// the buffer keeps a lookahead window ending with a null character,
+	// so tokens are scanned through pointers without checking the end of buffer
+	class Tokenizer
+	{
+		public:
+			Tokenizer(std::istream& in) : m_in(in), m_buffer(1024*1024+1), m_pos(0), m_end(0), m_eof(false), m_line(1) {m_buffer[0] = '\0';}
+
+			// skip separators and comments
+			// return next character or EOF
+			int skip()
+			{
+				while (fill())
+				{
+					char const* p = &m_buffer[m_pos];
+					char const* end = &m_buffer[m_end];
+					while (true)
+					{
+						char c = *p;
+						if (c == ' ' || c == '\t' || c == '\r' || c == ':' || c == ',' || c == '\v' || c == '\f')
+							++p;
+						else if (c == '\n')
+						{
+							++m_line;
+							++p;
+						}
+						else if (c == '#')
+						{
+							while (*p != '\n' && p != end)
+								++p;
+						}
+						else
+							break;
+					}
+					m_pos = p - &m_buffer[0];
+					if (p != end)
+						return (unsigned char)*p;
+				}
+				return EOF;
+			}
+			// read a word of [a-zA-Z_0-9.-], empty if next character is not in the set
+			string const& word()
+			{
+				m_token.clear();
+				skip();
+				while (fill())
+				{
+					char const* first = &m_buffer[m_pos];
+					char const* p = first;
+					while (is_word(*p))
+						++p;
+					m_token.append(first, p);
+					m_pos = p - &m_buffer[0];
+					// stop unless a long word reaches the end of the window
+					if (m_pos != m_end)
+						break;
+				}
+				return m_token;
+			}
+			// read a string quoted by "", without quotes
+			bool quoted(string& s)
+			{
+				if (skip() != '"')
+					return false;
+				++m_pos;
+				s.clear();
+				while (fill())
+				{
+					char const* first = &m_buffer[m_pos];
+					char const* end = &m_buffer[m_end];
+					char const* p = first;
+					while (p != end && *p != '"')
+					{
+						if (*p == '\n')
+							++m_line;
+						++p;
+					}
+					s.append(first, p);
+					m_pos = p - &m_buffer[0];
+					if (p != end)
+					{
+						++m_pos;
+						return true;
+					}
+				}
+				return false;
+			}
+			// return true if next token starts like an integer
+			bool integer_ahead()
+			{
+				int c = skip();
+				return (c >= '0' && c <= '9') || c == '-' || c == '+';
+			}
+			// read an integer with optional sign
+			bool integer(int32_t& value)
+			{
+				if (skip() == EOF)
+					return false;
+				// the window holds the whole number
+				limbo::from_chars_result result = limbo::from_chars(&m_buffer[m_pos], &m_buffer[m_end], value);
+				if (result.ec != 0)
+					return false;
+				m_pos = result.ptr - &m_buffer[0];
+				return true;
+			}
+			// read a floating point number
+			bool real(double& value)
+			{
+				if (skip() == EOF)
+					return false;
+				char const* first = &m_buffer[m_pos];
+				char const* p = first;
+				while ((*p >= '0' && *p <= '9') || *p == '.' || *p == '-' || *p == '+' || *p == 'e' || *p == 'E')
+					++p;
+				if (p == first)
+					return false;
+				m_pos = p - &m_buffer[0];
+				limbo::from_chars_result result = limbo::from_chars(first, p, value);
+				return result.ec == 0 && result.ptr == p;
+			}
+			// return true if all input is consumed
+			bool eof() {return skip() == EOF;}
+			// return current line number
+			int line() const {return m_line;}
+		protected:
+			// whether a character can be in a word
+			static bool is_word(char c)
+			{
+				return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.' || c == '-';
+			}
+			// keep at least a window of bytes after current position unless the stream ends
+			// return false if no byte is left
+			bool fill()
+			{
+				static const std::size_t window = 4096;
+				if (m_end - m_pos < window && !m_eof)
+				{
+					std::copy(m_buffer.begin()+m_pos, m_buffer.begin()+m_end, m_buffer.begin());
+					m_end -= m_pos;
+					m_pos = 0;
+					m_in.read(&m_buffer[m_end], m_buffer.size()-1-m_end);
+					m_end += m_in.gcount();
+					m_eof = !m_in.good();
+					// sentinel
+					m_buffer[m_end] = '\0';
+				}
+				return m_pos < m_end;
+			}
+
+			std::istream& m_in;
+			vector<char> m_buffer;
+			std::size_t m_pos; // current position
+			std::size_t m_end; // end of valid bytes
+			bool m_eof; // no more bytes in the stream
+			int m_line; // current line number
+			string m_token; // current word
+	};
+
+	// recursive descent parser of the same grammar as GdsTxtParser::GdsTxtGrammar
+	template <typename DataBaseType>
+	class Parser
+	{
+		public:
+			Parser(DataBaseType& db, std::istream& in) : m_db(db), m_tokenizer(in) {}
+
+			bool operator()()
+			{
+				if (!keyword("HEADER") || m_tokenizer.word().empty())
+					return error("HEADER");
+				while (!m_tokenizer.eof())
+				{
+					if (!block_lib())
+						return false;
+				}
+				return true;
+			}
+		protected:
+			// compare next word to a keyword
+			bool keyword(const char* key)
+			{
+				return match(m_tokenizer.word(), key);
+			}
+			static bool match(string const& token, const char* key)
+			{
+#ifdef CASE_INSENSITIVE
+				std::size_t i = 0;
+				for (; i < token.size() && key[i] != '\0'; ++i)
+				{
+					if (toupper((unsigned char)token[i]) != toupper((unsigned char)key[i]))
+						return false;
+				}
+				return i == token.size() && key[i] == '\0';
+#else
+				return token == key;
+#endif
+			}
+			bool error(const char* what)
+			{
+				std::cout << "Error! Expecting " << what << " line " << m_tokenizer.line() << std::endl;
+				return false;
+			}
+			bool block_lib()
+			{
+				if (!keyword("BGNLIB"))
+					return error("BGNLIB");
+				// skip time stamps
+				while (true)
+				{
+					string const& token = m_tokenizer.word();
+					if (token.empty())
+						return error("LIBNAME");
+					if (match(token, "LIBNAME"))
+						break;
+				}
+				if (!m_tokenizer.quoted(m_lib.lib_name))
+					return error("\"libname\"");
+				if (!keyword("UNITS") || !m_tokenizer.real(m_lib.unit[0]) || !m_tokenizer.real(m_lib.unit[1]))
+					return error("UNITS");
+				while (true)
+				{
+					string const& token = m_tokenizer.word();
+					if (match(token, "BGNSTR"))
+					{
+						if (!block_str())
+							return false;
+					}
+					else if (match(token, "ENDLIB"))
+						break;
+					else
+						return error("ENDLIB");
+				}
+				// required callback for DataBaseType
+				m_db.add_gds_lib(m_lib);
+				m_lib.reset();
+				return true;
+			}
+			bool block_str()
+			{
+				// skip time stamps
+				while (true)
+				{
+					string const& token = m_tokenizer.word();
+					if (token.empty())
+						return error("STRNAME");
+					if (match(token, "STRNAME"))
+						break;
+				}
+				m_lib.vCell.push_back(GdsCell());
+				GdsCell& cell = m_lib.vCell.back();
+				if (!m_tokenizer.quoted(cell.cell_name))
+					return error("\"strname\"");
+				while (true)
+				{
+					string const& token = m_tokenizer.word();
+					if (match(token, "BOUNDARY"))
+					{
+						if (!block_boundary(cell))
+							return false;
+					}
+					else if (match(token, "TEXT"))
+					{
+						if (!block_text(cell))
+							return false;
+					}
+					else if (match(token, "ENDSTR"))
+						return true;
+					else
+						return error("ENDSTR");
+				}
+			}
+			bool block_boundary(GdsCell& cell)
+			{
+				cell.vBoundary.push_back(GdsBoundary());
+				GdsBoundary& boundary = cell.vBoundary.back();
+				while (true)
+				{
+					string const& token = m_tokenizer.word();
+					if (match(token, "LAYER"))
+					{
+						if (!m_tokenizer.integer(boundary.layer))
+							return error("LAYER");
+					}
+					else if (match(token, "DATATYPE"))
+					{
+						if (!m_tokenizer.integer(boundary.datatype))
+							return error("DATATYPE");
+					}
+					else if (match(token, "XY"))
+					{
+						boundary.vPoint.clear();
+						array<int32_t, 2> point;
+						while (m_tokenizer.integer_ahead())
+						{
+							if (!m_tokenizer.integer(point[0]) || !m_tokenizer.integer(point[1]))
+								return error("XY");
+							boundary.vPoint.push_back(point);
+						}
+						// at least 5 integers as in GdsTxtParser
+						if (boundary.vPoint.size() < 3)
+							return error("XY");
+						assert(boundary.vPoint.front() == boundary.vPoint.back());
+					}
+					else if (match(token, "ENDEL"))
+						return true;
+					else
+						return error("ENDEL");
+				}
+			}
+			bool block_text(GdsCell& cell)
+			{
+				cell.vText.push_back(GdsText());
+				GdsText& t = cell.vText.back();
+				while (true)
+				{
+					string const& token = m_tokenizer.word();
+					if (match(token, "LAYER"))
+					{
+						if (!m_tokenizer.integer(t.layer))
+							return error("LAYER");
+					}
+					else if (match(token, "TEXTTYPE"))
+					{
+						if (!m_tokenizer.integer(t.texttype))
+							return error("TEXTTYPE");
+					}
+					else if (match(token, "PRESENTATION"))
+					{
+						if (!m_tokenizer.integer(t.presentation))
+							return error("PRESENTATION");
+					}
+					else if (match(token, "STRANS"))
+					{
+						if (!m_tokenizer.integer(t.strans))
+							return error("STRANS");
+					}
+					else if (match(token, "MAG"))
+					{
+						if (!m_tokenizer.real(t.mag))
+							return error("MAG");
+					}
+					else if (match(token, "XY"))
+					{
+						if (!m_tokenizer.integer(t.position[0]) || !m_tokenizer.integer(t.position[1]))
+							return error("XY");
+					}
+					else if (match(token, "STRING"))
+					{
+						if (!m_tokenizer.quoted(t.content))
+							return error("STRING");
+					}
+					else if (match(token, "ENDEL"))
+						return true;
+					else
+						return error("ENDEL");
+				}
+			}
+
+			DataBaseType& m_db;
+			Tokenizer m_tokenizer;
+			GdsLib m_lib;
+	};
+
+	template <typename DataBaseType>
+	static bool read(DataBaseType& db, std::istream& in)
+	{
+		return Parser<DataBaseType>(db, in)();
+	}
+	template <typename DataBaseType>
+	static bool read(DataBaseType& db, const string& gdsTxtFile)
+	{
+		std::ifstream in (gdsTxtFile.c_str(), std::ios::in | std::ios::binary);
+		if (!in.is_open())
+		{
+			std::cout << "Unable to open input file " << gdsTxtFile << std::endl;
+			return false;
+		}
+		return read(db, in);
+	}
+};
+
+#endif
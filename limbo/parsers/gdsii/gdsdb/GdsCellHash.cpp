@@ -0,0 +1,380 @@
+/**
+ * @file   GdsCellHash.cpp
+ * @brief  Implementation of content hashes of GDSII cells @ref GdsParser::GdsDB::GdsCellHash
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/gdsii/gdsdb/GdsCellHash.h>
+#include <limits>
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace GdsParser { namespace GdsDB {
+
+/// @brief scramble a hash, so sums of hashes do not cancel for similar objects
+/// @param h hash
+/// @return scrambled hash
+static GdsCellHash::hash_type scramble(GdsCellHash::hash_type h)
+{
+	boost::uint64_t x = h;
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdULL;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ULL;
+	x ^= x >> 33;
+	return (GdsCellHash::hash_type)x;
+}
+
+/// @brief combine a range of points into a hash
+/// @param seed hash
+/// @param first, last begin and end iterator to points
+template <typename Iterator>
+static void hashPoints(std::size_t& seed, Iterator first, Iterator last)
+{
+	for (; first != last; ++first)
+	{
+		boost::hash_combine(seed, first->x());
+		boost::hash_combine(seed, first->y());
+	}
+}
+
+/// @brief compare two points lexicographically
+/// @param p1, p2 points
+/// @return true if p1 is before p2
+static bool lessPoint(GdsCellHash::point_type const& p1, GdsCellHash::point_type const& p2)
+{
+	return p1.x() < p2.x() || (p1.x() == p2.x() && p1.y() < p2.y());
+}
+
+/// @brief compare two ranges of points
+/// @param first1, last1 begin and end iterator to points
+/// @param first2 begin iterator to points with at least as many points
+template <typename Iterator1, typename Iterator2>
+static bool equalPoints(Iterator1 first1, Iterator1 last1, Iterator2 first2)
+{
+	for (; first1 != last1; ++first1, ++first2)
+	{
+		if (first1->x() != first2->x() || first1->y() != first2->y())
+			return false;
+	}
+	return true;
+}
+
+/// @brief compare hashes of objects
+struct CompareHashIndex
+{
+	/// @param v1, v2 pairs of hash and index of object
+	bool operator()(std::pair<GdsCellHash::hash_type, unsigned int> const& v1, std::pair<GdsCellHash::hash_type, unsigned int> const& v2) const {return v1.first < v2.first;}
+};
+
+GdsCellHash::GdsCellHash(GdsDB const& db)
+	: m_db(db)
+	, m_vHash(db.cells().size(), 0)
+	, m_vState(db.cells().size(), 0)
+{
+	m_vOrder.reserve(db.cells().size());
+	for (unsigned int i = 0, ie = db.cells().size(); i < ie; ++i)
+		compute(i);
+	// only needed while computing
+	std::vector<char>().swap(m_vState);
+}
+
+void GdsCellHash::canonicalPolygon(GdsPolygon const& polygon, std::vector<point_type>& vPoint)
+{
+	std::vector<point_type> vTmp (polygon.begin(), polygon.end());
+	if (vTmp.size() > 1 && vTmp.front() == vTmp.back())
+		vTmp.pop_back();
+	vPoint.clear();
+	if (vTmp.empty())
+		return;
+	std::size_t n = vTmp.size();
+	std::size_t start = std::min_element(vTmp.begin(), vTmp.end(), lessPoint) - vTmp.begin();
+	// walk towards the smaller neighbor of the smallest vertex
+	bool forward = !lessPoint(vTmp[(start+n-1)%n], vTmp[(start+1)%n]);
+	vPoint.reserve(n);
+	for (std::size_t i = 0; i < n; ++i)
+		vPoint.push_back(vTmp[(forward)? (start+i)%n : (start+n-i)%n]);
+}
+
+GdsCellHash::hash_type GdsCellHash::hashObject(::GdsParser::GdsRecords::EnumType type, GdsObject const* object, hash_type refHash)
+{
+	std::size_t seed = 0;
+	boost::hash_combine(seed, (int)type);
+	switch (type)
+	{
+		case ::GdsParser::GdsRecords::BOUNDARY:
+		case ::GdsParser::GdsRecords::BOX:
+			{
+				GdsPolygon const* polygon = static_cast<GdsPolygon const*>(object);
+				std::vector<point_type> vPoint;
+				canonicalPolygon(*polygon, vPoint);
+				boost::hash_combine(seed, polygon->layer());
+				boost::hash_combine(seed, polygon->datatype());
+				hashPoints(seed, vPoint.begin(), vPoint.end());
+			}
+			break;
+		case ::GdsParser::GdsRecords::PATH:
+			{
+				GdsPath const* path = static_cast<GdsPath const*>(object);
+				boost::hash_combine(seed, path->layer());
+				boost::hash_combine(seed, path->datatype());
+				boost::hash_combine(seed, path->pathtype());
+				boost::hash_combine(seed, path->width());
+				boost::hash_combine(seed, path->bgnExtn());
+				boost::hash_combine(seed, path->endExtn());
+				hashPoints(seed, path->begin(), path->end());
+			}
+			break;
+		case ::GdsParser::GdsRecords::TEXT:
+			{
+				GdsText const* text = static_cast<GdsText const*>(object);
+				boost::hash_combine(seed, text->layer());
+				boost::hash_combine(seed, text->datatype());
+				boost::hash_combine(seed, text->texttype());
+				boost::hash_combine(seed, text->text());
+				boost::hash_combine(seed, text->position().x());
+				boost::hash_combine(seed, text->position().y());
+				boost::hash_combine(seed, text->width());
+				boost::hash_combine(seed, text->presentation());
+				boost::hash_combine(seed, text->angle());
+				boost::hash_combine(seed, text->magnification());
+				boost::hash_combine(seed, text->strans());
+			}
+			break;
+		case ::GdsParser::GdsRecords::SREF:
+			{
+				GdsCellReference const* cellRef = static_cast<GdsCellReference const*>(object);
+				boost::hash_combine(seed, refHash);
+				boost::hash_combine(seed, cellRef->position().x());
+				boost::hash_combine(seed, cellRef->position().y());
+				boost::hash_combine(seed, cellRef->angle());
+				boost::hash_combine(seed, cellRef->magnification());
+				boost::hash_combine(seed, cellRef->strans());
+			}
+			break;
+		case ::GdsParser::GdsRecords::AREF:
+			{
+				GdsCellArray const* cellArray = static_cast<GdsCellArray const*>(object);
+				boost::hash_combine(seed, refHash);
+				boost::hash_combine(seed, cellArray->columns());
+				boost::hash_combine(seed, cellArray->rows());
+				boost::hash_combine(seed, cellArray->spacing(0));
+				boost::hash_combine(seed, cellArray->spacing(1));
+				hashPoints(seed, cellArray->positions().begin(), cellArray->positions().end());
+				boost::hash_combine(seed, cellArray->angle());
+				boost::hash_combine(seed, cellArray->magnification());
+				boost::hash_combine(seed, cellArray->strans());
+			}
+			break;
+		default:
+			break;
+	}
+	return seed;
+}
+
+unsigned int GdsCellHash::refIndex(object_entry_type const& entry) const
+{
+	GdsCell const* refCell = NULL;
+	if (entry.first == ::GdsParser::GdsRecords::SREF)
+		refCell = m_db.getRefCell(*static_cast<GdsCellReference const*>(entry.second));
+	else if (entry.first == ::GdsParser::GdsRecords::AREF)
+		refCell = m_db.getRefCell(*static_cast<GdsCellArray const*>(entry.second));
+	return (refCell)? refCell - &m_db.cells()[0] : std::numeric_limits<unsigned int>::max();
+}
+
+GdsCellHash::hash_type GdsCellHash::hashEntry(object_entry_type const& entry) const
+{
+	hash_type refHash = 0;
+	if (entry.first == ::GdsParser::GdsRecords::SREF || entry.first == ::GdsParser::GdsRecords::AREF)
+	{
+		unsigned int idx = refIndex(entry);
+		// a missing cell or a cycle of references falls back to the name
+		if (idx < m_vState.size() && m_vState[idx] != 2)
+			idx = std::numeric_limits<unsigned int>::max();
+		if (idx < m_vHash.size())
+			refHash = m_vHash[idx];
+		else if (entry.first == ::GdsParser::GdsRecords::SREF)
+			refHash = boost::hash<std::string>()(static_cast<GdsCellReference const*>(entry.second)->refCell());
+		else
+			refHash = boost::hash<std::string>()(static_cast<GdsCellArray const*>(entry.second)->refCell());
+	}
+	return hashObject(entry.first, entry.second, refHash);
+}
+
+void GdsCellHash::compute(unsigned int idx)
+{
+	if (m_vState[idx])
+		return;
+	m_vState[idx] = 1;
+	GdsCell const& cell = m_db.cells()[idx];
+	for (std::vector<object_entry_type>::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+	{
+		unsigned int refIdx = refIndex(*it);
+		if (refIdx < m_vState.size())
+			compute(refIdx);
+	}
+	// sum of scrambled hashes does not depend on the order of objects
+	hash_type sum = 0;
+	for (std::vector<object_entry_type>::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+		sum += scramble(hashEntry(*it));
+	std::size_t seed = sum;
+	boost::hash_combine(seed, cell.objects().size());
+	m_vHash[idx] = seed;
+	m_vState[idx] = 2;
+	m_vOrder.push_back(idx);
+}
+
+bool GdsCellHash::equalEntry(object_entry_type const& e1, object_entry_type const& e2, std::vector<unsigned int> const& vClass) const
+{
+	if (e1.first != e2.first)
+		return false;
+	switch (e1.first)
+	{
+		case ::GdsParser::GdsRecords::BOUNDARY:
+		case ::GdsParser::GdsRecords::BOX:
+			{
+				GdsPolygon const* p1 = static_cast<GdsPolygon const*>(e1.second);
+				GdsPolygon const* p2 = static_cast<GdsPolygon const*>(e2.second);
+				if (p1->layer() != p2->layer() || p1->datatype() != p2->datatype())
+					return false;
+				std::vector<point_type> v1, v2;
+				canonicalPolygon(*p1, v1);
+				canonicalPolygon(*p2, v2);
+				return v1.size() == v2.size() && equalPoints(v1.begin(), v1.end(), v2.begin());
+			}
+		case ::GdsParser::GdsRecords::PATH:
+			{
+				GdsPath const* p1 = static_cast<GdsPath const*>(e1.second);
+				GdsPath const* p2 = static_cast<GdsPath const*>(e2.second);
+				return p1->layer() == p2->layer() && p1->datatype() == p2->datatype()
+					&& p1->pathtype() == p2->pathtype() && p1->width() == p2->width()
+					&& p1->bgnExtn() == p2->bgnExtn() && p1->endExtn() == p2->endExtn()
+					&& p1->size() == p2->size() && equalPoints(p1->begin(), p1->end(), p2->begin());
+			}
+		case ::GdsParser::GdsRecords::TEXT:
+			{
+				GdsText const* t1 = static_cast<GdsText const*>(e1.second);
+				GdsText const* t2 = static_cast<GdsText const*>(e2.second);
+				return t1->layer() == t2->layer() && t1->datatype() == t2->datatype()
+					&& t1->texttype() == t2->texttype() && t1->text() == t2->text()
+					&& t1->position() == t2->position() && t1->width() == t2->width()
+					&& t1->presentation() == t2->presentation() && t1->angle() == t2->angle()
+					&& t1->magnification() == t2->magnification() && t1->strans() == t2->strans();
+			}
+		case ::GdsParser::GdsRecords::SREF:
+		case ::GdsParser::GdsRecords::AREF:
+			{
+				unsigned int idx1 = refIndex(e1);
+				unsigned int idx2 = refIndex(e2);
+				if (idx1 < vClass.size() && idx2 < vClass.size())
+				{
+					if (vClass[idx1] != vClass[idx2])
+						return false;
+				}
+				else if (idx1 < vClass.size() || idx2 < vClass.size())
+					return false;
+				if (e1.first == ::GdsParser::GdsRecords::SREF)
+				{
+					GdsCellReference const* r1 = static_cast<GdsCellReference const*>(e1.second);
+					GdsCellReference const* r2 = static_cast<GdsCellReference const*>(e2.second);
+					// names of missing cells are the only way to tell them apart
+					if (idx1 >= vClass.size() && r1->refCell() != r2->refCell())
+						return false;
+					return r1->position() == r2->position() && r1->angle() == r2->angle()
+						&& r1->magnification() == r2->magnification() && r1->strans() == r2->strans();
+				}
+				else
+				{
+					GdsCellArray const* a1 = static_cast<GdsCellArray const*>(e1.second);
+					GdsCellArray const* a2 = static_cast<GdsCellArray const*>(e2.second);
+					if (idx1 >= vClass.size() && a1->refCell() != a2->refCell())
+						return false;
+					return a1->columns() == a2->columns() && a1->rows() == a2->rows()
+						&& a1->spacing(0) == a2->spacing(0) && a1->spacing(1) == a2->spacing(1)
+						&& a1->positions() == a2->positions() && a1->angle() == a2->angle()
+						&& a1->magnification() == a2->magnification() && a1->strans() == a2->strans();
+				}
+			}
+		default:
+			return e1.second == e2.second;
+	}
+}
+
+bool GdsCellHash::equal(unsigned int i, unsigned int j, std::vector<unsigned int> const& vClass) const
+{
+	if (i == j)
+		return true;
+	std::vector<object_entry_type> const& vObject1 = m_db.cells()[i].objects();
+	std::vector<object_entry_type> const& vObject2 = m_db.cells()[j].objects();
+	if (m_vHash[i] != m_vHash[j] || vObject1.size() != vObject2.size())
+		return false;
+
+	// match objects with equal hashes
+	std::vector<std::pair<hash_type, unsigned int> > v1, v2;
+	v1.reserve(vObject1.size());
+	v2.reserve(vObject2.size());
+	for (unsigned int k = 0, ke = vObject1.size(); k < ke; ++k)
+	{
+		v1.push_back(std::make_pair(hashEntry(vObject1[k]), k));
+		v2.push_back(std::make_pair(hashEntry(vObject2[k]), k));
+	}
+	std::sort(v1.begin(), v1.end(), CompareHashIndex());
+	std::sort(v2.begin(), v2.end(), CompareHashIndex());
+	std::vector<char> vMatched (v2.size(), false);
+	for (std::size_t k = 0, ke = v1.size(); k < ke; )
+	{
+		if (v1[k].first != v2[k].first)
+			return false;
+		std::size_t kr = k;
+		while (kr < ke && v1[kr].first == v1[k].first)
+			++kr;
+		if (kr < ke && v2[kr].first == v1[k].first)
+			return false;
+		// equality is transitive, so greedy matching within objects of the same hash is exact
+		for (std::size_t a = k; a < kr; ++a)
+		{
+			std::size_t b = k;
+			for (; b < kr; ++b)
+			{
+				if (!vMatched[b] && equalEntry(vObject1[v1[a].second], vObject2[v2[b].second], vClass))
+					break;
+			}
+			if (b == kr)
+				return false;
+			vMatched[b] = true;
+		}
+		k = kr;
+	}
+	return true;
+}
+
+std::size_t GdsCellHash::classify(std::vector<unsigned int>& vClass) const
+{
+	vClass.resize(m_vHash.size());
+	for (unsigned int i = 0, ie = vClass.size(); i < ie; ++i)
+		vClass[i] = i;
+
+	std::size_t numDuplicates = 0;
+	boost::unordered_map<hash_type, std::vector<unsigned int> > mHash2Class;
+	for (std::vector<unsigned int>::const_iterator it = m_vOrder.begin(), ite = m_vOrder.end(); it != ite; ++it)
+	{
+		std::vector<unsigned int>& vRepresentative = mHash2Class[m_vHash[*it]];
+		std::vector<unsigned int>::const_iterator itr = vRepresentative.begin();
+		for (; itr != vRepresentative.end(); ++itr)
+		{
+			if (equal(*itr, *it, vClass))
+				break;
+		}
+		if (itr == vRepresentative.end())
+			vRepresentative.push_back(*it);
+		else
+		{
+			vClass[*it] = *itr;
+			++numDuplicates;
+		}
+	}
+	return numDuplicates;
+}
+
+}} // namespace GdsParser // GdsDB
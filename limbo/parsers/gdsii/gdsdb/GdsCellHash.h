@@ -0,0 +1,108 @@
+/**
+ * @file   GdsCellHash.h
+ * @brief  Content hashes of GDSII cells for finding duplicate structures
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_GDSII_GDSDB_GDSCELLHASH_H
+#define LIMBO_PARSERS_GDSII_GDSDB_GDSCELLHASH_H
+
+#include <vector>
+#include <limbo/parsers/gdsii/gdsdb/GdsObjects.h>
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+/// namespace for Limbo.GdsParser.GdsDB
+namespace GdsDB
+{
+
+/**
+	Content hashes of all cells in a database \n
+\n
+	The hash of a cell does not depend on its name or the order of its objects,
+	so structures copied under different names get the same hash.
+	A polygon is hashed from its vertices starting at the smallest one in the orientation with the smaller second vertex,
+	so the starting vertex, the orientation and a closing vertex do not matter.
+	A reference is hashed with the hash of its reference cell instead of the cell name,
+	so parents of duplicate cells are duplicates as well. \n
+\n
+	Equal hashes do not guarantee equal cells; @ref GdsParser::GdsDB::GdsCellHash::classify
+	compares the objects of cells with equal hashes before grouping them.
+	Hashes refer to cells by indices in @ref GdsParser::GdsDB::GdsDB::cells, so they are stale once cells are added or removed.
+*/
+class GdsCellHash
+{
+	public:
+        /// @nowarn
+		typedef GdsObject::point_type point_type;
+		typedef GdsCell::object_entry_type object_entry_type;
+        /// @endnowarn
+        /// hash value type
+		typedef std::size_t hash_type;
+
+		/// @brief constructor, compute hashes of all cells
+        /// @param db database
+		explicit GdsCellHash(GdsDB const& db);
+
+        /// @param idx index of cell in @ref GdsParser::GdsDB::GdsDB::cells
+        /// @return hash of the cell
+		hash_type hash(unsigned int idx) const {return m_vHash[idx];}
+        /// @param cell a cell of the database
+        /// @return hash of the cell
+		hash_type hash(GdsCell const& cell) const {return m_vHash[&cell - &m_db.cells()[0]];}
+        /// @return hashes of cells by indices
+		std::vector<hash_type> const& hashes() const {return m_vHash;}
+        /// @return indices of cells, reference cells before the cells referring to them
+		std::vector<unsigned int> const& order() const {return m_vOrder;}
+
+		/// @brief group cells with the same content
+        /// @param vClass for each cell, the index of the first cell in @ref order with the same content
+        /// @return number of cells that are duplicates of another cell
+		std::size_t classify(std::vector<unsigned int>& vClass) const;
+		/// @brief compare the content of two cells, ignoring names and the order of objects
+        /// @param i, j indices of cells
+        /// @param vClass classes of reference cells as computed by @ref classify, references to cells of the same class are equal
+        /// @return true if the cells have the same objects
+		bool equal(unsigned int i, unsigned int j, std::vector<unsigned int> const& vClass) const;
+
+        /// @brief hash of an object
+        /// @param type GDSII record of object
+        /// @param object GDSII object
+        /// @param refHash hash of the reference cell for SREF and AREF
+        /// @return hash of the object
+		static hash_type hashObject(::GdsParser::GdsRecords::EnumType type, GdsObject const* object, hash_type refHash);
+        /// @brief vertices of a polygon in canonical order
+        /// @param polygon polygon
+        /// @param vPoint output vertices without closing vertex
+		static void canonicalPolygon(GdsPolygon const& polygon, std::vector<point_type>& vPoint);
+	protected:
+		/// @brief copy constructor is not allowed
+		GdsCellHash(GdsCellHash const&);
+		/// @brief assignment is not allowed
+		GdsCellHash& operator=(GdsCellHash const&);
+
+        /// @brief compute the hash of a cell after its reference cells
+        /// @param idx index of cell
+		void compute(unsigned int idx);
+        /// @param entry object of a cell
+        /// @return index of the reference cell of SREF or AREF, std::numeric_limits<unsigned int>::max() if not found or not a reference
+		unsigned int refIndex(object_entry_type const& entry) const;
+        /// @param entry object of a cell
+        /// @return hash of the object
+		hash_type hashEntry(object_entry_type const& entry) const;
+        /// @param e1, e2 objects of two cells
+        /// @param vClass classes of reference cells
+        /// @return true if the objects are equal
+		bool equalEntry(object_entry_type const& e1, object_entry_type const& e2, std::vector<unsigned int> const& vClass) const;
+
+		GdsDB const& m_db; ///< database
+		std::vector<hash_type> m_vHash; ///< hashes of cells
+		std::vector<unsigned int> m_vOrder; ///< cells in bottom-up order
+		std::vector<char> m_vState; ///< 0 for not visited, 1 for in progress, 2 for done
+};
+
+} // namespace GdsDB
+} // namespace GdsParser
+
+#endif
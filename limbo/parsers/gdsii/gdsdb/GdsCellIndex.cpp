@@ -0,0 +1,137 @@
+/**
+ * @file   GdsCellIndex.cpp
+ * @brief  Implementation of spatial index of GDSII shapes @ref GdsParser::GdsDB::GdsCellIndex
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/gdsii/gdsdb/GdsCellIndex.h>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+
+namespace GdsParser { namespace GdsDB {
+
+/// @brief extents of a range of points
+/// @param first, last begin and end iterator to points
+/// @param box output bounding box
+/// @return false if the range is empty
+template <typename Iterator>
+static bool pointExtents(Iterator first, Iterator last, GdsCellIndex::rectangle_type& box)
+{
+	if (first == last)
+		return false;
+	box = gtl::construct<GdsCellIndex::rectangle_type>(first->x(), first->y(), first->x(), first->y());
+	for (++first; first != last; ++first)
+		gtl::encompass(box, *first);
+	return true;
+}
+
+/// @brief compare values of R-tree by indices of objects
+struct CompareValueByIndex
+{
+	/// @param v1, v2 values of R-tree
+	bool operator()(GdsCellIndex::value_type const& v1, GdsCellIndex::value_type const& v2) const {return v1.second < v2.second;}
+};
+
+GdsCellIndex::GdsCellIndex(GdsCell const& cell)
+	: m_cell(cell)
+	, m_grouped(false)
+{
+}
+
+bool GdsCellIndex::boundingBox(::GdsParser::GdsRecords::EnumType type, GdsObject const* object, rectangle_type& box)
+{
+	switch (type)
+	{
+		case ::GdsParser::GdsRecords::BOUNDARY:
+		case ::GdsParser::GdsRecords::BOX:
+			{
+				GdsPolygon const* polygon = static_cast<GdsPolygon const*>(object);
+				return pointExtents(polygon->begin(), polygon->end(), box);
+			}
+		case ::GdsParser::GdsRecords::PATH:
+			{
+				GdsPath const* path = static_cast<GdsPath const*>(object);
+				if (!pointExtents(path->begin(), path->end(), box))
+					return false;
+				// conservative bloating covers any path type
+				coordinate_type bloat = 0;
+				if (path->width() != std::numeric_limits<coordinate_type>::max())
+					bloat = (std::abs(path->width())+1)/2;
+				if (path->bgnExtn() != std::numeric_limits<coordinate_type>::max())
+					bloat = std::max(bloat, path->bgnExtn());
+				if (path->endExtn() != std::numeric_limits<coordinate_type>::max())
+					bloat = std::max(bloat, path->endExtn());
+				gtl::bloat(box, bloat);
+				return true;
+			}
+		case ::GdsParser::GdsRecords::TEXT:
+			{
+				GdsText const* text = static_cast<GdsText const*>(object);
+				box = gtl::construct<rectangle_type>(text->position().x(), text->position().y(), text->position().x(), text->position().y());
+				return true;
+			}
+		default:
+			return false;
+	}
+}
+
+std::size_t GdsCellIndex::query(int layer, int datatype, rectangle_type const& box, std::vector<object_entry_type>& vObject) const
+{
+	rtree_type const* rtree = index(layer_key_type(layer, datatype));
+	if (rtree == NULL)
+		return 0;
+
+	std::vector<value_type> vValue;
+	rtree->query(bgi::intersects(box), std::back_inserter(vValue));
+	// report in the order of the cell for deterministic results
+	std::sort(vValue.begin(), vValue.end(), CompareValueByIndex());
+	vObject.reserve(vObject.size() + vValue.size());
+	for (std::vector<value_type>::const_iterator it = vValue.begin(), ite = vValue.end(); it != ite; ++it)
+		vObject.push_back(m_cell.objects()[it->second]);
+	return vValue.size();
+}
+
+void GdsCellIndex::clear()
+{
+	m_grouped = false;
+	m_mLayerValue.clear();
+	m_mIndex.clear();
+}
+
+void GdsCellIndex::groupByLayer() const
+{
+	if (m_grouped)
+		return;
+	m_grouped = true;
+	for (unsigned int i = 0, ie = m_cell.objects().size(); i < ie; ++i)
+	{
+		object_entry_type const& entry = m_cell.objects()[i];
+		rectangle_type box;
+		if (!boundingBox(entry.first, entry.second, box))
+			continue;
+		GdsShape const* shape = static_cast<GdsShape const*>(entry.second);
+		m_mLayerValue[layer_key_type(shape->layer(), shape->datatype())].push_back(value_type(box, i));
+	}
+}
+
+GdsCellIndex::rtree_type const* GdsCellIndex::index(layer_key_type const& key) const
+{
+	std::map<layer_key_type, rtree_type>::const_iterator found = m_mIndex.find(key);
+	if (found != m_mIndex.end())
+		return &found->second;
+
+	groupByLayer();
+	std::map<layer_key_type, std::vector<value_type> >::iterator foundValue = m_mLayerValue.find(key);
+	if (foundValue == m_mLayerValue.end())
+		return NULL;
+	// bulk loading gives a better packed tree than insertion one by one
+	rtree_type rtree (foundValue->second.begin(), foundValue->second.end());
+	rtree_type& target = m_mIndex[key];
+	target.swap(rtree);
+	m_mLayerValue.erase(foundValue);
+	return &target;
+}
+
+}} // namespace GdsParser // GdsDB
@@ -0,0 +1,101 @@
+/**
+ * @file   GdsCellIndex.h
+ * @brief  Spatial index of GDSII shapes in a cell by layers
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_GDSII_GDSDB_GDSCELLINDEX_H
+#define LIMBO_PARSERS_GDSII_GDSDB_GDSCELLINDEX_H
+
+#include <map>
+#include <boost/geometry/index/rtree.hpp>
+#include <limbo/parsers/gdsii/gdsdb/GdsObjects.h>
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+/// namespace for Limbo.GdsParser.GdsDB
+namespace GdsDB
+{
+
+/// shortcut for namespace of Boost.Geometry index
+namespace bgi = boost::geometry::index;
+
+/**
+	Spatial index of shapes in a cell for window queries \n
+\n
+	One R-tree is kept for each pair of (layer, datatype).
+	Nothing is built on construction; the first query groups shapes by layers,
+	and the R-tree of a layer is bulk loaded on the first query to that layer.
+	It works on any @ref GdsParser::GdsDB::GdsCell, including the flattened result of
+	@ref GdsParser::GdsDB::GdsDB::extractCell, which is usually where window queries are needed. \n
+\n
+	Only BOUNDARY, BOX, PATH and TEXT are indexed, because cell references have no layer.
+	Shapes are matched by their bounding boxes, a path is bloated by its half width and extensions.
+	The index refers to objects of the cell, so the cell must outlive the index,
+	and @ref GdsParser::GdsDB::GdsCellIndex::clear should be called after the cell is modified.
+*/
+class GdsCellIndex
+{
+	public:
+        /// @nowarn
+		typedef GdsObject::coordinate_type coordinate_type;
+		typedef GdsObject::rectangle_type rectangle_type;
+		typedef GdsCell::object_entry_type object_entry_type;
+        /// @endnowarn
+        /// key of an index, pair of layer and data type
+		typedef std::pair<int, int> layer_key_type;
+        /// value in R-tree, pair of bounding box and index to @ref GdsParser::GdsDB::GdsCell::objects
+		typedef std::pair<rectangle_type, unsigned int> value_type;
+        /// R-tree type
+		typedef bgi::rtree<value_type, bgi::rstar<16> > rtree_type;
+
+		/// @brief constructor
+        /// @param cell the cell to index
+		explicit GdsCellIndex(GdsCell const& cell);
+
+		/// @brief collect shapes in a layer whose bounding boxes intersect a window
+        /// @param layer layer
+        /// @param datatype data type
+        /// @param box query window
+        /// @param vObject objects found are appended
+        /// @return number of objects found
+		std::size_t query(int layer, int datatype, rectangle_type const& box, std::vector<object_entry_type>& vObject) const;
+		/// @brief release all indices, they are rebuilt on next query
+		void clear();
+
+        /// @param layer layer
+        /// @param datatype data type
+        /// @return true if the R-tree of the layer has been built
+		bool isBuilt(int layer, int datatype) const {return m_mIndex.count(layer_key_type(layer, datatype));}
+        /// @return the cell indexed
+		GdsCell const& cell() const {return m_cell;}
+
+        /// @brief compute bounding box of a shape
+        /// @param type GDSII record of object
+        /// @param object GDSII object
+        /// @param box output bounding box
+        /// @return false if the object is not a shape or has no point
+		static bool boundingBox(::GdsParser::GdsRecords::EnumType type, GdsObject const* object, rectangle_type& box);
+	protected:
+		/// @brief copy constructor is not allowed
+		GdsCellIndex(GdsCellIndex const&);
+		/// @brief assignment is not allowed
+		GdsCellIndex& operator=(GdsCellIndex const&);
+
+		/// @brief group shapes by layers if not done yet
+		void groupByLayer() const;
+        /// @param key layer and data type
+        /// @return R-tree of a layer, built if needed, NULL if the layer has no shape
+		rtree_type const* index(layer_key_type const& key) const;
+
+		GdsCell const& m_cell; ///< the cell indexed
+		mutable bool m_grouped; ///< whether shapes have been grouped
+		mutable std::map<layer_key_type, std::vector<value_type> > m_mLayerValue; ///< shapes grouped by layers, consumed when R-tree is built
+		mutable std::map<layer_key_type, rtree_type> m_mIndex; ///< R-tree for each layer
+};
+
+} // namespace GdsDB
+} // namespace GdsParser
+
+#endif
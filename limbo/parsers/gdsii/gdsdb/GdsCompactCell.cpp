@@ -0,0 +1,389 @@
+/**
+ * @file   GdsCompactCell.cpp
+ * @brief  Implementation of GDSII cell with contiguous storage @ref GdsParser::GdsDB::GdsCompactCell
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/gdsii/gdsdb/GdsCompactCell.h>
+#include <limbo/preprocessor/AssertMsg.h>
+#include <limits>
+#include <algorithm>
+
+namespace GdsParser { namespace GdsDB {
+
+/// @brief check whether points form an axis-parallel rectangle
+/// @param first, last begin and end iterator to points
+/// @param box output rectangle
+/// @return true if points form a rectangle with 4 corners, the last point may repeat the first one
+template <typename Iterator>
+static bool toRectangle(Iterator first, Iterator last, GdsCompactCell::rectangle_type& box)
+{
+	typedef GdsCompactCell::point_type point_type;
+	std::size_t n = std::distance(first, last);
+	if (n != 4 && n != 5)
+		return false;
+	point_type p[5];
+	std::copy(first, last, p);
+	if (n == 5 && p[4] != p[0])
+		return false;
+
+	bool vertical = (p[0].x() == p[1].x() && p[1].y() == p[2].y() && p[2].x() == p[3].x() && p[3].y() == p[0].y());
+	bool horizontal = (p[0].y() == p[1].y() && p[1].x() == p[2].x() && p[2].y() == p[3].y() && p[3].x() == p[0].x());
+	if (!vertical && !horizontal)
+		return false;
+	GdsCompactCell::coordinate_type xl = std::min(p[0].x(), p[2].x());
+	GdsCompactCell::coordinate_type yl = std::min(p[0].y(), p[2].y());
+	GdsCompactCell::coordinate_type xh = std::max(p[0].x(), p[2].x());
+	GdsCompactCell::coordinate_type yh = std::max(p[0].y(), p[2].y());
+	if (xl == xh || yl == yh)
+		return false;
+	box = gtl::construct<GdsCompactCell::rectangle_type>(xl, yl, xh, yh);
+	return true;
+}
+
+GdsCompactCell::polygon_point_iterator::polygon_point_iterator(unsigned char const* p, unsigned int size)
+	: m_point(NULL)
+	, m_byte(p)
+	, m_remain(size)
+	, m_manhattan(false)
+	, m_horizontal(true)
+	, m_firstX(0)
+{
+	if (m_remain == 0)
+		return;
+	m_manhattan = (*m_byte++ == 0);
+	m_firstX = GdsCompactCellDetails::getSignedVarint(m_byte);
+	m_current = gtl::construct<point_type>(m_firstX, GdsCompactCellDetails::getSignedVarint(m_byte));
+}
+
+GdsCompactCell::polygon_point_iterator& GdsCompactCell::polygon_point_iterator::operator++()
+{
+	if (m_point)
+	{
+		++m_point;
+		return *this;
+	}
+	if (--m_remain == 0)
+		return *this;
+	if (!m_manhattan)
+	{
+		long long dx = GdsCompactCellDetails::getSignedVarint(m_byte);
+		long long dy = GdsCompactCellDetails::getSignedVarint(m_byte);
+		m_current = gtl::construct<point_type>(m_current.x() + dx, m_current.y() + dy);
+	}
+	else if (m_remain == 1)
+		// the last vertex is implied by the first one
+		m_current.x(m_firstX);
+	else if (m_horizontal)
+		m_current.x(m_current.x() + GdsCompactCellDetails::getSignedVarint(m_byte));
+	else
+		m_current.y(m_current.y() + GdsCompactCellDetails::getSignedVarint(m_byte));
+	m_horizontal = !m_horizontal;
+	return *this;
+}
+
+int GdsCompactCell::object_view::layer() const
+{
+	switch (type())
+	{
+		case ::GdsParser::GdsRecords::BOX: return m_cell->m_vRectangle[index()].layer;
+		case ::GdsParser::GdsRecords::BOUNDARY: return m_cell->m_vPolygon[index()].layer;
+		case ::GdsParser::GdsRecords::PATH: return m_cell->m_vPath[index()].layer;
+		case ::GdsParser::GdsRecords::TEXT: return m_cell->m_vText[index()].layer();
+		default: return std::numeric_limits<int>::max();
+	}
+}
+
+int GdsCompactCell::object_view::datatype() const
+{
+	switch (type())
+	{
+		case ::GdsParser::GdsRecords::BOX: return m_cell->m_vRectangle[index()].datatype;
+		case ::GdsParser::GdsRecords::BOUNDARY: return m_cell->m_vPolygon[index()].datatype;
+		case ::GdsParser::GdsRecords::PATH: return m_cell->m_vPath[index()].datatype;
+		case ::GdsParser::GdsRecords::TEXT: return m_cell->m_vText[index()].datatype();
+		default: return std::numeric_limits<int>::max();
+	}
+}
+
+GdsCompactCell::point_type const* GdsCompactCell::object_view::pointsBegin() const
+{
+	switch (type())
+	{
+		case ::GdsParser::GdsRecords::BOUNDARY: return m_cell->pointsBegin(m_cell->m_vPolygon[index()]);
+		case ::GdsParser::GdsRecords::PATH: return m_cell->pointsBegin(m_cell->m_vPath[index()]);
+		default: return NULL;
+	}
+}
+
+GdsCompactCell::point_type const* GdsCompactCell::object_view::pointsEnd() const
+{
+	switch (type())
+	{
+		case ::GdsParser::GdsRecords::BOUNDARY: return m_cell->pointsEnd(m_cell->m_vPolygon[index()]);
+		case ::GdsParser::GdsRecords::PATH: return m_cell->pointsEnd(m_cell->m_vPath[index()]);
+		default: return NULL;
+	}
+}
+
+GdsObject* GdsCompactCell::object_view::toObject() const
+{
+	switch (type())
+	{
+		case ::GdsParser::GdsRecords::BOX:
+			{
+				// rectangles are converted to polygons as the reader does
+				Rectangle const& rect = m_cell->m_vRectangle[index()];
+				GdsPolygon* polygon = new GdsPolygon();
+				point_type vPoint[4] = {
+					gtl::ll(rect.box),
+					gtl::construct<point_type>(gtl::xh(rect.box), gtl::yl(rect.box)),
+					gtl::ur(rect.box),
+					gtl::construct<point_type>(gtl::xl(rect.box), gtl::yh(rect.box))
+				};
+				polygon->setLayer(rect.layer);
+				polygon->setDatatype(rect.datatype);
+				polygon->set(vPoint, vPoint + 4);
+				return polygon;
+			}
+		case ::GdsParser::GdsRecords::BOUNDARY:
+			{
+				Polygon const& record = m_cell->m_vPolygon[index()];
+				polygon_view view = m_cell->polygon(record);
+				GdsPolygon* polygon = new GdsPolygon();
+				polygon->setLayer(record.layer);
+				polygon->setDatatype(record.datatype);
+				polygon->set(view.begin(), view.end());
+				return polygon;
+			}
+		case ::GdsParser::GdsRecords::PATH:
+			{
+				Path const& record = m_cell->m_vPath[index()];
+				GdsPath* path = new GdsPath();
+				path->setLayer(record.layer);
+				path->setDatatype(record.datatype);
+				path->setPathtype(record.pathtype);
+				path->setWidth(record.width);
+				path->setBgnExtn(record.bgnextn);
+				path->setEndExtn(record.endextn);
+				path->set(pointsBegin(), pointsEnd());
+				return path;
+			}
+		case ::GdsParser::GdsRecords::TEXT: return new GdsText(m_cell->m_vText[index()]);
+		case ::GdsParser::GdsRecords::SREF: return new GdsCellReference(m_cell->m_vCellReference[index()]);
+		case ::GdsParser::GdsRecords::AREF: return new GdsCellArray(m_cell->m_vCellArray[index()]);
+		default: limboAssertMsg(0, "unsupported type %d", type());
+	}
+	return NULL;
+}
+
+GdsCompactCell::GdsCompactCell()
+	: m_compress(false)
+{
+}
+
+GdsCompactCell::GdsCompactCell(GdsCell const& cell, bool compress)
+	: m_compress(compress)
+{
+	assign(cell);
+}
+
+void GdsCompactCell::assign(GdsCell const& cell)
+{
+	clear();
+	m_name = cell.name();
+
+	// count objects and points once so that every pool is allocated only once
+	std::size_t numPolygons = 0;
+	std::size_t numPaths = 0;
+	std::size_t numPoints = 0;
+	for (std::vector<GdsCell::object_entry_type>::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+	{
+		if (it->first == ::GdsParser::GdsRecords::BOUNDARY || it->first == ::GdsParser::GdsRecords::BOX)
+		{
+			numPolygons += 1;
+			if (!m_compress)
+				numPoints += static_cast<GdsPolygon const*>(it->second)->size();
+		}
+		else if (it->first == ::GdsParser::GdsRecords::PATH)
+		{
+			numPaths += 1;
+			numPoints += static_cast<GdsPath const*>(it->second)->size();
+		}
+	}
+	m_vEntry.reserve(cell.objects().size());
+	m_vPolygon.reserve(numPolygons);
+	m_vPath.reserve(numPaths);
+	m_vPoint.reserve(numPoints);
+
+	for (std::vector<GdsCell::object_entry_type>::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+	{
+		switch (it->first)
+		{
+			case ::GdsParser::GdsRecords::BOUNDARY:
+			case ::GdsParser::GdsRecords::BOX:
+				{
+					GdsPolygon const* polygon = static_cast<GdsPolygon const*>(it->second);
+					rectangle_type box;
+					if (toRectangle(polygon->begin(), polygon->end(), box))
+						addRectangle(polygon->layer(), polygon->datatype(), box);
+					else
+						addPolygon(polygon->layer(), polygon->datatype(), polygon->begin(), polygon->end());
+				}
+				break;
+			case ::GdsParser::GdsRecords::PATH:
+				{
+					GdsPath const* path = static_cast<GdsPath const*>(it->second);
+					Path record;
+					record.layer = path->layer();
+					record.datatype = path->datatype();
+					record.pathtype = path->pathtype();
+					record.width = path->width();
+					record.bgnextn = path->bgnExtn();
+					record.endextn = path->endExtn();
+					record.offset = m_vPoint.size();
+					m_vPoint.insert(m_vPoint.end(), path->begin(), path->end());
+					record.size = m_vPoint.size() - record.offset;
+					m_vEntry.push_back(entry_type(::GdsParser::GdsRecords::PATH, m_vPath.size()));
+					m_vPath.push_back(record);
+				}
+				break;
+			case ::GdsParser::GdsRecords::TEXT:
+				addText(*static_cast<GdsText const*>(it->second));
+				break;
+			case ::GdsParser::GdsRecords::SREF:
+				addCellReference(*static_cast<GdsCellReference const*>(it->second));
+				break;
+			case ::GdsParser::GdsRecords::AREF:
+				addCellArray(*static_cast<GdsCellArray const*>(it->second));
+				break;
+			default:
+				limboAssertMsg(0, "unsupported type %d", it->first);
+		}
+	}
+}
+
+void GdsCompactCell::toCell(GdsCell& cell) const
+{
+	cell.setName(m_name);
+	cell.objects().reserve(cell.objects().size() + m_vEntry.size());
+	for (const_iterator it = objects().begin(), ite = objects().end(); it != ite; ++it)
+	{
+		object_view view = *it;
+		::GdsParser::GdsRecords::EnumType type = (view.type() == ::GdsParser::GdsRecords::BOX)? ::GdsParser::GdsRecords::BOUNDARY : view.type();
+		cell.objects().push_back(GdsCell::object_entry_type(type, view.toObject()));
+	}
+}
+
+void GdsCompactCell::clear()
+{
+	m_name.clear();
+	m_vEntry.clear();
+	m_vRectangle.clear();
+	m_vPolygon.clear();
+	m_vPath.clear();
+	m_vText.clear();
+	m_vCellReference.clear();
+	m_vCellArray.clear();
+	m_vPoint.clear();
+	m_vByte.clear();
+}
+
+void GdsCompactCell::setCompressPolygons(bool c)
+{
+	limboAssertMsg(m_vPolygon.empty(), "cannot change compression of %lu polygons", m_vPolygon.size());
+	m_compress = c;
+}
+
+GdsCompactCell::polygon_view GdsCompactCell::polygon(Polygon const& polygon) const
+{
+	if (m_compress)
+		return polygon_view(polygon_point_iterator((polygon.size)? &m_vByte[polygon.offset] : NULL, polygon.size), polygon_point_iterator(NULL, 0), polygon.size);
+	return polygon_view(polygon_point_iterator(pointsBegin(polygon)), polygon_point_iterator(pointsEnd(polygon)), polygon.size);
+}
+
+unsigned int GdsCompactCell::encodePolygon(std::vector<point_type> const& vPoint)
+{
+	std::size_t n = vPoint.size();
+	// a Manhattan polygon needs alternating edges of non-zero length, starting from a horizontal one
+	std::size_t start = (n && vPoint[0].y() == vPoint[1%n].y())? 0 : 1;
+	bool manhattan = (n >= 4 && n%2 == 0);
+	for (std::size_t i = 0; i < n && manhattan; ++i)
+	{
+		point_type const& p0 = vPoint[(start+i)%n];
+		point_type const& p1 = vPoint[(start+i+1)%n];
+		manhattan = (i%2 == 0)? (p0.y() == p1.y() && p0.x() != p1.x()) : (p0.x() == p1.x() && p0.y() != p1.y());
+	}
+
+	if (manhattan)
+	{
+		m_vByte.push_back(0);
+		GdsCompactCellDetails::putSignedVarint(m_vByte, vPoint[start].x());
+		GdsCompactCellDetails::putSignedVarint(m_vByte, vPoint[start].y());
+		// the coordinate that changes along each edge, except for the last edge closing the loop
+		for (std::size_t i = 1; i+1 < n; ++i)
+		{
+			point_type const& p0 = vPoint[(start+i-1)%n];
+			point_type const& p1 = vPoint[(start+i)%n];
+			GdsCompactCellDetails::putSignedVarint(m_vByte, (i%2)? (long long)p1.x() - p0.x() : (long long)p1.y() - p0.y());
+		}
+	}
+	else if (n)
+	{
+		m_vByte.push_back(1);
+		GdsCompactCellDetails::putSignedVarint(m_vByte, vPoint[0].x());
+		GdsCompactCellDetails::putSignedVarint(m_vByte, vPoint[0].y());
+		for (std::size_t i = 1; i < n; ++i)
+		{
+			GdsCompactCellDetails::putSignedVarint(m_vByte, (long long)vPoint[i].x() - vPoint[i-1].x());
+			GdsCompactCellDetails::putSignedVarint(m_vByte, (long long)vPoint[i].y() - vPoint[i-1].y());
+		}
+	}
+	return n;
+}
+
+void GdsCompactCell::addRectangle(int layer, int datatype, rectangle_type const& box)
+{
+	Rectangle rect;
+	rect.layer = layer;
+	rect.datatype = datatype;
+	rect.box = box;
+	m_vEntry.push_back(entry_type(::GdsParser::GdsRecords::BOX, m_vRectangle.size()));
+	m_vRectangle.push_back(rect);
+}
+
+void GdsCompactCell::addPath(int layer, int datatype, int pathtype, int width, int bgnextn, int endextn, std::vector<point_type> const& vPoint)
+{
+	Path path;
+	path.layer = layer;
+	path.datatype = datatype;
+	path.pathtype = pathtype;
+	path.width = width;
+	path.bgnextn = bgnextn;
+	path.endextn = endextn;
+	path.offset = m_vPoint.size();
+	path.size = vPoint.size();
+	m_vPoint.insert(m_vPoint.end(), vPoint.begin(), vPoint.end());
+	m_vEntry.push_back(entry_type(::GdsParser::GdsRecords::PATH, m_vPath.size()));
+	m_vPath.push_back(path);
+}
+
+void GdsCompactCell::addText(GdsText const& text)
+{
+	m_vEntry.push_back(entry_type(::GdsParser::GdsRecords::TEXT, m_vText.size()));
+	m_vText.push_back(text);
+}
+
+void GdsCompactCell::addCellReference(GdsCellReference const& cellRef)
+{
+	m_vEntry.push_back(entry_type(::GdsParser::GdsRecords::SREF, m_vCellReference.size()));
+	m_vCellReference.push_back(cellRef);
+}
+
+void GdsCompactCell::addCellArray(GdsCellArray const& cellArray)
+{
+	m_vEntry.push_back(entry_type(::GdsParser::GdsRecords::AREF, m_vCellArray.size()));
+	m_vCellArray.push_back(cellArray);
+}
+
+}} // namespace GdsParser // GdsDB
@@ -0,0 +1,511 @@
+/**
+ * @file   GdsCompactCell.h
+ * @brief  GDSII cell with contiguous storage of objects by types
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_GDSII_GDSDB_GDSCOMPACTCELL_H
+#define LIMBO_PARSERS_GDSII_GDSDB_GDSCOMPACTCELL_H
+
+#include <vector>
+#include <iterator>
+#include <limbo/containers/LargeMemory.h>
+#include <limbo/parsers/gdsii/gdsdb/GdsObjects.h>
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+/// namespace for Limbo.GdsParser.GdsDB
+namespace GdsDB
+{
+
+/// @namespace GdsParser::GdsDB::GdsCompactCellDetails
+/// @brief Variable-length integers of compressed polygons in @ref GdsParser::GdsDB::GdsCompactCell
+namespace GdsCompactCellDetails
+{
+
+/// @brief append an unsigned integer with 7 bits per byte, least significant group first
+/// @tparam ByteArray vector of bytes
+/// @param v byte buffer
+/// @param value value
+template <typename ByteArray>
+inline void putVarint(ByteArray& v, unsigned long long value)
+{
+	while (value >= 0x80)
+	{
+		v.push_back((unsigned char)(value | 0x80));
+		value >>= 7;
+	}
+	v.push_back((unsigned char)value);
+}
+/// @brief append a signed integer, zigzag encoded so small magnitudes take one byte
+/// @tparam ByteArray vector of bytes
+/// @param v byte buffer
+/// @param value value
+template <typename ByteArray>
+inline void putSignedVarint(ByteArray& v, long long value)
+{
+	putVarint(v, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+/// @brief read an unsigned integer written by @ref putVarint
+/// @param p current position, moved past the integer
+/// @return value
+inline unsigned long long getVarint(unsigned char const*& p)
+{
+	unsigned long long value = *p & 0x7f;
+	for (int shift = 7; *p++ & 0x80; shift += 7)
+		value |= (unsigned long long)(*p & 0x7f) << shift;
+	return value;
+}
+/// @brief read a signed integer written by @ref putSignedVarint
+/// @param p current position, moved past the integer
+/// @return value
+inline long long getSignedVarint(unsigned char const*& p)
+{
+	unsigned long long value = getVarint(p);
+	return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+} // namespace GdsCompactCellDetails
+
+/**
+	GDSII cell with structure-of-arrays storage \n
+\n
+	Objects are kept in one pool per type instead of separately allocated @ref GdsParser::GdsDB::GdsObject.
+	Points of all polygons and paths share one buffer, so a polygon only costs a small record plus its points.
+	Axis-parallel rectangles are kept as boxes without points.
+	The order of objects is kept in an entry array, which is exposed through @ref GdsParser::GdsDB::GdsCompactCell::objects
+	as light-weight views. \n
+\n
+	Conversion from @ref GdsParser::GdsDB::GdsCell stores a BOUNDARY with 4 corners (or 5 points with the first repeated)
+	of an axis-parallel rectangle as a rectangle; it is written back as a 4-point polygon starting from the lower left corner. \n
+\n
+	With @ref GdsParser::GdsDB::GdsCompactCell::setCompressPolygons, polygons are kept in a byte buffer instead of the point buffer.
+	A Manhattan polygon is stored as its compact coordinates x0, y0, x1, y1, ... of alternating edges,
+	where the first two are absolute and the others are deltas to the previous coordinate on the same axis, all as variable-length integers;
+	it starts from a vertex with a horizontal edge next, so it may start one vertex later than the input.
+	Other polygons keep the first vertex and deltas between vertices.
+	Such polygons are decoded on access through @ref GdsParser::GdsDB::GdsCompactCell::polygon,
+	and Manhattan ones also through @ref GdsParser::GdsDB::GdsCompactCell::polygon90, which models the polygon_90 concept of Boost.Polygon.
+	Most edges of standard cells and routes are short, so a vertex of a Manhattan polygon usually takes 2 bytes instead of 8.
+*/
+class GdsCompactCell
+{
+	public:
+        /// @nowarn
+		typedef GdsObject::coordinate_type coordinate_type;
+		typedef GdsObject::point_type point_type;
+		typedef GdsObject::rectangle_type rectangle_type;
+        /// @endnowarn
+        /// point buffer, mapped with huge pages and spread over NUMA nodes for large layouts
+		typedef std::vector<point_type, limbo::containers::LargeAllocator<point_type> > point_array_type;
+        /// byte buffer of compressed polygons, with the same memory as the point buffer
+		typedef std::vector<unsigned char, limbo::containers::LargeAllocator<unsigned char> > byte_array_type;
+        /// entry of an object, GDSII record and index in the pool of its type; rectangles use BOX
+		typedef std::pair< ::GdsParser::GdsRecords::EnumType, unsigned int> entry_type;
+
+        /// @brief rectangle record
+		struct Rectangle
+		{
+			int layer; ///< layer
+			int datatype; ///< data type
+			rectangle_type box; ///< rectangle
+		};
+        /// @brief polygon record, points are in [offset, offset+size) of the shared point buffer
+		struct Polygon
+		{
+			int layer; ///< layer
+			int datatype; ///< data type
+			unsigned int offset; ///< offset to point buffer
+			unsigned int size; ///< number of points
+		};
+        /// @brief path record, points are in [offset, offset+size) of the shared point buffer
+		struct Path
+		{
+			int layer; ///< layer
+			int datatype; ///< data type
+			int pathtype; ///< path type
+			coordinate_type width; ///< width
+			coordinate_type bgnextn; ///< begin point extension
+			coordinate_type endextn; ///< end point extension
+			unsigned int offset; ///< offset to point buffer
+			unsigned int size; ///< number of points
+		};
+
+        /// @brief forward iterator decoding points of a polygon
+		class polygon_point_iterator
+		{
+			public:
+                /// @nowarn
+				typedef std::forward_iterator_tag iterator_category;
+				typedef point_type value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef point_type const* pointer;
+				typedef point_type const& reference;
+                /// @endnowarn
+
+                /// @brief default constructor
+				polygon_point_iterator() : m_point(NULL), m_byte(NULL), m_remain(0), m_manhattan(false), m_horizontal(true), m_firstX(0) {}
+                /// @brief constructor over points of the point buffer
+                /// @param p current point
+				explicit polygon_point_iterator(point_type const* p) : m_point(p), m_byte(NULL), m_remain(0), m_manhattan(false), m_horizontal(true), m_firstX(0) {}
+                /// @brief constructor over an encoded polygon
+                /// @param p start of the encoded polygon
+                /// @param size number of vertices, 0 for the end iterator
+				polygon_point_iterator(unsigned char const* p, unsigned int size);
+
+                /// @return current point
+				reference operator*() const {return (m_point)? *m_point : m_current;}
+                /// @return pointer to current point
+				pointer operator->() const {return &**this;}
+                /// @brief move to next point
+				polygon_point_iterator& operator++();
+                /// @brief move to next point
+				polygon_point_iterator operator++(int) {polygon_point_iterator tmp (*this); ++*this; return tmp;}
+                /// @param rhs another iterator
+				bool operator==(polygon_point_iterator const& rhs) const {return (m_point)? m_point == rhs.m_point : m_remain == rhs.m_remain;}
+                /// @param rhs another iterator
+				bool operator!=(polygon_point_iterator const& rhs) const {return !(*this == rhs);}
+			protected:
+				point_type const* m_point; ///< current point in the point buffer, NULL if decoding
+				unsigned char const* m_byte; ///< next byte to decode
+				unsigned int m_remain; ///< number of points from the current one to the end
+				bool m_manhattan; ///< whether the polygon has alternating edges
+				bool m_horizontal; ///< whether the next edge is horizontal
+				coordinate_type m_firstX; ///< x of the first vertex, closing the last edge
+				point_type m_current; ///< current point
+		};
+
+        /// @brief forward iterator decoding compact coordinates of a Manhattan polygon
+		class compact_iterator
+		{
+			public:
+                /// @nowarn
+				typedef std::forward_iterator_tag iterator_category;
+				typedef coordinate_type value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef coordinate_type const* pointer;
+				typedef coordinate_type const& reference;
+                /// @endnowarn
+
+                /// @brief default constructor
+				compact_iterator() : m_byte(NULL), m_remain(0), m_index(0) {m_last[0] = m_last[1] = 0;}
+                /// @brief constructor
+                /// @param p first coordinate after the header of an encoded polygon
+                /// @param size number of coordinates, 0 for the end iterator
+				compact_iterator(unsigned char const* p, unsigned int size) : m_byte(p), m_remain(size), m_index(0)
+				{
+					m_last[0] = m_last[1] = 0;
+					if (m_remain)
+						m_last[0] = GdsCompactCellDetails::getSignedVarint(m_byte);
+				}
+
+                /// @return current coordinate
+				reference operator*() const {return m_last[m_index];}
+                /// @brief move to next coordinate
+				compact_iterator& operator++()
+				{
+					if (--m_remain)
+					{
+						m_index ^= 1;
+						m_last[m_index] += GdsCompactCellDetails::getSignedVarint(m_byte);
+					}
+					return *this;
+				}
+                /// @brief move to next coordinate
+				compact_iterator operator++(int) {compact_iterator tmp (*this); ++*this; return tmp;}
+                /// @param rhs another iterator
+				bool operator==(compact_iterator const& rhs) const {return m_remain == rhs.m_remain;}
+                /// @param rhs another iterator
+				bool operator!=(compact_iterator const& rhs) const {return m_remain != rhs.m_remain;}
+			protected:
+				unsigned char const* m_byte; ///< next byte to decode
+				unsigned int m_remain; ///< number of coordinates from the current one to the end
+				unsigned int m_index; ///< axis of the current coordinate
+				coordinate_type m_last[2]; ///< last x and y, the second y is a delta to the first one, and so on
+		};
+
+        /// @brief view of a polygon, modeling the polygon concept of Boost.Polygon
+		class polygon_view
+		{
+			public:
+                /// @nowarn
+				typedef GdsCompactCell::coordinate_type coordinate_type;
+				typedef GdsCompactCell::point_type point_type;
+				typedef polygon_point_iterator iterator_type;
+                /// @endnowarn
+                /// @brief constructor
+                /// @param first, last begin and end iterator to points
+                /// @param size number of points
+				polygon_view(iterator_type first, iterator_type last, std::size_t size) : m_first(first), m_last(last), m_size(size) {}
+                /// @return begin iterator
+				iterator_type begin() const {return m_first;}
+                /// @return end iterator
+				iterator_type end() const {return m_last;}
+                /// @return number of points
+				std::size_t size() const {return m_size;}
+			protected:
+				iterator_type m_first; ///< begin iterator
+				iterator_type m_last; ///< end iterator
+				std::size_t m_size; ///< number of points
+		};
+
+        /// @brief view of a compressed Manhattan polygon, modeling the polygon_90 concept of Boost.Polygon
+		class polygon_90_view
+		{
+			public:
+                /// @nowarn
+				typedef GdsCompactCell::coordinate_type coordinate_type;
+				typedef compact_iterator compact_iterator_type;
+                /// @endnowarn
+                /// @brief constructor
+                /// @param p first coordinate after the header of an encoded polygon
+                /// @param size number of vertices
+				polygon_90_view(unsigned char const* p, unsigned int size) : m_byte(p), m_size(size) {}
+                /// @return begin iterator of compact coordinates
+				compact_iterator_type begin_compact() const {return compact_iterator_type(m_byte, m_size);}
+                /// @return end iterator of compact coordinates
+				compact_iterator_type end_compact() const {return compact_iterator_type(NULL, 0);}
+                /// @return number of vertices
+				std::size_t size() const {return m_size;}
+			protected:
+				unsigned char const* m_byte; ///< first coordinate
+				unsigned int m_size; ///< number of vertices
+		};
+
+        /// @brief light-weight view of an object in the cell
+		class object_view
+		{
+			public:
+                /// @brief constructor
+                /// @param cell the cell
+                /// @param entry entry of object
+				object_view(GdsCompactCell const& cell, entry_type const& entry) : m_cell(&cell), m_entry(entry) {}
+
+                /// @return GDSII record, BOX for rectangles
+				::GdsParser::GdsRecords::EnumType type() const {return m_entry.first;}
+                /// @return index in the pool of its type
+				unsigned int index() const {return m_entry.second;}
+                /// @return layer, maximum integer for references
+				int layer() const;
+                /// @return data type, maximum integer for references
+				int datatype() const;
+                /// @return begin of points of paths and uncompressed polygons
+				point_type const* pointsBegin() const;
+                /// @return end of points of paths and uncompressed polygons
+				point_type const* pointsEnd() const;
+                /// @brief create a separate GDSII object, the caller owns the returned object
+                /// @return a new object
+				GdsObject* toObject() const;
+			protected:
+				GdsCompactCell const* m_cell; ///< the cell
+				entry_type m_entry; ///< entry of object
+		};
+
+        /// @brief iterator of object views in the order of insertion
+		class const_iterator
+		{
+			public:
+                /// @brief constructor
+                /// @param cell the cell
+                /// @param it iterator to entry
+				const_iterator(GdsCompactCell const& cell, std::vector<entry_type>::const_iterator it) : m_cell(&cell), m_it(it) {}
+                /// @return view of current object
+				object_view operator*() const {return object_view(*m_cell, *m_it);}
+                /// @brief move to next object
+				const_iterator& operator++() {++m_it; return *this;}
+                /// @param rhs another iterator
+				bool operator==(const_iterator const& rhs) const {return m_it == rhs.m_it;}
+                /// @param rhs another iterator
+				bool operator!=(const_iterator const& rhs) const {return m_it != rhs.m_it;}
+			protected:
+				GdsCompactCell const* m_cell; ///< the cell
+				std::vector<entry_type>::const_iterator m_it; ///< iterator to entry
+		};
+
+        /// @brief range of object views, mirroring @ref GdsParser::GdsDB::GdsCell::objects
+		class object_range
+		{
+			public:
+                /// @brief constructor
+                /// @param cell the cell
+				object_range(GdsCompactCell const& cell) : m_cell(&cell) {}
+                /// @return begin iterator
+				const_iterator begin() const {return const_iterator(*m_cell, m_cell->m_vEntry.begin());}
+                /// @return end iterator
+				const_iterator end() const {return const_iterator(*m_cell, m_cell->m_vEntry.end());}
+                /// @return number of objects
+				std::size_t size() const {return m_cell->m_vEntry.size();}
+                /// @return true if there is no object
+				bool empty() const {return m_cell->m_vEntry.empty();}
+			protected:
+				GdsCompactCell const* m_cell; ///< the cell
+		};
+
+		/// default constructor
+		GdsCompactCell();
+		/// @brief construct from a cell
+        /// @param cell a GdsCell object
+        /// @param compress compress polygons, see @ref setCompressPolygons
+		explicit GdsCompactCell(GdsCell const& cell, bool compress = false);
+
+        /// @brief replace content with objects of a cell
+        /// @param cell a GdsCell object
+		void assign(GdsCell const& cell);
+        /// @brief convert to a cell with separately allocated objects
+        /// @param cell target cell, existing objects are kept
+		void toCell(GdsCell& cell) const;
+        /// @brief remove all objects, the compression of polygons is kept
+		void clear();
+        /// @brief keep polygons added later in the compressed byte buffer
+        /// @param c true to compress, only allowed when the cell has no polygon
+		void setCompressPolygons(bool c);
+        /// @return true if polygons are compressed
+		bool compressPolygons() const {return m_compress;}
+
+        /// @param layer layer
+        /// @param datatype data type
+        /// @param box rectangle
+		void addRectangle(int layer, int datatype, rectangle_type const& box);
+        /// @param layer layer
+        /// @param datatype data type
+        /// @param vPoint array of points
+		void addPolygon(int layer, int datatype, std::vector<point_type> const& vPoint) {addPolygon(layer, datatype, vPoint.begin(), vPoint.end());}
+        /// @tparam Iterator iterator to points
+        /// @param layer layer
+        /// @param datatype data type
+        /// @param first, last begin and end iterator to points
+		template <typename Iterator>
+		void addPolygon(int layer, int datatype, Iterator first, Iterator last);
+        /// @param layer layer
+        /// @param datatype data type
+        /// @param pathtype path type
+        /// @param width path width
+        /// @param bgnextn begin point extension
+        /// @param endextn end point extension
+        /// @param vPoint array of points
+		void addPath(int layer, int datatype, int pathtype, int width, int bgnextn, int endextn, std::vector<point_type> const& vPoint);
+        /// @param text text object
+		void addText(GdsText const& text);
+        /// @param cellRef cell reference object
+		void addCellReference(GdsCellReference const& cellRef);
+        /// @param cellArray cell array object
+		void addCellArray(GdsCellArray const& cellArray);
+
+		// accessors
+        /// @return name of cell
+		std::string const& name() const {return m_name;}
+        /// @param n name of cell
+		void setName(std::string const& n) {m_name = n;}
+
+        /// @return views of objects in the order of insertion
+		object_range objects() const {return object_range(*this);}
+        /// @return entries of objects in the order of insertion
+		std::vector<entry_type> const& entries() const {return m_vEntry;}
+        /// @return rectangle pool
+		std::vector<Rectangle> const& rectangles() const {return m_vRectangle;}
+        /// @return polygon pool
+		std::vector<Polygon> const& polygons() const {return m_vPolygon;}
+        /// @return path pool
+		std::vector<Path> const& paths() const {return m_vPath;}
+        /// @return text pool
+		std::vector<GdsText> const& texts() const {return m_vText;}
+        /// @return cell reference pool
+		std::vector<GdsCellReference> const& cellReferences() const {return m_vCellReference;}
+        /// @return cell array pool
+		std::vector<GdsCellArray> const& cellArrays() const {return m_vCellArray;}
+        /// @return point buffer shared by polygons and paths
+		point_array_type const& points() const {return m_vPoint;}
+        /// @return byte buffer of compressed polygons
+		byte_array_type const& polygonBytes() const {return m_vByte;}
+        /// @param polygon a polygon record
+        /// @return begin of points, NULL if polygons are compressed
+		point_type const* pointsBegin(Polygon const& polygon) const {return (m_compress || m_vPoint.empty())? NULL : &m_vPoint[0] + polygon.offset;}
+        /// @param polygon a polygon record
+        /// @return end of points, NULL if polygons are compressed
+		point_type const* pointsEnd(Polygon const& polygon) const {return (m_compress)? NULL : pointsBegin(polygon) + polygon.size;}
+        /// @param polygon a polygon record
+        /// @return view of points, compressed or not
+		polygon_view polygon(Polygon const& polygon) const;
+        /// @param polygon a polygon record
+        /// @return true if the polygon is compressed as a Manhattan polygon
+		bool isManhattan(Polygon const& polygon) const {return m_compress && polygon.size && m_vByte[polygon.offset] == 0;}
+        /// @param polygon a polygon record, which must be compressed as a Manhattan polygon
+        /// @return view of compact coordinates
+		polygon_90_view polygon90(Polygon const& polygon) const {return polygon_90_view(&m_vByte[polygon.offset] + 1, polygon.size);}
+        /// @param path a path record
+        /// @return begin of points
+		point_type const* pointsBegin(Path const& path) const {return m_vPoint.empty()? NULL : &m_vPoint[0] + path.offset;}
+        /// @param path a path record
+        /// @return end of points
+		point_type const* pointsEnd(Path const& path) const {return pointsBegin(path) + path.size;}
+	protected:
+		std::string m_name; ///< cell name
+		std::vector<entry_type> m_vEntry; ///< objects in the order of insertion
+		std::vector<Rectangle> m_vRectangle; ///< rectangles
+		std::vector<Polygon> m_vPolygon; ///< polygons
+		std::vector<Path> m_vPath; ///< paths
+		std::vector<GdsText> m_vText; ///< texts
+		std::vector<GdsCellReference> m_vCellReference; ///< cell references
+		std::vector<GdsCellArray> m_vCellArray; ///< cell arrays
+		point_array_type m_vPoint; ///< points of polygons and paths
+		byte_array_type m_vByte; ///< compressed polygons
+		bool m_compress; ///< whether polygons are compressed
+
+        /// @brief append a compressed polygon to the byte buffer
+        /// @param vPoint points without the closing point
+        /// @return number of vertices stored
+		unsigned int encodePolygon(std::vector<point_type> const& vPoint);
+};
+
+template <typename Iterator>
+inline void GdsCompactCell::addPolygon(int layer, int datatype, Iterator first, Iterator last)
+{
+	Polygon polygon;
+	polygon.layer = layer;
+	polygon.datatype = datatype;
+	if (m_compress)
+	{
+		std::vector<point_type> vPoint (first, last);
+		if (vPoint.size() > 1 && vPoint.front() == vPoint.back())
+			vPoint.pop_back();
+		polygon.offset = m_vByte.size();
+		polygon.size = encodePolygon(vPoint);
+	}
+	else
+	{
+		polygon.offset = m_vPoint.size();
+		m_vPoint.insert(m_vPoint.end(), first, last);
+		polygon.size = m_vPoint.size() - polygon.offset;
+	}
+	m_vEntry.push_back(entry_type(::GdsParser::GdsRecords::BOUNDARY, m_vPolygon.size()));
+	m_vPolygon.push_back(polygon);
+}
+
+} // namespace GdsDB
+} // namespace GdsParser
+
+/// Boost.Polygon
+namespace boost { namespace polygon {
+
+/// specialization for Boost.Polygon traits for @ref GdsParser::GdsDB::GdsCompactCell::polygon_view
+template <>
+struct geometry_concept<GdsParser::GdsDB::GdsCompactCell::polygon_view>
+{
+    /// @nowarn
+	typedef polygon_concept type;
+    /// @endnowarn
+};
+
+/// specialization for Boost.Polygon traits for @ref GdsParser::GdsDB::GdsCompactCell::polygon_90_view
+template <>
+struct geometry_concept<GdsParser::GdsDB::GdsCompactCell::polygon_90_view>
+{
+    /// @nowarn
+	typedef polygon_90_concept type;
+    /// @endnowarn
+};
+
+}} // namespace boost // namespace polygon
+
+#endif
@@ -8,14 +8,56 @@
 #include <limbo/parsers/gdsii/gdsdb/GdsIO.h>
 #include <limbo/parsers/gdsii/gdsdb/GdsObjectHelpers.h>
 #include <limbo/preprocessor/Msg.h>
+#include <limbo/preprocessor/AssertMsg.h>
+#include <limbo/preprocessor/Instrument.h>
+#include <limbo/string/String.h>
+#include <limbo/containers/TaskPool.h>
 #include <exception>
+#include <sys/stat.h>
 
 namespace GdsParser { namespace GdsDB {
 
 namespace gtl = boost::polygon;
 using namespace gtl::operators;
 
+/// @brief size and modification time of a file 
+/// @param filename file name 
+/// @param size file size 
+/// @param time modification time 
+/// @return false if the file does not exist 
+static bool gdsFileStat(std::string const& filename, std::size_t& size, long& time)
+{
+    struct stat st; 
+    if (stat(filename.c_str(), &st) != 0)
+        return false; 
+    size = st.st_size; 
+    time = st.st_mtime; 
+    return true; 
+}
+
 bool GdsReader::operator() (std::string const& filename)  
+{
+    limboScopedTimer("GdsParser::read"); 
+    limboScopedAllocations("GdsParser::read"); 
+    if (::GdsParser::is_oasis(filename))
+        return readOasis(filename); 
+    return readStream(filename, 1); 
+}
+
+bool GdsReader::readOasis(std::string const& filename)
+{
+    m_fileSize = 0; 
+	// reset temporary data 
+	m_status = ::GdsParser::GdsRecords::UNKNOWN; 
+	reset();
+	m_vUnsupportRecord.assign(::GdsParser::GdsRecords::UNKNOWN, 0); 
+    bool flag = ::GdsParser::read_oasis(*this, filename, m_filter); 
+    m_db.resolveCellReferences(); 
+	printUnsupportRecords();
+	return flag; 
+}
+
+bool GdsReader::readStream(std::string const& filename, int numThreads)
 {
     // calculate file size 
     std::ifstream in (filename.c_str());
@@ -29,12 +71,176 @@ bool GdsReader::operator() (std::string const& filename)
 	m_status = ::GdsParser::GdsRecords::UNKNOWN; 
 	reset();
 	m_vUnsupportRecord.assign(::GdsParser::GdsRecords::UNKNOWN, 0); 
+    std::size_t firstCell = m_db.cells().size(); 
     // read gds 
-    bool flag = ::GdsParser::read(*this, filename);
+    bool flag = ::GdsParser::read(*this, filename, m_filter, numThreads, m_profiler);
+    m_db.resolveCellReferences(); 
+    // cells with filtered layers differ from the file 
+    if (flag && m_filter.empty() && limbo::get_file_suffix(filename) != "gz")
+    {
+        ::GdsParser::GdsFileMapping mapping; 
+        std::vector< ::GdsParser::GdsStructureRange> vStructure; 
+        if (mapping.open(filename.c_str()) && ::GdsParser::scan_structures(mapping.data(), mapping.size(), vStructure))
+            setSourceRanges(filename, mapping.size(), vStructure, firstCell); 
+    }
 	printUnsupportRecords();
 	return flag; 
 }
 
+bool GdsReader::readBuffer(const char* buffer, std::size_t length)
+{
+    m_fileSize = length; 
+	// reset temporary data 
+	m_status = ::GdsParser::GdsRecords::UNKNOWN; 
+	reset();
+	m_vUnsupportRecord.assign(::GdsParser::GdsRecords::UNKNOWN, 0); 
+    ::GdsParser::GdsReader parser (*this); 
+    parser.set_layer_filter(m_filter); 
+    parser.set_profiler(m_profiler); 
+    bool flag = parser.read_buffer(buffer, length); 
+    m_db.resolveCellReferences(); 
+	printUnsupportRecords();
+	return flag; 
+}
+
+/// @brief a group of consecutive structures decoded by one worker of @ref GdsReader::readParallel
+struct GdsReadStructureTask
+{
+    const char* buffer; ///< start of the GDSII stream 
+    std::vector< ::GdsParser::GdsStructureRange> const* vStructure; ///< all structures in the stream 
+    std::size_t first; ///< index of the first structure in the group 
+    std::size_t last; ///< index past the last structure in the group 
+    ::GdsParser::GdsLayerFilter const* filter; ///< layers to keep 
+    ::GdsParser::GdsRecordProfiler* profiler; ///< statistics of the group, NULL if disabled 
+    GdsDB db; ///< database collecting the cells of the group 
+    std::vector<unsigned int> vUnsupportRecord; ///< times of unsupported records in the group 
+};
+
+bool GdsReader::readParallel(std::string const& filename, int numThreads)
+{
+    limboScopedTimer("GdsParser::readParallel"); 
+    limboScopedAllocations("GdsParser::readParallel"); 
+    numThreads = std::min(numThreads, (int)limbo::containers::num_threads()); 
+    if (numThreads <= 1)
+        return (*this)(filename); 
+    // compressed files are decoded in order, but BGZF blocks can be inflated in parallel 
+    if (limbo::get_file_suffix(filename) == "gz")
+        return readStream(filename, numThreads); 
+
+    ::GdsParser::GdsFileMapping mapping; 
+    std::vector< ::GdsParser::GdsStructureRange> vStructure; 
+    if (!mapping.open(filename.c_str()) 
+            || !::GdsParser::scan_structures(mapping.data(), mapping.size(), vStructure) 
+            || vStructure.empty())
+        return (*this)(filename); 
+
+    m_fileSize = mapping.size(); 
+    std::size_t firstCell = m_db.cells().size(); 
+	// reset temporary data 
+	m_status = ::GdsParser::GdsRecords::UNKNOWN; 
+	reset();
+	m_vUnsupportRecord.assign(::GdsParser::GdsRecords::UNKNOWN, 0); 
+
+    ::GdsParser::GdsReader parser (*this); 
+    parser.set_profiler(m_profiler); 
+    // records before the first structure, i.e., HEADER, BGNLIB, LIBNAME, UNITS
+    parser.read_buffer(mapping.data(), vStructure.front().begin); 
+
+    // split structures into groups of similar bytes, 
+    // more groups than threads for load balance 
+    std::size_t numTasks = std::min(vStructure.size(), (std::size_t)numThreads*4); 
+    std::size_t totalBytes = vStructure.back().end - vStructure.front().begin; 
+    std::vector<GdsReadStructureTask> vTask (numTasks); 
+    // each group has its own statistics to avoid contention 
+    std::vector< ::GdsParser::GdsRecordProfiler> vProfiler ((m_profiler)? numTasks : 0); 
+    std::size_t first = 0; 
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+        GdsReadStructureTask& task = vTask[i]; 
+        task.buffer = mapping.data(); 
+        task.vStructure = &vStructure; 
+        task.filter = &m_filter; 
+        task.profiler = (m_profiler)? &vProfiler[i] : NULL; 
+        task.first = first; 
+        std::size_t targetEnd = vStructure.front().begin + totalBytes/numTasks*(i+1); 
+        std::size_t last = first+1; 
+        // leave at least one structure for each remaining group 
+        while (last < vStructure.size()-(numTasks-i-1) && (i+1 == numTasks || vStructure[last-1].end < targetEnd))
+            ++last; 
+        task.last = last; 
+        first = last; 
+    }
+
+    {
+        // the calling thread runs tasks as well while waiting 
+        limbo::containers::TaskPool pool (numThreads-1); 
+        for (std::size_t i = 0; i < numTasks; ++i)
+            pool.submit(GdsReader::readStructures, &vTask[i]); 
+        pool.wait(); 
+    }
+
+    // merge cells in the order of the file 
+    m_db.cells().reserve(m_db.cells().size() + vStructure.size()); 
+    for (std::vector<GdsReadStructureTask>::iterator it = vTask.begin(), ite = vTask.end(); it != ite; ++it)
+    {
+        for (std::vector<GdsCell>::iterator itc = it->db.cells().begin(), itce = it->db.cells().end(); itc != itce; ++itc)
+            m_db.addCell(itc->name()).swap(*itc); 
+        for (std::size_t i = 0, ie = m_vUnsupportRecord.size(); i < ie; ++i)
+            m_vUnsupportRecord[i] += it->vUnsupportRecord[i]; 
+        if (it->profiler)
+            m_profiler->merge(*it->profiler); 
+    }
+
+    // records after the last structure, i.e., ENDLIB 
+    m_status = ::GdsParser::GdsRecords::BGNLIB; 
+    parser.read_buffer(mapping.data() + vStructure.back().end, mapping.size() - vStructure.back().end); 
+
+    // references can only be resolved after all cells are merged 
+    m_db.resolveCellReferences(); 
+    if (m_filter.empty())
+        setSourceRanges(filename, mapping.size(), vStructure, firstCell); 
+    printUnsupportRecords(); 
+    return true; 
+}
+
+void GdsReader::setSourceRanges(std::string const& filename, std::size_t size, std::vector< ::GdsParser::GdsStructureRange> const& vStructure, std::size_t firstCell)
+{
+    std::size_t fileSize = 0; 
+    long fileTime = 0; 
+    if (!gdsFileStat(filename, fileSize, fileTime) || fileSize != size || m_db.cells().size() != firstCell + vStructure.size())
+        return; 
+    for (std::size_t i = 0, ie = vStructure.size(); i < ie; ++i)
+    {
+        if (m_db.cells()[firstCell+i].name() != vStructure[i].name)
+            return; 
+    }
+    // a new source id invalidates ranges of cells read from other files 
+    m_db.setSourceFile(filename, fileSize, fileTime); 
+    for (std::size_t i = 0, ie = vStructure.size(); i < ie; ++i)
+        m_db.cells()[firstCell+i].setSourceRange(m_db.sourceId(), vStructure[i].begin, vStructure[i].end); 
+}
+
+void GdsReader::readStructures(void* arg)
+{
+    GdsReadStructureTask& task = *static_cast<GdsReadStructureTask*>(arg); 
+    task.db.cells().reserve(task.last - task.first); 
+
+    GdsReader reader (task.db); 
+    reader.reset(); 
+	reader.m_vUnsupportRecord.assign(::GdsParser::GdsRecords::UNKNOWN, 0); 
+    ::GdsParser::GdsReader parser (reader); 
+    parser.set_layer_filter(*task.filter); 
+    parser.set_profiler(task.profiler); 
+    for (std::size_t i = task.first; i < task.last; ++i)
+    {
+        ::GdsParser::GdsStructureRange const& range = (*task.vStructure)[i]; 
+        // structures only appear inside a library 
+        reader.m_status = ::GdsParser::GdsRecords::BGNLIB; 
+        parser.read_buffer(task.buffer + range.begin, range.end - range.begin); 
+    }
+    task.vUnsupportRecord.swap(reader.m_vUnsupportRecord); 
+}
+
 void GdsReader::reset() 
 {
 	m_string.clear(); ///< STRING 
@@ -273,15 +479,160 @@ void GdsReader::float_cbk(::GdsParser::GdsRecords::EnumType record_type, ::GdsPa
 
 void GdsWriter::operator() (std::string const& filename) const 
 {
+    // map the source before the file to write is truncated 
+    ::GdsParser::GdsFileMapping mapping; 
+    mapSource(filename, mapping); 
+    ::GdsParser::GdsWriter gw (filename.c_str());
+    gw.create_lib(m_db.libname().c_str(), m_db.unit(), m_db.precision());
+
+	for (std::vector<GdsCell>::const_iterator it = m_db.cells().begin(), ite = m_db.cells().end(); it != ite; ++it)
+    {
+        if (!writeSource(gw, *it, mapping))
+            write(gw, *it);
+    }
+
+    gw.gds_write_endlib(); 
+}
+
+/// @brief a group of consecutive cells encoded by one worker of @ref GdsWriter::writeParallel
+struct GdsWriteCellTask
+{
+    GdsWriter const* writer; ///< writer of database 
+    std::size_t first; ///< index of the first cell in the group 
+    std::size_t last; ///< index past the last cell in the group 
+    ::GdsParser::GdsWriter* gw; ///< memory writer collecting encoded bytes 
+    ::GdsParser::GdsFileMapping const* mapping; ///< mapping of the source file 
+};
+
+void GdsWriter::writeParallel(std::string const& filename, int numThreads) const 
+{
+    numThreads = std::min(numThreads, (int)limbo::containers::num_threads()); 
+    if (numThreads <= 1 || m_db.cells().size() <= 1)
+    {
+        (*this)(filename); 
+        return; 
+    }
+
+    ::GdsParser::GdsFileMapping mapping; 
+    mapSource(filename, mapping); 
     ::GdsParser::GdsWriter gw (filename.c_str());
     gw.create_lib(m_db.libname().c_str(), m_db.unit(), m_db.precision());
 
+    // split cells into groups of similar number of objects, 
+    // more groups than threads for load balance 
+    std::size_t numCells = m_db.cells().size(); 
+    std::size_t numTasks = std::min(numCells, (std::size_t)numThreads*8); 
+    std::size_t totalObjects = 0; 
 	for (std::vector<GdsCell>::const_iterator it = m_db.cells().begin(), ite = m_db.cells().end(); it != ite; ++it)
-		write(gw, *it);
+        totalObjects += it->objects().size() + 1; 
+    std::vector<GdsWriteCellTask> vTask (numTasks); 
+    std::size_t first = 0; 
+    std::size_t objects = 0; 
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+        GdsWriteCellTask& task = vTask[i]; 
+        task.writer = this; 
+        task.first = first; 
+        task.gw = NULL; 
+        task.mapping = &mapping; 
+        std::size_t last = first; 
+        // leave at least one cell for each remaining group 
+        do 
+        {
+            objects += m_db.cells()[last++].objects().size() + 1; 
+        } while (last < numCells-(numTasks-i-1) && (i+1 == numTasks || objects < totalObjects/numTasks*(i+1))); 
+        task.last = last; 
+        first = last; 
+    }
+
+    // encode groups in waves to bound memory, and write each wave in order 
+    // the calling thread runs tasks as well while waiting 
+    limbo::containers::TaskPool pool (numThreads-1); 
+    std::size_t waveSize = numThreads*2; 
+    for (std::size_t wave = 0; wave < numTasks; wave += waveSize)
+    {
+        std::size_t waveEnd = std::min(wave+waveSize, numTasks); 
+        for (std::size_t i = wave; i < waveEnd; ++i)
+        {
+            vTask[i].gw = new ::GdsParser::GdsWriter(); 
+            pool.submit(GdsWriter::writeCells, &vTask[i]); 
+        }
+        pool.wait(); 
+        for (std::size_t i = wave; i < waveEnd; ++i)
+        {
+            gw.write_bytes(vTask[i].gw->data(), vTask[i].gw->size()); 
+            delete vTask[i].gw; 
+            vTask[i].gw = NULL; 
+        }
+    }
 
     gw.gds_write_endlib(); 
 }
 
+void GdsWriter::writeCells(void* arg)
+{
+    GdsWriteCellTask& task = *static_cast<GdsWriteCellTask*>(arg); 
+    for (std::size_t i = task.first; i < task.last; ++i)
+    {
+        GdsCell const& cell = task.writer->m_db.cells()[i]; 
+        if (!task.writer->writeSource(*task.gw, cell, *task.mapping))
+            task.writer->write(*task.gw, cell); 
+    }
+}
+
+void GdsWriter::writeOasis(std::string const& filename, bool compress) const 
+{
+    ::GdsParser::OasisWriter ow (filename.c_str(), compress); 
+    if (!ow.good())
+        return; 
+    // grid steps per micron, rounded if it is close to an integer 
+    double unit = (m_db.precision() > 0)? 1e-6/m_db.precision() : 1.0/m_db.unit(); 
+    if (fabs(unit - floor(unit+0.5)) < 1e-9*unit)
+        unit = floor(unit+0.5); 
+    ow.create_lib(unit); 
+
+	for (std::vector<GdsCell>::const_iterator it = m_db.cells().begin(), ite = m_db.cells().end(); it != ite; ++it)
+        write(ow, *it); 
+
+    ow.end_lib(); 
+}
+
+bool GdsWriter::mapSource(std::string const& filename, ::GdsParser::GdsFileMapping& mapping) const 
+{
+    if (m_db.sourceFile().empty())
+        return false; 
+    std::size_t size = 0; 
+    long time = 0; 
+    // the source file is modified after read 
+    if (!gdsFileStat(m_db.sourceFile(), size, time) || size != m_db.sourceSize() || time != m_db.sourceTime())
+        return false; 
+    // writing over the source file truncates it 
+    struct stat src; 
+    struct stat dst; 
+    if (stat(m_db.sourceFile().c_str(), &src) == 0 && stat(filename.c_str(), &dst) == 0 
+            && src.st_dev == dst.st_dev && src.st_ino == dst.st_ino)
+        return false; 
+    if (!mapping.open(m_db.sourceFile().c_str()) || mapping.size() != size)
+    {
+        mapping.close(); 
+        return false; 
+    }
+    return true; 
+}
+
+bool GdsWriter::writeSource(::GdsParser::GdsWriter& gw, GdsCell const& cell, ::GdsParser::GdsFileMapping const& mapping) const 
+{
+    if (mapping.data() == NULL || !cell.hasSourceRange() || cell.sourceId() != m_db.sourceId() || cell.sourceEnd() > mapping.size())
+        return false; 
+    unsigned char const* begin = reinterpret_cast<unsigned char const*>(mapping.data()) + cell.sourceBegin(); 
+    unsigned char const* end = reinterpret_cast<unsigned char const*>(mapping.data()) + cell.sourceEnd(); 
+    // sanity check on BGNSTR and ENDSTR records 
+    if (end - begin < 8 || begin[2] != ::GdsParser::GdsRecords::BGNSTR || end[-2] != ::GdsParser::GdsRecords::ENDSTR)
+        return false; 
+    gw.write_bytes(reinterpret_cast<const char*>(begin), end - begin); 
+    return true; 
+}
+
 void GdsWriter::write(::GdsParser::GdsWriter& gw, GdsCell const& cell) const 
 {
     gw.gds_write_bgnstr();
@@ -429,4 +780,221 @@ void GdsWriter::write(::GdsParser::GdsWriter& gw, GdsCellArray const& object) co
     gw.gds_write_endel();                   // end of element
 }
 
+void GdsWriter::write(::GdsParser::OasisWriter& ow, GdsCell const& cell) const 
+{
+    ow.begin_cell(cell.name().c_str());
+
+	for (std::vector<std::pair< ::GdsParser::GdsRecords::EnumType, GdsObject*> >::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+	{
+		GdsObjectHelpers()(it->first, it->second, WriteCellObjectAction<GdsWriter, ::GdsParser::OasisWriter>(*this, ow, *it));
+	}
+}
+
+void GdsWriter::write(::GdsParser::OasisWriter& ow, GdsPolygon const& object) const
+{
+	std::vector<int> vx(object.size());
+	std::vector<int> vy(object.size());
+
+	std::size_t count = 0; 
+	for (GdsPolygon::iterator_type it = object.begin(), ite = object.end(); it != ite; ++it, ++count)
+	{
+		vx[count] = it->x();
+		vy[count] = it->y();
+	}
+
+	ow.write_polygon(object.layer(), object.datatype(), vx.data(), vy.data(), count);
+}
+
+void GdsWriter::write(::GdsParser::OasisWriter& ow, GdsPath const& object) const 
+{
+    int width = (object.width() != std::numeric_limits<int>::max())? object.width() : 0; 
+    int halfwidth = width/2; 
+    int bgnExtn = 0; 
+    int endExtn = 0; 
+    switch (object.pathtype())
+    {
+        case 1: // round ends are approximated by square ends 
+        case 2: 
+            bgnExtn = endExtn = halfwidth; 
+            break; 
+        case 4: 
+            if (object.bgnExtn() != std::numeric_limits<int>::max())
+                bgnExtn = object.bgnExtn(); 
+            if (object.endExtn() != std::numeric_limits<int>::max())
+                endExtn = object.endExtn(); 
+            break; 
+        default: 
+            break; 
+    }
+
+	std::vector<int> vx(object.size());
+	std::vector<int> vy(object.size());
+
+	std::size_t count = 0; 
+	for (GdsPath::const_iterator it = object.begin(); it != object.end(); ++it, ++count)
+	{
+		vx[count] = it->x();
+		vy[count] = it->y();
+	}
+
+    ow.write_path(object.layer(), (object.datatype() != std::numeric_limits<int>::max())? object.datatype() : 0, 
+            halfwidth, bgnExtn, endExtn, vx.data(), vy.data(), count); 
+}
+
+void GdsWriter::write(::GdsParser::OasisWriter& ow, GdsText const& object) const 
+{
+    // OASIS texts have no width, presentation or transformation 
+    ow.write_text(object.layer(), (object.texttype() != std::numeric_limits<int>::max())? object.texttype() : 0, 
+            object.position().x(), object.position().y(), object.text().c_str()); 
+}
+
+void GdsWriter::write(::GdsParser::OasisWriter& ow, GdsCellReference const& object) const 
+{
+    ow.write_placement(object.refCell().c_str(), object.position().x(), object.position().y(), 
+            (object.angle() != std::numeric_limits<double>::max())? object.angle() : 0, 
+            (object.magnification() != std::numeric_limits<double>::max())? object.magnification() : 1, 
+            object.strans() != std::numeric_limits<int>::max() && object.strans()/32768); 
+}
+
+void GdsWriter::write(::GdsParser::OasisWriter& ow, GdsCellArray const& object) const 
+{
+    // positions are the origin, displacements of all columns and all rows 
+    std::vector<GdsCellArray::point_type> const& vPosition = object.positions(); 
+    limboAssert(vPosition.size() == 3 && object.columns() > 0 && object.rows() > 0); 
+    long long colx = ((long long)vPosition[1].x() - vPosition[0].x())/object.columns(); 
+    long long coly = ((long long)vPosition[1].y() - vPosition[0].y())/object.columns(); 
+    long long rowx = ((long long)vPosition[2].x() - vPosition[0].x())/object.rows(); 
+    long long rowy = ((long long)vPosition[2].y() - vPosition[0].y())/object.rows(); 
+    ow.write_placement(object.refCell().c_str(), vPosition[0].x(), vPosition[0].y(), 
+            (object.angle() != std::numeric_limits<double>::max())? object.angle() : 0, 
+            (object.magnification() != std::numeric_limits<double>::max())? object.magnification() : 1, 
+            object.strans() != std::numeric_limits<int>::max() && object.strans()/32768, 
+            object.columns(), object.rows(), colx, coly, rowx, rowy); 
+}
+
+GdsStreamWriter::GdsStreamWriter(std::string const& filename, std::size_t bufferSize) 
+    : m_gw(new ::GdsParser::GdsWriter(filename.c_str(), bufferSize))
+    , m_db()
+    , m_encoder(m_db)
+    , m_state(BEFORE_LIB)
+    , m_numStructures(0)
+    , m_numObjects(0)
+{
+}
+
+GdsStreamWriter::~GdsStreamWriter()
+{
+    // leave a complete file even if the session is not ended 
+    if (m_state == IN_STRUCTURE)
+        endStructure(); 
+    if (m_state == IN_LIB)
+        endLib(); 
+    delete m_gw; 
+}
+
+void GdsStreamWriter::beginLib(std::string const& libname, double unit, double precision)
+{
+    check(BEFORE_LIB, "begin library"); 
+    m_db.setLibname(libname); 
+    m_db.setUnit(unit); 
+    m_db.setPrecision(precision); 
+    m_gw->create_lib(libname.c_str(), unit, precision); 
+    m_state = IN_LIB; 
+}
+
+void GdsStreamWriter::beginStructure(std::string const& name)
+{
+    check(IN_LIB, "begin structure"); 
+    m_gw->gds_write_bgnstr(); 
+    m_gw->gds_write_strname(name.c_str()); 
+    m_state = IN_STRUCTURE; 
+}
+
+void GdsStreamWriter::writeBoxes(int layer, int datatype, const int* boxes, std::size_t n)
+{
+    check(IN_STRUCTURE, "write boxes"); 
+    m_gw->write_boxes(layer, datatype, boxes, n); 
+    m_numObjects += n; 
+}
+
+void GdsStreamWriter::writePolygons(int layer, int datatype, const int* offsets, std::size_t n, const int* points, bool hasLast)
+{
+    check(IN_STRUCTURE, "write polygons"); 
+    m_gw->write_polygons(layer, datatype, offsets, n, points, hasLast); 
+    m_numObjects += n; 
+}
+
+void GdsStreamWriter::writeEncoded(::GdsParser::GdsWriter const& encoder)
+{
+    check(IN_STRUCTURE, "write encoded records"); 
+    m_gw->write_bytes(encoder.data(), encoder.size()); 
+}
+
+void GdsStreamWriter::write(GdsPolygon const& object)
+{
+    check(IN_STRUCTURE, "write polygon"); 
+    m_encoder.write(*m_gw, object); 
+    ++m_numObjects; 
+}
+
+void GdsStreamWriter::write(GdsPath const& object)
+{
+    check(IN_STRUCTURE, "write path"); 
+    m_encoder.write(*m_gw, object); 
+    ++m_numObjects; 
+}
+
+void GdsStreamWriter::write(GdsText const& object)
+{
+    check(IN_STRUCTURE, "write text"); 
+    m_encoder.write(*m_gw, object); 
+    ++m_numObjects; 
+}
+
+void GdsStreamWriter::write(GdsCellReference const& object)
+{
+    check(IN_STRUCTURE, "write cell reference"); 
+    m_encoder.write(*m_gw, object); 
+    ++m_numObjects; 
+}
+
+void GdsStreamWriter::write(GdsCellArray const& object)
+{
+    check(IN_STRUCTURE, "write cell array"); 
+    m_encoder.write(*m_gw, object); 
+    ++m_numObjects; 
+}
+
+void GdsStreamWriter::write(GdsCell const& cell)
+{
+    check(IN_LIB, "write cell"); 
+    m_encoder.write(*m_gw, cell); 
+    m_numObjects += cell.objects().size(); 
+    ++m_numStructures; 
+}
+
+void GdsStreamWriter::endStructure()
+{
+    check(IN_STRUCTURE, "end structure"); 
+    m_gw->gds_write_endstr(); 
+    ++m_numStructures; 
+    m_state = IN_LIB; 
+}
+
+void GdsStreamWriter::endLib()
+{
+    check(IN_LIB, "end library"); 
+    m_gw->gds_write_endlib(); 
+    // the writer flushes its buffer and closes the file on destruction 
+    delete m_gw; 
+    m_gw = NULL; 
+    m_state = AFTER_LIB; 
+}
+
+void GdsStreamWriter::check(State state, const char* action) const 
+{
+    static const char* names[] = {"before library", "in library", "in structure", "after library"}; 
+    limboAssertMsg(m_state == state, "cannot %s %s, expected %s", action, names[m_state], names[state]); 
+}
+
 }} // namespace GdsParser // GdsDB
@@ -12,6 +12,8 @@
 #include <limits>
 #include <limbo/parsers/gdsii/stream/GdsReader.h>
 #include <limbo/parsers/gdsii/stream/GdsWriter.h>
+#include <limbo/parsers/gdsii/stream/OasisReader.h>
+#include <limbo/parsers/gdsii/stream/OasisWriter.h>
 
 #include <limbo/parsers/gdsii/gdsdb/GdsObjects.h>
 
@@ -34,11 +36,40 @@ class GdsReader : ::GdsParser::GdsDataBaseKernel
 
         /// @brief constructor
         /// @param db GDSII database 
-		GdsReader(gdsdb_type& db) : m_db(db) {}
+		GdsReader(gdsdb_type& db) : m_db(db), m_profiler(NULL) {}
 
-		/// @brief API to read GDSII file 
-        /// @param filename GDSII file 
+		/// @brief API to read GDSII file, or OASIS file detected from its magic bytes 
+        /// @param filename GDSII or OASIS file 
 		bool operator() (std::string const& filename); 
+		/// @brief API to read OASIS file, see @ref GdsParser::OasisReader for the translation to GDSII records 
+        /// @param filename OASIS file 
+		bool readOasis(std::string const& filename); 
+		/// @brief API to read GDSII records from a memory buffer, 
+        /// e.g., a part of memory mapped file holding a range of structures 
+        /// @param buffer start of records 
+        /// @param length number of bytes 
+		bool readBuffer(const char* buffer, std::size_t length); 
+		/// @brief API to read GDSII file with structures decoded in parallel. 
+		/// The file is memory mapped and a quick scan over record headers locates all structures. 
+		/// Structures are then decoded by a @ref limbo::containers::TaskPool into cells of per-task databases, 
+		/// which are merged into the database in the order of the file. 
+		/// It falls back to serial reading for corrupted files or a single thread. 
+		/// For .gds.gz files, records are decoded serially while BGZF blocks are inflated in parallel. 
+        /// @param filename GDSII file 
+        /// @param numThreads number of threads, capped by @ref limbo::containers::num_threads 
+		bool readParallel(std::string const& filename, int numThreads); 
+        /// @brief only keep BOUNDARY, PATH and BOX elements on some layers in later reads, 
+        /// other elements are skipped by the parser without creating objects 
+        /// @param filter layers to keep, an empty filter keeps everything 
+		void setLayerFilter(::GdsParser::GdsLayerFilter const& filter) {m_filter = filter;}
+        /// @return layers to keep 
+		::GdsParser::GdsLayerFilter const& layerFilter() const {return m_filter;}
+        /// @brief collect statistics per record type in later reads, 
+        /// statistics of parallel reading are summed over threads 
+        /// @param profiler statistics, NULL to disable 
+		void setProfiler(::GdsParser::GdsRecordProfiler* profiler) {m_profiler = profiler;}
+        /// @return statistics per record type, NULL if disabled 
+		::GdsParser::GdsRecordProfiler* profiler() const {return m_profiler;}
 
 		/// @name required callbacks in parser 
         ///@{
@@ -85,10 +116,25 @@ class GdsReader : ::GdsParser::GdsDataBaseKernel
         ///@}
 
 	protected:
+		/// @brief read GDSII file through stream 
+        /// @param filename GDSII file 
+        /// @param numThreads number of threads to decompress BGZF files 
+		bool readStream(std::string const& filename, int numThreads); 
+		/// @brief record the file as the source of the database and the byte ranges of cells read from it, 
+		/// so that unmodified cells can be copied verbatim when written. 
+		/// Nothing is recorded if the structures do not match the cells. 
+        /// @param filename GDSII file 
+        /// @param size file size 
+        /// @param vStructure structures in the file 
+        /// @param firstCell index of the first cell read from the file 
+		void setSourceRanges(std::string const& filename, std::size_t size, std::vector< ::GdsParser::GdsStructureRange> const& vStructure, std::size_t firstCell); 
 		/// @brief reset all temporary data to default values 
 		void reset(); 
         /// @brief warn unsupported records 
 		void printUnsupportRecords() const; 
+        /// @brief decode a group of structures, run by worker threads of @ref GdsParser::GdsDB::GdsReader::readParallel
+        /// @param arg pointer to task 
+        static void readStructures(void* arg); 
 
 		// temporary data 
 		std::string m_string; ///< STRING 
@@ -112,6 +158,8 @@ class GdsReader : ::GdsParser::GdsDataBaseKernel
 		::GdsParser::GdsRecords::EnumType m_status; ///< current record status 
 		int m_fileSize; ///< file size in bytes 
 		gdsdb_type& m_db; ///< reference to GDSII database 
+		::GdsParser::GdsLayerFilter m_filter; ///< layers to keep 
+		::GdsParser::GdsRecordProfiler* m_profiler; ///< statistics per record type, NULL if disabled 
 
 		std::vector<unsigned int> m_vUnsupportRecord; ///< try to be clean at screen output, record the times of unsupported records 
 };
@@ -128,9 +176,24 @@ class GdsWriter
         /// @param db GDSII database 
 		GdsWriter(gdsdb_type const& db) : m_db(db) {}
 
-		/// @brief API to write GDSII file 
+		/// @brief API to write GDSII file. 
+		/// Cells unmodified since read from the source file of the database are copied from the file verbatim, 
+		/// unless the source file has changed or is the file to write. 
         /// @param filename GDSII file 
 		void operator() (std::string const& filename) const;
+		/// @brief API to write GDSII file with structures encoded in parallel. 
+		/// Groups of cells are encoded by a @ref limbo::containers::TaskPool into memory buffers, 
+		/// which are written to the file in the order of cells. 
+		/// Only a few groups are kept in memory at the same time. 
+        /// @param filename GDSII file 
+        /// @param numThreads number of threads, capped by @ref limbo::containers::num_threads 
+		void writeParallel(std::string const& filename, int numThreads) const;
+		/// @brief API to write OASIS file. 
+		/// AREF is written as PLACEMENT with a repetition. 
+		/// The half-width of PATH is half of WIDTH rounded down, and round ends of PATHTYPE 1 are written as half-width extensions. 
+        /// @param filename OASIS file 
+        /// @param compress write cells in CBLOCK records 
+		void writeOasis(std::string const& filename, bool compress = true) const;
 
 		/// @name helper functions to write gdsii objects 
         ///@{
@@ -155,10 +218,150 @@ class GdsWriter
 		void write(::GdsParser::GdsWriter& gw, GdsCellArray const& object) const; 
         ///@}
 
+		/// @name helper functions to write gdsii objects to OASIS 
+        ///@{
+        /// @param ow OASIS writer handler 
+        /// @param cell GDSII cell object 
+		void write(::GdsParser::OasisWriter& ow, GdsCell const& cell) const; 
+        /// @param ow OASIS writer handler 
+        /// @param object GDSII polygon object 
+		void write(::GdsParser::OasisWriter& ow, GdsPolygon const& object) const; 
+        /// @param ow OASIS writer handler 
+        /// @param object GDSII path object 
+		void write(::GdsParser::OasisWriter& ow, GdsPath const& object) const; 
+        /// @param ow OASIS writer handler 
+        /// @param object GDSII text object 
+		void write(::GdsParser::OasisWriter& ow, GdsText const& object) const; 
+        /// @param ow OASIS writer handler 
+        /// @param object GDSII cell reference object 
+		void write(::GdsParser::OasisWriter& ow, GdsCellReference const& object) const; 
+        /// @param ow OASIS writer handler 
+        /// @param object GDSII cell array object 
+		void write(::GdsParser::OasisWriter& ow, GdsCellArray const& object) const; 
+        ///@}
+
 	protected:
+        /// @brief encode a group of cells, run by worker threads of @ref GdsParser::GdsDB::GdsWriter::writeParallel
+        /// @param arg pointer to task 
+		static void writeCells(void* arg); 
+		/// @brief map the source file of the database if cells can be copied from it 
+        /// @param filename GDSII file to write 
+        /// @param mapping mapping of the source file 
+        /// @return true if the source file is mapped 
+		bool mapSource(std::string const& filename, ::GdsParser::GdsFileMapping& mapping) const; 
+		/// @brief copy the bytes of an unmodified cell from the source file 
+        /// @param gw GDSII writer handler 
+        /// @param cell GDSII cell object 
+        /// @param mapping mapping of the source file, may not be open 
+        /// @return false if the cell has to be encoded 
+		bool writeSource(::GdsParser::GdsWriter& gw, GdsCell const& cell, ::GdsParser::GdsFileMapping const& mapping) const; 
+
 		gdsdb_type const& m_db; ///< reference to GDSII database 
 };
 
+/// @brief write a GDSII file structure by structure without a database. \n
+/// Layout generators, e.g., decomposition into masks or fill insertion, create shapes progressively. 
+/// A session begins the library, begins a structure, appends batches of shapes, ends the structure, 
+/// and so on until the library is ended. 
+/// Shapes are encoded immediately into the buffer of @ref GdsParser::GdsWriter, which is flushed whenever it is full, 
+/// so memory is bounded by the buffer and the batch of the caller. \n
+/// Objects of the database are encoded as by @ref GdsParser::GdsDB::GdsWriter. 
+/// Structures referenced by SREF or AREF may come later in the file. 
+class GdsStreamWriter
+{
+	public:
+        /// @nowarn
+		typedef GdsDB gdsdb_type;
+        /// @endnowarn
+
+		/// @brief constructor
+        /// @param filename GDSII file, .gds.gz is compressed if enabled 
+        /// @param bufferSize bytes of the output buffer 
+		GdsStreamWriter(std::string const& filename, std::size_t bufferSize = 1024*1024);
+		/// @brief destructor, ends the open structure and library 
+		~GdsStreamWriter(); 
+
+		/// @brief begin the library 
+        /// @param libname name of library 
+        /// @param unit user unit 
+        /// @param precision database unit in meter 
+		void beginLib(std::string const& libname, double unit = 0.001, double precision = 1.0e-9); 
+		/// @brief begin a structure, the library must be open and no other structure 
+        /// @param name name of the structure 
+		void beginStructure(std::string const& name); 
+		/// @brief append boxes on a layer to the open structure as BOUNDARY records 
+        /// @param layer layer 
+        /// @param datatype data type 
+        /// @param boxes array of 4*n coordinates, xl, yl, xh, yh for each box 
+        /// @param n number of boxes 
+		void writeBoxes(int layer, int datatype, const int* boxes, std::size_t n); 
+		/// @brief append polygons on a layer to the open structure from a CSR-style buffer 
+        /// @param layer layer 
+        /// @param datatype data type 
+        /// @param offsets array of n+1 offsets, points of polygon i are [offsets[i], offsets[i+1]) 
+        /// @param n number of polygons 
+        /// @param points array of interleaved coordinates, x and y for each point 
+        /// @param hasLast whether the last point of each polygon is the same as the first point 
+		void writePolygons(int layer, int datatype, const int* offsets, std::size_t n, const int* points, bool hasLast = true); 
+		/// @brief append records encoded by a memory writer to the open structure, 
+		/// e.g., shapes of a tile encoded by another thread 
+        /// @param encoder memory writer of @ref GdsParser::GdsWriter 
+		void writeEncoded(::GdsParser::GdsWriter const& encoder); 
+		/// @name append objects of the database to the open structure 
+        ///@{
+        /// @param object GDSII polygon object 
+		void write(GdsPolygon const& object); 
+        /// @param object GDSII path object 
+		void write(GdsPath const& object); 
+        /// @param object GDSII text object 
+		void write(GdsText const& object); 
+        /// @param object GDSII cell reference object 
+		void write(GdsCellReference const& object); 
+        /// @param object GDSII cell array object 
+		void write(GdsCellArray const& object); 
+        ///@}
+		/// @brief write a whole cell as a structure, no other structure may be open 
+        /// @param cell GDSII cell object 
+		void write(GdsCell const& cell); 
+		/// @brief end the open structure 
+		void endStructure(); 
+		/// @brief end the library, flush the buffer and close the file 
+		void endLib(); 
+
+        /// @return number of structures ended 
+		std::size_t numStructures() const {return m_numStructures;}
+        /// @return number of objects written to structures 
+		std::size_t numObjects() const {return m_numObjects;}
+
+	protected:
+		/// @brief state of a session 
+		enum State 
+		{
+			BEFORE_LIB, ///< library not begun 
+			IN_LIB, ///< library open, no structure open 
+			IN_STRUCTURE, ///< structure open 
+			AFTER_LIB ///< library ended 
+		};
+
+		/// @brief check the state before writing 
+        /// @param state expected state 
+        /// @param action name of the action for the message 
+		void check(State state, const char* action) const; 
+
+		::GdsParser::GdsWriter* m_gw; ///< buffered writer of the file, NULL once the library is ended 
+		gdsdb_type m_db; ///< database without cells, keeps the library header 
+		GdsWriter m_encoder; ///< encoder of objects of the database 
+		State m_state; ///< state of the session 
+		std::size_t m_numStructures; ///< number of structures ended 
+		std::size_t m_numObjects; ///< number of objects written 
+
+	private:
+		/// @brief copy is not allowed as the file is owned 
+		GdsStreamWriter(GdsStreamWriter const&); 
+		/// @brief assignment is not allowed as the file is owned 
+		GdsStreamWriter& operator=(GdsStreamWriter const&); 
+};
+
 } // namespace GdsDB
 } // namespace GdsParser
 
@@ -0,0 +1,184 @@
+/**
+ * @file   GdsLazyDB.cpp
+ * @brief  Implementation of GDSII database with cells loaded on demand @ref GdsParser::GdsDB::GdsLazyDB
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/gdsii/gdsdb/GdsLazyDB.h>
+#include <limbo/preprocessor/AssertMsg.h>
+#include <limbo/string/String.h>
+#include <algorithm>
+
+namespace GdsParser { namespace GdsDB {
+
+GdsLazyDB::GdsLazyDB()
+    : m_clock(0)
+    , m_budget(0)
+    , m_usage(0)
+{
+}
+
+GdsLazyDB::~GdsLazyDB()
+{
+}
+
+bool GdsLazyDB::open(std::string const& filename)
+{
+    close();
+    if (limbo::get_file_suffix(filename) == "gz")
+        return false;
+    if (!m_mapping.open(filename.c_str())
+            || !::GdsParser::scan_structures(m_mapping.data(), m_mapping.size(), m_vStructure))
+    {
+        close();
+        return false;
+    }
+
+    // records before the first structure, i.e., HEADER, BGNLIB, LIBNAME, UNITS
+    std::size_t headerEnd = (m_vStructure.empty())? m_mapping.size() : m_vStructure.front().begin;
+    GdsReader reader (m_db);
+    reader.readBuffer(m_mapping.data(), headerEnd);
+
+    // placeholders in the order of the file
+    m_db.cells().reserve(m_vStructure.size());
+    for (std::vector< ::GdsParser::GdsStructureRange>::const_iterator it = m_vStructure.begin(), ite = m_vStructure.end(); it != ite; ++it)
+        m_db.addCell(it->name);
+    m_vLastUse.assign(m_vStructure.size(), 0);
+    return true;
+}
+
+void GdsLazyDB::close()
+{
+    m_db = gdsdb_type();
+    m_vStructure.clear();
+    m_vLastUse.clear();
+    m_mapping.close();
+    m_clock = 0;
+    m_usage = 0;
+}
+
+void GdsLazyDB::setMemoryBudget(std::size_t b)
+{
+    m_budget = b;
+    enforceBudget(m_vStructure.size());
+}
+
+bool GdsLazyDB::isLoaded(std::string const& cellName) const
+{
+    unsigned int idx = cellIndex(cellName);
+    return idx < m_vStructure.size() && m_vLastUse[idx];
+}
+
+GdsCell const* GdsLazyDB::getCell(std::string const& cellName)
+{
+    unsigned int idx = cellIndex(cellName);
+    if (idx == m_vStructure.size())
+        return NULL;
+    loadCell(idx);
+    enforceBudget(idx);
+    return &m_db.cells()[idx];
+}
+
+GdsCell GdsLazyDB::extractCell(std::string const& cellName)
+{
+    unsigned int idx = cellIndex(cellName);
+    if (idx == m_vStructure.size())
+        return GdsCell();
+    // the whole hierarchy must stay in memory during extraction,
+    // so the budget is only enforced afterwards
+    loadHierarchy(idx);
+    GdsCell targetCell = m_db.extractCell(cellName);
+    enforceBudget(idx);
+    return targetCell;
+}
+
+void GdsLazyDB::evict()
+{
+    for (unsigned int i = 0, ie = m_vStructure.size(); i < ie; ++i)
+    {
+        if (m_vLastUse[i])
+            releaseCell(i);
+    }
+}
+
+void GdsLazyDB::loadCell(unsigned int idx)
+{
+    if (!m_vLastUse[idx])
+    {
+        ::GdsParser::GdsStructureRange const& range = m_vStructure[idx];
+        // decode to a scratch database and move the cell to its placeholder
+        gdsdb_type scratch;
+        GdsReader reader (scratch);
+        reader.readBuffer(m_mapping.data() + range.begin, range.end - range.begin);
+        limboAssertMsg(scratch.cells().size() == 1, "failed to load cell %s", range.name.c_str());
+        m_db.cells()[idx].swap(scratch.cells().front());
+        // indices resolved in the scratch database are not valid here
+        m_db.resolveCellReferences(m_db.cells()[idx]);
+        m_usage += range.end - range.begin;
+    }
+    m_vLastUse[idx] = ++m_clock;
+}
+
+void GdsLazyDB::loadHierarchy(unsigned int idx)
+{
+    std::vector<unsigned int> vStack (1, idx);
+    std::vector<char> vVisited (m_vStructure.size(), false);
+    vVisited[idx] = true;
+    while (!vStack.empty())
+    {
+        unsigned int cur = vStack.back();
+        vStack.pop_back();
+        loadCell(cur);
+        GdsCell const& cell = m_db.cells()[cur];
+        for (std::vector<GdsCell::object_entry_type>::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+        {
+            unsigned int child = m_vStructure.size();
+            if (it->first == ::GdsParser::GdsRecords::SREF)
+                child = static_cast<GdsCellReference const*>(it->second)->refCellIndex();
+            else if (it->first == ::GdsParser::GdsRecords::AREF)
+                child = static_cast<GdsCellArray const*>(it->second)->refCellIndex();
+            if (child < m_vStructure.size() && !vVisited[child])
+            {
+                vVisited[child] = true;
+                vStack.push_back(child);
+            }
+        }
+    }
+}
+
+void GdsLazyDB::releaseCell(unsigned int idx)
+{
+    GdsCell empty;
+    empty.setName(m_vStructure[idx].name);
+    // objects are destroyed together with the swapped cell
+    m_db.cells()[idx].swap(empty);
+    m_usage -= m_vStructure[idx].end - m_vStructure[idx].begin;
+    m_vLastUse[idx] = 0;
+}
+
+void GdsLazyDB::enforceBudget(unsigned int keep)
+{
+    if (m_budget == 0 || m_usage <= m_budget)
+        return;
+
+    // loaded cells ordered from least recently used
+    std::vector<std::pair<std::size_t, unsigned int> > vLoaded;
+    for (unsigned int i = 0, ie = m_vStructure.size(); i < ie; ++i)
+    {
+        if (m_vLastUse[i] && i != keep)
+            vLoaded.push_back(std::make_pair(m_vLastUse[i], i));
+    }
+    std::sort(vLoaded.begin(), vLoaded.end());
+    for (std::vector<std::pair<std::size_t, unsigned int> >::const_iterator it = vLoaded.begin(), ite = vLoaded.end(); it != ite && m_usage > m_budget; ++it)
+        releaseCell(it->second);
+}
+
+unsigned int GdsLazyDB::cellIndex(std::string const& cellName) const
+{
+    GdsCell const* cell = m_db.getCell(cellName);
+    if (cell == NULL)
+        return m_vStructure.size();
+    return cell - &m_db.cells()[0];
+}
+
+}} // namespace GdsParser // GdsDB
@@ -0,0 +1,110 @@
+/**
+ * @file   GdsLazyDB.h
+ * @brief  GDSII database with cells loaded on demand
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_GDSII_GDSDB_GDSLAZYDB_H
+#define LIMBO_PARSERS_GDSII_GDSDB_GDSLAZYDB_H
+
+#include <limbo/parsers/gdsii/gdsdb/GdsIO.h>
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+/// namespace for Limbo.GdsParser.GdsDB
+namespace GdsDB
+{
+
+/**
+	GDSII database with cells loaded on demand \n
+\n
+	The file is memory mapped and only the byte ranges of structures are indexed on open.
+	A cell is decoded on its first access through @ref GdsParser::GdsDB::GdsLazyDB::getCell
+	or @ref GdsParser::GdsDB::GdsLazyDB::extractCell.
+	If a memory budget is set, least recently used cells are released when the budget is exceeded.
+	The memory of a cell is estimated by the number of bytes of its structure in the file. \n
+\n
+	Pointers returned by getCell are only valid until the next call that may load or release cells.
+*/
+class GdsLazyDB
+{
+	public:
+        /// @nowarn
+		typedef GdsDB gdsdb_type;
+        /// @endnowarn
+
+		/// @brief constructor
+		GdsLazyDB();
+		/// @brief destructor
+		~GdsLazyDB();
+
+		/// @brief index a GDSII file, .gds.gz is not supported
+        /// @param filename GDSII file
+        /// @return true if succeed
+		bool open(std::string const& filename);
+		/// @brief release all cells and the file
+		void close();
+
+        /// @return memory budget in bytes, 0 for unlimited
+		std::size_t memoryBudget() const {return m_budget;}
+        /// @param b memory budget in bytes, 0 for unlimited
+		void setMemoryBudget(std::size_t b);
+        /// @return estimated memory of loaded cells in bytes
+		std::size_t memoryUsage() const {return m_usage;}
+
+        /// @return number of cells in the file
+		std::size_t numCells() const {return m_vStructure.size();}
+        /// @param cellName cell name
+        /// @return true if the cell has been loaded
+		bool isLoaded(std::string const& cellName) const;
+
+		/// @brief given cell name and return the pointer to the cell,
+		/// load the cell if it has not been loaded, return NULL if not found
+        /// @param cellName cell name
+        /// @return pointer to the cell, NULL if not found
+		GdsCell const* getCell(std::string const& cellName);
+		/// @brief extract a cell into a new cell with flatten hierarchies,
+		/// load all cells referenced by it if needed
+        /// @param cellName cell name
+		GdsCell extractCell(std::string const& cellName);
+		/// @brief release all loaded cells
+		void evict();
+
+        /// @return underlying database with header information and loaded cells
+		gdsdb_type const& db() const {return m_db;}
+	protected:
+		/// @brief copy constructor is not allowed
+		GdsLazyDB(GdsLazyDB const&);
+		/// @brief assignment is not allowed
+		GdsLazyDB& operator=(GdsLazyDB const&);
+
+        /// @brief decode a cell if it has not been loaded and mark it as recently used
+        /// @param idx index of cell
+		void loadCell(unsigned int idx);
+        /// @brief load a cell and all cells in its hierarchy
+        /// @param idx index of cell
+		void loadHierarchy(unsigned int idx);
+        /// @brief release a loaded cell
+        /// @param idx index of cell
+		void releaseCell(unsigned int idx);
+        /// @brief release least recently used cells until memory usage is within budget
+        /// @param keep index of cell that should not be released
+		void enforceBudget(unsigned int keep);
+        /// @param cellName cell name
+        /// @return index of cell, numCells() if not found
+		unsigned int cellIndex(std::string const& cellName) const;
+
+		::GdsParser::GdsFileMapping m_mapping; ///< memory mapped file
+		std::vector< ::GdsParser::GdsStructureRange> m_vStructure; ///< byte ranges of structures
+		std::vector<std::size_t> m_vLastUse; ///< time stamp of last use for each cell, 0 if not loaded
+		std::size_t m_clock; ///< time stamp
+		std::size_t m_budget; ///< memory budget in bytes, 0 for unlimited
+		std::size_t m_usage; ///< estimated memory of loaded cells in bytes
+		gdsdb_type m_db; ///< database with a placeholder for each cell
+};
+
+} // namespace GdsDB
+} // namespace GdsParser
+
+#endif
@@ -9,6 +9,10 @@
 #define LIMBO_PARSERS_GDSII_GDSDB_GDSOBJECTHELPERS_H
 
 #include <cmath>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
 #include <boost/geometry/strategies/transform.hpp>
 #include <limbo/parsers/gdsii/stream/GdsReader.h>
 #include <limbo/parsers/gdsii/stream/GdsWriter.h>
@@ -142,18 +146,19 @@ struct DeleteCellObjectAction
 
 /// an action function for write a cell 
 /// @tparam GdsWriterType object writer type 
-template <typename GdsWriterType>
+/// @tparam StreamWriterType stream writer type, ::GdsParser::GdsWriter or ::GdsParser::OasisWriter
+template <typename GdsWriterType, typename StreamWriterType = ::GdsParser::GdsWriter>
 struct WriteCellObjectAction
 {
-	GdsWriterType const& writer; ///< wrapper of GDSII writer which will invoke ::GdsParser::GdsWriter to write 
-	::GdsParser::GdsWriter& gdsWriter; ///< GDSII writer 
+	GdsWriterType const& writer; ///< wrapper of GDSII writer which will invoke the stream writer to write 
+	StreamWriterType& gdsWriter; ///< stream writer 
 	std::pair< ::GdsParser::GdsRecords::EnumType, GdsObject*> const& target; ///< target object 
 
 	/// @brief constructor 
     /// @param w GDSII object writer 
-    /// @param gw GDSII writer 
+    /// @param gw stream writer 
     /// @param t target object 
-	WriteCellObjectAction(GdsWriterType const& w, ::GdsParser::GdsWriter& gw, std::pair< ::GdsParser::GdsRecords::EnumType, GdsObject*> const& t) : writer(w), gdsWriter(gw), target(t) {}
+	WriteCellObjectAction(GdsWriterType const& w, StreamWriterType& gw, std::pair< ::GdsParser::GdsRecords::EnumType, GdsObject*> const& t) : writer(w), gdsWriter(gw), target(t) {}
 	/// @brief copy constructor 
     /// @param rhs a WriteCellObjectAction object 
 	WriteCellObjectAction(WriteCellObjectAction const& rhs) : writer(rhs.writer), gdsWriter(rhs.gdsWriter), target(rhs.target) {}
@@ -174,18 +179,41 @@ struct WriteCellObjectAction
 	}
 }; 
 
+/// @brief cache of flattened cells in their own coordinate systems, keyed by cells in the database. 
+/// It is shared by all references during extraction so that each cell is flattened only once. 
+typedef std::map<GdsCell const*, GdsCell> ExtractCellCache; 
+
 /// @namespace GdsParser::GdsDB::ExtractCellObjectActionDetails 
 /// @brief Detailed action functions for extract objects of a cell 
 namespace ExtractCellObjectActionDetails 
 {
 
+/// @brief extract a reference into target cell with transformed copies of objects; 
+/// defined after @ref GdsParser::GdsDB::ApplyCellReferenceAction
+/// @param gdsDB GDSII database 
+/// @param cellRef a reference to a cell, the position of which is the location of the instance 
+/// @param refCell the cell referenced 
+/// @param targetCell target cell 
+/// @param cache cache of flattened cells, NULL to flatten the reference cell again 
+/// @param numThreads number of threads to transform instances of arrays 
+inline void extractCellReference(GdsDB const& gdsDB, GdsCellReference const& cellRef, GdsCell const& refCell, GdsCell& targetCell, ExtractCellCache* cache, int numThreads); 
+/// @brief extract all instances of an array into target cell, the reference cell is flattened only once; 
+/// defined after @ref GdsParser::GdsDB::ApplyCellReferenceAction
+/// @param gdsDB GDSII database 
+/// @param cellArray a cell array 
+/// @param refCell the cell referenced 
+/// @param targetCell target cell 
+/// @param cache cache of flattened cells, NULL if not available 
+/// @param numThreads number of threads to transform instances 
+inline void extractCellArray(GdsDB const& gdsDB, GdsCellArray const& cellArray, GdsCell const& refCell, GdsCell& targetCell, ExtractCellCache* cache, int numThreads); 
+
 /// default action is to copy objects 
 /// @tparam ObjectType GDSII object type 
 /// @param targetCell target cell 
 /// @param type GDSII record 
 /// @param object GDSII object in the cell 
 template <typename ObjectType>
-inline void extract(GdsDB const& /*gdsDB*/, GdsCell const& /*srcCell*/, GdsCell& targetCell, ::GdsParser::GdsRecords::EnumType type, ObjectType* object)
+inline void extract(GdsDB const& /*gdsDB*/, GdsCell const& /*srcCell*/, GdsCell& targetCell, ::GdsParser::GdsRecords::EnumType type, ObjectType* object, ExtractCellCache* /*cache*/, int /*numThreads*/)
 {
 	ObjectType* ptr = new ObjectType (*object); 
 	targetCell.objects().push_back(std::make_pair(type, ptr)); 
@@ -197,29 +225,35 @@ inline void extract(GdsDB const& /*gdsDB*/, GdsCell const& /*srcCell*/, GdsCell&
 /// @param targetCell target cell 
 /// @param type GDSII record 
 /// @param object the GDSII SREF object in the cell 
+/// @param cache cache of flattened cells, NULL if not available 
+/// @param numThreads number of threads to transform instances of arrays 
 template <>
-inline void extract<GdsCellReference>(GdsDB const& gdsDB, GdsCell const& srcCell, GdsCell& targetCell, ::GdsParser::GdsRecords::EnumType type, GdsCellReference* object)
+inline void extract<GdsCellReference>(GdsDB const& gdsDB, GdsCell const& srcCell, GdsCell& targetCell, ::GdsParser::GdsRecords::EnumType type, GdsCellReference* object, ExtractCellCache* cache, int numThreads)
 {
 	limboAssert(type == ::GdsParser::GdsRecords::SREF);
-	limboAssertMsg(srcCell.name() != object->refCell(), "self reference of cell %s", srcCell.name().c_str());
-	GdsCell const* refCell = gdsDB.getCell(object->refCell()); 
+	// resolved index avoids looking up the name for each instance 
+	GdsCell const* refCell = gdsDB.getRefCell(*object); 
 	limboAssertMsg(refCell, "failed to find reference cell %s", object->refCell().c_str());
-	// generate a new cell from reference 
-	GdsCell cell = object->extractCellRef(gdsDB, *refCell); 
-	// directly append object pointers to target cell 
-	targetCell.objects().insert(targetCell.objects().end(), cell.objects().begin(), cell.objects().end()); 
-	// must clear the list, otherwise, the pointers are destroyed 
-	cell.objects().clear(); 
+	limboAssertMsg(refCell != &srcCell, "self reference of cell %s", srcCell.name().c_str());
+	extractCellReference(gdsDB, *object, *refCell, targetCell, cache, numThreads); 
 }
 
 /// specialization for AREF 
+/// @param gdsDB GDSII database 
+/// @param srcCell source cell with the AREF object 
+/// @param targetCell target cell 
 /// @param type GDSII record 
-/// @todo finish extraction of GDSII AREF 
+/// @param object the GDSII AREF object in the cell 
+/// @param cache cache of flattened cells, NULL if not available 
+/// @param numThreads number of threads to transform instances 
 template <>
-inline void extract<GdsCellArray>(GdsDB const& /*gdsDB*/, GdsCell const& /*srcCell*/, GdsCell& /*targetCell*/, ::GdsParser::GdsRecords::EnumType type, GdsCellArray* /*object*/)
+inline void extract<GdsCellArray>(GdsDB const& gdsDB, GdsCell const& srcCell, GdsCell& targetCell, ::GdsParser::GdsRecords::EnumType type, GdsCellArray* object, ExtractCellCache* cache, int numThreads)
 {
 	limboAssert(type == ::GdsParser::GdsRecords::AREF);
-	limboAssertMsg(0, "not implemented yet"); 
+	GdsCell const* refCell = gdsDB.getRefCell(*object); 
+	limboAssertMsg(refCell, "failed to find reference cell %s", object->refCell().c_str());
+	limboAssertMsg(refCell != &srcCell, "self reference of cell %s", srcCell.name().c_str());
+	extractCellArray(gdsDB, *object, *refCell, targetCell, cache, numThreads); 
 }
 
 } // namespace ExtractCellObjectActionDetails
@@ -232,15 +266,19 @@ struct ExtractCellObjectAction
 	GdsDB const& gdsDB; ///< GDSII database 
 	GdsCell const& srcCell; ///< source cell 
 	GdsCell& targetCell; ///< target cell 
+	ExtractCellCache* cache; ///< cache of flattened cells, NULL if not available 
+	int numThreads; ///< number of threads to transform instances of arrays 
 
 	/// @brief constructor 
     /// @param db GDSII database 
     /// @param sc source cell 
     /// @param tc target cell 
-	ExtractCellObjectAction(GdsDB const& db, GdsCell const& sc, GdsCell& tc) : gdsDB(db), srcCell(sc), targetCell(tc) {}
+    /// @param c cache of flattened cells, NULL to flatten each reference from scratch 
+    /// @param nt number of threads to transform instances of arrays 
+	ExtractCellObjectAction(GdsDB const& db, GdsCell const& sc, GdsCell& tc, ExtractCellCache* c = NULL, int nt = 1) : gdsDB(db), srcCell(sc), targetCell(tc), cache(c), numThreads(nt) {}
 	/// @brief copy constructor 
     /// @param rhs an object 
-	ExtractCellObjectAction(ExtractCellObjectAction const& rhs) : gdsDB(rhs.gdsDB), srcCell(rhs.srcCell), targetCell(rhs.targetCell) {}
+	ExtractCellObjectAction(ExtractCellObjectAction const& rhs) : gdsDB(rhs.gdsDB), srcCell(rhs.srcCell), targetCell(rhs.targetCell), cache(rhs.cache), numThreads(rhs.numThreads) {}
 
     /// @brief API to run the extraction 
     /// 
@@ -252,7 +290,7 @@ struct ExtractCellObjectAction
 	template <typename ObjectType>
 	void operator()(::GdsParser::GdsRecords::EnumType type, ObjectType* object)
 	{
-		ExtractCellObjectActionDetails::extract(gdsDB, srcCell, targetCell, type, object);
+		ExtractCellObjectActionDetails::extract(gdsDB, srcCell, targetCell, type, object, cache, numThreads);
 	}
 
 	/// @return a message of action for debug 
@@ -345,6 +383,136 @@ struct XReflection
 	}
 };
 
+/// @brief Transformation of an instance with x reflection, magnification, rotation and translation in the order of the manual. 
+/// 
+/// A point array is transformed in one pass. 
+/// The 8 Manhattan orientations without magnification are computed in integers with a kernel for each orientation, 
+/// which gives the same results as rounding the floating point transformation, 
+/// and the loops are simple enough to be vectorized by compilers. 
+/// Other transformations fall back to the floating point kernel. 
+struct InstanceTransform
+{
+    /// @nowarn
+	typedef GdsCellReference::point_type point_type; 
+    /// @endnowarn
+	/// @brief orientations of rotations by multiples of 90 degrees, optionally after x reflection 
+	enum OrientType {R0, R90, R180, R270, MX, MXR90, MXR180, MXR270, GENERAL}; 
+
+	OrientType orient; ///< orientation, GENERAL if not Manhattan 
+	bool reflect; ///< x reflection 
+	bool scale; ///< magnification 
+	bool rotate; ///< rotation 
+	bool translate; ///< translation 
+	double magnification; ///< magnification 
+	double cosAngle; ///< cosine value of angle 
+	double sinAngle; ///< sine value of angle 
+	point_type offset; ///< translation 
+
+	/// @brief default constructor for identity 
+	InstanceTransform() : orient(R0), reflect(false), scale(false), rotate(false), translate(false), magnification(1), cosAngle(1), sinAngle(0), offset(0, 0) {}
+	/// @brief constructor 
+    /// @param cellRef CREF object 
+	InstanceTransform(GdsCellReference const& cellRef)
+	{
+		reflect = (cellRef.strans() != std::numeric_limits<int>::max() && (cellRef.strans() & 0x8000)); 
+		// magnification and angle bits in strans are not honored, same as KLayout 
+		scale = (cellRef.magnification() != std::numeric_limits<double>::max()); 
+		magnification = (scale)? cellRef.magnification() : 1; 
+		rotate = (cellRef.angle() != std::numeric_limits<double>::max()); 
+		cosAngle = (rotate)? cos(cellRef.angle()/180.0*M_PI) : 1; 
+		sinAngle = (rotate)? sin(cellRef.angle()/180.0*M_PI) : 0; 
+		translate = false; 
+		offset = point_type(0, 0); 
+		if (cellRef.position().x() != std::numeric_limits<int>::max() && cellRef.position().y() != std::numeric_limits<int>::max())
+			setOffset(cellRef.position()); 
+
+		orient = GENERAL; 
+		if (magnification == 1 && (!rotate || fmod(cellRef.angle(), 90.0) == 0))
+		{
+			int quarter = (rotate)? ((int)fmod(cellRef.angle()/90.0, 4.0) + 4) % 4 : 0; 
+			orient = (OrientType)((reflect)? MX + quarter : R0 + quarter); 
+		}
+	}
+
+    /// @brief set translation 
+    /// @param p offset 
+	void setOffset(point_type const& p) 
+	{
+		translate = true; 
+		offset = p; 
+	}
+
+    /// @brief API to transform an array of points 
+    /// @param first, last begin and end of source points 
+    /// @param target output points, can be the same as the source 
+	void operator()(point_type const* first, point_type const* last, point_type* target) const 
+	{
+		switch (orient)
+		{
+			case R0: manhattan<1, 0, 0, 1>(first, last, target); break; 
+			case R90: manhattan<0, -1, 1, 0>(first, last, target); break; 
+			case R180: manhattan<-1, 0, 0, -1>(first, last, target); break; 
+			case R270: manhattan<0, 1, -1, 0>(first, last, target); break; 
+			case MX: manhattan<1, 0, 0, -1>(first, last, target); break; 
+			case MXR90: manhattan<0, 1, 1, 0>(first, last, target); break; 
+			case MXR180: manhattan<-1, 0, 0, 1>(first, last, target); break; 
+			case MXR270: manhattan<0, -1, -1, 0>(first, last, target); break; 
+			default: general(first, last, target); break; 
+		}
+	}
+
+	protected:
+	/// @brief integer kernel of a Manhattan orientation with matrix [XX XY; YX YY] 
+    /// @param first, last begin and end of source points 
+    /// @param target output points 
+	template <int XX, int XY, int YX, int YY>
+	void manhattan(point_type const* first, point_type const* last, point_type* target) const 
+	{
+		int dx = offset.x(); 
+		int dy = offset.y(); 
+		for (; first != last; ++first, ++target)
+		{
+			int x = first->x(); 
+			int y = first->y(); 
+			*target = point_type(XX*x + XY*y + dx, YX*x + YY*y + dy); 
+		}
+	}
+	/// @brief floating point kernel in the same order of operations as @ref GdsParser::GdsDB::ApplyCellReferenceActionDetails::XReflection, 
+	/// @ref GdsParser::GdsDB::ApplyCellReferenceActionDetails::MagScale, @ref GdsParser::GdsDB::ApplyCellReferenceActionDetails::Rotate 
+	/// and @ref GdsParser::GdsDB::ApplyCellReferenceActionDetails::Translate 
+    /// @param first, last begin and end of source points 
+    /// @param target output points 
+	void general(point_type const* first, point_type const* last, point_type* target) const 
+	{
+		double dx = offset.x(); 
+		double dy = offset.y(); 
+		for (; first != last; ++first, ++target)
+		{
+			double x = first->x(); 
+			double y = first->y(); 
+			if (reflect)
+				y = -y; 
+			if (scale)
+			{
+				x *= magnification; 
+				y *= magnification; 
+			}
+			if (rotate)
+			{
+				double rx = x*cosAngle - y*sinAngle; 
+				y = x*sinAngle + y*cosAngle; 
+				x = rx; 
+			}
+			if (translate)
+			{
+				x += dx; 
+				y += dy; 
+			}
+			*target = point_type(round(x), round(y)); 
+		}
+	}
+};
+
 /// @brief Transform operation over an array 
 /// @tparam Iterator iterator to object 
 /// @tparam TransformerType transformer type 
@@ -400,44 +568,56 @@ template <typename ObjectType>
 inline void apply(GdsCellReference const& cellRef, ObjectType* object)
 {
 	std::vector<GdsCellReference::point_type> vPoint; 
-	std::vector<GdsCellReference::float_point_type> vFloatPoint; 
 	copyToArray(vPoint, object);
-  // copy to temporary float point array 
-  // use float point type to avoid numerical issues 
-  vFloatPoint.reserve(vPoint.size());
-  for (std::vector<GdsCellReference::point_type>::const_iterator it = vPoint.begin(); it != vPoint.end(); ++it)
-  {
-    vFloatPoint.push_back(gtl::construct<GdsCellReference::float_point_type>(it->x(), it->y())); 
-  }
-	// the order must be kept according to the manual 
-	// strans
-	if (cellRef.strans() != std::numeric_limits<int>::max() && (cellRef.strans() & 0x8000)) // apply x reflection 
-	{
-		transform(vFloatPoint.begin(), vFloatPoint.end(), XReflection<GdsCellReference::float_point_type>()); 
-	}
-	// magnification, magnification bit in strans must be set to 1 (KLayout does not honor this bit) 
-	if (/*(cellRef.strans() & 0x4) &&*/ cellRef.magnification() != std::numeric_limits<double>::max())
-	{
-		transform(vFloatPoint.begin(), vFloatPoint.end(), MagScale<GdsCellReference::float_point_type>(cellRef.magnification(), cellRef.magnification())); 
-	}
-	// angle, angle bit in strans must be set to 1 (KLayout does not honor this bit)
-	if (/*(cellRef.strans() & 0x2) &&*/ cellRef.angle() != std::numeric_limits<double>::max())
-	{
-		transform(vFloatPoint.begin(), vFloatPoint.end(), Rotate<GdsCellReference::float_point_type>(cellRef.angle())); 
-	}
-	// position offset 
-	if (cellRef.position().x() != std::numeric_limits<int>::max() && cellRef.position().y() != std::numeric_limits<int>::max())
+	if (vPoint.empty())
+		return; 
+	// transform in place, floating point is only used for non-Manhattan instances 
+	InstanceTransform transform (cellRef); 
+	transform(&vPoint[0], &vPoint[0] + vPoint.size(), &vPoint[0]); 
+	copyFromArray(vPoint, object);
+}
+
+/// @brief make a transformed copy of a shape in a flattened cell 
+/// @param type GDSII record 
+/// @param object GDSII shape 
+/// @param transform transformation 
+/// @param buffer reused buffer of points 
+/// @return new object 
+inline GdsObject* transformedCopy(::GdsParser::GdsRecords::EnumType type, GdsObject const* object, InstanceTransform const& transform, std::vector<GdsCellReference::point_type>& buffer)
+{
+	switch (type)
 	{
-		transform(vFloatPoint.begin(), vFloatPoint.end(), Translate<GdsCellReference::float_point_type>(cellRef.position())); 
+		case ::GdsParser::GdsRecords::BOUNDARY:
+			{
+				// points of polygon_data can only be set, so transform into the buffer 
+				GdsPolygon const* src = static_cast<GdsPolygon const*>(object); 
+				GdsPolygon* polygon = new GdsPolygon(); 
+				static_cast<GdsShape&>(*polygon) = *src; 
+				buffer.resize(src->size()); 
+				if (!buffer.empty())
+					transform(&*src->begin(), &*src->begin() + buffer.size(), &buffer[0]); 
+				polygon->set(buffer.begin(), buffer.end()); 
+				return polygon; 
+			}
+		case ::GdsParser::GdsRecords::PATH:
+			{
+				GdsPath* path = new GdsPath(*static_cast<GdsPath const*>(object)); 
+				if (!path->empty())
+					transform(&(*path)[0], &(*path)[0] + path->size(), &(*path)[0]); 
+				return path; 
+			}
+		case ::GdsParser::GdsRecords::TEXT:
+			{
+				GdsText* text = new GdsText(*static_cast<GdsText const*>(object)); 
+				GdsCellReference::point_type position = text->position(); 
+				transform(&position, &position + 1, &position); 
+				text->setPosition(position); 
+				return text; 
+			}
+		default:
+			limboAssertMsg(0, "unsupported type %d in flattened cell\n", type); 
+			return NULL; 
 	}
-
-  // copy back 
-  vPoint.clear();
-  for (std::vector<GdsCellReference::float_point_type>::const_iterator it = vFloatPoint.begin(); it != vFloatPoint.end(); ++it)
-  {
-    vPoint.push_back(gtl::construct<GdsCellReference::point_type>(round(it->x()), round(it->y()))); 
-  }
-	copyFromArray(vPoint, object);
 }
 
 /// @brief no reference to cell reference; it should not reach here 
@@ -485,6 +665,186 @@ struct ApplyCellReferenceAction
 	}
 };
 
+namespace ExtractCellObjectActionDetails 
+{
+
+/// @brief write transformed copies of all objects in a flattened cell 
+/// @param flatCell flattened cell in its own coordinate system 
+/// @param transform transformation of the instance 
+/// @param target output entries, as many as objects in the flattened cell 
+/// @param buffer reused buffer of points 
+inline void transformCell(GdsCell const& flatCell, ApplyCellReferenceActionDetails::InstanceTransform const& transform, GdsCell::object_entry_type* target, std::vector<GdsCellReference::point_type>& buffer)
+{
+	for (std::vector<GdsCell::object_entry_type>::const_iterator it = flatCell.objects().begin(), ite = flatCell.objects().end(); it != ite; ++it, ++target)
+	{
+		target->first = it->first; 
+		target->second = ApplyCellReferenceActionDetails::transformedCopy(it->first, it->second, transform, buffer); 
+	}
+}
+
+/// @brief append transformed copies of all objects in a flattened cell to target cell 
+/// @param flatCell flattened cell in its own coordinate system 
+/// @param cellRef the reference giving the transformation 
+/// @param targetCell target cell 
+inline void appendTransformedCell(GdsCell const& flatCell, GdsCellReference const& cellRef, GdsCell& targetCell)
+{
+	if (flatCell.objects().empty())
+		return; 
+	std::vector<GdsCell::object_entry_type>& vObject = targetCell.objects(); 
+	std::size_t offset = vObject.size(); 
+	vObject.resize(offset + flatCell.objects().size()); 
+	std::vector<GdsCellReference::point_type> buffer; 
+	transformCell(flatCell, ApplyCellReferenceActionDetails::InstanceTransform(cellRef), &vObject[offset], buffer); 
+}
+
+/// @brief a range of instances of an array transformed by one thread 
+struct TransformArrayTask
+{
+	GdsCell const* flatCell; ///< flattened cell of the array 
+	ApplyCellReferenceActionDetails::InstanceTransform transform; ///< transformation shared by instances except for the offset 
+	GdsCellArray::point_type origin; ///< reference point of the array 
+	double colStep[2]; ///< displacement between columns 
+	double rowStep[2]; ///< displacement between rows 
+	int columns; ///< number of columns 
+	std::size_t first; ///< index of the first instance in row major order 
+	std::size_t last; ///< index past the last instance 
+	GdsCell::object_entry_type* target; ///< output entries of the first instance 
+
+	/// @brief constructor, an empty range 
+	TransformArrayTask() : flatCell(NULL), origin(0, 0), columns(0), first(0), last(0), target(NULL) 
+	{
+		colStep[0] = colStep[1] = 0; 
+		rowStep[0] = rowStep[1] = 0; 
+	}
+};
+
+/// @brief transform a range of instances, run by threads of @ref GdsParser::GdsDB::ExtractCellObjectActionDetails::extractCellArray
+/// @param arg pointer to task 
+/// @return NULL 
+inline void* transformArrayInstances(void* arg)
+{
+	TransformArrayTask& task = *static_cast<TransformArrayTask*>(arg); 
+	std::vector<GdsCellReference::point_type> buffer; 
+	GdsCell::object_entry_type* target = task.target; 
+	for (std::size_t i = task.first; i < task.last; ++i, target += task.flatCell->objects().size())
+	{
+		int r = i / task.columns; 
+		int c = i % task.columns; 
+		task.transform.setOffset(gtl::construct<GdsCellReference::point_type>(
+					round(task.origin.x() + c*task.colStep[0] + r*task.rowStep[0]), 
+					round(task.origin.y() + c*task.colStep[1] + r*task.rowStep[1])
+					)); 
+		transformCell(*task.flatCell, task.transform, target, buffer); 
+	}
+	return NULL; 
+}
+
+/// @brief get a flattened cell in its own coordinate system 
+/// @param gdsDB GDSII database 
+/// @param refCell cell in the database 
+/// @param localCell storage for the flattened cell if cache is not available 
+/// @param cache cache of flattened cells, NULL if not available 
+/// @param numThreads number of threads to transform instances of arrays 
+/// @return reference to flattened cell 
+inline GdsCell const& flattenedCell(GdsDB const& gdsDB, GdsCell const& refCell, GdsCell& localCell, ExtractCellCache* cache, int numThreads)
+{
+	if (cache)
+	{
+		ExtractCellCache::const_iterator found = cache->find(&refCell); 
+		if (found != cache->end())
+			return found->second; 
+	}
+	// references inside std::map stay valid during recursive insertion 
+	GdsCell& flatCell = (cache)? (*cache)[&refCell] : localCell; 
+	flatCell.setName(refCell.name()); 
+	for (std::vector<GdsCell::object_entry_type>::const_iterator it = refCell.objects().begin(), ite = refCell.objects().end(); it != ite; ++it)
+	{
+		GdsObjectHelpers()(it->first, it->second, ExtractCellObjectAction(gdsDB, refCell, flatCell, cache, numThreads));
+	}
+	return flatCell; 
+}
+
+inline void extractCellReference(GdsDB const& gdsDB, GdsCellReference const& cellRef, GdsCell const& refCell, GdsCell& targetCell, ExtractCellCache* cache, int numThreads)
+{
+	if (cache)
+	{
+		GdsCell localCell; 
+		appendTransformedCell(flattenedCell(gdsDB, refCell, localCell, cache, numThreads), cellRef, targetCell); 
+	}
+	else 
+	{
+		// generate a new cell from reference 
+		GdsCell cell = cellRef.extractCellRef(gdsDB, refCell); 
+		// directly append object pointers to target cell 
+		targetCell.objects().insert(targetCell.objects().end(), cell.objects().begin(), cell.objects().end()); 
+		// must clear the list, otherwise, the pointers are destroyed 
+		cell.objects().clear(); 
+	}
+}
+
+inline void extractCellArray(GdsDB const& gdsDB, GdsCellArray const& cellArray, GdsCell const& refCell, GdsCell& targetCell, ExtractCellCache* cache, int numThreads)
+{
+	limboAssertMsg(cellArray.positions().size() == 3, "AREF of %s requires 3 points, got %lu", cellArray.refCell().c_str(), cellArray.positions().size());
+	limboAssertMsg(cellArray.columns() > 0 && cellArray.rows() > 0, "invalid COLROW (%d, %d) in AREF of %s", cellArray.columns(), cellArray.rows(), cellArray.refCell().c_str());
+
+	GdsCell localCell; 
+	GdsCell const& flatCell = flattenedCell(gdsDB, refCell, localCell, cache, numThreads); 
+	if (flatCell.objects().empty())
+		return; 
+
+	// each instance shares the transformation of the array except for the position 
+	GdsCellReference cellRef; 
+	cellRef.setAngle(cellArray.angle()); 
+	cellRef.setMagnification(cellArray.magnification()); 
+	cellRef.setStrans(cellArray.strans()); 
+
+	// according to the manual, the 3 points are the reference point, 
+	// the displacement of the last column and the displacement of the last row
+	TransformArrayTask task; 
+	task.flatCell = &flatCell; 
+	task.transform = ApplyCellReferenceActionDetails::InstanceTransform(cellRef); 
+	task.origin = cellArray.positions()[0]; 
+	task.colStep[0] = (cellArray.positions()[1].x() - task.origin.x()) / (double)cellArray.columns(); 
+	task.colStep[1] = (cellArray.positions()[1].y() - task.origin.y()) / (double)cellArray.columns(); 
+	task.rowStep[0] = (cellArray.positions()[2].x() - task.origin.x()) / (double)cellArray.rows(); 
+	task.rowStep[1] = (cellArray.positions()[2].y() - task.origin.y()) / (double)cellArray.rows(); 
+	task.columns = cellArray.columns(); 
+
+	// allocate entries of all instances, so threads fill disjoint ranges in the order of instances 
+	std::size_t numInstances = (std::size_t)cellArray.columns()*cellArray.rows(); 
+	std::size_t numObjects = flatCell.objects().size(); 
+	std::vector<GdsCell::object_entry_type>& vObject = targetCell.objects(); 
+	std::size_t offset = vObject.size(); 
+	vObject.resize(offset + numInstances*numObjects); 
+
+	// small arrays are not worth threads 
+	std::size_t numTasks = std::max(std::min((std::size_t)std::max(numThreads, 1), numInstances*numObjects/1024), (std::size_t)1); 
+	numTasks = std::min(numTasks, numInstances); 
+	std::vector<TransformArrayTask> vTask (numTasks, task); 
+	for (std::size_t i = 0; i < numTasks; ++i)
+	{
+		vTask[i].first = numInstances*i/numTasks; 
+		vTask[i].last = numInstances*(i+1)/numTasks; 
+		vTask[i].target = &vObject[offset + vTask[i].first*numObjects]; 
+	}
+
+	// the current thread takes the first range 
+	std::vector<pthread_t> vThread (numTasks); 
+	std::vector<char> vCreated (numTasks, false); 
+	for (std::size_t i = 1; i < numTasks; ++i)
+		vCreated[i] = (pthread_create(&vThread[i], NULL, transformArrayInstances, &vTask[i]) == 0); 
+	transformArrayInstances(&vTask[0]); 
+	for (std::size_t i = 1; i < numTasks; ++i)
+	{
+		if (vCreated[i])
+			pthread_join(vThread[i], NULL); 
+		else 
+			transformArrayInstances(&vTask[i]); 
+	}
+}
+
+} // namespace ExtractCellObjectActionDetails
+
 } // namespace GdsDB
 } // namespace GdsParser
 
@@ -7,8 +7,10 @@
 
 #include <limbo/parsers/gdsii/gdsdb/GdsObjects.h>
 #include <limbo/parsers/gdsii/gdsdb/GdsObjectHelpers.h>
+#include <limbo/parsers/gdsii/gdsdb/GdsCellHash.h>
 #include <limbo/preprocessor/Msg.h>
 #include <limits>
+#include <algorithm>
 #include <exception>
 #include <cmath>
 #include <deque>
@@ -336,6 +338,7 @@ GdsText::~GdsText()
 GdsCellReference::GdsCellReference()
 	: GdsCellReference::base_type()
 	, m_refCell()
+	, m_refCellIdx(std::numeric_limits<unsigned int>::max())
 	, m_position(gtl::construct<GdsCellReference::point_type>(std::numeric_limits<int>::max(), std::numeric_limits<int>::max()))
 	, m_angle(std::numeric_limits<double>::max())
 	, m_magnification(std::numeric_limits<double>::max())
@@ -346,6 +349,7 @@ GdsCellReference::GdsCellReference()
 GdsCellReference::GdsCellReference(GdsCellReference const& rhs) 
 	: GdsCellReference::base_type(rhs)
 	, m_refCell(rhs.m_refCell)
+	, m_refCellIdx(rhs.m_refCellIdx)
 	, m_position(rhs.m_position)
 	, m_angle(rhs.m_angle)
 	, m_magnification(rhs.m_magnification)
@@ -359,6 +363,7 @@ GdsCellReference& GdsCellReference::operator=(GdsCellReference const& rhs)
 	{
 		this->base_type::operator=(rhs); 
 		m_refCell = rhs.m_refCell; 
+		m_refCellIdx = rhs.m_refCellIdx; 
 		m_position = rhs.m_position; 
 		m_angle = rhs.m_angle; 
 		m_magnification = rhs.m_magnification; 
@@ -374,7 +379,7 @@ GdsCellReference::~GdsCellReference()
 GdsCell GdsCellReference::extractCellRef(GdsDB const& gdsDB, GdsCell const& srcCell) const 
 {
 	GdsCell targetCell; 
-	limboAssertMsg(refCell() == srcCell.name(), "mismatch between reference cell %s and source cell %s", refCell().c_str(), srcCell.name().c_str());
+	limboAssertMsg(gdsDB.getRefCell(*this) == &srcCell || refCell() == srcCell.name(), "mismatch between reference cell %s and source cell %s", refCell().c_str(), srcCell.name().c_str());
 
 	targetCell.setName(srcCell.name()+"_SREF");
 	// first, try to deep copy all the objects 
@@ -395,6 +400,7 @@ GdsCellArray::GdsCellArray()
 	: GdsCellArray::base_type()
 {
 	m_refCell.clear();
+	m_refCellIdx = std::numeric_limits<unsigned int>::max(); 
 	m_columns = std::numeric_limits<int>::max(); 
 	m_rows = std::numeric_limits<int>::max(); 
 	m_vPosition.clear();
@@ -409,6 +415,7 @@ GdsCellArray::GdsCellArray(GdsCellArray const& rhs)
 	: GdsCellArray::base_type(rhs)
 {
 	m_refCell = rhs.m_refCell; 
+	m_refCellIdx = rhs.m_refCellIdx; 
 	m_columns = rhs.m_columns; 
 	m_rows = rhs.m_rows; 
 	m_spacing[0] = rhs.m_spacing[0]; 
@@ -425,6 +432,7 @@ GdsCellArray& GdsCellArray::operator=(GdsCellArray const& rhs)
 	{
 		this->base_type::operator=(rhs); 
 		m_refCell = rhs.m_refCell; 
+		m_refCellIdx = rhs.m_refCellIdx; 
 		m_columns = rhs.m_columns; 
 		m_rows = rhs.m_rows; 
 		m_spacing[0] = rhs.m_spacing[0]; 
@@ -443,11 +451,17 @@ GdsCellArray::~GdsCellArray()
 
 GdsCell::GdsCell() 
 	: GdsCell::base_type()
+	, m_sourceId(0)
+	, m_sourceBegin(0)
+	, m_sourceEnd(0)
 {
 }
 
 GdsCell::GdsCell(GdsCell const& rhs) 
 	: GdsCell::base_type(rhs)
+	, m_sourceId(0)
+	, m_sourceBegin(0)
+	, m_sourceEnd(0)
 {
 	copy(rhs);
 }
@@ -476,6 +490,61 @@ void GdsCell::copy(GdsCell const& rhs)
 	{
 		GdsObjectHelpers()(rhs.m_vObject[i].first, rhs.m_vObject[i].second, CopyCellObjectAction(m_vObject[i])); 
 	}
+	// the source id tells whether the copy is written to the same source 
+	m_sourceId = rhs.m_sourceId; 
+	m_sourceBegin = rhs.m_sourceBegin; 
+	m_sourceEnd = rhs.m_sourceEnd; 
+}
+
+void GdsCell::swap(GdsCell& rhs)
+{
+	m_name.swap(rhs.m_name); 
+	m_vObject.swap(rhs.m_vObject); 
+	std::swap(m_sourceId, rhs.m_sourceId); 
+	std::swap(m_sourceBegin, rhs.m_sourceBegin); 
+	std::swap(m_sourceEnd, rhs.m_sourceEnd); 
+}
+
+void GdsCell::memoryUsage(limbo::MemoryUsage& usage) const
+{
+	std::size_t polygonBytes = 0; 
+	std::size_t pathBytes = 0; 
+	std::size_t textBytes = 0; 
+	std::size_t refBytes = 0; 
+	for (std::vector<object_entry_type>::const_iterator it = m_vObject.begin(), ite = m_vObject.end(); it != ite; ++it)
+	{
+		switch (it->first)
+		{
+			case ::GdsParser::GdsRecords::BOUNDARY:
+				{
+					GdsPolygon const* polygon = static_cast<GdsPolygon const*>(it->second); 
+					polygonBytes += sizeof(GdsPolygon) + limbo::heap_bytes(polygon->coords_); 
+				}
+				break; 
+			case ::GdsParser::GdsRecords::PATH:
+				pathBytes += sizeof(GdsPath) + static_cast<GdsPath const*>(it->second)->capacity()*sizeof(point_type); 
+				break; 
+			case ::GdsParser::GdsRecords::TEXT:
+				textBytes += sizeof(GdsText) + limbo::heap_bytes(static_cast<GdsText const*>(it->second)->text()); 
+				break; 
+			case ::GdsParser::GdsRecords::SREF:
+				refBytes += sizeof(GdsCellReference) + limbo::heap_bytes(static_cast<GdsCellReference const*>(it->second)->refCell()); 
+				break; 
+			case ::GdsParser::GdsRecords::AREF:
+				{
+					GdsCellArray const* cellArray = static_cast<GdsCellArray const*>(it->second); 
+					refBytes += sizeof(GdsCellArray) + limbo::heap_bytes(cellArray->refCell()) + limbo::heap_bytes(cellArray->positions()); 
+				}
+				break; 
+			default:
+				break; 
+		}
+	}
+	usage.add("GdsDB/cells", limbo::heap_bytes(m_name) + limbo::heap_bytes(m_vObject)); 
+	usage.add("GdsDB/polygons", polygonBytes); 
+	usage.add("GdsDB/paths", pathBytes); 
+	usage.add("GdsDB/texts", textBytes); 
+	usage.add("GdsDB/references", refBytes); 
 }
 
 void GdsCell::destroy() 
@@ -489,6 +558,7 @@ void GdsCell::destroy()
 
 void GdsCell::addPolygon(int layer, int datatype, std::vector<point_type> const& vPoint)
 {
+	markModified(); 
 	GdsPolygon* polygon = new GdsPolygon(); 
 	m_vObject.push_back(std::make_pair(::GdsParser::GdsRecords::BOUNDARY, polygon)); 
 	polygon->setLayer(layer); 
@@ -498,6 +568,7 @@ void GdsCell::addPolygon(int layer, int datatype, std::vector<point_type> const&
 
 void GdsCell::addPath(int layer, int datatype, int pathtype, int width, int bgnextn, int endextn, std::vector<point_type> const& vPoint)
 {
+	markModified(); 
 	GdsPath* path = new GdsPath(); 
 	m_vObject.push_back(std::make_pair(::GdsParser::GdsRecords::PATH, path)); 
 	path->setLayer(layer); 
@@ -511,6 +582,7 @@ void GdsCell::addPath(int layer, int datatype, int pathtype, int width, int bgne
 
 void GdsCell::addText(int layer, int datatype, int texttype, std::string const& str, point_type const& position, int width, int presentation, double angle, double magnification, int strans)
 {
+	markModified(); 
 	GdsText* text = new GdsText(); 
 	m_vObject.push_back(std::make_pair(::GdsParser::GdsRecords::TEXT, text)); 
 	text->setLayer(layer); 
@@ -527,6 +599,7 @@ void GdsCell::addText(int layer, int datatype, int texttype, std::string const&
 
 void GdsCell::addCellReference(std::string const& sname, point_type const& position, double angle, double magnification, int strans)
 {
+	markModified(); 
 	GdsCellReference* cellRef = new GdsCellReference(); 
 	m_vObject.push_back(std::make_pair(::GdsParser::GdsRecords::SREF, cellRef)); 
 	cellRef->setRefCell(sname); 
@@ -538,6 +611,7 @@ void GdsCell::addCellReference(std::string const& sname, point_type const& posit
 
 void GdsCell::addCellArray(std::string const& sname, int columns, int rows, int spacing[2], std::vector<GdsCell::point_type> const& vPosition, double angle, double magnification, int strans)
 {
+	markModified(); 
 	GdsCellArray* cellArray = new GdsCellArray(); 
 	m_vObject.push_back(std::make_pair(::GdsParser::GdsRecords::AREF, cellArray)); 
 	cellArray->setRefCell(sname); 
@@ -559,6 +633,9 @@ GdsDB::GdsDB()
 	m_unit = std::numeric_limits<double>::max();
 	m_precision = std::numeric_limits<double>::max();
 	m_vCell.clear();
+	m_sourceSize = 0; 
+	m_sourceTime = 0; 
+	m_sourceId = 0; 
 }
 
 GdsDB::GdsDB(GdsDB const& rhs)
@@ -568,6 +645,11 @@ GdsDB::GdsDB(GdsDB const& rhs)
 	, m_unit(rhs.m_unit)
 	, m_precision(rhs.m_precision)
 	, m_vCell(rhs.m_vCell)
+	, m_mCellName2Idx(rhs.m_mCellName2Idx)
+	, m_sourceFile(rhs.m_sourceFile)
+	, m_sourceSize(rhs.m_sourceSize)
+	, m_sourceTime(rhs.m_sourceTime)
+	, m_sourceId(rhs.m_sourceId)
 {
 }
 
@@ -581,6 +663,11 @@ GdsDB& GdsDB::operator=(GdsDB const& rhs)
 		m_unit = rhs.m_unit;
 		m_precision = rhs.m_precision;
 		m_vCell = rhs.m_vCell; 
+		m_mCellName2Idx = rhs.m_mCellName2Idx; 
+		m_sourceFile = rhs.m_sourceFile; 
+		m_sourceSize = rhs.m_sourceSize; 
+		m_sourceTime = rhs.m_sourceTime; 
+		m_sourceId = rhs.m_sourceId; 
 	}
 	return *this; 
 }
@@ -617,7 +704,7 @@ GdsCell& GdsDB::addCell(GdsCell const& cell)
 
 GdsCell const* GdsDB::getCell(std::string const& cellName) const 
 {
-	std::map<std::string, unsigned int>::const_iterator found = m_mCellName2Idx.find(cellName); 
+	boost::unordered_map<std::string, unsigned int>::const_iterator found = m_mCellName2Idx.find(cellName); 
 	if (found == m_mCellName2Idx.end())
 		return NULL; 
 	else return &m_vCell[found->second]; 
@@ -625,13 +712,120 @@ GdsCell const* GdsDB::getCell(std::string const& cellName) const
 
 GdsCell* GdsDB::getCell(std::string const& cellName) 
 {
-	std::map<std::string, unsigned int>::const_iterator found = m_mCellName2Idx.find(cellName); 
+	boost::unordered_map<std::string, unsigned int>::const_iterator found = m_mCellName2Idx.find(cellName); 
 	if (found == m_mCellName2Idx.end())
 		return NULL; 
 	else return &m_vCell[found->second]; 
 }
 
-GdsCell GdsDB::extractCell(std::string const& cellName) const 
+void GdsDB::setSourceFile(std::string const& filename, std::size_t size, long time)
+{
+	// ids are unique among all databases, so cells copied from another database never match 
+	static unsigned int numSources = 0; 
+	m_sourceFile = filename; 
+	m_sourceSize = size; 
+	m_sourceTime = time; 
+	m_sourceId = __sync_add_and_fetch(&numSources, 1); 
+}
+
+void GdsDB::resolveCellReferences()
+{
+	for (std::vector<GdsCell>::iterator it = m_vCell.begin(), ite = m_vCell.end(); it != ite; ++it)
+		resolveCellReferences(*it); 
+}
+
+void GdsDB::resolveCellReferences(GdsCell& cell) const 
+{
+	// indices are not written to files, so keep the source range through the const accessor 
+	std::vector<GdsCell::object_entry_type> const& vObject = static_cast<GdsCell const&>(cell).objects(); 
+	for (std::vector<GdsCell::object_entry_type>::const_iterator it = vObject.begin(), ite = vObject.end(); it != ite; ++it)
+	{
+		if (it->first == ::GdsParser::GdsRecords::SREF)
+		{
+			GdsCellReference* cellRef = static_cast<GdsCellReference*>(it->second); 
+			GdsCell const* refCell = getCell(cellRef->refCell()); 
+			cellRef->setRefCellIndex((refCell)? refCell - &m_vCell[0] : std::numeric_limits<unsigned int>::max()); 
+		}
+		else if (it->first == ::GdsParser::GdsRecords::AREF)
+		{
+			GdsCellArray* cellArray = static_cast<GdsCellArray*>(it->second); 
+			GdsCell const* refCell = getCell(cellArray->refCell()); 
+			cellArray->setRefCellIndex((refCell)? refCell - &m_vCell[0] : std::numeric_limits<unsigned int>::max()); 
+		}
+	}
+}
+
+void GdsDB::memoryUsage(limbo::MemoryUsage& usage) const
+{
+	std::size_t bytes = sizeof(*this) + limbo::heap_bytes(m_header) + limbo::heap_bytes(m_libname) + limbo::heap_bytes(m_sourceFile) 
+		+ limbo::heap_bytes(m_vCell) + m_mCellName2Idx.bucket_count()*sizeof(void*); 
+	for (boost::unordered_map<std::string, unsigned int>::const_iterator it = m_mCellName2Idx.begin(), ite = m_mCellName2Idx.end(); it != ite; ++it)
+		bytes += sizeof(*it) + 2*sizeof(void*) + limbo::heap_bytes(it->first); 
+	usage.add("GdsDB/cells", bytes); 
+	for (std::vector<GdsCell>::const_iterator it = m_vCell.begin(), ite = m_vCell.end(); it != ite; ++it)
+		it->memoryUsage(usage); 
+}
+
+std::size_t GdsDB::foldDuplicateCells()
+{
+	resolveCellReferences(); 
+	std::vector<unsigned int> vClass; 
+	std::size_t numDuplicates = GdsCellHash(*this).classify(vClass); 
+	if (numDuplicates == 0)
+		return 0; 
+
+	// rename references to duplicates, then compact kept cells in place 
+	std::vector<unsigned int> vNewIdx (m_vCell.size()); 
+	unsigned int numKept = 0; 
+	for (unsigned int i = 0, ie = m_vCell.size(); i < ie; ++i)
+	{
+		if (vClass[i] != i)
+			continue; 
+		GdsCell& cell = m_vCell[i]; 
+		bool renamed = false; 
+		std::vector<GdsCell::object_entry_type> const& vObject = static_cast<GdsCell const&>(cell).objects(); 
+		for (std::vector<GdsCell::object_entry_type>::const_iterator it = vObject.begin(), ite = vObject.end(); it != ite; ++it)
+		{
+			if (it->first == ::GdsParser::GdsRecords::SREF)
+			{
+				GdsCellReference* cellRef = static_cast<GdsCellReference*>(it->second); 
+				unsigned int idx = cellRef->refCellIndex(); 
+				if (idx < m_vCell.size() && vClass[idx] != idx)
+				{
+					cellRef->setRefCell(m_vCell[vClass[idx]].name()); 
+					renamed = true; 
+				}
+			}
+			else if (it->first == ::GdsParser::GdsRecords::AREF)
+			{
+				GdsCellArray* cellArray = static_cast<GdsCellArray*>(it->second); 
+				unsigned int idx = cellArray->refCellIndex(); 
+				if (idx < m_vCell.size() && vClass[idx] != idx)
+				{
+					cellArray->setRefCell(m_vCell[vClass[idx]].name()); 
+					renamed = true; 
+				}
+			}
+		}
+		if (renamed)
+			cell.markModified(); 
+		vNewIdx[i] = numKept++; 
+	}
+	for (unsigned int i = 0, ie = m_vCell.size(); i < ie; ++i)
+	{
+		if (vClass[i] == i && vNewIdx[i] != i)
+			m_vCell[vNewIdx[i]].swap(m_vCell[i]); 
+	}
+	// names of removed cells find the kept cells 
+	for (boost::unordered_map<std::string, unsigned int>::iterator it = m_mCellName2Idx.begin(), ite = m_mCellName2Idx.end(); it != ite; ++it)
+		it->second = vNewIdx[vClass[it->second]]; 
+	m_vCell.erase(m_vCell.begin()+numKept, m_vCell.end()); 
+	resolveCellReferences(); 
+
+	return numDuplicates; 
+}
+
+GdsCell GdsDB::extractCell(std::string const& cellName, bool memoize, int numThreads) const 
 {
 	GdsCell const* srcCell = getCell(cellName);
 	GdsCell targetCell; 
@@ -639,10 +833,11 @@ GdsCell GdsDB::extractCell(std::string const& cellName) const
 	if (!srcCell)
 		return targetCell; 
 
+	ExtractCellCache cache; 
 	targetCell.setName(srcCell->name());
 	for (std::vector<GdsCell::object_entry_type>::const_iterator it = srcCell->objects().begin(), ite = srcCell->objects().end(); it != ite; ++it)
 	{
-		GdsObjectHelpers()(it->first, it->second, ExtractCellObjectAction(*this, *srcCell, targetCell));
+		GdsObjectHelpers()(it->first, it->second, ExtractCellObjectAction(*this, *srcCell, targetCell, (memoize)? &cache : NULL, numThreads));
 	}
 
 	return targetCell; 
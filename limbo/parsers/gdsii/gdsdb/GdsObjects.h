@@ -8,11 +8,14 @@
 #ifndef LIMBO_PARSERS_GDSII_GDSDB_GDSOBJECTS_H
 #define LIMBO_PARSERS_GDSII_GDSDB_GDSOBJECTS_H
 
+#include <limits>
+#include <boost/unordered_map.hpp>
 #include <boost/geometry.hpp>
 // use adapted boost.polygon in boost.geometry, which is compatible to rtree
 #include <boost/geometry/geometries/adapted/boost_polygon.hpp>
 #include <boost/geometry/geometries/geometries.hpp>
 #include <limbo/parsers/gdsii/stream/GdsReader.h>
+#include <limbo/preprocessor/MemoryUsage.h>
 
 /// namespace for Limbo.GdsParser 
 namespace GdsParser 
@@ -422,8 +425,13 @@ class GdsCellReference : public GdsObject
 		// accessors 
         /// @return reference cell 
 		std::string const& refCell() const {return m_refCell;}
-        /// @param r set reference cell 
-		void setRefCell(std::string const& r) {m_refCell = r;}
+        /// @param r set reference cell, which also clears the resolved index 
+		void setRefCell(std::string const& r) {m_refCell = r; m_refCellIdx = std::numeric_limits<unsigned int>::max();}
+        /// @return index of reference cell in @ref GdsParser::GdsDB::GdsDB::cells, 
+        /// std::numeric_limits<unsigned int>::max() if not resolved 
+		unsigned int refCellIndex() const {return m_refCellIdx;}
+        /// @param i index of reference cell, see @ref GdsParser::GdsDB::GdsDB::resolveCellReferences
+		void setRefCellIndex(unsigned int i) {m_refCellIdx = i;}
 
         /// @return position 
 		point_type const& position() const {return m_position;}
@@ -453,6 +461,7 @@ class GdsCellReference : public GdsObject
 		GdsCell extractCellRef(GdsDB const& gdsDB, GdsCell const& srcCell) const; 
 	protected:
 		std::string m_refCell; ///< string to reference cell 
+		unsigned int m_refCellIdx; ///< index of reference cell in database 
 		point_type m_position; ///< position 
 		double m_angle; ///< angle 
 		double m_magnification; ///< magnification 
@@ -502,8 +511,13 @@ class GdsCellArray : public GdsObject
 		// accessors 
         /// @return reference cell 
 		std::string const& refCell() const {return m_refCell;}
-        /// @param r reference cell 
-		void setRefCell(std::string const& r) {m_refCell = r;}
+        /// @param r reference cell, which also clears the resolved index 
+		void setRefCell(std::string const& r) {m_refCell = r; m_refCellIdx = std::numeric_limits<unsigned int>::max();}
+        /// @return index of reference cell in @ref GdsParser::GdsDB::GdsDB::cells, 
+        /// std::numeric_limits<unsigned int>::max() if not resolved 
+		unsigned int refCellIndex() const {return m_refCellIdx;}
+        /// @param i index of reference cell, see @ref GdsParser::GdsDB::GdsDB::resolveCellReferences
+		void setRefCellIndex(unsigned int i) {m_refCellIdx = i;}
 
         /// @return number of columns 
 		int columns() const {return m_columns;}
@@ -543,6 +557,7 @@ class GdsCellArray : public GdsObject
 		void setStrans(int s) {m_strans = s;}
 	protected:
 		std::string m_refCell; ///< reference cell 
+		unsigned int m_refCellIdx; ///< index of reference cell in database 
 		int m_columns; ///< number of columns 
 		int m_rows; ///< number of rows 
 		coordinate_type m_spacing[2]; ///< spacing of x and y 
@@ -626,12 +641,43 @@ class GdsCell : public GdsObject
         /// @return name of cell 
 		std::string const& name() const {return m_name;}
         /// @param n name of cell 
-		void setName(std::string const& n) {m_name = n;}
+		void setName(std::string const& n) {m_name = n; markModified();}
 
         /// @return reference to array of GDSII object entries 
 		std::vector<std::pair< ::GdsParser::GdsRecords::EnumType, GdsObject*> > const& objects() const {return m_vObject;}
-        /// @return reference to array of GDSII object entries 
-		std::vector<std::pair< ::GdsParser::GdsRecords::EnumType, GdsObject*> >& objects() {return m_vObject;}
+        /// @return reference to array of GDSII object entries, the cell is considered modified 
+		std::vector<std::pair< ::GdsParser::GdsRecords::EnumType, GdsObject*> >& objects() {markModified(); return m_vObject;}
+
+		/// @name source range 
+		/// A cell read from an uncompressed file remembers the bytes of its structure in the file, 
+		/// so @ref GdsParser::GdsDB::GdsWriter can copy the structure verbatim if the cell is not modified. 
+		/// Non-const accessors and add functions mark the cell modified; 
+		/// call @ref markModified after changing objects through pointers from the const accessor. 
+		///@{
+        /// @return true if the cell is unmodified since read from the source file with id @ref sourceId
+		bool hasSourceRange() const {return m_sourceEnd > m_sourceBegin;}
+        /// @return id of the source file, see @ref GdsParser::GdsDB::GdsDB::sourceId
+		unsigned int sourceId() const {return m_sourceId;}
+        /// @return offset of the BGNSTR record in the source file 
+		std::size_t sourceBegin() const {return m_sourceBegin;}
+        /// @return offset past the ENDSTR record in the source file 
+		std::size_t sourceEnd() const {return m_sourceEnd;}
+        /// @brief set bytes of the cell in a source file 
+        /// @param id id of the source file 
+        /// @param b offset of the BGNSTR record 
+        /// @param e offset past the ENDSTR record 
+		void setSourceRange(unsigned int id, std::size_t b, std::size_t e) {m_sourceId = id; m_sourceBegin = b; m_sourceEnd = e;}
+		/// @brief drop the source range, so the cell is encoded again when written 
+		void markModified() {m_sourceBegin = m_sourceEnd = 0;}
+		///@}
+
+        /// @brief swap content with another cell without copying objects 
+        /// @param rhs a GdsCell object 
+		void swap(GdsCell& rhs); 
+        /// @brief report bytes of the cell under categories "GdsDB/cells" for names and object entries, 
+        /// "GdsDB/polygons", "GdsDB/paths", "GdsDB/texts" and "GdsDB/references" for SREF and AREF objects 
+        /// @param usage bytes are added to it 
+		void memoryUsage(limbo::MemoryUsage& usage) const; 
 	protected:
 		/// copy 
         /// @param rhs a GdsCell object 
@@ -641,6 +687,9 @@ class GdsCell : public GdsObject
 
 		std::string m_name; ///< cell name 
 		std::vector<object_entry_type> m_vObject; ///< gdsii objects with types 
+		unsigned int m_sourceId; ///< id of source file 
+		std::size_t m_sourceBegin; ///< offset of the structure in source file 
+		std::size_t m_sourceEnd; ///< offset past the structure in source file 
 };
 
 /**
@@ -719,17 +768,75 @@ class GdsDB : public GdsObject
         /// @param cellName cell name 
         /// @return pointer to the cell, NULL if not found 
 		GdsCell* getCell(std::string const& cellName); 
+		/// @brief get the reference cell of an SREF, 
+		/// the resolved index is used if available to avoid looking up the name 
+        /// @param cellRef an SREF object 
+        /// @return pointer to the cell, NULL if not found 
+		GdsCell const* getRefCell(GdsCellReference const& cellRef) const {return getCell(cellRef.refCellIndex(), cellRef.refCell());}
+		/// @brief get the reference cell of an AREF, 
+		/// the resolved index is used if available to avoid looking up the name 
+        /// @param cellArray an AREF object 
+        /// @return pointer to the cell, NULL if not found 
+		GdsCell const* getRefCell(GdsCellArray const& cellArray) const {return getCell(cellArray.refCellIndex(), cellArray.refCell());}
+
+		/// @brief resolve reference cells of all SREF and AREF objects to indices of cells. \n
+		/// It is called after reading; call it again if cells are reordered or removed through @ref cells. 
+		void resolveCellReferences(); 
+		/// @brief resolve reference cells of SREF and AREF objects in one cell to indices of cells in the database 
+        /// @param cell a cell whose references are resolved 
+		void resolveCellReferences(GdsCell& cell) const; 
+
+		/// @brief fold cells with the same content as another cell, see @ref GdsParser::GdsDB::GdsCellHash. \n
+		/// References to a duplicate are renamed to the first equal cell, which keeps its name and objects,
+		/// and the duplicate is removed. The name of a removed cell still finds the kept cell through @ref getCell.
+		/// Cells keep their relative order, and references are resolved again.
+        /// @return number of cells removed
+		std::size_t foldDuplicateCells();
+
+		/// @name source file 
+		/// The file a database is read from, used by @ref GdsParser::GdsDB::GdsWriter to copy unmodified cells verbatim. 
+		///@{
+        /// @return source file, empty if none 
+		std::string const& sourceFile() const {return m_sourceFile;}
+        /// @return size of source file when read 
+		std::size_t sourceSize() const {return m_sourceSize;}
+        /// @return modification time of source file when read 
+		long sourceTime() const {return m_sourceTime;}
+        /// @return unique id of source file, matched against @ref GdsParser::GdsDB::GdsCell::sourceId
+		unsigned int sourceId() const {return m_sourceId;}
+        /// @brief set source file with a new unique id, which invalidates source ranges of existing cells 
+        /// @param filename source file 
+        /// @param size file size 
+        /// @param time modification time 
+		void setSourceFile(std::string const& filename, std::size_t size, long time); 
+		///@}
 
 		/// @brief extract a cell into a new cell with flatten hierarchies 
         /// @param cellName cell name 
-		GdsCell extractCell(std::string const& cellName) const; 
+        /// @param memoize if true, each referenced cell is flattened only once 
+        /// and its transformed copies are reused for all instances, at the cost of caching the flattened cells 
+        /// @param numThreads number of threads to transform instances of large arrays 
+		GdsCell extractCell(std::string const& cellName, bool memoize = false, int numThreads = 1) const; 
+		/// @brief report bytes of the database and all cells, see @ref GdsParser::GdsDB::GdsCell::memoryUsage; 
+		/// hash nodes of the cell name map are estimated with two pointers of overhead each 
+        /// @param usage bytes are added to it 
+		void memoryUsage(limbo::MemoryUsage& usage) const; 
 	protected:
 		std::string m_header; ///< header 
 		std::string m_libname; ///< name of library 
 		double m_unit; ///< unit 
 		double m_precision; ///< precision 
 		std::vector<GdsCell> m_vCell; ///< cell array  
-		std::map<std::string, unsigned int> m_mCellName2Idx; ///< map from cell name to index 
+		boost::unordered_map<std::string, unsigned int> m_mCellName2Idx; ///< hash map from cell name to index 
+		std::string m_sourceFile; ///< source file 
+		std::size_t m_sourceSize; ///< size of source file 
+		long m_sourceTime; ///< modification time of source file 
+		unsigned int m_sourceId; ///< id of source file, 0 if none 
+
+        /// @param idx resolved index of cell 
+        /// @param cellName cell name, looked up only if idx is out of range 
+        /// @return pointer to the cell, NULL if not found 
+		GdsCell const* getCell(unsigned int idx, std::string const& cellName) const {return (idx < m_vCell.size())? &m_vCell[idx] : getCell(cellName);}
 };
 
 } // namespace GdsDB 
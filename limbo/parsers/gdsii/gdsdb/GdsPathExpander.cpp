@@ -0,0 +1,243 @@
+/**
+ * @file   GdsPathExpander.cpp
+ * @brief  Implementation of expansion of GDSII paths @ref GdsParser::GdsDB::GdsPathExpander
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/gdsii/gdsdb/GdsPathExpander.h>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <pthread.h>
+
+namespace GdsParser { namespace GdsDB {
+
+/// @brief a range of paths expanded by one thread
+struct ExpandPathTask
+{
+	GdsPath const* const* first; ///< first path
+	GdsPath const* const* last; ///< past the last path
+	std::vector<GdsPathExpander::rectangle_type> vRect; ///< output rectangles
+	std::vector<GdsPathExpander::polygon_type> vPolygon; ///< output polygons
+	std::size_t count; ///< number of paths expanded
+};
+
+/// @brief expand a range of paths
+/// @param arg pointer to task
+/// @return NULL
+static void* expandPaths(void* arg)
+{
+	ExpandPathTask& task = *static_cast<ExpandPathTask*>(arg);
+	task.count = 0;
+	for (GdsPath const* const* it = task.first; it != task.last; ++it)
+		task.count += GdsPathExpander::expand(**it, task.vRect, task.vPolygon);
+	return NULL;
+}
+
+/// @param value a field of a path
+/// @return the value, 0 if not set
+static GdsPathExpander::coordinate_type valueOrZero(GdsPathExpander::coordinate_type value)
+{
+	return (value == std::numeric_limits<GdsPathExpander::coordinate_type>::max())? 0 : value;
+}
+
+bool GdsPathExpander::expand(GdsPath const& path, std::vector<rectangle_type>& vRect, std::vector<polygon_type>& vPolygon)
+{
+	// a negative width is absolute, which does not matter here
+	coordinate_type width = std::abs(valueOrZero(path.width()));
+	if (width == 0)
+		return false;
+	std::vector<point_type> vPoint;
+	vPoint.reserve(path.size());
+	for (GdsPath::const_iterator it = path.begin(), ite = path.end(); it != ite; ++it)
+	{
+		if (vPoint.empty() || vPoint.back() != *it)
+			vPoint.push_back(*it);
+	}
+	if (vPoint.size() < 2)
+		return false;
+
+	// offsets below and above the center line
+	coordinate_type lo = width/2;
+	coordinate_type hi = width - lo;
+	coordinate_type bgnExtn = 0;
+	coordinate_type endExtn = 0;
+	switch (valueOrZero(path.pathtype()))
+	{
+		case 1:
+		case 2:
+			bgnExtn = endExtn = lo;
+			break;
+		case 4:
+			bgnExtn = valueOrZero(path.bgnExtn());
+			endExtn = valueOrZero(path.endExtn());
+			break;
+		default:
+			break;
+	}
+
+	bool manhattan = true;
+	for (std::size_t i = 1, ie = vPoint.size(); i < ie && manhattan; ++i)
+		manhattan = (vPoint[i].x() == vPoint[i-1].x() || vPoint[i].y() == vPoint[i-1].y());
+
+	std::size_t numSegments = vPoint.size()-1;
+	if (manhattan)
+	{
+		for (std::size_t i = 0; i < numSegments; ++i)
+		{
+			point_type const& p0 = vPoint[i];
+			point_type const& p1 = vPoint[i+1];
+			// inner vertices extend by the offset on that side, so rectangles of adjacent segments meet at the miter
+			if (p0.y() == p1.y())
+			{
+				bool forward = p1.x() > p0.x();
+				coordinate_type e0 = (i == 0)? bgnExtn : (forward)? lo : hi;
+				coordinate_type e1 = (i+1 == numSegments)? endExtn : (forward)? hi : lo;
+				coordinate_type xl = (forward)? p0.x()-e0 : p1.x()-e1;
+				coordinate_type xh = (forward)? p1.x()+e1 : p0.x()+e0;
+				vRect.push_back(gtl::construct<rectangle_type>(xl, p0.y()-lo, xh, p0.y()+hi));
+			}
+			else
+			{
+				bool forward = p1.y() > p0.y();
+				coordinate_type e0 = (i == 0)? bgnExtn : (forward)? lo : hi;
+				coordinate_type e1 = (i+1 == numSegments)? endExtn : (forward)? hi : lo;
+				coordinate_type yl = (forward)? p0.y()-e0 : p1.y()-e1;
+				coordinate_type yh = (forward)? p1.y()+e1 : p0.y()+e0;
+				vRect.push_back(gtl::construct<rectangle_type>(p0.x()-lo, yl, p0.x()+hi, yh));
+			}
+		}
+		return true;
+	}
+
+	// unit directions and left normals of segments
+	std::vector<double> vDir (2*numSegments);
+	for (std::size_t i = 0; i < numSegments; ++i)
+	{
+		double dx = vPoint[i+1].x() - (double)vPoint[i].x();
+		double dy = vPoint[i+1].y() - (double)vPoint[i].y();
+		double length = std::sqrt(dx*dx+dy*dy);
+		vDir[2*i] = dx/length;
+		vDir[2*i+1] = dy/length;
+	}
+	double halfWidth = width/2.0;
+	std::vector<point_type> vOutline (2*vPoint.size());
+	for (std::size_t k = 0, ke = vPoint.size(); k < ke; ++k)
+	{
+		double x = vPoint[k].x();
+		double y = vPoint[k].y();
+		double ox, oy;
+		if (k == 0)
+		{
+			x -= vDir[0]*bgnExtn;
+			y -= vDir[1]*bgnExtn;
+			ox = -vDir[1]*halfWidth;
+			oy = vDir[0]*halfWidth;
+		}
+		else if (k+1 == ke)
+		{
+			x += vDir[2*k-2]*endExtn;
+			y += vDir[2*k-1]*endExtn;
+			ox = -vDir[2*k-1]*halfWidth;
+			oy = vDir[2*k-2]*halfWidth;
+		}
+		else
+		{
+			// miter offset is the sum of adjacent normals scaled by 1/(1+cos) of the turn
+			double nx = -vDir[2*k-1] - vDir[2*k+1];
+			double ny = vDir[2*k-2] + vDir[2*k];
+			double denominator = 1 + vDir[2*k-2]*vDir[2*k] + vDir[2*k-1]*vDir[2*k+1];
+			if (denominator < 1e-9)
+			{
+				// the path turns back, keep the normal of the previous segment
+				nx = -vDir[2*k-1];
+				ny = vDir[2*k-2];
+				denominator = 1;
+			}
+			ox = nx*halfWidth/denominator;
+			oy = ny*halfWidth/denominator;
+		}
+		// left side forward and right side backward form a loop
+		vOutline[k] = gtl::construct<point_type>(round(x+ox), round(y+oy));
+		vOutline[2*ke-1-k] = gtl::construct<point_type>(round(x-ox), round(y-oy));
+	}
+	vPolygon.push_back(polygon_type());
+	vPolygon.back().set(vOutline.begin(), vOutline.end());
+	return true;
+}
+
+std::size_t GdsPathExpander::expandLayer(GdsCell const& cell, int layer, int datatype, std::vector<rectangle_type>& vRect, std::vector<polygon_type>& vPolygon, int numThreads)
+{
+	std::vector<GdsPath const*> vPath;
+	for (std::vector<GdsCell::object_entry_type>::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+	{
+		if (it->first != ::GdsParser::GdsRecords::PATH)
+			continue;
+		GdsPath const* path = static_cast<GdsPath const*>(it->second);
+		if (path->layer() == layer && (datatype < 0 || path->datatype() == datatype))
+			vPath.push_back(path);
+	}
+	return expand(vPath, vRect, vPolygon, numThreads);
+}
+
+std::size_t GdsPathExpander::expand(std::vector<GdsPath const*> const& vPath, std::vector<rectangle_type>& vRect, std::vector<polygon_type>& vPolygon, int numThreads)
+{
+	if (vPath.empty())
+		return 0;
+	// a few paths are not worth threads
+	std::size_t numTasks = std::max(std::min((std::size_t)std::max(numThreads, 1), vPath.size()/256), (std::size_t)1);
+	if (numTasks == 1)
+	{
+		std::size_t count = 0;
+		for (std::vector<GdsPath const*>::const_iterator it = vPath.begin(), ite = vPath.end(); it != ite; ++it)
+			count += expand(**it, vRect, vPolygon);
+		return count;
+	}
+
+	std::vector<ExpandPathTask> vTask (numTasks);
+	for (std::size_t i = 0; i < numTasks; ++i)
+	{
+		vTask[i].first = &vPath[0] + vPath.size()*i/numTasks;
+		vTask[i].last = &vPath[0] + vPath.size()*(i+1)/numTasks;
+		vTask[i].vRect.reserve(2*(vTask[i].last-vTask[i].first));
+	}
+	// the current thread takes the first range
+	std::vector<pthread_t> vThread (numTasks);
+	std::vector<char> vCreated (numTasks, false);
+	for (std::size_t i = 1; i < numTasks; ++i)
+		vCreated[i] = (pthread_create(&vThread[i], NULL, expandPaths, &vTask[i]) == 0);
+	expandPaths(&vTask[0]);
+	for (std::size_t i = 1; i < numTasks; ++i)
+	{
+		if (vCreated[i])
+			pthread_join(vThread[i], NULL);
+		else
+			expandPaths(&vTask[i]);
+	}
+
+	// concatenate in the order of paths
+	std::size_t count = 0;
+	std::size_t numRects = 0;
+	std::size_t numPolygons = 0;
+	for (std::size_t i = 0; i < numTasks; ++i)
+	{
+		numRects += vTask[i].vRect.size();
+		numPolygons += vTask[i].vPolygon.size();
+	}
+	vRect.reserve(vRect.size() + numRects);
+	vPolygon.reserve(vPolygon.size() + numPolygons);
+	for (std::size_t i = 0; i < numTasks; ++i)
+	{
+		count += vTask[i].count;
+		vRect.insert(vRect.end(), vTask[i].vRect.begin(), vTask[i].vRect.end());
+		for (std::vector<polygon_type>::iterator it = vTask[i].vPolygon.begin(), ite = vTask[i].vPolygon.end(); it != ite; ++it)
+		{
+			vPolygon.push_back(polygon_type());
+			vPolygon.back().coords_.swap(it->coords_);
+		}
+	}
+	return count;
+}
+
+}} // namespace GdsParser // GdsDB
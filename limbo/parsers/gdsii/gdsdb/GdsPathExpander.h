@@ -0,0 +1,70 @@
+/**
+ * @file   GdsPathExpander.h
+ * @brief  Expansion of GDSII paths into rectangles and polygons
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_GDSII_GDSDB_GDSPATHEXPANDER_H
+#define LIMBO_PARSERS_GDSII_GDSDB_GDSPATHEXPANDER_H
+
+#include <vector>
+#include <limbo/parsers/gdsii/gdsdb/GdsObjects.h>
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+/// namespace for Limbo.GdsParser.GdsDB
+namespace GdsDB
+{
+
+/**
+	Expansion of paths into shapes for geometric processing \n
+\n
+	A path whose segments are all axis-parallel becomes one rectangle per segment in integer arithmetic.
+	Each segment is extended by the half width at inner vertices, so the rectangles overlap at bends
+	and their union is the path with the miter joins of GDSII.
+	Other paths, such as 45 degree routes, become one polygon with miter joins computed from segment normals. \n
+\n
+	The end extension follows the path type: none for 0, half width for 2,
+	BGNEXTN and ENDEXTN for 4, and half width for the round ends of 1, which are approximated by square ends like @ref GdsParser::GdsDB::GdsPath::toPolygon.
+	Odd widths keep the exact width, with the extra unit above or to the right of the center line.
+	Duplicate vertices are skipped, and paths with zero width or a single distinct vertex produce nothing.
+*/
+class GdsPathExpander
+{
+	public:
+        /// @nowarn
+		typedef GdsObject::coordinate_type coordinate_type;
+		typedef GdsObject::point_type point_type;
+		typedef GdsObject::rectangle_type rectangle_type;
+		typedef GdsObject::polygon_type polygon_type;
+        /// @endnowarn
+
+		/// @brief expand a path
+        /// @param path path
+        /// @param vRect rectangles of Manhattan paths are appended
+        /// @param vPolygon polygons of other paths are appended
+        /// @return false if the path has less than two distinct vertices
+		static bool expand(GdsPath const& path, std::vector<rectangle_type>& vRect, std::vector<polygon_type>& vPolygon);
+		/// @brief expand all paths on a layer of a cell, distributing paths to threads
+        /// @param cell a cell, usually a flattened one from @ref GdsParser::GdsDB::GdsDB::extractCell
+        /// @param layer layer
+        /// @param datatype data type, negative for all data types of the layer
+        /// @param vRect rectangles are appended in the order of paths in the cell
+        /// @param vPolygon polygons are appended in the order of paths in the cell
+        /// @param numThreads number of threads
+        /// @return number of paths expanded
+		static std::size_t expandLayer(GdsCell const& cell, int layer, int datatype, std::vector<rectangle_type>& vRect, std::vector<polygon_type>& vPolygon, int numThreads = 1);
+		/// @brief expand paths in bulk, distributing paths to threads
+        /// @param vPath paths
+        /// @param vRect rectangles are appended in the order of paths
+        /// @param vPolygon polygons are appended in the order of paths
+        /// @param numThreads number of threads
+        /// @return number of paths expanded
+		static std::size_t expand(std::vector<GdsPath const*> const& vPath, std::vector<rectangle_type>& vRect, std::vector<polygon_type>& vPolygon, int numThreads = 1);
+};
+
+} // namespace GdsDB
+} // namespace GdsParser
+
+#endif
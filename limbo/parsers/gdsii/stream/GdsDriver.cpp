@@ -14,8 +14,8 @@ GdsDriver::GdsDriver(GdsDriver::database_type& db) : m_db(db) {}
 
 bool GdsDriver::operator()(string const& filename)
 {
-	// call GdsReader to read gds file 
-	return read(*this, filename);
+	// enum callbacks fill the same GdsLib without string comparison 
+	return GdsEnumDriver(m_db)(filename);
 }
 
 void GdsDriver::bit_array_cbk(const char* ascii_record_type, const char* ascii_data_type, vector<int> const& vBitArray)
@@ -33,10 +33,33 @@ void GdsDriver::string_cbk(const char* ascii_record_type, const char* ascii_data
 void GdsDriver::begin_end_cbk(const char* ascii_record_type)
 {this->general_cbk(ascii_record_type, "", vector<int>());}
 
+GdsEnumDriver::GdsEnumDriver(GdsEnumDriver::database_type& db) : m_db(db), m_current(BLOCK_HEADER) {}
+
+bool GdsEnumDriver::operator()(string const& filename)
+{
+	// call GdsReader to read gds file 
+	return read(static_cast<GdsDataBaseKernel&>(*this), filename);
+}
+
+void GdsEnumDriver::bit_array_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, vector<int> const& vBitArray)
+{this->general_cbk(record_type, vBitArray);}
+void GdsEnumDriver::integer_2_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, vector<int> const& vInteger)
+{this->general_cbk(record_type, vInteger);}
+void GdsEnumDriver::integer_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, vector<int> const& vInteger)
+{this->general_cbk(record_type, vInteger);}
+void GdsEnumDriver::real_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, vector<double> const& vFloat) 
+{this->general_cbk(record_type, vFloat);}
+void GdsEnumDriver::real_8_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, vector<double> const& vFloat) 
+{this->general_cbk(record_type, vFloat);}
+void GdsEnumDriver::string_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, string const& str) 
+{this->general_cbk(record_type, str);}
+void GdsEnumDriver::begin_end_cbk(GdsRecords::EnumType record_type)
+{this->general_cbk(record_type, vector<int>());}
+
 /// top api function for GdsDriver
 bool read(GdsDriverDataBase& db, string const& filename)
 {
-	return GdsDriver(db)(filename);
+	return GdsEnumDriver(db)(filename);
 }
 
 } // namespace GdsParser
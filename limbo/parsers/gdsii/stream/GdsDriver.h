@@ -143,7 +143,8 @@ class GdsDriver : public GdsDataBase
         /// @brief constructor 
 		GdsDriver(database_type&);
 
-		/// @brief Top function for GdsDriver
+		/// @brief Top function for GdsDriver, which reads through @ref GdsParser::GdsEnumDriver 
+		/// to skip the ASCII redirection; the result is the same 
         /// @param filename GDSII file 
 		bool operator()(string const& filename);
 
@@ -312,7 +313,183 @@ void GdsDriver::general_cbk(string const& ascii_record_type, string const&, Cont
 	else limboAssertMsg(0, "unsupported record type: %s", ascii_record_type.c_str());
 }
 
-/// @brief API function for GdsDriver
+/// @brief Same as @ref GdsParser::GdsDriver, but built on enum callbacks of @ref GdsParser::GdsDataBaseKernel. 
+/// Records are dispatched by enum instead of string comparison, and points of a boundary are reserved from the length of XY record. 
+/// The resulting @ref GdsParser::GdsLib is identical. 
+class GdsEnumDriver : public GdsDataBaseKernel
+{
+	public:
+        /// @nowarn 
+		typedef GdsDataBaseKernel base_type;
+		typedef GdsDriverDataBase database_type;
+        /// @endnowarn
+
+        /// @brief constructor 
+		GdsEnumDriver(database_type&);
+
+		/// @brief Top function for GdsEnumDriver
+        /// @param filename GDSII file 
+		bool operator()(string const& filename);
+
+		/// @name required callbacks from GdsDataBaseKernel
+        ///@{
+		virtual void bit_array_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vBitArray);
+		virtual void integer_2_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vInteger);
+		virtual void integer_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vInteger);
+		virtual void real_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<double> const& vFloat);
+		virtual void real_8_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<double> const& vFloat);
+		virtual void string_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, string const& str);
+		virtual void begin_end_cbk(GdsRecords::EnumType record_type); // begin or end indicater of a block 
+        ///@}
+	protected:
+        /// @brief current block 
+        enum BlockType 
+        {
+            BLOCK_HEADER, 
+            BLOCK_LIBRARY, 
+            BLOCK_CELL, 
+            BLOCK_BOUNDARY, ///< BOUNDARY and BOX 
+            BLOCK_TEXT, 
+            BLOCK_SREF
+        };
+
+		/// @brief Generalized callback for all cases 
+        /// @tparam ContainerType container type 
+        /// @param record_type record 
+        /// @param vData data 
+		template <typename ContainerType>
+		void general_cbk(GdsRecords::EnumType record_type, ContainerType const& vData);
+
+		database_type& m_db; ///< database type 
+		GdsLib m_lib; ///< temporary GdsLib object. 
+									///< when parsed a lib, pass it using add_gds_lib function
+		BlockType m_current; ///< current block 
+};
+
+template <typename ContainerType>
+void GdsEnumDriver::general_cbk(GdsRecords::EnumType record_type, ContainerType const& vData)
+{
+	switch (record_type)
+	{
+		case GdsRecords::HEADER:
+			m_current = BLOCK_HEADER;
+			break;
+		case GdsRecords::BGNLIB:
+			m_current = BLOCK_LIBRARY;
+			break;
+		case GdsRecords::LIBNAME:
+			m_lib.lib_name.assign(vData.begin(), vData.end());
+			break;
+		case GdsRecords::UNITS:
+			m_lib.unit[0] = vData[0]; 
+			m_lib.unit[1] = vData[1]; 
+			break;
+		case GdsRecords::BGNSTR:
+			m_current = BLOCK_CELL;
+			m_lib.vCell.push_back(GdsCell());
+			break;
+		case GdsRecords::STRNAME:
+			m_lib.vCell.back().cell_name.assign(vData.begin(), vData.end());
+			break;
+		case GdsRecords::BOUNDARY: // BOUNDARY and BOX are generalized to BOUNDARY
+		case GdsRecords::BOX:
+			m_current = BLOCK_BOUNDARY;
+			limboAssertMsg(!m_lib.vCell.empty(), "%s block must be in a BGNSTR block", gds_record_ascii(record_type));
+			m_lib.vCell.back().vBoundary.push_back(GdsBoundary());
+			break;
+		case GdsRecords::TEXT:
+			m_current = BLOCK_TEXT;
+			limboAssertMsg(!m_lib.vCell.empty(), "%s block must be in a BGNSTR block", gds_record_ascii(record_type));
+			m_lib.vCell.back().vText.push_back(GdsText());
+			break;
+		case GdsRecords::SREF:
+			m_current = BLOCK_SREF;
+			limboAssertMsg(!m_lib.vCell.empty(), "%s block must be in a BGNSTR block", gds_record_ascii(record_type));
+			m_lib.vCell.back().vSref.push_back(GdsSref());
+			break;
+		case GdsRecords::LAYER:
+			if (m_current == BLOCK_BOUNDARY)
+				m_lib.vCell.back().vBoundary.back().layer = vData[0];
+			else if (m_current == BLOCK_TEXT)
+				m_lib.vCell.back().vText.back().layer = vData[0];
+			break;
+		case GdsRecords::DATATYPE:
+			if (m_current == BLOCK_BOUNDARY)
+				m_lib.vCell.back().vBoundary.back().datatype = vData[0];
+			break;
+		case GdsRecords::TEXTTYPE:
+			if (m_current == BLOCK_TEXT)
+				m_lib.vCell.back().vText.back().texttype = vData[0];
+			break;
+		case GdsRecords::PRESENTATION:
+			if (m_current == BLOCK_TEXT)
+				m_lib.vCell.back().vText.back().presentation = vData[0];
+			break;
+		case GdsRecords::STRANS:
+			if (m_current == BLOCK_TEXT)
+				m_lib.vCell.back().vText.back().strans = vData[0];
+			break;
+		case GdsRecords::MAG:
+			if (m_current == BLOCK_TEXT)
+				m_lib.vCell.back().vText.back().mag = vData[0];
+			break;
+		case GdsRecords::SNAME:
+			if (m_current == BLOCK_SREF)
+				m_lib.vCell.back().vSref.back().sname.assign(vData.begin(), vData.end());
+			break;
+		case GdsRecords::XY:
+			if (m_current == BLOCK_BOUNDARY)
+			{
+				limboAssertMsg((vData.size() % 2) == 0 && vData.size() > 4, "invalid size of data array: %lu", vData.size());
+				vector<vector<int32_t> >& vPoint = m_lib.vCell.back().vBoundary.back().vPoint; 
+				// the number of points is known from the record 
+				vPoint.reserve(vPoint.size() + vData.size()/2); 
+				for (uint32_t i = 0; i < vData.size(); i += 2)
+				{
+					vPoint.push_back(vector<int32_t>(2));
+					vPoint.back()[0] = vData[i];
+					vPoint.back()[1] = vData[i+1];
+				}
+			}
+			else if (m_current == BLOCK_TEXT)
+			{
+				limboAssertMsg(vData.size() == 2, "invalid size of data array for TEXT: %lu", vData.size());
+				m_lib.vCell.back().vText.back().position.assign(vData.begin(), vData.end());
+			}
+			else if (m_current == BLOCK_SREF)
+			{
+				limboAssertMsg(vData.size() == 2, "invalid size of data array for SREF: %lu", vData.size());
+				m_lib.vCell.back().vSref.back().position.assign(vData.begin(), vData.end());
+			}
+			else limboAssertMsg(0, "record XY should only appear in BOUNDARY, BOX, TEXT, SREF");
+			break;
+		case GdsRecords::STRING:
+			limboAssertMsg(m_current == BLOCK_TEXT, "record type STRING must appear in TEXT block");
+			m_lib.vCell.back().vText.back().content.assign(vData.begin(), vData.end());
+			break;
+		case GdsRecords::ENDEL:
+			limboAssertMsg(m_current == BLOCK_BOUNDARY || m_current == BLOCK_TEXT
+					|| m_current == BLOCK_SREF, 
+					"currently only support BOUNDARY, BOX, and TEXT");
+			m_current = BLOCK_CELL; // go back to upper 
+			break;
+		case GdsRecords::ENDSTR:
+			limboAssertMsg(m_current == BLOCK_CELL, "BGNSTR and ENDSTR should be in pair");
+			m_current = BLOCK_LIBRARY; // go back to upper 
+			break;
+		case GdsRecords::ENDLIB:
+			limboAssertMsg(m_current == BLOCK_LIBRARY, "BGNLIB and ENDLIB should be in pair");
+			m_current = BLOCK_HEADER; 
+			// call db 
+			m_db.add_gds_lib(m_lib);
+			m_lib.reset();
+			break;
+		default:
+			limboAssertMsg(0, "unsupported record type: %s", gds_record_ascii(record_type));
+	}
+}
+
+/// @brief API function for GdsDriver, records are dispatched by enum through @ref GdsParser::GdsEnumDriver
 /// @param db database 
 /// @param filename GDSII file 
 bool read(GdsDriverDataBase& db, string const& filename);
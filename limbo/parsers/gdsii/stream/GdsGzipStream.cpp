@@ -0,0 +1,347 @@
+/**
+ * @file   GdsGzipStream.cpp
+ * @brief  Implementation of pipelined gzip decompression @ref GdsParser::GdsGzipStreambuf
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/gdsii/stream/GdsGzipStream.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#if ZLIB == 1
+#include <zlib.h>
+#endif
+
+namespace GdsParser
+{
+
+/// number of ring buffers, one parsed, one inflated, one in reserve
+static const std::size_t GDS_GZIP_NUM_SLOTS = 3;
+
+/// @brief a range of BGZF blocks inflated by one thread
+struct GdsBgzfTask
+{
+    GdsGzipStreambuf const* buf; ///< stream buffer
+    std::size_t first; ///< index of the first block
+    std::size_t last; ///< index past the last block
+    char* target; ///< output of the first block
+    bool ok; ///< false on error
+};
+
+GdsGzipStreambuf::GdsGzipStreambuf()
+    : m_head(0)
+    , m_tail(0)
+    , m_holding(false)
+    , m_eof(false)
+    , m_stop(false)
+    , m_error(false)
+    , m_running(false)
+    , m_numThreads(1)
+    , m_gz(NULL)
+    , m_nextBgzfBlock(0)
+{
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_cond, NULL);
+}
+
+GdsGzipStreambuf::~GdsGzipStreambuf()
+{
+    close();
+    pthread_cond_destroy(&m_cond);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+bool GdsGzipStreambuf::open(const char* filename, int numThreads, std::size_t blockSize)
+{
+#if ZLIB == 1
+    close();
+    m_numThreads = std::max(numThreads, 1);
+
+    // BGZF needs random access to blocks, otherwise inflate sequentially
+    if (!(m_mapping.open(filename) && scan_bgzf()))
+    {
+        m_mapping.close();
+        m_vBgzfBlock.clear();
+        m_gz = gzopen(filename, "rb");
+        if (m_gz == NULL)
+        {
+            printf("failed to open %s for read\n", filename);
+            return false;
+        }
+        gzbuffer(m_gz, 256*1024);
+    }
+
+    m_vSlot.assign(GDS_GZIP_NUM_SLOTS, Slot());
+    for (std::vector<Slot>::iterator it = m_vSlot.begin(), ite = m_vSlot.end(); it != ite; ++it)
+    {
+        it->data.resize(blockSize);
+        it->size = 0;
+        it->full = false;
+    }
+    m_head = m_tail = 0;
+    m_holding = m_eof = m_stop = m_error = false;
+    m_nextBgzfBlock = 0;
+    setg(NULL, NULL, NULL);
+
+    if (pthread_create(&m_thread, NULL, GdsGzipStreambuf::produce, this) != 0)
+    {
+        printf("failed to create thread to read %s\n", filename);
+        close();
+        return false;
+    }
+    m_running = true;
+    return true;
+#else
+    printf("failed to read %s, compile with ZLIB=1 to support gzip\n", filename);
+    return false;
+#endif
+}
+
+void GdsGzipStreambuf::close()
+{
+    if (m_running)
+    {
+        pthread_mutex_lock(&m_mutex);
+        m_stop = true;
+        pthread_cond_broadcast(&m_cond);
+        pthread_mutex_unlock(&m_mutex);
+        pthread_join(m_thread, NULL);
+        m_running = false;
+    }
+#if ZLIB == 1
+    if (m_gz)
+    {
+        gzclose(m_gz);
+        m_gz = NULL;
+    }
+#endif
+    m_mapping.close();
+    m_vBgzfBlock.clear();
+    m_vSlot.clear();
+    setg(NULL, NULL, NULL);
+}
+
+GdsGzipStreambuf::int_type GdsGzipStreambuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+    if (!m_running)
+        return traits_type::eof();
+
+    pthread_mutex_lock(&m_mutex);
+    // give back the consumed slot
+    if (m_holding)
+    {
+        m_vSlot[m_head].full = false;
+        m_head = (m_head+1) % m_vSlot.size();
+        m_holding = false;
+        pthread_cond_broadcast(&m_cond);
+    }
+    while (!m_vSlot[m_head].full && !m_eof)
+        pthread_cond_wait(&m_cond, &m_mutex);
+    bool ready = m_vSlot[m_head].full;
+    m_holding = ready;
+    pthread_mutex_unlock(&m_mutex);
+
+    if (!ready)
+        return traits_type::eof();
+    Slot& slot = m_vSlot[m_head];
+    setg(&slot.data[0], &slot.data[0], &slot.data[0] + slot.size);
+    return traits_type::to_int_type(*gptr());
+}
+
+void* GdsGzipStreambuf::produce(void* arg)
+{
+    GdsGzipStreambuf& buf = *static_cast<GdsGzipStreambuf*>(arg);
+    while (true)
+    {
+        pthread_mutex_lock(&buf.m_mutex);
+        while (buf.m_vSlot[buf.m_tail].full && !buf.m_stop)
+            pthread_cond_wait(&buf.m_cond, &buf.m_mutex);
+        bool stop = buf.m_stop;
+        pthread_mutex_unlock(&buf.m_mutex);
+        if (stop)
+            break;
+
+        // the slot is not touched by consumer until it is marked full
+        Slot& slot = buf.m_vSlot[buf.m_tail];
+        bool ok = buf.fill(slot);
+
+        pthread_mutex_lock(&buf.m_mutex);
+        if (ok && slot.size)
+        {
+            slot.full = true;
+            buf.m_tail = (buf.m_tail+1) % buf.m_vSlot.size();
+        }
+        else
+        {
+            buf.m_error = !ok;
+            buf.m_eof = true;
+        }
+        pthread_cond_broadcast(&buf.m_cond);
+        bool done = buf.m_eof;
+        pthread_mutex_unlock(&buf.m_mutex);
+        if (done)
+            break;
+    }
+    return NULL;
+}
+
+bool GdsGzipStreambuf::fill(Slot& slot)
+{
+    slot.size = 0;
+    if (is_bgzf())
+        return fill_bgzf(slot);
+#if ZLIB == 1
+    int no_read = gzread(m_gz, &slot.data[0], slot.data.size());
+    if (no_read < 0)
+    {
+        int errnum = 0;
+        printf("# ***ERROR*** Failed to inflate gzip stream: %s\n", gzerror(m_gz, &errnum));
+        return false;
+    }
+    slot.size = no_read;
+#endif
+    return true;
+}
+
+bool GdsGzipStreambuf::fill_bgzf(Slot& slot)
+{
+    // take blocks until the slot is full, at least one block
+    std::size_t first = m_nextBgzfBlock;
+    std::size_t last = first;
+    std::size_t total = 0;
+    while (last < m_vBgzfBlock.size() && (last == first || total + m_vBgzfBlock[last].isize <= slot.data.size()))
+        total += m_vBgzfBlock[last++].isize;
+    if (first == last)
+        return true;
+    if (slot.data.size() < total)
+        slot.data.resize(total);
+    m_nextBgzfBlock = last;
+
+    // split blocks into ranges of similar bytes
+    std::size_t numTasks = std::min((std::size_t)m_numThreads, last-first);
+    std::vector<GdsBgzfTask> vTask (numTasks);
+    std::size_t begin = first;
+    std::size_t offset = 0;
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+        GdsBgzfTask& task = vTask[i];
+        task.buf = this;
+        task.first = begin;
+        task.target = &slot.data[0] + offset;
+        task.ok = true;
+        std::size_t end = begin+1;
+        bytes += m_vBgzfBlock[begin].isize;
+        while (end < last-(numTasks-i-1) && (i+1 == numTasks || bytes < total*(i+1)/numTasks))
+            bytes += m_vBgzfBlock[end++].isize;
+        task.last = end;
+        offset = bytes;
+        begin = end;
+    }
+
+    // the current thread takes the first range
+    std::vector<pthread_t> vThread (numTasks);
+    std::vector<char> vCreated (numTasks, false);
+    for (std::size_t i = 1; i < numTasks; ++i)
+        vCreated[i] = (pthread_create(&vThread[i], NULL, GdsGzipStreambuf::inflate_bgzf_task, &vTask[i]) == 0);
+    inflate_bgzf_task(&vTask[0]);
+    bool ok = vTask[0].ok;
+    for (std::size_t i = 1; i < numTasks; ++i)
+    {
+        if (vCreated[i])
+            pthread_join(vThread[i], NULL);
+        else
+            inflate_bgzf_task(&vTask[i]);
+        ok = ok && vTask[i].ok;
+    }
+    slot.size = total;
+    return ok;
+}
+
+void* GdsGzipStreambuf::inflate_bgzf_task(void* arg)
+{
+    GdsBgzfTask& task = *static_cast<GdsBgzfTask*>(arg);
+    char* target = task.target;
+    for (std::size_t i = task.first; i < task.last && task.ok; ++i)
+    {
+        task.ok = task.buf->inflate_bgzf(task.buf->m_vBgzfBlock[i], target);
+        target += task.buf->m_vBgzfBlock[i].isize;
+    }
+    return NULL;
+}
+
+/// @brief read a little endian integer
+/// @param p start of bytes
+/// @param n number of bytes
+static std::size_t gds_read_le(unsigned char const* p, int n)
+{
+    std::size_t value = 0;
+    for (int i = n-1; i >= 0; --i)
+        value = (value<<8) | p[i];
+    return value;
+}
+
+bool GdsGzipStreambuf::scan_bgzf()
+{
+    unsigned char const* data = reinterpret_cast<unsigned char const*>(m_mapping.data());
+    std::size_t length = m_mapping.size();
+    std::size_t offset = 0;
+    m_vBgzfBlock.clear();
+    while (offset < length)
+    {
+        unsigned char const* p = data + offset;
+        // gzip member with FEXTRA and a 'BC' subfield holding block size
+        if (length - offset < 28
+                || p[0] != 0x1f || p[1] != 0x8b || p[2] != 8 || !(p[3] & 4)
+                || gds_read_le(p+10, 2) < 6 || p[12] != 'B' || p[13] != 'C' || gds_read_le(p+14, 2) != 2)
+        {
+            m_vBgzfBlock.clear();
+            return false;
+        }
+        BgzfBlock block;
+        block.offset = offset;
+        block.size = gds_read_le(p+16, 2) + 1;
+        if (block.size < 28 || length - offset < block.size)
+        {
+            m_vBgzfBlock.clear();
+            return false;
+        }
+        block.isize = gds_read_le(p + block.size - 4, 4);
+        // empty blocks, e.g., the end-of-file marker, need no work
+        if (block.isize)
+            m_vBgzfBlock.push_back(block);
+        offset += block.size;
+    }
+    return !m_vBgzfBlock.empty();
+}
+
+bool GdsGzipStreambuf::inflate_bgzf(BgzfBlock const& block, char* target) const
+{
+#if ZLIB == 1
+    unsigned char const* p = reinterpret_cast<unsigned char const*>(m_mapping.data()) + block.offset;
+    std::size_t header = 12 + gds_read_le(p+10, 2);
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    // raw deflate data without gzip header
+    if (inflateInit2(&zs, -15) != Z_OK)
+        return false;
+    zs.next_in = const_cast<unsigned char*>(p + header);
+    zs.avail_in = block.size - header - 8;
+    zs.next_out = reinterpret_cast<unsigned char*>(target);
+    zs.avail_out = block.isize;
+    int status = inflate(&zs, Z_FINISH);
+    inflateEnd(&zs);
+    bool ok = (status == Z_STREAM_END && zs.total_out == block.isize
+            && crc32(0L, reinterpret_cast<unsigned char const*>(target), block.isize) == gds_read_le(p + block.size - 8, 4));
+    if (!ok)
+        printf("# ***ERROR*** Failed to inflate BGZF block at offset %lu\n", (unsigned long)block.offset);
+    return ok;
+#else
+    return false;
+#endif
+}
+
+} // namespace GdsParser
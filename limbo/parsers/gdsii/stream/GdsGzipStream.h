@@ -0,0 +1,141 @@
+/**
+ * @file   GdsGzipStream.h
+ * @brief  pipelined gzip decompression for reading .gds.gz files
+ * @date   Oct 2026
+ */
+
+#ifndef _GDSPARSER_GDSGZIPSTREAM_H
+#define _GDSPARSER_GDSGZIPSTREAM_H
+
+#include <streambuf>
+#include <istream>
+#include <vector>
+#include <pthread.h>
+#include <limbo/parsers/gdsii/stream/GdsReader.h>
+
+// forward declaration of zlib file handler
+struct gzFile_s;
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+
+/// @class GdsParser::GdsGzipStreambuf
+/// @brief input stream buffer that decompresses a gzip file in a background thread.
+///
+/// The background thread inflates large blocks into a ring of buffers,
+/// while the consumer, e.g., @ref GdsParser::GdsReader, parses blocks already inflated.
+/// BGZF files, i.e., gzip files made of independent members with block sizes in the extra field,
+/// are decompressed with several threads on each ring buffer.
+/// Other gzip files are inflated sequentially by the background thread.
+class GdsGzipStreambuf : public std::streambuf
+{
+    public:
+        /// @brief constructor
+        GdsGzipStreambuf();
+        /// @brief destructor
+        ~GdsGzipStreambuf();
+
+        /// @brief open a gzip file and start decompression
+        /// @param filename gzip file
+        /// @param numThreads number of threads to inflate BGZF blocks
+        /// @param blockSize bytes of each ring buffer
+        /// @return true if succeed
+        bool open(const char* filename, int numThreads = 1, std::size_t blockSize = 4*1024*1024);
+        /// @brief stop decompression and close the file
+        void close();
+        /// @return true if a file is open
+        bool is_open() const {return m_running;}
+        /// @return true if the file is in BGZF format
+        bool is_bgzf() const {return !m_vBgzfBlock.empty();}
+        /// @return true if decompression failed
+        bool fail() const {return m_error;}
+
+    protected:
+        /// @brief copy constructor is not allowed
+        GdsGzipStreambuf(GdsGzipStreambuf const&);
+        /// @brief assignment is not allowed
+        GdsGzipStreambuf& operator=(GdsGzipStreambuf const&);
+
+        /// @brief a ring buffer
+        struct Slot
+        {
+            std::vector<char> data; ///< inflated bytes
+            std::size_t size; ///< number of valid bytes
+            bool full; ///< true if filled by producer and not yet consumed
+        };
+        /// @brief byte range of a BGZF block in the file
+        struct BgzfBlock
+        {
+            std::size_t offset; ///< offset in the file
+            std::size_t size; ///< compressed bytes of the whole member
+            std::size_t isize; ///< inflated bytes
+        };
+
+        /// @brief refill the get area from the ring
+        virtual int_type underflow();
+
+        /// @brief entry of background thread
+        /// @param arg this object
+        static void* produce(void* arg);
+        /// @brief fill a ring buffer with next inflated bytes
+        /// @param slot ring buffer
+        /// @return false on error
+        bool fill(Slot& slot);
+        /// @brief fill a ring buffer by inflating consecutive BGZF blocks in parallel
+        /// @param slot ring buffer
+        /// @return false on error
+        bool fill_bgzf(Slot& slot);
+        /// @brief scan BGZF blocks of the mapped file
+        /// @return false if the file is not in BGZF format
+        bool scan_bgzf();
+        /// @brief inflate one BGZF block
+        /// @param block the block
+        /// @param target output with at least block.isize bytes
+        /// @return false on error
+        bool inflate_bgzf(BgzfBlock const& block, char* target) const;
+        /// @brief entry of threads inflating BGZF blocks
+        /// @param arg task
+        static void* inflate_bgzf_task(void* arg);
+
+        std::vector<Slot> m_vSlot; ///< ring buffers
+        std::size_t m_head; ///< slot read by consumer
+        std::size_t m_tail; ///< slot written by producer
+        bool m_holding; ///< whether the consumer holds m_head
+        bool m_eof; ///< producer reaches the end of input
+        bool m_stop; ///< request producer to stop
+        bool m_error; ///< decompression error
+        bool m_running; ///< whether producer thread is running
+        pthread_t m_thread; ///< producer thread
+        pthread_mutex_t m_mutex; ///< lock of ring states
+        pthread_cond_t m_cond; ///< signal changes on ring states
+
+        int m_numThreads; ///< number of threads to inflate BGZF blocks
+        gzFile_s* m_gz; ///< zlib file handler for sequential inflation
+        GdsFileMapping m_mapping; ///< mapped file for BGZF
+        std::vector<BgzfBlock> m_vBgzfBlock; ///< BGZF blocks, empty if not BGZF
+        std::size_t m_nextBgzfBlock; ///< next BGZF block to inflate
+};
+
+/// @class GdsParser::igdsgzstream
+/// @brief input stream of a gzip file with pipelined decompression
+class igdsgzstream : public std::istream
+{
+    public:
+        /// @brief constructor
+        /// @param filename gzip file
+        /// @param numThreads number of threads to inflate BGZF blocks
+        igdsgzstream(const char* filename, int numThreads = 1) : std::istream(&m_buf)
+        {
+            if (!m_buf.open(filename, numThreads))
+                setstate(std::ios::badbit);
+        }
+        /// @return stream buffer
+        GdsGzipStreambuf* rdbuf() {return &m_buf;}
+    protected:
+        GdsGzipStreambuf m_buf; ///< stream buffer
+};
+
+} // namespace GdsParser
+
+#endif
@@ -36,15 +36,20 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <string.h>
 #include <ctype.h>
 #include <math.h>
+#include <time.h>
 #include <fstream>
+#include <algorithm>
 #include <limbo/parsers/gdsii/stream/GdsReader.h>
+#include <limbo/parsers/gdsii/stream/GdsStaticReader.h>
+#include <limbo/parsers/common/PrefetchInputStream.h>
 /// support to .gds.gz if enabled
 /// better to put them in .cpp, which is not seen by users 
 #if ZLIB == 1 
-#include <limbo/thirdparty/gzstream/gzstream.h>
+#include <limbo/parsers/gdsii/stream/GdsGzipStream.h>
 #endif
 
 /* this is how far we indent the structures, then the elements */
@@ -61,15 +66,223 @@ bool read(GdsDataBaseKernel& db, std::istream& fp)
 
 bool read(GdsDataBaseKernel& db, string const& filename)
 {
+    return read(db, filename, GdsLayerFilter()); 
+}
+
+bool read(GdsDataBaseKernel& db, string const& filename, GdsLayerFilter const& filter, int numThreads, GdsRecordProfiler* profiler)
+{
+    GdsReader reader (db); 
+    reader.set_layer_filter(filter); 
+    reader.set_profiler(profiler); 
 /// support to .gds.gz if enabled
 #if ZLIB == 1
     if (limbo::get_file_suffix(filename) == "gz") // detect .gz file 
     {
-        igzstream in (filename.c_str()); 
-        return read(db, in);
+        // decompression runs in background threads while parsing 
+        igdsgzstream in (filename.c_str(), numThreads); 
+        if (!in.good())
+            return false; 
+        bool flag = reader(in);
+        if (in.rdbuf()->fail())
+            printf ("# ***ERROR*** %s is corrupted\n", filename.c_str());
+        return flag; 
     }
 #endif
-    return GdsReader(db)(filename.c_str());
+    return reader(filename.c_str());
+}
+
+bool read_mmap(GdsDataBaseKernel& db, string const& filename)
+{
+/// memory mapping does not apply to compressed files 
+#if ZLIB == 1
+    if (limbo::get_file_suffix(filename) == "gz") // detect .gz file 
+        return read(db, filename); 
+#endif
+    return GdsReader(db).read_mmap(filename.c_str());
+}
+
+void GdsRecordProfiler::reset()
+{
+    std::fill(m_count, m_count+GdsRecords::UNKNOWN+1, 0); 
+    std::fill(m_bytes, m_bytes+GdsRecords::UNKNOWN+1, 0); 
+    std::fill(m_seconds, m_seconds+GdsRecords::UNKNOWN+1, 0.0); 
+}
+
+void GdsRecordProfiler::merge(GdsRecordProfiler const& rhs)
+{
+    for (int i = 0; i <= GdsRecords::UNKNOWN; ++i)
+    {
+        m_count[i] += rhs.m_count[i]; 
+        m_bytes[i] += rhs.m_bytes[i]; 
+        m_seconds[i] += rhs.m_seconds[i]; 
+    }
+}
+
+std::size_t GdsRecordProfiler::total_count() const 
+{
+    std::size_t total = 0; 
+    for (int i = 0; i <= GdsRecords::UNKNOWN; ++i)
+        total += m_count[i]; 
+    return total; 
+}
+
+std::size_t GdsRecordProfiler::total_bytes() const 
+{
+    std::size_t total = 0; 
+    for (int i = 0; i <= GdsRecords::UNKNOWN; ++i)
+        total += m_bytes[i]; 
+    return total; 
+}
+
+double GdsRecordProfiler::total_seconds() const 
+{
+    double total = 0; 
+    for (int i = 0; i <= GdsRecords::UNKNOWN; ++i)
+        total += m_seconds[i]; 
+    return total; 
+}
+
+/// @brief compare record types by time in descending order 
+struct GdsRecordProfilerCompare
+{
+    double const* seconds; ///< seconds per type 
+    /// @return true if type i takes longer than type j 
+    bool operator()(int i, int j) const {return seconds[i] > seconds[j];}
+}; 
+
+void GdsRecordProfiler::print() const 
+{
+    std::vector<int> vType; 
+    for (int i = 0; i <= GdsRecords::UNKNOWN; ++i)
+    {
+        if (m_count[i])
+            vType.push_back(i); 
+    }
+    GdsRecordProfilerCompare compare; 
+    compare.seconds = m_seconds; 
+    std::sort(vType.begin(), vType.end(), compare); 
+
+    double totalSeconds = total_seconds(); 
+    printf("%-14s %12s %14s %10s %7s %10s\n", "record", "count", "bytes", "ms", "time%", "ns/record"); 
+    for (std::vector<int>::const_iterator it = vType.begin(), ite = vType.end(); it != ite; ++it)
+    {
+        int i = *it; 
+        printf("%-14s %12lu %14lu %10.3f %6.1f%% %10.1f\n", gds_record_ascii(i), 
+                (unsigned long)m_count[i], (unsigned long)m_bytes[i], m_seconds[i]*1e3, 
+                (totalSeconds > 0)? m_seconds[i]/totalSeconds*100 : 0.0, m_seconds[i]/m_count[i]*1e9); 
+    }
+    printf("%-14s %12lu %14lu %10.3f\n", "total", (unsigned long)total_count(), (unsigned long)total_bytes(), totalSeconds*1e3); 
+}
+
+double GdsRecordProfiler::now()
+{
+    timespec ts; 
+    clock_gettime(CLOCK_MONOTONIC, &ts); 
+    return ts.tv_sec + ts.tv_nsec*1e-9; 
+}
+
+GdsFileMapping::GdsFileMapping()
+    : m_data(NULL)
+    , m_size(0)
+{
+}
+
+GdsFileMapping::~GdsFileMapping()
+{
+    close(); 
+}
+
+bool GdsFileMapping::open(const char* filename)
+{
+    close(); 
+
+    int fd = ::open(filename, O_RDONLY); 
+    if (fd < 0)
+        return false; 
+    struct stat sb; 
+    if (fstat(fd, &sb) < 0 || !S_ISREG(sb.st_mode))
+    {
+        ::close(fd); 
+        return false; 
+    }
+    if (sb.st_size == 0) // nothing to map 
+    {
+        ::close(fd); 
+        return true; 
+    }
+    void* addr = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0); 
+    // the mapping holds its own reference to the file 
+    ::close(fd); 
+    if (addr == MAP_FAILED) 
+        return false; 
+#ifdef MADV_SEQUENTIAL
+    // records are consumed front to back, let the kernel read ahead aggressively 
+    madvise(addr, sb.st_size, MADV_SEQUENTIAL); 
+#endif
+    m_data = static_cast<const char*>(addr); 
+    m_size = sb.st_size; 
+    return true; 
+}
+
+void GdsFileMapping::close()
+{
+    if (m_data)
+    {
+        munmap(const_cast<char*>(m_data), m_size); 
+        m_data = NULL; 
+        m_size = 0; 
+    }
+}
+
+bool scan_structures(const char* buffer, std::size_t length, vector<GdsStructureRange>& vStructure)
+{
+    unsigned char const* bbegin = reinterpret_cast<unsigned char const*>(buffer); 
+    unsigned char const* bptr = bbegin; 
+    unsigned char const* bend = bbegin + length; 
+    bool inStructure = false; 
+
+    while (bend - bptr >= 2)
+    {
+        int no_bytes = (bptr[0]<<8) + bptr[1]; 
+        if (no_bytes == 0) // padding 
+        {
+            bptr += 2; 
+            continue; 
+        }
+        if (no_bytes < 4 || bend - bptr < no_bytes)
+            return false; 
+        switch (bptr[2])
+        {
+            case GdsRecords::BGNSTR:
+                if (inStructure)
+                    return false; 
+                inStructure = true; 
+                vStructure.push_back(GdsStructureRange()); 
+                vStructure.back().begin = bptr - bbegin; 
+                break; 
+            case GdsRecords::STRNAME:
+                if (inStructure)
+                {
+                    string& name = vStructure.back().name; 
+                    name.assign(reinterpret_cast<const char*>(bptr + 4), no_bytes - 4); 
+                    // strings are padded with null characters to even length 
+                    std::size_t pos = name.find('\0'); 
+                    if (pos != string::npos)
+                        name.resize(pos); 
+                }
+                break; 
+            case GdsRecords::ENDSTR:
+                if (!inStructure)
+                    return false; 
+                inStructure = false; 
+                vStructure.back().end = bptr + no_bytes - bbegin; 
+                break; 
+            default:
+                break; 
+        }
+        bptr += no_bytes; 
+    }
+    return !inStructure; 
 }
 
 GdsReader::GdsReader(GdsDataBaseKernel& db) 
@@ -79,6 +292,9 @@ GdsReader::GdsReader(GdsDataBaseKernel& db)
     m_blen = 0; 
     m_buffer = new char [m_bcap]; 
     m_bptr = m_buffer; 
+    m_filter_state = FILTER_NONE; 
+    m_filter_layer = 0; 
+    m_profiler = NULL; 
 }
 
 GdsReader::~GdsReader()
@@ -167,16 +383,15 @@ const char* GdsReader::gds_read(std::istream& fp, int& no_read, std::size_t n)
 
 bool GdsReader::operator() (const char* filename)
 {
-    std::ifstream fp (filename);
+    // records are read ahead by a helper thread 
+    limbo::PrefetchInputStream fp (filename);
     if (!fp.good())
     {
 		printf("failed to open %s for read\n", filename);
 		return false;
     }
 
-    bool flag = (*this)(fp);
-    fp.close();
-    return flag; 
+    return (*this)(fp);
 }
 
 bool GdsReader::operator() (std::istream& fp)
@@ -187,31 +402,7 @@ bool GdsReader::operator() (std::istream& fp)
 	int no_bytes;
 	unsigned char* record;
     int indent_amount;
-	int record_type;
-	int data_type;
-	int expected_data_type;
-    GdsRecords::EnumType enum_record_type;
-    GdsData::EnumType enum_data_type;
-    GdsData::EnumType enum_expected_data_type;
-	int int_ktr;
-	int data_ktr;
-	int exponent_ktr;
 	int corrupt_ktr;
-	unsigned int display_integer;
-#ifdef DEBUG_GDSREADER
-	unsigned int hex_display_integer;
-#endif 
-	char display_char_1;
-	char display_char_2;
-	int bit_array;
-	int real_sign;
-	int real_exponent;
-	unsigned long long real_mantissa_int;	/* 64 bit integer, yep you need
-											 * at least 56 of 'em. Some compilers need
-											 * a switch to allow this. Maybe some don't.
-											 * gcc has no problems... */
-	double real_mantissa_float;
-	double display_float;
 
 	/* start out with no indent */
     indent_amount = 0;
@@ -274,257 +465,449 @@ bool GdsReader::operator() (std::istream& fp)
 				break;
 			}
 
-			/* now find the record type, numeric and ascii */
-			record_type = record[0];
-			find_record_type (record_type, enum_record_type, expected_data_type);
+			process_record(record, no_read, indent_amount);
+		}
+		else
+		{
+#ifdef DEBUG_GDSREADER
+			/* if it was a NULL record */
+			printf ("%*s0x%04x # PADDING(NULL RECORD)\n",
+					indent_amount, "", no_bytes);
+#endif 
+		}
 
-			/* find the data type, numeric and ascii */
-			data_type = record[1];
-			find_data_type (data_type, enum_data_type);
+	}
 
-			/* if it's a ENDSTR or ENDEL, subtract from indent */
-            if (enum_record_type == GdsRecords::ENDSTR
-                    || enum_record_type == GdsRecords::ENDEL)
-			{
-                if (indent_amount >= 2)
-                    indent_amount -= 2;
-			}
+	return true;
+}
+
+bool GdsReader::read_mmap (const char* filename)
+{
+    GdsFileMapping mapping; 
+    if (!mapping.open(filename)) // e.g., not a regular file, fall back to stream 
+        return (*this)(filename); 
+    return read_buffer(mapping.data(), mapping.size()); 
+}
+
+bool GdsReader::read_buffer (const char* buffer, std::size_t length)
+{
+    unsigned char const* bptr = reinterpret_cast<unsigned char const*>(buffer); 
+    unsigned char const* bend = bptr + length; 
+	int no_bytes;
+    int indent_amount = 0; 
 
+    // walk records in place, no copy to m_buffer 
+    while (bend - bptr >= 2)
+    {
+        no_bytes = (bptr[0]<<8) + bptr[1]; 
+
+		/* we could be into the padding region at the end of the file... */
+        if (no_bytes == 0)
+        {
 #ifdef DEBUG_GDSREADER
-			/* print it out */
-			printf ("\n");
-			printf ("%*s0x%04x     # RECORD_LENGTH              Bytes of data in this record\n",
+			printf ("%*s0x%04x # PADDING(NULL RECORD)\n",
 					indent_amount, "", no_bytes);
-			printf ("%*s0x%02x       # RECORD_TYPE:  %-12s %s\n",
-					indent_amount, "", record_type, gds_record_ascii(enum_record_type), gds_record_description(enum_record_type));
-			printf ("%*s0x%02x       # DATA_TYPE:    %-12s %s\n",
-					indent_amount, "", data_type, gds_data_ascii(enum_data_type), gds_data_description(enum_data_type));
 #endif 
+            bptr += 2; 
+            continue; 
+        }
+        if (no_bytes < 4 || bend - bptr < no_bytes)
+        {
+            printf ("# ***ERROR*** Couldn't read all of record.\n");
+            printf ("#             It should have had %d bytes, could only read %d of them.\n",
+                    no_bytes, (int)std::min(bend - bptr, (std::ptrdiff_t)no_bytes));
+            printf ("#             This is a corrupt file...\n");
+            return true; 
+        }
+        process_record(bptr + 2, no_bytes - 2, indent_amount); 
+        bptr += no_bytes; 
+    }
+    if (bptr != bend && *bptr != 0)
+    {
+        printf ("# ***ERROR*** We read a single non-zero byte after the last record.\n");
+        printf ("#             I'm suspecting that this isn't padding...\n");
+    }
 
-			/* If the record and data types don't match, print an error, but
-			 * keep right on processing. It seems redundant having both of
-			 * these when it looks like the record type would be enough, but
-			 * hey, I didn't create this format, I'm just parsing it and
-			 * looking for errors... */
-			if ((expected_data_type != 0xffff) && (expected_data_type != data_type))
-			{
-				find_data_type (expected_data_type, enum_expected_data_type);
-				printf ("%*s# ***ERROR*** We were expecting data type 0x%02x (%s) to be specified, but\n",
-						indent_amount, "", expected_data_type, gds_data_ascii(enum_expected_data_type));
-				printf ("%*s#             data type 0x%02x (%s) was specified.\n",
-						indent_amount, "", data_type, gds_data_ascii(enum_data_type));
-				printf ("%*s#             I'll use the expected data type when I try to read this.\n",
-						indent_amount, "");
-			}
+    return true; 
+}
 
-			/* now print the actual data (if present) */
-			if (expected_data_type == GdsData::BIT_ARRAY)	/* BIT_ARRAY */
-			{
-				vector<int> vBitArray; vBitArray.reserve((no_read-2)>>1);
-				for (data_ktr = 2; data_ktr < no_read; data_ktr += 2)
-				{
-                    /* use bit shifting instread of multiplication */
-					bit_array = (record[data_ktr]<<8) + record[data_ktr + 1];
+void GdsReader::parse_record (unsigned char const* record, int no_read, int& indent_amount)
+{
+	int record_type;
+	int data_type;
+	int expected_data_type;
+    GdsRecords::EnumType enum_record_type;
+    GdsData::EnumType enum_data_type;
+    GdsData::EnumType enum_expected_data_type;
+	int int_ktr;
+	int data_ktr;
+	int exponent_ktr;
+	unsigned int display_integer;
 #ifdef DEBUG_GDSREADER
-					printf ("%*s0x%04x     # DATA\n",
-							indent_amount, "", bit_array);
-					/* print a hopefully useful comment */
-					print_bit_array_comments (enum_record_type, bit_array, indent_amount);
+	unsigned int hex_display_integer;
 #endif 
-					vBitArray.push_back(bit_array);
-				}
-				m_db.bit_array_cbk(enum_record_type, enum_data_type, vBitArray);
-			}
-			else if (expected_data_type == GdsData::INTEGER_2)	/* INTEGER_2 */
-			{
-				/* vInteger used to save data for callbacks, be careful, it should be int rather than unsigned int */
-				vector<int> vInteger; vInteger.reserve((no_read-2)>>1);
-				for (data_ktr = 2; data_ktr < no_read; data_ktr += 2)
-				{
-					display_integer = record[data_ktr];
-					display_integer <<= 8;
-					display_integer += record[data_ktr + 1];
+	char display_char_1;
+	char display_char_2;
+	int bit_array;
+	int real_sign;
+	int real_exponent;
+	unsigned long long real_mantissa_int;	/* 64 bit integer, yep you need
+											 * at least 56 of 'em. Some compilers need
+											 * a switch to allow this. Maybe some don't.
+											 * gcc has no problems... */
+	double real_mantissa_float;
+	double display_float;
+
+	/* now find the record type, numeric and ascii */
+	record_type = record[0];
+	find_record_type (record_type, enum_record_type, expected_data_type);
+
+#ifndef DEBUG_GDSREADER
+    /* fast path for well-formed records, which has nothing to print */
+    if (expected_data_type == record[1])
+    {
+        gds_decode_record(m_db, enum_record_type, (GdsData::EnumType)expected_data_type, record, no_read, m_vInteger, m_vFloat, m_string); 
+        switch (enum_record_type)
+        {
+            case GdsRecords::ENDSTR: 
+            case GdsRecords::ENDEL: 
+                if (indent_amount >= 2)
+                    indent_amount -= 2; 
+                break; 
+            case GdsRecords::BGNSTR: 
+            case GdsRecords::BOUNDARY: 
+            case GdsRecords::PATH: 
+            case GdsRecords::SREF: 
+            case GdsRecords::AREF: 
+            case GdsRecords::TEXT: 
+            case GdsRecords::TEXTNODE: 
+            case GdsRecords::NODE: 
+            case GdsRecords::BOX: 
+                indent_amount += NO_SPACES_TO_INDENT; 
+                break; 
+            default: 
+                break; 
+        }
+        return; 
+    }
+#endif
+
+	/* find the data type, numeric and ascii */
+	data_type = record[1];
+	find_data_type (data_type, enum_data_type);
+
+	/* if it's a ENDSTR or ENDEL, subtract from indent */
+    if (enum_record_type == GdsRecords::ENDSTR
+            || enum_record_type == GdsRecords::ENDEL)
+	{
+        if (indent_amount >= 2)
+            indent_amount -= 2;
+	}
+
 #ifdef DEBUG_GDSREADER
-					hex_display_integer = display_integer;
+	/* print it out */
+	printf ("\n");
+	printf ("%*s0x%04x     # RECORD_LENGTH              Bytes of data in this record\n",
+			indent_amount, "", no_read + 2);
+	printf ("%*s0x%02x       # RECORD_TYPE:  %-12s %s\n",
+			indent_amount, "", record_type, gds_record_ascii(enum_record_type), gds_record_description(enum_record_type));
+	printf ("%*s0x%02x       # DATA_TYPE:    %-12s %s\n",
+			indent_amount, "", data_type, gds_data_ascii(enum_data_type), gds_data_description(enum_data_type));
 #endif 
-					if (display_integer & 0x8000)	/* negative number, 2's
-													 * comp */
-					{
-						display_integer &= 0x7fff;
-						display_integer ^= 0x7fff;
-						display_integer += 1;
-						display_integer *= -1;
-					}
+
+	/* If the record and data types don't match, print an error, but
+	 * keep right on processing. It seems redundant having both of
+	 * these when it looks like the record type would be enough, but
+	 * hey, I didn't create this format, I'm just parsing it and
+	 * looking for errors... */
+	if ((expected_data_type != 0xffff) && (expected_data_type != data_type))
+	{
+		find_data_type (expected_data_type, enum_expected_data_type);
+		printf ("%*s# ***ERROR*** We were expecting data type 0x%02x (%s) to be specified, but\n",
+				indent_amount, "", expected_data_type, gds_data_ascii(enum_expected_data_type));
+		printf ("%*s#             data type 0x%02x (%s) was specified.\n",
+				indent_amount, "", data_type, gds_data_ascii(enum_data_type));
+		printf ("%*s#             I'll use the expected data type when I try to read this.\n",
+				indent_amount, "");
+	}
+
+	/* now print the actual data (if present) */
+	if (expected_data_type == GdsData::BIT_ARRAY)	/* BIT_ARRAY */
+	{
+		vector<int>& vBitArray = m_vInteger; vBitArray.clear();
+		for (data_ktr = 2; data_ktr < no_read; data_ktr += 2)
+		{
+            /* use bit shifting instread of multiplication */
+			bit_array = (record[data_ktr]<<8) + record[data_ktr + 1];
 #ifdef DEBUG_GDSREADER
-					printf ("%*s0x%04x     # DATA: %d\n",
-							indent_amount, "", hex_display_integer, display_integer);
+			printf ("%*s0x%04x     # DATA\n",
+					indent_amount, "", bit_array);
+			/* print a hopefully useful comment */
+			print_bit_array_comments (enum_record_type, bit_array, indent_amount);
 #endif 
-					vInteger.push_back(display_integer);
-				}
-				m_db.integer_2_cbk(enum_record_type, enum_data_type, vInteger);
-			}
-			else if (expected_data_type == GdsData::INTEGER_4)	/* INTEGER_4 */
-			{
-				/* vInteger used to save data for callbacks, be careful, it should be int rather than unsigned int */
-				vector<int> vInteger; vInteger.reserve((no_read-2)>>2);
-				for (data_ktr = 2; data_ktr < no_read; data_ktr += 4)
-				{
-					display_integer = 0;
-					for (int_ktr = 0; int_ktr < 4; int_ktr++)
-					{
-						display_integer <<= 8;
-						display_integer += record[data_ktr + int_ktr];
-					}
+			vBitArray.push_back(bit_array);
+		}
+		m_db.bit_array_cbk(enum_record_type, enum_data_type, vBitArray);
+	}
+	else if (expected_data_type == GdsData::INTEGER_2)	/* INTEGER_2 */
+	{
+		/* vInteger used to save data for callbacks, be careful, it should be int rather than unsigned int */
+		vector<int>& vInteger = m_vInteger; vInteger.clear();
+		for (data_ktr = 2; data_ktr < no_read; data_ktr += 2)
+		{
+			display_integer = record[data_ktr];
+			display_integer <<= 8;
+			display_integer += record[data_ktr + 1];
 #ifdef DEBUG_GDSREADER
-					hex_display_integer = display_integer;
+			hex_display_integer = display_integer;
 #endif 
-					if (display_integer & 0x80000000)	/* negative number, 2's
-														 * comp */
-					{
-						display_integer &= 0x7fffffff;
-						display_integer ^= 0x7fffffff;
-						display_integer += 1;
-						display_integer *= -1;
-					}
+			if (display_integer & 0x8000)	/* negative number, 2's
+											 * comp */
+			{
+				display_integer &= 0x7fff;
+				display_integer ^= 0x7fff;
+				display_integer += 1;
+				display_integer *= -1;
+			}
 #ifdef DEBUG_GDSREADER
-					printf ("%*s0x%08x # DATA: %d\n",
-							indent_amount, "", hex_display_integer, display_integer);
+			printf ("%*s0x%04x     # DATA: %d\n",
+					indent_amount, "", hex_display_integer, display_integer);
 #endif 
-					vInteger.push_back(display_integer);
-				}
-				m_db.integer_4_cbk(enum_record_type, enum_data_type, vInteger);
-			}
-			else if (expected_data_type == GdsData::REAL_4)	/* REAL_4 */
+			vInteger.push_back(display_integer);
+		}
+		m_db.integer_2_cbk(enum_record_type, enum_data_type, vInteger);
+	}
+	else if (expected_data_type == GdsData::INTEGER_4)	/* INTEGER_4 */
+	{
+		/* vInteger used to save data for callbacks, be careful, it should be int rather than unsigned int */
+		vector<int>& vInteger = m_vInteger; vInteger.clear();
+		for (data_ktr = 2; data_ktr < no_read; data_ktr += 4)
+		{
+			display_integer = 0;
+			for (int_ktr = 0; int_ktr < 4; int_ktr++)
 			{
-				vector<double> vFloat; vFloat.reserve((no_read-2)>>2);
-				for (data_ktr = 2; data_ktr < no_read; data_ktr += 4)
-				{
-					real_sign = record[data_ktr] & 0x80;
-					real_exponent = (record[data_ktr] & 0x7f) - 64;
-					real_mantissa_int = 0;
-					for (exponent_ktr = 1; exponent_ktr < 4; exponent_ktr++)
-					{
-						real_mantissa_int <<= 8;
-						real_mantissa_int += record[data_ktr + exponent_ktr];
-					}
-					real_mantissa_float = (double) real_mantissa_int / pow (2, 24);
-					display_float = real_mantissa_float * pow (16, (float) real_exponent);
-					if (real_sign)
-					{
-						display_float *= -1;
-					}
+				display_integer <<= 8;
+				display_integer += record[data_ktr + int_ktr];
+			}
 #ifdef DEBUG_GDSREADER
-					printf ("%*s%-.9f # DATA\n", indent_amount, "", display_float);
+			hex_display_integer = display_integer;
 #endif 
-					vFloat.push_back(display_float);
-				}
-				m_db.real_4_cbk(enum_record_type, enum_data_type, vFloat);
-			}
-			else if (expected_data_type == GdsData::REAL_8)	/* REAL_8 */
+			if (display_integer & 0x80000000)	/* negative number, 2's
+												 * comp */
 			{
-				vector<double> vFloat; vFloat.reserve((no_read-2)>>3);
-				for (data_ktr = 2; data_ktr < no_read; data_ktr += 8)
-				{
-					real_sign = record[data_ktr] & 0x80;
-					real_exponent = (record[data_ktr] & 0x7f) - 64;
-					real_mantissa_int = 0;
-					for (exponent_ktr = 1; exponent_ktr < 8; exponent_ktr++)
-					{
-						real_mantissa_int <<= 8;
-						real_mantissa_int += record[data_ktr + exponent_ktr];
-					}
-					real_mantissa_float = (double) real_mantissa_int / pow (2, 56);
-					display_float = real_mantissa_float * pow (16, (float) real_exponent);
-					if (real_sign)
-					{
-						display_float *= -1;
-					}
+				display_integer &= 0x7fffffff;
+				display_integer ^= 0x7fffffff;
+				display_integer += 1;
+				display_integer *= -1;
+			}
 #ifdef DEBUG_GDSREADER
-					printf ("%*s%-.18f # DATA\n", indent_amount, "", display_float);
+			printf ("%*s0x%08x # DATA: %d\n",
+					indent_amount, "", hex_display_integer, display_integer);
 #endif 
-					vFloat.push_back(display_float);
-				}
-				m_db.real_8_cbk(enum_record_type, enum_data_type, vFloat);
+			vInteger.push_back(display_integer);
+		}
+		m_db.integer_4_cbk(enum_record_type, enum_data_type, vInteger);
+	}
+	else if (expected_data_type == GdsData::REAL_4)	/* REAL_4 */
+	{
+		vector<double>& vFloat = m_vFloat; vFloat.clear();
+		for (data_ktr = 2; data_ktr < no_read; data_ktr += 4)
+		{
+			real_sign = record[data_ktr] & 0x80;
+			real_exponent = (record[data_ktr] & 0x7f) - 64;
+			real_mantissa_int = 0;
+			for (exponent_ktr = 1; exponent_ktr < 4; exponent_ktr++)
+			{
+				real_mantissa_int <<= 8;
+				real_mantissa_int += record[data_ktr + exponent_ktr];
 			}
-			else if (expected_data_type == GdsData::STRING)	/* STRING */
+			real_mantissa_float = (double) real_mantissa_int / pow (2, 24);
+			display_float = real_mantissa_float * pow (16, (float) real_exponent);
+			if (real_sign)
 			{
-				string str; str.reserve((no_read-2)>>1); 
-				for (data_ktr = 2; data_ktr < no_read; data_ktr += 2)
-				{
-					display_char_1 = record[data_ktr];
-					display_char_2 = record[data_ktr + 1];
-
-					if (display_char_1 == '\0') break; /* quit early if encounter null character */
-					else if (!isprint (display_char_1))
-					{
-						display_char_1 = '.';
-					}
-					str.push_back(display_char_1);
-
-					if (display_char_2 == '\0') break; /* quit early if encounter null character */
-					else if (!isprint (display_char_2))
-					{
-						display_char_2 = '.';
-					}
-					str.push_back(display_char_2);
+				display_float *= -1;
+			}
 #ifdef DEBUG_GDSREADER
-					printf ("%*s0x%02x 0x%02x  # DATA: %c%c\n",
-							indent_amount, "", record[data_ktr], record[data_ktr + 1],
-							display_char_1, display_char_2);
+			printf ("%*s%-.9f # DATA\n", indent_amount, "", display_float);
 #endif 
-					//if (((!isprint (record[data_ktr])) && (record[data_ktr] != 0)) ||
-					//		((!isprint (record[data_ktr + 1])) && (record[data_ktr + 1] != 0)))
-					//{
-					//	printf ("%*s# ***ERROR*** There was a non-printable character in the last 2 byte word.\n",
-					//			indent_amount, "");
-					//}
-				}
-				m_db.string_cbk(enum_record_type, enum_data_type, str);
+			vFloat.push_back(display_float);
+		}
+		m_db.real_4_cbk(enum_record_type, enum_data_type, vFloat);
+	}
+	else if (expected_data_type == GdsData::REAL_8)	/* REAL_8 */
+	{
+		vector<double>& vFloat = m_vFloat; vFloat.clear();
+		for (data_ktr = 2; data_ktr < no_read; data_ktr += 8)
+		{
+			real_sign = record[data_ktr] & 0x80;
+			real_exponent = (record[data_ktr] & 0x7f) - 64;
+			real_mantissa_int = 0;
+			for (exponent_ktr = 1; exponent_ktr < 8; exponent_ktr++)
+			{
+				real_mantissa_int <<= 8;
+				real_mantissa_int += record[data_ktr + exponent_ktr];
 			}
-			else
+			real_mantissa_float = (double) real_mantissa_int / pow (2, 56);
+			display_float = real_mantissa_float * pow (16, (float) real_exponent);
+			if (real_sign)
 			{
-				if (expected_data_type != GdsData::NO_DATA)
-				{
+				display_float *= -1;
+			}
 #ifdef DEBUG_GDSREADER
-					for (data_ktr = 2; data_ktr < no_read; data_ktr++)
-					{
-						printf ("0x%02x # RAW(UNKNOWN)\n", record[data_ktr]);
-					}
+			printf ("%*s%-.18f # DATA\n", indent_amount, "", display_float);
 #endif 
-				}
-				/* enum_record_type == BGNSTR, BOUNDARY, PATH, BOX */
-				else m_db.begin_end_cbk(enum_record_type); 
-			}
+			vFloat.push_back(display_float);
+		}
+		m_db.real_8_cbk(enum_record_type, enum_data_type, vFloat);
+	}
+	else if (expected_data_type == GdsData::STRING)	/* STRING */
+	{
+		string& str = m_string; str.clear(); 
+		for (data_ktr = 2; data_ktr < no_read; data_ktr += 2)
+		{
+			display_char_1 = record[data_ktr];
+			display_char_2 = record[data_ktr + 1];
 
-			/* if it's a BGNSTR or the beginning of an element, add to indent */
-			if (enum_record_type == GdsRecords::BGNSTR ||
-					enum_record_type == GdsRecords::BOUNDARY ||
-					enum_record_type == GdsRecords::PATH ||
-					enum_record_type == GdsRecords::SREF ||
-					enum_record_type == GdsRecords::AREF ||
-					enum_record_type == GdsRecords::TEXT ||
-					enum_record_type == GdsRecords::TEXTNODE ||
-					enum_record_type == GdsRecords::NODE ||
-					enum_record_type == GdsRecords::BOX)
+			if (display_char_1 == '\0') break; /* quit early if encounter null character */
+			else if (!isprint (display_char_1))
 			{
-                indent_amount += NO_SPACES_TO_INDENT;
+				display_char_1 = '.';
 			}
+			str.push_back(display_char_1);
 
-			/* free the record memory */
-			//free (record);
+			if (display_char_2 == '\0') break; /* quit early if encounter null character */
+			else if (!isprint (display_char_2))
+			{
+				display_char_2 = '.';
+			}
+			str.push_back(display_char_2);
+#ifdef DEBUG_GDSREADER
+			printf ("%*s0x%02x 0x%02x  # DATA: %c%c\n",
+					indent_amount, "", record[data_ktr], record[data_ktr + 1],
+					display_char_1, display_char_2);
+#endif 
+			//if (((!isprint (record[data_ktr])) && (record[data_ktr] != 0)) ||
+			//		((!isprint (record[data_ktr + 1])) && (record[data_ktr + 1] != 0)))
+			//{
+			//	printf ("%*s# ***ERROR*** There was a non-printable character in the last 2 byte word.\n",
+			//			indent_amount, "");
+			//}
 		}
-		else
+		m_db.string_cbk(enum_record_type, enum_data_type, str);
+	}
+	else
+	{
+		if (expected_data_type != GdsData::NO_DATA)
 		{
 #ifdef DEBUG_GDSREADER
-			/* if it was a NULL record */
-			printf ("%*s0x%04x # PADDING(NULL RECORD)\n",
-					indent_amount, "", no_bytes);
+			for (data_ktr = 2; data_ktr < no_read; data_ktr++)
+			{
+				printf ("0x%02x # RAW(UNKNOWN)\n", record[data_ktr]);
+			}
 #endif 
 		}
+		/* enum_record_type == BGNSTR, BOUNDARY, PATH, BOX */
+		else m_db.begin_end_cbk(enum_record_type); 
+	}
 
+	/* if it's a BGNSTR or the beginning of an element, add to indent */
+	if (enum_record_type == GdsRecords::BGNSTR ||
+			enum_record_type == GdsRecords::BOUNDARY ||
+			enum_record_type == GdsRecords::PATH ||
+			enum_record_type == GdsRecords::SREF ||
+			enum_record_type == GdsRecords::AREF ||
+			enum_record_type == GdsRecords::TEXT ||
+			enum_record_type == GdsRecords::TEXTNODE ||
+			enum_record_type == GdsRecords::NODE ||
+			enum_record_type == GdsRecords::BOX)
+	{
+        indent_amount += NO_SPACES_TO_INDENT;
 	}
+}
 
-	return true;
+void GdsReader::process_record (unsigned char const* record, int no_read, int& indent_amount)
+{
+    if (m_profiler == NULL)
+    {
+        filter_record(record, no_read, indent_amount); 
+        return; 
+    }
+    double start = GdsRecordProfiler::now(); 
+    filter_record(record, no_read, indent_amount); 
+    m_profiler->add(gds_record_type(record[0]), no_read + 2, GdsRecordProfiler::now() - start); 
+}
+
+void GdsReader::filter_record (unsigned char const* record, int no_read, int& indent_amount)
+{
+    if (m_filter.empty())
+    {
+        parse_record(record, no_read, indent_amount); 
+        return; 
+    }
+
+    switch (m_filter_state)
+    {
+        case FILTER_NONE:
+            if (record[0] == GdsRecords::BOUNDARY || record[0] == GdsRecords::PATH || record[0] == GdsRecords::BOX)
+            {
+                m_filter_state = FILTER_PENDING; 
+                m_vPending.clear(); 
+                break; // hold back the record 
+            }
+            parse_record(record, no_read, indent_amount); 
+            return; 
+        case FILTER_SKIP:
+            if (record[0] == GdsRecords::ENDEL)
+                m_filter_state = FILTER_NONE; 
+            return; 
+        case FILTER_PENDING:
+            // LAYER and DATATYPE/BOXTYPE are single 2-byte integers 
+            if (record[0] == GdsRecords::LAYER && no_read >= 4)
+            {
+                m_filter_layer = gds_decode_integer_2(record + 2); 
+                if (!m_filter.accept(m_filter_layer))
+                {
+                    m_filter_state = FILTER_SKIP; 
+                    return; 
+                }
+                break; 
+            }
+            else if ((record[0] == GdsRecords::DATATYPE || record[0] == GdsRecords::BOXTYPE) && no_read >= 4)
+            {
+                if (!m_filter.accept(m_filter_layer, gds_decode_integer_2(record + 2)))
+                {
+                    m_filter_state = FILTER_SKIP; 
+                    return; 
+                }
+                flush_pending_records(indent_amount); 
+                parse_record(record, no_read, indent_amount); 
+                return; 
+            }
+            else if (record[0] == GdsRecords::ELFLAGS || record[0] == GdsRecords::PLEX)
+                break; // attributes before LAYER 
+            // unexpected record, keep the element 
+            flush_pending_records(indent_amount); 
+            parse_record(record, no_read, indent_amount); 
+            return; 
+    }
+    // save record with its length for later decoding 
+    m_vPending.push_back(((no_read+2)>>8) & 0xff); 
+    m_vPending.push_back((no_read+2) & 0xff); 
+    m_vPending.insert(m_vPending.end(), record, record + no_read); 
+}
+
+void GdsReader::flush_pending_records (int& indent_amount)
+{
+    m_filter_state = FILTER_NONE; 
+    // parse_record does not touch m_vPending, so records are decoded in place 
+    std::size_t pos = 0; 
+    while (pos + 2 <= m_vPending.size())
+    {
+        int no_bytes = (m_vPending[pos]<<8) + m_vPending[pos+1]; 
+        parse_record(&m_vPending[pos+2], no_bytes - 2, indent_amount); 
+        pos += no_bytes; 
+    }
+    m_vPending.clear(); 
 }
 
 void GdsReader::find_record_type (int numeric, GdsRecords::EnumType& record_name, int& expected_data_type)
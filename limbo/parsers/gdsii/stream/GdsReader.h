@@ -10,6 +10,7 @@
 
 #include <string>
 #include <vector>
+#include <set>
 #include <istream>
 #include <limbo/parsers/gdsii/stream/GdsRecords.h>
 #include <limbo/string/String.h>
@@ -144,6 +145,205 @@ inline void GdsDataBase::string_cbk(GdsRecords::EnumType record_type, GdsData::E
 inline void GdsDataBase::begin_end_cbk(GdsRecords::EnumType record_type) // begin or end indicater of a block 
 {this->begin_end_cbk(gds_record_ascii(record_type));}
 
+/// =============================================================
+/// @class GdsParser::GdsDataBaseSpanKernel
+/// @brief GdsDataBaseSpanKernel redirects callbacks of GdsDataBaseKernel to span callbacks. 
+/// Each span callback receives a pointer and a length into the decode buffer of @ref GdsParser::GdsReader, 
+/// which is reused across records. So the data is only valid during the callback; 
+/// databases that do not keep a copy get no allocation per record. 
+/// =============================================================
+class GdsDataBaseSpanKernel : public GdsDataBaseKernel
+{
+	public:
+        /// @brief bit array callback 
+        /// @param record_type record 
+        /// @param data_type data type 
+        /// @param data start of data array 
+        /// @param size number of elements 
+		virtual void bit_array_span_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, int const* data, std::size_t size) = 0;
+        /// @brief 2-byte integer callback 
+        /// @param record_type record 
+        /// @param data_type data type 
+        /// @param data start of data array 
+        /// @param size number of elements 
+		virtual void integer_2_span_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, int const* data, std::size_t size) = 0;
+        /// @brief 4-byte integer callback 
+        /// @param record_type record 
+        /// @param data_type data type 
+        /// @param data start of data array 
+        /// @param size number of elements 
+		virtual void integer_4_span_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, int const* data, std::size_t size) = 0;
+        /// @brief 4-byte floating point number callback 
+        /// @param record_type record 
+        /// @param data_type data type 
+        /// @param data start of data array 
+        /// @param size number of elements 
+		virtual void real_4_span_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, double const* data, std::size_t size) = 0;
+        /// @brief 8-byte floating point number callback 
+        /// @param record_type record 
+        /// @param data_type data type 
+        /// @param data start of data array 
+        /// @param size number of elements 
+		virtual void real_8_span_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, double const* data, std::size_t size) = 0;
+        /// @brief string callback 
+        /// @param record_type record 
+        /// @param data_type data type 
+        /// @param str start of characters, not null terminated 
+        /// @param size number of characters 
+		virtual void string_span_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, char const* str, std::size_t size) = 0;
+        /// @brief begin or end indicator of a block 
+        /// @param record_type record 
+		virtual void begin_end_cbk(GdsRecords::EnumType record_type) = 0; 
+    private:
+        /// @name These callbacks are disabled for users 
+        ///@{
+        /// These callbacks will redirect to span callbacks 
+		virtual void bit_array_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vBitArray);
+		virtual void integer_2_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vInteger);
+		virtual void integer_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vInteger);
+		virtual void real_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<double> const& vFloat);
+		virtual void real_8_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<double> const& vFloat);
+		virtual void string_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, string const& str);
+        ///@}
+};
+
+// inline redirection from enum callbacks to span callbacks
+inline void GdsDataBaseSpanKernel::bit_array_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vBitArray)
+{this->bit_array_span_cbk(record_type, data_type, vBitArray.empty()? NULL : &vBitArray[0], vBitArray.size());}
+inline void GdsDataBaseSpanKernel::integer_2_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vInteger)
+{this->integer_2_span_cbk(record_type, data_type, vInteger.empty()? NULL : &vInteger[0], vInteger.size());}
+inline void GdsDataBaseSpanKernel::integer_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vInteger)
+{this->integer_4_span_cbk(record_type, data_type, vInteger.empty()? NULL : &vInteger[0], vInteger.size());}
+inline void GdsDataBaseSpanKernel::real_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<double> const& vFloat)
+{this->real_4_span_cbk(record_type, data_type, vFloat.empty()? NULL : &vFloat[0], vFloat.size());}
+inline void GdsDataBaseSpanKernel::real_8_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<double> const& vFloat)
+{this->real_8_span_cbk(record_type, data_type, vFloat.empty()? NULL : &vFloat[0], vFloat.size());}
+inline void GdsDataBaseSpanKernel::string_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, string const& str)
+{this->string_span_cbk(record_type, data_type, str.data(), str.size());}
+
+/// @class GdsParser::GdsFileMapping
+/// @brief read-only memory mapping of a file, unmapped on destruction 
+class GdsFileMapping
+{
+    public:
+        /// @brief constructor 
+        GdsFileMapping(); 
+        /// @brief destructor 
+        ~GdsFileMapping(); 
+
+        /// @brief map a regular file into memory 
+        /// @param filename file name 
+        /// @return true if succeed 
+        bool open(const char* filename); 
+        /// @brief release the mapping 
+        void close(); 
+
+        /// @return start of mapped content 
+        const char* data() const {return m_data;}
+        /// @return number of bytes mapped 
+        std::size_t size() const {return m_size;}
+    protected:
+        /// @brief copy constructor is not allowed 
+        GdsFileMapping(GdsFileMapping const&); 
+        /// @brief assignment is not allowed 
+        GdsFileMapping& operator=(GdsFileMapping const&); 
+
+        const char* m_data; ///< start of mapped content 
+        std::size_t m_size; ///< number of bytes mapped 
+};
+
+/// @brief byte range of a structure in a GDSII stream, from BGNSTR to ENDSTR 
+struct GdsStructureRange
+{
+    string name; ///< STRNAME of the structure 
+    std::size_t begin; ///< offset of the BGNSTR record 
+    std::size_t end; ///< offset past the ENDSTR record 
+};
+
+/// @class GdsParser::GdsLayerFilter
+/// @brief set of (layer, datatype) pairs to keep when reading. 
+/// BOUNDARY, PATH and BOX elements not in the set are skipped without decoding; other records are not affected. 
+/// An empty filter keeps everything. 
+class GdsLayerFilter
+{
+    public:
+        /// @brief constructor 
+        GdsLayerFilter() {}
+
+        /// @brief keep a layer 
+        /// @param layer layer 
+        /// @param datatype data type, BOXTYPE for BOX elements, -1 for any data type 
+        void add(int layer, int datatype = -1) {m_sLayer.insert(std::make_pair(layer, datatype));}
+        /// @brief remove all layers, so nothing is filtered 
+        void clear() {m_sLayer.clear();}
+        /// @return true if nothing is filtered 
+        bool empty() const {return m_sLayer.empty();}
+        /// @param layer layer 
+        /// @return true if some data type of the layer is kept 
+        bool accept(int layer) const 
+        {
+            std::set<std::pair<int, int> >::const_iterator found = m_sLayer.lower_bound(std::make_pair(layer, -1)); 
+            return found != m_sLayer.end() && found->first == layer; 
+        }
+        /// @param layer layer 
+        /// @param datatype data type 
+        /// @return true if the pair is kept 
+        bool accept(int layer, int datatype) const 
+        {
+            return m_sLayer.count(std::make_pair(layer, -1)) || m_sLayer.count(std::make_pair(layer, datatype)); 
+        }
+    protected:
+        std::set<std::pair<int, int> > m_sLayer; ///< layer and data type pairs 
+};
+
+/// @class GdsParser::GdsRecordProfiler
+/// @brief collect the number of records, bytes and time for each record type during reading. 
+///
+/// Install it to a reader with @ref GdsParser::GdsReader::set_profiler. 
+/// The time of a record covers layer filtering, decoding and callbacks, but not file I/O; 
+/// records held back by the layer filter are timed with the record deciding their element. 
+class GdsRecordProfiler
+{
+    public:
+        /// @brief constructor 
+        GdsRecordProfiler() {reset();}
+        /// @brief clear all statistics 
+        void reset(); 
+        /// @brief add a record 
+        /// @param record_type enum type of record 
+        /// @param bytes number of bytes including the 2-byte length 
+        /// @param seconds time to process the record 
+        void add(GdsRecords::EnumType record_type, std::size_t bytes, double seconds)
+        {
+            m_count[record_type] += 1; 
+            m_bytes[record_type] += bytes; 
+            m_seconds[record_type] += seconds; 
+        }
+        /// @brief accumulate statistics of another profiler, e.g., from another thread 
+        /// @param rhs another profiler 
+        void merge(GdsRecordProfiler const& rhs); 
+        /// @return number of records of a type 
+        std::size_t count(GdsRecords::EnumType record_type) const {return m_count[record_type];}
+        /// @return number of bytes of a type 
+        std::size_t bytes(GdsRecords::EnumType record_type) const {return m_bytes[record_type];}
+        /// @return seconds spent on a type 
+        double seconds(GdsRecords::EnumType record_type) const {return m_seconds[record_type];}
+        /// @return number of records of all types 
+        std::size_t total_count() const; 
+        /// @return number of bytes of all types 
+        std::size_t total_bytes() const; 
+        /// @return seconds spent on all types 
+        double total_seconds() const; 
+        /// @brief print a table of non-empty record types sorted by time 
+        void print() const; 
+        /// @return current time in seconds from a monotonic clock 
+        static double now(); 
+    protected:
+        std::size_t m_count[GdsRecords::UNKNOWN+1]; ///< number of records per type 
+        std::size_t m_bytes[GdsRecords::UNKNOWN+1]; ///< number of bytes per type 
+        double m_seconds[GdsRecords::UNKNOWN+1]; ///< seconds per type 
+};
+
 /// @class GdsParser::GdsReader
 /// @brief read GDSII 
 class GdsReader
@@ -161,8 +361,35 @@ class GdsReader
         /// @brief read from stream
         /// @param fp input stream 
         bool operator()(std::istream& fp); 
+        /// @brief read from file through memory mapping. 
+        /// Records are decoded in place from the mapped pages instead of being copied to the internal buffer. 
+        /// It falls back to stream reading if the file cannot be mapped. 
+        /// @param filename file name 
+        bool read_mmap(const char* filename); 
+        /// @brief read from a memory buffer holding a complete GDSII stream 
+        /// @param buffer start of the buffer 
+        /// @param length number of bytes in the buffer 
+        bool read_buffer(const char* buffer, std::size_t length); 
+        /// @brief only keep elements on some layers in later reads 
+        /// @param filter layers to keep, an empty filter keeps everything 
+        void set_layer_filter(GdsLayerFilter const& filter) {m_filter = filter;}
+        /// @return layers to keep 
+        GdsLayerFilter const& layer_filter() const {return m_filter;}
+        /// @brief collect statistics per record type in later reads 
+        /// @param profiler statistics, NULL to disable 
+        void set_profiler(GdsRecordProfiler* profiler) {m_profiler = profiler;}
+        /// @return statistics per record type, NULL if disabled 
+        GdsRecordProfiler* profiler() const {return m_profiler;}
 
 	protected:
+        /// @brief states of layer filtering within an element 
+        enum FilterState 
+        {
+            FILTER_NONE, ///< not within a filtered element 
+            FILTER_PENDING, ///< within a BOUNDARY, PATH or BOX element whose layer or data type is not known yet 
+            FILTER_SKIP ///< within an element rejected by the filter 
+        };
+
         /// @brief find record 
         /// @param numeric record 
         /// @param record_name enum type of record 
@@ -177,6 +404,26 @@ class GdsReader
         /// @param bit_array bit array 
         /// @param indent_amount amount of indent
         void print_bit_array_comments (GdsRecords::EnumType enum_record_type, int bit_array, int indent_amount);
+        /// @brief decode a record and invoke callbacks 
+        /// @param record record content after the 2-byte length, starting from record type 
+        /// @param no_read number of bytes in the record excluding the 2-byte length 
+        /// @param indent_amount amount of indent
+        void parse_record (unsigned char const* record, int no_read, int& indent_amount); 
+        /// @brief process a record read from the input, timed if a profiler is installed 
+        /// @param record record content after the 2-byte length, starting from record type 
+        /// @param no_read number of bytes in the record excluding the 2-byte length 
+        /// @param indent_amount amount of indent
+        void process_record (unsigned char const* record, int no_read, int& indent_amount); 
+        /// @brief apply layer filter and decode a record if it is kept. 
+        /// Records of an element are held back until its layer and data type are known, 
+        /// and records of rejected elements are dropped by length without decoding. 
+        /// @param record record content after the 2-byte length, starting from record type 
+        /// @param no_read number of bytes in the record excluding the 2-byte length 
+        /// @param indent_amount amount of indent
+        void filter_record (unsigned char const* record, int no_read, int& indent_amount); 
+        /// @brief decode records held back by the layer filter 
+        /// @param indent_amount amount of indent
+        void flush_pending_records (int& indent_amount); 
 
         /// read n bytes 
         /// @param fp file handler 
@@ -189,6 +436,19 @@ class GdsReader
         char* m_bptr; ///< start position in buffer 
         std::size_t m_bcap; ///< buffer capacity 
         std::size_t m_blen; ///< current buffer size, from m_bptr to m_buffer+m_bcap 
+
+        /// @name decode buffers reused across records, so callbacks do not trigger allocation per record 
+        ///@{
+        vector<int> m_vInteger; ///< bit arrays and integers 
+        vector<double> m_vFloat; ///< floating point numbers 
+        string m_string; ///< strings 
+        ///@}
+
+        GdsLayerFilter m_filter; ///< layers to keep 
+        FilterState m_filter_state; ///< state of layer filtering 
+        int m_filter_layer; ///< layer of the pending element 
+        vector<unsigned char> m_vPending; ///< records held back by the filter, each with its 2-byte length 
+        GdsRecordProfiler* m_profiler; ///< statistics per record type, NULL if disabled 
 };
 
 /// @brief read from stream 
@@ -199,6 +459,27 @@ bool read(GdsDataBaseKernel& db, std::istream& fp);
 /// @param db GDSII database 
 /// @param filename GDSII file 
 bool read(GdsDataBaseKernel& db, string const& filename);
+/// @brief read from file, only keep elements on some layers. 
+/// A .gds.gz file is decompressed in a background thread, 
+/// and BGZF files are decompressed with numThreads threads. 
+/// @param db GDSII database 
+/// @param filename GDSII file 
+/// @param filter layers to keep 
+/// @param numThreads number of threads to decompress BGZF files 
+/// @param profiler statistics per record type, NULL to disable 
+bool read(GdsDataBaseKernel& db, string const& filename, GdsLayerFilter const& filter, int numThreads = 1, GdsRecordProfiler* profiler = NULL);
+/// @brief read from file through memory mapping, 
+/// .gds.gz files are still read through stream 
+/// @param db GDSII database 
+/// @param filename GDSII file 
+bool read_mmap(GdsDataBaseKernel& db, string const& filename);
+/// @brief scan record headers of a GDSII stream in memory and collect the byte range of each structure. 
+/// Only STRNAME records are decoded, so it is much faster than a full read. 
+/// @param buffer start of the stream 
+/// @param length number of bytes in the stream 
+/// @param vStructure array of structure ranges in the order of appearance 
+/// @return false if the stream is corrupted 
+bool scan_structures(const char* buffer, std::size_t length, vector<GdsStructureRange>& vStructure);
 
 } // namespace GdsParser
 
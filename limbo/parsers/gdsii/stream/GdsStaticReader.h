@@ -0,0 +1,311 @@
+/**
+ * @file   GdsStaticReader.h
+ * @brief  record decoders and @ref GdsParser::GdsReaderT, a GDSII reader with callbacks bound at compile time
+ * @date   Oct 2026
+ */
+
+#ifndef _GDSPARSER_GDSSTATICREADER_H
+#define _GDSPARSER_GDSSTATICREADER_H
+
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+#include <fstream>
+#include <algorithm>
+#include <limbo/parsers/gdsii/stream/GdsReader.h>
+#if ZLIB == 1
+#include <limbo/parsers/gdsii/stream/GdsGzipStream.h>
+#endif
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+
+/// @name decoders of GDSII data in big endian
+///@{
+
+/// @brief decode a signed 2-byte integer
+/// @param p start of bytes
+inline int gds_decode_integer_2 (unsigned char const* p)
+{
+    int value = (p[0]<<8) + p[1];
+    return (value & 0x8000)? value - 0x10000 : value;
+}
+/// @brief decode a signed 4-byte integer
+/// @param p start of bytes
+inline int gds_decode_integer_4 (unsigned char const* p)
+{
+    unsigned int value = ((unsigned int)p[0]<<24) | ((unsigned int)p[1]<<16) | ((unsigned int)p[2]<<8) | p[3];
+    return (int)value;
+}
+/// @brief decode an excess-64 real number
+/// @param p start of bytes
+/// @param n number of bytes, 4 or 8
+inline double gds_decode_real (unsigned char const* p, int n)
+{
+    unsigned long long mantissa = 0;
+    for (int i = 1; i < n; ++i)
+        mantissa = (mantissa<<8) + p[i];
+    double value = (double)mantissa / pow (2, 8*(n-1)) * pow (16, (float)((p[0] & 0x7f) - 64));
+    return (p[0] & 0x80)? -value : value;
+}
+
+///@}
+
+/// @brief decode one record and invoke callbacks of a database.
+///
+/// The record is decoded as data type data_type, which has been checked against the expected type by the caller.
+/// The most frequent records of geometries, XY, LAYER, DATATYPE, BOUNDARY and ENDEL, are dispatched first
+/// to dedicated decoders; the others are decoded by their data types.
+/// Callbacks are invoked through DataBaseType, so they are bound at compile time when DataBaseType is a concrete class.
+/// @tparam DataBaseType database with the callbacks of @ref GdsParser::GdsDataBaseKernel
+/// @param db database
+/// @param record_type enum type of record
+/// @param data_type enum type of data type
+/// @param record record content after the 2-byte length, starting from record type
+/// @param no_read number of bytes in the record excluding the 2-byte length
+/// @param vInteger buffer for integers and bit arrays
+/// @param vFloat buffer for real numbers
+/// @param str buffer for strings
+template <typename DataBaseType>
+inline void gds_decode_record (DataBaseType& db, GdsRecords::EnumType record_type, GdsData::EnumType data_type,
+        unsigned char const* record, int no_read, vector<int>& vInteger, vector<double>& vFloat, string& str)
+{
+    unsigned char const* data = record + 2;
+    int no_data = no_read - 2;
+    switch (record_type)
+    {
+        case GdsRecords::XY:
+            if (data_type == GdsData::INTEGER_4)
+            {
+                vInteger.resize(no_data/4);
+                for (std::size_t i = 0, ie = vInteger.size(); i < ie; ++i, data += 4)
+                    vInteger[i] = gds_decode_integer_4(data);
+                db.integer_4_cbk(record_type, data_type, vInteger);
+                return;
+            }
+            break;
+        case GdsRecords::LAYER:
+        case GdsRecords::DATATYPE:
+            if (data_type == GdsData::INTEGER_2 && no_data == 2)
+            {
+                vInteger.resize(1);
+                vInteger[0] = gds_decode_integer_2(data);
+                db.integer_2_cbk(record_type, data_type, vInteger);
+                return;
+            }
+            break;
+        case GdsRecords::BOUNDARY:
+        case GdsRecords::ENDEL:
+            if (data_type == GdsData::NO_DATA)
+            {
+                db.begin_end_cbk(record_type);
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+
+    switch (data_type)
+    {
+        case GdsData::BIT_ARRAY:
+        case GdsData::INTEGER_2:
+            vInteger.resize(no_data/2);
+            for (std::size_t i = 0, ie = vInteger.size(); i < ie; ++i, data += 2)
+                vInteger[i] = (data_type == GdsData::BIT_ARRAY)? (data[0]<<8) + data[1] : gds_decode_integer_2(data);
+            if (data_type == GdsData::BIT_ARRAY)
+                db.bit_array_cbk(record_type, data_type, vInteger);
+            else
+                db.integer_2_cbk(record_type, data_type, vInteger);
+            break;
+        case GdsData::INTEGER_4:
+            vInteger.resize(no_data/4);
+            for (std::size_t i = 0, ie = vInteger.size(); i < ie; ++i, data += 4)
+                vInteger[i] = gds_decode_integer_4(data);
+            db.integer_4_cbk(record_type, data_type, vInteger);
+            break;
+        case GdsData::REAL_4:
+        case GdsData::REAL_8:
+            {
+                int n = (data_type == GdsData::REAL_4)? 4 : 8;
+                vFloat.resize(no_data/n);
+                for (std::size_t i = 0, ie = vFloat.size(); i < ie; ++i, data += n)
+                    vFloat[i] = gds_decode_real(data, n);
+                if (data_type == GdsData::REAL_4)
+                    db.real_4_cbk(record_type, data_type, vFloat);
+                else
+                    db.real_8_cbk(record_type, data_type, vFloat);
+                break;
+            }
+        case GdsData::STRING:
+            str.clear();
+            // stop at null character, replace non-printable characters
+            for (int i = 0; i < no_data && data[i] != '\0'; ++i)
+                str.push_back((isprint (data[i]))? (char)data[i] : '.');
+            db.string_cbk(record_type, data_type, str);
+            break;
+        case GdsData::NO_DATA:
+            db.begin_end_cbk(record_type);
+            break;
+        default:
+            break;
+    }
+}
+
+/// @class GdsParser::GdsReaderT
+/// @brief read GDSII with callbacks bound at compile time.
+///
+/// Unlike @ref GdsParser::GdsReader, the database is a template parameter and does not need to derive from
+/// @ref GdsParser::GdsDataBaseKernel; it only needs the same callback functions, which can be non-virtual
+/// and inlined into the decoding loop, e.g., for thin databases that only count or bin shapes.
+/// Regular files are decoded in place through memory mapping, and streams are read in large chunks.
+/// Layer filtering is not supported; use @ref GdsParser::GdsReader for it.
+/// @tparam DataBaseType database with the callbacks of @ref GdsParser::GdsDataBaseKernel
+template <typename DataBaseType>
+class GdsReaderT
+{
+	public:
+        /// @brief constructor
+        /// @param db database
+		GdsReaderT(DataBaseType& db) : m_db(db) {}
+
+        /// @brief read from file, .gds.gz files are read through stream if compiled with ZLIB=1
+        /// @param filename file name
+        bool operator()(const char* filename)
+        {
+#if ZLIB == 1
+            if (limbo::get_file_suffix(filename) == "gz")
+            {
+                igdsgzstream in (filename);
+                if (!in.good())
+                    return false;
+                return (*this)(in);
+            }
+#endif
+            GdsFileMapping mapping;
+            // e.g., not a regular file, fall back to stream
+            if (!mapping.open(filename))
+            {
+                std::ifstream in (filename, std::ios::in | std::ios::binary);
+                if (!in.good())
+                {
+                    printf("failed to open %s for read\n", filename);
+                    return false;
+                }
+                return (*this)(in);
+            }
+            return read_buffer(mapping.data(), mapping.size());
+        }
+        /// @brief read from stream in chunks, records are decoded in place within each chunk
+        /// @param fp input stream
+        bool operator()(std::istream& fp)
+        {
+            vector<char> vBuffer (1024*1024);
+            std::size_t begin = 0; // start of unparsed bytes
+            std::size_t end = 0; // end of valid bytes
+            while (true)
+            {
+                // keep the incomplete record at the front, a record has at most 65535 bytes
+                if (begin)
+                {
+                    std::copy(vBuffer.begin()+begin, vBuffer.begin()+end, vBuffer.begin());
+                    end -= begin;
+                    begin = 0;
+                }
+                fp.read(&vBuffer[end], vBuffer.size()-end);
+                std::size_t no_read = fp.gcount();
+                if (no_read == 0)
+                    break;
+                end += no_read;
+                begin = parse_records(&vBuffer[0], end);
+            }
+            return check_tail(reinterpret_cast<unsigned char const*>(&vBuffer[0]), end);
+        }
+        /// @brief read from a memory buffer holding a complete GDSII stream
+        /// @param buffer start of the buffer
+        /// @param length number of bytes in the buffer
+        bool read_buffer(const char* buffer, std::size_t length)
+        {
+            std::size_t pos = parse_records(buffer, length);
+            return check_tail(reinterpret_cast<unsigned char const*>(buffer) + pos, length - pos);
+        }
+
+	protected:
+        /// @brief decode all complete records in a buffer
+        /// @param buffer start of the buffer
+        /// @param length number of bytes in the buffer
+        /// @return number of bytes consumed
+        std::size_t parse_records(const char* buffer, std::size_t length)
+        {
+            unsigned char const* bbegin = reinterpret_cast<unsigned char const*>(buffer);
+            unsigned char const* bptr = bbegin;
+            unsigned char const* bend = bptr + length;
+            while (bend - bptr >= 2)
+            {
+                int no_bytes = (bptr[0]<<8) + bptr[1];
+                // padding at the end of the file
+                if (no_bytes == 0)
+                {
+                    bptr += 2;
+                    continue;
+                }
+                // corrupted or incomplete record
+                if (no_bytes < 4 || bend - bptr < no_bytes)
+                    break;
+                parse_record(bptr + 2, no_bytes - 2);
+                bptr += no_bytes;
+            }
+            return bptr - bbegin;
+        }
+        /// @brief report bytes left after the last complete record
+        /// @param tail start of bytes left
+        /// @param length number of bytes left
+        bool check_tail(unsigned char const* tail, std::size_t length) const
+        {
+            if (length >= 2 || (length == 1 && *tail != 0))
+            {
+                printf ("# ***ERROR*** Couldn't read all of record.\n");
+                printf ("#             This is a corrupt file...\n");
+            }
+            return true;
+        }
+        /// @brief decode a record and invoke callbacks
+        /// @param record record content after the 2-byte length, starting from record type
+        /// @param no_read number of bytes in the record excluding the 2-byte length
+        void parse_record(unsigned char const* record, int no_read)
+        {
+            GdsRecords::EnumType record_type = gds_record_type(record[0]);
+            int expected_data_type = gds_record_expected_data(record_type);
+            // unknown records carry no callback
+            if (expected_data_type == 0xffff)
+                return;
+            if (expected_data_type != record[1])
+            {
+                printf ("# ***ERROR*** We were expecting data type 0x%02x (%s) to be specified for %s, but\n",
+                        expected_data_type, gds_data_ascii(expected_data_type), gds_record_ascii(record_type));
+                printf ("#             data type 0x%02x (%s) was specified.\n",
+                        record[1], gds_data_ascii(gds_data_type(record[1])));
+            }
+            gds_decode_record(m_db, record_type, (GdsData::EnumType)expected_data_type, record, no_read, m_vInteger, m_vFloat, m_string);
+        }
+
+		DataBaseType& m_db; ///< database
+        vector<int> m_vInteger; ///< bit arrays and integers
+        vector<double> m_vFloat; ///< floating point numbers
+        string m_string; ///< strings
+};
+
+/// @brief read from file with callbacks bound at compile time
+/// @tparam DataBaseType database with the callbacks of @ref GdsParser::GdsDataBaseKernel
+/// @param db GDSII database
+/// @param filename GDSII file
+template <typename DataBaseType>
+inline bool read_static(DataBaseType& db, string const& filename)
+{
+    return GdsReaderT<DataBaseType>(db)(filename.c_str());
+}
+
+} // namespace GdsParser
+
+#endif
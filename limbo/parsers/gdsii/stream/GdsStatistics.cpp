@@ -0,0 +1,390 @@
+/**
+ * @file   GdsStatistics.cpp
+ * @brief  Implementation of @ref GdsParser::GdsStatisticsDB
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/gdsii/stream/GdsStatistics.h>
+#include <stdio.h>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <limbo/containers/TaskPool.h>
+
+namespace GdsParser
+{
+
+GdsShapeStatistics::GdsShapeStatistics()
+    : num_boundaries(0)
+    , num_boxes(0)
+    , num_paths(0)
+    , num_texts(0)
+    , num_points(0)
+    , area(0)
+    , xl(std::numeric_limits<int>::max())
+    , yl(std::numeric_limits<int>::max())
+    , xh(std::numeric_limits<int>::min())
+    , yh(std::numeric_limits<int>::min())
+{
+}
+
+void GdsShapeStatistics::merge(GdsShapeStatistics const& rhs)
+{
+    num_boundaries += rhs.num_boundaries;
+    num_boxes += rhs.num_boxes;
+    num_paths += rhs.num_paths;
+    num_texts += rhs.num_texts;
+    num_points += rhs.num_points;
+    area += rhs.area;
+    xl = std::min(xl, rhs.xl);
+    yl = std::min(yl, rhs.yl);
+    xh = std::max(xh, rhs.xh);
+    yh = std::max(yh, rhs.yh);
+}
+
+GdsShapeStatistics GdsCellStatistics::total() const
+{
+    GdsShapeStatistics result;
+    for (layer_map_type::const_iterator it = layers.begin(), ite = layers.end(); it != ite; ++it)
+        result.merge(it->second);
+    return result;
+}
+
+GdsStatisticsDB::GdsStatisticsDB()
+    : m_element(GdsRecords::UNKNOWN)
+    , m_layer(0)
+    , m_datatype(0)
+    , m_width(0)
+    , m_numInstances(0)
+    , m_lastLayer(NULL)
+{
+    m_unit[0] = m_unit[1] = 0;
+}
+
+void GdsStatisticsDB::bit_array_cbk(GdsRecords::EnumType, GdsData::EnumType, vector<int> const&)
+{
+}
+
+void GdsStatisticsDB::integer_2_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, vector<int> const& vInteger)
+{
+    switch (record_type)
+    {
+        case GdsRecords::BGNSTR:
+            // with time stamps
+            begin_end_cbk(record_type);
+            return;
+        default:
+            break;
+    }
+    if (vInteger.empty())
+        return;
+    switch (record_type)
+    {
+        case GdsRecords::LAYER:
+            m_layer = vInteger[0];
+            break;
+        case GdsRecords::DATATYPE:
+        case GdsRecords::BOXTYPE:
+        case GdsRecords::TEXTTYPE:
+            m_datatype = vInteger[0];
+            break;
+        case GdsRecords::COLROW:
+            if (vInteger.size() >= 2)
+                m_numInstances = (std::size_t)std::max(vInteger[0], 0) * std::max(vInteger[1], 0);
+            break;
+        default:
+            break;
+    }
+}
+
+void GdsStatisticsDB::integer_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, vector<int> const& vInteger)
+{
+    switch (record_type)
+    {
+        case GdsRecords::WIDTH:
+            // negative width is absolute, which does not matter here
+            if (!vInteger.empty())
+                m_width = std::abs(vInteger[0]);
+            break;
+        case GdsRecords::XY:
+            {
+                std::size_t n = vInteger.size()/2;
+                if (n == 0)
+                    break;
+                m_shape.num_points += n;
+                for (std::size_t i = 0; i < n; ++i)
+                    m_shape.extend(vInteger[2*i], vInteger[2*i+1]);
+                if (m_element == GdsRecords::BOUNDARY || m_element == GdsRecords::BOX)
+                {
+                    // shoelace formula, the last point may or may not repeat the first one
+                    double area = 0;
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        std::size_t j = (i+1 == n)? 0 : i+1;
+                        area += (double)((long long)vInteger[2*i]*vInteger[2*j+1] - (long long)vInteger[2*j]*vInteger[2*i+1]);
+                    }
+                    m_shape.area = std::abs(area)/2;
+                }
+                else if (m_element == GdsRecords::PATH)
+                {
+                    // length of center line, multiplied by width at the end of element
+                    double length = 0;
+                    for (std::size_t i = 1; i < n; ++i)
+                    {
+                        double dx = (double)vInteger[2*i] - vInteger[2*i-2];
+                        double dy = (double)vInteger[2*i+1] - vInteger[2*i-1];
+                        length += sqrt(dx*dx + dy*dy);
+                    }
+                    m_shape.area = length;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void GdsStatisticsDB::real_4_cbk(GdsRecords::EnumType, GdsData::EnumType, vector<double> const&)
+{
+}
+
+void GdsStatisticsDB::real_8_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, vector<double> const& vFloat)
+{
+    if (record_type == GdsRecords::UNITS && vFloat.size() >= 2)
+    {
+        m_unit[0] = vFloat[0];
+        m_unit[1] = vFloat[1];
+    }
+}
+
+void GdsStatisticsDB::string_cbk(GdsRecords::EnumType record_type, GdsData::EnumType, string const& str)
+{
+    switch (record_type)
+    {
+        case GdsRecords::LIBNAME:
+            m_libName = str;
+            break;
+        case GdsRecords::STRNAME:
+            if (!m_vCell.empty())
+                m_vCell.back().name = str;
+            break;
+        default:
+            break;
+    }
+}
+
+void GdsStatisticsDB::begin_end_cbk(GdsRecords::EnumType record_type)
+{
+    switch (record_type)
+    {
+        case GdsRecords::BGNSTR:
+            m_vCell.push_back(GdsCellStatistics());
+            m_lastLayer = NULL;
+            break;
+        case GdsRecords::BOUNDARY:
+        case GdsRecords::BOX:
+        case GdsRecords::PATH:
+        case GdsRecords::TEXT:
+        case GdsRecords::SREF:
+        case GdsRecords::AREF:
+            m_element = record_type;
+            m_layer = m_datatype = m_width = 0;
+            m_numInstances = 0;
+            m_shape = GdsShapeStatistics();
+            break;
+        case GdsRecords::ENDEL:
+            end_element();
+            m_element = GdsRecords::UNKNOWN;
+            break;
+        default:
+            break;
+    }
+}
+
+void GdsStatisticsDB::end_element()
+{
+    // elements outside structures are ignored
+    if (m_vCell.empty())
+        return;
+    GdsCellStatistics& cell = m_vCell.back();
+    switch (m_element)
+    {
+        case GdsRecords::SREF:
+            ++cell.num_srefs;
+            return;
+        case GdsRecords::AREF:
+            ++cell.num_arefs;
+            cell.num_aref_instances += m_numInstances;
+            return;
+        case GdsRecords::BOUNDARY:
+            m_shape.num_boundaries = 1;
+            break;
+        case GdsRecords::BOX:
+            m_shape.num_boxes = 1;
+            break;
+        case GdsRecords::PATH:
+            m_shape.num_paths = 1;
+            m_shape.area *= m_width;
+            if (m_shape.has_bbox())
+            {
+                int half = m_width/2;
+                m_shape.xl -= half;
+                m_shape.yl -= half;
+                m_shape.xh += half;
+                m_shape.yh += half;
+            }
+            break;
+        case GdsRecords::TEXT:
+            m_shape.num_texts = 1;
+            m_shape.area = 0;
+            break;
+        default:
+            return;
+    }
+
+    layer_type key (m_layer, m_datatype);
+    if (m_lastLayer == NULL || m_lastKey != key)
+    {
+        m_lastLayer = &cell.layers[key];
+        m_lastKey = key;
+    }
+    m_lastLayer->merge(m_shape);
+}
+
+GdsStatisticsDB::layer_map_type GdsStatisticsDB::layers() const
+{
+    layer_map_type result;
+    for (vector<GdsCellStatistics>::const_iterator it = m_vCell.begin(), ite = m_vCell.end(); it != ite; ++it)
+    {
+        for (layer_map_type::const_iterator itl = it->layers.begin(), itle = it->layers.end(); itl != itle; ++itl)
+            result[itl->first].merge(itl->second);
+    }
+    return result;
+}
+
+void GdsStatisticsDB::merge(GdsStatisticsDB& rhs)
+{
+    if (m_libName.empty())
+        m_libName = rhs.m_libName;
+    if (m_unit[0] == 0 && m_unit[1] == 0)
+    {
+        m_unit[0] = rhs.m_unit[0];
+        m_unit[1] = rhs.m_unit[1];
+    }
+    m_vCell.reserve(m_vCell.size() + rhs.m_vCell.size());
+    for (vector<GdsCellStatistics>::iterator it = rhs.m_vCell.begin(), ite = rhs.m_vCell.end(); it != ite; ++it)
+    {
+        m_vCell.push_back(GdsCellStatistics());
+        m_vCell.back().name.swap(it->name);
+        m_vCell.back().layers.swap(it->layers);
+        m_vCell.back().num_srefs = it->num_srefs;
+        m_vCell.back().num_arefs = it->num_arefs;
+        m_vCell.back().num_aref_instances = it->num_aref_instances;
+    }
+    rhs.m_vCell.clear();
+    m_lastLayer = NULL;
+}
+
+void GdsStatisticsDB::print() const
+{
+    // square of user units per database unit
+    double scale = m_unit[0]*m_unit[0];
+    layer_map_type mLayer = layers();
+    printf("library %s, %lu structures\n", m_libName.c_str(), (unsigned long)m_vCell.size());
+    printf("%6s %8s %12s %12s %12s %12s %14s %16s  %s\n", "layer", "datatype", "boundaries", "boxes", "paths", "texts", "points", "area", "bbox");
+    for (layer_map_type::const_iterator it = mLayer.begin(), ite = mLayer.end(); it != ite; ++it)
+    {
+        GdsShapeStatistics const& s = it->second;
+        printf("%6d %8d %12lu %12lu %12lu %12lu %14lu %16.6g  (%d, %d, %d, %d)\n", it->first.first, it->first.second,
+                (unsigned long)s.num_boundaries, (unsigned long)s.num_boxes, (unsigned long)s.num_paths, (unsigned long)s.num_texts,
+                (unsigned long)s.num_points, s.area*scale, s.xl, s.yl, s.xh, s.yh);
+    }
+}
+
+/// @brief a group of consecutive structures read by one thread of @ref GdsParser::read_statistics
+struct GdsStatisticsTask
+{
+    const char* buffer; ///< start of the GDSII stream
+    vector<GdsStructureRange> const* vStructure; ///< all structures in the stream
+    std::size_t first; ///< index of the first structure in the group
+    std::size_t last; ///< index past the last structure in the group
+    GdsLayerFilter const* filter; ///< layers to keep
+    GdsStatisticsDB db; ///< statistics of the group
+};
+
+/// @brief groups of structures read by limbo::containers::parallel_for in @ref GdsParser::read_statistics
+struct GdsStatisticsKernel
+{
+    vector<GdsStatisticsTask>* vTask; ///< all groups
+    /// @brief read groups in [first, last)
+    /// @param first first group
+    /// @param last end group
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t index = first; index < last; ++index)
+        {
+            GdsStatisticsTask& task = (*vTask)[index];
+            GdsReader reader (task.db);
+            reader.set_layer_filter(*task.filter);
+            for (std::size_t i = task.first; i < task.last; ++i)
+            {
+                GdsStructureRange const& range = (*task.vStructure)[i];
+                reader.read_buffer(task.buffer + range.begin, range.end - range.begin);
+            }
+        }
+    }
+};
+
+bool read_statistics(GdsStatisticsDB& db, string const& filename, GdsLayerFilter const& filter, int numThreads)
+{
+    // BGZF blocks of compressed files can still be inflated in parallel
+    GdsFileMapping mapping;
+    if (limbo::get_file_suffix(filename) == "gz" || !mapping.open(filename.c_str()))
+        return read(db, filename, filter, numThreads);
+
+    GdsReader reader (db);
+    reader.set_layer_filter(filter);
+    vector<GdsStructureRange> vStructure;
+    if (numThreads <= 1
+            || !scan_structures(mapping.data(), mapping.size(), vStructure)
+            || vStructure.size() < 2)
+        return reader.read_buffer(mapping.data(), mapping.size());
+
+    // records before the first structure, i.e., HEADER, BGNLIB, LIBNAME, UNITS
+    reader.read_buffer(mapping.data(), vStructure.front().begin);
+
+    // split structures into groups of similar bytes, more groups than threads for load balance
+    std::size_t numTasks = std::min(vStructure.size(), (std::size_t)numThreads*4);
+    std::size_t totalBytes = vStructure.back().end - vStructure.front().begin;
+    vector<GdsStatisticsTask> vTask (numTasks);
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+        GdsStatisticsTask& task = vTask[i];
+        task.buffer = mapping.data();
+        task.vStructure = &vStructure;
+        task.filter = &filter;
+        task.first = first;
+        std::size_t targetEnd = vStructure.front().begin + totalBytes/numTasks*(i+1);
+        std::size_t last = first+1;
+        // leave at least one structure for each remaining group
+        while (last < vStructure.size()-(numTasks-i-1) && (i+1 == numTasks || vStructure[last-1].end < targetEnd))
+            ++last;
+        task.last = last;
+        first = last;
+    }
+
+    // threads take groups in turn
+    GdsStatisticsKernel kernel = {&vTask};
+    limbo::containers::parallel_for(0, numTasks, 1, std::min((unsigned int)numThreads, limbo::containers::num_threads()), kernel);
+
+    // collect structures in the order of the file
+    for (std::size_t i = 0; i < numTasks; ++i)
+        db.merge(vTask[i].db);
+
+    // records after the last structure, i.e., ENDLIB
+    reader.read_buffer(mapping.data() + vStructure.back().end, mapping.size() - vStructure.back().end);
+    return true;
+}
+
+} // namespace GdsParser
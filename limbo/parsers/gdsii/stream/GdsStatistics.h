@@ -0,0 +1,157 @@
+/**
+ * @file   GdsStatistics.h
+ * @brief  per-layer shape statistics of GDSII files computed in one streaming pass, see @ref GdsParser::GdsStatisticsDB
+ * @date   Oct 2026
+ */
+
+#ifndef _GDSPARSER_GDSSTATISTICS_H
+#define _GDSPARSER_GDSSTATISTICS_H
+
+#include <map>
+#include <limits>
+#include <algorithm>
+#include <limbo/parsers/gdsii/stream/GdsReader.h>
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+
+/// @brief aggregates of shapes on a (layer, datatype) pair.
+/// BOX elements use BOXTYPE and TEXT elements use TEXTTYPE as the data type.
+struct GdsShapeStatistics
+{
+    std::size_t num_boundaries; ///< number of BOUNDARY elements
+    std::size_t num_boxes; ///< number of BOX elements
+    std::size_t num_paths; ///< number of PATH elements
+    std::size_t num_texts; ///< number of TEXT elements
+    std::size_t num_points; ///< number of points in XY records
+    double area; ///< total area of polygons and boxes, paths count width times center line length, texts have no area
+    int xl; ///< lower left x of bounding box
+    int yl; ///< lower left y of bounding box
+    int xh; ///< upper right x of bounding box
+    int yh; ///< upper right y of bounding box
+
+    /// @brief constructor
+    GdsShapeStatistics();
+    /// @return number of shapes
+    std::size_t num_shapes() const {return num_boundaries + num_boxes + num_paths + num_texts;}
+    /// @return true if the bounding box is valid
+    bool has_bbox() const {return xl <= xh && yl <= yh;}
+    /// @brief extend bounding box
+    /// @param x x coordinate
+    /// @param y y coordinate
+    void extend(int x, int y)
+    {
+        xl = std::min(xl, x);
+        yl = std::min(yl, y);
+        xh = std::max(xh, x);
+        yh = std::max(yh, y);
+    }
+    /// @brief accumulate another statistics
+    /// @param rhs another statistics
+    void merge(GdsShapeStatistics const& rhs);
+};
+
+/// @brief shape statistics of a structure without expanding references
+struct GdsCellStatistics
+{
+    /// @nowarn
+    typedef std::pair<int, int> layer_type;
+    typedef std::map<layer_type, GdsShapeStatistics> layer_map_type;
+    /// @endnowarn
+
+    string name; ///< STRNAME of the structure
+    layer_map_type layers; ///< statistics per (layer, datatype)
+    std::size_t num_srefs; ///< number of SREF elements
+    std::size_t num_arefs; ///< number of AREF elements
+    std::size_t num_aref_instances; ///< number of instances in AREF elements, i.e., sum of columns times rows
+
+    /// @brief constructor
+    GdsCellStatistics() : num_srefs(0), num_arefs(0), num_aref_instances(0) {}
+    /// @return statistics of all layers
+    GdsShapeStatistics total() const;
+};
+
+/// @class GdsParser::GdsStatisticsDB
+/// @brief kernel database computing per-layer and per-cell shape statistics while reading.
+///
+/// Each element only updates a few counters, so no object is kept in memory and
+/// the memory footprint is proportional to the number of cells and layers instead of shapes.
+/// It can be used with @ref GdsParser::GdsReader directly, or through @ref GdsParser::read_statistics, which reads in parallel.
+/// With @ref GdsParser::GdsLayerFilter, BOUNDARY, PATH and BOX elements on other layers are skipped before decoding, 
+/// while TEXT elements are still counted.
+class GdsStatisticsDB : public GdsDataBaseKernel
+{
+    public:
+        /// @nowarn
+        typedef GdsCellStatistics::layer_type layer_type;
+        typedef GdsCellStatistics::layer_map_type layer_map_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        GdsStatisticsDB();
+
+        /// @name required callbacks from GdsDataBaseKernel
+        ///@{
+        virtual void bit_array_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vBitArray);
+        virtual void integer_2_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vInteger);
+        virtual void integer_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<int> const& vInteger);
+        virtual void real_4_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<double> const& vFloat);
+        virtual void real_8_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, vector<double> const& vFloat);
+        virtual void string_cbk(GdsRecords::EnumType record_type, GdsData::EnumType data_type, string const& str);
+        virtual void begin_end_cbk(GdsRecords::EnumType record_type);
+        ///@}
+
+        /// @return library name
+        string const& lib_name() const {return m_libName;}
+        /// @return user unit and database unit in meters from UNITS
+        double const* unit() const {return m_unit;}
+        /// @return statistics of all structures in the order of the file
+        vector<GdsCellStatistics> const& cells() const {return m_vCell;}
+        /// @return statistics of all structures
+        vector<GdsCellStatistics>& cells() {return m_vCell;}
+        /// @return statistics per (layer, datatype) summed over structures, references are not expanded
+        layer_map_type layers() const;
+        /// @brief keep library name and units of another database and append its structures,
+        /// e.g., to collect results of threads in the order of the file
+        /// @param rhs another database
+        void merge(GdsStatisticsDB& rhs);
+        /// @brief print statistics per (layer, datatype) with areas in square user units
+        void print() const;
+
+    protected:
+        /// @brief add the current element to the statistics of its layer
+        void end_element();
+
+        string m_libName; ///< LIBNAME
+        double m_unit[2]; ///< UNITS
+        vector<GdsCellStatistics> m_vCell; ///< statistics of structures
+
+        /// @name states of the current element
+        ///@{
+        GdsRecords::EnumType m_element; ///< BOUNDARY, BOX, PATH, TEXT, SREF, AREF, or UNKNOWN if not within an element
+        int m_layer; ///< LAYER
+        int m_datatype; ///< DATATYPE, BOXTYPE or TEXTTYPE
+        int m_width; ///< WIDTH of paths
+        std::size_t m_numInstances; ///< instances from COLROW
+        GdsShapeStatistics m_shape; ///< counters of the element, its bounding box and area
+        ///@}
+        /// cache of the last layer, as consecutive elements are often on the same layer
+        GdsShapeStatistics* m_lastLayer;
+        layer_type m_lastKey; ///< key of m_lastLayer
+};
+
+/// @brief compute statistics of a file in one pass without building objects.
+/// Uncompressed files are memory mapped; with multiple threads, structures located by @ref GdsParser::scan_structures
+/// are split into groups of similar bytes, each of which is read by one thread into its own database.
+/// Compressed and corrupted files are read serially.
+/// @param db database to collect statistics
+/// @param filename GDSII file
+/// @param filter layers to keep, an empty filter keeps everything
+/// @param numThreads number of threads
+/// @return true if succeed
+bool read_statistics(GdsStatisticsDB& db, string const& filename, GdsLayerFilter const& filter = GdsLayerFilter(), int numThreads = 1);
+
+} // namespace GdsParser
+
+#endif
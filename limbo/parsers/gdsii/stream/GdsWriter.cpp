@@ -105,6 +105,7 @@ ENDEL
 */
 
 #include <limbo/parsers/gdsii/stream/GdsWriter.h>
+#include <algorithm>
 #include <limbo/parsers/gdsii/stream/GdsRecords.h>
 #include <limbo/string/String.h>
 /// support to .gds.gz if enabled
@@ -162,13 +163,21 @@ class GdsStream
 /*------------------------------------------------------------------------------------------*/
 //    CONSTRUCTOR AND DESTRUCTOR
 /*------------------------------------------------------------------------------------------*/
-GdsWriter::GdsWriter(const char* filename)
+GdsWriter::GdsWriter(const char* filename, std::size_t buffer_size)
 {
 	//this->out = open( filename, O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH );
 	//if( this->out <= 0 ) BAILOUT( "UNABLE TO OPEN OUTPUT FILE" );
     m_os = new GdsStream (filename); 
 
-    m_capacity = 16*1024; // 16 KB
+    m_capacity = std::max(buffer_size, (std::size_t)1024); 
+    m_size = 0; 
+    m_buffer = new char [m_capacity]; 
+}
+GdsWriter::GdsWriter()
+{
+    m_os = NULL; // keep everything in memory 
+
+    m_capacity = 64*1024; // 64 KB, grow on demand 
     m_size = 0; 
     m_buffer = new char [m_capacity]; 
 }
@@ -206,6 +215,15 @@ inline void fast_copy (char *t, const char *s, std::size_t n)
 /// a buffered writing scheme 
 int GdsWriter::gds_write(const char* b, std::size_t n)
 {
+    if (m_os == NULL && m_size + n > m_capacity) // memory output, grow the buffer 
+    {
+        while (m_size + n > m_capacity)
+            m_capacity *= 2; 
+        char* buffer = new char [m_capacity]; 
+        memcpy(buffer, m_buffer, m_size); 
+        delete [] m_buffer; 
+        m_buffer = buffer; 
+    }
     //int ret; 
     while (m_size + n > m_capacity) 
     {
@@ -235,7 +253,7 @@ int GdsWriter::gds_write(const char* b, std::size_t n)
 
 void GdsWriter::gds_flush()
 {
-    if (m_size) // remember to write the rest content in the buffer 
+    if (m_os && m_size) // remember to write the rest content in the buffer 
     {
         //write (this->out, m_buffer, m_size);
         m_os->getStream().write(m_buffer, m_size);
@@ -243,6 +261,23 @@ void GdsWriter::gds_flush()
     }
 }
 
+void GdsWriter::write_bytes(const char* b, std::size_t n)
+{
+    if (m_os && n >= m_capacity) // large block goes to stream directly 
+    {
+        gds_flush(); 
+        m_os->getStream().write(b, n); 
+    }
+    else 
+        gds_write(b, n); 
+}
+
+void GdsWriter::clear()
+{
+    if (m_os == NULL)
+        m_size = 0; 
+}
+
 /*------------------------------------------------------------------------------------------*/
 //    HIGH LEVEL UTILITY FUNCTIONS
 /*------------------------------------------------------------------------------------------*/
@@ -273,6 +308,128 @@ void GdsWriter::write_box(int layer, int datatype, int xl, int yl, int xh, int y
 	this->gds_write_xy(  px, py, 4, false);    // polygon, four vertices, first vertex repeated => 5 points
     this->gds_write_endel(  );          // end of element
 }
+/// @brief put a 2-byte integer in big endian 
+/// @param p target 
+/// @param v value 
+/// @return position after the integer 
+inline BYTE* gds_put2bytes(BYTE* p, unsigned int v)
+{
+    p[0] = (v >> 8) & 0xff; 
+    p[1] = v & 0xff; 
+    return p+2; 
+}
+
+/// @brief put a 4-byte integer in big endian 
+/// @param p target 
+/// @param v value 
+/// @return position after the integer 
+inline BYTE* gds_put4bytes(BYTE* p, int v)
+{
+    unsigned int u = v; 
+    p[0] = (u >> 24) & 0xff; 
+    p[1] = (u >> 16) & 0xff; 
+    p[2] = (u >> 8) & 0xff; 
+    p[3] = u & 0xff; 
+    return p+4; 
+}
+
+/// @brief put BOUNDARY, LAYER and DATATYPE records, i.e., the common prefix of boundaries on a layer 
+/// @param p target with 16 bytes 
+/// @param layer layer 
+/// @param datatype data type 
+inline void gds_put_boundary_prefix(BYTE* p, int layer, int datatype)
+{
+    p = gds_put2bytes(p, 4); 
+    p = gds_put2bytes(p, 0x0800); // BOUNDARY 
+    p = gds_put2bytes(p, 6); 
+    p = gds_put2bytes(p, 0x0D02); // LAYER 
+    p = gds_put2bytes(p, layer); 
+    p = gds_put2bytes(p, 6); 
+    p = gds_put2bytes(p, 0x0E02); // DATATYPE 
+    gds_put2bytes(p, datatype); 
+}
+
+void GdsWriter::write_boxes(int layer, int datatype, const int* boxes, std::size_t n)
+{
+    if ( datatype < 0 || datatype > 255 )
+        WARNING( "DATATYPE OUT OF RANGE [0, 255]" ); 
+
+    // BOUNDARY, LAYER, DATATYPE, XY with 5 points and ENDEL 
+    const std::size_t element_size = 16 + 4+40 + 4; 
+    BYTE prefix[16]; 
+    gds_put_boundary_prefix(prefix, layer, datatype); 
+
+    const std::size_t chunk_size = 256; 
+    BYTE chunk[chunk_size*element_size]; 
+    for (std::size_t first = 0; first < n; first += chunk_size)
+    {
+        std::size_t last = std::min(first + chunk_size, n); 
+        BYTE* p = chunk; 
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const int* box = boxes + 4*i; // xl, yl, xh, yh 
+            memcpy(p, prefix, 16); 
+            p = gds_put2bytes(p + 16, 44); 
+            p = gds_put2bytes(p, 0x1003); // XY 
+            // same vertex order as write_box 
+            p = gds_put4bytes(p, box[0]); p = gds_put4bytes(p, box[1]); 
+            p = gds_put4bytes(p, box[0]); p = gds_put4bytes(p, box[3]); 
+            p = gds_put4bytes(p, box[2]); p = gds_put4bytes(p, box[3]); 
+            p = gds_put4bytes(p, box[2]); p = gds_put4bytes(p, box[1]); 
+            p = gds_put4bytes(p, box[0]); p = gds_put4bytes(p, box[1]); 
+            p = gds_put2bytes(p, 4); 
+            p = gds_put2bytes(p, 0x1100); // ENDEL 
+        }
+        gds_write((char*)chunk, p - chunk); 
+    }
+}
+
+void GdsWriter::write_polygons(int layer, int datatype, const int* offsets, std::size_t n, const int* points, bool has_last)
+{
+    if ( datatype < 0 || datatype > 255 )
+        WARNING( "DATATYPE OUT OF RANGE [0, 255]" ); 
+
+    BYTE prefix[16]; 
+    gds_put_boundary_prefix(prefix, layer, datatype); 
+
+    // encode elements into a local chunk and write it when it is full 
+    const std::size_t chunk_capacity = 64*1024; 
+    std::vector<BYTE> vChunk (chunk_capacity); 
+    std::size_t size = 0; 
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        int num_points = offsets[i+1] - offsets[i]; 
+        int num_xy = num_points + (!has_last && num_points > 0); 
+        if ( num_xy > 8200 ) BAILOUT( "WAY TOO MANY VERTICIES" );
+        std::size_t element_size = 16 + 4+8*num_xy + 4; 
+        if (size + element_size > vChunk.size())
+        {
+            gds_write((char*)&vChunk[0], size); 
+            size = 0; 
+            if (element_size > vChunk.size())
+                vChunk.resize(element_size); 
+        }
+
+        BYTE* p = &vChunk[size]; 
+        memcpy(p, prefix, 16); 
+        p = gds_put2bytes(p + 16, 4 + 8*num_xy); 
+        p = gds_put2bytes(p, 0x1003); // XY 
+        const int* xy = points + 2*offsets[i]; 
+        for (int j = 0; j < 2*num_points; ++j)
+            p = gds_put4bytes(p, xy[j]); 
+        if (num_xy > num_points)
+        {
+            p = gds_put4bytes(p, xy[0]); 
+            p = gds_put4bytes(p, xy[1]); 
+        }
+        p = gds_put2bytes(p, 4); 
+        gds_put2bytes(p, 0x1100); // ENDEL 
+        size += element_size; 
+    }
+    if (size)
+        gds_write((char*)&vChunk[0], size); 
+}
+
 void GdsWriter::create_lib(const char* libname, double dbu_uu, double dbu_m)
 {
 	// Write HEADER, BGNLIB, LIBNAME, and UNITS.
@@ -289,7 +446,7 @@ void GdsWriter::create_lib(const char* libname, double dbu_uu, double dbu_m)
 
 void GdsWriter::gds_swap4bytes( BYTE *four  )
 {
-	static BYTE temp;
+	BYTE temp;
 #if BYTESWAP
 	temp    = four[0];
 	four[0] = four[3];
@@ -302,9 +459,20 @@ void GdsWriter::gds_swap4bytes( BYTE *four  )
 
 /*------------------------------------------------------------------------------------------*/
 
+unsigned int GdsWriter::gds_swap4bytes_value( unsigned int four )
+{
+#if BYTESWAP
+	return (four >> 24) | ((four >> 8) & 0x0000ff00u) | ((four << 8) & 0x00ff0000u) | (four << 24);
+#else
+	return four;
+#endif
+}
+
+/*------------------------------------------------------------------------------------------*/
+
 void GdsWriter::gds_swap2bytes( BYTE *two )
 {
-	static BYTE temp;
+	BYTE temp;
 #if BYTESWAP 
 	temp   = two[0];
 	two[0] = two[1];
@@ -318,7 +486,7 @@ void GdsWriter::gds_make_next_item( struct gds_itemtype **ci )
 {
 	// mag, angle and strans must be tallied
 	// only when flattening the pattern.
-	static struct gds_itemtype
+	struct gds_itemtype
 		*current_item;
 
 
@@ -361,7 +529,7 @@ void GdsWriter::gds_make_next_item( struct gds_itemtype **ci )
 void GdsWriter::gds_bindump( BYTE x )            // dump one byte in binary format
 {                            // way too clever hack from a forum post, sorry
 	int z;
-	static char b[9];
+	char b[9];
 
 	b[0] = '\0';
 
@@ -510,7 +678,8 @@ void GdsWriter::gds_write_bgnlib(  )
 	//date = (struct tm *) malloc( sizeof( struct tm ) );
 
 	time( now );
-	date = localtime( now );
+	struct tm date_buffer; // localtime is not thread-safe
+	date = localtime_r( now, &date_buffer );
 
 	count = 0x1C;
 	gds_swap2bytes( (BYTE *) &count );
@@ -553,10 +722,10 @@ void GdsWriter::gds_write_bgnlib(  )
 
 void GdsWriter::gds_write_bgnstr(  )
 {
-	static time_t *now;
-	static struct tm *date;
+	time_t *now;
+	struct tm *date;
 
-	static short int 
+	short int 
 		year,
 		month,
 		day,
@@ -570,7 +739,8 @@ void GdsWriter::gds_write_bgnstr(  )
 	//date = (struct tm *) malloc( sizeof( struct tm ) );
 
 	time( now );
-	date = localtime( now );
+	struct tm date_buffer; // localtime is not thread-safe
+	date = localtime_r( now, &date_buffer );
 
 	year   = 1900 + date->tm_year;   
 	month  = 1 + date->tm_mon;
@@ -613,7 +783,7 @@ void GdsWriter::gds_write_bgnstr(  )
 
 void GdsWriter::gds_write_endlib(  )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -634,7 +804,7 @@ void GdsWriter::gds_write_endlib(  )
 
 void GdsWriter::gds_write_endstr(  )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -678,7 +848,7 @@ void GdsWriter::gds_write_libname( const char *name )
 
 void GdsWriter::gds_write_strname( const char *name )
 {
-	static short int         // name should be null-terminated
+	short int         // name should be null-terminated
 		count,
 		token;
 
@@ -705,7 +875,7 @@ void GdsWriter::gds_write_strname( const char *name )
 
 void GdsWriter::gds_write_string( const char *s )
 {                               // s must by null-terminated
-	static short int          
+	short int          
 		count,
 		token;
 
@@ -737,7 +907,7 @@ void GdsWriter::gds_write_string( const char *s )
 
 void GdsWriter::gds_write_sname( const char *s )
 {
-	static short int                // s should be null-terminated
+	short int                // s should be null-terminated
 		count,
 		token;
 
@@ -762,7 +932,7 @@ void GdsWriter::gds_write_sname( const char *s )
 
 void GdsWriter::gds_write_boundary(  )
 {                             // just the token here. "xy" writes the actual polygon.
-	static short int
+	short int
 		count,
 		token;
 
@@ -783,7 +953,7 @@ void GdsWriter::gds_write_box(  )
 	// but later, people started using them like polygons.
 	// The spec says we need to store five points,
 	// just like a boundary, which is so stupid.
-	static short int
+	short int
 		count,
 	token;
 
@@ -803,7 +973,7 @@ void GdsWriter::gds_write_box(  )
 
 void GdsWriter::gds_write_boxtype( short int dt )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -828,7 +998,7 @@ void GdsWriter::gds_write_boxtype( short int dt )
 /*------------------------------------------------------------------------------------------*/
 void GdsWriter::gds_write_path(  )
 {                             // Just the token here. "xy" writes the actual path.
-	static short int
+	short int
 		count,
 		token;
 
@@ -846,7 +1016,7 @@ void GdsWriter::gds_write_path(  )
 
 void GdsWriter::gds_write_sref(  )
 {                             // Only the token is written here.
-	static short int
+	short int
 		count,
 		token;
 
@@ -864,7 +1034,7 @@ void GdsWriter::gds_write_sref(  )
 
 void GdsWriter::gds_write_aref(  )
 {
-	static short int                   // write the aref token only
+	short int                   // write the aref token only
 		count,
 		token;
 
@@ -882,7 +1052,7 @@ void GdsWriter::gds_write_aref(  )
 
 void GdsWriter::gds_write_text(  )
 {
-	static short int                   // write the text token only
+	short int                   // write the text token only
 		count,
 		token;
 
@@ -900,7 +1070,7 @@ void GdsWriter::gds_write_text(  )
 
 void GdsWriter::gds_write_endel(  )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -918,7 +1088,7 @@ void GdsWriter::gds_write_endel(  )
 
 void GdsWriter::gds_write_layer( short int layer )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -944,7 +1114,7 @@ void GdsWriter::gds_write_layer( short int layer )
 
 void GdsWriter::gds_write_width( int width )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -964,7 +1134,7 @@ void GdsWriter::gds_write_width( int width )
 
 void GdsWriter::gds_write_datatype( short int dt )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -990,7 +1160,7 @@ void GdsWriter::gds_write_datatype( short int dt )
 
 void GdsWriter::gds_write_texttype( short int dt )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -1016,7 +1186,7 @@ void GdsWriter::gds_write_texttype( short int dt )
 
 void GdsWriter::gds_write_generations( short int gens )
 {                                       // most useless parameter ever
-	static short int
+	short int
 		count,
 		token;
 
@@ -1042,7 +1212,7 @@ void GdsWriter::gds_write_generations( short int gens )
 
 void GdsWriter::gds_write_pathtype( short int pt )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -1068,7 +1238,7 @@ void GdsWriter::gds_write_presentation(      // file descriptor
 		int vp,      // vertical presentation    0 = top  1 = middle  2 = bottom
 		int hp )     // horizontal presentation  0 = left 1 = center  2 = right
 {
-	static unsigned short
+	unsigned short
 		token, 
 		count,
 		num;
@@ -1113,7 +1283,7 @@ void GdsWriter::gds_write_strans(            // output file descriptor
 		BOOL abs_angle,     // angles are absolute (normally false)
 		BOOL abs_mag  )     // magnification (scale) is absolute (normally false) 
 {             
-	static unsigned short int
+	unsigned short int
 		count,
 		token,
 		strans;
@@ -1139,12 +1309,10 @@ void GdsWriter::gds_write_strans(            // output file descriptor
 // else number of xy pairs is n+1
 void GdsWriter::gds_write_xy( const int *x, const int *y, int n, bool has_last )
 {
-	static short int            // If this is a polygon, be sure to repeat the first vertex.
+	short int            // If this is a polygon, be sure to repeat the first vertex.
 		count,                  // If this is a path, do not repeat.
 		token;
 
-	static int i;
-
 	//if ( n > 200  ) WARNING( "OVER 200 VERTICIES" );
 	if ( n+!has_last > 8200 ) BAILOUT( "WAY TOO MANY VERTICIES" );
 
@@ -1155,17 +1323,25 @@ void GdsWriter::gds_write_xy( const int *x, const int *y, int n, bool has_last )
 	gds_swap2bytes( (BYTE *) &token );
 	gds_write((char*)(&token), 2 );
 
-	for ( i=0; i<n; i++ )
+	// convert byte order in chunks of a local array, 
+	// which leaves the input untouched and lets the compiler vectorize the loop 
+	const int chunk_size = 256; 
+	unsigned int chunk[2*chunk_size]; 
+	for (int first = 0; first < n; first += chunk_size)
 	{
-		gds_swap4bytes( (BYTE *) &(x[i]) );
-		gds_swap4bytes( (BYTE *) &(y[i]) );
-		gds_write((char*)(&(x[i])), 4 );
-		gds_write((char*)(&(y[i])), 4 );
+		int last = std::min(first + chunk_size, n); 
+		for (int i = first; i < last; ++i)
+		{
+			chunk[2*(i-first)] = gds_swap4bytes_value( x[i] ); 
+			chunk[2*(i-first)+1] = gds_swap4bytes_value( y[i] ); 
+		}
+		gds_write((char*)chunk, 8*(last-first) );
 	}
 	if (n > 0 && !has_last)
 	{
-		gds_write((char*)(&(x[0])), 4 );
-		gds_write((char*)(&(y[0])), 4 );
+		chunk[0] = gds_swap4bytes_value( x[0] ); 
+		chunk[1] = gds_swap4bytes_value( y[0] ); 
+		gds_write((char*)chunk, 8 );
 	}
 
 }  // write_xy
@@ -1175,7 +1351,7 @@ void GdsWriter::gds_write_xy( const int *x, const int *y, int n, bool has_last )
 
 void GdsWriter::gds_write_colrow(  int ncols, int nrows )
 {             
-	static unsigned short int
+	unsigned short int
 		count,
 		token,
 		sicols,
@@ -1207,7 +1383,7 @@ void GdsWriter::gds_write_colrow(  int ncols, int nrows )
 
 void GdsWriter::gds_write_bgnextn( int bgnextn )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -1226,7 +1402,7 @@ void GdsWriter::gds_write_bgnextn( int bgnextn )
 
 void GdsWriter::gds_write_endextn( int endextn )
 {
-	static short int
+	short int
 		count,
 		token;
 
@@ -1264,7 +1440,7 @@ void GdsWriter::gds_write_units( double dbu_uu, double dbu_m )
 
 void GdsWriter::gds_write_mag( double mag )
 {
-	static int
+	int
 		count,
 		token;
 
@@ -1282,7 +1458,7 @@ void GdsWriter::gds_write_mag( double mag )
 
 void GdsWriter::gds_write_angle( double angle )
 {
-	static int
+	int
 		count,
 		token;
 
@@ -1328,7 +1504,7 @@ void GdsWriter::gds_create_lib( const char *libname, double dbu_um )
 
 void GdsWriter::gds_create_text( const char *str, int x, int y, int layer, int size )
 { 
-	static int xx[1], yy[1];
+	int xx[1], yy[1];
 
 	// generate text centered at x,y
 
@@ -91,8 +91,12 @@ struct GdsWriter
 {
     public:
         /// @brief constructor 
-        /// @param filename output file name 
-        GdsWriter(const char* filename);
+        /// @param filename output file name, .gds.gz is compressed if enabled 
+        /// @param buffer_size bytes of output buffer 
+        GdsWriter(const char* filename, std::size_t buffer_size = 1024*1024);
+        /// @brief constructor of a writer keeping all output in memory, 
+        /// e.g., to encode structures in parallel and concatenate them later with @ref write_bytes 
+        GdsWriter();
         /// @brief destructor 
         ~GdsWriter();
 
@@ -114,6 +118,23 @@ struct GdsWriter
         /// @param datatype data type 
         /// @param xl, yl, xh, yh coordinates of the box 
         void write_box(int layer, int datatype, int xl, int yl, int xh, int yh);
+        /// @brief write many box objects on a layer at once, 
+        /// the result is the same as calling @ref write_box for each box 
+        /// @param layer layer 
+        /// @param datatype data type 
+        /// @param boxes array of 4*n coordinates, xl, yl, xh, yh for each box 
+        /// @param n number of boxes 
+        void write_boxes(int layer, int datatype, const int* boxes, std::size_t n);
+        /// @brief write many boundary objects on a layer at once from a CSR-style buffer, 
+        /// the result is the same as calling @ref write_boundary for each polygon 
+        /// @param layer layer 
+        /// @param datatype data type 
+        /// @param offsets array of n+1 offsets, points of polygon i are [offsets[i], offsets[i+1]) 
+        /// @param n number of polygons 
+        /// @param points array of interleaved coordinates, x and y for each point 
+        /// @param has_last if true, the last point of each polygon is the same as the first point; 
+        ///                 otherwise, the first point is repeated at the end. 
+        void write_polygons(int layer, int datatype, const int* offsets, std::size_t n, const int* points, bool has_last = true);
         /// @brief create GDSII library 
         /// @param libname name of the library 
         /// @param dbu_uu is user unit, 1nm per bit
@@ -121,6 +142,17 @@ struct GdsWriter
         /// this wrapper is different from gds_create_lib in terms of units 
         void create_lib(const char* libname, double dbu_uu, double dbu_m);
 
+        /// @brief write encoded bytes, e.g., output of another writer 
+        /// @param b start of bytes 
+        /// @param n number of bytes 
+        void write_bytes(const char* b, std::size_t n);
+        /// @return start of bytes in memory, i.e., all output of a memory writer 
+        const char* data() const {return m_buffer;}
+        /// @return number of bytes in memory, i.e., all output of a memory writer 
+        std::size_t size() const {return m_size;}
+        /// @brief discard output of a memory writer 
+        void clear();
+
         ///@}
         
         /**************** low level interfaces *****************/
@@ -135,6 +167,10 @@ struct GdsWriter
         /// @brief swap bytes 
         /// @param four 4-byte of data 
         void gds_swap4bytes( BYTE *four  );
+        /// @brief swap bytes of a 4-byte integer 
+        /// @param four 4-byte of data 
+        /// @return swapped value 
+        static unsigned int gds_swap4bytes_value( unsigned int four );
         /// @brief swap bytes 
         /// @param two 2-byte of data 
         void gds_swap2bytes( BYTE *two );
@@ -264,7 +300,7 @@ struct GdsWriter
         /// flush all contents in the buffer 
         void gds_flush(); 
 
-        GdsStream* m_os; ///< output stream 
+        GdsStream* m_os; ///< output stream, NULL for memory output 
         //int out; // output gds file descriptor
         BYTE  gdsswap; ///< moved from global variables 
         short gdsword; ///< move from global variables 
@@ -0,0 +1,1166 @@
+/**
+ * @file   OasisReader.cpp
+ * @brief  read OASIS file through the callbacks of a GDSII database
+ * @date   Oct 2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <stdexcept>
+#include <fstream>
+#include <algorithm>
+#include <limbo/parsers/gdsii/stream/OasisReader.h>
+/// CBLOCK records are inflated by zlib if enabled
+#if ZLIB == 1
+#include <zlib.h>
+#endif
+
+namespace GdsParser
+{
+
+/// @brief error of a corrupted or unsupported OASIS file
+struct OasisFormatError : public std::runtime_error
+{
+    /// @brief constructor
+    /// @param msg message
+    OasisFormatError(const char* msg) : std::runtime_error(msg) {}
+};
+
+/// @brief largest reference number accepted for name tables
+static const unsigned long long OASIS_MAX_REFNUM = 1ULL<<28;
+
+/// @brief vertices of CTRAPEZOID types as multiples of width and height, {xw, xh, yw, yh} for x = xw*w+xh*h and y = yw*w+yh*h
+static const int oasis_ctrapezoid[26][4][4] = {
+    {{0, 0, 0, 0}, {0, 0, 0, 1}, {1, -1, 0, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, 0, 1}, {1, 0, 0, 1}, {1, -1, 0, 0}},
+    {{0, 0, 0, 0}, {0, 1, 0, 1}, {1, 0, 0, 1}, {1, 0, 0, 0}},
+    {{0, 1, 0, 0}, {0, 0, 0, 1}, {1, 0, 0, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 1, 0, 1}, {1, -1, 0, 1}, {1, 0, 0, 0}},
+    {{0, 1, 0, 0}, {0, 0, 0, 1}, {1, 0, 0, 1}, {1, -1, 0, 0}},
+    {{0, 0, 0, 0}, {0, 1, 0, 1}, {1, 0, 0, 1}, {1, -1, 0, 0}},
+    {{0, 1, 0, 0}, {0, 0, 0, 1}, {1, -1, 0, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, 0, 1}, {1, 0, -1, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, -1, 1}, {1, 0, 0, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, 0, 1}, {1, 0, 0, 1}, {1, 0, 1, 0}},
+    {{0, 0, 1, 0}, {0, 0, 0, 1}, {1, 0, 0, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, 0, 1}, {1, 0, -1, 1}, {1, 0, 1, 0}},
+    {{0, 0, 1, 0}, {0, 0, -1, 1}, {1, 0, 0, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, -1, 1}, {1, 0, 0, 1}, {1, 0, 1, 0}},
+    {{0, 0, 1, 0}, {0, 0, 0, 1}, {1, 0, -1, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 0}, {0, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, 1, 0}, {1, 0, 1, 0}, {0, 0, 0, 0}},
+    {{0, 0, 0, 0}, {1, 0, 1, 0}, {1, 0, 0, 0}, {0, 0, 0, 0}},
+    {{0, 0, 1, 0}, {1, 0, 1, 0}, {1, 0, 0, 0}, {0, 0, 1, 0}},
+    {{0, 0, 0, 0}, {0, 1, 0, 1}, {0, 2, 0, 0}, {0, 0, 0, 0}},
+    {{0, 0, 0, 1}, {0, 2, 0, 1}, {0, 1, 0, 0}, {0, 0, 0, 1}},
+    {{0, 0, 0, 0}, {0, 0, 2, 0}, {1, 0, 1, 0}, {0, 0, 0, 0}},
+    {{1, 0, 0, 0}, {0, 0, 1, 0}, {1, 0, 2, 0}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, 0, 1}, {1, 0, 0, 1}, {1, 0, 0, 0}},
+    {{0, 0, 0, 0}, {0, 0, 1, 0}, {1, 0, 1, 0}, {1, 0, 0, 0}}
+};
+
+void OasisReader::Modal::reset()
+{
+    absolute = true;
+    placement = geometry = text = Point();
+    placementCell.clear();
+    layer = datatype = textlayer = texttype = 0;
+    textString.clear();
+    width = height = 0;
+    vPolygon.clear();
+    vPath.clear();
+    halfwidth = startExtn = endExtn = 0;
+    ctrapezoidType = 0;
+    radius = 0;
+    repetition = Repetition();
+}
+
+OasisReader::OasisReader(GdsDataBaseKernel& db)
+    : m_db(db)
+    , m_circle_vertices(64)
+    , m_begin(NULL)
+    , m_ptr(NULL)
+    , m_end(NULL)
+    , m_file(NULL)
+    , m_emit(true)
+    , m_in_cell(false)
+    , m_table_seen(false)
+    , m_cellname_count(0)
+    , m_textstring_count(0)
+    , m_propname_count(0)
+    , m_propstring_count(0)
+    , m_xname_count(0)
+{
+    m_modal.reset();
+}
+
+bool OasisReader::operator()(const char* filename)
+{
+    GdsFileMapping mapping;
+    if (!mapping.open(filename))
+    {
+        printf("failed to open %s for read\n", filename);
+        return false;
+    }
+    return read_buffer(mapping.data(), mapping.size());
+}
+
+bool OasisReader::read_buffer(const char* buffer, std::size_t length)
+{
+    if (!is_oasis(buffer, length))
+    {
+        printf("# ***ERROR*** missing OASIS magic bytes\n");
+        return false;
+    }
+    const unsigned char* begin = reinterpret_cast<const unsigned char*>(buffer);
+    const unsigned char* end = begin + length;
+    m_file = begin;
+    m_vCellName.clear();
+    m_vTextString.clear();
+    m_in_cell = false;
+    try
+    {
+        // names are resolved before any record is translated
+        read_start(begin + OASIS_MAGIC_SIZE, end);
+
+        m_emit = true;
+        m_cellname_count = m_textstring_count = m_propname_count = m_propstring_count = m_xname_count = 0;
+        m_modal.reset();
+        if (read_records(begin + OASIS_MAGIC_SIZE, end, false) != STOP)
+            throw OasisFormatError("missing END record");
+    }
+    catch (std::exception& e)
+    {
+        printf("# ***ERROR*** OASIS %s at byte %lu\n", e.what(), (unsigned long)(m_ptr - m_begin));
+        return false;
+    }
+    return true;
+}
+
+void OasisReader::read_start(const unsigned char* begin, const unsigned char* end)
+{
+    m_begin = m_ptr = begin;
+    m_end = end;
+    if (read_uint() != OasisRecords::START)
+        throw OasisFormatError("missing START record");
+    skip_string(); // version
+    read_real(); // unit
+    unsigned long long vTable[12];
+    if (read_uint() == 0) // table offsets in START
+    {
+        for (int i = 0; i < 12; ++i)
+            vTable[i] = read_uint();
+    }
+    else // table offsets in END
+    {
+        if (end - m_file < OASIS_END_SIZE)
+            throw OasisFormatError("truncated END record");
+        m_begin = m_ptr = end - OASIS_END_SIZE;
+        if (read_uint() != OasisRecords::END)
+            throw OasisFormatError("missing END record");
+        for (int i = 0; i < 12; ++i)
+            vTable[i] = read_uint();
+    }
+
+    // pairs of strict flag and offset for CELLNAME, TEXTSTRING, PROPNAME, PROPSTRING, LAYERNAME and XNAME,
+    // only cell names and text strings are needed
+    m_emit = false;
+    bool strict = true;
+    for (int i = 0; i < 2; ++i)
+    {
+        unsigned long long offset = vTable[2*i+1];
+        strict = strict && vTable[2*i] != 0;
+        if (offset != 0)
+        {
+            if (offset >= (unsigned long long)(end - m_file))
+                throw OasisFormatError("invalid table offset");
+            m_cellname_count = m_textstring_count = m_propname_count = m_propstring_count = m_xname_count = 0;
+            m_table_seen = false;
+            m_modal.reset();
+            read_records(m_file + offset, end, true);
+        }
+    }
+    // names may be anywhere without strict tables, so collect them from the whole file
+    if (!strict)
+    {
+        m_cellname_count = m_textstring_count = m_propname_count = m_propstring_count = m_xname_count = 0;
+        m_modal.reset();
+        read_records(begin, end, false);
+    }
+    m_in_cell = false;
+}
+
+OasisReader::Status OasisReader::read_records(const unsigned char* begin, const unsigned char* end, bool tableOnly)
+{
+    const unsigned char* savedBegin = m_begin;
+    const unsigned char* savedPtr = m_ptr;
+    const unsigned char* savedEnd = m_end;
+    m_begin = m_ptr = begin;
+    m_end = end;
+    Status status = CONTINUE;
+
+    while (status == CONTINUE && m_ptr < m_end)
+    {
+        const unsigned char* recordBegin = m_ptr;
+        unsigned long long record = read_uint();
+        bool nameRecord = (record >= OasisRecords::CELLNAME_IMPLICIT && record <= OasisRecords::LAYERNAME_TEXT)
+            || record == OasisRecords::XNAME_IMPLICIT || record == OasisRecords::XNAME;
+        // a table ends at the first record of another kind
+        if (tableOnly && m_table_seen && !nameRecord && record != OasisRecords::PAD
+                && record != OasisRecords::PROPERTY && record != OasisRecords::PROPERTY_REPEAT && record != OasisRecords::CBLOCK)
+        {
+            m_ptr = recordBegin;
+            status = STOP;
+            break;
+        }
+        // names end the current cell
+        if (nameRecord)
+        {
+            end_cell();
+            m_table_seen = true;
+        }
+
+        switch (record)
+        {
+            case OasisRecords::PAD:
+                break;
+            case OasisRecords::START:
+                {
+                    m_name.clear();
+                    skip_string(); // version
+                    double unit = read_real();
+                    if (!(unit > 0))
+                        throw OasisFormatError("invalid unit");
+                    if (read_uint() == 0)
+                        for (int i = 0; i < 12; ++i)
+                            read_uint();
+                    if (m_emit)
+                    {
+                        emit_integer_2(GdsRecords::HEADER, 600);
+                        m_vInteger.assign(12, 0);
+                        m_db.integer_2_cbk(GdsRecords::BGNLIB, GdsData::INTEGER_2, m_vInteger);
+                        m_db.string_cbk(GdsRecords::LIBNAME, GdsData::STRING, "LIB");
+                        m_vFloat.resize(2);
+                        m_vFloat[0] = 1.0/unit;
+                        m_vFloat[1] = 1e-6/unit;
+                        m_db.real_8_cbk(GdsRecords::UNITS, GdsData::REAL_8, m_vFloat);
+                    }
+                }
+                break;
+            case OasisRecords::END:
+                end_cell();
+                if (m_emit)
+                    m_db.begin_end_cbk(GdsRecords::ENDLIB);
+                m_ptr = m_end;
+                status = STOP;
+                break;
+            case OasisRecords::CELLNAME_IMPLICIT:
+            case OasisRecords::CELLNAME:
+                read_string(m_name);
+                define(m_vCellName, (record == OasisRecords::CELLNAME)? read_uint() : m_cellname_count++, m_name);
+                break;
+            case OasisRecords::TEXTSTRING_IMPLICIT:
+            case OasisRecords::TEXTSTRING:
+                read_string(m_name);
+                define(m_vTextString, (record == OasisRecords::TEXTSTRING)? read_uint() : m_textstring_count++, m_name);
+                break;
+            case OasisRecords::PROPNAME_IMPLICIT:
+            case OasisRecords::PROPNAME:
+                skip_string();
+                if (record == OasisRecords::PROPNAME) read_uint();
+                else ++m_propname_count;
+                break;
+            case OasisRecords::PROPSTRING_IMPLICIT:
+            case OasisRecords::PROPSTRING:
+                skip_string();
+                if (record == OasisRecords::PROPSTRING) read_uint();
+                else ++m_propstring_count;
+                break;
+            case OasisRecords::LAYERNAME:
+            case OasisRecords::LAYERNAME_TEXT:
+                skip_string();
+                read_interval();
+                read_interval();
+                break;
+            case OasisRecords::CELL_REFNUM:
+            case OasisRecords::CELL:
+                {
+                    end_cell();
+                    if (record == OasisRecords::CELL_REFNUM)
+                        m_name = name(m_vCellName, read_uint());
+                    else
+                        read_string(m_name);
+                    m_modal.reset();
+                    if (m_emit)
+                    {
+                        m_vInteger.assign(12, 0);
+                        m_db.integer_2_cbk(GdsRecords::BGNSTR, GdsData::INTEGER_2, m_vInteger);
+                        m_db.string_cbk(GdsRecords::STRNAME, GdsData::STRING, m_name);
+                    }
+                    m_in_cell = true;
+                }
+                break;
+            case OasisRecords::XYABSOLUTE:
+                m_modal.absolute = true;
+                break;
+            case OasisRecords::XYRELATIVE:
+                m_modal.absolute = false;
+                break;
+            case OasisRecords::PLACEMENT:
+            case OasisRecords::PLACEMENT_TRANSFORM:
+                read_placement(record == OasisRecords::PLACEMENT_TRANSFORM);
+                break;
+            case OasisRecords::TEXT:
+                read_text();
+                break;
+            case OasisRecords::RECTANGLE:
+                read_rectangle();
+                break;
+            case OasisRecords::POLYGON:
+                read_polygon();
+                break;
+            case OasisRecords::PATH:
+                read_path();
+                break;
+            case OasisRecords::TRAPEZOID:
+            case OasisRecords::TRAPEZOID_A:
+            case OasisRecords::TRAPEZOID_B:
+                read_trapezoid(record);
+                break;
+            case OasisRecords::CTRAPEZOID:
+                read_ctrapezoid();
+                break;
+            case OasisRecords::CIRCLE:
+                read_circle();
+                break;
+            case OasisRecords::PROPERTY:
+                read_property();
+                break;
+            case OasisRecords::PROPERTY_REPEAT:
+                break;
+            case OasisRecords::XNAME_IMPLICIT:
+            case OasisRecords::XNAME:
+                read_uint(); // attribute
+                skip_string();
+                if (record == OasisRecords::XNAME) read_uint();
+                else ++m_xname_count;
+                break;
+            case OasisRecords::XELEMENT:
+                read_uint(); // attribute
+                skip_string();
+                break;
+            case OasisRecords::XGEOMETRY:
+                {
+                    unsigned char info = read_byte();
+                    read_uint(); // attribute
+                    if (info & 0x01) m_modal.layer = read_uint();
+                    if (info & 0x02) m_modal.datatype = read_uint();
+                    skip_string();
+                    read_xy(info, 0x10, 0x08, m_modal.geometry);
+                    if (info & 0x04) read_repetition();
+                }
+                break;
+            case OasisRecords::CBLOCK:
+                status = read_cblock(tableOnly);
+                break;
+            default:
+                throw OasisFormatError("unknown record");
+        }
+    }
+
+    m_begin = savedBegin;
+    m_ptr = savedPtr;
+    m_end = savedEnd;
+    return status;
+}
+
+OasisReader::Status OasisReader::read_cblock(bool tableOnly)
+{
+    if (read_uint() != 0)
+        throw OasisFormatError("unknown CBLOCK compression");
+    unsigned long long uncompressed = read_uint();
+    unsigned long long compressed = read_uint();
+    if (compressed > (unsigned long long)(m_end - m_ptr))
+        throw OasisFormatError("truncated CBLOCK");
+    // the expansion of DEFLATE is bounded by about 1032:1
+    if (uncompressed > compressed*1032 + 64)
+        throw OasisFormatError("invalid CBLOCK size");
+#if ZLIB == 1
+    m_vInflate.resize(uncompressed);
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    // raw DEFLATE without zlib header
+    if (inflateInit2(&zs, -15) != Z_OK)
+        throw OasisFormatError("failed to initialize zlib");
+    zs.next_in = const_cast<Bytef*>(m_ptr);
+    zs.avail_in = compressed;
+    zs.next_out = m_vInflate.empty()? NULL : &m_vInflate[0];
+    zs.avail_out = uncompressed;
+    int ret = inflate(&zs, Z_FINISH);
+    inflateEnd(&zs);
+    if (ret != Z_STREAM_END || zs.total_out != uncompressed)
+        throw OasisFormatError("corrupted CBLOCK");
+    m_ptr += compressed;
+    // the block is read from its own buffer, so the buffer can be reused by later blocks
+    std::vector<unsigned char> vRecord;
+    vRecord.swap(m_vInflate);
+    Status status = (vRecord.empty())? CONTINUE : read_records(&vRecord[0], &vRecord[0] + vRecord.size(), tableOnly);
+    vRecord.swap(m_vInflate);
+    return status;
+#else
+    throw OasisFormatError("CBLOCK requires ZLIB=1");
+#endif
+}
+
+void OasisReader::read_placement(bool transform)
+{
+    unsigned char info = read_byte();
+    if (info & 0x80)
+    {
+        if (info & 0x40)
+            m_modal.placementCell = name(m_vCellName, read_uint());
+        else
+            read_string(m_modal.placementCell);
+    }
+    double angle = 0;
+    double mag = 1;
+    if (transform)
+    {
+        if (info & 0x04) mag = read_real();
+        if (info & 0x02) angle = read_real();
+    }
+    else
+        angle = ((info>>1)&0x03)*90;
+    read_xy(info, 0x20, 0x10, m_modal.placement);
+    bool repeated = (info & 0x08);
+    if (repeated) read_repetition();
+    if (m_emit)
+        emit_placement(angle, mag, (info & 0x01), repeated);
+}
+
+void OasisReader::read_text()
+{
+    unsigned char info = read_byte();
+    if (info & 0x40)
+    {
+        if (info & 0x20)
+            m_modal.textString = name(m_vTextString, read_uint());
+        else
+            read_string(m_modal.textString);
+    }
+    if (info & 0x01) m_modal.textlayer = read_uint();
+    if (info & 0x02) m_modal.texttype = read_uint();
+    read_xy(info, 0x10, 0x08, m_modal.text);
+    bool repeated = (info & 0x04);
+    if (repeated) read_repetition();
+    if (m_emit)
+        emit_text(repeated);
+}
+
+void OasisReader::read_rectangle()
+{
+    unsigned char info = read_byte();
+    if (info & 0x01) m_modal.layer = read_uint();
+    if (info & 0x02) m_modal.datatype = read_uint();
+    if (info & 0x40) m_modal.width = read_uint();
+    if (info & 0x80) // square
+    {
+        if (info & 0x20)
+            throw OasisFormatError("height of square");
+        m_modal.height = m_modal.width;
+    }
+    else if (info & 0x20)
+        m_modal.height = read_uint();
+    read_xy(info, 0x10, 0x08, m_modal.geometry);
+    bool repeated = (info & 0x04);
+    if (repeated) read_repetition();
+    if (m_emit && keep(m_modal.layer, m_modal.datatype))
+    {
+        m_vPoint.resize(4);
+        m_vPoint[0] = Point(0, 0);
+        m_vPoint[1] = Point(0, m_modal.height);
+        m_vPoint[2] = Point(m_modal.width, m_modal.height);
+        m_vPoint[3] = Point(m_modal.width, 0);
+        emit_boundary(m_vPoint, m_modal.geometry, repeated);
+    }
+}
+
+void OasisReader::read_polygon()
+{
+    unsigned char info = read_byte();
+    if (info & 0x01) m_modal.layer = read_uint();
+    if (info & 0x02) m_modal.datatype = read_uint();
+    if (info & 0x20) read_point_list(m_modal.vPolygon, true);
+    read_xy(info, 0x10, 0x08, m_modal.geometry);
+    bool repeated = (info & 0x04);
+    if (repeated) read_repetition();
+    if (m_emit && keep(m_modal.layer, m_modal.datatype))
+        emit_boundary(m_modal.vPolygon, m_modal.geometry, repeated);
+}
+
+void OasisReader::read_path()
+{
+    unsigned char info = read_byte();
+    if (info & 0x01) m_modal.layer = read_uint();
+    if (info & 0x02) m_modal.datatype = read_uint();
+    if (info & 0x40) m_modal.halfwidth = read_uint();
+    if (info & 0x80) // extension scheme 0000SSEE
+    {
+        unsigned long long scheme = read_uint();
+        switch ((scheme>>2)&0x03)
+        {
+            case 1: m_modal.startExtn = 0; break;
+            case 2: m_modal.startExtn = m_modal.halfwidth; break;
+            case 3: m_modal.startExtn = read_sint(); break;
+            default: break;
+        }
+        switch (scheme&0x03)
+        {
+            case 1: m_modal.endExtn = 0; break;
+            case 2: m_modal.endExtn = m_modal.halfwidth; break;
+            case 3: m_modal.endExtn = read_sint(); break;
+            default: break;
+        }
+    }
+    if (info & 0x20) read_point_list(m_modal.vPath, false);
+    read_xy(info, 0x10, 0x08, m_modal.geometry);
+    bool repeated = (info & 0x04);
+    if (repeated) read_repetition();
+    if (m_emit && keep(m_modal.layer, m_modal.datatype))
+        emit_path(m_modal.geometry, repeated);
+}
+
+void OasisReader::read_trapezoid(int type)
+{
+    unsigned char info = read_byte();
+    if (info & 0x01) m_modal.layer = read_uint();
+    if (info & 0x02) m_modal.datatype = read_uint();
+    if (info & 0x40) m_modal.width = read_uint();
+    if (info & 0x20) m_modal.height = read_uint();
+    long long da = (type != OasisRecords::TRAPEZOID_B)? read_sint() : 0;
+    long long db = (type != OasisRecords::TRAPEZOID_A)? read_sint() : 0;
+    read_xy(info, 0x10, 0x08, m_modal.geometry);
+    bool repeated = (info & 0x04);
+    if (repeated) read_repetition();
+    if (m_emit && keep(m_modal.layer, m_modal.datatype))
+    {
+        long long w = m_modal.width;
+        long long h = m_modal.height;
+        m_vPoint.resize(4);
+        if (info & 0x80) // vertical
+        {
+            m_vPoint[0] = Point(0, std::max(da, 0LL));
+            m_vPoint[1] = Point(0, h + std::min(db, 0LL));
+            m_vPoint[2] = Point(w, h - std::max(db, 0LL));
+            m_vPoint[3] = Point(w, -std::min(da, 0LL));
+        }
+        else // horizontal
+        {
+            m_vPoint[0] = Point(-std::min(da, 0LL), 0);
+            m_vPoint[1] = Point(std::max(da, 0LL), h);
+            m_vPoint[2] = Point(w + std::min(db, 0LL), h);
+            m_vPoint[3] = Point(w - std::max(db, 0LL), 0);
+        }
+        emit_boundary(m_vPoint, m_modal.geometry, repeated);
+    }
+}
+
+void OasisReader::read_ctrapezoid()
+{
+    unsigned char info = read_byte();
+    if (info & 0x01) m_modal.layer = read_uint();
+    if (info & 0x02) m_modal.datatype = read_uint();
+    if (info & 0x80) m_modal.ctrapezoidType = read_uint();
+    if (m_modal.ctrapezoidType > 25)
+        throw OasisFormatError("invalid CTRAPEZOID type");
+    if (info & 0x40) m_modal.width = read_uint();
+    if (info & 0x20) m_modal.height = read_uint();
+    read_xy(info, 0x10, 0x08, m_modal.geometry);
+    bool repeated = (info & 0x04);
+    if (repeated) read_repetition();
+    if (m_emit && keep(m_modal.layer, m_modal.datatype))
+    {
+        unsigned type = m_modal.ctrapezoidType;
+        long long w = m_modal.width;
+        long long h = m_modal.height;
+        // some types take a single dimension
+        if ((type >= 16 && type <= 19) || type == 25) h = w;
+        else if (type == 20 || type == 21) w = 2*h;
+        else if (type == 22 || type == 23) h = 2*w;
+        m_vPoint.clear();
+        for (int i = 0; i < 4; ++i)
+        {
+            int const* v = oasis_ctrapezoid[type][i];
+            Point p (v[0]*w + v[1]*h, v[2]*w + v[3]*h);
+            // triangles repeat the first vertex
+            if (i == 3 && p.x == m_vPoint.front().x && p.y == m_vPoint.front().y)
+                break;
+            m_vPoint.push_back(p);
+        }
+        emit_boundary(m_vPoint, m_modal.geometry, repeated);
+    }
+}
+
+void OasisReader::read_circle()
+{
+    unsigned char info = read_byte();
+    if (info & 0x01) m_modal.layer = read_uint();
+    if (info & 0x02) m_modal.datatype = read_uint();
+    if (info & 0x20) m_modal.radius = read_uint();
+    read_xy(info, 0x10, 0x08, m_modal.geometry);
+    bool repeated = (info & 0x04);
+    if (repeated) read_repetition();
+    if (m_emit && keep(m_modal.layer, m_modal.datatype))
+    {
+        m_vPoint.resize(m_circle_vertices);
+        for (int i = 0; i < m_circle_vertices; ++i)
+        {
+            double a = 2*M_PI*i/m_circle_vertices;
+            m_vPoint[i] = Point((long long)floor(m_modal.radius*cos(a) + 0.5), (long long)floor(m_modal.radius*sin(a) + 0.5));
+        }
+        emit_boundary(m_vPoint, m_modal.geometry, repeated);
+    }
+}
+
+void OasisReader::read_property()
+{
+    unsigned char info = read_byte();
+    if (info & 0x04) // explicit name
+    {
+        if (info & 0x02) read_uint();
+        else skip_string();
+    }
+    if (info & 0x08) // reuse the last value list
+        return;
+    unsigned long long count = info>>4;
+    if (count == 15)
+        count = read_uint();
+    for (unsigned long long i = 0; i < count; ++i)
+    {
+        unsigned long long type = read_uint();
+        if (type <= 7) read_real(type);
+        else if (type == 8) read_uint();
+        else if (type == 9) read_sint();
+        else if (type <= 12) skip_string();
+        else if (type <= 15) read_uint();
+        else throw OasisFormatError("invalid property value");
+    }
+}
+
+unsigned long long OasisReader::read_uint()
+{
+    unsigned long long value = 0;
+    for (int shift = 0; ; shift += 7)
+    {
+        if (m_ptr >= m_end)
+            throw OasisFormatError("unexpected end of records");
+        unsigned char byte = *m_ptr++;
+        if (shift > 63 || (shift == 63 && (byte & 0x7e)))
+            throw OasisFormatError("integer overflow");
+        value |= (unsigned long long)(byte & 0x7f)<<shift;
+        if (!(byte & 0x80))
+            break;
+    }
+    return value;
+}
+
+long long OasisReader::read_sint()
+{
+    unsigned long long value = read_uint();
+    long long magnitude = (long long)(value>>1);
+    return (value & 1)? -magnitude : magnitude;
+}
+
+double OasisReader::read_real()
+{
+    return read_real(read_uint());
+}
+
+double OasisReader::read_real(unsigned long long type)
+{
+    switch (type)
+    {
+        case 0: return (double)read_uint();
+        case 1: return -(double)read_uint();
+        case 2: return 1.0/read_uint();
+        case 3: return -1.0/read_uint();
+        case 4: {double n = read_uint(); return n/read_uint();}
+        case 5: {double n = read_uint(); return -n/read_uint();}
+        case 6:
+        case 7:
+            {
+                std::size_t bytes = (type == 6)? 4 : 8;
+                if ((std::size_t)(m_end - m_ptr) < bytes)
+                    throw OasisFormatError("unexpected end of records");
+                // IEEE 754 in little endian
+                unsigned long long bits = 0;
+                for (std::size_t i = 0; i < bytes; ++i)
+                    bits |= (unsigned long long)m_ptr[i]<<(8*i);
+                m_ptr += bytes;
+                if (type == 6)
+                {
+                    unsigned int b = bits;
+                    float f;
+                    memcpy(&f, &b, 4);
+                    return f;
+                }
+                double d;
+                memcpy(&d, &bits, 8);
+                return d;
+            }
+        default:
+            throw OasisFormatError("invalid real");
+    }
+}
+
+void OasisReader::read_string(std::string& str)
+{
+    unsigned long long length = read_uint();
+    if (length > (unsigned long long)(m_end - m_ptr))
+        throw OasisFormatError("unexpected end of records");
+    str.assign(reinterpret_cast<const char*>(m_ptr), length);
+    m_ptr += length;
+}
+
+void OasisReader::skip_string()
+{
+    unsigned long long length = read_uint();
+    if (length > (unsigned long long)(m_end - m_ptr))
+        throw OasisFormatError("unexpected end of records");
+    m_ptr += length;
+}
+
+OasisReader::Point OasisReader::read_gdelta()
+{
+    unsigned long long value = read_uint();
+    if (value & 1) // form 2, x and y
+    {
+        long long x = (long long)(value>>2);
+        if (value & 2) x = -x;
+        return Point(x, read_sint());
+    }
+    // form 1, octangular direction and magnitude
+    long long m = (long long)(value>>4);
+    switch ((value>>1)&0x07)
+    {
+        case 0: return Point(m, 0);
+        case 1: return Point(0, m);
+        case 2: return Point(-m, 0);
+        case 3: return Point(0, -m);
+        case 4: return Point(m, m);
+        case 5: return Point(-m, m);
+        case 6: return Point(-m, -m);
+        default: return Point(m, -m);
+    }
+}
+
+unsigned char OasisReader::read_byte()
+{
+    if (m_ptr >= m_end)
+        throw OasisFormatError("unexpected end of records");
+    return *m_ptr++;
+}
+
+void OasisReader::read_point_list(std::vector<Point>& vPoint, bool polygon)
+{
+    unsigned long long type = read_uint();
+    unsigned long long count = read_uint();
+    // each delta takes at least one byte
+    if (count > (unsigned long long)(m_end - m_ptr))
+        throw OasisFormatError("invalid point list");
+    vPoint.resize(1);
+    vPoint[0] = Point(0, 0);
+    Point p;
+    switch (type)
+    {
+        case 0: // alternating horizontal and vertical 1-deltas
+        case 1:
+            {
+                bool horizontal = (type == 0);
+                for (unsigned long long i = 0; i < count; ++i, horizontal = !horizontal)
+                {
+                    if (horizontal) p.x += read_sint();
+                    else p.y += read_sint();
+                    vPoint.push_back(p);
+                }
+                // the last vertex of a polygon is implied
+                if (polygon)
+                {
+                    if (horizontal) vPoint.push_back(Point(0, p.y));
+                    else vPoint.push_back(Point(p.x, 0));
+                }
+            }
+            break;
+        case 2: // 2-deltas
+            for (unsigned long long i = 0; i < count; ++i)
+            {
+                unsigned long long value = read_uint();
+                long long m = (long long)(value>>2);
+                switch (value&0x03)
+                {
+                    case 0: p.x += m; break;
+                    case 1: p.y += m; break;
+                    case 2: p.x -= m; break;
+                    default: p.y -= m; break;
+                }
+                vPoint.push_back(p);
+            }
+            break;
+        case 3: // 3-deltas
+            for (unsigned long long i = 0; i < count; ++i)
+            {
+                unsigned long long value = read_uint();
+                long long m = (long long)(value>>3);
+                switch (value&0x07)
+                {
+                    case 0: p.x += m; break;
+                    case 1: p.y += m; break;
+                    case 2: p.x -= m; break;
+                    case 3: p.y -= m; break;
+                    case 4: p.x += m; p.y += m; break;
+                    case 5: p.x -= m; p.y += m; break;
+                    case 6: p.x -= m; p.y -= m; break;
+                    default: p.x += m; p.y -= m; break;
+                }
+                vPoint.push_back(p);
+            }
+            break;
+        case 4: // g-deltas
+            for (unsigned long long i = 0; i < count; ++i)
+            {
+                Point d = read_gdelta();
+                p.x += d.x;
+                p.y += d.y;
+                vPoint.push_back(p);
+            }
+            break;
+        case 5: // g-deltas of deltas
+            {
+                Point d;
+                for (unsigned long long i = 0; i < count; ++i)
+                {
+                    Point dd = read_gdelta();
+                    d.x += dd.x;
+                    d.y += dd.y;
+                    p.x += d.x;
+                    p.y += d.y;
+                    vPoint.push_back(p);
+                }
+            }
+            break;
+        default:
+            throw OasisFormatError("invalid point list type");
+    }
+}
+
+void OasisReader::read_repetition()
+{
+    Repetition& rep = m_modal.repetition;
+    unsigned long long type = read_uint();
+    if (type == 0) // reuse
+    {
+        if (rep.kind == Repetition::NONE)
+            throw OasisFormatError("no repetition to reuse");
+        return;
+    }
+    rep.kind = Repetition::GRID;
+    rep.columns = rep.rows = 1;
+    rep.colVector = rep.rowVector = Point();
+    rep.vOffset.clear();
+    switch (type)
+    {
+        case 1: // matrix
+            rep.columns = read_uint() + 2;
+            rep.rows = read_uint() + 2;
+            rep.colVector.x = read_uint();
+            rep.rowVector.y = read_uint();
+            break;
+        case 2: // row
+            rep.columns = read_uint() + 2;
+            rep.colVector.x = read_uint();
+            break;
+        case 3: // column
+            rep.rows = read_uint() + 2;
+            rep.rowVector.y = read_uint();
+            break;
+        case 4: // irregular row
+        case 5:
+        case 6: // irregular column
+        case 7:
+            {
+                unsigned long long n = read_uint() + 2;
+                if (n > (unsigned long long)(m_end - m_ptr) + 1)
+                    throw OasisFormatError("invalid repetition");
+                long long grid = (type == 5 || type == 7)? read_uint() : 1;
+                rep.kind = Repetition::LIST;
+                rep.vOffset.push_back(Point());
+                long long s = 0;
+                for (unsigned long long i = 1; i < n; ++i)
+                {
+                    s += read_uint()*grid;
+                    rep.vOffset.push_back((type <= 5)? Point(s, 0) : Point(0, s));
+                }
+            }
+            break;
+        case 8: // matrix of arbitrary vectors
+            rep.columns = read_uint() + 2;
+            rep.rows = read_uint() + 2;
+            rep.colVector = read_gdelta();
+            rep.rowVector = read_gdelta();
+            break;
+        case 9: // row of an arbitrary vector
+            rep.columns = read_uint() + 2;
+            rep.colVector = read_gdelta();
+            break;
+        case 10: // arbitrary displacements
+        case 11:
+            {
+                unsigned long long n = read_uint() + 2;
+                if (n > (unsigned long long)(m_end - m_ptr) + 1)
+                    throw OasisFormatError("invalid repetition");
+                long long grid = (type == 11)? read_uint() : 1;
+                rep.kind = Repetition::LIST;
+                rep.vOffset.push_back(Point());
+                Point p;
+                for (unsigned long long i = 1; i < n; ++i)
+                {
+                    Point d = read_gdelta();
+                    p.x += d.x*grid;
+                    p.y += d.y*grid;
+                    rep.vOffset.push_back(p);
+                }
+            }
+            break;
+        default:
+            throw OasisFormatError("invalid repetition type");
+    }
+}
+
+void OasisReader::read_interval()
+{
+    switch (read_uint())
+    {
+        case 0: break;
+        case 1:
+        case 2:
+        case 3: read_uint(); break;
+        case 4: read_uint(); read_uint(); break;
+        default: throw OasisFormatError("invalid interval");
+    }
+}
+
+void OasisReader::read_xy(unsigned char info, unsigned char xbit, unsigned char ybit, Point& modal)
+{
+    if (info & xbit)
+    {
+        long long x = read_sint();
+        modal.x = (m_modal.absolute)? x : modal.x + x;
+    }
+    if (info & ybit)
+    {
+        long long y = read_sint();
+        modal.y = (m_modal.absolute)? y : modal.y + y;
+    }
+}
+
+void OasisReader::end_cell()
+{
+    if (m_in_cell && m_emit)
+        m_db.begin_end_cbk(GdsRecords::ENDSTR);
+    m_in_cell = false;
+}
+
+void OasisReader::offsets(bool repeated, std::vector<Point>& vOffset) const
+{
+    vOffset.assign(1, Point());
+    if (!repeated)
+        return;
+    Repetition const& rep = m_modal.repetition;
+    if (rep.kind == Repetition::LIST)
+        vOffset = rep.vOffset;
+    else if (rep.kind == Repetition::GRID)
+    {
+        vOffset.clear();
+        for (long long j = 0; j < rep.rows; ++j)
+            for (long long i = 0; i < rep.columns; ++i)
+                vOffset.push_back(Point(i*rep.colVector.x + j*rep.rowVector.x, i*rep.colVector.y + j*rep.rowVector.y));
+    }
+}
+
+void OasisReader::emit_boundary(std::vector<Point> const& vPoint, Point const& origin, bool repeated)
+{
+    if (vPoint.size() < 3)
+        throw OasisFormatError("polygon with less than 3 vertices");
+    offsets(repeated, m_vOffset);
+    for (std::vector<Point>::const_iterator it = m_vOffset.begin(); it != m_vOffset.end(); ++it)
+    {
+        m_db.begin_end_cbk(GdsRecords::BOUNDARY);
+        emit_integer_2(GdsRecords::LAYER, m_modal.layer);
+        emit_integer_2(GdsRecords::DATATYPE, m_modal.datatype);
+        emit_xy(vPoint, Point(origin.x + it->x, origin.y + it->y), true);
+        m_db.begin_end_cbk(GdsRecords::ENDEL);
+    }
+}
+
+void OasisReader::emit_path(Point const& origin, bool repeated)
+{
+    int pathtype = 4;
+    if (m_modal.startExtn == 0 && m_modal.endExtn == 0)
+        pathtype = 0;
+    else if (m_modal.startExtn == m_modal.halfwidth && m_modal.endExtn == m_modal.halfwidth)
+        pathtype = 2;
+    offsets(repeated, m_vOffset);
+    for (std::vector<Point>::const_iterator it = m_vOffset.begin(); it != m_vOffset.end(); ++it)
+    {
+        m_db.begin_end_cbk(GdsRecords::PATH);
+        emit_integer_2(GdsRecords::LAYER, m_modal.layer);
+        emit_integer_2(GdsRecords::DATATYPE, m_modal.datatype);
+        emit_integer_2(GdsRecords::PATHTYPE, pathtype);
+        emit_integer_4(GdsRecords::WIDTH, 2*m_modal.halfwidth);
+        if (pathtype == 4)
+        {
+            emit_integer_4(GdsRecords::BGNEXTN, m_modal.startExtn);
+            emit_integer_4(GdsRecords::ENDEXTN, m_modal.endExtn);
+        }
+        emit_xy(m_modal.vPath, Point(origin.x + it->x, origin.y + it->y), false);
+        m_db.begin_end_cbk(GdsRecords::ENDEL);
+    }
+}
+
+void OasisReader::emit_text(bool repeated)
+{
+    offsets(repeated, m_vOffset);
+    for (std::vector<Point>::const_iterator it = m_vOffset.begin(); it != m_vOffset.end(); ++it)
+    {
+        m_db.begin_end_cbk(GdsRecords::TEXT);
+        emit_integer_2(GdsRecords::LAYER, m_modal.textlayer);
+        emit_integer_2(GdsRecords::TEXTTYPE, m_modal.texttype);
+        m_vPoint.assign(1, Point());
+        emit_xy(m_vPoint, Point(m_modal.text.x + it->x, m_modal.text.y + it->y), false);
+        m_db.string_cbk(GdsRecords::STRING, GdsData::STRING, m_modal.textString);
+        m_db.begin_end_cbk(GdsRecords::ENDEL);
+    }
+}
+
+void OasisReader::emit_placement(double angle, double mag, bool flip, bool repeated)
+{
+    Repetition const& rep = m_modal.repetition;
+    bool array = repeated && rep.kind == Repetition::GRID;
+    if (array)
+        offsets(false, m_vOffset);
+    else
+        offsets(repeated, m_vOffset);
+    for (std::vector<Point>::const_iterator it = m_vOffset.begin(); it != m_vOffset.end(); ++it)
+    {
+        m_db.begin_end_cbk((array)? GdsRecords::AREF : GdsRecords::SREF);
+        m_db.string_cbk(GdsRecords::SNAME, GdsData::STRING, m_modal.placementCell);
+        if (flip || angle != 0 || mag != 1)
+        {
+            m_vInteger.assign(1, (flip)? 0x8000 : 0);
+            m_db.bit_array_cbk(GdsRecords::STRANS, GdsData::BIT_ARRAY, m_vInteger);
+            if (mag != 1)
+                emit_real_8(GdsRecords::MAG, mag);
+            if (angle != 0)
+                emit_real_8(GdsRecords::ANGLE, angle);
+        }
+        Point origin (m_modal.placement.x + it->x, m_modal.placement.y + it->y);
+        if (array)
+        {
+            m_vInteger.resize(2);
+            m_vInteger[0] = rep.columns;
+            m_vInteger[1] = rep.rows;
+            m_db.integer_2_cbk(GdsRecords::COLROW, GdsData::INTEGER_2, m_vInteger);
+            // origin, displacement of all columns and displacement of all rows
+            m_vPoint.resize(3);
+            m_vPoint[0] = Point();
+            m_vPoint[1] = Point(rep.columns*rep.colVector.x, rep.columns*rep.colVector.y);
+            m_vPoint[2] = Point(rep.rows*rep.rowVector.x, rep.rows*rep.rowVector.y);
+        }
+        else
+            m_vPoint.assign(1, Point());
+        emit_xy(m_vPoint, origin, false);
+        m_db.begin_end_cbk(GdsRecords::ENDEL);
+    }
+}
+
+void OasisReader::emit_xy(std::vector<Point> const& vPoint, Point const& offset, bool closed)
+{
+    m_vInteger.clear();
+    for (std::vector<Point>::const_iterator it = vPoint.begin(); it != vPoint.end(); ++it)
+    {
+        m_vInteger.push_back(offset.x + it->x);
+        m_vInteger.push_back(offset.y + it->y);
+    }
+    if (closed && !vPoint.empty())
+    {
+        m_vInteger.push_back(offset.x + vPoint.front().x);
+        m_vInteger.push_back(offset.y + vPoint.front().y);
+    }
+    m_db.integer_4_cbk(GdsRecords::XY, GdsData::INTEGER_4, m_vInteger);
+}
+
+void OasisReader::emit_integer_2(GdsRecords::EnumType record, int value)
+{
+    m_vInteger.assign(1, value);
+    m_db.integer_2_cbk(record, GdsData::INTEGER_2, m_vInteger);
+}
+
+void OasisReader::emit_integer_4(GdsRecords::EnumType record, int value)
+{
+    m_vInteger.assign(1, value);
+    m_db.integer_4_cbk(record, GdsData::INTEGER_4, m_vInteger);
+}
+
+void OasisReader::emit_real_8(GdsRecords::EnumType record, double value)
+{
+    m_vFloat.assign(1, value);
+    m_db.real_8_cbk(record, GdsData::REAL_8, m_vFloat);
+}
+
+std::string const& OasisReader::name(std::vector<std::string> const& vName, unsigned long long refnum) const
+{
+    // names are only needed for translation, so they may be unknown while collecting names
+    static const std::string empty;
+    if (refnum < vName.size() && !vName[refnum].empty())
+        return vName[refnum];
+    if (m_emit)
+        throw OasisFormatError("undefined reference number");
+    return empty;
+}
+
+void OasisReader::define(std::vector<std::string>& vName, unsigned long long refnum, std::string const& str)
+{
+    if (refnum >= OASIS_MAX_REFNUM)
+        throw OasisFormatError("reference number too large");
+    if (refnum >= vName.size())
+        vName.resize(refnum+1);
+    vName[refnum] = str;
+}
+
+bool is_oasis(const char* buffer, std::size_t length)
+{
+    return length >= OASIS_MAGIC_SIZE && memcmp(buffer, OASIS_MAGIC, OASIS_MAGIC_SIZE) == 0;
+}
+
+bool is_oasis(string const& filename)
+{
+    std::ifstream in (filename.c_str(), std::ios::binary);
+    char buffer[OASIS_MAGIC_SIZE];
+    return in.read(buffer, OASIS_MAGIC_SIZE) && is_oasis(buffer, OASIS_MAGIC_SIZE);
+}
+
+bool read_oasis(GdsDataBaseKernel& db, string const& filename)
+{
+    OasisReader reader (db);
+    return reader(filename.c_str());
+}
+
+bool read_oasis(GdsDataBaseKernel& db, string const& filename, GdsLayerFilter const& filter)
+{
+    OasisReader reader (db);
+    reader.set_layer_filter(filter);
+    return reader(filename.c_str());
+}
+
+} // namespace GdsParser
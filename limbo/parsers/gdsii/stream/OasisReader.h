@@ -0,0 +1,259 @@
+/**
+ * @file   OasisReader.h
+ * @brief  read OASIS file through the callbacks of a GDSII database
+ * @date   Oct 2026
+ */
+
+#ifndef _GDSPARSER_OASISREADER_H
+#define _GDSPARSER_OASISREADER_H
+
+#include <string>
+#include <vector>
+#include <limbo/parsers/gdsii/stream/GdsReader.h>
+#include <limbo/parsers/gdsii/stream/OasisRecords.h>
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+
+/// @class GdsParser::OasisReader
+/// @brief Read OASIS records and translate them into GDSII records of @ref GdsParser::GdsDataBaseKernel,
+/// so any GDSII database can read OASIS files without change.
+///
+/// The library gets a LIBNAME of "LIB" and UNITS of 1/unit user units and 1e-6/unit meters,
+/// where unit is the grid steps per micron in START.
+/// CELL is BGNSTR and STRNAME, while RECTANGLE, POLYGON, TRAPEZOID, CTRAPEZOID and CIRCLE are BOUNDARY.
+/// PATH keeps the half-width and extensions through WIDTH, PATHTYPE, BGNEXTN and ENDEXTN.
+/// PLACEMENT with a regular repetition is AREF, and other repetitions are expanded into elements.
+/// Modal variables, name tables and CBLOCK records are resolved by the reader.
+/// CIRCLE is approximated by a polygon, while PROPERTY, XNAME, XELEMENT and XGEOMETRY records are skipped.
+class OasisReader
+{
+    public:
+        /// @brief constructor
+        /// @param db database receiving GDSII records
+        OasisReader(GdsDataBaseKernel& db);
+
+        /// @brief read an OASIS file through memory mapping
+        /// @param filename OASIS file
+        /// @return true if succeed
+        bool operator()(const char* filename);
+        /// @brief read OASIS file content from a memory buffer
+        /// @param buffer start of the file content
+        /// @param length number of bytes
+        /// @return true if succeed
+        bool read_buffer(const char* buffer, std::size_t length);
+
+        /// @brief only keep geometries on some layers
+        /// @param filter layers to keep, an empty filter keeps everything
+        void set_layer_filter(GdsLayerFilter const& filter) {m_filter = filter;}
+        /// @return layers to keep
+        GdsLayerFilter const& layer_filter() const {return m_filter;}
+        /// @brief number of vertices of polygons approximating circles
+        /// @param n number of vertices, at least 4
+        void set_circle_vertices(int n) {m_circle_vertices = (n < 4)? 4 : n;}
+    protected:
+        /// @brief a point, OASIS coordinates take 64 bits
+        struct Point
+        {
+            long long x; ///< x coordinate
+            long long y; ///< y coordinate
+            /// @brief constructor
+            Point(long long xx = 0, long long yy = 0) : x(xx), y(yy) {}
+        };
+        /// @brief decoded repetition
+        struct Repetition
+        {
+            /// @brief kind of repetition
+            enum Kind {NONE, GRID, LIST};
+            Kind kind; ///< kind of repetition
+            long long columns; ///< number of instances along the first vector of a grid
+            long long rows; ///< number of instances along the second vector of a grid
+            Point colVector; ///< displacement between columns of a grid
+            Point rowVector; ///< displacement between rows of a grid
+            std::vector<Point> vOffset; ///< offsets of all instances of a list, including the origin
+            /// @brief constructor
+            Repetition() : kind(NONE), columns(1), rows(1) {}
+        };
+        /// @brief modal variables, reset at each CELL
+        struct Modal
+        {
+            bool absolute; ///< xy-mode
+            Point placement; ///< placement-x and placement-y
+            Point geometry; ///< geometry-x and geometry-y
+            Point text; ///< text-x and text-y
+            std::string placementCell; ///< placement-cell
+            unsigned layer; ///< layer
+            unsigned datatype; ///< datatype
+            unsigned textlayer; ///< textlayer
+            unsigned texttype; ///< texttype
+            std::string textString; ///< text-string
+            long long width; ///< geometry-w
+            long long height; ///< geometry-h
+            std::vector<Point> vPolygon; ///< polygon-point-list, relative to the first vertex
+            std::vector<Point> vPath; ///< path-point-list, relative to the first vertex
+            long long halfwidth; ///< path-halfwidth
+            long long startExtn; ///< path-start-extension
+            long long endExtn; ///< path-end-extension
+            unsigned ctrapezoidType; ///< ctrapezoid-type
+            long long radius; ///< circle-radius
+            Repetition repetition; ///< last repetition
+            /// @brief reset to the state at the beginning of a cell
+            void reset();
+        };
+        /// @brief result of reading a sequence of records
+        enum Status {CONTINUE, STOP};
+
+        /// @brief read records until END or the end of the range
+        /// @param begin start of records
+        /// @param end end of records
+        /// @param tableOnly stop at the first record that cannot be in a name table
+        /// @return STOP if END or the end of a name table is reached
+        Status read_records(const unsigned char* begin, const unsigned char* end, bool tableOnly);
+        /// @brief read the START record and the name tables it or END refers to
+        /// @param begin start of the file
+        /// @param end end of the file
+        void read_start(const unsigned char* begin, const unsigned char* end);
+        /// @brief read a CBLOCK record and the records it holds
+        /// @param tableOnly stop at the first record that cannot be in a name table
+        /// @return STOP if the contained records reach END or the end of a name table
+        Status read_cblock(bool tableOnly);
+
+        /// @name element records
+        ///@{
+        void read_placement(bool transform); ///< PLACEMENT
+        void read_text(); ///< TEXT
+        void read_rectangle(); ///< RECTANGLE
+        void read_polygon(); ///< POLYGON
+        void read_path(); ///< PATH
+        void read_trapezoid(int type); ///< TRAPEZOID
+        void read_ctrapezoid(); ///< CTRAPEZOID
+        void read_circle(); ///< CIRCLE
+        void read_property(); ///< PROPERTY
+        ///@}
+
+        /// @name decoders of OASIS data types
+        ///@{
+        unsigned long long read_uint(); ///< unsigned-integer
+        long long read_sint(); ///< signed-integer
+        double read_real(); ///< real
+        double read_real(unsigned long long type); ///< real of a known type, e.g., in property values
+        void read_string(std::string& str); ///< a-string, b-string and n-string
+        void skip_string(); ///< skip a string
+        Point read_gdelta(); ///< g-delta
+        unsigned char read_byte(); ///< info-byte and others
+        void read_point_list(std::vector<Point>& vPoint, bool polygon); ///< point-list
+        void read_repetition(); ///< repetition into the modal variable
+        void read_interval(); ///< interval of LAYERNAME
+        void read_xy(unsigned char info, unsigned char xbit, unsigned char ybit, Point& modal); ///< x and y of an element
+        ///@}
+
+        /// @name GDSII output
+        ///@{
+        /// @brief end the current cell if any
+        void end_cell();
+        /// @param layer layer
+        /// @param datatype data type
+        /// @return true if geometries on the layer are kept
+        bool keep(unsigned layer, unsigned datatype) const {return m_filter.empty() || m_filter.accept(layer, datatype);}
+        /// @brief offsets of all instances of the modal repetition
+        /// @param repeated whether the element has a repetition
+        /// @param vOffset offsets, only the origin without repetition
+        void offsets(bool repeated, std::vector<Point>& vOffset) const;
+        /// @brief emit BOUNDARY for each instance of the repetition
+        /// @param vPoint vertices relative to origin, without closing vertex
+        /// @param origin position of the polygon
+        /// @param repeated whether the element has a repetition
+        void emit_boundary(std::vector<Point> const& vPoint, Point const& origin, bool repeated);
+        /// @brief emit PATH for each instance of the repetition
+        /// @param origin position of the first vertex
+        /// @param repeated whether the element has a repetition
+        void emit_path(Point const& origin, bool repeated);
+        /// @brief emit TEXT for each instance of the repetition
+        /// @param repeated whether the element has a repetition
+        void emit_text(bool repeated);
+        /// @brief emit SREF or AREF
+        /// @param angle rotation in degrees
+        /// @param mag magnification
+        /// @param flip reflection about x axis
+        /// @param repeated whether the element has a repetition
+        void emit_placement(double angle, double mag, bool flip, bool repeated);
+        /// @brief emit XY of points
+        /// @param vPoint points
+        /// @param offset offset added to each point
+        /// @param closed add the first point at the end
+        void emit_xy(std::vector<Point> const& vPoint, Point const& offset, bool closed);
+        /// @param record GDSII record
+        /// @param value 2-byte integer value
+        void emit_integer_2(GdsRecords::EnumType record, int value);
+        /// @param record GDSII record
+        /// @param value 4-byte integer value
+        void emit_integer_4(GdsRecords::EnumType record, int value);
+        /// @param record GDSII record
+        /// @param value 8-byte real value
+        void emit_real_8(GdsRecords::EnumType record, double value);
+        ///@}
+
+        /// @param vName name table
+        /// @param refnum reference number
+        /// @return name of the reference number
+        std::string const& name(std::vector<std::string> const& vName, unsigned long long refnum) const;
+        /// @brief define a name
+        /// @param vName name table
+        /// @param refnum reference number
+        /// @param str name
+        void define(std::vector<std::string>& vName, unsigned long long refnum, std::string const& str);
+
+        GdsDataBaseKernel& m_db; ///< database receiving GDSII records
+        GdsLayerFilter m_filter; ///< layers to keep
+        int m_circle_vertices; ///< number of vertices of polygons approximating circles
+
+        const unsigned char* m_begin; ///< start of the records being read
+        const unsigned char* m_ptr; ///< current position
+        const unsigned char* m_end; ///< end of the records being read
+        const unsigned char* m_file; ///< start of the file, for table offsets
+        bool m_emit; ///< whether records are translated, false when only collecting names
+        bool m_in_cell; ///< whether a cell is open
+        bool m_table_seen; ///< whether a name record is read since a name table begins
+        unsigned long long m_cellname_count; ///< implicit reference number of the next CELLNAME
+        unsigned long long m_textstring_count; ///< implicit reference number of the next TEXTSTRING
+        unsigned long long m_propname_count; ///< implicit reference number of the next PROPNAME
+        unsigned long long m_propstring_count; ///< implicit reference number of the next PROPSTRING
+        unsigned long long m_xname_count; ///< implicit reference number of the next XNAME
+        std::vector<std::string> m_vCellName; ///< cell names by reference number
+        std::vector<std::string> m_vTextString; ///< text strings by reference number
+        Modal m_modal; ///< modal variables
+        std::string m_name; ///< buffer of names
+
+        /// @name output buffers reused across records
+        ///@{
+        std::vector<int> m_vInteger; ///< integers
+        std::vector<double> m_vFloat; ///< floating point numbers
+        std::vector<Point> m_vPoint; ///< vertices
+        std::vector<Point> m_vOffset; ///< offsets of repeated instances
+        std::vector<unsigned char> m_vInflate; ///< content of CBLOCK records
+        ///@}
+};
+
+/// @brief check the magic bytes of an OASIS file
+/// @param buffer start of the file content
+/// @param length number of bytes
+/// @return true if the content starts with the OASIS magic bytes
+bool is_oasis(const char* buffer, std::size_t length);
+/// @brief check whether a file is an OASIS file from its magic bytes
+/// @param filename file name
+/// @return true if the file starts with the OASIS magic bytes
+bool is_oasis(string const& filename);
+/// @brief read OASIS file as GDSII records
+/// @param db GDSII database
+/// @param filename OASIS file
+bool read_oasis(GdsDataBaseKernel& db, string const& filename);
+/// @brief read OASIS file as GDSII records, only keep geometries on some layers
+/// @param db GDSII database
+/// @param filename OASIS file
+/// @param filter layers to keep
+bool read_oasis(GdsDataBaseKernel& db, string const& filename, GdsLayerFilter const& filter);
+
+} // namespace GdsParser
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file   OasisRecords.h
+ * @brief  enum of OASIS records and constants shared by the OASIS reader and writer
+ * @date   Oct 2026
+ */
+
+#ifndef _GDSPARSER_OASISRECORDS_H
+#define _GDSPARSER_OASISRECORDS_H
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+
+/// @brief OASIS records, see SEMI P39
+struct OasisRecords
+{
+    /// @brief enum type of OASIS records
+    enum EnumType {
+        PAD = 0,
+        START = 1,
+        END = 2,
+        CELLNAME_IMPLICIT = 3,
+        CELLNAME = 4,
+        TEXTSTRING_IMPLICIT = 5,
+        TEXTSTRING = 6,
+        PROPNAME_IMPLICIT = 7,
+        PROPNAME = 8,
+        PROPSTRING_IMPLICIT = 9,
+        PROPSTRING = 10,
+        LAYERNAME = 11,
+        LAYERNAME_TEXT = 12,
+        CELL_REFNUM = 13,
+        CELL = 14,
+        XYABSOLUTE = 15,
+        XYRELATIVE = 16,
+        PLACEMENT = 17,
+        PLACEMENT_TRANSFORM = 18,
+        TEXT = 19,
+        RECTANGLE = 20,
+        POLYGON = 21,
+        PATH = 22,
+        TRAPEZOID = 23,
+        TRAPEZOID_A = 24,
+        TRAPEZOID_B = 25,
+        CTRAPEZOID = 26,
+        CIRCLE = 27,
+        PROPERTY = 28,
+        PROPERTY_REPEAT = 29,
+        XNAME_IMPLICIT = 30,
+        XNAME = 31,
+        XELEMENT = 32,
+        XGEOMETRY = 33,
+        CBLOCK = 34,
+        UNKNOWN = 35
+    };
+};
+
+/// @brief magic bytes at the beginning of an OASIS file
+#define OASIS_MAGIC "%SEMI-OASIS\r\n"
+/// @brief number of magic bytes
+#define OASIS_MAGIC_SIZE 13
+/// @brief number of bytes in the END record
+#define OASIS_END_SIZE 256
+
+} // namespace GdsParser
+
+#endif
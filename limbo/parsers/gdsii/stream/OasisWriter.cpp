@@ -0,0 +1,486 @@
+/**
+ * @file   OasisWriter.cpp
+ * @brief  write OASIS file
+ * @date   Oct 2026
+ */
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <limbo/parsers/gdsii/stream/OasisWriter.h>
+/// CBLOCK records are deflated by zlib if enabled
+#if ZLIB == 1
+#include <zlib.h>
+#endif
+
+namespace GdsParser
+{
+
+OasisWriter::OasisWriter(const char* filename, bool compress)
+    : m_fp(fopen(filename, "wb"))
+    , m_compress(compress)
+    , m_offset(0)
+    , m_ended(false)
+{
+    if (!m_fp)
+        printf("failed to open %s for write\n", filename);
+    reset_modal();
+}
+
+OasisWriter::~OasisWriter()
+{
+    if (!m_ended)
+        end_lib();
+}
+
+void OasisWriter::create_lib(double unit)
+{
+    std::vector<unsigned char> v (OASIS_MAGIC, OASIS_MAGIC + OASIS_MAGIC_SIZE);
+    put_uint(v, OasisRecords::START);
+    put_string(v, "1.0", 3);
+    put_real(v, unit);
+    put_uint(v, 1); // table offsets in END
+    write_bytes(v);
+}
+
+void OasisWriter::begin_cell(const char* name)
+{
+    flush_block();
+    reset_modal();
+    put_uint(m_vBlock, OasisRecords::CELL_REFNUM);
+    put_uint(m_vBlock, refnum(name));
+    // coordinates relative to the previous element are smaller
+    put_uint(m_vBlock, OasisRecords::XYRELATIVE);
+}
+
+void OasisWriter::write_rectangle(unsigned layer, unsigned datatype, long long xl, long long yl, long long width, long long height)
+{
+    unsigned char info = 0;
+    m_vField.clear();
+    if (m_layer != (long long)layer) {info |= 0x01; put_uint(m_vField, layer); m_layer = layer;}
+    if (m_datatype != (long long)datatype) {info |= 0x02; put_uint(m_vField, datatype); m_datatype = datatype;}
+    if (width == height) // square
+    {
+        info |= 0x80;
+        if (m_width != width) {info |= 0x40; put_uint(m_vField, width); m_width = width;}
+        m_height = width;
+    }
+    else
+    {
+        if (m_width != width) {info |= 0x40; put_uint(m_vField, width); m_width = width;}
+        if (m_height != height) {info |= 0x20; put_uint(m_vField, height); m_height = height;}
+    }
+    xy(xl, yl, m_geometryX, m_geometryY, info, 0x10, 0x08, m_vField);
+    put_uint(m_vBlock, OasisRecords::RECTANGLE);
+    m_vBlock.push_back(info);
+    m_vBlock.insert(m_vBlock.end(), m_vField.begin(), m_vField.end());
+}
+
+void OasisWriter::write_polygon(unsigned layer, unsigned datatype, const int* vx, const int* vy, std::size_t n)
+{
+    if (n > 1 && vx[0] == vx[n-1] && vy[0] == vy[n-1]) // closing vertex
+        --n;
+    if (n < 3)
+        return;
+    if (n == 4 && ((vx[0] == vx[1] && vy[1] == vy[2] && vx[2] == vx[3] && vy[3] == vy[0])
+                || (vy[0] == vy[1] && vx[1] == vx[2] && vy[2] == vy[3] && vx[3] == vx[0])))
+    {
+        long long xl = std::min(vx[0], vx[2]);
+        long long yl = std::min(vy[0], vy[2]);
+        write_rectangle(layer, datatype, xl, yl, std::max(vx[0], vx[2]) - xl, std::max(vy[0], vy[2]) - yl);
+        return;
+    }
+
+    unsigned char info = 0;
+    m_vField.clear();
+    if (m_layer != (long long)layer) {info |= 0x01; put_uint(m_vField, layer); m_layer = layer;}
+    if (m_datatype != (long long)datatype) {info |= 0x02; put_uint(m_vField, datatype); m_datatype = datatype;}
+    write_point_list(vx, vy, n, true);
+    if (m_vPointList != m_vPolygonPoints)
+    {
+        info |= 0x20;
+        m_vField.insert(m_vField.end(), m_vPointList.begin(), m_vPointList.end());
+        m_vPolygonPoints.swap(m_vPointList);
+    }
+    xy(vx[0], vy[0], m_geometryX, m_geometryY, info, 0x10, 0x08, m_vField);
+    put_uint(m_vBlock, OasisRecords::POLYGON);
+    m_vBlock.push_back(info);
+    m_vBlock.insert(m_vBlock.end(), m_vField.begin(), m_vField.end());
+}
+
+void OasisWriter::write_path(unsigned layer, unsigned datatype, long long halfwidth, long long startExtn, long long endExtn, const int* vx, const int* vy, std::size_t n)
+{
+    if (n < 1)
+        return;
+    unsigned char info = 0;
+    m_vField.clear();
+    if (m_layer != (long long)layer) {info |= 0x01; put_uint(m_vField, layer); m_layer = layer;}
+    if (m_datatype != (long long)datatype) {info |= 0x02; put_uint(m_vField, datatype); m_datatype = datatype;}
+    if (m_halfwidth != halfwidth) {info |= 0x40; put_uint(m_vField, halfwidth); m_halfwidth = halfwidth;}
+    if (!m_hasExtn || m_startExtn != startExtn || m_endExtn != endExtn)
+    {
+        // extension scheme 0000SSEE, 1 for flush, 2 for half-width and 3 for explicit
+        unsigned ss = (startExtn == 0)? 1 : (startExtn == halfwidth)? 2 : 3;
+        unsigned ee = (endExtn == 0)? 1 : (endExtn == halfwidth)? 2 : 3;
+        info |= 0x80;
+        put_uint(m_vField, (ss<<2)|ee);
+        if (ss == 3) put_sint(m_vField, startExtn);
+        if (ee == 3) put_sint(m_vField, endExtn);
+        m_startExtn = startExtn;
+        m_endExtn = endExtn;
+        m_hasExtn = true;
+    }
+    write_point_list(vx, vy, n, false);
+    if (m_vPointList != m_vPathPoints)
+    {
+        info |= 0x20;
+        m_vField.insert(m_vField.end(), m_vPointList.begin(), m_vPointList.end());
+        m_vPathPoints.swap(m_vPointList);
+    }
+    xy(vx[0], vy[0], m_geometryX, m_geometryY, info, 0x10, 0x08, m_vField);
+    put_uint(m_vBlock, OasisRecords::PATH);
+    m_vBlock.push_back(info);
+    m_vBlock.insert(m_vBlock.end(), m_vField.begin(), m_vField.end());
+}
+
+void OasisWriter::write_text(unsigned textlayer, unsigned texttype, long long x, long long y, const char* str)
+{
+    unsigned char info = 0;
+    m_vField.clear();
+    if (!m_hasTextString || m_textString != str)
+    {
+        info |= 0x40;
+        m_textString = str;
+        m_hasTextString = true;
+        put_string(m_vField, m_textString.data(), m_textString.size());
+    }
+    if (m_textlayer != (long long)textlayer) {info |= 0x01; put_uint(m_vField, textlayer); m_textlayer = textlayer;}
+    if (m_texttype != (long long)texttype) {info |= 0x02; put_uint(m_vField, texttype); m_texttype = texttype;}
+    xy(x, y, m_textX, m_textY, info, 0x10, 0x08, m_vField);
+    put_uint(m_vBlock, OasisRecords::TEXT);
+    m_vBlock.push_back(info);
+    m_vBlock.insert(m_vBlock.end(), m_vField.begin(), m_vField.end());
+}
+
+void OasisWriter::write_placement(const char* cellname, long long x, long long y, double angle, double mag, bool flip,
+        int columns, int rows, long long colx, long long coly, long long rowx, long long rowy)
+{
+    unsigned char info = (flip)? 0x01 : 0;
+    m_vField.clear();
+    long long ref = refnum(cellname);
+    if (m_placementCell != ref)
+    {
+        info |= 0xc0; // by reference number
+        put_uint(m_vField, ref);
+        m_placementCell = ref;
+    }
+    // multiples of 90 degrees without magnification are in the info byte
+    double a = fmod(angle, 360.0);
+    if (a < 0) a += 360.0;
+    bool manhattan = (mag == 1 && a == floor(a/90)*90);
+    if (manhattan)
+        info |= ((int)(a/90)&0x03)<<1;
+    else
+    {
+        if (mag != 1) {info |= 0x04; put_real(m_vField, mag);}
+        if (angle != 0) {info |= 0x02; put_real(m_vField, angle);}
+    }
+    xy(x, y, m_placementX, m_placementY, info, 0x20, 0x10, m_vField);
+
+    if (columns < 1) columns = 1;
+    if (rows < 1) rows = 1;
+    if (columns > 1 || rows > 1)
+    {
+        info |= 0x08;
+        if (columns > 1 && rows > 1 && coly == 0 && rowx == 0 && colx >= 0 && rowy >= 0) // matrix
+        {
+            put_uint(m_vField, 1);
+            put_uint(m_vField, columns-2);
+            put_uint(m_vField, rows-2);
+            put_uint(m_vField, colx);
+            put_uint(m_vField, rowy);
+        }
+        else if (rows == 1 && coly == 0 && colx >= 0) // row
+        {
+            put_uint(m_vField, 2);
+            put_uint(m_vField, columns-2);
+            put_uint(m_vField, colx);
+        }
+        else if (columns == 1 && rowx == 0 && rowy >= 0) // column
+        {
+            put_uint(m_vField, 3);
+            put_uint(m_vField, rows-2);
+            put_uint(m_vField, rowy);
+        }
+        else if (columns > 1 && rows > 1) // matrix of arbitrary vectors
+        {
+            put_uint(m_vField, 8);
+            put_uint(m_vField, columns-2);
+            put_uint(m_vField, rows-2);
+            put_gdelta(m_vField, colx, coly);
+            put_gdelta(m_vField, rowx, rowy);
+        }
+        else // row of an arbitrary vector
+        {
+            put_uint(m_vField, 9);
+            if (rows == 1)
+            {
+                put_uint(m_vField, columns-2);
+                put_gdelta(m_vField, colx, coly);
+            }
+            else
+            {
+                put_uint(m_vField, rows-2);
+                put_gdelta(m_vField, rowx, rowy);
+            }
+        }
+    }
+    put_uint(m_vBlock, (manhattan)? OasisRecords::PLACEMENT : OasisRecords::PLACEMENT_TRANSFORM);
+    m_vBlock.push_back(info);
+    m_vBlock.insert(m_vBlock.end(), m_vField.begin(), m_vField.end());
+}
+
+void OasisWriter::end_lib()
+{
+    if (m_ended)
+        return;
+    m_ended = true;
+    if (!m_fp)
+        return;
+    flush_block();
+
+    // strict CELLNAME table with implicit reference numbers in order
+    unsigned long long tableOffset = (m_vCellName.empty())? 0 : m_offset;
+    for (std::vector<std::string const*>::const_iterator it = m_vCellName.begin(); it != m_vCellName.end(); ++it)
+    {
+        put_uint(m_vBlock, OasisRecords::CELLNAME_IMPLICIT);
+        put_string(m_vBlock, (*it)->data(), (*it)->size());
+    }
+    flush_block();
+
+    std::vector<unsigned char> v;
+    put_uint(v, OasisRecords::END);
+    // strict flag and offset for CELLNAME, TEXTSTRING, PROPNAME, PROPSTRING, LAYERNAME and XNAME
+    put_uint(v, 1);
+    put_uint(v, tableOffset);
+    for (int i = 1; i < 6; ++i)
+    {
+        put_uint(v, 1);
+        put_uint(v, 0);
+    }
+    // the padding string fills END to 256 bytes with a 2-byte length and a 1-byte validation scheme
+    std::size_t padding = OASIS_END_SIZE - v.size() - 3;
+    put_uint(v, padding);
+    v.resize(v.size() + padding, 0);
+    put_uint(v, 0); // no validation
+    write_bytes(v);
+
+    fclose(m_fp);
+    m_fp = NULL;
+}
+
+void OasisWriter::flush_block()
+{
+    if (m_vBlock.empty() || !m_fp)
+    {
+        m_vBlock.clear();
+        return;
+    }
+#if ZLIB == 1
+    if (m_compress)
+    {
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        // raw DEFLATE without zlib header
+        if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) == Z_OK)
+        {
+            m_vDeflate.resize(deflateBound(&zs, m_vBlock.size()));
+            zs.next_in = &m_vBlock[0];
+            zs.avail_in = m_vBlock.size();
+            zs.next_out = &m_vDeflate[0];
+            zs.avail_out = m_vDeflate.size();
+            int ret = deflate(&zs, Z_FINISH);
+            std::size_t compressed = zs.total_out;
+            deflateEnd(&zs);
+            // small blocks may not benefit from compression
+            if (ret == Z_STREAM_END && compressed + 16 < m_vBlock.size())
+            {
+                std::vector<unsigned char> v;
+                put_uint(v, OasisRecords::CBLOCK);
+                put_uint(v, 0); // DEFLATE
+                put_uint(v, m_vBlock.size());
+                put_uint(v, compressed);
+                write_bytes(v);
+                m_vDeflate.resize(compressed);
+                write_bytes(m_vDeflate);
+                m_vBlock.clear();
+                return;
+            }
+        }
+    }
+#endif
+    write_bytes(m_vBlock);
+    m_vBlock.clear();
+}
+
+void OasisWriter::reset_modal()
+{
+    m_placementX = m_placementY = 0;
+    m_geometryX = m_geometryY = 0;
+    m_textX = m_textY = 0;
+    m_placementCell = -1;
+    m_layer = m_datatype = -1;
+    m_textlayer = m_texttype = -1;
+    m_textString.clear();
+    m_hasTextString = false;
+    m_width = m_height = -1;
+    m_halfwidth = -1;
+    m_startExtn = m_endExtn = 0;
+    m_hasExtn = false;
+    m_vPolygonPoints.clear();
+    m_vPathPoints.clear();
+}
+
+void OasisWriter::write_bytes(std::vector<unsigned char> const& v)
+{
+    if (m_fp && !v.empty())
+    {
+        fwrite(&v[0], 1, v.size(), m_fp);
+        m_offset += v.size();
+    }
+}
+
+unsigned long long OasisWriter::refnum(std::string const& name)
+{
+    std::pair<std::map<std::string, unsigned long long>::iterator, bool> found = m_mRefnum.insert(std::make_pair(name, (unsigned long long)m_vCellName.size()));
+    if (found.second)
+        m_vCellName.push_back(&found.first->first);
+    return found.first->second;
+}
+
+void OasisWriter::write_point_list(const int* vx, const int* vy, std::size_t n, bool polygon)
+{
+    m_vPointList.clear();
+    // number of edges to check, the closing edge of a polygon is included
+    std::size_t numEdges = (polygon)? n : n-1;
+    bool alternate = (!polygon || n%2 == 0) && n > 1;
+    bool manhattan = true;
+    bool octangular = true;
+    bool horizontal = (n > 1 && vy[1] == vy[0]);
+    for (std::size_t i = 0; i < numEdges; ++i)
+    {
+        std::size_t j = (i+1 == n)? 0 : i+1;
+        long long dx = (long long)vx[j] - vx[i];
+        long long dy = (long long)vy[j] - vy[i];
+        bool h = (dy == 0);
+        bool v = (dx == 0);
+        manhattan = manhattan && (h || v);
+        octangular = octangular && (h || v || dx == dy || dx == -dy);
+        alternate = alternate && (((i%2 == 0) == horizontal)? h : v);
+    }
+
+    if (alternate) // 1-deltas of alternating directions
+    {
+        std::size_t count = (polygon)? n-2 : n-1;
+        put_uint(m_vPointList, (horizontal)? 0 : 1);
+        put_uint(m_vPointList, count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            bool h = ((i%2 == 0) == horizontal);
+            put_sint(m_vPointList, (h)? (long long)vx[i+1] - vx[i] : (long long)vy[i+1] - vy[i]);
+        }
+        return;
+    }
+
+    put_uint(m_vPointList, (manhattan)? 2 : (octangular)? 3 : 4);
+    put_uint(m_vPointList, n-1);
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        long long dx = (long long)vx[i] - vx[i-1];
+        long long dy = (long long)vy[i] - vy[i-1];
+        if (manhattan) // 2-deltas
+        {
+            unsigned dir = (dy == 0)? ((dx >= 0)? 0 : 2) : ((dy > 0)? 1 : 3);
+            put_uint(m_vPointList, ((unsigned long long)(std::max(dx, -dx) + std::max(dy, -dy))<<2) | dir);
+        }
+        else if (octangular) // 3-deltas
+        {
+            unsigned dir = 0;
+            if (dy == 0) dir = (dx >= 0)? 0 : 2;
+            else if (dx == 0) dir = (dy > 0)? 1 : 3;
+            else if (dx > 0) dir = (dy > 0)? 4 : 7;
+            else dir = (dy > 0)? 5 : 6;
+            put_uint(m_vPointList, ((unsigned long long)std::max(std::max(dx, -dx), std::max(dy, -dy))<<3) | dir);
+        }
+        else
+            put_gdelta(m_vPointList, dx, dy);
+    }
+}
+
+void OasisWriter::xy(long long x, long long y, long long& modalX, long long& modalY, unsigned char& info, unsigned char xbit, unsigned char ybit, std::vector<unsigned char>& vField)
+{
+    // omitted coordinates take the modal variables
+    if (x != modalX) {info |= xbit; put_sint(vField, x - modalX); modalX = x;}
+    if (y != modalY) {info |= ybit; put_sint(vField, y - modalY); modalY = y;}
+}
+
+void OasisWriter::put_uint(std::vector<unsigned char>& v, unsigned long long value)
+{
+    while (value >= 0x80)
+    {
+        v.push_back((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    v.push_back(value);
+}
+
+void OasisWriter::put_sint(std::vector<unsigned char>& v, long long value)
+{
+    if (value < 0)
+        put_uint(v, ((unsigned long long)(-value)<<1) | 1);
+    else
+        put_uint(v, (unsigned long long)value<<1);
+}
+
+void OasisWriter::put_real(std::vector<unsigned char>& v, double value)
+{
+    if (value == floor(value) && fabs(value) < 4503599627370496.0) // integers below 2^52
+    {
+        put_uint(v, (value < 0)? 1 : 0);
+        put_uint(v, (unsigned long long)fabs(value));
+        return;
+    }
+    // IEEE 754 double in little endian
+    put_uint(v, 7);
+    unsigned long long bits;
+    memcpy(&bits, &value, 8);
+    for (int i = 0; i < 8; ++i)
+        v.push_back((bits>>(8*i)) & 0xff);
+}
+
+void OasisWriter::put_string(std::vector<unsigned char>& v, const char* str, std::size_t length)
+{
+    put_uint(v, length);
+    v.insert(v.end(), str, str + length);
+}
+
+void OasisWriter::put_gdelta(std::vector<unsigned char>& v, long long dx, long long dy)
+{
+    unsigned long long ax = (dx < 0)? -dx : dx;
+    unsigned long long ay = (dy < 0)? -dy : dy;
+    if (dx == 0 || dy == 0 || ax == ay) // form 1, octangular direction and magnitude
+    {
+        unsigned dir = 0;
+        if (dy == 0) dir = (dx >= 0)? 0 : 2;
+        else if (dx == 0) dir = (dy > 0)? 1 : 3;
+        else if (dx > 0) dir = (dy > 0)? 4 : 7;
+        else dir = (dy > 0)? 5 : 6;
+        put_uint(v, (std::max(ax, ay)<<4) | (dir<<1));
+        return;
+    }
+    // form 2, x with its sign and then y
+    put_uint(v, (ax<<2) | ((dx < 0)? 2 : 0) | 1);
+    put_sint(v, dy);
+}
+
+} // namespace GdsParser
@@ -0,0 +1,178 @@
+/**
+ * @file   OasisWriter.h
+ * @brief  write OASIS file
+ * @date   Oct 2026
+ */
+
+#ifndef _GDSPARSER_OASISWRITER_H
+#define _GDSPARSER_OASISWRITER_H
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <limbo/parsers/gdsii/stream/OasisRecords.h>
+
+/// namespace for Limbo.GdsParser
+namespace GdsParser
+{
+
+/// @class GdsParser::OasisWriter
+/// @brief Write OASIS records with an interface similar to @ref GdsParser::GdsWriter.
+///
+/// Coordinates in a cell are relative to the previous element of the same kind,
+/// and fields equal to modal variables are omitted.
+/// Axis-parallel rectangles are written as RECTANGLE, Manhattan polygons and paths with 1-deltas and others with g-deltas.
+/// Cell names are referred to by reference numbers in a strict CELLNAME table at the end of the file.
+/// Each cell and the name table are written in a CBLOCK if compiled with ZLIB=1 and compression is enabled.
+class OasisWriter
+{
+    public:
+        /// @brief constructor
+        /// @param filename OASIS file
+        /// @param compress write cells in CBLOCK records
+        OasisWriter(const char* filename, bool compress = true);
+        /// @brief destructor, write the name table and END if not yet
+        ~OasisWriter();
+
+        /// @return true if the file is open
+        bool good() const {return m_fp != NULL;}
+
+        /// @brief write the magic bytes and START
+        /// @param unit grid steps per micron
+        void create_lib(double unit);
+        /// @brief begin a cell, which ends at the next cell or the end of the library
+        /// @param name cell name
+        void begin_cell(const char* name);
+        /// @brief write a rectangle
+        /// @param layer layer
+        /// @param datatype data type
+        /// @param xl left
+        /// @param yl bottom
+        /// @param width width
+        /// @param height height
+        void write_rectangle(unsigned layer, unsigned datatype, long long xl, long long yl, long long width, long long height);
+        /// @brief write a polygon, axis-parallel rectangles are written as RECTANGLE
+        /// @param layer layer
+        /// @param datatype data type
+        /// @param vx x coordinates of vertices, a closing vertex equal to the first one is ignored
+        /// @param vy y coordinates of vertices
+        /// @param n number of vertices
+        void write_polygon(unsigned layer, unsigned datatype, const int* vx, const int* vy, std::size_t n);
+        /// @brief write a path
+        /// @param layer layer
+        /// @param datatype data type
+        /// @param halfwidth half of the width
+        /// @param startExtn extension at the first vertex
+        /// @param endExtn extension at the last vertex
+        /// @param vx x coordinates of vertices
+        /// @param vy y coordinates of vertices
+        /// @param n number of vertices
+        void write_path(unsigned layer, unsigned datatype, long long halfwidth, long long startExtn, long long endExtn, const int* vx, const int* vy, std::size_t n);
+        /// @brief write a text
+        /// @param textlayer text layer
+        /// @param texttype text type
+        /// @param x x coordinate
+        /// @param y y coordinate
+        /// @param str text string
+        void write_text(unsigned textlayer, unsigned texttype, long long x, long long y, const char* str);
+        /// @brief write a placement of a cell, or a regular array of placements if columns or rows are larger than 1
+        /// @param cellname name of the placed cell
+        /// @param x x coordinate
+        /// @param y y coordinate
+        /// @param angle rotation in degrees
+        /// @param mag magnification
+        /// @param flip reflection about x axis before rotation
+        /// @param columns number of columns
+        /// @param rows number of rows
+        /// @param colx x displacement between columns
+        /// @param coly y displacement between columns
+        /// @param rowx x displacement between rows
+        /// @param rowy y displacement between rows
+        void write_placement(const char* cellname, long long x, long long y, double angle = 0, double mag = 1, bool flip = false,
+                int columns = 1, int rows = 1, long long colx = 0, long long coly = 0, long long rowx = 0, long long rowy = 0);
+        /// @brief write the name table and END, then close the file
+        void end_lib();
+    protected:
+        /// @brief copy constructor is not allowed
+        OasisWriter(OasisWriter const&);
+        /// @brief assignment is not allowed
+        OasisWriter& operator=(OasisWriter const&);
+
+        /// @brief write the records of the current cell or table to the file
+        void flush_block();
+        /// @brief reset modal variables at the beginning of a cell
+        void reset_modal();
+        /// @param v bytes to write to the file
+        void write_bytes(std::vector<unsigned char> const& v);
+        /// @param name cell name
+        /// @return reference number of the cell name
+        unsigned long long refnum(std::string const& name);
+        /// @brief collect deltas between vertices
+        /// @param vx x coordinates of vertices
+        /// @param vy y coordinates of vertices
+        /// @param n number of vertices
+        /// @param polygon the last vertex of Manhattan polygons is implied
+        void write_point_list(const int* vx, const int* vy, std::size_t n, bool polygon);
+        /// @brief write x and y relative to the modal variables, and set bits of the info byte
+        /// @param x x coordinate
+        /// @param y y coordinate
+        /// @param modalX modal x
+        /// @param modalY modal y
+        /// @param info info byte
+        /// @param xbit bit of x in the info byte
+        /// @param ybit bit of y in the info byte
+        /// @param vField buffer of x and y
+        void xy(long long x, long long y, long long& modalX, long long& modalY, unsigned char& info, unsigned char xbit, unsigned char ybit, std::vector<unsigned char>& vField);
+
+        /// @name encoders of OASIS data types
+        ///@{
+        static void put_uint(std::vector<unsigned char>& v, unsigned long long value); ///< unsigned-integer
+        static void put_sint(std::vector<unsigned char>& v, long long value); ///< signed-integer
+        static void put_real(std::vector<unsigned char>& v, double value); ///< real
+        static void put_string(std::vector<unsigned char>& v, const char* str, std::size_t length); ///< string
+        static void put_gdelta(std::vector<unsigned char>& v, long long dx, long long dy); ///< g-delta
+        ///@}
+
+        FILE* m_fp; ///< output file
+        bool m_compress; ///< write cells in CBLOCK records
+        unsigned long long m_offset; ///< number of bytes written to the file
+        bool m_ended; ///< whether END is written
+
+        std::vector<unsigned char> m_vBlock; ///< records of the current cell or table
+        std::vector<unsigned char> m_vField; ///< fields of the current record
+        std::vector<unsigned char> m_vPointList; ///< point list of the current record
+        std::vector<unsigned char> m_vDeflate; ///< compressed block
+
+        std::map<std::string, unsigned long long> m_mRefnum; ///< reference numbers of cell names
+        std::vector<std::string const*> m_vCellName; ///< cell names by reference number
+
+        /// @name modal variables, reset at each cell
+        ///@{
+        long long m_placementX; ///< placement-x
+        long long m_placementY; ///< placement-y
+        long long m_geometryX; ///< geometry-x
+        long long m_geometryY; ///< geometry-y
+        long long m_textX; ///< text-x
+        long long m_textY; ///< text-y
+        long long m_placementCell; ///< reference number of placement-cell, -1 if undefined
+        long long m_layer; ///< layer, -1 if undefined
+        long long m_datatype; ///< datatype, -1 if undefined
+        long long m_textlayer; ///< textlayer, -1 if undefined
+        long long m_texttype; ///< texttype, -1 if undefined
+        std::string m_textString; ///< text-string
+        bool m_hasTextString; ///< whether text-string is defined
+        long long m_width; ///< geometry-w, -1 if undefined
+        long long m_height; ///< geometry-h, -1 if undefined
+        long long m_halfwidth; ///< path-halfwidth, -1 if undefined
+        long long m_startExtn; ///< path-start-extension
+        long long m_endExtn; ///< path-end-extension
+        bool m_hasExtn; ///< whether path extensions are defined
+        std::vector<unsigned char> m_vPolygonPoints; ///< polygon-point-list as written, empty if undefined
+        std::vector<unsigned char> m_vPathPoints; ///< path-point-list as written, empty if undefined
+        ///@}
+};
+
+} // namespace GdsParser
+
+#endif
@@ -110,6 +110,23 @@ enum lefiGeomEnum {
 };
 /// @endcond
 
+/// @brief sections of LEF whose callbacks are registered to the reader, see @ref LefParser::LefDataBase::lef_callbacks. 
+/// Header statements like VERSION, UNITS and MANUFACTURINGGRID are always registered. 
+enum LefCallbackFlag 
+{
+    LEF_CBK_LAYERS = 1, ///< LAYER and MAXVIASTACK 
+    LEF_CBK_VIAS = 2, ///< VIA and VIARULE 
+    LEF_CBK_SPACING = 4, ///< SPACING 
+    LEF_CBK_NONDEFAULT = 8, ///< NONDEFAULTRULE 
+    LEF_CBK_SITES = 16, ///< SITE 
+    LEF_CBK_MACROS = 32, ///< MACRO without its pins and obstructions 
+    LEF_CBK_PINS = 64, ///< PIN of macros 
+    LEF_CBK_OBSTRUCTIONS = 128, ///< OBS of macros 
+    LEF_CBK_PROPERTYDEFINITIONS = 256, ///< PROPERTYDEFINITIONS 
+    LEF_CBK_MISC = 512, ///< others like antenna, ARRAY, IRDROP, DENSITY and TIMING 
+    LEF_CBK_ALL = 1023 ///< all sections 
+};
+
 // forward declaration
 /// @class LefParser::LefDataBase
 /// @brief Base class for lef database. 
@@ -138,6 +155,11 @@ class LefDataBase
         // Because most LEF files are so simple that we only need several callbacks.  
         // Then user does not need to provide some callbacks.
 
+        /// @brief sections the database implements callbacks for. 
+        /// Callbacks of other sections are not registered, so the reader skips building their objects. 
+        /// @return bitwise OR of @ref LefParser::LefCallbackFlag, all sections by default 
+        virtual unsigned lef_callbacks() const {return LEF_CBK_ALL;}
+
         /// @brief set LEF version 
         /// @param v string of LEF version 
         virtual void lef_version_cbk(string const& v)
@@ -566,65 +566,92 @@ bool Driver::parse_file(const std::string &filename)
     lefrInitSession(isSessionless ? 0 : 1);
 
     lefrSetWarningLogFunction(printWarning);
-    lefrSetAntennaInputCbk(antennaCB);
-    lefrSetAntennaInoutCbk(antennaCB);
-    lefrSetAntennaOutputCbk(antennaCB);
-    lefrSetArrayBeginCbk(arrayBeginCB);
-    lefrSetArrayCbk(arrayCB);
-    lefrSetArrayEndCbk(arrayEndCB);
+    lefrSetUserData((void*)3);
+    // sections without callbacks are not built by the reader 
+    unsigned callbacks = m_db.lef_callbacks(); 
+
+    // always registered 
     lefrSetBusBitCharsCbk(busBitCharsCB);
     lefrSetCaseSensitiveCbk(caseSensCB);
     lefrSetFixedMaskCbk(fixedMaskCB);
     lefrSetClearanceMeasureCbk(clearanceCB);
-    lefrSetDensityCbk(densityCB);
     lefrSetDividerCharCbk(dividerCB);
     lefrSetNoWireExtensionCbk(noWireExtCB);
-    lefrSetNoiseMarginCbk(noiseMarCB);
-    lefrSetEdgeRateThreshold1Cbk(edge1CB);
-    lefrSetEdgeRateThreshold2Cbk(edge2CB);
-    lefrSetEdgeRateScaleFactorCbk(edgeScaleCB);
-    lefrSetExtensionCbk(extensionCB);
-    lefrSetNoiseTableCbk(noiseTableCB);
-    lefrSetCorrectionTableCbk(correctionCB);
-    lefrSetDielectricCbk(dielectricCB);
-    lefrSetIRDropBeginCbk(irdropBeginCB);
-    lefrSetIRDropCbk(irdropCB);
-    lefrSetIRDropEndCbk(irdropEndCB);
-    lefrSetLayerCbk(layerCB);
     lefrSetLibraryEndCbk(doneCB); 
-    lefrSetMacroBeginCbk(macroBeginCB);
-    lefrSetMacroCbk(macroCB);
-    lefrSetMacroClassTypeCbk(macroClassTypeCB);
-    lefrSetMacroOriginCbk(macroOriginCB);
-    lefrSetMacroSizeCbk(macroSizeCB);
-    lefrSetMacroFixedMaskCbk(macroFixedMaskCB);
-    lefrSetMacroEndCbk(macroEndCB);
     lefrSetManufacturingCbk(manufacturingCB);
-    lefrSetMaxStackViaCbk(maxStackViaCB);
     lefrSetMinFeatureCbk(minFeatureCB);
-    lefrSetNonDefaultCbk(nonDefaultCB);
-    lefrSetObstructionCbk(obstructionCB);
-    lefrSetPinCbk(pinCB);
-    lefrSetPropBeginCbk(propDefBeginCB);
-    lefrSetPropCbk(propDefCB);
-    lefrSetPropEndCbk(propDefEndCB);
-    lefrSetSiteCbk(siteCB);
-    lefrSetSpacingBeginCbk(spacingBeginCB);
-    lefrSetSpacingCbk(spacingCB);
-    lefrSetSpacingEndCbk(spacingEndCB);
-    lefrSetTimingCbk(timingCB);
     lefrSetUnitsCbk(unitsCB);
     lefrSetUseMinSpacingCbk(useMinSpacingCB);
-    lefrSetUserData((void*)3);
     if (!verStr)
         lefrSetVersionCbk(versionCB);
     else
         lefrSetVersionStrCbk(versionStrCB);
-    lefrSetViaCbk(viaCB);
-    lefrSetViaRuleCbk(viaRuleCB);
-    lefrSetInputAntennaCbk(antennaCB);
-    lefrSetOutputAntennaCbk(antennaCB);
-    lefrSetInoutAntennaCbk(antennaCB);
+
+    if (callbacks & LEF_CBK_LAYERS)
+    {
+        lefrSetLayerCbk(layerCB);
+        lefrSetMaxStackViaCbk(maxStackViaCB);
+    }
+    if (callbacks & LEF_CBK_VIAS)
+    {
+        lefrSetViaCbk(viaCB);
+        lefrSetViaRuleCbk(viaRuleCB);
+    }
+    if (callbacks & LEF_CBK_SPACING)
+    {
+        lefrSetSpacingBeginCbk(spacingBeginCB);
+        lefrSetSpacingCbk(spacingCB);
+        lefrSetSpacingEndCbk(spacingEndCB);
+    }
+    if (callbacks & LEF_CBK_NONDEFAULT)
+        lefrSetNonDefaultCbk(nonDefaultCB);
+    if (callbacks & LEF_CBK_SITES)
+        lefrSetSiteCbk(siteCB);
+    if (callbacks & LEF_CBK_MACROS)
+    {
+        lefrSetMacroBeginCbk(macroBeginCB);
+        lefrSetMacroCbk(macroCB);
+        lefrSetMacroClassTypeCbk(macroClassTypeCB);
+        lefrSetMacroOriginCbk(macroOriginCB);
+        lefrSetMacroSizeCbk(macroSizeCB);
+        lefrSetMacroFixedMaskCbk(macroFixedMaskCB);
+        lefrSetMacroEndCbk(macroEndCB);
+    }
+    if (callbacks & LEF_CBK_PINS)
+        lefrSetPinCbk(pinCB);
+    if (callbacks & LEF_CBK_OBSTRUCTIONS)
+        lefrSetObstructionCbk(obstructionCB);
+    if (callbacks & LEF_CBK_PROPERTYDEFINITIONS)
+    {
+        lefrSetPropBeginCbk(propDefBeginCB);
+        lefrSetPropCbk(propDefCB);
+        lefrSetPropEndCbk(propDefEndCB);
+    }
+    if (callbacks & LEF_CBK_MISC)
+    {
+        lefrSetAntennaInputCbk(antennaCB);
+        lefrSetAntennaInoutCbk(antennaCB);
+        lefrSetAntennaOutputCbk(antennaCB);
+        lefrSetArrayBeginCbk(arrayBeginCB);
+        lefrSetArrayCbk(arrayCB);
+        lefrSetArrayEndCbk(arrayEndCB);
+        lefrSetDensityCbk(densityCB);
+        lefrSetNoiseMarginCbk(noiseMarCB);
+        lefrSetEdgeRateThreshold1Cbk(edge1CB);
+        lefrSetEdgeRateThreshold2Cbk(edge2CB);
+        lefrSetEdgeRateScaleFactorCbk(edgeScaleCB);
+        lefrSetExtensionCbk(extensionCB);
+        lefrSetNoiseTableCbk(noiseTableCB);
+        lefrSetCorrectionTableCbk(correctionCB);
+        lefrSetDielectricCbk(dielectricCB);
+        lefrSetIRDropBeginCbk(irdropBeginCB);
+        lefrSetIRDropCbk(irdropCB);
+        lefrSetIRDropEndCbk(irdropEndCB);
+        lefrSetTimingCbk(timingCB);
+        lefrSetInputAntennaCbk(antennaCB);
+        lefrSetOutputAntennaCbk(antennaCB);
+        lefrSetInoutAntennaCbk(antennaCB);
+    }
 
     if (msgCb)
     {
@@ -639,7 +666,10 @@ bool Driver::parse_file(const std::string &filename)
     //lefrSetLineNumberFunction(lineNumberCB);
     lefrSetDeltaNumberLines(50);
 
-    lefrSetRegisterUnusedCallbacks();
+    // unused callbacks are counted by a function registered to them, 
+    // which makes the reader build sections the database does not implement 
+    if (callbacks == LEF_CBK_ALL)
+        lefrSetRegisterUnusedCallbacks();
 
     if (relax)
         lefrSetRelaxMode();
@@ -697,7 +727,8 @@ bool Driver::parse_file(const std::string &filename)
     if (res)
         std::cerr << "Reader returns bad status\n"; 
 
-    (void)lefrPrintUnusedCallbacks(stderr);
+    if (callbacks == LEF_CBK_ALL)
+        (void)lefrPrintUnusedCallbacks(stderr);
     (void)lefrReleaseNResetMemory();
     //(void)lefrUnsetCallbacks();
     (void)lefrUnsetLayerCbk();
@@ -129,6 +129,14 @@ void LefDataBase::lef_macro_cbk(lefiMacro const& v)
 	v.print(stdout);
 	lef_user_cbk_reminder(__func__);
 }
+limbo::DesignSymbols* LefDataBase::lef_symbols()
+{
+	return NULL;
+}
+void LefDataBase::lef_macro_id_cbk(unsigned int /*macro_id*/, lefiMacro const& v)
+{
+	lef_macro_cbk(v);
+}
 #if 0
 void LefDataBase::lef_obstruction_cbk(lefiObstruction const& v)
 {
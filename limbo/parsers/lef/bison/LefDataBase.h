@@ -18,6 +18,9 @@
 #include <limbo/parsers/lef/bison/lefiDefs.hpp>
 #include <limbo/parsers/lef/bison/lefiUtil.hpp>
 
+/// @brief symbols shared by the LEF, DEF and Verilog drivers, see @ref limbo::DesignSymbols 
+namespace limbo { class DesignSymbols; }
+
 /// namespace for LefParser
 namespace LefParser {
 
@@ -172,6 +175,16 @@ class LefDataBase
         /// @brief macro callback, describe standard cell type 
         /// @param v an object for macro 
 		virtual void lef_macro_cbk(lefiMacro const& v);
+        /// @brief symbols shared with DEF and Verilog databases 
+        /// @return the table, NULL by default to pass names only 
+		virtual limbo::DesignSymbols* lef_symbols();
+        /// @brief macro callback with symbols, called instead of @ref LefParser::LefDataBase::lef_macro_cbk 
+        /// if @ref LefParser::LefDataBase::lef_symbols returns a table. 
+        /// The macro is marked as defined, and names of its pins are interned as well. 
+        /// Call @ref LefParser::LefDataBase::lef_macro_cbk by default. 
+        /// @param macro_id symbol of the macro, the same as DEF components and Verilog instances of the macro 
+        /// @param v an object for macro 
+		virtual void lef_macro_id_cbk(unsigned int macro_id, lefiMacro const& v);
 		//virtual void lef_obstruction_cbk(lefiObstruction const&);
         /// @brief density callback 
         /// @param v an object for density 
@@ -10,15 +10,47 @@
 #include <limbo/parsers/lef/bison/lefiDebug.hpp>
 #include <cctype>
 #include <cstring>
+#include <strings.h>
 #include <unistd.h>
 #include <cstdlib>
 #include <cmath>
+#include <fstream>
+#include <limbo/parsers/common/PrefetchInputStream.h>
+#if ZLIB == 1
+#include <limbo/parsers/common/GzipInputStream.h>
+#endif
+#include <limbo/preprocessor/Instrument.h>
+#include <limbo/parsers/common/DesignSymbols.h>
+#include <sstream>
+#include <algorithm>
+#include <pthread.h>
 
 namespace LefParser {
 
+/// @brief pass a macro to a database, with symbols if the database shares a table 
+/// @param db database 
+/// @param v macro 
+static void lef_pass_macro(LefDataBase& db, lefiMacro const& v)
+{
+    limbo::DesignSymbols* symbols = db.lef_symbols(); 
+    if (symbols == NULL)
+    {
+        db.lef_macro_cbk(v); 
+        return; 
+    }
+    unsigned int macro_id = symbols->find_or_insert(limbo::DESIGN_MACRO, v.name()); 
+    symbols->define_macro(macro_id); 
+    for (int i = 0; i < v.numPins(); ++i)
+        symbols->find_or_insert(limbo::DESIGN_PIN, v.pin(i)->name()); 
+    db.lef_macro_id_cbk(macro_id, v); 
+}
+
 Driver::Driver(LefDataBase& db)
     : trace_scanning(false),
       trace_parsing(false),
+      skip(LEF_SKIP_NONE),
+      macros(NULL),
+      profile("LefParser"),
       m_db(db)
 {
 	lefNamesCaseSensitive = m_db.lefNamesCaseSensitive;  // always true in 5.6
@@ -148,6 +180,88 @@ Driver::Driver(LefDataBase& db)
 	lef_nlines = 1;
 
 	lefrLog = stdout; // dump to screen, original is 0 
+
+	// states of the grammar are kept per driver, so drivers can parse in different threads 
+	hasOpenedLogFile = 0; 
+	spaceMissing = 0; 
+	ignoreVersion = 0; 
+	temp_name[0] = '\0'; 
+	siteDef = symDef = sizeDef = pinDef = obsDef = origDef = 0; 
+	useLenThr = 0; 
+	layerCut = layerMastOver = layerRout = layerDir = 0; 
+	antennaType = lefiAntennaAR; 
+	arrayCutsVal = 0; 
+	arrayCutsWar = 0; 
+	viaRuleLayer = 0; 
+	viaLayer = 0; 
+	ndLayer = 0; 
+	numVia = 0; 
+	viaRuleHasDir = 0; 
+	viaRuleHasEnc = 0; 
+	ndRule = 0; 
+	ndLayerWidth = 0; 
+	ndLayerSpace = 0; 
+	isGenerate = 0; 
+	hasType = 0; 
+	hasPitch = 0; 
+	hasWidth = 0; 
+	hasDirection = 0; 
+	hasParallel = 0; 
+	hasInfluence = 0; 
+	hasTwoWidths = 0; 
+	hasLayerMincut = 0; 
+	hasManufactur = 0; 
+	hasMinfeature = 0; 
+	hasPRP = 0; 
+	needGeometry = 0; 
+	hasViaRule_layer = 0; 
+	hasSamenet = 0; 
+	hasSite = 0; 
+	hasSiteClass = 0; 
+	hasSiteSize = 0; 
+	hasSpCenter = 0; 
+	hasSpSamenet = 0; 
+	hasSpParallel = 0; 
+	hasSpLayer = 0; 
+	hasGeoLayer = 0; 
+
+	antennaInoutWarnings = 0;
+	antennaInputWarnings = 0;
+	antennaOutputWarnings = 0;
+	arrayWarnings = 0;
+	caseSensitiveWarnings = 0;
+	correctionTableWarnings = 0;
+	dielectricWarnings = 0;
+	edgeRateThreshold1Warnings = 0;
+	edgeRateThreshold2Warnings = 0;
+	edgeRateScaleFactorWarnings = 0;
+	inoutAntennaWarnings = 0;
+	inputAntennaWarnings = 0;
+	iRDropWarnings = 0;
+	layerWarnings = 0;
+	macroWarnings = 0;
+	maxStackViaWarnings = 0;
+	minFeatureWarnings = 0;
+	noiseMarginWarnings = 0;
+	noiseTableWarnings = 0;
+	nonDefaultWarnings = 0;
+	noWireExtensionWarnings = 0;
+	outputAntennaWarnings = 0;
+	pinWarnings = 0;
+	siteWarnings = 0;
+	spacingWarnings = 0;
+	timingWarnings = 0;
+	unitsWarnings = 0;
+	useMinSpacingWarnings = 0;
+	viaRuleWarnings = 0;
+	viaWarnings = 0;
+	layerCutSpacing = 0;
+	outMsg = NULL; 
+	lefPropDefType = '\0'; 
+	cur_token[0] = '\0'; 
+	saved_token[0] = '\0'; 
+	pv_token[0] = '\0'; 
+	nDMsgs = 0; 
 }
 Driver::~Driver()
 {
@@ -160,10 +274,12 @@ Driver::~Driver()
 
 bool Driver::parse_stream(std::istream& in, const std::string& sname)
 {
+    limboParserParse(profile);
     streamname = sname;
 
     Scanner scanner(&in);
     scanner.set_debug(trace_scanning);
+    scanner.set_skip(skip);
     this->lexer = &scanner;
 
     Parser parser(*this);
@@ -173,15 +289,24 @@ bool Driver::parse_stream(std::istream& in, const std::string& sname)
 
 bool Driver::parse_file(const std::string &filename)
 {
-    std::ifstream in(filename.c_str());
-    if (!in.good()) {std::cerr << "failed to open " << filename << std::endl; return false;}
     lefrFileName = (const char*)filename.c_str();
+#if ZLIB == 1
+    if (limbo::is_gzip_file(filename)) // inflated by a helper thread 
+    {
+        limbo::GzipInputStream in (filename);
+        if (!in.good()) {std::cerr << "failed to open " << filename << std::endl; return false;}
+        return parse_stream(in, filename);
+    }
+#endif
+    limbo::PrefetchInputStream in (filename); // read ahead by a helper thread 
+    if (!in.good()) {std::cerr << "failed to open " << filename << std::endl; return false;}
     return parse_stream(in, filename);
 }
 
 bool Driver::parse_string(const std::string &input, const std::string& sname)
 {
     std::istringstream iss(input);
+    lefrFileName = (const char*)sname.c_str();
     return parse_stream(iss, sname);
 }
 
@@ -199,14 +324,17 @@ void Driver::error(const std::string& m)
 /***************** custom callbacks here ******************/
 void Driver::lefrVersionStrCbk(string const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_version_cbk(v);
 }
 void Driver::lefrVersionCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_version_cbk(v);
 }
 void Driver::lefrDividerCharCbk(string const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_dividerchar_cbk(v);
 }
 void Driver::lefrLibraryEndCbk()
@@ -214,49 +342,65 @@ void Driver::lefrLibraryEndCbk()
 }
 void Driver::lefrCaseSensitiveCbk(int v)
 {
+	limboParserCallback(profile);
 	m_db.lef_casesensitive_cbk(v);
 }
 void Driver::lefrNoWireExtensionCbk(string const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_nowireextension_cbk(v);
 }
 void Driver::lefrManufacturingCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_manufacturing_cbk(v);
 }
 void Driver::lefrUseMinSpacingCbk(lefiUseMinSpacing const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_useminspacing_cbk(v);
 }
 void Driver::lefrClearanceMeasureCbk(string const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_clearancemeasure_cbk(v);
 }
 void Driver::lefrUnitsCbk(lefiUnits const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_units_cbk(v);
 }
 void Driver::lefrBusBitCharsCbk(string const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_busbitchars_cbk(v);
 }
 void Driver::lefrLayerCbk(lefiLayer const& v)
 {
+	limboParserRecord(profile, "LAYER");
+	limboParserCallback(profile);
 	m_db.lef_layer_cbk(v);
 }
 void Driver::lefrMaxStackViaCbk(lefiMaxStackVia const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_maxstackvia_cbk(v);
 }
 void Driver::lefrViaCbk(lefiVia const& v)
 {
+	limboParserRecord(profile, "VIA");
 	if (lefNdRule) // in non-default rules 
 		lefrNonDefault.lefiNonDefault::addViaRule(v);
 	else // normal mode 
+	{
+		limboParserCallback(profile);
 		m_db.lef_via_cbk(v);
+	}
 }
 void Driver::lefrViaRuleCbk(lefiViaRule const& v)
 {
+	limboParserRecord(profile, "VIARULE");
+	limboParserCallback(profile);
 	m_db.lef_viarule_cbk(v);
 }
 void Driver::lefrSpacingBeginCbk(int)
@@ -277,10 +421,14 @@ void Driver::lefrSpacingEndCbk(int)
 }
 void Driver::lefrSpacingCbk(lefiSpacing const& s)
 {
+	limboParserRecord(profile, "SPACING");
 	if (lefNdRule) // in non-default rules 
 		lefrNonDefault.lefiNonDefault::addSpacingRule(s);
 	else // normal mode 
+	{
+		limboParserCallback(profile);
 		m_db.lef_spacing_cbk(s);
+	}
 }
 void Driver::lefrIRDropBeginCbk(int)
 {
@@ -290,22 +438,30 @@ void Driver::lefrIRDropEndCbk(int)
 }
 void Driver::lefrIRDropCbk(lefiIRDrop const& v)
 {
+	limboParserRecord(profile, "IRDROP");
+	limboParserCallback(profile);
 	m_db.lef_irdrop_cbk(v);
 }
 void Driver::lefrMinFeatureCbk(lefiMinFeature const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_minfeature_cbk(v);
 }
 void Driver::lefrDielectricCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_dielectric_cbk(v);
 }
 void Driver::lefrNonDefaultCbk(lefiNonDefault const& v)
 {
+	limboParserRecord(profile, "NONDEFAULTRULE");
+	limboParserCallback(profile);
 	m_db.lef_nondefault_cbk(v);
 }
 void Driver::lefrSiteCbk(lefiSite const& v)
 {
+	limboParserRecord(profile, "SITE");
+	limboParserCallback(profile);
 	m_db.lef_site_cbk(v);
 }
 void Driver::lefrMacroBeginCbk(string const&)
@@ -316,7 +472,18 @@ void Driver::lefrMacroEndCbk(string const&)
 }
 void Driver::lefrMacroCbk(lefiMacro const& v)
 {
-	m_db.lef_macro_cbk(v);
+	limboParserRecord(profile, "MACRO");
+	if (macros)
+	{
+		// keep the macro and continue with an empty one 
+		macros->push_back(new lefiMacro());
+		macros->back()->swap(lefrMacro);
+	}
+	else 
+	{
+		limboParserCallback(profile);
+		lef_pass_macro(m_db, v);
+	}
     //lefrMacro.Init();
     //lefrMacro.obstruction().Destroy();
     lefrMacro.clear();
@@ -338,14 +505,19 @@ void Driver::lefrObstructionCbk(lefiObstruction& v)
 }
 void Driver::lefrDensityCbk(lefiDensity const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_density_cbk(v);
 }
 void Driver::lefrTimingCbk(lefiTiming const& v)
 {
+	limboParserRecord(profile, "TIMING");
+	limboParserCallback(profile);
 	m_db.lef_timing_cbk(v);
 }
 void Driver::lefrArrayCbk(lefiArray const& v)
 {
+	limboParserRecord(profile, "ARRAY");
+	limboParserCallback(profile);
 	m_db.lef_array_cbk(v);
 }
 void Driver::lefrArrayBeginCbk(string const&)
@@ -358,58 +530,75 @@ void Driver::lefrPropEndCbk(int)
 {}
 void Driver::lefrPropCbk(lefiProp const& v)
 {
+	limboParserRecord(profile, "PROPERTYDEFINITIONS");
+	limboParserCallback(profile);
 	m_db.lef_prop_cbk(v);
 }
 void Driver::lefrNoiseMarginCbk(lefiNoiseMargin const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_noisemargin_cbk(v);
 }
 void Driver::lefrEdgeRateThreshold1Cbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_edgeratethreshold1_cbk(v);
 }
 void Driver::lefrEdgeRateThreshold2Cbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_edgeratethreshold2_cbk(v);
 }
 void Driver::lefrEdgeRateScaleFactorCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_edgeratescalefactor_cbk(v);
 }
 void Driver::lefrNoiseTableCbk(lefiNoiseTable const& v)
 {
+	limboParserRecord(profile, "NOISETABLE");
+	limboParserCallback(profile);
 	m_db.lef_noisetable_cbk(v);
 }
 void Driver::lefrCorrectionTableCbk(lefiCorrectionTable const& v)
 {
+	limboParserRecord(profile, "CORRECTIONTABLE");
+	limboParserCallback(profile);
 	m_db.lef_correctiontable_cbk(v);
 }
 void Driver::lefrInputAntennaCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_inputantenna_cbk(v);
 }
 void Driver::lefrOutputAntennaCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_outputantenna_cbk(v);
 }
 void Driver::lefrInoutAntennaCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_inoutantenna_cbk(v);
 }
 void Driver::lefrAntennaInputCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_antennainput_cbk(v);
 }
 void Driver::lefrAntennaInoutCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_antennainout_cbk(v);
 }
 void Driver::lefrAntennaOutputCbk(double v)
 {
+	limboParserCallback(profile);
 	m_db.lef_antennaoutput_cbk(v);
 }
 void Driver::lefrExtensionCbk(string const& v)
 {
+	limboParserCallback(profile);
 	m_db.lef_extension_cbk(v);
 }
 
@@ -818,118 +1007,455 @@ double Driver::convert_name2num(char const* versionName) const
     return version;
 }
 
-/***************** static variables ******************/
-int Driver::ignoreVersion = 0; // ignore checking version number
-char Driver::temp_name[258];
-std::string Driver::layerName;
-std::string Driver::viaName;
-std::string Driver::viaRuleName;
-std::string Driver::nonDefaultRuleName;
-std::string Driver::siteName;
-std::string Driver::arrayName;
-std::string Driver::macroName;
-std::string Driver::pinName;
-
-int Driver::siteDef;
-int Driver::symDef;
-int Driver::sizeDef;
-int Driver::pinDef;
-int Driver::obsDef;
-int Driver::origDef;
-int Driver::useLenThr;
-int Driver::layerCut;
-int Driver::layerMastOver;
-int Driver::layerRout;
-int Driver::layerDir;
-lefiAntennaEnum Driver::antennaType = lefiAntennaAR;  /* 5.4 - antenna type */
-int Driver::arrayCutsVal;       /* keep track the arraycuts value */
-int Driver::arrayCutsWar;       /* keep track if warning has already printed */
-int Driver::viaRuleLayer;       /* keep track number of layer in a viarule */
-int Driver::viaLayer;           /* keep track number of layer in a via */
-std::string Driver::ndName;
-int Driver::ndLayer;            /* keep track number of layer in a nondefault */
-int Driver::numVia;             /* keep track number of via */
-int Driver::viaRuleHasDir;      /* viarule layer has direction construct */
-int Driver::viaRuleHasEnc;      /* viarule layer has enclosure construct */
-int Driver::ndRule = 0;         /* keep track if inside nondefaultrule */
-int Driver::ndLayerWidth;       /* keep track if width is set at ndLayer */
-int Driver::ndLayerSpace;       /* keep track if spacing is set at ndLayer */
-int Driver::isGenerate;         /* keep track if viarule has generate */
-int Driver::hasType;            /* keep track of type in layer */
-int Driver::hasPitch;           /* keep track of pitch in layer */
-int Driver::hasWidth;           /* keep track of width in layer */
-int Driver::hasDirection;       /* keep track of direction in layer */
-int Driver::hasParallel;        /* keep track of parallelrunlength */
-int Driver::hasInfluence;       /* keep track of influence */
-int Driver::hasTwoWidths;       /* keep track of twoWidths */
-int Driver::hasLayerMincut;     /* keep track of layer minimumcut */
-int Driver::hasManufactur = 0;  /* keep track of manufacture is after unit */
-int Driver::hasMinfeature = 0;  /* keep track of minfeature is after unit */
-int Driver::hasPRP;             /* keep track if path, rect or poly is def */
-int Driver::needGeometry;       /* keep track if path/rect/poly is defined */
-int Driver::hasViaRule_layer = 0; /* keep track at least viarule or layer */
-int Driver::hasSamenet;         /* keep track if samenet is defined in spacing */
-int Driver::hasSite = 0;        /* keep track if SITE has defined for pre 5.6 */
-int Driver::hasSiteClass = 0;   /* keep track if SITE has CLASS */
-int Driver::hasSiteSize = 0;    /* keep track if SITE has SIZE */
-int Driver::hasSpCenter = 0;    /* keep track if LAYER SPACING has CENTER */
-int Driver::hasSpSamenet = 0;   /* keep track if LAYER SPACING has SAMENET */
-int Driver::hasSpParallel = 0;  /* keep track if LAYER SPACING has PARALLEL */
-int Driver::hasSpLayer = 0;     /* keep track if LAYER SPACING has LAYER */
-int Driver::hasGeoLayer = 0;    /* keep track if Geometries has LAYER */
-
-
-// the following variables to keep track the number of warnings printed.
-int Driver::antennaInoutWarnings = 0;
-int Driver::antennaInputWarnings = 0;
-int Driver::antennaOutputWarnings = 0;
-int Driver::arrayWarnings = 0;
-int Driver::caseSensitiveWarnings = 0;
-int Driver::correctionTableWarnings = 0;
-int Driver::dielectricWarnings = 0;
-int Driver::edgeRateThreshold1Warnings = 0;
-int Driver::edgeRateThreshold2Warnings = 0;
-int Driver::edgeRateScaleFactorWarnings = 0;
-int Driver::inoutAntennaWarnings = 0;
-int Driver::inputAntennaWarnings = 0;
-int Driver::iRDropWarnings = 0;
-int Driver::layerWarnings = 0;
-int Driver::macroWarnings = 0;
-int Driver::maxStackViaWarnings = 0;
-int Driver::minFeatureWarnings = 0;
-int Driver::noiseMarginWarnings = 0;
-int Driver::noiseTableWarnings = 0;
-int Driver::nonDefaultWarnings = 0;
-int Driver::noWireExtensionWarnings = 0;
-int Driver::outputAntennaWarnings = 0;
-int Driver::pinWarnings = 0;
-int Driver::siteWarnings = 0;
-int Driver::spacingWarnings = 0;
-int Driver::timingWarnings = 0;
-int Driver::unitsWarnings = 0;
-int Driver::useMinSpacingWarnings = 0;
-int Driver::viaRuleWarnings = 0;
-int Driver::viaWarnings = 0;
-double Driver::layerCutSpacing = 0;
-
-int Driver::hasOpenedLogFile = 0; /* flag on how to open the warning log file */
-int Driver::spaceMissing = 0;   /* flag to indicate if there is space after " */
-int Driver::nDMsgs = 0; // disable message 
-
-char* Driver::outMsg = NULL; // error messages
-char Driver::lefPropDefType; /* save the current type of the property */
-char Driver::cur_token[STRSIZE];      /* global so error message can print it */
-char Driver::saved_token[STRSIZE];/* for an (illegal) usage ';TOKEN' */
-char Driver::pv_token[STRSIZE];   /* previous token, for check ; without space */
-int Driver::lefrRegisterUnused = 0;
-
-bool read(LefDataBase& db, const string& lefFile)
+bool read(LefDataBase& db, const string& lefFile, unsigned skip)
 {
+	limboScopedTimer("LefParser::read");
+	limboScopedAllocations("LefParser::read");
 	Driver driver (db);
+	driver.skip = skip;
 	//driver.trace_scanning = true;
 	//driver.trace_parsing = true;
 
 	return driver.parse_file(lefFile);
 }
 
+/// @brief database only passing macros to another database, 
+/// used to parse statements before macros again for @ref LefParser::LefMacroIndex 
+class LefMacroFilterDataBase : public LefDataBase
+{
+    public:
+        /// @brief constructor 
+        /// @param db database receiving macros 
+        LefMacroFilterDataBase(LefDataBase& db) : LefDataBase(), m_db(db) 
+        {
+            current_version(db.current_version()); 
+        }
+        /// @cond
+        virtual void lef_version_cbk(string const&) {}
+        virtual void lef_version_cbk(double) {}
+        virtual void lef_dividerchar_cbk(string const&) {}
+        virtual void lef_casesensitive_cbk(int) {}
+        virtual void lef_nowireextension_cbk(string const&) {}
+        virtual void lef_manufacturing_cbk(double) {}
+        virtual void lef_useminspacing_cbk(lefiUseMinSpacing const&) {}
+        virtual void lef_clearancemeasure_cbk(string const&) {}
+        virtual void lef_units_cbk(lefiUnits const&) {}
+        virtual void lef_busbitchars_cbk(string const&) {}
+        virtual void lef_layer_cbk(lefiLayer const&) {}
+        virtual void lef_maxstackvia_cbk(lefiMaxStackVia const&) {}
+        virtual void lef_via_cbk(lefiVia const&) {}
+        virtual void lef_viarule_cbk(lefiViaRule const&) {}
+        virtual void lef_spacing_cbk(lefiSpacing const&) {}
+        virtual void lef_irdrop_cbk(lefiIRDrop const&) {}
+        virtual void lef_minfeature_cbk(lefiMinFeature const&) {}
+        virtual void lef_dielectric_cbk(double) {}
+        virtual void lef_nondefault_cbk(lefiNonDefault const&) {}
+        virtual void lef_site_cbk(lefiSite const&) {}
+        virtual void lef_macro_cbk(lefiMacro const& v) {lef_pass_macro(m_db, v);}
+        virtual void lef_density_cbk(lefiDensity const&) {}
+        virtual void lef_timing_cbk(lefiTiming const&) {}
+        virtual void lef_array_cbk(lefiArray const&) {}
+        virtual void lef_prop_cbk(lefiProp const&) {}
+        virtual void lef_noisemargin_cbk(lefiNoiseMargin const&) {}
+        virtual void lef_edgeratethreshold1_cbk(double) {}
+        virtual void lef_edgeratethreshold2_cbk(double) {}
+        virtual void lef_edgeratescalefactor_cbk(double) {}
+        virtual void lef_noisetable_cbk(lefiNoiseTable const&) {}
+        virtual void lef_correctiontable_cbk(lefiCorrectionTable const&) {}
+        virtual void lef_inputantenna_cbk(double) {}
+        virtual void lef_outputantenna_cbk(double) {}
+        virtual void lef_inoutantenna_cbk(double) {}
+        virtual void lef_antennainput_cbk(double) {}
+        virtual void lef_antennaoutput_cbk(double) {}
+        virtual void lef_antennainout_cbk(double) {}
+        virtual void lef_extension_cbk(string const&) {}
+        /// @endcond
+    protected:
+        LefDataBase& m_db; ///< database receiving macros 
+};
+
+/// @brief find the next token for @ref LefParser::LefMacroIndex, skipping white spaces and comments 
+/// @param data first character 
+/// @param size number of characters 
+/// @param pos position to start, set to the end of the token 
+/// @param begin first character of the token 
+/// @return false if no more token 
+static bool lef_next_token(const char* data, std::size_t size, std::size_t& pos, std::size_t& begin)
+{
+    while (pos < size)
+    {
+        char c = data[pos]; 
+        if (isspace((unsigned char)c))
+            ++pos; 
+        else if (c == '#')
+        {
+            const char* p = (const char*)memchr(data+pos, '\n', size-pos); 
+            pos = (p)? p-data : size; 
+        }
+        else 
+            break; 
+    }
+    if (pos >= size)
+        return false; 
+    begin = pos; 
+    if (data[pos] == '"')
+    {
+        const char* p = (const char*)memchr(data+pos+1, '"', size-pos-1); 
+        pos = (p)? p-data+1 : size; 
+    }
+    else 
+    {
+        while (pos < size && !isspace((unsigned char)data[pos]) && data[pos] != '#' && data[pos] != '"')
+            ++pos; 
+    }
+    return true; 
+}
+
+/// @brief case-insensitive comparison of a token with a keyword 
+/// @param data first character of the token 
+/// @param size length of the token 
+/// @param keyword upper case keyword 
+/// @return true if equal 
+static bool lef_token_is(const char* data, std::size_t size, const char* keyword)
+{
+    return std::strlen(keyword) == size && strncasecmp(data, keyword, size) == 0; 
+}
+
+/// @brief locate MACRO statements 
+/// @param data first character of the file 
+/// @param size number of characters 
+/// @param vMacro macros in the order of the file 
+/// @return false if a statement is not terminated 
+static bool lef_index_macros(const char* data, std::size_t size, vector<LefMacroRange>& vMacro)
+{
+    std::size_t pos = 0; 
+    std::size_t begin = 0; 
+    while (lef_next_token(data, size, pos, begin))
+    {
+        std::size_t len = pos-begin; 
+        // MACRO also appears in PROPERTYDEFINITIONS, and anything may appear in extensions 
+        if (lef_token_is(data+begin, len, "PROPERTYDEFINITIONS") || lef_token_is(data+begin, len, "BEGINEXT"))
+        {
+            bool extFlag = (data[begin] == 'B' || data[begin] == 'b'); 
+            bool endFlag = false; 
+            bool found = false; 
+            while (!found && lef_next_token(data, size, pos, begin))
+            {
+                len = pos-begin; 
+                if (extFlag)
+                    found = lef_token_is(data+begin, len, "ENDEXT"); 
+                else 
+                    found = endFlag && lef_token_is(data+begin, len, "PROPERTYDEFINITIONS"); 
+                endFlag = lef_token_is(data+begin, len, "END"); 
+            }
+            if (!found)
+                return false; 
+        }
+        else if (lef_token_is(data+begin, len, "MACRO"))
+        {
+            LefMacroRange range; 
+            range.begin = begin; 
+            if (!lef_next_token(data, size, pos, begin))
+                return false; 
+            range.name.assign(data+begin, pos-begin); 
+            // PIN name ... END name, macro name ... END name; 
+            // END of PORT and OBS is followed by other statements, so the next token is only consumed on a match 
+            string pinName; 
+            bool found = false; 
+            while (!found && lef_next_token(data, size, pos, begin))
+            {
+                len = pos-begin; 
+                if (lef_token_is(data+begin, len, "PIN"))
+                {
+                    if (!lef_next_token(data, size, pos, begin))
+                        return false; 
+                    pinName.assign(data+begin, pos-begin); 
+                }
+                else if (lef_token_is(data+begin, len, "END"))
+                {
+                    std::size_t next = pos; 
+                    std::size_t nextBegin = 0; 
+                    if (!lef_next_token(data, size, next, nextBegin))
+                        return false; 
+                    string const& target = (pinName.empty())? range.name : pinName; 
+                    if (target.compare(0, string::npos, data+nextBegin, next-nextBegin) == 0)
+                    {
+                        pos = next; 
+                        if (pinName.empty())
+                            found = true; 
+                        else 
+                            pinName.clear(); 
+                    }
+                }
+            }
+            if (!found)
+                return false; 
+            range.end = pos; 
+            vMacro.push_back(range); 
+        }
+    }
+    return true; 
+}
+
+/// @brief copy a LEF file with macros replaced by their line breaks, so locations of errors are kept 
+/// @param content content of the file 
+/// @param vMacro macros in the order of the file 
+/// @param vMacroName if not NULL, these macros are kept 
+/// @param text copy of the file 
+static void lef_remove_macros(string const& content, vector<LefMacroRange> const& vMacro, std::set<string> const* vMacroName, string& text)
+{
+    text.clear(); 
+    text.reserve(content.size()); 
+    std::size_t last = 0; 
+    for (vector<LefMacroRange>::const_iterator it = vMacro.begin(); it != vMacro.end(); ++it)
+    {
+        if (vMacroName && vMacroName->count(it->name))
+            continue; 
+        text.append(content, last, it->begin-last); 
+        text.append(std::count(content.begin()+it->begin, content.begin()+it->end, '\n'), '\n'); 
+        last = it->end; 
+    }
+    text.append(content, last, string::npos); 
+}
+
+bool LefMacroIndex::read(LefDataBase& db, const string& lefFile, std::set<string> const* vMacroName)
+{
+    m_filename = lefFile; 
+    m_header.clear(); 
+    m_vMacro.clear(); 
+    m_mName2Index.clear(); 
+
+    std::ifstream in (lefFile.c_str()); 
+    if (!in.good()) 
+    {
+        std::cerr << "failed to open " << lefFile << std::endl; 
+        return false;
+    }
+    std::ostringstream oss; 
+    oss << in.rdbuf(); 
+    string content = oss.str(); 
+    if (!lef_index_macros(content.data(), content.size(), m_vMacro))
+    {
+        std::cerr << "failed to locate macros in " << lefFile << ", parse the whole file" << std::endl; 
+        m_vMacro.clear(); 
+        Driver driver (db);
+        return driver.parse_string(content, lefFile);
+    }
+    for (std::size_t i = 0; i < m_vMacro.size(); ++i)
+        m_mName2Index.insert(std::make_pair(m_vMacro[i].name, (int)i)); 
+    m_header.assign(content, 0, (m_vMacro.empty())? content.size() : m_vMacro.front().begin); 
+
+    // macros not requested are removed 
+    string text; 
+    lef_remove_macros(content, m_vMacro, vMacroName, text); 
+    string().swap(content); 
+
+    Driver driver (db);
+    return driver.parse_string(text, lefFile);
+}
+
+int LefMacroIndex::find(string const& macroName) const 
+{
+    std::map<string, int>::const_iterator found = m_mName2Index.find(macroName); 
+    return (found == m_mName2Index.end())? -1 : found->second; 
+}
+
+bool LefMacroIndex::read_macros(LefDataBase& db, std::set<string> const& vMacroName) const
+{
+    vector<int> vIndex; 
+    for (std::set<string>::const_iterator it = vMacroName.begin(); it != vMacroName.end(); ++it)
+    {
+        int i = find(*it); 
+        if (i >= 0)
+            vIndex.push_back(i); 
+    }
+    std::sort(vIndex.begin(), vIndex.end()); 
+    return read_macros(db, vIndex); 
+}
+
+bool LefMacroIndex::read_macro(LefDataBase& db, string const& macroName) const
+{
+    int i = find(macroName); 
+    if (i < 0)
+        return false; 
+    return read_macros(db, vector<int>(1, i)); 
+}
+
+bool LefMacroIndex::read_macros(LefDataBase& db, vector<int> const& vIndex) const
+{
+    if (vIndex.empty())
+        return true; 
+    std::ifstream in (m_filename.c_str(), std::ios::in | std::ios::binary); 
+    if (!in.good()) 
+    {
+        std::cerr << "failed to open " << m_filename << std::endl; 
+        return false;
+    }
+    string text (m_header); 
+    for (vector<int>::const_iterator it = vIndex.begin(); it != vIndex.end(); ++it)
+    {
+        LefMacroRange const& range = m_vMacro.at(*it); 
+        std::size_t offset = text.size(); 
+        text.resize(offset + range.end-range.begin + 1); 
+        in.seekg(range.begin); 
+        in.read(&text[offset], range.end-range.begin); 
+        if (!in.good())
+        {
+            std::cerr << "failed to read macro " << range.name << " from " << m_filename << std::endl; 
+            return false; 
+        }
+        text[text.size()-1] = '\n'; 
+    }
+    text += "END LIBRARY\n"; 
+
+    LefMacroFilterDataBase filterDb (db); 
+    Driver driver (filterDb);
+    return driver.parse_string(text, m_filename);
+}
+
+/// @brief a LEF file parsed by a thread for @ref LefParser::read with multiple files 
+struct LefFileTask
+{
+    string const* filename; ///< LEF file 
+    string text; ///< the file without macros, parsed again in order 
+    vector<lefiMacro*> vMacro; ///< macros in the order of the file 
+    bool indexed; ///< whether macros are located, otherwise the whole file is parsed again in order 
+    bool result; ///< true if successfully read 
+};
+
+/// @brief LEF files shared by threads 
+struct LefParallelData
+{
+    LefDataBase* db; ///< database, only its version is read by threads 
+    unsigned skip; ///< sections skipped by scanners 
+    vector<LefFileTask> vTask; ///< files in order 
+    std::size_t next; ///< next file to parse 
+};
+
+/// @brief read a LEF file into memory 
+/// @param filename LEF file, possibly gzipped 
+/// @param content content of the file 
+/// @return true if succeed 
+static bool lef_read_file(string const& filename, string& content)
+{
+    std::ostringstream oss; 
+#if ZLIB == 1
+    if (limbo::is_gzip_file(filename))
+    {
+        limbo::GzipInputStream in (filename);
+        if (!in.good()) {std::cerr << "failed to open " << filename << std::endl; return false;}
+        oss << in.rdbuf(); 
+        content = oss.str(); 
+        return true; 
+    }
+#endif
+    std::ifstream in (filename.c_str(), std::ios::in | std::ios::binary); 
+    if (!in.good()) {std::cerr << "failed to open " << filename << std::endl; return false;}
+    oss << in.rdbuf(); 
+    content = oss.str(); 
+    return true; 
+}
+
+/// @brief thread function to parse files in turn, macros are kept in the tasks 
+/// @param arg pointer to @ref LefParser::LefParallelData
+/// @return NULL 
+static void* lef_parse_files(void* arg)
+{
+    LefParallelData& data = *(LefParallelData*)arg;
+    while (true)
+    {
+        std::size_t i = __sync_fetch_and_add(&data.next, 1);
+        if (i >= data.vTask.size())
+            break;
+        LefFileTask& task = data.vTask[i]; 
+        string content; 
+        task.result = lef_read_file(*task.filename, content); 
+        if (!task.result)
+            continue; 
+        vector<LefMacroRange> vRange; 
+        task.indexed = lef_index_macros(content.data(), content.size(), vRange); 
+        if (!task.indexed)
+            continue; 
+        lef_remove_macros(content, vRange, NULL, task.text); 
+
+        // other statements do not reach the database, which is not locked 
+        LefMacroFilterDataBase filterDb (*data.db); 
+        Driver driver (filterDb); 
+        driver.skip = data.skip; 
+        driver.macros = &task.vMacro; 
+        task.result = driver.parse_string(content, *task.filename); 
+    }
+    return NULL;
+}
+
+bool read(LefDataBase& db, vector<string> const& vLefFile, int numThreads, unsigned skip)
+{
+	limboScopedTimer("LefParser::read");
+	limboScopedAllocations("LefParser::read");
+    if (numThreads <= 1 || vLefFile.size() <= 1)
+    {
+        for (vector<string>::const_iterator it = vLefFile.begin(); it != vLefFile.end(); ++it)
+        {
+            if (!read(db, *it, skip))
+                return false; 
+        }
+        return true; 
+    }
+
+    LefParallelData data; 
+    data.db = &db; 
+    data.skip = skip; 
+    data.next = 0; 
+    data.vTask.resize(vLefFile.size()); 
+    for (std::size_t i = 0; i < vLefFile.size(); ++i)
+    {
+        data.vTask[i].filename = &vLefFile[i]; 
+        data.vTask[i].indexed = false; 
+        data.vTask[i].result = false; 
+    }
+
+    // threads take files in turn, the current thread also works 
+    std::size_t numWorkers = std::min((std::size_t)numThreads, vLefFile.size());
+    vector<pthread_t> vThread (numWorkers);
+    vector<char> vCreated (numWorkers, false);
+    for (std::size_t i = 1; i < numWorkers; ++i)
+        vCreated[i] = (pthread_create(&vThread[i], NULL, lef_parse_files, &data) == 0);
+    // also finishes files left by threads failed to create 
+    lef_parse_files(&data);
+    for (std::size_t i = 1; i < numWorkers; ++i)
+    {
+        if (vCreated[i])
+            pthread_join(vThread[i], NULL);
+    }
+
+    // pass files to the database in order 
+    bool result = true; 
+    for (vector<LefFileTask>::iterator it = data.vTask.begin(); it != data.vTask.end(); ++it)
+    {
+        if (result && it->result)
+        {
+            Driver driver (db); 
+            driver.skip = skip; 
+            if (it->indexed)
+            {
+                result = driver.parse_string(it->text, *it->filename); 
+                for (vector<lefiMacro*>::const_iterator itm = it->vMacro.begin(); result && itm != it->vMacro.end(); ++itm)
+                {
+                    // counted as records by the thread parsing the file 
+                    limboParserCallback(driver.profile);
+                    lef_pass_macro(db, **itm); 
+                }
+            }
+            else 
+                result = driver.parse_file(*it->filename); 
+        }
+        else 
+            result = false; 
+        for (vector<lefiMacro*>::iterator itm = it->vMacro.begin(); itm != it->vMacro.end(); ++itm)
+            delete *itm; 
+        it->vMacro.clear(); 
+    }
+    return result; 
+}
+
 } // namespace example
@@ -32,7 +32,9 @@
 #define LEFPARSER_DRIVER_H
 
 #include <map>
+#include <set>
 #include <limbo/parsers/lef/bison/LefDataBase.h>
+#include <limbo/parsers/common/ParserProfile.h>
 
 /** The example namespace is used to encapsulate the three parser classes
  * example::Parser, example::Scanner and example::Driver */
@@ -53,6 +55,14 @@ using std::ostringstream;
 #define STRSIZE 4096
 #endif 
 
+/// @brief sections skipped by the scanner, see @ref LefParser::Driver::skip. 
+/// Skipped text is fast-forwarded without tokens or grammar actions. 
+enum LefSkipFlag
+{
+    LEF_SKIP_NONE = 0, ///< parse everything 
+    LEF_SKIP_PROPERTYDEFINITIONS = 1 ///< PROPERTYDEFINITIONS section up to END PROPERTYDEFINITIONS, properties of objects get no types 
+};
+
 /** 
  * @class LefParser::Driver
  * The Driver class brings together all components. It creates an instance of
@@ -78,6 +88,13 @@ public:
     /// stream name (file or input stream) used for error messages.
     string streamname;
 
+    /// bitwise OR of @ref LefParser::LefSkipFlag, sections skipped by the scanner 
+    unsigned skip;
+
+    /// if not NULL, parsed macros are moved into new objects appended here 
+    /// instead of passed to @ref LefParser::LefDataBase::lef_macro_cbk; the caller deletes them 
+    vector<lefiMacro*>* macros;
+
     /** Invoke the scanner and parser for a stream.
      * @param in	input stream
      * @param sname	stream name for error messages
@@ -117,6 +134,11 @@ public:
      * parser to the scanner. It is used in the yylex macro. */
     class Scanner* lexer;
 
+    /** Counters and timers of the scanner, grammar actions and database
+     * callbacks, compiled out unless LIMBO_INSTRUMENT is defined. It is used
+     * in the yylex macro. */
+    limbo::ParserProfile profile;
+
     /** Reference to the database filled during parsing of the
      * expressions. */
     LefDataBase& m_db;
@@ -215,8 +237,8 @@ public:
 	int lef_ntokens; ///< number of tokens 
 	int lef_nlines; ///< number of lines 
 	FILE* lefrLog; ///< log file handler 
-	static int hasOpenedLogFile; /*!< flag on how to open the warning log file */
-	static int spaceMissing;   /*!< flag to indicate if there is space after " */
+	int hasOpenedLogFile; /*!< flag on how to open the warning log file */
+	int spaceMissing;   /*!< flag to indicate if there is space after " */
 	std::string Hist_text;   ///< for BEGINEXT - extension
 
 	int doneLib;       ///< keep track if the file is done parsing
@@ -240,100 +262,100 @@ public:
 	/* #define STRING_LIST_SIZE 1024 */
 	/* char string_list[STRING_LIST_SIZE]; */
 
-	static int ignoreVersion; ///< ignore checking version number
-	static char temp_name[258]; ///< temporary buffer for characters 
-	static std::string layerName; ///< layer name 
-	static std::string viaName; ///< via name 
-	static std::string viaRuleName; ///< via rule name 
-	static std::string nonDefaultRuleName; ///< non default rule name 
-	static std::string siteName; ///< site name 
-	static std::string arrayName; ///< array name 
-	static std::string macroName; ///< macro name 
-	static std::string pinName; ///< pin name 
+	int ignoreVersion; ///< ignore checking version number
+	char temp_name[258]; ///< temporary buffer for characters 
+	std::string layerName; ///< layer name 
+	std::string viaName; ///< via name 
+	std::string viaRuleName; ///< via rule name 
+	std::string nonDefaultRuleName; ///< non default rule name 
+	std::string siteName; ///< site name 
+	std::string arrayName; ///< array name 
+	std::string macroName; ///< macro name 
+	std::string pinName; ///< pin name 
 
     ///@{
-	static int siteDef, symDef, sizeDef, pinDef, obsDef, origDef; ///< some definitions? 
+	int siteDef, symDef, sizeDef, pinDef, obsDef, origDef; ///< some definitions? 
     ///@}
-	static int useLenThr; ///< not sure what this is for 
+	int useLenThr; ///< not sure what this is for 
     ///@{
-	static int layerCut, layerMastOver, layerRout, layerDir; ///< some properties 
+	int layerCut, layerMastOver, layerRout, layerDir; ///< some properties 
     ///@}
-	static lefiAntennaEnum antennaType;  /*!< 5.4 - antenna type */
-	static int arrayCutsVal;       /*!< keep track the arraycuts value */
-	static int arrayCutsWar;       /*!< keep track if warning has already printed */
-	static int viaRuleLayer;       /*!< keep track number of layer in a viarule */
-	static int viaLayer;           /*!< keep track number of layer in a via */
-	static std::string ndName;		///< for ndName in lefSetNonDefault()
-	static int ndLayer;            /*!< keep track number of layer in a nondefault */
-	static int numVia;             /*!< keep track number of via */
-	static int viaRuleHasDir;      /*!< viarule layer has direction construct */
-	static int viaRuleHasEnc;      /*!< viarule layer has enclosure construct */
-	static int ndRule;         /*!< keep track if inside nondefaultrule */
-	static int ndLayerWidth;       /*!< keep track if width is set at ndLayer */
-	static int ndLayerSpace;       /*!< keep track if spacing is set at ndLayer */
-	static int isGenerate;         /*!< keep track if viarule has generate */
-	static int hasType;            /*!< keep track of type in layer */
-	static int hasPitch;           /*!< keep track of pitch in layer */
-	static int hasWidth;           /*!< keep track of width in layer */
-	static int hasDirection;       /*!< keep track of direction in layer */
-	static int hasParallel;        /*!< keep track of parallelrunlength */
-	static int hasInfluence;       /*!< keep track of influence */
-	static int hasTwoWidths;       /*!< keep track of twoWidths */
-	static int hasLayerMincut;     /*!< keep track of layer minimumcut */
-	static int hasManufactur;  /*!< keep track of manufacture is after unit */
-	static int hasMinfeature;  /*!< keep track of minfeature is after unit */
-	static int hasPRP;             /*!< keep track if path, rect or poly is def */
-	static int needGeometry;       /*!< keep track if path/rect/poly is defined */
-	static int hasViaRule_layer; /*!< keep track at least viarule or layer */
-	static int hasSamenet;         /*!< keep track if samenet is defined in spacing */
-	static int hasSite;        /*!< keep track if SITE has defined for pre 5.6 */
-	static int hasSiteClass;   /*!< keep track if SITE has CLASS */
-	static int hasSiteSize;    /*!< keep track if SITE has SIZE */
-	static int hasSpCenter;    /*!< keep track if LAYER SPACING has CENTER */
-	static int hasSpSamenet;   /*!< keep track if LAYER SPACING has SAMENET */
-	static int hasSpParallel;  /*!< keep track if LAYER SPACING has PARALLEL */
-	static int hasSpLayer;     /*!< keep track if LAYER SPACING has LAYER */
-	static int hasGeoLayer;    /*!< keep track if Geometries has LAYER */
+	lefiAntennaEnum antennaType;  /*!< 5.4 - antenna type */
+	int arrayCutsVal;       /*!< keep track the arraycuts value */
+	int arrayCutsWar;       /*!< keep track if warning has already printed */
+	int viaRuleLayer;       /*!< keep track number of layer in a viarule */
+	int viaLayer;           /*!< keep track number of layer in a via */
+	std::string ndName;		///< for ndName in lefSetNonDefault()
+	int ndLayer;            /*!< keep track number of layer in a nondefault */
+	int numVia;             /*!< keep track number of via */
+	int viaRuleHasDir;      /*!< viarule layer has direction construct */
+	int viaRuleHasEnc;      /*!< viarule layer has enclosure construct */
+	int ndRule;         /*!< keep track if inside nondefaultrule */
+	int ndLayerWidth;       /*!< keep track if width is set at ndLayer */
+	int ndLayerSpace;       /*!< keep track if spacing is set at ndLayer */
+	int isGenerate;         /*!< keep track if viarule has generate */
+	int hasType;            /*!< keep track of type in layer */
+	int hasPitch;           /*!< keep track of pitch in layer */
+	int hasWidth;           /*!< keep track of width in layer */
+	int hasDirection;       /*!< keep track of direction in layer */
+	int hasParallel;        /*!< keep track of parallelrunlength */
+	int hasInfluence;       /*!< keep track of influence */
+	int hasTwoWidths;       /*!< keep track of twoWidths */
+	int hasLayerMincut;     /*!< keep track of layer minimumcut */
+	int hasManufactur;  /*!< keep track of manufacture is after unit */
+	int hasMinfeature;  /*!< keep track of minfeature is after unit */
+	int hasPRP;             /*!< keep track if path, rect or poly is def */
+	int needGeometry;       /*!< keep track if path/rect/poly is defined */
+	int hasViaRule_layer; /*!< keep track at least viarule or layer */
+	int hasSamenet;         /*!< keep track if samenet is defined in spacing */
+	int hasSite;        /*!< keep track if SITE has defined for pre 5.6 */
+	int hasSiteClass;   /*!< keep track if SITE has CLASS */
+	int hasSiteSize;    /*!< keep track if SITE has SIZE */
+	int hasSpCenter;    /*!< keep track if LAYER SPACING has CENTER */
+	int hasSpSamenet;   /*!< keep track if LAYER SPACING has SAMENET */
+	int hasSpParallel;  /*!< keep track if LAYER SPACING has PARALLEL */
+	int hasSpLayer;     /*!< keep track if LAYER SPACING has LAYER */
+	int hasGeoLayer;    /*!< keep track if Geometries has LAYER */
 
 
 	// the following variables to keep track the number of warnings printed.
-	static int antennaInoutWarnings; ///< variable to keep track the number of warnings printed
-	static int antennaInputWarnings; ///< variable to keep track the number of warnings printed
-	static int antennaOutputWarnings; ///< variable to keep track the number of warnings printed
-	static int arrayWarnings; ///< variable to keep track the number of warnings printed
-	static int caseSensitiveWarnings; ///< variable to keep track the number of warnings printed
-	static int correctionTableWarnings; ///< variable to keep track the number of warnings printed
-	static int dielectricWarnings; ///< variable to keep track the number of warnings printed
-	static int edgeRateThreshold1Warnings; ///< variable to keep track the number of warnings printed
-	static int edgeRateThreshold2Warnings; ///< variable to keep track the number of warnings printed
-	static int edgeRateScaleFactorWarnings; ///< variable to keep track the number of warnings printed
-	static int inoutAntennaWarnings; ///< variable to keep track the number of warnings printed
-	static int inputAntennaWarnings; ///< variable to keep track the number of warnings printed
-	static int iRDropWarnings; ///< variable to keep track the number of warnings printed
-	static int layerWarnings; ///< variable to keep track the number of warnings printed
-	static int macroWarnings; ///< variable to keep track the number of warnings printed
-	static int maxStackViaWarnings; ///< variable to keep track the number of warnings printed
-	static int minFeatureWarnings; ///< variable to keep track the number of warnings printed
-	static int noiseMarginWarnings; ///< variable to keep track the number of warnings printed
-	static int noiseTableWarnings; ///< variable to keep track the number of warnings printed
-	static int nonDefaultWarnings; ///< variable to keep track the number of warnings printed
-	static int noWireExtensionWarnings; ///< variable to keep track the number of warnings printed
-	static int outputAntennaWarnings; ///< variable to keep track the number of warnings printed
-	static int pinWarnings; ///< variable to keep track the number of warnings printed
-	static int siteWarnings; ///< variable to keep track the number of warnings printed
-	static int spacingWarnings; ///< variable to keep track the number of warnings printed
-	static int timingWarnings; ///< variable to keep track the number of warnings printed
-	static int unitsWarnings; ///< variable to keep track the number of warnings printed
-	static int useMinSpacingWarnings; ///< variable to keep track the number of warnings printed
-	static int viaRuleWarnings; ///< variable to keep track the number of warnings printed
-	static int viaWarnings; ///< variable to keep track the number of warnings printed
-	static double layerCutSpacing; ///< variable to keep track the number of warnings printed
-	static char* outMsg; ///< error messages
-	static char lefPropDefType; /*!< save the current type of the property */
-	static char cur_token[STRSIZE];      /*!< global so error message can print it */
-	static char saved_token[STRSIZE];/*!< for an (illegal) usage ';TOKEN' */
-	static char pv_token[STRSIZE];   /*!< previous token, for check ; without space */
-	static int nDMsgs; ///< disable message 
+	int antennaInoutWarnings; ///< variable to keep track the number of warnings printed
+	int antennaInputWarnings; ///< variable to keep track the number of warnings printed
+	int antennaOutputWarnings; ///< variable to keep track the number of warnings printed
+	int arrayWarnings; ///< variable to keep track the number of warnings printed
+	int caseSensitiveWarnings; ///< variable to keep track the number of warnings printed
+	int correctionTableWarnings; ///< variable to keep track the number of warnings printed
+	int dielectricWarnings; ///< variable to keep track the number of warnings printed
+	int edgeRateThreshold1Warnings; ///< variable to keep track the number of warnings printed
+	int edgeRateThreshold2Warnings; ///< variable to keep track the number of warnings printed
+	int edgeRateScaleFactorWarnings; ///< variable to keep track the number of warnings printed
+	int inoutAntennaWarnings; ///< variable to keep track the number of warnings printed
+	int inputAntennaWarnings; ///< variable to keep track the number of warnings printed
+	int iRDropWarnings; ///< variable to keep track the number of warnings printed
+	int layerWarnings; ///< variable to keep track the number of warnings printed
+	int macroWarnings; ///< variable to keep track the number of warnings printed
+	int maxStackViaWarnings; ///< variable to keep track the number of warnings printed
+	int minFeatureWarnings; ///< variable to keep track the number of warnings printed
+	int noiseMarginWarnings; ///< variable to keep track the number of warnings printed
+	int noiseTableWarnings; ///< variable to keep track the number of warnings printed
+	int nonDefaultWarnings; ///< variable to keep track the number of warnings printed
+	int noWireExtensionWarnings; ///< variable to keep track the number of warnings printed
+	int outputAntennaWarnings; ///< variable to keep track the number of warnings printed
+	int pinWarnings; ///< variable to keep track the number of warnings printed
+	int siteWarnings; ///< variable to keep track the number of warnings printed
+	int spacingWarnings; ///< variable to keep track the number of warnings printed
+	int timingWarnings; ///< variable to keep track the number of warnings printed
+	int unitsWarnings; ///< variable to keep track the number of warnings printed
+	int useMinSpacingWarnings; ///< variable to keep track the number of warnings printed
+	int viaRuleWarnings; ///< variable to keep track the number of warnings printed
+	int viaWarnings; ///< variable to keep track the number of warnings printed
+	double layerCutSpacing; ///< variable to keep track the number of warnings printed
+	char* outMsg; ///< error messages
+	char lefPropDefType; /*!< save the current type of the property */
+	char cur_token[STRSIZE];      /*!< global so error message can print it */
+	char saved_token[STRSIZE];/*!< for an (illegal) usage ';TOKEN' */
+	char pv_token[STRSIZE];   /*!< previous token, for check ; without space */
+	int nDMsgs; ///< disable message 
 
 
 	int spParallelLength;          /*!< the number of layer parallelrunlength */
@@ -344,7 +366,7 @@ public:
     ///@{ 
 	lefiUserData lefrUserData; 
 	//char* lefrFileName; 
-	static int lefrRegisterUnused; 
+	int lefrRegisterUnused; 
 	FILE* lefrFile; 
 	lefiAntennaPWL* lefrAntennaPWLPtr; 
 	lefiArray lefrArray; 
@@ -464,7 +486,86 @@ public:
 /// Read LEF file and initialize database by calling user-defined callback functions. 
 /// @param db database which is derived from @ref LefParser::LefDataBase
 /// @param lefFile LEF file 
-bool read(LefDataBase& db, const string& lefFile);
+/// @param skip bitwise OR of @ref LefParser::LefSkipFlag, see @ref LefParser::Driver::skip
+bool read(LefDataBase& db, const string& lefFile, unsigned skip = LEF_SKIP_NONE);
+
+/// @brief API for LefParser. 
+/// Read LEF files with multiple threads, e.g., a technology LEF and cell LEFs. 
+/// Each thread parses whole files with its own driver, keeping macros in memory. 
+/// Afterwards, files are passed to the database in the order of the list: 
+/// statements other than macros of a file are parsed again without macros, 
+/// then macros of the file are passed in the order of the file. 
+/// The result is the same for any number of threads as long as statements of a file do not depend on macros before them. 
+/// Files in which macros cannot be located are parsed as a whole in order. 
+/// @param db database which is derived from @ref LefParser::LefDataBase
+/// @param vLefFile LEF files 
+/// @param numThreads number of threads 
+/// @param skip bitwise OR of @ref LefParser::LefSkipFlag, see @ref LefParser::Driver::skip
+/// @return true if all files are parsed successfully; files after a failure are not passed to the database 
+bool read(LefDataBase& db, vector<string> const& vLefFile, int numThreads, unsigned skip = LEF_SKIP_NONE);
+
+/// @brief byte range of a MACRO statement in a LEF file, see @ref LefParser::LefMacroIndex 
+struct LefMacroRange
+{
+    string name; ///< macro name 
+    std::size_t begin; ///< first character of MACRO 
+    std::size_t end; ///< end of the macro name after END 
+};
+
+/// @class LefParser::LefMacroIndex
+/// @brief read a LEF file with macros parsed on demand. 
+/// 
+/// The first pass locates MACRO statements by tokens without parsing them, 
+/// and parses everything else, e.g., units, layers, vias and sites, to the database. 
+/// Macro bodies are parsed later by names, 
+/// so macros never instantiated by the design do not build @ref LefParser::lefiMacro objects. 
+/// Statements before the first macro are parsed again with each request, 
+/// but their callbacks are not passed to the database. 
+class LefMacroIndex
+{
+    public:
+        /// @brief constructor 
+        LefMacroIndex() {}
+
+        /// @brief first pass: index macros and parse other statements 
+        /// @param db database which is derived from @ref LefParser::LefDataBase
+        /// @param lefFile LEF file 
+        /// @param vMacroName if not NULL, these macros are parsed in the first pass in the order of the file, 
+        /// e.g., cell types used in DEF or Verilog 
+        /// @return true if succeed; if macros cannot be located, the whole file is parsed and no macro is indexed 
+        bool read(LefDataBase& db, const string& lefFile, std::set<string> const* vMacroName = NULL);
+        /// @brief parse macros by names, @ref LefParser::LefDataBase::lef_macro_cbk is invoked in the order of the file 
+        /// @param db database 
+        /// @param vMacroName macro names, names not in the file are ignored 
+        /// @return true if succeed 
+        bool read_macros(LefDataBase& db, std::set<string> const& vMacroName) const;
+        /// @brief parse a macro 
+        /// @param db database 
+        /// @param macroName macro name 
+        /// @return true if the macro is found and parsed 
+        bool read_macro(LefDataBase& db, string const& macroName) const;
+
+        /// @return number of macros 
+        std::size_t num_macros() const {return m_vMacro.size();}
+        /// @return byte range of a macro 
+        /// @param i index of the macro in the file 
+        LefMacroRange const& macro(std::size_t i) const {return m_vMacro[i];}
+        /// @return index of a macro, -1 if not found 
+        /// @param macroName macro name 
+        int find(string const& macroName) const; 
+
+    protected:
+        /// @brief parse macros and statements before the first macro without callbacks of other statements 
+        /// @param db database 
+        /// @param vIndex indices of macros in ascending order 
+        /// @return true if succeed 
+        bool read_macros(LefDataBase& db, vector<int> const& vIndex) const;
+
+        string m_filename; ///< LEF file 
+        string m_header; ///< statements before the first macro 
+        vector<LefMacroRange> m_vMacro; ///< macros in the order of the file 
+        std::map<string, int> m_mName2Index; ///< map from macro names to indices, the first one is kept for duplicate names 
+};
 
 } // namespace example
 
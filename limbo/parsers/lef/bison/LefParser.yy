@@ -532,7 +532,7 @@
  * object. it defines the yylex() function call to pull the next token from the
  * current lexer object of the driver context. */
 #undef yylex
-#define yylex driver.lexer->lex
+#define yylex(yylval, yylloc) limboParserScan(driver.profile, driver.lexer->lex(yylval, yylloc))
 
 %}
 
@@ -5276,7 +5276,7 @@ macro_pin: start_macro_pin macro_pin_options end_macro_pin
     { 
       if (/*driver.lefrPinCbk*/ 1)
         /*driver.lefrPinCbk( driver.lefrPin);*/
-		driver.lefrMacro.addPin(driver.lefrPin);
+		driver.lefrMacro.takePin(driver.lefrPin);
       driver.lefrPin.lefiPin::clear();
     }
 
@@ -53,6 +53,21 @@ public:
 
     /** Enable debug output (via arg_yyout) if compiled into the scanner. */
     void set_debug(bool b);
+
+    /** Set sections to fast-forward without tokens, a bitwise OR of
+     * LefSkipFlag. */
+    void set_skip(unsigned skip) {m_skip = skip;}
+
+protected:
+    /** Count line breaks of a token spanning lines, which YY_USER_ACTION has
+     * counted as columns. */
+    void count_lines(Parser::location_type* yylloc);
+    /** @return true if the current token, END followed by a word, ends the
+     * skipped section. */
+    bool is_skip_end() const;
+
+    unsigned m_skip; ///< bitwise OR of LefSkipFlag
+    const char* m_skipEnd; ///< keyword of the skipped section
 };
 
 } // namespace example
@@ -4,8 +4,14 @@
 %{ /*** C/C++ Declarations ***/
 
 #include <string>
+#include <cstring>
+#include <strings.h>
+#include <algorithm>
+#include <limbo/string/CharConv.h>
+#include <limbo/parsers/common/ParserProfile.h>
 
 #include "LefScanner.h"
+#include "LefDriver.h"
 
 /* import the parser's token type into a local typedef */
 typedef LefParser::Parser::token token;
@@ -42,12 +48,24 @@ typedef LefParser::Parser::token_type token_type;
 /* enables the use of start condition stacks */
 %option stack
 
+/* a skipped section up to its END */
+%x SKIPSECTION
+
 /* The following paragraph suffices to track locations accurately. Each time
  * yylex is invoked, the begin position is moved onto the end position. */
 %{
 #define YY_USER_ACTION  yylloc->columns(yyleng);
 %}
 
+/* Read input as flex does by default, and count the bytes in the profile of
+ * the driver if compiled with LIMBO_INSTRUMENT. */
+%{
+#define YY_INPUT(buf, result, max_size) \
+    if ((int)(result = LexerInput((char*)buf, max_size)) < 0) \
+        YY_FATAL_ERROR("input in flex scanner failed"); \
+    limboParserBytes(result);
+%}
+
 %% /*** Regular Expressions Part ***/
 
  /* code to place at the beginning of yylex() */
@@ -345,7 +363,17 @@ typedef LefParser::Parser::token_type token_type;
 (?i:PREFERENCLOSURE) {return token::K_PREFERENCLOSURE;}
 (?i:PRL) {return token::K_PRL;}
 (?i:PROPERTY) {return token::K_PROPERTY;}
-(?i:PROPERTYDEFINITIONS) {return token::K_PROPERTYDEFINITIONS;}
+(?i:PROPERTYDEFINITIONS) {
+    /* END PROPERTYDEFINITIONS is consumed by SKIPSECTION in skip mode */
+    if (m_skip & LEF_SKIP_PROPERTYDEFINITIONS)
+    {
+        m_skipEnd = "PROPERTYDEFINITIONS";
+        BEGIN(SKIPSECTION);
+        yylloc->step();
+    }
+    else
+        return token::K_PROPERTYDEFINITIONS;
+}
 (?i:PROTRUSIONWIDTH) {return token::K_PROTRUSIONWIDTH;}
 (?i:PULLDOWNRES) {return token::K_PULLDOWNRES;}
 (?i:PWL) {return token::K_PWL;}
@@ -465,12 +493,12 @@ typedef LefParser::Parser::token_type token_type;
 (?i:Y) {return token::K_Y;}
 
 [\+\-]?[0-9]+ {
-    yylval->integerVal = atoi(yytext);
+    limbo::from_chars(yytext, yytext+yyleng, yylval->integerVal);
     return token::INTEGER;
 }
 
 [\+\-]?[0-9]+("."[0-9]*)?([eE][\+\-]?[0-9]+)? {
-    yylval->doubleVal = atof(yytext);
+    limbo::from_chars(yytext, yytext+yyleng, yylval->doubleVal);
     return token::DOUBLE;
 }
 
@@ -489,6 +517,31 @@ typedef LefParser::Parser::token_type token_type;
     return token::QSTRING;
 }
 
+ /* fast-forward skipped sections without tokens */
+<SKIPSECTION>(?i:END)[ \t\r\n]+[A-Za-z]+ {
+    count_lines(yylloc);
+    if (is_skip_end())
+        BEGIN(INITIAL);
+    yylloc->step();
+}
+<SKIPSECTION>[^ \t\r\n#"]+ {
+    yylloc->step();
+}
+<SKIPSECTION>[ \t\r\n]+ {
+    count_lines(yylloc);
+    yylloc->step();
+}
+<SKIPSECTION>"#"([^\n])* {
+    yylloc->step();
+}
+<SKIPSECTION>\"([^"])*\" {
+    count_lines(yylloc);
+    yylloc->step();
+}
+<SKIPSECTION>. {
+    yylloc->step();
+}
+
  /* gobble up comments */
 "#"([^\n])* {
     yylloc->step();
@@ -518,8 +571,32 @@ namespace LefParser {
 
 Scanner::Scanner(std::istream* in,
 		 std::ostream* out)
-    : LefParserFlexLexer(in, out)
+    : LefParserFlexLexer(in, out),
+      m_skip(LEF_SKIP_NONE),
+      m_skipEnd(NULL)
+{
+}
+
+void Scanner::count_lines(Parser::location_type* yylloc)
+{
+    int lines = std::count(yytext, yytext+yyleng, '\n');
+    if (lines)
+    {
+        const char* last = yytext+yyleng;
+        while (last[-1] != '\n')
+            --last;
+        yylloc->lines(lines);
+        yylloc->columns(yytext+yyleng-last);
+    }
+}
+
+bool Scanner::is_skip_end() const
 {
+    // keywords are case insensitive 
+    std::size_t n = strlen(m_skipEnd);
+    const char* word = yytext+yyleng-n;
+    return (std::size_t)yyleng > n+3 && strncasecmp(word, m_skipEnd, n) == 0
+        && strchr(" \t\r\n", word[-1]);
 }
 
 Scanner::~Scanner()
@@ -0,0 +1,293 @@
+/**
+ * @file   LefShapes.cc
+ * @brief  flattened rectangles of pins and obstructions of LEF macros
+ * @date   Oct 2026
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <limbo/parsers/lef/bison/LefShapes.h>
+#include <limbo/geometry/Polygon2Rectangle.h>
+
+namespace LefParser {
+
+/// @brief point of polygons in database units
+struct LefShapePoint
+{
+    int x; ///< x coordinate
+    int y; ///< y coordinate
+};
+
+} // namespace LefParser
+
+namespace limbo { namespace geometry {
+
+/// @brief traits of @ref LefParser::LefShapePoint for @ref limbo::geometry::Polygon2Rectangle
+template <>
+struct point_traits<LefParser::LefShapePoint>
+{
+    /// @nowarn
+    typedef LefParser::LefShapePoint point_type;
+    typedef int coordinate_type;
+    /// @endnowarn
+
+    /// @brief get coordinate
+	static coordinate_type get(point_type const& p, orientation_2d orient)
+	{return (orient == HORIZONTAL)? p.x : p.y;}
+    /// @brief set coordinate
+	static void set(point_type& p, orientation_2d orient, coordinate_type v)
+	{if (orient == HORIZONTAL) p.x = v; else p.y = v;}
+    /// @brief construct a point
+	static point_type construct(coordinate_type x, coordinate_type y)
+	{
+        point_type p;
+        p.x = x;
+        p.y = y;
+        return p;
+    }
+};
+
+/// @brief traits of @ref LefParser::LefShapeRect for @ref limbo::geometry::Polygon2Rectangle
+template <>
+struct rectangle_traits<LefParser::LefShapeRect>
+{
+    /// @nowarn
+    typedef LefParser::LefShapeRect rectangle_type;
+    typedef int coordinate_type;
+    /// @endnowarn
+
+    /// @brief get coordinate
+	static coordinate_type get(rectangle_type const& r, direction_2d dir)
+	{
+        switch (dir)
+        {
+            case LEFT: return r.xl;
+            case BOTTOM: return r.yl;
+            case RIGHT: return r.xh;
+            case TOP: return r.yh;
+            default: limboAssert(0); return 0;
+        }
+    }
+    /// @brief set coordinate
+	static void set(rectangle_type& r, direction_2d dir, coordinate_type v)
+	{
+        switch (dir)
+        {
+            case LEFT: r.xl = v; break;
+            case BOTTOM: r.yl = v; break;
+            case RIGHT: r.xh = v; break;
+            case TOP: r.yh = v; break;
+            default: limboAssert(0);
+        }
+    }
+    /// @brief construct a rectangle without layer
+	static rectangle_type construct(coordinate_type xl, coordinate_type yl, coordinate_type xh, coordinate_type yh)
+	{
+        rectangle_type r;
+        r.layer = -1;
+        r.xl = xl;
+        r.yl = yl;
+        r.xh = xh;
+        r.yh = yh;
+        return r;
+    }
+};
+
+}} // namespace limbo // namespace geometry
+
+namespace LefParser {
+
+/// @brief append a rectangle with normalized corners
+static void lef_shape_append(vector<LefShapeRect>& vRect, int layer, int x1, int y1, int x2, int y2)
+{
+    LefShapeRect r;
+    r.layer = layer;
+    r.xl = std::min(x1, x2);
+    r.yl = std::min(y1, y2);
+    r.xh = std::max(x1, x2);
+    r.yh = std::max(y1, y2);
+    vRect.push_back(r);
+}
+
+void LefMacroShapes::clear()
+{
+    name.clear();
+    vPinName.clear();
+    vPinBegin.clear();
+    vPinRect.clear();
+    vObsRect.clear();
+}
+
+int LefShapeExtractor::layer_id(string const& name)
+{
+    std::map<string, int>::iterator found = m_mLayerName2Id.find(name);
+    if (found != m_mLayerName2Id.end())
+        return found->second;
+    int id = m_vLayerName.size();
+    m_mLayerName2Id.insert(std::make_pair(name, id));
+    m_vLayerName.push_back(name);
+    return id;
+}
+
+int LefShapeExtractor::to_dbu(double v) const
+{
+    return (int)std::floor(v*m_dbu + 0.5);
+}
+
+bool LefShapeExtractor::extract(lefiMacro const& macro, LefMacroShapes& shapes)
+{
+    bool flag = true;
+    shapes.clear();
+    shapes.name = macro.name();
+    shapes.vPinName.reserve(macro.numPins());
+    shapes.vPinBegin.reserve(macro.numPins()+1);
+    for (int i = 0; i < macro.numPins(); ++i)
+    {
+        lefiPin const* pin = macro.pin(i);
+        shapes.vPinName.push_back(pin->name());
+        shapes.vPinBegin.push_back(shapes.vPinRect.size());
+        for (int j = 0; j < pin->numPorts(); ++j)
+            flag &= extract(*pin->port(j), shapes.vPinRect);
+    }
+    shapes.vPinBegin.push_back(shapes.vPinRect.size());
+    for (vector<lefiObstruction*>::const_iterator it = macro.obstructions().begin(); it != macro.obstructions().end(); ++it)
+    {
+        if ((*it)->geometries())
+            flag &= extract(*(*it)->geometries(), shapes.vObsRect);
+    }
+    return flag;
+}
+
+bool LefShapeExtractor::extract(lefiGeometries const& geometries, vector<LefShapeRect>& vRect)
+{
+    bool flag = true;
+    int layer = -1;
+    int width = 0;
+    vector<LefShapePoint> vPoint;
+    vector<LefShapeRect> vPolygonRect;
+
+    for (int i = 0; i < geometries.numItems(); ++i)
+    {
+        // shapes of this item are appended from index begin, and copied by step patterns of ITERATE forms
+        std::size_t begin = vRect.size();
+        double numX = 1, numY = 1, stepX = 0, stepY = 0;
+        int numPoints = 0;
+        double const* vx = NULL;
+        double const* vy = NULL;
+        bool polygon = false;
+
+        switch (geometries.itemType(i))
+        {
+            case lefiGeomLayerE:
+                layer = layer_id(geometries.getLayer(i));
+                width = 0;
+                continue;
+            case lefiGeomWidthE:
+                width = to_dbu(geometries.getWidth(i));
+                continue;
+            case lefiGeomRectE:
+            {
+                lefiGeomRect const* r = geometries.getRect(i);
+                lef_shape_append(vRect, layer, to_dbu(r->xl), to_dbu(r->yl), to_dbu(r->xh), to_dbu(r->yh));
+                break;
+            }
+            case lefiGeomRectIterE:
+            {
+                lefiGeomRectIter const* r = geometries.getRectIter(i);
+                lef_shape_append(vRect, layer, to_dbu(r->xl), to_dbu(r->yl), to_dbu(r->xh), to_dbu(r->yh));
+                numX = r->xStart; numY = r->yStart; stepX = r->xStep; stepY = r->yStep;
+                break;
+            }
+            case lefiGeomPathE:
+            {
+                lefiGeomPath const* p = geometries.getPath(i);
+                numPoints = p->numPoints; vx = p->x; vy = p->y;
+                break;
+            }
+            case lefiGeomPathIterE:
+            {
+                lefiGeomPathIter const* p = geometries.getPathIter(i);
+                numPoints = p->numPoints; vx = p->x; vy = p->y;
+                numX = p->xStart; numY = p->yStart; stepX = p->xStep; stepY = p->yStep;
+                break;
+            }
+            case lefiGeomPolygonE:
+            {
+                lefiGeomPolygon const* p = geometries.getPolygon(i);
+                numPoints = p->numPoints; vx = p->x; vy = p->y;
+                polygon = true;
+                break;
+            }
+            case lefiGeomPolygonIterE:
+            {
+                lefiGeomPolygonIter const* p = geometries.getPolygonIter(i);
+                numPoints = p->numPoints; vx = p->x; vy = p->y;
+                numX = p->xStart; numY = p->yStart; stepX = p->xStep; stepY = p->yStep;
+                polygon = true;
+                break;
+            }
+            default:
+                continue;
+        }
+
+        if (polygon)
+        {
+            vPoint.resize(numPoints);
+            for (int k = 0; k < numPoints; ++k)
+            {
+                vPoint[k].x = to_dbu(vx[k]);
+                vPoint[k].y = to_dbu(vy[k]);
+            }
+            bool rectilinear = (numPoints >= 4);
+            for (int k = 0; k < numPoints && rectilinear; ++k)
+            {
+                LefShapePoint const& p1 = vPoint[k];
+                LefShapePoint const& p2 = vPoint[(k+1) % numPoints];
+                rectilinear = (p1.x == p2.x || p1.y == p2.y);
+            }
+            vPolygonRect.clear();
+            if (!rectilinear || !limbo::geometry::polygon2rectangle(vPoint.begin(), vPoint.end(), vector<LefShapePoint>(), vPolygonRect))
+            {
+                cout << "LEF polygon on layer " << ((layer < 0)? string("") : m_vLayerName[layer]) << " is not rectilinear, skipped" << endl;
+                flag = false;
+                continue;
+            }
+            for (vector<LefShapeRect>::const_iterator it = vPolygonRect.begin(); it != vPolygonRect.end(); ++it)
+                lef_shape_append(vRect, layer, it->xl, it->yl, it->xh, it->yh);
+        }
+        else if (vx) // path
+        {
+            if (width <= 0)
+                continue;
+            int hw = width/2;
+            if (numPoints == 1)
+                lef_shape_append(vRect, layer, to_dbu(vx[0])-hw, to_dbu(vy[0])-hw, to_dbu(vx[0])+hw, to_dbu(vy[0])+hw);
+            for (int k = 1; k < numPoints; ++k)
+            {
+                int x1 = to_dbu(vx[k-1]), y1 = to_dbu(vy[k-1]);
+                int x2 = to_dbu(vx[k]), y2 = to_dbu(vy[k]);
+                lef_shape_append(vRect, layer, std::min(x1, x2)-hw, std::min(y1, y2)-hw, std::max(x1, x2)+hw, std::max(y1, y2)+hw);
+            }
+        }
+
+        // copy shapes for ITERATE forms
+        std::size_t end = vRect.size();
+        int dx = to_dbu(stepX), dy = to_dbu(stepY);
+        for (int iy = 0; iy < (int)numY; ++iy)
+            for (int ix = 0; ix < (int)numX; ++ix)
+            {
+                if (ix == 0 && iy == 0)
+                    continue;
+                for (std::size_t k = begin; k < end; ++k)
+                {
+                    LefShapeRect r = vRect[k];
+                    r.xl += ix*dx; r.xh += ix*dx;
+                    r.yl += iy*dy; r.yh += iy*dy;
+                    vRect.push_back(r);
+                }
+            }
+    }
+    return flag;
+}
+
+} // namespace LefParser
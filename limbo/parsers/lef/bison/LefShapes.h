@@ -0,0 +1,91 @@
+/**
+ * @file   LefShapes.h
+ * @brief  flattened rectangles of pins and obstructions of LEF macros, see @ref LefParser::LefShapeExtractor
+ * @date   Oct 2026
+ */
+
+#ifndef LEFPARSER_SHAPES_H
+#define LEFPARSER_SHAPES_H
+
+#include <map>
+#include <limbo/parsers/lef/bison/LefDataBase.h>
+
+/** @brief namespace for LefParser */
+namespace LefParser {
+
+/// @brief rectangle on a layer in database units, relative to the macro origin
+struct LefShapeRect
+{
+    int layer; ///< dense layer id from @ref LefParser::LefShapeExtractor
+    int xl; ///< lower left x
+    int yl; ///< lower left y
+    int xh; ///< upper right x
+    int yh; ///< upper right y
+};
+
+/// @brief rectangles of a macro in contiguous tables.
+/// Rectangles of pin i are vPinRect[vPinBegin[i]] to vPinRect[vPinBegin[i+1]-1].
+struct LefMacroShapes
+{
+    string name; ///< macro name
+    vector<string> vPinName; ///< pin names
+    vector<unsigned> vPinBegin; ///< offset of the rectangles of each pin, with one more entry for the end
+    vector<LefShapeRect> vPinRect; ///< rectangles of all pins
+    vector<LefShapeRect> vObsRect; ///< rectangles of obstructions
+
+    /// @return number of pins
+    unsigned num_pins() const {return vPinName.size();}
+    /// @brief remove all pins and rectangles, buffers are kept
+    void clear();
+};
+
+/// @class LefParser::LefShapeExtractor
+/// @brief convert the geometries of @ref LefParser::lefiMacro to rectangles, e.g., in @ref LefParser::LefDataBase::lef_macro_cbk.
+///
+/// RECT, PATH and POLYGON statements, including their ITERATE forms, become rectangles on the current LAYER.
+/// Polygons are decomposed by @ref limbo::geometry::Polygon2Rectangle, and paths become one rectangle per segment,
+/// extended by half width at both ends; paths without WIDTH statements are skipped, as they use default widths of layers.
+/// VIA statements are not expanded because via definitions are separate from macros.
+/// Layer names are mapped to dense ids in the order they are seen, or in the order of @ref LefParser::LefShapeExtractor::layer_id calls,
+/// e.g., from @ref LefParser::LefDataBase::lef_layer_cbk.
+class LefShapeExtractor
+{
+	public:
+        /// @brief constructor
+        /// @param dbu database units per micron, e.g., DATABASE MICRONS in UNITS
+        LefShapeExtractor(int dbu = 1000) : m_dbu(dbu) {}
+
+        /// @brief set database units per micron
+        void set_dbu(int dbu) {m_dbu = dbu;}
+        /// @return database units per micron
+        int dbu() const {return m_dbu;}
+        /// @brief find or add a layer
+        /// @param name layer name
+        /// @return dense id of the layer
+        int layer_id(string const& name);
+        /// @return names of layers indexed by ids
+        vector<string> const& layer_names() const {return m_vLayerName;}
+
+        /// @brief extract rectangles of a macro
+        /// @param macro macro from the parser
+        /// @param shapes output, old contents are removed
+        /// @return false if some polygons are not rectilinear, which are skipped
+        bool extract(lefiMacro const& macro, LefMacroShapes& shapes);
+        /// @brief append rectangles of geometries
+        /// @param geometries a port or obstruction
+        /// @param vRect output rectangles
+        /// @return false if some polygons are not rectilinear, which are skipped
+        bool extract(lefiGeometries const& geometries, vector<LefShapeRect>& vRect);
+
+	protected:
+        /// @brief convert microns to database units
+        int to_dbu(double v) const;
+
+        int m_dbu; ///< database units per micron
+        std::map<string, int> m_mLayerName2Id; ///< map from layer names to ids
+        vector<string> m_vLayerName; ///< layer names
+};
+
+} // namespace LefParser
+
+#endif
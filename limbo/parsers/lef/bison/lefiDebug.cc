@@ -105,8 +105,9 @@ static char lefiShift [] = {
 
 
 const char* lefUpperCase(const char* str) {
-  static char* shiftBuf = 0;
-  static int shiftBufLength = 0;
+  // one buffer per thread for drivers in different threads 
+  static __thread char* shiftBuf = 0;
+  static __thread int shiftBufLength = 0;
   char* place = (char*)str;
   char* to;
   int len = strlen(str) + 1;
@@ -14,6 +14,7 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <algorithm>
 //#include "lex.h"
 #include <limbo/parsers/lef/bison/lefiMacro.hpp>
 #include <limbo/parsers/lef/bison/lefiMisc.hpp>
@@ -619,6 +620,16 @@ lefiPin::lefiPin(lefiPin const& rhs)
 }
 
 
+// lefiPin only holds scalars, fixed arrays and owned pointers, 
+// so exchanging the bytes of two pins exchanges their contents 
+void lefiPin::swap(lefiPin& rhs) {
+  char tmp[sizeof(lefiPin)];
+  memcpy(tmp, (void*)this, sizeof(lefiPin));
+  memcpy((void*)this, (void*)&rhs, sizeof(lefiPin));
+  memcpy((void*)&rhs, tmp, sizeof(lefiPin));
+}
+
+
 void lefiPin::Init() {
   this->nameSize_ = 16;
   this->name_ = (char*)lefMalloc(16);
@@ -2446,6 +2457,10 @@ void lefiMacro::Init() {
 
 void lefiMacro::Destroy() {
   this->lefiMacro::clear();
+  for (std::vector<lefiPin*>::iterator it = m_vPinPool.begin();
+		  it != m_vPinPool.end(); ++it)
+	  delete *it;
+  m_vPinPool.clear();
   lefFree(this->name_);
   lefFree(this->generator_);
   lefFree(this->EEQ_);
@@ -2518,10 +2533,13 @@ void lefiMacro::clear() {
   }
   this->numProperties_ = 0;
 
-  // remove pins 
+  // remove pins, keep them with their buffers for later macros 
   for (std::vector<lefiPin*>::iterator it = m_vPin.begin();
 		  it != m_vPin.end(); ++it)
-	  delete *it;
+  {
+	  (*it)->clear();
+	  m_vPinPool.push_back(*it);
+  }
   m_vPin.clear();
 
   // remove Obstruction 
@@ -3098,6 +3116,81 @@ void lefiMacro::addPin(lefiPin const& p)
 	m_vPin.push_back(new lefiPin (p));
 }
 
+void lefiMacro::takePin(lefiPin& p)
+{
+	lefiPin* pin;
+	if (m_vPinPool.empty())
+		pin = new lefiPin ();
+	else 
+	{
+		pin = m_vPinPool.back();
+		m_vPinPool.pop_back();
+	}
+	pin->swap(p);
+	m_vPin.push_back(pin);
+}
+
+void lefiMacro::swap(lefiMacro& rhs)
+{
+	std::swap(this->nameSize_, rhs.nameSize_);
+	std::swap(this->name_, rhs.name_);
+	std::swap_ranges(this->macroClass_, this->macroClass_+sizeof(this->macroClass_), rhs.macroClass_);
+	std::swap_ranges(this->source_, this->source_+sizeof(this->source_), rhs.source_);
+	std::swap(this->generatorSize_, rhs.generatorSize_);
+	std::swap(this->generator_, rhs.generator_);
+	std::swap(this->hasClass_, rhs.hasClass_);
+	std::swap(this->hasGenerator_, rhs.hasGenerator_);
+	std::swap(this->hasGenerate_, rhs.hasGenerate_);
+	std::swap(this->hasPower_, rhs.hasPower_);
+	std::swap(this->hasOrigin_, rhs.hasOrigin_);
+	std::swap(this->hasSource_, rhs.hasSource_);
+	std::swap(this->hasEEQ_, rhs.hasEEQ_);
+	std::swap(this->hasLEQ_, rhs.hasLEQ_);
+	std::swap(this->hasSymmetry_, rhs.hasSymmetry_);
+	std::swap(this->hasSiteName_, rhs.hasSiteName_);
+	std::swap(this->hasSize_, rhs.hasSize_);
+	std::swap(this->hasClockType_, rhs.hasClockType_);
+	std::swap(this->isBuffer_, rhs.isBuffer_);
+	std::swap(this->isInverter_, rhs.isInverter_);
+	std::swap(this->EEQ_, rhs.EEQ_);
+	std::swap(this->EEQSize_, rhs.EEQSize_);
+	std::swap(this->LEQ_, rhs.LEQ_);
+	std::swap(this->LEQSize_, rhs.LEQSize_);
+	std::swap(this->gen1_, rhs.gen1_);
+	std::swap(this->gen1Size_, rhs.gen1Size_);
+	std::swap(this->gen2_, rhs.gen2_);
+	std::swap(this->gen2Size_, rhs.gen2Size_);
+	std::swap(this->power_, rhs.power_);
+	std::swap(this->originX_, rhs.originX_);
+	std::swap(this->originY_, rhs.originY_);
+	std::swap(this->sizeX_, rhs.sizeX_);
+	std::swap(this->sizeY_, rhs.sizeY_);
+	std::swap(this->numSites_, rhs.numSites_);
+	std::swap(this->sitesAllocated_, rhs.sitesAllocated_);
+	std::swap(this->pattern_, rhs.pattern_);
+	std::swap(this->numForeigns_, rhs.numForeigns_);
+	std::swap(this->foreignAllocated_, rhs.foreignAllocated_);
+	std::swap(this->hasForeignOrigin_, rhs.hasForeignOrigin_);
+	std::swap(this->hasForeignPoint_, rhs.hasForeignPoint_);
+	std::swap(this->foreignOrient_, rhs.foreignOrient_);
+	std::swap(this->foreignX_, rhs.foreignX_);
+	std::swap(this->foreignY_, rhs.foreignY_);
+	std::swap(this->foreign_, rhs.foreign_);
+	std::swap(this->siteNameSize_, rhs.siteNameSize_);
+	std::swap(this->siteName_, rhs.siteName_);
+	std::swap(this->clockType_, rhs.clockType_);
+	std::swap(this->clockTypeSize_, rhs.clockTypeSize_);
+	std::swap(this->numProperties_, rhs.numProperties_);
+	std::swap(this->propertiesAllocated_, rhs.propertiesAllocated_);
+	std::swap(this->propNames_, rhs.propNames_);
+	std::swap(this->propValues_, rhs.propValues_);
+	std::swap(this->propNums_, rhs.propNums_);
+	std::swap(this->propTypes_, rhs.propTypes_);
+	m_vPin.swap(rhs.m_vPin);
+	m_vPinPool.swap(rhs.m_vPinPool);
+	m_vObs.swap(rhs.m_vObs);
+}
+
 
 const char* lefiMacro::clockType() const {
   return this->clockType_;
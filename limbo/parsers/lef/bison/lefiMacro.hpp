@@ -121,6 +121,8 @@ public:
   lefiPin(lefiPin const& rhs); // copy constructor 
   void Init();
   void copy(lefiPin const& rhs);
+  // swap with a lefiPin, no memory is allocated
+  void swap(lefiPin& rhs);
 
   void Destroy();
   ~lefiPin();
@@ -581,6 +583,12 @@ public:
   int numPins() const;
   lefiPin* pin(unsigned int index) const;
   void addPin(lefiPin const& p);
+  // move a pin into the macro and leave p cleared, 
+  // pins removed by clear() are reused 
+  void takePin(lefiPin& p);
+  // swap with a lefiMacro, no memory is allocated, 
+  // e.g., to keep a parsed macro while the parser reuses its own 
+  void swap(lefiMacro& rhs);
 
   // for obstructions in a macro 
   std::vector<lefiObstruction*> const& obstructions() const {return m_vObs;}
@@ -654,6 +662,7 @@ protected:
   char*  propTypes_;
 
   std::vector<lefiPin*> m_vPin; ///< save pins in macro 
+  std::vector<lefiPin*> m_vPinPool; ///< cleared pins reused by takePin 
   std::vector<lefiObstruction*> m_vObs; ///< obstructions 
 };
 
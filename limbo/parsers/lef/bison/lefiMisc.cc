@@ -229,6 +229,80 @@ lefiGeomViaIter::~lefiGeomViaIter()
 ////////////////////////////////////////////
 
 
+// Fixed-size geometry items are created for every shape of every port and
+// freed when the macro is cleared.  They are recycled through free lists per
+// size class instead of malloc/free, so the memory of the items is bounded by
+// the largest macro rather than the whole library.  Polygons may be taken over
+// by vias (lefiViaLayer::addPoly), so they are still allocated by lefMalloc.
+// The free lists and chunks are kept per thread, so drivers in different
+// threads never lock them.  An item freed by another thread joins the free
+// list of that thread, which is fine as chunks are never released.
+
+/// @brief free item linked through its first bytes
+struct lefiGeomFreeItem {
+  lefiGeomFreeItem* next;
+};
+
+static const size_t lefiGeomItemAlign = sizeof(double);
+static const size_t lefiGeomNumItemClasses = 8; // items up to 64 bytes
+static const size_t lefiGeomItemChunkSize = 64*1024;
+
+static __thread lefiGeomFreeItem* lefiGeomFreeItems[lefiGeomNumItemClasses+1];
+static __thread char* lefiGeomChunk = 0;     // current chunk, linked to the previous one by its first bytes
+static __thread size_t lefiGeomChunkUsed = 0; // bytes used in the current chunk
+
+static size_t lefiGeomItemClass(enum lefiGeomEnum e) {
+  size_t size;
+  switch (e) {
+    case lefiGeomLayerExceptPgNetE: size = sizeof(int); break;
+    case lefiGeomLayerMinSpacingE:
+    case lefiGeomLayerRuleWidthE:
+    case lefiGeomWidthE: size = sizeof(double); break;
+    case lefiGeomPathE: size = sizeof(struct lefiGeomPath); break;
+    case lefiGeomPathIterE: size = sizeof(struct lefiGeomPathIter); break;
+    case lefiGeomRectE: size = sizeof(struct lefiGeomRect); break;
+    case lefiGeomRectIterE: size = sizeof(struct lefiGeomRectIter); break;
+    case lefiGeomViaE: size = sizeof(struct lefiGeomVia); break;
+    case lefiGeomViaIterE: size = sizeof(struct lefiGeomViaIter); break;
+    default: return 0; // strings and polygons
+  }
+  size = (size + lefiGeomItemAlign - 1) / lefiGeomItemAlign;
+  return (size <= lefiGeomNumItemClasses)? size : 0;
+}
+
+static void* lefiGeomItemMalloc(enum lefiGeomEnum e, size_t size) {
+  size_t c = lefiGeomItemClass(e);
+  if (c == 0)
+    return lefMalloc(size);
+  lefiGeomFreeItem* item = lefiGeomFreeItems[c];
+  if (item) {
+    lefiGeomFreeItems[c] = item->next;
+    return (void*)item;
+  }
+  size = c * lefiGeomItemAlign;
+  if (lefiGeomChunk == 0 || lefiGeomChunkUsed + size > lefiGeomItemChunkSize) {
+    char* chunk = (char*)lefMalloc(lefiGeomItemChunkSize);
+    *(char**)chunk = lefiGeomChunk;
+    lefiGeomChunk = chunk;
+    lefiGeomChunkUsed = lefiGeomItemAlign;
+  }
+  void* v = (void*)(lefiGeomChunk + lefiGeomChunkUsed);
+  lefiGeomChunkUsed += size;
+  return v;
+}
+
+static void lefiGeomItemFree(void* v, enum lefiGeomEnum e) {
+  size_t c = lefiGeomItemClass(e);
+  if (c == 0) {
+    lefFree(v);
+    return;
+  }
+  lefiGeomFreeItem* item = (lefiGeomFreeItem*)v;
+  item->next = lefiGeomFreeItems[c];
+  lefiGeomFreeItems[c] = item;
+}
+
+
 lefiGeometries::lefiGeometries() {
   this->lefiGeometries::Init();
 }
@@ -288,25 +362,25 @@ void lefiGeometries::copy(lefiGeometries const& rhs)
 				break;
 			case lefiGeomPathE:
 			{
-				lefiGeomPath* p = (lefiGeomPath*)lefMalloc(sizeof(lefiGeomPath)); p->copy(*rhs.getPath(i));
+				lefiGeomPath* p = (lefiGeomPath*)lefiGeomItemMalloc(lefiGeomPathE, sizeof(lefiGeomPath)); p->copy(*rhs.getPath(i));
 				this->lefiGeometries::add((void*)p, lefiGeomPathE);
 				break;
 			}
 			case lefiGeomPathIterE:
 			{
-				lefiGeomPathIter* p = (lefiGeomPathIter*)lefMalloc(sizeof(lefiGeomPathIter)); p->copy(*rhs.getPathIter(i));
+				lefiGeomPathIter* p = (lefiGeomPathIter*)lefiGeomItemMalloc(lefiGeomPathIterE, sizeof(lefiGeomPathIter)); p->copy(*rhs.getPathIter(i));
 				this->lefiGeometries::add((void*)p, lefiGeomPathIterE);
 				break;
 			}
 			case lefiGeomRectE:
 			{
-				lefiGeomRect* p = (lefiGeomRect*)lefMalloc(sizeof(lefiGeomRect)); p->copy(*rhs.getRect(i));
+				lefiGeomRect* p = (lefiGeomRect*)lefiGeomItemMalloc(lefiGeomRectE, sizeof(lefiGeomRect)); p->copy(*rhs.getRect(i));
 				this->lefiGeometries::add((void*)p, lefiGeomRectE);
 				break;
 			}
 			case lefiGeomRectIterE:
 			{
-				lefiGeomRectIter* p = (lefiGeomRectIter*)lefMalloc(sizeof(lefiGeomRectIter)); p->copy(*rhs.getRectIter(i));
+				lefiGeomRectIter* p = (lefiGeomRectIter*)lefiGeomItemMalloc(lefiGeomRectIterE, sizeof(lefiGeomRectIter)); p->copy(*rhs.getRectIter(i));
 				this->lefiGeometries::add((void*)p, lefiGeomRectIterE);
 				break;
 			}
@@ -324,13 +398,13 @@ void lefiGeometries::copy(lefiGeometries const& rhs)
 			}
 			case lefiGeomViaE:
 			{
-				lefiGeomVia* p = (lefiGeomVia*)lefMalloc(sizeof(lefiGeomVia)); p->copy(*rhs.getVia(i));
+				lefiGeomVia* p = (lefiGeomVia*)lefiGeomItemMalloc(lefiGeomViaE, sizeof(lefiGeomVia)); p->copy(*rhs.getVia(i));
 				this->lefiGeometries::add((void*)p, lefiGeomViaE);
 				break;
 			}
 			case lefiGeomViaIterE:
 			{
-				lefiGeomViaIter* p = (lefiGeomViaIter*)lefMalloc(sizeof(lefiGeomViaIter)); p->copy(*rhs.getViaIter(i));
+				lefiGeomViaIter* p = (lefiGeomViaIter*)lefiGeomItemMalloc(lefiGeomViaIterE, sizeof(lefiGeomViaIter)); p->copy(*rhs.getViaIter(i));
 				this->lefiGeometries::add((void*)p, lefiGeomViaIterE);
 				break;
 			}
@@ -388,7 +462,7 @@ void lefiGeometries::clear() {
        lefFree((double*)((struct lefiGeomPolygonIter*)this->items_[i])->x);
        lefFree((double*)((struct lefiGeomPolygonIter*)this->items_[i])->y);
      }
-     lefFree((char*)(this->items_[i]));
+     lefiGeomItemFree(this->items_[i], this->itemType_[i]);
    }
    this->numItems_ = 0;
 }
@@ -440,21 +514,21 @@ void lefiGeometries::addLayer(const char* name) {
 
 // 5.7
 void lefiGeometries::addLayerExceptPgNet() {
-  int* d = (int*)lefMalloc(sizeof(int));
+  int* d = (int*)lefiGeomItemMalloc(lefiGeomLayerExceptPgNetE, sizeof(int));
   *d = 1;
   this->lefiGeometries::add((void*)d, lefiGeomLayerExceptPgNetE);
 }
 
 
 void lefiGeometries::addLayerMinSpacing(double spacing) {
-  double* d = (double*)lefMalloc(sizeof(double));
+  double* d = (double*)lefiGeomItemMalloc(lefiGeomLayerMinSpacingE, sizeof(double));
   *d = spacing;
   this->lefiGeometries::add((void*)d, lefiGeomLayerMinSpacingE);
 }
 
 
 void lefiGeometries::addLayerRuleWidth(double width) {
-  double* d = (double*)lefMalloc(sizeof(double));
+  double* d = (double*)lefiGeomItemMalloc(lefiGeomLayerRuleWidthE, sizeof(double));
   *d = width;
   this->lefiGeometries::add((void*)d, lefiGeomLayerRuleWidthE);
 }
@@ -468,7 +542,7 @@ void lefiGeometries::addClass(const char* name) {
 
 
 void lefiGeometries::addWidth(double w) {
-  double* d = (double*)lefMalloc(sizeof(double));
+  double* d = (double*)lefiGeomItemMalloc(lefiGeomWidthE, sizeof(double));
   *d = w;
   this->lefiGeometries::add((void*)d, lefiGeomWidthE);
 }
@@ -477,8 +551,8 @@ void lefiGeometries::addWidth(double w) {
 void lefiGeometries::addPath() {
   int i;
   int lim;
-  struct lefiGeomPath* p = (struct lefiGeomPath*)lefMalloc(
-                 sizeof(struct lefiGeomPath));
+  struct lefiGeomPath* p = (struct lefiGeomPath*)lefiGeomItemMalloc(
+                 lefiGeomPathE, sizeof(struct lefiGeomPath));
   lim = p->numPoints = this->numPoints_;
   if (lim > 0) {
      p->x = (double*)lefMalloc(sizeof(double)*lim);
@@ -498,8 +572,8 @@ void lefiGeometries::addPath() {
 void lefiGeometries::addPathIter() {
   int i;
   int lim;
-  struct lefiGeomPathIter* p = (struct lefiGeomPathIter*)lefMalloc(
-                 sizeof(struct lefiGeomPathIter));
+  struct lefiGeomPathIter* p = (struct lefiGeomPathIter*)lefiGeomItemMalloc(
+                 lefiGeomPathIterE, sizeof(struct lefiGeomPathIter));
   lim = p->numPoints = this->numPoints_;
   if (lim > 0) {
      p->x = (double*)lefMalloc(sizeof(double)*lim);
@@ -522,8 +596,8 @@ void lefiGeometries::addPathIter() {
 
 /* pcr 481783 & 560504 */
 void lefiGeometries::addRect(double xl, double yl, double xh, double yh) {
-  struct lefiGeomRect* p = (struct lefiGeomRect*)lefMalloc(
-                 sizeof(struct lefiGeomRect));
+  struct lefiGeomRect* p = (struct lefiGeomRect*)lefiGeomItemMalloc(
+                 lefiGeomRectE, sizeof(struct lefiGeomRect));
   p->xl = xl;
   p->yl = yl;
   p->xh = xh;
@@ -534,8 +608,8 @@ void lefiGeometries::addRect(double xl, double yl, double xh, double yh) {
 
 void lefiGeometries::addRectIter(double xl, double yl,
                                  double xh, double yh) {
-  struct lefiGeomRectIter* p = (struct lefiGeomRectIter*)lefMalloc(
-                 sizeof(struct lefiGeomRectIter));
+  struct lefiGeomRectIter* p = (struct lefiGeomRectIter*)lefiGeomItemMalloc(
+                 lefiGeomRectIterE, sizeof(struct lefiGeomRectIter));
   p->xl = xl;
   p->yl = yl;
   p->xh = xh;
@@ -593,8 +667,8 @@ void lefiGeometries::addPolygonIter() {
 
 
 void lefiGeometries::addVia(double x, double y, const char* name) {
-  struct lefiGeomVia* p = (struct lefiGeomVia*)lefMalloc(
-                 sizeof(struct lefiGeomVia));
+  struct lefiGeomVia* p = (struct lefiGeomVia*)lefiGeomItemMalloc(
+                 lefiGeomViaE, sizeof(struct lefiGeomVia));
   char* c = (char*)lefMalloc(strlen(name)+1);
   strcpy(c, CASE(name));
   p->x = x;
@@ -605,8 +679,8 @@ void lefiGeometries::addVia(double x, double y, const char* name) {
 
 
 void lefiGeometries::addViaIter(double x, double y, const char* name) {
-  struct lefiGeomViaIter* p = (struct lefiGeomViaIter*)lefMalloc(
-                 sizeof(struct lefiGeomViaIter));
+  struct lefiGeomViaIter* p = (struct lefiGeomViaIter*)lefiGeomItemMalloc(
+                 lefiGeomViaIterE, sizeof(struct lefiGeomViaIter));
   char* c = (char*)lefMalloc(strlen(name)+1);
   strcpy(c, CASE(name));
   p->x = x;
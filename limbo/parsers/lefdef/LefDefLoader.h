@@ -0,0 +1,99 @@
+/**
+ * @file   LefDefLoader.h
+ * @brief  Read LEF files and a DEF file concurrently with the bison parsers.
+ *
+ * The LEF files, e.g., the technology LEF followed by the cell LEFs, are read one after another by a separate thread,
+ * while the DEF file is read by the calling thread, see @ref LefDefLoader::read.
+ * The LEF files themselves can be parsed by more threads with the last argument of @ref LefDefLoader::read,
+ * see the multi-file @ref LefParser::read for the order of callbacks in that case.
+ *
+ * Callbacks of the LEF database and the DEF database are called at the same time,
+ * so the two databases must not share data without synchronization.
+ * Binding components to macros is deferred: record the macro names in the DEF callbacks
+ * and resolve them after @ref LefDefLoader::read returns, when all macros are known.
+ *
+ * Link with lefparser, defparser and the thread library.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PARSERS_LEFDEF_LEFDEFLOADER_H
+#define LIMBO_PARSERS_LEFDEF_LEFDEFLOADER_H
+
+#include <pthread.h>
+#include <limbo/parsers/lef/bison/LefDriver.h>
+#include <limbo/parsers/def/bison/DefDriver.h>
+
+/// namespace for reading LEF and DEF together
+namespace LefDefLoader {
+
+/// @nowarn
+using std::string;
+using std::vector;
+/// @endnowarn
+
+/// @brief arguments and result of the thread reading LEF files
+struct LefTask
+{
+    LefParser::LefDataBase* db; ///< LEF database
+    vector<string> const* vLefFile; ///< LEF files in order
+    int numThreads; ///< number of threads for the LEF files
+    bool ok; ///< whether all LEF files are read successfully
+};
+
+/// @brief read the LEF files of a task in order, stop at the first failure
+/// @param task @ref LefDefLoader::LefTask
+inline void read_lef_task(LefTask& task)
+{
+    task.ok = LefParser::read(*task.db, *task.vLefFile, task.numThreads);
+    if (!task.ok)
+        std::cerr << "failed to read LEF files" << std::endl;
+}
+
+/// @brief thread entry of @ref LefDefLoader::read_lef_task
+/// @param arg pointer to @ref LefDefLoader::LefTask
+/// @return NULL
+inline void* read_lef_thread(void* arg)
+{
+    read_lef_task(*static_cast<LefTask*>(arg));
+    return NULL;
+}
+
+/// @brief API for LefDefLoader.
+/// Read LEF files in a separate thread and the DEF file in the current thread at the same time.
+/// Returns after both are done, so the DEF components can be bound to LEF macros afterwards.
+/// If the thread cannot be created, the LEF files are read before the DEF file.
+/// @param lefDb database which is derived from @ref LefParser::LefDataBase
+/// @param vLefFile LEF files, read in this order, e.g., technology LEF first
+/// @param defDb database which is derived from @ref DefParser::DefDataBase
+/// @param defFile DEF file
+/// @param defThreads number of threads for the DEF file, see @ref DefParser::read
+/// @param lefThreads number of threads for the LEF files, see @ref LefParser::read
+/// @return true if all files are read successfully
+inline bool read(LefParser::LefDataBase& lefDb, vector<string> const& vLefFile,
+        DefParser::DefDataBase& defDb, string const& defFile, int defThreads = 1, int lefThreads = 1)
+{
+    LefTask task;
+    task.db = &lefDb;
+    task.vLefFile = &vLefFile;
+    task.numThreads = lefThreads;
+    task.ok = false;
+
+    pthread_t thread;
+    bool created = (pthread_create(&thread, NULL, read_lef_thread, &task) == 0);
+    if (!created)
+        read_lef_task(task);
+
+    bool defOk = DefParser::read(defDb, defFile, defThreads);
+    if (!defOk)
+        std::cerr << "failed to read DEF file " << defFile << std::endl;
+
+    if (created)
+        pthread_join(thread, NULL);
+
+    return task.ok && defOk;
+}
+
+} // namespace LefDefLoader
+
+#endif
@@ -104,6 +104,38 @@ struct Term
 /// @brief array of terms 
 typedef std::vector<Term> TermArray; 
 
+/// @brief LP problem in arrays, where variables are indexed in the order of appearance 
+/// and constraints are kept in compressed sparse row (CSR) format with zero-based indices. 
+/// It is filled by @ref LpParser::read(LpSparseModel&, string const&) without callbacks. 
+struct LpSparseModel
+{
+    bool minimize; ///< true for minimizing objective, false for maximizing 
+
+    vector<string> vVariableName; ///< variable names 
+    vector<double> vLowerBound; ///< lower bounds of variables 
+    vector<double> vUpperBound; ///< upper bounds of variables 
+    vector<char> vVariableType; ///< 'C' for continuous, 'I' for integer, 'B' for binary variables 
+
+    vector<int> vObjColumn; ///< variables of objective terms 
+    vector<double> vObjElement; ///< coefficients of objective terms 
+
+    vector<int> vRowBegin; ///< first term of each constraint, with one more entry for the end 
+    vector<int> vColumn; ///< variables of constraint terms 
+    vector<double> vElement; ///< coefficients of constraint terms 
+    vector<char> vSense; ///< '<', '>' or '=' of constraints 
+    vector<double> vRhs; ///< right hand side of constraints 
+    vector<string> vConstraintName; ///< constraint names, empty if not named 
+
+    /// @brief constructor 
+    LpSparseModel() : minimize(true) {}
+    /// @return number of variables 
+    unsigned num_variables() const {return vVariableName.size();}
+    /// @return number of constraints 
+    unsigned num_constraints() const {return vSense.size();}
+    /// @brief remove all variables and constraints 
+    void clear();
+};
+
 // temporary data structures to hold parsed data 
 
 // forward declaration
@@ -8,18 +8,25 @@
 #include <limits>
 #include "LpDriver.h"
 #include "LpScanner.h"
+#include <limbo/parsers/common/PrefetchInputStream.h>
+#if ZLIB == 1
+#include <limbo/parsers/common/GzipInputStream.h>
+#endif
+#include <limbo/preprocessor/Instrument.h>
 
 namespace LpParser {
 
 Driver::Driver(LpDataBase& db)
     : trace_scanning(false),
       trace_parsing(false),
+      profile("LpParser"),
       m_db(db)
 {
 }
 
 bool Driver::parse_stream(std::istream& in, const std::string& sname)
 {
+    limboParserParse(profile);
     streamname = sname;
 
     Scanner scanner(&in);
@@ -33,7 +40,15 @@ bool Driver::parse_stream(std::istream& in, const std::string& sname)
 
 bool Driver::parse_file(const std::string &filename)
 {
-    std::ifstream in(filename.c_str());
+#if ZLIB == 1
+    if (limbo::is_gzip_file(filename)) // inflated by a helper thread 
+    {
+        limbo::GzipInputStream in (filename);
+        if (!in.good()) return false;
+        return parse_stream(in, filename);
+    }
+#endif
+    limbo::PrefetchInputStream in (filename); // read ahead by a helper thread 
     if (!in.good()) return false;
     return parse_stream(in, filename);
 }
@@ -58,19 +73,26 @@ void Driver::error(const std::string& m)
 // sum coef*var compare_op constant 
 void Driver::obj_cbk(bool minimize, TermArray const& terms) 
 {
+    limboParserRecord(profile, "objective");
+    limboParserCallback(profile);
     m_db.add_objective(minimize, terms); 
 }
 void Driver::constraint_cbk(TermArray& terms, char compare, double constant)
 {
+    limboParserRecord(profile, "constraints");
+    limboParserCallback(profile);
     m_db.add_constraint("", terms, compare, constant); 
 }
 void Driver::constraint_cbk(string const& name, TermArray& terms, char compare, double constant)
 {
+    limboParserRecord(profile, "constraints");
+    limboParserCallback(profile);
     m_db.add_constraint(name, terms, compare, constant); 
 }
 // var compare_op constant 
 void Driver::bound_cbk(string const& var, char compare, double constant)
 {
+    limboParserRecord(profile, "bounds");
     double lb = limbo::lowest<double>(); 
     double ub = std::numeric_limits<double>::max(); 
 
@@ -86,11 +108,13 @@ void Driver::bound_cbk(string const& var, char compare, double constant)
         default:
             lb = ub = constant; 
     }
+    limboParserCallback(profile);
     m_db.add_variable(var, lb, ub);
 }
 // constant compare_op var
 void Driver::bound_cbk(double constant, char compare, string const& var) 
 {
+    limboParserRecord(profile, "bounds");
     double lb = limbo::lowest<double>(); 
     double ub = std::numeric_limits<double>::max(); 
 
@@ -107,11 +131,13 @@ void Driver::bound_cbk(double constant, char compare, string const& var)
             lb = ub = constant; 
             break; 
     }
+    limboParserCallback(profile);
     m_db.add_variable(var, lb, ub);
 }
 // constant1 compare_op1 var compare_op2 constant2 
 void Driver::bound_cbk(double constant1, char compare1, string const& var, char compare2, double constant2)
 {
+    limboParserRecord(profile, "bounds");
     double lb = limbo::lowest<double>(); 
     double ub = std::numeric_limits<double>::max(); 
 
@@ -142,23 +168,30 @@ void Driver::bound_cbk(double constant1, char compare1, string const& var, char
             lb = ub = constant2; 
             break; 
     }
+    limboParserCallback(profile);
     m_db.add_variable(var, lb, ub);
 }
 // generals type (integer)
 void Driver::generals_cbk(StringArray const& vIntegerVar)
 {
+    limboParserRecord(profile, "generals");
+    limboParserCallback(profile);
     for (StringArray::const_iterator it = vIntegerVar.begin(); it != vIntegerVar.end(); ++it)
         m_db.set_integer(*it, false);
 }
 // binary type  
 void Driver::binary_cbk(StringArray const& vIntegerVar)
 {
+    limboParserRecord(profile, "binary");
+    limboParserCallback(profile);
     for (StringArray::const_iterator it = vIntegerVar.begin(); it != vIntegerVar.end(); ++it)
         m_db.set_integer(*it, true);
 }
 
 bool read(LpDataBase& db, const string& lpFile)
 {
+	limboScopedTimer("LpParser::read");
+	limboScopedAllocations("LpParser::read");
 	Driver driver (db);
 	//driver.trace_scanning = true;
 	//driver.trace_parsing = true;
@@ -9,6 +9,7 @@
 #define LPPARSER_DRIVER_H
 
 #include "LpDataBase.h"
+#include <limbo/parsers/common/ParserProfile.h>
 
 /** The example namespace is used to encapsulate the three parser classes
  * example::Parser, example::Scanner and example::Driver */
@@ -87,6 +88,11 @@ public:
      * parser to the scanner. It is used in the yylex macro. */
     class Scanner* lexer;
 
+    /** Counters and timers of the scanner, grammar actions and database
+     * callbacks, compiled out unless LIMBO_INSTRUMENT is defined. It is used
+     * in the yylex macro. */
+    limbo::ParserProfile profile;
+
     /** Reference to the database filled during parsing of the
      * expressions. */
     LpDataBase& m_db;
@@ -118,6 +124,16 @@ protected:
 /// @param lpFile LP file 
 bool read(LpDataBase& db, const string& lpFile);
 
+/// @brief API for LpParser without callbacks. 
+/// Read LP file with a hand-written scanner in two passes over the file in memory: 
+/// the first pass counts constraints and terms to reserve arrays, 
+/// and the second pass fills the arrays with variable names interned into indices. 
+/// It accepts the same syntax as @ref LpParser::Driver. 
+/// @param model output model, old contents are removed 
+/// @param lpFile LP file 
+/// @return true if succeed 
+bool read(LpSparseModel& model, const string& lpFile);
+
 } // namespace example
 
 #endif // EXAMPLE_DRIVER_H
@@ -0,0 +1,561 @@
+/**
+ * @file   LpSparseReader.cc
+ * @author Yibo Lin
+ * @date   Oct 2014
+ * @brief  Implementation of @ref LpParser::read(LpSparseModel&, string const&)
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include "LpDriver.h"
+#include <limbo/string/CharConv.h>
+#if ZLIB == 1
+#include <limbo/parsers/common/GzipInputStream.h>
+#endif
+
+namespace LpParser {
+
+void LpSparseModel::clear()
+{
+    minimize = true;
+    vVariableName.clear();
+    vLowerBound.clear();
+    vUpperBound.clear();
+    vVariableType.clear();
+    vObjColumn.clear();
+    vObjElement.clear();
+    vRowBegin.clear();
+    vColumn.clear();
+    vElement.clear();
+    vSense.clear();
+    vRhs.clear();
+    vConstraintName.clear();
+}
+
+namespace {
+
+/// token types, following the tokens of LpScanner.ll
+enum LpTokenType
+{
+    LPTOK_END,
+    LPTOK_NUMBER,
+    LPTOK_STRING,
+    LPTOK_COMPARE,
+    LPTOK_OP,
+    LPTOK_MINIMIZE,
+    LPTOK_MAXIMIZE,
+    LPTOK_SUBJECT,
+    LPTOK_TO,
+    LPTOK_BOUNDS,
+    LPTOK_GENERALS,
+    LPTOK_BINARY,
+    LPTOK_KWD_END,
+    LPTOK_CHAR
+};
+
+/// a token pointing into the input buffer
+struct LpToken
+{
+    LpTokenType type;
+    const char* begin;
+    unsigned length;
+    double number; ///< value of LPTOK_NUMBER, or sign of LPTOK_OP
+    char compare; ///< '<', '>', '=' of LPTOK_COMPARE, or the character of LPTOK_CHAR
+};
+
+/// hand-written scanner with the same rules as LpScanner.ll
+class LpTokenizer
+{
+    public:
+        LpTokenizer(const char* begin, const char* end) : m_cur(begin), m_end(end), m_line(1) {}
+
+        unsigned line() const {return m_line;}
+
+        void next(LpToken& tok)
+        {
+            skip();
+            tok.begin = m_cur;
+            tok.length = 0;
+            if (m_cur == m_end)
+            {
+                tok.type = LPTOK_END;
+                return;
+            }
+            char c = *m_cur;
+            if (is_alpha(c))
+            {
+                const char* p = m_cur+1;
+                while (p != m_end && is_name_char(*p))
+                    ++p;
+                tok.length = p-m_cur;
+                tok.type = keyword(m_cur, tok.length);
+                m_cur = p;
+            }
+            else if (is_digit(c) || ((c == '+' || c == '-') && m_cur+1 != m_end && is_digit(m_cur[1])))
+            {
+                const char* p = m_cur+1;
+                while (p != m_end && is_digit(*p))
+                    ++p;
+                if (p != m_end && *p == '.')
+                {
+                    ++p;
+                    while (p != m_end && is_digit(*p))
+                        ++p;
+                }
+                tok.length = p-m_cur;
+                tok.type = LPTOK_NUMBER;
+                tok.number = to_number(m_cur, tok.length);
+                m_cur = p;
+            }
+            else if (c == '+' || c == '-')
+            {
+                tok.type = LPTOK_OP;
+                tok.number = (c == '+')? 1 : -1;
+                tok.length = 1;
+                ++m_cur;
+            }
+            else if (c == '=' || ((c == '<' || c == '>') && m_cur+1 != m_end && m_cur[1] == '='))
+            {
+                tok.type = LPTOK_COMPARE;
+                tok.compare = c;
+                tok.length = (c == '=')? 1 : 2;
+                m_cur += tok.length;
+            }
+            else
+            {
+                tok.type = LPTOK_CHAR;
+                tok.compare = c;
+                tok.length = 1;
+                ++m_cur;
+            }
+        }
+    protected:
+        static bool is_alpha(char c) {return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');}
+        static bool is_digit(char c) {return c >= '0' && c <= '9';}
+        static bool is_name_char(char c) {return is_alpha(c) || is_digit(c) || c == '_' || c == ',' || c == '.' || c == '-';}
+
+        /// skip white spaces, end of lines and comments
+        void skip()
+        {
+            while (m_cur != m_end)
+            {
+                char c = *m_cur;
+                if (c == '\n')
+                    ++m_line;
+                else if (c == '#')
+                {
+                    while (m_cur != m_end && *m_cur != '\n')
+                        ++m_cur;
+                    continue;
+                }
+                else if (c != ' ' && c != '\t' && c != '\r')
+                    break;
+                ++m_cur;
+            }
+        }
+        static LpTokenType keyword(const char* s, unsigned n)
+        {
+            switch (n)
+            {
+                case 2:
+                    if (std::memcmp(s, "To", 2) == 0) return LPTOK_TO;
+                    break;
+                case 3:
+                    if (std::memcmp(s, "End", 3) == 0) return LPTOK_KWD_END;
+                    break;
+                case 6:
+                    if (std::memcmp(s, "Bounds", 6) == 0) return LPTOK_BOUNDS;
+                    if (std::memcmp(s, "Binary", 6) == 0) return LPTOK_BINARY;
+                    break;
+                case 7:
+                    if (std::memcmp(s, "Subject", 7) == 0) return LPTOK_SUBJECT;
+                    break;
+                case 8:
+                    if (std::memcmp(s, "Minimize", 8) == 0) return LPTOK_MINIMIZE;
+                    if (std::memcmp(s, "Maximize", 8) == 0) return LPTOK_MAXIMIZE;
+                    if (std::memcmp(s, "Generals", 8) == 0) return LPTOK_GENERALS;
+                    break;
+                default:
+                    break;
+            }
+            return LPTOK_STRING;
+        }
+        /// convert exactly \a n characters, as the token ends before any exponent
+        static double to_number(const char* s, unsigned n)
+        {
+            double v = 0;
+            limbo::from_chars(s, s+n, v);
+            return v;
+        }
+
+        const char* m_cur;
+        const char* m_end;
+        unsigned m_line;
+};
+
+/// open addressing hash table from names in the input buffer to variable indices,
+/// so looking up a name does not construct a string
+class LpVariableTable
+{
+    public:
+        LpVariableTable(LpSparseModel& model) : m_model(model), m_mask(0) {}
+
+        void reserve(unsigned n)
+        {
+            m_model.vVariableName.reserve(n);
+            m_model.vLowerBound.reserve(n);
+            m_model.vUpperBound.reserve(n);
+            m_model.vVariableType.reserve(n);
+            rehash(n);
+        }
+        int find_or_add(const char* s, unsigned n)
+        {
+            if ((m_model.num_variables()+1)*2 > m_vSlot.size())
+                rehash(std::max(m_model.num_variables()*2, 16U));
+            std::size_t i = hash(s, n) & m_mask;
+            while (m_vSlot[i] >= 0)
+            {
+                string const& name = m_model.vVariableName[m_vSlot[i]];
+                if (name.size() == n && std::memcmp(name.data(), s, n) == 0)
+                    return m_vSlot[i];
+                i = (i+1) & m_mask;
+            }
+            int id = m_model.num_variables();
+            m_vSlot[i] = id;
+            m_model.vVariableName.push_back(string(s, n));
+            m_model.vLowerBound.push_back(limbo::lowest<double>());
+            m_model.vUpperBound.push_back(std::numeric_limits<double>::max());
+            m_model.vVariableType.push_back('C');
+            return id;
+        }
+    protected:
+        static std::size_t hash(const char* s, unsigned n)
+        {
+            // FNV-1a
+            std::size_t h = 2166136261U;
+            for (unsigned i = 0; i < n; ++i)
+                h = (h ^ (unsigned char)s[i]) * 16777619U;
+            return h;
+        }
+        void rehash(unsigned n)
+        {
+            std::size_t capacity = 16;
+            while (capacity < (std::size_t)n*2)
+                capacity <<= 1;
+            if (capacity <= m_vSlot.size())
+                return;
+            m_vSlot.assign(capacity, -1);
+            m_mask = capacity-1;
+            for (unsigned id = 0; id < m_model.num_variables(); ++id)
+            {
+                string const& name = m_model.vVariableName[id];
+                std::size_t i = hash(name.data(), name.size()) & m_mask;
+                while (m_vSlot[i] >= 0)
+                    i = (i+1) & m_mask;
+                m_vSlot[i] = id;
+            }
+        }
+
+        LpSparseModel& m_model;
+        vector<int> m_vSlot; ///< variable index of each slot, -1 for empty
+        std::size_t m_mask;
+};
+
+/// recursive descent parser following the grammar in LpParser.yy
+class LpSparseReader
+{
+    public:
+        LpSparseReader(LpSparseModel& model, string const& filename, const char* begin, const char* end)
+            : m_model(model)
+            , m_table(model)
+            , m_filename(filename)
+            , m_begin(begin)
+            , m_end(end)
+            , m_tokenizer(begin, end)
+        {
+        }
+
+        /// first pass, count constraints and terms to reserve arrays
+        void reserve()
+        {
+            LpTokenizer tokenizer (m_begin, m_end);
+            LpToken tok;
+            unsigned numObjTerms = 0;
+            unsigned numRows = 0;
+            unsigned numTerms = 0;
+            unsigned numBounds = 0;
+            LpTokenType section = LPTOK_END;
+            for (tokenizer.next(tok); tok.type != LPTOK_END; tokenizer.next(tok))
+            {
+                switch (tok.type)
+                {
+                    case LPTOK_MINIMIZE: case LPTOK_MAXIMIZE: case LPTOK_SUBJECT:
+                    case LPTOK_BOUNDS: case LPTOK_GENERALS: case LPTOK_BINARY:
+                        section = tok.type;
+                        break;
+                    case LPTOK_STRING:
+                        if (section == LPTOK_SUBJECT) ++numTerms; // constraint names are counted as well
+                        else if (section == LPTOK_MINIMIZE || section == LPTOK_MAXIMIZE) ++numObjTerms;
+                        else if (section == LPTOK_BOUNDS) ++numBounds;
+                        break;
+                    case LPTOK_COMPARE:
+                        if (section == LPTOK_SUBJECT) ++numRows;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            m_model.vObjColumn.reserve(numObjTerms);
+            m_model.vObjElement.reserve(numObjTerms);
+            m_model.vRowBegin.reserve(numRows+1);
+            m_model.vColumn.reserve(numTerms);
+            m_model.vElement.reserve(numTerms);
+            m_model.vSense.reserve(numRows);
+            m_model.vRhs.reserve(numRows);
+            m_model.vConstraintName.reserve(numRows);
+            // every variable usually has a bound, or appears in the objective
+            m_table.reserve(std::max(numObjTerms, numBounds));
+        }
+
+        /// second pass, fill the model
+        bool parse()
+        {
+            m_model.vRowBegin.push_back(0);
+            next();
+
+            // objective
+            if (m_tok.type != LPTOK_MINIMIZE && m_tok.type != LPTOK_MAXIMIZE)
+                return error("MINIMIZE or MAXIMIZE expected");
+            m_model.minimize = (m_tok.type == LPTOK_MINIMIZE);
+            next();
+            if (!terms(m_model.vObjColumn, m_model.vObjElement))
+                return false;
+
+            // constraints
+            if (m_tok.type != LPTOK_SUBJECT)
+                return error("SUBJECT expected");
+            next();
+            if (m_tok.type != LPTOK_TO)
+                return error("TO expected");
+            next();
+            do
+            {
+                if (!constraint())
+                    return false;
+            } while (m_tok.type != LPTOK_BOUNDS);
+
+            // bounds
+            next();
+            while (m_tok.type == LPTOK_STRING || m_tok.type == LPTOK_NUMBER)
+            {
+                if (!bound())
+                    return false;
+            }
+
+            // generals and binary
+            while (m_tok.type == LPTOK_GENERALS || m_tok.type == LPTOK_BINARY)
+            {
+                char type = (m_tok.type == LPTOK_GENERALS)? 'I' : 'B';
+                for (next(); m_tok.type == LPTOK_STRING; next())
+                    m_model.vVariableType[variable()] = type;
+            }
+
+            if (m_tok.type != LPTOK_KWD_END)
+                return error("END expected");
+            next();
+            if (m_tok.type != LPTOK_END)
+                return error("end of file expected");
+            return true;
+        }
+    protected:
+        void next() {m_tokenizer.next(m_tok);}
+        int variable() {return m_table.find_or_add(m_tok.begin, m_tok.length);}
+
+        bool error(const char* msg)
+        {
+            cerr << m_filename << ":" << m_tokenizer.line() << ": syntax error, " << msg;
+            if (m_tok.type != LPTOK_END)
+                cerr << " before \"" << string(m_tok.begin, m_tok.length) << "\"";
+            cerr << endl;
+            return false;
+        }
+
+        /// [OP] term (OP term)*, where term is STRING or number STRING
+        bool terms(vector<int>& vColumn, vector<double>& vElement)
+        {
+            double sign = 1;
+            if (m_tok.type == LPTOK_OP)
+            {
+                sign = m_tok.number;
+                next();
+            }
+            while (true)
+            {
+                double coef = sign;
+                if (m_tok.type == LPTOK_NUMBER)
+                {
+                    coef *= m_tok.number;
+                    next();
+                }
+                if (m_tok.type != LPTOK_STRING)
+                    return error("variable expected");
+                vColumn.push_back(variable());
+                vElement.push_back(coef);
+                next();
+                if (m_tok.type != LPTOK_OP)
+                    return true;
+                sign = m_tok.number;
+                next();
+            }
+        }
+        /// [STRING ':'] terms COMPARE number
+        bool constraint()
+        {
+            string name;
+            if (m_tok.type == LPTOK_STRING)
+            {
+                LpToken tok = m_tok;
+                LpTokenizer tokenizer = m_tokenizer;
+                next();
+                if (m_tok.type == LPTOK_CHAR && m_tok.compare == ':')
+                {
+                    name.assign(tok.begin, tok.length);
+                    next();
+                }
+                else // not a name, step back
+                {
+                    m_tok = tok;
+                    m_tokenizer = tokenizer;
+                }
+            }
+            if (!terms(m_model.vColumn, m_model.vElement))
+                return false;
+            if (m_tok.type != LPTOK_COMPARE)
+                return error("COMPARE expected");
+            char sense = m_tok.compare;
+            next();
+            if (m_tok.type != LPTOK_NUMBER)
+                return error("number expected");
+            m_model.vSense.push_back(sense);
+            m_model.vRhs.push_back(m_tok.number);
+            m_model.vConstraintName.push_back(name);
+            m_model.vRowBegin.push_back(m_model.vColumn.size());
+            next();
+            return true;
+        }
+        /// STRING COMPARE number | number COMPARE STRING [COMPARE number],
+        /// bounds are tightened like LinearModel::add_variable
+        bool bound()
+        {
+            double lb = limbo::lowest<double>();
+            double ub = std::numeric_limits<double>::max();
+            int id = -1;
+            if (m_tok.type == LPTOK_STRING)
+            {
+                id = variable();
+                next();
+                if (m_tok.type != LPTOK_COMPARE)
+                    return error("COMPARE expected");
+                char compare = m_tok.compare;
+                next();
+                if (m_tok.type != LPTOK_NUMBER)
+                    return error("number expected");
+                set_bound(compare, m_tok.number, lb, ub);
+                next();
+            }
+            else
+            {
+                double constant = m_tok.number;
+                next();
+                if (m_tok.type != LPTOK_COMPARE)
+                    return error("COMPARE expected");
+                // constant compare var is var reversed-compare constant
+                char compare = (m_tok.compare == '<')? '>' : (m_tok.compare == '>')? '<' : '=';
+                next();
+                if (m_tok.type != LPTOK_STRING)
+                    return error("variable expected");
+                id = variable();
+                set_bound(compare, constant, lb, ub);
+                next();
+                if (m_tok.type == LPTOK_COMPARE)
+                {
+                    compare = m_tok.compare;
+                    next();
+                    if (m_tok.type != LPTOK_NUMBER)
+                        return error("number expected");
+                    set_bound(compare, m_tok.number, lb, ub);
+                    next();
+                }
+            }
+            m_model.vLowerBound[id] = std::max(m_model.vLowerBound[id], lb);
+            m_model.vUpperBound[id] = std::min(m_model.vUpperBound[id], ub);
+            return true;
+        }
+        static void set_bound(char compare, double constant, double& lb, double& ub)
+        {
+            switch (compare)
+            {
+                case '>':
+                    lb = constant;
+                    break;
+                case '<':
+                    ub = constant;
+                    break;
+                case '=':
+                default:
+                    lb = ub = constant;
+                    break;
+            }
+        }
+
+        LpSparseModel& m_model;
+        LpVariableTable m_table;
+        string const& m_filename;
+        const char* m_begin;
+        const char* m_end;
+        LpTokenizer m_tokenizer;
+        LpToken m_tok;
+};
+
+} // anonymous namespace
+
+bool read(LpSparseModel& model, const string& lpFile)
+{
+    model.clear();
+
+#if ZLIB == 1
+    if (limbo::is_gzip_file(lpFile)) // size unknown before inflating 
+    {
+        limbo::GzipInputStream in (lpFile);
+        if (!in.good())
+            return false;
+        std::ostringstream oss;
+        oss << in.rdbuf();
+        string text = oss.str();
+        LpSparseReader reader (model, lpFile, text.data(), text.data()+text.size());
+        reader.reserve();
+        return reader.parse();
+    }
+#endif
+    std::ifstream in (lpFile.c_str(), std::ios::in | std::ios::binary);
+    if (!in.good())
+        return false;
+    in.seekg(0, std::ios::end);
+    std::streamoff size = in.tellg();
+    if (size < 0)
+        return false;
+    in.seekg(0, std::ios::beg);
+    vector<char> vBuffer (static_cast<std::size_t>(size));
+    if (size > 0 && !in.read(&vBuffer[0], size))
+        return false;
+    in.close();
+
+    const char* begin = vBuffer.empty()? NULL : &vBuffer[0];
+    LpSparseReader reader (model, lpFile, begin, begin+vBuffer.size());
+    reader.reserve();
+    return reader.parse();
+}
+
+} // namespace LpParser
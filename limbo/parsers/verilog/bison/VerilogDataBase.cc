@@ -20,6 +20,16 @@ void VerilogDataBase::verilog_assignment_cbk(std::string const& /*target_name*/,
 	verilog_user_cbk_reminder(__func__);
 }
 
+limbo::DesignSymbols* VerilogIdDataBase::verilog_symbols()
+{
+	return NULL;
+}
+
+void VerilogIdDataBase::verilog_instance_cbk(std::string const& /*macro_name*/, std::string const& /*inst_name*/, std::vector<NetPin> const& /*vNetPin*/)
+{
+	verilog_user_cbk_reminder(__func__);
+}
+
 void VerilogDataBase::verilog_user_cbk_reminder(const char* str) const 
 {
     std::cout << "A corresponding user-defined callback is necessary: " << str << std::endl;
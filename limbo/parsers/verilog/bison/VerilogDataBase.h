@@ -16,6 +16,9 @@
 #include <cassert>
 #include <limits>
 
+/// @brief symbols shared by the LEF, DEF and Verilog drivers, see @ref limbo::DesignSymbols 
+namespace limbo { class DesignSymbols; }
+
 /// namespace for VerilogParser
 namespace VerilogParser {
 
@@ -155,6 +158,44 @@ struct NetPin
     }
 };
 
+/// @brief reserved symbols of nets in @ref VerilogParser::NetPinId 
+enum NetSymbolType 
+{
+    kCONSTANT_NET = -1, ///< the net is a constant value 
+    kGROUP_NETS = -2 ///< the net is a group of nets 
+};
+
+/// @brief name with a range by symbol, see @ref VerilogParser::VerilogIdDataBase 
+struct GeneralNameId
+{
+    int name; ///< symbol of the name 
+    Range range; ///< min infinity if not specified 
+
+    /// @brief constructor 
+    /// @param n symbol of the name 
+    /// @param r range 
+    GeneralNameId(int n = -1, Range const& r = Range()) : name(n), range(r) {}
+};
+
+/// @brief connection of a pin to a net by symbols, see @ref VerilogParser::VerilogIdDataBase. 
+/// It is a plain struct, so arrays of connections are reused by the driver without allocation. 
+struct NetPinId
+{
+    int net; ///< symbol of the net, or @ref VerilogParser::kCONSTANT_NET and @ref VerilogParser::kGROUP_NETS 
+    int pin; ///< symbol of the pin 
+    Range range; ///< range of the net, (0, bits) for a constant 
+    int constant; ///< constant value only valid if the net is @ref VerilogParser::kCONSTANT_NET 
+    unsigned group_begin; ///< first net in the group array of the instance, only valid if the net is @ref VerilogParser::kGROUP_NETS 
+    unsigned group_end; ///< end of nets in the group array of the instance 
+
+    /// @brief constructor 
+    /// @param n symbol of the net 
+    /// @param p symbol of the pin 
+    /// @param r range of the net 
+    NetPinId(int n = -1, int p = -1, Range const& r = Range()) 
+        : net(n), pin(p), range(r), constant(0), group_begin(0), group_end(0) {}
+};
+
 /// @brief bison does not support vector very well, 
 /// so here create a dummy class for string array. 
 class StringArray : public std::vector<std::string>
@@ -211,6 +252,8 @@ class GeneralNameArray : public std::vector<GeneralName>
 class VerilogDataBase
 {
 	public:
+        /// @brief destructor, virtual so derived databases are destroyed completely through a pointer of this type 
+        virtual ~VerilogDataBase() {}
         /// @brief read a module declaration 
         ///
         /// module NOR2_X1 ( a, b, c );
@@ -259,6 +302,40 @@ class VerilogDataBase
         void verilog_user_cbk_reminder(const char* str) const; 
 };
 
+/// @class VerilogParser::VerilogIdDataBase
+/// @brief Base class for verilog database taking instances by symbols. 
+/// 
+/// Instance, macro, net and pin names of instances are interned by the driver to dense symbols in the order of appearance, 
+/// and @ref VerilogParser::VerilogIdDataBase::verilog_symbol_cbk reports each symbol once before its first use. 
+/// Connections of an instance are passed as arrays reused for all instances, 
+/// so large gate-level netlists do not allocate strings or vectors per instance. 
+/// 
+/// If @ref VerilogParser::VerilogIdDataBase::verilog_symbols returns a table, names are interned into it by kind instead, 
+/// i.e., macro symbols of @ref limbo::DESIGN_MACRO, instance symbols of @ref limbo::DESIGN_INSTANCE, 
+/// nets of @ref limbo::DESIGN_NET and pins of @ref limbo::DESIGN_PIN, 
+/// so instances get the symbols of DEF components and LEF macros with the same names; 
+/// instances are bound to their macros, and @ref VerilogParser::VerilogIdDataBase::verilog_symbol_cbk is not called. 
+class VerilogIdDataBase : public VerilogDataBase
+{
+	public:
+        /// @brief symbols shared with LEF and DEF databases 
+        /// @return the table, NULL by default for symbols of this database only 
+        virtual limbo::DesignSymbols* verilog_symbols(); 
+        /// @brief read an instance by names, not called for this database 
+        virtual void verilog_instance_cbk(std::string const& macro_name, std::string const& inst_name, std::vector<NetPin> const& vNetPin); 
+        /// @brief read a new symbol 
+        /// @param id symbol, starting from 0 
+        /// @param name name of the symbol 
+        virtual void verilog_symbol_cbk(int id, std::string const& name) = 0; 
+        /// @brief read an instance by symbols 
+        /// @param macro_id symbol of standard cell type or module name 
+        /// @param inst_id symbol of instance name 
+        /// @param vNetPin array of connections, only valid during the callback 
+        /// @param numNetPins number of connections 
+        /// @param vGroupNet nets of groups referred to by @ref VerilogParser::NetPinId::group_begin and @ref VerilogParser::NetPinId::group_end 
+        virtual void verilog_instance_cbk(int macro_id, int inst_id, NetPinId const* vNetPin, unsigned numNetPins, GeneralNameId const* vGroupNet) = 0;
+};
+
 } // namespace VerilogParser
 
 #endif
@@ -7,18 +7,71 @@
 
 #include "VerilogDriver.h"
 #include "VerilogScanner.h"
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+#include <streambuf>
+#include <pthread.h>
+#include <boost/unordered_map.hpp>
+#include <limbo/parsers/common/PrefetchInputStream.h>
+#if ZLIB == 1
+#include <limbo/parsers/common/GzipInputStream.h>
+#include <limbo/preprocessor/Instrument.h>
+#endif
 
 namespace VerilogParser {
 
+/// @brief dense symbols of names in the order of appearance 
+class VerilogSymbolTable
+{
+    public:
+        /// @brief constructor 
+        /// @param db database to report new symbols 
+        VerilogSymbolTable(VerilogIdDataBase& db) : m_db(db) {}
+        /// @brief intern a name 
+        /// @param name name 
+        /// @return symbol 
+        int find_or_insert(std::string const& name)
+        {
+            std::pair<boost::unordered_map<std::string, int>::iterator, bool> found = m_mName2Id.insert(std::make_pair(name, (int)m_mName2Id.size())); 
+            if (found.second)
+                m_db.verilog_symbol_cbk(found.first->second, found.first->first); 
+            return found.first->second; 
+        }
+    protected:
+        VerilogIdDataBase& m_db; ///< database 
+        boost::unordered_map<std::string, int> m_mName2Id; ///< hash map from names to symbols 
+};
+
 Driver::Driver(VerilogDataBase& db)
     : trace_scanning(false),
       trace_parsing(false),
-      m_db(db)
+      first_line(1), 
+      profile("VerilogParser"),
+      m_db(db), 
+      m_idDb(dynamic_cast<VerilogIdDataBase*>(&db)), 
+      m_symbols(NULL), 
+      m_design((m_idDb)? m_idDb->verilog_symbols() : NULL)
+{
+    if (m_idDb && !m_design)
+        m_symbols = new VerilogSymbolTable (*m_idDb); 
+}
+
+Driver::~Driver()
+{
+    delete m_symbols; 
+}
+
+int Driver::symbol(limbo::DesignSymbolKind kind, std::string const& name)
 {
+    if (m_design)
+        return m_design->find_or_insert(kind, name); 
+    return m_symbols->find_or_insert(name); 
 }
 
 bool Driver::parse_stream(std::istream& in, const std::string& sname)
 {
+    limboParserParse(profile);
     streamname = sname;
 
     Scanner scanner(&in);
@@ -32,7 +85,15 @@ bool Driver::parse_stream(std::istream& in, const std::string& sname)
 
 bool Driver::parse_file(const std::string &filename)
 {
-    std::ifstream in(filename.c_str());
+#if ZLIB == 1
+    if (limbo::is_gzip_file(filename)) // inflated by a helper thread 
+    {
+        limbo::GzipInputStream in (filename);
+        if (!in.good()) return false;
+        return parse_stream(in, filename);
+    }
+#endif
+    limbo::PrefetchInputStream in (filename); // read ahead by a helper thread 
     if (!in.good()) return false;
     return parse_stream(in, filename);
 }
@@ -56,6 +117,8 @@ void Driver::error(const std::string& m)
 
 void Driver::module_name_cbk(std::string const& module_name, std::vector<GeneralName> const& vPinName)
 {
+    limboParserRecord(profile, "module");
+    limboParserCallback(profile);
     m_db.verilog_module_declaration_cbk(module_name, vPinName);
 }
 
@@ -71,69 +134,473 @@ void Driver::module_name_cbk(std::string const& module_name, std::vector<General
 }
 
 void Driver::module_instance_cbk(std::string const& macro_name, std::string const& inst_name) 
+{
+    limboParserRecord(profile, "instance");
+    instance_cbk(macro_name, inst_name);
+}
+
+void Driver::instance_cbk(std::string const& macro_name, std::string const& inst_name) 
 {
 	// due to the feature of LL 
 	// wire_pin_cbk will be called before module_instance_cbk
-	m_db.verilog_instance_cbk(macro_name, inst_name, m_vNetPin);
+    if (m_idDb)
+    {
+        int macro_id = symbol(limbo::DESIGN_MACRO, macro_name); 
+        int inst_id = symbol(limbo::DESIGN_INSTANCE, inst_name); 
+        if (m_design)
+            m_design->bind_instance(inst_id, macro_id); 
+        {
+            limboParserCallback(profile);
+            m_idDb->verilog_instance_cbk(macro_id, inst_id, 
+                    (m_vNetPinId.empty())? NULL : &m_vNetPinId[0], m_vNetPinId.size(), 
+                    (m_vGroupNetId.empty())? NULL : &m_vGroupNetId[0]); 
+        }
+        // keep capacities for the next instance 
+        m_vNetPinId.clear(); 
+        m_vGroupNetId.clear(); 
+        return; 
+    }
+	{
+		limboParserCallback(profile);
+		m_db.verilog_instance_cbk(macro_name, inst_name, m_vNetPin);
+	}
 	// remember to clear m_vNetPin
 	m_vNetPin.clear();
 }
 
 void Driver::assignment_cbk(std::string const& target_name, Range const& target_range, std::string const& source_name, Range const& source_range) 
 {
+    limboParserRecord(profile, "assign");
+    limboParserCallback(profile);
     m_db.verilog_assignment_cbk(target_name, target_range, source_name, source_range);
 }
 
 void Driver::wire_pin_cbk(std::string& net_name, std::string& pin_name, Range const& range)
 {
+    if (m_idDb)
+    {
+        m_vNetPinId.push_back(NetPinId(symbol(limbo::DESIGN_NET, net_name), symbol(limbo::DESIGN_PIN, pin_name), range)); 
+        return; 
+    }
 	m_vNetPin.push_back(NetPin(net_name, pin_name, range));
 }
 void Driver::wire_pin_cbk(int bits, int value, std::string& pin_name)
 {
+    if (m_idDb)
+    {
+        m_vNetPinId.push_back(NetPinId(kCONSTANT_NET, symbol(limbo::DESIGN_PIN, pin_name), Range(0, bits))); 
+        m_vNetPinId.back().constant = value; 
+        return; 
+    }
     std::string net_name = "VerilogParser::CONSTANT_NET";
 	m_vNetPin.push_back(NetPin(net_name, pin_name, Range(0, bits), value));
 }
 void Driver::wire_pin_cbk(std::vector<GeneralName>& vNetName, std::string& pin_name)
 {
+    if (m_idDb)
+    {
+        m_vNetPinId.push_back(NetPinId(kGROUP_NETS, symbol(limbo::DESIGN_PIN, pin_name))); 
+        m_vNetPinId.back().group_begin = m_vGroupNetId.size(); 
+        for (std::vector<GeneralName>::const_iterator it = vNetName.begin(); it != vNetName.end(); ++it)
+            m_vGroupNetId.push_back(GeneralNameId(symbol(limbo::DESIGN_NET, it->name), it->range)); 
+        m_vNetPinId.back().group_end = m_vGroupNetId.size(); 
+        return; 
+    }
     std::string net_name = "VerilogParser::GROUP_NETS";
 	m_vNetPin.push_back(NetPin(net_name, pin_name, vNetName));
 }
 void Driver::wire_declare_cbk(std::vector<GeneralName> const& vNetName, Range const& range)
 {
+    limboParserRecord(profile, "wire");
     for (std::vector<GeneralName>::const_iterator it = vNetName.begin(); it != vNetName.end(); ++it)
     {
         if (it->range.low != std::numeric_limits<int>::min() || it->range.high != std::numeric_limits<int>::min())
             std::cerr << "warning: multiple definitions of ranges " << it->name << std::endl;
+        limboParserCallback(profile);
         m_db.verilog_net_declare_cbk(it->name, range);
     }
 }
 void Driver::wire_declare_cbk(std::vector<GeneralName> const& vNetName)
 {
+    limboParserRecord(profile, "wire");
+    limboParserCallback(profile);
     for (std::vector<GeneralName>::const_iterator it = vNetName.begin(); it != vNetName.end(); ++it)
         m_db.verilog_net_declare_cbk(it->name, it->range);
 }
 void Driver::pin_declare_cbk(std::vector<GeneralName> const& vPinName, unsigned type, Range const& range)
 {
+    limboParserRecord(profile, "port");
     for (std::vector<GeneralName>::const_iterator it = vPinName.begin(); it != vPinName.end(); ++it)
     {
         if (it->range.low != std::numeric_limits<int>::min() || it->range.high != std::numeric_limits<int>::min())
             std::cerr << "warning: multiple definitions of ranges " << it->name << std::endl;
+        limboParserCallback(profile);
         m_db.verilog_pin_declare_cbk(it->name, type, range);
     }
 }
 void Driver::pin_declare_cbk(std::vector<GeneralName> const& vPinName, unsigned type)
 {
+    limboParserRecord(profile, "port");
+    limboParserCallback(profile);
     for (std::vector<GeneralName>::const_iterator it = vPinName.begin(); it != vPinName.end(); ++it)
         m_db.verilog_pin_declare_cbk(it->name, type, it->range);
 }
 
-bool read(VerilogDataBase& db, const string& verilogFile)
+/// @brief types of callbacks recorded by @ref VerilogParser::VerilogRecordDataBase 
+enum VerilogCallbackType 
+{
+    VERILOG_MODULE_DECLARATION, 
+    VERILOG_INSTANCE, 
+    VERILOG_NET_DECLARE, 
+    VERILOG_PIN_DECLARE, 
+    VERILOG_ASSIGNMENT
+};
+
+/// @brief a recorded callback, arguments are kept in pools of the database 
+struct VerilogCallback
+{
+    VerilogCallbackType type; ///< callback 
+    unsigned value; ///< pin type, or number of connections of an instance 
+    std::size_t index; ///< first entry in the pool of names 
+    std::size_t extra; ///< first entry in the pool of pin lists, connections or ranges 
+};
+
+/// @brief callbacks recorded by a thread of @ref VerilogParser::read, 
+/// so they can be passed to the user database in the order of the file 
+class VerilogRecordDataBase : public VerilogDataBase
+{
+	public:
+        virtual void verilog_module_declaration_cbk(std::string const& module_name, std::vector<GeneralName> const& vPinName)
+        {
+            add(VERILOG_MODULE_DECLARATION, module_name).extra = m_vPinName.size(); 
+            m_vPinName.push_back(vPinName); 
+        }
+        virtual void verilog_instance_cbk(std::string const& macro_name, std::string const& inst_name, std::vector<NetPin> const& vNetPin)
+        {
+            VerilogCallback& cbk = add(VERILOG_INSTANCE, macro_name); 
+            m_vName.push_back(inst_name); 
+            cbk.value = vNetPin.size(); 
+            cbk.extra = m_vNetPin.size(); 
+            m_vNetPin.insert(m_vNetPin.end(), vNetPin.begin(), vNetPin.end()); 
+        }
+        virtual void verilog_net_declare_cbk(std::string const& net_name, Range const& range)
+        {
+            add(VERILOG_NET_DECLARE, net_name).extra = m_vRange.size(); 
+            m_vRange.push_back(range); 
+        }
+        virtual void verilog_pin_declare_cbk(std::string const& pin_name, unsigned type, Range const& range)
+        {
+            VerilogCallback& cbk = add(VERILOG_PIN_DECLARE, pin_name); 
+            cbk.value = type; 
+            cbk.extra = m_vRange.size(); 
+            m_vRange.push_back(range); 
+        }
+        virtual void verilog_assignment_cbk(std::string const& target_name, Range const& target_range, std::string const& source_name, Range const& source_range)
+        {
+            add(VERILOG_ASSIGNMENT, target_name).extra = m_vRange.size(); 
+            m_vName.push_back(source_name); 
+            m_vRange.push_back(target_range); 
+            m_vRange.push_back(source_range); 
+        }
+
+        /// @brief invoke recorded callbacks in order 
+        /// @param driver driver of the user database, instances go through it 
+        /// to be passed by names or symbols in the same way as the serial mode 
+        void replay(Driver& driver)
+        {
+            VerilogDataBase& db = driver.m_db; 
+            for (std::vector<VerilogCallback>::const_iterator it = m_vCallback.begin(); it != m_vCallback.end(); ++it)
+            {
+                VerilogCallback const& cbk = *it; 
+                switch (cbk.type)
+                {
+                    case VERILOG_MODULE_DECLARATION: 
+                        {
+                            limboParserCallback(driver.profile);
+                            db.verilog_module_declaration_cbk(m_vName[cbk.index], m_vPinName[cbk.extra]); 
+                        }
+                        break; 
+                    case VERILOG_INSTANCE: 
+                        for (std::size_t i = cbk.extra, ie = cbk.extra+cbk.value; i < ie; ++i)
+                        {
+                            NetPin& np = m_vNetPin[i]; 
+                            if (np.net == "VerilogParser::CONSTANT_NET")
+                                driver.wire_pin_cbk(np.range.high, np.extension.constant, np.pin); 
+                            else if (np.net == "VerilogParser::GROUP_NETS")
+                                driver.wire_pin_cbk(*np.extension.vNetName, np.pin); 
+                            else 
+                                driver.wire_pin_cbk(np.net, np.pin, np.range); 
+                        }
+                        // counted as a record by the thread parsing the module 
+                        driver.instance_cbk(m_vName[cbk.index], m_vName[cbk.index+1]); 
+                        break; 
+                    case VERILOG_NET_DECLARE: 
+                        {
+                            limboParserCallback(driver.profile);
+                            db.verilog_net_declare_cbk(m_vName[cbk.index], m_vRange[cbk.extra]); 
+                        }
+                        break; 
+                    case VERILOG_PIN_DECLARE: 
+                        {
+                            limboParserCallback(driver.profile);
+                            db.verilog_pin_declare_cbk(m_vName[cbk.index], cbk.value, m_vRange[cbk.extra]); 
+                        }
+                        break; 
+                    case VERILOG_ASSIGNMENT: 
+                        {
+                            limboParserCallback(driver.profile);
+                            db.verilog_assignment_cbk(m_vName[cbk.index], m_vRange[cbk.extra], m_vName[cbk.index+1], m_vRange[cbk.extra+1]); 
+                        }
+                        break; 
+                    default: assert(0); 
+                }
+            }
+        }
+    protected:
+        /// @brief append a callback 
+        /// @param type callback 
+        /// @param name first name argument 
+        /// @return the callback 
+        VerilogCallback& add(VerilogCallbackType type, std::string const& name)
+        {
+            m_vCallback.push_back(VerilogCallback()); 
+            VerilogCallback& cbk = m_vCallback.back(); 
+            cbk.type = type; 
+            cbk.value = 0; 
+            cbk.index = m_vName.size(); 
+            cbk.extra = 0; 
+            m_vName.push_back(name); 
+            return cbk; 
+        }
+
+        std::vector<VerilogCallback> m_vCallback; ///< callbacks in order 
+        std::vector<std::string> m_vName; ///< name arguments 
+        std::vector<std::vector<GeneralName> > m_vPinName; ///< pins of module declarations 
+        std::vector<NetPin> m_vNetPin; ///< connections of instances 
+        std::vector<Range> m_vRange; ///< ranges of declarations and assignments 
+};
+
+/// @brief read-only stream buffer over a part of the file in memory, so modules are parsed without copies 
+class VerilogMemoryBuffer : public std::streambuf
+{
+    public:
+        /// @brief constructor 
+        /// @param data first character 
+        /// @param size number of characters 
+        VerilogMemoryBuffer(const char* data, std::size_t size)
+        {
+            char* p = const_cast<char*>(data); 
+            setg(p, p, p+size); 
+        }
+};
+
+/// @brief a part of the file starting at a module declaration 
+struct VerilogChunk
+{
+    std::size_t begin; ///< first character 
+    std::size_t end; ///< end of characters 
+    int line; ///< line number of the first character 
+};
+
+/// @brief split a file before each module declaration, 
+/// skipping comments, compiler directives and escaped names like the scanner 
+/// @param content whole file 
+/// @param vChunk parts of the file in order, the first part starts at the beginning of the file 
+static void verilog_split_modules(std::string const& content, std::vector<VerilogChunk>& vChunk)
+{
+    const char* data = content.data(); 
+    std::size_t size = content.size(); 
+    VerilogChunk chunk; 
+    chunk.begin = 0; 
+    chunk.line = 1; 
+    int line = 1; 
+    bool nameFlag = false; // whether the previous character belongs to a name 
+    for (std::size_t i = 0; i < size; )
+    {
+        char c = data[i]; 
+        if (c == '\n')
+        {
+            ++line; 
+            ++i; 
+            nameFlag = false; 
+        }
+        else if (c == '/' && i+1 < size && data[i+1] == '/' && !nameFlag)
+        {
+            const char* p = (const char*)memchr(data+i, '\n', size-i); 
+            i = (p)? p-data : size; 
+        }
+        else if (c == '/' && i+1 < size && data[i+1] == '*' && !nameFlag)
+        {
+            std::size_t pos = content.find("*/", i+2); 
+            pos = (pos == std::string::npos)? size : pos+2; 
+            line += std::count(data+i, data+pos, '\n'); 
+            i = pos; 
+        }
+        else if (c == '`')
+        {
+            const char* p = (const char*)memchr(data+i, '\n', size-i); 
+            i = (p)? p-data : size; 
+            nameFlag = false; 
+        }
+        else if (isalnum((unsigned char)c) || c == '_' || c == '/' || c == '.' || c == '\\')
+        {
+            if (!nameFlag && c == 'm' && size-i >= 6 && content.compare(i, 6, "module") == 0 
+                    && (size-i == 6 || !(isalnum((unsigned char)data[i+6]) || data[i+6] == '_' || data[i+6] == '/' || data[i+6] == '.')))
+            {
+                if (i > chunk.begin && !vChunk.empty())
+                {
+                    vChunk.back().end = i; 
+                    chunk.begin = i; 
+                    chunk.line = line; 
+                    vChunk.push_back(chunk); 
+                }
+                else if (vChunk.empty())
+                    vChunk.push_back(chunk); 
+                i += 6; 
+                continue; 
+            }
+            nameFlag = true; 
+            // escaped names take the next character 
+            i += (c == '\\' && i+1 < size)? 2 : 1; 
+        }
+        else 
+        {
+            nameFlag = false; 
+            ++i; 
+        }
+    }
+    if (vChunk.empty())
+        vChunk.push_back(chunk); 
+    vChunk.back().end = size; 
+}
+
+/// @brief modules shared by threads of @ref VerilogParser::read 
+struct VerilogParallelData
+{
+    std::string const* content; ///< whole file 
+    std::string const* filename; ///< file name for error messages 
+    std::vector<VerilogChunk> const* vChunk; ///< parts of the file 
+    std::vector<VerilogRecordDataBase*> vDataBase; ///< recorded callbacks of parts 
+    std::vector<char> vResult; ///< parsing results of parts 
+    std::vector<char> vDone; ///< whether parts have been parsed 
+    std::size_t next; ///< next part to parse 
+    pthread_mutex_t mutex; ///< lock of vDone 
+    pthread_cond_t cond; ///< signal when a part has been parsed 
+};
+
+/// @brief thread function to parse parts in turn 
+/// @param arg pointer to @ref VerilogParser::VerilogParallelData 
+/// @return NULL 
+static void* verilog_parse_modules(void* arg)
+{
+    VerilogParallelData& data = *(VerilogParallelData*)arg;
+    while (true)
+    {
+        std::size_t i = __sync_fetch_and_add(&data.next, (std::size_t)1);
+        if (i >= data.vChunk->size())
+            break;
+        VerilogChunk const& chunk = data.vChunk->at(i); 
+        VerilogRecordDataBase* db = new VerilogRecordDataBase;
+        Driver driver (*db);
+        driver.first_line = chunk.line; 
+        VerilogMemoryBuffer buffer (data.content->data()+chunk.begin, chunk.end-chunk.begin); 
+        std::istream in (&buffer); 
+        bool result = driver.parse_stream(in, *data.filename);
+
+        pthread_mutex_lock(&data.mutex);
+        data.vDataBase[i] = db;
+        data.vResult[i] = result;
+        data.vDone[i] = true;
+        pthread_cond_broadcast(&data.cond);
+        pthread_mutex_unlock(&data.mutex);
+    }
+    return NULL;
+}
+
+bool read(VerilogDataBase& db, const string& verilogFile, int numThreads)
 {
+	limboScopedTimer("VerilogParser::read");
+	limboScopedAllocations("VerilogParser::read");
 	Driver driver (db);
 	//driver.trace_scanning = true;
 	//driver.trace_parsing = true;
 
-	return driver.parse_file(verilogFile);
+    if (numThreads <= 1)
+        return driver.parse_file(verilogFile);
+
+    std::ostringstream oss; 
+#if ZLIB == 1
+    if (limbo::is_gzip_file(verilogFile))
+    {
+        limbo::GzipInputStream in (verilogFile); 
+        if (!in.good()) 
+            return false; 
+        oss << in.rdbuf(); 
+    }
+    else 
+#endif
+    {
+        std::ifstream in (verilogFile.c_str()); 
+        if (!in.good()) 
+            return false; 
+        oss << in.rdbuf(); 
+    }
+    std::string content = oss.str(); 
+    std::vector<VerilogChunk> vChunk; 
+    verilog_split_modules(content, vChunk); 
+    if (vChunk.size() <= 1)
+    {
+        VerilogMemoryBuffer buffer (content.data(), content.size()); 
+        std::istream is (&buffer); 
+        return driver.parse_stream(is, verilogFile); 
+    }
+
+    // threads parse modules into their own databases, 
+    // and the current thread passes callbacks to the user database in the order of modules 
+    VerilogParallelData data; 
+    data.content = &content; 
+    data.filename = &verilogFile; 
+    data.vChunk = &vChunk; 
+    data.vDataBase.assign(vChunk.size(), NULL); 
+    data.vResult.assign(vChunk.size(), false); 
+    data.vDone.assign(vChunk.size(), false); 
+    data.next = 0; 
+    pthread_mutex_init(&data.mutex, NULL);
+    pthread_cond_init(&data.cond, NULL);
+
+    std::size_t numWorkers = std::min((std::size_t)numThreads, vChunk.size());
+    std::vector<pthread_t> vThread (numWorkers);
+    std::size_t numCreated = 0; 
+    for (std::size_t i = 0; i < numWorkers; ++i)
+    {
+        if (pthread_create(&vThread[numCreated], NULL, verilog_parse_modules, &data) == 0)
+            ++numCreated; 
+    }
+    // parse in the current thread if no thread is available 
+    if (numCreated == 0)
+        verilog_parse_modules(&data); 
+
+    bool flag = true; 
+    for (std::size_t i = 0; i < vChunk.size(); ++i)
+    {
+        pthread_mutex_lock(&data.mutex);
+        while (!data.vDone[i])
+            pthread_cond_wait(&data.cond, &data.mutex);
+        pthread_mutex_unlock(&data.mutex);
+        // same callbacks as the serial mode, so stop after the first failed module 
+        if (flag)
+        {
+            data.vDataBase[i]->replay(driver);
+            flag = data.vResult[i];
+        }
+        delete data.vDataBase[i];
+        data.vDataBase[i] = NULL;
+    }
+    for (std::size_t i = 0; i < numCreated; ++i)
+        pthread_join(vThread[i], NULL);
+    pthread_cond_destroy(&data.cond);
+    pthread_mutex_destroy(&data.mutex);
+    return flag; 
 }
 
 } // namespace example
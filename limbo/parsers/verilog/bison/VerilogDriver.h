@@ -9,6 +9,8 @@
 #define VERILOGPARSER_DRIVER_H
 
 #include "VerilogDataBase.h"
+#include <limbo/parsers/common/ParserProfile.h>
+#include <limbo/parsers/common/DesignSymbols.h>
 
 /** The example namespace is used to encapsulate the three parser classes
  * example::Parser, example::Scanner and example::Driver */
@@ -24,6 +26,9 @@ using std::pair;
 using std::make_pair;
 using std::ostringstream;
 
+/// @brief map from names to symbols, see @ref VerilogParser::VerilogIdDataBase 
+class VerilogSymbolTable;
+
 /** 
  * @class VerilogParser::Driver
  * The Driver class brings together all components. It creates an instance of
@@ -38,6 +43,8 @@ public:
     /// construct a new parser driver context
     /// @param db reference to database 
     Driver(VerilogDataBase& db);
+    /// destructor 
+    ~Driver();
 
     /// enable debug output in the flex scanner
     bool trace_scanning;
@@ -48,6 +55,9 @@ public:
     /// stream name (file or input stream) used for error messages.
     string streamname;
 
+    /// line number of the first line in the stream, e.g., for modules split from a file 
+    int first_line;
+
     /** Invoke the scanner and parser for a stream.
      * @param in	input stream
      * @param sname	stream name for error messages
@@ -87,6 +97,11 @@ public:
      * parser to the scanner. It is used in the yylex macro. */
     class Scanner* lexer;
 
+    /** Counters and timers of the scanner, grammar actions and database
+     * callbacks, compiled out unless LIMBO_INSTRUMENT is defined. It is used
+     * in the yylex macro. */
+    limbo::ParserProfile profile;
+
     /** Reference to the database filled during parsing of the
      * expressions. */
     VerilogDataBase& m_db;
@@ -102,20 +117,40 @@ public:
     void pin_declare_cbk(std::vector<GeneralName> const&, unsigned, Range const&);
     void pin_declare_cbk(std::vector<GeneralName> const&, unsigned);
     void module_instance_cbk(std::string const&, std::string const&);
+    void instance_cbk(std::string const&, std::string const&); // module_instance_cbk without counting a record, for replays 
     void assignment_cbk(std::string const&, Range const&, std::string const&, Range const&); 
     /// @endcond
 
 protected:
+    /// @brief disabled copy 
+    Driver(Driver const&);
+    /// @brief disabled assignment 
+    Driver& operator=(Driver const&);
+    /// @brief intern a name 
+    /// @param kind namespace of the name in a shared table 
+    /// @param name name 
+    /// @return symbol 
+    int symbol(limbo::DesignSymbolKind kind, std::string const& name);
+
 	/// @brief Use as a stack for node and pin pairs in a net,  
 	/// because wire_pin_cbk will be called before module_instance_cbk
 	vector<NetPin> m_vNetPin;
+    VerilogIdDataBase* m_idDb; ///< database taking symbols, NULL if the database only takes names 
+    VerilogSymbolTable* m_symbols; ///< symbols of names, only used with m_idDb without a shared table 
+    limbo::DesignSymbols* m_design; ///< symbols shared with other parsers, NULL if not given by m_idDb 
+    vector<NetPinId> m_vNetPinId; ///< connections of the current instance by symbols, reused for all instances 
+    vector<GeneralNameId> m_vGroupNetId; ///< nets of groups in the current instance by symbols 
 };
 
 /// @brief API for VerilogParser. 
 /// Read Verilog file and initialize database by calling user-defined callback functions. 
+/// If the database is derived from @ref VerilogParser::VerilogIdDataBase, instances are passed by symbols. 
 /// @param db database which is derived from @ref VerilogParser::VerilogDataBase
 /// @param verilogFile Verilog file 
-bool read(VerilogDataBase& db, const string& verilogFile);
+/// @param numThreads number of threads; the file is split at module boundaries, 
+/// modules are parsed concurrently with separate drivers, 
+/// and their callbacks are recorded and then passed to the database in the same order as the serial mode. 
+bool read(VerilogDataBase& db, const string& verilogFile, int numThreads = 1);
 
 } // namespace example
 
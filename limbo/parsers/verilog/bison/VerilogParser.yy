@@ -39,6 +39,7 @@
 {
     // initialize the initial location object
     @$.begin.filename = @$.end.filename = &driver.streamname;
+    @$.begin.line = @$.end.line = driver.first_line;
 };
 
 /* The driver is passed by reference to the parser and to the scanner. This
@@ -123,7 +124,7 @@
  * object. it defines the yylex() function call to pull the next token from the
  * current lexer object of the driver context. */
 #undef yylex
-#define yylex driver.lexer->lex
+#define yylex(yylval, yylloc) limboParserScan(driver.profile, driver.lexer->lex(yylval, yylloc))
 
 %}
 
@@ -4,6 +4,7 @@
 %{ /*** C/C++ Declarations ***/
 
 #include <string>
+#include <limbo/parsers/common/ParserProfile.h>
 
 #include "VerilogScanner.h"
 
@@ -48,6 +49,15 @@ typedef VerilogParser::Parser::token_type token_type;
 #define YY_USER_ACTION  yylloc->columns(yyleng);
 %}
 
+/* Read input as flex does by default, and count the bytes in the profile of
+ * the driver if compiled with LIMBO_INSTRUMENT. */
+%{
+#define YY_INPUT(buf, result, max_size) \
+    if ((int)(result = LexerInput((char*)buf, max_size)) < 0) \
+        YY_FATAL_ERROR("input in flex scanner failed"); \
+    limboParserBytes(result);
+%}
+
 /* c-style comments using starting condition */
 %x C_COMMENT
 
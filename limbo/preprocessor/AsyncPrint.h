@@ -0,0 +1,306 @@
+/**
+ * @file   AsyncPrint.h
+ * @brief  asynchronous back end of print functions in @ref PrintMsg.h
+ *
+ * After @ref limbo::limboStartAsyncPrint, each thread formats messages into its own ring buffer
+ * and a background thread writes them, so threads do not wait for console or file output.
+ * Messages of a thread are written in order, and each message is written at once.
+ * Messages of different threads are written in the order they are collected, about the order of printing.
+ * Assertion messages are written synchronously after pending messages, as the program aborts right after them.
+ *
+ * A separate header, so programs only link pthread when they use the asynchronous back end.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PREPROCESSOR_ASYNCPRINT_H
+#define LIMBO_PREPROCESSOR_ASYNCPRINT_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/time.h>
+#include <limbo/preprocessor/PrintMsg.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+
+/// @brief messages of a thread waiting to be written, a ring with one producer and one consumer
+struct AsyncPrintBuffer
+{
+    /// @brief a message
+    struct Slot
+    {
+        FILE* stream; ///< output stream
+        std::string text; ///< message
+    };
+
+    std::vector<Slot> vSlot; ///< ring of messages
+    unsigned long head; ///< next slot to write, advanced by the writer
+    unsigned long tail; ///< next slot to fill, advanced by the owner thread
+    int closed; ///< set when the owner thread exits
+
+    /// @brief constructor
+    /// @param capacity number of slots
+    explicit AsyncPrintBuffer(std::size_t capacity) : vSlot(capacity), head(0), tail(0), closed(0) {}
+};
+
+/// @brief background writer of messages in per-thread buffers
+class AsyncPrinter
+{
+    public:
+        /// @return the writer of the process
+        static AsyncPrinter& instance()
+        {
+            static AsyncPrinter printer;
+            return printer;
+        }
+
+        /// @brief start the writer thread and route print functions to it
+        /// @param capacity number of messages buffered per thread
+        /// @return true if running
+        bool start(std::size_t capacity)
+        {
+            pthread_mutex_lock(&m_mutex);
+            if (!m_running)
+            {
+                m_capacity = std::max(capacity, (std::size_t)2);
+                m_stop = false;
+                m_running = (pthread_create(&m_thread, NULL, AsyncPrinter::writerThread, this) == 0);
+            }
+            bool running = m_running;
+            pthread_mutex_unlock(&m_mutex);
+            if (running)
+            {
+                limboPrintConfig().flush = AsyncPrinter::flushHook;
+                limboPrintConfig().sink = AsyncPrinter::sinkHook;
+            }
+            return running;
+        }
+        /// @brief write pending messages, stop the writer thread and print synchronously again
+        void stop()
+        {
+            limboPrintConfig().sink = NULL;
+            pthread_mutex_lock(&m_mutex);
+            bool running = m_running;
+            m_stop = true;
+            pthread_cond_signal(&m_cond);
+            pthread_mutex_unlock(&m_mutex);
+            if (running)
+                pthread_join(m_thread, NULL);
+            m_running = false;
+            limboPrintConfig().flush = NULL;
+            this->drain();
+        }
+        /// @brief write all pending messages from the calling thread
+        void flush()
+        {
+            this->drain();
+        }
+    protected:
+        /// @brief constructor
+        AsyncPrinter() : m_capacity(4096), m_running(false), m_stop(false)
+        {
+            pthread_mutex_init(&m_mutex, NULL);
+            pthread_mutex_init(&m_drainMutex, NULL);
+            pthread_cond_init(&m_cond, NULL);
+            pthread_key_create(&m_key, AsyncPrinter::closeBuffer);
+        }
+        /// @brief destructor, write pending messages at exit
+        ~AsyncPrinter()
+        {
+            this->stop();
+            for (std::vector<AsyncPrintBuffer*>::iterator it = m_vBuffer.begin(); it != m_vBuffer.end(); ++it)
+                delete *it;
+            pthread_key_delete(m_key);
+            pthread_cond_destroy(&m_cond);
+            pthread_mutex_destroy(&m_drainMutex);
+            pthread_mutex_destroy(&m_mutex);
+        }
+        /// copy is not allowed
+        AsyncPrinter(AsyncPrinter const&);
+        /// assignment is not allowed
+        AsyncPrinter& operator=(AsyncPrinter const&);
+
+        /// @return value read after all earlier writes of other threads are visible
+        static unsigned long load(unsigned long const& v)
+        {
+            unsigned long r = *(unsigned long const volatile*)&v;
+            __sync_synchronize();
+            return r;
+        }
+        /// @brief write a value after all earlier writes of this thread
+        static void store(unsigned long& v, unsigned long r)
+        {
+            __sync_synchronize();
+            *(unsigned long volatile*)&v = r;
+        }
+        /// @brief sink of @ref PrintConfig
+        static int sinkHook(FILE* stream, const char* text, std::size_t length)
+        {
+            return instance().push(stream, text, length);
+        }
+        /// @brief flush of @ref PrintConfig
+        static void flushHook()
+        {
+            instance().drain();
+        }
+        /// @brief mark the buffer of an exiting thread, so the writer releases it when empty
+        static void closeBuffer(void* arg)
+        {
+            __sync_lock_test_and_set(&static_cast<AsyncPrintBuffer*>(arg)->closed, 1);
+        }
+        /// @brief writer loop, write messages and sleep for a while when there is none
+        static void* writerThread(void* arg)
+        {
+            AsyncPrinter& printer = *static_cast<AsyncPrinter*>(arg);
+            while (true)
+            {
+                bool written = printer.drain();
+                pthread_mutex_lock(&printer.m_mutex);
+                bool stop = printer.m_stop;
+                if (!written && !stop)
+                {
+                    // producers signal when a buffer is half full, otherwise wait 10 ms
+                    timeval now;
+                    gettimeofday(&now, NULL);
+                    timespec deadline;
+                    deadline.tv_sec = now.tv_sec;
+                    deadline.tv_nsec = now.tv_usec*1000+10000000;
+                    if (deadline.tv_nsec >= 1000000000)
+                    {
+                        deadline.tv_sec += 1;
+                        deadline.tv_nsec -= 1000000000;
+                    }
+                    pthread_cond_timedwait(&printer.m_cond, &printer.m_mutex, &deadline);
+                }
+                pthread_mutex_unlock(&printer.m_mutex);
+                if (stop)
+                    break;
+            }
+            return NULL;
+        }
+
+        /// @return buffer of the calling thread, created at the first call of the thread
+        AsyncPrintBuffer& buffer()
+        {
+            AsyncPrintBuffer* buf = static_cast<AsyncPrintBuffer*>(pthread_getspecific(m_key));
+            if (buf == NULL)
+            {
+                pthread_mutex_lock(&m_mutex);
+                buf = new AsyncPrintBuffer (m_capacity);
+                m_vBuffer.push_back(buf);
+                pthread_mutex_unlock(&m_mutex);
+                pthread_setspecific(m_key, buf);
+            }
+            return *buf;
+        }
+        /// @brief append a message to the buffer of the calling thread, waiting while it is full
+        /// @return length of the message
+        int push(FILE* stream, const char* text, std::size_t length)
+        {
+            AsyncPrintBuffer& buf = this->buffer();
+            unsigned long tail = buf.tail;
+            unsigned long capacity = buf.vSlot.size();
+            while (tail-load(buf.head) >= capacity)
+            {
+                pthread_mutex_lock(&m_mutex);
+                pthread_cond_signal(&m_cond);
+                pthread_mutex_unlock(&m_mutex);
+                sched_yield();
+            }
+            AsyncPrintBuffer::Slot& slot = buf.vSlot[tail%capacity];
+            slot.stream = stream;
+            slot.text.assign(text, length);
+            store(buf.tail, tail+1);
+            // wake up the writer early when the buffer is half full
+            if (tail+1-load(buf.head) == capacity/2)
+            {
+                pthread_mutex_lock(&m_mutex);
+                pthread_cond_signal(&m_cond);
+                pthread_mutex_unlock(&m_mutex);
+            }
+            return length;
+        }
+        /// @brief write messages of all buffers, and release buffers of exited threads
+        /// @return true if any message is written
+        bool drain()
+        {
+            pthread_mutex_lock(&m_drainMutex);
+            pthread_mutex_lock(&m_mutex);
+            std::vector<AsyncPrintBuffer*> vBuffer (m_vBuffer);
+            pthread_mutex_unlock(&m_mutex);
+
+            bool written = false;
+            std::set<FILE*> sStream;
+            std::vector<AsyncPrintBuffer*> vClosed;
+            for (std::vector<AsyncPrintBuffer*>::iterator it = vBuffer.begin(); it != vBuffer.end(); ++it)
+            {
+                AsyncPrintBuffer& buf = **it;
+                // read closed before tail, so no message comes after a closed buffer is seen empty
+                bool closed = __sync_fetch_and_add(&buf.closed, 0);
+                unsigned long tail = load(buf.tail);
+                unsigned long head = buf.head;
+                for (; head != tail; ++head)
+                {
+                    AsyncPrintBuffer::Slot& slot = buf.vSlot[head%buf.vSlot.size()];
+                    fwrite(slot.text.data(), 1, slot.text.size(), slot.stream);
+                    sStream.insert(slot.stream);
+                    written = true;
+                }
+                store(buf.head, head);
+                if (closed)
+                    vClosed.push_back(*it);
+            }
+            for (std::set<FILE*>::iterator it = sStream.begin(); it != sStream.end(); ++it)
+                fflush(*it);
+            if (!vClosed.empty())
+            {
+                pthread_mutex_lock(&m_mutex);
+                for (std::vector<AsyncPrintBuffer*>::iterator it = vClosed.begin(); it != vClosed.end(); ++it)
+                {
+                    m_vBuffer.erase(std::find(m_vBuffer.begin(), m_vBuffer.end(), *it));
+                    delete *it;
+                }
+                pthread_mutex_unlock(&m_mutex);
+            }
+            pthread_mutex_unlock(&m_drainMutex);
+            return written;
+        }
+
+        std::vector<AsyncPrintBuffer*> m_vBuffer; ///< buffers of all threads
+        std::size_t m_capacity; ///< number of slots of new buffers
+        pthread_key_t m_key; ///< buffer of the current thread
+        pthread_t m_thread; ///< writer thread
+        bool m_running; ///< whether the writer thread runs
+        bool m_stop; ///< whether the writer thread exits
+        pthread_mutex_t m_mutex; ///< protect the list of buffers and the state of the writer
+        pthread_mutex_t m_drainMutex; ///< only one thread writes messages at a time
+        pthread_cond_t m_cond; ///< wake up the writer
+};
+
+/// @brief print messages from a background thread from now on
+/// @param capacity number of messages buffered per thread; a thread waits when its buffer is full
+/// @return true if the background thread runs
+inline bool limboStartAsyncPrint(std::size_t capacity = 4096)
+{
+    return AsyncPrinter::instance().start(capacity);
+}
+/// @brief write pending messages and print synchronously again
+inline void limboStopAsyncPrint()
+{
+    AsyncPrinter::instance().stop();
+}
+/// @brief write pending messages now
+inline void limboFlushPrint()
+{
+    AsyncPrinter::instance().flush();
+}
+
+} // namespace limbo
+
+#endif
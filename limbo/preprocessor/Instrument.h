@@ -0,0 +1,660 @@
+/**
+ * @file   Instrument.h
+ * @brief  scoped timers, counters and histograms that compile to nothing unless LIMBO_INSTRUMENT is defined
+ *
+ * macro: limboScopedTimer, limboCounterAdd, limboHistogramAdd, limboInstrumentWrite,
+ *        limboMemoryRecord, limboScopedAllocations, limboDefineAllocationHooks
+ *
+ * attribute: timers nest, so a timer started inside another one is reported under the path "outer/inner".
+ *            Each thread records timers in its own buffer, and buffers are merged when a report is written.
+ *            Counters and histograms are shared by all threads and updated with atomic additions.
+ *            Gauges keep the last and the peak value, such as bytes of a @ref MemoryUsage category recorded by limboMemoryRecord.
+ *            limboScopedAllocations counts the allocations of the calling thread in a scope and the peak heap of the process,
+ *            which are only counted if limboDefineAllocationHooks is expanded once at namespace scope of the program.
+ *            Reports are written in JSON, or CSV if the file name ends with ".csv".
+ *            Without LIMBO_INSTRUMENT, the macros expand to nothing and no code is generated;
+ *            values of counters and histograms are not evaluated.
+ *
+ * example usage:
+ * ~~~~~~~~~~~~~~~~
+ * {
+ *     limboScopedTimer("simplify");
+ *     limboCounterAdd("hidden vertices", numHidden);
+ *     limboHistogramAdd("component size", compSize);
+ * }
+ * limboInstrumentWrite("profile.json");
+ * ~~~~~~~~~~~~~~~~
+ *
+ * counting allocations of a parser:
+ * ~~~~~~~~~~~~~~~~
+ * limboDefineAllocationHooks();
+ *
+ * int main()
+ * {
+ *     {
+ *         limboScopedAllocations("read");
+ *         DefParser::read(db, "a.def");
+ *     }
+ *     limbo::MemoryUsage usage;
+ *     db.memoryUsage(usage);
+ *     limboMemoryRecord(usage);
+ *     limboInstrumentWrite("profile.json");
+ * }
+ * ~~~~~~~~~~~~~~~~
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PREPROCESSOR_INSTRUMENT_H
+#define LIMBO_PREPROCESSOR_INSTRUMENT_H
+
+/// @cond
+#define LIMBO_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define LIMBO_INSTRUMENT_CONCAT(a, b) LIMBO_INSTRUMENT_CONCAT_IMPL(a, b)
+/// @endcond
+
+#ifdef LIMBO_INSTRUMENT
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <pthread.h>
+#include <time.h>
+#include <limbo/preprocessor/MemoryUsage.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+
+/// @brief statistics of a timer path
+struct InstrumentTimerStat
+{
+	unsigned long long count; ///< number of scopes finished
+	double total; ///< total wall time in seconds
+	double max; ///< maximum wall time of a scope in seconds
+	unsigned int threads; ///< number of threads recording the path, set when merged
+
+	/// @brief constructor
+	InstrumentTimerStat() : count(0), total(0), max(0), threads(0) {}
+};
+
+/// @brief timers of a thread
+struct InstrumentThreadBuffer
+{
+	pthread_mutex_t mutex; ///< protect the timers from a concurrent report
+	std::string path; ///< path of the innermost running timer
+	std::map<std::string, InstrumentTimerStat> mTimer; ///< statistics of finished timers by path
+
+	/// @brief constructor
+	InstrumentThreadBuffer() {pthread_mutex_init(&mutex, NULL);}
+	/// @brief destructor
+	~InstrumentThreadBuffer() {pthread_mutex_destroy(&mutex);}
+};
+
+/// @brief a named counter updated atomically
+class InstrumentCounter
+{
+	public:
+		/// @brief constructor
+		InstrumentCounter() : m_value(0) {}
+		/// @brief add to the counter
+		void add(long long v) {__sync_fetch_and_add(&m_value, v);}
+		/// @return current value
+		long long value() const {return __sync_fetch_and_add(const_cast<long long*>(&m_value), 0);}
+		/// @brief set to 0
+		void reset() {__sync_lock_test_and_set(&m_value, 0);}
+	protected:
+		long long m_value; ///< value
+};
+
+/// @brief a named histogram of non-negative values in power-of-two buckets, updated atomically
+///
+/// Bucket 0 counts values below 1, and bucket b > 0 counts values in [2^(b-1), 2^b).
+class InstrumentHistogram
+{
+	public:
+		/// number of buckets
+		enum {NUM_BUCKETS = 64};
+		/// @brief constructor
+		InstrumentHistogram() {this->reset();}
+		/// @brief add a value
+		void add(long long v)
+		{
+			unsigned int b = 0;
+			for (unsigned long long u = (v > 0)? v : 0; u != 0 && b+1 < NUM_BUCKETS; u >>= 1)
+				++b;
+			__sync_fetch_and_add(&m_vBucket[b], 1);
+			__sync_fetch_and_add(&m_count, 1);
+			__sync_fetch_and_add(&m_sum, v);
+		}
+		/// @return number of values in a bucket
+		long long bucket(unsigned int b) const {return __sync_fetch_and_add(const_cast<long long*>(&m_vBucket[b]), 0);}
+		/// @return number of values
+		long long count() const {return __sync_fetch_and_add(const_cast<long long*>(&m_count), 0);}
+		/// @return sum of values
+		long long sum() const {return __sync_fetch_and_add(const_cast<long long*>(&m_sum), 0);}
+		/// @brief remove all values
+		void reset()
+		{
+			for (unsigned int b = 0; b < NUM_BUCKETS; ++b)
+				__sync_lock_test_and_set(&m_vBucket[b], 0);
+			__sync_lock_test_and_set(&m_count, 0);
+			__sync_lock_test_and_set(&m_sum, 0);
+		}
+	protected:
+		long long m_vBucket[NUM_BUCKETS]; ///< number of values in each bucket
+		long long m_count; ///< number of values
+		long long m_sum; ///< sum of values
+};
+
+/// @brief a named gauge keeping the last and the peak value, updated atomically
+class InstrumentGauge
+{
+	public:
+		/// @brief constructor
+		InstrumentGauge() : m_value(0), m_peak(0) {}
+		/// @brief set the value and raise the peak
+		void set(long long v)
+		{
+			__sync_lock_test_and_set(&m_value, v);
+			for (long long p = this->peak(); v > p && !__sync_bool_compare_and_swap(&m_peak, p, v); )
+				p = this->peak();
+		}
+		/// @return last value
+		long long value() const {return __sync_fetch_and_add(const_cast<long long*>(&m_value), 0);}
+		/// @return largest value
+		long long peak() const {return __sync_fetch_and_add(const_cast<long long*>(&m_peak), 0);}
+		/// @brief set to 0
+		void reset()
+		{
+			__sync_lock_test_and_set(&m_value, 0);
+			__sync_lock_test_and_set(&m_peak, 0);
+		}
+	protected:
+		long long m_value; ///< last value
+		long long m_peak; ///< largest value
+};
+
+/// @brief allocations of a thread counted by the hooks of limboDefineAllocationHooks
+struct InstrumentAllocationStat
+{
+	unsigned long long count; ///< number of allocations
+	unsigned long long bytes; ///< bytes allocated
+};
+
+/// @brief heap of the process through the hooks of limboDefineAllocationHooks
+struct InstrumentHeap
+{
+	/// size of the header before each block, which keeps the alignment of malloc
+	enum {HEADER = 16};
+
+	/// @return allocations of the calling thread
+	static InstrumentAllocationStat& thread_stat()
+	{
+		static __thread InstrumentAllocationStat stat;
+		return stat;
+	}
+	/// @return bytes allocated and not released
+	static long long& live()
+	{
+		static long long bytes = 0;
+		return bytes;
+	}
+	/// @return largest value of @ref live since the last reset by @ref reset_peak
+	static long long& peak()
+	{
+		static long long bytes = 0;
+		return bytes;
+	}
+	/// @brief raise the peak to a value
+	static void raise_peak(long long v)
+	{
+		for (long long p = peak(); v > p && !__sync_bool_compare_and_swap(&peak(), p, v); )
+			p = peak();
+	}
+	/// @brief restart the peak from the live bytes
+	/// @return previous peak
+	static long long reset_peak() {return __sync_lock_test_and_set(&peak(), __sync_fetch_and_add(&live(), 0));}
+
+	/// @brief allocate a block with a header keeping its size
+	/// @return the block, NULL if out of memory
+	static void* allocate(std::size_t n)
+	{
+		char* p = static_cast<char*>(std::malloc(n+HEADER));
+		if (p == NULL)
+			return NULL;
+		*reinterpret_cast<std::size_t*>(p) = n;
+		InstrumentAllocationStat& stat = thread_stat();
+		stat.count += 1;
+		stat.bytes += n;
+		raise_peak(__sync_add_and_fetch(&live(), (long long)n));
+		return p+HEADER;
+	}
+	/// @brief release a block from @ref allocate
+	static void deallocate(void* ptr)
+	{
+		if (ptr == NULL)
+			return;
+		char* p = static_cast<char*>(ptr)-HEADER;
+		__sync_fetch_and_sub(&live(), (long long)*reinterpret_cast<std::size_t*>(p));
+		std::free(p);
+	}
+};
+
+/// @brief registry of all timers, counters, histograms and gauges of the process
+class Instrument
+{
+	public:
+		/// @return the registry
+		static Instrument& instance()
+		{
+			static Instrument inst;
+			return inst;
+		}
+		/// @return wall time in seconds
+		static double wall_time()
+		{
+			timespec ts;
+			clock_gettime(CLOCK_MONOTONIC, &ts);
+			return ts.tv_sec+ts.tv_nsec*1e-9;
+		}
+
+		/// @return timer buffer of the calling thread, created at the first call of the thread
+		InstrumentThreadBuffer& buffer()
+		{
+			InstrumentThreadBuffer* buf = static_cast<InstrumentThreadBuffer*>(pthread_getspecific(m_key));
+			if (buf == NULL)
+			{
+				buf = new InstrumentThreadBuffer;
+				pthread_setspecific(m_key, buf);
+				pthread_mutex_lock(&m_mutex);
+				m_vBuffer.push_back(buf);
+				pthread_mutex_unlock(&m_mutex);
+			}
+			return *buf;
+		}
+		/// @return counter of a name, created at the first call
+		InstrumentCounter* counter(const char* name)
+		{
+			pthread_mutex_lock(&m_mutex);
+			InstrumentCounter*& c = m_mCounter[name];
+			if (c == NULL)
+				c = new InstrumentCounter;
+			pthread_mutex_unlock(&m_mutex);
+			return c;
+		}
+		/// @return histogram of a name, created at the first call
+		InstrumentHistogram* histogram(const char* name)
+		{
+			pthread_mutex_lock(&m_mutex);
+			InstrumentHistogram*& h = m_mHistogram[name];
+			if (h == NULL)
+				h = new InstrumentHistogram;
+			pthread_mutex_unlock(&m_mutex);
+			return h;
+		}
+		/// @return gauge of a name, created at the first call
+		InstrumentGauge* gauge(const char* name)
+		{
+			pthread_mutex_lock(&m_mutex);
+			InstrumentGauge*& g = m_mGauge[name];
+			if (g == NULL)
+				g = new InstrumentGauge;
+			pthread_mutex_unlock(&m_mutex);
+			return g;
+		}
+		/// @brief add scopes timed by the caller to the timer of a name under the path of the enclosing timers of the calling thread,
+		/// for code too hot for a @ref ScopedTimer per scope; the maximum is that of the times added at once
+		/// @param name name of the scopes
+		/// @param count number of scopes
+		/// @param total total wall time in seconds
+		void add_time(const char* name, unsigned long long count, double total)
+		{
+			InstrumentThreadBuffer& buf = this->buffer();
+			pthread_mutex_lock(&buf.mutex);
+			InstrumentTimerStat& stat = buf.mTimer[(buf.path.empty())? std::string(name) : buf.path+'/'+name];
+			stat.count += count;
+			stat.total += total;
+			stat.max = std::max(stat.max, total);
+			pthread_mutex_unlock(&buf.mutex);
+		}
+		/// @brief set gauges "memory/<category>" to bytes of categories and "memory/total" to the sum
+		/// @param usage bytes by category
+		void record(MemoryUsage const& usage)
+		{
+			for (MemoryUsage::map_type::const_iterator it = usage.categories().begin(); it != usage.categories().end(); ++it)
+				this->gauge(("memory/"+it->first).c_str())->set(it->second);
+			this->gauge("memory/total")->set(usage.total());
+		}
+		/// @brief clear finished timers, counters, histograms and gauges, keeping running timers
+		void reset()
+		{
+			pthread_mutex_lock(&m_mutex);
+			for (std::vector<InstrumentThreadBuffer*>::iterator it = m_vBuffer.begin(); it != m_vBuffer.end(); ++it)
+			{
+				pthread_mutex_lock(&(*it)->mutex);
+				(*it)->mTimer.clear();
+				pthread_mutex_unlock(&(*it)->mutex);
+			}
+			for (std::map<std::string, InstrumentCounter*>::iterator it = m_mCounter.begin(); it != m_mCounter.end(); ++it)
+				it->second->reset();
+			for (std::map<std::string, InstrumentHistogram*>::iterator it = m_mHistogram.begin(); it != m_mHistogram.end(); ++it)
+				it->second->reset();
+			for (std::map<std::string, InstrumentGauge*>::iterator it = m_mGauge.begin(); it != m_mGauge.end(); ++it)
+				it->second->reset();
+			pthread_mutex_unlock(&m_mutex);
+		}
+		/// @brief merge finished timers of all threads by path
+		/// @param mTimer statistics as output
+		void merge(std::map<std::string, InstrumentTimerStat>& mTimer)
+		{
+			mTimer.clear();
+			pthread_mutex_lock(&m_mutex);
+			for (std::vector<InstrumentThreadBuffer*>::iterator it = m_vBuffer.begin(); it != m_vBuffer.end(); ++it)
+			{
+				pthread_mutex_lock(&(*it)->mutex);
+				for (std::map<std::string, InstrumentTimerStat>::const_iterator itt = (*it)->mTimer.begin(); itt != (*it)->mTimer.end(); ++itt)
+				{
+					InstrumentTimerStat& stat = mTimer[itt->first];
+					stat.count += itt->second.count;
+					stat.total += itt->second.total;
+					stat.max = std::max(stat.max, itt->second.max);
+					stat.threads += 1;
+				}
+				pthread_mutex_unlock(&(*it)->mutex);
+			}
+			pthread_mutex_unlock(&m_mutex);
+		}
+		/// @brief write a report
+		/// @param fileName output file, in CSV if it ends with ".csv", otherwise in JSON
+		/// @return true if written
+		bool write(const char* fileName)
+		{
+			FILE* fp = fopen(fileName, "w");
+			if (fp == NULL)
+				return false;
+			std::size_t len = strlen(fileName);
+			if (len >= 4 && strcmp(fileName+len-4, ".csv") == 0)
+				this->writeCsv(fp);
+			else
+				this->writeJson(fp);
+			return fclose(fp) == 0;
+		}
+		/// @brief write a report in JSON, with arrays "timers", "counters", "histograms" and "gauges"
+		/// @param fp output stream
+		void writeJson(FILE* fp)
+		{
+			std::map<std::string, InstrumentTimerStat> mTimer;
+			this->merge(mTimer);
+			fprintf(fp, "{\n  \"timers\": [");
+			const char* sep = "";
+			for (std::map<std::string, InstrumentTimerStat>::const_iterator it = mTimer.begin(); it != mTimer.end(); ++it, sep = ",")
+				fprintf(fp, "%s\n    {\"name\": \"%s\", \"count\": %llu, \"total\": %.9g, \"max\": %.9g, \"threads\": %u}",
+						sep, escape(it->first).c_str(), it->second.count, it->second.total, it->second.max, it->second.threads);
+			fprintf(fp, "\n  ],\n  \"counters\": [");
+			pthread_mutex_lock(&m_mutex);
+			sep = "";
+			for (std::map<std::string, InstrumentCounter*>::const_iterator it = m_mCounter.begin(); it != m_mCounter.end(); ++it, sep = ",")
+				fprintf(fp, "%s\n    {\"name\": \"%s\", \"value\": %lld}", sep, escape(it->first).c_str(), it->second->value());
+			fprintf(fp, "\n  ],\n  \"histograms\": [");
+			sep = "";
+			for (std::map<std::string, InstrumentHistogram*>::const_iterator it = m_mHistogram.begin(); it != m_mHistogram.end(); ++it, sep = ",")
+			{
+				InstrumentHistogram const& h = *it->second;
+				fprintf(fp, "%s\n    {\"name\": \"%s\", \"count\": %lld, \"sum\": %lld, \"buckets\": [", sep, escape(it->first).c_str(), h.count(), h.sum());
+				const char* bsep = "";
+				for (unsigned int b = 0; b < InstrumentHistogram::NUM_BUCKETS; ++b)
+				{
+					if (h.bucket(b) == 0)
+						continue;
+					fprintf(fp, "%s{\"lower\": %llu, \"upper\": %llu, \"count\": %lld}", bsep, lower(b), lower(b+1), h.bucket(b));
+					bsep = ", ";
+				}
+				fprintf(fp, "]}");
+			}
+			fprintf(fp, "\n  ],\n  \"gauges\": [");
+			sep = "";
+			for (std::map<std::string, InstrumentGauge*>::const_iterator it = m_mGauge.begin(); it != m_mGauge.end(); ++it, sep = ",")
+				fprintf(fp, "%s\n    {\"name\": \"%s\", \"value\": %lld, \"peak\": %lld}", sep, escape(it->first).c_str(), it->second->value(), it->second->peak());
+			pthread_mutex_unlock(&m_mutex);
+			fprintf(fp, "\n  ]\n}\n");
+		}
+		/// @brief write a report in CSV with columns type, name, count, total, max, lower, upper;
+		/// a timer gives count, total and max in seconds, a counter gives its value as count,
+		/// a histogram gives one row per nonempty bucket [lower, upper), and a gauge gives its last value as count and its peak as max
+		/// @param fp output stream
+		void writeCsv(FILE* fp)
+		{
+			std::map<std::string, InstrumentTimerStat> mTimer;
+			this->merge(mTimer);
+			fprintf(fp, "type,name,count,total,max,lower,upper\n");
+			for (std::map<std::string, InstrumentTimerStat>::const_iterator it = mTimer.begin(); it != mTimer.end(); ++it)
+				fprintf(fp, "timer,\"%s\",%llu,%.9g,%.9g,,\n", quote(it->first).c_str(), it->second.count, it->second.total, it->second.max);
+			pthread_mutex_lock(&m_mutex);
+			for (std::map<std::string, InstrumentCounter*>::const_iterator it = m_mCounter.begin(); it != m_mCounter.end(); ++it)
+				fprintf(fp, "counter,\"%s\",%lld,,,,\n", quote(it->first).c_str(), it->second->value());
+			for (std::map<std::string, InstrumentHistogram*>::const_iterator it = m_mHistogram.begin(); it != m_mHistogram.end(); ++it)
+				for (unsigned int b = 0; b < InstrumentHistogram::NUM_BUCKETS; ++b)
+					if (it->second->bucket(b))
+						fprintf(fp, "histogram,\"%s\",%lld,,,%llu,%llu\n", quote(it->first).c_str(), it->second->bucket(b), lower(b), lower(b+1));
+			for (std::map<std::string, InstrumentGauge*>::const_iterator it = m_mGauge.begin(); it != m_mGauge.end(); ++it)
+				fprintf(fp, "gauge,\"%s\",%lld,,%lld,,\n", quote(it->first).c_str(), it->second->value(), it->second->peak());
+			pthread_mutex_unlock(&m_mutex);
+		}
+	protected:
+		/// @brief constructor
+		Instrument()
+		{
+			pthread_mutex_init(&m_mutex, NULL);
+			pthread_key_create(&m_key, NULL);
+		}
+		/// @brief destructor, buffers of threads are released with the registry at exit
+		~Instrument()
+		{
+			for (std::vector<InstrumentThreadBuffer*>::iterator it = m_vBuffer.begin(); it != m_vBuffer.end(); ++it)
+				delete *it;
+			for (std::map<std::string, InstrumentCounter*>::iterator it = m_mCounter.begin(); it != m_mCounter.end(); ++it)
+				delete it->second;
+			for (std::map<std::string, InstrumentHistogram*>::iterator it = m_mHistogram.begin(); it != m_mHistogram.end(); ++it)
+				delete it->second;
+			for (std::map<std::string, InstrumentGauge*>::iterator it = m_mGauge.begin(); it != m_mGauge.end(); ++it)
+				delete it->second;
+			pthread_key_delete(m_key);
+			pthread_mutex_destroy(&m_mutex);
+		}
+		/// copy is not allowed
+		Instrument(Instrument const&);
+		/// assignment is not allowed
+		Instrument& operator=(Instrument const&);
+
+		/// @return lower bound of a histogram bucket
+		static unsigned long long lower(unsigned int b) {return (b == 0)? 0 : 1ULL << (b-1);}
+		/// @return string with JSON escapes
+		static std::string escape(std::string const& s)
+		{
+			std::string r;
+			for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+			{
+				if (*it == '"' || *it == '\\')
+					r += '\\';
+				r += *it;
+			}
+			return r;
+		}
+		/// @return string with CSV quotes doubled
+		static std::string quote(std::string const& s)
+		{
+			std::string r;
+			for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+			{
+				if (*it == '"')
+					r += '"';
+				r += *it;
+			}
+			return r;
+		}
+
+		pthread_mutex_t m_mutex; ///< protect the registry
+		pthread_key_t m_key; ///< timer buffer of the current thread
+		std::vector<InstrumentThreadBuffer*> m_vBuffer; ///< timer buffers of all threads
+		std::map<std::string, InstrumentCounter*> m_mCounter; ///< counters by name
+		std::map<std::string, InstrumentHistogram*> m_mHistogram; ///< histograms by name
+		std::map<std::string, InstrumentGauge*> m_mGauge; ///< gauges by name
+};
+
+/// @brief timer recording the wall time of a scope under the path of the enclosing timers of the thread
+class ScopedTimer
+{
+	public:
+		/// @brief constructor, start the timer
+		/// @param name name of the scope
+		explicit ScopedTimer(const char* name)
+			: m_buffer(Instrument::instance().buffer())
+			, m_parentLength(m_buffer.path.size())
+		{
+			if (m_parentLength)
+				m_buffer.path += '/';
+			m_buffer.path += name;
+			m_start = Instrument::wall_time();
+		}
+		/// @brief destructor, stop the timer
+		~ScopedTimer()
+		{
+			double elapsed = Instrument::wall_time()-m_start;
+			pthread_mutex_lock(&m_buffer.mutex);
+			InstrumentTimerStat& stat = m_buffer.mTimer[m_buffer.path];
+			stat.count += 1;
+			stat.total += elapsed;
+			stat.max = std::max(stat.max, elapsed);
+			pthread_mutex_unlock(&m_buffer.mutex);
+			m_buffer.path.resize(m_parentLength);
+		}
+	protected:
+		/// copy is not allowed
+		ScopedTimer(ScopedTimer const&);
+		/// assignment is not allowed
+		ScopedTimer& operator=(ScopedTimer const&);
+
+		InstrumentThreadBuffer& m_buffer; ///< buffer of the thread
+		std::string::size_type m_parentLength; ///< length of the path of the enclosing timer
+		double m_start; ///< start time
+};
+
+/// @brief counter of the allocations of the calling thread in a scope and the peak heap of the process.
+/// Adds to counters "<name>::allocations" and "<name>::allocated bytes", and sets gauge "<name>::peak heap".
+/// The peak is that of the whole process while the scope runs, which includes other threads.
+class ScopedAllocations
+{
+	public:
+		/// @brief constructor, start counting
+		/// @param name name of the scope
+		explicit ScopedAllocations(const char* name)
+			: m_name(name)
+			, m_count(InstrumentHeap::thread_stat().count)
+			, m_bytes(InstrumentHeap::thread_stat().bytes)
+			, m_outerPeak(InstrumentHeap::reset_peak())
+		{
+		}
+		/// @brief destructor, stop counting
+		~ScopedAllocations()
+		{
+			InstrumentAllocationStat const& stat = InstrumentHeap::thread_stat();
+			long long peak = __sync_fetch_and_add(&InstrumentHeap::peak(), 0);
+			Instrument& inst = Instrument::instance();
+			inst.counter((m_name+"::allocations").c_str())->add(stat.count-m_count);
+			inst.counter((m_name+"::allocated bytes").c_str())->add(stat.bytes-m_bytes);
+			inst.gauge((m_name+"::peak heap").c_str())->set(peak);
+			// enclosing scopes keep the larger peak
+			InstrumentHeap::raise_peak(m_outerPeak);
+		}
+	protected:
+		/// copy is not allowed
+		ScopedAllocations(ScopedAllocations const&);
+		/// assignment is not allowed
+		ScopedAllocations& operator=(ScopedAllocations const&);
+
+		std::string m_name; ///< name of the scope
+		unsigned long long m_count; ///< number of allocations of the thread at the start
+		unsigned long long m_bytes; ///< bytes allocated by the thread at the start
+		long long m_outerPeak; ///< peak heap before the scope
+};
+
+} // namespace limbo
+
+/// @cond
+#if __cplusplus >= 201103L
+#define LIMBO_INSTRUMENT_NOTHROW noexcept
+#define LIMBO_INSTRUMENT_THROW_BAD_ALLOC
+#else
+#define LIMBO_INSTRUMENT_NOTHROW throw()
+#define LIMBO_INSTRUMENT_THROW_BAD_ALLOC throw(std::bad_alloc)
+#endif
+/// @endcond
+
+/// @def limboScopedTimer(name)
+/// @brief time the enclosing scope, name must be a string literal or alive until the scope ends
+#define limboScopedTimer(name) ::limbo::ScopedTimer LIMBO_INSTRUMENT_CONCAT(limboScopedTimer, __LINE__) (name)
+/// @def limboCounterAdd(name, value)
+/// @brief add a value to a counter, name is looked up once per call site
+#define limboCounterAdd(name, value) do {\
+    static ::limbo::InstrumentCounter* limboCounter = ::limbo::Instrument::instance().counter(name); \
+    limboCounter->add(value); \
+} while (false)
+/// @def limboHistogramAdd(name, value)
+/// @brief add a value to a histogram, name is looked up once per call site
+#define limboHistogramAdd(name, value) do {\
+    static ::limbo::InstrumentHistogram* limboHistogram = ::limbo::Instrument::instance().histogram(name); \
+    limboHistogram->add(value); \
+} while (false)
+/// @def limboInstrumentWrite(fileName)
+/// @brief write a report, in CSV if fileName ends with ".csv", otherwise in JSON; true if written
+#define limboInstrumentWrite(fileName) ::limbo::Instrument::instance().write(fileName)
+/// @def limboMemoryRecord(usage)
+/// @brief set gauges "memory/<category>" from a @ref limbo::MemoryUsage, the peak is kept over records
+#define limboMemoryRecord(usage) ::limbo::Instrument::instance().record(usage)
+/// @def limboScopedAllocations(name)
+/// @brief count allocations in the enclosing scope, see @ref limbo::ScopedAllocations
+#define limboScopedAllocations(name) ::limbo::ScopedAllocations LIMBO_INSTRUMENT_CONCAT(limboScopedAllocations, __LINE__) (name)
+/// @def limboDefineAllocationHooks()
+/// @brief replace global operator new and delete to count allocations, expand once at namespace scope of a program
+#define limboDefineAllocationHooks() \
+void* operator new(std::size_t n) LIMBO_INSTRUMENT_THROW_BAD_ALLOC \
+{ \
+    if (void* p = ::limbo::InstrumentHeap::allocate(n)) \
+        return p; \
+    throw std::bad_alloc(); \
+} \
+void* operator new[](std::size_t n) LIMBO_INSTRUMENT_THROW_BAD_ALLOC \
+{ \
+    if (void* p = ::limbo::InstrumentHeap::allocate(n)) \
+        return p; \
+    throw std::bad_alloc(); \
+} \
+void* operator new(std::size_t n, std::nothrow_t const&) LIMBO_INSTRUMENT_NOTHROW {return ::limbo::InstrumentHeap::allocate(n);} \
+void* operator new[](std::size_t n, std::nothrow_t const&) LIMBO_INSTRUMENT_NOTHROW {return ::limbo::InstrumentHeap::allocate(n);} \
+void operator delete(void* p) LIMBO_INSTRUMENT_NOTHROW {::limbo::InstrumentHeap::deallocate(p);} \
+void operator delete[](void* p) LIMBO_INSTRUMENT_NOTHROW {::limbo::InstrumentHeap::deallocate(p);} \
+void operator delete(void* p, std::nothrow_t const&) LIMBO_INSTRUMENT_NOTHROW {::limbo::InstrumentHeap::deallocate(p);} \
+void operator delete[](void* p, std::nothrow_t const&) LIMBO_INSTRUMENT_NOTHROW {::limbo::InstrumentHeap::deallocate(p);} \
+struct limboAllocationHooksDefined
+
+#else
+
+/// @cond
+#define limboScopedTimer(name) do {} while (false)
+#define limboCounterAdd(name, value) do {static_cast<void>(sizeof(value));} while (false)
+#define limboHistogramAdd(name, value) do {static_cast<void>(sizeof(value));} while (false)
+#define limboInstrumentWrite(fileName) (static_cast<void>(fileName), false)
+#define limboMemoryRecord(usage) static_cast<void>(sizeof(usage))
+#define limboScopedAllocations(name) do {} while (false)
+#define limboDefineAllocationHooks() struct limboAllocationHooksDefined
+/// @endcond
+
+#endif
+
+#endif
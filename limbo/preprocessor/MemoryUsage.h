@@ -0,0 +1,107 @@
+/**
+ * @file   MemoryUsage.h
+ * @brief  bytes of data structures by category, reported by the structures themselves
+ *
+ * Major structures such as @ref GdsParser::GdsDB::GdsDB, @ref limbo::solvers::LinearModel,
+ * @ref limbo::algorithms::coloring::GraphSimplification and @ref limbo::algorithms::partition::FM
+ * add their heap and object bytes to a @ref limbo::MemoryUsage under categories like "GdsDB/polygons".
+ * The bytes are computed from sizes and capacities of containers, not measured from the allocator,
+ * so they do not include allocator overhead and are available without instrumentation.
+ * With LIMBO_INSTRUMENT, limboMemoryRecord in @ref Instrument.h records them as gauges of the report.
+ *
+ * example usage:
+ * ~~~~~~~~~~~~~~~~
+ * limbo::MemoryUsage usage;
+ * db.memoryUsage(usage);
+ * model.memoryUsage(usage);
+ * usage.print();
+ * limboMemoryRecord(usage);
+ * ~~~~~~~~~~~~~~~~
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_PREPROCESSOR_MEMORYUSAGE_H
+#define LIMBO_PREPROCESSOR_MEMORYUSAGE_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+
+/// namespace for Limbo
+namespace limbo
+{
+
+/// @brief bytes of data structures by category
+class MemoryUsage
+{
+	public:
+		/// @brief map from category to bytes
+		typedef std::map<std::string, std::size_t> map_type;
+
+		/// @brief add bytes to a category
+		/// @param category name of category, usually "Structure/part"
+		/// @param bytes number of bytes
+		void add(std::string const& category, std::size_t bytes) {m_mBytes[category] += bytes;}
+		/// @brief add all categories of another report
+		/// @param rhs another report
+		void add(MemoryUsage const& rhs)
+		{
+			for (map_type::const_iterator it = rhs.m_mBytes.begin(); it != rhs.m_mBytes.end(); ++it)
+				m_mBytes[it->first] += it->second;
+		}
+		/// @return bytes of a category, 0 if not reported
+		std::size_t bytes(std::string const& category) const
+		{
+			map_type::const_iterator found = m_mBytes.find(category);
+			return (found == m_mBytes.end())? 0 : found->second;
+		}
+		/// @return bytes of all categories
+		std::size_t total() const
+		{
+			std::size_t sum = 0;
+			for (map_type::const_iterator it = m_mBytes.begin(); it != m_mBytes.end(); ++it)
+				sum += it->second;
+			return sum;
+		}
+		/// @return bytes by category in the order of names
+		map_type const& categories() const {return m_mBytes;}
+		/// @brief remove all categories
+		void clear() {m_mBytes.clear();}
+		/// @brief print a table of categories in MB and the total
+		/// @param fp output stream
+		void print(FILE* fp = stdout) const
+		{
+			for (map_type::const_iterator it = m_mBytes.begin(); it != m_mBytes.end(); ++it)
+				fprintf(fp, "%-40s %12.3f MB\n", it->first.c_str(), it->second/1048576.0);
+			fprintf(fp, "%-40s %12.3f MB\n", "total", this->total()/1048576.0);
+		}
+	protected:
+		map_type m_mBytes; ///< bytes by category
+};
+
+/// @name heap bytes of containers
+/// Bytes a container owns beyond its own object, from the capacity.
+///@{
+/// @return bytes of elements of a vector
+template <typename T>
+inline std::size_t heap_bytes(std::vector<T> const& v) {return v.capacity()*sizeof(T);}
+/// @return bytes of a vector of bits
+inline std::size_t heap_bytes(std::vector<bool> const& v) {return (v.capacity()+7)/8;}
+/// @return bytes of a string, 0 if the string is short enough to be stored in the object itself
+inline std::size_t heap_bytes(std::string const& s) {return (s.capacity() > 15)? s.capacity()+1 : 0;}
+/// @return bytes of a vector of vectors, including the inner elements
+template <typename T>
+inline std::size_t heap_bytes(std::vector<std::vector<T> > const& v)
+{
+	std::size_t bytes = v.capacity()*sizeof(std::vector<T>);
+	for (typename std::vector<std::vector<T> >::const_iterator it = v.begin(); it != v.end(); ++it)
+		bytes += heap_bytes(*it);
+	return bytes;
+}
+///@}
+
+} // namespace limbo
+
+#endif
@@ -10,6 +10,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 
 #ifndef LIMBO_PREPROCESSOR_PRINTMSG_H
 #define LIMBO_PREPROCESSOR_PRINTMSG_H
@@ -37,11 +38,62 @@ int limboVPrintStream(MessageType m, FILE* stream, const char* format, va_list a
 int limboSPrint(MessageType m, char* buf, const char* format, ...);
 int limboVSPrint(MessageType m, char* buf, const char* format, va_list args);
 int limboSPrintPrefix(MessageType m, char* prefix);
+bool limboPrintAdmit(MessageType m, FILE* stream);
+int limboPrintWrite(MessageType m, FILE* stream, const char* text, std::size_t length);
 void limboPrintAssertMsg(const char* expr, const char* fileName, unsigned lineNum, const char* funcName, const char* format, ...);
 void limboPrintAssertMsg(const char* expr, const char* fileName, unsigned lineNum, const char* funcName);
 /// @endcond
 
 
+/// @brief settings of print functions shared by all threads 
+struct PrintConfig 
+{
+    unsigned int mask; ///< bit m is set if messages of type m are printed 
+    unsigned long rateLimit; ///< maximum number of messages per second, 0 for no limit; errors and assertions are never limited 
+    long window; ///< second of the current rate limiting window 
+    unsigned long count; ///< number of messages in the current window 
+    unsigned long suppressed; ///< number of messages dropped in the current window 
+    FILE* suppressedStream; ///< stream of the first message dropped in the current window, where drops are reported 
+    /// output back end replacing synchronous writes if not NULL, e.g., installed by @ref limboStartAsyncPrint 
+    int (*sink)(FILE* stream, const char* text, std::size_t length); 
+    /// write pending messages of the back end, called before assertion messages 
+    void (*flush)(); 
+};
+
+/// @return settings of print functions 
+inline PrintConfig& limboPrintConfig()
+{
+    static PrintConfig config = {~0U, 0, 0, 0, 0, NULL, NULL, NULL}; 
+    return config; 
+}
+
+/// @brief enable or disable a message type at runtime; disabled messages are not formatted 
+/// @param m message type 
+/// @param enable whether to print 
+inline void limboSetPrintLevel(MessageType m, bool enable)
+{
+    if (enable)
+        __sync_fetch_and_or(&limboPrintConfig().mask, 1U << m); 
+    else 
+        __sync_fetch_and_and(&limboPrintConfig().mask, ~(1U << m)); 
+}
+
+/// @param m message type 
+/// @return true if messages of the type are printed 
+inline bool limboPrintEnabled(MessageType m)
+{
+    return (*(volatile unsigned int*)&limboPrintConfig().mask >> m) & 1U; 
+}
+
+/// @brief limit the number of messages per second; further messages in the same second are dropped 
+/// and counted in a warning at the start of the next second with a message. 
+/// Errors and assertions are never dropped. 
+/// @param maxPerSecond maximum number of messages per second, 0 for no limit 
+inline void limboSetPrintRateLimit(unsigned long maxPerSecond)
+{
+    limboPrintConfig().rateLimit = maxPerSecond; 
+}
+
 /// @brief formatted print with prefix 
 /// @param m prefix message 
 /// @param format refer to the usage of printf 
@@ -79,20 +131,87 @@ inline int limboPrintStream(MessageType m, FILE* stream, const char* format, ...
 /// @return 
 inline int limboVPrintStream(MessageType m, FILE* stream, const char* format, va_list args)
 {
+    // skip formatting of disabled and dropped messages 
+    if (!limboPrintEnabled(m) || !limboPrintAdmit(m, stream))
+        return 0; 
+
 	// print prefix 
-    char prefix[8];
-    limboSPrintPrefix(m, prefix);
-    // merge prefix and format 
-    char formatBuf[256];
-    sprintf(formatBuf, "%s%s", prefix, format);
+    char buf[1024];
+    limboSPrintPrefix(m, buf);
+    int prefixLength = strlen(buf); 
+    // format the whole message first, so it is written at once 
+    va_list argsCopy; 
+    __builtin_va_copy(argsCopy, args); // va_copy is not in C++98 
+    int length = vsnprintf(buf+prefixLength, sizeof(buf)-prefixLength, format, argsCopy); 
+    va_end(argsCopy); 
+    if (length < 0)
+        return length; 
+    length += prefixLength; 
+    if ((std::size_t)length < sizeof(buf))
+        return limboPrintWrite(m, stream, buf, length); 
 
-	// print message 
-    // only print once to ensure multi-thread safe 
-    int ret = vfprintf(stream, formatBuf, args);
+    // long message 
+    char* longBuf = (char*)malloc(length+1); 
+    if (longBuf == NULL)
+        return -1; 
+    memcpy(longBuf, buf, prefixLength); 
+    vsnprintf(longBuf+prefixLength, length+1-prefixLength, format, args); 
+    int ret = limboPrintWrite(m, stream, longBuf, length); 
+    free(longBuf); 
 	
 	return ret;
 }
 
+/// @brief write a formatted message to the back end, or to the stream directly if there is no back end 
+/// @param m message type 
+/// @param stream output stream 
+/// @param text message 
+/// @param length length of message 
+/// @return number of characters written 
+inline int limboPrintWrite(MessageType m, FILE* stream, const char* text, std::size_t length)
+{
+    PrintConfig const& config = limboPrintConfig(); 
+    if (config.sink && m != kASSERT)
+        return config.sink(stream, text, length); 
+    // pending messages come before an assertion message 
+    if (config.flush)
+        config.flush(); 
+    // one write per message, as stdio locks the stream for each call 
+    return fwrite(text, 1, length, stream); 
+}
+
+/// @brief count a message for rate limiting 
+/// @param m message type 
+/// @param stream output stream of the message 
+/// @return true if the message is printed 
+inline bool limboPrintAdmit(MessageType m, FILE* stream)
+{
+    PrintConfig& config = limboPrintConfig(); 
+    if (config.rateLimit == 0 || m == kERROR || m == kASSERT)
+        return true; 
+    long now = time(NULL); 
+    long window = config.window; 
+    if (now != window && __sync_bool_compare_and_swap(&config.window, window, now))
+    {
+        // the first message of a new second reports drops of the previous one 
+        unsigned long suppressed = __sync_lock_test_and_set(&config.suppressed, 0); 
+        FILE* suppressedStream = __sync_lock_test_and_set(&config.suppressedStream, (FILE*)NULL); 
+        __sync_lock_test_and_set(&config.count, 0); 
+        if (suppressed)
+        {
+            char buf[128]; 
+            int length = limboSPrintPrefix(kWARN, buf); 
+            length += sprintf(buf+length, "%lu messages suppressed by rate limit\n", suppressed); 
+            limboPrintWrite(kWARN, suppressedStream? suppressedStream : stream, buf, length); 
+        }
+    }
+    if (__sync_add_and_fetch(&config.count, 1) <= config.rateLimit)
+        return true; 
+    __sync_bool_compare_and_swap(&config.suppressedStream, (FILE*)NULL, stream); 
+    __sync_fetch_and_add(&config.suppressed, 1); 
+    return false; 
+}
+
 /// @brief formatted print with prefix to buffer  
 /// @param m prefix message 
 /// @param buf buffer 
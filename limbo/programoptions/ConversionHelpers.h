@@ -12,9 +12,11 @@
 #define _LIMBO_PROGRAMOPTIONS_CONVERSIONHELPERS_H
 
 #include <iostream>
+#include <cstring>
 #include <vector>
 #include <set>
 #include <limbo/string/String.h>
+#include <limbo/string/CharConv.h>
 
 /// @brief namespace for Limbo
 namespace limbo 
@@ -95,6 +97,21 @@ struct boolean_helper
 };
 
 /////////////////// specialization for parse_helper /////////////////
+/// @brief parse a whole char-based string as a number with @ref limbo::from_chars
+/// @param target target data, unchanged on failure
+/// @param value char-based string
+/// @return false if the string is not a number in the range of the type
+template <typename T>
+inline bool parse_number(T& target, const char* value)
+{
+    const char* last = value+std::strlen(value);
+    T v;
+    limbo::from_chars_result result = limbo::from_chars(value, last, v);
+    if (result.ec != 0 || result.ptr != last)
+        return false;
+    target = v;
+    return true;
+}
 /**
  * @brief template specialization for boolean type to struct @ref limbo::programoptions::parse_helper
  */
@@ -155,8 +172,7 @@ struct parse_helper<int>
     /// @param value char-based string 
     inline bool operator()(int& target, const char* value) const
     {
-        target = atoi(value);
-        return true;
+        return parse_number(target, value);
     }
 };
 /**
@@ -170,8 +186,7 @@ struct parse_helper<unsigned int>
     /// @param value char-based string 
     inline bool operator()(unsigned int& target, const char* value) const
     {
-        target = atoi(value);
-        return true;
+        return parse_number(target, value);
     }
 };
 /**
@@ -185,8 +200,7 @@ struct parse_helper<long>
     /// @param value char-based string 
     inline bool operator()(long& target, const char* value) const
     {
-        target = atol(value);
-        return true;
+        return parse_number(target, value);
     }
 };
 /**
@@ -200,8 +214,7 @@ struct parse_helper<unsigned long>
     /// @param value char-based string 
     inline bool operator()(unsigned long& target, const char* value) const
     {
-        target = atol(value);
-        return true;
+        return parse_number(target, value);
     }
 };
 /**
@@ -215,8 +228,7 @@ struct parse_helper<long long>
     /// @param value char-based string 
     inline bool operator()(long long& target, const char* value) const
     {
-        target = atol(value);
-        return true;
+        return parse_number(target, value);
     }
 };
 /**
@@ -230,8 +242,7 @@ struct parse_helper<unsigned long long>
     /// @param value char-based string 
     inline bool operator()(unsigned long long& target, const char* value) const
     {
-        target = atol(value);
-        return true;
+        return parse_number(target, value);
     }
 };
 /**
@@ -245,8 +256,7 @@ struct parse_helper<float>
     /// @param value char-based string 
     inline bool operator()(float& target, const char* value) const
     {
-        target = atof(value);
-        return true;
+        return parse_number(target, value);
     }
 };
 /**
@@ -260,8 +270,7 @@ struct parse_helper<double>
     /// @param value char-based string 
     inline bool operator()(double& target, const char* value) const
     {
-        target = atof(value);
-        return true;
+        return parse_number(target, value);
     }
 };
 /**
@@ -277,7 +286,8 @@ struct parse_helper<std::vector<T> >
     inline bool operator()(std::vector<T>& target, const char* value) const
     {
         T v;
-        parse_helper<T>()(v, value);
+        if (!parse_helper<T>()(v, value))
+            return false;
         target.push_back(v);
         return true;
     }
@@ -295,7 +305,8 @@ struct parse_helper<std::set<T> >
     inline bool operator()(std::set<T>& target, const char* value) const
     {
         T v;
-        parse_helper<T>()(v, value);
+        if (!parse_helper<T>()(v, value))
+            return false;
         target.insert(v);
         return true;
     }
@@ -0,0 +1,453 @@
+/**
+ * @file   OptionTable.h
+ * @brief  static tables of options parsed without allocation
+ *
+ * @ref limbo::programoptions::ProgramOptions keeps each option as a heap-allocated polymorphic value bound to one variable,
+ * which suits a command line parsed once.
+ * An @ref limbo::programoptions::OptionTable instead describes the members of a struct with a static array of entries,
+ * each with a pointer to member and a type tag, so one table parses options into any number of structs,
+ * e.g., one per job, with no allocation and no virtual calls.
+ * Arguments are read as views, and numbers are converted with @ref limbo::from_chars.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_PROGRAMOPTIONS_OPTIONTABLE_H
+#define _LIMBO_PROGRAMOPTIONS_OPTIONTABLE_H
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cctype>
+#include <algorithm>
+#include <boost/utility/string_ref.hpp>
+#include <limbo/string/CharConv.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+/// @brief namespace for Limbo.ProgramOptions
+namespace programoptions
+{
+
+/// @brief type of the member set by an option
+enum OptionKind
+{
+    OPTION_BOOL,
+    OPTION_INT,
+    OPTION_UNSIGNED,
+    OPTION_LONG,
+    OPTION_UNSIGNED_LONG,
+    OPTION_LONG_LONG,
+    OPTION_UNSIGNED_LONG_LONG,
+    OPTION_FLOAT,
+    OPTION_DOUBLE,
+    OPTION_STRING, ///< std::string, assigned a copy of the argument
+    OPTION_STRING_REF ///< boost::string_ref, a view of the argument, valid as long as the arguments
+};
+
+/// @brief flags of an option
+enum OptionFlag
+{
+    OPTION_REQUIRED = 1, ///< the option must be given, unless a help option is given
+    OPTION_HELP = 2 ///< giving the option skips the check of required options
+};
+
+/// @brief error of @ref limbo::programoptions::OptionTable::parse
+enum OptionError
+{
+    OPTION_OK, ///< no error
+    OPTION_UNKNOWN, ///< unknown option
+    OPTION_MISSING_VALUE, ///< no argument after an option taking a value
+    OPTION_INVALID_VALUE, ///< argument cannot be converted to the type of the option
+    OPTION_MISSING_REQUIRED ///< a required option is not given
+};
+
+/// @brief pointer to the member set by an option, one field per @ref OptionKind
+template <typename Options>
+union OptionMember
+{
+    bool Options::* b; ///< @ref OPTION_BOOL
+    int Options::* i; ///< @ref OPTION_INT
+    unsigned int Options::* u; ///< @ref OPTION_UNSIGNED
+    long Options::* l; ///< @ref OPTION_LONG
+    unsigned long Options::* ul; ///< @ref OPTION_UNSIGNED_LONG
+    long long Options::* ll; ///< @ref OPTION_LONG_LONG
+    unsigned long long Options::* ull; ///< @ref OPTION_UNSIGNED_LONG_LONG
+    float Options::* f; ///< @ref OPTION_FLOAT
+    double Options::* d; ///< @ref OPTION_DOUBLE
+    std::string Options::* s; ///< @ref OPTION_STRING
+    boost::string_ref Options::* sr; ///< @ref OPTION_STRING_REF
+};
+
+/// @name bind a pointer to member to @ref OptionMember
+/// @return kind of the member
+///@{
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, bool Options::* p) {m.b = p; return OPTION_BOOL;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, int Options::* p) {m.i = p; return OPTION_INT;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, unsigned int Options::* p) {m.u = p; return OPTION_UNSIGNED;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, long Options::* p) {m.l = p; return OPTION_LONG;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, unsigned long Options::* p) {m.ul = p; return OPTION_UNSIGNED_LONG;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, long long Options::* p) {m.ll = p; return OPTION_LONG_LONG;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, unsigned long long Options::* p) {m.ull = p; return OPTION_UNSIGNED_LONG_LONG;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, float Options::* p) {m.f = p; return OPTION_FLOAT;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, double Options::* p) {m.d = p; return OPTION_DOUBLE;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, std::string Options::* p) {m.s = p; return OPTION_STRING;}
+template <typename Options> inline OptionKind bind_member(OptionMember<Options>& m, boost::string_ref Options::* p) {m.sr = p; return OPTION_STRING_REF;}
+///@}
+
+/// @brief an option of a table, usually made with @ref option or @ref toggle_option
+/// @tparam Options struct holding the values of options
+template <typename Options>
+struct OptionEntry
+{
+    const char* name; ///< option name in the command line, e.g., "-i"
+    const char* msg; ///< help message
+    const char* defaultValue; ///< default value as text, NULL if none
+    const char* toggleValue; ///< value as text set by the option alone, NULL if the option takes an argument
+    unsigned int flags; ///< combination of @ref OptionFlag
+    OptionKind kind; ///< type of the member
+    OptionMember<Options> member; ///< member set by the option
+};
+
+/// @brief make an option taking an argument
+/// @param name option name in the command line
+/// @param member member set by the option
+/// @param msg help message
+/// @param defaultValue default value as text, NULL if none
+/// @param flags combination of @ref OptionFlag
+template <typename Options, typename T>
+inline OptionEntry<Options> option(const char* name, T Options::* member, const char* msg, const char* defaultValue = NULL, unsigned int flags = 0)
+{
+    OptionEntry<Options> entry;
+    entry.name = name;
+    entry.msg = msg;
+    entry.defaultValue = defaultValue;
+    entry.toggleValue = NULL;
+    entry.flags = flags;
+    entry.kind = bind_member(entry.member, member);
+    return entry;
+}
+/// @brief make an option taking no argument
+/// @param name option name in the command line
+/// @param member member set by the option
+/// @param msg help message
+/// @param toggleValue value as text set when the option is given
+/// @param defaultValue default value as text, NULL if none
+/// @param flags combination of @ref OptionFlag
+template <typename Options, typename T>
+inline OptionEntry<Options> toggle_option(const char* name, T Options::* member, const char* msg, const char* toggleValue = "true", const char* defaultValue = "false", unsigned int flags = 0)
+{
+    OptionEntry<Options> entry = option(name, member, msg, defaultValue, flags);
+    entry.toggleValue = toggleValue;
+    return entry;
+}
+
+/// @brief outcome of @ref limbo::programoptions::OptionTable::parse
+struct OptionResult
+{
+    OptionError error; ///< error code
+    boost::string_ref token; ///< argument or option name causing the error
+
+    /// @return true if parsing succeeds
+    bool ok() const {return error == OPTION_OK;}
+};
+
+/**
+ * @class limbo::programoptions::OptionTable
+ * @brief parse options into a struct by a static table of entries
+ *
+ * The table only refers to the array of entries, so the array should be static.
+ * Parsing applies default values, sets members by the arguments in order, and checks required options.
+ * It allocates nothing except when assigning @ref OPTION_STRING members, and is safe to call from several threads.
+ *
+ * @code
+ * struct JobOptions {bool help; int threads; double eps; std::string output;};
+ * static const OptionEntry<JobOptions> vEntry[] = {
+ *     toggle_option("-help", &JobOptions::help, "print help message", "true", "false", OPTION_HELP),
+ *     option("-threads", &JobOptions::threads, "number of threads", "1"),
+ *     option("-eps", &JobOptions::eps, "tolerance", "1e-6"),
+ *     option("-out", &JobOptions::output, "output file", NULL, OPTION_REQUIRED)
+ * };
+ * static const OptionTable<JobOptions> table (vEntry, "Job options");
+ * JobOptions opts;
+ * OptionResult result = table.parse(opts, "-threads 4 -out \"a b.txt\"");
+ * @endcode
+ *
+ * @tparam Options struct holding the values of options
+ */
+template <typename Options>
+class OptionTable
+{
+    public:
+        /// type of entries
+        typedef OptionEntry<Options> entry_type;
+        /// maximum number of entries
+        enum {MAX_OPTIONS = 256};
+
+        /// @brief constructor
+        /// @param vEntry static array of entries
+        /// @param title title of help message
+        template <std::size_t N>
+        explicit OptionTable(entry_type const (&vEntry)[N], const char* title = "Available options")
+            : m_vEntry(vEntry)
+            , m_size(N)
+            , m_title(title)
+        {
+            limboAssertMsg(N <= MAX_OPTIONS, "at most %d options in a table", (int)MAX_OPTIONS);
+        }
+
+        /// @return number of entries
+        std::size_t size() const {return m_size;}
+        /// @return entry of an option name, NULL if not found
+        entry_type const* find(boost::string_ref name) const
+        {
+            for (std::size_t i = 0; i < m_size; ++i)
+            {
+                // compare lengths first, as most names differ in length
+                if (std::strlen(m_vEntry[i].name) == name.size() && name.compare(m_vEntry[i].name) == 0)
+                    return &m_vEntry[i];
+            }
+            return NULL;
+        }
+
+        /// @brief parse command line arguments, skipping the program name as @ref ProgramOptions::parse does
+        /// @param options struct to set
+        /// @param argc number of arguments
+        /// @param argv values of arguments
+        /// @return outcome of parsing
+        OptionResult parse(Options& options, int argc, char const* const* argv) const
+        {
+            ArgvTokens tokens (argc, argv);
+            return parse_tokens(options, tokens);
+        }
+        /// @brief parse an option string with arguments separated by white spaces;
+        /// an argument in double quotes may contain white spaces
+        /// @param options struct to set
+        /// @param line option string, @ref OPTION_STRING_REF members refer to it
+        /// @return outcome of parsing
+        OptionResult parse(Options& options, boost::string_ref line) const
+        {
+            LineTokens tokens (line);
+            return parse_tokens(options, tokens);
+        }
+        /// @brief parse an option string
+        /// @param options struct to set
+        /// @param line null-terminated option string
+        /// @return outcome of parsing
+        OptionResult parse(Options& options, const char* line) const
+        {
+            return parse(options, boost::string_ref(line));
+        }
+
+        /// @brief print help message in the layout of @ref ProgramOptions::print
+        /// @param os output stream
+        void print(std::ostream& os) const
+        {
+            static const unsigned cat_prefix_spaces = 2;
+            static const unsigned cat_option_spaces = 4;
+
+            std::size_t max_cat_count = 0;
+            for (std::size_t i = 0; i < m_size; ++i)
+                max_cat_count = std::max(max_cat_count, placeholder_length(m_vEntry[i]));
+
+            os << m_title << ":" << std::endl;
+            for (std::size_t i = 0; i < m_size; ++i)
+            {
+                entry_type const& entry = m_vEntry[i];
+                os << std::string(cat_prefix_spaces, ' ') << entry.name;
+                if (entry.defaultValue)
+                    os << " (" << entry.defaultValue << ")";
+                os << std::string(max_cat_count-placeholder_length(entry)+cat_option_spaces, ' ') << entry.msg << "\n";
+            }
+        }
+        /// @brief print help message
+        /// @param os output stream
+        /// @param rhs target object
+        /// @return output stream
+        friend std::ostream& operator<<(std::ostream& os, OptionTable const& rhs)
+        {
+            rhs.print(os);
+            return os;
+        }
+
+        /// @brief set a member from text
+        /// @param options struct to set
+        /// @param entry option
+        /// @param value text of the value
+        /// @return true if the text is valid for the type of the member
+        static bool assign(Options& options, entry_type const& entry, boost::string_ref value)
+        {
+            const char* first = value.data();
+            const char* last = first+value.size();
+            switch (entry.kind)
+            {
+                case OPTION_BOOL:
+                    {
+                        bool& target = options.*entry.member.b;
+                        if (iequals(value, "true") || value == "1")
+                            target = true;
+                        else if (iequals(value, "false") || value == "0")
+                            target = false;
+                        else return false;
+                        return true;
+                    }
+                case OPTION_INT: return convert(first, last, options.*entry.member.i);
+                case OPTION_UNSIGNED: return convert(first, last, options.*entry.member.u);
+                case OPTION_LONG: return convert(first, last, options.*entry.member.l);
+                case OPTION_UNSIGNED_LONG: return convert(first, last, options.*entry.member.ul);
+                case OPTION_LONG_LONG: return convert(first, last, options.*entry.member.ll);
+                case OPTION_UNSIGNED_LONG_LONG: return convert(first, last, options.*entry.member.ull);
+                case OPTION_FLOAT: return convert(first, last, options.*entry.member.f);
+                case OPTION_DOUBLE: return convert(first, last, options.*entry.member.d);
+                case OPTION_STRING: (options.*entry.member.s).assign(first, value.size()); return true;
+                case OPTION_STRING_REF: options.*entry.member.sr = value; return true;
+                default: return false;
+            }
+        }
+    protected:
+        /// @brief arguments from argc and argv
+        struct ArgvTokens
+        {
+            int argc; ///< number of arguments
+            char const* const* argv; ///< values of arguments
+            int i; ///< next argument
+
+            /// @brief constructor
+            ArgvTokens(int c, char const* const* v) : argc(c), argv(v), i(1) {}
+            /// @brief get the next argument
+            /// @return false if none is left
+            bool next(boost::string_ref& token)
+            {
+                if (i >= argc)
+                    return false;
+                token = boost::string_ref(argv[i++]);
+                return true;
+            }
+        };
+        /// @brief arguments separated by white spaces in a string
+        struct LineTokens
+        {
+            const char* p; ///< current position
+            const char* last; ///< end of string
+
+            /// @brief constructor
+            explicit LineTokens(boost::string_ref line) : p(line.data()), last(line.data()+line.size()) {}
+            /// @return true if c is a white space
+            static bool space(char c) {return c == ' ' || c == '\t' || c == '\n' || c == '\r';}
+            /// @brief get the next argument, without the quotes if quoted
+            /// @return false if none is left
+            bool next(boost::string_ref& token)
+            {
+                while (p != last && space(*p))
+                    ++p;
+                if (p == last)
+                    return false;
+                const char* first = p;
+                if (*p == '"')
+                {
+                    ++first;
+                    p = std::find(first, last, '"');
+                    token = boost::string_ref(first, p-first);
+                    if (p != last) // skip the closing quote
+                        ++p;
+                }
+                else
+                {
+                    while (p != last && !space(*p))
+                        ++p;
+                    token = boost::string_ref(first, p-first);
+                }
+                return true;
+            }
+        };
+
+        /// @brief convert a whole text to a number
+        template <typename T>
+        static bool convert(const char* first, const char* last, T& target)
+        {
+            T value;
+            from_chars_result result = limbo::from_chars(first, last, value);
+            if (result.ec || result.ptr != last || first == last)
+                return false;
+            target = value;
+            return true;
+        }
+        /// @return true if two strings are equal ignoring case
+        static bool iequals(boost::string_ref s, const char* t)
+        {
+            std::size_t i = 0;
+            for (; i < s.size() && t[i]; ++i)
+            {
+                if (std::tolower((unsigned char)s[i]) != std::tolower((unsigned char)t[i]))
+                    return false;
+            }
+            return i == s.size() && !t[i];
+        }
+        /// @return number of characters of an option name and its default value in help message
+        static std::size_t placeholder_length(entry_type const& entry)
+        {
+            return std::strlen(entry.name)+((entry.defaultValue)? std::strlen(entry.defaultValue)+3 : 0);
+        }
+        /// @brief parse arguments from a source of tokens
+        template <typename Tokens>
+        OptionResult parse_tokens(Options& options, Tokens& tokens) const
+        {
+            OptionResult result;
+            result.error = OPTION_OK;
+            // defaults first, so given options override them without tracking which are given
+            for (std::size_t i = 0; i < m_size; ++i)
+            {
+                if (m_vEntry[i].defaultValue)
+                {
+                    bool valid = assign(options, m_vEntry[i], boost::string_ref(m_vEntry[i].defaultValue));
+                    limboAssertMsg(valid, "invalid default value %s of option %s", m_vEntry[i].defaultValue, m_vEntry[i].name);
+                }
+            }
+
+            bool vGiven[MAX_OPTIONS];
+            std::fill(vGiven, vGiven+m_size, false);
+            bool help = false;
+            boost::string_ref token;
+            while (tokens.next(token))
+            {
+                entry_type const* entry = find(token);
+                if (entry == NULL)
+                    return fail(result, OPTION_UNKNOWN, token);
+                boost::string_ref value;
+                if (entry->toggleValue)
+                    value = boost::string_ref(entry->toggleValue);
+                else if (!tokens.next(value))
+                    return fail(result, OPTION_MISSING_VALUE, token);
+                if (!assign(options, *entry, value))
+                    return fail(result, OPTION_INVALID_VALUE, value);
+                vGiven[entry-m_vEntry] = true;
+                help |= (entry->flags & OPTION_HELP) != 0;
+            }
+            if (!help)
+            {
+                for (std::size_t i = 0; i < m_size; ++i)
+                {
+                    if ((m_vEntry[i].flags & OPTION_REQUIRED) && !vGiven[i])
+                        return fail(result, OPTION_MISSING_REQUIRED, boost::string_ref(m_vEntry[i].name));
+                }
+            }
+            return result;
+        }
+        /// @brief record an error
+        static OptionResult& fail(OptionResult& result, OptionError error, boost::string_ref token)
+        {
+            result.error = error;
+            result.token = token;
+            return result;
+        }
+
+        entry_type const* m_vEntry; ///< static array of entries
+        std::size_t m_size; ///< number of entries
+        const char* m_title; ///< title of help message
+};
+
+}} // namespace limbo // programoptions
+
+#endif
@@ -0,0 +1,1160 @@
+/**
+ * @file   ConjugateGradient.h
+ * @brief  Preconditioned conjugate gradient for sparse symmetric positive definite systems
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_CONJUGATEGRADIENT_H
+#define LIMBO_SOLVERS_CONJUGATEGRADIENT_H
+
+#include <cmath>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/Instrument.h>
+#include <limbo/solvers/Numerical.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @cond
+/// @brief rows [b, e) of \f$ Y = A X \f$ for \a k vectors interleaved by rows,
+/// i.e., entry \a c of row \a i is at i*k+c, so each element of \a A is read once for all vectors
+template <typename T>
+struct BlockAxKernel
+{
+    MatrixCSR<T, int, 1> const* A; ///< matrix
+    unsigned int k; ///< number of vectors
+    T const* x; ///< input vectors
+    T* y; ///< output vectors
+    /// @param b first row
+    /// @param e end row
+    void operator()(unsigned int b, unsigned int e) const
+    {
+        for (; b < e; ++b)
+        {
+            T* yi = y+(unsigned long)b*k;
+            std::fill(yi, yi+k, (T)0);
+            for (int kk = A->vRowBeginIndex[b]-1; kk < A->vRowBeginIndex[b+1]-1; ++kk)
+            {
+                T a = A->vElement[kk];
+                T const* xj = x+(unsigned long)(A->vColumn[kk]-1)*k;
+                for (unsigned int c = 0; c < k; ++c)
+                    yi[c] += a*xj[c];
+            }
+        }
+    }
+};
+/// @brief partial sums of \f$ x_c^T y_c \f$ of each vector \a c over fixed blocks of rows
+template <typename T>
+struct BlockDotKernel
+{
+    typedef typename NumericalAccumulator<T>::type accumulator_type; ///< accumulator type
+    unsigned int k; ///< number of vectors
+    unsigned int blockSize; ///< number of rows in a block
+    T const* x; ///< vectors
+    T const* y; ///< vectors
+    accumulator_type* vPartialSum; ///< partial sum of each block and vector
+    /// @param b first row
+    /// @param e end row
+    void operator()(unsigned int b, unsigned int e) const
+    {
+        accumulator_type* sum = vPartialSum+(unsigned long)(b/blockSize)*k;
+        std::fill(sum, sum+k, (accumulator_type)0);
+        for (unsigned long i = (unsigned long)b*k, ie = (unsigned long)e*k; i < ie; i += k)
+            for (unsigned int c = 0; c < k; ++c)
+                sum[c] += (accumulator_type)x[i+c]*y[i+c];
+    }
+};
+/// @brief rows [b, e) of \f$ y_c = a_c x_c + y_c \f$ for each vector \a c
+template <typename T>
+struct BlockAxpyKernel
+{
+    unsigned int k; ///< number of vectors
+    T const* a; ///< constant of each vector
+    T const* x; ///< vectors
+    T* y; ///< output vectors
+    /// @param b first row
+    /// @param e end row
+    void operator()(unsigned int b, unsigned int e) const
+    {
+        for (unsigned long i = (unsigned long)b*k, ie = (unsigned long)e*k; i < ie; i += k)
+            for (unsigned int c = 0; c < k; ++c)
+                y[i+c] += a[c]*x[i+c];
+    }
+};
+/// @brief rows [b, e) of \f$ y_c = x_c + a_c y_c \f$ for each vector \a c
+template <typename T>
+struct BlockXpayKernel
+{
+    unsigned int k; ///< number of vectors
+    T const* a; ///< constant of each vector
+    T const* x; ///< vectors
+    T* y; ///< output vectors
+    /// @param b first row
+    /// @param e end row
+    void operator()(unsigned int b, unsigned int e) const
+    {
+        for (unsigned long i = (unsigned long)b*k, ie = (unsigned long)e*k; i < ie; i += k)
+            for (unsigned int c = 0; c < k; ++c)
+                y[i+c] = x[i+c]+a[c]*y[i+c];
+    }
+};
+/// @brief rows [b, e) of \f$ z = w D^{-1} r + z \f$ for \a k vectors
+template <typename T>
+struct BlockDiagonalKernel
+{
+    unsigned int k; ///< number of vectors
+    T const* vInvDiag; ///< inverse of the diagonal, scaled by the weight
+    T const* r; ///< vectors
+    T* z; ///< output vectors
+    bool accumulate; ///< add to \a z if true, overwrite it otherwise
+    /// @param b first row
+    /// @param e end row
+    void operator()(unsigned int b, unsigned int e) const
+    {
+        for (; b < e; ++b)
+            for (unsigned long i = (unsigned long)b*k, ie = i+k; i < ie; ++i)
+                z[i] = (accumulate)? z[i]+vInvDiag[b]*r[i] : vInvDiag[b]*r[i];
+    }
+};
+/// @endcond
+
+/// @brief \f$ Y = A X \f$ for \a k vectors interleaved by rows;
+/// a single vector runs @ref AxPlusy
+/// @tparam T data type
+/// @param A matrix
+/// @param k number of vectors
+/// @param x input vectors
+/// @param y output vectors
+/// @param numThreads maximum number of threads
+template <typename T>
+inline void blockAx(MatrixCSR<T, int, 1> const& A, unsigned int k, T const* x, T* y, unsigned int numThreads = 1)
+{
+    if (k == 1)
+    {
+        std::fill(y, y+A.numRows, (T)0);
+        AxPlusy((T)1, A, x, y, numThreads);
+        return;
+    }
+    BlockAxKernel<T> kernel;
+    kernel.A = &A;
+    kernel.k = k;
+    kernel.x = x;
+    kernel.y = y;
+    unsigned long work = (unsigned long)A.numElements*k;
+    numThreads = numericalThreads(numThreads, work);
+    if (numThreads > 1)
+        runNumericalKernel(kernel, A.numRows, (unsigned long)A.numRows*NUMERICAL_BLOCK_WORK/work+1, numThreads);
+    else
+        kernel(0, A.numRows);
+}
+/// @brief \f$ x_c^T y_c \f$ of each of \a k vectors interleaved by rows.
+/// Partial sums of fixed blocks are added in order, so the results do not depend on the number of threads.
+/// @tparam T data type
+/// @param n number of rows
+/// @param k number of vectors
+/// @param x vectors
+/// @param y vectors
+/// @param result dot product of each vector
+/// @param numThreads maximum number of threads
+template <typename T>
+inline void blockDot(unsigned int n, unsigned int k, T const* x, T const* y, T* result, unsigned int numThreads = 1)
+{
+    if (k == 1)
+    {
+        result[0] = dot(n, x, y, numThreads);
+        return;
+    }
+    BlockDotKernel<T> kernel;
+    kernel.k = k;
+    kernel.blockSize = NUMERICAL_BLOCK_WORK/k+1;
+    kernel.x = x;
+    kernel.y = y;
+    std::vector<typename BlockDotKernel<T>::accumulator_type> vPartialSum ((unsigned long)(n+kernel.blockSize-1)/kernel.blockSize*k);
+    kernel.vPartialSum = vPartialSum.empty()? NULL : &vPartialSum[0];
+    numThreads = numericalThreads(numThreads, (unsigned long)n*k);
+    if (numThreads > 1)
+        runNumericalKernel(kernel, n, kernel.blockSize, numThreads);
+    else
+    {
+        for (unsigned int b = 0; b < n; b += kernel.blockSize)
+            kernel(b, std::min(b+kernel.blockSize, n));
+    }
+    for (unsigned int c = 0; c < k; ++c)
+    {
+        typename BlockDotKernel<T>::accumulator_type sum = 0;
+        for (unsigned long i = c; i < vPartialSum.size(); i += k)
+            sum += vPartialSum[i];
+        result[c] = sum;
+    }
+}
+/// @brief \f$ y_c = a_c x_c + y_c \f$ of each of \a k vectors interleaved by rows;
+/// a single vector runs @ref axpy
+/// @tparam T data type
+/// @param n number of rows
+/// @param k number of vectors
+/// @param a constant of each vector
+/// @param x vectors
+/// @param y output vectors
+/// @param numThreads maximum number of threads
+template <typename T>
+inline void blockAxpy(unsigned int n, unsigned int k, T const* a, T const* x, T* y, unsigned int numThreads = 1)
+{
+    if (k == 1)
+    {
+        axpy(n, a[0], x, y, numThreads);
+        return;
+    }
+    BlockAxpyKernel<T> kernel;
+    kernel.k = k;
+    kernel.a = a;
+    kernel.x = x;
+    kernel.y = y;
+    numThreads = numericalThreads(numThreads, (unsigned long)n*k);
+    if (numThreads > 1)
+        runNumericalKernel(kernel, n, NUMERICAL_BLOCK_WORK/k+1, numThreads);
+    else
+        kernel(0, n);
+}
+/// @brief \f$ y_c = x_c + a_c y_c \f$ of each of \a k vectors interleaved by rows
+/// @tparam T data type
+/// @param n number of rows
+/// @param k number of vectors
+/// @param x vectors
+/// @param a constant of each vector
+/// @param y output vectors
+/// @param numThreads maximum number of threads
+template <typename T>
+inline void blockXpay(unsigned int n, unsigned int k, T const* x, T const* a, T* y, unsigned int numThreads = 1)
+{
+    BlockXpayKernel<T> kernel;
+    kernel.k = k;
+    kernel.a = a;
+    kernel.x = x;
+    kernel.y = y;
+    numThreads = numericalThreads(numThreads, (unsigned long)n*k);
+    if (numThreads > 1)
+        runNumericalKernel(kernel, n, NUMERICAL_BLOCK_WORK/k+1, numThreads);
+    else
+        kernel(0, n);
+}
+/// @brief \f$ z = D r \f$ or \f$ z = D r + z \f$ with a diagonal matrix \a D for \a k vectors interleaved by rows
+/// @tparam T data type
+/// @param n number of rows
+/// @param k number of vectors
+/// @param vDiag diagonal of \a D
+/// @param r vectors
+/// @param z output vectors
+/// @param accumulate add to \a z if true
+/// @param numThreads maximum number of threads
+template <typename T>
+inline void blockDiagonal(unsigned int n, unsigned int k, T const* vDiag, T const* r, T* z, bool accumulate, unsigned int numThreads = 1)
+{
+    BlockDiagonalKernel<T> kernel;
+    kernel.k = k;
+    kernel.vInvDiag = vDiag;
+    kernel.r = r;
+    kernel.z = z;
+    kernel.accumulate = accumulate;
+    numThreads = numericalThreads(numThreads, (unsigned long)n*k);
+    if (numThreads > 1)
+        runNumericalKernel(kernel, n, NUMERICAL_BLOCK_WORK/k+1, numThreads);
+    else
+        kernel(0, n);
+}
+
+/// @brief Base class of preconditioners \f$ M \approx A \f$ for @ref limbo::solvers::ConjugateGradient,
+/// no preconditioning by default.
+/// Vectors are interleaved by rows, i.e., entry \a c of row \a i is at i*k+c for \a k vectors.
+/// @tparam T data type
+template <typename T>
+class CGPreconditioner
+{
+    public:
+        /// @brief value type
+        typedef T value_type;
+        /// @brief matrix type
+        typedef MatrixCSR<T, int, 1> matrix_type;
+
+        /// @brief constructor
+        CGPreconditioner() : m_numThreads(1) {}
+        /// @brief destructor
+        virtual ~CGPreconditioner() {}
+
+        /// @brief build the preconditioner for a matrix, called again if the values of the matrix change
+        /// @param A symmetric positive definite matrix with both triangles
+        /// @param numThreads maximum number of threads
+        virtual void setup(matrix_type const& /*A*/, unsigned int numThreads)
+        {
+            m_numThreads = numThreads;
+        }
+        /// @brief \f$ z = M^{-1} r \f$
+        /// @param n number of rows
+        /// @param k number of vectors
+        /// @param r vectors
+        /// @param z output vectors
+        virtual void operator()(unsigned int n, unsigned int k, value_type const* r, value_type* z) const
+        {
+            std::copy(r, r+(unsigned long)n*k, z);
+        }
+
+    protected:
+        unsigned int m_numThreads; ///< maximum number of threads
+};
+
+/// @brief Jacobi preconditioner \f$ M = diag(A) \f$, applied by threads
+/// @tparam T data type
+template <typename T>
+class JacobiPreconditioner : public CGPreconditioner<T>
+{
+    public:
+        /// @brief base type
+        typedef CGPreconditioner<T> base_type;
+        /// @brief value type
+        typedef typename base_type::value_type value_type;
+        /// @brief matrix type
+        typedef typename base_type::matrix_type matrix_type;
+
+        /// @brief constructor
+        JacobiPreconditioner() : base_type() {}
+
+        /// @brief collect inverse of the diagonal, rows without positive diagonal are not scaled
+        /// @param A symmetric positive definite matrix
+        /// @param numThreads maximum number of threads
+        void setup(matrix_type const& A, unsigned int numThreads)
+        {
+            this->m_numThreads = numThreads;
+            m_vInvDiag.assign(A.numRows, 1);
+            for (int i = 0; i < A.numRows; ++i)
+                for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1; ++k)
+                    if (A.vColumn[k]-1 == i && A.vElement[k] > 0)
+                        m_vInvDiag[i] = 1/A.vElement[k];
+        }
+        /// @brief \f$ z = D^{-1} r \f$
+        /// @param n number of rows
+        /// @param k number of vectors
+        /// @param r vectors
+        /// @param z output vectors
+        void operator()(unsigned int n, unsigned int k, value_type const* r, value_type* z) const
+        {
+            blockDiagonal(n, k, &m_vInvDiag[0], r, z, false, this->m_numThreads);
+        }
+
+    protected:
+        std::vector<value_type> m_vInvDiag; ///< inverse of the diagonal
+};
+
+/// @brief Incomplete Cholesky preconditioner \f$ M = L L^T \f$ without fill-in, IC(0).
+///
+/// \a L keeps the pattern of the lower triangle of \a A.
+/// If a pivot is not positive, the diagonal is shifted by a growing ratio and the factorization restarts,
+/// which always succeeds for positive diagonals.
+/// The triangular solves are sequential over rows and process all vectors in the same sweep,
+/// so with many threads @ref limbo::solvers::JacobiPreconditioner or
+/// @ref limbo::solvers::AggregationPreconditioner may take less time in total.
+/// @tparam T data type
+template <typename T>
+class IncompleteCholeskyPreconditioner : public CGPreconditioner<T>
+{
+    public:
+        /// @brief base type
+        typedef CGPreconditioner<T> base_type;
+        /// @brief value type
+        typedef typename base_type::value_type value_type;
+        /// @brief matrix type
+        typedef typename base_type::matrix_type matrix_type;
+
+        /// @brief constructor
+        IncompleteCholeskyPreconditioner() : base_type(), m_shift(0) {}
+
+        /// @brief factorize \f$ A \approx L L^T \f$
+        /// @param A symmetric positive definite matrix
+        /// @param numThreads maximum number of threads
+        void setup(matrix_type const& A, unsigned int numThreads);
+        /// @brief \f$ z = (L L^T)^{-1} r \f$ by forward and backward substitution
+        /// @param n number of rows
+        /// @param k number of vectors
+        /// @param r vectors
+        /// @param z output vectors
+        void operator()(unsigned int n, unsigned int k, value_type const* r, value_type* z) const;
+        /// @return relative shift of the diagonal in the last factorization, 0 if none
+        value_type shift() const {return m_shift;}
+
+    protected:
+        /// @brief factorize with a shifted diagonal
+        /// @param shift relative shift of the diagonal
+        /// @return true if all pivots are positive
+        bool factorize(value_type shift);
+
+        std::vector<unsigned int> m_vRowBegin; ///< begin of each row of \a L, diagonal last
+        std::vector<unsigned int> m_vColumn; ///< column of each element of \a L, increasing in a row
+        std::vector<value_type> m_vLowerA; ///< elements of the lower triangle of \a A
+        std::vector<value_type> m_vElement; ///< elements of \a L
+        std::vector<unsigned int> m_vColumnBegin; ///< begin of each column of \a L in @ref m_vColumnElement, for backward substitution
+        std::vector<unsigned int> m_vColumnElement; ///< elements of columns, indices to @ref m_vElement
+        std::vector<unsigned int> m_vElementRow; ///< row of each element
+        value_type m_shift; ///< relative shift of the diagonal
+};
+
+template <typename T>
+void IncompleteCholeskyPreconditioner<T>::setup(typename IncompleteCholeskyPreconditioner<T>::matrix_type const& A, unsigned int numThreads)
+{
+    limboScopedTimer("IncompleteCholeskyPreconditioner::setup");
+    this->m_numThreads = numThreads;
+    unsigned int n = A.numRows;
+    // lower triangle sorted by columns, the diagonal last
+    m_vRowBegin.assign(1, 0);
+    m_vColumn.clear();
+    m_vLowerA.clear();
+    std::vector<std::pair<unsigned int, value_type> > vRow;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        vRow.clear();
+        value_type diag = 0;
+        for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1; ++k)
+        {
+            unsigned int j = A.vColumn[k]-1;
+            if (j < i)
+                vRow.push_back(std::make_pair(j, A.vElement[k]));
+            else if (j == i)
+                diag += A.vElement[k];
+        }
+        std::sort(vRow.begin(), vRow.end());
+        for (typename std::vector<std::pair<unsigned int, value_type> >::const_iterator it = vRow.begin(); it != vRow.end(); ++it)
+        {
+            // merge duplicates
+            if (m_vColumn.size() > m_vRowBegin.back() && m_vColumn.back() == it->first)
+                m_vLowerA.back() += it->second;
+            else
+            {
+                m_vColumn.push_back(it->first);
+                m_vLowerA.push_back(it->second);
+            }
+        }
+        m_vColumn.push_back(i);
+        m_vLowerA.push_back(diag);
+        m_vRowBegin.push_back(m_vColumn.size());
+    }
+    // columns of L for backward substitution
+    unsigned int numElements = m_vColumn.size();
+    m_vColumnBegin.assign(n+1, 0);
+    m_vElementRow.resize(numElements);
+    for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int k = m_vRowBegin[i]; k < m_vRowBegin[i+1]; ++k)
+        {
+            ++m_vColumnBegin[m_vColumn[k]+1];
+            m_vElementRow[k] = i;
+        }
+    for (unsigned int j = 0; j < n; ++j)
+        m_vColumnBegin[j+1] += m_vColumnBegin[j];
+    m_vColumnElement.resize(numElements);
+    std::vector<unsigned int> vNext (m_vColumnBegin.begin(), m_vColumnBegin.end()-1);
+    for (unsigned int k = 0; k < numElements; ++k)
+        m_vColumnElement[vNext[m_vColumn[k]]++] = k;
+
+    // shift the diagonal until all pivots are positive
+    m_shift = 0;
+    while (!factorize(m_shift))
+        m_shift = (m_shift == 0)? 1e-3 : m_shift*2;
+}
+template <typename T>
+bool IncompleteCholeskyPreconditioner<T>::factorize(typename IncompleteCholeskyPreconditioner<T>::value_type shift)
+{
+    unsigned int n = m_vRowBegin.size()-1;
+    m_vElement.resize(m_vLowerA.size());
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        unsigned int diagIndex = m_vRowBegin[i+1]-1;
+        // L_ij = (a_ij - sum_{k < j} L_ik L_jk) / L_jj, by merging rows i and j
+        value_type sum = 0;
+        for (unsigned int k = m_vRowBegin[i]; k < diagIndex; ++k)
+        {
+            unsigned int j = m_vColumn[k];
+            value_type s = m_vLowerA[k];
+            unsigned int p = m_vRowBegin[i];
+            unsigned int q = m_vRowBegin[j];
+            unsigned int qe = m_vRowBegin[j+1]-1;
+            while (p < k && q < qe)
+            {
+                if (m_vColumn[p] < m_vColumn[q])
+                    ++p;
+                else if (m_vColumn[p] > m_vColumn[q])
+                    ++q;
+                else
+                    s -= m_vElement[p++]*m_vElement[q++];
+            }
+            m_vElement[k] = s/m_vElement[m_vRowBegin[j+1]-1];
+            sum += m_vElement[k]*m_vElement[k];
+        }
+        // a row without positive diagonal is kept unscaled
+        value_type diag = (m_vLowerA[diagIndex] > 0)? m_vLowerA[diagIndex] : 1;
+        value_type pivot = diag*(1+shift)-sum;
+        if (!(pivot > 0))
+            return false;
+        m_vElement[diagIndex] = sqrt(pivot);
+    }
+    return true;
+}
+template <typename T>
+void IncompleteCholeskyPreconditioner<T>::operator()(unsigned int n, unsigned int k, typename IncompleteCholeskyPreconditioner<T>::value_type const* r,
+        typename IncompleteCholeskyPreconditioner<T>::value_type* z) const
+{
+    // forward substitution L y = r
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        value_type* zi = z+(unsigned long)i*k;
+        std::copy(r+(unsigned long)i*k, r+(unsigned long)(i+1)*k, zi);
+        unsigned int diagIndex = m_vRowBegin[i+1]-1;
+        for (unsigned int p = m_vRowBegin[i]; p < diagIndex; ++p)
+        {
+            value_type const* zj = z+(unsigned long)m_vColumn[p]*k;
+            for (unsigned int c = 0; c < k; ++c)
+                zi[c] -= m_vElement[p]*zj[c];
+        }
+        for (unsigned int c = 0; c < k; ++c)
+            zi[c] /= m_vElement[diagIndex];
+    }
+    // backward substitution L^T z = y, column i of L is row i of L^T with the diagonal first
+    for (unsigned int i = n; i-- > 0; )
+    {
+        value_type* zi = z+(unsigned long)i*k;
+        value_type diag = 0;
+        for (unsigned int p = m_vColumnBegin[i]; p < m_vColumnBegin[i+1]; ++p)
+        {
+            unsigned int element = m_vColumnElement[p];
+            unsigned int row = m_vElementRow[element];
+            if (row == i)
+            {
+                diag = m_vElement[element];
+                continue;
+            }
+            value_type const* zr = z+(unsigned long)row*k;
+            for (unsigned int c = 0; c < k; ++c)
+                zi[c] -= m_vElement[element]*zr[c];
+        }
+        for (unsigned int c = 0; c < k; ++c)
+            zi[c] /= diag;
+    }
+}
+
+/// @brief Algebraic multigrid preconditioner with plain aggregation, a V-cycle per application.
+///
+/// Each level groups a vertex with its strongly connected neighbors,
+/// \f$ |a_{ij}| \ge \theta \sqrt{a_{ii} a_{jj}} \f$, into an aggregate,
+/// and the coarse matrix sums the elements between aggregates, \f$ A_c = P^T A P \f$ with piecewise constant \a P.
+/// Levels stop at a small size solved by dense Cholesky.
+/// Damped Jacobi smooths before and after the coarse correction, so the preconditioner stays symmetric for CG.
+/// Smoothing, residuals and transfers run by threads; the setup is sequential.
+/// @tparam T data type
+template <typename T>
+class AggregationPreconditioner : public CGPreconditioner<T>
+{
+    public:
+        /// @brief base type
+        typedef CGPreconditioner<T> base_type;
+        /// @brief value type
+        typedef typename base_type::value_type value_type;
+        /// @brief matrix type
+        typedef typename base_type::matrix_type matrix_type;
+
+        /// @brief constructor
+        /// @param theta threshold of strong connections
+        /// @param maxCoarseSize size of the coarsest level solved directly
+        /// @param weight damping weight of Jacobi smoothing
+        AggregationPreconditioner(value_type theta = 0.08, unsigned int maxCoarseSize = 256, value_type weight = 2.0/3.0)
+            : base_type()
+            , m_theta(theta)
+            , m_maxCoarseSize(maxCoarseSize)
+            , m_weight(weight)
+        {
+        }
+        /// @brief destructor
+        ~AggregationPreconditioner()
+        {
+            clear();
+        }
+
+        /// @brief build levels of aggregates and coarse matrices
+        /// @param A symmetric positive definite matrix
+        /// @param numThreads maximum number of threads
+        void setup(matrix_type const& A, unsigned int numThreads);
+        /// @brief \f$ z = M^{-1} r \f$ by a V-cycle
+        /// @param n number of rows
+        /// @param k number of vectors
+        /// @param r vectors
+        /// @param z output vectors
+        void operator()(unsigned int n, unsigned int k, value_type const* r, value_type* z) const
+        {
+            vcycle(0, k, r, z);
+        }
+        /// @return number of levels including the finest one
+        unsigned int numLevels() const {return m_vLevel.size();}
+
+    protected:
+        /// @brief copy constructor, forbidden
+        /// @param rhs right hand side
+        AggregationPreconditioner(AggregationPreconditioner const& rhs);
+        /// @brief assignment, forbidden
+        /// @param rhs right hand side
+        AggregationPreconditioner& operator=(AggregationPreconditioner const& rhs);
+
+        /// @brief a level of the hierarchy
+        struct Level
+        {
+            matrix_type const* A; ///< matrix of the level
+            std::vector<value_type> vInvDiag; ///< damped inverse of the diagonal
+            std::vector<unsigned int> vAggregateBegin; ///< begin of each aggregate in @ref vAggregateVertex, empty at the coarsest level
+            std::vector<unsigned int> vAggregateVertex; ///< vertices of aggregates
+            std::vector<unsigned int> vAggregate; ///< aggregate of each vertex
+            mutable std::vector<value_type> vResidual; ///< residual of the level
+            mutable std::vector<value_type> vCoarseRhs; ///< right hand side of the next level
+            mutable std::vector<value_type> vCoarseSol; ///< solution of the next level
+        };
+        /// @brief restrict rows [b, e) of the next level, \f$ r_c = P^T r \f$
+        struct RestrictKernel
+        {
+            Level const* level; ///< the level
+            unsigned int k; ///< number of vectors
+            value_type const* r; ///< fine vectors
+            value_type* rc; ///< coarse vectors
+            /// @param b first aggregate
+            /// @param e end aggregate
+            void operator()(unsigned int b, unsigned int e) const
+            {
+                for (; b < e; ++b)
+                {
+                    value_type* rci = rc+(unsigned long)b*k;
+                    std::fill(rci, rci+k, (value_type)0);
+                    for (unsigned int p = level->vAggregateBegin[b]; p < level->vAggregateBegin[b+1]; ++p)
+                    {
+                        value_type const* ri = r+(unsigned long)level->vAggregateVertex[p]*k;
+                        for (unsigned int c = 0; c < k; ++c)
+                            rci[c] += ri[c];
+                    }
+                }
+            }
+        };
+        /// @brief prolongate rows [b, e) of the level, \f$ z = P z_c + z \f$
+        struct ProlongateKernel
+        {
+            Level const* level; ///< the level
+            unsigned int k; ///< number of vectors
+            value_type const* zc; ///< coarse vectors
+            value_type* z; ///< fine vectors
+            /// @param b first vertex
+            /// @param e end vertex
+            void operator()(unsigned int b, unsigned int e) const
+            {
+                for (; b < e; ++b)
+                {
+                    value_type const* zci = zc+(unsigned long)level->vAggregate[b]*k;
+                    value_type* zi = z+(unsigned long)b*k;
+                    for (unsigned int c = 0; c < k; ++c)
+                        zi[c] += zci[c];
+                }
+            }
+        };
+
+        /// @brief release coarse matrices
+        void clear();
+        /// @brief aggregate vertices of a level by strong connections
+        /// @param level the level
+        /// @return number of aggregates
+        unsigned int aggregate(Level& level) const;
+        /// @brief build the coarse matrix \f$ P^T A P \f$
+        /// @param level the fine level
+        /// @param numAggregates number of aggregates
+        /// @return coarse matrix
+        matrix_type* coarsen(Level const& level, unsigned int numAggregates) const;
+        /// @brief factorize the dense matrix of the coarsest level
+        /// @param A matrix of the coarsest level
+        void factorizeCoarsest(matrix_type const& A);
+        /// @brief V-cycle from a level
+        /// @param l index of the level
+        /// @param k number of vectors
+        /// @param r vectors
+        /// @param z output vectors
+        void vcycle(unsigned int l, unsigned int k, value_type const* r, value_type* z) const;
+
+        value_type m_theta; ///< threshold of strong connections
+        unsigned int m_maxCoarseSize; ///< size of the coarsest level solved directly
+        value_type m_weight; ///< damping weight of Jacobi smoothing
+        std::vector<Level> m_vLevel; ///< levels from the finest one
+        std::vector<matrix_type*> m_vCoarseMatrix; ///< matrices of levels after the finest one
+        std::vector<value_type> m_vCholesky; ///< dense Cholesky factor of the coarsest level, row major
+};
+
+template <typename T>
+void AggregationPreconditioner<T>::clear()
+{
+    for (typename std::vector<matrix_type*>::iterator it = m_vCoarseMatrix.begin(); it != m_vCoarseMatrix.end(); ++it)
+        delete *it;
+    m_vCoarseMatrix.clear();
+    m_vLevel.clear();
+}
+template <typename T>
+void AggregationPreconditioner<T>::setup(typename AggregationPreconditioner<T>::matrix_type const& A, unsigned int numThreads)
+{
+    limboScopedTimer("AggregationPreconditioner::setup");
+    this->m_numThreads = numThreads;
+    clear();
+    matrix_type const* levelA = &A;
+    while (true)
+    {
+        m_vLevel.push_back(Level());
+        Level& level = m_vLevel.back();
+        level.A = levelA;
+        level.vInvDiag.assign(levelA->numRows, 0);
+        for (int i = 0; i < levelA->numRows; ++i)
+            for (int k = levelA->vRowBeginIndex[i]-1; k < levelA->vRowBeginIndex[i+1]-1; ++k)
+                if (levelA->vColumn[k]-1 == i && levelA->vElement[k] > 0)
+                    level.vInvDiag[i] = m_weight/levelA->vElement[k];
+        if ((unsigned int)levelA->numRows <= m_maxCoarseSize)
+            break;
+        unsigned int numAggregates = aggregate(level);
+        // stop if aggregates hardly reduce the size
+        if (numAggregates*5 > (unsigned int)levelA->numRows*4)
+        {
+            level.vAggregateBegin.clear();
+            break;
+        }
+        m_vCoarseMatrix.push_back(coarsen(level, numAggregates));
+        levelA = m_vCoarseMatrix.back();
+    }
+    factorizeCoarsest(*m_vLevel.back().A);
+}
+template <typename T>
+unsigned int AggregationPreconditioner<T>::aggregate(typename AggregationPreconditioner<T>::Level& level) const
+{
+    matrix_type const& A = *level.A;
+    unsigned int n = A.numRows;
+    std::vector<value_type> vDiag (n, 0);
+    for (unsigned int i = 0; i < n; ++i)
+        for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1; ++k)
+            if ((unsigned int)A.vColumn[k]-1 == i)
+                vDiag[i] += A.vElement[k];
+    const unsigned int unassigned = std::numeric_limits<unsigned int>::max();
+    level.vAggregate.assign(n, unassigned);
+    unsigned int numAggregates = 0;
+    // 1. vertices with all strong neighbors free start aggregates
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        if (level.vAggregate[i] != unassigned)
+            continue;
+        bool free = true;
+        for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1 && free; ++k)
+        {
+            unsigned int j = A.vColumn[k]-1;
+            if (j != i && std::abs(A.vElement[k]) >= m_theta*sqrt(std::abs(vDiag[i]*vDiag[j])))
+                free = (level.vAggregate[j] == unassigned);
+        }
+        if (!free)
+            continue;
+        level.vAggregate[i] = numAggregates;
+        for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1; ++k)
+        {
+            unsigned int j = A.vColumn[k]-1;
+            if (j != i && std::abs(A.vElement[k]) >= m_theta*sqrt(std::abs(vDiag[i]*vDiag[j])))
+                level.vAggregate[j] = numAggregates;
+        }
+        ++numAggregates;
+    }
+    // 2. other vertices join the aggregate of their strongest neighbor, or stay alone
+    std::vector<unsigned int> vFirstPass (level.vAggregate);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        if (level.vAggregate[i] != unassigned)
+            continue;
+        value_type strongest = 0;
+        for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1; ++k)
+        {
+            unsigned int j = A.vColumn[k]-1;
+            if (j != i && vFirstPass[j] != unassigned && std::abs(A.vElement[k]) > strongest)
+            {
+                strongest = std::abs(A.vElement[k]);
+                level.vAggregate[i] = vFirstPass[j];
+            }
+        }
+        if (level.vAggregate[i] == unassigned)
+            level.vAggregate[i] = numAggregates++;
+    }
+    // vertices of each aggregate
+    level.vAggregateBegin.assign(numAggregates+1, 0);
+    for (unsigned int i = 0; i < n; ++i)
+        ++level.vAggregateBegin[level.vAggregate[i]+1];
+    for (unsigned int a = 0; a < numAggregates; ++a)
+        level.vAggregateBegin[a+1] += level.vAggregateBegin[a];
+    level.vAggregateVertex.resize(n);
+    std::vector<unsigned int> vNext (level.vAggregateBegin.begin(), level.vAggregateBegin.end()-1);
+    for (unsigned int i = 0; i < n; ++i)
+        level.vAggregateVertex[vNext[level.vAggregate[i]]++] = i;
+    return numAggregates;
+}
+template <typename T>
+typename AggregationPreconditioner<T>::matrix_type* AggregationPreconditioner<T>::coarsen(typename AggregationPreconditioner<T>::Level const& level, unsigned int numAggregates) const
+{
+    matrix_type const& A = *level.A;
+    // accumulate rows of each aggregate with a dense marker of columns
+    std::vector<int> vPosition (numAggregates, -1);
+    std::vector<int> vRowBegin (1, 0);
+    std::vector<int> vColumn;
+    std::vector<value_type> vElement;
+    for (unsigned int a = 0; a < numAggregates; ++a)
+    {
+        int rowBegin = vColumn.size();
+        for (unsigned int p = level.vAggregateBegin[a]; p < level.vAggregateBegin[a+1]; ++p)
+        {
+            unsigned int i = level.vAggregateVertex[p];
+            for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1; ++k)
+            {
+                unsigned int b = level.vAggregate[A.vColumn[k]-1];
+                if (vPosition[b] < rowBegin)
+                {
+                    vPosition[b] = vColumn.size();
+                    vColumn.push_back(b);
+                    vElement.push_back(A.vElement[k]);
+                }
+                else
+                    vElement[vPosition[b]] += A.vElement[k];
+            }
+        }
+        vRowBegin.push_back(vColumn.size());
+    }
+    matrix_type* Ac = new matrix_type();
+    Ac->initialize(numAggregates, numAggregates, vColumn.size());
+    for (unsigned int a = 0; a <= numAggregates; ++a)
+        Ac->vRowBeginIndex[a] = vRowBegin[a]+matrix_type::s_startingIndex;
+    for (unsigned int k = 0; k < vColumn.size(); ++k)
+    {
+        Ac->vColumn[k] = vColumn[k]+matrix_type::s_startingIndex;
+        Ac->vElement[k] = vElement[k];
+    }
+    return Ac;
+}
+template <typename T>
+void AggregationPreconditioner<T>::factorizeCoarsest(typename AggregationPreconditioner<T>::matrix_type const& A)
+{
+    unsigned int n = A.numRows;
+    m_vCholesky.assign((unsigned long)n*n, 0);
+    for (unsigned int i = 0; i < n; ++i)
+        for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1; ++k)
+            m_vCholesky[(unsigned long)i*n+A.vColumn[k]-1] += A.vElement[k];
+    // lower triangle in place; a pivot of a singular level falls back to its diagonal
+    for (unsigned int j = 0; j < n; ++j)
+    {
+        value_type diag = m_vCholesky[(unsigned long)j*n+j];
+        value_type pivot = diag;
+        for (unsigned int k = 0; k < j; ++k)
+            pivot -= m_vCholesky[(unsigned long)j*n+k]*m_vCholesky[(unsigned long)j*n+k];
+        if (!(pivot > diag*1e-12))
+            pivot = (diag > 0)? diag : 1;
+        value_type ljj = sqrt(pivot);
+        m_vCholesky[(unsigned long)j*n+j] = ljj;
+        for (unsigned int i = j+1; i < n; ++i)
+        {
+            value_type s = m_vCholesky[(unsigned long)i*n+j];
+            for (unsigned int k = 0; k < j; ++k)
+                s -= m_vCholesky[(unsigned long)i*n+k]*m_vCholesky[(unsigned long)j*n+k];
+            m_vCholesky[(unsigned long)i*n+j] = s/ljj;
+        }
+    }
+}
+template <typename T>
+void AggregationPreconditioner<T>::vcycle(unsigned int l, unsigned int k, typename AggregationPreconditioner<T>::value_type const* r,
+        typename AggregationPreconditioner<T>::value_type* z) const
+{
+    Level const& level = m_vLevel[l];
+    unsigned int n = level.A->numRows;
+    unsigned int numThreads = this->m_numThreads;
+    // coarsest level by dense Cholesky
+    if (l+1 == m_vLevel.size())
+    {
+        for (unsigned int c = 0; c < k; ++c)
+        {
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                value_type s = r[(unsigned long)i*k+c];
+                for (unsigned int j = 0; j < i; ++j)
+                    s -= m_vCholesky[(unsigned long)i*n+j]*z[(unsigned long)j*k+c];
+                z[(unsigned long)i*k+c] = s/m_vCholesky[(unsigned long)i*n+i];
+            }
+            for (unsigned int i = n; i-- > 0; )
+            {
+                value_type s = z[(unsigned long)i*k+c];
+                for (unsigned int j = i+1; j < n; ++j)
+                    s -= m_vCholesky[(unsigned long)j*n+i]*z[(unsigned long)j*k+c];
+                z[(unsigned long)i*k+c] = s/m_vCholesky[(unsigned long)i*n+i];
+            }
+        }
+        return;
+    }
+    unsigned long size = (unsigned long)n*k;
+    unsigned int numAggregates = level.vAggregateBegin.size()-1;
+    level.vResidual.resize(size);
+    level.vCoarseRhs.resize((unsigned long)numAggregates*k);
+    level.vCoarseSol.resize((unsigned long)numAggregates*k);
+    std::vector<value_type> vMinusOne (k, -1);
+
+    // pre-smoothing from zero
+    blockDiagonal(n, k, &level.vInvDiag[0], r, z, false, numThreads);
+    // residual r - A z
+    blockAx(*level.A, k, z, &level.vResidual[0], numThreads);
+    blockXpay(n, k, r, &vMinusOne[0], &level.vResidual[0], numThreads);
+    // coarse correction
+    RestrictKernel restrictKernel;
+    restrictKernel.level = &level;
+    restrictKernel.k = k;
+    restrictKernel.r = &level.vResidual[0];
+    restrictKernel.rc = &level.vCoarseRhs[0];
+    runNumericalKernel(restrictKernel, numAggregates, NUMERICAL_BLOCK_WORK/k+1, numericalThreads(numThreads, size));
+    vcycle(l+1, k, &level.vCoarseRhs[0], &level.vCoarseSol[0]);
+    ProlongateKernel prolongateKernel;
+    prolongateKernel.level = &level;
+    prolongateKernel.k = k;
+    prolongateKernel.zc = &level.vCoarseSol[0];
+    prolongateKernel.z = z;
+    runNumericalKernel(prolongateKernel, n, NUMERICAL_BLOCK_WORK/k+1, numericalThreads(numThreads, size));
+    // post-smoothing
+    blockAx(*level.A, k, z, &level.vResidual[0], numThreads);
+    blockXpay(n, k, r, &vMinusOne[0], &level.vResidual[0], numThreads);
+    blockDiagonal(n, k, &level.vInvDiag[0], &level.vResidual[0], z, true, numThreads);
+}
+
+/// @brief Preconditioned conjugate gradient for sparse symmetric positive definite systems \f$ A x = b \f$.
+///
+/// Several right hand sides, e.g., x and y coordinates of quadratic placement, are solved together:
+/// vectors are interleaved by rows, so each iteration reads the matrix once for all of them,
+/// while each keeps its own step sizes and stops at its own convergence.
+/// Matrix-vector products, dot products and vector updates run by threads with the kernels of Numerical.h;
+/// dot products add fixed blocks in order, so iterations do not depend on the number of threads.
+/// With @ref setWarmStart, the solutions passed in are the initial guesses,
+/// e.g., the positions of the previous placement iteration.
+/// The preconditioner is built at the first solve after @ref setMatrix or @ref setPreconditioner,
+/// and kept for later solves of the same matrix.
+/// @tparam T data type
+template <typename T>
+class ConjugateGradient
+{
+    public:
+        /// @brief value type
+        typedef T value_type;
+        /// @brief matrix type
+        typedef MatrixCSR<T, int, 1> matrix_type;
+        /// @brief preconditioner type
+        typedef CGPreconditioner<T> preconditioner_type;
+
+        /// @brief constructor
+        /// @param A symmetric positive definite matrix with both triangles, kept by pointer
+        /// @param preconditioner preconditioner, @ref limbo::solvers::JacobiPreconditioner if NULL; the solver does not own it
+        ConjugateGradient(matrix_type const* A, preconditioner_type* preconditioner = NULL)
+            : m_A(A)
+            , m_preconditioner(preconditioner)
+            , m_setup(false)
+            , m_warmStart(false)
+            , m_tolerance(1e-6)
+            , m_maxIters(1000)
+            , m_maxThreads(1)
+            , m_numThreads(1)
+            , m_iter(0)
+            , m_residual(0)
+        {
+        }
+
+        /// @brief solve a single system
+        /// @param b right hand side
+        /// @param x solution, also the initial guess with warm start
+        /// @return OPTIMAL if converged, SUBOPTIMAL at the maximum iterations, INFEASIBLE if the matrix is not positive definite
+        SolverProperty operator()(value_type const* b, value_type* x)
+        {
+            return solve(1, &b, &x);
+        }
+        /// @brief solve systems of the same matrix together
+        /// @param numRhs number of right hand sides
+        /// @param vRhs right hand sides
+        /// @param vSolution solutions, also the initial guesses with warm start
+        /// @return OPTIMAL if all converged, SUBOPTIMAL at the maximum iterations, INFEASIBLE if the matrix is not positive definite
+        SolverProperty operator()(unsigned int numRhs, value_type const* const* vRhs, value_type* const* vSolution)
+        {
+            return solve(numRhs, vRhs, vSolution);
+        }
+
+        /// @brief set the matrix, the preconditioner is built again at the next solve
+        /// @param A symmetric positive definite matrix with both triangles
+        void setMatrix(matrix_type const* A) {m_A = A; m_setup = false;}
+        /// @brief set the preconditioner, built at the next solve
+        /// @param preconditioner preconditioner, @ref limbo::solvers::JacobiPreconditioner if NULL; the solver does not own it
+        void setPreconditioner(preconditioner_type* preconditioner) {m_preconditioner = preconditioner; m_setup = false;}
+        /// @brief set whether solutions passed in are initial guesses
+        /// @param w flag
+        void setWarmStart(bool w) {m_warmStart = w;}
+        /// @brief set tolerance of the relative residual \f$ \|b - A x\| / \|b\| \f$
+        /// @param t tolerance
+        void setTolerance(value_type t) {m_tolerance = t;}
+        /// @brief set maximum iterations
+        /// @param maxIter maximum iterations
+        void setMaxIterations(unsigned int maxIter) {m_maxIters = maxIter;}
+        /// @brief set maximum number of threads, limited by the number of cores
+        /// @param t number of threads
+        void setNumThreads(unsigned int t) {m_maxThreads = std::max(t, 1U); m_setup = false;}
+        /// @return number of iterations of the last solve
+        unsigned int numIterations() const {return m_iter;}
+        /// @return largest relative residual of the last solve
+        value_type residual() const {return m_residual;}
+
+    protected:
+        /// @brief copy constructor, forbidden
+        /// @param rhs right hand side
+        ConjugateGradient(ConjugateGradient const& rhs);
+        /// @brief assignment, forbidden
+        /// @param rhs right hand side
+        ConjugateGradient& operator=(ConjugateGradient const& rhs);
+
+        /// @brief kernel function to solve systems
+        /// @param k number of right hand sides
+        /// @param vRhs right hand sides
+        /// @param vSolution solutions
+        /// @return solving status
+        SolverProperty solve(unsigned int k, value_type const* const* vRhs, value_type* const* vSolution);
+
+        matrix_type const* m_A; ///< matrix
+        preconditioner_type* m_preconditioner; ///< preconditioner given by users
+        JacobiPreconditioner<value_type> m_defaultPreconditioner; ///< default preconditioner
+        bool m_setup; ///< whether the preconditioner is built for the matrix
+        bool m_warmStart; ///< whether solutions passed in are initial guesses
+        value_type m_tolerance; ///< tolerance of relative residuals
+        unsigned int m_maxIters; ///< maximum iterations
+        unsigned int m_maxThreads; ///< maximum number of threads
+        unsigned int m_numThreads; ///< number of threads in use, limited by the number of cores
+        unsigned int m_iter; ///< number of iterations of the last solve
+        value_type m_residual; ///< largest relative residual of the last solve
+
+        std::vector<value_type> m_vX; ///< solutions, interleaved by rows
+        std::vector<value_type> m_vR; ///< residuals
+        std::vector<value_type> m_vZ; ///< preconditioned residuals
+        std::vector<value_type> m_vP; ///< search directions
+        std::vector<value_type> m_vQ; ///< products of the matrix and search directions
+};
+
+template <typename T>
+SolverProperty ConjugateGradient<T>::solve(unsigned int k, typename ConjugateGradient<T>::value_type const* const* vRhs, typename ConjugateGradient<T>::value_type* const* vSolution)
+{
+    limboScopedTimer("ConjugateGradient::solve");
+    unsigned int n = m_A->numRows;
+    m_iter = 0;
+    m_residual = 0;
+    if (n == 0 || k == 0)
+        return OPTIMAL;
+    // threads beyond the number of cores only add overhead
+    m_numThreads = std::min(limbo::containers::num_threads(), m_maxThreads);
+    preconditioner_type* preconditioner = (m_preconditioner)? m_preconditioner : &m_defaultPreconditioner;
+    if (!m_setup)
+    {
+        preconditioner->setup(*m_A, m_numThreads);
+        m_setup = true;
+    }
+
+    unsigned long size = (unsigned long)n*k;
+    m_vX.resize(size);
+    m_vR.resize(size);
+    m_vZ.resize(size);
+    m_vP.resize(size);
+    m_vQ.resize(size);
+    // interleave right hand sides and initial guesses
+    for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int c = 0; c < k; ++c)
+        {
+            m_vR[(unsigned long)i*k+c] = vRhs[c][i];
+            m_vX[(unsigned long)i*k+c] = (m_warmStart)? vSolution[c][i] : 0;
+        }
+    std::vector<value_type> vBNorm (k);
+    blockDot(n, k, &m_vR[0], &m_vR[0], &vBNorm[0], m_numThreads);
+    // r = b - A x
+    std::vector<value_type> vMinusOne (k, -1);
+    if (m_warmStart)
+    {
+        blockAx(*m_A, k, &m_vX[0], &m_vQ[0], m_numThreads);
+        blockAxpy(n, k, &vMinusOne[0], &m_vQ[0], &m_vR[0], m_numThreads);
+    }
+
+    std::vector<value_type> vRR (k);
+    std::vector<value_type> vRZ (k);
+    std::vector<value_type> vPQ (k);
+    std::vector<value_type> vAlpha (k, 0);
+    std::vector<value_type> vBeta (k, 0);
+    std::vector<bool> vActive (k, true);
+    blockDot(n, k, &m_vR[0], &m_vR[0], &vRR[0], m_numThreads);
+    unsigned int numActive = 0;
+    SolverProperty status = OPTIMAL;
+    for (unsigned int c = 0; c < k; ++c)
+    {
+        // zero right hand sides converge to zero
+        value_type target = m_tolerance*m_tolerance*((vBNorm[c] > 0)? vBNorm[c] : 1);
+        vActive[c] = (vRR[c] > target);
+        numActive += vActive[c];
+    }
+    (*preconditioner)(n, k, &m_vR[0], &m_vZ[0]);
+    blockDot(n, k, &m_vR[0], &m_vZ[0], &vRZ[0], m_numThreads);
+    std::copy(m_vZ.begin(), m_vZ.end(), m_vP.begin());
+    for (; numActive && m_iter < m_maxIters; ++m_iter)
+    {
+        limboCounterAdd("ConjugateGradient::iterations", 1);
+        // q = A p
+        blockAx(*m_A, k, &m_vP[0], &m_vQ[0], m_numThreads);
+        blockDot(n, k, &m_vP[0], &m_vQ[0], &vPQ[0], m_numThreads);
+        for (unsigned int c = 0; c < k; ++c)
+        {
+            vAlpha[c] = 0;
+            if (!vActive[c])
+                continue;
+            if (!(vPQ[c] > 0))
+            {
+                // not positive definite
+                vActive[c] = false;
+                --numActive;
+                status = INFEASIBLE;
+                continue;
+            }
+            vAlpha[c] = vRZ[c]/vPQ[c];
+        }
+        // x += alpha p, r -= alpha q
+        blockAxpy(n, k, &vAlpha[0], &m_vP[0], &m_vX[0], m_numThreads);
+        for (unsigned int c = 0; c < k; ++c)
+            vAlpha[c] = -vAlpha[c];
+        blockAxpy(n, k, &vAlpha[0], &m_vQ[0], &m_vR[0], m_numThreads);
+        blockDot(n, k, &m_vR[0], &m_vR[0], &vRR[0], m_numThreads);
+        for (unsigned int c = 0; c < k; ++c)
+        {
+            if (vActive[c] && vRR[c] <= m_tolerance*m_tolerance*((vBNorm[c] > 0)? vBNorm[c] : 1))
+            {
+                vActive[c] = false;
+                --numActive;
+            }
+        }
+        // p = z + beta p, converged vectors take zero steps afterwards
+        (*preconditioner)(n, k, &m_vR[0], &m_vZ[0]);
+        blockDot(n, k, &m_vR[0], &m_vZ[0], &vPQ[0], m_numThreads);
+        for (unsigned int c = 0; c < k; ++c)
+        {
+            vBeta[c] = (vActive[c])? vPQ[c]/vRZ[c] : 0;
+            vRZ[c] = vPQ[c];
+        }
+        blockXpay(n, k, &m_vZ[0], &vBeta[0], &m_vP[0], m_numThreads);
+    }
+    if (numActive && status == OPTIMAL)
+        status = SUBOPTIMAL;
+
+    // relative residuals of the recurrence
+    for (unsigned int c = 0; c < k; ++c)
+        m_residual = std::max(m_residual, (value_type)sqrt(vRR[c]/((vBNorm[c] > 0)? vBNorm[c] : 1)));
+    for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int c = 0; c < k; ++c)
+            vSolution[c][i] = m_vX[(unsigned long)i*k+c];
+    return status;
+}
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
@@ -15,7 +15,11 @@
 #include <lemon/cycle_canceling.h>
 #include <lemon/lgf_writer.h>
 
+#include <limbo/string/ToString.h>
+#include <limbo/containers/DisjointSet.h>
 #include <limbo/solvers/Solvers.h>
+#include <limbo/solvers/WarmStartNetworkSimplex.h>
+#include <limbo/solvers/PotentialRecovery.h>
 
 /// namespace for Limbo 
 namespace limbo 
@@ -35,6 +39,8 @@ template <typename T, typename V>
 class NetworkSimplex;
 template <typename T, typename V>
 class CycleCanceling;
+template <typename T, typename V>
+class IncrementalNetworkSimplex;
 
 /// @class limbo::solvers::DualMinCostFlow
 /// @brief LP solved with min-cost flow. A better implementation of @ref limbo::solvers::lpmcf::LpDualMcf
@@ -45,35 +51,35 @@ class CycleCanceling;
 ///
 /// 1. Primal problem \n
 /// \f{eqnarray*}{
-/// & min. & \sum_{i=1}^{n} c_i \cdot x_i - \sum_{i,j} u_{ij} \alpha_{ij}, \\
-/// & s.t. & x_i - x_j - \alpha_{ij} \ge b_{ij}, \forall (i, j) \in E,  \\
-/// &     & d_i \le x_i \le u_i, \forall i \in [1, n], \\
+/// & min. & \sum_{i=1}^{n} c_i \cdot x_i - \sum_{i,j} u_{ij} \alpha_{ij}, \\[0pt]
+/// & s.t. & x_i - x_j - \alpha_{ij} \ge b_{ij}, \forall (i, j) \in E,  \\[0pt]
+/// &     & d_i \le x_i \le u_i, \forall i \in [1, n], \\[0pt]
 /// &     & \alpha_{ij} \ge 0, \forall (i, j) \in A.  
 /// \f}
 /// \n
 /// 2. Introduce new variables \f$y_i\f$ in \f$[0, n]\f$, set \f$x_i = y_i - y_0\f$, \n
 /// \f{eqnarray*}{
-/// & min. & \sum_{i=1}^{n} c_i \cdot (y_i-y_0) - \sum_{i,j} u_{ij} \alpha_{ij}, \\
-/// & s.t. & y_i - y_j -\alpha_{ij} \ge b_{ij}, \forall (i, j) \in E \\
-/// &      & d_i \le y_i - y_0 - \alpha_{ij} \le u_i, \forall i \in [1, n], \\
-/// &      & y_i \textrm{ is unbounded integer}, \forall i \in [0, n], \\
+/// & min. & \sum_{i=1}^{n} c_i \cdot (y_i-y_0) - \sum_{i,j} u_{ij} \alpha_{ij}, \\[0pt]
+/// & s.t. & y_i - y_j -\alpha_{ij} \ge b_{ij}, \forall (i, j) \in E \\[0pt]
+/// &      & d_i \le y_i - y_0 - \alpha_{ij} \le u_i, \forall i \in [1, n], \\[0pt]
+/// &      & y_i \textrm{ is unbounded integer}, \forall i \in [0, n], \\[0pt]
 /// &      & \alpha_{ij} \ge 0, \forall (i, j) \in A.  
 /// \f}
 /// \n
 /// 3. Re-write the problem \n
 /// \f{eqnarray*}{
-/// & min. & \sum_{i=0}^{n} c_i \cdot y_i - \sum_{i,j} u_{ij} \alpha_{ij}, \textrm{ where } \
+/// & min. & \sum_{i=0}^{n} c_i \cdot y_i - \sum_{i,j} u_{ij} \alpha_{ij}, \textrm{ where }
 ///   c_i = \left\{\begin{array}{lr}
-///             c_i, & \forall i \in [1, n],  \\
+///             c_i, & \forall i \in [1, n],  \\[0pt]
 ///             - \sum_{j=1}^{n} c_i, & i = 0, 
-///           \end{array}\right. \\
-/// & s.t. & y_i - y_j \ge \
+///           \end{array}\right. \\[0pt]
+/// & s.t. & y_i - y_j \ge
 ///        \left\{\begin{array}{lr}
-///            b_{ij}, & \forall (i, j) \in E, \\
-///            d_i,  & \forall j = 0, i \in [1, n], \\
+///            b_{ij}, & \forall (i, j) \in E, \\[0pt]
+///            d_i,  & \forall j = 0, i \in [1, n], \\[0pt]
 ///            -u_i, & \forall i = 0, j \in [1, n], 
-///        \end{array}\right. \\
-/// &      & y_i \textrm{ is unbounded integer}, \forall i \in [0, n], \\
+///        \end{array}\right. \\[0pt]
+/// &      & y_i \textrm{ is unbounded integer}, \forall i \in [0, n], \\[0pt]
 /// &      & \alpha_{ij} \ge 0, \forall (i, j) \in A.  
 /// \f}
 /// \n
@@ -96,6 +102,25 @@ class CycleCanceling;
 /// by all the algorithms (only capacity scaling algorithm supports). Therefore, graph transformation is introduced 
 /// to convert arcs with negative costs to positive costs with arc inversal. 
 /// 
+/// The object can solve its model again after changes of the objective, right hand sides or bounds. 
+/// If the signs of right hand sides are kept, the graph has the same arcs, 
+/// and @ref limbo::solvers::IncrementalNetworkSimplex starts from the spanning tree of the previous solve. 
+/// 
+/// Without a model, variables, bounds, objective weights and difference constraints are added directly 
+/// with @ref addVariable, @ref addObjectiveWeight and @ref addDifferenceConstraint, 
+/// which also support soft constraints with finite penalties \f$u_{ij}\f$. 
+/// Solutions are then read from @ref solutions. 
+/// 
+/// Solutions are the potentials of the min-cost flow solver. 
+/// For solvers that only compute flows, or with @ref setRecoverPotential, 
+/// they are recomputed from the flows by @ref limbo::solvers::PotentialRecovery, 
+/// which keeps its arrays between solves. 
+/// 
+/// Difference constraints only couple their two variables and bounds only refer to constants, 
+/// so the LP separates over the connected components of the constraint graph without the additional node. 
+/// With @ref setDecompose, components are solved as independent min-cost flow problems in parallel, 
+/// e.g., the rows of a legalization problem, and their potentials are stitched together. 
+/// 
 /// @tparam T coefficient type 
 /// @tparam V variable type 
 template <typename T, typename V>
@@ -128,8 +153,8 @@ class DualMinCostFlow
         /// @endnowarn
 
         /// @brief constructor 
-        /// @param model pointer to the model of problem 
-        DualMinCostFlow(model_type* model)
+        /// @param model pointer to the model of problem, NULL to add variables and difference constraints directly 
+        DualMinCostFlow(model_type* model = NULL)
             : m_model(model)
               , m_graph()
               //, m_mLower(m_graph)
@@ -141,6 +166,11 @@ class DualMinCostFlow
               , m_boundBigM(std::numeric_limits<typename DualMinCostFlow<T, V>::value_type>::max())
               , m_mFlow(m_graph)
               , m_mPotential(m_graph)
+              , m_recoverPotential(false)
+              , m_potentialRecovery(m_graph)
+              , m_decompose(false)
+              , m_numThreads(0)
+              , m_numSubnetworks(0)
         {
         }
         /// @brief destructor 
@@ -155,6 +185,48 @@ class DualMinCostFlow
             return solve(solver);
         }
 
+        /// @name difference constraint system without a model 
+        /// Large legalization and compaction systems skip the @ref limbo::solvers::LinearModel 
+        /// and write variables and constraints to flat arrays. 
+        ///@{
+        /// @brief reserve space 
+        /// @param numVariables number of variables 
+        /// @param numConstraints number of difference constraints 
+        void reserve(unsigned int numVariables, unsigned int numConstraints); 
+        /// @brief add a variable with zero objective weight 
+        /// @param lowerBound lower bound, unbounded by default 
+        /// @param upperBound upper bound, unbounded by default 
+        /// @return index of the variable 
+        unsigned int addVariable(value_type lowerBound = limbo::lowest<value_type>(), value_type upperBound = std::numeric_limits<value_type>::max()); 
+        /// @brief set bounds of a variable 
+        /// @param i index of the variable 
+        /// @param lowerBound lower bound 
+        /// @param upperBound upper bound 
+        void setVariableBounds(unsigned int i, value_type lowerBound, value_type upperBound); 
+        /// @brief add to the weight of a variable in the minimized objective 
+        /// @param i index of the variable 
+        /// @param weight weight to add 
+        void addObjectiveWeight(unsigned int i, value_type weight); 
+        /// @brief add a constraint \f$ x_i - x_j \ge b \f$ 
+        /// @param i index of the first variable 
+        /// @param j index of the second variable 
+        /// @param b right hand side 
+        /// @param penalty cost per unit of violation, i.e., \f$ u_{ij} \f$ of the slack \f$ \alpha_{ij} \f$; 
+        /// a hard constraint with big M by default 
+        /// @return index of the constraint 
+        unsigned int addDifferenceConstraint(unsigned int i, unsigned int j, value_type b, value_type penalty = std::numeric_limits<value_type>::max()); 
+        /// @brief change the right hand side of a difference constraint 
+        /// @param k index of the constraint 
+        /// @param b right hand side 
+        void setDifferenceConstraintRhs(unsigned int k, value_type b); 
+        ///@}
+        /// @return number of variables 
+        unsigned int numVariables() const {return m_vWeight.size();}
+        /// @return number of difference constraints 
+        unsigned int numDifferenceConstraints() const {return m_vDiffRhs.size();}
+        /// @return solutions of variables after solving, also written to the model if any 
+        std::vector<value_type> const& solutions() const {return m_vSolution;}
+
         /// @return big M for differential constraints 
         value_type diffBigM() const; 
         /// @brief set big M as a large number for differential constraints 
@@ -166,6 +238,35 @@ class DualMinCostFlow
         /// @param v value 
         void setBoundBigM(value_type v);
 
+        /// @return true if potentials are always recomputed from flows 
+        bool recoverPotential() const {return m_recoverPotential;}
+        /// @brief recompute potentials from flows after each solve, starting from the potentials of the solver; 
+        /// potentials are always recomputed for solvers that do not provide them 
+        /// @param v flag 
+        void setRecoverPotential(bool v) {m_recoverPotential = v;}
+
+        /// @name decomposition into independent subnetworks 
+        /// Each subnetwork holds one or more connected components of the constraint graph 
+        /// and is solved with its own graph by a copy of the solver from @ref MinCostFlowSolver::clone; 
+        /// solvers that cannot be copied solve the subnetworks one after another. 
+        /// Small components are grouped, so each subnetwork has at least @ref s_minSubnetworkSize variables if possible. 
+        /// The graph and maps of this object are not built then, 
+        /// and @ref limbo::solvers::IncrementalNetworkSimplex is not warm started across solves. 
+        ///@{
+        /// @return true if independent subnetworks are solved separately 
+        bool decompose() const {return m_decompose;}
+        /// @brief solve independent subnetworks separately 
+        /// @param v flag 
+        void setDecompose(bool v) {m_decompose = v;}
+        /// @return maximum number of threads to solve subnetworks, 0 for @ref limbo::containers::num_threads 
+        unsigned int numThreads() const {return m_numThreads;}
+        /// @brief set maximum number of threads to solve subnetworks, capped by @ref limbo::containers::num_threads 
+        /// @param v number of threads, 0 for @ref limbo::containers::num_threads 
+        void setNumThreads(unsigned int v) {m_numThreads = v;}
+        /// @return number of subnetworks of the last solve with decomposition, 1 if the graph is connected 
+        unsigned int numSubnetworks() const {return m_numSubnetworks;}
+        ///@}
+
         /// @return graph 
         graph_type const& graph() const; 
         /// @return arc lower bound map 
@@ -204,6 +305,8 @@ class DualMinCostFlow
         /// @brief kernel function to solve the problem 
         /// @param solver an object to solve min cost flow, use default updater if NULL  
         SolverProperty solve(solver_type* solver);
+        /// @brief copy the model to the arrays of the difference constraint system 
+        void loadModel(); 
         /// @brief prepare data like big M 
         void prepare(); 
         /// @brief build dual min-cost flow graph 
@@ -226,8 +329,47 @@ class DualMinCostFlow
         void addArcForDiffConstraint(node_type xi, node_type xj, value_type cij, value_type bigM); 
         /// @brief apply solutions to model 
         void applySolution(); 
-
-        model_type* m_model; ///< model for the problem 
+        /// @brief solve the connected components of the constraint graph as separate min-cost flow problems 
+        /// @param solver an object to solve min cost flow 
+        /// @param status status of the first subnetwork not solved to optimality, or OPTIMAL 
+        /// @return false if there is only one subnetwork, which is solved with the graph of this object instead 
+        bool solveSubnetworks(solver_type* solver, SolverProperty& status); 
+
+        /// @brief shared state of threads solving subnetworks 
+        struct SubnetworkPass 
+        {
+            std::vector<DualMinCostFlow*> vSubnetwork; ///< subnetworks, larger ones first 
+            std::vector<SolverProperty> vStatus; ///< status of each subnetwork 
+            std::vector<solver_type*> vSolver; ///< solvers, one for each thread, as a solver is not shared while solving 
+            std::vector<unsigned int> vBusy; ///< 1 if the solver of the same index is taken by a thread, set atomically 
+        };
+        /// @brief subnetworks solved by threads with @ref limbo::containers::parallel_for 
+        struct SubnetworkKernel 
+        {
+            SubnetworkPass* pass; ///< shared state 
+            /// @param b first subnetwork 
+            /// @param e end subnetwork 
+            void operator()(std::size_t b, std::size_t e) const {DualMinCostFlow::solveSubnetworkBlock(*pass, b, e);}
+        };
+        /// @brief solve a block of subnetworks with a solver no other thread is using 
+        /// @param pass shared state 
+        /// @param b first subnetwork 
+        /// @param e end subnetwork 
+        static void solveSubnetworkBlock(SubnetworkPass& pass, std::size_t b, std::size_t e); 
+
+        /// minimum number of variables of a subnetwork, smaller components are grouped 
+        static const unsigned int s_minSubnetworkSize = 256; 
+
+        model_type* m_model; ///< model for the problem, NULL if variables and constraints are added directly 
+
+        std::vector<value_type> m_vWeight; ///< objective weight of each variable 
+        std::vector<value_type> m_vLowerBound; ///< lower bound of each variable 
+        std::vector<value_type> m_vUpperBound; ///< upper bound of each variable 
+        std::vector<unsigned int> m_vDiffSource; ///< variable \f$ x_i \f$ of each difference constraint 
+        std::vector<unsigned int> m_vDiffTarget; ///< variable \f$ x_j \f$ of each difference constraint 
+        std::vector<value_type> m_vDiffRhs; ///< right hand side of each difference constraint 
+        std::vector<value_type> m_vDiffPenalty; ///< penalty of each difference constraint, max for big M 
+        std::vector<value_type> m_vSolution; ///< solution of each variable 
 
 		graph_type m_graph; ///< input graph 
 		//arc_value_map_type m_mLower; ///< lower bound of flow, usually zero  
@@ -241,6 +383,11 @@ class DualMinCostFlow
 
 		arc_flow_map_type m_mFlow; ///< solution of min-cost flow, which is the dual solution of LP 
 		node_pot_map_type m_mPotential; ///< dual solution of min-cost flow, which is the solution of LP 
+        bool m_recoverPotential; ///< whether potentials are recomputed from flows even if the solver provides them 
+        PotentialRecovery<graph_type, value_type> m_potentialRecovery; ///< kernel to compute potentials from flows 
+        bool m_decompose; ///< whether independent subnetworks are solved separately 
+        unsigned int m_numThreads; ///< maximum number of threads to solve subnetworks, 0 for all 
+        unsigned int m_numSubnetworks; ///< number of subnetworks of the last solve with decomposition 
 };
 
 template <typename T, typename V>
@@ -316,6 +463,53 @@ typename DualMinCostFlow<T, V>::value_type DualMinCostFlow<T, V>::totalCost() co
     return -(totalFlowCost()-m_reversedArcFlowCost);
 }
 template <typename T, typename V>
+void DualMinCostFlow<T, V>::reserve(unsigned int numVariables, unsigned int numConstraints)
+{
+    m_vWeight.reserve(numVariables); 
+    m_vLowerBound.reserve(numVariables); 
+    m_vUpperBound.reserve(numVariables); 
+    m_vDiffSource.reserve(numConstraints); 
+    m_vDiffTarget.reserve(numConstraints); 
+    m_vDiffRhs.reserve(numConstraints); 
+    m_vDiffPenalty.reserve(numConstraints); 
+}
+template <typename T, typename V>
+unsigned int DualMinCostFlow<T, V>::addVariable(typename DualMinCostFlow<T, V>::value_type lowerBound, typename DualMinCostFlow<T, V>::value_type upperBound)
+{
+    limboAssertMsg(m_model == NULL, "variables of a model must be added to the model"); 
+    m_vWeight.push_back(0); 
+    m_vLowerBound.push_back(lowerBound); 
+    m_vUpperBound.push_back(upperBound); 
+    return m_vWeight.size()-1; 
+}
+template <typename T, typename V>
+void DualMinCostFlow<T, V>::setVariableBounds(unsigned int i, typename DualMinCostFlow<T, V>::value_type lowerBound, typename DualMinCostFlow<T, V>::value_type upperBound)
+{
+    m_vLowerBound.at(i) = lowerBound; 
+    m_vUpperBound.at(i) = upperBound; 
+}
+template <typename T, typename V>
+void DualMinCostFlow<T, V>::addObjectiveWeight(unsigned int i, typename DualMinCostFlow<T, V>::value_type weight)
+{
+    m_vWeight.at(i) += weight; 
+}
+template <typename T, typename V>
+unsigned int DualMinCostFlow<T, V>::addDifferenceConstraint(unsigned int i, unsigned int j, typename DualMinCostFlow<T, V>::value_type b, typename DualMinCostFlow<T, V>::value_type penalty)
+{
+    limboAssertMsg(m_model == NULL, "constraints of a model must be added to the model"); 
+    limboAssertMsg(i < m_vWeight.size() && j < m_vWeight.size() && i != j, "invalid variables %u and %u", i, j); 
+    m_vDiffSource.push_back(i); 
+    m_vDiffTarget.push_back(j); 
+    m_vDiffRhs.push_back(b); 
+    m_vDiffPenalty.push_back(penalty); 
+    return m_vDiffRhs.size()-1; 
+}
+template <typename T, typename V>
+void DualMinCostFlow<T, V>::setDifferenceConstraintRhs(unsigned int k, typename DualMinCostFlow<T, V>::value_type b)
+{
+    m_vDiffRhs.at(k) = b; 
+}
+template <typename T, typename V>
 void DualMinCostFlow<T, V>::printGraph(bool writeSol) const
 {
     limboPrint(kDEBUG, "diffBigM = %ld, boundBigM = %ld, reversedArcFlowCost = %ld\n", (long)m_diffBigM, (long)m_boundBigM, (long)m_reversedArcFlowCost);
@@ -323,9 +517,10 @@ void DualMinCostFlow<T, V>::printGraph(bool writeSol) const
         limboPrint(kDEBUG, "totalFlowCost = %ld, totalCost = %ld\n", (long)totalFlowCost(), (long)totalCost()); 
 
     node_name_map_type nameMap (m_graph); 
-    for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
-        nameMap[m_graph.nodeFromId(i)] = m_model->variableName(variable_type(i)); 
-    nameMap[m_graph.nodeFromId(m_graph.maxNodeId())] = "additional";
+    for (unsigned int i = 0, ie = numVariables(); i < ie; ++i)
+        nameMap[m_graph.nodeFromId(i)] = (m_model)? m_model->variableName(variable_type(i)) : "x"+limbo::to_string(i); 
+    if ((unsigned int)m_graph.nodeNum() > numVariables())
+        nameMap[m_graph.nodeFromId(m_graph.maxNodeId())] = "additional";
 
     // dump lgf file 
     lemon::DigraphWriter<graph_type> writer(m_graph, "debug.lgf");
@@ -341,6 +536,14 @@ void DualMinCostFlow<T, V>::printGraph(bool writeSol) const
 template <typename T, typename V>
 SolverProperty DualMinCostFlow<T, V>::solve(typename DualMinCostFlow<T, V>::solver_type* solver)
 {
+    // copy the model to the arrays of the difference constraint system 
+    if (m_model)
+        loadModel(); 
+
+    // skip empty problem 
+    if (numVariables() == 0)
+        return OPTIMAL; 
+
     bool defaultSolver = false; 
     // use default solver if NULL 
     if (solver == NULL)
@@ -349,12 +552,16 @@ SolverProperty DualMinCostFlow<T, V>::solve(typename DualMinCostFlow<T, V>::solv
         defaultSolver = true; 
     }
 
-    // skip empty problem 
-    if (m_model->numVariables() == 0)
-        return OPTIMAL; 
-
     // prepare 
     prepare();
+    // solve independent subnetworks separately 
+    SolverProperty status; 
+    if (m_decompose && solveSubnetworks(solver, status))
+    {
+        if (defaultSolver)
+            delete solver; 
+        return status; 
+    }
     // build graph 
     buildGraph();
 #ifdef DEBUG_DUALMINCOSTFLOW
@@ -366,7 +573,13 @@ SolverProperty DualMinCostFlow<T, V>::solve(typename DualMinCostFlow<T, V>::solv
     limboAssert(totalSupply == 0);
 #endif
     // solve min-cost flow problem 
-    SolverProperty status = solver->operator()(this); 
+    status = solver->operator()(this); 
+    // recover potentials from flows if needed 
+    if (status == OPTIMAL && (m_recoverPotential || !solver->providesPotential()))
+    {
+        bool recovered = m_potentialRecovery.run(m_mUpper, m_mCost, m_mFlow, m_mPotential, solver->providesPotential()); 
+        limboAssertMsg(recovered, "failed to recover potentials, flow is not optimal"); 
+    }
     // apply solution 
     applySolution(); 
 
@@ -380,6 +593,39 @@ SolverProperty DualMinCostFlow<T, V>::solve(typename DualMinCostFlow<T, V>::solv
     return status; 
 }
 template <typename T, typename V>
+void DualMinCostFlow<T, V>::loadModel() 
+{
+    unsigned int numVars = m_model->numVariables(); 
+    m_vWeight.assign(numVars, 0); 
+    m_vLowerBound.resize(numVars); 
+    m_vUpperBound.resize(numVars); 
+    for (unsigned int i = 0; i < numVars; ++i)
+    {
+        m_vLowerBound[i] = m_model->variableLowerBound(variable_type(i)); 
+        m_vUpperBound[i] = m_model->variableUpperBound(variable_type(i)); 
+    }
+    for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+        m_vWeight[it->variable().id()] += it->coefficient();
+
+    // arcs constraints like xi - xj >= cij 
+    // normalize to '>' format 
+    unsigned int numConstrs = m_model->constraints().size(); 
+    m_vDiffSource.resize(numConstrs); 
+    m_vDiffTarget.resize(numConstrs); 
+    m_vDiffRhs.resize(numConstrs); 
+    m_vDiffPenalty.assign(numConstrs, std::numeric_limits<value_type>::max()); 
+    for (unsigned int k = 0; k < numConstrs; ++k)
+    {
+        constraint_type& constr = m_model->constraints()[k]; 
+        limboAssertMsg(constr.expression().terms().size() == 2, "only support differential constraints like xi - xj >= cij");
+        constr.normalize('>');
+        std::vector<term_type> const& vTerm = constr.expression().terms();
+        m_vDiffSource[k] = ((vTerm[0].coefficient() > 0)? vTerm[0].variable() : vTerm[1].variable()).id();
+        m_vDiffTarget[k] = ((vTerm[0].coefficient() > 0)? vTerm[1].variable() : vTerm[0].variable()).id();
+        m_vDiffRhs[k] = constr.rightHandSide(); 
+    }
+}
+template <typename T, typename V>
 void DualMinCostFlow<T, V>::prepare() 
 {
     // big M should be larger than the summation of all non-negative supply in the graph 
@@ -388,10 +634,10 @@ void DualMinCostFlow<T, V>::prepare()
     if (m_diffBigM == std::numeric_limits<value_type>::max()) // if not set 
     {
         m_diffBigM = 0; 
-        for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+        for (typename std::vector<value_type>::const_iterator it = m_vWeight.begin(), ite = m_vWeight.end(); it != ite; ++it)
         {
-            if (it->coefficient() > 0)
-                m_diffBigM += it->coefficient();
+            if (*it > 0)
+                m_diffBigM += *it;
         }
     }
     // big M for bound constraints should be larger than that for differential constraints 
@@ -405,6 +651,10 @@ void DualMinCostFlow<T, V>::prepare()
 template <typename T, typename V>
 void DualMinCostFlow<T, V>::buildGraph() 
 {
+    // repeated solves rebuild the graph in the storage of the previous one, 
+    // so nodes and arcs keep their ids if the model keeps its shape 
+    m_graph.clear(); 
+
     // 1. preparing nodes 
     mapObjective2Graph();
 
@@ -424,11 +674,9 @@ void DualMinCostFlow<T, V>::mapObjective2Graph()
 {
     // preparing nodes 
     // set supply to its weight in the objective 
-    m_graph.reserveNode(m_model->numVariables()+1); // in case an additional node is necessary, which will be the last node  
-    for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
-        m_graph.addNode();
-    for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
-        m_mSupply[m_graph.nodeFromId(it->variable().id())] = it->coefficient();
+    m_graph.reserveNode(numVariables()+1); // in case an additional node is necessary, which will be the last node  
+    for (unsigned int i = 0, ie = numVariables(); i < ie; ++i)
+        m_mSupply[m_graph.addNode()] = m_vWeight[i];
 }
 template <typename T, typename V>
 unsigned int DualMinCostFlow<T, V>::mapDiffConstraint2Graph(bool countArcs) 
@@ -437,24 +685,14 @@ unsigned int DualMinCostFlow<T, V>::mapDiffConstraint2Graph(bool countArcs)
     // arcs constraints like xi - xj >= cij 
     // add arc from node i to node j with cost -cij and capacity unlimited 
 
-    unsigned int numArcs = m_model->constraints().size(); 
+    unsigned int numArcs = m_vDiffRhs.size(); 
     if (!countArcs) // skip in count arcs mode 
     {
-        // normalize to '>' format 
-        for (typename std::vector<constraint_type>::iterator it = m_model->constraints().begin(), ite = m_model->constraints().end(); it != ite; ++it)
-        {
-            constraint_type& constr = *it; 
-            limboAssertMsg(constr.expression().terms().size() == 2, "only support differential constraints like xi - xj >= cij");
-            constr.normalize('>');
-        }
-        for (typename std::vector<constraint_type>::const_iterator it = m_model->constraints().begin(), ite = m_model->constraints().end(); it != ite; ++it)
+        for (unsigned int k = 0; k < numArcs; ++k)
         {
-            constraint_type const& constr = *it; 
-            std::vector<term_type> const& vTerm = constr.expression().terms();
-            variable_type xi = (vTerm[0].coefficient() > 0)? vTerm[0].variable() : vTerm[1].variable();
-            variable_type xj = (vTerm[0].coefficient() > 0)? vTerm[1].variable() : vTerm[0].variable();
-
-            addArcForDiffConstraint(m_graph.nodeFromId(xi.id()), m_graph.nodeFromId(xj.id()), constr.rightHandSide(), m_diffBigM);
+            value_type penalty = m_vDiffPenalty[k]; 
+            addArcForDiffConstraint(m_graph.nodeFromId(m_vDiffSource[k]), m_graph.nodeFromId(m_vDiffTarget[k]), m_vDiffRhs[k], 
+                    (penalty == std::numeric_limits<value_type>::max())? m_diffBigM : penalty);
         }
     }
     return numArcs; 
@@ -467,13 +705,11 @@ unsigned int DualMinCostFlow<T, V>::mapBoundConstraint2Graph(bool countArcs)
 
     // check whether there is node with non-zero lower bound or non-infinity upper bound 
     unsigned int numArcs = 0; 
-    for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
+    for (unsigned int i = 0, ie = numVariables(); i < ie; ++i)
     {
-        value_type lowerBound = m_model->variableLowerBound(variable_type(i)); 
-        value_type upperBound = m_model->variableUpperBound(variable_type(i)); 
-        if (lowerBound != limbo::lowest<value_type>())
+        if (m_vLowerBound[i] != limbo::lowest<value_type>())
             ++numArcs; 
-        if (upperBound != std::numeric_limits<value_type>::max())
+        if (m_vUpperBound[i] != std::numeric_limits<value_type>::max())
             ++numArcs; 
     }
     if (!countArcs && numArcs) // skip in count arcs mode 
@@ -482,24 +718,22 @@ unsigned int DualMinCostFlow<T, V>::mapBoundConstraint2Graph(bool countArcs)
         // its corresponding weight is the negative sum of weight for other nodes 
         node_type addlNode = m_graph.addNode();
         value_type addlWeight = 0;
-        for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
-            addlWeight -= it->coefficient();
+        for (typename std::vector<value_type>::const_iterator it = m_vWeight.begin(), ite = m_vWeight.end(); it != ite; ++it)
+            addlWeight -= *it;
         m_mSupply[addlNode] = addlWeight; 
 
         // bound constraint is more important 
         // so it has higher cost than normal differential constraints  
-        for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
+        for (unsigned int i = 0, ie = numVariables(); i < ie; ++i)
         {
-            value_type lowerBound = m_model->variableLowerBound(variable_type(i)); 
-            value_type upperBound = m_model->variableUpperBound(variable_type(i)); 
             // has lower bound 
             // add arc from node to additional node with cost d and cap unlimited
-            if (lowerBound != limbo::lowest<value_type>())
-                addArcForDiffConstraint(m_graph.nodeFromId(i), addlNode, lowerBound, m_boundBigM);
+            if (m_vLowerBound[i] != limbo::lowest<value_type>())
+                addArcForDiffConstraint(m_graph.nodeFromId(i), addlNode, m_vLowerBound[i], m_boundBigM);
             // has upper bound 
             // add arc from additional node to node with cost u and capacity unlimited
-            if (upperBound != std::numeric_limits<value_type>::max())
-                addArcForDiffConstraint(addlNode, m_graph.nodeFromId(i), -upperBound, m_boundBigM); 
+            if (m_vUpperBound[i] != std::numeric_limits<value_type>::max())
+                addArcForDiffConstraint(addlNode, m_graph.nodeFromId(i), -m_vUpperBound[i], m_boundBigM); 
         }
     }
     return numArcs; 
@@ -538,11 +772,124 @@ void DualMinCostFlow<T, V>::applySolution()
 {
     // update solution 
     value_type addlValue = 0;
-    if ((unsigned int)m_graph.nodeNum() > m_model->numVariables()) // additional node has been introduced 
+    if ((unsigned int)m_graph.nodeNum() > numVariables()) // additional node has been introduced 
         addlValue = m_mPotential[m_graph.nodeFromId(m_graph.maxNodeId())];
-    unsigned int i = 0; 
-    for (typename std::vector<value_type>::iterator it = m_model->variableSolutions().begin(), ite = m_model->variableSolutions().end(); it != ite; ++it, ++i)
-        *it = m_mPotential[m_graph.nodeFromId(i)]-addlValue; 
+    m_vSolution.resize(numVariables()); 
+    for (unsigned int i = 0, ie = numVariables(); i < ie; ++i)
+        m_vSolution[i] = m_mPotential[m_graph.nodeFromId(i)]-addlValue; 
+    if (m_model)
+        std::copy(m_vSolution.begin(), m_vSolution.end(), m_model->variableSolutions().begin()); 
+}
+template <typename T, typename V>
+bool DualMinCostFlow<T, V>::solveSubnetworks(typename DualMinCostFlow<T, V>::solver_type* solver, SolverProperty& status)
+{
+    typedef limbo::containers::DisjointSet::SubsetHelper<unsigned int, unsigned int> subset_helper_type; 
+    unsigned int numVars = numVariables(); 
+    unsigned int numConstrs = numDifferenceConstraints(); 
+
+    // connected components of the constraint graph, bounds do not connect variables 
+    std::vector<unsigned int> vParent (numVars); 
+    std::vector<unsigned int> vRank (numVars); 
+    subset_helper_type gp (vParent, vRank); 
+    for (unsigned int k = 0; k < numConstrs; ++k)
+        limbo::containers::DisjointSet::union_set(gp, m_vDiffSource[k], m_vDiffTarget[k]); 
+    std::vector<unsigned int> vSize (numVars, 0); 
+    std::vector<unsigned int> vRoot; 
+    for (unsigned int i = 0; i < numVars; ++i)
+    {
+        vParent[i] = limbo::containers::DisjointSet::find_set(gp, i); 
+        if (vSize[vParent[i]]++ == 0)
+            vRoot.push_back(vParent[i]); 
+    }
+
+    // larger components first, small ones are grouped into one subnetwork 
+    std::vector<std::pair<unsigned int, unsigned int> > vOrder (vRoot.size()); 
+    for (unsigned int r = 0; r < vRoot.size(); ++r)
+        vOrder[r] = std::make_pair(numVars-vSize[vRoot[r]], vRoot[r]); 
+    std::sort(vOrder.begin(), vOrder.end()); 
+    std::vector<unsigned int> vSubnetworkSize; 
+    for (unsigned int r = 0; r < vOrder.size(); ++r)
+    {
+        if (vSubnetworkSize.empty() || vSubnetworkSize.back() >= s_minSubnetworkSize)
+            vSubnetworkSize.push_back(0); 
+        vSubnetworkSize.back() += numVars-vOrder[r].first; 
+        vRank[vOrder[r].second] = vSubnetworkSize.size()-1; // rank of a root is no longer needed 
+    }
+    m_numSubnetworks = vSubnetworkSize.size(); 
+    if (m_numSubnetworks <= 1)
+        return false; 
+
+    // copy variables and constraints to subnetworks with local indices 
+    SubnetworkPass pass; 
+    pass.vSubnetwork.resize(m_numSubnetworks); 
+    pass.vStatus.assign(m_numSubnetworks, OPTIMAL); 
+    for (unsigned int s = 0; s < m_numSubnetworks; ++s)
+    {
+        DualMinCostFlow* subnetwork = new DualMinCostFlow(); 
+        subnetwork->reserve(vSubnetworkSize[s], 0); 
+        subnetwork->setDiffBigM(m_diffBigM); 
+        subnetwork->setBoundBigM(m_boundBigM); 
+        subnetwork->setRecoverPotential(m_recoverPotential); 
+        pass.vSubnetwork[s] = subnetwork; 
+    }
+    std::vector<unsigned int> vLocal (numVars); 
+    for (unsigned int i = 0; i < numVars; ++i)
+    {
+        DualMinCostFlow* subnetwork = pass.vSubnetwork[vRank[vParent[i]]]; 
+        vLocal[i] = subnetwork->addVariable(m_vLowerBound[i], m_vUpperBound[i]); 
+        subnetwork->addObjectiveWeight(vLocal[i], m_vWeight[i]); 
+    }
+    for (unsigned int k = 0; k < numConstrs; ++k)
+        pass.vSubnetwork[vRank[vParent[m_vDiffSource[k]]]]->addDifferenceConstraint(vLocal[m_vDiffSource[k]], vLocal[m_vDiffTarget[k]], m_vDiffRhs[k], m_vDiffPenalty[k]); 
+
+    // each thread takes subnetworks with its own copy of the solver 
+    unsigned int numThreads = (m_numThreads)? m_numThreads : limbo::containers::num_threads(); 
+    numThreads = std::max(std::min(std::min(numThreads, limbo::containers::num_threads()), m_numSubnetworks), 1U); 
+    pass.vSolver.push_back(solver); 
+    for (unsigned int t = 1; t < numThreads; ++t)
+    {
+        solver_type* copy = solver->clone(); 
+        if (copy == NULL) // solver cannot be copied 
+            break; 
+        pass.vSolver.push_back(copy); 
+    }
+    pass.vBusy.assign(pass.vSolver.size(), 0); 
+    SubnetworkKernel kernel; 
+    kernel.pass = &pass; 
+    // no more threads than solvers, so each block finds a free solver 
+    limbo::containers::parallel_for(0, m_numSubnetworks, 1, pass.vSolver.size(), kernel); 
+    for (unsigned int t = 1; t < pass.vSolver.size(); ++t)
+        delete pass.vSolver[t]; 
+
+    // stitch solutions and costs 
+    status = OPTIMAL; 
+    m_totalFlowCost = 0; 
+    m_reversedArcFlowCost = 0; 
+    for (unsigned int s = 0; s < m_numSubnetworks; ++s)
+    {
+        if (status == OPTIMAL)
+            status = pass.vStatus[s]; 
+        m_totalFlowCost += pass.vSubnetwork[s]->m_totalFlowCost; 
+        m_reversedArcFlowCost += pass.vSubnetwork[s]->m_reversedArcFlowCost; 
+    }
+    m_vSolution.resize(numVars); 
+    for (unsigned int i = 0; i < numVars; ++i)
+        m_vSolution[i] = pass.vSubnetwork[vRank[vParent[i]]]->m_vSolution[vLocal[i]]; 
+    if (m_model)
+        std::copy(m_vSolution.begin(), m_vSolution.end(), m_model->variableSolutions().begin()); 
+    for (unsigned int s = 0; s < m_numSubnetworks; ++s)
+        delete pass.vSubnetwork[s]; 
+    return true; 
+}
+template <typename T, typename V>
+void DualMinCostFlow<T, V>::solveSubnetworkBlock(typename DualMinCostFlow<T, V>::SubnetworkPass& pass, std::size_t b, std::size_t e)
+{
+    unsigned int t = 0; 
+    while (!__sync_bool_compare_and_swap(&pass.vBusy[t], 0U, 1U))
+        t = (t+1)%pass.vBusy.size(); 
+    for (; b < e; ++b)
+        pass.vStatus[b] = pass.vSubnetwork[b]->solve(pass.vSolver[t]); 
+    __sync_lock_release(&pass.vBusy[t]); 
 }
 
 
@@ -578,6 +925,12 @@ class MinCostFlowSolver
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(dualsolver_type* d) = 0; 
+        /// @return true if the solver writes optimal potentials to the dual min-cost flow object; 
+        /// otherwise, only flows are written and potentials are recovered from them 
+        virtual bool providesPotential() const {return true;}
+        /// @return a new solver with the same settings to solve another problem, e.g., a subnetwork in another thread, 
+        /// or NULL if the solver cannot be copied; the caller deletes it 
+        virtual MinCostFlowSolver* clone() const {return NULL;}
     protected:
         /// @brief copy object 
         void copy(MinCostFlowSolver const& /*rhs*/) {} 
@@ -627,6 +980,9 @@ class CapacityScaling : public MinCostFlowSolver<T, V>
             return *this;
         }
 
+        /// @return a copy of the solver 
+        virtual base_type* clone() const {return new CapacityScaling(*this);}
+
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(dualsolver_type* d)
@@ -725,6 +1081,9 @@ class CostScaling : public MinCostFlowSolver<T, V>
             return *this;
         }
 
+        /// @return a copy of the solver 
+        virtual base_type* clone() const {return new CostScaling(*this);}
+
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(dualsolver_type* d)
@@ -823,6 +1182,9 @@ class NetworkSimplex : public MinCostFlowSolver<T, V>
             return *this;
         }
 
+        /// @return a copy of the solver 
+        virtual base_type* clone() const {return new NetworkSimplex(*this);}
+
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(dualsolver_type* d)
@@ -919,6 +1281,9 @@ class CycleCanceling : public MinCostFlowSolver<T, V>
             return *this;
         }
 
+        /// @return a copy of the solver 
+        virtual base_type* clone() const {return new CycleCanceling(*this);}
+
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(dualsolver_type* d)
@@ -971,6 +1336,119 @@ class CycleCanceling : public MinCostFlowSolver<T, V>
         typename alg_type::Method m_method; ///< method for the algorithm, SIMPLE_CYCLE_CANCELING, MINIMUM_MEAN_CYCLE_CANCELING, CANCEL_AND_TIGHTEN
 };
 
+/// @brief Network simplex algorithm for min-cost flow, warm started from the spanning tree of the previous solve. 
+/// Keep the object across solves of models with the same shape, 
+/// e.g., when only costs or right hand sides change between iterations; 
+/// see @ref limbo::solvers::WarmStartNetworkSimplex. 
+/// @tparam T coefficient type 
+/// @tparam V variable type 
+template <typename T, typename V>
+class IncrementalNetworkSimplex : public MinCostFlowSolver<T, V>
+{
+    public:
+        /// @brief value type 
+        typedef T value_type;
+        /// @brief base type 
+        typedef MinCostFlowSolver<T, V> base_type; 
+        /// @brief dual min-cost flow solver type 
+        typedef typename base_type::dualsolver_type dualsolver_type; 
+        /// @brief algorithm type 
+        typedef WarmStartNetworkSimplex<typename dualsolver_type::graph_type, 
+                value_type> alg_type;
+
+        /// @brief constructor 
+        IncrementalNetworkSimplex()
+            : base_type()
+            , m_alg(NULL)
+        {
+        }
+        /// @brief copy constructor, the spanning tree is not copied 
+        /// @param rhs right hand side 
+        IncrementalNetworkSimplex(IncrementalNetworkSimplex const& rhs)
+            : base_type(rhs)
+            , m_alg(NULL)
+        {
+            copy(rhs);
+        }
+        /// @brief assignment, the spanning tree is not copied 
+        /// @param rhs right hand side 
+        IncrementalNetworkSimplex& operator=(IncrementalNetworkSimplex const& rhs)
+        {
+            if (this != &rhs)
+            {
+                this->base_type::operator=(rhs); 
+                copy(rhs);
+            }
+            return *this;
+        }
+        /// @brief destructor 
+        ~IncrementalNetworkSimplex()
+        {
+            delete m_alg; 
+        }
+
+        /// @return a copy of the solver, the spanning tree is not copied 
+        virtual base_type* clone() const {return new IncrementalNetworkSimplex(*this);}
+
+        /// @brief API to run min-cost flow solver 
+        /// @param d dual min-cost flow object 
+        virtual SolverProperty operator()(dualsolver_type* d)
+        {
+            // 1. keep the algorithm and its spanning tree for the same graph 
+            if (m_alg == NULL || &m_alg->graph() != &d->graph())
+            {
+                delete m_alg; 
+                m_alg = new alg_type (d->graph());
+            }
+
+            // 2. run 
+            typename alg_type::ProblemType status = m_alg->resetParams()
+                //.lowerMap(d->lowerMap())
+                .upperMap(d->upperMap())
+                .costMap(d->costMap())
+                .supplyMap(d->supplyMap())
+                .run();
+
+            // 3. check results 
+            SolverProperty solverStatus; 
+            switch (status)
+            {
+                case alg_type::OPTIMAL:
+                    solverStatus = OPTIMAL; 
+                    break;
+                case alg_type::INFEASIBLE:
+                    solverStatus = INFEASIBLE; 
+                    break;
+                case alg_type::UNBOUNDED:
+                    solverStatus = UNBOUNDED; 
+                    break;
+                default:
+                    limboAssertMsg(0, "unknown status");
+            }
+
+            // 4. apply results 
+            // get dual solution of LP, which is the flow of min-cost flow, skip this if not necessary
+            m_alg->flowMap(d->flowMap());
+            // get solution of LP, which is the dual solution of min-cost flow 
+            m_alg->potentialMap(d->potentialMap());
+            // set total cost of min-cost flow 
+            d->setTotalFlowCost(m_alg->totalCost());
+
+            return solverStatus; 
+        }
+        /// @return true if the last solve started from the spanning tree of the previous one 
+        bool warmStarted() const {return m_alg && m_alg->warmStarted();}
+    protected:
+        /// @brief copy object, the algorithm is created again at the next solve 
+        void copy(IncrementalNetworkSimplex const& /*rhs*/)
+        {
+            delete m_alg; 
+            m_alg = NULL; 
+        }
+
+        alg_type* m_alg; ///< algorithm kept across solves 
+};
+
 
 } // namespace solvers 
 } // namespace limbo 
@@ -0,0 +1,175 @@
+/**
+ * @file   LagrangianFlowOracle.h
+ * @brief  Min-cost flow subproblems of @ref limbo::solvers::LagrangianRelaxation
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_LAGRANGIANFLOWORACLE_H
+#define LIMBO_SOLVERS_LAGRANGIANFLOWORACLE_H
+
+#include <limbo/solvers/LagrangianRelaxation.h>
+#include <limbo/solvers/MinCostFlow.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @brief Oracle for kept constraints of flow conservation, solved by @ref limbo::solvers::MinCostFlow.
+///
+/// Kept constraints must be equalities with coefficients 1 or -1 and each variable in at most two of them,
+/// so a shortest path is a flow of one unit from its source to its target.
+/// The graph is built once in @ref prepare and only costs change in later iterations,
+/// so @ref limbo::solvers::IncrementalNetworkSimplex by default starts from the previous spanning tree.
+/// Costs are rounded to integers after scaling the largest one to the resolution.
+/// This oracle is kept out of LagrangianRelaxation.h, which does not depend on lemon.
+/// @tparam T coefficient value type
+/// @tparam V variable value type
+template <typename T, typename V>
+class MinCostFlowOracle : public LagSubproblemOracle<T, V>
+{
+    public:
+        /// @brief base type
+        typedef LagSubproblemOracle<T, V> base_type;
+        /// @brief model type
+        typedef typename base_type::model_type model_type;
+        /// @brief coefficient value type
+        typedef typename base_type::coefficient_value_type coefficient_value_type;
+        /// @brief variable value type
+        typedef typename base_type::variable_value_type variable_value_type;
+        /// @brief constraint type
+        typedef typename base_type::constraint_type constraint_type;
+        /// @brief term type
+        typedef typename base_type::term_type term_type;
+        /// @brief integer model of the flow problem
+        typedef LinearModel<long, long> flow_model_type;
+        /// @brief min-cost flow problem
+        typedef MinCostFlow<long, long> flow_type;
+        /// @brief algorithm of min-cost flow
+        typedef MinCostFlowSolver<long, long> flow_solver_type;
+
+        /// @brief constructor
+        /// @param solver algorithm of min-cost flow, @ref limbo::solvers::IncrementalNetworkSimplex if NULL; the oracle does not own it
+        /// @param resolution integer cost of the largest cost
+        MinCostFlowOracle(flow_solver_type* solver = NULL, long resolution = 1000000)
+            : base_type()
+            , m_flowModel(NULL)
+            , m_flow(NULL)
+            , m_solver(solver)
+            , m_defaultSolver(NULL)
+            , m_resolution(resolution)
+        {
+        }
+        /// @brief destructor
+        ~MinCostFlowOracle()
+        {
+            clear();
+        }
+
+        /// @brief build the flow problem of the kept constraints
+        /// @param model model of the problem
+        /// @param vKept indices of constraints kept in the subproblem
+        void prepare(model_type const& model, std::vector<unsigned int> const& vKept, unsigned int /*numThreads*/)
+        {
+            std::vector<unsigned int> vVariableConstraint;
+            this->collectFreeVariables(model, vKept, vVariableConstraint);
+            clear();
+            m_flowModel = new flow_model_type();
+            m_flowModel->setOptimizeType(MIN);
+            m_vFlowVariable.clear();
+            std::vector<unsigned int> vLocal (model.numVariables(), std::numeric_limits<unsigned int>::max());
+            for (unsigned int i = 0, ie = model.numVariables(); i < ie; ++i)
+            {
+                if (vVariableConstraint[i] == 0)
+                    continue;
+                limboAssertMsg(vVariableConstraint[i] <= 2, "variable %u appears in %u kept constraints", i, vVariableConstraint[i]);
+                typename model_type::property_type const& property = model.variableProperties()[i];
+                vLocal[i] = m_vFlowVariable.size();
+                m_vFlowVariable.push_back(i);
+                m_flowModel->addVariable(flowValue(property.lowerBound()), flowValue(property.upperBound()), CONTINUOUS);
+            }
+            for (std::vector<unsigned int>::const_iterator it = vKept.begin(), ite = vKept.end(); it != ite; ++it)
+            {
+                constraint_type const& constr = model.constraints()[*it];
+                limboAssertMsg(constr.sense() == '=', "kept constraint %u is not flow conservation", *it);
+                typename flow_model_type::expression_type expr;
+                for (typename std::vector<term_type>::const_iterator itt = constr.expression().terms().begin(), itte = constr.expression().terms().end(); itt != itte; ++itt)
+                {
+                    limboAssertMsg(itt->coefficient() == 1 || itt->coefficient() == -1, "variable %u of kept constraint %u has coefficient %g",
+                            itt->variable().id(), *it, (double)itt->coefficient());
+                    expr += typename flow_model_type::term_type(m_flowModel->variable(vLocal[itt->variable().id()]), (long)itt->coefficient());
+                }
+                // a constraint with a single term becomes a bound, which the graph cannot express
+                bool added = m_flowModel->addConstraint(typename flow_model_type::constraint_type(expr, (long)constr.rightHandSide(), '='));
+                limboAssertMsg(added, "kept constraint %u is not flow conservation", *it);
+            }
+            m_flow = new flow_type(m_flowModel);
+            if (m_solver == NULL)
+                m_defaultSolver = new IncrementalNetworkSimplex<long, long>();
+        }
+        /// @brief solve the min-cost flow problem with rounded costs
+        /// @param vCost cost of each variable
+        /// @param vSolution solution of each variable
+        /// @return status of min-cost flow, or UNBOUNDED for free variables without bounds
+        SolverProperty operator()(coefficient_value_type const* vCost, variable_value_type* vSolution)
+        {
+            coefficient_value_type maxCost = 0;
+            for (std::vector<unsigned int>::const_iterator it = m_vFlowVariable.begin(), ite = m_vFlowVariable.end(); it != ite; ++it)
+                maxCost = std::max(maxCost, (coefficient_value_type)std::abs(vCost[*it]));
+            coefficient_value_type scale = (maxCost > 0)? m_resolution/maxCost : 1;
+            typename flow_model_type::expression_type obj;
+            for (unsigned int i = 0, ie = m_vFlowVariable.size(); i < ie; ++i)
+                obj += typename flow_model_type::term_type(m_flowModel->variable(i), (long)floor(vCost[m_vFlowVariable[i]]*scale+0.5));
+            m_flowModel->setObjective(obj);
+            SolverProperty status = m_flow->operator()((m_solver)? m_solver : m_defaultSolver);
+            if (status != OPTIMAL)
+                return status;
+            std::vector<long> const& vFlowSol = m_flowModel->variableSolutions();
+            for (unsigned int i = 0, ie = m_vFlowVariable.size(); i < ie; ++i)
+                vSolution[m_vFlowVariable[i]] = vFlowSol[i];
+            return this->solveFreeVariables(vCost, vSolution);
+        }
+
+    protected:
+        /// @brief copy constructor, forbidden
+        /// @param rhs right hand side
+        MinCostFlowOracle(MinCostFlowOracle const& rhs);
+        /// @brief assignment, forbidden
+        /// @param rhs right hand side
+        MinCostFlowOracle& operator=(MinCostFlowOracle const& rhs);
+
+        /// @brief recycle the flow problem
+        void clear()
+        {
+            delete m_flow;
+            delete m_flowModel;
+            delete m_defaultSolver;
+            m_flow = NULL;
+            m_flowModel = NULL;
+            m_defaultSolver = NULL;
+        }
+        /// @brief convert a bound to an integer capacity
+        /// @param v bound
+        /// @return capacity, infinite bounds are kept infinite
+        static long flowValue(variable_value_type v)
+        {
+            if (v >= std::numeric_limits<variable_value_type>::max() || (double)v >= (double)std::numeric_limits<long>::max())
+                return std::numeric_limits<long>::max();
+            else if (v <= limbo::lowest<variable_value_type>() || (double)v <= (double)limbo::lowest<long>())
+                return limbo::lowest<long>();
+            return (long)v;
+        }
+
+        flow_model_type* m_flowModel; ///< integer model of the flow problem
+        flow_type* m_flow; ///< min-cost flow problem, keeping its graph across iterations
+        flow_solver_type* m_solver; ///< algorithm of min-cost flow given by users
+        flow_solver_type* m_defaultSolver; ///< default algorithm, owned by the oracle
+        long m_resolution; ///< integer cost of the largest cost
+        std::vector<unsigned int> m_vFlowVariable; ///< variables of the model for arcs of the flow problem
+};
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
@@ -0,0 +1,668 @@
+/**
+ * @file   LagrangianRelaxation.h
+ * @brief  Solve linear models with lagrangian relaxation of chosen constraints and an oracle for the subproblem
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_LAGRANGIANRELAXATION_H
+#define LIMBO_SOLVERS_LAGRANGIANRELAXATION_H
+
+#include <limbo/solvers/MultiKnapsackLagRelax.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @brief Base class of oracles for the subproblem of @ref limbo::solvers::LagrangianRelaxation,
+/// which minimizes a linear cost subject to the constraints kept in the subproblem and the bounds of variables.
+///
+/// Variables in no kept constraint are set to one of their bounds by the sign of their costs
+/// with @ref solveFreeVariables, so an oracle only handles the structure of the kept constraints.
+/// @tparam T coefficient value type
+/// @tparam V variable value type
+template <typename T, typename V>
+class LagSubproblemOracle
+{
+    public:
+        /// @brief model type
+        typedef LinearModel<T, V> model_type;
+        /// @brief coefficient value type
+        typedef typename model_type::coefficient_value_type coefficient_value_type;
+        /// @brief variable value type
+        typedef typename model_type::variable_value_type variable_value_type;
+        /// @brief variable type
+        typedef typename model_type::variable_type variable_type;
+        /// @brief constraint type
+        typedef typename model_type::constraint_type constraint_type;
+        /// @brief term type
+        typedef typename model_type::term_type term_type;
+        /// @brief matrix type of relaxed constraints
+        typedef MatrixCSR<coefficient_value_type, int, 1> matrix_type;
+
+        /// @brief constructor
+        LagSubproblemOracle() : m_model(NULL) {}
+        /// @brief destructor
+        virtual ~LagSubproblemOracle() {}
+
+        /// @brief prepare for the kept constraints at the beginning of a solve
+        /// @param model model of the problem
+        /// @param vKept indices of constraints kept in the subproblem
+        /// @param numThreads number of threads in use
+        virtual void prepare(model_type const& model, std::vector<unsigned int> const& vKept, unsigned int numThreads) = 0;
+        /// @brief minimize \f$ c^T x \f$ subject to the kept constraints and bounds
+        /// @param vCost cost of each variable
+        /// @param vSolution solution of each variable
+        /// @return OPTIMAL if solved, INFEASIBLE or UNBOUNDED otherwise
+        virtual SolverProperty operator()(coefficient_value_type const* vCost, variable_value_type* vSolution) = 0;
+        /// @brief search for a solution satisfying the relaxed constraints from the last subproblem solution,
+        /// called at the end of a solve without any feasible subproblem solution
+        /// @param A scaled rows of relaxed constraints \f$ A x \le b \f$
+        /// @param vRhs right hand side \f$ b \f$
+        /// @param vCost costs of the last subproblem
+        /// @param vSolution solution of each variable, repaired in place
+        /// @return true if the relaxed constraints are satisfied
+        virtual bool repair(matrix_type const& /*A*/, coefficient_value_type const* /*vRhs*/, coefficient_value_type const* /*vCost*/, variable_value_type* /*vSolution*/)
+        {
+            return false;
+        }
+
+    protected:
+        /// @brief keep the model and collect variables in no kept constraint
+        /// @param model model of the problem
+        /// @param vKept indices of constraints kept in the subproblem
+        /// @param vVariableConstraint number of kept constraints of each variable
+        void collectFreeVariables(model_type const& model, std::vector<unsigned int> const& vKept, std::vector<unsigned int>& vVariableConstraint)
+        {
+            m_model = &model;
+            vVariableConstraint.assign(model.numVariables(), 0);
+            for (std::vector<unsigned int>::const_iterator it = vKept.begin(), ite = vKept.end(); it != ite; ++it)
+            {
+                std::vector<term_type> const& vTerm = model.constraints()[*it].expression().terms();
+                for (typename std::vector<term_type>::const_iterator itt = vTerm.begin(), itte = vTerm.end(); itt != itte; ++itt)
+                    ++vVariableConstraint[itt->variable().id()];
+            }
+            m_vFreeVariable.clear();
+            for (unsigned int i = 0, ie = model.numVariables(); i < ie; ++i)
+                if (vVariableConstraint[i] == 0)
+                    m_vFreeVariable.push_back(i);
+        }
+        /// @brief set variables in no kept constraint to their bounds
+        /// @param vCost cost of each variable
+        /// @param vSolution solution of each variable
+        /// @return UNBOUNDED if a variable with negative cost has no upper bound or vice versa, OPTIMAL otherwise
+        SolverProperty solveFreeVariables(coefficient_value_type const* vCost, variable_value_type* vSolution) const
+        {
+            for (std::vector<unsigned int>::const_iterator it = m_vFreeVariable.begin(), ite = m_vFreeVariable.end(); it != ite; ++it)
+            {
+                typename model_type::property_type const& property = m_model->variableProperties()[*it];
+                vSolution[*it] = (vCost[*it] < 0)? property.upperBound() : property.lowerBound();
+                if (vSolution[*it] == std::numeric_limits<variable_value_type>::max() || vSolution[*it] == limbo::lowest<variable_value_type>())
+                    return UNBOUNDED;
+            }
+            return OPTIMAL;
+        }
+
+        model_type const* m_model; ///< model of the problem
+        std::vector<unsigned int> m_vFreeVariable; ///< variables in no kept constraint
+};
+
+/// @brief Oracle for kept constraints of assignments \f$ \sum_{j} x_{ij} = 1 \f$ with binary variables,
+/// e.g., an item to one of its bins, a net to one of its layers or a segment to one of its tracks.
+/// Each group takes its variable of minimum cost, computed by threads in blocks of groups.
+/// Infeasible solutions are repaired by moving single groups to the variables reducing the violation the most,
+/// like the greedy reassignment of @ref limbo::solvers::SearchByAdjustCoefficient for bins.
+/// @tparam T coefficient value type
+/// @tparam V variable value type
+template <typename T, typename V>
+class AssignmentOracle : public LagSubproblemOracle<T, V>
+{
+    public:
+        /// @brief base type
+        typedef LagSubproblemOracle<T, V> base_type;
+        /// @brief model type
+        typedef typename base_type::model_type model_type;
+        /// @brief coefficient value type
+        typedef typename base_type::coefficient_value_type coefficient_value_type;
+        /// @brief variable value type
+        typedef typename base_type::variable_value_type variable_value_type;
+        /// @brief constraint type
+        typedef typename base_type::constraint_type constraint_type;
+        /// @brief term type
+        typedef typename base_type::term_type term_type;
+        /// @brief matrix type of relaxed constraints
+        typedef typename base_type::matrix_type matrix_type;
+
+        /// @brief constructor
+        AssignmentOracle() : base_type(), m_numThreads(1) {}
+
+        /// @brief group variables by the kept constraints
+        /// @param model model of the problem
+        /// @param vKept indices of constraints kept in the subproblem
+        /// @param numThreads number of threads in use
+        void prepare(model_type const& model, std::vector<unsigned int> const& vKept, unsigned int numThreads)
+        {
+            std::vector<unsigned int> vVariableConstraint;
+            this->collectFreeVariables(model, vKept, vVariableConstraint);
+            m_numThreads = numThreads;
+            m_vGroupBegin.assign(1, 0);
+            m_vGroupVariable.clear();
+            for (std::vector<unsigned int>::const_iterator it = vKept.begin(), ite = vKept.end(); it != ite; ++it)
+            {
+                constraint_type const& constr = model.constraints()[*it];
+                limboAssertMsg(constr.sense() == '=' && constr.rightHandSide() == 1, "kept constraint %u is not an assignment", *it);
+                for (typename std::vector<term_type>::const_iterator itt = constr.expression().terms().begin(), itte = constr.expression().terms().end(); itt != itte; ++itt)
+                {
+                    limboAssertMsg(itt->coefficient() == 1 && vVariableConstraint[itt->variable().id()] == 1,
+                            "variable %u of assignment %u has coefficient %g or more than one assignment", itt->variable().id(), *it, (double)itt->coefficient());
+                    m_vGroupVariable.push_back(itt->variable().id());
+                }
+                m_vGroupBegin.push_back(m_vGroupVariable.size());
+            }
+        }
+        /// @brief select the variable of minimum cost in each group
+        /// @param vCost cost of each variable
+        /// @param vSolution solution of each variable
+        /// @return OPTIMAL, or UNBOUNDED for free variables without bounds
+        SolverProperty operator()(coefficient_value_type const* vCost, variable_value_type* vSolution)
+        {
+            GroupKernel kernel;
+            kernel.oracle = this;
+            kernel.vCost = vCost;
+            kernel.vSolution = vSolution;
+            runNumericalKernel(kernel, m_vGroupBegin.size()-1, 256, m_numThreads);
+            return this->solveFreeVariables(vCost, vSolution);
+        }
+        /// @brief move groups one at a time to the variable reducing the total violation the most, ties broken by costs
+        /// @param A scaled rows of relaxed constraints \f$ A x \le b \f$
+        /// @param vRhs right hand side \f$ b \f$
+        /// @param vCost costs of the last subproblem
+        /// @param vSolution solution of each variable, repaired in place
+        /// @return true if the relaxed constraints are satisfied
+        bool repair(matrix_type const& A, coefficient_value_type const* vRhs, coefficient_value_type const* vCost, variable_value_type* vSolution);
+
+    protected:
+        /// @brief change of the total violation \f$ \sum_i \max(0, -s_i) \f$ if a group moves from variable j to variable k
+        /// @param j current variable
+        /// @param k new variable
+        /// @param vSlackness slackness of each row
+        /// @param vDelta change of slackness of each row, all zeros before and after the call
+        /// @return change of the total violation
+        coefficient_value_type violationChange(unsigned int j, unsigned int k, std::vector<coefficient_value_type> const& vSlackness, std::vector<coefficient_value_type>& vDelta) const;
+
+        /// @brief select variables of groups [b, e)
+        struct GroupKernel
+        {
+            AssignmentOracle const* oracle; ///< oracle
+            coefficient_value_type const* vCost; ///< cost of each variable
+            variable_value_type* vSolution; ///< solution of each variable
+            /// @param b first group
+            /// @param e end group
+            void operator()(unsigned int b, unsigned int e) const
+            {
+                std::vector<unsigned int> const& vGroupVariable = oracle->m_vGroupVariable;
+                for (; b < e; ++b)
+                {
+                    unsigned int best = vGroupVariable[oracle->m_vGroupBegin[b]];
+                    for (unsigned int k = oracle->m_vGroupBegin[b], ke = oracle->m_vGroupBegin[b+1]; k < ke; ++k)
+                    {
+                        vSolution[vGroupVariable[k]] = 0;
+                        if (vCost[vGroupVariable[k]] < vCost[best])
+                            best = vGroupVariable[k];
+                    }
+                    vSolution[best] = 1;
+                }
+            }
+        };
+
+        std::vector<unsigned int> m_vGroupBegin; ///< begin index of each group in @ref m_vGroupVariable, with one more entry for the end
+        std::vector<unsigned int> m_vGroupVariable; ///< variables of groups
+        std::vector<unsigned int> m_vVariableGroup; ///< group of each variable in @ref repair
+        std::vector<unsigned int> m_vColumnBegin; ///< begin index of each column of relaxed rows in @ref repair
+        std::vector<unsigned int> m_vColumnRow; ///< rows of columns
+        std::vector<coefficient_value_type> m_vColumnElement; ///< elements of columns
+        unsigned int m_numThreads; ///< number of threads in use
+};
+
+template <typename T, typename V>
+bool AssignmentOracle<T, V>::repair(typename AssignmentOracle<T, V>::matrix_type const& A, typename AssignmentOracle<T, V>::coefficient_value_type const* vRhs,
+        typename AssignmentOracle<T, V>::coefficient_value_type const* vCost, typename AssignmentOracle<T, V>::variable_value_type* vSolution)
+{
+    limboScopedTimer("AssignmentOracle::repair");
+    unsigned int numRows = A.numRows;
+    unsigned int numGroups = m_vGroupBegin.size()-1;
+    // columns of relaxed rows
+    m_vColumnBegin.assign(A.numColumns+1, 0);
+    for (int k = 0; k < A.numElements; ++k)
+        ++m_vColumnBegin[A.vColumn[k]-matrix_type::s_startingIndex+1];
+    for (unsigned int j = 0; j < (unsigned int)A.numColumns; ++j)
+        m_vColumnBegin[j+1] += m_vColumnBegin[j];
+    m_vColumnRow.resize(A.numElements);
+    m_vColumnElement.resize(A.numElements);
+    std::vector<unsigned int> vNext (m_vColumnBegin.begin(), m_vColumnBegin.end()-1);
+    for (unsigned int i = 0; i < numRows; ++i)
+        for (int k = A.vRowBeginIndex[i]-matrix_type::s_startingIndex, ke = A.vRowBeginIndex[i+1]-matrix_type::s_startingIndex; k < ke; ++k)
+        {
+            unsigned int& next = vNext[A.vColumn[k]-matrix_type::s_startingIndex];
+            m_vColumnRow[next] = i;
+            m_vColumnElement[next] = A.vElement[k];
+            ++next;
+        }
+    m_vVariableGroup.assign(A.numColumns, std::numeric_limits<unsigned int>::max());
+    for (unsigned int g = 0; g < numGroups; ++g)
+        for (unsigned int k = m_vGroupBegin[g]; k < m_vGroupBegin[g+1]; ++k)
+            m_vVariableGroup[m_vGroupVariable[k]] = g;
+
+    std::vector<coefficient_value_type> vSlackness (vRhs, vRhs+numRows);
+    if (numRows)
+        AxPlusy((coefficient_value_type)-1, A, vSolution, &vSlackness[0], m_numThreads);
+    std::vector<coefficient_value_type> vDelta (numRows, 0);
+    // each move reduces the violation, and a group rarely moves twice
+    for (unsigned int move = 0; move < 2*numGroups; ++move)
+    {
+        unsigned int bestFrom = std::numeric_limits<unsigned int>::max();
+        unsigned int bestTo = std::numeric_limits<unsigned int>::max();
+        coefficient_value_type bestChange = 0;
+        coefficient_value_type bestCost = std::numeric_limits<coefficient_value_type>::max();
+        bool feasible = true;
+        for (unsigned int i = 0; i < numRows; ++i)
+        {
+            if (vSlackness[i] >= 0)
+                continue;
+            feasible = false;
+            // selected variables adding to the violated row
+            for (int k = A.vRowBeginIndex[i]-matrix_type::s_startingIndex, ke = A.vRowBeginIndex[i+1]-matrix_type::s_startingIndex; k < ke; ++k)
+            {
+                unsigned int j = A.vColumn[k]-matrix_type::s_startingIndex;
+                unsigned int g = m_vVariableGroup[j];
+                if (A.vElement[k] <= 0 || vSolution[j] == 0 || g == std::numeric_limits<unsigned int>::max())
+                    continue;
+                for (unsigned int kk = m_vGroupBegin[g]; kk < m_vGroupBegin[g+1]; ++kk)
+                {
+                    unsigned int to = m_vGroupVariable[kk];
+                    if (to == j)
+                        continue;
+                    coefficient_value_type change = violationChange(j, to, vSlackness, vDelta);
+                    coefficient_value_type cost = vCost[to]-vCost[j];
+                    if (change < bestChange || (change == bestChange && change < 0 && cost < bestCost))
+                    {
+                        bestFrom = j;
+                        bestTo = to;
+                        bestChange = change;
+                        bestCost = cost;
+                    }
+                }
+            }
+        }
+        if (feasible)
+            return true;
+        if (bestTo == std::numeric_limits<unsigned int>::max())
+            return false;
+        // apply the move
+        vSolution[bestFrom] = 0;
+        vSolution[bestTo] = 1;
+        for (unsigned int k = m_vColumnBegin[bestFrom]; k < m_vColumnBegin[bestFrom+1]; ++k)
+            vSlackness[m_vColumnRow[k]] += m_vColumnElement[k];
+        for (unsigned int k = m_vColumnBegin[bestTo]; k < m_vColumnBegin[bestTo+1]; ++k)
+            vSlackness[m_vColumnRow[k]] -= m_vColumnElement[k];
+    }
+    for (unsigned int i = 0; i < numRows; ++i)
+        if (vSlackness[i] < 0)
+            return false;
+    return true;
+}
+template <typename T, typename V>
+typename AssignmentOracle<T, V>::coefficient_value_type AssignmentOracle<T, V>::violationChange(unsigned int j, unsigned int k,
+        std::vector<typename AssignmentOracle<T, V>::coefficient_value_type> const& vSlackness, std::vector<typename AssignmentOracle<T, V>::coefficient_value_type>& vDelta) const
+{
+    for (unsigned int c = m_vColumnBegin[j]; c < m_vColumnBegin[j+1]; ++c)
+        vDelta[m_vColumnRow[c]] += m_vColumnElement[c];
+    for (unsigned int c = m_vColumnBegin[k]; c < m_vColumnBegin[k+1]; ++c)
+        vDelta[m_vColumnRow[c]] -= m_vColumnElement[c];
+    coefficient_value_type change = 0;
+    // rows of both columns, each row counted once as its delta is reset
+    unsigned int vColumn[2] = {j, k};
+    for (unsigned int t = 0; t < 2; ++t)
+        for (unsigned int c = m_vColumnBegin[vColumn[t]]; c < m_vColumnBegin[vColumn[t]+1]; ++c)
+        {
+            unsigned int i = m_vColumnRow[c];
+            if (vDelta[i] == 0)
+                continue;
+            change += std::max((coefficient_value_type)0, -(vSlackness[i]+vDelta[i])) - std::max((coefficient_value_type)0, -vSlackness[i]);
+            vDelta[i] = 0;
+        }
+    return change;
+}
+
+/// @brief Solve a linear model by lagrangian relaxation of chosen constraints.
+///
+/// Constraints picked with @ref relaxConstraint move into the objective with multipliers \f$ \lambda \f$,
+/// and the subproblem over the other constraints,
+/// \f{eqnarray*}{
+/// & min. & c^T x + \lambda^T (A x - b), \\[0pt]
+/// & s.t. & \textrm{kept constraints and bounds},
+/// \f}
+/// \n
+/// is solved in each iteration by an oracle derived from @ref limbo::solvers::LagSubproblemOracle,
+/// such as @ref limbo::solvers::AssignmentOracle or limbo::solvers::MinCostFlowOracle in LagrangianFlowOracle.h,
+/// which also covers shortest paths with a unit of supply.
+/// @ref limbo::solvers::MultiKnapsackLagRelax is the special case of assignments kept and capacities relaxed.
+///
+/// Relaxed constraints are normalized to \f$ A x \le b \f$, with equalities split into two rows,
+/// and scaled by a @ref limbo::solvers::ProblemScaler without changing the model.
+/// Multipliers are updated by a @ref limbo::solvers::LagMultiplierUpdater from the slackness \f$ b - A x \f$.
+/// The costs \f$ c + A^T \lambda \f$, the slackness and the lagrangian objective are computed by threads.
+/// Each subproblem solution satisfying the relaxed constraints is a feasible solution, and the best one is kept;
+/// the iterations stop at the complementary slackness \f$ \lambda_i (b - A x)_i = 0 \f$ or the maximum iterations.
+/// The best lagrangian objective is a lower bound of the problem, see @ref lowerBound.
+///
+/// The feasible searchers of @ref limbo::solvers::MultiKnapsackLagRelax rely on its groups of items and bins,
+/// so repairing is left to @ref limbo::solvers::LagSubproblemOracle::repair, called if no subproblem solution is feasible;
+/// without a repaired solution, the last one is kept with INFEASIBLE.
+/// @tparam T coefficient type
+/// @tparam V variable type
+template <typename T, typename V>
+class LagrangianRelaxation
+{
+    public:
+        /// @brief linear model type for the problem
+        typedef LinearModel<T, V> model_type;
+        /// @nowarn
+        typedef typename model_type::coefficient_value_type coefficient_value_type;
+        typedef typename model_type::variable_value_type variable_value_type;
+        typedef typename model_type::variable_type variable_type;
+        typedef typename model_type::constraint_type constraint_type;
+        typedef typename model_type::expression_type expression_type;
+        typedef typename model_type::term_type term_type;
+        typedef typename NumericalAccumulator<coefficient_value_type>::type accumulator_type;
+        typedef MatrixCSR<coefficient_value_type, int, 1> matrix_type;
+        typedef LagMultiplierUpdater<coefficient_value_type> updater_type;
+        typedef ProblemScaler<coefficient_value_type, variable_value_type> scaler_type;
+        typedef LagSubproblemOracle<coefficient_value_type, variable_value_type> oracle_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param model pointer to the model of problem
+        LagrangianRelaxation(model_type* model)
+            : m_model(model)
+            , m_objScalingFactor(1)
+            , m_lowerBound(-std::numeric_limits<coefficient_value_type>::max())
+            , m_bestObj(std::numeric_limits<coefficient_value_type>::max())
+            , m_iter(0)
+            , m_maxIters(1000)
+            , m_maxThreads(1)
+            , m_numThreads(1)
+        {
+            // T must be a floating point number
+            limboStaticAssert(!std::numeric_limits<T>::is_integer);
+        }
+
+        /// @brief API to run the algorithm
+        /// @param oracle an object to solve the subproblem
+        /// @param updater an object to update lagrangian multipliers, use default updater if NULL
+        /// @param scaler an object to scale relaxed constraints and objective, use default scaler if NULL
+        /// @return OPTIMAL at complementary slackness, SUBOPTIMAL with a feasible solution,
+        /// INFEASIBLE without one, or the status of a subproblem the oracle failed to solve
+        SolverProperty operator()(oracle_type* oracle, updater_type* updater = NULL, scaler_type* scaler = NULL)
+        {
+            return solve(oracle, updater, scaler);
+        }
+
+        /// @brief relax a constraint into the objective
+        /// @param i index of the constraint in the model
+        void relaxConstraint(unsigned int i) {m_vRelaxed.push_back(i);}
+        /// @brief set constraints relaxed into the objective
+        /// @param vRelaxed indices of constraints in the model
+        void setRelaxedConstraints(std::vector<unsigned int> const& vRelaxed) {m_vRelaxed = vRelaxed;}
+        /// @return indices of relaxed constraints
+        std::vector<unsigned int> const& relaxedConstraints() const {return m_vRelaxed;}
+        /// @return maximum iterations
+        unsigned int maxIterations() const {return m_maxIters;}
+        /// @brief set maximum iterations
+        /// @param maxIter maximum iterations
+        void setMaxIterations(unsigned int maxIter) {m_maxIters = maxIter;}
+        /// @brief set maximum number of threads, limited by the number of cores
+        /// @param t number of threads
+        void setNumThreads(unsigned int t) {m_maxThreads = std::max(t, 1U);}
+        /// @return number of iterations of the last solve
+        unsigned int numIterations() const {return m_iter;}
+        /// @return best objective of the lagrangian subproblem in the last solve, a lower bound of the problem
+        coefficient_value_type lowerBound() const {return m_lowerBound;}
+        /// @return objective of the best feasible solution in the last solve, maximum value if none
+        coefficient_value_type bestObjective() const {return m_bestObj;}
+
+    protected:
+        /// @brief copy constructor, forbidden
+        /// @param rhs right hand side
+        LagrangianRelaxation(LagrangianRelaxation const& rhs);
+        /// @brief assignment, forbidden
+        /// @param rhs right hand side
+        LagrangianRelaxation& operator=(LagrangianRelaxation const& rhs);
+
+        /// @brief kernel function to solve the problem
+        /// @param oracle an object to solve the subproblem
+        /// @param updater an object to update lagrangian multipliers
+        /// @param scaler an object to scale relaxed constraints and objective
+        /// @return solving status
+        SolverProperty solve(oracle_type* oracle, updater_type* updater, scaler_type* scaler);
+        /// @brief build scaled rows of relaxed constraints and the scaled objective
+        /// @param scaler an object to scale relaxed constraints and objective
+        void prepare(scaler_type* scaler);
+        /// @brief check feasibility and complementary slackness of the solution, keep it if it is the best one
+        /// @return OPTIMAL at complementary slackness, SUBOPTIMAL if feasible, INFEASIBLE otherwise
+        SolverProperty converge();
+        /// @brief objective \f$ c^T x \f$ of the current solution with scaled costs
+        /// @param vCost costs
+        /// @return objective
+        accumulator_type evaluate(coefficient_value_type const* vCost) const;
+
+        model_type* m_model; ///< model for the problem
+        std::vector<unsigned int> m_vRelaxed; ///< indices of relaxed constraints
+        std::vector<unsigned int> m_vKept; ///< indices of constraints kept in the subproblem
+
+        matrix_type m_constrMatrix; ///< scaled rows \f$ A \f$ of relaxed constraints
+        std::vector<coefficient_value_type> m_vConstrRhs; ///< scaled right hand side \f$ b \f$
+        std::vector<coefficient_value_type> m_vObjCoef; ///< scaled coefficients of variables in objective
+        std::vector<coefficient_value_type> m_vCost; ///< costs \f$ c + A^T \lambda \f$ of the subproblem
+        std::vector<coefficient_value_type> m_vLagMultiplier; ///< lagrangian multiplier of each row
+        std::vector<coefficient_value_type> m_vNewLagMultiplier; ///< new lagrangian multipliers, temporary storage
+        std::vector<coefficient_value_type> m_vSlackness; ///< slackness \f$ b - A x \f$ of each row
+        coefficient_value_type m_objScalingFactor; ///< scaling factor of the objective
+
+        std::vector<variable_value_type> m_vBestVariableSol; ///< best feasible solution found so far
+        coefficient_value_type m_lowerBound; ///< best objective of the lagrangian subproblem, unscaled
+        coefficient_value_type m_bestObj; ///< objective of the best feasible solution, unscaled
+        unsigned int m_iter; ///< current iteration
+        unsigned int m_maxIters; ///< maximum number of iterations
+        unsigned int m_maxThreads; ///< maximum number of threads
+        unsigned int m_numThreads; ///< number of threads in use, limited by the number of cores
+};
+
+template <typename T, typename V>
+SolverProperty LagrangianRelaxation<T, V>::solve(typename LagrangianRelaxation<T, V>::oracle_type* oracle,
+        typename LagrangianRelaxation<T, V>::updater_type* updater, typename LagrangianRelaxation<T, V>::scaler_type* scaler)
+{
+    limboScopedTimer("LagrangianRelaxation::solve");
+    bool defaultUpdater = false;
+    bool defaultScaler = false;
+    // use default updater if NULL
+    if (updater == NULL)
+    {
+        updater = new SubGradientDescent<coefficient_value_type>();
+        defaultUpdater = true;
+    }
+    // use default scaler if NULL
+    if (scaler == NULL)
+    {
+        scaler = new L2NormScaler<coefficient_value_type, variable_value_type>();
+        defaultScaler = true;
+    }
+
+    // threads beyond the number of cores only add overhead
+    m_numThreads = std::min(limbo::containers::num_threads(), m_maxThreads);
+
+    prepare(scaler);
+    oracle->prepare(*m_model, m_vKept, m_numThreads);
+
+    unsigned int numVars = m_model->numVariables();
+    unsigned int numRows = m_vConstrRhs.size();
+    variable_value_type* vVariableSol = (numVars)? &m_model->variableSolutions()[0] : NULL;
+    SolverProperty status = INFEASIBLE;
+    bool subproblemSolved = false;
+    for (m_iter = 0; m_iter < m_maxIters; ++m_iter)
+    {
+        limboCounterAdd("LagrangianRelaxation::iterations", 1);
+        // c + A^T \lambda
+        std::copy(m_vObjCoef.begin(), m_vObjCoef.end(), m_vCost.begin());
+        if (numRows)
+            ATxPlusy((coefficient_value_type)1, m_constrMatrix, &m_vLagMultiplier[0], &m_vCost[0], m_numThreads);
+        SolverProperty oracleStatus = oracle->operator()((numVars)? &m_vCost[0] : NULL, vVariableSol);
+        if (oracleStatus != OPTIMAL)
+        {
+            status = oracleStatus;
+            subproblemSolved = false;
+            break;
+        }
+        subproblemSolved = true;
+        // s = b-Ax
+        std::copy(m_vConstrRhs.begin(), m_vConstrRhs.end(), m_vSlackness.begin());
+        if (numRows)
+            AxPlusy((coefficient_value_type)-1, m_constrMatrix, vVariableSol, &m_vSlackness[0], m_numThreads);
+        // c^T x + \lambda^T (Ax-b)
+        coefficient_value_type lagObj = evaluate((numVars)? &m_vCost[0] : NULL)
+            - ((numRows)? dot(numRows, &m_vConstrRhs[0], &m_vLagMultiplier[0], m_numThreads) : 0);
+        m_lowerBound = std::max(m_lowerBound, lagObj*m_objScalingFactor);
+
+        status = converge();
+        if (status == OPTIMAL || m_iter+1 == m_maxIters)
+            break;
+
+        // update lagrangian multipliers
+        if (updater->needObjective())
+            updater->setObjective(lagObj, (m_bestObj == std::numeric_limits<coefficient_value_type>::max())? m_bestObj : m_bestObj/m_objScalingFactor);
+        updater->operator()(m_iter, numRows, (numRows)? &m_vSlackness[0] : NULL, (numRows)? &m_vLagMultiplier[0] : NULL, (numRows)? &m_vNewLagMultiplier[0] : NULL);
+        m_vLagMultiplier.swap(m_vNewLagMultiplier);
+    }
+    // repair the last subproblem solution if none is feasible
+    if (status == INFEASIBLE && subproblemSolved && m_vBestVariableSol.empty()
+            && oracle->repair(m_constrMatrix, &m_vConstrRhs[0], (numVars)? &m_vCost[0] : NULL, vVariableSol))
+    {
+        std::copy(m_vConstrRhs.begin(), m_vConstrRhs.end(), m_vSlackness.begin());
+        AxPlusy((coefficient_value_type)-1, m_constrMatrix, vVariableSol, &m_vSlackness[0], m_numThreads);
+        converge();
+    }
+    // the last solution is kept if no solution is feasible
+    if (status == SUBOPTIMAL || (status == INFEASIBLE && !m_vBestVariableSol.empty()))
+    {
+        m_model->variableSolutions() = m_vBestVariableSol;
+        status = SUBOPTIMAL;
+    }
+
+    // recycle default updater
+    if (defaultUpdater)
+        delete updater;
+    // recycle default scaler
+    if (defaultScaler)
+        delete scaler;
+
+    return status;
+}
+template <typename T, typename V>
+void LagrangianRelaxation<T, V>::prepare(typename LagrangianRelaxation<T, V>::scaler_type* scaler)
+{
+    unsigned int numVars = m_model->numVariables();
+    std::vector<constraint_type> const& vConstraint = m_model->constraints();
+    std::vector<bool> vRelaxedFlag (vConstraint.size(), false);
+    for (std::vector<unsigned int>::const_iterator it = m_vRelaxed.begin(), ite = m_vRelaxed.end(); it != ite; ++it)
+        vRelaxedFlag.at(*it) = true;
+    m_vKept.clear();
+    for (unsigned int i = 0, ie = vConstraint.size(); i < ie; ++i)
+        if (!vRelaxedFlag[i])
+            m_vKept.push_back(i);
+
+    // rows in Ax <= b, an equality takes two rows
+    unsigned int numRows = 0;
+    typename matrix_type::index_type numElements = 0;
+    for (std::vector<unsigned int>::const_iterator it = m_vRelaxed.begin(), ite = m_vRelaxed.end(); it != ite; ++it)
+    {
+        unsigned int copies = (vConstraint[*it].sense() == '=')? 2 : 1;
+        numRows += copies;
+        numElements += copies*vConstraint[*it].expression().terms().size();
+    }
+    // scaling factors of all constraints and the objective by threads
+    std::vector<coefficient_value_type> vScalingFactor;
+    scaler->computeScalingFactors(*m_model, vScalingFactor, m_numThreads);
+    m_constrMatrix.initialize(numRows, numVars, numElements);
+    m_constrMatrix.vRowBeginIndex[0] = matrix_type::s_startingIndex;
+    m_vConstrRhs.resize(numRows);
+    unsigned int row = 0;
+    typename matrix_type::index_type k = 0;
+    for (std::vector<unsigned int>::const_iterator it = m_vRelaxed.begin(), ite = m_vRelaxed.end(); it != ite; ++it)
+    {
+        constraint_type const& constr = vConstraint[*it];
+        coefficient_value_type scalingFactor = (vScalingFactor[*it] > 0)? vScalingFactor[*it] : 1;
+        for (unsigned int copy = 0; copy < ((constr.sense() == '=')? 2U : 1U); ++copy, ++row)
+        {
+            coefficient_value_type sign = (constr.sense() == '>' || copy)? -1 : 1;
+            for (typename std::vector<term_type>::const_iterator itt = constr.expression().terms().begin(), itte = constr.expression().terms().end(); itt != itte; ++itt, ++k)
+            {
+                m_constrMatrix.vElement[k] = sign*itt->coefficient()/scalingFactor;
+                m_constrMatrix.vColumn[k] = itt->variable().id()+matrix_type::s_startingIndex;
+            }
+            m_constrMatrix.vRowBeginIndex[row+1] = k+matrix_type::s_startingIndex;
+            m_vConstrRhs[row] = sign*constr.rightHandSide()/scalingFactor;
+        }
+    }
+
+    // objective of minimization
+    m_objScalingFactor = (vScalingFactor.back() > 0)? vScalingFactor.back() : 1;
+    coefficient_value_type sign = (m_model->optimizeType() == MAX)? -1 : 1;
+    m_vObjCoef.assign(numVars, 0);
+    for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+        m_vObjCoef[it->variable().id()] += sign*it->coefficient()/m_objScalingFactor;
+    m_objScalingFactor *= sign;
+
+    m_vCost.resize(numVars);
+    m_vLagMultiplier.assign(numRows, 0);
+    m_vNewLagMultiplier.assign(numRows, 0);
+    m_vSlackness.assign(numRows, 0);
+    m_vBestVariableSol.clear();
+    m_lowerBound = -std::numeric_limits<coefficient_value_type>::max();
+    m_bestObj = std::numeric_limits<coefficient_value_type>::max();
+}
+template <typename T, typename V>
+SolverProperty LagrangianRelaxation<T, V>::converge()
+{
+    bool convergeFlag = true;
+    for (unsigned int i = 0, ie = m_vSlackness.size(); i < ie; ++i)
+    {
+        // KKT conditions: lambda >= 0, Ax-b <= 0, lambda * (Ax-b) = 0
+        if (m_vSlackness[i] < 0)
+            return INFEASIBLE;
+        else if (m_vLagMultiplier[i]*m_vSlackness[i] != 0)
+            convergeFlag = false;
+    }
+    // store feasible solutions with better objective
+    coefficient_value_type obj = evaluate((m_vObjCoef.empty())? NULL : &m_vObjCoef[0])*m_objScalingFactor;
+    if (m_vBestVariableSol.empty() || obj < m_bestObj)
+    {
+        m_vBestVariableSol = m_model->variableSolutions();
+        m_bestObj = obj;
+    }
+    return (convergeFlag)? OPTIMAL : SUBOPTIMAL;
+}
+template <typename T, typename V>
+typename LagrangianRelaxation<T, V>::accumulator_type LagrangianRelaxation<T, V>::evaluate(typename LagrangianRelaxation<T, V>::coefficient_value_type const* vCost) const
+{
+    std::vector<variable_value_type> const& vVariableSol = m_model->variableSolutions();
+    accumulator_type obj = 0;
+    for (unsigned int i = 0, ie = vVariableSol.size(); i < ie; ++i)
+        obj += (accumulator_type)vCost[i]*vVariableSol[i];
+    return obj;
+}
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
@@ -0,0 +1,422 @@
+/**
+ * @file   LowRankSdp.h
+ * @brief  Solve sparse SDP with unit diagonal by low-rank factorization of Burer and Monteiro.
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_LOWRANKSDP_H
+#define LIMBO_SOLVERS_LOWRANKSDP_H
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @class limbo::solvers::LowRankSdp
+/// @brief Solve a sparse SDP with unit diagonal by low-rank factorization.
+///
+/// The problem is \n
+/// \f{eqnarray*}{
+/// & min. & \sum_{(i, j) \in E} c_{ij} X_{ij}, \\[0pt]
+/// & s.t. & X_{ii} = 1, \forall i \in V, \\[0pt]
+/// &      & X_{ij} \ge l_{ij}, \forall (i, j) \in B \subseteq E, \\[0pt]
+/// &      & X \succeq 0.
+/// \f}
+/// \n
+/// Following Burer and Monteiro, \f$X = V V^T\f$ with \f$V\f$ of size \f$|V| \times r\f$,
+/// so the diagonal constraints keep each row \f$v_i\f$ on the unit sphere.
+/// Lower bounds are handled by an augmented Lagrangian,
+/// \f[
+/// \sum_{(i, j) \in E} c_{ij} v_i^T v_j + \frac{\rho}{2} \sum_{(i, j) \in B} \max(0, \lambda_{ij}/\rho + l_{ij} - v_i^T v_j)^2,
+/// \f]
+/// which is minimized by projected gradient steps on the spheres.
+/// Every step reads the rows of the previous iteration, so vertices are updated by threads in parallel
+/// and the result does not depend on the number of threads.
+/// Each iteration costs \f$O(r |E|)\f$ instead of \f$O(|V|^3)\f$ of interior point methods.
+///
+/// The problem is not convex in \f$V\f$, so the solution is a local optimum,
+/// which is usually good enough to round.
+///
+/// @tparam T value type
+template <typename T>
+class LowRankSdp
+{
+    public:
+        /// @brief value type
+        typedef T value_type;
+
+        /// @brief constructor
+        /// @param n number of rows of the variable matrix
+        LowRankSdp(uint32_t n);
+
+        /// @brief add \f$c X_{st}\f$ to the objective
+        /// @param s, t indices of the entry
+        /// @param cost coefficient
+        void add_term(uint32_t s, uint32_t t, value_type cost);
+        /// @brief add \f$c X_{st}\f$ to the objective with constraint \f$X_{st} \ge l\f$
+        /// @param s, t indices of the entry
+        /// @param cost coefficient
+        /// @param lb lower bound
+        void add_term(uint32_t s, uint32_t t, value_type cost, value_type lb);
+        /// @brief set rank of factorization, 0 for \f$\lceil \sqrt{2 (|V|+|B|)} \rceil\f$ up to 16
+        /// @param r rank
+        void rank(uint32_t r) {m_rank = r;}
+        /// @brief set number of threads
+        /// @param t number of threads
+        void threads(int32_t t) {m_threads = t;}
+        /// @brief set maximum number of gradient steps
+        /// @param n number of steps
+        void max_iters(uint32_t n) {m_max_iters = n;}
+        /// @brief set tolerance of constraint violations
+        /// @param t tolerance
+        void tolerance(value_type t) {m_tolerance = t;}
+        /// @brief set seed of the random initial solution
+        /// @param s seed
+        void seed(uint32_t s) {m_seed = s;}
+
+        /// @brief solve the problem
+        /// @return objective value
+        value_type operator()();
+
+        /// @return number of rows
+        uint32_t num_vertices() const {return m_num_vertices;}
+        /// @return rank of the solution
+        uint32_t dimension() const {return m_dim;}
+        /// @param i row
+        /// @return unit vector of row \a i
+        value_type const* vector(uint32_t i) const {return &m_vV[i*m_dim];}
+        /// @param i, j indices
+        /// @return \f$X_{ij}\f$ of the solution
+        value_type inner(uint32_t i, uint32_t j) const {return dot(vector(i), vector(j));}
+        /// @return objective value of the solution
+        value_type objective() const;
+        /// @return maximum violation of lower bounds
+        value_type max_violation() const;
+        /// @return number of gradient steps
+        uint32_t iterations() const {return m_iters;}
+    protected:
+        /// @brief a term in the objective
+        struct term_type
+        {
+            uint32_t s; ///< row
+            uint32_t t; ///< column
+            value_type cost; ///< coefficient
+            value_type lb; ///< lower bound
+            bool bounded; ///< whether the lower bound applies
+        };
+        /// @brief work done by threads
+        enum PassType
+        {
+            TERM_PASS, ///< entries, gradient weights and penalties of terms
+            VERTEX_PASS ///< gradient steps of rows
+        };
+
+        /// @brief build adjacency of rows and the initial solution
+        void build();
+        /// @brief compute step sizes of rows
+        void compute_steps();
+        /// @brief run a pass with threads
+        /// @param pass work to do
+        /// @return sum of the augmented Lagrangian over terms after \a TERM_PASS
+        value_type run(PassType pass);
+        /// @brief blocks of a pass run by limbo::containers::parallel_for
+        struct BlockKernel
+        {
+            LowRankSdp* solver; ///< solver
+            PassType pass; ///< work to do
+            /// @param b first item
+            /// @param e end item
+            void operator()(std::size_t b, std::size_t e) const
+            {
+                if (pass == TERM_PASS)
+                    solver->term_block(b, e);
+                else
+                    solver->vertex_block(b, e);
+            }
+        };
+        /// @brief update entries of terms in [b, e)
+        void term_block(uint32_t b, uint32_t e);
+        /// @brief take gradient steps for rows in [b, e)
+        void vertex_block(uint32_t b, uint32_t e);
+        /// @return inner product of two rows
+        value_type dot(value_type const* a, value_type const* b) const
+        {
+            value_type r = 0;
+            for (uint32_t k = 0; k < m_dim; ++k)
+                r += a[k]*b[k];
+            return r;
+        }
+
+        uint32_t m_num_vertices; ///< number of rows
+        std::vector<term_type> m_vTerm; ///< terms of the objective
+        std::vector<uint32_t> m_vAdjBegin; ///< terms of each row start from here in m_vAdjTerm
+        std::vector<uint32_t> m_vAdjTerm; ///< terms incident to each row
+        uint32_t m_dim; ///< rank of the solution
+        std::vector<value_type> m_vV; ///< rows of the factor
+        std::vector<value_type> m_vNext; ///< rows after a gradient step
+        std::vector<value_type> m_vX; ///< entry of each term
+        std::vector<value_type> m_vWeight; ///< derivative of the augmented Lagrangian to the entry of each term
+        std::vector<value_type> m_vValue; ///< augmented Lagrangian of each term
+        std::vector<value_type> m_vLambda; ///< multiplier of each term
+        std::vector<value_type> m_vStep; ///< step size of each row
+        value_type m_rho; ///< penalty of the augmented Lagrangian
+        value_type m_step_scale; ///< scale of step sizes, reduced if a step does not improve
+
+        int32_t m_num_threads; ///< number of threads in use
+
+        uint32_t m_rank; ///< rank required
+        int32_t m_threads; ///< maximum number of threads
+        uint32_t m_max_iters; ///< maximum number of gradient steps
+        value_type m_tolerance; ///< tolerance of violations
+        uint32_t m_seed; ///< seed of the initial solution
+        uint32_t m_iters; ///< number of gradient steps
+
+        static const uint32_t block_size = 256; ///< number of items pulled by a thread at a time
+        static const uint32_t max_auto_rank = 16; ///< maximum rank chosen automatically
+        static const uint32_t max_inner_iters = 100; ///< maximum gradient steps before updating multipliers
+};
+
+template <typename T>
+LowRankSdp<T>::LowRankSdp(uint32_t n)
+    : m_num_vertices(n)
+    , m_dim(0)
+    , m_rho(1)
+    , m_step_scale(1)
+    , m_num_threads(1)
+    , m_rank(0)
+    , m_threads(1)
+    , m_max_iters(10000)
+    , m_tolerance(1e-3)
+    , m_seed(1)
+    , m_iters(0)
+{
+}
+
+template <typename T>
+void LowRankSdp<T>::add_term(uint32_t s, uint32_t t, typename LowRankSdp<T>::value_type cost)
+{
+    limboAssertMsg(s < m_num_vertices && t < m_num_vertices && s != t, "invalid term (%u, %u)", s, t);
+    term_type term = {s, t, cost, 0, false};
+    m_vTerm.push_back(term);
+}
+
+template <typename T>
+void LowRankSdp<T>::add_term(uint32_t s, uint32_t t, typename LowRankSdp<T>::value_type cost, typename LowRankSdp<T>::value_type lb)
+{
+    limboAssertMsg(s < m_num_vertices && t < m_num_vertices && s != t, "invalid term (%u, %u)", s, t);
+    term_type term = {s, t, cost, lb, true};
+    m_vTerm.push_back(term);
+}
+
+template <typename T>
+typename LowRankSdp<T>::value_type LowRankSdp<T>::operator()()
+{
+    build();
+
+    m_num_threads = std::min((int32_t)limbo::containers::num_threads(), m_threads);
+    // threads are not worth it if there are few blocks
+    m_num_threads = std::max(std::min(m_num_threads, (int32_t)(m_vTerm.size()/(block_size*4))), 1);
+
+    m_rho = 1;
+    m_step_scale = 1;
+    m_vLambda.assign(m_vTerm.size(), 0);
+    compute_steps();
+
+    value_type f = run(TERM_PASS);
+    value_type prev_violation = std::numeric_limits<value_type>::max();
+    uint32_t inner = 0;
+    for (m_iters = 0; m_iters < m_max_iters; ++m_iters)
+    {
+        run(VERTEX_PASS);
+        m_vV.swap(m_vNext);
+        value_type next_f = run(TERM_PASS);
+        // a step too long, which rarely happens as step sizes bound the curvature of each row
+        if (next_f > f)
+        {
+            m_step_scale *= 0.5;
+            compute_steps();
+        }
+        bool converged = (std::abs(f-next_f) <= m_tolerance*m_tolerance*(1+std::abs(next_f)));
+        f = next_f;
+        if (converged || ++inner >= max_inner_iters)
+        {
+            value_type violation = max_violation();
+            if (converged && violation <= m_tolerance)
+                break;
+            for (uint32_t e = 0, ee = m_vTerm.size(); e < ee; ++e)
+                if (m_vTerm[e].bounded)
+                    m_vLambda[e] = std::max((value_type)0, m_vLambda[e]+m_rho*(m_vTerm[e].lb-m_vX[e]));
+            // increase penalty if violations do not drop fast enough
+            if (violation > prev_violation/4)
+            {
+                m_rho *= 2;
+                compute_steps();
+            }
+            prev_violation = violation;
+            inner = 0;
+            f = run(TERM_PASS);
+        }
+    }
+    return objective();
+}
+
+template <typename T>
+typename LowRankSdp<T>::value_type LowRankSdp<T>::objective() const
+{
+    value_type f = 0;
+    for (typename std::vector<term_type>::const_iterator it = m_vTerm.begin(), ite = m_vTerm.end(); it != ite; ++it)
+        f += it->cost*inner(it->s, it->t);
+    return f;
+}
+
+template <typename T>
+typename LowRankSdp<T>::value_type LowRankSdp<T>::max_violation() const
+{
+    value_type violation = 0;
+    for (typename std::vector<term_type>::const_iterator it = m_vTerm.begin(), ite = m_vTerm.end(); it != ite; ++it)
+        if (it->bounded)
+            violation = std::max(violation, it->lb-inner(it->s, it->t));
+    return violation;
+}
+
+template <typename T>
+void LowRankSdp<T>::build()
+{
+    uint32_t num_bounded = 0;
+    m_vAdjBegin.assign(m_num_vertices+1, 0);
+    for (typename std::vector<term_type>::const_iterator it = m_vTerm.begin(), ite = m_vTerm.end(); it != ite; ++it)
+    {
+        ++m_vAdjBegin[it->s+1];
+        ++m_vAdjBegin[it->t+1];
+        num_bounded += it->bounded;
+    }
+    for (uint32_t i = 0; i < m_num_vertices; ++i)
+        m_vAdjBegin[i+1] += m_vAdjBegin[i];
+    m_vAdjTerm.resize(m_vAdjBegin.back());
+    std::vector<uint32_t> vPos (m_vAdjBegin.begin(), m_vAdjBegin.end()-1);
+    for (uint32_t e = 0, ee = m_vTerm.size(); e < ee; ++e)
+    {
+        m_vAdjTerm[vPos[m_vTerm[e].s]++] = e;
+        m_vAdjTerm[vPos[m_vTerm[e].t]++] = e;
+    }
+
+    m_dim = m_rank;
+    if (m_dim == 0)
+        m_dim = std::min((uint32_t)std::ceil(std::sqrt(2.0*(m_num_vertices+num_bounded))), max_auto_rank);
+    m_dim = std::max(std::min(m_dim, m_num_vertices), 1U);
+
+    // random unit rows
+    unsigned int seed = m_seed;
+    m_vV.resize(m_num_vertices*m_dim);
+    for (uint32_t i = 0; i < m_num_vertices; ++i)
+    {
+        value_type* v = &m_vV[i*m_dim];
+        value_type norm = 0;
+        while (norm < 1e-6)
+        {
+            for (uint32_t k = 0; k < m_dim; ++k)
+                v[k] = 2*(value_type)rand_r(&seed)/RAND_MAX-1;
+            norm = std::sqrt(dot(v, v));
+        }
+        for (uint32_t k = 0; k < m_dim; ++k)
+            v[k] /= norm;
+    }
+    m_vNext.resize(m_vV.size());
+    m_vX.resize(m_vTerm.size());
+    m_vWeight.resize(m_vTerm.size());
+    m_vValue.resize(m_vTerm.size());
+}
+
+template <typename T>
+void LowRankSdp<T>::compute_steps()
+{
+    // the augmented Lagrangian is bounded by |c| + rho in curvature for each term
+    m_vStep.assign(m_num_vertices, 0);
+    for (uint32_t i = 0; i < m_num_vertices; ++i)
+    {
+        value_type curvature = 0;
+        for (uint32_t k = m_vAdjBegin[i]; k < m_vAdjBegin[i+1]; ++k)
+        {
+            term_type const& term = m_vTerm[m_vAdjTerm[k]];
+            curvature += std::abs(term.cost)+(term.bounded? m_rho : 0);
+        }
+        if (curvature > 0)
+            m_vStep[i] = m_step_scale/curvature;
+    }
+}
+
+template <typename T>
+typename LowRankSdp<T>::value_type LowRankSdp<T>::run(typename LowRankSdp<T>::PassType pass)
+{
+    BlockKernel kernel = {this, pass};
+    uint32_t size = (pass == TERM_PASS)? m_vTerm.size() : m_num_vertices;
+    limbo::containers::parallel_for(0, size, block_size, m_num_threads, kernel);
+
+    // sum in a fixed order, independent of the schedule
+    value_type f = 0;
+    if (pass == TERM_PASS)
+        for (uint32_t e = 0, ee = m_vValue.size(); e < ee; ++e)
+            f += m_vValue[e];
+    return f;
+}
+
+template <typename T>
+void LowRankSdp<T>::term_block(uint32_t b, uint32_t e)
+{
+    for (; b < e; ++b)
+    {
+        term_type const& term = m_vTerm[b];
+        value_type x = inner(term.s, term.t);
+        m_vX[b] = x;
+        m_vWeight[b] = term.cost;
+        m_vValue[b] = term.cost*x;
+        if (term.bounded)
+        {
+            value_type p = std::max((value_type)0, m_vLambda[b]/m_rho+term.lb-x);
+            m_vWeight[b] -= m_rho*p;
+            m_vValue[b] += m_rho/2*p*p;
+        }
+    }
+}
+
+template <typename T>
+void LowRankSdp<T>::vertex_block(uint32_t b, uint32_t e)
+{
+    std::vector<value_type> vGrad (m_dim);
+    for (; b < e; ++b)
+    {
+        value_type const* v = vector(b);
+        value_type* next = &m_vNext[b*m_dim];
+        std::fill(vGrad.begin(), vGrad.end(), 0);
+        for (uint32_t k = m_vAdjBegin[b]; k < m_vAdjBegin[b+1]; ++k)
+        {
+            uint32_t id = m_vAdjTerm[k];
+            term_type const& term = m_vTerm[id];
+            value_type const* u = vector((term.s == b)? term.t : term.s);
+            value_type w = m_vWeight[id];
+            for (uint32_t d = 0; d < m_dim; ++d)
+                vGrad[d] += w*u[d];
+        }
+        // project the gradient to the tangent space of the sphere
+        value_type radial = dot(&vGrad[0], v);
+        for (uint32_t d = 0; d < m_dim; ++d)
+            next[d] = v[d]-m_vStep[b]*(vGrad[d]-radial*v[d]);
+        value_type norm = std::sqrt(dot(next, next));
+        for (uint32_t d = 0; d < m_dim; ++d)
+            next[d] /= norm;
+    }
+}
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
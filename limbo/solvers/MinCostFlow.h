@@ -14,7 +14,9 @@
 #include <lemon/cycle_canceling.h>
 #include <lemon/lgf_writer.h>
 
+#include <limbo/containers/DisjointSet.h>
 #include <limbo/solvers/Solvers.h>
+#include <limbo/solvers/WarmStartNetworkSimplex.h>
 
 /// namespace for Limbo 
 namespace limbo 
@@ -36,6 +38,8 @@ template <typename T, typename V>
 class NetworkSimplex;
 template <typename T, typename V>
 class CycleCanceling;
+template <typename T, typename V>
+class IncrementalNetworkSimplex;
 
 /// @class limbo::solvers::MinCostFlow
 /// @brief LP solved with min-cost flow. 
@@ -45,15 +49,19 @@ class CycleCanceling;
 ///
 /// 1. Primal problem \n
 /// \f{eqnarray*}{
-/// & min. & \sum_{i, j \in E} c_{ij} \cdot x_{ij}, \\
-/// & s.t. & l_{ij} \le x_{ij} \le u_{ij}, \forall (i, j) \in E,  \\
-/// &     & \sum_{j \in V} x_{ij} = s_i, \forall i \ne t, \in V, \\
+/// & min. & \sum_{i, j \in E} c_{ij} \cdot x_{ij}, \\[0pt]
+/// & s.t. & l_{ij} \le x_{ij} \le u_{ij}, \forall (i, j) \in E,  \\[0pt]
+/// &     & \sum_{j \in V} x_{ij} = s_i, \forall i \ne t, \in V, \\[0pt]
 /// &     & x_{ij} = -x_{ji}, \forall (i, j) \in E. (implicit) 
 /// \f}
 /// \n
 /// Only CapacityScaling algorithm supports real-value costs. 
 /// All other algorithms require integer costs, supply and capacity. 
 /// 
+/// Constraints are only coupled by variables in two of them, 
+/// so the LP separates over the connected components of the graph without the node st. 
+/// With @ref setDecompose, components are solved as independent min-cost flow problems in parallel. 
+/// 
 /// @tparam T coefficient type 
 /// @tparam V variable type 
 template <typename T, typename V>
@@ -98,6 +106,9 @@ class MinCostFlow
               , m_totalFlowCost(std::numeric_limits<typename MinCostFlow<T, V>::value_type>::max())
               , m_mFlow(m_graph)
               , m_mPotential(m_graph)
+              , m_decompose(false)
+              , m_numThreads(0)
+              , m_numSubnetworks(0)
         {
         }
         /// @brief destructor 
@@ -112,6 +123,27 @@ class MinCostFlow
             return solve(solver);
         }
 
+        /// @name decomposition into independent subnetworks 
+        /// Each subnetwork holds one or more connected components and is solved from its own model and graph 
+        /// by a copy of the solver from @ref MinCostFlowSolver::clone; 
+        /// solvers that cannot be copied solve the subnetworks one after another. 
+        /// Small components are grouped, so each subnetwork has at least @ref s_minSubnetworkSize constraints if possible. 
+        /// The graph and maps of this object are not built then, and subnetworks are built again at each solve. 
+        ///@{
+        /// @return true if independent subnetworks are solved separately 
+        bool decompose() const {return m_decompose;}
+        /// @brief solve independent subnetworks separately 
+        /// @param v flag 
+        void setDecompose(bool v) {m_decompose = v;}
+        /// @return maximum number of threads to solve subnetworks, 0 for @ref limbo::containers::num_threads 
+        unsigned int numThreads() const {return m_numThreads;}
+        /// @brief set maximum number of threads to solve subnetworks, capped by @ref limbo::containers::num_threads 
+        /// @param v number of threads, 0 for @ref limbo::containers::num_threads 
+        void setNumThreads(unsigned int v) {m_numThreads = v;}
+        /// @return number of subnetworks of the last solve with decomposition, 1 if the graph is connected 
+        unsigned int numSubnetworks() const {return m_numSubnetworks;}
+        ///@}
+
         /// @return graph 
         graph_type const& graph() const; 
         /// @return arc lower bound map 
@@ -152,10 +184,43 @@ class MinCostFlow
         SolverProperty solve(solver_type* solver);
         /// @brief build min-cost flow graph 
         void buildGraph(); 
+        /// @brief update arc bounds and node supplies of the graph from the model, the graph keeps its shape 
+        void updateGraph(); 
         /// @brief set objective, support incremental set 
         void setObjective(expression_type const& obj); 
         /// @brief apply solutions to model 
         void applySolution(); 
+        /// @brief solve the connected components of the graph as separate min-cost flow problems 
+        /// @param solver an object to solve min cost flow 
+        /// @param status status of the first subnetwork not solved to optimality, or OPTIMAL 
+        /// @return false if there is only one subnetwork, which is solved with the graph of this object instead 
+        bool solveSubnetworks(solver_type* solver, SolverProperty& status); 
+
+        /// @brief shared state of threads solving subnetworks 
+        struct SubnetworkPass 
+        {
+            std::vector<model_type> vModel; ///< model of each subnetwork, larger ones first; by value, as @ref limbo::solvers::LinearModel has no virtual destructor 
+            std::vector<MinCostFlow*> vSubnetwork; ///< subnetworks 
+            std::vector<SolverProperty> vStatus; ///< status of each subnetwork 
+            std::vector<solver_type*> vSolver; ///< solvers, one for each thread, as a solver is not shared while solving 
+            std::vector<unsigned int> vBusy; ///< 1 if the solver of the same index is taken by a thread, set atomically 
+        };
+        /// @brief subnetworks solved by threads with @ref limbo::containers::parallel_for 
+        struct SubnetworkKernel 
+        {
+            SubnetworkPass* pass; ///< shared state 
+            /// @param b first subnetwork 
+            /// @param e end subnetwork 
+            void operator()(std::size_t b, std::size_t e) const {MinCostFlow::solveSubnetworkBlock(*pass, b, e);}
+        };
+        /// @brief solve a block of subnetworks with a solver no other thread is using 
+        /// @param pass shared state 
+        /// @param b first subnetwork 
+        /// @param e end subnetwork 
+        static void solveSubnetworkBlock(SubnetworkPass& pass, std::size_t b, std::size_t e); 
+
+        /// minimum number of constraints of a subnetwork, smaller components are grouped 
+        static const unsigned int s_minSubnetworkSize = 256; 
 
         model_type* m_model; ///< model for the problem 
 
@@ -168,6 +233,10 @@ class MinCostFlow
 
 		arc_flow_map_type m_mFlow; ///< solution of min-cost flow, which is the solution of LP 
 		node_pot_map_type m_mPotential; ///< solution of min-cost flow, which is the dual solution of LP 
+        std::vector<int> m_vConstrSign; ///< sign to scale each constraint into a node of the graph 
+        bool m_decompose; ///< whether independent subnetworks are solved separately 
+        unsigned int m_numThreads; ///< maximum number of threads to solve subnetworks, 0 for all 
+        unsigned int m_numSubnetworks; ///< number of subnetworks of the last solve with decomposition 
 };
 
 template <typename T, typename V>
@@ -261,12 +330,28 @@ SolverProperty MinCostFlow<T, V>::solve(typename MinCostFlow<T, V>::solver_type*
 
     // skip empty problem 
     if (m_model->numVariables() == 0)
+    {
+        if (defaultSolver)
+            delete solver; 
         return OPTIMAL; 
+    }
+
+    // solve independent subnetworks separately 
+    SolverProperty status; 
+    if (m_decompose && solveSubnetworks(solver, status))
+    {
+        if (defaultSolver)
+            delete solver; 
+        return status; 
+    }
 
     // build graph if no nodes, I know in corner cases it may be called repeatedly 
     // but this seems to be the best way 
+    // otherwise update bounds and supplies in place for repeated solves 
     if (m_graph.nodeNum() == 0)
         buildGraph(); 
+    else 
+        updateGraph(); 
     setObjective(m_model->objective());
 #ifdef DEBUG_MINCOSTFLOW
     printGraph(false);
@@ -277,7 +362,7 @@ SolverProperty MinCostFlow<T, V>::solve(typename MinCostFlow<T, V>::solver_type*
     limboAssert(totalSupply == 0);
 #endif
     // solve min-cost flow problem 
-    SolverProperty status = solver->operator()(this); 
+    status = solver->operator()(this); 
     // apply solution 
     applySolution(); 
 
@@ -318,9 +403,11 @@ void MinCostFlow<T, V>::buildGraph()
     // I assume vVar2Constr sorts according to variable id 
     std::vector<std::pair<unsigned int, unsigned int> > vVar2Constr (m_model->numVariables(), std::make_pair(std::numeric_limits<unsigned int>::max(), std::numeric_limits<unsigned int>::max())); 
     unsigned int constrIndex = 0; 
+    m_vConstrSign.assign(numNodes, 1); 
     for (typename std::vector<constraint_type>::const_iterator it = m_model->constraints().begin(), ite = m_model->constraints().end(); it != ite; ++it)
     {
         constraint_type constr = *it; 
+        int sign = 1; 
         // equality constraints 
         //if (constr.sense() == '=')
         {
@@ -336,6 +423,7 @@ void MinCostFlow<T, V>::buildGraph()
                     if (value.first != std::numeric_limits<unsigned int>::max())
                     {
                         constr.scale(-1); 
+                        sign = -1; 
                         break; 
                     }
                     else if (value.second != std::numeric_limits<unsigned int>::max())
@@ -349,6 +437,7 @@ void MinCostFlow<T, V>::buildGraph()
                     if (value.second != std::numeric_limits<unsigned int>::max())
                     {
                         constr.scale(-1); 
+                        sign = -1; 
                         break; 
                     }
                     else if (value.first != std::numeric_limits<unsigned int>::max())
@@ -381,6 +470,7 @@ void MinCostFlow<T, V>::buildGraph()
             }
             // compute supply 
             // since here we know whether this constraint is inversed
+            m_vConstrSign[constrIndex] = sign; 
             m_mSupply[m_graph.nodeFromId(constrIndex)] = constr.rightHandSide(); 
             totalSupply += constr.rightHandSide(); 
             // next cosntraint 
@@ -423,8 +513,32 @@ void MinCostFlow<T, V>::buildGraph()
     // everytime solver is called 
 }
 template <typename T, typename V>
+void MinCostFlow<T, V>::updateGraph() 
+{
+    limboAssertMsg(m_vConstrSign.size() == m_model->constraints().size() && (unsigned int)m_graph.arcNum() == m_model->numVariables(), 
+            "model changed its shape since the graph was built"); 
+    // supplies with the same orientation of constraints as the graph 
+    coefficient_value_type totalSupply = 0; 
+    for (unsigned int i = 0, ie = m_vConstrSign.size(); i < ie; ++i)
+    {
+        coefficient_value_type supply = m_vConstrSign[i]*m_model->constraints()[i].rightHandSide(); 
+        m_mSupply[m_graph.nodeFromId(i)] = supply; 
+        totalSupply += supply; 
+    }
+    m_mSupply[m_graph.nodeFromId(m_vConstrSign.size())] = -totalSupply; 
+    for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
+    {
+        arc_type arc = m_graph.arcFromId(i); 
+        m_mLower[arc] = m_model->variableLowerBound(m_model->variable(i));
+        m_mUpper[arc] = m_model->variableUpperBound(m_model->variable(i));
+    }
+}
+template <typename T, typename V>
 void MinCostFlow<T, V>::setObjective(typename MinCostFlow<T, V>::expression_type const& obj)
 {
+    // variables without terms have zero costs, also after a previous objective 
+    for (graph_type::ArcIt it (m_graph); it != lemon::INVALID; ++it)
+        m_mCost[it] = 0; 
     for (typename std::vector<term_type>::const_iterator it = obj.terms().begin(), ite = obj.terms().end(); it != ite; ++it)
     {
         term_type const& term = *it; 
@@ -449,6 +563,142 @@ void MinCostFlow<T, V>::applySolution()
     for (typename std::vector<value_type>::iterator it = m_model->variableSolutions().begin(), ite = m_model->variableSolutions().end(); it != ite; ++it, ++i)
         *it = m_mFlow[m_graph.arcFromId(i)]; 
 }
+template <typename T, typename V>
+bool MinCostFlow<T, V>::solveSubnetworks(typename MinCostFlow<T, V>::solver_type* solver, SolverProperty& status)
+{
+    typedef limbo::containers::DisjointSet::SubsetHelper<unsigned int, unsigned int> subset_helper_type; 
+    std::vector<constraint_type> const& vConstraint = m_model->constraints(); 
+    unsigned int numVars = m_model->numVariables(); 
+    unsigned int numConstrs = vConstraint.size(); 
+    if (numConstrs == 0)
+        return false; 
+
+    // connected components of constraints, joined by variables in two of them 
+    std::vector<unsigned int> vParent (numConstrs); 
+    std::vector<unsigned int> vRank (numConstrs); 
+    subset_helper_type gp (vParent, vRank); 
+    std::vector<unsigned int> vVar2Constr (numVars, std::numeric_limits<unsigned int>::max()); 
+    for (unsigned int k = 0; k < numConstrs; ++k)
+    {
+        for (typename std::vector<term_type>::const_iterator it = vConstraint[k].expression().terms().begin(), ite = vConstraint[k].expression().terms().end(); it != ite; ++it)
+        {
+            unsigned int& constr = vVar2Constr[it->variable().id()]; 
+            if (constr == std::numeric_limits<unsigned int>::max())
+                constr = k; 
+            else 
+                limbo::containers::DisjointSet::union_set(gp, constr, k); 
+        }
+    }
+    std::vector<unsigned int> vSize (numConstrs, 0); 
+    std::vector<unsigned int> vRoot; 
+    for (unsigned int k = 0; k < numConstrs; ++k)
+    {
+        vParent[k] = limbo::containers::DisjointSet::find_set(gp, k); 
+        if (vSize[vParent[k]]++ == 0)
+            vRoot.push_back(vParent[k]); 
+    }
+
+    // larger components first, small ones are grouped into one subnetwork 
+    std::vector<std::pair<unsigned int, unsigned int> > vOrder (vRoot.size()); 
+    for (unsigned int r = 0; r < vRoot.size(); ++r)
+        vOrder[r] = std::make_pair(numConstrs-vSize[vRoot[r]], vRoot[r]); 
+    std::sort(vOrder.begin(), vOrder.end()); 
+    std::vector<unsigned int> vSubnetworkSize; 
+    for (unsigned int r = 0; r < vOrder.size(); ++r)
+    {
+        if (vSubnetworkSize.empty() || vSubnetworkSize.back() >= s_minSubnetworkSize)
+            vSubnetworkSize.push_back(0); 
+        vSubnetworkSize.back() += numConstrs-vOrder[r].first; 
+        vRank[vOrder[r].second] = vSubnetworkSize.size()-1; // rank of a root is no longer needed 
+    }
+    m_numSubnetworks = vSubnetworkSize.size(); 
+    if (m_numSubnetworks <= 1)
+        return false; 
+
+    // copy variables, objective and constraints to the model of each subnetwork with local indices 
+    SubnetworkPass pass; 
+    pass.vModel.resize(m_numSubnetworks); 
+    pass.vSubnetwork.resize(m_numSubnetworks); 
+    pass.vStatus.assign(m_numSubnetworks, OPTIMAL); 
+    for (unsigned int s = 0; s < m_numSubnetworks; ++s)
+    {
+        pass.vModel[s].reserveConstraints(vSubnetworkSize[s]); 
+        pass.vModel[s].setOptimizeType(m_model->optimizeType()); 
+        pass.vSubnetwork[s] = new MinCostFlow(&pass.vModel[s]); 
+    }
+    // variables in no constraint stay with the first subnetwork 
+    std::vector<variable_type> vLocal (numVars); 
+    for (unsigned int i = 0; i < numVars; ++i)
+    {
+        variable_type var = m_model->variable(i); 
+        unsigned int s = (vVar2Constr[i] == std::numeric_limits<unsigned int>::max())? 0 : vRank[vParent[vVar2Constr[i]]]; 
+        vVar2Constr[i] = s; 
+        vLocal[i] = pass.vModel[s].addVariable(m_model->variableLowerBound(var), m_model->variableUpperBound(var), m_model->variableNumericType(var)); 
+    }
+    std::vector<expression_type> vObjective (m_numSubnetworks); 
+    for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+        vObjective[vVar2Constr[it->variable().id()]] += term_type(vLocal[it->variable().id()], it->coefficient()); 
+    for (unsigned int s = 0; s < m_numSubnetworks; ++s)
+        pass.vModel[s].setObjective(vObjective[s]); 
+    bool added = true; 
+    for (unsigned int k = 0; k < numConstrs; ++k)
+    {
+        expression_type expr; 
+        for (typename std::vector<term_type>::const_iterator it = vConstraint[k].expression().terms().begin(), ite = vConstraint[k].expression().terms().end(); it != ite; ++it)
+            expr += term_type(vLocal[it->variable().id()], it->coefficient()); 
+        // a constraint with one term would become a bound and leave the graph of its subnetwork 
+        added &= pass.vModel[vRank[vParent[k]]].addConstraint(constraint_type(expr, vConstraint[k].rightHandSide(), vConstraint[k].sense())); 
+    }
+
+    if (added)
+    {
+        // each thread takes subnetworks with its own copy of the solver 
+        unsigned int numThreads = (m_numThreads)? m_numThreads : limbo::containers::num_threads(); 
+        numThreads = std::max(std::min(std::min(numThreads, limbo::containers::num_threads()), m_numSubnetworks), 1U); 
+        pass.vSolver.push_back(solver); 
+        for (unsigned int t = 1; t < numThreads; ++t)
+        {
+            solver_type* copy = solver->clone(); 
+            if (copy == NULL) // solver cannot be copied 
+                break; 
+            pass.vSolver.push_back(copy); 
+        }
+        pass.vBusy.assign(pass.vSolver.size(), 0); 
+        SubnetworkKernel kernel; 
+        kernel.pass = &pass; 
+        // no more threads than solvers, so each block finds a free solver 
+        limbo::containers::parallel_for(0, m_numSubnetworks, 1, pass.vSolver.size(), kernel); 
+        for (unsigned int t = 1; t < pass.vSolver.size(); ++t)
+            delete pass.vSolver[t]; 
+
+        // stitch flows and costs 
+        status = OPTIMAL; 
+        m_totalFlowCost = 0; 
+        for (unsigned int s = 0; s < m_numSubnetworks; ++s)
+        {
+            if (status == OPTIMAL)
+                status = pass.vStatus[s]; 
+            m_totalFlowCost += pass.vSubnetwork[s]->totalFlowCost(); 
+        }
+        for (unsigned int i = 0; i < numVars; ++i)
+            m_model->variableSolutions()[i] = pass.vModel[vVar2Constr[i]].variableSolution(vLocal[i]); 
+    }
+    for (unsigned int s = 0; s < pass.vSubnetwork.size(); ++s)
+        delete pass.vSubnetwork[s]; 
+    if (!added)
+        m_numSubnetworks = 1; 
+    return added; 
+}
+template <typename T, typename V>
+void MinCostFlow<T, V>::solveSubnetworkBlock(typename MinCostFlow<T, V>::SubnetworkPass& pass, std::size_t b, std::size_t e)
+{
+    unsigned int t = 0; 
+    while (!__sync_bool_compare_and_swap(&pass.vBusy[t], 0U, 1U))
+        t = (t+1)%pass.vBusy.size(); 
+    for (; b < e; ++b)
+        pass.vStatus[b] = pass.vSubnetwork[b]->solve(pass.vSolver[t]); 
+    __sync_lock_release(&pass.vBusy[t]); 
+}
 
 /// @brief A base class of min-cost flow solver 
 /// @tparam T coefficient type 
@@ -482,6 +732,9 @@ class MinCostFlowSolver
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(primalsolver_type* d) = 0; 
+        /// @return a new solver with the same settings to solve another problem, e.g., a subnetwork in another thread, 
+        /// or NULL if the solver cannot be copied; the caller deletes it 
+        virtual MinCostFlowSolver* clone() const {return NULL;}
     protected:
         /// @brief copy object 
         void copy(MinCostFlowSolver const& /*rhs*/) {} 
@@ -531,6 +784,9 @@ class CapacityScaling : public MinCostFlowSolver<T, V>
             return *this;
         }
 
+        /// @return a copy of the solver 
+        virtual base_type* clone() const {return new CapacityScaling(*this);}
+
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(primalsolver_type* d)
@@ -629,6 +885,9 @@ class CostScaling : public MinCostFlowSolver<T, V>
             return *this;
         }
 
+        /// @return a copy of the solver 
+        virtual base_type* clone() const {return new CostScaling(*this);}
+
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(primalsolver_type* d)
@@ -727,6 +986,9 @@ class NetworkSimplex : public MinCostFlowSolver<T, V>
             return *this;
         }
 
+        /// @return a copy of the solver 
+        virtual base_type* clone() const {return new NetworkSimplex(*this);}
+
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(primalsolver_type* d)
@@ -823,6 +1085,9 @@ class CycleCanceling : public MinCostFlowSolver<T, V>
             return *this;
         }
 
+        /// @return a copy of the solver 
+        virtual base_type* clone() const {return new CycleCanceling(*this);}
+
         /// @brief API to run min-cost flow solver 
         /// @param d dual min-cost flow object 
         virtual SolverProperty operator()(primalsolver_type* d)
@@ -875,6 +1140,119 @@ class CycleCanceling : public MinCostFlowSolver<T, V>
         typename alg_type::Method m_method; ///< method for the algorithm, SIMPLE_CYCLE_CANCELING, MINIMUM_MEAN_CYCLE_CANCELING, CANCEL_AND_TIGHTEN
 };
 
+/// @brief Network simplex algorithm for min-cost flow, warm started from the spanning tree of the previous solve. 
+/// Keep the object across solves of models with the same shape, 
+/// e.g., when only costs or right hand sides change between iterations; 
+/// see @ref limbo::solvers::WarmStartNetworkSimplex. 
+/// @tparam T coefficient type 
+/// @tparam V variable type 
+template <typename T, typename V>
+class IncrementalNetworkSimplex : public MinCostFlowSolver<T, V>
+{
+    public:
+        /// @brief value type 
+        typedef T value_type;
+        /// @brief base type 
+        typedef MinCostFlowSolver<T, V> base_type; 
+        /// @brief primal min-cost flow solver type 
+        typedef typename base_type::primalsolver_type primalsolver_type; 
+        /// @brief algorithm type 
+        typedef WarmStartNetworkSimplex<typename primalsolver_type::graph_type, 
+                value_type> alg_type;
+
+        /// @brief constructor 
+        IncrementalNetworkSimplex()
+            : base_type()
+            , m_alg(NULL)
+        {
+        }
+        /// @brief copy constructor, the spanning tree is not copied 
+        /// @param rhs right hand side 
+        IncrementalNetworkSimplex(IncrementalNetworkSimplex const& rhs)
+            : base_type(rhs)
+            , m_alg(NULL)
+        {
+            copy(rhs);
+        }
+        /// @brief assignment, the spanning tree is not copied 
+        /// @param rhs right hand side 
+        IncrementalNetworkSimplex& operator=(IncrementalNetworkSimplex const& rhs)
+        {
+            if (this != &rhs)
+            {
+                this->base_type::operator=(rhs); 
+                copy(rhs);
+            }
+            return *this;
+        }
+        /// @brief destructor 
+        ~IncrementalNetworkSimplex()
+        {
+            delete m_alg; 
+        }
+
+        /// @return a copy of the solver, the spanning tree is not copied 
+        virtual base_type* clone() const {return new IncrementalNetworkSimplex(*this);}
+
+        /// @brief API to run min-cost flow solver 
+        /// @param d primal min-cost flow object 
+        virtual SolverProperty operator()(primalsolver_type* d)
+        {
+            // 1. keep the algorithm and its spanning tree for the same graph 
+            if (m_alg == NULL || &m_alg->graph() != &d->graph())
+            {
+                delete m_alg; 
+                m_alg = new alg_type (d->graph());
+            }
+
+            // 2. run 
+            typename alg_type::ProblemType status = m_alg->resetParams()
+                .lowerMap(d->lowerMap())
+                .upperMap(d->upperMap())
+                .costMap(d->costMap())
+                .supplyMap(d->supplyMap())
+                .run();
+
+            // 3. check results 
+            SolverProperty solverStatus; 
+            switch (status)
+            {
+                case alg_type::OPTIMAL:
+                    solverStatus = OPTIMAL; 
+                    break;
+                case alg_type::INFEASIBLE:
+                    solverStatus = INFEASIBLE; 
+                    break;
+                case alg_type::UNBOUNDED:
+                    solverStatus = UNBOUNDED; 
+                    break;
+                default:
+                    limboAssertMsg(0, "unknown status");
+            }
+
+            // 4. apply results 
+            // get dual solution of LP, which is the flow of min-cost flow, skip this if not necessary
+            m_alg->flowMap(d->flowMap());
+            // get solution of LP, which is the dual solution of min-cost flow 
+            m_alg->potentialMap(d->potentialMap());
+            // set total cost of min-cost flow 
+            d->setTotalFlowCost(m_alg->totalCost());
+
+            return solverStatus; 
+        }
+        /// @return true if the last solve started from the spanning tree of the previous one 
+        bool warmStarted() const {return m_alg && m_alg->warmStarted();}
+    protected:
+        /// @brief copy object, the algorithm is created again at the next solve 
+        void copy(IncrementalNetworkSimplex const& /*rhs*/)
+        {
+            delete m_alg; 
+            m_alg = NULL; 
+        }
+
+        alg_type* m_alg; ///< algorithm kept across solves 
+};
+
 
 } // namespace solvers 
 } // namespace limbo 
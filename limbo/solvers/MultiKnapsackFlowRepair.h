@@ -0,0 +1,226 @@
+/**
+ * @file   MultiKnapsackFlowRepair.h
+ * @brief  Repair infeasible solutions of @ref limbo::solvers::MultiKnapsackLagRelax with min-cost flow
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_MULTIKNAPSACKFLOWREPAIR_H
+#define LIMBO_SOLVERS_MULTIKNAPSACKFLOWREPAIR_H
+
+#include <limbo/solvers/MultiKnapsackLagRelax.h>
+#include <limbo/solvers/MinCostFlow.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @brief Heuristic to search for feasible solutions by reassigning items of overfilled bins with a transportation problem.
+///
+/// Items selected in overfilled bins are moved at the same time by a min-cost flow,
+/// so an item can leave a bin to make room for another one, which greedy moves of single items cannot see.
+/// Each item is a node with one unit of supply, and each bin reachable by these items is a node whose flow to the sink is
+/// limited by the number of the heaviest items fitting into its room, so the flow respects capacities with weights in any order.
+/// The room of a bin is its slackness plus the weights of the items it may release.
+/// An item may also keep its current bin outside the capacity at a large cost, so the flow always exists.
+/// The solution is applied and the procedure repeats on the bins still overfilled.
+///
+/// Only candidates in at most one capacity constraint are moved.
+/// Costs are rounded to integers for @ref limbo::solvers::NetworkSimplex.
+/// This searcher is kept out of MultiKnapsackLagRelax.h, which does not depend on lemon.
+/// @tparam T coefficient value type
+/// @tparam V variable value type
+template <typename T, typename V>
+class SearchByMinCostFlow : public FeasibleSearcher<T, V>
+{
+    public:
+        /// @brief base type
+        typedef FeasibleSearcher<T, V> base_type;
+        /// @brief model type
+        typedef typename base_type::model_type model_type;
+        /// @brief solver type
+        typedef typename base_type::solver_type solver_type;
+        /// @brief updater type for lagrangian multipliers
+        typedef typename solver_type::updater_type updater_type;
+        /// @brief coefficient value type
+        typedef typename model_type::coefficient_value_type coefficient_value_type;
+        /// @brief variable value type
+        typedef typename model_type::variable_value_type variable_value_type;
+        /// @brief term type
+        typedef typename model_type::term_type term_type;
+        /// @brief model type of the transportation problem
+        typedef LinearModel<long, long> flow_model_type;
+
+        /// @brief constructor
+        /// @param solver problem solver
+        /// @param maxRounds maximum number of transportation problems
+        /// @param costResolution integer cost of the largest cost difference among candidates of an item
+        SearchByMinCostFlow(solver_type* solver, unsigned int maxRounds = 4, long costResolution = 1000)
+            : base_type(solver)
+            , m_maxRounds(maxRounds)
+            , m_costResolution(std::max(costResolution, 1L))
+        {
+        }
+        /// @brief destructor
+        ~SearchByMinCostFlow() {}
+
+        /// @brief API to search for feasible solutions
+        ///
+        /// param updater updater for lagrangian multipliers, not used
+        /// @return @ref limbo::solvers::SolverProperty SUBOPTIMAL if all bins fit, otherwise INFEASIBLE
+        virtual SolverProperty operator()(updater_type* /*updater*/)
+        {
+            this->transposeConstraints(m_vColumnBegin, m_vColumnRow, m_vColumnElement);
+            this->groupVariables(m_vVariable2Group);
+            m_vCost.assign(this->m_model->numVariables(), 0);
+            for (typename std::vector<term_type>::const_iterator it = this->m_model->objective().terms().begin(), ite = this->m_model->objective().terms().end(); it != ite; ++it)
+                m_vCost[it->variable().id()] += it->coefficient();
+
+            for (unsigned int round = 0; round < m_maxRounds; ++round)
+            {
+                this->computeSlackness();
+                if (!transport())
+                    break;
+            }
+            this->computeSlackness();
+            for (unsigned int i = 0, ie = this->m_constrMatrix.numRows; i < ie; ++i)
+                if (this->m_vSlackness[i] < 0)
+                    return INFEASIBLE;
+            return SUBOPTIMAL;
+        }
+    protected:
+        /// @brief build and solve one transportation problem for the items in overfilled bins
+        /// @return true if some item moves
+        bool transport()
+        {
+            unsigned int none = std::numeric_limits<unsigned int>::max();
+            unsigned int numRows = this->m_constrMatrix.numRows;
+            std::vector<variable_value_type>& vSol = this->m_model->variableSolutions();
+
+            // movable items are selected variables in one overfilled bin
+            std::vector<unsigned int> vItem;
+            std::vector<coefficient_value_type> vRoom (this->m_vSlackness, this->m_vSlackness+numRows);
+            for (unsigned int j = 0, je = this->m_model->numVariables(); j < je; ++j)
+            {
+                if (vSol[j] == 0 || m_vVariable2Group[j] == none || m_vColumnBegin[j+1]-m_vColumnBegin[j] != 1)
+                    continue;
+                unsigned int row = m_vColumnRow[m_vColumnBegin[j]];
+                if (this->m_vSlackness[row] < 0 && m_vColumnElement[m_vColumnBegin[j]] > 0)
+                {
+                    vItem.push_back(j);
+                    vRoom[row] += m_vColumnElement[m_vColumnBegin[j]];
+                }
+            }
+            if (vItem.empty())
+                return false;
+
+            // bins reachable by the items, and the heaviest item each bin may receive
+            std::vector<unsigned int> vRow2Node (numRows, none);
+            std::vector<unsigned int> vBin;
+            std::vector<coefficient_value_type> vMaxWeight;
+            coefficient_value_type maxRange = 0;
+            for (unsigned int i = 0; i < vItem.size(); ++i)
+            {
+                unsigned int g = m_vVariable2Group[vItem[i]];
+                coefficient_value_type minCost = std::numeric_limits<coefficient_value_type>::max();
+                coefficient_value_type maxCost = -std::numeric_limits<coefficient_value_type>::max();
+                for (unsigned int v = this->m_vVariableGroupBeginIndex[g]; v < this->m_vVariableGroupBeginIndex[g+1]; ++v)
+                {
+                    unsigned int t = this->m_vGroupedVariable[v].id();
+                    if (m_vColumnBegin[t+1]-m_vColumnBegin[t] > 1)
+                        continue;
+                    minCost = std::min(minCost, m_vCost[t]);
+                    maxCost = std::max(maxCost, m_vCost[t]);
+                    if (m_vColumnBegin[t+1] == m_vColumnBegin[t])
+                        continue;
+                    unsigned int row = m_vColumnRow[m_vColumnBegin[t]];
+                    if (vRow2Node[row] == none)
+                    {
+                        vRow2Node[row] = vBin.size();
+                        vBin.push_back(row);
+                        vMaxWeight.push_back(0);
+                    }
+                    vMaxWeight[vRow2Node[row]] = std::max(vMaxWeight[vRow2Node[row]], m_vColumnElement[m_vColumnBegin[t]]);
+                }
+                maxRange = std::max(maxRange, maxCost-minCost);
+            }
+            coefficient_value_type factor = (maxRange > 0)? m_costResolution/maxRange : 1;
+            long stayCost = m_costResolution*((long)vItem.size()+1);
+
+            // item constraints first, so the flow goes from items to bins
+            flow_model_type flowModel;
+            std::vector<typename flow_model_type::expression_type> vBinExpr (vBin.size());
+            std::vector<std::pair<typename flow_model_type::variable_type, unsigned int> > vArc;
+            typename flow_model_type::expression_type obj;
+            for (unsigned int i = 0; i < vItem.size(); ++i)
+            {
+                unsigned int g = m_vVariable2Group[vItem[i]];
+                coefficient_value_type minCost = std::numeric_limits<coefficient_value_type>::max();
+                for (unsigned int v = this->m_vVariableGroupBeginIndex[g]; v < this->m_vVariableGroupBeginIndex[g+1]; ++v)
+                {
+                    unsigned int t = this->m_vGroupedVariable[v].id();
+                    if (m_vColumnBegin[t+1]-m_vColumnBegin[t] <= 1)
+                        minCost = std::min(minCost, m_vCost[t]);
+                }
+                typename flow_model_type::expression_type itemExpr;
+                for (unsigned int v = this->m_vVariableGroupBeginIndex[g]; v < this->m_vVariableGroupBeginIndex[g+1]; ++v)
+                {
+                    unsigned int t = this->m_vGroupedVariable[v].id();
+                    if (m_vColumnBegin[t+1]-m_vColumnBegin[t] > 1)
+                        continue;
+                    typename flow_model_type::variable_type var = flowModel.addVariable(0, 1, CONTINUOUS);
+                    vArc.push_back(std::make_pair(var, t));
+                    itemExpr += var*1L;
+                    obj += var*(long)std::floor((m_vCost[t]-minCost)*factor+0.5);
+                    // a candidate in no capacity constraint goes to the sink directly
+                    if (m_vColumnBegin[t+1] != m_vColumnBegin[t])
+                        vBinExpr[vRow2Node[m_vColumnRow[m_vColumnBegin[t]]]] += var*(-1L);
+                }
+                // keep the current bin outside the capacity
+                typename flow_model_type::variable_type stay = flowModel.addVariable(0, 1, CONTINUOUS);
+                vArc.push_back(std::make_pair(stay, vItem[i]));
+                itemExpr += stay*1L;
+                obj += stay*stayCost;
+                flowModel.addConstraint(itemExpr == 1L);
+            }
+            for (unsigned int b = 0; b < vBin.size(); ++b)
+            {
+                long capacity = (vRoom[vBin[b]] <= 0)? 0 : (vMaxWeight[b] <= 0)? (long)vItem.size() : std::min((long)std::floor(vRoom[vBin[b]]/vMaxWeight[b]), (long)vItem.size());
+                typename flow_model_type::variable_type var = flowModel.addVariable(0, capacity, CONTINUOUS);
+                vBinExpr[b] += var*1L;
+                flowModel.addConstraint(vBinExpr[b] == 0L);
+            }
+            flowModel.setObjective(obj);
+            flowModel.setOptimizeType(MIN);
+
+            MinCostFlow<long, long> mcf (&flowModel);
+            NetworkSimplex<long, long> alg;
+            if (mcf(&alg) != OPTIMAL)
+                return false;
+
+            // apply the assignment, stay arcs keep the current variables
+            unsigned int numMoves = 0;
+            for (unsigned int i = 0; i < vItem.size(); ++i)
+                vSol[vItem[i]] = 0;
+            for (unsigned int k = 0; k < vArc.size(); ++k)
+                if (flowModel.variableSolution(vArc[k].first) > 0)
+                    vSol[vArc[k].second] = 1;
+            for (unsigned int i = 0; i < vItem.size(); ++i)
+                numMoves += (vSol[vItem[i]] == 0);
+            return numMoves > 0;
+        }
+
+        unsigned int m_maxRounds; ///< maximum number of transportation problems
+        long m_costResolution; ///< integer cost of the largest cost difference among candidates of an item
+        std::vector<unsigned int> m_vColumnBegin; ///< first element of each variable in capacity constraints, with one more entry for the end
+        std::vector<unsigned int> m_vColumnRow; ///< capacity constraint of each element
+        std::vector<coefficient_value_type> m_vColumnElement; ///< coefficient of each element
+        std::vector<unsigned int> m_vVariable2Group; ///< group of each variable
+        std::vector<coefficient_value_type> m_vCost; ///< coefficient of each variable in the objective
+};
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
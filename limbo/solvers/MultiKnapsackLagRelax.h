@@ -8,6 +8,9 @@
 #define LIMBO_SOLVERS_MULTIKNAPSACKLAGRELAX_H
 
 #include <cmath>
+#include <unistd.h>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/Instrument.h>
 #include <limbo/solvers/Solvers.h>
 #include <limbo/solvers/Numerical.h>
 
@@ -23,14 +26,24 @@ template <typename T>
 class LagMultiplierUpdater;
 template <typename T>
 class SubGradientDescent; 
+template <typename T>
+class PolyakStep; 
+template <typename T>
+class DeflectedSubGradient; 
+template <typename T>
+class ProximalBundle; 
 template <typename T, typename V>
 class ProblemScaler; 
 template <typename T, typename V>
 class L2NormScaler; 
 template <typename T, typename V>
+class RuizScaler; 
+template <typename T, typename V>
 class FeasibleSearcher;
 template <typename T, typename V>
 class SearchByAdjustCoefficient;
+template <typename T, typename V>
+class SearchByParallelReassignment;
 
 /// @brief Solve multiple knapsack problem with lagrangian relaxation 
 /// 
@@ -38,9 +51,9 @@ class SearchByAdjustCoefficient;
 /// Use \f$x_{ij}\f$ to denote item \f$i\f$ is assigned to knapsack \f$j\f$. 
 /// The primal problem \f$P\f$ is as follows, \n
 /// \f{eqnarray*}{
-/// & min. & \sum_{i,j} c_{ij} \cdot x_{ij}, \\
-/// & s.t. & \sum_{i} a_i x_{ij} \le b_j, \forall j \in B,  \\
-/// &      & \sum_{j} x_{ij} = 1, \forall i \in C, \\
+/// & min. & \sum_{i,j} c_{ij} \cdot x_{ij}, \\[0pt]
+/// & s.t. & \sum_{i} a_i x_{ij} \le b_j, \forall j \in B,  \\[0pt]
+/// &      & \sum_{j} x_{ij} = 1, \forall i \in C, \\[0pt]
 /// &      & x_{ij} \in \{0, 1\}, \forall i \in C, j \in B.  
 /// \f}
 /// \n
@@ -48,8 +61,8 @@ class SearchByAdjustCoefficient;
 /// The procedure to solve the problem is to iteratively solve following 
 /// lagrangian subproblem \f$L\f$, 
 /// \f{eqnarray*}{
-/// & min. & \sum_{i,j} c_{ij} \cdot x_{ij} + \sum_{j} \lambda_j (\sum_{i} a_i x_{ij} - b_j), \\
-/// & s.t. & \sum_{j} x_{ij} = 1, \forall i \in C, \\
+/// & min. & \sum_{i,j} c_{ij} \cdot x_{ij} + \sum_{j} \lambda_j (\sum_{i} a_i x_{ij} - b_j), \\[0pt]
+/// & s.t. & \sum_{j} x_{ij} = 1, \forall i \in C, \\[0pt]
 /// &      & x_{ij} \in \{0, 1\}, \forall i \in C, j \in B.  
 /// \f}
 /// \n
@@ -60,6 +73,32 @@ class SearchByAdjustCoefficient;
 /// and stop once we observe no significant improvement. 
 /// The rest violations are solved by heuristic approaches. 
 /// 
+/// The argmin of groups, the slackness \f$b-Ax\f$ and the objective of the subproblem 
+/// are computed by threads in blocks. Rows and groups are independent 
+/// and partial sums of the objective are added in the order of blocks, 
+/// so the solution does not depend on the number of threads. 
+/// The lagrangian objective is summed by the argmin kernel from the minimum costs of groups, 
+/// which saves a pass over all variables in each iteration. 
+/// Threads are started once for the iterations of a solve and kept in a @ref limbo::solvers::NumericalTeam, 
+/// so the kernels of the solver and the vector updates of the multipliers do not create threads in each iteration. 
+/// 
+/// Usually only a few items change bins between iterations. 
+/// In the incremental mode, the selected variable of each group is tracked 
+/// and only the rows of the old and new bins of changed items are updated in \f$b-Ax\f$. 
+/// The slackness is recomputed from scratch periodically and before a solution is accepted, 
+/// so rounding errors do not accumulate. 
+/// 
+/// With warm start, the solver keeps the constraint matrix, variable groups and multipliers 
+/// after solving, so that the problem can be solved again with different objective coefficients. 
+/// The next solve skips preparation and starts from the multipliers of the previous best feasible solution, 
+/// which also stays a candidate solution as the constraints are the same. 
+/// Variables and constraints must not change between the calls. 
+/// 
+/// Besides @ref limbo::solvers::SubGradientDescent, the multipliers can be updated by 
+/// @ref limbo::solvers::PolyakStep, @ref limbo::solvers::DeflectedSubGradient or @ref limbo::solvers::ProximalBundle, 
+/// which use the objective of the subproblem. 
+/// The bound, the best objective and the violation of each iteration are kept in @ref convergenceHistory. 
+/// 
 /// @tparam T coefficient type 
 /// @tparam V variable type 
 template <typename T, typename V>
@@ -76,6 +115,7 @@ class MultiKnapsackLagRelax
         typedef typename model_type::expression_type expression_type; 
         typedef typename model_type::term_type term_type; 
         typedef typename model_type::property_type property_type;
+        typedef typename NumericalAccumulator<coefficient_value_type>::type accumulator_type; 
         typedef MatrixCSR<coefficient_value_type, int, 1> matrix_type; 
         typedef LagMultiplierUpdater<coefficient_value_type> updater_type; 
         typedef ProblemScaler<coefficient_value_type, variable_value_type> scaler_type; 
@@ -108,11 +148,17 @@ class MultiKnapsackLagRelax
             m_objConstant = 0; 
             m_lagObj = 0; 
             m_lagObjFlag = false; 
+            m_lagObjEval = false; 
 
             m_iter = 0; 
             m_maxIters = 1000; 
             m_bestObj = std::numeric_limits<coefficient_value_type>::max();
             m_useInitialSol = false; 
+
+            m_maxThreads = 1; 
+            m_numThreads = 1; 
+            m_incremental = false; 
+            m_warmStart = false; 
         }
         /// @brief copy constructor 
         /// @param rhs right hand side 
@@ -158,6 +204,36 @@ class MultiKnapsackLagRelax
         bool lagObjFlag() const; 
         /// @brief set evaluating objective of lagrangian subproblem in each iteration 
         void setLagObjFlag(bool f); 
+        /// @return maximum number of threads 
+        unsigned int numThreads() const; 
+        /// @brief set maximum number of threads, limited by the number of cores 
+        /// @param t number of threads 
+        void setNumThreads(unsigned int t); 
+        /// @return flag of whether update slackness incrementally 
+        bool incremental() const; 
+        /// @brief set whether update slackness incrementally with the items changing bins 
+        /// @param f flag 
+        void setIncremental(bool f); 
+        /// @return flag of whether warm start from the previous solve 
+        bool warmStart() const; 
+        /// @brief set whether warm start from the prepared data and multipliers of the previous solve. 
+        /// Only objective coefficients of the model may change between the calls. 
+        /// @param f flag 
+        void setWarmStart(bool f); 
+
+        /// @brief metrics of an iteration to compare the convergence of updaters, 
+        /// objectives and slackness are in the units of the original problem 
+        struct ConvergenceRecord
+        {
+            unsigned int iter; ///< iteration 
+            coefficient_value_type lagObj; ///< objective of the lagrangian subproblem, a lower bound of the problem, NaN if not evaluated 
+            coefficient_value_type bestObj; ///< best objective of feasible solutions so far, maximum value if none 
+            unsigned int numNegativeSlacks; ///< number of capacity constraints with negative slackness 
+            coefficient_value_type violation; ///< total negative slackness 
+        };
+        /// @return metrics of iterations in the last solve, 
+        /// the objective of the lagrangian subproblem is only recorded when evaluated by @ref setLagObjFlag or the updater 
+        std::vector<ConvergenceRecord> const& convergenceHistory() const; 
 
         /// @brief get number of constraints with negative slackness in current iteration 
         /// @param evaluateFlag if true, recompute slackness for each constraint 
@@ -248,6 +324,26 @@ class MultiKnapsackLagRelax
         };
 
     protected:
+        /// @brief kernels computed by threads in blocks 
+        enum KernelType
+        {
+            LAG_KERNEL, ///< argmin of variable groups 
+            SLACKNESS_KERNEL, ///< rows of \f$b-Ax\f$
+            OBJECTIVE_KERNEL ///< partial sums of the lagrangian objective 
+        };
+        /// @brief state of a kernel shared by threads 
+        struct KernelPass
+        {
+            MultiKnapsackLagRelax const* solver; ///< solver 
+            KernelType kernel; ///< kernel to run 
+            unsigned int size; ///< number of items 
+            unsigned int blockSize; ///< number of items pulled by a thread at a time 
+            accumulator_type* vPartialSum; ///< partial sum of each block for reductions 
+
+            /// @brief run the kernel on items [b, e) 
+            void operator()(unsigned int b, unsigned int e) const {solver->runBlock(*this, b, e);}
+        };
+
         /// @brief copy object 
         void copy(MultiKnapsackLagRelax const& rhs);
         /// @brief destroy model 
@@ -267,6 +363,12 @@ class MultiKnapsackLagRelax
         void scale(scaler_type* scaler); 
         /// @brief recover problem from scaling 
         void unscale(); 
+        /// @brief scale problem with the scaling factors of constraints from the previous solve 
+        /// and scale multipliers to the new scaling factor of objective 
+        /// @param scaler an object to scale objective 
+        void rescale(scaler_type* scaler); 
+        /// @brief reset weights of variables in objective with current multipliers for a warm start 
+        void reprepare(); 
         /// @brief prepare weights of variables in objective 
         /// and classify constraints by marking capacity constraints and single item constraints 
         void prepare();
@@ -275,10 +377,17 @@ class MultiKnapsackLagRelax
         void updateLagMultipliers(updater_type* updater); 
         /// @brief solve lagrangian subproblem 
         void solveLag(); 
+        /// @brief solve lagrangian subproblem and update slackness for the groups changing selections 
+        void solveLagIncremental(); 
+        /// @brief find the variable with minimum cost in each group to m_vNewSelectedVariable, 
+        /// set it in the solution if selections are unknown, and evaluate the objective of the lagrangian subproblem if needed 
+        void runLagKernel(); 
         /// @brief compute slackness in an iteration 
         void computeSlackness(); 
         /// @brief evaluate objective of the lagrangian subproblem 
         coefficient_value_type evaluateLagObjective() const;
+        /// @brief record metrics of current iteration 
+        void record(); 
         /// @brief check convergence of current solution 
         /// @return @ref limbo::solvers::SolverProperty OPTIMAL if converged; @ref limbo::solvers::SolverProperty  SUBOPTIMAL if a feasible solution found 
         SolverProperty converge(); 
@@ -297,6 +406,27 @@ class MultiKnapsackLagRelax
         /// @param y output vector 
         template <typename TT, typename VV>
         void bMinusAx(matrix_type const& A, VV const* x, TT const* b, TT* y) const; 
+        /// @brief run a kernel with threads 
+        /// @param pass state of the kernel 
+        void runKernel(KernelPass& pass) const; 
+        /// @brief run a kernel on a block of items 
+        /// @param pass state of the kernel 
+        /// @param b first item 
+        /// @param e end item 
+        void runBlock(KernelPass const& pass, unsigned int b, unsigned int e) const; 
+        /// @brief set the variable with minimum cost in groups [b, e) 
+        /// @param b first group 
+        /// @param e end group 
+        /// @return sum of the minimum costs, i.e., objective of the lagrangian subproblem for groups [b, e) without the constant 
+        accumulator_type lagBlock(unsigned int b, unsigned int e) const; 
+        /// @brief compute rows [b, e) of \f$b-Ax\f$
+        /// @param b first row 
+        /// @param e end row 
+        void slacknessBlock(unsigned int b, unsigned int e) const; 
+        /// @param b first variable 
+        /// @param e end variable 
+        /// @return objective of the lagrangian subproblem for variables [b, e) 
+        accumulator_type objectiveBlock(unsigned int b, unsigned int e) const; 
 
         model_type* m_model; ///< model for the problem 
 
@@ -316,12 +446,24 @@ class MultiKnapsackLagRelax
         coefficient_value_type m_objConstant; ///< constant value in objective from lagrangian relaxation
         coefficient_value_type m_lagObj; ///< current objective of the lagrangian subproblem 
         bool m_lagObjFlag; ///< whether evaluate objective of the lagrangian subproblem in each iteration 
+        bool m_lagObjEval; ///< whether evaluate objective of the lagrangian subproblem in current solve, set by @ref m_lagObjFlag or the updater 
+        std::vector<ConvergenceRecord> m_vConvergence; ///< metrics of iterations in current solve 
 
         unsigned int m_iter; ///< current iteration 
         unsigned int m_maxIters; ///< maximum number of iterations 
         bool m_useInitialSol; ///< whether use initial solutions or not 
+        unsigned int m_maxThreads; ///< maximum number of threads 
+        unsigned int m_numThreads; ///< number of threads in use, limited by the number of cores 
+        bool m_incremental; ///< whether update slackness incrementally 
+        bool m_warmStart; ///< whether warm start from the previous solve 
+        matrix_type m_constrMatrixT; ///< transpose of constraint matrix \f$A^T\f$, only for the incremental mode 
+        std::vector<unsigned int> m_vSelectedVariable; ///< selected variable of each group, empty if unknown, only for the incremental mode 
+        mutable std::vector<unsigned int> m_vNewSelectedVariable; ///< new selected variable of each group, temporary storage written by kernels 
+
+        static const unsigned int s_slacknessRefreshIters = 64; ///< number of iterations to recompute slackness from scratch in the incremental mode 
 
         std::vector<variable_value_type> m_vBestVariableSol; ///< best feasible solution found so far 
+        std::vector<coefficient_value_type> m_vBestLagMultiplier; ///< multipliers of the best feasible solution, only for warm start 
         coefficient_value_type m_bestObj; ///< best objective found so far 
 
     private:
@@ -359,6 +501,41 @@ void MultiKnapsackLagRelax<T, V>::setLagObjFlag(bool f)
     m_lagObjFlag = f; 
 }
 template <typename T, typename V>
+unsigned int MultiKnapsackLagRelax<T, V>::numThreads() const
+{
+    return m_maxThreads;
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::setNumThreads(unsigned int t)
+{
+    m_maxThreads = std::max(t, 1U); 
+}
+template <typename T, typename V>
+bool MultiKnapsackLagRelax<T, V>::incremental() const
+{
+    return m_incremental;
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::setIncremental(bool f)
+{
+    m_incremental = f; 
+}
+template <typename T, typename V>
+bool MultiKnapsackLagRelax<T, V>::warmStart() const
+{
+    return m_warmStart;
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::setWarmStart(bool f)
+{
+    m_warmStart = f; 
+}
+template <typename T, typename V>
+std::vector<typename MultiKnapsackLagRelax<T, V>::ConvergenceRecord> const& MultiKnapsackLagRelax<T, V>::convergenceHistory() const
+{
+    return m_vConvergence; 
+}
+template <typename T, typename V>
 unsigned int MultiKnapsackLagRelax<T, V>::numNegativeSlackConstraints(bool evaluateFlag) 
 {
     unsigned int result = 0; 
@@ -411,12 +588,22 @@ void MultiKnapsackLagRelax<T, V>::copy(MultiKnapsackLagRelax<T, V> const& rhs)
     m_objConstant = rhs.m_objConstant; 
     m_lagObj = rhs.m_lagObj; 
     m_lagObjFlag = rhs.m_lagObjFlag;
+    m_lagObjEval = rhs.m_lagObjEval; 
+    m_vConvergence = rhs.m_vConvergence; 
     m_iter = rhs.m_iter; 
     m_maxIters = rhs.m_maxIters;
     m_useInitialSol = rhs.m_useInitialSol; 
+    m_maxThreads = rhs.m_maxThreads; 
+    m_numThreads = rhs.m_numThreads; 
+    m_incremental = rhs.m_incremental; 
+    m_warmStart = rhs.m_warmStart; 
+    m_constrMatrixT = rhs.m_constrMatrixT; 
+    m_vSelectedVariable = rhs.m_vSelectedVariable; 
+    m_vNewSelectedVariable = rhs.m_vNewSelectedVariable; 
 
     m_vBestVariableSol = rhs.m_vBestVariableSol;
     m_bestObj = rhs.m_bestObj;
+    m_vBestLagMultiplier = rhs.m_vBestLagMultiplier; 
 }
 template <typename T, typename V>
 void MultiKnapsackLagRelax<T, V>::destroy() 
@@ -450,10 +637,15 @@ void MultiKnapsackLagRelax<T, V>::destroy()
         m_vNewLagMultiplier = NULL;
         m_vSlackness = NULL;
     }
+    // recycle incremental data 
+    m_constrMatrixT.reset(); 
+    m_vSelectedVariable.clear(); 
+    m_vNewSelectedVariable.clear(); 
 }
 template <typename T, typename V>
 SolverProperty MultiKnapsackLagRelax<T, V>::solve(typename MultiKnapsackLagRelax<T, V>::updater_type* updater, typename MultiKnapsackLagRelax<T, V>::scaler_type* scaler, typename MultiKnapsackLagRelax<T, V>::searcher_type* searcher)
 {
+    limboScopedTimer("MultiKnapsackLagRelax::solve"); 
     bool defaultUpdater = false; 
     bool defaultScaler = false; 
     bool defaultSearcher = false; 
@@ -476,13 +668,30 @@ SolverProperty MultiKnapsackLagRelax<T, V>::solve(typename MultiKnapsackLagRelax
         defaultSearcher = true; 
     }
 
-    // recycle old model 
-    destroy(); 
+    // objectives of the lagrangian subproblem are needed by the flag or the updater 
+    m_lagObjEval = m_lagObjFlag || updater->needObjective(); 
+    m_vConvergence.clear(); 
 
-    // scale problem 
-    scale(scaler); 
-    // prepare data structure 
-    prepare(); 
+    // threads beyond the number of cores only add overhead 
+    m_numThreads = std::min(limbo::containers::num_threads(), m_maxThreads); 
+
+    // reuse data of the previous solve if the model has the same structure 
+    if (m_warmStart && m_vGroupedVariable 
+            && m_model->numVariables() == (unsigned int)m_constrMatrix.numColumns 
+            && m_model->constraints().size() == m_vConstraintPartition.size())
+    {
+        rescale(scaler); 
+        reprepare(); 
+    }
+    else 
+    {
+        // recycle old model 
+        destroy(); 
+        // scale problem 
+        scale(scaler); 
+        // prepare data structure 
+        prepare(); 
+    }
 
     // solve lagrangian subproblem 
     SolverProperty status = solveSubproblems(updater, 0, m_maxIters); 
@@ -508,13 +717,26 @@ SolverProperty MultiKnapsackLagRelax<T, V>::solve(typename MultiKnapsackLagRelax
 template <typename T, typename V>
 SolverProperty MultiKnapsackLagRelax<T, V>::solveSubproblems(typename MultiKnapsackLagRelax<T, V>::updater_type* updater, unsigned int beginIter, unsigned int endIter)
 {
+    limboScopedTimer("subproblems"); 
+    // threads of all kernels in the iterations, started once 
+    NumericalTeam team (m_numThreads); 
+    NumericalTeam::Scope scope (&team); 
     // solve lagrangian subproblem 
     SolverProperty status = INFEASIBLE; 
+    // solutions may be changed by searchers, so selections are unknown 
+    m_vSelectedVariable.clear(); 
     for (m_iter = beginIter; m_iter < endIter; ++m_iter)
     {
-        if (!useInitialSolutions() || m_iter != 0)
-            solveLag(); 
-        computeSlackness();
+        limboCounterAdd("MultiKnapsackLagRelax::iterations", 1); 
+        bool incrementalFlag = m_incremental && !m_vSelectedVariable.empty() && (m_iter-beginIter)%s_slacknessRefreshIters != 0; 
+        if (incrementalFlag)
+            solveLagIncremental(); 
+        else 
+        {
+            if (!useInitialSolutions() || m_iter != 0)
+                solveLag(); 
+            computeSlackness();
+        }
 #ifdef DEBUG_MULTIKNAPSACKLAGRELAX
         limboPrint(kDEBUG, "iteration %u with %u negative slacks, %g lagrangian objective, %g objective\n", m_iter, numNegativeSlackConstraints(false), evaluateLagObjective(), m_model->evaluateObjective());
         char buf[64];
@@ -524,7 +746,15 @@ SolverProperty MultiKnapsackLagRelax<T, V>::solveSubproblems(typename MultiKnaps
         printLagMultiplier(out);
         out.close();
 #endif
-        if ((status = converge()) == OPTIMAL || m_iter+1 == endIter)
+        status = converge(); 
+        // confirm a solution with exact slackness 
+        if (incrementalFlag && status != INFEASIBLE)
+        {
+            computeSlackness(); 
+            status = converge(); 
+        }
+        record(); 
+        if (status == OPTIMAL || m_iter+1 == endIter)
             break; 
 
         updateLagMultipliers(updater);
@@ -535,28 +765,60 @@ SolverProperty MultiKnapsackLagRelax<T, V>::solveSubproblems(typename MultiKnaps
 template <typename T, typename V>
 void MultiKnapsackLagRelax<T, V>::scale(typename MultiKnapsackLagRelax<T, V>::scaler_type* scaler)
 {
-    // compute scaling factors and perform scale 
-    m_vScalingFactor.resize(m_model->constraints().size()+1);
-    // constraints 
-    for (unsigned int i = 0, ie = m_model->constraints().size(); i < ie; ++i)
-    {
-        m_vScalingFactor[i] = scaler->operator()(m_model->constraints()[i]); 
-        m_model->scaleConstraint(i, 1.0/m_vScalingFactor[i]);
-    }
-    // objective 
-    m_vScalingFactor.back() = scaler->operator()(m_model->objective()); 
+    limboScopedTimer("scale"); 
+    // compute scaling factors of constraints and objective, and perform scale 
+    scaler->computeScalingFactors(*m_model, m_vScalingFactor, m_numThreads); 
+    m_model->scaleConstraints(m_vScalingFactor, true, m_numThreads); 
     m_model->scaleObjective(1.0/m_vScalingFactor.back());
 }
 template <typename T, typename V>
 void MultiKnapsackLagRelax<T, V>::unscale()
 {
+    limboScopedTimer("unscale"); 
     // constraints 
-    for (unsigned int i = 0, ie = m_model->constraints().size(); i < ie; ++i)
-        m_model->scaleConstraint(i, m_vScalingFactor[i]);
+    m_model->scaleConstraints(m_vScalingFactor, false, m_numThreads); 
     // objective 
     m_model->scaleObjective(m_vScalingFactor.back());
 }
 template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::rescale(typename MultiKnapsackLagRelax<T, V>::scaler_type* scaler)
+{
+    // constraints do not change, so do their scaling factors 
+    m_model->scaleConstraints(m_vScalingFactor, true, m_numThreads);
+    // objective 
+    coefficient_value_type prevScalingFactor = m_vScalingFactor.back(); 
+    m_vScalingFactor.back() = scaler->operator()(m_model->objective()); 
+    m_model->scaleObjective(1.0/m_vScalingFactor.back());
+    // start from the multipliers of the best feasible solution, 
+    // the last ones oscillate around the boundary of feasibility 
+    if (!m_vBestLagMultiplier.empty())
+        std::copy(m_vBestLagMultiplier.begin(), m_vBestLagMultiplier.end(), m_vLagMultiplier); 
+    // multipliers are in the unit of scaled objective 
+    for (typename matrix_type::index_type i = 0; i < m_constrMatrix.numRows; ++i)
+        m_vLagMultiplier[i] *= prevScalingFactor/m_vScalingFactor.back(); 
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::reprepare()
+{
+    // c = c^{0} + A^T \lambda
+    std::fill(m_vObjCoef, m_vObjCoef+m_model->numVariables(), 0);
+    for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+        m_vObjCoef[it->variable().id()] += it->coefficient();
+    ATxPlusy((coefficient_value_type)1, m_constrMatrix, m_vLagMultiplier, m_vObjCoef, m_numThreads); 
+    m_objConstant = (m_lagObjEval)? -dot(m_constrMatrix.numRows, m_vConstrRhs, m_vLagMultiplier, m_numThreads) : 0;
+
+    // constraints do not change, so the best solution of the previous solve is still feasible, 
+    // only its objective is evaluated with new costs 
+    m_bestObj = std::numeric_limits<coefficient_value_type>::max();
+    if (!m_vBestVariableSol.empty())
+    {
+        m_bestObj = 0; 
+        for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+            m_bestObj += it->coefficient()*m_vBestVariableSol[it->variable().id()];
+    }
+    m_vBestLagMultiplier.clear(); 
+}
+template <typename T, typename V>
 void MultiKnapsackLagRelax<T, V>::prepare() 
 {
     // initialize weights of variables in objective 
@@ -585,6 +847,7 @@ void MultiKnapsackLagRelax<T, V>::prepare()
     unsigned int numCapacityConstraints = std::distance(m_vConstraintPartition.begin(), bound);
     m_vLagMultiplier = new coefficient_value_type [numCapacityConstraints]; 
     std::fill(m_vLagMultiplier, m_vLagMultiplier+numCapacityConstraints, 0);
+    m_objConstant = 0; 
     m_vNewLagMultiplier = new coefficient_value_type [numCapacityConstraints];
     std::fill(m_vNewLagMultiplier, m_vNewLagMultiplier+numCapacityConstraints, 0);
     m_vSlackness = new coefficient_value_type [numCapacityConstraints]; 
@@ -598,7 +861,7 @@ void MultiKnapsackLagRelax<T, V>::prepare()
     m_constrMatrix.numRows = numCapacityConstraints; 
     m_constrMatrix.numColumns = m_model->numVariables(); 
     m_constrMatrix.numElements = 0; 
-    m_constrMatrix.vRowBeginIndex = new typename matrix_type::index_type [m_constrMatrix.numRows+1]; 
+    m_constrMatrix.vRowBeginIndex = limbo::containers::large_new_array<typename matrix_type::index_type>(m_constrMatrix.numRows+1); 
     m_constrMatrix.vRowBeginIndex[0] = matrix_type::s_startingIndex;
 
     // initialize vRowBeginIndex 
@@ -615,8 +878,8 @@ void MultiKnapsackLagRelax<T, V>::prepare()
     m_constrMatrix.numElements = m_constrMatrix.vRowBeginIndex[m_constrMatrix.numRows]-matrix_type::s_startingIndex; 
 
     // initialize vElement and vColumn 
-    m_constrMatrix.vElement = new coefficient_value_type [m_constrMatrix.numElements]; 
-    m_constrMatrix.vColumn = new typename matrix_type::index_type [m_constrMatrix.numElements];
+    m_constrMatrix.vElement = limbo::containers::large_new_array<coefficient_value_type>(m_constrMatrix.numElements); 
+    m_constrMatrix.vColumn = limbo::containers::large_new_array<typename matrix_type::index_type>(m_constrMatrix.numElements);
     i = 0; 
     for (std::vector<unsigned int>::iterator it = m_vConstraintPartition.begin(); it != bound; ++it)
     {
@@ -639,6 +902,31 @@ void MultiKnapsackLagRelax<T, V>::prepare()
         m_vConstrRhs[i] = constr.rightHandSide();
     }
 
+    // transpose of constraint matrix to find the rows of a variable 
+    if (m_incremental)
+    {
+        m_constrMatrixT.initialize(m_constrMatrix.numColumns, m_constrMatrix.numRows, m_constrMatrix.numElements); 
+        std::fill(m_constrMatrixT.vRowBeginIndex, m_constrMatrixT.vRowBeginIndex+m_constrMatrixT.numRows+1, 0); 
+        for (typename matrix_type::index_type k = 0; k < m_constrMatrix.numElements; ++k)
+            ++m_constrMatrixT.vRowBeginIndex[m_constrMatrix.vColumn[k]-matrix_type::s_startingIndex+1]; 
+        for (typename matrix_type::index_type j = 0; j < m_constrMatrixT.numRows; ++j)
+            m_constrMatrixT.vRowBeginIndex[j+1] += m_constrMatrixT.vRowBeginIndex[j]; 
+        // use vRowBeginIndex as positions to fill, then shift it back 
+        for (typename matrix_type::index_type r = 0; r < m_constrMatrix.numRows; ++r)
+        {
+            for (typename matrix_type::index_type k = m_constrMatrix.vRowBeginIndex[r]-matrix_type::s_startingIndex; k < m_constrMatrix.vRowBeginIndex[r+1]-matrix_type::s_startingIndex; ++k)
+            {
+                typename matrix_type::index_type& pos = m_constrMatrixT.vRowBeginIndex[m_constrMatrix.vColumn[k]-matrix_type::s_startingIndex]; 
+                m_constrMatrixT.vElement[pos] = m_constrMatrix.vElement[k]; 
+                m_constrMatrixT.vColumn[pos] = r+matrix_type::s_startingIndex; 
+                ++pos; 
+            }
+        }
+        for (typename matrix_type::index_type j = m_constrMatrixT.numRows; j > 0; --j)
+            m_constrMatrixT.vRowBeginIndex[j] = m_constrMatrixT.vRowBeginIndex[j-1]+matrix_type::s_startingIndex; 
+        m_constrMatrixT.vRowBeginIndex[0] = matrix_type::s_startingIndex; 
+    }
+
     // group variables according items 
     // the variables for one item will be grouped 
     // I assume the rest constraints are all single item constraints 
@@ -668,10 +956,14 @@ void MultiKnapsackLagRelax<T, V>::prepare()
             m_vGroupedVariable[j] = itt->variable(); 
         }
     }
+    if (m_incremental)
+        m_vNewSelectedVariable.resize(m_numGroups); 
 }
 template <typename T, typename V>
 void MultiKnapsackLagRelax<T, V>::updateLagMultipliers(typename MultiKnapsackLagRelax<T, V>::updater_type* updater)
 {
+    if (updater->needObjective())
+        updater->setObjective(m_lagObj, m_bestObj); 
 #if 1
     // update lagrangian multiplier 
     // \lambda^{k+1} = \lambda^{k} + t_k (Ax-b) 
@@ -681,9 +973,13 @@ void MultiKnapsackLagRelax<T, V>::updateLagMultipliers(typename MultiKnapsackLag
     // update objective coefficients
     // c^{k+1, T} = c^{0, T} + \lambda^{k+1, T} (Ax-b) = c^{0, T} + \lambda^{k+1, T} A - \lambda^{k+1, T} b
     // c^{k+1} = c^{0} + A^T \lambda^{k+1} - b^T \lambda^{k+1} = c^{k} + A^T \Delta \lambda^{k+1} - b^T \lambda^{k+1}
-    axpy(m_constrMatrix.numRows, (coefficient_value_type)-1, m_vLagMultiplier, m_vNewLagMultiplier); // m_vNewLagMultiplier becomes delta multipliers 
-    ATxPlusy((coefficient_value_type)1, m_constrMatrix, m_vNewLagMultiplier, m_vObjCoef); 
-    axpy(m_constrMatrix.numRows, (coefficient_value_type)1, m_vNewLagMultiplier, m_vLagMultiplier); // update delta multipliers of m_vNewLagMultiplier to m_vLagMultiplier
+    axpy(m_constrMatrix.numRows, (coefficient_value_type)-1, m_vLagMultiplier, m_vNewLagMultiplier, m_numThreads); // m_vNewLagMultiplier becomes delta multipliers 
+    // the transpose built for the incremental mode gives a row-wise product without scattering 
+    if (m_constrMatrixT.vElement)
+        AxPlusy((coefficient_value_type)1, m_constrMatrixT, m_vNewLagMultiplier, m_vObjCoef, m_numThreads); 
+    else 
+        ATxPlusy((coefficient_value_type)1, m_constrMatrix, m_vNewLagMultiplier, m_vObjCoef, m_numThreads); 
+    axpy(m_constrMatrix.numRows, (coefficient_value_type)1, m_vNewLagMultiplier, m_vLagMultiplier, m_numThreads); // update delta multipliers of m_vNewLagMultiplier to m_vLagMultiplier
 #else 
     updater->operator()(m_iter, m_constrMatrix.numRows, m_vSlackness, m_vLagMultiplier, m_vLagMultiplier); 
 
@@ -693,53 +989,191 @@ void MultiKnapsackLagRelax<T, V>::updateLagMultipliers(typename MultiKnapsackLag
     ATxPlusy((coefficient_value_type)1, m_constrMatrix, m_vLagMultiplier, m_vObjCoef); 
 #endif
 
-    if (m_lagObjFlag)
+    if (m_lagObjEval)
     {
-        m_objConstant = -dot(m_constrMatrix.numRows, m_vConstrRhs, m_vLagMultiplier);
+        m_objConstant = -dot(m_constrMatrix.numRows, m_vConstrRhs, m_vLagMultiplier, m_numThreads);
     }
 }
 template <typename T, typename V>
 void MultiKnapsackLagRelax<T, V>::solveLag()
 {
-    // for each item 
-    CompareVariableByCoefficient helper (m_vObjCoef);
+    // reset variables 
     variable_value_type* vVariableSol = &m_model->variableSolutions()[0];
-    unsigned int i = 0; 
-    variable_type const* variableGroupBegin = m_vGroupedVariable; 
-    variable_type const* variableGroupEnd = m_vGroupedVariable; 
-    variable_type const* variable; 
-
-    // reset variables in this group 
     std::fill(vVariableSol, vVariableSol+m_model->numVariables(), 0);
-    for (i = 0; i < m_numGroups; ++i)
+    m_vSelectedVariable.clear(); 
+    runLagKernel(); 
+    if (m_incremental)
+        m_vSelectedVariable = m_vNewSelectedVariable; 
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::solveLagIncremental()
+{
+    runLagKernel(); 
+
+    // move items changing bins and update the slackness of old and new bins 
+    variable_value_type* vVariableSol = &m_model->variableSolutions()[0];
+    for (unsigned int i = 0; i < m_numGroups; ++i)
     {
-        variableGroupBegin = variableGroupEnd;
-        variableGroupEnd = m_vGroupedVariable+m_vVariableGroupBeginIndex[i+1];
-        // find the bin with minimum cost for each item 
-        variable = std::min_element(variableGroupBegin, variableGroupEnd, helper);
-        vVariableSol[variable->id()] = 1; 
+        unsigned int oldVar = m_vSelectedVariable[i]; 
+        unsigned int newVar = m_vNewSelectedVariable[i]; 
+        if (oldVar == newVar)
+            continue; 
+        vVariableSol[oldVar] = 0; 
+        for (typename matrix_type::index_type k = m_constrMatrixT.vRowBeginIndex[oldVar]-matrix_type::s_startingIndex, ke = m_constrMatrixT.vRowBeginIndex[oldVar+1]-matrix_type::s_startingIndex; k < ke; ++k)
+            m_vSlackness[m_constrMatrixT.vColumn[k]-matrix_type::s_startingIndex] += m_constrMatrixT.vElement[k]; 
+        vVariableSol[newVar] = 1; 
+        for (typename matrix_type::index_type k = m_constrMatrixT.vRowBeginIndex[newVar]-matrix_type::s_startingIndex, ke = m_constrMatrixT.vRowBeginIndex[newVar+1]-matrix_type::s_startingIndex; k < ke; ++k)
+            m_vSlackness[m_constrMatrixT.vColumn[k]-matrix_type::s_startingIndex] -= m_constrMatrixT.vElement[k]; 
+        m_vSelectedVariable[i] = newVar; 
+    }
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::runLagKernel()
+{
+    // find the bin with minimum cost for each item 
+    KernelPass pass; 
+    pass.kernel = LAG_KERNEL; 
+    pass.size = m_numGroups; 
+    pass.blockSize = 256; 
+    // each item takes its minimum cost, so the objective comes with the argmin 
+    std::vector<accumulator_type> vPartialSum (m_lagObjEval? (pass.size+pass.blockSize-1)/pass.blockSize : 0); 
+    pass.vPartialSum = vPartialSum.empty()? NULL : &vPartialSum[0]; 
+    runKernel(pass); 
+    // evaluate current objective, summed in a fixed order 
+    if (m_lagObjEval)
+    {
+        accumulator_type objValue = m_objConstant; 
+        for (typename std::vector<accumulator_type>::const_iterator it = vPartialSum.begin(), ite = vPartialSum.end(); it != ite; ++it)
+            objValue += *it; 
+        m_lagObj = objValue; 
     }
-    // evaluate current objective 
-    if (m_lagObjFlag)
-        m_lagObj = evaluateLagObjective();
-
 }
 template <typename T, typename V>
 void MultiKnapsackLagRelax<T, V>::computeSlackness() 
 {
     // s = b-Ax
-    bMinusAx(m_constrMatrix, &m_model->variableSolutions()[0], m_vConstrRhs, m_vSlackness);
+    if (m_numThreads > 1)
+    {
+        // rows are long, so a few of them make a block 
+        KernelPass pass; 
+        pass.kernel = SLACKNESS_KERNEL; 
+        pass.size = m_constrMatrix.numRows; 
+        pass.blockSize = 4; 
+        pass.vPartialSum = NULL; 
+        runKernel(pass); 
+    }
+    else 
+        bMinusAx(m_constrMatrix, &m_model->variableSolutions()[0], m_vConstrRhs, m_vSlackness);
 }
 template <typename T, typename V>
 typename MultiKnapsackLagRelax<T, V>::coefficient_value_type MultiKnapsackLagRelax<T, V>::evaluateLagObjective() const 
 {
     // evaluate current objective 
-    coefficient_value_type objValue = m_objConstant; 
-    for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
-        objValue += m_vObjCoef[i]*m_model->variableSolution(variable_type(i));
+    KernelPass pass; 
+    pass.kernel = OBJECTIVE_KERNEL; 
+    pass.size = m_model->numVariables(); 
+    pass.blockSize = 4096; 
+    std::vector<accumulator_type> vPartialSum ((pass.size+pass.blockSize-1)/pass.blockSize); 
+    pass.vPartialSum = vPartialSum.empty()? NULL : &vPartialSum[0]; 
+    runKernel(pass); 
+    // sum in a fixed order, independent of the schedule 
+    accumulator_type objValue = m_objConstant; 
+    for (typename std::vector<accumulator_type>::const_iterator it = vPartialSum.begin(), ite = vPartialSum.end(); it != ite; ++it)
+        objValue += *it; 
     return objValue; 
 }
 template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::runKernel(typename MultiKnapsackLagRelax<T, V>::KernelPass& pass) const
+{
+    pass.solver = this; 
+
+    // threads are not worth it if there are few blocks 
+    unsigned int numBlocks = (pass.size+pass.blockSize-1)/pass.blockSize; 
+    unsigned int numThreads = std::max(std::min(m_numThreads, numBlocks/4), 1U); 
+    // threads kept for the iterations only need to be woken up 
+    runNumericalKernel(pass, pass.size, pass.blockSize, numThreads); 
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::runBlock(typename MultiKnapsackLagRelax<T, V>::KernelPass const& pass, unsigned int b, unsigned int e) const
+{
+    switch (pass.kernel)
+    {
+        case LAG_KERNEL:
+            {
+                accumulator_type objValue = lagBlock(b, e); 
+                if (pass.vPartialSum)
+                    pass.vPartialSum[b/pass.blockSize] = objValue; 
+            }
+            break; 
+        case SLACKNESS_KERNEL:
+            slacknessBlock(b, e); 
+            break; 
+        case OBJECTIVE_KERNEL:
+            pass.vPartialSum[b/pass.blockSize] = objectiveBlock(b, e); 
+            break; 
+    }
+}
+template <typename T, typename V>
+typename MultiKnapsackLagRelax<T, V>::accumulator_type MultiKnapsackLagRelax<T, V>::lagBlock(unsigned int b, unsigned int e) const
+{
+    CompareVariableByCoefficient helper (m_vObjCoef);
+    variable_value_type* vVariableSol = &m_model->variableSolutions()[0];
+    accumulator_type objValue = 0; 
+    for (; b < e; ++b)
+    {
+        // find the bin with minimum cost for each item 
+        variable_type const* variable = std::min_element(m_vGroupedVariable+m_vVariableGroupBeginIndex[b], m_vGroupedVariable+m_vVariableGroupBeginIndex[b+1], helper);
+        objValue += m_vObjCoef[variable->id()]; 
+        if (m_incremental)
+            m_vNewSelectedVariable[b] = variable->id(); 
+        // the incremental update moves items by itself 
+        if (m_vSelectedVariable.empty())
+            vVariableSol[variable->id()] = 1; 
+    }
+    return objValue; 
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::slacknessBlock(unsigned int b, unsigned int e) const
+{
+    variable_value_type const* vVariableSol = &m_model->variableSolutions()[0];
+    for (; b < e; ++b)
+    {
+        accumulator_type slackness = m_vConstrRhs[b]; 
+        for (typename matrix_type::index_type k = m_constrMatrix.vRowBeginIndex[b]-matrix_type::s_startingIndex, ke = m_constrMatrix.vRowBeginIndex[b+1]-matrix_type::s_startingIndex; k < ke; ++k)
+            slackness -= (accumulator_type)m_constrMatrix.vElement[k]*vVariableSol[m_constrMatrix.vColumn[k]-matrix_type::s_startingIndex]; 
+        m_vSlackness[b] = slackness; 
+    }
+}
+template <typename T, typename V>
+typename MultiKnapsackLagRelax<T, V>::accumulator_type MultiKnapsackLagRelax<T, V>::objectiveBlock(unsigned int b, unsigned int e) const
+{
+    variable_value_type const* vVariableSol = &m_model->variableSolutions()[0];
+    accumulator_type objValue = 0; 
+    for (; b < e; ++b)
+        objValue += m_vObjCoef[b]*vVariableSol[b]; 
+    return objValue; 
+}
+template <typename T, typename V>
+void MultiKnapsackLagRelax<T, V>::record()
+{
+    ConvergenceRecord r; 
+    r.iter = m_iter; 
+    // the objective is scaled by the last scaling factor 
+    r.lagObj = (m_lagObjEval)? m_lagObj*m_vScalingFactor.back() : std::numeric_limits<coefficient_value_type>::quiet_NaN(); 
+    r.bestObj = (m_bestObj != std::numeric_limits<coefficient_value_type>::max())? m_bestObj*m_vScalingFactor.back() : m_bestObj; 
+    r.numNegativeSlacks = 0; 
+    r.violation = 0; 
+    for (typename matrix_type::index_type i = 0; i < m_constrMatrix.numRows; ++i)
+    {
+        if (m_vSlackness[i] < 0)
+        {
+            ++r.numNegativeSlacks; 
+            r.violation -= m_vSlackness[i]*m_vScalingFactor[m_vConstraintPartition[i]]; 
+        }
+    }
+    m_vConvergence.push_back(r); 
+}
+template <typename T, typename V>
 SolverProperty MultiKnapsackLagRelax<T, V>::converge()
 {
     bool feasibleFlag = true; 
@@ -768,11 +1202,13 @@ SolverProperty MultiKnapsackLagRelax<T, V>::converge()
     // store feasible solutions with better objective 
     if (feasibleFlag)
     {
-        coefficient_value_type obj = m_model->evaluateObjective(); 
+        coefficient_value_type obj = m_model->evaluateObjective(m_model->variableSolutions(), m_numThreads); 
         if (obj < m_bestObj)
         {
             m_vBestVariableSol = m_model->variableSolutions();
             m_bestObj = obj; 
+            if (m_warmStart)
+                m_vBestLagMultiplier.assign(m_vLagMultiplier, m_vLagMultiplier+m_constrMatrix.numRows); 
         }
         status = SUBOPTIMAL;
     }
@@ -784,6 +1220,7 @@ SolverProperty MultiKnapsackLagRelax<T, V>::converge()
 template <typename T, typename V>
 SolverProperty MultiKnapsackLagRelax<T, V>::postProcess(typename MultiKnapsackLagRelax<T, V>::updater_type* updater, typename MultiKnapsackLagRelax<T, V>::searcher_type* searcher, SolverProperty status)
 {
+    limboScopedTimer("postProcess"); 
     if (status == OPTIMAL) // already OPTIMAL
         return status; 
     else if (m_bestObj != std::numeric_limits<coefficient_value_type>::max()) // there is a best feasible solution in store 
@@ -935,12 +1372,21 @@ class LagMultiplierUpdater
     public:
         /// @brief value type 
         typedef T value_type; 
+        /// @brief type of sums over multipliers, see @ref NumericalAccumulator 
+        typedef typename NumericalAccumulator<T>::type accumulator_type; 
 
         /// @brief constructor 
         LagMultiplierUpdater() {}
         /// @brief destructor 
         virtual ~LagMultiplierUpdater() {}
 
+        /// @return true if the updater needs objectives through @ref setObjective before each update 
+        virtual bool needObjective() const {return false;}
+        /// @brief set objectives of current iteration before an update 
+        /// @param lagObj objective of the lagrangian subproblem, a lower bound of the problem 
+        /// @param bestObj best objective of feasible solutions so far, maximum value of @ref value_type if none 
+        virtual void setObjective(value_type /*lagObj*/, value_type /*bestObj*/) {}
+
         /// @brief API to update lagrangian multiplier 
         /// @param iter current iteration 
         /// @param multiplier current multiplier value 
@@ -1061,6 +1507,437 @@ class SubGradientDescent : public LagMultiplierUpdater<T>
         value_type m_scalingFactor; ///< scaling factor \f$ t_k = \beta \cdot k^{-\alpha} \f$
 };
 
+/// @brief Update lagrangian multiplier with Polyak step size and target estimation. 
+/// 
+/// The step size is \f$ t_k = \theta (L^* - L(\lambda^k)) / \|g^k\|^2 \f$, 
+/// where \f$ g^k \f$ is the subgradient projected to the feasible directions of \f$ \lambda \ge 0 \f$. 
+/// The unknown optimal value \f$ L^* \f$ is estimated by the target \f$ \bar{L}^k + \delta_k \f$ 
+/// with \f$ \bar{L}^k \f$ the best lagrangian objective so far, 
+/// capped by the best objective of feasible solutions. 
+/// \f$ \delta_k \f$ grows when the target is reached and shrinks when the objective stalls. 
+/// @tparam T coefficient value type 
+template <typename T>
+class PolyakStep : public LagMultiplierUpdater<T>
+{
+    public:
+        /// @brief base type 
+        typedef LagMultiplierUpdater<T> base_type;
+        /// @brief value type 
+        typedef typename base_type::value_type value_type;
+        /// @brief type of sums 
+        typedef typename base_type::accumulator_type accumulator_type;
+
+        /// @brief constructor 
+        /// @param theta relaxation factor in (0, 2) 
+        /// @param deltaRatio initial \f$ \delta \f$ relative to \f$ |L(\lambda^0)| \f$
+        /// @param patience number of iterations without improvement before shrinking \f$ \delta \f$
+        PolyakStep(value_type theta = 1, value_type deltaRatio = 0.05, unsigned int patience = 10)
+            : PolyakStep::base_type()
+            , m_theta(theta)
+            , m_deltaRatio(deltaRatio)
+            , m_patience(patience)
+            , m_lagObj(0)
+            , m_bestObj(std::numeric_limits<value_type>::max())
+        {
+            reset(); 
+        }
+        /// @brief destructor 
+        virtual ~PolyakStep()
+        {
+        }
+
+        /// @return true as the step size needs objectives 
+        virtual bool needObjective() const {return true;}
+        /// @brief set objectives of current iteration 
+        /// @param lagObj objective of the lagrangian subproblem 
+        /// @param bestObj best objective of feasible solutions 
+        virtual void setObjective(value_type lagObj, value_type bestObj)
+        {
+            m_lagObj = lagObj; 
+            m_bestObj = bestObj; 
+        }
+        /// @brief API to update lagrangian multiplier with the step size of last update 
+        /// @param iter current iteration 
+        /// @param multiplier current multiplier value 
+        /// @param slackness current slackness value assuming the constraint is in \f$ Ax \le b \f$ and compute \f$ b-Ax \f$
+        /// @return updated multiplier value 
+        value_type operator()(unsigned int /*iter*/, value_type multiplier, value_type slackness)
+        {
+            return std::max((value_type)0, multiplier-m_step*slackness);
+        }
+        /// @brief API to update lagrangian multiplier with Polyak step size 
+        /// @param iter current iteration 
+        /// @param n dimension 
+        /// @param vSlackness array of slackness 
+        /// @param vLagMultiplier array of lagrangian multipliers 
+        /// @param vNewLagMultiplier array of new lagrangian multipliers 
+        void operator()(unsigned int iter, unsigned int n, value_type const* vSlackness, value_type const* vLagMultiplier, value_type* vNewLagMultiplier)
+        {
+            // a new solve starts 
+            if ((iter <= m_iter && m_iter != std::numeric_limits<unsigned int>::max()) || m_vDirection.size() != n)
+                reset(); 
+            m_iter = iter; 
+            m_vDirection.resize(n); 
+            computeDirection(n, vSlackness, vLagMultiplier); 
+
+            accumulator_type norm2 = 0; 
+            for (unsigned int i = 0; i < n; ++i)
+                norm2 += m_vDirection[i]*m_vDirection[i]; 
+            if (norm2 == 0)
+            {
+                m_step = 0; 
+                std::copy(vLagMultiplier, vLagMultiplier+n, vNewLagMultiplier); 
+                return; 
+            }
+            m_step = m_theta*(target()-m_lagObj)/norm2; 
+            for (unsigned int i = 0; i < n; ++i)
+                vNewLagMultiplier[i] = std::max((value_type)0, vLagMultiplier[i]-m_step*m_vDirection[i]);
+        }
+    protected:
+        /// @brief reset states for a new solve, objectives are already set for current iteration 
+        void reset()
+        {
+            m_iter = std::numeric_limits<unsigned int>::max(); 
+            m_bestLagObj = -std::numeric_limits<value_type>::max(); 
+            m_delta = -1; 
+            m_numStalls = 0; 
+            m_step = 0; 
+            m_vDirection.clear(); 
+        }
+        /// @brief compute the direction to move multipliers against, in the form of slackness 
+        /// @param n dimension 
+        /// @param vSlackness array of slackness 
+        /// @param vLagMultiplier array of lagrangian multipliers 
+        virtual void computeDirection(unsigned int n, value_type const* vSlackness, value_type const* vLagMultiplier)
+        {
+            // multipliers at zero with positive slackness cannot move 
+            for (unsigned int i = 0; i < n; ++i)
+                m_vDirection[i] = (vLagMultiplier[i] == 0 && vSlackness[i] > 0)? 0 : vSlackness[i]; 
+        }
+        /// @brief update target estimation with current objective 
+        /// @return target of lagrangian objective 
+        value_type target()
+        {
+            if (m_delta < 0) // first iteration 
+                m_delta = std::max(m_deltaRatio*std::abs(m_lagObj), std::numeric_limits<value_type>::epsilon()); 
+            else if (m_lagObj >= m_bestLagObj+m_delta) // target reached 
+                m_delta *= 1.5; 
+            if (m_lagObj > m_bestLagObj)
+            {
+                m_bestLagObj = m_lagObj; 
+                m_numStalls = 0; 
+            }
+            else if (++m_numStalls >= m_patience)
+            {
+                m_delta *= 0.5; 
+                m_numStalls = 0; 
+            }
+            value_type result = m_bestLagObj+m_delta; 
+            // a feasible solution bounds the optimal objective 
+            if (m_bestObj < result && m_bestObj > m_lagObj)
+                result = m_bestObj; 
+            return std::max(result, m_lagObj+std::numeric_limits<value_type>::epsilon()*std::abs(m_lagObj)); 
+        }
+
+        value_type m_theta; ///< relaxation factor 
+        value_type m_deltaRatio; ///< initial gap of target relative to the objective 
+        unsigned int m_patience; ///< number of iterations without improvement before shrinking the gap 
+        unsigned int m_iter; ///< current iteration 
+        value_type m_lagObj; ///< current objective of the lagrangian subproblem 
+        value_type m_bestObj; ///< best objective of feasible solutions 
+        value_type m_bestLagObj; ///< best objective of the lagrangian subproblem 
+        value_type m_delta; ///< gap between target and best lagrangian objective 
+        unsigned int m_numStalls; ///< number of iterations without improvement 
+        value_type m_step; ///< step size of last update 
+        std::vector<value_type> m_vDirection; ///< direction of last update 
+};
+
+/// @brief Update lagrangian multiplier with deflected subgradient of Camerini, Fratta and Maffioli. 
+/// 
+/// The direction is \f$ d^k = g^k + \beta_k d^{k-1} \f$ with 
+/// \f$ \beta_k = \max(0, -\gamma g^{k, T} d^{k-1} / \|d^{k-1}\|^2) \f$, 
+/// which damps the zigzag of subgradients between two faces. 
+/// The step size follows @ref limbo::solvers::PolyakStep on the direction. 
+/// @tparam T coefficient value type 
+template <typename T>
+class DeflectedSubGradient : public PolyakStep<T>
+{
+    public:
+        /// @brief base type 
+        typedef PolyakStep<T> base_type;
+        /// @brief value type 
+        typedef typename base_type::value_type value_type;
+        /// @brief type of sums 
+        typedef typename base_type::accumulator_type accumulator_type;
+
+        /// @brief constructor 
+        /// @param gamma deflection factor, 1.5 is suggested by Camerini, Fratta and Maffioli 
+        /// @param theta relaxation factor in (0, 2) 
+        /// @param deltaRatio initial \f$ \delta \f$ relative to \f$ |L(\lambda^0)| \f$
+        /// @param patience number of iterations without improvement before shrinking \f$ \delta \f$
+        DeflectedSubGradient(value_type gamma = 1.5, value_type theta = 1, value_type deltaRatio = 0.05, unsigned int patience = 10)
+            : DeflectedSubGradient::base_type(theta, deltaRatio, patience)
+            , m_gamma(gamma)
+        {
+        }
+    protected:
+        /// @brief compute deflected direction 
+        /// @param n dimension 
+        /// @param vSlackness array of slackness 
+        /// @param vLagMultiplier array of lagrangian multipliers 
+        virtual void computeDirection(unsigned int n, value_type const* vSlackness, value_type const* vLagMultiplier)
+        {
+            // this->m_vDirection keeps the previous direction unless reset 
+            accumulator_type dot = 0; 
+            accumulator_type norm2 = 0; 
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                dot += vSlackness[i]*this->m_vDirection[i]; 
+                norm2 += this->m_vDirection[i]*this->m_vDirection[i]; 
+            }
+            value_type beta = (norm2 > 0)? std::max((value_type)0, (value_type)(-m_gamma*dot/norm2)) : 0; 
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                value_type d = vSlackness[i]+beta*this->m_vDirection[i]; 
+                // multipliers at zero cannot move below 
+                this->m_vDirection[i] = (vLagMultiplier[i] == 0 && d > 0)? 0 : d; 
+            }
+        }
+
+        value_type m_gamma; ///< deflection factor 
+};
+
+/// @brief Update lagrangian multiplier with a proximal bundle method. 
+/// 
+/// Each iteration adds a cutting plane \f$ L(\lambda^j) + g^{j, T} (\lambda - \lambda^j) \f$ 
+/// of the concave lagrangian objective to a bundle. 
+/// The next multipliers maximize the cutting plane model with a proximal term, 
+/// \f[ \max_{\lambda \ge 0} \min_j (L(\lambda^j) + g^{j, T} (\lambda - \lambda^j)) - \frac{u}{2} \|\lambda - \hat{\lambda}\|^2, \f]
+/// solved in its dual over the simplex of bundle weights by projected gradient, 
+/// where \f$ \lambda = \max(0, \hat{\lambda} + \sum_j \alpha_j g^j / u) \f$. 
+/// The center \f$ \hat{\lambda} \f$ moves only if the objective increases by a fraction of the predicted increase (serious step); 
+/// otherwise the cut refines the model (null step). 
+/// The weight \f$ u \f$ decreases after serious steps and increases after null steps. 
+/// @tparam T coefficient value type 
+template <typename T>
+class ProximalBundle : public LagMultiplierUpdater<T>
+{
+    public:
+        /// @brief base type 
+        typedef LagMultiplierUpdater<T> base_type;
+        /// @brief value type 
+        typedef typename base_type::value_type value_type;
+        /// @brief type of sums 
+        typedef typename base_type::accumulator_type accumulator_type;
+
+        /// @brief constructor 
+        /// @param weight initial proximal weight \f$ u \f$
+        /// @param maxBundleSize maximum number of cutting planes 
+        /// @param seriousRatio fraction of predicted increase to accept a serious step 
+        ProximalBundle(value_type weight = 1, unsigned int maxBundleSize = 10, value_type seriousRatio = 0.1)
+            : ProximalBundle::base_type()
+            , m_initWeight(weight)
+            , m_maxBundleSize(std::max(maxBundleSize, 2U))
+            , m_seriousRatio(seriousRatio)
+            , m_lagObj(0)
+        {
+            reset(); 
+        }
+        /// @brief destructor 
+        virtual ~ProximalBundle()
+        {
+        }
+
+        /// @return true as cutting planes need objectives 
+        virtual bool needObjective() const {return true;}
+        /// @brief set objectives of current iteration 
+        /// @param lagObj objective of the lagrangian subproblem 
+        virtual void setObjective(value_type lagObj, value_type /*bestObj*/)
+        {
+            m_lagObj = lagObj; 
+        }
+        /// @brief API to update a lagrangian multiplier, not supported by bundles, so the multiplier is kept 
+        /// @param multiplier current multiplier value 
+        /// @return the same multiplier value 
+        value_type operator()(unsigned int /*iter*/, value_type multiplier, value_type /*slackness*/)
+        {
+            return multiplier; 
+        }
+        /// @brief API to update lagrangian multiplier with a bundle step 
+        /// @param iter current iteration 
+        /// @param n dimension 
+        /// @param vSlackness array of slackness 
+        /// @param vLagMultiplier array of lagrangian multipliers 
+        /// @param vNewLagMultiplier array of new lagrangian multipliers 
+        void operator()(unsigned int iter, unsigned int n, value_type const* vSlackness, value_type const* vLagMultiplier, value_type* vNewLagMultiplier)
+        {
+            // a new solve starts 
+            if ((iter <= m_iter && m_iter != std::numeric_limits<unsigned int>::max()) || m_vCenter.size() != n)
+                reset(); 
+            m_iter = iter; 
+
+            addCut(n, vSlackness, vLagMultiplier); 
+            if (m_vCenter.empty())
+            {
+                m_vCenter.assign(vLagMultiplier, vLagMultiplier+n); 
+                m_centerObj = m_lagObj; 
+            }
+            else if (m_lagObj-m_centerObj >= m_seriousRatio*m_predicted) // serious step 
+            {
+                m_vCenter.assign(vLagMultiplier, vLagMultiplier+n); 
+                m_centerObj = m_lagObj; 
+                m_weight = std::max(m_weight*(value_type)0.5, m_initWeight*(value_type)1e-6); 
+            }
+            else // null step 
+                m_weight = std::min(m_weight*2, m_initWeight*(value_type)1e6); 
+
+            solveQP(n, vNewLagMultiplier); 
+
+            // predicted increase of the cutting plane model 
+            value_type model = std::numeric_limits<value_type>::max(); 
+            for (unsigned int j = 0; j < m_vCut.size(); ++j)
+                model = std::min(model, m_vCut[j].value(vNewLagMultiplier)); 
+            m_predicted = model-m_centerObj; 
+        }
+    protected:
+        /// @brief cutting plane \f$ c + g^T \lambda \f$
+        struct Cut
+        {
+            value_type constant; ///< constant 
+            std::vector<value_type> vGrad; ///< subgradient \f$ g = Ax-b \f$
+            value_type weight; ///< weight in the last solution of the dual problem 
+            unsigned int iter; ///< iteration of the cut 
+
+            /// @param vLagMultiplier array of lagrangian multipliers 
+            /// @return value of the cut 
+            value_type value(value_type const* vLagMultiplier) const 
+            {
+                accumulator_type result = constant; 
+                for (unsigned int i = 0, ie = vGrad.size(); i < ie; ++i)
+                    result += vGrad[i]*vLagMultiplier[i]; 
+                return result; 
+            }
+        };
+
+        /// @brief reset states for a new solve, objectives are already set for current iteration 
+        void reset()
+        {
+            m_iter = std::numeric_limits<unsigned int>::max(); 
+            m_weight = m_initWeight; 
+            m_centerObj = 0; 
+            m_predicted = 0; 
+            m_vCenter.clear(); 
+            m_vCut.clear(); 
+        }
+        /// @brief add a cut and drop the oldest cut not in use if the bundle is full 
+        /// @param n dimension 
+        /// @param vSlackness array of slackness 
+        /// @param vLagMultiplier array of lagrangian multipliers 
+        void addCut(unsigned int n, value_type const* vSlackness, value_type const* vLagMultiplier)
+        {
+            if (m_vCut.size() >= m_maxBundleSize)
+            {
+                unsigned int drop = 0; 
+                for (unsigned int j = 1; j < m_vCut.size(); ++j)
+                {
+                    bool unused = (m_vCut[j].weight == 0); 
+                    bool dropUnused = (m_vCut[drop].weight == 0); 
+                    if ((unused && !dropUnused) || (unused == dropUnused && m_vCut[j].iter < m_vCut[drop].iter))
+                        drop = j; 
+                }
+                m_vCut.erase(m_vCut.begin()+drop); 
+            }
+            m_vCut.push_back(Cut()); 
+            Cut& cut = m_vCut.back(); 
+            cut.vGrad.resize(n); 
+            accumulator_type constant = m_lagObj; 
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                cut.vGrad[i] = -vSlackness[i]; 
+                constant += (accumulator_type)vSlackness[i]*vLagMultiplier[i]; 
+            }
+            cut.constant = constant; 
+            cut.weight = 0; 
+            cut.iter = m_iter; 
+        }
+        /// @brief compute multipliers for bundle weights 
+        /// @param n dimension 
+        /// @param vWeight weights of cuts 
+        /// @param vLagMultiplier output multipliers 
+        void multipliers(unsigned int n, std::vector<value_type> const& vWeight, value_type* vLagMultiplier) const 
+        {
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                value_type g = 0; 
+                for (unsigned int j = 0; j < m_vCut.size(); ++j)
+                    g += vWeight[j]*m_vCut[j].vGrad[i]; 
+                vLagMultiplier[i] = std::max((value_type)0, m_vCenter[i]+g/m_weight); 
+            }
+        }
+        /// @brief solve the dual of the proximal problem over the simplex of bundle weights by projected gradient 
+        /// @param n dimension 
+        /// @param vLagMultiplier output multipliers 
+        void solveQP(unsigned int n, value_type* vLagMultiplier)
+        {
+            unsigned int k = m_vCut.size(); 
+            // the gradient is Lipschitz with a constant bounded by the sum of squared norms of cuts over the weight 
+            accumulator_type lipschitz = 0; 
+            for (unsigned int j = 0; j < k; ++j)
+                for (unsigned int i = 0; i < n; ++i)
+                    lipschitz += m_vCut[j].vGrad[i]*m_vCut[j].vGrad[i]; 
+            lipschitz /= m_weight; 
+            // start from the newest cut 
+            std::vector<value_type> vWeight (k, 0); 
+            vWeight.back() = 1; 
+            std::vector<value_type> vGrad (k); 
+            for (unsigned int iter = 0; iter < 100 && lipschitz > 0; ++iter)
+            {
+                multipliers(n, vWeight, vLagMultiplier); 
+                // gradient of the dual objective is the value of each cut at the multipliers 
+                for (unsigned int j = 0; j < k; ++j)
+                    vGrad[j] = vWeight[j]-m_vCut[j].value(vLagMultiplier)/lipschitz; 
+                projectSimplex(vGrad); 
+                value_type change = 0; 
+                for (unsigned int j = 0; j < k; ++j)
+                    change += std::abs(vGrad[j]-vWeight[j]); 
+                vWeight.swap(vGrad); 
+                if (change < 1e-6)
+                    break; 
+            }
+            multipliers(n, vWeight, vLagMultiplier); 
+            for (unsigned int j = 0; j < k; ++j)
+                m_vCut[j].weight = vWeight[j]; 
+        }
+        /// @brief project a vector to the unit simplex 
+        /// @param v vector 
+        static void projectSimplex(std::vector<value_type>& v) 
+        {
+            std::vector<value_type> u (v); 
+            std::sort(u.begin(), u.end(), std::greater<value_type>()); 
+            value_type sum = 0; 
+            value_type shift = 0; 
+            for (unsigned int j = 0; j < u.size(); ++j)
+            {
+                sum += u[j]; 
+                if (u[j]-(sum-1)/(j+1) > 0)
+                    shift = (sum-1)/(j+1); 
+            }
+            for (unsigned int j = 0; j < v.size(); ++j)
+                v[j] = std::max((value_type)0, v[j]-shift); 
+        }
+
+        value_type m_initWeight; ///< initial proximal weight 
+        unsigned int m_maxBundleSize; ///< maximum number of cuts 
+        value_type m_seriousRatio; ///< fraction of predicted increase for a serious step 
+        unsigned int m_iter; ///< current iteration 
+        value_type m_lagObj; ///< current objective of the lagrangian subproblem 
+        value_type m_weight; ///< proximal weight 
+        value_type m_centerObj; ///< objective at the center 
+        value_type m_predicted; ///< predicted increase of last step 
+        std::vector<value_type> m_vCenter; ///< center of the proximal term 
+        std::vector<Cut> m_vCut; ///< bundle of cutting planes 
+};
+
 /// @brief Base class for scaling scheme with default no scaling  
 /// @tparam T coefficient value type 
 /// @tparam V variable value type 
@@ -1099,6 +1976,37 @@ class ProblemScaler
         {
             return this->operator()(constr.expression());
         }
+        /// @brief API to compute scaling factors of all constraints and the objective. 
+        /// By default, constraints are computed independently by threads in blocks. 
+        /// @param model model of the problem 
+        /// @param vScalingFactor scaling factor of each constraint, followed by the one of the objective 
+        /// @param numThreads number of threads 
+        virtual void computeScalingFactors(model_type const& model, std::vector<value_type>& vScalingFactor, unsigned int numThreads) const
+        {
+            vScalingFactor.resize(model.constraints().size()+1); 
+            ConstraintKernel kernel; 
+            kernel.scaler = this; 
+            kernel.vConstraint = (model.constraints().empty())? NULL : &model.constraints()[0]; 
+            kernel.vScalingFactor = &vScalingFactor[0]; 
+            runNumericalKernel(kernel, model.constraints().size(), NUMERICAL_BLOCK_WORK/16, numThreads); 
+            vScalingFactor.back() = this->operator()(model.objective()); 
+        }
+
+    protected:
+        /// @brief scaling factors of constraints [b, e) 
+        struct ConstraintKernel
+        {
+            ProblemScaler const* scaler; ///< the scaler 
+            constraint_type const* vConstraint; ///< constraints 
+            value_type* vScalingFactor; ///< scaling factor of each constraint 
+            /// @param b first constraint 
+            /// @param e end constraint 
+            void operator()(unsigned int b, unsigned int e) const
+            {
+                for (; b < e; ++b)
+                    vScalingFactor[b] = scaler->operator()(vConstraint[b]); 
+            }
+        };
 };
 
 /// @brief Scaling scheme with minimum coefficient in an expression 
@@ -1193,6 +2101,201 @@ class L2NormScaler : public ProblemScaler<T, V>
         }
 };
 
+/// @brief Scaling scheme with Ruiz equilibration of the constraint matrix. 
+/// 
+/// Each iteration divides rows and columns by square roots of their maximum absolute coefficients, 
+/// which drives all of them to one. 
+/// Only row factors are applied, as variables keep their bounds and integrality; 
+/// column factors balance rows with large and small coefficients on the same variables during the iterations. 
+/// Rows and columns are computed by threads over a CSR copy of the constraints and its transpose. 
+/// The objective is scaled by its maximum absolute coefficient. 
+/// @tparam T coefficient value type 
+/// @tparam V variable value type 
+template <typename T, typename V>
+class RuizScaler : public ProblemScaler<T, V>
+{
+    public:
+        /// @brief base type 
+        typedef ProblemScaler<T, V> base_type;
+        /// @brief model type 
+        typedef typename base_type::model_type model_type; 
+        /// @brief value type 
+        typedef typename base_type::value_type value_type;
+        /// @brief expression type 
+        typedef typename base_type::expression_type expression_type; 
+        /// @brief constraint type 
+        typedef typename base_type::constraint_type constraint_type; 
+        /// @brief term type 
+        typedef typename base_type::term_type term_type; 
+
+        /// @brief constructor 
+        /// @param maxIters maximum number of iterations 
+        /// @param tolerance stop if maximum absolute coefficients of all rows and columns are within this distance to one 
+        RuizScaler(unsigned int maxIters = 10, value_type tolerance = 0.1) : base_type(), m_maxIters(maxIters), m_tolerance(tolerance) {}
+        /// @brief destructor 
+        ~RuizScaler() {}
+
+        /// @brief API to compute scaling factor for expression using maximum absolute coefficient 
+        /// @param expr expression 
+        /// @return scaling factor 
+        value_type operator()(expression_type const& expr) const
+        {
+            value_type result = 0; 
+            for (typename std::vector<term_type>::const_iterator it = expr.terms().begin(), ite = expr.terms().end(); it != ite; ++it)
+                result = std::max(result, (value_type)std::abs(it->coefficient())); 
+            return (result > 0)? result : 1; 
+        }
+        /// @brief API to compute scaling factor for constraints using maximum absolute coefficient 
+        /// @param constr constraint 
+        /// @return scaling factor 
+        value_type operator()(constraint_type const& constr) const
+        {
+            return this->operator()(constr.expression());
+        }
+        /// @brief API to compute scaling factors of all constraints by Ruiz equilibration 
+        /// @param model model of the problem 
+        /// @param vScalingFactor scaling factor of each constraint, followed by the one of the objective 
+        /// @param numThreads number of threads 
+        void computeScalingFactors(model_type const& model, std::vector<value_type>& vScalingFactor, unsigned int numThreads) const;
+
+    protected:
+        /// @brief data of the equilibration shared by kernels 
+        struct Equilibration
+        {
+            std::vector<unsigned int> vRowBegin; ///< begin of each row in @ref vColumn and @ref vElement 
+            std::vector<unsigned int> vColumn; ///< column of each element 
+            std::vector<value_type> vElement; ///< absolute value of each element 
+            std::vector<unsigned int> vColumnBegin; ///< begin of each column in @ref vColumnElement 
+            std::vector<unsigned int> vColumnElement; ///< elements of columns, indices to @ref vElement 
+            std::vector<unsigned int> vElementRow; ///< row of each element 
+            std::vector<value_type> vRowFactor; ///< scaling factor \f$ d_i \f$ multiplied to each row 
+            std::vector<value_type> vColumnFactor; ///< scaling factor \f$ e_j \f$ multiplied to each column 
+            std::vector<value_type> vDeviation; ///< distance of the maximum absolute coefficient to one of each row or column 
+        };
+        /// @brief copy rows [b, e) of constraints 
+        struct CopyKernel
+        {
+            Equilibration* data; ///< equilibration 
+            constraint_type const* vConstraint; ///< constraints 
+            /// @param b first row 
+            /// @param e end row 
+            void operator()(unsigned int b, unsigned int e) const
+            {
+                for (; b < e; ++b)
+                {
+                    unsigned int k = data->vRowBegin[b]; 
+                    for (typename std::vector<term_type>::const_iterator it = vConstraint[b].expression().terms().begin(), ite = vConstraint[b].expression().terms().end(); it != ite; ++it, ++k)
+                    {
+                        data->vColumn[k] = it->variable().id(); 
+                        data->vElement[k] = std::abs(it->coefficient()); 
+                        data->vElementRow[k] = b; 
+                    }
+                }
+            }
+        };
+        /// @brief equilibrate rows [b, e) 
+        struct RowKernel
+        {
+            Equilibration* data; ///< equilibration 
+            /// @param b first row 
+            /// @param e end row 
+            void operator()(unsigned int b, unsigned int e) const
+            {
+                for (; b < e; ++b)
+                {
+                    value_type norm = 0; 
+                    for (unsigned int k = data->vRowBegin[b]; k < data->vRowBegin[b+1]; ++k)
+                        norm = std::max(norm, data->vElement[k]*data->vColumnFactor[data->vColumn[k]]); 
+                    norm *= data->vRowFactor[b]; 
+                    data->vDeviation[b] = (norm > 0)? std::abs(1-norm) : 0; 
+                    if (norm > 0)
+                        data->vRowFactor[b] /= sqrt(norm); 
+                }
+            }
+        };
+        /// @brief equilibrate columns [b, e) 
+        struct ColumnKernel
+        {
+            Equilibration* data; ///< equilibration 
+            /// @param b first column 
+            /// @param e end column 
+            void operator()(unsigned int b, unsigned int e) const
+            {
+                for (; b < e; ++b)
+                {
+                    value_type norm = 0; 
+                    for (unsigned int k = data->vColumnBegin[b]; k < data->vColumnBegin[b+1]; ++k)
+                    {
+                        unsigned int element = data->vColumnElement[k]; 
+                        norm = std::max(norm, data->vElement[element]*data->vRowFactor[data->vElementRow[element]]); 
+                    }
+                    norm *= data->vColumnFactor[b]; 
+                    data->vDeviation[data->vRowFactor.size()+b] = (norm > 0)? std::abs(1-norm) : 0; 
+                    if (norm > 0)
+                        data->vColumnFactor[b] /= sqrt(norm); 
+                }
+            }
+        };
+
+        unsigned int m_maxIters; ///< maximum number of iterations 
+        value_type m_tolerance; ///< tolerance of maximum absolute coefficients to one 
+};
+
+template <typename T, typename V>
+void RuizScaler<T, V>::computeScalingFactors(typename RuizScaler<T, V>::model_type const& model, std::vector<typename RuizScaler<T, V>::value_type>& vScalingFactor, unsigned int numThreads) const
+{
+    limboScopedTimer("RuizScaler::computeScalingFactors"); 
+    std::vector<constraint_type> const& vConstraint = model.constraints(); 
+    unsigned int numRows = vConstraint.size(); 
+    unsigned int numColumns = model.numVariables(); 
+    Equilibration data; 
+    // CSR copy of absolute coefficients 
+    data.vRowBegin.resize(numRows+1); 
+    data.vRowBegin[0] = 0; 
+    for (unsigned int i = 0; i < numRows; ++i)
+        data.vRowBegin[i+1] = data.vRowBegin[i]+vConstraint[i].expression().terms().size(); 
+    unsigned int numElements = data.vRowBegin.back(); 
+    data.vColumn.resize(numElements); 
+    data.vElement.resize(numElements); 
+    data.vElementRow.resize(numElements); 
+    CopyKernel copyKernel; 
+    copyKernel.data = &data; 
+    copyKernel.vConstraint = (numRows)? &vConstraint[0] : NULL; 
+    runNumericalKernel(copyKernel, numRows, NUMERICAL_BLOCK_WORK/16, numThreads); 
+    // transpose by counting sort of columns 
+    data.vColumnBegin.assign(numColumns+1, 0); 
+    for (unsigned int k = 0; k < numElements; ++k)
+        ++data.vColumnBegin[data.vColumn[k]+1]; 
+    for (unsigned int j = 0; j < numColumns; ++j)
+        data.vColumnBegin[j+1] += data.vColumnBegin[j]; 
+    data.vColumnElement.resize(numElements); 
+    std::vector<unsigned int> vNext (data.vColumnBegin.begin(), data.vColumnBegin.end()-1); 
+    for (unsigned int k = 0; k < numElements; ++k)
+        data.vColumnElement[vNext[data.vColumn[k]]++] = k; 
+
+    data.vRowFactor.assign(numRows, 1); 
+    data.vColumnFactor.assign(numColumns, 1); 
+    data.vDeviation.assign(numRows+numColumns, 0); 
+    RowKernel rowKernel; 
+    rowKernel.data = &data; 
+    ColumnKernel columnKernel; 
+    columnKernel.data = &data; 
+    for (unsigned int iter = 0; iter < m_maxIters; ++iter)
+    {
+        // rows and columns use the factors of each other from the previous pass 
+        runNumericalKernel(rowKernel, numRows, NUMERICAL_BLOCK_WORK/16, numThreads); 
+        runNumericalKernel(columnKernel, numColumns, NUMERICAL_BLOCK_WORK/16, numThreads); 
+        if (data.vDeviation.empty() || *std::max_element(data.vDeviation.begin(), data.vDeviation.end()) <= m_tolerance)
+            break; 
+    }
+
+    // constraints are divided by the factors 
+    vScalingFactor.resize(numRows+1); 
+    for (unsigned int i = 0; i < numRows; ++i)
+        vScalingFactor[i] = 1/data.vRowFactor[i]; 
+    vScalingFactor.back() = this->operator()(model.objective()); 
+}
+
 /// @brief Base heuristic to search for feasible solutions 
 /// @tparam T coefficient value type 
 /// @tparam V variable value type 
@@ -1243,6 +2346,7 @@ class FeasibleSearcher
             , m_useInitialSol(solver->m_useInitialSol)
             , m_vBestVariableSol(solver->m_vBestVariableSol)
             , m_bestObj(solver->m_bestObj)
+            , m_numThreads(solver->m_numThreads)
         {
         }
         /// @brief destructor 
@@ -1268,6 +2372,39 @@ class FeasibleSearcher
         {
             return m_solver->solveSubproblems(updater, beginIter, endIter);
         }
+        /// @brief transpose capacity constraints into columns of zero-based row indices 
+        /// @param vColumnBegin first element of each variable, with one more entry for the end 
+        /// @param vColumnRow row of each element 
+        /// @param vColumnElement coefficient of each element 
+        void transposeConstraints(std::vector<unsigned int>& vColumnBegin, std::vector<unsigned int>& vColumnRow, std::vector<coefficient_value_type>& vColumnElement) const 
+        {
+            vColumnBegin.assign(m_model->numVariables()+1, 0); 
+            for (typename matrix_type::index_type k = 0; k < m_constrMatrix.numElements; ++k)
+                ++vColumnBegin[m_constrMatrix.vColumn[k]-matrix_type::s_startingIndex+1]; 
+            for (unsigned int j = 0, je = m_model->numVariables(); j < je; ++j)
+                vColumnBegin[j+1] += vColumnBegin[j]; 
+            vColumnRow.resize(m_constrMatrix.numElements); 
+            vColumnElement.resize(m_constrMatrix.numElements); 
+            std::vector<unsigned int> vNext (vColumnBegin.begin(), vColumnBegin.end()-1); 
+            for (typename matrix_type::index_type i = 0; i < m_constrMatrix.numRows; ++i)
+            {
+                for (typename matrix_type::index_type k = m_constrMatrix.vRowBeginIndex[i]-matrix_type::s_startingIndex, ke = m_constrMatrix.vRowBeginIndex[i+1]-matrix_type::s_startingIndex; k < ke; ++k)
+                {
+                    unsigned int pos = vNext[m_constrMatrix.vColumn[k]-matrix_type::s_startingIndex]++; 
+                    vColumnRow[pos] = i; 
+                    vColumnElement[pos] = m_constrMatrix.vElement[k]; 
+                }
+            }
+        }
+        /// @brief map variables to groups, variables in no group are mapped to the maximum value 
+        /// @param vVariable2Group group of each variable 
+        void groupVariables(std::vector<unsigned int>& vVariable2Group) const 
+        {
+            vVariable2Group.assign(m_model->numVariables(), std::numeric_limits<unsigned int>::max()); 
+            for (unsigned int g = 0; g < m_numGroups; ++g)
+                for (unsigned int k = m_vVariableGroupBeginIndex[g]; k < m_vVariableGroupBeginIndex[g+1]; ++k)
+                    vVariable2Group[m_vGroupedVariable[k].id()] = g; 
+        }
 
         solver_type* m_solver; ///< problem solver 
         model_type* const& m_model; ///< model for the problem 
@@ -1291,6 +2428,7 @@ class FeasibleSearcher
 
         std::vector<variable_value_type>& m_vBestVariableSol; ///< best feasible solution found so far 
         coefficient_value_type& m_bestObj; ///< best objective found so far 
+        unsigned int const& m_numThreads; ///< number of threads in use 
 };
 
 /// @brief Heuristic to search for feasible solutions by adjusting coefficients 
@@ -1718,6 +2856,305 @@ class SearchByBinSmoothing : public SearchByAdjustCoefficient<T, V>
         std::vector<coefficient_value_type> m_vObjCoefOrig; ///< original coefficient of variable in objective 
 };
 
+/// @brief Heuristic to search for feasible solutions by moving items out of overfilled bins in parallel. 
+/// 
+/// Each round visits the bins with negative slackness from the most overfilled one, 
+/// and takes the bins reachable by the items in a bin as its neighborhood. 
+/// A bin whose neighborhood overlaps one taken in the same round waits for the next round, 
+/// so the neighborhoods of a round share no bins or items and threads repair them without locks. 
+/// A neighborhood is repaired greedily several times, moving items in the order of move cost per capacity 
+/// to the cheapest candidate bins with enough room; the first order is exact and the others are perturbed by seeds. 
+/// The moves leaving the least violation at the lowest cost are kept. 
+/// Rounds repeat until all bins fit or a round moves nothing. 
+/// Unlike @ref limbo::solvers::SearchByAdjustCoefficient, no more lagrangian iterations are run. 
+/// @tparam T coefficient value type 
+/// @tparam V variable value type 
+template <typename T, typename V>
+class SearchByParallelReassignment : public FeasibleSearcher<T, V>
+{
+    public:
+        /// @brief base type 
+        typedef FeasibleSearcher<T, V> base_type; 
+        /// @brief model type 
+        typedef typename base_type::model_type model_type; 
+        /// @brief solver type 
+        typedef typename base_type::solver_type solver_type; 
+        /// @brief updater type for lagrangian multipliers 
+        typedef typename solver_type::updater_type updater_type;
+        /// @brief coefficient value type 
+        typedef typename model_type::coefficient_value_type coefficient_value_type; 
+        /// @brief variable value type 
+        typedef typename model_type::variable_value_type variable_value_type; 
+        /// @brief variable type 
+        typedef typename model_type::variable_type variable_type; 
+        /// @brief term type 
+        typedef typename model_type::term_type term_type; 
+        /// @brief matrix type 
+        typedef typename solver_type::matrix_type matrix_type;
+
+        /// @brief constructor 
+        /// @param solver problem solver 
+        /// @param numSeeds number of greedy orders tried for each neighborhood 
+        /// @param maxRounds maximum number of rounds 
+        SearchByParallelReassignment(solver_type* solver, unsigned int numSeeds = 4, unsigned int maxRounds = 64) 
+            : base_type(solver)
+            , m_numSeeds(std::max(numSeeds, 1U))
+            , m_maxRounds(maxRounds)
+        {
+        }
+        /// @brief destructor 
+        ~SearchByParallelReassignment() {}
+
+        /// @brief API to search for feasible solutions 
+        /// 
+        /// param updater updater for lagrangian multipliers, not used 
+        /// @return @ref limbo::solvers::SolverProperty SUBOPTIMAL if all bins fit, otherwise INFEASIBLE 
+        virtual SolverProperty operator()(updater_type* /*updater*/)
+        {
+            unsigned int numRows = this->m_constrMatrix.numRows; 
+            this->computeSlackness(); 
+            this->transposeConstraints(m_vColumnBegin, m_vColumnRow, m_vColumnElement); 
+            this->groupVariables(m_vVariable2Group); 
+            m_vCost.assign(this->m_model->numVariables(), 0); 
+            for (typename std::vector<term_type>::const_iterator it = this->m_model->objective().terms().begin(), ite = this->m_model->objective().terms().end(); it != ite; ++it)
+                m_vCost[it->variable().id()] += it->coefficient(); 
+            m_vRowOwner.assign(numRows, std::numeric_limits<unsigned int>::max()); 
+            m_vRowLocal.resize(numRows); 
+
+            std::vector<std::pair<coefficient_value_type, unsigned int> > vOverfilled; 
+            std::vector<Neighborhood> vNeighborhood; 
+            for (unsigned int round = 0; round < m_maxRounds; ++round)
+            {
+                vOverfilled.clear(); 
+                for (unsigned int i = 0; i < numRows; ++i)
+                    if (this->m_vSlackness[i] < 0)
+                        vOverfilled.push_back(std::make_pair(this->m_vSlackness[i], i)); 
+                if (vOverfilled.empty())
+                    return SUBOPTIMAL; 
+                std::sort(vOverfilled.begin(), vOverfilled.end()); 
+
+                // disjoint neighborhoods, from the most overfilled bin 
+                vNeighborhood.clear(); 
+                for (unsigned int i = 0; i < vOverfilled.size(); ++i)
+                {
+                    vNeighborhood.push_back(Neighborhood()); 
+                    if (!claim(vOverfilled[i].second, vNeighborhood.back(), vNeighborhood.size()-1))
+                        vNeighborhood.pop_back(); 
+                }
+
+                RepairPass pass; 
+                pass.searcher = this; 
+                pass.vNeighborhood = &vNeighborhood; 
+                pass.numMoves = 0; 
+                limbo::containers::parallel_for(0, vNeighborhood.size(), 1, std::max(this->m_numThreads, 1U), pass); 
+
+                for (typename std::vector<Neighborhood>::const_iterator it = vNeighborhood.begin(), ite = vNeighborhood.end(); it != ite; ++it)
+                    for (std::vector<unsigned int>::const_iterator itr = it->vRow.begin(), itre = it->vRow.end(); itr != itre; ++itr)
+                        m_vRowOwner[*itr] = std::numeric_limits<unsigned int>::max(); 
+                if (pass.numMoves == 0)
+                    break; 
+            }
+            for (unsigned int i = 0; i < numRows; ++i)
+                if (this->m_vSlackness[i] < 0)
+                    return INFEASIBLE; 
+            return SUBOPTIMAL; 
+        }
+    protected:
+        /// @brief an item moving between two variables of its group 
+        struct Move
+        {
+            unsigned int from; ///< variable selected before 
+            unsigned int to; ///< variable selected after 
+        };
+        /// @brief bins around an overfilled bin, repaired by one thread 
+        struct Neighborhood
+        {
+            unsigned int bin; ///< overfilled bin 
+            std::vector<unsigned int> vRow; ///< bins reachable by the items in the overfilled bin, including itself 
+            std::vector<unsigned int> vItem; ///< selected variables of the items in the overfilled bin 
+            std::vector<Move> vMove; ///< moves found by the best order 
+        };
+        /// @brief state shared by threads repairing neighborhoods 
+        struct RepairPass
+        {
+            SearchByParallelReassignment* searcher; ///< the searcher 
+            std::vector<Neighborhood>* vNeighborhood; ///< neighborhoods of the round 
+            mutable unsigned int numMoves; ///< total number of moves, added atomically 
+
+            /// @brief repair neighborhoods [b, e) 
+            void operator()(std::size_t b, std::size_t e) const {searcher->repairNeighborhoods(*this, b, e);}
+        };
+
+        /// @brief collect the neighborhood of an overfilled bin and mark its bins, unless they overlap a marked one 
+        /// @param bin overfilled bin 
+        /// @param nbhd neighborhood to fill 
+        /// @param id index of the neighborhood in the round 
+        /// @return false if the neighborhood overlaps another one 
+        bool claim(unsigned int bin, Neighborhood& nbhd, unsigned int id)
+        {
+            unsigned int none = std::numeric_limits<unsigned int>::max(); 
+            nbhd.bin = bin; 
+            for (typename matrix_type::index_type k = this->m_constrMatrix.vRowBeginIndex[bin]-matrix_type::s_startingIndex, 
+                    ke = this->m_constrMatrix.vRowBeginIndex[bin+1]-matrix_type::s_startingIndex; k < ke; ++k)
+            {
+                unsigned int j = this->m_constrMatrix.vColumn[k]-matrix_type::s_startingIndex; 
+                if (this->m_model->variableSolutions()[j] != 0 && this->m_constrMatrix.vElement[k] > 0 && m_vVariable2Group[j] != none)
+                    nbhd.vItem.push_back(j); 
+            }
+            // check all bins first, so nothing is marked for a conflict 
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (std::vector<unsigned int>::const_iterator it = nbhd.vItem.begin(), ite = nbhd.vItem.end(); it != ite; ++it)
+                {
+                    unsigned int g = m_vVariable2Group[*it]; 
+                    for (unsigned int v = this->m_vVariableGroupBeginIndex[g]; v < this->m_vVariableGroupBeginIndex[g+1]; ++v)
+                    {
+                        unsigned int j = this->m_vGroupedVariable[v].id(); 
+                        for (unsigned int k = m_vColumnBegin[j]; k < m_vColumnBegin[j+1]; ++k)
+                        {
+                            unsigned int row = m_vColumnRow[k]; 
+                            if (pass == 0 && m_vRowOwner[row] != none)
+                                return false; 
+                            if (pass == 1 && m_vRowOwner[row] != id)
+                            {
+                                m_vRowOwner[row] = id; 
+                                m_vRowLocal[row] = nbhd.vRow.size(); 
+                                nbhd.vRow.push_back(row); 
+                            }
+                        }
+                    }
+                }
+            }
+            return !nbhd.vRow.empty(); 
+        }
+        /// @brief repair a block of neighborhoods 
+        /// @param pass shared state 
+        /// @param b first neighborhood 
+        /// @param e end neighborhood 
+        void repairNeighborhoods(RepairPass const& pass, std::size_t b, std::size_t e)
+        {
+            std::vector<coefficient_value_type> vSlack; 
+            std::vector<Move> vMove; 
+            std::vector<std::pair<coefficient_value_type, unsigned int> > vOrder; 
+            for (std::size_t n = b; n < e; ++n)
+            {
+                Neighborhood& nbhd = (*pass.vNeighborhood)[n]; 
+                coefficient_value_type bestViolation = -std::numeric_limits<coefficient_value_type>::max(); 
+                coefficient_value_type bestCost = std::numeric_limits<coefficient_value_type>::max(); 
+                for (unsigned int seed = 0; seed < m_numSeeds; ++seed)
+                {
+                    coefficient_value_type cost = 0; 
+                    coefficient_value_type violation = greedy(nbhd, seed, vSlack, vMove, vOrder, cost); 
+                    if (violation > bestViolation || (violation == bestViolation && cost < bestCost))
+                    {
+                        bestViolation = violation; 
+                        bestCost = cost; 
+                        nbhd.vMove = vMove; 
+                    }
+                }
+                // bins and items of the neighborhood belong to this thread 
+                for (typename std::vector<Move>::const_iterator it = nbhd.vMove.begin(), ite = nbhd.vMove.end(); it != ite; ++it)
+                {
+                    this->m_model->variableSolutions()[it->from] = 0; 
+                    this->m_model->variableSolutions()[it->to] = 1; 
+                    for (unsigned int k = m_vColumnBegin[it->from]; k < m_vColumnBegin[it->from+1]; ++k)
+                        this->m_vSlackness[m_vColumnRow[k]] += m_vColumnElement[k]; 
+                    for (unsigned int k = m_vColumnBegin[it->to]; k < m_vColumnBegin[it->to+1]; ++k)
+                        this->m_vSlackness[m_vColumnRow[k]] -= m_vColumnElement[k]; 
+                }
+                __sync_fetch_and_add(&pass.numMoves, (unsigned int)nbhd.vMove.size()); 
+            }
+        }
+        /// @brief move items out of the overfilled bin of a neighborhood in one order 
+        /// @param nbhd neighborhood 
+        /// @param seed 0 for the order of move cost per capacity, otherwise a seed to perturb it 
+        /// @param vSlack slackness of the bins in the neighborhood, temporary storage 
+        /// @param vMove moves 
+        /// @param vOrder keys and items in order, temporary storage 
+        /// @param cost increase of objective by the moves 
+        /// @return total negative slackness of the bins in the neighborhood after the moves 
+        coefficient_value_type greedy(Neighborhood const& nbhd, unsigned int seed, std::vector<coefficient_value_type>& vSlack, 
+                std::vector<Move>& vMove, std::vector<std::pair<coefficient_value_type, unsigned int> >& vOrder, coefficient_value_type& cost) const 
+        {
+            vSlack.resize(nbhd.vRow.size()); 
+            for (unsigned int l = 0; l < nbhd.vRow.size(); ++l)
+                vSlack[l] = this->m_vSlackness[nbhd.vRow[l]]; 
+            vMove.clear(); 
+            cost = 0; 
+
+            // cheapest move per capacity first, like @ref limbo::solvers::SearchByAdjustCoefficient 
+            unsigned int random = (seed+1)*2654435761U^nbhd.bin; 
+            vOrder.clear(); 
+            for (unsigned int i = 0; i < nbhd.vItem.size(); ++i)
+            {
+                unsigned int j = nbhd.vItem[i]; 
+                unsigned int g = m_vVariable2Group[j]; 
+                coefficient_value_type moveCost = std::numeric_limits<coefficient_value_type>::max(); 
+                for (unsigned int v = this->m_vVariableGroupBeginIndex[g]; v < this->m_vVariableGroupBeginIndex[g+1]; ++v)
+                    if (this->m_vGroupedVariable[v].id() != j)
+                        moveCost = std::min(moveCost, m_vCost[this->m_vGroupedVariable[v].id()]-m_vCost[j]); 
+                coefficient_value_type capacity = 0; 
+                for (unsigned int k = m_vColumnBegin[j]; k < m_vColumnBegin[j+1]; ++k)
+                    if (m_vColumnRow[k] == nbhd.bin)
+                        capacity = m_vColumnElement[k]; 
+                coefficient_value_type key = moveCost/(1+capacity); 
+                if (seed)
+                {
+                    random = random*1103515245U+12345U; 
+                    key = (moveCost == std::numeric_limits<coefficient_value_type>::max())? moveCost : key+std::abs(key)*((random>>16)%1024)/1024; 
+                }
+                vOrder.push_back(std::make_pair(key, j)); 
+            }
+            std::sort(vOrder.begin(), vOrder.end()); 
+
+            coefficient_value_type& binSlack = vSlack[m_vRowLocal[nbhd.bin]]; 
+            for (unsigned int i = 0; i < vOrder.size() && binSlack < 0; ++i)
+            {
+                unsigned int j = vOrder[i].second; 
+                for (unsigned int k = m_vColumnBegin[j]; k < m_vColumnBegin[j+1]; ++k)
+                    vSlack[m_vRowLocal[m_vColumnRow[k]]] += m_vColumnElement[k]; 
+                // the cheapest candidate with enough room in all its bins 
+                unsigned int g = m_vVariable2Group[j]; 
+                unsigned int target = j; 
+                for (unsigned int v = this->m_vVariableGroupBeginIndex[g]; v < this->m_vVariableGroupBeginIndex[g+1]; ++v)
+                {
+                    unsigned int t = this->m_vGroupedVariable[v].id(); 
+                    if (t == j || (target != j && m_vCost[t] >= m_vCost[target]))
+                        continue; 
+                    bool fit = true; 
+                    for (unsigned int k = m_vColumnBegin[t]; k < m_vColumnBegin[t+1] && fit; ++k)
+                        fit = (vSlack[m_vRowLocal[m_vColumnRow[k]]] >= m_vColumnElement[k]); 
+                    if (fit)
+                        target = t; 
+                }
+                for (unsigned int k = m_vColumnBegin[target]; k < m_vColumnBegin[target+1]; ++k)
+                    vSlack[m_vRowLocal[m_vColumnRow[k]]] -= m_vColumnElement[k]; 
+                if (target != j)
+                {
+                    Move move; 
+                    move.from = j; 
+                    move.to = target; 
+                    vMove.push_back(move); 
+                    cost += m_vCost[target]-m_vCost[j]; 
+                }
+            }
+            coefficient_value_type violation = 0; 
+            for (unsigned int l = 0; l < vSlack.size(); ++l)
+                violation += std::min(vSlack[l], (coefficient_value_type)0); 
+            return violation; 
+        }
+
+        unsigned int m_numSeeds; ///< number of greedy orders tried for each neighborhood 
+        unsigned int m_maxRounds; ///< maximum number of rounds 
+        std::vector<unsigned int> m_vColumnBegin; ///< first element of each variable in capacity constraints, with one more entry for the end 
+        std::vector<unsigned int> m_vColumnRow; ///< capacity constraint of each element 
+        std::vector<coefficient_value_type> m_vColumnElement; ///< coefficient of each element 
+        std::vector<unsigned int> m_vVariable2Group; ///< group of each variable 
+        std::vector<coefficient_value_type> m_vCost; ///< coefficient of each variable in the objective 
+        std::vector<unsigned int> m_vRowOwner; ///< neighborhood of each bin in the current round, maximum value if none 
+        std::vector<unsigned int> m_vRowLocal; ///< position of each bin in its neighborhood 
+};
+
 /// @brief Heuristic to search for feasible solutions by combined strategies. 
 /// @tparam T coefficient value type 
 /// @tparam V variable value type 
@@ -7,6 +7,10 @@
 #ifndef LIMBO_SOLVERS_NUMERICAL_H
 #define LIMBO_SOLVERS_NUMERICAL_H
 
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
+#include <limbo/containers/TaskPool.h>
 #include <limbo/solvers/Solvers.h>
 #if MKL == 1
 #include <mkl.h>
@@ -19,6 +23,27 @@ namespace limbo
 namespace solvers 
 {
 
+/// number of operations of a block in parallel kernels without MKL, a thread gets at least 4 blocks 
+#ifndef NUMERICAL_BLOCK_WORK
+#define NUMERICAL_BLOCK_WORK 8192
+#endif
+
+/// @brief type to accumulate sums of a data type. 
+/// Sums of float are accumulated in double, so float matrices and vectors halve the memory traffic 
+/// without losing precision in long rows and reductions; the accumulators only live in registers. 
+/// @tparam T data type 
+template <typename T>
+struct NumericalAccumulator
+{
+    typedef T type; ///< accumulator type 
+};
+/// @brief float is accumulated in double 
+template <>
+struct NumericalAccumulator<float>
+{
+    typedef double type; ///< accumulator type 
+};
+
 #if MKL == 1
 /// @brief \f$ y = a \cdot x+y \f$ 
 /// @tparam T data type 
@@ -166,8 +191,319 @@ inline void mklcopy(unsigned int n, double const* x, double* y)
 {
     cblas_dcopy(n, x, 1, y, 1);
 }
+
+/// @cond
+/// @brief MKL vector kernels for data types it supports, 
+/// other types such as mixed precision return false and fall back to the native kernels 
+template <typename T, typename V>
+struct MklVectorKernel
+{
+    static bool axpy(unsigned int, T, V const*, T*) {return false;}
+    static bool dot(unsigned int, T const*, T const*, T&) {return false;}
+    static bool copy(unsigned int, T const*, T*) {return false;}
+};
+/// @brief MKL vector kernels for T 
+template <typename T>
+struct MklUniformVectorKernel
+{
+    static bool axpy(unsigned int n, T a, T const* x, T* y) {mklaxpy(n, a, x, y); return true;}
+    static bool dot(unsigned int n, T const* x, T const* y, T& result) {result = mkldot(n, x, y); return true;}
+    static bool copy(unsigned int n, T const* x, T* y) {mklcopy(n, x, y); return true;}
+};
+template <>
+struct MklVectorKernel<float, float> : public MklUniformVectorKernel<float> {};
+template <>
+struct MklVectorKernel<double, double> : public MklUniformVectorKernel<double> {};
+
+/// @brief MKL sparse kernels for data types it supports, i.e., one-based int indices with the same value types 
+template <typename T, typename V, typename MatrixType>
+struct MklMatrixKernel
+{
+    static bool AxPlusy(T, MatrixType const&, V const*, T*) {return false;}
+    static bool ATxPlusy(T, MatrixType const&, V const*, T*) {return false;}
+};
+/// @brief MKL sparse kernels for T 
+template <typename T>
+struct MklUniformMatrixKernel
+{
+    static bool AxPlusy(T a, MatrixCSR<T, int, 1> const& A, T const* x, T* y) {mklAxPlusy(a, A, x, (T)1, y); return true;}
+    static bool ATxPlusy(T a, MatrixCSR<T, int, 1> const& A, T const* x, T* y) {mklATxPlusy(a, A, x, (T)1, y); return true;}
+};
+template <>
+struct MklMatrixKernel<float, float, MatrixCSR<float, int, 1> > : public MklUniformMatrixKernel<float> {};
+template <>
+struct MklMatrixKernel<double, double, MatrixCSR<double, int, 1> > : public MklUniformMatrixKernel<double> {};
+/// @endcond
 #endif
 
+/// @brief a team of threads kept alive across parallel kernels.
+/// Iterative solvers run several short kernels in each iteration for thousands of iterations,
+/// e.g., the argmin of groups, \f$b-Ax\f$ and the multiplier updates of @ref limbo::solvers::MultiKnapsackLagRelax.
+/// Creating and joining threads for each kernel costs tens of microseconds per thread,
+/// while the sleeping workers of a @ref limbo::containers::TaskPool are only woken up.
+///
+/// Kernels started by a thread inside a @ref NumericalTeam::Scope run on the workers of the team and the thread itself,
+/// on no more threads than the kernel asks for, pulling the same blocks as new threads would, so results do not change.
+/// The team is no larger than @ref limbo::containers::num_threads.
+///
+/// Usage:
+/// ~~~~~~~~~~~~~~~~
+/// NumericalTeam team (numThreads);
+/// NumericalTeam::Scope scope (&team);
+/// for (unsigned int iter = 0; iter < maxIters; ++iter)
+///     axpy(n, a, x, y, numThreads); // no threads created
+/// ~~~~~~~~~~~~~~~~
+class NumericalTeam
+{
+    public:
+        /// @brief make the team current for the calling thread until the scope ends
+        class Scope
+        {
+            public:
+                /// @brief constructor
+                /// @param team team, NULL to create threads for each kernel
+                explicit Scope(NumericalTeam* team) : m_prev(NumericalTeam::current()) {NumericalTeam::setCurrent(team);}
+                /// @brief destructor, restore the previous team
+                ~Scope() {NumericalTeam::setCurrent(m_prev);}
+            protected:
+                NumericalTeam* m_prev; ///< team of the enclosing scope
+        };
+
+        /// @brief constructor, start the workers
+        /// @param numThreads number of threads including the calling thread
+        explicit NumericalTeam(unsigned int numThreads)
+        {
+            numThreads = std::min(numThreads, limbo::containers::num_threads());
+            // the calling thread is a member as well
+            m_pool = (numThreads > 1)? new limbo::containers::TaskPool (numThreads-1) : NULL;
+        }
+        /// @brief destructor, stop the workers
+        ~NumericalTeam()
+        {
+            delete m_pool;
+        }
+
+        /// @return number of threads including the calling thread
+        unsigned int size() const {return (m_pool? m_pool->size() : 0)+1;}
+        /// @brief call body(i, j) for blocks [i, j) covering [first, last) on the team, and wait for all blocks
+        /// @tparam Body function object with operator()(std::size_t, std::size_t) const
+        /// @param first first index
+        /// @param last end index
+        /// @param grain number of indices of a block, at least 1
+        /// @param numThreads maximum number of threads including the calling thread
+        /// @param body function object
+        template <typename Body>
+        void parallel_for(std::size_t first, std::size_t last, std::size_t grain, unsigned int numThreads, Body const& body)
+        {
+            if (m_pool)
+                m_pool->parallel_for(first, last, grain, numThreads, body);
+            else
+                limbo::containers::ParallelBlocks<Body>(first, last, grain, body).run();
+        }
+        /// @return team of the calling thread, NULL if it is not in a @ref Scope
+        static NumericalTeam* current()
+        {
+            static pthread_once_t once = PTHREAD_ONCE_INIT;
+            pthread_once(&once, NumericalTeam::createKey);
+            return static_cast<NumericalTeam*>(pthread_getspecific(key()));
+        }
+
+    protected:
+        /// @brief set team of the calling thread
+        /// @param team team
+        static void setCurrent(NumericalTeam* team)
+        {
+            current();
+            pthread_setspecific(key(), team);
+        }
+        /// @return key of the team of each thread
+        static pthread_key_t& key()
+        {
+            static pthread_key_t k;
+            return k;
+        }
+        /// @brief create the key
+        static void createKey()
+        {
+            pthread_key_create(&key(), NULL);
+        }
+
+        limbo::containers::TaskPool* m_pool; ///< workers, NULL for a team of the calling thread only
+
+    private:
+        /// @brief copy is not allowed
+        NumericalTeam(NumericalTeam const&);
+        /// @brief assignment is not allowed
+        NumericalTeam& operator=(NumericalTeam const&);
+};
+
+/// @cond
+/// @brief run a kernel on blocks of items with threads 
+/// @param kernel kernel 
+/// @param size number of items 
+/// @param blockSize number of items in a block 
+/// @param numThreads number of threads, limited by the number of blocks;
+/// the workers of the @ref NumericalTeam of the calling thread are used instead of new threads if there is one
+template <typename Kernel>
+inline void runNumericalKernel(Kernel const& kernel, unsigned int size, unsigned int blockSize, unsigned int numThreads)
+{
+    blockSize = std::max(blockSize, 1U); 
+    unsigned int numBlocks = (size+blockSize-1)/blockSize; 
+    numThreads = std::max(std::min(numThreads, numBlocks), 1U); 
+    NumericalTeam* team = (numThreads > 1)? NumericalTeam::current() : NULL;
+    if (team && team->size() > 1)
+        team->parallel_for(0, size, blockSize, numThreads, kernel);
+    else 
+        limbo::containers::parallel_for(0, size, blockSize, numThreads, kernel);
+}
+/// @brief number of threads worth using for a kernel, a block should have thousands of operations to pay for the threads 
+/// @param numThreads maximum number of threads 
+/// @param work number of operations 
+/// @return number of threads 
+inline unsigned int numericalThreads(unsigned int numThreads, unsigned long work)
+{
+    return std::max(std::min((unsigned long)numThreads, work/(NUMERICAL_BLOCK_WORK*4)), 1UL); 
+}
+
+/// @brief rows [b, e) of \f$ y = a A x + y \f$, 
+/// each row is summed with two accumulators so that the gathers of \a x overlap, 
+/// in @ref NumericalAccumulator of \a T 
+template <typename T, typename V, typename MatrixType>
+struct AxPlusyKernel
+{
+    T a; ///< constant 
+    MatrixType const* A; ///< matrix 
+    V const* x; ///< vector 
+    T* y; ///< output vector 
+
+    /// @brief run rows [b, e) 
+    void operator()(unsigned int b, unsigned int e) const 
+    {
+        typedef typename MatrixType::index_type index_type; 
+        typedef typename NumericalAccumulator<T>::type accumulator_type; 
+        index_type const* vColumn = A->vColumn; 
+        typename MatrixType::value_type const* vElement = A->vElement; 
+        for (; b < e; ++b)
+        {
+            index_type k = A->vRowBeginIndex[b]-MatrixType::s_startingIndex; 
+            index_type ke = A->vRowBeginIndex[b+1]-MatrixType::s_startingIndex; 
+            accumulator_type sum0 = 0; 
+            accumulator_type sum1 = 0; 
+            for (; k+1 < ke; k += 2)
+            {
+#ifdef DEBUG_NUMERICAL
+                limboAssert(vColumn[k]-MatrixType::s_startingIndex < A->numColumns && vColumn[k+1]-MatrixType::s_startingIndex < A->numColumns); 
+#endif
+                sum0 += (accumulator_type)vElement[k]*x[vColumn[k]-MatrixType::s_startingIndex]; 
+                sum1 += (accumulator_type)vElement[k+1]*x[vColumn[k+1]-MatrixType::s_startingIndex]; 
+            }
+            if (k < ke)
+                sum0 += (accumulator_type)vElement[k]*x[vColumn[k]-MatrixType::s_startingIndex]; 
+            y[b] += a*(sum0+sum1); 
+        }
+    }
+};
+/// @brief rows [b, e) of \f$ z = a A^T x \f$ scattered to the buffer of the block, 
+/// blocks are contiguous ranges of rows, one per thread 
+template <typename T, typename V, typename MatrixType>
+struct ATxScatterKernel
+{
+    T a; ///< constant 
+    MatrixType const* A; ///< matrix 
+    V const* x; ///< vector 
+    T* vBuffer; ///< a buffer of A.numColumns for each block 
+    unsigned int blockSize; ///< number of rows in a block 
+
+    /// @brief run rows [b, e) 
+    void operator()(unsigned int b, unsigned int e) const 
+    {
+        typedef typename MatrixType::index_type index_type; 
+        T* z = vBuffer+(unsigned long)(b/blockSize)*A->numColumns; 
+        std::fill(z, z+A->numColumns, (T)0); 
+        for (; b < e; ++b)
+        {
+            T ax = a*x[b]; 
+            for (index_type k = A->vRowBeginIndex[b]-MatrixType::s_startingIndex, ke = A->vRowBeginIndex[b+1]-MatrixType::s_startingIndex; k < ke; ++k)
+                z[A->vColumn[k]-MatrixType::s_startingIndex] += ax*A->vElement[k]; 
+        }
+    }
+};
+/// @brief columns [b, e) of \f$ y = y + \sum z \f$ over the buffers in a fixed order, independent of the schedule 
+template <typename T>
+struct ATxReduceKernel
+{
+    T const* vBuffer; ///< buffers 
+    unsigned int numBuffers; ///< number of buffers 
+    unsigned int size; ///< length of a buffer 
+    T* y; ///< output vector 
+
+    /// @brief run columns [b, e) 
+    void operator()(unsigned int b, unsigned int e) const 
+    {
+        for (unsigned int p = 0; p < numBuffers; ++p)
+        {
+            T const* z = vBuffer+(unsigned long)p*size; 
+            for (unsigned int j = b; j < e; ++j)
+                y[j] += z[j]; 
+        }
+    }
+};
+/// @brief elements [b, e) of \f$ y = a \cdot x+y \f$
+template <typename T, typename V>
+struct AxpyKernel
+{
+    T a; ///< constant 
+    V const* x; ///< vector 
+    T* y; ///< output vector 
+
+    /// @brief run elements [b, e), a plain loop is vectorized by compilers 
+    void operator()(unsigned int b, unsigned int e) const 
+    {
+        T const aa = a; 
+        V const* xx = x; 
+        T* yy = y; 
+        for (; b < e; ++b)
+            yy[b] += aa*xx[b]; 
+    }
+};
+/// @brief partial dot product of elements [b, e) to the entry of the block 
+template <typename T>
+struct DotKernel
+{
+    typedef typename NumericalAccumulator<T>::type accumulator_type; ///< type of partial sums 
+
+    T const* x; ///< vector 
+    T const* y; ///< vector 
+    accumulator_type* vPartialSum; ///< partial sum of each block 
+    unsigned int blockSize; ///< number of elements in a block 
+
+    /// @brief run elements [b, e) 
+    void operator()(unsigned int b, unsigned int e) const 
+    {
+        vPartialSum[b/blockSize] = sum(b, e); 
+    }
+    /// @brief dot product of elements [b, e), 
+    /// with four accumulators so that additions do not wait for each other and can be vectorized 
+    accumulator_type sum(unsigned int b, unsigned int e) const 
+    {
+        accumulator_type sum0 = 0; 
+        accumulator_type sum1 = 0; 
+        accumulator_type sum2 = 0; 
+        accumulator_type sum3 = 0; 
+        for (; b+3 < e; b += 4)
+        {
+            sum0 += (accumulator_type)x[b]*y[b]; 
+            sum1 += (accumulator_type)x[b+1]*y[b+1]; 
+            sum2 += (accumulator_type)x[b+2]*y[b+2]; 
+            sum3 += (accumulator_type)x[b+3]*y[b+3]; 
+        }
+        for (; b < e; ++b)
+            sum0 += (accumulator_type)x[b]*y[b]; 
+        return (sum0+sum1)+(sum2+sum3); 
+    }
+};
+/// @endcond
+
 /// @brief \f$ y = a \cdot x+y \f$ 
 /// @tparam T data type of \a a, \a y
 /// @tparam V data type of \a x
@@ -175,18 +511,31 @@ inline void mklcopy(unsigned int n, double const* x, double* y)
 /// @param a constant 
 /// @param x vector 
 /// @param y output vector 
+/// @param numThreads maximum number of threads without MKL, only used for long vectors 
 template <typename T, typename V>
-inline void axpy(unsigned int n, T a, V const* x, T* y) 
+inline void axpy(unsigned int n, T a, V const* x, T* y, unsigned int numThreads = 1) 
 {
 #if MKL == 1
-    mklaxpy(n, a, x, y);
-#else 
-    for (unsigned int i = 0; i < n; ++i)
-        y[i] += a*x[i];
+    if (MklVectorKernel<T, V>::axpy(n, a, x, y))
+        return; 
 #endif
+    AxpyKernel<T, V> kernel; 
+    kernel.a = a; 
+    kernel.x = x; 
+    kernel.y = y; 
+    numThreads = numericalThreads(numThreads, n); 
+    if (numThreads > 1)
+        runNumericalKernel(kernel, n, NUMERICAL_BLOCK_WORK, numThreads); 
+    else 
+        kernel(0, n); 
 }
 
 /// @brief \f$ y = a A x + y \f$
+/// 
+/// Without MKL, rows are partitioned into blocks of similar numbers of non-zero elements for threads. 
+/// Each row writes only its own entry of \a y, so the result does not depend on the number of threads. 
+/// MKL only takes float or double with one-based int indices and \a x of the same type; 
+/// mixed precision, e.g., a float matrix with double vectors, runs the native kernel. 
 /// @tparam T data type of \a a, \a y
 /// @tparam V data type of \a x
 /// @tparam MatrixType sparse matrix type in CSR format 
@@ -194,27 +543,32 @@ inline void axpy(unsigned int n, T a, V const* x, T* y)
 /// @param A matrix 
 /// @param x vector 
 /// @param y output vector 
+/// @param numThreads maximum number of threads without MKL, only used for large matrices 
 template <typename T, typename V, typename MatrixType>
-inline void AxPlusy(T a, MatrixType const& A, V const* x, T* y) 
+inline void AxPlusy(T a, MatrixType const& A, V const* x, T* y, unsigned int numThreads = 1) 
 {
     // y = a A x + y
 #if MKL == 1
-    mklAxPlusy(a, A, x, (T)1, y);
-#else 
-    for (typename MatrixType::index_type i = 0; i < A.numRows; ++i)
-    {
-        for (typename MatrixType::index_type k = A.vRowBeginIndex[i]; k < A.vRowBeginIndex[i+1]; ++k)
-        {
-            typename MatrixType::index_type kk = k-MatrixType::s_startingIndex;
-#ifdef DEBUG_NUMERICAL
-            limboAssert(A.vColumn[kk]-MatrixType::s_startingIndex < A.numColumns && kk < A.numElements); 
-#endif
-            y[i] += a*A.vElement[kk]*x[A.vColumn[kk]-MatrixType::s_startingIndex];
-        }
-    }
+    if (MklMatrixKernel<T, V, MatrixType>::AxPlusy(a, A, x, y))
+        return; 
 #endif
+    AxPlusyKernel<T, V, MatrixType> kernel; 
+    kernel.a = a; 
+    kernel.A = &A; 
+    kernel.x = x; 
+    kernel.y = y; 
+    numThreads = numericalThreads(numThreads, A.numElements); 
+    if (numThreads > 1)
+        runNumericalKernel(kernel, A.numRows, (unsigned long)A.numRows*NUMERICAL_BLOCK_WORK/A.numElements, numThreads); 
+    else 
+        kernel(0, A.numRows); 
 }
 /// @brief \f$ y = a A^T x + y \f$
+/// 
+/// Without MKL, each thread scatters a contiguous range of rows to its own buffer of \a y, 
+/// then the buffers are summed by columns. 
+/// The result depends on the number of threads only by the order of floating point additions. 
+/// If \f$A^T\f$ is available in CSR format, @ref AxPlusy on it avoids the buffers. 
 /// @tparam T data type of \a a, \a y
 /// @tparam V data type of \a x
 /// @tparam MatrixType sparse matrix type in CSR format 
@@ -222,42 +576,84 @@ inline void AxPlusy(T a, MatrixType const& A, V const* x, T* y)
 /// @param A matrix 
 /// @param x vector 
 /// @param y output vector 
+/// @param numThreads maximum number of threads without MKL, only used for large matrices 
 template <typename T, typename V, typename MatrixType>
-inline void ATxPlusy(T a, MatrixType const& A, V const* x, T* y) 
+inline void ATxPlusy(T a, MatrixType const& A, V const* x, T* y, unsigned int numThreads = 1) 
 {
     // y = a A^T x + y
 #if MKL == 1
-    mklATxPlusy(a, A, x, (T)1, y);
-#else 
+    if (MklMatrixKernel<T, V, MatrixType>::ATxPlusy(a, A, x, y))
+        return; 
+#endif
+    // buffers cost as much as the columns, so they need more elements per column 
+    numThreads = std::min(numericalThreads(numThreads, A.numElements), (unsigned int)(A.numElements/(2*A.numColumns+1))); 
+    if (numThreads > 1)
+    {
+        std::vector<T> vBuffer ((unsigned long)numThreads*A.numColumns); 
+        ATxScatterKernel<T, V, MatrixType> scatter; 
+        scatter.a = a; 
+        scatter.A = &A; 
+        scatter.x = x; 
+        scatter.vBuffer = &vBuffer[0]; 
+        scatter.blockSize = (A.numRows+numThreads-1)/numThreads; 
+        runNumericalKernel(scatter, A.numRows, scatter.blockSize, numThreads); 
+        ATxReduceKernel<T> reduce; 
+        reduce.vBuffer = &vBuffer[0]; 
+        reduce.numBuffers = (A.numRows+scatter.blockSize-1)/scatter.blockSize; 
+        reduce.size = A.numColumns; 
+        reduce.y = y; 
+        runNumericalKernel(reduce, A.numColumns, NUMERICAL_BLOCK_WORK, numThreads); 
+        return; 
+    }
     for (typename MatrixType::index_type i = 0; i < A.numRows; ++i)
     {
+        T ax = a*x[i]; 
         for (typename MatrixType::index_type k = A.vRowBeginIndex[i]; k < A.vRowBeginIndex[i+1]; ++k)
         {
             typename MatrixType::index_type kk = k-MatrixType::s_startingIndex;
 #ifdef DEBUG_NUMERICAL
             limboAssert(A.vColumn[kk]-MatrixType::s_startingIndex < A.numColumns && kk < A.numElements); 
 #endif
-            y[A.vColumn[kk]-MatrixType::s_startingIndex] += a*A.vElement[kk]*x[i];
+            y[A.vColumn[kk]-MatrixType::s_startingIndex] += ax*A.vElement[kk];
         }
     }
-#endif
 }
 /// @brief compute dot product \f$ x^T y \f$
+/// 
+/// Without MKL, partial sums of fixed blocks are added in order, 
+/// so the result does not depend on the number of threads. 
+/// Partial sums are kept in @ref NumericalAccumulator of \a T. 
 /// @tparam T data type 
 /// @param n dimension 
 /// @param x vector 
 /// @param y vector 
+/// @param numThreads maximum number of threads without MKL, only used for long vectors 
 /// @return dot product 
 template <typename T>
-inline T dot(unsigned int n, T const* x, T const* y) 
+inline T dot(unsigned int n, T const* x, T const* y, unsigned int numThreads = 1) 
 {
-    T result = 0; 
 #if MKL == 1
-    result = mkldot(n, x, y);
-#else 
-    for (unsigned int i = 0; i < n; ++i)
-        result += x[i]*y[i];
-#endif 
+    T mklResult = 0; 
+    if (MklVectorKernel<T, T>::dot(n, x, y, mklResult))
+        return mklResult; 
+#endif
+    DotKernel<T> kernel; 
+    kernel.x = x; 
+    kernel.y = y; 
+    kernel.blockSize = NUMERICAL_BLOCK_WORK; 
+    std::vector<typename DotKernel<T>::accumulator_type> vPartialSum ((n+kernel.blockSize-1)/kernel.blockSize); 
+    kernel.vPartialSum = vPartialSum.empty()? NULL : &vPartialSum[0]; 
+    numThreads = numericalThreads(numThreads, n); 
+    if (numThreads > 1)
+        runNumericalKernel(kernel, n, kernel.blockSize, numThreads); 
+    else 
+    {
+        for (unsigned int b = 0; b < n; b += kernel.blockSize)
+            kernel(b, std::min(b+kernel.blockSize, n)); 
+    }
+    typename DotKernel<T>::accumulator_type result = 0; 
+    for (typename std::vector<typename DotKernel<T>::accumulator_type>::const_iterator it = vPartialSum.begin(), ite = vPartialSum.end(); it != ite; ++it)
+        result += *it; 
     return result; 
 }
 /// @brief copy vector 
@@ -270,10 +666,10 @@ inline void vcopy(unsigned int n, T const* x, T* y)
 {
     // y = x 
 #if MKL == 1
-    mklcopy(n, x, y);
-#else 
-    std::copy(x, x+n, y); 
+    if (MklVectorKernel<T, T>::copy(n, x, y))
+        return; 
 #endif
+    std::copy(x, x+n, y); 
 }
 
 } // namespace solvers 
@@ -0,0 +1,259 @@
+/**
+ * @file   PotentialRecovery.h
+ * @brief  Recover optimal node potentials of a min-cost flow from its optimal flow
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_POTENTIALRECOVERY_H
+#define LIMBO_SOLVERS_POTENTIALRECOVERY_H
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <lemon/core.h>
+#include <limbo/math/Math.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @brief Compute node potentials, i.e., the dual solution, of a min-cost flow problem from an optimal flow.
+///
+/// Potentials \f$\pi\f$ are optimal if every arc of the residual network has a non-negative reduced cost
+/// \f$c_{ij} + \pi_i - \pi_j\f$, the same convention as lemon::NetworkSimplex.
+/// They are the shortest path distances in the residual network from a virtual root connected to all nodes with zero costs.
+///
+/// The residual network is built into compressed sparse rows with reduced costs of the initial potentials,
+/// and the distances are computed by the Goldberg-Radzik variant of Bellman-Ford, starting only from the nodes
+/// with negative outgoing reduced costs.
+/// With potentials close to optimal, e.g., those of a solver, few nodes are visited;
+/// without initial potentials, it is a plain shortest path computation.
+/// The arrays are kept between runs, so repeated recovery on graphs of similar sizes does not allocate.
+///
+/// Lower bounds of arcs are 0. Node and arc ids of the graph must be contiguous, e.g., lemon::SmartDigraph.
+///
+/// @tparam GR digraph type
+/// @tparam V value type of flows and costs
+template <typename GR, typename V>
+class PotentialRecovery
+{
+    public:
+        /// @nowarn
+        typedef GR graph_type;
+        typedef V value_type;
+        typedef typename graph_type::Node node_type;
+        typedef typename graph_type::NodeIt node_iterator;
+        typedef typename graph_type::ArcIt arc_iterator;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param g graph, kept by reference
+        explicit PotentialRecovery(graph_type const& g)
+            : m_graph(g)
+            , m_numRelaxed(0)
+        {
+        }
+
+        /// @brief compute potentials from a flow
+        /// @param upper arc map of upper bounds
+        /// @param cost arc map of costs
+        /// @param flow arc map of an optimal flow
+        /// @param potential node map of potentials, read as initial potentials if \a warmStart is true, and written with the result
+        /// @param warmStart true to start from the potentials in \a potential, false to start from zero potentials
+        /// @return false if the residual network has a negative cycle, i.e., the flow is not optimal; \a potential is then unchanged
+        template <typename UpperMap, typename CostMap, typename FlowMap, typename PotentialMap>
+        bool run(UpperMap const& upper, CostMap const& cost, FlowMap const& flow, PotentialMap& potential, bool warmStart = true)
+        {
+            int numNodes = m_graph.maxNodeId()+1;
+            m_vPotential.assign(numNodes, 0);
+            if (warmStart)
+                for (node_iterator v (m_graph); v != lemon::INVALID; ++v)
+                    m_vPotential[m_graph.id(v)] = potential[v];
+            buildResidual(upper, cost, flow);
+            if (!shortestPath())
+                return false;
+
+            // shift potentials to be non-positive like lemon, which only changes them by a constant
+            value_type maxPotential = limbo::lowest<value_type>();
+            for (int i = 0; i < numNodes; ++i)
+            {
+                m_vPotential[i] += m_vDist[i];
+                maxPotential = std::max(maxPotential, m_vPotential[i]);
+            }
+            for (node_iterator v (m_graph); v != lemon::INVALID; ++v)
+                potential.set(v, m_vPotential[m_graph.id(v)]-maxPotential);
+            return true;
+        }
+        /// @return number of relaxed arcs in the last run
+        long numRelaxed() const {return m_numRelaxed;}
+
+    protected:
+        /// @brief states of nodes in a pass
+        enum NodeState
+        {
+            VISITED = 1, ///< in the order of the current pass
+            LABELED = 2 ///< distance decreased after the node is scanned, a source of the next pass
+        };
+
+        /// @brief build the residual network with reduced costs in compressed sparse rows
+        /// @param upper arc map of upper bounds
+        /// @param cost arc map of costs
+        /// @param flow arc map of flows
+        template <typename UpperMap, typename CostMap, typename FlowMap>
+        void buildResidual(UpperMap const& upper, CostMap const& cost, FlowMap const& flow)
+        {
+            int numNodes = m_vPotential.size();
+            // count residual arcs of each node
+            m_vFirstOut.assign(numNodes+1, 0);
+            for (arc_iterator a (m_graph); a != lemon::INVALID; ++a)
+            {
+                value_type f = flow[a];
+                if (f < upper[a])
+                    ++m_vFirstOut[m_graph.id(m_graph.source(a))+1];
+                if (f > 0)
+                    ++m_vFirstOut[m_graph.id(m_graph.target(a))+1];
+            }
+            for (int i = 0; i < numNodes; ++i)
+                m_vFirstOut[i+1] += m_vFirstOut[i];
+            m_vTarget.resize(m_vFirstOut[numNodes]);
+            m_vReducedCost.resize(m_vFirstOut[numNodes]);
+            // fill residual arcs, using the positions in m_vNext as cursors
+            m_vNext.assign(m_vFirstOut.begin(), m_vFirstOut.end()-1);
+            for (arc_iterator a (m_graph); a != lemon::INVALID; ++a)
+            {
+                value_type f = flow[a];
+                int u = m_graph.id(m_graph.source(a));
+                int v = m_graph.id(m_graph.target(a));
+                value_type rc = cost[a]+m_vPotential[u]-m_vPotential[v];
+                if (f < upper[a])
+                {
+                    int k = m_vNext[u]++;
+                    m_vTarget[k] = v;
+                    m_vReducedCost[k] = rc;
+                }
+                if (f > 0)
+                {
+                    int k = m_vNext[v]++;
+                    m_vTarget[k] = u;
+                    m_vReducedCost[k] = -rc;
+                }
+            }
+        }
+        /// @brief shortest path distances from a virtual root with the reduced costs, 
+        /// by the Goldberg-Radzik algorithm 
+        /// 
+        /// Each pass scans the nodes reachable from the nodes labeled in the previous pass 
+        /// through arcs of negative reduced costs, in topological order, so distances along such paths settle in one pass. 
+        /// @return false if there is a negative cycle
+        bool shortestPath()
+        {
+            int numNodes = m_vPotential.size();
+            m_numRelaxed = 0;
+            m_vDist.assign(numNodes, 0);
+            m_vState.assign(numNodes, 0);
+            // nodes with negative outgoing reduced costs start the first pass 
+            m_vSource.clear();
+            for (int i = 0; i < numNodes; ++i)
+            {
+                for (int k = m_vFirstOut[i], ke = m_vFirstOut[i+1]; k < ke; ++k)
+                {
+                    if (m_vReducedCost[k] < 0)
+                    {
+                        m_vSource.push_back(i);
+                        break;
+                    }
+                }
+            }
+            // without negative cycles, a shortest path has less than n arcs and each pass extends the settled paths by at least one arc 
+            for (int pass = 0; !m_vSource.empty(); ++pass)
+            {
+                if (pass > numNodes)
+                    return false;
+                topologicalOrder();
+                // scan in topological order, nodes labeled in this pass are the sources of the next pass 
+                m_vSource.clear();
+                for (int t = m_vOrder.size()-1; t >= 0; --t)
+                {
+                    int u = m_vOrder[t];
+                    m_vState[u] = 0;
+                    value_type du = m_vDist[u];
+                    for (int k = m_vFirstOut[u], ke = m_vFirstOut[u+1]; k < ke; ++k)
+                    {
+                        int v = m_vTarget[k];
+                        value_type dv = du+m_vReducedCost[k];
+                        if (dv < m_vDist[v])
+                        {
+                            ++m_numRelaxed;
+                            m_vDist[v] = dv;
+                            // nodes later in the order are scanned in this pass anyway 
+                            if (m_vState[v] == 0)
+                            {
+                                m_vState[v] = LABELED;
+                                m_vSource.push_back(v);
+                            }
+                        }
+                    }
+                }
+                for (unsigned int i = 0; i < m_vSource.size(); ++i)
+                    m_vState[m_vSource[i]] = 0;
+            }
+            return true;
+        }
+        /// @brief depth-first search from @ref m_vSource through arcs of negative reduced costs, 
+        /// nodes are put to @ref m_vOrder in post order 
+        void topologicalOrder()
+        {
+            m_vOrder.clear();
+            for (unsigned int i = 0; i < m_vSource.size(); ++i)
+            {
+                int s = m_vSource[i];
+                if (m_vState[s] != 0)
+                    continue;
+                m_vState[s] = VISITED;
+                m_vStack.push_back(std::make_pair(s, m_vFirstOut[s]));
+                while (!m_vStack.empty())
+                {
+                    int u = m_vStack.back().first;
+                    int& k = m_vStack.back().second;
+                    value_type du = m_vDist[u];
+                    for (int ke = m_vFirstOut[u+1]; k < ke; ++k)
+                    {
+                        int v = m_vTarget[k];
+                        if (m_vState[v] == 0 && du+m_vReducedCost[k] < m_vDist[v])
+                            break;
+                    }
+                    if (k < m_vFirstOut[u+1])
+                    {
+                        int v = m_vTarget[k++];
+                        m_vState[v] = VISITED;
+                        m_vStack.push_back(std::make_pair(v, m_vFirstOut[v]));
+                    }
+                    else 
+                    {
+                        m_vOrder.push_back(u);
+                        m_vStack.pop_back();
+                    }
+                }
+            }
+        }
+
+        graph_type const& m_graph; ///< graph
+        std::vector<value_type> m_vPotential; ///< initial potentials by node id
+        std::vector<int> m_vFirstOut; ///< first residual arc of each node, with one more entry for the end
+        std::vector<int> m_vTarget; ///< target node of each residual arc
+        std::vector<value_type> m_vReducedCost; ///< reduced cost of each residual arc with the initial potentials
+        std::vector<int> m_vNext; ///< fill cursors when building the residual network
+        std::vector<value_type> m_vDist; ///< shortest path distance of each node
+        std::vector<char> m_vState; ///< 0, @ref VISITED in the order of this pass, or @ref LABELED for the next pass
+        std::vector<int> m_vSource; ///< nodes to start a pass
+        std::vector<int> m_vOrder; ///< nodes of a pass in post order
+        std::vector<std::pair<int, int> > m_vStack; ///< nodes and their next arcs in depth-first search
+        long m_numRelaxed; ///< number of relaxed arcs in the last run
+};
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
@@ -0,0 +1,500 @@
+/**
+ * @file   Presolve.h
+ * @brief  Presolve a @ref limbo::solvers::LinearModel before any solver and map the solutions back
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_PRESOLVE_H
+#define LIMBO_SOLVERS_PRESOLVE_H
+
+#include <cmath>
+#include <map>
+#include <limbo/solvers/Solvers.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @brief Reduce a linear model before it is passed to a solver, and map the solution of the reduced model back.
+///
+/// The reductions are repeated on the affected constraints until nothing changes:
+/// - variables with equal bounds are substituted into constraints and the objective;
+/// - empty constraints are checked and removed;
+/// - singleton constraints become bounds, rounded for integer variables;
+/// - constraints always satisfied within the bounds of their variables are removed;
+/// - constraints only satisfied with all variables at a bound fix the variables, e.g., a sum of binaries at most 0;
+///
+/// then constraints with the same terms up to a scaling factor and the same sense keep the tightest one,
+/// and variables left in no constraint are fixed at the bound preferred by the objective.
+///
+/// The reduced model has the same numeric types, names and initial solutions of the remaining variables,
+/// so it can be solved by any API, e.g., @ref limbo::solvers::GurobiLinearApi or
+/// @ref limbo::solvers::MultiKnapsackLagRelax, like
+/// @code
+/// Presolver<T, V> presolver (&model);
+/// if (!presolver()) ... // infeasible
+/// if (!presolver.solved())
+/// {
+///     GurobiLinearApi<T, V> solver (&presolver.reducedModel());
+///     solver();
+/// }
+/// presolver.postsolve(); // solutions in model
+/// @endcode
+/// The objective of the reduced model carries the contribution of fixed variables as a constant.
+///
+/// @tparam T coefficient value type
+/// @tparam V variable value type
+template <typename T, typename V>
+class Presolver
+{
+    public:
+        /// @brief linear model type for the problem
+        typedef LinearModel<T, V> model_type;
+        /// @nowarn
+        typedef typename model_type::coefficient_value_type coefficient_value_type;
+        typedef typename model_type::variable_value_type variable_value_type;
+        typedef typename model_type::variable_type variable_type;
+        typedef typename model_type::constraint_type constraint_type;
+        typedef typename model_type::expression_type expression_type;
+        typedef typename model_type::term_type term_type;
+        typedef typename model_type::property_type property_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param model pointer to the original model, which is not changed except its solutions by @ref postsolve
+        explicit Presolver(model_type* model);
+
+        /// @brief build the reduced model
+        /// @return false if the model is infeasible
+        bool operator()();
+        /// @return true if all variables are fixed, so the reduced model is empty and @ref postsolve gives the solution
+        bool solved() const {return m_reducedModel.numVariables() == 0;}
+        /// @return reduced model
+        model_type& reducedModel() {return m_reducedModel;}
+        /// @return reduced model
+        model_type const& reducedModel() const {return m_reducedModel;}
+        /// @brief write solutions of the reduced model and values of fixed variables to the original model
+        void postsolve();
+
+        /// @return number of variables fixed
+        unsigned int numFixedVariables() const {return m_numFixedVariables;}
+        /// @return number of constraints removed
+        unsigned int numRemovedConstraints() const {return m_numRemovedConstraints;}
+        /// @return number of bounds tightened by singleton constraints
+        unsigned int numTightenedBounds() const {return m_numTightenedBounds;}
+
+    protected:
+        /// @brief a constraint under reduction
+        struct Row
+        {
+            std::vector<term_type> vTerm; ///< terms of variables not fixed yet
+            char sense; ///< sense, '<', '>' or '='
+            double rhs; ///< right hand side with fixed variables moved
+            bool alive; ///< false if removed
+        };
+
+        /// @brief reduce a constraint
+        /// @param i constraint index
+        /// @return false if infeasible
+        bool presolveRow(unsigned int i);
+        /// @brief tighten a bound of a variable
+        /// @param j variable index
+        /// @param upper true for the upper bound, false for the lower bound
+        /// @param bound new bound
+        /// @return false if the bounds cross
+        bool tightenBound(unsigned int j, bool upper, double bound);
+        /// @brief fix a variable and queue its constraints
+        /// @param j variable index
+        /// @param value value
+        void fixVariable(unsigned int j, variable_value_type value);
+        /// @brief queue the constraints of a variable
+        /// @param j variable index
+        void queueRows(unsigned int j);
+        /// @brief keep the tightest one of the constraints with the same terms and sense
+        /// @return false if infeasible
+        bool removeDuplicateRows();
+        /// @brief fix variables in no constraint
+        void fixEmptyColumns();
+        /// @brief build the reduced model
+        void build();
+        /// @return true if a variable is fixed
+        /// @param j variable index
+        bool fixed(unsigned int j) const {return m_vLowerBound[j] == m_vUpperBound[j];}
+        /// @return true if a lower bound is infinite
+        /// @param v bound
+        static bool infiniteLower(variable_value_type v) {return v <= limbo::lowest<variable_value_type>();}
+        /// @return true if an upper bound is infinite
+        /// @param v bound
+        static bool infiniteUpper(variable_value_type v) {return v >= std::numeric_limits<variable_value_type>::max();}
+
+        model_type* m_model; ///< original model
+        model_type m_reducedModel; ///< reduced model
+        std::vector<Row> m_vRow; ///< constraints under reduction
+        std::vector<variable_value_type> m_vLowerBound; ///< lower bound of each variable
+        std::vector<variable_value_type> m_vUpperBound; ///< upper bound of each variable
+        std::vector<unsigned int> m_vColumnBegin; ///< first constraint of each variable in @ref m_vColumnRow, with one more entry for the end
+        std::vector<unsigned int> m_vColumnRow; ///< constraints of each variable in the original model
+        std::vector<unsigned int> m_vQueue; ///< constraints to reduce
+        std::vector<char> m_vQueued; ///< whether a constraint is in the queue
+        std::vector<int> m_vNewId; ///< variable index in the reduced model, -1 if fixed
+        unsigned int m_numFixedVariables; ///< number of variables fixed
+        unsigned int m_numRemovedConstraints; ///< number of constraints removed
+        unsigned int m_numTightenedBounds; ///< number of bounds tightened
+};
+
+template <typename T, typename V>
+Presolver<T, V>::Presolver(typename Presolver<T, V>::model_type* model)
+    : m_model(model)
+    , m_numFixedVariables(0)
+    , m_numRemovedConstraints(0)
+    , m_numTightenedBounds(0)
+{
+}
+template <typename T, typename V>
+bool Presolver<T, V>::operator()()
+{
+    unsigned int numVariables = m_model->numVariables();
+    unsigned int numConstraints = m_model->constraints().size();
+    m_numFixedVariables = 0;
+    m_numRemovedConstraints = 0;
+    m_numTightenedBounds = 0;
+    m_reducedModel = model_type();
+
+    m_vLowerBound.resize(numVariables);
+    m_vUpperBound.resize(numVariables);
+    for (unsigned int j = 0; j < numVariables; ++j)
+    {
+        m_vLowerBound[j] = m_model->variableProperties()[j].lowerBound();
+        m_vUpperBound[j] = m_model->variableProperties()[j].upperBound();
+        if (m_vLowerBound[j] > m_vUpperBound[j])
+            return false;
+    }
+    m_vRow.resize(numConstraints);
+    m_vColumnBegin.assign(numVariables+1, 0);
+    for (unsigned int i = 0; i < numConstraints; ++i)
+    {
+        constraint_type const& constr = m_model->constraints()[i];
+        Row& row = m_vRow[i];
+        row.vTerm = constr.expression().terms();
+        row.sense = constr.sense();
+        row.rhs = constr.rightHandSide()-constr.expression().constant();
+        row.alive = true;
+        for (typename std::vector<term_type>::const_iterator it = row.vTerm.begin(), ite = row.vTerm.end(); it != ite; ++it)
+            ++m_vColumnBegin[it->variable().id()+1];
+    }
+    for (unsigned int j = 0; j < numVariables; ++j)
+        m_vColumnBegin[j+1] += m_vColumnBegin[j];
+    m_vColumnRow.resize(m_vColumnBegin.back());
+    std::vector<unsigned int> vNext (m_vColumnBegin.begin(), m_vColumnBegin.end()-1);
+    for (unsigned int i = 0; i < numConstraints; ++i)
+        for (typename std::vector<term_type>::const_iterator it = m_vRow[i].vTerm.begin(), ite = m_vRow[i].vTerm.end(); it != ite; ++it)
+            m_vColumnRow[vNext[it->variable().id()]++] = i;
+
+    // all constraints are reduced once, then those of changed variables again
+    m_vQueue.resize(numConstraints);
+    m_vQueued.assign(numConstraints, true);
+    for (unsigned int i = 0; i < numConstraints; ++i)
+        m_vQueue[i] = numConstraints-1-i;
+    while (!m_vQueue.empty())
+    {
+        unsigned int i = m_vQueue.back();
+        m_vQueue.pop_back();
+        m_vQueued[i] = false;
+        if (!presolveRow(i))
+            return false;
+    }
+    if (!removeDuplicateRows())
+        return false;
+    fixEmptyColumns();
+    build();
+    return true;
+}
+template <typename T, typename V>
+bool Presolver<T, V>::presolveRow(unsigned int i)
+{
+    Row& row = m_vRow[i];
+    if (!row.alive)
+        return true;
+    // substitute fixed variables
+    unsigned int n = 0;
+    for (unsigned int k = 0; k < row.vTerm.size(); ++k)
+    {
+        unsigned int j = row.vTerm[k].variable().id();
+        if (fixed(j))
+            row.rhs -= (double)row.vTerm[k].coefficient()*m_vLowerBound[j];
+        else
+            row.vTerm[n++] = row.vTerm[k];
+    }
+    row.vTerm.resize(n);
+    double tol = 1e-9*(1+std::abs(row.rhs));
+
+    if (n == 0)
+    {
+        row.alive = false;
+        ++m_numRemovedConstraints;
+        switch (row.sense)
+        {
+            case '<': return 0 <= row.rhs+tol;
+            case '>': return 0 >= row.rhs-tol;
+            default: return std::abs(row.rhs) <= tol;
+        }
+    }
+    if (n == 1)
+    {
+        // a x <= b, a x >= b or a x = b becomes bounds of x
+        row.alive = false;
+        ++m_numRemovedConstraints;
+        double a = row.vTerm[0].coefficient();
+        unsigned int j = row.vTerm[0].variable().id();
+        double bound = row.rhs/a;
+        bool lessEqual = (row.sense == '=') || ((row.sense == '<') == (a > 0));
+        bool greaterEqual = (row.sense == '=') || !lessEqual;
+        return (!lessEqual || tightenBound(j, true, bound)) && (!greaterEqual || tightenBound(j, false, bound));
+    }
+
+    // activities within bounds, counting infinite contributions separately
+    double minActivity = 0;
+    double maxActivity = 0;
+    unsigned int numMinInfinite = 0;
+    unsigned int numMaxInfinite = 0;
+    for (typename std::vector<term_type>::const_iterator it = row.vTerm.begin(), ite = row.vTerm.end(); it != ite; ++it)
+    {
+        double a = it->coefficient();
+        unsigned int j = it->variable().id();
+        bool lowerInfinite = infiniteLower(m_vLowerBound[j]);
+        bool upperInfinite = infiniteUpper(m_vUpperBound[j]);
+        if (a > 0)
+        {
+            if (lowerInfinite) ++numMinInfinite; else minActivity += a*m_vLowerBound[j];
+            if (upperInfinite) ++numMaxInfinite; else maxActivity += a*m_vUpperBound[j];
+        }
+        else
+        {
+            if (upperInfinite) ++numMinInfinite; else minActivity += a*m_vUpperBound[j];
+            if (lowerInfinite) ++numMaxInfinite; else maxActivity += a*m_vLowerBound[j];
+        }
+    }
+    bool checkLess = (row.sense != '>');
+    bool checkGreater = (row.sense != '<');
+    if ((checkLess && numMinInfinite == 0 && minActivity > row.rhs+tol)
+            || (checkGreater && numMaxInfinite == 0 && maxActivity < row.rhs-tol))
+        return false;
+    // redundant inequality
+    if ((row.sense == '<' && numMaxInfinite == 0 && maxActivity <= row.rhs+tol)
+            || (row.sense == '>' && numMinInfinite == 0 && minActivity >= row.rhs-tol))
+    {
+        row.alive = false;
+        ++m_numRemovedConstraints;
+        return true;
+    }
+    // forcing constraint, only satisfied with all variables at the bounds of the minimum or maximum activity
+    bool forceMin = (checkLess && numMinInfinite == 0 && minActivity >= row.rhs-tol);
+    bool forceMax = (checkGreater && numMaxInfinite == 0 && maxActivity <= row.rhs+tol);
+    if (forceMin || forceMax)
+    {
+        row.alive = false;
+        ++m_numRemovedConstraints;
+        for (typename std::vector<term_type>::const_iterator it = row.vTerm.begin(), ite = row.vTerm.end(); it != ite; ++it)
+        {
+            unsigned int j = it->variable().id();
+            bool atUpper = ((it->coefficient() > 0) == forceMax);
+            fixVariable(j, (atUpper)? m_vUpperBound[j] : m_vLowerBound[j]);
+        }
+    }
+    return true;
+}
+template <typename T, typename V>
+bool Presolver<T, V>::tightenBound(unsigned int j, bool upper, double bound)
+{
+    // integer bounds are rounded inwards with a tolerance
+    if (m_model->variableProperties()[j].numericType() != CONTINUOUS || std::numeric_limits<variable_value_type>::is_integer)
+        bound = (upper)? std::floor(bound+1e-9) : std::ceil(bound-1e-9);
+    if (bound >= (double)std::numeric_limits<variable_value_type>::max() || bound <= (double)limbo::lowest<variable_value_type>())
+        return true;
+    variable_value_type& target = (upper)? m_vUpperBound[j] : m_vLowerBound[j];
+    if ((upper && bound < target) || (!upper && bound > target))
+    {
+        target = (variable_value_type)bound;
+        ++m_numTightenedBounds;
+        double tol = 1e-9*(1+std::abs(bound));
+        if (m_vLowerBound[j] > m_vUpperBound[j]+tol)
+            return false;
+        if (m_vLowerBound[j] >= m_vUpperBound[j]-tol)
+            m_vLowerBound[j] = m_vUpperBound[j] = target;
+        queueRows(j);
+    }
+    return true;
+}
+template <typename T, typename V>
+void Presolver<T, V>::fixVariable(unsigned int j, typename Presolver<T, V>::variable_value_type value)
+{
+    if (fixed(j) && m_vLowerBound[j] == value)
+        return;
+    m_vLowerBound[j] = value;
+    m_vUpperBound[j] = value;
+    queueRows(j);
+}
+template <typename T, typename V>
+void Presolver<T, V>::queueRows(unsigned int j)
+{
+    for (unsigned int k = m_vColumnBegin[j]; k < m_vColumnBegin[j+1]; ++k)
+    {
+        unsigned int i = m_vColumnRow[k];
+        if (m_vRow[i].alive && !m_vQueued[i])
+        {
+            m_vQueued[i] = true;
+            m_vQueue.push_back(i);
+        }
+    }
+}
+template <typename T, typename V>
+bool Presolver<T, V>::removeDuplicateRows()
+{
+    // terms are normalized by the first coefficient, so scaled copies share a key;
+    // a negative factor flips the sense
+    typedef std::vector<std::pair<unsigned int, double> > key_type;
+    std::map<std::pair<key_type, char>, unsigned int> mRow;
+    for (unsigned int i = 0; i < m_vRow.size(); ++i)
+    {
+        // rows are up to date, as fixing or bounding a variable queues its rows
+        Row& row = m_vRow[i];
+        if (!row.alive)
+            continue;
+        double factor = row.vTerm.front().coefficient();
+        std::pair<key_type, char> key;
+        key.first.reserve(row.vTerm.size());
+        for (typename std::vector<term_type>::const_iterator it = row.vTerm.begin(), ite = row.vTerm.end(); it != ite; ++it)
+            key.first.push_back(std::make_pair(it->variable().id(), it->coefficient()/factor));
+        std::sort(key.first.begin(), key.first.end());
+        key.second = (row.sense == '=' || factor > 0)? row.sense : ((row.sense == '<')? '>' : '<');
+        double rhs = row.rhs/factor;
+
+        std::pair<typename std::map<std::pair<key_type, char>, unsigned int>::iterator, bool> found = mRow.insert(std::make_pair(key, i));
+        if (found.second)
+            continue;
+        Row& other = m_vRow[found.first->second];
+        double otherRhs = other.rhs/other.vTerm.front().coefficient();
+        double tol = 1e-9*(1+std::abs(rhs));
+        bool keepOther = true;
+        switch (key.second)
+        {
+            case '<': keepOther = (otherRhs <= rhs); break;
+            case '>': keepOther = (otherRhs >= rhs); break;
+            default:
+                if (std::abs(otherRhs-rhs) > tol)
+                    return false;
+        }
+        ++m_numRemovedConstraints;
+        if (keepOther)
+            row.alive = false;
+        else
+        {
+            other.alive = false;
+            found.first->second = i;
+        }
+    }
+    return true;
+}
+template <typename T, typename V>
+void Presolver<T, V>::fixEmptyColumns()
+{
+    std::vector<char> vUsed (m_vLowerBound.size(), false);
+    for (unsigned int i = 0; i < m_vRow.size(); ++i)
+        if (m_vRow[i].alive)
+            for (typename std::vector<term_type>::const_iterator it = m_vRow[i].vTerm.begin(), ite = m_vRow[i].vTerm.end(); it != ite; ++it)
+                vUsed[it->variable().id()] = true;
+    std::vector<double> vObjCoef (m_vLowerBound.size(), 0);
+    for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+        vObjCoef[it->variable().id()] += it->coefficient();
+    double sign = (m_model->optimizeType() == MAX)? -1 : 1;
+    for (unsigned int j = 0; j < vUsed.size(); ++j)
+    {
+        if (vUsed[j] || fixed(j))
+            continue;
+        // the cheaper bound for the objective, or the bound closest to 0 without cost;
+        // an infinite bound means the model is unbounded, which is left to the solver
+        double c = sign*vObjCoef[j];
+        bool lowerInfinite = infiniteLower(m_vLowerBound[j]);
+        bool upperInfinite = infiniteUpper(m_vUpperBound[j]);
+        if (c > 0 && !lowerInfinite)
+            fixVariable(j, m_vLowerBound[j]);
+        else if (c < 0 && !upperInfinite)
+            fixVariable(j, m_vUpperBound[j]);
+        else if (c == 0)
+        {
+            if (!lowerInfinite && m_vLowerBound[j] >= 0)
+                fixVariable(j, m_vLowerBound[j]);
+            else if (!upperInfinite && m_vUpperBound[j] <= 0)
+                fixVariable(j, m_vUpperBound[j]);
+            else
+                fixVariable(j, 0);
+        }
+    }
+}
+template <typename T, typename V>
+void Presolver<T, V>::build()
+{
+    unsigned int numVariables = m_vLowerBound.size();
+    m_vNewId.assign(numVariables, -1);
+    unsigned int numReducedVariables = 0;
+    for (unsigned int j = 0; j < numVariables; ++j)
+        numReducedVariables += !fixed(j);
+    m_reducedModel.reserveVariables(numReducedVariables);
+    for (unsigned int j = 0; j < numVariables; ++j)
+    {
+        if (fixed(j))
+        {
+            ++m_numFixedVariables;
+            continue;
+        }
+        variable_type var (j);
+        variable_type newVar = m_reducedModel.addVariable(m_vLowerBound[j], m_vUpperBound[j],
+                m_model->variableProperties()[j].numericType(), m_model->variableName(var));
+        m_reducedModel.setVariableSolution(newVar, std::min(std::max(m_model->variableSolution(var), m_vLowerBound[j]), m_vUpperBound[j]));
+        m_vNewId[j] = newVar.id();
+    }
+
+    expression_type obj;
+    coefficient_value_type constant = m_model->objective().constant();
+    for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+    {
+        unsigned int j = it->variable().id();
+        if (m_vNewId[j] < 0)
+            constant += it->coefficient()*m_vLowerBound[j];
+        else
+            obj += term_type(variable_type(m_vNewId[j]), it->coefficient());
+    }
+    obj += constant;
+    m_reducedModel.emplaceObjective(obj);
+    m_reducedModel.setOptimizeType(m_model->optimizeType());
+
+    unsigned int numReducedConstraints = 0;
+    for (unsigned int i = 0; i < m_vRow.size(); ++i)
+        numReducedConstraints += m_vRow[i].alive;
+    m_reducedModel.reserveConstraints(numReducedConstraints);
+    for (unsigned int i = 0; i < m_vRow.size(); ++i)
+    {
+        Row& row = m_vRow[i];
+        if (!row.alive)
+            continue;
+        expression_type expr;
+        for (typename std::vector<term_type>::const_iterator it = row.vTerm.begin(), ite = row.vTerm.end(); it != ite; ++it)
+            expr += term_type(variable_type(m_vNewId[it->variable().id()]), it->coefficient());
+        m_reducedModel.emplaceConstraint(expr, row.sense, row.rhs, m_model->constraintName(m_model->constraints()[i]));
+    }
+    m_vRow.clear();
+    m_vQueue.clear();
+}
+template <typename T, typename V>
+void Presolver<T, V>::postsolve()
+{
+    for (unsigned int j = 0; j < m_vNewId.size(); ++j)
+        m_model->setVariableSolution(variable_type(j), (m_vNewId[j] < 0)? m_vLowerBound[j] : m_reducedModel.variableSolution(variable_type(m_vNewId[j])));
+}
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
@@ -0,0 +1,796 @@
+/**
+ * @file   PrimalDualHybridGradient.h
+ * @brief  Solve linear programs of @ref limbo::solvers::LinearModel by the restarted primal-dual hybrid gradient method
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_PRIMALDUALHYBRIDGRADIENT_H
+#define LIMBO_SOLVERS_PRIMALDUALHYBRIDGRADIENT_H
+
+#include <cmath>
+#include <limits>
+#include <unistd.h>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/solvers/Solvers.h>
+#include <limbo/solvers/Numerical.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @brief Solve a linear program with the restarted primal-dual hybrid gradient method, in the spirit of PDLP.
+///
+/// Constraints with sense '<' are negated, so the problem becomes \n
+/// \f{eqnarray*}{
+/// & min. & c^T x, \\[0pt]
+/// & s.t. & K_i x \ge q_i \mbox{ or } K_i x = q_i, \forall i, \\[0pt]
+/// &      & l \le x \le u.
+/// \f}
+/// \n
+/// Each iteration takes a projected gradient step of the primal variables and an extrapolated step of the duals,
+/// \f{eqnarray*}{
+/// x^{k+1} & = & proj_{[l, u]}(x^k - \tau (c - K^T y^k)), \\[0pt]
+/// y^{k+1} & = & proj_{y_i \ge 0 \mbox{ for inequalities}}(y^k + \sigma (q - K (2 x^{k+1} - x^k))),
+/// \f}
+/// which costs one product with \f$K\f$ and one with \f$K^T\f$ by the kernels of @ref Numerical.h.
+/// No factorization is needed, so the memory is about the constraint matrix in CSR format and a few vectors.
+///
+/// The matrix is equilibrated by a few Ruiz iterations of infinity norms of rows and columns,
+/// then by the square roots of the L1 norms of rows and columns as Pock and Chambolle,
+/// so that \f$\|K\|_2 \le 1\f$ and a step size close to 1 can be taken.
+/// The ratio of the primal and dual steps, the primal weight, is balanced at restarts.
+/// The iterates restart from the average or the current solution, whichever has the smaller KKT error,
+/// when the error drops enough since the last restart, or stops to drop.
+///
+/// The solver stops when the relative primal and dual residuals and the duality gap
+/// are below the tolerance in the units of the original problem.
+/// Integer variables are relaxed. Infeasible or unbounded problems run to the iteration limit.
+///
+/// With warm start, the primal solution starts from the solutions in the model,
+/// and the duals and the primal weight from the previous solve if the number of constraints is the same.
+///
+/// @tparam T coefficient value type
+/// @tparam V variable value type
+template <typename T, typename V>
+class PrimalDualHybridGradient
+{
+    public:
+        /// @brief linear model type for the problem
+        typedef LinearModel<T, V> model_type;
+        /// @nowarn
+        typedef typename model_type::coefficient_value_type coefficient_value_type;
+        typedef typename model_type::variable_value_type variable_value_type;
+        typedef typename model_type::variable_type variable_type;
+        typedef typename model_type::constraint_type constraint_type;
+        typedef typename model_type::expression_type expression_type;
+        typedef typename model_type::term_type term_type;
+        typedef typename model_type::property_type property_type;
+        typedef MatrixCSR<double, int, 1> matrix_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param model pointer to the model of problem
+        PrimalDualHybridGradient(model_type* model);
+
+        /// @brief API to run the algorithm
+        /// @return @ref OPTIMAL if the tolerance is met, @ref SUBOPTIMAL at the iteration limit
+        SolverProperty operator()()
+        {
+            return solve();
+        }
+
+        /// @return maximum iterations
+        unsigned int maxIterations() const {return m_maxIters;}
+        /// @brief set maximum iterations
+        /// @param maxIter maximum iterations
+        void setMaxIterations(unsigned int maxIter) {m_maxIters = maxIter;}
+        /// @return relative tolerance
+        double tolerance() const {return m_tolerance;}
+        /// @brief set relative tolerance of residuals and duality gap
+        /// @param tol tolerance
+        void setTolerance(double tol) {m_tolerance = tol;}
+        /// @return maximum number of threads
+        unsigned int numThreads() const {return m_maxThreads;}
+        /// @brief set maximum number of threads, limited by the number of cores
+        /// @param t number of threads
+        void setNumThreads(unsigned int t) {m_maxThreads = std::max(t, 1U);}
+        /// @return flag of whether warm start
+        bool warmStart() const {return m_warmStart;}
+        /// @brief set whether start from the solutions in the model and the duals of the previous solve
+        /// @param f flag
+        void setWarmStart(bool f) {m_warmStart = f;}
+
+        /// @return number of iterations in the last solve
+        unsigned int iterations() const {return m_iter;}
+        /// @return number of restarts in the last solve
+        unsigned int numRestarts() const {return m_numRestarts;}
+        /// @return objective of the primal solution
+        double primalObjective() const {return m_primalObj;}
+        /// @return objective of the dual solution, a bound of the optimal objective up to the dual residual
+        double dualObjective() const {return m_dualObj;}
+        /// @return dual value of each constraint, the change of the objective per unit increase of its right hand side
+        std::vector<double> const& dualSolutions() const {return m_vDualSol;}
+        /// @brief set the duals to start from with warm start, e.g., kept by @ref PrimalDualHybridGradientSession across changes of rows
+        /// @param vDualSol dual value of each constraint, ignored if the size does not match the constraints
+        void setDualSolutions(std::vector<double> const& vDualSol) {m_vDualSol = vDualSol;}
+
+    protected:
+        /// @brief work done by threads
+        enum KernelType
+        {
+            PRIMAL_KERNEL, ///< primal step of columns
+            DUAL_KERNEL, ///< dual step and averages of rows
+            AVERAGE_KERNEL ///< averages of columns
+        };
+        /// @brief run a kernel on blocks of rows or columns
+        struct StepKernel
+        {
+            PrimalDualHybridGradient* solver; ///< solver
+            KernelType kernel; ///< kernel to run
+
+            /// @brief run items [b, e)
+            void operator()(unsigned int b, unsigned int e) const;
+        };
+        /// @brief residuals and objectives of a solution in the units of the original problem
+        struct Residual
+        {
+            double primal; ///< L2 norm of constraint violations
+            double dual; ///< L2 norm of reduced costs without matching bounds
+            double primalObj; ///< primal objective
+            double dualObj; ///< dual objective
+        };
+
+        /// @brief kernel function to solve the problem
+        SolverProperty solve();
+        /// @brief build the scaled problem from the model
+        void prepare();
+        /// @brief equilibrate rows and columns of the constraint matrix
+        void scale();
+        /// @brief multiply rows and columns of the constraint matrix
+        /// @param vRow factor of each row
+        /// @param vColumn factor of each column
+        void scaleMatrix(std::vector<double> const& vRow, std::vector<double> const& vColumn);
+        /// @brief estimate \f$\|K\|_2\f$ by power iterations
+        /// @return estimated norm
+        double estimateNorm();
+        /// @brief set the initial solution
+        void initialize();
+        /// @brief run a kernel with threads
+        /// @param kernel kernel type
+        /// @param size number of items
+        void run(KernelType kernel, unsigned int size);
+        /// @brief primal step of columns [b, e)
+        void primalBlock(unsigned int b, unsigned int e);
+        /// @brief dual step and averages of rows [b, e)
+        void dualBlock(unsigned int b, unsigned int e);
+        /// @brief averages of columns [b, e)
+        void averageBlock(unsigned int b, unsigned int e);
+        /// @brief evaluate a solution
+        /// @param vX primal solution
+        /// @param vY dual solution
+        /// @param vKx \f$K x\f$
+        /// @param vKTy \f$K^T y\f$
+        /// @return residuals and objectives
+        Residual evaluate(std::vector<double> const& vX, std::vector<double> const& vY,
+                std::vector<double> const& vKx, std::vector<double> const& vKTy) const;
+        /// @return true if the residuals and the duality gap are below the tolerance
+        /// @param r residuals
+        bool converged(Residual const& r) const;
+        /// @return KKT error weighted by the primal weight
+        /// @param r residuals
+        double kktError(Residual const& r) const;
+        /// @brief restart from the average or the current solution and update the primal weight
+        /// @param fromAverage true to restart from the average
+        void restart(bool fromAverage);
+        /// @brief write solutions to the model
+        /// @param vX primal solution
+        /// @param vY dual solution
+        void writeSolution(std::vector<double> const& vX, std::vector<double> const& vY);
+
+        model_type* m_model; ///< model for the problem
+        unsigned int m_maxIters; ///< maximum number of iterations
+        double m_tolerance; ///< relative tolerance
+        unsigned int m_maxThreads; ///< maximum number of threads
+        unsigned int m_numThreads; ///< number of threads in use, limited by the number of cores
+        bool m_warmStart; ///< whether warm start
+
+        matrix_type m_constrMatrix; ///< scaled constraint matrix \f$K\f$ with rows of sense '<' negated
+        std::vector<double> m_vRhs; ///< scaled right hand side \f$q\f$
+        std::vector<char> m_vEquality; ///< whether a row is an equality
+        std::vector<double> m_vRowSign; ///< -1 for negated rows, 1 otherwise
+        std::vector<double> m_vObjCoef; ///< scaled objective \f$c\f$, negated for maximization
+        std::vector<double> m_vLowerBound; ///< scaled lower bounds, -inf if unbounded
+        std::vector<double> m_vUpperBound; ///< scaled upper bounds, inf if unbounded
+        std::vector<double> m_vRowScale; ///< row scaling \f$D_r\f$, \f$K = D_r A D_c\f$
+        std::vector<double> m_vColumnScale; ///< column scaling \f$D_c\f$, \f$x = D_c \tilde{x}\f$
+        double m_objSign; ///< -1 for maximization, 1 otherwise
+        double m_objConstant; ///< constant of the objective
+        double m_rhsNorm; ///< L2 norm of the original right hand side
+        double m_objNorm; ///< L2 norm of the original objective
+
+        std::vector<double> m_vX; ///< current primal solution
+        std::vector<double> m_vY; ///< current dual solution
+        std::vector<double> m_vKx; ///< \f$K x\f$ of the current solution
+        std::vector<double> m_vKTy; ///< \f$K^T y\f$ of the current solution
+        std::vector<double> m_vNextX; ///< next primal solution
+        std::vector<double> m_vNextY; ///< next dual solution
+        std::vector<double> m_vNextKx; ///< \f$K x\f$ of the next solution
+        std::vector<double> m_vNextKTy; ///< \f$K^T y\f$ of the next solution
+        std::vector<double> m_vAvgX; ///< average primal solution since the last restart
+        std::vector<double> m_vAvgY; ///< average dual solution since the last restart
+        std::vector<double> m_vAvgKx; ///< \f$K x\f$ of the average solution
+        std::vector<double> m_vAvgKTy; ///< \f$K^T y\f$ of the average solution
+        std::vector<double> m_vRestartX; ///< primal solution at the last restart
+        std::vector<double> m_vRestartY; ///< dual solution at the last restart
+
+        double m_stepSize; ///< step size \f$\eta\f$, \f$\tau = \eta / \omega\f$ and \f$\sigma = \eta \omega\f$
+        double m_primalWeight; ///< primal weight \f$\omega\f$
+        double m_tau; ///< primal step
+        double m_sigma; ///< dual step
+        double m_avgWeight; ///< weight of the next solution in the averages
+        unsigned int m_iter; ///< current iteration
+        unsigned int m_numRestarts; ///< number of restarts
+        double m_primalObj; ///< primal objective of the solution
+        double m_dualObj; ///< dual objective of the solution
+        std::vector<double> m_vDualSol; ///< dual value of each constraint of the model
+};
+
+template <typename T, typename V>
+PrimalDualHybridGradient<T, V>::PrimalDualHybridGradient(typename PrimalDualHybridGradient<T, V>::model_type* model)
+    : m_model(model)
+    , m_maxIters(100000)
+    , m_tolerance(1e-6)
+    , m_maxThreads(1)
+    , m_numThreads(1)
+    , m_warmStart(false)
+    , m_objSign(1)
+    , m_objConstant(0)
+    , m_rhsNorm(0)
+    , m_objNorm(0)
+    , m_stepSize(1)
+    , m_primalWeight(1)
+    , m_tau(1)
+    , m_sigma(1)
+    , m_avgWeight(1)
+    , m_iter(0)
+    , m_numRestarts(0)
+    , m_primalObj(0)
+    , m_dualObj(0)
+{
+}
+template <typename T, typename V>
+SolverProperty PrimalDualHybridGradient<T, V>::solve()
+{
+    // threads beyond the number of cores only add overhead
+    m_numThreads = std::min(limbo::containers::num_threads(), m_maxThreads);
+
+    prepare();
+    initialize();
+
+    unsigned int numRows = m_vY.size();
+    unsigned int numColumns = m_vX.size();
+    // restart and termination are checked periodically, as an evaluation costs about an iteration
+    unsigned int const checkFrequency = 64;
+    Residual r = evaluate(m_vX, m_vY, m_vKx, m_vKTy);
+    double restartKkt = kktError(r);
+    double prevCandidateKkt = std::numeric_limits<double>::max();
+    unsigned int restartIter = 0;
+    bool optimal = converged(r);
+    bool fromAverage = false;
+    m_numRestarts = 0;
+    for (m_iter = 0; m_iter < m_maxIters && !optimal; )
+    {
+        // x^{k+1}, K x^{k+1}, y^{k+1}, K^T y^{k+1}
+        run(PRIMAL_KERNEL, numColumns);
+        std::fill(m_vNextKx.begin(), m_vNextKx.end(), 0.0);
+        if (numRows)
+            AxPlusy(1.0, m_constrMatrix, &m_vNextX[0], &m_vNextKx[0], m_numThreads);
+        m_avgWeight = 1.0/(m_iter-restartIter+1);
+        run(DUAL_KERNEL, numRows);
+        std::fill(m_vNextKTy.begin(), m_vNextKTy.end(), 0.0);
+        if (numRows)
+            ATxPlusy(1.0, m_constrMatrix, &m_vNextY[0], &m_vNextKTy[0], m_numThreads);
+        run(AVERAGE_KERNEL, numColumns);
+        m_vX.swap(m_vNextX);
+        m_vY.swap(m_vNextY);
+        m_vKx.swap(m_vNextKx);
+        m_vKTy.swap(m_vNextKTy);
+        ++m_iter;
+
+        if (m_iter%checkFrequency == 0 || m_iter == m_maxIters)
+        {
+            Residual current = evaluate(m_vX, m_vY, m_vKx, m_vKTy);
+            Residual average = evaluate(m_vAvgX, m_vAvgY, m_vAvgKx, m_vAvgKTy);
+            double currentKkt = kktError(current);
+            double averageKkt = kktError(average);
+            fromAverage = (averageKkt < currentKkt);
+            r = (fromAverage)? average : current;
+            double candidateKkt = std::min(currentKkt, averageKkt);
+            optimal = converged(r);
+            if (optimal)
+                break;
+            // sufficient decay, necessary decay without progress, or a long run since the last restart
+            if (candidateKkt <= 0.2*restartKkt
+                    || (candidateKkt <= 0.8*restartKkt && candidateKkt > prevCandidateKkt)
+                    || m_iter-restartIter >= 0.36*m_iter)
+            {
+                restart(fromAverage);
+                restartKkt = candidateKkt;
+                prevCandidateKkt = std::numeric_limits<double>::max();
+                restartIter = m_iter;
+                fromAverage = false;
+            }
+            else
+                prevCandidateKkt = candidateKkt;
+        }
+    }
+
+    writeSolution((fromAverage)? m_vAvgX : m_vX, (fromAverage)? m_vAvgY : m_vY);
+    m_primalObj = m_objSign*r.primalObj;
+    m_dualObj = m_objSign*r.dualObj;
+    return (optimal)? OPTIMAL : SUBOPTIMAL;
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::prepare()
+{
+    unsigned int numVariables = m_model->numVariables();
+    unsigned int numConstraints = m_model->constraints().size();
+
+    // min. c^T x, K x >= q with rows of '<' negated
+    m_constrMatrix.set(numConstraints, numVariables, (numConstraints)? &m_model->constraints()[0] : (constraint_type const*)NULL);
+    m_vRhs.resize(numConstraints);
+    m_vEquality.resize(numConstraints);
+    m_vRowSign.resize(numConstraints);
+    m_rhsNorm = 0;
+    for (unsigned int i = 0; i < numConstraints; ++i)
+    {
+        constraint_type const& constr = m_model->constraints()[i];
+        m_vEquality[i] = (constr.sense() == '=');
+        m_vRowSign[i] = (constr.sense() == '<')? -1 : 1;
+        m_vRhs[i] = m_vRowSign[i]*(constr.rightHandSide()-constr.expression().constant());
+        m_rhsNorm += m_vRhs[i]*m_vRhs[i];
+        if (m_vRowSign[i] < 0)
+            for (int k = m_constrMatrix.vRowBeginIndex[i]-1, ke = m_constrMatrix.vRowBeginIndex[i+1]-1; k < ke; ++k)
+                m_constrMatrix.vElement[k] = -m_constrMatrix.vElement[k];
+    }
+    m_rhsNorm = std::sqrt(m_rhsNorm);
+
+    m_objSign = (m_model->optimizeType() == MAX)? -1 : 1;
+    m_objConstant = m_objSign*m_model->objective().constant();
+    m_vObjCoef.assign(numVariables, 0);
+    for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
+        m_vObjCoef[it->variable().id()] += m_objSign*it->coefficient();
+    m_objNorm = std::sqrt(dot(numVariables, (numVariables)? &m_vObjCoef[0] : (double const*)NULL, (numVariables)? &m_vObjCoef[0] : (double const*)NULL));
+
+    m_vLowerBound.resize(numVariables);
+    m_vUpperBound.resize(numVariables);
+    for (unsigned int j = 0; j < numVariables; ++j)
+    {
+        property_type const& property = m_model->variableProperties()[j];
+        m_vLowerBound[j] = (property.lowerBound() <= limbo::lowest<variable_value_type>())? -std::numeric_limits<double>::infinity() : (double)property.lowerBound();
+        m_vUpperBound[j] = (property.upperBound() >= std::numeric_limits<variable_value_type>::max())? std::numeric_limits<double>::infinity() : (double)property.upperBound();
+    }
+
+    scale();
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::scale()
+{
+    unsigned int numRows = m_constrMatrix.numRows;
+    unsigned int numColumns = m_constrMatrix.numColumns;
+    m_vRowScale.assign(numRows, 1.0);
+    m_vColumnScale.assign(numColumns, 1.0);
+    std::vector<double> vRow (numRows);
+    std::vector<double> vColumn (numColumns);
+
+    // Ruiz equilibration with infinity norms
+    for (unsigned int iter = 0; iter < 10; ++iter)
+    {
+        std::fill(vRow.begin(), vRow.end(), 0.0);
+        std::fill(vColumn.begin(), vColumn.end(), 0.0);
+        for (unsigned int i = 0; i < numRows; ++i)
+        {
+            for (int k = m_constrMatrix.vRowBeginIndex[i]-1, ke = m_constrMatrix.vRowBeginIndex[i+1]-1; k < ke; ++k)
+            {
+                double v = std::abs(m_constrMatrix.vElement[k]);
+                int j = m_constrMatrix.vColumn[k]-1;
+                vRow[i] = std::max(vRow[i], v);
+                vColumn[j] = std::max(vColumn[j], v);
+            }
+        }
+        for (unsigned int i = 0; i < numRows; ++i)
+            vRow[i] = (vRow[i] > 0)? 1.0/std::sqrt(vRow[i]) : 1.0;
+        for (unsigned int j = 0; j < numColumns; ++j)
+            vColumn[j] = (vColumn[j] > 0)? 1.0/std::sqrt(vColumn[j]) : 1.0;
+        scaleMatrix(vRow, vColumn);
+    }
+    // Pock-Chambolle with square roots of L1 norms, which bounds the spectral norm by 1
+    std::fill(vRow.begin(), vRow.end(), 0.0);
+    std::fill(vColumn.begin(), vColumn.end(), 0.0);
+    for (unsigned int i = 0; i < numRows; ++i)
+    {
+        for (int k = m_constrMatrix.vRowBeginIndex[i]-1, ke = m_constrMatrix.vRowBeginIndex[i+1]-1; k < ke; ++k)
+        {
+            double v = std::abs(m_constrMatrix.vElement[k]);
+            vRow[i] += v;
+            vColumn[m_constrMatrix.vColumn[k]-1] += v;
+        }
+    }
+    for (unsigned int i = 0; i < numRows; ++i)
+        vRow[i] = (vRow[i] > 0)? 1.0/std::sqrt(vRow[i]) : 1.0;
+    for (unsigned int j = 0; j < numColumns; ++j)
+        vColumn[j] = (vColumn[j] > 0)? 1.0/std::sqrt(vColumn[j]) : 1.0;
+    scaleMatrix(vRow, vColumn);
+
+    // q = D_r q, c = D_c c, l = l / D_c, u = u / D_c
+    for (unsigned int i = 0; i < numRows; ++i)
+        m_vRhs[i] *= m_vRowScale[i];
+    for (unsigned int j = 0; j < numColumns; ++j)
+    {
+        m_vObjCoef[j] *= m_vColumnScale[j];
+        m_vLowerBound[j] /= m_vColumnScale[j];
+        m_vUpperBound[j] /= m_vColumnScale[j];
+    }
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::scaleMatrix(std::vector<double> const& vRow, std::vector<double> const& vColumn)
+{
+    for (unsigned int i = 0; i < vRow.size(); ++i)
+    {
+        m_vRowScale[i] *= vRow[i];
+        for (int k = m_constrMatrix.vRowBeginIndex[i]-1, ke = m_constrMatrix.vRowBeginIndex[i+1]-1; k < ke; ++k)
+            m_constrMatrix.vElement[k] *= vRow[i]*vColumn[m_constrMatrix.vColumn[k]-1];
+    }
+    for (unsigned int j = 0; j < vColumn.size(); ++j)
+        m_vColumnScale[j] *= vColumn[j];
+}
+template <typename T, typename V>
+double PrimalDualHybridGradient<T, V>::estimateNorm()
+{
+    unsigned int numRows = m_constrMatrix.numRows;
+    unsigned int numColumns = m_constrMatrix.numColumns;
+    if (numRows == 0 || numColumns == 0)
+        return 1;
+    // power iterations of K^T K from a vector not orthogonal to common singular vectors
+    std::vector<double> v (numColumns);
+    std::vector<double> w (numRows);
+    for (unsigned int j = 0; j < numColumns; ++j)
+        v[j] = 1+0.1*(j%7);
+    double norm2 = 0;
+    for (unsigned int iter = 0; iter < 30; ++iter)
+    {
+        double vNorm = std::sqrt(dot(numColumns, &v[0], &v[0], m_numThreads));
+        if (vNorm == 0)
+            break;
+        for (unsigned int j = 0; j < numColumns; ++j)
+            v[j] /= vNorm;
+        std::fill(w.begin(), w.end(), 0.0);
+        AxPlusy(1.0, m_constrMatrix, &v[0], &w[0], m_numThreads);
+        std::fill(v.begin(), v.end(), 0.0);
+        ATxPlusy(1.0, m_constrMatrix, &w[0], &v[0], m_numThreads);
+        norm2 = dot(numRows, &w[0], &w[0], m_numThreads);
+    }
+    return (norm2 > 0)? std::sqrt(norm2) : 1;
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::initialize()
+{
+    unsigned int numRows = m_constrMatrix.numRows;
+    unsigned int numColumns = m_constrMatrix.numColumns;
+
+    // the estimate approaches the norm from below, and the scaling bounds it by 1
+    m_stepSize = 0.9/std::min(1.05*estimateNorm(), 1.0);
+
+    bool warmDual = m_warmStart && m_vDualSol.size() == numRows;
+    m_vX.assign(numColumns, 0.0);
+    if (m_warmStart)
+        for (unsigned int j = 0; j < numColumns; ++j)
+            m_vX[j] = m_model->variableSolutions()[j]/m_vColumnScale[j];
+    for (unsigned int j = 0; j < numColumns; ++j)
+        m_vX[j] = std::min(std::max(m_vX[j], m_vLowerBound[j]), m_vUpperBound[j]);
+    m_vY.assign(numRows, 0.0);
+    if (warmDual)
+    {
+        for (unsigned int i = 0; i < numRows; ++i)
+        {
+            m_vY[i] = m_objSign*m_vRowSign[i]*m_vDualSol[i]/m_vRowScale[i];
+            if (!m_vEquality[i])
+                m_vY[i] = std::max(m_vY[i], 0.0);
+        }
+    }
+    else
+    {
+        // balance the primal and dual steps by the norms of the objective and the right hand side
+        double objNorm = std::sqrt(dot(numColumns, (numColumns)? &m_vObjCoef[0] : (double const*)NULL, (numColumns)? &m_vObjCoef[0] : (double const*)NULL));
+        double rhsNorm = std::sqrt(dot(numRows, (numRows)? &m_vRhs[0] : (double const*)NULL, (numRows)? &m_vRhs[0] : (double const*)NULL));
+        m_primalWeight = (objNorm > 0 && rhsNorm > 0)? objNorm/rhsNorm : 1;
+    }
+    m_tau = m_stepSize/m_primalWeight;
+    m_sigma = m_stepSize*m_primalWeight;
+
+    m_vKx.assign(numRows, 0.0);
+    m_vKTy.assign(numColumns, 0.0);
+    if (numRows)
+    {
+        AxPlusy(1.0, m_constrMatrix, &m_vX[0], &m_vKx[0], m_numThreads);
+        ATxPlusy(1.0, m_constrMatrix, &m_vY[0], &m_vKTy[0], m_numThreads);
+    }
+    m_vNextX.resize(numColumns);
+    m_vNextY.resize(numRows);
+    m_vNextKx.resize(numRows);
+    m_vNextKTy.resize(numColumns);
+    m_vAvgX = m_vX;
+    m_vAvgY = m_vY;
+    m_vAvgKx = m_vKx;
+    m_vAvgKTy = m_vKTy;
+    m_vRestartX = m_vX;
+    m_vRestartY = m_vY;
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::run(typename PrimalDualHybridGradient<T, V>::KernelType kernel, unsigned int size)
+{
+    StepKernel step;
+    step.solver = this;
+    step.kernel = kernel;
+    unsigned int numThreads = numericalThreads(m_numThreads, size);
+    if (numThreads > 1)
+        runNumericalKernel(step, size, NUMERICAL_BLOCK_WORK, numThreads);
+    else
+        step(0, size);
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::StepKernel::operator()(unsigned int b, unsigned int e) const
+{
+    switch (kernel)
+    {
+        case PRIMAL_KERNEL:
+            solver->primalBlock(b, e);
+            break;
+        case DUAL_KERNEL:
+            solver->dualBlock(b, e);
+            break;
+        case AVERAGE_KERNEL:
+            solver->averageBlock(b, e);
+            break;
+    }
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::primalBlock(unsigned int b, unsigned int e)
+{
+    for (; b < e; ++b)
+    {
+        double x = m_vX[b]-m_tau*(m_vObjCoef[b]-m_vKTy[b]);
+        m_vNextX[b] = std::min(std::max(x, m_vLowerBound[b]), m_vUpperBound[b]);
+    }
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::dualBlock(unsigned int b, unsigned int e)
+{
+    for (; b < e; ++b)
+    {
+        double y = m_vY[b]+m_sigma*(m_vRhs[b]-2*m_vNextKx[b]+m_vKx[b]);
+        m_vNextY[b] = (m_vEquality[b])? y : std::max(y, 0.0);
+        m_vAvgY[b] += m_avgWeight*(m_vNextY[b]-m_vAvgY[b]);
+        m_vAvgKx[b] += m_avgWeight*(m_vNextKx[b]-m_vAvgKx[b]);
+    }
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::averageBlock(unsigned int b, unsigned int e)
+{
+    for (; b < e; ++b)
+    {
+        m_vAvgX[b] += m_avgWeight*(m_vNextX[b]-m_vAvgX[b]);
+        m_vAvgKTy[b] += m_avgWeight*(m_vNextKTy[b]-m_vAvgKTy[b]);
+    }
+}
+template <typename T, typename V>
+typename PrimalDualHybridGradient<T, V>::Residual PrimalDualHybridGradient<T, V>::evaluate(std::vector<double> const& vX, std::vector<double> const& vY,
+        std::vector<double> const& vKx, std::vector<double> const& vKTy) const
+{
+    // scaled residuals are D_r (q - K x) and D_c (c - K^T y), objectives do not change with the scaling
+    Residual r;
+    r.primal = 0;
+    r.dual = 0;
+    r.primalObj = m_objConstant;
+    r.dualObj = m_objConstant;
+    for (unsigned int i = 0; i < vY.size(); ++i)
+    {
+        double violation = m_vRhs[i]-vKx[i];
+        if (!m_vEquality[i])
+            violation = std::max(violation, 0.0);
+        violation /= m_vRowScale[i];
+        r.primal += violation*violation;
+        r.dualObj += m_vRhs[i]*vY[i];
+    }
+    for (unsigned int j = 0; j < vX.size(); ++j)
+    {
+        r.primalObj += m_vObjCoef[j]*vX[j];
+        // positive reduced costs are paid by lower bounds and negative ones by upper bounds
+        double reducedCost = m_vObjCoef[j]-vKTy[j];
+        double bound = (reducedCost > 0)? m_vLowerBound[j] : m_vUpperBound[j];
+        if (reducedCost == 0)
+            continue;
+        if (std::abs(bound) == std::numeric_limits<double>::infinity())
+        {
+            double residual = reducedCost/m_vColumnScale[j];
+            r.dual += residual*residual;
+        }
+        else
+            r.dualObj += reducedCost*bound;
+    }
+    r.primal = std::sqrt(r.primal);
+    r.dual = std::sqrt(r.dual);
+    return r;
+}
+template <typename T, typename V>
+bool PrimalDualHybridGradient<T, V>::converged(typename PrimalDualHybridGradient<T, V>::Residual const& r) const
+{
+    return r.primal <= m_tolerance*(1+m_rhsNorm)
+        && r.dual <= m_tolerance*(1+m_objNorm)
+        && std::abs(r.primalObj-r.dualObj) <= m_tolerance*(1+std::abs(r.primalObj)+std::abs(r.dualObj));
+}
+template <typename T, typename V>
+double PrimalDualHybridGradient<T, V>::kktError(typename PrimalDualHybridGradient<T, V>::Residual const& r) const
+{
+    double gap = r.primalObj-r.dualObj;
+    return std::sqrt(m_primalWeight*m_primalWeight*r.primal*r.primal + r.dual*r.dual/(m_primalWeight*m_primalWeight) + gap*gap);
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::restart(bool fromAverage)
+{
+    ++m_numRestarts;
+    if (fromAverage)
+    {
+        m_vX.swap(m_vAvgX);
+        m_vY.swap(m_vAvgY);
+        m_vKx.swap(m_vAvgKx);
+        m_vKTy.swap(m_vAvgKTy);
+    }
+    // move the primal weight towards the ratio of the dual and primal movements since the last restart
+    double dx = 0;
+    double dy = 0;
+    for (unsigned int j = 0; j < m_vX.size(); ++j)
+        dx += (m_vX[j]-m_vRestartX[j])*(m_vX[j]-m_vRestartX[j]);
+    for (unsigned int i = 0; i < m_vY.size(); ++i)
+        dy += (m_vY[i]-m_vRestartY[i])*(m_vY[i]-m_vRestartY[i]);
+    if (dx > 1e-20 && dy > 1e-20)
+    {
+        m_primalWeight = std::exp(0.5*std::log(std::sqrt(dy/dx))+0.5*std::log(m_primalWeight));
+        m_tau = m_stepSize/m_primalWeight;
+        m_sigma = m_stepSize*m_primalWeight;
+    }
+    m_vRestartX = m_vX;
+    m_vRestartY = m_vY;
+    m_vAvgX = m_vX;
+    m_vAvgY = m_vY;
+    m_vAvgKx = m_vKx;
+    m_vAvgKTy = m_vKTy;
+}
+template <typename T, typename V>
+void PrimalDualHybridGradient<T, V>::writeSolution(std::vector<double> const& vX, std::vector<double> const& vY)
+{
+    std::vector<variable_value_type>& vVariableSol = m_model->variableSolutions();
+    for (unsigned int j = 0; j < vX.size(); ++j)
+    {
+        double x = m_vColumnScale[j]*std::min(std::max(vX[j], m_vLowerBound[j]), m_vUpperBound[j]);
+        vVariableSol[j] = (std::numeric_limits<variable_value_type>::is_integer)? (variable_value_type)std::floor(x+0.5) : (variable_value_type)x;
+    }
+    m_vDualSol.resize(vY.size());
+    for (unsigned int i = 0; i < vY.size(); ++i)
+        m_vDualSol[i] = m_objSign*m_vRowSign[i]*m_vRowScale[i]*vY[i];
+}
+
+/// @brief Model kept across solves of a @ref limbo::solvers::LinearModel by @ref PrimalDualHybridGradient,
+/// with the same interface as the sessions of the solver APIs, e.g., @ref limbo::solvers::GurobiLinearSession.
+///
+/// Each modification is applied to the @ref limbo::solvers::LinearModel.
+/// A re-solve starts from the previous primal solution and the previous duals,
+/// where added constraints start with zero duals and the duals of removed constraints are dropped.
+/// The @ref limbo::solvers::LinearModel must only be modified through the session while it is alive.
+/// @tparam T coefficient type
+/// @tparam V variable type
+template <typename T, typename V>
+class PrimalDualHybridGradientSession
+{
+    public:
+        /// @brief linear model type for the problem
+        typedef LinearModel<T, V> model_type;
+        /// @nowarn
+        typedef typename model_type::coefficient_value_type coefficient_value_type;
+        typedef typename model_type::variable_value_type variable_value_type;
+        typedef typename model_type::variable_type variable_type;
+        typedef typename model_type::constraint_type constraint_type;
+        typedef PrimalDualHybridGradient<T, V> solver_type;
+        /// @endnowarn
+
+        /// @brief constructor
+        /// @param model pointer to the model of problem
+        PrimalDualHybridGradientSession(model_type* model)
+            : m_model(model)
+            , m_solver(model)
+            , m_solved(false)
+        {
+        }
+
+        /// @brief solve or re-solve the model and write solutions to the @ref limbo::solvers::LinearModel
+        /// @return solving status of @ref PrimalDualHybridGradient
+        SolverProperty operator()()
+        {
+            m_solver.setWarmStart(m_solved);
+            if (m_solved)
+                m_solver.setDualSolutions(m_vDualSol);
+            SolverProperty status = m_solver();
+            m_vDualSol = m_solver.dualSolutions();
+            m_solved = true;
+            return status;
+        }
+
+        /// @brief add a constraint, a constraint of one term updates bounds as @ref limbo::solvers::LinearModel::addConstraint
+        /// @param constr constraint
+        /// @param name constraint name
+        /// @return true if added
+        bool addConstraint(constraint_type const& constr, std::string const& name = "")
+        {
+            unsigned int numConstraints = m_model->constraints().size();
+            if (!m_model->addConstraint(constr, name))
+                return false;
+            if (m_solved && m_model->constraints().size() != numConstraints)
+                m_vDualSol.push_back(0);
+            return true;
+        }
+        /// @brief remove constraints, the remaining ones are renumbered as @ref limbo::solvers::LinearModel::removeConstraints
+        /// @param vConstraintId indices of constraints
+        void removeConstraints(std::vector<unsigned int> const& vConstraintId)
+        {
+            if (m_solved)
+            {
+                std::vector<bool> vRemove (m_vDualSol.size(), false);
+                for (std::vector<unsigned int>::const_iterator it = vConstraintId.begin(); it != vConstraintId.end(); ++it)
+                    vRemove.at(*it) = true;
+                unsigned int n = 0;
+                for (unsigned int i = 0; i < m_vDualSol.size(); ++i)
+                    if (!vRemove[i])
+                        m_vDualSol[n++] = m_vDualSol[i];
+                m_vDualSol.resize(n);
+            }
+            m_model->removeConstraints(vConstraintId);
+        }
+        /// @brief change bounds of a variable
+        /// @param var variable
+        /// @param lb lower bound
+        /// @param ub upper bound
+        void setVariableBounds(variable_type const& var, variable_value_type lb, variable_value_type ub)
+        {
+            m_model->setVariableLowerBound(var, lb);
+            m_model->setVariableUpperBound(var, ub);
+        }
+        /// @brief change the coefficient of a variable in the objective
+        /// @param var variable
+        /// @param coef coefficient
+        void setObjectiveCoefficient(variable_type const& var, coefficient_value_type coef)
+        {
+            m_model->setObjectiveCoefficient(var, coef);
+        }
+        /// @return solver, to set its tolerance, iterations and threads
+        solver_type& solver() {return m_solver;}
+
+    protected:
+        /// @brief copy constructor, forbidden
+        /// @param rhs right hand side
+        PrimalDualHybridGradientSession(PrimalDualHybridGradientSession const& rhs);
+        /// @brief assignment, forbidden
+        /// @param rhs right hand side
+        PrimalDualHybridGradientSession& operator=(PrimalDualHybridGradientSession const& rhs);
+
+        model_type* m_model; ///< model for the problem
+        solver_type m_solver; ///< solver, which keeps the primal weight across solves
+        bool m_solved; ///< whether the model has been solved once
+        std::vector<double> m_vDualSol; ///< duals of the last solve, one per constraint of the model
+};
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
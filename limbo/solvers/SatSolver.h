@@ -0,0 +1,827 @@
+/**
+ * @file   SatSolver.h
+ * @brief  Incremental CDCL SAT solver with a bound on the weighted sum of literals.
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_SATSOLVER_H
+#define LIMBO_SOLVERS_SATSOLVER_H
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <time.h>
+#include <boost/cstdint.hpp>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @class limbo::solvers::SatSolver
+/// @brief Conflict-driven clause learning SAT solver with a cost bound, for exact optimization by a series of SAT calls.
+///
+/// Besides clauses, literals may carry costs, and solutions must satisfy \f$\sum_i c_i l_i \le B\f$.
+/// The bound is propagated natively: a literal whose cost would exceed the bound is set to false,
+/// explained by the true literals with costs before it, and a conflict is explained in the same way.
+/// These explanations stay valid when the bound decreases, so the bound can be tightened between calls
+/// and learned clauses are kept, e.g., to minimize the cost by solving again below the cost of each solution found.
+///
+/// The search follows MiniSat, with two watched literals, first-UIP learning with minimization,
+/// activities of variables in a heap, saved phases, Luby restarts and reduction of learned clauses by their LBD.
+/// Clauses can be added between calls, and calls can take assumptions.
+class SatSolver
+{
+    public:
+        /// @brief literal, 2 * variable + 1 if negated
+        typedef boost::uint32_t literal_type;
+        /// @brief result of a call
+        enum StatusType
+        {
+            SATISFIABLE, ///< a solution is found
+            UNSATISFIABLE, ///< no solution under the assumptions
+            UNKNOWN ///< the limit of conflicts or time is reached
+        };
+
+        /// @brief constructor
+        SatSolver();
+
+        /// @brief add a variable
+        /// @return index of the variable
+        boost::uint32_t new_variable();
+        /// @return number of variables
+        boost::uint32_t num_variables() const {return m_vAssign.size();}
+        /// @param v variable
+        /// @param positive false for the negation
+        /// @return literal of a variable
+        static literal_type literal(boost::uint32_t v, bool positive = true) {return (v<<1)|(!positive);}
+        /// @return negation of a literal
+        static literal_type negate(literal_type l) {return l^1;}
+        /// @return variable of a literal
+        static boost::uint32_t variable(literal_type l) {return l>>1;}
+
+        /// @brief add a clause, only between calls
+        /// @param vLiteral literals
+        /// @return false if the clauses are unsatisfiable
+        bool add_clause(std::vector<literal_type> const& vLiteral);
+        /// @brief add a clause of two literals
+        bool add_clause(literal_type a, literal_type b) {m_vTmp.assign(1, a); m_vTmp.push_back(b); return add_clause_tmp();}
+        /// @brief add a clause of three literals
+        bool add_clause(literal_type a, literal_type b, literal_type c) {m_vTmp.assign(1, a); m_vTmp.push_back(b); m_vTmp.push_back(c); return add_clause_tmp();}
+        /// @brief add the cost of a literal if it is true, only between calls
+        /// @param l literal
+        /// @param cost positive cost
+        void add_cost(literal_type l, double cost);
+        /// @brief set the bound of the total cost, which can only decrease
+        /// @param b bound
+        void cost_bound(double b);
+        /// @return bound of the total cost
+        double cost_bound() const {return m_bound;}
+        /// @brief set the limit of conflicts of each call
+        /// @param n number of conflicts, 0 for no limit
+        void max_conflicts(boost::uint64_t n) {m_max_conflicts = n;}
+        /// @brief set the time limit of each call, checked at restarts
+        /// @param t seconds, 0 for no limit
+        void time_limit(double t) {m_time_limit = t;}
+
+        /// @brief solve the clauses and the cost bound
+        /// @param vAssumption literals assumed to be true in this call
+        /// @return status
+        StatusType solve(std::vector<literal_type> const& vAssumption = std::vector<literal_type>());
+
+        /// @param v variable
+        /// @return value of a variable in the last solution
+        bool value(boost::uint32_t v) const {return m_vModel[v];}
+        /// @return total cost of the last solution
+        double model_cost() const;
+        /// @return number of conflicts in all calls
+        boost::uint64_t num_conflicts() const {return m_num_conflicts;}
+        /// @return number of decisions in all calls
+        boost::uint64_t num_decisions() const {return m_num_decisions;}
+        /// @return number of learned clauses kept
+        std::size_t num_learnt_clauses() const {return m_num_learnts;}
+
+    protected:
+        /// @brief a clause in the arena of literals
+        struct clause_type
+        {
+            boost::uint32_t begin; ///< first literal in m_vClauseLit
+            boost::uint32_t size; ///< number of literals
+            boost::uint32_t lbd; ///< number of decision levels of a learned clause, 0 for original clauses
+        };
+        /// @brief a clause watching a literal, with a literal to skip the clause if true
+        struct watcher_type
+        {
+            boost::uint32_t clause; ///< index of clause
+            literal_type blocker; ///< another literal of the clause
+            /// @brief constructor
+            watcher_type(boost::uint32_t c, literal_type b) : clause(c), blocker(b) {}
+        };
+        /// @brief values of variables and literals
+        enum ValueType
+        {
+            FALSE_VALUE = 0,
+            TRUE_VALUE = 1,
+            UNDEF_VALUE = 2
+        };
+
+        /// @brief reasons other than clauses
+        enum ReasonType
+        {
+            no_reason = -1, ///< decision or unassigned
+            cost_reason = -2 ///< implied or conflicted by the cost bound
+        };
+
+        /// @return value of a literal
+        boost::uint8_t value_of(literal_type l) const
+        {
+            boost::uint8_t a = m_vAssign[l>>1];
+            return (a == UNDEF_VALUE)? a : (a^(l&1));
+        }
+        /// @return current decision level
+        boost::uint32_t decision_level() const {return m_vTrailLim.size();}
+        /// @brief add the clause in m_vTmp
+        bool add_clause_tmp() {return add_clause(m_vTmp);}
+        /// @brief assign a literal to true
+        void enqueue(literal_type l, boost::int32_t reason);
+        /// @brief attach a clause of at least two literals
+        boost::uint32_t attach(literal_type const* lits, boost::uint32_t size, boost::uint32_t lbd);
+        /// @brief propagate clauses and the cost bound
+        /// @return index of conflicting clause, @ref cost_reason for the bound, @ref no_reason if no conflict
+        boost::int32_t propagate();
+        /// @brief check the bound and set literals that would exceed it to false
+        /// @return true if the bound is exceeded
+        bool propagate_cost();
+        /// @brief literals of the reason of an assigned variable, the true literal first,
+        /// or of a conflict if v is out of range
+        /// @param v variable
+        /// @param reason reason of the variable or the conflict
+        /// @param vLit output literals
+        void reason_literals(boost::uint32_t v, boost::int32_t reason, std::vector<literal_type>& vLit) const;
+        /// @brief learn a clause from a conflict
+        /// @param conflict index of conflicting clause or @ref cost_reason
+        /// @param vLearnt learned clause with the asserting literal first
+        /// @return level to backtrack to
+        boost::uint32_t analyze(boost::int32_t conflict, std::vector<literal_type>& vLearnt);
+        /// @return true if a literal of a learned clause is implied by the other ones
+        bool redundant(literal_type l) const;
+        /// @brief undo assignments above a level
+        void backtrack(boost::uint32_t level);
+        /// @brief search until a solution, a conflict at level 0 or a number of conflicts
+        StatusType search(boost::uint64_t num_conflicts, std::vector<literal_type> const& vAssumption);
+        /// @brief remove half of the learned clauses with large LBD, at level 0
+        void reduce_learnts();
+        /// @brief increase the activity of a variable
+        void bump(boost::uint32_t v);
+        /// @name heap of variables by activity
+        ///@{
+        void heap_insert(boost::uint32_t v);
+        boost::uint32_t heap_pop();
+        void heap_up(boost::uint32_t i);
+        void heap_down(boost::uint32_t i);
+        ///@}
+        /// @return Luby sequence with base 2
+        static double luby(boost::uint32_t i);
+        /// @return wall time in seconds
+        static double wall_time()
+        {
+            timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return ts.tv_sec+ts.tv_nsec*1e-9;
+        }
+
+        bool m_ok; ///< false if the clauses are unsatisfiable
+        std::vector<boost::uint8_t> m_vAssign; ///< value of each variable
+        std::vector<boost::uint32_t> m_vLevel; ///< decision level of each variable
+        std::vector<boost::int32_t> m_vReason; ///< reason of each variable
+        std::vector<boost::uint32_t> m_vTrailPos; ///< position of each variable in the trail
+        std::vector<boost::uint32_t> m_vCostMark; ///< size of the cost trail when a variable is implied by the bound
+        std::vector<char> m_vPolarity; ///< saved phase, 1 for negative
+        std::vector<char> m_vSeen; ///< flags of analysis
+        std::vector<double> m_vActivity; ///< activity of each variable
+        std::vector<boost::uint32_t> m_vHeap; ///< heap of unassigned variables by activity
+        std::vector<boost::int32_t> m_vHeapPos; ///< position of each variable in the heap, -1 if not in it
+        double m_var_inc; ///< bump of activity
+        std::vector<literal_type> m_vTrail; ///< assigned literals in order
+        std::vector<boost::uint32_t> m_vTrailLim; ///< start of each decision level in the trail
+        boost::uint32_t m_qhead; ///< next literal of the trail to propagate
+
+        std::vector<literal_type> m_vClauseLit; ///< literals of all clauses
+        std::vector<clause_type> m_vClause; ///< clauses
+        std::vector<std::vector<watcher_type> > m_vWatch; ///< clauses watching each literal
+        std::size_t m_num_learnts; ///< number of learned clauses
+        std::size_t m_max_learnts; ///< number of learned clauses to trigger a reduction
+
+        std::vector<double> m_vLitCost; ///< cost of each literal
+        std::vector<literal_type> m_vCostLit; ///< literals with costs by decreasing costs
+        bool m_cost_sorted; ///< whether m_vCostLit is sorted
+        std::vector<literal_type> m_vCostTrail; ///< true literals with costs in the order of the trail
+        double m_cost_sum; ///< total cost of true literals
+        double m_bound; ///< bound of the total cost
+        double m_tolerance; ///< tolerance of the bound
+
+        std::vector<char> m_vModel; ///< last solution
+        boost::uint64_t m_max_conflicts; ///< limit of conflicts of each call
+        double m_time_limit; ///< time limit of each call in seconds, 0 for no limit
+        boost::uint64_t m_num_conflicts; ///< number of conflicts
+        boost::uint64_t m_num_decisions; ///< number of decisions
+        std::vector<literal_type> m_vTmp; ///< buffer of a clause
+};
+
+inline SatSolver::SatSolver()
+    : m_ok(true)
+    , m_var_inc(1)
+    , m_qhead(0)
+    , m_num_learnts(0)
+    , m_max_learnts(0)
+    , m_cost_sorted(true)
+    , m_cost_sum(0)
+    , m_bound(std::numeric_limits<double>::max())
+    , m_tolerance(0)
+    , m_max_conflicts(0)
+    , m_time_limit(0)
+    , m_num_conflicts(0)
+    , m_num_decisions(0)
+{
+}
+
+inline boost::uint32_t SatSolver::new_variable()
+{
+    boost::uint32_t v = m_vAssign.size();
+    m_vAssign.push_back(UNDEF_VALUE);
+    m_vLevel.push_back(0);
+    m_vReason.push_back(no_reason);
+    m_vTrailPos.push_back(0);
+    m_vCostMark.push_back(0);
+    m_vPolarity.push_back(1);
+    m_vSeen.push_back(0);
+    m_vActivity.push_back(0);
+    m_vHeapPos.push_back(-1);
+    m_vWatch.resize(2*(v+1));
+    m_vLitCost.resize(2*(v+1), 0);
+    m_vModel.push_back(false);
+    heap_insert(v);
+    return v;
+}
+
+inline bool SatSolver::add_clause(std::vector<literal_type> const& vLiteral)
+{
+    limboAssertMsg(decision_level() == 0, "clauses can only be added between calls");
+    if (!m_ok)
+        return false;
+    // drop false literals and duplicates, and skip satisfied clauses and tautologies
+    std::vector<literal_type> vLit (vLiteral);
+    std::sort(vLit.begin(), vLit.end());
+    boost::uint32_t j = 0;
+    for (boost::uint32_t i = 0; i < vLit.size(); ++i)
+    {
+        literal_type l = vLit[i];
+        limboAssertMsg(variable(l) < num_variables(), "unknown variable %u", variable(l));
+        if (value_of(l) == TRUE_VALUE || (i > 0 && vLit[i-1] == negate(l)))
+            return true;
+        if (value_of(l) == FALSE_VALUE || (j > 0 && vLit[j-1] == l))
+            continue;
+        vLit[j++] = l;
+    }
+    vLit.resize(j);
+    if (vLit.empty())
+        return m_ok = false;
+    if (vLit.size() == 1)
+    {
+        enqueue(vLit[0], no_reason);
+        return m_ok = (propagate() == no_reason);
+    }
+    attach(&vLit[0], vLit.size(), 0);
+    return true;
+}
+
+inline void SatSolver::add_cost(literal_type l, double cost)
+{
+    limboAssertMsg(decision_level() == 0, "costs can only be added between calls");
+    limboAssertMsg(cost > 0, "cost must be positive");
+    if (value_of(l) == TRUE_VALUE)
+    {
+        if (m_vLitCost[l] == 0)
+            m_vCostTrail.push_back(l);
+        m_cost_sum += cost;
+    }
+    if (m_vLitCost[l] == 0)
+        m_vCostLit.push_back(l);
+    m_vLitCost[l] += cost;
+    m_cost_sorted = false;
+}
+
+inline void SatSolver::cost_bound(double b)
+{
+    limboAssertMsg(b <= m_bound, "the cost bound can only decrease");
+    m_bound = b;
+    m_tolerance = 1e-9*(1+std::abs(b));
+}
+
+inline double SatSolver::model_cost() const
+{
+    double cost = 0;
+    for (std::vector<literal_type>::const_iterator it = m_vCostLit.begin(); it != m_vCostLit.end(); ++it)
+        if (m_vModel[variable(*it)] != (bool)(*it&1))
+            cost += m_vLitCost[*it];
+    return cost;
+}
+
+inline void SatSolver::enqueue(literal_type l, boost::int32_t reason)
+{
+    boost::uint32_t v = variable(l);
+    m_vAssign[v] = !(l&1);
+    m_vLevel[v] = decision_level();
+    m_vReason[v] = reason;
+    m_vTrailPos[v] = m_vTrail.size();
+    if (reason == cost_reason)
+        m_vCostMark[v] = m_vCostTrail.size();
+    m_vTrail.push_back(l);
+    if (m_vLitCost[l] > 0)
+    {
+        m_cost_sum += m_vLitCost[l];
+        m_vCostTrail.push_back(l);
+    }
+}
+
+inline boost::uint32_t SatSolver::attach(literal_type const* lits, boost::uint32_t size, boost::uint32_t lbd)
+{
+    clause_type c = {(boost::uint32_t)m_vClauseLit.size(), size, lbd};
+    m_vClauseLit.insert(m_vClauseLit.end(), lits, lits+size);
+    boost::uint32_t ci = m_vClause.size();
+    m_vClause.push_back(c);
+    m_vWatch[lits[0]].push_back(watcher_type(ci, lits[1]));
+    m_vWatch[lits[1]].push_back(watcher_type(ci, lits[0]));
+    if (lbd)
+        ++m_num_learnts;
+    return ci;
+}
+
+inline bool SatSolver::propagate_cost()
+{
+    if (m_cost_sum > m_bound+m_tolerance)
+        return true;
+    for (std::vector<literal_type>::const_iterator it = m_vCostLit.begin(); it != m_vCostLit.end(); ++it)
+    {
+        if (m_cost_sum+m_vLitCost[*it] <= m_bound+m_tolerance)
+            break;
+        if (value_of(*it) == UNDEF_VALUE)
+            enqueue(negate(*it), cost_reason);
+    }
+    return false;
+}
+
+inline boost::int32_t SatSolver::propagate()
+{
+    while (m_qhead < m_vTrail.size())
+    {
+        literal_type p = m_vTrail[m_qhead++];
+        if (m_vLitCost[p] > 0 && propagate_cost())
+            return cost_reason;
+        // clauses watching the false literal
+        literal_type false_lit = negate(p);
+        std::vector<watcher_type>& vWatch = m_vWatch[false_lit];
+        std::vector<watcher_type>::iterator i = vWatch.begin(), j = vWatch.begin(), ie = vWatch.end();
+        while (i != ie)
+        {
+            if (value_of(i->blocker) == TRUE_VALUE)
+            {
+                *j++ = *i++;
+                continue;
+            }
+            boost::uint32_t ci = i->clause;
+            clause_type const& c = m_vClause[ci];
+            literal_type* lits = &m_vClauseLit[c.begin];
+            if (lits[0] == false_lit)
+                std::swap(lits[0], lits[1]);
+            literal_type first = lits[0];
+            ++i;
+            if (value_of(first) == TRUE_VALUE)
+            {
+                *j++ = watcher_type(ci, first);
+                continue;
+            }
+            // look for a new literal to watch
+            bool found = false;
+            for (boost::uint32_t k = 2; k < c.size; ++k)
+            {
+                if (value_of(lits[k]) != FALSE_VALUE)
+                {
+                    std::swap(lits[1], lits[k]);
+                    m_vWatch[lits[1]].push_back(watcher_type(ci, first));
+                    found = true;
+                    break;
+                }
+            }
+            if (found)
+                continue;
+            *j++ = watcher_type(ci, first);
+            if (value_of(first) == FALSE_VALUE)
+            {
+                while (i != ie)
+                    *j++ = *i++;
+                vWatch.erase(j, vWatch.end());
+                m_qhead = m_vTrail.size();
+                return ci;
+            }
+            enqueue(first, ci);
+        }
+        vWatch.erase(j, vWatch.end());
+    }
+    return no_reason;
+}
+
+inline void SatSolver::reason_literals(boost::uint32_t v, boost::int32_t reason, std::vector<literal_type>& vLit) const
+{
+    vLit.clear();
+    if (reason >= 0)
+    {
+        clause_type const& c = m_vClause[reason];
+        vLit.assign(m_vClauseLit.begin()+c.begin, m_vClauseLit.begin()+c.begin+c.size);
+    }
+    else if (reason == cost_reason)
+    {
+        // the true literals with costs before the implied one, or all of them for a conflict
+        boost::uint32_t end = m_vCostTrail.size();
+        if (v < num_variables())
+        {
+            vLit.push_back(m_vTrail[m_vTrailPos[v]]);
+            end = m_vCostMark[v];
+        }
+        for (boost::uint32_t i = 0; i < end; ++i)
+            vLit.push_back(negate(m_vCostTrail[i]));
+    }
+}
+
+inline boost::uint32_t SatSolver::analyze(boost::int32_t conflict, std::vector<literal_type>& vLearnt)
+{
+    vLearnt.assign(1, 0);
+    std::vector<literal_type> vReason;
+    reason_literals(num_variables(), conflict, vReason);
+    boost::uint32_t path = 0;
+    boost::int32_t index = m_vTrail.size()-1;
+    literal_type p = 0;
+    bool first = true;
+    do
+    {
+        for (boost::uint32_t k = (first)? 0 : 1; k < vReason.size(); ++k)
+        {
+            literal_type q = vReason[k];
+            boost::uint32_t v = variable(q);
+            if (m_vSeen[v] || m_vLevel[v] == 0)
+                continue;
+            bump(v);
+            m_vSeen[v] = 1;
+            if (m_vLevel[v] >= decision_level())
+                ++path;
+            else
+                vLearnt.push_back(q);
+        }
+        // the next literal of the current level on the trail
+        while (!m_vSeen[variable(m_vTrail[index--])]);
+        p = m_vTrail[index+1];
+        m_vSeen[variable(p)] = 0;
+        reason_literals(variable(p), m_vReason[variable(p)], vReason);
+        first = false;
+        --path;
+    } while (path > 0);
+    vLearnt[0] = negate(p);
+
+    // remove literals implied by the others
+    std::vector<literal_type> vRemoved;
+    boost::uint32_t j = 1;
+    for (boost::uint32_t i = 1; i < vLearnt.size(); ++i)
+    {
+        if (m_vReason[variable(vLearnt[i])] == no_reason || !redundant(vLearnt[i]))
+            vLearnt[j++] = vLearnt[i];
+        else
+            vRemoved.push_back(vLearnt[i]);
+    }
+    vLearnt.resize(j);
+    for (std::vector<literal_type>::const_iterator it = vRemoved.begin(); it != vRemoved.end(); ++it)
+        m_vSeen[variable(*it)] = 0;
+
+    // the literal of the highest level other than the current one is watched with the asserting literal
+    boost::uint32_t level = 0;
+    for (boost::uint32_t i = 1; i < vLearnt.size(); ++i)
+    {
+        if (m_vLevel[variable(vLearnt[i])] > level)
+        {
+            level = m_vLevel[variable(vLearnt[i])];
+            std::swap(vLearnt[1], vLearnt[i]);
+        }
+    }
+    for (boost::uint32_t i = 0; i < vLearnt.size(); ++i)
+        m_vSeen[variable(vLearnt[i])] = 0;
+    return level;
+}
+
+inline bool SatSolver::redundant(literal_type l) const
+{
+    std::vector<literal_type> vReason;
+    boost::uint32_t v = variable(l);
+    reason_literals(v, m_vReason[v], vReason);
+    for (boost::uint32_t k = 1; k < vReason.size(); ++k)
+    {
+        boost::uint32_t u = variable(vReason[k]);
+        if (!m_vSeen[u] && m_vLevel[u] > 0)
+            return false;
+    }
+    return true;
+}
+
+inline void SatSolver::backtrack(boost::uint32_t level)
+{
+    if (decision_level() <= level)
+        return;
+    for (boost::int32_t i = (boost::int32_t)m_vTrail.size()-1, ie = m_vTrailLim[level]; i >= ie; --i)
+    {
+        literal_type l = m_vTrail[i];
+        boost::uint32_t v = variable(l);
+        if (m_vLitCost[l] > 0)
+        {
+            m_cost_sum -= m_vLitCost[l];
+            m_vCostTrail.pop_back();
+        }
+        m_vAssign[v] = UNDEF_VALUE;
+        m_vReason[v] = no_reason;
+        m_vPolarity[v] = (l&1);
+        if (m_vHeapPos[v] < 0)
+            heap_insert(v);
+    }
+    m_vTrail.resize(m_vTrailLim[level]);
+    m_vTrailLim.resize(level);
+    m_qhead = m_vTrail.size();
+    // avoid drift of the sum after many updates
+    if (level == 0)
+    {
+        m_cost_sum = 0;
+        for (std::vector<literal_type>::const_iterator it = m_vCostTrail.begin(); it != m_vCostTrail.end(); ++it)
+            m_cost_sum += m_vLitCost[*it];
+    }
+}
+
+inline SatSolver::StatusType SatSolver::search(boost::uint64_t num_conflicts, std::vector<literal_type> const& vAssumption)
+{
+    std::vector<literal_type> vLearnt;
+    boost::uint64_t conflicts = 0;
+    for (;;)
+    {
+        boost::int32_t conflict = propagate();
+        if (conflict != no_reason)
+        {
+            ++m_num_conflicts;
+            ++conflicts;
+            if (decision_level() == 0)
+            {
+                m_ok = false;
+                return UNSATISFIABLE;
+            }
+            boost::uint32_t level = analyze(conflict, vLearnt);
+            backtrack(level);
+            if (vLearnt.size() == 1)
+                enqueue(vLearnt[0], no_reason);
+            else
+            {
+                // number of distinct levels
+                std::vector<boost::uint32_t> vLevel;
+                for (boost::uint32_t i = 0; i < vLearnt.size(); ++i)
+                    vLevel.push_back(m_vLevel[variable(vLearnt[i])]);
+                std::sort(vLevel.begin(), vLevel.end());
+                boost::uint32_t lbd = std::unique(vLevel.begin(), vLevel.end())-vLevel.begin();
+                boost::uint32_t ci = attach(&vLearnt[0], vLearnt.size(), lbd);
+                enqueue(vLearnt[0], ci);
+            }
+            m_var_inc /= 0.95;
+        }
+        else
+        {
+            if (conflicts >= num_conflicts)
+            {
+                backtrack(0);
+                return UNKNOWN;
+            }
+            // assumptions take the first levels
+            literal_type next = 0;
+            bool decided = false;
+            while (decision_level() < vAssumption.size())
+            {
+                literal_type a = vAssumption[decision_level()];
+                if (value_of(a) == TRUE_VALUE)
+                    m_vTrailLim.push_back(m_vTrail.size());
+                else if (value_of(a) == FALSE_VALUE)
+                    return UNSATISFIABLE;
+                else
+                {
+                    next = a;
+                    decided = true;
+                    break;
+                }
+            }
+            while (!decided && !m_vHeap.empty())
+            {
+                boost::uint32_t v = heap_pop();
+                if (m_vAssign[v] == UNDEF_VALUE)
+                {
+                    next = literal(v, !m_vPolarity[v]);
+                    decided = true;
+                }
+            }
+            if (!decided)
+            {
+                for (boost::uint32_t v = 0; v < num_variables(); ++v)
+                    m_vModel[v] = (m_vAssign[v] == TRUE_VALUE);
+                return SATISFIABLE;
+            }
+            ++m_num_decisions;
+            m_vTrailLim.push_back(m_vTrail.size());
+            enqueue(next, no_reason);
+        }
+    }
+}
+
+inline SatSolver::StatusType SatSolver::solve(std::vector<literal_type> const& vAssumption)
+{
+    if (!m_ok)
+        return UNSATISFIABLE;
+    if (!m_cost_sorted)
+    {
+        std::vector<std::pair<double, literal_type> > vCost;
+        for (std::vector<literal_type>::const_iterator it = m_vCostLit.begin(); it != m_vCostLit.end(); ++it)
+            vCost.push_back(std::make_pair(-m_vLitCost[*it], *it));
+        std::sort(vCost.begin(), vCost.end());
+        for (boost::uint32_t i = 0; i < vCost.size(); ++i)
+            m_vCostLit[i] = vCost[i].second;
+        m_cost_sorted = true;
+    }
+    // a tighter bound may be exceeded or imply literals at level 0
+    if (propagate_cost() || propagate() != no_reason)
+    {
+        m_ok = false;
+        return UNSATISFIABLE;
+    }
+    if (m_max_learnts == 0)
+        m_max_learnts = std::max(m_vClause.size()/3, (std::size_t)2000);
+
+    StatusType status = UNKNOWN;
+    boost::uint64_t start = m_num_conflicts;
+    double deadline = (m_time_limit > 0)? wall_time()+m_time_limit : 0;
+    for (boost::uint32_t restart = 0; status == UNKNOWN; ++restart)
+    {
+        if (deadline > 0 && restart > 0 && wall_time() > deadline)
+            break;
+        boost::uint64_t budget = luby(restart)*100;
+        if (m_max_conflicts)
+        {
+            if (m_num_conflicts-start >= m_max_conflicts)
+                break;
+            budget = std::min(budget, m_max_conflicts-(m_num_conflicts-start));
+        }
+        status = search(budget, vAssumption);
+        if (status == UNKNOWN && m_num_learnts > m_max_learnts)
+        {
+            reduce_learnts();
+            m_max_learnts += m_max_learnts/10;
+        }
+    }
+    backtrack(0);
+    return status;
+}
+
+inline void SatSolver::reduce_learnts()
+{
+    // keep original clauses, glue clauses and the better half of the others by LBD, then rebuild watches
+    std::vector<std::pair<boost::uint32_t, boost::uint32_t> > vLearnt;
+    for (boost::uint32_t i = 0; i < m_vClause.size(); ++i)
+        if (m_vClause[i].lbd > 2)
+            vLearnt.push_back(std::make_pair(m_vClause[i].lbd, i));
+    std::sort(vLearnt.begin(), vLearnt.end());
+    std::vector<char> vRemove (m_vClause.size(), 0);
+    for (boost::uint32_t i = vLearnt.size()/2; i < vLearnt.size(); ++i)
+        vRemove[vLearnt[i].second] = 1;
+    // clauses are reasons of level 0 only, which are never analyzed
+    std::vector<boost::int32_t> vIndex (m_vClause.size(), -1);
+    std::vector<literal_type> vClauseLit;
+    std::vector<clause_type> vClause;
+    vClauseLit.reserve(m_vClauseLit.size());
+    m_num_learnts = 0;
+    for (boost::uint32_t i = 0; i < m_vClause.size(); ++i)
+    {
+        if (vRemove[i])
+            continue;
+        clause_type c = m_vClause[i];
+        vIndex[i] = vClause.size();
+        c.begin = vClauseLit.size();
+        vClauseLit.insert(vClauseLit.end(), m_vClauseLit.begin()+m_vClause[i].begin, m_vClauseLit.begin()+m_vClause[i].begin+c.size);
+        vClause.push_back(c);
+        m_num_learnts += (c.lbd > 0);
+    }
+    m_vClauseLit.swap(vClauseLit);
+    m_vClause.swap(vClause);
+    for (boost::uint32_t v = 0; v < num_variables(); ++v)
+        if (m_vReason[v] >= 0)
+            m_vReason[v] = vIndex[m_vReason[v]];
+    for (std::vector<std::vector<watcher_type> >::iterator it = m_vWatch.begin(); it != m_vWatch.end(); ++it)
+        it->clear();
+    for (boost::uint32_t i = 0; i < m_vClause.size(); ++i)
+    {
+        literal_type const* lits = &m_vClauseLit[m_vClause[i].begin];
+        m_vWatch[lits[0]].push_back(watcher_type(i, lits[1]));
+        m_vWatch[lits[1]].push_back(watcher_type(i, lits[0]));
+    }
+}
+
+inline void SatSolver::bump(boost::uint32_t v)
+{
+    if ((m_vActivity[v] += m_var_inc) > 1e100)
+    {
+        for (boost::uint32_t u = 0; u < num_variables(); ++u)
+            m_vActivity[u] *= 1e-100;
+        m_var_inc *= 1e-100;
+    }
+    if (m_vHeapPos[v] >= 0)
+        heap_up(m_vHeapPos[v]);
+}
+
+inline void SatSolver::heap_insert(boost::uint32_t v)
+{
+    m_vHeapPos[v] = m_vHeap.size();
+    m_vHeap.push_back(v);
+    heap_up(m_vHeap.size()-1);
+}
+
+inline boost::uint32_t SatSolver::heap_pop()
+{
+    boost::uint32_t v = m_vHeap[0];
+    m_vHeap[0] = m_vHeap.back();
+    m_vHeapPos[m_vHeap[0]] = 0;
+    m_vHeap.pop_back();
+    m_vHeapPos[v] = -1;
+    if (!m_vHeap.empty())
+        heap_down(0);
+    return v;
+}
+
+inline void SatSolver::heap_up(boost::uint32_t i)
+{
+    boost::uint32_t v = m_vHeap[i];
+    while (i > 0)
+    {
+        boost::uint32_t parent = (i-1)>>1;
+        if (m_vActivity[m_vHeap[parent]] >= m_vActivity[v])
+            break;
+        m_vHeap[i] = m_vHeap[parent];
+        m_vHeapPos[m_vHeap[i]] = i;
+        i = parent;
+    }
+    m_vHeap[i] = v;
+    m_vHeapPos[v] = i;
+}
+
+inline void SatSolver::heap_down(boost::uint32_t i)
+{
+    boost::uint32_t v = m_vHeap[i];
+    boost::uint32_t n = m_vHeap.size();
+    for (;;)
+    {
+        boost::uint32_t child = 2*i+1;
+        if (child >= n)
+            break;
+        if (child+1 < n && m_vActivity[m_vHeap[child+1]] > m_vActivity[m_vHeap[child]])
+            ++child;
+        if (m_vActivity[m_vHeap[child]] <= m_vActivity[v])
+            break;
+        m_vHeap[i] = m_vHeap[child];
+        m_vHeapPos[m_vHeap[i]] = i;
+        i = child;
+    }
+    m_vHeap[i] = v;
+    m_vHeapPos[v] = i;
+}
+
+inline double SatSolver::luby(boost::uint32_t i)
+{
+    // find the finite subsequence containing i and its position in it
+    boost::uint32_t size = 1;
+    boost::uint32_t seq = 0;
+    while (size < i+1)
+    {
+        ++seq;
+        size = 2*size+1;
+    }
+    while (size-1 != i)
+    {
+        size = (size-1)>>1;
+        --seq;
+        i = i%size;
+    }
+    return (double)(1UL<<seq);
+}
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
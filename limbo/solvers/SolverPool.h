@@ -0,0 +1,267 @@
+/**
+ * @file   SolverPool.h
+ * @brief  Solve many independent @ref limbo::solvers::LinearModel concurrently on a pool of solver environments
+ * @date   Oct 2026
+ */
+
+#ifndef LIMBO_SOLVERS_SOLVERPOOL_H
+#define LIMBO_SOLVERS_SOLVERPOOL_H
+
+#include <deque>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+#include <boost/shared_ptr.hpp>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/solvers/Solvers.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Solvers
+namespace solvers
+{
+
+/// @brief Result of a solve submitted to a @ref limbo::solvers::SolverPool.
+/// Copies refer to the same solve.
+class SolverFuture
+{
+    public:
+        /// @brief construct an invalid future
+        SolverFuture() {}
+
+        /// @return true if the future refers to a solve
+        bool valid() const {return m_state.get() != NULL;}
+        /// @return true if the solve has finished
+        bool ready() const
+        {
+            pthread_mutex_lock(&m_state->mutex);
+            bool done = m_state->done;
+            pthread_mutex_unlock(&m_state->mutex);
+            return done;
+        }
+        /// @brief block until the solve has finished
+        void wait() const
+        {
+            pthread_mutex_lock(&m_state->mutex);
+            while (!m_state->done)
+                pthread_cond_wait(&m_state->cond, &m_state->mutex);
+            pthread_mutex_unlock(&m_state->mutex);
+        }
+        /// @brief block until the solve has finished; solutions are then in the model
+        /// @return status of the solve
+        SolverProperty get() const
+        {
+            wait();
+            return m_state->status;
+        }
+
+    protected:
+        template <typename SolverBackend>
+        friend class SolverPool;
+
+        /// @brief state shared by the pool and the copies of a future
+        struct State
+        {
+            pthread_mutex_t mutex; ///< protect @ref done
+            pthread_cond_t cond; ///< signaled when @ref done is set
+            bool done; ///< whether the solve has finished
+            SolverProperty status; ///< status of the solve
+
+            /// @brief constructor
+            State() : done(false), status(INFEASIBLE)
+            {
+                pthread_mutex_init(&mutex, NULL);
+                pthread_cond_init(&cond, NULL);
+            }
+            /// @brief destructor
+            ~State()
+            {
+                pthread_cond_destroy(&cond);
+                pthread_mutex_destroy(&mutex);
+            }
+        };
+
+        /// @brief finish the solve and wake up waiting threads
+        /// @param status status of the solve
+        void set(SolverProperty status)
+        {
+            pthread_mutex_lock(&m_state->mutex);
+            m_state->status = status;
+            m_state->done = true;
+            pthread_cond_broadcast(&m_state->cond);
+            pthread_mutex_unlock(&m_state->mutex);
+        }
+
+        boost::shared_ptr<State> m_state; ///< shared state, NULL if invalid
+};
+
+/// @brief Thread-safe pool of solver environments for many independent small models,
+/// e.g., the ILPs of components in coloring and partitioning flows.
+///
+/// Each worker thread owns one environment, created with a fixed number of solver threads,
+/// so environments are never shared between concurrent solves and loaded only once for the pool.
+/// The number of models in flight times the solver threads per model is the CPU budget of the pool.
+/// Models are solved in the order of submission; a model must not be accessed until its future is ready.
+///
+/// The backend provides the types model_type, parameter_type and environment_type, and the static functions
+/// @code
+/// environment_type* createEnvironment(int numThreads);
+/// void destroyEnvironment(environment_type* env);
+/// SolverProperty solve(environment_type* env, model_type* model, parameter_type const* param);
+/// @endcode
+/// e.g., @ref limbo::solvers::GurobiPoolBackend.
+/// @tparam SolverBackend solver backend
+template <typename SolverBackend>
+class SolverPool
+{
+    public:
+        /// @nowarn
+        typedef SolverBackend backend_type;
+        typedef typename backend_type::model_type model_type;
+        typedef typename backend_type::parameter_type parameter_type;
+        typedef typename backend_type::environment_type environment_type;
+        /// @endnowarn
+
+        /// @brief constructor, start the workers and load their environments
+        /// @param numModels number of models in flight, i.e., environments;
+        /// 0 to fill the online processors with \a threadsPerModel threads each
+        /// @param threadsPerModel number of solver threads per model, at least 1
+        /// @param maxPending maximum number of submitted models waiting for a worker;
+        /// @ref submit blocks when reached, 0 for no limit
+        SolverPool(unsigned int numModels = 0, unsigned int threadsPerModel = 1, unsigned int maxPending = 0)
+            : m_threadsPerModel(std::max(threadsPerModel, 1U))
+            , m_maxPending(maxPending)
+            , m_numRunning(0)
+            , m_stop(false)
+        {
+            if (numModels == 0)
+            {
+                long numProcessors = limbo::containers::num_threads();
+                numModels = std::max(numProcessors, 1L)/m_threadsPerModel;
+            }
+            numModels = std::max(numModels, 1U);
+            pthread_mutex_init(&m_mutex, NULL);
+            pthread_cond_init(&m_condWork, NULL);
+            pthread_cond_init(&m_condSpace, NULL);
+            pthread_cond_init(&m_condIdle, NULL);
+            m_vThread.resize(numModels);
+            for (unsigned int i = 0; i < numModels; ++i)
+            {
+                int error = pthread_create(&m_vThread[i], NULL, SolverPool::workerThread, this);
+                limboAssertMsg(error == 0, "failed to create solver thread %u", i);
+            }
+        }
+        /// @brief destructor, finish the submitted models and free the environments
+        ~SolverPool()
+        {
+            pthread_mutex_lock(&m_mutex);
+            m_stop = true;
+            pthread_cond_broadcast(&m_condWork);
+            pthread_mutex_unlock(&m_mutex);
+            for (unsigned int i = 0; i < m_vThread.size(); ++i)
+                pthread_join(m_vThread[i], NULL);
+            pthread_cond_destroy(&m_condIdle);
+            pthread_cond_destroy(&m_condSpace);
+            pthread_cond_destroy(&m_condWork);
+            pthread_mutex_destroy(&m_mutex);
+        }
+
+        /// @brief schedule a model to solve, thread-safe
+        /// @param model model to solve, solutions are written back to it
+        /// @param param parameters shared by concurrent solves, use default if NULL;
+        /// the model and the parameters must be alive until the future is ready
+        /// @return future of the solve
+        SolverFuture submit(model_type* model, parameter_type const* param = NULL)
+        {
+            Job job;
+            job.model = model;
+            job.param = param;
+            job.future.m_state.reset(new SolverFuture::State);
+
+            pthread_mutex_lock(&m_mutex);
+            while (m_maxPending && m_qJob.size() >= m_maxPending)
+                pthread_cond_wait(&m_condSpace, &m_mutex);
+            m_qJob.push_back(job);
+            pthread_cond_signal(&m_condWork);
+            pthread_mutex_unlock(&m_mutex);
+            return job.future;
+        }
+        /// @brief block until all submitted models are solved
+        void wait()
+        {
+            pthread_mutex_lock(&m_mutex);
+            while (!m_qJob.empty() || m_numRunning)
+                pthread_cond_wait(&m_condIdle, &m_mutex);
+            pthread_mutex_unlock(&m_mutex);
+        }
+
+        /// @return number of models in flight
+        unsigned int numModels() const {return m_vThread.size();}
+        /// @return number of solver threads per model
+        unsigned int threadsPerModel() const {return m_threadsPerModel;}
+
+    protected:
+        /// @brief a submitted model
+        struct Job
+        {
+            model_type* model; ///< model to solve
+            parameter_type const* param; ///< parameters
+            SolverFuture future; ///< result
+        };
+
+        /// @brief worker loop, solve models with the environment of the worker
+        /// @param arg pointer to the pool
+        /// @return NULL
+        static void* workerThread(void* arg)
+        {
+            SolverPool& pool = *static_cast<SolverPool*>(arg);
+            environment_type* env = backend_type::createEnvironment(pool.m_threadsPerModel);
+            pthread_mutex_lock(&pool.m_mutex);
+            while (true)
+            {
+                while (pool.m_qJob.empty() && !pool.m_stop)
+                    pthread_cond_wait(&pool.m_condWork, &pool.m_mutex);
+                if (pool.m_qJob.empty())
+                    break;
+                Job job = pool.m_qJob.front();
+                pool.m_qJob.pop_front();
+                ++pool.m_numRunning;
+                pthread_cond_signal(&pool.m_condSpace);
+                pthread_mutex_unlock(&pool.m_mutex);
+
+                job.future.set(backend_type::solve(env, job.model, job.param));
+
+                pthread_mutex_lock(&pool.m_mutex);
+                --pool.m_numRunning;
+                if (pool.m_qJob.empty() && pool.m_numRunning == 0)
+                    pthread_cond_broadcast(&pool.m_condIdle);
+            }
+            pthread_mutex_unlock(&pool.m_mutex);
+            backend_type::destroyEnvironment(env);
+            return NULL;
+        }
+
+        /// @brief copy constructor, forbidden
+        /// @param rhs right hand side
+        SolverPool(SolverPool const& rhs);
+        /// @brief assignment, forbidden
+        /// @param rhs right hand side
+        SolverPool& operator=(SolverPool const& rhs);
+
+        std::vector<pthread_t> m_vThread; ///< worker threads, one environment each
+        unsigned int m_threadsPerModel; ///< number of solver threads per model
+        unsigned int m_maxPending; ///< maximum number of waiting models, 0 for no limit
+        std::deque<Job> m_qJob; ///< submitted models waiting for a worker
+        unsigned int m_numRunning; ///< number of models being solved
+        bool m_stop; ///< whether workers exit when no model is waiting
+        pthread_mutex_t m_mutex; ///< protect the queue and the counters
+        pthread_cond_t m_condWork; ///< signaled when a model is submitted or the pool stops
+        pthread_cond_t m_condSpace; ///< signaled when a model leaves the queue
+        pthread_cond_t m_condIdle; ///< signaled when all submitted models are solved
+};
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
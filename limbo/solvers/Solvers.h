@@ -8,14 +8,25 @@
 #ifndef LIMBO_SOLVERS_SOLVERS_H
 #define LIMBO_SOLVERS_SOLVERS_H
 
+#include <cstdio>
 #include <iostream>
+#include <fstream>
 #include <limits>
 #include <string>
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <utility>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/containers/LargeMemory.h>
 #include <limbo/preprocessor/Msg.h>
+#include <limbo/preprocessor/MemoryUsage.h>
 #include <limbo/math/Math.h>
+#include <limbo/string/CharConv.h>
 #include <limbo/parsers/lp/bison/LpDriver.h>
 
 /// namespace for Limbo 
@@ -639,6 +650,23 @@ class LinearExpression
                 copy(rhs);
             return *this;
         }
+#if __cplusplus >= 201103L
+        /// @brief move constructor 
+        /// @param rhs right hand side 
+        LinearExpression(LinearExpression&& rhs) noexcept
+            : m_vTerm(std::move(rhs.m_vTerm))
+            , m_constant(rhs.m_constant)
+        {
+        }
+        /// @brief move assignment 
+        /// @param rhs right hand side 
+        LinearExpression& operator=(LinearExpression&& rhs) noexcept
+        {
+            m_vTerm.swap(rhs.m_vTerm);
+            m_constant = rhs.m_constant; 
+            return *this;
+        }
+#endif
         /// @brief destructor 
         ~LinearExpression()
         {
@@ -653,6 +681,8 @@ class LinearExpression
         }
         /// @return terms 
         std::vector<term_type> const& terms() const {return m_vTerm;}
+        /// @return terms 
+        std::vector<term_type>& terms() {return m_vTerm;}
         /// @brief clear expression 
         void clear() 
         {
@@ -923,19 +953,225 @@ class LinearExpression
         {
             return LinearConstraint<coefficient_value_type>(expr, rhs, '=');
         }
+#if __cplusplus >= 201103L
+        /// @name operators on temporary expressions 
+        /// A temporary expression, e.g., in a chain like x+y+z <= 1, is updated in place and moved to the result, 
+        /// so the terms are not copied for each operator. 
+        ///@{
+        /// overload plus 
+        /// @param expr temporary expression 
+        /// @param constant right hand side is a constant 
+        /// @return result object 
+        friend LinearExpression operator+(LinearExpression&& expr, coefficient_value_type constant)
+        {
+            expr += constant; 
+            return std::move(expr); 
+        }
+        /// overload plus 
+        /// @param expr temporary expression 
+        /// @param term right hand side is a term 
+        /// @return result object 
+        friend LinearExpression operator+(LinearExpression&& expr, term_type const& term)
+        {
+            expr += term; 
+            return std::move(expr); 
+        }
+        /// overload plus constant+expr
+        /// @param constant constant
+        /// @param expr temporary expression 
+        /// @return result object 
+        friend LinearExpression operator+(coefficient_value_type constant, LinearExpression&& expr)
+        {
+            return std::move(expr)+constant; 
+        }
+        /// overload plus term+expr 
+        /// @param term a term 
+        /// @param expr temporary expression 
+        /// @return result object 
+        friend LinearExpression operator+(term_type const& term, LinearExpression&& expr)
+        {
+            return std::move(expr)+term; 
+        }
+        /// overload plus expr+expr 
+        /// @param expr1 temporary expression 
+        /// @param expr2 expression
+        /// @return result object 
+        friend LinearExpression operator+(LinearExpression&& expr1, LinearExpression const& expr2)
+        {
+            expr1 += expr2; 
+            return std::move(expr1); 
+        }
+        /// overload plus expr+expr 
+        /// @param expr1 expression 
+        /// @param expr2 temporary expression
+        /// @return result object 
+        friend LinearExpression operator+(LinearExpression const& expr1, LinearExpression&& expr2)
+        {
+            return std::move(expr2)+expr1; 
+        }
+        /// overload plus expr+expr 
+        /// @param expr1 temporary expression 
+        /// @param expr2 temporary expression
+        /// @return result object 
+        friend LinearExpression operator+(LinearExpression&& expr1, LinearExpression&& expr2)
+        {
+            return std::move(expr1)+expr2; 
+        }
+        /// overload minus 
+        /// @param expr temporary expression 
+        /// @param constant right hand side is a constant 
+        /// @return result object 
+        friend LinearExpression operator-(LinearExpression&& expr, coefficient_value_type constant)
+        {
+            expr -= constant; 
+            return std::move(expr); 
+        }
+        /// overload minus 
+        /// @param expr temporary expression 
+        /// @param term right hand side is a term 
+        /// @return result object 
+        friend LinearExpression operator-(LinearExpression&& expr, term_type const& term)
+        {
+            expr -= term; 
+            return std::move(expr); 
+        }
+        /// overload minus constant-expr
+        /// @param constant constant 
+        /// @param expr temporary expression 
+        /// @return result object 
+        friend LinearExpression operator-(coefficient_value_type constant, LinearExpression&& expr)
+        {
+            expr.negate(); 
+            return std::move(expr)+constant; 
+        }
+        /// overload minus term-expr
+        /// @param term term 
+        /// @param expr temporary expression 
+        /// @return result object 
+        friend LinearExpression operator-(term_type const& term, LinearExpression&& expr)
+        {
+            expr.negate(); 
+            return std::move(expr)+term; 
+        }
+        /// overload minus 
+        /// @param expr1 temporary expression 
+        /// @param expr2 expression 
+        /// @return result object 
+        friend LinearExpression operator-(LinearExpression&& expr1, LinearExpression const& expr2)
+        {
+            expr1 -= expr2; 
+            return std::move(expr1); 
+        }
+        /// overload minus 
+        /// @param expr1 expression 
+        /// @param expr2 temporary expression 
+        /// @return result object 
+        friend LinearExpression operator-(LinearExpression const& expr1, LinearExpression&& expr2)
+        {
+            expr2.negate(); 
+            return std::move(expr2)+expr1; 
+        }
+        /// overload minus 
+        /// @param expr1 temporary expression 
+        /// @param expr2 temporary expression 
+        /// @return result object 
+        friend LinearExpression operator-(LinearExpression&& expr1, LinearExpression&& expr2)
+        {
+            return std::move(expr1)-expr2; 
+        }
+        /// overload multiply 
+        /// @param expr temporary expression 
+        /// @param c constant value 
+        /// @return result object 
+        friend LinearExpression operator*(LinearExpression&& expr, coefficient_value_type c)
+        {
+            expr *= c; 
+            return std::move(expr); 
+        }
+        /// overload multiply in case of c*expr 
+        /// @param c constant value 
+        /// @param expr temporary expression 
+        /// @return result object 
+        friend LinearExpression operator*(coefficient_value_type c, LinearExpression&& expr)
+        {
+            return std::move(expr)*c; 
+        }
+        /// overload divide  
+        /// @param expr temporary expression 
+        /// @param c constant value 
+        /// @return result object 
+        friend LinearExpression operator/(LinearExpression&& expr, coefficient_value_type c)
+        {
+            expr /= c; 
+            return std::move(expr); 
+        }
+        /// overload negation 
+        /// @param expr temporary expression 
+        /// @return result object 
+        friend LinearExpression operator-(LinearExpression&& expr)
+        {
+            expr.negate(); 
+            return std::move(expr); 
+        }
+        /// @brief overload < 
+        /// @param expr temporary expression 
+        /// @param rhs right hand side constant 
+        friend LinearConstraint<coefficient_value_type> operator<(LinearExpression&& expr, coefficient_value_type rhs)
+        {
+            return LinearConstraint<coefficient_value_type>(std::move(expr), rhs, '<');
+        }
+        /// @brief overload <=, same as < 
+        /// @param expr temporary expression 
+        /// @param rhs right hand side constant 
+        friend LinearConstraint<coefficient_value_type> operator<=(LinearExpression&& expr, coefficient_value_type rhs)
+        {
+            return std::move(expr) < rhs;
+        }
+        /// @brief overload > 
+        /// @param expr temporary expression 
+        /// @param rhs right hand side constant 
+        friend LinearConstraint<coefficient_value_type> operator>(LinearExpression&& expr, coefficient_value_type rhs)
+        {
+            return LinearConstraint<coefficient_value_type>(std::move(expr), rhs, '>');
+        }
+        /// @brief overload >=, same as >
+        /// @param expr temporary expression 
+        /// @param rhs right hand side constant 
+        friend LinearConstraint<coefficient_value_type> operator>=(LinearExpression&& expr, coefficient_value_type rhs)
+        {
+            return std::move(expr) > rhs;
+        }
+        /// overload == 
+        /// @param expr temporary expression 
+        /// @param rhs right hand side constant 
+        friend LinearConstraint<coefficient_value_type> operator==(LinearExpression&& expr, coefficient_value_type rhs)
+        {
+            return LinearConstraint<coefficient_value_type>(std::move(expr), rhs, '=');
+        }
+        ///@}
+#endif
 
         /// @brief simplify expression by merge terms of the same variables 
         /// and remove terms with zero coefficients 
         void simplify()
         {
-            if (m_vTerm.empty())
-                return;
-            std::sort(m_vTerm.begin(), m_vTerm.end(), CompareTermByVariable()); 
+            m_vTerm.erase(simplify(m_vTerm.begin(), m_vTerm.end()), m_vTerm.end());
+        }
+        /// @brief simplify a range of terms in place by merge terms of the same variables 
+        /// and remove terms with zero coefficients 
+        /// @param first begin of the range 
+        /// @param last end of the range 
+        /// @return end of the simplified terms 
+        template <typename Iterator>
+        static Iterator simplify(Iterator first, Iterator last)
+        {
+            if (first == last)
+                return last;
+            std::sort(first, last, CompareTermByVariable()); 
             // merge terms 
-            typename std::vector<term_type>::iterator itw = m_vTerm.begin(); // write iterator 
-            typename std::vector<term_type>::iterator itr = m_vTerm.begin(); // read iterator 
-            typename std::vector<term_type>::iterator ite = m_vTerm.end();
-            for (; itr != ite; ++itr)
+            Iterator itw = first; // write iterator 
+            Iterator itr = first; // read iterator 
+            for (; itr != last; ++itr)
             {
                 if (itr != itw)
                 {
@@ -948,20 +1184,26 @@ class LinearExpression
                     }
                 }
             }
-            m_vTerm.resize(std::distance(m_vTerm.begin(), itw+1));
+            last = itw+1; 
             // remove terms with zero coefficients 
             // the order is not maintained 
-            for (itr = m_vTerm.begin(); itr != m_vTerm.end(); )
+            for (itr = first; itr != last; )
             {
                 if (itr->coefficient() == 0)
                 {
-                    *itr = m_vTerm.back(); 
-                    m_vTerm.pop_back(); 
+                    --last; 
+                    *itr = *last; 
                 }
                 else 
                     ++itr; 
             }
+            return last; 
         }
+        /// @brief replace terms by a range of terms 
+        /// @param first begin of the range 
+        /// @param last end of the range 
+        template <typename Iterator>
+        void assign(Iterator first, Iterator last) {m_vTerm.assign(first, last);}
 
     protected:
         /// @brief copy object 
@@ -997,10 +1239,12 @@ class LinearConstraint
         /// @param s sense 
         LinearConstraint(expression_type expr = expression_type(), coefficient_value_type rhs = 0, char s = '<')
             : m_id (std::numeric_limits<unsigned int>::max())
-            , m_expr(expr)
+            , m_expr()
             , m_rhs(rhs)
             , m_sense(s)
         {
+            // \a expr is already a copy 
+            m_expr.swap(expr); 
             clearConstant();
         }
         /// @brief copy constructor 
@@ -1015,6 +1259,22 @@ class LinearConstraint
                 copy(rhs);
             return *this; 
         }
+#if __cplusplus >= 201103L
+        /// @brief move constructor 
+        LinearConstraint(LinearConstraint&& rhs) noexcept
+            : m_id(rhs.m_id)
+            , m_expr(std::move(rhs.m_expr))
+            , m_rhs(rhs.m_rhs)
+            , m_sense(rhs.m_sense)
+        {
+        }
+        /// @brief move assignment 
+        LinearConstraint& operator=(LinearConstraint&& rhs) noexcept
+        {
+            swap(rhs); 
+            return *this; 
+        }
+#endif
         /// @brief destructor 
         ~LinearConstraint()
         {
@@ -1219,6 +1479,18 @@ class LinearModel : public LpParser::LpDataBase
             expression_type expr = constr.expression();
             return emplaceConstraint(expr, constr.sense(), constr.rightHandSide(), name);
         }
+#if __cplusplus >= 201103L
+        /// @brief add a temporary constraint without copying its expression 
+        /// @param constr constraint 
+        /// @param name constraint name 
+        /// @return true if added 
+        bool addConstraint(constraint_type&& constr, std::string name = "") 
+        {
+            expression_type expr; 
+            constr.emplaceExpression(expr); 
+            return emplaceConstraint(expr, constr.sense(), constr.rightHandSide(), name);
+        }
+#endif
         /// @brief emplace a constraint 
         /// @param expr expression 
         /// @param sense sense 
@@ -1229,6 +1501,91 @@ class LinearModel : public LpParser::LpDataBase
         {
             // simplify expression 
             expr.simplify();
+            return emplaceSimplifiedConstraint(expr, sense, rhs, name);
+        }
+        /// @name batch construction of constraints 
+        /// Building a large model with @ref addConstraint allocates one expression per constraint and copies it several times. 
+        /// Alternatively, terms can be appended to one buffer shared by all pending constraints, 
+        /// and the constraints are simplified and added in one pass by @ref buildConstraints. 
+        /// The result is the same as adding the constraints one by one in the same order. 
+        ///@{
+        /// @brief reserve space for pending constraints 
+        /// @param numConstraints number of constraints 
+        /// @param numTerms total number of terms 
+        void reservePendingConstraints(unsigned int numConstraints, std::size_t numTerms)
+        {
+            m_vPendingTerm.reserve(numTerms);
+            m_vPendingEnd.reserve(numConstraints);
+            m_vPendingSense.reserve(numConstraints);
+            m_vPendingRhs.reserve(numConstraints);
+            m_vPendingName.reserve(numConstraints);
+        }
+        /// @brief append a term to the left hand side of the pending constraint 
+        /// @param var variable 
+        /// @param coef coefficient 
+        void appendConstraintTerm(variable_type const& var, coefficient_value_type coef)
+        {
+            m_vPendingTerm.push_back(term_type(var, coef));
+        }
+        /// @brief close the pending constraint, whose left hand side is the terms appended since the last call 
+        /// @param sense sense 
+        /// @param rhs right hand side 
+        /// @param name constraint name 
+        void closeConstraint(char sense, coefficient_value_type rhs, std::string const& name = "")
+        {
+            m_vPendingEnd.push_back(m_vPendingTerm.size());
+            m_vPendingSense.push_back(sense);
+            m_vPendingRhs.push_back(rhs);
+            m_vPendingName.push_back(name);
+        }
+        /// @return number of closed constraints not built yet 
+        unsigned int numPendingConstraints() const {return m_vPendingEnd.size();}
+        /// @brief simplify pending constraints and add them to the model, then release the buffer. 
+        /// Constraints with one term become bounds as in @ref addConstraint. 
+        /// Terms appended after the last @ref closeConstraint are discarded. 
+        /// @param numThreads maximum number of threads to simplify constraints 
+        /// @return number of constraints added, including bound constraints 
+        unsigned int buildConstraints(unsigned int numThreads = 1)
+        {
+            unsigned int numRows = m_vPendingEnd.size(); 
+            std::vector<std::size_t> vEnd (numRows); 
+            BuildPass pass; 
+            pass.model = this; 
+            pass.vEnd = vEnd.empty()? NULL : &vEnd[0]; 
+            // each thread simplifies blocks of rows in place 
+            numThreads = std::max(std::min(numThreads, limbo::containers::num_threads()), 1U);
+            limbo::containers::parallel_for(0, numRows, s_buildBlockSize, numThreads, pass);
+
+            m_vConstraint.reserve(m_vConstraint.size()+numRows);
+            m_vConstraintName.reserve(m_vConstraintName.size()+numRows);
+            unsigned int count = 0; 
+            expression_type expr; 
+            for (unsigned int i = 0; i < numRows; ++i)
+            {
+                expr.assign(m_vPendingTerm.begin()+pendingBegin(i), m_vPendingTerm.begin()+vEnd[i]);
+                count += emplaceSimplifiedConstraint(expr, m_vPendingSense[i], m_vPendingRhs[i], m_vPendingName[i]);
+            }
+            clearPendingConstraints();
+            return count; 
+        }
+        /// @brief discard pending constraints and release the buffer 
+        void clearPendingConstraints()
+        {
+            std::vector<term_type>().swap(m_vPendingTerm);
+            std::vector<std::size_t>().swap(m_vPendingEnd);
+            std::vector<char>().swap(m_vPendingSense);
+            std::vector<coefficient_value_type>().swap(m_vPendingRhs);
+            std::vector<std::string>().swap(m_vPendingName);
+        }
+        ///@}
+        /// @brief emplace a constraint whose expression has been simplified 
+        /// @param expr expression 
+        /// @param sense sense 
+        /// @param rhs right hand side 
+        /// @param name constraint name 
+        /// @return true if added 
+        bool emplaceSimplifiedConstraint(expression_type& expr, char sense, coefficient_value_type rhs, std::string const& name = "")
+        {
             // verify whether the constraint is actually a bound constraint 
             std::vector<term_type> const& vTerm = expr.terms();
             if (vTerm.empty())
@@ -1297,6 +1654,14 @@ class LinearModel : public LpParser::LpDataBase
             m_objective = expr;
             m_objective.simplify();
         }
+#if __cplusplus >= 201103L
+        /// @brief set objective from a temporary expression without copying it 
+        /// @param expr objective 
+        void setObjective(expression_type&& expr) 
+        {
+            emplaceObjective(expr);
+        }
+#endif
         /// @brief set objective by swaping with the expression 
         /// @param expr objective 
         void emplaceObjective(expression_type& expr)
@@ -1304,6 +1669,22 @@ class LinearModel : public LpParser::LpDataBase
             m_objective.swap(expr); 
             m_objective.simplify();
         }
+        /// @brief set the coefficient of a variable in the objective 
+        /// @param var variable 
+        /// @param coef coefficient 
+        void setObjectiveCoefficient(variable_type const& var, coefficient_value_type coef)
+        {
+            std::vector<term_type>& vTerm = m_objective.terms(); 
+            for (typename std::vector<term_type>::iterator it = vTerm.begin(); it != vTerm.end(); ++it)
+            {
+                if (it->variable() == var)
+                {
+                    it->setCoefficient(coef); 
+                    return; 
+                }
+            }
+            m_objective += term_type(var, coef); 
+        }
         /// @return optimization objective, whether maximize or minimize the objective 
         SolverProperty optimizeType() const {return m_optType;}
         /// @param optType optimization objective 
@@ -1400,6 +1781,30 @@ class LinearModel : public LpParser::LpDataBase
             for (unsigned int i = 0; i < n; ++i)
                 m_vConstraint[i].setId(i);
         }
+        /// @brief remove constraints, the remaining ones keep their order and are renumbered from 0 
+        /// @param vConstraintId indices of constraints to remove 
+        void removeConstraints(std::vector<unsigned int> const& vConstraintId)
+        {
+            std::vector<bool> vRemove (m_vConstraint.size(), false); 
+            for (std::vector<unsigned int>::const_iterator it = vConstraintId.begin(); it != vConstraintId.end(); ++it)
+                vRemove.at(*it) = true; 
+            unsigned int n = 0; 
+            for (unsigned int i = 0; i < m_vConstraint.size(); ++i)
+            {
+                if (!vRemove[i])
+                {
+                    if (n != i)
+                    {
+                        m_vConstraint[n].swap(m_vConstraint[i]); 
+                        m_vConstraintName[n].swap(m_vConstraintName[i]); 
+                    }
+                    m_vConstraint[n].setId(n); 
+                    ++n; 
+                }
+            }
+            m_vConstraint.resize(n); 
+            m_vConstraintName.resize(n); 
+        }
         /// @brief scale objective 
         /// @param factor scaling factor 
         void scaleObjective(coefficient_value_type factor) {m_objective *= factor;}
@@ -1457,6 +1862,66 @@ class LinearModel : public LpParser::LpDataBase
             for (unsigned int i = 0, ie = m_vConstraint.size(); i < ie; ++i)
                 limboPrint(kNONE, "C[%u] slack = %g\n", i, (double)evaluateConstraint(m_vConstraint.at(i)));
         }
+        /// @brief evaluate objective by threads over blocks of terms. 
+        /// Sums of blocks are added in order, so the result does not depend on the number of threads. 
+        /// @param vVariableSol variable solutions 
+        /// @param numThreads maximum number of threads 
+        /// @return objective after applying the solution 
+        coefficient_value_type evaluateObjective(std::vector<variable_value_type> const& vVariableSol, unsigned int numThreads) const 
+        {
+            std::size_t numTerms = m_objective.terms().size(); 
+            std::vector<coefficient_value_type> vBlockSum ((numTerms+s_evaluateBlockSize-1)/s_evaluateBlockSize, 0); 
+            ObjectiveKernel kernel; 
+            kernel.vTerm = (numTerms)? &m_objective.terms()[0] : NULL; 
+            kernel.vVariableSol = &vVariableSol; 
+            kernel.vBlockSum = (numTerms)? &vBlockSum[0] : NULL; 
+            runBlocks(kernel, numTerms, numThreads); 
+            coefficient_value_type result = m_objective.constant(); 
+            for (typename std::vector<coefficient_value_type>::const_iterator it = vBlockSum.begin(), ite = vBlockSum.end(); it != ite; ++it)
+                result += *it; 
+            return result; 
+        }
+        /// @brief evaluate slackness of all constraints by threads over blocks of constraints 
+        /// @param vVariableSol variable solutions 
+        /// @param vSlackness slackness of each constraint as in @ref evaluateConstraint 
+        /// @param numThreads maximum number of threads 
+        void evaluateConstraints(std::vector<variable_value_type> const& vVariableSol, std::vector<coefficient_value_type>& vSlackness, unsigned int numThreads = 1) const 
+        {
+            vSlackness.resize(m_vConstraint.size()); 
+            SlacknessKernel kernel; 
+            kernel.model = this; 
+            kernel.vVariableSol = &vVariableSol; 
+            kernel.vSlackness = (vSlackness.empty())? NULL : &vSlackness[0]; 
+            runBlocks(kernel, m_vConstraint.size(), numThreads); 
+        }
+        /// @brief check bounds of variables and constraints by threads over blocks 
+        /// @param vVariableSol variable solutions 
+        /// @param tolerance violation allowed for each bound or constraint 
+        /// @param numThreads maximum number of threads 
+        /// @return number of violated bounds and constraints, 0 if the solution is feasible 
+        std::size_t numViolations(std::vector<variable_value_type> const& vVariableSol, coefficient_value_type tolerance = 0, unsigned int numThreads = 1) const 
+        {
+            ViolationKernel kernel; 
+            kernel.model = this; 
+            kernel.vVariableSol = &vVariableSol; 
+            kernel.tolerance = tolerance; 
+            kernel.count = 0; 
+            runBlocks(kernel, std::max(m_vConstraint.size(), m_vVariableProperty.size()), numThreads); 
+            return kernel.count; 
+        }
+        /// @brief scale all constraints by threads over blocks of constraints 
+        /// @param vFactor scaling factor of each constraint, extra entries are ignored 
+        /// @param reciprocal true to divide constraints by the factors 
+        /// @param numThreads maximum number of threads 
+        void scaleConstraints(std::vector<coefficient_value_type> const& vFactor, bool reciprocal = false, unsigned int numThreads = 1) 
+        {
+            limboAssert(vFactor.size() >= m_vConstraint.size()); 
+            ScaleKernel kernel; 
+            kernel.vConstraint = (m_vConstraint.empty())? NULL : &m_vConstraint[0]; 
+            kernel.vFactor = (vFactor.empty())? NULL : &vFactor[0]; 
+            kernel.reciprocal = reciprocal; 
+            runBlocks(kernel, m_vConstraint.size(), numThreads); 
+        }
 
 		/// @brief read lp format 
         /// @param filename input file in lp format 
@@ -1546,6 +2011,133 @@ class LinearModel : public LpParser::LpDataBase
         }
         ///@}
 
+        /// @brief write problem to a binary file, which is much faster to write and to read back than lp format 
+        /// 
+        /// The file keeps variables with bounds, types, names and solutions, constraints in compressed sparse rows with names, 
+        /// and the objective. Numbers are in native byte order and types, so the file is only read by a model of the same types 
+        /// on the same kind of machine. 
+        /// @param filename output file name 
+        /// @return true if succeed; otherwise false 
+        bool writeBinary(std::string const& filename) const 
+        {
+            std::ofstream out (filename.c_str(), std::ios::out | std::ios::binary); 
+            if (!out.good())
+                return false; 
+
+            std::size_t numVariables = m_vVariableProperty.size(); 
+            std::size_t numConstraints = m_vConstraint.size(); 
+            BinaryHeader header; 
+            std::copy(binaryMagic(), binaryMagic()+sizeof(header.magic), header.magic); 
+            header.coefficientSize = sizeof(coefficient_value_type); 
+            header.variableSize = sizeof(variable_value_type); 
+            header.indexSize = sizeof(std::size_t); 
+            header.numericFlags = std::numeric_limits<coefficient_value_type>::is_integer | (std::numeric_limits<variable_value_type>::is_integer << 1); 
+            header.optType = m_optType; 
+            header.numVariables = numVariables; 
+            header.numConstraints = numConstraints; 
+            header.numTerms = 0; 
+            for (std::size_t i = 0; i < numConstraints; ++i)
+                header.numTerms += m_vConstraint[i].expression().terms().size(); 
+            header.numObjectiveTerms = m_objective.terms().size(); 
+            writeBinarySection(out, &header, 1); 
+
+            // variables 
+            std::vector<variable_value_type> vValue (numVariables); 
+            std::vector<char> vType (numVariables); 
+            std::vector<std::size_t> vNameBegin (1, 0); 
+            std::string names; 
+            for (std::size_t i = 0; i < numVariables; ++i)
+            {
+                vValue[i] = m_vVariableProperty[i].lowerBound(); 
+                vType[i] = m_vVariableProperty[i].numericType(); 
+                names += m_vVariableProperty[i].name(); 
+                vNameBegin.push_back(names.size()); 
+            }
+            writeBinarySection(out, vValue.empty()? NULL : &vValue[0], numVariables); 
+            for (std::size_t i = 0; i < numVariables; ++i)
+                vValue[i] = m_vVariableProperty[i].upperBound(); 
+            writeBinarySection(out, vValue.empty()? NULL : &vValue[0], numVariables); 
+            writeBinarySection(out, m_vVariableSol.empty()? NULL : &m_vVariableSol[0], numVariables); 
+            writeBinarySection(out, vType.empty()? NULL : &vType[0], numVariables); 
+            writeBinarySection(out, &vNameBegin[0], numVariables+1); 
+            writeBinarySection(out, names.data(), names.size()); 
+
+            // constraints in compressed sparse rows 
+            std::vector<std::size_t> vRowBegin (1, 0); 
+            std::vector<unsigned int> vColumn; 
+            std::vector<coefficient_value_type> vElement; 
+            std::vector<char> vSense (numConstraints); 
+            std::vector<coefficient_value_type> vRhs (numConstraints); 
+            vRowBegin.reserve(numConstraints+1); 
+            vColumn.reserve(header.numTerms); 
+            vElement.reserve(header.numTerms); 
+            vNameBegin.assign(1, 0); 
+            names.clear(); 
+            for (std::size_t i = 0; i < numConstraints; ++i)
+            {
+                constraint_type const& constr = m_vConstraint[i]; 
+                for (typename std::vector<term_type>::const_iterator it = constr.expression().terms().begin(), ite = constr.expression().terms().end(); it != ite; ++it)
+                {
+                    vColumn.push_back(it->variable().id()); 
+                    vElement.push_back(it->coefficient()); 
+                }
+                vRowBegin.push_back(vColumn.size()); 
+                vSense[i] = constr.sense(); 
+                vRhs[i] = constr.rightHandSide(); 
+                names += m_vConstraintName[i]; 
+                vNameBegin.push_back(names.size()); 
+            }
+            writeBinarySection(out, &vRowBegin[0], numConstraints+1); 
+            writeBinarySection(out, vColumn.empty()? NULL : &vColumn[0], vColumn.size()); 
+            writeBinarySection(out, vElement.empty()? NULL : &vElement[0], vElement.size()); 
+            writeBinarySection(out, vSense.empty()? NULL : &vSense[0], numConstraints); 
+            writeBinarySection(out, vRhs.empty()? NULL : &vRhs[0], numConstraints); 
+            writeBinarySection(out, &vNameBegin[0], numConstraints+1); 
+            writeBinarySection(out, names.data(), names.size()); 
+
+            // objective 
+            vColumn.clear(); 
+            vElement.clear(); 
+            for (typename std::vector<term_type>::const_iterator it = m_objective.terms().begin(), ite = m_objective.terms().end(); it != ite; ++it)
+            {
+                vColumn.push_back(it->variable().id()); 
+                vElement.push_back(it->coefficient()); 
+            }
+            vElement.push_back(m_objective.constant()); 
+            writeBinarySection(out, vColumn.empty()? NULL : &vColumn[0], vColumn.size()); 
+            writeBinarySection(out, &vElement[0], vElement.size()); 
+
+            out.close(); 
+            return !out.fail(); 
+        }
+        /// @brief read problem written by @ref writeBinary, which replaces the current problem 
+        /// 
+        /// The file is mapped to memory and its arrays are copied to the model directly, without parsing. 
+        /// @param filename input file name 
+        /// @return false if the file cannot be read or is written by a model of other types, and then the model is not changed; otherwise true 
+        bool readBinary(std::string const& filename)
+        {
+            int fd = ::open(filename.c_str(), O_RDONLY); 
+            if (fd < 0)
+                return false; 
+            struct stat sb; 
+            if (fstat(fd, &sb) < 0 || !S_ISREG(sb.st_mode) || sb.st_size == 0)
+            {
+                ::close(fd); 
+                return false; 
+            }
+            void* addr = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0); 
+            // the mapping holds its own reference to the file 
+            ::close(fd); 
+            if (addr == MAP_FAILED)
+                return false; 
+#ifdef MADV_SEQUENTIAL
+            madvise(addr, sb.st_size, MADV_SEQUENTIAL); 
+#endif
+            bool ret = readBinaryData(static_cast<char const*>(addr), sb.st_size); 
+            munmap(addr, sb.st_size); 
+            return ret; 
+        }
         /// @brief print problem in lp format to file 
         /// @param filename output file name 
         /// @return true if succeed; otherwise false 
@@ -1558,6 +2150,138 @@ class LinearModel : public LpParser::LpDataBase
             out.close();
             return true; 
         }
+        /// @brief write problem in lp format, the same text as @ref print, but much faster for large models 
+        /// 
+        /// Blocks of constraints and variables are formatted by threads into separate buffers with @ref limbo::to_chars, 
+        /// and the buffers are written in order with fwrite, a round of blocks at a time to bound the memory. 
+        /// @param filename output file name 
+        /// @param numThreads maximum number of threads to format blocks 
+        /// @return true if succeed; otherwise false 
+        bool writeLp(std::string const& filename, unsigned int numThreads = 1) const 
+        {
+            std::FILE* fp = std::fopen(filename.c_str(), "wb"); 
+            if (!fp)
+                return false; 
+            WritePass pass; 
+            pass.model = this; 
+            pass.numThreads = numThreads; 
+            pass.fp = fp; 
+            pass.good = true; 
+
+            std::string buffer; 
+            switch (optimizeType())
+            {
+                case MIN:
+                    buffer += "Minimize\n";
+                    break; 
+                case MAX:
+                    buffer += "Maximize\n";
+                    break; 
+                default:
+                    buffer += "Unknown\n";
+                    break; 
+            }
+            appendExpression(buffer, objective()); 
+            buffer += "\n\nSubject To\n"; 
+            pass.write(buffer); 
+            writeBlocks(pass, LP_ROWS, m_vConstraint.size()); 
+            pass.write("Bounds\n"); 
+            writeBlocks(pass, LP_BOUNDS, m_vVariableProperty.size()); 
+            pass.write("Generals\n"); 
+            writeBlocks(pass, LP_GENERALS, m_vVariableProperty.size()); 
+            pass.write("End\n"); 
+
+            return (std::fclose(fp) == 0) && pass.good; 
+        }
+        /// @brief write problem in free mps format 
+        /// 
+        /// Rows are named as in @ref print and the objective row is named OBJ. 
+        /// Integer and binary columns are enclosed in INTORG and INTEND markers, and integer columns without upper bounds get PL bounds. 
+        /// The constant of the objective is not written, the same as @ref print. 
+        /// Columns are formatted from a transposed copy of the constraints by threads like @ref writeLp. 
+        /// @param filename output file name 
+        /// @param numThreads maximum number of threads to format blocks 
+        /// @return true if succeed; otherwise false 
+        bool writeMps(std::string const& filename, unsigned int numThreads = 1) const 
+        {
+            std::FILE* fp = std::fopen(filename.c_str(), "wb"); 
+            if (!fp)
+                return false; 
+            WritePass pass; 
+            pass.model = this; 
+            pass.numThreads = numThreads; 
+            pass.fp = fp; 
+            pass.good = true; 
+
+            // transpose constraints into compressed sparse columns, rows of a column in increasing order 
+            std::size_t numVariables = m_vVariableProperty.size(); 
+            pass.vColumnBegin.assign(numVariables+1, 0); 
+            for (typename std::vector<constraint_type>::const_iterator it = m_vConstraint.begin(), ite = m_vConstraint.end(); it != ite; ++it)
+                for (typename std::vector<term_type>::const_iterator itt = it->expression().terms().begin(), itte = it->expression().terms().end(); itt != itte; ++itt)
+                    ++pass.vColumnBegin[itt->variable().id()+1]; 
+            for (std::size_t i = 0; i < numVariables; ++i)
+                pass.vColumnBegin[i+1] += pass.vColumnBegin[i]; 
+            pass.vRow.resize(pass.vColumnBegin.back()); 
+            pass.vElement.resize(pass.vColumnBegin.back()); 
+            std::vector<std::size_t> vNext (pass.vColumnBegin.begin(), pass.vColumnBegin.end()-1); 
+            for (typename std::vector<constraint_type>::const_iterator it = m_vConstraint.begin(), ite = m_vConstraint.end(); it != ite; ++it)
+                for (typename std::vector<term_type>::const_iterator itt = it->expression().terms().begin(), itte = it->expression().terms().end(); itt != itte; ++itt)
+                {
+                    std::size_t& k = vNext[itt->variable().id()]; 
+                    pass.vRow[k] = it->id(); 
+                    pass.vElement[k] = itt->coefficient(); 
+                    ++k; 
+                }
+            std::vector<std::size_t>().swap(vNext); 
+            pass.vObjective.assign(numVariables, 0); 
+            pass.vHasObjective.assign(numVariables, false); 
+            for (typename std::vector<term_type>::const_iterator it = m_objective.terms().begin(), ite = m_objective.terms().end(); it != ite; ++it)
+            {
+                pass.vObjective[it->variable().id()] += it->coefficient(); 
+                pass.vHasObjective[it->variable().id()] = true; 
+            }
+
+            pass.write((optimizeType() == MAX)? "NAME\nOBJSENSE\n    MAX\nROWS\n N  OBJ\n" : "NAME\nROWS\n N  OBJ\n"); 
+            writeBlocks(pass, MPS_ROWS, m_vConstraint.size()); 
+            pass.write("COLUMNS\n"); 
+            writeBlocks(pass, MPS_COLUMNS, numVariables); 
+            if (numVariables && isIntegerType(m_vVariableProperty.back().numericType()))
+            {
+                std::string buffer; 
+                appendMarker(buffer, numVariables, "INTEND"); 
+                pass.write(buffer); 
+            }
+            pass.write("RHS\n"); 
+            writeBlocks(pass, MPS_RHS, m_vConstraint.size()); 
+            pass.write("BOUNDS\n"); 
+            writeBlocks(pass, MPS_BOUNDS, numVariables); 
+            pass.write("ENDATA\n"); 
+
+            return (std::fclose(fp) == 0) && pass.good; 
+        }
+        /// @brief report bytes of the model under categories "LinearModel/constraints", "LinearModel/terms", 
+        /// "LinearModel/variables", "LinearModel/names" and "LinearModel/pending" for constraints not built yet 
+        /// @param usage bytes are added to it 
+        void memoryUsage(limbo::MemoryUsage& usage) const 
+        {
+            std::size_t termBytes = limbo::heap_bytes(m_objective.terms()); 
+            for (typename std::vector<constraint_type>::const_iterator it = m_vConstraint.begin(), ite = m_vConstraint.end(); it != ite; ++it)
+                termBytes += limbo::heap_bytes(it->expression().terms()); 
+            std::size_t nameBytes = limbo::heap_bytes(m_vConstraintName); 
+            for (std::vector<std::string>::const_iterator it = m_vConstraintName.begin(), ite = m_vConstraintName.end(); it != ite; ++it)
+                nameBytes += limbo::heap_bytes(*it); 
+            for (typename std::vector<property_type>::const_iterator it = m_vVariableProperty.begin(), ite = m_vVariableProperty.end(); it != ite; ++it)
+                nameBytes += limbo::heap_bytes(it->name()); 
+            std::size_t pendingBytes = limbo::heap_bytes(m_vPendingTerm) + limbo::heap_bytes(m_vPendingEnd) 
+                + limbo::heap_bytes(m_vPendingSense) + limbo::heap_bytes(m_vPendingRhs) + limbo::heap_bytes(m_vPendingName); 
+            for (std::vector<std::string>::const_iterator it = m_vPendingName.begin(), ite = m_vPendingName.end(); it != ite; ++it)
+                pendingBytes += limbo::heap_bytes(*it); 
+            usage.add("LinearModel/constraints", sizeof(*this) + limbo::heap_bytes(m_vConstraint)); 
+            usage.add("LinearModel/terms", termBytes); 
+            usage.add("LinearModel/variables", limbo::heap_bytes(m_vVariableProperty) + limbo::heap_bytes(m_vVariableSol)); 
+            usage.add("LinearModel/names", nameBytes); 
+            usage.add("LinearModel/pending", pendingBytes); 
+        }
         /// @brief print problem in lp format 
         /// @param os output stream 
         /// @return output stream 
@@ -1601,11 +2325,11 @@ class LinearModel : public LpParser::LpDataBase
                 if (it->lowerBound() <= limbo::lowest<variable_value_type>() && it->upperBound() >= std::numeric_limits<variable_value_type>::max())
                     os << variableName(variable_type(i)) << " free";
                 else if (it->lowerBound() <= limbo::lowest<variable_value_type>())
-                    os << variableName(variable_type(i)) << " <= " << it->upperBound();
+                    printNumber(os << variableName(variable_type(i)) << " <= ", it->upperBound());
                 else if (it->upperBound() >= std::numeric_limits<variable_value_type>::max())
-                    os << variableName(variable_type(i)) << " >= " << it->lowerBound();
+                    printNumber(os << variableName(variable_type(i)) << " >= ", it->lowerBound());
                 else 
-                    os << it->lowerBound() << " <= " << variableName(variable_type(i)) << " <= " << it->upperBound();
+                    printNumber(printNumber(os, it->lowerBound()) << " <= " << variableName(variable_type(i)) << " <= ", it->upperBound());
                 os << "\n";
             }
 
@@ -1628,7 +2352,7 @@ class LinearModel : public LpParser::LpDataBase
         /// @return output stream 
         std::ostream& print(std::ostream& os, term_type const& term) const 
         {
-            os << term.coefficient() << " " << variableName(term.variable());
+            printNumber(os, term.coefficient()) << " " << variableName(term.variable());
             return os; 
         }
         /// @brief print expression 
@@ -1656,9 +2380,9 @@ class LinearModel : public LpParser::LpDataBase
         {
             print(os, constr.expression());
             if (constr.sense() == '=')
-                os << " " << constr.sense() << " " << constr.rightHandSide();
+                printNumber(os << " " << constr.sense() << " ", constr.rightHandSide());
             else 
-                os << " " << constr.sense() << "= " << constr.rightHandSide();
+                printNumber(os << " " << constr.sense() << "= ", constr.rightHandSide());
             return os;  
         }
         /// @brief print solutions to file 
@@ -1677,12 +2401,552 @@ class LinearModel : public LpParser::LpDataBase
         std::ostream& printSolution(std::ostream& os = std::cout) const 
         {
             coefficient_value_type obj = evaluateObjective(); 
-            os << "# Objective " << obj << "\n";
+            printNumber(os << "# Objective ", obj) << "\n";
             for (unsigned int i = 0, ie = variableSolutions().size(); i < ie; ++i)
-                os << variableName(variable_type(i)) << " " << variableSolution(variable_type(i)) << "\n";
+                printNumber(os << variableName(variable_type(i)) << " ", variableSolution(variable_type(i))) << "\n";
             return os; 
         }
     protected:
+        /// @brief print a number in the shortest form that reads back to the same value
+        /// @param os output stream 
+        /// @param value number 
+        /// @return output stream 
+        template <typename U>
+        static std::ostream& printNumber(std::ostream& os, U value)
+        {
+            char buf[32];
+            return os.write(buf, limbo::to_chars(buf, buf+sizeof(buf), value).ptr-buf);
+        }
+        /// @brief shared state of threads simplifying pending constraints 
+        struct BuildPass
+        {
+            LinearModel* model; ///< the model 
+            std::size_t* vEnd; ///< end of simplified terms of each row 
+            /// @param b first row 
+            /// @param e end row 
+            void operator()(std::size_t b, std::size_t e) const {model->simplifyPending(vEnd, b, e);}
+        };
+        /// @brief header of binary files by @ref writeBinary 
+        struct BinaryHeader
+        {
+            char magic[8]; ///< file identifier 
+            unsigned int coefficientSize; ///< size of coefficient_value_type 
+            unsigned int variableSize; ///< size of variable_value_type 
+            unsigned int indexSize; ///< size of std::size_t 
+            unsigned int numericFlags; ///< bit 0 set for integer coefficients, bit 1 set for integer variables 
+            int optType; ///< optimization objective 
+            std::size_t numVariables; ///< number of variables 
+            std::size_t numConstraints; ///< number of constraints 
+            std::size_t numTerms; ///< number of terms in all constraints 
+            std::size_t numObjectiveTerms; ///< number of terms in the objective 
+        };
+
+        /// @param i index of pending constraint 
+        /// @return begin of its terms in the buffer 
+        std::size_t pendingBegin(unsigned int i) const {return (i)? m_vPendingEnd[i-1] : 0;}
+        /// @brief simplify a block of pending constraints in place 
+        /// @param vEnd end of simplified terms of each row as output 
+        /// @param b first row 
+        /// @param e end row 
+        void simplifyPending(std::size_t* vEnd, std::size_t b, std::size_t e)
+        {
+            for (; b < e; ++b)
+                vEnd[b] = std::distance(m_vPendingTerm.begin(), 
+                        expression_type::simplify(m_vPendingTerm.begin()+pendingBegin(b), m_vPendingTerm.begin()+m_vPendingEnd[b]));
+        }
+        /// @brief run a kernel by threads over blocks of @ref s_evaluateBlockSize items 
+        /// @param kernel kernel with operator()(b, e) over items [b, e) of a block 
+        /// @param size number of items 
+        /// @param numThreads maximum number of threads 
+        template <typename Kernel>
+        static void runBlocks(Kernel const& kernel, std::size_t size, unsigned int numThreads)
+        {
+            numThreads = std::max(std::min(numThreads, limbo::containers::num_threads()), 1U);
+            limbo::containers::parallel_for(0, size, s_evaluateBlockSize, numThreads, kernel);
+        }
+        /// @brief sum objective terms of each block for @ref evaluateObjective 
+        struct ObjectiveKernel
+        {
+            term_type const* vTerm; ///< terms of the objective 
+            std::vector<variable_value_type> const* vVariableSol; ///< variable solutions 
+            coefficient_value_type* vBlockSum; ///< sum of each block 
+            /// @param b first term 
+            /// @param e end term 
+            void operator()(std::size_t b, std::size_t e) const
+            {
+                coefficient_value_type sum = 0; 
+                for (std::size_t i = b; i < e; ++i)
+                    sum += vTerm[i].coefficient()*(*vVariableSol)[vTerm[i].variable().id()]; 
+                vBlockSum[b/s_evaluateBlockSize] = sum; 
+            }
+        };
+        /// @brief slackness of constraints for @ref evaluateConstraints 
+        struct SlacknessKernel
+        {
+            LinearModel const* model; ///< the model 
+            std::vector<variable_value_type> const* vVariableSol; ///< variable solutions 
+            coefficient_value_type* vSlackness; ///< slackness of each constraint 
+            /// @param b first constraint 
+            /// @param e end constraint 
+            void operator()(std::size_t b, std::size_t e) const
+            {
+                for (; b < e; ++b)
+                    vSlackness[b] = model->evaluateConstraint(model->constraints()[b], *vVariableSol); 
+            }
+        };
+        /// @brief count violated bounds and constraints for @ref numViolations 
+        struct ViolationKernel
+        {
+            LinearModel const* model; ///< the model 
+            std::vector<variable_value_type> const* vVariableSol; ///< variable solutions 
+            coefficient_value_type tolerance; ///< violation allowed 
+            mutable std::size_t count; ///< number of violations, added atomically 
+            /// @param b first constraint and variable 
+            /// @param e end constraint and variable 
+            void operator()(std::size_t b, std::size_t e) const
+            {
+                std::size_t numViolations = 0; 
+                std::vector<constraint_type> const& vConstraint = model->constraints(); 
+                for (std::size_t i = b, ie = std::min(e, vConstraint.size()); i < ie; ++i)
+                {
+                    coefficient_value_type slack = model->evaluateConstraint(vConstraint[i], *vVariableSol); 
+                    numViolations += (slack < -tolerance || (vConstraint[i].sense() == '=' && slack > tolerance)); 
+                }
+                std::vector<property_type> const& vProperty = model->variableProperties(); 
+                for (std::size_t i = b, ie = std::min(e, vProperty.size()); i < ie; ++i)
+                    numViolations += ((*vVariableSol)[i] < vProperty[i].lowerBound()-tolerance || (*vVariableSol)[i] > vProperty[i].upperBound()+tolerance); 
+                if (numViolations)
+                    __sync_fetch_and_add(&count, numViolations); 
+            }
+        };
+        /// @brief scale constraints for @ref scaleConstraints 
+        struct ScaleKernel
+        {
+            constraint_type* vConstraint; ///< constraints 
+            coefficient_value_type const* vFactor; ///< scaling factor of each constraint 
+            bool reciprocal; ///< true to divide by the factors 
+            /// @param b first constraint 
+            /// @param e end constraint 
+            void operator()(std::size_t b, std::size_t e) const
+            {
+                for (; b < e; ++b)
+                    vConstraint[b].scale((reciprocal)? 1/vFactor[b] : vFactor[b]); 
+            }
+        };
+        /// @brief sections formatted in blocks by @ref writeLp and @ref writeMps 
+        enum WriteSection 
+        {
+            LP_ROWS, ///< constraints in lp format 
+            LP_BOUNDS, ///< bounds of variables in lp format 
+            LP_GENERALS, ///< integer variables in lp format 
+            MPS_ROWS, ///< senses of rows in mps format 
+            MPS_COLUMNS, ///< columns in mps format 
+            MPS_RHS, ///< right hand sides in mps format 
+            MPS_BOUNDS ///< bounds of columns in mps format 
+        };
+        /// @brief shared state of threads formatting blocks for @ref writeLp and @ref writeMps 
+        struct WritePass
+        {
+            LinearModel const* model; ///< the model 
+            unsigned int numThreads; ///< maximum number of threads 
+            std::FILE* fp; ///< output file 
+            bool good; ///< false if failed to write 
+            WriteSection section; ///< section of the current round 
+            std::size_t begin; ///< first item of the current round 
+            std::size_t end; ///< one past the last item of the current round 
+            std::vector<std::string> vBuffer; ///< formatted blocks of the current round in order 
+            std::vector<std::size_t> vColumnBegin; ///< begin of each column in @ref vRow for mps 
+            std::vector<unsigned int> vRow; ///< rows of columns for mps 
+            std::vector<coefficient_value_type> vElement; ///< coefficients of columns for mps 
+            std::vector<coefficient_value_type> vObjective; ///< objective coefficients of columns for mps 
+            std::vector<bool> vHasObjective; ///< whether a column is in the objective for mps 
+
+            /// @brief write bytes to the file 
+            /// @param buffer bytes 
+            void write(std::string const& buffer) 
+            {
+                if (!buffer.empty())
+                    good = (std::fwrite(buffer.data(), 1, buffer.size(), fp) == buffer.size()) && good; 
+            }
+        };
+        /// @param t numeric type 
+        /// @return true for integer and binary variables 
+        static bool isIntegerType(SolverProperty t) {return t == BINARY || t == INTEGER;}
+        /// @brief append a number in the shortest form that reads back to the same value 
+        /// @param buffer output 
+        /// @param value number 
+        template <typename U>
+        static void appendNumber(std::string& buffer, U value)
+        {
+            char buf[32];
+            buffer.append(buf, limbo::to_chars(buf, buf+sizeof(buf), value).ptr);
+        }
+        /// @brief append the name of a variable, the same as @ref variableName without a temporary string 
+        /// @param buffer output 
+        /// @param id variable index 
+        void appendVariableName(std::string& buffer, unsigned int id) const 
+        {
+            std::string const& name = m_vVariableProperty[id].name(); 
+            if (name.empty())
+            {
+                buffer += 'x'; 
+                appendNumber(buffer, id); 
+            }
+            else 
+                buffer += name; 
+        }
+        /// @brief append the name of a constraint, C followed by its index if not named 
+        /// @param buffer output 
+        /// @param id constraint index 
+        void appendConstraintName(std::string& buffer, unsigned int id) const 
+        {
+            if (m_vConstraintName[id].empty())
+            {
+                buffer += 'C'; 
+                appendNumber(buffer, id); 
+            }
+            else 
+                buffer += m_vConstraintName[id]; 
+        }
+        /// @brief append an expression in lp format, the same as @ref print 
+        /// @param buffer output 
+        /// @param expr expression 
+        void appendExpression(std::string& buffer, expression_type const& expr) const 
+        {
+            int i = 0; 
+            for (typename std::vector<term_type>::const_iterator it = expr.terms().begin(), ite = expr.terms().end(); it != ite; ++it, ++i)
+            {
+                if (i)
+                    buffer += " + "; 
+                appendNumber(buffer, it->coefficient()); 
+                buffer += ' '; 
+                appendVariableName(buffer, it->variable().id()); 
+                if (i%4 == 3)
+                    buffer += '\n'; 
+            }
+        }
+        /// @brief append a marker line of integer columns for mps 
+        /// @param buffer output 
+        /// @param id column starting or ending the markers, which makes the marker name unique 
+        /// @param type INTORG or INTEND 
+        static void appendMarker(std::string& buffer, std::size_t id, char const* type) 
+        {
+            buffer += "    M"; 
+            appendNumber(buffer, (unsigned long)id); 
+            buffer.append(" 'MARKER' '").append(type).append("'\n"); 
+        }
+        /// @brief append a bound line for mps 
+        /// @param buffer output 
+        /// @param type bound type 
+        /// @param id column 
+        /// @param value bound, not written for FR, MI and PL 
+        void appendMpsBound(std::string& buffer, char const* type, unsigned int id, variable_value_type value) const 
+        {
+            buffer.append(" ").append(type).append(" BND "); 
+            appendVariableName(buffer, id); 
+            if (type[0] != 'F' || type[1] != 'R')
+                if (type[0] != 'M' && type[0] != 'P')
+                {
+                    buffer += ' '; 
+                    appendNumber(buffer, value); 
+                }
+            buffer += '\n'; 
+        }
+        /// @brief format an item of a section 
+        /// @param pass shared state 
+        /// @param i index of constraint or variable 
+        /// @param buffer output 
+        void formatItem(WritePass const& pass, std::size_t i, std::string& buffer) const 
+        {
+            switch (pass.section)
+            {
+                case LP_ROWS:
+                    {
+                        constraint_type const& constr = m_vConstraint[i]; 
+                        appendConstraintName(buffer, i); 
+                        buffer += ": "; 
+                        appendExpression(buffer, constr.expression()); 
+                        buffer += ' '; 
+                        buffer += constr.sense(); 
+                        buffer += (constr.sense() == '=')? " " : "= "; 
+                        appendNumber(buffer, constr.rightHandSide()); 
+                        buffer += '\n'; 
+                    }
+                    break; 
+                case LP_BOUNDS:
+                    {
+                        property_type const& prop = m_vVariableProperty[i]; 
+                        bool noLower = (prop.lowerBound() <= limbo::lowest<variable_value_type>()); 
+                        bool noUpper = (prop.upperBound() >= std::numeric_limits<variable_value_type>::max()); 
+                        if (!noLower && !noUpper)
+                        {
+                            appendNumber(buffer, prop.lowerBound()); 
+                            buffer += " <= "; 
+                        }
+                        appendVariableName(buffer, i); 
+                        if (noLower && noUpper)
+                            buffer += " free"; 
+                        else if (noUpper)
+                        {
+                            buffer += " >= "; 
+                            appendNumber(buffer, prop.lowerBound()); 
+                        }
+                        else 
+                        {
+                            buffer += " <= "; 
+                            appendNumber(buffer, prop.upperBound()); 
+                        }
+                        buffer += '\n'; 
+                    }
+                    break; 
+                case LP_GENERALS:
+                    if (isIntegerType(m_vVariableProperty[i].numericType()))
+                    {
+                        appendVariableName(buffer, i); 
+                        buffer += '\n'; 
+                    }
+                    break; 
+                case MPS_ROWS:
+                    {
+                        char sense = m_vConstraint[i].sense(); 
+                        buffer += (sense == '<')? " L  " : (sense == '>')? " G  " : " E  "; 
+                        appendConstraintName(buffer, i); 
+                        buffer += '\n'; 
+                    }
+                    break; 
+                case MPS_COLUMNS:
+                    {
+                        // markers switch at boundaries of integer columns, which are decided by neighbors only 
+                        bool integer = isIntegerType(m_vVariableProperty[i].numericType()); 
+                        bool prevInteger = (i > 0 && isIntegerType(m_vVariableProperty[i-1].numericType())); 
+                        if (integer && !prevInteger)
+                            appendMarker(buffer, i, "INTORG"); 
+                        else if (!integer && prevInteger)
+                            appendMarker(buffer, i, "INTEND"); 
+                        // a column without coefficients is written with objective coefficient 0 to define it 
+                        if (pass.vHasObjective[i] || pass.vColumnBegin[i] == pass.vColumnBegin[i+1])
+                        {
+                            buffer += "    "; 
+                            appendVariableName(buffer, i); 
+                            buffer += " OBJ "; 
+                            appendNumber(buffer, pass.vObjective[i]); 
+                            buffer += '\n'; 
+                        }
+                        for (std::size_t k = pass.vColumnBegin[i], ke = pass.vColumnBegin[i+1]; k < ke; ++k)
+                        {
+                            buffer += "    "; 
+                            appendVariableName(buffer, i); 
+                            buffer += ' '; 
+                            appendConstraintName(buffer, pass.vRow[k]); 
+                            buffer += ' '; 
+                            appendNumber(buffer, pass.vElement[k]); 
+                            buffer += '\n'; 
+                        }
+                    }
+                    break; 
+                case MPS_RHS:
+                    if (m_vConstraint[i].rightHandSide() != 0)
+                    {
+                        buffer += "    RHS "; 
+                        appendConstraintName(buffer, i); 
+                        buffer += ' '; 
+                        appendNumber(buffer, m_vConstraint[i].rightHandSide()); 
+                        buffer += '\n'; 
+                    }
+                    break; 
+                case MPS_BOUNDS:
+                    {
+                        // default bounds of a column are [0, inf) 
+                        property_type const& prop = m_vVariableProperty[i]; 
+                        bool noLower = (prop.lowerBound() <= limbo::lowest<variable_value_type>()); 
+                        bool noUpper = (prop.upperBound() >= std::numeric_limits<variable_value_type>::max()); 
+                        if (noLower && noUpper)
+                            appendMpsBound(buffer, "FR", i, 0); 
+                        else if (noLower)
+                        {
+                            appendMpsBound(buffer, "MI", i, 0); 
+                            appendMpsBound(buffer, "UP", i, prop.upperBound()); 
+                        }
+                        else if (!noUpper && prop.lowerBound() == prop.upperBound())
+                            appendMpsBound(buffer, "FX", i, prop.lowerBound()); 
+                        else 
+                        {
+                            // a negative upper bound alone would make some readers drop the lower bound 
+                            if (prop.lowerBound() != 0 || (!noUpper && prop.upperBound() < 0))
+                                appendMpsBound(buffer, "LO", i, prop.lowerBound()); 
+                            if (!noUpper)
+                                appendMpsBound(buffer, "UP", i, prop.upperBound()); 
+                            else if (isIntegerType(prop.numericType()))
+                                appendMpsBound(buffer, "PL", i, 0); 
+                        }
+                    }
+                    break; 
+            }
+        }
+        /// @brief format a block of the current round into its buffer 
+        /// @param pass shared state 
+        /// @param b first item 
+        /// @param e end item 
+        void formatBlock(WritePass& pass, std::size_t b, std::size_t e) const 
+        {
+            std::string& buffer = pass.vBuffer[(b-pass.begin)/s_writeBlockSize]; 
+            for (; b < e; ++b)
+                formatItem(pass, b, buffer); 
+        }
+        /// @brief blocks of a round for @ref formatBlock 
+        struct FormatKernel
+        {
+            WritePass* pass; ///< shared state 
+            /// @param b first item 
+            /// @param e end item 
+            void operator()(std::size_t b, std::size_t e) const {pass->model->formatBlock(*pass, b, e);}
+        };
+        /// @brief format a section with threads and write it in order 
+        /// @param pass shared state 
+        /// @param section section 
+        /// @param numItems number of constraints or variables 
+        void writeBlocks(WritePass& pass, WriteSection section, std::size_t numItems) const 
+        {
+            unsigned int numThreads = std::max(std::min(pass.numThreads, limbo::containers::num_threads()), 1U);
+            // a round keeps a few blocks per thread in memory 
+            std::size_t roundSize = (std::size_t)s_writeBlockSize*s_writeRoundBlocks*numThreads; 
+            pass.section = section; 
+            for (pass.begin = 0; pass.begin < numItems; pass.begin = pass.end)
+            {
+                pass.end = std::min(pass.begin+roundSize, numItems); 
+                std::size_t numBlocks = (pass.end-pass.begin+s_writeBlockSize-1)/s_writeBlockSize; 
+                pass.vBuffer.resize(numBlocks); 
+                FormatKernel kernel; 
+                kernel.pass = &pass; 
+                limbo::containers::parallel_for(pass.begin, pass.end, s_writeBlockSize, numThreads, kernel); 
+                // buffers keep their capacity for the next round 
+                for (std::size_t i = 0; i < numBlocks; ++i)
+                {
+                    pass.write(pass.vBuffer[i]); 
+                    pass.vBuffer[i].clear(); 
+                }
+            }
+        }
+        /// @brief write an array to a binary file, padded to a multiple of 8 bytes so arrays in a mapped file are aligned 
+        /// @param out output stream 
+        /// @param data array 
+        /// @param n number of elements 
+        template <typename U>
+        static void writeBinarySection(std::ofstream& out, U const* data, std::size_t n)
+        {
+            std::size_t size = n*sizeof(U); 
+            if (size)
+                out.write(reinterpret_cast<char const*>(data), size); 
+            char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0}; 
+            out.write(padding, (8-size%8)%8); 
+        }
+        /// @brief take an array from a binary file in memory, written by @ref writeBinarySection 
+        /// @param cursor current position, moved after the array 
+        /// @param end end of the file 
+        /// @param n number of elements 
+        /// @return array, or NULL if the file is too short 
+        template <typename U>
+        static U const* readBinarySection(char const*& cursor, char const* end, std::size_t n)
+        {
+            if (n > (std::size_t)(end-cursor)/sizeof(U))
+                return NULL; 
+            U const* data = reinterpret_cast<U const*>(cursor); 
+            std::size_t size = n*sizeof(U); 
+            size += (8-size%8)%8; 
+            cursor = (size < (std::size_t)(end-cursor))? cursor+size : end; 
+            return data; 
+        }
+        /// @brief read problem from a binary file in memory 
+        /// @param data begin of the file 
+        /// @param size size of the file in bytes 
+        /// @return false if the file is invalid, and then the model is not changed; otherwise true 
+        bool readBinaryData(char const* data, std::size_t size)
+        {
+            char const* cursor = data; 
+            char const* end = data+size; 
+            BinaryHeader const* header = readBinarySection<BinaryHeader>(cursor, end, 1); 
+            if (!header || !std::equal(header->magic, header->magic+sizeof(header->magic), binaryMagic())
+                    || header->coefficientSize != sizeof(coefficient_value_type) || header->variableSize != sizeof(variable_value_type) 
+                    || header->indexSize != sizeof(std::size_t)
+                    || header->numericFlags != (std::numeric_limits<coefficient_value_type>::is_integer | (std::numeric_limits<variable_value_type>::is_integer << 1)))
+                return false; 
+            std::size_t numVariables = header->numVariables; 
+            std::size_t numConstraints = header->numConstraints; 
+
+            // take all arrays first, so nothing is changed for a truncated file 
+            variable_value_type const* vLowerBound = readBinarySection<variable_value_type>(cursor, end, numVariables); 
+            variable_value_type const* vUpperBound = readBinarySection<variable_value_type>(cursor, end, numVariables); 
+            variable_value_type const* vSolution = readBinarySection<variable_value_type>(cursor, end, numVariables); 
+            char const* vType = readBinarySection<char>(cursor, end, numVariables); 
+            std::size_t const* vVariableNameBegin = readBinarySection<std::size_t>(cursor, end, numVariables+1); 
+            char const* variableNames = (vVariableNameBegin)? readBinarySection<char>(cursor, end, vVariableNameBegin[numVariables]) : NULL; 
+            std::size_t const* vRowBegin = readBinarySection<std::size_t>(cursor, end, numConstraints+1); 
+            unsigned int const* vColumn = readBinarySection<unsigned int>(cursor, end, header->numTerms); 
+            coefficient_value_type const* vElement = readBinarySection<coefficient_value_type>(cursor, end, header->numTerms); 
+            char const* vSense = readBinarySection<char>(cursor, end, numConstraints); 
+            coefficient_value_type const* vRhs = readBinarySection<coefficient_value_type>(cursor, end, numConstraints); 
+            std::size_t const* vConstraintNameBegin = readBinarySection<std::size_t>(cursor, end, numConstraints+1); 
+            char const* constraintNames = (vConstraintNameBegin)? readBinarySection<char>(cursor, end, vConstraintNameBegin[numConstraints]) : NULL; 
+            unsigned int const* vObjectiveColumn = readBinarySection<unsigned int>(cursor, end, header->numObjectiveTerms); 
+            coefficient_value_type const* vObjectiveElement = readBinarySection<coefficient_value_type>(cursor, end, header->numObjectiveTerms+1); 
+            if (!vLowerBound || !vUpperBound || !vSolution || !vType || !variableNames || !vRowBegin || !vColumn || !vElement 
+                    || !vSense || !vRhs || !constraintNames || !vObjectiveColumn || !vObjectiveElement || vRowBegin[numConstraints] != header->numTerms)
+                return false; 
+            for (std::size_t i = 0; i < numVariables; ++i)
+                if (vVariableNameBegin[i] > vVariableNameBegin[i+1])
+                    return false; 
+            for (std::size_t i = 0; i < numConstraints; ++i)
+                if (vRowBegin[i] > vRowBegin[i+1] || vConstraintNameBegin[i] > vConstraintNameBegin[i+1])
+                    return false; 
+            for (std::size_t k = 0; k < header->numTerms; ++k)
+                if (vColumn[k] >= numVariables)
+                    return false; 
+            for (std::size_t k = 0; k < header->numObjectiveTerms; ++k)
+                if (vObjectiveColumn[k] >= numVariables)
+                    return false; 
+
+            m_vVariableProperty.clear(); 
+            m_vVariableProperty.reserve(numVariables); 
+            for (std::size_t i = 0; i < numVariables; ++i)
+                m_vVariableProperty.push_back(property_type(vLowerBound[i], vUpperBound[i], (SolverProperty)vType[i], 
+                            std::string(variableNames+vVariableNameBegin[i], variableNames+vVariableNameBegin[i+1]))); 
+            m_vVariableSol.assign(vSolution, vSolution+numVariables); 
+
+            m_vConstraint.resize(numConstraints); 
+            m_vConstraintName.resize(numConstraints); 
+            expression_type expr; 
+            for (std::size_t i = 0; i < numConstraints; ++i)
+            {
+                std::vector<term_type>& vTerm = expr.terms(); 
+                vTerm.clear(); 
+                vTerm.reserve(vRowBegin[i+1]-vRowBegin[i]); 
+                for (std::size_t k = vRowBegin[i]; k < vRowBegin[i+1]; ++k)
+                    vTerm.push_back(term_type(variable_type(vColumn[k]), vElement[k])); 
+                constraint_type& constr = m_vConstraint[i]; 
+                constr.setId(i); 
+                constr.emplaceExpression(expr); 
+                constr.setSense(vSense[i]); 
+                constr.setRightHandSide(vRhs[i]); 
+                m_vConstraintName[i].assign(constraintNames+vConstraintNameBegin[i], constraintNames+vConstraintNameBegin[i+1]); 
+            }
+
+            std::vector<term_type>& vTerm = m_objective.terms(); 
+            vTerm.clear(); 
+            for (std::size_t k = 0; k < header->numObjectiveTerms; ++k)
+                vTerm.push_back(term_type(variable_type(vObjectiveColumn[k]), vObjectiveElement[k])); 
+            m_objective.setConstant(vObjectiveElement[header->numObjectiveTerms]); 
+            m_optType = (SolverProperty)header->optType; 
+
+            m_mName2Variable.clear(); 
+            m_vPendingTerm.clear(); 
+            m_vPendingEnd.clear(); 
+            m_vPendingSense.clear(); 
+            m_vPendingRhs.clear(); 
+            m_vPendingName.clear(); 
+            return true; 
+        }
+        /// @return identifier at the beginning of binary files, 8 characters 
+        static char const* binaryMagic() {return "LIMBOLP1";}
         /// @brief copy object 
         void copy(LinearModel const& rhs)
         {
@@ -1694,6 +2958,12 @@ class LinearModel : public LpParser::LpDataBase
             m_vVariableSol = rhs.m_vVariableSol;
 
             m_mName2Variable = rhs.m_mName2Variable; 
+
+            m_vPendingTerm = rhs.m_vPendingTerm; 
+            m_vPendingEnd = rhs.m_vPendingEnd; 
+            m_vPendingSense = rhs.m_vPendingSense; 
+            m_vPendingRhs = rhs.m_vPendingRhs; 
+            m_vPendingName = rhs.m_vPendingName; 
         }
 
         std::vector<constraint_type> m_vConstraint; ///< constraints 
@@ -1705,6 +2975,16 @@ class LinearModel : public LpParser::LpDataBase
         std::vector<variable_value_type> m_vVariableSol; ///< variable solutions, it can be either initial solution or final solution 
 
         std::map<std::string, variable_type> m_mName2Variable; ///< mapping from variable name to variable, only used when reading from files 
+
+        std::vector<term_type> m_vPendingTerm; ///< terms of all pending constraints in one buffer 
+        std::vector<std::size_t> m_vPendingEnd; ///< end of terms of each pending constraint in the buffer 
+        std::vector<char> m_vPendingSense; ///< sense of each pending constraint 
+        std::vector<coefficient_value_type> m_vPendingRhs; ///< right hand side of each pending constraint 
+        std::vector<std::string> m_vPendingName; ///< name of each pending constraint 
+        static const unsigned int s_buildBlockSize = 64; ///< number of pending constraints simplified by a thread at a time 
+        static const unsigned int s_writeBlockSize = 1024; ///< number of constraints or variables formatted by a thread at a time 
+        static const unsigned int s_writeRoundBlocks = 16; ///< number of blocks per thread formatted before writing 
+        static const unsigned int s_evaluateBlockSize = 4096; ///< number of constraints, variables or terms evaluated by a thread at a time 
 };
 
 /// @brief Compressed sparse row (CSR) matrix 
@@ -1765,20 +3045,20 @@ struct MatrixCSR
         numRows = nr; 
         numColumns = nc; 
         numElements = nv; 
-        vElement = new value_type [numElements];
-        vColumn = new index_type [numElements];
-        vRowBeginIndex = new index_type [numRows+1];
+        vElement = limbo::containers::large_new_array<value_type>(numElements);
+        vColumn = limbo::containers::large_new_array<index_type>(numElements);
+        vRowBeginIndex = limbo::containers::large_new_array<index_type>(numRows+1);
     }
 
     /// @brief Destroy matrix and recycle memory 
     void reset() 
     {
         if (vElement)
-            delete [] vElement; 
+            limbo::containers::large_delete_array(vElement); 
         if (vColumn)
-            delete [] vColumn; 
+            limbo::containers::large_delete_array(vColumn); 
         if (vRowBeginIndex)
-            delete [] vRowBeginIndex;
+            limbo::containers::large_delete_array(vRowBeginIndex);
         vElement = NULL;
         vColumn = NULL;
         vRowBeginIndex = NULL;
@@ -1797,9 +3077,9 @@ struct MatrixCSR
         numElements = rhs.numElements;
         if (rhs.vElement)
         {
-            vElement = new value_type [numElements];
-            vColumn = new index_type [numElements]; 
-            vRowBeginIndex = new index_type [numRows+1]; 
+            vElement = limbo::containers::large_new_array<value_type>(numElements);
+            vColumn = limbo::containers::large_new_array<index_type>(numElements); 
+            vRowBeginIndex = limbo::containers::large_new_array<index_type>(numRows+1); 
             std::copy(rhs.vElement, rhs.vElement+numElements, vElement); 
             std::copy(rhs.vColumn, rhs.vColumn+numElements, vColumn); 
             std::copy(rhs.vRowBeginIndex, rhs.vRowBeginIndex+numRows+1, vRowBeginIndex);
@@ -1832,18 +3112,21 @@ struct MatrixCSR
     }
 
     /// @brief Set from array of constraints 
+    /// @tparam U coefficient type of constraints, converted to \a T 
     /// @param nr number of rows, i.e, number of constraints 
     /// @param nc number of columns, i.e., number of variables 
     /// @param vConstraint array of constraints 
-    void set(index_type nr, index_type nc, LinearConstraint<value_type> const* vConstraint) 
+    template <typename U>
+    void set(index_type nr, index_type nc, LinearConstraint<U> const* vConstraint) 
     {
+        reset(); 
         numRows = nr; 
         numColumns = nc; 
         numElements = 0; 
-        vRowBeginIndex = new index_type [numRows+1]; 
+        vRowBeginIndex = limbo::containers::large_new_array<index_type>(numRows+1); 
         vRowBeginIndex[0] = s_startingIndex;
 
-        typedef LinearConstraint<value_type> constraint_type;
+        typedef LinearConstraint<U> constraint_type;
         constraint_type const* it = vConstraint; 
         constraint_type const* ite = vConstraint+nr; 
         // initialize vRowBeginIndex 
@@ -1856,11 +3139,11 @@ struct MatrixCSR
             vRowBeginIndex[i] = vRowBeginIndex[i-1]+it->expression().terms().size(); 
         }
         // last element of vRowBeginIndex denotes the total number of elements 
-        numElements = vRowBeginIndex[numRows]; 
+        numElements = vRowBeginIndex[numRows]-s_startingIndex; 
 
         // initialize vElement and vColumn 
-        vElement = new value_type [numElements]; 
-        vColumn = new index_type [numElements];
+        vElement = limbo::containers::large_new_array<value_type>(numElements); 
+        vColumn = limbo::containers::large_new_array<index_type>(numElements);
         i = 0; 
         for (it = vConstraint; it != ite; ++it)
         {
@@ -1879,6 +3162,159 @@ struct MatrixCSR
 template <typename T, typename I, int StartingIndex>
 typename MatrixCSR<T, I, StartingIndex>::index_type MatrixCSR<T, I, StartingIndex>::s_startingIndex = StartingIndex; 
 
+/// @brief Arrays of a @ref limbo::solvers::LinearModel for the bulk loading functions of external solvers. 
+/// 
+/// Loading a model element by element costs a library call per bound, coefficient and constraint, 
+/// which dominates the solving time of large models. 
+/// The arrays are built in one pass and passed to the solver by a few calls. 
+/// Constraints are in the CSR format with coefficients in double, 
+/// and variable types follow the codes shared by Gurobi and CPLEX, 'C' for continuous and 'I' for integer. 
+/// @tparam T coefficient type of the model 
+/// @tparam V variable type of the model 
+/// @tparam StartingIndex starting index of columns and rows in the constraint matrix 
+template <typename T, typename V, int StartingIndex = 0>
+struct LinearModelArrays
+{
+    /// @brief model type 
+    typedef LinearModel<T, V> model_type; 
+    /// @brief matrix type 
+    typedef MatrixCSR<double, int, StartingIndex> matrix_type; 
+
+    matrix_type constrMatrix; ///< constraint matrix 
+    std::vector<char> vSense; ///< sense of each constraint, '<', '>' or '=' 
+    std::vector<double> vRhs; ///< right hand side of each constraint 
+    std::vector<double> vObjective; ///< dense objective coefficient of each variable 
+    std::vector<double> vLowerBound; ///< lower bound of each variable 
+    std::vector<double> vUpperBound; ///< upper bound of each variable 
+    std::vector<double> vStart; ///< initial solution of each variable 
+    std::vector<char> vType; ///< type of each variable, 'C' or 'I' 
+    std::vector<std::string> vVariableName; ///< name of each variable 
+    std::vector<char*> vVariableNamePtr; ///< pointers to variable names for C APIs 
+    std::vector<char*> vConstraintNamePtr; ///< pointers to constraint names of the model for C APIs 
+
+    /// @brief build arrays from a model 
+    /// @param model the model, which must not change while the pointers to its names are in use 
+    void set(model_type const& model)
+    {
+        unsigned int numVariables = model.numVariables(); 
+        unsigned int numConstraints = model.constraints().size(); 
+
+        constrMatrix.set(numConstraints, numVariables, (numConstraints)? &model.constraints()[0] : (typename model_type::constraint_type const*)NULL); 
+        vSense.resize(numConstraints); 
+        vRhs.resize(numConstraints); 
+        vConstraintNamePtr.resize(numConstraints); 
+        for (unsigned int i = 0; i < numConstraints; ++i)
+        {
+            typename model_type::constraint_type const& constr = model.constraints()[i]; 
+            vSense[i] = constr.sense(); 
+            vRhs[i] = constr.rightHandSide(); 
+            vConstraintNamePtr[i] = const_cast<char*>(model.constraintName(constr).c_str()); 
+        }
+
+        vObjective.assign(numVariables, 0); 
+        for (typename std::vector<typename model_type::term_type>::const_iterator it = model.objective().terms().begin(), ite = model.objective().terms().end(); it != ite; ++it)
+            vObjective[it->variable().id()] += it->coefficient(); 
+
+        vLowerBound.resize(numVariables); 
+        vUpperBound.resize(numVariables); 
+        vStart.resize(numVariables); 
+        vType.resize(numVariables); 
+        vVariableName.resize(numVariables); 
+        vVariableNamePtr.resize(numVariables); 
+        for (unsigned int i = 0; i < numVariables; ++i)
+        {
+            typename model_type::property_type const& property = model.variableProperties()[i]; 
+            typename model_type::variable_type var (i); 
+            vLowerBound[i] = property.lowerBound(); 
+            vUpperBound[i] = property.upperBound(); 
+            vStart[i] = model.variableSolution(var); 
+            vType[i] = (property.numericType() == CONTINUOUS)? 'C' : 'I'; 
+            limboAssertMsg(!(std::numeric_limits<V>::is_integer && property.numericType() == CONTINUOUS), 
+                    "LinearModel<T, V> is declared as V = integer type, but variable %s is CONTINUOUS", model.variableName(var).c_str());
+            vVariableName[i] = model.variableName(var); 
+        }
+        // pointers are taken after all names are in place 
+        for (unsigned int i = 0; i < numVariables; ++i)
+            vVariableNamePtr[i] = const_cast<char*>(vVariableName[i].c_str()); 
+    }
+    /// @return index of the first element of row \a i in the element arrays 
+    /// @param i row index starting from 0 
+    int rowBegin(unsigned int i) const {return constrMatrix.vRowBeginIndex[i]-StartingIndex;}
+    /// @return number of elements in row \a i 
+    /// @param i row index starting from 0 
+    int rowSize(unsigned int i) const {return constrMatrix.vRowBeginIndex[i+1]-constrMatrix.vRowBeginIndex[i];}
+};
+
+/// @brief Callback at each new incumbent of a solve with @ref limbo::solvers::SolveControl. 
+/// Backends call it from their own threads, one call at a time. 
+class IncumbentCallback
+{
+    public:
+        /// @brief destructor 
+        virtual ~IncumbentCallback() {}
+        /// @brief receive an incumbent 
+        /// @param vSolution value of each variable in the order of the model 
+        /// @param objective objective of the incumbent 
+        /// @return true to continue, false to stop the solve, which then returns the incumbent as @ref limbo::solvers::SUBOPTIMAL 
+        virtual bool operator()(std::vector<double> const& vSolution, double objective) = 0; 
+};
+
+/// @brief Backend-independent control of a solve, inherited by the parameters of each backend. 
+/// 
+/// Each limit is off by default. 
+/// When a limit stops the solve, the best solution found is returned as @ref limbo::solvers::SUBOPTIMAL, 
+/// or the initial solution is kept if none is found. 
+/// Reaching the gap target returns @ref limbo::solvers::OPTIMAL. 
+class SolveControl
+{
+    public:
+        /// @brief constructor 
+        SolveControl()
+            : m_timeLimit(0)
+            , m_mipGap(-1)
+            , m_nodeLimit(0)
+            , m_solutionLimit(0)
+            , m_incumbentCallback(NULL)
+        {
+        }
+        /// @brief destructor 
+        virtual ~SolveControl() {}
+
+        /// @brief set time limit 
+        /// @param v seconds, 0 for no limit 
+        void setTimeLimit(double v) {m_timeLimit = v;}
+        /// @brief set target of the relative MIP gap 
+        /// @param v gap, negative for the default of the backend 
+        void setMipGap(double v) {m_mipGap = v;}
+        /// @brief set limit of branch-and-bound nodes 
+        /// @param v number of nodes, 0 for no limit 
+        void setNodeLimit(long v) {m_nodeLimit = v;}
+        /// @brief set limit of improving solutions found 
+        /// @param v number of solutions, 0 for no limit 
+        void setSolutionLimit(long v) {m_solutionLimit = v;}
+        /// @brief set callback at each new incumbent 
+        /// @param v callback, not owned, NULL to disable 
+        void setIncumbentCallback(IncumbentCallback* v) {m_incumbentCallback = v;}
+
+        /// @return time limit in seconds, 0 for no limit 
+        double timeLimit() const {return m_timeLimit;}
+        /// @return target of the relative MIP gap, negative for the default of the backend 
+        double mipGap() const {return m_mipGap;}
+        /// @return limit of branch-and-bound nodes, 0 for no limit 
+        long nodeLimit() const {return m_nodeLimit;}
+        /// @return limit of improving solutions, 0 for no limit 
+        long solutionLimit() const {return m_solutionLimit;}
+        /// @return callback at each new incumbent, NULL if disabled 
+        IncumbentCallback* incumbentCallback() const {return m_incumbentCallback;}
+
+    protected:
+        double m_timeLimit; ///< time limit in seconds, 0 for no limit 
+        double m_mipGap; ///< target of the relative MIP gap, negative for the default 
+        long m_nodeLimit; ///< limit of branch-and-bound nodes, 0 for no limit 
+        long m_solutionLimit; ///< limit of improving solutions, 0 for no limit 
+        IncumbentCallback* m_incumbentCallback; ///< callback at each new incumbent 
+};
+
 } // namespace solvers 
 } // namespace limbo 
 
@@ -0,0 +1,658 @@
+/**
+ * @file   WarmStartNetworkSimplex.h
+ * @brief  Primal network simplex for min-cost flow that restarts from the spanning tree of the previous run
+ * @date   Oct 2026
+ */
+#ifndef LIMBO_SOLVERS_WARMSTARTNETWORKSIMPLEX_H
+#define LIMBO_SOLVERS_WARMSTARTNETWORKSIMPLEX_H
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <lemon/core.h>
+
+/// namespace for Limbo
+namespace limbo
+{
+/// namespace for Limbo.Solvers
+namespace solvers
+{
+
+/// @brief Primal network simplex with the interface of lemon::NetworkSimplex,
+/// for min-cost flow problems solved many times on graphs of the same shape.
+///
+/// The algorithm object keeps the spanning tree of the last run.
+/// If the next run has the same nodes and arcs, flows of the tree arcs are recomputed from the new supplies and capacities,
+/// and potentials from the new costs.
+/// When the tree is still strongly feasible, which is always the case if only costs change,
+/// pivoting continues from it instead of the artificial tree of a cold start.
+/// Otherwise, the run starts from scratch.
+///
+/// The spanning tree is kept with parent and sibling links, so a pivot costs the length of the cycle
+/// plus the size of the subtree moved, as with the thread indices of lemon::NetworkSimplex.
+/// Entering arcs are chosen by block search.
+/// Only problems with zero total supply are supported, and node and arc ids of the graph must be contiguous,
+/// e.g., lemon::SmartDigraph.
+///
+/// @tparam GR digraph type
+/// @tparam V value type of flows and costs
+template <typename GR, typename V>
+class WarmStartNetworkSimplex
+{
+    public:
+        /// @nowarn
+        typedef GR graph_type;
+        typedef V value_type;
+        typedef typename graph_type::Node node_type;
+        typedef typename graph_type::Arc arc_type;
+        typedef typename graph_type::NodeIt node_iterator;
+        typedef typename graph_type::ArcIt arc_iterator;
+        /// @endnowarn
+
+        /// @brief status of a run, same as lemon::NetworkSimplex::ProblemType
+        enum ProblemType
+        {
+            INFEASIBLE, ///< no feasible flow
+            OPTIMAL, ///< optimally solved
+            UNBOUNDED ///< a negative cycle of infinite capacity
+        };
+
+        /// @brief constructor
+        /// @param g graph, kept by reference
+        explicit WarmStartNetworkSimplex(graph_type const& g)
+            : m_graph(g)
+            , m_numNodes(0)
+            , m_numArcs(0)
+            , m_hasLower(false)
+            , m_hasTree(false)
+            , m_warmStarted(false)
+            , m_totalCost(0)
+            , m_nextArc(0)
+        {
+        }
+
+        /// @return graph
+        graph_type const& graph() const {return m_graph;}
+
+        /// @brief set lower bounds of arcs, 0 by default
+        /// @param map arc map of lower bounds
+        /// @return reference to this object
+        template <typename LowerMap>
+        WarmStartNetworkSimplex& lowerMap(LowerMap const& map)
+        {
+            m_hasLower = true;
+            copyArcMap(map, m_vLower);
+            return *this;
+        }
+        /// @brief set upper bounds of arcs, infinite by default
+        /// @param map arc map of upper bounds
+        /// @return reference to this object
+        template <typename UpperMap>
+        WarmStartNetworkSimplex& upperMap(UpperMap const& map)
+        {
+            copyArcMap(map, m_vUpper);
+            return *this;
+        }
+        /// @brief set costs of arcs, 1 by default
+        /// @param map arc map of costs
+        /// @return reference to this object
+        template <typename CostMap>
+        WarmStartNetworkSimplex& costMap(CostMap const& map)
+        {
+            copyArcMap(map, m_vInputCost);
+            return *this;
+        }
+        /// @brief set supplies of nodes, 0 by default
+        /// @param map node map of supplies
+        /// @return reference to this object
+        template <typename SupplyMap>
+        WarmStartNetworkSimplex& supplyMap(SupplyMap const& map)
+        {
+            m_vInputSupply.assign(m_graph.maxNodeId()+1, 0);
+            for (node_iterator it (m_graph); it != lemon::INVALID; ++it)
+                m_vInputSupply[m_graph.id(it)] = map[it];
+            return *this;
+        }
+        /// @brief reset bounds, costs and supplies to defaults, the spanning tree is kept
+        /// @return reference to this object
+        WarmStartNetworkSimplex& resetParams()
+        {
+            m_hasLower = false;
+            m_vLower.clear();
+            m_vUpper.clear();
+            m_vInputCost.clear();
+            m_vInputSupply.clear();
+            return *this;
+        }
+        /// @brief forget the spanning tree, so the next run starts from scratch
+        /// @return reference to this object
+        WarmStartNetworkSimplex& reset()
+        {
+            m_hasTree = false;
+            return resetParams();
+        }
+
+        /// @brief run the algorithm, from the spanning tree of the previous run if possible
+        /// @return status
+        ProblemType run();
+
+        /// @return true if the last run started from the spanning tree of the previous run
+        bool warmStarted() const {return m_warmStarted;}
+        /// @return total cost of the flow
+        value_type totalCost() const {return m_totalCost;}
+        /// @param a arc
+        /// @return flow on the arc
+        value_type flow(arc_type const& a) const
+        {
+            int e = m_graph.id(a);
+            return m_vFlow[e]+(m_hasLower? m_vLower[e] : 0);
+        }
+        /// @brief copy flows to a map
+        /// @param map arc map of flows
+        template <typename FlowMap>
+        void flowMap(FlowMap& map) const
+        {
+            for (arc_iterator it (m_graph); it != lemon::INVALID; ++it)
+                map.set(it, flow(it));
+        }
+        /// @param n node
+        /// @return potential of the node, shifted to non-positive values as lemon::NetworkSimplex
+        value_type potential(node_type const& n) const
+        {
+            return m_vPi[m_graph.id(n)]-m_potentialShift;
+        }
+        /// @brief copy potentials to a map
+        /// @param map node map of potentials
+        template <typename PotentialMap>
+        void potentialMap(PotentialMap& map) const
+        {
+            for (node_iterator it (m_graph); it != lemon::INVALID; ++it)
+                map.set(it, potential(it));
+        }
+
+    protected:
+        /// @brief state of arcs
+        enum ArcState
+        {
+            STATE_UPPER = -1, ///< non-tree arc at upper bound
+            STATE_TREE = 0, ///< tree arc
+            STATE_LOWER = 1 ///< non-tree arc at lower bound
+        };
+        /// @brief direction of the arc to the parent
+        enum ArcDirection
+        {
+            DIR_DOWN = -1, ///< from the parent to the node
+            DIR_UP = 1 ///< from the node to the parent
+        };
+
+        /// @brief copy an arc map to an array indexed by arc ids
+        /// @param map arc map
+        /// @param vValue array
+        template <typename ArcMap>
+        void copyArcMap(ArcMap const& map, std::vector<value_type>& vValue) const
+        {
+            vValue.assign(m_graph.maxArcId()+1, 0);
+            for (arc_iterator it (m_graph); it != lemon::INVALID; ++it)
+                vValue[m_graph.id(it)] = map[it];
+        }
+        /// @return infinite capacity
+        static value_type infinity()
+        {
+            return std::numeric_limits<value_type>::has_infinity? std::numeric_limits<value_type>::infinity() : std::numeric_limits<value_type>::max();
+        }
+        /// @brief initialize the artificial spanning tree
+        void coldStart();
+        /// @brief recompute flows and potentials of the previous spanning tree
+        /// @return true if the tree is strongly feasible
+        bool warmStart();
+        /// @brief compute depths and potentials in a subtree from its root
+        /// @param root root of the subtree
+        void updateSubtree(int root);
+        /// @brief find an arc with negative reduced cost by block search
+        /// @return true if found
+        bool findEnteringArc();
+        /// @brief find the join node of the cycle of the entering arc
+        void findJoinNode();
+        /// @brief find the leaving arc and the amount of flow to augment
+        /// @return true if the leaving arc is a tree arc
+        bool findLeavingArc();
+        /// @brief augment flow along the cycle and update arc states
+        /// @param change whether the entering arc replaces a tree arc
+        void changeFlow(bool change);
+        /// @brief replace the leaving arc with the entering arc in the spanning tree
+        void updateTreeStructure();
+        /// @brief add a child to a node
+        /// @param parent parent node
+        /// @param child child node
+        void linkChild(int parent, int child);
+        /// @brief remove a node from the children of its parent
+        /// @param child child node
+        void unlinkChild(int child);
+
+        graph_type const& m_graph; ///< graph
+        int m_numNodes; ///< number of nodes of the graph, the artificial root is the next one
+        int m_numArcs; ///< number of arcs of the graph, followed by one artificial arc for each node
+
+        bool m_hasLower; ///< whether lower bounds are set
+        std::vector<value_type> m_vLower; ///< lower bounds of arcs
+        std::vector<value_type> m_vUpper; ///< upper bounds of arcs
+        std::vector<value_type> m_vInputCost; ///< costs of arcs
+        std::vector<value_type> m_vInputSupply; ///< supplies of nodes
+
+        std::vector<int> m_vSource; ///< source of each arc
+        std::vector<int> m_vTarget; ///< target of each arc
+        std::vector<value_type> m_vCap; ///< capacity of each arc after removing lower bounds
+        std::vector<value_type> m_vCost; ///< cost of each arc
+        std::vector<value_type> m_vFlow; ///< flow of each arc after removing lower bounds
+        std::vector<signed char> m_vState; ///< @ref ArcState of each arc
+        std::vector<value_type> m_vSupply; ///< supply of each node after removing lower bounds
+
+        std::vector<value_type> m_vPi; ///< potential of each node
+        std::vector<int> m_vParent; ///< parent of each node in the spanning tree
+        std::vector<int> m_vPred; ///< arc to the parent of each node
+        std::vector<signed char> m_vPredDir; ///< @ref ArcDirection of the arc to the parent
+        std::vector<int> m_vDepth; ///< depth of each node in the spanning tree
+        std::vector<int> m_vFirstChild; ///< first child of each node
+        std::vector<int> m_vNextSibling; ///< next sibling of each node
+        std::vector<int> m_vPrevSibling; ///< previous sibling of each node
+        std::vector<int> m_vStack; ///< stack to traverse subtrees
+
+        bool m_hasTree; ///< whether the spanning tree of a previous run is kept
+        bool m_warmStarted; ///< whether the last run started from the previous spanning tree
+        value_type m_totalCost; ///< total cost of the last run
+        value_type m_potentialShift; ///< shift of potentials in the output
+
+        int m_root; ///< artificial root
+        int m_blockSize; ///< block size of the pivot rule
+        int m_nextArc; ///< arc to continue the block search
+        int m_inArc; ///< entering arc
+        int m_join; ///< join node of the cycle
+        int m_uIn; ///< end of the entering arc in the moved subtree
+        int m_vIn; ///< other end of the entering arc
+        int m_uOut; ///< node whose arc to the parent leaves the tree
+        value_type m_delta; ///< amount of flow to augment
+};
+
+template <typename GR, typename V>
+typename WarmStartNetworkSimplex<GR, V>::ProblemType WarmStartNetworkSimplex<GR, V>::run()
+{
+    int numNodes = m_graph.maxNodeId()+1;
+    int numArcs = m_graph.maxArcId()+1;
+    m_warmStarted = false;
+    m_totalCost = 0;
+    m_potentialShift = 0;
+    if (numNodes <= 0)
+        return OPTIMAL;
+
+    // the previous tree is only valid for the same arcs
+    bool sameGraph = m_hasTree && numNodes == m_numNodes && numArcs == m_numArcs;
+    m_vSource.resize(numArcs+numNodes);
+    m_vTarget.resize(numArcs+numNodes);
+    for (arc_iterator it (m_graph); it != lemon::INVALID; ++it)
+    {
+        int e = m_graph.id(it);
+        int s = m_graph.id(m_graph.source(it));
+        int t = m_graph.id(m_graph.target(it));
+        sameGraph = sameGraph && m_vSource[e] == s && m_vTarget[e] == t;
+        m_vSource[e] = s;
+        m_vTarget[e] = t;
+    }
+    m_numNodes = numNodes;
+    m_numArcs = numArcs;
+    m_root = numNodes;
+
+    // remove lower bounds
+    value_type inf = infinity();
+    m_vSupply.assign(numNodes+1, 0);
+    if (!m_vInputSupply.empty())
+        std::copy(m_vInputSupply.begin(), m_vInputSupply.end(), m_vSupply.begin());
+    m_vCap.resize(numArcs+numNodes);
+    m_vCost.resize(numArcs+numNodes);
+    for (int e = 0; e < numArcs; ++e)
+    {
+        value_type upper = m_vUpper.empty()? inf : m_vUpper[e];
+        value_type lower = m_hasLower? m_vLower[e] : 0;
+        m_vCap[e] = (upper >= inf)? inf : upper-lower;
+        m_vCost[e] = m_vInputCost.empty()? 1 : m_vInputCost[e];
+        m_vSupply[m_vSource[e]] -= lower;
+        m_vSupply[m_vTarget[e]] += lower;
+    }
+    value_type sumSupply = 0;
+    for (int u = 0; u < numNodes; ++u)
+        sumSupply += m_vSupply[u];
+    if (sumSupply != 0)
+    {
+        m_hasTree = false;
+        return INFEASIBLE;
+    }
+
+    // artificial arcs from the root are expensive enough to leave the tree in any feasible problem
+    value_type artCost = 0;
+    if (std::numeric_limits<value_type>::is_exact)
+        artCost = std::numeric_limits<value_type>::max()/2+1;
+    else
+    {
+        for (int e = 0; e < numArcs; ++e)
+            artCost = std::max(artCost, m_vCost[e]);
+        artCost = (artCost+1)*numNodes;
+    }
+    for (int u = 0, e = numArcs; u < numNodes; ++u, ++e)
+    {
+        m_vCap[e] = inf;
+        m_vCost[e] = (m_vSource[e] == m_root)? artCost : 0;
+    }
+
+    m_warmStarted = sameGraph && warmStart();
+    if (!m_warmStarted)
+    {
+        for (int u = 0, e = numArcs; u < numNodes; ++u, ++e)
+        {
+            bool up = (m_vSupply[u] >= 0);
+            m_vSource[e] = up? u : m_root;
+            m_vTarget[e] = up? m_root : u;
+            m_vCost[e] = up? 0 : artCost;
+        }
+        coldStart();
+    }
+    m_hasTree = true;
+
+    m_blockSize = std::max(int(std::sqrt(double(numArcs))), std::min(10, numArcs));
+    m_nextArc = 0;
+    while (findEnteringArc())
+    {
+        findJoinNode();
+        bool change = findLeavingArc();
+        if (m_delta >= inf)
+        {
+            m_hasTree = false;
+            return UNBOUNDED;
+        }
+        changeFlow(change);
+        if (change)
+        {
+            updateTreeStructure();
+            updateSubtree(m_uIn);
+        }
+    }
+
+    // flows left on artificial arcs
+    for (int e = numArcs; e < numArcs+numNodes; ++e)
+        if (m_vFlow[e] != 0)
+            return INFEASIBLE;
+
+    for (int e = 0; e < numArcs; ++e)
+        m_totalCost += m_vCost[e]*(m_vFlow[e]+(m_hasLower? m_vLower[e] : 0));
+    // the same potentials as lemon::NetworkSimplex for the default supply type
+    value_type maxPi = m_vPi[0];
+    for (int u = 1; u < numNodes; ++u)
+        maxPi = std::max(maxPi, m_vPi[u]);
+    if (maxPi > 0)
+        m_potentialShift = maxPi;
+    return OPTIMAL;
+}
+
+template <typename GR, typename V>
+void WarmStartNetworkSimplex<GR, V>::coldStart()
+{
+    int numAllNodes = m_numNodes+1;
+    m_vFlow.assign(m_numArcs+m_numNodes, 0);
+    m_vState.assign(m_numArcs+m_numNodes, STATE_LOWER);
+    m_vPi.resize(numAllNodes);
+    m_vParent.resize(numAllNodes);
+    m_vPred.resize(numAllNodes);
+    m_vPredDir.resize(numAllNodes);
+    m_vDepth.resize(numAllNodes);
+    m_vFirstChild.assign(numAllNodes, -1);
+    m_vNextSibling.resize(numAllNodes);
+    m_vPrevSibling.resize(numAllNodes);
+
+    m_vParent[m_root] = -1;
+    m_vPred[m_root] = -1;
+    m_vDepth[m_root] = 0;
+    m_vPi[m_root] = 0;
+    for (int u = 0, e = m_numArcs; u < m_numNodes; ++u, ++e)
+    {
+        linkChild(m_root, u);
+        m_vPred[u] = e;
+        m_vDepth[u] = 1;
+        m_vState[e] = STATE_TREE;
+        if (m_vSource[e] == u)
+        {
+            m_vPredDir[u] = DIR_UP;
+            m_vFlow[e] = m_vSupply[u];
+            m_vPi[u] = -m_vCost[e];
+        }
+        else
+        {
+            m_vPredDir[u] = DIR_DOWN;
+            m_vFlow[e] = -m_vSupply[u];
+            m_vPi[u] = m_vCost[e];
+        }
+    }
+}
+
+template <typename GR, typename V>
+bool WarmStartNetworkSimplex<GR, V>::warmStart()
+{
+    value_type inf = infinity();
+    // non-tree arcs stay at their bounds, the remaining supply is carried by tree arcs
+    std::vector<value_type> vExcess (m_vSupply);
+    for (int e = 0; e < m_numArcs+m_numNodes; ++e)
+    {
+        if (m_vState[e] == STATE_TREE)
+            continue;
+        if (m_vState[e] == STATE_UPPER && m_vCap[e] >= inf)
+            m_vState[e] = STATE_LOWER;
+        m_vFlow[e] = (m_vState[e] == STATE_UPPER)? m_vCap[e] : 0;
+        vExcess[m_vSource[e]] -= m_vFlow[e];
+        vExcess[m_vTarget[e]] += m_vFlow[e];
+    }
+
+    // children before parents in the reversed preorder
+    std::vector<int> vOrder;
+    vOrder.reserve(m_numNodes+1);
+    m_vStack.assign(1, m_root);
+    while (!m_vStack.empty())
+    {
+        int u = m_vStack.back();
+        m_vStack.pop_back();
+        vOrder.push_back(u);
+        for (int c = m_vFirstChild[u]; c != -1; c = m_vNextSibling[c])
+            m_vStack.push_back(c);
+    }
+    for (int i = vOrder.size()-1; i > 0; --i)
+    {
+        int u = vOrder[i];
+        int e = m_vPred[u];
+        value_type f = m_vPredDir[u]*vExcess[u];
+        // strongly feasible, i.e., each node can send positive flow to the root
+        if (f < 0 || (m_vPredDir[u] == DIR_UP && m_vCap[e] < inf && f >= m_vCap[e]) || (m_vPredDir[u] == DIR_DOWN && f == 0))
+            return false;
+        m_vFlow[e] = f;
+        vExcess[m_vParent[u]] += vExcess[u];
+    }
+    updateSubtree(m_root);
+    return true;
+}
+
+template <typename GR, typename V>
+void WarmStartNetworkSimplex<GR, V>::updateSubtree(int root)
+{
+    if (root == m_root)
+    {
+        m_vDepth[root] = 0;
+        m_vPi[root] = 0;
+    }
+    m_vStack.assign(1, root);
+    while (!m_vStack.empty())
+    {
+        int u = m_vStack.back();
+        m_vStack.pop_back();
+        if (u != m_root)
+        {
+            int p = m_vParent[u];
+            m_vDepth[u] = m_vDepth[p]+1;
+            // reduced costs of tree arcs are zero
+            m_vPi[u] = m_vPi[p]-m_vPredDir[u]*m_vCost[m_vPred[u]];
+        }
+        for (int c = m_vFirstChild[u]; c != -1; c = m_vNextSibling[c])
+            m_vStack.push_back(c);
+    }
+}
+
+template <typename GR, typename V>
+bool WarmStartNetworkSimplex<GR, V>::findEnteringArc()
+{
+    value_type minCost = 0;
+    int count = m_blockSize;
+    int e = m_nextArc;
+    for (int i = 0; i < m_numArcs; ++i)
+    {
+        value_type c = m_vState[e]*(m_vCost[e]+m_vPi[m_vSource[e]]-m_vPi[m_vTarget[e]]);
+        if (c < minCost)
+        {
+            minCost = c;
+            m_inArc = e;
+        }
+        if (++e == m_numArcs)
+            e = 0;
+        if (--count == 0)
+        {
+            if (minCost < 0)
+                break;
+            count = m_blockSize;
+        }
+    }
+    m_nextArc = e;
+    return minCost < 0;
+}
+
+template <typename GR, typename V>
+void WarmStartNetworkSimplex<GR, V>::findJoinNode()
+{
+    int u = m_vSource[m_inArc];
+    int v = m_vTarget[m_inArc];
+    while (u != v)
+    {
+        if (m_vDepth[u] >= m_vDepth[v])
+            u = m_vParent[u];
+        else
+            v = m_vParent[v];
+    }
+    m_join = u;
+}
+
+template <typename GR, typename V>
+bool WarmStartNetworkSimplex<GR, V>::findLeavingArc()
+{
+    value_type inf = infinity();
+    // flow goes from the second node to the first node through the join node
+    int first = (m_vState[m_inArc] == STATE_LOWER)? m_vSource[m_inArc] : m_vTarget[m_inArc];
+    int second = (m_vState[m_inArc] == STATE_LOWER)? m_vTarget[m_inArc] : m_vSource[m_inArc];
+    m_delta = m_vCap[m_inArc];
+    int result = 0;
+    // ties on the second path are taken last to keep the tree strongly feasible
+    for (int u = first; u != m_join; u = m_vParent[u])
+    {
+        int e = m_vPred[u];
+        value_type d = m_vFlow[e];
+        if (m_vPredDir[u] == DIR_DOWN)
+            d = (m_vCap[e] >= inf)? inf : m_vCap[e]-d;
+        if (d < m_delta)
+        {
+            m_delta = d;
+            m_uOut = u;
+            result = 1;
+        }
+    }
+    for (int u = second; u != m_join; u = m_vParent[u])
+    {
+        int e = m_vPred[u];
+        value_type d = m_vFlow[e];
+        if (m_vPredDir[u] == DIR_UP)
+            d = (m_vCap[e] >= inf)? inf : m_vCap[e]-d;
+        if (d <= m_delta)
+        {
+            m_delta = d;
+            m_uOut = u;
+            result = 2;
+        }
+    }
+    m_uIn = (result == 1)? first : second;
+    m_vIn = (result == 1)? second : first;
+    return result != 0;
+}
+
+template <typename GR, typename V>
+void WarmStartNetworkSimplex<GR, V>::changeFlow(bool change)
+{
+    if (m_delta > 0)
+    {
+        value_type val = m_vState[m_inArc]*m_delta;
+        m_vFlow[m_inArc] += val;
+        for (int u = m_vSource[m_inArc]; u != m_join; u = m_vParent[u])
+            m_vFlow[m_vPred[u]] -= m_vPredDir[u]*val;
+        for (int u = m_vTarget[m_inArc]; u != m_join; u = m_vParent[u])
+            m_vFlow[m_vPred[u]] += m_vPredDir[u]*val;
+    }
+    if (change)
+    {
+        m_vState[m_inArc] = STATE_TREE;
+        m_vState[m_vPred[m_uOut]] = (m_vFlow[m_vPred[m_uOut]] == 0)? STATE_LOWER : STATE_UPPER;
+    }
+    else
+        m_vState[m_inArc] = -m_vState[m_inArc];
+}
+
+template <typename GR, typename V>
+void WarmStartNetworkSimplex<GR, V>::updateTreeStructure()
+{
+    // reverse the path from u_in to u_out, then hang it below v_in
+    int prevNode = m_vIn;
+    int prevArc = m_inArc;
+    int u = m_uIn;
+    while (true)
+    {
+        int nextNode = m_vParent[u];
+        int nextArc = m_vPred[u];
+        unlinkChild(u);
+        linkChild(prevNode, u);
+        m_vPred[u] = prevArc;
+        m_vPredDir[u] = (m_vSource[prevArc] == u)? DIR_UP : DIR_DOWN;
+        if (u == m_uOut)
+            break;
+        prevNode = u;
+        prevArc = nextArc;
+        u = nextNode;
+    }
+}
+
+template <typename GR, typename V>
+void WarmStartNetworkSimplex<GR, V>::linkChild(int parent, int child)
+{
+    int first = m_vFirstChild[parent];
+    m_vParent[child] = parent;
+    m_vPrevSibling[child] = -1;
+    m_vNextSibling[child] = first;
+    if (first != -1)
+        m_vPrevSibling[first] = child;
+    m_vFirstChild[parent] = child;
+}
+
+template <typename GR, typename V>
+void WarmStartNetworkSimplex<GR, V>::unlinkChild(int child)
+{
+    int prev = m_vPrevSibling[child];
+    int next = m_vNextSibling[child];
+    if (prev == -1)
+        m_vFirstChild[m_vParent[child]] = next;
+    else
+        m_vNextSibling[prev] = next;
+    if (next != -1)
+        m_vPrevSibling[next] = prev;
+}
+
+} // namespace solvers
+} // namespace limbo
+
+#endif
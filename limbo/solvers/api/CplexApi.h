@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <pthread.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/assert.hpp> 
@@ -36,13 +37,16 @@ namespace limbo
 namespace solvers 
 {
 
-/// @brief Base class for custom CPLEX parameters 
-class CplexParameters
+/// @brief Base class for custom CPLEX parameters. 
+/// The limits of @ref limbo::solvers::SolveControl map onto parameters of the environment, 
+/// and the incumbent callback is called at improving candidates by @ref limbo::solvers::CplexLinearApi. 
+class CplexParameters : public SolveControl
 {
     public:
         /// @brief constructor 
         CplexParameters() 
-            : m_outputFlag(0)
+            : SolveControl()
+            , m_outputFlag(0)
             , m_numThreads(std::numeric_limits<int>::max())
         {
         }
@@ -62,6 +66,14 @@ class CplexParameters
             }
             if (m_numThreads > 0 && m_numThreads != std::numeric_limits<int>::max())
               CPXXsetintparam(env, CPXPARAM_Threads, m_numThreads);
+            if (m_timeLimit > 0)
+              CPXXsetdblparam(env, CPXPARAM_TimeLimit, m_timeLimit);
+            if (m_mipGap >= 0)
+              CPXXsetdblparam(env, CPXPARAM_MIP_Tolerances_MIPGap, m_mipGap);
+            if (m_nodeLimit > 0)
+              CPXXsetlongparam(env, CPXPARAM_MIP_Limits_Nodes, m_nodeLimit);
+            if (m_solutionLimit > 0)
+              CPXXsetlongparam(env, CPXPARAM_MIP_Limits_Solutions, m_solutionLimit);
         }
         /// @brief customize model 
         /// 
@@ -102,6 +114,29 @@ struct SmartRound<T, 1>
     }
 }; 
 
+/// @brief whether CPLEX has a solution at a status 
+/// @param solstat status of CPLEX 
+/// @return true if a solution can be read 
+inline bool cplexHasSolution(int solstat)
+{
+    switch (solstat)
+    {
+        case CPXMIP_TIME_LIM_INFEAS:
+        case CPXMIP_NODE_LIM_INFEAS:
+        case CPXMIP_ABORT_INFEAS:
+        case CPXMIP_INFEASIBLE:
+        case CPXMIP_INForUNBD:
+        case CPXMIP_UNBOUNDED:
+        case CPX_STAT_INFEASIBLE:
+        case CPX_STAT_INForUNBD:
+        case CPX_STAT_UNBOUNDED:
+        case CPX_STAT_ABORT_TIME_LIM:
+            return false; 
+        default:
+            return true; 
+    }
+}
+
 /// @brief CPLEX API with @ref limbo::solvers::LinearModel
 /// @tparam T coefficient type 
 /// @tparam V variable type 
@@ -127,11 +162,16 @@ class CplexLinearApi
         CplexLinearApi(model_type* model)
             : m_model(model)
               , m_cplexModel(NULL)
+              , m_incumbent(NULL)
+              , m_incumbentObjective(0)
+              , m_numIncumbents(0)
         {
+            pthread_mutex_init(&m_incumbentLock, NULL); 
         }
         /// @brief destructor 
         ~CplexLinearApi()
         {
+            pthread_mutex_destroy(&m_incumbentLock); 
         }
         
         /// @brief API to run the algorithm 
@@ -165,108 +205,61 @@ class CplexLinearApi
               limboAssertMsg(0, "Could not create model");
             }
 
+            // build arrays of the model once and load them in bulk 
+            LinearModelArrays<T, V> arrays; 
+            arrays.set(*m_model); 
             CPXDIM   numcols = m_model->numVariables();
             CPXDIM   numrows = m_model->constraints().size();
-            int      objsen;
-            std::vector<double> obj (numcols, 0);
-            std::vector<double> rhs (numrows, 0);
-            std::vector<char> sense (numrows, '=');
-            // follows compressed sparse column format 
-            std::vector<CPXNNZ> matbeg (numcols, 0);
-            std::vector<CPXDIM> matcnt (numcols, 0);
-            std::vector<double> lb (numcols);
-            std::vector<double> ub (numcols);
-            std::vector<char> ctype (numcols);
-            // create variables 
-            for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
-            {
-                variable_type var (i);
-                lb[var.id()] = m_model->variableLowerBound(var);
-                ub[var.id()] = m_model->variableUpperBound(var);
-                // error = GRBsetdblattrelement(m_cplexModel, GRB_DBL_ATTR_START, var.id(), m_model->variableSolution(var));
-                ctype[var.id()] = m_model->variableNumericType(var) == CONTINUOUS? 'C' : 'I';
-                limboAssertMsg(!(std::numeric_limits<V>::is_integer && m_model->variableNumericType(var) == CONTINUOUS), 
-                    "LinearModel<T, V> is declared as V = integer type, but variable %s is CONTINUOUS", m_model->variableName(var).c_str());
-            }
-
-            // create constraints 
-            // initialize matcnt 
-            for (unsigned int i = 0, ie = m_model->constraints().size(); i < ie; ++i)
+            for (CPXDIM i = 0; i < numrows; ++i)
             {
-                constraint_type const& constr = m_model->constraints().at(i);
-
-                for (typename std::vector<term_type>::const_iterator it = constr.expression().terms().begin(), ite = constr.expression().terms().end(); it != ite; ++it)
-                {
-                    if (it->coefficient() != 0)
-                    {
-                      matcnt[it->variable().id()] += 1; 
-                      limboAssert(it->variable().id() < matcnt.size());
-                    }
-                }
-            }
-            // initialize matbeg 
-            int numnz = 0; // number of non-zeros in constraint matrix 
-            for (unsigned int i = 0; i < numcols - 1; ++i)
-            {
-              matbeg[i + 1] = matbeg[i] + matcnt[i];
-              numnz += matcnt[i];
-            }
-            numnz += matcnt.back();
-            // initialize matind, matval, sense, rhs
-            std::vector<CPXDIM> matind (numnz, 0);
-            std::vector<double> matval (numnz, 0);
-            std::vector<CPXDIM> curcnt (numcols, 0); // intermediate count of how many elements filled in each column 
-            for (unsigned int i = 0, ie = m_model->constraints().size(); i < ie; ++i)
-            {
-                constraint_type const& constr = m_model->constraints().at(i);
-
-                for (typename std::vector<term_type>::const_iterator it = constr.expression().terms().begin(), ite = constr.expression().terms().end(); it != ite; ++it)
-                {
-                    if (it->coefficient() != 0)
-                    {
-                      matind[matbeg[it->variable().id()] + curcnt[it->variable().id()]] = i; 
-                      matval[matbeg[it->variable().id()] + curcnt[it->variable().id()]] = it->coefficient(); 
-                      limboAssert(matbeg[it->variable().id()] + curcnt[it->variable().id()] < matind.size());
-                      curcnt[it->variable().id()] += 1; 
-                    }
-                }
-
-                switch (constr.sense())
+                switch (arrays.vSense[i])
                 {
                   case '<':
-                    sense[i] = 'L'; break; 
+                    arrays.vSense[i] = 'L'; break; 
                   case '=':
-                    sense[i] = 'E'; break; 
+                    arrays.vSense[i] = 'E'; break; 
                   case '>':
-                    sense[i] = 'G'; break; 
+                    arrays.vSense[i] = 'G'; break; 
                   default:
-                    limboAssertMsg(0, "Unknown sense for row %u: %c", i, constr.sense());
+                    limboAssertMsg(0, "Unknown sense for row %d: %c", i, arrays.vSense[i]);
                     break; 
                 }
-
-                rhs[i] = constr.rightHandSide();
             }
-
-            // create objective 
-            for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
-            {
-              obj[it->variable().id()] = it->coefficient();
-            }
-            objsen = m_model->optimizeType() == MIN? CPX_MIN : CPX_MAX;
+            // follows compressed sparse row format 
+            std::vector<CPXNNZ> rmatbeg (arrays.constrMatrix.vRowBeginIndex, arrays.constrMatrix.vRowBeginIndex+numrows);
 
             // call parameter setting before optimization 
             param->operator()(m_cplexModel); 
-            status = CPXXcopylp (env, m_cplexModel, numcols, numrows, objsen, obj.data(), rhs.data(),
-                sense.data(), matbeg.data(), matcnt.data(), matind.data(), matval.data(),
-                lb.data(), ub.data(), NULL);
+            status = CPXXchgobjsen (env, m_cplexModel, m_model->optimizeType() == MIN? CPX_MIN : CPX_MAX);
+            if (status)
+            {
+              limboAssertMsg(0, "CPXXchgobjsen failed");
+            }
+            // create variables with objective, the types make it a MIP 
+            status = CPXXnewcols (env, m_cplexModel, numcols, arrays.vObjective.data(), 
+                arrays.vLowerBound.data(), arrays.vUpperBound.data(), arrays.vType.data(), NULL);
             if (status)
             {
-              limboAssertMsg(0, "CPXXcopylp failed");
+              limboAssertMsg(0, "CPXXnewcols failed");
             }
-            status = CPXXcopyctype (env, m_cplexModel, ctype.data());
+            // create constraints 
+            status = CPXXaddrows (env, m_cplexModel, 0, numrows, arrays.constrMatrix.numElements, arrays.vRhs.data(), 
+                arrays.vSense.data(), rmatbeg.data(), arrays.constrMatrix.vColumn, arrays.constrMatrix.vElement, NULL, NULL);
             if (status)
             {
-              limboAssertMsg(0, "CPXXcopyctype failed");
+              limboAssertMsg(0, "CPXXaddrows failed");
+            }
+
+            // report improving candidates, which CPLEX may check from several threads 
+            m_incumbent = param->incumbentCallback(); 
+            m_numIncumbents = 0; 
+            if (m_incumbent)
+            {
+                status = CPXXcallbacksetfunc (env, m_cplexModel, CPX_CALLBACKCONTEXT_CANDIDATE, CplexLinearApi::callback, this);
+                if (status)
+                {
+                  limboAssertMsg(0, "CPXXcallbacksetfunc failed");
+                }
             }
 
 #ifdef DEBUG_CPLEXAPI
@@ -310,11 +303,15 @@ class CplexLinearApi
             }
 #endif 
 
-            std::vector<double> x (numcols, 0);
-            status = CPXXgetx (env, m_cplexModel, x.data(), 0, numcols-1);
-            if (status)
+            // at a limit, the start is kept if no solution is found 
+            std::vector<double> x (m_model->variableSolutions().begin(), m_model->variableSolutions().end());
+            if (numcols && cplexHasSolution(solstat))
             {
-              limboAssertMsg(0, "CPXXgetx failed");
+                status = CPXXgetx (env, m_cplexModel, x.data(), 0, numcols-1);
+                if (status)
+                {
+                  limboAssertMsg(0, "CPXXgetx failed");
+                }
             }
             // round if the variable type is integer 
             SmartRound<V> sround; 
@@ -350,7 +347,16 @@ class CplexLinearApi
             {
                 //case CPX_STAT_OPTIMAL:
                 case CPXMIP_OPTIMAL:
+                case CPXMIP_OPTIMAL_TOL:
                     return OPTIMAL;
+                case CPXMIP_TIME_LIM_FEAS:
+                case CPXMIP_TIME_LIM_INFEAS:
+                case CPXMIP_NODE_LIM_FEAS:
+                case CPXMIP_NODE_LIM_INFEAS:
+                case CPXMIP_SOL_LIM:
+                case CPXMIP_ABORT_FEAS:
+                case CPXMIP_ABORT_INFEAS:
+                    return SUBOPTIMAL;
                 //case CPX_STAT_INFEASIBLE:
                 case CPXMIP_INFEASIBLE:
                     return INFEASIBLE;
@@ -371,9 +377,302 @@ class CplexLinearApi
         /// @brief assignment, forbidden 
         /// @param rhs right hand side 
         CplexLinearApi& operator=(CplexLinearApi const& rhs);
+        /// @brief callback of CPLEX at each candidate, which reports improving ones as incumbents 
+        /// @param context context of the callback 
+        /// @param contextid where the callback is called 
+        /// @param userhandle pointer to this object 
+        /// @return 0 if succeed, otherwise an error code of CPLEX 
+        static int CPXPUBLIC callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, void* userhandle); 
 
         model_type* m_model; ///< model for the problem 
         CPXLPptr m_cplexModel; ///< model for CPLEX 
+        IncumbentCallback* m_incumbent; ///< callback at each new incumbent of the current solve, NULL if disabled 
+        double m_incumbentObjective; ///< objective of the last incumbent reported 
+        long m_numIncumbents; ///< number of incumbents reported in the current solve 
+        pthread_mutex_t m_incumbentLock; ///< lock of incumbents, as candidates come from several threads 
+};
+
+template <typename T, typename V>
+int CPXPUBLIC CplexLinearApi<T, V>::callback(CPXCALLBACKCONTEXTptr context, CPXLONG contextid, void* userhandle)
+{
+    if (contextid != CPX_CALLBACKCONTEXT_CANDIDATE)
+        return 0; 
+    CplexLinearApi* api = static_cast<CplexLinearApi*>(userhandle); 
+    int isPoint = 0; 
+    int status = CPXXcallbackcandidateispoint (context, &isPoint); 
+    if (status || !isPoint)
+        return status; 
+    std::vector<double> vSolution (api->m_model->numVariables()); 
+    double objective = 0; 
+    status = CPXXcallbackgetcandidatepoint (context, (vSolution.empty())? NULL : vSolution.data(), 0, (CPXDIM)vSolution.size()-1, &objective); 
+    if (status)
+        return status; 
+    bool stop = false; 
+    pthread_mutex_lock(&api->m_incumbentLock); 
+    // candidates are not always better than the incumbent 
+    bool improved = (api->m_numIncumbents == 0 
+            || (api->m_model->optimizeType() == MIN && objective < api->m_incumbentObjective) 
+            || (api->m_model->optimizeType() == MAX && objective > api->m_incumbentObjective)); 
+    if (improved)
+    {
+        api->m_incumbentObjective = objective; 
+        ++api->m_numIncumbents; 
+        stop = !(*api->m_incumbent)(vSolution, objective); 
+    }
+    pthread_mutex_unlock(&api->m_incumbentLock); 
+    if (stop)
+        status = CPXXcallbackabort (context); 
+    return status; 
+}
+
+/// @brief CPLEX problem kept alive across solves of a @ref limbo::solvers::LinearModel. 
+/// 
+/// The session loads the model once, applies each modification to both the @ref limbo::solvers::LinearModel and the CPLEX problem, 
+/// and re-solves from the previous basis with dual simplex for LP, or from the previous solution as a MIP start. 
+/// A model with only continuous variables is loaded as LP. 
+/// The @ref limbo::solvers::LinearModel must only be modified through the session while it is alive. 
+/// @tparam T coefficient type 
+/// @tparam V variable type 
+template <typename T, typename V>
+class CplexLinearSession 
+{
+    public:
+        /// @brief linear model type for the problem 
+        typedef LinearModel<T, V> model_type; 
+        /// @nowarn
+        typedef typename model_type::coefficient_value_type coefficient_value_type; 
+        typedef typename model_type::variable_value_type variable_value_type; 
+        typedef typename model_type::variable_type variable_type;
+        typedef typename model_type::constraint_type constraint_type; 
+        typedef typename model_type::term_type term_type; 
+        typedef CplexParameters parameter_type; 
+        /// @endnowarn
+
+        /// @brief constructor, load the model 
+        /// @param model pointer to the model of problem 
+        /// @param param set additional parameters, use default if NULL 
+        CplexLinearSession(model_type* model, parameter_type const* param = NULL)
+            : m_model(model)
+            , m_env(NULL)
+            , m_cplexModel(NULL)
+            , m_mip(false)
+        {
+            CplexParameters defaultParam; 
+            if (param == NULL)
+                param = &defaultParam; 
+            int status = 0; 
+            m_env = CPXXopenCPLEX (&status);
+            limboAssertMsg(m_env, "Could not open CPLEX environment");
+            // dual simplex re-solves from the previous basis 
+            CPXXsetintparam (m_env, CPXPARAM_LPMethod, CPX_ALG_DUAL);
+            param->operator()(m_env); 
+            m_cplexModel = CPXXcreateprob (m_env, &status, "CplexLinearSession");
+            limboAssertMsg(status == 0, "Could not create model");
+
+            LinearModelArrays<T, V> arrays; 
+            arrays.set(*m_model); 
+            CPXDIM numcols = m_model->numVariables();
+            CPXDIM numrows = m_model->constraints().size();
+            for (CPXDIM i = 0; i < numcols; ++i)
+                m_mip |= (arrays.vType[i] != 'C'); 
+            for (CPXDIM i = 0; i < numrows; ++i)
+                arrays.vSense[i] = sense(arrays.vSense[i]); 
+            std::vector<CPXNNZ> rmatbeg (arrays.constrMatrix.vRowBeginIndex, arrays.constrMatrix.vRowBeginIndex+numrows);
+
+            param->operator()(m_cplexModel); 
+            errorHandler(CPXXchgobjsen (m_env, m_cplexModel, m_model->optimizeType() == MIN? CPX_MIN : CPX_MAX), "CPXXchgobjsen"); 
+            errorHandler(CPXXnewcols (m_env, m_cplexModel, numcols, arrays.vObjective.data(), 
+                arrays.vLowerBound.data(), arrays.vUpperBound.data(), (m_mip)? arrays.vType.data() : NULL, NULL), "CPXXnewcols"); 
+            errorHandler(CPXXaddrows (m_env, m_cplexModel, 0, numrows, arrays.constrMatrix.numElements, arrays.vRhs.data(), 
+                arrays.vSense.data(), rmatbeg.data(), arrays.constrMatrix.vColumn, arrays.constrMatrix.vElement, NULL, NULL), "CPXXaddrows"); 
+        }
+        /// @brief destructor, free the CPLEX problem and environment 
+        ~CplexLinearSession()
+        {
+            CPXXfreeprob (m_env, &m_cplexModel);
+            CPXXcloseCPLEX (&m_env);
+        }
+
+        /// @brief solve or re-solve the model and write solutions to the @ref limbo::solvers::LinearModel 
+        /// @return solving status 
+        SolverProperty operator()()
+        {
+            CPXDIM numcols = m_model->numVariables();
+            std::vector<double> x (m_model->variableSolutions().begin(), m_model->variableSolutions().end()); 
+            if (m_mip)
+            {
+                // the last solution is a MIP start 
+                if (numcols)
+                {
+                    std::vector<CPXDIM> vIdx (numcols); 
+                    for (CPXDIM i = 0; i < numcols; ++i)
+                        vIdx[i] = i; 
+                    CPXNNZ beg = 0; 
+                    int effort = CPX_MIPSTART_AUTO; 
+                    errorHandler(CPXXaddmipstarts (m_env, m_cplexModel, 1, numcols, &beg, vIdx.data(), x.data(), &effort, NULL), "CPXXaddmipstarts"); 
+                }
+                errorHandler(CPXXmipopt (m_env, m_cplexModel), "CPXXmipopt"); 
+            }
+            else 
+                errorHandler(CPXXlpopt (m_env, m_cplexModel), "CPXXlpopt"); 
+#ifdef DEBUG_CPLEXAPI
+            errorHandler(CPXXwriteprob (m_env, m_cplexModel, "problem.lp", NULL), "CPXXwriteprob"); 
+#endif 
+
+            int solstat = CPXXgetstat (m_env, m_cplexModel);
+            SolverProperty result = OPTIMAL; 
+            switch (solstat)
+            {
+                case CPX_STAT_OPTIMAL:
+                case CPXMIP_OPTIMAL:
+                case CPXMIP_OPTIMAL_TOL:
+                    break; 
+                // at a limit, the last solution is kept if no solution is found 
+                case CPX_STAT_ABORT_TIME_LIM:
+                case CPXMIP_TIME_LIM_FEAS:
+                case CPXMIP_TIME_LIM_INFEAS:
+                case CPXMIP_NODE_LIM_FEAS:
+                case CPXMIP_NODE_LIM_INFEAS:
+                case CPXMIP_SOL_LIM:
+                case CPXMIP_ABORT_FEAS:
+                case CPXMIP_ABORT_INFEAS:
+                    result = SUBOPTIMAL; 
+                    break; 
+                case CPX_STAT_INFEASIBLE:
+                case CPXMIP_INFEASIBLE:
+                    return INFEASIBLE;
+                case CPX_STAT_INForUNBD:
+                case CPX_STAT_UNBOUNDED:
+                case CPXMIP_INForUNBD:
+                case CPXMIP_UNBOUNDED:
+                    return UNBOUNDED;
+                default:
+                    limboAssertMsg(0, "unknown status %d", solstat);
+            }
+            if (numcols && cplexHasSolution(solstat))
+                errorHandler(CPXXgetx (m_env, m_cplexModel, x.data(), 0, numcols-1), "CPXXgetx"); 
+            SmartRound<V> sround; 
+            for (CPXDIM i = 0; i < numcols; ++i)
+                m_model->setVariableSolution(m_model->variable(i), sround(x[i]));
+            return result; 
+        }
+
+        /// @brief add a constraint, a constraint of one term updates bounds as @ref limbo::solvers::LinearModel::addConstraint 
+        /// @param constr constraint 
+        /// @param name constraint name 
+        /// @return true if added 
+        bool addConstraint(constraint_type const& constr, std::string const& name = "")
+        {
+            unsigned int numConstraints = m_model->constraints().size(); 
+            if (!m_model->addConstraint(constr, name))
+                return false; 
+            if (m_model->constraints().size() == numConstraints) // bound constraint 
+            {
+                variable_type var = constr.expression().terms().front().variable(); 
+                changeBounds(var.id(), m_model->variableLowerBound(var), m_model->variableUpperBound(var)); 
+            }
+            else 
+            {
+                constraint_type const& added = m_model->constraints().back(); 
+                std::vector<CPXDIM> vIdx; 
+                std::vector<double> vValue; 
+                vIdx.reserve(added.expression().terms().size()); 
+                vValue.reserve(added.expression().terms().size()); 
+                for (typename std::vector<term_type>::const_iterator it = added.expression().terms().begin(), ite = added.expression().terms().end(); it != ite; ++it)
+                {
+                    vIdx.push_back(it->variable().id()); 
+                    vValue.push_back(it->coefficient());
+                }
+                double rhs = added.rightHandSide(); 
+                char s = sense(added.sense()); 
+                CPXNNZ beg = 0; 
+                errorHandler(CPXXaddrows (m_env, m_cplexModel, 0, 1, vIdx.size(), &rhs, &s, &beg, vIdx.data(), vValue.data(), NULL, NULL), "CPXXaddrows"); 
+            }
+            return true; 
+        }
+        /// @brief remove constraints, the remaining ones are renumbered as @ref limbo::solvers::LinearModel::removeConstraints 
+        /// @param vConstraintId indices of constraints 
+        void removeConstraints(std::vector<unsigned int> const& vConstraintId)
+        {
+            if (vConstraintId.empty())
+                return; 
+            std::vector<CPXDIM> vDelStat (m_model->constraints().size(), 0); 
+            for (std::vector<unsigned int>::const_iterator it = vConstraintId.begin(); it != vConstraintId.end(); ++it)
+                vDelStat.at(*it) = 1; 
+            m_model->removeConstraints(vConstraintId); 
+            errorHandler(CPXXdelsetrows (m_env, m_cplexModel, vDelStat.data()), "CPXXdelsetrows"); 
+        }
+        /// @brief change bounds of a variable 
+        /// @param var variable 
+        /// @param lb lower bound 
+        /// @param ub upper bound 
+        void setVariableBounds(variable_type const& var, variable_value_type lb, variable_value_type ub)
+        {
+            m_model->setVariableLowerBound(var, lb); 
+            m_model->setVariableUpperBound(var, ub); 
+            changeBounds(var.id(), lb, ub); 
+        }
+        /// @brief change the coefficient of a variable in the objective 
+        /// @param var variable 
+        /// @param coef coefficient 
+        void setObjectiveCoefficient(variable_type const& var, coefficient_value_type coef)
+        {
+            m_model->setObjectiveCoefficient(var, coef); 
+            CPXDIM idx = var.id(); 
+            double value = coef; 
+            errorHandler(CPXXchgobj (m_env, m_cplexModel, 1, &idx, &value), "CPXXchgobj"); 
+        }
+        /// @return CPLEX problem 
+        CPXLPptr cplexModel() const {return m_cplexModel;}
+
+    protected:
+        /// @brief copy constructor, forbidden 
+        /// @param rhs right hand side 
+        CplexLinearSession(CplexLinearSession const& rhs);
+        /// @brief assignment, forbidden 
+        /// @param rhs right hand side 
+        CplexLinearSession& operator=(CplexLinearSession const& rhs);
+        /// @param s sense of @ref limbo::solvers::LinearConstraint
+        /// @return sense of CPLEX 
+        static char sense(char s)
+        {
+            switch (s)
+            {
+                case '<':
+                    return 'L'; 
+                case '>':
+                    return 'G'; 
+                case '=':
+                    return 'E'; 
+                default:
+                    limboAssertMsg(0, "Unknown sense %c", s);
+                    return 'E'; 
+            }
+        }
+        /// @brief change bounds of a column 
+        /// @param idx column index 
+        /// @param lb lower bound 
+        /// @param ub upper bound 
+        void changeBounds(CPXDIM idx, double lb, double ub)
+        {
+            CPXDIM vIdx[2] = {idx, idx}; 
+            char vLu[2] = {'L', 'U'}; 
+            double vBd[2] = {lb, ub}; 
+            errorHandler(CPXXchgbds (m_env, m_cplexModel, 2, vIdx, vLu, vBd), "CPXXchgbds"); 
+        }
+        /// @brief error handler 
+        /// @param status status returned by CPLEX 
+        /// @param func name of the function 
+        void errorHandler(int status, char const* func) const 
+        {
+            if (status)
+                limboAssertMsg(0, "%s failed", func);
+        }
+
+        model_type* m_model; ///< model for the problem 
+        CPXENVptr m_env; ///< environment 
+        CPXLPptr m_cplexModel; ///< model for CPLEX, alive with the session 
+        bool m_mip; ///< whether some variables are integer 
 };
 
 } // namespace solvers
@@ -33,6 +33,24 @@ extern "C" {
 #ifdef __cplusplus
 }
 #endif
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
+#include <limbo/preprocessor/AssertMsg.h>
+#include <limbo/containers/TaskPool.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if MKL == 1
+#include <mkl.h>
+#endif
+
+/// @cond
+// BLAS libraries with threads export these, weak declarations resolve to NULL otherwise 
+#if defined(__GNUC__) && !defined(_WIN32)
+extern "C" void openblas_set_num_threads(int) __attribute__((weak)); 
+#endif
+/// @endcond
 
 /// namespace for Limbo 
 namespace limbo 
@@ -41,6 +59,217 @@ namespace limbo
 namespace solvers 
 {
 
+/// @brief Set the number of threads of the routines Csdp calls in the calling thread. 
+/// 
+/// OpenMP loops of Csdp and MKL take the setting of the calling thread, 
+/// so concurrent solves in different threads may use different numbers; 
+/// OpenBLAS with threads takes a setting of the process. 
+/// Many small SDPs solved concurrently should use 1 thread each, 
+/// while one big SDP may use all cores. 
+/// The bundled OpenBLAS is built without threads, leaving the OpenMP loops. 
+/// @param numThreads number of threads, at most @ref limbo::containers::num_threads are used 
+inline void setCsdpNumThreads(int numThreads)
+{
+    numThreads = std::max(std::min(numThreads, (int)limbo::containers::num_threads()), 1); 
+#ifdef _OPENMP
+    omp_set_num_threads(numThreads); 
+#endif
+#if MKL == 1
+    mkl_set_num_threads_local(numThreads); 
+#endif
+#if defined(__GNUC__) && !defined(_WIN32)
+    if (openblas_set_num_threads)
+        openblas_set_num_threads(numThreads); 
+#endif
+}
+
+/// @brief Working storage of @ref limbo::solvers::easy_sdp_ext kept across solves. 
+/// 
+/// The storage of Csdp takes dozens of block matrices and vectors of the problem size, 
+/// which are allocated and freed at each call of easy_sdp. 
+/// A workspace keeps them, and a later problem with the same kinds of blocks reuses them if they are large enough, 
+/// e.g., SDPs of components in graph coloring, which have a MATRIX block for vertices and a DIAG block for edges. 
+/// Each workspace serves one solve at a time; @ref threadLocal gives one for each thread. 
+class CsdpWorkspace
+{
+    public:
+        /// @brief constructor 
+        CsdpWorkspace()
+            : m_numThreads(0)
+        {
+            for (int i = 0; i < NUM_MATRICES; ++i)
+            {
+                m_vMatrix[i].nblocks = 0; 
+                m_vMatrix[i].blocks = NULL; 
+            }
+        }
+        /// @brief destructor 
+        ~CsdpWorkspace()
+        {
+            for (int i = 0; i < NUM_MATRICES; ++i)
+                freeMatrix(i); 
+        }
+
+        /// @brief get the workspace of the calling thread, created at the first call and freed when the thread exits 
+        /// @return workspace 
+        static CsdpWorkspace& threadLocal()
+        {
+            static pthread_once_t once = PTHREAD_ONCE_INIT; 
+            pthread_once(&once, CsdpWorkspace::createKey); 
+            CsdpWorkspace* workspace = static_cast<CsdpWorkspace*>(pthread_getspecific(key())); 
+            if (workspace == NULL)
+            {
+                workspace = new CsdpWorkspace; 
+                pthread_setspecific(key(), workspace); 
+            }
+            return *workspace; 
+        }
+
+        /// @brief set the number of threads applied by @ref setCsdpNumThreads at each solve 
+        /// @param t number of threads, 0 to keep the current setting 
+        void setNumThreads(int t) {m_numThreads = t;}
+        /// @return number of threads at each solve, 0 to keep the current setting 
+        int numThreads() const {return m_numThreads;}
+
+        /// @brief prepare storage for a problem, reusing the previous one if large enough 
+        /// @param n dimension of the problem 
+        /// @param k number of constraints 
+        /// @param C objective matrix, giving the structure of blocks 
+        void reserve(int n, int k, struct blockmatrix const& C)
+        {
+            for (int i = 0; i < NUM_MATRICES; ++i)
+                reserveMatrix(i, C, i >= NUM_FULL_MATRICES); 
+            std::size_t size = std::max(n, k)+1; 
+            for (int i = 0; i < NUM_NK_VECTORS; ++i)
+                m_vNKVector[i].resize(std::max(m_vNKVector[i].size(), size)); 
+            for (int i = 0; i < NUM_K_VECTORS; ++i)
+                m_vKVector[i].resize(std::max(m_vKVector[i].size(), (std::size_t)k+1)); 
+            // leading dimension of O, not k itself for cache issues 
+            m_ldam = (k%2 == 0)? k+1 : k; 
+            m_vO.resize(std::max(m_vO.size(), (std::size_t)m_ldam*m_ldam)); 
+            m_vByBlocks.resize(std::max(m_vByBlocks.size(), (std::size_t)C.nblocks+1)); 
+        }
+
+        /// @nowarn
+        // block matrices with the structure of C, the last ones packed 
+        enum MatrixIndex {WORK1, WORK2, WORK3, ZI, DZ, DX, NUM_FULL_MATRICES, 
+            BESTX = NUM_FULL_MATRICES, BESTZ, CHOLXINV, CHOLZINV, NUM_MATRICES}; 
+        // vectors of max(n, k)+1 
+        enum NKVectorIndex {WORKVEC1, WORKVEC2, WORKVEC3, WORKVEC4, WORKVEC5, WORKVEC6, WORKVEC7, WORKVEC8, DIAGO, NUM_NK_VECTORS}; 
+        // vectors of k+1 
+        enum KVectorIndex {BESTY, RHS, DY, DY1, FP, NUM_K_VECTORS}; 
+        /// @endnowarn
+
+        /// @return block matrix 
+        /// @param i index of the matrix 
+        struct blockmatrix& matrix(MatrixIndex i) {return m_vMatrix[i];}
+        /// @return vector of size max(n, k)+1 
+        /// @param i index of the vector 
+        double* nkVector(NKVectorIndex i) {return &m_vNKVector[i][0];}
+        /// @return vector of size k+1 
+        /// @param i index of the vector 
+        double* kVector(KVectorIndex i) {return &m_vKVector[i][0];}
+        /// @return matrix O 
+        double* O() {return &m_vO[0];}
+        /// @return leading dimension of O 
+        int ldam() const {return m_ldam;}
+        /// @return pointers of the first sparse block of each block 
+        struct sparseblock** byblocks() {return &m_vByBlocks[0];}
+
+    protected:
+        /// @brief copy constructor, forbidden 
+        /// @param rhs right hand side 
+        CsdpWorkspace(CsdpWorkspace const& rhs);
+        /// @brief assignment, forbidden 
+        /// @param rhs right hand side 
+        CsdpWorkspace& operator=(CsdpWorkspace const& rhs);
+
+        /// @return number of doubles of a block 
+        /// @param category category of the block in C 
+        /// @param blocksize size of the block 
+        /// @param packed whether a MATRIX block is packed 
+        static std::size_t blockCapacity(enum blockcat category, int blocksize, bool packed)
+        {
+            if (category == DIAG)
+                return blocksize+1; 
+            return (packed)? (std::size_t)blocksize*(blocksize+1)/2 : (std::size_t)blocksize*blocksize; 
+        }
+        /// @brief shape a matrix to the blocks of C, reallocating only blocks that are too small 
+        /// @param i index of the matrix 
+        /// @param C objective matrix 
+        /// @param packed whether MATRIX blocks are packed 
+        void reserveMatrix(int i, struct blockmatrix const& C, bool packed)
+        {
+            struct blockmatrix& B = m_vMatrix[i]; 
+            std::vector<std::size_t>& vCapacity = m_vCapacity[i]; 
+            if (B.nblocks != C.nblocks)
+            {
+                freeMatrix(i); 
+                B.nblocks = C.nblocks; 
+                B.blocks = (struct blockrec*)malloc(sizeof(struct blockrec)*(C.nblocks+1)); 
+                limboAssertMsg(B.blocks, "Storage allocation failed"); 
+                vCapacity.assign(C.nblocks+1, 0); 
+                for (int blk = 1; blk <= C.nblocks; ++blk)
+                    B.blocks[blk].data.vec = NULL; 
+            }
+            for (int blk = 1; blk <= C.nblocks; ++blk)
+            {
+                enum blockcat category = C.blocks[blk].blockcategory; 
+                std::size_t capacity = blockCapacity(category, C.blocks[blk].blocksize, packed); 
+                if (vCapacity[blk] < capacity)
+                {
+                    free(B.blocks[blk].data.vec); 
+                    B.blocks[blk].data.vec = (double*)malloc(sizeof(double)*capacity); 
+                    limboAssertMsg(B.blocks[blk].data.vec, "Storage allocation failed"); 
+                    vCapacity[blk] = capacity; 
+                }
+                B.blocks[blk].blockcategory = (category == MATRIX && packed)? PACKEDMATRIX : category; 
+                B.blocks[blk].blocksize = C.blocks[blk].blocksize; 
+            }
+        }
+        /// @brief free a matrix 
+        /// @param i index of the matrix 
+        void freeMatrix(int i)
+        {
+            struct blockmatrix& B = m_vMatrix[i]; 
+            if (B.blocks)
+            {
+                for (int blk = 1; blk <= B.nblocks; ++blk)
+                    free(B.blocks[blk].data.vec); 
+                free(B.blocks); 
+            }
+            B.nblocks = 0; 
+            B.blocks = NULL; 
+            m_vCapacity[i].clear(); 
+        }
+        /// @return key of thread-specific workspaces 
+        static pthread_key_t& key()
+        {
+            static pthread_key_t k; 
+            return k; 
+        }
+        /// @brief create the key with the destructor of workspaces 
+        static void createKey()
+        {
+            pthread_key_create(&key(), CsdpWorkspace::destroy); 
+        }
+        /// @brief free a workspace when its thread exits 
+        /// @param workspace workspace 
+        static void destroy(void* workspace)
+        {
+            delete static_cast<CsdpWorkspace*>(workspace); 
+        }
+
+        int m_numThreads; ///< number of threads at each solve, 0 to keep the current setting 
+        struct blockmatrix m_vMatrix[NUM_MATRICES]; ///< block matrices 
+        std::vector<std::size_t> m_vCapacity[NUM_MATRICES]; ///< number of doubles allocated for each block of each matrix 
+        std::vector<double> m_vNKVector[NUM_NK_VECTORS]; ///< vectors of max(n, k)+1 
+        std::vector<double> m_vKVector[NUM_K_VECTORS]; ///< vectors of k+1 
+        std::vector<double> m_vO; ///< matrix O 
+        int m_ldam; ///< leading dimension of O 
+        std::vector<struct sparseblock*> m_vByBlocks; ///< first sparse block of each block 
+};
+
 /// @brief API to call Csdp solver.  
 /// 
 /// This is a dummy template, 
@@ -54,6 +283,7 @@ namespace solvers
 /// @param pdobj as dual objective 
 /// @param params pass customized parameters to control the solver 
 /// @param printlevel verbose level in printing 
+/// @param workspace working storage kept across solves 
 /// @return the return code from sdp
 template <typename T>
 int easy_sdp_ext(
@@ -71,7 +301,8 @@ int easy_sdp_ext(
         double *pdobj, 
         // newly added parameters 
         struct paramstruc const& params, 
-        int const& printlevel
+        int const& printlevel, 
+        CsdpWorkspace& workspace
         )
 {
   int ret;
@@ -123,200 +354,42 @@ int easy_sdp_ext(
    //initparams(&params,&printlevel); // commence out because we pass it as a parameter
 
   /*
-   *  Allocate working storage
+   *  Take working storage from the workspace, 
+   *  which only allocates what the previous problems did not. 
    */
 
-  alloc_mat(C,&work1);
-  alloc_mat(C,&work2);
-  alloc_mat(C,&work3);
-  alloc_mat_packed(C,&bestx);
-  alloc_mat_packed(C,&bestz);
-  alloc_mat_packed(C,&cholxinv);
-  alloc_mat_packed(C,&cholzinv);
-
-  besty=(double *)malloc(sizeof(double)*(k+1));
-   if (besty == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   if (n > k)
-     {
-       workvec1=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       workvec1=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (workvec1 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   if (n > k)
-     {
-       workvec2=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       workvec2=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (workvec2 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   if (n > k)
-     {
-       workvec3=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       workvec3=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (workvec3 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   if (n > k)
-     {
-       workvec4=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       workvec4=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (workvec4 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   if (n > k)
-     {
-       workvec5=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       workvec5=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (workvec5 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   if (n > k)
-     {
-       workvec6=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       workvec6=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (workvec6 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   if (n > k)
-     {
-       workvec7=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       workvec7=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (workvec7 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   if (n > k)
-     {
-       workvec8=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       workvec8=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (workvec8 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-
-   if (n > k)
-     {
-       diagO=(double *)malloc(sizeof(double)*(n+1));
-     }
-   else
-     {
-       diagO=(double *)malloc(sizeof(double)*(k+1));
-     };
-   if (diagO == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-
-
-   rhs=(double*)malloc(sizeof(double)*(k+1));
-   if (rhs == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   dy=(double*)malloc(sizeof(double)*(k+1));
-   if (dy == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   dy1=(double*)malloc(sizeof(double)*(k+1));
-   if (dy1 == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   Fp=(double*)malloc(sizeof(double)*(k+1));
-   if (Fp == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   /*
-    *  Work out the leading dimension for the array.  Note that we may not
-    *  want to use k itself, for cache issues.
-    */
-   if ((k % 2) == 0)
-     ldam=k+1;
-   else
-     ldam=k;
-
-   O=(double*)malloc(sizeof(double)*ldam*ldam);
-   if (O == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
-
-   alloc_mat(C,&Zi);
-   alloc_mat(C,&dZ);
-   alloc_mat(C,&dX);
+  workspace.reserve(n,k,C);
+  if (workspace.numThreads() > 0)
+    setCsdpNumThreads(workspace.numThreads());
+  work1=workspace.matrix(CsdpWorkspace::WORK1);
+  work2=workspace.matrix(CsdpWorkspace::WORK2);
+  work3=workspace.matrix(CsdpWorkspace::WORK3);
+  bestx=workspace.matrix(CsdpWorkspace::BESTX);
+  bestz=workspace.matrix(CsdpWorkspace::BESTZ);
+  cholxinv=workspace.matrix(CsdpWorkspace::CHOLXINV);
+  cholzinv=workspace.matrix(CsdpWorkspace::CHOLZINV);
+  Zi=workspace.matrix(CsdpWorkspace::ZI);
+  dZ=workspace.matrix(CsdpWorkspace::DZ);
+  dX=workspace.matrix(CsdpWorkspace::DX);
+
+  besty=workspace.kVector(CsdpWorkspace::BESTY);
+  rhs=workspace.kVector(CsdpWorkspace::RHS);
+  dy=workspace.kVector(CsdpWorkspace::DY);
+  dy1=workspace.kVector(CsdpWorkspace::DY1);
+  Fp=workspace.kVector(CsdpWorkspace::FP);
+
+  workvec1=workspace.nkVector(CsdpWorkspace::WORKVEC1);
+  workvec2=workspace.nkVector(CsdpWorkspace::WORKVEC2);
+  workvec3=workspace.nkVector(CsdpWorkspace::WORKVEC3);
+  workvec4=workspace.nkVector(CsdpWorkspace::WORKVEC4);
+  workvec5=workspace.nkVector(CsdpWorkspace::WORKVEC5);
+  workvec6=workspace.nkVector(CsdpWorkspace::WORKVEC6);
+  workvec7=workspace.nkVector(CsdpWorkspace::WORKVEC7);
+  workvec8=workspace.nkVector(CsdpWorkspace::WORKVEC8);
+  diagO=workspace.nkVector(CsdpWorkspace::DIAGO);
+
+  ldam=workspace.ldam();
+  O=workspace.O();
 
    /*
     *  Fill in lots of details in the constraints data structure that haven't
@@ -424,15 +497,10 @@ int easy_sdp_ext(
      };
    
    /*
-    * Allocate space for byblocks pointers.
+    * Space for byblocks pointers is in the workspace.
     */
 
-   byblocks=(struct sparseblock **)malloc((C.nblocks+1)*sizeof(struct sparseblock *));
-   if (byblocks == NULL)
-     {
-       printf("Storage Allocation Failed!\n");
-       exit(10);
-     };
+   byblocks=workspace.byblocks();
 
    for (i=1; i<=C.nblocks; i++)
      byblocks[i]=NULL;
@@ -549,38 +617,9 @@ int easy_sdp_ext(
      };
 
    /*
-    *  Now, free up all of the storage.
+    *  Working storage is kept in the workspace for later solves.
     */
 
-   free_mat(work1);
-   free_mat(work2);
-   free_mat(work3);
-   free_mat_packed(bestx);
-   free_mat_packed(bestz);
-   free_mat_packed(cholxinv);
-   free_mat_packed(cholzinv);
-
-   free_mat(Zi);
-   free_mat(dZ);
-   free_mat(dX);
-
-   free(besty);
-   free(workvec1);
-   free(workvec2);
-   free(workvec3);
-   free(workvec4);
-   free(workvec5);
-   free(workvec6);
-   free(workvec7);
-   free(workvec8);
-   free(rhs);
-   free(dy);
-   free(dy1);
-   free(Fp);
-   free(O);
-   free(diagO);
-   free(byblocks);
- 
    /*
     * Free up the fill data structure.
     */
@@ -605,6 +644,17 @@ int easy_sdp_ext(
 
 }
 
+/// @brief API to call Csdp solver with the workspace of the calling thread, 
+/// see @ref limbo::solvers::easy_sdp_ext with a workspace for parameters 
+/// @return the return code from sdp
+template <typename T>
+int easy_sdp_ext(int n, int k, struct blockmatrix C, double *a, struct constraintmatrix *constraints, double constant_offset, 
+        struct blockmatrix *pX, double **py, struct blockmatrix *pZ, double *ppobj, double *pdobj, 
+        struct paramstruc const& params, int const& printlevel)
+{
+    return easy_sdp_ext<T>(n, k, C, a, constraints, constant_offset, pX, py, pZ, ppobj, pdobj, params, printlevel, CsdpWorkspace::threadLocal()); 
+}
+
 }} // namespace limbo // namespace solvers
 
 #endif
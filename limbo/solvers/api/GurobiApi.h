@@ -12,10 +12,12 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <pthread.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/assert.hpp> 
 #include <limbo/solvers/Solvers.h>
+#include <limbo/solvers/SolverPool.h>
 // make sure gurobi is configured properly 
 extern "C" 
 {
@@ -29,13 +31,16 @@ namespace limbo
 namespace solvers 
 {
 
-/// @brief Base class for custom Gurobi parameters 
-class GurobiParameters
+/// @brief Base class for custom Gurobi parameters. 
+/// The limits of @ref limbo::solvers::SolveControl map onto parameters of the environment, 
+/// and the incumbent callback is called at GRB_CB_MIPSOL by @ref limbo::solvers::GurobiLinearApi. 
+class GurobiParameters : public SolveControl
 {
     public:
         /// @brief constructor 
         GurobiParameters() 
-            : m_outputFlag(0)
+            : SolveControl()
+            , m_outputFlag(0)
             , m_numThreads(std::numeric_limits<int>::max())
         {
         }
@@ -49,6 +54,14 @@ class GurobiParameters
             GRBsetintparam(env, GRB_INT_PAR_OUTPUTFLAG, m_outputFlag); 
             if (m_numThreads > 0 && m_numThreads != std::numeric_limits<int>::max())
                 GRBsetintparam(env, GRB_INT_PAR_THREADS, m_numThreads);
+            if (m_timeLimit > 0)
+                GRBsetdblparam(env, GRB_DBL_PAR_TIMELIMIT, m_timeLimit);
+            if (m_mipGap >= 0)
+                GRBsetdblparam(env, GRB_DBL_PAR_MIPGAP, m_mipGap);
+            if (m_nodeLimit > 0)
+                GRBsetdblparam(env, GRB_DBL_PAR_NODELIMIT, m_nodeLimit);
+            if (m_solutionLimit > 0)
+                GRBsetintparam(env, GRB_INT_PAR_SOLUTIONLIMIT, (int)std::min(m_solutionLimit, (long)std::numeric_limits<int>::max()));
         }
         /// @brief customize model 
         /// 
@@ -69,6 +82,72 @@ class GurobiParameters
         int m_numThreads; ///< number of threads 
 };
 
+/// @brief Base class for lazy constraints of @ref limbo::solvers::GurobiLinearApi. 
+/// Lazy constraints are left out of the model and requested by Gurobi at each new integer solution, 
+/// so a model with many constraints of which few are binding is solved without loading all of them. 
+/// The constraints returned for an infeasible solution must cut it off. 
+/// @tparam T coefficient type 
+/// @tparam V variable type 
+template <typename T, typename V>
+class GurobiLazyConstraints
+{
+    public:
+        /// @nowarn
+        typedef LinearModel<T, V> model_type; 
+        typedef typename model_type::constraint_type constraint_type; 
+        /// @endnowarn
+
+        /// @brief destructor 
+        virtual ~GurobiLazyConstraints() {}
+        /// @brief find constraints violated by an integer solution 
+        /// @param vSolution value of each variable in the order of the model 
+        /// @param vConstraint constraints to add, empty when called 
+        virtual void operator()(std::vector<double> const& vSolution, std::vector<constraint_type>& vConstraint) = 0; 
+};
+
+/// @brief Gurobi environment kept for each thread. 
+/// Loading an environment checks the licence and may take milliseconds, 
+/// which dominates the solving time of small models, e.g., in graph coloring of small components. 
+/// The environment is freed when the thread exits. 
+class GurobiThreadEnv 
+{
+    public:
+        /// @brief get the environment of the calling thread, created at the first call 
+        /// @return environment 
+        static GRBenv* get()
+        {
+            static pthread_once_t once = PTHREAD_ONCE_INIT; 
+            pthread_once(&once, GurobiThreadEnv::createKey); 
+            GRBenv* env = static_cast<GRBenv*>(pthread_getspecific(key())); 
+            if (env == NULL)
+            {
+                int error = GRBloadenv(&env, NULL);
+                if (error) 
+                    limboAssertMsg(0, "%s", GRBgeterrormsg(env)); 
+                pthread_setspecific(key(), env); 
+            }
+            return env; 
+        }
+    protected:
+        /// @return key of thread-specific environments 
+        static pthread_key_t& key()
+        {
+            static pthread_key_t k; 
+            return k; 
+        }
+        /// @brief create the key with the destructor of environments 
+        static void createKey()
+        {
+            pthread_key_create(&key(), GurobiThreadEnv::destroy); 
+        }
+        /// @brief free an environment when its thread exits 
+        /// @param env environment 
+        static void destroy(void* env)
+        {
+            GRBfreeenv(static_cast<GRBenv*>(env)); 
+        }
+};
+
 /// @brief Round floating point solutions to integer if the variable type is integer. 
 /// If not rounded, there might be precision issues. 
 template <typename T, std::size_t = std::numeric_limits<T>::is_integer>
@@ -107,13 +186,20 @@ class GurobiLinearApi
         typedef typename model_type::term_type term_type; 
         typedef typename model_type::property_type property_type;
         typedef GurobiParameters parameter_type; 
+        typedef GurobiLazyConstraints<T, V> lazy_constraints_type; 
         /// @endnowarn
         
         /// @brief constructor 
         /// @param model pointer to the model of problem 
-        GurobiLinearApi(model_type* model)
+        /// @param env environment to share, e.g., from @ref limbo::solvers::GurobiThreadEnv; 
+        /// a new one is loaded for each solve if NULL 
+        GurobiLinearApi(model_type* model, GRBenv* env = NULL)
             : m_model(model)
               , m_grbModel(NULL)
+              , m_env(env)
+              , m_lazy(NULL)
+              , m_numLazyConstraints(0)
+              , m_incumbent(NULL)
         {
         }
         /// @brief destructor 
@@ -121,9 +207,15 @@ class GurobiLinearApi
         {
         }
         
+        /// @brief set lazy constraints separated at integer solutions, in terms of the variables of the model 
+        /// @param lazy callback, not owned, NULL to disable 
+        void setLazyConstraints(lazy_constraints_type* lazy) {m_lazy = lazy;}
+        /// @return number of lazy constraints added in the last solve 
+        std::size_t numLazyConstraints() const {return m_numLazyConstraints;}
+
         /// @brief API to run the algorithm 
         /// @param param set additional parameters, use default if NULL 
-        SolverProperty operator()(parameter_type* param = NULL)
+        SolverProperty operator()(parameter_type const* param = NULL)
         {
             bool defaultParam = false; 
             if (param == NULL)
@@ -133,66 +225,70 @@ class GurobiLinearApi
             }
 
             // ILP environment
-            GRBenv* env = NULL; 
+            GRBenv* env = m_env; 
             m_grbModel = NULL; 
+            int error = 0; 
             // Create environment
-            int error = GRBloadenv(&env, NULL);
-            errorHandler(env, error);
-            param->operator()(env); 
-            // Create an empty model 
-            error = GRBnewmodel(env, &m_grbModel, "GurobiLinearApi", m_model->numVariables(), NULL, NULL, NULL, NULL, NULL);
+            if (m_env == NULL)
+            {
+                error = GRBloadenv(&env, NULL);
+                errorHandler(env, error);
+                param->operator()(env); 
+            }
+            // build arrays of the model once and load them in bulk 
+            LinearModelArrays<T, V> arrays; 
+            arrays.set(*m_model); 
+            int numVariables = m_model->numVariables(); 
+            int numConstraints = m_model->constraints().size(); 
+            // Create a model with variables 
+            error = GRBnewmodel(env, &m_grbModel, "GurobiLinearApi", numVariables, 
+                    (numVariables)? &arrays.vObjective[0] : NULL, 
+                    (numVariables)? &arrays.vLowerBound[0] : NULL, 
+                    (numVariables)? &arrays.vUpperBound[0] : NULL, 
+                    (numVariables)? &arrays.vType[0] : NULL, 
+                    (numVariables)? &arrays.vVariableNamePtr[0] : NULL);
             errorHandler(env, error);
-
-            // create variables 
+            // a shared environment is not changed, the model has its own copy of parameters 
+            if (m_env)
+            {
+                env = GRBgetenv(m_grbModel); 
+                param->operator()(env); 
+            }
             error = GRBupdatemodel(m_grbModel);
             errorHandler(env, error);
-            for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
+            if (numVariables)
             {
-                variable_type var (i);
-                error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_LB, var.id(), m_model->variableLowerBound(var));
-                errorHandler(env, error);
-                error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_UB, var.id(), m_model->variableUpperBound(var));
-                errorHandler(env, error);
-                error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_START, var.id(), m_model->variableSolution(var));
-                errorHandler(env, error);
-                error = GRBsetcharattrelement(m_grbModel, GRB_CHAR_ATTR_VTYPE, var.id(), m_model->variableNumericType(var) == CONTINUOUS? GRB_CONTINUOUS : GRB_INTEGER);
-                errorHandler(env, error);
-                limboAssertMsg(!(std::numeric_limits<V>::is_integer && m_model->variableNumericType(var) == CONTINUOUS), 
-                    "LinearModel<T, V> is declared as V = integer type, but variable %s is CONTINUOUS", m_model->variableName(var).c_str());
-                error = GRBsetstrattrelement(m_grbModel, GRB_STR_ATTR_VARNAME, var.id(), m_model->variableName(var).c_str());
+                error = GRBsetdblattrarray(m_grbModel, GRB_DBL_ATTR_START, 0, numVariables, &arrays.vStart[0]);
                 errorHandler(env, error);
             }
 
             // create constraints 
-            std::vector<int> vIdx; 
-            std::vector<double> vValue; 
-            for (unsigned int i = 0, ie = m_model->constraints().size(); i < ie; ++i)
+            if (numConstraints)
             {
-                constraint_type const& constr = m_model->constraints().at(i);
-
-                vIdx.clear(); 
-                vValue.clear();
-                for (typename std::vector<term_type>::const_iterator it = constr.expression().terms().begin(), ite = constr.expression().terms().end(); it != ite; ++it)
-                {
-                    vIdx.push_back(it->variable().id()); 
-                    vValue.push_back(it->coefficient());
-                }
-
-                error = GRBaddconstr(m_grbModel, constr.expression().terms().size(), &vIdx[0], &vValue[0], constr.sense(), constr.rightHandSide(), m_model->constraintName(constr).c_str());
+                error = GRBaddconstrs(m_grbModel, numConstraints, arrays.constrMatrix.numElements, 
+                        arrays.constrMatrix.vRowBeginIndex, arrays.constrMatrix.vColumn, arrays.constrMatrix.vElement, 
+                        &arrays.vSense[0], &arrays.vRhs[0], &arrays.vConstraintNamePtr[0]);
                 errorHandler(env, error);
             }
 
-            // create objective 
-            for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
-            {
-                error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_OBJ, it->variable().id(), it->coefficient());
-                errorHandler(env, error);
-            }
             error = GRBsetintattr(m_grbModel, GRB_INT_ATTR_MODELSENSE, m_model->optimizeType() == MIN? GRB_MINIMIZE : GRB_MAXIMIZE);
             errorHandler(env, error);
 
             // call parameter setting before optimization 
             param->operator()(m_grbModel); 
+            m_numLazyConstraints = 0; 
+            m_incumbent = param->incumbentCallback(); 
+            if (m_lazy)
+            {
+                // the parameter is read from the environment of the model 
+                error = GRBsetintparam(GRBgetenv(m_grbModel), GRB_INT_PAR_LAZYCONSTRAINTS, 1); 
+                errorHandler(env, error);
+            }
+            if (m_lazy || m_incumbent)
+            {
+                error = GRBsetcallbackfunc(m_grbModel, GurobiLinearApi::callback, this); 
+                errorHandler(env, error);
+            }
             error = GRBupdatemodel(m_grbModel);
             errorHandler(env, error);
 
@@ -216,28 +312,43 @@ class GurobiLinearApi
             GRBwrite(m_grbModel, "problem.sol");
 #endif 
 
+            // at a limit, the start is kept if no solution is found 
+            bool limited = (status == GRB_TIME_LIMIT || status == GRB_NODE_LIMIT || status == GRB_SOLUTION_LIMIT || status == GRB_INTERRUPTED); 
+            int solCount = 0; 
+            if (limited)
+            {
+                error = GRBgetintattr(m_grbModel, GRB_INT_ATTR_SOLCOUNT, &solCount);
+                errorHandler(env, error);
+            }
+
             // round if the variable type is integer 
             SmartRound<V> sround; 
-            for (unsigned int i = 0; i < m_model->numVariables(); ++i)
+            if (numVariables && (!limited || solCount > 0))
             {
-                variable_type var = m_model->variable(i); 
-                double value = 0; 
-                error = GRBgetdblattrelement(m_grbModel, GRB_DBL_ATTR_X, var.id(), &value);
+                // reuse the array of initial solutions 
+                error = GRBgetdblattrarray(m_grbModel, GRB_DBL_ATTR_X, 0, numVariables, &arrays.vStart[0]);
                 errorHandler(env, error);
-                m_model->setVariableSolution(m_model->variable(i), sround(value));
             }
+            for (int i = 0; i < numVariables; ++i)
+                m_model->setVariableSolution(m_model->variable(i), sround(arrays.vStart[i]));
 
             if (defaultParam)
                 delete param; 
             // Free model 
             GRBfreemodel(m_grbModel);
             // Free environment 
-            GRBfreeenv(env);
+            if (m_env == NULL)
+                GRBfreeenv(env);
 
             switch (status)
             {
                 case GRB_OPTIMAL:
                     return OPTIMAL;
+                case GRB_TIME_LIMIT:
+                case GRB_NODE_LIMIT:
+                case GRB_SOLUTION_LIMIT:
+                case GRB_INTERRUPTED:
+                    return SUBOPTIMAL;
                 case GRB_INFEASIBLE:
                     return INFEASIBLE;
                 case GRB_INF_OR_UNBD:
@@ -259,11 +370,70 @@ class GurobiLinearApi
         /// @brief assignment, forbidden 
         /// @param rhs right hand side 
         GurobiLinearApi& operator=(GurobiLinearApi const& rhs);
+        /// @brief callback of Gurobi at each integer solution, which adds lazy constraints, 
+        /// or reports the solution as an incumbent if no lazy constraint cuts it off 
+        /// @param model Gurobi model 
+        /// @param cbdata data to query in the callback 
+        /// @param where where the callback is called 
+        /// @param usrdata pointer to this object 
+        /// @return 0 if succeed, otherwise an error code of Gurobi 
+        static int __stdcall callback(GRBmodel* model, void* cbdata, int where, void* usrdata); 
 
         model_type* m_model; ///< model for the problem 
         GRBmodel* m_grbModel; ///< model for Gurobi 
+        GRBenv* m_env; ///< shared environment, NULL if loaded for each solve 
+        lazy_constraints_type* m_lazy; ///< lazy constraints, NULL if all constraints are in the model 
+        std::size_t m_numLazyConstraints; ///< number of lazy constraints added 
+        IncumbentCallback* m_incumbent; ///< callback at each new incumbent of the current solve, NULL if disabled 
 };
 
+template <typename T, typename V>
+int __stdcall GurobiLinearApi<T, V>::callback(GRBmodel* model, void* cbdata, int where, void* usrdata)
+{
+    if (where != GRB_CB_MIPSOL)
+        return 0; 
+    GurobiLinearApi* api = static_cast<GurobiLinearApi*>(usrdata); 
+    std::vector<double> vSolution (api->m_model->numVariables()); 
+    int error = GRBcbget(cbdata, where, GRB_CB_MIPSOL_SOL, (vSolution.empty())? NULL : &vSolution[0]); 
+    if (error)
+        return error; 
+    std::vector<constraint_type> vConstraint; 
+    if (api->m_lazy)
+        (*api->m_lazy)(vSolution, vConstraint); 
+    if (vConstraint.empty())
+    {
+        if (api->m_incumbent)
+        {
+            double objective = 0; 
+            error = GRBcbget(cbdata, where, GRB_CB_MIPSOL_OBJ, &objective); 
+            if (error)
+                return error; 
+            if (!(*api->m_incumbent)(vSolution, objective))
+                GRBterminate(model); 
+        }
+        return 0; 
+    }
+    std::vector<int> vIndex; 
+    std::vector<double> vValue; 
+    for (typename std::vector<constraint_type>::iterator it = vConstraint.begin(), ite = vConstraint.end(); it != ite; ++it)
+    {
+        it->simplify(); 
+        vIndex.clear(); 
+        vValue.clear(); 
+        for (typename std::vector<term_type>::const_iterator itt = it->expression().terms().begin(), itte = it->expression().terms().end(); itt != itte; ++itt)
+        {
+            vIndex.push_back(itt->variable().id()); 
+            vValue.push_back(itt->coefficient()); 
+        }
+        // senses of constraints are the same characters as in Gurobi 
+        error = GRBcblazy(cbdata, vIndex.size(), (vIndex.empty())? NULL : &vIndex[0], (vValue.empty())? NULL : &vValue[0], it->sense(), it->rightHandSide()); 
+        if (error)
+            return error; 
+    }
+    api->m_numLazyConstraints += vConstraint.size(); 
+    return 0; 
+}
+
 template <typename T, typename V>
 void GurobiLinearApi<T, V>::errorHandler(GRBenv* env, int error) const 
 {
@@ -272,6 +442,286 @@ void GurobiLinearApi<T, V>::errorHandler(GRBenv* env, int error) const
         limboAssertMsg(0, "%s", GRBgeterrormsg(env)); 
 }
 
+/// @brief Gurobi backend of @ref limbo::solvers::SolverPool. 
+/// Each environment is loaded once per worker with its number of threads, 
+/// and models are solved by @ref limbo::solvers::GurobiLinearApi on it. 
+/// @tparam T coefficient type 
+/// @tparam V variable type 
+template <typename T, typename V>
+struct GurobiPoolBackend 
+{
+    /// @nowarn
+    typedef LinearModel<T, V> model_type; 
+    typedef GurobiParameters parameter_type; 
+    typedef GRBenv environment_type; 
+    /// @endnowarn
+
+    /// @brief load an environment 
+    /// @param numThreads number of threads of each solve 
+    /// @return environment 
+    static GRBenv* createEnvironment(int numThreads)
+    {
+        GRBenv* env = NULL; 
+        int error = GRBloadenv(&env, NULL);
+        if (error) 
+            limboAssertMsg(0, "%s", GRBgeterrormsg(env)); 
+        GRBsetintparam(env, GRB_INT_PAR_OUTPUTFLAG, 0); 
+        GRBsetintparam(env, GRB_INT_PAR_THREADS, numThreads); 
+        return env; 
+    }
+    /// @brief free an environment 
+    /// @param env environment 
+    static void destroyEnvironment(GRBenv* env)
+    {
+        GRBfreeenv(env); 
+    }
+    /// @brief solve a model; the number of threads of the environment is kept unless set in \a param 
+    /// @param env environment of the calling worker 
+    /// @param model model to solve 
+    /// @param param parameters, use default if NULL 
+    /// @return status of the solve 
+    static SolverProperty solve(GRBenv* env, model_type* model, parameter_type const* param)
+    {
+        GurobiLinearApi<T, V> solver (model, env); 
+        return solver(param); 
+    }
+};
+
+/// @brief Gurobi model kept alive across solves of a @ref limbo::solvers::LinearModel. 
+/// 
+/// Iterative flows re-solve nearly identical models many times. 
+/// The session loads the model once, applies each modification to both the @ref limbo::solvers::LinearModel and the Gurobi model, 
+/// and re-solves from the previous basis with dual simplex, or from the previous solution as a MIP start. 
+/// The @ref limbo::solvers::LinearModel must only be modified through the session while it is alive. 
+/// @tparam T coefficient type 
+/// @tparam V variable type 
+template <typename T, typename V>
+class GurobiLinearSession 
+{
+    public:
+        /// @brief linear model type for the problem 
+        typedef LinearModel<T, V> model_type; 
+        /// @nowarn
+        typedef typename model_type::coefficient_value_type coefficient_value_type; 
+        typedef typename model_type::variable_value_type variable_value_type; 
+        typedef typename model_type::variable_type variable_type;
+        typedef typename model_type::constraint_type constraint_type; 
+        typedef typename model_type::term_type term_type; 
+        typedef GurobiParameters parameter_type; 
+        /// @endnowarn
+
+        /// @brief constructor, load the model 
+        /// @param model pointer to the model of problem 
+        /// @param env environment to share, e.g., from @ref limbo::solvers::GurobiThreadEnv; a new one is loaded if NULL 
+        /// @param param set additional parameters, use default if NULL 
+        GurobiLinearSession(model_type* model, GRBenv* env = NULL, parameter_type const* param = NULL)
+            : m_model(model)
+            , m_grbModel(NULL)
+            , m_env(env)
+            , m_ownEnv(env == NULL)
+        {
+            GurobiParameters defaultParam; 
+            if (param == NULL)
+                param = &defaultParam; 
+            int error = 0; 
+            if (m_ownEnv)
+            {
+                error = GRBloadenv(&m_env, NULL);
+                errorHandler(error);
+            }
+
+            LinearModelArrays<T, V> arrays; 
+            arrays.set(*m_model); 
+            int numVariables = m_model->numVariables(); 
+            int numConstraints = m_model->constraints().size(); 
+            error = GRBnewmodel(m_env, &m_grbModel, "GurobiLinearSession", numVariables, 
+                    (numVariables)? &arrays.vObjective[0] : NULL, 
+                    (numVariables)? &arrays.vLowerBound[0] : NULL, 
+                    (numVariables)? &arrays.vUpperBound[0] : NULL, 
+                    (numVariables)? &arrays.vType[0] : NULL, 
+                    (numVariables)? &arrays.vVariableNamePtr[0] : NULL);
+            errorHandler(error);
+            // parameters go to the copy in the model, dual simplex re-solves from the previous basis 
+            GRBenv* modelEnv = GRBgetenv(m_grbModel); 
+            GRBsetintparam(modelEnv, GRB_INT_PAR_METHOD, GRB_METHOD_DUAL); 
+            param->operator()(modelEnv); 
+            if (numConstraints)
+            {
+                error = GRBaddconstrs(m_grbModel, numConstraints, arrays.constrMatrix.numElements, 
+                        arrays.constrMatrix.vRowBeginIndex, arrays.constrMatrix.vColumn, arrays.constrMatrix.vElement, 
+                        &arrays.vSense[0], &arrays.vRhs[0], &arrays.vConstraintNamePtr[0]);
+                errorHandler(error);
+            }
+            error = GRBsetintattr(m_grbModel, GRB_INT_ATTR_MODELSENSE, m_model->optimizeType() == MIN? GRB_MINIMIZE : GRB_MAXIMIZE);
+            errorHandler(error);
+            param->operator()(m_grbModel); 
+            error = GRBupdatemodel(m_grbModel);
+            errorHandler(error);
+        }
+        /// @brief destructor, free the Gurobi model 
+        ~GurobiLinearSession()
+        {
+            GRBfreemodel(m_grbModel);
+            if (m_ownEnv)
+                GRBfreeenv(m_env);
+        }
+
+        /// @brief solve or re-solve the model and write solutions to the @ref limbo::solvers::LinearModel 
+        /// @return solving status 
+        SolverProperty operator()()
+        {
+            int numVariables = m_model->numVariables(); 
+            int error = 0; 
+            // the last solution is a MIP start, it is ignored for LP 
+            std::vector<double> vSol (m_model->variableSolutions().begin(), m_model->variableSolutions().end()); 
+            if (numVariables)
+            {
+                error = GRBsetdblattrarray(m_grbModel, GRB_DBL_ATTR_START, 0, numVariables, &vSol[0]);
+                errorHandler(error);
+            }
+            error = GRBoptimize(m_grbModel);
+            errorHandler(error);
+            int status = 0; 
+            error = GRBgetintattr(m_grbModel, GRB_INT_ATTR_STATUS, &status);
+            errorHandler(error);
+#ifdef DEBUG_GUROBIAPI
+            GRBwrite(m_grbModel, "problem.lp");
+#endif 
+
+            SolverProperty result = OPTIMAL; 
+            int solCount = 1; 
+            switch (status)
+            {
+                case GRB_OPTIMAL:
+                    break; 
+                case GRB_TIME_LIMIT:
+                case GRB_NODE_LIMIT:
+                case GRB_SOLUTION_LIMIT:
+                case GRB_INTERRUPTED:
+                    // at a limit, the last solution is kept if no solution is found 
+                    result = SUBOPTIMAL; 
+                    error = GRBgetintattr(m_grbModel, GRB_INT_ATTR_SOLCOUNT, &solCount);
+                    errorHandler(error);
+                    break; 
+                case GRB_INFEASIBLE:
+                    return INFEASIBLE;
+                case GRB_INF_OR_UNBD:
+                case GRB_UNBOUNDED:
+                    return UNBOUNDED;
+                default:
+                    limboAssertMsg(0, "unknown status %d", status);
+            }
+            if (numVariables && solCount > 0)
+            {
+                error = GRBgetdblattrarray(m_grbModel, GRB_DBL_ATTR_X, 0, numVariables, &vSol[0]);
+                errorHandler(error);
+            }
+            SmartRound<V> sround; 
+            for (int i = 0; i < numVariables; ++i)
+                m_model->setVariableSolution(m_model->variable(i), sround(vSol[i]));
+            return result; 
+        }
+
+        /// @brief add a constraint, a constraint of one term updates bounds as @ref limbo::solvers::LinearModel::addConstraint 
+        /// @param constr constraint 
+        /// @param name constraint name 
+        /// @return true if added 
+        bool addConstraint(constraint_type const& constr, std::string const& name = "")
+        {
+            unsigned int numConstraints = m_model->constraints().size(); 
+            if (!m_model->addConstraint(constr, name))
+                return false; 
+            int error = 0; 
+            if (m_model->constraints().size() == numConstraints) // bound constraint 
+            {
+                variable_type var = constr.expression().terms().front().variable(); 
+                error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_LB, var.id(), m_model->variableLowerBound(var));
+                errorHandler(error);
+                error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_UB, var.id(), m_model->variableUpperBound(var));
+                errorHandler(error);
+            }
+            else 
+            {
+                constraint_type const& added = m_model->constraints().back(); 
+                std::vector<int> vIdx; 
+                std::vector<double> vValue; 
+                vIdx.reserve(added.expression().terms().size()); 
+                vValue.reserve(added.expression().terms().size()); 
+                for (typename std::vector<term_type>::const_iterator it = added.expression().terms().begin(), ite = added.expression().terms().end(); it != ite; ++it)
+                {
+                    vIdx.push_back(it->variable().id()); 
+                    vValue.push_back(it->coefficient());
+                }
+                error = GRBaddconstr(m_grbModel, vIdx.size(), &vIdx[0], &vValue[0], added.sense(), added.rightHandSide(), name.c_str());
+                errorHandler(error);
+            }
+            error = GRBupdatemodel(m_grbModel);
+            errorHandler(error);
+            return true; 
+        }
+        /// @brief remove constraints, the remaining ones are renumbered as @ref limbo::solvers::LinearModel::removeConstraints 
+        /// @param vConstraintId indices of constraints 
+        void removeConstraints(std::vector<unsigned int> const& vConstraintId)
+        {
+            if (vConstraintId.empty())
+                return; 
+            m_model->removeConstraints(vConstraintId); 
+            std::vector<int> vIdx (vConstraintId.begin(), vConstraintId.end()); 
+            int error = GRBdelconstrs(m_grbModel, vIdx.size(), &vIdx[0]);
+            errorHandler(error);
+            error = GRBupdatemodel(m_grbModel);
+            errorHandler(error);
+        }
+        /// @brief change bounds of a variable 
+        /// @param var variable 
+        /// @param lb lower bound 
+        /// @param ub upper bound 
+        void setVariableBounds(variable_type const& var, variable_value_type lb, variable_value_type ub)
+        {
+            m_model->setVariableLowerBound(var, lb); 
+            m_model->setVariableUpperBound(var, ub); 
+            int error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_LB, var.id(), lb);
+            errorHandler(error);
+            error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_UB, var.id(), ub);
+            errorHandler(error);
+            error = GRBupdatemodel(m_grbModel);
+            errorHandler(error);
+        }
+        /// @brief change the coefficient of a variable in the objective 
+        /// @param var variable 
+        /// @param coef coefficient 
+        void setObjectiveCoefficient(variable_type const& var, coefficient_value_type coef)
+        {
+            m_model->setObjectiveCoefficient(var, coef); 
+            int error = GRBsetdblattrelement(m_grbModel, GRB_DBL_ATTR_OBJ, var.id(), coef);
+            errorHandler(error);
+            error = GRBupdatemodel(m_grbModel);
+            errorHandler(error);
+        }
+        /// @return Gurobi model 
+        GRBmodel* grbModel() const {return m_grbModel;}
+
+    protected:
+        /// @brief copy constructor, forbidden 
+        /// @param rhs right hand side 
+        GurobiLinearSession(GurobiLinearSession const& rhs);
+        /// @brief assignment, forbidden 
+        /// @param rhs right hand side 
+        GurobiLinearSession& operator=(GurobiLinearSession const& rhs);
+        /// @brief error handler 
+        /// @param error error type 
+        void errorHandler(int error) const 
+        {
+            if (error) 
+                limboAssertMsg(0, "%s", GRBgeterrormsg(m_env)); 
+        }
+
+        model_type* m_model; ///< model for the problem 
+        GRBmodel* m_grbModel; ///< model for Gurobi, alive with the session 
+        GRBenv* m_env; ///< environment 
+        bool m_ownEnv; ///< whether the environment is loaded by the session 
+};
+
 #if GUROBIFILEAPI == 1
 #include "gurobi_c++.h"
 /// This api needs a file in LP format as input.
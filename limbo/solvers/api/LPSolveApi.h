@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <cmath>
 #include <limbo/solvers/Solvers.h>
 // make sure lpsolve is configured properly 
 extern "C" 
@@ -58,13 +59,16 @@ namespace limbo
 namespace solvers 
 {
 
-/// @brief Base class for custom LPSolve parameters 
-class LPSolveParameters
+/// @brief Base class for custom LPSolve parameters. 
+/// The time limit and the gap of @ref limbo::solvers::SolveControl map onto lpsolve options; 
+/// lpsolve has no node or solution limit, so @ref limbo::solvers::LPSolveLinearApi counts them in its callbacks with the incumbent callback. 
+class LPSolveParameters : public SolveControl
 {
     public:
         /// @brief constructor 
         LPSolveParameters() 
-            : m_verbose(SEVERE)
+            : SolveControl()
+            , m_verbose(SEVERE)
             , m_bbRule(NODE_PSEUDONONINTSELECT|NODE_RCOSTFIXING)
               // various options in presolve to tune 
               // I found PRESOLVE_COLDOMINATE may result in INFEASIBLE model, which may be a bug in lpsolve
@@ -85,6 +89,11 @@ class LPSolveParameters
             // various options in presolve to tune 
             set_bb_rule(lp, m_bbRule); 
             set_presolve(lp, m_presolve, get_presolveloops(lp)); 
+            // lpsolve takes whole seconds 
+            if (m_timeLimit > 0)
+                set_timeout(lp, (long)ceil(m_timeLimit)); 
+            if (m_mipGap >= 0)
+                set_mip_gap(lp, FALSE, m_mipGap); 
         }
 
         /// @brief set verbose level 
@@ -127,6 +136,9 @@ class LPSolveLinearApi
         LPSolveLinearApi(model_type* model)
             : m_model(model)
               , m_lpModel(NULL)
+              , m_control(NULL)
+              , m_numIncumbents(0)
+              , m_stop(false)
         {
         }
         /// @brief destructor 
@@ -145,91 +157,7 @@ class LPSolveLinearApi
                 defaultParam = true; 
             }
 
-            // column indices 
-            std::vector<int> vIdx; 
-            // coefficients  
-            std::vector<double> vValue; 
-            // buffer for name 
-            char buf[64]; 
-
-            m_lpModel = make_lp(m_model->constraints().size(), m_model->numVariables()); 
-
-            set_lp_name(m_lpModel, (char*)"LPSolveLinearApi");
-            // set verbose level 
-            set_verbose(m_lpModel, SEVERE);
-
-            // create variables 
-            for (unsigned int i = 0, ie = m_model->numVariables(); i < ie; ++i)
-            {
-                variable_type var (i);
-                limboAssertMsg(set_bounds(m_lpModel, i+1, m_model->variableLowerBound(var), m_model->variableUpperBound(var)), "failed to set bounds of variable for LP");
-                sprintf(buf, "%s", m_model->variableName(var).c_str());
-                limboAssertMsg(set_col_name(m_lpModel, i+1, buf), "failed to set name of variable %s", m_model->variableName(var).c_str());
-                switch (m_model->variableNumericType(var))
-                {
-                    case CONTINUOUS:
-                        break; 
-                    case BINARY: 
-                        limboAssertMsg(set_binary(m_lpModel, i+1, TRUE), "failed to set binary variable for LP"); 
-                        break;
-                    case INTEGER:
-                        limboAssertMsg(set_int(m_lpModel, i+1, TRUE), "failed to set integer variable for LP"); 
-                        break;
-                    default:
-                        limboAssertMsg(0, "unknown numeric type");
-                }
-            }
-
-            // create objective 
-            vIdx.clear(); 
-            vValue.clear();
-            for (typename std::vector<term_type>::const_iterator it = m_model->objective().terms().begin(), ite = m_model->objective().terms().end(); it != ite; ++it)
-            {
-                vIdx.push_back(it->variable().id()+1); // variable id starts from 1 for LPSolve
-                vValue.push_back(it->coefficient());
-            }
-            limboAssertMsg(set_obj_fnex(m_lpModel, vIdx.size(), &vValue[0], &vIdx[0]), "failed to set objective for LP"); 
-            if (m_model->optimizeType() == MIN)
-            {
-                set_minim(m_lpModel); 
-            }
-            else 
-            {
-                set_maxim(m_lpModel); 
-            }
-
-            // create constraints 
-            for (unsigned int i = 0, ie = m_model->constraints().size(); i < ie; ++i)
-            {
-                constraint_type const& constr = m_model->constraints().at(i);
-
-                vIdx.clear(); 
-                vValue.clear();
-                for (typename std::vector<term_type>::const_iterator it = constr.expression().terms().begin(), ite = constr.expression().terms().end(); it != ite; ++it)
-                {
-                    vIdx.push_back(it->variable().id()+1); // variable id starts from 1 for LPSolve
-                    vValue.push_back(it->coefficient());
-                }
-
-                limboAssertMsg(set_rowex(m_lpModel, i+1, vIdx.size(), &vValue[0], &vIdx[0]), "failed to set constraint for LP");
-                switch (constr.sense())
-                {
-                    case '>':
-                        limboAssertMsg(set_constr_type(m_lpModel, i+1, GE), "failed to set constraint type for LP");
-                        break;
-                    case '<':
-                        limboAssertMsg(set_constr_type(m_lpModel, i+1, LE), "failed to set constraint type for LP");
-                        break;
-                    case '=':
-                        limboAssertMsg(set_constr_type(m_lpModel, i+1, EQ), "failed to set constraint type for LP");
-                        break;
-                    default:
-                        limboAssertMsg(0, "unknown sense");
-                }
-                limboAssertMsg(set_rh(m_lpModel, i+1, constr.rightHandSide()), "failed to set constraint right-hand side for LP"); 
-                sprintf(buf, "%s", m_model->constraintName(constr).c_str());
-                limboAssertMsg(set_row_name(m_lpModel, i+1, buf), "failed to set constraint name %s for LP", m_model->constraintName(constr).c_str()); 
-            }
+            m_lpModel = createModel(*m_model, "LPSolveLinearApi"); 
 
             // solve LP 
 #ifdef DEBUG_LPSOLVEAPI
@@ -238,13 +166,24 @@ class LPSolveLinearApi
             set_scaling(m_lpModel, SCALE_RANGE); 
             // call parameter setting before optimization 
             param->operator()(m_lpModel); 
+            m_control = param; 
+            m_numIncumbents = 0; 
+            m_stop = false; 
+            if (param->nodeLimit() > 0 || param->solutionLimit() > 0 || param->incumbentCallback())
+            {
+                put_abortfunc(m_lpModel, LPSolveLinearApi::abortCallback, this); 
+                put_msgfunc(m_lpModel, LPSolveLinearApi::messageCallback, this, MSG_MILPBETTER); 
+            }
             int status = solve(m_lpModel); 
 
-            // apply solution 
-            for (unsigned int i = 0; i < m_model->numVariables(); ++i)
+            // apply solution, the start is kept if stopped before any solution 
+            if (status != USERABORT && status != TIMEOUT)
             {
-                REAL value = get_var_primalresult(m_lpModel, m_model->constraints().size()+1+i);
-                m_model->setVariableSolution(m_model->variable(i), value);
+                for (unsigned int i = 0; i < m_model->numVariables(); ++i)
+                {
+                    REAL value = get_var_primalresult(m_lpModel, m_model->constraints().size()+1+i);
+                    m_model->setVariableSolution(m_model->variable(i), value);
+                }
             }
 
 #ifdef DEBUG_LPSOLVEAPI
@@ -286,6 +225,84 @@ class LPSolveLinearApi
             //        limboAssertMsg(0, "unknown status %d", status);
             //}
         }
+        /// @brief create an lpsolve model from a @ref limbo::solvers::LinearModel
+        /// @param model the model 
+        /// @param name name of the lpsolve model 
+        /// @return lpsolve model, to be freed by delete_lp 
+        static lprec* createModel(model_type const& model, char const* name)
+        {
+            // build arrays of the model once, columns start from 1 for LPSolve 
+            LinearModelArrays<T, V, 1> arrays; 
+            arrays.set(model); 
+
+            // rows are added later in row entry mode, which is much faster than setting existing rows 
+            lprec* lp = make_lp(0, model.numVariables()); 
+            limboAssertMsg(lp, "failed to create LP");
+
+            set_lp_name(lp, const_cast<char*>(name));
+            // set verbose level 
+            set_verbose(lp, SEVERE);
+
+            // create variables 
+            for (unsigned int i = 0, ie = model.numVariables(); i < ie; ++i)
+            {
+                limboAssertMsg(set_bounds(lp, i+1, arrays.vLowerBound[i], arrays.vUpperBound[i]), "failed to set bounds of variable for LP");
+                limboAssertMsg(set_col_name(lp, i+1, arrays.vVariableNamePtr[i]), "failed to set name of variable %s", arrays.vVariableNamePtr[i]);
+                switch (model.variableProperties()[i].numericType())
+                {
+                    case CONTINUOUS:
+                        break; 
+                    case BINARY: 
+                        limboAssertMsg(set_binary(lp, i+1, TRUE), "failed to set binary variable for LP"); 
+                        break;
+                    case INTEGER:
+                        limboAssertMsg(set_int(lp, i+1, TRUE), "failed to set integer variable for LP"); 
+                        break;
+                    default:
+                        limboAssertMsg(0, "unknown numeric type");
+                }
+            }
+
+            // create objective, a dense row without column indices 
+            if (model.numVariables())
+                limboAssertMsg(set_obj_fnex(lp, model.numVariables(), &arrays.vObjective[0], NULL), "failed to set objective for LP"); 
+            if (model.optimizeType() == MIN)
+            {
+                set_minim(lp); 
+            }
+            else 
+            {
+                set_maxim(lp); 
+            }
+
+            // create constraints 
+            limboAssertMsg(set_add_rowmode(lp, TRUE), "failed to enter row entry mode for LP");
+            for (unsigned int i = 0, ie = model.constraints().size(); i < ie; ++i)
+            {
+                int type = EQ; 
+                switch (arrays.vSense[i])
+                {
+                    case '>':
+                        type = GE; 
+                        break;
+                    case '<':
+                        type = LE; 
+                        break;
+                    case '=':
+                        type = EQ; 
+                        break;
+                    default:
+                        limboAssertMsg(0, "unknown sense");
+                }
+                limboAssertMsg(add_constraintex(lp, arrays.rowSize(i), arrays.constrMatrix.vElement+arrays.rowBegin(i), 
+                            arrays.constrMatrix.vColumn+arrays.rowBegin(i), type, arrays.vRhs[i]), "failed to add constraint for LP");
+            }
+            limboAssertMsg(set_add_rowmode(lp, FALSE), "failed to leave row entry mode for LP");
+            for (unsigned int i = 0, ie = model.constraints().size(); i < ie; ++i)
+                limboAssertMsg(set_row_name(lp, i+1, arrays.vConstraintNamePtr[i]), "failed to set constraint name %s for LP", arrays.vConstraintNamePtr[i]);
+
+            return lp; 
+        }
     protected:
         /// @brief copy constructor, forbidden 
         /// @param rhs right hand side 
@@ -293,9 +310,189 @@ class LPSolveLinearApi
         /// @brief assignment, forbidden 
         /// @param rhs right hand side 
         LPSolveLinearApi& operator=(LPSolveLinearApi const& rhs);
+        /// @brief callback of lpsolve polled during the solve 
+        /// @param lp lpsolve model 
+        /// @param userhandle pointer to this object 
+        /// @return TRUE to stop at a node or solution limit, or at the request of the incumbent callback 
+        static int __WINAPI abortCallback(lprec* lp, void* userhandle)
+        {
+            LPSolveLinearApi* api = static_cast<LPSolveLinearApi*>(userhandle); 
+            return api->m_stop 
+                || (api->m_control->nodeLimit() > 0 && get_total_nodes(lp) >= api->m_control->nodeLimit()) 
+                || (api->m_control->solutionLimit() > 0 && api->m_numIncumbents >= api->m_control->solutionLimit()); 
+        }
+        /// @brief callback of lpsolve at each improved solution 
+        /// @param lp lpsolve model 
+        /// @param userhandle pointer to this object 
+        /// @param msg message, MSG_MILPBETTER 
+        static void __WINAPI messageCallback(lprec* lp, void* userhandle, int msg)
+        {
+            if (msg != MSG_MILPBETTER)
+                return; 
+            LPSolveLinearApi* api = static_cast<LPSolveLinearApi*>(userhandle); 
+            ++api->m_numIncumbents; 
+            IncumbentCallback* incumbent = api->m_control->incumbentCallback(); 
+            if (incumbent == NULL)
+                return; 
+            // map columns left by presolve to the model, removed ones keep the start 
+            std::vector<double> vSolution (api->m_model->variableSolutions().begin(), api->m_model->variableSolutions().end()); 
+            int numRows = get_Nrows(lp); 
+            int numColumns = get_Ncolumns(lp); 
+            int numOrigRows = get_Norig_rows(lp); 
+            std::vector<REAL> vColumn (numColumns); 
+            if (numColumns && get_variables(lp, &vColumn[0]))
+            {
+                for (int j = 1; j <= numColumns; ++j)
+                    vSolution[get_orig_index(lp, numRows+j)-numOrigRows-1] = vColumn[j-1]; 
+            }
+            api->m_stop = !(*incumbent)(vSolution, get_working_objective(lp)); 
+        }
 
         model_type* m_model; ///< model for the problem 
         lprec* m_lpModel; ///< model for LPSolve 
+        SolveControl const* m_control; ///< control of the current solve 
+        long m_numIncumbents; ///< number of improved solutions in the current solve 
+        bool m_stop; ///< whether the incumbent callback requests to stop 
+};
+
+/// @brief lpsolve model kept alive across solves of a @ref limbo::solvers::LinearModel. 
+/// 
+/// The session loads the model once, applies each modification to both the @ref limbo::solvers::LinearModel and the lpsolve model, 
+/// and re-solves from the last basis, which lpsolve keeps as long as the model is not presolved. 
+/// Presolve is therefore turned off after applying the parameters, as it removes rows and columns from the model. 
+/// The @ref limbo::solvers::LinearModel must only be modified through the session while it is alive. 
+/// @tparam T coefficient type 
+/// @tparam V variable type 
+template <typename T, typename V>
+class LPSolveLinearSession 
+{
+    public:
+        /// @brief linear model type for the problem 
+        typedef LinearModel<T, V> model_type; 
+        /// @nowarn
+        typedef typename model_type::coefficient_value_type coefficient_value_type; 
+        typedef typename model_type::variable_value_type variable_value_type; 
+        typedef typename model_type::variable_type variable_type;
+        typedef typename model_type::constraint_type constraint_type; 
+        typedef typename model_type::term_type term_type; 
+        typedef LPSolveParameters parameter_type; 
+        /// @endnowarn
+
+        /// @brief constructor, load the model 
+        /// @param model pointer to the model of problem 
+        /// @param param set additional parameters, use default if NULL 
+        LPSolveLinearSession(model_type* model, parameter_type const* param = NULL)
+            : m_model(model)
+            , m_lpModel(NULL)
+        {
+            LPSolveParameters defaultParam; 
+            if (param == NULL)
+                param = &defaultParam; 
+            m_lpModel = LPSolveLinearApi<T, V>::createModel(*m_model, "LPSolveLinearSession"); 
+            set_scaling(m_lpModel, SCALE_RANGE); 
+            param->operator()(m_lpModel); 
+            set_presolve(m_lpModel, PRESOLVE_NONE, get_presolveloops(m_lpModel)); 
+        }
+        /// @brief destructor, free the lpsolve model 
+        ~LPSolveLinearSession()
+        {
+            delete_lp(m_lpModel); 
+        }
+
+        /// @brief solve or re-solve the model and write solutions to the @ref limbo::solvers::LinearModel 
+        /// @return solving status 
+        SolverProperty operator()()
+        {
+#ifdef DEBUG_LPSOLVEAPI
+            write_lp(m_lpModel, (char*)"problem.lp"); 
+#endif
+            int status = solve(m_lpModel); 
+            // the last solution is kept if stopped before any solution 
+            if (status == USERABORT || status == TIMEOUT)
+                return getSolveStatus(status); 
+            std::vector<REAL> vSol (m_model->numVariables()); 
+            if (!vSol.empty())
+                limboAssertMsg(get_variables(m_lpModel, &vSol[0]), "failed to get_variables for LP");
+            for (unsigned int i = 0; i < vSol.size(); ++i)
+                m_model->setVariableSolution(m_model->variable(i), vSol[i]);
+            return getSolveStatus(status);
+        }
+
+        /// @brief add a constraint, a constraint of one term updates bounds as @ref limbo::solvers::LinearModel::addConstraint 
+        /// @param constr constraint 
+        /// @param name constraint name 
+        /// @return true if added 
+        bool addConstraint(constraint_type const& constr, std::string const& name = "")
+        {
+            unsigned int numConstraints = m_model->constraints().size(); 
+            if (!m_model->addConstraint(constr, name))
+                return false; 
+            if (m_model->constraints().size() == numConstraints) // bound constraint 
+            {
+                variable_type var = constr.expression().terms().front().variable(); 
+                limboAssertMsg(set_bounds(m_lpModel, var.id()+1, m_model->variableLowerBound(var), m_model->variableUpperBound(var)), "failed to set bounds of variable for LP");
+            }
+            else 
+            {
+                constraint_type const& added = m_model->constraints().back(); 
+                std::vector<int> vIdx; 
+                std::vector<REAL> vValue; 
+                vIdx.reserve(added.expression().terms().size()); 
+                vValue.reserve(added.expression().terms().size()); 
+                for (typename std::vector<term_type>::const_iterator it = added.expression().terms().begin(), ite = added.expression().terms().end(); it != ite; ++it)
+                {
+                    vIdx.push_back(it->variable().id()+1); // variable id starts from 1 for LPSolve
+                    vValue.push_back(it->coefficient());
+                }
+                int type = (added.sense() == '<')? LE : (added.sense() == '>')? GE : EQ; 
+                limboAssertMsg(add_constraintex(m_lpModel, vIdx.size(), &vValue[0], &vIdx[0], type, added.rightHandSide()), "failed to add constraint for LP");
+                limboAssertMsg(set_row_name(m_lpModel, m_model->constraints().size(), const_cast<char*>(name.c_str())), "failed to set constraint name %s for LP", name.c_str()); 
+            }
+            return true; 
+        }
+        /// @brief remove constraints, the remaining ones are renumbered as @ref limbo::solvers::LinearModel::removeConstraints 
+        /// @param vConstraintId indices of constraints 
+        void removeConstraints(std::vector<unsigned int> const& vConstraintId)
+        {
+            m_model->removeConstraints(vConstraintId); 
+            // delete from the last row, as lpsolve renumbers the rows after each deletion 
+            std::vector<unsigned int> vSortedId (vConstraintId); 
+            std::sort(vSortedId.begin(), vSortedId.end()); 
+            vSortedId.erase(std::unique(vSortedId.begin(), vSortedId.end()), vSortedId.end()); 
+            for (std::vector<unsigned int>::const_reverse_iterator it = vSortedId.rbegin(); it != vSortedId.rend(); ++it)
+                limboAssertMsg(del_constraint(m_lpModel, *it+1), "failed to delete constraint %u for LP", *it); 
+        }
+        /// @brief change bounds of a variable 
+        /// @param var variable 
+        /// @param lb lower bound 
+        /// @param ub upper bound 
+        void setVariableBounds(variable_type const& var, variable_value_type lb, variable_value_type ub)
+        {
+            m_model->setVariableLowerBound(var, lb); 
+            m_model->setVariableUpperBound(var, ub); 
+            limboAssertMsg(set_bounds(m_lpModel, var.id()+1, lb, ub), "failed to set bounds of variable for LP");
+        }
+        /// @brief change the coefficient of a variable in the objective 
+        /// @param var variable 
+        /// @param coef coefficient 
+        void setObjectiveCoefficient(variable_type const& var, coefficient_value_type coef)
+        {
+            m_model->setObjectiveCoefficient(var, coef); 
+            limboAssertMsg(set_mat(m_lpModel, 0, var.id()+1, coef), "failed to set objective for LP"); 
+        }
+        /// @return lpsolve model 
+        lprec* lpModel() const {return m_lpModel;}
+
+    protected:
+        /// @brief copy constructor, forbidden 
+        /// @param rhs right hand side 
+        LPSolveLinearSession(LPSolveLinearSession const& rhs);
+        /// @brief assignment, forbidden 
+        /// @param rhs right hand side 
+        LPSolveLinearSession& operator=(LPSolveLinearSession const& rhs);
+
+        model_type* m_model; ///< model for the problem 
+        lprec* m_lpModel; ///< model for LPSolve, alive with the session 
 };
 
 } // namespace solvers
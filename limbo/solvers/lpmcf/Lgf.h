@@ -121,6 +121,7 @@ class Lgf
 			graph_type::NodeMap<int> shapes(m_graph);
 			graph_type::ArcMap<int> acolors(m_graph);
 			graph_type::ArcMap<int> widths(m_graph);
+			node_name_map_type names(m_graph);
 			//lemon::IdMap<graph_type, node_type> id(m_graph);
 
 			srand(1000);
@@ -134,6 +135,7 @@ class Lgf
 				sizes[v] = 1;
 				colors[v] = 1;
 				shapes[v] = 0;
+				names[v] = node_name(v);
 			}
 			i = 0;
 			for (graph_type::ArcIt a(m_graph); a != lemon::INVALID; ++a, ++i)
@@ -152,13 +154,13 @@ class Lgf
 				.nodeColors(lemon::composeMap(palette,colors))
 				.arcColors(lemon::composeMap(palette,acolors))
 				.arcWidthScale(.4).arcWidths(widths)
-				.nodeTexts(m_hName).nodeTextSize(3)
+				.nodeTexts(names).nodeTextSize(3)
 				.enableParallel().parArcDist(1)
 				.drawArrows().arrowWidth(1).arrowLength(1)
 				.run();
 			// dump lgf file 
 			lemon::DigraphWriter<graph_type>(m_graph, filename+".lgf")
-				.nodeMap("name", m_hName)
+				.nodeMap("name", names)
 				.nodeMap("supply", m_hSupply)
 				.arcMap("capacity_lower", m_hLower)
 				.arcMap("capacity_upper", m_hUpper)
@@ -181,13 +183,13 @@ class Lgf
 			for (graph_type::ArcIt a(m_graph); a != lemon::INVALID; ++a)
 			{
 				out << m_graph.id(a) << ": " 
-					<< m_hName[m_graph.source(a)] << "->" << m_hName[m_graph.target(a)] << ": " 
+					<< node_name(m_graph.source(a)) << "->" << node_name(m_graph.target(a)) << ": " 
 					<< m_hFlow[a] << endl;
 			}
 			out << "############# MCF Potential #############" << endl;
 			for (graph_type::NodeIt v(m_graph); v != lemon::INVALID; ++v)
 			{
-				out << m_hName[v] << ": " << m_hPot[v] << endl; 
+				out << node_name(v) << ": " << m_hPot[v] << endl; 
 			}
 
 			out.close();
@@ -205,6 +207,10 @@ class Lgf
 				.run();
 		}
 	protected:
+        /// @brief name of a node for printing 
+        /// @param v node 
+        /// @return name read from .lgf file 
+		virtual string node_name(node_type const& v) const {return m_hName[v];}
         /// @brief run algorithm 
         /// @return solving status: OPTIMAL, INFEASIBLE, or UNBOUNDED
 		typename alg_type::ProblemType run()
@@ -256,7 +262,7 @@ class Lgf
 		arc_value_map_type m_hUpper; ///< upper bound of flow, arc capacity in mcf  
 		arc_cost_map_type m_hCost; ///< arc cost in mcf 
 		node_value_map_type m_hSupply; ///< node supply in mcf 
-		node_name_map_type m_hName; ///< node name in mcf 
+		node_name_map_type m_hName; ///< node name in mcf, only set by @ref read_lgf 
 		cost_type m_totalcost; ///< total cost after solving 
 
 		arc_flow_map_type m_hFlow; ///< solution of min-cost flow, which is the dual solution of LP 
@@ -17,12 +17,16 @@
 #include <string>
 #include <cctype>
 #include <ctime>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
 #include <boost/cstdint.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/foreach.hpp>
 #include <boost/typeof/typeof.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <limbo/containers/TaskPool.h>
 #include <limbo/solvers/lpmcf/Lgf.h>
 #include <limbo/parsers/lp/bison/LpDriver.h>
 #include <limbo/math/Math.h>
@@ -97,32 +101,32 @@ struct hash_pair : pair<T1, T2>
 ///
 /// 1. Primal problem \n
 /// \f{eqnarray*}{
-/// & min. & \sum_{i=1}^{n} c_i \cdot x_i, \\
-/// & s.t. & x_i - x_j \ge b_{ij}, \forall (i, j) \in E,  \\
+/// & min. & \sum_{i=1}^{n} c_i \cdot x_i, \\[0pt]
+/// & s.t. & x_i - x_j \ge b_{ij}, \forall (i, j) \in E,  \\[0pt]
 /// &     & d_i \le x_i \le u_i, \forall i \in [1, n].  
 /// \f}
 /// \n
 /// 2. Introduce new variables \f$y_i\f$ in \f$[0, n]\f$, set \f$x_i = y_i - y_0\f$, \n
 /// \f{eqnarray*}{
-/// & min. & \sum_{i=1}^{n} c_i \cdot (y_i-y_0), \\
-/// & s.t. & y_i - y_j \ge b_{ij}, \forall (i, j) \in E \\
-/// &      & d_i \le y_i - y_0 \le u_i, \forall i \in [1, n], \\
+/// & min. & \sum_{i=1}^{n} c_i \cdot (y_i-y_0), \\[0pt]
+/// & s.t. & y_i - y_j \ge b_{ij}, \forall (i, j) \in E \\[0pt]
+/// &      & d_i \le y_i - y_0 \le u_i, \forall i \in [1, n], \\[0pt]
 /// &      & y_i \textrm{ is unbounded integer}, \forall i \in [0, n].  
 /// \f}
 /// \n
 /// 3. Re-write the problem \n
 /// \f{eqnarray*}{
-/// & min. & \sum_{i=0}^{n} c_i \cdot y_i, \textrm{ where } \
+/// & min. & \sum_{i=0}^{n} c_i \cdot y_i, \textrm{ where }
 ///   c_i = \left\{\begin{array}{lr}
-///             c_i, & \forall i \in [1, n],  \\
+///             c_i, & \forall i \in [1, n],  \\[0pt]
 ///             - \sum_{j=1}^{n} c_i, & i = 0, 
-///           \end{array}\right. \\
-/// & s.t. & y_i - y_j \ge \
+///           \end{array}\right. \\[0pt]
+/// & s.t. & y_i - y_j \ge
 ///        \left\{\begin{array}{lr}
-///            b_{ij}, & \forall (i, j) \in E, \\
-///            d_i,  & \forall j = 0, i \in [1, n], \\
+///            b_{ij}, & \forall (i, j) \in E, \\[0pt]
+///            d_i,  & \forall j = 0, i \in [1, n], \\[0pt]
 ///            -u_i, & \forall i = 0, j \in [1, n], 
-///        \end{array}\right. \\
+///        \end{array}\right. \\[0pt]
 /// &      & y_i \textrm{ is unbounded integer}, \forall i \in [0, n].  
 /// \f}
 /// \n
@@ -135,6 +139,11 @@ struct hash_pair : pair<T1, T2>
 /// So here I introduce a member variable m_M to represent unlimit, but it is much smaller than real bound of integer.
 /// But there may be problem if potential overflow appears. 
 /// 
+/// Variables get contiguous indices when they are added, which are also the ids of their nodes, 
+/// and constraints are kept in arrays of endpoints and constants indexed by the ids of their arcs. 
+/// Names are only looked up when variables are added by name; 
+/// @ref read_lp takes the indices assigned by LpParser::read(LpSparseModel&, string const&). 
+/// 
 /// @tparam T data type 
 template <typename T = int64_t>
 class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
@@ -163,70 +172,14 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 		typedef typename base_type1::alg_type alg_type;
         /// @endnowarn
 
-        /// @class limbo::solvers::lpmcf::LpDualMcf::variable_type
-		/// @brief variable \f$x_i\f$ in the primal linear programming problem.
-        /// standard format: \f$l_i \le x_i \le u_i\f$
-		/// maps to 
-		/// node \f$i\f$, 
-		/// arcs from node \f$i\f$ to node \f$st\f$. 
-		struct variable_type 
-		{
-			string name; ///< name of variable 
-			pair<value_type, value_type> range; ///< pair of \f$(l_i, u_i)\f$
-			value_type weight; ///< weight in the objective, i.e., \f$c_i\f$
-			value_type value; ///< solved value 
-			node_type node; ///< node \f$i\f$ in the graph 
-
-            /// @brief constructor 
-            /// @param n name 
-            /// @param l lower bound of range, i.e., \f$l_i\f$
-            /// @param r upper bound of range, i.e., \f$u_i\f$
-            /// @param w weight in the objective, i.e., \f$c_i\f$
-            /// @param v solved value 
-			variable_type(string const& n, 
-					value_type const& l = 0, 
-					value_type const& r = std::numeric_limits<value_type>::max(),
-					value_type const& w = 0, 
-					value_type const& v = 0)
-				: name(n), range(make_pair(l, r)), weight(w), value(v) {}
-
-            /// @brief check if the variable is lower bounded 
-            /// @return true if the variable has a lower bound 
-			bool is_lower_bounded() const {return range.first != limbo::lowest<value_type>();}
-            /// @brief check if the variable is upper bounded 
-            /// @return true if the variable is an upper bound 
-			bool is_upper_bounded() const {return range.second != std::numeric_limits<value_type>::max();}
-            /// @brief check if the variable is bounded 
-            /// @return true if the variable is eitehr lower bounded or upper bounded 
-			bool is_bounded() const {return is_lower_bounded() || is_upper_bounded();}
-		};
-
-        /// @class limbo::solvers::lpmcf::LpDualMcf::constraint_type
-        /// @brief constraint object in the primal linear programming problem. 
-		/// standard format: \f$x_i - x_j \ge c_{ij}\f$
-		/// maps to 
-		/// arc \f$x_i \rightarrow x_j, \textrm{cost} = -c_{ij}\f$. 
-		struct constraint_type 
-		{
-			pair<string, string> variable; ///< variable \f$x_i\f$ and \f$x_j\f$
-			value_type constant; ///< constant in the right hand side, i.e., \f$c_{ij}\f$
-			arc_type arc; ///< arc \f$x_i \rightarrow x_j\f$ in the graph 
-			
-            /// @brief constructor 
-            /// @param xi \f$x_i\f$
-            /// @param xj \f$x_j\f$
-            /// @param c \f$c_{ij}\f$
-			constraint_type(string const& xi, string const& xj, value_type const& c)
-				: variable(make_pair(xi, xj)), constant(c) {}
-		};
-
 		/// @brief constructor 
 		/// @param max_limit represents unlimited arc capacity, default value is \f$2^{32 \times \frac{3}{4}}\f$ for int32_t, \f$2^{64 \times \frac{3}{4}}\f$ for int64_t...
 		LpDualMcf(value_type max_limit = (value_type(2) << (sizeof(value_type)*8*3/4))) 
 			: base_type1(), 
 			base_type2(),
 			m_is_bounded(false), 
-			m_M(max_limit) // use as unlimited number 
+			m_M(max_limit), // use as unlimited number 
+			m_num_threads(limbo::containers::num_threads())
 		{
 			if (m_M < 0) m_M = -m_M; // make sure m_M is positive 
 		}
@@ -241,31 +194,17 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 				double l = limbo::lowest<double>(), 
 				double r = std::numeric_limits<value_type>::max())
 		{
-            // in case of overflow 
-            value_type lb = l; 
-            value_type ub = r;
-            if (l <= (double)limbo::lowest<value_type>())
-                lb = limbo::lowest<value_type>();
-            if (r >= (double)std::numeric_limits<value_type>::max())
-                ub = std::numeric_limits<value_type>::max();
-			limboAssertMsg(lb <= ub, "failed to add bound %lu <= %lu <= %lu", lb, xi, ub);
-
 			// no variables with the same name is allowed 
-			BOOST_AUTO(found, m_hVariable.find(xi));
-			if (found == m_hVariable.end())
-				limboAssertMsg(m_hVariable.insert(make_pair(xi, variable_type(xi, lb, ub, 0))).second,
-						"failed to insert variable %lu to hash table", xi);
-			else 
+			std::pair<typename unordered_map<string, unsigned>::iterator, bool> found = m_hVariableId.insert(make_pair(xi, (unsigned)m_vVariableName.size()));
+			if (found.second)
 			{
-				found->second.range.first = std::max(found->second.range.first, (value_type)lb);
-				found->second.range.second = std::min(found->second.range.second, (value_type)ub);
-				limboAssertMsg(found->second.range.first <= found->second.range.second,
-						"failed to set bound %lu <= %lu <= %lu", found->second.range.first, xi, found->second.range.second);
+				m_vVariableName.push_back(xi);
+				m_vLowerBound.push_back(limbo::lowest<value_type>());
+				m_vUpperBound.push_back(std::numeric_limits<value_type>::max());
+				m_vWeight.push_back(0);
+				m_vValue.push_back(0);
 			}
-			// if user set bounds to variables 
-			// switch to bounded mode, which means there will be an additional node to the graph 
-			if (lb != limbo::lowest<value_type>() || ub != std::numeric_limits<value_type>::max())
-				this->is_bounded(true);
+			set_bounds(found.first->second, l, r);
 		}
         /// @brief add constraint callback for LpParser::LpDataBase
         /// @param terms array of terms in left hand side 
@@ -273,41 +212,11 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
         /// @param constant constant in the right hand side 
         virtual void add_constraint(std::string const& /*cname*/, LpParser::TermArray const& terms, char compare, double constant)
         {
-            limboAssert(terms.size() == 2 && terms[0].coef*terms[1].coef < 0);
+            limboAssert(terms.size() == 2);
             // in case some variables are not added yet 
             add_variable(terms[0].var); 
             add_variable(terms[1].var); 
-            string xi = terms[0].var;
-            string xj = terms[1].var; 
-            if (compare == '<' || compare == '=')
-            {
-                if (terms[0].coef > 0)
-                {
-                    xi = terms[1].var; 
-                    xj = terms[0].var; 
-                }
-                else 
-                {
-                    xi = terms[0].var; 
-                    xj = terms[1].var; 
-                }
-                constant = -constant;
-                add_constraint(xi, xj, constant);
-            }
-            if (compare == '>' || compare == '=')
-            {
-                if (terms[0].coef > 0)
-                {
-                    xi = terms[0].var; 
-                    xj = terms[1].var; 
-                }
-                else 
-                {
-                    xi = terms[1].var; 
-                    xj = terms[0].var; 
-                }
-                add_constraint(xi, xj, constant);
-            }
+            add_constraint(variable_id(terms[0].var), terms[0].coef, variable_id(terms[1].var), terms[1].coef, compare, constant);
         }
         /// @brief add object callback for LpParser::LpDataBase 
         /// @param minimize true denotes minimizing object, false denotes maximizing object 
@@ -327,25 +236,26 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
         }
 		/// @brief add constraint 
 		/// \f$x_i - x_j \ge c_{ij}\f$. 
-        /// 
-		/// Assume there's no duplicate.  
         /// @param xi variable \f$x_i\f$
         /// @param xj variable \f$x_j\f$
         /// @param cij constant \f$c_{ij}\f$
 		virtual void add_constraint(string const& xi, string const& xj, cost_type const& cij)
 		{
-			BOOST_AUTO(found, m_hConstraint.find(make_pair(xi, xj)));
-			if (found == m_hConstraint.end())
-				limboAssertMsg(m_hConstraint.insert(
-							make_pair(
-								make_pair(xi, xj), 
-								constraint_type(xi, xj, cij)
-								)
-							).second,
-						"failed to add constraint for %lu - %lu >= %lu", xi, xj, cij
-						);
-			else // automatically reduce constraints 
-				found->second.constant = std::max(found->second.constant, cij);
+			add_constraint(variable_id(xi), variable_id(xj), cij);
+		}
+		/// @brief add constraint 
+		/// \f$x_i - x_j \ge c_{ij}\f$ by variable indices. 
+        /// 
+		/// Duplicate constraints are kept as parallel arcs, which do not change the optimum. 
+        /// @param xi index of variable \f$x_i\f$
+        /// @param xj index of variable \f$x_j\f$
+        /// @param cij constant \f$c_{ij}\f$
+		void add_constraint(unsigned xi, unsigned xj, cost_type const& cij)
+		{
+			limboAssertMsg(xi < num_variables() && xj < num_variables(), "failed to add constraint for %u - %u >= %ld", xi, xj, (long)cij);
+			m_vConstrSource.push_back(xi);
+			m_vConstrTarget.push_back(xj);
+			m_vConstrConstant.push_back(cij);
 		}
 		/// @brief add linear terms for objective function of the primal linear programming problem. 
         /// 
@@ -356,11 +266,15 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 		virtual void add_objective(string const& xi, value_type const& w)
 		{
 			if (w == 0) return;
-
-			BOOST_AUTO(found, m_hVariable.find(xi));
-			limboAssertMsg(found != m_hVariable.end(), "failed to add objective %lu %lu", w, xi);
-
-			found->second.weight += w;
+			add_objective(variable_id(xi), w);
+		}
+		/// @brief add linear terms for objective function by variable index. 
+        /// @param xi index of variable \f$x_i\f$
+        /// @param w weight 
+		void add_objective(unsigned xi, value_type const& w)
+		{
+			limboAssertMsg(xi < num_variables(), "failed to add objective %ld %u", (long)w, xi);
+			m_vWeight[xi] += w;
 		}
         /// @brief set integer variables 
         /// param vname integer variables  
@@ -377,6 +291,12 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
         /// @param v flag for whether the problem is bounded 
 		void is_bounded(bool v) {m_is_bounded = v;}
 
+		/// @return maximum number of threads to prepare the graph 
+		unsigned num_threads() const {return m_num_threads;}
+		/// @brief set maximum number of threads to prepare the graph, default is the number of online processors 
+		/// @param t number of threads 
+		void num_threads(unsigned t) {m_num_threads = std::max(t, 1U);}
+
 		/// @brief API to run the algorithm with input file. 
         /// 
         /// Read primal problem in lp format and then dump solution. 
@@ -404,26 +324,86 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 #endif 
 			return run();
 		}
+        /// @brief get index of variable \f$x_i\f$ 
+        /// @param xi variable \f$x_i\f$
+		/// @return index of the variable 
+		unsigned variable_id(string const& xi) const 
+		{
+			typename unordered_map<string, unsigned>::const_iterator found = m_hVariableId.find(xi);
+			limboAssertMsg(found != m_hVariableId.end(), "failed to find variable %s", xi.c_str());
+
+			return found->second;
+		}
         /// @brief get solution to \f$x_i\f$ 
         /// @param xi variable \f$x_i\f$
 		/// @return solution 
 		value_type solution(string const& xi) const 
 		{
-			BOOST_AUTO(found, m_hVariable.find(xi));
-			limboAssertMsg(found != m_hVariable.end(), "failed to find variable %lu", xi);
-
-			return found->second.value;
+			return m_vValue[variable_id(xi)];
+		}
+        /// @brief get solution to \f$x_i\f$ by index 
+        /// @param xi index of variable \f$x_i\f$
+		/// @return solution 
+		value_type solution(unsigned xi) const 
+		{
+			return m_vValue.at(xi);
 		}
+		/// @return number of variables 
+		unsigned num_variables() const {return m_vVariableName.size();}
+		/// @return number of constraints 
+		unsigned num_constraints() const {return m_vConstrSource.size();}
 		/// @brief read lp format 
         /// @param filename input file in lp format 
 		/// initializing graph 
 		void read_lp(string const& filename) 
 		{
-			LpParser::read(*this, filename);
+			LpParser::LpSparseModel model;
+			if (LpParser::read(model, filename))
+				load_lp(model);
+		}
+		/// @brief load a problem read by LpParser::read(LpSparseModel&, string const&). 
+		/// 
+		/// Variables of the model keep their indices if the problem is empty. 
+		/// Each constraint must have two terms with opposite signs. 
+		/// @param model problem in compressed sparse rows 
+		void load_lp(LpParser::LpSparseModel const& model)
+		{
+			// map indices of the model to indices of the problem 
+			std::vector<unsigned> vId (model.num_variables());
+			reserve(num_variables()+model.num_variables(), num_constraints()+model.num_constraints()*2);
+			for (unsigned i = 0; i < model.num_variables(); ++i)
+			{
+				add_variable(model.vVariableName[i]);
+				vId[i] = variable_id(model.vVariableName[i]);
+				set_bounds(vId[i], model.vLowerBound[i], model.vUpperBound[i]);
+			}
+			for (unsigned k = 0; k < model.vObjColumn.size(); ++k)
+				add_objective(vId[model.vObjColumn[k]], (value_type)(model.minimize? model.vObjElement[k] : -model.vObjElement[k]));
+			for (unsigned i = 0; i < model.num_constraints(); ++i)
+			{
+				int k = model.vRowBegin[i];
+				limboAssertMsg(model.vRowBegin[i+1]-k == 2, "failed to add constraint %u with %d terms", i, model.vRowBegin[i+1]-k);
+				add_constraint(vId[model.vColumn[k]], model.vElement[k], vId[model.vColumn[k+1]], model.vElement[k+1], model.vSense[i], model.vRhs[i]);
+			}
+		}
+		/// @brief reserve space for variables and constraints 
+		/// @param n number of variables 
+		/// @param m number of constraints 
+		void reserve(unsigned n, unsigned m)
+		{
+			m_vVariableName.reserve(n);
+			m_vLowerBound.reserve(n);
+			m_vUpperBound.reserve(n);
+			m_vWeight.reserve(n);
+			m_vValue.reserve(n);
+			m_hVariableId.reserve(n);
+			m_vConstrSource.reserve(m);
+			m_vConstrTarget.reserve(m);
+			m_vConstrConstant.reserve(m);
 		}
 		/// @brief check empty
 		/// @return true if there's no variable created
-		bool empty() const {return m_hVariable.empty();}
+		bool empty() const {return m_vVariableName.empty();}
 
 		/// @brief print solutions into a file 
 		/// including primal problem and dual problem
@@ -440,11 +420,8 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 			}
 
 			out << "############# LP Solution #############" << endl;
-			for (BOOST_AUTO(it, this->m_hVariable.begin()); it != this->m_hVariable.end(); ++it)
-			{
-				variable_type const& variable = it->second;
-				out << this->m_hName[variable.node] << ": " << variable.value << endl;
-			}
+			for (unsigned i = 0; i < num_variables(); ++i)
+				out << m_vVariableName[i] << ": " << m_vValue[i] << endl;
 
 			out.close();
 		}
@@ -461,93 +438,147 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 
 			// print objective 
 			out << "Minimize\n";
-			for (BOOST_AUTO(it, this->m_hVariable.begin()); it != this->m_hVariable.end(); ++it)
+			for (unsigned i = 0; i < num_variables(); ++i)
 			{
-				variable_type const& variable = it->second;
-				if (variable.weight == 0) continue;
+				if (m_vWeight[i] == 0) continue;
 
-				out << "\t" << " + " << variable.weight << " " << variable.name << endl;
+				out << "\t" << " + " << m_vWeight[i] << " " << m_vVariableName[i] << endl;
 			}
 			// print constraints 
 			out << "Subject To\n";
-			for (BOOST_AUTO(it, this->m_hConstraint.begin()); it != this->m_hConstraint.end(); ++it)
+			for (unsigned k = 0; k < num_constraints(); ++k)
 			{
-				constraint_type const& constraint = it->second;
-				out << "\t" << constraint.variable.first 
-					<< " - " << constraint.variable.second 
-					<< " >= " << constraint.constant << endl;
+				out << "\t" << m_vVariableName[m_vConstrSource[k]] 
+					<< " - " << m_vVariableName[m_vConstrTarget[k]] 
+					<< " >= " << m_vConstrConstant[k] << endl;
 			}
 			// print bounds 
 			out << "Bounds\n";
-			for (BOOST_AUTO(it, this->m_hVariable.begin()); it != this->m_hVariable.end(); ++it)
+			for (unsigned i = 0; i < num_variables(); ++i)
 			{
-				variable_type const& variable = it->second;
+				string const& name = m_vVariableName[i];
 				out << "\t";
 				// both lower bound and upper bound 
-				if (variable.range.first != limbo::lowest<value_type>()
-						&& variable.range.second != std::numeric_limits<value_type>::max())
-					out << variable.range.first << " <= " 
-						<< variable.name << " <= " << variable.range.second << endl;
+				if (is_lower_bounded(i) && is_upper_bounded(i))
+					out << m_vLowerBound[i] << " <= " 
+						<< name << " <= " << m_vUpperBound[i] << endl;
 				// lower bound only 
-				else if (variable.range.first != limbo::lowest<value_type>())
-					out << variable.name << " >= " << variable.range.first << endl;
+				else if (is_lower_bounded(i))
+					out << name << " >= " << m_vLowerBound[i] << endl;
 				// upper bound only 
-				else if (variable.range.second != std::numeric_limits<value_type>::max())
-					out << variable.name << " <= " << variable.range.second << endl;
+				else if (is_upper_bounded(i))
+					out << name << " <= " << m_vUpperBound[i] << endl;
 				// no bounds 
 				else 
-					out << variable.name << " free\n";
+					out << name << " free\n";
 			}
 			// print data type (integer)
 			out << "Generals\n";
-			for (BOOST_AUTO(it, this->m_hVariable.begin()); it != this->m_hVariable.end(); ++it)
-			{
-				variable_type const& variable = it->second;
-				out << "\t" << variable.name << endl;
-			}
+			for (unsigned i = 0; i < num_variables(); ++i)
+				out << "\t" << m_vVariableName[i] << endl;
 			out << "End";
 			out.close();
 		}
 	protected:
+		/// @brief parallel pass over blocks of constraint arcs 
+		struct ArcPass
+		{
+			LpDualMcf* solver; ///< problem 
+			/// @param b first arc 
+			/// @param e end arc 
+			void operator()(std::size_t b, std::size_t e) const {solver->arc_block(b, e);}
+		};
+
+		/// @brief tighten bounds of a variable 
+		/// @param xi index of variable \f$x_i\f$
+		/// @param l lower bound \f$l_i\f$
+		/// @param r upper bound \f$u_i\f$
+		void set_bounds(unsigned xi, double l, double r)
+		{
+            // in case of overflow 
+            value_type lb = limbo::lowest<value_type>(); 
+            value_type ub = std::numeric_limits<value_type>::max();
+            if (l > (double)limbo::lowest<value_type>())
+                lb = l;
+            if (r < (double)std::numeric_limits<value_type>::max())
+                ub = r;
+			limboAssertMsg(lb <= ub, "failed to add bound %ld <= %s <= %ld", (long)lb, m_vVariableName[xi].c_str(), (long)ub);
+
+			m_vLowerBound[xi] = std::max(m_vLowerBound[xi], lb);
+			m_vUpperBound[xi] = std::min(m_vUpperBound[xi], ub);
+			limboAssertMsg(m_vLowerBound[xi] <= m_vUpperBound[xi],
+					"failed to set bound %ld <= %s <= %ld", (long)m_vLowerBound[xi], m_vVariableName[xi].c_str(), (long)m_vUpperBound[xi]);
+			// if user set bounds to variables 
+			// switch to bounded mode, which means there will be an additional node to the graph 
+			if (lb != limbo::lowest<value_type>() || ub != std::numeric_limits<value_type>::max())
+				this->is_bounded(true);
+		}
+		/// @brief add constraint from two terms 
+		/// @param x1 index of the first variable 
+		/// @param coef1 coefficient of the first variable 
+		/// @param x2 index of the second variable 
+		/// @param coef2 coefficient of the second variable 
+		/// @param compare operator '<', '>', '='
+		/// @param constant constant in the right hand side 
+		void add_constraint(unsigned x1, double coef1, unsigned x2, double coef2, char compare, double constant)
+		{
+            limboAssert(coef1*coef2 < 0);
+            // x1 is the variable with positive coefficient 
+            if (coef1 < 0)
+                std::swap(x1, x2);
+            if (compare == '<' || compare == '=')
+                add_constraint(x2, x1, (cost_type)-constant);
+            if (compare == '>' || compare == '=')
+                add_constraint(x1, x2, (cost_type)constant);
+		}
+		/// @param xi index of variable \f$x_i\f$
+		/// @return true if the variable has a lower bound 
+		bool is_lower_bounded(unsigned xi) const {return m_vLowerBound[xi] != limbo::lowest<value_type>();}
+		/// @param xi index of variable \f$x_i\f$
+		/// @return true if the variable has an upper bound 
+		bool is_upper_bounded(unsigned xi) const {return m_vUpperBound[xi] != std::numeric_limits<value_type>::max();}
+		/// @brief name of a node for printing 
+		/// @param v node 
+		/// @return name of the variable of the node 
+		virtual string node_name(node_type const& v) const 
+		{
+			unsigned id = this->m_graph.id(v);
+			return (id < num_variables())? m_vVariableName[id] : string("lpmcf_additional_node");
+		}
 		/// @brief prepare before run 
 		void prepare()
 		{
+			this->m_graph.clear();
+			unsigned num_bound_arcs = 0;
+			if (this->is_bounded())
+				for (unsigned i = 0; i < num_variables(); ++i)
+					num_bound_arcs += is_lower_bounded(i)+is_upper_bounded(i);
+			this->m_graph.reserveNode(num_variables()+1);
+			this->m_graph.reserveArc(num_constraints()+num_bound_arcs);
+
 			// 1. preparing nodes 
+			// node ids are variable indices, 
 			// set supply to its weight in the objective 
-			for (BOOST_AUTO(it, m_hVariable.begin()); it != m_hVariable.end(); ++it)
+			for (unsigned i = 0; i < num_variables(); ++i)
 			{
-				variable_type& variable = it->second;
-				node_type const& node = this->m_graph.addNode();
-				variable.node = node;
-				this->m_hSupply[node] = variable.weight; 
-				this->m_hName[node] = variable.name;
+				node_type node = this->m_graph.addNode();
+				this->m_hSupply[node] = m_vWeight[i]; 
 			}
 
 			// 2. preparing arcs 
 			// arcs constraints like xi - xj >= cij 
 			// add arc from node i to node j with cost -cij and capacity unlimited 
-			for (BOOST_AUTO(it, m_hConstraint.begin()); it != m_hConstraint.end(); ++it)
-			{
-				constraint_type& constraint = it->second;
-				BOOST_AUTO(found1, m_hVariable.find(constraint.variable.first));
-				BOOST_AUTO(found2, m_hVariable.find(constraint.variable.second));
-				limboAssertMsg(found1 != m_hVariable.end(), "failed to find variable1 %lu in preparing arcs", constraint.variable.first);
-				limboAssertMsg(found2 != m_hVariable.end(), "failed to find variable2 %lu in preparing arcs", constraint.variable.second);
+			// arc ids are constraint indices, the arcs are linked to nodes sequentially, 
+			// and their costs and capacities are set in parallel 
+			for (unsigned k = 0; k < num_constraints(); ++k)
+				this->m_graph.addArc(this->m_graph.nodeFromId(m_vConstrSource[k]), this->m_graph.nodeFromId(m_vConstrTarget[k]));
+			ArcPass pass;
+			pass.solver = this;
+			unsigned block_size = 16384;
+			// threads are not worth it if there are few blocks 
+			unsigned num_blocks = (num_constraints()+block_size-1)/block_size;
+			limbo::containers::parallel_for(0, num_constraints(), block_size, std::max(std::min(m_num_threads, num_blocks/4), 1U), pass);
 
-				variable_type const& variable1 = found1->second;
-				variable_type const& variable2 = found2->second;
-
-				node_type const& node1 = variable1.node;
-				node_type const& node2 = variable2.node;
-
-				arc_type const& arc = this->m_graph.addArc(node1, node2);
-				constraint.arc = arc;
-
-				this->m_hCost[arc] = -constraint.constant;
-				this->m_hLower[arc] = 0;
-				//m_hUpper[arc] = std::numeric_limits<value_type>::max();
-				this->m_hUpper[arc] = m_M;
-			}
 			// 3. arcs for variable bounds 
 			// from node to additional node  
 			if (this->is_bounded())
@@ -556,35 +587,47 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 				// its corresponding weight is the negative sum of weight for other nodes 
 				m_addl_node = this->m_graph.addNode();
 				value_type addl_weight = 0;
-				for (BOOST_AUTO(it, m_hVariable.begin()); it != m_hVariable.end(); ++it)
-					addl_weight -= it->second.weight;
+				for (unsigned i = 0; i < num_variables(); ++i)
+					addl_weight -= m_vWeight[i];
 				this->m_hSupply[m_addl_node] = addl_weight; 
-				this->m_hName[m_addl_node] = "lpmcf_additional_node";
 
-				for (BOOST_AUTO(it, m_hVariable.begin()); it != m_hVariable.end(); ++it)
+				for (unsigned i = 0; i < num_variables(); ++i)
 				{
-					variable_type const& variable = it->second;
+					node_type node = this->m_graph.nodeFromId(i);
 					// has lower bound 
 					// add arc from node to additional node with cost d and cap unlimited
-					if (variable.is_lower_bounded())
+					if (is_lower_bounded(i))
 					{
-						arc_type const& arc = this->m_graph.addArc(variable.node, m_addl_node);
-						this->m_hCost[arc] = -variable.range.first;
+						arc_type const& arc = this->m_graph.addArc(node, m_addl_node);
+						this->m_hCost[arc] = -m_vLowerBound[i];
 						this->m_hLower[arc] = 0;
 						this->m_hUpper[arc] = m_M;
 					}
 					// has upper bound 
 					// add arc from additional node to node with cost u and capacity unlimited
-					if (variable.is_upper_bounded())
+					if (is_upper_bounded(i))
 					{
-						arc_type const& arc = this->m_graph.addArc(m_addl_node, variable.node);
-						this->m_hCost[arc] = variable.range.second;
+						arc_type const& arc = this->m_graph.addArc(m_addl_node, node);
+						this->m_hCost[arc] = m_vUpperBound[i];
 						this->m_hLower[arc] = 0;
 						this->m_hUpper[arc] = m_M;
 					}
 				}
 			}
 		}
+		/// @brief set costs and capacities of a block of constraint arcs 
+		/// @param b first arc 
+		/// @param e end arc 
+		void arc_block(std::size_t b, std::size_t e)
+		{
+			for (; b < e; ++b)
+			{
+				arc_type arc = this->m_graph.arcFromId(b);
+				this->m_hCost[arc] = -m_vConstrConstant[b];
+				this->m_hLower[arc] = 0;
+				this->m_hUpper[arc] = m_M;
+			}
+		}
 		/// @brief kernel function to run algorithm 
         /// @return solving status, OPTIMAL, INFEASIBLE, UNBOUNDED 
 		typename alg_type::ProblemType run()
@@ -635,11 +678,8 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 				value_type addl_value = 0;
 				if (this->is_bounded())
 					addl_value = this->m_hPot[m_addl_node];
-				for (BOOST_AUTO(it, m_hVariable.begin()); it != m_hVariable.end(); ++it)
-				{
-					variable_type& variable = it->second;
-					variable.value = this->m_hPot[variable.node]-addl_value;
-				}
+				for (unsigned i = 0; i < num_variables(); ++i)
+					m_vValue[i] = this->m_hPot[this->m_graph.nodeFromId(i)]-addl_value;
 			}
 
 			return status;
@@ -650,10 +690,19 @@ class LpDualMcf : public Lgf<T>, public LpParser::LpDataBase
 
 		value_type m_M; ///< a very large number to deal with ranges of variables 
 						///< reference from MIT paper: solving the convex cost integer dual network flow problem 
-		unordered_map<string, variable_type> m_hVariable; ///< variable map 
-		unordered_map<hash_pair<string, string>, constraint_type> m_hConstraint; ///< constraint map 
+		unsigned m_num_threads; ///< maximum number of threads to prepare the graph 
+
+		unordered_map<string, unsigned> m_hVariableId; ///< map variable names to indices, only used when adding by name 
+		std::vector<string> m_vVariableName; ///< names of variables 
+		std::vector<value_type> m_vLowerBound; ///< lower bounds of variables, i.e., \f$l_i\f$
+		std::vector<value_type> m_vUpperBound; ///< upper bounds of variables, i.e., \f$u_i\f$
+		std::vector<value_type> m_vWeight; ///< weights of variables in the objective, i.e., \f$c_i\f$
+		std::vector<value_type> m_vValue; ///< solved values of variables 
+		std::vector<unsigned> m_vConstrSource; ///< variable \f$x_i\f$ of constraints, i.e., source of the arcs 
+		std::vector<unsigned> m_vConstrTarget; ///< variable \f$x_j\f$ of constraints, i.e., target of the arcs 
+		std::vector<cost_type> m_vConstrConstant; ///< constant in the right hand side of constraints, i.e., \f$c_{ij}\f$
 };
 
 }}} // namespace lpmcf // namespace solvers // limbo
 
-#endif 
+#endif
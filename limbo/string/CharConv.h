@@ -0,0 +1,610 @@
+/**
+ * @file   CharConv.h
+ * @brief  locale-free conversion between numbers and characters without allocation
+ *
+ * Functions follow std::from_chars and std::to_chars of C++17, so parsers and writers get them with C++98.
+ * They read and write ranges of characters, never allocate on the common path,
+ * and always use '.' as the decimal point whatever the locale of the program is.
+ *
+ * Integers are read 8 digits at a time with arithmetic on 64-bit words (SWAR) when the machine is little-endian.
+ * Floating point numbers with at most 19 significant digits and small exponents are converted exactly
+ * with one multiplication or division; other numbers fall back to strtod.
+ * Floating point numbers are written in the shortest form that reads back to the same value.
+ *
+ * @date   Oct 2026
+ */
+
+#ifndef _LIMBO_STRING_CHARCONV
+#define _LIMBO_STRING_CHARCONV
+
+#include <algorithm>
+#include <cerrno>
+#include <cfloat>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+/// @brief namespace for Limbo
+namespace limbo
+{
+
+/// @brief result of @ref limbo::from_chars
+struct from_chars_result
+{
+	const char* ptr; ///< one past the last character of the number; the first character if no number is found
+	int ec; ///< 0 on success, EINVAL if no number is found, ERANGE if the value does not fit the type
+};
+
+/// @brief result of @ref limbo::to_chars
+struct to_chars_result
+{
+	char* ptr; ///< one past the last character written, or the end of the range on failure
+	int ec; ///< 0 on success, EOVERFLOW if the range is too short
+};
+
+/// @brief helpers of @ref CharConv.h
+namespace charconv_detail
+{
+
+/// @return true on little-endian machines, where 8 characters load into a word with the first one lowest
+inline bool little_endian()
+{
+	unsigned int x = 1;
+	return *reinterpret_cast<unsigned char*>(&x) == 1;
+}
+/// @return true if c is a decimal digit
+inline bool is_digit(char c)
+{
+	return (unsigned char)(c-'0') < 10;
+}
+/// @return true if all 8 characters in a word are decimal digits
+inline bool is_eight_digits(unsigned long long w)
+{
+	return ((w & 0xF0F0F0F0F0F0F0F0ULL) | (((w + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+/// @return value of 8 decimal digits in a word, combining pairs, then quadruples, with three multiplications
+inline unsigned long long parse_eight_digits(unsigned long long w)
+{
+	const unsigned long long mask = 0x000000FF000000FFULL;
+	const unsigned long long mul1 = 100 + (1000000ULL << 32);
+	const unsigned long long mul2 = 1 + (10000ULL << 32);
+	w -= 0x3030303030303030ULL;
+	w = (w * 10) + (w >> 8);
+	return (((w & mask) * mul1) + (((w >> 16) & mask) * mul2)) >> 32;
+}
+/// @return 10^k for 0 <= k <= 22, all exactly representable by double
+inline double exact_pow10(int k)
+{
+	static const double table[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	return table[k];
+}
+/// @return characters of 00, 01, ..., 99 in a row
+inline const char* digit_pairs()
+{
+	return "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+}
+
+/// @brief read decimal digits, 8 at a time while the value cannot overflow
+/// @param p first digit
+/// @param last end of characters
+/// @param value value as output
+/// @param overflow set if the value exceeds the range of unsigned long long
+/// @return one past the last digit
+inline const char* scan_unsigned(const char* p, const char* last, unsigned long long& value, bool& overflow)
+{
+	unsigned long long v = 0;
+	if (little_endian())
+	{
+		// 16 digits never overflow
+		for (int i = 0; i < 2 && last-p >= 8; ++i)
+		{
+			unsigned long long w;
+			std::memcpy(&w, p, 8);
+			if (!is_eight_digits(w))
+				break;
+			v = v*100000000ULL + parse_eight_digits(w);
+			p += 8;
+		}
+	}
+	const unsigned long long maxValue = std::numeric_limits<unsigned long long>::max();
+	for (; p != last && is_digit(*p); ++p)
+	{
+		unsigned d = *p-'0';
+		if (v > (maxValue-d)/10)
+			overflow = true;
+		else
+			v = v*10+d;
+	}
+	value = v;
+	return p;
+}
+/// @brief read a decimal integer with an optional sign
+template <typename IntType>
+inline from_chars_result from_chars_integer(const char* first, const char* last, IntType& value)
+{
+	from_chars_result result = {first, EINVAL};
+	const char* p = first;
+	bool negative = false;
+	if (p != last && (*p == '-' || *p == '+'))
+	{
+		negative = (*p == '-');
+		++p;
+	}
+	if (p == last || !is_digit(*p) || (negative && !std::numeric_limits<IntType>::is_signed))
+		return result;
+	unsigned long long u = 0;
+	bool overflow = false;
+	result.ptr = scan_unsigned(p, last, u, overflow);
+	// the magnitude of the lowest value is one more than the highest
+	unsigned long long limit = (unsigned long long)std::numeric_limits<IntType>::max() + (negative? 1 : 0);
+	if (overflow || u > limit)
+		result.ec = ERANGE;
+	else
+	{
+		value = (negative)? (IntType)(-(long long)(u-1)-1) : (IntType)u;
+		result.ec = 0;
+	}
+	return result;
+}
+
+/// @brief copy characters to the output range
+inline to_chars_result copy_chars(char* first, char* last, const char* s, const char* e)
+{
+	to_chars_result result = {last, EOVERFLOW};
+	if (e-s > last-first)
+		return result;
+	std::memcpy(first, s, e-s);
+	result.ptr = first+(e-s);
+	result.ec = 0;
+	return result;
+}
+/// @brief write decimal digits of an unsigned value ending at a position, two digits at a time
+/// @param end one past the position of the last digit
+/// @param u value
+/// @return position of the first digit
+inline char* write_digits_backward(char* end, unsigned long long u)
+{
+	const char* pairs = digit_pairs();
+	char* p = end;
+	while (u >= 100)
+	{
+		unsigned r = (unsigned)(u % 100);
+		u /= 100;
+		p -= 2;
+		p[0] = pairs[2*r];
+		p[1] = pairs[2*r+1];
+	}
+	if (u >= 10)
+	{
+		p -= 2;
+		p[0] = pairs[2*u];
+		p[1] = pairs[2*u+1];
+	}
+	else
+		*--p = (char)('0'+u);
+	return p;
+}
+/// @brief write decimal digits of an unsigned value
+/// @return one past the last character written
+inline char* write_digits(char* p, unsigned long long u)
+{
+	char digits[24];
+	char* begin = write_digits_backward(digits+sizeof(digits), u);
+	std::memcpy(p, begin, digits+sizeof(digits)-begin);
+	return p+(digits+sizeof(digits)-begin);
+}
+/// @brief write a decimal integer
+inline to_chars_result to_chars_integer(char* first, char* last, unsigned long long u, bool negative)
+{
+	char digits[24];
+	char* p = write_digits_backward(digits+sizeof(digits), u);
+	if (negative)
+		*--p = '-';
+	return copy_chars(first, last, p, digits+sizeof(digits));
+}
+
+/// @brief replace the decimal point of the locale by '.' in output of printf
+inline void to_point(char* first, char* last)
+{
+	char point = *std::localeconv()->decimal_point;
+	if (point != '.')
+		std::replace(first, last, point, '.');
+}
+
+/// @brief read a run of digits into a mantissa of at most 19 significant digits
+/// @param p first character
+/// @param last end of characters
+/// @param mantissa mantissa, updated
+/// @param digits an upper bound of significant digits in the mantissa, updated
+/// @param dropped number of digits beyond the mantissa, updated
+/// @param truncated set if a nonzero digit is dropped
+/// @return one past the last digit
+inline const char* scan_mantissa(const char* p, const char* last, unsigned long long& mantissa, int& digits, int& dropped, bool& truncated)
+{
+	if (little_endian())
+	{
+		while (digits <= 11 && last-p >= 8)
+		{
+			unsigned long long w;
+			std::memcpy(&w, p, 8);
+			if (!is_eight_digits(w))
+				break;
+			mantissa = mantissa*100000000ULL + parse_eight_digits(w);
+			if (mantissa)
+				digits += 8;
+			p += 8;
+		}
+	}
+	for (; p != last && is_digit(*p); ++p)
+	{
+		unsigned d = *p-'0';
+		if (digits < 19)
+		{
+			mantissa = mantissa*10+d;
+			if (mantissa)
+				++digits;
+		}
+		else
+		{
+			++dropped;
+			truncated |= (d != 0);
+		}
+	}
+	return p;
+}
+/// @brief convert mantissa * 10^exponent exactly, when both the mantissa and the power of 10 are exact in double
+/// @return false if not exact
+inline bool fast_path(unsigned long long mantissa, int exponent, double& value)
+{
+	const unsigned long long maxExact = 1ULL << 53;
+	if (mantissa > maxExact || exponent < -22 || exponent > 22+16)
+		return false;
+	// move extra powers of 10 into the mantissa while it stays exact
+	for (; exponent > 22; --exponent)
+	{
+		if (mantissa > maxExact/10)
+			return false;
+		mantissa *= 10;
+	}
+	value = (double)mantissa;
+	value = (exponent < 0)? value/exact_pow10(-exponent) : value*exact_pow10(exponent);
+	return true;
+}
+/// @brief convert characters with strtod, for numbers beyond the fast path
+/// @return false on overflow
+inline bool slow_path(const char* first, const char* last, double& value)
+{
+	char buf[128];
+	std::vector<char> vBuf;
+	char* s = buf;
+	std::size_t n = last-first;
+	if (n >= sizeof(buf))
+	{
+		vBuf.resize(n+1);
+		s = &vBuf[0];
+	}
+	std::memcpy(s, first, n);
+	s[n] = '\0';
+	char point = *std::localeconv()->decimal_point;
+	if (point != '.')
+		std::replace(s, s+n, '.', point);
+	double v = std::strtod(s, NULL);
+	if (v > DBL_MAX || v < -DBL_MAX)
+		return false;
+	value = v;
+	return true;
+}
+/// @return true if characters from p start with a lower case word, ignoring cases
+inline bool match_word(const char* p, const char* last, const char* word)
+{
+	for (; *word; ++p, ++word)
+	{
+		if (p == last || (*p | 0x20) != *word)
+			return false;
+	}
+	return true;
+}
+/// @brief read inf, infinity or nan after the sign
+inline from_chars_result from_chars_special(const char* first, const char* p, const char* last, bool negative, double& value)
+{
+	from_chars_result result = {first, EINVAL};
+	if (match_word(p, last, "inf"))
+	{
+		result.ptr = (match_word(p, last, "infinity"))? p+8 : p+3;
+		value = (negative)? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+		result.ec = 0;
+	}
+	else if (match_word(p, last, "nan"))
+	{
+		result.ptr = p+3;
+		value = std::numeric_limits<double>::quiet_NaN();
+		result.ec = 0;
+	}
+	return result;
+}
+
+/// @brief write a positive value with the fewest fraction digits that read back to it, for values that are
+/// exact as integer / 10^k; the division is exact in rounding, so a match reads back to the same value
+/// @return false if no such form is found
+inline bool write_short_decimal(char*& p, double value)
+{
+	const double maxExact = 9007199254740992.0;
+	for (int k = 1; k <= 22; ++k)
+	{
+		double s = value*exact_pow10(k);
+		if (s >= maxExact)
+			return false;
+		unsigned long long m = (unsigned long long)(s+0.5);
+		if ((double)m/exact_pow10(k) == value)
+		{
+			char digits[24];
+			char* begin = write_digits_backward(digits+sizeof(digits), m);
+			int n = digits+sizeof(digits)-begin;
+			if (n <= k)
+			{
+				*p++ = '0';
+				*p++ = '.';
+				p = std::fill_n(p, k-n, '0');
+				p = std::copy(begin, begin+n, p);
+			}
+			else
+			{
+				p = std::copy(begin, begin+n-k, p);
+				*p++ = '.';
+				p = std::copy(begin+n-k, begin+n, p);
+			}
+			return true;
+		}
+	}
+	return false;
+}
+/// @brief float has no exact decimal fast path, as a double division would round twice
+inline bool write_short_decimal(char*&, float)
+{
+	return false;
+}
+/// @brief read a float, declared for @ref write_shortest
+inline from_chars_result from_chars_float(const char* first, const char* last, float& value);
+/// @brief read a double, declared for @ref write_shortest
+inline from_chars_result from_chars_float(const char* first, const char* last, double& value);
+/// @brief write a positive finite value in the style of printf %g, with the fewest digits that read back to it
+template <typename T>
+inline char* write_shortest(char* p, T value)
+{
+	int maxPrecision = std::numeric_limits<T>::digits10+2;
+	// subnormal values have fewer bits, so shorter forms may read back
+	int precision = (value < std::numeric_limits<T>::min())? 1 : std::numeric_limits<T>::digits10;
+	for (; ; ++precision)
+	{
+		int n = snprintf(p, 30, "%.*g", precision, (double)value);
+		to_point(p, p+n);
+		T v;
+		if (precision == maxPrecision || (from_chars_float(p, p+n, v).ec == 0 && v == value))
+			return p+n;
+	}
+}
+/// @brief write a floating point value in the shortest form
+template <typename T>
+inline to_chars_result to_chars_float(char* first, char* last, T value)
+{
+	char buf[32];
+	char* p = buf;
+	if (value != value)
+		return copy_chars(first, last, "nan", "nan"+3);
+	if (value < 0 || (value == 0 && 1/value < 0))
+	{
+		*p++ = '-';
+		value = -value;
+	}
+	const T maxExact = (T)(1ULL << std::numeric_limits<T>::digits);
+	if (value > std::numeric_limits<T>::max())
+		p = std::copy("inf", "inf"+3, p);
+	else if (value < maxExact && value == (T)(unsigned long long)value)
+		p = write_digits(p, (unsigned long long)value);
+	else if (!(value >= (T)1e-4 && write_short_decimal(p, value)))
+		p = write_shortest(p, value);
+	return copy_chars(first, last, buf, p);
+}
+
+} // namespace charconv_detail
+
+/// @name read numbers
+/// Read a decimal number at the beginning of [first, last), without skipping whitespace.
+/// Unlike std::from_chars, a leading '+' is accepted, as it appears in many layout formats.
+/// Floating point numbers also accept exponents, inf, infinity and nan, ignoring cases.
+/// @param first first character
+/// @param last end of characters
+/// @param value value as output, unchanged on failure
+/// @return one past the number and error code
+///@{
+inline from_chars_result from_chars(const char* first, const char* last, int& value) {return charconv_detail::from_chars_integer(first, last, value);}
+inline from_chars_result from_chars(const char* first, const char* last, unsigned int& value) {return charconv_detail::from_chars_integer(first, last, value);}
+inline from_chars_result from_chars(const char* first, const char* last, long& value) {return charconv_detail::from_chars_integer(first, last, value);}
+inline from_chars_result from_chars(const char* first, const char* last, unsigned long& value) {return charconv_detail::from_chars_integer(first, last, value);}
+inline from_chars_result from_chars(const char* first, const char* last, long long& value) {return charconv_detail::from_chars_integer(first, last, value);}
+inline from_chars_result from_chars(const char* first, const char* last, unsigned long long& value) {return charconv_detail::from_chars_integer(first, last, value);}
+inline from_chars_result from_chars(const char* first, const char* last, double& value) {return charconv_detail::from_chars_float(first, last, value);}
+inline from_chars_result from_chars(const char* first, const char* last, float& value) {return charconv_detail::from_chars_float(first, last, value);}
+///@}
+
+/// @name write numbers
+/// Write a number to [first, last) without a terminating '\0'.
+/// Floating point numbers are written like printf %g, with the fewest digits that read back to the same value;
+/// 32 characters are always enough.
+/// @param first first character of the output range
+/// @param last end of the output range
+/// @param value value
+/// @return one past the last character written and error code
+///@{
+inline to_chars_result to_chars(char* first, char* last, int value) {return charconv_detail::to_chars_integer(first, last, (value < 0)? 0ULL-(unsigned long long)value : (unsigned long long)value, value < 0);}
+inline to_chars_result to_chars(char* first, char* last, unsigned int value) {return charconv_detail::to_chars_integer(first, last, value, false);}
+inline to_chars_result to_chars(char* first, char* last, long value) {return charconv_detail::to_chars_integer(first, last, (value < 0)? 0ULL-(unsigned long long)value : (unsigned long long)value, value < 0);}
+inline to_chars_result to_chars(char* first, char* last, unsigned long value) {return charconv_detail::to_chars_integer(first, last, value, false);}
+inline to_chars_result to_chars(char* first, char* last, long long value) {return charconv_detail::to_chars_integer(first, last, (value < 0)? 0ULL-(unsigned long long)value : (unsigned long long)value, value < 0);}
+inline to_chars_result to_chars(char* first, char* last, unsigned long long value) {return charconv_detail::to_chars_integer(first, last, value, false);}
+inline to_chars_result to_chars(char* first, char* last, double value) {return charconv_detail::to_chars_float(first, last, value);}
+inline to_chars_result to_chars(char* first, char* last, float value) {return charconv_detail::to_chars_float(first, last, value);}
+///@}
+
+/// @brief write a floating point number with a fixed number of fraction digits, the same as printf %.*f
+///
+/// Values below 2^53 after scaling are rounded from one exact multiplication,
+/// other values and values too close to a tie go through snprintf.
+/// @param first first character of the output range
+/// @param last end of the output range
+/// @param value value
+/// @param precision number of digits after the decimal point
+/// @return one past the last character written and error code
+inline to_chars_result to_chars(char* first, char* last, double value, int precision)
+{
+	using namespace charconv_detail;
+	if (precision < 0)
+		precision = 6;
+	if (value != value)
+		return copy_chars(first, last, "nan", "nan"+3);
+	char buf[64];
+	char* p = buf;
+	bool negative = (value < 0 || (value == 0 && 1/value < 0));
+	double a = (negative)? -value : value;
+	if (negative)
+		*p++ = '-';
+	if (a > DBL_MAX)
+	{
+		p = std::copy("inf", "inf"+3, p);
+		return copy_chars(first, last, buf, p);
+	}
+	if (precision <= 22)
+	{
+		const double maxExact = 9007199254740992.0;
+		double s = a*exact_pow10(precision);
+		double r = std::floor(s);
+		double fraction = s-r;
+		// s is within s*2^-53 of the exact product, so rounding is certain away from a tie
+		if (s < maxExact && std::fabs(fraction-0.5) > s*2.3e-16)
+		{
+			unsigned long long m = (unsigned long long)r + (fraction > 0.5);
+			char digits[24];
+			char* begin = write_digits_backward(digits+sizeof(digits), m);
+			int n = digits+sizeof(digits)-begin;
+			// pad with zeros so that at least one digit is before the decimal point
+			if (n <= precision)
+			{
+				p = std::fill_n(p, precision+1-n, '0');
+				p = std::copy(begin, begin+n, p);
+			}
+			else
+				p = std::copy(begin, begin+n, p);
+			if (precision > 0)
+			{
+				std::copy_backward(p-precision, p, p+1);
+				*(p-precision) = '.';
+				++p;
+			}
+			return copy_chars(first, last, buf, p);
+		}
+	}
+	int n = snprintf(NULL, 0, "%.*f", precision, value);
+	std::vector<char> vBuf;
+	char* s = buf;
+	if (n >= (int)sizeof(buf))
+	{
+		vBuf.resize(n+1);
+		s = &vBuf[0];
+	}
+	snprintf(s, n+1, "%.*f", precision, value);
+	to_point(s, s+n);
+	return copy_chars(first, last, s, s+n);
+}
+
+namespace charconv_detail
+{
+
+inline from_chars_result from_chars_float(const char* first, const char* last, double& value)
+{
+	from_chars_result result = {first, EINVAL};
+	const char* p = first;
+	bool negative = false;
+	if (p != last && (*p == '-' || *p == '+'))
+	{
+		negative = (*p == '-');
+		++p;
+	}
+	const char* begin = p;
+	unsigned long long mantissa = 0;
+	int digits = 0;
+	int dropped = 0;
+	int exponent = 0;
+	bool truncated = false;
+	p = scan_mantissa(p, last, mantissa, digits, dropped, truncated);
+	exponent += dropped;
+	bool found = (p != begin);
+	if (p != last && *p == '.')
+	{
+		const char* fraction = ++p;
+		dropped = 0;
+		p = scan_mantissa(p, last, mantissa, digits, dropped, truncated);
+		exponent -= (int)(p-fraction)-dropped;
+		found |= (p != fraction);
+	}
+	if (!found)
+		return from_chars_special(first, begin, last, negative, value);
+	if (p != last && (*p == 'e' || *p == 'E'))
+	{
+		const char* q = p+1;
+		bool negativeExponent = false;
+		if (q != last && (*q == '-' || *q == '+'))
+		{
+			negativeExponent = (*q == '-');
+			++q;
+		}
+		// an exponent without digits is not part of the number
+		if (q != last && is_digit(*q))
+		{
+			int e = 0;
+			for (; q != last && is_digit(*q); ++q)
+			{
+				if (e < 100000)
+					e = e*10 + (*q-'0');
+			}
+			exponent += (negativeExponent)? -e : e;
+			p = q;
+		}
+	}
+	result.ptr = p;
+	double v = 0;
+	if (mantissa == 0 || (!truncated && fast_path(mantissa, exponent, v)))
+		value = (negative)? -v : v;
+	else if (!slow_path(first, p, value))
+	{
+		result.ec = ERANGE;
+		return result;
+	}
+	result.ec = 0;
+	return result;
+}
+inline from_chars_result from_chars_float(const char* first, const char* last, float& value)
+{
+	double v;
+	from_chars_result result = from_chars_float(first, last, v);
+	if (result.ec == 0)
+	{
+		if (v <= DBL_MAX && v >= -DBL_MAX && (v > FLT_MAX || v < -FLT_MAX))
+			result.ec = ERANGE;
+		else
+			value = (float)v;
+	}
+	return result;
+}
+
+} // namespace charconv_detail
+
+} // namespace limbo
+
+#endif
@@ -0,0 +1,301 @@
+/**
+ * @file   test_AbacusLegalizer.cpp
+ * @brief  test @ref limbo::algorithms::placement::AbacusLegalizer with GreedySearch as the fallback
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <list>
+#include <limits>
+#include <boost/type_traits/integral_constant.hpp>
+#include <limbo/algorithms/placement/AbacusLegalizer.h>
+
+using std::cout;
+using std::endl;
+using std::list;
+using std::vector;
+using std::pair;
+
+/// a cell in rows of sites
+struct Cell
+{
+	int id; ///< index
+	int width; ///< width in sites
+	int x; ///< current site, -1 if not placed
+	int row; ///< current row, -1 if not placed
+	int gx; ///< desired site
+	int grow; ///< desired row
+};
+
+/// a row of sites
+struct Row
+{
+	int xl; ///< first site
+	int xh; ///< last site plus one
+};
+
+/// callback for both AbacusLegalizer and GreedySearch
+struct Callback
+{
+	/// @nowarn
+	typedef Cell node_type;
+	typedef Row row_type;
+	typedef int site_coordinate_type;
+	typedef list<Cell*> node_vector_type;
+	typedef list<Cell*> node_fail_vector_type;
+	typedef vector<Row*> row_vector_type;
+	typedef boost::true_type thread_safe_type;
+	/// @endnowarn
+	/// @brief displacement of a candidate of GreedySearch
+	struct cost_type
+	{
+		long cost; ///< displacement and penalty of swaps
+		int row; ///< target row
+		int site; ///< target site
+		vector<list<Cell*>::iterator> vItNode; ///< swapped cells and the position for insertion
+		/// constructor
+		cost_type() : cost(std::numeric_limits<long>::max()), row(-1), site(-1) {}
+		/// @return true if c1 has smaller cost than c2
+		friend bool operator<(cost_type const& c1, cost_type const& c2) {return c1.cost < c2.cost;}
+	};
+
+	vector<Row>* pRow; ///< rows
+	vector<list<Cell*> >* pRowCell; ///< cells in each row sorted by sites, ended by a zero width cell
+	int max_disp_x; ///< maximum displacement in sites
+	int max_disp_row; ///< maximum displacement in rows
+
+	/// constructor
+	Callback() : pRow(NULL), pRowCell(NULL), max_disp_x(0), max_disp_row(0) {}
+
+	/// @nowarn
+	int site_xl(const Cell* c) const {return c->x;}
+	int site_xh(const Cell* c) const {return c->x+c->width;}
+	pair<size_t, size_t> row_range(const Cell* c) const
+	{
+		return pair<size_t, size_t>(std::max(c->grow-max_disp_row, 0), std::min(c->grow+max_disp_row+1, (int)pRow->size()));
+	}
+	list<Cell*>& nodes_in_row(size_t row_idx) const {return (*pRowCell)[row_idx];}
+	bool check_displace(const Cell* c, int x, int) const {return std::abs(x-c->gx) <= max_disp_x;}
+	cost_type calc_cost(const Cell* c, int row, int site, vector<list<Cell*>::iterator> const& vItNode, unsigned int swap_cnt) const
+	{
+		cost_type cost;
+		cost.cost = std::abs(site-c->gx)+4*std::abs(row-c->grow)+100*swap_cnt;
+		cost.row = row;
+		cost.site = site;
+		cost.vItNode = vItNode;
+		return cost;
+	}
+	bool check_valid(cost_type const& c) const {return c.row >= 0;}
+	void apply(Cell* c, cost_type const& cost, list<Cell*>& vFailNode, int swap_cnt) const
+	{
+		list<Cell*>& vCell = (*pRowCell)[cost.row];
+		for (int i = 0; i < swap_cnt; ++i)
+		{
+			Cell* pSwap = *cost.vItNode[i];
+			pSwap->x = pSwap->row = -1;
+			vFailNode.push_back(pSwap);
+			vCell.erase(cost.vItNode[i]);
+		}
+		c->x = cost.site;
+		c->row = cost.row;
+		vCell.insert(cost.vItNode.back(), c);
+	}
+	Row* row(size_t row_idx) const {return &(*pRow)[row_idx];}
+	int site_xl(const Row* r) const {return r->xl;}
+	int site_xh(const Row* r) const {return r->xh;}
+	double desired_x(const Cell* c) const {return c->gx;}
+	double row_cost(const Cell* c, size_t row_idx) const {return 16.0*((int)row_idx-c->grow)*((int)row_idx-c->grow);}
+	void place(Cell* c, size_t row_idx, int site) const
+	{
+		c->x = site;
+		c->row = row_idx;
+	}
+	/// @endnowarn
+};
+
+/// a random global placement, with fixed blocks in rows and all other cells to legalize
+struct Placement
+{
+	vector<Row> vRow; ///< rows
+	vector<Cell> vCell; ///< movable cells, fixed blocks, and one zero width cell per row
+	vector<list<Cell*> > vRowCell; ///< cells in each row
+	int numMovable; ///< number of movable cells
+
+	/// constructor
+	/// @param numRows number of rows
+	/// @param numSites number of sites in a row
+	/// @param numCells number of movable cells
+	/// @param seed random seed
+	Placement(int numRows, int numSites, int numCells, unsigned int seed) : numMovable(numCells)
+	{
+		srand(seed);
+		vRow.assign(numRows, Row());
+		for (int i = 0; i < numRows; ++i)
+		{
+			vRow[i].xl = 0;
+			vRow[i].xh = numSites;
+		}
+		vCell.assign(numCells+2*numRows, Cell());
+		vRowCell.assign(numRows, list<Cell*>());
+		for (int i = 0; i < numCells; ++i)
+		{
+			Cell& c = vCell[i];
+			c.id = i;
+			c.width = 1+rand()%4;
+			c.grow = rand()%numRows;
+			// cells crowd in the middle
+			c.gx = (rand()%(numSites-c.width+1)+rand()%(numSites-c.width+1))/2;
+			c.x = c.row = -1;
+		}
+		for (int i = 0; i < numRows; ++i)
+		{
+			// a fixed block in each row, and the end of the row
+			Cell& b = vCell[numCells+i];
+			b.id = numCells+i;
+			b.width = 5+rand()%10;
+			b.x = b.gx = rand()%(numSites-b.width);
+			b.row = b.grow = i;
+			vRowCell[i].push_back(&b);
+			Cell& c = vCell[numCells+numRows+i];
+			c.id = numCells+numRows+i;
+			c.width = 0;
+			c.x = c.gx = numSites;
+			c.row = c.grow = i;
+			vRowCell[i].push_back(&c);
+		}
+	}
+	/// @return true if no cells overlap and cells stay in rows
+	bool legal() const
+	{
+		for (unsigned int i = 0; i < vRowCell.size(); ++i)
+		{
+			int xh = vRow[i].xl;
+			for (list<Cell*>::const_iterator it = vRowCell[i].begin(); it != vRowCell[i].end(); ++it)
+			{
+				if ((*it)->x < xh || (*it)->row != (int)i) return false;
+				xh = (*it)->x+(*it)->width;
+			}
+			if (xh > vRow[i].xh) return false;
+		}
+		return true;
+	}
+	/// @return true if every movable cell is placed in a row
+	bool complete() const
+	{
+		std::size_t count = 0;
+		for (unsigned int i = 0; i < vRowCell.size(); ++i)
+			count += vRowCell[i].size();
+		return count == vCell.size();
+	}
+	/// @return total displacement of movable cells in sites, a row counted as 4 sites
+	long displacement() const
+	{
+		long disp = 0;
+		for (int i = 0; i < numMovable; ++i)
+			disp += std::abs(vCell[i].x-vCell[i].gx)+4*std::abs(vCell[i].row-vCell[i].grow);
+		return disp;
+	}
+	/// @return sites and rows of all cells
+	vector<pair<int, int> > positions() const
+	{
+		vector<pair<int, int> > vPos;
+		for (unsigned int i = 0; i < vCell.size(); ++i)
+			vPos.push_back(pair<int, int>(vCell[i].x, vCell[i].row));
+		return vPos;
+	}
+};
+
+/// result of a legalization
+struct Result
+{
+	vector<pair<int, int> > vPos; ///< positions of cells after the legalizer
+	int numFail; ///< failed cells of the legalizer
+	int numLeft; ///< failed cells after the fallback
+	long disp; ///< total displacement after the fallback
+	bool legal; ///< no overlap after the legalizer and after the fallback
+};
+
+/// legalize a placement with AbacusLegalizer, and failed cells with GreedySearch
+/// @param mode legalization mode
+/// @param bandRows number of rows of a band
+/// @param numThreads number of threads
+/// @return result
+Result legalize(limbo::algorithms::placement::AbacusLegalizer<Callback>::mode_type mode, int bandRows, int numThreads)
+{
+	Placement pl (40, 200, 2400, 7);
+	Callback cbk;
+	cbk.pRow = &pl.vRow;
+	cbk.pRowCell = &pl.vRowCell;
+	cbk.max_disp_x = 30;
+	cbk.max_disp_row = 2;
+	vector<Cell*> vNode;
+	for (int i = 0; i < pl.numMovable; ++i)
+		vNode.push_back(&pl.vCell[i]);
+	list<Cell*> vFailNode;
+	limbo::algorithms::placement::AbacusLegalizer<Callback> legalizer (cbk);
+	legalizer.set_mode(mode);
+	legalizer.set_band_rows(bandRows);
+	legalizer.set_num_threads(numThreads);
+	Result res;
+	res.numFail = legalizer(vNode.begin(), vNode.end(), vFailNode);
+	res.vPos = pl.positions();
+	res.legal = pl.legal() && res.numFail == (int)vFailNode.size();
+	limbo::algorithms::placement::GreedySearch<Callback> gs (cbk);
+	gs(vFailNode, 2);
+	res.numLeft = vFailNode.size();
+	res.legal = res.legal && pl.legal() && (res.numLeft > 0 || pl.complete());
+	res.disp = pl.displacement();
+	return res;
+}
+
+/// legalize a placement with GreedySearch only
+/// @param numLeft failed cells
+/// @return true if the placement is legal
+bool greedy(int& numLeft)
+{
+	Placement pl (40, 200, 2400, 7);
+	Callback cbk;
+	cbk.pRow = &pl.vRow;
+	cbk.pRowCell = &pl.vRowCell;
+	cbk.max_disp_x = 30;
+	cbk.max_disp_row = 2;
+	list<Cell*> vFailNode;
+	for (int i = 0; i < pl.numMovable; ++i)
+		vFailNode.push_back(&pl.vCell[i]);
+	limbo::algorithms::placement::GreedySearch<Callback> gs (cbk);
+	gs(vFailNode, 2);
+	numLeft = vFailNode.size();
+	return pl.legal();
+}
+
+/// main function \n
+/// verify legality, independence of the number of threads, and fewer failed cells than GreedySearch alone
+/// @return 0 if all tests pass
+int main()
+{
+	typedef limbo::algorithms::placement::AbacusLegalizer<Callback> legalizer_type;
+	bool pass = true;
+	clock_t t0 = clock();
+	Result abacus = legalize(legalizer_type::ABACUS, 0, 1);
+	clock_t t1 = clock();
+	Result band1 = legalize(legalizer_type::ABACUS, 8, 1);
+	Result band4 = legalize(legalizer_type::ABACUS, 8, 4);
+	Result tetris = legalize(legalizer_type::TETRIS, 8, 4);
+	int numLeftGS;
+	pass = greedy(numLeftGS) && pass;
+
+	cout << "Abacus: " << abacus.numFail << " failed cells, displacement " << abacus.disp
+		<< " in " << (double)(t1-t0)/CLOCKS_PER_SEC << " s" << endl;
+	cout << "Abacus by bands: " << band4.numFail << " failed cells, displacement " << band4.disp << endl;
+	cout << "Tetris by bands: " << tetris.numFail << " failed cells, displacement " << tetris.disp << endl;
+	cout << "GreedySearch only: " << numLeftGS << " failed cells" << endl;
+	pass = abacus.legal && band1.legal && band4.legal && tetris.legal && pass;
+	pass = (band1.vPos == band4.vPos && band1.numFail == band4.numFail && band1.disp == band4.disp) && pass;
+	pass = (abacus.numLeft == 0 && band4.numLeft == 0 && numLeftGS > 0) && pass;
+	pass = (tetris.numLeft > 0 || abacus.disp <= tetris.disp) && pass;
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
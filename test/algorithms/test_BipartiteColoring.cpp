@@ -0,0 +1,189 @@
+/**
+ * @file   test_BipartiteColoring.cpp
+ * @brief  test @ref limbo::algorithms::coloring::BipartiteColoring and two colors of exact solvers
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/BipartiteColoring.h>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef limbo::algorithms::coloring::BipartiteColoring<graph_type> bipartite_coloring_type;
+/// @endnowarn
+
+/// build a random graph on two hidden sides, with conflict edges across the sides and stitch edges within a side
+/// @param g graph
+/// @param vSide hidden side of each vertex
+/// @param m number of edges tried, duplicates are skipped
+void randomGraph(graph_type& g, std::vector<int8_t> const& vSide, uint32_t m)
+{
+	uint32_t n = vSide.size();
+	g = graph_type(n);
+	for (uint32_t i = 0; i < m; ++i)
+	{
+		uint32_t s = rand()%n;
+		uint32_t t = rand()%n;
+		if (s == t || edge(s, t, g).second)
+			continue;
+		int w = (vSide[s] == vSide[t])? -1 : 1+(rand()%4 == 0);
+		put(edge_weight, g, add_edge(s, t, g).first, w);
+	}
+}
+
+/// @param g graph
+/// @param c coloring solver
+/// @param stitchWeight weight of stitches
+/// @return cost of the coloring solution
+template <typename ColoringType>
+double calcCost(graph_type const& g, ColoringType const& c, double stitchWeight)
+{
+	double cost = 0;
+	graph_traits<graph_type>::edge_iterator ei, eie;
+	for (tie(ei, eie) = edges(g); ei != eie; ++ei)
+	{
+		int w = get(edge_weight, g, *ei);
+		bool same = (c.color(source(*ei, g)) == c.color(target(*ei, g)));
+		if (w >= 0)
+			cost += same*w;
+		else
+			cost -= (!same)*w*stitchWeight;
+	}
+	return cost;
+}
+
+/// @param g graph
+/// @param bc solver after coloring
+/// @return true if every odd cycle is a cycle of the graph with an odd number of conflict edges
+bool checkOddCycles(graph_type const& g, bipartite_coloring_type const& bc)
+{
+	for (uint32_t i = 0; i < bc.num_odd_cycles(); ++i)
+	{
+		std::vector<graph_traits<graph_type>::vertex_descriptor> vCycle;
+		bc.odd_cycle(i, vCycle);
+		uint32_t numConflicts = 0;
+		for (uint32_t k = 0; k < vCycle.size(); ++k)
+		{
+			std::pair<graph_traits<graph_type>::edge_descriptor, bool> e = edge(vCycle[k], vCycle[(k+1)%vCycle.size()], g);
+			if (!e.second)
+				return false;
+			numConflicts += (get(edge_weight, g, e.first) > 0);
+		}
+		if (numConflicts%2 == 0)
+			return false;
+	}
+	return true;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+
+	for (uint32_t i = 0; i < 300; ++i)
+	{
+		// half of the graphs get a random edge that may close an odd cycle
+		uint32_t n = 10+rand()%13;
+		std::vector<int8_t> vSide (n);
+		for (uint32_t v = 0; v < n; ++v)
+			vSide[v] = rand()%2;
+		graph_type g;
+		randomGraph(g, vSide, n*(1+rand()%3));
+		bool extra = (i%2 == 1);
+		if (extra)
+		{
+			uint32_t s = rand()%n;
+			uint32_t t = (s+1+rand()%(n-1))%n;
+			if (!edge(s, t, g).second)
+				put(edge_weight, g, add_edge(s, t, g).first, (vSide[s] == vSide[t])? 1 : -1);
+		}
+		std::vector<int8_t> vPrecolor (n, -1);
+		if (i%3 == 0)
+			for (uint32_t k = 0; k < 2; ++k)
+			{
+				uint32_t v = rand()%n;
+				vPrecolor[v] = vSide[v];
+			}
+
+		limbo::algorithms::coloring::BacktrackColoring<graph_type> tc (g);
+		tc.color_num(2);
+		tc.stitch_weight(0.1);
+		bipartite_coloring_type bc (g);
+		bc.stitch_weight(0.1);
+		for (uint32_t v = 0; v < n; ++v)
+		{
+			if (vPrecolor[v] >= 0)
+			{
+				tc.precolor(v, vPrecolor[v]);
+				bc.precolor(v, vPrecolor[v]);
+			}
+		}
+		double cost = tc();
+		bc();
+		double bcost = calcCost(g, bc, 0.1);
+
+		// the hidden sides are a solution of cost 0 without the extra edge
+		if ((!extra && (cost != 0 || bcost != 0)) || std::abs(cost-calcCost(g, tc, 0.1)) > 1e-6 || bcost < cost-1e-6)
+		{
+			cout << "graph " << i << ": cost " << bcost << " by bipartite coloring, " << cost << " by backtracking" << endl;
+			return 1;
+		}
+		if (bc.bipartite() != (cost == 0) || (cost == 0 && bcost != 0) || !checkOddCycles(g, bc))
+		{
+			cout << "graph " << i << ": wrong odd cycles or bipartite flag" << endl;
+			return 1;
+		}
+		for (uint32_t v = 0; v < n; ++v)
+		{
+			if (bc.color(v) < 0 || bc.color(v) >= 2 || (vPrecolor[v] >= 0 && bc.color(v) != vPrecolor[v])
+					|| tc.color(v) < 0 || tc.color(v) >= 2 || (vPrecolor[v] >= 0 && tc.color(v) != vPrecolor[v]))
+			{
+				cout << "graph " << i << ": wrong color of vertex " << v << endl;
+				return 1;
+			}
+		}
+	}
+
+	// a large bipartite graph is colored in linear time, and a triangle closed by stitch edges through it is found as an odd cycle
+	{
+		uint32_t n = 1000000;
+		std::vector<int8_t> vSide (n);
+		for (uint32_t v = 0; v < n; ++v)
+			vSide[v] = rand()%2;
+		graph_type g;
+		randomGraph(g, vSide, 2*n);
+		clock_t start = clock();
+		bipartite_coloring_type bc (g);
+		bc.stitch_weight(0.1);
+		bc();
+		double cost = calcCost(g, bc, 0.1);
+		cout << "\n" << n << " vertices, " << num_edges(g) << " edges: cost " << cost << " in " << double(clock()-start)/CLOCKS_PER_SEC << " s" << endl;
+		if (cost != 0 || !bc.bipartite() || bc.num_odd_cycles() != 0)
+			return 1;
+		for (uint32_t k = 0; k < 3; ++k)
+			add_vertex(g);
+		put(edge_weight, g, add_edge(n, n+1, g).first, 1);
+		put(edge_weight, g, add_edge(n+1, n+2, g).first, -1);
+		put(edge_weight, g, add_edge(n+2, 0, g).first, -1);
+		put(edge_weight, g, add_edge(0, n, g).first, -1);
+		bipartite_coloring_type oc (g);
+		oc.stitch_weight(0.1);
+		oc();
+		if (calcCost(g, oc, 0.1) == 0 || oc.bipartite() || oc.num_odd_cycles() != 1 || !checkOddCycles(g, oc))
+			return 1;
+	}
+	return 0;
+}
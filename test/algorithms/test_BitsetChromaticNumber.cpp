@@ -0,0 +1,135 @@
+/**
+ * @file   test_BitsetChromaticNumber.cpp
+ * @brief  test @ref limbo::algorithms::coloring::BitsetChromaticNumber against backtracking
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/ChromaticNumber.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t>,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+/// @endnowarn
+
+/// generate a random graph
+/// @param g graph
+/// @param n number of vertices
+/// @param percent probability of each edge in percent
+template <typename G>
+void randomGraph(G& g, uint32_t n, uint32_t percent)
+{
+	for (uint32_t v = 0; v < n; ++v)
+		add_vertex(g);
+	for (uint32_t s = 0; s < n; ++s)
+		for (uint32_t t = s+1; t < n; ++t)
+			if ((uint32_t)rand()%100 < percent)
+				add_edge(s, t, g);
+}
+
+/// @param vAdj adjacency masks
+/// @param vColor colors of vertices before \a v
+/// @param v next vertex
+/// @param k number of colors
+/// @return true if the remaining vertices can be colored
+bool colorable(std::vector<uint32_t> const& vAdj, std::vector<int>& vColor, uint32_t v, int k)
+{
+	if (v == vAdj.size())
+		return true;
+	for (int c = 0; c < k; ++c)
+	{
+		bool ok = true;
+		for (uint32_t u = 0; u < v && ok; ++u)
+			ok = !((vAdj[v]>>u)&1) || vColor[u] != c;
+		if (ok)
+		{
+			vColor[v] = c;
+			if (colorable(vAdj, vColor, v+1, k))
+				return true;
+		}
+	}
+	return false;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+	limbo::algorithms::coloring::BitsetChromaticNumber<graph_type> bcn;
+
+	// Groetzsch graph, the Mycielskian of a 5-cycle, is triangle free with chromatic number 4
+	graph_type mycielski (11);
+	for (uint32_t i = 0; i < 5; ++i)
+	{
+		add_edge(i, (i+1)%5, mycielski);
+		add_edge(i, 5+(i+1)%5, mycielski);
+		add_edge(i, 5+(i+4)%5, mycielski);
+		add_edge(5+i, 10, mycielski);
+	}
+	graph_type complete (7);
+	for (uint32_t s = 0; s < 7; ++s)
+		for (uint32_t t = s+1; t < 7; ++t)
+			add_edge(s, t, complete);
+	graph_type cycle (9);
+	for (uint32_t i = 0; i < 9; ++i)
+		add_edge(i, (i+1)%9, cycle);
+	if (bcn(mycielski) != 4 || bcn(complete) != 7 || bcn(cycle) != 3 || bcn(graph_type(5)) != 1 || bcn(graph_type()) != 0)
+	{
+		cout << "wrong chromatic number of known graphs" << endl;
+		return 1;
+	}
+
+	// random graphs against backtracking, with the table split for larger graphs
+	limbo::algorithms::coloring::BitsetChromaticNumber<graph_type> split;
+	split.table_bits(6);
+	split.threads(4);
+	for (uint32_t i = 0; i < 40; ++i)
+	{
+		uint32_t n = 4+rand()%10;
+		uint32_t percent = 20+rand()%60;
+		graph_type g;
+		randomGraph(g, n, percent);
+		std::vector<uint32_t> vAdj (n, 0);
+		graph_traits<graph_type>::edge_iterator ei, eie;
+		for (boost::tie(ei, eie) = edges(g); ei != eie; ++ei)
+		{
+			vAdj[source(*ei, g)] |= 1u<<target(*ei, g);
+			vAdj[target(*ei, g)] |= 1u<<source(*ei, g);
+		}
+		std::vector<int> vColor (n);
+		int expected = 1;
+		while (!colorable(vAdj, vColor, 0, expected))
+			++expected;
+		if (bcn(g) != expected || split(g) != expected)
+		{
+			cout << "graph " << i << " of " << n << " vertices: " << bcn(g) << " and " << split(g)
+				<< ", expected " << expected << endl;
+			return 1;
+		}
+	}
+
+	// a graph too large for LawlerChromaticNumber, also counted with the table split
+	graph_type g;
+	randomGraph(g, 26, 50);
+	limbo::algorithms::coloring::BitsetChromaticNumber<graph_type> large;
+	large.threads(4);
+	clock_t start = clock();
+	int cn = large(g);
+	double t = double(clock()-start)/CLOCKS_PER_SEC;
+	split.table_bits(20);
+	int splitCn = split(g);
+	cout << "chromatic number of 26 vertices = " << cn << " in " << t << " s" << endl;
+	if (cn != splitCn || cn < 2)
+		return 1;
+	return 0;
+}
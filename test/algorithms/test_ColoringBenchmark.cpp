@@ -0,0 +1,387 @@
+/**
+ * @file   test_ColoringBenchmark.cpp
+ * @brief  benchmark coloring algorithms on synthetic or input conflict graphs and report CSV
+ *
+ * Every algorithm colors components of the simplified graph larger than 20 vertices
+ * in @ref limbo::algorithms::coloring::ComponentColoring,
+ * while smaller ones are colored by @ref limbo::algorithms::coloring::BitsetColoring,
+ * so phases of simplification, solving and recovery are timed in the same way.
+ *
+ * Usage: test_ColoringBenchmark [options]
+ * - -input file.gv: conflict graph in graphviz format as test/algorithms/benchmarks, instead of a synthetic one;
+ *   files ending with .lcg are read as binary snapshots of @ref limbo::algorithms::coloring::GraphSnapshot
+ * - -vertices n: number of vertices of the synthetic graph, 2000 by default
+ * - -degree d: average degree, 4 by default
+ * - -stitch r: ratio of stitch edges, 0.1 by default
+ * - -component min max: range of component sizes, 20 to 500 by default
+ * - -powerlaw: draw component sizes from a power law instead of a uniform distribution
+ * - -colors list: numbers of colors separated by commas, 3,4 by default
+ * - -algorithms list: names separated by commas, all available ones by default
+ * - -max_exact n: skip exact algorithms on graphs with components larger than n, 64 by default
+ * - -threads n: number of threads, 1 by default
+ * - -stitch_weight w: weight of stitches, 0.1 by default
+ * - -refine n: refine solutions by tabu search with n iterations without improvement, 0 (disabled) by default
+ * - -seed s: random seed, 1 by default
+ * - -csv file: output file, coloring_benchmark.csv by default, - for stdout;
+ *   solvers may print their own messages to stdout, so a file is preferred
+ *
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <time.h>
+#include <limbo/preprocessor/AssertMsg.h>
+#include <boost/graph/graphviz.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/GraphSnapshot.h>
+#include <boost/graph/connected_components.hpp>
+#include <limbo/algorithms/coloring/ComponentColoring.h>
+#include <limbo/algorithms/coloring/ColoringCost.h>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+#include <limbo/algorithms/coloring/BitsetColoring.h>
+#include <limbo/algorithms/coloring/MISColoring.h>
+#if GUROBI == 1
+#include <limbo/algorithms/coloring/ILPColoring.h>
+#include <limbo/algorithms/coloring/ILPColoringUpdated.h>
+#endif
+#if OPENBLAS == 1
+#include <limbo/algorithms/coloring/SDPColoringCsdp.h>
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, string> > graph_type;
+typedef graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
+typedef graph_traits<graph_type>::edge_descriptor edge_descriptor;
+/// @endnowarn
+
+/// MIS based coloring with heuristic independent sets
+struct MISHeuristicColoring : public limbo::algorithms::coloring::MISColoring<graph_type>
+{
+	/// constructor
+	/// @param g graph
+	MISHeuristicColoring(graph_type const& g) : limbo::algorithms::coloring::MISColoring<graph_type>(g) {this->heuristic(true);}
+};
+#if OPENBLAS == 1
+/// SDP based coloring with the low-rank solver
+struct SDPLowRankColoring : public limbo::algorithms::coloring::SDPColoringCsdp<graph_type>
+{
+	/// constructor
+	/// @param g graph
+	SDPLowRankColoring(graph_type const& g) : limbo::algorithms::coloring::SDPColoringCsdp<graph_type>(g) {this->sdp_solver(LOW_RANK);}
+};
+#endif
+
+/// options of the benchmark
+struct Options
+{
+	string input; ///< input graph, empty for a synthetic one
+	uint32_t vertices; ///< number of vertices
+	double degree; ///< average degree
+	double stitch; ///< ratio of stitch edges
+	uint32_t compMin; ///< smallest component
+	uint32_t compMax; ///< largest component
+	bool powerlaw; ///< whether component sizes follow a power law
+	std::vector<int> vColorNum; ///< numbers of colors
+	std::vector<string> vAlgorithm; ///< algorithms to run, empty for all
+	uint32_t maxExact; ///< largest component for exact algorithms
+	int32_t threads; ///< number of threads
+	double stitchWeight; ///< weight of stitches
+	uint32_t refine; ///< iterations of tabu refinement, 0 to disable
+	unsigned int seed; ///< random seed
+	string csv; ///< output file, - for stdout
+
+	/// constructor with default values
+	Options()
+		: vertices(2000), degree(4), stitch(0.1), compMin(20), compMax(500), powerlaw(false)
+		, maxExact(64), threads(1), stitchWeight(0.1), refine(0), seed(1), csv("coloring_benchmark.csv")
+	{
+		vColorNum.push_back(3);
+		vColorNum.push_back(4);
+	}
+};
+
+/// @return wall time in seconds
+double wallTime()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+
+/// @param s values separated by commas
+/// @return values
+std::vector<string> split(string const& s)
+{
+	std::vector<string> vValue;
+	std::istringstream iss (s);
+	string value;
+	while (std::getline(iss, value, ','))
+		if (!value.empty())
+			vValue.push_back(value);
+	return vValue;
+}
+
+/// add a random geometric graph as a component,
+/// vertices are placed in a square with unit density and connected within a radius for the average degree,
+/// like conflicts of features within the minimum coloring distance in a layout
+/// @param g graph
+/// @param offset first vertex of the component
+/// @param n number of vertices
+/// @param opt options
+void addComponent(graph_type& g, uint32_t offset, uint32_t n, Options const& opt)
+{
+	double side = std::sqrt((double)n);
+	double radius = std::sqrt(opt.degree/M_PI);
+	uint32_t numCells = std::max(1U, (uint32_t)std::ceil(side/radius));
+	std::vector<double> vX (n), vY (n);
+	std::vector<std::vector<uint32_t> > mCell (numCells*numCells);
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		vX[i] = side*rand()/RAND_MAX;
+		vY[i] = side*rand()/RAND_MAX;
+		uint32_t cx = std::min((uint32_t)(vX[i]/radius), numCells-1);
+		uint32_t cy = std::min((uint32_t)(vY[i]/radius), numCells-1);
+		mCell[cx*numCells+cy].push_back(i);
+	}
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		int32_t cx = std::min((uint32_t)(vX[i]/radius), numCells-1);
+		int32_t cy = std::min((uint32_t)(vY[i]/radius), numCells-1);
+		for (int32_t x = std::max(cx-1, 0); x <= std::min(cx+1, (int32_t)numCells-1); ++x)
+			for (int32_t y = std::max(cy-1, 0); y <= std::min(cy+1, (int32_t)numCells-1); ++y)
+			{
+				std::vector<uint32_t> const& vCell = mCell[x*numCells+y];
+				for (std::vector<uint32_t>::const_iterator it = vCell.begin(); it != vCell.end(); ++it)
+				{
+					uint32_t j = *it;
+					double dx = vX[i]-vX[j];
+					double dy = vY[i]-vY[j];
+					if (j > i && dx*dx+dy*dy < radius*radius)
+						put(edge_weight, g, add_edge(offset+i, offset+j, g).first, ((double)rand()/RAND_MAX < opt.stitch)? -1 : 1);
+				}
+			}
+	}
+}
+
+/// generate a graph of components with sizes in a range
+/// @param g graph
+/// @param opt options
+void syntheticGraph(graph_type& g, Options const& opt)
+{
+	std::vector<uint32_t> vSize;
+	uint32_t total = 0;
+	while (total < opt.vertices)
+	{
+		double u = (double)rand()/RAND_MAX;
+		uint32_t size = opt.compMin;
+		if (opt.powerlaw) // Pareto distribution with exponent 2.5
+			size = std::min((double)opt.compMax, opt.compMin*std::pow(1-u*0.999, -1/1.5));
+		else
+			size = opt.compMin+u*(opt.compMax-opt.compMin);
+		size = std::max(1U, std::min(size, opt.vertices-total));
+		vSize.push_back(size);
+		total += size;
+	}
+	g = graph_type(total);
+	for (uint32_t i = 0, offset = 0; i < vSize.size(); offset += vSize[i], ++i)
+		addComponent(g, offset, vSize[i], opt);
+}
+
+/// read a graph in graphviz format as test/algorithms/benchmarks, or a binary snapshot ending with .lcg
+/// @param g graph
+/// @param filename input file
+void readGraph(graph_type& g, string const& filename)
+{
+	if (filename.size() > 4 && filename.compare(filename.size()-4, 4, ".lcg") == 0)
+	{
+		limbo::algorithms::coloring::GraphSnapshot snapshot;
+		limboAssertMsg(snapshot.open(filename), "failed to open snapshot %s", filename.c_str());
+		snapshot.graph(g);
+		return;
+	}
+
+	std::ifstream in (filename.c_str());
+	limboAssertMsg(in.good(), "failed to open %s", filename.c_str());
+
+	// the graphviz reader in boost cannot specify vertex_index_t
+	// I have to create a temporary graph and then construct the real graph
+	typedef adjacency_list<vecS, vecS, undirectedS,
+			property<vertex_index_t, std::size_t, property<vertex_color_t, int, property<vertex_name_t, std::size_t> > >,
+			property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+			property<graph_name_t, string> > tmp_graph_type;
+	tmp_graph_type tmpg;
+	dynamic_properties tmpdp;
+	tmpdp.property("node_id", get(vertex_name, tmpg));
+	tmpdp.property("label", get(vertex_name, tmpg));
+	tmpdp.property("weight", get(edge_weight, tmpg));
+	tmpdp.property("label", get(edge_weight, tmpg));
+	limboAssert(read_graphviz(in, tmpg, tmpdp, "node_id"));
+
+	g = graph_type(num_vertices(tmpg));
+	graph_traits<tmp_graph_type>::edge_iterator eit, eit_end;
+	for (tie(eit, eit_end) = edges(tmpg); eit != eit_end; ++eit)
+	{
+		size_t s = get(vertex_name, tmpg, source(*eit, tmpg));
+		size_t t = get(vertex_name, tmpg, target(*eit, tmpg));
+		std::pair<edge_descriptor, bool> pe = add_edge(s, t, g);
+		put(edge_weight, g, pe.first, get(edge_weight, tmpg, *eit));
+	}
+	in.close();
+}
+
+/// @param g graph
+/// @return size of the largest connected component
+uint32_t maxComponentSize(graph_type const& g)
+{
+	std::vector<uint32_t> vComponent (num_vertices(g));
+	uint32_t numComps = connected_components(g, &vComponent[0]);
+	std::vector<uint32_t> vSize (numComps, 0);
+	for (uint32_t i = 0; i < vComponent.size(); ++i)
+		++vSize[vComponent[i]];
+	return (numComps)? *std::max_element(vSize.begin(), vSize.end()) : 0;
+}
+
+/// run an algorithm and write a line of CSV
+/// @tparam LargeColoringType solver for components larger than 20 vertices
+/// @param name name of the algorithm
+/// @param graphName name of the graph
+/// @param g graph
+/// @param colorNum number of colors
+/// @param opt options
+/// @param out output stream
+template <typename LargeColoringType>
+void run(string const& name, string const& graphName, graph_type const& g, int colorNum, Options const& opt, std::ostream& out)
+{
+	if (!opt.vAlgorithm.empty() && std::find(opt.vAlgorithm.begin(), opt.vAlgorithm.end(), name) == opt.vAlgorithm.end())
+		return;
+	cerr << "running " << name << " with " << colorNum << " colors" << endl;
+
+	typedef limbo::algorithms::coloring::ComponentColoring<graph_type, limbo::algorithms::coloring::BitsetColoring<graph_type>, LargeColoringType> coloring_type;
+	coloring_type cc (g);
+	cc.color_num((int8_t)colorNum);
+	cc.stitch_weight(opt.stitchWeight);
+	cc.threads(opt.threads);
+	cc.refine_iterations(opt.refine);
+	cc.collect_statistics(true);
+	double start = wallTime();
+	cc();
+	double runtime = wallTime()-start;
+	limbo::algorithms::coloring::ColoringStatistics const& stat = cc.statistics();
+
+	std::vector<int8_t> vColor (num_vertices(g));
+	for (uint32_t v = 0; v < vColor.size(); ++v)
+		vColor[v] = cc.color(v);
+	limbo::algorithms::coloring::ColoringCost<graph_type> evaluator (g, opt.stitchWeight);
+	evaluator.threads(opt.threads);
+	limbo::algorithms::coloring::ColoringCost<graph_type>::result_type result = evaluator.evaluate(vColor);
+
+	out << graphName << "," << num_vertices(g) << "," << num_edges(g) << "," << colorNum << "," << name << "," << opt.threads
+		<< "," << runtime << "," << result.cost << "," << result.conflicts << "," << result.stitches
+		<< "," << stat.stitch_time << "," << stat.simplify_time << "," << stat.solve_time << "," << stat.recover_time << "," << stat.refine_time
+		<< "," << cc.num_small_components() << "," << cc.num_large_components() << "," << stat.num_merged_vertices << "," << stat.num_hidden_vertices
+		<< "," << stat.num_variables << "," << stat.num_constraints << "," << stat.num_iterations << endl;
+}
+
+/// main function
+/// @param argc number of arguments
+/// @param argv values of arguments
+/// @return 0 if succeed
+int main(int argc, char** argv)
+{
+	Options opt;
+	for (int i = 1; i < argc; ++i)
+	{
+		string arg = argv[i];
+		bool hasValue = (i+1 < argc);
+		if (arg == "-input" && hasValue) opt.input = argv[++i];
+		else if (arg == "-vertices" && hasValue) opt.vertices = atoi(argv[++i]);
+		else if (arg == "-degree" && hasValue) opt.degree = atof(argv[++i]);
+		else if (arg == "-stitch" && hasValue) opt.stitch = atof(argv[++i]);
+		else if (arg == "-component" && i+2 < argc)
+		{
+			opt.compMin = atoi(argv[++i]);
+			opt.compMax = atoi(argv[++i]);
+		}
+		else if (arg == "-powerlaw") opt.powerlaw = true;
+		else if (arg == "-colors" && hasValue)
+		{
+			std::vector<string> vValue = split(argv[++i]);
+			opt.vColorNum.clear();
+			for (uint32_t k = 0; k < vValue.size(); ++k)
+				opt.vColorNum.push_back(atoi(vValue[k].c_str()));
+		}
+		else if (arg == "-algorithms" && hasValue) opt.vAlgorithm = split(argv[++i]);
+		else if (arg == "-max_exact" && hasValue) opt.maxExact = atoi(argv[++i]);
+		else if (arg == "-threads" && hasValue) opt.threads = atoi(argv[++i]);
+		else if (arg == "-stitch_weight" && hasValue) opt.stitchWeight = atof(argv[++i]);
+		else if (arg == "-refine" && hasValue) opt.refine = atoi(argv[++i]);
+		else if (arg == "-seed" && hasValue) opt.seed = atoi(argv[++i]);
+		else if (arg == "-csv" && hasValue) opt.csv = argv[++i];
+		else
+		{
+			cerr << "unknown option " << arg << ", see the file header of test_ColoringBenchmark.cpp" << endl;
+			return 1;
+		}
+	}
+	limboAssertMsg(opt.compMin > 0 && opt.compMin <= opt.compMax, "invalid range of component sizes");
+
+	srand(opt.seed);
+	graph_type g;
+	string graphName;
+	if (opt.input.empty())
+	{
+		syntheticGraph(g, opt);
+		std::ostringstream oss;
+		oss << "synthetic-" << opt.vertices << "-" << opt.degree << "-" << opt.stitch << "-" << opt.compMin << "-" << opt.compMax << (opt.powerlaw? "-powerlaw" : "");
+		graphName = oss.str();
+	}
+	else
+	{
+		readGraph(g, opt.input);
+		graphName = opt.input.substr(opt.input.find_last_of('/')+1);
+	}
+	bool exact = (maxComponentSize(g) <= opt.maxExact);
+
+	std::ofstream fout;
+	if (opt.csv != "-")
+		fout.open(opt.csv.c_str());
+	std::ostream& out = (opt.csv == "-")? cout : fout;
+	out << "graph,vertices,edges,colors,algorithm,threads,runtime,cost,conflicts,stitches,stitch_time,simplify_time,solve_time,recover_time,refine_time,small_components,large_components,merged_vertices,hidden_vertices,variables,constraints,iterations" << endl;
+	for (uint32_t i = 0; i < opt.vColorNum.size(); ++i)
+	{
+		int colorNum = opt.vColorNum[i];
+		if (exact)
+		{
+			run<limbo::algorithms::coloring::BacktrackColoring<graph_type> >("backtrack", graphName, g, colorNum, opt, out);
+			run<limbo::algorithms::coloring::BitsetColoring<graph_type> >("bitset", graphName, g, colorNum, opt, out);
+		}
+		run<limbo::algorithms::coloring::MISColoring<graph_type> >("mis", graphName, g, colorNum, opt, out);
+		run<MISHeuristicColoring>("mis-heuristic", graphName, g, colorNum, opt, out);
+#if GUROBI == 1
+		run<limbo::algorithms::coloring::ILPColoring<graph_type> >("ilp", graphName, g, colorNum, opt, out);
+		run<limbo::algorithms::coloring::ILPColoringUpdated<graph_type> >("ilp-updated", graphName, g, colorNum, opt, out);
+#endif
+#if OPENBLAS == 1
+		run<limbo::algorithms::coloring::SDPColoringCsdp<graph_type> >("sdp", graphName, g, colorNum, opt, out);
+		run<SDPLowRankColoring>("sdp-lowrank", graphName, g, colorNum, opt, out);
+#endif
+	}
+	if (!exact)
+		cerr << "exact algorithms are skipped for components larger than " << opt.maxExact << endl;
+	return 0;
+}
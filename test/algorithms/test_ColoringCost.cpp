@@ -0,0 +1,95 @@
+/**
+ * @file   test_ColoringCost.cpp
+ * @brief  test @ref limbo::algorithms::coloring::ColoringCost against a walk over graph edges
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/ColoringCost.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef limbo::algorithms::coloring::ColoringCost<graph_type> cost_type;
+/// @endnowarn
+
+/// cost in the same way as @ref limbo::algorithms::coloring::Coloring::calc_cost
+/// @param g graph
+/// @param vColor coloring solution
+/// @param stitchWeight weight of stitches
+/// @return cost
+double walkCost(graph_type const& g, std::vector<int8_t> const& vColor, double stitchWeight)
+{
+	double cost = 0;
+	graph_traits<graph_type>::edge_iterator ei, eie;
+	for (tie(ei, eie) = edges(g); ei != eie; ++ei)
+	{
+		int w = get(edge_weight, g, *ei);
+		bool same = (vColor[source(*ei, g)] == vColor[target(*ei, g)]);
+		if (source(*ei, g) == target(*ei, g))
+			continue;
+		if (w >= 0)
+			cost += same*w;
+		else
+			cost -= (!same)*w*stitchWeight;
+	}
+	return cost;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+	uint32_t numVertices = 200000;
+	double stitchWeight = 0.1;
+	graph_type g (numVertices);
+	for (uint32_t i = 0; i < numVertices*5; ++i)
+	{
+		uint32_t s = rand()%numVertices;
+		uint32_t t = rand()%numVertices;
+		put(edge_weight, g, add_edge(s, t, g).first, (rand()%10 == 0)? -1 : 1+rand()%2);
+	}
+	std::vector<int8_t> vColor (numVertices);
+	for (uint32_t v = 0; v < numVertices; ++v)
+		vColor[v] = rand()%3;
+
+	clock_t start = clock();
+	double expected = walkCost(g, vColor, stitchWeight);
+	double walkTime = double(clock()-start)/CLOCKS_PER_SEC;
+
+	cost_type cc (g, stitchWeight);
+	start = clock();
+	cost_type::result_type result = cc.evaluate(vColor);
+	double flatTime = double(clock()-start)/CLOCKS_PER_SEC;
+	cc.threads(4);
+	cost_type::result_type parallel = cc.evaluate(vColor);
+	cout << "cost = " << result.cost << " with " << result.conflicts << " conflicts and " << result.stitches << " stitches in " << flatTime 
+		<< " s, " << expected << " by walking edges in " << walkTime << " s" << endl;
+	if (std::abs(result.cost-expected) > 1e-6*expected || parallel.cost != result.cost 
+			|| parallel.conflicts != result.conflicts || parallel.stitches != result.stitches)
+		return 1;
+
+	// delta cost of recoloring single vertices matches the whole cost
+	double cost = result.cost;
+	for (uint32_t i = 0; i < 1000; ++i)
+	{
+		uint32_t v = rand()%numVertices;
+		cost += cc.recolor(vColor, v, rand()%3);
+	}
+	expected = cc(vColor);
+	cout << "cost after recoloring = " << cost << ", evaluated " << expected << endl;
+	if (std::abs(cost-expected) > 1e-6*expected)
+		return 1;
+	return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file   test_ComponentCache.cpp
+ * @brief  test canonical forms of @ref limbo::algorithms::coloring::ComponentCache and its use in component coloring
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/ComponentColoring.h>
+#include <limbo/algorithms/coloring/ComponentCache.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
+typedef limbo::algorithms::coloring::ComponentCache<graph_type> cache_type;
+/// @endnowarn
+
+/// edge of a pattern
+struct PatternEdge
+{
+	uint32_t s; ///< source
+	uint32_t t; ///< target
+	int w; ///< weight
+};
+
+/// build a random pattern with a K4 so that it survives simplification
+/// @param n number of vertices, at least 4
+/// @param vEdge edges
+void randomPattern(uint32_t n, std::vector<PatternEdge>& vEdge)
+{
+	vEdge.clear();
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		for (uint32_t j = i+1; j < n; ++j)
+		{
+			if (j < 4 || rand()%3 == 0)
+			{
+				PatternEdge e = {i, j, (rand()%6 == 0)? -1 : 1};
+				vEdge.push_back(e);
+			}
+		}
+	}
+}
+
+/// add a copy of a pattern with randomly permuted vertices
+/// @param g graph
+/// @param offset first vertex of the copy
+/// @param n number of vertices of the pattern
+/// @param vEdge edges of the pattern
+void addPattern(graph_type& g, uint32_t offset, uint32_t n, std::vector<PatternEdge> const& vEdge)
+{
+	std::vector<uint32_t> vPerm (n);
+	for (uint32_t i = 0; i < n; ++i)
+		vPerm[i] = i;
+	for (uint32_t i = n; i > 1; --i)
+		std::swap(vPerm[i-1], vPerm[rand()%i]);
+	for (uint32_t i = 0; i < vEdge.size(); ++i)
+		put(edge_weight, g, add_edge(offset+vPerm[vEdge[i].s], offset+vPerm[vEdge[i].t], g).first, vEdge[i].w);
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+
+	// permuted copies of a graph must have the same canonical form
+	for (uint32_t i = 0; i < 50; ++i)
+	{
+		uint32_t n = 4+rand()%10;
+		std::vector<PatternEdge> vEdge;
+		randomPattern(n, vEdge);
+		graph_type g1 (n), g2 (n);
+		addPattern(g1, 0, n, vEdge);
+		addPattern(g2, 0, n, vEdge);
+		std::vector<int8_t> vPrecolor (n, -1);
+		cache_type cache;
+		cache_type::key_type key1, key2;
+		std::vector<uint32_t> vLabel1, vLabel2;
+		cache.canonical_form(g1, vPrecolor, key1, vLabel1);
+		cache.canonical_form(g2, vPrecolor, key2, vLabel2);
+		if (key1 < key2 || key2 < key1)
+		{
+			cout << "pattern " << i << ": canonical forms of permuted copies differ" << endl;
+			return 1;
+		}
+	}
+
+	// a graph repeating a few patterns, neighboring copies are connected by single edges
+	uint32_t numPatterns = 5;
+	uint32_t numCopies = 400;
+	std::vector<std::vector<PatternEdge> > mPattern (numPatterns);
+	std::vector<uint32_t> vSize (numPatterns);
+	for (uint32_t p = 0; p < numPatterns; ++p)
+	{
+		vSize[p] = 6+rand()%6;
+		randomPattern(vSize[p], mPattern[p]);
+	}
+	std::vector<uint32_t> vBegin (1, 0);
+	std::vector<uint32_t> vPattern;
+	for (uint32_t c = 0; c < numCopies; ++c)
+	{
+		vPattern.push_back(rand()%numPatterns);
+		vBegin.push_back(vBegin.back()+vSize[vPattern.back()]);
+	}
+	graph_type g (vBegin.back());
+	for (uint32_t c = 0; c < numCopies; ++c)
+	{
+		addPattern(g, vBegin[c], vSize[vPattern[c]], mPattern[vPattern[c]]);
+		if (c > 0)
+			put(edge_weight, g, add_edge(vBegin[c]-1, vBegin[c], g).first, 1);
+	}
+
+	typedef limbo::algorithms::coloring::ComponentColoring<graph_type> coloring_type;
+	coloring_type ref (g);
+	ref.color_num(coloring_type::THREE);
+	ref.threads(4);
+	double refCost = ref();
+
+	coloring_type cc (g);
+	cc.color_num(coloring_type::THREE);
+	cc.threads(4);
+	cc.cache_size(100);
+	double cost = cc();
+	cout << "\ncost = " << cost << " with cache, " << refCost << " without cache, "
+		<< cc.num_cached_components() << " components from the cache, "
+		<< cc.num_small_components()+cc.num_large_components() << " components solved" << endl;
+	if (std::abs(cost-refCost) > 1e-6 || cc.num_cached_components() == 0 || cc.cache().size() > 100)
+		return 1;
+	for (uint32_t v = 0; v < num_vertices(g); ++v)
+	{
+		if (cc.color(v) < 0 || cc.color(v) >= 3)
+		{
+			cout << "vertex " << v << " is not colored" << endl;
+			return 1;
+		}
+	}
+	return 0;
+}
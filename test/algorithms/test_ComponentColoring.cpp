@@ -0,0 +1,279 @@
+/**
+ * @file   test_ComponentColoring.cpp
+ * @brief  test coloring components in parallel @ref limbo::algorithms::coloring::ComponentColoring
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/ComponentColoring.h>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
+typedef graph_traits<graph_type>::edge_descriptor edge_descriptor;
+/// @endnowarn
+
+/// add a conflict edge
+/// @param g graph
+/// @param s, t vertices
+void addEdge(graph_type& g, vertex_descriptor s, vertex_descriptor t)
+{
+	if (s == t || edge(s, t, g).second)
+		return;
+	std::pair<edge_descriptor, bool> e = add_edge(s, t, g);
+	put(edge_weight, g, e.first, 1);
+}
+
+/// build a graph of clusters, each a random graph with a K4 so that it survives simplification,
+/// and connect neighboring clusters by single edges so that biconnected components are split at articulation points
+/// @param g graph
+/// @param numClusters number of clusters
+/// @param maxClusterSize largest cluster, at least 4
+void buildGraph(graph_type& g, uint32_t numClusters, uint32_t maxClusterSize)
+{
+	srand(1);
+	std::vector<uint32_t> vBegin (1, 0);
+	for (uint32_t c = 0; c < numClusters; ++c)
+		vBegin.push_back(vBegin.back()+4+rand()%(maxClusterSize-3));
+	g = graph_type(vBegin.back());
+	for (uint32_t c = 0; c < numClusters; ++c)
+	{
+		uint32_t b = vBegin[c];
+		uint32_t n = vBegin[c+1]-b;
+		for (uint32_t i = 0; i < 4; ++i)
+			for (uint32_t j = i+1; j < 4; ++j)
+				addEdge(g, b+i, b+j);
+		for (uint32_t i = 4; i < n; ++i)
+			for (uint32_t k = 0; k < 3; ++k)
+				addEdge(g, b+i, b+rand()%i);
+		if (c > 0)
+			addEdge(g, vBegin[c-1], b);
+	}
+}
+
+/// main function
+/// @param argc number of arguments
+/// @param argv values of arguments: [number of clusters] [threads]
+/// @return 0 if succeed
+int main(int argc, char** argv)
+{
+	uint32_t numClusters = (argc > 1)? atoi(argv[1]) : 1000;
+	int32_t numThreads = (argc > 2)? atoi(argv[2]) : 4;
+
+	graph_type g;
+	buildGraph(g, numClusters, 30);
+	cout << "vertices = " << num_vertices(g) << ", edges = " << num_edges(g) << endl;
+
+	typedef limbo::algorithms::coloring::ComponentColoring<graph_type> coloring_type;
+	coloring_type cc (g);
+	cc.color_num(coloring_type::THREE);
+	cc.threads(numThreads);
+	cc.max_small_vertices(12);
+	double cost = cc();
+	cout << "\ncost = " << cost << ", small components = " << cc.num_small_components()
+		<< ", large components = " << cc.num_large_components() << endl;
+
+	// every vertex must be colored
+	graph_traits<graph_type>::vertex_iterator vi, vie;
+	for (tie(vi, vie) = vertices(g); vi != vie; ++vi)
+	{
+		if (cc.color(*vi) < 0 || cc.color(*vi) >= 3)
+		{
+			cout << "vertex " << *vi << " is not colored" << endl;
+			return 1;
+		}
+	}
+
+	// component views refer to one set of arrays and build the same graphs as components extracted one by one
+	{
+		typedef limbo::algorithms::coloring::GraphSimplification<graph_type> simplification_type;
+		simplification_type gs (g, 3);
+		gs.threads(numThreads);
+		gs.simplify(simplification_type::HIDE_SMALL_DEGREE | simplification_type::BICONNECTED_COMPONENT);
+		simplification_type::component_set_type cs;
+		gs.simplified_components(cs);
+		if (cs.size() != gs.num_component())
+			return 1;
+		for (uint32_t c = 0; c < cs.size(); c += 97)
+		{
+			graph_type sg, vg;
+			std::vector<vertex_descriptor> vSimpl2Orig;
+			gs.simplified_graph_component(c, sg, vSimpl2Orig);
+			simplification_type::component_view view (cs, c);
+			view.graph(vg);
+			if (view.size() != vSimpl2Orig.size() || view.num_edges() != num_edges(sg) || num_edges(vg) != num_edges(sg))
+				return 1;
+			for (uint32_t i = 0; i < view.size(); ++i)
+				if (view.vertex(i) != vSimpl2Orig[i])
+					return 1;
+			graph_traits<graph_type>::edge_iterator ei, eie, vei, veie;
+			for (tie(ei, eie) = edges(sg), tie(vei, veie) = edges(vg); ei != eie; ++ei, ++vei)
+				if (source(*ei, sg) != source(*vei, vg) || target(*ei, sg) != target(*vei, vg) || get(edge_weight, sg, *ei) != get(edge_weight, vg, *vei))
+					return 1;
+		}
+	}
+
+	// statistics are off by default and do not change the solution
+	if (cc.statistics().num_components != 0 || cc.statistics().simplify_time != 0)
+		return 1;
+	{
+		coloring_type sc (g);
+		sc.color_num(coloring_type::THREE);
+		sc.threads(numThreads);
+		sc.max_small_vertices(12);
+		sc.collect_statistics(true);
+		double statCost = sc();
+		limbo::algorithms::coloring::ColoringStatistics const& stat = sc.statistics();
+		cout << "\nstitch " << stat.stitch_time << " s, simplify " << stat.simplify_time << " s, solve " << stat.solve_time 
+			<< " s, recover " << stat.recover_time << " s, components = " << stat.num_components 
+			<< ", merged = " << stat.num_merged_vertices << ", hidden = " << stat.num_hidden_vertices << endl;
+		if (statCost != cost || stat.num_components < sc.num_small_components()+sc.num_large_components() || stat.solve_time <= 0)
+			return 1;
+	}
+
+	// small components colored in batches reach the same cost, since the solvers are exact;
+	// batches are meant for solvers with a high cost per call, so they are kept small for branch and bound
+	coloring_type bc (g);
+	bc.color_num(coloring_type::THREE);
+	bc.threads(numThreads);
+	bc.max_small_vertices(6);
+	bc.batch_vertices(12);
+	double batchCost = bc();
+	coloring_type uc (g);
+	uc.color_num(coloring_type::THREE);
+	uc.threads(numThreads);
+	uc.max_small_vertices(6);
+	double unbatchCost = uc();
+	cout << "\nbatch cost = " << batchCost << ", batches = " << bc.num_batches() << ", cost without batches = " << unbatchCost << endl;
+	if (batchCost != unbatchCost || bc.num_batches() == 0)
+		return 1;
+
+	// an ECO adds edges inside a few clusters, only the components touching them are colored again
+	std::vector<int8_t> vPrevColor (num_vertices(g));
+	for (uint32_t v = 0; v < vPrevColor.size(); ++v)
+		vPrevColor[v] = cc.color(v);
+	std::vector<vertex_descriptor> vDirty;
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		vertex_descriptor s = rand()%num_vertices(g);
+		vertex_descriptor t = (s+1)%num_vertices(g);
+		if (!edge(s, t, g).second)
+		{
+			addEdge(g, s, t);
+			vDirty.push_back(s);
+			vDirty.push_back(t);
+		}
+	}
+	coloring_type ec (g);
+	ec.color_num(coloring_type::THREE);
+	ec.threads(numThreads);
+	ec.max_small_vertices(12);
+	ec.warm_start(vPrevColor.begin(), vPrevColor.end());
+	for (uint32_t i = 0; i < vDirty.size(); ++i)
+		ec.dirty(vDirty[i]);
+	double ecoCost = ec();
+	cout << "\neco cost = " << ecoCost << ", reused components = " << ec.num_reused_components()
+		<< ", colored components = " << ec.num_small_components()+ec.num_large_components() << endl;
+	if (ec.num_reused_components() == 0)
+		return 1;
+	for (tie(vi, vie) = vertices(g); vi != vie; ++vi)
+	{
+		if (ec.color(*vi) < 0 || ec.color(*vi) >= 3)
+		{
+			cout << "vertex " << *vi << " is not colored after eco" << endl;
+			return 1;
+		}
+	}
+	// precolored vertices, e.g., pins of fixed colors, are pruned and split the clusters, 
+	// while forbidden colors keep the optimal cost of the exact solvers on a graph small enough to solve without pruning 
+	{
+		graph_type pg;
+		buildGraph(pg, 4, 10);
+		std::vector<int8_t> vPrecolor (num_vertices(pg), -1);
+		for (uint32_t v = 0; v < vPrecolor.size(); v += 4)
+			vPrecolor[v] = rand()%3;
+		coloring_type pc (pg);
+		coloring_type npc (pg);
+		npc.simplify_level(npc.simplify_level() & ~limbo::algorithms::coloring::GraphSimplification<graph_type>::PRUNE_PRECOLOR);
+		coloring_type* vColoring[] = {&pc, &npc};
+		for (uint32_t i = 0; i < 2; ++i)
+		{
+			vColoring[i]->color_num(coloring_type::THREE);
+			vColoring[i]->threads(numThreads);
+			vColoring[i]->max_small_vertices(12);
+			vColoring[i]->collect_statistics(true);
+			for (uint32_t v = 0; v < vPrecolor.size(); ++v)
+				if (vPrecolor[v] >= 0)
+					vColoring[i]->precolor(v, vPrecolor[v]);
+		}
+		double prunedCost = pc();
+		double unprunedCost = npc();
+		cout << "\nprecolored: cost = " << prunedCost << ", pruned = " << pc.statistics().num_pruned_vertices 
+			<< ", components = " << pc.statistics().num_components << "; cost without pruning = " << unprunedCost 
+			<< ", components = " << npc.statistics().num_components << endl;
+		if (prunedCost != unprunedCost || pc.statistics().num_pruned_vertices == 0 || pc.statistics().num_components <= npc.statistics().num_components)
+			return 1;
+		for (uint32_t v = 0; v < vPrecolor.size(); ++v)
+			if (pc.color(v) < 0 || pc.color(v) >= 3 || (vPrecolor[v] >= 0 && pc.color(v) != vPrecolor[v]))
+				return 1;
+	}
+	// a long chain of stitch edges forms one stitch group, with conflict edges between distant vertices
+	{
+		uint32_t chainLength = 1000000;
+		graph_type chain (chainLength);
+		for (uint32_t v = 1; v < chainLength; ++v)
+			put(edge_weight, chain, add_edge(v-1, v, chain).first, -1);
+		for (uint32_t v = 0; v+10 < chainLength; v += 1000)
+			addEdge(chain, v, v+10);
+		coloring_type chainColoring (chain);
+		chainColoring.color_num(coloring_type::THREE);
+		chainColoring.threads(numThreads);
+		chainColoring.collect_statistics(true);
+		double chainCost = chainColoring();
+		cout << "\nchain of " << chainLength << " vertices: cost = " << chainCost << ", stitch edges = " << chainColoring.statistics().num_stitch_edges 
+			<< ", grouped in " << chainColoring.statistics().stitch_time << " s" << endl;
+		if (chainColoring.statistics().num_stitch_edges != chainLength-1)
+			return 1;
+		for (uint32_t v = 0; v < chainLength; ++v)
+			if (chainColoring.color(v) < 0 || chainColoring.color(v) >= 3)
+				return 1;
+	}
+	// dense clusters take backtracking far beyond the time limit, which bounds the run with heuristic solutions kept
+	{
+		graph_type dg;
+		srand(2);
+		uint32_t clusterSize = 80;
+		dg = graph_type(20*clusterSize);
+		for (uint32_t c = 0; c < 20; ++c)
+			for (uint32_t i = 1; i < clusterSize; ++i)
+				for (uint32_t k = 0; k < 4; ++k)
+					addEdge(dg, c*clusterSize+i, c*clusterSize+rand()%i);
+		limbo::algorithms::coloring::ComponentColoring<graph_type, limbo::algorithms::coloring::BitsetColoring<graph_type>,
+			limbo::algorithms::coloring::BacktrackColoring<graph_type> > tc (dg);
+		tc.color_num(coloring_type::THREE);
+		tc.threads(numThreads);
+		tc.max_small_vertices(12);
+		tc.time_limit(2);
+		double start = limbo::algorithms::coloring::ColoringStatistics::wall_time();
+		double timedCost = tc();
+		double runtime = limbo::algorithms::coloring::ColoringStatistics::wall_time()-start;
+		cout << "\ncost = " << timedCost << " in " << runtime << " s with a time limit of 2 s, heuristic solutions kept in "
+			<< tc.num_fallback_components() << " of " << tc.num_large_components() << " large components" << endl;
+		if (runtime > 3 || tc.num_large_components() == 0)
+			return 1;
+		for (uint32_t v = 0; v < num_vertices(dg); ++v)
+			if (tc.color(v) < 0 || tc.color(v) >= 3)
+				return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file   test_ConflictGraphBuilder.cpp
+ * @brief  test @ref limbo::algorithms::coloring::ConflictGraphBuilder against brute force on random layouts
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <set>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <limbo/algorithms/coloring/ConflictGraphBuilder.h>
+#include <limbo/algorithms/coloring/ComponentColoring.h>
+
+using std::cout;
+using std::endl;
+
+/// rectangle for the test
+struct Rect
+{
+	/// @nowarn
+	typedef int coordinate_type;
+	/// @endnowarn
+	int c[4]; ///< coordinates in the order of @ref limbo::geometry::direction_2d
+	/// @param d direction
+	/// @return coordinate
+	int get(limbo::geometry::direction_2d d) const {return c[d];}
+};
+
+/// @nowarn
+typedef limbo::algorithms::coloring::ConflictGraphBuilder<Rect> builder_type;
+typedef builder_type::graph_type graph_type;
+typedef boost::tuple<uint32_t, uint32_t, int> edge_type;
+/// @endnowarn
+
+/// generate polygons of 1 to 3 abutting rectangles
+/// @param vRect rectangles
+/// @param vPolygon polygon of each rectangle
+/// @param numPolygons number of polygons
+/// @param extent side of the layout
+void randomLayout(std::vector<Rect>& vRect, std::vector<uint32_t>& vPolygon, uint32_t numPolygons, int extent)
+{
+	for (uint32_t p = 0; p < numPolygons; ++p)
+	{
+		int x = rand()%extent;
+		int y = rand()%extent;
+		uint32_t numRects = 1+rand()%3;
+		for (uint32_t i = 0; i < numRects; ++i)
+		{
+			Rect r;
+			int w = 10+rand()%40;
+			int h = 10+rand()%40;
+			r.c[limbo::geometry::LEFT] = x;
+			r.c[limbo::geometry::BOTTOM] = y;
+			r.c[limbo::geometry::RIGHT] = x+w;
+			r.c[limbo::geometry::TOP] = y+h;
+			vRect.push_back(r);
+			vPolygon.push_back(p);
+			// the next rectangle abuts on the right or the top
+			if (rand()%2)
+				x += w;
+			else
+				y += h;
+		}
+	}
+}
+
+/// @param g graph
+/// @return edges as sorted tuples
+std::set<edge_type> edgeSet(graph_type const& g)
+{
+	std::set<edge_type> sEdge;
+	graph_type::edge_iterator ei, eie;
+	for (boost::tie(ei, eie) = edges(g); ei != eie; ++ei)
+		sEdge.insert(boost::make_tuple(source(*ei, g), target(*ei, g), g.weight(*ei)));
+	return sEdge;
+}
+
+/// build the graph with given threads and tile size
+/// @param g graph
+/// @param vRect rectangles
+/// @param vPolygon polygon of each rectangle
+/// @param distance coloring distance
+/// @param threads number of threads
+/// @param tile side of tiles
+void build(graph_type& g, std::vector<Rect> const& vRect, std::vector<uint32_t> const& vPolygon, int distance, int32_t threads, int tile)
+{
+	builder_type builder (distance);
+	builder.threads(threads);
+	builder.tile_size(tile);
+	for (uint32_t i = 0; i < vRect.size(); ++i)
+		builder.add(vRect[i], vPolygon[i]);
+	builder(g);
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+	int distance = 30;
+
+	// compare with all pairs
+	std::vector<Rect> vRect;
+	std::vector<uint32_t> vPolygon;
+	randomLayout(vRect, vPolygon, 2000, 6000);
+	std::set<edge_type> sExpected;
+	for (uint32_t u = 0; u < vRect.size(); ++u)
+		for (uint32_t v = u+1; v < vRect.size(); ++v)
+		{
+			Rect const& a = vRect[u];
+			Rect const& b = vRect[v];
+			long dx = std::max(0, std::max(a.c[0]-b.c[2], b.c[0]-a.c[2]));
+			long dy = std::max(0, std::max(a.c[1]-b.c[3], b.c[1]-a.c[3]));
+			if (dx == 0 && dy == 0 && vPolygon[u] == vPolygon[v])
+				sExpected.insert(boost::make_tuple(u, v, -1));
+			else if (dx*dx+dy*dy < (long)distance*distance)
+				sExpected.insert(boost::make_tuple(u, v, 1));
+		}
+
+	graph_type g;
+	int tiles[] = {0, 10, 100, 5000};
+	for (uint32_t i = 0; i < sizeof(tiles)/sizeof(tiles[0]); ++i)
+	{
+		for (int32_t threads = 1; threads <= 4; threads *= 4)
+		{
+			build(g, vRect, vPolygon, distance, threads, tiles[i]);
+			if (num_edges(g) != sExpected.size() || edgeSet(g) != sExpected)
+			{
+				cout << "tile " << tiles[i] << ", " << threads << " threads: " << num_edges(g) << " edges, expected " << sExpected.size() << endl;
+				return 1;
+			}
+		}
+	}
+
+	// color the graph with the generic coloring algorithms
+	limbo::algorithms::coloring::ComponentColoring<graph_type> cc (g);
+	cc.color_num(4);
+	cc.threads(4);
+	double cost = cc();
+	cout << "cost = " << cost << endl;
+	for (uint32_t v = 0; v < num_vertices(g); ++v)
+	{
+		if (cc.color(v) < 0 || cc.color(v) >= 4)
+		{
+			cout << "vertex " << v << " is not colored" << endl;
+			return 1;
+		}
+	}
+
+	// color relabeled graphs, the colors must come back to the original vertices
+	builder_type orderBuilder (distance);
+	for (uint32_t i = 0; i < vRect.size(); ++i)
+		orderBuilder.add(vRect[i], vPolygon[i]);
+	std::vector<uint32_t> vHilbert;
+	orderBuilder.hilbert_order(vHilbert);
+	for (int order = 0; order < 2; ++order)
+	{
+		limbo::algorithms::coloring::ComponentColoring<graph_type> oc (g);
+		oc.color_num(4);
+		oc.threads(4);
+		if (order == 0)
+			oc.vertex_order(oc.VERTEX_ORDER_RCM);
+		else
+			oc.vertex_order(vHilbert);
+		double orderCost = oc();
+		std::vector<int8_t> vColor (num_vertices(g));
+		for (uint32_t v = 0; v < num_vertices(g); ++v)
+			vColor[v] = oc.color(v);
+		cout << ((order == 0)? "reverse Cuthill-McKee" : "Hilbert") << " order: cost = " << orderCost << endl;
+		if (orderCost != cost || oc.calc_cost(vColor) != orderCost)
+			return 1;
+	}
+
+	// a large layout
+	vRect.clear();
+	vPolygon.clear();
+	randomLayout(vRect, vPolygon, 100000, 40000);
+	builder_type builder (distance);
+	builder.threads(4);
+	for (uint32_t i = 0; i < vRect.size(); ++i)
+		builder.add(vRect[i], vPolygon[i]);
+	clock_t start = clock();
+	builder(g);
+	double buildTime = double(clock()-start)/CLOCKS_PER_SEC;
+	cout << vRect.size() << " rectangles: " << builder.num_conflict_edges() << " conflict edges, "
+		<< builder.num_stitch_edges() << " stitch edges in " << buildTime << " s" << endl;
+	if (num_vertices(g) != vRect.size() || num_edges(g) != builder.num_conflict_edges()+builder.num_stitch_edges())
+		return 1;
+	return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file   test_CsrGraph.cpp
+ * @brief  test coloring algorithms on @ref limbo::algorithms::CsrGraph against boost::adjacency_list
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/CsrGraph.h>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+#include <limbo/algorithms/coloring/ComponentColoring.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef limbo::algorithms::CsrGraph<int> csr_graph_type;
+/// @endnowarn
+
+/// build random clusters with some stitch edges, neighboring clusters are connected by single edges
+/// @param g graph
+/// @param numClusters number of clusters
+/// @param n number of vertices in each cluster
+/// @param m number of edges tried in each cluster, duplicates are skipped
+void randomGraph(graph_type& g, uint32_t numClusters, uint32_t n, uint32_t m)
+{
+	g = graph_type(numClusters*n);
+	for (uint32_t c = 0; c < numClusters; ++c)
+	{
+		for (uint32_t i = 0; i < m; ++i)
+		{
+			uint32_t s = c*n+rand()%n;
+			uint32_t t = c*n+rand()%n;
+			if (s == t || edge(s, t, g).second)
+				continue;
+			std::pair<graph_traits<graph_type>::edge_descriptor, bool> e = add_edge(s, t, g);
+			put(edge_weight, g, e.first, (rand()%8 == 0)? -1 : 1);
+		}
+		if (c > 0 && !edge(c*n-1, c*n, g).second)
+			put(edge_weight, g, add_edge(c*n-1, c*n, g).first, 1);
+	}
+}
+
+/// check adjacency and edge lookup of the CSR graph
+/// @param g original graph
+/// @param cg CSR graph
+/// @return true if consistent
+bool checkStructure(graph_type const& g, csr_graph_type const& cg)
+{
+	if (num_vertices(g) != num_vertices(cg) || num_edges(g) != num_edges(cg))
+		return false;
+	graph_traits<graph_type>::edge_iterator ei, eie;
+	for (tie(ei, eie) = edges(g); ei != eie; ++ei)
+	{
+		uint32_t s = source(*ei, g);
+		uint32_t t = target(*ei, g);
+		std::pair<csr_graph_type::edge_descriptor, bool> e1 = edge(s, t, cg);
+		std::pair<csr_graph_type::edge_descriptor, bool> e2 = edge(t, s, cg);
+		if (!e1.second || !e2.second || e1.first != e2.first || get(edge_weight, cg, e1.first) != get(edge_weight, g, *ei))
+			return false;
+	}
+	for (uint32_t v = 0; v < num_vertices(g); ++v)
+	{
+		if (degree(v, g) != degree(v, cg))
+			return false;
+		csr_graph_type::adjacency_iterator vi, vie;
+		tie(vi, vie) = adjacent_vertices(v, cg);
+		for (uint32_t prev = 0; vi != vie; prev = *vi, ++vi)
+			if (*vi < prev || !edge(v, *vi, g).second)
+				return false;
+	}
+	return true;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+
+	// small graphs are colored optimally, so both graph types must reach the same cost
+	for (uint32_t i = 0; i < 20; ++i)
+	{
+		graph_type g;
+		randomGraph(g, 1, 12, 30);
+		csr_graph_type cg;
+		limbo::algorithms::copy_csr_graph(g, cg);
+		if (!checkStructure(g, cg))
+		{
+			cout << "graph " << i << ": CSR graph differs from the original one" << endl;
+			return 1;
+		}
+
+		limbo::algorithms::coloring::BacktrackColoring<graph_type> bc (g);
+		bc.color_num(3);
+		double cost = bc();
+		limbo::algorithms::coloring::BacktrackColoring<csr_graph_type> cbc (cg);
+		cbc.color_num(3);
+		double ccost = cbc();
+		if (std::abs(cost-ccost) > 1e-6)
+		{
+			cout << "graph " << i << ": cost " << ccost << " on CSR graph, " << cost << " on adjacency_list" << endl;
+			return 1;
+		}
+	}
+
+	// a larger graph goes through simplification, where merged graphs are built by add_edge
+	graph_type g;
+	randomGraph(g, 500, 12, 30);
+	csr_graph_type cg;
+	limbo::algorithms::copy_csr_graph(g, cg);
+	cg.freeze();
+	limbo::algorithms::coloring::ComponentColoring<csr_graph_type> cc (cg);
+	cc.color_num(3);
+	cc.threads(4);
+	double cost = cc();
+	limbo::algorithms::coloring::ComponentColoring<graph_type> ac (g);
+	ac.color_num(3);
+	ac.threads(4);
+	double acost = ac();
+	cout << "\ncost = " << cost << " on CSR graph, " << acost << " on adjacency_list" << endl;
+	if (std::abs(cost-acost) > 1e-6)
+		return 1;
+	for (uint32_t v = 0; v < num_vertices(cg); ++v)
+	{
+		if (cc.color(v) < 0 || cc.color(v) >= 3)
+		{
+			cout << "vertex " << v << " is not colored" << endl;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file   test_ExactCover.cpp
+ * @brief  test @ref limbo::algorithms::ExactCover on n-queens and the example of Knuth with different numbers of threads
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <ctime>
+#include <limbo/algorithms/ExactCover.h>
+
+using std::cout;
+using std::endl;
+using limbo::algorithms::ExactCover;
+
+/// n-queens as exact cover: ranks and files are primary columns, diagonals are secondary ones
+/// @param n board size
+/// @return problem
+ExactCover queens(boost::uint32_t n)
+{
+	ExactCover ec (2*n, 2*(2*n-1));
+	for (boost::uint32_t r = 0; r < n; ++r)
+	{
+		for (boost::uint32_t f = 0; f < n; ++f)
+		{
+			boost::uint32_t vColumn[4] = {r, n+f, 2*n+r+f, 2*n+(2*n-1)+(n-1-r+f)};
+			ec.add_row(vColumn, vColumn+4);
+		}
+	}
+	return ec;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	// example in "Dancing Links", Donald E. Knuth, 2000, with the only solution of rows 0, 3, 4
+	ExactCover knuth (7);
+	boost::uint32_t vRow[6][4] = {{2, 4, 5}, {0, 3, 6}, {1, 2, 5}, {0, 3}, {1, 6}, {3, 4, 6}};
+	boost::uint32_t vSize[6] = {3, 3, 3, 2, 2, 3};
+	for (boost::uint32_t i = 0; i < 6; ++i)
+		knuth.add_row(vRow[i], vRow[i]+vSize[i]);
+	ExactCover::solution_type sol;
+	if (!knuth.solve(sol) || sol.size() != 3 || knuth.count() != 1)
+	{
+		cout << "wrong solution of the example of Knuth" << endl;
+		return 1;
+	}
+	cout << "example of Knuth: rows";
+	for (ExactCover::solution_type::const_iterator it = sol.begin(); it != sol.end(); ++it)
+		cout << " " << *it;
+	cout << endl;
+
+	// numbers of solutions of n-queens
+	boost::uint64_t vExpected[11] = {0, 1, 0, 0, 2, 10, 4, 40, 92, 352, 724};
+	for (boost::uint32_t n = 1; n <= 10; ++n)
+	{
+		ExactCover ec = queens(n);
+		ec.threads(1);
+		boost::uint64_t serial = ec.count();
+		ec.threads(4);
+		boost::uint64_t parallel = ec.count();
+		if (serial != vExpected[n] || parallel != vExpected[n])
+		{
+			cout << n << "-queens: " << serial << " and " << parallel << " solutions, expected " << vExpected[n] << endl;
+			return 1;
+		}
+	}
+
+	// solutions are in the order of a serial search for any number of threads
+	ExactCover ec = queens(12);
+	ec.threads(1);
+	clock_t start = clock();
+	std::vector<ExactCover::solution_type> vSerial = ec.solutions(100);
+	ExactCover::solution_type first;
+	ec.solve(first);
+	double serialTime = double(clock()-start)/CLOCKS_PER_SEC;
+	ec.threads(4);
+	std::vector<ExactCover::solution_type> vParallel = ec.solutions(100);
+	ExactCover::solution_type parallelFirst;
+	ec.solve(parallelFirst);
+	if (vSerial.size() != 100 || vSerial != vParallel || first != vSerial.front() || parallelFirst != first)
+	{
+		cout << "solutions of 12-queens differ with threads" << endl;
+		return 1;
+	}
+
+	timespec t0, t1;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	boost::uint64_t count = ec.count();
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	cout << "12-queens: " << count << " solutions in " << (t1.tv_sec-t0.tv_sec)+(t1.tv_nsec-t0.tv_nsec)*1e-9 << " s with 4 threads" << endl;
+	cout << "serial search of the first solutions " << serialTime << " s" << endl;
+	return (count == 14200)? 0 : 1;
+}
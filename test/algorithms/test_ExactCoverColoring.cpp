@@ -0,0 +1,129 @@
+/**
+ * @file   test_ExactCoverColoring.cpp
+ * @brief  test @ref limbo::algorithms::coloring::ExactCoverColoring against @ref limbo::algorithms::coloring::BacktrackColoring
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+#include <limbo/algorithms/coloring/ExactCoverColoring.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+/// @endnowarn
+
+/// build a random graph with weighted conflict edges, and some stitch edges if asked
+/// @param g graph
+/// @param n number of vertices
+/// @param m number of edges tried, duplicates are skipped
+/// @param stitch whether to add stitch edges
+void randomGraph(graph_type& g, uint32_t n, uint32_t m, bool stitch)
+{
+	g = graph_type(n);
+	for (uint32_t i = 0; i < m; ++i)
+	{
+		uint32_t s = rand()%n;
+		uint32_t t = rand()%n;
+		if (s == t || edge(s, t, g).second)
+			continue;
+		int w = (stitch && rand()%8 == 0)? -1 : 1+(rand()%4 == 0);
+		put(edge_weight, g, add_edge(s, t, g).first, w);
+	}
+}
+
+/// @param g graph
+/// @param c coloring solver
+/// @param stitchWeight weight of stitches
+/// @return cost of the coloring solution
+template <typename ColoringType>
+double calcCost(graph_type const& g, ColoringType const& c, double stitchWeight)
+{
+	double cost = 0;
+	graph_traits<graph_type>::edge_iterator ei, eie;
+	for (tie(ei, eie) = edges(g); ei != eie; ++ei)
+	{
+		int w = get(edge_weight, g, *ei);
+		bool same = (c.color(source(*ei, g)) == c.color(target(*ei, g)));
+		if (w >= 0)
+			cost += same*w;
+		else
+			cost -= (!same)*w*stitchWeight;
+	}
+	return cost;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+
+	double backtrackTime = 0;
+	double exactTime = 0;
+	uint32_t numExact = 0;
+	for (uint32_t i = 0; i < 300; ++i)
+	{
+		// larger than the graphs colored directly in Coloring::operator()
+		uint32_t n = 10+rand()%13;
+		int8_t colorNum = 2+rand()%3;
+		graph_type g;
+		// mostly sparse graphs without stitch edges, which often have colorings without conflicts
+		randomGraph(g, n, n*(1+rand()%3)/2, i%10 == 0);
+		std::vector<int8_t> vPrecolor (n, -1);
+		if (i%3 == 0)
+			for (uint32_t k = 0; k < 2; ++k)
+				vPrecolor[rand()%n] = rand()%colorNum;
+
+		limbo::algorithms::coloring::BacktrackColoring<graph_type> bc (g);
+		bc.color_num(colorNum);
+		bc.stitch_weight(0.1);
+		limbo::algorithms::coloring::ExactCoverColoring<graph_type> sc (g);
+		sc.threads(1+i%4);
+		sc.color_num(colorNum);
+		sc.stitch_weight(0.1);
+		for (uint32_t v = 0; v < n; ++v)
+		{
+			if (vPrecolor[v] >= 0)
+			{
+				bc.precolor(v, vPrecolor[v]);
+				sc.precolor(v, vPrecolor[v]);
+			}
+		}
+
+		clock_t start = clock();
+		double cost = bc();
+		backtrackTime += double(clock()-start)/CLOCKS_PER_SEC;
+		start = clock();
+		double scost = sc();
+		exactTime += double(clock()-start)/CLOCKS_PER_SEC;
+
+		if (std::abs(cost-scost) > 1e-6 || std::abs(scost-calcCost(g, sc, 0.1)) > 1e-6)
+		{
+			cout << "graph " << i << ": cost " << scost << " by exact cover, " << cost << " by backtracking" << endl;
+			return 1;
+		}
+		numExact += (scost == 0);
+		for (uint32_t v = 0; v < n; ++v)
+		{
+			if (sc.color(v) < 0 || sc.color(v) >= colorNum || (vPrecolor[v] >= 0 && sc.color(v) != vPrecolor[v]))
+			{
+				cout << "graph " << i << ": wrong color of vertex " << v << endl;
+				return 1;
+			}
+		}
+	}
+	cout << numExact << " graphs colored without conflicts" << endl;
+	cout << "backtracking " << backtrackTime << " s, exact cover " << exactTime << " s" << endl;
+	return 0;
+}
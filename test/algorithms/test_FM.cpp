@@ -6,6 +6,12 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+#include <algorithm>
 #include <limbo/algorithms/partition/FM.h>
 
 using std::cout;
@@ -39,10 +45,175 @@ class Node
 		weight_type m_weight; ///< node weight 
 };
 
+/// a class to describe vertices of large hypergraphs 
+class BenchNode 
+{
+	public:
+        /// @nowarn
+		typedef int tie_id_type;
+		typedef int weight_type;
+        /// @endnowarn
+
+        /// constructor 
+        /// @param w node weight 
+        /// @param id node label  
+		BenchNode(weight_type const& w, tie_id_type const& id) : m_id(id), m_weight(w) {}
+
+        /// @return node label  
+		tie_id_type tie_id() const {return m_id;}
+        /// @return node weight 
+		weight_type weight() const {return m_weight;}
+
+	protected:
+		tie_id_type m_id; ///< node label  
+		weight_type m_weight; ///< node weight 
+};
+
+/// hypergraph in CSR format 
+struct Hypergraph
+{
+	std::string name; ///< name 
+	vector<int> vNodeWeight; ///< weight of each node 
+	vector<int> vNetOffset; ///< pins of net i are from vNetOffset[i] to vNetOffset[i+1]-1 
+	vector<int> vPin; ///< node of each pin 
+	vector<int> vNetWeight; ///< weight of each net 
+};
+
+/// read a hypergraph in hMETIS format, in which ISPD98 benchmarks are distributed 
+/// @param filename file name 
+/// @param hg hypergraph 
+/// @return true if succeeded 
+bool readHmetis(std::string const& filename, Hypergraph& hg)
+{
+	std::ifstream in (filename.c_str());
+	std::string line;
+	// skip comments 
+	while (std::getline(in, line) && (line.empty() || line[0] == '%'));
+	int numNets = 0, numNodes = 0, fmt = 0;
+	std::istringstream header (line);
+	if (!(header >> numNets >> numNodes)) return false;
+	header >> fmt;
+	hg.name = filename;
+	hg.vNetOffset.assign(1, 0);
+	hg.vPin.clear();
+	hg.vNetWeight.clear();
+	for (int i = 0; i < numNets && std::getline(in, line); )
+	{
+		if (line.empty() || line[0] == '%') continue;
+		std::istringstream ss (line);
+		int w = 1, v;
+		if (fmt%10 == 1) ss >> w;
+		while (ss >> v)
+			hg.vPin.push_back(v-1);
+		hg.vNetWeight.push_back(w);
+		hg.vNetOffset.push_back(hg.vPin.size());
+		++i;
+	}
+	hg.vNodeWeight.assign(numNodes, 1);
+	for (int i = 0; fmt >= 10 && i < numNodes && std::getline(in, line); )
+	{
+		if (line.empty() || line[0] == '%') continue;
+		hg.vNodeWeight[i++] = atoi(line.c_str());
+	}
+	return (int)hg.vNetWeight.size() == numNets;
+}
+
+/// generate a hypergraph with the sizes of an ISPD98 benchmark, 
+/// mostly small nets of nearby nodes with a tail of large nets 
+/// @param name name 
+/// @param numNodes number of nodes 
+/// @param numNets number of nets 
+/// @param hg hypergraph 
+void generateIspd98Like(std::string const& name, int numNodes, int numNets, Hypergraph& hg)
+{
+	hg.name = name;
+	hg.vNodeWeight.assign(numNodes, 1);
+	hg.vNetOffset.assign(1, 0);
+	hg.vPin.clear();
+	hg.vNetWeight.assign(numNets, 1);
+	for (int i = 0; i < numNets; ++i)
+	{
+		int r = rand()%100;
+		int size = (r < 55)? 2 : (r < 75)? 3 : (r < 85)? 4 : (r < 97)? 5+rand()%6 : 11+rand()%20;
+		int center = rand()%numNodes;
+		int first = hg.vPin.size();
+		while ((int)hg.vPin.size()-first < size)
+		{
+			int v = (center+rand()%256)%numNodes;
+			if (std::find(hg.vPin.begin()+first, hg.vPin.end(), v) == hg.vPin.end())
+				hg.vPin.push_back(v);
+		}
+		hg.vNetOffset.push_back(hg.vPin.size());
+	}
+}
+
+/// report setup time, time per pass, teardown time and cut size of @ref limbo::algorithms::partition::FM, 
+/// set up by add_node() and add_net() or by add_hypergraph() 
+/// @param hg hypergraph 
+/// @return true if both setups give the same cut size 
+bool benchmark(Hypergraph const& hg)
+{
+	int numNodes = hg.vNodeWeight.size();
+	int numNets = hg.vNetWeight.size();
+	vector<BenchNode> vNode;
+	vector<BenchNode*> vpNode;
+	vector<int> vPartition;
+	for (int i = 0; i < numNodes; ++i)
+		vNode.push_back(BenchNode(hg.vNodeWeight[i], i));
+	for (int i = 0; i < numNodes; ++i)
+	{
+		vpNode.push_back(&vNode[i]);
+		vPartition.push_back(i%2);
+	}
+
+	int vCut[2];
+	for (int k = 0; k < 2; ++k)
+	{
+		limbo::algorithms::partition::FM<BenchNode, int>* pFM = new limbo::algorithms::partition::FM<BenchNode, int>;
+		limbo::algorithms::partition::FM<BenchNode, int>& fm = *pFM;
+		clock_t start = clock();
+		if (k == 0)
+		{
+			for (int i = 0; i < numNodes; ++i)
+				fm.add_node(vpNode[i], vPartition[i]);
+			vector<BenchNode*> vNet;
+			for (int i = 0; i < numNets; ++i)
+			{
+				vNet.clear();
+				for (int j = hg.vNetOffset[i]; j < hg.vNetOffset[i+1]; ++j)
+					vNet.push_back(vpNode[hg.vPin[j]]);
+				fm.add_net(hg.vNetWeight[i], vNet.begin(), vNet.end());
+			}
+		}
+		else if (!fm.add_hypergraph(vpNode.begin(), vpNode.end(), vPartition.begin(), 
+					hg.vNetOffset.begin(), hg.vNetOffset.end(), hg.vPin.begin(), hg.vNetWeight.begin()))
+		{
+			delete pFM;
+			return false;
+		}
+		double setup = (double)(clock()-start)/CLOCKS_PER_SEC;
+		start = clock();
+		vCut[k] = fm(0.9, 1.1);
+		double seconds = (double)(clock()-start)/CLOCKS_PER_SEC;
+		unsigned int passes = fm.num_passes();
+		start = clock();
+		delete pFM;
+		double teardown = (double)(clock()-start)/CLOCKS_PER_SEC;
+		cout << hg.name << (k == 0? " add_net" : " add_hypergraph") << ": " << numNodes << " nodes, " << numNets << " nets, " 
+			<< hg.vPin.size() << " pins, setup " << setup << " s, " << passes << " passes, " 
+			<< seconds/std::max(passes, 1U) << " s per pass, teardown " << teardown << " s, cut " << vCut[k] << endl;
+	}
+	return vCut[0] == vCut[1];
+}
+
 /// main function \n
-/// construct a graph and verify @ref limbo::algorithms::partition::FM
-/// @return 0 
-int main()
+/// construct a graph and verify @ref limbo::algorithms::partition::FM, 
+/// then benchmark hypergraphs in hMETIS format given by arguments, 
+/// or generated with the sizes of ISPD98 ibm01 and ibm05 
+/// @param argc number of arguments 
+/// @param argv hMETIS files 
+/// @return 0 if the benchmarks agree 
+int main(int argc, char** argv)
 {
 	array<Node*, 8> vNode;
 	vNode[0] = new Node (1, 'a');
@@ -129,5 +300,27 @@ int main()
 	fm.print();
 	fm.print_connection();
 
-	return 0;
+	bool pass = true;
+	vector<Hypergraph> vHypergraph;
+	for (int i = 1; i < argc; ++i)
+	{
+		vHypergraph.push_back(Hypergraph());
+		if (!readHmetis(argv[i], vHypergraph.back()))
+		{
+			cout << "failed to read " << argv[i] << endl;
+			return 1;
+		}
+	}
+	if (vHypergraph.empty())
+	{
+		srand(1);
+		vHypergraph.resize(2);
+		generateIspd98Like("ibm01-like", 12752, 14111, vHypergraph[0]);
+		generateIspd98Like("ibm05-like", 29347, 28446, vHypergraph[1]);
+	}
+	for (unsigned int i = 0; i < vHypergraph.size(); ++i)
+		pass = benchmark(vHypergraph[i]) && pass;
+	cout << (pass? "passed" : "failed") << endl;
+
+	return pass? 0 : 1;
 }
@@ -0,0 +1,149 @@
+/**
+ * @file   test_FMBucket.cpp
+ * @brief  test @ref limbo::algorithms::partition::FMBucket against @ref limbo::algorithms::partition::FM
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <limbo/algorithms/partition/FMBucket.h>
+
+using std::cout;
+using std::endl;
+
+/// a class to describe graph vertex
+class Node
+{
+	public:
+        /// @nowarn
+		typedef int tie_id_type;
+		typedef int weight_type;
+        /// @endnowarn
+
+        /// constructor
+        /// @param w node weight
+        /// @param id node label
+		Node(weight_type const& w, tie_id_type const& id)
+		{
+			m_weight = w;
+			m_id = id;
+		}
+
+        /// @return node label
+		tie_id_type tie_id() const {return m_id;}
+        /// @return node weight
+		weight_type weight() const {return m_weight;}
+
+	protected:
+		tie_id_type m_id; ///< node label
+		weight_type m_weight; ///< node weight
+};
+
+/// random hypergraph with nets of 2 to 5 distinct nodes, mostly local in the order of nodes
+/// @param vNode nodes
+/// @param vNet nets
+/// @param vNetWeight weights of nets
+/// @param numNodes number of nodes
+/// @param numNets number of nets
+void randomHypergraph(vector<Node>& vNode, vector<vector<Node*> >& vNet, vector<int>& vNetWeight, int numNodes, int numNets)
+{
+	vNode.clear();
+	// labels are shuffled so that tie_id does not follow the order of insertion
+	for (int i = 0; i < numNodes; ++i)
+		vNode.push_back(Node(1+rand()%3, (int)((i*7919LL)%numNodes)));
+	vNet.assign(numNets, vector<Node*>());
+	vNetWeight.assign(numNets, 0);
+	for (int i = 0; i < numNets; ++i)
+	{
+		int size = 2+rand()%4;
+		int first = rand()%numNodes;
+		for (int j = 0; (int)vNet[i].size() < size; ++j)
+		{
+			Node* pNode = &vNode[(first+rand()%64)%numNodes];
+			if (std::find(vNet[i].begin(), vNet[i].end(), pNode) == vNet[i].end())
+				vNet[i].push_back(pNode);
+		}
+		vNetWeight[i] = 1+rand()%4;
+	}
+}
+
+/// compare moves of @ref limbo::algorithms::partition::FM and @ref limbo::algorithms::partition::FMBucket with ties broken by tie_id
+/// @param numNodes number of nodes
+/// @param numNets number of nets
+/// @return true if both give the same partitions
+bool testSameMoves(int numNodes, int numNets)
+{
+	vector<Node> vNode;
+	vector<vector<Node*> > vNet;
+	vector<int> vNetWeight;
+	randomHypergraph(vNode, vNet, vNetWeight, numNodes, numNets);
+
+	limbo::algorithms::partition::FM<Node, int> fm;
+	limbo::algorithms::partition::FMBucket<Node, int> fmBucket;
+	for (int i = 0; i < numNodes; ++i)
+	{
+		fm.add_node(&vNode[i], i%2);
+		fmBucket.add_node(&vNode[i], i%2);
+	}
+	for (int i = 0; i < numNets; ++i)
+	{
+		fm.add_net(vNetWeight[i], vNet[i].begin(), vNet[i].end());
+		fmBucket.add_net(vNetWeight[i], vNet[i].begin(), vNet[i].end());
+	}
+	int initial = fmBucket.cutsize();
+	int cutsize = fm(0.9, 1.1);
+	int cutsizeBucket = fmBucket(0.9, 1.1);
+	cout << "FM cutsize " << initial << " -> " << cutsize << ", FMBucket cutsize " << initial << " -> " << cutsizeBucket
+		<< " in " << fmBucket.num_pass() << " passes" << endl;
+
+	bool same = (cutsize == cutsizeBucket && cutsize == fm.cutsize() && cutsizeBucket == fmBucket.cutsize());
+	return same;
+}
+
+/// run @ref limbo::algorithms::partition::FMBucket on a large hypergraph with ties broken by the order in buckets
+/// @param numNodes number of nodes
+/// @param numNets number of nets
+/// @return true if the cut size is consistent and the partitions stay balanced
+bool testLarge(int numNodes, int numNets)
+{
+	vector<Node> vNode;
+	vector<vector<Node*> > vNet;
+	vector<int> vNetWeight;
+	randomHypergraph(vNode, vNet, vNetWeight, numNodes, numNets);
+
+	limbo::algorithms::partition::FMBucket<Node, int> fmBucket;
+	fmBucket.set_tie_break(limbo::algorithms::partition::FMBucket<Node, int>::TIE_BY_ORDER);
+	for (int i = 0; i < numNodes; ++i)
+		fmBucket.add_node(&vNode[i], rand()%2);
+	for (int i = 0; i < numNets; ++i)
+		fmBucket.add_net(vNetWeight[i], vNet[i].begin(), vNet[i].end());
+	int initial = fmBucket.cutsize();
+	clock_t start = clock();
+	int cutsize = fmBucket(0.9, 1.1);
+	double seconds = (double)(clock()-start)/CLOCKS_PER_SEC;
+
+	int weight[2] = {0, 0};
+	for (int i = 0; i < numNodes; ++i)
+		weight[fmBucket.partition(&vNode[i])] += vNode[i].weight();
+	double ratio = (double)weight[0]/weight[1];
+	cout << numNodes << " nodes, " << numNets << " nets: cutsize " << initial << " -> " << cutsize
+		<< " in " << fmBucket.num_pass() << " passes, " << seconds << " seconds, ratio " << ratio << endl;
+	return cutsize == fmBucket.cutsize() && cutsize < initial && ratio >= 0.9 && ratio <= 1.1;
+}
+
+/// main function \n
+/// verify @ref limbo::algorithms::partition::FMBucket gives the same partitions as @ref limbo::algorithms::partition::FM
+/// and scales to large hypergraphs
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	bool pass = true;
+	for (int i = 0; i < 5; ++i)
+		pass = testSameMoves(200, 300) && pass;
+	pass = testLarge(100000, 150000) && pass;
+	pass = testLarge(1000000, 1500000) && pass;
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file   test_FMMultiWay.cpp
+ * @brief  test @ref limbo::algorithms::partition::FMMultiWay with and without the gain cache
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <limbo/algorithms/partition/FMMultiWay.h>
+
+using std::cout;
+using std::endl;
+
+/// gain of moving a vertex in a weighted graph, positive weights for conflicts and negative weights for stitches,
+/// like @ref limbo::algorithms::coloring::SDPColoringCsdp::FMGainCalcType
+struct GainCalc
+{
+    /// define value_type
+    typedef double value_type;
+    std::vector<std::vector<std::pair<int, double> > > const& adj; ///< adjacency lists
+
+    /// constructor
+    /// @param a adjacency lists
+    GainCalc(std::vector<std::vector<std::pair<int, double> > > const& a) : adj(a) {}
+    /// compute the gain when moving a vertex from one partition to another
+    /// @param v vertex
+    /// @param origp original partition
+    /// @param newp new partition
+    /// @param vPartition array of partition for each vertex
+    /// @return gain
+    double operator()(int v, signed char origp, signed char newp, std::vector<signed char> const& vPartition) const
+    {
+        double gain = 0;
+        for (std::vector<std::pair<int, double> >::const_iterator it = adj[v].begin(); it != adj[v].end(); ++it)
+        {
+            signed char pt = vPartition[it->first];
+            gain += (pt == newp)? -it->second : (pt == origp)? it->second : 0;
+        }
+        return gain;
+    }
+};
+
+/// the same gain with the hook of affected vertices
+struct CachedGainCalc : public GainCalc
+{
+    /// constructor
+    /// @param a adjacency lists
+    CachedGainCalc(std::vector<std::vector<std::pair<int, double> > > const& a) : GainCalc(a) {}
+    /// @param v moved vertex
+    /// @param vVertex neighbors of \a v are appended
+    void affected_vertices(int v, std::vector<int>& vVertex) const
+    {
+        for (std::vector<std::pair<int, double> >::const_iterator it = adj[v].begin(); it != adj[v].end(); ++it)
+            vVertex.push_back(it->first);
+    }
+};
+
+/// random graph of local edges with a few stitches, and a random coloring
+/// @param adj adjacency lists
+/// @param vPartition partition of each vertex
+/// @param n number of vertices
+/// @param numPartitions number of partitions
+void randomGraph(std::vector<std::vector<std::pair<int, double> > >& adj, std::vector<signed char>& vPartition, int n, int numPartitions)
+{
+    adj.assign(n, std::vector<std::pair<int, double> >());
+    for (int e = 0; e < 3*n; ++e)
+    {
+        int s = rand()%n;
+        int t = (s+1+rand()%20)%n;
+        double w = (rand()%10 == 0)? -0.1 : 1;
+        adj[s].push_back(std::make_pair(t, w));
+        adj[t].push_back(std::make_pair(s, w));
+    }
+    vPartition.resize(n);
+    for (int i = 0; i < n; ++i)
+        vPartition[i] = rand()%numPartitions;
+}
+
+/// @param adj adjacency lists
+/// @param vPartition partition of each vertex
+/// @return cost of conflicts and stitches
+double cost(std::vector<std::vector<std::pair<int, double> > > const& adj, std::vector<signed char> const& vPartition)
+{
+    double c = 0;
+    for (unsigned int v = 0; v < adj.size(); ++v)
+        for (std::vector<std::pair<int, double> >::const_iterator it = adj[v].begin(); it != adj[v].end(); ++it)
+            if (it->second > 0)
+                c += (vPartition[v] == vPartition[it->first])? it->second : 0;
+            else
+                c -= (vPartition[v] != vPartition[it->first])? it->second : 0;
+    return c/2;
+}
+
+/// @tparam GainCalcType gain calculator
+/// @param adj adjacency lists
+/// @param vPartition initial partition of each vertex, updated
+/// @param numPartitions number of partitions
+/// @param stopRule rules to end passes and runs early
+/// @return seconds
+template <typename GainCalcType>
+double refine(std::vector<std::vector<std::pair<int, double> > > const& adj, std::vector<signed char>& vPartition, int numPartitions, 
+        limbo::algorithms::partition::FMStopRule const& stopRule = limbo::algorithms::partition::FMStopRule())
+{
+    GainCalcType gc (adj);
+    limbo::algorithms::partition::FMMultiWay<GainCalcType> fmp (gc, adj.size(), numPartitions);
+    fmp.set_partitions(vPartition.begin(), vPartition.end());
+    fmp.set_max_stall(stopRule.max_stall);
+    fmp.set_max_passes(stopRule.max_passes);
+    fmp.set_adaptive_stop(stopRule.alpha, stopRule.beta);
+    clock_t start = clock();
+    fmp();
+    double seconds = (double)(clock()-start)/CLOCKS_PER_SEC;
+    for (unsigned int i = 0; i < vPartition.size(); ++i)
+        vPartition[i] = fmp.partition(i);
+    return seconds;
+}
+
+/// main function \n
+/// verify the gain cache of @ref limbo::algorithms::partition::FMMultiWay gives the same moves as traversal
+/// @return 0 if all tests pass
+int main()
+{
+    srand(1);
+    bool pass = limbo::algorithms::partition::FMHasAffectedVertices<CachedGainCalc>::value
+        && !limbo::algorithms::partition::FMHasAffectedVertices<GainCalc>::value;
+
+    std::vector<std::vector<std::pair<int, double> > > adj;
+    std::vector<signed char> vInitial;
+    randomGraph(adj, vInitial, 2000, 3);
+    std::vector<signed char> vPartition1 (vInitial), vPartition2 (vInitial);
+    double seconds1 = refine<GainCalc>(adj, vPartition1, 3);
+    double seconds2 = refine<CachedGainCalc>(adj, vPartition2, 3);
+    cout << adj.size() << " vertices: cost " << cost(adj, vInitial) << " -> " << cost(adj, vPartition1) << " in " << seconds1 << " seconds by traversal, "
+        << cost(adj, vPartition2) << " in " << seconds2 << " seconds by gain cache" << endl;
+    pass = pass && vPartition1 == vPartition2 && cost(adj, vPartition2) < cost(adj, vInitial);
+
+    randomGraph(adj, vInitial, 50000, 3);
+    vPartition2 = vInitial;
+    seconds2 = refine<CachedGainCalc>(adj, vPartition2, 3);
+    cout << adj.size() << " vertices: cost " << cost(adj, vInitial) << " -> " << cost(adj, vPartition2) << " in " << seconds2 << " seconds by gain cache" << endl;
+    pass = pass && cost(adj, vPartition2) < cost(adj, vInitial);
+
+    // early exits of passes 
+    char const* vName[] = {"stall 1000", "adaptive 0.5, 100", "2 passes"};
+    limbo::algorithms::partition::FMStopRule vStopRule[3];
+    vStopRule[0].max_stall = 1000;
+    vStopRule[1].alpha = 0.5;
+    vStopRule[1].beta = 100;
+    vStopRule[2].max_passes = 2;
+    for (int i = 0; i < 3; ++i)
+    {
+        std::vector<signed char> vPartition3 (vInitial);
+        double seconds3 = refine<CachedGainCalc>(adj, vPartition3, 3, vStopRule[i]);
+        cout << "with " << vName[i] << ": cost " << cost(adj, vPartition3) << " in " << seconds3 << " seconds" << endl;
+        pass = pass && cost(adj, vPartition3) < cost(adj, vInitial);
+    }
+
+    cout << (pass? "passed" : "failed") << endl;
+    return pass? 0 : 1;
+}
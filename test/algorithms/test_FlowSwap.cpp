@@ -0,0 +1,224 @@
+/**
+ * @file   test_FlowSwap.cpp
+ * @brief  test @ref limbo::algorithms::placement::FlowSwap with both min-cost flow algorithms and threads
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+#include <limbo/algorithms/placement/FlowSwap.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using std::pair;
+
+/// @nowarn
+typedef limbo::algorithms::placement::Wirelength<double> wirelength_type;
+typedef limbo::algorithms::placement::FlowSwap<double> flow_swap_type;
+/// @endnowarn
+
+/// a scrambled placement of a netlist connecting cells close to each other in an ideal placement
+struct Design
+{
+	int numCols; ///< number of sites in a row, one cell per site
+	int numRows; ///< number of rows
+	vector<vector<int> > vNet; ///< cells of each net
+	vector<int> vFootprint; ///< footprint of each cell, negative for fixed cells
+	vector<double> vX; ///< position of each cell in x direction
+	vector<double> vY; ///< position of each cell in y direction
+
+	/// constructor
+	/// @param cols number of sites in a row
+	/// @param rows number of rows
+	/// @param seed random seed
+	Design(int cols, int rows, unsigned int seed) : numCols(cols), numRows(rows)
+	{
+		srand(seed);
+		int numCells = cols*rows;
+		vFootprint.resize(numCells);
+		for (int c = 0; c < numCells; ++c)
+			vFootprint[c] = (c%29 == 0)? -1 : rand()%3;
+		// nets among cells near each other at their ideal sites c
+		for (int c = 0; c < numCells; ++c)
+			for (int k = 0; k < 2; ++k)
+			{
+				vNet.push_back(vector<int>(1, c));
+				int degree = 1+rand()%3;
+				for (int i = 0; i < degree; ++i)
+				{
+					int r = std::min(std::max(c/cols+rand()%5-2, 0), rows-1);
+					int col = std::min(std::max(c%cols+rand()%5-2, 0), cols-1);
+					vNet.back().push_back(r*cols+col);
+				}
+			}
+		// swap sites of cells of the same footprint near each other
+		vector<int> vSite (numCells);
+		for (int c = 0; c < numCells; ++c)
+			vSite[c] = c;
+		for (int i = 0; i < 4*numCells; ++i)
+		{
+			int s1 = rand()%numCells;
+			int r = std::min(std::max(s1/cols+rand()%7-3, 0), rows-1);
+			int col = std::min(std::max(s1%cols+rand()%13-6, 0), cols-1);
+			int s2 = r*cols+col;
+			if (vFootprint[s1] >= 0 && vFootprint[s1] == vFootprint[s2])
+				std::swap(vSite[s1], vSite[s2]);
+		}
+		vX.resize(numCells);
+		vY.resize(numCells);
+		for (int c = 0; c < numCells; ++c)
+		{
+			vX[c] = vSite[c]%cols;
+			vY[c] = 4.0*(vSite[c]/cols);
+		}
+	}
+	/// @brief build a wirelength engine of the netlist
+	/// @param wl engine
+	void build(wirelength_type& wl) const
+	{
+		for (unsigned int n = 0; n < vNet.size(); ++n)
+		{
+			wl.add_net((n%5 == 0)? 2 : 1);
+			for (unsigned int i = 0; i < vNet[n].size(); ++i)
+				wl.add_pin(vNet[n][i], 0.5, 2);
+		}
+		wl.build();
+	}
+	/// @return sorted positions of cells of each footprint and fixed cells
+	vector<pair<int, pair<double, double> > > sites(vector<double> const& vPosX, vector<double> const& vPosY) const
+	{
+		vector<pair<int, pair<double, double> > > vSite;
+		for (unsigned int c = 0; c < vFootprint.size(); ++c)
+			vSite.push_back(std::make_pair(vFootprint[c], std::make_pair(vPosX[c], vPosY[c])));
+		std::sort(vSite.begin(), vSite.end());
+		return vSite;
+	}
+};
+
+/// result of detailed placement
+struct Result
+{
+	vector<double> vX; ///< positions in x direction
+	vector<double> vY; ///< positions in y direction
+	vector<double> vHpwl; ///< HPWL before and after each pass
+	bool consistent; ///< kept HPWL agrees with HPWL from scratch, and cells stay on sites of their footprints
+};
+
+/// run passes of detailed placement
+/// @param design design
+/// @param solver min-cost flow algorithm
+/// @param numThreads number of threads
+/// @param numPasses number of passes
+/// @return result
+Result place(Design const& design, flow_swap_type::solver_type solver, int numThreads, int numPasses)
+{
+	wirelength_type wl (design.vX.size());
+	design.build(wl);
+	Result res;
+	res.vHpwl.push_back(wl.init(design.vX, design.vY));
+	flow_swap_type fs (wl);
+	fs.set_solver(solver);
+	fs.set_region(16, 16);
+	fs.set_num_threads(numThreads);
+	res.consistent = true;
+	for (int i = 0; i < numPasses; ++i)
+	{
+		double delta = fs(design.vFootprint);
+		res.vHpwl.push_back(wl.total());
+		res.consistent = (std::abs(res.vHpwl[i]+delta-res.vHpwl[i+1]) < 1e-6) && res.consistent;
+	}
+	for (unsigned int c = 0; c < design.vX.size(); ++c)
+	{
+		res.vX.push_back(wl.x(c));
+		res.vY.push_back(wl.y(c));
+	}
+	res.consistent = (std::abs(wl.hpwl(res.vX, res.vY)-res.vHpwl.back()) < 1e-6) && res.consistent;
+	res.consistent = (design.sites(res.vX, res.vY) == design.sites(design.vX, design.vY)) && res.consistent;
+	return res;
+}
+
+/// @return true if one window of independent cells is solved optimally, compared with all permutations
+bool optimal()
+{
+	// 6 movable cells without common nets, each on a net with 2 fixed cells
+	int k = 6;
+	wirelength_type wl (3*k);
+	vector<double> vX (3*k), vY (3*k);
+	vector<int> vFootprint (3*k, -1);
+	for (int i = 0; i < k; ++i)
+	{
+		vFootprint[i] = 0;
+		vX[i] = 10*i;
+		vY[i] = 0;
+		vX[k+2*i] = rand()%100;
+		vY[k+2*i] = rand()%100;
+		vX[k+2*i+1] = rand()%100;
+		vY[k+2*i+1] = rand()%100;
+		wl.add_net(1+i%2);
+		wl.add_pin(i, 0, 0);
+		wl.add_pin(k+2*i, 0, 0);
+		wl.add_pin(k+2*i+1, 0, 0);
+	}
+	wl.build();
+	double init = wl.init(vX, vY);
+	vector<int> vPerm (k);
+	for (int i = 0; i < k; ++i)
+		vPerm[i] = i;
+	double best = init;
+	vector<double> vPermX (vX);
+	do
+	{
+		for (int i = 0; i < k; ++i)
+			vPermX[i] = vX[vPerm[i]];
+		best = std::min(best, wl.hpwl(vPermX, vY));
+	} while (std::next_permutation(vPerm.begin(), vPerm.end()));
+
+	bool pass = true;
+	for (int s = 0; s < 2; ++s)
+	{
+		wl.init(vX, vY);
+		flow_swap_type fs (wl);
+		fs.set_solver((s == 0)? flow_swap_type::NETWORK_SIMPLEX : flow_swap_type::COST_SCALING);
+		double delta = fs(vFootprint);
+		pass = (fs.num_windows() == 1 && std::abs(init+delta-best) < 1e-6) && pass;
+	}
+	return pass;
+}
+
+/// main function \n
+/// verify HPWL decreases, results of threads and of both algorithms, and optimality of a window
+/// @return 0 if all tests pass
+int main()
+{
+	bool pass = true;
+	// allow threads beyond the number of processors
+	limbo::containers::set_num_threads(4);
+	Design design (200, 100, 3);
+	clock_t t0 = clock();
+	Result ns1 = place(design, flow_swap_type::NETWORK_SIMPLEX, 1, 3);
+	clock_t t1 = clock();
+	Result ns4 = place(design, flow_swap_type::NETWORK_SIMPLEX, 4, 3);
+	Result cs4 = place(design, flow_swap_type::COST_SCALING, 4, 3);
+	cout << "HPWL by network simplex:";
+	for (unsigned int i = 0; i < ns1.vHpwl.size(); ++i)
+		cout << " " << ns1.vHpwl[i];
+	cout << " in " << (double)(t1-t0)/CLOCKS_PER_SEC << " s" << endl;
+	cout << "HPWL by cost scaling:";
+	for (unsigned int i = 0; i < cs4.vHpwl.size(); ++i)
+		cout << " " << cs4.vHpwl[i];
+	cout << endl;
+
+	pass = ns1.consistent && ns4.consistent && cs4.consistent && pass;
+	pass = (ns1.vX == ns4.vX && ns1.vY == ns4.vY && ns1.vHpwl == ns4.vHpwl) && pass;
+	for (unsigned int i = 1; i < ns1.vHpwl.size(); ++i)
+		pass = (ns1.vHpwl[i] <= ns1.vHpwl[i-1] && cs4.vHpwl[i] <= cs4.vHpwl[i-1]) && pass;
+	pass = (ns1.vHpwl.back() < 0.8*ns1.vHpwl.front() && cs4.vHpwl.back() < 0.8*cs4.vHpwl.front()) && pass;
+	pass = optimal() && pass;
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file   test_GraphSnapshot.cpp
+ * @brief  test binary snapshots of conflict graphs @ref limbo::algorithms::coloring::GraphSnapshot against graphviz
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/CsrGraph.h>
+#include <limbo/algorithms/coloring/GraphSnapshot.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef limbo::algorithms::CsrGraph<double> csr_graph_type;
+typedef limbo::algorithms::coloring::GraphSnapshot snapshot_type;
+typedef boost::tuple<uint32_t, uint32_t, double> edge_type;
+/// @endnowarn
+
+/// sorted edges of a graph with the smaller ends first
+/// @tparam GraphType graph type
+/// @param g graph
+/// @param vEdge edges
+template <typename GraphType>
+void edgeList(GraphType const& g, std::vector<edge_type>& vEdge)
+{
+	vEdge.clear();
+	typename graph_traits<GraphType>::edge_iterator ei, eie;
+	for (tie(ei, eie) = edges(g); ei != eie; ++ei)
+	{
+		uint32_t s = source(*ei, g);
+		uint32_t t = target(*ei, g);
+		vEdge.push_back(edge_type(std::min(s, t), std::max(s, t), get(edge_weight, g, *ei)));
+	}
+	std::sort(vEdge.begin(), vEdge.end());
+}
+
+/// @tparam GraphType graph type
+/// @param g1, g2 graphs
+/// @return true if both graphs have the same vertices and edges with the same weights
+template <typename GraphType>
+bool sameGraph(GraphType const& g1, GraphType const& g2)
+{
+	std::vector<edge_type> vEdge1, vEdge2;
+	edgeList(g1, vEdge1);
+	edgeList(g2, vEdge2);
+	return num_vertices(g1) == num_vertices(g2) && vEdge1 == vEdge2;
+}
+
+/// main function
+/// @param argc number of arguments
+/// @param argv values of arguments: [benchmark directory]
+/// @return 0 if succeed
+int main(int argc, char** argv)
+{
+	std::string dir = (argc > 1)? argv[1] : "benchmarks";
+	srand(1);
+
+	// benchmarks in graphviz survive both conversions
+	char const* vBenchmark[] = {"graph_backtrack-34.gv", "graph_backtrack-100.gv", "lpcoloring_test_graph.gv"};
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		graph_type g, sg, gg;
+		std::vector<int8_t> vPrecolor, vSnapshotPrecolor, vTextPrecolor;
+		if (!snapshot_type::read_graphviz(dir+"/"+vBenchmark[i], g, vPrecolor) || num_edges(g) == 0)
+		{
+			cout << "failed to read " << vBenchmark[i] << endl;
+			return 1;
+		}
+		vPrecolor[0] = 1;
+		snapshot_type snapshot;
+		if (!snapshot_type::write("snapshot.lcg", g, vPrecolor) || !snapshot.open("snapshot.lcg"))
+			return 1;
+		snapshot.graph(sg);
+		snapshot.precolors(vSnapshotPrecolor);
+		if (!snapshot_type::write_graphviz("snapshot.gv", sg, vSnapshotPrecolor) || !snapshot_type::read_graphviz("snapshot.gv", gg, vTextPrecolor))
+			return 1;
+		cout << vBenchmark[i] << ": " << num_vertices(g) << " vertices, " << num_edges(g) << " edges" << endl;
+		if (!sameGraph(g, sg) || !sameGraph(g, gg) || vSnapshotPrecolor != vPrecolor || vTextPrecolor != vPrecolor)
+			return 1;
+	}
+
+	// a large CSR graph with stitch edges of fractional weights, loaded in a single pass
+	{
+		uint32_t n = 1000000;
+		csr_graph_type g (n);
+		for (uint32_t i = 0; i < 4*n; ++i)
+		{
+			uint32_t s = rand()%n;
+			uint32_t t = (s+1+rand()%64)%n;
+			put(edge_weight, g, add_edge(s, t, g).first, (rand()%8 == 0)? -0.5 : 1+rand()%3);
+		}
+		clock_t start = clock();
+		if (!snapshot_type::write("snapshot.lcg", g))
+			return 1;
+		double writeTime = double(clock()-start)/CLOCKS_PER_SEC;
+		start = clock();
+		snapshot_type snapshot;
+		csr_graph_type sg;
+		if (!snapshot.open("snapshot.lcg"))
+			return 1;
+		snapshot.graph(sg);
+		double readTime = double(clock()-start)/CLOCKS_PER_SEC;
+		cout << "CSR graph of " << num_edges(g) << " edges: written in " << writeTime << " s, loaded in " << readTime << " s" << endl;
+		if (snapshot.has_precolor() || !sameGraph(g, sg))
+			return 1;
+	}
+
+	// truncated or foreign files are rejected
+	{
+		snapshot_type snapshot;
+		FILE* fp = fopen("snapshot.lcg", "r+b");
+		if (fp == NULL || fseek(fp, 0, SEEK_END) != 0)
+			return 1;
+		long size = ftell(fp);
+		fclose(fp);
+		if (truncate("snapshot.lcg", size-8) != 0 || snapshot.open("snapshot.lcg") || snapshot.open(dir+"/"+vBenchmark[0]))
+			return 1;
+	}
+	std::remove("snapshot.lcg");
+	std::remove("snapshot.gv");
+	return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file   test_GraphUtility.cpp
+ * @brief  test parallel utilities of @ref limbo::algorithms::CsrGraph in @ref GraphUtility.h against sequential references
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/connected_components.hpp>
+#include <limbo/algorithms/GraphUtility.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+/// @nowarn
+typedef limbo::algorithms::CsrGraph<int> csr_graph_type;
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> graph_type;
+/// @endnowarn
+
+/// build a grid of rows x cols vertices with scrambled indices, some removed edges and some self loops
+/// @param g graph
+/// @param rows number of rows
+/// @param cols number of columns
+void randomGrid(csr_graph_type& g, uint32_t rows, uint32_t cols)
+{
+	uint32_t n = rows*cols;
+	vector<uint32_t> vIndex (n);
+	for (uint32_t v = 0; v < n; ++v)
+		vIndex[v] = v;
+	for (uint32_t v = n-1; v > 0; --v)
+		std::swap(vIndex[v], vIndex[rand()%(v+1)]);
+	vector<std::pair<uint32_t, uint32_t> > vEdge;
+	vector<int> vWeight;
+	for (uint32_t r = 0; r < rows; ++r)
+		for (uint32_t c = 0; c < cols; ++c)
+		{
+			uint32_t v = r*cols+c;
+			// sparse enough to leave many components
+			if (c+1 < cols && rand()%4)
+				vEdge.push_back(std::make_pair(vIndex[v], vIndex[v+1]));
+			if (r+1 < rows && rand()%3 == 0)
+				vEdge.push_back(std::make_pair(vIndex[v+cols], vIndex[v]));
+			if (rand()%100 == 0)
+				vEdge.push_back(std::make_pair(vIndex[v], vIndex[v]));
+		}
+	for (uint32_t i = 0; i < vEdge.size(); ++i)
+		vWeight.push_back((i%7 == 0)? -1 : 1);
+	csr_graph_type(n, vEdge.begin(), vEdge.end(), vWeight.begin()).swap(g);
+}
+
+/// @return maximum difference of positions of adjacent vertices
+/// @param g graph
+uint32_t bandwidth(csr_graph_type const& g)
+{
+	uint32_t width = 0;
+	csr_graph_type::edge_iterator ei, eie;
+	for (boost::tie(ei, eie) = g.edges(); ei != eie; ++ei)
+		width = std::max(width, (ei->m_source > ei->m_target)? ei->m_source-ei->m_target : ei->m_target-ei->m_source);
+	return width;
+}
+
+/// @param g graph
+/// @param source source vertex
+/// @return distances of sequential breadth-first search
+vector<uint32_t> distances(csr_graph_type const& g, uint32_t source)
+{
+	vector<uint32_t> vDistance (g.num_vertices(), std::numeric_limits<uint32_t>::max());
+	std::deque<uint32_t> qVertex (1, source);
+	vDistance[source] = 0;
+	while (!qVertex.empty())
+	{
+		uint32_t v = qVertex.front();
+		qVertex.pop_front();
+		csr_graph_type::adjacency_iterator it, ite;
+		for (boost::tie(it, ite) = g.adjacent_vertices(v); it != ite; ++it)
+			if (vDistance[*it] == std::numeric_limits<uint32_t>::max())
+			{
+				vDistance[*it] = vDistance[v]+1;
+				qVertex.push_back(*it);
+			}
+	}
+	return vDistance;
+}
+
+/// main function \n
+/// compare utilities with 1 and 4 threads against boost::connected_components, a sequential search and direct counting
+/// @return 0 if all tests pass
+int main()
+{
+	bool pass = true;
+	srand(7);
+	csr_graph_type g;
+	randomGrid(g, 300, 1000);
+	g.freeze();
+
+	// references
+	graph_type bg (g.num_vertices());
+	csr_graph_type::edge_iterator ei, eie;
+	for (boost::tie(ei, eie) = g.edges(); ei != eie; ++ei)
+		boost::add_edge(ei->m_source, ei->m_target, bg);
+	vector<int> vRefComponent (g.num_vertices());
+	uint32_t numRefComponents = boost::connected_components(bg, &vRefComponent[0]);
+	// search from a vertex of the largest component
+	vector<uint32_t> vSize (numRefComponents, 0);
+	for (uint32_t v = 0; v < g.num_vertices(); ++v)
+		++vSize[vRefComponent[v]];
+	uint32_t largest = std::max_element(vSize.begin(), vSize.end())-vSize.begin();
+	uint32_t source = std::find(vRefComponent.begin(), vRefComponent.end(), (int)largest)-vRefComponent.begin();
+	vector<uint32_t> vRefDistance = distances(g, source);
+	uint32_t numRefReached = g.num_vertices()-std::count(vRefDistance.begin(), vRefDistance.end(), std::numeric_limits<uint32_t>::max());
+
+	vector<uint32_t> vPrevOrder;
+	for (unsigned int numThreads = 1; numThreads <= 4; numThreads += 3)
+	{
+		limbo::containers::TaskPool pool (numThreads);
+		clock_t t0 = clock();
+		vector<uint32_t> vComponent;
+		uint32_t numComponents = limbo::algorithms::connected_components(g, vComponent, pool);
+		clock_t t1 = clock();
+		pass = (numComponents == numRefComponents && vector<uint32_t>(vRefComponent.begin(), vRefComponent.end()) == vComponent) && pass;
+
+		vector<uint32_t> vDistance;
+		uint32_t numReached = limbo::algorithms::breadth_first_distances(g, source, vDistance, pool);
+		pass = (numReached == numRefReached && vDistance == vRefDistance) && pass;
+
+		limbo::algorithms::CsrDegreeStatistics stat = limbo::algorithms::degree_statistics(g, pool);
+		uint32_t minDegree = std::numeric_limits<uint32_t>::max(), maxDegree = 0, numIsolated = 0;
+		uint64_t totalDegree = 0;
+		for (uint32_t v = 0; v < g.num_vertices(); ++v)
+		{
+			minDegree = std::min(minDegree, g.degree(v));
+			maxDegree = std::max(maxDegree, g.degree(v));
+			totalDegree += g.degree(v);
+			numIsolated += (g.degree(v) == 0);
+		}
+		pass = (stat.numVertices == g.num_vertices() && stat.minDegree == minDegree && stat.maxDegree == maxDegree
+				&& stat.totalDegree == totalDegree && stat.numIsolated == numIsolated) && pass;
+
+		vector<uint32_t> vOrder;
+		limbo::algorithms::reverse_cuthill_mckee_order(g, vOrder, pool);
+		vector<uint32_t> vSorted (vOrder);
+		std::sort(vSorted.begin(), vSorted.end());
+		for (uint32_t v = 0; v < vSorted.size(); ++v)
+			pass = (vSorted[v] == v) && pass;
+		pass = (vPrevOrder.empty() || vPrevOrder == vOrder) && pass;
+		vPrevOrder = vOrder;
+
+		csr_graph_type gp;
+		limbo::algorithms::permute_graph(g, vOrder, gp, pool);
+		pass = (gp.num_edges() == g.num_edges() && gp.weights() == g.weights()) && pass;
+		for (uint32_t i = 0; i < g.num_edges(); ++i)
+		{
+			limbo::algorithms::CsrEdgeDescriptor e = *(g.edges().first+i);
+			limbo::algorithms::CsrEdgeDescriptor ep = *(gp.edges().first+i);
+			pass = (vOrder[ep.m_source] == e.m_source && vOrder[ep.m_target] == e.m_target) && pass;
+		}
+		cout << numThreads << " threads: " << numComponents << " components in " << (double)(t1-t0)/CLOCKS_PER_SEC << " s, "
+			<< numReached << " vertices reached, average degree " << stat.mean()
+			<< ", bandwidth " << bandwidth(g) << " before and " << bandwidth(gp) << " after reverse Cuthill-McKee" << endl;
+		pass = (bandwidth(gp) < bandwidth(g)/10) && pass;
+
+		limbo::algorithms::degree_order(g, vOrder);
+		for (uint32_t i = 1; i < vOrder.size(); ++i)
+			pass = (g.degree(vOrder[i-1]) > g.degree(vOrder[i]) || (g.degree(vOrder[i-1]) == g.degree(vOrder[i]) && vOrder[i-1] < vOrder[i])) && pass;
+	}
+
+	// graph without edges
+	limbo::containers::TaskPool pool (2);
+	csr_graph_type empty (5);
+	vector<uint32_t> vComponent;
+	pass = (limbo::algorithms::connected_components(empty, vComponent, pool) == 5 && vComponent[4] == 4) && pass;
+
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
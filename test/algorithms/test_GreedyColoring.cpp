@@ -0,0 +1,114 @@
+/**
+ * @file   test_GreedyColoring.cpp
+ * @brief  test @ref limbo::algorithms::coloring::BucketDsatColoring and @ref limbo::algorithms::coloring::ParallelGreedyColoring
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/GreedyColoring.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t>,
+		property<edge_index_t, std::size_t> > graph_type;
+/// @endnowarn
+
+/// @param g graph
+/// @param vColor colors
+/// @return true if no edge has the same color on both ends
+bool proper(graph_type const& g, std::vector<int> const& vColor)
+{
+	graph_traits<graph_type>::edge_iterator ei, eie;
+	for (boost::tie(ei, eie) = edges(g); ei != eie; ++ei)
+		if (source(*ei, g) != target(*ei, g) && vColor[source(*ei, g)] == vColor[target(*ei, g)])
+			return false;
+	for (std::size_t v = 0; v < vColor.size(); ++v)
+		if (vColor[v] < 0)
+			return false;
+	return true;
+}
+
+/// generate a random graph with local edges, like conflicts in layouts
+/// @param g graph
+/// @param n number of vertices
+/// @param degree average degree
+void randomGraph(graph_type& g, std::size_t n, std::size_t degree)
+{
+	for (std::size_t v = 0; v < n; ++v)
+		add_vertex(g);
+	for (std::size_t i = 0; i < n*degree/2; ++i)
+	{
+		std::size_t s = rand()%n;
+		add_edge(s, (s+1+rand()%std::min(n-1, (std::size_t)4*degree))%n, g);
+	}
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+
+	// DSATUR is exact on bipartite graphs and cycles
+	graph_type grid (100*100);
+	for (std::size_t i = 0; i < 100; ++i)
+		for (std::size_t j = 0; j < 100; ++j)
+		{
+			if (i+1 < 100) add_edge(i*100+j, (i+1)*100+j, grid);
+			if (j+1 < 100) add_edge(i*100+j, i*100+j+1, grid);
+		}
+	graph_type cycle (99);
+	for (std::size_t i = 0; i < 99; ++i)
+		add_edge(i, (i+1)%99, cycle);
+	limbo::algorithms::coloring::BucketDsatColoring<graph_type> gridDsat (grid);
+	limbo::algorithms::coloring::BucketDsatColoring<graph_type> cycleDsat (cycle);
+	if (gridDsat() != 2 || cycleDsat() != 3 || !proper(grid, gridDsat.colors()) || !proper(cycle, cycleDsat.colors()))
+	{
+		cout << "wrong DSATUR coloring of the grid or the cycle" << endl;
+		return 1;
+	}
+
+	for (std::size_t i = 0; i < 20; ++i)
+	{
+		graph_type g;
+		randomGraph(g, 10+rand()%500, 1+rand()%12);
+		limbo::algorithms::coloring::BucketDsatColoring<graph_type> dsat (g);
+		limbo::algorithms::coloring::ParallelGreedyColoring<graph_type> serial (g);
+		limbo::algorithms::coloring::ParallelGreedyColoring<graph_type> parallel (g);
+		parallel.threads(4);
+		int dsatColors = dsat();
+		int serialColors = serial();
+		int parallelColors = parallel();
+		if (!proper(g, dsat.colors()) || !proper(g, serial.colors()) || serialColors != parallelColors || serial.colors() != parallel.colors())
+		{
+			cout << "graph " << i << ": wrong coloring, " << dsatColors << " colors by DSATUR, "
+				<< serialColors << " and " << parallelColors << " by parallel greedy coloring" << endl;
+			return 1;
+		}
+	}
+
+	// a large graph
+	graph_type g;
+	randomGraph(g, 1000000, 8);
+	limbo::algorithms::coloring::BucketDsatColoring<graph_type> dsat (g);
+	clock_t start = clock();
+	int dsatColors = dsat();
+	double dsatTime = double(clock()-start)/CLOCKS_PER_SEC;
+	limbo::algorithms::coloring::ParallelGreedyColoring<graph_type> pg (g);
+	pg.threads(4);
+	start = clock();
+	int pgColors = pg();
+	double pgTime = double(clock()-start)/CLOCKS_PER_SEC;
+	cout << "1M vertices: " << dsatColors << " colors by DSATUR in " << dsatTime << " s, "
+		<< pgColors << " colors by parallel greedy coloring in " << pgTime << " s" << endl;
+	if (!proper(g, dsat.colors()) || !proper(g, pg.colors()))
+		return 1;
+	return 0;
+}
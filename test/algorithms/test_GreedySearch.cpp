@@ -0,0 +1,248 @@
+/**
+ * @file   test_GreedySearch.cpp
+ * @brief  test @ref limbo::algorithms::placement::GreedySearch with threads
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <list>
+#include <limits>
+#include <boost/type_traits/integral_constant.hpp>
+#include <limbo/algorithms/placement/GreedySearch.h>
+
+using std::cout;
+using std::endl;
+using std::list;
+using std::vector;
+using std::pair;
+
+/// a cell in rows of sites
+struct Cell
+{
+	int id; ///< index
+	int width; ///< width in sites
+	int x; ///< current site, -1 if not placed
+	int row; ///< current row, -1 if not placed
+	int gx; ///< desired site
+	int grow; ///< desired row
+};
+
+/// a row of sites
+struct Row
+{
+	int xl; ///< first site
+	int xh; ///< last site plus one
+};
+
+/// callback legalizing cells with the smallest displacement
+struct Callback
+{
+	/// @nowarn
+	typedef Cell node_type;
+	typedef Row row_type;
+	typedef int site_coordinate_type;
+	typedef list<Cell*> node_vector_type;
+	typedef list<Cell*> node_fail_vector_type;
+	typedef vector<Row*> row_vector_type;
+	typedef boost::true_type thread_safe_type;
+	/// @endnowarn
+	/// @brief displacement of a candidate
+	struct cost_type
+	{
+		long cost; ///< displacement and penalty of swaps
+		int row; ///< target row
+		int site; ///< target site
+		vector<list<Cell*>::iterator> vItNode; ///< swapped cells and the position for insertion
+		/// constructor
+		cost_type() : cost(std::numeric_limits<long>::max()), row(-1), site(-1) {}
+		/// @return true if c1 has smaller cost than c2
+		friend bool operator<(cost_type const& c1, cost_type const& c2) {return c1.cost < c2.cost;}
+	};
+
+	vector<Row>* pRow; ///< rows
+	vector<list<Cell*> >* pRowCell; ///< cells in each row sorted by sites, ended by a zero width cell
+	int max_disp_x; ///< maximum displacement in sites
+	int max_disp_row; ///< maximum displacement in rows
+
+	/// constructor
+	Callback() : pRow(NULL), pRowCell(NULL), max_disp_x(0), max_disp_row(0) {}
+
+	/// @nowarn
+	int site_xl(const Cell* c) const {return c->x;}
+	int site_xh(const Cell* c) const {return c->x+c->width;}
+	pair<size_t, size_t> row_range(const Cell* c) const
+	{
+		return pair<size_t, size_t>(std::max(c->grow-max_disp_row, 0), std::min(c->grow+max_disp_row+1, (int)pRow->size()));
+	}
+	list<Cell*>& nodes_in_row(size_t row_idx) const {return (*pRowCell)[row_idx];}
+	bool check_displace(const Cell* c, int x, int) const {return std::abs(x-c->gx) <= max_disp_x;}
+	cost_type calc_cost(const Cell* c, int row, int site, vector<list<Cell*>::iterator> const& vItNode, unsigned int swap_cnt) const
+	{
+		cost_type cost;
+		cost.cost = std::abs(site-c->gx)+4*std::abs(row-c->grow)+100*swap_cnt;
+		cost.row = row;
+		cost.site = site;
+		cost.vItNode = vItNode;
+		return cost;
+	}
+	bool check_valid(cost_type const& c) const {return c.row >= 0;}
+	void apply(Cell* c, cost_type const& cost, list<Cell*>& vFailNode, int swap_cnt) const
+	{
+		list<Cell*>& vCell = (*pRowCell)[cost.row];
+		for (int i = 0; i < swap_cnt; ++i)
+		{
+			Cell* pSwap = *cost.vItNode[i];
+			pSwap->x = pSwap->row = -1;
+			vFailNode.push_back(pSwap);
+			vCell.erase(cost.vItNode[i]);
+		}
+		c->x = cost.site;
+		c->row = cost.row;
+		vCell.insert(cost.vItNode.back(), c);
+	}
+	Row* row(size_t row_idx) const {return &(*pRow)[row_idx];}
+	int site_xl(const Row* r) const {return r->xl;}
+	int site_xh(const Row* r) const {return r->xh;}
+	/// @endnowarn
+};
+
+/// a callback that is not declared thread-safe
+struct UnsafeCallback : public Callback
+{
+	typedef boost::false_type thread_safe_type; ///< not thread-safe 
+};
+
+/// a random placement, cells placed from left to right in their desired rows, others failed
+struct Placement
+{
+	vector<Row> vRow; ///< rows
+	vector<Cell> vCell; ///< cells followed by one zero width cell per row
+	vector<list<Cell*> > vRowCell; ///< cells in each row
+	list<Cell*> vFailNode; ///< failed cells
+
+	/// constructor
+	/// @param numRows number of rows
+	/// @param numSites number of sites in a row
+	/// @param numCells number of cells
+	/// @param seed random seed
+	Placement(int numRows, int numSites, int numCells, unsigned int seed)
+	{
+		srand(seed);
+		vRow.assign(numRows, Row());
+		for (int i = 0; i < numRows; ++i)
+		{
+			vRow[i].xl = 0;
+			vRow[i].xh = numSites;
+		}
+		vCell.assign(numCells+numRows, Cell());
+		vector<int> vUsed (numRows, 0);
+		vRowCell.assign(numRows, list<Cell*>());
+		for (int i = 0; i < numCells; ++i)
+		{
+			Cell& c = vCell[i];
+			c.id = i;
+			c.width = 1+rand()%4;
+			c.grow = rand()%numRows;
+			c.gx = rand()%(numSites-c.width+1);
+			// cells fill rows until nothing fits in, like an overfull global placement
+			if (vUsed[c.grow]+c.width <= numSites && rand()%4)
+			{
+				c.x = vUsed[c.grow];
+				c.row = c.grow;
+				vUsed[c.grow] += c.width;
+				vRowCell[c.grow].push_back(&c);
+			}
+			else
+			{
+				c.x = c.row = -1;
+				vFailNode.push_back(&c);
+			}
+		}
+		for (int i = 0; i < numRows; ++i)
+		{
+			Cell& c = vCell[numCells+i];
+			c.id = numCells+i;
+			c.width = 0;
+			c.x = c.gx = numSites;
+			c.row = c.grow = i;
+			vRowCell[i].push_back(&c);
+		}
+	}
+	/// @return true if no cells overlap and cells stay in rows
+	bool legal() const
+	{
+		for (unsigned int i = 0; i < vRowCell.size(); ++i)
+		{
+			int xh = vRow[i].xl;
+			for (list<Cell*>::const_iterator it = vRowCell[i].begin(); it != vRowCell[i].end(); ++it)
+			{
+				if ((*it)->x < xh || (*it)->row != (int)i) return false;
+				xh = (*it)->x+(*it)->width;
+			}
+			if (xh > vRow[i].xh) return false;
+		}
+		return true;
+	}
+	/// @return sites and rows of all cells
+	vector<pair<int, int> > positions() const
+	{
+		vector<pair<int, int> > vPos;
+		for (unsigned int i = 0; i < vCell.size(); ++i)
+			vPos.push_back(pair<int, int>(vCell[i].x, vCell[i].row));
+		return vPos;
+	}
+};
+
+/// legalize a placement
+/// @tparam CallbackType callback type
+/// @param numThreads number of threads
+/// @param batchSize maximum number of cells in a batch
+/// @param vPos positions of cells after legalization
+/// @param numFail number of failed cells after legalization
+/// @return true if the placement is legal
+template <typename CallbackType>
+bool legalize(int numThreads, int batchSize, vector<pair<int, int> >& vPos, int& numFail)
+{
+	Placement pl (40, 200, 2800, 7);
+	CallbackType cbk;
+	cbk.pRow = &pl.vRow;
+	cbk.pRowCell = &pl.vRowCell;
+	cbk.max_disp_x = 30;
+	cbk.max_disp_row = 2;
+	limbo::algorithms::placement::GreedySearch<CallbackType> gs (cbk);
+	gs.set_num_threads(numThreads);
+	gs.set_batch_size(batchSize);
+	gs.set_batch_row_gap(1);
+	gs(pl.vFailNode, 2);
+	vPos = pl.positions();
+	numFail = pl.vFailNode.size();
+	return pl.legal();
+}
+
+/// main function \n
+/// verify results do not depend on the number of threads,
+/// and concurrent evaluation of candidates matches the serial search
+/// @return 0 if all tests pass
+int main()
+{
+	bool pass = true;
+	vector<pair<int, int> > vSerial, vUnsafe, vCandidate, vBatch2, vBatch4;
+	int numSerial, numUnsafe, numCandidate, numBatch2, numBatch4;
+	pass = legalize<Callback>(1, 64, vSerial, numSerial) && pass;
+	// callbacks not declared thread-safe run serially
+	pass = legalize<UnsafeCallback>(4, 64, vUnsafe, numUnsafe) && pass;
+	pass = legalize<Callback>(4, 1, vCandidate, numCandidate) && pass;
+	pass = legalize<Callback>(2, 64, vBatch2, numBatch2) && pass;
+	pass = legalize<Callback>(4, 64, vBatch4, numBatch4) && pass;
+
+	cout << "failed cells: serial " << numSerial << ", not thread-safe " << numUnsafe
+		<< ", candidates by threads " << numCandidate << ", batches by 2 threads " << numBatch2
+		<< ", batches by 4 threads " << numBatch4 << endl;
+	pass = (vUnsafe == vSerial && numUnsafe == numSerial) && pass;
+	pass = (vCandidate == vSerial && numCandidate == numSerial) && pass;
+	pass = (vBatch2 == vBatch4 && numBatch2 == numBatch4) && pass;
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
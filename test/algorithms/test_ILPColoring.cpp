@@ -8,6 +8,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <cmath>
 #include <limbo/preprocessor/AssertMsg.h>
 #include <boost/graph/graphviz.hpp>
 #include <boost/graph/graph_utility.hpp>
@@ -81,6 +82,15 @@ void randomGraph()
 	lc.color_num(limbo::algorithms::coloring::ILPColoring<graph_type>::THREE);
 	double cost = lc();
     cout << "final cost = " << cost << endl;
+
+	// the improved formulation with symmetry breaking and lazy conflict constraints reaches the same optimum 
+	limbo::algorithms::coloring::ILPColoring<graph_type> ic (g); 
+	ic.stitch_weight(0.1);
+	ic.color_num(limbo::algorithms::coloring::ILPColoring<graph_type>::THREE);
+	ic.improved_formulation(true); 
+	double improvedCost = ic();
+    cout << "improved formulation cost = " << improvedCost << endl;
+	limboAssertMsg(std::abs(improvedCost-cost) < 1e-6, "cost %g by the improved formulation, %g by the full model", improvedCost, cost);
 }
 
 /// test 2: a real graph from input 
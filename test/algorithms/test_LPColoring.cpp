@@ -16,6 +16,9 @@
 #include <limbo/algorithms/coloring/ChromaticNumber.h>
 #include <limbo/algorithms/coloring/GreedyColoring.h>
 // do not include these two together 
+#if GUROBI == 1
+#include <limbo/solvers/api/GurobiApi.h>
+#endif
 #include <limbo/algorithms/coloring/LPColoring.h>
 //#include <limbo/algorithms/coloring/LPColoringOld.h> 
 #include <boost/graph/erdos_renyi_generator.hpp>
@@ -87,6 +90,14 @@ double simple_graph()
 	lc.color_num(limbo::algorithms::coloring::LPColoring<graph_type>::THREE);
 	double cost = lc();
     printf("solved in %u LP iterations\n", lc.lp_iters());
+#if GUROBI == 1
+    // the same LP re-solved by dual simplex 
+    typedef limbo::solvers::GurobiLinearSession<double, double> gurobi_session_type; 
+	limbo::algorithms::coloring::LPColoring<graph_type, gurobi_session_type> glc (g); 
+	glc.color_num(limbo::algorithms::coloring::LPColoring<graph_type, gurobi_session_type>::THREE);
+	double gurobiCost = glc();
+    printf("solved in %u LP iterations by Gurobi with cost %g\n", glc.lp_iters(), gurobiCost);
+#endif
     return cost;
 }
 
@@ -0,0 +1,159 @@
+/**
+ * @file   test_LabelPropagation.cpp
+ * @brief  test @ref limbo::algorithms::partition::LabelPropagation against @ref limbo::algorithms::partition::FMMultiWay
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <ctime>
+#include <limbo/algorithms/partition/LabelPropagation.h>
+
+using std::cout;
+using std::endl;
+
+/// gain of moving a vertex in a weighted graph, positive weights for conflicts and negative weights for stitches,
+/// like @ref limbo::algorithms::coloring::SDPColoringCsdp::FMGainCalcType
+struct GainCalc
+{
+    /// define value_type
+    typedef double value_type;
+    std::vector<std::vector<std::pair<int, double> > > const& adj; ///< adjacency lists
+
+    /// constructor
+    /// @param a adjacency lists
+    GainCalc(std::vector<std::vector<std::pair<int, double> > > const& a) : adj(a) {}
+    /// compute the gain when moving a vertex from one partition to another
+    /// @param v vertex
+    /// @param origp original partition
+    /// @param newp new partition
+    /// @param vPartition array of partition for each vertex
+    /// @return gain
+    double operator()(int v, signed char origp, signed char newp, std::vector<signed char> const& vPartition) const
+    {
+        double gain = 0;
+        for (std::vector<std::pair<int, double> >::const_iterator it = adj[v].begin(); it != adj[v].end(); ++it)
+        {
+            signed char pt = vPartition[it->first];
+            gain += (pt == newp)? -it->second : (pt == origp)? it->second : 0;
+        }
+        return gain;
+    }
+};
+
+/// the same gain with the hook of affected vertices
+struct CachedGainCalc : public GainCalc
+{
+    /// constructor
+    /// @param a adjacency lists
+    CachedGainCalc(std::vector<std::vector<std::pair<int, double> > > const& a) : GainCalc(a) {}
+    /// @param v moved vertex
+    /// @param vVertex neighbors of \a v are appended
+    void affected_vertices(int v, std::vector<int>& vVertex) const
+    {
+        for (std::vector<std::pair<int, double> >::const_iterator it = adj[v].begin(); it != adj[v].end(); ++it)
+            vVertex.push_back(it->first);
+    }
+};
+
+/// random graph of local edges with a few stitches, and a random coloring
+/// @param adj adjacency lists
+/// @param vPartition partition of each vertex
+/// @param n number of vertices
+/// @param numPartitions number of partitions
+void randomGraph(std::vector<std::vector<std::pair<int, double> > >& adj, std::vector<signed char>& vPartition, int n, int numPartitions)
+{
+    adj.assign(n, std::vector<std::pair<int, double> >());
+    for (int e = 0; e < 3*n; ++e)
+    {
+        int s = rand()%n;
+        int t = (s+1+rand()%20)%n;
+        double w = (rand()%10 == 0)? -0.1 : 1;
+        adj[s].push_back(std::make_pair(t, w));
+        adj[t].push_back(std::make_pair(s, w));
+    }
+    vPartition.resize(n);
+    for (int i = 0; i < n; ++i)
+        vPartition[i] = rand()%numPartitions;
+}
+
+/// @param adj adjacency lists
+/// @param vPartition partition of each vertex
+/// @return cost of conflicts and stitches
+double cost(std::vector<std::vector<std::pair<int, double> > > const& adj, std::vector<signed char> const& vPartition)
+{
+    double c = 0;
+    for (unsigned int v = 0; v < adj.size(); ++v)
+        for (std::vector<std::pair<int, double> >::const_iterator it = adj[v].begin(); it != adj[v].end(); ++it)
+            if (it->second > 0)
+                c += (vPartition[v] == vPartition[it->first])? it->second : 0;
+            else
+                c -= (vPartition[v] != vPartition[it->first])? it->second : 0;
+    return c/2;
+}
+
+/// @param vPartition partition of each vertex
+/// @param numPartitions number of partitions
+/// @return largest partition size over the average
+double imbalance(std::vector<signed char> const& vPartition, int numPartitions)
+{
+    std::vector<int> vSize (numPartitions, 0);
+    for (unsigned int i = 0; i < vPartition.size(); ++i)
+        ++vSize[vPartition[i]];
+    return (double)*std::max_element(vSize.begin(), vSize.end())*numPartitions/vPartition.size();
+}
+
+/// @param adj adjacency lists
+/// @param vPartition initial partition of each vertex, updated
+/// @param numPartitions number of partitions
+/// @param numThreads number of threads
+/// @param eps allowed imbalance, negative for no constraint
+/// @param polish whether to polish by FMMultiWay
+/// @return seconds
+double refine(std::vector<std::vector<std::pair<int, double> > > const& adj, std::vector<signed char>& vPartition, int numPartitions, int numThreads, double eps, bool polish)
+{
+    CachedGainCalc gc (adj);
+    limbo::algorithms::partition::LabelPropagation<CachedGainCalc> lp (gc, adj.size(), numPartitions);
+    lp.set_partitions(vPartition.begin(), vPartition.end());
+    lp.set_num_threads(numThreads);
+    lp.set_max_imbalance(eps);
+    lp.set_polish(polish);
+    clock_t start = clock();
+    lp();
+    double seconds = (double)(clock()-start)/CLOCKS_PER_SEC;
+    for (unsigned int i = 0; i < vPartition.size(); ++i)
+        vPartition[i] = lp.partition(i);
+    return seconds;
+}
+
+/// main function \n
+/// verify @ref limbo::algorithms::partition::LabelPropagation improves colorings, respects balance, 
+/// and gives the same results with any number of threads
+/// @return 0 if all tests pass
+int main()
+{
+    srand(1);
+    bool pass = true;
+    std::vector<std::vector<std::pair<int, double> > > adj;
+    std::vector<signed char> vInitial;
+    randomGraph(adj, vInitial, 100000, 3);
+    double initial = cost(adj, vInitial);
+
+    std::vector<signed char> vPartition1 (vInitial), vPartition4 (vInitial), vBalanced (vInitial), vPolished (vInitial);
+    double seconds1 = refine(adj, vPartition1, 3, 1, -1, false);
+    double seconds4 = refine(adj, vPartition4, 3, 4, -1, false);
+    refine(adj, vBalanced, 3, 4, 0.01, false);
+    double secondsPolish = refine(adj, vPolished, 3, 4, -1, true);
+    cout << adj.size() << " vertices: cost " << initial << " -> " << cost(adj, vPartition1) << " in " << seconds1 << " seconds with 1 thread, "
+        << cost(adj, vPartition4) << " in " << seconds4 << " seconds with 4 threads" << endl;
+    cout << "imbalance " << imbalance(vInitial, 3) << " -> " << imbalance(vPartition1, 3) << " without constraint, "
+        << imbalance(vBalanced, 3) << " with cost " << cost(adj, vBalanced) << " under 1%" << endl;
+    cout << "polished by FMMultiWay: cost " << cost(adj, vPolished) << " in " << secondsPolish << " seconds" << endl;
+    pass = pass && vPartition1 == vPartition4 && cost(adj, vPartition1) < initial
+        && imbalance(vBalanced, 3) <= std::max(1.01, imbalance(vInitial, 3)) && cost(adj, vBalanced) < initial
+        && cost(adj, vPolished) <= cost(adj, vPartition1);
+
+    cout << (pass? "passed" : "failed") << endl;
+    return pass? 0 : 1;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file   test_MISColoringHeuristic.cpp
+ * @brief  test heuristic independent sets of @ref limbo::algorithms::coloring::MISColoring on components in parallel
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/MISColoring.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef limbo::algorithms::coloring::MISColoring<graph_type> coloring_type;
+/// @endnowarn
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+
+	// components with planted 4-colorings and a few extra conflicts
+	uint32_t numComponents = 30;
+	uint32_t componentSize = 100;
+	graph_type g (numComponents*componentSize);
+	std::vector<int> vPlanted (num_vertices(g));
+	for (uint32_t i = 0; i < vPlanted.size(); ++i)
+		vPlanted[i] = rand()%4;
+	for (uint32_t c = 0; c < numComponents; ++c)
+	{
+		uint32_t offset = c*componentSize;
+		for (uint32_t i = 0; i < componentSize*3; ++i)
+		{
+			uint32_t s = offset+rand()%componentSize;
+			uint32_t t = offset+rand()%componentSize;
+			if (s != t && (vPlanted[s] != vPlanted[t] || rand()%50 == 0) && !edge(s, t, g).second)
+				put(edge_weight, g, add_edge(s, t, g).first, 1);
+		}
+	}
+
+	coloring_type greedy (g);
+	greedy.color_num(coloring_type::FOUR);
+	clock_t start = clock();
+	double greedyCost = greedy();
+	double greedyTime = double(clock()-start)/CLOCKS_PER_SEC;
+
+	coloring_type serial (g);
+	serial.color_num(coloring_type::FOUR);
+	serial.heuristic(true);
+	serial.threads(1);
+	start = clock();
+	double cost = serial();
+	double heuristicTime = double(clock()-start)/CLOCKS_PER_SEC;
+
+	coloring_type parallel (g);
+	parallel.color_num(coloring_type::FOUR);
+	parallel.heuristic(true);
+	parallel.threads(4);
+	double parallelCost = parallel();
+
+	cout << "\ncost = " << cost << " by heuristic independent sets in " << heuristicTime << " s, "
+		<< greedyCost << " by greedy independent sets in " << greedyTime << " s" << endl;
+	if (cost > greedyCost || parallelCost != cost)
+		return 1;
+	for (uint32_t v = 0; v < num_vertices(g); ++v)
+	{
+		if (serial.color(v) < 0 || serial.color(v) >= 4 || serial.color(v) != parallel.color(v))
+		{
+			cout << "wrong color of vertex " << v << endl;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file   test_MaxClique.cpp
+ * @brief  test @ref limbo::algorithms::BitsetCliqueSearch against boost::bron_kerbosch_all_cliques
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <set>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/MaxClique.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t>,
+		property<edge_index_t, std::size_t> > graph_type;
+typedef graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
+/// @endnowarn
+
+/// visitor counting cliques without keeping them
+struct CountVisitor
+{
+	std::size_t& count; ///< number of cliques
+	std::size_t& largest; ///< size of the largest clique
+	/// constructor
+	/// @param c number of cliques
+	/// @param l size of the largest clique
+	CountVisitor(std::size_t& c, std::size_t& l) : count(c), largest(l) {}
+	/// @param c clique
+	template <typename CliqueType>
+	void clique(CliqueType const& c, graph_type const&)
+	{
+		++count;
+		largest = std::max(largest, (std::size_t)c.size());
+	}
+};
+
+/// @param vClique cliques
+/// @return cliques with sorted vertices in a set
+std::set<std::vector<vertex_descriptor> > cliqueSet(std::vector<std::vector<vertex_descriptor> > vClique)
+{
+	std::set<std::vector<vertex_descriptor> > sClique;
+	for (std::size_t i = 0; i < vClique.size(); ++i)
+	{
+		std::sort(vClique[i].begin(), vClique[i].end());
+		sClique.insert(vClique[i]);
+	}
+	return sClique;
+}
+
+/// generate a random graph with dense clusters, like conflicts in dense layouts
+/// @param g graph
+/// @param n number of vertices
+/// @param degree average degree
+void randomGraph(graph_type& g, std::size_t n, std::size_t degree)
+{
+	for (std::size_t v = 0; v < n; ++v)
+		add_vertex(g);
+	for (std::size_t i = 0; i < n*degree/2; ++i)
+	{
+		std::size_t s = rand()%n;
+		std::size_t t = (s+1+rand()%std::min(n-1, (std::size_t)3*degree))%n;
+		if (!edge(s, t, g).second)
+			add_edge(s, t, g);
+	}
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+	for (std::size_t i = 0; i < 50; ++i)
+	{
+		graph_type g;
+		randomGraph(g, 5+rand()%60, 2+rand()%10);
+		std::size_t minSize = 1+rand()%4;
+		std::vector<std::vector<vertex_descriptor> > vExpected;
+		bron_kerbosch_all_cliques(g, limbo::algorithms::max_clique_visitor_type<graph_type>(vExpected), minSize);
+		std::vector<std::vector<vertex_descriptor> > vParallel;
+		limbo::algorithms::maximal_cliques(g, limbo::algorithms::max_clique_visitor_type<graph_type>(vParallel), minSize, 4);
+		std::set<std::vector<vertex_descriptor> > sExpected = cliqueSet(vExpected);
+		std::vector<std::vector<vertex_descriptor> > vClique = limbo::algorithms::max_clique(g, minSize);
+		if (vClique.size() != sExpected.size() || cliqueSet(vClique) != sExpected
+				|| vParallel.size() != sExpected.size() || cliqueSet(vParallel) != sExpected)
+		{
+			cout << "graph " << i << ": " << vClique.size() << " and " << vParallel.size()
+				<< " cliques, expected " << sExpected.size() << endl;
+			return 1;
+		}
+		std::size_t largest = 0;
+		for (std::size_t j = 0; j < vExpected.size(); ++j)
+			largest = std::max(largest, vExpected[j].size());
+		std::vector<vertex_descriptor> vMax = limbo::algorithms::maximum_clique(g, 4);
+		for (std::size_t j = 0; j < vMax.size(); ++j)
+			for (std::size_t k = j+1; k < vMax.size(); ++k)
+				if (!edge(vMax[j], vMax[k], g).second)
+				{
+					cout << "graph " << i << ": maximum clique is not a clique" << endl;
+					return 1;
+				}
+		if (!vExpected.empty() && vMax.size() != largest)
+		{
+			cout << "graph " << i << ": maximum clique of " << vMax.size() << " vertices, expected " << largest << endl;
+			return 1;
+		}
+	}
+
+	// a larger dense graph, cliques are only counted by the visitor
+	graph_type g;
+	randomGraph(g, 20000, 24);
+	std::size_t count = 0, largest = 0;
+	clock_t start = clock();
+	limbo::algorithms::maximal_cliques(g, CountVisitor(count, largest), 4, 4);
+	double t = double(clock()-start)/CLOCKS_PER_SEC;
+	std::size_t boostCount = 0, boostLargest = 0;
+	start = clock();
+	bron_kerbosch_all_cliques(g, CountVisitor(boostCount, boostLargest), 4);
+	double boostTime = double(clock()-start)/CLOCKS_PER_SEC;
+	start = clock();
+	std::size_t maxSize = limbo::algorithms::maximum_clique(g, 4).size();
+	double maxTime = double(clock()-start)/CLOCKS_PER_SEC;
+	cout << count << " cliques of at least 4 vertices in " << t << " s, " << boostTime
+		<< " s by boost::bron_kerbosch_all_cliques; maximum clique of " << maxSize << " vertices in " << maxTime << " s" << endl;
+	if (count != boostCount || largest != boostLargest || maxSize != largest)
+		return 1;
+	return 0;
+}
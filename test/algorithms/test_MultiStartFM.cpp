@@ -0,0 +1,148 @@
+/**
+ * @file   test_MultilevelFM.cpp
+ * @brief  test @ref limbo::algorithms::partition::MultiStartFM against a single run of @ref limbo::algorithms::partition::FMBucket
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <limbo/algorithms/partition/MultiStartFM.h>
+
+using std::cout;
+using std::endl;
+
+/// a class to describe graph vertex
+class Node
+{
+	public:
+        /// @nowarn
+		typedef int tie_id_type;
+		typedef int weight_type;
+        /// @endnowarn
+
+        /// constructor
+        /// @param w node weight
+        /// @param id node label
+		Node(weight_type const& w, tie_id_type const& id)
+		{
+			m_weight = w;
+			m_id = id;
+		}
+
+        /// @return node label
+		tie_id_type tie_id() const {return m_id;}
+        /// @return node weight
+		weight_type weight() const {return m_weight;}
+
+	protected:
+		tie_id_type m_id; ///< node label
+		weight_type m_weight; ///< node weight
+};
+
+/// netlist-like hypergraph of cells on a grid, each net connects 2 to 6 cells in a small window
+/// @param vNode nodes
+/// @param vNet nets
+/// @param vNetWeight weights of nets
+/// @param side number of cells in each row and column
+void gridHypergraph(vector<Node>& vNode, vector<vector<Node*> >& vNet, vector<int>& vNetWeight, int side)
+{
+	int numNodes = side*side;
+	vNode.clear();
+	for (int i = 0; i < numNodes; ++i)
+		vNode.push_back(Node(1+rand()%4, i));
+	int numNets = numNodes*3/2;
+	vNet.assign(numNets, vector<Node*>());
+	vNetWeight.assign(numNets, 0);
+	for (int i = 0; i < numNets; ++i)
+	{
+		int x = rand()%side;
+		int y = rand()%side;
+		int size = 2+rand()%5;
+		for (int j = 0; j < size; ++j)
+		{
+			int nx = std::min(std::max(x+rand()%5-2, 0), side-1);
+			int ny = std::min(std::max(y+rand()%5-2, 0), side-1);
+			vNet[i].push_back(&vNode[nx*side+ny]);
+		}
+		vNetWeight[i] = 1+rand()%3;
+	}
+}
+
+/// @param vNode nodes
+/// @param fm partitioner
+/// @return ratio of weights of partition 0 over partition 1
+template <typename PartitionerType>
+double ratio(vector<Node>& vNode, PartitionerType const& fm)
+{
+	int weight[2] = {0, 0};
+	for (unsigned int i = 0; i < vNode.size(); ++i)
+		weight[fm.partition(&vNode[i])] += vNode[i].weight();
+	return (double)weight[0]/weight[1];
+}
+
+/// compare multi-start FM with a single run from the same initial partition
+/// @param side number of cells in each row and column
+/// @param numStarts number of starts
+/// @return true if the best start is balanced, not worse than the single run, and independent of the number of threads
+bool test(int side, unsigned int numStarts)
+{
+	vector<Node> vNode;
+	vector<vector<Node*> > vNet;
+	vector<int> vNetWeight;
+	gridHypergraph(vNode, vNet, vNetWeight, side);
+	vector<int> vInitial;
+	for (unsigned int i = 0; i < vNode.size(); ++i)
+		vInitial.push_back(rand()%2);
+
+	limbo::algorithms::partition::FMBucket<Node, int> single;
+	single.set_tie_break(limbo::algorithms::partition::FMBucket<Node, int>::TIE_BY_ORDER);
+	for (unsigned int i = 0; i < vNode.size(); ++i)
+		single.add_node(&vNode[i], vInitial[i]);
+	for (unsigned int i = 0; i < vNet.size(); ++i)
+		single.add_net(vNetWeight[i], vNet[i].begin(), vNet[i].end());
+	clock_t start = clock();
+	int singleCutsize = single(0.9, 1.1);
+	double singleSeconds = (double)(clock()-start)/CLOCKS_PER_SEC;
+
+	bool pass = true;
+	int vCutsize[2];
+	vector<int> vPartition[2];
+	for (int t = 0; t < 2; ++t)
+	{
+		limbo::algorithms::partition::MultiStartFM<Node, int> multistart;
+		multistart.set_tie_break(limbo::algorithms::partition::FMBucket<Node, int>::TIE_BY_ORDER);
+		multistart.set_num_starts(numStarts);
+		multistart.set_num_threads(t? 4 : 1);
+		multistart.set_seed(7);
+		for (unsigned int i = 0; i < vNode.size(); ++i)
+			multistart.add_node(&vNode[i], vInitial[i]);
+		for (unsigned int i = 0; i < vNet.size(); ++i)
+			multistart.add_net(vNetWeight[i], vNet[i].begin(), vNet[i].end());
+		start = clock();
+		vCutsize[t] = multistart(0.9, 1.1);
+		double seconds = (double)(clock()-start)/CLOCKS_PER_SEC;
+		double r = ratio(vNode, multistart);
+		for (unsigned int i = 0; i < vNode.size(); ++i)
+			vPartition[t].push_back(multistart.partition(&vNode[i]));
+		cout << vNode.size() << " nodes, " << vNet.size() << " nets: single FM cutsize " << singleCutsize << " in " << singleSeconds << " seconds, "
+			<< numStarts << " starts cutsize " << vCutsize[t] << " from start " << multistart.best_start() << " in " << seconds << " seconds, ratio " << r << endl;
+		// the first start repeats the single run 
+		pass = pass && multistart.start_cutsizes()[0] == singleCutsize;
+		pass = pass && vCutsize[t] == multistart.cutsize() && vCutsize[t] <= singleCutsize && r >= 0.9 && r <= 1.1;
+	}
+	return pass && vCutsize[0] == vCutsize[1] && vPartition[0] == vPartition[1];
+}
+
+/// main function \n
+/// verify @ref limbo::algorithms::partition::MultiStartFM on netlist-like hypergraphs
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	bool pass = true;
+	pass = test(100, 8) && pass;
+	pass = test(300, 4) && pass;
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file   test_MultilevelFM.cpp
+ * @brief  test @ref limbo::algorithms::partition::MultilevelFM against flat @ref limbo::algorithms::partition::FMBucket
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <limbo/algorithms/partition/MultilevelFM.h>
+
+using std::cout;
+using std::endl;
+
+/// a class to describe graph vertex
+class Node
+{
+	public:
+        /// @nowarn
+		typedef int tie_id_type;
+		typedef int weight_type;
+        /// @endnowarn
+
+        /// constructor
+        /// @param w node weight
+        /// @param id node label
+		Node(weight_type const& w, tie_id_type const& id)
+		{
+			m_weight = w;
+			m_id = id;
+		}
+
+        /// @return node label
+		tie_id_type tie_id() const {return m_id;}
+        /// @return node weight
+		weight_type weight() const {return m_weight;}
+
+	protected:
+		tie_id_type m_id; ///< node label
+		weight_type m_weight; ///< node weight
+};
+
+/// netlist-like hypergraph of cells on a grid, each net connects 2 to 6 cells in a small window
+/// @param vNode nodes
+/// @param vNet nets
+/// @param vNetWeight weights of nets
+/// @param side number of cells in each row and column
+void gridHypergraph(vector<Node>& vNode, vector<vector<Node*> >& vNet, vector<int>& vNetWeight, int side)
+{
+	int numNodes = side*side;
+	vNode.clear();
+	for (int i = 0; i < numNodes; ++i)
+		vNode.push_back(Node(1+rand()%4, i));
+	int numNets = numNodes*3/2;
+	vNet.assign(numNets, vector<Node*>());
+	vNetWeight.assign(numNets, 0);
+	for (int i = 0; i < numNets; ++i)
+	{
+		int x = rand()%side;
+		int y = rand()%side;
+		int size = 2+rand()%5;
+		for (int j = 0; j < size; ++j)
+		{
+			int nx = std::min(std::max(x+rand()%5-2, 0), side-1);
+			int ny = std::min(std::max(y+rand()%5-2, 0), side-1);
+			vNet[i].push_back(&vNode[nx*side+ny]);
+		}
+		vNetWeight[i] = 1+rand()%3;
+	}
+}
+
+/// @param vNode nodes
+/// @param fm partitioner
+/// @return ratio of weights of partition 0 over partition 1
+template <typename PartitionerType>
+double ratio(vector<Node>& vNode, PartitionerType const& fm)
+{
+	int weight[2] = {0, 0};
+	for (unsigned int i = 0; i < vNode.size(); ++i)
+		weight[fm.partition(&vNode[i])] += vNode[i].weight();
+	return (double)weight[0]/weight[1];
+}
+
+/// compare multilevel partitioning with flat FM from a random partition
+/// @param side number of cells in each row and column
+/// @return true if multilevel partitioning is balanced, better than flat FM, and independent of the number of threads
+bool test(int side)
+{
+	vector<Node> vNode;
+	vector<vector<Node*> > vNet;
+	vector<int> vNetWeight;
+	gridHypergraph(vNode, vNet, vNetWeight, side);
+
+	limbo::algorithms::partition::FMBucket<Node, int> flat;
+	flat.set_tie_break(limbo::algorithms::partition::FMBucket<Node, int>::TIE_BY_ORDER);
+	for (unsigned int i = 0; i < vNode.size(); ++i)
+		flat.add_node(&vNode[i], rand()%2);
+	for (unsigned int i = 0; i < vNet.size(); ++i)
+		flat.add_net(vNetWeight[i], vNet[i].begin(), vNet[i].end());
+	clock_t start = clock();
+	int flatCutsize = flat(0.9, 1.1);
+	double flatSeconds = (double)(clock()-start)/CLOCKS_PER_SEC;
+
+	bool pass = true;
+	int vCutsize[2];
+	for (int t = 0; t < 2; ++t)
+	{
+		limbo::algorithms::partition::MultilevelFM<Node, int> multilevel;
+		multilevel.set_num_threads(t? 4 : 1);
+		for (unsigned int i = 0; i < vNode.size(); ++i)
+			multilevel.add_node(&vNode[i]);
+		for (unsigned int i = 0; i < vNet.size(); ++i)
+			multilevel.add_net(vNetWeight[i], vNet[i].begin(), vNet[i].end());
+		start = clock();
+		vCutsize[t] = multilevel(0.9, 1.1);
+		double seconds = (double)(clock()-start)/CLOCKS_PER_SEC;
+		double r = ratio(vNode, multilevel);
+		cout << vNode.size() << " nodes, " << vNet.size() << " nets: flat FM cutsize " << flatCutsize << " in " << flatSeconds << " seconds, "
+			<< "multilevel cutsize " << vCutsize[t] << " with " << multilevel.num_levels() << " levels in " << seconds << " seconds, ratio " << r << endl;
+		pass = pass && vCutsize[t] == multilevel.cutsize() && vCutsize[t] < flatCutsize && r >= 0.9 && r <= 1.1;
+	}
+	return pass && vCutsize[0] == vCutsize[1];
+}
+
+/// main function \n
+/// verify @ref limbo::algorithms::partition::MultilevelFM on netlist-like hypergraphs
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	bool pass = true;
+	pass = test(100) && pass;
+	pass = test(500) && pass;
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
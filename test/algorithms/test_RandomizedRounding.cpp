@@ -0,0 +1,92 @@
+/**
+ * @file   test_RandomizedRounding.cpp
+ * @brief  test @ref limbo::algorithms::coloring::RandomizedRounding with fractional solutions near a random coloring
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/RandomizedRounding.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef limbo::algorithms::coloring::RandomizedRounding<graph_type> rounding_type;
+/// @endnowarn
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+	uint32_t n = 2000;
+	graph_type g (n);
+	for (uint32_t i = 0; i < n*3; ++i)
+	{
+		uint32_t s = rand()%n;
+		uint32_t t = rand()%n;
+		if (s != t && !edge(s, t, g).second)
+			put(edge_weight, g, add_edge(s, t, g).first, (rand()%10 == 0)? -1 : 1);
+	}
+
+	// fractional bits around a random coloring
+	std::vector<double> vColorBit (n*2);
+	std::vector<int8_t> vPrecolor (n, -1);
+	for (uint32_t v = 0; v < n; ++v)
+	{
+		int8_t c = rand()%3;
+		vColorBit[v*2] = std::abs((c>>1)-0.3*rand()/RAND_MAX);
+		vColorBit[v*2+1] = std::abs((c&1)-0.3*rand()/RAND_MAX);
+		if (v%50 == 0)
+			vPrecolor[v] = c;
+	}
+
+	rounding_type rr (g, 3, 0.1, vPrecolor, vColorBit);
+	rr.trials(1);
+	std::vector<int8_t> vSingle;
+	double singleCost = rr(vSingle);
+
+	rr.trials(16);
+	rr.threads(1);
+	std::vector<int8_t> vSerial;
+	double serialCost = rr(vSerial);
+	rr.threads(4);
+	std::vector<int8_t> vColor;
+	double cost = rr(vColor);
+	cout << "cost = " << cost << " from 16 trials, " << singleCost << " from 1 trial" << endl;
+
+	if (cost > singleCost || cost != serialCost || vColor != vSerial)
+	{
+		cout << "results of 4 threads differ from 1 thread or worse than a single trial" << endl;
+		return 1;
+	}
+	if (std::abs(cost-rr.cost(vColor)) > 1e-6)
+	{
+		cout << "incremental cost " << cost << " differs from " << rr.cost(vColor) << endl;
+		return 1;
+	}
+	for (uint32_t v = 0; v < n; ++v)
+	{
+		if (vColor[v] < 0 || vColor[v] >= 3 || (vPrecolor[v] >= 0 && vColor[v] != vPrecolor[v]))
+		{
+			cout << "wrong color of vertex " << v << endl;
+			return 1;
+		}
+	}
+	// refinement reaches a local minimum
+	std::vector<int8_t> vRefined (vColor);
+	if (std::abs(rr.refine(vRefined)-cost) > 1e-6 || vRefined != vColor)
+	{
+		cout << "refinement does not reach a local minimum" << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file   test_RowOccupancy.cpp
+ * @brief  test @ref limbo::algorithms::placement::RowOccupancy against scans of site arrays
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <iterator>
+#include <limbo/algorithms/placement/RowOccupancy.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+/// occupancy by scanning sites, -1 for free sites
+struct SiteArray
+{
+	int xl; ///< first site
+	vector<int> vSite; ///< cell on each site
+
+	/// @return number of free sites in [l, h) clipped by the row
+	int free_sites(int l, int h) const
+	{
+		int cnt = 0;
+		for (int x = std::max(l, xl); x < std::min(h, xl+(int)vSite.size()); ++x)
+			cnt += (vSite[x-xl] < 0);
+		return cnt;
+	}
+	/// @return cells overlapping [l, h) in the order of sites
+	vector<int> cells(int l, int h) const
+	{
+		vector<int> vCell;
+		for (int x = std::max(l, xl); x < std::min(h, xl+(int)vSite.size()); ++x)
+			if (vSite[x-xl] >= 0 && (vCell.empty() || vCell.back() != vSite[x-xl]))
+				vCell.push_back(vSite[x-xl]);
+		return vCell;
+	}
+	/// @return closest first site to x where \a w sites are free within [l, h), smaller on ties, or -1
+	int nearest(int x, int w, int l, int h) const
+	{
+		int best = -1;
+		for (int s = std::max(l, xl); s+w <= std::min(h, xl+(int)vSite.size()); ++s)
+			if (free_sites(s, s+w) == w && (best < 0 || std::abs(s-x) < std::abs(best-x)))
+				best = s;
+		return best;
+	}
+};
+
+/// random insertions, removals and queries on one row
+/// @param xl first site of the row
+/// @param numSites number of sites
+/// @param numOps number of operations
+/// @return true if the index agrees with the site array
+bool testRandom(int xl, int numSites, int numOps)
+{
+	limbo::algorithms::placement::RowOccupancy<int> occupancy;
+	occupancy.add_row(0, 1);
+	std::size_t r = occupancy.add_row(xl, xl+numSites);
+	SiteArray sa;
+	sa.xl = xl;
+	sa.vSite.assign(numSites, -1);
+	vector<int> vCellXl;
+
+	for (int i = 0; i < numOps; ++i)
+	{
+		int l = xl-5+rand()%(numSites+10);
+		int h = l+rand()%20;
+		int op = rand()%4;
+		if (op == 0)
+		{
+			// insert a cell
+			int cell = vCellXl.size();
+			bool expected = (l < h && l >= xl && h <= xl+numSites && sa.free_sites(l, h) == h-l);
+			if (occupancy.insert(r, l, h, cell) != expected) return false;
+			if (expected)
+			{
+				for (int x = l; x < h; ++x)
+					sa.vSite[x-xl] = cell;
+				vCellXl.push_back(l);
+			}
+		}
+		else if (op == 1 && !vCellXl.empty())
+		{
+			// remove a cell
+			int cell = rand()%vCellXl.size();
+			// a removed cell, then remove at a random site, which fails unless a cell starts there
+			int x = (vCellXl[cell] < 0)? l : vCellXl[cell];
+			bool expected = (x >= xl && x < xl+numSites && sa.vSite[x-xl] >= 0 && vCellXl[sa.vSite[x-xl]] == x);
+			if (occupancy.erase(r, x) != expected) return false;
+			if (!expected) continue;
+			cell = sa.vSite[x-xl];
+			for (int x = 0; x < numSites; ++x)
+				if (sa.vSite[x] == cell)
+					sa.vSite[x] = -1;
+			vCellXl[cell] = -1;
+		}
+		else if (op == 2)
+		{
+			vector<int> vCell;
+			occupancy.cells_in_window(r, l, h, std::back_inserter(vCell));
+			if (occupancy.free_sites(r, l, h) != sa.free_sites(l, h) || vCell != sa.cells(l, h))
+				return false;
+		}
+		else
+		{
+			int x = l+rand()%10;
+			int w = 1+rand()%6;
+			int site = -1;
+			if (!occupancy.nearest_free_site(r, x, w, l-10, h+10, site))
+				site = -1;
+			if (site != sa.nearest(x, w, l-10, h+10))
+				return false;
+		}
+	}
+	return occupancy.free_sites(0, 0, 1) == 1;
+}
+
+/// main function \n
+/// verify @ref limbo::algorithms::placement::RowOccupancy against scans of site arrays
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	bool pass = true;
+	pass = testRandom(0, 100, 20000) && pass;
+	pass = testRandom(37, 250, 20000) && pass;
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
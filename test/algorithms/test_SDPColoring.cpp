@@ -48,6 +48,7 @@ typedef graph_traits<graph_type>::vertex_descriptor vertex_descriptor;
 typedef graph_traits<graph_type>::edge_descriptor edge_descriptor; 
 typedef property_map<graph_type, edge_weight_t>::type edge_weight_map_type;
 typedef property_map<graph_type, vertex_color_t>::type vertex_color_map_type;
+typedef limbo::algorithms::coloring::SDPColoringCsdp<graph_type> coloring_type;
 /// @endnowarn
 
 /// test 1: a simple graph 
@@ -87,11 +88,14 @@ double simple_graph()
 }
 
 /// test 2: a random graph 
-double random_graph() 
+/// @param sdpSolver solver for the SDP 
+/// @param N number of vertices 
+/// @param trials number of randomized rounding trials 
+/// @param threads number of threads 
+double random_graph(coloring_type::SdpSolverType sdpSolver, int N = 40, uint32_t trials = 0, int32_t threads = 1) 
 {
 	mt19937 gen;
 	graph_type g;
-	int N = 40;
 	std::vector<vertex_descriptor> vertex_set;
 	std::vector< std::pair<vertex_descriptor, vertex_descriptor> > edge_set;
 	generate_random_graph(g, N, N * 2, gen,
@@ -115,6 +119,9 @@ double random_graph()
 	lc.stitch_weight(0.1);
 	// THREE or FOUR 
 	lc.color_num(limbo::algorithms::coloring::SDPColoringCsdp<graph_type>::THREE);
+	lc.sdp_solver(sdpSolver);
+	lc.rounding_trials(trials);
+	lc.threads(threads);
     return lc();
 }
 
@@ -194,7 +201,22 @@ int main(int argc, char** argv)
 	if (argc < 2)
 	{
 		cost = simple_graph();
-		//cost = random_graph();
+		cout << "random graph cost = " << random_graph(coloring_type::CSDP) << " by Csdp, " 
+			<< random_graph(coloring_type::LOW_RANK) << " by low-rank SDP" << endl;
+		cout << "large random graph cost = " << random_graph(coloring_type::LOW_RANK, 5000) << " by low-rank SDP" << endl;
+		// randomized rounding trials never lose to the threshold rounding and do not depend on the number of threads 
+		for (int i = 0; i < 2; ++i)
+		{
+			coloring_type::SdpSolverType sdpSolver = (i == 0)? coloring_type::CSDP : coloring_type::LOW_RANK;
+			int N = (i == 0)? 200 : 5000;
+			double base = random_graph(sdpSolver, N);
+			double serial = random_graph(sdpSolver, N, 16, 1);
+			double parallel = random_graph(sdpSolver, N, 16, 4);
+			cout << "random graph cost = " << base << " without and " << parallel << " with 16 rounding trials by " 
+				<< ((i == 0)? "Csdp" : "low-rank SDP") << endl;
+			if (serial > base || parallel != serial)
+				return 1;
+		}
 	}
 	else cost = real_graph(argv[1]);
 
@@ -0,0 +1,185 @@
+/**
+ * @file   test_TabuRefinement.cpp
+ * @brief  test @ref limbo::algorithms::coloring::TabuRefinement on greedy solutions against exact ones
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <boost/graph/adjacency_list.hpp>
+#include <limbo/algorithms/coloring/TabuRefinement.h>
+#include <limbo/algorithms/coloring/GreedyColoring.h>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+#include <limbo/algorithms/coloring/MISColoring.h>
+#include <limbo/algorithms/coloring/SatColoring.h>
+
+using std::cout;
+using std::endl;
+using namespace boost;
+
+/// @nowarn
+typedef adjacency_list<vecS, vecS, undirectedS,
+		property<vertex_index_t, std::size_t, property<vertex_color_t, int> >,
+		property<edge_index_t, std::size_t, property<edge_weight_t, int> >,
+		property<graph_name_t, std::string> > graph_type;
+typedef limbo::algorithms::coloring::TabuRefinement<graph_type> refinement_type;
+/// @endnowarn
+
+/// build a random graph with some stitch edges and weighted conflict edges
+/// @param g graph
+/// @param n number of vertices
+/// @param m number of edges tried, duplicates are skipped
+void randomGraph(graph_type& g, uint32_t n, uint32_t m)
+{
+	g = graph_type(n);
+	for (uint32_t i = 0; i < m; ++i)
+	{
+		uint32_t s = rand()%n;
+		uint32_t t = rand()%n;
+		if (s == t || edge(s, t, g).second)
+			continue;
+		int w = (rand()%8 == 0)? -1 : 1+(rand()%4 == 0);
+		put(edge_weight, g, add_edge(s, t, g).first, w);
+	}
+}
+
+/// greedy solution with the number of colors folded into \a colorNum
+/// @param g graph
+/// @param colorNum number of colors
+/// @param vColor coloring solution
+void greedyColoring(graph_type const& g, int8_t colorNum, std::vector<int8_t>& vColor)
+{
+	limbo::algorithms::coloring::BucketDsatColoring<graph_type> dc (g);
+	dc();
+	vColor.resize(num_vertices(g));
+	for (uint32_t v = 0; v < vColor.size(); ++v)
+		vColor[v] = dc.color(v)%colorNum;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+
+	// small graphs, greedy solutions refined close to the optimum
+	uint32_t numOptimal = 0;
+	double greedyGap = 0;
+	double refinedGap = 0;
+	for (uint32_t i = 0; i < 200; ++i)
+	{
+		uint32_t n = 10+rand()%13;
+		int8_t colorNum = 3+rand()%2;
+		graph_type g;
+		randomGraph(g, n, n*(2+rand()%2));
+		std::vector<char> vFixed (n, false);
+		std::vector<int8_t> vColor;
+		greedyColoring(g, colorNum, vColor);
+
+		limbo::algorithms::coloring::BacktrackColoring<graph_type> bc (g);
+		bc.color_num(colorNum);
+		bc.stitch_weight(0.1);
+		if (i%3 == 0)
+		{
+			for (uint32_t k = 0; k < 2; ++k)
+			{
+				uint32_t v = rand()%n;
+				vColor[v] = rand()%colorNum;
+				vFixed[v] = true;
+				bc.precolor(v, vColor[v]);
+			}
+		}
+		bc();
+		std::vector<int8_t> vOptimal (n);
+		for (uint32_t v = 0; v < n; ++v)
+			vOptimal[v] = bc.color(v);
+
+		refinement_type tr (g, colorNum, 0.1);
+		tr.max_iterations(2000);
+		tr.fixed(vFixed);
+		std::vector<int8_t> vInitial (vColor);
+		double greedyCost = tr.cost()(vColor);
+		double cost = tr(vColor);
+		double optimum = tr.cost()(vOptimal);
+		if (cost > greedyCost+1e-6 || std::abs(cost-tr.cost()(vColor)) > 1e-6 || cost < optimum-1e-6)
+		{
+			cout << "graph " << i << ": cost " << cost << " after refinement, " << greedyCost << " before, optimum " << optimum << endl;
+			return 1;
+		}
+		for (uint32_t v = 0; v < n; ++v)
+		{
+			if (vColor[v] < 0 || vColor[v] >= colorNum || (vFixed[v] && vColor[v] != vInitial[v]))
+			{
+				cout << "graph " << i << ": wrong color of vertex " << v << endl;
+				return 1;
+			}
+		}
+		numOptimal += (cost < optimum+1e-6);
+		greedyGap += greedyCost-optimum;
+		refinedGap += cost-optimum;
+	}
+	cout << "refined solutions optimal on " << numOptimal << " of 200 graphs, total gap " << refinedGap << " from " << greedyGap << " of greedy" << endl;
+	if (numOptimal < 180)
+		return 1;
+
+	// a large graph of many components, the same solution with any number of threads
+	{
+		graph_type g;
+		randomGraph(g, 200000, 300000);
+		std::vector<int8_t> vColor;
+		greedyColoring(g, 3, vColor);
+		std::vector<int8_t> vParallel (vColor);
+		refinement_type tr (g, 3, 0.1);
+		tr.max_iterations(200);
+		double greedyCost = tr.cost()(vColor);
+		clock_t start = clock();
+		double cost = tr(vColor);
+		double serialTime = double(clock()-start)/CLOCKS_PER_SEC;
+		tr.threads(4);
+		double parallelCost = tr(vParallel);
+		cout << "large graph: cost " << cost << " from " << greedyCost << " of greedy, " << tr.num_moves() << " moves in "
+			<< tr.num_refined_components() << " components, " << serialTime << " s" << endl;
+		if (cost >= greedyCost || parallelCost != cost || vParallel != vColor)
+			return 1;
+	}
+
+	// refinement after any algorithm
+	{
+		graph_type g;
+		randomGraph(g, 2000, 6000);
+		limbo::algorithms::coloring::MISColoring<graph_type> mc (g);
+		mc.color_num(3);
+		mc.stitch_weight(0.1);
+		mc.heuristic(true);
+		double misCost = mc();
+		limbo::algorithms::coloring::MISColoring<graph_type> rc (g);
+		rc.color_num(3);
+		rc.stitch_weight(0.1);
+		rc.heuristic(true);
+		rc.refine_iterations(500);
+		rc.collect_statistics(true);
+		double cost = rc();
+		cout << "MIS coloring: cost " << cost << " with refinement in " << rc.statistics().refine_time << " s, " << misCost << " without" << endl;
+		if (cost >= misCost)
+			return 1;
+	}
+
+	// precolors are kept by the refinement
+	{
+		graph_type g;
+		randomGraph(g, 300, 900);
+		limbo::algorithms::coloring::SatColoring<graph_type> sc (g);
+		sc.color_num(3);
+		sc.stitch_weight(0.1);
+		sc.max_conflicts(100);
+		sc.precolor(0, 2);
+		sc.refine_iterations(500);
+		double cost = sc();
+		cout << "SAT coloring: cost " << cost << " with refinement" << endl;
+		if (sc.color(0) != 2)
+			return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file   test_TiledDecomposition.cpp
+ * @brief  test @ref limbo::algorithms::coloring::TiledDecomposition against coloring the whole layout
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <limbo/algorithms/coloring/TiledDecomposition.h>
+
+using std::cout;
+using std::endl;
+
+/// rectangle for the test
+struct Rect
+{
+	/// @nowarn
+	typedef int coordinate_type;
+	/// @endnowarn
+	int c[4]; ///< coordinates in the order of @ref limbo::geometry::direction_2d
+	/// @param d direction
+	/// @return coordinate
+	int get(limbo::geometry::direction_2d d) const {return c[d];}
+};
+
+/// @nowarn
+typedef limbo::algorithms::coloring::TiledDecomposition<Rect> decomposition_type;
+typedef decomposition_type::graph_type graph_type;
+/// @endnowarn
+
+/// rectangles in memory, scanned for each window
+struct Source
+{
+	std::vector<Rect> const& vRect; ///< rectangles
+	std::vector<uint32_t> const& vPolygon; ///< polygon of each rectangle
+	uint32_t calls; ///< number of windows read
+	/// constructor
+	/// @param vr rectangles
+	/// @param vp polygon of each rectangle
+	Source(std::vector<Rect> const& vr, std::vector<uint32_t> const& vp) : vRect(vr), vPolygon(vp), calls(0) {}
+	/// append rectangles overlapping a window
+	void operator()(int xl, int yl, int xh, int yh, std::vector<Rect>& vr, std::vector<boost::uint64_t>& vId, std::vector<uint32_t>& vp)
+	{
+		++calls;
+		for (uint32_t i = 0; i < vRect.size(); ++i)
+		{
+			Rect const& r = vRect[i];
+			if (r.c[0] <= xh && r.c[2] >= xl && r.c[1] <= yh && r.c[3] >= yl)
+			{
+				vr.push_back(r);
+				vId.push_back(i);
+				vp.push_back(vPolygon[i]);
+			}
+		}
+	}
+};
+
+/// colors received
+struct Sink
+{
+	std::vector<int8_t> vColor; ///< color of each rectangle
+	uint32_t calls; ///< number of colors received
+	/// constructor
+	/// @param n number of rectangles
+	Sink(uint32_t n) : vColor(n, -1), calls(0) {}
+	/// receive a color
+	void operator()(boost::uint64_t id, int8_t c)
+	{
+		++calls;
+		vColor[id] = c;
+	}
+};
+
+/// generate polygons of 1 to 3 abutting rectangles
+/// @param vRect rectangles
+/// @param vPolygon polygon of each rectangle
+/// @param numPolygons number of polygons
+/// @param extent side of the layout
+void randomLayout(std::vector<Rect>& vRect, std::vector<uint32_t>& vPolygon, uint32_t numPolygons, int extent)
+{
+	for (uint32_t p = 0; p < numPolygons; ++p)
+	{
+		int x = rand()%extent;
+		int y = rand()%extent;
+		uint32_t numRects = 1+rand()%3;
+		for (uint32_t i = 0; i < numRects; ++i)
+		{
+			Rect r;
+			int w = 10+rand()%40;
+			int h = 10+rand()%40;
+			r.c[limbo::geometry::LEFT] = x;
+			r.c[limbo::geometry::BOTTOM] = y;
+			r.c[limbo::geometry::RIGHT] = x+w;
+			r.c[limbo::geometry::TOP] = y+h;
+			vRect.push_back(r);
+			vPolygon.push_back(p);
+			if (rand()%2)
+				x += w;
+			else
+				y += h;
+		}
+	}
+}
+
+/// @param g graph
+/// @param vColor colors
+/// @param stitchWeight weight of stitches
+/// @return cost of the coloring
+double cost(graph_type const& g, std::vector<int8_t> const& vColor, double stitchWeight)
+{
+	double c = 0;
+	graph_type::edge_iterator ei, eie;
+	for (boost::tie(ei, eie) = edges(g); ei != eie; ++ei)
+	{
+		int8_t c1 = vColor[source(*ei, g)];
+		int8_t c2 = vColor[target(*ei, g)];
+		int32_t w = g.weight(*ei);
+		c += (w >= 0)? (c1 == c2)*w : -(c1 != c2)*w*stitchWeight;
+	}
+	return c;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+	int distance = 30;
+	int extent = 18000;
+	std::vector<Rect> vRect;
+	std::vector<uint32_t> vPolygon;
+	randomLayout(vRect, vPolygon, 20000, extent);
+
+	// the whole layout in one graph
+	limbo::algorithms::coloring::ConflictGraphBuilder<Rect> builder (distance);
+	for (uint32_t i = 0; i < vRect.size(); ++i)
+		builder.add(vRect[i], vPolygon[i]);
+	graph_type g;
+	builder(g);
+	limbo::algorithms::coloring::ComponentColoring<graph_type> cc (g);
+	cc.color_num(3);
+	double wholeCost = cc();
+
+	Rect box;
+	box.c[limbo::geometry::LEFT] = box.c[limbo::geometry::BOTTOM] = 0;
+	box.c[limbo::geometry::RIGHT] = box.c[limbo::geometry::TOP] = extent;
+	std::vector<int8_t> vColor;
+	for (int32_t threads = 1; threads <= 4; threads *= 4)
+	{
+		decomposition_type td (distance, 2000, distance+50);
+		td.color_num(3);
+		td.threads(threads);
+		Source source (vRect, vPolygon);
+		Sink sink (vRect.size());
+		clock_t start = clock();
+		double tiledCost = td(box, source, sink);
+		double tiledTime = double(clock()-start)/CLOCKS_PER_SEC;
+		cout << threads << " threads: cost = " << tiledCost << " by " << td.num_tiles() << " tiles with "
+			<< td.num_boundary_rectangles() << " boundary rectangles in " << tiledTime << " s, "
+			<< wholeCost << " for the whole layout" << endl;
+
+		if (source.calls != td.num_tiles() || sink.calls != vRect.size())
+		{
+			cout << source.calls << " windows read, " << sink.calls << " colors received" << endl;
+			return 1;
+		}
+		for (uint32_t i = 0; i < vRect.size(); ++i)
+		{
+			if (sink.vColor[i] < 0 || sink.vColor[i] >= 3)
+			{
+				cout << "rectangle " << i << " is not colored" << endl;
+				return 1;
+			}
+		}
+		double c = cost(g, sink.vColor, 0.1);
+		if (std::abs(c-tiledCost) > 1e-6 || tiledCost > wholeCost*1.2+1)
+		{
+			cout << "cost of colors " << c << endl;
+			return 1;
+		}
+		if (!vColor.empty() && vColor != sink.vColor)
+		{
+			cout << "colors depend on threads" << endl;
+			return 1;
+		}
+		vColor.swap(sink.vColor);
+	}
+	return 0;
+}
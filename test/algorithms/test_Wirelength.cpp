@@ -0,0 +1,344 @@
+/**
+ * @file   test_Wirelength.cpp
+ * @brief  test @ref limbo::algorithms::placement::Wirelength against wirelength computed by walking nets
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <limbo/algorithms/placement/Wirelength.h>
+#include <limbo/parsers/bookshelf/bison/BookshelfDataBase.h>
+#include <limbo/parsers/def/bison/DefDataBase.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+/// @nowarn
+typedef limbo::algorithms::placement::Wirelength<double> wirelength_type;
+/// @endnowarn
+
+/// nets as lists of pins for reference
+struct Netlist
+{
+	vector<vector<int> > vNetCell; ///< cells of pins of each net
+	vector<vector<double> > vNetOffsetX; ///< offsets of pins of each net in x direction
+	vector<vector<double> > vNetOffsetY; ///< offsets of pins of each net in y direction
+	vector<double> vWeight; ///< weight of each net
+
+	/// @return HPWL of a net
+	double net_hpwl(unsigned int n, vector<double> const& vX, vector<double> const& vY) const
+	{
+		if (vNetCell[n].empty())
+			return 0;
+		double xl = 1e100, xh = -1e100, yl = 1e100, yh = -1e100;
+		for (unsigned int i = 0; i < vNetCell[n].size(); ++i)
+		{
+			double x = vX[vNetCell[n][i]]+vNetOffsetX[n][i];
+			double y = vY[vNetCell[n][i]]+vNetOffsetY[n][i];
+			xl = std::min(xl, x);
+			xh = std::max(xh, x);
+			yl = std::min(yl, y);
+			yh = std::max(yh, y);
+		}
+		return vWeight[n]*((xh-xl)+(yh-yl));
+	}
+	/// @return HPWL of a placement
+	double hpwl(vector<double> const& vX, vector<double> const& vY) const
+	{
+		double total = 0;
+		for (unsigned int n = 0; n < vNetCell.size(); ++n)
+			total += net_hpwl(n, vX, vY);
+		return total;
+	}
+};
+
+/// generate a random netlist with empty nets, cells with several pins on a net and a large net
+/// @param numCells number of cells
+/// @param numNets number of nets
+/// @param netlist netlist for reference
+/// @param wl wirelength engine
+void generate(int numCells, int numNets, Netlist& netlist, wirelength_type& wl)
+{
+	for (int n = 0; n < numNets; ++n)
+	{
+		int degree = (n == numNets/2)? 20000 : (n%97 == 0)? 0 : 2+rand()%6;
+		double weight = (n%5 == 0)? 2 : 1;
+		netlist.vNetCell.push_back(vector<int>());
+		netlist.vNetOffsetX.push_back(vector<double>());
+		netlist.vNetOffsetY.push_back(vector<double>());
+		netlist.vWeight.push_back(weight);
+		wl.add_net(weight);
+		for (int i = 0; i < degree; ++i)
+		{
+			// some pins share cells in the same net
+			int c = (i > 0 && rand()%8 == 0)? netlist.vNetCell.back().back() : rand()%numCells;
+			double dx = rand()%3;
+			double dy = rand()%3;
+			netlist.vNetCell.back().push_back(c);
+			netlist.vNetOffsetX.back().push_back(dx);
+			netlist.vNetOffsetY.back().push_back(dy);
+			wl.add_pin(c, dx, dy);
+		}
+	}
+	wl.build();
+}
+
+/// compare full evaluation with the reference and among numbers of threads
+/// @return true if succeed
+bool testHpwl(Netlist const& netlist, wirelength_type& wl, vector<double> const& vX, vector<double> const& vY)
+{
+	double golden = netlist.hpwl(vX, vY);
+	wl.threads(1);
+	double single = wl.hpwl(vX, vY);
+	wl.threads(4);
+	double multi = wl.hpwl(vX, vY);
+	cout << "HPWL = " << golden << ", 1 thread " << single << ", 4 threads " << multi << endl;
+	if (std::abs(single-golden) > 1e-9*golden || single != multi)
+	{
+		cout << "HPWL differs" << endl;
+		return false;
+	}
+	return true;
+}
+
+/// random moves and swaps against the reference
+/// @return true if succeed
+bool testIncremental(Netlist const& netlist, wirelength_type& wl, vector<double> vX, vector<double> vY, int numOps)
+{
+	double total = wl.init(vX, vY);
+	if (std::abs(total-netlist.hpwl(vX, vY)) > 1e-9*total)
+	{
+		cout << "init " << total << " differs" << endl;
+		return false;
+	}
+	int numCells = vX.size();
+	for (int op = 0; op < numOps; ++op)
+	{
+		int c1 = rand()%numCells;
+		int c2 = rand()%numCells;
+		// positions on a coarse grid, so pins often share sides of boxes
+		double x = rand()%50;
+		double y = rand()%50;
+		double before = 0;
+		double after = 0;
+		double expect = 0;
+		double d = 0;
+		vector<unsigned int> vNet;
+		for (unsigned int n = 0; n < netlist.vNetCell.size(); ++n)
+		{
+			if (std::find(netlist.vNetCell[n].begin(), netlist.vNetCell[n].end(), c1) != netlist.vNetCell[n].end()
+					|| std::find(netlist.vNetCell[n].begin(), netlist.vNetCell[n].end(), c2) != netlist.vNetCell[n].end())
+				vNet.push_back(n);
+		}
+		for (unsigned int i = 0; i < vNet.size(); ++i)
+			before += netlist.net_hpwl(vNet[i], vX, vY);
+		if (op%2)
+		{
+			expect = wl.delta_swap(c1, c2);
+			std::swap(vX[c1], vX[c2]);
+			std::swap(vY[c1], vY[c2]);
+			d = wl.swap(c1, c2);
+		}
+		else
+		{
+			expect = wl.delta_move(c1, x, y);
+			vX[c1] = x;
+			vY[c1] = y;
+			d = wl.move(c1, x, y);
+		}
+		for (unsigned int i = 0; i < vNet.size(); ++i)
+			after += netlist.net_hpwl(vNet[i], vX, vY);
+		if (std::abs(d-(after-before)) > 1e-6 || d != expect)
+		{
+			cout << "operation " << op << " changes HPWL by " << d << ", expected " << after-before << endl;
+			return false;
+		}
+	}
+	double golden = netlist.hpwl(vX, vY);
+	cout << "after " << numOps << " moves and swaps, HPWL = " << wl.total() << ", expected " << golden << endl;
+	if (std::abs(wl.total()-golden) > 1e-6*golden)
+		return false;
+	// cached boxes are the ones from scratch
+	vector<wirelength_type::bound_type> vBoundX (wl.num_nets());
+	vector<wirelength_type::bound_type> vBoundY (wl.num_nets());
+	for (unsigned int n = 0; n < wl.num_nets(); ++n)
+	{
+		vBoundX[n] = wl.bound_x(n);
+		vBoundY[n] = wl.bound_y(n);
+	}
+	wl.init(vX, vY);
+	for (unsigned int n = 0; n < wl.num_nets(); ++n)
+	{
+		if (wl.net_pin_begin(n) == wl.net_pin_end(n))
+			continue;
+		wirelength_type::bound_type const& bx = wl.bound_x(n);
+		wirelength_type::bound_type const& by = wl.bound_y(n);
+		if (bx.lo != vBoundX[n].lo || bx.hi != vBoundX[n].hi || bx.count_lo != vBoundX[n].count_lo || bx.count_hi != vBoundX[n].count_hi
+				|| by.lo != vBoundY[n].lo || by.hi != vBoundY[n].hi || by.count_lo != vBoundY[n].count_lo || by.count_hi != vBoundY[n].count_hi)
+		{
+			cout << "bounding box of net " << n << " differs" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/// check smoothed wirelength against HPWL and gradients against finite differences
+/// @return true if succeed
+bool testSmooth(wirelength_type& wl, vector<double> vX, vector<double> vY)
+{
+	double hpwl = wl.hpwl(vX, vY);
+	wl.threads(4);
+	for (int m = 0; m < 2; ++m)
+	{
+		wirelength_type::smooth_model_type model = (m == 0)? wirelength_type::WEIGHTED_AVERAGE : wirelength_type::LOG_SUM_EXP;
+		char const* name = (m == 0)? "WA" : "LSE";
+		double coarse = wl.smooth_wirelength(vX, vY, 5.0, model);
+		double fine = wl.smooth_wirelength(vX, vY, 0.01, model);
+		cout << name << " wirelength = " << coarse << " with gamma 5, " << fine << " with gamma 0.01, HPWL = " << hpwl << endl;
+		// WA is below HPWL and LSE is above
+		if ((m == 0 && (coarse > hpwl || fine > hpwl)) || (m == 1 && (coarse < hpwl || fine < hpwl))
+				|| std::abs(fine-hpwl) > std::abs(coarse-hpwl))
+		{
+			cout << name << " wirelength does not approach HPWL" << endl;
+			return false;
+		}
+		vector<double> vGradX, vGradY;
+		double gamma = 2.0;
+		wl.smooth_wirelength(vX, vY, gamma, model, &vGradX, &vGradY);
+		for (int k = 0; k < 20; ++k)
+		{
+			int c = rand()%vX.size();
+			double h = 1e-5;
+			double x = vX[c];
+			vX[c] = x+h;
+			double up = wl.smooth_wirelength(vX, vY, gamma, model);
+			vX[c] = x-h;
+			double down = wl.smooth_wirelength(vX, vY, gamma, model);
+			vX[c] = x;
+			double y = vY[c];
+			vY[c] = y+h;
+			double upy = wl.smooth_wirelength(vX, vY, gamma, model);
+			vY[c] = y-h;
+			double downy = wl.smooth_wirelength(vX, vY, gamma, model);
+			vY[c] = y;
+			if (std::abs((up-down)/(2*h)-vGradX[c]) > 1e-4*(1+std::abs(vGradX[c])) || std::abs((upy-downy)/(2*h)-vGradY[c]) > 1e-4*(1+std::abs(vGradY[c])))
+			{
+				cout << name << " gradient of cell " << c << " = (" << vGradX[c] << ", " << vGradY[c] << "), finite difference ("
+					<< (up-down)/(2*h) << ", " << (upy-downy)/(2*h) << ")" << endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/// @brief offsets of pins of DEF components, (1, 2) for pin "A" and (3, 4) otherwise
+struct DefPinOffset
+{
+	/// set offset of a pin
+	void operator()(std::string const&, std::string const& pin, double& dx, double& dy) const
+	{
+		dx = (pin == "A")? 1 : 3;
+		dy = (pin == "A")? 2 : 4;
+	}
+};
+
+/// build nets from parser types
+/// @return true if succeed
+bool testParsers()
+{
+	std::map<std::string, unsigned int> mCell;
+	mCell["o0"] = 0;
+	mCell["o1"] = 1;
+	mCell["io"] = 2;
+	wirelength_type wl (3);
+
+	BookshelfParser::Net bnet;
+	std::string vNodeName[2] = {"o0", "unknown"};
+	std::string pinName = "Z";
+	bnet.vNetPin.push_back(BookshelfParser::NetPin(vNodeName[0], 'I', 0.5, -0.5, 0, 0));
+	// pins of BookshelfParser::BookshelfIndexDataBase refer to nodes by indices
+	bnet.vNetPin.push_back(BookshelfParser::NetPin(1, 'O', 1.5, 0.5, 0, 0, pinName));
+	bnet.vNetPin.push_back(BookshelfParser::NetPin(vNodeName[1], 'O', 0, 0, 0, 0));
+	wl.add_bookshelf_net(bnet, mCell);
+
+	DefParser::Net dnet;
+	dnet.vNetPin.push_back(std::make_pair(std::string("o0"), std::string("A")));
+	dnet.vNetPin.push_back(std::make_pair(std::string("o1"), std::string("Z")));
+	dnet.vNetPin.push_back(std::make_pair(std::string("PIN"), std::string("io")));
+	wl.add_def_net(dnet, mCell, DefPinOffset(), 2);
+	wl.build();
+
+	vector<double> vX (3), vY (3);
+	vX[0] = 0; vY[0] = 0;
+	vX[1] = 10; vY[1] = 5;
+	vX[2] = -4; vY[2] = 20;
+	// bookshelf: x in [0.5, 11.5], y in [-0.5, 5.5]; def: x in [-4, 13], y in [2, 20]
+	double expect = (11+6)+2*(17+18);
+	double total = wl.hpwl(vX, vY);
+	cout << "nets from parsers: " << wl.num_nets() << " nets, " << wl.num_pins() << " pins, HPWL = " << total << endl;
+	return wl.num_pins() == 5 && total == expect;
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+	srand(1);
+	int numCells = 20000;
+	Netlist netlist;
+	wirelength_type wl (numCells);
+	generate(numCells, 30000, netlist, wl);
+	cout << wl.num_nets() << " nets, " << wl.num_pins() << " pins" << endl;
+	vector<double> vX (numCells), vY (numCells);
+	for (int c = 0; c < numCells; ++c)
+	{
+		vX[c] = rand()%1000;
+		vY[c] = rand()%1000;
+	}
+	if (!testHpwl(netlist, wl, vX, vY))
+		return 1;
+	// a small netlist for incremental updates checked against nets of the moved cells
+	Netlist small;
+	wirelength_type swl (200);
+	for (int n = 0; n < 400; ++n)
+	{
+		int degree = (n%50 == 0)? 0 : 2+rand()%5;
+		small.vNetCell.push_back(vector<int>());
+		small.vNetOffsetX.push_back(vector<double>());
+		small.vNetOffsetY.push_back(vector<double>());
+		small.vWeight.push_back(1+n%3);
+		swl.add_net(1+n%3);
+		for (int i = 0; i < degree; ++i)
+		{
+			int c = (i > 0 && rand()%6 == 0)? small.vNetCell.back().back() : rand()%200;
+			double dx = rand()%2;
+			small.vNetCell.back().push_back(c);
+			small.vNetOffsetX.back().push_back(dx);
+			small.vNetOffsetY.back().push_back(0);
+			swl.add_pin(c, dx, 0);
+		}
+	}
+	swl.build();
+	vector<double> vSmallX (200), vSmallY (200);
+	for (int c = 0; c < 200; ++c)
+	{
+		vSmallX[c] = rand()%50;
+		vSmallY[c] = rand()%50;
+	}
+	if (!testIncremental(small, swl, vSmallX, vSmallY, 20000))
+		return 1;
+	if (!testIncremental(netlist, wl, vX, vY, 200))
+		return 1;
+	if (!testSmooth(swl, vSmallX, vSmallY))
+		return 1;
+	if (!testParsers())
+		return 1;
+	return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file   test_DisjointSet.cpp
+ * @brief  test the sequential and the concurrent disjoint sets, see @ref limbo::containers::DisjointSet
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <limbo/containers/DisjointSet.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @nowarn
+typedef limbo::containers::DisjointSet disjoint_set_type;
+typedef disjoint_set_type::SubsetHelper<unsigned int, unsigned int> subset_helper_type;
+typedef std::pair<unsigned int, unsigned int> edge_type;
+/// @endnowarn
+
+/// @brief main function 
+/// @return 0 
+int main()
+{
+	// union_set() reports whether two subsets are merged 
+	{
+		std::vector<unsigned int> vParent (4);
+		std::vector<unsigned int> vRank (4);
+		subset_helper_type gp (vParent, vRank);
+		limboAssertMsg(disjoint_set_type::union_set(gp, 0, 1), "union_set failed to merge different subsets");
+		limboAssertMsg(!disjoint_set_type::union_set(gp, 1, 0), "union_set merged the same subset");
+		limboAssertMsg(disjoint_set_type::count_sets(gp) == 3, "%u subsets instead of 3", (unsigned int)disjoint_set_type::count_sets(gp));
+	}
+
+	// a chain far deeper than the stack allows for recursive finds 
+	{
+		unsigned int n = 1000000;
+		std::vector<unsigned int> vParent (n);
+		std::vector<unsigned int> vRank (n);
+		subset_helper_type gp (vParent, vRank);
+		for (unsigned int i = 1; i < n; ++i)
+			gp.set_parent(i, i-1);
+		limboAssertMsg(disjoint_set_type::find_set(gp, n-1) == 0, "find_set failed on a long chain");
+		limboAssertMsg(disjoint_set_type::find_set_compress(gp, n-1) == 0, "find_set_compress failed on a long chain");
+		limboAssertMsg(disjoint_set_type::union_set(gp, n-1, n/2) == false, "union_set merged elements of the same chain");
+	}
+
+	// concurrent unions give the same subsets as sequential unions 
+	srand(1);
+	unsigned int n = 200000;
+	std::vector<edge_type> vEdge;
+	for (unsigned int i = 0; i < n*3/4; ++i)
+		vEdge.push_back(edge_type(rand()%n, rand()%n));
+	for (unsigned int i = 1; i < 1000; ++i) // a long path in reverse order 
+		vEdge.push_back(edge_type(n-i, n-i-1));
+
+	std::vector<unsigned int> vParent (n);
+	std::vector<unsigned int> vRank (n);
+	subset_helper_type gp (vParent, vRank);
+	std::size_t numMerges = disjoint_set_type::union_sets(gp, vEdge.begin(), vEdge.end());
+	std::size_t numSets = disjoint_set_type::count_sets(gp);
+	limboAssertMsg(numSets+numMerges == n, "%u subsets after %u merges of %u elements", (unsigned int)numSets, (unsigned int)numMerges, n);
+	// smallest element of each sequential subset 
+	std::vector<unsigned int> vSmallest (n, n);
+	for (unsigned int i = 0; i < n; ++i)
+	{
+		unsigned int root = disjoint_set_type::find_set(gp, i);
+		vSmallest[root] = std::min(vSmallest[root], i);
+	}
+
+	// more threads than processors, so threads interleave even on a single processor 
+	limbo::containers::set_num_threads(8);
+	for (unsigned int numThreads = 1; numThreads <= 8; numThreads *= 2)
+	{
+		limbo::containers::ConcurrentDisjointSet<unsigned int> ds (n);
+		std::size_t numConcurrentMerges = ds.union_sets(vEdge.begin(), vEdge.end(), numThreads);
+		limboAssertMsg(numConcurrentMerges == numMerges, "%u merges with %u threads instead of %u", (unsigned int)numConcurrentMerges, numThreads, (unsigned int)numMerges);
+		std::vector<unsigned int> vSet;
+		limboAssertMsg(ds.get_sets(vSet) == numSets, "different number of subsets with %u threads", numThreads);
+		limboAssertMsg(ds.count_sets() == numSets, "count_sets differs from get_sets with %u threads", numThreads);
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			limboAssertMsg(vSet[i] == vSmallest[disjoint_set_type::find_set(gp, i)], "subset of %u differs with %u threads", i, numThreads);
+			limboAssertMsg(ds.find_set(i) == vSet[i], "find_set of %u differs from get_sets with %u threads", i, numThreads);
+		}
+	}
+	limbo::containers::set_num_threads(0);
+
+	std::cout << n << " elements, " << vEdge.size() << " edges, " << numSets << " subsets" << std::endl;
+	return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file   test_FlatHashMap.cpp
+ * @brief  test the open-addressing hash map against a std::map, and the string interner from many threads, 
+ * see @ref limbo::containers::FlatHashMap and @ref limbo::containers::StringInterner
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include <limbo/containers/FlatHashMap.h>
+#include <limbo/containers/StringInterner.h>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief a poor hash putting keys in a few runs of slots, so probes are long and erasure shifts many entries
+struct CollidingHash
+{
+	/// @return hash value
+	std::size_t operator()(int key) const {return (std::size_t)(key%7);}
+};
+
+/// @brief random operations on a map, checked against a std::map
+/// @tparam MapType FlatHashMap type of int keys and values
+/// @param numKeys range of keys
+/// @param numOps number of operations
+template <typename MapType>
+void testRandom(int numKeys, unsigned int numOps)
+{
+	MapType map;
+	std::map<int, int> ref;
+	for (unsigned int op = 0; op < numOps; ++op)
+	{
+		int key = rand()%numKeys;
+		switch (rand()%4)
+		{
+			case 0:
+				{
+					bool inserted = map.insert(std::make_pair(key, (int)op)).second;
+					limboAssertMsg(inserted == ref.insert(std::make_pair(key, (int)op)).second, "insert of %d differs", key);
+				}
+				break;
+			case 1:
+				map[key] = op;
+				ref[key] = op;
+				break;
+			case 2:
+				limboAssertMsg(map.erase(key) == ref.erase(key), "erase of %d differs", key);
+				break;
+			default:
+				{
+					typename MapType::const_iterator it = map.find(key);
+					std::map<int, int>::const_iterator itRef = ref.find(key);
+					limboAssertMsg((it == map.end()) == (itRef == ref.end()), "find of %d differs", key);
+					limboAssertMsg(it == map.end() || it->second == itRef->second, "value of %d differs", key);
+				}
+				break;
+		}
+		limboAssertMsg(map.size() == ref.size(), "size %u instead of %u at operation %u", (unsigned int)map.size(), (unsigned int)ref.size(), op);
+	}
+	// iteration visits every entry once 
+	std::map<int, int> visited;
+	for (typename MapType::const_iterator it = map.begin(); it != map.end(); ++it)
+		limboAssertMsg(visited.insert(*it).second, "key %d visited twice", it->first);
+	limboAssertMsg(visited == ref, "entries differ from the reference");
+	map.clear();
+	limboAssertMsg(map.empty() && map.begin() == map.end(), "map is not empty after clear");
+}
+
+/// @brief insert names into an interner in blocks of indices 
+struct InternKernel
+{
+	limbo::containers::StringInterner* pInterner; ///< interner 
+	std::vector<std::string> const* pName; ///< names, with duplicates 
+	std::vector<unsigned int>* pId; ///< id of each name as output 
+	/// @param b first name 
+	/// @param e end name 
+	void operator()(std::size_t b, std::size_t e) const
+	{
+		for (; b < e; ++b)
+			(*pId)[b] = pInterner->find_or_insert((*pName)[b]);
+	}
+};
+
+/// @brief intern names with duplicates from several threads 
+/// @param numThreads number of threads 
+void testInterner(unsigned int numThreads)
+{
+	std::vector<std::string> vName;
+	char buf[64];
+	for (unsigned int i = 0; i < 20000; ++i)
+	{
+		sprintf(buf, "net_%u", rand()%5000);
+		vName.push_back(buf);
+	}
+	// longer than a block, so it gets a block of its own 
+	vName.push_back(std::string(300, 'x'));
+	vName.push_back("");
+
+	limbo::containers::StringInterner interner (256);
+	std::vector<unsigned int> vId (vName.size());
+	InternKernel kernel = {&interner, &vName, &vId};
+	limbo::containers::parallel_for(0, vName.size(), 64, numThreads, kernel);
+
+	std::map<std::string, unsigned int> mId;
+	for (std::size_t i = 0; i < vName.size(); ++i)
+	{
+		std::pair<std::map<std::string, unsigned int>::iterator, bool> found = mId.insert(std::make_pair(vName[i], vId[i]));
+		limboAssertMsg(found.first->second == vId[i], "%s has ids %u and %u", vName[i].c_str(), found.first->second, vId[i]);
+		limboAssertMsg(interner.str(vId[i]) == vName[i], "str of id %u is not %s", vId[i], vName[i].c_str());
+		unsigned int id = 0;
+		limboAssertMsg(interner.find(vName[i], id) && id == vId[i], "find of %s failed", vName[i].c_str());
+	}
+	limboAssertMsg(interner.size() == mId.size(), "%u strings interned instead of %u", (unsigned int)interner.size(), (unsigned int)mId.size());
+	// ids are dense 
+	std::vector<bool> vUsed (mId.size(), false);
+	for (std::map<std::string, unsigned int>::const_iterator it = mId.begin(); it != mId.end(); ++it)
+	{
+		limboAssertMsg(it->second < vUsed.size() && !vUsed[it->second], "id %u is out of range or repeated", it->second);
+		vUsed[it->second] = true;
+	}
+	unsigned int id = 0;
+	limboAssertMsg(!interner.find("no_such_net", id), "found a string never inserted");
+}
+
+/// @brief main function 
+/// @return 0 
+int main()
+{
+	srand(1);
+	testRandom<limbo::containers::FlatHashMap<int, int> >(1000, 200000);
+	testRandom<limbo::containers::FlatHashMap<int, int, CollidingHash> >(300, 50000);
+
+	// more threads than processors, so threads interleave even on a single processor 
+	limbo::containers::set_num_threads(8);
+	testInterner(1);
+	testInterner(8);
+	limbo::containers::set_num_threads(0);
+
+	std::cout << "flat hash map tests passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file   test_IndexedHeap.cpp
+ * @brief  test the d-ary heap and the bucket queue against a std::set, see @ref IndexedHeap.h
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <cstdlib>
+#include <limbo/containers/IndexedHeap.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief compare elements by priorities in an array, which change between updates
+struct PriorityCompare
+{
+	std::vector<int> const* pPriority; ///< priority of each element
+	/// @return true if element \a a has a lower priority than element \a b
+	bool operator()(unsigned int a, unsigned int b) const {return (*pPriority)[a] < (*pPriority)[b];}
+};
+
+/// @nowarn
+typedef limbo::containers::DaryHeap<unsigned int, PriorityCompare> heap_type;
+typedef limbo::containers::BucketQueue<int> bucket_type;
+typedef std::set<std::pair<int, unsigned int> > reference_type;
+/// @endnowarn
+
+/// @brief random inserts, erases, updates and pops on both queues, checked against a std::set
+/// @param n number of elements
+/// @param numOps number of operations
+void testRandom(unsigned int n, unsigned int numOps)
+{
+	int maxPriority = 50;
+	std::vector<int> vPriority (n, 0);
+	PriorityCompare comp = {&vPriority};
+	heap_type heap (comp);
+	heap.reserve(n, n);
+	bucket_type bucket (n, -maxPriority, maxPriority);
+	reference_type ref;
+
+	for (unsigned int op = 0; op < numOps; ++op)
+	{
+		unsigned int e = rand()%n;
+		int p = rand()%(2*maxPriority+1)-maxPriority;
+		bool in = ref.count(std::make_pair(vPriority[e], e));
+		limboAssertMsg(heap.count(e) == in && bucket.count(e) == in, "count of %u differs at operation %u", e, op);
+		switch (rand()%4)
+		{
+			case 0: // insert or update 
+				if (in)
+				{
+					ref.erase(std::make_pair(vPriority[e], e));
+					vPriority[e] = p;
+					limboAssertMsg(heap.update(e) && bucket.update(e, p), "update of %u failed", e);
+				}
+				else
+				{
+					vPriority[e] = p;
+					heap.insert(e);
+					bucket.insert(e, p);
+				}
+				ref.insert(std::make_pair(p, e));
+				break;
+			case 1: // erase 
+				limboAssertMsg(heap.erase(e) == in && bucket.erase(e) == in, "erase of %u differs", e);
+				ref.erase(std::make_pair(vPriority[e], e));
+				break;
+			case 2: // pop, both queues hold the same elements and may pick different ones of the lowest priority 
+				if (!ref.empty())
+				{
+					limboAssertMsg(vPriority[heap.top()] == ref.begin()->first, "heap top has priority %d instead of %d", vPriority[heap.top()], ref.begin()->first);
+					limboAssertMsg(bucket.top_priority() == ref.begin()->first, "bucket top has priority %d instead of %d", bucket.top_priority(), ref.begin()->first);
+					unsigned int t = heap.top();
+					heap.pop();
+					bucket.erase(t);
+					ref.erase(std::make_pair(vPriority[t], t));
+				}
+				break;
+			default: // insert element in a lower priority than the cursor of the bucket queue 
+				if (!in)
+				{
+					vPriority[e] = -maxPriority;
+					heap.insert(e);
+					bucket.insert(e, -maxPriority);
+					ref.insert(std::make_pair(-maxPriority, e));
+				}
+				break;
+		}
+		limboAssertMsg(heap.size() == ref.size() && bucket.size() == ref.size(), "sizes differ at operation %u", op);
+	}
+
+	// drain in order of priorities 
+	int last = -maxPriority;
+	while (!heap.empty())
+	{
+		unsigned int t = heap.top();
+		limboAssertMsg(vPriority[t] >= last, "heap pops priority %d after %d", vPriority[t], last);
+		last = vPriority[t];
+		heap.pop();
+	}
+	last = -maxPriority;
+	while (!bucket.empty())
+	{
+		limboAssertMsg(bucket.top_priority() >= last, "bucket pops priority %d after %d", bucket.top_priority(), last);
+		last = bucket.top_priority();
+		bucket.pop();
+	}
+}
+
+/// @brief main function 
+/// @return 0 
+int main()
+{
+	// the element inserted last comes first among equal priorities of a bucket 
+	bucket_type bucket (4, 0, 3);
+	bucket.insert(0, 2);
+	bucket.insert(1, 2);
+	bucket.insert(2, 3);
+	limboAssertMsg(bucket.top() == 1, "bucket top is %u instead of the last inserted 1", (unsigned int)bucket.top());
+	bucket.update(2, 1);
+	limboAssertMsg(bucket.top() == 2 && bucket.top_priority() == 1, "bucket top is not the updated element");
+
+	srand(1);
+	testRandom(64, 100000);
+	testRandom(5000, 200000);
+	std::cout << "indexed heap tests passed" << std::endl;
+	return 0;
+}
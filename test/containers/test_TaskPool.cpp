@@ -0,0 +1,283 @@
+/**
+ * @file   test_TaskPool.cpp
+ * @brief  test the task pool, the free parallel_for and the bounded queue, 
+ * see @ref limbo::containers::TaskPool and @ref limbo::containers::BoundedQueue
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <unistd.h>
+#include <pthread.h>
+#include <limbo/containers/TaskPool.h>
+#include <limbo/containers/BoundedQueue.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+using limbo::containers::TaskPool;
+using limbo::containers::TaskFuture;
+using limbo::containers::BoundedQueue;
+
+/// @brief a node of a binary tree of tasks, each waiting for its children 
+struct TreeTask
+{
+	TaskPool* pool; ///< pool 
+	unsigned int depth; ///< levels below the node 
+	unsigned long count; ///< number of nodes of the subtree as output 
+};
+
+/// @brief submit both children, wait for them and count the nodes of the subtree 
+/// @param arg TreeTask 
+void countTree(void* arg)
+{
+	TreeTask& task = *static_cast<TreeTask*>(arg);
+	task.count = 1;
+	if (task.depth == 0)
+		return;
+	TreeTask vChild[2] = {{task.pool, task.depth-1, 0}, {task.pool, task.depth-1, 0}};
+	TaskFuture vFuture[2];
+	for (int i = 0; i < 2; ++i)
+		vFuture[i] = task.pool->submit(countTree, &vChild[i]);
+	// waiting runs other tasks, so nested waits on few workers do not deadlock 
+	for (int i = 0; i < 2; ++i)
+	{
+		vFuture[i].wait();
+		task.count += vChild[i].count;
+	}
+}
+
+/// @brief a task recording the thread running it 
+struct ThreadTask
+{
+	pthread_t thread; ///< thread running the task as output 
+	unsigned int runs; ///< number of runs as output 
+};
+
+/// @brief record the thread and stay a while, so idle workers have time to steal 
+/// @param arg ThreadTask 
+void recordThread(void* arg)
+{
+	ThreadTask& task = *static_cast<ThreadTask*>(arg);
+	task.thread = pthread_self();
+	__sync_fetch_and_add(&task.runs, 1);
+	usleep(1000);
+}
+
+/// @brief tasks submitted by a worker go to its own deque 
+struct SpawnTask
+{
+	TaskPool* pool; ///< pool 
+	std::vector<ThreadTask>* pChild; ///< children 
+};
+
+/// @brief submit all children from a worker and wait for them 
+/// @param arg SpawnTask 
+void spawnChildren(void* arg)
+{
+	SpawnTask& task = *static_cast<SpawnTask*>(arg);
+	std::vector<TaskFuture> vFuture (task.pChild->size());
+	for (std::size_t i = 0; i < vFuture.size(); ++i)
+		vFuture[i] = task.pool->submit(recordThread, &(*task.pChild)[i]);
+	for (std::size_t i = 0; i < vFuture.size(); ++i)
+		vFuture[i].wait();
+}
+
+/// @brief count visits of indices by blocks 
+struct CoverKernel
+{
+	std::vector<unsigned int>* pVisit; ///< visits of each index 
+	std::size_t grain; ///< expected size of blocks 
+	std::size_t last; ///< end of the range 
+	/// @param b first index 
+	/// @param e end index 
+	void operator()(std::size_t b, std::size_t e) const
+	{
+		limboAssertMsg(e > b && e-b <= grain && (e-b == grain || e == last), "block [%u, %u) of grain %u", (unsigned int)b, (unsigned int)e, (unsigned int)grain);
+		for (; b < e; ++b)
+			__sync_fetch_and_add(&(*pVisit)[b], 1);
+	}
+};
+
+/// @brief check that blocks cover [first, last) exactly once 
+/// @param vVisit visits of each index 
+/// @param first first index 
+/// @param last end index 
+void checkCover(std::vector<unsigned int>& vVisit, std::size_t first, std::size_t last)
+{
+	for (std::size_t i = 0; i < vVisit.size(); ++i)
+		limboAssertMsg(vVisit[i] == (i >= first && i < last), "index %u visited %u times", (unsigned int)i, vVisit[i]);
+	std::fill(vVisit.begin(), vVisit.end(), 0);
+}
+
+/// @brief blocks in the order they are taken by a single thread 
+struct OrderKernel
+{
+	std::vector<std::size_t>* pFirst; ///< first index of each block as output 
+	/// @param b first index 
+	void operator()(std::size_t b, std::size_t) const {pFirst->push_back(b);}
+};
+
+/// @brief a producer or a consumer of a queue 
+struct QueueTask
+{
+	BoundedQueue<unsigned int>* queue; ///< queue 
+	unsigned int producer; ///< index of the producer 
+	unsigned int count; ///< number of elements to push or pop 
+	std::vector<unsigned int> vValue; ///< popped elements as output 
+};
+
+/// @brief push elements producer*count+0, 1, ..., count-1 in order 
+/// @param arg QueueTask 
+/// @return NULL 
+void* produce(void* arg)
+{
+	QueueTask& task = *static_cast<QueueTask*>(arg);
+	for (unsigned int i = 0; i < task.count; ++i)
+		task.queue->push(task.producer*task.count+i);
+	return NULL;
+}
+
+/// @brief pop count elements 
+/// @param arg QueueTask 
+/// @return NULL 
+void* consume(void* arg)
+{
+	QueueTask& task = *static_cast<QueueTask*>(arg);
+	for (unsigned int i = 0; i < task.count; ++i)
+	{
+		unsigned int v = 0;
+		task.queue->pop(v);
+		task.vValue.push_back(v);
+	}
+	return NULL;
+}
+
+/// @brief main function 
+/// @return 0 
+int main()
+{
+	// thread budget 
+	unsigned int numHardware = limbo::containers::hardware_threads();
+	limbo::containers::set_num_threads(3);
+	limboAssertMsg(limbo::containers::num_threads() == 3, "num_threads ignores set_num_threads");
+	limbo::containers::set_num_threads(0);
+	limboAssertMsg(limbo::containers::num_threads() == numHardware, "num_threads is not restored to the processors");
+
+	// nested waits: a tree of 2^13-1 tasks, each waiting for its children, on 2 workers 
+	{
+		TaskPool pool (2);
+		TreeTask root = {&pool, 12, 0};
+		pool.submit(countTree, &root).wait();
+		limboAssertMsg(root.count == (1UL << 13)-1, "tree of %lu tasks instead of %lu", root.count, (1UL << 13)-1);
+	}
+
+	// work stealing: children submitted by one worker are run by other workers as well 
+	{
+		TaskPool pool (4);
+		std::vector<ThreadTask> vChild (64);
+		for (std::size_t i = 0; i < vChild.size(); ++i)
+			vChild[i].runs = 0;
+		SpawnTask spawn = {&pool, &vChild};
+		pool.submit(spawnChildren, &spawn);
+		pool.wait();
+		std::set<pthread_t> sThread;
+		for (std::size_t i = 0; i < vChild.size(); ++i)
+		{
+			limboAssertMsg(vChild[i].runs == 1, "child %u ran %u times", (unsigned int)i, vChild[i].runs);
+			sThread.insert(vChild[i].thread);
+		}
+		limboAssertMsg(sThread.size() > 1, "no child of a worker was stolen");
+		std::cout << "64 children of a worker run by " << sThread.size() << " threads" << std::endl;
+	}
+
+	// parallel_for covers a range exactly once for any grain and number of threads 
+	{
+		std::size_t n = 10000;
+		std::vector<unsigned int> vVisit (n+100, 0);
+		TaskPool pool (3);
+		std::size_t vGrain[] = {1, 7, 1000, 20000};
+		for (unsigned int g = 0; g < sizeof(vGrain)/sizeof(vGrain[0]); ++g)
+		{
+			CoverKernel kernel = {&vVisit, vGrain[g], n+50};
+			pool.parallel_for(50, n+50, vGrain[g], kernel);
+			checkCover(vVisit, 50, n+50);
+			for (unsigned int t = 1; t <= 4; ++t)
+			{
+				pool.parallel_for(50, n+50, vGrain[g], t, kernel);
+				checkCover(vVisit, 50, n+50);
+			}
+			for (unsigned int t = 0; t <= 8; t += 4)
+			{
+				limbo::containers::parallel_for(50, n+50, vGrain[g], t, kernel);
+				checkCover(vVisit, 50, n+50);
+			}
+		}
+		// an empty range has no block 
+		CoverKernel kernel = {&vVisit, 1, 0};
+		limbo::containers::parallel_for(10, 10, 1, 4, kernel);
+		pool.parallel_for(10, 5, 1, kernel);
+		checkCover(vVisit, 0, 0);
+		// a single thread takes blocks in increasing order 
+		std::vector<std::size_t> vFirst;
+		OrderKernel order = {&vFirst};
+		limbo::containers::parallel_for(0, 100, 10, 1, order);
+		for (std::size_t i = 0; i < vFirst.size(); ++i)
+			limboAssertMsg(vFirst[i] == i*10, "block %u starts at %u", (unsigned int)i, (unsigned int)vFirst[i]);
+		limboAssertMsg(vFirst.size() == 10, "%u blocks instead of 10", (unsigned int)vFirst.size());
+	}
+
+	// bounded queue 
+	{
+		BoundedQueue<unsigned int> queue (5);
+		limboAssertMsg(queue.capacity() == 8, "capacity %u instead of 8", (unsigned int)queue.capacity());
+		unsigned int v = 0;
+		limboAssertMsg(!queue.try_pop(v), "popped from an empty queue");
+		for (unsigned int i = 0; i < 8; ++i)
+			limboAssertMsg(queue.try_push(i), "failed to push %u", i);
+		limboAssertMsg(!queue.try_push(8), "pushed to a full queue");
+		limboAssertMsg(queue.size_approx() == 8, "size %u instead of 8", (unsigned int)queue.size_approx());
+		for (unsigned int i = 0; i < 8; ++i)
+			limboAssertMsg(queue.try_pop(v) && v == i, "popped %u instead of %u", v, i);
+		limboAssertMsg(!queue.try_pop(v), "popped from an empty queue");
+	}
+
+	// many producers and consumers through a small ring: nothing lost or duplicated, 
+	// and elements of a producer reach each consumer in the order pushed 
+	{
+		unsigned int numProducers = 4;
+		unsigned int numConsumers = 4;
+		unsigned int count = 20000;
+		BoundedQueue<unsigned int> queue (16);
+		std::vector<QueueTask> vTask (numProducers+numConsumers);
+		std::vector<pthread_t> vThread (vTask.size());
+		for (unsigned int i = 0; i < vTask.size(); ++i)
+		{
+			vTask[i].queue = &queue;
+			vTask[i].producer = i;
+			vTask[i].count = count;
+			limboAssertMsg(pthread_create(&vThread[i], NULL, (i < numProducers)? produce : consume, &vTask[i]) == 0, "failed to create thread %u", i);
+		}
+		for (unsigned int i = 0; i < vThread.size(); ++i)
+			pthread_join(vThread[i], NULL);
+		std::vector<unsigned int> vSeen (numProducers*count, 0);
+		for (unsigned int c = numProducers; c < vTask.size(); ++c)
+		{
+			std::vector<unsigned int> vLast (numProducers, 0);
+			std::vector<bool> vAny (numProducers, false);
+			for (std::size_t i = 0; i < vTask[c].vValue.size(); ++i)
+			{
+				unsigned int value = vTask[c].vValue[i];
+				unsigned int p = value/count;
+				limboAssertMsg(!vAny[p] || value > vLast[p], "consumer %u popped %u after %u", c, value, vLast[p]);
+				vAny[p] = true;
+				vLast[p] = value;
+				++vSeen[value];
+			}
+		}
+		for (std::size_t i = 0; i < vSeen.size(); ++i)
+			limboAssertMsg(vSeen[i] == 1, "element %u popped %u times", (unsigned int)i, vSeen[i]);
+	}
+
+	std::cout << "task pool tests passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,328 @@
+/**
+ * @file   bench_p2r.cpp
+ * @brief  benchmark polygon-to-rectangle engines on large synthetic manhattan polygons
+ *
+ * Polygons are generated with a given number of vertices in three families:
+ * staircase, i.e., between random lower and upper staircases;
+ * holes, i.e., a rectangle with a hole in each row, given as one contour with duplicate points;
+ * comb, i.e., teeth of random heights on a bar, with many chords between concave vertices.
+ * Each engine reports time of the best run, number of rectangles, and heap allocations of one run.
+ * Engines giving the same rectangles as @ref limbo::geometry::Polygon2Rectangle are checked against each other,
+ * so the benchmark fails on a regression of the output.
+ *
+ * @date   Oct 2026
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <vector>
+#include <list>
+#include <set>
+#include <string>
+#include <iterator>
+#include <algorithm>
+#include <boost/polygon/polygon.hpp>
+#include <limbo/geometry/Polygon2Rectangle.h>
+#include <limbo/geometry/api/BoostPolygonApi.h>
+#include <limbo/geometry/api/GeoBoostPolygonApi.h>
+
+namespace gtl = boost::polygon;
+namespace lg = limbo::geometry;
+
+/// point type
+typedef gtl::point_data<int> Point;
+/// rectangle type
+typedef gtl::rectangle_data<int> Rectangle;
+
+/// number of heap allocations
+static std::size_t g_numAllocs = 0;
+/// bytes of heap allocations
+static std::size_t g_allocBytes = 0;
+
+// replacing both functions in this file makes gcc see malloc and free through new and delete
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+/// @nowarn
+void* operator new(std::size_t size)
+{
+    ++g_numAllocs;
+    g_allocBytes += size;
+    void* p = malloc(size? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) throw() {free(p);}
+/// @endnowarn
+
+/// @brief random polygon between a lower and an upper staircase
+/// @param n number of vertices
+/// @return vertices
+std::vector<Point> staircase(std::size_t n)
+{
+    std::vector<Point> vLow, vHigh;
+    int x = 0, low = 0, high = 10;
+    for (std::size_t i = 0; i < std::max(n/4, (std::size_t)1); ++i)
+    {
+        int xn = x+1+rand()%5;
+        vLow.push_back(Point(x, low));
+        vLow.push_back(Point(xn, low));
+        vHigh.push_back(Point(x, high));
+        vHigh.push_back(Point(xn, high));
+        // neighbor steps overlap so that the polygon is connected
+        int lown = low+rand()%20-10;
+        int highn = std::max(lown, low)+1+rand()%20;
+        if (lown >= high) lown = high-1;
+        low = lown;
+        high = highn;
+        x = xn;
+    }
+    std::vector<Point> vPoint (vLow.begin(), vLow.end());
+    vPoint.insert(vPoint.end(), vHigh.rbegin(), vHigh.rend());
+    return vPoint;
+}
+
+/// @brief a rectangle with a hole in each row, holes are reached from the left edge through duplicate points
+/// @param n number of vertices
+/// @return vertices
+std::vector<Point> holes(std::size_t n)
+{
+    int numHoles = std::max((int)(n/7), 1);
+    int width = 1000;
+    std::vector<Point> vPoint;
+    vPoint.push_back(Point(0, 0));
+    vPoint.push_back(Point(width, 0));
+    vPoint.push_back(Point(width, 4*numHoles+1));
+    vPoint.push_back(Point(0, 4*numHoles+1));
+    for (int i = numHoles-1; i >= 0; --i)
+    {
+        int xl = 1+rand()%(width/2), xh = xl+1+rand()%(width/2-1), yl = 4*i+1, yh = 4*i+3;
+        vPoint.push_back(Point(0, yl));
+        vPoint.push_back(Point(xl, yl));
+        vPoint.push_back(Point(xl, yh));
+        vPoint.push_back(Point(xh, yh));
+        vPoint.push_back(Point(xh, yl));
+        vPoint.push_back(Point(xl, yl));
+        vPoint.push_back(Point(0, yl));
+    }
+    return vPoint;
+}
+
+/// @brief teeth of random heights on a bar
+/// @param n number of vertices
+/// @return vertices
+std::vector<Point> comb(std::size_t n)
+{
+    int numTeeth = std::max((int)(n/4), 2);
+    int width = 2*numTeeth-1;
+    std::vector<Point> vPoint;
+    vPoint.push_back(Point(0, 0));
+    vPoint.push_back(Point(width, 0));
+    for (int i = numTeeth-1; i >= 0; --i)
+    {
+        int h = 10+5*(1+rand()%4);
+        if (i < numTeeth-1)
+            vPoint.push_back(Point(2*i+1, 10));
+        vPoint.push_back(Point(2*i+1, h));
+        vPoint.push_back(Point(2*i, h));
+        if (i > 0)
+            vPoint.push_back(Point(2*i, 10));
+    }
+    return vPoint;
+}
+
+/// @brief result of an engine
+struct Result
+{
+    bool success; ///< true if conversion succeeds
+    double best; ///< seconds of the best run
+    std::size_t numRects; ///< number of rectangles
+    long long area; ///< total area of rectangles
+    std::size_t numAllocs; ///< heap allocations of one run
+    std::size_t allocBytes; ///< bytes of heap allocations of one run
+};
+
+/// @brief run an engine several times
+/// @tparam Engine callable with vertices and rectangles, returning true if succeed
+/// @param engine engine
+/// @param vPoint vertices
+/// @param numRuns number of runs
+/// @return result
+template <typename Engine>
+Result run(Engine engine, std::vector<Point> const& vPoint, int numRuns)
+{
+    Result result;
+    result.best = 1e30;
+    for (int r = 0; r < numRuns; ++r)
+    {
+        std::vector<Rectangle> vRect;
+        vRect.reserve(vPoint.size());
+        std::size_t numAllocs = g_numAllocs, allocBytes = g_allocBytes;
+        clock_t t0 = clock();
+        result.success = engine(vPoint, vRect);
+        clock_t t1 = clock();
+        result.numAllocs = g_numAllocs-numAllocs;
+        result.allocBytes = g_allocBytes-allocBytes;
+        result.best = std::min(result.best, (double)(t1-t0)/CLOCKS_PER_SEC);
+        result.numRects = vRect.size();
+        result.area = 0;
+        for (std::size_t i = 0; i < vRect.size(); ++i)
+            result.area += (long long)gtl::delta(vRect[i], gtl::HORIZONTAL)*gtl::delta(vRect[i], gtl::VERTICAL);
+    }
+    return result;
+}
+
+/// @brief Polygon2Rectangle with a point set type
+template <typename PointSet, typename RectSet>
+struct ClassEngine
+{
+    /// @brief convert
+    bool operator()(std::vector<Point> const& vPoint, std::vector<Rectangle>& vRect) const
+    {
+        RectSet rects;
+        lg::Polygon2Rectangle<PointSet, RectSet> p2r (rects, vPoint.begin(), vPoint.end(), lg::HOR_VER_SLICING);
+        bool ret = p2r();
+        vRect.assign(rects.begin(), rects.end());
+        return ret;
+    }
+};
+
+/// @brief Polygon2RectangleSweep
+struct SweepEngine
+{
+    /// @brief convert
+    bool operator()(std::vector<Point> const& vPoint, std::vector<Rectangle>& vRect) const
+    {
+        lg::Polygon2RectangleSweep<std::vector<Point>, std::vector<Rectangle> > p2r (vRect, vPoint.begin(), vPoint.end(), lg::HOR_VER_SLICING);
+        return p2r();
+    }
+};
+
+/// @brief Polygon2RectangleConverter
+struct ConverterEngine
+{
+    /// @brief convert
+    bool operator()(std::vector<Point> const& vPoint, std::vector<Rectangle>& vRect) const
+    {
+        lg::Polygon2RectangleConverter<Point, Rectangle> p2r (lg::HOR_VER_SLICING);
+        return p2r.convert(vPoint.begin(), vPoint.end(), std::back_inserter(vRect));
+    }
+};
+
+/// @brief polygon2rectangle with a slicing orientation
+struct FunctionEngine
+{
+    lg::slicing_orientation_2d slicing_orient; ///< slicing orientation
+    /// @brief constructor
+    FunctionEngine(lg::slicing_orientation_2d s) : slicing_orient(s) {}
+    /// @brief convert
+    bool operator()(std::vector<Point> const& vPoint, std::vector<Rectangle>& vRect) const
+    {
+        return lg::polygon2rectangle(vPoint.begin(), vPoint.end(), std::vector<Point>(), vRect, slicing_orient);
+    }
+};
+
+/// @brief polygon2RectangleBoost
+struct BoostApiEngine
+{
+    /// @brief convert
+    bool operator()(std::vector<Point> const& vPoint, std::vector<Rectangle>& vRect) const
+    {
+        return lg::polygon2RectangleBoost(vPoint, vRect);
+    }
+};
+
+/// @brief get_rectangles of Boost.Polygon
+struct BoostEngine
+{
+    /// @brief convert
+    bool operator()(std::vector<Point> const& vPoint, std::vector<Rectangle>& vRect) const
+    {
+        gtl::polygon_90_data<int> polygon;
+        polygon.set(vPoint.begin(), vPoint.end());
+        gtl::polygon_90_set_data<int> ps;
+        ps.insert(polygon);
+        ps.get_rectangles(vRect);
+        return true;
+    }
+};
+
+/// @brief print a result
+/// @param name engine
+/// @param result result
+void report(const char* name, Result const& result)
+{
+    printf("  %-34s %s %10.3f ms %9lu rects %9lu allocs %9.2f MB\n", name, result.success? "  " : "F ", result.best*1e3,
+            (unsigned long)result.numRects, (unsigned long)result.numAllocs, result.allocBytes/1e6);
+}
+
+/// @brief main function
+/// @param argc number of arguments
+/// @param argv values of arguments: [max vertices] [runs] [max vertices of quadratic engines]
+/// @return 0 if engines giving the same rectangles agree
+int main(int argc, char** argv)
+{
+    std::size_t maxVertices = (argc > 1)? atol(argv[1]) : 1000000;
+    int numRuns = (argc > 2)? std::max(atoi(argv[2]), 1) : 3;
+    std::size_t maxQuadratic = (argc > 3)? atol(argv[3]) : 10000;
+    printf("usage: %s [max vertices] [runs] [max vertices of quadratic engines]\n", argv[0]);
+    printf("max vertices %lu, %d runs, quadratic engines up to %lu vertices\n", (unsigned long)maxVertices, numRuns, (unsigned long)maxQuadratic);
+
+    srand(1);
+    bool pass = true;
+    const char* vFamily[] = {"staircase", "holes", "comb"};
+    for (int f = 0; f < 3; ++f)
+    {
+        for (std::size_t n = 10; n <= maxVertices; n *= 10)
+        {
+            std::vector<Point> vPoint = (f == 0)? staircase(n) : (f == 1)? holes(n) : comb(n);
+            printf("%s, %lu vertices\n", vFamily[f], (unsigned long)vPoint.size());
+            // engines giving the same rectangles as Polygon2Rectangle
+            std::vector<std::pair<std::string, Result> > vSame;
+            if (n <= maxQuadratic)
+            {
+                vSame.push_back(std::make_pair("Polygon2Rectangle<list>", run(ClassEngine<std::list<Point>, std::vector<Rectangle> >(), vPoint, numRuns)));
+                vSame.push_back(std::make_pair("Polygon2Rectangle<set>", run(ClassEngine<std::set<Point, lg::point_compare_type>, std::vector<Rectangle> >(), vPoint, numRuns)));
+                vSame.push_back(std::make_pair("Polygon2Rectangle<vector>", run(ClassEngine<std::vector<Point>, std::list<Rectangle> >(), vPoint, numRuns)));
+                vSame.push_back(std::make_pair("Polygon2RectangleVec", run(ClassEngine<std::vector<Point>, std::vector<Rectangle> >(), vPoint, numRuns)));
+                vSame.push_back(std::make_pair("Polygon2RectangleConverter", run(ConverterEngine(), vPoint, numRuns)));
+            }
+            vSame.push_back(std::make_pair("Polygon2RectangleSweep", run(SweepEngine(), vPoint, numRuns)));
+            vSame.push_back(std::make_pair("polygon2rectangle", run(FunctionEngine(lg::HOR_VER_SLICING), vPoint, numRuns)));
+            vSame.push_back(std::make_pair("polygon2RectangleBoost", run(BoostApiEngine(), vPoint, numRuns)));
+            for (std::size_t i = 0; i < vSame.size(); ++i)
+            {
+                report(vSame[i].first.c_str(), vSame[i].second);
+                if (!vSame[i].second.success || vSame[i].second.numRects != vSame.back().second.numRects || vSame[i].second.area != vSame.back().second.area)
+                {
+                    printf("  %s differs from polygon2RectangleBoost\n", vSame[i].first.c_str());
+                    pass = false;
+                }
+            }
+            // engines giving other rectangles of the same area
+            Result vOther[] = {run(FunctionEngine(lg::MIN_RECT_SLICING), vPoint, numRuns),
+                run(FunctionEngine(lg::MIN_RECT_FAST_SLICING), vPoint, numRuns), run(BoostEngine(), vPoint, numRuns)};
+            const char* vOtherName[] = {"polygon2rectangle MIN_RECT", "polygon2rectangle MIN_RECT_FAST", "Boost.Polygon get_rectangles"};
+            for (int i = 0; i < 3; ++i)
+            {
+                report(vOtherName[i], vOther[i]);
+                if (!vOther[i].success || vOther[i].area != vSame.back().second.area)
+                {
+                    printf("  %s covers a different area\n", vOtherName[i]);
+                    pass = false;
+                }
+            }
+            if (vOther[0].numRects > vOther[1].numRects || vOther[0].numRects > vSame.back().second.numRects)
+            {
+                printf("  MIN_RECT is not the fewest\n");
+                pass = false;
+            }
+        }
+    }
+    printf("%s\n", pass? "passed" : "failed");
+    return pass? 0 : 1;
+}
@@ -9,6 +9,7 @@
 #include <vector>
 #include <list>
 #include <set>
+#include <cstdlib>
 #include <boost/polygon/polygon.hpp>
 #include <limbo/geometry/Polygon2Rectangle.h>
 #include <limbo/geometry/api/BoostPolygonApi.h>
@@ -93,6 +94,41 @@ void test4()
     cout << "test 4 passed\n";
 }
 
+/**
+ * @brief test batched get_rectangles with threads against get_rectangles of each polygon 
+ */
+void test5()
+{
+    vector<gtl::polygon_90_data<int> > vPolygon; 
+    for (int i = 0; i < 20000; ++i)
+    {
+        // an L shape with random sizes 
+        int x = rand()%1000, y = rand()%1000, w = 2+rand()%20, h = 2+rand()%20; 
+        int vCoord[] = {x, y, x+w, y+h/2, x+w/2, y+h}; 
+        gtl::polygon_90_data<int> polygon; 
+        polygon.set_compact(vCoord, vCoord+6); 
+        vPolygon.push_back(polygon); 
+    }
+    for (int o = 0; o < 2; ++o)
+    {
+        gtl::orientation_2d orient = (o == 0)? gtl::HORIZONTAL : gtl::VERTICAL; 
+        vector<gtl::rectangle_data<int> > vRectangle; 
+        vector<std::size_t> vRectOffset (1, 0); 
+        for (std::size_t i = 0; i < vPolygon.size(); ++i)
+        {
+            gtl::polygon_90_set_data<int> ps (orient); 
+            ps.insert(vPolygon[i]); 
+            ps.get_rectangles(vRectangle); 
+            vRectOffset.push_back(vRectangle.size()); 
+        }
+        vector<gtl::rectangle_data<int> > vBatchRectangle; 
+        vector<std::size_t> vBatchRectOffset; 
+        assert(lg::polygon2RectangleBoostBatch(vPolygon, vBatchRectangle, vBatchRectOffset, orient, 4)); 
+        assert(vBatchRectangle == vRectangle && vBatchRectOffset == vRectOffset); 
+    }
+    cout << "test 5 passed\n";
+}
+
 /**
  * @brief main function requires an input benchmark in gnuplot format  
  * @param argc number of arguments 
@@ -102,6 +138,7 @@ void test4()
 int main(int argc, char** argv)
 {
     test4();
+    test5();
 	if (argc > 1)
 	{
 		test1(argv[1]);
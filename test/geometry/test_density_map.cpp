@@ -0,0 +1,136 @@
+/**
+ * @file   test_density_map.cpp
+ * @brief  test @ref limbo::geometry::DensityMap against overlap areas computed bin by bin
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <boost/polygon/polygon.hpp>
+#include <limbo/geometry/api/BoostPolygonApi.h>
+#include <limbo/geometry/DensityMap.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using namespace limbo::geometry;
+
+/// rectangle of Boost.Polygon
+typedef boost::polygon::rectangle_data<int> Rectangle;
+
+/// @return overlap areas of rectangles with each bin, by intersecting each rectangle with the bins around it
+vector<long> bruteForce(vector<Rectangle> const& vRect, int xl, int yl, int bin_w, int bin_h, int nx, int ny)
+{
+	vector<long> vBin ((std::size_t)nx*ny, 0);
+	for (std::size_t i = 0; i < vRect.size(); ++i)
+	{
+		int rxl = boost::polygon::xl(vRect[i]), ryl = boost::polygon::yl(vRect[i]);
+		int rxh = boost::polygon::xh(vRect[i]), ryh = boost::polygon::yh(vRect[i]);
+		for (int r = std::max((ryl-yl)/bin_h-1, 0); r < std::min((ryh-yl)/bin_h+1, ny); ++r)
+			for (int c = std::max((rxl-xl)/bin_w-1, 0); c < std::min((rxh-xl)/bin_w+1, nx); ++c)
+			{
+				long w = std::min(rxh, xl+(c+1)*bin_w)-std::max(rxl, xl+c*bin_w);
+				long h = std::min(ryh, yl+(r+1)*bin_h)-std::max(ryl, yl+r*bin_h);
+				if (w > 0 && h > 0)
+					vBin[(std::size_t)r*nx+c] += w*h;
+			}
+	}
+	return vBin;
+}
+
+/// main function \n
+/// compare bins, incremental moves and windows with brute force, and results of different numbers of threads
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	// rectangles partly out of the grid [0, 100000)^2, one in ten is a long wire
+	vector<Rectangle> vRect;
+	for (int i = 0; i < 500000; ++i)
+	{
+		int xl = rand()%110000-5000, yl = rand()%110000-5000;
+		int w = (i%10 == 0)? rand()%20000 : rand()%500;
+		int h = (i%10 == 1)? rand()%20000 : rand()%500;
+		vRect.push_back(Rectangle(xl, yl, xl+w, yl+h));
+	}
+	int nx = 400, ny = 250;
+	int bin_w = 250, bin_h = 400;
+	bool pass = true;
+
+	vector<long> vRef = bruteForce(vRect, 0, 0, bin_w, bin_h, nx, ny);
+	clock_t t0 = clock();
+	DensityMap<int, long> dmap;
+	dmap.reset(0, 0, bin_w, bin_h, nx, ny);
+	dmap.add_rectangles(vRect.begin(), vRect.end(), 1);
+	clock_t t1 = clock();
+	pass = (dmap.bins() == vRef) && pass;
+	DensityMap<int, long> dmap4;
+	dmap4.reset(0, 0, bin_w, bin_h, nx, ny);
+	dmap4.add_rectangles(vRect.begin(), vRect.end(), 4);
+	pass = (dmap4.bins() == vRef) && pass;
+	cout << vRect.size() << " rectangles into " << nx << " x " << ny << " bins in " << (double)(t1-t0)/CLOCKS_PER_SEC << " s" << endl;
+
+	// incremental moves
+	for (int k = 0; k < 20000; ++k)
+	{
+		std::size_t i = rand()%vRect.size();
+		int dx = rand()%2001-1000, dy = rand()%2001-1000;
+		Rectangle& rect = vRect[i];
+		dmap.move(boost::polygon::xl(rect), boost::polygon::yl(rect), boost::polygon::xh(rect), boost::polygon::yh(rect),
+				boost::polygon::xl(rect)+dx, boost::polygon::yl(rect)+dy, boost::polygon::xh(rect)+dx, boost::polygon::yh(rect)+dy);
+		boost::polygon::move(rect, boost::polygon::HORIZONTAL, dx);
+		boost::polygon::move(rect, boost::polygon::VERTICAL, dy);
+	}
+	vRef = bruteForce(vRect, 0, 0, bin_w, bin_h, nx, ny);
+	pass = (dmap.bins() == vRef) && pass;
+	cout << "after moves " << ((dmap.bins() == vRef)? "agree" : "differ") << endl;
+
+	// windows
+	dmap.update_prefix();
+	for (int q = 0; q < 1000; ++q)
+	{
+		int c0 = rand()%nx, r0 = rand()%ny;
+		int c1 = c0+rand()%(nx-c0+1), r1 = r0+rand()%(ny-r0+1);
+		long sum = 0;
+		for (int r = r0; r < r1; ++r)
+			for (int c = c0; c < c1; ++c)
+				sum += vRef[(std::size_t)r*nx+c];
+		pass = (dmap.window(c0, r0, c1, r1) == sum) && pass;
+	}
+	vector<double> vDensity;
+	dmap.sliding_window(5, 3, vDensity);
+	pass = (vDensity.size() == (std::size_t)(nx-4)*(ny-2)) && pass;
+	double area = 0;
+	for (int r = 7; r < 10; ++r)
+		for (int c = 11; c < 16; ++c)
+			area += vRef[(std::size_t)r*nx+c];
+	pass = (std::abs(vDensity[7*(nx-4)+11]-area/(15.0*bin_w*bin_h)) < 1e-12) && pass;
+
+	// floating point coordinates, the same bins whatever the number of threads
+	vector<Rectangle> vSmall (vRect.begin(), vRect.begin()+50000);
+	DensityMap<double> fmap, fmap4;
+	fmap.reset(0.5, 0.25, 333.3, 217.7, 300, 460);
+	fmap.add_rectangles(vSmall.begin(), vSmall.end(), 1);
+	fmap4.reset(0.5, 0.25, 333.3, 217.7, 300, 460);
+	fmap4.add_rectangles(vSmall.begin(), vSmall.end(), 4);
+	pass = (fmap.bins() == fmap4.bins()) && pass;
+	double total = 0, clipped = 0;
+	for (std::size_t i = 0; i < fmap.bins().size(); ++i)
+		total += fmap.bins()[i];
+	for (std::size_t i = 0; i < vSmall.size(); ++i)
+	{
+		double w = std::min((double)boost::polygon::xh(vSmall[i]), 0.5+333.3*300)-std::max((double)boost::polygon::xl(vSmall[i]), 0.5);
+		double h = std::min((double)boost::polygon::yh(vSmall[i]), 0.25+217.7*460)-std::max((double)boost::polygon::yl(vSmall[i]), 0.25);
+		if (w > 0 && h > 0)
+			clipped += w*h;
+	}
+	pass = (std::abs(total-clipped) < 1e-9*clipped) && pass;
+	cout << "overflow above density 0.5 = " << fmap.overflow(0.5) << endl;
+
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file   test_manhattan_boolean.cpp
+ * @brief  test @ref limbo::geometry::ManhattanBoolean against operations on bitmaps
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <limbo/geometry/ManhattanBoolean.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using namespace limbo::geometry;
+
+/// a rectangle working with the default rectangle_traits
+struct Rectangle
+{
+	typedef int coordinate_type; ///< coordinate type
+	int m_c[4]; ///< coordinates by direction_2d
+	/// constructor
+	Rectangle(int xl = 0, int yl = 0, int xh = 0, int yh = 0) {m_c[LEFT] = xl; m_c[BOTTOM] = yl; m_c[RIGHT] = xh; m_c[TOP] = yh;}
+	/// @return coordinate in a direction
+	int get(direction_2d d) const {return m_c[d];}
+	/// @brief set coordinate in a direction
+	void set(direction_2d d, int v) {m_c[d] = v;}
+	/// @return true if two rectangles are identical
+	bool operator==(Rectangle const& rhs) const
+	{
+		return m_c[0] == rhs.m_c[0] && m_c[1] == rhs.m_c[1] && m_c[2] == rhs.m_c[2] && m_c[3] == rhs.m_c[3];
+	}
+};
+
+/// unit cells of [-S, S)^2
+struct Bitmap
+{
+	static const int S = 64; ///< half size
+	vector<char> vCell; ///< cells by rows
+
+	/// constructor
+	Bitmap() : vCell(4*S*S, 0) {}
+	/// @return cell at (x, y)
+	char& at(int x, int y) {return vCell[(y+S)*2*S+x+S];}
+	/// @return cell at (x, y), 0 outside
+	char get(int x, int y) const {return (x < -S || x >= S || y < -S || y >= S)? 0 : vCell[(y+S)*2*S+x+S];}
+	/// @brief fill rectangles
+	void fill(vector<Rectangle> const& vRect)
+	{
+		for (unsigned int i = 0; i < vRect.size(); ++i)
+			for (int y = vRect[i].get(BOTTOM); y < vRect[i].get(TOP); ++y)
+				for (int x = vRect[i].get(LEFT); x < vRect[i].get(RIGHT); ++x)
+					at(x, y) = 1;
+	}
+	/// @return maximal horizontal intervals merged vertically, sorted by bottom and left
+	vector<Rectangle> rectangles() const
+	{
+		vector<Rectangle> vRect;
+		vector<Rectangle> vOpen;
+		for (int y = -S; y <= S; ++y)
+		{
+			vector<Rectangle> vNextOpen;
+			for (int x = -S; x < S; )
+			{
+				if (!get(x, y)) {++x; continue;}
+				int xl = x;
+				for (; x < S && get(x, y); ++x);
+				vNextOpen.push_back(Rectangle(xl, y, x, y+1));
+			}
+			// extend open rectangles with the same intervals
+			for (unsigned int i = 0; i < vOpen.size(); ++i)
+			{
+				bool found = false;
+				for (unsigned int j = 0; j < vNextOpen.size(); ++j)
+					if (vNextOpen[j].get(LEFT) == vOpen[i].get(LEFT) && vNextOpen[j].get(RIGHT) == vOpen[i].get(RIGHT))
+					{
+						vNextOpen[j].set(BOTTOM, vOpen[i].get(BOTTOM));
+						found = true;
+					}
+				if (!found)
+				{
+					vOpen[i].set(TOP, y);
+					vRect.push_back(vOpen[i]);
+				}
+			}
+			vOpen.swap(vNextOpen);
+		}
+		// sort by bottom and left
+		for (unsigned int i = 0; i < vRect.size(); ++i)
+			for (unsigned int j = i+1; j < vRect.size(); ++j)
+				if (vRect[j].get(BOTTOM) < vRect[i].get(BOTTOM)
+						|| (vRect[j].get(BOTTOM) == vRect[i].get(BOTTOM) && vRect[j].get(LEFT) < vRect[i].get(LEFT)))
+					std::swap(vRect[i], vRect[j]);
+		return vRect;
+	}
+};
+
+/// @return random rectangles in [0, 48)^2
+vector<Rectangle> randomRectangles(int n)
+{
+	vector<Rectangle> vRect;
+	for (int i = 0; i < n; ++i)
+	{
+		int xl = rand()%44, yl = rand()%44;
+		vRect.push_back(Rectangle(xl, yl, xl+rand()%(48-xl)+(rand()%8 == 0? 0 : 1), yl+1+rand()%std::min(48-yl, 12)));
+	}
+	return vRect;
+}
+
+/// random operations compared with bitmaps, with different numbers of tiles and threads
+/// @return true if all results match
+bool testRandom()
+{
+	for (int iter = 0; iter < 300; ++iter)
+	{
+		vector<Rectangle> vA = randomRectangles(1+rand()%20), vB = randomRectangles(rand()%20);
+		Bitmap bA, bB;
+		bA.fill(vA);
+		bB.fill(vB);
+		for (int op = BOOLEAN_OR; op <= BOOLEAN_XOR; ++op)
+		{
+			Bitmap bOut;
+			for (unsigned int i = 0; i < bOut.vCell.size(); ++i)
+			{
+				bool a = bA.vCell[i], b = bB.vCell[i];
+				bOut.vCell[i] = (op == BOOLEAN_OR)? a || b : (op == BOOLEAN_AND)? a && b : (op == BOOLEAN_NOT)? a && !b : a != b;
+			}
+			vector<Rectangle> vExpected = bOut.rectangles();
+			for (unsigned int numTiles = 1; numTiles <= 9; numTiles += 4)
+			{
+				ManhattanBoolean<Rectangle> mb;
+				mb.set_num_tiles(numTiles);
+				mb.set_num_threads(numTiles > 1? 3 : 1);
+				mb.add(vA.begin(), vA.end(), 0);
+				mb.add(vB.begin(), vB.end(), 1);
+				vector<Rectangle> vRect;
+				mb.run((boolean_operation_type)op, vRect);
+				if (!(vRect == vExpected))
+				{
+					cout << "boolean operation " << op << " with " << numTiles << " tiles failed" << endl;
+					return false;
+				}
+			}
+		}
+		for (int d = -3; d <= 3; ++d)
+		{
+			// a cell is in the result if any (bloat) or all (shrink) cells within distance |d| are in A
+			Bitmap bOut;
+			for (int y = -Bitmap::S; y < Bitmap::S; ++y)
+				for (int x = -Bitmap::S; x < Bitmap::S; ++x)
+				{
+					bool any = false, all = true;
+					for (int dy = -std::abs(d); dy <= std::abs(d); ++dy)
+						for (int dx = -std::abs(d); dx <= std::abs(d); ++dx)
+						{
+							any = any || bA.get(x+dx, y+dy);
+							all = all && bA.get(x+dx, y+dy);
+						}
+					bOut.at(x, y) = (d >= 0)? any : all;
+				}
+			vector<Rectangle> vRect;
+			manhattan_resize(vA, d, vRect, 2);
+			if (!(vRect == bOut.rectangles()))
+			{
+				cout << "resize by " << d << " failed" << endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/// main function \n
+/// verify boolean operations and sizing against bitmaps, then time a union of many rectangles
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	bool pass = testRandom();
+
+	// a layer of many overlapping wires
+	vector<Rectangle> vA;
+	for (int i = 0; i < 400000; ++i)
+	{
+		int x = rand()%100000, y = rand()%100000;
+		if (i%2)
+			vA.push_back(Rectangle(x, y, x+20+rand()%400, y+20));
+		else
+			vA.push_back(Rectangle(x, y, x+20, y+20+rand()%400));
+	}
+	vector<Rectangle> vRect1, vRect4;
+	clock_t t0 = clock();
+	manhattan_boolean(vA, vector<Rectangle>(), BOOLEAN_OR, vRect1, 1);
+	clock_t t1 = clock();
+	manhattan_boolean(vA, vector<Rectangle>(), BOOLEAN_OR, vRect4, 4);
+	clock_t t2 = clock();
+	pass = (vRect1 == vRect4) && pass;
+	cout << "union of " << vA.size() << " rectangles into " << vRect1.size() << " rectangles: 1 thread " << (double)(t1-t0)/CLOCKS_PER_SEC
+		<< " s, 4 threads " << (double)(t2-t1)/CLOCKS_PER_SEC << " s" << endl;
+
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
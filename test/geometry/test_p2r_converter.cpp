@@ -0,0 +1,120 @@
+/**
+ * @file   test_p2r_converter.cpp
+ * @brief  test @ref limbo::geometry::Polygon2RectangleConverter against @ref limbo::geometry::Polygon2Rectangle
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <limbo/geometry/Polygon2Rectangle.h>
+#include <iterator>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using namespace limbo::geometry;
+
+/// a point working with the default point_traits
+struct Point
+{
+	typedef int coordinate_type; ///< coordinate type
+	int m_x; ///< x coordinate
+	int m_y; ///< y coordinate
+	/// constructor
+	Point(int x = 0, int y = 0) : m_x(x), m_y(y) {}
+	/// @return coordinate in an orientation
+	int get(orientation_2d o) const {return (o == HORIZONTAL)? m_x : m_y;}
+	/// @brief set coordinate in an orientation
+	void set(orientation_2d o, int v) {if (o == HORIZONTAL) m_x = v; else m_y = v;}
+};
+
+/// a rectangle working with the default rectangle_traits
+struct Rectangle
+{
+	typedef int coordinate_type; ///< coordinate type
+	int m_c[4]; ///< coordinates by direction_2d
+	/// constructor
+	Rectangle(int xl = 0, int yl = 0, int xh = 0, int yh = 0) {m_c[LEFT] = xl; m_c[BOTTOM] = yl; m_c[RIGHT] = xh; m_c[TOP] = yh;}
+	/// @return coordinate in a direction
+	int get(direction_2d d) const {return m_c[d];}
+	/// @brief set coordinate in a direction
+	void set(direction_2d d, int v) {m_c[d] = v;}
+	/// @return true if two rectangles are identical
+	bool operator==(Rectangle const& rhs) const
+	{
+		return m_c[0] == rhs.m_c[0] && m_c[1] == rhs.m_c[1] && m_c[2] == rhs.m_c[2] && m_c[3] == rhs.m_c[3];
+	}
+};
+
+/// append a random manhattan polygon between a lower and an upper staircase
+/// @param numSteps number of steps
+/// @param vPoint vertices of all polygons
+/// @param vOffset offsets of polygons
+void addRandomPolygon(int numSteps, vector<Point>& vPoint, vector<std::size_t>& vOffset)
+{
+	int x = rand()%1000, low = rand()%1000, high = low+1+rand()%20;
+	vector<Point> vLow, vHigh;
+	for (int i = 0; i < numSteps; ++i)
+	{
+		int xn = x+1+rand()%5;
+		vLow.push_back(Point(x, low));
+		vLow.push_back(Point(xn, low));
+		vHigh.push_back(Point(x, high));
+		vHigh.push_back(Point(xn, high));
+		// neighbor steps overlap so that the polygon is connected
+		int lown = low+rand()%20-10;
+		int highn = std::max(lown, low)+1+rand()%20;
+		if (lown >= high) lown = high-1;
+		low = lown;
+		high = highn;
+		x = xn;
+	}
+	vPoint.insert(vPoint.end(), vLow.begin(), vLow.end());
+	vPoint.insert(vPoint.end(), vHigh.rbegin(), vHigh.rend());
+	vOffset.push_back(vPoint.size());
+}
+
+/// main function \n
+/// convert many small polygons with one converter and with a Polygon2Rectangle object for each polygon,
+/// and verify the rectangles are identical in all slicing orientations
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	vector<Point> vPoint;
+	vector<std::size_t> vOffset (1, 0);
+	for (int i = 0; i < 200000; ++i)
+		addRandomPolygon(1+rand()%6, vPoint, vOffset);
+	std::size_t numPolygons = vOffset.size()-1;
+
+	bool pass = true;
+	slicing_orientation_2d vOrient[] = {HORIZONTAL_SLICING, VERTICAL_SLICING, HOR_VER_SLICING, HOR_VER_SA_SLICING, HOR_VER_AR_SLICING};
+	Polygon2RectangleConverter<Point, Rectangle> converter;
+	for (int o = 0; o < 5; ++o)
+	{
+		clock_t t0 = clock();
+		vector<Rectangle> vRect;
+		std::size_t numFailed = 0;
+		for (std::size_t i = 0; i < numPolygons; ++i)
+		{
+			Polygon2Rectangle<vector<Point>, vector<Rectangle> > p2r (vRect, vPoint.begin()+vOffset[i], vPoint.begin()+vOffset[i+1], vOrient[o]);
+			numFailed += !p2r();
+		}
+		clock_t t1 = clock();
+		vector<Rectangle> vConvRect;
+		vConvRect.reserve(vRect.size());
+		std::size_t numConvFailed = 0;
+		converter.reset(vOrient[o]);
+		for (std::size_t i = 0; i < numPolygons; ++i)
+			numConvFailed += !converter.convert(vPoint.begin()+vOffset[i], vPoint.begin()+vOffset[i+1], std::back_inserter(vConvRect));
+		clock_t t2 = clock();
+		cout << to_string(vOrient[o]) << ": " << numPolygons << " polygons, " << vRect.size() << " rectangles, Polygon2Rectangle "
+			<< (double)(t1-t0)/CLOCKS_PER_SEC << " s, Polygon2RectangleConverter " << (double)(t2-t1)/CLOCKS_PER_SEC << " s" << endl;
+		pass = (numFailed == 0 && numConvFailed == 0 && vConvRect == vRect) && pass;
+	}
+
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file   test_p2r_holes.cpp
+ * @brief  test polygon-to-rectangle conversion of polygons with holes given as separate contours
+ *
+ * Each polygon is converted from its outer contour and holes,
+ * and from one contour reaching the holes through duplicate points.
+ * Both inputs must give identical rectangles in all slicing orientations.
+ *
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <iterator>
+#include <boost/polygon/polygon.hpp>
+#include <limbo/geometry/api/BoostPolygonApi.h>
+#include <limbo/geometry/Polygon2Rectangle.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using namespace limbo::geometry;
+
+/// point type
+typedef boost::polygon::point_data<int> Point;
+/// rectangle type
+typedef boost::polygon::rectangle_data<int> Rectangle;
+/// polygon type with holes
+typedef boost::polygon::polygon_90_with_holes_data<int> Polygon;
+
+/// generate a staircase bottom with a rectangular hole in each row
+/// @param numHoles number of holes
+/// @param polygon polygon with holes
+/// @param vPoint one contour reaching holes from the left edge through duplicate points
+void addRandomPolygon(int numHoles, Polygon& polygon, vector<Point>& vPoint)
+{
+	int width = 100+rand()%100;
+	vector<Point> vOuter;
+	// a random staircase below the first row
+	vOuter.push_back(Point(0, 0));
+	for (int x = 0; x < width; )
+	{
+		int xn = std::min(width, x+1+rand()%20);
+		vOuter.push_back(Point(x, -rand()%5-1));
+		vOuter.push_back(Point(xn, vOuter.back().y()));
+		x = xn;
+	}
+	vOuter.push_back(Point(width, 0));
+	vOuter.push_back(Point(width, 4*numHoles+1));
+	vOuter.push_back(Point(0, 4*numHoles+1));
+
+	vector<Polygon::hole_type> vHole;
+	vPoint = vOuter;
+	for (int i = numHoles-1; i >= 0; --i)
+	{
+		int xl = 1+rand()%(width/2), xh = xl+1+rand()%(width/2-1), yl = 4*i+1, yh = 4*i+3;
+		Point vHolePoint[] = {Point(xl, yl), Point(xl, yh), Point(xh, yh), Point(xh, yl)};
+		vHole.push_back(Polygon::hole_type());
+		vHole.back().set(vHolePoint, vHolePoint+4);
+		vPoint.push_back(Point(0, yl));
+		vPoint.insert(vPoint.end(), vHolePoint, vHolePoint+4);
+		vPoint.push_back(Point(xl, yl));
+		vPoint.push_back(Point(0, yl));
+	}
+	polygon.set(vOuter.begin(), vOuter.end());
+	polygon.set_holes(vHole.begin(), vHole.end());
+}
+
+/// main function \n
+/// convert random polygons with holes given separately and given in one contour,
+/// and verify the rectangles are identical
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	bool pass = true;
+	slicing_orientation_2d vOrient[] = {HORIZONTAL_SLICING, VERTICAL_SLICING, HOR_VER_SLICING, HOR_VER_SA_SLICING, HOR_VER_AR_SLICING,
+		MIN_RECT_SLICING, MIN_RECT_FAST_SLICING};
+	Polygon2RectangleConverter<Point, Rectangle> converter;
+	double vTime[2] = {0, 0};
+	for (int i = 0; i < 2000; ++i)
+	{
+		// mostly small polygons for the converter, and some large ones for the sweep
+		int numHoles = (i%10 == 0)? 300+rand()%300 : 1+rand()%10;
+		Polygon polygon;
+		vector<Point> vPoint;
+		addRandomPolygon(numHoles, polygon, vPoint);
+		for (int o = 0; o < 7; ++o)
+		{
+			vector<Rectangle> vRect, vHoleRect;
+			clock_t t0 = clock();
+			bool success = polygon2rectangle(vPoint.begin(), vPoint.end(), vector<Point>(), vRect, vOrient[o]);
+			clock_t t1 = clock();
+			bool holeSuccess = polygon2rectangle(polygon.begin(), polygon.end(), polygon.begin_holes(), polygon.end_holes(),
+					vector<Point>(), vHoleRect, vOrient[o]);
+			clock_t t2 = clock();
+			vTime[0] += (double)(t1-t0)/CLOCKS_PER_SEC;
+			vTime[1] += (double)(t2-t1)/CLOCKS_PER_SEC;
+			if (!success || !holeSuccess || vRect != vHoleRect)
+			{
+				cout << "polygon " << i << " with " << numHoles << " holes, " << to_string(vOrient[o]) << ": "
+					<< vRect.size() << " rectangles in one contour, " << vHoleRect.size() << " rectangles with holes" << endl;
+				pass = false;
+			}
+		}
+		// holes as pairs of iterators
+		if (numHoles < 300)
+		{
+			vector<std::pair<Polygon::iterator_type, Polygon::iterator_type> > vHoleRange;
+			for (Polygon::iterator_holes_type it = polygon.begin_holes(); it != polygon.end_holes(); ++it)
+				vHoleRange.push_back(std::make_pair(it->begin(), it->end()));
+			vector<Rectangle> vRect, vHoleRect;
+			converter.reset(HOR_VER_SLICING);
+			converter.convert(vPoint.begin(), vPoint.end(), std::back_inserter(vRect));
+			converter.convert(polygon.begin(), polygon.end(), vHoleRange.begin(), vHoleRange.end(), std::back_inserter(vHoleRect));
+			pass = (vRect == vHoleRect) && pass;
+		}
+	}
+	cout << "one contour " << vTime[0] << " s, contour with holes " << vTime[1] << " s" << endl;
+
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
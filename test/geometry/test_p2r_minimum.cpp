@@ -0,0 +1,288 @@
+/**
+ * @file   test_p2r_minimum.cpp
+ * @brief  test @ref limbo::geometry::Polygon2RectangleMinimum on random polygons of grid cells
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <limbo/geometry/Polygon2Rectangle.h>
+#include <limbo/geometry/Polygon2RectangleBatch.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using namespace limbo::geometry;
+
+/// a point working with the default point_traits
+struct Point
+{
+	typedef int coordinate_type; ///< coordinate type
+	int m_x; ///< x coordinate
+	int m_y; ///< y coordinate
+	/// constructor
+	Point(int x = 0, int y = 0) : m_x(x), m_y(y) {}
+	/// @return coordinate in an orientation
+	int get(orientation_2d o) const {return (o == HORIZONTAL)? m_x : m_y;}
+	/// @brief set coordinate in an orientation
+	void set(orientation_2d o, int v) {if (o == HORIZONTAL) m_x = v; else m_y = v;}
+	/// @return true if two points are identical
+	bool operator==(Point const& rhs) const {return m_x == rhs.m_x && m_y == rhs.m_y;}
+};
+
+/// a rectangle working with the default rectangle_traits
+struct Rectangle
+{
+	typedef int coordinate_type; ///< coordinate type
+	int m_c[4]; ///< coordinates by direction_2d
+	/// constructor
+	Rectangle(int xl = 0, int yl = 0, int xh = 0, int yh = 0) {m_c[LEFT] = xl; m_c[BOTTOM] = yl; m_c[RIGHT] = xh; m_c[TOP] = yh;}
+	/// @return coordinate in a direction
+	int get(direction_2d d) const {return m_c[d];}
+	/// @brief set coordinate in a direction
+	void set(direction_2d d, int v) {m_c[d] = v;}
+	/// @return true if two rectangles are identical
+	bool operator==(Rectangle const& rhs) const
+	{
+		return m_c[0] == rhs.m_c[0] && m_c[1] == rhs.m_c[1] && m_c[2] == rhs.m_c[2] && m_c[3] == rhs.m_c[3];
+	}
+};
+
+/// a connected region of unit cells in [0, S)^2 without holes
+struct Region
+{
+	static const int S = 12; ///< size
+	vector<char> vCell; ///< cells by rows
+
+	/// constructor
+	Region() : vCell(S*S, 0) {}
+	/// @return cell at (x, y), 0 outside
+	char get(int x, int y) const {return (x < 0 || x >= S || y < 0 || y >= S)? 0 : vCell[y*S+x];}
+	/// @return number of cells around grid point (x, y)
+	int count(int x, int y) const {return get(x-1, y-1)+get(x, y-1)+get(x-1, y)+get(x, y);}
+	/// @return true if grid point (x, y) is a vertex
+	bool vertex(int x, int y) const {return count(x, y)%2 == 1;}
+	/// @return true if grid point (x, y) is a concave vertex
+	bool concave(int x, int y) const {return count(x, y) == 3;}
+
+	/// @brief random rectangles, then keep the component of the first cell and fill its holes
+	/// @return false if two cells touch only at a corner
+	bool generate()
+	{
+		vector<char> vFill (S*S, 0);
+		int n = 1+rand()%8;
+		for (int i = 0; i < n; ++i)
+		{
+			int xl = rand()%S, yl = rand()%S, xh = xl+1+rand()%(S-xl), yh = yl+1+rand()%(S-yl);
+			for (int y = yl; y < yh; ++y)
+				for (int x = xl; x < xh; ++x)
+					vFill[y*S+x] = 1;
+		}
+		// component of the first filled cell
+		vCell.assign(S*S, 0);
+		vector<int> vStack;
+		for (int i = 0; i < S*S && vStack.empty(); ++i)
+			if (vFill[i]) {vStack.push_back(i); vCell[i] = 1;}
+		flood(vFill, vCell, vStack, 1);
+		// cells not reachable from outside are holes
+		vector<char> vOut (S*S, 0);
+		vStack.clear();
+		for (int i = 0; i < S; ++i)
+		{
+			int vBorder[] = {i, (S-1)*S+i, i*S, i*S+S-1};
+			for (int k = 0; k < 4; ++k)
+				if (!vCell[vBorder[k]] && !vOut[vBorder[k]]) {vOut[vBorder[k]] = 1; vStack.push_back(vBorder[k]);}
+		}
+		flood(vCell, vOut, vStack, 0);
+		for (int i = 0; i < S*S; ++i)
+			vCell[i] = !vOut[i];
+		for (int y = 0; y <= S; ++y)
+			for (int x = 0; x <= S; ++x)
+				if (count(x, y) == 2 && get(x-1, y-1) == get(x, y))
+					return false;
+		return true;
+	}
+	/// @brief flood cells with value v in vSrc into vDst
+	static void flood(vector<char> const& vSrc, vector<char>& vDst, vector<int>& vStack, char v)
+	{
+		while (!vStack.empty())
+		{
+			int i = vStack.back();
+			vStack.pop_back();
+			int x = i%S, y = i/S;
+			int vNeighbor[4][2] = {{x-1, y}, {x+1, y}, {x, y-1}, {x, y+1}};
+			for (int k = 0; k < 4; ++k)
+			{
+				int nx = vNeighbor[k][0], ny = vNeighbor[k][1];
+				if (nx >= 0 && nx < S && ny >= 0 && ny < S && vSrc[ny*S+nx] == v && !vDst[ny*S+nx])
+				{
+					vDst[ny*S+nx] = 1;
+					vStack.push_back(ny*S+nx);
+				}
+			}
+		}
+	}
+	/// @return vertices along the boundary, alternating horizontal and vertical edges
+	vector<Point> contour() const
+	{
+		vector<Point> vVertex;
+		for (int y = 0; y <= S; ++y)
+			for (int x = 0; x <= S; ++x)
+				if (vertex(x, y))
+					vVertex.push_back(Point(x, y));
+		vector<Point> vContour (1, vVertex.front());
+		for (bool horizontal = true; ; horizontal = !horizontal)
+		{
+			// walk along the edge from the current vertex until the next vertex
+			Point p = vContour.back();
+			int dx = 0, dy = 0;
+			if (horizontal)
+				dx = (get(p.m_x, p.m_y-1) != get(p.m_x, p.m_y))? 1 : -1;
+			else
+				dy = (get(p.m_x-1, p.m_y) != get(p.m_x, p.m_y))? 1 : -1;
+			do {p.m_x += dx; p.m_y += dy;} while (!vertex(p.m_x, p.m_y));
+			if (p == vContour.front())
+				break;
+			vContour.push_back(p);
+		}
+		return vContour;
+	}
+	/// @return maximum number of non-intersecting chords by brute force, -1 if there are too many chords
+	int maxChords() const
+	{
+		// chords as (x1, y1, x2, y2)
+		vector<vector<int> > vChord;
+		for (int y = 0; y <= S; ++y)
+			for (int x1 = 0; x1 <= S; ++x1)
+				for (int x2 = x1+1; concave(x1, y) && x2 <= S; ++x2)
+				{
+					if (!get(x2-1, y-1) || !get(x2-1, y))
+						break;
+					if (concave(x2, y))
+					{
+						int c[] = {x1, y, x2, y};
+						vChord.push_back(vector<int>(c, c+4));
+						break;
+					}
+				}
+		for (int x = 0; x <= S; ++x)
+			for (int y1 = 0; y1 <= S; ++y1)
+				for (int y2 = y1+1; concave(x, y1) && y2 <= S; ++y2)
+				{
+					if (!get(x-1, y2-1) || !get(x, y2-1))
+						break;
+					if (concave(x, y2))
+					{
+						int c[] = {x, y1, x, y2};
+						vChord.push_back(vector<int>(c, c+4));
+						break;
+					}
+				}
+		int n = vChord.size();
+		if (n > 16)
+			return -1;
+		int best = 0;
+		for (int mask = 0; mask < (1<<n); ++mask)
+		{
+			bool independent = true;
+			for (int i = 0; i < n && independent; ++i)
+				for (int j = i+1; j < n && independent; ++j)
+					if ((mask>>i & 1) && (mask>>j & 1)
+							&& vChord[i][0] <= vChord[j][2] && vChord[j][0] <= vChord[i][2]
+							&& vChord[i][1] <= vChord[j][3] && vChord[j][1] <= vChord[i][3])
+						independent = false;
+			if (independent)
+				best = std::max(best, __builtin_popcount(mask));
+		}
+		return best;
+	}
+	/// @return true if rectangles tile the region exactly
+	bool tiled(vector<Rectangle> const& vRect) const
+	{
+		vector<char> vCount (S*S, 0);
+		for (unsigned int i = 0; i < vRect.size(); ++i)
+		{
+			if (vRect[i].get(LEFT) >= vRect[i].get(RIGHT) || vRect[i].get(BOTTOM) >= vRect[i].get(TOP))
+				return false;
+			for (int y = vRect[i].get(BOTTOM); y < vRect[i].get(TOP); ++y)
+				for (int x = vRect[i].get(LEFT); x < vRect[i].get(RIGHT); ++x)
+					++vCount[y*S+x];
+		}
+		return vCount == vCell;
+	}
+};
+
+/// main function \n
+/// verify the exact mode reaches the minimum from chords by brute force and both modes tile the polygons,
+/// then compare the numbers of rectangles and runtime with greedy slicing
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	bool pass = true;
+	vector<Point> vPoint;
+	vector<std::size_t> vOffset (1, 0);
+	std::size_t vTotal[3] = {0, 0, 0};
+	int numChecked = 0;
+	for (int iter = 0; iter < 3000; ++iter)
+	{
+		Region region;
+		if (!region.generate())
+			continue;
+		vector<Point> vContour = region.contour();
+		if (iter%2)
+			std::reverse(vContour.begin(), vContour.end());
+		vPoint.insert(vPoint.end(), vContour.begin(), vContour.end());
+		vOffset.push_back(vPoint.size());
+
+		int numConcave = 0;
+		for (int y = 0; y <= Region::S; ++y)
+			for (int x = 0; x <= Region::S; ++x)
+				numConcave += region.concave(x, y);
+		vector<Rectangle> vRect[3];
+		slicing_orientation_2d vOrient[] = {MIN_RECT_SLICING, MIN_RECT_FAST_SLICING, HOR_VER_SLICING};
+		for (int o = 0; o < 3; ++o)
+		{
+			if (!polygon2rectangle(vContour.begin(), vContour.end(), vector<Point>(), vRect[o], vOrient[o]) || !region.tiled(vRect[o]))
+			{
+				cout << to_string(vOrient[o]) << " failed at iteration " << iter << endl;
+				pass = false;
+			}
+			vTotal[o] += vRect[o].size();
+		}
+		int maxChords = region.maxChords();
+		if (maxChords >= 0)
+		{
+			++numChecked;
+			if ((int)vRect[0].size() != numConcave-maxChords+1)
+			{
+				cout << "not minimum at iteration " << iter << ": " << vRect[0].size() << " rectangles, expected " << numConcave-maxChords+1 << endl;
+				pass = false;
+			}
+		}
+		pass = (vRect[0].size() <= vRect[1].size() && vRect[0].size() <= vRect[2].size()) && pass;
+	}
+	cout << vOffset.size()-1 << " polygons, " << numChecked << " checked by brute force, rectangles: "
+		<< to_string(MIN_RECT_SLICING) << " " << vTotal[0] << ", " << to_string(MIN_RECT_FAST_SLICING) << " " << vTotal[1]
+		<< ", " << to_string(HOR_VER_SLICING) << " " << vTotal[2] << endl;
+
+	// batch conversion gives the same rectangles as one by one
+	slicing_orientation_2d vOrient[] = {MIN_RECT_SLICING, MIN_RECT_FAST_SLICING, HOR_VER_SLICING};
+	for (int o = 0; o < 3; ++o)
+	{
+		vector<Rectangle> vBatchRect;
+		vector<std::size_t> vBatchRectOffset;
+		clock_t t0 = clock();
+		pass = polygon2rectangle_batch(vPoint.begin(), vOffset.begin(), vOffset.end(), vBatchRect, vBatchRectOffset, vOrient[o], 2) && pass;
+		clock_t t1 = clock();
+		pass = (vBatchRect.size() == vTotal[o]) && pass;
+		cout << to_string(vOrient[o]) << " batch " << (double)(t1-t0)/CLOCKS_PER_SEC << " s" << endl;
+	}
+
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
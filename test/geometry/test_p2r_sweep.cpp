@@ -0,0 +1,173 @@
+/**
+ * @file   test_p2r_sweep.cpp
+ * @brief  test @ref limbo::geometry::Polygon2RectangleSweep against @ref limbo::geometry::Polygon2Rectangle
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <list>
+#include <string>
+#include <limbo/geometry/Polygon2Rectangle.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using std::list;
+using std::string;
+using namespace limbo::geometry;
+
+/// a point working with the default point_traits
+struct Point
+{
+	typedef int coordinate_type; ///< coordinate type
+	int m_x; ///< x coordinate
+	int m_y; ///< y coordinate
+	/// constructor
+	Point(int x = 0, int y = 0) : m_x(x), m_y(y) {}
+	/// @return coordinate in an orientation
+	int get(orientation_2d o) const {return (o == HORIZONTAL)? m_x : m_y;}
+	/// @brief set coordinate in an orientation
+	void set(orientation_2d o, int v) {if (o == HORIZONTAL) m_x = v; else m_y = v;}
+};
+
+/// a rectangle working with the default rectangle_traits
+struct Rectangle
+{
+	typedef int coordinate_type; ///< coordinate type
+	int m_c[4]; ///< coordinates by direction_2d
+	/// constructor
+	Rectangle(int xl = 0, int yl = 0, int xh = 0, int yh = 0) {m_c[LEFT] = xl; m_c[BOTTOM] = yl; m_c[RIGHT] = xh; m_c[TOP] = yh;}
+	/// @return coordinate in a direction
+	int get(direction_2d d) const {return m_c[d];}
+	/// @brief set coordinate in a direction
+	void set(direction_2d d, int v) {m_c[d] = v;}
+	/// @return true if two rectangles are identical
+	bool operator==(Rectangle const& rhs) const
+	{
+		return m_c[0] == rhs.m_c[0] && m_c[1] == rhs.m_c[1] && m_c[2] == rhs.m_c[2] && m_c[3] == rhs.m_c[3];
+	}
+};
+
+/// read the first polygon of a gnuplot file like benchmarks/polygon1.gp
+/// @param filename input file
+/// @param vPoint vertices
+/// @return true if succeed
+bool readPolygon(string const& filename, vector<Point>& vPoint)
+{
+	std::ifstream in (filename.c_str());
+	if (!in.good())
+	{
+		cout << "failed to open " << filename << endl;
+		return false;
+	}
+	string line;
+	while (std::getline(in, line))
+	{
+		int x, y;
+		if (std::sscanf(line.c_str(), " %d , %d", &x, &y) == 2)
+			vPoint.push_back(Point(x, y));
+		else if (!vPoint.empty())
+			break;
+	}
+	return vPoint.size() >= 4;
+}
+
+/// a random manhattan polygon between a lower and an upper staircase
+/// @param numSteps number of steps
+/// @param vPoint vertices
+void randomPolygon(int numSteps, vector<Point>& vPoint)
+{
+	vector<int> vX (numSteps+1), vLow (numSteps), vHigh (numSteps);
+	vX[0] = rand()%10;
+	for (int i = 1; i <= numSteps; ++i)
+		vX[i] = vX[i-1]+1+rand()%5;
+	for (int i = 0; i < numSteps; ++i)
+	{
+		// neighbor steps overlap so that the polygon is connected
+		vLow[i] = rand()%20;
+		vHigh[i] = vLow[i]+1+rand()%20;
+		if (i > 0 && vLow[i] >= vHigh[i-1]) vLow[i] = vHigh[i-1]-1;
+		if (i > 0 && vHigh[i] <= vLow[i-1]) vHigh[i] = vLow[i-1]+1;
+	}
+	vPoint.clear();
+	for (int i = 0; i < numSteps; ++i)
+	{
+		vPoint.push_back(Point(vX[i], vLow[i]));
+		vPoint.push_back(Point(vX[i+1], vLow[i]));
+	}
+	for (int i = numSteps-1; i >= 0; --i)
+	{
+		vPoint.push_back(Point(vX[i+1], vHigh[i]));
+		vPoint.push_back(Point(vX[i], vHigh[i]));
+	}
+}
+
+/// compare both engines in all slicing orientations
+/// @param vPoint vertices
+/// @return true if the rectangles are identical
+bool compare(vector<Point> const& vPoint)
+{
+	slicing_orientation_2d vOrient[] = {HORIZONTAL_SLICING, VERTICAL_SLICING, HOR_VER_SLICING, HOR_VER_SA_SLICING, HOR_VER_AR_SLICING};
+	for (int i = 0; i < 5; ++i)
+	{
+		vector<Rectangle> vRect, vRectSweep, vRectList;
+		Polygon2Rectangle<vector<Point>, vector<Rectangle> > p2r (vRect, vPoint.begin(), vPoint.end(), vOrient[i]);
+		bool ret = p2r();
+		Polygon2RectangleSweep<vector<Point>, vector<Rectangle> > p2rSweep (vRectSweep, vPoint.begin(), vPoint.end(), vOrient[i]);
+		bool retSweep = p2rSweep();
+		// the top api with forward iterators
+		list<Point> lPoint (vPoint.begin(), vPoint.end());
+		bool retList = polygon2rectangle(lPoint.begin(), lPoint.end(), vector<Point>(), vRectList, vOrient[i]);
+		if (ret != retSweep || ret != retList || !(vRect == vRectSweep) || !(vRect == vRectList))
+		{
+			cout << "mismatch in " << to_string(vOrient[i]) << ": " << vRect.size() << " vs " << vRectSweep.size() << " rectangles" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/// main function \n
+/// compare with @ref limbo::geometry::Polygon2Rectangle on gnuplot benchmarks in arguments and random polygons,
+/// then time both engines on a large polygon
+/// @param argc number of arguments
+/// @param argv gnuplot benchmarks
+/// @return 0 if all tests pass
+int main(int argc, char** argv)
+{
+	bool pass = true;
+	for (int i = 1; i < argc; ++i)
+	{
+		vector<Point> vPoint;
+		pass = readPolygon(argv[i], vPoint) && compare(vPoint) && pass;
+	}
+	srand(1);
+	for (int i = 0; i < 500; ++i)
+	{
+		vector<Point> vPoint;
+		randomPolygon(1+rand()%40, vPoint);
+		pass = compare(vPoint) && pass;
+	}
+
+	vector<Point> vPoint;
+	randomPolygon(20000, vPoint);
+	vector<Rectangle> vRect, vRectSweep;
+	clock_t t0 = clock();
+	Polygon2Rectangle<vector<Point>, vector<Rectangle> > p2r (vRect, vPoint.begin(), vPoint.end(), HORIZONTAL_SLICING);
+	pass = p2r() && pass;
+	clock_t t1 = clock();
+	Polygon2RectangleSweep<vector<Point>, vector<Rectangle> > p2rSweep (vRectSweep, vPoint.begin(), vPoint.end(), HORIZONTAL_SLICING);
+	pass = p2rSweep() && pass;
+	clock_t t2 = clock();
+	pass = (vRect == vRectSweep) && pass;
+	cout << vPoint.size() << " vertices, " << vRect.size() << " rectangles: Polygon2Rectangle " << (double)(t1-t0)/CLOCKS_PER_SEC
+		<< " s, Polygon2RectangleSweep " << (double)(t2-t1)/CLOCKS_PER_SEC << " s" << endl;
+
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
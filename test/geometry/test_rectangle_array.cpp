@@ -0,0 +1,101 @@
+/**
+ * @file   test_rectangle_array.cpp
+ * @brief  test kernels of @ref limbo::geometry::RectangleArray against loops over rectangles with @ref limbo::geometry::rectangle_traits
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+#include <boost/polygon/polygon.hpp>
+#include <limbo/geometry/api/BoostPolygonApi.h>
+#include <limbo/geometry/RectangleArray.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using namespace limbo::geometry;
+
+/// rectangle of Boost.Polygon
+typedef boost::polygon::rectangle_data<int> Rectangle;
+/// traits of rectangles
+typedef rectangle_traits<Rectangle> traits_type;
+
+/// main function \n
+/// compare bounding box, area, overlap and distance of random rectangles with loops over rectangles
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	vector<Rectangle> vRect;
+	for (int i = 0; i < 2000000; ++i)
+	{
+		int xl = rand()%100000-50000, yl = rand()%100000-50000;
+		vRect.push_back(Rectangle(xl, yl, xl+rand()%1000, yl+rand()%1000));
+	}
+	RectangleArray<int> array;
+	array.assign(vRect.begin(), vRect.end());
+	bool pass = (array.size() == vRect.size());
+	double vTime[2] = {0, 0};
+
+	// bounding box and area
+	clock_t t0 = clock();
+	int bxl = traits_type::get(vRect[0], LEFT), byl = traits_type::get(vRect[0], BOTTOM);
+	int bxh = traits_type::get(vRect[0], RIGHT), byh = traits_type::get(vRect[0], TOP);
+	long area = 0;
+	for (std::size_t i = 0; i < vRect.size(); ++i)
+	{
+		bxl = std::min(bxl, traits_type::get(vRect[i], LEFT));
+		byl = std::min(byl, traits_type::get(vRect[i], BOTTOM));
+		bxh = std::max(bxh, traits_type::get(vRect[i], RIGHT));
+		byh = std::max(byh, traits_type::get(vRect[i], TOP));
+		area += (long)(traits_type::get(vRect[i], RIGHT)-traits_type::get(vRect[i], LEFT))*(traits_type::get(vRect[i], TOP)-traits_type::get(vRect[i], BOTTOM));
+	}
+	clock_t t1 = clock();
+	int xl, yl, xh, yh;
+	pass = array.bbox(xl, yl, xh, yh) && xl == bxl && yl == byl && xh == bxh && yh == byh && pass;
+	pass = (array.area() == area) && pass;
+	clock_t t2 = clock();
+	vTime[0] += (double)(t1-t0)/CLOCKS_PER_SEC;
+	vTime[1] += (double)(t2-t1)/CLOCKS_PER_SEC;
+
+	// overlap and distance to random boxes
+	vector<unsigned char> vMask;
+	vector<long> vDistance;
+	for (int q = 0; q < 20; ++q)
+	{
+		int qxl = rand()%100000-50000, qyl = rand()%100000-50000;
+		int qxh = qxl+rand()%5000, qyh = qyl+rand()%5000;
+		t0 = clock();
+		std::size_t count = 0;
+		vector<unsigned char> vRefMask (vRect.size());
+		vector<long> vRefDistance (vRect.size());
+		for (std::size_t i = 0; i < vRect.size(); ++i)
+		{
+			int rxl = traits_type::get(vRect[i], LEFT), ryl = traits_type::get(vRect[i], BOTTOM);
+			int rxh = traits_type::get(vRect[i], RIGHT), ryh = traits_type::get(vRect[i], TOP);
+			vRefMask[i] = (rxl <= qxh && qxl <= rxh && ryl <= qyh && qyl <= ryh);
+			count += vRefMask[i];
+			long dx = (rxh < qxl)? qxl-rxh : (qxh < rxl)? rxl-qxh : 0;
+			long dy = (ryh < qyl)? qyl-ryh : (qyh < ryl)? ryl-qyh : 0;
+			vRefDistance[i] = dx+dy;
+		}
+		t1 = clock();
+		pass = (array.overlap(qxl, qyl, qxh, qyh, vMask) == count && vMask == vRefMask) && pass;
+		array.distance(qxl, qyl, qxh, qyh, vDistance);
+		t2 = clock();
+		pass = (vDistance == vRefDistance) && pass;
+		vTime[0] += (double)(t1-t0)/CLOCKS_PER_SEC;
+		vTime[1] += (double)(t2-t1)/CLOCKS_PER_SEC;
+	}
+
+	// empty array
+	RectangleArray<int> empty;
+	pass = !empty.bbox(xl, yl, xh, yh) && empty.area() == 0 && empty.overlap(0, 0, 1, 1, vMask) == 0 && vMask.empty() && pass;
+
+	cout << vRect.size() << " rectangles, loops with rectangle_traits " << vTime[0] << " s, RectangleArray " << vTime[1] << " s" << endl;
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file   test_rectangle_index.cpp
+ * @brief  test @ref limbo::geometry::PackedRTree and @ref limbo::geometry::BinGrid against brute force
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <boost/polygon/polygon.hpp>
+#include <limbo/geometry/api/BoostPolygonApi.h>
+#include <limbo/geometry/RectangleIndex.h>
+
+using std::cout;
+using std::endl;
+using std::vector;
+using namespace limbo::geometry;
+
+/// rectangle of Boost.Polygon
+typedef boost::polygon::rectangle_data<int> Rectangle;
+
+/// @return random rectangles in [0, size)^2, where one in five is a long wire up to longSize
+vector<Rectangle> randomRectangles(int n, int size, int longSize)
+{
+	vector<Rectangle> vRect;
+	for (int i = 0; i < n; ++i)
+	{
+		int xl = rand()%size, yl = rand()%size;
+		int w = (i%10 == 0)? rand()%(longSize+1) : rand()%(size/100+1);
+		int h = (i%10 == 1)? rand()%(longSize+1) : rand()%(size/100+1);
+		vRect.push_back(Rectangle(xl, yl, xl+w, yl+h));
+	}
+	return vRect;
+}
+
+/// @return positions of rectangles within distance d of a box, by brute force
+vector<std::size_t> bruteForce(vector<Rectangle> const& vRect, Rectangle const& box, int d)
+{
+	vector<std::size_t> vResult;
+	for (std::size_t i = 0; i < vRect.size(); ++i)
+		if (xl(vRect[i]) <= xh(box)+d && xl(box)-d <= xh(vRect[i]) && yl(vRect[i]) <= yh(box)+d && yl(box)-d <= yh(vRect[i]))
+			vResult.push_back(i);
+	return vResult;
+}
+
+/// compare an index with brute force and batch queries with single queries
+/// @return true if all results match
+template <typename IndexType>
+bool compare(IndexType const& index, vector<Rectangle> const& vRect, vector<Rectangle> const& vQuery, int d)
+{
+	vector<std::size_t> vOffset, vResult;
+	query_batch(index, vQuery.begin(), vQuery.end(), d, vOffset, vResult, 3);
+	for (std::size_t i = 0; i < vQuery.size(); ++i)
+	{
+		vector<std::size_t> vSingle;
+		index.query(vQuery[i], d, std::back_inserter(vSingle));
+		if (!std::equal(vSingle.begin(), vSingle.end(), vResult.begin()+vOffset[i]) || vSingle.size() != vOffset[i+1]-vOffset[i])
+			return false;
+		std::sort(vSingle.begin(), vSingle.end());
+		if (vSingle != bruteForce(vRect, vQuery[i], d))
+			return false;
+	}
+	return true;
+}
+
+/// main function \n
+/// verify both indices with random rectangles, then time batch queries on a large set
+/// @return 0 if all tests pass
+int main()
+{
+	srand(1);
+	bool pass = true;
+	for (int iter = 0; iter < 50; ++iter)
+	{
+		vector<Rectangle> vRect = randomRectangles(rand()%2000, 1000, 250);
+		vector<Rectangle> vQuery = randomRectangles(300, 1100, 250);
+		PackedRTree<Rectangle> rtree (2+rand()%20);
+		rtree.build(vRect.begin(), vRect.end());
+		BinGrid<Rectangle> grid;
+		if (iter%2)
+			grid.build(vRect.begin(), vRect.end());
+		else
+			grid.build(vRect.begin(), vRect.end(), 1+rand()%50, 1+rand()%50);
+		for (int d = 0; d <= 20; d += 10)
+		{
+			if (!compare(rtree, vRect, vQuery, d))
+			{
+				cout << "R-tree failed at iteration " << iter << " distance " << d << endl;
+				pass = false;
+			}
+			if (!compare(grid, vRect, vQuery, d))
+			{
+				cout << "bin grid failed at iteration " << iter << " distance " << d << endl;
+				pass = false;
+			}
+		}
+	}
+
+	vector<Rectangle> vRect = randomRectangles(1000000, 1000000, 20000);
+	vector<Rectangle> vQuery = randomRectangles(200000, 1000000, 20000);
+	clock_t t0 = clock();
+	PackedRTree<Rectangle> rtree;
+	rtree.build(vRect.begin(), vRect.end());
+	clock_t t1 = clock();
+	BinGrid<Rectangle> grid;
+	grid.build(vRect.begin(), vRect.end());
+	clock_t t2 = clock();
+	vector<std::size_t> vOffset1, vResult1, vOffset2, vResult2;
+	query_batch(rtree, vQuery.begin(), vQuery.end(), 0, vOffset1, vResult1, 4);
+	clock_t t3 = clock();
+	query_batch(grid, vQuery.begin(), vQuery.end(), 0, vOffset2, vResult2, 4);
+	clock_t t4 = clock();
+	pass = (vOffset1 == vOffset2) && pass;
+	cout << vRect.size() << " rectangles, " << vQuery.size() << " queries, " << vResult1.size() << " results" << endl;
+	cout << "R-tree build " << (double)(t1-t0)/CLOCKS_PER_SEC << " s, query " << (double)(t3-t2)/CLOCKS_PER_SEC << " s" << endl;
+	cout << "bin grid " << grid.num_bins_x() << "x" << grid.num_bins_y() << " build " << (double)(t2-t1)/CLOCKS_PER_SEC
+		<< " s, query " << (double)(t4-t3)/CLOCKS_PER_SEC << " s" << endl;
+
+	cout << (pass? "passed" : "failed") << endl;
+	return pass? 0 : 1;
+}
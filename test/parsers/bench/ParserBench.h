@@ -0,0 +1,159 @@
+/**
+ * @file   bench/ParserBench.h
+ * @brief  common code of the parser benchmarks: timing, peak memory, allocation counts and result lines
+ * @date   Oct 2026
+ *
+ * Each backend is measured by its own executable, e.g., bench_def_bison,
+ * so that peak RSS and allocation counts belong to one backend only.
+ * An executable is called as
+ * ~~~~~~~~~~~~~~~~
+ * bench_<format>_<backend> file [runs] [variant]
+ * ~~~~~~~~~~~~~~~~
+ * and prints one result line in JSON on stdout, which starts with {"format":
+ * so that it can be told apart from messages of the parser.
+ * @ref bench_parsers.cpp generates the inputs, runs all executables and collects the lines.
+ */
+
+#ifndef LIMBO_TEST_PARSERS_BENCH_PARSERBENCH_H
+#define LIMBO_TEST_PARSERS_BENCH_PARSERBENCH_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+/// @brief allocation counters, defined in ParserBenchAlloc.cpp
+namespace ParserBench {
+
+/// @brief number of allocations since the start of the process
+unsigned long allocation_count();
+/// @brief number of bytes allocated since the start of the process
+unsigned long allocation_bytes();
+
+/// @return monotonic time in seconds
+inline double now()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+/// @return peak resident set size of the process in KB
+inline long peak_rss_kb()
+{
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss/1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+/// @return size of a file in bytes, or 0 if it does not exist
+inline unsigned long file_size(std::string const& filename)
+{
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0)
+        return 0;
+    return st.st_size;
+}
+
+/// @brief measurements of one backend
+struct Result
+{
+    std::string format; ///< file format, e.g., def
+    std::string backend; ///< backend, e.g., bison
+    std::string filename; ///< input file
+    unsigned long bytes; ///< file size
+    unsigned long objects; ///< number of objects reported by the backend in one run
+    std::vector<double> vSeconds; ///< wall time of each run
+    long baseRssKB; ///< peak RSS before the first run
+    long peakRssKB; ///< peak RSS after all runs
+    unsigned long allocs; ///< number of allocations in the first run
+    unsigned long allocBytes; ///< number of bytes allocated in the first run
+    bool ok; ///< whether all runs succeed
+
+    /// @brief constructor
+    Result() : bytes(0), objects(0), baseRssKB(0), peakRssKB(0), allocs(0), allocBytes(0), ok(true) {}
+
+    /// @return time of the fastest run
+    double best() const {return vSeconds.empty()? 0 : *std::min_element(vSeconds.begin(), vSeconds.end());}
+    /// @return average time of all runs
+    double average() const
+    {
+        double sum = 0;
+        for (std::size_t i = 0; i < vSeconds.size(); ++i)
+            sum += vSeconds[i];
+        return vSeconds.empty()? 0 : sum/vSeconds.size();
+    }
+
+    /// @brief print one line of JSON
+    /// @param fp output file
+    void print(FILE* fp = stdout) const
+    {
+        double t = best();
+        fprintf(fp, "{\"format\": \"%s\", \"backend\": \"%s\", \"file\": \"%s\", \"ok\": %s, \"bytes\": %lu, \"objects\": %lu, "
+                "\"runs\": %lu, \"best_s\": %.6f, \"avg_s\": %.6f, \"mb_per_s\": %.3f, \"objects_per_s\": %.1f, "
+                "\"base_rss_kb\": %ld, \"peak_rss_kb\": %ld, \"allocs\": %lu, \"alloc_bytes\": %lu}\n",
+                format.c_str(), backend.c_str(), filename.c_str(), ok? "true" : "false", bytes, objects,
+                (unsigned long)vSeconds.size(), t, average(), (t > 0)? bytes/t/1e6 : 0.0, (t > 0)? objects/t : 0.0,
+                baseRssKB, peakRssKB, allocs, allocBytes);
+        fflush(fp);
+    }
+};
+
+/// @brief run a backend several times and print the result line.
+/// @tparam RunnerType function object with signature bool (std::string const& filename, unsigned long& objects)
+/// @param format file format
+/// @param backend name of the backend
+/// @param argc number of arguments of main
+/// @param argv values of arguments of main: file [runs]
+/// @param runner reads the file once
+/// @return exit code of main
+template <typename RunnerType>
+int run(const char* format, std::string const& backend, int argc, char** argv, RunnerType runner)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s file [runs]\n", argv[0]);
+        return 1;
+    }
+    Result result;
+    result.format = format;
+    result.backend = backend;
+    result.filename = argv[1];
+    result.bytes = file_size(result.filename);
+    int numRuns = (argc > 2)? std::max(atoi(argv[2]), 1) : 3;
+    result.baseRssKB = peak_rss_kb();
+
+    for (int i = 0; i < numRuns; ++i)
+    {
+        unsigned long objects = 0;
+        unsigned long allocs = allocation_count();
+        unsigned long allocBytes = allocation_bytes();
+        double start = now();
+        bool ok = runner(result.filename, objects);
+        result.vSeconds.push_back(now()-start);
+        result.ok = result.ok && ok;
+        if (i == 0)
+        {
+            result.objects = objects;
+            result.allocs = allocation_count()-allocs;
+            result.allocBytes = allocation_bytes()-allocBytes;
+        }
+    }
+    result.peakRssKB = peak_rss_kb();
+    result.print();
+
+    return result.ok? 0 : 1;
+}
+
+} // namespace ParserBench
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file   bench/ParserBenchAlloc.cpp
+ * @brief  count allocations of the parser benchmarks
+ * @date   Oct 2026
+ *
+ * Global operator new is replaced to count allocations of C++ code.
+ * With PARSER_BENCH_WRAP_MALLOC, the executable is linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,
+ * so malloc calls in statically linked parsers, e.g., the C code of the LEF and DEF libraries, are counted as well.
+ * Allocations inside shared libraries, like strdup of libc, are not counted.
+ */
+
+#include <cstdlib>
+#include <new>
+#include "ParserBench.h"
+
+namespace ParserBench {
+
+static unsigned long g_allocCount = 0; ///< number of allocations
+static unsigned long g_allocBytes = 0; ///< number of bytes allocated
+
+/// @brief count one allocation, safe for parsers with multiple threads
+static inline void count_allocation(std::size_t n)
+{
+    __sync_fetch_and_add(&g_allocCount, 1UL);
+    __sync_fetch_and_add(&g_allocBytes, (unsigned long)n);
+}
+
+unsigned long allocation_count()
+{
+    return __sync_fetch_and_add(&g_allocCount, 0UL);
+}
+
+unsigned long allocation_bytes()
+{
+    return __sync_fetch_and_add(&g_allocBytes, 0UL);
+}
+
+} // namespace ParserBench
+
+#ifdef PARSER_BENCH_WRAP_MALLOC
+extern "C" {
+
+void* __real_malloc(std::size_t n);
+void* __real_calloc(std::size_t m, std::size_t n);
+void* __real_realloc(void* p, std::size_t n);
+
+void* __wrap_malloc(std::size_t n)
+{
+    ParserBench::count_allocation(n);
+    return __real_malloc(n);
+}
+
+void* __wrap_calloc(std::size_t m, std::size_t n)
+{
+    ParserBench::count_allocation(m*n);
+    return __real_calloc(m, n);
+}
+
+void* __wrap_realloc(void* p, std::size_t n)
+{
+    ParserBench::count_allocation(n);
+    return __real_realloc(p, n);
+}
+
+} // extern "C"
+#endif
+
+/// @brief allocate memory and count it, unless malloc is counted already
+/// @param n number of bytes
+/// @return allocated memory
+static void* bench_allocate(std::size_t n)
+{
+#ifndef PARSER_BENCH_WRAP_MALLOC
+    ParserBench::count_allocation(n);
+#endif
+    void* p = std::malloc(n? n : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+/// @nowarn
+#if __cplusplus >= 201103L
+void* operator new(std::size_t n) {return bench_allocate(n);}
+void* operator new[](std::size_t n) {return bench_allocate(n);}
+void operator delete(void* p) noexcept {std::free(p);}
+void operator delete[](void* p) noexcept {std::free(p);}
+#else
+void* operator new(std::size_t n) throw(std::bad_alloc) {return bench_allocate(n);}
+void* operator new[](std::size_t n) throw(std::bad_alloc) {return bench_allocate(n);}
+void operator delete(void* p) throw() {std::free(p);}
+void operator delete[](void* p) throw() {std::free(p);}
+#endif
+/// @endnowarn
@@ -0,0 +1,55 @@
+/**
+ * @file   bench/bench_def_spirit.cpp
+ * @brief  benchmark of the Boost.Spirit DEF parser
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/def/spirit/DefParser.h>
+#include "ParserBench.h"
+
+/// @brief a database only counting components, pins and nets
+class CountDataBase : public DefParser::DefDataBase
+{
+	public:
+        /// @brief constructor 
+		CountDataBase() : numObjects(0) {}
+        /// @nowarn 
+		virtual void set_def_dividerchar(std::string const&) {}
+		virtual void set_def_busbitchars(std::string const&) {}
+		virtual void set_def_version(std::string const&) {}
+		virtual void set_def_design(std::string const&) {}
+		virtual void set_def_unit(int) {}
+		virtual void set_def_diearea(int, int, int, int) {}
+		virtual void add_def_row(DefParser::Row const&) {}
+		virtual void add_def_component(DefParser::Component const&) {++numObjects;}
+		virtual void resize_def_component(int) {}
+		virtual void add_def_pin(DefParser::Pin const&) {++numObjects;}
+		virtual void resize_def_pin(int) {}
+		virtual void add_def_net(DefParser::Net const&) {++numObjects;}
+		virtual void resize_def_net(int) {}
+        /// @endnowarn 
+
+		unsigned long numObjects; ///< number of components, pins and nets 
+};
+
+/// @brief read a DEF file 
+struct Runner
+{
+    /// @brief read once 
+    bool operator()(std::string const& filename, unsigned long& objects) const 
+    {
+        CountDataBase db;
+        bool ok = DefParser::read(db, filename);
+        objects = db.numObjects;
+        return ok;
+    }
+};
+
+/// @brief main function 
+/// @param argc number of arguments 
+/// @param argv values of arguments: file [runs]
+/// @return 0 if succeed 
+int main(int argc, char** argv)
+{
+    return ParserBench::run("def", "spirit", argc, argv, Runner());
+}
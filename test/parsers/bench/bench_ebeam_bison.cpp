@@ -0,0 +1,45 @@
+/**
+ * @file   bench/bench_ebeam_bison.cpp
+ * @brief  benchmark of the bison Ebeam parser, see @ref EbeamParser::Driver
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/ebeam/bison/EbeamDriver.h>
+#include "ParserBench.h"
+
+/// @brief a database only counting macros and conflict sites
+class CountDataBase : public EbeamParser::EbeamDataBase
+{
+	public:
+        /// @brief constructor 
+		CountDataBase() : numObjects(0) {}
+        /// @nowarn 
+		virtual void set_ebeam_unit(int) {}
+		virtual void set_ebeam_boundary(EbeamParser::EbeamBoundary const&) {}
+		virtual void add_ebeam_macro(EbeamParser::Macro const& m) {numObjects += 1+m.vConfSite.size();}
+        /// @endnowarn 
+
+		unsigned long numObjects; ///< number of macros and conflict sites 
+};
+
+/// @brief read an Ebeam file 
+struct Runner
+{
+    /// @brief read once 
+    bool operator()(std::string const& filename, unsigned long& objects) const 
+    {
+        CountDataBase db;
+        bool ok = EbeamParser::read(db, filename);
+        objects = db.numObjects;
+        return ok;
+    }
+};
+
+/// @brief main function 
+/// @param argc number of arguments 
+/// @param argv values of arguments: file [runs]
+/// @return 0 if succeed 
+int main(int argc, char** argv)
+{
+    return ParserBench::run("ebeam", "bison", argc, argv, Runner());
+}
@@ -0,0 +1,56 @@
+/**
+ * @file   bench/bench_gds_ascii.cpp
+ * @brief  benchmark of the ASCII GDSII parsers, see @ref GdsTxtParser and @ref GdsTxtReader
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/gdsii/ascii/spirit/GdsTxtParser.h>
+#include <limbo/parsers/gdsii/ascii/spirit/GdsTxtReader.h>
+#include "ParserBench.h"
+
+/// @brief a database only counting boundaries and texts
+struct CountDataBase 
+{
+    /// @brief constructor
+    CountDataBase() : numObjects(0) {}
+    /// @brief add a library 
+    void add_gds_lib(GdsTxtData::GdsLib const& lib)
+    {
+        for (std::size_t i = 0; i < lib.vCell.size(); ++i)
+            numObjects += lib.vCell[i].vBoundary.size()+lib.vCell[i].vText.size();
+    }
+
+    unsigned long numObjects; ///< number of boundaries and texts
+};
+
+/// @brief read an ASCII GDSII file with one of the parsers
+struct Runner
+{
+    bool spirit; ///< true for GdsTxtParser, false for GdsTxtReader 
+
+    /// @brief read once 
+    bool operator()(std::string const& filename, unsigned long& objects) const 
+    {
+        CountDataBase db;
+        bool ok = spirit? GdsTxtParser::read(db, filename) : GdsTxtReader::read(db, filename);
+        objects = db.numObjects;
+        return ok;
+    }
+};
+
+/// @brief main function 
+/// @param argc number of arguments 
+/// @param argv values of arguments: file [runs] [spirit|reader]
+/// @return 0 if succeed 
+int main(int argc, char** argv)
+{
+    std::string backend = (argc > 3)? argv[3] : "reader";
+    if (backend != "spirit" && backend != "reader")
+    {
+        fprintf(stderr, "unknown parser %s, expect spirit or reader\n", backend.c_str());
+        return 1;
+    }
+    Runner runner;
+    runner.spirit = (backend == "spirit");
+    return ParserBench::run("gds_ascii", "ascii_"+backend, argc, argv, runner);
+}
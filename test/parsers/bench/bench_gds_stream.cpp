@@ -0,0 +1,86 @@
+/**
+ * @file   bench/bench_gds_stream.cpp
+ * @brief  benchmark of the GDSII stream readers, see @ref GdsParser::GdsReader and @ref GdsParser::GdsDB::GdsReader
+ * @date   Oct 2026
+ */
+
+#include <cstring>
+#include <limbo/parsers/gdsii/stream/GdsReader.h>
+#include <limbo/parsers/gdsii/gdsdb/GdsIO.h>
+#include "ParserBench.h"
+
+/// @brief a database only counting elements, to measure the cost of the reader itself
+struct CountDataBase : public GdsParser::GdsDataBaseKernel
+{
+    /// @brief constructor
+    CountDataBase() : numObjects(0) {}
+
+    /// @nowarn
+    virtual void bit_array_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<int> const&) {}
+    virtual void integer_2_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<int> const&) {}
+    virtual void integer_4_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<int> const&) {}
+    virtual void real_4_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<double> const&) {}
+    virtual void real_8_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<double> const&) {}
+    virtual void string_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::string const&) {}
+    virtual void begin_end_cbk(GdsParser::GdsRecords::EnumType record_type) 
+    {
+        switch (record_type)
+        {
+            case GdsParser::GdsRecords::BOUNDARY:
+            case GdsParser::GdsRecords::BOX:
+            case GdsParser::GdsRecords::PATH:
+            case GdsParser::GdsRecords::TEXT:
+            case GdsParser::GdsRecords::SREF:
+            case GdsParser::GdsRecords::AREF:
+                ++numObjects;
+                break;
+            default:
+                break;
+        }
+    }
+    /// @endnowarn
+
+    unsigned long numObjects; ///< number of elements
+};
+
+/// @brief read a GDSII file with one of the readers
+struct Runner
+{
+    std::string backend; ///< stream, mmap or gdsdb
+
+    /// @brief read once 
+    bool operator()(std::string const& filename, unsigned long& objects) const 
+    {
+        if (backend == "gdsdb")
+        {
+            GdsParser::GdsDB::GdsDB db;
+            GdsParser::GdsDB::GdsReader reader (db);
+            bool ok = reader(filename);
+            objects = 0;
+            for (std::size_t i = 0; i < db.cells().size(); ++i)
+                objects += db.cells()[i].objects().size();
+            return ok;
+        }
+        CountDataBase db;
+        GdsParser::GdsReader reader (db);
+        bool ok = (backend == "mmap")? reader.read_mmap(filename.c_str()) : reader(filename.c_str());
+        objects = db.numObjects;
+        return ok;
+    }
+};
+
+/// @brief main function 
+/// @param argc number of arguments 
+/// @param argv values of arguments: file [runs] [stream|mmap|gdsdb]
+/// @return 0 if succeed 
+int main(int argc, char** argv)
+{
+    Runner runner;
+    runner.backend = (argc > 3)? argv[3] : "stream";
+    if (runner.backend != "stream" && runner.backend != "mmap" && runner.backend != "gdsdb")
+    {
+        fprintf(stderr, "unknown reader %s, expect stream, mmap or gdsdb\n", runner.backend.c_str());
+        return 1;
+    }
+    return ParserBench::run("gds", runner.backend, argc, argv, runner);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file   bench/bench_lef_bison.cpp
+ * @brief  benchmark of the bison LEF parser, see @ref LefParser::Driver
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/lef/bison/LefDriver.h>
+#include "ParserBench.h"
+
+/// @brief a database only counting layers, sites, macros and pins. 
+/// All callbacks for statements in generated LEF files are defined, 
+/// because the default ones exit. 
+class CountDataBase : public LefParser::LefDataBase
+{
+	public:
+        /// @brief constructor 
+		CountDataBase() : LefParser::LefDataBase(), numObjects(0) {}
+        /// @nowarn 
+		virtual void lef_version_cbk(std::string const&) {}
+		virtual void lef_version_cbk(double) {}
+		virtual void lef_dividerchar_cbk(std::string const&) {}
+		virtual void lef_busbitchars_cbk(std::string const&) {}
+		virtual void lef_casesensitive_cbk(int) {}
+		virtual void lef_manufacturing_cbk(double) {}
+		virtual void lef_units_cbk(LefParser::lefiUnits const&) {}
+		virtual void lef_layer_cbk(LefParser::lefiLayer const&) {++numObjects;}
+		virtual void lef_site_cbk(LefParser::lefiSite const&) {++numObjects;}
+		virtual void lef_macro_cbk(LefParser::lefiMacro const& v) {numObjects += 1+v.numPins();}
+        /// @endnowarn 
+
+		unsigned long numObjects; ///< number of layers, sites, macros and pins 
+};
+
+/// @brief read a LEF file 
+struct Runner
+{
+    /// @brief read once 
+    bool operator()(std::string const& filename, unsigned long& objects) const 
+    {
+        CountDataBase db;
+        bool ok = LefParser::read(db, filename);
+        objects = db.numObjects;
+        return ok;
+    }
+};
+
+/// @brief main function 
+/// @param argc number of arguments 
+/// @param argv values of arguments: file [runs]
+/// @return 0 if succeed 
+int main(int argc, char** argv)
+{
+    return ParserBench::run("lef", "bison", argc, argv, Runner());
+}
@@ -0,0 +1,47 @@
+/**
+ * @file   bench/bench_lef_spirit.cpp
+ * @brief  benchmark of the Boost.Spirit LEF parser
+ * @date   Oct 2026
+ */
+
+#include <limbo/parsers/lef/spirit/LefParser.h>
+#include "ParserBench.h"
+
+/// @brief a database only counting layers, sites, macros and pins
+class CountDataBase : public LefParser::LefDataBase
+{
+	public:
+        /// @brief constructor 
+		CountDataBase() : numObjects(0) {}
+        /// @nowarn 
+		virtual void set_lef_version(std::string const&) {}
+		virtual void set_lef_unit(boost::int32_t const&) {}
+		virtual void set_lef_site(LefParser::Site const&) {++numObjects;}
+		virtual void add_lef_layer(LefParser::Layer const&) {++numObjects;}
+		virtual void add_lef_macro(LefParser::Macro const& m) {numObjects += 1+m.vPin.size();}
+        /// @endnowarn 
+
+		unsigned long numObjects; ///< number of layers, sites, macros and pins 
+};
+
+/// @brief read a LEF file 
+struct Runner
+{
+    /// @brief read once 
+    bool operator()(std::string const& filename, unsigned long& objects) const 
+    {
+        CountDataBase db;
+        bool ok = LefParser::read(db, filename);
+        objects = db.numObjects;
+        return ok;
+    }
+};
+
+/// @brief main function 
+/// @param argc number of arguments 
+/// @param argv values of arguments: file [runs]
+/// @return 0 if succeed 
+int main(int argc, char** argv)
+{
+    return ParserBench::run("lef", "spirit", argc, argv, Runner());
+}
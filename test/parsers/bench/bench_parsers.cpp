@@ -0,0 +1,441 @@
+/**
+ * @file   bench/bench_parsers.cpp
+ * @brief  generate synthetic DEF, LEF, Ebeam and GDSII inputs, run all parser benchmarks and gate regressions
+ * @date   Oct 2026
+ *
+ * Each backend runs in its own process, see @ref ParserBench.h,
+ * and the result lines are collected into a JSON lines file.
+ * With -baseline, results are compared with an earlier file by (format, backend),
+ * and the program fails if a backend becomes slower or uses more memory than the tolerance.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+#include <limbo/programoptions/ProgramOptions.h>
+#ifdef PARSER_BENCH_GDSII_STREAM
+#include <limbo/parsers/gdsii/stream/GdsWriter.h>
+#endif
+#include "ParserBench.h"
+
+/// @brief write a placed design with \a n components, \a n nets and n/50 pins.
+/// Only statements supported by all DEF parsers are written.
+/// @param filename output file
+/// @param n number of components
+/// @return true if succeed
+bool writeDef(std::string const& filename, unsigned n)
+{
+    FILE* fp = fopen(filename.c_str(), "w");
+    if (!fp)
+        return false;
+    static const char* macros[] = {"INV_X1", "NAND2_X1", "NOR2_X1", "AOI21_X1", "DFF_X1", "BUF_X2", "XOR2_X1", "OAI22_X1"};
+    static const char* pins[] = {"A", "B", "ZN", "CK"};
+    unsigned numPins = std::max(n/50, 1U);
+    unsigned numRows = std::max((unsigned)std::sqrt((double)n)/4, 1U);
+    unsigned sitesPerRow = n/numRows+1;
+
+    fprintf(fp, "VERSION 5.7 ;\nDIVIDERCHAR \"/\" ;\nBUSBITCHARS \"[]\" ;\nDESIGN bench ;\nUNITS DISTANCE MICRONS 1000 ;\n\n");
+    fprintf(fp, "DIEAREA ( 0 0 ) ( %u %u ) ;\n\n", sitesPerRow*200, numRows*2000);
+    for (unsigned i = 0; i < numRows; ++i)
+        fprintf(fp, "ROW row_%u core 0 %u %s DO %u BY 1 STEP 200 0 ;\n", i, i*2000, (i%2)? "FS" : "N", sitesPerRow);
+
+    fprintf(fp, "\nCOMPONENTS %u ;\n", n);
+    for (unsigned i = 0; i < n; ++i)
+        fprintf(fp, "   - c%u %s\n      + PLACED ( %u %u ) %s ;\n", i, macros[i%8], (i%sitesPerRow)*200, (i/sitesPerRow)*2000, ((i/sitesPerRow)%2)? "FS" : "N");
+    fprintf(fp, "END COMPONENTS\n\n");
+
+    fprintf(fp, "PINS %u ;\n", numPins);
+    for (unsigned i = 0; i < numPins; ++i)
+        fprintf(fp, "   - p%u + NET n%u\n      + DIRECTION %s\n      + LAYER metal3 ( -50 -50 ) ( 50 50 )\n      + FIXED ( %u 0 ) N ;\n",
+                i, i, (i%2)? "OUTPUT" : "INPUT", (i%sitesPerRow)*200);
+    fprintf(fp, "END PINS\n\n");
+
+    fprintf(fp, "NETS %u ;\n", n);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        fprintf(fp, "   - n%u", i);
+        if (i < numPins)
+            fprintf(fp, " ( PIN p%u )", i);
+        // a driver and 1 to 4 sinks nearby
+        unsigned degree = 2+i%4;
+        for (unsigned j = 0; j < degree; ++j)
+            fprintf(fp, " ( c%u %s )", (i+j*7)%n, pins[(i+j)%4]);
+        fprintf(fp, " ;\n");
+    }
+    fprintf(fp, "END NETS\n\nEND DESIGN\n");
+    fclose(fp);
+    return true;
+}
+
+/// @brief write a library with 4 routing layers and \a n macros with 4 pins and obstructions.
+/// Only statements supported by all LEF parsers are written.
+/// @param filename output file
+/// @param n number of macros
+/// @return true if succeed
+bool writeLef(std::string const& filename, unsigned n)
+{
+    FILE* fp = fopen(filename.c_str(), "w");
+    if (!fp)
+        return false;
+    fprintf(fp, "VERSION 5.7 ;\nBUSBITCHARS \"[]\" ;\nDIVIDERCHAR \"/\" ;\n\nUNITS\n  DATABASE MICRONS 2000 ;\nEND UNITS\n\nMANUFACTURINGGRID 0.005 ;\n\n");
+    for (unsigned i = 1; i <= 4; ++i)
+        fprintf(fp, "LAYER metal%u\n  TYPE ROUTING ;\n  DIRECTION %s ;\n  PITCH 0.19 ;\n  WIDTH 0.07 ;\n  SPACING 0.065 ;\nEND metal%u\n\n",
+                i, (i%2)? "HORIZONTAL" : "VERTICAL", i);
+    fprintf(fp, "SITE core\n  SIZE 0.19 BY 1.4 ;\n  CLASS CORE ;\n  SYMMETRY Y ;\nEND core\n\n");
+
+    static const char* pins[] = {"A", "B", "ZN", "CK"};
+    static const char* directions[] = {"INPUT", "INPUT", "OUTPUT", "INPUT"};
+    for (unsigned i = 0; i < n; ++i)
+    {
+        double width = 0.19*(2+i%8);
+        fprintf(fp, "MACRO cell%u\n  CLASS CORE ;\n  ORIGIN 0 0 ;\n  SIZE %g BY 1.4 ;\n  SYMMETRY X Y ;\n  SITE core ;\n", i, width);
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            double x = 0.19*j;
+            fprintf(fp, "  PIN %s\n    DIRECTION %s ;\n    USE SIGNAL ;\n    PORT\n      LAYER metal1 ;\n", pins[j], directions[j]);
+            fprintf(fp, "        RECT %g 0.3 %g 0.9 ;\n        RECT %g 0.5 %g 0.6 ;\n    END\n  END %s\n", x, x+0.07, x, x+0.15, pins[j]);
+        }
+        fprintf(fp, "  OBS\n    LAYER metal1 ;\n      RECT 0 0 %g 0.1 ;\n      RECT 0 1.3 %g 1.4 ;\n  END\nEND cell%u\n\n", width, width, i);
+    }
+    fprintf(fp, "END LIBRARY\n");
+    fclose(fp);
+    return true;
+}
+
+/// @brief write ebeam configurations of \a n macros with 4 conflict sites
+/// @param filename output file
+/// @param n number of macros
+/// @return true if succeed
+bool writeEbeam(std::string const& filename, unsigned n)
+{
+    FILE* fp = fopen(filename.c_str(), "w");
+    if (!fp)
+        return false;
+    fprintf(fp, "UNITS\n  DATABASE MICRONS 2000 ;\nEND UNITS\n\n");
+    fprintf(fp, "EBEAMBOUNDARY\n  OFFSET 0 ;\n  WIDTH 0.1 ;\n  STEP 5 ;\n  LAYERID 15 16 ;\nEND EBEAMBOUNDARY\n\n");
+    for (unsigned i = 0; i < n; ++i)
+    {
+        fprintf(fp, "MACRO cell%u\n", i);
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            fprintf(fp, "  CONFLICTSITE C%u\n    LAYERID %u ;\n    SITE", j, j*5);
+            for (unsigned k = 0; k < 4+(i+j)%8; ++k)
+                fprintf(fp, " %u", k);
+            fprintf(fp, " ;\n  END C%u\n", j);
+        }
+        fprintf(fp, "END cell%u\n\n", i);
+    }
+    fprintf(fp, "END LIBRARY\n");
+    fclose(fp);
+    return true;
+}
+
+/// @brief write the same flat layout as GDSII stream and ASCII GDSII.
+/// Cells have 1000 elements, rectangles and L-shapes as boundaries and every 8th element a text,
+/// because the ASCII parsers only support BOUNDARY and TEXT.
+/// @param gdsFilename output GDSII file, not written without the stream parser
+/// @param asciiFilename output ASCII GDSII file
+/// @param n number of elements
+/// @return true if succeed
+bool writeGds(std::string const& gdsFilename, std::string const& asciiFilename, unsigned n)
+{
+    FILE* fp = fopen(asciiFilename.c_str(), "w");
+    if (!fp)
+        return false;
+#ifdef PARSER_BENCH_GDSII_STREAM
+    GdsParser::GdsWriter gw (gdsFilename.c_str());
+    gw.create_lib("bench", 0.001, 1.0e-9);
+#else
+    (void)gdsFilename;
+#endif
+    fprintf(fp, "HEADER: 600\nBGNLIB: 2026, 10, 15, 0, 0, 0, 2026, 10, 15, 0, 0, 0\nLIBNAME: \"bench\"\nUNITS: 0.001, 1e-09\n");
+
+    std::vector<int> vx;
+    std::vector<int> vy;
+    unsigned numCells = (n+999)/1000;
+    for (unsigned c = 0; c < numCells; ++c)
+    {
+        char name[32];
+        sprintf(name, "CELL_%u", c);
+#ifdef PARSER_BENCH_GDSII_STREAM
+        gw.gds_write_bgnstr();
+        gw.gds_write_strname(name);
+#endif
+        fprintf(fp, "BGNSTR: 2026, 10, 15, 0, 0, 0, 2026, 10, 15, 0, 0, 0\nSTRNAME: \"%s\"\n", name);
+        for (unsigned i = c*1000; i < std::min((c+1)*1000, n); ++i)
+        {
+            int layer = i%16;
+            int xl = (i%100)*200;
+            int yl = ((i%1000)/100)*200;
+            if (i%8 == 7)
+            {
+#ifdef PARSER_BENCH_GDSII_STREAM
+                int x = xl, y = yl;
+                gw.gds_write_text();
+                gw.gds_write_layer(layer);
+                gw.gds_write_texttype(0);
+                gw.gds_write_xy(&x, &y, 1);
+                gw.gds_write_string("net");
+                gw.gds_write_endel();
+#endif
+                fprintf(fp, "TEXT\nLAYER: %d\nTEXTTYPE: 0\nXY: %d, %d\nSTRING: \"net\"\nENDEL\n", layer, xl, yl);
+                continue;
+            }
+            if (i%8 < 4) // rectangles
+            {
+                int px[] = {xl, xl+100, xl+100, xl, xl};
+                int py[] = {yl, yl, yl+50, yl+50, yl};
+                vx.assign(px, px+5);
+                vy.assign(py, py+5);
+            }
+            else // L-shapes
+            {
+                int px[] = {xl, xl+100, xl+100, xl+40, xl+40, xl, xl};
+                int py[] = {yl, yl, yl+40, yl+40, yl+100, yl+100, yl};
+                vx.assign(px, px+7);
+                vy.assign(py, py+7);
+            }
+#ifdef PARSER_BENCH_GDSII_STREAM
+            gw.write_boundary(layer, 0, vx, vy, true);
+#endif
+            fprintf(fp, "BOUNDARY\nLAYER: %d\nDATATYPE: 0\nXY:", layer);
+            for (std::size_t j = 0; j < vx.size(); ++j)
+                fprintf(fp, "%s %d, %d", (j)? "," : "", vx[j], vy[j]);
+            fprintf(fp, "\nENDEL\n");
+        }
+#ifdef PARSER_BENCH_GDSII_STREAM
+        gw.gds_write_endstr();
+#endif
+        fprintf(fp, "ENDSTR\n");
+    }
+#ifdef PARSER_BENCH_GDSII_STREAM
+    gw.gds_write_endlib();
+#endif
+    fprintf(fp, "ENDLIB\n");
+    fclose(fp);
+    return true;
+}
+
+/// @brief a benchmark executable with its arguments
+struct Job
+{
+    std::string format; ///< file format
+    std::string program; ///< executable name
+    std::string filename; ///< input file
+    std::string variant; ///< extra argument after the number of runs
+};
+
+/// @brief extract a field from a result line, enough for lines printed by @ref ParserBench::Result::print
+/// @param line one line of JSON
+/// @param key field name
+/// @return value without quotes, empty if not found
+std::string field(std::string const& line, std::string const& key)
+{
+    std::string pattern = "\"" + key + "\": ";
+    std::size_t pos = line.find(pattern);
+    if (pos == std::string::npos)
+        return "";
+    pos += pattern.size();
+    if (line[pos] == '"')
+        return line.substr(pos+1, line.find('"', pos+1)-pos-1);
+    return line.substr(pos, line.find_first_of(",}", pos)-pos);
+}
+
+/// @brief compare results with a baseline
+/// @param vLine result lines
+/// @param baseline baseline file
+/// @param tolerance relative tolerance of throughput and peak memory
+/// @return number of regressions
+int compare(std::vector<std::string> const& vLine, std::string const& baseline, double tolerance)
+{
+    std::ifstream in (baseline.c_str());
+    if (!in.good())
+    {
+        printf("failed to open baseline %s\n", baseline.c_str());
+        return 1;
+    }
+    std::map<std::string, std::string> mBaseline;
+    std::string line;
+    while (std::getline(in, line))
+        if (line.compare(0, 10, "{\"format\":") == 0)
+            mBaseline[field(line, "format")+"/"+field(line, "backend")] = line;
+
+    int numRegressions = 0;
+    printf("\n%-24s %12s %12s %12s %12s\n", "backend", "MB/s", "base MB/s", "RSS KB", "base RSS KB");
+    for (std::size_t i = 0; i < vLine.size(); ++i)
+    {
+        std::string key = field(vLine[i], "format")+"/"+field(vLine[i], "backend");
+        std::map<std::string, std::string>::const_iterator found = mBaseline.find(key);
+        if (found == mBaseline.end())
+        {
+            printf("%-24s not in baseline\n", key.c_str());
+            continue;
+        }
+        double speed = atof(field(vLine[i], "mb_per_s").c_str());
+        double baseSpeed = atof(field(found->second, "mb_per_s").c_str());
+        // compare memory of parsing, without the memory of the executable
+        double rss = atof(field(vLine[i], "peak_rss_kb").c_str())-atof(field(vLine[i], "base_rss_kb").c_str());
+        double baseRss = atof(field(found->second, "peak_rss_kb").c_str())-atof(field(found->second, "base_rss_kb").c_str());
+        bool slower = speed < baseSpeed*(1-tolerance);
+        bool larger = rss > baseRss*(1+tolerance) && rss-baseRss > 1024;
+        printf("%-24s %12.1f %12.1f %12.0f %12.0f%s%s\n", key.c_str(), speed, baseSpeed, rss, baseRss,
+                (slower)? " SLOWER" : "", (larger)? " LARGER" : "");
+        numRegressions += slower || larger;
+    }
+    return numRegressions;
+}
+
+/// @brief main function
+/// @param argc number of arguments
+/// @param argv values of arguments, run with -help for options
+/// @return 0 if all backends succeed without regressions
+int main(int argc, char** argv)
+{
+    using namespace limbo::programoptions;
+
+    bool help = false;
+    std::string dir;
+    unsigned scale = 0;
+    int numRuns = 0;
+    int numThreads = 0;
+    std::string output;
+    std::string baseline;
+    double tolerance = 0;
+    bool skipGenerate = false;
+
+    ProgramOptions po ("Parser benchmarks");
+    po.add_option(Value<bool>("-help", &help, "print help message").toggle(true).default_value(false).toggle_value(true).help(true))
+        .add_option(Value<std::string>("-dir", &dir, "directory of generated inputs").default_value("."))
+        .add_option(Value<unsigned>("-scale", &scale, "number of DEF components; LEF and Ebeam have scale/100 macros, GDSII has scale elements").default_value(100000))
+        .add_option(Value<int>("-runs", &numRuns, "number of runs of each backend").default_value(3))
+        .add_option(Value<int>("-threads", &numThreads, "number of threads of the multi-threaded DEF backend").default_value(4))
+        .add_option(Value<std::string>("-output", &output, "result file in JSON lines, default dir/parser_bench.jsonl"))
+        .add_option(Value<std::string>("-baseline", &baseline, "earlier result file to compare with"))
+        .add_option(Value<double>("-tolerance", &tolerance, "relative tolerance of throughput and peak memory against the baseline").default_value(0.1))
+        .add_option(Value<bool>("-skip_generate", &skipGenerate, "reuse inputs in dir").toggle(true).default_value(false).toggle_value(true))
+        ;
+    try
+    {
+        if (!po.parse(argc, argv) || help)
+        {
+            po.print();
+            return help? 0 : 1;
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cout << e.what() << "\n";
+        po.print();
+        return 1;
+    }
+    if (output.empty())
+        output = dir + "/parser_bench.jsonl";
+
+    std::string def = dir + "/bench.def";
+    std::string lef = dir + "/bench.lef";
+    std::string ebeam = dir + "/bench.ebeam";
+    std::string gds = dir + "/bench.gds";
+    std::string ascii = dir + "/bench.ascii";
+    if (!skipGenerate)
+    {
+        double start = ParserBench::now();
+        if (!writeDef(def, scale) || !writeLef(lef, std::max(scale/100, 1U)) || !writeEbeam(ebeam, std::max(scale/100, 1U)) || !writeGds(gds, ascii, scale))
+        {
+            printf("failed to write inputs to %s\n", dir.c_str());
+            return 1;
+        }
+        printf("generated inputs of scale %u in %.3f s\n", scale, ParserBench::now()-start);
+    }
+
+    char threads[16];
+    sprintf(threads, "%d", numThreads);
+    Job jobs[] = {
+        {"def", "bench_def_bison", def, ""},
+        {"def", "bench_def_bison", def, threads},
+        {"def", "bench_def_adapt", def, ""},
+        {"def", "bench_def_spirit", def, ""},
+        {"lef", "bench_lef_bison", lef, ""},
+        {"lef", "bench_lef_adapt", lef, ""},
+        {"lef", "bench_lef_spirit", lef, ""},
+        {"ebeam", "bench_ebeam_bison", ebeam, ""},
+        {"ebeam", "bench_ebeam_spirit", ebeam, ""},
+        {"gds", "bench_gds_stream", gds, "stream"},
+        {"gds", "bench_gds_stream", gds, "mmap"},
+        {"gds", "bench_gds_stream", gds, "gdsdb"},
+        {"gds_ascii", "bench_gds_ascii", ascii, "spirit"},
+        {"gds_ascii", "bench_gds_ascii", ascii, "reader"}
+    };
+
+    // benchmark executables are installed next to this one
+    std::string binDir = argv[0];
+    binDir = (binDir.find('/') == std::string::npos)? "." : binDir.substr(0, binDir.rfind('/'));
+
+    FILE* out = fopen(output.c_str(), "w");
+    if (!out)
+    {
+        printf("failed to open %s for write\n", output.c_str());
+        return 1;
+    }
+    printf("%-24s %12s %14s %12s %12s %12s\n", "backend", "MB/s", "objects/s", "best s", "RSS KB", "allocs");
+    std::vector<std::string> vLine;
+    int numFailures = 0;
+    for (std::size_t i = 0; i < sizeof(jobs)/sizeof(jobs[0]); ++i)
+    {
+        Job const& job = jobs[i];
+        std::string program = binDir + "/" + job.program;
+        if (access(program.c_str(), X_OK) != 0)
+        {
+            printf("%-24s skipped, %s is not built\n", (job.format+"/"+job.program).c_str(), job.program.c_str());
+            continue;
+        }
+        if (access(job.filename.c_str(), R_OK) != 0)
+        {
+            printf("%-24s skipped, %s does not exist\n", (job.format+"/"+job.program).c_str(), job.filename.c_str());
+            continue;
+        }
+        char cmd[4096];
+        snprintf(cmd, sizeof(cmd), "'%s' '%s' %d %s", program.c_str(), job.filename.c_str(), numRuns, job.variant.c_str());
+        FILE* pipe = popen(cmd, "r");
+        if (!pipe)
+        {
+            ++numFailures;
+            continue;
+        }
+        // parsers print messages, only the result line is kept
+        std::string result;
+        char buf[4096];
+        while (fgets(buf, sizeof(buf), pipe))
+            if (strncmp(buf, "{\"format\":", 10) == 0)
+                result = buf;
+        int status = pclose(pipe);
+        if (result.empty())
+        {
+            printf("%-24s failed with status %d\n", (job.format+"/"+job.program).c_str(), status);
+            ++numFailures;
+            continue;
+        }
+        if (field(result, "ok") != "true")
+            ++numFailures;
+        fputs(result.c_str(), out);
+        vLine.push_back(result);
+        printf("%-24s %12s %14s %12s %12s %12s%s\n", (field(result, "format")+"/"+field(result, "backend")).c_str(),
+                field(result, "mb_per_s").c_str(), field(result, "objects_per_s").c_str(), field(result, "best_s").c_str(),
+                field(result, "peak_rss_kb").c_str(), field(result, "allocs").c_str(),
+                (field(result, "ok") == "true")? "" : " FAILED");
+    }
+    fclose(out);
+    printf("results written to %s\n", output.c_str());
+
+    int numRegressions = baseline.empty()? 0 : compare(vLine, baseline, tolerance);
+    if (numRegressions)
+        printf("%d regressions against %s\n", numRegressions, baseline.c_str());
+
+    return (numFailures || numRegressions)? 1 : 0;
+}
@@ -7,8 +7,10 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 
 #include <limbo/parsers/bookshelf/bison/BookshelfDriver.h>
+#include <limbo/parsers/bookshelf/bison/BookshelfWriter.h>
 
 using std::cout;
 using std::cin;
@@ -137,6 +139,52 @@ class BookshelfDataBase : public BookshelfParser::BookshelfDataBase
         }
 };
 
+/// @brief Custom class that inheritates @ref BookshelfParser::BookshelfIndexDataBase, 
+/// which receives node indices instead of names in .nets and .pl. 
+class BookshelfIndexDataBase : public BookshelfParser::BookshelfIndexDataBase
+{
+	public:
+        /// constructor 
+		BookshelfIndexDataBase() : numNodes(0), numIndexPins(0), numNamePins(0), numPositions(0) {}
+        virtual void resize_bookshelf_node_terminals(int, int) {}
+        virtual void resize_bookshelf_net(int) {}
+        virtual void resize_bookshelf_pin(int) {}
+        virtual void resize_bookshelf_row(int) {}
+        virtual void add_bookshelf_terminal(string&, int, int) {++numNodes;}
+        virtual void add_bookshelf_node(string&, int, int, bool) {++numNodes;}
+        virtual void add_bookshelf_row(BookshelfParser::Row const&) {}
+        virtual void set_bookshelf_net_weight(string const&, double) {}
+        virtual void set_bookshelf_design(string&) {}
+        virtual void bookshelf_end() 
+        {
+            cout << __func__ << " => " << numNodes << " nodes, " 
+                << numIndexPins << " pins by index, " << numNamePins << " pins by name, " 
+                << numPositions << " positions by index" << endl;
+        }
+        /// @param n net 
+        virtual void add_bookshelf_net(BookshelfParser::Net const& n) 
+        {
+            for (unsigned int i = 0; i < n.vNetPin.size(); ++i)
+            {
+                if (n.vNetPin[i].node_id >= 0)
+                    ++numIndexPins; 
+                else 
+                    ++numNamePins; 
+            }
+        }
+        /// @param id node index 
+        virtual void set_bookshelf_node_position(int id, double, double, string const&, string const&, bool) 
+        {
+            if (id < numNodes)
+                ++numPositions; 
+        }
+
+        int numNodes; ///< number of nodes and terminals 
+        int numIndexPins; ///< number of pins referring to nodes by indices 
+        int numNamePins; ///< number of pins referring to nodes by names 
+        int numPositions; ///< number of positions of valid nodes 
+};
+
 /// @brief test 1: use function wrapper @ref BookshelfParser::read  
 void test1(string const& filename)
 {
@@ -157,6 +205,85 @@ void test2(string const& filename)
 	driver.parse_file(filename);
 }
 
+/// @brief test 3: parse files listed in .aux with multiple threads, see @ref BookshelfParser::read 
+/// @param filename .aux file 
+/// @param numThreads number of threads 
+void test3(string const& filename, int numThreads)
+{
+	cout << "////////////// test3 ////////////////" << endl;
+	BookshelfDataBase db;
+	BookshelfParser::read(db, filename, numThreads);
+}
+
+/// @brief test 4: resolve node names to indices in the parser, see @ref BookshelfParser::BookshelfIndexDataBase 
+/// @param filename .aux file 
+/// @param numThreads number of threads 
+void test4(string const& filename, int numThreads)
+{
+	cout << "////////////// test4 ////////////////" << endl;
+	BookshelfIndexDataBase db;
+	BookshelfParser::read(db, filename, numThreads);
+}
+
+/// @brief test 5: read through a binary cache, see @ref BookshelfParser::readCached 
+/// @param filename .aux file 
+/// @param cacheFile cache file, written in the first run and loaded in the second run 
+void test5(string const& filename, string const& cacheFile)
+{
+	cout << "////////////// test5 ////////////////" << endl;
+	for (int i = 0; i < 2; ++i)
+	{
+		BookshelfDataBase db;
+		BookshelfParser::readCached(db, filename, cacheFile);
+	}
+	BookshelfIndexDataBase db;
+	BookshelfParser::readCached(db, filename, cacheFile);
+}
+
+/// @brief synthetic node positions in a grid for @ref BookshelfParser::BookshelfWriter 
+class PlSource : public BookshelfParser::BookshelfPlSource
+{
+	public:
+        /// @param i node index 
+        /// @param node node position 
+		virtual void get(std::size_t i, BookshelfParser::PlNode& node) const 
+		{
+			std::ostringstream oss; 
+			oss << "o" << i; 
+			node.node_name = oss.str(); 
+			node.origin[0] = (i%100)*2.5; 
+			node.origin[1] = (i/100)*12; 
+			node.orient = (i%2)? "FS" : "N"; 
+			if (i%10 == 0)
+				node.status = "FIXED"; 
+		}
+};
+
+/// @brief test 6: write a .pl file with @ref BookshelfParser::writePl and reload it with @ref BookshelfParser::readPlFast 
+/// @param plFile output .pl file 
+void test6(string const& plFile)
+{
+	cout << "////////////// test6 ////////////////" << endl;
+	std::size_t n = 1000; 
+	if (!BookshelfParser::writePl(plFile, n, PlSource()))
+	{
+		cout << "failed to write " << plFile << endl; 
+		return; 
+	}
+	std::vector<string> vNodeName (n); 
+	PlSource source; 
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		BookshelfParser::PlNode node; 
+		source.get(i, node); 
+		vNodeName[i] = node.node_name; 
+	}
+	BookshelfIndexDataBase db;
+	db.numNodes = n; 
+	BookshelfParser::readPlFast(db, plFile, &vNodeName);
+	db.bookshelf_end(); 
+}
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments 
@@ -168,6 +295,13 @@ int main(int argc, char** argv)
 	{
 		test1(argv[1]);
 		test2(argv[1]);
+		test3(argv[1], (argc > 2)? atoi(argv[2]) : 4);
+		test4(argv[1], 1);
+		test4(argv[1], (argc > 2)? atoi(argv[2]) : 4);
+		if (argc > 3)
+			test5(argv[1], argv[3]);
+		if (argc > 4)
+			test6(argv[4]);
 	}
 	else 
 		cout << "at least 1 argument is required" << endl;
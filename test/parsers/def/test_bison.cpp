@@ -7,8 +7,11 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
+#include <sstream>
 
 #include <limbo/parsers/def/bison/DefDriver.h>
+#include <limbo/parsers/def/bison/DefWriter.h>
 
 using std::cout;
 using std::cin;
@@ -116,6 +119,44 @@ class DefDataBase : public DefParser::DefDataBase
         }
 };
 
+/// @brief Custom class that inheritates @ref DefParser::DefRefDataBase, 
+/// which receives components, pins and nets with names referring to characters in the parser. 
+class DefRefDataBase : public DefParser::DefRefDataBase
+{
+	public:
+		virtual void set_def_dividerchar(string const&) {}
+		virtual void set_def_busbitchars(string const&) {}
+		virtual void set_def_version(string const&) {}
+		virtual void set_def_design(string const&) {}
+		virtual void set_def_unit(int) {}
+		virtual void set_def_diearea(int, int, int, int) {}
+		virtual void add_def_row(DefParser::Row const&) {}
+		virtual void resize_def_component(int) {}
+		virtual void resize_def_pin(int) {}
+		virtual void resize_def_net(int) {}
+        virtual void resize_def_blockage(int) {}
+        virtual void add_def_placement_blockage(int, int, int, int) {}
+        virtual void add_def_routing_blockage(int, int, int, int) {}
+        /// @brief add component, names are only valid in this function 
+        /// @param c component 
+		virtual void add_def_component_ref(DefParser::ComponentRef const& c) 
+		{
+			cout << __func__ << ": " << c.comp_name << " " << c.macro_name << endl;
+		}
+        /// @brief add pin 
+        /// @param p pin 
+		virtual void add_def_pin_ref(DefParser::PinRef const& p) 
+		{
+			cout << __func__ << ": " << p.pin_name << " " << p.net_name << endl;
+		}
+        /// @brief add net 
+        /// @param n net 
+		virtual void add_def_net_ref(DefParser::NetRef const& n) 
+		{
+			cout << __func__ << ": " << n.net_name << " with " << n.vNetPin.size() << " pins" << endl;
+		}
+};
+
 /// @brief test 1: use function wrapper @ref DefParser::read  
 void test1(string const& filename)
 {
@@ -136,20 +177,213 @@ void test2(string const& filename)
 	driver.parse_file(filename);
 }
 
+/// @brief test 3: read names without creating std::string through @ref DefParser::DefRefDataBase 
+void test3(string const& filename)
+{
+	cout << "////////////// test3 ////////////////" << endl;
+	DefRefDataBase db;
+	DefParser::read(db, filename);
+}
+
+/// @brief test 4: parse COMPONENTS and NETS with multiple threads 
+/// @param filename DEF file 
+/// @param numThreads number of threads 
+void test4(string const& filename, int numThreads)
+{
+	cout << "////////////// test4 ////////////////" << endl;
+	DefDataBase db;
+	DefParser::read(db, filename, numThreads);
+}
+
+/// @return name of a synthetic item 
+/// @param prefix prefix of the name 
+/// @param i index of the item 
+string grid_name(char prefix, std::size_t i)
+{
+	std::ostringstream oss; 
+	oss << prefix << i; 
+	return oss.str(); 
+}
+
+/// @brief synthetic components placed in a grid for @ref DefParser::DefWriter 
+class GridComponentSource : public DefParser::DefComponentSource
+{
+	public:
+		virtual void get(std::size_t i, DefParser::Component& c) const 
+		{
+			c.comp_name = grid_name('c', i); 
+			c.macro_name = "INV_X1"; 
+			c.status = "PLACED"; 
+			c.origin[0] = (i % 100) * 380; 
+			c.origin[1] = (i / 100) * 2800; 
+			c.orient = (i % 2)? "FS" : "N"; 
+		}
+};
+/// @brief synthetic pins for @ref DefParser::DefWriter 
+class GridPinSource : public DefParser::DefPinSource
+{
+	public:
+		virtual void get(std::size_t i, DefParser::Pin& p) const 
+		{
+			p.pin_name = grid_name('p', i); 
+			p.net_name = grid_name('n', i); 
+			p.direct = "INPUT"; 
+			p.status = "PLACED"; 
+			p.origin[0] = 0; 
+			p.origin[1] = i * 100; 
+			p.orient = "N"; 
+		}
+};
+/// @brief synthetic nets connecting neighboring components for @ref DefParser::DefWriter 
+class GridNetSource : public DefParser::DefNetSource
+{
+	public:
+		virtual void get(std::size_t i, DefParser::Net& n) const 
+		{
+			n.net_name = grid_name('n', i); 
+			n.vNetPin.push_back(std::make_pair(grid_name('c', i), string("ZN"))); 
+			n.vNetPin.push_back(std::make_pair(grid_name('c', i+1), string("A"))); 
+		}
+};
+
+/// @brief test 5: write a placement with @ref DefParser::DefWriter and read it back 
+/// @param filename output DEF file, compressed if the suffix is .gz 
+/// @param numThreads number of threads 
+void test5(string const& filename, int numThreads)
+{
+	cout << "////////////// test5 ////////////////" << endl;
+	int dieArea[4] = {0, 0, 38000, 280000};
+	std::vector<DefParser::Row> vRow (1);
+	vRow[0].row_name = "row0"; 
+	vRow[0].macro_name = "core"; 
+	vRow[0].origin[0] = vRow[0].origin[1] = 0; 
+	vRow[0].orient = "N"; 
+	vRow[0].repeat[0] = 100; vRow[0].repeat[1] = 1; 
+	vRow[0].step[0] = 380; vRow[0].step[1] = 0; 
+	if (!DefParser::write(filename, "grid", 2000, dieArea, vRow, 
+				1000, GridComponentSource(), 
+				10, GridPinSource(), 
+				999, GridNetSource(), numThreads))
+		cout << "failed to write " << filename << endl;
+	else if (filename.size() < 3 || filename.compare(filename.size()-3, 3, ".gz") != 0) // the parser reads plain text only 
+	{
+		DefRefDataBase db;
+		DefParser::read(db, filename);
+	}
+}
+
+/// @brief components moved to the right of the die area for @ref DefParser::patch_placements 
+class ShiftComponentSource : public DefParser::DefComponentSource
+{
+	public:
+		virtual void get(std::size_t i, DefParser::Component& c) const 
+		{
+			c.status = "PLACED"; 
+			c.origin[0] = 100000 + i * 380; 
+			c.origin[1] = 0; 
+			c.orient = "N"; 
+		}
+};
+
+/// @brief test 6: record byte ranges of placements and rewrite only them with @ref DefParser::patch_placements 
+/// @param filename input DEF file 
+/// @param outFilename output DEF file 
+void test6(string const& filename, string const& outFilename)
+{
+	cout << "////////////// test6 ////////////////" << endl;
+	DefRefDataBase db;
+	std::vector<DefParser::DefPlacementRange> vPlacement; 
+	if (DefParser::read(db, filename, vPlacement) 
+			&& DefParser::patch_placements(filename, outFilename, vPlacement, ShiftComponentSource()))
+	{
+		cout << "patched " << vPlacement.size() << " components" << endl;
+		DefRefDataBase db2;
+		DefParser::read(db2, outFilename);
+	}
+	else 
+		cout << "failed to patch " << filename << endl;
+}
+
+/// @brief Custom class counting components, pins and nets 
+class DefCountDataBase : public DefRefDataBase
+{
+	public:
+        /// @brief constructor 
+		DefCountDataBase() : numComponents(0), numPins(0), numNets(0) {}
+        /// @brief count component 
+		virtual void add_def_component_ref(DefParser::ComponentRef const&) {++numComponents;}
+        /// @brief count pin 
+		virtual void add_def_pin_ref(DefParser::PinRef const&) {++numPins;}
+        /// @brief count net 
+		virtual void add_def_net_ref(DefParser::NetRef const&) {++numNets;}
+
+		long long numComponents; ///< number of components 
+		long long numPins; ///< number of pins 
+		long long numNets; ///< number of nets 
+};
+
+/// @brief test 7: counters of @ref limbo::ParserProfile reported to @ref Instrument.h at the end of a parse, 
+/// only with LIMBO_INSTRUMENT 
+/// @param filename DEF file 
+/// @return true if counters match the records read 
+bool test7(string const& filename)
+{
+	cout << "////////////// test7 ////////////////" << endl;
+#ifdef LIMBO_INSTRUMENT
+	limbo::Instrument& inst = limbo::Instrument::instance();
+	const char* names[] = {"DefParser::tokens", "DefParser::bytes", "DefParser::callbacks", 
+		"DefParser::records/COMPONENTS", "DefParser::records/PINS", "DefParser::records/NETS"};
+	long long before[6];
+	for (int i = 0; i < 6; ++i)
+		before[i] = inst.counter(names[i])->value();
+
+	// read through a stream, so all bytes pass the scanner input 
+	DefCountDataBase db;
+	std::ifstream in (filename.c_str());
+	in.seekg(0, std::ios::end);
+	long long size = in.tellg();
+	in.seekg(0, std::ios::beg);
+	DefParser::Driver driver (db);
+	bool ok = driver.parse_stream(in, filename);
+
+	long long delta[6];
+	for (int i = 0; i < 6; ++i)
+	{
+		delta[i] = inst.counter(names[i])->value()-before[i];
+		cout << names[i] << " = " << delta[i] << endl;
+	}
+	// a parse stopped by a syntax error does not read the whole file 
+	return delta[0] > 0 && (!ok || delta[1] == size) 
+		&& delta[2] >= db.numComponents+db.numPins+db.numNets 
+		&& delta[3] == db.numComponents && delta[4] == db.numPins && delta[5] == db.numNets;
+#else
+	cout << "compiled without LIMBO_INSTRUMENT" << endl;
+	return true;
+#endif
+}
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments 
-/// @return 0 
+/// @return 0 if succeed 
 int main(int argc, char** argv)
 {
+	bool ok = true;
 
 	if (argc > 1)
 	{
 		test1(argv[1]);
 		test2(argv[1]);
+		test3(argv[1]);
+		test4(argv[1], (argc > 2)? atoi(argv[2]) : 4);
+		if (argc > 3)
+			test5(argv[3], (argc > 2)? atoi(argv[2]) : 4);
+		if (argc > 4)
+			test6(argv[1], argv[4]);
+		ok = test7(argv[1]);
 	}
 	else 
 		cout << "at least 1 argument is required" << endl;
 
-	return 0;
+	return ok? 0 : 1;
 }
@@ -9,6 +9,7 @@
 #include <fstream>
 
 #include <limbo/parsers/ebeam/bison/EbeamDriver.h>
+#include <limbo/parsers/ebeam/bison/EbeamTable.h>
 
 using std::cout;
 using std::cin;
@@ -63,6 +64,28 @@ void test2(string const& filename)
 	driver.parse_file(filename);
 }
 
+/// @brief test 3: read into flat arrays with @ref EbeamParser::EbeamConflictTable 
+void test3(string const& filename)
+{
+	cout << "////////////// test3 ////////////////" << endl;
+	EbeamParser::EbeamConflictTable table;
+	if (!EbeamParser::read(table, filename))
+		return;
+	cout << "macros = " << table.num_macros() << ", layers = " << table.num_layers() 
+		<< ", regions = " << table.num_regions() << ", site ranges = " << table.vRange.size() << endl;
+	for (unsigned r = 0; r < table.num_regions(); ++r)
+	{
+		cout << table.vMacroName[table.vRegionMacro[r]] << " " << table.vRegionNameTable[table.vRegionName[r]] 
+			<< " layer " << table.vLayerFileId[table.vRegionLayer[r]] << table.vLayerName[table.vRegionLayer[r]] << ":";
+		for (unsigned i = table.vRegionRangeBegin[r]; i < table.vRegionRangeBegin[r+1]; ++i)
+			cout << " [" << table.vRange[i].lo << ", " << table.vRange[i].hi << "]";
+		cout << endl;
+	}
+	if (table.num_macros() > 0 && table.num_layers() > 0)
+		cout << table.vMacroName[0] << " conflicts at site 1 of layer " << table.vLayerFileId[0] << table.vLayerName[0] << ": " 
+			<< table.conflict(0, 0, 1) << endl;
+}
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments 
@@ -74,6 +97,7 @@ int main(int argc, char** argv)
 	{
 		test1(argv[1]);
 		test2(argv[1]);
+		test3(argv[1]);
 	}
 	else 
 		cout << "at least 1 argument is required" << endl;
@@ -34,6 +34,61 @@ class GdfDataBase : public GdfParser::GdfDataBase
         }
 };
 
+/// @brief Custom class that inheritates @ref GdfParser::GdfStreamDataBase 
+/// to receive the contents of a cell one by one. 
+class GdfStreamDataBase : public GdfParser::GdfStreamDataBase
+{
+	public:
+        /// @brief constructor 
+		GdfStreamDataBase()
+		{
+			cout << "GdfStreamDataBase::" << __func__ << endl;
+		}
+		//////////////////// required callbacks from abstract GdfParser::GdfStreamDataBase ///////////////////
+        /// @brief begin cell 
+        /// @param name cell name 
+        virtual void begin_gdf_cell(std::string const& name)
+        {
+            cout << "begin cell " << name << endl;
+        }
+        /// @brief add cell port 
+        /// @param port cell port 
+        virtual void add_gdf_port(GdfParser::CellPort& port)
+        {
+            cout << port;
+        }
+        /// @brief add cell instance 
+        /// @param inst cell instance 
+        virtual void add_gdf_instance(GdfParser::CellInstance& inst)
+        {
+            cout << inst;
+        }
+        /// @brief add text 
+        /// @param text text 
+        virtual void add_gdf_text(GdfParser::Text& text)
+        {
+            cout << text;
+        }
+        /// @brief add routing path 
+        /// @param path routing path 
+        virtual void add_gdf_path(GdfParser::Path& path)
+        {
+            cout << path;
+        }
+        /// @brief add net 
+        /// @param net net 
+        virtual void add_gdf_net(GdfParser::Net& net)
+        {
+            cout << net;
+        }
+        /// @brief end cell 
+        /// @param name cell name 
+        virtual void end_gdf_cell(std::string const& name)
+        {
+            cout << "end cell " << name << endl;
+        }
+};
+
 /// @brief test 1: use function wrapper @ref GdfParser::read  
 void test1(string const& filename)
 {
@@ -54,6 +109,14 @@ void test2(string const& filename)
 	driver.parse_file(filename);
 }
 
+/// @brief test 3: receive cells in streaming mode with @ref GdfParser::GdfStreamDataBase 
+void test3(string const& filename)
+{
+	cout << "////////////// test3 ////////////////" << endl;
+	GdfStreamDataBase db;
+	GdfParser::read(db, filename);
+}
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments 
@@ -65,6 +128,7 @@ int main(int argc, char** argv)
 	{
 		test1(argv[1]);
 		//test2(argv[1]);
+		test3(argv[1]);
 	}
 	else 
 		cout << "at least 1 argument is required" << endl;
@@ -0,0 +1,444 @@
+/**
+ * @file   gdsii/bench_decomposition.cpp
+ * @brief  benchmark the layout decomposition flow from a GDSII layer to GDSII masks,
+ * i.e., @ref GdsParser::GdsDB::GdsReader, @ref limbo::geometry::polygon2rectangle_batch,
+ * @ref limbo::algorithms::coloring::ConflictGraphBuilder, @ref limbo::algorithms::coloring::ComponentColoring
+ * and @ref GdsParser::GdsDB::GdsStreamWriter, with wall time, throughput and peak memory of each stage
+ * @date   Oct 2026
+ */
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <boost/polygon/polygon.hpp>
+#include <limbo/parsers/gdsii/stream/GdsWriter.h>
+#include <limbo/parsers/gdsii/gdsdb/GdsIO.h>
+#include <limbo/geometry/api/BoostPolygonApi.h>
+#include <limbo/geometry/Polygon2RectangleBatch.h>
+#include <limbo/algorithms/coloring/ConflictGraphBuilder.h>
+#include <limbo/algorithms/coloring/ComponentColoring.h>
+#include <limbo/algorithms/coloring/ColoringCost.h>
+#include <limbo/algorithms/coloring/BitsetColoring.h>
+#include <limbo/algorithms/coloring/BacktrackColoring.h>
+#include <limbo/algorithms/coloring/MISColoring.h>
+#if GUROBI == 1
+#include <limbo/algorithms/coloring/ILPColoring.h>
+#endif
+#if OPENBLAS == 1
+#include <limbo/algorithms/coloring/SDPColoringCsdp.h>
+#endif
+
+/// @nowarn
+typedef boost::polygon::point_data<int> Point;
+typedef boost::polygon::rectangle_data<int> Rect;
+typedef limbo::algorithms::coloring::ConflictGraphBuilder<Rect> builder_type;
+typedef builder_type::graph_type graph_type;
+/// @endnowarn
+
+/// @brief options of the benchmark
+struct Options
+{
+    std::string input; ///< input GDSII file, written first if scale is positive
+    std::string output; ///< output GDSII file with masks, empty to skip writing
+    std::string top; ///< cell to flatten
+    std::string engine; ///< coloring algorithm for large components
+    std::string order; ///< vertex ordering before coloring, none, rcm, degree or hilbert
+    int layer; ///< layer to decompose
+    int maskLayer; ///< layer of the first mask, color c goes to maskLayer+c
+    int distance; ///< coloring distance in database units
+    int scale; ///< number of leaf cells in a row and in a column of the synthetic layout
+    int colors; ///< number of masks
+    int threads; ///< number of threads
+    double stitchWeight; ///< weight of stitches
+
+    /// @brief constructor
+    Options() : top("TOP"), engine("bitset"), order("none"), layer(1), maskLayer(101), distance(60), scale(0), colors(3), threads(1), stitchWeight(0.1) {}
+};
+
+/// @brief memory of the process in KB from /proc/self/status
+/// @param key VmHWM for the peak resident set, VmRSS for the current one
+/// @return memory in KB, or the peak from getrusage if /proc is not available
+long memoryKB(const char* key)
+{
+    std::ifstream in ("/proc/self/status");
+    std::string line;
+    std::size_t len = strlen(key);
+    while (std::getline(in, line))
+    {
+        if (line.compare(0, len, key) == 0 && line.size() > len && line[len] == ':')
+            return atol(line.c_str()+len+1);
+    }
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/// @brief reset the peak resident set to the current one, so each stage reports its own peak;
+/// only supported on Linux, elsewhere peaks accumulate from the start of the process
+void resetPeakMemory()
+{
+    std::ofstream out ("/proc/self/clear_refs");
+    if (out.good())
+        out << "5" << std::endl;
+}
+
+/// @brief a stage of the flow, reported as a line of JSON when it ends
+class Stage
+{
+    public:
+        /// @brief constructor, starting the timer
+        /// @param name name of the stage
+        Stage(const char* name) : m_name(name)
+        {
+            resetPeakMemory();
+            m_start = GdsParser::GdsRecordProfiler::now();
+        }
+        /// @brief stop the timer and print the stage
+        /// @param items number of items processed
+        /// @param unit unit of items
+        /// @return seconds of the stage
+        double end(std::size_t items, const char* unit)
+        {
+            double seconds = GdsParser::GdsRecordProfiler::now()-m_start;
+            long peak = memoryKB("VmHWM");
+            s_peak = std::max(s_peak, peak);
+            printf("{\"stage\":\"%s\",\"seconds\":%.6f,\"items\":%lu,\"unit\":\"%s\",\"throughput\":%.1f,\"peak_rss_kb\":%ld,\"rss_kb\":%ld}\n",
+                    m_name, seconds, (unsigned long)items, unit, (seconds > 0)? items/seconds : 0.0, peak, memoryKB("VmRSS"));
+            fflush(stdout);
+            return seconds;
+        }
+
+        /// @return largest peak memory of all stages in KB
+        static long peak() {return s_peak;}
+
+    protected:
+        static long s_peak; ///< largest peak memory of all stages in KB
+        const char* m_name; ///< name of the stage
+        double m_start; ///< start time
+};
+
+long Stage::s_peak = 0;
+
+/// @brief write a synthetic layout for decomposition.
+/// Four variants of leaf cells hold rectangles and L-shapes on the layer, with gaps around the coloring distance,
+/// so shapes form conflict chains, odd cycles and stitch candidates.
+/// Cell TOP places scale x scale leaf cells with SREF, abutting so shapes of neighboring cells are in conflict too.
+/// @param filename output GDSII file
+/// @param layer layer of shapes
+/// @param distance coloring distance
+/// @param scale number of leaf cells in a row and in a column
+/// @return number of shapes in the flattened layout
+std::size_t writeLayout(std::string const& filename, int layer, int distance, int scale)
+{
+    GdsParser::GdsWriter gw (filename.c_str());
+    gw.create_lib("decomposition", 0.001, 1.0e-9);
+
+    // a grid of 16 x 16 shapes in each leaf cell, at a pitch of about twice the distance
+    int const numShapes = 16;
+    int const pitch = 2*distance;
+    int const width = distance;
+    int const cellSize = numShapes*pitch;
+    std::vector<int> vx (6);
+    std::vector<int> vy (6);
+    int x[1];
+    int y[1];
+    for (int variant = 0; variant < 4; ++variant)
+    {
+        std::ostringstream oss;
+        oss << "LEAF_" << variant;
+        gw.gds_write_bgnstr();
+        gw.gds_write_strname(oss.str().c_str());
+        for (int i = 0; i < numShapes; ++i)
+            for (int j = 0; j < numShapes; ++j)
+            {
+                int xl = i*pitch;
+                int yl = j*pitch;
+                // shapes stretch towards their neighbors by an amount depending on the variant and the position
+                int grow = ((i*7+j*3+variant*5)%4)*distance/4;
+                if ((i+j+variant)%5 == 0) // L-shapes reaching the neighbors above and on the right
+                {
+                    vx[0] = xl;              vy[0] = yl;
+                    vx[1] = xl+width+grow;   vy[1] = yl;
+                    vx[2] = xl+width+grow;   vy[2] = yl+width/2;
+                    vx[3] = xl+width/2;      vy[3] = yl+width/2;
+                    vx[4] = xl+width/2;      vy[4] = yl+width+grow;
+                    vx[5] = xl;              vy[5] = yl+width+grow;
+                    gw.write_boundary(layer, 0, vx, vy, false);
+                }
+                else if ((i+variant)%2) // horizontal wires
+                    gw.write_box(layer, 0, xl, yl, xl+width+grow, yl+width/2);
+                else // vertical wires
+                    gw.write_box(layer, 0, xl, yl, xl+width/2, yl+width+grow);
+            }
+        // shapes on another layer are not decomposed
+        gw.write_box(layer+1, 0, 0, 0, cellSize, cellSize);
+        gw.gds_write_endstr();
+    }
+    gw.gds_write_bgnstr();
+    gw.gds_write_strname("TOP");
+    for (int r = 0; r < scale; ++r)
+        for (int c = 0; c < scale; ++c)
+        {
+            std::ostringstream oss;
+            oss << "LEAF_" << (r*3+c)%4;
+            gw.gds_write_sref();
+            gw.gds_write_sname(oss.str().c_str());
+            x[0] = c*cellSize;
+            y[0] = r*cellSize;
+            gw.gds_write_xy(x, y, 1);
+            gw.gds_write_endel();
+        }
+    gw.gds_write_endstr();
+    gw.gds_write_endlib();
+    return (std::size_t)scale*scale*(numShapes*numShapes+1);
+}
+
+/// @brief color the conflict graph with ComponentColoring, with LargeColoringType for large components
+/// @tparam LargeColoringType solver for large components
+/// @param g conflict graph
+/// @param opt options
+/// @param vHilbert rectangles in Hilbert order, used if the ordering is hilbert
+/// @param vColor colors of vertices
+/// @param stat statistics of the run
+template <typename LargeColoringType>
+void color(graph_type const& g, Options const& opt, std::vector<uint32_t> const& vHilbert, std::vector<int8_t>& vColor, limbo::algorithms::coloring::ColoringStatistics& stat)
+{
+    typedef limbo::algorithms::coloring::ComponentColoring<graph_type, limbo::algorithms::coloring::BitsetColoring<graph_type>, LargeColoringType> coloring_type;
+    coloring_type cc (g);
+    cc.color_num((int8_t)opt.colors);
+    cc.stitch_weight(opt.stitchWeight);
+    cc.threads(opt.threads);
+    cc.collect_statistics(true);
+    if (opt.order == "rcm")
+        cc.vertex_order(coloring_type::VERTEX_ORDER_RCM);
+    else if (opt.order == "degree")
+        cc.vertex_order(coloring_type::VERTEX_ORDER_DEGREE);
+    else if (opt.order == "hilbert")
+        cc.vertex_order(vHilbert);
+    cc();
+    stat = cc.statistics();
+    vColor.resize(num_vertices(g));
+    for (uint32_t v = 0; v < vColor.size(); ++v)
+        vColor[v] = cc.color(v);
+}
+
+/// @brief main function
+/// @param argc number of arguments
+/// @param argv values of arguments
+/// @return 0 if succeed
+int main(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = (i+1 < argc);
+        if (arg == "-input" && hasValue) opt.input = argv[++i];
+        else if (arg == "-output" && hasValue) opt.output = argv[++i];
+        else if (arg == "-top" && hasValue) opt.top = argv[++i];
+        else if (arg == "-engine" && hasValue) opt.engine = argv[++i];
+        else if (arg == "-order" && hasValue) opt.order = argv[++i];
+        else if (arg == "-layer" && hasValue) opt.layer = atoi(argv[++i]);
+        else if (arg == "-mask_layer" && hasValue) opt.maskLayer = atoi(argv[++i]);
+        else if (arg == "-distance" && hasValue) opt.distance = atoi(argv[++i]);
+        else if (arg == "-scale" && hasValue) opt.scale = atoi(argv[++i]);
+        else if (arg == "-colors" && hasValue) opt.colors = atoi(argv[++i]);
+        else if (arg == "-threads" && hasValue) opt.threads = std::max(atoi(argv[++i]), 1);
+        else if (arg == "-stitch_weight" && hasValue) opt.stitchWeight = atof(argv[++i]);
+        else
+        {
+            printf("usage: %s -input file.gds [-output masks.gds] [-top TOP] [-layer 1] [-mask_layer 101] [-distance 60]\n", argv[0]);
+            printf("       [-scale n] [-engine bitset|backtrack|mis");
+#if GUROBI == 1
+            printf("|ilp");
+#endif
+#if OPENBLAS == 1
+            printf("|sdp");
+#endif
+            printf("] [-order none|rcm|degree|hilbert]\n");
+            printf("       [-colors 3] [-threads 1] [-stitch_weight 0.1]\n");
+            printf("       with scale n > 0, a synthetic layout of n x n leaf cells is written to file.gds first\n");
+            printf("       each stage prints a line of JSON with seconds, items, throughput and peak memory\n");
+            return 1;
+        }
+    }
+    if (opt.input.empty())
+    {
+        printf("no input file, run without arguments for usage\n");
+        return 1;
+    }
+    if (opt.order != "none" && opt.order != "rcm" && opt.order != "degree" && opt.order != "hilbert")
+    {
+        printf("unknown vertex ordering %s\n", opt.order.c_str());
+        return 1;
+    }
+    printf("{\"config\":{\"input\":\"%s\",\"layer\":%d,\"distance\":%d,\"scale\":%d,\"engine\":\"%s\",\"order\":\"%s\",\"colors\":%d,\"threads\":%d,\"stitch_weight\":%g}}\n",
+            opt.input.c_str(), opt.layer, opt.distance, opt.scale, opt.engine.c_str(), opt.order.c_str(), opt.colors, opt.threads, opt.stitchWeight);
+    double total = 0;
+
+    if (opt.scale > 0)
+    {
+        Stage stage ("synthesize");
+        std::size_t numShapes = writeLayout(opt.input, opt.layer, opt.distance, opt.scale);
+        stage.end(numShapes, "shapes");
+    }
+
+    struct stat st;
+    if (stat(opt.input.c_str(), &st) != 0)
+    {
+        printf("failed to open %s for read\n", opt.input.c_str());
+        return 1;
+    }
+
+    GdsParser::GdsDB::GdsDB db;
+    {
+        Stage stage ("read");
+        GdsParser::GdsDB::GdsReader reader (db);
+        bool success = (opt.threads > 1)? reader.readParallel(opt.input, opt.threads) : reader(opt.input);
+        if (!success)
+        {
+            printf("failed to read %s\n", opt.input.c_str());
+            return 1;
+        }
+        total += stage.end(st.st_size, "bytes");
+    }
+
+    GdsParser::GdsDB::GdsCell flatCell;
+    {
+        Stage stage ("flatten");
+        if (db.getCell(opt.top) == NULL)
+        {
+            printf("cell %s not found\n", opt.top.c_str());
+            return 1;
+        }
+        flatCell = db.extractCell(opt.top, true, opt.threads);
+        total += stage.end(flatCell.objects().size(), "shapes");
+    }
+
+    // polygons of the layer in a CSR buffer, without the closing vertices
+    std::vector<Point> vPoint;
+    std::vector<std::size_t> vOffset (1, 0);
+    std::vector<Rect> vRect;
+    std::vector<std::size_t> vRectOffset;
+    {
+        Stage stage ("polygon2rectangle");
+        for (std::vector<std::pair<GdsParser::GdsRecords::EnumType, GdsParser::GdsDB::GdsObject*> >::const_iterator it = flatCell.objects().begin();
+                it != flatCell.objects().end(); ++it)
+        {
+            if (it->first != GdsParser::GdsRecords::BOUNDARY)
+                continue;
+            GdsParser::GdsDB::GdsPolygon const* polygon = dynamic_cast<GdsParser::GdsDB::GdsPolygon const*>(it->second);
+            if (polygon == NULL || polygon->layer() != opt.layer)
+                continue;
+            std::size_t n = polygon->size();
+            if (n > 1 && *polygon->begin() == *(polygon->begin()+(n-1)))
+                --n;
+            vPoint.insert(vPoint.end(), polygon->begin(), polygon->begin()+n);
+            vOffset.push_back(vPoint.size());
+        }
+        if (!limbo::geometry::polygon2rectangle_batch(vPoint.begin(), vOffset.begin(), vOffset.end(), vRect, vRectOffset,
+                    limbo::geometry::HORIZONTAL_SLICING, opt.threads))
+            printf("some polygons failed to convert to rectangles and are skipped\n");
+        total += stage.end(vOffset.size()-1, "polygons");
+    }
+    // release the layout, later stages only need the rectangles
+    flatCell = GdsParser::GdsDB::GdsCell();
+    db = GdsParser::GdsDB::GdsDB();
+
+    graph_type g;
+    uint32_t numConflicts = 0;
+    uint32_t numStitches = 0;
+    std::vector<uint32_t> vHilbert;
+    {
+        Stage stage ("conflict_graph");
+        builder_type builder (opt.distance);
+        builder.threads(opt.threads);
+        for (std::size_t p = 0; p+1 < vRectOffset.size(); ++p)
+            for (std::size_t i = vRectOffset[p]; i < vRectOffset[p+1]; ++i)
+                builder.add(vRect[i], p);
+        builder(g);
+        numConflicts = builder.num_conflict_edges();
+        numStitches = builder.num_stitch_edges();
+        if (opt.order == "hilbert")
+            builder.hilbert_order(vHilbert);
+        total += stage.end(vRect.size(), "rectangles");
+    }
+
+    std::vector<int8_t> vColor;
+    limbo::algorithms::coloring::ColoringStatistics stat;
+    {
+        Stage stage ("coloring");
+        if (opt.engine == "bitset")
+            color<limbo::algorithms::coloring::BitsetColoring<graph_type> >(g, opt, vHilbert, vColor, stat);
+        else if (opt.engine == "backtrack")
+            color<limbo::algorithms::coloring::BacktrackColoring<graph_type> >(g, opt, vHilbert, vColor, stat);
+        else if (opt.engine == "mis")
+            color<limbo::algorithms::coloring::MISColoring<graph_type> >(g, opt, vHilbert, vColor, stat);
+#if GUROBI == 1
+        else if (opt.engine == "ilp")
+            color<limbo::algorithms::coloring::ILPColoring<graph_type> >(g, opt, vHilbert, vColor, stat);
+#endif
+#if OPENBLAS == 1
+        else if (opt.engine == "sdp")
+            color<limbo::algorithms::coloring::SDPColoringCsdp<graph_type> >(g, opt, vHilbert, vColor, stat);
+#endif
+        else
+        {
+            printf("unknown or unavailable engine %s\n", opt.engine.c_str());
+            return 1;
+        }
+        total += stage.end(num_vertices(g), "vertices");
+    }
+    // simplification and solving inside the coloring stage
+    printf("{\"stage\":\"coloring_detail\",\"simplify_seconds\":%.6f,\"solve_seconds\":%.6f,\"recover_seconds\":%.6f,\"merged_vertices\":%u,\"hidden_vertices\":%u,\"components\":%u}\n",
+            stat.simplify_time, stat.solve_time, stat.recover_time, stat.num_merged_vertices, stat.num_hidden_vertices, stat.num_components);
+
+    limbo::algorithms::coloring::ColoringCost<graph_type> evaluator (g, opt.stitchWeight);
+    evaluator.threads(opt.threads);
+    limbo::algorithms::coloring::ColoringCost<graph_type>::result_type result = evaluator.evaluate(vColor);
+
+    if (!opt.output.empty())
+    {
+        Stage stage ("write");
+        // stream masks in batches of boxes, one batch per mask at a time
+        GdsParser::GdsDB::GdsStreamWriter sw (opt.output);
+        sw.beginLib("masks", 0.001, 1.0e-9);
+        sw.beginStructure("TOP");
+        std::size_t const batchSize = 4096;
+        std::vector<std::vector<int> > vBatch (std::max(opt.colors, 1));
+        for (uint32_t v = 0; v < vRect.size(); ++v)
+        {
+            int mask = std::max((int)vColor[v], 0);
+            std::vector<int>& vBox = vBatch[mask];
+            vBox.push_back(boost::polygon::xl(vRect[v]));
+            vBox.push_back(boost::polygon::yl(vRect[v]));
+            vBox.push_back(boost::polygon::xh(vRect[v]));
+            vBox.push_back(boost::polygon::yh(vRect[v]));
+            if (vBox.size() == batchSize*4)
+            {
+                sw.writeBoxes(opt.maskLayer+mask, 0, &vBox[0], batchSize);
+                vBox.clear();
+            }
+        }
+        for (int mask = 0; mask < (int)vBatch.size(); ++mask)
+        {
+            if (!vBatch[mask].empty())
+                sw.writeBoxes(opt.maskLayer+mask, 0, &vBatch[mask][0], vBatch[mask].size()/4);
+        }
+        sw.endStructure();
+        sw.endLib();
+        total += stage.end(vRect.size(), "rectangles");
+    }
+
+    printf("{\"summary\":{\"seconds\":%.6f,\"polygons\":%lu,\"rectangles\":%lu,\"conflict_edges\":%u,\"stitch_edges\":%u,\"cost\":%g,\"conflicts\":%u,\"stitches\":%u,\"peak_rss_kb\":%ld}}\n",
+            total, (unsigned long)(vOffset.size()-1), (unsigned long)vRect.size(), numConflicts, numStitches,
+            (double)result.cost, (unsigned)result.conflicts, (unsigned)result.stitches, Stage::peak());
+    return 0;
+}
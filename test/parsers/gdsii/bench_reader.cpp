@@ -0,0 +1,338 @@
+/**
+ * @file   gdsii/bench_reader.cpp
+ * @brief  benchmark throughput of @ref GdsParser::GdsReader, @ref GdsParser::GdsDB::GdsReader and @ref GdsParser::GdsDriver
+ * @date   Oct 2026
+ */
+
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <sys/stat.h>
+#include <limbo/parsers/gdsii/stream/GdsReader.h>
+#include <limbo/parsers/gdsii/stream/GdsWriter.h>
+#include <limbo/parsers/gdsii/stream/GdsDriver.h>
+#include <limbo/parsers/gdsii/gdsdb/GdsIO.h>
+
+/// @brief a database only counting callbacks, to measure the cost of the reader itself
+struct CountDataBase : public GdsParser::GdsDataBaseKernel
+{
+    /// @brief constructor
+    CountDataBase() : numCallbacks(0), numIntegers(0) {}
+
+    ///////////////////// required callbacks /////////////////////
+    /// @nowarn
+    virtual void bit_array_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<int> const& v) {++numCallbacks; numIntegers += v.size();}
+    virtual void integer_2_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<int> const& v) {++numCallbacks; numIntegers += v.size();}
+    virtual void integer_4_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<int> const& v) {++numCallbacks; numIntegers += v.size();}
+    virtual void real_4_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<double> const&) {++numCallbacks;}
+    virtual void real_8_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::vector<double> const&) {++numCallbacks;}
+    virtual void string_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, std::string const&) {++numCallbacks;}
+    virtual void begin_end_cbk(GdsParser::GdsRecords::EnumType) {++numCallbacks;}
+    /// @endnowarn
+
+    std::size_t numCallbacks; ///< number of callbacks
+    std::size_t numIntegers; ///< number of integers decoded
+};
+
+/// @brief a database for GdsParser::GdsDriver only counting cells
+struct DriverDataBase : public GdsParser::GdsDriverDataBase
+{
+    /// @brief constructor
+    DriverDataBase() : numCells(0) {}
+    /// @brief add GDSII library
+    /// @param lib GDSII library
+    virtual void add_gds_lib(GdsParser::GdsLib const& lib) {numCells += lib.vCell.size();}
+
+    std::size_t numCells; ///< number of cells
+};
+
+/// @brief write a synthetic layout.
+/// Leaf cells hold boundaries, boxes, paths and texts.
+/// Each cell above level 0 places the cells one level below with SREF and AREF,
+/// and a few shapes of its own; cell TOP places all cells of the highest level.
+/// @param filename output GDSII file
+/// @param levels number of levels below TOP
+/// @param numCells number of cells per level
+/// @param numShapes number of shapes per leaf cell
+/// @param basic only write records supported by GdsParser::GdsDriver, i.e., no PATH, AREF, ANGLE or WIDTH
+void writeLayout(std::string const& filename, int levels, int numCells, int numShapes, bool basic)
+{
+    GdsParser::GdsWriter gw (filename.c_str());
+    gw.create_lib("bench", 0.001, 1.0e-9);
+
+    std::vector<int> vx (8);
+    std::vector<int> vy (8);
+    int x[3];
+    int y[3];
+    for (int level = 0; level < levels; ++level)
+    {
+        for (int c = 0; c < numCells; ++c)
+        {
+            std::ostringstream oss;
+            oss << "CELL_" << level << "_" << c;
+            gw.gds_write_bgnstr();
+            gw.gds_write_strname(oss.str().c_str());
+            // upper levels have fewer shapes of their own
+            int n = (level == 0)? numShapes : std::max(numShapes/10, 1);
+            for (int i = 0; i < n; ++i)
+            {
+                int layer = i%16;
+                int xl = (i%100)*200;
+                int yl = (i/100)*200;
+                switch (i%8)
+                {
+                    case 0:
+                    case 1:
+                    case 2: // rectangles
+                        gw.write_box(layer, 0, xl, yl, xl+100, yl+50);
+                        break;
+                    case 3:
+                    case 4: // L-shapes
+                        vx[0] = xl;     vy[0] = yl;
+                        vx[1] = xl+100; vy[1] = yl;
+                        vx[2] = xl+100; vy[2] = yl+40;
+                        vx[3] = xl+40;  vy[3] = yl+40;
+                        vx[4] = xl+40;  vy[4] = yl+100;
+                        vx[5] = xl;     vy[5] = yl+100;
+                        vx.resize(6); vy.resize(6);
+                        gw.write_boundary(layer, 1, vx, vy, false);
+                        vx.resize(8); vy.resize(8);
+                        break;
+                    case 5:
+                    case 6: // paths
+                        if (basic)
+                        {
+                            gw.write_box(layer, 2, xl, yl, xl+150, yl+20);
+                            break;
+                        }
+                        gw.gds_write_path();
+                        gw.gds_write_layer(layer);
+                        gw.gds_write_datatype(2);
+                        gw.gds_write_pathtype(0);
+                        gw.gds_write_width(20);
+                        x[0] = xl;     y[0] = yl;
+                        x[1] = xl+150; y[1] = yl;
+                        x[2] = xl+150; y[2] = yl+150;
+                        gw.gds_write_xy(x, y, 3);
+                        gw.gds_write_endel();
+                        break;
+                    default: // texts
+                        gw.gds_write_text();
+                        gw.gds_write_layer(layer);
+                        gw.gds_write_texttype(0);
+                        if (!basic)
+                            gw.gds_write_width(10);
+                        x[0] = xl;
+                        y[0] = yl;
+                        gw.gds_write_xy(x, y, 1);
+                        gw.gds_write_string("net");
+                        gw.gds_write_endel();
+                        break;
+                }
+            }
+            if (level > 0)
+            {
+                for (int child = 0; child < numCells; ++child)
+                {
+                    std::ostringstream ossChild;
+                    ossChild << "CELL_" << level-1 << "_" << child;
+                    gw.gds_write_sref();
+                    gw.gds_write_sname(ossChild.str().c_str());
+                    // rotate every other instance
+                    if (!basic)
+                    {
+                        gw.gds_write_strans(child%2, 0, 0);
+                        if (child%2)
+                            gw.gds_write_angle(90);
+                    }
+                    x[0] = child*30000;
+                    y[0] = 0;
+                    gw.gds_write_xy(x, y, 1);
+                    gw.gds_write_endel();
+                }
+                if (basic)
+                {
+                    gw.gds_write_endstr();
+                    continue;
+                }
+                gw.gds_write_aref();
+                gw.gds_write_sname("CELL_0_0");
+                gw.gds_write_colrow(4, 4);
+                x[0] = 0;      y[0] = 50000;
+                x[1] = 120000; y[1] = 50000;
+                x[2] = 0;      y[2] = 170000;
+                gw.gds_write_xy(x, y, 3);
+                gw.gds_write_endel();
+            }
+            gw.gds_write_endstr();
+        }
+    }
+    gw.gds_write_bgnstr();
+    gw.gds_write_strname("TOP");
+    for (int c = 0; c < numCells && levels > 0; ++c)
+    {
+        std::ostringstream oss;
+        oss << "CELL_" << levels-1 << "_" << c;
+        gw.gds_write_sref();
+        gw.gds_write_sname(oss.str().c_str());
+        x[0] = 0;
+        y[0] = c*200000;
+        gw.gds_write_xy(x, y, 1);
+        gw.gds_write_endel();
+    }
+    gw.gds_write_endstr();
+    gw.gds_write_endlib();
+}
+
+/// @brief GdsParser::GdsDriver asserts on records it does not support
+/// @param profiler statistics of the file
+/// @return true if all records in the file are supported
+bool driverSupports(GdsParser::GdsRecordProfiler const& profiler)
+{
+    static const GdsParser::GdsRecords::EnumType supported[] = {
+        GdsParser::GdsRecords::HEADER, GdsParser::GdsRecords::BGNLIB, GdsParser::GdsRecords::LIBNAME, GdsParser::GdsRecords::UNITS,
+        GdsParser::GdsRecords::ENDLIB, GdsParser::GdsRecords::BGNSTR, GdsParser::GdsRecords::STRNAME, GdsParser::GdsRecords::ENDSTR,
+        GdsParser::GdsRecords::BOUNDARY, GdsParser::GdsRecords::BOX, GdsParser::GdsRecords::TEXT, GdsParser::GdsRecords::SREF,
+        GdsParser::GdsRecords::LAYER, GdsParser::GdsRecords::DATATYPE, GdsParser::GdsRecords::TEXTTYPE, GdsParser::GdsRecords::PRESENTATION,
+        GdsParser::GdsRecords::STRANS, GdsParser::GdsRecords::MAG, GdsParser::GdsRecords::SNAME, GdsParser::GdsRecords::XY,
+        GdsParser::GdsRecords::STRING, GdsParser::GdsRecords::ENDEL
+    };
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < sizeof(supported)/sizeof(supported[0]); ++i)
+        count += profiler.count(supported[i]);
+    return count == profiler.total_count();
+}
+
+/// @brief report throughput of the best run
+/// @param name name of the reader
+/// @param vSeconds seconds of all runs
+/// @param bytes file size
+/// @param records number of records in the file
+void report(const char* name, std::vector<double> const& vSeconds, std::size_t bytes, std::size_t records)
+{
+    double best = *std::min_element(vSeconds.begin(), vSeconds.end());
+    double sum = 0;
+    for (std::size_t i = 0; i < vSeconds.size(); ++i)
+        sum += vSeconds[i];
+    printf("%-28s best %9.3f ms avg %9.3f ms %10.1f MB/s %10.2f Mrecords/s\n", name, best*1e3, sum/vSeconds.size()*1e3,
+            (best > 0)? bytes/best/1e6 : 0.0, (best > 0)? records/best/1e6 : 0.0);
+}
+
+/// @brief main function
+/// @param argc number of arguments
+/// @param argv values of arguments: gds file, [number of runs] [number of threads] [levels] [cells per level] [shapes per leaf cell] [basic];
+/// if levels, cells and shapes are given, a synthetic layout is written to the gds file first, 
+/// with only records supported by GdsParser::GdsDriver if basic is 1
+/// @return 0 if succeed
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("usage: %s file.gds [runs] [threads] [levels cells shapes [basic]]\n", argv[0]);
+        printf("       with levels, cells and shapes, a synthetic layout is written to file.gds first\n");
+        printf("       with basic = 1, the layout only has records supported by GdsDriver\n");
+        return 1;
+    }
+    std::string filename = argv[1];
+    int numRuns = (argc > 2)? std::max(atoi(argv[2]), 1) : 3;
+    int numThreads = (argc > 3)? std::max(atoi(argv[3]), 1) : 4;
+    if (argc > 6)
+    {
+        double start = GdsParser::GdsRecordProfiler::now();
+        writeLayout(filename, atoi(argv[4]), atoi(argv[5]), atoi(argv[6]), argc > 7 && atoi(argv[7]));
+        printf("write %s in %.3f ms\n", filename.c_str(), (GdsParser::GdsRecordProfiler::now()-start)*1e3);
+    }
+
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0)
+    {
+        printf("failed to open %s for read\n", filename.c_str());
+        return 1;
+    }
+    std::size_t bytes = st.st_size;
+
+    // one profiled run counts records and shows where reader time goes
+    GdsParser::GdsRecordProfiler profiler;
+    {
+        CountDataBase db;
+        GdsParser::GdsReader reader (db);
+        reader.set_profiler(&profiler);
+        reader.read_mmap(filename.c_str());
+    }
+    std::size_t records = profiler.total_count();
+    printf("%s: %lu bytes, %lu records, %d runs, %d threads\n", filename.c_str(), (unsigned long)bytes, (unsigned long)records, numRuns, numThreads);
+
+    std::vector<double> vSeconds (numRuns);
+    for (int i = 0; i < numRuns; ++i)
+    {
+        CountDataBase db;
+        double start = GdsParser::GdsRecordProfiler::now();
+        GdsParser::GdsReader reader (db);
+        reader(filename.c_str());
+        vSeconds[i] = GdsParser::GdsRecordProfiler::now() - start;
+    }
+    report("GdsReader stream", vSeconds, bytes, records);
+
+    for (int i = 0; i < numRuns; ++i)
+    {
+        CountDataBase db;
+        double start = GdsParser::GdsRecordProfiler::now();
+        GdsParser::GdsReader reader (db);
+        reader.read_mmap(filename.c_str());
+        vSeconds[i] = GdsParser::GdsRecordProfiler::now() - start;
+    }
+    report("GdsReader mmap", vSeconds, bytes, records);
+
+    if (driverSupports(profiler))
+    {
+        for (int i = 0; i < numRuns; ++i)
+        {
+            DriverDataBase db;
+            double start = GdsParser::GdsRecordProfiler::now();
+            GdsParser::read(db, filename);
+            vSeconds[i] = GdsParser::GdsRecordProfiler::now() - start;
+        }
+        report("GdsDriver", vSeconds, bytes, records);
+    }
+    else
+        printf("%-28s skipped, the file has records not supported\n", "GdsDriver");
+
+    for (int i = 0; i < numRuns; ++i)
+    {
+        GdsParser::GdsDB::GdsDB db;
+        double start = GdsParser::GdsRecordProfiler::now();
+        GdsParser::GdsDB::GdsReader reader (db);
+        reader(filename);
+        vSeconds[i] = GdsParser::GdsRecordProfiler::now() - start;
+    }
+    report("GdsDB::GdsReader", vSeconds, bytes, records);
+
+    for (int i = 0; i < numRuns; ++i)
+    {
+        GdsParser::GdsDB::GdsDB db;
+        double start = GdsParser::GdsRecordProfiler::now();
+        GdsParser::GdsDB::GdsReader reader (db);
+        reader.readParallel(filename, numThreads);
+        vSeconds[i] = GdsParser::GdsRecordProfiler::now() - start;
+    }
+    report("GdsDB::GdsReader parallel", vSeconds, bytes, records);
+
+    printf("\nGdsReader per record type\n");
+    profiler.print();
+
+    // the database adds the cost of building objects to each record
+    GdsParser::GdsRecordProfiler dbProfiler;
+    {
+        GdsParser::GdsDB::GdsDB db;
+        GdsParser::GdsDB::GdsReader reader (db);
+        reader.setProfiler(&dbProfiler);
+        reader(filename);
+    }
+    printf("\nGdsDB::GdsReader per record type\n");
+    dbProfiler.print();
+
+    return 0;
+}
@@ -5,17 +5,438 @@
  * @date   Jan 2017
  */
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <limbo/containers/TaskPool.h>
 #include <limbo/parsers/gdsii/gdsdb/GdsIO.h>
+#include <limbo/parsers/gdsii/gdsdb/GdsLazyDB.h>
 #include <limbo/parsers/gdsii/gdsdb/GdsObjectHelpers.h>
 #include <limbo/preprocessor/Msg.h>
 
+/// @nowarn
+typedef GdsParser::GdsDB::GdsCell::point_type point_type; 
+/// @endnowarn
+
+/// @brief add a rectangle as a polygon 
+/// @param cell target cell 
+/// @param layer layer 
+/// @param datatype datatype 
+/// @param xl left 
+/// @param yl bottom 
+/// @param xh right 
+/// @param yh top 
+void addRectangle(GdsParser::GdsDB::GdsCell& cell, int layer, int datatype, int xl, int yl, int xh, int yh)
+{
+    std::vector<point_type> vPoint; 
+    vPoint.push_back(point_type(xl, yl)); 
+    vPoint.push_back(point_type(xh, yl)); 
+    vPoint.push_back(point_type(xh, yh)); 
+    vPoint.push_back(point_type(xl, yh)); 
+    vPoint.push_back(point_type(xl, yl)); 
+    cell.addPolygon(layer, datatype, vPoint); 
+}
+
+/// @brief write a small library to a file: 
+/// LEAF has rectangles on (1, 0) and (1, 5) and a path on (2, 0), 
+/// MID has LEAF at (100, 0) and a rectangle on (3, 0), 
+/// TOP has a 3 x 2 array of LEAF at pitch (50, 40) and MID at (0, 1000) 
+/// @param db database to fill 
+/// @param filename GDSII file 
+void writeLibrary(GdsParser::GdsDB::GdsDB& db, std::string const& filename)
+{
+    double const none = std::numeric_limits<double>::max(); 
+    int const noStrans = std::numeric_limits<int>::max(); 
+    db.setLibname("TEST"); 
+    db.setUnit(0.001); 
+    db.setPrecision(1e-9); 
+    {
+        GdsParser::GdsDB::GdsCell& leaf = db.addCell("LEAF"); 
+        addRectangle(leaf, 1, 0, 0, 0, 10, 10); 
+        addRectangle(leaf, 1, 5, 0, 20, 10, 30); 
+        std::vector<point_type> vPoint; 
+        vPoint.push_back(point_type(0, 0)); 
+        vPoint.push_back(point_type(20, 0)); 
+        leaf.addPath(2, 0, 0, 4, 0, 0, vPoint); 
+    }
+    {
+        GdsParser::GdsDB::GdsCell& mid = db.addCell("MID"); 
+        mid.addCellReference("LEAF", point_type(100, 0), none, none, noStrans); 
+        addRectangle(mid, 3, 0, 0, 0, 5, 5); 
+    }
+    {
+        GdsParser::GdsDB::GdsCell& top = db.addCell("TOP"); 
+        int spacing[2] = {50, 40}; 
+        std::vector<point_type> vPosition; 
+        vPosition.push_back(point_type(0, 0)); 
+        vPosition.push_back(point_type(3*50, 0)); 
+        vPosition.push_back(point_type(0, 2*40)); 
+        top.addCellArray("LEAF", 3, 2, spacing, vPosition, none, none, noStrans); 
+        top.addCellReference("MID", point_type(0, 1000), none, none, noStrans); 
+    }
+    GdsParser::GdsDB::GdsWriter gw (db); 
+    gw(filename); 
+}
+
+/// @brief lower left corners of polygons on a layer, sorted 
+/// @param cell flattened cell 
+/// @param layer layer 
+/// @param datatype datatype 
+/// @return corners 
+std::vector<std::pair<int, int> > polygonCorners(GdsParser::GdsDB::GdsCell const& cell, int layer, int datatype)
+{
+    std::vector<std::pair<int, int> > vCorner; 
+    for (std::vector<GdsParser::GdsDB::GdsCell::object_entry_type>::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+    {
+        if (it->first != ::GdsParser::GdsRecords::BOUNDARY)
+            continue; 
+        GdsParser::GdsDB::GdsPolygon const& polygon = *static_cast<GdsParser::GdsDB::GdsPolygon const*>(it->second); 
+        if (polygon.layer() != layer || polygon.datatype() != datatype)
+            continue; 
+        std::pair<int, int> corner (std::numeric_limits<int>::max(), std::numeric_limits<int>::max()); 
+        for (GdsParser::GdsDB::GdsPolygon::iterator_type itp = polygon.begin(), itpe = polygon.end(); itp != itpe; ++itp)
+        {
+            corner.first = std::min(corner.first, itp->x()); 
+            corner.second = std::min(corner.second, itp->y()); 
+        }
+        vCorner.push_back(corner); 
+    }
+    std::sort(vCorner.begin(), vCorner.end()); 
+    return vCorner; 
+}
+
+/// @brief flatten AREF instances at their positions, with and without memoization and threads 
+/// @param filename GDSII file of @ref writeLibrary 
+void testArrayFlatten(std::string const& filename)
+{
+    GdsParser::GdsDB::GdsDB db; 
+    GdsParser::GdsDB::GdsReader reader (db); 
+    limboAssert(reader(filename)); 
+
+    // 3 x 2 instances of LEAF at pitch (50, 40), and LEAF in MID at (100, 1000) 
+    std::vector<std::pair<int, int> > vExpect; 
+    for (int c = 0; c < 3; ++c)
+        for (int r = 0; r < 2; ++r)
+            vExpect.push_back(std::make_pair(c*50, r*40)); 
+    vExpect.push_back(std::make_pair(100, 1000)); 
+    std::sort(vExpect.begin(), vExpect.end()); 
+    std::vector<std::pair<int, int> > vMid (1, std::make_pair(0, 1000)); 
+    for (int memoize = 0; memoize < 2; ++memoize)
+    {
+        GdsParser::GdsDB::GdsCell flatCell = db.extractCell("TOP", memoize); 
+        limboAssert(flatCell.objects().size() == 7*3+1); 
+        limboAssert(polygonCorners(flatCell, 1, 0) == vExpect); 
+        limboAssert(polygonCorners(flatCell, 1, 5).size() == 7); 
+        limboAssert(polygonCorners(flatCell, 3, 0) == vMid); 
+    }
+
+    // a large array away from the origin is split among threads 
+    {
+        double const none = std::numeric_limits<double>::max(); 
+        int spacing[2] = {0, 0}; 
+        std::vector<point_type> vPosition; 
+        vPosition.push_back(point_type(7, -3)); 
+        vPosition.push_back(point_type(7+40*25, -3)); 
+        vPosition.push_back(point_type(7, -3+30*45)); 
+        db.addCell("BIG").addCellArray("LEAF", 40, 30, spacing, vPosition, none, none, std::numeric_limits<int>::max()); 
+    }
+    vExpect.clear(); 
+    for (int c = 0; c < 40; ++c)
+        for (int r = 0; r < 30; ++r)
+            vExpect.push_back(std::make_pair(7+c*25, -3+r*45)); 
+    std::sort(vExpect.begin(), vExpect.end()); 
+    limbo::containers::set_num_threads(4); 
+    for (int numThreads = 1; numThreads <= 4; numThreads *= 4)
+    {
+        GdsParser::GdsDB::GdsCell flatCell = db.extractCell("BIG", true, numThreads); 
+        limboAssert(flatCell.objects().size() == 40*30*3); 
+        limboAssert(polygonCorners(flatCell, 1, 0) == vExpect); 
+    }
+    limbo::containers::set_num_threads(0); 
+    std::cout << "array flattening passed" << std::endl; 
+}
+
+/// @brief count objects of a type in a cell 
+/// @param cell cell 
+/// @param type record type of objects 
+/// @return number of objects 
+std::size_t countObjects(GdsParser::GdsDB::GdsCell const& cell, ::GdsParser::GdsRecords::EnumType type)
+{
+    std::size_t count = 0; 
+    for (std::vector<GdsParser::GdsDB::GdsCell::object_entry_type>::const_iterator it = cell.objects().begin(), ite = cell.objects().end(); it != ite; ++it)
+        count += (it->first == type); 
+    return count; 
+}
+
+/// @brief read only some layers, serially, in parallel and from a compressed file 
+/// @param db database of @ref writeLibrary 
+/// @param filename GDSII file of @ref writeLibrary 
+void testLayerFilter(GdsParser::GdsDB::GdsDB const& db, std::string const& filename)
+{
+    std::string gzFile = filename + ".gz"; 
+    GdsParser::GdsDB::GdsWriter gw (db); 
+    gw(gzFile); 
+
+    for (int mode = 0; mode < 3; ++mode)
+    {
+        // all datatypes of layer 1 
+        {
+            GdsParser::GdsDB::GdsDB filteredDB; 
+            GdsParser::GdsDB::GdsReader reader (filteredDB); 
+            ::GdsParser::GdsLayerFilter filter; 
+            filter.add(1); 
+            reader.setLayerFilter(filter); 
+            limboAssert((mode == 0)? reader(filename) : (mode == 1)? reader.readParallel(filename, 2) : reader(gzFile)); 
+            limboAssert(filteredDB.cells().size() == 3); 
+            GdsParser::GdsDB::GdsCell const& leaf = *filteredDB.getCell("LEAF"); 
+            limboAssert(leaf.objects().size() == 2 && countObjects(leaf, ::GdsParser::GdsRecords::BOUNDARY) == 2); 
+            // references are not filtered 
+            GdsParser::GdsDB::GdsCell const& mid = *filteredDB.getCell("MID"); 
+            limboAssert(mid.objects().size() == 1 && countObjects(mid, ::GdsParser::GdsRecords::SREF) == 1); 
+            limboAssert(filteredDB.getCell("TOP")->objects().size() == 2); 
+            limboAssert(filteredDB.extractCell("TOP").objects().size() == 7*2); 
+        }
+        // one datatype of layer 1 and all of layer 2 
+        {
+            GdsParser::GdsDB::GdsDB filteredDB; 
+            GdsParser::GdsDB::GdsReader reader (filteredDB); 
+            ::GdsParser::GdsLayerFilter filter; 
+            filter.add(1, 5); 
+            filter.add(2); 
+            reader.setLayerFilter(filter); 
+            limboAssert((mode == 0)? reader(filename) : (mode == 1)? reader.readParallel(filename, 2) : reader(gzFile)); 
+            GdsParser::GdsDB::GdsCell const& leaf = *filteredDB.getCell("LEAF"); 
+            limboAssert(leaf.objects().size() == 2 && countObjects(leaf, ::GdsParser::GdsRecords::PATH) == 1); 
+            limboAssert(polygonCorners(leaf, 1, 5).size() == 1 && polygonCorners(leaf, 1, 0).empty()); 
+            limboAssert(filteredDB.getCell("MID")->objects().size() == 1); 
+        }
+    }
+    std::cout << "layer filter passed" << std::endl; 
+}
+
+/// @brief read the bytes of a GDSII file with the timestamps of BGNLIB and BGNSTR cleared 
+/// @param filename GDSII file 
+/// @return bytes 
+std::string readRecords(std::string const& filename)
+{
+    std::ifstream in (filename.c_str(), std::ios::binary); 
+    std::string bytes ((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()); 
+    for (std::size_t pos = 0; pos+4 <= bytes.size(); )
+    {
+        std::size_t length = ((unsigned char)bytes[pos] << 8) | (unsigned char)bytes[pos+1]; 
+        if (length < 4)
+            break; 
+        if ((bytes[pos+2] == ::GdsParser::GdsRecords::BGNLIB || bytes[pos+2] == ::GdsParser::GdsRecords::BGNSTR) && pos+length <= bytes.size())
+            std::fill(bytes.begin()+pos+4, bytes.begin()+pos+length, 0); 
+        pos += length; 
+    }
+    return bytes; 
+}
+
+/// @brief write cells in parallel and read them back in parallel 
+/// @param filename prefix of GDSII files 
+void testParallelReadWrite(std::string const& filename)
+{
+    // enough cells for several groups of tasks 
+    GdsParser::GdsDB::GdsDB db; 
+    db.setLibname("PARALLEL"); 
+    db.setUnit(0.001); 
+    db.setPrecision(1e-9); 
+    for (int i = 0; i < 500; ++i)
+    {
+        std::ostringstream oss; 
+        oss << "CELL" << i; 
+        GdsParser::GdsDB::GdsCell& cell = db.addCell(oss.str()); 
+        for (int j = 0; j <= i%7; ++j)
+            addRectangle(cell, i%3, j, j*10, i, j*10+5, i+5); 
+        if (i)
+            cell.addCellReference("CELL0", point_type(i, -i), std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max()); 
+    }
+    std::string serialFile = filename + ".serial.gds"; 
+    std::string parallelFile = filename + ".parallel.gds"; 
+    GdsParser::GdsDB::GdsWriter gw (db); 
+    gw(serialFile); 
+    limbo::containers::set_num_threads(4); 
+    gw.writeParallel(parallelFile, 4); 
+    gw.writeParallel(parallelFile + ".gz", 4); 
+    limboAssert(readRecords(parallelFile) == readRecords(serialFile)); 
+
+    for (int gz = 0; gz < 2; ++gz)
+    {
+        GdsParser::GdsDB::GdsDB parallelDB; 
+        GdsParser::GdsDB::GdsReader reader (parallelDB); 
+        limboAssert(reader.readParallel((gz)? parallelFile + ".gz" : parallelFile, 4)); 
+        limboAssert(parallelDB.libname() == db.libname() && parallelDB.cells().size() == db.cells().size()); 
+        for (std::size_t i = 0; i < db.cells().size(); ++i)
+        {
+            GdsParser::GdsDB::GdsCell const& cell = parallelDB.cells()[i]; 
+            limboAssert(cell.name() == db.cells()[i].name() && cell.objects().size() == db.cells()[i].objects().size()); 
+            limboAssert(polygonCorners(cell, i%3, i%7) == polygonCorners(db.cells()[i], i%3, i%7)); 
+        }
+        // references are resolved across cells of different tasks 
+        limboAssert(parallelDB.extractCell("CELL499").objects().size() == 499%7+1 + 1); 
+    }
+    limbo::containers::set_num_threads(0); 
+    std::cout << "parallel read and write passed" << std::endl; 
+}
+
+/// @brief bytes of each structure in a GDSII file 
+/// @param bytes content of GDSII file 
+/// @return map from structure name to bytes from BGNSTR to ENDSTR 
+std::map<std::string, std::string> structureBytes(std::string const& bytes)
+{
+    std::map<std::string, std::string> mStructure; 
+    std::size_t begin = bytes.size(); 
+    std::string name; 
+    for (std::size_t pos = 0; pos+4 <= bytes.size(); )
+    {
+        std::size_t length = ((unsigned char)bytes[pos] << 8) | (unsigned char)bytes[pos+1]; 
+        if (length < 4 || pos+length > bytes.size())
+            break; 
+        if (bytes[pos+2] == ::GdsParser::GdsRecords::BGNSTR)
+            begin = pos; 
+        else if (bytes[pos+2] == ::GdsParser::GdsRecords::STRNAME)
+            name = std::string(bytes.c_str()+pos+4, length-4).c_str(); // strip padding 
+        else if (bytes[pos+2] == ::GdsParser::GdsRecords::ENDSTR && begin < pos)
+            mStructure[name] = bytes.substr(begin, pos+length-begin); 
+        pos += length; 
+    }
+    return mStructure; 
+}
+
+/// @brief copy unmodified structures from the source file when writing 
+/// @param filename GDSII file of @ref writeLibrary 
+void testVerbatimCopy(std::string const& filename)
+{
+    // a source file with all structures dated 2001, so copies are told apart from encoded structures 
+    std::string sourceFile = filename + ".source.gds"; 
+    std::string source; 
+    {
+        std::ifstream in (filename.c_str(), std::ios::binary); 
+        source.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()); 
+        for (std::size_t pos = 0; pos+4 <= source.size(); pos += ((unsigned char)source[pos] << 8) | (unsigned char)source[pos+1])
+        {
+            if (source[pos+2] != ::GdsParser::GdsRecords::BGNSTR)
+                continue; 
+            int const date[6] = {2001, 1, 1, 0, 0, 0}; 
+            for (int i = 0; i < 12; ++i)
+            {
+                source[pos+4+2*i] = (char)(date[i%6] >> 8); 
+                source[pos+5+2*i] = (char)(date[i%6] & 0xff); 
+            }
+        }
+        std::ofstream out (sourceFile.c_str(), std::ios::binary); 
+        out.write(source.data(), source.size()); 
+    }
+    std::map<std::string, std::string> mSource = structureBytes(source); 
+    limboAssert(mSource.size() == 3); 
+
+    GdsParser::GdsDB::GdsDB db; 
+    GdsParser::GdsDB::GdsReader reader (db); 
+    limboAssert(reader(sourceFile)); 
+    limboAssert(db.sourceFile() == sourceFile && db.sourceId() != 0); 
+    for (std::vector<GdsParser::GdsDB::GdsCell>::const_iterator it = db.cells().begin(); it != db.cells().end(); ++it)
+        limboAssert(it->hasSourceRange() && it->sourceId() == db.sourceId()); 
+    // adding an object drops the source range of MID 
+    addRectangle(*db.getCell("MID"), 4, 0, 0, 0, 1, 1); 
+    limboAssert(!db.getCell("MID")->hasSourceRange()); 
+
+    std::string outFile = filename + ".verbatim.gds"; 
+    GdsParser::GdsDB::GdsWriter gw (db); 
+    for (int parallel = 0; parallel < 2; ++parallel)
+    {
+        if (parallel)
+            gw.writeParallel(outFile, 2); 
+        else 
+            gw(outFile); 
+        std::ifstream in (outFile.c_str(), std::ios::binary); 
+        std::map<std::string, std::string> mOut = structureBytes(std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>())); 
+        limboAssert(mOut.size() == 3); 
+        limboAssert(mOut["LEAF"] == mSource["LEAF"] && mOut["TOP"] == mSource["TOP"]); 
+        limboAssert(mOut["MID"] != mSource["MID"] && mOut["MID"].size() > mSource["MID"].size()); 
+    }
+
+    // structures are encoded again once the source file changes 
+    {
+        std::ofstream out (sourceFile.c_str(), std::ios::binary | std::ios::app); 
+        out.write("\0\0\0\0", 4); 
+    }
+    gw(outFile); 
+    std::ifstream in (outFile.c_str(), std::ios::binary); 
+    std::map<std::string, std::string> mOut = structureBytes(std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>())); 
+    limboAssert(mOut.size() == 3 && mOut["LEAF"] != mSource["LEAF"]); 
+    limboAssert(mOut["LEAF"].substr(28) == mSource["LEAF"].substr(28)); // same but the timestamps 
+    std::cout << "verbatim copy passed" << std::endl; 
+}
+
+/// @brief load cells of a @ref GdsParser::GdsDB::GdsLazyDB on demand and release them under a memory budget 
+/// @param filename GDSII file of @ref writeLibrary 
+void testLazyDB(std::string const& filename)
+{
+    GdsParser::GdsDB::GdsDB db; 
+    GdsParser::GdsDB::GdsReader reader (db); 
+    limboAssert(reader(filename)); 
+    std::size_t numObjects = db.extractCell("TOP").objects().size(); 
+
+    GdsParser::GdsDB::GdsLazyDB lazyDB; 
+    limboAssert(lazyDB.open(filename)); 
+    limboAssert(lazyDB.numCells() == 3 && lazyDB.memoryUsage() == 0); 
+    limboAssert(!lazyDB.isLoaded("LEAF") && !lazyDB.isLoaded("MID") && !lazyDB.isLoaded("TOP")); 
+    limboAssert(lazyDB.getCell("MISSING") == NULL); 
+
+    // a cell is decoded on first access 
+    GdsParser::GdsDB::GdsCell const* leaf = lazyDB.getCell("LEAF"); 
+    limboAssert(leaf && leaf->objects().size() == db.getCell("LEAF")->objects().size()); 
+    limboAssert(lazyDB.isLoaded("LEAF") && !lazyDB.isLoaded("MID")); 
+    std::size_t leafUsage = lazyDB.memoryUsage(); 
+    limboAssert(leafUsage > 0); 
+    lazyDB.evict(); 
+    limboAssert(!lazyDB.isLoaded("LEAF") && lazyDB.memoryUsage() == 0); 
+    limboAssert(lazyDB.getCell("MID")->objects().size() == db.getCell("MID")->objects().size()); 
+    std::size_t midUsage = lazyDB.memoryUsage(); 
+    lazyDB.evict(); 
+
+    // with room for one cell, the least recently used cell is released 
+    lazyDB.setMemoryBudget(std::max(leafUsage, midUsage)); 
+    lazyDB.getCell("LEAF"); 
+    lazyDB.getCell("MID"); 
+    limboAssert(!lazyDB.isLoaded("LEAF") && lazyDB.isLoaded("MID")); 
+    limboAssert(lazyDB.memoryUsage() == midUsage); 
+    lazyDB.getCell("LEAF"); 
+    limboAssert(lazyDB.isLoaded("LEAF") && !lazyDB.isLoaded("MID")); 
+
+    // extraction loads the whole hierarchy and only keeps the extracted cell afterwards 
+    limboAssert(lazyDB.extractCell("TOP").objects().size() == numObjects); 
+    limboAssert(lazyDB.isLoaded("TOP") && !lazyDB.isLoaded("LEAF") && !lazyDB.isLoaded("MID")); 
+
+    // no budget keeps everything 
+    lazyDB.setMemoryBudget(0); 
+    limboAssert(lazyDB.extractCell("TOP").objects().size() == numObjects); 
+    limboAssert(lazyDB.isLoaded("TOP") && lazyDB.isLoaded("LEAF") && lazyDB.isLoaded("MID")); 
+    std::cout << "lazy database passed" << std::endl; 
+}
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments, 4 arguments: input gds, output gds, flat output gds, flat cell name  
 /// @return 0 if succeed 
 int main(int argc, char** argv)
 {
+    // tests on a generated library next to the output, or in the working directory 
+    {
+        std::string generatedFile = (argc > 2)? std::string(argv[2]) + ".generated.gds" : std::string("test_gdsdb.generated.gds"); 
+        GdsParser::GdsDB::GdsDB generatedDB; 
+        writeLibrary(generatedDB, generatedFile); 
+        testArrayFlatten(generatedFile); 
+        testLayerFilter(generatedDB, generatedFile); 
+        testLazyDB(generatedFile); 
+        testParallelReadWrite(generatedFile); 
+        testVerbatimCopy(generatedFile); 
+    }
+
     GdsParser::GdsDB::GdsDB db; 
     if (argc > 2 && argc <= 4)
     {
@@ -30,6 +451,38 @@ int main(int argc, char** argv)
         GdsParser::GdsDB::GdsWriter gw (db); 
         gw(argv[2]);
 
+        // stream the same cells to another file structure by structure, and read it back 
+        std::string streamFile = std::string(argv[2]) + ".stream.gds"; 
+        {
+            GdsParser::GdsDB::GdsStreamWriter sw (streamFile, 64*1024); 
+            sw.beginLib(db.libname(), db.unit(), db.precision()); 
+            for (std::vector<GdsParser::GdsDB::GdsCell>::const_iterator it = db.cells().begin(); it != db.cells().end(); ++it)
+                sw.write(*it); 
+            // a generated structure appended in batches of boxes 
+            sw.beginStructure("STREAM_BOXES"); 
+            for (int batch = 0; batch < 4; ++batch)
+            {
+                std::vector<int> vBox; 
+                for (int i = 0; i < 1000; ++i)
+                {
+                    int boxes[4] = {i*20, batch*20, i*20+10, batch*20+10}; 
+                    vBox.insert(vBox.end(), boxes, boxes+4); 
+                }
+                sw.writeBoxes(batch, 0, &vBox[0], vBox.size()/4); 
+            }
+            sw.endStructure(); 
+            sw.endLib(); 
+            limboAssert(sw.numStructures() == db.cells().size()+1); 
+        }
+        GdsParser::GdsDB::GdsDB streamDB; 
+        GdsParser::GdsDB::GdsReader streamReader (streamDB); 
+        limboAssert(streamReader(streamFile)); 
+        limboAssert(streamDB.cells().size() == db.cells().size()+1); 
+        for (std::size_t i = 0; i < db.cells().size(); ++i)
+            limboAssert(streamDB.cells()[i].name() == db.cells()[i].name() && streamDB.cells()[i].objects().size() == db.cells()[i].objects().size()); 
+        limboAssert(streamDB.cells().back().objects().size() == 4000); 
+        std::cout << "streamed " << streamDB.cells().size() << " cells to " << streamFile << std::endl; 
+
         std::cout << "4 arguments to test flatten: input gds, output gds, flat output gds, flat cell name" << std::endl;
     }
 	else if (argc > 4)
@@ -0,0 +1,302 @@
+/**
+ * @file   gdsii/test_oasis.cpp
+ * @brief  test OASIS read and write with @ref GdsParser::GdsDB::GdsDB
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <sys/stat.h>
+#include <limbo/parsers/gdsii/gdsdb/GdsIO.h>
+#include <limbo/parsers/gdsii/gdsdb/GdsObjectHelpers.h>
+#include <limbo/preprocessor/Msg.h>
+
+using GdsParser::GdsDB::GdsDB;
+using GdsParser::GdsDB::GdsCell;
+using GdsParser::GdsDB::GdsObject;
+typedef GdsParser::GdsDB::GdsObject::point_type point_type;
+
+/// @brief an action to describe an object independent of its encoding
+struct DescribeObjectAction
+{
+    std::string& description; ///< description of the object
+
+    /// @brief constructor
+    /// @param d description of the object
+    DescribeObjectAction(std::string& d) : description(d) {}
+
+    /// @brief describe a polygon by its layer and sorted vertices without the closing one
+    void operator()(GdsParser::GdsRecords::EnumType, GdsParser::GdsDB::GdsPolygon* object)
+    {
+        std::vector<std::pair<int, int> > vPoint;
+        for (GdsParser::GdsDB::GdsPolygon::iterator_type it = object->begin(); it != object->end(); ++it)
+            vPoint.push_back(std::make_pair(it->x(), it->y()));
+        if (vPoint.size() > 1 && vPoint.front() == vPoint.back())
+            vPoint.pop_back();
+        std::sort(vPoint.begin(), vPoint.end());
+        std::ostringstream oss;
+        oss << "BOUNDARY " << object->layer() << " " << object->datatype();
+        for (std::size_t i = 0; i < vPoint.size(); ++i)
+            oss << " (" << vPoint[i].first << "," << vPoint[i].second << ")";
+        description = oss.str();
+    }
+    /// @brief describe a path by its layer, width, extensions and vertices
+    void operator()(GdsParser::GdsRecords::EnumType, GdsParser::GdsDB::GdsPath* object)
+    {
+        std::ostringstream oss;
+        int bgnExtn = (object->pathtype() == 2)? object->width()/2 : (object->pathtype() == 4)? object->bgnExtn() : 0;
+        int endExtn = (object->pathtype() == 2)? object->width()/2 : (object->pathtype() == 4)? object->endExtn() : 0;
+        oss << "PATH " << object->layer() << " " << object->datatype() << " " << object->width() << " " << bgnExtn << " " << endExtn;
+        for (GdsParser::GdsDB::GdsPath::const_iterator it = object->begin(); it != object->end(); ++it)
+            oss << " (" << it->x() << "," << it->y() << ")";
+        description = oss.str();
+    }
+    /// @brief describe a text by its layer, position and string
+    void operator()(GdsParser::GdsRecords::EnumType, GdsParser::GdsDB::GdsText* object)
+    {
+        std::ostringstream oss;
+        oss << "TEXT " << object->layer() << " " << object->texttype() << " (" << object->position().x() << "," << object->position().y() << ") " << object->text();
+        description = oss.str();
+    }
+    /// @brief describe a reference by its cell and transformation
+    void operator()(GdsParser::GdsRecords::EnumType, GdsParser::GdsDB::GdsCellReference* object)
+    {
+        std::ostringstream oss;
+        oss << "SREF " << object->refCell() << " (" << object->position().x() << "," << object->position().y() << ") "
+            << ((object->angle() == std::numeric_limits<double>::max())? 0 : object->angle()) << " "
+            << ((object->magnification() == std::numeric_limits<double>::max())? 1 : object->magnification()) << " "
+            << (object->strans() != std::numeric_limits<int>::max() && object->strans()/32768);
+        description = oss.str();
+    }
+    /// @brief describe an array by its cell, sorted instances and transformation, 
+    /// since a row or a column may be encoded either way
+    void operator()(GdsParser::GdsRecords::EnumType, GdsParser::GdsDB::GdsCellArray* object)
+    {
+        std::vector<point_type> const& vPosition = object->positions();
+        std::vector<std::pair<int, int> > vInstance;
+        for (int i = 0; i < object->columns(); ++i)
+            for (int j = 0; j < object->rows(); ++j)
+                vInstance.push_back(std::make_pair(
+                            vPosition[0].x() + i*(vPosition[1].x()-vPosition[0].x())/object->columns() + j*(vPosition[2].x()-vPosition[0].x())/object->rows(),
+                            vPosition[0].y() + i*(vPosition[1].y()-vPosition[0].y())/object->columns() + j*(vPosition[2].y()-vPosition[0].y())/object->rows()));
+        std::sort(vInstance.begin(), vInstance.end());
+        std::ostringstream oss;
+        oss << "AREF " << object->refCell();
+        for (std::size_t i = 0; i < vInstance.size(); ++i)
+            oss << " (" << vInstance[i].first << "," << vInstance[i].second << ")";
+        oss << " " << ((object->angle() == std::numeric_limits<double>::max())? 0 : object->angle())
+            << " " << (object->strans() != std::numeric_limits<int>::max() && object->strans()/32768);
+        description = oss.str();
+    }
+    /// @return a message of action for debug
+    std::string message() const {return "DescribeObjectAction";}
+};
+
+/// @brief describe all objects of a cell in sorted order
+/// @param cell GDSII cell
+/// @return descriptions
+std::vector<std::string> describe(GdsCell const& cell)
+{
+    std::vector<std::string> vDescription;
+    for (std::vector<std::pair<GdsParser::GdsRecords::EnumType, GdsObject*> >::const_iterator it = cell.objects().begin(); it != cell.objects().end(); ++it)
+    {
+        vDescription.push_back(std::string());
+        GdsParser::GdsDB::GdsObjectHelpers()(it->first, it->second, DescribeObjectAction(vDescription.back()));
+    }
+    std::sort(vDescription.begin(), vDescription.end());
+    return vDescription;
+}
+
+/// @brief compare two databases cell by cell
+/// @param db1 first database
+/// @param db2 second database
+/// @return number of differences
+int compare(GdsDB const& db1, GdsDB const& db2)
+{
+    int fails = 0;
+    if (db1.cells().size() != db2.cells().size())
+    {
+        std::cout << "number of cells: " << db1.cells().size() << " vs " << db2.cells().size() << std::endl;
+        return 1;
+    }
+    if (std::fabs(db1.unit() - db2.unit()) > 1e-6*db1.unit() || std::fabs(db1.precision() - db2.precision()) > 1e-6*db1.precision())
+    {
+        std::cout << "units: " << db1.unit() << " " << db1.precision() << " vs " << db2.unit() << " " << db2.precision() << std::endl;
+        ++fails;
+    }
+    for (std::size_t i = 0; i < db1.cells().size(); ++i)
+    {
+        GdsCell const& cell1 = db1.cells()[i];
+        GdsCell const& cell2 = db2.cells()[i];
+        std::vector<std::string> vDescription1 = describe(cell1);
+        std::vector<std::string> vDescription2 = describe(cell2);
+        if (cell1.name() != cell2.name() || vDescription1 != vDescription2)
+        {
+            std::cout << "cell " << cell1.name() << " vs " << cell2.name() << std::endl;
+            for (std::size_t j = 0; j < std::max(vDescription1.size(), vDescription2.size()); ++j)
+            {
+                std::string d1 = (j < vDescription1.size())? vDescription1[j] : "";
+                std::string d2 = (j < vDescription2.size())? vDescription2[j] : "";
+                if (d1 != d2)
+                    std::cout << "  " << d1 << "\n  " << d2 << std::endl;
+            }
+            ++fails;
+        }
+    }
+    return fails;
+}
+
+/// @brief build a library with all kinds of objects
+/// @param db GDSII database
+void build(GdsDB& db)
+{
+    db.setUnit(0.001);
+    db.setPrecision(1e-9);
+    db.setLibname("LIB");
+
+    GdsCell& leaf = db.addCell("leaf");
+    for (int i = 0; i < 100; ++i) // rectangles and squares with the same shapes
+    {
+        std::vector<point_type> vPoint;
+        int w = (i%2)? 40 : 20;
+        vPoint.push_back(point_type(i*100, 0));
+        vPoint.push_back(point_type(i*100+w, 0));
+        vPoint.push_back(point_type(i*100+w, 20));
+        vPoint.push_back(point_type(i*100, 20));
+        vPoint.push_back(point_type(i*100, 0));
+        leaf.addPolygon(1 + i%3, 0, vPoint);
+    }
+    // Manhattan polygon starting with a vertical edge
+    int vL[][2] = {{0, 0}, {0, 300}, {100, 300}, {100, 100}, {250, 100}, {250, 0}, {0, 0}};
+    // a polygon that is not alternating
+    int vU[][2] = {{0, 0}, {50, 0}, {100, 0}, {100, 80}, {0, 80}, {0, 0}};
+    // octangular and arbitrary polygons
+    int vOct[][2] = {{0, 0}, {10, -10}, {30, -10}, {40, 0}, {40, 20}, {30, 30}, {10, 30}, {0, 20}, {0, 0}};
+    int vTri[][2] = {{-7, 3}, {101, -55}, {33, 87}, {-7, 3}};
+    std::vector<point_type> vPoint;
+    for (int i = 0; i < 7; ++i) vPoint.push_back(point_type(vL[i][0], 500+vL[i][1]));
+    leaf.addPolygon(5, 1, vPoint);
+    vPoint.clear();
+    for (int i = 0; i < 6; ++i) vPoint.push_back(point_type(vU[i][0], -500+vU[i][1]));
+    leaf.addPolygon(5, 1, vPoint);
+    vPoint.clear();
+    for (int i = 0; i < 9; ++i) vPoint.push_back(point_type(vOct[i][0]-1000, vOct[i][1]));
+    leaf.addPolygon(6, 2, vPoint);
+    vPoint.clear();
+    for (int i = 0; i < 4; ++i) vPoint.push_back(point_type(vTri[i][0], vTri[i][1]+2000));
+    leaf.addPolygon(7, 0, vPoint);
+
+    // paths with all kinds of ends
+    vPoint.clear();
+    vPoint.push_back(point_type(0, 0));
+    vPoint.push_back(point_type(0, 400));
+    vPoint.push_back(point_type(300, 400));
+    vPoint.push_back(point_type(500, 600));
+    leaf.addPath(10, 0, 0, 20, std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), vPoint);
+    leaf.addPath(10, 0, 2, 20, std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), vPoint);
+    leaf.addPath(11, 3, 4, 30, 5, -3, vPoint);
+    vPoint.pop_back();
+    leaf.addPath(11, 3, 4, 30, 0, 15, vPoint);
+
+    leaf.addText(20, 0, 1, "VDD", point_type(5, 5), std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
+            std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+    leaf.addText(20, 0, 1, "VDD", point_type(500, 5), std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
+            std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+    leaf.addText(21, 0, 0, "GND", point_type(-5, 5), std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
+            std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+
+    // the top cell refers to leaf before and after it
+    GdsCell& top = db.addCell("top");
+    top.addCellReference("leaf", point_type(0, 0), std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+    top.addCellReference("leaf", point_type(10000, 0), 90, std::numeric_limits<double>::max(), 32768);
+    top.addCellReference("leaf", point_type(-10000, 300), 30, 2.5, 0);
+    top.addCellReference("mid", point_type(-10000, -300), 180, std::numeric_limits<double>::max(), 32768);
+    int spacing[2] = {0, 0};
+    std::vector<point_type> vPosition (3);
+    // regular 4x3 array
+    vPosition[0] = point_type(0, 20000);
+    vPosition[1] = point_type(4*15000, 20000);
+    vPosition[2] = point_type(0, 20000+3*12000);
+    top.addCellArray("leaf", 4, 3, spacing, vPosition, std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+    // a row and a column
+    vPosition[1] = point_type(5*15000, 20000);
+    vPosition[2] = point_type(0, 20000);
+    top.addCellArray("mid", 5, 1, spacing, vPosition, 270, std::numeric_limits<double>::max(), 0);
+    vPosition[1] = point_type(0, 20000);
+    vPosition[2] = point_type(0, 20000-6*1000);
+    top.addCellArray("mid", 1, 6, spacing, vPosition, std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+    // skewed lattice
+    vPosition[0] = point_type(0, 0);
+    vPosition[1] = point_type(3*1000, 3*500);
+    vPosition[2] = point_type(2*(-200), 2*700);
+    top.addCellArray("leaf", 3, 2, spacing, vPosition, 45, std::numeric_limits<double>::max(), 32768);
+
+    GdsCell& mid = db.addCell("mid");
+    mid.addCellReference("leaf", point_type(7, -7), std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<int>::max());
+    vPoint.clear();
+    vPoint.push_back(point_type(0, 0));
+    vPoint.push_back(point_type(0, 10));
+    vPoint.push_back(point_type(10, 10));
+    vPoint.push_back(point_type(10, 0));
+    vPoint.push_back(point_type(0, 0));
+    mid.addPolygon(1, 0, vPoint);
+}
+
+/// @param filename file name
+/// @return file size in bytes
+long fileSize(std::string const& filename)
+{
+    struct stat st;
+    return (stat(filename.c_str(), &st) == 0)? (long)st.st_size : -1;
+}
+
+/// @brief write a database to OASIS, read it back and compare
+/// @param db GDSII database
+/// @param filename OASIS file
+/// @param compress write cells in CBLOCK records
+/// @return number of differences
+int roundTrip(GdsDB const& db, std::string const& filename, bool compress)
+{
+    GdsParser::GdsDB::GdsWriter gw (db);
+    gw.writeOasis(filename, compress);
+    GdsDB db2;
+    GdsParser::GdsDB::GdsReader reader (db2);
+    if (!reader(filename))
+    {
+        std::cout << "failed to read " << filename << std::endl;
+        return 1;
+    }
+    int fails = compare(db, db2);
+    std::cout << filename << ": " << fileSize(filename) << " bytes, " << ((fails)? "different" : "same") << std::endl;
+    return fails;
+}
+
+/// @brief main function
+/// @param argc number of arguments
+/// @param argv values of arguments, an optional GDSII or OASIS file to convert to OASIS and back
+/// @return 0 if succeed
+int main(int argc, char** argv)
+{
+    int fails = 0;
+    GdsDB db;
+    if (argc > 1)
+    {
+        GdsParser::GdsDB::GdsReader reader (db);
+        limboAssert(reader(argv[1]));
+        std::cout << argv[1] << ": " << fileSize(argv[1]) << " bytes" << std::endl;
+    }
+    else
+        build(db);
+
+    fails += roundTrip(db, "test_oasis.oas", true);
+    fails += roundTrip(db, "test_oasis_raw.oas", false);
+
+    // GDSII of the same library for comparison of file sizes
+    GdsParser::GdsDB::GdsWriter gw (db);
+    gw("test_oasis.gds");
+    std::cout << "test_oasis.gds: " << fileSize("test_oasis.gds") << " bytes" << std::endl;
+
+    std::cout << ((fails)? "FAILED" : "PASSED") << std::endl;
+    return fails;
+}
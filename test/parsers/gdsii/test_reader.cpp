@@ -218,6 +218,64 @@ struct EnumDataBase : public GdsParser::GdsDataBaseKernel
     }
 };
 
+/// @brief test span callbacks, data are views into the decode buffer of the reader 
+struct SpanDataBase : public GdsParser::GdsDataBaseSpanKernel
+{
+    /// @brief constructor 
+    SpanDataBase() : num_records(0), num_points(0)
+    {
+        cout << "constructing SpanDataBase" << endl;
+    }
+    ///////////////////// required callbacks /////////////////////
+    /// @brief bit array callback 
+    virtual void bit_array_span_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, int const*, std::size_t)
+    {
+        ++num_records; 
+    }
+    /// @brief 2-byte integer callback 
+    virtual void integer_2_span_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, int const*, std::size_t)
+    {
+        ++num_records; 
+    }
+    /// @brief 4-byte integer callback 
+    /// @param record_type record 
+    /// @param size number of integers 
+    virtual void integer_4_span_cbk(GdsParser::GdsRecords::EnumType record_type, GdsParser::GdsData::EnumType, int const*, std::size_t size)
+    {
+        ++num_records; 
+        if (record_type == GdsParser::GdsRecords::XY)
+            num_points += size/2; 
+    }
+    /// @brief 4-byte floating point number callback 
+    virtual void real_4_span_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, double const*, std::size_t) 
+    {
+        ++num_records; 
+    }
+    /// @brief 8-byte floating point number callback 
+    virtual void real_8_span_cbk(GdsParser::GdsRecords::EnumType, GdsParser::GdsData::EnumType, double const*, std::size_t) 
+    {
+        ++num_records; 
+    }
+    /// @brief string callback 
+    /// @param record_type record 
+    /// @param str start of characters 
+    /// @param size number of characters 
+    virtual void string_span_cbk(GdsParser::GdsRecords::EnumType record_type, GdsParser::GdsData::EnumType, char const* str, std::size_t size) 
+    {
+        ++num_records; 
+        if (record_type == GdsParser::GdsRecords::STRNAME)
+            cout << "STRNAME = " << string(str, size) << endl; 
+    }
+    /// @brief begin or end indicator of a block 
+    virtual void begin_end_cbk(GdsParser::GdsRecords::EnumType)
+    {
+        ++num_records; 
+    }
+
+    std::size_t num_records; ///< number of records 
+    std::size_t num_points; ///< number of points in XY records 
+};
+
 /* ===========================================
 example to read .gds.gz 
 #include <boost/iostreams/filter/gzip.hpp>
@@ -244,6 +302,11 @@ int main(int argc, char** argv)
 		cout << "test ascii api\n" << GdsParser::read(adb, argv[1]) << endl;
         EnumDataBase edb;
 		cout << "test enum api\n" << GdsParser::read(edb, argv[1]) << endl;
+        EnumDataBase mdb;
+		cout << "test enum api with memory mapping\n" << GdsParser::read_mmap(mdb, argv[1]) << endl;
+        SpanDataBase sdb; 
+		cout << "test span api\n" << GdsParser::read(sdb, argv[1]) << endl;
+        cout << "records = " << sdb.num_records << ", points = " << sdb.num_points << endl; 
     }
 	else cout << "at least 1 argument is required" << endl;
 
@@ -8,8 +8,10 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <set>
 
 #include <limbo/parsers/lef/bison/LefDriver.h>
+#include <limbo/parsers/lef/bison/LefShapes.h>
 
 using std::cout;
 using std::endl;
@@ -127,6 +129,45 @@ class LefDataBase : public LefParser::LefDataBase
 #endif
 };
 
+/// @brief database collecting rectangles of macros with @ref LefParser::LefShapeExtractor 
+class LefShapeDataBase : public LefDataBase
+{
+	public:
+        /// @brief constructor 
+		LefShapeDataBase() : LefDataBase(), numPinRects(0), numObsRects(0) {}
+        /// @brief set database units 
+		virtual void lef_units_cbk(LefParser::lefiUnits const& v)
+		{
+			if (v.hasDatabase())
+				extractor.set_dbu(v.databaseNumber());
+		}
+        /// @brief assign layer ids in the order of layers 
+		virtual void lef_layer_cbk(LefParser::lefiLayer const& v)
+		{
+			extractor.layer_id(v.name());
+		}
+        /// @brief print rectangles of a macro 
+		virtual void lef_macro_cbk(LefParser::lefiMacro const& v)
+		{
+			LefParser::LefMacroShapes shapes;
+			extractor.extract(v, shapes);
+			cout << shapes.name << ": " << shapes.num_pins() << " pins, " 
+				<< shapes.vPinRect.size() << " pin rectangles, " << shapes.vObsRect.size() << " obstruction rectangles" << endl;
+			for (unsigned i = 0; i < shapes.num_pins(); ++i)
+				for (unsigned j = shapes.vPinBegin[i]; j < shapes.vPinBegin[i+1]; ++j)
+				{
+					LefParser::LefShapeRect const& r = shapes.vPinRect[j];
+					cout << "  " << shapes.vPinName[i] << " " << extractor.layer_names()[r.layer] 
+						<< " (" << r.xl << ", " << r.yl << ", " << r.xh << ", " << r.yh << ")" << endl;
+				}
+			numPinRects += shapes.vPinRect.size();
+			numObsRects += shapes.vObsRect.size();
+		}
+
+		LefParser::LefShapeExtractor extractor; ///< rectangle extractor 
+		std::size_t numPinRects; ///< number of pin rectangles 
+		std::size_t numObsRects; ///< number of obstruction rectangles 
+};
 /// @brief test 1: use function wrapper @ref LefParser::read  
 void test1(std::string const& filename)
 {
@@ -137,6 +178,37 @@ void test1(std::string const& filename)
 	else cout << "read failed" << endl;
 }
 
+/// @brief test 2: parse macros on demand, see @ref LefParser::LefMacroIndex 
+void test2(std::string const& filename)
+{
+	cout << "////////////// test2 ////////////////" << endl;
+	LefDataBase db;
+	LefParser::LefMacroIndex index;
+	if (!index.read(db, filename))
+	{
+		cout << "read failed" << endl;
+		return;
+	}
+	cout << index.num_macros() << " macros indexed" << endl;
+	// parse all macros in one pass, then the first one again 
+	std::set<std::string> vMacroName;
+	for (std::size_t i = 0; i < index.num_macros(); ++i)
+		vMacroName.insert(index.macro(i).name);
+	if (index.read_macros(db, vMacroName) && (index.num_macros() == 0 || index.read_macro(db, index.macro(0).name)))
+		cout << "read successfully" << endl;
+	else cout << "read failed" << endl;
+}
+
+/// @brief test 3: flatten pins and obstructions of macros to rectangles, see @ref LefParser::LefShapeExtractor 
+void test3(std::string const& filename)
+{
+	cout << "////////////// test3 ////////////////" << endl;
+	LefShapeDataBase db;
+	if (LefParser::read(db, filename))
+		cout << "read successfully, " << db.extractor.layer_names().size() << " layers, " 
+			<< db.numPinRects << " pin rectangles, " << db.numObsRects << " obstruction rectangles" << endl;
+	else cout << "read failed" << endl;
+}
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments 
@@ -147,7 +219,11 @@ int main(int argc, char** argv)
 	if (argc > 1)
 	{
 		for (int i = 1; i < argc; ++i)
+		{
 			test1(argv[i]);
+			test2(argv[i]);
+			test3(argv[i]);
+		}
 	}
 	else 
 		cout << "at least 1 argument is required" << endl;
@@ -0,0 +1,203 @@
+/**
+ * @file   lefdef/test_loader.cpp
+ * @brief  test reading LEF and DEF files concurrently, see @ref LefDefLoader::read
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+
+#include <limbo/parsers/lefdef/LefDefLoader.h>
+#include <limbo/parsers/common/DesignSymbols.h>
+
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+/// @brief LEF database recording names of macros
+class LefDataBase : public LefParser::LefDataBase
+{
+	public:
+        /// @nowarn
+		virtual void lef_version_cbk(string const&) {}
+		virtual void lef_version_cbk(double) {}
+		virtual void lef_dividerchar_cbk(string const&) {}
+		virtual void lef_units_cbk(LefParser::lefiUnits const&) {}
+		virtual void lef_manufacturing_cbk(double) {}
+		virtual void lef_busbitchars_cbk(string const&) {}
+		virtual void lef_layer_cbk(LefParser::lefiLayer const&) {}
+		virtual void lef_via_cbk(LefParser::lefiVia const&) {}
+		virtual void lef_viarule_cbk(LefParser::lefiViaRule const&) {}
+		virtual void lef_spacing_cbk(LefParser::lefiSpacing const&) {}
+		virtual void lef_site_cbk(LefParser::lefiSite const&) {}
+		virtual void lef_prop_cbk(LefParser::lefiProp const&) {}
+		virtual void lef_maxstackvia_cbk(LefParser::lefiMaxStackVia const&) {}
+        /// @endnowarn
+        /// @brief macro callback, record the index of the macro
+        /// @param v an object for macro
+		virtual void lef_macro_cbk(LefParser::lefiMacro const& v)
+		{
+            mMacroIndex.insert(std::make_pair(string(v.name()), (int)mMacroIndex.size()));
+		}
+
+        std::map<string, int> mMacroIndex; ///< map macro name to index
+};
+
+/// @brief DEF database recording macro names of components, bound to macros after reading
+class DefDataBase : public DefParser::DefDataBase
+{
+	public:
+        /// @nowarn
+		virtual void set_def_dividerchar(string const&) {}
+		virtual void set_def_busbitchars(string const&) {}
+		virtual void set_def_version(string const&) {}
+		virtual void set_def_design(string const&) {}
+		virtual void set_def_unit(int) {}
+		virtual void set_def_diearea(int, int, int, int) {}
+		virtual void add_def_row(DefParser::Row const&) {}
+		virtual void resize_def_component(int n) {vComponentMacro.reserve(n);}
+		virtual void add_def_pin(DefParser::Pin const&) {}
+		virtual void resize_def_pin(int) {}
+		virtual void add_def_net(DefParser::Net const&) {}
+		virtual void resize_def_net(int) {}
+        /// @endnowarn
+        /// @brief add component, the macro may not be read yet
+        /// @param c component
+		virtual void add_def_component(DefParser::Component const& c)
+		{
+            vComponentMacro.push_back(c.macro_name);
+		}
+
+        vector<string> vComponentMacro; ///< macro names of components
+};
+
+/// @brief LEF database sharing a symbol table, so macros are known by symbols
+class LefSymbolDataBase : public LefDataBase
+{
+	public:
+        /// @brief constructor
+        /// @param symbols shared table
+		LefSymbolDataBase(limbo::DesignSymbols& symbols) : symbols(symbols), numMacros(0) {}
+        /// @return shared table
+		virtual limbo::DesignSymbols* lef_symbols() {return &symbols;}
+        /// @brief macro callback with its symbol
+		virtual void lef_macro_id_cbk(unsigned int, LefParser::lefiMacro const&) {++numMacros;}
+
+        limbo::DesignSymbols& symbols; ///< shared table
+        int numMacros; ///< number of macros
+};
+
+/// @brief DEF database sharing a symbol table, so components come with symbols of their macros
+class DefSymbolDataBase : public DefParser::DefRefDataBase
+{
+	public:
+        /// @brief constructor
+        /// @param symbols shared table
+		DefSymbolDataBase(limbo::DesignSymbols& symbols) : symbols(symbols), numMismatches(0) {}
+        /// @nowarn
+		virtual void set_def_dividerchar(string const&) {}
+		virtual void set_def_busbitchars(string const&) {}
+		virtual void set_def_version(string const&) {}
+		virtual void set_def_design(string const&) {}
+		virtual void set_def_unit(int) {}
+		virtual void set_def_diearea(int, int, int, int) {}
+		virtual void add_def_row(DefParser::Row const&) {}
+		virtual void resize_def_component(int n) {vComponentMacro.reserve(n);}
+		virtual void add_def_pin_ref(DefParser::PinRef const&) {}
+		virtual void resize_def_pin(int) {}
+		virtual void resize_def_net(int) {}
+        /// @endnowarn
+        /// @return shared table
+		virtual limbo::DesignSymbols* def_symbols() {return &symbols;}
+        /// @brief add component by symbols, which must match its names and bind it to its macro
+        /// @param c component
+		virtual void add_def_component_ref(DefParser::ComponentRef const& c)
+		{
+            vComponentMacro.push_back(c.macro_id);
+            if (!(c.comp_name == symbols.str(limbo::DESIGN_INSTANCE, c.comp_id).to_string())
+                    || !(c.macro_name == symbols.str(limbo::DESIGN_MACRO, c.macro_id).to_string())
+                    || symbols.instance_macro(c.comp_id) != c.macro_id)
+                ++numMismatches;
+		}
+        /// @brief add net by symbols, which must match its names
+        /// @param n net
+		virtual void add_def_net_ref(DefParser::NetRef const& n)
+		{
+            if (!(n.net_name == symbols.str(limbo::DESIGN_NET, n.net_id).to_string()) || n.vNetPinId.size() != n.vNetPin.size())
+            {
+                ++numMismatches;
+                return;
+            }
+            for (std::size_t i = 0; i < n.vNetPin.size(); ++i)
+            {
+                unsigned int comp = n.vNetPinId[i].first;
+                if (!(n.vNetPin[i].second == symbols.str(limbo::DESIGN_PIN, n.vNetPinId[i].second).to_string()))
+                    ++numMismatches;
+                // IO pins have no component
+                else if (comp == limbo::DesignSymbols::invalid_id())
+                    numMismatches += !(n.vNetPin[i].first == "PIN");
+                else
+                    numMismatches += !(n.vNetPin[i].first == symbols.str(limbo::DESIGN_INSTANCE, comp).to_string());
+            }
+		}
+
+        limbo::DesignSymbols& symbols; ///< shared table
+        vector<unsigned int> vComponentMacro; ///< macro symbols of components
+        int numMismatches; ///< number of components and net pins whose symbols differ from their names
+};
+
+/// @brief main function
+/// @param argc number of arguments
+/// @param argv values of arguments: LEF files followed by a DEF file
+/// @return 0 if succeed
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		cout << "usage: test_loader lef1 [lef2 ...] def" << endl;
+		return 1;
+	}
+
+	vector<string> vLefFile (argv+1, argv+argc-1);
+	LefDataBase lefDb;
+	DefDataBase defDb;
+	bool ok = LefDefLoader::read(lefDb, vLefFile, defDb, argv[argc-1]);
+	cout << "read " << vLefFile.size() << " LEF files and DEF file: " << (ok? "succeed" : "failed") << endl;
+
+	// bind components to macros after both LEF and DEF are read
+	vector<int> vComponentMacroIndex (defDb.vComponentMacro.size(), -1);
+	int numUnbound = 0;
+	for (std::size_t i = 0; i < defDb.vComponentMacro.size(); ++i)
+	{
+		std::map<string, int>::const_iterator found = lefDb.mMacroIndex.find(defDb.vComponentMacro[i]);
+		if (found != lefDb.mMacroIndex.end())
+			vComponentMacroIndex[i] = found->second;
+		else
+		{
+			cout << "macro " << defDb.vComponentMacro[i] << " of component " << i << " not found" << endl;
+			++numUnbound;
+		}
+	}
+	cout << "macros: " << lefDb.mMacroIndex.size() << ", components: " << vComponentMacroIndex.size()
+		<< ", unbound components: " << numUnbound << endl;
+
+	// read again with a shared symbol table, components are bound to macros while parsing
+	limbo::DesignSymbols symbols;
+	LefSymbolDataBase lefSymbolDb (symbols);
+	DefSymbolDataBase defSymbolDb (symbols);
+	ok = LefDefLoader::read(lefSymbolDb, vLefFile, defSymbolDb, argv[argc-1]) && ok;
+	int numSymbolUnbound = 0;
+	for (std::size_t i = 0; i < defSymbolDb.vComponentMacro.size(); ++i)
+		numSymbolUnbound += !symbols.macro_defined(defSymbolDb.vComponentMacro[i]);
+	cout << "symbols: " << symbols.size(limbo::DESIGN_MACRO) << " macros, " << symbols.size(limbo::DESIGN_INSTANCE) << " components, "
+		<< symbols.size(limbo::DESIGN_NET) << " nets, " << symbols.size(limbo::DESIGN_PIN) << " pins, unbound components: " << numSymbolUnbound << endl;
+	cout << "symbols different from names: " << defSymbolDb.numMismatches << ", conflicts: " << symbols.num_conflicts() << endl;
+	ok = (lefSymbolDb.numMacros == (int)lefDb.mMacroIndex.size() && numSymbolUnbound == numUnbound
+			&& defSymbolDb.vComponentMacro.size() == defDb.vComponentMacro.size()
+			&& defSymbolDb.numMismatches == 0 && symbols.num_conflicts() == 0) && ok;
+
+	return ok? 0 : 1;
+}
@@ -93,6 +93,33 @@ void test2(string const& filename)
 	driver.parse_file(filename);
 }
 
+/// @brief test 3: read into @ref LpParser::LpSparseModel without callbacks 
+void test3(string const& filename)
+{
+	cout << "////////////// test3 ////////////////" << endl;
+	LpParser::LpSparseModel model; 
+	if (!LpParser::read(model, filename))
+	{
+		cout << "failed to read " << filename << endl;
+		return;
+	}
+	cout << model.num_variables() << " variables, " << model.num_constraints() << " constraints" << endl;
+	cout << (model.minimize? "Minimize\n" : "Maximize\n");
+	for (unsigned i = 0; i < model.vObjColumn.size(); ++i)
+		cout << " + " << model.vObjElement[i] << " " << model.vVariableName[model.vObjColumn[i]];
+	cout << endl;
+	cout << "Subject To\n";
+	for (unsigned i = 0; i < model.num_constraints(); ++i)
+	{
+		cout << model.vConstraintName[i] << ": ";
+		for (int j = model.vRowBegin[i]; j < model.vRowBegin[i+1]; ++j)
+			cout << " + " << model.vElement[j] << " " << model.vVariableName[model.vColumn[j]];
+		cout << " " << model.vSense[i] << " " << model.vRhs[i] << endl;
+	}
+	for (unsigned i = 0; i < model.num_variables(); ++i)
+		cout << model.vLowerBound[i] << " <= " << model.vVariableName[i] << " <= " << model.vUpperBound[i] << " " << model.vVariableType[i] << endl;
+}
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments 
@@ -103,6 +130,7 @@ int main(int argc, char** argv)
 	{
 		test1(argv[1]);
 		test2(argv[1]);
+		test3(argv[1]);
 	}
 	else 
 		cout << "at least 1 argument is required" << endl;
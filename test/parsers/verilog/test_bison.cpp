@@ -7,8 +7,17 @@
 
 #include <iostream>
 #include <fstream>
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <limbo/parsers/verilog/bison/VerilogDriver.h>
+#include <limbo/parsers/common/DesignSymbols.h>
 
 using std::cout;
 using std::cin;
@@ -109,6 +118,111 @@ class VerilogDataBase : public VerilogParser::VerilogDataBase
         }
 };
 
+/// @brief Custom class that inheritates @ref VerilogParser::VerilogIdDataBase 
+/// to read instances by symbols, other callbacks are the same as VerilogDataBase 
+class VerilogIdDataBase : public VerilogParser::VerilogIdDataBase
+{
+	public:
+        /// @brief read a module declaration 
+        virtual void verilog_module_declaration_cbk(std::string const& module_name, std::vector<VerilogParser::GeneralName> const&)
+        {
+            cout << __func__ << " => " << module_name << endl;
+        }
+        /// @brief read an net declaration 
+        virtual void verilog_net_declare_cbk(std::string const&, VerilogParser::Range const&) {}
+        /// @brief read an pin declaration 
+        virtual void verilog_pin_declare_cbk(std::string const&, unsigned, VerilogParser::Range const&) {}
+        /// @brief read an assignment 
+        virtual void verilog_assignment_cbk(std::string const&, VerilogParser::Range const&, std::string const&, VerilogParser::Range const&) {}
+        /// @brief read a new symbol 
+        /// @param id symbol 
+        /// @param name name of the symbol 
+        virtual void verilog_symbol_cbk(int id, std::string const& name)
+        {
+            assert(id == (int)m_vSymbol.size());
+            m_vSymbol.push_back(name);
+        }
+        /// @brief read an instance by symbols, print in the same format as VerilogDataBase 
+        /// @param macro_id symbol of standard cell type or module name 
+        /// @param inst_id symbol of instance name 
+        /// @param vNetPin array of connections 
+        /// @param numNetPins number of connections 
+        /// @param vGroupNet nets of groups 
+        virtual void verilog_instance_cbk(int macro_id, int inst_id, VerilogParser::NetPinId const* vNetPin, unsigned numNetPins, VerilogParser::GeneralNameId const* vGroupNet)
+        {
+			cout << "verilog_instance_cbk => " << m_vSymbol[macro_id] << ", " << m_vSymbol[inst_id] << ", ";
+            for (unsigned i = 0; i < numNetPins; ++i)
+            {
+                VerilogParser::NetPinId const& np = vNetPin[i];
+                if (np.net == VerilogParser::kCONSTANT_NET)
+                    cout << m_vSymbol[np.pin] << "(VerilogParser::CONSTANT_NET " << np.constant << ")";
+                else if (np.net == VerilogParser::kGROUP_NETS)
+                {
+                    cout << m_vSymbol[np.pin] << "(VerilogParser::GROUP_NETS {";
+                    for (unsigned j = np.group_begin; j < np.group_end; ++j)
+                        cout << "(" << m_vSymbol[vGroupNet[j].name] << ")" << "[" << vGroupNet[j].range.low << ":" << vGroupNet[j].range.high << "] ";
+                    cout << "} " << ")";
+                }
+                else 
+                    cout << m_vSymbol[np.pin] << "(" << m_vSymbol[np.net] << ")";
+                cout << "[" << np.range.low << ":" << np.range.high << "] ";
+            }
+            cout << endl;
+        }
+    protected:
+        std::vector<std::string> m_vSymbol; ///< names of symbols 
+};
+
+/// @brief Custom class recording the macro of each instance by names 
+class VerilogNameDataBase : public VerilogDataBase
+{
+	public:
+        /// @brief read a module declaration 
+        virtual void verilog_module_declaration_cbk(std::string const&, std::vector<VerilogParser::GeneralName> const&) {}
+        /// @brief read an net declaration 
+        virtual void verilog_net_declare_cbk(std::string const&, VerilogParser::Range const&) {}
+        /// @brief read an pin declaration 
+        virtual void verilog_pin_declare_cbk(std::string const&, unsigned, VerilogParser::Range const&) {}
+        /// @brief read an assignment 
+        virtual void verilog_assignment_cbk(std::string const&, VerilogParser::Range const&, std::string const&, VerilogParser::Range const&) {}
+        /// @brief record an instance 
+        /// @param macro_name standard cell type or module name 
+        /// @param inst_name instance name 
+        virtual void verilog_instance_cbk(std::string const& macro_name, std::string const& inst_name, std::vector<VerilogParser::NetPin> const&)
+        {
+            mInstMacro[inst_name] = macro_name;
+        }
+
+        std::map<std::string, std::string> mInstMacro; ///< macro of each instance 
+};
+
+/// @brief Custom class interning instances into a table shared with LEF and DEF databases, see @ref limbo::DesignSymbols 
+class VerilogSymbolDataBase : public VerilogIdDataBase
+{
+	public:
+        /// @brief constructor 
+        /// @param symbols shared table 
+		VerilogSymbolDataBase(limbo::DesignSymbols& symbols) : symbols(symbols), numMismatches(0) {}
+        /// @return shared table 
+		virtual limbo::DesignSymbols* verilog_symbols() {return &symbols;}
+        /// @brief record an instance by symbols, which must be bound to its macro 
+        /// @param macro_id symbol of standard cell type or module name 
+        /// @param inst_id symbol of instance name 
+        /// @param vNetPin array of connections 
+        /// @param numNetPins number of connections 
+        virtual void verilog_instance_cbk(int macro_id, int inst_id, VerilogParser::NetPinId const* vNetPin, unsigned numNetPins, VerilogParser::GeneralNameId const*)
+        {
+            mInstMacro[symbols.str(limbo::DESIGN_INSTANCE, inst_id).to_string()] = symbols.str(limbo::DESIGN_MACRO, macro_id).to_string();
+            numMismatches += (symbols.instance_macro(inst_id) != (unsigned int)macro_id);
+            for (unsigned i = 0; i < numNetPins; ++i)
+                numMismatches += ((unsigned int)vNetPin[i].pin >= symbols.size(limbo::DESIGN_PIN));
+        }
+
+        limbo::DesignSymbols& symbols; ///< shared table 
+        std::map<std::string, std::string> mInstMacro; ///< macro of each instance by names of symbols 
+        int numMismatches; ///< number of instances not bound to their macros or with invalid pins 
+};
+
 /// @brief test 1: use function wrapper @ref VerilogParser::read  
 void test1(string const& filename)
 {
@@ -129,20 +243,129 @@ void test2(string const& filename)
 	driver.parse_file(filename);
 }
 
+/// @brief test 3: read instances by symbols, see @ref VerilogParser::VerilogIdDataBase 
+void test3(string const& filename)
+{
+	cout << "////////////// test3 ////////////////" << endl;
+	VerilogIdDataBase db;
+	VerilogParser::read(db, filename);
+}
+
+/// @brief test 4: parse modules with multiple threads, see @ref VerilogParser::read 
+/// @param filename Verilog file 
+/// @param numThreads number of threads 
+void test4(string const& filename, int numThreads)
+{
+	cout << "////////////// test4 ////////////////" << endl;
+	VerilogDataBase db;
+	VerilogParser::read(db, filename, numThreads);
+	VerilogIdDataBase idDb;
+	VerilogParser::read(idDb, filename, numThreads);
+}
+
+/// @brief test 5: intern instances into a shared table, serially and with multiple threads, see @ref VerilogParser::VerilogIdDataBase::verilog_symbols 
+/// @param filename Verilog file 
+/// @param numThreads number of threads 
+/// @return true if instances by symbols match instances by names 
+bool test5(string const& filename, int numThreads)
+{
+	cout << "////////////// test5 ////////////////" << endl;
+	VerilogNameDataBase nameDb;
+	VerilogParser::read(nameDb, filename);
+	bool ok = true;
+	for (int threads = 1; threads <= numThreads; threads = (threads == numThreads)? threads+1 : numThreads)
+	{
+		limbo::DesignSymbols symbols;
+		// a macro already known from LEF keeps its symbol 
+		unsigned int macro = symbols.find_or_insert(limbo::DESIGN_MACRO, "INV_X1");
+		symbols.define_macro(macro);
+		VerilogSymbolDataBase db (symbols);
+		VerilogParser::read(db, filename, threads);
+		ok = (db.mInstMacro == nameDb.mInstMacro && db.numMismatches == 0 && symbols.num_conflicts() == 0 
+				&& symbols.size(limbo::DESIGN_INSTANCE) == nameDb.mInstMacro.size() && symbols.macro_defined(macro)) && ok;
+		cout << threads << " threads: " << symbols.size(limbo::DESIGN_MACRO) << " macros, " << symbols.size(limbo::DESIGN_INSTANCE) << " instances, " 
+			<< symbols.size(limbo::DESIGN_NET) << " nets, " << symbols.size(limbo::DESIGN_PIN) << " pins, " << db.numMismatches << " mismatches" << endl;
+	}
+	return ok;
+}
+
+/// @brief write a string to a pipe, run by the writer thread of test6 
+/// @param arg pointer to a pair of the pipe name and the content 
+/// @return NULL 
+void* writePipe(void* arg)
+{
+	std::pair<string, string> const& task = *(std::pair<string, string> const*)arg;
+	std::ofstream out (task.first.c_str(), std::ios::binary);
+	out.write(task.second.data(), task.second.size());
+	return NULL;
+}
+
+/// @brief test 6: read a file of several blocks ahead with @ref limbo::PrefetchInputStream, 
+/// from a regular file and from a pipe, and compare with reading from memory 
+/// @param filename generated Verilog file 
+/// @return true if all reads give the same instances 
+bool test6(string const& filename)
+{
+	cout << "////////////// test6 ////////////////" << endl;
+	// about 4 MB, more than the ring of blocks 
+	std::ostringstream oss;
+	oss << "module big ( a, z );\ninput a;\noutput z;\n";
+	int const numInstances = 80000;
+	for (int i = 0; i < numInstances; ++i)
+		oss << ((i%3)? "INV_X1" : "NAND2_X1") << " g" << i << " ( .a(n" << i << "), .b(a), .o(n" << i+1 << ") );\n";
+	oss << "endmodule\n";
+	string content = oss.str();
+	{
+		std::ofstream out (filename.c_str(), std::ios::binary);
+		out.write(content.data(), content.size());
+	}
+
+	VerilogNameDataBase memoryDb;
+	VerilogParser::Driver memoryDriver (memoryDb);
+	bool ok = memoryDriver.parse_string(content, filename) && memoryDb.mInstMacro.size() == (std::size_t)numInstances;
+
+	VerilogNameDataBase fileDb;
+	VerilogParser::Driver fileDriver (fileDb);
+	ok = fileDriver.parse_file(filename) && fileDb.mInstMacro == memoryDb.mInstMacro && ok;
+
+	// a pipe has no size, so it is always read by the helper thread 
+	string pipeName = filename + ".fifo";
+	unlink(pipeName.c_str());
+	if (mkfifo(pipeName.c_str(), 0600) == 0)
+	{
+		std::pair<string, string> task (pipeName, content);
+		pthread_t writer;
+		if (pthread_create(&writer, NULL, writePipe, &task) == 0)
+		{
+			VerilogNameDataBase pipeDb;
+			VerilogParser::Driver pipeDriver (pipeDb);
+			ok = pipeDriver.parse_file(pipeName) && pipeDb.mInstMacro == memoryDb.mInstMacro && ok;
+			pthread_join(writer, NULL);
+		}
+		unlink(pipeName.c_str());
+	}
+	cout << content.size() << " bytes, " << memoryDb.mInstMacro.size() << " instances: " << (ok? "same" : "different") << endl;
+	return ok;
+}
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments 
-/// @return 0 
+/// @return 0 if succeed 
 int main(int argc, char** argv)
 {
-
+	bool ok = true;
 	if (argc > 1)
 	{
 		test1(argv[1]);
 		test2(argv[1]);
+		test3(argv[1]);
+		test4(argv[1], (argc > 2)? atoi(argv[2]) : 4);
+		ok = test5(argv[1], (argc > 2)? atoi(argv[2]) : 4);
+		ok = test6("test_bison.prefetch.v") && ok;
 	}
 	else 
 		cout << "at least 1 argument is required" << endl;
 
-	return 0;
+	return ok? 0 : 1;
 }
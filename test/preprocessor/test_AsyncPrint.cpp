@@ -0,0 +1,138 @@
+/**
+ * @file   test_AsyncPrint.cpp
+ * @brief  test the print functions in @ref PrintMsg.h with and without the asynchronous back end in @ref AsyncPrint.h
+ * @date   Oct 2026
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <pthread.h>
+#include <limbo/preprocessor/AsyncPrint.h>
+#include <limbo/preprocessor/AssertMsg.h>
+
+/// @brief lines printed by one thread 
+struct PrintTask 
+{
+	FILE* stream; ///< output stream 
+	unsigned int id; ///< thread index 
+	unsigned int numLines; ///< number of lines to print 
+};
+
+/// @brief print numbered lines 
+/// @param arg pointer to @ref PrintTask
+/// @return NULL 
+void* printLines(void* arg)
+{
+	PrintTask const& task = *(PrintTask const*)arg;
+	for (unsigned int i = 0; i < task.numLines; ++i)
+		limbo::limboPrintStream(limbo::kINFO, task.stream, "%u %u\n", task.id, i);
+	return NULL;
+}
+
+/// @brief count lines of a stream containing a string 
+/// @param stream input stream 
+/// @param str string to search 
+/// @return number of lines 
+unsigned int countLines(FILE* stream, const char* str)
+{
+	fflush(stream);
+	rewind(stream);
+	char line[256];
+	unsigned int count = 0;
+	while (fgets(line, sizeof(line), stream))
+		count += (strstr(line, str) != NULL);
+	return count;
+}
+
+/// @brief wait until the start of the next second, so rate limiting windows are predictable 
+void waitNextSecond()
+{
+	time_t now = time(NULL);
+	while (time(NULL) == now)
+		;
+}
+
+/// @brief main function 
+/// @return 0 
+int main()
+{
+	// disabled messages are neither formatted nor written; %n records whether formatting happens 
+	{
+		FILE* stream = tmpfile();
+		limboAssert(stream);
+		int formatted = -1;
+		limbo::limboSetPrintLevel(limbo::kDEBUG, false);
+		limboAssertMsg(!limbo::limboPrintEnabled(limbo::kDEBUG), "kDEBUG still enabled");
+		limboAssertMsg(limbo::limboPrintStream(limbo::kDEBUG, stream, "%n\n", &formatted) == 0, "disabled message written");
+		limboAssertMsg(formatted == -1, "disabled message formatted");
+		limboAssertMsg(countLines(stream, "") == 0, "disabled message in stream");
+		limbo::limboSetPrintLevel(limbo::kDEBUG, true);
+		limboAssertMsg(limbo::limboPrintStream(limbo::kDEBUG, stream, "%n\n", &formatted) > 0, "enabled message not written");
+		limboAssertMsg(formatted == 0, "enabled message not formatted");
+		limboAssertMsg(countLines(stream, "(D)") == 1, "enabled message not in stream");
+		fclose(stream);
+	}
+	// lines of each thread are written in order, and none is lost 
+	{
+		FILE* stream = tmpfile();
+		limboAssert(stream);
+		unsigned int const numThreads = 8;
+		unsigned int const numLines = 20000;
+		limboAssertMsg(limbo::limboStartAsyncPrint(64), "failed to start the writer thread");
+		std::vector<PrintTask> vTask (numThreads);
+		std::vector<pthread_t> vThread (numThreads);
+		for (unsigned int i = 0; i < numThreads; ++i)
+		{
+			vTask[i].stream = stream;
+			vTask[i].id = i;
+			vTask[i].numLines = numLines;
+			limboAssertMsg(pthread_create(&vThread[i], NULL, printLines, &vTask[i]) == 0, "failed to create thread %u", i);
+		}
+		for (unsigned int i = 0; i < numThreads; ++i)
+			pthread_join(vThread[i], NULL);
+		limbo::limboStopAsyncPrint();
+
+		fflush(stream);
+		rewind(stream);
+		std::vector<unsigned int> vNext (numThreads, 0);
+		char line[256];
+		while (fgets(line, sizeof(line), stream))
+		{
+			unsigned int id = 0;
+			unsigned int i = 0;
+			limboAssertMsg(sscanf(line, "(I) %u %u", &id, &i) == 2 && id < numThreads, "garbled line: %s", line);
+			limboAssertMsg(i == vNext[id], "thread %u printed line %u before line %u", id, i, vNext[id]);
+			++vNext[id];
+		}
+		for (unsigned int i = 0; i < numThreads; ++i)
+			limboAssertMsg(vNext[i] == numLines, "thread %u lost %u lines", i, numLines-vNext[i]);
+		fclose(stream);
+	}
+	// drops within a second are reported at the next second to the stream of the dropped messages 
+	{
+		FILE* stream = tmpfile();
+		limboAssert(stream);
+		unsigned int const rateLimit = 5;
+		unsigned int const numMessages = 20;
+		limbo::limboSetPrintRateLimit(rateLimit);
+		waitNextSecond();
+		for (unsigned int i = 0; i < numMessages; ++i)
+			limbo::limboPrintStream(limbo::kWARN, stream, "message %u\n", i);
+		// errors are never limited 
+		limbo::limboPrintStream(limbo::kERROR, stream, "error\n");
+		limboAssertMsg(countLines(stream, "message") == rateLimit, "%u messages printed instead of %u", countLines(stream, "message"), rateLimit);
+		limboAssertMsg(countLines(stream, "error") == 1, "error message dropped");
+		waitNextSecond();
+		limbo::limboPrintStream(limbo::kWARN, stream, "message %u\n", numMessages);
+		char expect[64];
+		sprintf(expect, "%u messages suppressed", numMessages-rateLimit);
+		limboAssertMsg(countLines(stream, expect) == 1, "suppressed count \"%s\" not reported to the stream", expect);
+		limboAssertMsg(countLines(stream, "message") == rateLimit+2, "message after the window dropped");
+		limbo::limboSetPrintRateLimit(0);
+		fclose(stream);
+	}
+
+	return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file   test_OptionTable.cpp
+ * @brief  test static option tables parsing options of several jobs
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <string>
+#include <limbo/programoptions/OptionTable.h>
+
+using namespace limbo::programoptions;
+
+/// @brief options of a job
+struct JobOptions
+{
+    bool help; ///< print help message
+    int threads; ///< number of threads
+    double eps; ///< tolerance
+    unsigned long long seed; ///< random seed
+    std::string output; ///< output file
+    boost::string_ref tag; ///< tag of the job, a view of the option string
+};
+
+/// table of job options, shared by all jobs
+static const OptionEntry<JobOptions> vJobEntry[] = {
+    toggle_option("-help", &JobOptions::help, "print help message", "true", "false", OPTION_HELP),
+    option("-threads", &JobOptions::threads, "number of threads", "1"),
+    option("-eps", &JobOptions::eps, "tolerance", "1e-6"),
+    option("-seed", &JobOptions::seed, "random seed", "0"),
+    option("-out", &JobOptions::output, "output file", NULL, OPTION_REQUIRED),
+    option("-tag", &JobOptions::tag, "tag of the job", "none")
+};
+/// parser of job options
+static const OptionTable<JobOptions> jobTable (vJobEntry, "Job options");
+
+/// @brief print the outcome of parsing
+/// @param line option string
+/// @return number of failures against the expected error
+int check(const char* line, OptionError expected)
+{
+    JobOptions opts;
+    OptionResult result = jobTable.parse(opts, line);
+    std::cout << "[" << line << "] -> ";
+    if (result.ok())
+        std::cout << "help = " << opts.help << ", threads = " << opts.threads << ", eps = " << opts.eps
+            << ", seed = " << opts.seed << ", out = " << opts.output << ", tag = " << opts.tag << "\n";
+    else
+        std::cout << "error " << result.error << " at " << result.token << "\n";
+    return (result.error == expected)? 0 : 1;
+}
+
+/**
+ * @brief parse job options from strings and from the command line
+ * @param argc number of arguments
+ * @param argv values of arguments
+ * @return 0 if all checks pass
+ */
+int main(int argc, char** argv)
+{
+    int fails = 0;
+    fails += check("-out a.txt", OPTION_OK);
+    fails += check("  -threads 8\t-eps 2.5e-3 -seed 18446744073709551615 -out \"b c.txt\" -tag route ", OPTION_OK);
+    fails += check("-help", OPTION_OK);
+    fails += check("-threads 4", OPTION_MISSING_REQUIRED);
+    fails += check("-out a.txt -threads", OPTION_MISSING_VALUE);
+    fails += check("-out a.txt -threads 4x", OPTION_INVALID_VALUE);
+    fails += check("-out a.txt -verbose", OPTION_UNKNOWN);
+
+    std::cout << jobTable << "\n";
+
+    // the command line is parsed with the same table
+    JobOptions opts;
+    OptionResult result = jobTable.parse(opts, argc, argv);
+    std::cout << "command line: " << ((result.ok())? "ok" : "error") << "\n";
+
+    std::cout << ((fails)? "FAILED" : "PASSED") << "\n";
+    return fails;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file   test_ConjugateGradient.cpp
+ * @brief  Test @ref limbo::solvers::ConjugateGradient with different preconditioners on a quadratic placement
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <limbo/solvers/ConjugateGradient.h>
+
+/// @nowarn
+typedef limbo::solvers::MatrixCSR<double, int, 1> matrix_type;
+template <>
+matrix_type::index_type matrix_type::s_startingIndex = 1;
+/// @endnowarn
+
+/// @brief build the Laplacian of a grid of cells connected to neighbors, with some cells anchored to fixed pins
+/// @param n number of rows and columns of the grid
+/// @param A matrix
+/// @param vBx right hand side of x
+/// @param vBy right hand side of y
+void buildPlacement(unsigned int n, matrix_type& A, std::vector<double>& vBx, std::vector<double>& vBy)
+{
+    unsigned int numCells = n*n;
+    std::vector<int> vRowBegin (1, 0);
+    std::vector<int> vColumn;
+    std::vector<double> vElement;
+    vBx.assign(numCells, 0);
+    vBy.assign(numCells, 0);
+    for (unsigned int i = 0; i < numCells; ++i)
+    {
+        unsigned int r = i/n;
+        unsigned int c = i%n;
+        double diag = 0;
+        int vNeighbor[4] = {(c > 0)? (int)i-1 : -1, (c+1 < n)? (int)i+1 : -1, (r > 0)? (int)(i-n) : -1, (r+1 < n)? (int)(i+n) : -1};
+        for (unsigned int k = 0; k < 4; ++k)
+        {
+            if (vNeighbor[k] < 0)
+                continue;
+            double w = 1+rand()%10*0.1;
+            // symmetric weights from the smaller index
+            if ((unsigned int)vNeighbor[k] < i)
+            {
+                for (int p = vRowBegin[vNeighbor[k]]; p < vRowBegin[vNeighbor[k]+1]; ++p)
+                    if (vColumn[p] == (int)i)
+                        w = -vElement[p];
+            }
+            vColumn.push_back(vNeighbor[k]);
+            vElement.push_back(-w);
+            diag += w;
+        }
+        // pins on the boundary and a few random ones
+        if (r == 0 || c == 0 || r+1 == n || c+1 == n || rand()%50 == 0)
+        {
+            double w = 0.5;
+            diag += w;
+            vBx[i] = w*(c*10.0+rand()%5);
+            vBy[i] = w*(r*10.0+rand()%5);
+        }
+        vColumn.push_back(i);
+        vElement.push_back(diag);
+        vRowBegin.push_back(vColumn.size());
+    }
+    A.initialize(numCells, numCells, vColumn.size());
+    for (unsigned int i = 0; i <= numCells; ++i)
+        A.vRowBeginIndex[i] = vRowBegin[i]+matrix_type::s_startingIndex;
+    for (unsigned int k = 0; k < vColumn.size(); ++k)
+    {
+        A.vColumn[k] = vColumn[k]+matrix_type::s_startingIndex;
+        A.vElement[k] = vElement[k];
+    }
+}
+
+/// @brief relative residual \f$ \|b - A x\| / \|b\| \f$
+/// @param A matrix
+/// @param b right hand side
+/// @param x solution
+/// @return relative residual
+double residual(matrix_type const& A, std::vector<double> const& b, std::vector<double> const& x)
+{
+    double rr = 0;
+    double bb = 0;
+    for (int i = 0; i < A.numRows; ++i)
+    {
+        double r = b[i];
+        for (int k = A.vRowBeginIndex[i]-1; k < A.vRowBeginIndex[i+1]-1; ++k)
+            r -= A.vElement[k]*x[A.vColumn[k]-1];
+        rr += r*r;
+        bb += b[i]*b[i];
+    }
+    return sqrt(rr/bb);
+}
+
+/// @brief solve x and y together with a preconditioner, then check residuals, threads and warm start
+/// @param name name of the preconditioner
+/// @param A matrix
+/// @param vBx right hand side of x
+/// @param vBy right hand side of y
+/// @param preconditioner preconditioner
+/// @return true if succeed
+bool test(std::string const& name, matrix_type const& A, std::vector<double> const& vBx, std::vector<double> const& vBy,
+        limbo::solvers::CGPreconditioner<double>* preconditioner)
+{
+    limbo::solvers::ConjugateGradient<double> solver (&A, preconditioner);
+    solver.setTolerance(1e-8);
+    solver.setMaxIterations(2000);
+    std::vector<double> vX (A.numRows, 0);
+    std::vector<double> vY (A.numRows, 0);
+    double const* vRhs[2] = {&vBx[0], &vBy[0]};
+    double* vSolution[2] = {&vX[0], &vY[0]};
+    limbo::solvers::SolverProperty status = solver(2, vRhs, vSolution);
+    unsigned int numIterations = solver.numIterations();
+    std::cout << name << ": " << limbo::solvers::toString(status) << " in " << numIterations << " iterations, residual x = "
+        << residual(A, vBx, vX) << ", y = " << residual(A, vBy, vY) << "\n";
+    if (status != limbo::solvers::OPTIMAL || residual(A, vBx, vX) > 1e-6 || residual(A, vBy, vY) > 1e-6)
+    {
+        std::cout << "not converged\n";
+        return false;
+    }
+
+    // the same iterations with more threads and a single right hand side
+    std::vector<double> vX4 (A.numRows, 0);
+    solver.setNumThreads(4);
+    solver(&vBx[0], &vX4[0]);
+    for (int i = 0; i < A.numRows; ++i)
+    {
+        if (std::abs(vX4[i]-vX[i]) > 1e-6*(1+std::abs(vX[i])))
+        {
+            std::cout << "solution of a single right hand side with 4 threads differs at " << i << "\n";
+            return false;
+        }
+    }
+
+    // warm start from a perturbed solution
+    std::vector<double> vBx2 (vBx);
+    for (unsigned int i = 0; i < vBx2.size(); i += 97)
+        vBx2[i] += 1;
+    solver.setWarmStart(true);
+    status = solver(&vBx2[0], &vX[0]);
+    std::cout << name << " warm start: " << limbo::solvers::toString(status) << " in " << solver.numIterations() << " iterations, residual = "
+        << residual(A, vBx2, vX) << "\n";
+    if (status != limbo::solvers::OPTIMAL || residual(A, vBx2, vX) > 1e-6 || solver.numIterations() >= numIterations)
+    {
+        std::cout << "warm start does not help\n";
+        return false;
+    }
+    return true;
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+    matrix_type A;
+    std::vector<double> vBx;
+    std::vector<double> vBy;
+    buildPlacement(200, A, vBx, vBy);
+
+    limbo::solvers::CGPreconditioner<double> identity;
+    limbo::solvers::JacobiPreconditioner<double> jacobi;
+    limbo::solvers::IncompleteCholeskyPreconditioner<double> ic;
+    limbo::solvers::AggregationPreconditioner<double> amg;
+    if (!test("no preconditioner", A, vBx, vBy, &identity))
+        return 1;
+    if (!test("Jacobi", A, vBx, vBy, &jacobi))
+        return 1;
+    if (!test("incomplete Cholesky", A, vBx, vBy, &ic))
+        return 1;
+    if (!test("aggregation", A, vBx, vBy, &amg))
+        return 1;
+    std::cout << "aggregation levels = " << amg.numLevels() << "\n";
+    return 0;
+}
@@ -2,7 +2,7 @@
  * @file   test_CplexApi.cpp
  * @author Yibo Lin
  * @date   Aug 2023
- * @brief  Test CPLEX API @ref limbo::solvers::CplexLinearApi
+ * @brief  Test CPLEX API @ref limbo::solvers::CplexLinearApi and @ref limbo::solvers::CplexLinearSession
  */
 #include <iostream>
 #include <limbo/solvers/api/CplexApi.h>
@@ -55,5 +55,24 @@ int main()
     std::cout << optModel.variableName(var3) << " = " << optModel.variableSolution(var3) << "\n";
     std::cout << optModel.variableName(var4) << " = " << optModel.variableSolution(var4) << "\n";
 
+    // re-solve modified models in a session 
+    {
+        typedef limbo::solvers::CplexLinearSession<model_type::coefficient_value_type, model_type::variable_value_type> session_type; 
+        session_type session (&optModel, &cplexParams); 
+        // x3 >= 0.1 becomes a bound, the optimal objective rises from 1 to 1.4 
+        session.addConstraint(var3 >= 0.1, "c4"); 
+        optStatus = session(); 
+        std::cout << "add bound: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+        // x4 costs 2, the optimal objective is 1.6 
+        session.setObjectiveCoefficient(var4, 2); 
+        optStatus = session(); 
+        std::cout << "change objective: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+        // x4 - x3 >= 0.1 removed, x4 = 0 and the optimal objective is 1.2 
+        session.removeConstraints(std::vector<unsigned int>(1, 1)); 
+        session.setVariableBounds(var1, 0, 0.9); 
+        optStatus = session(); 
+        std::cout << "remove constraint: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+    }
+
     return 0; 
 }
@@ -0,0 +1,167 @@
+/**
+ * @file   test_DifferenceConstraints.cpp
+ * @brief  Test difference constraint systems added directly to @ref limbo::solvers::DualMinCostFlow without a model
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <limbo/solvers/DualMinCostFlow.h>
+
+/// @nowarn
+typedef limbo::solvers::LinearModel<int, int> model_type;
+typedef limbo::solvers::DualMinCostFlow<int, int> solver_type;
+/// @endnowarn
+
+/// @brief generate cells in rows with spacing constraints to their right neighbors and to some cells of the next row
+/// @param numCells number of cells
+/// @param vSource first variable of each constraint
+/// @param vTarget second variable of each constraint
+/// @param vRhs right hand side of each constraint
+/// @param vWeight objective weight of each cell
+/// @param crossRows whether to add constraints between rows
+void randomSystem(int numCells, std::vector<int>& vSource, std::vector<int>& vTarget, std::vector<int>& vRhs, std::vector<int>& vWeight, bool crossRows = true)
+{
+    int rowSize = 100;
+    for (int i = 0; i < numCells; ++i)
+    {
+        vWeight.push_back(rand()%21-10);
+        if ((i+1)%rowSize)
+        {
+            vSource.push_back(std::min(i+1, numCells-1));
+            vTarget.push_back(i);
+            vRhs.push_back(1+rand()%10);
+        }
+        if (crossRows && i+rowSize < numCells && rand()%4 == 0)
+        {
+            vSource.push_back(i+rowSize);
+            vTarget.push_back(i);
+            vRhs.push_back(rand()%20-10);
+        }
+    }
+}
+
+/// @brief solve the same system with a model and directly
+/// @return true if solutions match
+bool testSameAsModel()
+{
+    int numCells = 100000;
+    std::vector<int> vSource, vTarget, vRhs, vWeight;
+    randomSystem(numCells, vSource, vTarget, vRhs, vWeight);
+
+    clock_t start = clock();
+    model_type model;
+    for (int i = 0; i < numCells; ++i)
+        model.addVariable(0, numCells*10, limbo::solvers::INTEGER, "");
+    model_type::expression_type obj;
+    for (int i = 0; i < numCells; ++i)
+        obj += vWeight[i]*model.variable(i);
+    model.setObjective(obj);
+    model.setOptimizeType(limbo::solvers::MIN);
+    for (unsigned int k = 0; k < vRhs.size(); ++k)
+        model.addConstraint(model.variable(vSource[k])-model.variable(vTarget[k]) >= vRhs[k], "");
+    double modelTime = double(clock()-start)/CLOCKS_PER_SEC;
+    solver_type modelSolver (&model);
+    limbo::solvers::NetworkSimplex<int, int> alg;
+    limbo::solvers::SolverProperty modelStatus = modelSolver(&alg);
+
+    start = clock();
+    solver_type directSolver;
+    directSolver.reserve(numCells, vRhs.size());
+    for (int i = 0; i < numCells; ++i)
+    {
+        directSolver.addVariable(0, numCells*10);
+        directSolver.addObjectiveWeight(i, vWeight[i]);
+    }
+    for (unsigned int k = 0; k < vRhs.size(); ++k)
+        directSolver.addDifferenceConstraint(vSource[k], vTarget[k], vRhs[k]);
+    double directTime = double(clock()-start)/CLOCKS_PER_SEC;
+    limbo::solvers::SolverProperty directStatus = directSolver(&alg);
+
+    std::cout << numCells << " cells, " << vRhs.size() << " constraints set up in " << modelTime << " s with a model, "
+        << directTime << " s without" << std::endl;
+    if (directStatus != limbo::solvers::OPTIMAL || modelStatus != directStatus || directSolver.totalCost() != modelSolver.totalCost()
+            || directSolver.solutions() != model.variableSolutions())
+    {
+        std::cout << "objective " << directSolver.totalCost() << ", expected " << modelSolver.totalCost() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// @brief a soft constraint is violated when its penalty is lower than the gain in the objective
+/// @return true if the solutions are expected
+bool testSoftConstraint()
+{
+    for (int penalty = 1; penalty <= 3; penalty += 2)
+    {
+        solver_type solver;
+        solver.addVariable(0, 10);
+        solver.addVariable(0, 10);
+        // min. 2 x_1 - 2 x_0 + penalty * max(0, 5 - (x_1 - x_0))
+        solver.addObjectiveWeight(0, -2);
+        solver.addObjectiveWeight(1, 2);
+        solver.addDifferenceConstraint(1, 0, 5, penalty);
+        limbo::solvers::SolverProperty status = solver();
+        int diff = solver.solutions()[1]-solver.solutions()[0];
+        int expected = (penalty < 2)? -10 : 5;
+        if (status != limbo::solvers::OPTIMAL || diff != expected)
+        {
+            std::cout << "penalty " << penalty << ": x_1 - x_0 = " << diff << ", expected " << expected << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief rows without constraints between them are solved as independent subnetworks
+/// @return true if the objective and feasibility match the solve of the whole graph
+bool testDecompose()
+{
+    int numCells = 20000;
+    std::vector<int> vSource, vTarget, vRhs, vWeight;
+    randomSystem(numCells, vSource, vTarget, vRhs, vWeight, false);
+
+    double vTime[2];
+    int vObjective[2];
+    for (int decompose = 0; decompose < 2; ++decompose)
+    {
+        solver_type solver;
+        solver.reserve(numCells, vRhs.size());
+        for (int i = 0; i < numCells; ++i)
+        {
+            solver.addVariable(0, 2000);
+            solver.addObjectiveWeight(i, vWeight[i]);
+        }
+        for (unsigned int k = 0; k < vRhs.size(); ++k)
+            solver.addDifferenceConstraint(vSource[k], vTarget[k], vRhs[k]);
+        solver.setDecompose(decompose);
+        limbo::solvers::NetworkSimplex<int, int> alg;
+        clock_t start = clock();
+        limbo::solvers::SolverProperty status = solver(&alg);
+        vTime[decompose] = double(clock()-start)/CLOCKS_PER_SEC;
+        if (status != limbo::solvers::OPTIMAL || (decompose && solver.numSubnetworks() <= 1))
+            return false;
+        vObjective[decompose] = 0;
+        for (int i = 0; i < numCells; ++i)
+            vObjective[decompose] += vWeight[i]*solver.solutions()[i];
+        for (unsigned int k = 0; k < vRhs.size(); ++k)
+            if (solver.solutions()[vSource[k]]-solver.solutions()[vTarget[k]] < vRhs[k])
+                return false;
+        if (solver.totalCost() != vObjective[decompose])
+            return false;
+    }
+    std::cout << "rows solved in " << vTime[0] << " s as one graph, " << vTime[1] << " s as subnetworks" << std::endl;
+    return vObjective[0] == vObjective[1];
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+    if (!testSameAsModel() || !testSoftConstraint() || !testDecompose())
+        return 1;
+    return 0;
+}
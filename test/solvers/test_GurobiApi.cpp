@@ -2,7 +2,7 @@
  * @file   test_GurobiApi.cpp
  * @author Yibo Lin
  * @date   Mar 2017
- * @brief  Test Gurobi API @ref limbo::solvers::GurobiLinearApi
+ * @brief  Test Gurobi API @ref limbo::solvers::GurobiLinearApi, @ref limbo::solvers::GurobiLinearSession and @ref limbo::solvers::GurobiPoolBackend
  */
 #include <iostream>
 #include <limbo/solvers/api/GurobiApi.h>
@@ -55,5 +55,47 @@ int main()
     std::cout << optModel.variableName(var3) << " = " << optModel.variableSolution(var3) << "\n";
     std::cout << optModel.variableName(var4) << " = " << optModel.variableSolution(var4) << "\n";
 
+    // re-solve modified models in a session 
+    {
+        typedef limbo::solvers::GurobiLinearSession<model_type::coefficient_value_type, model_type::variable_value_type> session_type; 
+        session_type session (&optModel, NULL, &gurobiParams); 
+        // x3 >= 0.1 becomes a bound, the optimal objective rises from 1 to 1.4 
+        session.addConstraint(var3 >= 0.1, "c4"); 
+        optStatus = session(); 
+        std::cout << "add bound: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+        // x4 costs 2, the optimal objective is 1.6 
+        session.setObjectiveCoefficient(var4, 2); 
+        optStatus = session(); 
+        std::cout << "change objective: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+        // x4 - x3 >= 0.1 removed, x4 = 0 and the optimal objective is 1.2 
+        session.removeConstraints(std::vector<unsigned int>(1, 1)); 
+        session.setVariableBounds(var1, 0, 0.9); 
+        optStatus = session(); 
+        std::cout << "remove constraint: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+    }
+
+    // solve copies with shifted right hand sides on a pool of 2 environments 
+    {
+        typedef limbo::solvers::SolverPool<limbo::solvers::GurobiPoolBackend<model_type::coefficient_value_type, model_type::variable_value_type> > pool_type; 
+        pool_type pool (2, 1); 
+        std::vector<model_type> vModel (8); 
+        std::vector<limbo::solvers::SolverFuture> vFuture; 
+        for (unsigned int i = 0; i < vModel.size(); ++i)
+        {
+            model_type& m = vModel[i]; 
+            model_type::variable_type x1 = m.addVariable(0, 1, limbo::solvers::CONTINUOUS, "x1");
+            model_type::variable_type x2 = m.addVariable(0, 1, limbo::solvers::CONTINUOUS, "x2");
+            m.setObjective(x1+x2); 
+            m.setOptimizeType(limbo::solvers::MIN);
+            m.addConstraint(x1 - x2 >= 0.1*i, "c1"); 
+            vFuture.push_back(pool.submit(&m)); 
+        }
+        for (unsigned int i = 0; i < vModel.size(); ++i)
+        {
+            optStatus = vFuture[i].get(); 
+            std::cout << "pool model " << i << ": optStatus = " << optStatus << ", objective = " << vModel[i].evaluateObjective() << std::endl; 
+        }
+    }
+
     return 0; 
 }
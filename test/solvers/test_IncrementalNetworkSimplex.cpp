@@ -0,0 +1,180 @@
+/**
+ * @file   test_IncrementalNetworkSimplex.cpp
+ * @brief  Test @ref limbo::solvers::WarmStartNetworkSimplex against lemon::NetworkSimplex,
+ *         and repeated solves of @ref limbo::solvers::DualMinCostFlow with @ref limbo::solvers::IncrementalNetworkSimplex
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <limbo/string/ToString.h>
+#include <limbo/solvers/DualMinCostFlow.h>
+
+/// @nowarn
+typedef lemon::SmartDigraph graph_type;
+typedef limbo::solvers::WarmStartNetworkSimplex<graph_type, long> warm_type;
+typedef lemon::NetworkSimplex<graph_type, long, long> lemon_type;
+typedef limbo::solvers::LinearModel<int, int> model_type;
+/// @endnowarn
+
+/// @brief check flow bounds, flow conservation and reduced costs of a solution
+/// @param g graph
+/// @param alg algorithm after an optimal run
+/// @param lower lower bounds
+/// @param upper upper bounds
+/// @param cost costs
+/// @param supply supplies
+/// @return true if the solution is optimal
+bool optimal(graph_type const& g, warm_type const& alg, graph_type::ArcMap<long> const& lower, graph_type::ArcMap<long> const& upper,
+        graph_type::ArcMap<long> const& cost, graph_type::NodeMap<long> const& supply)
+{
+    graph_type::NodeMap<long> excess (g);
+    for (graph_type::NodeIt n (g); n != lemon::INVALID; ++n)
+        excess[n] = supply[n];
+    for (graph_type::ArcIt a (g); a != lemon::INVALID; ++a)
+    {
+        long f = alg.flow(a);
+        long rc = cost[a]+alg.potential(g.source(a))-alg.potential(g.target(a));
+        if (f < lower[a] || f > upper[a] || (rc > 0 && f != lower[a]) || (rc < 0 && f != upper[a]))
+            return false;
+        excess[g.source(a)] -= f;
+        excess[g.target(a)] += f;
+    }
+    for (graph_type::NodeIt n (g); n != lemon::INVALID; ++n)
+        if (excess[n] != 0)
+            return false;
+    return true;
+}
+
+/// @brief solve random min-cost flow problems repeatedly with changing costs, supplies and bounds
+/// @return true if all results match lemon::NetworkSimplex
+bool testKernel()
+{
+    for (int i = 0; i < 30; ++i)
+    {
+        graph_type g;
+        int numNodes = 20+rand()%200;
+        for (int n = 0; n < numNodes; ++n)
+            g.addNode();
+        for (int e = 0; e < numNodes*4; ++e)
+        {
+            int s = rand()%numNodes;
+            int t = (s+1+rand()%(numNodes-1))%numNodes;
+            g.addArc(g.nodeFromId(s), g.nodeFromId(t));
+        }
+        graph_type::ArcMap<long> lower (g, 0);
+        graph_type::ArcMap<long> upper (g);
+        graph_type::ArcMap<long> cost (g);
+        graph_type::NodeMap<long> supply (g, 0);
+        for (graph_type::ArcIt a (g); a != lemon::INVALID; ++a)
+            upper[a] = (rand()%4)? 10+rand()%40 : std::numeric_limits<long>::max();
+
+        warm_type warm (g);
+        int numWarm = 0;
+        for (int round = 0; round < 6; ++round)
+        {
+            // costs change in every round, supplies and bounds in some rounds
+            for (graph_type::ArcIt a (g); a != lemon::INVALID; ++a)
+                cost[a] = rand()%60-10;
+            if (round == 0 || round == 3)
+            {
+                for (graph_type::NodeIt n (g); n != lemon::INVALID; ++n)
+                    supply[n] = 0;
+                for (int k = 0; k < numNodes/2; ++k)
+                {
+                    long amount = rand()%20;
+                    supply[g.nodeFromId(rand()%numNodes)] += amount;
+                    supply[g.nodeFromId(rand()%numNodes)] -= amount;
+                }
+            }
+            if (round == 4)
+                for (graph_type::ArcIt a (g); a != lemon::INVALID; ++a)
+                    lower[a] = (rand()%8)? 0 : rand()%5;
+
+            lemon_type ref (g);
+            lemon_type::ProblemType refStatus = ref.lowerMap(lower).upperMap(upper).costMap(cost).supplyMap(supply).run();
+            warm_type::ProblemType status = warm.resetParams().lowerMap(lower).upperMap(upper).costMap(cost).supplyMap(supply).run();
+            numWarm += warm.warmStarted();
+            if ((int)status != (int)refStatus
+                    || (status == warm_type::OPTIMAL && (warm.totalCost() != ref.totalCost() || !optimal(g, warm, lower, upper, cost, supply))))
+            {
+                std::cout << "graph " << i << " round " << round << ": status " << status << " cost " << warm.totalCost()
+                    << ", expected status " << refStatus << " cost " << ref.totalCost() << std::endl;
+                return false;
+            }
+        }
+        // only costs change in rounds 1, 2 and 5 after optimal runs
+        if (numWarm < 2)
+        {
+            std::cout << "graph " << i << ": " << numWarm << " warm starts" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief build a row of cells with spacing constraints, like detailed placement
+/// @param model model
+/// @param numCells number of cells
+void buildRow(model_type& model, int numCells)
+{
+    for (int i = 0; i < numCells; ++i)
+        model.addVariable(0, numCells*20, limbo::solvers::INTEGER, "x"+limbo::to_string(i));
+    model_type::expression_type obj;
+    for (int i = 0; i < numCells; ++i)
+    {
+        obj += (rand()%21-10)*model.variable(i);
+        if (i+1 < numCells)
+            model.addConstraint(model.variable(i+1)-model.variable(i) >= 1+rand()%10, "c"+limbo::to_string(i));
+    }
+    model.setObjective(obj);
+    model.setOptimizeType(limbo::solvers::MIN);
+}
+
+/// @brief solve rows repeatedly with changing spacing
+/// @return true if objectives match lemon::NetworkSimplex
+bool testDualMinCostFlow()
+{
+    int numCells = 20000;
+    model_type model;
+    buildRow(model, numCells);
+    limbo::solvers::DualMinCostFlow<int, int> incremental (&model);
+    limbo::solvers::IncrementalNetworkSimplex<int, int> incrementalSolver;
+    double refTime = 0;
+    double incrementalTime = 0;
+    int numWarm = 0;
+    for (int round = 0; round < 5; ++round)
+    {
+        for (unsigned int i = 0; i < model.constraints().size(); ++i)
+            model.constraints()[i].setRightHandSide(1+rand()%10);
+        model_type refModel (model);
+        limbo::solvers::DualMinCostFlow<int, int> ref (&refModel);
+        limbo::solvers::NetworkSimplex<int, int> refSolver;
+        clock_t start = clock();
+        limbo::solvers::SolverProperty refStatus = ref(&refSolver);
+        refTime += double(clock()-start)/CLOCKS_PER_SEC;
+        start = clock();
+        limbo::solvers::SolverProperty status = incremental(&incrementalSolver);
+        incrementalTime += double(clock()-start)/CLOCKS_PER_SEC;
+        numWarm += incrementalSolver.warmStarted();
+        if (status != refStatus || model.evaluateObjective() != refModel.evaluateObjective() || incremental.totalCost() != ref.totalCost())
+        {
+            std::cout << "round " << round << ": objective " << model.evaluateObjective() << ", expected " << refModel.evaluateObjective() << std::endl;
+            return false;
+        }
+    }
+    std::cout << numCells << " cells, 5 rounds: " << refTime << " s by NetworkSimplex, "
+        << incrementalTime << " s by IncrementalNetworkSimplex with " << numWarm << " warm starts" << std::endl;
+    return numWarm == 4;
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+    if (!testKernel() || !testDualMinCostFlow())
+        return 1;
+    return 0;
+}
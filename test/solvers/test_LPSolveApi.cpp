@@ -2,11 +2,24 @@
  * @file   test_LPSolveApi.cpp
  * @author Yibo Lin
  * @date   Dec 2018
- * @brief  Test LPSolve API @ref limbo::solvers::LPSolveLinearApi
+ * @brief  Test LPSolve API @ref limbo::solvers::LPSolveLinearApi and @ref limbo::solvers::LPSolveLinearSession
  */
 #include <iostream>
 #include <limbo/solvers/api/LPSolveApi.h>
 
+/// @brief print each incumbent of a solve 
+struct PrintIncumbent : public limbo::solvers::IncumbentCallback
+{
+    /// @brief print the objective 
+    /// @param objective objective of the incumbent 
+    /// @return true to continue 
+    bool operator()(std::vector<double> const& /*vSolution*/, double objective)
+    {
+        std::cout << "incumbent objective = " << objective << std::endl; 
+        return true; 
+    }
+};
+
 /// @brief main function 
 /// 
 /// Solve following problem, 
@@ -49,5 +62,48 @@ int main()
 
     std::cout << "optStatus = " << optStatus << std::endl; 
 
+    // re-solve modified models in a session 
+    {
+        typedef limbo::solvers::LPSolveLinearSession<model_type::coefficient_value_type, model_type::variable_value_type> session_type; 
+        session_type session (&optModel, &lpsolveParams); 
+        // x3 >= 0.1 becomes a bound, the optimal objective rises from 1 to 1.4 
+        session.addConstraint(var3 >= 0.1, "c4"); 
+        optStatus = session(); 
+        std::cout << "add bound: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+        // x4 costs 2, the optimal objective is 1.6 
+        session.setObjectiveCoefficient(var4, 2); 
+        optStatus = session(); 
+        std::cout << "change objective: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+        // x4 - x3 >= 0.1 removed, x4 = 0 and the optimal objective is 1.2 
+        session.removeConstraints(std::vector<unsigned int>(1, 1)); 
+        session.setVariableBounds(var1, 0, 0.9); 
+        optStatus = session(); 
+        std::cout << "remove constraint: optStatus = " << optStatus << ", objective = " << optModel.evaluateObjective() << std::endl; 
+    }
+
+    // anytime solve of a knapsack, stopped at the first improved solution 
+    {
+        model_type knapsackModel; 
+        model_type::expression_type obj; 
+        model_type::expression_type weight; 
+        for (int i = 0; i < 30; ++i)
+        {
+            model_type::variable_type var = knapsackModel.addVariable(0, 1, limbo::solvers::BINARY); 
+            obj += (10+i*7%13)*var; 
+            weight += (5+i*11%17)*var; 
+        }
+        knapsackModel.setObjective(obj); 
+        knapsackModel.setOptimizeType(limbo::solvers::MAX); 
+        knapsackModel.addConstraint(weight <= 100, "capacity"); 
+        solver_type knapsackSolver (&knapsackModel); 
+        limbo::solvers::LPSolveParameters controlParams; 
+        PrintIncumbent callback; 
+        controlParams.setTimeLimit(10); 
+        controlParams.setSolutionLimit(1); 
+        controlParams.setIncumbentCallback(&callback); 
+        optStatus = knapsackSolver(&controlParams); 
+        std::cout << "solution limit: optStatus = " << optStatus << ", objective = " << knapsackModel.evaluateObjective() << std::endl; 
+    }
+
     return 0; 
 }
@@ -0,0 +1,153 @@
+/**
+ * @file   test_LagrangianRelaxation.cpp
+ * @date   Oct 2026
+ * @brief  test @ref limbo::solvers::LagrangianRelaxation with assignment and min-cost flow oracles
+ */
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <limbo/solvers/LagrangianFlowOracle.h>
+
+/// @brief model type
+typedef limbo::solvers::LinearModel<double, int> model_type;
+
+/// @brief check the relaxed solution against all constraints of the model
+/// @param optModel model
+/// @return true if all constraints are satisfied
+bool feasible(model_type const& optModel)
+{
+    std::vector<int> const& vSolution = optModel.variableSolutions();
+    for (std::vector<model_type::constraint_type>::const_iterator it = optModel.constraints().begin(), ite = optModel.constraints().end(); it != ite; ++it)
+    {
+        double lhs = 0;
+        for (std::vector<model_type::term_type>::const_iterator itt = it->expression().terms().begin(), itte = it->expression().terms().end(); itt != itte; ++itt)
+            lhs += itt->coefficient()*vSolution[itt->variable().id()];
+        if ((it->sense() != '>' && lhs > it->rightHandSide()+1e-6) || (it->sense() != '<' && lhs < it->rightHandSide()-1e-6))
+            return false;
+    }
+    return true;
+}
+
+/// @brief report a solve and check its solution and bounds
+/// @param name name of the test
+/// @param optModel model
+/// @param solver lagrangian relaxation
+/// @param status solving status
+/// @return true if the solution is feasible and the lower bound does not exceed its objective
+bool check(std::string const& name, model_type const& optModel, limbo::solvers::LagrangianRelaxation<double, int> const& solver, limbo::solvers::SolverProperty status)
+{
+    double obj = const_cast<model_type&>(optModel).evaluateObjective();
+    std::cout << name << ": " << limbo::solvers::toString(status) << " in " << solver.numIterations() << " iterations, objective = " << obj
+        << ", lower bound = " << solver.lowerBound() << "\n";
+    if ((status != limbo::solvers::OPTIMAL && status != limbo::solvers::SUBOPTIMAL) || !feasible(optModel))
+    {
+        std::cout << "solution is infeasible\n";
+        return false;
+    }
+    if (std::abs(obj-solver.bestObjective()) > 1e-6*std::max(1.0, std::abs(obj)) || solver.lowerBound() > obj+1e-6*std::max(1.0, std::abs(obj)))
+    {
+        std::cout << "lower bound or best objective is inconsistent\n";
+        return false;
+    }
+    return true;
+}
+
+/// @brief generalized assignment of jobs to machines with capacities relaxed
+/// @param numJobs number of jobs
+/// @param numMachines number of machines
+/// @return true if succeed
+bool testAssignment(unsigned int numJobs, unsigned int numMachines)
+{
+    model_type optModel;
+    std::vector<model_type::expression_type> vMachineExpr (numMachines);
+    std::vector<double> vMachineLoad (numMachines, 0);
+    model_type::expression_type obj;
+    for (unsigned int i = 0; i < numJobs; ++i)
+    {
+        model_type::expression_type jobExpr;
+        for (unsigned int j = 0; j < numMachines; ++j)
+        {
+            double load = 1+rand()%10;
+            model_type::variable_type var = optModel.addVariable(0, 1, limbo::solvers::INTEGER);
+            jobExpr += var*1.0;
+            vMachineExpr[j] += load*var;
+            vMachineLoad[j] += load;
+            // cheap machines take heavy loads, so capacities are tight
+            obj += (11-load+rand()%100*0.01)*var;
+        }
+        optModel.addConstraint(jobExpr == 1);
+    }
+    limbo::solvers::LagrangianRelaxation<double, int> solver (&optModel);
+    for (unsigned int j = 0; j < numMachines; ++j)
+    {
+        solver.relaxConstraint(optModel.constraints().size());
+        optModel.addConstraint(vMachineExpr[j] <= vMachineLoad[j]/numMachines*1.2);
+    }
+    optModel.setObjective(obj);
+
+    limbo::solvers::AssignmentOracle<double, int> oracle;
+    limbo::solvers::DeflectedSubGradient<double> updater;
+    solver.setMaxIterations(500);
+    solver.setNumThreads(4);
+    limbo::solvers::SolverProperty status = solver(&oracle, &updater);
+    return check("generalized assignment", optModel, solver, status);
+}
+
+/// @brief resource constrained shortest path on a grid with the resource relaxed
+/// @param n number of rows and columns of the grid
+/// @return true if succeed
+bool testShortestPath(unsigned int n)
+{
+    model_type optModel;
+    std::vector<model_type::expression_type> vNodeExpr (n*n);
+    model_type::expression_type resourceExpr;
+    model_type::expression_type obj;
+    double totalResource = 0;
+    for (unsigned int i = 0; i < n*n; ++i)
+    {
+        // arcs to the right and to the bottom
+        unsigned int vTarget[2] = {(i%n+1 < n)? i+1 : i, (i/n+1 < n)? i+n : i};
+        for (unsigned int k = 0; k < 2; ++k)
+        {
+            if (vTarget[k] == i)
+                continue;
+            model_type::variable_type var = optModel.addVariable(0, 1, limbo::solvers::INTEGER);
+            vNodeExpr[i] += var*1.0;
+            vNodeExpr[vTarget[k]] -= var*1.0;
+            double cost = 1+rand()%10;
+            double resource = 11-cost+rand()%3;
+            obj += cost*var;
+            resourceExpr += resource*var;
+            totalResource += resource;
+        }
+    }
+    for (unsigned int i = 0; i < n*n; ++i)
+        optModel.addConstraint(vNodeExpr[i] == ((i == 0)? 1 : (i+1 == n*n)? -1 : 0));
+    limbo::solvers::LagrangianRelaxation<double, int> solver (&optModel);
+    solver.relaxConstraint(optModel.constraints().size());
+    // about the resource of a path with average arcs
+    optModel.addConstraint(resourceExpr <= totalResource/optModel.numVariables()*(2*n-2));
+    optModel.setObjective(obj);
+
+    limbo::solvers::MinCostFlowOracle<double, int> oracle;
+    limbo::solvers::PolyakStep<double> updater;
+    solver.setMaxIterations(200);
+    limbo::solvers::SolverProperty status = solver(&oracle, &updater);
+    if (!check("resource constrained shortest path", optModel, solver, status))
+        return false;
+    // the second solve starts again on the same oracle
+    status = solver(&oracle, &updater);
+    return check("resource constrained shortest path, solved again", optModel, solver, status);
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+    if (!testAssignment(1000, 10))
+        return 1;
+    if (!testShortestPath(30))
+        return 1;
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file   test_LowRankSdp.cpp
+ * @brief  test @ref limbo::solvers::LowRankSdp on graphs with known SDP optimum
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <limbo/solvers/LowRankSdp.h>
+
+/// @nowarn
+typedef limbo::solvers::LowRankSdp<double> solver_type;
+/// @endnowarn
+
+/// graph with a planted 3-coloring, conflict edges only join vertices of different colors,
+/// so the optimum is -0.5 per edge with \f$x_{ij} \ge -0.5\f$
+/// @param sdp solver
+/// @param n number of vertices
+/// @param m number of edges tried
+/// @return number of edges
+uint32_t planted(solver_type& sdp, uint32_t n, uint32_t m)
+{
+    std::vector<int> vColor (n);
+    for (uint32_t i = 0; i < n; ++i)
+        vColor[i] = rand()%3;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < m; ++i)
+    {
+        uint32_t s = rand()%n;
+        uint32_t t = rand()%n;
+        if (vColor[s] != vColor[t])
+        {
+            sdp.add_term(s, t, 1, -0.5);
+            ++count;
+        }
+    }
+    return count;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+
+    // K4 with 4 colors, all entries are -1/3
+    solver_type k4 (4);
+    for (uint32_t i = 0; i < 4; ++i)
+        for (uint32_t j = i+1; j < 4; ++j)
+            k4.add_term(i, j, 1, -1.0/3);
+    double f = k4();
+    std::cout << "K4 objective " << f << ", violation " << k4.max_violation() << std::endl;
+    if (std::abs(f+2) > 1e-2 || k4.max_violation() > 1e-3)
+        return 1;
+
+    uint32_t n = 3000;
+    solver_type sdp (n);
+    uint32_t m = planted(sdp, n, n*4);
+    sdp.threads(1);
+    f = sdp();
+    std::cout << "planted objective " << f << ", optimum " << -0.5*m << ", violation " << sdp.max_violation()
+        << ", " << sdp.iterations() << " iterations with rank " << sdp.dimension() << std::endl;
+    if (std::abs(f+0.5*m) > 1e-3*m || sdp.max_violation() > 1e-3)
+        return 1;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        if (std::abs(sdp.inner(i, i)-1) > 1e-6)
+        {
+            std::cout << "row " << i << " is not a unit vector" << std::endl;
+            return 1;
+        }
+    }
+
+    // threads do not change the solution
+    srand(1);
+    solver_type psdp (n);
+    planted(psdp, n, n*4);
+    psdp.threads(4);
+    psdp();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        for (uint32_t k = 0; k < sdp.dimension(); ++k)
+        {
+            if (sdp.vector(i)[k] != psdp.vector(i)[k])
+            {
+                std::cout << "row " << i << " differs with 4 threads" << std::endl;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
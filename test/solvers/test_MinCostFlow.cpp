@@ -10,7 +10,7 @@
 
 /// @brief test file API 
 /// @param filename input lp file 
-/// @param alg algorithm type, 0 for cost scaling, 1 for capacity scaling, 2 for network simplex, 3 for cycle canceling 
+/// @param alg algorithm type, 0 for cost scaling, 1 for capacity scaling, 2 for network simplex, 3 for cycle canceling, 4 for incremental network simplex 
 void test(std::string const& filename, int alg)
 {
     typedef limbo::solvers::LinearModel<double, int> model_type; 
@@ -33,6 +33,9 @@ void test(std::string const& filename, int alg)
         case 2:
             minCostFlowSolver = new limbo::solvers::NetworkSimplex<double, int>(); 
             break;
+        case 4:
+            minCostFlowSolver = new limbo::solvers::IncrementalNetworkSimplex<double, int>(); 
+            break;
         case 3:
         default:
             minCostFlowSolver = new limbo::solvers::CycleCanceling<double, int>(); 
@@ -5,7 +5,10 @@
  * @brief  test @ref limbo::solvers::MultiKnapsackLagRelax algorithm 
  */
 #include <iostream>
-#include <limbo/solvers/MultiKnapsackLagRelax.h>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <limbo/solvers/MultiKnapsackFlowRepair.h>
 
 
 /// @brief test file API 
@@ -31,17 +34,290 @@ void test(std::string const& filename)
     optModel.print(std::cout); 
 }
 
+/// @brief generate a random problem of items assigned to bins 
+/// @param optModel model 
+/// @param numItems number of items 
+/// @param numBins number of bins 
+/// @param numCandidates number of candidate bins of each item 
+/// @param ratio ratio of capacity to the average area of items in a bin 
+void randomProblem(limbo::solvers::LinearModel<float, int>& optModel, unsigned int numItems, unsigned int numBins, unsigned int numCandidates, float ratio)
+{
+    typedef limbo::solvers::LinearModel<float, int> model_type; 
+    std::vector<model_type::expression_type> vBinExpr (numBins); 
+    std::vector<float> vBinArea (numBins, 0); 
+    model_type::expression_type obj; 
+    for (unsigned int i = 0; i < numItems; ++i)
+    {
+        float area = 1+rand()%10; 
+        unsigned int bin = rand()%numBins; 
+        model_type::expression_type itemExpr; 
+        for (unsigned int j = 0; j < numCandidates; ++j, bin = (bin+1+rand()%3)%numBins)
+        {
+            model_type::variable_type var = optModel.addVariable(0, 1, limbo::solvers::INTEGER); 
+            itemExpr += var*1.0f; 
+            vBinExpr[bin] += area*var; 
+            vBinArea[bin] += area; 
+            obj += (j+rand()%500*0.01f)*var; 
+        }
+        optModel.addConstraint(itemExpr == 1); 
+    }
+    // capacities are tight, so that multipliers are needed 
+    for (unsigned int j = 0; j < numBins; ++j)
+        if (vBinExpr[j].terms().size() > 1)
+            optModel.addConstraint(vBinExpr[j] <= vBinArea[j]/numCandidates*ratio); 
+    optModel.setObjective(obj); 
+}
+
+/// @brief test threads and incremental updates on random problems. 
+/// Solutions must not depend on the number of threads. 
+/// Incremental updates round differently, so only objectives are compared. 
+/// @return true if succeed 
+bool testModes()
+{
+    typedef limbo::solvers::LinearModel<float, int> model_type; 
+    for (unsigned int numItems = 1000; numItems <= 100000; numItems *= 100)
+    {
+        std::vector<int> vSolution; 
+        float fullObj = 0; 
+        for (unsigned int mode = 0; mode < 4; ++mode)
+        {
+            unsigned int threads = (mode%2)? 4 : 1; 
+            bool incremental = (mode >= 2); 
+            model_type optModel; 
+            srand(numItems); 
+            randomProblem(optModel, numItems, numItems/100, 4, 1.25); 
+
+            limbo::solvers::MultiKnapsackLagRelax<float, int> solver (&optModel);
+            solver.setMaxIterations(100); 
+            solver.setLagObjFlag(true); 
+            solver.setNumThreads(threads); 
+            solver.setIncremental(incremental); 
+            clock_t start = clock(); 
+            limbo::solvers::SolverProperty status = solver();
+            double t = double(clock()-start)/CLOCKS_PER_SEC; 
+            std::cout << numItems << " items with " << threads << " threads" << (incremental? ", incremental" : "") << ": " 
+                << limbo::solvers::toString(status) << ", objective = " << optModel.evaluateObjective() << " in " << t << " s\n";
+            if (threads > 1 && vSolution != optModel.variableSolutions())
+            {
+                std::cout << "solutions depend on threads\n"; 
+                return false; 
+            }
+            vSolution = optModel.variableSolutions(); 
+            if (!incremental)
+                fullObj = optModel.evaluateObjective(); 
+            else if (std::abs(optModel.evaluateObjective()-fullObj) > fullObj*0.01)
+            {
+                std::cout << "objective of incremental updates is far from " << fullObj << "\n"; 
+                return false; 
+            }
+        }
+    }
+    return true; 
+}
+
+/// @brief test warm start on a problem solved again with perturbed costs, 
+/// like the outer iterations of a placer 
+/// @return true if succeed 
+bool testWarmStart()
+{
+    typedef limbo::solvers::LinearModel<float, int> model_type; 
+    srand(2); 
+    model_type optModel; 
+    randomProblem(optModel, 100000, 1000, 4, 1.3); 
+    limbo::solvers::MultiKnapsackLagRelax<float, int> solver (&optModel);
+    solver.setMaxIterations(100); 
+    solver.setWarmStart(true); 
+    solver(); 
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        // perturb costs 
+        model_type::expression_type obj; 
+        for (std::vector<model_type::term_type>::const_iterator it = optModel.objective().terms().begin(), ite = optModel.objective().terms().end(); it != ite; ++it)
+            obj += model_type::term_type(it->variable(), it->coefficient()*(1+(rand()%5-2)*0.01f)); 
+        optModel.setObjective(obj); 
+        model_type coldModel (optModel); 
+
+        clock_t start = clock(); 
+        limbo::solvers::SolverProperty status = solver();
+        double warmTime = double(clock()-start)/CLOCKS_PER_SEC; 
+        limbo::solvers::MultiKnapsackLagRelax<float, int> coldSolver (&coldModel);
+        coldSolver.setMaxIterations(100); 
+        start = clock(); 
+        limbo::solvers::SolverProperty coldStatus = coldSolver();
+        double coldTime = double(clock()-start)/CLOCKS_PER_SEC; 
+        std::cout << "perturbation " << i << ": warm start " << limbo::solvers::toString(status) << ", objective = " << optModel.evaluateObjective() << " in " << warmTime << " s, " 
+            << "cold start " << limbo::solvers::toString(coldStatus) << ", objective = " << coldModel.evaluateObjective() << " in " << coldTime << " s\n";
+        if (std::abs(optModel.evaluateObjective()-coldModel.evaluateObjective()) > coldModel.evaluateObjective()*0.01)
+        {
+            std::cout << "objective of warm start is far from cold start\n"; 
+            return false; 
+        }
+    }
+    return true; 
+}
+
+/// @brief compare multiplier updaters by their convergence on a random problem 
+/// @return true if succeed 
+bool testUpdaters()
+{
+    typedef limbo::solvers::LinearModel<float, int> model_type; 
+    typedef limbo::solvers::MultiKnapsackLagRelax<float, int> solver_type; 
+    limbo::solvers::SubGradientDescent<float> subgradient; 
+    limbo::solvers::PolyakStep<float> polyak; 
+    limbo::solvers::DeflectedSubGradient<float> deflected; 
+    limbo::solvers::ProximalBundle<float> bundle; 
+    limbo::solvers::LagMultiplierUpdater<float>* vUpdater[] = {&subgradient, &polyak, &deflected, &bundle}; 
+    char const* vName[] = {"subgradient", "Polyak", "deflected subgradient", "proximal bundle"}; 
+    for (unsigned int u = 0; u < 4; ++u)
+    {
+        srand(3); 
+        model_type optModel; 
+        randomProblem(optModel, 20000, 200, 4, 1.1); 
+        solver_type solver (&optModel); 
+        solver.setMaxIterations(200); 
+        solver.setLagObjFlag(true); 
+        limbo::solvers::SolverProperty status = solver(vUpdater[u]); 
+
+        std::vector<solver_type::ConvergenceRecord> const& vRecord = solver.convergenceHistory(); 
+        unsigned int firstFeasible = std::numeric_limits<unsigned int>::max(); 
+        float bestLagObj = -std::numeric_limits<float>::max(); 
+        // later iterations run by the searcher change costs, so they do not give bounds 
+        for (unsigned int i = 0; i < vRecord.size() && vRecord[i].iter < solver.maxIterations(); ++i)
+        {
+            if (vRecord[i].numNegativeSlacks == 0 && firstFeasible == std::numeric_limits<unsigned int>::max())
+                firstFeasible = vRecord[i].iter; 
+            bestLagObj = std::max(bestLagObj, vRecord[i].lagObj); 
+            // weak duality 
+            if (vRecord[i].lagObj > vRecord[i].bestObj*1.0001f+1e-3f)
+            {
+                std::cout << vName[u] << ": lower bound " << vRecord[i].lagObj << " above feasible objective " << vRecord[i].bestObj << "\n"; 
+                return false; 
+            }
+        }
+        if (vRecord.empty())
+            return false; 
+        std::cout << vName[u] << ": " << limbo::solvers::toString(status) << ", objective = " << optModel.evaluateObjective() 
+            << ", lower bound = " << bestLagObj << " from " << vRecord.front().lagObj << " at iteration 0, " 
+            << "first feasible iteration = " << (int)firstFeasible << ", " << vRecord.size() << " iterations\n";
+    }
+    return true; 
+}
+
+/// @brief check all constraints of a model 
+/// @param optModel model with solutions 
+/// @return number of violated constraints 
+unsigned int countViolations(limbo::solvers::LinearModel<float, int> const& optModel)
+{
+    unsigned int count = 0; 
+    for (unsigned int i = 0; i < optModel.constraints().size(); ++i)
+    {
+        float slack = optModel.evaluateConstraint(optModel.constraints()[i]); 
+        if (slack < -1e-3f || (optModel.constraints()[i].sense() == '=' && slack > 1e-3f))
+            ++count; 
+    }
+    return count; 
+}
+
+/// @brief compare feasible searchers on tight problems stopped before the multipliers converge. 
+/// Repairs by parallel reassignment must not depend on the number of threads. 
+/// @return true if succeed 
+bool testSearchers()
+{
+    typedef limbo::solvers::LinearModel<float, int> model_type; 
+    typedef limbo::solvers::MultiKnapsackLagRelax<float, int> solver_type; 
+    char const* vName[] = {"adjust coefficient", "parallel reassignment", "parallel reassignment", "min-cost flow"}; 
+    for (unsigned int numItems = 10000; numItems <= 100000; numItems *= 10)
+    {
+        std::vector<int> vSolution; 
+        for (unsigned int s = 0; s < 4; ++s)
+        {
+            unsigned int threads = (s == 2)? 4 : 1; 
+            srand(numItems+4); 
+            model_type optModel; 
+            randomProblem(optModel, numItems, numItems/100, 4, 1.15); 
+            solver_type solver (&optModel); 
+            solver.setMaxIterations(5); 
+            solver.setNumThreads(threads); 
+            limbo::solvers::SearchByAdjustCoefficient<float, int> coeff (&solver); 
+            limbo::solvers::SearchByParallelReassignment<float, int> reassignment (&solver); 
+            limbo::solvers::SearchByMinCostFlow<float, int> flow (&solver); 
+            limbo::solvers::FeasibleSearcher<float, int>* vSearcher[] = {&coeff, &reassignment, &reassignment, &flow}; 
+            clock_t start = clock(); 
+            limbo::solvers::SolverProperty status = solver(NULL, NULL, vSearcher[s]); 
+            double t = double(clock()-start)/CLOCKS_PER_SEC; 
+            std::cout << numItems << " items by " << vName[s] << " with " << threads << " threads: " 
+                << limbo::solvers::toString(status) << ", objective = " << optModel.evaluateObjective() << ", " << countViolations(optModel) << " violations in " << t << " s\n"; 
+            // the default searcher gives up within few iterations, while repairs are expected to succeed 
+            if ((status != limbo::solvers::INFEASIBLE && countViolations(optModel)) || (s > 0 && status == limbo::solvers::INFEASIBLE))
+            {
+                std::cout << "solution is not feasible\n"; 
+                return false; 
+            }
+            if (s == 2 && vSolution != optModel.variableSolutions())
+            {
+                std::cout << "solutions depend on threads\n"; 
+                return false; 
+            }
+            vSolution = optModel.variableSolutions(); 
+        }
+    }
+    return true; 
+}
+
+/// @brief compare scalers with threads on a random problem. 
+/// Constraints must be restored after solving. 
+/// @return true if succeed 
+bool testScalers()
+{
+    typedef limbo::solvers::LinearModel<float, int> model_type; 
+    limbo::solvers::L2NormScaler<float, int> l2norm; 
+    limbo::solvers::RuizScaler<float, int> ruiz; 
+    limbo::solvers::ProblemScaler<float, int>* vScaler[] = {&l2norm, &l2norm, &ruiz, &ruiz}; 
+    char const* vName[] = {"L2 norm", "L2 norm", "Ruiz", "Ruiz"}; 
+    for (unsigned int s = 0; s < 4; ++s)
+    {
+        unsigned int threads = (s%2)? 4 : 1; 
+        srand(5); 
+        model_type optModel; 
+        randomProblem(optModel, 100000, 1000, 4, 1.3); 
+        model_type origModel (optModel); 
+        limbo::solvers::MultiKnapsackLagRelax<float, int> solver (&optModel);
+        solver.setMaxIterations(100); 
+        solver.setNumThreads(threads); 
+        clock_t start = clock(); 
+        limbo::solvers::SolverProperty status = solver(NULL, vScaler[s]); 
+        double t = double(clock()-start)/CLOCKS_PER_SEC; 
+        std::cout << vName[s] << " scaler with " << threads << " threads: " << limbo::solvers::toString(status) 
+            << ", objective = " << optModel.evaluateObjective() << ", " << countViolations(optModel) << " violations in " << t << " s\n"; 
+        if (status != limbo::solvers::INFEASIBLE && countViolations(optModel))
+            return false; 
+        for (unsigned int i = 0; i < optModel.constraints().size(); ++i)
+        {
+            float rhs = origModel.constraints()[i].rightHandSide(); 
+            if (std::abs(optModel.constraints()[i].rightHandSide()-rhs) > 1e-4f*std::max(1.0f, std::abs(rhs)))
+            {
+                std::cout << "constraint " << i << " is not restored\n"; 
+                return false; 
+            }
+        }
+    }
+    return true; 
+}
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments
 int main(int argc, char** argv)
 {
+    // allow threads beyond the number of processors 
+    limbo::containers::set_num_threads(4); 
     if (argc > 1)
     {
         // test file API 
         test(argv[1]);
     }
-    else std::cout << "at least one argument is required\n";
+    else if (!testModes() || !testWarmStart() || !testUpdaters() || !testSearchers() || !testScalers())
+        return 1; 
 
     return 0; 
 }
@@ -0,0 +1,265 @@
+/**
+ * @file   test_Numerical.cpp
+ * @brief  Test the parallel kernels of @ref Numerical.h against plain loops with different numbers of threads
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <unistd.h>
+#include <limbo/solvers/Numerical.h>
+
+/// @nowarn
+typedef limbo::solvers::MatrixCSR<double, int, 1> matrix_type;
+template <>
+matrix_type::index_type matrix_type::s_startingIndex = 1;
+/// @endnowarn
+
+/// @brief maximum difference of two vectors
+/// @param x vector
+/// @param y vector
+/// @return maximum absolute difference
+double maxDiff(std::vector<double> const& x, std::vector<double> const& y)
+{
+    double diff = 0;
+    for (unsigned int i = 0; i < x.size(); ++i)
+        diff = std::max(diff, std::fabs(x[i]-y[i]));
+    return diff;
+}
+
+/// @brief compare kernels on a random matrix
+/// @param numRows number of rows
+/// @param numColumns number of columns
+/// @param rowSize number of non-zero elements in a row
+/// @return true if the results match plain loops
+bool test(int numRows, int numColumns, int rowSize)
+{
+    matrix_type A;
+    A.initialize(numRows, numColumns, numRows*rowSize);
+    A.vRowBeginIndex[0] = matrix_type::s_startingIndex;
+    for (int i = 0; i < numRows; ++i)
+    {
+        for (int k = i*rowSize; k < (i+1)*rowSize; ++k)
+        {
+            A.vElement[k] = (rand()%100)/10.0;
+            A.vColumn[k] = rand()%numColumns+matrix_type::s_startingIndex;
+        }
+        A.vRowBeginIndex[i+1] = A.vRowBeginIndex[i]+rowSize;
+    }
+    std::vector<double> x (numColumns);
+    std::vector<double> xT (numRows);
+    for (int j = 0; j < numColumns; ++j)
+        x[j] = rand()%10;
+    for (int i = 0; i < numRows; ++i)
+        xT[i] = rand()%10;
+
+    // y = 2 A x + 1, z = 2 A^T xT + 1, w = 3 xT + 1 
+    std::vector<double> yRef (numRows, 1);
+    std::vector<double> zRef (numColumns, 1);
+    std::vector<double> wRef (numRows, 1);
+    double dotRef = 0;
+    for (int i = 0; i < numRows; ++i)
+    {
+        for (int k = i*rowSize; k < (i+1)*rowSize; ++k)
+        {
+            yRef[i] += 2*A.vElement[k]*x[A.vColumn[k]-1];
+            zRef[A.vColumn[k]-1] += 2*A.vElement[k]*xT[i];
+        }
+        wRef[i] += 3*xT[i];
+        dotRef += xT[i]*xT[i];
+    }
+
+    for (unsigned int numThreads = 1; numThreads <= 4; numThreads *= 2)
+    {
+        std::vector<double> y (numRows, 1);
+        std::vector<double> z (numColumns, 1);
+        std::vector<double> w (numRows, 1);
+        clock_t start = clock();
+        limbo::solvers::AxPlusy(2.0, A, &x[0], &y[0], numThreads);
+        limbo::solvers::ATxPlusy(2.0, A, &xT[0], &z[0], numThreads);
+        double spmvTime = double(clock()-start)/CLOCKS_PER_SEC;
+        limbo::solvers::axpy(numRows, 3.0, &xT[0], &w[0], numThreads);
+        double d = limbo::solvers::dot(numRows, &xT[0], &xT[0], numThreads);
+        // values are integers scaled by 0.1, so only rounding differs
+        double tol = 1e-9*rowSize*numRows;
+        if (maxDiff(y, yRef) > tol || maxDiff(z, zRef) > tol || maxDiff(w, wRef) > 0 || std::fabs(d-dotRef) > 0)
+        {
+            std::cout << numRows << "x" << numColumns << " with " << numThreads << " threads: results differ" << std::endl;
+            return false;
+        }
+        std::cout << numRows << "x" << numColumns << " with " << numThreads << " threads: Ax and A^T x in " << spmvTime << " s" << std::endl;
+    }
+    return true;
+}
+
+/// @brief compare float and mixed precision kernels with double on a random matrix. 
+/// Elements are multiples of 1/8, exact in float, so mixed precision matches double up to rounding of sums, 
+/// and float vectors lose only the rounding of the results with double accumulators. 
+/// @param numRows number of rows
+/// @param numColumns number of columns
+/// @param rowSize number of non-zero elements in a row
+/// @return true if the results are within tolerances
+bool testPrecision(int numRows, int numColumns, int rowSize)
+{
+    typedef limbo::solvers::MatrixCSR<float, int, 1> float_matrix_type; 
+    matrix_type A;
+    float_matrix_type Af; 
+    A.initialize(numRows, numColumns, numRows*rowSize);
+    Af.initialize(numRows, numColumns, numRows*rowSize);
+    A.vRowBeginIndex[0] = Af.vRowBeginIndex[0] = 1;
+    for (int i = 0; i < numRows; ++i)
+    {
+        for (int k = i*rowSize; k < (i+1)*rowSize; ++k)
+        {
+            A.vElement[k] = Af.vElement[k] = (rand()%100)/8.0f;
+            A.vColumn[k] = Af.vColumn[k] = rand()%numColumns+1;
+        }
+        A.vRowBeginIndex[i+1] = Af.vRowBeginIndex[i+1] = A.vRowBeginIndex[i]+rowSize;
+    }
+    std::vector<double> x (numColumns);
+    std::vector<float> xf (numColumns);
+    for (int j = 0; j < numColumns; ++j)
+        xf[j] = x[j] = rand()/(RAND_MAX+1.0f);
+
+    std::vector<double> yRef (numRows, 0);
+    clock_t start = clock();
+    limbo::solvers::AxPlusy(1.0, A, &x[0], &yRef[0]);
+    double doubleTime = double(clock()-start)/CLOCKS_PER_SEC;
+    double dotRef = limbo::solvers::dot(numColumns, &x[0], &x[0]);
+
+    // float matrix with double vectors 
+    std::vector<double> yMixed (numRows, 0);
+    start = clock();
+    limbo::solvers::AxPlusy(1.0, Af, &x[0], &yMixed[0]);
+    double mixedTime = double(clock()-start)/CLOCKS_PER_SEC;
+    // float matrix and vectors 
+    std::vector<float> yf (numRows, 0);
+    start = clock();
+    limbo::solvers::AxPlusy(1.0f, Af, &xf[0], &yf[0]);
+    double floatTime = double(clock()-start)/CLOCKS_PER_SEC;
+    float df = limbo::solvers::dot(numColumns, &xf[0], &xf[0]);
+
+    double mixedError = 0; 
+    double floatError = 0; 
+    for (int i = 0; i < numRows; ++i)
+    {
+        mixedError = std::max(mixedError, std::fabs(yMixed[i]-yRef[i])/(std::fabs(yRef[i])+1));
+        floatError = std::max(floatError, std::fabs(yf[i]-yRef[i])/(std::fabs(yRef[i])+1));
+    }
+    double dotError = std::fabs(df-dotRef)/dotRef;
+    std::cout << numRows << "x" << numColumns << ": Ax in " << doubleTime << " s with double, " << mixedTime << " s with a float matrix, " << floatTime << " s with float, " 
+        << "relative errors " << mixedError << ", " << floatError << ", dot " << dotError << std::endl;
+    if (mixedError > 1e-12 || floatError > 1e-6 || dotError > 1e-6)
+    {
+        std::cout << "float results differ" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// @brief run kernels in a @ref limbo::solvers::NumericalTeam and with threads created for each kernel. 
+/// Both pull the same blocks, so results must be identical. 
+/// @param n dimension of vectors 
+/// @param numIters number of repeated kernels, like iterations of a solver 
+/// @return true if the results are identical 
+bool testTeam(unsigned int n, unsigned int numIters)
+{
+    matrix_type A;
+    A.initialize(n, n, n*4);
+    A.vRowBeginIndex[0] = matrix_type::s_startingIndex;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        for (unsigned int k = i*4; k < (i+1)*4; ++k)
+        {
+            A.vElement[k] = (rand()%100)/10.0;
+            A.vColumn[k] = rand()%n+matrix_type::s_startingIndex;
+        }
+        A.vRowBeginIndex[i+1] = A.vRowBeginIndex[i]+4;
+    }
+    std::vector<double> x0 (n);
+    for (unsigned int i = 0; i < n; ++i)
+        x0[i] = (rand()%1000)/1000.0;
+
+    std::vector<double> vResult[2];
+    double vTime[2];
+    for (unsigned int t = 0; t < 2; ++t)
+    {
+        limbo::solvers::NumericalTeam team ((t == 1)? 4 : 1);
+        limbo::solvers::NumericalTeam::Scope scope ((t == 1)? &team : NULL);
+        std::vector<double> x (x0);
+        std::vector<double> y (n, 1);
+        std::vector<double> z (n, 0);
+        clock_t start = clock();
+        for (unsigned int iter = 0; iter < numIters; ++iter)
+        {
+            limbo::solvers::AxPlusy(1e-3, A, &x[0], &y[0], 4);
+            limbo::solvers::ATxPlusy(1e-3, A, &y[0], &z[0], 4);
+            limbo::solvers::axpy(n, limbo::solvers::dot(n, &y[0], &z[0], 4)*1e-9, &z[0], &x[0], 4);
+        }
+        vTime[t] = double(clock()-start)/CLOCKS_PER_SEC;
+        vResult[t] = x;
+        vResult[t].insert(vResult[t].end(), z.begin(), z.end());
+    }
+    std::cout << numIters << " iterations of length " << n << ": new threads " << vTime[0] << " s, team " << vTime[1] << " s" << std::endl;
+    if (vResult[0] != vResult[1])
+    {
+        std::cout << "results of the team differ" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// @brief block that records the number of blocks running at the same time
+struct ConcurrencyKernel
+{
+    unsigned int* pRunning; ///< number of blocks running
+    unsigned int* pMaxRunning; ///< maximum number of blocks running at the same time
+    /// @brief stay a while in the block
+    void operator()(std::size_t, std::size_t) const
+    {
+        unsigned int running = __sync_add_and_fetch(pRunning, 1);
+        unsigned int maxRunning = *pMaxRunning;
+        while (running > maxRunning && !__sync_bool_compare_and_swap(pMaxRunning, maxRunning, running))
+            maxRunning = *pMaxRunning;
+        usleep(200);
+        __sync_sub_and_fetch(pRunning, 1);
+    }
+};
+
+/// @brief kernels in a @ref limbo::solvers::NumericalTeam must run on no more threads than they ask for
+/// @return true if the limits are kept
+bool testTeamLimit()
+{
+    // the team is capped by the thread budget, which may be a single processor
+    limbo::containers::set_num_threads(4);
+    limbo::solvers::NumericalTeam team (4);
+    limbo::solvers::NumericalTeam::Scope scope (&team);
+    for (unsigned int numThreads = 1; numThreads <= 4; ++numThreads)
+    {
+        unsigned int running = 0;
+        unsigned int maxRunning = 0;
+        ConcurrencyKernel kernel = {&running, &maxRunning};
+        limbo::solvers::runNumericalKernel(kernel, 64, 1, numThreads);
+        std::cout << "team of " << team.size() << " threads, kernel of " << numThreads << " threads: " << maxRunning << " blocks at the same time" << std::endl;
+        if (maxRunning > numThreads)
+        {
+            std::cout << "team exceeds the threads of the kernel" << std::endl;
+            limbo::containers::set_num_threads(0);
+            return false;
+        }
+    }
+    limbo::containers::set_num_threads(0);
+    return true;
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+    if (!test(1000, 10, 3) || !test(3000, 100, 100) || !test(200000, 50000, 20) || !testPrecision(10000, 1000, 10) || !testPrecision(1000000, 1000000, 20) || !testTeam(200000, 200) || !testTeamLimit())
+        return 1;
+    return 0;
+}
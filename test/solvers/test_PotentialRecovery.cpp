@@ -0,0 +1,292 @@
+/**
+ * @file   test_PotentialRecovery.cpp
+ * @brief  Test @ref limbo::solvers::PotentialRecovery against lemon::NetworkSimplex and lemon::BellmanFord,
+ *         and recovery of solutions in @ref limbo::solvers::DualMinCostFlow
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <lemon/static_graph.h>
+#include <lemon/bellman_ford.h>
+#include <limbo/solvers/DualMinCostFlow.h>
+
+/// @nowarn
+typedef lemon::SmartDigraph graph_type;
+typedef limbo::solvers::PotentialRecovery<graph_type, long> recovery_type;
+typedef lemon::NetworkSimplex<graph_type, long, long> lemon_type;
+typedef limbo::solvers::DualMinCostFlow<int, int> dual_type;
+/// @endnowarn
+
+/// @brief check reduced costs of all residual arcs
+/// @param g graph
+/// @param upper upper bounds
+/// @param cost costs
+/// @param flow flows
+/// @param potential potentials
+/// @return true if the potentials are optimal for the flow
+bool optimal(graph_type const& g, graph_type::ArcMap<long> const& upper, graph_type::ArcMap<long> const& cost,
+        graph_type::ArcMap<long> const& flow, graph_type::NodeMap<long> const& potential)
+{
+    for (graph_type::ArcIt a (g); a != lemon::INVALID; ++a)
+    {
+        long rc = cost[a]+potential[g.source(a)]-potential[g.target(a)];
+        if ((rc < 0 && flow[a] < upper[a]) || (rc > 0 && flow[a] > 0))
+            return false;
+    }
+    return true;
+}
+
+/// @brief recover potentials of random min-cost flow problems from flows of lemon::NetworkSimplex
+/// @return true if the potentials are optimal, and a non-optimal flow is detected
+bool testKernel()
+{
+    for (int i = 0; i < 30; ++i)
+    {
+        graph_type g;
+        int numNodes = 20+rand()%200;
+        for (int n = 0; n < numNodes; ++n)
+            g.addNode();
+        for (int e = 0; e < numNodes*4; ++e)
+        {
+            int s = rand()%numNodes;
+            int t = (s+1+rand()%(numNodes-1))%numNodes;
+            g.addArc(g.nodeFromId(s), g.nodeFromId(t));
+        }
+        graph_type::ArcMap<long> upper (g);
+        graph_type::ArcMap<long> cost (g);
+        graph_type::ArcMap<long> flow (g);
+        graph_type::NodeMap<long> supply (g, 0);
+        graph_type::NodeMap<long> potential (g);
+        for (graph_type::ArcIt a (g); a != lemon::INVALID; ++a)
+        {
+            upper[a] = (rand()%4)? 10+rand()%40 : 1000000;
+            cost[a] = rand()%60-10;
+        }
+        for (int k = 0; k < numNodes/2; ++k)
+        {
+            long amount = rand()%20;
+            supply[g.nodeFromId(rand()%numNodes)] += amount;
+            supply[g.nodeFromId(rand()%numNodes)] -= amount;
+        }
+        lemon_type ref (g);
+        if (ref.upperMap(upper).costMap(cost).supplyMap(supply).run() != lemon_type::OPTIMAL)
+            continue;
+        ref.flowMap(flow);
+
+        recovery_type recovery (g);
+        // from zero potentials, and from potentials of lemon with a perturbation
+        for (int warm = 0; warm < 2; ++warm)
+        {
+            ref.potentialMap(potential);
+            if (warm)
+                potential[g.nodeFromId(rand()%numNodes)] += 5;
+            if (!recovery.run(upper, cost, flow, potential, warm) || !optimal(g, upper, cost, flow, potential))
+            {
+                std::cout << "graph " << i << ": potentials are not optimal, warm start " << warm << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // a zero flow is not optimal with a negative cycle 0 -> 1 -> 0
+    graph_type g;
+    graph_type::Node u = g.addNode();
+    graph_type::Node v = g.addNode();
+    graph_type::Arc uv = g.addArc(u, v);
+    graph_type::Arc vu = g.addArc(v, u);
+    graph_type::ArcMap<long> upper (g, 1);
+    graph_type::ArcMap<long> cost (g);
+    graph_type::ArcMap<long> flow (g, 0);
+    graph_type::NodeMap<long> potential (g, 0);
+    cost[uv] = -2;
+    cost[vu] = 1;
+    recovery_type recovery (g);
+    if (recovery.run(upper, cost, flow, potential, false))
+    {
+        std::cout << "negative cycle is not detected" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// @brief network simplex that only writes flows
+class FlowOnlyNetworkSimplex : public limbo::solvers::MinCostFlowSolver<int, int>
+{
+    public:
+        /// @brief solve and write flows only
+        /// @param d dual min-cost flow object
+        /// @return solving status
+        virtual limbo::solvers::SolverProperty operator()(dual_type* d)
+        {
+            lemon::NetworkSimplex<graph_type, int, int> alg (d->graph());
+            if (alg.upperMap(d->upperMap()).costMap(d->costMap()).supplyMap(d->supplyMap()).run() != lemon::NetworkSimplex<graph_type, int, int>::OPTIMAL)
+                return limbo::solvers::INFEASIBLE;
+            alg.flowMap(d->flowMap());
+            d->setTotalFlowCost(alg.totalCost());
+            return limbo::solvers::OPTIMAL;
+        }
+        /// @return false
+        virtual bool providesPotential() const {return false;}
+};
+
+/// @brief compute potentials with lemon::BellmanFord on the residual network like lemon::CostScaling
+/// @param d solved problem
+/// @param vPotential initial potentials by node id
+void lemonBellmanFord(dual_type const& d, std::vector<long> const& vPotential)
+{
+    graph_type const& g = d.graph();
+    dual_type::arc_flow_map_type const& flow = const_cast<dual_type&>(d).flowMap();
+    std::vector<std::pair<int, int> > vArc;
+    std::vector<long> vCost;
+    for (int i = 0; i <= g.maxNodeId(); ++i)
+    {
+        graph_type::Node u = g.nodeFromId(i);
+        for (graph_type::OutArcIt a (g, u); a != lemon::INVALID; ++a)
+        {
+            int j = g.id(g.target(a));
+            if (flow[a] < d.upperMap()[a])
+            {
+                vArc.push_back(std::make_pair(i, j));
+                vCost.push_back(d.costMap()[a]+vPotential[i]-vPotential[j]);
+            }
+        }
+        for (graph_type::InArcIt a (g, u); a != lemon::INVALID; ++a)
+        {
+            int j = g.id(g.source(a));
+            if (flow[a] > 0)
+            {
+                vArc.push_back(std::make_pair(i, j));
+                vCost.push_back(-d.costMap()[a]+vPotential[i]-vPotential[j]);
+            }
+        }
+    }
+    lemon::StaticDigraph sg;
+    sg.build(g.maxNodeId()+1, vArc.begin(), vArc.end());
+    // arcs are sorted by source nodes, so they keep their order
+    lemon::StaticDigraph::ArcMap<long> costMap (sg);
+    for (unsigned int k = 0; k < vCost.size(); ++k)
+        costMap[sg.arc(k)] = vCost[k];
+    lemon::BellmanFord<lemon::StaticDigraph, lemon::StaticDigraph::ArcMap<long> > bf (sg, costMap);
+    bf.init(0);
+    bf.start();
+}
+
+/// @brief evaluate the primal objective of the solutions
+/// @param solver solved problem
+/// @param vWeight objective weights
+/// @param vSource first variable of each constraint
+/// @param vTarget second variable of each constraint
+/// @param vRhs right hand side of each constraint
+/// @return objective, or max if a constraint is violated
+long primalObjective(dual_type const& solver, std::vector<int> const& vWeight,
+        std::vector<int> const& vSource, std::vector<int> const& vTarget, std::vector<int> const& vRhs)
+{
+    std::vector<int> const& vSol = solver.solutions();
+    for (unsigned int k = 0; k < vRhs.size(); ++k)
+        if (vSol[vSource[k]]-vSol[vTarget[k]] < vRhs[k])
+            return std::numeric_limits<long>::max();
+    long obj = 0;
+    for (unsigned int i = 0; i < vWeight.size(); ++i)
+        obj += (long)vWeight[i]*vSol[i];
+    return obj;
+}
+
+/// @brief solve rows of cells with and without potentials from the solver
+/// @return true if objectives match
+bool testDualMinCostFlow()
+{
+    int numCells = 100000;
+    int rowSize = 100;
+    std::vector<int> vWeight, vSource, vTarget, vRhs;
+    for (int i = 0; i < numCells; ++i)
+    {
+        vWeight.push_back(rand()%21-10);
+        if ((i+1)%rowSize)
+        {
+            vSource.push_back(i+1);
+            vTarget.push_back(i);
+            vRhs.push_back(1+rand()%10);
+        }
+        if (i+rowSize < numCells && rand()%4 == 0)
+        {
+            vSource.push_back(i+rowSize);
+            vTarget.push_back(i);
+            vRhs.push_back(rand()%20-10);
+        }
+    }
+    dual_type ref;
+    dual_type flowOnly;
+    dual_type* vSolver[2] = {&ref, &flowOnly};
+    for (int s = 0; s < 2; ++s)
+    {
+        vSolver[s]->reserve(numCells, vRhs.size());
+        for (int i = 0; i < numCells; ++i)
+        {
+            vSolver[s]->addVariable(0, numCells*10);
+            vSolver[s]->addObjectiveWeight(i, vWeight[i]);
+        }
+        for (unsigned int k = 0; k < vRhs.size(); ++k)
+            vSolver[s]->addDifferenceConstraint(vSource[k], vTarget[k], vRhs[k]);
+    }
+
+    limbo::solvers::NetworkSimplex<int, int> refSolver;
+    FlowOnlyNetworkSimplex flowOnlySolver;
+    limbo::solvers::SolverProperty refStatus = ref(&refSolver);
+    clock_t start = clock();
+    limbo::solvers::SolverProperty status = flowOnly(&flowOnlySolver);
+    double solveTime = double(clock()-start)/CLOCKS_PER_SEC;
+    long refObj = primalObjective(ref, vWeight, vSource, vTarget, vRhs);
+    long obj = primalObjective(flowOnly, vWeight, vSource, vTarget, vRhs);
+    if (status != limbo::solvers::OPTIMAL || status != refStatus || obj != refObj || refObj == std::numeric_limits<long>::max())
+    {
+        std::cout << "objective " << obj << ", expected " << refObj << std::endl;
+        return false;
+    }
+
+    // recovery from the same flows by the kernel and by lemon::BellmanFord like lemon::CostScaling,
+    // from zero potentials and from optimal potentials changed at 1% of the nodes
+    graph_type const& g = flowOnly.graph();
+    limbo::solvers::PotentialRecovery<graph_type, int> recovery (g);
+    graph_type::NodeMap<int> potential (g);
+    std::vector<long> vPotential (g.maxNodeId()+1, 0);
+    for (int warm = 0; warm < 2; ++warm)
+    {
+        if (warm)
+        {
+            for (int i = 0; i <= g.maxNodeId(); ++i)
+                vPotential[i] = flowOnly.potentialMap()[g.nodeFromId(i)]-((rand()%100)? 0 : rand()%20);
+        }
+        for (int i = 0; i <= g.maxNodeId(); ++i)
+            potential[g.nodeFromId(i)] = vPotential[i];
+        start = clock();
+        recovery.run(flowOnly.upperMap(), flowOnly.costMap(), flowOnly.flowMap(), potential, warm);
+        double recoveryTime = double(clock()-start)/CLOCKS_PER_SEC;
+        start = clock();
+        lemonBellmanFord(flowOnly, vPotential);
+        double bellmanFordTime = double(clock()-start)/CLOCKS_PER_SEC;
+        std::cout << numCells << " cells, " << ((warm)? "warm" : "cold") << " recovery: " << recoveryTime << " s by PotentialRecovery, "
+            << bellmanFordTime << " s by lemon::BellmanFord, solved in " << solveTime << " s with cold recovery" << std::endl;
+    }
+
+    // recover after a solver with potentials
+    ref.setRecoverPotential(true);
+    obj = (ref(&refSolver) == limbo::solvers::OPTIMAL)? primalObjective(ref, vWeight, vSource, vTarget, vRhs) : 0;
+    if (obj != refObj)
+    {
+        std::cout << "objective " << obj << " after recovery, expected " << refObj << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+    if (!testKernel() || !testDualMinCostFlow())
+        return 1;
+    return 0;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file   test_Presolve.cpp
+ * @brief  Test @ref limbo::solvers::Presolver by enumerating solutions of small binary models before and after presolve, 
+ *         and on a linear program solved by @ref limbo::solvers::PrimalDualHybridGradient
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <limbo/solvers/Presolve.h>
+#include <limbo/solvers/PrimalDualHybridGradient.h>
+
+/// @nowarn
+typedef limbo::solvers::LinearModel<float, int> model_type;
+typedef limbo::solvers::Presolver<float, int> presolver_type;
+/// @endnowarn
+
+/// @brief find the best solution of a small integer model by enumeration 
+/// @param model model with bounded integer variables, whose solutions are set to the best one 
+/// @return best objective, or max if infeasible 
+double enumerate(model_type& model)
+{
+    unsigned int numVariables = model.numVariables();
+    // singleton constraints are bounds of the model, which may cross 
+    std::vector<int> vLower (numVariables);
+    std::vector<int> vUpper (numVariables);
+    for (unsigned int j = 0; j < numVariables; ++j)
+    {
+        vLower[j] = std::ceil(model.variableProperties()[j].lowerBound()-1e-6);
+        vUpper[j] = std::floor(model.variableProperties()[j].upperBound()+1e-6);
+        if (vLower[j] > vUpper[j])
+            return std::numeric_limits<double>::max();
+    }
+    std::vector<int> vSol (vLower);
+    double sign = (model.optimizeType() == limbo::solvers::MAX)? -1 : 1;
+    double bestObj = std::numeric_limits<double>::max();
+    std::vector<int> vBest;
+    while (true)
+    {
+        bool feasible = true;
+        for (unsigned int i = 0; i < model.constraints().size() && feasible; ++i)
+        {
+            model_type::constraint_type const& constr = model.constraints()[i];
+            double slack = model.evaluateConstraint(constr, vSol);
+            feasible = (constr.sense() == '=')? std::abs(slack) < 1e-6 : (slack > -1e-6);
+        }
+        double obj = sign*model.evaluateObjective(vSol);
+        if (feasible && obj < bestObj)
+        {
+            bestObj = obj;
+            vBest = vSol;
+        }
+        // next assignment 
+        unsigned int j = 0;
+        for (; j < numVariables; ++j)
+        {
+            if (vSol[j] < vUpper[j])
+            {
+                ++vSol[j];
+                break;
+            }
+            vSol[j] = vLower[j];
+        }
+        if (j == numVariables)
+            break;
+    }
+    if (!vBest.empty())
+        model.variableSolutions() = vBest;
+    return (vBest.empty())? bestObj : sign*bestObj;
+}
+
+/// @brief random binary models with fixed variables, like coloring with precolored vertices 
+/// @return true if the best objectives before and after presolve match 
+bool testEnumeration()
+{
+    unsigned int numRemoved = 0;
+    unsigned int numConstraints = 0;
+    for (int t = 0; t < 300; ++t)
+    {
+        model_type model;
+        int numVariables = 4+rand()%10;
+        for (int j = 0; j < numVariables; ++j)
+        {
+            int lb = (rand()%6)? 0 : rand()%2;
+            int ub = (rand()%6)? std::max(lb, 1) : lb;
+            if (rand()%8 == 0)
+                ub = lb+2;
+            model.addVariable(lb, ub, limbo::solvers::INTEGER, "");
+        }
+        model_type::expression_type obj;
+        for (int j = 0; j < numVariables; ++j)
+            obj += (rand()%11-5)*model.variable(j);
+        model.setObjective(obj);
+        model.setOptimizeType((rand()%2)? limbo::solvers::MIN : limbo::solvers::MAX);
+        int numRows = 2+rand()%10;
+        for (int i = 0; i < numRows; ++i)
+        {
+            model_type::expression_type expr;
+            int numTerms = 2+rand()%3;
+            for (int k = 0; k < numTerms; ++k)
+                expr += (rand()%5-2)*model.variable(rand()%numVariables);
+            char sense = "<>="[rand()%3];
+            int rhs = rand()%5-1;
+            model.emplaceConstraint(expr, sense, rhs);
+            // duplicate of the row, maybe scaled 
+            if (rand()%4 == 0 && !model.constraints().empty())
+            {
+                model_type::constraint_type const& last = model.constraints().back();
+                model_type::expression_type copy = last.expression();
+                int factor = (rand()%2)? 2 : -1;
+                copy *= factor;
+                char copySense = (factor > 0 || last.sense() == '=')? last.sense() : ((last.sense() == '<')? '>' : '<');
+                model.emplaceConstraint(copy, copySense, factor*(last.rightHandSide()+rand()%2));
+            }
+        }
+
+        model_type reference (model);
+        double refObj = enumerate(reference);
+
+        presolver_type presolver (&model);
+        bool feasible = presolver();
+        double presolvedObj = std::numeric_limits<double>::max();
+        if (feasible)
+        {
+            if (enumerate(presolver.reducedModel()) != std::numeric_limits<double>::max())
+            {
+                presolver.postsolve();
+                presolvedObj = model.evaluateObjective();
+                // the solution must be feasible for the original model 
+                for (unsigned int i = 0; i < model.constraints().size(); ++i)
+                {
+                    model_type::constraint_type const& constr = model.constraints()[i];
+                    double slack = model.evaluateConstraint(constr);
+                    if ((constr.sense() == '=')? std::abs(slack) > 1e-6 : (slack < -1e-6))
+                    {
+                        std::cout << "model " << t << ": constraint " << i << " violated after postsolve" << std::endl;
+                        return false;
+                    }
+                }
+                if (std::abs(presolver.reducedModel().evaluateObjective()-presolvedObj) > 1e-6)
+                {
+                    std::cout << "model " << t << ": objective " << presolver.reducedModel().evaluateObjective() << " of the reduced model, " << presolvedObj << " after postsolve" << std::endl;
+                    return false;
+                }
+            }
+        }
+        if (presolvedObj != refObj)
+        {
+            std::cout << "model " << t << ": objective " << presolvedObj << ", expected " << refObj << std::endl;
+            return false;
+        }
+        numRemoved += presolver.numRemovedConstraints();
+        numConstraints += model.constraints().size();
+    }
+    std::cout << "random binary models: " << numRemoved << " of " << numConstraints << " constraints removed" << std::endl;
+    return true;
+}
+
+/// @brief a linear program with fixed variables and redundant rows, solved with and without presolve 
+/// @return true if objectives match 
+bool testLinearProgram()
+{
+    typedef limbo::solvers::LinearModel<double, double> lp_model_type;
+    lp_model_type model;
+    int numVariables = 200;
+    for (int j = 0; j < numVariables; ++j)
+    {
+        double lb = rand()%5;
+        model.addVariable(lb, (rand()%5)? lb+1+rand()%10 : lb, limbo::solvers::CONTINUOUS, "");
+    }
+    lp_model_type::expression_type obj;
+    for (int j = 0; j < numVariables; ++j)
+        obj += (rand()%21-10)*model.variable(j);
+    model.setObjective(obj);
+    model.setOptimizeType(limbo::solvers::MIN);
+    // rows are satisfied by a random point within the bounds, some are duplicates or redundant 
+    std::vector<double> vPoint (numVariables);
+    for (int j = 0; j < numVariables; ++j)
+    {
+        lp_model_type::property_type const& prop = model.variableProperties()[j];
+        vPoint[j] = prop.lowerBound()+(prop.upperBound()-prop.lowerBound())*(rand()%100)/100.0;
+    }
+    for (int i = 0; i < 300; ++i)
+    {
+        lp_model_type::expression_type expr;
+        for (int k = 0; k < 3; ++k)
+            expr += (1+rand()%3)*model.variable(rand()%numVariables);
+        double activity = model.evaluateExpression(expr, vPoint);
+        char sense = (rand()%2)? '<' : '>';
+        double rhs = (sense == '<')? activity+rand()%10 : activity-rand()%10-((i%5)? 0 : 100);
+        model.emplaceConstraint(expr, sense, rhs);
+        if (i%10 == 0)
+        {
+            lp_model_type::expression_type copy = model.constraints().back().expression();
+            copy *= 2;
+            model.emplaceConstraint(copy, sense, 2*rhs+((sense == '<')? 1 : -1));
+        }
+    }
+    lp_model_type reference (model);
+    limbo::solvers::PrimalDualHybridGradient<double, double> refSolver (&reference);
+    refSolver.setTolerance(1e-8);
+    limbo::solvers::SolverProperty refStatus = refSolver();
+
+    limbo::solvers::Presolver<double, double> presolver (&model);
+    if (!presolver())
+    {
+        std::cout << "linear program: infeasible by presolve" << std::endl;
+        return false;
+    }
+    limbo::solvers::PrimalDualHybridGradient<double, double> solver (&presolver.reducedModel());
+    solver.setTolerance(1e-8);
+    limbo::solvers::SolverProperty status = (presolver.solved())? limbo::solvers::OPTIMAL : solver();
+    presolver.postsolve();
+    std::cout << "linear program: " << presolver.reducedModel().numVariables() << " of " << model.numVariables() << " variables, "
+        << presolver.reducedModel().constraints().size() << " of " << model.constraints().size() << " constraints after presolve, objective "
+        << model.evaluateObjective() << ", expected " << reference.evaluateObjective() << std::endl;
+    return status == refStatus && std::abs(model.evaluateObjective()-reference.evaluateObjective()) < 1e-4*(1+std::abs(reference.evaluateObjective()));
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+    if (!testEnumeration() || !testLinearProgram())
+        return 1;
+    return 0;
+}
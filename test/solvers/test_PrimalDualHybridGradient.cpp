@@ -0,0 +1,203 @@
+/**
+ * @file   test_PrimalDualHybridGradient.cpp
+ * @brief  Test @ref limbo::solvers::PrimalDualHybridGradient on small problems with known solutions, also modified in a session,
+ *         and on transportation problems against lemon::NetworkSimplex
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <lemon/smart_graph.h>
+#include <lemon/network_simplex.h>
+#include <limbo/solvers/PrimalDualHybridGradient.h>
+
+/// @nowarn
+typedef limbo::solvers::LinearModel<double, double> model_type;
+typedef limbo::solvers::PrimalDualHybridGradient<double, double> solver_type;
+/// @endnowarn
+
+/// @brief max. 3 x + 2 y, s.t. x + y <= 4, x + 3 y <= 7, y - x >= -5, 0 <= x <= 3, y >= 0
+/// @return true if the solution is x = 3, y = 1 with duals 2, 0, 0
+bool testSmall()
+{
+    model_type model;
+    model_type::variable_type x = model.addVariable(0, 3, limbo::solvers::CONTINUOUS, "x");
+    model_type::variable_type y = model.addVariable(0, std::numeric_limits<double>::max(), limbo::solvers::CONTINUOUS, "y");
+    model.addConstraint(x+y <= 4, "c0");
+    model.addConstraint(x+3*y <= 7, "c1");
+    model.addConstraint(y-x >= -5, "c2");
+    model.setObjective(3*x+2*y);
+    model.setOptimizeType(limbo::solvers::MAX);
+    solver_type solver (&model);
+    solver.setTolerance(1e-8);
+    limbo::solvers::SolverProperty status = solver();
+    std::vector<double> const& vDual = solver.dualSolutions();
+    if (status != limbo::solvers::OPTIMAL || std::abs(model.variableSolution(x)-3) > 1e-5 || std::abs(model.variableSolution(y)-1) > 1e-5
+            || std::abs(solver.primalObjective()-11) > 1e-5 || std::abs(vDual[0]-2) > 1e-5 || std::abs(vDual[1]) > 1e-5 || std::abs(vDual[2]) > 1e-5)
+    {
+        std::cout << "small problem: " << limbo::solvers::toString(status) << ", x = " << model.variableSolution(x) << ", y = " << model.variableSolution(y)
+            << ", duals " << vDual[0] << " " << vDual[1] << " " << vDual[2] << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/// @brief the small problem of @ref testSmall modified through @ref limbo::solvers::PrimalDualHybridGradientSession
+/// @return true if each re-solve reaches the optimum of the modified problem
+bool testSession()
+{
+    model_type model;
+    model_type::variable_type x = model.addVariable(0, 3, limbo::solvers::CONTINUOUS, "x");
+    model_type::variable_type y = model.addVariable(0, std::numeric_limits<double>::max(), limbo::solvers::CONTINUOUS, "y");
+    model.addConstraint(x+y <= 4, "c0");
+    model.addConstraint(x+3*y <= 7, "c1");
+    model.addConstraint(y-x >= -5, "c2");
+    model.setObjective(3*x+2*y);
+    model.setOptimizeType(limbo::solvers::MAX);
+    limbo::solvers::PrimalDualHybridGradientSession<double, double> session (&model);
+    session.solver().setTolerance(1e-8);
+    double vExpected[] = {11, 10, 8, 6+10.0/3, 6+20.0/3};
+    for (int step = 0; step < 5; ++step)
+    {
+        switch (step)
+        {
+            case 1: session.addConstraint(x+2*y <= 4, "c3"); break;
+            case 2: session.setVariableBounds(x, 0, 2); break;
+            case 3: session.removeConstraints(std::vector<unsigned int>(1, 3)); break;
+            case 4: session.setObjectiveCoefficient(y, 4); break;
+            default: break;
+        }
+        limbo::solvers::SolverProperty status = session();
+        std::cout << "session step " << step << ": " << limbo::solvers::toString(status) << ", objective " << model.evaluateObjective()
+            << ", expected " << vExpected[step] << ", " << session.solver().iterations() << " iterations" << std::endl;
+        if (status != limbo::solvers::OPTIMAL || std::abs(model.evaluateObjective()-vExpected[step]) > 1e-5
+                || session.solver().dualSolutions().size() != model.constraints().size())
+            return false;
+    }
+    return true;
+}
+
+/// @brief random balanced transportation problem
+/// @param model model
+/// @param numSources number of sources
+/// @param numSinks number of sinks
+/// @param vSupply supply of each source, followed by the negative demand of each sink
+/// @param vCost cost from each source to each sink
+void buildTransportation(model_type& model, int numSources, int numSinks, std::vector<int>& vSupply, std::vector<int>& vCost)
+{
+    vSupply.assign(numSources+numSinks, 0);
+    for (int k = 0; k < numSources*4; ++k)
+    {
+        int amount = rand()%20;
+        vSupply[rand()%numSources] += amount;
+        vSupply[numSources+rand()%numSinks] -= amount;
+    }
+    vCost.resize(numSources*numSinks);
+    for (unsigned int k = 0; k < vCost.size(); ++k)
+        vCost[k] = 1+rand()%100;
+
+    for (int k = 0; k < numSources*numSinks; ++k)
+        model.addVariable(0, std::numeric_limits<double>::max(), limbo::solvers::CONTINUOUS, "");
+    model_type::expression_type obj;
+    for (int k = 0; k < numSources*numSinks; ++k)
+        obj += vCost[k]*model.variable(k);
+    model.setObjective(obj);
+    model.setOptimizeType(limbo::solvers::MIN);
+    // sources ship at most their supplies, sinks receive exactly their demands
+    for (int i = 0; i < numSources; ++i)
+    {
+        model_type::expression_type expr;
+        for (int j = 0; j < numSinks; ++j)
+            expr += model.variable(i*numSinks+j);
+        model.addConstraint(expr <= vSupply[i]);
+    }
+    for (int j = 0; j < numSinks; ++j)
+    {
+        model_type::expression_type expr;
+        for (int i = 0; i < numSources; ++i)
+            expr += model.variable(i*numSinks+j);
+        model.addConstraint(expr == -vSupply[numSources+j]);
+    }
+}
+
+/// @brief solve transportation problems, then again with perturbed costs from the previous solution
+/// @return true if objectives match lemon::NetworkSimplex
+bool testTransportation()
+{
+    int numSources = 60;
+    int numSinks = 80;
+    model_type model;
+    std::vector<int> vSupply;
+    std::vector<int> vCost;
+    buildTransportation(model, numSources, numSinks, vSupply, vCost);
+
+    solver_type solver (&model);
+    solver.setTolerance(1e-7);
+    unsigned int coldIters = 0;
+    for (int round = 0; round < 2; ++round)
+    {
+        if (round)
+        {
+            // perturb costs and warm start from the previous solution
+            model_type::expression_type obj;
+            for (int k = 0; k < numSources*numSinks; ++k)
+            {
+                if (rand()%100 == 0)
+                    vCost[k] = 1+rand()%100;
+                obj += vCost[k]*model.variable(k);
+            }
+            model.setObjective(obj);
+            solver.setWarmStart(true);
+        }
+
+        lemon::SmartDigraph g;
+        for (int i = 0; i < numSources+numSinks; ++i)
+            g.addNode();
+        for (int i = 0; i < numSources; ++i)
+            for (int j = 0; j < numSinks; ++j)
+                g.addArc(g.nodeFromId(i), g.nodeFromId(numSources+j));
+        lemon::SmartDigraph::ArcMap<int> cost (g);
+        lemon::SmartDigraph::NodeMap<int> supply (g);
+        for (int k = 0; k < numSources*numSinks; ++k)
+            cost[g.arcFromId(k)] = vCost[k];
+        for (int i = 0; i < numSources+numSinks; ++i)
+            supply[g.nodeFromId(i)] = vSupply[i];
+        lemon::NetworkSimplex<lemon::SmartDigraph, int, int> ref (g);
+        ref.costMap(cost).supplyMap(supply).run();
+
+        clock_t start = clock();
+        limbo::solvers::SolverProperty status = solver();
+        double solveTime = double(clock()-start)/CLOCKS_PER_SEC;
+        double obj = model.evaluateObjective();
+        double maxViolation = 0;
+        for (unsigned int i = 0; i < model.constraints().size(); ++i)
+        {
+            model_type::constraint_type const& constr = model.constraints()[i];
+            double slack = model.evaluateConstraint(constr);
+            maxViolation = std::max(maxViolation, (constr.sense() == '=')? std::abs(slack) : -slack);
+        }
+        std::cout << numSources << "x" << numSinks << " transportation, " << ((round)? "warm" : "cold") << " start: "
+            << limbo::solvers::toString(status) << ", objective " << obj << ", expected " << ref.totalCost()
+            << ", max violation " << maxViolation << ", " << solver.iterations() << " iterations, "
+            << solver.numRestarts() << " restarts in " << solveTime << " s" << std::endl;
+        if (status != limbo::solvers::OPTIMAL || std::abs(obj-ref.totalCost()) > 1e-4*ref.totalCost() || maxViolation > 1e-3)
+            return false;
+        if (round == 0)
+            coldIters = solver.iterations();
+        else if (solver.iterations() >= coldIters)
+            return false;
+    }
+    return true;
+}
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+    if (!testSmall() || !testSession() || !testTransportation())
+        return 1;
+    return 0;
+}
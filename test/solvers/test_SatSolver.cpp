@@ -0,0 +1,144 @@
+/**
+ * @file   test_SatSolver.cpp
+ * @brief  test @ref limbo::solvers::SatSolver against enumeration on small formulas
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <limbo/solvers/SatSolver.h>
+
+/// @nowarn
+typedef limbo::solvers::SatSolver solver_type;
+typedef solver_type::literal_type literal_type;
+/// @endnowarn
+
+/// minimum cost of a formula by enumeration
+/// @param n number of variables
+/// @param vClause clauses
+/// @param vCost cost of each positive literal
+/// @return minimum cost, negative if unsatisfiable
+double enumerate(uint32_t n, std::vector<std::vector<literal_type> > const& vClause, std::vector<double> const& vCost)
+{
+    double best = -1;
+    for (uint32_t x = 0; x < (1U<<n); ++x)
+    {
+        bool sat = true;
+        for (uint32_t c = 0; c < vClause.size() && sat; ++c)
+        {
+            bool any = false;
+            for (uint32_t k = 0; k < vClause[c].size() && !any; ++k)
+                any = (((x>>solver_type::variable(vClause[c][k]))&1) != (vClause[c][k]&1));
+            sat = any;
+        }
+        if (!sat)
+            continue;
+        double cost = 0;
+        for (uint32_t v = 0; v < n; ++v)
+            if ((x>>v)&1)
+                cost += vCost[v];
+        if (best < 0 || cost < best)
+            best = cost;
+    }
+    return best;
+}
+
+/// main function
+/// @return 0 if succeed
+int main()
+{
+    srand(1);
+
+    // pigeonhole, 7 pigeons in 6 holes
+    {
+        uint32_t p = 7, h = 6;
+        solver_type sat;
+        for (uint32_t i = 0; i < p*h; ++i)
+            sat.new_variable();
+        for (uint32_t i = 0; i < p; ++i)
+        {
+            std::vector<literal_type> vLit;
+            for (uint32_t j = 0; j < h; ++j)
+                vLit.push_back(solver_type::literal(i*h+j));
+            sat.add_clause(vLit);
+        }
+        for (uint32_t j = 0; j < h; ++j)
+            for (uint32_t i = 0; i < p; ++i)
+                for (uint32_t k = i+1; k < p; ++k)
+                    sat.add_clause(solver_type::literal(i*h+j, false), solver_type::literal(k*h+j, false));
+        solver_type::StatusType status = sat.solve();
+        std::cout << "pigeonhole " << p << "/" << h << ": status " << status << ", conflicts " << sat.num_conflicts() << std::endl;
+        if (status != solver_type::UNSATISFIABLE)
+            return 1;
+    }
+
+    // random 3-SAT around the threshold, minimum costs by tightening the bound after each solution
+    uint32_t numSat = 0;
+    for (uint32_t iter = 0; iter < 300; ++iter)
+    {
+        uint32_t n = 6+rand()%9;
+        uint32_t m = n*(7+rand()%3)/2;
+        std::vector<std::vector<literal_type> > vClause (m);
+        std::vector<double> vCost (n);
+        solver_type sat;
+        for (uint32_t v = 0; v < n; ++v)
+        {
+            sat.new_variable();
+            vCost[v] = (rand()%4)*0.5;
+            if (vCost[v] > 0)
+                sat.add_cost(solver_type::literal(v), vCost[v]);
+        }
+        for (uint32_t c = 0; c < m; ++c)
+        {
+            for (uint32_t k = 0; k < 3; ++k)
+            {
+                uint32_t v = rand()%n;
+                vClause[c].push_back(solver_type::literal(v, rand()%2));
+            }
+            sat.add_clause(vClause[c]);
+        }
+        double expect = enumerate(n, vClause, vCost);
+        double best = -1;
+        while (sat.solve() == solver_type::SATISFIABLE)
+        {
+            // the solution satisfies every clause
+            for (uint32_t c = 0; c < m; ++c)
+            {
+                bool any = false;
+                for (uint32_t k = 0; k < 3; ++k)
+                    any = any || (sat.value(solver_type::variable(vClause[c][k])) != (vClause[c][k]&1));
+                if (!any)
+                    return 1;
+            }
+            best = sat.model_cost();
+            if (best == 0)
+                break;
+            sat.cost_bound(best-0.25);
+        }
+        if (std::abs(best-expect) > 1e-9)
+        {
+            std::cout << "formula " << iter << ": cost " << best << ", expected " << expect << std::endl;
+            return 1;
+        }
+        numSat += (expect >= 0);
+    }
+    std::cout << "random formulas: " << numSat << " satisfiable, minimum costs match enumeration" << std::endl;
+
+    // assumptions do not change the clauses
+    {
+        solver_type sat;
+        uint32_t a = sat.new_variable(), b = sat.new_variable();
+        sat.add_clause(solver_type::literal(a), solver_type::literal(b));
+        std::vector<literal_type> vAssumption (1, solver_type::literal(a, false));
+        vAssumption.push_back(solver_type::literal(b, false));
+        if (sat.solve(vAssumption) != solver_type::UNSATISFIABLE)
+            return 1;
+        vAssumption.pop_back();
+        if (sat.solve(vAssumption) != solver_type::SATISFIABLE || sat.value(a) || !sat.value(b))
+            return 1;
+        if (sat.solve() != solver_type::SATISFIABLE)
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,640 @@
+/**
+ * @file   test_SolverBenchmark.cpp
+ * @brief  benchmark solvers on scalable synthetic instances and report CSV
+ *
+ * Problems and algorithms:
+ * - difference: difference constraints of rows of cells like a legalizer, solved by @ref limbo::solvers::DualMinCostFlow
+ *   with costscaling, networksimplex, capacityscaling, cyclecanceling and incremental,
+ *   networksimplex-recovery with potentials recovered from flows,
+ *   model-networksimplex through @ref limbo::solvers::LinearModel, and pdhg on the LP
+ * - knapsack: items assigned to bins of capacities, solved by @ref limbo::solvers::MultiKnapsackLagRelax
+ *   with lagrangian-subgradient, lagrangian-polyak, lagrangian-deflected, lagrangian-bundle and lagrangian-reassignment,
+ *   and by pdhg and presolve-pdhg on the LP relaxation
+ * - coloring: ILP of coloring a random geometric conflict graph minimizing conflicts,
+ *   with presolve-pdhg on the LP relaxation, gurobi if GUROBI is 1 and lpsolve if LPSOLVE is 1
+ *
+ * Times are wall times of three phases:
+ * - setup: building the model and the data structures of the solver, e.g., the graph of min-cost flow
+ * - solve: the algorithm, e.g., the min-cost flow algorithm or the lagrangian iterations
+ * - recovery: getting the solution back, e.g., potentials and solutions of the dual min-cost flow,
+ *   the feasible searcher of the lagrangian relaxation, or postsolve
+ *
+ * Usage: test_SolverBenchmark [options]
+ * - -problems list: names separated by commas, difference,knapsack,coloring by default
+ * - -algorithms list: names separated by commas, all available ones by default
+ * - -size n: number of cells, items or vertices, 100000 by default
+ * - -max_cycle_canceling n: skip cyclecanceling on larger sizes, 20000 by default
+ * - -max_ilp n: skip ILP solvers on larger sizes, 2000 by default
+ * - -pdhg_iterations n: iteration limit of pdhg, 20000 by default
+ * - -threads n: number of threads, 1 by default
+ * - -seed s: random seed, 1 by default
+ * - -csv file: output file, solver_benchmark.csv by default, - for stdout
+ *
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <time.h>
+#include <limbo/solvers/DualMinCostFlow.h>
+#include <limbo/solvers/MultiKnapsackLagRelax.h>
+#include <limbo/solvers/PrimalDualHybridGradient.h>
+#include <limbo/solvers/Presolve.h>
+#if GUROBI == 1
+#include <limbo/solvers/api/GurobiApi.h>
+#endif
+#if LPSOLVE == 1
+#include <limbo/solvers/api/LPSolveApi.h>
+#endif
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::string;
+
+/// @nowarn
+typedef limbo::solvers::DualMinCostFlow<int, int> dual_type;
+typedef limbo::solvers::MinCostFlowSolver<int, int> mcf_solver_type;
+typedef limbo::solvers::LinearModel<double, double> lp_model_type;
+typedef limbo::solvers::LinearModel<float, int> knapsack_model_type;
+typedef limbo::solvers::MultiKnapsackLagRelax<float, int> lagrangian_type;
+/// @endnowarn
+
+/// options of the benchmark
+struct Options
+{
+    std::vector<string> vProblem; ///< problems to run
+    std::vector<string> vAlgorithm; ///< algorithms to run, empty for all
+    unsigned int size; ///< number of cells, items or vertices
+    unsigned int maxCycleCanceling; ///< largest size for cycle canceling
+    unsigned int maxIlp; ///< largest size for ILP solvers
+    unsigned int pdhgIterations; ///< iteration limit of PDHG
+    unsigned int threads; ///< number of threads
+    unsigned int seed; ///< random seed
+    string csv; ///< output file, - for stdout
+
+    /// constructor with default values
+    Options()
+        : size(100000), maxCycleCanceling(20000), maxIlp(2000), pdhgIterations(20000), threads(1), seed(1), csv("solver_benchmark.csv")
+    {
+        vProblem.push_back("difference");
+        vProblem.push_back("knapsack");
+        vProblem.push_back("coloring");
+    }
+    /// @param name algorithm
+    /// @return true if the algorithm is selected
+    bool selected(string const& name) const
+    {
+        return vAlgorithm.empty() || std::find(vAlgorithm.begin(), vAlgorithm.end(), name) != vAlgorithm.end();
+    }
+};
+
+/// a line of the report
+struct Record
+{
+    string problem; ///< problem
+    string algorithm; ///< algorithm
+    unsigned int numVariables; ///< number of variables
+    unsigned int numConstraints; ///< number of constraints
+    limbo::solvers::SolverProperty status; ///< solving status
+    double objective; ///< objective
+    double setupTime; ///< time to build the model and the solver
+    double solveTime; ///< time of the algorithm
+    double recoveryTime; ///< time to get the solution back
+    unsigned int iterations; ///< iterations if the algorithm is iterative
+
+    /// constructor
+    Record() : numVariables(0), numConstraints(0), status(limbo::solvers::INFEASIBLE), objective(0), setupTime(0), solveTime(0), recoveryTime(0), iterations(0) {}
+};
+
+/// @return wall time in seconds
+double wallTime()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+
+/// @param s values separated by commas
+/// @return values
+std::vector<string> split(string const& s)
+{
+    std::vector<string> vValue;
+    std::istringstream iss (s);
+    string value;
+    while (std::getline(iss, value, ','))
+        if (!value.empty())
+            vValue.push_back(value);
+    return vValue;
+}
+
+/// @brief write a line of CSV
+/// @param r record
+/// @param opt options
+/// @param out output stream
+void report(Record const& r, Options const& opt, std::ostream& out)
+{
+    out << r.problem << "," << opt.size << "," << r.numVariables << "," << r.numConstraints << "," << r.algorithm << "," << opt.threads
+        << "," << limbo::solvers::toString(r.status) << "," << r.objective
+        << "," << r.setupTime << "," << r.solveTime << "," << r.recoveryTime << "," << r.setupTime+r.solveTime+r.recoveryTime
+        << "," << r.iterations << endl;
+}
+
+/// @brief min-cost flow solver marking the time around the algorithm,
+/// so that graph building before and recovery after are told apart
+struct TimedMinCostFlowSolver : public mcf_solver_type
+{
+    mcf_solver_type* solver; ///< algorithm
+    bool flowOnly; ///< whether potentials are recovered from flows
+    double startTime; ///< time the algorithm starts
+    double endTime; ///< time the algorithm ends
+
+    /// @brief constructor
+    /// @param s algorithm
+    /// @param f whether potentials are recovered from flows
+    TimedMinCostFlowSolver(mcf_solver_type* s, bool f) : solver(s), flowOnly(f), startTime(0), endTime(0) {}
+    /// @brief run the algorithm
+    /// @param d dual min-cost flow object
+    /// @return solving status
+    virtual limbo::solvers::SolverProperty operator()(dual_type* d)
+    {
+        startTime = wallTime();
+        limbo::solvers::SolverProperty status = (*solver)(d);
+        endTime = wallTime();
+        return status;
+    }
+    /// @return false to recover potentials from flows
+    virtual bool providesPotential() const {return !flowOnly && solver->providesPotential();}
+};
+
+/// @brief feasible searcher marking its time, which is the recovery of the lagrangian relaxation
+struct TimedSearcher : public limbo::solvers::FeasibleSearcher<float, int>
+{
+    limbo::solvers::FeasibleSearcher<float, int>* searcher; ///< searcher
+    double time; ///< time of the searcher
+
+    /// @brief constructor
+    /// @param solver problem solver
+    /// @param s searcher
+    TimedSearcher(lagrangian_type* solver, limbo::solvers::FeasibleSearcher<float, int>* s)
+        : limbo::solvers::FeasibleSearcher<float, int>(solver), searcher(s), time(0) {}
+    /// @brief run the searcher
+    /// @param updater updater for lagrangian multipliers
+    /// @return solving status
+    virtual limbo::solvers::SolverProperty operator()(updater_type* updater)
+    {
+        double start = wallTime();
+        limbo::solvers::SolverProperty status = (*searcher)(updater);
+        time += wallTime()-start;
+        return status;
+    }
+};
+
+/// @brief difference constraints of rows of cells, each cell is after its left neighbor,
+/// and some are above cells in the row below
+/// @param numCells number of cells
+/// @param vWeight objective weights
+/// @param vSource first variable of each constraint
+/// @param vTarget second variable of each constraint
+/// @param vRhs right hand side of each constraint, \f$ x_s - x_t \ge b \f$
+void differenceProblem(unsigned int numCells, std::vector<int>& vWeight, std::vector<int>& vSource, std::vector<int>& vTarget, std::vector<int>& vRhs)
+{
+    unsigned int rowSize = 100;
+    for (unsigned int i = 0; i < numCells; ++i)
+    {
+        vWeight.push_back(rand()%21-10);
+        if ((i+1)%rowSize && i+1 < numCells)
+        {
+            vSource.push_back(i+1);
+            vTarget.push_back(i);
+            vRhs.push_back(1+rand()%10);
+        }
+        if (i+rowSize < numCells && rand()%4 == 0)
+        {
+            vSource.push_back(i+rowSize);
+            vTarget.push_back(i);
+            vRhs.push_back(rand()%20-10);
+        }
+    }
+}
+
+/// @brief run difference constraints
+/// @param opt options
+/// @param out output stream
+void runDifference(Options const& opt, std::ostream& out)
+{
+    std::vector<int> vWeight, vSource, vTarget, vRhs;
+    differenceProblem(opt.size, vWeight, vSource, vTarget, vRhs);
+    int upper = opt.size*10;
+
+    limbo::solvers::CostScaling<int, int> costScaling;
+    limbo::solvers::NetworkSimplex<int, int> networkSimplex;
+    limbo::solvers::CapacityScaling<int, int> capacityScaling;
+    limbo::solvers::CycleCanceling<int, int> cycleCanceling;
+    limbo::solvers::IncrementalNetworkSimplex<int, int> incremental;
+    char const* vName[] = {"costscaling", "networksimplex", "capacityscaling", "cyclecanceling", "incremental", "networksimplex-recovery", "model-networksimplex"};
+    mcf_solver_type* vSolver[] = {&costScaling, &networkSimplex, &capacityScaling, &cycleCanceling, &incremental, &networkSimplex, &networkSimplex};
+    for (unsigned int s = 0; s < sizeof(vSolver)/sizeof(vSolver[0]); ++s)
+    {
+        string name = vName[s];
+        if (!opt.selected(name) || (name == "cyclecanceling" && opt.size > opt.maxCycleCanceling))
+            continue;
+        cerr << "running difference with " << name << endl;
+        Record r;
+        r.problem = "difference";
+        r.algorithm = name;
+        r.numVariables = vWeight.size();
+        r.numConstraints = vRhs.size();
+        TimedMinCostFlowSolver timed (vSolver[s], name == "networksimplex-recovery");
+        double start = wallTime();
+        limbo::solvers::LinearModel<int, int> model;
+        if (name == "model-networksimplex")
+        {
+            std::vector<limbo::solvers::LinearModel<int, int>::variable_type> vVar;
+            limbo::solvers::LinearModel<int, int>::expression_type obj;
+            for (unsigned int i = 0; i < vWeight.size(); ++i)
+            {
+                vVar.push_back(model.addVariable(0, upper, limbo::solvers::INTEGER));
+                obj += vWeight[i]*vVar[i];
+            }
+            for (unsigned int k = 0; k < vRhs.size(); ++k)
+                model.addConstraint(vVar[vSource[k]]-vVar[vTarget[k]] >= vRhs[k]);
+            model.setObjective(obj);
+            model.setOptimizeType(limbo::solvers::MIN);
+        }
+        dual_type solver ((name == "model-networksimplex")? &model : NULL);
+        if (name != "model-networksimplex")
+        {
+            solver.reserve(vWeight.size(), vRhs.size());
+            for (unsigned int i = 0; i < vWeight.size(); ++i)
+            {
+                solver.addVariable(0, upper);
+                solver.addObjectiveWeight(i, vWeight[i]);
+            }
+            for (unsigned int k = 0; k < vRhs.size(); ++k)
+                solver.addDifferenceConstraint(vSource[k], vTarget[k], vRhs[k]);
+        }
+        r.status = solver(&timed);
+        double end = wallTime();
+        r.objective = solver.totalCost();
+        r.setupTime = timed.startTime-start;
+        r.solveTime = timed.endTime-timed.startTime;
+        r.recoveryTime = end-timed.endTime;
+        report(r, opt, out);
+    }
+
+    if (opt.selected("pdhg"))
+    {
+        cerr << "running difference with pdhg" << endl;
+        Record r;
+        r.problem = "difference";
+        r.algorithm = "pdhg";
+        r.numVariables = vWeight.size();
+        r.numConstraints = vRhs.size();
+        double start = wallTime();
+        lp_model_type model;
+        std::vector<lp_model_type::variable_type> vVar;
+        lp_model_type::expression_type obj;
+        for (unsigned int i = 0; i < vWeight.size(); ++i)
+        {
+            vVar.push_back(model.addVariable(0, upper, limbo::solvers::CONTINUOUS));
+            obj += (double)vWeight[i]*vVar[i];
+        }
+        for (unsigned int k = 0; k < vRhs.size(); ++k)
+            model.addConstraint(vVar[vSource[k]]-vVar[vTarget[k]] >= (double)vRhs[k]);
+        model.setObjective(obj);
+        model.setOptimizeType(limbo::solvers::MIN);
+        limbo::solvers::PrimalDualHybridGradient<double, double> solver (&model);
+        solver.setMaxIterations(opt.pdhgIterations);
+        solver.setNumThreads(opt.threads);
+        double solveStart = wallTime();
+        r.status = solver();
+        r.setupTime = solveStart-start;
+        r.solveTime = wallTime()-solveStart;
+        r.objective = model.evaluateObjective();
+        r.iterations = solver.iterations();
+        report(r, opt, out);
+    }
+}
+
+/// @brief items assigned to one of their candidate bins, with bins of tight capacities,
+/// like @ref test_MultiKnapsackLagRelax.cpp
+/// @tparam ModelType linear model type
+/// @param optModel model
+/// @param numItems number of items
+/// @param seed random seed, so the same instance is built for any model type
+template <typename ModelType>
+void knapsackProblem(ModelType& optModel, unsigned int numItems, unsigned int seed)
+{
+    typedef typename ModelType::coefficient_value_type coefficient_value_type;
+    unsigned int numBins = std::max(numItems/100, 2U);
+    unsigned int numCandidates = 4;
+    srand(seed);
+    std::vector<typename ModelType::expression_type> vBinExpr (numBins);
+    std::vector<coefficient_value_type> vBinArea (numBins, 0);
+    typename ModelType::expression_type obj;
+    for (unsigned int i = 0; i < numItems; ++i)
+    {
+        coefficient_value_type area = 1+rand()%10;
+        unsigned int bin = rand()%numBins;
+        typename ModelType::expression_type itemExpr;
+        for (unsigned int j = 0; j < numCandidates; ++j, bin = (bin+1+rand()%3)%numBins)
+        {
+            typename ModelType::variable_type var = optModel.addVariable(0, 1, limbo::solvers::INTEGER);
+            itemExpr += var*(coefficient_value_type)1;
+            vBinExpr[bin] += area*var;
+            vBinArea[bin] += area;
+            obj += (coefficient_value_type)(j+rand()%500*0.01)*var;
+        }
+        optModel.addConstraint(itemExpr == (coefficient_value_type)1);
+    }
+    for (unsigned int j = 0; j < numBins; ++j)
+        if (vBinExpr[j].terms().size() > 1)
+            optModel.addConstraint(vBinExpr[j] <= (coefficient_value_type)(vBinArea[j]/numCandidates*1.05));
+    optModel.setObjective(obj);
+    optModel.setOptimizeType(limbo::solvers::MIN);
+}
+
+/// @brief solve an LP by PDHG, optionally after presolve
+/// @param r record to fill
+/// @param model model, built already
+/// @param presolve whether to presolve
+/// @param opt options
+void runPdhg(Record& r, lp_model_type& model, bool presolve, Options const& opt)
+{
+    double start = wallTime();
+    limbo::solvers::Presolver<double, double> presolver (&model);
+    lp_model_type* target = &model;
+    if (presolve)
+    {
+        presolver();
+        target = &presolver.reducedModel();
+    }
+    r.setupTime += wallTime()-start;
+    r.status = limbo::solvers::OPTIMAL;
+    if (target->numVariables())
+    {
+        limbo::solvers::PrimalDualHybridGradient<double, double> solver (target);
+        solver.setMaxIterations(opt.pdhgIterations);
+        solver.setNumThreads(opt.threads);
+        start = wallTime();
+        r.status = solver();
+        r.solveTime = wallTime()-start;
+        r.iterations = solver.iterations();
+    }
+    if (presolve)
+    {
+        start = wallTime();
+        presolver.postsolve();
+        r.recoveryTime = wallTime()-start;
+    }
+    r.objective = model.evaluateObjective();
+}
+
+/// @brief run multi-knapsack assignments
+/// @param opt options
+/// @param out output stream
+void runKnapsack(Options const& opt, std::ostream& out)
+{
+    limbo::solvers::SubGradientDescent<float> subgradient;
+    limbo::solvers::PolyakStep<float> polyak;
+    limbo::solvers::DeflectedSubGradient<float> deflected;
+    limbo::solvers::ProximalBundle<float> bundle;
+    char const* vName[] = {"lagrangian-subgradient", "lagrangian-polyak", "lagrangian-deflected", "lagrangian-bundle", "lagrangian-reassignment"};
+    limbo::solvers::LagMultiplierUpdater<float>* vUpdater[] = {&subgradient, &polyak, &deflected, &bundle, &subgradient};
+    for (unsigned int s = 0; s < sizeof(vUpdater)/sizeof(vUpdater[0]); ++s)
+    {
+        string name = vName[s];
+        if (!opt.selected(name))
+            continue;
+        cerr << "running knapsack with " << name << endl;
+        Record r;
+        r.problem = "knapsack";
+        r.algorithm = name;
+        double start = wallTime();
+        knapsack_model_type model;
+        knapsackProblem(model, opt.size, opt.seed);
+        lagrangian_type solver (&model);
+        solver.setNumThreads(opt.threads);
+        limbo::solvers::SearchByAdjustCoefficient<float, int> coeff (&solver);
+        limbo::solvers::SearchByParallelReassignment<float, int> reassignment (&solver);
+        TimedSearcher timed (&solver, (name == "lagrangian-reassignment")? (limbo::solvers::FeasibleSearcher<float, int>*)&reassignment : &coeff);
+        double solveStart = wallTime();
+        r.status = solver(vUpdater[s], NULL, &timed);
+        double end = wallTime();
+        r.numVariables = model.numVariables();
+        r.numConstraints = model.constraints().size();
+        r.objective = model.evaluateObjective();
+        r.setupTime = solveStart-start;
+        r.solveTime = end-solveStart-timed.time;
+        r.recoveryTime = timed.time;
+        r.iterations = solver.convergenceHistory().size();
+        report(r, opt, out);
+    }
+    for (int presolve = 0; presolve < 2; ++presolve)
+    {
+        string name = (presolve)? "presolve-pdhg" : "pdhg";
+        if (!opt.selected(name))
+            continue;
+        cerr << "running knapsack with " << name << endl;
+        Record r;
+        r.problem = "knapsack";
+        r.algorithm = name;
+        double start = wallTime();
+        lp_model_type model;
+        knapsackProblem(model, opt.size, opt.seed);
+        r.setupTime = wallTime()-start;
+        r.numVariables = model.numVariables();
+        r.numConstraints = model.constraints().size();
+        runPdhg(r, model, presolve, opt);
+        report(r, opt, out);
+    }
+}
+
+/// @brief ILP of coloring a random geometric graph with 3 colors, minimizing conflicts
+/// @tparam ModelType linear model type
+/// @param optModel model
+/// @param numVertices number of vertices
+/// @param seed random seed
+template <typename ModelType>
+void coloringProblem(ModelType& optModel, unsigned int numVertices, unsigned int seed)
+{
+    typedef typename ModelType::coefficient_value_type coefficient_value_type;
+    typedef typename ModelType::variable_type variable_type;
+    unsigned int numColors = 3;
+    // vertices in a square of unit density, connected within the radius of average degree 4
+    double side = std::sqrt((double)numVertices);
+    double radius = std::sqrt(4/M_PI);
+    unsigned int numCells = std::max(1U, (unsigned int)std::ceil(side/radius));
+    srand(seed);
+    std::vector<double> vX (numVertices), vY (numVertices);
+    std::vector<std::vector<unsigned int> > mCell (numCells*numCells);
+    for (unsigned int i = 0; i < numVertices; ++i)
+    {
+        vX[i] = side*rand()/RAND_MAX;
+        vY[i] = side*rand()/RAND_MAX;
+        mCell[std::min((unsigned int)(vX[i]/radius), numCells-1)*numCells+std::min((unsigned int)(vY[i]/radius), numCells-1)].push_back(i);
+    }
+    std::vector<variable_type> vColor;
+    for (unsigned int i = 0; i < numVertices; ++i)
+    {
+        typename ModelType::expression_type expr;
+        for (unsigned int c = 0; c < numColors; ++c)
+        {
+            // the first vertex takes the first color to break symmetry
+            vColor.push_back(optModel.addVariable(0, (i == 0 && c > 0)? 0 : 1, limbo::solvers::INTEGER));
+            expr += vColor.back()*(coefficient_value_type)1;
+        }
+        optModel.addConstraint(expr == (coefficient_value_type)1);
+    }
+    typename ModelType::expression_type obj;
+    for (unsigned int i = 0; i < numVertices; ++i)
+    {
+        int cx = std::min((unsigned int)(vX[i]/radius), numCells-1);
+        int cy = std::min((unsigned int)(vY[i]/radius), numCells-1);
+        for (int x = std::max(cx-1, 0); x <= std::min(cx+1, (int)numCells-1); ++x)
+            for (int y = std::max(cy-1, 0); y <= std::min(cy+1, (int)numCells-1); ++y)
+            {
+                std::vector<unsigned int> const& vCell = mCell[x*numCells+y];
+                for (std::vector<unsigned int>::const_iterator it = vCell.begin(); it != vCell.end(); ++it)
+                {
+                    unsigned int j = *it;
+                    double dx = vX[i]-vX[j];
+                    double dy = vY[i]-vY[j];
+                    if (j <= i || dx*dx+dy*dy >= radius*radius)
+                        continue;
+                    variable_type conflict = optModel.addVariable(0, 1, limbo::solvers::CONTINUOUS);
+                    obj += conflict*(coefficient_value_type)1;
+                    for (unsigned int c = 0; c < numColors; ++c)
+                        optModel.addConstraint(vColor[i*numColors+c]+vColor[j*numColors+c]-conflict <= (coefficient_value_type)1);
+                }
+            }
+    }
+    optModel.setObjective(obj);
+    optModel.setOptimizeType(limbo::solvers::MIN);
+}
+
+/// @brief run coloring ILPs
+/// @param opt options
+/// @param out output stream
+void runColoring(Options const& opt, std::ostream& out)
+{
+    if (opt.selected("presolve-pdhg"))
+    {
+        cerr << "running coloring with presolve-pdhg" << endl;
+        Record r;
+        r.problem = "coloring";
+        r.algorithm = "presolve-pdhg";
+        double start = wallTime();
+        lp_model_type model;
+        coloringProblem(model, opt.size, opt.seed);
+        r.setupTime = wallTime()-start;
+        r.numVariables = model.numVariables();
+        r.numConstraints = model.constraints().size();
+        runPdhg(r, model, true, opt);
+        report(r, opt, out);
+    }
+    if (opt.size > opt.maxIlp)
+    {
+        cerr << "ILP solvers are skipped for sizes larger than " << opt.maxIlp << endl;
+        return;
+    }
+#if GUROBI == 1
+    if (opt.selected("gurobi"))
+    {
+        cerr << "running coloring with gurobi" << endl;
+        Record r;
+        r.problem = "coloring";
+        r.algorithm = "gurobi";
+        double start = wallTime();
+        lp_model_type model;
+        coloringProblem(model, opt.size, opt.seed);
+        limbo::solvers::GurobiLinearApi<double, double> solver (&model);
+        limbo::solvers::GurobiParameters params;
+        params.setNumThreads(opt.threads);
+        params.setOutputFlag(0);
+        double solveStart = wallTime();
+        r.status = solver(&params);
+        r.setupTime = solveStart-start;
+        r.solveTime = wallTime()-solveStart;
+        r.numVariables = model.numVariables();
+        r.numConstraints = model.constraints().size();
+        r.objective = model.evaluateObjective();
+        report(r, opt, out);
+    }
+#endif
+#if LPSOLVE == 1
+    if (opt.selected("lpsolve"))
+    {
+        cerr << "running coloring with lpsolve" << endl;
+        Record r;
+        r.problem = "coloring";
+        r.algorithm = "lpsolve";
+        double start = wallTime();
+        lp_model_type model;
+        coloringProblem(model, opt.size, opt.seed);
+        limbo::solvers::LPSolveLinearApi<double, double> solver (&model);
+        double solveStart = wallTime();
+        r.status = solver();
+        r.setupTime = solveStart-start;
+        r.solveTime = wallTime()-solveStart;
+        r.numVariables = model.numVariables();
+        r.numConstraints = model.constraints().size();
+        r.objective = model.evaluateObjective();
+        report(r, opt, out);
+    }
+#endif
+}
+
+/// main function
+/// @param argc number of arguments
+/// @param argv values of arguments
+/// @return 0 if succeed
+int main(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        bool hasValue = (i+1 < argc);
+        if (arg == "-problems" && hasValue) opt.vProblem = split(argv[++i]);
+        else if (arg == "-algorithms" && hasValue) opt.vAlgorithm = split(argv[++i]);
+        else if (arg == "-size" && hasValue) opt.size = atoi(argv[++i]);
+        else if (arg == "-max_cycle_canceling" && hasValue) opt.maxCycleCanceling = atoi(argv[++i]);
+        else if (arg == "-max_ilp" && hasValue) opt.maxIlp = atoi(argv[++i]);
+        else if (arg == "-pdhg_iterations" && hasValue) opt.pdhgIterations = atoi(argv[++i]);
+        else if (arg == "-threads" && hasValue) opt.threads = atoi(argv[++i]);
+        else if (arg == "-seed" && hasValue) opt.seed = atoi(argv[++i]);
+        else if (arg == "-csv" && hasValue) opt.csv = argv[++i];
+        else
+        {
+            cerr << "unknown option " << arg << ", see the file header of test_SolverBenchmark.cpp" << endl;
+            return 1;
+        }
+    }
+    limboAssertMsg(opt.size > 1, "size must be larger than 1");
+
+    std::ofstream fout;
+    if (opt.csv != "-")
+        fout.open(opt.csv.c_str());
+    std::ostream& out = (opt.csv == "-")? cout : fout;
+    out << "problem,size,variables,constraints,algorithm,threads,status,objective,setup_time,solve_time,recovery_time,total_time,iterations" << endl;
+    for (unsigned int i = 0; i < opt.vProblem.size(); ++i)
+    {
+        srand(opt.seed);
+        if (opt.vProblem[i] == "difference")
+            runDifference(opt, out);
+        else if (opt.vProblem[i] == "knapsack")
+            runKnapsack(opt, out);
+        else if (opt.vProblem[i] == "coloring")
+            runColoring(opt, out);
+        else
+            cerr << "unknown problem " << opt.vProblem[i] << endl;
+    }
+    return 0;
+}
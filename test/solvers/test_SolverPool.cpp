@@ -0,0 +1,135 @@
+/**
+ * @file   test_SolverPool.cpp
+ * @brief  test @ref limbo::solvers::SolverPool with a backend that needs no solver library
+ * @date   Oct 2026
+ */
+#include <iostream>
+#include <limbo/solvers/SolverPool.h>
+
+/// @nowarn
+typedef limbo::solvers::LinearModel<int, int> model_type;
+/// @endnowarn
+
+/// @brief environment of the test backend
+struct Environment
+{
+    int numThreads; ///< number of threads of each solve
+    int users; ///< number of solves using the environment
+};
+
+/// @brief backend setting each variable to its lower bound
+struct TestBackend
+{
+    /// @nowarn
+    typedef ::model_type model_type;
+    typedef int parameter_type;
+    typedef Environment environment_type;
+    /// @endnowarn
+
+    static pthread_mutex_t mutex; ///< protect the counters
+    static int numEnvironments; ///< number of environments alive
+    static int numRunning; ///< number of solves running
+    static int maxRunning; ///< maximum number of concurrent solves
+    static bool shared; ///< whether an environment was used by concurrent solves
+
+    /// @param numThreads number of threads of each solve
+    /// @return environment
+    static Environment* createEnvironment(int numThreads)
+    {
+        Environment* env = new Environment;
+        env->numThreads = numThreads;
+        env->users = 0;
+        pthread_mutex_lock(&mutex);
+        ++numEnvironments;
+        pthread_mutex_unlock(&mutex);
+        return env;
+    }
+    /// @param env environment
+    static void destroyEnvironment(Environment* env)
+    {
+        pthread_mutex_lock(&mutex);
+        --numEnvironments;
+        pthread_mutex_unlock(&mutex);
+        delete env;
+    }
+    /// @param env environment
+    /// @param model model to solve
+    /// @param param offset added to the solutions, 0 if NULL
+    /// @return OPTIMAL
+    static limbo::solvers::SolverProperty solve(Environment* env, model_type* model, int const* param)
+    {
+        pthread_mutex_lock(&mutex);
+        shared |= (env->users++ != 0);
+        maxRunning = std::max(maxRunning, ++numRunning);
+        pthread_mutex_unlock(&mutex);
+        usleep(1000);
+        for (unsigned int i = 0; i < model->numVariables(); ++i)
+            model->setVariableSolution(model->variable(i), model->variableLowerBound(model->variable(i))+(param? *param : 0));
+        pthread_mutex_lock(&mutex);
+        --env->users;
+        --numRunning;
+        pthread_mutex_unlock(&mutex);
+        return limbo::solvers::OPTIMAL;
+    }
+};
+pthread_mutex_t TestBackend::mutex = PTHREAD_MUTEX_INITIALIZER;
+int TestBackend::numEnvironments = 0;
+int TestBackend::numRunning = 0;
+int TestBackend::maxRunning = 0;
+bool TestBackend::shared = false;
+
+/// @brief main function
+/// @return 0 if succeed
+int main()
+{
+    int offset = 1;
+    std::vector<model_type> vModel (200);
+    std::vector<limbo::solvers::SolverFuture> vFuture (vModel.size());
+    {
+        limbo::solvers::SolverPool<TestBackend> pool (3, 2, 4);
+        if (pool.numModels() != 3 || pool.threadsPerModel() != 2)
+        {
+            std::cout << "wrong size of the pool" << std::endl;
+            return 1;
+        }
+        for (unsigned int i = 0; i < vModel.size(); ++i)
+        {
+            for (unsigned int j = 0; j < 3; ++j)
+                vModel[i].addVariable(i+j, 1000, limbo::solvers::INTEGER, "");
+            vFuture[i] = pool.submit(&vModel[i], (i%2)? &offset : NULL);
+        }
+        if (vFuture[0].get() != limbo::solvers::OPTIMAL || !vFuture[0].ready())
+        {
+            std::cout << "wrong status of the first model" << std::endl;
+            return 1;
+        }
+        pool.wait();
+        for (unsigned int i = 0; i < vModel.size(); ++i)
+        {
+            if (!vFuture[i].ready() || vModel[i].variableSolution(vModel[i].variable(2)) != int(i+2+i%2))
+            {
+                std::cout << "model " << i << " is not solved" << std::endl;
+                return 1;
+            }
+        }
+        // models submitted after waiting are solved before the pool is destroyed
+        offset = 0;
+        for (unsigned int i = 0; i < 10; ++i)
+            vFuture[i] = pool.submit(&vModel[i], &offset);
+    }
+    for (unsigned int i = 0; i < 10; ++i)
+    {
+        if (!vFuture[i].ready() || vModel[i].variableSolution(vModel[i].variable(0)) != int(i))
+        {
+            std::cout << "model " << i << " is not solved again" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "at most " << TestBackend::maxRunning << " models in flight" << std::endl;
+    if (TestBackend::maxRunning > 3 || TestBackend::shared || TestBackend::numEnvironments != 0)
+    {
+        std::cout << "environments are shared or not freed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -5,6 +5,12 @@
  * @brief  test API of solvers in @ref limbo::solvers::LinearModel
  */
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <string>
+#include <limits>
 #include <limbo/solvers/Solvers.h>
 
 /// @brief test function API 
@@ -50,6 +56,417 @@ void test2(std::string const& filename)
     optModel.print(std::cout); 
 }
 
+/// @brief test batch construction of constraints against adding them one by one 
+/// @param numConstraints number of constraints 
+/// @param numTerms number of terms per constraint 
+/// @return true if both models have the same constraints 
+bool test3(unsigned int numConstraints, unsigned int numTerms)
+{
+    typedef limbo::solvers::LinearModel<float, float> model_type; 
+    model_type model1; 
+    model_type model2; 
+    unsigned int numVariables = numConstraints; 
+    model1.reserveVariables(numVariables);
+    model2.reserveVariables(numVariables);
+    for (unsigned int i = 0; i < numVariables; ++i)
+    {
+        model1.addVariable(0, 1, limbo::solvers::BINARY); 
+        model2.addVariable(0, 1, limbo::solvers::BINARY); 
+    }
+    model2.reservePendingConstraints(numConstraints, (std::size_t)numConstraints*numTerms);
+
+    srand(1);
+    char const* vSense = "<>=";
+    for (unsigned int i = 0; i < numConstraints; ++i)
+    {
+        // repeated variables, cancelled terms and one-term constraints 
+        unsigned int n = (i%16)? numTerms : 1; 
+        model_type::expression_type expr; 
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            model_type::variable_type var = model1.variable((i+rand()%(4*numTerms+1))%numVariables); 
+            float coef = (rand()%10)-3; 
+            expr += coef*var; 
+            model2.appendConstraintTerm(var, coef); 
+        }
+        model1.addConstraint(model_type::constraint_type(expr, i%7, vSense[i%3]));
+        model2.closeConstraint(vSense[i%3], i%7);
+    }
+    clock_t start = clock(); 
+    model2.buildConstraints(4); 
+    std::cout << "////////////////////// " << __func__ << "//////////////////////\n";
+    std::cout << model2.constraints().size() << " constraints of " << numTerms << " terms built in " << double(clock()-start)/CLOCKS_PER_SEC << " s\n";
+
+    if (model1.constraints().size() != model2.constraints().size() || model2.numPendingConstraints())
+        return false; 
+    for (unsigned int i = 0; i < model1.constraints().size(); ++i)
+    {
+        model_type::constraint_type const& c1 = model1.constraints()[i]; 
+        model_type::constraint_type const& c2 = model2.constraints()[i]; 
+        if (c1.sense() != c2.sense() || c1.rightHandSide() != c2.rightHandSide() || c1.expression().terms().size() != c2.expression().terms().size())
+            return false; 
+        for (unsigned int j = 0; j < c1.expression().terms().size(); ++j)
+            if (c1.expression().terms()[j].variable() != c2.expression().terms()[j].variable() 
+                    || c1.expression().terms()[j].coefficient() != c2.expression().terms()[j].coefficient())
+                return false; 
+    }
+    for (unsigned int i = 0; i < numVariables; ++i)
+        if (model1.variableProperties()[i].lowerBound() != model2.variableProperties()[i].lowerBound() 
+                || model1.variableProperties()[i].upperBound() != model2.variableProperties()[i].upperBound())
+            return false; 
+    return true; 
+}
+
+/// @brief test arrays for bulk loading against the model 
+/// @return true if arrays match the model 
+bool test5()
+{
+    typedef limbo::solvers::LinearModel<float, int> model_type; 
+    model_type optModel; 
+    std::vector<model_type::variable_type> vVar; 
+    for (int i = 0; i < 5; ++i)
+        vVar.push_back(optModel.addVariable(-i, 5, (i%2)? limbo::solvers::BINARY : limbo::solvers::INTEGER, "")); 
+    optModel.addConstraint(vVar[0]+2*vVar[3]-vVar[2]*10 <= 10, "c0"); 
+    optModel.addConstraint(vVar[4]-vVar[1] >= 1); 
+    optModel.addConstraint(vVar[1]+vVar[2]+vVar[3]+vVar[4] == 2, "c2"); 
+    optModel.setObjective(vVar[4]*3-vVar[0]); 
+
+    limbo::solvers::LinearModelArrays<float, int, 1> arrays; 
+    arrays.set(optModel); 
+    for (unsigned int i = 0; i < optModel.constraints().size(); ++i)
+    {
+        model_type::constraint_type const& constr = optModel.constraints()[i]; 
+        if ((unsigned int)arrays.rowSize(i) != constr.expression().terms().size() 
+                || arrays.vSense[i] != constr.sense() || arrays.vRhs[i] != constr.rightHandSide() 
+                || optModel.constraintName(constr) != arrays.vConstraintNamePtr[i])
+            return false; 
+        for (int k = 0; k < arrays.rowSize(i); ++k)
+            if (arrays.constrMatrix.vColumn[arrays.rowBegin(i)+k] != (int)constr.expression().terms()[k].variable().id()+1 
+                    || arrays.constrMatrix.vElement[arrays.rowBegin(i)+k] != constr.expression().terms()[k].coefficient())
+                return false; 
+    }
+    for (unsigned int i = 0; i < optModel.numVariables(); ++i)
+        if (arrays.vLowerBound[i] != -(int)i || arrays.vUpperBound[i] != 5 || arrays.vType[i] != 'I' 
+                || arrays.vObjective[i] != (i == 4)*3-(i == 0) || optModel.variableName(vVar[i]) != arrays.vVariableNamePtr[i])
+            return false; 
+    return arrays.constrMatrix.numElements == 9; 
+}
+
+/// @brief test modification of models used by solver sessions 
+/// @return true if constraints are removed in order and objective coefficients are changed 
+bool test6()
+{
+    typedef limbo::solvers::LinearModel<float, float> model_type; 
+    model_type optModel; 
+    std::vector<model_type::variable_type> vVar; 
+    for (int i = 0; i < 4; ++i)
+        vVar.push_back(optModel.addVariable(0, 1, limbo::solvers::CONTINUOUS, "")); 
+    for (int i = 0; i < 6; ++i)
+    {
+        char buf[8]; 
+        sprintf(buf, "c%d", i); 
+        optModel.addConstraint(vVar[i%4]+vVar[(i+1)%4] <= i, buf); 
+    }
+    std::vector<unsigned int> vRemove; 
+    vRemove.push_back(4); 
+    vRemove.push_back(1); 
+    vRemove.push_back(2); 
+    optModel.removeConstraints(vRemove); 
+    optModel.setObjective(vVar[0]+2*vVar[1]); 
+    optModel.setObjectiveCoefficient(vVar[1], 3); 
+    optModel.setObjectiveCoefficient(vVar[3], -1); 
+
+    if (optModel.constraints().size() != 3)
+        return false; 
+    int vExpected[3] = {0, 3, 5}; 
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        model_type::constraint_type const& constr = optModel.constraints()[i]; 
+        char buf[8]; 
+        sprintf(buf, "c%d", vExpected[i]); 
+        if (constr.id() != i || constr.rightHandSide() != vExpected[i] || optModel.constraintName(constr) != buf)
+            return false; 
+    }
+    std::vector<float> vSol (4, 1); 
+    return optModel.evaluateObjective(vSol) == 3 && optModel.objective().terms().size() == 3; 
+}
+
+/// @brief test binary files against lp files 
+/// @param numConstraints number of constraints 
+/// @param numTerms number of terms per constraint 
+/// @return true if the model read from the binary file is the same as the written one 
+bool test7(unsigned int numConstraints, unsigned int numTerms)
+{
+    typedef limbo::solvers::LinearModel<double, double> model_type; 
+    model_type optModel; 
+    unsigned int numVariables = numConstraints; 
+    for (unsigned int i = 0; i < numVariables; ++i)
+    {
+        char buf[16]; 
+        sprintf(buf, "v%u", i); 
+        model_type::variable_type var = optModel.addVariable(-(double)(i%5), 10+i%3, (i%3)? limbo::solvers::CONTINUOUS : limbo::solvers::INTEGER, (i%2)? buf : ""); 
+        optModel.setVariableSolution(var, i%4); 
+    }
+    srand(1); 
+    char const* vSense = "<>="; 
+    for (unsigned int i = 0; i < numConstraints; ++i)
+    {
+        model_type::expression_type expr; 
+        for (unsigned int j = 0; j < numTerms; ++j)
+            expr += ((rand()%100)/8.0-3)*optModel.variable(rand()%numVariables); 
+        char buf[16]; 
+        sprintf(buf, "R%u", i); 
+        optModel.addConstraint(model_type::constraint_type(expr, i%7+0.5, vSense[i%3]), buf); 
+    }
+    model_type::expression_type obj; 
+    for (unsigned int i = 0; i < numVariables; i += 3)
+        obj += (i%11-5.25)*optModel.variable(i); 
+    obj += 2.5; 
+    optModel.setObjective(obj); 
+    optModel.setOptimizeType(limbo::solvers::MAX); 
+
+    std::cout << "////////////////////// " << __func__ << "//////////////////////\n";
+    clock_t start = clock(); 
+    optModel.print("test_solvers.lp"); 
+    double lpWriteTime = double(clock()-start)/CLOCKS_PER_SEC; 
+    start = clock(); 
+    model_type lpModel; 
+    lpModel.read("test_solvers.lp"); 
+    double lpReadTime = double(clock()-start)/CLOCKS_PER_SEC; 
+    start = clock(); 
+    bool written = optModel.writeBinary("test_solvers.bin"); 
+    double binaryWriteTime = double(clock()-start)/CLOCKS_PER_SEC; 
+    start = clock(); 
+    model_type binaryModel; 
+    bool read = binaryModel.readBinary("test_solvers.bin"); 
+    double binaryReadTime = double(clock()-start)/CLOCKS_PER_SEC; 
+    std::cout << numConstraints << " constraints of " << numTerms << " terms written in " << lpWriteTime << " s, read in " << lpReadTime << " s as lp, " 
+        << "written in " << binaryWriteTime << " s, read in " << binaryReadTime << " s as binary\n"; 
+
+    // a model of other types and a truncated file are rejected without changes 
+    limbo::solvers::LinearModel<float, int> otherModel; 
+    bool readOther = otherModel.readBinary("test_solvers.bin"); 
+    truncate("test_solvers.bin", 1000); 
+    bool readTruncated = binaryModel.readBinary("test_solvers.bin"); 
+    std::remove("test_solvers.lp"); 
+    std::remove("test_solvers.bin"); 
+    if (!written || !read || readOther || readTruncated || lpModel.constraints().size() != numConstraints)
+        return false; 
+
+    if (binaryModel.numVariables() != numVariables || binaryModel.constraints().size() != numConstraints 
+            || binaryModel.optimizeType() != optModel.optimizeType() || binaryModel.objective().constant() != optModel.objective().constant() 
+            || binaryModel.objective().terms() != optModel.objective().terms() || binaryModel.variableSolutions() != optModel.variableSolutions())
+        return false; 
+    for (unsigned int i = 0; i < numVariables; ++i)
+    {
+        model_type::property_type const& p1 = optModel.variableProperties()[i]; 
+        model_type::property_type const& p2 = binaryModel.variableProperties()[i]; 
+        if (p1.lowerBound() != p2.lowerBound() || p1.upperBound() != p2.upperBound() || p1.numericType() != p2.numericType() || p1.name() != p2.name())
+            return false; 
+    }
+    for (unsigned int i = 0; i < numConstraints; ++i)
+    {
+        model_type::constraint_type const& c1 = optModel.constraints()[i]; 
+        model_type::constraint_type const& c2 = binaryModel.constraints()[i]; 
+        if (c2.id() != i || c1.sense() != c2.sense() || c1.rightHandSide() != c2.rightHandSide() 
+                || c1.expression().terms() != c2.expression().terms() || optModel.constraintName(c1) != binaryModel.constraintName(c2))
+            return false; 
+    }
+    return true; 
+}
+
+/// @brief read a whole file 
+/// @param filename file name 
+/// @return content, empty if failed 
+std::string readFile(char const* filename)
+{
+    std::string content; 
+    if (std::FILE* fp = std::fopen(filename, "rb"))
+    {
+        char buf[4096]; 
+        for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), fp)) > 0; )
+            content.append(buf, n); 
+        std::fclose(fp); 
+    }
+    return content; 
+}
+
+/// @brief test fast lp and mps writers 
+/// @param numConstraints number of constraints 
+/// @param numTerms number of terms in each constraint 
+/// @return true if the lp file is the same as @ref limbo::solvers::LinearModel::print and the mps file is complete 
+bool test8(unsigned int numConstraints, unsigned int numTerms)
+{
+    typedef limbo::solvers::LinearModel<double, double> model_type; 
+    model_type optModel; 
+    unsigned int numVariables = numConstraints; 
+    double inf = std::numeric_limits<double>::max(); 
+    for (unsigned int i = 0; i < numVariables; ++i)
+    {
+        char buf[16]; 
+        sprintf(buf, "v%u", i); 
+        // cover free, bounded above, bounded below and fixed variables 
+        double lb = (i%4 == 0)? limbo::lowest<double>() : -(double)(i%5); 
+        double ub = (i%4 == 1)? inf : (i%4 == 2)? lb : 10+i%3+0.125; 
+        optModel.addVariable(lb, ub, (i%3)? limbo::solvers::CONTINUOUS : limbo::solvers::INTEGER, (i%2)? buf : ""); 
+    }
+    srand(2); 
+    char const* vSense = "<>="; 
+    for (unsigned int i = 0; i < numConstraints; ++i)
+    {
+        model_type::expression_type expr; 
+        for (unsigned int j = 0; j < numTerms; ++j)
+            expr += ((rand()%100)/8.0-3)*optModel.variable(rand()%numVariables); 
+        optModel.addConstraint(model_type::constraint_type(expr, i%7+0.1, vSense[i%3]), (i%2)? "" : "R"); 
+    }
+    model_type::expression_type obj; 
+    for (unsigned int i = 0; i < numVariables; i += 3)
+        obj += (i%11-5.25)*optModel.variable(i); 
+    optModel.setObjective(obj); 
+    optModel.setOptimizeType(limbo::solvers::MAX); 
+
+    std::cout << "////////////////////// " << __func__ << "//////////////////////\n";
+    clock_t start = clock(); 
+    optModel.print("test_solvers_print.lp"); 
+    double printTime = double(clock()-start)/CLOCKS_PER_SEC; 
+    start = clock(); 
+    bool writtenLp = optModel.writeLp("test_solvers_fast.lp", 4); 
+    double lpTime = double(clock()-start)/CLOCKS_PER_SEC; 
+    start = clock(); 
+    bool writtenMps = optModel.writeMps("test_solvers_fast.mps", 4); 
+    double mpsTime = double(clock()-start)/CLOCKS_PER_SEC; 
+    std::cout << numConstraints << " constraints of " << numTerms << " terms printed in " << printTime << " s, written in " 
+        << lpTime << " s as lp, " << mpsTime << " s as mps\n"; 
+
+    std::string printed = readFile("test_solvers_print.lp"); 
+    std::string lp = readFile("test_solvers_fast.lp"); 
+    std::string mps = readFile("test_solvers_fast.mps"); 
+    std::remove("test_solvers_print.lp"); 
+    std::remove("test_solvers_fast.lp"); 
+    std::remove("test_solvers_fast.mps"); 
+    return writtenLp && writtenMps && !printed.empty() && printed == lp 
+        && mps.compare(0, 26, "NAME\nOBJSENSE\n    MAX\nROWS") == 0 && mps.size() > 7 && mps.compare(mps.size()-7, 7, "ENDATA\n") == 0; 
+}
+
+/// @brief test parallel evaluation and scaling against the serial functions 
+/// @param numConstraints number of constraints 
+/// @param numTerms number of terms in each constraint 
+/// @return true if slackness, objective, violations and scaled constraints match the serial ones 
+bool test9(unsigned int numConstraints, unsigned int numTerms)
+{
+    typedef limbo::solvers::LinearModel<double, int> model_type; 
+    model_type optModel; 
+    unsigned int numVariables = numConstraints; 
+    for (unsigned int i = 0; i < numVariables; ++i)
+        optModel.addVariable(0, 10, limbo::solvers::INTEGER); 
+    srand(3); 
+    char const* vSense = "<>="; 
+    std::vector<int>& vSolution = optModel.variableSolutions(); 
+    vSolution.resize(numVariables); 
+    for (unsigned int i = 0; i < numVariables; ++i)
+        vSolution[i] = rand()%11; 
+    model_type::expression_type obj; 
+    for (unsigned int i = 0; i < numConstraints; ++i)
+    {
+        model_type::expression_type expr; 
+        for (unsigned int j = 0; j < numTerms; ++j)
+            expr += (rand()%17-8)*optModel.variable(rand()%numVariables); 
+        // a third of the constraints is tight at the solution, others are satisfied or violated at random 
+        double lhs = optModel.evaluateExpression(expr, vSolution); 
+        optModel.addConstraint(model_type::constraint_type(expr, lhs+((i%3)? rand()%5-2 : 0), vSense[i%3])); 
+        obj += (i%7+0.5)*optModel.variable(i); 
+    }
+    optModel.setObjective(obj); 
+
+    std::cout << "////////////////////// " << __func__ << "//////////////////////\n";
+    std::size_t numViolations = 0; 
+    for (unsigned int i = 0; i < optModel.constraints().size(); ++i)
+    {
+        double slack = optModel.evaluateConstraint(optModel.constraints()[i]); 
+        numViolations += (slack < 0 || (optModel.constraints()[i].sense() == '=' && slack > 0)); 
+    }
+    clock_t start = clock(); 
+    std::vector<double> vSlackness; 
+    optModel.evaluateConstraints(vSolution, vSlackness, 4); 
+    double obj1 = optModel.evaluateObjective(vSolution, 1); 
+    double obj4 = optModel.evaluateObjective(vSolution, 4); 
+    std::size_t numViolations4 = optModel.numViolations(vSolution, 0, 4); 
+    std::cout << numConstraints << " constraints evaluated in " << double(clock()-start)/CLOCKS_PER_SEC << " s, " 
+        << numViolations4 << " violations\n"; 
+    if (numViolations4 != numViolations || obj1 != obj4 || std::abs(obj1-optModel.evaluateObjective()) > 1e-6*std::abs(obj1))
+        return false; 
+    for (unsigned int i = 0; i < optModel.constraints().size(); ++i)
+        if (vSlackness[i] != optModel.evaluateConstraint(optModel.constraints()[i]))
+            return false; 
+
+    // scaling by factors and back restores the constraints 
+    model_type scaledModel (optModel); 
+    std::vector<double> vFactor (optModel.constraints().size()); 
+    for (unsigned int i = 0; i < vFactor.size(); ++i)
+        vFactor[i] = 1 << (i%5); 
+    scaledModel.scaleConstraints(vFactor, true, 4); 
+    if (scaledModel.constraints().size() > 1 && scaledModel.constraints()[1].rightHandSide() != optModel.constraints()[1].rightHandSide()/2)
+        return false; 
+    scaledModel.scaleConstraints(vFactor, false, 4); 
+    for (unsigned int i = 0; i < optModel.constraints().size(); ++i)
+        if (scaledModel.constraints()[i].rightHandSide() != optModel.constraints()[i].rightHandSide() 
+                || scaledModel.constraints()[i].expression().terms() != optModel.constraints()[i].expression().terms())
+            return false; 
+    return true; 
+}
+
+#if __cplusplus >= 201103L
+/// number of allocations by operator new 
+static std::size_t g_numAllocations = 0; 
+
+/// @brief count allocations 
+/// @param n number of bytes 
+/// @return allocated memory 
+void* operator new(std::size_t n)
+{
+    ++g_numAllocations; 
+    if (void* p = std::malloc(n))
+        return p; 
+    throw std::bad_alloc(); 
+}
+/// @brief release memory 
+/// @param p memory 
+void operator delete(void* p) noexcept
+{
+    std::free(p); 
+}
+/// @brief release memory 
+/// @param p memory 
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p); 
+}
+
+/// @brief test that temporary expressions are moved through operators rather than copied 
+/// @return true if a chain of operators allocates no more than growing one expression 
+bool test4()
+{
+    typedef limbo::solvers::LinearModel<float, float> model_type; 
+    model_type optModel; 
+    std::vector<model_type::variable_type> vVar; 
+    for (int i = 0; i < 16; ++i)
+        vVar.push_back(optModel.addVariable(0, 1, limbo::solvers::BINARY, "")); 
+    optModel.reserveConstraints(1);
+
+    std::size_t numAllocations = g_numAllocations; 
+    optModel.addConstraint(
+            vVar[0] + vVar[1] - vVar[2] + 2*vVar[3] + vVar[4] + vVar[5] - vVar[6] + vVar[7] 
+            + vVar[8] - vVar[9] + vVar[10] + vVar[11] + vVar[12] - 3*vVar[13] + vVar[14] + vVar[15] >= 1
+            ); 
+    numAllocations = g_numAllocations-numAllocations; 
+
+    std::cout << "////////////////////// " << __func__ << "//////////////////////\n";
+    std::cout << numAllocations << " allocations for a constraint of " << optModel.constraints().front().expression().terms().size() << " terms\n";
+    // the vector of terms grows 5 times to hold 16 terms, each copy would allocate once more 
+    return optModel.constraints().size() == 1 && optModel.constraints().front().expression().terms().size() == 16 && numAllocations <= 8; 
+}
+#endif
+
 /// @brief main function 
 /// @param argc number of arguments 
 /// @param argv values of arguments
@@ -63,6 +480,50 @@ int main(int argc, char** argv)
         test2(argv[1]);
     }
     else std::cout << "at least one argument is required to test file API\n";
+    // test batch construction 
+    if (!test3(20000, 50))
+    {
+        std::cout << "batch construction differs from adding constraints one by one\n";
+        return 1; 
+    }
+    // test arrays for bulk loading into solvers 
+    if (!test5())
+    {
+        std::cout << "arrays for bulk loading differ from the model\n";
+        return 1; 
+    }
+    // test modification of models 
+    if (!test6())
+    {
+        std::cout << "wrong modification of the model\n";
+        return 1; 
+    }
+    // test binary files 
+    if (!test7(200000, 10))
+    {
+        std::cout << "model read from binary file differs from the written one\n";
+        return 1; 
+    }
+    // test fast lp and mps writers 
+    if (!test8(200000, 10))
+    {
+        std::cout << "lp file differs from printed one or mps file is incomplete\n";
+        return 1; 
+    }
+    // test parallel evaluation and scaling 
+    if (!test9(200000, 10))
+    {
+        std::cout << "parallel evaluation or scaling differs from serial one\n";
+        return 1; 
+    }
+#if __cplusplus >= 201103L
+    // test operators on temporary expressions 
+    if (!test4())
+    {
+        std::cout << "temporary expressions are copied\n";
+        return 1; 
+    }
+#endif
 
     return 0; 
 }
@@ -0,0 +1,79 @@
+/**
+ * @file   test_charconv.cpp
+ * @brief  test conversion between numbers and characters
+ * @date   Oct 2026
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <limbo/string/CharConv.h>
+#include <limbo/preprocessor/AssertMsg.h>
+using std::cout;
+using std::endl;
+
+/// @brief read a number from a string 
+/// @param s string 
+/// @param value value as output 
+/// @return true if the whole string is a number 
+template <typename T>
+bool read(const char* s, T& value)
+{
+	limbo::from_chars_result result = limbo::from_chars(s, s+strlen(s), value);
+	return result.ec == 0 && result.ptr == s+strlen(s);
+}
+
+/// @brief write a number to a string 
+/// @param value number 
+/// @return string 
+template <typename T>
+std::string write(T value)
+{
+	char buf[32];
+	return std::string(buf, limbo::to_chars(buf, buf+sizeof(buf), value).ptr);
+}
+
+/// @brief main function 
+/// @return 0 
+int main()
+{
+	int i = 0;
+	limboAssertMsg(read("-2147483648", i) && i == std::numeric_limits<int>::min(), "limbo::from_chars failed on the lowest int");
+	limboAssertMsg(!read("2147483648", i), "limbo::from_chars failed to detect overflow");
+	limboAssertMsg(read("+123456789", i) && i == 123456789, "limbo::from_chars failed on an integer with 8 digits at a time");
+	unsigned int u = 0;
+	limboAssertMsg(!read("-1", u), "limbo::from_chars accepted a negative unsigned integer");
+
+	double d = 0;
+	limboAssertMsg(read("0.1", d) && d == 0.1, "limbo::from_chars failed on 0.1");
+	limboAssertMsg(read("-1.5e-3", d) && d == -1.5e-3, "limbo::from_chars failed on an exponent");
+	limboAssertMsg(read("123456789012345678901234567890", d) && d == 123456789012345678901234567890.0, "limbo::from_chars failed on a long mantissa");
+	limboAssertMsg(!read("1e400", d), "limbo::from_chars failed to detect overflow");
+
+	limboAssertMsg(write(-2147483647-1) == "-2147483648", "limbo::to_chars failed on the lowest int");
+	limboAssertMsg(write(0.1) == "0.1", "limbo::to_chars failed on 0.1");
+	limboAssertMsg(write(0.1+0.2) == "0.30000000000000004", "limbo::to_chars failed on 0.1+0.2");
+	limboAssertMsg(write(1e23) == "1e+23", "limbo::to_chars failed on 1e23");
+	limboAssertMsg(write(0.1f) == "0.1", "limbo::to_chars failed on float 0.1");
+
+	// shortest forms of random values read back exactly
+	srand(1);
+	for (int k = 0; k < 100000; ++k)
+	{
+		double v = (rand()-RAND_MAX/2)/(double)(rand()+1)*std::pow(10.0, rand()%40-20);
+		double r = 0;
+		limboAssertMsg(read(write(v).c_str(), r) && r == v, "limbo::to_chars failed to round trip %.17g", v);
+	}
+
+	char buf[32];
+	limbo::to_chars_result result = limbo::to_chars(buf, buf+sizeof(buf), 2.675, 2);
+	*result.ptr = '\0';
+	cout << "2.675 with 2 digits: " << buf << endl;
+	limboAssertMsg(std::strcmp(buf, "2.67") == 0, "limbo::to_chars failed with fixed precision");
+	cout << "shortest 1/3: " << write(1.0/3) << endl;
+
+	return 0;
+}